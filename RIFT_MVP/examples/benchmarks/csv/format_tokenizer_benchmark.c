@@ -3,7 +3,8 @@
  * @brief Benchmark application for LibRift demonstrating thread-safe parsing of JSON and CSV
  *
  * This application demonstrates the capabilities of LibRift"s thread-safe components
- * and R"" syntax for parsing and tokenizing JSON and CSV data formats.
+ * and R"" syntax for parsing and tokenizing JSON and CSV data formats. For engine
+ * comparisons on a pattern and corpus, use the CLI's bench command instead.
  *
  * @copyright Copyright (c) 2025 LibRift Project
  * @license MIT License
@@ -468,16 +469,19 @@ parser_thread_function(void *arg)
     parser_thread_arg_t *thread_arg = (parser_thread_arg_t *)arg;
     rift_regex_error_t error = {0};
 
-    /* Record start time */
-    clock_t start_time = clock();
+    /* Record start time; clock() would add up the CPU time of every thread */
+    struct timespec start_time;
+    clock_gettime(CLOCK_MONOTONIC, &start_time);
 
     /* Execute the token extractor with thread-local context */
     thread_arg->success = rift_thread_safe_context_execute(
         thread_arg->context, token_extractor_callback, thread_arg, &error);
 
     /* Record end time */
-    clock_t end_time = clock();
-    thread_arg->elapsed_time = (double)(end_time - start_time) / CLOCKS_PER_SEC;
+    struct timespec end_time;
+    clock_gettime(CLOCK_MONOTONIC, &end_time);
+    thread_arg->elapsed_time = (double)(end_time.tv_sec - start_time.tv_sec) +
+                               (double)(end_time.tv_nsec - start_time.tv_nsec) / 1e9;
 
     if (!thread_arg->success) {
         printf("Thread %d: Error: %s\n", thread_arg->thread_id, error.message);
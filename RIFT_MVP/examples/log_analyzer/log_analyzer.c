@@ -17,6 +17,7 @@
 #include "librift/regex/automaton/flags.h"
 #include "librift/regex/engine/matcher.h"
 #include "librift/regex/engine/pattern.h"
+#include "librift/regex/engine/rulebank.h"
 #include "librift/regex/runtime/context.h"
 #include "librift/regex/runtime/groups.h"
 
@@ -44,13 +45,64 @@ typedef struct {
     } transaction_data;
 } log_entry_t;
 
+/* Rules of the log format, in the order they are added to the rule bank */
+typedef enum {
+    RULE_TIMESTAMP = 0,
+    RULE_ENTRY,
+    RULE_ERROR,
+    RULE_WARNING,
+    RULE_INFO,
+    RULE_DEBUG,
+    RULE_TRANSACTION,
+    RULE_TRANSACTION_DATA,
+    NUM_LOG_RULES
+} log_rule_t;
+
+/* Named patterns of the log format, using LibRift's r'' syntax */
+static const struct {
+    const char *name;
+    const char *pattern;
+} log_rules[NUM_LOG_RULES] = {
+    {"timestamp", "^\\[(\\d{4}-\\d{2}-\\d{2} \\d{2}:\\d{2}:\\d{2})\\]"},
+    {"entry", "^\\[\\d{4}-\\d{2}-\\d{2} \\d{2}:\\d{2}:\\d{2}\\] \\[([A-Za-z0-9_-]+)\\] "
+              "\\[.*?\\]: (.+)$"},
+    {"error", "^\\[.*?\\] \\[.*?\\] \\[ERROR\\]:"},
+    {"warning", "^\\[.*?\\] \\[.*?\\] \\[WARN\\]:"},
+    {"info", "^\\[.*?\\] \\[.*?\\] \\[INFO\\]:"},
+    {"debug", "^\\[.*?\\] \\[.*?\\] \\[DEBUG\\]:"},
+    {"transaction", "^\\[.*?\\] \\[TRANSACTION\\] \\[.*?\\]:"},
+    {"transaction_data", "TRANSACTION: user=([A-Za-z0-9_-]+), txn_id=([A-Za-z0-9-]+), "
+                         "amount=\\$([\\d\\.]+), status=([A-Z]+)"}};
+
+/* Running statistics over the analyzed entries */
+typedef struct {
+    rift_regex_matcher_t *line_matcher;
+    rift_rulebank_t *rules;
+    rift_rulebank_results_t *results;
+    size_t line_count;
+    size_t error_count;
+    size_t warning_count;
+    size_t transaction_count;
+    double total_transaction_amount;
+    size_t successful_transactions;
+    size_t failed_transactions;
+} log_stats_t;
+
 /* Function prototypes */
-bool parse_log_entry(const char *line, log_entry_t *entry);
-bool extract_timestamp(const char *line, char *timestamp, size_t max_len);
-log_entry_type_t determine_log_type(const char *line);
-bool extract_transaction_data(const char *line, log_entry_t *entry);
+rift_rulebank_t *create_log_rules(void);
+bool parse_log_entry(rift_rulebank_t *rules, rift_rulebank_results_t *results, const char *line,
+                     log_entry_t *entry);
+bool copy_group(const rift_rulebank_results_t *results, log_rule_t rule, size_t group,
+                const char *line, char *buffer, size_t size);
+bool extract_timestamp(const rift_rulebank_results_t *results, const char *line, char *timestamp,
+                       size_t max_len);
+log_entry_type_t determine_log_type(const rift_rulebank_results_t *results);
+bool extract_transaction_data(const rift_rulebank_results_t *results, const char *line,
+                              log_entry_t *entry);
 void print_log_entry(const log_entry_t *entry);
-void analyze_logs(FILE *log_file);
+bool analyze_line(size_t line_number, const rift_regex_span_t *line_span,
+                  const rift_regex_span_t *spans, size_t num_spans, void *user_data);
+bool analyze_logs(const char *log_file_path);
 
 /**
  * @brief Main entry point
@@ -64,257 +116,240 @@ main(int argc, char *argv[])
     }
 
     const char *log_file_path = argv[1];
-    FILE *log_file = fopen(log_file_path, "r");
 
-    if (!log_file) {
-        fprintf(stderr, "Error: Could not open log file '%s'\n", log_file_path);
+    printf("Analyzing log file: %s\n\n", log_file_path);
+    if (!analyze_logs(log_file_path)) {
+        fprintf(stderr, "Error: Could not analyze log file '%s'\n", log_file_path);
         return 1;
     }
 
-    printf("Analyzing log file: %s\n\n", log_file_path);
-    analyze_logs(log_file);
-
-    fclose(log_file);
     return 0;
 }
 
 /**
- * @brief Analyze all entries in a log file
+ * @brief Analyze one line of a log file, reported as a match of the whole line
  */
-void
-analyze_logs(FILE *log_file)
+bool
+analyze_line(size_t line_number, const rift_regex_span_t *line_span,
+             const rift_regex_span_t *spans, size_t num_spans, void *user_data)
 {
+    log_stats_t *stats = (log_stats_t *)user_data;
     char line[1024];
-    size_t line_count = 0;
-    size_t error_count = 0;
-    size_t warning_count = 0;
-    size_t transaction_count = 0;
-    double total_transaction_amount = 0.0;
-    size_t successful_transactions = 0;
-    size_t failed_transactions = 0;
-
-    // Process each line of the log file
-    while (fgets(line, sizeof(line), log_file)) {
-        line_count++;
-
-        // Remove trailing newline if present
-        size_t len = strlen(line);
-        if (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r')) {
-            line[len - 1] = '\0';
-        }
 
-        // Parse the log entry
-        log_entry_t entry;
-        if (parse_log_entry(line, &entry)) {
-            // Update statistics based on entry type
-            switch (entry.type) {
-            case LOG_TYPE_ERROR:
-                error_count++;
-                break;
-            case LOG_TYPE_WARNING:
-                warning_count++;
-                break;
-            case LOG_TYPE_TRANSACTION:
-                transaction_count++;
-                total_transaction_amount += entry.transaction_data.amount;
-
-                if (strcmp(entry.transaction_data.status, "SUCCESS") == 0) {
-                    successful_transactions++;
-                } else if (strcmp(entry.transaction_data.status, "FAILED") == 0) {
-                    failed_transactions++;
-                }
-                break;
-            default:
-                break;
-            }
+    stats->line_count++;
 
-            // Print detailed information for errors and transactions
-            if (entry.type == LOG_TYPE_ERROR || entry.type == LOG_TYPE_TRANSACTION) {
-                print_log_entry(&entry);
+    // Copy the line out of the mapped file, dropping a trailing carriage return
+    size_t len = rift_matcher_copy_span_text(stats->line_matcher, &spans[0], line, sizeof(line));
+    if (len >= sizeof(line)) {
+        len = sizeof(line) - 1;
+    }
+    if (len > 0 && line[len - 1] == '\r') {
+        line[len - 1] = '\0';
+    }
+
+    // Parse the log entry
+    log_entry_t entry;
+    if (parse_log_entry(stats->rules, stats->results, line, &entry)) {
+        // Update statistics based on entry type
+        switch (entry.type) {
+        case LOG_TYPE_ERROR:
+            stats->error_count++;
+            break;
+        case LOG_TYPE_WARNING:
+            stats->warning_count++;
+            break;
+        case LOG_TYPE_TRANSACTION:
+            stats->transaction_count++;
+            stats->total_transaction_amount += entry.transaction_data.amount;
+
+            if (strcmp(entry.transaction_data.status, "SUCCESS") == 0) {
+                stats->successful_transactions++;
+            } else if (strcmp(entry.transaction_data.status, "FAILED") == 0) {
+                stats->failed_transactions++;
             }
+            break;
+        default:
+            break;
+        }
+
+        // Print detailed information for errors and transactions
+        if (entry.type == LOG_TYPE_ERROR || entry.type == LOG_TYPE_TRANSACTION) {
+            print_log_entry(&entry);
         }
     }
 
-    // Print summary statistics
-    printf("\n--- Log Analysis Summary ---\n");
-    printf("Total log entries: %zu\n", line_count);
-    printf("Error entries: %zu\n", error_count);
-    printf("Warning entries: %zu\n", warning_count);
-    printf("Transaction entries: %zu\n", transaction_count);
-    printf("Total transaction amount: $%.2f\n", total_transaction_amount);
-    printf("Successful transactions: %zu\n", successful_transactions);
-    printf("Failed transactions: %zu\n", failed_transactions);
+    (void)line_number;
+    (void)line_span;
+    (void)num_spans;
+    return true;
 }
 
 /**
- * @brief Parse a log entry line into a structured format
+ * @brief Analyze all entries in a log file
  */
 bool
-parse_log_entry(const char *line, log_entry_t *entry)
+analyze_logs(const char *log_file_path)
 {
-    if (!line || !entry) {
+    rift_regex_error_t error;
+    log_stats_t stats = {0};
+
+    // Every pattern of the log format is compiled once, before the first line
+    stats.rules = create_log_rules();
+    if (!stats.rules) {
         return false;
     }
-
-    // Initialize entry
-    memset(entry, 0, sizeof(log_entry_t));
-
-    // Extract timestamp first
-    if (!extract_timestamp(line, entry->timestamp, sizeof(entry->timestamp))) {
+    stats.results = rift_rulebank_results_create(stats.rules);
+    if (!stats.results) {
+        rift_rulebank_free(stats.rules);
         return false;
     }
 
-    // Determine log entry type
-    entry->type = determine_log_type(line);
+    // Every non-empty line is one match, scanned line by line straight from the mapped file
+    rift_regex_pattern_t *line_pattern =
+        rift_regex_compile("^.+$", RIFT_REGEX_FLAG_RIFT_SYNTAX, &error);
+    if (line_pattern) {
+        stats.line_matcher = rift_matcher_create(line_pattern, RIFT_MATCHER_OPTION_NONE);
+    }
 
-    // Use LibRift's r'' syntax for complex pattern matching
-    rift_regex_error_t error;
-    rift_regex_flags_t flags = RIFT_REGEX_FLAG_RIFT_SYNTAX;
+    bool scanned = stats.line_matcher && rift_matcher_find_all_lines_file(stats.line_matcher,
+                                                                          log_file_path,
+                                                                          analyze_line, &stats);
 
-    // Pattern to extract module and message
-    rift_regex_pattern_t *module_pattern = rift_regex_compile(
-        "^\\[\\d{4}-\\d{2}-\\d{2} \\d{2}:\\d{2}:\\d{2}\\] \\[([A-Za-z0-9_-]+)\\] \\[.*?\\]: (.+)$",
-        flags, &error);
+    rift_matcher_free(stats.line_matcher);
+    rift_regex_pattern_free(line_pattern);
+    rift_rulebank_results_free(stats.results);
+    rift_rulebank_free(stats.rules);
 
-    if (!module_pattern) {
+    if (!scanned) {
         return false;
     }
 
-    // Create matcher for the pattern
-    rift_regex_matcher_t *matcher = rift_matcher_create(module_pattern, RIFT_MATCHER_OPTION_NONE);
-    if (!matcher) {
-        rift_regex_pattern_free(module_pattern);
-        return false;
+    // Print summary statistics
+    printf("\n--- Log Analysis Summary ---\n");
+    printf("Total log entries: %zu\n", stats.line_count);
+    printf("Error entries: %zu\n", stats.error_count);
+    printf("Warning entries: %zu\n", stats.warning_count);
+    printf("Transaction entries: %zu\n", stats.transaction_count);
+    printf("Total transaction amount: $%.2f\n", stats.total_transaction_amount);
+    printf("Successful transactions: %zu\n", stats.successful_transactions);
+    printf("Failed transactions: %zu\n", stats.failed_transactions);
+    return true;
+}
+
+/**
+ * @brief Compile the rules of the log format into a rule bank
+ */
+rift_rulebank_t *
+create_log_rules(void)
+{
+    rift_rulebank_t *rules = rift_rulebank_create(RIFT_RULEBANK_OPTION_NONE);
+    if (!rules) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < NUM_LOG_RULES; i++) {
+        rift_regex_error_t error;
+        if (!rift_rulebank_add(rules, log_rules[i].name, log_rules[i].pattern,
+                               RIFT_REGEX_FLAG_RIFT_SYNTAX, NULL, &error)) {
+            fprintf(stderr, "Error: rule '%s': %s\n", log_rules[i].name, error.message);
+            rift_rulebank_free(rules);
+            return NULL;
+        }
     }
 
-    // Set the input string
-    if (!rift_matcher_set_input(matcher, line, strlen(line))) {
-        rift_matcher_free(matcher);
-        rift_regex_pattern_free(module_pattern);
+    return rules;
+}
+
+/**
+ * @brief Parse a log entry line into a structured format
+ */
+bool
+parse_log_entry(rift_rulebank_t *rules, rift_rulebank_results_t *results, const char *line,
+                log_entry_t *entry)
+{
+    if (!line || !entry) {
         return false;
     }
 
-    // Match the pattern
-    rift_regex_match_t match;
-    bool result = rift_matcher_matches(matcher, &match);
+    // Initialize entry
+    memset(entry, 0, sizeof(log_entry_t));
 
-    if (result && match.group_count >= 2) {
-        // Copy module name (group 1) and message (group 2)
-        strncpy(entry->module, match.groups[1].value, sizeof(entry->module) - 1);
-        strncpy(entry->message, match.groups[2].value, sizeof(entry->message) - 1);
+    // One pass of the rule bank answers every question asked about the line
+    rift_rulebank_match(rules, line, strlen(line), results);
+
+    // Extract timestamp first
+    if (!extract_timestamp(results, line, entry->timestamp, sizeof(entry->timestamp))) {
+        return false;
     }
 
-    // Clean up resources
-    rift_match_free(&match);
-    rift_matcher_free(matcher);
-    rift_regex_pattern_free(module_pattern);
+    // Determine log entry type
+    entry->type = determine_log_type(results);
+
+    // Copy module name (group 1) and message (group 2)
+    copy_group(results, RULE_ENTRY, 1, line, entry->module, sizeof(entry->module));
+    copy_group(results, RULE_ENTRY, 2, line, entry->message, sizeof(entry->message));
 
     // For transaction logs, extract additional data
     if (entry->type == LOG_TYPE_TRANSACTION) {
-        extract_transaction_data(line, entry);
+        extract_transaction_data(results, line, entry);
     }
 
     return true;
 }
 
 /**
- * @brief Extract timestamp from log line
+ * @brief Copy the text of a rule's capture group out of the line
  */
 bool
-extract_timestamp(const char *line, char *timestamp, size_t max_len)
+copy_group(const rift_rulebank_results_t *results, log_rule_t rule, size_t group,
+           const char *line, char *buffer, size_t size)
 {
-    rift_regex_error_t error;
-    rift_regex_flags_t flags = RIFT_REGEX_FLAG_RIFT_SYNTAX;
-
-    // Pattern to extract timestamp
-    rift_regex_pattern_t *timestamp_pattern =
-        rift_regex_compile("^\\[(\\d{4}-\\d{2}-\\d{2} \\d{2}:\\d{2}:\\d{2})\\]", flags, &error);
-
-    if (!timestamp_pattern) {
+    rift_regex_span_t span;
+    if (!rift_rulebank_results_get_span(results, rule, group, &span)) {
         return false;
     }
 
-    // Create matcher for the pattern
-    rift_regex_matcher_t *matcher =
-        rift_matcher_create(timestamp_pattern, RIFT_MATCHER_OPTION_NONE);
-    if (!matcher) {
-        rift_regex_pattern_free(timestamp_pattern);
-        return false;
-    }
-
-    // Set the input string
-    if (!rift_matcher_set_input(matcher, line, strlen(line))) {
-        rift_matcher_free(matcher);
-        rift_regex_pattern_free(timestamp_pattern);
-        return false;
+    size_t len = span.end - span.start;
+    if (len >= size) {
+        len = size - 1;
     }
+    memcpy(buffer, line + span.start, len);
+    buffer[len] = '\0';
+    return true;
+}
 
-    // Match the pattern
-    rift_regex_match_t match;
-    bool result = rift_matcher_find_next(matcher, &match);
-
-    if (result && match.group_count >= 1) {
-        // Copy timestamp (group 1)
-        strncpy(timestamp, match.groups[1].value, max_len - 1);
-        timestamp[max_len - 1] = '\0';
-    } else {
-        // Default timestamp if not found
-        strncpy(timestamp, "Unknown", max_len - 1);
-        timestamp[max_len - 1] = '\0';
-        result = false;
+/**
+ * @brief Extract timestamp from log line
+ */
+bool
+extract_timestamp(const rift_rulebank_results_t *results, const char *line, char *timestamp,
+                  size_t max_len)
+{
+    // Copy timestamp (group 1)
+    if (copy_group(results, RULE_TIMESTAMP, 1, line, timestamp, max_len)) {
+        return true;
     }
 
-    // Clean up resources
-    rift_match_free(&match);
-    rift_matcher_free(matcher);
-    rift_regex_pattern_free(timestamp_pattern);
-
-    return result;
+    // Default timestamp if not found
+    strncpy(timestamp, "Unknown", max_len - 1);
+    timestamp[max_len - 1] = '\0';
+    return false;
 }
 
 /**
  * @brief Determine log entry type based on content
  */
 log_entry_type_t
-determine_log_type(const char *line)
+determine_log_type(const rift_rulebank_results_t *results)
 {
-    rift_regex_error_t error;
-    rift_regex_flags_t flags = RIFT_REGEX_FLAG_RIFT_SYNTAX;
-
-    // Patterns for different log types
-    const char *patterns[] = {
-        "^\\[.*?\\] \\[.*?\\] \\[ERROR\\]:", "^\\[.*?\\] \\[.*?\\] \\[WARN\\]:",
-        "^\\[.*?\\] \\[.*?\\] \\[INFO\\]:", "^\\[.*?\\] \\[.*?\\] \\[DEBUG\\]:",
-        "^\\[.*?\\] \\[TRANSACTION\\] \\[.*?\\]:"};
-
-    log_entry_type_t types[] = {LOG_TYPE_ERROR, LOG_TYPE_WARNING, LOG_TYPE_INFO, LOG_TYPE_DEBUG,
-                                LOG_TYPE_TRANSACTION};
-
-    // Try each pattern in order
-    for (size_t i = 0; i < sizeof(patterns) / sizeof(patterns[0]); i++) {
-        rift_regex_pattern_t *pattern = rift_regex_compile(patterns[i], flags, &error);
-        if (!pattern) {
-            continue;
-        }
-
-        rift_regex_matcher_t *matcher = rift_matcher_create(pattern, RIFT_MATCHER_OPTION_NONE);
-        if (!matcher) {
-            rift_regex_pattern_free(pattern);
-            continue;
-        }
-
-        if (!rift_matcher_set_input(matcher, line, strlen(line))) {
-            rift_matcher_free(matcher);
-            rift_regex_pattern_free(pattern);
-            continue;
-        }
-
-        bool result = rift_matcher_find_next(matcher, NULL);
-
-        rift_matcher_free(matcher);
-        rift_regex_pattern_free(pattern);
-
-        if (result) {
+    static const log_rule_t rules[] = {RULE_ERROR, RULE_WARNING, RULE_INFO, RULE_DEBUG,
+                                       RULE_TRANSACTION};
+    static const log_entry_type_t types[] = {LOG_TYPE_ERROR, LOG_TYPE_WARNING, LOG_TYPE_INFO,
+                                             LOG_TYPE_DEBUG, LOG_TYPE_TRANSACTION};
+
+    // The first type rule that matched, in order
+    for (size_t i = 0; i < sizeof(rules) / sizeof(rules[0]); i++) {
+        if (rift_rulebank_results_matched(results, rules[i])) {
             return types[i];
         }
     }
@@ -326,63 +361,25 @@ determine_log_type(const char *line)
  * @brief Extract transaction-specific data from a log line
  */
 bool
-extract_transaction_data(const char *line __attribute__((unused)), log_entry_t *entry)
+extract_transaction_data(const rift_rulebank_results_t *results, const char *line,
+                         log_entry_t *entry)
 {
-    rift_regex_error_t error;
-    rift_regex_flags_t flags = RIFT_REGEX_FLAG_RIFT_SYNTAX;
-
-    // Pattern to extract transaction data
-    // This demonstrates the power of the r'' syntax with a complex pattern
-    rift_regex_pattern_t *transaction_pattern =
-        rift_regex_compile("TRANSACTION: user=([A-Za-z0-9_-]+), txn_id=([A-Za-z0-9-]+), "
-                           "amount=\\$([\\d\\.]+), status=([A-Z]+)",
-                           flags, &error);
-
-    if (!transaction_pattern) {
+    if (!rift_rulebank_results_matched(results, RULE_TRANSACTION_DATA)) {
         return false;
     }
 
-    // Create matcher for the pattern
-    rift_regex_matcher_t *matcher =
-        rift_matcher_create(transaction_pattern, RIFT_MATCHER_OPTION_NONE);
-    if (!matcher) {
-        rift_regex_pattern_free(transaction_pattern);
-        return false;
-    }
-
-    // Set the input string
-    if (!rift_matcher_set_input(matcher, entry->message, strlen(entry->message))) {
-        rift_matcher_free(matcher);
-        rift_regex_pattern_free(transaction_pattern);
-        return false;
-    }
-
-    // Match the pattern
-    rift_regex_match_t match;
-    bool result = rift_matcher_find_next(matcher, &match);
-
-    if (result && match.group_count >= 4) {
-        // Copy transaction data from capture groups
-        strncpy(entry->transaction_data.user_id, match.groups[1].value,
-                sizeof(entry->transaction_data.user_id) - 1);
+    // Copy transaction data from capture groups
+    char amount[32] = "";
+    copy_group(results, RULE_TRANSACTION_DATA, 1, line, entry->transaction_data.user_id,
+               sizeof(entry->transaction_data.user_id));
+    copy_group(results, RULE_TRANSACTION_DATA, 2, line, entry->transaction_data.transaction_id,
+               sizeof(entry->transaction_data.transaction_id));
+    copy_group(results, RULE_TRANSACTION_DATA, 3, line, amount, sizeof(amount));
+    copy_group(results, RULE_TRANSACTION_DATA, 4, line, entry->transaction_data.status,
+               sizeof(entry->transaction_data.status));
+    entry->transaction_data.amount = atof(amount);
 
-        strncpy(entry->transaction_data.transaction_id, match.groups[2].value,
-                sizeof(entry->transaction_data.transaction_id) - 1);
-
-        entry->transaction_data.amount = atof(match.groups[3].value);
-
-        strncpy(entry->transaction_data.status, match.groups[4].value,
-                sizeof(entry->transaction_data.status) - 1);
-    } else {
-        result = false;
-    }
-
-    // Clean up resources
-    rift_match_free(&match);
-    rift_matcher_free(matcher);
-    rift_regex_pattern_free(transaction_pattern);
-
-    return result;
+    return true;
 }
 
 /**
@@ -0,0 +1,708 @@
+/**
+ * @file thread_scaling_benchmark.c
+ * @brief Thread-scalability benchmark of the LibRift matching paths
+ *
+ * This application matches a fixed corpus with 1 to N threads through the
+ * bytecode VM, the DFA table, the thread-safe context and the batch API,
+ * and reports for each thread count the wall time, the matches per second
+ * and the p50/p99/p999 latency. Times come from the monotonic clock, which
+ * unlike clock() does not add up the CPU time of every thread. Results are
+ * printed as a table, or as CSV or JSON for regression tracking.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "core/automaton/automaton.h"
+#include "core/automaton/dfa_table.h"
+#include "core/bytecode/bytecode_compiler.h"
+#include "core/bytecode/bytecode_vm_pool.h"
+#include "core/engine/batch.h"
+#include "core/engine/pattern.h"
+#include "core/errors/regex_error.h"
+#include "runtime/context_thread_safe_context.h"
+
+/* Pattern matched when none is given */
+#define DEFAULT_PATTERN "user[0-9]+"
+
+/* Matches each thread makes per run when no count is given */
+#define DEFAULT_ITERATIONS 20000
+
+/* Lines in the generated corpus */
+#define CORPUS_SIZE 256
+
+/* Maximum backtracking depth of the thread-safe context */
+#define MAX_BACKTRACK_DEPTH 1000
+
+/* Output formats */
+typedef enum { FORMAT_TABLE, FORMAT_CSV, FORMAT_JSON } output_format_t;
+
+/* Matching paths under test */
+typedef enum {
+    ENGINE_BYTECODE,
+    ENGINE_DFA,
+    ENGINE_CONTEXT_MATCH,
+    ENGINE_CONTEXT_EXECUTE,
+    ENGINE_BATCH,
+    ENGINE_COUNT
+} engine_t;
+
+static const char *engine_names[ENGINE_COUNT] = {"bytecode", "dfa", "context_match",
+                                                 "context_execute", "batch"};
+
+/* Compiled forms of the pattern and the corpus, shared by every thread */
+typedef struct {
+    rift_regex_pattern_t *pattern;
+    rift_regex_automaton_t *automaton;
+    rift_bytecode_program_t *program;
+    rift_dfa_table_t *table;
+    rift_regex_thread_safe_context_t *context;
+    char **inputs;
+    size_t *lengths;
+    size_t num_inputs;
+} bench_targets_t;
+
+/* State of one benchmark thread */
+typedef struct {
+    const bench_targets_t *targets;
+    engine_t engine;
+    size_t iterations;
+    size_t first_input;
+    pthread_barrier_t *barrier;
+    uint64_t *latencies;
+    uint64_t start_ns;
+    uint64_t end_ns;
+    size_t matched;
+    bool failed;
+} bench_worker_t;
+
+/* Result of one engine at one thread count */
+typedef struct {
+    engine_t engine;
+    size_t threads;
+    size_t matches;
+    size_t matched;
+    uint64_t wall_ns;
+    double matches_per_sec;
+    uint64_t p50_ns;
+    uint64_t p99_ns;
+    uint64_t p999_ns;
+    const char *latency_of;
+} bench_result_t;
+
+/**
+ * @brief Read the monotonic clock
+ *
+ * @return Time in nanoseconds
+ */
+static uint64_t
+bench_clock_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief Callback of rift_thread_safe_context_execute
+ *
+ * It does no matching of its own, so the run measures what a call costs to
+ * find the thread's matcher context and bind the input to it.
+ */
+static bool
+execute_callback(rift_regex_matcher_context_t *context, void *user_data,
+                 rift_regex_error_t *error)
+{
+    (void)user_data;
+    (void)error;
+    return context != NULL;
+}
+
+/**
+ * @brief Match one input through an engine
+ *
+ * @param targets The compiled pattern and corpus
+ * @param engine The engine
+ * @param index Index of the input
+ * @param failed Set when the engine could not run
+ * @return true if the input matched, false otherwise
+ */
+static bool
+match_one(const bench_targets_t *targets, engine_t engine, size_t index, bool *failed)
+{
+    const char *input = targets->inputs[index];
+    size_t length = targets->lengths[index];
+    rift_regex_match_t match = {0};
+
+    switch (engine) {
+    case ENGINE_BYTECODE: {
+        rift_bytecode_vm_t *vm = rift_bytecode_vm_acquire(targets->program, input, length);
+        if (!vm) {
+            *failed = true;
+            return false;
+        }
+        bool matched = rift_bytecode_execute(targets->program, vm, &match);
+        rift_bytecode_vm_release(vm);
+        return matched;
+    }
+    case ENGINE_DFA:
+        return rift_dfa_table_matches(targets->table, input, length);
+    case ENGINE_CONTEXT_MATCH:
+        return rift_thread_safe_context_match(targets->context, input, length, &match);
+    case ENGINE_CONTEXT_EXECUTE:
+        return rift_thread_safe_context_execute(targets->context, input, length,
+                                                execute_callback, NULL, NULL);
+    default:
+        *failed = true;
+        return false;
+    }
+}
+
+/**
+ * @brief Benchmark thread body
+ *
+ * @param arg The worker (bench_worker_t*)
+ * @return NULL
+ */
+static void *
+bench_worker_run(void *arg)
+{
+    bench_worker_t *worker = arg;
+    const bench_targets_t *targets = worker->targets;
+
+    pthread_barrier_wait(worker->barrier);
+    worker->start_ns = bench_clock_ns();
+
+    // Threads start at different lines so they do not walk the corpus in step
+    size_t index = worker->first_input;
+    for (size_t i = 0; i < worker->iterations && !worker->failed; i++) {
+        uint64_t start = bench_clock_ns();
+        if (match_one(targets, worker->engine, index, &worker->failed)) {
+            worker->matched++;
+        }
+        worker->latencies[i] = bench_clock_ns() - start;
+        index = (index + 1) % targets->num_inputs;
+    }
+    worker->end_ns = bench_clock_ns();
+
+    if (worker->engine == ENGINE_BYTECODE) {
+        rift_bytecode_vm_pool_evict(targets->program);
+    }
+    return NULL;
+}
+
+static int
+compare_latencies(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+/**
+ * @brief Get a percentile of sorted latencies by the nearest-rank method
+ *
+ * @param sorted The latencies in increasing order
+ * @param count Number of latencies
+ * @param permille The percentile in thousandths
+ * @return The latency
+ */
+static uint64_t
+percentile(const uint64_t *sorted, size_t count, unsigned permille)
+{
+    if (count == 0) {
+        return 0;
+    }
+    size_t rank = (count * permille + 999) / 1000;
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+/**
+ * @brief Fill the latency fields of a result
+ *
+ * @param result The result
+ * @param latencies The latencies, sorted in place
+ * @param count Number of latencies
+ */
+static void
+summarize_latencies(bench_result_t *result, uint64_t *latencies, size_t count)
+{
+    qsort(latencies, count, sizeof(uint64_t), compare_latencies);
+    result->p50_ns = percentile(latencies, count, 500);
+    result->p99_ns = percentile(latencies, count, 990);
+    result->p999_ns = percentile(latencies, count, 999);
+    result->matches_per_sec =
+        result->wall_ns > 0 ? (double)result->matches * 1e9 / (double)result->wall_ns : 0.0;
+}
+
+/**
+ * @brief Run an engine on its own threads
+ *
+ * @param targets The compiled pattern and corpus
+ * @param engine The engine
+ * @param threads Number of threads
+ * @param iterations Matches per thread
+ * @param result Result to fill
+ * @return true if successful, false otherwise
+ */
+static bool
+run_threaded(const bench_targets_t *targets, engine_t engine, size_t threads, size_t iterations,
+             bench_result_t *result)
+{
+    bench_worker_t *workers = calloc(threads, sizeof(bench_worker_t));
+    pthread_t *handles = calloc(threads, sizeof(pthread_t));
+    uint64_t *latencies = malloc(threads * iterations * sizeof(uint64_t));
+    pthread_barrier_t barrier;
+    if (!workers || !handles || !latencies ||
+        pthread_barrier_init(&barrier, NULL, (unsigned)threads + 1) != 0) {
+        free(workers);
+        free(handles);
+        free(latencies);
+        return false;
+    }
+
+    size_t started = 0;
+    for (; started < threads; started++) {
+        bench_worker_t *worker = &workers[started];
+        worker->targets = targets;
+        worker->engine = engine;
+        worker->iterations = iterations;
+        worker->first_input = started * targets->num_inputs / threads;
+        worker->barrier = &barrier;
+        worker->latencies = latencies + started * iterations;
+        if (pthread_create(&handles[started], NULL, bench_worker_run, worker) != 0) {
+            break;
+        }
+    }
+    if (started < threads) {
+        // The barrier cannot be released without every thread; give up
+        fprintf(stderr, "Error: Failed to start %zu threads\n", threads);
+        exit(1);
+    }
+
+    pthread_barrier_wait(&barrier);
+    for (size_t i = 0; i < threads; i++) {
+        pthread_join(handles[i], NULL);
+    }
+    pthread_barrier_destroy(&barrier);
+
+    // Wall time runs from the first thread's start to the last one's end, as
+    // this thread may be scheduled out for a while after the barrier
+    bool failed = false;
+    uint64_t start = UINT64_MAX;
+    uint64_t end = 0;
+    result->matched = 0;
+    for (size_t i = 0; i < threads; i++) {
+        failed |= workers[i].failed;
+        result->matched += workers[i].matched;
+        start = workers[i].start_ns < start ? workers[i].start_ns : start;
+        end = workers[i].end_ns > end ? workers[i].end_ns : end;
+    }
+    result->wall_ns = end - start;
+    result->engine = engine;
+    result->threads = threads;
+    result->matches = threads * iterations;
+    result->latency_of = "match";
+    summarize_latencies(result, latencies, threads * iterations);
+
+    free(workers);
+    free(handles);
+    free(latencies);
+    return !failed;
+}
+
+/**
+ * @brief Run the batch API with its own worker threads
+ *
+ * Each call matches the whole corpus, so the latencies are per batch.
+ *
+ * @param targets The compiled pattern and corpus
+ * @param threads Number of batch threads, including the caller's
+ * @param iterations Matches to make, rounded up to whole batches
+ * @param result Result to fill
+ * @return true if successful, false otherwise
+ */
+static bool
+run_batch(const bench_targets_t *targets, size_t threads, size_t iterations,
+          bench_result_t *result)
+{
+    size_t rounds = (threads * iterations + targets->num_inputs - 1) / targets->num_inputs;
+    rift_batch_result_t *results = malloc(targets->num_inputs * sizeof(rift_batch_result_t));
+    uint64_t *latencies = malloc(rounds * sizeof(uint64_t));
+    if (!results || !latencies) {
+        free(results);
+        free(latencies);
+        return false;
+    }
+
+    const rift_regex_pattern_t *patterns[1] = {targets->pattern};
+    rift_batch_options_t options = {0};
+    options.num_threads = threads;
+
+    bool ok = true;
+    result->matched = 0;
+    uint64_t start = bench_clock_ns();
+    for (size_t round = 0; round < rounds && ok; round++) {
+        uint64_t batch_start = bench_clock_ns();
+        ok = rift_match_batch(patterns, 1, (const char *const *)targets->inputs,
+                              targets->lengths, targets->num_inputs, results, &options);
+        latencies[round] = bench_clock_ns() - batch_start;
+        for (size_t i = 0; ok && i < targets->num_inputs; i++) {
+            result->matched += results[i].matched;
+        }
+    }
+    result->wall_ns = bench_clock_ns() - start;
+
+    result->engine = ENGINE_BATCH;
+    result->threads = threads;
+    result->matches = rounds * targets->num_inputs;
+    result->latency_of = "batch";
+    summarize_latencies(result, latencies, rounds);
+
+    free(results);
+    free(latencies);
+    return ok;
+}
+
+/**
+ * @brief Generate the corpus
+ *
+ * Two lines in three name a user and match the default pattern.
+ *
+ * @param targets Targets to store the corpus in
+ * @return true if successful, false otherwise
+ */
+static bool
+generate_corpus(bench_targets_t *targets)
+{
+    static const char *methods[] = {"GET", "POST", "PUT", "DELETE"};
+
+    targets->inputs = calloc(CORPUS_SIZE, sizeof(char *));
+    targets->lengths = calloc(CORPUS_SIZE, sizeof(size_t));
+    if (!targets->inputs || !targets->lengths) {
+        return false;
+    }
+    targets->num_inputs = CORPUS_SIZE;
+
+    for (size_t i = 0; i < CORPUS_SIZE; i++) {
+        char line[160];
+        if (i % 3 == 0) {
+            snprintf(line, sizeof(line), "%s /static/assets/app.css HTTP/1.1 status=304 anonymous",
+                     methods[i % 4]);
+        } else {
+            snprintf(line, sizeof(line),
+                     "%s /api/v%zu/items/%zu HTTP/1.1 status=200 user%zu session=%08zx",
+                     methods[i % 4], i % 3 + 1, i * 7919 % 10007, i * 31 % 997, i * 2654435761u);
+        }
+        targets->inputs[i] = strdup(line);
+        if (!targets->inputs[i]) {
+            return false;
+        }
+        targets->lengths[i] = strlen(line);
+    }
+    return true;
+}
+
+/**
+ * @brief Compile the pattern for every engine and build the corpus
+ *
+ * The DFA table answers whole-input matches only, so it is built from the
+ * pattern surrounded by .* to find it anywhere in a line like the others.
+ *
+ * @param targets Targets to fill
+ * @param source The pattern
+ * @return true if successful, false otherwise
+ */
+static bool
+prepare_targets(bench_targets_t *targets, const char *source)
+{
+    rift_regex_error_t error = {0};
+    memset(targets, 0, sizeof(*targets));
+
+    targets->pattern = rift_regex_compile(source, RIFT_REGEX_FLAG_NONE, &error);
+    targets->automaton = rift_regex_compile_pattern(source, RIFT_REGEX_FLAG_NONE, &error);
+    targets->program = rift_bytecode_compile(source, RIFT_REGEX_FLAG_NONE, &error);
+    if (!targets->pattern || !targets->automaton || !targets->program) {
+        fprintf(stderr, "Error: Failed to compile pattern: %s\n", error.message);
+        return false;
+    }
+
+    size_t length = strlen(source) + 7;
+    char *unanchored = malloc(length);
+    if (!unanchored) {
+        return false;
+    }
+    snprintf(unanchored, length, ".*(%s).*", source);
+    rift_regex_automaton_t *nfa =
+        rift_regex_compile_pattern(unanchored, RIFT_REGEX_FLAG_NONE, &error);
+    free(unanchored);
+    rift_regex_automaton_t *dfa = nfa ? rift_automaton_nfa_to_dfa(nfa, &error) : NULL;
+    targets->table = dfa ? rift_dfa_table_compile(dfa, &error) : NULL;
+    if (dfa) {
+        rift_automaton_free(dfa);
+    }
+    if (nfa) {
+        rift_automaton_free(nfa);
+    }
+    if (!targets->table) {
+        fprintf(stderr, "Error: Failed to build DFA table: %s\n", error.message);
+        return false;
+    }
+
+    targets->context =
+        rift_thread_safe_context_create(targets->automaton, 10, MAX_BACKTRACK_DEPTH);
+    if (!targets->context) {
+        fprintf(stderr, "Error: Failed to create thread-safe context\n");
+        return false;
+    }
+
+    return generate_corpus(targets);
+}
+
+static void
+free_targets(bench_targets_t *targets)
+{
+    if (targets->context) {
+        rift_thread_safe_context_free(targets->context);
+    }
+    if (targets->table) {
+        rift_dfa_table_free(targets->table);
+    }
+    if (targets->program) {
+        rift_bytecode_program_free(targets->program);
+    }
+    if (targets->automaton) {
+        rift_automaton_free(targets->automaton);
+    }
+    if (targets->pattern) {
+        rift_regex_pattern_free(targets->pattern);
+    }
+    if (targets->inputs) {
+        for (size_t i = 0; i < targets->num_inputs; i++) {
+            free(targets->inputs[i]);
+        }
+    }
+    free(targets->inputs);
+    free(targets->lengths);
+}
+
+static void
+print_header(FILE *out, output_format_t format)
+{
+    switch (format) {
+    case FORMAT_CSV:
+        fprintf(out, "engine,threads,matches,matched,wall_ns,matches_per_sec,"
+                     "p50_ns,p99_ns,p999_ns,latency_of\n");
+        break;
+    case FORMAT_JSON:
+        fprintf(out, "[\n");
+        break;
+    default:
+        fprintf(out, "%-16s %7s %10s %12s %14s %10s %10s %10s  %s\n", "engine", "threads",
+                "matches", "wall_ms", "matches/s", "p50_ns", "p99_ns", "p999_ns", "latency of");
+        break;
+    }
+}
+
+static void
+print_result(FILE *out, output_format_t format, const bench_result_t *result, bool first)
+{
+    const char *name = engine_names[result->engine];
+
+    switch (format) {
+    case FORMAT_CSV:
+        fprintf(out, "%s,%zu,%zu,%zu,%llu,%.1f,%llu,%llu,%llu,%s\n", name, result->threads,
+                result->matches, result->matched, (unsigned long long)result->wall_ns,
+                result->matches_per_sec, (unsigned long long)result->p50_ns,
+                (unsigned long long)result->p99_ns, (unsigned long long)result->p999_ns,
+                result->latency_of);
+        break;
+    case FORMAT_JSON:
+        fprintf(out,
+                "%s  {\"engine\": \"%s\", \"threads\": %zu, \"matches\": %zu, \"matched\": %zu, "
+                "\"wall_ns\": %llu, \"matches_per_sec\": %.1f, \"p50_ns\": %llu, "
+                "\"p99_ns\": %llu, \"p999_ns\": %llu, \"latency_of\": \"%s\"}",
+                first ? "" : ",\n", name, result->threads, result->matches, result->matched,
+                (unsigned long long)result->wall_ns, result->matches_per_sec,
+                (unsigned long long)result->p50_ns, (unsigned long long)result->p99_ns,
+                (unsigned long long)result->p999_ns, result->latency_of);
+        break;
+    default:
+        fprintf(out, "%-16s %7zu %10zu %12.3f %14.0f %10llu %10llu %10llu  %s\n", name,
+                result->threads, result->matches, (double)result->wall_ns / 1e6,
+                result->matches_per_sec, (unsigned long long)result->p50_ns,
+                (unsigned long long)result->p99_ns, (unsigned long long)result->p999_ns,
+                result->latency_of);
+        break;
+    }
+    fflush(out);
+}
+
+static void
+print_footer(FILE *out, output_format_t format, bool any)
+{
+    if (format == FORMAT_JSON) {
+        fprintf(out, "%s]\n", any ? "\n" : "");
+    }
+}
+
+static void
+print_usage(const char *program)
+{
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --threads N      Highest thread count (default: online CPUs)\n"
+            "  --iterations N   Matches per thread and run (default: %d)\n"
+            "  --pattern P      Pattern to match (default: %s)\n"
+            "  --engines LIST   Comma-separated engines (default: all)\n"
+            "                   bytecode, dfa, context_match, context_execute, batch\n"
+            "  --format F       table, csv or json (default: table)\n"
+            "  --output FILE    Write the results to FILE instead of stdout\n",
+            program, DEFAULT_ITERATIONS, DEFAULT_PATTERN);
+}
+
+/**
+ * @brief Parse a comma-separated list of engine names
+ *
+ * @param list The list
+ * @param selected Set to true for every engine in the list
+ * @return true if every name is known, false otherwise
+ */
+static bool
+parse_engines(const char *list, bool selected[ENGINE_COUNT])
+{
+    memset(selected, 0, ENGINE_COUNT * sizeof(bool));
+    while (*list) {
+        size_t length = strcspn(list, ",");
+        bool known = false;
+        for (int i = 0; i < ENGINE_COUNT; i++) {
+            if (strlen(engine_names[i]) == length && strncmp(list, engine_names[i], length) == 0) {
+                selected[i] = true;
+                known = true;
+            }
+        }
+        if (!known) {
+            return false;
+        }
+        list += length;
+        if (*list == ',') {
+            list++;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Main function
+ *
+ * @param argc Argument count
+ * @param argv Arguments
+ * @return Exit code
+ */
+int
+main(int argc, char **argv)
+{
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t max_threads = cpus > 0 ? (size_t)cpus : 1;
+    size_t iterations = DEFAULT_ITERATIONS;
+    const char *pattern = DEFAULT_PATTERN;
+    const char *output_path = NULL;
+    output_format_t format = FORMAT_TABLE;
+    bool selected[ENGINE_COUNT];
+    for (int i = 0; i < ENGINE_COUNT; i++) {
+        selected[i] = true;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--threads") == 0 && value) {
+            max_threads = strtoul(value, NULL, 10);
+        } else if (strcmp(argv[i], "--iterations") == 0 && value) {
+            iterations = strtoul(value, NULL, 10);
+        } else if (strcmp(argv[i], "--pattern") == 0 && value) {
+            pattern = value;
+        } else if (strcmp(argv[i], "--engines") == 0 && value) {
+            if (!parse_engines(value, selected)) {
+                fprintf(stderr, "Error: Unknown engine in '%s'\n", value);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--format") == 0 && value) {
+            if (strcmp(value, "csv") == 0) {
+                format = FORMAT_CSV;
+            } else if (strcmp(value, "json") == 0) {
+                format = FORMAT_JSON;
+            } else if (strcmp(value, "table") == 0) {
+                format = FORMAT_TABLE;
+            } else {
+                fprintf(stderr, "Error: Unknown format '%s'\n", value);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--output") == 0 && value) {
+            output_path = value;
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+        i++;
+    }
+    if (max_threads == 0 || iterations == 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    bench_targets_t targets;
+    if (!prepare_targets(&targets, pattern)) {
+        free_targets(&targets);
+        return 1;
+    }
+
+    FILE *out = output_path ? fopen(output_path, "w") : stdout;
+    if (!out) {
+        fprintf(stderr, "Error: Failed to open '%s'\n", output_path);
+        free_targets(&targets);
+        return 1;
+    }
+
+    // Thread counts double from 1 and end with the highest one
+    print_header(out, format);
+    bool any = false;
+    int status = 0;
+    for (int engine = 0; engine < ENGINE_COUNT; engine++) {
+        if (!selected[engine]) {
+            continue;
+        }
+        for (size_t threads = 1;; threads = threads * 2 < max_threads ? threads * 2 : max_threads) {
+            bench_result_t result;
+            bool ok = engine == ENGINE_BATCH
+                          ? run_batch(&targets, threads, iterations, &result)
+                          : run_threaded(&targets, (engine_t)engine, threads, iterations, &result);
+            if (!ok) {
+                fprintf(stderr, "Error: %s failed with %zu threads\n", engine_names[engine],
+                        threads);
+                status = 1;
+                break;
+            }
+            print_result(out, format, &result, !any);
+            any = true;
+            if (threads == max_threads) {
+                break;
+            }
+        }
+    }
+    print_footer(out, format, any);
+
+    if (out != stdout) {
+        fclose(out);
+    }
+    free_targets(&targets);
+    return status;
+}
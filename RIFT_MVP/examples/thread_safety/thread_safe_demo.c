@@ -3,7 +3,9 @@
  * @brief Demonstration of thread-safe regex operations with LibRift
  *
  * This file provides a demonstration of using the thread-safe context
- * and backtracker implementations in a multi-threaded environment.
+ * and backtracker implementations in a multi-threaded environment. Every
+ * thread passes its own input with each call, so the threads share one
+ * context without serializing their setup.
  *
  * @copyright Copyright (c) 2025 LibRift Project
  * @license MIT License
@@ -29,12 +31,17 @@
 /* Maximum backtracking depth */
 #define MAX_BACKTRACK_DEPTH 1000
 
+/* Pattern every thread matches its input against */
+#define DEMO_PATTERN "[a-z]+s"
+
 /* Thread argument structure */
 typedef struct {
     rift_regex_thread_safe_context_t *context;
     const char *input;
     int thread_id;
     bool success;
+    bool matched;
+    rift_regex_match_t match;
 } thread_arg_t;
 
 /**
@@ -95,14 +102,19 @@ thread_function(void *arg)
     thread_arg_t *thread_arg = (thread_arg_t *)arg;
     rift_regex_error_t error = {0};
 
-    /* Execute the matcher callback with thread-local context */
-    thread_arg->success =
-        rift_thread_safe_context_execute(thread_arg->context, matcher_callback, thread_arg, &error);
+    /* Execute the matcher callback on this thread's input with its thread-local context */
+    thread_arg->success = rift_thread_safe_context_execute(
+        thread_arg->context, thread_arg->input, (size_t)-1, matcher_callback, thread_arg, &error);
 
     if (!thread_arg->success) {
         printf("Thread %d: Error: %s\n", thread_arg->thread_id, error.message);
+        return NULL;
     }
 
+    /* Match the same input against the shared automaton */
+    thread_arg->matched = rift_thread_safe_context_match(thread_arg->context, thread_arg->input,
+                                                         (size_t)-1, &thread_arg->match);
+
     return NULL;
 }
 
@@ -120,10 +132,12 @@ main(void)
                                        "Backtracking limits",  "No more race conditions",
                                        "Thread-local storage", "Synchronization primitives"};
 
-    /* Create a simple automaton for demonstration */
-    rift_regex_automaton_t *automaton = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    /* Compile the pattern the threads share */
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *automaton =
+        rift_regex_compile_pattern(DEMO_PATTERN, RIFT_REGEX_FLAG_NONE, &error);
     if (!automaton) {
-        fprintf(stderr, "Error: Failed to create automaton\n");
+        fprintf(stderr, "Error: Failed to compile pattern: %s\n", error.message);
         return 1;
     }
 
@@ -142,35 +156,40 @@ main(void)
 
     printf("Starting %d threads with different inputs\n", NUM_THREADS);
 
-    /* Create and start threads */
+    /* Create and start threads; each one passes its input with its own calls */
+    bool started[NUM_THREADS];
     for (int i = 0; i < NUM_THREADS; i++) {
         thread_args[i].context = context;
         thread_args[i].input = inputs[i];
         thread_args[i].thread_id = i;
         thread_args[i].success = false;
+        thread_args[i].matched = false;
 
-        /* Set input for this thread */
-        if (!rift_thread_safe_context_set_input(context, inputs[i], (size_t)-1)) {
-            fprintf(stderr, "Error: Failed to set input for thread %d\n", i);
-            continue;
-        }
-
-        /* Create thread */
-        if (pthread_create(&threads[i], NULL, thread_function, &thread_args[i]) != 0) {
+        started[i] = pthread_create(&threads[i], NULL, thread_function, &thread_args[i]) == 0;
+        if (!started[i]) {
             fprintf(stderr, "Error: Failed to create thread %d\n", i);
-            continue;
         }
     }
 
     /* Wait for all threads to complete */
     for (int i = 0; i < NUM_THREADS; i++) {
-        pthread_join(threads[i], NULL);
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        }
     }
 
     /* Print results */
-    printf("\nResults:\n");
+    printf("\nResults for " DEMO_PATTERN ":\n");
     for (int i = 0; i < NUM_THREADS; i++) {
-        printf("Thread %d: %s\n", i, thread_args[i].success ? "Success" : "Failed");
+        if (!thread_args[i].success) {
+            printf("Thread %d: Failed\n", i);
+        } else if (thread_args[i].matched) {
+            printf("Thread %d: Success, matched '%.*s'\n", i,
+                   (int)(thread_args[i].match.end_pos - thread_args[i].match.start_pos),
+                   thread_args[i].input + thread_args[i].match.start_pos);
+        } else {
+            printf("Thread %d: Success, no match\n", i);
+        }
     }
 
     /* Clean up */
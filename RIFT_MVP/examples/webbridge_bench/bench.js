@@ -0,0 +1,399 @@
+/**
+ * @file bench.js
+ * @brief Web bridge benchmark, shared by bench.html and run_bench.mjs
+ *
+ * Measures, for the Wasm build of LibRift, the time to compile and
+ * instantiate the module, the time to compile each pattern, the scan time
+ * per byte of each corpus through rift_webbridge_find_all_batch and through
+ * a rift_webbridge_find_next loop, and the cost of one call of the small
+ * exports. native_benchmark.c measures the same workloads on the native
+ * build; the difference is the cost of crossing between JS and Wasm.
+ *
+ * Browsers coarsen performance.now(), so every time is taken over many
+ * calls or a whole corpus, and each measurement reports the median of its
+ * repetitions.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+/** Bytes in each corpus when no size is given */
+export const DEFAULT_CORPUS_BYTES = 1024 * 1024;
+
+/** Timed repetitions of each measurement, of which the median is reported */
+export const DEFAULT_REPEATS = 7;
+
+/** Calls per repetition of the call-cost measurements */
+const CALL_ITERATIONS = 100000;
+
+/** Compilations per repetition of the compile-time measurement */
+const COMPILE_ITERATIONS = 200;
+
+/** Words of the batch span array header, RIFT_WEBBRIDGE_BATCH_HEADER_WORDS */
+const BATCH_HEADER_WORDS = 2;
+
+/** Workloads, kept in step with native_benchmark.c */
+export const CORPORA = [
+  { name: 'log', kind: 0,
+    patterns: ['status=5[0-9][0-9]', 'user[0-9]+', '(GET|POST) /api/v1/items/[0-9]+'] },
+  { name: 'prose', kind: 1, patterns: ['quick', '[a-z]+ing', 'the (lazy|quick) [a-z]+'] },
+  { name: 'dna', kind: 2, patterns: ['ACGTACGT', 'GA(T|C)TACA', 'T[AG]{4}C'] },
+];
+
+/** Entry points whose per-call cost is measured, kept in step with native_benchmark.c */
+export const CALLS = ['set_input', 'matches', 'set_input_find_next'];
+
+/** Exports of librift.mjs the benchmark calls */
+const REQUIRED_EXPORTS = [
+  '_malloc', '_free', '_rift_webbridge_init', '_rift_webbridge_cleanup',
+  '_rift_webbridge_compile', '_rift_webbridge_free_pattern', '_rift_webbridge_create_matcher',
+  '_rift_webbridge_free_matcher', '_rift_webbridge_set_input', '_rift_webbridge_get_input_buffer',
+  '_rift_webbridge_set_input_length', '_rift_webbridge_matches', '_rift_webbridge_find_next',
+  '_rift_webbridge_find_all_batch',
+];
+
+const METHODS = ['GET', 'POST', 'PUT', 'DELETE'];
+const STATUSES = [200, 200, 200, 304, 404, 500];
+const WORDS = ['the', 'quick', 'brown', 'fox', 'jumps', 'over', 'lazy', 'dog',
+               'running', 'nothing', 'sing', 'while', 'reading', 'a', 'long', 'evening'];
+const BASES = 'ACGT';
+
+/**
+ * Generate a corpus, byte for byte as native_benchmark.c does
+ *
+ * @param {number} kind Index of the generator
+ * @param {number} size Number of bytes to generate
+ * @return {Uint8Array} The corpus
+ */
+export function generateCorpus(kind, size) {
+  // 32-bit linear congruential generator, upper bits returned
+  let state = (kind + 1) >>> 0;
+  const random = () => {
+    state = (Math.imul(state, 1103515245) + 12345) >>> 0;
+    return (state >>> 16) & 0x7fff;
+  };
+
+  const lines = [];
+  let length = 0;
+  while (length < size) {
+    let line = '';
+    if (kind === 0) {
+      const method = METHODS[random() % 4];
+      const item = random() % 10000;
+      const status = STATUSES[random() % 6];
+      const user = random() % 1000;
+      line = `${method} /api/v1/items/${item} HTTP/1.1 status=${status} user${user}\n`;
+    } else if (kind === 1) {
+      for (let i = 0; i < 8; i++) {
+        line += WORDS[random() % 16] + (i === 7 ? '\n' : ' ');
+      }
+    } else {
+      for (let i = 0; i < 63; i++) {
+        line += BASES[random() % 4];
+      }
+      line += '\n';
+    }
+    lines.push(line);
+    length += line.length;
+  }
+  return new TextEncoder().encode(lines.join('')).subarray(0, size);
+}
+
+/**
+ * Get the median of the repetitions of a measurement
+ *
+ * @param {number[]} times The times
+ * @return {number} The median
+ */
+function median(times) {
+  const sorted = [...times].sort((a, b) => a - b);
+  const middle = sorted.length >> 1;
+  return sorted.length % 2 ? sorted[middle] : (sorted[middle - 1] + sorted[middle]) / 2;
+}
+
+/**
+ * Time a function over several repetitions
+ *
+ * @param {number} repeats Number of repetitions
+ * @param {number} units Units of work per repetition, the result is per unit
+ * @param {function(): void} run The work of one repetition
+ * @return {number} Median nanoseconds per unit
+ */
+function measure(repeats, units, run) {
+  const times = [];
+  for (let r = 0; r < repeats; r++) {
+    const start = performance.now();
+    run();
+    times.push(((performance.now() - start) * 1e6) / units);
+  }
+  return median(times);
+}
+
+/**
+ * Round a time for the JSON output
+ *
+ * @param {number} value The time
+ * @param {number} digits Digits after the decimal point
+ * @return {number} The rounded time
+ */
+function round(value, digits) {
+  const scale = 10 ** digits;
+  return Math.round(value * scale) / scale;
+}
+
+/**
+ * Compile and instantiate the Wasm module, timing both steps
+ *
+ * @param {function(Object): Promise<Object>} factory The MODULARIZE factory of librift.mjs
+ * @param {Uint8Array} wasmBytes Contents of librift.wasm
+ * @return {Promise<{module: Object, timing: Object}>} The module and its load times
+ */
+export async function loadModule(factory, wasmBytes) {
+  const compileStart = performance.now();
+  const wasmModule = await WebAssembly.compile(wasmBytes);
+  const compileMs = performance.now() - compileStart;
+
+  let instantiateMs = 0;
+  const module = await factory({
+    instantiateWasm(imports, receiveInstance) {
+      const start = performance.now();
+      WebAssembly.instantiate(wasmModule, imports).then((instance) => {
+        instantiateMs = performance.now() - start;
+        receiveInstance(instance, wasmModule);
+      });
+      return {};
+    },
+  });
+
+  return {
+    module,
+    timing: {
+      bytes: wasmBytes.length,
+      compile_ms: round(compileMs, 3),
+      instantiate_ms: round(instantiateMs, 3),
+    },
+  };
+}
+
+/**
+ * Copy a string into Wasm memory, NUL terminated
+ *
+ * @param {Object} M The module
+ * @param {string} text The string
+ * @return {number} Pointer to the copy, to release with M._free
+ */
+function allocString(M, text) {
+  const bytes = new TextEncoder().encode(text);
+  const pointer = M._malloc(bytes.length + 1);
+  M.HEAPU8.set(bytes, pointer);
+  M.HEAPU8[pointer + bytes.length] = 0;
+  return pointer;
+}
+
+/**
+ * Benchmark one pattern over a corpus
+ *
+ * @param {Object} M The module
+ * @param {string} pattern The pattern
+ * @param {Uint8Array} corpus The corpus
+ * @param {number} repeats Number of repetitions
+ * @return {Object} The results of the pattern
+ */
+function benchPattern(M, pattern, corpus, repeats) {
+  const patternPointer = allocString(M, pattern);
+  const compileNs = measure(repeats, COMPILE_ITERATIONS, () => {
+    for (let i = 0; i < COMPILE_ITERATIONS; i++) {
+      M._rift_webbridge_free_pattern(M._rift_webbridge_compile(patternPointer, 0));
+    }
+  });
+
+  const patternHandle = M._rift_webbridge_compile(patternPointer, 0);
+  M._free(patternPointer);
+  const matcher = patternHandle ? M._rift_webbridge_create_matcher(patternHandle, 0) : 0;
+  if (!matcher) {
+    M._rift_webbridge_free_pattern(patternHandle);
+    throw new Error(`Failed to compile '${pattern}'`);
+  }
+
+  // The corpus goes straight into the matcher's own buffer, which the batch
+  // call matches in place; the copy is timed on its own
+  const input = M._rift_webbridge_get_input_buffer(matcher, corpus.length);
+  const copyNs = measure(repeats, corpus.length, () => M.HEAPU8.set(corpus, input));
+
+  // Room for two spans per byte, a match and one group, holds every match of
+  // these patterns, so no batch is cut short
+  const maxWords = BATCH_HEADER_WORDS + 4 * corpus.length;
+  const spans = M._malloc(maxWords * 4);
+  let batchMatches = 0;
+  const scanNs = measure(repeats, corpus.length, () => {
+    batchMatches = M._rift_webbridge_find_all_batch(matcher, input, corpus.length, spans, maxWords);
+  });
+
+  const bounds = M._malloc(8);
+  let loopMatches = 0;
+  const findNextNs = measure(repeats, corpus.length, () => {
+    M._rift_webbridge_set_input_length(matcher, corpus.length);
+    let count = 0;
+    while (M._rift_webbridge_find_next(matcher, bounds, bounds + 4)) {
+      count++;
+    }
+    loopMatches = count;
+  });
+
+  M._free(bounds);
+  M._free(spans);
+  M._rift_webbridge_free_matcher(matcher);
+  M._rift_webbridge_free_pattern(patternHandle);
+
+  if (loopMatches !== batchMatches) {
+    throw new Error(`'${pattern}': find_next found ${loopMatches} matches, ` +
+                    `the batch ${batchMatches}`);
+  }
+  return {
+    pattern,
+    compile_ns: round(compileNs, 1),
+    scan_ns_per_byte: round(scanNs, 4),
+    find_next_ns_per_byte: round(findNextNs, 4),
+    copy_ns_per_byte: round(copyNs, 4),
+    matches: batchMatches,
+  };
+}
+
+/**
+ * Measure the cost of one call of each small export on a one-byte input
+ *
+ * @param {Object} M The module
+ * @param {number} repeats Number of repetitions
+ * @return {Object[]} The cost of each entry of CALLS
+ */
+function benchCalls(M, repeats) {
+  const patternPointer = allocString(M, 'a');
+  const inputPointer = allocString(M, 'a');
+  const bounds = M._malloc(8);
+  const patternHandle = M._rift_webbridge_compile(patternPointer, 0);
+  const matcher = patternHandle ? M._rift_webbridge_create_matcher(patternHandle, 0) : 0;
+  if (!matcher) {
+    throw new Error('Failed to compile the call-cost pattern');
+  }
+
+  const bodies = {
+    set_input: () => M._rift_webbridge_set_input(matcher, inputPointer, 1),
+    matches: () => M._rift_webbridge_matches(matcher),
+    set_input_find_next: () => {
+      M._rift_webbridge_set_input(matcher, inputPointer, 1);
+      return M._rift_webbridge_find_next(matcher, bounds, bounds + 4);
+    },
+  };
+
+  M._rift_webbridge_set_input(matcher, inputPointer, 1);
+  const results = CALLS.map((api) => {
+    const body = bodies[api];
+    let sink = 0;
+    const ns = measure(repeats, CALL_ITERATIONS, () => {
+      for (let i = 0; i < CALL_ITERATIONS; i++) {
+        sink += body();
+      }
+    });
+    if (sink < 0) {
+      throw new Error('unreachable');
+    }
+    return { api, ns_per_call: round(ns, 2) };
+  });
+
+  M._rift_webbridge_free_matcher(matcher);
+  M._rift_webbridge_free_pattern(patternHandle);
+  M._free(bounds);
+  M._free(inputPointer);
+  M._free(patternPointer);
+  return results;
+}
+
+/**
+ * Run every benchmark
+ *
+ * @param {Object} options
+ * @param {function(Object): Promise<Object>} options.factory The factory of librift.mjs
+ * @param {Uint8Array} options.wasmBytes Contents of librift.wasm
+ * @param {string} options.environment Where the benchmark runs, for the results
+ * @param {number} [options.bytes] Bytes in each corpus
+ * @param {number} [options.repeats] Repetitions of each measurement
+ * @param {function(string): void} [options.log] Receives progress messages
+ * @return {Promise<Object>} The results, in the layout of native_benchmark.c plus
+ *         the module load times
+ */
+export async function runBenchmarks({
+  factory,
+  wasmBytes,
+  environment,
+  bytes = DEFAULT_CORPUS_BYTES,
+  repeats = DEFAULT_REPEATS,
+  log = () => {},
+}) {
+  const { module: M, timing } = await loadModule(factory, wasmBytes);
+
+  // A module built before the bridge sources were linked in lacks the exports
+  const missing = REQUIRED_EXPORTS.filter((name) => typeof M[name] !== 'function');
+  if (missing.length > 0) {
+    throw new Error(`librift.mjs does not export ${missing.join(', ')}; rebuild it with make wasm`);
+  }
+  if (!M._rift_webbridge_init()) {
+    throw new Error('rift_webbridge_init failed');
+  }
+
+  const corpora = CORPORA.map(({ name, kind, patterns }) => {
+    const corpus = generateCorpus(kind, bytes);
+    return {
+      name,
+      patterns: patterns.map((pattern) => {
+        log(`${name}: ${pattern}`);
+        return benchPattern(M, pattern, corpus, repeats);
+      }),
+    };
+  });
+
+  log('calls');
+  const calls = benchCalls(M, repeats);
+  M._rift_webbridge_cleanup();
+
+  return { platform: 'wasm', environment, corpus_bytes: bytes, module: timing, corpora, calls };
+}
+
+/**
+ * Compare Wasm results with native ones
+ *
+ * @param {Object} native Output of native_benchmark
+ * @param {Object} wasm Output of runBenchmarks
+ * @return {Object} Per-pattern slowdowns and per-call overheads; mismatches
+ *         lists the patterns whose match counts differ
+ */
+export function compareResults(native, wasm) {
+  const patterns = [];
+  const mismatches = [];
+  for (const corpus of wasm.corpora) {
+    const nativeCorpus = native.corpora.find((c) => c.name === corpus.name);
+    for (const result of corpus.patterns) {
+      const base = nativeCorpus?.patterns.find((p) => p.pattern === result.pattern);
+      if (!base) {
+        continue;
+      }
+      if (base.matches !== result.matches) {
+        mismatches.push({ corpus: corpus.name, pattern: result.pattern,
+                          native: base.matches, wasm: result.matches });
+      }
+      patterns.push({
+        corpus: corpus.name,
+        pattern: result.pattern,
+        compile_ratio: round(result.compile_ns / base.compile_ns, 3),
+        scan_ratio: round(result.scan_ns_per_byte / base.scan_ns_per_byte, 3),
+        find_next_ratio: round(result.find_next_ns_per_byte / base.scan_ns_per_byte, 3),
+      });
+    }
+  }
+
+  const calls = wasm.calls.map(({ api, ns_per_call }) => {
+    const base = native.calls.find((c) => c.api === api);
+    return { api, overhead_ns: base ? round(ns_per_call - base.ns_per_call, 2) : null };
+  });
+
+  return { patterns, calls, mismatches };
+}
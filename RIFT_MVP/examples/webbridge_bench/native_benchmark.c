@@ -0,0 +1,376 @@
+/**
+ * @file native_benchmark.c
+ * @brief Native baseline of the web bridge benchmark
+ *
+ * This application runs the workloads of bench.js on the native build,
+ * through the direct mode of the bridge API, and prints the same JSON
+ * fields: the time to compile each pattern, the scan time per byte of each
+ * corpus and the cost of one call of the small entry points. run_bench.mjs
+ * subtracts these from the Wasm results to get the JS to Wasm overhead.
+ *
+ * The corpora are generated, not read, with the same generator as
+ * bench.js, so both builds scan the same bytes without shipping data files.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "core/bytecode/bridge_direct.h"
+
+/* Bytes in each corpus when no size is given */
+#define DEFAULT_CORPUS_BYTES (1024 * 1024)
+
+/* Timed repetitions of each measurement, of which the median is reported */
+#define DEFAULT_REPEATS 7
+
+/* Calls per repetition of the call-cost measurements */
+#define CALL_ITERATIONS 100000
+
+/* Compilations per repetition of the compile-time measurement */
+#define COMPILE_ITERATIONS 200
+
+/* Largest number of patterns of a corpus */
+#define MAX_PATTERNS 3
+
+/* Corpus generators, kept in step with bench.js */
+typedef enum { CORPUS_LOG, CORPUS_PROSE, CORPUS_DNA, CORPUS_COUNT } corpus_kind_t;
+
+/* A corpus and the patterns scanned over it */
+typedef struct {
+    const char *name;
+    corpus_kind_t kind;
+    const char *patterns[MAX_PATTERNS];
+} bench_corpus_t;
+
+/* Workloads, kept in step with bench.js */
+static const bench_corpus_t corpora[CORPUS_COUNT] = {
+    {"log", CORPUS_LOG, {"status=5[0-9][0-9]", "user[0-9]+", "(GET|POST) /api/v1/items/[0-9]+"}},
+    {"prose", CORPUS_PROSE, {"quick", "[a-z]+ing", "the (lazy|quick) [a-z]+"}},
+    {"dna", CORPUS_DNA, {"ACGTACGT", "GA(T|C)TACA", "T[AG]{4}C"}},
+};
+
+/**
+ * @brief Read the monotonic clock
+ *
+ * @return Time in nanoseconds
+ */
+static uint64_t
+bench_clock_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief Draw the next number of the corpus generator
+ *
+ * A 32-bit linear congruential generator whose upper bits are returned, as
+ * bench.js can reproduce it exactly with Math.imul.
+ *
+ * @param state The generator state
+ * @return A number in [0, 32768)
+ */
+static uint32_t
+bench_random(uint32_t *state)
+{
+    *state = *state * 1103515245u + 12345u;
+    return (*state >> 16) & 0x7fff;
+}
+
+/**
+ * @brief Generate a corpus
+ *
+ * @param kind The generator
+ * @param size Number of bytes to generate
+ * @return The corpus, NUL terminated, or NULL on allocation failure
+ */
+static char *
+generate_corpus(corpus_kind_t kind, size_t size)
+{
+    static const char *methods[] = {"GET", "POST", "PUT", "DELETE"};
+    static const unsigned statuses[] = {200, 200, 200, 304, 404, 500};
+    static const char *words[] = {"the",     "quick", "brown",   "fox",    "jumps",  "over",
+                                  "lazy",    "dog",   "running", "nothing", "sing",   "while",
+                                  "reading", "a",     "long",    "evening"};
+    static const char bases[] = "ACGT";
+
+    // Lines are at most 80 bytes, so one more line always fits
+    char *corpus = malloc(size + 128);
+    if (!corpus) {
+        return NULL;
+    }
+
+    uint32_t state = (uint32_t)kind + 1;
+    size_t length = 0;
+    while (length < size) {
+        char *line = corpus + length;
+        switch (kind) {
+        case CORPUS_LOG: {
+            const char *method = methods[bench_random(&state) % 4];
+            unsigned item = bench_random(&state) % 10000;
+            unsigned status = statuses[bench_random(&state) % 6];
+            unsigned user = bench_random(&state) % 1000;
+            length += (size_t)sprintf(line, "%s /api/v1/items/%u HTTP/1.1 status=%u user%u\n",
+                                      method, item, status, user);
+            break;
+        }
+        case CORPUS_PROSE:
+            for (int i = 0; i < 8; i++) {
+                length += (size_t)sprintf(corpus + length, "%s%c",
+                                          words[bench_random(&state) % 16], i == 7 ? '\n' : ' ');
+            }
+            break;
+        default:
+            for (int i = 0; i < 63; i++) {
+                corpus[length++] = bases[bench_random(&state) % 4];
+            }
+            corpus[length++] = '\n';
+            break;
+        }
+    }
+
+    corpus[size] = '\0';
+    return corpus;
+}
+
+static int
+compare_times(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return x < y ? -1 : x > y;
+}
+
+/**
+ * @brief Get the median of the repetitions of a measurement
+ *
+ * @param times The times, sorted in place
+ * @param count Number of times
+ * @return The median
+ */
+static double
+median(double *times, size_t count)
+{
+    qsort(times, count, sizeof(double), compare_times);
+    return count % 2 ? times[count / 2] : (times[count / 2 - 1] + times[count / 2]) / 2.0;
+}
+
+/**
+ * @brief Measure the time to compile and free a pattern
+ *
+ * @param pattern The pattern
+ * @param repeats Number of repetitions
+ * @return Median nanoseconds per compilation, negative if it does not compile
+ */
+static double
+measure_compile(const char *pattern, size_t repeats)
+{
+    double times[DEFAULT_REPEATS * 4];
+    for (size_t r = 0; r < repeats; r++) {
+        uint64_t start = bench_clock_ns();
+        for (int i = 0; i < COMPILE_ITERATIONS; i++) {
+            rift_bridge_direct_pattern_t *compiled = rift_bridge_direct_compile(pattern, 0, NULL);
+            if (!compiled) {
+                return -1.0;
+            }
+            rift_bridge_direct_free_pattern(compiled);
+        }
+        times[r] = (double)(bench_clock_ns() - start) / COMPILE_ITERATIONS;
+    }
+    return median(times, repeats);
+}
+
+/**
+ * @brief Measure the time to find every match of a corpus
+ *
+ * @param matcher Matcher of the pattern
+ * @param corpus The corpus
+ * @param size Number of bytes in the corpus
+ * @param repeats Number of repetitions
+ * @param matches Set to the number of matches
+ * @return Median nanoseconds per corpus byte
+ */
+static double
+measure_scan(rift_bridge_direct_matcher_t *matcher, const char *corpus, size_t size,
+             size_t repeats, size_t *matches)
+{
+    double times[DEFAULT_REPEATS * 4];
+    for (size_t r = 0; r < repeats; r++) {
+        uint64_t start = bench_clock_ns();
+        rift_bridge_direct_set_input(matcher, corpus, size);
+        size_t count = 0;
+        while (rift_bridge_direct_find_next(matcher, NULL, NULL)) {
+            count++;
+        }
+        times[r] = (double)(bench_clock_ns() - start) / (double)size;
+        *matches = count;
+    }
+    return median(times, repeats);
+}
+
+/* Entry points whose per-call cost is measured, kept in step with bench.js */
+typedef enum { CALL_SET_INPUT, CALL_MATCHES, CALL_SET_INPUT_FIND_NEXT, CALL_COUNT } call_t;
+
+static const char *call_names[CALL_COUNT] = {"set_input", "matches", "set_input_find_next"};
+
+/**
+ * @brief Measure the cost of one call of an entry point on a one-byte input
+ *
+ * @param matcher Matcher of a literal pattern
+ * @param call The entry point
+ * @param repeats Number of repetitions
+ * @return Median nanoseconds per call
+ */
+static double
+measure_call(rift_bridge_direct_matcher_t *matcher, call_t call, size_t repeats)
+{
+    double times[DEFAULT_REPEATS * 4];
+    size_t start_pos = 0;
+    size_t end_pos = 0;
+    volatile size_t sink = 0;
+
+    rift_bridge_direct_set_input(matcher, "a", 1);
+    for (size_t r = 0; r < repeats; r++) {
+        uint64_t start = bench_clock_ns();
+        for (int i = 0; i < CALL_ITERATIONS; i++) {
+            switch (call) {
+            case CALL_SET_INPUT:
+                sink += rift_bridge_direct_set_input(matcher, "a", 1);
+                break;
+            case CALL_MATCHES:
+                sink += rift_bridge_direct_matches(matcher);
+                break;
+            default:
+                // The bridge has no rewind, so setting the input again starts over
+                sink += rift_bridge_direct_set_input(matcher, "a", 1);
+                sink += rift_bridge_direct_find_next(matcher, &start_pos, &end_pos);
+                break;
+            }
+        }
+        times[r] = (double)(bench_clock_ns() - start) / CALL_ITERATIONS;
+    }
+    (void)sink;
+    return median(times, repeats);
+}
+
+static void
+print_usage(const char *program)
+{
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --bytes N        Bytes in each corpus (default: %d)\n"
+            "  --repeats N      Repetitions of each measurement, up to %d (default: %d)\n"
+            "  --output FILE    Write the JSON results to FILE instead of stdout\n",
+            program, DEFAULT_CORPUS_BYTES, DEFAULT_REPEATS * 4, DEFAULT_REPEATS);
+}
+
+/**
+ * @brief Main function
+ *
+ * @param argc Argument count
+ * @param argv Arguments
+ * @return Exit code
+ */
+int
+main(int argc, char **argv)
+{
+    size_t size = DEFAULT_CORPUS_BYTES;
+    size_t repeats = DEFAULT_REPEATS;
+    const char *output_path = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (strcmp(argv[i], "--bytes") == 0 && value) {
+            size = strtoul(value, NULL, 10);
+        } else if (strcmp(argv[i], "--repeats") == 0 && value) {
+            repeats = strtoul(value, NULL, 10);
+        } else if (strcmp(argv[i], "--output") == 0 && value) {
+            output_path = value;
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+        i++;
+    }
+    if (size == 0 || repeats == 0 || repeats > DEFAULT_REPEATS * 4) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    FILE *out = output_path ? fopen(output_path, "w") : stdout;
+    if (!out) {
+        fprintf(stderr, "Error: Failed to open '%s'\n", output_path);
+        return 1;
+    }
+
+    int status = 0;
+    fprintf(out, "{\n  \"platform\": \"native\",\n  \"corpus_bytes\": %zu,\n", size);
+    fprintf(out, "  \"corpora\": [");
+    for (int c = 0; c < CORPUS_COUNT; c++) {
+        const bench_corpus_t *corpus = &corpora[c];
+        char *text = generate_corpus(corpus->kind, size);
+        if (!text) {
+            fprintf(stderr, "Error: Failed to generate corpus '%s'\n", corpus->name);
+            status = 1;
+            break;
+        }
+
+        fprintf(out, "%s\n    {\"name\": \"%s\", \"patterns\": [", c ? "," : "", corpus->name);
+        for (int p = 0; p < MAX_PATTERNS && corpus->patterns[p]; p++) {
+            const char *pattern = corpus->patterns[p];
+            rift_regex_error_t error = {0};
+            rift_bridge_direct_pattern_t *compiled = rift_bridge_direct_compile(pattern, 0, &error);
+            rift_bridge_direct_matcher_t *matcher =
+                compiled ? rift_bridge_direct_create_matcher(compiled, 0) : NULL;
+            if (!matcher) {
+                fprintf(stderr, "Error: Failed to compile '%s': %s\n", pattern, error.message);
+                rift_bridge_direct_free_pattern(compiled);
+                status = 1;
+                continue;
+            }
+
+            size_t matches = 0;
+            double compile_ns = measure_compile(pattern, repeats);
+            double scan_ns = measure_scan(matcher, text, size, repeats, &matches);
+            fprintf(out,
+                    "%s\n      {\"pattern\": \"%s\", \"compile_ns\": %.1f, "
+                    "\"scan_ns_per_byte\": %.4f, \"matches\": %zu}",
+                    p ? "," : "", pattern, compile_ns, scan_ns, matches);
+
+            rift_bridge_direct_free_matcher(matcher);
+            rift_bridge_direct_free_pattern(compiled);
+        }
+        fprintf(out, "\n    ]}");
+        free(text);
+    }
+
+    // Call costs use a literal pattern on a one-byte input, so little else is timed
+    fprintf(out, "\n  ],\n  \"calls\": [");
+    rift_bridge_direct_pattern_t *literal = rift_bridge_direct_compile("a", 0, NULL);
+    rift_bridge_direct_matcher_t *matcher =
+        literal ? rift_bridge_direct_create_matcher(literal, 0) : NULL;
+    for (int call = 0; matcher && call < CALL_COUNT; call++) {
+        fprintf(out, "%s\n    {\"api\": \"%s\", \"ns_per_call\": %.2f}", call ? "," : "",
+                call_names[call], measure_call(matcher, (call_t)call, repeats));
+    }
+    if (!matcher) {
+        fprintf(stderr, "Error: Failed to compile the call-cost pattern\n");
+        status = 1;
+    }
+    fprintf(out, "\n  ]\n}\n");
+    rift_bridge_direct_free_matcher(matcher);
+    rift_bridge_direct_free_pattern(literal);
+
+    if (out != stdout) {
+        fclose(out);
+    }
+    return status;
+}
@@ -0,0 +1,163 @@
+#!/usr/bin/env node
+/**
+ * @file run_bench.mjs
+ * @brief Runner of the web bridge benchmark
+ *
+ * Runs native_benchmark, then bench.js on the Wasm module, either in Node
+ * or in a headless browser loading bench.html, and writes one JSON document
+ * with both results and their comparison for CI to track. Exits with status
+ * 1 when the two builds disagree on a match count.
+ *
+ * Usage: node run_bench.mjs [--module PATH] [--native PATH] [--browser]
+ *                           [--bytes N] [--repeats N] [--output FILE]
+ *
+ * The browser run needs puppeteer (npm install in this directory).
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+import { spawnSync } from 'node:child_process';
+import { readFile, writeFile } from 'node:fs/promises';
+import { createServer } from 'node:http';
+import { basename, dirname, extname, join, resolve } from 'node:path';
+import { fileURLToPath, pathToFileURL } from 'node:url';
+
+import { compareResults, DEFAULT_CORPUS_BYTES, DEFAULT_REPEATS, runBenchmarks } from './bench.js';
+
+const here = dirname(fileURLToPath(import.meta.url));
+
+const options = {
+  module: join(here, '../../../build-wasm/librift.mjs'),
+  native: join(here, 'native_benchmark'),
+  browser: false,
+  bytes: DEFAULT_CORPUS_BYTES,
+  repeats: DEFAULT_REPEATS,
+  output: null,
+};
+
+for (let i = 2; i < process.argv.length; i++) {
+  const name = process.argv[i].replace(/^--/, '');
+  if (name === 'browser') {
+    options.browser = true;
+  } else if (name in options && i + 1 < process.argv.length) {
+    const value = process.argv[++i];
+    options[name] = typeof options[name] === 'number' ? Number(value) : resolve(value);
+  } else {
+    console.error('Usage: node run_bench.mjs [--module PATH] [--native PATH] [--browser] ' +
+                  '[--bytes N] [--repeats N] [--output FILE]');
+    process.exit(1);
+  }
+}
+
+const log = (message) => console.error(`[bench] ${message}`);
+
+/**
+ * Run the native baseline
+ *
+ * @return {Object} Its results
+ */
+function runNative() {
+  log(`native: ${options.native}`);
+  const run = spawnSync(options.native, ['--bytes', String(options.bytes),
+                                         '--repeats', String(options.repeats)],
+                        { encoding: 'utf8', maxBuffer: 16 * 1024 * 1024 });
+  if (run.status !== 0) {
+    throw new Error(`native_benchmark failed: ${run.error?.message ?? run.stderr}`);
+  }
+  return JSON.parse(run.stdout);
+}
+
+/**
+ * Run bench.js on the Wasm module in this Node process
+ *
+ * @return {Promise<Object>} Its results
+ */
+async function runInNode() {
+  const { default: factory } = await import(pathToFileURL(options.module).href);
+  const wasmBytes = await readFile(options.module.replace(/\.m?js$/, '.wasm'));
+  return runBenchmarks({
+    factory,
+    wasmBytes,
+    environment: `node ${process.version}`,
+    bytes: options.bytes,
+    repeats: options.repeats,
+    log,
+  });
+}
+
+/**
+ * Serve bench.html, bench.js and the module, and run the page in headless Chrome
+ *
+ * @return {Promise<Object>} Its results
+ */
+async function runInBrowser() {
+  let puppeteer;
+  try {
+    puppeteer = (await import('puppeteer')).default;
+  } catch {
+    throw new Error('--browser needs puppeteer: run npm install in ' + here);
+  }
+
+  // The module directory is served under /module/, the rest from here
+  const moduleDir = dirname(options.module);
+  const types = { '.html': 'text/html', '.js': 'text/javascript', '.mjs': 'text/javascript',
+                  '.wasm': 'application/wasm' };
+  const server = createServer(async (request, response) => {
+    const path = decodeURIComponent(new URL(request.url, 'http://localhost').pathname);
+    const file = path.startsWith('/module/') ? join(moduleDir, basename(path))
+                                             : join(here, basename(path));
+    try {
+      const body = await readFile(file);
+      // Cross-origin isolation gives the page a finer performance.now()
+      response.writeHead(200, {
+        'Content-Type': types[extname(file)] ?? 'application/octet-stream',
+        'Cross-Origin-Opener-Policy': 'same-origin',
+        'Cross-Origin-Embedder-Policy': 'require-corp',
+      });
+      response.end(body);
+    } catch {
+      response.writeHead(404);
+      response.end();
+    }
+  });
+  await new Promise((ready) => server.listen(0, '127.0.0.1', ready));
+
+  const browser = await puppeteer.launch({ headless: true });
+  try {
+    const page = await browser.newPage();
+    page.on('console', (message) => log(`browser: ${message.text()}`));
+    const query = new URLSearchParams({
+      module: `/module/${basename(options.module)}`,
+      bytes: String(options.bytes),
+      repeats: String(options.repeats),
+    });
+    await page.goto(`http://127.0.0.1:${server.address().port}/bench.html?${query}`);
+    await page.waitForFunction('window.benchResults || window.benchError', { timeout: 0 });
+    const error = await page.evaluate('window.benchError');
+    if (error) {
+      throw new Error(`browser run failed: ${error}`);
+    }
+    return await page.evaluate('window.benchResults');
+  } finally {
+    await browser.close();
+    server.close();
+  }
+}
+
+const native = runNative();
+const wasm = options.browser ? await runInBrowser() : await runInNode();
+const comparison = compareResults(native, wasm);
+const report = JSON.stringify({ native, wasm, comparison }, null, 2) + '\n';
+
+if (options.output) {
+  await writeFile(options.output, report);
+  log(`results written to ${options.output}`);
+} else {
+  process.stdout.write(report);
+}
+
+if (comparison.mismatches.length > 0) {
+  log(`match counts differ for ${comparison.mismatches.length} patterns`);
+  process.exit(1);
+}
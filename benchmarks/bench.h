@@ -0,0 +1,157 @@
+/**
+ * @file bench.h
+ * @brief Registry and harness of the rift_bench benchmark suite
+ *
+ * A benchmark prepares its state once, then its run function is timed in
+ * batches of iterations sized to the minimum batch time, and the batch
+ * times are reduced to a median time per iteration. Micro benchmarks time
+ * one stage of the engine on fixed patterns; macro benchmarks search
+ * generated corpora end to end. Startup benchmarks time a child process
+ * through its first match.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/runtime/perf_counters.h"
+#ifndef LIBRIFT_BENCHMARKS_BENCH_H
+#define LIBRIFT_BENCHMARKS_BENCH_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Kinds of benchmarks
+ */
+typedef enum rift_bench_kind {
+    RIFT_BENCH_MICRO = 0, /**< One stage of the engine */
+    RIFT_BENCH_MACRO,     /**< A search over a corpus */
+    RIFT_BENCH_COMPARE,   /**< A macro workload on LibRift or another engine */
+    RIFT_BENCH_STARTUP    /**< A process started through its first match */
+} rift_bench_kind_t;
+
+/**
+ * @brief Settings shared by the benchmarks
+ */
+typedef struct rift_bench_config {
+    size_t corpus_size;    /**< Bytes of each generated corpus */
+    uint64_t min_batch_ns; /**< Minimum time of a timed batch */
+    size_t repetitions;    /**< Timed batches per benchmark */
+    bool counters;         /**< Read the hardware counters over one more batch */
+} rift_bench_config_t;
+
+/**
+ * @brief A benchmark of the suite
+ */
+typedef struct rift_bench {
+    const char *name;       /**< Name, "micro/...", "macro/<corpus>/...", "compare/<engine>/..." */
+    rift_bench_kind_t kind; /**< Kind of the benchmark */
+    /** Prepare the state, false if the benchmark cannot run */
+    bool (*setup)(const rift_bench_config_t *config, const void *arg, void **state);
+    /** Run one iteration, returning a count that keeps the work from being optimized away */
+    size_t (*run)(void *state);
+    /** Free the state */
+    void (*teardown)(void *state);
+    /** Bytes processed by one iteration, for the throughput, 0 if meaningless */
+    size_t (*bytes)(void *state);
+    const void *arg; /**< Argument of setup */
+} rift_bench_t;
+
+/**
+ * @brief Measurements of one benchmark
+ */
+typedef struct rift_bench_result {
+    const rift_bench_t *bench;   /**< The benchmark */
+    uint64_t iterations;         /**< Iterations of each batch */
+    double ns_per_op;            /**< Median time of an iteration */
+    double min_ns_per_op;        /**< Fastest batch, per iteration */
+    double max_ns_per_op;        /**< Slowest batch, per iteration */
+    size_t bytes_per_op;         /**< Bytes processed by an iteration */
+    size_t checksum;             /**< Count returned by the last iteration */
+    rift_perf_sample_t counters; /**< Hardware counts of one batch, if they were read */
+} rift_bench_result_t;
+
+/**
+ * @brief Gets the micro benchmarks
+ *
+ * @param count Where the number of benchmarks goes
+ * @return const rift_bench_t* The benchmarks
+ */
+const rift_bench_t *rift_bench_micro_list(size_t *count);
+
+/**
+ * @brief Gets the macro benchmarks
+ *
+ * @param count Where the number of benchmarks goes
+ * @return const rift_bench_t* The benchmarks
+ */
+const rift_bench_t *rift_bench_macro_list(size_t *count);
+
+/**
+ * @brief Gets the comparison benchmarks
+ *
+ * Every macro benchmark that searches for patterns is run again, on
+ * LibRift and on each other engine the suite was built with, once timing
+ * the search and once timing the compilation of its patterns.
+ *
+ * @param count Where the number of benchmarks goes
+ * @return const rift_bench_t* The benchmarks
+ */
+const rift_bench_t *rift_bench_compare_list(size_t *count);
+
+/**
+ * @brief Gets the startup benchmarks
+ *
+ * @param count Where the number of benchmarks goes
+ * @return const rift_bench_t* The benchmarks
+ */
+const rift_bench_t *rift_bench_startup_list(size_t *count);
+
+/**
+ * @brief Does the work of a startup benchmark's child process
+ *
+ * @param name Name of the startup case
+ * @return int Exit status of the child, 0 when it found its match
+ */
+int rift_bench_startup_child(const char *name);
+
+/**
+ * @brief Generates the corpus of a macro benchmark
+ *
+ * @param bench A macro benchmark
+ * @param size Most bytes of the corpus
+ * @param length Where the length goes
+ * @return char* The corpus, to free, or NULL on failure
+ */
+char *rift_bench_macro_corpus(const rift_bench_t *bench, size_t size, size_t *length);
+
+/**
+ * @brief Gets the patterns of a macro benchmark
+ *
+ * @param bench A macro benchmark
+ * @param count Where the number of patterns goes
+ * @return const char *const* The patterns, or NULL for a benchmark that tokenizes
+ */
+const char *const *rift_bench_macro_patterns(const rift_bench_t *bench, size_t *count);
+
+/**
+ * @brief Times a benchmark
+ *
+ * @param bench The benchmark
+ * @param config Settings of the run
+ * @param result Where the measurements go
+ * @return bool True if the benchmark ran, false if its setup failed
+ */
+bool rift_bench_measure(const rift_bench_t *bench, const rift_bench_config_t *config,
+                        rift_bench_result_t *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_BENCHMARKS_BENCH_H */
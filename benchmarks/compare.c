@@ -0,0 +1,465 @@
+/**
+ * @file compare.c
+ * @brief Comparison benchmarks against other regex engines
+ *
+ * The macro workloads run again on LibRift and on PCRE2, with and without
+ * its JIT, RE2 and Hyperscan, each compiled in only when the build found
+ * the library. Every engine counts the non-overlapping leftmost matches of
+ * each pattern over the same corpus, so the checksums agree, except for
+ * Hyperscan, which reports every match end and scans for all the patterns
+ * of a workload at once. A second benchmark of each pair times compiling
+ * the patterns, with what an engine builds before its first search: the
+ * JIT code of PCRE2 and the scratch space of Hyperscan.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "core/automaton/flags.h"
+#include "core/engine/pattern.h"
+#include "core/runtime/matcher.h"
+#ifdef LIBRIFT_BENCH_HAVE_PCRE2
+#define PCRE2_CODE_UNIT_WIDTH 8
+#include <pcre2.h>
+#endif
+#ifdef LIBRIFT_BENCH_HAVE_HYPERSCAN
+#include <hs.h>
+#endif
+
+/**
+ * @brief Most patterns of a workload, as in the macro benchmarks
+ */
+#define COMPARE_MAX_PATTERNS 16
+
+/**
+ * @brief Most comparison benchmarks
+ */
+#define COMPARE_MAX_BENCHES 256
+
+/**
+ * @brief Longest name of a comparison benchmark
+ */
+#define COMPARE_MAX_NAME 96
+
+/**
+ * @brief An engine the workloads run on
+ */
+typedef struct compare_engine {
+    const char *name; /**< Name in the benchmark names */
+    /** Compile the patterns of a workload, NULL if one is not supported */
+    void *(*compile)(const char *const *patterns, size_t count);
+    /** Count the matches of every pattern over a text */
+    size_t (*count)(void *compiled, const char *text, size_t length);
+    /** Free what compile built */
+    void (*free)(void *compiled);
+} compare_engine_t;
+
+/**
+ * @brief Argument of a comparison benchmark
+ */
+typedef struct compare_arg {
+    const compare_engine_t *engine; /**< The engine */
+    const rift_bench_t *macro;      /**< The macro benchmark of the workload */
+    bool compile;                   /**< Time the compilation rather than the search */
+} compare_arg_t;
+
+/**
+ * @brief State of a comparison benchmark
+ */
+typedef struct compare_state {
+    const compare_engine_t *engine; /**< The engine */
+    const char *const *patterns;    /**< Patterns of the workload */
+    size_t count;                   /**< Number of patterns */
+    void *compiled;                 /**< Compiled patterns, NULL when timing compilation */
+    char *corpus;                   /**< The corpus, NULL when timing compilation */
+    size_t length;                  /**< Bytes of the corpus */
+} compare_state_t;
+
+/* ============================================================================
+ * LibRift
+ * ============================================================================ */
+
+/**
+ * @brief Compiled patterns of LibRift
+ */
+typedef struct librift_compiled {
+    size_t count;                                         /**< Number of patterns */
+    rift_regex_pattern_t *patterns[COMPARE_MAX_PATTERNS]; /**< Compiled patterns */
+    rift_regex_matcher_t *matchers[COMPARE_MAX_PATTERNS]; /**< Their matchers */
+} librift_compiled_t;
+
+static void
+librift_free(void *compiled)
+{
+    librift_compiled_t *rift = compiled;
+    for (size_t i = 0; rift && i < rift->count; i++) {
+        rift_matcher_free(rift->matchers[i]);
+        rift_regex_pattern_free(rift->patterns[i]);
+    }
+    free(rift);
+}
+
+static void *
+librift_compile(const char *const *patterns, size_t count)
+{
+    librift_compiled_t *rift = calloc(1, sizeof(*rift));
+    if (!rift) {
+        return NULL;
+    }
+    for (; rift->count < count; rift->count++) {
+        size_t i = rift->count;
+        rift->patterns[i] = rift_regex_compile(patterns[i], RIFT_REGEX_FLAG_NONE, NULL);
+        rift->matchers[i] =
+            rift->patterns[i] ? rift_matcher_create(rift->patterns[i], RIFT_MATCHER_OPTION_NONE)
+                              : NULL;
+        if (!rift->matchers[i]) {
+            rift->count++;
+            librift_free(rift);
+            return NULL;
+        }
+    }
+    return rift;
+}
+
+static bool
+librift_count_match(const rift_regex_span_t *spans, size_t num_spans, void *user_data)
+{
+    (void)spans;
+    (void)num_spans;
+    (*(size_t *)user_data)++;
+    return true;
+}
+
+static size_t
+librift_count(void *compiled, const char *text, size_t length)
+{
+    librift_compiled_t *rift = compiled;
+    size_t matches = 0;
+    for (size_t i = 0; i < rift->count; i++) {
+        if (rift_matcher_set_input(rift->matchers[i], text, length)) {
+            rift_matcher_for_each_match(rift->matchers[i], librift_count_match, &matches);
+        }
+    }
+    return matches;
+}
+
+/* ============================================================================
+ * PCRE2
+ * ============================================================================ */
+
+#ifdef LIBRIFT_BENCH_HAVE_PCRE2
+
+/**
+ * @brief Compiled patterns of PCRE2
+ */
+typedef struct pcre2_compiled {
+    size_t count;                                   /**< Number of patterns */
+    pcre2_code *codes[COMPARE_MAX_PATTERNS];        /**< Compiled patterns */
+    pcre2_match_data *data[COMPARE_MAX_PATTERNS];   /**< Their match data */
+} pcre2_compiled_t;
+
+static void
+pcre2_free_compiled(void *compiled)
+{
+    pcre2_compiled_t *pcre = compiled;
+    for (size_t i = 0; pcre && i < pcre->count; i++) {
+        pcre2_match_data_free(pcre->data[i]);
+        pcre2_code_free(pcre->codes[i]);
+    }
+    free(pcre);
+}
+
+static void *
+pcre2_compile_patterns(const char *const *patterns, size_t count, bool jit)
+{
+    pcre2_compiled_t *pcre = calloc(1, sizeof(*pcre));
+    if (!pcre) {
+        return NULL;
+    }
+    for (; pcre->count < count; pcre->count++) {
+        size_t i = pcre->count;
+        int error;
+        PCRE2_SIZE offset;
+        pcre->codes[i] =
+            pcre2_compile((PCRE2_SPTR)patterns[i], PCRE2_ZERO_TERMINATED, 0, &error, &offset, NULL);
+        pcre->data[i] =
+            pcre->codes[i] ? pcre2_match_data_create_from_pattern(pcre->codes[i], NULL) : NULL;
+        if (!pcre->data[i] || (jit && pcre2_jit_compile(pcre->codes[i], PCRE2_JIT_COMPLETE))) {
+            pcre->count++;
+            pcre2_free_compiled(pcre);
+            return NULL;
+        }
+    }
+    return pcre;
+}
+
+static void *
+pcre2_compile_interpreted(const char *const *patterns, size_t count)
+{
+    return pcre2_compile_patterns(patterns, count, false);
+}
+
+static void *
+pcre2_compile_jit(const char *const *patterns, size_t count)
+{
+    return pcre2_compile_patterns(patterns, count, true);
+}
+
+static size_t
+pcre2_count(void *compiled, const char *text, size_t length)
+{
+    pcre2_compiled_t *pcre = compiled;
+    size_t matches = 0;
+    for (size_t i = 0; i < pcre->count; i++) {
+        PCRE2_SIZE offset = 0;
+        while (offset <= length &&
+               pcre2_match(pcre->codes[i], (PCRE2_SPTR)text, length, offset, 0, pcre->data[i],
+                           NULL) > 0) {
+            PCRE2_SIZE *ovector = pcre2_get_ovector_pointer(pcre->data[i]);
+            matches++;
+            offset = ovector[1] > ovector[0] ? ovector[1] : ovector[1] + 1;
+        }
+    }
+    return matches;
+}
+
+#endif /* LIBRIFT_BENCH_HAVE_PCRE2 */
+
+/* ============================================================================
+ * RE2, through the C++ shim in compare_re2.cc
+ * ============================================================================ */
+
+#ifdef LIBRIFT_BENCH_HAVE_RE2
+void *rift_bench_re2_compile(const char *const *patterns, size_t count);
+size_t rift_bench_re2_count(void *compiled, const char *text, size_t length);
+void rift_bench_re2_free(void *compiled);
+#endif
+
+/* ============================================================================
+ * Hyperscan
+ * ============================================================================ */
+
+#ifdef LIBRIFT_BENCH_HAVE_HYPERSCAN
+
+/**
+ * @brief Compiled patterns of Hyperscan: one database for all of them
+ */
+typedef struct hyperscan_compiled {
+    hs_database_t *database; /**< Database of the patterns */
+    hs_scratch_t *scratch;   /**< Scratch space of a scan */
+} hyperscan_compiled_t;
+
+static void
+hyperscan_free(void *compiled)
+{
+    hyperscan_compiled_t *hs = compiled;
+    if (hs) {
+        hs_free_scratch(hs->scratch);
+        hs_free_database(hs->database);
+    }
+    free(hs);
+}
+
+static void *
+hyperscan_compile(const char *const *patterns, size_t count)
+{
+    hyperscan_compiled_t *hs = calloc(1, sizeof(*hs));
+    if (!hs) {
+        return NULL;
+    }
+
+    unsigned ids[COMPARE_MAX_PATTERNS];
+    for (size_t i = 0; i < count; i++) {
+        ids[i] = (unsigned)i;
+    }
+    hs_compile_error_t *error = NULL;
+    if (hs_compile_multi(patterns, NULL, ids, (unsigned)count, HS_MODE_BLOCK, NULL, &hs->database,
+                         &error) != HS_SUCCESS) {
+        hs_free_compile_error(error);
+        free(hs);
+        return NULL;
+    }
+    if (hs_alloc_scratch(hs->database, &hs->scratch) != HS_SUCCESS) {
+        hyperscan_free(hs);
+        return NULL;
+    }
+    return hs;
+}
+
+static int
+hyperscan_on_match(unsigned id, unsigned long long from, unsigned long long to, unsigned flags,
+                   void *context)
+{
+    (void)id;
+    (void)from;
+    (void)to;
+    (void)flags;
+    (*(size_t *)context)++;
+    return 0;
+}
+
+static size_t
+hyperscan_count(void *compiled, const char *text, size_t length)
+{
+    hyperscan_compiled_t *hs = compiled;
+    size_t matches = 0;
+    hs_scan(hs->database, text, (unsigned)length, 0, hs->scratch, hyperscan_on_match, &matches);
+    return matches;
+}
+
+#endif /* LIBRIFT_BENCH_HAVE_HYPERSCAN */
+
+/**
+ * @brief The engines, LibRift first as the reference of the comparison
+ */
+static const compare_engine_t ENGINES[] = {
+    {"librift", librift_compile, librift_count, librift_free},
+#ifdef LIBRIFT_BENCH_HAVE_PCRE2
+    {"pcre2", pcre2_compile_interpreted, pcre2_count, pcre2_free_compiled},
+    {"pcre2_jit", pcre2_compile_jit, pcre2_count, pcre2_free_compiled},
+#endif
+#ifdef LIBRIFT_BENCH_HAVE_RE2
+    {"re2", rift_bench_re2_compile, rift_bench_re2_count, rift_bench_re2_free},
+#endif
+#ifdef LIBRIFT_BENCH_HAVE_HYPERSCAN
+    {"hyperscan", hyperscan_compile, hyperscan_count, hyperscan_free},
+#endif
+};
+
+/* ============================================================================
+ * Benchmarks
+ * ============================================================================ */
+
+static void
+compare_teardown(void *state)
+{
+    compare_state_t *compare = state;
+    if (!compare) {
+        return;
+    }
+    if (compare->compiled) {
+        compare->engine->free(compare->compiled);
+    }
+    free(compare->corpus);
+    free(compare);
+}
+
+static bool
+compare_setup(const rift_bench_config_t *config, const void *arg, void **state)
+{
+    const compare_arg_t *c = arg;
+    compare_state_t *compare = calloc(1, sizeof(*compare));
+    if (!compare) {
+        return false;
+    }
+    compare->engine = c->engine;
+    compare->patterns = rift_bench_macro_patterns(c->macro, &compare->count);
+
+    if (c->compile) {
+        /* An engine that cannot compile the patterns skips both benchmarks */
+        void *compiled = compare->engine->compile(compare->patterns, compare->count);
+        if (!compiled) {
+            compare_teardown(compare);
+            return false;
+        }
+        compare->engine->free(compiled);
+        *state = compare;
+        return true;
+    }
+
+    compare->compiled = compare->engine->compile(compare->patterns, compare->count);
+    compare->corpus = rift_bench_macro_corpus(c->macro, config->corpus_size, &compare->length);
+    if (!compare->compiled || !compare->corpus) {
+        compare_teardown(compare);
+        return false;
+    }
+    *state = compare;
+    return true;
+}
+
+/**
+ * @brief Count the matches of the workload's patterns over the corpus
+ */
+static size_t
+compare_search(void *state)
+{
+    compare_state_t *compare = state;
+    return compare->engine->count(compare->compiled, compare->corpus, compare->length);
+}
+
+/**
+ * @brief Compile and free the workload's patterns
+ */
+static size_t
+compare_compile(void *state)
+{
+    compare_state_t *compare = state;
+    void *compiled = compare->engine->compile(compare->patterns, compare->count);
+    if (!compiled) {
+        return 0;
+    }
+    compare->engine->free(compiled);
+    return compare->count;
+}
+
+/**
+ * @brief Bytes searched by an iteration, the corpus once per pattern as in the macro benchmarks
+ */
+static size_t
+compare_bytes(void *state)
+{
+    compare_state_t *compare = state;
+    return compare->length * compare->count;
+}
+
+static rift_bench_t COMPARE_BENCHES[COMPARE_MAX_BENCHES];
+static compare_arg_t COMPARE_ARGS[COMPARE_MAX_BENCHES];
+static char COMPARE_NAMES[COMPARE_MAX_BENCHES][COMPARE_MAX_NAME];
+static size_t compare_count;
+
+/**
+ * @brief Add the search and compile benchmarks of a workload on an engine
+ */
+static void
+add_benches(const compare_engine_t *engine, const rift_bench_t *macro)
+{
+    const char *workload = macro->name + strlen("macro/");
+    for (int compile = 0; compile < 2 && compare_count < COMPARE_MAX_BENCHES; compile++) {
+        size_t i = compare_count++;
+        snprintf(COMPARE_NAMES[i], COMPARE_MAX_NAME, "compare/%s/%s%s", engine->name,
+                 compile ? "compile/" : "", workload);
+        COMPARE_ARGS[i] = (compare_arg_t){engine, macro, compile != 0};
+        COMPARE_BENCHES[i] = (rift_bench_t){COMPARE_NAMES[i],
+                                            RIFT_BENCH_COMPARE,
+                                            compare_setup,
+                                            compile ? compare_compile : compare_search,
+                                            compare_teardown,
+                                            compile ? NULL : compare_bytes,
+                                            &COMPARE_ARGS[i]};
+    }
+}
+
+const rift_bench_t *
+rift_bench_compare_list(size_t *count)
+{
+    if (compare_count == 0) {
+        size_t macro_count;
+        const rift_bench_t *macro = rift_bench_macro_list(&macro_count);
+        for (size_t m = 0; m < macro_count; m++) {
+            size_t patterns;
+            if (!rift_bench_macro_patterns(&macro[m], &patterns) ||
+                patterns > COMPARE_MAX_PATTERNS) {
+                continue;
+            }
+            for (size_t e = 0; e < sizeof(ENGINES) / sizeof(ENGINES[0]); e++) {
+                add_benches(&ENGINES[e], &macro[m]);
+            }
+        }
+    }
+    *count = compare_count;
+    return COMPARE_BENCHES;
+}
@@ -0,0 +1,64 @@
+/**
+ * @file compare_re2.cc
+ * @brief RE2 engine of the comparison benchmarks, behind a C interface
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <re2/re2.h>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Compiled patterns of RE2
+ */
+struct Re2Compiled {
+    std::vector<std::unique_ptr<re2::RE2>> patterns; /**< Compiled patterns */
+};
+
+} // namespace
+
+extern "C" void *
+rift_bench_re2_compile(const char *const *patterns, size_t count)
+{
+    auto compiled = new Re2Compiled;
+    re2::RE2::Options options;
+    options.set_log_errors(false);
+    for (size_t i = 0; i < count; i++) {
+        compiled->patterns.emplace_back(new re2::RE2(patterns[i], options));
+        if (!compiled->patterns.back()->ok()) {
+            delete compiled;
+            return nullptr;
+        }
+    }
+    return compiled;
+}
+
+extern "C" size_t
+rift_bench_re2_count(void *compiled, const char *text, size_t length)
+{
+    auto re2 = static_cast<Re2Compiled *>(compiled);
+    re2::StringPiece input(text, length);
+    size_t matches = 0;
+    for (const auto &pattern : re2->patterns) {
+        size_t offset = 0;
+        re2::StringPiece match;
+        while (offset <= length &&
+               pattern->Match(input, offset, length, re2::RE2::UNANCHORED, &match, 1)) {
+            matches++;
+            size_t end = static_cast<size_t>(match.data() - text) + match.size();
+            offset = match.empty() ? end + 1 : end;
+        }
+    }
+    return matches;
+}
+
+extern "C" void
+rift_bench_re2_free(void *compiled)
+{
+    delete static_cast<Re2Compiled *>(compiled);
+}
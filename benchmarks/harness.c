@@ -0,0 +1,113 @@
+/**
+ * @file harness.c
+ * @brief Timing harness of the rift_bench benchmark suite
+ *
+ * An untimed iteration warms the caches and the allocator first. The batch
+ * size then doubles until a batch lasts the minimum batch time, so clock
+ * resolution and call overhead vanish in the per-iteration time, and the
+ * median of the timed batches is reported, which a stray interruption
+ * cannot move. The hardware counters, when asked for, are read over one
+ * more batch of the same size, so opening them costs the timings nothing.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "core/runtime/matcher.h"
+
+/**
+ * @brief Iterations a batch never exceeds while calibrating
+ */
+#define BENCH_MAX_ITERATIONS ((uint64_t)1 << 30)
+
+/**
+ * @brief Order batch times
+ */
+static int
+compare_double(const void *a, const void *b)
+{
+    double left = *(const double *)a;
+    double right = *(const double *)b;
+    return left < right ? -1 : left > right;
+}
+
+/**
+ * @brief Run a batch of iterations
+ *
+ * @param bench The benchmark
+ * @param state Its state
+ * @param iterations Iterations of the batch
+ * @param checksum Where the count of the last iteration goes
+ * @return uint64_t Time of the batch
+ */
+static uint64_t
+run_batch(const rift_bench_t *bench, void *state, uint64_t iterations, size_t *checksum)
+{
+    size_t count = 0;
+    uint64_t begin = rift_matcher_monotonic_ns();
+    for (uint64_t i = 0; i < iterations; i++) {
+        count = bench->run(state);
+    }
+    uint64_t elapsed = rift_matcher_monotonic_ns() - begin;
+    *checksum = count;
+    return elapsed;
+}
+
+bool
+rift_bench_measure(const rift_bench_t *bench, const rift_bench_config_t *config,
+                   rift_bench_result_t *result)
+{
+    if (!bench || !config || !result) {
+        return false;
+    }
+    memset(result, 0, sizeof(*result));
+    result->bench = bench;
+
+    void *state = NULL;
+    if (!bench->setup(config, bench->arg, &state)) {
+        return false;
+    }
+
+    size_t repetitions = config->repetitions > 0 ? config->repetitions : 1;
+    double *times = malloc(repetitions * sizeof(*times));
+    if (!times) {
+        bench->teardown(state);
+        return false;
+    }
+
+    /* Warm up, then size the batches */
+    size_t checksum = bench->run(state);
+    uint64_t iterations = 1;
+    while (iterations < BENCH_MAX_ITERATIONS &&
+           run_batch(bench, state, iterations, &checksum) < config->min_batch_ns) {
+        iterations *= 2;
+    }
+
+    for (size_t i = 0; i < repetitions; i++) {
+        times[i] = (double)run_batch(bench, state, iterations, &checksum) / (double)iterations;
+    }
+    qsort(times, repetitions, sizeof(*times), compare_double);
+
+    result->iterations = iterations;
+    result->ns_per_op = times[repetitions / 2];
+    result->min_ns_per_op = times[0];
+    result->max_ns_per_op = times[repetitions - 1];
+    result->bytes_per_op = bench->bytes ? bench->bytes(state) : 0;
+    result->checksum = checksum;
+
+    if (config->counters) {
+        rift_perf_counters_t *counters = rift_perf_counters_create();
+        if (rift_perf_counters_start(counters)) {
+            run_batch(bench, state, iterations, &checksum);
+            rift_perf_counters_stop(counters, &result->counters);
+        }
+        rift_perf_counters_free(counters);
+    }
+
+    free(times);
+    bench->teardown(state);
+    return true;
+}
@@ -0,0 +1,408 @@
+/**
+ * @file macro.c
+ * @brief Macro benchmarks searching standard corpora
+ *
+ * The corpora are generated from a fixed seed rather than shipped, so every
+ * run searches the same bytes at whatever size it asks for: web server
+ * logs, CSV records, newline-delimited JSON, and FASTA DNA for the variant
+ * patterns of the regex-redux benchmark. An iteration counts the matches of
+ * each pattern of a benchmark over the whole corpus, or for the token
+ * benchmarks the tokens a lexer made of the patterns cuts the corpus into.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "core/automaton/flags.h"
+#include "core/engine/pattern.h"
+#include "core/patterns/lexer.h"
+#include "core/runtime/matcher.h"
+
+/**
+ * @brief Most patterns a macro benchmark searches for
+ */
+#define MACRO_MAX_PATTERNS 9
+
+/**
+ * @brief Longest line a generator writes
+ */
+#define MACRO_MAX_LINE 256
+
+/**
+ * @brief Seed of the corpus generators
+ */
+#define MACRO_SEED 0x9E3779B97F4A7C15ull
+
+/**
+ * @brief Generator of a corpus, writing one line into buffer
+ *
+ * @return int Length of the line
+ */
+typedef int (*macro_line_fn)(uint64_t *rng, size_t line, char *buffer);
+
+/**
+ * @brief A macro benchmark: a corpus and the patterns searched in it
+ */
+typedef struct macro_case {
+    macro_line_fn generate;                       /**< Generator of the corpus */
+    const char *header;                           /**< First line of the corpus, or NULL */
+    const char *patterns[MACRO_MAX_PATTERNS + 1]; /**< Patterns, NULL-terminated */
+    bool lexer;                                   /**< Tokenize with the patterns as rules */
+} macro_case_t;
+
+/**
+ * @brief State of a macro benchmark
+ */
+typedef struct macro_state {
+    char *corpus;                                       /**< The corpus */
+    size_t length;                                      /**< Bytes of the corpus */
+    size_t count;                                       /**< Patterns searched */
+    rift_regex_pattern_t *patterns[MACRO_MAX_PATTERNS]; /**< Compiled patterns */
+    rift_regex_matcher_t *matchers[MACRO_MAX_PATTERNS]; /**< Their matchers */
+    rift_lexer_t *lexer;                                /**< Lexer of the patterns, or NULL */
+} macro_state_t;
+
+/**
+ * @brief Next number of the xorshift64* generator
+ */
+static uint64_t
+next_random(uint64_t *rng)
+{
+    *rng ^= *rng >> 12;
+    *rng ^= *rng << 25;
+    *rng ^= *rng >> 27;
+    return *rng * 0x2545F4914F6CDD1Dull;
+}
+
+/**
+ * @brief Pick one of count items
+ */
+static size_t
+pick(uint64_t *rng, size_t count)
+{
+    return (size_t)((next_random(rng) >> 33) % count);
+}
+
+static const char *const NAMES[] = {"alice", "bob", "carol", "dave", "erin", "frank",
+                                    "grace", "heidi", "ivan", "judy", "mallory", "oscar"};
+static const char *const DOMAINS[] = {"example", "mail", "corp-net", "rift"};
+static const char *const PATHS[] = {"/", "/index.html", "/api/v1/users", "/api/v1/orders",
+                                    "/static/app.js", "/login", "/search"};
+
+/**
+ * @brief A line of a web server log
+ */
+static int
+generate_log(uint64_t *rng, size_t line, char *buffer)
+{
+    static const char *const LEVELS[] = {"INFO", "INFO", "INFO", "INFO", "INFO", "INFO",
+                                         "INFO", "INFO", "DEBUG", "WARN", "WARN", "ERROR"};
+    static const unsigned STATUSES[] = {200, 200, 200, 200, 201, 204, 301, 304, 404, 500, 503};
+    size_t seconds = line / 4;
+    return snprintf(buffer, MACRO_MAX_LINE,
+                    "2025-03-%02zuT%02zu:%02zu:%02zuZ %s [worker-%zu] %s %s from %zu.%zu.%zu.%zu "
+                    "status=%u latency=%zums\n",
+                    1 + seconds / 86400 % 28, seconds / 3600 % 24, seconds / 60 % 60,
+                    seconds % 60, LEVELS[pick(rng, 12)], pick(rng, 16),
+                    pick(rng, 4) ? "GET" : "POST", PATHS[pick(rng, 7)], 10 + pick(rng, 200),
+                    pick(rng, 256), pick(rng, 256), 1 + pick(rng, 254), STATUSES[pick(rng, 11)],
+                    pick(rng, 2000));
+}
+
+/**
+ * @brief A record of a CSV export, some names quoted for their comma
+ */
+static int
+generate_csv(uint64_t *rng, size_t line, char *buffer)
+{
+    const char *first = NAMES[pick(rng, 12)];
+    const char *last = NAMES[pick(rng, 12)];
+    const char *domain = DOMAINS[pick(rng, 4)];
+    size_t cents = pick(rng, 1000000);
+    if (pick(rng, 4) == 0) {
+        return snprintf(buffer, MACRO_MAX_LINE,
+                        "%zu,\"%s, %s\",%s.%s@%s.com,%zu.%02zu,2025-%02zu-%02zu\n", line, last,
+                        first, first, last, domain, cents / 100, cents % 100, 1 + pick(rng, 12),
+                        1 + pick(rng, 28));
+    }
+    return snprintf(buffer, MACRO_MAX_LINE, "%zu,%s %s,%s.%s@%s.com,%zu.%02zu,2025-%02zu-%02zu\n",
+                    line, first, last, first, last, domain, cents / 100, cents % 100,
+                    1 + pick(rng, 12), 1 + pick(rng, 28));
+}
+
+/**
+ * @brief An object of newline-delimited JSON
+ */
+static int
+generate_json(uint64_t *rng, size_t line, char *buffer)
+{
+    static const char *const TAGS[] = {"new", "vip", "trial", "churned", "beta"};
+    static const char *const ACTIVE[] = {"true", "false", "null"};
+    size_t score = pick(rng, 100000);
+    return snprintf(buffer, MACRO_MAX_LINE,
+                    "{\"id\":%zu,\"user\":\"%s\",\"email\":\"%s@%s.com\",\"score\":%s%zu.%zu,"
+                    "\"active\":%s,\"tags\":[\"%s\",\"%s\"]}\n",
+                    line, NAMES[pick(rng, 12)], NAMES[pick(rng, 12)], DOMAINS[pick(rng, 4)],
+                    pick(rng, 8) ? "" : "-", score / 100, score % 100, ACTIVE[pick(rng, 3)],
+                    TAGS[pick(rng, 5)], TAGS[pick(rng, 5)]);
+}
+
+/**
+ * @brief A line of FASTA DNA, a sequence header every 1000 lines
+ *
+ * The nucleotides follow the weights of the fasta benchmark's Homo sapiens
+ * sequence, which is what regex-redux reads.
+ */
+static int
+generate_dna(uint64_t *rng, size_t line, char *buffer)
+{
+    if (line % 1000 == 0) {
+        return snprintf(buffer, MACRO_MAX_LINE, ">SEQ%zu Homo sapiens frequency\n", line / 1000);
+    }
+    for (size_t i = 0; i < 60; i++) {
+        size_t weight = pick(rng, 10000);
+        buffer[i] = weight < 3030 ? 'a' : weight < 5010 ? 'c' : weight < 6985 ? 'g' : 't';
+    }
+    buffer[60] = '\n';
+    return 61;
+}
+
+/**
+ * @brief Generate a corpus of at most size bytes, whole lines only
+ */
+static char *
+generate_corpus(const macro_case_t *c, size_t size, size_t *length)
+{
+    char *corpus = malloc(size + 1);
+    if (!corpus) {
+        return NULL;
+    }
+
+    size_t used = 0;
+    if (c->header) {
+        size_t header_length = strlen(c->header);
+        if (header_length <= size) {
+            memcpy(corpus, c->header, header_length);
+            used = header_length;
+        }
+    }
+
+    uint64_t rng = MACRO_SEED;
+    char line[MACRO_MAX_LINE];
+    for (size_t i = 0;; i++) {
+        int written = c->generate(&rng, i, line);
+        if (written <= 0 || (size_t)written >= MACRO_MAX_LINE || used + (size_t)written > size) {
+            break;
+        }
+        memcpy(corpus + used, line, (size_t)written);
+        used += (size_t)written;
+    }
+    corpus[used] = '\0';
+    *length = used;
+    return corpus;
+}
+
+static void
+macro_teardown(void *state)
+{
+    macro_state_t *macro = state;
+    if (!macro) {
+        return;
+    }
+    for (size_t i = 0; i < macro->count; i++) {
+        rift_matcher_free(macro->matchers[i]);
+        rift_regex_pattern_free(macro->patterns[i]);
+    }
+    rift_lexer_free(macro->lexer);
+    free(macro->corpus);
+    free(macro);
+}
+
+static bool
+macro_setup(const rift_bench_config_t *config, const void *arg, void **state)
+{
+    const macro_case_t *c = arg;
+    macro_state_t *macro = calloc(1, sizeof(*macro));
+    if (!macro) {
+        return false;
+    }
+
+    macro->corpus = generate_corpus(c, config->corpus_size, &macro->length);
+    if (!macro->corpus) {
+        macro_teardown(macro);
+        return false;
+    }
+
+    if (c->lexer) {
+        macro->lexer = rift_lexer_create();
+        for (size_t i = 0; macro->lexer && i < MACRO_MAX_PATTERNS && c->patterns[i]; i++) {
+            if (!rift_lexer_add_rule(macro->lexer, c->patterns[i], RIFT_REGEX_FLAG_NONE, NULL,
+                                     NULL)) {
+                break;
+            }
+        }
+        if (!macro->lexer || !rift_lexer_compile(macro->lexer, NULL)) {
+            macro_teardown(macro);
+            return false;
+        }
+        *state = macro;
+        return true;
+    }
+
+    for (; macro->count < MACRO_MAX_PATTERNS && c->patterns[macro->count]; macro->count++) {
+        size_t i = macro->count;
+        macro->patterns[i] = rift_regex_compile(c->patterns[i], RIFT_REGEX_FLAG_NONE, NULL);
+        macro->matchers[i] =
+            macro->patterns[i] ? rift_matcher_create(macro->patterns[i], RIFT_MATCHER_OPTION_NONE)
+                               : NULL;
+        if (!macro->matchers[i]) {
+            macro->count++;
+            macro_teardown(macro);
+            return false;
+        }
+    }
+
+    *state = macro;
+    return true;
+}
+
+/**
+ * @brief Count a match
+ */
+static bool
+count_match(const rift_regex_span_t *spans, size_t num_spans, void *user_data)
+{
+    (void)spans;
+    (void)num_spans;
+    (*(size_t *)user_data)++;
+    return true;
+}
+
+/**
+ * @brief Count the matches of every pattern over the corpus
+ */
+static size_t
+macro_run(void *state)
+{
+    macro_state_t *macro = state;
+    if (macro->lexer) {
+        return rift_lexer_tokenize(macro->lexer, macro->corpus, macro->length, NULL, 0);
+    }
+
+    size_t matches = 0;
+    for (size_t i = 0; i < macro->count; i++) {
+        if (rift_matcher_set_input(macro->matchers[i], macro->corpus, macro->length)) {
+            rift_matcher_for_each_match(macro->matchers[i], count_match, &matches);
+        }
+    }
+    return matches;
+}
+
+/**
+ * @brief Bytes searched by an iteration, the corpus once per pattern or once for a lexer
+ */
+static size_t
+macro_bytes(void *state)
+{
+    macro_state_t *macro = state;
+    return macro->lexer ? macro->length : macro->length * macro->count;
+}
+
+static const macro_case_t LOGS_LEVEL = {generate_log, NULL, {"ERROR|WARN", NULL}, false};
+static const macro_case_t LOGS_TIMESTAMP = {
+    generate_log, NULL, {"\\d{4}-\\d{2}-\\d{2}T\\d{2}:\\d{2}:\\d{2}Z", NULL}, false};
+static const macro_case_t LOGS_IPV4 = {
+    generate_log, NULL, {"(\\d{1,3}\\.){3}\\d{1,3}", NULL}, false};
+static const macro_case_t LOGS_SERVER_ERROR = {generate_log, NULL, {"status=5\\d\\d", NULL}, false};
+
+static const char CSV_HEADER[] = "id,name,email,amount,date\n";
+static const macro_case_t CSV_EMAIL = {generate_csv, CSV_HEADER,
+                                       {"[a-z0-9.]+@[a-z0-9-]+\\.[a-z]+", NULL}, false};
+static const macro_case_t CSV_QUOTED = {generate_csv, CSV_HEADER, {"\"[^\"]*\"", NULL}, false};
+static const macro_case_t CSV_AMOUNT = {generate_csv, CSV_HEADER, {"\\d+\\.\\d\\d", NULL}, false};
+static const macro_case_t CSV_TOKENS = {
+    generate_csv, CSV_HEADER, {"\"[^\"]*\"", "[^,\"\n]+", ",", "\n", NULL}, true};
+
+static const macro_case_t JSON_KEY = {generate_json, NULL, {"\"[a-z_]+\":", NULL}, false};
+static const macro_case_t JSON_NUMBER = {generate_json, NULL, {"-?\\d+(\\.\\d+)?", NULL}, false};
+static const macro_case_t JSON_LITERAL = {generate_json, NULL, {"true|false|null", NULL}, false};
+static const macro_case_t JSON_TOKENS = {
+    generate_json,
+    NULL,
+    {"\"[^\"]*\"", "-?\\d+(\\.\\d+)?", "true|false|null", "[{}\\[\\]:,]", "\\s+", NULL},
+    true};
+
+static const macro_case_t REDUX_VARIANTS = {
+    generate_dna,
+    NULL,
+    {"agggtaaa|tttaccct", "[cgt]gggtaaa|tttaccc[acg]", "a[act]ggtaaa|tttacc[agt]t",
+     "ag[act]gtaaa|tttac[agt]ct", "agg[act]taaa|ttta[agt]cct", "aggg[acg]aaa|ttt[cgt]ccct",
+     "agggt[cgt]aa|tt[acg]accct", "agggta[cgt]a|t[acg]taccct", "agggtaa[cgt]|[acg]ttaccct",
+     NULL},
+    false};
+static const macro_case_t REDUX_CLEANUP = {generate_dna, NULL, {">[^\n]*\n|\n", NULL}, false};
+
+/**
+ * @brief The macro benchmarks, by corpus
+ */
+static const rift_bench_t MACRO_BENCHES[] = {
+    {"macro/logs/level", RIFT_BENCH_MACRO, macro_setup, macro_run, macro_teardown, macro_bytes,
+     &LOGS_LEVEL},
+    {"macro/logs/timestamp", RIFT_BENCH_MACRO, macro_setup, macro_run, macro_teardown,
+     macro_bytes, &LOGS_TIMESTAMP},
+    {"macro/logs/ipv4", RIFT_BENCH_MACRO, macro_setup, macro_run, macro_teardown, macro_bytes,
+     &LOGS_IPV4},
+    {"macro/logs/server_error", RIFT_BENCH_MACRO, macro_setup, macro_run, macro_teardown,
+     macro_bytes, &LOGS_SERVER_ERROR},
+    {"macro/csv/email", RIFT_BENCH_MACRO, macro_setup, macro_run, macro_teardown, macro_bytes,
+     &CSV_EMAIL},
+    {"macro/csv/quoted", RIFT_BENCH_MACRO, macro_setup, macro_run, macro_teardown, macro_bytes,
+     &CSV_QUOTED},
+    {"macro/csv/amount", RIFT_BENCH_MACRO, macro_setup, macro_run, macro_teardown, macro_bytes,
+     &CSV_AMOUNT},
+    {"macro/csv/tokens", RIFT_BENCH_MACRO, macro_setup, macro_run, macro_teardown, macro_bytes,
+     &CSV_TOKENS},
+    {"macro/json/key", RIFT_BENCH_MACRO, macro_setup, macro_run, macro_teardown, macro_bytes,
+     &JSON_KEY},
+    {"macro/json/number", RIFT_BENCH_MACRO, macro_setup, macro_run, macro_teardown, macro_bytes,
+     &JSON_NUMBER},
+    {"macro/json/literal", RIFT_BENCH_MACRO, macro_setup, macro_run, macro_teardown,
+     macro_bytes, &JSON_LITERAL},
+    {"macro/json/tokens", RIFT_BENCH_MACRO, macro_setup, macro_run, macro_teardown, macro_bytes,
+     &JSON_TOKENS},
+    {"macro/regex_redux/variants", RIFT_BENCH_MACRO, macro_setup, macro_run, macro_teardown,
+     macro_bytes, &REDUX_VARIANTS},
+    {"macro/regex_redux/cleanup", RIFT_BENCH_MACRO, macro_setup, macro_run, macro_teardown,
+     macro_bytes, &REDUX_CLEANUP},
+};
+
+const rift_bench_t *
+rift_bench_macro_list(size_t *count)
+{
+    *count = sizeof(MACRO_BENCHES) / sizeof(MACRO_BENCHES[0]);
+    return MACRO_BENCHES;
+}
+
+char *
+rift_bench_macro_corpus(const rift_bench_t *bench, size_t size, size_t *length)
+{
+    return generate_corpus(bench->arg, size, length);
+}
+
+const char *const *
+rift_bench_macro_patterns(const rift_bench_t *bench, size_t *count)
+{
+    const macro_case_t *c = bench->arg;
+    *count = 0;
+    if (c->lexer) {
+        return NULL;
+    }
+    while (*count < MACRO_MAX_PATTERNS && c->patterns[*count]) {
+        (*count)++;
+    }
+    return c->patterns;
+}
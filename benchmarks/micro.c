@@ -0,0 +1,478 @@
+/**
+ * @file micro.c
+ * @brief Micro benchmarks of the stages of the engine
+ *
+ * Every stage is timed alone on the same set of patterns: its inputs are
+ * built in setup by the stages before it, so an iteration covers the one
+ * stage named and nothing upstream. An iteration processes every pattern of
+ * the set once.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+#include "core/automaton/automaton.h"
+#include "core/automaton/flags.h"
+#include "core/bytecode/bytecode_compiler.h"
+#include "core/bytecode/bytecode_vm.h"
+#include "core/compiler/compiler.h"
+#include "core/errors/regex_error.h"
+#include "core/parser/ast.h"
+#include "core/runtime/backtrack_stack.h"
+#include "core/tokenizer/token.h"
+#include "core/tokenizer/token_type.h"
+#include "core/tokenizer/tokenizer.h"
+
+/**
+ * @brief A pattern of the set and a subject it matches from the start
+ */
+typedef struct micro_case {
+    const char *pattern; /**< The pattern */
+    const char *subject; /**< Input of the VM benchmark */
+} micro_case_t;
+
+/**
+ * @brief Patterns shaped like the ones tokenizers and log filters use
+ */
+static const micro_case_t MICRO_CASES[] = {
+    {"[a-zA-Z_][a-zA-Z0-9_]*", "rift_bench_identifier_0123456789 tail"},
+    {"(\\d{1,3}\\.){3}\\d{1,3}", "192.168.100.254 - - [14/Mar/2025]"},
+    {"([a-z0-9._%+-]+)@([a-z0-9.-]+)\\.([a-z]{2,})", "first.last+tag@example-mail.co.uk>"},
+    {"(foo|bar|baz|qux)+[0-9]*", "foobarbazquxfoobarbazqux2025;"},
+    {"\"([^\"\\\\]|\\\\.)*\"", "\"a quoted \\\"string\\\" with escapes\" rest"},
+    {"a(b|c)*d?e{2,4}", "abcbcbcbcbcbcbcdeeee!"},
+};
+
+#define MICRO_CASE_COUNT (sizeof(MICRO_CASES) / sizeof(MICRO_CASES[0]))
+
+/**
+ * @brief Frames pushed by an iteration of the backtrack stack benchmarks
+ */
+#define MICRO_STACK_FRAMES 4096
+
+/**
+ * @brief Capture groups of the capture recording benchmark
+ */
+#define MICRO_CAPTURE_GROUPS 8
+
+/**
+ * @brief What the stages before the one timed produced, per pattern
+ */
+typedef struct micro_state {
+    rift_regex_ast_t *asts[MICRO_CASE_COUNT];            /**< Parsed patterns */
+    rift_regex_automaton_t *nfas[MICRO_CASE_COUNT];      /**< Their NFAs */
+    rift_regex_automaton_t *dfas[MICRO_CASE_COUNT];      /**< Their DFAs */
+    rift_bytecode_program_t *programs[MICRO_CASE_COUNT]; /**< Their bytecode */
+    rift_bytecode_vm_t *vms[MICRO_CASE_COUNT];           /**< VMs bound to the programs */
+    rift_backtrack_stack_t *stack;                       /**< Stack of the stack benchmarks */
+    uint8_t *buffer;                                     /**< Serialization buffer */
+    size_t buffer_size;                                  /**< Bytes of the buffer */
+    size_t bytes;                                        /**< Bytes an iteration processes */
+} micro_state_t;
+
+/**
+ * @brief Stages prepared by the setup of a benchmark
+ */
+typedef enum micro_stage {
+    MICRO_STAGE_NONE = 0,  /**< Only the pattern strings */
+    MICRO_STAGE_AST,       /**< Up to the ASTs */
+    MICRO_STAGE_NFA,       /**< Up to the NFAs */
+    MICRO_STAGE_DFA,       /**< Up to the DFAs */
+    MICRO_STAGE_BYTECODE,  /**< Up to the bytecode */
+    MICRO_STAGE_VM,        /**< Up to VMs for the bytecode */
+    MICRO_STAGE_SERIALIZED /**< Up to a buffer for the serialized bytecode */
+} micro_stage_t;
+
+static void
+micro_teardown(void *state)
+{
+    micro_state_t *micro = state;
+    if (!micro) {
+        return;
+    }
+    for (size_t i = 0; i < MICRO_CASE_COUNT; i++) {
+        rift_bytecode_vm_free(micro->vms[i]);
+        rift_bytecode_program_free(micro->programs[i]);
+        rift_automaton_free(micro->dfas[i]);
+        rift_automaton_free(micro->nfas[i]);
+        rift_regex_ast_free(micro->asts[i]);
+    }
+    rift_backtrack_stack_free(micro->stack);
+    free(micro->buffer);
+    free(micro);
+}
+
+/**
+ * @brief Build the stages a benchmark starts from
+ *
+ * @param stage Last stage built
+ * @param state Where the state goes
+ * @return bool True if every pattern went through every stage, false otherwise
+ */
+static bool
+micro_prepare(micro_stage_t stage, void **state)
+{
+    micro_state_t *micro = calloc(1, sizeof(*micro));
+    if (!micro) {
+        return false;
+    }
+    *state = micro;
+
+    for (size_t i = 0; i < MICRO_CASE_COUNT; i++) {
+        const micro_case_t *c = &MICRO_CASES[i];
+        micro->bytes += strlen(stage >= MICRO_STAGE_VM ? c->subject : c->pattern);
+        if (stage < MICRO_STAGE_AST) {
+            continue;
+        }
+        micro->asts[i] = rift_regex_parse(c->pattern, RIFT_REGEX_FLAG_NONE, NULL);
+        if (!micro->asts[i]) {
+            goto fail;
+        }
+        if (stage < MICRO_STAGE_NFA) {
+            continue;
+        }
+        micro->nfas[i] = rift_regex_compile_ast(micro->asts[i], RIFT_REGEX_FLAG_NONE, NULL);
+        if (!micro->nfas[i]) {
+            goto fail;
+        }
+        if (stage == MICRO_STAGE_DFA) {
+            micro->dfas[i] = rift_automaton_nfa_to_dfa(micro->nfas[i], NULL);
+            if (!micro->dfas[i]) {
+                goto fail;
+            }
+            continue;
+        }
+        if (stage < MICRO_STAGE_BYTECODE) {
+            continue;
+        }
+        micro->programs[i] = rift_bytecode_compile(c->pattern, RIFT_REGEX_FLAG_NONE, NULL);
+        if (!micro->programs[i]) {
+            goto fail;
+        }
+        if (stage == MICRO_STAGE_VM) {
+            micro->vms[i] = rift_bytecode_vm_create(micro->programs[i], c->subject, (size_t)-1);
+            if (!micro->vms[i]) {
+                goto fail;
+            }
+        }
+    }
+
+    if (stage == MICRO_STAGE_SERIALIZED) {
+        micro->bytes = 0;
+        for (size_t i = 0; i < MICRO_CASE_COUNT; i++) {
+            size_t size = 0;
+            if (!rift_bytecode_serialize(micro->programs[i], NULL, &size)) {
+                goto fail;
+            }
+            micro->bytes += size;
+            if (size > micro->buffer_size) {
+                micro->buffer_size = size;
+            }
+        }
+        micro->buffer = malloc(micro->buffer_size);
+        if (!micro->buffer) {
+            goto fail;
+        }
+    }
+    return true;
+
+fail:
+    micro_teardown(micro);
+    *state = NULL;
+    return false;
+}
+
+static size_t
+micro_bytes(void *state)
+{
+    return ((micro_state_t *)state)->bytes;
+}
+
+static bool
+setup_none(const rift_bench_config_t *config, const void *arg, void **state)
+{
+    (void)config;
+    (void)arg;
+    return micro_prepare(MICRO_STAGE_NONE, state);
+}
+
+static bool
+setup_ast(const rift_bench_config_t *config, const void *arg, void **state)
+{
+    (void)config;
+    (void)arg;
+    return micro_prepare(MICRO_STAGE_AST, state);
+}
+
+static bool
+setup_nfa(const rift_bench_config_t *config, const void *arg, void **state)
+{
+    (void)config;
+    (void)arg;
+    return micro_prepare(MICRO_STAGE_NFA, state);
+}
+
+static bool
+setup_dfa(const rift_bench_config_t *config, const void *arg, void **state)
+{
+    (void)config;
+    (void)arg;
+    return micro_prepare(MICRO_STAGE_DFA, state);
+}
+
+static bool
+setup_vm(const rift_bench_config_t *config, const void *arg, void **state)
+{
+    (void)config;
+    (void)arg;
+    return micro_prepare(MICRO_STAGE_VM, state);
+}
+
+static bool
+setup_serialized(const rift_bench_config_t *config, const void *arg, void **state)
+{
+    (void)config;
+    (void)arg;
+    return micro_prepare(MICRO_STAGE_SERIALIZED, state);
+}
+
+static bool
+setup_stack(const rift_bench_config_t *config, const void *arg, void **state)
+{
+    (void)config;
+    (void)arg;
+    if (!micro_prepare(MICRO_STAGE_NONE, state)) {
+        return false;
+    }
+    micro_state_t *micro = *state;
+    micro->stack = rift_backtrack_stack_create(MICRO_STACK_FRAMES, MICRO_CAPTURE_GROUPS);
+    micro->bytes = 0;
+    if (!micro->stack) {
+        micro_teardown(micro);
+        *state = NULL;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Tokenize every pattern
+ */
+static size_t
+run_tokenizer(void *state)
+{
+    (void)state;
+    size_t tokens = 0;
+    for (size_t i = 0; i < MICRO_CASE_COUNT; i++) {
+        const char *pattern = MICRO_CASES[i].pattern;
+        rift_regex_tokenizer_t *tokenizer =
+            rift_regex_tokenizer_create_spans(pattern, strlen(pattern));
+        if (!tokenizer) {
+            continue;
+        }
+        for (;;) {
+            rift_regex_token_t token = rift_regex_tokenizer_next_token(tokenizer);
+            tokens++;
+            if (token.type == RIFT_REGEX_TOKEN_END || token.type == RIFT_REGEX_TOKEN_END_OF_INPUT ||
+                token.type == RIFT_REGEX_TOKEN_ERROR) {
+                break;
+            }
+        }
+        rift_regex_tokenizer_free(tokenizer);
+    }
+    return tokens;
+}
+
+/**
+ * @brief Parse every pattern
+ */
+static size_t
+run_parser(void *state)
+{
+    (void)state;
+    size_t parsed = 0;
+    for (size_t i = 0; i < MICRO_CASE_COUNT; i++) {
+        rift_regex_ast_t *ast = rift_regex_parse(MICRO_CASES[i].pattern, RIFT_REGEX_FLAG_NONE,
+                                                 NULL);
+        parsed += ast != NULL;
+        rift_regex_ast_free(ast);
+    }
+    return parsed;
+}
+
+/**
+ * @brief Build the NFA of every parsed pattern
+ */
+static size_t
+run_nfa_build(void *state)
+{
+    micro_state_t *micro = state;
+    size_t states = 0;
+    for (size_t i = 0; i < MICRO_CASE_COUNT; i++) {
+        rift_regex_automaton_t *nfa =
+            rift_regex_compile_ast(micro->asts[i], RIFT_REGEX_FLAG_NONE, NULL);
+        states += rift_automaton_get_state_count(nfa);
+        rift_automaton_free(nfa);
+    }
+    return states;
+}
+
+/**
+ * @brief Convert every NFA to a DFA
+ */
+static size_t
+run_nfa_to_dfa(void *state)
+{
+    micro_state_t *micro = state;
+    size_t states = 0;
+    for (size_t i = 0; i < MICRO_CASE_COUNT; i++) {
+        rift_regex_automaton_t *dfa = rift_automaton_nfa_to_dfa(micro->nfas[i], NULL);
+        states += rift_automaton_get_state_count(dfa);
+        rift_automaton_free(dfa);
+    }
+    return states;
+}
+
+/**
+ * @brief Minimize every DFA
+ */
+static size_t
+run_minimize(void *state)
+{
+    micro_state_t *micro = state;
+    size_t states = 0;
+    for (size_t i = 0; i < MICRO_CASE_COUNT; i++) {
+        rift_regex_automaton_t *minimal = rift_automaton_minimize_dfa(micro->dfas[i], NULL);
+        states += rift_automaton_get_state_count(minimal);
+        rift_automaton_free(minimal);
+    }
+    return states;
+}
+
+/**
+ * @brief Generate the bytecode of every NFA
+ */
+static size_t
+run_bytecode_compile(void *state)
+{
+    micro_state_t *micro = state;
+    size_t programs = 0;
+    for (size_t i = 0; i < MICRO_CASE_COUNT; i++) {
+        rift_bytecode_program_t *program =
+            rift_bytecode_from_automaton(micro->nfas[i], RIFT_REGEX_FLAG_NONE, NULL);
+        programs += program != NULL;
+        rift_bytecode_program_free(program);
+    }
+    return programs;
+}
+
+/**
+ * @brief Run every program on its subject
+ */
+static size_t
+run_vm_execute(void *state)
+{
+    micro_state_t *micro = state;
+    size_t matches = 0;
+    for (size_t i = 0; i < MICRO_CASE_COUNT; i++) {
+        if (rift_bytecode_vm_bind(micro->vms[i], micro->programs[i], MICRO_CASES[i].subject,
+                                  (size_t)-1)) {
+            matches += rift_bytecode_execute(micro->programs[i], micro->vms[i], NULL);
+        }
+    }
+    return matches;
+}
+
+/**
+ * @brief Push frames to the maximum depth and pop them all
+ */
+static size_t
+run_backtrack_push_pop(void *state)
+{
+    micro_state_t *micro = state;
+    for (size_t i = 0; i < MICRO_STACK_FRAMES; i++) {
+        rift_backtrack_stack_push(micro->stack, NULL, i);
+    }
+
+    size_t sum = 0;
+    struct rift_regex_state *resume;
+    size_t position;
+    while (rift_backtrack_stack_pop(micro->stack, &resume, &position)) {
+        sum += position;
+    }
+    return sum;
+}
+
+/**
+ * @brief Write capture slots under every frame, then roll them all back
+ */
+static size_t
+run_capture_recording(void *state)
+{
+    micro_state_t *micro = state;
+    size_t slots = 2 * MICRO_CAPTURE_GROUPS;
+    for (size_t i = 0; i < MICRO_STACK_FRAMES; i++) {
+        rift_backtrack_stack_push(micro->stack, NULL, i);
+        rift_backtrack_stack_set_slot(micro->stack, (2 * i) % slots, i);
+        rift_backtrack_stack_set_slot(micro->stack, (2 * i + 1) % slots, i + 1);
+    }
+
+    struct rift_regex_state *resume;
+    size_t position;
+    while (rift_backtrack_stack_pop(micro->stack, &resume, &position)) {
+    }
+    return rift_backtrack_stack_get_slot(micro->stack, 0) == RIFT_BACKTRACK_SLOT_UNSET;
+}
+
+/**
+ * @brief Serialize every program and read it back
+ */
+static size_t
+run_serialization(void *state)
+{
+    micro_state_t *micro = state;
+    size_t restored = 0;
+    for (size_t i = 0; i < MICRO_CASE_COUNT; i++) {
+        size_t size = micro->buffer_size;
+        if (!rift_bytecode_serialize(micro->programs[i], micro->buffer, &size)) {
+            continue;
+        }
+        rift_bytecode_program_t *program = rift_bytecode_deserialize(micro->buffer, size, NULL);
+        restored += program != NULL;
+        rift_bytecode_program_free(program);
+    }
+    return restored;
+}
+
+/**
+ * @brief The micro benchmarks, in the order of the pipeline
+ */
+static const rift_bench_t MICRO_BENCHES[] = {
+    {"micro/tokenizer", RIFT_BENCH_MICRO, setup_none, run_tokenizer, micro_teardown, micro_bytes,
+     NULL},
+    {"micro/parser", RIFT_BENCH_MICRO, setup_none, run_parser, micro_teardown, micro_bytes, NULL},
+    {"micro/nfa_build", RIFT_BENCH_MICRO, setup_ast, run_nfa_build, micro_teardown, NULL, NULL},
+    {"micro/nfa_to_dfa", RIFT_BENCH_MICRO, setup_nfa, run_nfa_to_dfa, micro_teardown, NULL,
+     NULL},
+    {"micro/minimize", RIFT_BENCH_MICRO, setup_dfa, run_minimize, micro_teardown, NULL, NULL},
+    {"micro/bytecode_compile", RIFT_BENCH_MICRO, setup_nfa, run_bytecode_compile,
+     micro_teardown, NULL, NULL},
+    {"micro/vm_execute", RIFT_BENCH_MICRO, setup_vm, run_vm_execute, micro_teardown, micro_bytes,
+     NULL},
+    {"micro/backtrack_push_pop", RIFT_BENCH_MICRO, setup_stack, run_backtrack_push_pop,
+     micro_teardown, NULL, NULL},
+    {"micro/capture_recording", RIFT_BENCH_MICRO, setup_stack, run_capture_recording,
+     micro_teardown, NULL, NULL},
+    {"micro/serialization", RIFT_BENCH_MICRO, setup_serialized, run_serialization,
+     micro_teardown, micro_bytes, NULL},
+};
+
+const rift_bench_t *
+rift_bench_micro_list(size_t *count)
+{
+    *count = sizeof(MICRO_BENCHES) / sizeof(MICRO_BENCHES[0]);
+    return MICRO_BENCHES;
+}
@@ -0,0 +1,615 @@
+/**
+ * @file rift_bench.c
+ * @brief Driver of the rift_bench benchmark suite
+ *
+ * Runs the micro, macro and startup benchmarks and writes their results as JSON,
+ * one result per line. Given a baseline, a file it wrote before, every
+ * result is compared with the baseline's time for the same benchmark, and
+ * the run fails when one is slower by more than the threshold, so the
+ * bench_compare target can gate a change. With --counters every result
+ * also carries the hardware counts of an iteration, where the machine
+ * lets them be read. With --compare the macro workloads also run on the
+ * other regex engines the suite was built with, and a table of each
+ * engine's speed relative to LibRift follows the run.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+
+/**
+ * @brief Version of the JSON written, checked when reading a baseline
+ */
+#define RIFT_BENCH_FORMAT_VERSION 1
+
+/**
+ * @brief Longest line read from a baseline
+ */
+#define BASELINE_MAX_LINE 1024
+
+/**
+ * @brief Longest benchmark name read from a baseline
+ */
+#define BASELINE_MAX_NAME 128
+
+/**
+ * @brief Exit status of a run slower than its baseline
+ */
+#define EXIT_REGRESSION 2
+
+/**
+ * @brief Rule of the comparison table, cut to the width of each column
+ */
+#define DASHES "----------------------------------------"
+
+/**
+ * @brief Time of a benchmark in a baseline
+ */
+typedef struct baseline_entry {
+    char name[BASELINE_MAX_NAME]; /**< Name of the benchmark */
+    double ns_per_op;             /**< Its median time */
+    size_t checksum;              /**< Its count */
+} baseline_entry_t;
+
+/**
+ * @brief Options of a run
+ */
+typedef struct bench_options {
+    rift_bench_config_t config; /**< Settings passed to the benchmarks */
+    const char *filter;         /**< Substring of the names run, or NULL for all */
+    bool micro;                 /**< Run the micro benchmarks */
+    bool macro;                 /**< Run the macro benchmarks */
+    bool compare;               /**< Run the comparison benchmarks */
+    bool startup;               /**< Run the startup benchmarks */
+    bool list;                  /**< List the benchmarks instead of running them */
+    const char *output;         /**< JSON output file, or NULL for standard output */
+    const char *baseline;       /**< Baseline compared with, or NULL */
+    double threshold;           /**< Slowdown counted as a regression, as a fraction */
+} bench_options_t;
+
+static void
+print_usage(const char *program)
+{
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "\n"
+            "Options:\n"
+            "  --filter TEXT       Run only the benchmarks whose name contains TEXT\n"
+            "  --micro             Run only the micro benchmarks\n"
+            "  --macro             Run only the macro benchmarks\n"
+            "  --compare           Run only the comparison with other engines\n"
+            "  --startup           Run only the startup benchmarks\n"
+            "  --list              List the benchmarks and exit\n"
+            "  --output FILE       Write the JSON results to FILE (default: stdout)\n"
+            "  --baseline FILE     Compare with the results stored in FILE\n"
+            "  --threshold PCT     Slowdown reported as a regression (default: 10)\n"
+            "  --corpus-size N     Bytes of each macro corpus (default: 4194304)\n"
+            "  --min-time MS       Minimum time of a timed batch (default: 20)\n"
+            "  --repetitions N     Timed batches per benchmark (default: 5)\n"
+            "  --counters          Read cycles, instructions and cache and TLB misses\n"
+            "  --help              Show this help\n"
+            "\n"
+            "Exits with %d when a benchmark is slower than its baseline.\n",
+            program, EXIT_REGRESSION);
+}
+
+/**
+ * @brief Parse a positive number argument
+ */
+static bool
+parse_count(const char *text, size_t *value)
+{
+    char *end;
+    unsigned long long parsed = strtoull(text, &end, 10);
+    if (*text == '\0' || *end != '\0' || parsed == 0) {
+        return false;
+    }
+    *value = (size_t)parsed;
+    return true;
+}
+
+/**
+ * @brief Parse the command line
+ *
+ * @return int 0 to run, 1 on a usage error, -1 after --help
+ */
+static int
+parse_options(int argc, char **argv, bench_options_t *options)
+{
+    memset(options, 0, sizeof(*options));
+    options->config.corpus_size = (size_t)4 << 20;
+    options->config.min_batch_ns = 20000000;
+    options->config.repetitions = 5;
+    options->threshold = 0.10;
+
+    bool only_micro = false;
+    bool only_macro = false;
+    bool only_compare = false;
+    bool only_startup = false;
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        size_t count;
+
+        if (strcmp(arg, "--help") == 0) {
+            print_usage(argv[0]);
+            return -1;
+        } else if (strcmp(arg, "--micro") == 0) {
+            only_micro = true;
+        } else if (strcmp(arg, "--macro") == 0) {
+            only_macro = true;
+        } else if (strcmp(arg, "--compare") == 0) {
+            only_compare = true;
+        } else if (strcmp(arg, "--startup") == 0) {
+            only_startup = true;
+        } else if (strcmp(arg, "--list") == 0) {
+            options->list = true;
+        } else if (strcmp(arg, "--counters") == 0) {
+            options->config.counters = true;
+        } else if (!value) {
+            fprintf(stderr, "Error: unknown option or missing value: %s\n", arg);
+            return 1;
+        } else if (strcmp(arg, "--filter") == 0) {
+            options->filter = value;
+            i++;
+        } else if (strcmp(arg, "--output") == 0) {
+            options->output = value;
+            i++;
+        } else if (strcmp(arg, "--baseline") == 0) {
+            options->baseline = value;
+            i++;
+        } else if (strcmp(arg, "--threshold") == 0) {
+            char *end;
+            double percent = strtod(value, &end);
+            if (*end != '\0' || percent < 0.0) {
+                fprintf(stderr, "Error: invalid threshold: %s\n", value);
+                return 1;
+            }
+            options->threshold = percent / 100.0;
+            i++;
+        } else if (strcmp(arg, "--corpus-size") == 0 && parse_count(value, &count)) {
+            options->config.corpus_size = count;
+            i++;
+        } else if (strcmp(arg, "--min-time") == 0 && parse_count(value, &count)) {
+            options->config.min_batch_ns = (uint64_t)count * 1000000;
+            i++;
+        } else if (strcmp(arg, "--repetitions") == 0 && parse_count(value, &count)) {
+            options->config.repetitions = count;
+            i++;
+        } else {
+            fprintf(stderr, "Error: invalid option: %s %s\n", arg, value);
+            return 1;
+        }
+    }
+
+    /* No kind given runs all but the comparison, which is asked for */
+    bool any = only_micro || only_macro || only_compare || only_startup;
+    options->micro = only_micro || !any;
+    options->macro = only_macro || !any;
+    options->compare = only_compare;
+    options->startup = only_startup || !any;
+    return 0;
+}
+
+/**
+ * @brief Read a number following a JSON key on a line
+ */
+static bool
+read_number(const char *line, const char *key, double *value)
+{
+    const char *found = strstr(line, key);
+    if (!found) {
+        return false;
+    }
+    char *end;
+    *value = strtod(found + strlen(key), &end);
+    return end != found + strlen(key);
+}
+
+/**
+ * @brief Read the results of a baseline
+ *
+ * Only what rift_bench writes is understood: one result per line, the name
+ * first.
+ *
+ * @param path The baseline file
+ * @param count Where the number of entries goes
+ * @return baseline_entry_t* The entries, or NULL on failure
+ */
+static baseline_entry_t *
+read_baseline(const char *path, size_t *count)
+{
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "Error: cannot open baseline %s\n", path);
+        return NULL;
+    }
+
+    baseline_entry_t *entries = NULL;
+    size_t capacity = 0;
+    bool versioned = false;
+    char line[BASELINE_MAX_LINE];
+    *count = 0;
+    while (fgets(line, sizeof(line), file)) {
+        double number;
+        if (read_number(line, "\"version\": ", &number)) {
+            versioned = number == RIFT_BENCH_FORMAT_VERSION;
+            continue;
+        }
+
+        const char *name = strstr(line, "\"name\": \"");
+        double ns_per_op;
+        if (!name || !read_number(line, "\"ns_per_op\": ", &ns_per_op)) {
+            continue;
+        }
+        name += strlen("\"name\": \"");
+        const char *name_end = strchr(name, '"');
+        if (!name_end || (size_t)(name_end - name) >= BASELINE_MAX_NAME) {
+            continue;
+        }
+
+        if (*count == capacity) {
+            capacity = capacity ? capacity * 2 : 32;
+            baseline_entry_t *grown = realloc(entries, capacity * sizeof(*entries));
+            if (!grown) {
+                free(entries);
+                fclose(file);
+                return NULL;
+            }
+            entries = grown;
+        }
+        baseline_entry_t *entry = &entries[(*count)++];
+        memcpy(entry->name, name, (size_t)(name_end - name));
+        entry->name[name_end - name] = '\0';
+        entry->ns_per_op = ns_per_op;
+        entry->checksum = read_number(line, "\"checksum\": ", &number) ? (size_t)number : 0;
+    }
+    fclose(file);
+
+    if (!versioned) {
+        fprintf(stderr, "Error: %s is not a rift_bench baseline of version %d\n", path,
+                RIFT_BENCH_FORMAT_VERSION);
+        free(entries);
+        return NULL;
+    }
+    return entries;
+}
+
+/**
+ * @brief Find a benchmark in a baseline
+ */
+static const baseline_entry_t *
+find_baseline(const baseline_entry_t *entries, size_t count, const char *name)
+{
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(entries[i].name, name) == 0) {
+            return &entries[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Write the hardware counts of an iteration, null for events not counted
+ */
+static void
+write_counters(FILE *out, const rift_bench_result_t *result)
+{
+    double iterations = result->iterations > 0 ? (double)result->iterations : 1.0;
+    fprintf(out, ", \"counters\": {");
+    for (size_t i = 0; i < RIFT_PERF_EVENT_COUNT; i++) {
+        fprintf(out, "%s\"%s\": ", i ? ", " : "", rift_perf_event_name((rift_perf_event_t)i));
+        if (result->counters.valid[i]) {
+            fprintf(out, "%.3f", (double)result->counters.values[i] / iterations);
+        } else {
+            fprintf(out, "null");
+        }
+    }
+    fprintf(out, "}");
+
+    const rift_perf_sample_t *counters = &result->counters;
+    if (counters->valid[RIFT_PERF_EVENT_CYCLES] && counters->valid[RIFT_PERF_EVENT_INSTRUCTIONS] &&
+        counters->values[RIFT_PERF_EVENT_CYCLES] > 0) {
+        fprintf(stderr, " %5.2f IPC",
+                (double)counters->values[RIFT_PERF_EVENT_INSTRUCTIONS] /
+                    (double)counters->values[RIFT_PERF_EVENT_CYCLES]);
+    }
+}
+
+/**
+ * @brief Name of a kind of benchmark in the JSON
+ */
+static const char *
+kind_name(rift_bench_kind_t kind)
+{
+    switch (kind) {
+    case RIFT_BENCH_MICRO:
+        return "micro";
+    case RIFT_BENCH_MACRO:
+        return "macro";
+    case RIFT_BENCH_COMPARE:
+        return "compare";
+    case RIFT_BENCH_STARTUP:
+        return "startup";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Write a result and its comparison with the baseline
+ *
+ * @return bool True if the result is a regression
+ */
+static bool
+write_result(FILE *out, const rift_bench_result_t *result, const baseline_entry_t *baseline,
+             const bench_options_t *options, bool last)
+{
+    const rift_bench_t *bench = result->bench;
+    double mb_per_s = result->bytes_per_op && result->ns_per_op > 0.0
+                          ? (double)result->bytes_per_op * 1000.0 / result->ns_per_op
+                          : 0.0;
+    fprintf(out,
+            "    {\"name\": \"%s\", \"kind\": \"%s\", \"iterations\": %llu, "
+            "\"ns_per_op\": %.3f, \"min_ns_per_op\": %.3f, \"max_ns_per_op\": %.3f, "
+            "\"bytes_per_op\": %zu, \"mb_per_s\": %.3f, \"checksum\": %zu",
+            bench->name, kind_name(bench->kind),
+            (unsigned long long)result->iterations, result->ns_per_op, result->min_ns_per_op,
+            result->max_ns_per_op, result->bytes_per_op, mb_per_s, result->checksum);
+    fprintf(stderr, "%-32s %14.1f ns/op", bench->name, result->ns_per_op);
+    if (mb_per_s > 0.0) {
+        fprintf(stderr, " %10.1f MB/s", mb_per_s);
+    }
+    if (options->config.counters) {
+        write_counters(out, result);
+    }
+
+    bool regression = false;
+    if (baseline && baseline->ns_per_op > 0.0) {
+        double change = result->ns_per_op / baseline->ns_per_op - 1.0;
+        regression = change > options->threshold;
+        fprintf(out, ", \"baseline_ns_per_op\": %.3f, \"change\": %.4f, \"regression\": %s",
+                baseline->ns_per_op, change, regression ? "true" : "false");
+        fprintf(stderr, " %+7.1f%%%s", change * 100.0, regression ? "  REGRESSION" : "");
+        if (baseline->checksum != result->checksum) {
+            fprintf(stderr, "  (checksum %zu, was %zu)", result->checksum, baseline->checksum);
+        }
+    } else if (options->baseline) {
+        fprintf(stderr, "  (not in baseline)");
+    }
+    fprintf(out, "}%s\n", last ? "" : ",");
+    fprintf(stderr, "\n");
+    return regression;
+}
+
+/**
+ * @brief Whether a benchmark is selected by the options
+ */
+static bool
+is_selected(const rift_bench_t *bench, const bench_options_t *options)
+{
+    bool kind = false;
+    switch (bench->kind) {
+    case RIFT_BENCH_MICRO:
+        kind = options->micro;
+        break;
+    case RIFT_BENCH_MACRO:
+        kind = options->macro;
+        break;
+    case RIFT_BENCH_COMPARE:
+        kind = options->compare;
+        break;
+    case RIFT_BENCH_STARTUP:
+        kind = options->startup;
+        break;
+    }
+    return kind && (!options->filter || strstr(bench->name, options->filter));
+}
+
+/**
+ * @brief Split the name of a comparison benchmark into its engine and workload
+ *
+ * @return bool False if the name is not one of a comparison benchmark
+ */
+static bool
+split_compare_name(const char *name, const char **engine, size_t *engine_length,
+                   const char **workload)
+{
+    const char *prefix = "compare/";
+    if (strncmp(name, prefix, strlen(prefix)) != 0) {
+        return false;
+    }
+    *engine = name + strlen(prefix);
+    const char *slash = strchr(*engine, '/');
+    if (!slash) {
+        return false;
+    }
+    *engine_length = (size_t)(slash - *engine);
+    *workload = slash + 1;
+    return true;
+}
+
+/**
+ * @brief Print the comparison benchmarks as a Markdown table, relative to LibRift
+ *
+ * A row per workload and engine, searches in MB/s and compilations in
+ * microseconds; the ratio is the engine's speed over LibRift's, above 1
+ * when the engine is faster.
+ */
+static void
+print_comparison(const rift_bench_result_t *results, size_t measured)
+{
+    bool header = false;
+    for (size_t i = 0; i < measured; i++) {
+        const char *engine;
+        size_t engine_length;
+        const char *workload;
+        if (!split_compare_name(results[i].bench->name, &engine, &engine_length, &workload) ||
+            strncmp(engine, "librift", engine_length) != 0) {
+            continue;
+        }
+        if (!header) {
+            fprintf(stderr, "\n| %-32s | %-10s | %12s | %12s | %9s |\n", "Workload", "Engine",
+                    "us/op", "MB/s", "vs librift");
+            fprintf(stderr, "|%.34s|%.12s|%.14s|%.14s|%.12s|\n", DASHES, DASHES, DASHES, DASHES,
+                    DASHES);
+            header = true;
+        }
+
+        /* LibRift first, then every engine that ran the same workload */
+        const rift_bench_result_t *reference = &results[i];
+        for (size_t j = i; j < measured; j++) {
+            const char *other;
+            size_t other_length;
+            const char *other_workload;
+            if (!split_compare_name(results[j].bench->name, &other, &other_length,
+                                    &other_workload) ||
+                strcmp(other_workload, workload) != 0 ||
+                (j != i && strncmp(other, "librift", other_length) == 0)) {
+                continue;
+            }
+            const rift_bench_result_t *result = &results[j];
+            double mb_per_s = result->bytes_per_op && result->ns_per_op > 0.0
+                                  ? (double)result->bytes_per_op * 1000.0 / result->ns_per_op
+                                  : 0.0;
+            double ratio = result->ns_per_op > 0.0 ? reference->ns_per_op / result->ns_per_op : 0.0;
+            fprintf(stderr, "| %-32s | %-10.*s | %12.1f | ", workload, (int)other_length, other,
+                    result->ns_per_op / 1000.0);
+            if (mb_per_s > 0.0) {
+                fprintf(stderr, "%12.1f", mb_per_s);
+            } else {
+                fprintf(stderr, "%12s", "");
+            }
+            fprintf(stderr, " | %9.2fx |", ratio);
+            if (j != i && result->checksum != reference->checksum) {
+                fprintf(stderr, " %zu matches, librift %zu", result->checksum,
+                        reference->checksum);
+            }
+            fprintf(stderr, "\n");
+        }
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+    /* A child of a startup benchmark */
+    if (argc == 3 && strcmp(argv[1], "--startup-child") == 0) {
+        return rift_bench_startup_child(argv[2]);
+    }
+
+    bench_options_t options;
+    int parsed = parse_options(argc, argv, &options);
+    if (parsed != 0) {
+        return parsed < 0 ? 0 : 1;
+    }
+
+    /* Gather the selected benchmarks */
+    size_t micro_count;
+    size_t macro_count;
+    size_t compare_count;
+    size_t startup_count;
+    const rift_bench_t *micro = rift_bench_micro_list(&micro_count);
+    const rift_bench_t *macro = rift_bench_macro_list(&macro_count);
+    const rift_bench_t *compare = rift_bench_compare_list(&compare_count);
+    const rift_bench_t *startup = rift_bench_startup_list(&startup_count);
+    size_t total = micro_count + macro_count + compare_count + startup_count;
+    const rift_bench_t **selected = malloc(total * sizeof(*selected));
+    if (!selected) {
+        return 1;
+    }
+    size_t count = 0;
+    const rift_bench_t *lists[] = {micro, macro, compare, startup};
+    size_t counts[] = {micro_count, macro_count, compare_count, startup_count};
+    for (size_t l = 0; l < sizeof(lists) / sizeof(lists[0]); l++) {
+        for (size_t i = 0; i < counts[l]; i++) {
+            if (is_selected(&lists[l][i], &options)) {
+                selected[count++] = &lists[l][i];
+            }
+        }
+    }
+
+    if (options.list) {
+        for (size_t i = 0; i < count; i++) {
+            printf("%s\n", selected[i]->name);
+        }
+        free(selected);
+        return 0;
+    }
+
+    baseline_entry_t *baseline = NULL;
+    size_t baseline_count = 0;
+    if (options.baseline) {
+        baseline = read_baseline(options.baseline, &baseline_count);
+        if (!baseline) {
+            free(selected);
+            return 1;
+        }
+    }
+
+    /* Measure first, so a baseline can be rewritten in place */
+    rift_bench_result_t *results = calloc(count ? count : 1, sizeof(*results));
+    if (!results) {
+        free(baseline);
+        free(selected);
+        return 1;
+    }
+    size_t measured = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (rift_bench_measure(selected[i], &options.config, &results[measured])) {
+            measured++;
+        } else {
+            fprintf(stderr, "%-32s skipped: setup failed\n", selected[i]->name);
+        }
+    }
+
+    FILE *out = options.output ? fopen(options.output, "w") : stdout;
+    if (!out) {
+        fprintf(stderr, "Error: cannot open %s\n", options.output);
+        free(results);
+        free(baseline);
+        free(selected);
+        return 1;
+    }
+
+    fprintf(out, "{\n  \"suite\": \"rift_bench\",\n  \"version\": %d,\n",
+            RIFT_BENCH_FORMAT_VERSION);
+    fprintf(out,
+            "  \"config\": {\"corpus_size\": %zu, \"min_batch_ns\": %llu, "
+            "\"repetitions\": %zu, \"counters\": %s},\n",
+            options.config.corpus_size, (unsigned long long)options.config.min_batch_ns,
+            options.config.repetitions, options.config.counters ? "true" : "false");
+    fprintf(out, "  \"results\": [\n");
+    size_t regressions = 0;
+    for (size_t i = 0; i < measured; i++) {
+        const baseline_entry_t *entry =
+            find_baseline(baseline, baseline_count, results[i].bench->name);
+        regressions += write_result(out, &results[i], entry, &options, i + 1 == measured);
+    }
+    fprintf(out, "  ],\n  \"skipped\": %zu,\n  \"regressions\": %zu\n}\n", count - measured,
+            regressions);
+
+    bool written = !ferror(out);
+    if (out != stdout) {
+        written = fclose(out) == 0 && written;
+    }
+    if (options.compare) {
+        print_comparison(results, measured);
+    }
+    if (options.baseline) {
+        fprintf(stderr, "%zu of %zu benchmarks slower than the baseline by more than %.1f%%\n",
+                regressions, measured, options.threshold * 100.0);
+    }
+
+    free(results);
+    free(baseline);
+    free(selected);
+    if (!written) {
+        fprintf(stderr, "Error: cannot write the results\n");
+        return 1;
+    }
+    return regressions > 0 ? EXIT_REGRESSION : 0;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file startup.c
+ * @brief Startup benchmarks of the rift_bench suite
+ *
+ * A short-lived command pays for process creation, loading the library and
+ * whatever it initializes before its first match. An iteration of these
+ * benchmarks starts rift_bench again as a child that compiles one pattern,
+ * finds its first match and exits, so the time includes every one-time
+ * initialization the first match triggers. The startup/exec benchmark
+ * starts a child that exits at once; the difference is what LibRift adds.
+ *
+ * The children find rift_bench through /proc/self/exe, so the benchmarks
+ * are skipped where it does not exist.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <limits.h>
+#include <spawn.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "bench.h"
+#include "core/automaton/flags.h"
+#include "core/engine/pattern.h"
+#include "core/runtime/matcher.h"
+
+extern char **environ;
+
+/**
+ * @brief Pattern and subject of the first match
+ */
+#define STARTUP_PATTERN "[a-z]+@[a-z]+\\.com"
+#define STARTUP_SUBJECT "contact: someone@example.com"
+
+/**
+ * @brief What a child does before exiting
+ */
+typedef struct startup_case {
+    const char *name;              /**< Name passed to the child */
+    bool match;                    /**< Find the first match, or exit at once */
+    rift_matcher_option_t options; /**< Options of the matcher */
+} startup_case_t;
+
+/**
+ * @brief State of a startup benchmark
+ */
+typedef struct startup_state {
+    const startup_case_t *c; /**< The case */
+    char path[PATH_MAX];     /**< Path of rift_bench */
+} startup_state_t;
+
+static const startup_case_t STARTUP_CASES[] = {
+    {"exec", false, RIFT_MATCHER_OPTION_NONE},
+    {"first_match", true, RIFT_MATCHER_OPTION_NONE},
+    {"first_match_lazy_dfa", true, RIFT_MATCHER_OPTION_LAZY_DFA},
+};
+
+#define STARTUP_CASE_COUNT (sizeof(STARTUP_CASES) / sizeof(STARTUP_CASES[0]))
+
+int
+rift_bench_startup_child(const char *name)
+{
+    const startup_case_t *c = NULL;
+    for (size_t i = 0; i < STARTUP_CASE_COUNT; i++) {
+        if (strcmp(STARTUP_CASES[i].name, name) == 0) {
+            c = &STARTUP_CASES[i];
+        }
+    }
+    if (!c) {
+        return 2;
+    }
+    if (!c->match) {
+        return 0;
+    }
+
+    rift_regex_pattern_t *pattern = rift_regex_compile(STARTUP_PATTERN, RIFT_REGEX_FLAG_NONE, NULL);
+    rift_regex_matcher_t *matcher = pattern ? rift_matcher_create(pattern, c->options) : NULL;
+    rift_regex_match_t match;
+    bool found = matcher &&
+                 rift_matcher_set_input(matcher, STARTUP_SUBJECT, strlen(STARTUP_SUBJECT)) &&
+                 rift_matcher_find_next(matcher, &match);
+    rift_matcher_free(matcher);
+    rift_regex_pattern_free(pattern);
+    return found ? 0 : 1;
+}
+
+static bool
+startup_setup(const rift_bench_config_t *config, const void *arg, void **state)
+{
+    (void)config;
+    startup_state_t *startup = calloc(1, sizeof(*startup));
+    if (!startup) {
+        return false;
+    }
+    startup->c = arg;
+
+    ssize_t length = readlink("/proc/self/exe", startup->path, sizeof(startup->path) - 1);
+    if (length <= 0) {
+        free(startup);
+        return false;
+    }
+    startup->path[length] = '\0';
+    *state = startup;
+    return true;
+}
+
+/**
+ * @brief Start a child and wait for it
+ *
+ * @return size_t 1 if the child did its work, 0 otherwise
+ */
+static size_t
+startup_run(void *state)
+{
+    startup_state_t *startup = state;
+    char *argv[] = {startup->path, "--startup-child", (char *)startup->c->name, NULL};
+    pid_t pid;
+    if (posix_spawn(&pid, startup->path, NULL, NULL, argv, environ) != 0) {
+        return 0;
+    }
+
+    int status;
+    if (waitpid(pid, &status, 0) != pid) {
+        return 0;
+    }
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+static void
+startup_teardown(void *state)
+{
+    free(state);
+}
+
+static const rift_bench_t STARTUP_BENCHES[] = {
+    {"startup/exec", RIFT_BENCH_STARTUP, startup_setup, startup_run, startup_teardown, NULL,
+     &STARTUP_CASES[0]},
+    {"startup/first_match", RIFT_BENCH_STARTUP, startup_setup, startup_run, startup_teardown, NULL,
+     &STARTUP_CASES[1]},
+    {"startup/first_match_lazy_dfa", RIFT_BENCH_STARTUP, startup_setup, startup_run,
+     startup_teardown, NULL, &STARTUP_CASES[2]},
+};
+
+const rift_bench_t *
+rift_bench_startup_list(size_t *count)
+{
+    *count = sizeof(STARTUP_BENCHES) / sizeof(STARTUP_BENCHES[0]);
+    return STARTUP_BENCHES;
+}
@@ -0,0 +1,23 @@
+# Print the size of a build artifact, raw and gzip-compressed
+# Usage: cmake -DARTIFACT=<path> -P ReportSize.cmake
+
+if(NOT EXISTS "${ARTIFACT}")
+    message(FATAL_ERROR "ReportSize: ${ARTIFACT} does not exist")
+endif()
+
+get_filename_component(artifact_name "${ARTIFACT}" NAME)
+file(SIZE "${ARTIFACT}" artifact_size)
+
+# Web users download the module compressed, so report that size as well
+set(compressed "${ARTIFACT}.size.tar.gz")
+execute_process(
+    COMMAND ${CMAKE_COMMAND} -E tar czf "${compressed}" "${ARTIFACT}"
+    RESULT_VARIABLE tar_result
+)
+if(tar_result EQUAL 0)
+    file(SIZE "${compressed}" compressed_size)
+    file(REMOVE "${compressed}")
+    message(STATUS "${artifact_name}: ${artifact_size} bytes, ${compressed_size} bytes compressed")
+else()
+    message(STATUS "${artifact_name}: ${artifact_size} bytes")
+endif()
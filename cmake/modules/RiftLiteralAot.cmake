@@ -0,0 +1,49 @@
+# Compile the R'' regex literals of a target's sources at build time
+# Usage: rift_precompile_literals(<target> <source>...)
+#
+# Every source is run through rift_literal_aot, which compiles its R'...' and
+# R"..." literals, failing the build on a bad pattern, and writes the source
+# back out with each literal replaced by a rift_regex_pattern_t * loaded from
+# an embedded image on first use. The rewritten sources are added to the
+# target in place of the originals, so list them here and not in
+# add_executable() or add_library().
+#
+# The images only load on a machine of the build's byte order. When
+# cross-compiling, set LIBRIFT_LITERAL_AOT to a host build of the tool; the
+# literals are then still checked at build time but compiled on first use.
+
+set(LIBRIFT_LITERAL_AOT "" CACHE FILEPATH
+    "Host build of rift_literal_aot, used when cross-compiling")
+
+function(rift_precompile_literals target)
+    if(CMAKE_CROSSCOMPILING)
+        if(NOT LIBRIFT_LITERAL_AOT)
+            message(FATAL_ERROR
+                "rift_precompile_literals: set LIBRIFT_LITERAL_AOT when cross-compiling")
+        endif()
+        set(tool ${LIBRIFT_LITERAL_AOT})
+        set(tool_options --runtime)
+    else()
+        set(tool rift_literal_aot)
+        set(tool_options)
+    endif()
+
+    foreach(source ${ARGN})
+        get_filename_component(source_path "${source}" ABSOLUTE)
+        file(RELATIVE_PATH relative "${CMAKE_CURRENT_SOURCE_DIR}" "${source_path}")
+        string(REPLACE "../" "__/" relative "${relative}")
+        set(output ${CMAKE_CURRENT_BINARY_DIR}/rift_literals/${relative})
+        get_filename_component(output_dir "${output}" DIRECTORY)
+
+        add_custom_command(
+            OUTPUT ${output}
+            COMMAND ${CMAKE_COMMAND} -E make_directory ${output_dir}
+            COMMAND ${tool} ${tool_options} ${source_path} ${output}
+            DEPENDS ${tool} ${source_path}
+            COMMENT "Precompiling the regex literals of ${relative}"
+        )
+        target_sources(${target} PRIVATE ${output})
+    endforeach()
+
+    target_link_libraries(${target} PRIVATE librift_core)
+endfunction()
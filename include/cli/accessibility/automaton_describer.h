@@ -0,0 +1,116 @@
+/**
+ * @file automaton_describer.h
+ * @brief Lazily generated textual descriptions of automata for screen readers
+ *
+ * The describer writes the description of a state only when a screen reader
+ * asks for it, for the focused state or the states in view, and keeps it
+ * until the state changes. Its observer drops the descriptions a change
+ * made stale, so navigating a large automaton costs the states visited
+ * rather than the whole automaton.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "cli/visualizer/automaton_observer.h"
+#include "core/automaton/automaton.h"
+#ifndef LIBRIFT_CLI_ACCESSIBILITY_AUTOMATON_DESCRIBER_H
+#define LIBRIFT_CLI_ACCESSIBILITY_AUTOMATON_DESCRIBER_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Forward declaration of the automaton describer structure
+ */
+typedef struct rift_automaton_describer rift_automaton_describer_t;
+
+/**
+ * @brief Creates a new automaton describer
+ *
+ * @return rift_automaton_describer_t* A new describer or NULL on failure
+ */
+rift_automaton_describer_t *rift_automaton_describer_create(void);
+
+/**
+ * @brief Destroys a describer and the descriptions it holds
+ *
+ * @param describer The describer to destroy (can be NULL)
+ */
+void rift_automaton_describer_destroy(rift_automaton_describer_t *describer);
+
+/**
+ * @brief Sets the automaton described
+ *
+ * Nothing is described yet; descriptions of a previous automaton are dropped.
+ *
+ * @param describer The describer
+ * @param automaton The automaton, or NULL to detach
+ * @return bool True if successful, false otherwise
+ */
+bool rift_automaton_describer_attach(rift_automaton_describer_t *describer,
+                                     rift_regex_automaton_t *automaton);
+
+/**
+ * @brief Gets the observer to notify of changes to the described automaton
+ *
+ * A change to a state drops its description, a change to a transition the
+ * description of its source state, and a whole-automaton update every
+ * description.
+ *
+ * @param describer The describer
+ * @return rift_automaton_observer_t* The observer or NULL on error
+ */
+rift_automaton_observer_t *
+rift_automaton_describer_get_observer(rift_automaton_describer_t *describer);
+
+/**
+ * @brief Describes a state, such as the one with the focus
+ *
+ * @param describer The describer
+ * @param state A state of the attached automaton
+ * @return const char* The description, owned by the describer and valid until the state
+ *         changes or the automaton is detached, or NULL on error
+ */
+const char *rift_automaton_describer_describe_state(rift_automaton_describer_t *describer,
+                                                    const rift_regex_state_t *state);
+
+/**
+ * @brief Describes the states in view
+ *
+ * @param describer The describer
+ * @param first Index of the first state in view
+ * @param count Number of states in view
+ * @param descriptions Where the descriptions go, count of them
+ * @return size_t The number of states described, fewer past the last state
+ */
+size_t rift_automaton_describer_describe_range(rift_automaton_describer_t *describer,
+                                               size_t first, size_t count,
+                                               const char **descriptions);
+
+/**
+ * @brief Describes the attached automaton as a whole
+ *
+ * @param describer The describer
+ * @return const char* The description, owned by the describer and valid until the automaton
+ *         changes, or NULL on error
+ */
+const char *rift_automaton_describer_describe_summary(rift_automaton_describer_t *describer);
+
+/**
+ * @brief Gets the number of state descriptions held
+ *
+ * @param describer The describer
+ * @return size_t The number of states described and not changed since
+ */
+size_t rift_automaton_describer_get_cached_count(const rift_automaton_describer_t *describer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_CLI_ACCESSIBILITY_AUTOMATON_DESCRIBER_H */
@@ -20,7 +20,7 @@
 typedef struct {
     char *input_file;      /**< Input file path (source or parse tree) */
     char *output_file;     /**< Output file path for AST */
-    char *format;          /**< Output format (json, dot, text) */
+    char *format;          /**< Output format (text, json, ndjson, cbor, dot) */
     char *transform_file;  /**< Transformation rules file */
     bool optimize;         /**< Apply AST optimizations */
     char *parse_tree_file; /**< Parse tree file to use as input (if not processing source) */
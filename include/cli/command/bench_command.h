@@ -0,0 +1,128 @@
+/**
+ * @file bench_command.h
+ * @brief Command implementation for benchmarking patterns on every engine
+ *
+ * This file defines the interface for the bench command, which compiles a
+ * pattern, or a .rift DSL ruleset, and searches a corpus with it on each
+ * engine, reporting compile time, memory, throughput and latency
+ * percentiles as a table, JSON or CSV.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "cli/command/command.h"
+#include "core/automaton/flags.h"
+#ifndef LIBRIFT_CLI_COMMANDS_BENCH_COMMAND_H
+#define LIBRIFT_CLI_COMMANDS_BENCH_COMMAND_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Output formats of the bench command
+ */
+typedef enum rift_bench_format {
+    RIFT_BENCH_FORMAT_TEXT, /**< Aligned table */
+    RIFT_BENCH_FORMAT_JSON, /**< One JSON document */
+    RIFT_BENCH_FORMAT_CSV   /**< One CSV row per engine, after a header row */
+} rift_bench_format_t;
+
+/**
+ * @brief Repetitions of each measurement when none are given
+ */
+#define RIFT_BENCH_DEFAULT_REPEATS 5
+
+/**
+ * @brief Lines of the corpus timed one by one for the latency percentiles
+ */
+#define RIFT_BENCH_DEFAULT_LATENCY_SAMPLES 10000
+
+/**
+ * @brief Bench command options structure
+ */
+typedef struct rift_bench_options rift_bench_options_t;
+struct rift_bench_options {
+    char *pattern;              /**< Regex pattern benchmarked */
+    char *rules_file;           /**< .rift ruleset benchmarked instead of a pattern */
+    char *input_file;           /**< Corpus searched */
+    char **engines;             /**< Engines to run, all of them when empty */
+    size_t num_engines;         /**< Number of engines */
+    size_t warmup;              /**< Untimed searches before the measured ones */
+    size_t repeats;             /**< Measured compilations and searches */
+    size_t latency_samples;     /**< Lines timed one by one, 0 to skip latencies */
+    rift_bench_format_t format; /**< Output format */
+    rift_regex_flags_t flags;   /**< Compilation flags of the pattern */
+};
+
+/**
+ * @brief Command structure for bench command
+ */
+typedef struct rift_bench_command rift_bench_command_t;
+struct rift_bench_command {
+    rift_command_type_t type;     /**< Command type */
+    bool verbose;                 /**< Verbose output flag */
+    bool quiet;                   /**< Quiet mode flag */
+    rift_bench_options_t options; /**< Command-specific options */
+};
+
+/**
+ * @brief Create a new bench command instance
+ *
+ * @return A new bench command or NULL on failure
+ */
+rift_command_t *rift_bench_command_create(void);
+
+/**
+ * @brief Get the options for a bench command
+ *
+ * @param command The bench command
+ * @return Pointer to the bench options or NULL on error
+ */
+rift_bench_options_t *rift_bench_command_get_options(rift_command_t *command);
+
+/**
+ * @brief Parse the arguments of a bench command
+ *
+ * @param command The bench command
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @return true if parsing was successful, false otherwise
+ */
+bool rift_bench_command_parse_args(rift_command_t *command, int argc, char *argv[]);
+
+/**
+ * @brief Execute a bench command
+ *
+ * Engines that cannot run the pattern are reported as unavailable with the
+ * reason rather than failing the command.
+ *
+ * @param command The bench command
+ * @return 0 on success, non-zero on failure
+ */
+int rift_bench_command_execute(rift_command_t *command);
+
+/**
+ * @brief Get help information for a bench command
+ *
+ * @param command The bench command
+ * @return Help string for the command
+ */
+const char *rift_bench_command_get_help(const rift_command_t *command);
+
+/**
+ * @brief Free a bench command and its options
+ *
+ * @param command The command to free
+ */
+void rift_bench_command_free(rift_command_t *command);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_CLI_COMMANDS_BENCH_COMMAND_H */
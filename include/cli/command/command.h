@@ -45,6 +45,12 @@ typedef enum rift_command_type {
     RIFT_COMMAND_VISUALIZE, /**< Visualize a pattern automaton */
     RIFT_COMMAND_BENCHMARK, /**< Benchmark regex performance */
     RIFT_COMMAND_CONFIG,    /**< Manage configuration */
+    RIFT_COMMAND_GREP,      /**< Search files for patterns */
+    RIFT_COMMAND_PROFILE,   /**< Profile the cost of patterns */
+    RIFT_COMMAND_TRACE,     /**< Trace the search of a pattern */
+    RIFT_COMMAND_EXPLAIN,   /**< Explain the engine chosen for a pattern */
+    RIFT_COMMAND_LINT,      /**< Report redundant rules of a ruleset */
+    RIFT_COMMAND_SERVE,     /**< Serve a ruleset to match requests */
     RIFT_COMMAND_UNKNOWN    /**< Unknown command */
 } rift_command_type_t;
 
@@ -62,6 +68,12 @@ typedef enum rift_command_type {
     RIFT_COMMAND_VISUALIZE, /**< Visualize a pattern automaton */
     RIFT_COMMAND_BENCHMARK, /**< Benchmark regex performance */
     RIFT_COMMAND_CONFIG,    /**< Manage configuration */
+    RIFT_COMMAND_GREP,      /**< Search files for patterns */
+    RIFT_COMMAND_PROFILE,   /**< Profile the cost of patterns */
+    RIFT_COMMAND_TRACE,     /**< Trace the search of a pattern */
+    RIFT_COMMAND_EXPLAIN,   /**< Explain the engine chosen for a pattern */
+    RIFT_COMMAND_LINT,      /**< Report redundant rules of a ruleset */
+    RIFT_COMMAND_SERVE,     /**< Serve a ruleset to match requests */
     RIFT_COMMAND_UNKNOWN    /**< Unknown command */
 } rift_command_type_t;
 
@@ -3,7 +3,9 @@
  * @brief Command implementation for compiling regex patterns
  *
  * This file defines the interface for the compile command, which compiles
- * regex patterns to their automaton representation.
+ * regex patterns to their automaton representation, or in batch mode every
+ * .rift ruleset and pattern list of a directory or manifest to mappable
+ * bytecode containers.
  *
  * @copyright Copyright (c) 2025 LibRift Project
  * @license MIT License
@@ -47,6 +49,13 @@ typedef struct rift_compile_options rift_compile_options_t;
 struct rift_compile_options {
     char *pattern;            /**< Regex pattern string */
     char *output_file;        /**< Output file path */
+    char *emit_c_file;        /**< Path of the generated C source, or NULL */
+    char *emit_c_prefix;      /**< Prefix of the generated C names, or NULL for the default */
+    bool batch;               /**< Whether the pattern names a directory or @manifest */
+    size_t jobs;              /**< Files compiled at once in batch mode, 0 for one per CPU */
+    char *output_dir;         /**< Directory of the batch containers, NULL beside the sources */
+    char *cache_dir;          /**< Build cache directory of batch mode, or NULL for none */
+    bool prune_redundant;     /**< Leave rules another rule covers out of batch containers */
     bool use_rift_syntax;     /**< Whether to use LibRift r'' syntax */
     bool optimize;            /**< Whether to optimize the automaton */
     bool use_dfa;             /**< Whether to use DFA when possible */
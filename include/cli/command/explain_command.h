@@ -0,0 +1,105 @@
+/**
+ * @file explain_command.h
+ * @brief Command implementation for explaining the engine chosen for a pattern
+ *
+ * This file defines the interface for the explain command, which compiles a
+ * pattern and prints the engine plan recorded on it: the engine a search
+ * starts with, whether each of the matcher's engines can run the pattern
+ * and why, and the ambiguity verdict the choice rests on.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "cli/command/command.h"
+#include "core/automaton/flags.h"
+#ifndef LIBRIFT_CLI_COMMANDS_EXPLAIN_COMMAND_H
+#define LIBRIFT_CLI_COMMANDS_EXPLAIN_COMMAND_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Explain command options structure
+ */
+typedef struct rift_explain_options rift_explain_options_t;
+struct rift_explain_options {
+    char *pattern;            /**< Regex pattern explained */
+    bool json;                /**< Print the plan as JSON */
+    rift_regex_flags_t flags; /**< Compilation flags of the pattern */
+};
+
+/**
+ * @brief Command structure for explain command
+ */
+typedef struct rift_explain_command rift_explain_command_t;
+struct rift_explain_command {
+    rift_command_type_t type;       /**< Command type */
+    bool verbose;                   /**< Verbose output flag */
+    bool quiet;                     /**< Quiet mode flag */
+    rift_explain_options_t options; /**< Command-specific options */
+};
+
+/**
+ * @brief Create a new explain command instance
+ *
+ * @return A new explain command or NULL on failure
+ */
+rift_command_t *rift_explain_command_create(void);
+
+/**
+ * @brief Get the options for an explain command
+ *
+ * @param command The explain command
+ * @return Pointer to the explain options or NULL on error
+ */
+rift_explain_options_t *rift_explain_command_get_options(rift_command_t *command);
+
+/**
+ * @brief Parse the arguments of an explain command
+ *
+ * The first argument that is not an option is the pattern.
+ *
+ * @param command The explain command
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @return true if parsing was successful, false otherwise
+ */
+bool rift_explain_command_parse_args(rift_command_t *command, int argc, char *argv[]);
+
+/**
+ * @brief Execute an explain command
+ *
+ * The plan describes a default search. Matcher options that force an
+ * engine, and memory budgets too small for the DFA engines, are applied
+ * when the search runs and can move it further down the list.
+ *
+ * @param command The explain command
+ * @return 0 on success, non-zero on failure
+ */
+int rift_explain_command_execute(rift_command_t *command);
+
+/**
+ * @brief Get help information for an explain command
+ *
+ * @param command The explain command
+ * @return Help string for the command
+ */
+const char *rift_explain_command_get_help(const rift_command_t *command);
+
+/**
+ * @brief Free an explain command and its options
+ *
+ * @param command The command to free
+ */
+void rift_explain_command_free(rift_command_t *command);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_CLI_COMMANDS_EXPLAIN_COMMAND_H */
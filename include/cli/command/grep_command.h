@@ -0,0 +1,117 @@
+/**
+ * @file grep_command.h
+ * @brief Command implementation for searching files with regex patterns
+ *
+ * This file defines the interface for the grep command, which searches
+ * files and directory trees for one or more patterns or the rules of a
+ * .rift DSL ruleset, and prints the matching lines, the match spans, the
+ * match counts or JSON records.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "cli/command/command.h"
+#include "core/automaton/flags.h"
+#ifndef LIBRIFT_CLI_COMMANDS_GREP_COMMAND_H
+#define LIBRIFT_CLI_COMMANDS_GREP_COMMAND_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Grep command options structure
+ */
+typedef struct rift_grep_options rift_grep_options_t;
+struct rift_grep_options {
+    char **patterns;          /**< Regex patterns searched for */
+    size_t num_patterns;      /**< Number of patterns */
+    char *rules_file;         /**< .rift ruleset or bytecode container, instead of patterns */
+    char **paths;             /**< Files and directories searched, "." when none is given */
+    size_t num_paths;         /**< Number of paths */
+    bool count_only;          /**< Whether to print the number of matches per file */
+    bool only_matching;       /**< Whether to print the match spans instead of the lines */
+    bool json;                /**< Whether to print one JSON record per line */
+    size_t num_threads;       /**< Threads including the caller's, 0 for one per CPU */
+    rift_regex_flags_t flags; /**< Compilation flags of the patterns */
+};
+
+/**
+ * @brief Command structure for grep command
+ */
+typedef struct rift_grep_command rift_grep_command_t;
+struct rift_grep_command {
+    rift_command_type_t type;    /**< Command type */
+    bool verbose;                /**< Verbose output flag */
+    bool quiet;                  /**< Quiet mode flag */
+    rift_grep_options_t options; /**< Command-specific options */
+};
+
+/**
+ * @brief Create a new grep command instance
+ *
+ * @return A new grep command or NULL on failure
+ */
+rift_command_t *rift_grep_command_create(void);
+
+/**
+ * @brief Get the options for a grep command
+ *
+ * @param command The grep command
+ * @return Pointer to the grep options or NULL on error
+ */
+rift_grep_options_t *rift_grep_command_get_options(rift_command_t *command);
+
+/**
+ * @brief Parse the arguments of a grep command
+ *
+ * The first argument that is not an option is the pattern unless -e or
+ * --rules gave one; the others are the paths searched.
+ *
+ * @param command The grep command
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @return true if parsing was successful, false otherwise
+ */
+bool rift_grep_command_parse_args(rift_command_t *command, int argc, char *argv[]);
+
+/**
+ * @brief Execute a grep command
+ *
+ * Each file is memory-mapped and scanned in place, except gzip and zstd
+ * files, which are decompressed a chunk at a time on a thread of their own
+ * and scanned one block of whole lines at a time. Files are shared out to
+ * a pool of threads, a reading thread reading small files ahead of them in
+ * bulk (through io_uring on Linux); a single file is instead cut into chunks searched in
+ * parallel. The output of each file is written as a whole, in no
+ * particular order between files.
+ *
+ * @param command The grep command
+ * @return 0 if a match was found, 1 if none was, 2 on error
+ */
+int rift_grep_command_execute(rift_command_t *command);
+
+/**
+ * @brief Get help information for a grep command
+ *
+ * @param command The grep command
+ * @return Help string for the command
+ */
+const char *rift_grep_command_get_help(const rift_command_t *command);
+
+/**
+ * @brief Free a grep command and its options
+ *
+ * @param command The command to free
+ */
+void rift_grep_command_free(rift_command_t *command);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_CLI_COMMANDS_GREP_COMMAND_H */
@@ -0,0 +1,104 @@
+/**
+ * @file lint_command.h
+ * @brief Command implementation for finding redundant rules in a ruleset
+ *
+ * This file defines the interface for the lint command, which compiles a
+ * .rift DSL ruleset and reports the rules that are duplicates of an earlier
+ * rule or whose matches another rule's matches include, so they can be
+ * removed from the file or pruned when it is compiled.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "cli/command/command.h"
+#ifndef LIBRIFT_CLI_COMMANDS_LINT_COMMAND_H
+#define LIBRIFT_CLI_COMMANDS_LINT_COMMAND_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Lint command options structure
+ */
+typedef struct rift_lint_options rift_lint_options_t;
+struct rift_lint_options {
+    char *rules_file; /**< .rift ruleset checked */
+    bool json;        /**< Print the redundant rules as JSON */
+    bool strict;      /**< Fail when a rule is redundant */
+};
+
+/**
+ * @brief Command structure for lint command
+ */
+typedef struct rift_lint_command rift_lint_command_t;
+struct rift_lint_command {
+    rift_command_type_t type;    /**< Command type */
+    bool verbose;                /**< Verbose output flag */
+    bool quiet;                  /**< Quiet mode flag */
+    rift_lint_options_t options; /**< Command-specific options */
+};
+
+/**
+ * @brief Create a new lint command instance
+ *
+ * @return A new lint command or NULL on failure
+ */
+rift_command_t *rift_lint_command_create(void);
+
+/**
+ * @brief Get the options for a lint command
+ *
+ * @param command The lint command
+ * @return Pointer to the lint options or NULL on error
+ */
+rift_lint_options_t *rift_lint_command_get_options(rift_command_t *command);
+
+/**
+ * @brief Parse the arguments of a lint command
+ *
+ * The first argument that is not an option is the ruleset.
+ *
+ * @param command The lint command
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @return true if parsing was successful, false otherwise
+ */
+bool rift_lint_command_parse_args(rift_command_t *command, int argc, char *argv[]);
+
+/**
+ * @brief Execute a lint command
+ *
+ * Rules with anchors, word boundaries, atomic groups, lookarounds or
+ * backreferences, and rules whose DFA is too large for a table, are not
+ * compared and never reported.
+ *
+ * @param command The lint command
+ * @return 0 on success, 1 on failure, 2 with --strict when a rule is redundant
+ */
+int rift_lint_command_execute(rift_command_t *command);
+
+/**
+ * @brief Get help information for a lint command
+ *
+ * @param command The lint command
+ * @return Help string for the command
+ */
+const char *rift_lint_command_get_help(const rift_command_t *command);
+
+/**
+ * @brief Free a lint command and its options
+ *
+ * @param command The command to free
+ */
+void rift_lint_command_free(rift_command_t *command);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_CLI_COMMANDS_LINT_COMMAND_H */
@@ -0,0 +1,216 @@
+/**
+ * @file output_writer.h
+ * @brief Buffered, format-aware output shared by the CLI commands
+ *
+ * A command describes its results as records of named fields, and the
+ * writer encodes them as text, JSON, newline-delimited JSON or CBOR, so
+ * downstream tools read the structured formats without parsing the text
+ * one. Output is gathered in a large buffer and written with few system
+ * calls, which keeps dumps of big inputs from being bound by small writes.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#ifndef LIBRIFT_CLI_COMMANDS_OUTPUT_WRITER_H
+#define LIBRIFT_CLI_COMMANDS_OUTPUT_WRITER_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Bytes gathered before they are written
+ */
+#define RIFT_OUTPUT_WRITER_BUFFER_SIZE ((size_t)1 << 20)
+
+/**
+ * @brief Encodings of the output
+ */
+typedef enum rift_output_format {
+    RIFT_OUTPUT_FORMAT_TEXT = 0, /**< Fields as key=value, one record per line */
+    RIFT_OUTPUT_FORMAT_JSON,     /**< One JSON array of the records */
+    RIFT_OUTPUT_FORMAT_NDJSON,   /**< One JSON object per line */
+    RIFT_OUTPUT_FORMAT_CBOR,     /**< A CBOR sequence of maps (RFC 8742) */
+    RIFT_OUTPUT_FORMAT_BINARY    /**< Records the command lays out, written raw */
+} rift_output_format_t;
+
+/**
+ * @brief Forward declaration of the output writer structure
+ */
+typedef struct rift_output_writer rift_output_writer_t;
+
+/**
+ * @brief Parses the name of a format
+ *
+ * @param name "text", "json", "ndjson", "cbor" or "binary"
+ * @param format Where the format goes
+ * @return bool True if the name is known, false otherwise
+ */
+bool rift_output_format_parse(const char *name, rift_output_format_t *format);
+
+/**
+ * @brief Gets the name of a format
+ *
+ * @param format The format
+ * @return const char* Its name, "unknown" for an invalid format
+ */
+const char *rift_output_format_name(rift_output_format_t format);
+
+/**
+ * @brief Opens a writer on a file
+ *
+ * @param path File written, created or truncated, or NULL or "-" for standard output
+ * @param format Encoding of the output
+ * @return rift_output_writer_t* A new writer or NULL on failure
+ */
+rift_output_writer_t *rift_output_writer_open(const char *path, rift_output_format_t format);
+
+/**
+ * @brief Ends the output, writes what is buffered and frees the writer
+ *
+ * The JSON array is closed here, and a file opened by the writer is closed.
+ *
+ * @param writer The writer (can be NULL)
+ * @return bool True if every write succeeded, false otherwise
+ */
+bool rift_output_writer_close(rift_output_writer_t *writer);
+
+/**
+ * @brief Gets the encoding of a writer
+ *
+ * @param writer The writer
+ * @return rift_output_format_t The format
+ */
+rift_output_format_t rift_output_writer_get_format(const rift_output_writer_t *writer);
+
+/**
+ * @brief Writes what is buffered
+ *
+ * @param writer The writer
+ * @return bool True if every write so far succeeded, false otherwise
+ */
+bool rift_output_writer_flush(rift_output_writer_t *writer);
+
+/**
+ * @brief Writes bytes as they are
+ *
+ * For the text and binary formats, where the command lays out the output.
+ *
+ * @param writer The writer
+ * @param data The bytes
+ * @param length Number of bytes
+ * @return bool True if successful, false otherwise
+ */
+bool rift_output_writer_write(rift_output_writer_t *writer, const void *data, size_t length);
+
+/**
+ * @brief Writes formatted text as it is
+ *
+ * @param writer The writer
+ * @param format printf-style format
+ * @return bool True if successful, false otherwise
+ */
+bool rift_output_writer_printf(rift_output_writer_t *writer, const char *format, ...);
+
+/**
+ * @brief Starts a record, an object at the top level of the output
+ *
+ * @param writer The writer
+ * @return bool True if successful, false otherwise
+ */
+bool rift_output_writer_begin_record(rift_output_writer_t *writer);
+
+/**
+ * @brief Ends the record started last
+ *
+ * @param writer The writer
+ * @return bool True if successful, false otherwise
+ */
+bool rift_output_writer_end_record(rift_output_writer_t *writer);
+
+/**
+ * @brief Starts an object nested in the current record
+ *
+ * @param writer The writer
+ * @param key Name of the object in the enclosing object, NULL in an array
+ * @return bool True if successful, false otherwise
+ */
+bool rift_output_writer_begin_object(rift_output_writer_t *writer, const char *key);
+
+/**
+ * @brief Ends the object started last
+ *
+ * @param writer The writer
+ * @return bool True if successful, false otherwise
+ */
+bool rift_output_writer_end_object(rift_output_writer_t *writer);
+
+/**
+ * @brief Starts an array nested in the current record
+ *
+ * @param writer The writer
+ * @param key Name of the array in the enclosing object, NULL in an array
+ * @return bool True if successful, false otherwise
+ */
+bool rift_output_writer_begin_array(rift_output_writer_t *writer, const char *key);
+
+/**
+ * @brief Ends the array started last
+ *
+ * @param writer The writer
+ * @return bool True if successful, false otherwise
+ */
+bool rift_output_writer_end_array(rift_output_writer_t *writer);
+
+/**
+ * @brief Writes a string field
+ *
+ * @param writer The writer
+ * @param key Name of the field, NULL in an array
+ * @param value The string, which need not be terminated
+ * @param length Bytes of value
+ * @return bool True if successful, false otherwise
+ */
+bool rift_output_writer_field_string(rift_output_writer_t *writer, const char *key,
+                                     const char *value, size_t length);
+
+/**
+ * @brief Writes an unsigned integer field
+ *
+ * @param writer The writer
+ * @param key Name of the field, NULL in an array
+ * @param value The integer
+ * @return bool True if successful, false otherwise
+ */
+bool rift_output_writer_field_uint(rift_output_writer_t *writer, const char *key, uint64_t value);
+
+/**
+ * @brief Writes a signed integer field
+ *
+ * @param writer The writer
+ * @param key Name of the field, NULL in an array
+ * @param value The integer
+ * @return bool True if successful, false otherwise
+ */
+bool rift_output_writer_field_int(rift_output_writer_t *writer, const char *key, int64_t value);
+
+/**
+ * @brief Writes a boolean field
+ *
+ * @param writer The writer
+ * @param key Name of the field, NULL in an array
+ * @param value The boolean
+ * @return bool True if successful, false otherwise
+ */
+bool rift_output_writer_field_bool(rift_output_writer_t *writer, const char *key, bool value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_CLI_COMMANDS_OUTPUT_WRITER_H */
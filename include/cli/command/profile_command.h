@@ -0,0 +1,138 @@
+/**
+ * @file profile_command.h
+ * @brief Command implementation for profiling the cost of patterns
+ *
+ * This file defines the interface for the profile command, which compiles
+ * patterns, or the rules of a .rift DSL ruleset, one stage at a time and
+ * searches a corpus with each of them, then ranks them by what they cost:
+ * the time of each compilation stage, and the time, steps, backtracks and
+ * engine of the search, and with --counters the hardware counts of it.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "cli/command/command.h"
+#include "core/automaton/flags.h"
+#ifndef LIBRIFT_CLI_COMMANDS_PROFILE_COMMAND_H
+#define LIBRIFT_CLI_COMMANDS_PROFILE_COMMAND_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Output formats of the profile command
+ */
+typedef enum rift_profile_format {
+    RIFT_PROFILE_FORMAT_TEXT,  /**< Ranked tables */
+    RIFT_PROFILE_FORMAT_JSON,  /**< One JSON document */
+    RIFT_PROFILE_FORMAT_FOLDED /**< Folded stacks for flame graph tools, in nanoseconds */
+} rift_profile_format_t;
+
+/**
+ * @brief What the patterns are ranked by
+ */
+typedef enum rift_profile_sort {
+    RIFT_PROFILE_SORT_TOTAL,   /**< Compile time plus search time */
+    RIFT_PROFILE_SORT_COMPILE, /**< Compile time of all the stages */
+    RIFT_PROFILE_SORT_MATCH    /**< Search time of the corpus */
+} rift_profile_sort_t;
+
+/**
+ * @brief Repetitions of each measurement when none are given
+ */
+#define RIFT_PROFILE_DEFAULT_REPEATS 5
+
+/**
+ * @brief Profile command options structure
+ */
+typedef struct rift_profile_options rift_profile_options_t;
+struct rift_profile_options {
+    char **patterns;              /**< Regex patterns profiled */
+    size_t num_patterns;          /**< Number of patterns */
+    char *rules_file;             /**< .rift ruleset whose rules are profiled instead */
+    char *input_file;             /**< Corpus searched, or NULL to profile compilation only */
+    size_t repeats;               /**< Measured compilations and searches */
+    size_t top;                   /**< Patterns reported, 0 for all of them */
+    rift_profile_sort_t sort;     /**< What the patterns are ranked by */
+    rift_profile_format_t format; /**< Output format */
+    rift_regex_flags_t flags;     /**< Compilation flags of the patterns */
+    bool counters;                /**< Read the hardware counters over a search */
+};
+
+/**
+ * @brief Command structure for profile command
+ */
+typedef struct rift_profile_command rift_profile_command_t;
+struct rift_profile_command {
+    rift_command_type_t type;       /**< Command type */
+    bool verbose;                   /**< Verbose output flag */
+    bool quiet;                     /**< Quiet mode flag */
+    rift_profile_options_t options; /**< Command-specific options */
+};
+
+/**
+ * @brief Create a new profile command instance
+ *
+ * @return A new profile command or NULL on failure
+ */
+rift_command_t *rift_profile_command_create(void);
+
+/**
+ * @brief Get the options for a profile command
+ *
+ * @param command The profile command
+ * @return Pointer to the profile options or NULL on error
+ */
+rift_profile_options_t *rift_profile_command_get_options(rift_command_t *command);
+
+/**
+ * @brief Parse the arguments of a profile command
+ *
+ * The first argument that is not an option is the pattern unless -e or
+ * --rules gave one; the next is the corpus.
+ *
+ * @param command The profile command
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @return true if parsing was successful, false otherwise
+ */
+bool rift_profile_command_parse_args(rift_command_t *command, int argc, char *argv[]);
+
+/**
+ * @brief Execute a profile command
+ *
+ * Each stage is timed on its own, so their sum exceeds what a single
+ * rift_regex_compile() call takes. A stage that cannot run on a pattern,
+ * such as the DFA of a pattern with backreferences, is reported as
+ * skipped rather than failing the command.
+ *
+ * @param command The profile command
+ * @return 0 on success, non-zero on failure
+ */
+int rift_profile_command_execute(rift_command_t *command);
+
+/**
+ * @brief Get help information for a profile command
+ *
+ * @param command The profile command
+ * @return Help string for the command
+ */
+const char *rift_profile_command_get_help(const rift_command_t *command);
+
+/**
+ * @brief Free a profile command and its options
+ *
+ * @param command The command to free
+ */
+void rift_profile_command_free(rift_command_t *command);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_CLI_COMMANDS_PROFILE_COMMAND_H */
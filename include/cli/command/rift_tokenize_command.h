@@ -9,6 +9,7 @@
  * @license MIT License
  */
 
+#include <stdint.h>
 #include "librift/cli/command.h"
 #ifndef LIBRIFT_CLI_TOKENIZE_COMMAND_H
 #define LIBRIFT_CLI_TOKENIZE_COMMAND_H
@@ -26,12 +27,29 @@ typedef struct {
     char *output_file;        /**< Output file path for tokenization results */
     char *rules_file;         /**< Custom tokenization rules file path */
     char *ignore_pattern;     /**< Pattern to ignore during tokenization */
-    char *format;             /**< Output format (json, text) */
+    char *format;             /**< Output format (json, text, ndjson, cbor, binary) */
     bool case_sensitive;      /**< Whether tokenization is case sensitive */
     bool debug;               /**< Whether to include debug information */
     rift_regex_flags_t flags; /**< Tokenization flags */
 } rift_tokenize_options_t;
 
+/**
+ * @brief Magic bytes opening the binary token stream
+ */
+#define RIFT_TOKENIZE_STREAM_MAGIC "RIFTTOK1"
+
+/**
+ * @brief Record of one token in the binary token stream
+ *
+ * Records follow the magic bytes back to back, in native byte order.
+ */
+typedef struct {
+    uint64_t start; /**< Offset of the first byte of the token in the input */
+    uint64_t end;   /**< Offset one past the last byte of the token */
+    uint32_t type;  /**< Token type, a rift_regex_token_type_t */
+    uint32_t flags; /**< Reserved, always 0 */
+} rift_tokenize_record_t;
+
 /**
  * @brief Tokenize command implementation structure
  */
@@ -77,6 +95,22 @@ bool rift_tokenize_command_set_options(rift_command_t *command,
  */
 int rift_tokenize_file(const rift_tokenize_options_t *options, bool verbose, bool quiet);
 
+/**
+ * @brief Tokenize a file as a stream of token spans
+ *
+ * The input is memory-mapped and tokenized in place, and each token is
+ * written through the shared output writer as an NDJSON line, a CBOR map
+ * or a binary record holding its type and span, never its text. Pages already tokenized are
+ * released as the scan moves on, so memory stays constant whatever the
+ * size of the input.
+ *
+ * @param options The tokenization options; the format is ndjson, cbor or binary
+ * @param verbose Whether to show verbose output
+ * @param quiet Whether to suppress all output
+ * @return int 0 on success, non-zero on failure
+ */
+int rift_tokenize_stream(const rift_tokenize_options_t *options, bool verbose, bool quiet);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,141 @@
+/**
+ * @file serve_command.h
+ * @brief Command implementation for serving a ruleset to match requests
+ *
+ * This file defines the interface for the serve command, which compiles a
+ * .rift DSL ruleset once and answers match requests from any number of
+ * clients over a Unix socket or TCP, so that small client processes share
+ * one warm compilation instead of each paying to compile it.
+ *
+ * Every message on a connection is a frame: a 32-bit big-endian length,
+ * then that many bytes, the first of which is the message type. A client
+ * sends a RIFT_SERVE_REQUEST_MATCH frame whose payload is the input, or a
+ * RIFT_SERVE_REQUEST_METRICS frame with no payload, and waits for the
+ * reply frame, whose first byte is a status. The payload of a successful
+ * match reply is the number of matching rules and their indices in the
+ * ruleset, as 32-bit big-endian integers in index order; that of a metrics
+ * reply is the metrics in the Prometheus text format; that of an error
+ * reply is a message.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "cli/command/command.h"
+#ifndef LIBRIFT_CLI_COMMANDS_SERVE_COMMAND_H
+#define LIBRIFT_CLI_COMMANDS_SERVE_COMMAND_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Message type of a match request, whose payload is the input
+ */
+#define RIFT_SERVE_REQUEST_MATCH 0x01
+
+/**
+ * @brief Message type of a metrics request, which has no payload
+ */
+#define RIFT_SERVE_REQUEST_METRICS 0x02
+
+/**
+ * @brief Status of a successful reply
+ */
+#define RIFT_SERVE_STATUS_OK 0x00
+
+/**
+ * @brief Status of a failed request, whose reply payload is a message
+ */
+#define RIFT_SERVE_STATUS_ERROR 0x01
+
+/**
+ * @brief Serve command options structure
+ */
+typedef struct rift_serve_options rift_serve_options_t;
+struct rift_serve_options {
+    char *rules_file;   /**< .rift ruleset or bytecode container served */
+    char *socket_path;  /**< Unix socket listened on */
+    char *listen;       /**< TCP address listened on, as host:port */
+    size_t window_us;   /**< Longest a request waits for others to share its batch */
+    size_t max_batch;   /**< Most requests matched in one batch */
+    size_t max_request; /**< Largest input accepted, in bytes */
+    size_t num_threads; /**< Threads matching batches, 0 for one per CPU */
+    bool watch;         /**< Reload the ruleset when its file changes */
+};
+
+/**
+ * @brief Command structure for serve command
+ */
+typedef struct rift_serve_command rift_serve_command_t;
+struct rift_serve_command {
+    rift_command_type_t type;     /**< Command type */
+    bool verbose;                 /**< Verbose output flag */
+    bool quiet;                   /**< Quiet mode flag */
+    rift_serve_options_t options; /**< Command-specific options */
+};
+
+/**
+ * @brief Create a new serve command instance
+ *
+ * @return A new serve command or NULL on failure
+ */
+rift_command_t *rift_serve_command_create(void);
+
+/**
+ * @brief Get the options for a serve command
+ *
+ * @param command The serve command
+ * @return Pointer to the serve options or NULL on error
+ */
+rift_serve_options_t *rift_serve_command_get_options(rift_command_t *command);
+
+/**
+ * @brief Parse the arguments of a serve command
+ *
+ * The first argument that is not an option is the ruleset. Exactly one of
+ * --socket and --listen must be given.
+ *
+ * @param command The serve command
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @return true if parsing was successful, false otherwise
+ */
+bool rift_serve_command_parse_args(rift_command_t *command, int argc, char *argv[]);
+
+/**
+ * @brief Execute a serve command
+ *
+ * Serves until SIGINT or SIGTERM. SIGHUP, and with watching a change of
+ * the ruleset's modification time, recompiles the ruleset and swaps it in
+ * without dropping a request; a ruleset that fails to compile is reported
+ * and the one in use is kept.
+ *
+ * @param command The serve command
+ * @return 0 on a clean shutdown, 1 on failure
+ */
+int rift_serve_command_execute(rift_command_t *command);
+
+/**
+ * @brief Get help information for a serve command
+ *
+ * @param command The serve command
+ * @return Help string for the command
+ */
+const char *rift_serve_command_get_help(const rift_command_t *command);
+
+/**
+ * @brief Free a serve command and its options
+ *
+ * @param command The command to free
+ */
+void rift_serve_command_free(rift_command_t *command);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_CLI_COMMANDS_SERVE_COMMAND_H */
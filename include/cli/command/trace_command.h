@@ -0,0 +1,124 @@
+/**
+ * @file trace_command.h
+ * @brief Command implementation for tracing the search of a pattern
+ *
+ * This file defines the interface for the trace command, which searches an
+ * input with the backtracking matcher while it records into a trace
+ * buffer, ranks the states by the backtracking they saw, and can draw the
+ * trace over the automaton as a heat map or as an animation.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "cli/command/command.h"
+#include "core/automaton/flags.h"
+#ifndef LIBRIFT_CLI_COMMANDS_TRACE_COMMAND_H
+#define LIBRIFT_CLI_COMMANDS_TRACE_COMMAND_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Hotspots reported when no number is given
+ */
+#define RIFT_TRACE_DEFAULT_TOP 10
+
+/**
+ * @brief Most frames of an animation when no number is given
+ */
+#define RIFT_TRACE_DEFAULT_FRAMES 200
+
+/**
+ * @brief Trace command options structure
+ */
+typedef struct rift_trace_options rift_trace_options_t;
+struct rift_trace_options {
+    char *pattern;            /**< Regex pattern traced */
+    char *input_file;         /**< Input searched */
+    char *text;               /**< Input given on the command line instead */
+    size_t buffer_records;    /**< Records the trace keeps, 0 for the default */
+    size_t top;               /**< Hotspots reported, 0 for all of them */
+    size_t frames;            /**< Most frames of the animation */
+    bool backtracks_only;     /**< Whether only backtracks are recorded */
+    char *svg_file;           /**< Heat map written here, or NULL */
+    char *html_file;          /**< Animation written here, or NULL */
+    rift_regex_flags_t flags; /**< Compilation flags of the pattern */
+};
+
+/**
+ * @brief Command structure for trace command
+ */
+typedef struct rift_trace_command rift_trace_command_t;
+struct rift_trace_command {
+    rift_command_type_t type;     /**< Command type */
+    bool verbose;                 /**< Verbose output flag */
+    bool quiet;                   /**< Quiet mode flag */
+    rift_trace_options_t options; /**< Command-specific options */
+};
+
+/**
+ * @brief Create a new trace command instance
+ *
+ * @return A new trace command or NULL on failure
+ */
+rift_command_t *rift_trace_command_create(void);
+
+/**
+ * @brief Get the options for a trace command
+ *
+ * @param command The trace command
+ * @return Pointer to the trace options or NULL on error
+ */
+rift_trace_options_t *rift_trace_command_get_options(rift_command_t *command);
+
+/**
+ * @brief Parse the arguments of a trace command
+ *
+ * The first argument that is not an option is the pattern, the next the
+ * input file unless --text gave the input.
+ *
+ * @param command The trace command
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @return true if parsing was successful, false otherwise
+ */
+bool rift_trace_command_parse_args(rift_command_t *command, int argc, char *argv[]);
+
+/**
+ * @brief Execute a trace command
+ *
+ * The search runs on the backtracking matcher whatever engine the pattern
+ * would get, since the others have no states to trace. When the input
+ * takes more records than the buffer keeps, the report covers the end of
+ * the search.
+ *
+ * @param command The trace command
+ * @return 0 on success, non-zero on failure
+ */
+int rift_trace_command_execute(rift_command_t *command);
+
+/**
+ * @brief Get help information for a trace command
+ *
+ * @param command The trace command
+ * @return Help string for the command
+ */
+const char *rift_trace_command_get_help(const rift_command_t *command);
+
+/**
+ * @brief Free a trace command and its options
+ *
+ * @param command The command to free
+ */
+void rift_trace_command_free(rift_command_t *command);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_CLI_COMMANDS_TRACE_COMMAND_H */
@@ -21,18 +21,43 @@ extern "C" {
  */
 typedef struct rift_automaton_observer rift_automaton_observer_t;
 
+/**
+ * @brief Kinds of change to one element of an automaton
+ */
+typedef enum rift_automaton_change_type {
+    RIFT_AUTOMATON_CHANGE_STATE_ADDED,        /**< A state was added */
+    RIFT_AUTOMATON_CHANGE_STATE_REMOVED,      /**< A state is about to be freed */
+    RIFT_AUTOMATON_CHANGE_STATE_MODIFIED,     /**< A state was modified */
+    RIFT_AUTOMATON_CHANGE_TRANSITION_ADDED,   /**< A transition was added */
+    RIFT_AUTOMATON_CHANGE_TRANSITION_REMOVED, /**< A transition is about to be freed */
+    RIFT_AUTOMATON_CHANGE_TRANSITION_MODIFIED /**< A transition was modified */
+} rift_automaton_change_type_t;
+
 /**
  * @brief Callback function type for automaton updates
  */
 typedef void (*rift_automaton_update_callback_t)(rift_automaton_observer_t *observer,
                                                  void *automaton);
 
+/**
+ * @brief Callback function type for changes to one state or transition
+ */
+typedef void (*rift_automaton_change_callback_t)(rift_automaton_observer_t *observer,
+                                                 void *automaton,
+                                                 rift_automaton_change_type_t type,
+                                                 void *element);
+
 /**
  * @brief Automaton observer interface structure
+ *
+ * Observers embedded in other structures start zeroed, outside any batch.
  */
 struct rift_automaton_observer {
-    rift_automaton_update_callback_t update; /**< Update callback function */
-    void *user_data;                         /**< User data for the observer */
+    rift_automaton_update_callback_t update;  /**< Update callback function */
+    rift_automaton_change_callback_t changed; /**< Per-element callback, or NULL for update */
+    void *user_data;                          /**< User data for the observer */
+    unsigned int batch_depth;                 /**< Batches open, notifications held while > 0 */
+    void *batch_automaton;                    /**< Automaton changed in the batch, or NULL */
 };
 
 /**
@@ -52,14 +77,57 @@ rift_automaton_observer_create(rift_automaton_update_callback_t update_callback,
  */
 void rift_automaton_observer_destroy(rift_automaton_observer_t *observer);
 
+/**
+ * @brief Starts holding back the notifications of an observer
+ *
+ * Passes that rewrite an automaton wholesale, such as subset construction,
+ * minimization or transition optimization, change it thousands of times;
+ * an observer redrawing or describing it after each change makes them
+ * orders of magnitude slower. Between this call and the matching
+ * rift_automaton_observer_end_batch() the observer only records which
+ * automaton changed. Batches nest; only the outermost one delivers.
+ *
+ * @param observer The observer (can be NULL)
+ */
+void rift_automaton_observer_begin_batch(rift_automaton_observer_t *observer);
+
+/**
+ * @brief Ends a batch and delivers the changes it held back as one update
+ *
+ * When the outermost batch ends, an observer notified of any change during
+ * the batch gets a single whole-automaton update for it.
+ *
+ * @param observer The observer (can be NULL)
+ */
+void rift_automaton_observer_end_batch(rift_automaton_observer_t *observer);
+
 /**
  * @brief Notifies an observer of an automaton update
  *
+ * Inside a batch the update is held back, see
+ * rift_automaton_observer_begin_batch().
+ *
  * @param observer The observer to notify
  * @param automaton The updated automaton
  */
 void rift_automaton_observer_notify(rift_automaton_observer_t *observer, void *automaton);
 
+/**
+ * @brief Notifies an observer of a change to one state or transition
+ *
+ * Removals must be notified before the element is freed; the pointer is
+ * only used as a key afterwards. Observers without a change callback get
+ * a whole-automaton update instead, as do observers in a batch once it
+ * ends.
+ *
+ * @param observer The observer to notify
+ * @param automaton The automaton the element belongs to
+ * @param type What changed
+ * @param element The state or transition that changed
+ */
+void rift_automaton_observer_notify_change(rift_automaton_observer_t *observer, void *automaton,
+                                           rift_automaton_change_type_t type, void *element);
+
 #ifdef __cplusplus
 }
 #endif
@@ -5,6 +5,11 @@
  * This header defines the real-time update management functionality
  * for efficient processing of SVG updates in response to automaton changes.
  *
+ * Updates scheduled for the same element are merged while they wait, and
+ * waiting updates are applied at most once per throttling interval, so a
+ * burst of changes to an automaton costs one pass over the changed
+ * elements per frame.
+ *
  * @copyright Copyright (c) 2025 LibRift Project
  * @license MIT License
  */
@@ -68,6 +73,12 @@ void rift_real_time_update_manager_destroy(rift_real_time_update_manager_t *mana
 /**
  * @brief Schedules an update for processing
  *
+ * An update of an element that already has one waiting is merged into it,
+ * keeping the higher priority. A removal is applied at once, since the
+ * element may be freed right after, and cancels the update waiting for it.
+ * A layout change resynchronizes the whole automaton, its element being the
+ * automaton or NULL for the one already mapped.
+ *
  * @param manager The manager to use
  * @param update The update to schedule
  * @return bool True if scheduled successfully, false otherwise
@@ -78,11 +89,29 @@ bool rift_real_time_update_manager_schedule_update(rift_real_time_update_manager
 /**
  * @brief Processes all pending updates
  *
+ * Does nothing until the throttling interval has passed since updates were
+ * last processed. States are applied before transitions and, within each,
+ * higher priorities first. When many elements wait, the automaton is
+ * resynchronized in one pass instead.
+ *
  * @param manager The manager to use
  * @return int The number of updates processed
  */
 int rift_real_time_update_manager_process_updates(rift_real_time_update_manager_t *manager);
 
+/**
+ * @brief Processes all pending updates regardless of the throttling interval
+ *
+ * @param manager The manager to use
+ * @return int The number of updates processed
+ */
+int rift_real_time_update_manager_flush(rift_real_time_update_manager_t *manager);
+
+/**
+ * @brief Default throttling interval, one frame at 60 frames per second
+ */
+#define RIFT_UPDATE_DEFAULT_THROTTLE_MS 16
+
 /**
  * @brief Sets the throttling interval for updates
  *
@@ -96,6 +125,8 @@ bool rift_real_time_update_manager_throttle_updates(rift_real_time_update_manage
 /**
  * @brief Gets the current timestamp in milliseconds
  *
+ * The timestamp is taken from a monotonic clock.
+ *
  * @return uint64_t The current timestamp
  */
 uint64_t rift_real_time_update_manager_get_timestamp(void);
@@ -5,10 +5,16 @@
  * This header defines the mapping functionality between automaton states/transitions
  * and their corresponding SVG element representations.
  *
+ * Each state is a group placed with a transform and each transition a group
+ * holding its path and label. Positions stick once assigned, so updating one
+ * state or transition changes its own group and leaves the rest of the
+ * document clean for rift_svg_element_to_string() to copy.
+ *
  * @copyright Copyright (c) 2025 LibRift Project
  * @license MIT License
  */
 
+#include <stdint.h>
 #include "svg_element.h"
 #ifndef LIBRIFT_SVG_AUTOMATON_MAPPER_H
 #define LIBRIFT_SVG_AUTOMATON_MAPPER_H
@@ -18,6 +24,14 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Layout algorithms of rift_svg_automaton_mapper_apply_layout()
+ */
+typedef enum rift_svg_layout {
+    RIFT_SVG_LAYOUT_DEFAULT = 0, /**< Columns by breadth-first distance from the initial state */
+    RIFT_SVG_LAYOUT_LAYERED = 1  /**< Layers by longest path with crossing reduction */
+} rift_svg_layout_t;
+
 /**
  * @brief Forward declaration of the SVG automaton mapper structure
  */
@@ -51,6 +65,10 @@ rift_svg_automaton_mapper_map_automaton_to_svg(rift_svg_automaton_mapper_t *mapp
 /**
  * @brief Updates existing SVG elements from an automaton
  *
+ * Maps the states and transitions that have no element yet, refreshes the
+ * others and removes the elements of those no longer in the automaton.
+ * Positions already assigned are kept; see rift_svg_automaton_mapper_apply_layout().
+ *
  * @param mapper The mapper to use
  * @param automaton The updated automaton
  * @return bool True if successful, false otherwise
@@ -110,6 +128,12 @@ void *rift_svg_automaton_mapper_get_transition_from_element(rift_svg_automaton_m
 /**
  * @brief Applies a custom layout algorithm to the automaton visualization
  *
+ * The algorithm also lays out automata mapped later. Applying the layout
+ * in use again keeps the positions unless states or transitions were
+ * added or removed since. The layered layout runs in O(E + V log V) and
+ * draws each strongly connected component at or above the collapse
+ * threshold as a single cluster.
+ *
  * @param mapper The mapper to use
  * @param layout_algorithm The layout algorithm identifier (0 = default)
  * @return bool True if successful, false otherwise
@@ -117,6 +141,130 @@ void *rift_svg_automaton_mapper_get_transition_from_element(rift_svg_automaton_m
 bool rift_svg_automaton_mapper_apply_layout(rift_svg_automaton_mapper_t *mapper,
                                             int layout_algorithm);
 
+/**
+ * @brief Sets the size from which strongly connected components are collapsed
+ *
+ * Applies from the next layered layout. The states and transitions of a
+ * collapsed component stay mapped but are not displayed, and transitions
+ * entering or leaving it are drawn to its cluster.
+ *
+ * @param mapper The mapper to modify
+ * @param min_states Smallest component collapsed, or 0 to collapse none
+ * @return bool True if successful, false otherwise
+ */
+bool rift_svg_automaton_mapper_set_collapse_threshold(rift_svg_automaton_mapper_t *mapper,
+                                                      size_t min_states);
+
+/**
+ * @brief Gets the root SVG element of the mapper
+ *
+ * The root exists before any automaton is mapped and is owned by the mapper.
+ *
+ * @param mapper The mapper to query
+ * @return rift_svg_element_t* The root SVG element or NULL on error
+ */
+rift_svg_element_t *rift_svg_automaton_mapper_get_root_element(rift_svg_automaton_mapper_t *mapper);
+
+/**
+ * @brief Gets the automaton the mapper last mapped
+ *
+ * @param mapper The mapper to query
+ * @return void* The automaton or NULL if none is mapped
+ */
+void *rift_svg_automaton_mapper_get_automaton(rift_svg_automaton_mapper_t *mapper);
+
+/**
+ * @brief Maps a state, or refreshes the element of an already mapped state
+ *
+ * @param mapper The mapper to use
+ * @param state The automaton state
+ * @return bool True if successful, false otherwise
+ */
+bool rift_svg_automaton_mapper_update_state(rift_svg_automaton_mapper_t *mapper, void *state);
+
+/**
+ * @brief Maps a transition, or refreshes the element of an already mapped one
+ *
+ * The states at both ends are mapped first if they are not yet.
+ *
+ * @param mapper The mapper to use
+ * @param transition The automaton transition
+ * @return bool True if successful, false otherwise
+ */
+bool rift_svg_automaton_mapper_update_transition(rift_svg_automaton_mapper_t *mapper,
+                                                 void *transition);
+
+/**
+ * @brief Removes the element of a state and of the transitions touching it
+ *
+ * The state is only used as a key, so it may already be freed.
+ *
+ * @param mapper The mapper to use
+ * @param state The automaton state
+ * @return bool True if the state was mapped, false otherwise
+ */
+bool rift_svg_automaton_mapper_remove_state(rift_svg_automaton_mapper_t *mapper, void *state);
+
+/**
+ * @brief Removes the element of a transition
+ *
+ * The transition is only used as a key, so it may already be freed.
+ *
+ * @param mapper The mapper to use
+ * @param transition The automaton transition
+ * @return bool True if the transition was mapped, false otherwise
+ */
+bool rift_svg_automaton_mapper_remove_transition(rift_svg_automaton_mapper_t *mapper,
+                                                 void *transition);
+
+/**
+ * @brief Marks a state with what a match trace did there
+ *
+ * The counts add up over calls. A marked state's group carries them in
+ * data-visits and data-backtracks attributes, with a data-heat from 0 to 8
+ * growing with the logarithm of the backtracks, and has the "active" class
+ * while active. The group changes when the state is next updated, so the
+ * marks made between two frames cost one refresh of each state.
+ *
+ * @param mapper The mapper to use
+ * @param state The automaton state
+ * @param visits Trace records to add to the state's
+ * @param backtracks Backtracks to add to the state's
+ * @param active Whether the trace is at the state now
+ * @return bool True if the state is mapped, false otherwise
+ */
+bool rift_svg_automaton_mapper_mark_state(rift_svg_automaton_mapper_t *mapper, void *state,
+                                          uint32_t visits, uint32_t backtracks, bool active);
+
+/**
+ * @brief Clears the trace marks of every state
+ *
+ * The groups of marked states are refreshed at once and keep their trace
+ * attributes, reset to zero.
+ *
+ * @param mapper The mapper to use
+ * @return bool True if successful, false otherwise
+ */
+bool rift_svg_automaton_mapper_clear_marks(rift_svg_automaton_mapper_t *mapper);
+
+/**
+ * @brief Gets the number of states and transitions mapped
+ *
+ * @param mapper The mapper to query
+ * @return size_t The number of mapped elements
+ */
+size_t rift_svg_automaton_mapper_get_element_count(rift_svg_automaton_mapper_t *mapper);
+
+/**
+ * @brief Takes the IDs of the elements removed since the last call
+ *
+ * @param mapper The mapper to use
+ * @param count Receives the number of IDs
+ * @return char** The IDs (caller must free each and the array) or NULL if none
+ */
+char **rift_svg_automaton_mapper_take_removed_ids(rift_svg_automaton_mapper_t *mapper,
+                                                  size_t *count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -5,6 +5,11 @@
  * This header defines the SVG element structure and associated functions
  * for building and manipulating SVG document elements.
  *
+ * Each element keeps the markup it was last serialized to. Changing an
+ * element drops the markup of the element and its ancestors only, so
+ * serializing a large document again after a small change re-formats the
+ * changed subtrees and copies the rest.
+ *
  * @copyright Copyright (c) 2025 LibRift Project
  * @license MIT License
  */
@@ -110,9 +115,43 @@ rift_svg_element_t *rift_svg_element_get_child(const rift_svg_element_t *element
  */
 size_t rift_svg_element_get_child_count(const rift_svg_element_t *element);
 
+/**
+ * @brief Sets the text content of an SVG element
+ *
+ * The text is written before the children, escaped.
+ *
+ * @param element The element to modify
+ * @param text The text, or NULL for none
+ * @return bool True if successful, false otherwise
+ */
+bool rift_svg_element_set_text(rift_svg_element_t *element, const char *text);
+
+/**
+ * @brief Gets the parent of an SVG element
+ *
+ * @param element The element to query
+ * @return rift_svg_element_t* The parent or NULL for a root element
+ */
+rift_svg_element_t *rift_svg_element_get_parent(const rift_svg_element_t *element);
+
+/**
+ * @brief Checks whether an SVG element changed since it was last serialized
+ *
+ * An element is dirty when it, or one of its descendants, was changed,
+ * or when it was never serialized. Setting an attribute or text to the
+ * value it already has does not make an element dirty.
+ *
+ * @param element The element to query
+ * @return bool True if the element must be formatted again, false otherwise
+ */
+bool rift_svg_element_is_dirty(const rift_svg_element_t *element);
+
 /**
  * @brief Converts an SVG element to a string representation
  *
+ * Subtrees that did not change since they were last serialized are
+ * copied from their kept markup; the others are formatted and kept.
+ *
  * @param element The element to convert
  * @return char* The SVG string (caller must free) or NULL on failure
  */
@@ -130,6 +169,8 @@ bool rift_svg_element_set_accessible_label(rift_svg_element_t *element, const ch
 /**
  * @brief Removes a child element from a parent
  *
+ * The child is detached, not destroyed.
+ *
  * @param parent The parent element
  * @param child The child element to remove
  * @return bool True if successful, false otherwise
@@ -5,6 +5,11 @@
  * This header defines the SVG renderer interface for visualizing
  * regex automata with accessibility integrations.
  *
+ * The renderer keeps the document of the automaton between renders. Its
+ * observer turns change notifications into updates of the affected
+ * elements only, and rift_svg_renderer_render_changes() emits just the
+ * elements changed since the last render.
+ *
  * @copyright Copyright (c) 2025 LibRift Project
  * @license MIT License
  */
@@ -19,6 +24,7 @@
 #include "real_time_update_manager.h"
 #include "svg_automaton_mapper.h"
 #include "svg_element.h"
+#include "core/runtime/trace_buffer.h"
 #ifndef LIBRIFT_SVG_RENDERER_H
 #define LIBRIFT_SVG_RENDERER_H
 
@@ -60,6 +66,9 @@ bool rift_svg_renderer_initialize(rift_svg_renderer_t *renderer, int width, int
 /**
  * @brief Renders an automaton to SVG string
  *
+ * The first render of an automaton maps it; later renders apply the
+ * updates still waiting and format only the elements that changed.
+ *
  * @param renderer The renderer to use
  * @param automaton The automaton to render
  * @return char* The rendered SVG as a string (caller must free) or NULL on failure
@@ -110,6 +119,54 @@ rift_svg_element_t *rift_svg_renderer_get_root_element(rift_svg_renderer_t *rend
  */
 void rift_svg_renderer_update(rift_automaton_observer_t *observer, void *automaton);
 
+/**
+ * @brief Gets the observer to notify of changes to the rendered automaton
+ *
+ * The observer belongs to the renderer and must not be destroyed.
+ *
+ * @param renderer The renderer to query
+ * @return rift_automaton_observer_t* The observer or NULL on error
+ */
+rift_automaton_observer_t *rift_svg_renderer_get_observer(rift_svg_renderer_t *renderer);
+
+/**
+ * @brief Renders the elements changed since the last render
+ *
+ * Applies the updates still waiting, then returns an empty group with a
+ * data-removed attribute for each element removed, followed by the markup
+ * of every state and transition group that changed, in document order. A
+ * client replaces the elements with the same IDs.
+ *
+ * @param renderer The renderer to use
+ * @return char* The changed elements (caller must free), empty if none, or NULL on failure
+ */
+char *rift_svg_renderer_render_changes(rift_svg_renderer_t *renderer);
+
+/**
+ * @brief Plays match trace records over the rendered automaton
+ *
+ * Each record counts as a visit of the state it names, and a backtrack
+ * record as a backtrack there too; the state of the last record is drawn
+ * active. Records naming no state of the automaton are skipped. The states
+ * touched wait in the update manager, one update each however many records
+ * touched them, until rift_svg_renderer_render_changes() emits them as the
+ * next frame of the animation.
+ *
+ * @param renderer The renderer, after an automaton was rendered
+ * @param records The records, oldest first
+ * @param count Number of records
+ * @return size_t The number of records played
+ */
+size_t rift_svg_renderer_play_trace(rift_svg_renderer_t *renderer,
+                                    const rift_trace_record_t *records, size_t count);
+
+/**
+ * @brief Clears what the trace records played so far marked
+ *
+ * @param renderer The renderer
+ */
+void rift_svg_renderer_clear_trace(rift_svg_renderer_t *renderer);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,173 @@
+/**
+ * @file aho_corasick.h
+ * @brief Aho-Corasick literal matching for the LibRift regex engine
+ *
+ * This file defines an Aho-Corasick automaton over a set of literal strings,
+ * each tagged with the identifier of the pattern it belongs to. The trie and
+ * its failure links are compiled into a dense DFA over byte classes, so a
+ * scan costs one table lookup per byte however many literals there are, and
+ * a scan sitting at the root jumps to the next byte that can start a
+ * literal, 16 bytes per step, when only a few can.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_AUTOMATON_AHO_CORASICK_H
+#define LIBRIFT_REGEX_AUTOMATON_AHO_CORASICK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/automaton/automaton.h"
+#include "core/errors/regex_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Longest literal an automaton may contribute
+ */
+#define RIFT_AHO_CORASICK_MAX_LITERAL_LENGTH 256
+
+/**
+ * @brief Most states visited while expanding one automaton into literals
+ */
+#define RIFT_AHO_CORASICK_MAX_EXPANSION 65536
+
+/**
+ * @brief Most bytes an edge may accept for its automaton to expand into literals
+ */
+#define RIFT_AHO_CORASICK_MAX_EDGE_BYTES 4
+
+/**
+ * @brief Most bytes that can start a literal for scans to skip ahead to them
+ */
+#define RIFT_AHO_CORASICK_MAX_START_BYTES 3
+
+/**
+ * @brief Entry meaning no state or no output
+ */
+#define RIFT_AHO_CORASICK_NONE UINT32_MAX
+
+/**
+ * @brief Aho-Corasick automaton over tagged literals
+ *
+ * Literals are added first and compiled by rift_aho_corasick_build(). State 0
+ * is the root, and the transition of state i on byte b is
+ * transitions[i * num_classes + classes[b]], failure links already followed.
+ * The tags a state reports are those of its own outputs and, through
+ * dict_links, of the outputs of its suffixes. When fewer bytes than
+ * RIFT_AHO_CORASICK_MAX_START_BYTES leave the root, start_bytes repeats the
+ * first of them in its unused slots.
+ */
+typedef struct rift_aho_corasick {
+    char *pool;                     /**< Bytes of every literal, back to back */
+    size_t pool_size;               /**< Bytes of pool in use */
+    size_t pool_capacity;           /**< Bytes allocated for pool */
+    size_t *literal_offsets;        /**< Start of each literal in pool */
+    size_t *literal_lengths;        /**< Length of each literal */
+    uint32_t *literal_tags;         /**< Pattern identifier of each literal */
+    size_t num_literals;            /**< Number of literals */
+    size_t literal_capacity;        /**< Literals allocated for */
+    uint32_t tag_limit;             /**< One more than the largest tag */
+    uint8_t classes[256];           /**< Byte class of each byte, 0 for bytes in no literal */
+    uint32_t num_classes;           /**< Number of byte classes */
+    uint32_t num_states;            /**< Number of states of the built automaton */
+    uint32_t *transitions;          /**< Next state per state and byte class */
+    uint32_t *first_outputs;        /**< First output of each state, or none */
+    uint32_t *output_tags;          /**< Tag of each output */
+    uint32_t *output_next;          /**< Next output of the same state, or none */
+    uint32_t *dict_links;           /**< Nearest proper suffix state with outputs, or none */
+    uint32_t *seen;                 /**< Scan that last reported each state */
+    uint32_t generation;            /**< Number of the current scan */
+    uint8_t start_bytes[RIFT_AHO_CORASICK_MAX_START_BYTES]; /**< Bytes leaving the root, padded */
+    uint32_t num_start_bytes;       /**< Bytes that leave the root, 256 when too many */
+    bool built;                     /**< Whether the automaton holds every literal added */
+} rift_aho_corasick_t;
+
+/**
+ * @brief Create an empty Aho-Corasick automaton
+ *
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new automaton or NULL on failure
+ */
+rift_aho_corasick_t *rift_aho_corasick_create(rift_regex_error_t *error);
+
+/**
+ * @brief Free an Aho-Corasick automaton
+ *
+ * @param ac The automaton to free
+ */
+void rift_aho_corasick_free(rift_aho_corasick_t *ac);
+
+/**
+ * @brief Add a literal
+ *
+ * @param ac The automaton
+ * @param bytes The literal bytes
+ * @param length Number of literal bytes, at least 1
+ * @param tag Identifier reported when the literal occurs
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+bool rift_aho_corasick_add(rift_aho_corasick_t *ac, const char *bytes, size_t length,
+                           uint32_t tag, rift_regex_error_t *error);
+
+/**
+ * @brief Add every string an automaton accepts as a literal
+ *
+ * The automaton must accept a finite set of non-empty strings through edges
+ * of at most RIFT_AHO_CORASICK_MAX_EDGE_BYTES bytes each, such as foo|bar or
+ * the case-folded classes of a caseless keyword. Automata with anchors,
+ * word boundaries, atomic groups, counted loops or lookarounds, wider edges
+ * or the empty string are refused with RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE;
+ * loops and other expansions past RIFT_AHO_CORASICK_MAX_EXPANSION states or
+ * RIFT_AHO_CORASICK_MAX_LITERAL_LENGTH bytes fail with
+ * RIFT_REGEX_ERROR_LIMIT_EXCEEDED. Nothing is added on failure.
+ *
+ * @param ac The Aho-Corasick automaton
+ * @param automaton The automaton of the pattern
+ * @param tag Identifier reported when one of its literals occurs
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+bool rift_aho_corasick_add_automaton(rift_aho_corasick_t *ac,
+                                     const rift_regex_automaton_t *automaton, uint32_t tag,
+                                     rift_regex_error_t *error);
+
+/**
+ * @brief Compile the literals added so far into the scanning automaton
+ *
+ * @param ac The automaton
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+bool rift_aho_corasick_build(rift_aho_corasick_t *ac, rift_regex_error_t *error);
+
+/**
+ * @brief Get the number of states of a built automaton
+ *
+ * @param ac The automaton
+ * @return Number of states, 0 if it is not built
+ */
+size_t rift_aho_corasick_get_state_count(const rift_aho_corasick_t *ac);
+
+/**
+ * @brief Collect the tags of every literal occurring in the input
+ *
+ * @param ac The built automaton
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param tags Bitset to fill, cleared first
+ * @param num_words Number of 64-bit words in tags, enough for every tag
+ * @return true if successful, false on invalid parameters or an automaton not built
+ */
+bool rift_aho_corasick_scan(rift_aho_corasick_t *ac, const char *input, size_t length,
+                            uint64_t *tags, size_t num_words);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_AUTOMATON_AHO_CORASICK_H */
@@ -34,6 +34,12 @@ extern "C" {
  */
 typedef struct rift_regex_automaton rift_regex_automaton_t;
 
+/* Forward declaration of the epsilon closure cache */
+struct rift_epsilon_closures;
+
+/* Forward declaration of the lookaround table entries */
+struct rift_lookaround;
+
 typedef enum rift_automaton_type {
     RIFT_AUTOMATON_INVALID = 0,
     RIFT_AUTOMATON_NFA,
@@ -56,7 +62,10 @@ struct rift_regex_automaton {
     size_t transition_capacity;            /**< Capacity of transitions array */
     rift_regex_error_t last_error;         /**< Last error that occurred */
 
-    size_t num_transitions; /**< Number of transitions */
+    size_t num_transitions;                        /**< Number of transitions */
+    struct rift_epsilon_closures *epsilon_closures; /**< Cached epsilon closures or NULL */
+    struct rift_lookaround *lookarounds;            /**< Lookarounds run by states or NULL */
+    size_t num_lookarounds;                         /**< Number of lookarounds */
 };
 
 // Define rift_automaton_t if not already defined
@@ -90,6 +99,16 @@ typedef struct {
  */
 rift_regex_automaton_t *rift_automaton_create(rift_automaton_type_t type);
 
+/**
+ * @brief Create a new state and add it to the automaton
+ *
+ * @param automaton The automaton
+ * @param is_accepting Whether the new state is accepting
+ * @return The created state or NULL on failure
+ */
+rift_regex_state_t *rift_automaton_create_state(rift_regex_automaton_t *automaton,
+                                                bool is_accepting);
+
 /**
  * @brief Create a transition between two states in the automaton
  *
@@ -164,6 +183,8 @@ rift_regex_state_t *rift_automaton_get_state_by_index(const rift_regex_automaton
 /**
  * @brief Find a state by ID
  *
+ * State IDs are indices into the automaton, so this is an array access.
+ *
  * @param automaton The automaton
  * @param id The ID of the state to find
  * @return The state or NULL if not found
@@ -171,6 +192,16 @@ rift_regex_state_t *rift_automaton_get_state_by_index(const rift_regex_automaton
 rift_regex_state_t *rift_automaton_find_state_by_id(const rift_regex_automaton_t *automaton,
                                                     size_t id);
 
+/**
+ * @brief Get the index of a state in an automaton
+ *
+ * @param automaton The automaton
+ * @param state The state
+ * @return The index, or RIFT_STATE_NO_ID if the state is not in the automaton
+ */
+size_t rift_automaton_get_state_index(const rift_regex_automaton_t *automaton,
+                                      const rift_regex_state_t *state);
+
 /**
  * @brief Convert an NFA to a DFA
  *
@@ -183,6 +214,62 @@ rift_regex_state_t *rift_automaton_find_state_by_id(const rift_regex_automaton_t
 rift_regex_automaton_t *rift_automaton_nfa_to_dfa(const rift_regex_automaton_t *nfa,
                                                   rift_regex_error_t *error);
 
+/**
+ * @brief Convert an NFA to a DFA with an explicit state budget
+ *
+ * Conversion fails with RIFT_REGEX_ERROR_LIMIT_EXCEEDED once the DFA would
+ * need more than max_states states.
+ *
+ * @param nfa The NFA to convert
+ * @param max_states Maximum number of DFA states (0 for no limit)
+ * @param error Pointer to store error code (can be NULL)
+ * @return The equivalent DFA or NULL on failure
+ */
+rift_regex_automaton_t *rift_automaton_nfa_to_dfa_limited(const rift_regex_automaton_t *nfa,
+                                                          size_t max_states,
+                                                          rift_regex_error_t *error);
+
+/**
+ * @brief Get the epsilon closures of all states of an automaton
+ *
+ * The closures are computed on first use and cached on the automaton. The
+ * automaton functions that add states or transitions drop the cache; code that
+ * edits states directly must call rift_automaton_invalidate_epsilon_closures.
+ * The compiler fills the cache before returning an automaton, so on compiled
+ * automata this call only reads and is safe from many threads at once.
+ *
+ * @param automaton The automaton
+ * @param error Pointer to store error information (can be NULL)
+ * @return The cached closures or NULL on failure
+ */
+const struct rift_epsilon_closures *
+rift_automaton_get_epsilon_closures(const rift_regex_automaton_t *automaton,
+                                    rift_regex_error_t *error);
+
+/**
+ * @brief Drop the cached epsilon closures of an automaton
+ *
+ * @param automaton The automaton
+ */
+void rift_automaton_invalidate_epsilon_closures(rift_regex_automaton_t *automaton);
+
+/**
+ * @brief Compute the epsilon closure of a set of states
+ *
+ * The closure is read from the cached per-state closures and written in
+ * ascending order of state index.
+ *
+ * @param automaton The automaton
+ * @param states The states to compute the closure for
+ * @param num_states Number of states in the input set
+ * @param closure Array of at least the automaton's state count for the closure states
+ * @param closure_size Pointer to store the number of states in the closure
+ * @return true if successful, false otherwise
+ */
+bool rift_automaton_compute_epsilon_closure(const rift_regex_automaton_t *automaton,
+                                            rift_regex_state_t *const *states, size_t num_states,
+                                            rift_regex_state_t **closure, size_t *closure_size);
+
 /**
  * @brief Add a transition between two states in the automaton
  *
@@ -220,6 +307,16 @@ bool rift_automaton_create_epsilon_transition(rift_regex_automaton_t *automaton,
                                               rift_regex_state_t *from_state,
                                               rift_regex_state_t *to_state);
 
+/**
+ * @brief Normalize the byte transitions of every state
+ *
+ * Byte edges to the same target are merged into one edge over the union of
+ * their bytes, and runs of edges accepting disjoint bytes are sorted by their
+ * lowest byte. Edge order a search could observe is kept.
+ *
+ * @param automaton The automaton to optimize
+ * @return true if successful, false otherwise
+ */
 bool rift_automaton_optimize_transitions(rift_regex_automaton_t *automaton);
 
 /**
@@ -0,0 +1,115 @@
+/**
+ * @file bit_parallel.h
+ * @brief Bit-parallel NFA simulation for short patterns in the LibRift regex engine
+ *
+ * This file defines a Shift-And style simulation over the Glushkov positions
+ * of an NFA, its byte edges. The positions just taken are the bits of one
+ * machine word, so a byte of input costs a shift, a mask per byte and a few
+ * table lookups for the positions that do not simply follow each other,
+ * with no DFA states to build or cache. It reports match bounds only.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_AUTOMATON_BIT_PARALLEL_H
+#define LIBRIFT_REGEX_AUTOMATON_BIT_PARALLEL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/automaton/automaton.h"
+#include "core/errors/regex_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Most positions of an NFA run bit-parallel, the bits of a word
+ */
+#define RIFT_BIT_PARALLEL_MAX_POSITIONS 64
+
+/**
+ * @brief Positions looked up together in a follow table
+ */
+#define RIFT_BIT_PARALLEL_CHUNK_BITS 8
+
+/**
+ * @brief Number of follow tables a word of positions may need
+ */
+#define RIFT_BIT_PARALLEL_MAX_CHUNKS \
+    (RIFT_BIT_PARALLEL_MAX_POSITIONS / RIFT_BIT_PARALLEL_CHUNK_BITS)
+
+/**
+ * @brief Bit-parallel simulation of an NFA
+ *
+ * Bit p stands for position p, the byte edges of the NFA with one target and
+ * pattern, and is set while such an edge was the last one taken. After a
+ * byte, the next positions are those following an active one that accept
+ * the byte:
+ *
+ *   next = (((active & shift) << 1) | (active & loop) | follow) & masks[byte]
+ *
+ * where follow ORs tables[i][(active >> chunk_shifts[i]) & 0xff] over the
+ * chunks holding positions with other successors.
+ */
+typedef struct rift_bit_parallel {
+    uint64_t masks[256];                                 /**< Positions accepting each byte */
+    uint64_t first;                                      /**< Positions a match starts with */
+    uint64_t final;                                      /**< Positions a match may end after */
+    uint64_t shift;                                      /**< Positions followed by the next */
+    uint64_t loop;                                       /**< Positions followed by themselves */
+    uint64_t (*tables)[256];                             /**< Other successors per chunk value */
+    uint8_t chunk_shifts[RIFT_BIT_PARALLEL_MAX_CHUNKS];  /**< First position of each table */
+    uint32_t num_chunks;                                 /**< Number of follow tables */
+    uint32_t num_positions;                              /**< Number of positions */
+    bool accepts_empty;                                  /**< Whether the empty string matches */
+} rift_bit_parallel_t;
+
+/**
+ * @brief Build the bit-parallel simulation of an NFA
+ *
+ * Fails with RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE when the NFA uses
+ * lookarounds or counted loops, and with RIFT_REGEX_ERROR_LIMIT_EXCEEDED when
+ * it has more than RIFT_BIT_PARALLEL_MAX_POSITIONS reachable positions.
+ *
+ * @param nfa The NFA (a DFA is accepted as well)
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new simulation or NULL on failure
+ */
+rift_bit_parallel_t *rift_bit_parallel_create(const rift_regex_automaton_t *nfa,
+                                              rift_regex_error_t *error);
+
+/**
+ * @brief Free a bit-parallel simulation
+ *
+ * @param bit_parallel The simulation to free
+ */
+void rift_bit_parallel_free(rift_bit_parallel_t *bit_parallel);
+
+/**
+ * @brief Get the number of positions of a bit-parallel simulation
+ *
+ * @param bit_parallel The simulation
+ * @return Number of positions
+ */
+size_t rift_bit_parallel_get_position_count(const rift_bit_parallel_t *bit_parallel);
+
+/**
+ * @brief Find a prefix of the input accepted by the automaton
+ *
+ * @param bit_parallel The simulation
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param earliest Whether to stop at the shortest accepted prefix instead of the longest
+ * @param match_end Pointer to store the length of the accepted prefix (can be NULL)
+ * @return true if a prefix (possibly empty) is accepted, false otherwise
+ */
+bool rift_bit_parallel_match_prefix(const rift_bit_parallel_t *bit_parallel, const char *input,
+                                    size_t length, bool earliest, size_t *match_end);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_AUTOMATON_BIT_PARALLEL_H */
@@ -0,0 +1,160 @@
+/**
+ * @file byte_class.h
+ * @brief Byte equivalence classes for the LibRift regex engine automata
+ *
+ * This file defines the alphabet compression used by subset construction and
+ * compiled tables. Two bytes belong to the same class when every transition of
+ * an automaton either accepts both or rejects both, so algorithms can iterate
+ * over classes instead of the full byte alphabet.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_AUTOMATON_BYTE_CLASS_H
+#define LIBRIFT_REGEX_AUTOMATON_BYTE_CLASS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/automaton/automaton.h"
+#include "core/errors/regex_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Number of bytes in the input alphabet
+ */
+#define RIFT_BYTE_CLASS_ALPHABET_SIZE 256
+
+/**
+ * @brief Defined when byte scans use WebAssembly SIMD
+ *
+ * Web builds compiled with -msimd128 scan 16 input bytes per step; other
+ * targets keep their scalar or SSE2 loops.
+ */
+#if defined(__EMSCRIPTEN__) && defined(__wasm_simd128__)
+#define RIFT_BYTE_SCAN_SIMD128 1
+#endif
+
+/**
+ * @brief Number of 32-bit words in a byte set
+ *
+ * Byte c belongs to a set when bit (c & 31) of word (c >> 5) is set, the
+ * layout of the class bitmaps of bytecode programs.
+ */
+#define RIFT_BYTE_SET_WORDS 8
+
+/**
+ * @brief Buffer size large enough for any pattern produced by
+ * rift_byte_classes_format_pattern()
+ */
+#define RIFT_BYTE_CLASS_MAX_PATTERN_LENGTH 264
+
+/**
+ * @brief Partition of the byte alphabet into equivalence classes
+ */
+typedef struct rift_byte_classes {
+    uint8_t map[RIFT_BYTE_CLASS_ALPHABET_SIZE];             /**< Class index of every byte */
+    uint8_t representatives[RIFT_BYTE_CLASS_ALPHABET_SIZE]; /**< Smallest non-NUL member */
+    uint16_t num_classes;                                   /**< Number of classes in use */
+} rift_byte_classes_t;
+
+/**
+ * @brief Initialize a partition with a single class containing every byte
+ *
+ * @param classes The partition to initialize
+ */
+void rift_byte_classes_init(rift_byte_classes_t *classes);
+
+/**
+ * @brief Split classes so that members of a byte set are separated from non-members
+ *
+ * @param classes The partition to refine
+ * @param members Membership flag for every byte
+ */
+void rift_byte_classes_refine(rift_byte_classes_t *classes,
+                              const bool members[RIFT_BYTE_CLASS_ALPHABET_SIZE]);
+
+/**
+ * @brief Compute the byte classes distinguished by an automaton
+ *
+ * Every non-epsilon transition refines the partition once, so the result is the
+ * coarsest partition in which no transition can tell two bytes of a class apart.
+ *
+ * @param automaton The automaton to analyze
+ * @param classes Pointer to store the partition
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+bool rift_byte_classes_compute(const rift_regex_automaton_t *automaton,
+                               rift_byte_classes_t *classes, rift_regex_error_t *error);
+
+/**
+ * @brief Get the class index of a byte
+ *
+ * @param classes The partition
+ * @param byte The byte
+ * @return The class index
+ */
+uint8_t rift_byte_classes_get(const rift_byte_classes_t *classes, uint8_t byte);
+
+/**
+ * @brief Find the next input byte that belongs to a byte set
+ *
+ * @param set RIFT_BYTE_SET_WORDS words, bit c set for each member byte c
+ * @param input The input bytes
+ * @param start First position to consider
+ * @param end Position after the last one to consider
+ * @return Position of the byte or end if none belongs to the set
+ */
+size_t rift_byte_set_find(const uint32_t *set, const char *input, size_t start, size_t end);
+
+/**
+ * @brief Find the next input byte that does not belong to a byte set
+ *
+ * This is the end of the run of members starting at start.
+ *
+ * @param set RIFT_BYTE_SET_WORDS words, bit c set for each member byte c
+ * @param input The input bytes
+ * @param start First position to consider
+ * @param end Position after the last one to consider
+ * @return Position of the byte or end if all belong to the set
+ */
+size_t rift_byte_set_span(const uint32_t *set, const char *input, size_t start, size_t end);
+
+/**
+ * @brief Format a class as a transition pattern
+ *
+ * The pattern is a single (escaped) literal or a bracket expression accepted by
+ * rift_transition_matches(). The NUL byte cannot appear in a pattern string and
+ * is always omitted.
+ *
+ * @param classes The partition
+ * @param class_index The class to format
+ * @param buffer Output buffer of at least RIFT_BYTE_CLASS_MAX_PATTERN_LENGTH bytes
+ * @param buffer_size Size of the output buffer
+ * @return Length of the pattern, or 0 if the class has no printable pattern
+ */
+size_t rift_byte_classes_format_pattern(const rift_byte_classes_t *classes, uint16_t class_index,
+                                        char *buffer, size_t buffer_size);
+
+/**
+ * @brief Format a byte set as a transition pattern
+ *
+ * Same form as rift_byte_classes_format_pattern(), for a set that is not a
+ * class, such as the union of several transitions' bytes.
+ *
+ * @param set RIFT_BYTE_SET_WORDS words, bit c set for each member byte c
+ * @param buffer Output buffer of at least RIFT_BYTE_CLASS_MAX_PATTERN_LENGTH bytes
+ * @param buffer_size Size of the output buffer
+ * @return Length of the pattern, or 0 if the set has no printable pattern
+ */
+size_t rift_byte_set_format_pattern(const uint32_t *set, char *buffer, size_t buffer_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_AUTOMATON_BYTE_CLASS_H */
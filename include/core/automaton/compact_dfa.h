@@ -0,0 +1,248 @@
+/**
+ * @file compact_dfa.h
+ * @brief Compressed transition table forms of a DFA for the LibRift regex engine
+ *
+ * A dense table takes four bytes per state and byte class, which is too much
+ * to keep resident for rulesets whose DFAs have many thousands of states,
+ * although most of those cells are dead or repeat another row. A compact DFA
+ * holds the same automaton in one of several layouts that trade a few more
+ * loads per byte for less memory:
+ *
+ * - dense: every cell, one load per byte, in the narrowest of 8, 16 or 32
+ *   bits that holds the state IDs;
+ * - comb: the live cells of every row overlaid in one array by row
+ *   displacement, each slot checked against the row owning it;
+ * - default chain: each row keeps only the cells where it differs from a
+ *   similar row, packed like the comb, and follows that row on a miss;
+ * - ranges: each row as its runs of consecutive byte classes going to the
+ *   same state, scanned from the first.
+ *
+ * States are numbered by IDs rather than by the rows of the source table.
+ * The dead state is ID RIFT_DFA_DEAD_STATE and the accepting states take the
+ * IDs just above it, so a single compare against special_limit tells a scan
+ * whether the state it reached needs a look. In the dense layout an ID is
+ * premultiplied by the row length, so a step is next[state + class] with no
+ * multiply. rift_compact_dfa_row() maps an ID back to its source row, for
+ * per-row data kept beside the table.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_AUTOMATON_COMPACT_DFA_H
+#define LIBRIFT_REGEX_AUTOMATON_COMPACT_DFA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/automaton/dfa_table.h"
+#include "core/errors/regex_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Default row of a row that has none: its missing cells are dead
+ */
+#define RIFT_COMPACT_DFA_NO_DEFAULT UINT32_MAX
+
+/**
+ * @brief Longest chain of default rows a lookup follows
+ */
+#define RIFT_COMPACT_DFA_MAX_CHAIN 4
+
+/**
+ * @brief Layout of a compact DFA, in the order of their cost per byte
+ *
+ * The comb takes two loads per byte, a default chain up to two per row it
+ * follows, and ranges one per run scanned, which is the most on rows with
+ * many runs. Which layout is smallest depends on the rows.
+ */
+typedef enum rift_dfa_layout {
+    RIFT_DFA_LAYOUT_DENSE = 0,     /**< Row-major table of every cell */
+    RIFT_DFA_LAYOUT_COMB,          /**< Row displacement of the live cells */
+    RIFT_DFA_LAYOUT_DEFAULT_CHAIN, /**< Cells differing from a default row, displaced */
+    RIFT_DFA_LAYOUT_RANGES,        /**< Runs of byte classes per row */
+    RIFT_DFA_LAYOUT_COUNT          /**< Number of layouts */
+} rift_dfa_layout_t;
+
+/**
+ * @brief DFA in a compressed layout, with its special states first
+ */
+typedef struct rift_compact_dfa {
+    rift_dfa_layout_t layout;                   /**< Which of the arrays below are in use */
+    uint32_t num_states;                        /**< Number of states, including the dead state */
+    uint32_t start_state;                       /**< ID of the start state */
+    uint32_t special_limit;                     /**< IDs below this are dead or accepting */
+    uint32_t stride;                            /**< ID step between states: row length or 1 */
+    uint32_t num_classes;                       /**< Number of byte classes */
+    uint8_t byte_class[RIFT_DFA_ALPHABET_SIZE]; /**< Class of every input byte */
+    uint32_t *rows;                             /**< Source row of each state, by ID / stride */
+    void *next;             /**< Dense: num_states * num_classes IDs of id_width bytes */
+    uint8_t id_width;       /**< Dense: bytes per ID, 1, 2 or 4 */
+    uint32_t *base;         /**< Comb, chain: first slot of each row */
+    uint32_t *defaults;     /**< Chain: default row of each row or RIFT_COMPACT_DFA_NO_DEFAULT */
+    uint32_t *check;        /**< Comb, chain: row owning each slot */
+    uint32_t *value;        /**< Comb, chain: target of each slot */
+    uint32_t num_slots;     /**< Comb, chain: number of slots */
+    uint32_t *range_start;  /**< Ranges: first run of each row, num_states + 1 entries */
+    uint8_t *range_last;    /**< Ranges: last byte class of each run */
+    uint32_t *range_target; /**< Ranges: target of each run */
+    uint32_t num_ranges;    /**< Ranges: number of runs */
+} rift_compact_dfa_t;
+
+/**
+ * @brief Build a compact DFA in a given layout
+ *
+ * @param table The dense table to compress, left untouched
+ * @param layout The layout
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new compact DFA or NULL on failure
+ */
+rift_compact_dfa_t *rift_compact_dfa_create(const rift_dfa_table_t *table,
+                                            rift_dfa_layout_t layout, rift_regex_error_t *error);
+
+/**
+ * @brief Build a compact DFA in the fastest layout that fits a memory budget
+ *
+ * The layouts are tried in the order of rift_dfa_layout_t and the first
+ * whose rift_compact_dfa_memory_usage() is at most max_bytes is kept. A
+ * budget of 0 is no budget and keeps the dense layout.
+ *
+ * @param table The dense table to compress, left untouched
+ * @param max_bytes The budget in bytes, 0 for none
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new compact DFA or NULL on failure, with RIFT_REGEX_ERROR_LIMIT_EXCEEDED
+ *         when no layout fits the budget
+ */
+rift_compact_dfa_t *rift_compact_dfa_create_with_budget(const rift_dfa_table_t *table,
+                                                        size_t max_bytes,
+                                                        rift_regex_error_t *error);
+
+/**
+ * @brief Free a compact DFA
+ *
+ * @param dfa The compact DFA (can be NULL)
+ */
+void rift_compact_dfa_free(rift_compact_dfa_t *dfa);
+
+/**
+ * @brief Get the name of a layout
+ *
+ * @param layout The layout
+ * @return A static lowercase name, "unknown" for an invalid layout
+ */
+const char *rift_dfa_layout_name(rift_dfa_layout_t layout);
+
+/**
+ * @brief Step a compact DFA by one byte, without validation
+ *
+ * @param dfa The compact DFA
+ * @param state A state ID
+ * @param byte The input byte
+ * @return The next state ID (RIFT_DFA_DEAD_STATE if there is no transition)
+ */
+static inline uint32_t
+rift_compact_dfa_step(const rift_compact_dfa_t *dfa, uint32_t state, uint8_t byte)
+{
+    uint32_t cls = dfa->byte_class[byte];
+    switch (dfa->layout) {
+    case RIFT_DFA_LAYOUT_DENSE:
+        if (dfa->id_width == 1) {
+            return ((const uint8_t *)dfa->next)[state + cls];
+        }
+        if (dfa->id_width == 2) {
+            return ((const uint16_t *)dfa->next)[state + cls];
+        }
+        return ((const uint32_t *)dfa->next)[(size_t)state + cls];
+    case RIFT_DFA_LAYOUT_COMB: {
+        uint32_t slot = dfa->base[state] + cls;
+        return dfa->check[slot] == state ? dfa->value[slot] : RIFT_DFA_DEAD_STATE;
+    }
+    case RIFT_DFA_LAYOUT_DEFAULT_CHAIN:
+        for (uint32_t row = state; row != RIFT_COMPACT_DFA_NO_DEFAULT; row = dfa->defaults[row]) {
+            uint32_t slot = dfa->base[row] + cls;
+            if (dfa->check[slot] == row) {
+                return dfa->value[slot];
+            }
+        }
+        return RIFT_DFA_DEAD_STATE;
+    default: {
+        // The last run of every row ends at the last class, so the scan stops in the row
+        uint32_t run = dfa->range_start[state];
+        while (cls > dfa->range_last[run]) {
+            run++;
+        }
+        return dfa->range_target[run];
+    }
+    }
+}
+
+/**
+ * @brief Get the source table row of a state, without validation
+ *
+ * @param dfa The compact DFA
+ * @param state A state ID
+ * @return Its row in the table the DFA was built from
+ */
+static inline uint32_t
+rift_compact_dfa_row(const rift_compact_dfa_t *dfa, uint32_t state)
+{
+    return dfa->rows[state / dfa->stride];
+}
+
+/**
+ * @brief Get the next state for an input byte
+ *
+ * @param dfa The compact DFA
+ * @param state The current state ID
+ * @param byte The input byte
+ * @return The next state ID (RIFT_DFA_DEAD_STATE if there is no transition or
+ *         the state is not an ID of the DFA)
+ */
+uint32_t rift_compact_dfa_next(const rift_compact_dfa_t *dfa, uint32_t state, uint8_t byte);
+
+/**
+ * @brief Check whether a state is accepting
+ *
+ * @param dfa The compact DFA
+ * @param state The state ID
+ * @return true if the state is accepting, false otherwise
+ */
+bool rift_compact_dfa_is_accepting(const rift_compact_dfa_t *dfa, uint32_t state);
+
+/**
+ * @brief Check whether the whole input is accepted
+ *
+ * @param dfa The compact DFA
+ * @param input The input buffer
+ * @param length Length of the input in bytes
+ * @return true if the entire input is accepted, false otherwise
+ */
+bool rift_compact_dfa_matches(const rift_compact_dfa_t *dfa, const char *input, size_t length);
+
+/**
+ * @brief Find the longest accepted prefix of the input
+ *
+ * @param dfa The compact DFA
+ * @param input The input buffer
+ * @param length Length of the input in bytes
+ * @param match_end Pointer to store the end offset of the longest match (can be NULL)
+ * @return true if some prefix (possibly empty) is accepted, false otherwise
+ */
+bool rift_compact_dfa_longest_prefix(const rift_compact_dfa_t *dfa, const char *input,
+                                     size_t length, size_t *match_end);
+
+/**
+ * @brief Get the memory used by a compact DFA
+ *
+ * @param dfa The compact DFA
+ * @return Size of its storage in bytes, 0 for NULL
+ */
+size_t rift_compact_dfa_memory_usage(const rift_compact_dfa_t *dfa);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_AUTOMATON_COMPACT_DFA_H */
@@ -0,0 +1,123 @@
+/**
+ * @file counter.h
+ * @brief Counted repetition in the LibRift regex automaton
+ *
+ * This file defines counting states, which let the compiler build a bounded
+ * repeat such as \d{1,1000} from one copy of its body instead of a thousand.
+ * A counted loop is a COUNTER_START state entering the body and a
+ * COUNTER_STEP state at its end. Both have exactly two epsilon edges, one
+ * repeating the body and one leaving the loop, the preferred one first. The
+ * start resets the loop's counter and the step increments it; a repeat is
+ * only taken below the maximum and the loop only left from the minimum on.
+ *
+ * The bytecode VM runs such loops with real counters. The state-machine
+ * engines cannot count, so rift_automaton_expand_counters unrolls the loops
+ * back into plain states before an automaton reaches them.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_AUTOMATON_COUNTER_H
+#define LIBRIFT_REGEX_AUTOMATON_COUNTER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "core/automaton/automaton.h"
+#include "core/automaton/state.h"
+#include "core/errors/regex_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Maximum of a counted loop without an upper bound
+ */
+#define RIFT_COUNTER_UNBOUNDED UINT32_MAX
+
+/**
+ * @brief Largest bound the compiler unrolls instead of counting
+ *
+ * A few copies of a body run faster than a counter, which must be saved in
+ * every backtrack point.
+ */
+#ifndef RIFT_COUNTER_UNROLL_LIMIT
+#define RIFT_COUNTER_UNROLL_LIMIT 8
+#endif
+
+/**
+ * @brief Mark the start and step states of a counted loop
+ *
+ * Both states must already have their repeat and leave edges, in the order
+ * given by greedy.
+ *
+ * @param start The state entering the loop
+ * @param step The state ending an iteration
+ * @param min Iterations required before leaving
+ * @param max Iterations allowed, RIFT_COUNTER_UNBOUNDED for no limit
+ * @param greedy Whether repeating is preferred to leaving
+ * @return true if successful, false on invalid parameters
+ */
+bool rift_counter_mark(rift_regex_state_t *start, rift_regex_state_t *step, uint32_t min,
+                       uint32_t max, bool greedy);
+
+/**
+ * @brief Get the targets of the edges of a counting state
+ *
+ * @param state A COUNTER_START or COUNTER_STEP state
+ * @param repeat Pointer to store the entry of the body
+ * @param leave Pointer to store the state after the loop
+ * @return true if the state has the two edges of a counted loop, false otherwise
+ */
+bool rift_counter_get_edges(const rift_regex_state_t *state, rift_regex_state_t **repeat,
+                            rift_regex_state_t **leave);
+
+/**
+ * @brief Check whether a counted loop is better unrolled
+ *
+ * True when its bound is at most RIFT_COUNTER_UNROLL_LIMIT, or when its body
+ * can match the empty string, which a counter would let it repeat in place.
+ *
+ * @param automaton The automaton holding the loop
+ * @param start The COUNTER_START state of the loop
+ * @return true if the loop should be unrolled, also when it cannot be inspected
+ */
+bool rift_counter_should_unroll(const rift_regex_automaton_t *automaton,
+                                const rift_regex_state_t *start);
+
+/**
+ * @brief Unroll one counted loop into plain states
+ *
+ * The body becomes the first of its copies; the others are clones. Counted
+ * loops nested in the body are cloned with it and stay counted.
+ *
+ * @param automaton The automaton holding the loop
+ * @param start The COUNTER_START state of the loop
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+bool rift_counter_expand(rift_regex_automaton_t *automaton, rift_regex_state_t *start,
+                         rift_regex_error_t *error);
+
+/**
+ * @brief Check whether an automaton has counted loops
+ *
+ * @param automaton The automaton
+ * @return true if any state is a counting state
+ */
+bool rift_automaton_has_counters(const rift_regex_automaton_t *automaton);
+
+/**
+ * @brief Unroll every counted loop of an automaton
+ *
+ * @param automaton The automaton
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+bool rift_automaton_expand_counters(rift_regex_automaton_t *automaton, rift_regex_error_t *error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_AUTOMATON_COUNTER_H */
@@ -0,0 +1,74 @@
+/**
+ * @file dfa_codegen.h
+ * @brief C source generation from compiled DFA tables for the LibRift regex engine
+ *
+ * This file defines the ahead-of-time backend of the compile command. A
+ * compiled table is written out as a standalone C translation unit whose
+ * matchers need neither librift nor a pattern compile at startup.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_AUTOMATON_DFA_CODEGEN_H
+#define LIBRIFT_REGEX_AUTOMATON_DFA_CODEGEN_H
+
+#include <stdbool.h>
+#include <stdio.h>
+#include "core/automaton/dfa_table.h"
+#include "core/errors/regex_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Write a compiled table as standalone C source
+ *
+ * The output defines these functions, with the same semantics as
+ * rift_dfa_table_matches() and rift_dfa_table_longest_prefix():
+ *
+ *     bool <prefix>_matches(const char *input, size_t length);
+ *     bool <prefix>_longest_prefix(const char *input, size_t length, size_t *match_end);
+ *
+ * The tables behind them are static and use the narrowest integer type that
+ * holds every state. Calling this again on the same stream with another
+ * prefix adds another matcher to the file, which is how a pattern set is
+ * emitted.
+ *
+ * @param table The compiled table
+ * @param prefix Prefix of every emitted name, a valid C identifier
+ * @param out The stream to write to
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false on invalid parameters or write failure
+ */
+bool rift_dfa_table_emit_c(const rift_dfa_table_t *table, const char *prefix, FILE *out,
+                           rift_regex_error_t *error);
+
+/**
+ * @brief Write a compiled table as a read-only rift_dfa_table_t definition
+ *
+ * Unlike rift_dfa_table_emit_c(), the output is meant to be linked into code
+ * that uses librift: it defines
+ *
+ *     const rift_dfa_table_t <name>;
+ *
+ * with its arrays as static const data, so the table is usable from the
+ * first instruction with nothing to compile or allocate, and is shared
+ * between processes through the page cache. The output includes no headers;
+ * the file it is written into must include core/automaton/dfa_table.h
+ * first. The table must not be passed to rift_dfa_table_free.
+ *
+ * @param table The compiled table
+ * @param name Name of the emitted table, a valid C identifier
+ * @param out The stream to write to
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false on invalid parameters or write failure
+ */
+bool rift_dfa_table_emit_c_table(const rift_dfa_table_t *table, const char *name, FILE *out,
+                                 rift_regex_error_t *error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_AUTOMATON_DFA_CODEGEN_H */
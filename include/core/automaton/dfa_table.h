@@ -0,0 +1,255 @@
+/**
+ * @file dfa_table.h
+ * @brief Dense transition table form of a DFA for the LibRift regex engine
+ *
+ * This file defines the compiled DFA representation used on matching hot paths.
+ * A compiled table replaces per-character pattern dispatch over
+ * rift_regex_transition_t objects with a single table load per input byte.
+ * Rows are indexed by byte class rather than by raw byte, so a table only has
+ * as many columns as the DFA distinguishes.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_AUTOMATON_DFA_TABLE_H
+#define LIBRIFT_REGEX_AUTOMATON_DFA_TABLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/automaton/automaton.h"
+#include "core/automaton/byte_class.h"
+#include "core/errors/regex_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Number of input bytes mapped by a table's byte class map
+ */
+#define RIFT_DFA_ALPHABET_SIZE RIFT_BYTE_CLASS_ALPHABET_SIZE
+
+/**
+ * @brief Row index of the dead (rejecting sink) state
+ *
+ * Row 0 of every compiled table is the dead state. All of its transitions lead
+ * back to itself and it is never accepting, so scanners can stop as soon as
+ * they reach it.
+ */
+#define RIFT_DFA_DEAD_STATE 0u
+
+/**
+ * @brief Number of inputs the batch scanners advance in lockstep
+ *
+ * Each step of a scan waits for a table load that depends on the previous
+ * one, so a single scan over a table larger than the cache is bound by
+ * memory latency. Stepping several independent inputs in turn keeps that
+ * many loads in flight instead of one.
+ */
+#ifndef RIFT_DFA_INTERLEAVE
+#define RIFT_DFA_INTERLEAVE 8
+#endif
+
+/**
+ * @brief End offset reported by the batch scanners for inputs without a match
+ */
+#define RIFT_DFA_NO_MATCH SIZE_MAX
+
+/**
+ * @brief Compiled DFA with a flat next-state table and an accept bitmap
+ */
+typedef struct rift_dfa_table {
+    uint32_t num_states;                        /**< Number of rows, including the dead state */
+    uint32_t start_state;                       /**< Row index of the start state */
+    uint32_t num_classes;                       /**< Number of columns (byte classes) per row */
+    uint8_t byte_class[RIFT_DFA_ALPHABET_SIZE]; /**< Column index of every input byte */
+    uint32_t *next;                             /**< Row-major num_states * num_classes table */
+    uint64_t *accept_bitmap;                    /**< One bit per row, set when accepting */
+} rift_dfa_table_t;
+
+/**
+ * @brief Compile a DFA into a dense transition table
+ *
+ * The automaton is expected to be the output of rift_automaton_nfa_to_dfa() or
+ * rift_automaton_minimize_dfa(). Transition patterns are evaluated once per
+ * byte value while building the table; matching afterwards never touches the
+ * original rift_regex_transition_t objects.
+ *
+ * @param dfa The deterministic automaton to compile
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new table or NULL on failure
+ */
+rift_dfa_table_t *rift_dfa_table_compile(const rift_regex_automaton_t *dfa,
+                                         rift_regex_error_t *error);
+
+/**
+ * @brief Copy a compiled DFA table
+ *
+ * @param table The table to copy
+ * @return A new table or NULL on failure
+ */
+rift_dfa_table_t *rift_dfa_table_clone(const rift_dfa_table_t *table);
+
+/**
+ * @brief Get the size of the flat encoding of a table
+ *
+ * The encoding is four 32-bit words (states, start, classes, zero), the byte
+ * class map, the accept bitmap and the next-state table, in the byte order of
+ * the machine. Its size is a multiple of 8.
+ *
+ * @param table The compiled table
+ * @return Size in bytes, 0 for NULL
+ */
+size_t rift_dfa_table_encoded_size(const rift_dfa_table_t *table);
+
+/**
+ * @brief Write the flat encoding of a table
+ *
+ * @param table The compiled table
+ * @param data Output buffer of rift_dfa_table_encoded_size() bytes
+ */
+void rift_dfa_table_encode(const rift_dfa_table_t *table, uint8_t *data);
+
+/**
+ * @brief Read a table from its flat encoding into new memory
+ *
+ * @param data The encoding, with no alignment requirement
+ * @param size Number of bytes available at data
+ * @param swap Whether the encoding has the other byte order
+ * @param used Pointer to store the size of the encoding (can be NULL)
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new table or NULL on failure
+ */
+rift_dfa_table_t *rift_dfa_table_decode(const uint8_t *data, size_t size, bool swap, size_t *used,
+                                        rift_regex_error_t *error);
+
+/**
+ * @brief Use a flat encoding in place as a table
+ *
+ * The table's arrays point into data, which must be 8-byte aligned, in the
+ * byte order of the machine, and outlive the table. Such a table must not be
+ * passed to rift_dfa_table_free.
+ *
+ * @param data The encoding
+ * @param size Number of bytes available at data
+ * @param table The table to fill in
+ * @param used Pointer to store the size of the encoding (can be NULL)
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if the encoding is valid, false otherwise
+ */
+bool rift_dfa_table_view(const uint8_t *data, size_t size, rift_dfa_table_t *table, size_t *used,
+                         rift_regex_error_t *error);
+
+/**
+ * @brief Free a compiled DFA table
+ *
+ * @param table The table to free
+ */
+void rift_dfa_table_free(rift_dfa_table_t *table);
+
+/**
+ * @brief Get the next state for an input byte
+ *
+ * @param table The compiled table
+ * @param state The current row index
+ * @param byte The input byte
+ * @return The next row index (RIFT_DFA_DEAD_STATE if there is no transition)
+ */
+uint32_t rift_dfa_table_next(const rift_dfa_table_t *table, uint32_t state, uint8_t byte);
+
+/**
+ * @brief Check whether a row of the table is accepting
+ *
+ * @param table The compiled table
+ * @param state The row index
+ * @return true if the state is accepting, false otherwise
+ */
+bool rift_dfa_table_is_accepting(const rift_dfa_table_t *table, uint32_t state);
+
+/**
+ * @brief Check whether the whole input is accepted by the table
+ *
+ * @param table The compiled table
+ * @param input The input buffer
+ * @param length Length of the input in bytes
+ * @return true if the entire input is accepted, false otherwise
+ */
+bool rift_dfa_table_matches(const rift_dfa_table_t *table, const char *input, size_t length);
+
+/**
+ * @brief Find the longest accepted prefix of the input
+ *
+ * @param table The compiled table
+ * @param input The input buffer
+ * @param length Length of the input in bytes
+ * @param match_end Pointer to store the end offset of the longest match
+ * @return true if some prefix (possibly empty) is accepted, false otherwise
+ */
+bool rift_dfa_table_longest_prefix(const rift_dfa_table_t *table, const char *input,
+                                   size_t length, size_t *match_end);
+
+/**
+ * @brief Find the shortest accepted prefix of the input
+ *
+ * Stops at the first accepting state, so it answers whether some prefix is
+ * accepted without reading the rest of the input.
+ *
+ * @param table The compiled table
+ * @param input The input buffer
+ * @param length Length of the input in bytes
+ * @param match_end Pointer to store the end offset of the shortest match (can be NULL)
+ * @return true if some prefix (possibly empty) is accepted, false otherwise
+ */
+bool rift_dfa_table_shortest_prefix(const rift_dfa_table_t *table, const char *input,
+                                    size_t length, size_t *match_end);
+
+/**
+ * @brief Check whether each of several inputs is accepted as a whole
+ *
+ * Gives the same answers as rift_dfa_table_matches() on each input, but
+ * advances RIFT_DFA_INTERLEAVE inputs at a time, one byte of each in turn,
+ * and prefetches the table entry each of them reads next.
+ *
+ * @param table The compiled table
+ * @param inputs The inputs (an input can be NULL if its length is 0)
+ * @param lengths Lengths of the inputs in bytes, NULL to use strlen
+ * @param count Number of inputs
+ * @param results Array of count results to fill
+ * @return true if successful, false on invalid parameters
+ */
+bool rift_dfa_table_matches_many(const rift_dfa_table_t *table, const char *const *inputs,
+                                 const size_t *lengths, size_t count, bool *results);
+
+/**
+ * @brief Find the longest accepted prefix of each of several inputs
+ *
+ * Gives the same answers as rift_dfa_table_longest_prefix() on each input,
+ * scanning RIFT_DFA_INTERLEAVE of them in lockstep like
+ * rift_dfa_table_matches_many().
+ *
+ * @param table The compiled table
+ * @param inputs The inputs (an input can be NULL if its length is 0)
+ * @param lengths Lengths of the inputs in bytes, NULL to use strlen
+ * @param count Number of inputs
+ * @param match_ends Array of count end offsets to fill, RIFT_DFA_NO_MATCH where no
+ *                   prefix is accepted
+ * @return true if successful, false on invalid parameters
+ */
+bool rift_dfa_table_longest_prefix_many(const rift_dfa_table_t *table,
+                                        const char *const *inputs, const size_t *lengths,
+                                        size_t count, size_t *match_ends);
+
+/**
+ * @brief Get the memory used by a compiled table
+ *
+ * @param table The compiled table
+ * @return Size of the table storage in bytes
+ */
+size_t rift_dfa_table_memory_usage(const rift_dfa_table_t *table);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_AUTOMATON_DFA_TABLE_H */
@@ -0,0 +1,106 @@
+/**
+ * @file epsilon_closure.h
+ * @brief Precomputed epsilon closures for the LibRift regex automaton
+ *
+ * This file defines a table holding the epsilon closure of every state of an
+ * automaton as a sorted list of state indices. The table is computed once and
+ * reused by subset construction and NFA simulation instead of following
+ * epsilon transitions again for every subset or input character.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_AUTOMATON_EPSILON_CLOSURE_H
+#define LIBRIFT_REGEX_AUTOMATON_EPSILON_CLOSURE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/automaton/automaton.h"
+#include "core/automaton/state.h"
+#include "core/errors/regex_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Sentinel index meaning "no state"
+ */
+#define RIFT_EPSILON_NO_STATE UINT32_MAX
+
+/**
+ * @brief Epsilon closures of all states of an automaton
+ *
+ * State i is states[i] of the automaton the table was computed from. Its
+ * closure is members[offsets[i]] .. members[offsets[i + 1] - 1], sorted in
+ * ascending order and always containing i itself.
+ */
+typedef struct rift_epsilon_closures {
+    uint32_t num_states;                     /**< Number of states covered */
+    size_t bitset_words;                     /**< uint64_t words in a state bitset */
+    uint32_t *offsets;                       /**< num_states + 1 offsets into members */
+    uint32_t *members;                       /**< Closure members of every state */
+    const rift_regex_automaton_t *automaton; /**< Automaton the table was computed from */
+} rift_epsilon_closures_t;
+
+/**
+ * @brief Compute the epsilon closures of every state of an automaton
+ *
+ * @param automaton The automaton
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new closure table or NULL on failure
+ */
+rift_epsilon_closures_t *rift_epsilon_closures_compute(const rift_regex_automaton_t *automaton,
+                                                       rift_regex_error_t *error);
+
+/**
+ * @brief Free a closure table
+ *
+ * @param closures The closure table to free
+ */
+void rift_epsilon_closures_free(rift_epsilon_closures_t *closures);
+
+/**
+ * @brief Get the epsilon closure of a state
+ *
+ * @param closures The closure table
+ * @param state The state index
+ * @param size Pointer to store the number of states in the closure
+ * @return The sorted closure members or NULL if the index is out of range
+ */
+const uint32_t *rift_epsilon_closures_get(const rift_epsilon_closures_t *closures, uint32_t state,
+                                          size_t *size);
+
+/**
+ * @brief Find the index of a state in a closure table
+ *
+ * @param closures The closure table
+ * @param state The state to look up
+ * @return The state index or RIFT_EPSILON_NO_STATE if the state is unknown
+ */
+uint32_t rift_epsilon_closures_find_state(const rift_epsilon_closures_t *closures,
+                                          const rift_regex_state_t *state);
+
+/**
+ * @brief Compute the union of the epsilon closures of several states
+ *
+ * The scratch bitset must hold bitset_words words and be all zero on entry;
+ * it is all zero again on return.
+ *
+ * @param closures The closure table
+ * @param states The state indices
+ * @param num_states Number of state indices
+ * @param scratch Zeroed scratch bitset
+ * @param out Array of at least closures->num_states entries for the sorted union
+ * @return Number of states written to out
+ */
+size_t rift_epsilon_closures_union(const rift_epsilon_closures_t *closures,
+                                   const uint32_t *states, size_t num_states, uint64_t *scratch,
+                                   uint32_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_AUTOMATON_EPSILON_CLOSURE_H */
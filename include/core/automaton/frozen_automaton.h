@@ -0,0 +1,209 @@
+/**
+ * @file frozen_automaton.h
+ * @brief Read-only, index-based automaton layout for the LibRift regex engine
+ *
+ * This file defines a frozen copy of an automaton in which states are dense
+ * uint32_t indices and edges are stored in compressed sparse row (CSR) form.
+ * Traversals over a frozen automaton walk a few contiguous arrays instead of
+ * chasing per-state and per-transition heap pointers.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_AUTOMATON_FROZEN_AUTOMATON_H
+#define LIBRIFT_REGEX_AUTOMATON_FROZEN_AUTOMATON_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/automaton/automaton.h"
+#include "core/automaton/transition.h"
+#include "core/errors/regex_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Sentinel index meaning "no state"
+ */
+#define RIFT_FROZEN_NO_STATE UINT32_MAX
+
+/**
+ * @brief Sentinel string pool offset meaning "no string"
+ */
+#define RIFT_FROZEN_NO_STRING UINT32_MAX
+
+/**
+ * @brief Edge flag set on epsilon edges
+ */
+#define RIFT_FROZEN_EDGE_EPSILON 0x01u
+
+/**
+ * @brief Capture metadata for a state that starts or ends a group
+ */
+typedef struct rift_frozen_capture {
+    uint32_t state;       /**< Index of the state */
+    uint32_t name_offset; /**< Group name in the string pool or RIFT_FROZEN_NO_STRING */
+    bool is_group_start;  /**< Whether the state starts a group */
+    bool is_group_end;    /**< Whether the state ends a group */
+} rift_frozen_capture_t;
+
+/**
+ * @brief Counted loop metadata for a COUNTER_START or COUNTER_STEP state
+ */
+typedef struct rift_frozen_counter {
+    uint32_t state; /**< Index of the state */
+    uint32_t start; /**< Index of the loop's COUNTER_START state */
+    uint32_t min;   /**< Iterations required before leaving */
+    uint32_t max;   /**< Iterations allowed, UINT32_MAX for no limit */
+    bool greedy;    /**< Whether the first edge repeats the body */
+} rift_frozen_counter_t;
+
+/**
+ * @brief Lookaround metadata for a state that runs a lookaround
+ */
+typedef struct rift_frozen_lookaround {
+    uint32_t state; /**< Index of the state */
+    uint32_t index; /**< Index in the lookaround table of the source automaton */
+} rift_frozen_lookaround_t;
+
+/**
+ * @brief Frozen automaton with CSR edges and side tables
+ *
+ * State i corresponds to states[i] of the source automaton, and the edges of
+ * state i are edge_offsets[i] .. edge_offsets[i + 1] - 1 in their original order.
+ * The accept tags of state i are accept_tags[accept_tag_offsets[i]] ..
+ * accept_tags[accept_tag_offsets[i + 1] - 1] in ascending order.
+ */
+typedef struct rift_frozen_automaton {
+    rift_automaton_type_t type;                   /**< Type of the source automaton */
+    bool is_deterministic;                        /**< Whether the source automaton is a DFA */
+    rift_regex_flags_t flags;                     /**< Flags of the source automaton */
+    uint32_t num_states;                          /**< Number of states */
+    uint32_t num_edges;                           /**< Number of edges */
+    uint32_t num_captures;                        /**< Number of capture table entries */
+    uint32_t start_state;                         /**< Initial state or RIFT_FROZEN_NO_STATE */
+    uint64_t *accept_bitmap;                      /**< One bit per state, set when accepting */
+    uint8_t *state_flags;                         /**< rift_state_flag_t bits per state */
+    uint32_t *edge_offsets;                       /**< num_states + 1 offsets into edges */
+    uint32_t *edge_targets;                       /**< Target state index per edge */
+    uint8_t *edge_flags;                          /**< RIFT_FROZEN_EDGE_* bits per edge */
+    int32_t *edge_priorities;                     /**< Transition priority per edge */
+    rift_transition_predicate_t *edge_predicates; /**< Parsed predicate per edge */
+    uint32_t *edge_pattern_offsets;               /**< Pattern text offset per edge */
+    rift_frozen_capture_t *captures;              /**< Capture metadata sorted by state */
+    uint32_t num_counters;                        /**< Number of counter table entries */
+    rift_frozen_counter_t *counters;              /**< Counted loop metadata sorted by state */
+    uint32_t num_lookarounds;                     /**< Number of lookaround table entries */
+    rift_frozen_lookaround_t *lookarounds;        /**< Lookaround states sorted by state */
+    uint32_t num_accept_tags;                     /**< Number of accept tag entries */
+    uint32_t accept_tag_limit;                    /**< One more than the largest accept tag */
+    uint32_t *accept_tag_offsets;                 /**< num_states + 1 offsets into accept_tags */
+    uint32_t *accept_tags;                        /**< Pattern identifiers accepted per state */
+    char *string_pool;                            /**< Pattern texts and group names */
+    size_t string_pool_size;                      /**< Size of the string pool in bytes */
+} rift_frozen_automaton_t;
+
+/**
+ * @brief Freeze an automaton into the read-only layout
+ *
+ * The frozen copy owns all of its storage and stays valid after the source
+ * automaton is modified or freed.
+ *
+ * @param automaton The automaton to freeze
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new frozen automaton or NULL on failure
+ */
+rift_frozen_automaton_t *rift_frozen_automaton_create(const rift_regex_automaton_t *automaton,
+                                                      rift_regex_error_t *error);
+
+/**
+ * @brief Free a frozen automaton
+ *
+ * @param frozen The frozen automaton to free
+ */
+void rift_frozen_automaton_free(rift_frozen_automaton_t *frozen);
+
+/**
+ * @brief Check whether a state is accepting
+ *
+ * @param frozen The frozen automaton
+ * @param state The state index
+ * @return true if the state is accepting, false otherwise
+ */
+bool rift_frozen_automaton_is_accepting(const rift_frozen_automaton_t *frozen, uint32_t state);
+
+/**
+ * @brief Check whether an edge is an epsilon edge
+ *
+ * @param frozen The frozen automaton
+ * @param edge The edge index
+ * @return true if the edge is an epsilon edge, false otherwise
+ */
+bool rift_frozen_automaton_edge_is_epsilon(const rift_frozen_automaton_t *frozen, uint32_t edge);
+
+/**
+ * @brief Get the pattern text of an edge
+ *
+ * @param frozen The frozen automaton
+ * @param edge The edge index
+ * @return The pattern or NULL for epsilon edges
+ */
+const char *rift_frozen_automaton_get_edge_pattern(const rift_frozen_automaton_t *frozen,
+                                                   uint32_t edge);
+
+/**
+ * @brief Find the capture metadata of a state
+ *
+ * @param frozen The frozen automaton
+ * @param state The state index
+ * @return The capture entry or NULL if the state has no group information
+ */
+const rift_frozen_capture_t *
+rift_frozen_automaton_find_capture(const rift_frozen_automaton_t *frozen, uint32_t state);
+
+/**
+ * @brief Find the counted loop metadata of a state
+ *
+ * @param frozen The frozen automaton
+ * @param state The state index
+ * @return The counter entry or NULL if the state is not a counting state
+ */
+const rift_frozen_counter_t *
+rift_frozen_automaton_find_counter(const rift_frozen_automaton_t *frozen, uint32_t state);
+
+/**
+ * @brief Find the lookaround metadata of a state
+ *
+ * @param frozen The frozen automaton
+ * @param state The state index
+ * @return The lookaround entry or NULL if the state runs no lookaround
+ */
+const rift_frozen_lookaround_t *
+rift_frozen_automaton_find_lookaround(const rift_frozen_automaton_t *frozen, uint32_t state);
+
+/**
+ * @brief Get the accept tags of a state
+ *
+ * @param frozen The frozen automaton
+ * @param state The state index
+ * @param count Pointer to store the number of tags
+ * @return The tags in ascending order, or NULL if the state has none
+ */
+const uint32_t *rift_frozen_automaton_get_accept_tags(const rift_frozen_automaton_t *frozen,
+                                                      uint32_t state, uint32_t *count);
+
+/**
+ * @brief Get the memory used by a frozen automaton
+ *
+ * @param frozen The frozen automaton
+ * @return Size of the frozen storage in bytes
+ */
+size_t rift_frozen_automaton_memory_usage(const rift_frozen_automaton_t *frozen);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_AUTOMATON_FROZEN_AUTOMATON_H */
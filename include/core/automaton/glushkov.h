@@ -0,0 +1,50 @@
+/**
+ * @file glushkov.h
+ * @brief Glushkov (position) automata for the LibRift regex engine
+ *
+ * This file defines the conversion of a Thompson NFA into its Glushkov
+ * automaton: a start state and one state per position, a byte edge of the
+ * NFA, with no epsilon edges. Every edge into a state reads the predicate of
+ * its position, so closures, subset construction and the bit-parallel
+ * simulation all work on fewer states.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_AUTOMATON_GLUSHKOV_H
+#define LIBRIFT_REGEX_AUTOMATON_GLUSHKOV_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/automaton/automaton.h"
+#include "core/errors/regex_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Build the Glushkov automaton of an NFA
+ *
+ * Position p is taken in the order the epsilon closures of the start state
+ * and of earlier positions reach its edge, and its state gets the edges of
+ * the closure of the edge's target in the order the Pike VM would follow
+ * them, so engines that prefer earlier edges find the same matches. Only
+ * NFAs whose states carry nothing but edges convert: captures, anchors,
+ * atomic groups, counted loops, lookarounds and accept tags live on states
+ * an epsilon-free automaton no longer has, and are refused with
+ * RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE.
+ *
+ * @param automaton The NFA to convert
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new automaton or NULL on failure
+ */
+rift_regex_automaton_t *rift_automaton_to_glushkov(const rift_regex_automaton_t *automaton,
+                                                   rift_regex_error_t *error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_AUTOMATON_GLUSHKOV_H */
@@ -0,0 +1,85 @@
+/**
+ * @file hopcroft.h
+ * @brief Hopcroft partition refinement for DFA minimization in the LibRift regex engine
+ *
+ * This file defines DFA minimization by Hopcroft's algorithm. States are
+ * integer rows of a compiled DFA table and the alphabet is its byte classes,
+ * so refinement runs in O(n * k * log n) time for n states and k classes.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_AUTOMATON_HOPCROFT_H
+#define LIBRIFT_REGEX_AUTOMATON_HOPCROFT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/automaton/automaton.h"
+#include "core/automaton/dfa_table.h"
+#include "core/errors/regex_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Block of a table row that cannot be reached from the start state
+ */
+#define RIFT_HOPCROFT_NO_BLOCK UINT32_MAX
+
+/**
+ * @brief Partition the rows of a DFA table into equivalence classes
+ *
+ * Two rows share a block if and only if they accept the same language. The
+ * dead row is always reachable for the purpose of partitioning, so it belongs
+ * to a block even when no transition leads to it.
+ *
+ * @param table The compiled DFA table
+ * @param block_of Array of table->num_states entries for the block of every row
+ * @param num_blocks Pointer to store the number of blocks
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+bool rift_hopcroft_partition(const rift_dfa_table_t *table, uint32_t *block_of,
+                             uint32_t *num_blocks, rift_regex_error_t *error);
+
+/**
+ * @brief Partition the rows of a DFA table, starting from labelled accept classes
+ *
+ * Rows with different labels never share a block. This keeps apart accepting
+ * states that report different patterns; labels only need to be valid for
+ * rows reachable from the start state and the dead row.
+ *
+ * @param table The compiled DFA table
+ * @param labels Initial class of every row, or NULL to split on acceptance alone
+ * @param num_labels Number of distinct label values
+ * @param block_of Array of table->num_states entries for the block of every row
+ * @param num_blocks Pointer to store the number of blocks
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+bool rift_hopcroft_partition_labeled(const rift_dfa_table_t *table, const uint32_t *labels,
+                                     uint32_t num_labels, uint32_t *block_of,
+                                     uint32_t *num_blocks, rift_regex_error_t *error);
+
+/**
+ * @brief Build the minimal DFA equivalent to a DFA
+ *
+ * The result has one state per block that can still reach an accepting state,
+ * numbered in breadth-first order from the start state. Transitions keep the
+ * patterns of the original DFA, and states with different accept tags are
+ * never merged.
+ *
+ * @param dfa The deterministic automaton to minimize
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new minimized automaton or NULL on failure
+ */
+rift_regex_automaton_t *rift_hopcroft_minimize(const rift_regex_automaton_t *dfa,
+                                               rift_regex_error_t *error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_AUTOMATON_HOPCROFT_H */
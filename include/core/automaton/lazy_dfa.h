@@ -0,0 +1,329 @@
+/**
+ * @file lazy_dfa.h
+ * @brief On-demand DFA construction for the LibRift regex engine
+ *
+ * This file defines a lazy DFA that builds DFA states from NFA state sets only
+ * when the input reaches them. Built states live in a bounded cache that is
+ * flushed when full; when flushing happens too often the search continues as
+ * a plain NFA simulation, so memory stays bounded. The cache can be saved and
+ * loaded back into a lazy DFA of the same automaton, so a restarted process
+ * starts with the states earlier traffic built.
+ *
+ * Anchors and word boundaries stay on the DFA: a state remembers what kind
+ * of byte came before it, and byte classes keep word characters and newlines
+ * apart, so the byte read next settles the assertions between the two.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_AUTOMATON_LAZY_DFA_H
+#define LIBRIFT_REGEX_AUTOMATON_LAZY_DFA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/automaton/automaton.h"
+#include "core/automaton/byte_class.h"
+#include "core/automaton/epsilon_closure.h"
+#include "core/automaton/frozen_automaton.h"
+#include "core/automaton/sparse_set.h"
+#include "core/automaton/subset_table.h"
+#include "core/errors/regex_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Number of cached DFA states used when no capacity is given
+ */
+#define RIFT_LAZY_DFA_DEFAULT_CACHE_STATES 1024
+
+/**
+ * @brief Smallest accepted cache capacity
+ *
+ * A flush keeps the current state and needs room for its successor.
+ */
+#define RIFT_LAZY_DFA_MIN_CACHE_STATES 2
+
+/**
+ * @brief Magic number of a saved state cache ("RFLD" in ASCII)
+ */
+#define RIFT_LAZY_DFA_CACHE_MAGIC 0x52464c44
+
+/**
+ * @brief Format version of a saved state cache
+ */
+#define RIFT_LAZY_DFA_CACHE_VERSION 1
+
+/**
+ * @brief Context byte standing for the edge of the text, before its start or past its end
+ */
+#define RIFT_LAZY_DFA_TEXT_EDGE (-1)
+
+/**
+ * @brief Counters describing the work done by a lazy DFA
+ */
+typedef struct rift_lazy_dfa_stats {
+    size_t states_built;  /**< DFA states materialized from NFA state sets */
+    size_t cache_flushes; /**< Times the state cache was flushed */
+    size_t nfa_fallbacks; /**< Searches finished by NFA simulation */
+} rift_lazy_dfa_stats_t;
+
+/**
+ * @brief Lazily built DFA over an NFA
+ *
+ * Cached state i is the NFA state set stored at index i of the cache table.
+ * Its transition on byte class k is transitions[i * num_classes + k], and its
+ * accept tags are bits of state_tags[i * tag_words] .. state_tags[(i + 1) * tag_words - 1].
+ * An unanchored lazy DFA adds the start state to every successor set, so a
+ * match may begin at any input position.
+ */
+typedef struct rift_lazy_dfa {
+    rift_frozen_automaton_t *nfa;      /**< Frozen copy of the NFA */
+    rift_epsilon_closures_t *closures; /**< Epsilon closures of the NFA states */
+    rift_byte_classes_t classes;       /**< Byte classes of the NFA */
+    size_t max_cached_states;          /**< Capacity of the state cache */
+    rift_subset_table_t *cache;        /**< Cached DFA states keyed by NFA state set */
+    uint32_t *transitions;             /**< Cached transitions, filled on demand */
+    uint8_t *state_flags;              /**< Accepting and dead bits per cached state */
+    size_t tag_words;                  /**< Words per accept tag bitset, 0 without tags */
+    uint64_t *state_tags;              /**< Accept tags per cached state and next byte kind */
+    bool unanchored;                   /**< Whether matches may start at any position */
+    bool has_assertions;               /**< Whether NFA states carry anchors or word boundaries */
+    uint8_t look_behind;               /**< Kind of the byte before the input of a search */
+    uint8_t look_ahead;                /**< Kind of the byte after the input of a search */
+    uint32_t cached_start;             /**< Cached start state or RIFT_SUBSET_NOT_FOUND */
+    uint32_t *members;                 /**< Working set of NFA states */
+    rift_sparse_set_t targets;         /**< Working set of direct targets */
+    uint32_t *next_members;            /**< Working set of successor NFA states */
+    uint64_t *key;                     /**< Bitset used to look up state sets */
+    uint64_t *scratch;                 /**< Zeroed bitset for closure unions */
+    uint32_t *look_members;            /**< Working closure under an assertion context */
+    rift_sparse_set_t look_seen;       /**< States met by that closure, failed ones included */
+    rift_lazy_dfa_stats_t stats;       /**< Work counters */
+} rift_lazy_dfa_t;
+
+/**
+ * @brief Create a lazy DFA for an NFA
+ *
+ * The lazy DFA works on a frozen copy, so the NFA may change or be freed
+ * afterwards. Automata with lookaround states are refused, as the Pike VM
+ * runs those.
+ *
+ * @param nfa The NFA (a DFA is accepted as well)
+ * @param max_cached_states Capacity of the state cache (0 for the default)
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new lazy DFA or NULL on failure
+ */
+rift_lazy_dfa_t *rift_lazy_dfa_create(const rift_regex_automaton_t *nfa, size_t max_cached_states,
+                                      rift_regex_error_t *error);
+
+/**
+ * @brief Create a lazy DFA whose state cache fits in a memory budget
+ *
+ * The cache holds as many states as the budget allows, up to the default
+ * capacity, and is flushed when full like any other.
+ *
+ * @param nfa The NFA (a DFA is accepted as well)
+ * @param max_cache_bytes Bytes the state cache may take, 0 for no limit
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new lazy DFA, or NULL on failure with RIFT_REGEX_ERROR_LIMIT_EXCEEDED
+ *         when the budget cannot hold the smallest cache
+ */
+rift_lazy_dfa_t *rift_lazy_dfa_create_with_budget(const rift_regex_automaton_t *nfa,
+                                                  size_t max_cache_bytes,
+                                                  rift_regex_error_t *error);
+
+/**
+ * @brief Create a lazy DFA that finds matches starting anywhere in the input
+ *
+ * Every state also holds the start state of the NFA, so a single forward pass
+ * sees the match ends of every start position. This is meant for
+ * rift_lazy_dfa_scan_tags(); with rift_lazy_dfa_match_prefix() the reported
+ * end is that of a match starting at any position.
+ *
+ * @param nfa The NFA (a DFA is accepted as well)
+ * @param max_cached_states Capacity of the state cache (0 for the default)
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new lazy DFA or NULL on failure
+ */
+rift_lazy_dfa_t *rift_lazy_dfa_create_unanchored(const rift_regex_automaton_t *nfa,
+                                                 size_t max_cached_states,
+                                                 rift_regex_error_t *error);
+
+/**
+ * @brief Free a lazy DFA
+ *
+ * @param lazy The lazy DFA to free
+ */
+void rift_lazy_dfa_free(rift_lazy_dfa_t *lazy);
+
+/**
+ * @brief Drop every cached DFA state
+ *
+ * @param lazy The lazy DFA
+ */
+void rift_lazy_dfa_flush(rift_lazy_dfa_t *lazy);
+
+/**
+ * @brief Set the bytes around the input of the following searches
+ *
+ * Anchors and word boundaries at the ends of the input depend on the bytes
+ * just outside it, in reading order: a backward search's before byte is the
+ * one after its input in the text. Both are RIFT_LAZY_DFA_TEXT_EDGE until
+ * set, and stay as set until the next call. Automata without anchors or word
+ * boundaries ignore them.
+ *
+ * ^ and $ hold at the edges of the text, and next to a newline as well when
+ * the automaton has RIFT_REGEX_FLAG_MULTILINE. \b holds between a word
+ * character ([0-9A-Za-z_]) and anything else, the edges included.
+ *
+ * @param lazy The lazy DFA
+ * @param before Byte read just before the input, or RIFT_LAZY_DFA_TEXT_EDGE
+ * @param after Byte that would be read just after it, or RIFT_LAZY_DFA_TEXT_EDGE
+ */
+void rift_lazy_dfa_set_context(rift_lazy_dfa_t *lazy, int before, int after);
+
+/**
+ * @brief Find a prefix of the input accepted by the automaton
+ *
+ * @param lazy The lazy DFA
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param earliest Whether to stop at the shortest accepted prefix instead of the longest
+ * @param match_end Pointer to store the length of the accepted prefix (can be NULL)
+ * @return true if a prefix (possibly empty) is accepted, false otherwise
+ */
+bool rift_lazy_dfa_match_prefix(rift_lazy_dfa_t *lazy, const char *input, size_t length,
+                                bool earliest, size_t *match_end);
+
+/**
+ * @brief Find a prefix of the input, telling whether more input could change it
+ *
+ * Works like rift_lazy_dfa_match_prefix() on input that may continue past
+ * length. needs_more is set when the automaton was still live after the last
+ * byte, so a longer prefix, or a first one, could be accepted once more input
+ * arrives. It is never set once an earliest search has found its prefix.
+ *
+ * @param lazy The lazy DFA
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param earliest Whether to stop at the shortest accepted prefix instead of the longest
+ * @param match_end Pointer to store the length of the accepted prefix (can be NULL)
+ * @param needs_more Pointer to store whether the input ran out before the search ended (can be
+ * NULL)
+ * @return true if a prefix (possibly empty) is accepted, false otherwise
+ */
+bool rift_lazy_dfa_match_prefix_partial(rift_lazy_dfa_t *lazy, const char *input, size_t length,
+                                        bool earliest, size_t *match_end, bool *needs_more);
+
+/**
+ * @brief Find a suffix of the input accepted by the automaton, reading backward
+ *
+ * The input is read from its last byte down. On the lazy DFA of a reversed
+ * automaton, the longest suffix ending at a match end gives the leftmost
+ * start of a match ending there.
+ *
+ * @param lazy The lazy DFA, usually of a reversed automaton
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param earliest Whether to stop at the shortest accepted suffix instead of the longest
+ * @param match_length Pointer to store the length of the accepted suffix (can be NULL)
+ * @return true if a suffix (possibly empty) is accepted, false otherwise
+ */
+bool rift_lazy_dfa_match_suffix(rift_lazy_dfa_t *lazy, const char *input, size_t length,
+                                bool earliest, size_t *match_length);
+
+/**
+ * @brief Find where the first match starting before a limit ends
+ *
+ * On an unanchored lazy DFA this is the earliest end of a match starting at
+ * any position below start_limit. Once the limit is passed, the threads still
+ * alive are stepped without the state cache, as cached transitions restart
+ * the search. An anchored lazy DFA only considers the match starting at 0.
+ *
+ * @param lazy The lazy DFA, unanchored to let matches start anywhere
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param start_limit Position matches must start before
+ * @param match_end Pointer to store the end of the match (can be NULL)
+ * @return true if such a match exists, false otherwise
+ */
+bool rift_lazy_dfa_find_earliest_end(rift_lazy_dfa_t *lazy, const char *input, size_t length,
+                                     size_t start_limit, size_t *match_end);
+
+/**
+ * @brief Check whether the whole input is accepted by the automaton
+ *
+ * @param lazy The lazy DFA
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @return true if the input is accepted, false otherwise
+ */
+bool rift_lazy_dfa_matches(rift_lazy_dfa_t *lazy, const char *input, size_t length);
+
+/**
+ * @brief Collect the accept tags of every state reached while reading the input
+ *
+ * For an unanchored lazy DFA this is the set of patterns that match somewhere
+ * in the input, including empty matches.
+ *
+ * @param lazy The lazy DFA
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param tags Bitset to fill, cleared first
+ * @param num_words Number of 64-bit words in tags
+ * @return true if successful, false on invalid parameters or allocation failure
+ */
+bool rift_lazy_dfa_scan_tags(rift_lazy_dfa_t *lazy, const char *input, size_t length,
+                             uint64_t *tags, size_t num_words);
+
+/**
+ * @brief Save the state cache of a lazy DFA
+ *
+ * The cache is written in the byte order of the machine as the NFA state set
+ * and transitions of every cached state, in cache order, after a header
+ * holding a fingerprint of the automaton, its byte classes and whether the
+ * lazy DFA is unanchored. Transitions not built yet are saved as such.
+ *
+ * @param lazy The lazy DFA
+ * @param data Output buffer (can be NULL to get size)
+ * @param size Size of output buffer or pointer to store required size
+ * @return true if successful, false on invalid parameters or a buffer too small
+ */
+bool rift_lazy_dfa_save_cache(const rift_lazy_dfa_t *lazy, uint8_t *data, size_t *size);
+
+/**
+ * @brief Replace the state cache of a lazy DFA with a saved one
+ *
+ * The saved cache must come from a lazy DFA of the same automaton, anchored
+ * the same way, on a machine of the same byte order. States past the capacity
+ * of the cache are left out, and transitions to them are built again when
+ * the input reaches them. Accept flags and tags are computed again from the
+ * state sets, and the work counters are left as they are. A cache rejected
+ * by its header or size leaves the current one in place; one rejected while
+ * its states are added leaves the cache empty.
+ *
+ * @param lazy The lazy DFA
+ * @param data The saved cache
+ * @param size Size of the saved cache in bytes
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if the cache was loaded, false otherwise
+ */
+bool rift_lazy_dfa_load_cache(rift_lazy_dfa_t *lazy, const uint8_t *data, size_t size,
+                              rift_regex_error_t *error);
+
+/**
+ * @brief Get the number of DFA states currently cached
+ *
+ * @param lazy The lazy DFA
+ * @return Number of cached states
+ */
+size_t rift_lazy_dfa_cached_states(const rift_lazy_dfa_t *lazy);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_AUTOMATON_LAZY_DFA_H */
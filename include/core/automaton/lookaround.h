@@ -0,0 +1,157 @@
+/**
+ * @file lookaround.h
+ * @brief Lookaround assertions compiled into sub-automata for the LibRift regex engine
+ *
+ * This file defines lookaround states. The body of a lookaround is compiled
+ * into an automaton of its own, kept in a table of the automaton it belongs
+ * to, and a state of the outer automaton refers to it by index. A thread may
+ * only pass that state when the assertion holds at its input position: a
+ * lookahead needs its body to match some prefix of the input from there, a
+ * lookbehind needs it to match exactly the bytes before it. Lookbehinds have
+ * a fixed length, so checking one is a single anchored run over a known
+ * window instead of a search backwards.
+ *
+ * Bodies run on small lazy DFAs, so a lookaround costs the matcher one DFA
+ * walk instead of a fall back to backtracking.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_AUTOMATON_LOOKAROUND_H
+#define LIBRIFT_REGEX_AUTOMATON_LOOKAROUND_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/automaton/automaton.h"
+#include "core/automaton/lazy_dfa.h"
+#include "core/automaton/state.h"
+#include "core/errors/regex_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Number of DFA states cached for each lookaround body
+ *
+ * Bodies are short, and a cache that thrashes falls back to NFA simulation.
+ */
+#ifndef RIFT_LOOKAROUND_CACHE_STATES
+#define RIFT_LOOKAROUND_CACHE_STATES 64
+#endif
+
+/**
+ * @brief Lookaround assertion of an automaton
+ */
+typedef struct rift_lookaround {
+    rift_regex_automaton_t *body; /**< Compiled body, owned by the table */
+    bool is_behind;               /**< Whether the body matches the bytes before the position */
+    bool is_negated;              /**< Whether the assertion holds when the body does not match */
+    uint32_t length;              /**< Bytes a lookbehind reads, unused by lookaheads */
+} rift_lookaround_t;
+
+/**
+ * @brief Lazy DFAs evaluating the lookarounds of an automaton
+ *
+ * The result of each lookaround at the last position it was tested at is
+ * kept, as every thread reaching a lookaround state at one position asks the
+ * same question.
+ */
+typedef struct rift_lookaround_evaluator {
+    size_t count;              /**< Number of lookarounds */
+    rift_lookaround_t *info;   /**< Kind and length of each lookaround, bodies not owned */
+    rift_lazy_dfa_t **dfas;    /**< Lazy DFA of each body */
+    size_t *cached_positions;  /**< Position of each kept result or SIZE_MAX */
+    bool *cached_results;      /**< Kept result of each lookaround */
+} rift_lookaround_evaluator_t;
+
+/**
+ * @brief Add a lookaround to the table of an automaton
+ *
+ * The automaton takes ownership of the body, also when the call fails.
+ *
+ * @param automaton The automaton
+ * @param body The compiled body, whose end state accepts
+ * @param is_behind Whether the lookaround looks behind
+ * @param is_negated Whether the lookaround is negative
+ * @param length Bytes every match of a lookbehind body has
+ * @return Index of the lookaround, or RIFT_STATE_NO_LOOKAROUND on allocation failure
+ */
+uint32_t rift_automaton_add_lookaround(rift_regex_automaton_t *automaton,
+                                       rift_regex_automaton_t *body, bool is_behind,
+                                       bool is_negated, uint32_t length);
+
+/**
+ * @brief Copy the lookaround table of an automaton into another
+ *
+ * The states of the target refer to the copies by the same indices.
+ *
+ * @param target The automaton receiving the copies, without lookarounds
+ * @param source The automaton to copy from
+ * @return true if successful, false on allocation failure
+ */
+bool rift_automaton_copy_lookarounds(rift_regex_automaton_t *target,
+                                     const rift_regex_automaton_t *source);
+
+/**
+ * @brief Free the lookaround table of an automaton
+ *
+ * @param automaton The automaton
+ */
+void rift_automaton_free_lookarounds(rift_regex_automaton_t *automaton);
+
+/**
+ * @brief Check whether an automaton has lookaround states
+ *
+ * @param automaton The automaton
+ * @return true if a state of the automaton runs a lookaround, false otherwise
+ */
+bool rift_automaton_has_lookarounds(const rift_regex_automaton_t *automaton);
+
+/**
+ * @brief Create an evaluator for the lookarounds of an automaton
+ *
+ * The evaluator refers to the bodies only while it is created, so it stays
+ * valid after the automaton is freed.
+ *
+ * @param automaton The automaton
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new evaluator, or NULL on failure or when the automaton has no lookarounds
+ */
+rift_lookaround_evaluator_t *
+rift_lookaround_evaluator_create(const rift_regex_automaton_t *automaton,
+                                 rift_regex_error_t *error);
+
+/**
+ * @brief Free a lookaround evaluator
+ *
+ * @param evaluator The evaluator to free
+ */
+void rift_lookaround_evaluator_free(rift_lookaround_evaluator_t *evaluator);
+
+/**
+ * @brief Forget the kept results, before a search over new input
+ *
+ * @param evaluator The evaluator
+ */
+void rift_lookaround_evaluator_reset(rift_lookaround_evaluator_t *evaluator);
+
+/**
+ * @brief Check whether a lookaround holds at an input position
+ *
+ * @param evaluator The evaluator
+ * @param index Index of the lookaround
+ * @param input The whole input
+ * @param length Number of input bytes
+ * @param position Position the lookaround is tested at
+ * @return true if the assertion holds, false otherwise
+ */
+bool rift_lookaround_evaluator_test(rift_lookaround_evaluator_t *evaluator, uint32_t index,
+                                    const char *input, size_t length, size_t position);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_AUTOMATON_LOOKAROUND_H */
@@ -44,9 +44,8 @@ rift_regex_automaton_t *rift_automaton_minimize_dfa(const rift_regex_automaton_t
 /**
  * @brief Validate that a minimized automaton is equivalent to the original
  *
- * This function performs basic validation to check if a minimized automaton
- * is equivalent to the original automaton. It ensures that both automata
- * accept the same language.
+ * Checks that both automata accept the same language by walking the pairs
+ * of states of their DFAs; see rift_automaton_is_equivalent().
  *
  * @param original The original automaton
  * @param minimized The minimized automaton
@@ -56,11 +55,10 @@ int rift_automaton_validate_minimization(const rift_regex_automaton_t *original,
                                          const rift_regex_automaton_t *minimized);
 
 /**
- * @brief Optimize transitions in an automaton for better performance
+ * @brief Normalize the byte transitions of every state
  *
- * This function optimizes the transitions in an automaton to improve
- * matching performance, typically by reordering transitions based on
- * frequency or other heuristics.
+ * Merges byte edges to the same target and sorts runs of disjoint edges by
+ * their lowest byte; see automaton.h.
  *
  * @param automaton The automaton to optimize
  * @return true if optimization was successful, false otherwise
@@ -68,13 +66,15 @@ int rift_automaton_validate_minimization(const rift_regex_automaton_t *original,
 bool rift_automaton_optimize_transitions(rift_regex_automaton_t *automaton);
 
 /**
- * @brief Remove unreachable states from an automaton
+ * @brief Remove the states no match can pass through
  *
- * This function removes states that cannot be reached from the initial
- * state, reducing the size of the automaton without changing its behavior.
+ * States the initial state does not reach and states that reach no
+ * accepting state are found in one linear pass and deleted together, with
+ * the edges into them; the rest keep their order in automaton->states. The
+ * language of the automaton does not change.
  *
  * @param automaton The automaton to process
- * @return true if successful, false otherwise
+ * @return true if successful, false on invalid parameters or allocation failure
  */
 bool rift_automaton_remove_unreachable_states(rift_regex_automaton_t *automaton);
 
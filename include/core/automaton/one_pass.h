@@ -0,0 +1,133 @@
+/**
+ * @file one_pass.h
+ * @brief One-pass DFA with capture actions for the LibRift regex engine
+ *
+ * This file defines a DFA for one-pass NFAs, those in which every input byte
+ * leaves at most one way to continue. Each DFA state stands for one NFA state
+ * reached by a byte, and each transition carries the capture slots written on
+ * the epsilon path it follows, so an anchored search fills the captures in a
+ * single forward scan without Pike VM threads or backtracking. The matches
+ * and captures are the ones the Pike VM reports.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_AUTOMATON_ONE_PASS_H
+#define LIBRIFT_REGEX_AUTOMATON_ONE_PASS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/automaton/automaton.h"
+#include "core/automaton/byte_class.h"
+#include "core/errors/regex_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Most NFA states of an automaton turned into a one-pass DFA
+ */
+#define RIFT_ONE_PASS_MAX_NFA_STATES 4096
+
+/**
+ * @brief Most capture slots, two for the whole match and two per group
+ *
+ * The slots a transition writes are a bitmask of one word.
+ */
+#define RIFT_ONE_PASS_MAX_SLOTS 64
+
+/**
+ * @brief Slot value of a position that was not recorded, as in the Pike VM
+ */
+#define RIFT_ONE_PASS_NO_POSITION ((size_t)-1)
+
+/**
+ * @brief Transition entry of a byte class that ends the match
+ */
+#define RIFT_ONE_PASS_DEAD UINT32_MAX
+
+/**
+ * @brief One-pass DFA over an NFA
+ *
+ * The transition of state i on byte class k is transitions[i * num_classes + k]
+ * and, when it is taken at input position p, the slots whose bits are set in
+ * actions[i * num_classes + k] are set to p first. State 0 is the start state.
+ * A state is accepting when its epsilon closure holds an accepting NFA state,
+ * and a match ending there records accept_actions[i] at its end.
+ */
+typedef struct rift_one_pass {
+    rift_byte_classes_t classes; /**< Byte classes of the NFA */
+    uint32_t num_states;         /**< Number of DFA states */
+    uint32_t num_classes;        /**< Number of byte classes */
+    size_t num_groups;           /**< Number of capture groups */
+    size_t num_slots;            /**< Capture slots of a match */
+    uint32_t *transitions;       /**< Next state per state and byte class */
+    uint64_t *actions;           /**< Slots written per state and byte class */
+    uint64_t *accept_actions;    /**< Slots written when a match ends in a state */
+    bool *accepting;             /**< Whether a match may end in a state */
+    size_t *scratch_slots;       /**< Slots of the path followed by a search */
+} rift_one_pass_t;
+
+/**
+ * @brief Check whether an NFA is one-pass and build its DFA
+ *
+ * Fails with RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE when the NFA is not
+ * one-pass or uses lookarounds or counted loops, and with
+ * RIFT_REGEX_ERROR_LIMIT_EXCEEDED when it has more than
+ * RIFT_ONE_PASS_MAX_NFA_STATES states or RIFT_ONE_PASS_MAX_SLOTS slots.
+ *
+ * @param nfa The NFA (a DFA is accepted as well)
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new one-pass DFA or NULL on failure
+ */
+rift_one_pass_t *rift_one_pass_create(const rift_regex_automaton_t *nfa,
+                                      rift_regex_error_t *error);
+
+/**
+ * @brief Free a one-pass DFA
+ *
+ * @param one_pass The one-pass DFA to free
+ */
+void rift_one_pass_free(rift_one_pass_t *one_pass);
+
+/**
+ * @brief Get the number of capture groups of a one-pass DFA
+ *
+ * @param one_pass The one-pass DFA
+ * @return Number of capture groups
+ */
+size_t rift_one_pass_get_group_count(const rift_one_pass_t *one_pass);
+
+/**
+ * @brief Get the number of capture slots filled by a search
+ *
+ * @param one_pass The one-pass DFA
+ * @return Number of slots, two for the whole match and two per group
+ */
+size_t rift_one_pass_get_slot_count(const rift_one_pass_t *one_pass);
+
+/**
+ * @brief Search for a match starting at a position
+ *
+ * The search is always anchored. The longest match is reported, or the
+ * first one to end when earliest is set, with the slots rift_pike_vm_search()
+ * would report for it.
+ *
+ * @param one_pass The one-pass DFA
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param start Position where the match must start
+ * @param earliest Whether to stop at the first match found
+ * @param slots Array of rift_one_pass_get_slot_count entries for the match (can be NULL)
+ * @return true if a match (possibly empty) was found, false otherwise
+ */
+bool rift_one_pass_search(rift_one_pass_t *one_pass, const char *input, size_t length,
+                          size_t start, bool earliest, size_t *slots);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_AUTOMATON_ONE_PASS_H */
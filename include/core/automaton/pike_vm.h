@@ -0,0 +1,141 @@
+/**
+ * @file pike_vm.h
+ * @brief Breadth-first NFA simulation with submatch extraction for the LibRift regex engine
+ *
+ * This file defines a Pike VM that runs all NFA paths in lockstep, keeping at
+ * most one thread per NFA state. Each thread carries its own capture slots, so
+ * matching takes O(n * m) time for an input of n bytes and an NFA of m states
+ * while still reporting capture groups.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_AUTOMATON_PIKE_VM_H
+#define LIBRIFT_REGEX_AUTOMATON_PIKE_VM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/automaton/automaton.h"
+#include "core/automaton/frozen_automaton.h"
+#include "core/automaton/lookaround.h"
+#include "core/automaton/sparse_set.h"
+#include "core/errors/regex_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Slot value of a position that was not recorded
+ */
+#define RIFT_PIKE_VM_NO_POSITION ((size_t)-1)
+
+/**
+ * @brief Group index of a state that starts or ends no group
+ */
+#define RIFT_PIKE_VM_NO_GROUP UINT32_MAX
+
+/**
+ * @brief Set of threads, one per NFA state, in priority order
+ *
+ * states.dense[0 .. states.count - 1] holds the states in priority order.
+ * The capture slots of the thread at position i are slots[i * num_slots] ..
+ * slots[(i + 1) * num_slots - 1].
+ */
+typedef struct rift_pike_vm_threads {
+    rift_sparse_set_t states; /**< States of the threads, in priority order */
+    size_t *slots;            /**< Capture slots of every thread */
+} rift_pike_vm_threads_t;
+
+/**
+ * @brief Entry of the explicit stack used to follow epsilon edges
+ */
+typedef struct rift_pike_vm_frame {
+    uint32_t state;  /**< State to add, or slot to restore when is_restore is set */
+    bool is_restore; /**< Whether the frame restores a capture slot */
+    size_t value;    /**< Slot value to restore */
+} rift_pike_vm_frame_t;
+
+/**
+ * @brief Pike VM over an NFA
+ *
+ * Slots 0 and 1 hold the bounds of the whole match. Group k, numbered from 0
+ * in the order its start state was created, uses slots 2k + 2 and 2k + 3.
+ * A thread only enters a lookaround state when its assertion holds there.
+ */
+typedef struct rift_pike_vm {
+    rift_frozen_automaton_t *nfa;      /**< Frozen copy of the NFA */
+    size_t num_groups;                 /**< Number of capture groups */
+    size_t num_slots;                  /**< Capture slots per thread */
+    uint32_t *group_starts;            /**< Group started by each state or RIFT_PIKE_VM_NO_GROUP */
+    uint32_t *group_ends;              /**< Group ended by each state or RIFT_PIKE_VM_NO_GROUP */
+    rift_pike_vm_threads_t threads[2]; /**< Current and next thread sets */
+    rift_pike_vm_frame_t *stack;       /**< Stack for following epsilon edges */
+    size_t stack_capacity;             /**< Number of frames the stack can hold */
+    size_t *scratch_slots;             /**< Slots of the thread being added */
+    size_t *match_slots;               /**< Slots of the best match so far */
+
+    /* Set up only for automata with lookarounds */
+    rift_lookaround_evaluator_t *lookarounds; /**< Evaluator of the lookaround bodies */
+    uint32_t *state_lookarounds;              /**< Lookaround index of each state */
+} rift_pike_vm_t;
+
+/**
+ * @brief Create a Pike VM for an NFA
+ *
+ * The VM works on a frozen copy, so the NFA may change or be freed afterwards.
+ *
+ * @param nfa The NFA (a DFA is accepted as well)
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new Pike VM or NULL on failure
+ */
+rift_pike_vm_t *rift_pike_vm_create(const rift_regex_automaton_t *nfa, rift_regex_error_t *error);
+
+/**
+ * @brief Free a Pike VM
+ *
+ * @param vm The Pike VM to free
+ */
+void rift_pike_vm_free(rift_pike_vm_t *vm);
+
+/**
+ * @brief Get the number of capture groups of a Pike VM
+ *
+ * @param vm The Pike VM
+ * @return Number of capture groups
+ */
+size_t rift_pike_vm_get_group_count(const rift_pike_vm_t *vm);
+
+/**
+ * @brief Get the number of capture slots filled by a search
+ *
+ * @param vm The Pike VM
+ * @return Number of slots, two for the whole match and two per group
+ */
+size_t rift_pike_vm_get_slot_count(const rift_pike_vm_t *vm);
+
+/**
+ * @brief Search the input for the leftmost match
+ *
+ * Among matches with the leftmost start, the longest one is reported, or the
+ * first one to end when earliest is set. Captures come from the highest
+ * priority path, following the order of the NFA transitions.
+ *
+ * @param vm The Pike VM
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param start Position where the search starts
+ * @param anchored Whether the match must start at the start position
+ * @param earliest Whether to stop at the first match found
+ * @param slots Array of rift_pike_vm_get_slot_count entries for the match (can be NULL)
+ * @return true if a match (possibly empty) was found, false otherwise
+ */
+bool rift_pike_vm_search(rift_pike_vm_t *vm, const char *input, size_t length, size_t start,
+                         bool anchored, bool earliest, size_t *slots);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_AUTOMATON_PIKE_VM_H */
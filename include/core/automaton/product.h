@@ -0,0 +1,132 @@
+/**
+ * @file product.h
+ * @brief Product constructions and language comparisons of DFAs for the LibRift regex engine
+ *
+ * This file defines operations combining the languages of frozen DFAs: the
+ * product automata accepting their intersection, union or difference, the
+ * complement of a DFA, and checks of language inclusion and equivalence.
+ * All of them walk the pairs of states reachable from the two start states
+ * over the byte classes both automata distinguish, so the checks cost no
+ * more than the pairs they visit and stop at the first counterexample.
+ *
+ * The operations compare the strings the automata accept. State flags such
+ * as anchors, word boundaries and atomic groups are ignored, as they are by
+ * the lazy DFA, so automata using them should not be compared.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_AUTOMATON_PRODUCT_H
+#define LIBRIFT_REGEX_AUTOMATON_PRODUCT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/automaton/automaton.h"
+#include "core/automaton/frozen_automaton.h"
+#include "core/errors/regex_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Largest number of state pairs a product or comparison visits
+ *
+ * Reaching it fails the operation with RIFT_REGEX_ERROR_LIMIT_EXCEEDED.
+ */
+#define RIFT_PRODUCT_MAX_STATES (1u << 20)
+
+/**
+ * @brief How a product combines the acceptance of its two automata
+ */
+typedef enum rift_product_operation {
+    RIFT_PRODUCT_INTERSECTION, /**< Strings both automata accept */
+    RIFT_PRODUCT_UNION,        /**< Strings either automaton accepts */
+    RIFT_PRODUCT_DIFFERENCE    /**< Strings the first accepts and the second does not */
+} rift_product_operation_t;
+
+/**
+ * @brief Freeze the DFA of an automaton for the product operations
+ *
+ * NFAs are determinized first; DFAs are frozen as they are.
+ *
+ * @param automaton The automaton
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new frozen DFA or NULL on failure
+ */
+rift_frozen_automaton_t *rift_automaton_freeze_dfa(const rift_regex_automaton_t *automaton,
+                                                   rift_regex_error_t *error);
+
+/**
+ * @brief Build the product of two DFAs
+ *
+ * The result is a DFA with one state per reachable pair of states, leaving
+ * out pairs whose dead states rule out accepting, such as any pair with a
+ * dead state in an intersection. The NUL byte cannot appear in a transition
+ * pattern, so the result has no transitions on it.
+ *
+ * @param a The first frozen DFA
+ * @param b The second frozen DFA
+ * @param operation How acceptance is combined
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new DFA or NULL on failure
+ */
+rift_regex_automaton_t *rift_automaton_product(const rift_frozen_automaton_t *a,
+                                               const rift_frozen_automaton_t *b,
+                                               rift_product_operation_t operation,
+                                               rift_regex_error_t *error);
+
+/**
+ * @brief Build a DFA accepting the strings two DFAs both accept
+ *
+ * @param a The first frozen DFA
+ * @param b The second frozen DFA
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new DFA or NULL on failure
+ */
+rift_regex_automaton_t *rift_automaton_intersection(const rift_frozen_automaton_t *a,
+                                                    const rift_frozen_automaton_t *b,
+                                                    rift_regex_error_t *error);
+
+/**
+ * @brief Build a DFA accepting the strings a DFA rejects
+ *
+ * Strings leaving the DFA are accepted by an accepting sink. As no
+ * transition pattern holds the NUL byte, strings containing it are not.
+ *
+ * @param dfa The frozen DFA
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new DFA or NULL on failure
+ */
+rift_regex_automaton_t *rift_automaton_complement(const rift_frozen_automaton_t *dfa,
+                                                  rift_regex_error_t *error);
+
+/**
+ * @brief Check whether every string one DFA accepts is accepted by another
+ *
+ * @param a The frozen DFA whose language may be included
+ * @param b The frozen DFA whose language may include it
+ * @param error Pointer to store error information (can be NULL)
+ * @return 1 if the language of a is a subset of that of b, 0 if not,
+ *         negative on error
+ */
+int rift_automaton_is_subset(const rift_frozen_automaton_t *a, const rift_frozen_automaton_t *b,
+                             rift_regex_error_t *error);
+
+/**
+ * @brief Check whether two DFAs accept the same strings
+ *
+ * @param a The first frozen DFA
+ * @param b The second frozen DFA
+ * @param error Pointer to store error information (can be NULL)
+ * @return 1 if the languages are equal, 0 if not, negative on error
+ */
+int rift_automaton_is_equivalent(const rift_frozen_automaton_t *a,
+                                 const rift_frozen_automaton_t *b, rift_regex_error_t *error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_AUTOMATON_PRODUCT_H */
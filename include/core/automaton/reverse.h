@@ -0,0 +1,46 @@
+/**
+ * @file reverse.h
+ * @brief Reversal of automata for the LibRift regex engine
+ *
+ * This file defines the reverse of an automaton, which accepts the reversed
+ * strings of the language of the original. Run backward from the end of a
+ * match found by a forward DFA, it finds where the match starts without
+ * retrying the pattern at every earlier position.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_AUTOMATON_REVERSE_H
+#define LIBRIFT_REGEX_AUTOMATON_REVERSE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/automaton/automaton.h"
+#include "core/errors/regex_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Build the reverse of an automaton
+ *
+ * Every edge is turned around, the initial state becomes the only accepting
+ * state and a new initial state reaches the old accepting states by epsilon
+ * edges. Capture and accept tag data are dropped, as the reverse only
+ * locates match bounds. Anchors and word boundaries are kept, with start and
+ * end anchors swapped. Automata with counted loops or lookarounds are refused.
+ *
+ * @param automaton The automaton to reverse
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new automaton or NULL on failure
+ */
+rift_regex_automaton_t *rift_automaton_reverse(const rift_regex_automaton_t *automaton,
+                                               rift_regex_error_t *error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_AUTOMATON_REVERSE_H */
@@ -0,0 +1,100 @@
+/**
+ * @file sparse_set.h
+ * @brief Sparse sets of NFA state indices for the LibRift regex engine
+ *
+ * A sparse set (Briggs and Torczon) holds integers below a fixed capacity in
+ * two arrays: dense lists the members in insertion order and sparse maps a
+ * member back to its position in dense. A value is a member when its sparse
+ * entry points inside the first count entries of dense and that entry holds
+ * the value, so insertion and membership take constant time and clearing is
+ * setting count to zero, whatever the capacity. The NFA simulations and the
+ * subset constructions keep their per-byte state sets in them.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_AUTOMATON_SPARSE_SET_H
+#define LIBRIFT_REGEX_AUTOMATON_SPARSE_SET_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Set of integers below a fixed capacity
+ */
+typedef struct rift_sparse_set {
+    uint32_t *dense;   /**< Members in insertion order */
+    uint32_t *sparse;  /**< Position of each value in dense, meaningful for members only */
+    uint32_t count;    /**< Number of members */
+    uint32_t capacity; /**< Values are below this */
+} rift_sparse_set_t;
+
+/**
+ * @brief Allocate the arrays of an empty set
+ *
+ * @param set The set
+ * @param capacity Values the set can hold are below this
+ * @return true if successful, false if the allocation failed
+ */
+bool rift_sparse_set_init(rift_sparse_set_t *set, uint32_t capacity);
+
+/**
+ * @brief Free the arrays of a set
+ *
+ * @param set The set, empty with no capacity on return
+ */
+void rift_sparse_set_destroy(rift_sparse_set_t *set);
+
+/**
+ * @brief Check whether a value is in a set
+ *
+ * @param set The set
+ * @param value A value below the capacity
+ * @return true if the value is a member
+ */
+static inline bool
+rift_sparse_set_contains(const rift_sparse_set_t *set, uint32_t value)
+{
+    uint32_t index = set->sparse[value];
+    return index < set->count && set->dense[index] == value;
+}
+
+/**
+ * @brief Add a value to a set
+ *
+ * @param set The set
+ * @param value A value below the capacity
+ * @return true if the value was added, false if it was already a member
+ */
+static inline bool
+rift_sparse_set_insert(rift_sparse_set_t *set, uint32_t value)
+{
+    if (rift_sparse_set_contains(set, value)) {
+        return false;
+    }
+    set->sparse[value] = set->count;
+    set->dense[set->count++] = value;
+    return true;
+}
+
+/**
+ * @brief Remove every member of a set
+ *
+ * @param set The set
+ */
+static inline void
+rift_sparse_set_clear(rift_sparse_set_t *set)
+{
+    set->count = 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_AUTOMATON_SPARSE_SET_H */
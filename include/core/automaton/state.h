@@ -13,6 +13,7 @@
 #include <regex.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/stat.h>
@@ -30,10 +31,6 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
-/* Forward declaration for maximum capture groups with default value */
-#ifndef RIFT_MAX_CAPTURE_GROUPS
-#define RIFT_MAX_CAPTURE_GROUPS 10 /**< Default maximum number of capture groups */
-#endif
 /**
  * @brief State flags enumeration
  */
@@ -42,13 +39,39 @@ typedef enum rift_state_flag {
     RIFT_STATE_FLAG_ANCHOR_START = 1,     /**< Start anchor (^) */
     RIFT_STATE_FLAG_ANCHOR_END = 2,       /**< End anchor ($) */
     RIFT_STATE_FLAG_WORD_BOUNDARY = 4,    /**< Word boundary (\b) */
-    RIFT_STATE_FLAG_NOT_WORD_BOUNDARY = 8 /**< Not word boundary (\B) */
+    RIFT_STATE_FLAG_NOT_WORD_BOUNDARY = 8, /**< Not word boundary (\B) */
+    RIFT_STATE_FLAG_ATOMIC_START = 16,    /**< Entry of an atomic group or possessive quantifier */
+    RIFT_STATE_FLAG_ATOMIC_END = 32,      /**< Exit, discarding backtrack points since the entry */
+    RIFT_STATE_FLAG_COUNTER_START = 64,   /**< Entry of a counted loop, resetting its counter */
+    RIFT_STATE_FLAG_COUNTER_STEP = 128    /**< End of an iteration, incrementing the counter */
 } rift_state_flag_t;
 
+/**
+ * @brief Lookaround index of a state that runs no lookaround
+ */
+#define RIFT_STATE_NO_LOOKAROUND UINT32_MAX
+
+/**
+ * @brief ID of a state that belongs to no automaton
+ */
+#define RIFT_STATE_NO_ID SIZE_MAX
+
+/**
+ * @brief Capturing group information of a state
+ *
+ * Only the states that open or close a group have one, so the record is kept
+ * out of the state and allocated on first use.
+ */
+typedef struct rift_state_capture {
+    char *group_name;    /**< Name of the capturing group (if any) */
+    bool is_group_start; /**< Whether this state marks the start of a group */
+    bool is_group_end;   /**< Whether this state marks the end of a group */
+} rift_state_capture_t;
+
 /* Type alias for the state structure */
 typedef struct rift_regex_state rift_regex_state_t;
 struct rift_regex_state {
-    size_t id;                                  /**< Unique identifier */
+    size_t id;                                  /**< Index in its automaton */
     bool is_accepting;                          /**< Whether this is an accepting state */
     char *pattern;                              /**< Pattern associated with this state */
     struct rift_regex_transition **transitions; /**< Array of outgoing transitions */
@@ -56,15 +79,24 @@ struct rift_regex_state {
     size_t transition_capacity;                 /**< Capacity of transitions array */
     void *user_data;                            /**< User data associated with the state */
 
-    /* Capturing group information */
-    char *group_name;    /**< Name of the capturing group (if any) */
-    bool is_group_start; /**< Whether this state marks the start of a group */
-    bool is_group_end;   /**< Whether this state marks the end of a group */
-
-    size_t capture_group_ends[RIFT_MAX_CAPTURE_GROUPS]; /**< End positions for capture groups */
+    /* Capturing group information, NULL for states outside group boundaries */
+    rift_state_capture_t *capture; /**< Group name and boundary marks */
 
     /* Flags for special features */
     rift_state_flag_t flags; /**< Special state flags */
+
+    /* Pattern identifiers accepted here, for automata built from a pattern set */
+    uint64_t *accept_tags;       /**< Bitset of accepted pattern identifiers */
+    size_t num_accept_tag_words; /**< Number of 64-bit words in accept_tags */
+
+    /* Counted loop information, for COUNTER_START and COUNTER_STEP states */
+    uint32_t repeat_min;                   /**< Iterations required before leaving */
+    uint32_t repeat_max;                   /**< Iterations allowed, UINT32_MAX for no limit */
+    bool repeat_greedy;                    /**< Whether the first edge repeats the body */
+    struct rift_regex_state *repeat_start; /**< COUNTER_START state of the loop */
+
+    /* Lookaround run on entry, as an index into the automaton's lookaround table */
+    uint32_t lookaround; /**< Lookaround index or RIFT_STATE_NO_LOOKAROUND */
 };
 
 /**
@@ -153,8 +185,11 @@ bool rift_state_set_accepting(rift_regex_state_t *state, bool is_accepting);
 /**
  * @brief Get the ID of a state
  *
+ * The ID is the index of the state in the automaton holding it, assigned
+ * when the state is added and kept dense as states are removed.
+ *
  * @param state The state
- * @return The state ID or 0 if the state is NULL
+ * @return The state ID, or RIFT_STATE_NO_ID if the state is NULL or in no automaton
  */
 size_t rift_state_get_id(const rift_regex_state_t *state);
 
@@ -313,18 +348,47 @@ bool rift_state_set_group_end(rift_regex_state_t *state, bool is_group_end);
 bool rift_state_is_group_end(const rift_regex_state_t *state);
 
 /**
- * @brief Reset the state ID counter
+ * @brief Tag a state as accepting for a pattern
+ *
+ * The state becomes accepting. A state may carry the tags of several patterns
+ * when their automata are combined.
+ *
+ * @param state The state to modify
+ * @param tag The pattern identifier
+ * @return true if successful, false otherwise
+ */
+bool rift_state_add_accept_tag(rift_regex_state_t *state, uint32_t tag);
+
+/**
+ * @brief Check whether a state accepts for a pattern
  *
- * This function should only be used for testing purposes.
+ * @param state The state to check
+ * @param tag The pattern identifier
+ * @return true if the state carries the tag, false otherwise
  */
-void rift_state_reset_id_counter(void);
+bool rift_state_has_accept_tag(const rift_regex_state_t *state, uint32_t tag);
 
 /**
- * @brief Get the next available state ID
+ * @brief Get the accept tag bitset of a state
  *
- * @return The next available state ID
+ * Bit t of the bitset is set when the state accepts for pattern t.
+ *
+ * @param state The state
+ * @param num_words Pointer to store the number of 64-bit words (can be NULL)
+ * @return The bitset or NULL if the state has no tags
+ */
+const uint64_t *rift_state_get_accept_tags(const rift_regex_state_t *state, size_t *num_words);
+
+/**
+ * @brief Add the accept tags of one state to another
+ *
+ * Only the tags are copied; whether the state is accepting is left unchanged.
+ *
+ * @param state The state to modify
+ * @param source The state whose tags are added
+ * @return true if successful, false otherwise
  */
-size_t rift_state_get_next_id(void);
+bool rift_state_merge_accept_tags(rift_regex_state_t *state, const rift_regex_state_t *source);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,112 @@
+/**
+ * @file subset_table.h
+ * @brief Hash-indexed table of NFA state subsets for the LibRift regex engine
+ *
+ * This file defines the table used by subset construction to map sets of NFA
+ * states to DFA state indices. Each subset is stored as a canonical bitset over
+ * NFA state indices and found through a 64-bit hash in an open-addressing
+ * index, so lookups do not depend on the number of subsets already stored.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_AUTOMATON_SUBSET_TABLE_H
+#define LIBRIFT_REGEX_AUTOMATON_SUBSET_TABLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Sentinel index meaning "no subset"
+ */
+#define RIFT_SUBSET_NOT_FOUND UINT32_MAX
+
+/**
+ * @brief Table of NFA state subsets
+ *
+ * Subset i occupies bits[i * words] .. bits[(i + 1) * words - 1]. Subsets are
+ * numbered in insertion order, which subset construction uses as its work list.
+ */
+typedef struct rift_subset_table {
+    size_t words;      /**< uint64_t words per subset */
+    uint32_t count;    /**< Number of subsets stored */
+    uint32_t capacity; /**< Number of subsets the storage can hold */
+    uint64_t *bits;    /**< Bitsets of all subsets */
+    uint64_t *hashes;  /**< Hash of each subset */
+    uint32_t *slots;   /**< Open-addressing index holding subset index + 1, 0 when empty */
+    size_t num_slots;  /**< Number of slots, always a power of two */
+} rift_subset_table_t;
+
+/**
+ * @brief Create an empty subset table
+ *
+ * @param num_nfa_states Number of NFA states a subset can contain
+ * @return A new subset table or NULL on failure
+ */
+rift_subset_table_t *rift_subset_table_create(uint32_t num_nfa_states);
+
+/**
+ * @brief Free a subset table
+ *
+ * @param table The subset table to free
+ */
+void rift_subset_table_free(rift_subset_table_t *table);
+
+/**
+ * @brief Remove all subsets while keeping the allocated storage
+ *
+ * @param table The subset table
+ */
+void rift_subset_table_clear(rift_subset_table_t *table);
+
+/**
+ * @brief Compute the hash of a subset bitset
+ *
+ * @param bitset The subset bitset
+ * @param words Number of words in the bitset
+ * @return The 64-bit hash
+ */
+uint64_t rift_subset_table_hash(const uint64_t *bitset, size_t words);
+
+/**
+ * @brief Find a subset in the table
+ *
+ * @param table The subset table
+ * @param bitset The subset bitset of table->words words
+ * @return The subset index or RIFT_SUBSET_NOT_FOUND
+ */
+uint32_t rift_subset_table_find(const rift_subset_table_t *table, const uint64_t *bitset);
+
+/**
+ * @brief Find a subset, adding it to the table if it is not present
+ *
+ * Inserting may move the stored bitsets, so pointers returned by
+ * rift_subset_table_get are invalidated.
+ *
+ * @param table The subset table
+ * @param bitset The subset bitset of table->words words
+ * @param inserted Pointer to store whether the subset was added (can be NULL)
+ * @return The subset index or RIFT_SUBSET_NOT_FOUND on allocation failure
+ */
+uint32_t rift_subset_table_insert(rift_subset_table_t *table, const uint64_t *bitset,
+                                  bool *inserted);
+
+/**
+ * @brief Get the bitset of a stored subset
+ *
+ * @param table The subset table
+ * @param index The subset index
+ * @return The subset bitset or NULL if the index is out of range
+ */
+const uint64_t *rift_subset_table_get(const rift_subset_table_t *table, uint32_t index);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_AUTOMATON_SUBSET_TABLE_H */
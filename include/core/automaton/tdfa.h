@@ -0,0 +1,163 @@
+/**
+ * @file tdfa.h
+ * @brief Tagged DFA for submatch extraction in the LibRift regex engine
+ *
+ * This file defines a tagged DFA (TDFA) in the style of Laurikari and
+ * Trofimovich. A DFA state stands for the ordered thread list the Pike VM
+ * would hold at a position, with each capture slot of each thread kept in a
+ * register instead of in the thread. Transitions carry register operations,
+ * a copy or a write of the current position, so an anchored search reports
+ * the matches and captures of the Pike VM in one deterministic pass, whether
+ * or not the pattern is one-pass.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_AUTOMATON_TDFA_H
+#define LIBRIFT_REGEX_AUTOMATON_TDFA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/automaton/automaton.h"
+#include "core/automaton/byte_class.h"
+#include "core/errors/regex_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Most NFA states of an automaton turned into a tagged DFA
+ */
+#define RIFT_TDFA_MAX_NFA_STATES 4096
+
+/**
+ * @brief Most DFA states built before the construction gives up
+ */
+#define RIFT_TDFA_MAX_STATES 1024
+
+/**
+ * @brief Most registers a DFA state may keep positions in
+ */
+#define RIFT_TDFA_MAX_REGISTERS 1024
+
+/**
+ * @brief Slot value of a position that was not recorded, as in the Pike VM
+ */
+#define RIFT_TDFA_NO_POSITION ((size_t)-1)
+
+/**
+ * @brief Transition entry of a byte class that ends the match
+ */
+#define RIFT_TDFA_DEAD UINT32_MAX
+
+/**
+ * @brief Register entry of a slot that holds no position
+ */
+#define RIFT_TDFA_NO_REGISTER UINT32_MAX
+
+/**
+ * @brief Source of a register operation that writes the current position
+ */
+#define RIFT_TDFA_POSITION (UINT32_MAX - 1)
+
+/**
+ * @brief Register operation of a transition
+ *
+ * The operations of a transition run in parallel: every source is read
+ * before any destination is written.
+ */
+typedef struct rift_tdfa_op {
+    uint32_t dst; /**< Register written */
+    uint32_t src; /**< Register read, or RIFT_TDFA_POSITION */
+} rift_tdfa_op_t;
+
+/**
+ * @brief Tagged DFA over an NFA
+ *
+ * The transition of state i on byte class k is transitions[i * num_classes + k]
+ * and, when it is taken, ops[op_offsets[i * num_classes + k]] up to
+ * ops[op_offsets[i * num_classes + k + 1]] run with the position after the
+ * byte. The operations before op_offsets[0] set up the registers of state 0,
+ * the start state, with the start position. A match ending in an accepting
+ * state i reads capture slot 2 + t from register accept_registers[i * num_tags + t].
+ */
+typedef struct rift_tdfa {
+    rift_byte_classes_t classes; /**< Byte classes of the NFA */
+    uint32_t num_states;         /**< Number of DFA states */
+    uint32_t num_classes;        /**< Number of byte classes */
+    uint32_t num_registers;      /**< Registers used by any state */
+    size_t num_groups;           /**< Number of capture groups */
+    size_t num_slots;            /**< Capture slots of a match */
+    size_t num_tags;             /**< Slots kept in registers, all but the whole match */
+    uint32_t *transitions;       /**< Next state per state and byte class */
+    uint32_t *op_offsets;        /**< First operation per state and byte class */
+    rift_tdfa_op_t *ops;         /**< Register operations of all transitions */
+    size_t num_ops;              /**< Number of register operations */
+    bool *accepting;             /**< Whether a match may end in a state */
+    uint32_t *accept_registers;  /**< Register of each tag per accepting state */
+    size_t *registers;           /**< Registers of a search */
+    size_t *scratch;             /**< Sources read by the operations of a transition */
+} rift_tdfa_t;
+
+/**
+ * @brief Build the tagged DFA of an NFA
+ *
+ * Fails with RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE when the NFA uses
+ * lookarounds or counted loops, and with RIFT_REGEX_ERROR_LIMIT_EXCEEDED when
+ * it has more than RIFT_TDFA_MAX_NFA_STATES states or its DFA would need more
+ * than RIFT_TDFA_MAX_STATES states or RIFT_TDFA_MAX_REGISTERS registers.
+ *
+ * @param nfa The NFA (a DFA is accepted as well)
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new tagged DFA or NULL on failure
+ */
+rift_tdfa_t *rift_tdfa_create(const rift_regex_automaton_t *nfa, rift_regex_error_t *error);
+
+/**
+ * @brief Free a tagged DFA
+ *
+ * @param tdfa The tagged DFA to free
+ */
+void rift_tdfa_free(rift_tdfa_t *tdfa);
+
+/**
+ * @brief Get the number of capture groups of a tagged DFA
+ *
+ * @param tdfa The tagged DFA
+ * @return Number of capture groups
+ */
+size_t rift_tdfa_get_group_count(const rift_tdfa_t *tdfa);
+
+/**
+ * @brief Get the number of capture slots filled by a search
+ *
+ * @param tdfa The tagged DFA
+ * @return Number of slots, two for the whole match and two per group
+ */
+size_t rift_tdfa_get_slot_count(const rift_tdfa_t *tdfa);
+
+/**
+ * @brief Search for a match starting at a position
+ *
+ * The search is always anchored. The longest match is reported, or the
+ * first one to end when earliest is set, with the slots rift_pike_vm_search()
+ * would report for it.
+ *
+ * @param tdfa The tagged DFA
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param start Position where the match must start
+ * @param earliest Whether to stop at the first match found
+ * @param slots Array of rift_tdfa_get_slot_count entries for the match (can be NULL)
+ * @return true if a match (possibly empty) was found, false otherwise
+ */
+bool rift_tdfa_search(rift_tdfa_t *tdfa, const char *input, size_t length, size_t start,
+                      bool earliest, size_t *slots);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_AUTOMATON_TDFA_H */
@@ -12,6 +12,7 @@
 #include <regex.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -30,17 +31,72 @@ extern "C" {
 struct rift_regex_pattern;
 typedef struct rift_regex_pattern rift_regex_pattern_t;
 
+/**
+ * @brief Kind of input predicate attached to a transition
+ */
+typedef enum rift_transition_predicate_kind {
+    RIFT_PREDICATE_NONE = 0, /**< Matches no input byte */
+    RIFT_PREDICATE_LITERAL,  /**< Matches a single byte */
+    RIFT_PREDICATE_ANY,      /**< Matches any byte except NUL */
+    RIFT_PREDICATE_CLASS     /**< Matches the bytes set in the bitmap */
+} rift_transition_predicate_kind_t;
+
+/**
+ * @brief Pre-parsed form of a transition pattern
+ *
+ * The bitmap is filled for every kind, so testing a byte is always a single
+ * bit test; the kind and literal only serve callers that want a fast path.
+ */
+typedef struct rift_transition_predicate {
+    rift_transition_predicate_kind_t kind; /**< Kind of predicate */
+    uint8_t literal;                       /**< Byte for RIFT_PREDICATE_LITERAL */
+    uint64_t bitmap[4];                    /**< 256-bit set of accepted bytes */
+} rift_transition_predicate_t;
+
 /* Type alias for the transition structure */
 typedef struct rift_regex_transition rift_regex_transition_t;
 struct rift_regex_transition {
-    struct rift_regex_state *from_state; /**< Source state */
-    struct rift_regex_state *to_state;   /**< Target state */
-    char *input_pattern;                 /**< Pattern that triggers this transition */
-    bool is_epsilon;                     /**< Whether this is an epsilon transition */
-    int priority;                        /**< Priority for deterministic resolution */
-    struct rift_regex_pattern *pattern;  /**< Associated regex pattern */
+    struct rift_regex_state *from_state;   /**< Source state */
+    struct rift_regex_state *to_state;     /**< Target state */
+    const char *input_pattern;             /**< Pattern text, kept for display and serialization */
+    bool owns_pattern;                     /**< Whether input_pattern is heap allocated */
+    bool is_epsilon;                       /**< Whether this is an epsilon transition */
+    int priority;                          /**< Priority for deterministic resolution */
+    rift_transition_predicate_t predicate; /**< Parsed form of input_pattern */
+    struct rift_regex_pattern *pattern;    /**< Associated regex pattern */
 };
 
+/**
+ * @brief Parse a transition pattern into a predicate
+ *
+ * Single bytes, escaped metacharacters, "." and bracket expressions are parsed
+ * directly. Any other pattern is compiled once with regcomp() and evaluated
+ * against every byte, which keeps the historical matching semantics.
+ *
+ * @param pattern The pattern to parse
+ * @param predicate Pointer to store the parsed predicate
+ * @return true if the pattern is valid, false otherwise (predicate matches nothing)
+ */
+bool rift_transition_predicate_parse(const char *pattern, rift_transition_predicate_t *predicate);
+
+/**
+ * @brief Test whether a predicate accepts a byte
+ *
+ * @param predicate The predicate
+ * @param byte The input byte
+ * @return true if the byte is accepted, false otherwise
+ */
+bool rift_transition_predicate_test(const rift_transition_predicate_t *predicate, uint8_t byte);
+
+/**
+ * @brief Get the parsed predicate of a transition
+ *
+ * @param transition The transition
+ * @return The predicate or NULL for epsilon transitions
+ */
+const rift_transition_predicate_t *
+rift_transition_get_predicate(const rift_regex_transition_t *transition);
+
 /**
  * @brief Create a transition between states
  *
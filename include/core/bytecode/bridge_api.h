@@ -4,6 +4,8 @@
  *
  * This file defines the abstract bridge API that serves as the interface
  * between the LibRift regex engine and platform-specific implementations.
+ * Native embedders can bypass the function table and its handles with the
+ * inline entry points of bridge_direct.h.
  *
  * @copyright Copyright (c) 2025 LibRift Project
  * @license MIT License
@@ -55,6 +57,10 @@ typedef int (*rift_bridge_run_bytecode_fn)(rift_bridge_context_t *context, const
                                            uint32_t *match_end);
 typedef int (*rift_bridge_reset_matcher_fn)(rift_bridge_context_t *context,
                                             rift_matcher_handle_t matcher_handle);
+typedef int (*rift_bridge_is_match_fn)(rift_bridge_context_t *context,
+                                       rift_matcher_handle_t matcher_handle);
+typedef uint32_t (*rift_bridge_count_fn)(rift_bridge_context_t *context,
+                                         rift_matcher_handle_t matcher_handle);
 
 /**
  * @brief Bridge API function table
@@ -77,6 +83,8 @@ typedef struct rift_bridge_api {
     rift_bridge_deserialize_pattern_fn deserialize_pattern;
     rift_bridge_run_bytecode_fn run_bytecode;
     rift_bridge_reset_matcher_fn reset_matcher;
+    rift_bridge_is_match_fn is_match; /**< Match existence only, no bounds or captures */
+    rift_bridge_count_fn count;       /**< Number of matches, no captures */
 } rift_bridge_api_t;
 
 /**
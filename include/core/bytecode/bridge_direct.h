@@ -0,0 +1,254 @@
+/**
+ * @file bridge_direct.h
+ * @brief Direct mode of the bridge API for native embedders
+ *
+ * Native embedders, such as the Python and Node bindings, run in the same
+ * address space as the engine and need neither the function table of
+ * rift_bridge_api_t nor its integer handles. In direct mode they hold the
+ * engine's patterns and matchers as opaque pointers and call the entry
+ * points below, which are inline and go straight to the matcher, so a call
+ * costs no table lookup, handle translation or match allocation.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_BRIDGE_DIRECT_H
+#define LIBRIFT_BRIDGE_DIRECT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "core/engine/pattern.h"
+#include "core/runtime/match_types.h"
+#include "core/runtime/matcher.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Pattern held by a direct mode embedder (opaque)
+ */
+typedef rift_regex_pattern_t rift_bridge_direct_pattern_t;
+
+/**
+ * @brief Matcher held by a direct mode embedder (opaque)
+ */
+typedef rift_regex_matcher_t rift_bridge_direct_matcher_t;
+
+/**
+ * @brief Spans collected by rift_bridge_direct_find_all
+ */
+typedef struct rift_bridge_direct_batch {
+    rift_regex_span_t *spans; /**< Receives the span of each match */
+    size_t max_matches;       /**< Number of entries in spans */
+    size_t count;             /**< Number of matches stored */
+} rift_bridge_direct_batch_t;
+
+/**
+ * @brief Compile a pattern
+ *
+ * @param pattern The pattern string
+ * @param flags Compilation flags, as for the compile entry of rift_bridge_api_t
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new pattern or NULL on failure
+ */
+static inline rift_bridge_direct_pattern_t *
+rift_bridge_direct_compile(const char *pattern, uint32_t flags, rift_regex_error_t *error)
+{
+    return rift_regex_compile(pattern, (rift_regex_flags_t)flags, error);
+}
+
+/**
+ * @brief Create a matcher for a pattern
+ *
+ * @param pattern The pattern, which must outlive the matcher
+ * @param options Matcher options, a combination of rift_matcher_option_t
+ * @return A new matcher or NULL on failure
+ */
+static inline rift_bridge_direct_matcher_t *
+rift_bridge_direct_create_matcher(const rift_bridge_direct_pattern_t *pattern, uint32_t options)
+{
+    return rift_matcher_create(pattern, (rift_matcher_option_t)options);
+}
+
+/**
+ * @brief Set the input of a matcher
+ *
+ * The input is not copied and must stay valid while the matcher uses it.
+ *
+ * @param matcher The matcher
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @return true if successful, false otherwise
+ */
+static inline bool
+rift_bridge_direct_set_input(rift_bridge_direct_matcher_t *matcher, const char *input,
+                             size_t length)
+{
+    return rift_matcher_set_input(matcher, input, length);
+}
+
+/**
+ * @brief Check whether the whole input matches
+ *
+ * @param matcher The matcher
+ * @return true if the entire input matches, false otherwise
+ */
+static inline bool
+rift_bridge_direct_matches(rift_bridge_direct_matcher_t *matcher)
+{
+    return rift_matcher_matches(matcher, NULL);
+}
+
+/**
+ * @brief Check whether the pattern matches anywhere in the input
+ *
+ * Computes neither the bounds nor the captures of the match; see
+ * rift_matcher_is_match.
+ *
+ * @param matcher The matcher
+ * @return true if the input has a match, false otherwise
+ */
+static inline bool
+rift_bridge_direct_is_match(rift_bridge_direct_matcher_t *matcher)
+{
+    return rift_matcher_is_match(matcher);
+}
+
+/**
+ * @brief Count the non-overlapping matches in the input
+ *
+ * Computes no captures; see rift_matcher_count.
+ *
+ * @param matcher The matcher
+ * @return Number of matches, 0 on invalid parameters
+ */
+static inline size_t
+rift_bridge_direct_count(rift_bridge_direct_matcher_t *matcher)
+{
+    return rift_matcher_count(matcher);
+}
+
+/**
+ * @brief Find the next match without building a match result
+ *
+ * @param matcher The matcher
+ * @param start_pos Pointer to store the match start (can be NULL)
+ * @param end_pos Pointer to store the match end (can be NULL)
+ * @return true if a match was found, false otherwise
+ */
+static inline bool
+rift_bridge_direct_find_next(rift_bridge_direct_matcher_t *matcher, size_t *start_pos,
+                             size_t *end_pos)
+{
+    rift_regex_span_t span;
+    if (!rift_matcher_find_next_spans(matcher, &span, 1, NULL)) {
+        return false;
+    }
+    if (start_pos) {
+        *start_pos = span.start;
+    }
+    if (end_pos) {
+        *end_pos = span.end;
+    }
+    return true;
+}
+
+/**
+ * @brief Find the next match and report it with its capture groups as spans
+ *
+ * See rift_matcher_find_next_spans for the layout of the spans.
+ *
+ * @param matcher The matcher
+ * @param spans Array to store the spans (can be NULL if max_spans is 0)
+ * @param max_spans Number of entries in spans
+ * @param num_spans Pointer to store the number of spans the match has (can be NULL)
+ * @return true if a match was found, false otherwise
+ */
+static inline bool
+rift_bridge_direct_find_next_spans(rift_bridge_direct_matcher_t *matcher, rift_regex_span_t *spans,
+                                   size_t max_spans, size_t *num_spans)
+{
+    return rift_matcher_find_next_spans(matcher, spans, max_spans, num_spans);
+}
+
+/**
+ * @brief Store one match of rift_bridge_direct_find_all
+ *
+ * @param spans The spans of the match
+ * @param num_spans Number of spans
+ * @param user_data The rift_bridge_direct_batch_t being filled
+ * @return false once the batch is full
+ */
+static inline bool
+rift_bridge_direct_collect(const rift_regex_span_t *spans, size_t num_spans, void *user_data)
+{
+    (void)num_spans;
+    rift_bridge_direct_batch_t *batch = (rift_bridge_direct_batch_t *)user_data;
+    batch->spans[batch->count++] = spans[0];
+    return batch->count < batch->max_matches;
+}
+
+/**
+ * @brief Find the non-overlapping matches in the whole input in one call
+ *
+ * @param matcher The matcher
+ * @param spans Array to store the span of each match
+ * @param max_matches Number of entries in spans
+ * @return Number of matches stored, 0 on invalid parameters
+ */
+static inline size_t
+rift_bridge_direct_find_all(rift_bridge_direct_matcher_t *matcher, rift_regex_span_t *spans,
+                            size_t max_matches)
+{
+    if (!spans || max_matches == 0) {
+        return 0;
+    }
+
+    rift_bridge_direct_batch_t batch = {spans, max_matches, 0};
+    if (!rift_matcher_for_each_match(matcher, rift_bridge_direct_collect, &batch)) {
+        return 0;
+    }
+    return batch.count;
+}
+
+/**
+ * @brief Reset a matcher to the start of its input
+ *
+ * @param matcher The matcher
+ */
+static inline void
+rift_bridge_direct_reset_matcher(rift_bridge_direct_matcher_t *matcher)
+{
+    rift_matcher_reset(matcher);
+}
+
+/**
+ * @brief Free a matcher
+ *
+ * @param matcher The matcher to free (can be NULL)
+ */
+static inline void
+rift_bridge_direct_free_matcher(rift_bridge_direct_matcher_t *matcher)
+{
+    rift_matcher_free(matcher);
+}
+
+/**
+ * @brief Free a pattern once its matchers are freed
+ *
+ * @param pattern The pattern to free (can be NULL)
+ */
+static inline void
+rift_bridge_direct_free_pattern(rift_bridge_direct_pattern_t *pattern)
+{
+    rift_regex_pattern_free(pattern);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_BRIDGE_DIRECT_H */
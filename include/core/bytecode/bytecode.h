@@ -40,14 +40,37 @@
      RIFT_OP_FAIL,        /* Fail the current path */
  
      /* Advanced operations */
-     RIFT_OP_REPEAT_START, /* Start of a repetition construct */
-     RIFT_OP_REPEAT_END,   /* End of a repetition construct */
-     RIFT_OP_BOUNDARY,     /* Word boundary assertion */
-     RIFT_OP_BACKREF,      /* Backreference to a previous capture */
-     RIFT_OP_LOOKAHEAD,    /* Positive lookahead assertion */
-     RIFT_OP_NEG_LOOKAHEAD /* Negative lookahead assertion */
+     RIFT_OP_REPEAT_START,  /* Enter a counted loop, resetting its counter */
+     RIFT_OP_REPEAT_END,    /* End an iteration of a counted loop, counting it */
+     RIFT_OP_BOUNDARY,      /* Word boundary assertion */
+     RIFT_OP_BACKREF,       /* Backreference to a previous capture */
+     RIFT_OP_LOOKAHEAD,     /* Positive lookahead assertion */
+     RIFT_OP_NEG_LOOKAHEAD, /* Negative lookahead assertion */
+ 
+     /* Superinstructions produced by rift_bytecode_optimize */
+     RIFT_OP_MATCH_STRING, /* Match a literal from the literal pool */
+     RIFT_OP_STAR_CLASS,   /* Match a character class zero or more times, greedily */
+ 
+     /* Table-driven matching produced by rift_bytecode_from_automaton */
+     RIFT_OP_DFA_SCAN, /* Consume the longest prefix a DFA table accepts */
+
+     /* Atomic groups and possessive quantifiers */
+     RIFT_OP_ATOMIC_START, /* Enter an atomic region */
+     RIFT_OP_CUT,          /* Leave it, dropping the backtrack points taken inside */
+
+     /* Guards on the edges of a counted loop */
+     RIFT_OP_REPEAT_AGAIN, /* Fail once the loop has run its maximum */
+     RIFT_OP_REPEAT_EXIT   /* Fail until the loop has run its minimum */
  } rift_bytecode_opcode_t;
  
+ /**
+  * @brief Number of 32-bit words in the bitmap of one character class
+  *
+  * Byte c belongs to a class when bit (c & 31) of word (c >> 5) of its
+  * bitmap is set.
+  */
+ #define RIFT_BYTECODE_CLASS_WORDS 8
+ 
  /**
   * @brief Single instruction in the LibRift bytecode
   */
@@ -55,12 +78,18 @@
      rift_bytecode_opcode_t opcode;
      union {
          char character;       /* For MATCH_CHAR */
-         uint32_t jump_target; /* For JUMP, SPLIT */
+         uint32_t jump_target; /* For JUMP, SPLIT; the REPEAT_START of REPEAT_END/AGAIN/EXIT */
          uint32_t group_index; /* For SAVE_START, SAVE_END, BACKREF */
-         struct {              /* For MATCH_CLASS */
+         uint32_t dfa_index;   /* For DFA_SCAN, row in dfa_tables */
+         struct {              /* For MATCH_CLASS, STAR_CLASS */
              char *class_pattern;
              uint32_t pattern_length;
+             uint32_t class_index; /* Bitmap row in char_class_map */
          } char_class;
+         struct { /* For MATCH_STRING */
+             uint32_t offset; /* First byte in literal_pool */
+             uint32_t length; /* Number of bytes */
+         } string;
          struct { /* For REPEAT_START */
              uint32_t min;
              uint32_t max; /* UINT32_MAX for unbounded */
@@ -69,6 +98,24 @@
      } operand;
  } rift_bytecode_instruction_t;
  
+ /**
+  * @brief Fixed-width 8-byte encoding of an instruction
+  *
+  * This is the form instructions take in serialized bytecode. Operands that do
+  * not fit are rows of side tables: the class table for MATCH_CLASS and
+  * STAR_CLASS, the literal table for MATCH_STRING and the repeat table for
+  * REPEAT_START. DFA_SCAN stores the index of its table. Other operands are
+  * stored directly.
+  */
+ typedef struct {
+     uint8_t opcode;      /* rift_bytecode_opcode_t */
+     uint8_t reserved[3]; /* Always zero */
+     uint32_t operand;    /* Character, jump target, group index, table or side table row */
+ } rift_bytecode_packed_t;
+ 
+ /* Forward declaration of the DFA table type (defined in core/automaton/dfa_table.h) */
+ struct rift_dfa_table;
+ 
  /**
   * @brief Collection of bytecode instructions representing a compiled pattern
   */
@@ -78,8 +125,14 @@
      uint32_t capacity;
      uint32_t group_count;
      rift_regex_flags_t flags;
-     char *original_pattern;   /* For debugging */
-     uint32_t *char_class_map; /* Optimized character class lookup */
+     char *original_pattern;             /* For debugging */
+     uint32_t *char_class_map;           /* Class bitmaps, RIFT_BYTECODE_CLASS_WORDS words each */
+     uint32_t char_class_count;          /* Number of bitmaps in char_class_map */
+     char *literal_pool;                 /* Bytes of the MATCH_STRING literals */
+     uint32_t literal_pool_size;         /* Number of bytes in literal_pool */
+     struct rift_dfa_table **dfa_tables; /* Tables of the DFA_SCAN instructions, owned */
+     uint32_t dfa_table_count;           /* Number of tables in dfa_tables */
+     bool verified;                      /* Proven valid by rift_bytecode_validate */
  } rift_bytecode_program_t;
  
  /**
@@ -179,6 +232,19 @@
  uint32_t rift_swap_endian32(uint32_t value, rift_endian_marker_t source_endian,
                              rift_endian_marker_t target_endian);
  
+ /**
+  * @brief Reverse the byte order of every value in an array of 32-bit values
+  *
+  * Images are written in the writer's byte order, so this only runs when an
+  * image is loaded on a machine of the other one, once per fixed-width section
+  * rather than once per field. The loop is simple enough for the compiler to
+  * vectorize.
+  *
+  * @param values The values, swapped in place
+  * @param count Number of values
+  */
+ void rift_swap_endian32_array(uint32_t *values, size_t count);
+ 
  /**
   * @brief Create bytecode program with proper platform adjustments
   *
@@ -193,6 +259,13 @@
  /**
   * @brief Validate a bytecode program
   *
+  * Checks every opcode, jump target, counted-loop start, group index, literal
+  * and DFA table, and marks the program verified when all are valid. The VM
+  * decodes a verified program without checking them again. Adding
+  * instructions or changing jump targets, group operands or the group count
+  * through the program functions clears the mark; a program changed in place
+  * otherwise must be validated again before it is run.
+  *
   * @param program Bytecode program to validate
   * @param error Error information (can be NULL)
   * @return bool True if valid, false otherwise
@@ -202,6 +275,8 @@
  /**
   * @brief Optimize a bytecode program
   *
+  * Runs the passes of rift_bytecode_peephole_optimize after validation.
+  *
   * @param program Bytecode program to optimize
   * @param error Error information (can be NULL)
   * @return bool True if optimization was successful, false otherwise
@@ -23,6 +23,15 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Time spent in each stage of rift_bytecode_compile_timed
+ */
+typedef struct rift_bytecode_compile_timings {
+    uint64_t pattern_ns;  /**< Parsing, building the AST and the automaton */
+    uint64_t counters_ns; /**< Rebuilding an NFA with counted repeats */
+    uint64_t codegen_ns;  /**< Generating and optimizing the instructions */
+} rift_bytecode_compile_timings_t;
+
 /**
  * @brief Compile a regex automaton into bytecode
  *
@@ -46,6 +55,22 @@ rift_bytecode_program_t *rift_bytecode_from_automaton(rift_regex_automaton_t *au
 rift_bytecode_program_t *rift_bytecode_compile(const char *pattern, rift_regex_flags_t flags,
                                                rift_regex_error_t *error);
 
+/**
+ * @brief Compile a regex pattern string into bytecode, timing each stage
+ *
+ * The stages' times are added to timings, so one structure can sum the
+ * stages over many patterns.
+ *
+ * @param pattern The pattern string to compile
+ * @param flags Compilation flags
+ * @param timings Times to add the stages to (can be NULL)
+ * @param error Error information (can be NULL)
+ * @return Compiled bytecode program or NULL on failure
+ */
+rift_bytecode_program_t *rift_bytecode_compile_timed(const char *pattern, rift_regex_flags_t flags,
+                                                     rift_bytecode_compile_timings_t *timings,
+                                                     rift_regex_error_t *error);
+
 /**
  * @brief Free a bytecode program
  *
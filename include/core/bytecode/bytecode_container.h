@@ -0,0 +1,247 @@
+/**
+ * @file bytecode_container.h
+ * @brief Memory-mappable container of precompiled bytecode programs for LibRift
+ *
+ * This file defines a sectioned file format holding any number of programs.
+ * Sections are aligned so a loader can run programs straight from a mapping
+ * of the file instead of copying them out first. Single programs that need
+ * to cross byte orders should use rift_bytecode_serialize instead.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+ #ifndef LIBRIFT_BYTECODE_CONTAINER_H
+ #define LIBRIFT_BYTECODE_CONTAINER_H
+ 
+ #include <stdbool.h>
+ #include <stddef.h>
+ #include <stdint.h>
+ 
+ #include "core/bytecode/bytecode.h"
+ #include "core/errors/regex_error.h"
+ 
+ #ifdef __cplusplus
+ extern "C" {
+ #endif
+ 
+ /**
+  * @brief Magic number of a container file ("RFTC" in ASCII)
+  */
+ #define RIFT_BYTECODE_CONTAINER_MAGIC 0x52465443
+ 
+ /**
+  * @brief Container format version, 2 gives REPEAT_END the index of its REPEAT_START
+  */
+ #define RIFT_BYTECODE_CONTAINER_VERSION 2
+ 
+ /**
+  * @brief Alignment of every section from the start of the file, in bytes
+  */
+ #define RIFT_BYTECODE_CONTAINER_ALIGNMENT 64
+ 
+ /**
+  * @brief Section types of a container
+  */
+ typedef enum {
+     RIFT_BYTECODE_SECTION_INDEX = 1,        /* One rift_bytecode_container_entry_t per program */
+     RIFT_BYTECODE_SECTION_INSTRUCTIONS = 2, /* rift_bytecode_packed_t of every program */
+     RIFT_BYTECODE_SECTION_OPERANDS = 3,     /* 32-bit literal and repeat operand rows */
+     RIFT_BYTECODE_SECTION_CLASSES = 4,      /* Class bitmaps, RIFT_BYTECODE_CLASS_WORDS each */
+     RIFT_BYTECODE_SECTION_STRINGS = 5,      /* Literal pools and NUL-terminated patterns */
+     RIFT_BYTECODE_SECTION_DFA_TABLES = 6    /* Transition tables of table-driven programs */
+ } rift_bytecode_section_type_t;
+ 
+ /**
+  * @brief Fixed header at the start of a container
+  *
+  * The checksum is the 32-bit FNV-1a hash of every byte after the header.
+  */
+ typedef struct {
+     uint32_t magic;         /* RIFT_BYTECODE_CONTAINER_MAGIC */
+     uint32_t endianness;    /* rift_endian_marker_t of the writer */
+     uint32_t version;       /* RIFT_BYTECODE_CONTAINER_VERSION */
+     uint32_t checksum;      /* FNV-1a of the bytes after the header */
+     uint32_t section_count; /* Entries in the section directory after the header */
+     uint32_t program_count; /* Entries in the index section */
+     uint64_t file_size;     /* Size of the whole container in bytes */
+ } rift_bytecode_container_header_t;
+ 
+ /**
+  * @brief Section directory entry
+  */
+ typedef struct {
+     uint32_t type;     /* rift_bytecode_section_type_t */
+     uint32_t reserved; /* Always zero */
+     uint64_t offset;   /* From the start of the file, a multiple of the alignment */
+     uint64_t size;     /* In bytes */
+ } rift_bytecode_section_t;
+ 
+ /**
+  * @brief Index entry of one program
+  *
+  * Offsets count elements of their section: instructions, operand words,
+  * class bitmaps or bytes.
+  */
+ typedef struct {
+     uint32_t flags;             /* Compilation flags */
+     uint32_t group_count;       /* Number of capture groups */
+     uint32_t instruction_first; /* First instruction in the instructions section */
+     uint32_t instruction_count; /* Number of instructions */
+     uint32_t operand_first;     /* First word in the operands section */
+     uint32_t operand_count;     /* Number of operand words */
+     uint32_t class_first;       /* First bitmap in the classes section */
+     uint32_t class_count;       /* Number of class bitmaps */
+     uint32_t literal_offset;    /* First byte of the literal pool in the strings section */
+     uint32_t literal_size;      /* Number of bytes in the literal pool */
+     uint32_t pattern_offset;    /* First byte of the pattern in the strings section */
+     uint32_t pattern_length;    /* Pattern length without terminator, UINT32_MAX if none */
+     uint32_t dfa_offset;        /* First byte of the program's tables in the DFA section */
+     uint32_t dfa_size;          /* Number of bytes of DFA tables, 0 if none */
+ } rift_bytecode_container_entry_t;
+ 
+ /**
+  * @brief Loaded container (opaque)
+  */
+ typedef struct rift_bytecode_container rift_bytecode_container_t;
+ 
+ /**
+  * @brief Write programs into a container
+  *
+  * Programs whose classes have no bitmap rows get them first, as with
+  * rift_bytecode_serialize. Equal instruction streams, operand rows, class
+  * tables, strings and DFA tables are written once and shared between the
+  * index entries of the programs that have them.
+  *
+  * @param programs Programs to write, in index order
+  * @param count Number of programs
+  * @param data Output buffer (can be NULL to get size)
+  * @param size Size of output buffer or pointer to store required size
+  * @return true if successful, false otherwise
+  */
+ bool rift_bytecode_container_write(rift_bytecode_program_t *const *programs, uint32_t count,
+                                    uint8_t *data, size_t *size);
+ 
+ /**
+  * @brief Load a container from memory without copying it
+  *
+  * The header, checksum, section directory and index are validated here.
+  * The memory must stay valid and unchanged until the container is closed.
+  *
+  * @param data Container bytes, aligned to at least 8 bytes
+  * @param size Size of the container bytes
+  * @param error Error information (can be NULL)
+  * @return The loaded container or NULL on failure
+  */
+ rift_bytecode_container_t *rift_bytecode_container_load(const uint8_t *data, size_t size,
+                                                         rift_regex_error_t *error);
+ 
+ /**
+  * @brief Map a container file and load it
+  *
+  * @param path Path of the container file
+  * @param error Error information (can be NULL)
+  * @return The loaded container or NULL on failure
+  */
+ rift_bytecode_container_t *rift_bytecode_container_open(const char *path,
+                                                         rift_regex_error_t *error);
+ 
+ /**
+  * @brief Write programs into a shared-memory segment for pre-fork servers
+ *
+ * The container is written as by rift_bytecode_container_write into a new
+ * segment, which then refuses further writes: an anonymous segment is a
+ * sealed memfd, a named one loses its write permission. Being offset-based,
+ * the container needs no relocation, so every process that attaches the
+ * segment reads the same physical pages and the tables cost their memory
+ * once whatever the number of workers.
+ *
+ * A pre-fork server shares the container before forking and has each worker
+ * attach the inherited descriptor, or the name, after the fork. Attaching
+ * before forking also works; calling rift_bytecode_container_program for
+ * every index first then shares the unpacked instructions copy-on-write.
+ *
+ * @param programs Programs to write, in index order
+ * @param count Number of programs
+ * @param name Name of a POSIX shared-memory object to create ("/name"), or NULL
+ *             for an anonymous segment reachable through the descriptor only
+ * @param error Error information (can be NULL)
+ * @return A descriptor of the segment, to be closed by the caller, or -1 on failure
+ */
+int rift_bytecode_container_share(rift_bytecode_program_t *const *programs, uint32_t count,
+                                  const char *name, rift_regex_error_t *error);
+
+/**
+ * @brief Map a shared container segment read-only and load it
+ *
+ * The container is validated as by rift_bytecode_container_load. The
+ * descriptor can be closed once attached.
+ *
+ * @param fd Descriptor returned by rift_bytecode_container_share, or inherited from it
+ * @param error Error information (can be NULL)
+ * @return The loaded container or NULL on failure
+ */
+rift_bytecode_container_t *rift_bytecode_container_attach(int fd, rift_regex_error_t *error);
+
+/**
+ * @brief Map a named shared container segment read-only and load it
+ *
+ * @param name Name given to rift_bytecode_container_share
+ * @param error Error information (can be NULL)
+ * @return The loaded container or NULL on failure
+ */
+rift_bytecode_container_t *rift_bytecode_container_attach_name(const char *name,
+                                                               rift_regex_error_t *error);
+
+/**
+ * @brief Remove the name of a shared container segment
+ *
+ * Containers already attached stay valid; the segment is freed when the last
+ * of them is closed and the last descriptor of it is closed.
+ *
+ * @param name Name given to rift_bytecode_container_share
+ * @return true if the name was removed
+ */
+bool rift_bytecode_container_unshare(const char *name);
+
+/**
+ * @brief Get the number of programs in a container
+  *
+  * @param container The container
+  * @return Number of programs, 0 for NULL
+  */
+ uint32_t rift_bytecode_container_count(const rift_bytecode_container_t *container);
+ 
+ /**
+  * @brief Get a program of a container
+  *
+  * The first call for an index unpacks its instructions. Indices whose
+  * index entries are equal get the same program. Class bitmaps,
+  * literals, DFA tables and the pattern are used in place. The program belongs to the
+  * container: it must not be modified, optimized or freed, and it stays valid
+  * until rift_bytecode_container_close. Safe to call from several threads.
+  *
+  * @param container The container
+  * @param index Index of the program
+  * @param error Error information (can be NULL)
+  * @return The program or NULL on failure
+  */
+ rift_bytecode_program_t *rift_bytecode_container_program(rift_bytecode_container_t *container,
+                                                          uint32_t index,
+                                                          rift_regex_error_t *error);
+ 
+ /**
+  * @brief Close a container, freeing its programs and unmapping its file or segment
+  *
+  * The programs are evicted from the calling thread's VM pool; pools of other
+  * threads that ran them must be evicted on those threads.
+  *
+  * @param container Container to close (can be NULL)
+  */
+ void rift_bytecode_container_close(rift_bytecode_container_t *container);
+ 
+ #ifdef __cplusplus
+ }
+ #endif
+ 
+ #endif /* LIBRIFT_BYTECODE_CONTAINER_H */
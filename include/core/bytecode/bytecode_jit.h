@@ -0,0 +1,93 @@
+/**
+ * @file bytecode_jit.h
+ * @brief Native code compilation of bytecode programs for LibRift
+ *
+ * This file defines an optional execution mode that translates a bytecode
+ * program into machine code once and runs it directly. Programs or platforms
+ * the JIT does not support run in the interpreter instead.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+ #ifndef LIBRIFT_BYTECODE_JIT_H
+ #define LIBRIFT_BYTECODE_JIT_H
+ 
+ #include <stdbool.h>
+ #include <stddef.h>
+ #include <stdint.h>
+ 
+ #include "core/bytecode/bytecode.h"
+ #include "core/bytecode/bytecode_vm.h"
+ #include "core/errors/regex_error.h"
+ 
+ #ifdef __cplusplus
+ extern "C" {
+ #endif
+ 
+ /**
+  * @brief Program compiled to native code
+  */
+ typedef struct rift_bytecode_jit {
+     const rift_bytecode_program_t *program; /* Program the code was compiled from */
+     void *code;                             /* Executable mapping holding the code */
+     size_t code_size;                       /* Size of the mapping in bytes */
+     uint32_t *classes;                      /* Class bitmaps the code refers to */
+     uint32_t capture_count;                 /* Captures the code writes, including the match */
+ } rift_bytecode_jit_t;
+ 
+ /**
+  * @brief Check whether the JIT can generate code on this platform
+  *
+  * Only x86-64 has a code generator for now.
+  *
+  * @return true if rift_bytecode_jit_compile can succeed
+  */
+ bool rift_bytecode_jit_available(void);
+ 
+ /**
+  * @brief Compile a program to native code
+  *
+  * MATCH_CHAR, MATCH_STRING, MATCH_ANY, MATCH_CLASS, STAR_CLASS, JUMP,
+  * SPLIT, SAVE_START, SAVE_END, ACCEPT, FAIL and NOP are supported. A
+  * program using any other opcode, such as LOOKAHEAD, fails with
+  * RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE and should run in the interpreter.
+  * The program must not be modified or freed while the result is in use.
+  *
+  * @param program The program to compile
+  * @param error Pointer to store error information (can be NULL)
+  * @return The compiled program or NULL on failure
+  */
+ rift_bytecode_jit_t *rift_bytecode_jit_compile(const rift_bytecode_program_t *program,
+                                                rift_regex_error_t *error);
+ 
+ /**
+  * @brief Execute a program through its native code
+  *
+  * Behaves like rift_bytecode_execute, which it falls back to when jit is
+  * NULL or compiled from another program, and when the native run exhausts
+  * its budget, so the interpreter's bit-state mode can still finish it. The
+  * budget of the native code counts backward jumps and backtracks rather
+  * than every instruction.
+  *
+  * @param jit Compiled program (can be NULL)
+  * @param program Bytecode program to execute
+  * @param vm VM instance to use, its captures receive the groups
+  * @param match Output match result (can be NULL)
+  * @return true if pattern matched, false otherwise
+  */
+ bool rift_bytecode_jit_execute(const rift_bytecode_jit_t *jit, rift_bytecode_program_t *program,
+                                rift_bytecode_vm_t *vm, rift_regex_match_t *match);
+ 
+ /**
+  * @brief Free a compiled program
+  *
+  * @param jit Compiled program to free (can be NULL)
+  */
+ void rift_bytecode_jit_free(rift_bytecode_jit_t *jit);
+ 
+ #ifdef __cplusplus
+ }
+ #endif
+ 
+ #endif /* LIBRIFT_BYTECODE_JIT_H */
@@ -0,0 +1,48 @@
+/**
+ * @file bytecode_optimizer.h
+ * @brief Peephole optimizer for LibRift bytecode programs
+ *
+ * This file defines the optimization pipeline run by rift_bytecode_optimize.
+ * It rewrites a program in place so the VM dispatches fewer instructions.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_BYTECODE_OPTIMIZER_H
+#define LIBRIFT_BYTECODE_OPTIMIZER_H
+
+#include <stdbool.h>
+#include "core/bytecode/bytecode.h"
+#include "core/errors/regex_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Run the peephole passes over a bytecode program
+ *
+ * The passes, in order:
+ * - a SPLIT, MATCH_CLASS, JUMP loop becomes one greedy STAR_CLASS
+ * - a run of two or more MATCH_CHAR becomes one MATCH_STRING
+ * - a jump to a JUMP goes straight to the final target
+ * - instructions no path from the first one reaches are dropped, which
+ *   covers code after ACCEPT and FAIL
+ * - a JUMP to the next instruction that is not a NOP is dropped
+ * - NOPs are removed and jump targets renumbered
+ *
+ * Instructions inside a fused sequence must not be jump targets. The
+ * program must be valid (see rift_bytecode_validate). On failure the
+ * program is left valid but possibly only partly optimized.
+ *
+ * @param program The program to optimize
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false on allocation failure
+ */
+bool rift_bytecode_peephole_optimize(rift_bytecode_program_t *program, rift_regex_error_t *error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_BYTECODE_OPTIMIZER_H */
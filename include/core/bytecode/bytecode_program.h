@@ -11,6 +11,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include "core/automaton/dfa_table.h"
 #include "core/bytecode/bytecode.h"
 #include "core/errors/regex_error.h"
 #ifndef RIFT_BYTECODE_PROGRAM_H
@@ -66,6 +67,9 @@ rift_bytecode_program_set_char_operand(rift_bytecode_program_t *program, int32_t
 /**
  * @brief Set a character class operand for an instruction
  *
+ * The bitmap of the class is added to the program's class table and the
+ * instruction refers to it by class_index.
+ *
  * @param program The bytecode program
  * @param index The instruction index
  * @param class_pattern The character class pattern
@@ -76,6 +80,40 @@ bool
 rift_bytecode_program_set_class_operand(rift_bytecode_program_t *program, int32_t index,
 										const char *class_pattern, uint32_t pattern_length);
 
+/**
+ * @brief Add a character class bitmap to the program's class table
+ *
+ * A class already in the table is not added twice.
+ *
+ * @param program The bytecode program
+ * @param bitmap RIFT_BYTECODE_CLASS_WORDS words, bit c set for each member byte c
+ * @return The row of the class in char_class_map or -1 on failure
+ */
+int32_t
+rift_bytecode_program_add_class(rift_bytecode_program_t *program, const uint32_t *bitmap);
+
+/**
+ * @brief Add a DFA table to the program for DFA_SCAN instructions
+ *
+ * @param program The bytecode program
+ * @param table The table, owned by the program on success
+ * @return The index of the table in dfa_tables or -1 on failure
+ */
+int32_t
+rift_bytecode_program_add_dfa_table(rift_bytecode_program_t *program, rift_dfa_table_t *table);
+
+/**
+ * @brief Rebuild the class table from the MATCH_CLASS and STAR_CLASS instructions
+ *
+ * Each instruction's bitmap comes from its class pattern, or from its current
+ * row when it has no pattern. Rows no instruction refers to are dropped.
+ *
+ * @param program The bytecode program
+ * @return true if successful, false on allocation failure
+ */
+bool
+rift_bytecode_program_build_class_map(rift_bytecode_program_t *program);
+
 /**
  * @brief Set a jump target for an instruction
  *
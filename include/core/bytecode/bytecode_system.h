@@ -30,8 +30,8 @@
 extern "C" {
 #endif
 
-/* Bytecode format version */
-#define BYTECODE_FORMAT_VERSION 1
+/* Bytecode format version, 5 adds the DFA tables */
+#define BYTECODE_FORMAT_VERSION 5
 
 /* Magic number for bytecode serialization format */
 #define BYTECODE_MAGIC 0x52494654 /* "RIFT" in ASCII */
@@ -49,6 +49,12 @@ typedef struct {
     uint32_t instruction_count; /* Number of instructions */
     uint32_t group_count;       /* Number of capture groups */
     uint32_t pattern_length;    /* Length of original pattern string */
+    uint32_t class_count;       /* Number of character class bitmaps */
+    uint32_t repeat_count;      /* Number of repeat table rows */
+    uint32_t literal_count;     /* Number of literal table rows */
+    uint32_t literal_pool_size; /* Number of bytes in the literal pool */
+    uint32_t dfa_table_count;   /* Number of DFA tables */
+    uint32_t dfa_table_size;    /* Number of bytes of DFA table encodings */
 } bytecode_header_t;
 
 /**
@@ -20,11 +20,35 @@
  #include "core/bytecode/bytecode.h"
  #include "core/errors/regex_error.h"
  #include "core/engine/match_types.h"
+ #include "core/runtime/execution_tracker.h"
+#include "core/runtime/trace_buffer.h"
  
  #ifdef __cplusplus
  extern "C" {
  #endif
  
+ /* Default largest visited bitmap, in bits, for the bit-state mode */
+ #define RIFT_BYTECODE_VM_BIT_STATE_BITS (256 * 1024)
+ 
+ /* Most groups the BACKREFs of a program may refer to for its runs to be memoized */
+ #define RIFT_BYTECODE_VM_MEMO_GROUPS 4
+ 
+ /**
+  * @brief Instruction decoded for dispatch
+  *
+  * With computed goto, op is the offset of the instruction's handler from the
+  * first handler in the interpreter loop; otherwise it is the opcode, or a
+  * decoder marker, selecting the handler in a switch. The operand is the
+  * character (MATCH_CHAR), group index (SAVE_START, SAVE_END, BACKREF, whose
+  * top bit asks for a case-insensitive comparison), class bitmap row
+  * (MATCH_CLASS) or jump target clamped to the program end (JUMP, SPLIT), so
+  * the loop never reads the instruction itself.
+  */
+ typedef struct rift_bytecode_decoded {
+     int32_t op;       /* Handler offset (threaded dispatch) or opcode (switch dispatch) */
+     uint32_t operand; /* Single operand of the instruction */
+ } rift_bytecode_decoded_t;
+
  /**
   * @brief Bytecode virtual machine state
   */
@@ -36,10 +60,51 @@
      uint32_t stack_capacity;      /* Capacity of backtrack stack */
      uint32_t *backtrack_stack;    /* Stack for backtracking information */
      uint32_t capture_count;       /* Number of capture groups (including full match) */
+     uint32_t capture_capacity;    /* Number of groups captures has room for */
      uint32_t *captures;           /* Capture group positions (start,end pairs) */
      bool timed_out;               /* Whether execution timed out */
      uint64_t max_instructions;    /* Maximum number of instructions to execute */
      uint64_t instruction_counter; /* Number of instructions executed */
+     uint64_t backtrack_pushes;    /* Backtrack frames pushed by the last execution */
+     uint64_t backtrack_pops;      /* Backtrack frames resumed by the last execution */
+     uint32_t max_stack_size;      /* Largest stack_size of the last execution */
+     uint32_t frame_words;         /* Words per backtrack frame of the last execution */
+    rift_trace_buffer_t *trace;   /* Buffer recording executions, or NULL */
+
+     /* Bit-state mode: (instruction, position) pairs already explored */
+     uint32_t *visited;        /* Bitmap of (instruction_count + 1) * (input_length + 1) bits */
+     size_t visited_capacity;  /* Capacity of visited in words */
+     size_t bit_state_limit;   /* Largest bitmap in bits, 0 disables the mode */
+     bool bit_state;           /* Whether the last execution ran in bit-state mode */
+ 
+     /* With backreferences, visited holds a table of explored (instruction, position, spans) */
+     uint32_t memo_words; /* Words per entry of the last execution, 0 if it was not memoized */
+     size_t memo_mask;    /* Entries in the table minus one */
+     size_t memo_free;    /* Entries that may still be added */
+
+     /* Program decoded for dispatch, rebuilt when another program is executed */
+     const rift_bytecode_program_t *decoded_program;    /* Program decoded below */
+     const rift_bytecode_instruction_t *decoded_source; /* Instructions decoded from */
+     rift_bytecode_decoded_t *decoded;                  /* Instructions plus end marker */
+     uint32_t decoded_count;                            /* Number of decoded instructions */
+     uint32_t decoded_capacity;                         /* Capacity of decoded */
+     bool decoded_has_backref;                          /* Whether the program has BACKREF */
+     bool decoded_has_cut;                              /* Whether the program has CUT */
+     uint32_t decoded_backref_groups[RIFT_BYTECODE_VM_MEMO_GROUPS]; /* Groups BACKREF uses */
+     uint32_t decoded_backref_group_count; /* Number of them, above the maximum if more */
+     uint32_t decoded_features;                         /* Run features the program uses */
+     const int32_t *decoded_handlers;                   /* Handlers of the loop decoded for */
+
+     /* Counters of the decoded program's counted loops, one per REPEAT_START */
+     uint32_t *counters;        /* Iterations of each loop, saved in every backtrack frame */
+     uint32_t *counter_bounds;  /* Minimum and maximum of each loop */
+     uint32_t counter_count;    /* Number of counted loops */
+     uint32_t counter_capacity; /* Capacity of counters in loops */
+
+     /* Class bitmaps of the decoded program, including those built from class patterns */
+     const uint32_t *decoded_class_source; /* Class table decoded from */
+     uint32_t *decoded_classes;            /* RIFT_BYTECODE_CLASS_WORDS words per row */
+     uint32_t decoded_class_capacity;      /* Capacity of decoded_classes in rows */
  };
  
  /**
@@ -67,9 +132,52 @@
   */
  void rift_bytecode_vm_reset(rift_bytecode_vm_t *vm);
  
+ /**
+  * @brief Rebind a VM to a program and input for reuse
+  *
+  * The backtrack stack, capture and decode buffers are kept, and only grown
+  * when the program needs more, so a VM bound again and again stops
+  * allocating. The execution limits are kept as well.
+  *
+  * @param vm The VM instance to rebind
+  * @param program Bytecode program to execute
+  * @param input Input string to match against
+  * @param input_length Length of input string or (size_t)-1 to use strlen
+  * @return true if successful, false on invalid parameters or allocation failure
+  */
+ bool rift_bytecode_vm_bind(rift_bytecode_vm_t *vm, rift_bytecode_program_t *program,
+                            const char *input, size_t input_length);
+ 
  /**
   * @brief Execute bytecode program on the given VM
   *
+  * The program is decoded once per VM and then run by a direct-threaded
+  * loop where the compiler supports computed goto, or by a switch
+  * otherwise. The instruction budget is checked on backward jumps and on
+  * backtracking, the only ways to execute an instruction twice, so a run may
+  * exceed max_instructions by at most the program length. A program must not
+  * be modified in place while a VM still uses it.
+  *
+  * Several loops are generated, each for a set of features: captures,
+  * counted loops, atomic groups, an instruction budget and tracing. A run
+  * takes the leanest loop covering the features its program uses and its VM
+  * sets (a max_instructions of UINT64_MAX means no budget), so a filter
+  * pattern without groups neither saves captures in its backtrack frames
+  * nor checks features it lacks.
+  *
+  * When the program has no BACKREF and its visited bitmap fits under
+  * bit_state_limit, the run is memoized, as in RE2's BitState: a jump or
+  * backtrack to an (instruction, position) pair already explored fails at
+  * once. Later paths to a pair can only match the same way the first one
+  * did, so the match and its captures are unchanged, but each pair is
+  * explored once and catastrophic patterns run in polynomial time.
+  *
+  * A program with BACKREFs to at most RIFT_BYTECODE_VM_MEMO_GROUPS groups is
+  * memoized on the instruction, the position and the spans of those groups,
+  * in a hash table within the same size limit; once the table fills up, the
+  * run goes on with the entries it has. BACKREF compares spans with memcmp,
+  * ignoring ASCII case when the program is RIFT_REGEX_FLAG_CASE_INSENSITIVE.
+  *
   * @param program Bytecode program to execute
   * @param vm VM instance to use
   * @param match Output match result (can be NULL)
@@ -91,6 +199,14 @@
                                                           const char *input, size_t input_length,
                                                           uint64_t max_instructions);
  
+ /**
+  * @brief Set the largest visited bitmap for the bit-state mode
+  *
+  * @param vm The VM instance
+  * @param max_bits Largest bitmap in bits, 0 to always backtrack without memoization
+  */
+ void rift_bytecode_vm_set_bit_state_limit(rift_bytecode_vm_t *vm, size_t max_bits);
+ 
  /**
   * @brief Check if VM execution timed out
   *
@@ -99,6 +215,19 @@
   */
  bool rift_bytecode_vm_timed_out(const rift_bytecode_vm_t *vm);
  
+ /**
+  * @brief Get the telemetry of the last execution
+  *
+  * Steps are the instructions executed and the stack depth is counted in
+  * frames. The counters are kept by every execution; they cost an addition
+  * per backtrack frame, next to the copy of the frame itself.
+  *
+  * @param vm The VM instance to query
+  * @param stats Pointer to store the counters
+  * @return true if successful, false otherwise
+  */
+ bool rift_bytecode_vm_get_stats(const rift_bytecode_vm_t *vm, rift_match_stats_t *stats);
+ 
  /**
   * @brief Get capture group positions
   *
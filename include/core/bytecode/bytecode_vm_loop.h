@@ -0,0 +1,390 @@
+/**
+ * @file bytecode_vm_loop.h
+ * @brief Interpreter loop template of the bytecode virtual machine for LibRift
+ *
+ * This file is not a regular header: bytecode_vm.c includes it once per
+ * entry of its VM_LOOPS list, with VM_LOOP_NAME naming the function to
+ * generate and VM_LOOP_FEATURES the run features it handles. Handlers and
+ * checks for the other features are left out, so a program using none of
+ * them runs a loop without their cost; their opcodes decode as invalid.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#if !defined(VM_LOOP_NAME) || !defined(VM_LOOP_FEATURES)
+#error "bytecode_vm_loop.h is included by bytecode_vm.c with VM_LOOP_NAME and VM_LOOP_FEATURES"
+#endif
+
+/**
+ * @brief Execute bytecode program with the loop generated for VM_LOOP_FEATURES
+ *
+ * @param program Bytecode program to execute, using no feature the loop lacks
+ * @param vm VM state for execution
+ * @param match Match information to fill (can be NULL)
+ * @return true if the program matched, false otherwise
+ */
+static bool
+VM_LOOP_NAME(rift_bytecode_program_t *program, rift_bytecode_vm_t *vm, rift_regex_match_t *match)
+{
+#if RIFT_BYTECODE_VM_THREADED
+    /* Handlers are stored as offsets from the first one to keep decoded instructions small */
+    static const int32_t handlers[VM_OPCODE_COUNT] = {
+        [RIFT_OP_NOP] = &&op_NOP - &&op_NOP,
+        [RIFT_OP_MATCH_CHAR] = &&op_MATCH_CHAR - &&op_NOP,
+        [RIFT_OP_MATCH_CLASS] = &&op_MATCH_CLASS - &&op_NOP,
+        [RIFT_OP_JUMP] = &&op_JUMP - &&op_NOP,
+        [RIFT_OP_SPLIT] = &&op_SPLIT - &&op_NOP,
+        [RIFT_OP_MATCH_ANY] = &&op_MATCH_ANY - &&op_NOP,
+        [RIFT_OP_ACCEPT] = &&op_ACCEPT - &&op_NOP,
+        [RIFT_OP_FAIL] = &&op_FAIL - &&op_NOP,
+        [RIFT_OP_BOUNDARY] = &&op_BOUNDARY - &&op_NOP,
+        [RIFT_OP_LOOKAHEAD] = &&op_LOOKAHEAD - &&op_NOP,
+        [RIFT_OP_NEG_LOOKAHEAD] = &&op_NEG_LOOKAHEAD - &&op_NOP,
+        [RIFT_OP_MATCH_STRING] = &&op_MATCH_STRING - &&op_NOP,
+        [RIFT_OP_STAR_CLASS] = &&op_STAR_CLASS - &&op_NOP,
+        [RIFT_OP_DFA_SCAN] = &&op_DFA_SCAN - &&op_NOP,
+#if VM_LOOP_FEATURES & VM_FEATURE_CAPTURES
+        [RIFT_OP_SAVE_START] = &&op_SAVE_START - &&op_NOP,
+        [RIFT_OP_SAVE_END] = &&op_SAVE_END - &&op_NOP,
+        [RIFT_OP_BACKREF] = &&op_BACKREF - &&op_NOP,
+#else
+        [RIFT_OP_SAVE_START] = &&op_invalid - &&op_NOP,
+        [RIFT_OP_SAVE_END] = &&op_invalid - &&op_NOP,
+        [RIFT_OP_BACKREF] = &&op_invalid - &&op_NOP,
+#endif
+#if VM_LOOP_FEATURES & VM_FEATURE_COUNTERS
+        [RIFT_OP_REPEAT_START] = &&op_REPEAT_START - &&op_NOP,
+        [RIFT_OP_REPEAT_END] = &&op_REPEAT_END - &&op_NOP,
+        [RIFT_OP_REPEAT_AGAIN] = &&op_REPEAT_AGAIN - &&op_NOP,
+        [RIFT_OP_REPEAT_EXIT] = &&op_REPEAT_EXIT - &&op_NOP,
+#else
+        [RIFT_OP_REPEAT_START] = &&op_invalid - &&op_NOP,
+        [RIFT_OP_REPEAT_END] = &&op_invalid - &&op_NOP,
+        [RIFT_OP_REPEAT_AGAIN] = &&op_invalid - &&op_NOP,
+        [RIFT_OP_REPEAT_EXIT] = &&op_invalid - &&op_NOP,
+#endif
+#if VM_LOOP_FEATURES & VM_FEATURE_ATOMIC
+        [RIFT_OP_ATOMIC_START] = &&op_ATOMIC_START - &&op_NOP,
+        [RIFT_OP_CUT] = &&op_CUT - &&op_NOP,
+#else
+        [RIFT_OP_ATOMIC_START] = &&op_invalid - &&op_NOP,
+        [RIFT_OP_CUT] = &&op_invalid - &&op_NOP,
+#endif
+    };
+    if (!vm_decode(vm, program, handlers, &&op_invalid - &&op_NOP, &&op_end - &&op_NOP)) {
+        return false;
+    }
+#else
+    if (!vm_decode(vm, program, NULL, 0, 0)) {
+        return false;
+    }
+#endif
+
+    /* Reset VM state, frames are as large as this loop needs */
+    rift_bytecode_vm_reset(vm);
+    vm->frame_words = vm_frame_words(vm, VM_LOOP_FEATURES);
+
+    /* Initialize captures for full match (group 0) */
+    vm->captures[0] = vm->current_pos; /* Start at current position */
+    vm->captures[1] = (uint32_t)-1;    /* End not determined yet */
+
+    const rift_bytecode_decoded_t *code = vm->decoded;
+    const uint32_t *classes = vm->decoded_classes;
+    const rift_bytecode_instruction_t *instructions = program->instructions;
+    uint32_t *visited = vm_bit_state_begin(vm);
+    bool memo = (VM_LOOP_FEATURES & VM_FEATURE_CAPTURES) && vm_memo_begin(vm);
+    uint32_t ip = 0;
+    uint32_t star_start = 0;
+    uint32_t run_start = 0; /* First instruction of the run not yet counted */
+    rift_trace_buffer_t *trace = vm->trace;
+
+    VM_TRACE(RIFT_TRACE_EVENT_START, 0);
+
+#if RIFT_BYTECODE_VM_THREADED
+    VM_NEXT();
+#else
+dispatch:
+    switch (code[ip].op) {
+#endif
+
+VM_OP(NOP):
+VM_OP(LOOKAHEAD):
+VM_OP(NEG_LOOKAHEAD):
+    /* Lookahead markers are not interpreted yet */
+    ip++;
+    VM_NEXT();
+
+#if VM_LOOP_FEATURES & VM_FEATURE_COUNTERS
+VM_OP(REPEAT_START):
+    vm->counters[code[ip].operand] = 0;
+    ip++;
+    VM_NEXT();
+
+VM_OP(REPEAT_END):
+    /* An unbounded loop stops counting at the largest count, which its guards never reach */
+    if (vm->counters[code[ip].operand] < UINT32_MAX) {
+        vm->counters[code[ip].operand]++;
+    }
+    ip++;
+    VM_NEXT();
+
+VM_OP(REPEAT_AGAIN): {
+    uint32_t max = vm->counter_bounds[code[ip].operand * 2 + 1];
+    if (max == UINT32_MAX || vm->counters[code[ip].operand] < max) {
+        ip++;
+        VM_NEXT();
+    }
+    goto fail;
+}
+
+VM_OP(REPEAT_EXIT):
+    if (vm->counters[code[ip].operand] >= vm->counter_bounds[code[ip].operand * 2]) {
+        ip++;
+        VM_NEXT();
+    }
+    goto fail;
+#endif
+
+VM_OP(MATCH_CHAR):
+    if (vm->current_pos < vm->input_length &&
+        (unsigned char)vm->input[vm->current_pos] == code[ip].operand) {
+        vm->current_pos++;
+        ip++;
+        VM_NEXT();
+    }
+    goto fail;
+
+VM_OP(MATCH_CLASS):
+    if (vm->current_pos < vm->input_length) {
+        const uint32_t *bitmap = classes + code[ip].operand * RIFT_BYTECODE_CLASS_WORDS;
+        unsigned char c = (unsigned char)vm->input[vm->current_pos];
+
+        /* Single bit test for class membership */
+        if (bitmap[c >> 5] & ((uint32_t)1 << (c & 31))) {
+            vm->current_pos++;
+            ip++;
+            VM_NEXT();
+        }
+    }
+    goto fail;
+
+VM_OP(MATCH_STRING): {
+    uint32_t length = instructions[ip].operand.string.length;
+    if (length <= vm->input_length - vm->current_pos &&
+        memcmp(vm->input + vm->current_pos,
+               program->literal_pool + instructions[ip].operand.string.offset, length) == 0) {
+        vm->current_pos += length;
+        ip++;
+        VM_NEXT();
+    }
+    goto fail;
+}
+
+VM_OP(STAR_CLASS): {
+    const uint32_t *bitmap = classes + code[ip].operand * RIFT_BYTECODE_CLASS_WORDS;
+    uint32_t start = vm->current_pos;
+
+    /* Take the longest run, then give it back one character at a time on failure */
+    uint32_t end = (uint32_t)rift_byte_set_span(bitmap, vm->input, start, vm->input_length);
+
+    if (end > start && !vm_push_backtrack(vm, ip | VM_BACKTRACK_STAR, end - 1, start, VM_LOOP_FEATURES)) {
+        goto error;
+    }
+    vm->current_pos = end;
+    ip++;
+    VM_NEXT();
+}
+
+VM_OP(DFA_SCAN): {
+    /* The table loop keeps its longest match and never gives any of it back */
+    size_t length = 0;
+    if (rift_dfa_table_longest_prefix(program->dfa_tables[code[ip].operand],
+                                      vm->input + vm->current_pos,
+                                      vm->input_length - vm->current_pos, &length)) {
+        vm->current_pos += (uint32_t)length;
+        ip++;
+        VM_NEXT();
+    }
+    goto fail;
+}
+
+VM_OP(MATCH_ANY):
+    if (vm->current_pos < vm->input_length) {
+        vm->current_pos++;
+        ip++;
+        VM_NEXT();
+    }
+    goto fail;
+
+VM_OP(JUMP): {
+    uint32_t target = code[ip].operand;
+    VM_COUNT_RUN();
+
+    /* Only a backward jump can repeat instructions */
+    if (target <= ip) {
+        VM_CHECK_BUDGET();
+    }
+    ip = target;
+    run_start = ip;
+    if (VM_VISITED(ip)) {
+        goto fail;
+    }
+    VM_NEXT();
+}
+
+VM_OP(SPLIT):
+    /* Save the alternate path as a backtrack point, continue with the primary one */
+    if (!vm_push_backtrack(vm, code[ip].operand, vm->current_pos, 0, VM_LOOP_FEATURES)) {
+        goto error;
+    }
+    ip++;
+    VM_NEXT();
+
+#if VM_LOOP_FEATURES & VM_FEATURE_ATOMIC
+VM_OP(ATOMIC_START):
+    /* Mark where the region's backtrack points begin */
+    if (!vm_push_backtrack(vm, ip | VM_BACKTRACK_ATOMIC, vm->current_pos, 0, VM_LOOP_FEATURES)) {
+        goto error;
+    }
+    ip++;
+    VM_NEXT();
+
+VM_OP(CUT):
+    /* Commit to the region's match: nothing inside it is retried */
+    if (!vm_cut_backtrack(vm, VM_LOOP_FEATURES)) {
+        goto error;
+    }
+    ip++;
+    VM_NEXT();
+#endif
+
+#if VM_LOOP_FEATURES & VM_FEATURE_CAPTURES
+VM_OP(SAVE_START):
+    vm->captures[code[ip].operand * 2] = vm->current_pos;
+    ip++;
+    VM_NEXT();
+
+VM_OP(SAVE_END):
+    vm->captures[code[ip].operand * 2 + 1] = vm->current_pos;
+    ip++;
+    VM_NEXT();
+#endif
+
+VM_OP(ACCEPT):
+    VM_COUNT_RUN();
+    VM_TRACE(RIFT_TRACE_EVENT_MATCH, ip);
+
+    /* Match found - set the end position for group 0 */
+    vm->captures[1] = vm->current_pos;
+
+    /* Fill match information if provided */
+    if (match) {
+        match->start_pos = vm->captures[0];
+        match->end_pos = vm->captures[1];
+        match->group_count = vm->capture_count;
+
+        /* Match groups would be copied here in a complete implementation */
+    }
+    return true;
+
+VM_OP(FAIL):
+    goto fail;
+
+VM_OP(BOUNDARY): {
+    bool at_boundary = false;
+
+    /* Start or end of input is a boundary, otherwise a change between word and non-word */
+    if (vm->current_pos == 0 || vm->current_pos == vm->input_length) {
+        at_boundary = true;
+    } else {
+        at_boundary = vm_is_word_char(vm->input[vm->current_pos - 1]) !=
+                      vm_is_word_char(vm->input[vm->current_pos]);
+    }
+
+    if (at_boundary) {
+        ip++;
+        VM_NEXT();
+    }
+    goto fail;
+}
+
+#if VM_LOOP_FEATURES & VM_FEATURE_CAPTURES
+VM_OP(BACKREF): {
+    uint32_t group_index = code[ip].operand & ~VM_BACKREF_CASELESS;
+    uint32_t start = vm->captures[group_index * 2];
+    uint32_t end = vm->captures[group_index * 2 + 1];
+
+    /* If group hasn't been captured yet, fail */
+    if (start == (uint32_t)-1 || end == (uint32_t)-1) {
+        goto fail;
+    }
+
+    /* Compare input with captured group */
+    uint32_t length = end - start;
+    if (vm->current_pos + length <= vm->input_length &&
+        ((code[ip].operand & VM_BACKREF_CASELESS)
+             ? vm_equal_caseless(vm->input + vm->current_pos, vm->input + start, length)
+             : memcmp(vm->input + vm->current_pos, vm->input + start, length) == 0)) {
+        vm->current_pos += length;
+        ip++;
+        VM_NEXT();
+    }
+    goto fail;
+}
+#endif
+
+#if !RIFT_BYTECODE_VM_THREADED
+    case VM_OPCODE_END:
+        goto op_end;
+    default:
+        goto op_invalid;
+    }
+#endif
+
+fail:
+    /* Match failed - try backtracking */
+    VM_COUNT_RUN();
+    VM_TRACE(RIFT_TRACE_EVENT_FAIL, ip);
+#if VM_LOOP_FEATURES & VM_FEATURE_ATOMIC
+pop:
+#endif
+    if (!vm_pop_backtrack(vm, &ip, &vm->current_pos, &star_start, VM_LOOP_FEATURES)) {
+        return false;
+    }
+    VM_CHECK_BUDGET();
+
+#if VM_LOOP_FEATURES & VM_FEATURE_ATOMIC
+    /* Failing back past an atomic marker leaves its region, there is nothing to resume */
+    if (ip & VM_BACKTRACK_ATOMIC) {
+        goto pop;
+    }
+#endif
+
+    /* A STAR_CLASS frame resumes after the loop, keeping a frame for a shorter run */
+    if (ip & VM_BACKTRACK_STAR) {
+        ip &= ~VM_BACKTRACK_STAR;
+        if (vm->current_pos > star_start &&
+            !vm_push_backtrack(vm, ip | VM_BACKTRACK_STAR, vm->current_pos - 1, star_start,
+                               VM_LOOP_FEATURES)) {
+            goto error;
+        }
+        ip++;
+    }
+    VM_TRACE(RIFT_TRACE_EVENT_BACKTRACK, ip);
+    run_start = ip;
+    if (VM_VISITED(ip)) {
+        goto fail;
+    }
+    VM_NEXT();
+
+op_end:
+op_invalid:
+error:
+    /* Execution error */
+    VM_COUNT_RUN();
+    return false;
+}
+
+#undef VM_LOOP_NAME
+#undef VM_LOOP_FEATURES
@@ -0,0 +1,69 @@
+/**
+ * @file bytecode_vm_pool.h
+ * @brief Per-thread pool of bytecode VMs for LibRift
+ *
+ * This file defines a small cache of VMs per thread, keyed by program, so
+ * callers that run a program many times on short inputs do not pay for VM
+ * setup and program decoding on every run.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+ #ifndef LIBRIFT_BYTECODE_VM_POOL_H
+ #define LIBRIFT_BYTECODE_VM_POOL_H
+ 
+ #include <stdbool.h>
+ #include <stddef.h>
+ 
+ #include "core/bytecode/bytecode_vm.h"
+ 
+ #ifdef __cplusplus
+ extern "C" {
+ #endif
+ 
+ /* Number of VMs kept per thread */
+ #define RIFT_BYTECODE_VM_POOL_SIZE 8
+ 
+ /**
+  * @brief Take a VM bound to a program and input from the calling thread's pool
+  *
+  * The VM last used for the program is returned when it is free, so its
+  * decoded program is reused. Otherwise a free slot is rebound to the program,
+  * and when every slot is in use a new VM is created. The VM has the default
+  * execution limits and must be handed back with rift_bytecode_vm_release on
+  * the same thread.
+  *
+  * @param program Bytecode program to execute
+  * @param input Input string to match against
+  * @param input_length Length of input string or (size_t)-1 to use strlen
+  * @return A VM or NULL on failure
+  */
+ rift_bytecode_vm_t *rift_bytecode_vm_acquire(rift_bytecode_program_t *program, const char *input,
+                                              size_t input_length);
+ 
+ /**
+  * @brief Hand a VM back to the calling thread's pool
+  *
+  * A VM the pool has no slot for is freed.
+  *
+  * @param vm VM returned by rift_bytecode_vm_acquire (can be NULL)
+  */
+ void rift_bytecode_vm_release(rift_bytecode_vm_t *vm);
+ 
+ /**
+  * @brief Forget a program in the calling thread's pool
+  *
+  * Must be called before a program is freed, so a later program allocated at
+  * the same address is not mistaken for it. Pools of other threads that ran
+  * the program must be evicted on those threads.
+  *
+  * @param program The program
+  */
+ void rift_bytecode_vm_pool_evict(const rift_bytecode_program_t *program);
+ 
+ #ifdef __cplusplus
+ }
+ #endif
+ 
+ #endif /* LIBRIFT_BYTECODE_VM_POOL_H */
@@ -0,0 +1,136 @@
+/**
+ * @file ambiguity.h
+ * @brief Static catastrophic-backtracking analysis for the LibRift regex engine
+ *
+ * This file defines a compile-time analysis of how many ways a pattern's NFA
+ * can match the same input. A backtracking engine explores every one of those
+ * ways before it rejects, so the degree of ambiguity bounds its running time:
+ * exponential degree of ambiguity (EDA) means exponential time, infinite
+ * polynomial degree (IDA) means polynomial time. The verdict is stored on the
+ * compiled pattern, and the matcher routes dangerous patterns to a
+ * linear-time engine up front instead of discovering the blowup at run time.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_COMPILER_AMBIGUITY_H
+#define LIBRIFT_REGEX_COMPILER_AMBIGUITY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/automaton/automaton.h"
+#include "core/errors/regex_error.h"
+#include "core/parser/ast.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Largest number of consuming states analyzed
+ *
+ * The exponential check walks pairs of states, so automata with more states
+ * reachable through consuming transitions are left RIFT_AMBIGUITY_UNKNOWN.
+ */
+#define RIFT_AMBIGUITY_MAX_STATES 512
+
+/**
+ * @brief Largest number of state triples visited by the polynomial check
+ */
+#define RIFT_AMBIGUITY_MAX_TRIPLES (1u << 22)
+
+/**
+ * @brief Degree of ambiguity of a pattern
+ */
+typedef enum rift_ambiguity {
+    RIFT_AMBIGUITY_UNKNOWN = 0, /**< Not analyzed, or too large to analyze */
+    RIFT_AMBIGUITY_FINITE,      /**< Bounded number of parses, backtracking stays linear */
+    RIFT_AMBIGUITY_POLYNOMIAL,  /**< IDA: parses grow polynomially with the input */
+    RIFT_AMBIGUITY_EXPONENTIAL  /**< EDA: parses grow exponentially with the input */
+} rift_ambiguity_t;
+
+/**
+ * @brief Verdict of the analysis, recorded on compiled patterns
+ */
+typedef struct rift_ambiguity_verdict {
+    rift_ambiguity_t ambiguity;  /**< Degree of ambiguity of the automaton */
+    uint32_t degree;             /**< For IDA, the number of chained loop pairs: a failing
+                                      backtracking run takes O(n^(degree + 1)) steps */
+    uint32_t nested_quantifiers; /**< Unbounded quantifiers inside unbounded quantifiers */
+    bool has_backreference;      /**< Whether only a backtracking engine can run the pattern */
+} rift_ambiguity_verdict_t;
+
+/**
+ * @brief Initialize a verdict to "not analyzed"
+ *
+ * @param verdict The verdict
+ */
+void rift_ambiguity_verdict_init(rift_ambiguity_verdict_t *verdict);
+
+/**
+ * @brief Record the structural findings of a pattern's AST
+ *
+ * Counts unbounded quantifiers nested in unbounded quantifiers, such as
+ * (a+)+, and notes backreferences. The degree of ambiguity itself comes from
+ * the automaton, since nesting alone is neither necessary, (a|a)*, nor
+ * sufficient, (ab+)+.
+ *
+ * @param ast The AST
+ * @param verdict The verdict to update
+ */
+void rift_ambiguity_analyze_ast(const rift_regex_ast_t *ast, rift_ambiguity_verdict_t *verdict);
+
+/**
+ * @brief Compute the degree of ambiguity of an automaton
+ *
+ * Epsilon transitions are removed first, counting distinct epsilon paths so
+ * that (a*)* keeps the parallel paths a backtracker would try. The automaton
+ * is then EDA when a strongly connected component of its self-product holds
+ * both a diagonal pair (p, p) and a second path, and IDA when there are two
+ * distinct loops p and q and a word v leading p -> p, p -> q and q -> q, as
+ * found in the self-product of three copies. Chained IDA pairs give the
+ * polynomial degree.
+ *
+ * @param automaton The automaton
+ * @param verdict The verdict to update
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if analyzed, false on invalid parameters or allocation failure
+ */
+bool rift_ambiguity_analyze_automaton(const rift_regex_automaton_t *automaton,
+                                      rift_ambiguity_verdict_t *verdict,
+                                      rift_regex_error_t *error);
+
+/**
+ * @brief Analyze a pattern's AST and automaton
+ *
+ * @param ast The AST (can be NULL)
+ * @param automaton The automaton
+ * @param verdict Pointer to store the verdict
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if analyzed, false otherwise (the verdict is then UNKNOWN)
+ */
+bool rift_ambiguity_analyze(const rift_regex_ast_t *ast, const rift_regex_automaton_t *automaton,
+                            rift_ambiguity_verdict_t *verdict, rift_regex_error_t *error);
+
+/**
+ * @brief Check whether a verdict calls for a linear-time engine
+ *
+ * @param verdict The verdict
+ * @return true for EDA and IDA patterns
+ */
+bool rift_ambiguity_is_dangerous(const rift_ambiguity_verdict_t *verdict);
+
+/**
+ * @brief Get the name of a degree of ambiguity
+ *
+ * @param ambiguity The degree
+ * @return A static string such as "exponential"
+ */
+const char *rift_ambiguity_to_string(rift_ambiguity_t ambiguity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_COMPILER_AMBIGUITY_H */
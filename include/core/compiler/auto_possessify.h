@@ -0,0 +1,47 @@
+/**
+ * @file auto_possessify.h
+ * @brief Automatic possessification of quantifiers for the LibRift regex engine
+ *
+ * This file defines a pass over a pattern's AST that makes greedy quantifiers
+ * possessive when giving back a repetition can never help the rest of the
+ * pattern match, in the manner of PCRE's auto-possessify. In \d+[a-z] no
+ * digit the loop gives back can be the letter that must follow, so the loop
+ * is compiled as \d++[a-z] and a failing match leaves no backtrack points
+ * behind it.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_COMPILER_AUTO_POSSESSIFY_H
+#define LIBRIFT_REGEX_COMPILER_AUTO_POSSESSIFY_H
+
+#include <stddef.h>
+#include "core/automaton/flags.h"
+#include "core/parser/ast.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Make the quantifiers of an AST possessive where it cannot change a match
+ *
+ * A greedy quantifier over a single byte, a literal character, a class or
+ * the dot, is made possessive when the bytes it repeats are disjoint from
+ * the bytes the next element of its sequence must start with, or when it
+ * ends the pattern. Nothing is changed under RIFT_REGEX_FLAG_NO_AUTO_POSSESS,
+ * for patterns whose flags change how bytes match (case-insensitive,
+ * extended) or make quantifiers lazy by default, or while the compiler is
+ * configured to build Glushkov NFAs (RIFT_REGEX_PARAM_GLUSHKOV_NFA).
+ *
+ * @param ast The AST, rewritten in place before it is compiled
+ * @param flags The compilation flags
+ * @return The number of quantifiers made possessive
+ */
+size_t rift_regex_auto_possessify(rift_regex_ast_t *ast, rift_regex_flags_t flags);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_COMPILER_AUTO_POSSESSIFY_H */
@@ -0,0 +1,61 @@
+/**
+ * @file case_fold.h
+ * @brief Compile-time case folding for the LibRift regex engine
+ *
+ * Case-insensitive patterns are folded while they are compiled: every
+ * literal byte and class predicate is widened to include the other case of
+ * its letters, so the automaton itself is case-insensitive and matching
+ * never lowercases the subject or compares a byte twice. Byte patterns fold
+ * ASCII letters as in the C locale; UTF-8 patterns also fold the simple
+ * one-to-one pairs of Latin-1, Greek and Cyrillic.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_COMPILER_CASE_FOLD_H
+#define LIBRIFT_REGEX_COMPILER_CASE_FOLD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/compiler/utf8_ranges.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Get the other case of a code point
+ *
+ * @param codepoint The code point
+ * @return The other case, or the code point itself if it has none
+ */
+uint32_t rift_case_fold_other(uint32_t codepoint);
+
+/**
+ * @brief Add the other case of every member to a set of code points
+ *
+ * @param set The set, normalized again on return
+ * @return true if successful, false on allocation failure
+ */
+bool rift_case_fold_range_set(rift_utf8_range_set_t *set);
+
+/**
+ * @brief Fold a transition pattern so that it matches ASCII letters in either case
+ *
+ * A negated bracket expression is folded before it is negated, so [^a]
+ * excludes both 'a' and 'A'.
+ *
+ * @param pattern A single byte, escaped byte or bracket expression
+ * @param buffer Output buffer of at least RIFT_BYTE_CLASS_MAX_PATTERN_LENGTH bytes
+ * @param buffer_size Size of the output buffer
+ * @return true if a folded pattern was written, false if the pattern has no
+ *         letters to fold and is used as it is
+ */
+bool rift_case_fold_pattern(const char *pattern, char *buffer, size_t buffer_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_COMPILER_CASE_FOLD_H */
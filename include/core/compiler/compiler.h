@@ -58,6 +58,24 @@ bool rift_automaton_create_epsilon_transition(rift_regex_automaton_t *automaton,
 rift_regex_automaton_t *rift_regex_compile_ast(const rift_regex_ast_t *ast,
                                                rift_regex_flags_t flags, rift_regex_error_t *error);
 
+/**
+ * @brief Compile an AST into an automaton whose counted loops are kept
+ *
+ * Large bounded repeats are built as counted loops (see counter.h), one copy
+ * of their body with a counter, instead of one copy per iteration. Only the
+ * bytecode compiler can run such an automaton; rift_regex_compile_ast
+ * unrolls the loops for everything else. The flags' DFA conversion and
+ * optimizations are not applied.
+ *
+ * @param ast The Abstract Syntax Tree representing the pattern
+ * @param flags Compilation flags
+ * @param error Pointer to store error code (can be NULL)
+ * @return The compiled NFA or NULL on failure
+ */
+rift_regex_automaton_t *rift_regex_compile_ast_with_counters(const rift_regex_ast_t *ast,
+                                                             rift_regex_flags_t flags,
+                                                             rift_regex_error_t *error);
+
 /**
  * @brief Compile a pattern string into an automaton structure
  *
@@ -176,12 +194,13 @@ bool parse_quantifier_values(const char *pattern, size_t *min, size_t *max, bool
  * @param node The character class node to process
  * @param start_state Pointer to store the start state
  * @param end_state Pointer to store the end state
+ * @param flags Compilation flags
  * @param error Pointer to store error code (can be NULL)
  * @return true if successful, false otherwise
  */
 bool handle_character_class(rift_regex_automaton_t *automaton, const rift_regex_ast_node_t *node,
                             rift_regex_state_t **start_state, rift_regex_state_t **end_state,
-                            rift_regex_error_t *error);
+                            rift_regex_flags_t flags, rift_regex_error_t *error);
 
 /**
  * @brief Handle a literal node (internal function)
@@ -190,12 +209,13 @@ bool handle_character_class(rift_regex_automaton_t *automaton, const rift_regex_
  * @param node The literal node to process
  * @param start_state Pointer to store the start state
  * @param end_state Pointer to store the end state
+ * @param flags Compilation flags
  * @param error Pointer to store error code (can be NULL)
  * @return true if successful, false otherwise
  */
 bool handle_literal(rift_regex_automaton_t *automaton, const rift_regex_ast_node_t *node,
                     rift_regex_state_t **start_state, rift_regex_state_t **end_state,
-                    rift_regex_error_t *error);
+                    rift_regex_flags_t flags, rift_regex_error_t *error);
 
 /**
  * @brief Handle a group node (internal function)
@@ -226,6 +246,21 @@ bool handle_anchor(rift_regex_automaton_t *automaton, const rift_regex_ast_node_
                    rift_regex_state_t **start_state, rift_regex_state_t **end_state,
                    rift_regex_error_t *error);
 
+/**
+ * @brief Handle a lookahead or lookbehind node (internal function)
+ *
+ * @param automaton The automaton to build
+ * @param node The lookaround node to process
+ * @param start_state Pointer to store the start state, which runs the assertion
+ * @param end_state Pointer to store the end state
+ * @param flags Compilation flags
+ * @param error Pointer to store error code (can be NULL)
+ * @return true if successful, false otherwise
+ */
+bool handle_lookaround(rift_regex_automaton_t *automaton, const rift_regex_ast_node_t *node,
+                       rift_regex_state_t **start_state, rift_regex_state_t **end_state,
+                       rift_regex_flags_t flags, rift_regex_error_t *error);
+
 /**
  * @brief Handle a backreference node (internal function)
  *
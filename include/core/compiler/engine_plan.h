@@ -0,0 +1,153 @@
+/**
+ * @file engine_plan.h
+ * @brief Compile-time engine selection for the LibRift regex engine
+ *
+ * This file defines the plan recorded on a compiled pattern for the matcher's
+ * engines. Each engine is checked against the pattern once, at compile time:
+ * what the pattern uses, how large its automaton is against each engine's
+ * limits and what the ambiguity analysis found. The plan keeps the engine a
+ * default search starts with and, for every engine, whether it can run the
+ * pattern and why, so the matcher skips engines already known not to fit
+ * and `rift explain` can show the choice.
+ *
+ * The plan also keeps how a search finds where the leftmost match starts
+ * when the pattern has no prefix literal: by the literal every match ends
+ * with, read back from with the reverse DFA, or by skipping to a literal
+ * every match contains before scanning forward.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_COMPILER_ENGINE_PLAN_H
+#define LIBRIFT_REGEX_COMPILER_ENGINE_PLAN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/automaton/automaton.h"
+#include "core/compiler/ambiguity.h"
+#include "core/compiler/prefilter.h"
+#include "core/errors/regex_error.h"
+#include "core/runtime/execution_tracker.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Longest reason recorded for an engine, terminator included
+ */
+#define RIFT_ENGINE_PLAN_REASON_LENGTH 96
+
+/**
+ * @brief How a search locates the leftmost match start on the lazy DFA
+ *
+ * The strategies other than RIFT_SEARCH_FORWARD apply to searches that
+ * report match bounds only, like the reverse DFA they rely on.
+ */
+typedef enum rift_search_strategy {
+    RIFT_SEARCH_FORWARD = 0,    /**< Scan forward from the start position or prefilter candidate */
+    RIFT_SEARCH_REVERSE_SUFFIX, /**< Find the suffix literal, then read back to the start */
+    RIFT_SEARCH_INNER_LITERAL   /**< Skip to a required literal, then scan forward */
+} rift_search_strategy_t;
+
+/**
+ * @brief Engines chosen for a pattern at compile time
+ *
+ * A plan that was never built allows every engine, so patterns compiled
+ * without one run as before. The bytecode VM is never usable here, as the
+ * matcher does not run it.
+ */
+typedef struct rift_engine_plan {
+    bool planned;                           /**< Whether the plan was built */
+    rift_match_engine_t engine;             /**< Engine a default search starts with */
+    bool usable[RIFT_MATCH_ENGINE_COUNT];   /**< Whether each engine can run the pattern */
+    char reasons[RIFT_MATCH_ENGINE_COUNT][RIFT_ENGINE_PLAN_REASON_LENGTH]; /**< Why, per engine */
+    size_t num_states;                      /**< States of the automaton */
+    size_t group_count;                     /**< Capture groups of the pattern */
+    size_t bit_parallel_positions;          /**< Positions of the bit-parallel NFA, 0 if none */
+    rift_search_strategy_t search;          /**< How a search locates the match start */
+    char search_reason[RIFT_ENGINE_PLAN_REASON_LENGTH]; /**< Why that strategy */
+} rift_engine_plan_t;
+
+/**
+ * @brief Initialize a plan to "not planned", allowing every engine
+ *
+ * @param plan The plan
+ */
+void rift_engine_plan_init(rift_engine_plan_t *plan);
+
+/**
+ * @brief Choose the engines of a compiled pattern
+ *
+ * Mirrors the order of a default search: the lazy DFA when the ambiguity
+ * verdict or the configuration asks for it, then the bit-parallel NFA, the
+ * one-pass DFA, the tagged DFA, the Pike VM and the backtracker. The
+ * bit-parallel and one-pass engines are built once to learn whether they
+ * fit and freed again; the tagged DFA only has its size limit checked, as
+ * building it costs as much as the first search saves.
+ *
+ * @param automaton The automaton of the pattern
+ * @param group_count Number of capture groups
+ * @param verdict The ambiguity verdict of the pattern (can be NULL)
+ * @param plan Pointer to store the plan
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if planned, false on invalid parameters (the plan then allows every engine)
+ */
+bool rift_engine_plan_build(const rift_regex_automaton_t *automaton, size_t group_count,
+                            const rift_ambiguity_verdict_t *verdict, rift_engine_plan_t *plan,
+                            rift_regex_error_t *error);
+
+/**
+ * @brief Choose how searches locate the start of a match
+ *
+ * A prefix literal or a start anchor already leads a forward scan to the
+ * candidates. Otherwise a suffix literal is used when no match contains it
+ * anywhere but at its end, which makes the first match ending at an
+ * occurrence the leftmost one and lets each reverse scan stop at the
+ * previous occurrence; this is checked on the languages of the automaton
+ * and of .*suffix.+, so patterns with assertions, lookarounds or counted
+ * loops are left out. Failing that, a required literal bounds where the
+ * forward scan starts.
+ *
+ * @param plan The plan, built by rift_engine_plan_build()
+ * @param automaton The automaton of the pattern
+ * @param prefilter The literals of the pattern (can be NULL)
+ * @return true if a strategy other than RIFT_SEARCH_FORWARD was chosen
+ */
+bool rift_engine_plan_choose_search(rift_engine_plan_t *plan,
+                                    const rift_regex_automaton_t *automaton,
+                                    const rift_prefilter_t *prefilter);
+
+/**
+ * @brief Get the name of a search strategy
+ *
+ * @param strategy The strategy
+ * @return A static lowercase name, "unknown" for an invalid strategy
+ */
+const char *rift_search_strategy_name(rift_search_strategy_t strategy);
+
+/**
+ * @brief Check whether a plan lets an engine run the pattern
+ *
+ * @param plan The plan (can be NULL)
+ * @param engine The engine
+ * @return true if the engine is usable or the pattern was not planned
+ */
+bool rift_engine_plan_allows(const rift_engine_plan_t *plan, rift_match_engine_t engine);
+
+/**
+ * @brief Get the reason recorded for an engine
+ *
+ * @param plan The plan
+ * @param engine The engine
+ * @return The reason, or an empty string
+ */
+const char *rift_engine_plan_get_reason(const rift_engine_plan_t *plan,
+                                        rift_match_engine_t engine);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_COMPILER_ENGINE_PLAN_H */
@@ -0,0 +1,87 @@
+/**
+ * @file group_names.h
+ * @brief Compile-time table of named capture groups for the LibRift regex engine
+ *
+ * This file defines the table that maps the names of capture groups to their
+ * indices. It is built once from the AST when a pattern is compiled, so code
+ * reading groups by name after every match resolves each name with one hash
+ * probe instead of comparing it with every group.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_COMPILER_GROUP_NAMES_H
+#define LIBRIFT_REGEX_COMPILER_GROUP_NAMES_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/errors/regex_error.h"
+#include "core/parser/ast.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Index returned for names no group of the pattern has
+ */
+#define RIFT_GROUP_NO_INDEX SIZE_MAX
+
+/**
+ * @brief Slot of the group name hash table
+ */
+typedef struct rift_group_name_slot {
+    const char *name; /**< Group name, NULL for an empty slot */
+    uint32_t hash;    /**< Hash of the name */
+    uint32_t index;   /**< Index of the group, counting from 1 in order of opening parentheses */
+} rift_group_name_slot_t;
+
+/**
+ * @brief Hash table from group names to group indices
+ *
+ * Open addressing with linear probing, kept at most half full. The names are
+ * copied into one block owned by the table, so the table outlives the AST.
+ */
+typedef struct rift_group_names {
+    rift_group_name_slot_t *slots; /**< Slots, a power of two of them */
+    size_t capacity;               /**< Number of slots */
+    size_t count;                  /**< Number of names */
+    char *names;                   /**< Block holding the names */
+} rift_group_names_t;
+
+/**
+ * @brief Build the name table of an AST
+ *
+ * Groups are numbered like backreferences: the first opening parenthesis of
+ * a capturing group is group 1. A name used by several groups maps to the
+ * first of them.
+ *
+ * @param ast The AST
+ * @param error Pointer to store error information (can be NULL)
+ * @return The table, or NULL on failure. ASTs without named groups get an
+ *         empty table
+ */
+rift_group_names_t *rift_group_names_build(const rift_regex_ast_t *ast, rift_regex_error_t *error);
+
+/**
+ * @brief Find the index of a named group
+ *
+ * @param names The table (can be NULL)
+ * @param name The group name
+ * @return The group index, or RIFT_GROUP_NO_INDEX if no group has the name
+ */
+size_t rift_group_names_lookup(const rift_group_names_t *names, const char *name);
+
+/**
+ * @brief Free a name table
+ *
+ * @param names The table (can be NULL)
+ */
+void rift_group_names_free(rift_group_names_t *names);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_COMPILER_GROUP_NAMES_H */
@@ -0,0 +1,81 @@
+/**
+ * @file match_length.h
+ * @brief Static bounds on the length of a pattern's matches for the LibRift regex engine
+ *
+ * This file defines a compile-time analysis of the fewest and most bytes a
+ * match of a pattern can consume, computed from its AST. Patterns such as
+ * fixed-width timestamps and identifiers have a finite maximum, which lets
+ * the matcher stop a scan once no match can still end in it, read backward
+ * from a match end no further than a match can reach, and size the overlap
+ * a chunk of a split input needs to see the matches crossing its end. A
+ * minimum rules out start positions too close to the end of the input.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_COMPILER_MATCH_LENGTH_H
+#define LIBRIFT_REGEX_COMPILER_MATCH_LENGTH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/automaton/flags.h"
+#include "core/parser/ast.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Maximum length of patterns whose matches can be arbitrarily long
+ */
+#define RIFT_MATCH_LENGTH_UNBOUNDED SIZE_MAX
+
+/**
+ * @brief Bounds on the number of bytes a match consumes, recorded on compiled patterns
+ *
+ * Lookarounds and anchors consume nothing. Backreferences and constructs the
+ * analysis does not know leave the maximum unbounded and count nothing
+ * toward the minimum, so the bounds always hold.
+ */
+typedef struct rift_match_length_bounds {
+    size_t min; /**< Fewest bytes any match consumes */
+    size_t max; /**< Most bytes any match consumes, or RIFT_MATCH_LENGTH_UNBOUNDED */
+} rift_match_length_bounds_t;
+
+/**
+ * @brief Initialize bounds to "not analyzed": any length from 0 up
+ *
+ * @param bounds The bounds
+ */
+void rift_match_length_bounds_init(rift_match_length_bounds_t *bounds);
+
+/**
+ * @brief Compute the bounds of a pattern's matches from its AST
+ *
+ * A UTF-8 dot, class or property consumes one to four bytes; in byte mode
+ * they consume one. Case folding pairs letters of the same encoded length,
+ * so a literal consumes its own length either way.
+ *
+ * @param ast The AST
+ * @param flags Compilation flags
+ * @param bounds Pointer to store the bounds
+ * @return true if analyzed, false on invalid parameters (the bounds are then
+ *         left as initialized)
+ */
+bool rift_match_length_analyze(const rift_regex_ast_t *ast, rift_regex_flags_t flags,
+                               rift_match_length_bounds_t *bounds);
+
+/**
+ * @brief Check whether every match of a pattern is at most some number of bytes long
+ *
+ * @param bounds The bounds
+ * @return true if the maximum is finite
+ */
+bool rift_match_length_is_bounded(const rift_match_length_bounds_t *bounds);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_COMPILER_MATCH_LENGTH_H */
@@ -0,0 +1,198 @@
+/**
+ * @file prefilter.h
+ * @brief Literal extraction and substring prefiltering for the LibRift regex engine
+ *
+ * This file defines a prefilter computed from a pattern's AST. It holds the
+ * literal every match starts with, the literal every match ends with, and a
+ * small set of literals of which every match contains at least one. The
+ * compiled automaton adds the set of bytes a match can begin with and whether
+ * matches must start at the beginning of the input. Searches use it to skip
+ * input where no match can start before running the automaton. Literals of
+ * case-insensitive patterns are searched for ignoring ASCII case.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_COMPILER_PREFILTER_H
+#define LIBRIFT_REGEX_COMPILER_PREFILTER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/automaton/automaton.h"
+#include "core/errors/regex_error.h"
+#include "core/parser/ast.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Longest literal kept by the analysis
+ *
+ * Longer literals are cut down, which keeps them valid: a part of a required
+ * literal is required as well.
+ */
+#define RIFT_PREFILTER_MAX_LITERAL_LENGTH 32
+
+/**
+ * @brief Largest number of alternative required literals
+ */
+#define RIFT_PREFILTER_MAX_LITERALS 8
+
+/**
+ * @brief Candidate position returned when no match can start in the input
+ */
+#define RIFT_PREFILTER_NO_CANDIDATE ((size_t)-1)
+
+/**
+ * @brief Literal string of bounded length
+ */
+typedef struct rift_prefilter_literal {
+    char bytes[RIFT_PREFILTER_MAX_LITERAL_LENGTH + 1]; /**< Literal bytes, NUL terminated */
+    size_t length;                                     /**< Number of literal bytes */
+} rift_prefilter_literal_t;
+
+/**
+ * @brief Literals required by every match of a pattern
+ *
+ * An empty prefix or suffix and a required count of 0 mean that nothing is
+ * known, in which case the prefilter accepts every position.
+ */
+typedef struct rift_prefilter {
+    rift_prefilter_literal_t prefix; /**< Literal every match starts with */
+    rift_prefilter_literal_t suffix; /**< Literal every match ends with */
+    rift_prefilter_literal_t required[RIFT_PREFILTER_MAX_LITERALS]; /**< Alternatives */
+    size_t num_required; /**< Number of required literals, one of which every match contains */
+    uint64_t first_bytes[4];  /**< 256-bit set of bytes a match can begin with */
+    uint16_t num_first_bytes; /**< Number of bytes in first_bytes, 256 when unknown */
+    bool anchored_start;      /**< Whether every match starts at a ^ anchor */
+    bool multiline;           /**< Whether ^ also matches after a newline */
+    bool caseless;            /**< Whether literals match ignoring ASCII case */
+} rift_prefilter_t;
+
+/**
+ * @brief Extract the literals of a pattern
+ *
+ * Patterns containing inline options yield an empty prefilter. Literals of
+ * patterns compiled case-insensitively are kept as written and marked
+ * caseless; in UTF-8 mode they are cut short of their first non-ASCII byte,
+ * whose other case is not a matter of ASCII folding.
+ *
+ * @param ast The AST of the pattern
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new prefilter or NULL on failure
+ */
+rift_prefilter_t *rift_prefilter_create(const rift_regex_ast_t *ast, rift_regex_error_t *error);
+
+/**
+ * @brief Add what the compiled automaton of a pattern tells about match starts
+ *
+ * Follows the epsilon transitions from the start state to collect the bytes
+ * the first transition of a match can consume. The start is anchored when
+ * every such path passes a state carrying RIFT_STATE_FLAG_ANCHOR_START.
+ * Patterns that can match the empty string keep every byte as a first byte.
+ *
+ * @param prefilter The prefilter
+ * @param automaton The automaton compiled from the same pattern
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+bool rift_prefilter_analyze_automaton(rift_prefilter_t *prefilter,
+                                      const rift_regex_automaton_t *automaton,
+                                      rift_regex_error_t *error);
+
+/**
+ * @brief Free a prefilter
+ *
+ * @param prefilter The prefilter to free
+ */
+void rift_prefilter_free(rift_prefilter_t *prefilter);
+
+/**
+ * @brief Check whether a prefilter can reject any input
+ *
+ * @param prefilter The prefilter
+ * @return true if a prefix or required literal is known, false otherwise
+ */
+bool rift_prefilter_has_literals(const rift_prefilter_t *prefilter);
+
+/**
+ * @brief Check whether a prefilter can rule out any start position
+ *
+ * @param prefilter The prefilter
+ * @return true if it has literals, a restricted first-byte set or an anchor
+ */
+bool rift_prefilter_can_skip(const rift_prefilter_t *prefilter);
+
+/**
+ * @brief Find the first position where a match could start
+ *
+ * Anchored patterns only start at the beginning of the input, or of a line
+ * in multiline mode. Otherwise the candidate is the next occurrence of the
+ * prefix, or the next byte of the first-byte set. A required literal must
+ * also occur at or after the candidate. Without a prefix or first-byte set
+ * every position up to that occurrence is a candidate as well.
+ *
+ * @param prefilter The prefilter
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param start First position to consider
+ * @param window_end Pointer to store the last position known to be a candidate (can be NULL)
+ * @return The candidate position or RIFT_PREFILTER_NO_CANDIDATE
+ */
+size_t rift_prefilter_find_candidate(const rift_prefilter_t *prefilter, const char *input,
+                                     size_t length, size_t start, size_t *window_end);
+
+/**
+ * @brief Find the next occurrence of a byte
+ *
+ * Uses memchr, which the C library implements with vector instructions, or
+ * 16-byte compares in Wasm builds, whose memchr is a word-at-a-time loop.
+ *
+ * @param input The input bytes
+ * @param start First position to consider
+ * @param end Position after the last one to consider
+ * @param byte The byte
+ * @return Position of the byte or end if it does not occur
+ */
+size_t rift_prefilter_find_byte(const char *input, size_t start, size_t end, unsigned char byte);
+
+/**
+ * @brief Find the first occurrence of a literal
+ *
+ * The search jumps between occurrences of the literal's first byte with
+ * memchr, which the C library implements with vector instructions.
+ *
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param start First position to consider
+ * @param literal The literal bytes
+ * @param literal_length Number of literal bytes
+ * @return Position of the occurrence or RIFT_PREFILTER_NO_CANDIDATE
+ */
+size_t rift_prefilter_find_literal(const char *input, size_t length, size_t start,
+                                   const char *literal, size_t literal_length);
+
+/**
+ * @brief Find the first occurrence of a literal, ignoring ASCII case
+ *
+ * Candidates for the first byte are found 16 bytes at a time by comparing
+ * against both of its cases with SSE2 where available, so a case-insensitive
+ * search costs about as much as a case-sensitive one.
+ *
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param start First position to consider
+ * @param literal The literal bytes
+ * @param literal_length Number of literal bytes
+ * @return Position of the occurrence or RIFT_PREFILTER_NO_CANDIDATE
+ */
+size_t rift_prefilter_find_literal_caseless(const char *input, size_t length, size_t start,
+                                            const char *literal, size_t literal_length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_COMPILER_PREFILTER_H */
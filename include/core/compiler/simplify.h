@@ -0,0 +1,43 @@
+/**
+ * @file simplify.h
+ * @brief AST simplification before NFA construction for the LibRift regex engine
+ *
+ * This file defines a pass that rewrites a pattern's AST into a smaller
+ * equivalent one before it is compiled: nested sequences and non-capturing
+ * groups are flattened, adjacent literals merged, common literal prefixes
+ * factored out of alternations, alternations of single bytes turned into
+ * classes and nested simple quantifiers folded. foo|foobar|fox compiles as
+ * fo(?:o(?:bar)??|x) and a|b|c as [abc], so every later stage works on a
+ * smaller automaton.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_COMPILER_SIMPLIFY_H
+#define LIBRIFT_REGEX_COMPILER_SIMPLIFY_H
+
+#include <stddef.h>
+#include "core/parser/ast.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Simplify an AST without changing what it matches
+ *
+ * Rewrites keep the order in which alternatives are tried wherever two of
+ * them could match at the same position, so leftmost-first matches and
+ * captures are unchanged; capturing groups are never removed or merged.
+ * A rewrite that cannot allocate its nodes is skipped.
+ *
+ * @param ast The AST, rewritten in place before it is compiled
+ * @return The number of rewrites made
+ */
+size_t rift_regex_simplify_ast(rift_regex_ast_t *ast);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_COMPILER_SIMPLIFY_H */
@@ -0,0 +1,192 @@
+/**
+ * @file utf8_ranges.h
+ * @brief Compilation of Unicode code point ranges into UTF-8 byte ranges
+ *
+ * Automata in LibRift read bytes. To match Unicode classes without decoding
+ * the subject, a range of code points is split into sequences of byte
+ * ranges, one range per UTF-8 byte: [a-é] becomes [a-z] followed by the
+ * two-byte sequences [\xC2-\xC3][\x80-\xBF] trimmed at both ends. The
+ * sequences of one range never overlap, so they compile into plain
+ * alternatives and the DFA keeps running one byte per step.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_COMPILER_UTF8_RANGES_H
+#define LIBRIFT_REGEX_COMPILER_UTF8_RANGES_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Largest Unicode code point
+ */
+#define RIFT_UTF8_MAX_CODEPOINT 0x10FFFF
+
+/**
+ * @brief Largest number of bytes in one UTF-8 encoded code point
+ */
+#define RIFT_UTF8_MAX_LENGTH 4
+
+/**
+ * @brief Largest number of byte sequences one code point range splits into
+ */
+#define RIFT_UTF8_MAX_SEQUENCES 32
+
+/**
+ * @brief Buffer size large enough for any pattern produced by
+ * rift_utf8_format_byte_range()
+ */
+#define RIFT_UTF8_MAX_PATTERN_LENGTH 32
+
+/**
+ * @brief Inclusive range of code points
+ */
+typedef struct rift_utf8_range {
+    uint32_t start; /**< First code point */
+    uint32_t end;   /**< Last code point */
+} rift_utf8_range_t;
+
+/**
+ * @brief Sequence of byte ranges matching the UTF-8 encoding of a code point range
+ */
+typedef struct rift_utf8_sequence {
+    uint8_t length;                      /**< Number of bytes, 1 to 4 */
+    uint8_t start[RIFT_UTF8_MAX_LENGTH]; /**< Smallest value of each byte */
+    uint8_t end[RIFT_UTF8_MAX_LENGTH];   /**< Largest value of each byte */
+} rift_utf8_sequence_t;
+
+/**
+ * @brief Sorted set of disjoint code point ranges
+ */
+typedef struct rift_utf8_range_set {
+    rift_utf8_range_t *ranges; /**< Ranges, sorted and merged by normalize */
+    size_t count;              /**< Number of ranges */
+    size_t capacity;           /**< Allocated number of ranges */
+} rift_utf8_range_set_t;
+
+/**
+ * @brief Decode one UTF-8 encoded code point
+ *
+ * Overlong forms, surrogates and code points above RIFT_UTF8_MAX_CODEPOINT
+ * are rejected.
+ *
+ * @param text The encoded bytes
+ * @param length Number of bytes available
+ * @param codepoint Where to store the code point
+ * @return Number of bytes read, 0 if the bytes are not valid UTF-8
+ */
+size_t rift_utf8_decode(const char *text, size_t length, uint32_t *codepoint);
+
+/**
+ * @brief Encode one code point as UTF-8
+ *
+ * @param codepoint The code point, not a surrogate
+ * @param out Output buffer of RIFT_UTF8_MAX_LENGTH bytes
+ * @return Number of bytes written, 0 if the code point cannot be encoded
+ */
+size_t rift_utf8_encode(uint32_t codepoint, uint8_t *out);
+
+/**
+ * @brief Split a code point range into UTF-8 byte range sequences
+ *
+ * Surrogates are left out. Every encoded code point in the range is matched
+ * by exactly one sequence, and the sequences come in code point order.
+ *
+ * @param start First code point
+ * @param end Last code point
+ * @param out Output array of RIFT_UTF8_MAX_SEQUENCES sequences
+ * @return Number of sequences written
+ */
+size_t rift_utf8_sequences(uint32_t start, uint32_t end, rift_utf8_sequence_t *out);
+
+/**
+ * @brief Format a byte range as a transition pattern
+ *
+ * @param start Smallest byte, not NUL
+ * @param end Largest byte
+ * @param buffer Output buffer of at least RIFT_UTF8_MAX_PATTERN_LENGTH bytes
+ * @return Length of the pattern
+ */
+size_t rift_utf8_format_byte_range(uint8_t start, uint8_t end, char *buffer);
+
+/**
+ * @brief Add a code point range to a set
+ *
+ * @param set The set
+ * @param start First code point
+ * @param end Last code point
+ * @return true if successful, false on allocation failure
+ */
+bool rift_utf8_range_set_add(rift_utf8_range_set_t *set, uint32_t start, uint32_t end);
+
+/**
+ * @brief Sort the ranges of a set and merge the ones that overlap or touch
+ *
+ * @param set The set
+ */
+void rift_utf8_range_set_normalize(rift_utf8_range_set_t *set);
+
+/**
+ * @brief Replace a normalized set by its complement over all code points
+ *
+ * @param set The set
+ * @return true if successful, false on allocation failure
+ */
+bool rift_utf8_range_set_negate(rift_utf8_range_set_t *set);
+
+/**
+ * @brief Free the ranges of a set and empty it
+ *
+ * @param set The set
+ */
+void rift_utf8_range_set_clear(rift_utf8_range_set_t *set);
+
+/**
+ * @brief Check whether a bracket expression needs code point matching
+ *
+ * A class needs it when it is valid UTF-8 and either has a member outside
+ * ASCII or is negated, since a negated class must consume whole characters.
+ *
+ * @param pattern The bracket expression, '[' to ']'
+ * @return true if the class should be compiled with rift_utf8_parse_class()
+ */
+bool rift_utf8_class_needs_ranges(const char *pattern);
+
+/**
+ * @brief Read a UTF-8 bracket expression into a normalized set of code points
+ *
+ * Members follow the same rules as byte bracket expressions: a leading ']'
+ * is a member, backslashes are ordinary and [:name:] classes keep their
+ * ASCII meaning, while ranges and members are whole code points.
+ *
+ * @param pattern The bracket expression, '[' to ']'
+ * @param caseless Whether to add the other case of the members before negating
+ * @param set An empty set to fill
+ * @return true if successful, false if the class is malformed or allocation failed
+ */
+bool rift_utf8_parse_class(const char *pattern, bool caseless, rift_utf8_range_set_t *set);
+
+/**
+ * @brief Read a \\p or \\P escape into a normalized set of code points
+ *
+ * Names are matched ignoring case, spaces, '_' and '-'; \\p{^Name} and
+ * \\P{Name} are negated.
+ *
+ * @param escape The escape text, e.g. "\\p{InGreek}" or "\\PL"
+ * @param caseless Whether to add the other case of the members before negating
+ * @param set An empty set to fill
+ * @return true if successful, false if the property is unknown or allocation failed
+ */
+bool rift_utf8_parse_property(const char *escape, bool caseless, rift_utf8_range_set_t *set);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_COMPILER_UTF8_RANGES_H */
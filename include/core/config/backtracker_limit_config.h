@@ -25,8 +25,23 @@ typedef struct rift_backtrack_limit_config {
     uint64_t max_transitions;           /**< Maximum state transitions */
     rift_backtrack_limit_scope_t scope; /**< Configuration scope */
     bool override_parent;               /**< Whether to override parent scope */
+    uint64_t max_memory_bytes;          /**< Memory budget of a match's engines, 0 for none */
 } rift_backtrack_limit_config_t;
 
+/**
+ * @brief Effective limits after resolving every scope
+ *
+ * A value of 0 means no limit. The generation identifies the registry state
+ * the limits were resolved from, so a holder can tell when they are stale.
+ */
+typedef struct rift_backtrack_limits {
+    uint32_t max_depth;        /**< Maximum backtracking depth */
+    uint32_t max_duration_ms;  /**< Maximum time in milliseconds */
+    uint64_t max_transitions;  /**< Maximum state transitions */
+    uint64_t max_memory_bytes; /**< Memory budget of a match's engines */
+    uint64_t generation;       /**< Registry generation they were resolved from */
+} rift_backtrack_limits_t;
+
 /**
  * @brief Create limit configuration with default values
  * @param scope The scope of this configuration
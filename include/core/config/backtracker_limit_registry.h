@@ -1,8 +1,28 @@
 /**
  * @file backtrack_limit_registry.h
  * @brief Registry for backtracking limit configurations
+ *
+ * Writers are serialized and publish an immutable snapshot of every
+ * registered scope. Readers resolve limits from the current snapshot without
+ * taking a lock, and a matcher resolves its limits once and keeps them inline,
+ * re-resolving only when the registry generation changes.
+ *
+ * The registry also sums the telemetry of matchers that record it, per
+ * pattern identifier, under a lock of its own.
  */
 
+#ifndef LIBRIFT_CORE_CONFIG_BACKTRACKER_LIMIT_REGISTRY_H
+#define LIBRIFT_CORE_CONFIG_BACKTRACKER_LIMIT_REGISTRY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "core/config/backtracker_limit_config.h"
+#include "core/runtime/execution_tracker.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 typedef struct rift_backtrack_limit_registry rift_backtrack_limit_registry_t;
 
 /**
@@ -53,8 +73,85 @@ rift_backtrack_limit_config_t *
 rift_backtrack_limit_registry_get_effective_config(const rift_backtrack_limit_registry_t *registry,
                                                    uint32_t pattern_id, uint32_t match_id);
 
+/**
+ * @brief Resolve the effective limits for a match operation without locking
+ *
+ * Reads the current snapshot only, so it can run concurrently with writers.
+ *
+ * @param registry The registry to query
+ * @param pattern_id Pattern identifier
+ * @param match_id Match operation identifier
+ * @param limits Pointer to store the limits and the generation they came from
+ * @return true if successful, false otherwise
+ */
+bool rift_backtrack_limit_registry_resolve(const rift_backtrack_limit_registry_t *registry,
+                                           uint32_t pattern_id, uint32_t match_id,
+                                           rift_backtrack_limits_t *limits);
+
+/**
+ * @brief Get the generation of the current snapshot
+ *
+ * The generation grows with every change to the registry.
+ *
+ * @param registry The registry to query
+ * @return The generation, or 0 if registry is NULL
+ */
+uint64_t rift_backtrack_limit_registry_get_generation(const rift_backtrack_limit_registry_t *registry);
+
+/**
+ * @brief Add the telemetry of a search to the totals of its pattern
+ *
+ * Matchers call this through a const registry, as recording does not
+ * change the limits.
+ *
+ * @param registry The registry
+ * @param pattern_id Pattern identifier
+ * @param stats The counters to add
+ * @return true if successful, false on invalid parameters or allocation failure
+ */
+bool rift_backtrack_limit_registry_record_stats(const rift_backtrack_limit_registry_t *registry,
+                                                uint32_t pattern_id,
+                                                const rift_match_stats_t *stats);
+
+/**
+ * @brief Get the telemetry totals of a pattern
+ *
+ * @param registry The registry to query
+ * @param pattern_id Pattern identifier
+ * @param stats Pointer to store the totals, cleared for patterns never recorded
+ * @return true if the pattern has recorded telemetry, false otherwise
+ */
+bool rift_backtrack_limit_registry_get_pattern_stats(
+    const rift_backtrack_limit_registry_t *registry, uint32_t pattern_id,
+    rift_match_stats_t *stats);
+
+/**
+ * @brief List the patterns with recorded telemetry
+ *
+ * @param registry The registry to query
+ * @param pattern_ids Array to store the identifiers in increasing order (can be NULL if
+ *                    max_ids is 0)
+ * @param max_ids Number of entries in pattern_ids
+ * @return The number of patterns with telemetry, which may exceed max_ids
+ */
+size_t rift_backtrack_limit_registry_get_stats_patterns(
+    const rift_backtrack_limit_registry_t *registry, uint32_t *pattern_ids, size_t max_ids);
+
+/**
+ * @brief Discard the recorded telemetry of every pattern
+ *
+ * @param registry The registry
+ */
+void rift_backtrack_limit_registry_reset_stats(rift_backtrack_limit_registry_t *registry);
+
 /**
  * @brief Free registry resources
  * @param registry The registry to free
  */
-void rift_backtrack_limit_registry_free(rift_backtrack_limit_registry_t *registry);
\ No newline at end of file
+void rift_backtrack_limit_registry_free(rift_backtrack_limit_registry_t *registry);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_CORE_CONFIG_BACKTRACKER_LIMIT_REGISTRY_H */
@@ -5,6 +5,13 @@
  * This file defines the configuration structures and functions for the
  * LibRift library, including support for regex engine parameters.
  *
+ * The global configuration is an immutable snapshot: every change
+ * publishes a new one atomically, and code that reads the settings while
+ * another thread may change them holds a snapshot with
+ * rift_config_acquire(). Patterns copy the regex settings when they are
+ * compiled and can override them one by one; matchers copy those of their
+ * pattern, so searches read no global state.
+ *
  * @copyright Copyright (c) 2025 LibRift Project
  * @license MIT License
  */
@@ -36,7 +43,8 @@ typedef enum rift_regex_config_param {
     RIFT_REGEX_PARAM_OPTIMIZE_AUTOMATON,    /**< Whether to optimize automaton */
     RIFT_REGEX_PARAM_USE_DFA_WHEN_POSSIBLE, /**< Use DFA when possible */
     RIFT_REGEX_PARAM_ENABLE_RIFT_SYNTAX,    /**< Enable LibRift r'' syntax */
-    RIFT_REGEX_PARAM_MAX_CAPTURE_GROUPS     /**< Maximum number of capture groups */
+    RIFT_REGEX_PARAM_MAX_CAPTURE_GROUPS,    /**< Maximum number of capture groups */
+    RIFT_REGEX_PARAM_GLUSHKOV_NFA           /**< Build epsilon-free Glushkov NFAs when possible */
 } rift_regex_config_param_t;
 
 /**
@@ -51,6 +59,7 @@ typedef struct rift_regex_config {
     bool use_dfa_when_possible;  /**< Use DFA when possible */
     bool enable_rift_syntax;     /**< Enable LibRift r'' syntax */
     size_t max_capture_groups;   /**< Maximum number of capture groups */
+    bool glushkov_nfa;           /**< Build epsilon-free Glushkov NFAs when possible */
 } rift_regex_config_t;
 
 /**
@@ -62,6 +71,9 @@ typedef struct rift_memory_config {
     rift_malloc_func_t custom_malloc;   /**< Custom malloc function */
     rift_realloc_func_t custom_realloc; /**< Custom realloc function */
     rift_free_func_t custom_free;       /**< Custom free function */
+    size_t table_page_threshold;        /**< Tables of at least this many bytes get pages of
+                                             their own (0 = never) */
+    bool table_huge_pages;              /**< Back page-mapped tables with huge pages */
 } rift_memory_config_t;
 
 /**
@@ -89,13 +101,36 @@ rift_status_t rift_config_cleanup(void);
 /**
  * @brief Get the global configuration
  *
- * @return Pointer to the global configuration instance
+ * The snapshot is not held: it stays valid only until the configuration
+ * next changes. Use rift_config_acquire() where a change may run concurrently.
+ *
+ * @return Pointer to the current configuration snapshot
  */
 const rift_config_t *rift_config_get(void);
 
+/**
+ * @brief Take a reference to the current configuration snapshot
+ *
+ * The snapshot never changes and stays valid until released, whatever
+ * later changes publish.
+ *
+ * @return The snapshot, to be released with rift_config_release()
+ */
+const rift_config_t *rift_config_acquire(void);
+
+/**
+ * @brief Release a snapshot taken with rift_config_acquire()
+ *
+ * @param config The snapshot (can be NULL)
+ */
+void rift_config_release(const rift_config_t *config);
+
 /**
  * @brief Set configuration values
  *
+ * Publishes a copy of the values as the new snapshot. Patterns compiled
+ * before keep the regex settings they copied.
+ *
  * @param config Pointer to configuration values to set
  * @return RIFT_OK on success, error code on failure
  */
@@ -108,6 +143,28 @@ rift_status_t rift_config_set(const rift_config_t *config);
  */
 rift_status_t rift_config_reset(void);
 
+/**
+ * @brief Get a parameter of a regex configuration
+ *
+ * @param config The regex configuration, such as a pattern's
+ * @param param The parameter to get
+ * @param value Pointer to store the value, of the parameter's type
+ * @return RIFT_OK on success, error code on failure
+ */
+rift_status_t rift_regex_config_get_param(const rift_regex_config_t *config,
+                                          rift_regex_config_param_t param, void *value);
+
+/**
+ * @brief Set a parameter of a regex configuration
+ *
+ * @param config The regex configuration
+ * @param param The parameter to set
+ * @param value Pointer to the value, of the parameter's type
+ * @return RIFT_OK on success, error code on failure
+ */
+rift_status_t rift_regex_config_set_param(rift_regex_config_t *config,
+                                          rift_regex_config_param_t param, const void *value);
+
 /**
  * @brief Get a specific regex configuration parameter
  *
@@ -66,9 +66,11 @@ bool rift_dsl_test_get_stats(void *handle, size_t *total, size_t *passed, size_t
 bool rift_dsl_test_all_passed(void *handle);
 
 /* Functions from rift_dsl_io.c */
+bool rift_dsl_set_cache_dir(const char *directory);
 void *rift_dsl_compile_to_binary(const char *source);
 void *rift_dsl_load_compile_to_binary(const char *filename);
 void rift_dsl_binary_free(void *handle);
+bool rift_dsl_binary_is_cached(void *handle);
 const char *rift_dsl_binary_get_error(void *handle);
 bool rift_dsl_binary_save(void *handle, const char *filename);
 void *rift_dsl_binary_load(const char *filename);
@@ -12,7 +12,11 @@
 #include <stdint.h>
 #include <stddef.h>
 #include <stdbool.h>
+#include "core/automaton/dfa_table.h"
 #include "core/bytecode/bytecode.h"
+#include "core/compiler/ambiguity.h"
+#include "core/compiler/prefilter.h"
+#include "core/dsl/rift_dsl_profile.h"
 #include "core/errors/regex_error.h"
 #ifndef RIFT_DSL_COMPILER_H
 #define RIFT_DSL_COMPILER_H
@@ -23,14 +27,119 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Timings of a DSL compilation, taken with the monotonic clock
+ *
+ * The per-stage times are summed over the patterns, so with several threads
+ * they add up to more than compile_ns.
+ */
+typedef struct rift_dsl_compile_stats {
+    uint64_t parse_ns;    /**< Parsing the DSL source */
+    uint64_t compile_ns;  /**< Wall time of compiling every pattern */
+    uint64_t pattern_ns;  /**< Parsing the patterns and building their automata */
+    uint64_t counters_ns; /**< Rebuilding NFAs with counted repeats */
+    uint64_t codegen_ns;  /**< Generating and optimizing the bytecode */
+    size_t num_patterns;  /**< Patterns compiled */
+    size_t num_threads;   /**< Threads that compiled, including the caller's */
+    size_t num_shards;    /**< Rule unions rift_dsl_execute_all scans */
+    size_t num_pruned;    /**< Redundant rules left out of the compilation */
+} rift_dsl_compile_stats_t;
+
+/**
+ * @brief Estimated DFA states of a rule union when no budget is given
+ */
+#define RIFT_DSL_DEFAULT_SHARD_STATES 4096
+
+/**
+ * @brief A rule matching nothing that a rule kept in the ruleset does not match
+ *
+ * A rule is redundant when the strings it accepts are all accepted by
+ * another rule: a duplicate of an earlier rule, or a rule strictly included
+ * in another one. Since programs match at the start of the input, whatever
+ * input the redundant rule matches, the covering rule matches too.
+ */
+typedef struct rift_dsl_redundancy {
+    size_t index;          /**< Source index of the redundant rule */
+    size_t covered_by;     /**< Source index of a kept rule accepting all it accepts */
+    char *name;            /**< Name of the redundant rule */
+    char *covered_by_name; /**< Name of the covering rule */
+    bool duplicate;        /**< Whether both rules accept exactly the same strings */
+} rift_dsl_redundancy_t;
+
+/**
+ * @brief Redundant rules found while compiling a ruleset
+ *
+ * Only rules given a minimized DFA table are compared, see
+ * rift_dsl_get_dfa_table; the others are always kept. When the redundant
+ * rules are pruned, the programs of the compilation are those of the kept
+ * rules in source order.
+ */
+typedef struct rift_dsl_lint {
+    rift_dsl_redundancy_t *redundancies; /**< Redundant rules in source order */
+    size_t count;                        /**< Number of redundant rules */
+    size_t num_compared;                 /**< Rules whose languages were compared */
+} rift_dsl_lint_t;
+
+/**
+ * @brief Options of a DSL compilation
+ */
+typedef struct rift_dsl_compile_options {
+    size_t num_threads;                /**< Threads including the caller's, 0 for one per CPU */
+    rift_dsl_compile_stats_t *stats;   /**< Filled when the compilation ends (can be NULL) */
+    size_t shard_states;               /**< Estimated DFA states per rule union, 0 for default */
+    const rift_dsl_profile_t *profile; /**< Match profile of the rules (can be NULL) */
+    rift_dsl_lint_t *lint;             /**< Filled with the redundant rules (can be NULL) */
+    bool prune_redundant;              /**< Leave the redundant rules out of the compilation */
+} rift_dsl_compile_options_t;
+
+/**
+ * @brief Free the redundancies of a lint report
+ *
+ * @param lint The report, emptied (can be NULL)
+ */
+void rift_dsl_lint_free(rift_dsl_lint_t *lint);
+
 /**
  * @brief Compile a .rift DSL source to bytecode
  * 
+ * The patterns are compiled on one thread per CPU; see
+ * rift_dsl_compile_with_options.
+ *
  * @param source The .rift DSL source code
  * @return Opaque handle to compiled bytecode or NULL on error
  */
 void *rift_dsl_compile(const char *source);
 
+/**
+ * @brief Compile a .rift DSL source to bytecode on several threads
+ *
+ * Patterns compile independently, so they are shared out among the threads,
+ * but the programs keep the order of the patterns in the source. If a
+ * pattern fails, the compilation holds the programs of the patterns before
+ * it and the error of the first failing one, as when compiling in order.
+ *
+ * @param source The .rift DSL source code
+ * @param options Options of the compilation (can be NULL for the defaults)
+ * @return Opaque handle to compiled bytecode or NULL on error
+ */
+void *rift_dsl_compile_with_options(const char *source, const rift_dsl_compile_options_t *options);
+
+/**
+ * @brief Compile a .rift DSL file, compiling patterns while the file is parsed
+ *
+ * The file is mapped and parsed as a stream on the calling thread, and each
+ * pattern goes to the other threads as soon as it is parsed, so compiling
+ * overlaps parsing. The parser runs at most a few patterns per thread ahead
+ * of the compilers, which bounds the memory taken besides the programs. The
+ * result is the one rift_dsl_compile_with_options gives for the contents of
+ * the file; parse_ns in the stats then overlaps compile_ns.
+ *
+ * @param filename The .rift DSL file
+ * @param options Options of the compilation (can be NULL for the defaults)
+ * @return Opaque handle to compiled bytecode or NULL if the file cannot be read
+ */
+void *rift_dsl_compile_file(const char *filename, const rift_dsl_compile_options_t *options);
+
 /**
  * @brief Free a compilation handle
  * 
@@ -63,9 +172,77 @@ size_t rift_dsl_get_compiled_count(void *handle);
  */
 const rift_bytecode_program_t *rift_dsl_get_compiled_program(void *handle, size_t index);
 
+/**
+ * @brief Get the time taken to compile a program
+ *
+ * Only compilations built from source know it; deserialized and mapped
+ * ones give 0.
+ *
+ * @param handle The compilation handle
+ * @param index Program index
+ * @return Nanoseconds of wall time, 0 if unknown or the index is invalid
+ */
+uint64_t rift_dsl_get_compile_ns(void *handle, size_t index);
+
+/**
+ * @brief Get the minimized DFA table of a program
+ *
+ * Patterns without anchors, word boundaries, atomic groups, lookarounds or
+ * backreferences are determinized and minimized once when compiled; such a
+ * program is then run on its table when no match details are asked for.
+ *
+ * @param handle The compilation handle
+ * @param index Program index
+ * @return The table, or NULL if the program has none or the index is invalid
+ */
+const rift_dfa_table_t *rift_dsl_get_dfa_table(void *handle, size_t index);
+
+/**
+ * @brief Get the prefilter of a program
+ *
+ * @param handle The compilation handle
+ * @param index Program index
+ * @return The prefilter, or NULL if none was computed or the index is invalid
+ */
+const rift_prefilter_t *rift_dsl_get_prefilter(void *handle, size_t index);
+
+/**
+ * @brief Get the name of a compiled program
+ *
+ * Only compilations built from source know it; deserialized and mapped
+ * ones give NULL.
+ *
+ * @param handle The compilation handle
+ * @param index Program index
+ * @return The name, or NULL if unknown or the index is invalid
+ */
+const char *rift_dsl_get_compiled_name(void *handle, size_t index);
+
+/**
+ * @brief Get the number of rule shards of a compilation
+ *
+ * @param handle The compilation handle
+ * @return Number of rule unions rift_dsl_execute_all scans, 0 if none
+ */
+size_t rift_dsl_get_shard_count(void *handle);
+
+/**
+ * @brief Get the static ambiguity verdict of a program
+ *
+ * @param handle The compilation handle
+ * @param index Program index
+ * @param verdict Verdict to fill in
+ * @return true if the verdict is known, false otherwise
+ */
+bool rift_dsl_get_ambiguity(void *handle, size_t index, rift_ambiguity_verdict_t *verdict);
+
 /**
  * @brief Serialize a compilation to binary data
  * 
+ * The programs are followed by the DFA tables, prefilters and ambiguity
+ * verdicts, so a deserialized compilation needs no determinization. Readers
+ * that predate that section ignore it.
+ * 
  * @param handle The compilation handle
  * @param data Pointer to receive the serialized data
  * @param size Pointer to receive the size of the serialized data
@@ -82,6 +259,48 @@ bool rift_dsl_serialize_compilation(void *handle, uint8_t **data, size_t *size);
  */
 void *rift_dsl_deserialize_compilation(const uint8_t *data, size_t size);
 
+/**
+ * @brief Write a compilation as a memory-mappable bytecode container
+ *
+ * Unlike rift_dsl_serialize_compilation, the output can be executed in place
+ * once mapped with rift_dsl_map_compilation.
+ *
+ * @param handle The compilation handle
+ * @param data Pointer to receive the container bytes, freed with free()
+ * @param size Pointer to receive the size of the container
+ * @return true if successful, false otherwise
+ */
+bool rift_dsl_serialize_container(void *handle, uint8_t **data, size_t *size);
+
+/**
+ * @brief Open a compilation by mapping a container file read-only
+ *
+ * The header and checksum are validated when the file is mapped. Programs
+ * are unpacked on first use and otherwise run from the mapped pages, which
+ * processes mapping the same file share. Like a deserialized compilation,
+ * it has no rule union, so rift_dsl_execute_all runs each program.
+ *
+ * @param filename Path of a file holding rift_dsl_serialize_container output
+ * @return Compilation handle, holding the error if the file cannot be mapped,
+ *         or NULL on error
+ */
+void *rift_dsl_map_compilation(const char *filename);
+
+/**
+ * @brief Open a compilation from container bytes already in memory
+ *
+ * Works like rift_dsl_map_compilation on a buffer the caller fetched or
+ * read, such as a ruleset shipped as one asset. Programs run from the
+ * buffer in place, so it must stay valid and unchanged until the
+ * compilation is freed.
+ *
+ * @param data Bytes written by rift_dsl_serialize_container, aligned to 8 bytes
+ * @param size Number of bytes
+ * @return Compilation handle, holding the error if the bytes are not a valid
+ *         container, or NULL on error
+ */
+void *rift_dsl_load_container(const uint8_t *data, size_t size);
+
 /**
  * @brief Execute a compiled program on input text
  * 
@@ -95,6 +314,147 @@ void *rift_dsl_deserialize_compilation(const uint8_t *data, size_t size);
 bool rift_dsl_execute(void *handle, size_t index, const char *input, 
 					 size_t input_length, rift_regex_match_t *match);
 
+/**
+ * @brief Execute a compiled program on each of several inputs
+ *
+ * Each input matches as with rift_dsl_execute. When the program has a DFA
+ * table, the inputs the prefilter lets through are scanned
+ * RIFT_DFA_INTERLEAVE at a time in lockstep, which hides the latency of the
+ * table loads on tables larger than the cache.
+ *
+ * @param handle The compilation handle
+ * @param index Program index
+ * @param inputs Input texts
+ * @param lengths Lengths of the input texts, NULL to use strlen
+ * @param count Number of inputs
+ * @param results Array of count results to fill
+ * @return Number of inputs the program matched
+ */
+size_t rift_dsl_execute_batch(void *handle, size_t index, const char *const *inputs,
+                              const size_t *lengths, size_t count, bool *results);
+
+/**
+ * @brief Check whether a compiled program matches input text
+ *
+ * Answers as rift_dsl_execute does without match details, but a program
+ * with a DFA table stops at its first accepting state instead of looking
+ * for the longest match.
+ *
+ * @param handle The compilation handle
+ * @param index Program index
+ * @param input Input text
+ * @param input_length Length of input text or (size_t)-1 to use strlen
+ * @return true if match found, false otherwise
+ */
+bool rift_dsl_is_match(void *handle, size_t index, const char *input, size_t input_length);
+
+/**
+ * @brief Count the matches of a compiled program in input text
+ *
+ * The program is run at the start of the input and, after each match,
+ * again where the match ends, or one byte further after an empty match or
+ * none. Programs with a DFA table run on it; the others on the VM, without
+ * match details.
+ *
+ * @param handle The compilation handle
+ * @param index Program index
+ * @param input Input text
+ * @param input_length Length of input text or (size_t)-1 to use strlen
+ * @return Number of non-empty matches, 0 on invalid parameters
+ */
+size_t rift_dsl_count(void *handle, size_t index, const char *input, size_t input_length);
+
+/**
+ * @brief Execute a compiled program on the VM and record the search in a profile
+ *
+ * Unlike rift_dsl_execute, the program always runs on the VM, so the steps
+ * recorded are what the search costs without a DFA table or prefilter. The
+ * search is recorded under the program's name, and only for compilations
+ * that know it; the profile is then passed to a later compilation in
+ * rift_dsl_compile_options_t.
+ *
+ * @param handle The compilation handle
+ * @param index Program index
+ * @param input Input text
+ * @param input_length Length of input text or (size_t)-1 to use strlen
+ * @param match Pointer to match structure to fill (can be NULL)
+ * @param profile Profile to record the search in
+ * @return true if match found, false otherwise
+ */
+bool rift_dsl_execute_profiled(void *handle, size_t index, const char *input, size_t input_length,
+                               rift_regex_match_t *match, rift_dsl_profile_t *profile);
+
+/**
+ * @brief Callback receiving a program that matched in rift_dsl_execute_all
+ *
+ * @param index Index of the matching program
+ * @param user_data The pointer given to rift_dsl_execute_all
+ * @return true to go on with the next programs, false to stop
+ */
+typedef bool (*rift_dsl_match_callback_t)(size_t index, void *user_data);
+
+/**
+ * @brief Execute every compiled program on input text
+ *
+ * A program matches as with rift_dsl_execute. Programs whose patterns have
+ * no anchors, word boundaries, atomic groups or lookarounds are split into
+ * shards whose union DFA is estimated to stay within the shard_states budget
+ * of the compilation; each shard is answered by one pass of a lazy DFA over
+ * the union of its automata, taken when the first of its programs comes up.
+ * The others run on the VM one by one. A deserialized compilation has no
+ * union and runs every program on its own.
+ *
+ * @param handle The compilation handle
+ * @param input Input text
+ * @param input_length Length of input text
+ * @param callback Function called for each matching program in index order (can be NULL)
+ * @param user_data Pointer passed to the callback
+ * @return Number of matching programs reported to the callback
+ */
+size_t rift_dsl_execute_all(void *handle, const char *input, size_t input_length,
+                            rift_dsl_match_callback_t callback, void *user_data);
+
+/**
+ * @brief Get the number of rule combinations of a compilation
+ *
+ * Each @combine directive of the source compiles to a formula over the
+ * programs it names; see rift_dsl_formula.h. Only compilations built from
+ * source have them; deserialized and mapped ones give 0.
+ *
+ * @param handle The compilation handle
+ * @return Number of combinations
+ */
+size_t rift_dsl_get_compiled_combination_count(void *handle);
+
+/**
+ * @brief Get the name of a rule combination
+ *
+ * @param handle The compilation handle
+ * @param index Combination index
+ * @return The name, or NULL if the index is invalid
+ */
+const char *rift_dsl_get_compiled_combination_name(void *handle, size_t index);
+
+/**
+ * @brief Evaluate every rule combination on each of several inputs
+ *
+ * Each input runs through rift_dsl_execute_all once, so every rule is
+ * matched in one pass of its shard whatever the number of combinations
+ * naming it. The matches of a few hundred inputs at a time are kept
+ * bit-sliced, one bit per input, and each formula is evaluated for all of
+ * them with a few word operations per step. Rules match as with
+ * rift_dsl_execute, and a NULL input matches none.
+ *
+ * @param handle The compilation handle
+ * @param inputs Input texts
+ * @param lengths Lengths of the input texts, NULL to use strlen
+ * @param count Number of inputs
+ * @param results Array of combinations * count results, those of combination c at c * count
+ * @return Number of results that are true
+ */
+size_t rift_dsl_execute_combinations(void *handle, const char *const *inputs,
+                                     const size_t *lengths, size_t count, bool *results);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,159 @@
+/**
+ * @file rift_dsl_extract.h
+ * @brief Two-phase extraction of the capture groups of matching .rift rules
+ *
+ * Running a capture engine for every rule on every input costs inputs times
+ * rules, although most inputs match few rules. An extraction plan splits the
+ * work: rift_dsl_execute_all first finds the rules an input matches, in one
+ * pass of each rule shard, and only for those rules does a matcher pick the
+ * one-pass, tagged DFA or Pike VM engine to fill the groups.
+ *
+ * Rules match at the start of the input, so every match starts at 0. For a
+ * rule with a minimized DFA table, the table's longest accepted prefix
+ * bounds where the match can end, and the capture engine only reads up to
+ * there. Such rules have no anchors, word boundaries or lookarounds, so the
+ * input past that point cannot change the match.
+ *
+ * A plan is built once per compilation and is only read afterwards, so
+ * threads share it. Each thread extracts through an extractor of its own,
+ * which keeps the matchers of the rules it has seen between inputs. Group
+ * values are spans into the input and own no memory.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_DSL_EXTRACT_H
+#define LIBRIFT_DSL_EXTRACT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "core/compiler/group_names.h"
+#include "core/errors/regex_error.h"
+#include "core/runtime/match_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Capture patterns of the rules of a compilation
+ */
+typedef struct rift_dsl_extract_plan rift_dsl_extract_plan_t;
+
+/**
+ * @brief Per-thread state of extraction with a plan
+ */
+typedef struct rift_dsl_extractor rift_dsl_extractor_t;
+
+/**
+ * @brief Groups of one matching rule
+ */
+typedef struct rift_dsl_extraction {
+    size_t rule;                    /**< Index of the rule in the compilation */
+    const rift_regex_span_t *spans; /**< spans[0] the match, spans[1 + i] group i */
+    size_t num_spans;               /**< Number of spans */
+} rift_dsl_extraction_t;
+
+/**
+ * @brief Callback receiving the groups of each matching rule
+ *
+ * The spans are only valid during the call.
+ *
+ * @param extraction The rule and its spans
+ * @param user_data User data given to rift_dsl_extract
+ * @return true to continue with the next matching rule, false to stop
+ */
+typedef bool (*rift_dsl_extract_callback_t)(const rift_dsl_extraction_t *extraction,
+                                            void *user_data);
+
+/**
+ * @brief Build the extraction plan of a compilation
+ *
+ * The pattern of every rule with capture groups is compiled again as a
+ * regex pattern. A rule whose pattern cannot be compiled is left to the
+ * bytecode VM, which reports its match without groups.
+ *
+ * @param compilation The compilation, which must outlive the plan
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new plan or NULL on failure
+ */
+rift_dsl_extract_plan_t *rift_dsl_extract_plan_create(void *compilation,
+                                                      rift_regex_error_t *error);
+
+/**
+ * @brief Free an extraction plan
+ *
+ * No extractor may use the plan any longer.
+ *
+ * @param plan The plan (can be NULL)
+ */
+void rift_dsl_extract_plan_free(rift_dsl_extract_plan_t *plan);
+
+/**
+ * @brief Get the number of spans extracted for a rule
+ *
+ * @param plan The plan
+ * @param rule Index of the rule
+ * @return One more than the number of groups of the rule, 1 for a rule left
+ *         to the VM, 0 for an invalid rule
+ */
+size_t rift_dsl_extract_plan_span_count(const rift_dsl_extract_plan_t *plan, size_t rule);
+
+/**
+ * @brief Find the span of a named group of a rule
+ *
+ * Resolving the names once and reading the spans by index afterwards keeps
+ * the lookups out of the loop over the inputs.
+ *
+ * @param plan The plan
+ * @param rule Index of the rule
+ * @param name The group name
+ * @return Index of the group's span, from 1, or RIFT_GROUP_NO_INDEX if the
+ *         rule has no group with that name
+ */
+size_t rift_dsl_extract_plan_group_index(const rift_dsl_extract_plan_t *plan, size_t rule,
+                                         const char *name);
+
+/**
+ * @brief Get the number of rules whose groups a plan extracts with a regex matcher
+ *
+ * @param plan The plan
+ * @return Number of rules not left to the VM
+ */
+size_t rift_dsl_extract_plan_capture_count(const rift_dsl_extract_plan_t *plan);
+
+/**
+ * @brief Create an extractor for one thread
+ *
+ * @param plan The plan, which must outlive the extractor
+ * @return A new extractor or NULL on failure
+ */
+rift_dsl_extractor_t *rift_dsl_extractor_create(const rift_dsl_extract_plan_t *plan);
+
+/**
+ * @brief Free an extractor and its matchers
+ *
+ * @param extractor The extractor (can be NULL)
+ */
+void rift_dsl_extractor_free(rift_dsl_extractor_t *extractor);
+
+/**
+ * @brief Extract the groups of every rule an input matches
+ *
+ * The callback gets the rules in index order.
+ *
+ * @param extractor The extractor
+ * @param input The input
+ * @param input_length Length of the input
+ * @param callback Function called for each matching rule (can be NULL)
+ * @param user_data Pointer passed to the callback
+ * @return Number of matching rules reported
+ */
+size_t rift_dsl_extract(rift_dsl_extractor_t *extractor, const char *input, size_t input_length,
+                        rift_dsl_extract_callback_t callback, void *user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_DSL_EXTRACT_H */
@@ -0,0 +1,130 @@
+/**
+ * @file rift_dsl_formula.h
+ * @brief Boolean formulas over the rules of a .rift file
+ *
+ * A @combine directive names a boolean expression over other rules, such as
+ * "Login & Admin & !Internal". Rather than matching each rule it names, the
+ * expression is compiled to a formula over the bitmap of the rules an input
+ * matched, which one scan of the rule unions fills for every rule at once.
+ *
+ * Expressions use the operators '!', '&' and '|', or the words "not", "and"
+ * and "or", binding in that order, and parentheses; the operands are rule
+ * names. A formula is a postfix program of bitwise operations, so it can
+ * also run bit-sliced: given, for each rule, a word whose bit i tells
+ * whether the rule matched input i, one pass evaluates it for 64 inputs per
+ * word, over blocks of words the compiler vectorizes.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_DSL_FORMULA_H
+#define LIBRIFT_DSL_FORMULA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Deepest operand stack a formula may need, bounding the nesting of expressions
+ */
+#define RIFT_DSL_FORMULA_MAX_STACK 64
+
+/**
+ * @brief Words of 64 inputs evaluated together by rift_dsl_formula_eval_lanes
+ */
+#define RIFT_DSL_FORMULA_BLOCK_WORDS 4
+
+/**
+ * @brief Operations of a formula
+ */
+typedef enum rift_dsl_formula_op {
+    RIFT_DSL_FORMULA_RULE, /**< Push whether a rule matched */
+    RIFT_DSL_FORMULA_NOT,  /**< Negate the top of the stack */
+    RIFT_DSL_FORMULA_AND,  /**< Replace the two top entries by their conjunction */
+    RIFT_DSL_FORMULA_OR    /**< Replace the two top entries by their disjunction */
+} rift_dsl_formula_op_t;
+
+/**
+ * @brief One operation of a formula
+ */
+typedef struct rift_dsl_formula_step {
+    rift_dsl_formula_op_t op; /**< The operation */
+    uint32_t rule;            /**< Rule pushed by RIFT_DSL_FORMULA_RULE */
+} rift_dsl_formula_step_t;
+
+/**
+ * @brief Boolean formula compiled to a postfix program
+ */
+typedef struct rift_dsl_formula {
+    rift_dsl_formula_step_t *steps; /**< Operations in postfix order */
+    size_t num_steps;               /**< Number of operations */
+    size_t max_stack;               /**< Deepest the operand stack gets */
+} rift_dsl_formula_t;
+
+/**
+ * @brief Callback resolving a rule name of an expression
+ *
+ * @param name The name, not null-terminated
+ * @param length Length of the name
+ * @param rule Pointer to store the rule, an index into the match bitmaps
+ * @param user_data User data given to rift_dsl_formula_compile
+ * @return true if the rule exists, false otherwise
+ */
+typedef bool (*rift_dsl_formula_resolver_t)(const char *name, size_t length, uint32_t *rule,
+                                            void *user_data);
+
+/**
+ * @brief Compile a boolean expression over rule names
+ *
+ * @param formula Formula to fill, freed with rift_dsl_formula_destroy on success
+ * @param expression The expression
+ * @param resolver Callback resolving each rule name
+ * @param user_data User data for the resolver
+ * @param error Buffer for the error message (can be NULL)
+ * @param error_size Size of the error buffer
+ * @return true if successful, false on a syntax error, an unknown rule, an
+ *         expression nested too deeply or allocation failure
+ */
+bool rift_dsl_formula_compile(rift_dsl_formula_t *formula, const char *expression,
+                              rift_dsl_formula_resolver_t resolver, void *user_data, char *error,
+                              size_t error_size);
+
+/**
+ * @brief Free the program of a formula
+ *
+ * @param formula The formula, emptied (can be NULL)
+ */
+void rift_dsl_formula_destroy(rift_dsl_formula_t *formula);
+
+/**
+ * @brief Evaluate a formula on the match bitmap of one input
+ *
+ * @param formula The formula
+ * @param matched Bitmap with bit r set when rule r matched, covering every rule of the formula
+ * @return The value of the formula
+ */
+bool rift_dsl_formula_matches(const rift_dsl_formula_t *formula, const uint64_t *matched);
+
+/**
+ * @brief Evaluate a formula on the bit-sliced matches of many inputs
+ *
+ * Bit b of word w of a rule tells whether the rule matched input 64 * w + b.
+ * Bits past the last input may be set in the output.
+ *
+ * @param formula The formula
+ * @param lanes Words of each rule in turn, num_words per rule
+ * @param num_words Number of words per rule
+ * @param out Array of num_words words for the value of the formula on each input
+ */
+void rift_dsl_formula_eval_lanes(const rift_dsl_formula_t *formula, const uint64_t *lanes,
+                                 size_t num_words, uint64_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_DSL_FORMULA_H */
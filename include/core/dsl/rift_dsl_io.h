@@ -20,14 +20,63 @@
 extern "C" {
 #endif
 
+/* Forward declaration for the options type of core/dsl/rift_dsl_compiler.h */
+struct rift_dsl_compile_options;
+
+/**
+ * @brief Set the directory caching compiled binaries
+ *
+ * While a directory is set, rift_dsl_compile_to_binary and
+ * rift_dsl_load_compile_to_binary store each binary they compile there,
+ * named by a hash of the source, the library version, the binary format and
+ * the byte order and word size of the machine. A later compilation of the
+ * same source reads the file back instead of compiling; a file that does
+ * not match in full is compiled anew and replaced. Files are renamed into
+ * place once written, so processes may share the directory.
+ *
+ * @param directory The directory, created if missing, or NULL to stop caching
+ * @return true if successful, false otherwise
+ */
+bool rift_dsl_set_cache_dir(const char *directory);
+
 /**
  * @brief Compile a .rift DSL source to binary format
  * 
+ * See rift_dsl_set_cache_dir for the cache.
+ *
  * @param source The .rift DSL source code
  * @return Opaque handle to binary data or NULL on error
  */
 void *rift_dsl_compile_to_binary(const char *source);
 
+/**
+ * @brief Compile a .rift DSL source to a memory-mappable container
+ *
+ * The binary is saved with rift_dsl_binary_save and opened with
+ * rift_dsl_compilation_map; the other binary functions expect the format of
+ * rift_dsl_compile_to_binary. Containers are cached like binaries; see
+ * rift_dsl_set_cache_dir.
+ *
+ * @param source The .rift DSL source code
+ * @return Opaque handle to binary data or NULL on error
+ */
+void *rift_dsl_compile_to_container(const char *source);
+
+/**
+ * @brief Compile a .rift DSL source to a memory-mappable container with options
+ *
+ * As rift_dsl_compile_to_container, compiling as rift_dsl_compile_with_options
+ * does. A container read from the cache is not compiled, so the stats of the
+ * options are then cleared. If a pattern fails, the binary data holds no
+ * bytes and rift_dsl_binary_get_error gives the error.
+ *
+ * @param source The .rift DSL source code
+ * @param options Options of the compilation (can be NULL for the defaults)
+ * @return Opaque handle to binary data or NULL on error
+ */
+void *rift_dsl_compile_to_container_with_options(const char *source,
+                                                 const struct rift_dsl_compile_options *options);
+
 /**
  * @brief Load a .rift file and compile it to binary format
  * 
@@ -43,6 +92,14 @@ void *rift_dsl_load_compile_to_binary(const char *filename);
  */
 void rift_dsl_binary_free(void *handle);
 
+/**
+ * @brief Check whether binary data was read from the cache directory
+ *
+ * @param handle The binary data handle
+ * @return true if the binary came from the cache, false otherwise
+ */
+bool rift_dsl_binary_is_cached(void *handle);
+
 /**
  * @brief Get error message from binary data
  * 
@@ -86,6 +143,16 @@ bool rift_dsl_binary_get_data(void *handle, const uint8_t **data, size_t *size);
  */
 void *rift_dsl_compilation_from_binary(void *handle);
 
+/**
+ * @brief Create a compilation handle by mapping a container file
+ *
+ * The file is neither read nor copied; see rift_dsl_map_compilation.
+ *
+ * @param filename Path to a file saved from rift_dsl_compile_to_container
+ * @return Compilation handle or NULL on error
+ */
+void *rift_dsl_compilation_map(const char *filename);
+
 /**
  * @brief Validate binary data
  * 
@@ -30,6 +30,7 @@ typedef enum {
 	RIFT_DSL_TOKEN_RBRACKET,
 	RIFT_DSL_TOKEN_COMMA,
 	RIFT_DSL_TOKEN_COMMENT,
+	RIFT_DSL_TOKEN_NUMBER,
 	RIFT_DSL_TOKEN_EOF
 } rift_dsl_token_type_t;
 
@@ -77,6 +78,7 @@ typedef struct {
 	bool expect_match;
 	char **match_groups;
 	size_t group_count;
+	size_t pattern_index;
 } rift_dsl_test_case_t;
 
 /**
@@ -87,12 +89,66 @@ typedef struct rift_dsl_test_case_list {
 	rift_dsl_test_case_t test_case;
 } rift_dsl_test_case_list_t;
 
+/**
+ * @brief Iterations of a benchmark that gives none
+ */
+#define RIFT_DSL_BENCH_DEFAULT_ITERATIONS 100
+
+/**
+ * @brief Structure representing a benchmark in the .rift DSL
+ *
+ * A benchmark times a pattern on an inline input or on the files matching
+ * a corpus glob. Unless given, the warm-up is a tenth of the iterations.
+ */
+typedef struct {
+	char *pattern_name;   /**< Name given in the file, NULL for the pattern defined last */
+	size_t pattern_index; /**< Index of the timed pattern */
+	char *input;          /**< Inline input, NULL with a corpus */
+	char *corpus;         /**< Glob of the input files, NULL with an inline input */
+	size_t iterations;    /**< Timed passes over the input */
+	size_t warmup;        /**< Untimed passes before the timed ones */
+} rift_dsl_bench_t;
+
+/**
+ * @brief Structure representing a list of benchmarks in the .rift DSL
+ */
+typedef struct rift_dsl_bench_list {
+	struct rift_dsl_bench_list *next;
+	rift_dsl_bench_t bench;
+} rift_dsl_bench_list_t;
+
+/**
+ * @brief Structure representing a rule combination in the .rift DSL
+ *
+ * A combination is a boolean expression over the names of the patterns,
+ * compiled to a formula by the DSL compiler; see rift_dsl_formula.h.
+ */
+typedef struct rift_dsl_combination_struct {
+	struct rift_dsl_combination_struct *next;
+	char *name;       /**< Name of the combination */
+	char *expression; /**< Boolean expression over pattern names */
+} rift_dsl_combination_t;
+
 /**
  * @brief Structure representing a parsed .rift DSL file
  */
 typedef struct {
 	rift_dsl_pattern_t *patterns;
+	rift_dsl_pattern_t *last_pattern;
+	size_t pattern_count;
 	rift_dsl_test_case_list_t *test_cases;
+	rift_dsl_test_case_list_t *last_test_case;
+	size_t test_case_count;
+	rift_dsl_pattern_t *pattern_cursor;
+	size_t pattern_cursor_index;
+	rift_dsl_test_case_list_t *test_case_cursor;
+	size_t test_case_cursor_index;
+	rift_dsl_bench_list_t *benches;
+	rift_dsl_bench_list_t *last_bench;
+	size_t bench_count;
+	rift_dsl_combination_t *combinations;
+	rift_dsl_combination_t *last_combination;
+	size_t combination_count;
 	bool has_error;
 	char *error_message;
 } rift_dsl_file_t;
@@ -113,6 +169,53 @@ void *rift_dsl_parse(const char *source);
  */
 void *rift_dsl_load_file(const char *filename);
 
+/**
+ * @brief Callback taking each pattern of a streamed .rift DSL file
+ *
+ * The strings belong to the parser and are freed once the callback returns.
+ *
+ * @param name Name of the pattern
+ * @param pattern Pattern string
+ * @param flags Names of the flags of the pattern
+ * @param flag_count Number of flags
+ * @param user_data User data given to the parser
+ * @return true to go on parsing, false to stop with an error
+ */
+typedef bool (*rift_dsl_pattern_callback_t)(const char *name, const char *pattern,
+                                            char *const *flags, size_t flag_count,
+                                            void *user_data);
+
+/**
+ * @brief Parse a .rift DSL source, handing each pattern to a callback
+ *
+ * A pattern is handed over as soon as its flags are known, when the next
+ * pattern starts or the source ends, and is not kept. The handle holds the
+ * test cases and the error of the file but no patterns. On an error the
+ * patterns before it have already been handed over.
+ *
+ * @param source The source bytes, not necessarily null-terminated
+ * @param length Length of the source
+ * @param callback Callback taking each pattern
+ * @param user_data User data for the callback
+ * @return Handle to the parsed DSL file or NULL on error
+ */
+void *rift_dsl_parse_stream(const char *source, size_t length, rift_dsl_pattern_callback_t callback,
+                            void *user_data);
+
+/**
+ * @brief Map a .rift DSL file from disk and parse it as a stream
+ *
+ * The file is mapped instead of read into a buffer, so its pages are only
+ * brought in as the parser reaches them; see rift_dsl_parse_stream.
+ *
+ * @param filename The path to the file to load
+ * @param callback Callback taking each pattern
+ * @param user_data User data for the callback
+ * @return Handle to the parsed DSL file or NULL if the file cannot be mapped
+ */
+void *rift_dsl_load_file_stream(const char *filename, rift_dsl_pattern_callback_t callback,
+                                void *user_data);
+
 /**
  * @brief Free resources associated with a parsed .rift DSL file
  *
@@ -188,4 +291,57 @@ bool rift_dsl_get_test_case(void *handle, size_t index, const char **input, bool
  */
 bool rift_dsl_get_test_case_groups(void *handle, size_t index, const char ***groups, size_t *count);
 
+/**
+ * @brief Get the index of the pattern a test case checks
+ *
+ * A test case checks the pattern defined last before it.
+ *
+ * @param handle Handle returned by rift_dsl_parse or rift_dsl_load_file
+ * @param index Index of the test case
+ * @param pattern_index Pointer to store the index of the pattern
+ * @return true if successful, false otherwise
+ */
+bool rift_dsl_get_test_case_pattern(void *handle, size_t index, size_t *pattern_index);
+
+/**
+ * @brief Get the number of benchmarks in a parsed DSL file
+ *
+ * A streamed file keeps no benchmarks.
+ *
+ * @param handle Handle returned by rift_dsl_parse or rift_dsl_load_file
+ * @return Number of @bench directives
+ */
+size_t rift_dsl_get_bench_count(void *handle);
+
+/**
+ * @brief Get a benchmark from a parsed DSL file
+ *
+ * @param handle Handle returned by rift_dsl_parse or rift_dsl_load_file
+ * @param index Index of the benchmark
+ * @return The benchmark, owned by the file, or NULL if the index is out of range
+ */
+const rift_dsl_bench_t *rift_dsl_get_bench(void *handle, size_t index);
+
+/**
+ * @brief Get the number of rule combinations in a parsed DSL file
+ *
+ * Streamed files keep their combinations too.
+ *
+ * @param handle Handle returned by rift_dsl_parse or rift_dsl_load_file
+ * @return Number of @combine directives
+ */
+size_t rift_dsl_get_combination_count(void *handle);
+
+/**
+ * @brief Get a rule combination from a parsed DSL file
+ *
+ * @param handle Handle returned by rift_dsl_parse or rift_dsl_load_file
+ * @param index Index of the combination
+ * @param name Pointer to store the name of the combination
+ * @param expression Pointer to store its boolean expression
+ * @return true if successful, false otherwise
+ */
+bool rift_dsl_get_combination(void *handle, size_t index, const char **name,
+                              const char **expression);
+
 #endif /* RIFT_DSL_PARSER_H */
@@ -0,0 +1,145 @@
+/**
+ * @file rift_dsl_profile.h
+ * @brief Match profiles that guide the compilation of .rift rules
+ *
+ * This file defines a profile of how the rules of a .rift file behave on real
+ * traffic: for each named rule, the searches it ran, how many of them matched
+ * and the steps the execution tracker charged them. Profiles are recorded
+ * while matching, saved as text and handed back to the DSL compiler, which
+ * then spends its DFA budget on the rules that cost the most and checks the
+ * required literals of the rules that rarely match before running them.
+ *
+ * The text form has one rule per line, its name followed by the searches,
+ * matches and steps as decimal numbers, separated by white space. Empty
+ * lines and lines starting with '#' are skipped.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_DSL_PROFILE_H
+#define LIBRIFT_DSL_PROFILE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/runtime/execution_tracker.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Longest rule name a profile keeps
+ */
+#define RIFT_DSL_PROFILE_MAX_NAME 255
+
+/**
+ * @brief Profile of match frequencies and costs of named rules
+ */
+typedef struct rift_dsl_profile rift_dsl_profile_t;
+
+/**
+ * @brief What a profile recorded for one rule
+ */
+typedef struct rift_dsl_profile_entry {
+    const char *name;  /**< Name of the rule, owned by the profile */
+    uint64_t searches; /**< Searches recorded */
+    uint64_t matches;  /**< Searches that matched */
+    uint64_t steps;    /**< Steps the searches ran, as counted by the execution tracker */
+} rift_dsl_profile_entry_t;
+
+/**
+ * @brief Create an empty profile
+ *
+ * @return A new profile or NULL on allocation failure
+ */
+rift_dsl_profile_t *rift_dsl_profile_create(void);
+
+/**
+ * @brief Free a profile
+ *
+ * @param profile The profile to free (can be NULL)
+ */
+void rift_dsl_profile_free(rift_dsl_profile_t *profile);
+
+/**
+ * @brief Record one search of a rule
+ *
+ * Recording is not synchronized; threads that match concurrently keep a
+ * profile each and merge them with rift_dsl_profile_merge.
+ *
+ * @param profile The profile
+ * @param name Name of the rule, without white space
+ * @param matched Whether the search matched
+ * @param stats Telemetry of the search (can be NULL when its cost is unknown)
+ * @return true if recorded, false on invalid parameters or allocation failure
+ */
+bool rift_dsl_profile_record(rift_dsl_profile_t *profile, const char *name, bool matched,
+                             const rift_match_stats_t *stats);
+
+/**
+ * @brief Add the counts of one profile to another
+ *
+ * @param total The profile to add to
+ * @param profile The profile to add
+ * @return true if successful, false on invalid parameters or allocation failure
+ */
+bool rift_dsl_profile_merge(rift_dsl_profile_t *total, const rift_dsl_profile_t *profile);
+
+/**
+ * @brief Find the entry of a rule
+ *
+ * @param profile The profile
+ * @param name Name of the rule
+ * @return The entry, valid until the profile changes, or NULL if the rule was not recorded
+ */
+const rift_dsl_profile_entry_t *rift_dsl_profile_find(const rift_dsl_profile_t *profile,
+                                                      const char *name);
+
+/**
+ * @brief Get the number of rules in a profile
+ *
+ * @param profile The profile
+ * @return Number of rules, 0 for NULL
+ */
+size_t rift_dsl_profile_get_count(const rift_dsl_profile_t *profile);
+
+/**
+ * @brief Get an entry of a profile
+ *
+ * Entries are ordered by rule name.
+ *
+ * @param profile The profile
+ * @param index Index of the entry
+ * @return The entry or NULL if the index is out of range
+ */
+const rift_dsl_profile_entry_t *rift_dsl_profile_get_entry(const rift_dsl_profile_t *profile,
+                                                           size_t index);
+
+/**
+ * @brief Write a profile to a file in its text form
+ *
+ * @param profile The profile
+ * @param filename Path of the file to write
+ * @return true if successful, false otherwise
+ */
+bool rift_dsl_profile_save(const rift_dsl_profile_t *profile, const char *filename);
+
+/**
+ * @brief Read a profile from a file in its text form
+ *
+ * A rule listed more than once has its counts summed.
+ *
+ * @param filename Path of the file to read
+ * @param error_message Buffer for the error, naming the line at fault (can be NULL)
+ * @param error_size Size of error_message
+ * @return A new profile or NULL on failure
+ */
+rift_dsl_profile_t *rift_dsl_profile_load(const char *filename, char *error_message,
+                                          size_t error_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_DSL_PROFILE_H */
@@ -0,0 +1,187 @@
+/**
+ * @file rift_dsl_ruleset.h
+ * @brief Hot-swappable handle to a compiled .rift ruleset
+ *
+ * This file defines a handle that publishes one DSL compilation at a time to
+ * any number of matching threads. A reader pins the current compilation with
+ * one atomic load of the published pointer and a counter increment in a
+ * reader slot of its own, so readers never wait on each other or on a
+ * reload. A swap publishes the new compilation at once; matches already
+ * running finish on the old one, which is freed as soon as the last of them
+ * unpins it.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_DSL_RULESET_H
+#define LIBRIFT_DSL_RULESET_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/dsl/rift_dsl_compiler.h"
+#include "core/errors/regex_error.h"
+#include "core/memory/memory.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Number of reader slots of a ruleset
+ *
+ * Threads share a slot only once there are more of them than slots.
+ */
+#ifndef RIFT_DSL_RULESET_READER_SLOTS
+#define RIFT_DSL_RULESET_READER_SLOTS 64
+#endif
+
+/**
+ * @brief Handle to the current compilation of a ruleset
+ */
+typedef struct rift_dsl_ruleset rift_dsl_ruleset_t;
+
+/**
+ * @brief A pin on the compilation a reader is matching with
+ */
+typedef struct rift_dsl_ruleset_guard {
+    void *compilation;   /**< The pinned compilation, NULL if none is published */
+    uint64_t generation; /**< Swaps made before the compilation was pinned */
+    size_t slot;         /**< Reader slot the pin is counted in */
+    unsigned phase;      /**< Phase the pin is counted in */
+} rift_dsl_ruleset_guard_t;
+
+/**
+ * @brief Create a ruleset
+ *
+ * @param compilation Compilation to publish first, owned by the ruleset
+ *                    from now on (can be NULL)
+ * @return A new ruleset or NULL on failure, in which case the compilation
+ *         is left to the caller
+ */
+rift_dsl_ruleset_t *rift_dsl_ruleset_create(void *compilation);
+
+/**
+ * @brief Free a ruleset and its current compilation
+ *
+ * No reader may hold a pin on the ruleset.
+ *
+ * @param ruleset The ruleset to free
+ */
+void rift_dsl_ruleset_free(rift_dsl_ruleset_t *ruleset);
+
+/**
+ * @brief Pin the current compilation for matching
+ *
+ * The compilation stays valid, even across swaps, until the guard is
+ * unpinned. The guard must be unpinned on the thread that pinned it, and
+ * the thread must not swap the ruleset while it holds a pin.
+ *
+ * @param ruleset The ruleset
+ * @param guard Guard to fill
+ * @return The pinned compilation, NULL if none is published
+ */
+void *rift_dsl_ruleset_pin(rift_dsl_ruleset_t *ruleset, rift_dsl_ruleset_guard_t *guard);
+
+/**
+ * @brief Unpin a compilation pinned with rift_dsl_ruleset_pin
+ *
+ * @param ruleset The ruleset
+ * @param guard The guard filled by rift_dsl_ruleset_pin
+ */
+void rift_dsl_ruleset_unpin(rift_dsl_ruleset_t *ruleset, rift_dsl_ruleset_guard_t *guard);
+
+/**
+ * @brief Publish a new compilation
+ *
+ * Readers pin the new compilation from the moment it is published. The
+ * call then waits for the pins on the old compilation to go and frees it;
+ * readers are never held up, only the thread that swaps. Swaps on the same
+ * ruleset are serialized.
+ *
+ * @param ruleset The ruleset
+ * @param compilation Compilation to publish, owned by the ruleset from now
+ *                    on (can be NULL)
+ * @return true if successful, false otherwise
+ */
+bool rift_dsl_ruleset_swap(rift_dsl_ruleset_t *ruleset, void *compilation);
+
+/**
+ * @brief Compile a .rift DSL source and publish it
+ *
+ * A source that fails to compile is not published and the current
+ * compilation stays in use.
+ *
+ * @param ruleset The ruleset
+ * @param source The .rift DSL source code
+ * @param options Options of the compilation (can be NULL for the defaults)
+ * @param error_message Buffer to store the compilation error (can be NULL)
+ * @param error_size Size of error_message
+ * @return true if the new compilation was published, false otherwise
+ */
+bool rift_dsl_ruleset_reload(rift_dsl_ruleset_t *ruleset, const char *source,
+                             const rift_dsl_compile_options_t *options, char *error_message,
+                             size_t error_size);
+
+/**
+ * @brief Allocate the ruleset's compilations and matches through an allocator
+ *
+ * Compilations made by rift_dsl_ruleset_reload and the matching state of
+ * rift_dsl_ruleset_execute come from the allocator from now on, which
+ * keeps a tenant's memory apart from the others'. Compilations already
+ * published stay with the allocator they came from. With an allocator that
+ * does not free, such as an arena, the memory of every reload and match
+ * stays until the arena goes. The allocator must outlive the ruleset.
+ *
+ * @param ruleset The ruleset
+ * @param allocator The allocator, or NULL for the one in use on the thread
+ * @return true if successful, false otherwise
+ */
+bool rift_dsl_ruleset_set_allocator(rift_dsl_ruleset_t *ruleset,
+                                    const rift_allocator_t *allocator);
+
+/**
+ * @brief Execute a program of the current compilation on input text
+ *
+ * The compilation is pinned for the duration of the match.
+ *
+ * @param ruleset The ruleset
+ * @param index Program index
+ * @param input Input text
+ * @param input_length Length of input text
+ * @param match Pointer to match structure to fill
+ * @return true if match found, false otherwise
+ */
+bool rift_dsl_ruleset_execute(rift_dsl_ruleset_t *ruleset, size_t index, const char *input,
+                              size_t input_length, rift_regex_match_t *match);
+
+/**
+ * @brief Execute every program of the current compilation on input text
+ *
+ * The compilation is pinned for the duration of the scan; see
+ * rift_dsl_execute_all.
+ *
+ * @param ruleset The ruleset
+ * @param input Input text
+ * @param input_length Length of input text
+ * @param callback Function called for each matching program in index order (can be NULL)
+ * @param user_data Pointer passed to the callback
+ * @return Number of matching programs reported to the callback
+ */
+size_t rift_dsl_ruleset_execute_all(rift_dsl_ruleset_t *ruleset, const char *input,
+                                    size_t input_length, rift_dsl_match_callback_t callback,
+                                    void *user_data);
+
+/**
+ * @brief Get the number of swaps made on a ruleset
+ *
+ * @param ruleset The ruleset
+ * @return Number of compilations published after the first
+ */
+uint64_t rift_dsl_ruleset_generation(rift_dsl_ruleset_t *ruleset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_DSL_RULESET_H */
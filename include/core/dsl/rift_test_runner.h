@@ -11,6 +11,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include "core/dsl/rift_dsl_parser.h"
 #include "core/dsl/rift_dsl_compiler.h"
 #ifndef RIFT_TEST_RUNNER_H
@@ -23,6 +24,10 @@ extern "C" {
 
 /**
  * @brief Structure representing a test result
+ *
+ * A test case checks the pattern defined last before it. Programs report no
+ * capture text, so the expected groups are given back but not checked and
+ * actual_groups is NULL.
  */
 typedef struct {
 	const char *pattern_name;
@@ -33,6 +38,9 @@ typedef struct {
 	char **expected_groups;
 	char **actual_groups;
 	size_t group_count;
+	size_t pattern_index; /**< Index of the pattern the test checks */
+	uint64_t elapsed_ns;  /**< Wall time of running the test */
+	uint64_t compile_ns;  /**< Wall time of compiling the pattern, shared by its tests */
 } rift_test_result_t;
 
 /**
@@ -45,22 +53,84 @@ typedef struct {
 	size_t failed_count;
 } rift_test_results_t;
 
+/**
+ * @brief Structure representing the result of a @bench directive
+ *
+ * A pass searches the whole input for successive matches. Each timed pass
+ * gives one sample of nanoseconds per input byte; the statistics are taken
+ * over the samples, so one slow pass moves the median little.
+ */
+typedef struct {
+	const char *pattern_name;  /**< Name of the timed pattern */
+	size_t pattern_index;      /**< Index of the timed pattern */
+	size_t iterations;         /**< Timed passes */
+	size_t warmup;             /**< Untimed passes before the timed ones */
+	size_t input_count;        /**< Inputs of a pass, 1 for an inline input */
+	size_t input_bytes;        /**< Bytes read by a pass */
+	size_t matches;            /**< Matches found by a pass */
+	double median_ns_per_byte; /**< Median of the samples */
+	double mad_ns_per_byte;    /**< Median absolute deviation of the samples */
+	double p99_ns_per_byte;    /**< 99th percentile of the samples */
+	double matches_per_second; /**< Matches of a pass over its median time */
+} rift_bench_result_t;
+
+/**
+ * @brief Options of a test run
+ */
+typedef struct rift_test_run_options {
+	size_t num_threads; /**< Threads including the caller's, 0 for one per CPU */
+	bool run_benches;   /**< Whether to run the @bench directives after the tests */
+} rift_test_run_options_t;
+
 /**
  * @brief Run tests from a .rift DSL file
  * 
+ * The tests run on the calling thread; see rift_test_run_file_with_options.
+ *
  * @param filename Path to the .rift file
  * @return Opaque handle to test results or NULL on error
  */
 void *rift_test_run_file(const char *filename);
 
+/**
+ * @brief Run tests from a .rift DSL file on several threads
+ *
+ * Each pattern is compiled once and its program is shared by the tests that
+ * check it. The patterns, then the tests, are shared out among the threads;
+ * results keep the order of the tests in the file whatever thread ran them.
+ *
+ * Benchmarks run afterwards on the calling thread alone, so that the other
+ * threads do not disturb their timings. A relative corpus glob is taken
+ * from the directory of the file.
+ *
+ * @param filename Path to the .rift file
+ * @param options Options of the run (can be NULL to run on the calling thread)
+ * @return Opaque handle to test results or NULL on error
+ */
+void *rift_test_run_file_with_options(const char *filename, const rift_test_run_options_t *options);
+
 /**
  * @brief Run tests from a .rift DSL source string
  * 
+ * The tests run on the calling thread; see rift_test_run_source_with_options.
+ *
  * @param source The .rift DSL source code
  * @return Opaque handle to test results or NULL on error
  */
 void *rift_test_run_source(const char *source);
 
+/**
+ * @brief Run tests from a .rift DSL source string on several threads
+ *
+ * See rift_test_run_file_with_options.
+ *
+ * @param source The .rift DSL source code
+ * @param options Options of the run (can be NULL to run on the calling thread)
+ * @return Opaque handle to test results or NULL on error
+ */
+void *rift_test_run_source_with_options(const char *source,
+                                        const rift_test_run_options_t *options);
+
 /**
  * @brief Free test results
  * 
@@ -113,6 +183,32 @@ bool rift_test_get_summary(void *handle, size_t *total, size_t *passed, size_t *
  */
 void rift_test_print_results(void *handle, bool verbose);
 
+/**
+ * @brief Get the number of benchmark results
+ *
+ * @param handle The test results handle
+ * @return Number of benchmarks run, 0 unless the run was asked to run them
+ */
+size_t rift_test_get_bench_count(void *handle);
+
+/**
+ * @brief Get a specific benchmark result
+ *
+ * @param handle The test results handle
+ * @param index Benchmark index, in the order of the file
+ * @param result Pointer to result structure to fill
+ * @return true if successful, false otherwise
+ */
+bool rift_test_get_bench_result(void *handle, size_t index, rift_bench_result_t *result);
+
+/**
+ * @brief Print benchmark results to stdout
+ *
+ * @param handle The test results handle
+ * @param json If true, print one JSON object instead of a line per benchmark
+ */
+void rift_test_print_bench_results(void *handle, bool json);
+
 #ifdef __cplusplus
 }
 #endif
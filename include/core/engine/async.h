@@ -0,0 +1,149 @@
+/**
+ * @file async.h
+ * @brief Completion-based matching for event-loop servers
+ *
+ * This file defines a pool of worker threads that runs match jobs submitted
+ * from an event loop. A job is a compiled pattern, an input and a deadline;
+ * it completes once on a worker, either through its callback or through the
+ * pool's completion queue, whose file descriptor becomes readable while
+ * completions are waiting so it can sit in the loop's epoll set. Deadlines
+ * and cancellation use the matchers' own checks, so a job stops within
+ * RIFT_MATCHER_TIMEOUT_CHECK_INTERVAL steps rather than running to the end.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_ENGINE_ASYNC_H
+#define LIBRIFT_REGEX_ENGINE_ASYNC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/runtime/match_types.h"
+#include "core/runtime/matcher.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Job id that no job has, returned when a submission fails
+ */
+#define RIFT_ASYNC_NO_JOB 0
+
+/**
+ * @brief How a job ended
+ */
+typedef enum rift_async_status {
+    RIFT_ASYNC_MATCHED = 0, /**< The pattern matched the input */
+    RIFT_ASYNC_NO_MATCH,    /**< The pattern did not match the input */
+    RIFT_ASYNC_TIMED_OUT,   /**< The deadline passed before the match ended */
+    RIFT_ASYNC_CANCELLED,   /**< The job was cancelled or the pool was freed */
+    RIFT_ASYNC_FAILED       /**< The matcher could not be built */
+} rift_async_status_t;
+
+/**
+ * @brief Outcome of one job
+ */
+typedef struct rift_async_completion {
+    uint64_t job_id;            /**< Id returned by rift_async_submit */
+    rift_async_status_t status; /**< How the job ended */
+    rift_regex_span_t span;     /**< First match, both ends RIFT_REGEX_SPAN_UNSET if none */
+    uint64_t elapsed_ns;        /**< Time from submission to completion */
+    void *user_data;            /**< User data given to rift_async_submit */
+} rift_async_completion_t;
+
+/**
+ * @brief Function called on a worker thread when a job completes
+ *
+ * @param completion The outcome, only valid during the call
+ * @param user_data User data given to rift_async_submit
+ */
+typedef void (*rift_async_callback_t)(const rift_async_completion_t *completion, void *user_data);
+
+/**
+ * @brief Pool of worker threads running match jobs
+ */
+typedef struct rift_async_pool rift_async_pool_t;
+
+/**
+ * @brief Create a pool and start its workers
+ *
+ * @param num_threads Number of workers, 0 for one per CPU
+ * @param options Options of the workers' matchers
+ * @return A new pool or NULL on failure
+ */
+rift_async_pool_t *rift_async_pool_create(size_t num_threads, rift_matcher_option_t options);
+
+/**
+ * @brief Free a pool
+ *
+ * Jobs still queued or running are cancelled and complete with
+ * RIFT_ASYNC_CANCELLED before the workers are joined, so every callback has
+ * returned by the time this does. Queued completions are dropped.
+ *
+ * @param pool The pool to free
+ */
+void rift_async_pool_free(rift_async_pool_t *pool);
+
+/**
+ * @brief Submit a match job
+ *
+ * The pattern and input must stay valid until the job completes. With a
+ * callback, the job completes by calling it on a worker thread; without
+ * one, its completion is queued for rift_async_poll.
+ *
+ * @param pool The pool
+ * @param pattern The compiled pattern
+ * @param input The input
+ * @param length Length of the input or (size_t)-1 to use strlen
+ * @param deadline_ns Deadline from rift_matcher_monotonic_ns, or RIFT_MATCHER_NO_DEADLINE
+ * @param callback Function to call on completion (can be NULL)
+ * @param user_data User data passed to the callback and stored in the completion
+ * @return Id of the job, or RIFT_ASYNC_NO_JOB on invalid parameters or allocation failure
+ */
+uint64_t rift_async_submit(rift_async_pool_t *pool, const rift_regex_pattern_t *pattern,
+                           const char *input, size_t length, uint64_t deadline_ns,
+                           rift_async_callback_t callback, void *user_data);
+
+/**
+ * @brief Cancel a job that has not completed yet
+ *
+ * A queued job completes without running and a running one stops at its
+ * matcher's next check. Either way it still completes, with
+ * RIFT_ASYNC_CANCELLED, unless it finished first.
+ *
+ * @param pool The pool
+ * @param job_id Id of the job
+ * @return true if the job was still pending, false otherwise
+ */
+bool rift_async_cancel(rift_async_pool_t *pool, uint64_t job_id);
+
+/**
+ * @brief Get the file descriptor that signals queued completions
+ *
+ * The descriptor is readable while completions wait in the queue. It
+ * belongs to the pool: register it for reading, then call rift_async_poll
+ * when it is ready, which also clears the signal.
+ *
+ * @param pool The pool
+ * @return The descriptor, or -1 if the pool is NULL
+ */
+int rift_async_get_fd(const rift_async_pool_t *pool);
+
+/**
+ * @brief Take completions from the queue without blocking
+ *
+ * @param pool The pool
+ * @param completions Array to store the completions
+ * @param max_completions Number of entries in completions
+ * @return Number of completions stored
+ */
+size_t rift_async_poll(rift_async_pool_t *pool, rift_async_completion_t *completions,
+                       size_t max_completions);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_ENGINE_ASYNC_H */
@@ -0,0 +1,141 @@
+/**
+ * @file batch.h
+ * @brief Batch matching of many inputs against one or many patterns
+ *
+ * This file defines a batch engine for workloads such as log pipelines,
+ * where millions of short inputs are matched against a few patterns. The
+ * inputs are shared out among a pool of threads in contiguous ranges; a
+ * thread that runs out of inputs steals half of the largest range left to
+ * another. Each thread keeps one matcher per pattern for the whole batch,
+ * so the lazy DFA, Pike VM and backtrack stack a matcher builds are paid
+ * for once per thread rather than once per input. On multi-socket hosts the
+ * batch can pin its threads to NUMA nodes and give each node its own copy of
+ * the compiled patterns, so the automata are read from local memory.
+ *
+ * An executor can take some of the patterns off the threads, for instance a
+ * GPU backend scanning the byte-class tables of the patterns' DFAs over the
+ * whole batch at once; the threads match the patterns it leaves.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_ENGINE_BATCH_H
+#define LIBRIFT_REGEX_ENGINE_BATCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/runtime/match_types.h"
+#include "core/runtime/matcher.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Number of inputs a thread takes from its range at a time by default
+ */
+#define RIFT_BATCH_DEFAULT_CHUNK 64
+
+/**
+ * @brief Measurements of a batch, taken with the monotonic clock
+ */
+typedef struct rift_batch_stats {
+    uint64_t elapsed_ns; /**< Wall time of the whole batch */
+    size_t num_threads;  /**< Threads that matched inputs, including the caller's */
+    size_t steals;       /**< Ranges taken from other threads */
+    size_t numa_nodes;   /**< Nodes holding a copy of the patterns, 0 without replication */
+    size_t offloaded;    /**< Patterns matched by the executor rather than the threads */
+} rift_batch_stats_t;
+
+/**
+ * @brief Result of one pattern on one input
+ */
+typedef struct rift_batch_result {
+    bool matched;           /**< Whether the pattern matched the input */
+    rift_regex_span_t span; /**< First match, both positions RIFT_REGEX_SPAN_UNSET without one */
+} rift_batch_result_t;
+
+/**
+ * @brief Matches the patterns of a batch it can run, before the threads start
+ *
+ * The callback gets the whole batch. For every pattern j it takes, it fills
+ * results[i * num_patterns + j] for every input i with what
+ * rift_matcher_find_next_spans() would report, and sets handled[j]. It may
+ * take none, for instance when a device is busy or a pattern's tables do
+ * not fit on it. It runs on the caller's thread and must not keep the
+ * pointers it is given.
+ *
+ * @param state The executor's state
+ * @param patterns The compiled patterns
+ * @param num_patterns Number of patterns
+ * @param inputs The inputs
+ * @param lengths Length of each input, or NULL for strlen on every input
+ * @param num_inputs Number of inputs
+ * @param results The result matrix
+ * @param handled Array of num_patterns flags, all false on entry
+ * @return true if successful, false to fail the batch
+ */
+typedef bool (*rift_batch_execute_fn)(void *state, const rift_regex_pattern_t *const *patterns,
+                                      size_t num_patterns, const char *const *inputs,
+                                      const size_t *lengths, size_t num_inputs,
+                                      rift_batch_result_t *results, bool *handled);
+
+/**
+ * @brief Executor a batch hands patterns to before its threads
+ */
+typedef struct rift_batch_executor {
+    const char *name;              /**< Name of the executor, for diagnostics */
+    rift_batch_execute_fn execute; /**< Matches the patterns it can run */
+    void *state;                   /**< State passed to execute */
+} rift_batch_executor_t;
+
+/**
+ * @brief Options of a batch
+ */
+typedef struct rift_batch_options {
+    size_t num_threads;                    /**< Threads including the caller's, 0 for one per CPU */
+    size_t chunk_size;                     /**< Inputs taken at a time, 0 for the default */
+    rift_matcher_option_t matcher_options; /**< Options of the threads' matchers */
+    rift_batch_stats_t *stats;             /**< Filled when the batch ends (can be NULL) */
+    bool numa_replicate;                   /**< Copy the patterns to each NUMA node */
+    const rift_batch_executor_t *executor; /**< Takes patterns off the threads (can be NULL) */
+} rift_batch_options_t;
+
+/**
+ * @brief Match every input against every pattern
+ *
+ * results is a matrix with one row per input and one column per pattern:
+ * the result of pattern j on input i is results[i * num_patterns + j]. It
+ * is written in place, so the batch allocates nothing per input. The
+ * patterns are only read and may be shared with other threads.
+ *
+ * With numa_replicate on a host with several NUMA nodes, thread i is pinned
+ * to node i modulo the node count, and the first thread on each node clones
+ * the patterns there. The caller's thread is pinned too and gets its
+ * affinity back before this returns. Threads still steal across nodes, so a
+ * stolen input is read remotely but matched against the thief's copy. On a
+ * single node the option does nothing.
+ *
+ * An executor runs first, on the caller's thread; the threads then match
+ * only the patterns it did not take, and none start when it took them all.
+ *
+ * @param patterns The compiled patterns
+ * @param num_patterns Number of patterns
+ * @param inputs The inputs
+ * @param lengths Length of each input, or NULL to use strlen on every input
+ * @param num_inputs Number of inputs
+ * @param results Matrix of num_inputs * num_patterns results
+ * @param options Options of the batch (can be NULL for the defaults)
+ * @return true if every input was matched, false on invalid parameters, allocation failure or
+ *         a failing executor
+ */
+bool rift_match_batch(const rift_regex_pattern_t *const *patterns, size_t num_patterns,
+                      const char *const *inputs, const size_t *lengths, size_t num_inputs,
+                      rift_batch_result_t *results, const rift_batch_options_t *options);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_ENGINE_BATCH_H */
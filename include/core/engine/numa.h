@@ -0,0 +1,71 @@
+/**
+ * @file numa.h
+ * @brief NUMA node discovery and thread pinning
+ *
+ * This file defines the little NUMA support the thread pools need to keep
+ * compiled pattern data on the socket that reads it: counting the nodes and
+ * pinning a thread to the CPUs of one. Memory is placed by first touch, so
+ * data a pinned thread allocates and fills lands on its node. Nodes are read
+ * from sysfs on Linux; elsewhere the host counts as a single node and
+ * pinning fails.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_ENGINE_NUMA_H
+#define LIBRIFT_REGEX_ENGINE_NUMA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Highest number of CPUs a saved affinity covers
+ */
+#define RIFT_NUMA_MAX_CPUS 1024
+
+/**
+ * @brief Highest number of nodes that are told apart
+ */
+#define RIFT_NUMA_MAX_NODES 64
+
+/**
+ * @brief CPUs a thread was allowed to run on before it was pinned
+ */
+typedef struct rift_numa_affinity {
+    uint64_t cpus[RIFT_NUMA_MAX_CPUS / 64]; /**< One bit per CPU */
+    bool valid;                             /**< Whether the affinity was saved */
+} rift_numa_affinity_t;
+
+/**
+ * @brief Get the number of NUMA nodes with CPUs
+ *
+ * @return Number of nodes, 1 when the topology cannot be read
+ */
+size_t rift_numa_node_count(void);
+
+/**
+ * @brief Pin the calling thread to the CPUs of a node
+ *
+ * @param node Index of the node, taken modulo rift_numa_node_count
+ * @param previous Pointer to save the affinity to restore (can be NULL)
+ * @return true if the thread was pinned, false otherwise
+ */
+bool rift_numa_bind_thread(size_t node, rift_numa_affinity_t *previous);
+
+/**
+ * @brief Restore the affinity a thread had before rift_numa_bind_thread
+ *
+ * @param previous The saved affinity; nothing is done if it is not valid
+ */
+void rift_numa_restore_thread(const rift_numa_affinity_t *previous);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_ENGINE_NUMA_H */
@@ -12,7 +12,8 @@
  #ifndef LIBRIFT_REGEX_ENGINE_PATTERN_H
  #define LIBRIFT_REGEX_ENGINE_PATTERN_H
  
- #include <stdbool.h>
+ #include <stdatomic.h>
+#include <stdbool.h>
  #include <stddef.h>
  #include <stdio.h>
  #include <stdlib.h>
@@ -20,8 +21,15 @@
  
  #include "core/automaton/automaton.h"
  #include "core/automaton/flags.h"
+ #include "core/compiler/ambiguity.h"
+ #include "core/compiler/engine_plan.h"
+ #include "core/compiler/group_names.h"
+ #include "core/compiler/match_length.h"
+ #include "core/compiler/prefilter.h"
+ #include "core/config/config.h"
  #include "core/errors/regex_error.h"
  #include "core/engine/engine.h"
+ #include "core/memory/memory.h"
  
  #ifdef __cplusplus
  extern "C" {
@@ -39,6 +47,16 @@
      bool is_rift_syntax;                    /**< Whether the pattern uses r'' syntax */
      char error_message[256];                /**< Last error message */
      bool is_valid;                          /**< Whether the pattern is valid */
+     rift_ambiguity_verdict_t ambiguity;     /**< Static backtracking analysis */
+     rift_engine_plan_t engine_plan;         /**< Engines chosen at compile time */
+     rift_match_length_bounds_t match_length; /**< Fewest and most bytes a match consumes */
+     rift_regex_config_t config;             /**< Regex settings copied at compile time,
+                                                  with the pattern's overrides */
+     rift_group_names_t *group_names;        /**< Named groups to indices, shared with clones */
+     rift_prefilter_t *prefilter;            /**< Literal prefilter of a deserialized pattern,
+                                                  NULL when matchers derive it from the AST */
+     _Atomic(atomic_size_t *) shared_refs;   /**< Owners of source, ast and automaton,
+                                                  NULL until the pattern is first cloned */
  };
  
  /**
@@ -66,6 +84,23 @@
   */
  rift_regex_pattern_t *rift_regex_compile(const char *pattern, rift_regex_flags_t flags,
                                           rift_regex_error_t *error);
+
+ /**
+  * @brief Create a new regex pattern whose compiled form comes from an allocator
+  *
+  * The AST, the automaton and everything else the compilation allocates
+  * with rift_malloc come from the allocator, which must outlive the pattern.
+  *
+  * @param pattern The pattern string
+  * @param flags Compilation flags
+  * @param allocator The allocator, or NULL for the one in use on the thread
+  * @param error Pointer to store error code (can be NULL)
+  * @return A new pattern or NULL on failure
+  */
+ rift_regex_pattern_t *rift_regex_compile_with_allocator(const char *pattern,
+                                                         rift_regex_flags_t flags,
+                                                         const rift_allocator_t *allocator,
+                                                         rift_regex_error_t *error);
  
  /**
   * @brief Free resources associated with a pattern
@@ -90,6 +125,81 @@
   */
  size_t rift_regex_pattern_get_group_count(const rift_regex_pattern_t *pattern);
  
+ /**
+  * @brief Get the static ambiguity verdict of the pattern
+  *
+  * The verdict is computed once at compile time and tells whether a
+  * backtracking match can take exponential or polynomial time.
+  *
+  * @param pattern The pattern
+  * @return The verdict, or NULL if pattern is NULL
+  */
+ const rift_ambiguity_verdict_t *rift_regex_pattern_get_ambiguity(const rift_regex_pattern_t *pattern);
+
+ /**
+  * @brief Get the engine plan of the pattern
+  *
+  * The plan is built once at compile time, after the ambiguity analysis, and
+  * records which matcher engines can run the pattern, the one a default
+  * search starts with and why.
+  *
+  * @param pattern The pattern
+  * @return The plan, or NULL if pattern is NULL
+  */
+ const rift_engine_plan_t *rift_regex_pattern_get_engine_plan(const rift_regex_pattern_t *pattern);
+
+ /**
+  * @brief Get the bounds on the length of the pattern's matches
+  *
+  * The bounds are computed once at compile time from the AST. Patterns built
+  * from an automaton have none: any length from 0 up.
+  *
+  * @param pattern The pattern
+  * @return The bounds, or NULL if pattern is NULL
+  */
+ const rift_match_length_bounds_t *rift_regex_pattern_get_match_length(
+     const rift_regex_pattern_t *pattern);
+
+ /**
+  * @brief Get the regex settings of the pattern
+  *
+  * They are copied from the global configuration snapshot when the pattern
+  * is created, so later changes to the configuration do not reach it, and
+  * matchers copy them in turn when created.
+  *
+  * @param pattern The pattern
+  * @return The settings, or NULL if pattern is NULL
+  */
+ const rift_regex_config_t *rift_regex_pattern_get_config(const rift_regex_pattern_t *pattern);
+ 
+ /**
+  * @brief Override one regex setting for this pattern only
+  *
+  * Affects matchers created afterwards. Settings applied while compiling,
+  * such as the engine plan, keep the values they were compiled with.
+  *
+  * @param pattern The pattern
+  * @param param The parameter to override
+  * @param value Pointer to the value, of the parameter's type
+  * @return true if set, false on invalid parameters
+  */
+ bool rift_regex_pattern_set_param(rift_regex_pattern_t *pattern, rift_regex_config_param_t param,
+                                   const void *value);
+ 
+ /**
+  * @brief Get the index of a named capture group
+  *
+  * Names are resolved into a hash table when the pattern is compiled, so
+  * code reading several groups by name after every match can look each one
+  * up in constant time, or resolve the indices once and read groups by index.
+  *
+  * @param pattern The pattern
+  * @param name The group name
+  * @return The group index, counting from 1, or RIFT_GROUP_NO_INDEX if the
+  *         pattern has no group with that name
+  */
+ size_t rift_regex_pattern_group_index(const rift_regex_pattern_t *pattern, const char *name);
+ 
  /**
   * @brief Get the compiled automaton from the pattern
   *
@@ -97,6 +207,17 @@
   * @return The automaton or NULL if not compiled
   */
  struct rift_regex_automaton *rift_regex_pattern_get_automaton(const rift_regex_pattern_t *pattern);
+
+ /**
+  * @brief Get the literal prefilter a pattern was deserialized with
+  *
+  * Compiled patterns keep their AST and leave the prefilter to the matcher;
+  * deserialized ones have no AST and carry the prefilter they were saved with.
+  *
+  * @param pattern The pattern
+  * @return The prefilter, or NULL if the matcher should derive one
+  */
+ const rift_prefilter_t *rift_regex_pattern_get_prefilter(const rift_regex_pattern_t *pattern);
  
  /**
   * @brief Get the original source string of the pattern
@@ -125,6 +246,10 @@
  /**
   * @brief Create a duplicate of a pattern
   *
+  * The duplicate shares the source, AST and automaton of the original, which
+  * are never modified after compilation; they are freed with the last pattern
+  * that refers to them. Per-pattern state such as the error message is copied.
+  *
   * @param pattern The pattern to clone
   * @return A new pattern that is a copy of the original, or NULL on failure
   */
@@ -160,8 +285,14 @@
  /**
   * @brief Serialize a pattern to a binary format for storage
   *
+  * The image holds everything compilation produced: the automaton with its
+  * lookaround bodies, the ambiguity verdict, the engine plan, the match
+  * length bounds, the regex settings, the group name table and the literal
+  * prefilter. It is read back by the same build on a machine of the same
+  * byte order; other images are refused.
+  *
   * @param pattern The pattern to serialize
-  * @param data Pointer to store the serialized data
+  * @param data Pointer to store the serialized data, freed with free()
   * @param size Pointer to store the size of the serialized data
   * @return true if successful, false otherwise
   */
@@ -171,6 +302,10 @@
  /**
   * @brief Deserialize a pattern from a binary format
   *
+  * Nothing is parsed or compiled again: the automaton is rebuilt state by
+  * state and the analysis results are taken as saved, so the pattern can be
+  * matched right away. It has no AST.
+  *
   * @param data The serialized data
   * @param size Size of the serialized data
   * @param error Pointer to store error code (can be NULL)
@@ -0,0 +1,168 @@
+/**
+ * @file pattern_cache.h
+ * @brief Shared cache of compiled patterns and bytecode programs
+ *
+ * This file defines a thread-safe cache for services that compile the same
+ * patterns over and over, from configuration, user queries or reloads. An
+ * entry is keyed by the pattern text and the compilation flags; the text
+ * also decides whether the r'' syntax is in use, so it needs no key of its
+ * own. A hit hands back the compiled object without tokenizing, parsing or
+ * building an automaton. Entries are reference counted: one that is held is
+ * never freed, and once every holder has released it, it joins its stripe's
+ * LRU list until the memory budget pushes it out.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_ENGINE_PATTERN_CACHE_H
+#define LIBRIFT_REGEX_ENGINE_PATTERN_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/automaton/flags.h"
+#include "core/bytecode/bytecode.h"
+#include "core/engine/pattern.h"
+#include "core/errors/regex_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Number of independently locked parts of a cache
+ */
+#ifndef RIFT_PATTERN_CACHE_STRIPES
+#define RIFT_PATTERN_CACHE_STRIPES 16
+#endif
+
+/**
+ * @brief Memory budget of the process-wide cache in bytes
+ */
+#ifndef RIFT_PATTERN_CACHE_DEFAULT_BUDGET
+#define RIFT_PATTERN_CACHE_DEFAULT_BUDGET (64 * 1024 * 1024)
+#endif
+
+/**
+ * @brief Cache of compiled patterns and bytecode programs
+ */
+typedef struct rift_pattern_cache rift_pattern_cache_t;
+
+/**
+ * @brief Counters of a cache, summed over its stripes
+ */
+typedef struct rift_pattern_cache_stats {
+    uint64_t hits;      /**< Lookups answered from the cache */
+    uint64_t misses;    /**< Lookups that compiled */
+    uint64_t evictions; /**< Entries freed to stay within the budget */
+    size_t entries;     /**< Entries in the cache, held or not */
+    size_t held;        /**< Entries with at least one holder */
+    size_t bytes;       /**< Estimated memory of the entries */
+} rift_pattern_cache_stats_t;
+
+/**
+ * @brief Create a cache
+ *
+ * The budget is split evenly between the stripes. Held entries count
+ * towards it but cannot be evicted, so the cache may go over it while
+ * they are held.
+ *
+ * @param memory_budget Budget in bytes, 0 for RIFT_PATTERN_CACHE_DEFAULT_BUDGET
+ * @return A new cache or NULL on failure
+ */
+rift_pattern_cache_t *rift_pattern_cache_create(size_t memory_budget);
+
+/**
+ * @brief Free a cache and every entry in it
+ *
+ * Every entry must have been released first.
+ *
+ * @param cache The cache to free
+ */
+void rift_pattern_cache_free(rift_pattern_cache_t *cache);
+
+/**
+ * @brief Get the process-wide cache
+ *
+ * The cache is created on first use with RIFT_PATTERN_CACHE_DEFAULT_BUDGET
+ * and lives until the process exits.
+ *
+ * @return The cache, or NULL if it could not be created
+ */
+rift_pattern_cache_t *rift_pattern_cache_global(void);
+
+/**
+ * @brief Get the compiled form of a pattern, compiling it on a miss
+ *
+ * The pattern is shared with every other holder and must be given back
+ * with rift_pattern_cache_release rather than freed. Failed compilations
+ * are not cached.
+ *
+ * @param cache The cache
+ * @param pattern The pattern string
+ * @param flags Compilation flags
+ * @param error Pointer to store error code (can be NULL)
+ * @return The compiled pattern or NULL on failure
+ */
+const rift_regex_pattern_t *rift_pattern_cache_compile(rift_pattern_cache_t *cache,
+                                                       const char *pattern,
+                                                       rift_regex_flags_t flags,
+                                                       rift_regex_error_t *error);
+
+/**
+ * @brief Give back a pattern from rift_pattern_cache_compile
+ *
+ * @param cache The cache the pattern came from
+ * @param pattern The pattern (can be NULL)
+ */
+void rift_pattern_cache_release(rift_pattern_cache_t *cache, const rift_regex_pattern_t *pattern);
+
+/**
+ * @brief Get the bytecode program of a pattern, compiling it on a miss
+ *
+ * Programs and patterns are cached apart, so a program hit does not keep
+ * the pattern it was compiled from alive. The program must be given back
+ * with rift_pattern_cache_release_bytecode.
+ *
+ * @param cache The cache
+ * @param pattern The pattern string
+ * @param flags Compilation flags
+ * @param error Pointer to store error code (can be NULL)
+ * @return The program or NULL on failure
+ */
+const rift_bytecode_program_t *rift_pattern_cache_compile_bytecode(rift_pattern_cache_t *cache,
+                                                                   const char *pattern,
+                                                                   rift_regex_flags_t flags,
+                                                                   rift_regex_error_t *error);
+
+/**
+ * @brief Give back a program from rift_pattern_cache_compile_bytecode
+ *
+ * @param cache The cache the program came from
+ * @param program The program (can be NULL)
+ */
+void rift_pattern_cache_release_bytecode(rift_pattern_cache_t *cache,
+                                         const rift_bytecode_program_t *program);
+
+/**
+ * @brief Free every entry that nobody holds
+ *
+ * Held entries stay and are looked up as before.
+ *
+ * @param cache The cache
+ */
+void rift_pattern_cache_clear(rift_pattern_cache_t *cache);
+
+/**
+ * @brief Read the counters of a cache
+ *
+ * @param cache The cache
+ * @param stats Pointer to store the counters
+ */
+void rift_pattern_cache_get_stats(rift_pattern_cache_t *cache, rift_pattern_cache_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_ENGINE_PATTERN_CACHE_H */
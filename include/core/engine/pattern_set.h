@@ -0,0 +1,200 @@
+/**
+ * @file pattern_set.h
+ * @brief Multi-pattern matching for the LibRift regex engine
+ *
+ * This file defines a pattern set that combines many patterns into one union
+ * automaton. Accepting states carry the identifiers of the patterns they
+ * complete, so a single pass over the input reports every pattern that matches
+ * it, in time linear in the input rather than in patterns times input.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_ENGINE_PATTERN_SET_H
+#define LIBRIFT_REGEX_ENGINE_PATTERN_SET_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/automaton/aho_corasick.h"
+#include "core/automaton/automaton.h"
+#include "core/automaton/flags.h"
+#include "core/automaton/lazy_dfa.h"
+#include "core/errors/regex_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Union state of a pattern that has no copy in the union
+ */
+#define RIFT_PATTERN_SET_NOT_MERGED SIZE_MAX
+
+/**
+ * @brief Set of patterns matched together
+ *
+ * Pattern identifiers are assigned from 0 in the order the patterns are added.
+ * Adding or replacing a pattern drops the scanner until the next compile,
+ * which only copies the new automata into the union: a replaced pattern's
+ * old copy is cut off from the start state and left unreachable until dead
+ * copies outnumber live states, when the union is rebuilt. When every
+ * pattern expands to a finite set of literals, they are scanned for with an
+ * Aho-Corasick automaton instead of the lazy DFA.
+ */
+typedef struct rift_pattern_set {
+    rift_regex_automaton_t **automata; /**< Owned automaton of each pattern */
+    size_t num_patterns;               /**< Number of patterns */
+    size_t capacity;                   /**< Capacity of the automata array */
+    size_t max_cached_states;          /**< State cache capacity of the scanner */
+    rift_regex_automaton_t *combined;  /**< Union NFA tagged by pattern, built by compile */
+    rift_lazy_dfa_t *scanner;          /**< Unanchored lazy DFA over the union */
+    rift_aho_corasick_t *literals;     /**< Scanner used instead when all are literals */
+    uint64_t *matched;                 /**< Bitset of the patterns matched by the last scan */
+    size_t matched_words;              /**< Number of 64-bit words in matched */
+    size_t *union_starts;              /**< Union state each pattern's copy starts at */
+    size_t *union_sizes;               /**< Union states of each pattern's copy */
+    bool *merged;                      /**< Whether each pattern's current automaton is in */
+    size_t dead_states;                /**< Union states of copies cut off since the build */
+} rift_pattern_set_t;
+
+/**
+ * @brief Create an empty pattern set
+ *
+ * @param max_cached_states State cache capacity of the scanner (0 for the default)
+ * @return A new pattern set or NULL on failure
+ */
+rift_pattern_set_t *rift_pattern_set_create(size_t max_cached_states);
+
+/**
+ * @brief Free a pattern set
+ *
+ * @param set The pattern set to free
+ */
+void rift_pattern_set_free(rift_pattern_set_t *set);
+
+/**
+ * @brief Compile a pattern and add it to a set
+ *
+ * @param set The pattern set
+ * @param pattern The pattern string
+ * @param flags Compilation flags
+ * @param id Pointer to store the identifier of the pattern (can be NULL)
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+bool rift_pattern_set_add(rift_pattern_set_t *set, const char *pattern, rift_regex_flags_t flags,
+                          uint32_t *id, rift_regex_error_t *error);
+
+/**
+ * @brief Add a compiled automaton to a set
+ *
+ * The set keeps its own copy, so the automaton may change or be freed
+ * afterwards.
+ *
+ * @param set The pattern set
+ * @param automaton The automaton of the pattern
+ * @param id Pointer to store the identifier of the pattern (can be NULL)
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+bool rift_pattern_set_add_automaton(rift_pattern_set_t *set,
+                                    const rift_regex_automaton_t *automaton, uint32_t *id,
+                                    rift_regex_error_t *error);
+
+/**
+ * @brief Compile a pattern and put it in place of one in a set
+ *
+ * Compiling goes through the process-wide pattern cache, so rebuilding a
+ * ruleset only compiles the patterns whose text changed.
+ *
+ * @param set The pattern set
+ * @param id The identifier of the pattern to replace
+ * @param pattern The new pattern string
+ * @param flags Compilation flags
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise, leaving the old pattern in place
+ */
+bool rift_pattern_set_replace(rift_pattern_set_t *set, uint32_t id, const char *pattern,
+                              rift_regex_flags_t flags, rift_regex_error_t *error);
+
+/**
+ * @brief Put a compiled automaton in place of a pattern of a set
+ *
+ * The set keeps its own copy, and the pattern keeps its identifier.
+ *
+ * @param set The pattern set
+ * @param id The identifier of the pattern to replace
+ * @param automaton The new automaton of the pattern
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise, leaving the old pattern in place
+ */
+bool rift_pattern_set_replace_automaton(rift_pattern_set_t *set, uint32_t id,
+                                        const rift_regex_automaton_t *automaton,
+                                        rift_regex_error_t *error);
+
+/**
+ * @brief Build the union automaton and scanner of a set
+ *
+ * The union has a new start state with an epsilon transition to the start
+ * state of every pattern, and every accepting state is tagged with the
+ * identifier of its pattern. A set compiled before only copies the patterns
+ * added or replaced since; the scanner is always created anew, an
+ * Aho-Corasick automaton when every pattern expands to literals with
+ * rift_aho_corasick_add_automaton() and a lazy DFA over the union otherwise.
+ *
+ * @param set The pattern set
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+bool rift_pattern_set_compile(rift_pattern_set_t *set, rift_regex_error_t *error);
+
+/**
+ * @brief Get the union automaton of a compiled set
+ *
+ * Converting it with rift_automaton_nfa_to_dfa() keeps the accept tags.
+ *
+ * @param set The pattern set
+ * @return The union automaton or NULL if the set is not compiled
+ */
+const rift_regex_automaton_t *rift_pattern_set_get_automaton(const rift_pattern_set_t *set);
+
+/**
+ * @brief Get the number of patterns in a set
+ *
+ * @param set The pattern set
+ * @return Number of patterns
+ */
+size_t rift_pattern_set_get_count(const rift_pattern_set_t *set);
+
+/**
+ * @brief Find every pattern that matches somewhere in the input
+ *
+ * The set is compiled first if needed. Empty matches count, so a pattern such
+ * as "a*" matches every input.
+ *
+ * @param set The pattern set
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param ids Array for the identifiers of matching patterns in ascending order (can be NULL)
+ * @param max_ids Capacity of the ids array
+ * @param error Pointer to store error information (can be NULL)
+ * @return Number of matching patterns, which may exceed max_ids, or 0 on failure
+ */
+size_t rift_pattern_set_scan(rift_pattern_set_t *set, const char *input, size_t length,
+                             uint32_t *ids, size_t max_ids, rift_regex_error_t *error);
+
+/**
+ * @brief Check whether a pattern matched in the last scan
+ *
+ * @param set The pattern set
+ * @param id The pattern identifier
+ * @return true if the pattern matched, false otherwise
+ */
+bool rift_pattern_set_matched(const rift_pattern_set_t *set, uint32_t id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_ENGINE_PATTERN_SET_H */
@@ -0,0 +1,196 @@
+/**
+ * @file rulebank.h
+ * @brief Named patterns compiled once and matched line by line from any thread
+ *
+ * A rule bank holds a set of named patterns compiled when they are added,
+ * and gives every thread that matches with it matchers of its own, created
+ * on the thread's first match and reused for every line after. Matching a
+ * line then neither compiles nor allocates, which is what code that
+ * compiled and freed its patterns around every line was paying for.
+ *
+ * Rules are added before the first match; from then on the bank is shared
+ * read-only and rift_rulebank_match() may run on any number of threads at
+ * once, each with its own results.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_ENGINE_RULEBANK_H
+#define LIBRIFT_REGEX_ENGINE_RULEBANK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/automaton/flags.h"
+#include "core/errors/regex_error.h"
+#include "core/runtime/match_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Rule index meaning no rule
+ */
+#define RIFT_RULEBANK_NO_RULE UINT32_MAX
+
+/**
+ * @brief Options of a rule bank
+ */
+typedef enum rift_rulebank_option {
+    RIFT_RULEBANK_OPTION_NONE = 0x00000000,       /**< Try every rule on every line */
+    RIFT_RULEBANK_OPTION_FIRST_MATCH = 0x00000001 /**< Stop at the first rule that matches */
+} rift_rulebank_option_t;
+
+/**
+ * @brief Forward declaration of the rule bank structure
+ */
+typedef struct rift_rulebank rift_rulebank_t;
+
+/**
+ * @brief Forward declaration of the match results of a rule bank
+ */
+typedef struct rift_rulebank_results rift_rulebank_results_t;
+
+/**
+ * @brief Create an empty rule bank
+ *
+ * @param options Options of the bank
+ * @return A new rule bank or NULL on failure
+ */
+rift_rulebank_t *rift_rulebank_create(rift_rulebank_option_t options);
+
+/**
+ * @brief Free a rule bank and the matchers of every thread
+ *
+ * No thread may be matching with the bank.
+ *
+ * @param bank The rule bank (can be NULL)
+ */
+void rift_rulebank_free(rift_rulebank_t *bank);
+
+/**
+ * @brief Compile a pattern and add it to a bank as a named rule
+ *
+ * Compiling goes through the process-wide pattern cache, so banks made of
+ * the same patterns share their compiled forms. Rules are tried in the
+ * order they are added.
+ *
+ * @param bank The rule bank
+ * @param name Name of the rule, unique in the bank (copied)
+ * @param pattern The pattern string
+ * @param flags Compilation flags
+ * @param rule Pointer to store the index of the rule (can be NULL)
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false on a duplicate name, a pattern that does
+ *         not compile, or a bank already used for matching
+ */
+bool rift_rulebank_add(rift_rulebank_t *bank, const char *name, const char *pattern,
+                       rift_regex_flags_t flags, uint32_t *rule, rift_regex_error_t *error);
+
+/**
+ * @brief Get the number of rules of a bank
+ *
+ * @param bank The rule bank
+ * @return Number of rules
+ */
+size_t rift_rulebank_get_count(const rift_rulebank_t *bank);
+
+/**
+ * @brief Find a rule by name
+ *
+ * @param bank The rule bank
+ * @param name Name of the rule
+ * @return Index of the rule, or RIFT_RULEBANK_NO_RULE if the bank has none of that name
+ */
+uint32_t rift_rulebank_find(const rift_rulebank_t *bank, const char *name);
+
+/**
+ * @brief Get the name of a rule
+ *
+ * @param bank The rule bank
+ * @param rule Index of the rule
+ * @return The name, or NULL for an invalid index
+ */
+const char *rift_rulebank_get_name(const rift_rulebank_t *bank, uint32_t rule);
+
+/**
+ * @brief Get the number of capture groups of a rule
+ *
+ * @param bank The rule bank
+ * @param rule Index of the rule
+ * @return Number of capture groups, 0 for an invalid index
+ */
+size_t rift_rulebank_get_group_count(const rift_rulebank_t *bank, uint32_t rule);
+
+/**
+ * @brief Create results sized for the rules of a bank
+ *
+ * Results belong to one caller at a time and can be reused for every line.
+ * They are sized for the rules the bank has when they are created.
+ *
+ * @param bank The rule bank
+ * @return New results or NULL on failure
+ */
+rift_rulebank_results_t *rift_rulebank_results_create(const rift_rulebank_t *bank);
+
+/**
+ * @brief Free results
+ *
+ * @param results The results (can be NULL)
+ */
+void rift_rulebank_results_free(rift_rulebank_results_t *results);
+
+/**
+ * @brief Match a line against the rules of a bank
+ *
+ * Every rule is searched for in the line, in the order the rules were
+ * added, or only up to the first that matches with
+ * RIFT_RULEBANK_OPTION_FIRST_MATCH. The first match of each rule and its
+ * capture groups are recorded in results as spans of the line. The calling
+ * thread's matchers are created on its first match; after that, matching
+ * does not allocate.
+ *
+ * @param bank The rule bank
+ * @param line The line, which need not be NUL-terminated
+ * @param length Length of the line
+ * @param results Results created for the bank, overwritten
+ * @return Number of rules that matched, 0 if none did or on failure
+ */
+size_t rift_rulebank_match(rift_rulebank_t *bank, const char *line, size_t length,
+                           rift_rulebank_results_t *results);
+
+/**
+ * @brief Check whether a rule matched the last line
+ *
+ * @param results The results
+ * @param rule Index of the rule
+ * @return true if the rule matched, false otherwise
+ */
+bool rift_rulebank_results_matched(const rift_rulebank_results_t *results, uint32_t rule);
+
+/**
+ * @brief Get the first rule that matched the last line
+ *
+ * @param results The results
+ * @return Index of the rule, or RIFT_RULEBANK_NO_RULE if none matched
+ */
+uint32_t rift_rulebank_results_first(const rift_rulebank_results_t *results);
+
+/**
+ * @brief Get the span of a rule's match or of one of its capture groups
+ *
+ * @param results The results
+ * @param rule Index of the rule
+ * @param group 0 for the whole match, i for capture group i
+ * @param span Pointer to store the span, offsets into the line
+ * @return true if the rule matched and the group took part, false otherwise
+ */
+bool rift_rulebank_results_get_span(const rift_rulebank_results_t *results, uint32_t rule,
+                                    size_t group, rift_regex_span_t *span);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_ENGINE_RULEBANK_H */
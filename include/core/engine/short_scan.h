@@ -0,0 +1,122 @@
+/**
+ * @file short_scan.h
+ * @brief Lane-parallel matching of many short inputs for the LibRift regex engine
+ *
+ * This file defines a scanner answering whether a pattern matches each of a
+ * large number of short inputs, such as the fields of a CSV column. Instead
+ * of one search per input, the scanner compiles the pattern into a search
+ * DFA table once and steps a group of inputs through it together, one lane
+ * per input. Builds with AVX2 do each step of the group with one gathered
+ * table load; other builds interleave the lanes in scalar code.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_REGEX_ENGINE_SHORT_SCAN_H
+#define LIBRIFT_REGEX_ENGINE_SHORT_SCAN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/automaton/automaton.h"
+#include "core/automaton/dfa_table.h"
+#include "core/errors/regex_error.h"
+#include "core/runtime/matcher.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Number of inputs stepped through the table together
+ */
+#define RIFT_SHORT_SCAN_LANES 8
+
+/**
+ * @brief Largest search DFA a scanner builds before falling back to a matcher
+ */
+#define RIFT_SHORT_SCAN_MAX_STATES 4096
+
+/**
+ * @brief Scanner of many short inputs for one pattern
+ *
+ * A scanner is used by one thread at a time: the fallback matcher keeps the
+ * state of its last search.
+ */
+typedef struct rift_short_scanner {
+    rift_dfa_table_t *table;       /**< Search table, accepting rows absorbing, or NULL */
+    rift_regex_matcher_t *matcher; /**< Matcher for patterns the table cannot run, or NULL */
+} rift_short_scanner_t;
+
+/**
+ * @brief Create a scanner for a compiled pattern
+ *
+ * Patterns with anchors, word boundaries, atomic groups, lookarounds,
+ * counted loops or backreferences, and patterns whose search DFA exceeds
+ * RIFT_SHORT_SCAN_MAX_STATES states, are searched with a matcher instead,
+ * one input at a time.
+ *
+ * @param pattern The compiled pattern
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new scanner or NULL on failure
+ */
+rift_short_scanner_t *rift_short_scanner_create(const rift_regex_pattern_t *pattern,
+                                                rift_regex_error_t *error);
+
+/**
+ * @brief Create a scanner searching for the language of an automaton
+ *
+ * @param nfa The automaton, with no backreferences
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new scanner, or NULL if the automaton asserts anything about
+ *         positions or its search DFA is too large
+ */
+rift_short_scanner_t *rift_short_scanner_create_from_automaton(const rift_regex_automaton_t *nfa,
+                                                               rift_regex_error_t *error);
+
+/**
+ * @brief Check whether the pattern matches somewhere in each of several inputs
+ *
+ * Inputs are taken RIFT_SHORT_SCAN_LANES at a time and every group runs for
+ * as many steps as its longest input, so inputs of similar lengths make the
+ * best use of the lanes.
+ *
+ * @param scanner The scanner
+ * @param inputs The inputs (an input can be NULL, which never matches)
+ * @param lengths Lengths of the inputs in bytes, NULL to use strlen
+ * @param count Number of inputs
+ * @param bitmap Array of (count + 63) / 64 words, bit i % 64 of word i / 64 set
+ *               when input i matches
+ * @return true if successful, false on invalid parameters
+ */
+bool rift_short_scanner_match(rift_short_scanner_t *scanner, const char *const *inputs,
+                              const size_t *lengths, size_t count, uint64_t *bitmap);
+
+/**
+ * @brief Free a scanner
+ *
+ * @param scanner The scanner (can be NULL)
+ */
+void rift_short_scanner_free(rift_short_scanner_t *scanner);
+
+/**
+ * @brief Check whether a pattern matches somewhere in each of several inputs
+ *
+ * Builds a scanner for the call. Callers filtering several batches with the
+ * same pattern keep a scanner instead.
+ *
+ * @param pattern The compiled pattern
+ * @param inputs The inputs (an input can be NULL, which never matches)
+ * @param lengths Lengths of the inputs in bytes, NULL to use strlen
+ * @param count Number of inputs
+ * @param bitmap Array of (count + 63) / 64 words to fill, one bit per input
+ * @return true if successful, false on invalid parameters or allocation failure
+ */
+bool rift_match_many_short(const rift_regex_pattern_t *pattern, const char *const *inputs,
+                           const size_t *lengths, size_t count, uint64_t *bitmap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_ENGINE_SHORT_SCAN_H */
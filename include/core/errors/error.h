@@ -69,6 +69,10 @@ typedef void (*rift_error_callback_t)(const rift_error_info_t *info);
 /**
  * @brief Set the current error information
  *
+ * The current error belongs to the calling thread. The message is formatted
+ * when it is first read, so the format string must outlive the error, as
+ * string literals do; string arguments are copied.
+ *
  * @param status Error status code
  * @param line Line number where the error occurred
  * @param file Source file where the error occurred
@@ -78,9 +82,10 @@ typedef void (*rift_error_callback_t)(const rift_error_info_t *info);
 void rift_error_set(rift_status_t status, int line, const char *file, const char *message, ...);
 
 /**
- * @brief Get the current error information
+ * @brief Get the current error information of the calling thread
  *
- * @return Pointer to the current error information
+ * @return Pointer to the current error information, valid until the thread
+ *         sets or clears its error
  */
 const rift_error_info_t *rift_error_get(void);
 
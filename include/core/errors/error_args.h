@@ -0,0 +1,129 @@
+/**
+ * @file error_args.h
+ * @brief Deferred formatting of error messages for the LibRift library
+ *
+ * This file defines a compact record of an error message's format string and
+ * arguments. Setting an error stores the record instead of running printf,
+ * and the message is only formatted when it is read, so operations that
+ * report errors nobody looks at, such as failed match attempts, skip the
+ * formatting entirely. String arguments are copied, since the strings they
+ * point to may be gone by the time the message is read.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#ifndef LIBRIFT_CORE_ERROR_ARGS_H
+#define LIBRIFT_CORE_ERROR_ARGS_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Most arguments a deferred message can take
+ */
+#define RIFT_ERROR_ARGS_MAX 6
+
+/**
+ * @brief Bytes available for copies of the string arguments of a deferred message
+ */
+#define RIFT_ERROR_ARGS_TEXT_LENGTH 96
+
+/**
+ * @brief Types an argument of a deferred message is read as
+ */
+typedef enum rift_error_arg_type {
+    RIFT_ERROR_ARG_INT,       /**< int, and the char and short types promoted to it */
+    RIFT_ERROR_ARG_LONG,      /**< long */
+    RIFT_ERROR_ARG_LONG_LONG, /**< long long */
+    RIFT_ERROR_ARG_SIZE,      /**< size_t */
+    RIFT_ERROR_ARG_INTMAX,    /**< intmax_t */
+    RIFT_ERROR_ARG_PTRDIFF,   /**< ptrdiff_t */
+    RIFT_ERROR_ARG_DOUBLE,    /**< double */
+    RIFT_ERROR_ARG_POINTER,   /**< void * */
+    RIFT_ERROR_ARG_STRING     /**< String copied into the record's text */
+} rift_error_arg_type_t;
+
+/**
+ * @brief One argument of a deferred message
+ */
+typedef struct rift_error_arg {
+    rift_error_arg_type_t type; /**< Type the argument was read as */
+    union {
+        int i;
+        long l;
+        long long ll;
+        size_t z;
+        intmax_t j;
+        ptrdiff_t t;
+        double d;
+        const void *p;
+        size_t text; /**< Offset of a copied string in the record's text */
+    } value;
+} rift_error_arg_t;
+
+/**
+ * @brief A message's format string and arguments, waiting to be formatted
+ *
+ * The format string is not copied; it must outlive the record, as the string
+ * literals errors are set with do.
+ */
+typedef struct rift_error_args {
+    const char *format;                         /**< Format string, or NULL if none is pending */
+    rift_error_arg_t args[RIFT_ERROR_ARGS_MAX]; /**< Arguments in format order */
+    uint8_t count;                              /**< Number of arguments */
+    uint8_t text_used;                          /**< Bytes of text in use */
+    char text[RIFT_ERROR_ARGS_TEXT_LENGTH];     /**< Copies of the string arguments */
+} rift_error_args_t;
+
+/**
+ * @brief Record a format string and its arguments without formatting them
+ *
+ * Formats using conversions the record cannot hold (%n, long double, '*'
+ * widths), more than RIFT_ERROR_ARGS_MAX arguments, or strings longer than
+ * the text left are refused; the caller then formats the message right away
+ * from its own copy of the arguments.
+ *
+ * @param record The record (left empty when refused)
+ * @param format Format string
+ * @param args Arguments for the format string
+ * @return true if recorded, false if the message must be formatted now
+ */
+bool rift_error_args_capture(rift_error_args_t *record, const char *format, va_list args);
+
+/**
+ * @brief Format a recorded message
+ *
+ * @param record The record
+ * @param buffer Buffer to store the message
+ * @param buffer_size Size of the buffer
+ * @return true if a message was pending and written (possibly truncated)
+ */
+bool rift_error_args_format(const rift_error_args_t *record, char *buffer, size_t buffer_size);
+
+/**
+ * @brief Check whether a record holds a message waiting to be formatted
+ *
+ * @param record The record
+ * @return true if a message is pending
+ */
+bool rift_error_args_pending(const rift_error_args_t *record);
+
+/**
+ * @brief Drop any message waiting in a record
+ *
+ * @param record The record
+ */
+void rift_error_args_clear(rift_error_args_t *record);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_CORE_ERROR_ARGS_H */
@@ -6,6 +6,11 @@
  * handling in the LibRift regex engine. It provides a consistent interface
  * for reporting and handling errors across the regex components.
  *
+ * Errors set with rift_regex_error_set_formatted() record their format and
+ * arguments and are only formatted when read through rift_regex_error_message()
+ * or rift_regex_error_format(), so a message field that is still empty on an
+ * error with a code may simply not have been formatted yet.
+ *
  * @copyright Copyright (c) 2025 LibRift Project
  * @license MIT License
  */
@@ -15,6 +20,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "core/errors/error_args.h"
 #ifndef LIBRIFT_REGEX_ERRORS_REGEX_ERROR_H
 #define LIBRIFT_REGEX_ERRORS_REGEX_ERROR_H
 
@@ -135,6 +141,7 @@ typedef struct rift_regex_error {
     rift_regex_error_code_t code; /**< Error code indicating the type of error */
     char message[RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH]; /**< Fixed-size message buffer */
     size_t position;                                   /**< Position where the error occurred */
+    rift_error_args_t deferred; /**< Message waiting to be formatted into the buffer */
 } rift_regex_error_t;
 
 /**
@@ -180,6 +187,10 @@ void rift_regex_error_set_with_message(rift_regex_error_t *error, int code, cons
 /**
  * @brief Set a formatted regex error message
  *
+ * Only the format and its arguments are recorded; the message is formatted
+ * the first time it is read. Formats the record cannot hold are formatted
+ * right away.
+ *
  * @param error The regex error object
  * @param code The error code
  * @param format The format string
@@ -226,6 +237,14 @@ rift_regex_error_t *rift_regex_error_create(rift_regex_error_code_t code, const
  */
 void rift_regex_error_free(rift_regex_error_t *error);
 
+/**
+ * @brief Get the message of an error, formatting it first if it is deferred
+ *
+ * @param error Pointer to the error object
+ * @return The message, or an empty string if there is none
+ */
+const char *rift_regex_error_message(rift_regex_error_t *error);
+
 /**
  * @brief Format an error object to a string
  *
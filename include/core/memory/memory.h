@@ -13,6 +13,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
+#include "core/errors/error.h"
 #ifndef LIBRIFT_CORE_MEMORY_H
 #define LIBRIFT_CORE_MEMORY_H
 
@@ -21,6 +22,37 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Whether memory tracking is compiled in
+ *
+ * Define to 0 to make rift_malloc, rift_realloc and rift_free plain calls
+ * to the configured allocator: no block header, no statistics and no
+ * allocation limit.
+ */
+#ifndef RIFT_MEMORY_TRACKING
+#define RIFT_MEMORY_TRACKING 1
+#endif
+
+/**
+ * @brief Number of shards the tracking statistics are split into
+ *
+ * Threads count into a shard of their own and the shards are summed on
+ * read, so tracked allocations on different threads do not contend.
+ */
+#ifndef RIFT_MEMORY_STATS_SHARDS
+#define RIFT_MEMORY_STATS_SHARDS 64
+#endif
+
+/**
+ * @brief Growth of a shard, in bytes, after which the peak usage is updated
+ *
+ * The reported peak can miss a short-lived high of up to this many bytes
+ * per shard.
+ */
+#ifndef RIFT_MEMORY_PEAK_GRANULE
+#define RIFT_MEMORY_PEAK_GRANULE (64 * 1024)
+#endif
+
 /**
  * @brief Structure holding memory tracking statistics
  */
@@ -32,6 +64,31 @@ typedef struct rift_memory_stats {
     size_t active_allocs; /**< Currently active allocations */
 } rift_memory_stats_t;
 
+/**
+ * @brief Subsystems allocations are attributed to while profiling
+ */
+typedef enum rift_memory_tag {
+    RIFT_MEMORY_TAG_OTHER = 0,   /**< Not attributed to a subsystem */
+    RIFT_MEMORY_TAG_TOKENIZER,   /**< Tokenizer state */
+    RIFT_MEMORY_TAG_PARSER,      /**< Parser state and AST nodes */
+    RIFT_MEMORY_TAG_AUTOMATON,   /**< NFA construction */
+    RIFT_MEMORY_TAG_DFA,         /**< Dense tables and lazy DFA caches */
+    RIFT_MEMORY_TAG_VM,          /**< Pike VM thread lists */
+    RIFT_MEMORY_TAG_BACKTRACKER, /**< Backtracking stacks */
+    RIFT_MEMORY_TAG_RESULTS,     /**< Match results handed to callers */
+    RIFT_MEMORY_TAG_COUNT        /**< Number of tags */
+} rift_memory_tag_t;
+
+/**
+ * @brief Allocation counters of one subsystem tag
+ */
+typedef struct rift_memory_tag_stats {
+    size_t allocs;          /**< Allocations made under the tag */
+    size_t frees;           /**< Frees of blocks allocated under the tag */
+    size_t bytes_allocated; /**< Bytes allocated under the tag */
+    size_t bytes_freed;     /**< Bytes of those blocks freed */
+} rift_memory_tag_stats_t;
+
 /**
  * @brief Function type for memory allocation
  */
@@ -88,9 +145,21 @@ void *rift_calloc(size_t num, size_t size);
  */
 char *rift_strdup(const char *str);
 
+/**
+ * @brief Invalidate the allocator settings cached from the configuration
+ *
+ * The allocation functions read the allocators and the allocation limit
+ * from the configuration once and keep them; the configuration calls this
+ * whenever it changes so they are read again on the next allocation.
+ */
+void rift_memory_config_changed(void);
+
 /**
  * @brief Enable memory usage tracking
  *
+ * Statistics are only kept, and the allocation limit only enforced, while
+ * tracking is enabled. Without RIFT_MEMORY_TRACKING this does nothing.
+ *
  * @param enabled Whether to enable memory tracking
  * @return Previous state of memory tracking
  */
@@ -122,6 +191,368 @@ void rift_memory_get_stats(size_t *current_usage, size_t *peak_usage, size_t *to
  */
 rift_status_t rift_memory_report(char *buffer, size_t buffer_size);
 
+/**
+ * @brief Enable allocation profiling by subsystem tag
+ *
+ * While profiling is enabled, every block rift_malloc hands out counts
+ * under the tag in use on the allocating thread, and its free and resizes
+ * count under the same tag whichever thread makes them. Blocks allocated
+ * before profiling was enabled count their frees only. Reset the counters
+ * with rift_memory_tracking_reset. Without RIFT_MEMORY_TRACKING this does
+ * nothing.
+ *
+ * @param enabled Whether to enable profiling
+ * @return Previous state of profiling
+ */
+bool rift_memory_profiling_enable(bool enabled);
+
+/**
+ * @brief Make a tag the one allocations on the calling thread count under
+ *
+ * Subsystems call this on entry and restore the previous tag on exit, so
+ * the allocations of nested subsystems count under their own tags.
+ *
+ * @param tag The tag
+ * @return The previous tag, to restore with another call
+ */
+rift_memory_tag_t rift_memory_tag_use(rift_memory_tag_t tag);
+
+/**
+ * @brief Allocate memory under a tag, whatever tag is in use on the thread
+ *
+ * @param size Size to allocate in bytes
+ * @param tag The tag
+ * @return Allocated memory to release with rift_free, or NULL on failure
+ */
+void *rift_malloc_tagged(size_t size, rift_memory_tag_t tag);
+
+/**
+ * @brief Allocate zeroed memory under a tag, whatever tag is in use on the thread
+ *
+ * @param num Number of elements
+ * @param size Size of each element in bytes
+ * @param tag The tag
+ * @return Allocated memory to release with rift_free, or NULL on failure
+ */
+void *rift_calloc_tagged(size_t num, size_t size, rift_memory_tag_t tag);
+
+/**
+ * @brief Get the name of a tag as it appears in the profile report
+ *
+ * @param tag The tag
+ * @return The name, "other" for tags out of range
+ */
+const char *rift_memory_tag_name(rift_memory_tag_t tag);
+
+/**
+ * @brief Get the profiling counters of a tag
+ *
+ * @param tag The tag
+ * @param stats Pointer to store the counters
+ */
+void rift_memory_get_tag_stats(rift_memory_tag_t tag, rift_memory_tag_stats_t *stats);
+
+/**
+ * @brief Write the profiling counters of every tag as JSON
+ *
+ * The object has a "profiling" member telling whether profiling is
+ * enabled and a "tags" member with the counters and current bytes of
+ * each tag by name.
+ *
+ * @param buffer Buffer to store the report
+ * @param buffer_size Size of the buffer
+ * @return RIFT_OK on success, error code on failure
+ */
+rift_status_t rift_memory_profile_report(char *buffer, size_t buffer_size);
+
+/**
+ * @brief Default size of the blocks an arena carves allocations from
+ */
+#ifndef RIFT_ARENA_DEFAULT_BLOCK_SIZE
+#define RIFT_ARENA_DEFAULT_BLOCK_SIZE (16 * 1024)
+#endif
+
+/**
+ * @brief Region allocator for the intermediates of one compilation
+ *
+ * Allocations are carved from large blocks and are never freed one by one;
+ * everything goes at once when the arena is reset or freed. Blocks come
+ * from rift_malloc, so they count towards tracking and the allocation
+ * limit. An arena is not thread-safe; each compilation uses its own.
+ */
+typedef struct rift_arena rift_arena_t;
+
+/**
+ * @brief Counters of an arena
+ */
+typedef struct rift_arena_stats {
+    size_t allocations;    /**< Allocations served since the last reset */
+    size_t bytes_used;     /**< Bytes handed out, alignment padding included */
+    size_t bytes_reserved; /**< Bytes in the blocks held */
+    size_t blocks;         /**< Blocks held */
+} rift_arena_stats_t;
+
+/**
+ * @brief Create an arena
+ *
+ * Allocations larger than a quarter of the block size get a block of
+ * their own.
+ *
+ * @param block_size Size of the blocks, 0 for RIFT_ARENA_DEFAULT_BLOCK_SIZE
+ * @return A new arena or NULL on failure
+ */
+rift_arena_t *rift_arena_create(size_t block_size);
+
+/**
+ * @brief Free an arena and everything allocated from it
+ *
+ * @param arena The arena (can be NULL)
+ */
+void rift_arena_free(rift_arena_t *arena);
+
+/**
+ * @brief Free everything allocated from an arena but keep it for reuse
+ *
+ * One block is kept, so an arena reused for compilations of similar size
+ * stops calling the system allocator.
+ *
+ * @param arena The arena
+ */
+void rift_arena_reset(rift_arena_t *arena);
+
+/**
+ * @brief Allocate memory from an arena
+ *
+ * The memory is aligned for any type.
+ *
+ * @param arena The arena
+ * @param size Size to allocate in bytes
+ * @return Allocated memory or NULL on failure
+ */
+void *rift_arena_alloc(rift_arena_t *arena, size_t size);
+
+/**
+ * @brief Allocate zero-initialized memory from an arena
+ *
+ * @param arena The arena
+ * @param num Number of elements
+ * @param size Size of each element in bytes
+ * @return Allocated memory or NULL on failure
+ */
+void *rift_arena_calloc(rift_arena_t *arena, size_t num, size_t size);
+
+/**
+ * @brief Resize memory allocated from an arena
+ *
+ * The last allocation grows in place when its block has room; anything
+ * else is copied to a new allocation and the old space is only reclaimed
+ * with the arena.
+ *
+ * @param arena The arena
+ * @param ptr Memory from rift_arena_alloc (can be NULL)
+ * @param old_size Size ptr was allocated with
+ * @param new_size New size in bytes
+ * @return Resized memory or NULL on failure, in which case ptr is untouched
+ */
+void *rift_arena_realloc(rift_arena_t *arena, void *ptr, size_t old_size, size_t new_size);
+
+/**
+ * @brief Duplicate a string into an arena
+ *
+ * @param arena The arena
+ * @param str String to duplicate
+ * @return Duplicated string or NULL on failure
+ */
+char *rift_arena_strdup(rift_arena_t *arena, const char *str);
+
+/**
+ * @brief Duplicate at most length bytes of a string into an arena
+ *
+ * @param arena The arena
+ * @param str String to duplicate
+ * @param length Maximum number of bytes to copy
+ * @return Duplicated, NUL-terminated string or NULL on failure
+ */
+char *rift_arena_strndup(rift_arena_t *arena, const char *str, size_t length);
+
+/**
+ * @brief Read the counters of an arena
+ *
+ * @param arena The arena
+ * @param stats Pointer to store the counters
+ */
+void rift_arena_get_stats(const rift_arena_t *arena, rift_arena_stats_t *stats);
+
+/**
+ * @brief An allocator with a context pointer
+ *
+ * Lets the allocations of a compilation or a match go to a per-request
+ * arena, a jemalloc arena or a hugepage pool instead of the allocator of
+ * the configuration. While an allocator is in use on a thread, rift_malloc
+ * takes its blocks from it and marks them, so rift_realloc and rift_free
+ * route them back to it whichever allocator is in use when they are
+ * called. The callbacks run with no allocator in use on the thread, so
+ * they may call rift_malloc themselves. The struct must outlive every block
+ * allocated through it.
+ */
+typedef struct rift_allocator {
+    /** Allocate size bytes, aligned like malloc; NULL on failure */
+    void *(*allocate)(void *ctx, size_t size);
+    /** Resize a block (can be NULL to allocate, copy and deallocate instead) */
+    void *(*reallocate)(void *ctx, void *ptr, size_t old_size, size_t new_size);
+    /** Free a block (can be NULL when the memory goes with the context) */
+    void (*deallocate)(void *ctx, void *ptr, size_t size);
+    void *ctx; /**< Context passed to the callbacks */
+} rift_allocator_t;
+
+/**
+ * @brief Make an allocator the one rift_malloc uses on the calling thread
+ *
+ * Scopes nest: restore the returned allocator to end one. Without
+ * RIFT_MEMORY_TRACKING blocks cannot be marked, so the allocator is
+ * recorded but rift_malloc keeps using the configured one.
+ *
+ * @param allocator The allocator, NULL for the configured one
+ * @return The allocator in use before the call, NULL for the configured one
+ */
+const rift_allocator_t *rift_allocator_use(const rift_allocator_t *allocator);
+
+/**
+ * @brief Get the allocator in use on the calling thread
+ *
+ * @return The allocator, NULL for the configured one
+ */
+const rift_allocator_t *rift_allocator_current(void);
+
+/**
+ * @brief Fill an allocator that allocates from an arena
+ *
+ * Nothing is freed one by one; the blocks go when the arena is reset or
+ * freed, after which nothing allocated through the allocator may be used.
+ *
+ * @param allocator The allocator to fill
+ * @param arena The arena
+ */
+void rift_allocator_init_arena(rift_allocator_t *allocator, rift_arena_t *arena);
+
+/**
+ * @brief Whether object pools are compiled in
+ *
+ * Define to 0 to make the pool functions plain rift_malloc and rift_free
+ * calls, e.g. so a memory checker sees every object's lifetime.
+ */
+#ifndef RIFT_MEMORY_POOLS
+#define RIFT_MEMORY_POOLS 1
+#endif
+
+/**
+ * @brief Granularity of the pool size classes in bytes
+ */
+#ifndef RIFT_POOL_SIZE_CLASS
+#define RIFT_POOL_SIZE_CLASS 64
+#endif
+
+/**
+ * @brief Largest object size served from a pool; larger ones use rift_malloc
+ */
+#ifndef RIFT_POOL_MAX_OBJECT_SIZE
+#define RIFT_POOL_MAX_OBJECT_SIZE 2048
+#endif
+
+/**
+ * @brief Objects of each size class a thread keeps for itself
+ *
+ * Beyond this, half of the thread's objects move to the global free list
+ * of the class, where any thread can pick them up.
+ */
+#ifndef RIFT_POOL_THREAD_CACHE
+#define RIFT_POOL_THREAD_CACHE 32
+#endif
+
+/**
+ * @brief Allocate an object from the fixed-size object pools
+ *
+ * Objects are grouped into size classes of RIFT_POOL_SIZE_CLASS bytes.
+ * A thread first reuses the objects it released itself, then takes a
+ * batch from the global free list of the class, and only then allocates
+ * with rift_malloc. Released objects are kept for reuse and still count
+ * as allocated in the tracking statistics. While an allocator is in use on
+ * the thread, objects come from it and are not pooled, so pools never hold
+ * memory that goes with an allocator's context. Safe to call from any thread.
+ *
+ * @param size Size of the object in bytes
+ * @return Uninitialized memory aligned for any type, or NULL on failure
+ */
+void *rift_pool_alloc(size_t size);
+
+/**
+ * @brief Return an object to the pools
+ *
+ * The object may be released on another thread than the one that
+ * allocated it.
+ *
+ * @param ptr Object from rift_pool_alloc (can be NULL)
+ * @param size Size the object was allocated with
+ */
+void rift_pool_free(void *ptr, size_t size);
+
+/**
+ * @brief Release the objects kept by the pools
+ *
+ * Frees the calling thread's objects and those on the global free lists.
+ * Objects other threads keep for themselves are freed when those threads
+ * exit.
+ */
+void rift_pool_trim(void);
+
+/**
+ * @brief Alignment of the memory returned by rift_table_alloc in bytes
+ */
+#ifndef RIFT_TABLE_ALIGNMENT
+#define RIFT_TABLE_ALIGNMENT 64
+#endif
+
+/**
+ * @brief Default size from which tables are mapped from the OS page allocator
+ *
+ * Used as the table_page_threshold of the default configuration.
+ */
+#ifndef RIFT_TABLE_PAGE_THRESHOLD
+#define RIFT_TABLE_PAGE_THRESHOLD (2u * 1024 * 1024)
+#endif
+
+/**
+ * @brief Size of the huge pages page-mapped tables are aligned to
+ */
+#ifndef RIFT_TABLE_HUGE_PAGE_SIZE
+#define RIFT_TABLE_HUGE_PAGE_SIZE (2u * 1024 * 1024)
+#endif
+
+/**
+ * @brief Allocate a zeroed lookup table
+ *
+ * Meant for the large, read-mostly arrays matching scans, such as dense DFA
+ * transition tables. The memory is aligned to RIFT_TABLE_ALIGNMENT. Tables of
+ * at least the configured table_page_threshold are mapped on pages of their
+ * own on Linux; with table_huge_pages set they use reserved huge pages when
+ * the system has some, and are otherwise aligned to RIFT_TABLE_HUGE_PAGE_SIZE
+ * and marked for transparent huge pages, so a scan takes fewer TLB misses.
+ * Smaller tables, and all tables elsewhere, come from rift_malloc. Mapped
+ * tables count in the tracking statistics and the allocation limit too.
+ *
+ * @param num Number of elements
+ * @param size Size of each element in bytes
+ * @return Zeroed memory to release with rift_table_free, or NULL on failure
+ */
+void *rift_table_alloc(size_t num, size_t size);
+
+/**
+ * @brief Release a table from rift_table_alloc
+ *
+ * @param ptr The table (can be NULL)
+ */
+void rift_table_free(void *ptr);
+
 #ifdef __cplusplus
 }
 #endif
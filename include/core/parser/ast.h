@@ -197,6 +197,21 @@ bool build_ast_from_pattern(rift_regex_ast_node_t *root, const char *pattern,
 rift_regex_ast_t *rift_regex_parse(const char *pattern, rift_regex_flags_t flags,
                                    rift_regex_error_t *error);
 
+/**
+ * @brief Parse a regex pattern into an AST whose nodes live in an arena
+ *
+ * The nodes go with the arena, so the AST must be freed before the arena
+ * is reset or freed, and must not outlive it.
+ *
+ * @param pattern The pattern string
+ * @param flags Compilation flags
+ * @param arena Arena for the nodes, NULL to create them on the heap
+ * @param error Pointer to store error code (can be NULL)
+ * @return A new AST representing the pattern or NULL on failure
+ */
+rift_regex_ast_t *rift_regex_parse_in_arena(const char *pattern, rift_regex_flags_t flags,
+                                            struct rift_arena *arena, rift_regex_error_t *error);
+
 #ifdef __cplusplus
 }
 #endif
@@ -22,6 +22,9 @@
 /* Forward declaration for state information type */
 typedef struct rift_state_info rift_state_info_t;
 
+/* Forward declaration for the arena type of core/memory/memory.h */
+struct rift_arena;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -73,6 +76,8 @@ typedef struct rift_regex_ast_node {
     rift_regex_flags_t flags;              /**< Regex flags for this node */
     struct rift_regex_ast_node *parent;    /**< Parent node */
     rift_state_info_t *state_info;         /**< State information for this node */
+    struct rift_arena *arena;              /**< Arena the node lives in, NULL for the heap */
+    uint64_t hash;                         /**< Content hash of the subtree, 0 if not known */
 } rift_regex_ast_node_t;
 
 /**
@@ -83,6 +88,20 @@ typedef struct rift_regex_ast_node {
  */
 rift_regex_ast_node_t *rift_regex_ast_node_create(rift_regex_ast_node_type_t type);
 
+/**
+ * @brief Create a new AST node in an arena
+ *
+ * The node, its value and its children array live in the arena and go with
+ * it; freeing the node only frees the heap nodes below it. Children added
+ * to it should come from the same arena.
+ *
+ * @param arena The arena, NULL to create the node on the heap
+ * @param type The type of node to create
+ * @return A new AST node or NULL on failure
+ */
+rift_regex_ast_node_t *rift_regex_ast_node_create_in_arena(struct rift_arena *arena,
+                                                           rift_regex_ast_node_type_t type);
+
 /**
  * @brief Free an AST node and its resources (but not its children)
  *
@@ -159,6 +178,29 @@ size_t rift_regex_ast_node_get_child_count(const rift_regex_ast_node_t *node);
  */
 rift_regex_ast_node_t *rift_regex_ast_node_get_parent(const rift_regex_ast_node_t *node);
 
+/**
+ * @brief Get the content hash of a subtree
+ *
+ * The hash covers the type, value and flags of every node of the subtree
+ * and the order of children, so equal subtrees hash alike wherever they
+ * are. It is computed on first use and kept in the nodes; the functions
+ * that change a node forget it for the node and its ancestors.
+ *
+ * @param node The root of the subtree
+ * @return The hash, never 0, or 0 for a NULL node
+ */
+uint64_t rift_regex_ast_node_hash(const rift_regex_ast_node_t *node);
+
+/**
+ * @brief Forget the content hash of a node and of its ancestors
+ *
+ * Code that writes node fields directly instead of going through the
+ * functions of this file calls it on the nodes it changed.
+ *
+ * @param node The changed node
+ */
+void rift_regex_ast_node_invalidate_hash(rift_regex_ast_node_t *node);
+
 /**
  * @brief Clone a node (shallow copy, without children)
  *
@@ -0,0 +1,228 @@
+/**
+ * @file flat_ast.h
+ * @brief Header file for the flat, index-based AST of LibRift
+ *
+ * A flat AST holds the nodes of a parsed pattern in one vector, in the
+ * order a depth-first walk visits them, so passes that look at every node
+ * can iterate it linearly. Nodes refer to each other by 32-bit indices: the
+ * children of a node are a contiguous range of a shared child table, and
+ * node values are offsets into a string pool where equal values are stored
+ * once. Nodes, child table and pool live in a single allocation.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/automaton/flags.h"
+#include "core/errors/regex_error.h"
+#include "core/parser/ast.h"
+#include "core/parser/ast_node.h"
+#ifndef LIBRIFT_REGEX_PARSER_FLAT_AST_H
+#define LIBRIFT_REGEX_PARSER_FLAT_AST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Index of a node in a flat AST
+ */
+typedef uint32_t rift_regex_flat_node_id_t;
+
+/**
+ * @brief Index standing for no node, and value offset standing for no value
+ */
+#define RIFT_REGEX_FLAT_AST_NONE UINT32_MAX
+
+/**
+ * @brief Index of the root node of a flat AST
+ */
+#define RIFT_REGEX_FLAT_AST_ROOT 0
+
+/**
+ * @brief Node of a flat AST
+ */
+typedef struct rift_regex_flat_ast_node {
+    uint8_t type;                     /**< Node type, a rift_regex_ast_node_type_t */
+    uint32_t flags;                   /**< Regex flags for this node */
+    uint32_t value;                   /**< Offset of the value in the pool, or NONE */
+    uint32_t first_child;             /**< Start of the children in the child table */
+    uint32_t child_count;             /**< Number of children */
+    rift_regex_flat_node_id_t parent; /**< Parent node, NONE for the root */
+} rift_regex_flat_ast_node_t;
+
+/**
+ * @brief Flat AST structure
+ */
+typedef struct rift_regex_flat_ast {
+    rift_regex_flat_ast_node_t *nodes;   /**< Nodes in depth-first order, root first */
+    rift_regex_flat_node_id_t *children; /**< Child table indexed by the nodes' ranges */
+    char *strings;                       /**< Pool of NUL-terminated node values */
+    uint32_t node_count;                 /**< Number of nodes */
+    uint32_t string_size;                /**< Bytes used in the string pool */
+    size_t size;                         /**< Size of the allocation holding all three */
+    rift_regex_flags_t flags;            /**< Compilation flags used for this AST */
+    size_t group_count;                  /**< Number of capture groups in the AST */
+} rift_regex_flat_ast_t;
+
+/**
+ * @brief Build a flat AST from a node tree
+ *
+ * @param root The root of the tree, which is left untouched
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new flat AST or NULL on failure
+ */
+rift_regex_flat_ast_t *rift_regex_flat_ast_from_node(const rift_regex_ast_node_t *root,
+                                                     rift_regex_error_t *error);
+
+/**
+ * @brief Build a flat AST from an AST
+ *
+ * @param ast The AST, which is left untouched
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new flat AST or NULL on failure
+ */
+rift_regex_flat_ast_t *rift_regex_flat_ast_from_ast(const rift_regex_ast_t *ast,
+                                                    rift_regex_error_t *error);
+
+/**
+ * @brief Rebuild a node tree from a flat AST
+ *
+ * @param flat The flat AST
+ * @param id The node to start from
+ * @param arena Arena for the new nodes, NULL to create them on the heap
+ * @return The new tree or NULL on failure
+ */
+rift_regex_ast_node_t *rift_regex_flat_ast_to_node(const rift_regex_flat_ast_t *flat,
+                                                   rift_regex_flat_node_id_t id,
+                                                   struct rift_arena *arena);
+
+/**
+ * @brief Free a flat AST
+ *
+ * @param flat The flat AST to free
+ */
+void rift_regex_flat_ast_free(rift_regex_flat_ast_t *flat);
+
+/**
+ * @brief Clone a flat AST
+ *
+ * @param flat The flat AST to clone
+ * @return A new flat AST or NULL on failure
+ */
+rift_regex_flat_ast_t *rift_regex_flat_ast_clone(const rift_regex_flat_ast_t *flat);
+
+/**
+ * @brief Get the number of nodes
+ *
+ * Node indices run from RIFT_REGEX_FLAT_AST_ROOT to the count minus one,
+ * each node coming before its children.
+ *
+ * @param flat The flat AST
+ * @return The number of nodes
+ */
+size_t rift_regex_flat_ast_get_node_count(const rift_regex_flat_ast_t *flat);
+
+/**
+ * @brief Get the type of a node
+ *
+ * @param flat The flat AST
+ * @param id The node
+ * @return The node type, RIFT_REGEX_AST_NODE_NONE for an invalid node
+ */
+rift_regex_ast_node_type_t rift_regex_flat_ast_get_node_type(const rift_regex_flat_ast_t *flat,
+                                                             rift_regex_flat_node_id_t id);
+
+/**
+ * @brief Get the value of a node
+ *
+ * @param flat The flat AST
+ * @param id The node
+ * @return The node value or NULL if not set
+ */
+const char *rift_regex_flat_ast_get_node_value(const rift_regex_flat_ast_t *flat,
+                                               rift_regex_flat_node_id_t id);
+
+/**
+ * @brief Get the flags of a node
+ *
+ * @param flat The flat AST
+ * @param id The node
+ * @return The node flags
+ */
+rift_regex_flags_t rift_regex_flat_ast_get_node_flags(const rift_regex_flat_ast_t *flat,
+                                                      rift_regex_flat_node_id_t id);
+
+/**
+ * @brief Get the number of children of a node
+ *
+ * @param flat The flat AST
+ * @param id The node
+ * @return The number of children
+ */
+size_t rift_regex_flat_ast_get_child_count(const rift_regex_flat_ast_t *flat,
+                                           rift_regex_flat_node_id_t id);
+
+/**
+ * @brief Get a child of a node
+ *
+ * @param flat The flat AST
+ * @param id The node
+ * @param index The index of the child
+ * @return The child node, RIFT_REGEX_FLAT_AST_NONE if not found
+ */
+rift_regex_flat_node_id_t rift_regex_flat_ast_get_child(const rift_regex_flat_ast_t *flat,
+                                                        rift_regex_flat_node_id_t id,
+                                                        size_t index);
+
+/**
+ * @brief Get the parent of a node
+ *
+ * @param flat The flat AST
+ * @param id The node
+ * @return The parent node, RIFT_REGEX_FLAT_AST_NONE for the root
+ */
+rift_regex_flat_node_id_t rift_regex_flat_ast_get_parent(const rift_regex_flat_ast_t *flat,
+                                                         rift_regex_flat_node_id_t id);
+
+/**
+ * @brief Check if a node is of a specific type
+ *
+ * @param flat The flat AST
+ * @param id The node
+ * @param type The type to check against
+ * @return true if the node is of the specified type, false otherwise
+ */
+bool rift_regex_flat_ast_is_type(const rift_regex_flat_ast_t *flat, rift_regex_flat_node_id_t id,
+                                 rift_regex_ast_node_type_t type);
+
+/**
+ * @brief Count the capture groups of a flat AST
+ *
+ * @param flat The flat AST
+ * @return The number of capturing and named groups
+ */
+size_t rift_regex_flat_ast_count_groups(const rift_regex_flat_ast_t *flat);
+
+/**
+ * @brief Convert a node to a string representation (for debugging)
+ *
+ * Each node takes one line in the format of rift_regex_ast_node_to_string,
+ * indented two spaces per level below the node the text starts from.
+ *
+ * @param flat The flat AST
+ * @param id The node
+ * @param include_children Whether to include children in the string representation
+ * @return A string representation of the node (must be freed by caller)
+ */
+char *rift_regex_flat_ast_node_to_string(const rift_regex_flat_ast_t *flat,
+                                         rift_regex_flat_node_id_t id, bool include_children);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_REGEX_PARSER_FLAT_AST_H */
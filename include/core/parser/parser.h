@@ -3,7 +3,9 @@
  * @brief Header file for the regex parser component of LibRift
  *
  * This file defines the interface for parsing regular expression patterns
- * in the LibRift regex engine.
+ * in the LibRift regex engine. The parser is the single front end for both
+ * traditional patterns and LibRift's R'' syntax: it reads the pattern bytes
+ * once and builds the AST directly, in an arena when the root node has one.
  *
  * @copyright Copyright (c) 2025 LibRift Project
  * @license MIT License
@@ -35,6 +37,11 @@ extern "C" {
  */
 #define RIFT_REGEX_PARSER_MAX_ERROR_LENGTH 256
 
+/**
+ * Maximum nesting depth of groups the parser accepts
+ */
+#define RIFT_REGEX_PARSER_MAX_DEPTH 256
+
 /**
  * @brief Forward declaration for tokenizer type
  */
@@ -44,18 +51,23 @@ typedef struct rift_regex_tokenizer rift_regex_tokenizer_t;
  * @brief Structure representing the LibRift regex parser
  */
 typedef struct rift_regex_parser {
-    rift_regex_tokenizer_t *tokenizer;   /**< Tokenizer instance */
-    rift_regex_validator_t *validator;   /**< Validator instance */
-    rift_regex_flags_t flags;            /**< Parser flags */
-    rift_regex_ast_t *ast;               /**< Current AST being built */
-    rift_regex_ast_node_t *current_node; /**< Current node in AST construction */
+    rift_regex_tokenizer_t *tokenizer; /**< Tokenizer set by the caller, not used to parse */
+    rift_regex_validator_t *validator; /**< Validator instance */
+    rift_regex_flags_t flags;          /**< Parser flags */
+    struct rift_arena *arena;          /**< Arena of the nodes being built, NULL for the heap */
+    const char *input;                 /**< Pattern text being parsed, without any R'' quotes */
+    size_t length;                     /**< Length of the pattern text */
+    size_t position;                   /**< Current position in the pattern text */
+    size_t offset;                     /**< Offset of the pattern text in the whole pattern */
+    size_t depth;                      /**< Nesting depth of the group being parsed */
+    rift_regex_error_t error;          /**< Last error */
+    size_t error_position;             /**< Position of the last error, (size_t)-1 for none */
+    bool rift_syntax_mode;             /**< Whether the last pattern used R'' syntax */
+    bool rift_flag_enabled;            /**< Whether the -lrift flag is enabled */
+    bool owns_tokenizer;               /**< Whether the parser owns the tokenizer */
+    bool owns_validator;               /**< Whether the parser owns the validator */
 } rift_regex_parser_t;
 
-/**
- * Maximum length of error messages generated by the parser
- */
-#define RIFT_REGEX_PARSER_MAX_ERROR_LENGTH 256
-
 /**
  * @brief Create a new parser
  *
@@ -66,10 +78,18 @@ typedef struct rift_regex_parser {
 rift_regex_parser_t *rift_regex_parser_create(rift_regex_flags_t flags, bool rift_flag);
 
 /**
- * Forward declarations for recursive descent parsing
+ * @brief Initialize a parser in place, without a validator
+ *
+ * A parser initialized this way owns nothing and needs no call to
+ * rift_regex_parser_free.
+ *
+ * @param parser The parser to initialize
+ * @param flags Parsing flags to initialize with
+ * @param rift_flag Whether to enable LibRift syntax mode
  */
-static bool parse_atom(rift_regex_parser_t *parser);
-static bool parse_term(rift_regex_parser_t *parser);
+void rift_regex_parser_init(rift_regex_parser_t *parser, rift_regex_flags_t flags,
+                            bool rift_flag);
+
 /**
  * @brief Free resources associated with a parser
  *
@@ -97,6 +117,33 @@ rift_regex_ast_t *rift_regex_parser_parse(rift_regex_parser_t *parser, const cha
 rift_regex_ast_t *rift_regex_parser_parse_with_options(rift_regex_parser_t *parser,
                                                        const char *pattern,
                                                        rift_regex_flags_t flags);
+
+/**
+ * @brief Parse a regular expression pattern under an existing root node
+ *
+ * The nodes are created in the arena of the root, or on the heap when it
+ * has none. An R'' pattern is unwrapped once and only its body is parsed.
+ *
+ * @param parser The parser
+ * @param pattern The pattern to parse
+ * @param flags Flags that affect parsing
+ * @param root The node the pattern's tree is added to
+ * @return true if successful, false otherwise
+ */
+bool rift_regex_parser_parse_into(rift_regex_parser_t *parser, const char *pattern,
+                                  rift_regex_flags_t flags, rift_regex_ast_node_t *root);
+
+/**
+ * @brief Check the syntax of a pattern without keeping its AST
+ *
+ * @param parser The parser
+ * @param pattern The pattern to check
+ * @param flags Flags that affect parsing
+ * @return true if the pattern is valid, false otherwise
+ */
+bool rift_regex_parser_validate(rift_regex_parser_t *parser, const char *pattern,
+                                rift_regex_flags_t flags);
+
 /**
  * @brief Get the last error code
  *
@@ -106,6 +153,22 @@ rift_regex_ast_t *rift_regex_parser_parse_with_options(rift_regex_parser_t *pars
 rift_regex_error_t rift_regex_parser_get_error(const rift_regex_parser_t *parser);
 rift_regex_error_t rift_regex_pattern_parser_get_error(const rift_regex_parser_t *parser);
 
+/**
+ * @brief Get the code of the last error
+ *
+ * @param parser The parser
+ * @return The code of the last error, RIFT_REGEX_ERROR_NONE if none occurred
+ */
+rift_regex_error_code_t rift_regex_parser_get_error_code(const rift_regex_parser_t *parser);
+
+/**
+ * @brief Get the last error message
+ *
+ * @param parser The parser
+ * @return The last error message, empty if no error occurred
+ */
+const char *rift_regex_parser_get_error_message(const rift_regex_parser_t *parser);
+
 /* @brief Get the position of the last error
  *
  * @param parser The parser
@@ -116,8 +179,8 @@ size_t rift_regex_parser_get_error_position(const rift_regex_parser_t *parser);
 /**
  * @brief Set the tokenizer for the parser
  *
- * Normally, the parser creates a tokenizer internally, but this function
- * allows providing a custom tokenizer for testing or special cases.
+ * The parser reads pattern bytes itself; a tokenizer set here is only kept
+ * for callers that want the token stream of the same pattern.
  *
  * @param parser The parser
  * @param tokenizer The tokenizer to use
@@ -140,57 +203,57 @@ bool rift_regex_parser_set_validator(rift_regex_parser_t *parser,
                                      rift_regex_validator_t *validator);
 
 /**
- * @brief Handle alternation (|) in the pattern
- *
- * This is a low-level function used primarily for testing.
+ * @brief Check if the last pattern parsed used LibRift R'' syntax
  *
- * @param parser The parser
- * @return true if successful, false otherwise
+ * @param parser The parser instance
+ * @return true if it did, false otherwise
  */
-bool rift_regex_parser_handle_alternation(rift_regex_parser_t *parser);
+bool rift_regex_parser_is_rift_syntax(const rift_regex_parser_t *parser);
 
 /**
- * @brief Handle concatenation (sequence) in the pattern
- *
- * This is a low-level function used primarily for testing.
+ * @brief Set whether the -lrift flag is enabled
  *
- * @param parser The parser
+ * @param parser The parser instance
+ * @param enabled Whether the flag should be enabled
  * @return true if successful, false otherwise
  */
-bool rift_regex_parser_handle_concatenation(rift_regex_parser_t *parser);
+bool rift_regex_parser_set_rift_flag(rift_regex_parser_t *parser, bool enabled);
 
 /**
- * @brief Handle quantifier (*, +, ?, {m,n}) in the pattern
- *
- * This is a low-level function used primarily for testing.
+ * @brief Check if the -lrift flag is enabled
  *
- * @param parser The parser
- * @return true if successful, false otherwise
+ * @param parser The parser instance
+ * @return true if the flag is enabled, false otherwise
  */
-bool rift_regex_parser_handle_quantifier(rift_regex_parser_t *parser);
+bool rift_regex_parser_is_rift_flag_enabled(const rift_regex_parser_t *parser);
 
 /**
- * @brief Handle group ((...)) in the pattern
+ * @brief Check if a pattern string uses the R'' syntax format
  *
- * This is a low-level function used primarily for testing.
+ * @param pattern The pattern string to check
+ * @return true if the pattern uses R'' syntax, false otherwise
+ */
+bool rift_regex_is_rift_syntax(const char *pattern);
+
+/**
+ * @brief Set parser options
  *
- * @param parser The parser
+ * @param parser The parser instance
+ * @param flags Flags controlling parser behavior
  * @return true if successful, false otherwise
  */
-bool rift_regex_parser_handle_group(rift_regex_parser_t *parser);
+bool rift_regex_parser_set_flags(rift_regex_parser_t *parser, rift_regex_flags_t flags);
 
 /**
- * @brief Handle character class ([...]) in the pattern
+ * @brief Get the current parser flags
  *
- * This is a low-level function used primarily for testing.
- *
- * @param parser The parser
- * @return true if successful, false otherwise
+ * @param parser The parser instance
+ * @return The current flags
  */
-bool rift_regex_parser_handle_character_class(rift_regex_parser_t *parser);
+rift_regex_flags_t rift_regex_parser_get_flags(const rift_regex_parser_t *parser);
 
 #ifdef __cplusplus
 }
 #endif
 
-#endif /* LIBRIFT_REGEX_PARSER_PARSER_H */
\ No newline at end of file
+#endif /* LIBRIFT_REGEX_PARSER_PARSER_H */
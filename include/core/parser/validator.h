@@ -11,6 +11,7 @@
 
 #include <stdarg.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include "core/automaton/flags.h"
 #include "core/errors/regex_error.h"
 #include "core/parser/ast.h"
@@ -28,6 +29,25 @@ extern "C" {
  */
 #define RIFT_REGEX_VALIDATOR_MAX_ERROR_LENGTH 256
 
+/**
+ * @brief Most subtree summaries a validator keeps before it starts over
+ */
+#define RIFT_REGEX_VALIDATOR_CACHE_MAX_ENTRIES 65536
+
+/**
+ * @brief Summary of a subtree that passed validation, kept by content hash
+ *
+ * A subtree whose hash is found again, in the same AST or a later one, is
+ * valid without being walked as long as enough groups come before it for
+ * its backreferences and it fits under the recursion limit.
+ */
+typedef struct rift_regex_validator_cache_entry {
+    uint64_t key;           /**< Subtree hash mixed with the flags, 0 for a free slot */
+    size_t group_count;     /**< Capturing groups in the subtree */
+    size_t groups_required; /**< Groups that must come before it for its backreferences */
+    size_t height;          /**< Number of levels of the subtree */
+} rift_regex_validator_cache_entry_t;
+
 /**
  * @brief Validator opaque structure
  */
@@ -44,6 +64,9 @@ struct rift_regex_validator {
     size_t current_group_number;                       /**< Current group number being processed */
     size_t max_recursion_depth;                        /**< Maximum recursion depth allowed */
     size_t current_recursion_depth;                    /**< Current recursion depth */
+    rift_regex_validator_cache_entry_t *cache;         /**< Valid subtrees by content hash */
+    size_t cache_capacity;                             /**< Slots in the cache, a power of 2 */
+    size_t cache_count;                                /**< Slots in use */
 };
 /**
  * @brief Create a new validator
@@ -62,6 +85,10 @@ void rift_regex_validator_free(rift_regex_validator_t *validator);
 /**
  * @brief Validate an AST
  *
+ * Subtrees that passed an earlier validation by this validator are
+ * recognized by their content hash and not walked again, so re-validating
+ * a document after an edit only walks what changed.
+ *
  * @param validator The validator
  * @param ast The AST to validate
  * @return true if the AST is valid, false otherwise
@@ -80,6 +107,33 @@ bool rift_regex_validator_validate_with_options(rift_regex_validator_t *validato
                                                 const rift_regex_ast_t *ast,
                                                 rift_regex_flags_t flags);
 
+/**
+ * @brief Forward declaration for the flat AST type of core/parser/flat_ast.h
+ */
+typedef struct rift_regex_flat_ast rift_regex_flat_ast_t;
+
+/**
+ * @brief Validate a flat AST
+ *
+ * Runs the same checks as rift_regex_validator_validate_with_options in one
+ * linear pass over the node vector, without recursion.
+ *
+ * @param validator The validator
+ * @param flat The flat AST to validate
+ * @param flags Flags that affect validation
+ * @return true if the AST is valid, false otherwise
+ */
+bool rift_regex_validator_validate_flat(rift_regex_validator_t *validator,
+                                        const rift_regex_flat_ast_t *flat,
+                                        rift_regex_flags_t flags);
+
+/**
+ * @brief Forget the subtrees a validator has seen pass
+ *
+ * @param validator The validator
+ */
+void rift_regex_validator_clear_cache(rift_regex_validator_t *validator);
+
 /**
  * @brief Get the last error message
  *
@@ -13,6 +13,12 @@
 #ifndef LIBRIFT_CORE_REGEX_PATTERNS_BASELINE_PATTERNS_H
 #define LIBRIFT_CORE_REGEX_PATTERNS_BASELINE_PATTERNS_H
 
+#include <stdbool.h>
+#include "core/automaton/dfa_table.h"
+#include "core/engine/pattern.h"
+#include "core/errors/regex_error.h"
+#include "core/patterns/pattern_types.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -77,6 +83,66 @@ extern "C" {
  */
 #define RIFT_PATTERN_STATE_TRANSITION R"((?:->|→))"
 
+/**
+ * @brief Compile every baseline pattern ahead of its first use
+ *
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if initialization was successful, false otherwise
+ */
+bool rift_baseline_patterns_initialize(rift_regex_error_t *error);
+
+/**
+ * @brief Free the compiled baseline patterns
+ */
+void rift_baseline_patterns_cleanup(void);
+
+/**
+ * @brief Get a compiled baseline pattern, compiling it on its first request
+ *
+ * @param pattern_type The pattern type to retrieve
+ * @param error Pointer to store error information (can be NULL)
+ * @return The compiled pattern or NULL if not available
+ */
+rift_regex_pattern_t *rift_baseline_patterns_get(rift_baseline_pattern_type_t pattern_type,
+                                                 rift_regex_error_t *error);
+
+/**
+ * @brief Get the pattern string of a baseline pattern
+ *
+ * @param pattern_type The pattern type
+ * @return The RIFT_PATTERN_* string, or NULL for an unknown type
+ */
+const char *rift_baseline_patterns_get_source(rift_baseline_pattern_type_t pattern_type);
+
+/**
+ * @brief Compile a baseline pattern into a minimal DFA table
+ *
+ * This is what the build runs to generate the tables returned by
+ * rift_baseline_patterns_get_table().
+ *
+ * @param pattern_type The pattern type
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new table or NULL on failure
+ */
+rift_dfa_table_t *rift_baseline_patterns_compile_table(rift_baseline_pattern_type_t pattern_type,
+                                                       rift_regex_error_t *error);
+
+/**
+ * @brief Get the DFA table of a baseline pattern
+ *
+ * The tables are generated when librift is built and linked in as
+ * read-only data, so this costs nothing at startup and the tables are
+ * shared by every process using the library. A build configured without
+ * LIBRIFT_PRECOMPILE_BASELINE compiles a table on its first request instead.
+ * A table only answers whether input matches; capture groups need the
+ * pattern from rift_baseline_patterns_get().
+ *
+ * @param pattern_type The pattern type
+ * @return The table, owned by the library, or NULL if the pattern could not be
+ *         compiled into one
+ */
+const rift_dfa_table_t *rift_baseline_patterns_get_table(rift_baseline_pattern_type_t pattern_type);
+
 #ifdef __cplusplus
 }
 #endif
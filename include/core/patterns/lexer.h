@@ -0,0 +1,145 @@
+/**
+ * @file lexer.h
+ * @brief Longest-match tokenizer over an ordered list of token patterns
+ *
+ * A lexer compiles its rules into one DFA whose states know the rules they
+ * accept, and cuts input into tokens in a single pass the way flex does: at
+ * every position the longest match wins, and among rules matching the same
+ * length the one added first. Unlike matching an alternation of the rules,
+ * nothing is ever tried twice.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#ifndef LIBRIFT_CORE_REGEX_PATTERNS_LEXER_H
+#define LIBRIFT_CORE_REGEX_PATTERNS_LEXER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/automaton/flags.h"
+#include "core/errors/regex_error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Rule of a token no rule matched
+ */
+#define RIFT_LEXER_NO_RULE UINT32_MAX
+
+/**
+ * @brief A token: the rule that matched and the bytes it covers
+ */
+typedef struct rift_lexer_token {
+    uint32_t rule; /**< Index of the rule, RIFT_LEXER_NO_RULE for an unmatched byte */
+    size_t start;  /**< Offset of the first byte */
+    size_t end;    /**< Offset one past the last byte */
+} rift_lexer_token_t;
+
+/**
+ * @brief Forward declaration of the lexer structure
+ */
+typedef struct rift_lexer rift_lexer_t;
+
+/**
+ * @brief Create a lexer with no rules
+ *
+ * @return A new lexer or NULL on failure
+ */
+rift_lexer_t *rift_lexer_create(void);
+
+/**
+ * @brief Free a lexer
+ *
+ * @param lexer The lexer (can be NULL)
+ */
+void rift_lexer_free(rift_lexer_t *lexer);
+
+/**
+ * @brief Compile a pattern and add it as the lowest-priority rule
+ *
+ * A rule added after rift_lexer_compile() takes effect at the next compile.
+ *
+ * @param lexer The lexer
+ * @param pattern The pattern string
+ * @param flags Compilation flags
+ * @param rule Pointer to store the index of the rule (can be NULL)
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+bool rift_lexer_add_rule(rift_lexer_t *lexer, const char *pattern, rift_regex_flags_t flags,
+                         uint32_t *rule, rift_regex_error_t *error);
+
+/**
+ * @brief Get the number of rules of a lexer
+ *
+ * @param lexer The lexer
+ * @return Number of rules
+ */
+size_t rift_lexer_get_rule_count(const rift_lexer_t *lexer);
+
+/**
+ * @brief Bound the memory of a lexer's transition table
+ *
+ * The table is kept in the fastest layout of rift_dfa_layout_t that fits,
+ * so a lexer with many rules can trade some speed for a smaller table. The
+ * budget takes effect at the next compile.
+ *
+ * @param lexer The lexer
+ * @param max_bytes The budget in bytes, 0 for none (the dense table)
+ */
+void rift_lexer_set_memory_budget(rift_lexer_t *lexer, size_t max_bytes);
+
+/**
+ * @brief Build the DFA of a lexer's rules
+ *
+ * Fails with RIFT_REGEX_ERROR_LIMIT_EXCEEDED when no layout of the table
+ * fits the memory budget.
+ *
+ * @param lexer The lexer
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+bool rift_lexer_compile(rift_lexer_t *lexer, rift_regex_error_t *error);
+
+/**
+ * @brief Get the token starting at an offset
+ *
+ * The token is the longest non-empty match of any rule at the offset, the
+ * first rule winning a tie. Where no rule matches, the token is the single
+ * byte at the offset with rule RIFT_LEXER_NO_RULE. The lexer is only read,
+ * so any number of threads may tokenize with it at once.
+ *
+ * @param lexer The compiled lexer
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param offset Offset of the token
+ * @param token Pointer to store the token
+ * @return true if a token was stored, false at the end of the input or if
+ *         the lexer is not compiled
+ */
+bool rift_lexer_next(const rift_lexer_t *lexer, const char *input, size_t length, size_t offset,
+                     rift_lexer_token_t *token);
+
+/**
+ * @brief Cut the whole input into tokens
+ *
+ * @param lexer The compiled lexer
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param tokens Array for the tokens in input order (can be NULL)
+ * @param max_tokens Capacity of the tokens array
+ * @return Number of tokens in the input, which may exceed max_tokens, or 0
+ *         if the lexer is not compiled
+ */
+size_t rift_lexer_tokenize(const rift_lexer_t *lexer, const char *input, size_t length,
+                           rift_lexer_token_t *tokens, size_t max_tokens);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_CORE_REGEX_PATTERNS_LEXER_H */
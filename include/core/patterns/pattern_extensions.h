@@ -11,6 +11,7 @@
 
 #include "core/engine/pattern.h"
 #include "core/errors/regex_error.h"
+#include "core/patterns/lexer.h"
 #include "core/patterns/pattern_types.h"
 #ifndef LIBRIFT_CORE_REGEX_PATTERNS_PATTERN_EXTENSIONS_H
 #define LIBRIFT_CORE_REGEX_PATTERNS_PATTERN_EXTENSIONS_H
@@ -59,6 +60,24 @@ rift_regex_pattern_t *rift_pattern_sequence(const rift_baseline_pattern_type_t *
                                             size_t num_patterns, rift_regex_flags_t flags,
                                             rift_regex_error_t *error);
 
+/**
+ * @brief Create a lexer whose rules are baseline patterns
+ *
+ * Rule i of the lexer is pattern_types[i], so earlier types win tokens of
+ * equal length. Cutting input into tokens this way takes one pass over it,
+ * where trying a sequence or combination of the patterns at every offset
+ * takes one per pattern.
+ *
+ * @param pattern_types Array of pattern types, highest priority first
+ * @param num_patterns Number of patterns in the array
+ * @param flags Additional flags for every rule
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new compiled lexer, or NULL on failure
+ */
+rift_lexer_t *rift_pattern_lexer(const rift_baseline_pattern_type_t *pattern_types,
+                                 size_t num_patterns, rift_regex_flags_t flags,
+                                 rift_regex_error_t *error);
+
 /**
  * @brief Pattern fingerprint for performance analysis and optimization
  *
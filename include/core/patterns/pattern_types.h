@@ -32,6 +32,11 @@ typedef enum {
     RIFT_BASELINE_PATTERN_STATE_TRANSITION /**< State transition pattern */
 } rift_baseline_pattern_type_t;
 
+/**
+ * @brief Number of baseline pattern types
+ */
+#define RIFT_BASELINE_PATTERN_COUNT (RIFT_BASELINE_PATTERN_STATE_TRANSITION + 1)
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,200 @@
+/**
+ * @file backtrack_stack.h
+ * @brief Contiguous backtrack stack with an undo log for captures
+ *
+ * This file defines a backtracker that keeps its frames in one growable
+ * array instead of a linked list of separately allocated points. Capture
+ * slots live in the stack, and a write to a slot records the old value in an
+ * undo log only when a frame could still need it, so a push copies no
+ * captures and a pop rolls back just the slots changed since its frame.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#ifndef LIBRIFT_RUNTIME_BACKTRACK_STACK_H
+#define LIBRIFT_RUNTIME_BACKTRACK_STACK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct rift_regex_state;
+
+/* Value of a capture slot that has not been set */
+#define RIFT_BACKTRACK_SLOT_UNSET ((size_t)-1)
+
+/* Number of frames and undo entries allocated up front */
+#define RIFT_BACKTRACK_STACK_INITIAL_CAPACITY 64
+
+/**
+ * @brief One backtrack frame
+ */
+typedef struct rift_backtrack_frame {
+    struct rift_regex_state *state; /**< State to resume from */
+    size_t input_position;          /**< Input position to resume at */
+    size_t undo_mark;               /**< Undo log length when the frame was pushed */
+} rift_backtrack_frame_t;
+
+/**
+ * @brief One undo log entry, the value a capture slot had before a write
+ */
+typedef struct rift_backtrack_undo {
+    size_t slot;  /**< Index of the slot written */
+    size_t value; /**< Value of the slot before the write */
+} rift_backtrack_undo_t;
+
+/**
+ * @brief Contiguous backtrack stack
+ *
+ * Slot 2 * i is the start and slot 2 * i + 1 the end of group i.
+ */
+typedef struct rift_backtrack_stack {
+    rift_backtrack_frame_t *frames; /**< Frames, the top one last */
+    size_t frame_count;             /**< Number of frames on the stack */
+    size_t frame_capacity;          /**< Capacity of frames */
+    rift_backtrack_undo_t *undo;    /**< Undo log, the latest write last */
+    size_t undo_count;              /**< Number of undo entries */
+    size_t undo_capacity;           /**< Capacity of undo */
+    size_t *slots;                  /**< Current capture slots */
+    size_t num_groups;              /**< Number of capture groups */
+    size_t max_depth;               /**< Maximum number of frames */
+} rift_backtrack_stack_t;
+
+/**
+ * @brief Create a backtrack stack
+ *
+ * Every capture slot starts unset.
+ *
+ * @param max_depth Maximum number of frames
+ * @param num_groups Number of capture groups
+ * @return A new stack or NULL on failure
+ */
+rift_backtrack_stack_t *rift_backtrack_stack_create(size_t max_depth, size_t num_groups);
+
+/**
+ * @brief Free a backtrack stack
+ *
+ * @param stack The stack to free (can be NULL)
+ */
+void rift_backtrack_stack_free(rift_backtrack_stack_t *stack);
+
+/**
+ * @brief Drop every frame and undo entry and unset every capture slot
+ *
+ * The frame and undo arrays keep their capacity.
+ *
+ * @param stack The stack
+ */
+void rift_backtrack_stack_reset(rift_backtrack_stack_t *stack);
+
+/**
+ * @brief Push a frame
+ *
+ * Only the state, the position and the undo log length are stored. The
+ * arrays double when full, so pushes are amortized constant time.
+ *
+ * @param stack The stack
+ * @param state State to resume from
+ * @param input_position Input position to resume at
+ * @return true if pushed, false at the maximum depth or on allocation failure
+ */
+bool rift_backtrack_stack_push(rift_backtrack_stack_t *stack, struct rift_regex_state *state,
+                               size_t input_position);
+
+/**
+ * @brief Pop the top frame and roll the capture slots back to it
+ *
+ * Undo entries logged since the frame was pushed are replayed newest first,
+ * so the slots are as they were at the push.
+ *
+ * @param stack The stack
+ * @param state Receives the state to resume from
+ * @param input_position Receives the input position to resume at
+ * @return true if a frame was popped, false if the stack was empty
+ */
+bool rift_backtrack_stack_pop(rift_backtrack_stack_t *stack, struct rift_regex_state **state,
+                              size_t *input_position);
+
+/**
+ * @brief Write a capture slot
+ *
+ * The old value is logged only when a frame is on the stack and the slot
+ * actually changes; writes below every frame cannot be backtracked over.
+ *
+ * @param stack The stack
+ * @param slot Index of the slot, less than 2 * num_groups
+ * @param value New value of the slot
+ * @return true if written, false on an invalid slot or allocation failure
+ */
+bool rift_backtrack_stack_set_slot(rift_backtrack_stack_t *stack, size_t slot, size_t value);
+
+/**
+ * @brief Read a capture slot
+ *
+ * @param stack The stack
+ * @param slot Index of the slot
+ * @return The slot value, or RIFT_BACKTRACK_SLOT_UNSET for an invalid slot
+ */
+size_t rift_backtrack_stack_get_slot(const rift_backtrack_stack_t *stack, size_t slot);
+
+/**
+ * @brief Check whether the stack has no frames
+ *
+ * @param stack The stack
+ * @return true if empty or NULL
+ */
+bool rift_backtrack_stack_is_empty(const rift_backtrack_stack_t *stack);
+
+/**
+ * @brief Get the number of frames on the stack
+ *
+ * @param stack The stack
+ * @return The number of frames
+ */
+size_t rift_backtrack_stack_get_depth(const rift_backtrack_stack_t *stack);
+
+/**
+ * @brief Drop the frames above a depth without rolling anything back
+ *
+ * This is the cut of an atomic group or possessive quantifier: the frames
+ * taken since its entry depth are discarded while the capture slots keep
+ * their current values. The undo entries of the dropped frames stay in the
+ * log and now belong to the frame below, so popping that one still undoes
+ * every write made since it was pushed.
+ *
+ * @param stack The stack
+ * @param depth The depth to cut back to, at most the current depth
+ * @return true if cut, false on an invalid depth
+ */
+bool rift_backtrack_stack_cut(rift_backtrack_stack_t *stack, size_t depth);
+
+/**
+ * @brief Set the maximum number of frames
+ *
+ * @param stack The stack
+ * @param max_depth The new maximum
+ * @return true if successful, false otherwise
+ */
+bool rift_backtrack_stack_set_max_depth(rift_backtrack_stack_t *stack, size_t max_depth);
+
+/**
+ * @brief Copy a backtrack stack
+ *
+ * The copy has the same frames, undo log and capture slots, and arrays sized
+ * to what is in use.
+ *
+ * @param stack The stack to copy
+ * @return A new stack or NULL on failure
+ */
+rift_backtrack_stack_t *rift_backtrack_stack_clone(const rift_backtrack_stack_t *stack);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_RUNTIME_BACKTRACK_STACK_H */
@@ -2,6 +2,18 @@
  * @file backtracker.h
  * @brief Header file for the backtracker component of the LibRift regex engine
  *
+ * This file defines the single backtracker every other variant builds on. It
+ * keeps the snapshot API of backtrack points (state, position and a copy of
+ * the capture groups) but stores them on the contiguous backtrack stack: a
+ * push only logs the groups that differ from the ones below it, and a pop
+ * rolls them back from the undo log. Safety features are layered on top as
+ * policies instead of separate implementations:
+ *
+ * - the depth limit is enforced by the stack itself,
+ * - a bailout hook set at run time is told when a push hits the limit,
+ *   unless RIFT_BACKTRACKER_BAILOUT_HOOKS is defined to 0,
+ * - thread-local instances are provided by safe_backtracker.h.
+ *
  * @copyright Copyright (c) 2025 LibRift Project
  * @license MIT License
  */
@@ -12,12 +24,215 @@
 #ifndef LIBRIFT_RUNTIME_BACKTRACKER_H
 #define LIBRIFT_RUNTIME_BACKTRACKER_H
 
+#include "core/automaton/state.h"
+#include "core/runtime/backtrack_stack.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-/* Declarations for backtracker */
+/**
+ * @brief Whether bailout hooks are compiled in
+ *
+ * Define to 0 to drop the hook call from the push path entirely.
+ */
+#ifndef RIFT_BACKTRACKER_BAILOUT_HOOKS
+#define RIFT_BACKTRACKER_BAILOUT_HOOKS 1
+#endif
+
+typedef struct rift_regex_backtracker rift_regex_backtracker_t;
+
+/**
+ * @brief Hook called when a push is refused at the maximum depth
+ *
+ * @param backtracker The backtracker that refused the push
+ * @param depth Its depth at the time
+ * @param user_data The policy's user data
+ */
+typedef void (*rift_backtracker_bailout_fn)(const rift_regex_backtracker_t *backtracker,
+                                           size_t depth, void *user_data);
+
+/**
+ * @brief Run-time policy of a backtracker
+ */
+typedef struct rift_backtracker_policy {
+    size_t max_depth;                     /**< Maximum number of backtrack points */
+    rift_backtracker_bailout_fn bailout;  /**< Called when the limit is hit (can be NULL) */
+    void *user_data;                      /**< Passed to the bailout hook */
+} rift_backtracker_policy_t;
+
+/**
+ * @brief Backtracker
+ *
+ * The stack carries one capture slot pair per group plus one extra slot
+ * holding the number of groups given to the latest push, so that it rolls
+ * back with the groups.
+ */
+struct rift_regex_backtracker {
+    rift_backtrack_stack_t *stack;    /**< Frames, undo log and capture slots */
+    size_t num_groups;                /**< Number of capture groups */
+    rift_backtracker_policy_t policy; /**< Depth limit and bailout hook */
+};
+
+/**
+ * @brief Create a new backtracker
+ *
+ * @param max_depth Maximum depth for backtracking
+ * @param num_groups Number of capturing groups
+ * @return A new backtracker or NULL on failure
+ */
+rift_regex_backtracker_t *rift_backtracker_create(size_t max_depth, size_t num_groups);
+
+/**
+ * @brief Create a new backtracker with a policy
+ *
+ * @param policy The policy, copied into the backtracker
+ * @param num_groups Number of capturing groups
+ * @return A new backtracker or NULL on failure
+ */
+rift_regex_backtracker_t *
+rift_backtracker_create_with_policy(const rift_backtracker_policy_t *policy, size_t num_groups);
+
+/**
+ * @brief Initialize a policy with a depth limit and no hook
+ *
+ * @param policy The policy
+ * @param max_depth Maximum depth for backtracking
+ */
+void rift_backtracker_policy_init(rift_backtracker_policy_t *policy, size_t max_depth);
+
+/**
+ * @brief Replace the policy of a backtracker
+ *
+ * @param backtracker The backtracker
+ * @param policy The new policy
+ * @return true if successful, false otherwise
+ */
+bool rift_backtracker_set_policy(rift_regex_backtracker_t *backtracker,
+                                 const rift_backtracker_policy_t *policy);
+
+/**
+ * @brief Push a new backtrack point onto the stack
+ *
+ * Only the groups that differ from the current ones are logged.
+ *
+ * @param backtracker The backtracker
+ * @param state The current state
+ * @param input_position Position in the input string
+ * @param group_starts Array of group start positions (can be NULL if num_groups is 0)
+ * @param group_ends Array of group end positions (can be NULL if num_groups is 0)
+ * @param num_groups Number of groups, at most the backtracker's
+ * @return true if the point was pushed successfully, false otherwise
+ */
+bool rift_backtracker_push(rift_regex_backtracker_t *backtracker, rift_regex_state_t *state,
+                           size_t input_position, const size_t *group_starts,
+                           const size_t *group_ends, size_t num_groups);
+
+/**
+ * @brief Pop a backtrack point from the stack
+ *
+ * @param backtracker The backtracker
+ * @param state Pointer to store the state
+ * @param input_position Pointer to store the input position
+ * @param group_starts Array to store group start positions (can be NULL)
+ * @param group_ends Array to store group end positions (can be NULL)
+ * @param num_groups Pointer to store the number of groups given to the push
+ * @return true if a point was popped, false if the stack was empty
+ */
+bool rift_backtracker_pop(rift_regex_backtracker_t *backtracker, rift_regex_state_t **state,
+                          size_t *input_position, size_t *group_starts, size_t *group_ends,
+                          size_t *num_groups);
+
+/**
+ * @brief Peek at the top backtrack point without removing it
+ *
+ * @param backtracker The backtracker
+ * @param state Pointer to store the state
+ * @param input_position Pointer to store the input position
+ * @param group_starts Array to store group start positions (can be NULL)
+ * @param group_ends Array to store group end positions (can be NULL)
+ * @param num_groups Pointer to store the number of groups given to the push
+ * @return true if a point was peeked, false if the stack was empty
+ */
+bool rift_backtracker_peek(const rift_regex_backtracker_t *backtracker, rift_regex_state_t **state,
+                           size_t *input_position, size_t *group_starts, size_t *group_ends,
+                           size_t *num_groups);
+
+/**
+ * @brief Discard the backtrack points pushed above a depth
+ *
+ * Commits an atomic group or possessive quantifier entered at that depth:
+ * none of the points taken inside it are retried, and the points below it
+ * still restore their own groups.
+ *
+ * @param backtracker The backtracker
+ * @param depth The depth at the entry, as returned by rift_backtracker_get_depth
+ * @return true if cut, false on an invalid depth
+ */
+bool rift_backtracker_cut(rift_regex_backtracker_t *backtracker, size_t depth);
+
+/**
+ * @brief Check if the backtracker stack is empty
+ *
+ * @param backtracker The backtracker
+ * @return true if the stack is empty, false otherwise
+ */
+bool rift_backtracker_is_empty(const rift_regex_backtracker_t *backtracker);
+
+/**
+ * @brief Reset the backtracker
+ *
+ * @param backtracker The backtracker to reset
+ */
+void rift_backtracker_reset(rift_regex_backtracker_t *backtracker);
+
+/**
+ * @brief Get the current depth of the backtracker stack
+ *
+ * @param backtracker The backtracker
+ * @return The current depth
+ */
+size_t rift_backtracker_get_depth(const rift_regex_backtracker_t *backtracker);
+
+/**
+ * @brief Get the maximum depth allowed for the backtracker
+ *
+ * @param backtracker The backtracker
+ * @return The maximum allowed depth
+ */
+size_t rift_backtracker_get_max_depth(const rift_regex_backtracker_t *backtracker);
+
+/**
+ * @brief Set the maximum depth for the backtracker
+ *
+ * @param backtracker The backtracker
+ * @param max_depth The new maximum depth
+ * @return true if successful, false otherwise
+ */
+bool rift_backtracker_set_max_depth(rift_regex_backtracker_t *backtracker, size_t max_depth);
+
+/**
+ * @brief Get the number of capture groups of a backtracker
+ *
+ * @param backtracker The backtracker
+ * @return The number of groups, or 0 for NULL
+ */
+size_t rift_backtracker_get_num_groups(const rift_regex_backtracker_t *backtracker);
+
+/**
+ * @brief Clone a backtracker
+ *
+ * @param backtracker The backtracker to clone
+ * @return A new backtracker that is a copy of the original, or NULL on failure
+ */
+rift_regex_backtracker_t *rift_backtracker_clone(const rift_regex_backtracker_t *backtracker);
+
+/**
+ * @brief Free resources associated with a backtracker
+ *
+ * @param backtracker The backtracker to free
+ */
+void rift_backtracker_free(rift_regex_backtracker_t *backtracker);
 
 #ifdef __cplusplus
 }
@@ -1,26 +0,0 @@
-/**
- * @file backtracker_safe_backtracker.h
- * @brief Header file for the backtracker_safe_backtracker component of the LibRift regex engine
- *
- * @copyright Copyright (c) 2025 LibRift Project
- * @license MIT License
- */
-
-#include <stdbool.h>
-#include <stddef.h>
-#include <stdint.h>
-#ifndef LIBRIFT_RUNTIME_BACKTRACKER_SAFE_BACKTRACKER_H
-#define LIBRIFT_RUNTIME_BACKTRACKER_SAFE_BACKTRACKER_H
-
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-/* Declarations for backtracker_safe_backtracker */
-
-#ifdef __cplusplus
-}
-#endif
-
-#endif /* LIBRIFT_RUNTIME_BACKTRACKER_SAFE_BACKTRACKER_H */
@@ -9,6 +9,7 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include "core/runtime/match_types.h"
 #ifndef LIBRIFT_RUNTIME_CONTEXT_H
 #define LIBRIFT_RUNTIME_CONTEXT_H
 
@@ -19,6 +20,29 @@ extern "C" {
 
 /* Declarations for context */
 
+/**
+ * @brief Forward declaration of the matcher context structure
+ */
+typedef struct rift_regex_matcher_context rift_regex_matcher_context_t;
+
+/**
+ * @brief Fill caller-provided spans from the current context state
+ *
+ * Unlike rift_matcher_context_create_match_result, this copies no text and
+ * allocates nothing. spans[0] receives the full match and spans[1 + i] the
+ * span of capture group i.
+ *
+ * @param context The matcher context
+ * @param start_pos Start position of the match
+ * @param end_pos End position of the match
+ * @param spans Array to store the spans
+ * @param max_spans Number of entries in spans
+ * @return Number of spans the match has, which may exceed max_spans, or 0 on failure
+ */
+size_t rift_matcher_context_get_spans(const rift_regex_matcher_context_t *context,
+                                      size_t start_pos, size_t end_pos, rift_regex_span_t *spans,
+                                      size_t max_spans);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,140 @@
+/**
+ * @file decompress_stream.h
+ * @brief Pipelined decompression of compressed inputs for the streaming matcher
+ *
+ * A decompression stream reads a gzip, zstd or uncompressed file on a
+ * thread of its own, decompressing it into two chunk buffers in turn: while
+ * the caller scans one chunk, the next one is being decompressed into the
+ * other, so decompression and matching overlap and the memory used stays
+ * two chunks whatever the size of the file. The format is told from the
+ * magic bytes at the start of the file; concatenated gzip members and zstd
+ * frames are read as one input, as gzip -d and zstd -d do.
+ *
+ * gzip needs zlib and zstd needs libzstd at build time (LIBRIFT_HAVE_ZLIB
+ * and LIBRIFT_HAVE_ZSTD); files in a format the build lacks are refused.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "core/errors/regex_error.h"
+#include "core/runtime/matcher.h"
+#ifndef LIBRIFT_RUNTIME_DECOMPRESS_STREAM_H
+#define LIBRIFT_RUNTIME_DECOMPRESS_STREAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Size of the chunks a stream decompresses into, unless given
+ */
+#define RIFT_DECOMPRESS_CHUNK_SIZE (1024 * 1024)
+
+/**
+ * @brief Formats a stream can read
+ */
+typedef enum rift_compression {
+    RIFT_COMPRESSION_NONE, /**< Uncompressed, read as is */
+    RIFT_COMPRESSION_GZIP, /**< gzip */
+    RIFT_COMPRESSION_ZSTD  /**< Zstandard */
+} rift_compression_t;
+
+/**
+ * @brief Decompression stream, opaque
+ */
+typedef struct rift_decompress_stream rift_decompress_stream_t;
+
+/**
+ * @brief Tell the format of an input from its first bytes
+ *
+ * @param data The first bytes of the input
+ * @param size Number of bytes available, at least 4 to recognize zstd
+ * @return The format, RIFT_COMPRESSION_NONE if no magic matches
+ */
+rift_compression_t rift_compression_detect(const void *data, size_t size);
+
+/**
+ * @brief Check whether the build can decompress a format
+ *
+ * @param compression The format
+ * @return true if supported
+ */
+bool rift_compression_supported(rift_compression_t compression);
+
+/**
+ * @brief Open a file and start decompressing it
+ *
+ * @param path Path of the file
+ * @param chunk_size Size of each of the two chunk buffers, 0 for RIFT_DECOMPRESS_CHUNK_SIZE
+ * @param error Pointer to store error code (can be NULL)
+ * @return A new stream or NULL if the file cannot be read, is in an
+ *         unsupported format, or memory runs out
+ */
+rift_decompress_stream_t *rift_decompress_stream_open(const char *path, size_t chunk_size,
+                                                      rift_regex_error_t *error);
+
+/**
+ * @brief Get the format of a stream
+ *
+ * @param stream The stream
+ * @return Its format
+ */
+rift_compression_t rift_decompress_stream_get_compression(const rift_decompress_stream_t *stream);
+
+/**
+ * @brief Take the next decompressed chunk
+ *
+ * The chunk stays valid until the next call, which hands its buffer back to
+ * the decompressing thread. Chunks are cut wherever a buffer fills up, not
+ * at line or character boundaries.
+ *
+ * @param stream The stream
+ * @param data Pointer to store the chunk
+ * @param length Pointer to store its length, never 0 when true is returned
+ * @return true if a chunk was taken, false at the end of the input or on an error
+ */
+bool rift_decompress_stream_next(rift_decompress_stream_t *stream, const char **data,
+                                 size_t *length);
+
+/**
+ * @brief Check whether a stream stopped on an error
+ *
+ * Read or corruption errors end the stream early; check this once
+ * rift_decompress_stream_next() returns false.
+ *
+ * @param stream The stream
+ * @return true if the input could not be read or decompressed to its end
+ */
+bool rift_decompress_stream_failed(const rift_decompress_stream_t *stream);
+
+/**
+ * @brief Feed a whole stream to a matcher
+ *
+ * Every chunk goes through rift_matcher_feed(), so matches are reported to
+ * the matcher's stream callback as they are found, with offsets into the
+ * decompressed input, while the next chunk is being decompressed.
+ *
+ * @param stream The stream, read to its end
+ * @param matcher The matcher, with a stream callback set
+ * @return true if the whole input was fed, false on an error of either
+ */
+bool rift_decompress_stream_feed(rift_decompress_stream_t *stream, rift_regex_matcher_t *matcher);
+
+/**
+ * @brief Stop a stream and free it
+ *
+ * The decompressing thread is stopped even if the input was not read to
+ * its end.
+ *
+ * @param stream The stream
+ */
+void rift_decompress_stream_close(rift_decompress_stream_t *stream);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_RUNTIME_DECOMPRESS_STREAM_H */
@@ -1,6 +1,13 @@
 /**
  * @file execution_tracker.h
- * @brief Header file for the execution_tracker component of the LibRift regex engine
+ * @brief Per-match telemetry of the LibRift regex engine
+ *
+ * Alongside the execution time tracker, which only bounds elapsed time, the
+ * matchers can record what a search cost: the steps it ran, the backtrack
+ * points it pushed and popped, how deep its backtrack stack grew, the
+ * epsilon closures it expanded, the positions its prefilter skipped and the
+ * engine that ran it. Recording is off by default, and a matcher that does
+ * not record tests one flag per counted event.
  *
  * @copyright Copyright (c) 2025 LibRift Project
  * @license MIT License
@@ -17,7 +24,71 @@
 extern "C" {
 #endif
 
-/* Declarations for execution_tracker */
+/**
+ * @brief Engine that ran a match attempt
+ */
+typedef enum rift_match_engine {
+    RIFT_MATCH_ENGINE_NONE = 0,     /**< No attempt was made */
+    RIFT_MATCH_ENGINE_LAZY_DFA,     /**< Lazy DFA, for capture-free patterns */
+    RIFT_MATCH_ENGINE_PIKE_VM,      /**< Pike VM over the NFA */
+    RIFT_MATCH_ENGINE_BACKTRACKER,  /**< Backtracking over the automaton */
+    RIFT_MATCH_ENGINE_BYTECODE_VM,  /**< Backtracking bytecode VM */
+    RIFT_MATCH_ENGINE_ONE_PASS,     /**< One-pass DFA, for unambiguous patterns */
+    RIFT_MATCH_ENGINE_TDFA,         /**< Tagged DFA, for patterns with captures */
+    RIFT_MATCH_ENGINE_BIT_PARALLEL, /**< Bit-parallel NFA, for short capture-free patterns */
+    RIFT_MATCH_ENGINE_COUNT         /**< Number of engines */
+} rift_match_engine_t;
+
+/**
+ * @brief Counters recorded for one search, or summed over several
+ *
+ * Steps are characters consumed by the backtracker and instructions run by
+ * the bytecode VM. The lazy DFA and Pike VM do not report their scans, so
+ * they are charged the bytes up to the match end, or up to the input end
+ * when nothing matched, which bounds what they read. Budget fallbacks are
+ * attempts that ran on the Pike VM because the matcher's memory budget could
+ * not hold a lazy DFA state cache.
+ */
+typedef struct rift_match_stats {
+    uint64_t searches;                                 /**< Searches recorded */
+    uint64_t attempts;                                 /**< Attempts, one per start position */
+    uint64_t engine_attempts[RIFT_MATCH_ENGINE_COUNT]; /**< Attempts run by each engine */
+    rift_match_engine_t engine;                        /**< Engine of the latest attempt */
+    uint64_t steps;                                    /**< Steps run, see above */
+    uint64_t backtrack_pushes;                         /**< Backtrack points pushed */
+    uint64_t backtrack_pops;                           /**< Backtrack points resumed */
+    uint64_t max_stack_depth;                          /**< Deepest stack, in frames */
+    uint64_t epsilon_expansions;                       /**< States of expanded closures */
+    uint64_t prefilter_skips;                          /**< Starts the prefilter ruled out */
+    uint64_t budget_fallbacks;                         /**< Attempts a memory budget moved */
+    uint64_t engine_switches;                          /**< Backtracker attempts moved mid-search */
+} rift_match_stats_t;
+
+/**
+ * @brief Clear a set of counters
+ *
+ * @param stats The counters
+ */
+void rift_match_stats_reset(rift_match_stats_t *stats);
+
+/**
+ * @brief Add one set of counters to another
+ *
+ * Counts are summed and the stack depth is the deeper of the two. The
+ * engine is taken from the source when it made an attempt.
+ *
+ * @param total The counters to add to
+ * @param stats The counters to add
+ */
+void rift_match_stats_merge(rift_match_stats_t *total, const rift_match_stats_t *stats);
+
+/**
+ * @brief Get the name of an engine
+ *
+ * @param engine The engine
+ * @return A static string, "unknown" for values out of range
+ */
+const char *rift_match_engine_name(rift_match_engine_t engine);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,123 @@
+/**
+ * @file file_reader.h
+ * @brief Bulk reading of many small files ahead of the threads scanning them
+ *
+ * A file reader takes a list of paths and reads the files into a pool of
+ * buffers on a thread of its own, many at a time, while the calling threads
+ * take the files already read and scan them. On Linux the opens, reads and
+ * closes go through io_uring, queue_depth of them in flight at once, reading
+ * into buffers registered with the ring; elsewhere, or where io_uring is
+ * unavailable or disabled, the thread reads the files one after the other
+ * with open and pread, still ahead of the scanning threads.
+ *
+ * Files that do not fit a buffer are not read whole: they come back with
+ * their first buffer_size bytes and complete set to false, for the caller
+ * to map them instead.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "core/errors/regex_error.h"
+#ifndef LIBRIFT_RUNTIME_FILE_READER_H
+#define LIBRIFT_RUNTIME_FILE_READER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Files read at once, and buffers in the pool, unless configured
+ */
+#define RIFT_FILE_READER_QUEUE_DEPTH 64
+
+/**
+ * @brief Size of each buffer of the pool, unless configured
+ */
+#define RIFT_FILE_READER_BUFFER_SIZE (128 * 1024)
+
+/**
+ * @brief Configuration of a file reader
+ */
+typedef struct rift_file_reader_config {
+    size_t queue_depth; /**< Files read at once, 0 for RIFT_FILE_READER_QUEUE_DEPTH */
+    size_t buffer_size; /**< Size of each buffer, 0 for RIFT_FILE_READER_BUFFER_SIZE */
+    bool no_io_uring;   /**< Whether to read with pread even where io_uring is available */
+} rift_file_reader_config_t;
+
+/**
+ * @brief A file read by a reader
+ */
+typedef struct rift_file_read {
+    size_t index;     /**< Index of the file in the paths given */
+    const char *path; /**< Its path */
+    const char *data; /**< Its contents, NULL if it could not be read */
+    size_t size;      /**< Bytes in data */
+    bool complete;    /**< Whether data holds the whole file */
+    int error;        /**< errno of the open or read that failed, 0 if none did */
+    size_t buffer;    /**< Buffer of the pool holding data, for the reader */
+} rift_file_read_t;
+
+/**
+ * @brief File reader, opaque
+ */
+typedef struct rift_file_reader rift_file_reader_t;
+
+/**
+ * @brief Create a file reader and start reading
+ *
+ * @param paths Paths of the files, kept by reference until the reader is freed
+ * @param num_paths Number of paths
+ * @param config Configuration (can be NULL for the defaults)
+ * @param error Pointer to store error code (can be NULL)
+ * @return A new reader or NULL if memory runs out or the thread cannot start
+ */
+rift_file_reader_t *rift_file_reader_create(const char *const *paths, size_t num_paths,
+                                            const rift_file_reader_config_t *config,
+                                            rift_regex_error_t *error);
+
+/**
+ * @brief Take the next file read, waiting for one if none is ready yet
+ *
+ * Files come back in the order their reads complete, not in the order of
+ * the paths. Any number of threads can take files at once; each hands the
+ * buffer back with rift_file_reader_release() once done with it.
+ *
+ * @param reader The reader
+ * @param file Pointer to store the file
+ * @return true if a file was taken, false once every file has been
+ */
+bool rift_file_reader_next(rift_file_reader_t *reader, rift_file_read_t *file);
+
+/**
+ * @brief Hand the buffer of a file back for the next reads
+ *
+ * @param reader The reader
+ * @param file The file, whose data is invalid from now on
+ */
+void rift_file_reader_release(rift_file_reader_t *reader, rift_file_read_t *file);
+
+/**
+ * @brief Check whether a reader reads through io_uring
+ *
+ * @param reader The reader
+ * @return true if io_uring is used, false if files are read with pread
+ */
+bool rift_file_reader_uses_io_uring(const rift_file_reader_t *reader);
+
+/**
+ * @brief Stop a reader and free it
+ *
+ * Reads in flight are waited for; files not read yet are skipped.
+ *
+ * @param reader The reader
+ */
+void rift_file_reader_free(rift_file_reader_t *reader);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_RUNTIME_FILE_READER_H */
@@ -20,6 +20,22 @@ extern "C" {
  */
 struct rift_regex_capture_group;
 
+/**
+ * @brief Span position of a group that did not participate in a match
+ */
+#define RIFT_REGEX_SPAN_UNSET ((size_t)-1)
+
+/**
+ * @brief Byte range of a match or capture group in the input
+ *
+ * Spans refer into the input and own no memory. Both positions are
+ * RIFT_REGEX_SPAN_UNSET for a group that did not participate in the match.
+ */
+typedef struct rift_regex_span {
+    size_t start; /**< Position of the first byte */
+    size_t end;   /**< Position one past the last byte */
+} rift_regex_span_t;
+
 /**
  * @brief Match result structure
  */
@@ -10,6 +10,7 @@
  */
 
 #include <regex.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -18,7 +19,14 @@
 #include <time.h>
 #include "core/automaton/automaton.h"
 #include "core/automaton/flags.h"
+#include "core/config/backtracker_limit_registry.h"
+#include "core/config/config.h"
 #include "core/errors/regex_error.h"
+#include "core/memory/memory.h"
+#include "core/runtime/context.h"
+#include "core/runtime/execution_tracker.h"
+#include "core/runtime/match_types.h"
+#include "core/runtime/replacement.h"
 #ifndef LIBRIFT_REGEX_ENGINE_MATCHER_H
 #define LIBRIFT_REGEX_ENGINE_MATCHER_H
 
@@ -27,17 +35,154 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Options controlling how a matcher executes a pattern
+ */
+typedef enum rift_matcher_option {
+    RIFT_MATCHER_OPTION_NONE = 0x00000000,         /**< Greedy, unanchored matching */
+    RIFT_MATCHER_OPTION_ANCHOR_START = 0x00000001, /**< Only match at the current position */
+    RIFT_MATCHER_OPTION_LAZY = 0x00000002,         /**< Stop at the shortest match */
+    RIFT_MATCHER_OPTION_LAZY_DFA = 0x00000004,     /**< Always use the lazy DFA when possible */
+    RIFT_MATCHER_OPTION_PIKE_VM = 0x00000008,      /**< Use the Pike VM, never the lazy DFA */
+    RIFT_MATCHER_OPTION_BACKTRACK = 0x00000010     /**< Always use the backtracking matcher */
+} rift_matcher_option_t;
+
+/**
+ * @brief Outcome of a budgeted search step
+ */
+typedef enum rift_match_status {
+    RIFT_MATCH_NOT_FOUND = 0, /**< The search ended without a match */
+    RIFT_MATCH_FOUND = 1,     /**< The search found a match */
+    RIFT_MATCH_PENDING = 2    /**< The steps ran out; call again to resume the search */
+} rift_match_status_t;
+
+/* Number of check_timeout calls between reads of the clock and the cancel flag */
+#define RIFT_MATCHER_TIMEOUT_CHECK_INTERVAL 1024
+
+/* Deadline meaning no deadline */
+#define RIFT_MATCHER_NO_DEADLINE UINT64_MAX
+
+/* Backtracker steps per remaining input byte after which an attempt moves to the Pike VM */
+#define RIFT_MATCHER_SWITCH_STEPS_PER_BYTE 64
+
+/*
+ * Engines built into the matcher, 1 to build an engine in and 0 to leave it
+ * out. Size-optimized builds, such as the minimal Wasm module, leave out the
+ * engines they do not need. Patterns no remaining engine can run never match:
+ * without the backtracker, patterns with backreferences; without the lazy
+ * DFA, streamed patterns.
+ */
+#ifndef RIFT_MATCHER_ENGINE_LAZY_DFA
+#define RIFT_MATCHER_ENGINE_LAZY_DFA 1
+#endif
+#ifndef RIFT_MATCHER_ENGINE_BIT_PARALLEL
+#define RIFT_MATCHER_ENGINE_BIT_PARALLEL 1
+#endif
+#ifndef RIFT_MATCHER_ENGINE_ONE_PASS
+#define RIFT_MATCHER_ENGINE_ONE_PASS 1
+#endif
+#ifndef RIFT_MATCHER_ENGINE_TDFA
+#define RIFT_MATCHER_ENGINE_TDFA 1
+#endif
+#ifndef RIFT_MATCHER_ENGINE_PIKE_VM
+#define RIFT_MATCHER_ENGINE_PIKE_VM 1
+#endif
+#ifndef RIFT_MATCHER_ENGINE_BACKTRACKER
+#define RIFT_MATCHER_ENGINE_BACKTRACKER 1
+#endif
+
+/**
+ * @brief Callback receiving the spans of one match
+ *
+ * spans[0] is the full match, followed by the capture groups when available.
+ *
+ * @param spans The spans of the match
+ * @param num_spans Number of spans
+ * @param user_data User data given with the callback
+ * @return true to continue matching, false to stop
+ */
+typedef bool (*rift_matcher_match_callback_t)(const rift_regex_span_t *spans, size_t num_spans,
+                                              void *user_data);
+
+/**
+ * @brief Callback receiving the spans of one match in line mode
+ *
+ * spans[0] is the full match, followed by the capture groups when
+ * available, all as offsets into the line.
+ *
+ * @param line_number Number of the line, counting from 1
+ * @param line Span of the line in the input, without its newline
+ * @param spans The spans of the match
+ * @param num_spans Number of spans
+ * @param user_data User data given with the callback
+ * @return true to continue matching, false to stop
+ */
+typedef bool (*rift_matcher_line_callback_t)(size_t line_number, const rift_regex_span_t *line,
+                                             const rift_regex_span_t *spans, size_t num_spans,
+                                             void *user_data);
+
 /* Implementation details */
 struct rift_regex_matcher {
-    const char *pattern;                        /**< Regex pattern */
-    size_t pattern_length;                      /**< Length of the regex pattern */
-    rift_matcher_option_t options;              /**< Matcher options */
-    rift_regex_matcher_context_t *context;      /**< Matcher context */
-    struct rift_regex_backtracker *backtracker; /**< Backtracker for backtracking state */
-    uint32_t flags;                             /**< Flags for regex matching */
-    bool timed_out;                             /**< Whether the matcher has timed out */
-    clock_t start_time;                         /**< Start time for timeout tracking */
-    uint32_t timeout_ms;                        /**< Timeout in milliseconds */
+    const char *pattern;                           /**< Regex pattern */
+    size_t pattern_length;                         /**< Length of the regex pattern */
+    rift_matcher_option_t options;                 /**< Matcher options */
+    rift_regex_matcher_context_t *context;         /**< Matcher context */
+    struct rift_backtrack_stack *backtrack_stack;  /**< Frames and captures of the backtracking path */
+    struct rift_lazy_dfa *lazy_dfa;                /**< Lazy DFA, built on first use */
+    struct rift_lazy_dfa *forward_dfa;             /**< Unanchored lazy DFA finding match ends */
+    struct rift_lazy_dfa *reverse_dfa;             /**< Reversed pattern's DFA finding starts */
+    bool reverse_search_ready;                     /**< Whether the two DFAs above were tried */
+    struct rift_bit_parallel *bit_parallel;        /**< Bit-parallel NFA, NULL if too long */
+    bool bit_parallel_ready;                       /**< Whether the bit-parallel NFA was tried */
+    struct rift_one_pass *one_pass;                /**< One-pass DFA, NULL if not one-pass */
+    size_t *one_pass_slots;                        /**< Capture slots filled by the one-pass DFA */
+    bool one_pass_ready;                           /**< Whether the one-pass DFA was tried */
+    struct rift_tdfa *tdfa;                        /**< Tagged DFA, NULL if too large */
+    size_t *tdfa_slots;                            /**< Capture slots filled by the tagged DFA */
+    bool tdfa_ready;                               /**< Whether the tagged DFA was tried */
+    struct rift_pike_vm *pike_vm;                  /**< Pike VM, built on first use */
+    size_t *pike_slots;                            /**< Capture slots filled by the Pike VM */
+    struct rift_prefilter *prefilter;              /**< Literal prefilter, NULL if it cannot help */
+    bool prefilter_ready;                          /**< Whether the prefilter has been built */
+    size_t last_match_start;                       /**< Start of the most recent match */
+    size_t last_match_end;                         /**< End of the most recent match */
+    rift_matcher_match_callback_t stream_callback; /**< Receiver of streamed matches */
+    void *stream_user_data;                        /**< User data for stream_callback */
+    char *stream_buffer;                           /**< Fed bytes a match may still start in */
+    size_t stream_length;                          /**< Number of bytes in stream_buffer */
+    size_t stream_capacity;                        /**< Capacity of stream_buffer */
+    size_t stream_offset;                          /**< Absolute offset of stream_buffer[0] */
+    int stream_before;                             /**< Byte before stream_buffer[0], or -1 */
+    bool stream_stopped;                           /**< Whether the callback ended the stream */
+    uint32_t flags;                                /**< Flags for regex matching */
+    rift_regex_config_t config;                    /**< Regex settings of the pattern */
+    bool timed_out;                                /**< Whether the matcher has timed out */
+    uint32_t timeout_ms;                           /**< Timeout in milliseconds */
+    uint64_t request_deadline_ns;                  /**< Deadline set by the caller, monotonic */
+    uint64_t deadline_ns;                          /**< Deadline of the running match, monotonic */
+    uint32_t timeout_countdown;                    /**< check_timeout calls until the next read */
+    const atomic_bool *cancel_flag;                /**< Set by another thread to cancel, or NULL */
+    const rift_backtrack_limit_registry_t *limit_registry; /**< Source of the limits, or NULL */
+    uint32_t limit_pattern_id;                     /**< Pattern identifier in limit_registry */
+    uint32_t limit_match_id;                       /**< Match identifier in limit_registry */
+    rift_backtrack_limits_t limits;                /**< Limits resolved from limit_registry */
+    uint64_t step_count;                           /**< Steps run by the engines, never reset */
+    uint64_t step_limit;                           /**< step_count to yield at, 0 for none */
+    bool step_pending;                             /**< Whether a stepped search was yielded */
+    uint32_t switch_steps_per_byte;                /**< Engine switch threshold, 0 for never */
+    bool stats_enabled;                            /**< Whether searches record telemetry */
+    rift_match_stats_t stats;                      /**< Telemetry of the latest search */
+    rift_match_stats_t stats_total;                /**< Telemetry summed over all searches */
+    struct rift_trace_buffer *trace;               /**< Buffer recording searches, or NULL */
+    struct rift_metrics *metrics;                  /**< Registry searches are counted in, or NULL */
+    uint32_t metrics_pattern_id;                   /**< Pattern identifier in metrics */
+    uint64_t metrics_start_ns;                     /**< Start of the running search, if counted */
+    rift_match_engine_t last_engine;               /**< Engine of the latest attempt */
+    const rift_allocator_t *allocator;             /**< Allocator of the engines, or NULL */
+    size_t memory_budget;                          /**< Bytes set by the caller, 0 for none */
+    size_t applied_budget;                         /**< Budget the engines are sized for */
+    bool lazy_dfa_over_budget;                     /**< Whether the lazy DFA did not fit it */
+    bool bounds_only;                              /**< Whether the search needs no captures */
 };
 
 
@@ -113,6 +258,214 @@ bool rift_regex_matcher_configure_r_syntax_limits(rift_regex_matcher_t *matcher,
  */
 bool rift_matcher_find_next(rift_regex_matcher_t *matcher, rift_regex_match_t *match);
 
+/**
+ * @brief Run the search for the next match for a limited number of steps
+ *
+ * The search runs as rift_matcher_find_next does, but yields with
+ * RIFT_MATCH_PENDING once its engines have run max_steps steps, the unit of
+ * the steps telemetry. Everything the search needs is kept in the matcher,
+ * so the next call resumes it where it stopped; a cooperative scheduler can
+ * interleave long searches with other tasks without threads or timeouts.
+ * The search yields between start positions: an attempt in progress is
+ * finished first, so a call may run over max_steps by one attempt, which
+ * the engine switch keeps linear in the input. Setting the input or the
+ * position abandons a pending search. Telemetry and probes cover the whole
+ * search, not each call.
+ *
+ * @param matcher The matcher
+ * @param max_steps Steps to run before yielding, at least one attempt runs
+ * @param match Pointer to store match information when found (can be NULL)
+ * @param status Pointer to store the outcome of the call
+ * @return true if a match was found, false if not or not yet
+ */
+bool rift_matcher_step(rift_regex_matcher_t *matcher, uint64_t max_steps,
+                       rift_regex_match_t *match, rift_match_status_t *status);
+
+/**
+ * @brief Find the next match and report it as spans without allocating
+ *
+ * spans[0] receives the full match and spans[1 + i] capture group i. Groups
+ * that did not participate are set to RIFT_REGEX_SPAN_UNSET. No text is
+ * copied; use rift_matcher_copy_span_text to extract it when needed.
+ *
+ * @param matcher The matcher
+ * @param spans Array to store the spans (can be NULL if max_spans is 0)
+ * @param max_spans Number of entries in spans
+ * @param num_spans Pointer to store the number of spans the match has (can be NULL)
+ * @return true if a match was found, false otherwise
+ */
+bool rift_matcher_find_next_spans(rift_regex_matcher_t *matcher, rift_regex_span_t *spans,
+                                  size_t max_spans, size_t *num_spans);
+
+/**
+ * @brief Copy the text of a span into a caller-provided buffer
+ *
+ * The copy is NUL terminated and cut to fit the buffer.
+ *
+ * @param matcher The matcher whose input the span refers to
+ * @param span The span
+ * @param buffer Buffer to store the text
+ * @param buffer_size Size of the buffer
+ * @return Length of the span text, or 0 for an unset or invalid span
+ */
+size_t rift_matcher_copy_span_text(const rift_regex_matcher_t *matcher,
+                                   const rift_regex_span_t *span, char *buffer,
+                                   size_t buffer_size);
+
+/**
+ * @brief Set the callback receiving the matches of a streamed input
+ *
+ * @param matcher The matcher
+ * @param callback The callback, called once per match
+ * @param user_data User data passed to the callback
+ * @return true if successful, false otherwise
+ */
+bool rift_matcher_set_stream_callback(rift_regex_matcher_t *matcher,
+                                      rift_matcher_match_callback_t callback, void *user_data);
+
+/**
+ * @brief Feed the next chunk of a streamed input
+ *
+ * Matches are reported through the stream callback with offsets from the
+ * start of the stream, in the same order and with the same bounds as
+ * rift_matcher_find_all() over the concatenated input. A match is reported
+ * once no further input can change it, so matches crossing chunk boundaries
+ * are reported whole. Only the bytes a pending match may start in are kept.
+ * Streamed matches carry the full match span only. Patterns with
+ * backreferences cannot be streamed.
+ *
+ * After the last chunk the stream starts over at offset 0.
+ *
+ * @param matcher The matcher
+ * @param chunk The chunk bytes (can be NULL if length is 0)
+ * @param length Number of bytes in the chunk
+ * @param is_last Whether this chunk ends the input
+ * @return true if successful, false on invalid parameters, unsupported patterns or allocation
+ * failure
+ */
+bool rift_matcher_feed(rift_regex_matcher_t *matcher, const char *chunk, size_t length,
+                       bool is_last);
+
+/**
+ * @brief Discard a streamed input and start over at offset 0
+ *
+ * @param matcher The matcher
+ */
+void rift_matcher_stream_reset(rift_regex_matcher_t *matcher);
+
+/**
+ * @brief Number of spans rift_matcher_for_each_match() keeps on the stack
+ *
+ * Patterns with more capture groups get one heap array per call.
+ */
+#define RIFT_MATCHER_LOCAL_SPANS 16
+
+/**
+ * @brief Report every match of the input to a callback
+ *
+ * Matches are found from the start of the input as with
+ * rift_matcher_find_all(), but each is handed to the callback as spans as
+ * soon as it is found, so no match array is needed and memory use does not
+ * grow with the number of matches. The callback stops the search by
+ * returning false.
+ *
+ * @param matcher The matcher
+ * @param callback The callback, called once per match
+ * @param user_data User data passed to the callback
+ * @return true if successful, false on invalid parameters or allocation failure
+ */
+bool rift_matcher_for_each_match(rift_regex_matcher_t *matcher,
+                                 rift_matcher_match_callback_t callback, void *user_data);
+
+/**
+ * @brief Report every match of each line of the input to a callback
+ *
+ * Lines end at each newline, found with rift_prefilter_find_byte(), and are
+ * searched one at a time as if each were the whole input: ^ and $ match at
+ * the ends of the line whatever the pattern flags, and no match crosses a
+ * newline. Lines in which the prefilter finds no candidate, such as lines
+ * without a literal every match contains, are skipped without a search.
+ * Within a line, matches are found as with rift_matcher_for_each_match().
+ *
+ * During the callback the matcher's input is the line, so
+ * rift_matcher_copy_span_text() extracts match text. The previous input is
+ * restored afterwards.
+ *
+ * @param matcher The matcher
+ * @param callback The callback, called once per match
+ * @param user_data User data passed to the callback
+ * @return true if successful, false on invalid parameters or allocation failure
+ */
+bool rift_matcher_for_each_line_match(rift_regex_matcher_t *matcher,
+                                      rift_matcher_line_callback_t callback, void *user_data);
+
+/**
+ * @brief Report every match in a file to a callback
+ *
+ * The file is memory-mapped and scanned in place, without read copies.
+ * Matches are found as with rift_matcher_find_all(), and their spans are
+ * offsets into the file. During the callback the matcher's input is the
+ * mapping, so rift_matcher_copy_span_text() extracts match text. The
+ * previous input is restored afterwards.
+ *
+ * @param matcher The matcher
+ * @param path Path of the file to scan
+ * @param callback The callback, called once per match
+ * @param user_data User data passed to the callback
+ * @return true if the file was scanned, false otherwise
+ */
+bool rift_matcher_find_all_file(rift_regex_matcher_t *matcher, const char *path,
+                                rift_matcher_match_callback_t callback, void *user_data);
+
+/**
+ * @brief Report every match of each line of a file to a callback
+ *
+ * The file is memory-mapped and scanned in place as with
+ * rift_matcher_for_each_line_match(), so log files are searched line by
+ * line in one call instead of a read loop. Line spans are offsets into the
+ * file.
+ *
+ * @param matcher The matcher
+ * @param path Path of the file to scan
+ * @param callback The callback, called once per match
+ * @param user_data User data passed to the callback
+ * @return true if the file was scanned, false otherwise
+ */
+bool rift_matcher_find_all_lines_file(rift_regex_matcher_t *matcher, const char *path,
+                                      rift_matcher_line_callback_t callback, void *user_data);
+
+/**
+ * @brief Smallest chunk rift_matcher_find_all_parallel() gives a thread
+ */
+#ifndef RIFT_MATCHER_PARALLEL_MIN_CHUNK
+#define RIFT_MATCHER_PARALLEL_MIN_CHUNK (64 * 1024)
+#endif
+
+/**
+ * @brief Report every match of an input to a callback, searching it on several threads
+ *
+ * The input is cut into one chunk per thread, and each thread finds the
+ * matches starting in its chunk with a matcher of its own, so the compiled
+ * pattern is shared and only read. A match found in one chunk may end in
+ * the next, which then enters the chunk past where its own search began;
+ * the caller searches those few positions again until the two searches
+ * agree, so the matches reported are exactly those of
+ * rift_matcher_for_each_match(), in the same order, all from the calling
+ * thread. Matches carry the full match span only.
+ *
+ * @param pattern The compiled pattern
+ * @param input The input
+ * @param length Length of the input or (size_t)-1 to use strlen
+ * @param num_threads Number of threads to search with, including the caller's; fewer are
+ *                    used when chunks would be smaller than RIFT_MATCHER_PARALLEL_MIN_CHUNK
+ * @param callback The callback, called once per match
+ * @param user_data User data passed to the callback
+ * @return true if the input was searched, false on invalid parameters or allocation failure
+ */
+bool rift_matcher_find_all_parallel(const rift_regex_pattern_t *pattern, const char *input,
+                                    size_t length, size_t num_threads,
+                                    rift_matcher_match_callback_t callback, void *user_data);
+
 /**
  * @brief Check if the entire input string matches the pattern
  *
@@ -122,6 +475,33 @@ bool rift_matcher_find_next(rift_regex_matcher_t *matcher, rift_regex_match_t *m
  */
 bool rift_matcher_matches(rift_regex_matcher_t *matcher, rift_regex_match_t *match);
 
+/**
+ * @brief Check whether the pattern matches anywhere in the input
+ *
+ * Answers whether rift_matcher_find_next() would find a match from the
+ * start of the input, without computing its bounds or captures. Patterns
+ * that run on the DFAs, including those with capture groups, stop at the
+ * first accepting state of one unanchored forward pass. The position of
+ * the matcher is left unchanged.
+ *
+ * @param matcher The matcher
+ * @return true if the input has a match, false otherwise
+ */
+bool rift_matcher_is_match(rift_regex_matcher_t *matcher);
+
+/**
+ * @brief Count the matches in the input
+ *
+ * Counts the matches rift_matcher_for_each_match() would report, restarting
+ * after each one, without computing captures or building spans. Patterns
+ * with capture groups run on the lazy DFA like those without when they can.
+ * The position of the matcher is left unchanged.
+ *
+ * @param matcher The matcher
+ * @return Number of matches, 0 on invalid parameters
+ */
+size_t rift_matcher_count(rift_regex_matcher_t *matcher);
+
 /**
  * @brief Find all matches in the input string
  *
@@ -159,6 +539,38 @@ bool rift_matcher_replace(rift_regex_matcher_t *matcher, const char *replacement
 bool rift_matcher_split(rift_regex_matcher_t *matcher, char **parts, size_t max_parts,
                         size_t *num_parts);
 
+/**
+ * @brief Replace every match, appending the result to a growable buffer
+ *
+ * The input is rewritten in one left-to-right pass. The replacement is
+ * compiled once with rift_replacement_compile() and may refer to groups as
+ * $N or ${N}. The result is appended to output, which is not cleared first.
+ *
+ * @param matcher The matcher
+ * @param replacement The compiled replacement template
+ * @param output The buffer to append to
+ * @param num_replacements Pointer to store the number of replacements made (can be NULL)
+ * @return true if successful, false on invalid parameters or allocation failure
+ */
+bool rift_matcher_replace_into(rift_regex_matcher_t *matcher,
+                               const rift_replacement_t *replacement,
+                               rift_output_buffer_t *output, size_t *num_replacements);
+
+/**
+ * @brief Split the input around the matches, returning spans into the input
+ *
+ * Parts are found as with rift_matcher_split(), but nothing is copied or
+ * allocated: each part is a span of the matcher's input.
+ *
+ * @param matcher The matcher
+ * @param parts Array to store the parts
+ * @param max_parts Number of entries in parts
+ * @param num_parts Pointer to store the number of parts
+ * @return true if at least one part was found, false otherwise
+ */
+bool rift_matcher_split_spans(rift_regex_matcher_t *matcher, rift_regex_span_t *parts,
+                              size_t max_parts, size_t *num_parts);
+
 /**
  * @brief Set matcher options
  *
@@ -210,6 +622,216 @@ bool rift_matcher_set_timeout(rift_regex_matcher_t *matcher, uint32_t timeout_ms
  */
 bool rift_matcher_timed_out(const rift_regex_matcher_t *matcher);
 
+/**
+ * @brief Get the current time of the monotonic clock used for deadlines
+ *
+ * @return Nanoseconds since an unspecified starting point
+ */
+uint64_t rift_matcher_monotonic_ns(void);
+
+/**
+ * @brief Set an absolute deadline for matching operations
+ *
+ * Unlike the timeout, which restarts with every match attempt, the deadline
+ * is fixed, so it bounds a whole request of several searches. When both are
+ * set the earlier one applies.
+ *
+ * @param matcher The matcher
+ * @param deadline_ns Deadline from rift_matcher_monotonic_ns, or
+ *                    RIFT_MATCHER_NO_DEADLINE
+ * @return true if successful, false otherwise
+ */
+bool rift_matcher_set_deadline(rift_regex_matcher_t *matcher, uint64_t deadline_ns);
+
+/**
+ * @brief Let another thread cancel matching operations through a flag
+ *
+ * The flag is read with relaxed ordering every
+ * RIFT_MATCHER_TIMEOUT_CHECK_INTERVAL steps. Once it is set, matching stops
+ * as on a timeout and rift_matcher_timed_out reports true. The flag must
+ * outlive its use by the matcher.
+ *
+ * @param matcher The matcher
+ * @param cancel_flag The flag, or NULL to stop watching one
+ * @return true if successful, false otherwise
+ */
+bool rift_matcher_set_cancel_flag(rift_regex_matcher_t *matcher, const atomic_bool *cancel_flag);
+
+/**
+ * @brief Set when a backtracking attempt moves to the Pike VM
+ *
+ * An attempt on the backtracker that runs more than steps_per_byte steps for
+ * each byte from its start to the end of the input is handed to the Pike VM,
+ * which reruns it from the same start in linear time. A match the backtracker
+ * already found is kept if the Pike VM finds none. The switch is counted in
+ * the engine_switches telemetry and fires the bailout probe. Patterns with
+ * backreferences, which the Pike VM cannot run, never switch and stay bound
+ * by the transition limit and the timeout. New matchers use
+ * RIFT_MATCHER_SWITCH_STEPS_PER_BYTE.
+ *
+ * @param matcher The matcher
+ * @param steps_per_byte Steps per byte before switching, 0 to never switch
+ * @return true if successful, false otherwise
+ */
+bool rift_matcher_set_engine_switch(rift_regex_matcher_t *matcher, uint32_t steps_per_byte);
+
+/**
+ * @brief Take the backtracking limits from a registry
+ *
+ * The effective limits are resolved here and stored on the matcher, so the
+ * backtracking loop reads plain fields. Each match compares the registry
+ * generation with the one the limits came from and resolves again only when
+ * the registry has changed since. The registry must outlive its use by the
+ * matcher.
+ *
+ * @param matcher The matcher
+ * @param registry The registry, or NULL to stop using one
+ * @param pattern_id Pattern identifier to resolve
+ * @param match_id Match identifier to resolve
+ * @return true if successful, false otherwise
+ */
+bool rift_matcher_set_limit_registry(rift_regex_matcher_t *matcher,
+                                     const rift_backtrack_limit_registry_t *registry,
+                                     uint32_t pattern_id, uint32_t match_id);
+
+/**
+ * @brief Allocate the matcher's engines and buffers through an allocator
+ *
+ * The lazy DFA, the Pike VM, the prefilter and the stream buffer the
+ * matcher builds from now on come from the allocator, so a request's
+ * matching memory can live in a per-request arena. Those built before stay
+ * with the allocator they came from. The allocator must outlive the
+ * matcher.
+ *
+ * @param matcher The matcher
+ * @param allocator The allocator, or NULL for the one in use on the thread
+ * @return true if successful, false otherwise
+ */
+bool rift_matcher_set_allocator(rift_regex_matcher_t *matcher,
+                                const rift_allocator_t *allocator);
+
+/**
+ * @brief Bound the memory a search's engines may use
+ *
+ * The budget in effect is the smaller of this one and the memory budget of
+ * the limit registry, if any. Engines degrade rather than fail when they do
+ * not fit: the lazy DFA keeps fewer cached states, and a pattern whose
+ * smallest state cache does not fit runs on the Pike VM instead, counted in
+ * the budget_fallbacks telemetry. The backtracker's depth is capped to the
+ * frames the budget holds. Engines sized for another budget are rebuilt on
+ * the next search.
+ *
+ * @param matcher The matcher
+ * @param max_bytes The budget in bytes, 0 for none
+ * @return true if successful, false otherwise
+ */
+bool rift_matcher_set_memory_budget(rift_regex_matcher_t *matcher, size_t max_bytes);
+
+/**
+ * @brief Save the lazy DFA state caches of a matcher to a file
+ *
+ * The states the matcher's lazy DFAs built during its searches are written
+ * with their transitions, so another process running the same pattern can
+ * load them with rift_matcher_load_dfa_cache() and skip rebuilding them on
+ * its first inputs. A matcher that built no lazy DFA writes an empty cache.
+ *
+ * @param matcher The matcher
+ * @param path Path of the cache file, replaced if it exists
+ * @return true if saved, false on invalid parameters or an I/O error
+ */
+bool rift_matcher_save_dfa_cache(const rift_regex_matcher_t *matcher, const char *path);
+
+/**
+ * @brief Load the lazy DFA state caches of a matcher from a file
+ *
+ * The file must have been saved for the same pattern, with the same flags,
+ * on a machine of the same byte order. Lazy DFAs the matcher uses are built
+ * first and take the saved states that fit their cache; caches for DFAs it
+ * does not use, such as under RIFT_MATCHER_OPTION_PIKE_VM, are skipped.
+ * A failed load leaves the caches in a valid state, possibly empty.
+ *
+ * @param matcher The matcher
+ * @param path Path of the cache file
+ * @return true if loaded, false on invalid parameters, an I/O error or a
+ *         cache saved for another pattern
+ */
+bool rift_matcher_load_dfa_cache(rift_regex_matcher_t *matcher, const char *path);
+
+/**
+ * @brief Turn per-search telemetry on or off
+ *
+ * While enabled, each search records its counters, which
+ * rift_matcher_get_stats() returns until the next search, adds them to the
+ * matcher's totals and, with a limit registry, to the totals of the
+ * matcher's pattern identifier there. While disabled, counting costs a
+ * test of this flag.
+ *
+ * @param matcher The matcher
+ * @param enabled Whether to record telemetry
+ * @return true if successful, false otherwise
+ */
+bool rift_matcher_set_stats_enabled(rift_regex_matcher_t *matcher, bool enabled);
+
+/**
+ * @brief Get the telemetry of the latest search
+ *
+ * @param matcher The matcher
+ * @param stats Pointer to store the counters
+ * @return true if successful, false otherwise
+ */
+bool rift_matcher_get_stats(const rift_regex_matcher_t *matcher, rift_match_stats_t *stats);
+
+/**
+ * @brief Get the telemetry summed over every search recorded by a matcher
+ *
+ * @param matcher The matcher
+ * @param stats Pointer to store the counters
+ * @return true if successful, false otherwise
+ */
+bool rift_matcher_get_total_stats(const rift_regex_matcher_t *matcher, rift_match_stats_t *stats);
+
+/**
+ * @brief Clear the telemetry of a matcher
+ *
+ * @param matcher The matcher
+ */
+void rift_matcher_reset_stats(rift_regex_matcher_t *matcher);
+
+/**
+ * @brief Record the searches of a matcher into a trace buffer
+ *
+ * Records name automaton states by ID. The backtracking matcher records
+ * the start of each attempt, every character consumed, each state that
+ * rejects a character, each backtrack point resumed and each accepting
+ * state reached. The lazy DFA and Pike VM never backtrack and record only
+ * the start and the match of an attempt, with RIFT_TRACE_NO_LOCATION; use
+ * RIFT_MATCHER_OPTION_BACKTRACK for a trace of states. A matcher without a
+ * buffer tests one pointer per recorded event.
+ *
+ * @param matcher The matcher
+ * @param trace The buffer, not owned, or NULL to stop recording
+ * @return true if successful, false otherwise
+ */
+bool rift_matcher_set_trace(rift_regex_matcher_t *matcher, struct rift_trace_buffer *trace);
+
+/**
+ * @brief Count the searches of a matcher in a metrics registry
+ *
+ * Every search from rift_matcher_find_next() or rift_matcher_matches() is
+ * recorded with its latency, whether it matched or timed out, and the
+ * engine of its last attempt, whether or not the matcher records
+ * telemetry. Matchers of one pattern on several threads can share the
+ * registry and the identifier. The registry must outlive its use by the
+ * matcher.
+ *
+ * @param matcher The matcher
+ * @param metrics The registry, not owned, or NULL to stop counting
+ * @param pattern_id Identifier from rift_metrics_register_pattern()
+ * @return true if successful, false otherwise
+ */
+bool rift_matcher_set_metrics(rift_regex_matcher_t *matcher, struct rift_metrics *metrics,
+                              uint32_t pattern_id);
+
 /**
  * @brief Get the pattern associated with a matcher
  *
@@ -244,16 +866,19 @@ size_t rift_matcher_get_position(const rift_regex_matcher_t *matcher);
 bool rift_matcher_set_position(rift_regex_matcher_t *matcher, size_t position);
 
 /**
- * @brief Process a single character through the automaton
+ * @brief Process a single character from a state of the automaton
+ *
+ * The automaton is only read, so one compiled pattern can serve any number of
+ * matchers at once.
  *
  * @param automaton The automaton
+ * @param current_state Pointer to the state to move from, updated to the target state
  * @param c The character to process
- * @param matcher The matcher for backtracking
  * @param context The matcher context for capturing
  * @return true if the character was accepted, false otherwise
  */
-bool process_character(rift_regex_automaton_t *automaton, char c, rift_regex_matcher_t *matcher,
-                       rift_regex_matcher_context_t *context);
+bool process_character(const rift_regex_automaton_t *automaton, rift_regex_state_t **current_state,
+                       char c, rift_regex_matcher_context_t *context);
 
 /**
  * @brief Create a matcher from a pattern string
@@ -272,7 +897,12 @@ rift_regex_matcher_t *rift_matcher_create_from_string(const char *pattern_string
                                                       rift_regex_error_t *error);
 
 /**
- * @brief Check if a matcher has timed out
+ * @brief Check if a matcher has timed out or been cancelled
+ *
+ * Cheap enough to call for every input character: the monotonic clock and
+ * the cancel flag are only read every RIFT_MATCHER_TIMEOUT_CHECK_INTERVAL
+ * calls, and a matcher without a timeout, deadline or cancel flag returns
+ * at once.
  *
  * @param matcher The matcher
  * @return true if timed out, false otherwise
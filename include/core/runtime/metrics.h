@@ -0,0 +1,196 @@
+/**
+ * @file metrics.h
+ * @brief Registry of search metrics for long-running services
+ *
+ * A registry counts the searches, matches and timeouts of every registered
+ * pattern, by the engine that ran them, and keeps a histogram of their
+ * latency. Matchers attached with rift_matcher_set_metrics() record into
+ * it, and rift_metrics_snapshot() renders it for a scrape as Prometheus
+ * text or JSON.
+ *
+ * Each thread records into one of RIFT_METRICS_SHARDS shards with relaxed
+ * atomic adds, so threads searching the same pattern do not share cache
+ * lines, and the shards are summed only when read. The latency histogram
+ * keeps RIFT_METRICS_SUB_BUCKETS buckets per power of two, in the manner of
+ * HDR histograms, so a quantile read from it is within 12.5% of the exact
+ * value whatever the latency.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "core/runtime/execution_tracker.h"
+#include "core/runtime/replacement.h"
+#ifndef LIBRIFT_RUNTIME_METRICS_H
+#define LIBRIFT_RUNTIME_METRICS_H
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Number of shards threads record into
+ */
+#define RIFT_METRICS_SHARDS 16
+
+/**
+ * @brief Buckets of the latency histogram per power of two
+ */
+#define RIFT_METRICS_SUB_BUCKETS 8
+
+/**
+ * @brief Highest power of two the latency histogram tells apart
+ *
+ * Latencies of 2^40 ns, about 18 minutes, and above share the last bucket.
+ */
+#define RIFT_METRICS_MAX_EXPONENT 40
+
+/**
+ * @brief Number of buckets of the latency histogram
+ */
+#define RIFT_METRICS_LATENCY_BUCKETS                                                               \
+    (RIFT_METRICS_SUB_BUCKETS + (RIFT_METRICS_MAX_EXPONENT - 3) * RIFT_METRICS_SUB_BUCKETS)
+
+/**
+ * @brief Pattern identifier returned when a registry is full
+ */
+#define RIFT_METRICS_NO_PATTERN UINT32_MAX
+
+/**
+ * @brief Format of a metrics snapshot
+ */
+typedef enum rift_metrics_format {
+    RIFT_METRICS_FORMAT_PROMETHEUS, /**< Prometheus text exposition format */
+    RIFT_METRICS_FORMAT_JSON        /**< One JSON object */
+} rift_metrics_format_t;
+
+/**
+ * @brief Opaque metrics registry
+ */
+typedef struct rift_metrics rift_metrics_t;
+
+/**
+ * @brief Metrics of one pattern, summed over the shards
+ *
+ * A search is counted under the engine of its last attempt, which is
+ * RIFT_MATCH_ENGINE_NONE when the prefilter ruled out every start.
+ */
+typedef struct rift_metrics_pattern {
+    const char *name;                               /**< Name the pattern was registered with */
+    uint64_t searches[RIFT_MATCH_ENGINE_COUNT];     /**< Searches run, by engine */
+    uint64_t matches[RIFT_MATCH_ENGINE_COUNT];      /**< Searches that found a match, by engine */
+    uint64_t timeouts[RIFT_MATCH_ENGINE_COUNT];     /**< Searches stopped by a limit, by engine */
+    uint64_t latency_count;                         /**< Latencies recorded */
+    uint64_t latency_sum_ns;                        /**< Sum of the latencies recorded */
+    uint64_t latency[RIFT_METRICS_LATENCY_BUCKETS]; /**< Latencies recorded in each bucket */
+} rift_metrics_pattern_t;
+
+/**
+ * @brief Create a metrics registry
+ *
+ * @param max_patterns Number of patterns the registry can hold
+ * @return A new registry or NULL on failure
+ */
+rift_metrics_t *rift_metrics_create(size_t max_patterns);
+
+/**
+ * @brief Free a metrics registry
+ *
+ * No matcher may record into the registry any longer.
+ *
+ * @param metrics The registry
+ */
+void rift_metrics_free(rift_metrics_t *metrics);
+
+/**
+ * @brief Register a pattern
+ *
+ * @param metrics The registry
+ * @param name Name of the pattern in snapshots, or NULL for its identifier
+ * @return The pattern identifier, or RIFT_METRICS_NO_PATTERN if the registry
+ *         is full or out of memory
+ */
+uint32_t rift_metrics_register_pattern(rift_metrics_t *metrics, const char *name);
+
+/**
+ * @brief Get the number of registered patterns
+ *
+ * @param metrics The registry
+ * @return Number of patterns, identified 0 to the count less one
+ */
+size_t rift_metrics_get_pattern_count(const rift_metrics_t *metrics);
+
+/**
+ * @brief Record one search
+ *
+ * Safe to call from any number of threads at once. The first search a
+ * shard records for a pattern allocates the pattern's counters in it; a
+ * search that cannot get them goes unrecorded.
+ *
+ * @param metrics The registry
+ * @param pattern The pattern identifier
+ * @param engine Engine of the search's last attempt
+ * @param found Whether the search found a match
+ * @param timed_out Whether a timeout or a limit stopped the search
+ * @param latency_ns Duration of the search
+ */
+void rift_metrics_record(rift_metrics_t *metrics, uint32_t pattern, rift_match_engine_t engine,
+                         bool found, bool timed_out, uint64_t latency_ns);
+
+/**
+ * @brief Sum the metrics of a pattern over the shards
+ *
+ * Searches recorded while the shards are read may be counted or not.
+ *
+ * @param metrics The registry
+ * @param pattern The pattern identifier
+ * @param result Where to store the metrics
+ * @return true if successful, false for an unknown pattern
+ */
+bool rift_metrics_get_pattern(const rift_metrics_t *metrics, uint32_t pattern,
+                              rift_metrics_pattern_t *result);
+
+/**
+ * @brief Estimate a latency quantile
+ *
+ * @param result Metrics of a pattern
+ * @param quantile The quantile, between 0 and 1
+ * @return The highest latency of the bucket holding the quantile, 0 if no
+ *         latency was recorded
+ */
+uint64_t rift_metrics_latency_quantile(const rift_metrics_pattern_t *result, double quantile);
+
+/**
+ * @brief Clear the metrics of every pattern, keeping the patterns
+ *
+ * @param metrics The registry
+ */
+void rift_metrics_reset(rift_metrics_t *metrics);
+
+/**
+ * @brief Render the metrics of every pattern
+ *
+ * The Prometheus format exposes the counters librift_searches_total,
+ * librift_matches_total and librift_timeouts_total, labelled by pattern and
+ * engine, and the summary librift_search_latency_seconds with the 0.5, 0.9,
+ * 0.99 and 0.999 quantiles, labelled by pattern. The JSON format holds the
+ * same values with latencies in nanoseconds. Engines that ran no search are
+ * left out.
+ *
+ * @param metrics The registry
+ * @param format The format
+ * @param buffer Buffer the snapshot is appended to
+ * @return true if successful, false on allocation failure
+ */
+bool rift_metrics_snapshot(const rift_metrics_t *metrics, rift_metrics_format_t format,
+                           rift_output_buffer_t *buffer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_RUNTIME_METRICS_H */
@@ -0,0 +1,100 @@
+/**
+ * @file perf_counters.h
+ * @brief Hardware performance counters around a piece of work
+ *
+ * Wall time says a search got slower, not why. The counters here read what
+ * the CPU did meanwhile: cycles, instructions, branch misses, L1 data and
+ * last-level cache misses and data TLB misses, counted for the calling
+ * thread in user space only. They come from perf_event_open on Linux;
+ * elsewhere, and where the kernel or a hypervisor refuses an event, the
+ * event is reported as unavailable rather than failing the measurement.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_RUNTIME_PERF_COUNTERS_H
+#define LIBRIFT_RUNTIME_PERF_COUNTERS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Events the counters read
+ */
+typedef enum rift_perf_event {
+    RIFT_PERF_EVENT_CYCLES = 0,     /**< CPU cycles */
+    RIFT_PERF_EVENT_INSTRUCTIONS,   /**< Instructions retired */
+    RIFT_PERF_EVENT_BRANCH_MISSES,  /**< Mispredicted branches */
+    RIFT_PERF_EVENT_L1D_MISSES,     /**< L1 data cache read misses */
+    RIFT_PERF_EVENT_LLC_MISSES,     /**< Last-level cache misses */
+    RIFT_PERF_EVENT_DTLB_MISSES,    /**< Data TLB read misses */
+    RIFT_PERF_EVENT_COUNT           /**< Number of events */
+} rift_perf_event_t;
+
+/**
+ * @brief Counts of the events over one measurement
+ */
+typedef struct rift_perf_sample {
+    uint64_t values[RIFT_PERF_EVENT_COUNT]; /**< Count of each event */
+    bool valid[RIFT_PERF_EVENT_COUNT];      /**< Whether the event was counted */
+} rift_perf_sample_t;
+
+/**
+ * @brief Forward declaration of the counters structure
+ */
+typedef struct rift_perf_counters rift_perf_counters_t;
+
+/**
+ * @brief Open the counters of the calling thread
+ *
+ * The counters count only the thread that opened them.
+ *
+ * @return The counters, or NULL if not one event can be counted
+ */
+rift_perf_counters_t *rift_perf_counters_create(void);
+
+/**
+ * @brief Close counters
+ *
+ * @param counters The counters (can be NULL)
+ */
+void rift_perf_counters_free(rift_perf_counters_t *counters);
+
+/**
+ * @brief Zero the counters and start counting
+ *
+ * @param counters The counters
+ * @return true if counting started, false otherwise
+ */
+bool rift_perf_counters_start(rift_perf_counters_t *counters);
+
+/**
+ * @brief Stop counting and read the counts since the last start
+ *
+ * When more events are open than the CPU has counters, the kernel takes
+ * turns between them; such counts are scaled up to the whole measurement.
+ *
+ * @param counters The counters
+ * @param sample Where the counts go
+ * @return true if at least one event was read, false otherwise
+ */
+bool rift_perf_counters_stop(rift_perf_counters_t *counters, rift_perf_sample_t *sample);
+
+/**
+ * @brief Get the name of an event, as used in reports
+ *
+ * @param event The event
+ * @return The name, such as "cycles", or "unknown"
+ */
+const char *rift_perf_event_name(rift_perf_event_t event);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_RUNTIME_PERF_COUNTERS_H */
@@ -0,0 +1,61 @@
+/**
+ * @file probes.h
+ * @brief Static tracepoints at the boundaries of the engine
+ *
+ * Built with LIBRIFT_USDT on a system with <sys/sdt.h>, every probe below is
+ * a USDT probe of the provider "librift": a single NOP in the code and a
+ * note in the binary, which bpftrace, perf or SystemTap turn into a trap
+ * only while attached. Without LIBRIFT_USDT the probes compile to nothing.
+ *
+ * Patterns are identified by their address, which compile__end pairs with
+ * the pattern source:
+ *
+ *   compile__start   (const char *source, size_t length, int flags)
+ *   compile__end     (const void *pattern, const char *source, size_t num_states, int error)
+ *   engine__select   (const void *pattern, int engine, size_t position)
+ *   match__start     (const void *pattern, size_t input_length, size_t position)
+ *   match__end       (const void *pattern, int found, size_t start, size_t end)
+ *   bailout          (const void *pattern, int reason, size_t position)
+ *   timeout          (const void *pattern, int cancelled, size_t position)
+ *   lazy_dfa__flush  (const void *lazy_dfa, size_t cached_states)
+ *   lazy_dfa__bailout(const void *lazy_dfa, size_t position, size_t cached_states)
+ *   pool__exhausted  (size_t object_size)
+ *
+ * For instance, the search latency of every pattern:
+ *
+ *   bpftrace -e 'usdt:./librift.so:librift:match__start { @t[tid] = nsecs; }
+ *                usdt:./librift.so:librift:match__end /@t[tid]/ {
+ *                    @ns[arg0] = hist(nsecs - @t[tid]); delete(@t[tid]); }'
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_RUNTIME_PROBES_H
+#define LIBRIFT_RUNTIME_PROBES_H
+
+/**
+ * @brief Why a search left the engine it started on
+ */
+typedef enum rift_probe_bailout {
+    RIFT_PROBE_BAILOUT_TRANSITION_LIMIT = 1, /**< The backtracker hit its transition limit */
+    RIFT_PROBE_BAILOUT_BUDGET = 2,           /**< The lazy DFA was over its memory budget */
+    RIFT_PROBE_BAILOUT_ENGINE_SWITCH = 3     /**< The backtracker handed off to the Pike VM */
+} rift_probe_bailout_t;
+
+#ifdef LIBRIFT_USDT
+#include <sys/sdt.h>
+
+#define RIFT_PROBE0(name) DTRACE_PROBE(librift, name)
+#define RIFT_PROBE1(name, a) DTRACE_PROBE1(librift, name, a)
+#define RIFT_PROBE2(name, a, b) DTRACE_PROBE2(librift, name, a, b)
+#define RIFT_PROBE3(name, a, b, c) DTRACE_PROBE3(librift, name, a, b, c)
+#define RIFT_PROBE4(name, a, b, c, d) DTRACE_PROBE4(librift, name, a, b, c, d)
+#else
+#define RIFT_PROBE0(name) ((void)0)
+#define RIFT_PROBE1(name, a) ((void)0)
+#define RIFT_PROBE2(name, a, b) ((void)0)
+#define RIFT_PROBE3(name, a, b, c) ((void)0)
+#define RIFT_PROBE4(name, a, b, c, d) ((void)0)
+#endif
+
+#endif /* LIBRIFT_RUNTIME_PROBES_H */
@@ -0,0 +1,127 @@
+/**
+ * @file replacement.h
+ * @brief Replacement templates and growable output buffers for the LibRift regex engine
+ *
+ * This file defines replacement templates that are parsed once and expanded
+ * for every match from its spans, and the growable buffer the expansions are
+ * appended to. A template is literal text in which $N or ${N} stands for
+ * capture group N, $0 for the whole match and $$ for a single $.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_RUNTIME_REPLACEMENT_H
+#define LIBRIFT_RUNTIME_REPLACEMENT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "core/errors/regex_error.h"
+#include "core/runtime/match_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Growable byte buffer
+ *
+ * The data is kept NUL terminated once anything has been appended.
+ */
+typedef struct rift_output_buffer {
+    char *data;      /**< Buffer bytes, NULL until the first append */
+    size_t length;   /**< Number of bytes in use, not counting the terminator */
+    size_t capacity; /**< Number of bytes allocated */
+} rift_output_buffer_t;
+
+/**
+ * @brief One piece of a replacement template
+ *
+ * A piece is either the literal text template[offset, offset + length) or,
+ * when is_group is set, the text of span group.
+ */
+typedef struct rift_replacement_piece {
+    bool is_group; /**< Whether the piece refers to a group */
+    size_t offset; /**< Offset of the literal text in the template */
+    size_t length; /**< Length of the literal text */
+    size_t group;  /**< Span index of the group, 0 for the whole match */
+} rift_replacement_piece_t;
+
+/**
+ * @brief Parsed replacement template
+ */
+typedef struct rift_replacement {
+    char *text;                       /**< Copy of the template text */
+    rift_replacement_piece_t *pieces; /**< Pieces in output order */
+    size_t num_pieces;                /**< Number of pieces */
+    size_t max_group;                 /**< Highest group referenced */
+} rift_replacement_t;
+
+/**
+ * @brief Initialize an empty output buffer
+ *
+ * @param buffer The buffer
+ */
+void rift_output_buffer_init(rift_output_buffer_t *buffer);
+
+/**
+ * @brief Append bytes to an output buffer
+ *
+ * @param buffer The buffer
+ * @param bytes The bytes to append (can be NULL if length is 0)
+ * @param length Number of bytes
+ * @return true if successful, false on allocation failure
+ */
+bool rift_output_buffer_append(rift_output_buffer_t *buffer, const char *bytes, size_t length);
+
+/**
+ * @brief Empty an output buffer, keeping its memory
+ *
+ * @param buffer The buffer
+ */
+void rift_output_buffer_clear(rift_output_buffer_t *buffer);
+
+/**
+ * @brief Release the memory of an output buffer
+ *
+ * @param buffer The buffer, left empty and reusable
+ */
+void rift_output_buffer_free(rift_output_buffer_t *buffer);
+
+/**
+ * @brief Parse a replacement template
+ *
+ * @param text The template text
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new replacement or NULL on failure
+ */
+rift_replacement_t *rift_replacement_compile(const char *text, rift_regex_error_t *error);
+
+/**
+ * @brief Free a replacement template
+ *
+ * @param replacement The replacement to free
+ */
+void rift_replacement_free(rift_replacement_t *replacement);
+
+/**
+ * @brief Append the expansion of a replacement for one match
+ *
+ * Groups that did not participate, or that lie beyond num_spans, expand to
+ * nothing.
+ *
+ * @param replacement The replacement
+ * @param input The input the spans refer to
+ * @param spans The spans of the match, spans[0] being the whole match
+ * @param num_spans Number of spans
+ * @param output The buffer to append to
+ * @return true if successful, false on invalid parameters or allocation failure
+ */
+bool rift_replacement_expand(const rift_replacement_t *replacement, const char *input,
+                             const rift_regex_span_t *spans, size_t num_spans,
+                             rift_output_buffer_t *output);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_RUNTIME_REPLACEMENT_H */
@@ -12,10 +12,9 @@
 #include <stddef.h>
 #include <stdint.h>
 #include "backtracker_bailout_strategy_manager.h"
-#include "backtracker_extension.h"
 #include "backtracker.h"
 #include "backtracker_limit_registry.h"
-#include "backtracker_safe_backtracker.h"
+#include "backtrack_stack.h"
 #include "context.h"
 #include "contexthread_safe_context.h"
 #include "context_thread_safe_context.h"
@@ -27,6 +26,7 @@
 #include "pattern_pattern_complexity_strategy.h"
 #include "pattern_pattern_tracking_strategy.h"
 #include "pattern_tracking_strategy.h"
+#include "safe_backtracker.h"
 #ifndef LIBRIFT_RUNTIME_H
 #define LIBRIFT_RUNTIME_H
 
@@ -2,6 +2,12 @@
  * @file safe_backtracker.h
  * @brief Header file for the safe_backtracker module
  *
+ * This file defines the thread-safe backtracker, a thread-local instance
+ * policy layered on the backtracker in backtracker.h. Each thread gets its
+ * own backtracker on first use, found again through a thread-local cache
+ * without locking; the depth limit and bailout hook are the shared policy
+ * every instance is created with.
+ *
  * @copyright Copyright (c) 2025 LibRift Project
  * @license MIT License
  */
@@ -12,12 +18,148 @@
 #ifndef CORE_RUNTIME_SAFE_BACKTRACKER_H
 #define CORE_RUNTIME_SAFE_BACKTRACKER_H
 
+#include <pthread.h>
+#include <stdatomic.h>
+#include "core/errors/regex_error.h"
+#include "core/runtime/backtracker.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-/* Forward declarations and function prototypes */
+struct rift_safe_backtracker_arena;
+
+/**
+ * @brief Thread-safe backtracker
+ */
+typedef struct rift_regex_safe_backtracker {
+    pthread_key_t thread_local_key;          /**< Key of each thread's arena, for thread exit */
+    pthread_mutex_t mutex;                   /**< Guards arenas and policy */
+    rift_regex_backtracker_t *global_bt;     /**< Fallback when an arena cannot be made */
+    rift_backtracker_policy_t policy;        /**< Policy thread-local backtrackers get */
+    atomic_uint_fast64_t policy_generation;  /**< Bumped on every policy change */
+    struct rift_safe_backtracker_arena *arenas; /**< Arenas of the threads that used it */
+    uint64_t id;                             /**< Process-unique id keying thread caches */
+    size_t num_groups;                       /**< Number of capture groups */
+    bool initialized;                        /**< Whether the key and mutex were created */
+} rift_regex_safe_backtracker_t;
+
+/**
+ * @brief Create a new thread-safe backtracker
+ *
+ * @param max_depth Maximum backtracking depth
+ * @param num_groups Number of capture groups
+ * @return Pointer to the new thread-safe backtracker or NULL on failure
+ */
+rift_regex_safe_backtracker_t *rift_safe_backtracker_create(uint32_t max_depth, size_t num_groups);
+
+/**
+ * @brief Create a new thread-safe backtracker with a policy
+ *
+ * @param policy The policy every thread-local backtracker gets
+ * @param num_groups Number of capture groups
+ * @return Pointer to the new thread-safe backtracker or NULL on failure
+ */
+rift_regex_safe_backtracker_t *
+rift_safe_backtracker_create_with_policy(const rift_backtracker_policy_t *policy,
+                                         size_t num_groups);
+
+/**
+ * @brief Get the calling thread's backtracker, creating it on first use
+ *
+ * @param safe_bt The thread-safe backtracker
+ * @return Pointer to the thread-local backtracker or NULL on failure
+ */
+rift_regex_backtracker_t *rift_safe_backtracker_get_local(rift_regex_safe_backtracker_t *safe_bt);
+
+/**
+ * @brief Push a new backtrack point onto the calling thread's stack
+ *
+ * @param safe_bt The thread-safe backtracker
+ * @param state The current state
+ * @param input_position Position in the input string
+ * @param group_starts Array of group start positions
+ * @param group_ends Array of group end positions
+ * @param num_groups Number of groups
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if the point was pushed successfully, false otherwise
+ */
+bool rift_safe_backtracker_push(rift_regex_safe_backtracker_t *safe_bt, rift_regex_state_t *state,
+                                size_t input_position, const size_t *group_starts,
+                                const size_t *group_ends, size_t num_groups,
+                                rift_regex_error_t *error);
+
+/**
+ * @brief Pop a backtrack point from the calling thread's stack
+ *
+ * @param safe_bt The thread-safe backtracker
+ * @param state Pointer to store the state
+ * @param input_position Pointer to store the input position
+ * @param group_starts Array to store group start positions
+ * @param group_ends Array to store group end positions
+ * @param num_groups Pointer to store the number of groups
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if a point was popped, false if the stack was empty
+ */
+bool rift_safe_backtracker_pop(rift_regex_safe_backtracker_t *safe_bt, rift_regex_state_t **state,
+                               size_t *input_position, size_t *group_starts, size_t *group_ends,
+                               size_t *num_groups, rift_regex_error_t *error);
+
+/**
+ * @brief Check if the calling thread's stack is empty
+ *
+ * @param safe_bt The thread-safe backtracker
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if the stack is empty, false otherwise
+ */
+bool rift_safe_backtracker_is_empty(rift_regex_safe_backtracker_t *safe_bt,
+                                    rift_regex_error_t *error);
+
+/**
+ * @brief Reset the calling thread's stack
+ *
+ * @param safe_bt The thread-safe backtracker
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+bool rift_safe_backtracker_reset(rift_regex_safe_backtracker_t *safe_bt, rift_regex_error_t *error);
+
+/**
+ * @brief Get the depth of the calling thread's stack
+ *
+ * @param safe_bt The thread-safe backtracker
+ * @param error Pointer to store error information (can be NULL)
+ * @return The current depth or (size_t)-1 on error
+ */
+size_t rift_safe_backtracker_get_depth(rift_regex_safe_backtracker_t *safe_bt,
+                                       rift_regex_error_t *error);
+
+/**
+ * @brief Get the maximum depth allowed for the backtracker
+ *
+ * @param safe_bt The thread-safe backtracker
+ * @return The maximum allowed depth
+ */
+uint32_t rift_safe_backtracker_get_max_depth(const rift_regex_safe_backtracker_t *safe_bt);
+
+/**
+ * @brief Set the maximum depth for the backtracker
+ *
+ * Each thread applies the change to its own backtracker on its next call.
+ *
+ * @param safe_bt The thread-safe backtracker
+ * @param max_depth The new maximum depth
+ * @return true if successful, false otherwise
+ */
+bool rift_safe_backtracker_set_max_depth(rift_regex_safe_backtracker_t *safe_bt,
+                                         uint32_t max_depth);
+
+/**
+ * @brief Free resources associated with a thread-safe backtracker
+ *
+ * @param safe_bt The thread-safe backtracker to free
+ */
+void rift_safe_backtracker_free(rift_regex_safe_backtracker_t *safe_bt);
 
 #ifdef __cplusplus
 }
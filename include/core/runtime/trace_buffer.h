@@ -0,0 +1,212 @@
+/**
+ * @file trace_buffer.h
+ * @brief Lock-free ring buffer of match trace records
+ *
+ * The backtracking matcher and the bytecode VM can record what a search did
+ * into a trace buffer: where it was (an automaton state or a bytecode
+ * instruction), at which input position, and what happened there. Records
+ * are packed into one 64-bit word each and the buffer keeps the latest of
+ * them, overwriting the oldest, so a buffer can stay attached to a matcher
+ * for a whole run and still hold the end of the slowest search.
+ *
+ * One thread records into a buffer at a time; any thread may take a
+ * snapshot meanwhile without stopping it. Recording is two counter stores
+ * and a record store, with no lock and no allocation, and an engine without
+ * a buffer tests one pointer on the paths it records.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#ifndef LIBRIFT_RUNTIME_TRACE_BUFFER_H
+#define LIBRIFT_RUNTIME_TRACE_BUFFER_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Records a buffer holds when none is given */
+#define RIFT_TRACE_BUFFER_DEFAULT_CAPACITY 65536
+
+/* Largest location a record holds; larger ones are stored as this */
+#define RIFT_TRACE_LOCATION_MAX 0x0FFFFFFFu
+
+/* Location of records made where there is no state or instruction to name */
+#define RIFT_TRACE_NO_LOCATION RIFT_TRACE_LOCATION_MAX
+
+/**
+ * @brief What happened at a traced location
+ */
+typedef enum rift_trace_event {
+    RIFT_TRACE_EVENT_START = 0,  /**< An attempt started */
+    RIFT_TRACE_EVENT_STEP,       /**< Input was consumed leaving the location */
+    RIFT_TRACE_EVENT_FAIL,       /**< The location rejected the input */
+    RIFT_TRACE_EVENT_BACKTRACK,  /**< A backtrack point resumed at the location */
+    RIFT_TRACE_EVENT_MATCH,      /**< The location accepted */
+    RIFT_TRACE_EVENT_COUNT       /**< Number of events */
+} rift_trace_event_t;
+
+/* Mask of every event, the events a new buffer records */
+#define RIFT_TRACE_EVENTS_ALL ((1u << RIFT_TRACE_EVENT_COUNT) - 1)
+
+/**
+ * @brief One trace record, unpacked
+ */
+typedef struct rift_trace_record {
+    uint32_t location;        /**< State ID or instruction index */
+    uint32_t position;        /**< Input position, saturated at UINT32_MAX */
+    rift_trace_event_t event; /**< What happened */
+} rift_trace_record_t;
+
+/**
+ * @brief Trace records aggregated over one location
+ */
+typedef struct rift_trace_hotspot {
+    uint32_t location;   /**< State ID or instruction index */
+    uint64_t records;    /**< Records at the location */
+    uint64_t backtracks; /**< Backtrack points resumed there */
+    uint64_t failures;   /**< Times the location rejected the input */
+} rift_trace_hotspot_t;
+
+/**
+ * @brief Ring buffer of packed trace records
+ *
+ * Record i lives in slot i & mask. claimed is raised before a slot is
+ * overwritten and published after the record is in place, so a reader
+ * knows which of the records it copied were complete and not yet
+ * overwritten.
+ */
+typedef struct rift_trace_buffer {
+    _Atomic uint64_t *slots;    /**< Packed records */
+    size_t mask;                /**< Slots minus one, slots being a power of two */
+    _Atomic uint64_t claimed;   /**< Records being written or written */
+    _Atomic uint64_t published; /**< Records written */
+    uint32_t events;            /**< Mask of the events recorded */
+} rift_trace_buffer_t;
+
+/**
+ * @brief Create a trace buffer
+ *
+ * @param capacity Records kept, rounded up to a power of two, 0 for the default
+ * @return A new buffer or NULL on allocation failure
+ */
+rift_trace_buffer_t *rift_trace_buffer_create(size_t capacity);
+
+/**
+ * @brief Free a trace buffer
+ *
+ * @param buffer The buffer (can be NULL)
+ */
+void rift_trace_buffer_free(rift_trace_buffer_t *buffer);
+
+/**
+ * @brief Choose the events recorded
+ *
+ * Recording only backtracks, for instance, keeps the hotspots while the
+ * buffer covers many more searches.
+ *
+ * @param buffer The buffer
+ * @param events Mask of (1u << event) bits
+ */
+void rift_trace_buffer_set_events(rift_trace_buffer_t *buffer, uint32_t events);
+
+/**
+ * @brief Drop every record
+ *
+ * Must not run while a thread records into the buffer.
+ *
+ * @param buffer The buffer
+ */
+void rift_trace_buffer_clear(rift_trace_buffer_t *buffer);
+
+/**
+ * @brief Get the number of records kept
+ *
+ * @param buffer The buffer
+ * @return The capacity in records, 0 for NULL
+ */
+size_t rift_trace_buffer_get_capacity(const rift_trace_buffer_t *buffer);
+
+/**
+ * @brief Get the number of records made since the buffer was created or cleared
+ *
+ * Records past the capacity have overwritten older ones.
+ *
+ * @param buffer The buffer
+ * @return The number of records, 0 for NULL
+ */
+uint64_t rift_trace_buffer_get_total(const rift_trace_buffer_t *buffer);
+
+/**
+ * @brief Record an event
+ *
+ * @param buffer The buffer
+ * @param event What happened
+ * @param location State ID or instruction index
+ * @param position Input position
+ */
+static inline void
+rift_trace_buffer_record(rift_trace_buffer_t *buffer, rift_trace_event_t event, size_t location,
+                         size_t position)
+{
+    if (!(buffer->events & (1u << event))) {
+        return;
+    }
+
+    uint64_t word = ((uint64_t)(position < UINT32_MAX ? position : UINT32_MAX) << 32) |
+                    ((uint64_t)event << 28) |
+                    (location < RIFT_TRACE_LOCATION_MAX ? location : RIFT_TRACE_LOCATION_MAX);
+    uint64_t index = atomic_load_explicit(&buffer->published, memory_order_relaxed);
+    atomic_store_explicit(&buffer->claimed, index + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&buffer->slots[index & buffer->mask], word, memory_order_relaxed);
+    atomic_store_explicit(&buffer->published, index + 1, memory_order_release);
+}
+
+/**
+ * @brief Copy the latest records, oldest first
+ *
+ * Safe while another thread records: records overwritten during the copy
+ * are left out, so fewer than the capacity may come back.
+ *
+ * @param buffer The buffer
+ * @param records Where the records go
+ * @param max_records Room in records
+ * @return The number of records copied
+ */
+size_t rift_trace_buffer_snapshot(const rift_trace_buffer_t *buffer, rift_trace_record_t *records,
+                                  size_t max_records);
+
+/**
+ * @brief Rank the locations of records by the backtracking they saw
+ *
+ * Locations are ordered by backtracks, then failures, then records, the
+ * most first.
+ *
+ * @param records The records
+ * @param count Number of records
+ * @param hotspots Where the hottest locations go
+ * @param max_hotspots Room in hotspots
+ * @return The number of hotspots written, 0 on allocation failure
+ */
+size_t rift_trace_find_hotspots(const rift_trace_record_t *records, size_t count,
+                                rift_trace_hotspot_t *hotspots, size_t max_hotspots);
+
+/**
+ * @brief Get the name of an event
+ *
+ * @param event The event
+ * @return A lowercase name, "unknown" for an invalid event
+ */
+const char *rift_trace_event_name(rift_trace_event_t event);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_RUNTIME_TRACE_BUFFER_H */
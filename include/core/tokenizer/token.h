@@ -25,13 +25,17 @@ extern "C" {
 
 /**
  * @brief Token structure for regular expressions
+ *
+ * Values of tokens from a tokenizer are not allocated per token: values of
+ * one character are interned and longer ones point into a copy of the
+ * input the tokenizer owns. start and end delimit the token in the input.
  */
 typedef struct {
     rift_regex_token_type_t type; /**< Token type */
     char *value;                  /**< Token value */
     size_t position;              /**< Position in the input */
-    size_t start;                 /**< Start position of the token */
-    size_t end;                   /**< End position of the token */
+    size_t start;                 /**< Offset of the first byte of the token in the input */
+    size_t end;                   /**< Offset one past the last byte of the token */
 } rift_regex_token_t;
 /**
 
@@ -80,6 +84,47 @@ rift_regex_token_t rift_regex_token_create_end(size_t position);
  */
 rift_regex_token_t rift_regex_token_copy(const rift_regex_token_t *token);
 
+/**
+ * @brief Get the interned value of a one-character token
+ *
+ * The value is a static string; it is never freed and must not be written.
+ *
+ * @param c The character
+ * @return The NUL-terminated string holding c
+ */
+const char *rift_regex_token_intern_char(char c);
+
+/**
+ * @brief Check if a token value is interned
+ *
+ * @param value The value (can be NULL)
+ * @return true if the value comes from rift_regex_token_intern_char, false otherwise
+ */
+bool rift_regex_token_value_is_interned(const char *value);
+
+/**
+ * @brief Get the type of the token a byte starts
+ *
+ * Plain literal bytes map to RIFT_REGEX_TOKEN_LITERAL. Bytes that may start
+ * a longer token ('(', '[', '\\') map to the type of the bare delimiter.
+ *
+ * @param c The byte
+ * @return The token type
+ */
+rift_regex_token_type_t rift_regex_token_byte_type(char c);
+
+/**
+ * @brief Get the length of the run of plain literal bytes at the start of the input
+ *
+ * When the byte after the run is a quantifier, the run leaves out its last
+ * byte, as the quantifier applies to that byte alone.
+ *
+ * @param input The input
+ * @param length Length of the input
+ * @return Length of the run, 0 if the input does not start with a plain literal
+ */
+size_t rift_regex_token_literal_run(const char *input, size_t length);
+
 /**
  * @brief Free resources associated with a token
  *
@@ -22,10 +22,11 @@ extern "C" {
  * @brief Token types for regular expressions
  */
 typedef enum rift_regex_token_type {
-    RIFT_REGEX_TOKEN_LITERAL, /**< Literal character */
-    RIFT_REGEX_TOKEN_DOT,     /**< Dot (any character) */
-    RIFT_REGEX_TOKEN_CARET,   /**< Caret (start anchor) */
-    RIFT_REGEX_TOKEN_DOLLAR,  /**< Dollar (end anchor) */
+    RIFT_REGEX_TOKEN_LITERAL,     /**< Literal character */
+    RIFT_REGEX_TOKEN_LITERAL_RUN, /**< Run of literal characters */
+    RIFT_REGEX_TOKEN_DOT,         /**< Dot (any character) */
+    RIFT_REGEX_TOKEN_CARET,       /**< Caret (start anchor) */
+    RIFT_REGEX_TOKEN_DOLLAR,      /**< Dollar (end anchor) */
 
     /* Quantifiers */
     RIFT_REGEX_TOKEN_STAR,     /**< Star (0 or more) */
@@ -30,6 +30,9 @@ extern "C" {
  */
 typedef struct rift_regex_tokenizer rift_regex_tokenizer_t;
 
+/* Forward declaration for the arena type of core/memory/memory.h */
+struct rift_arena;
+
 /**
  * @brief Create a new tokenizer
  *
@@ -38,6 +41,20 @@ typedef struct rift_regex_tokenizer rift_regex_tokenizer_t;
  */
 rift_regex_tokenizer_t *rift_regex_tokenizer_create(const char *input);
 
+/**
+ * @brief Create a new tokenizer whose token values live in an arena
+ *
+ * Token values go with the arena instead of with the next token, so they
+ * stay valid for the whole compilation; they must not be passed to
+ * rift_regex_token_free.
+ *
+ * @param input The input string to tokenize
+ * @param arena Arena for the token values, NULL to allocate them on the heap
+ * @return A new tokenizer or NULL on failure
+ */
+rift_regex_tokenizer_t *rift_regex_tokenizer_create_in_arena(const char *input,
+                                                             struct rift_arena *arena);
+
 /**
  * @brief Create a new tokenizer with a specific length
  *
@@ -47,6 +64,20 @@ rift_regex_tokenizer_t *rift_regex_tokenizer_create(const char *input);
  */
 rift_regex_tokenizer_t *rift_regex_tokenizer_create_with_length(const char *input, size_t length);
 
+/**
+ * @brief Create a tokenizer that reports token spans without values
+ *
+ * The input is read in place and need not be NUL-terminated, so it can be
+ * a memory-mapped file of any size. Nothing is copied: values of one
+ * character are still interned, but longer tokens have a NULL value and
+ * are read from the input through their start and end offsets.
+ *
+ * @param input The input to tokenize, which must outlive the tokenizer
+ * @param length The length of the input
+ * @return A new tokenizer or NULL on failure
+ */
+rift_regex_tokenizer_t *rift_regex_tokenizer_create_spans(const char *input, size_t length);
+
 /**
  * @brief Free resources associated with a tokenizer
  *
@@ -0,0 +1,126 @@
+/**
+ * @file handle_table.h
+ * @brief Generational handle tables for the objects the web bridge hands out
+ *
+ * This file defines a dense slot array that maps 32-bit handles to objects.
+ * A handle holds the index of its slot and the generation the slot had when
+ * the handle was issued; freeing a slot bumps its generation, so handles to
+ * freed objects are recognized as stale even after the slot is reused.
+ * Lookups, insertions and removals take constant time, free slots being
+ * chained through the slots themselves.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+#ifndef LIBRIFT_WEBBRIDGE_HANDLE_TABLE_H
+#define LIBRIFT_WEBBRIDGE_HANDLE_TABLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Bits of a handle holding the slot index, the rest hold the generation
+ */
+#define RIFT_HANDLE_INDEX_BITS 20
+
+/**
+ * @brief Largest number of slots a table can have
+ */
+#define RIFT_HANDLE_MAX_SLOTS ((uint32_t)1 << RIFT_HANDLE_INDEX_BITS)
+
+/**
+ * @brief Handle that never refers to an object
+ */
+#define RIFT_HANDLE_INVALID 0u
+
+/**
+ * @brief Table of objects addressed by generational handles (opaque)
+ */
+typedef struct rift_handle_table rift_handle_table_t;
+
+/**
+ * @brief Decide whether an object is removed by rift_handle_table_remove_each
+ *
+ * @param object The object
+ * @param context Context passed to rift_handle_table_remove_each
+ * @return true to remove the object
+ */
+typedef bool (*rift_handle_visit_fn)(void *object, void *context);
+
+/**
+ * @brief Create an empty handle table
+ *
+ * @param initial_capacity Number of slots to allocate up front (0 for a default)
+ * @return A new table or NULL on allocation failure
+ */
+rift_handle_table_t *rift_handle_table_create(uint32_t initial_capacity);
+
+/**
+ * @brief Free a handle table
+ *
+ * The objects are not freed; remove them first with rift_handle_table_remove_each.
+ *
+ * @param table The table to free (can be NULL)
+ */
+void rift_handle_table_free(rift_handle_table_t *table);
+
+/**
+ * @brief Store an object and issue a handle for it
+ *
+ * @param table The table
+ * @param object The object, not NULL
+ * @return The handle or RIFT_HANDLE_INVALID on invalid parameters, allocation
+ *         failure or when every slot is in use
+ */
+uint32_t rift_handle_table_insert(rift_handle_table_t *table, void *object);
+
+/**
+ * @brief Look up the object of a handle
+ *
+ * @param table The table
+ * @param handle The handle
+ * @return The object or NULL if the handle is invalid or stale
+ */
+void *rift_handle_table_get(const rift_handle_table_t *table, uint32_t handle);
+
+/**
+ * @brief Remove the object of a handle, making every copy of the handle stale
+ *
+ * @param table The table
+ * @param handle The handle
+ * @return The removed object or NULL if the handle is invalid or stale
+ */
+void *rift_handle_table_remove(rift_handle_table_t *table, uint32_t handle);
+
+/**
+ * @brief Remove every object a visitor selects
+ *
+ * The visitor sees each stored object once and may free the ones it
+ * selects, which are removed from the table as it returns.
+ *
+ * @param table The table
+ * @param visit Visitor returning true for the objects to remove
+ * @param context Context passed to the visitor
+ * @return Number of objects removed
+ */
+size_t rift_handle_table_remove_each(rift_handle_table_t *table, rift_handle_visit_fn visit,
+                                     void *context);
+
+/**
+ * @brief Get the number of objects in a table
+ *
+ * @param table The table
+ * @return Number of objects, 0 for NULL
+ */
+size_t rift_handle_table_count(const rift_handle_table_t *table);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBRIFT_WEBBRIDGE_HANDLE_TABLE_H */
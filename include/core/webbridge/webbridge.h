@@ -11,8 +11,11 @@
 
 #include <stdint.h>
 #include <stdlib.h>
-#include "core/bytecode.h"
+#include "core/bytecode/bytecode.h"
+#include "core/webbridge/handle_table.h"
+#ifdef __EMSCRIPTEN__
 #include <emscripten.h>
+#endif
 #ifndef LIBRIFT_WEBBRIDGE_H
 #define LIBRIFT_WEBBRIDGE_H
 
@@ -25,20 +28,51 @@
 #define RIFT_EXPORT
 #endif
 
+/**
+ * @brief Words at the start of a batch span array, before the first match
+ *
+ * Word 0 holds the spans per match (capture groups plus one) and word 1 is
+ * 1 when matches were left out for lack of room, 0 otherwise.
+ */
+#define RIFT_WEBBRIDGE_BATCH_HEADER_WORDS 2
+
+/**
+ * @brief Start and end written for a capture group that did not participate
+ */
+#define RIFT_WEBBRIDGE_BATCH_UNSET UINT32_MAX
+
 /**
  * @brief Handle representing a compiled pattern
  *
- * Opaque handle used to reference a pattern across the WebBridge
+ * Opaque handle used to reference a pattern across the WebBridge. Handles
+ * come from a generational rift_handle_table_t, so a handle to a freed
+ * pattern stays invalid even after its slot is reused.
  */
 typedef uint32_t rift_pattern_handle_t;
 
 /**
  * @brief Handle representing a matcher instance
  *
- * Opaque handle used to reference a matcher across the WebBridge
+ * Opaque handle used to reference a matcher across the WebBridge. Handles
+ * come from a generational rift_handle_table_t, so a handle to a freed
+ * matcher stays invalid even after its slot is reused.
  */
 typedef uint32_t rift_matcher_handle_t;
 
+/**
+ * @brief Handle representing a set of precompiled patterns
+ *
+ * Opaque handle used to reference a loaded bundle across the WebBridge
+ */
+typedef uint32_t rift_pattern_set_handle_t;
+
+/**
+ * @brief Handle representing a pool of matching workers
+ *
+ * Opaque handle used to reference a worker pool across the WebBridge
+ */
+typedef uint32_t rift_pool_handle_t;
+
 /**
  * @brief Initialize the WebBridge
  *
@@ -72,6 +106,8 @@ RIFT_EXPORT uint32_t rift_webbridge_get_last_error(char *buffer, uint32_t buffer
 /**
  * @brief Free a compiled pattern
  *
+ * The matchers created for the pattern are freed with it.
+ *
  * @param handle Handle to the pattern
  */
 RIFT_EXPORT void rift_webbridge_free_pattern(rift_pattern_handle_t handle);
@@ -89,6 +125,9 @@ rift_webbridge_create_matcher(rift_pattern_handle_t pattern_handle, uint32_t opt
 /**
  * @brief Set input for a matcher
  *
+ * The input is copied into the matcher's input buffer, so the caller may
+ * release it once the call returns.
+ *
  * @param matcher_handle Handle to the matcher
  * @param input Input string
  * @param length Length of input or -1 to use strlen
@@ -97,6 +136,38 @@ rift_webbridge_create_matcher(rift_pattern_handle_t pattern_handle, uint32_t opt
 RIFT_EXPORT int rift_webbridge_set_input(rift_matcher_handle_t matcher_handle, const char *input,
                                          int32_t length);
 
+/**
+ * @brief Get the matcher's own input buffer, growing it if needed
+ *
+ * JavaScript writes the input straight into this buffer, for instance with
+ * TextEncoder.encodeInto over a view of Wasm memory, then calls
+ * rift_webbridge_set_input_length. The buffer is reused across inputs and
+ * only reallocated when a larger capacity is asked for, so re-matching an
+ * edited text allocates nothing. Growing may move the buffer: views taken
+ * before this call must be recreated from the returned pointer.
+ *
+ * @param matcher_handle Handle to the matcher
+ * @param capacity Number of bytes the buffer must hold
+ * @return The buffer, valid until the next call, rift_webbridge_set_input or
+ *         rift_webbridge_free_matcher, or NULL on failure
+ */
+RIFT_EXPORT uint8_t *rift_webbridge_get_input_buffer(rift_matcher_handle_t matcher_handle,
+                                                     uint32_t capacity);
+
+/**
+ * @brief Use the first bytes of the matcher's input buffer as its input
+ *
+ * Works like rift_webbridge_set_input without copying: matching reads the
+ * buffer in place, so it must not be written again until the matcher is
+ * done with this input.
+ *
+ * @param matcher_handle Handle to the matcher
+ * @param length Number of bytes written to the input buffer
+ * @return 1 if successful, 0 if the length exceeds the buffer's capacity
+ */
+RIFT_EXPORT int rift_webbridge_set_input_length(rift_matcher_handle_t matcher_handle,
+                                                uint32_t length);
+
 /**
  * @brief Check if input matches pattern
  *
@@ -141,6 +212,88 @@ RIFT_EXPORT int rift_webbridge_get_named_group(rift_matcher_handle_t matcher_han
                                                const char *name, uint32_t *start_pos,
                                                uint32_t *end_pos);
 
+/**
+ * @brief Find every match of an input in one call
+ *
+ * Replaces a loop of rift_webbridge_set_input, rift_webbridge_find_next and
+ * rift_webbridge_get_group, which crosses the JavaScript boundary once per
+ * call, with a single crossing. The input and the span array both live in
+ * Wasm memory, so JavaScript reads the results through a Uint32Array view
+ * without copying strings.
+ *
+ * After the RIFT_WEBBRIDGE_BATCH_HEADER_WORDS header, each match takes
+ * two words per span, start then end, for the whole match followed by each
+ * capture group in order. Groups that did not participate are written as
+ * RIFT_WEBBRIDGE_BATCH_UNSET. Empty matches advance by one byte, as with
+ * rift_webbridge_find_next. The input replaces the matcher's current input;
+ * passing the matcher's input buffer matches it in place without a copy.
+ *
+ * @param matcher_handle Handle to the matcher
+ * @param input Input bytes in Wasm memory
+ * @param length Length of input or -1 to use strlen
+ * @param spans Span array in Wasm memory
+ * @param max_words Number of uint32_t words in spans
+ * @return Number of matches written, 0 on failure or when nothing matched
+ */
+RIFT_EXPORT uint32_t rift_webbridge_find_all_batch(rift_matcher_handle_t matcher_handle,
+                                                   const char *input, int32_t length,
+                                                   uint32_t *spans, uint32_t max_words);
+
+/**
+ * @brief Start matching a stream of chunks
+ *
+ * Lets JavaScript match the chunks of a ReadableStream as they arrive,
+ * without buffering the whole body in Wasm memory first. The stream runs
+ * on the matcher's rift_matcher_feed, so it finds the same matches as
+ * matching the concatenated chunks, including matches that cross chunk
+ * boundaries, and keeps only the bytes a pending match may start in.
+ * Patterns with backreferences cannot be streamed. Starting a stream drops
+ * any stream in progress.
+ *
+ * @param matcher_handle Handle to the matcher
+ * @return 1 if successful, 0 for an invalid handle or a pattern that cannot
+ *         be streamed
+ */
+RIFT_EXPORT int rift_webbridge_stream_begin(rift_matcher_handle_t matcher_handle);
+
+/**
+ * @brief Match the next chunk of a stream
+ *
+ * Writes the matches the chunk completes to spans, in the layout of
+ * rift_webbridge_find_all_batch with one span per match: streamed matches
+ * carry the full match only. Offsets are absolute, counted from the first
+ * byte of the stream. Matches that do not fit are kept, the overflow word
+ * is set, and they are written first by the next feed or end call. The
+ * chunk is not referenced once the call returns, so JavaScript can reuse
+ * its buffer for the next chunk.
+ *
+ * @param matcher_handle Handle to the matcher
+ * @param chunk Chunk bytes in Wasm memory (can be NULL if length is 0)
+ * @param length Length of chunk
+ * @param spans Span array in Wasm memory
+ * @param max_words Number of uint32_t words in spans
+ * @return Number of matches written, 0 on failure or when none completed
+ */
+RIFT_EXPORT uint32_t rift_webbridge_stream_feed(rift_matcher_handle_t matcher_handle,
+                                                const char *chunk, int32_t length,
+                                                uint32_t *spans, uint32_t max_words);
+
+/**
+ * @brief End a stream and collect its last matches
+ *
+ * Writes the matches that were waiting for more input, in the layout of
+ * rift_webbridge_stream_feed. The stream ends once every match has been
+ * written; while the overflow word is set, call again with room for more.
+ * The next stream starts over at offset 0.
+ *
+ * @param matcher_handle Handle to the matcher
+ * @param spans Span array in Wasm memory
+ * @param max_words Number of uint32_t words in spans
+ * @return Number of matches written, 0 on failure or when none were left
+ */
+RIFT_EXPORT uint32_t rift_webbridge_stream_end(rift_matcher_handle_t matcher_handle,
+                                               uint32_t *spans, uint32_t max_words);
+
 /**
  * @brief Free a matcher
  *
@@ -148,6 +301,74 @@ RIFT_EXPORT int rift_webbridge_get_named_group(rift_matcher_handle_t matcher_han
  */
 RIFT_EXPORT void rift_webbridge_free_matcher(rift_matcher_handle_t matcher_handle);
 
+/**
+ * @brief Free many matchers in one call
+ *
+ * Stale and invalid handles are skipped.
+ *
+ * @param matcher_handles Handles to the matchers, in Wasm memory
+ * @param count Number of handles
+ * @return Number of matchers freed
+ */
+RIFT_EXPORT uint32_t rift_webbridge_free_matchers(const rift_matcher_handle_t *matcher_handles,
+                                                  uint32_t count);
+
+/**
+ * @brief Free every matcher created for a pattern
+ *
+ * @param pattern_handle Handle to the pattern
+ * @return Number of matchers freed
+ */
+RIFT_EXPORT uint32_t rift_webbridge_free_pattern_matchers(rift_pattern_handle_t pattern_handle);
+
+/**
+ * @brief Create a pool of workers that match one pattern
+ *
+ * Available in builds with Emscripten pthreads, where each worker thread is
+ * a Web Worker sharing the Wasm memory through a SharedArrayBuffer. The
+ * workers run the compiled pattern in place, as matching only reads it, so
+ * it is neither copied nor serialized per worker. The pattern must outlive
+ * the pool.
+ *
+ * @param pattern_handle Handle to the compiled pattern
+ * @param num_workers Number of workers, 0 for navigator.hardwareConcurrency
+ * @return Handle to the pool or 0 on failure, including builds without pthreads
+ */
+RIFT_EXPORT rift_pool_handle_t rift_webbridge_create_pool(rift_pattern_handle_t pattern_handle,
+                                                         uint32_t num_workers);
+
+/**
+ * @brief Find every match of many inputs, split across the workers of a pool
+ *
+ * Input i is the bytes from offsets[i] to offsets[i + 1] of inputs, so
+ * offsets has count + 1 entries. Results are written in input order: for
+ * each input, its match count, then its matches in the span layout of
+ * rift_webbridge_find_all_batch. The RIFT_WEBBRIDGE_BATCH_HEADER_WORDS header
+ * comes once, at the start of spans.
+ *
+ * The call blocks until the workers are done, and browsers forbid blocking
+ * the main thread, so it must be made from a worker of its own.
+ *
+ * @param pool_handle Handle to the pool
+ * @param inputs Input bytes in shared Wasm memory
+ * @param offsets Start of each input, then the end of the last one
+ * @param count Number of inputs
+ * @param spans Span array in shared Wasm memory
+ * @param max_words Number of uint32_t words in spans
+ * @return Number of inputs whose results fit, 0 on failure
+ */
+RIFT_EXPORT uint32_t rift_webbridge_pool_find_all_batch(rift_pool_handle_t pool_handle,
+                                                        const char *inputs,
+                                                        const uint32_t *offsets, uint32_t count,
+                                                        uint32_t *spans, uint32_t max_words);
+
+/**
+ * @brief Stop the workers of a pool and free it
+ *
+ * @param pool_handle Handle to the pool
+ */
+RIFT_EXPORT void rift_webbridge_free_pool(rift_pool_handle_t pool_handle);
+
 /**
  * @brief Serialize a compiled pattern to bytecode
  *
@@ -169,6 +390,52 @@ RIFT_EXPORT uint32_t rift_webbridge_serialize_pattern(rift_pattern_handle_t patt
 RIFT_EXPORT rift_pattern_handle_t rift_webbridge_deserialize_pattern(const uint8_t *buffer,
                                                                      uint32_t buffer_size);
 
+/**
+ * @brief Load a precompiled ruleset in one call
+ *
+ * The buffer holds a DSL compilation written by rift_dsl_serialize_container,
+ * typically fetched as a single asset, so no pattern is compiled on the
+ * client. It is opened with rift_dsl_load_container and its programs run
+ * from the buffer in place: the buffer must stay in Wasm memory, unchanged,
+ * until the set is freed.
+ *
+ * @param buffer Container bytes in Wasm memory, aligned to 8 bytes
+ * @param buffer_size Size of buffer
+ * @return Handle to the pattern set or 0 on failure, with the reason in
+ *         rift_webbridge_get_last_error
+ */
+RIFT_EXPORT rift_pattern_set_handle_t rift_webbridge_load_bundle(const uint8_t *buffer,
+                                                                 uint32_t buffer_size);
+
+/**
+ * @brief Get the number of patterns in a loaded bundle
+ *
+ * @param set_handle Handle to the pattern set
+ * @return Number of patterns, 0 for an invalid handle
+ */
+RIFT_EXPORT uint32_t rift_webbridge_bundle_count(rift_pattern_set_handle_t set_handle);
+
+/**
+ * @brief Check whether a pattern of a loaded bundle matches an input
+ *
+ * @param set_handle Handle to the pattern set
+ * @param index Index of the pattern, in the order of the ruleset
+ * @param input Input bytes in Wasm memory
+ * @param length Length of input or -1 to use strlen
+ * @return 1 if the pattern matches, 0 otherwise
+ */
+RIFT_EXPORT int rift_webbridge_bundle_matches(rift_pattern_set_handle_t set_handle,
+                                              uint32_t index, const char *input, int32_t length);
+
+/**
+ * @brief Free a loaded bundle
+ *
+ * The caller may release the bundle's buffer afterwards.
+ *
+ * @param set_handle Handle to the pattern set
+ */
+RIFT_EXPORT void rift_webbridge_free_bundle(rift_pattern_set_handle_t set_handle);
+
 /**
  * @brief Run a bytecode program directly
  *
@@ -1,26 +0,0 @@
-/**
- * @file backtracker.h
- * @brief Header file for the backtracker module
- *
- * @copyright Copyright (c) 2025 LibRift Project
- * @license MIT License
- */
-
-#include <stddef.h>
-#include <stdbool.h>
-#include <stdint.h>
-#ifndef RUNTIME_BACKTRACKER_H
-#define RUNTIME_BACKTRACKER_H
-
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-/* Forward declarations and function prototypes */
-
-#ifdef __cplusplus
-}
-#endif
-
-#endif /* RUNTIME_BACKTRACKER_H */
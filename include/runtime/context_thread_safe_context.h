@@ -2,6 +2,12 @@
  * @file context_thread_safe_context.h
  * @brief Header file for the context_thread_safe_context module
  *
+ * A thread-safe context shares one compiled automaton between threads. Each
+ * thread matches with its own matcher context, kept in a small thread-local
+ * cache that is sharded by context id, so the match path takes no locks:
+ * the reference count and the reset generation are atomics, and the input
+ * is passed with every call instead of being stored in the shared context.
+ *
  * @copyright Copyright (c) 2025 LibRift Project
  * @license MIT License
  */
@@ -9,6 +15,12 @@
 #include <stddef.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "core/automaton/automaton.h"
+#include "core/errors/regex_error.h"
+#include "core/runtime/context.h"
+#include "core/runtime/match_types.h"
 #ifndef RUNTIME_CONTEXT_THREAD_SAFE_CONTEXT_H
 #define RUNTIME_CONTEXT_THREAD_SAFE_CONTEXT_H
 
@@ -17,7 +29,159 @@
 extern "C" {
 #endif
 
-/* Forward declarations and function prototypes */
+/**
+ * @brief Number of thread-safe contexts a thread caches a matcher context for
+ *
+ * A context is cached in the slot its id selects; a thread that alternates
+ * between more contexts than this recreates matcher contexts on collisions.
+ */
+#ifndef RIFT_THREAD_SAFE_CONTEXT_CACHE_SLOTS
+#define RIFT_THREAD_SAFE_CONTEXT_CACHE_SLOTS 16
+#endif
+
+/**
+ * @brief Automaton shared by threads that each match with their own context
+ */
+typedef struct rift_regex_thread_safe_context {
+    rift_regex_automaton_t *automaton; /**< The shared automaton */
+    size_t max_capture_groups;         /**< Capture groups of the threads' contexts */
+    uint32_t max_backtrack_depth;      /**< Maximum backtracking depth */
+    uint64_t id;                       /**< Unique id, never reused by another context */
+    atomic_size_t ref_count;           /**< References held */
+    atomic_uint_fast64_t generation;   /**< Bumped to reset every thread's context */
+    bool initialized;                  /**< Whether creation completed */
+    rift_regex_error_t error;          /**< Last error */
+    pthread_mutex_t mutex;             /**< Only for rift_thread_safe_context_lock */
+} rift_regex_thread_safe_context_t;
+
+/**
+ * @brief Create a new thread-safe context
+ *
+ * @param automaton The automaton to associate with the context
+ * @param max_capture_groups Maximum number of capture groups to support
+ * @param max_backtrack_depth Maximum backtracking depth
+ * @return Pointer to the new thread-safe context or NULL on failure
+ */
+rift_regex_thread_safe_context_t *
+rift_thread_safe_context_create(rift_regex_automaton_t *automaton, size_t max_capture_groups,
+                                uint32_t max_backtrack_depth);
+
+/**
+ * @brief Get the calling thread's matcher context
+ *
+ * The context is created on the thread's first call and reset when
+ * rift_thread_safe_context_reset_all was called since its last one. It is
+ * freed when the thread exits or when another thread-safe context takes its
+ * cache slot, so it must not be kept across calls.
+ *
+ * @param ts_context The thread-safe context
+ * @return Pointer to the thread-local matcher context or NULL on failure
+ */
+rift_regex_matcher_context_t *
+rift_thread_safe_context_get_local(rift_regex_thread_safe_context_t *ts_context);
+
+/**
+ * @brief Match an input against the automaton with the calling thread's state
+ *
+ * The input is only bound for the duration of the call, so any number of
+ * threads can match their own inputs at once without locking. Each thread
+ * builds its own Pike VM over the automaton on its first match. Only the
+ * bounds of the leftmost match are reported; the groups of the match are
+ * left empty.
+ *
+ * @param ts_context The thread-safe context
+ * @param input The input to match
+ * @param input_length Length of the input or (size_t)-1 to use strlen
+ * @param match Pointer to store the match (can be NULL)
+ * @return true if the automaton matched the input, false otherwise or on failure
+ */
+bool rift_thread_safe_context_match(rift_regex_thread_safe_context_t *ts_context,
+                                    const char *input, size_t input_length,
+                                    rift_regex_match_t *match);
+
+/**
+ * @brief Execute a function on an input with the calling thread's matcher context
+ *
+ * @param ts_context The thread-safe context
+ * @param input The input to match
+ * @param input_length Length of the input or (size_t)-1 to use strlen
+ * @param callback Function to call with the thread-local context
+ * @param user_data User-defined data to pass to the callback
+ * @param error Pointer to store error information (can be NULL)
+ * @return The return value from the callback, or false on error
+ */
+bool rift_thread_safe_context_execute(rift_regex_thread_safe_context_t *ts_context,
+                                      const char *input, size_t input_length,
+                                      bool (*callback)(rift_regex_matcher_context_t *, void *,
+                                                       rift_regex_error_t *),
+                                      void *user_data, rift_regex_error_t *error);
+
+/**
+ * @brief Set the input of the calling thread's matcher context
+ *
+ * Other threads keep their own inputs.
+ *
+ * @param ts_context The thread-safe context
+ * @param input The input string to set
+ * @param input_length Length of the input string or (size_t)-1 to use strlen
+ * @return true if successful, false otherwise
+ */
+bool rift_thread_safe_context_set_input(rift_regex_thread_safe_context_t *ts_context,
+                                        const char *input, size_t input_length);
+
+/**
+ * @brief Free resources associated with a thread-safe context
+ *
+ * Matcher contexts other threads cached for it are freed when those threads
+ * exit or reuse the slot.
+ *
+ * @param ts_context The thread-safe context to free
+ */
+void rift_thread_safe_context_free(rift_regex_thread_safe_context_t *ts_context);
+
+/**
+ * @brief Increment the reference count for a thread-safe context
+ *
+ * @param ts_context The thread-safe context
+ * @return The new reference count
+ */
+size_t rift_thread_safe_context_ref(rift_regex_thread_safe_context_t *ts_context);
+
+/**
+ * @brief Decrement the reference count for a thread-safe context
+ *
+ * @param ts_context The thread-safe context
+ * @return The new reference count or (size_t)-1 if the context was freed
+ */
+size_t rift_thread_safe_context_unref(rift_regex_thread_safe_context_t *ts_context);
+
+/**
+ * @brief Reset all thread-local contexts
+ *
+ * Each thread resets its context on its next call.
+ *
+ * @param ts_context The thread-safe context
+ * @return true if successful, false otherwise
+ */
+bool rift_thread_safe_context_reset_all(rift_regex_thread_safe_context_t *ts_context);
+
+/**
+ * @brief Lock the thread-safe context for exclusive access
+ *
+ * Matching never takes this lock; it only serializes callers that use it.
+ *
+ * @param ts_context The thread-safe context
+ * @return true if successful, false otherwise
+ */
+bool rift_thread_safe_context_lock(rift_regex_thread_safe_context_t *ts_context);
+
+/**
+ * @brief Unlock the thread-safe context
+ *
+ * @param ts_context The thread-safe context
+ * @return true if successful, false otherwise
+ */
+bool rift_thread_safe_context_unlock(rift_regex_thread_safe_context_t *ts_context);
 
 #ifdef __cplusplus
 }
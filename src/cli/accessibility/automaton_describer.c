@@ -0,0 +1,546 @@
+/**
+ * @file automaton_describer.c
+ * @brief Implementation of the lazy automaton describer
+ *
+ * Descriptions live in an open addressing table keyed by state address.
+ * An entry exists only for a state described since its last change.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "cli/accessibility/automaton_describer.h"
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "core/automaton/state.h"
+#include "core/automaton/transition.h"
+#include "core/memory/memory.h"
+
+/** Key of a table slot whose entry was removed */
+#define TOMBSTONE ((const void *)&tombstone_marker)
+static const char tombstone_marker;
+
+/**
+ * @brief Description held for one state
+ */
+typedef struct description {
+    const void *key; /**< State described, NULL for a free slot */
+    char *text;      /**< Its description */
+} description_t;
+
+/**
+ * @brief Automaton describer structure
+ *
+ * The observer comes first, so the observer pointer passed to the
+ * callbacks is the describer.
+ */
+struct rift_automaton_describer {
+    rift_automaton_observer_t observer; /**< Observer of the described automaton */
+    rift_regex_automaton_t *automaton;  /**< Automaton described */
+    description_t *slots;               /**< Open addressing table */
+    size_t capacity;                    /**< Slots, a power of two */
+    size_t count;                       /**< Live entries */
+    size_t used;                        /**< Live entries and tombstones */
+    char *summary;                      /**< Description of the automaton, or NULL */
+};
+
+/**
+ * @brief Text growing as a description is written
+ */
+typedef struct text_builder {
+    char *data;      /**< Text so far */
+    size_t length;   /**< Its length */
+    size_t capacity; /**< Bytes allocated */
+    bool failed;     /**< Whether an allocation failed */
+} text_builder_t;
+
+/**
+ * @brief Append formatted text
+ */
+static void
+append(text_builder_t *builder, const char *format, ...)
+{
+    if (builder->failed) {
+        return;
+    }
+
+    va_list args;
+    va_start(args, format);
+    va_list copy;
+    va_copy(copy, args);
+    int needed = vsnprintf(NULL, 0, format, copy);
+    va_end(copy);
+    if (needed < 0) {
+        builder->failed = true;
+        va_end(args);
+        return;
+    }
+
+    if (builder->length + (size_t)needed + 1 > builder->capacity) {
+        size_t capacity = builder->capacity ? builder->capacity : 128;
+        while (builder->length + (size_t)needed + 1 > capacity) {
+            capacity *= 2;
+        }
+        char *data = rift_realloc(builder->data, capacity);
+        if (!data) {
+            builder->failed = true;
+            va_end(args);
+            return;
+        }
+        builder->data = data;
+        builder->capacity = capacity;
+    }
+
+    vsnprintf(builder->data + builder->length, builder->capacity - builder->length, format, args);
+    builder->length += (size_t)needed;
+    va_end(args);
+}
+
+/**
+ * @brief Take the text written, or NULL if writing it failed
+ */
+static char *
+finish(text_builder_t *builder)
+{
+    if (builder->failed) {
+        rift_free(builder->data);
+        return NULL;
+    }
+    return builder->data;
+}
+
+/**
+ * @brief Hash an address to a slot
+ */
+static size_t
+hash_key(const void *key, size_t capacity)
+{
+    uint64_t h = (uint64_t)(uintptr_t)key;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return (size_t)h & (capacity - 1);
+}
+
+/**
+ * @brief Find the entry of a state
+ */
+static description_t *
+find_description(const rift_automaton_describer_t *describer, const void *key)
+{
+    if (!key || describer->capacity == 0) {
+        return NULL;
+    }
+
+    size_t i = hash_key(key, describer->capacity);
+    while (describer->slots[i].key) {
+        if (describer->slots[i].key == key) {
+            return &describer->slots[i];
+        }
+        i = (i + 1) & (describer->capacity - 1);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Rebuild the table with a capacity, dropping the tombstones
+ */
+static bool
+resize_table(rift_automaton_describer_t *describer, size_t capacity)
+{
+    description_t *slots = rift_malloc(capacity * sizeof(description_t));
+    if (!slots) {
+        return false;
+    }
+    memset(slots, 0, capacity * sizeof(description_t));
+
+    for (size_t i = 0; i < describer->capacity; i++) {
+        description_t *entry = &describer->slots[i];
+        if (!entry->key || entry->key == TOMBSTONE) {
+            continue;
+        }
+        size_t j = hash_key(entry->key, capacity);
+        while (slots[j].key) {
+            j = (j + 1) & (capacity - 1);
+        }
+        slots[j] = *entry;
+    }
+
+    rift_free(describer->slots);
+    describer->slots = slots;
+    describer->capacity = capacity;
+    describer->used = describer->count;
+    return true;
+}
+
+/**
+ * @brief Add the entry of a state that has none
+ */
+static description_t *
+insert_description(rift_automaton_describer_t *describer, const void *key, char *text)
+{
+    if ((describer->used + 1) * 2 > describer->capacity) {
+        size_t capacity = describer->capacity ? describer->capacity : 64;
+        while ((describer->count + 1) * 2 > capacity / 2) {
+            capacity *= 2;
+        }
+        if (!resize_table(describer, capacity)) {
+            return NULL;
+        }
+    }
+
+    size_t i = hash_key(key, describer->capacity);
+    while (describer->slots[i].key && describer->slots[i].key != TOMBSTONE) {
+        i = (i + 1) & (describer->capacity - 1);
+    }
+    if (!describer->slots[i].key) {
+        describer->used++;
+    }
+    describer->slots[i].key = key;
+    describer->slots[i].text = text;
+    describer->count++;
+    return &describer->slots[i];
+}
+
+/**
+ * @brief Drop the entry of a state, if it has one
+ */
+static void
+drop_description(rift_automaton_describer_t *describer, const void *key)
+{
+    description_t *entry = find_description(describer, key);
+    if (!entry) {
+        return;
+    }
+
+    rift_free(entry->text);
+    entry->text = NULL;
+    entry->key = TOMBSTONE;
+    describer->count--;
+}
+
+/**
+ * @brief Drop every description
+ */
+static void
+drop_all(rift_automaton_describer_t *describer)
+{
+    for (size_t i = 0; i < describer->capacity; i++) {
+        rift_free(describer->slots[i].text);
+    }
+    rift_free(describer->slots);
+    describer->slots = NULL;
+    describer->capacity = 0;
+    describer->count = 0;
+    describer->used = 0;
+    rift_free(describer->summary);
+    describer->summary = NULL;
+}
+
+/**
+ * @brief Drop the descriptions naming a state about to be freed
+ *
+ * Only the states described can name it, so the cost is in what is held
+ * rather than in the size of the automaton.
+ */
+static void
+drop_referring(rift_automaton_describer_t *describer, const rift_regex_state_t *target)
+{
+    for (size_t i = 0; i < describer->capacity; i++) {
+        description_t *entry = &describer->slots[i];
+        if (!entry->key || entry->key == TOMBSTONE) {
+            continue;
+        }
+        const rift_regex_state_t *state = entry->key;
+        for (size_t t = 0; t < state->num_transitions; t++) {
+            if (state->transitions[t] && state->transitions[t]->to_state == target) {
+                drop_description(describer, state);
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Write what a transition reads, in words
+ */
+static void
+append_label(text_builder_t *builder, const rift_regex_transition_t *transition)
+{
+    const char *label = transition->input_pattern;
+    if (transition->is_epsilon || !label || !*label) {
+        append(builder, "without input");
+    } else if (strcmp(label, " ") == 0) {
+        append(builder, "on space");
+    } else if (strcmp(label, ".") == 0) {
+        append(builder, "on any character");
+    } else {
+        append(builder, "on \"%s\"", label);
+    }
+}
+
+/**
+ * @brief Write the description of a state
+ */
+static char *
+generate_description(const rift_automaton_describer_t *describer, const rift_regex_state_t *state)
+{
+    text_builder_t builder = {0};
+    append(&builder, "State %zu", state->id);
+    if (describer->automaton->initial_state == state) {
+        append(&builder, ", initial");
+    }
+    if (state->is_accepting) {
+        append(&builder, ", accepting");
+    }
+
+    if (state->num_transitions == 0) {
+        append(&builder, ". No transitions.");
+        return finish(&builder);
+    }
+
+    append(&builder, ". %zu transition%s: ", state->num_transitions,
+           state->num_transitions == 1 ? "" : "s");
+    for (size_t i = 0; i < state->num_transitions; i++) {
+        const rift_regex_transition_t *transition = state->transitions[i];
+        if (i > 0) {
+            append(&builder, "; ");
+        }
+        if (!transition) {
+            append(&builder, "none");
+            continue;
+        }
+        append_label(&builder, transition);
+        if (transition->to_state == state) {
+            append(&builder, " back to itself");
+        } else if (transition->to_state) {
+            append(&builder, " to state %zu", transition->to_state->id);
+        }
+    }
+    append(&builder, ".");
+    return finish(&builder);
+}
+
+/**
+ * @brief Drop the descriptions a change made stale
+ */
+static void
+on_change(rift_automaton_observer_t *observer, void *automaton, rift_automaton_change_type_t type,
+          void *element)
+{
+    rift_automaton_describer_t *describer = (rift_automaton_describer_t *)observer;
+    if (automaton != describer->automaton || !element) {
+        return;
+    }
+
+    /* Every change may alter the counts of the summary */
+    rift_free(describer->summary);
+    describer->summary = NULL;
+
+    switch (type) {
+    case RIFT_AUTOMATON_CHANGE_STATE_ADDED:
+        break;
+    case RIFT_AUTOMATON_CHANGE_STATE_REMOVED:
+        drop_description(describer, element);
+        drop_referring(describer, element);
+        break;
+    case RIFT_AUTOMATON_CHANGE_STATE_MODIFIED:
+        drop_description(describer, element);
+        break;
+    case RIFT_AUTOMATON_CHANGE_TRANSITION_ADDED:
+    case RIFT_AUTOMATON_CHANGE_TRANSITION_REMOVED:
+    case RIFT_AUTOMATON_CHANGE_TRANSITION_MODIFIED:
+        drop_description(describer, ((rift_regex_transition_t *)element)->from_state);
+        break;
+    }
+}
+
+/**
+ * @brief Drop every description after a change the observer was not told the details of
+ */
+static void
+on_update(rift_automaton_observer_t *observer, void *automaton)
+{
+    rift_automaton_describer_t *describer = (rift_automaton_describer_t *)observer;
+    if (automaton == describer->automaton) {
+        drop_all(describer);
+    }
+}
+
+/**
+ * @brief Creates a new automaton describer
+ *
+ * @return rift_automaton_describer_t* A new describer or NULL on failure
+ */
+rift_automaton_describer_t *
+rift_automaton_describer_create(void)
+{
+    rift_automaton_describer_t *describer = rift_malloc(sizeof(rift_automaton_describer_t));
+    if (!describer) {
+        return NULL;
+    }
+
+    memset(describer, 0, sizeof(rift_automaton_describer_t));
+    describer->observer.update = on_update;
+    describer->observer.changed = on_change;
+    describer->observer.user_data = describer;
+    return describer;
+}
+
+/**
+ * @brief Destroys a describer and the descriptions it holds
+ *
+ * @param describer The describer to destroy (can be NULL)
+ */
+void
+rift_automaton_describer_destroy(rift_automaton_describer_t *describer)
+{
+    if (!describer) {
+        return;
+    }
+
+    drop_all(describer);
+    rift_free(describer);
+}
+
+/**
+ * @brief Sets the automaton described
+ *
+ * @param describer The describer
+ * @param automaton The automaton, or NULL to detach
+ * @return bool True if successful, false otherwise
+ */
+bool
+rift_automaton_describer_attach(rift_automaton_describer_t *describer,
+                                rift_regex_automaton_t *automaton)
+{
+    if (!describer) {
+        return false;
+    }
+
+    drop_all(describer);
+    describer->automaton = automaton;
+    return true;
+}
+
+/**
+ * @brief Gets the observer to notify of changes to the described automaton
+ *
+ * @param describer The describer
+ * @return rift_automaton_observer_t* The observer or NULL on error
+ */
+rift_automaton_observer_t *
+rift_automaton_describer_get_observer(rift_automaton_describer_t *describer)
+{
+    return describer ? &describer->observer : NULL;
+}
+
+/**
+ * @brief Describes a state, such as the one with the focus
+ *
+ * @param describer The describer
+ * @param state A state of the attached automaton
+ * @return const char* The description, owned by the describer, or NULL on error
+ */
+const char *
+rift_automaton_describer_describe_state(rift_automaton_describer_t *describer,
+                                        const rift_regex_state_t *state)
+{
+    if (!describer || !describer->automaton || !state) {
+        return NULL;
+    }
+
+    description_t *entry = find_description(describer, state);
+    if (entry) {
+        return entry->text;
+    }
+
+    char *text = generate_description(describer, state);
+    if (!text) {
+        return NULL;
+    }
+    entry = insert_description(describer, state, text);
+    if (!entry) {
+        rift_free(text);
+        return NULL;
+    }
+    return entry->text;
+}
+
+/**
+ * @brief Describes the states in view
+ *
+ * @param describer The describer
+ * @param first Index of the first state in view
+ * @param count Number of states in view
+ * @param descriptions Where the descriptions go, count of them
+ * @return size_t The number of states described, fewer past the last state
+ */
+size_t
+rift_automaton_describer_describe_range(rift_automaton_describer_t *describer, size_t first,
+                                        size_t count, const char **descriptions)
+{
+    if (!describer || !describer->automaton || !descriptions) {
+        return 0;
+    }
+
+    rift_regex_automaton_t *automaton = describer->automaton;
+    size_t described = 0;
+    for (size_t i = first; i < automaton->num_states && described < count; i++) {
+        const char *text = rift_automaton_describer_describe_state(describer, automaton->states[i]);
+        if (!text) {
+            break;
+        }
+        descriptions[described++] = text;
+    }
+    return described;
+}
+
+/**
+ * @brief Describes the attached automaton as a whole
+ *
+ * @param describer The describer
+ * @return const char* The description, owned by the describer, or NULL on error
+ */
+const char *
+rift_automaton_describer_describe_summary(rift_automaton_describer_t *describer)
+{
+    if (!describer || !describer->automaton) {
+        return NULL;
+    }
+    if (describer->summary) {
+        return describer->summary;
+    }
+
+    rift_regex_automaton_t *automaton = describer->automaton;
+    size_t accepting = 0;
+    size_t transitions = 0;
+    for (size_t i = 0; i < automaton->num_states; i++) {
+        accepting += automaton->states[i]->is_accepting;
+        transitions += automaton->states[i]->num_transitions;
+    }
+
+    text_builder_t builder = {0};
+    append(&builder, "Automaton with %zu state%s, %zu accepting, and %zu transition%s.",
+           automaton->num_states, automaton->num_states == 1 ? "" : "s", accepting, transitions,
+           transitions == 1 ? "" : "s");
+    if (automaton->initial_state) {
+        append(&builder, " Starts at state %zu.", automaton->initial_state->id);
+    }
+    describer->summary = finish(&builder);
+    return describer->summary;
+}
+
+/**
+ * @brief Gets the number of state descriptions held
+ *
+ * @param describer The describer
+ * @return size_t The number of states described and not changed since
+ */
+size_t
+rift_automaton_describer_get_cached_count(const rift_automaton_describer_t *describer)
+{
+    return describer ? describer->count : 0;
+}
@@ -42,6 +42,7 @@ ommand/ast_command.h"/a #include "core/config/config.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "cli/command/output_writer.h"
 #include "core/parser/ast.h"
 #include "core/parser/parser.h"
 #include "core/syntax/parser.h"
@@ -333,15 +334,19 @@ rift_command_parse_args(rift_command_t *command, int argc, char *argv[])
         } else if (strcmp(argv[i], "--format") == 0) {
             /* Output format */
             if (i + 1 < argc) {
-                if (strcmp(argv[i + 1], "json") == 0 || strcmp(argv[i + 1], "dot") == 0 ||
-                    strcmp(argv[i + 1], "text") == 0) {
+                rift_output_format_t parsed;
+                if (strcmp(argv[i + 1], "dot") == 0 ||
+                    (rift_output_format_parse(argv[i + 1], &parsed) &&
+                     parsed != RIFT_OUTPUT_FORMAT_BINARY)) {
                     cmd->options.format = rift_strdup(argv[i + 1]);
                     if (!cmd->options.format) {
                         fprintf(stderr, "Error: Failed to allocate memory for format\n");
                         return false;
                     }
                 } else {
-                    fprintf(stderr, "Error: Invalid format: %s. Must be json, dot, or text.\n",
+                    fprintf(stderr,
+                            "Error: Invalid format: %s. Must be json, ndjson, cbor, dot, or "
+                            "text.\n",
                             argv[i + 1]);
                     return false;
                 }
@@ -410,6 +415,35 @@ rift_command_parse_args(rift_command_t *command, int argc, char *argv[])
 
 ommand/ast_command.h"/a #include "core/errors/regex_error.h"
 ommand/ast_command.h"/a #include "core/errors/regex_error.h"
+/**
+ * @brief Write a node and its subtree as one object
+ *
+ * @param writer The writer, inside a record or an array
+ * @param node The node
+ * @param key Name of the object, NULL inside an array
+ */
+static void
+write_ast_node(rift_output_writer_t *writer, const rift_regex_ast_node_t *node, const char *key)
+{
+    const char *type = rift_regex_ast_node_type_to_string(rift_regex_ast_get_node_type(node));
+    const char *value = rift_regex_ast_get_node_value(node);
+    size_t num_children = rift_regex_ast_get_child_count(node);
+
+    rift_output_writer_begin_object(writer, key);
+    rift_output_writer_field_string(writer, "type", type, strlen(type));
+    if (value) {
+        rift_output_writer_field_string(writer, "value", value, strlen(value));
+    }
+    if (num_children > 0) {
+        rift_output_writer_begin_array(writer, "children");
+        for (size_t i = 0; i < num_children; i++) {
+            write_ast_node(writer, rift_regex_ast_get_child(node, i), NULL);
+        }
+        rift_output_writer_end_array(writer);
+    }
+    rift_output_writer_end_object(writer);
+}
+
 /**
  * @brief Execute the AST command
  *
@@ -484,7 +518,7 @@ rift_command_execute(rift_command_t *command)
 
         if (!ast) {
             error = rift_regex_parser_get_error(parser);
-            fprintf(stderr, "Error: Parsing failed: %s\n", error.message);
+            fprintf(stderr, "Error: Parsing failed: %s\n", rift_regex_error_message(&error));
             rift_regex_parser_free(parser);
             return 1;
         }
@@ -514,16 +548,7 @@ rift_command_execute(rift_command_t *command)
     }
 
     /* Generate output */
-    char *ast_output = NULL;
-    if (strcmp(cmd->options.format, "text") == 0) {
-        ast_output = rift_regex_ast_to_string(ast);
-    } else if (strcmp(cmd->options.format, "json") == 0) {
-        /* Placeholder: In a real implementation, we would generate JSON */
-        fprintf(stderr, "Error: JSON output format not implemented yet\n");
-        rift_regex_ast_free(ast);
-        rift_regex_parser_free(parser);
-        return 1;
-    } else if (strcmp(cmd->options.format, "dot") == 0) {
+    if (strcmp(cmd->options.format, "dot") == 0) {
         /* Placeholder: In a real implementation, we would generate DOT */
         fprintf(stderr, "Error: DOT output format not implemented yet\n");
         rift_regex_ast_free(ast);
@@ -531,30 +556,47 @@ rift_command_execute(rift_command_t *command)
         return 1;
     }
 
-    if (!ast_output) {
-        fprintf(stderr, "Error: Failed to generate AST output\n");
-        rift_regex_ast_free(ast);
-        rift_regex_parser_free(parser);
-        return 1;
-    }
-
-    /* Write output to file or stdout */
-    if (cmd->options.output_file) {
-        if (!rift_write_file(cmd->options.output_file, ast_output)) {
-            fprintf(stderr, "Error: Failed to write output to file: %s\n",
-                    cmd->options.output_file);
-            rift_free(ast_output);
+    rift_output_format_t format = RIFT_OUTPUT_FORMAT_TEXT;
+    rift_output_format_parse(cmd->options.format, &format);
+    char *ast_output = NULL;
+    if (format == RIFT_OUTPUT_FORMAT_TEXT) {
+        ast_output = rift_regex_ast_to_string(ast);
+        if (!ast_output) {
+            fprintf(stderr, "Error: Failed to generate AST output\n");
             rift_regex_ast_free(ast);
             rift_regex_parser_free(parser);
             return 1;
         }
+    }
 
-        if (!cmd->quiet) {
-            printf("AST written to: %s\n", cmd->options.output_file);
+    /* Write output to file or stdout; the structured formats hold one record, the tree */
+    rift_output_writer_t *writer = rift_output_writer_open(cmd->options.output_file, format);
+    bool written = writer != NULL;
+    if (writer && ast_output) {
+        written = rift_output_writer_printf(writer, "%s\n", ast_output);
+    } else if (writer) {
+        rift_output_writer_begin_record(writer);
+        rift_regex_ast_node_t *root = rift_regex_ast_get_root(ast);
+        if (root) {
+            write_ast_node(writer, root, "root");
         }
-    } else {
-        /* Print to stdout */
-        printf("%s\n", ast_output);
+        rift_output_writer_end_record(writer);
+    }
+    if (writer && !rift_output_writer_close(writer)) {
+        written = false;
+    }
+
+    if (!written) {
+        fprintf(stderr, "Error: Failed to write output to file: %s\n",
+                cmd->options.output_file ? cmd->options.output_file : "-");
+        rift_free(ast_output);
+        rift_regex_ast_free(ast);
+        rift_regex_parser_free(parser);
+        return 1;
+    }
+
+    if (cmd->options.output_file && !cmd->quiet) {
+        printf("AST written to: %s\n", cmd->options.output_file);
     }
 
     /* Generate visualization if requested */
@@ -602,7 +644,8 @@ rift_command_get_help(const rift_command_t *command)
                "\n"
                "Options:\n"
                "  --output, -o <file>          Save AST to a file\n"
-               "  --format <json|dot|text>     Output format (default: text)\n"
+               "  --format <fmt>               Output format: text, json, ndjson, cbor or dot\n"
+               "                               (default: text)\n"
                "  --transform <file>           Apply transformations from file\n"
                "  --optimize                   Apply AST optimizations\n"
                "  --parse-tree <file>          Use parse tree from file\n"
@@ -0,0 +1,937 @@
+/**
+ * @file bench_command.c
+ * @brief Bench command implementation for LibRift CLI
+ *
+ * This file implements the bench command. Every engine runs the same task,
+ * finding the non-overlapping matches of the pattern in the corpus from
+ * left to right. The matcher engines search for them; the DFA table and the
+ * bytecode programs only match at the start of their input, so they are
+ * tried at each position in turn, as a tokenizer would. The match counts
+ * show where the engines' semantics differ, the DFA table reporting the
+ * longest match at a position rather than the first.
+ *
+ * Times come from the monotonic clock. Memory is the peak of the tracked
+ * allocations while compiling and searching once, and reads 0 in builds
+ * without RIFT_MEMORY_TRACKING.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "cli/command/bench_command.h"
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "core/automaton/automaton.h"
+#include "core/automaton/dfa_table.h"
+#include "core/automaton/hopcroft.h"
+#include "core/automaton/lookaround.h"
+#include "core/bytecode/bytecode_compiler.h"
+#include "core/bytecode/bytecode_jit.h"
+#include "core/bytecode/bytecode_vm.h"
+#include "core/compiler/ambiguity.h"
+#include "core/dsl/rift_dsl_compiler.h"
+#include "core/engine/pattern.h"
+#include "core/errors/regex_error.h"
+#include "core/memory/memory.h"
+#include "core/runtime/matcher.h"
+
+/**
+ * @brief State of one engine compiled for the benchmark
+ */
+typedef struct bench_run {
+    const rift_bench_options_t *options; /**< Options of the command */
+    const char *unavailable;             /**< Why the engine cannot run the pattern, or NULL */
+    rift_regex_pattern_t *pattern;       /**< Compiled pattern of the matcher engines */
+    rift_regex_matcher_t *matcher;       /**< Matcher of the matcher engines */
+    rift_dfa_table_t *table;             /**< Minimized DFA table */
+    rift_bytecode_program_t *program;    /**< Bytecode program of the VM and the JIT */
+    rift_bytecode_vm_t *vm;              /**< VM running the program */
+    rift_bytecode_jit_t *jit;            /**< Native code of the program */
+    void *rules;                         /**< Compiled ruleset */
+} bench_run_t;
+
+/**
+ * @brief An engine the benchmark can run
+ */
+typedef struct bench_engine {
+    const char *name;                  /**< Name on the command line and in reports */
+    bool (*compile)(bench_run_t *run); /**< Compile, false with run->unavailable on failure */
+    size_t (*scan)(bench_run_t *run, const char *input, size_t length); /**< Count matches */
+} bench_engine_t;
+
+/**
+ * @brief Measurements of one engine
+ */
+typedef struct bench_result {
+    const bench_engine_t *engine; /**< The engine */
+    const char *unavailable;      /**< Why the engine did not run, or NULL */
+    uint64_t compile_ns;          /**< Median compile time */
+    size_t memory_bytes;          /**< Peak tracked memory of a compilation and a search */
+    uint64_t scan_ns;             /**< Median time of searching the corpus */
+    size_t matches;               /**< Matches found in the corpus */
+    size_t latency_samples;       /**< Lines timed one by one */
+    uint64_t latency_ns[4];       /**< p50, p90, p99 and maximum time of a line */
+} bench_result_t;
+
+/**
+ * @brief Percentiles reported for the latencies, the last being the maximum
+ */
+static const unsigned LATENCY_PERCENTILES[4] = {50, 90, 99, 100};
+
+/**
+ * @brief Free what an engine compiled
+ *
+ * @param run The engine's state, left empty
+ */
+static void
+run_release(bench_run_t *run)
+{
+    rift_matcher_free(run->matcher);
+    rift_regex_pattern_free(run->pattern);
+    rift_dfa_table_free(run->table);
+    rift_bytecode_jit_free(run->jit);
+    rift_bytecode_vm_free(run->vm);
+    rift_bytecode_program_free(run->program);
+    if (run->rules) {
+        rift_dsl_free_compilation(run->rules);
+    }
+
+    const rift_bench_options_t *options = run->options;
+    memset(run, 0, sizeof(*run));
+    run->options = options;
+}
+
+/**
+ * @brief Compile the pattern for a matcher engine
+ *
+ * @param run The engine's state
+ * @param option Option forcing the engine
+ * @return true if successful, false otherwise
+ */
+static bool
+compile_matcher(bench_run_t *run, rift_matcher_option_t option)
+{
+    rift_regex_error_t error;
+    rift_regex_error_init(&error);
+    run->pattern = rift_regex_compile(run->options->pattern, run->options->flags, &error);
+    if (!run->pattern) {
+        run->unavailable = "the pattern does not compile";
+        return false;
+    }
+
+    /* The matcher takes the backtracker for what the forced engine cannot run */
+    const rift_ambiguity_verdict_t *verdict = rift_regex_pattern_get_ambiguity(run->pattern);
+    const rift_regex_automaton_t *automaton = rift_regex_pattern_get_automaton(run->pattern);
+    if (option == RIFT_MATCHER_OPTION_PIKE_VM && verdict && verdict->has_backreference) {
+        run->unavailable = "the pattern has backreferences";
+        return false;
+    }
+    if (option == RIFT_MATCHER_OPTION_LAZY_DFA &&
+        (rift_regex_pattern_get_group_count(run->pattern) > 0 || !automaton ||
+         rift_automaton_has_lookarounds(automaton))) {
+        run->unavailable = "the pattern has capture groups or lookarounds";
+        return false;
+    }
+
+    run->matcher = rift_matcher_create(run->pattern, option);
+    if (!run->matcher) {
+        run->unavailable = "the matcher cannot be created";
+        return false;
+    }
+    return true;
+}
+
+static bool
+compile_backtracker(bench_run_t *run)
+{
+    return compile_matcher(run, RIFT_MATCHER_OPTION_BACKTRACK);
+}
+
+static bool
+compile_pike_vm(bench_run_t *run)
+{
+    return compile_matcher(run, RIFT_MATCHER_OPTION_PIKE_VM);
+}
+
+static bool
+compile_lazy_dfa(bench_run_t *run)
+{
+    return compile_matcher(run, RIFT_MATCHER_OPTION_LAZY_DFA);
+}
+
+/**
+ * @brief Count a match found by a matcher engine
+ */
+static bool
+count_match(const rift_regex_span_t *spans, size_t num_spans, void *user_data)
+{
+    (void)spans;
+    (void)num_spans;
+    (*(size_t *)user_data)++;
+    return true;
+}
+
+/**
+ * @brief Count the matches of a matcher engine
+ */
+static size_t
+scan_matcher(bench_run_t *run, const char *input, size_t length)
+{
+    size_t matches = 0;
+    if (rift_matcher_set_input(run->matcher, input, length)) {
+        rift_matcher_for_each_match(run->matcher, count_match, &matches);
+    }
+    return matches;
+}
+
+/**
+ * @brief Compile the pattern to a minimized DFA table
+ */
+static bool
+compile_dfa(bench_run_t *run)
+{
+    rift_regex_error_t error;
+    rift_regex_error_init(&error);
+    rift_regex_pattern_t *pattern =
+        rift_regex_compile(run->options->pattern, run->options->flags, &error);
+    const rift_regex_automaton_t *automaton =
+        pattern ? rift_regex_pattern_get_automaton(pattern) : NULL;
+    if (!automaton) {
+        rift_regex_pattern_free(pattern);
+        run->unavailable = "the pattern does not compile";
+        return false;
+    }
+
+    rift_regex_automaton_t *dfa = NULL;
+    if (!automaton->is_deterministic) {
+        dfa = rift_automaton_nfa_to_dfa(automaton, &error);
+        automaton = dfa;
+    }
+    rift_regex_automaton_t *minimal = automaton ? rift_hopcroft_minimize(automaton, &error) : NULL;
+    run->table = minimal ? rift_dfa_table_compile(minimal, &error) : NULL;
+
+    rift_automaton_free(minimal);
+    rift_automaton_free(dfa);
+    rift_regex_pattern_free(pattern);
+    if (!run->table) {
+        run->unavailable = "the pattern has no DFA";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Count the matches of the DFA table, trying each position in turn
+ */
+static size_t
+scan_dfa(bench_run_t *run, const char *input, size_t length)
+{
+    size_t matches = 0;
+    for (size_t pos = 0; pos < length;) {
+        size_t end = 0;
+        if (rift_dfa_table_longest_prefix(run->table, input + pos, length - pos, &end)) {
+            matches++;
+        }
+        pos += end > 0 ? end : 1;
+    }
+    return matches;
+}
+
+/**
+ * @brief Compile the pattern to a bytecode program and a VM to run it
+ */
+static bool
+compile_bytecode(bench_run_t *run)
+{
+    rift_regex_error_t error;
+    rift_regex_error_init(&error);
+    run->program = rift_bytecode_compile(run->options->pattern, run->options->flags, &error);
+    if (!run->program) {
+        run->unavailable = "the pattern does not compile to bytecode";
+        return false;
+    }
+
+    run->vm = rift_bytecode_vm_create(run->program, "", 0);
+    if (!run->vm) {
+        run->unavailable = "the VM cannot be created";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Compile the pattern to native code through its bytecode program
+ */
+static bool
+compile_jit(bench_run_t *run)
+{
+    if (!rift_bytecode_jit_available()) {
+        run->unavailable = "the JIT does not support this platform";
+        return false;
+    }
+    if (!compile_bytecode(run)) {
+        return false;
+    }
+
+    rift_regex_error_t error;
+    rift_regex_error_init(&error);
+    run->jit = rift_bytecode_jit_compile(run->program, &error);
+    if (!run->jit) {
+        run->unavailable = "the program uses opcodes the JIT does not support";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Count the matches of the bytecode program, trying each position in turn
+ *
+ * The JIT's native code runs the program when it was compiled.
+ */
+static size_t
+scan_bytecode(bench_run_t *run, const char *input, size_t length)
+{
+    size_t matches = 0;
+    for (size_t pos = 0; pos < length;) {
+        rift_regex_match_t match = {0};
+        size_t end = 0;
+        if (rift_bytecode_vm_bind(run->vm, run->program, input + pos, length - pos) &&
+            (run->jit ? rift_bytecode_jit_execute(run->jit, run->program, run->vm, &match)
+                      : rift_bytecode_execute(run->program, run->vm, &match))) {
+            matches++;
+            end = match.end_pos;
+        }
+        pos += end > 0 ? end : 1;
+    }
+    return matches;
+}
+
+/**
+ * @brief Compile the ruleset
+ */
+static bool
+compile_ruleset(bench_run_t *run)
+{
+    run->rules = rift_dsl_compile_file(run->options->rules_file, NULL);
+    if (!run->rules || rift_dsl_get_compilation_error(run->rules)) {
+        run->unavailable = "the ruleset does not compile";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Count the rules matching each line
+ */
+static size_t
+scan_ruleset(bench_run_t *run, const char *input, size_t length)
+{
+    size_t matches = 0;
+    for (size_t start = 0; start < length;) {
+        const char *newline = memchr(input + start, '\n', length - start);
+        size_t end = newline ? (size_t)(newline - input) : length;
+        matches += rift_dsl_execute_all(run->rules, input + start, end - start, NULL, NULL);
+        start = end + 1;
+    }
+    return matches;
+}
+
+/**
+ * @brief Engines run on a pattern, in report order
+ */
+static const bench_engine_t PATTERN_ENGINES[] = {
+    {"backtracker", compile_backtracker, scan_matcher},
+    {"bytecode_vm", compile_bytecode, scan_bytecode},
+    {"dfa", compile_dfa, scan_dfa},
+    {"lazy_dfa", compile_lazy_dfa, scan_matcher},
+    {"pike_vm", compile_pike_vm, scan_matcher},
+    {"jit", compile_jit, scan_bytecode},
+};
+
+/**
+ * @brief Engine run on a ruleset
+ */
+static const bench_engine_t RULESET_ENGINE = {"ruleset", compile_ruleset, scan_ruleset};
+
+/**
+ * @brief Order times for the medians and percentiles
+ */
+static int
+compare_ns(const void *a, const void *b)
+{
+    uint64_t left = *(const uint64_t *)a;
+    uint64_t right = *(const uint64_t *)b;
+    return left < right ? -1 : left > right;
+}
+
+/**
+ * @brief Sort times and pick the median
+ *
+ * @param times The times, sorted in place
+ * @param count Number of times, at least 1
+ * @return The median
+ */
+static uint64_t
+median_ns(uint64_t *times, size_t count)
+{
+    qsort(times, count, sizeof(*times), compare_ns);
+    return times[count / 2];
+}
+
+/**
+ * @brief Time the lines of the corpus one by one
+ *
+ * @param run The compiled engine
+ * @param engine The engine
+ * @param input The corpus
+ * @param length Length of the corpus
+ * @param result Where the percentiles go
+ */
+static void
+measure_latency(bench_run_t *run, const bench_engine_t *engine, const char *input, size_t length,
+                bench_result_t *result)
+{
+    size_t max_samples = run->options->latency_samples;
+    uint64_t *times = max_samples ? malloc(max_samples * sizeof(*times)) : NULL;
+    if (!times) {
+        return;
+    }
+
+    size_t count = 0;
+    for (size_t start = 0; start < length && count < max_samples;) {
+        const char *newline = memchr(input + start, '\n', length - start);
+        size_t end = newline ? (size_t)(newline - input) : length;
+        uint64_t begin = rift_matcher_monotonic_ns();
+        engine->scan(run, input + start, end - start);
+        times[count++] = rift_matcher_monotonic_ns() - begin;
+        start = end + 1;
+    }
+
+    if (count > 0) {
+        qsort(times, count, sizeof(*times), compare_ns);
+        for (size_t i = 0; i < 4; i++) {
+            size_t rank = (count * LATENCY_PERCENTILES[i] + 99) / 100;
+            result->latency_ns[i] = times[rank > 0 ? rank - 1 : 0];
+        }
+    }
+    result->latency_samples = count;
+    free(times);
+}
+
+/**
+ * @brief Measure one engine
+ *
+ * A first compilation and search run with memory tracking for the peak;
+ * the timed ones follow with tracking off, so its bookkeeping is not timed.
+ *
+ * @param options Options of the command
+ * @param engine The engine
+ * @param input The corpus
+ * @param length Length of the corpus
+ * @param result Where the measurements go
+ */
+static void
+measure_engine(const rift_bench_options_t *options, const bench_engine_t *engine,
+               const char *input, size_t length, bench_result_t *result)
+{
+    bench_run_t run = {.options = options};
+    size_t repeats = options->repeats > 0 ? options->repeats : 1;
+    uint64_t *times = malloc(repeats * sizeof(*times));
+    memset(result, 0, sizeof(*result));
+    result->engine = engine;
+    if (!times) {
+        result->unavailable = "out of memory";
+        return;
+    }
+
+    bool was_tracking = rift_memory_tracking_enable(true);
+    rift_memory_tracking_reset();
+    size_t base_usage = 0;
+    rift_memory_get_stats(&base_usage, NULL, NULL, NULL, NULL);
+    bool compiled = engine->compile(&run);
+    if (compiled) {
+        result->matches = engine->scan(&run, input, length);
+    }
+    size_t peak_usage = 0;
+    rift_memory_get_stats(NULL, &peak_usage, NULL, NULL, NULL);
+    rift_memory_tracking_enable(was_tracking);
+    result->memory_bytes = peak_usage > base_usage ? peak_usage - base_usage : 0;
+
+    if (!compiled) {
+        result->unavailable = run.unavailable;
+        run_release(&run);
+        free(times);
+        return;
+    }
+
+    for (size_t i = 0; i < repeats; i++) {
+        run_release(&run);
+        uint64_t begin = rift_matcher_monotonic_ns();
+        engine->compile(&run);
+        times[i] = rift_matcher_monotonic_ns() - begin;
+    }
+    result->compile_ns = median_ns(times, repeats);
+
+    for (size_t i = 0; i < options->warmup; i++) {
+        engine->scan(&run, input, length);
+    }
+    for (size_t i = 0; i < repeats; i++) {
+        uint64_t begin = rift_matcher_monotonic_ns();
+        engine->scan(&run, input, length);
+        times[i] = rift_matcher_monotonic_ns() - begin;
+    }
+    result->scan_ns = median_ns(times, repeats);
+
+    measure_latency(&run, engine, input, length, result);
+    run_release(&run);
+    free(times);
+}
+
+/**
+ * @brief Nanoseconds per byte of a search
+ */
+static double
+ns_per_byte(const bench_result_t *result, size_t length)
+{
+    return length > 0 ? (double)result->scan_ns / (double)length : 0.0;
+}
+
+/**
+ * @brief Matches found per second of a search
+ */
+static double
+matches_per_second(const bench_result_t *result)
+{
+    return result->scan_ns > 0 ? (double)result->matches * 1e9 / (double)result->scan_ns : 0.0;
+}
+
+/**
+ * @brief Write a string as a JSON string literal
+ */
+static void
+write_json_string(FILE *out, const char *text)
+{
+    fputc('"', out);
+    for (const unsigned char *c = (const unsigned char *)text; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            fprintf(out, "\\%c", *c);
+        } else if (*c < 0x20) {
+            fprintf(out, "\\u%04x", *c);
+        } else {
+            fputc(*c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+/**
+ * @brief Write the results as one JSON document
+ */
+static void
+write_json(FILE *out, const rift_bench_options_t *options, size_t length,
+           const bench_result_t *results, size_t count)
+{
+    fputs("{\n  \"pattern\": ", out);
+    write_json_string(out, options->pattern ? options->pattern : "");
+    fputs(",\n  \"rules\": ", out);
+    write_json_string(out, options->rules_file ? options->rules_file : "");
+    fputs(",\n  \"input\": ", out);
+    write_json_string(out, options->input_file);
+    fprintf(out, ",\n  \"bytes\": %zu,\n  \"warmup\": %zu,\n  \"repeats\": %zu,\n", length,
+            options->warmup, options->repeats);
+    fputs("  \"engines\": [", out);
+
+    for (size_t i = 0; i < count; i++) {
+        const bench_result_t *result = &results[i];
+        fprintf(out, "%s\n    {\"name\": \"%s\", ", i ? "," : "", result->engine->name);
+        if (result->unavailable) {
+            fputs("\"available\": false, \"reason\": ", out);
+            write_json_string(out, result->unavailable);
+            fputc('}', out);
+            continue;
+        }
+        fprintf(out,
+                "\"available\": true, \"compile_ns\": %llu, \"memory_bytes\": %zu, "
+                "\"scan_ns\": %llu, \"ns_per_byte\": %.3f, \"matches\": %zu, "
+                "\"matches_per_second\": %.0f, \"latency_ns\": {\"samples\": %zu, "
+                "\"p50\": %llu, \"p90\": %llu, \"p99\": %llu, \"max\": %llu}}",
+                (unsigned long long)result->compile_ns, result->memory_bytes,
+                (unsigned long long)result->scan_ns, ns_per_byte(result, length), result->matches,
+                matches_per_second(result), result->latency_samples,
+                (unsigned long long)result->latency_ns[0],
+                (unsigned long long)result->latency_ns[1],
+                (unsigned long long)result->latency_ns[2],
+                (unsigned long long)result->latency_ns[3]);
+    }
+    fputs("\n  ]\n}\n", out);
+}
+
+/**
+ * @brief Write the results as CSV, one row per engine
+ */
+static void
+write_csv(FILE *out, size_t length, const bench_result_t *results, size_t count)
+{
+    fputs("engine,available,compile_ns,memory_bytes,scan_ns,ns_per_byte,matches,"
+          "matches_per_second,latency_samples,p50_ns,p90_ns,p99_ns,max_ns\n",
+          out);
+    for (size_t i = 0; i < count; i++) {
+        const bench_result_t *result = &results[i];
+        if (result->unavailable) {
+            fprintf(out, "%s,false,,,,,,,,,,,\n", result->engine->name);
+            continue;
+        }
+        fprintf(out, "%s,true,%llu,%zu,%llu,%.3f,%zu,%.0f,%zu,%llu,%llu,%llu,%llu\n",
+                result->engine->name, (unsigned long long)result->compile_ns,
+                result->memory_bytes, (unsigned long long)result->scan_ns,
+                ns_per_byte(result, length), result->matches, matches_per_second(result),
+                result->latency_samples, (unsigned long long)result->latency_ns[0],
+                (unsigned long long)result->latency_ns[1],
+                (unsigned long long)result->latency_ns[2],
+                (unsigned long long)result->latency_ns[3]);
+    }
+}
+
+/**
+ * @brief Write the results as an aligned table
+ */
+static void
+write_text(FILE *out, const rift_bench_options_t *options, size_t length,
+           const bench_result_t *results, size_t count)
+{
+    fprintf(out, "%s on %s (%zu bytes, %zu warm-up, %zu repeats)\n\n",
+            options->pattern ? options->pattern : options->rules_file, options->input_file,
+            length, options->warmup, options->repeats);
+    fprintf(out, "%-12s %12s %12s %9s %10s %14s %10s %10s %10s\n", "engine", "compile_us",
+            "memory_KiB", "ns/byte", "matches", "matches/s", "p50_ns", "p90_ns", "p99_ns");
+
+    for (size_t i = 0; i < count; i++) {
+        const bench_result_t *result = &results[i];
+        if (result->unavailable) {
+            fprintf(out, "%-12s unavailable: %s\n", result->engine->name, result->unavailable);
+            continue;
+        }
+        fprintf(out, "%-12s %12.1f %12.1f %9.3f %10zu %14.0f %10llu %10llu %10llu\n",
+                result->engine->name, (double)result->compile_ns / 1e3,
+                (double)result->memory_bytes / 1024.0, ns_per_byte(result, length),
+                result->matches, matches_per_second(result),
+                (unsigned long long)result->latency_ns[0],
+                (unsigned long long)result->latency_ns[1],
+                (unsigned long long)result->latency_ns[2]);
+    }
+}
+
+/**
+ * @brief Check whether an engine was asked for
+ */
+static bool
+engine_selected(const rift_bench_options_t *options, const bench_engine_t *engine)
+{
+    if (options->num_engines == 0) {
+        return true;
+    }
+    for (size_t i = 0; i < options->num_engines; i++) {
+        if (strcmp(options->engines[i], engine->name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Create a new bench command
+ *
+ * @return A new bench command instance or NULL on failure
+ */
+rift_command_t *
+rift_bench_command_create(void)
+{
+    rift_bench_command_t *cmd = (rift_bench_command_t *)rift_malloc(sizeof(rift_bench_command_t));
+    if (!cmd) {
+        return NULL;
+    }
+
+    memset(cmd, 0, sizeof(*cmd));
+    cmd->type = RIFT_COMMAND_BENCHMARK;
+    cmd->options.warmup = 1;
+    cmd->options.repeats = RIFT_BENCH_DEFAULT_REPEATS;
+    cmd->options.latency_samples = RIFT_BENCH_DEFAULT_LATENCY_SAMPLES;
+    cmd->options.format = RIFT_BENCH_FORMAT_TEXT;
+    cmd->options.flags = 0; /* RIFT_REGEX_FLAG_NONE */
+
+    return (rift_command_t *)cmd;
+}
+
+/**
+ * @brief Get the options for a bench command
+ *
+ * @param command The bench command
+ * @return Pointer to the bench options
+ */
+rift_bench_options_t *
+rift_bench_command_get_options(rift_command_t *command)
+{
+    rift_bench_command_t *cmd = (rift_bench_command_t *)command;
+    if (!cmd || cmd->type != RIFT_COMMAND_BENCHMARK) {
+        return NULL;
+    }
+
+    return &cmd->options;
+}
+
+/**
+ * @brief Parse a count given to an option
+ *
+ * @param text The argument
+ * @param value Where the count goes
+ * @return true if the argument is a count, false otherwise
+ */
+static bool
+parse_count(const char *text, size_t *value)
+{
+    char *end;
+    unsigned long long parsed = strtoull(text, &end, 10);
+    if (*text == '\0' || *end != '\0') {
+        fprintf(stderr, "Error: Invalid count '%s'.\n", text);
+        return false;
+    }
+    *value = (size_t)parsed;
+    return true;
+}
+
+/**
+ * @brief Parse the arguments of a bench command
+ *
+ * @param command The bench command
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @return true if parsing was successful, false otherwise
+ */
+bool
+rift_bench_command_parse_args(rift_command_t *command, int argc, char *argv[])
+{
+    rift_bench_options_t *options = rift_bench_command_get_options(command);
+    if (!options) {
+        return false;
+    }
+
+    rift_bench_command_t *cmd = (rift_bench_command_t *)command;
+
+    for (int i = 0; i < argc; i++) {
+        const char *arg = argv[i];
+        bool takes_value = strcmp(arg, "--rules") == 0 || strcmp(arg, "--engine") == 0 ||
+                           strcmp(arg, "--warmup") == 0 || strcmp(arg, "--repeat") == 0 ||
+                           strcmp(arg, "--latency-samples") == 0;
+        if (takes_value && i + 1 >= argc) {
+            if (!cmd->quiet) {
+                fprintf(stderr, "Error: Missing argument for %s option.\n", arg);
+            }
+            return false;
+        }
+
+        bool ok = true;
+        if (strcmp(arg, "--rules") == 0) {
+            rift_free(options->rules_file);
+            options->rules_file = rift_strdup(argv[++i]);
+            ok = options->rules_file != NULL;
+        } else if (strcmp(arg, "--engine") == 0) {
+            /* One more engine to run */
+            char **engines =
+                rift_realloc(options->engines, (options->num_engines + 1) * sizeof(char *));
+            ok = engines != NULL;
+            if (ok) {
+                options->engines = engines;
+                engines[options->num_engines] = rift_strdup(argv[++i]);
+                ok = engines[options->num_engines] != NULL;
+                options->num_engines += ok;
+            }
+        } else if (strcmp(arg, "--warmup") == 0) {
+            if (!parse_count(argv[++i], &options->warmup)) {
+                return false;
+            }
+        } else if (strcmp(arg, "--repeat") == 0) {
+            if (!parse_count(argv[++i], &options->repeats)) {
+                return false;
+            }
+        } else if (strcmp(arg, "--latency-samples") == 0) {
+            if (!parse_count(argv[++i], &options->latency_samples)) {
+                return false;
+            }
+        } else if (strcmp(arg, "--json") == 0) {
+            options->format = RIFT_BENCH_FORMAT_JSON;
+        } else if (strcmp(arg, "--csv") == 0) {
+            options->format = RIFT_BENCH_FORMAT_CSV;
+        } else if (strcmp(arg, "--rift") == 0) {
+            options->flags |= RIFT_REGEX_FLAG_RIFT_SYNTAX;
+        } else if (strcmp(arg, "--case-insensitive") == 0 || strcmp(arg, "-i") == 0) {
+            options->flags |= RIFT_REGEX_FLAG_CASE_INSENSITIVE;
+        } else if (strcmp(arg, "--multiline") == 0 || strcmp(arg, "-m") == 0) {
+            options->flags |= RIFT_REGEX_FLAG_MULTILINE;
+        } else if (strcmp(arg, "--dotall") == 0 || strcmp(arg, "-s") == 0) {
+            options->flags |= RIFT_REGEX_FLAG_DOTALL;
+        } else if (arg[0] == '-' && arg[1] != '\0') {
+            if (!cmd->quiet) {
+                fprintf(stderr, "Warning: Unknown option '%s' ignored.\n", arg);
+            }
+        } else if (!options->pattern && !options->rules_file) {
+            /* The pattern comes first, unless --rules replaced it */
+            options->pattern = rift_strdup(arg);
+            ok = options->pattern != NULL;
+        } else if (!options->input_file) {
+            options->input_file = rift_strdup(arg);
+            ok = options->input_file != NULL;
+        } else if (!cmd->quiet) {
+            fprintf(stderr, "Warning: Extra argument '%s' ignored.\n", arg);
+        }
+
+        if (!ok) {
+            fprintf(stderr, "Error: Failed to allocate memory for arguments\n");
+            return false;
+        }
+    }
+
+    if (!options->pattern == !options->rules_file || !options->input_file) {
+        if (!cmd->quiet) {
+            fprintf(stderr, "Error: A pattern or --rules, and an input file, are required.\n");
+        }
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Execute a bench command
+ *
+ * @param command The bench command
+ * @return 0 on success, non-zero on failure
+ */
+int
+rift_bench_command_execute(rift_command_t *command)
+{
+    rift_bench_options_t *options = rift_bench_command_get_options(command);
+    if (!options || !options->input_file || (!options->pattern && !options->rules_file)) {
+        fprintf(stderr, "Error: No pattern or input specified\n");
+        return 1;
+    }
+
+    rift_bench_command_t *cmd = (rift_bench_command_t *)command;
+
+    /* The corpus is mapped once and searched in place by every engine */
+    int fd = open(options->input_file, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        fprintf(stderr, "Error: Cannot open input file: %s\n", options->input_file);
+        if (fd >= 0) {
+            close(fd);
+        }
+        return 1;
+    }
+    size_t length = (size_t)st.st_size;
+    void *mapping = length ? mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0) : NULL;
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        fprintf(stderr, "Error: Cannot map input file: %s\n", options->input_file);
+        return 1;
+    }
+    const char *input = mapping ? (const char *)mapping : "";
+
+    const bench_engine_t *engines = options->rules_file ? &RULESET_ENGINE : PATTERN_ENGINES;
+    size_t num_engines =
+        options->rules_file ? 1 : sizeof(PATTERN_ENGINES) / sizeof(PATTERN_ENGINES[0]);
+    bench_result_t results[sizeof(PATTERN_ENGINES) / sizeof(PATTERN_ENGINES[0])];
+    size_t count = 0;
+
+    for (size_t i = 0; i < num_engines; i++) {
+        if (!engine_selected(options, &engines[i])) {
+            continue;
+        }
+        if (cmd->verbose && !cmd->quiet) {
+            fprintf(stderr, "Running %s...\n", engines[i].name);
+        }
+        measure_engine(options, &engines[i], input, length, &results[count++]);
+    }
+
+    if (count == 0) {
+        fprintf(stderr, "Error: None of the engines given exists\n");
+    } else if (options->format == RIFT_BENCH_FORMAT_JSON) {
+        write_json(stdout, options, length, results, count);
+    } else if (options->format == RIFT_BENCH_FORMAT_CSV) {
+        write_csv(stdout, length, results, count);
+    } else {
+        write_text(stdout, options, length, results, count);
+    }
+
+    if (mapping) {
+        munmap(mapping, length);
+    }
+    return count > 0 ? 0 : 1;
+}
+
+/**
+ * @brief Get help information for a bench command
+ *
+ * @param command The bench command
+ * @return Help string for the command
+ */
+const char *
+rift_bench_command_get_help(const rift_command_t *command)
+{
+    (void)command;
+
+    return "bench <pattern> <input> [options]\n"
+           "bench --rules <file.rift> <input> [options]\n"
+           "\n"
+           "Benchmark compiling a pattern and finding its matches in a corpus on each\n"
+           "engine: backtracker, bytecode_vm, dfa, lazy_dfa, pike_vm and jit. A ruleset\n"
+           "is benchmarked on the DSL runtime, line by line. Reports compile time, peak\n"
+           "memory, ns/byte, matches/s and per-line latency percentiles.\n"
+           "\n"
+           "Options:\n"
+           "  --rules <file>                Benchmark a .rift ruleset instead of a pattern\n"
+           "  --engine <name>               Run only this engine, repeatable\n"
+           "  --warmup <n>                  Untimed searches before measuring (default: 1)\n"
+           "  --repeat <n>                  Measured compilations and searches (default: 5)\n"
+           "  --latency-samples <n>         Lines timed one by one (default: 10000)\n"
+           "  --json                        Print the results as JSON\n"
+           "  --csv                         Print the results as CSV\n"
+           "  --rift                        Enable LibRift r'' syntax\n"
+           "  --case-insensitive, -i        Case insensitive matching\n"
+           "  --multiline, -m               ^ and $ match start/end of line\n"
+           "  --dotall, -s                  . matches newline\n"
+           "\n"
+           "Examples:\n"
+           "  librift bench \"ERROR [0-9]+\" app.log\n"
+           "  librift bench \"[a-z]+@[a-z]+\\.com\" mail.txt --engine dfa --engine pike_vm\n"
+           "  librift bench --rules alerts.rift app.log --repeat 20 --json";
+}
+
+/**
+ * @brief Free resources associated with a bench command
+ *
+ * @param command The command to free
+ */
+void
+rift_bench_command_free(rift_command_t *command)
+{
+    rift_bench_options_t *options = rift_bench_command_get_options(command);
+    if (!options) {
+        return;
+    }
+
+    rift_free(options->pattern);
+    rift_free(options->rules_file);
+    rift_free(options->input_file);
+    for (size_t i = 0; i < options->num_engines; i++) {
+        rift_free(options->engines[i]);
+    }
+    rift_free(options->engines);
+
+    rift_free(command);
+}
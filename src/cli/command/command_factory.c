@@ -13,8 +13,15 @@
 #include <stdlib.h>
 #include <string.h>
 #include "cli/command/ast_command.h"
+#include "cli/command/bench_command.h"
 #include "cli/command/command.h"
 #include "cli/command/compile_command.h"
+#include "cli/command/explain_command.h"
+#include "cli/command/grep_command.h"
+#include "cli/command/lint_command.h"
+#include "cli/command/profile_command.h"
+#include "cli/command/serve_command.h"
+#include "cli/command/trace_command.h"
 #include "librift/cli/command_factory.h"
 #include "librift/cli/command.h"
 #include "librift/cli/commands/ast_command.h"
@@ -37,7 +44,10 @@ static const command_mapping_t COMMAND_MAPPINGS[] = {
     {"tokenize", RIFT_COMMAND_TOKENIZE},   {"visualize", RIFT_COMMAND_VISUALIZE},
     {"benchmark", RIFT_COMMAND_BENCHMARK}, {"config", RIFT_COMMAND_CONFIG},
     {"ast", RIFT_COMMAND_AST},             {"parse", RIFT_COMMAND_PARSE},
-    {NULL, RIFT_COMMAND_UNKNOWN}};
+    {"grep", RIFT_COMMAND_GREP},           {"bench", RIFT_COMMAND_BENCHMARK},
+    {"profile", RIFT_COMMAND_PROFILE},     {"trace", RIFT_COMMAND_TRACE},
+    {"explain", RIFT_COMMAND_EXPLAIN},     {"lint", RIFT_COMMAND_LINT},
+    {"serve", RIFT_COMMAND_SERVE},         {NULL, RIFT_COMMAND_UNKNOWN}};
     {NULL, RIFT_COMMAND_UNKNOWN}};
 
 
@@ -118,13 +128,25 @@ rift_command_factory_create_by_type(rift_command_type_t type)
     case RIFT_COMMAND_VISUALIZE:
         return NULL; /* Not implemented yet */
     case RIFT_COMMAND_BENCHMARK:
-        return NULL; /* Not implemented yet */
+        return rift_bench_command_create();
     case RIFT_COMMAND_AST:
         return rift_ast_command_create();
     case RIFT_COMMAND_PARSE:
         return NULL; /* Not implemented yet */
     case RIFT_COMMAND_CONFIG:
         return NULL; /* Not implemented yet */
+    case RIFT_COMMAND_GREP:
+        return rift_grep_command_create();
+    case RIFT_COMMAND_PROFILE:
+        return rift_profile_command_create();
+    case RIFT_COMMAND_TRACE:
+        return rift_trace_command_create();
+    case RIFT_COMMAND_EXPLAIN:
+        return rift_explain_command_create();
+    case RIFT_COMMAND_LINT:
+        return rift_lint_command_create();
+    case RIFT_COMMAND_SERVE:
+        return rift_serve_command_create();
     case RIFT_COMMAND_UNKNOWN:
     default:
         return NULL; /* Unknown command type */
@@ -29,7 +29,9 @@ ommand/compile_command.h"/a #include "runtime/pattern_complexity_strategy.h"
  * @brief Compile command implementation for LibRift CLI
  *
  * This file implements the compile command, which compiles a regex pattern
- * and optionally saves it to a file for later use.
+ * and optionally saves it to a file for later use. In batch mode it compiles
+ * the rulesets and pattern lists of a directory or manifest in one process,
+ * on a pool of workers, through the build cache.
  *
  * @copyright Copyright (c) 2025 LibRift Project
  * @license MIT License
@@ -37,6 +39,21 @@ ommand/compile_command.h"/a #include "runtime/pattern_complexity_strategy.h"
 
 ommand/compile_command.h"/a #include "core/errors/regex_error.h"
 #include "librift/cli/commands/compile_command.h"
+#include <dirent.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/stat.h>
+#include "core/automaton/dfa_codegen.h"
+#include "core/automaton/hopcroft.h"
+#include "core/dsl/rift_dsl_compiler.h"
+#include "core/dsl/rift_dsl_io.h"
+#include "core/runtime/matcher.h"
+
+/**
+ * @brief Prefix of the generated C names when --emit-prefix is not given
+ */
+#define RIFT_COMPILE_EMIT_C_DEFAULT_PREFIX "rift_pattern"
 
 ommand/compile_command.h"/a #include "runtime/pattern_complexity_strategy.h"
 ommand/compile_command.h"/a #include "runtime/pattern_complexity_strategy.h"
@@ -62,6 +79,13 @@ rift_compile_command_create(void)
     /* Initialize options with defaults */
     cmd->options.pattern = NULL;
     cmd->options.output_file = NULL;
+    cmd->options.emit_c_file = NULL;
+    cmd->options.emit_c_prefix = NULL;
+    cmd->options.batch = false;
+    cmd->options.jobs = 0;
+    cmd->options.output_dir = NULL;
+    cmd->options.cache_dir = NULL;
+    cmd->options.prune_redundant = false;
     cmd->options.use_rift_syntax = false;
     cmd->options.optimize = true;
     cmd->options.use_dfa = true;
@@ -166,7 +190,7 @@ rift_compile_command_set_options(rift_command_t *command, const rift_compile_opt
 
     rift_compile_command_t *cmd = (rift_compile_command_t *)command;
 
-    /* Free existing pattern and output_file if present */
+    /* Free existing pattern and file names if present */
     if (cmd->options.pattern) {
         rift_free(cmd->options.pattern);
     }
@@ -175,6 +199,15 @@ rift_compile_command_set_options(rift_command_t *command, const rift_compile_opt
         rift_free(cmd->options.output_file);
     }
 
+    rift_free(cmd->options.emit_c_file);
+    rift_free(cmd->options.emit_c_prefix);
+    rift_free(cmd->options.output_dir);
+    rift_free(cmd->options.cache_dir);
+    cmd->options.emit_c_file = NULL;
+    cmd->options.emit_c_prefix = NULL;
+    cmd->options.output_dir = NULL;
+    cmd->options.cache_dir = NULL;
+
     /* Copy pattern if present */
     if (options->pattern) {
         cmd->options.pattern = rift_strdup(options->pattern);
@@ -197,7 +230,46 @@ rift_compile_command_set_options(rift_command_t *command, const rift_compile_opt
         cmd->options.output_file = NULL;
     }
 
+    /* Copy the code generation settings if present */
+    if (options->emit_c_file) {
+        cmd->options.emit_c_file = rift_strdup(options->emit_c_file);
+    }
+    if (options->emit_c_prefix) {
+        cmd->options.emit_c_prefix = rift_strdup(options->emit_c_prefix);
+    }
+    if ((options->emit_c_file && !cmd->options.emit_c_file) ||
+        (options->emit_c_prefix && !cmd->options.emit_c_prefix)) {
+        rift_free(cmd->options.emit_c_prefix);
+        cmd->options.emit_c_prefix = NULL;
+        rift_free(cmd->options.emit_c_file);
+        rift_free(cmd->options.pattern);
+        rift_free(cmd->options.output_file);
+        cmd->options.emit_c_file = NULL;
+        cmd->options.pattern = NULL;
+        cmd->options.output_file = NULL;
+        return false;
+    }
+
+    /* Copy the batch directories if present */
+    if (options->output_dir) {
+        cmd->options.output_dir = rift_strdup(options->output_dir);
+    }
+    if (options->cache_dir) {
+        cmd->options.cache_dir = rift_strdup(options->cache_dir);
+    }
+    if ((options->output_dir && !cmd->options.output_dir) ||
+        (options->cache_dir && !cmd->options.cache_dir)) {
+        rift_free(cmd->options.output_dir);
+        rift_free(cmd->options.cache_dir);
+        cmd->options.output_dir = NULL;
+        cmd->options.cache_dir = NULL;
+        return false;
+    }
+
     /* Copy the rest of the options */
+    cmd->options.batch = options->batch;
+    cmd->options.jobs = options->jobs;
+    cmd->options.prune_redundant = options->prune_redundant;
     cmd->options.use_rift_syntax = options->use_rift_syntax;
     cmd->options.optimize = options->optimize;
     cmd->options.use_dfa = options->use_dfa;
@@ -210,6 +282,637 @@ rift_compile_command_set_options(rift_command_t *command, const rift_compile_opt
 
 ommand/compile_command.h"/a #include "runtime/pattern_complexity_strategy.h"
 ommand/compile_command.h"/a #include "runtime/pattern_complexity_strategy.h"
+/**
+ * @brief Write the DFA of a compiled pattern as standalone C source
+ *
+ * NFAs are determinized first, and the DFA is minimized unless optimization
+ * is disabled, so the emitted tables are as small as the engine can make them.
+ *
+ * @param cmd The compile command
+ * @param pattern The compiled pattern
+ * @return true if successful, false otherwise
+ */
+static bool
+emit_c_source(const rift_compile_command_t *cmd, const rift_regex_pattern_t *pattern)
+{
+    rift_regex_error_t error;
+    rift_regex_error_init(&error);
+
+    const rift_regex_automaton_t *automaton = rift_regex_pattern_get_automaton(pattern);
+    if (!automaton) {
+        fprintf(stderr, "Error: Pattern has no automaton to generate code from\n");
+        return false;
+    }
+
+    rift_regex_automaton_t *dfa = NULL;
+    if (!automaton->is_deterministic) {
+        dfa = rift_automaton_nfa_to_dfa(automaton, &error);
+        if (!dfa) {
+            fprintf(stderr, "Error: DFA conversion failed: %s\n", rift_regex_error_message(&error));
+            return false;
+        }
+        automaton = dfa;
+    }
+
+    if (cmd->options.optimize) {
+        rift_regex_automaton_t *minimal = rift_hopcroft_minimize(automaton, &error);
+        if (!minimal) {
+            fprintf(stderr, "Error: DFA minimization failed: %s\n",
+                    rift_regex_error_message(&error));
+            rift_automaton_free(dfa);
+            return false;
+        }
+        rift_automaton_free(dfa);
+        dfa = minimal;
+        automaton = dfa;
+    }
+
+    rift_dfa_table_t *table = rift_dfa_table_compile(automaton, &error);
+    rift_automaton_free(dfa);
+    if (!table) {
+        fprintf(stderr, "Error: DFA table compilation failed: %s\n",
+                rift_regex_error_message(&error));
+        return false;
+    }
+
+    const char *prefix = cmd->options.emit_c_prefix;
+    if (!prefix) {
+        prefix = RIFT_COMPILE_EMIT_C_DEFAULT_PREFIX;
+    }
+
+    if (cmd->verbose) {
+        printf("Writing C source to file: %s (%u states, prefix %s)\n", cmd->options.emit_c_file,
+               table->num_states, prefix);
+    }
+
+    FILE *file = fopen(cmd->options.emit_c_file, "w");
+    if (!file) {
+        fprintf(stderr, "Error: Failed to open output file: %s\n", cmd->options.emit_c_file);
+        rift_dfa_table_free(table);
+        return false;
+    }
+
+    /* A space keeps a "*" "/" pair in the pattern from closing the comment */
+    fputs("/* Pattern: ", file);
+    for (const char *c = cmd->options.pattern; *c; c++) {
+        fputc(*c, file);
+        if (c[0] == '*' && c[1] == '/') {
+            fputc(' ', file);
+        }
+    }
+    fputs(" */\n", file);
+    bool emitted = rift_dfa_table_emit_c(table, prefix, file, &error);
+    rift_dfa_table_free(table);
+
+    if (fclose(file) != 0 || !emitted) {
+        fprintf(stderr, "Error: Failed to write C source: %s\n",
+                emitted ? cmd->options.emit_c_file : rift_regex_error_message(&error));
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief A file of a batch compilation
+ */
+typedef struct {
+    char *source_path;              /**< .rift ruleset or pattern list */
+    char *output_path;              /**< Container written */
+    bool is_rift;                   /**< Whether the file is DSL source rather than patterns */
+    bool ok;                        /**< Whether the container was written */
+    bool cached;                    /**< Whether the container came from the build cache */
+    rift_dsl_compile_stats_t stats; /**< Stage timings of the compilation */
+    uint64_t read_ns;               /**< Reading the file */
+    uint64_t write_ns;              /**< Writing the container */
+    char error[256];                /**< Why the file failed */
+} compile_batch_file_t;
+
+/**
+ * @brief Files of a batch compilation and the state shared by its workers
+ */
+typedef struct {
+    compile_batch_file_t *files; /**< Files, in the order they were found */
+    size_t num_files;            /**< Number of files */
+    size_t capacity;             /**< Allocated files */
+    const char *output_dir;      /**< Root of the containers, NULL to write beside the sources */
+    size_t threads_per_file;     /**< Threads each compilation runs on */
+    bool prune_redundant;        /**< Whether redundant rules are left out */
+    atomic_size_t next;          /**< Next file to compile */
+} compile_batch_t;
+
+/**
+ * @brief Check whether a path ends with a suffix
+ *
+ * @param path The path
+ * @param suffix The suffix
+ * @return true if it does, false otherwise
+ */
+static bool
+has_suffix(const char *path, const char *suffix)
+{
+    size_t length = strlen(path);
+    size_t suffix_length = strlen(suffix);
+    return length >= suffix_length && strcmp(path + length - suffix_length, suffix) == 0;
+}
+
+/**
+ * @brief Add a file to a batch
+ *
+ * The container takes the name of the source with a .rbc extension, beside
+ * it or at the same relative path under the output directory. Sources
+ * outside the root they were found from go to the top of that directory.
+ *
+ * @param batch The batch
+ * @param path Path of the source
+ * @param relative Path of the source relative to its directory or manifest
+ * @return true if successful, false on allocation failure
+ */
+static bool
+batch_add_file(compile_batch_t *batch, const char *path, const char *relative)
+{
+    if (batch->num_files == batch->capacity) {
+        size_t grown = batch->capacity ? batch->capacity * 2 : 64;
+        compile_batch_file_t *files = rift_realloc(batch->files, grown * sizeof(*files));
+        if (!files) {
+            return false;
+        }
+        batch->files = files;
+        batch->capacity = grown;
+    }
+
+    const char *name = path;
+    if (batch->output_dir && relative[0] == '\0') {
+        /* A file given by itself goes to the top of the output directory */
+        const char *base = strrchr(path, '/');
+        name = base ? base + 1 : path;
+    } else if (batch->output_dir) {
+        bool outside = relative[0] == '/' || strncmp(relative, "../", 3) == 0 ||
+                       strstr(relative, "/../") != NULL;
+        const char *base = strrchr(relative, '/');
+        name = outside && base ? base + 1 : relative;
+    }
+    const char *dot = strrchr(name, '.');
+    const char *slash = strrchr(name, '/');
+    size_t stem = dot && (!slash || dot > slash) ? (size_t)(dot - name) : strlen(name);
+
+    size_t length = (batch->output_dir ? strlen(batch->output_dir) + 1 : 0) + stem + 5;
+    char *output = rift_malloc(length);
+    char *source = rift_strdup(path);
+    if (!output || !source) {
+        rift_free(output);
+        rift_free(source);
+        return false;
+    }
+    if (batch->output_dir) {
+        snprintf(output, length, "%s/%.*s.rbc", batch->output_dir, (int)stem, name);
+    } else {
+        snprintf(output, length, "%.*s.rbc", (int)stem, name);
+    }
+
+    compile_batch_file_t *file = &batch->files[batch->num_files++];
+    memset(file, 0, sizeof(*file));
+    file->source_path = source;
+    file->output_path = output;
+    file->is_rift = has_suffix(path, ".rift");
+    return true;
+}
+
+/**
+ * @brief Add the .rift rulesets and .re pattern lists under a directory to a batch
+ *
+ * Hidden entries and symbolic links are skipped.
+ *
+ * @param batch The batch
+ * @param path Directory or file visited
+ * @param relative Path of the entry relative to the directory searched
+ * @return true if successful, false on allocation failure
+ */
+static bool
+batch_collect_directory(compile_batch_t *batch, const char *path, const char *relative)
+{
+    struct stat st;
+    if (lstat(path, &st) != 0) {
+        return true;
+    }
+
+    if (S_ISREG(st.st_mode)) {
+        if (!has_suffix(path, ".rift") && !has_suffix(path, ".re")) {
+            return true;
+        }
+        return batch_add_file(batch, path, relative);
+    }
+
+    if (!S_ISDIR(st.st_mode)) {
+        return true;
+    }
+
+    DIR *dir = opendir(path);
+    if (!dir) {
+        fprintf(stderr, "Error: Cannot read directory %s\n", path);
+        return true;
+    }
+
+    bool ok = true;
+    size_t path_length = strlen(path);
+    size_t relative_length = strlen(relative);
+    struct dirent *entry;
+    while (ok && (entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+        size_t name_length = strlen(entry->d_name);
+        char *child = rift_malloc(path_length + name_length + 2);
+        char *child_relative = rift_malloc(relative_length + name_length + 2);
+        if (!child || !child_relative) {
+            rift_free(child);
+            rift_free(child_relative);
+            ok = false;
+            break;
+        }
+        bool slash = path_length > 0 && path[path_length - 1] == '/';
+        snprintf(child, path_length + name_length + 2, slash ? "%s%s" : "%s/%s", path,
+                 entry->d_name);
+        snprintf(child_relative, relative_length + name_length + 2,
+                 relative_length ? "%s/%s" : "%s%s", relative, entry->d_name);
+        ok = batch_collect_directory(batch, child, child_relative);
+        rift_free(child);
+        rift_free(child_relative);
+    }
+
+    closedir(dir);
+    return ok;
+}
+
+/**
+ * @brief Add the files listed in a manifest to a batch
+ *
+ * The manifest lists one file per line; blank lines and lines starting
+ * with '#' are skipped. Relative paths are taken from the manifest's
+ * directory.
+ *
+ * @param batch The batch
+ * @param manifest Path of the manifest
+ * @return true if successful, false if the manifest cannot be read
+ */
+static bool
+batch_collect_manifest(compile_batch_t *batch, const char *manifest)
+{
+    FILE *file = fopen(manifest, "r");
+    if (!file) {
+        fprintf(stderr, "Error: Cannot open manifest %s\n", manifest);
+        return false;
+    }
+
+    const char *slash = strrchr(manifest, '/');
+    size_t dir_length = slash ? (size_t)(slash - manifest) + 1 : 0;
+
+    bool ok = true;
+    char *line = NULL;
+    size_t line_capacity = 0;
+    ssize_t read;
+    while (ok && (read = getline(&line, &line_capacity, file)) != -1) {
+        while (read > 0 && (line[read - 1] == '\n' || line[read - 1] == '\r' ||
+                            line[read - 1] == ' ' || line[read - 1] == '\t')) {
+            line[--read] = '\0';
+        }
+        char *entry = line;
+        while (*entry == ' ' || *entry == '\t') {
+            entry++;
+        }
+        if (*entry == '\0' || *entry == '#') {
+            continue;
+        }
+
+        size_t length = (entry[0] == '/' ? 0 : dir_length) + strlen(entry) + 1;
+        char *path = rift_malloc(length);
+        if (!path) {
+            ok = false;
+            break;
+        }
+        snprintf(path, length, "%.*s%s", entry[0] == '/' ? 0 : (int)dir_length, manifest, entry);
+        ok = batch_add_file(batch, path, entry);
+        rift_free(path);
+    }
+
+    free(line);
+    fclose(file);
+    return ok;
+}
+
+/**
+ * @brief Read a source file whole, NUL-terminated
+ *
+ * @param path Path of the file
+ * @return The contents, to be freed with rift_free, or NULL on failure
+ */
+static char *
+batch_read_source(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return NULL;
+    }
+
+    char *contents = NULL;
+    struct stat st;
+    if (fstat(fileno(file), &st) == 0 && S_ISREG(st.st_mode)) {
+        size_t size = (size_t)st.st_size;
+        contents = rift_malloc(size + 1);
+        if (contents && fread(contents, 1, size, file) == size) {
+            contents[size] = '\0';
+        } else {
+            rift_free(contents);
+            contents = NULL;
+        }
+    }
+
+    fclose(file);
+    return contents;
+}
+
+/**
+ * @brief Turn a pattern list into .rift source
+ *
+ * Each non-blank line that does not start with '#' becomes a pattern named
+ * after its line number. Quotes, which cannot appear in a DSL string, are
+ * written as the \x22 escape of the regex syntax.
+ *
+ * @param patterns The pattern list
+ * @return The source, to be freed with rift_free, or NULL on allocation failure
+ */
+static char *
+batch_patterns_to_source(const char *patterns)
+{
+    /* The worst case escapes every byte and adds a header per line */
+    size_t lines = 1;
+    size_t length = 0;
+    for (const char *c = patterns; *c; c++) {
+        lines += *c == '\n';
+        length++;
+    }
+    size_t capacity = length * 4 + lines * 48 + 1;
+    char *source = rift_malloc(capacity);
+    if (!source) {
+        return NULL;
+    }
+
+    size_t written = 0;
+    size_t number = 0;
+    const char *line = patterns;
+    while (*line) {
+        const char *end = strchr(line, '\n');
+        if (!end) {
+            end = line + strlen(line);
+        }
+        number++;
+
+        const char *last = end;
+        while (last > line && (last[-1] == '\r' || last[-1] == ' ' || last[-1] == '\t')) {
+            last--;
+        }
+        if (last > line && line[0] != '#') {
+            written += (size_t)snprintf(source + written, capacity - written,
+                                        "@pattern L%zu = \"", number);
+            for (const char *c = line; c < last; c++) {
+                if (*c == '\\' && c + 1 < last && c[1] == '"') {
+                    c++; /* An escaped quote is the quote as well */
+                }
+                if (*c == '"') {
+                    memcpy(source + written, "\\x22", 4);
+                    written += 4;
+                    continue;
+                }
+                if (*c == '\\' && c + 1 < last) {
+                    source[written++] = *c++;
+                }
+                source[written++] = *c;
+            }
+            source[written++] = '"';
+            source[written++] = '\n';
+        }
+
+        line = *end ? end + 1 : end;
+    }
+    source[written] = '\0';
+
+    return source;
+}
+
+/**
+ * @brief Create the directories leading to a file
+ *
+ * @param path Path of the file
+ * @return true if they exist, false otherwise
+ */
+static bool
+make_parent_dirs(const char *path)
+{
+    char *copy = rift_strdup(path);
+    if (!copy) {
+        return false;
+    }
+
+    bool ok = true;
+    for (char *c = copy + 1; ok && *c; c++) {
+        if (*c == '/') {
+            *c = '\0';
+            ok = mkdir(copy, 0755) == 0 || errno == EEXIST;
+            *c = '/';
+        }
+    }
+
+    rift_free(copy);
+    return ok;
+}
+
+/**
+ * @brief Compile one file of a batch to its container
+ *
+ * @param batch The batch
+ * @param file The file
+ */
+static void
+batch_compile_file(compile_batch_t *batch, compile_batch_file_t *file)
+{
+    uint64_t begin = rift_matcher_monotonic_ns();
+    char *contents = batch_read_source(file->source_path);
+    char *source = contents;
+    if (contents && !file->is_rift) {
+        source = batch_patterns_to_source(contents);
+        rift_free(contents);
+        contents = source;
+    }
+    file->read_ns = rift_matcher_monotonic_ns() - begin;
+    if (!source) {
+        snprintf(file->error, sizeof(file->error), "Cannot read the file");
+        return;
+    }
+
+    rift_dsl_compile_options_t options = {0};
+    options.num_threads = batch->threads_per_file;
+    options.stats = &file->stats;
+    options.prune_redundant = batch->prune_redundant;
+    void *container = rift_dsl_compile_to_container_with_options(source, &options);
+    rift_free(contents);
+
+    const char *error = container ? rift_dsl_binary_get_error(container) : "Compilation failed";
+    if (error) {
+        snprintf(file->error, sizeof(file->error), "%s", error);
+        rift_dsl_binary_free(container);
+        return;
+    }
+    file->cached = rift_dsl_binary_is_cached(container);
+
+    begin = rift_matcher_monotonic_ns();
+    if (!make_parent_dirs(file->output_path) ||
+        !rift_dsl_binary_save(container, file->output_path)) {
+        snprintf(file->error, sizeof(file->error), "Cannot write %s", file->output_path);
+    } else {
+        file->ok = true;
+    }
+    file->write_ns = rift_matcher_monotonic_ns() - begin;
+
+    rift_dsl_binary_free(container);
+}
+
+/**
+ * @brief Worker compiling the files of a batch until none is left
+ *
+ * @param arg The batch
+ * @return NULL
+ */
+static void *
+batch_worker(void *arg)
+{
+    compile_batch_t *batch = (compile_batch_t *)arg;
+    size_t index;
+    while ((index = atomic_fetch_add(&batch->next, 1)) < batch->num_files) {
+        batch_compile_file(batch, &batch->files[index]);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Convert nanoseconds to milliseconds for printing
+ */
+static double
+ns_to_ms(uint64_t ns)
+{
+    return (double)ns / 1e6;
+}
+
+/**
+ * @brief Compile every ruleset and pattern list of a directory or manifest
+ *
+ * Files are shared out to the workers; with fewer files than jobs, each
+ * compilation gets the spare threads instead. Containers from the build
+ * cache skip compiling. The stage timings of each file are printed in the
+ * order the files were found once all are done.
+ *
+ * @param cmd The compile command
+ * @return 0 if every file was compiled, 1 otherwise
+ */
+static int
+compile_batch(const rift_compile_command_t *cmd)
+{
+    const rift_compile_options_t *options = &cmd->options;
+
+    if (options->cache_dir && !rift_dsl_set_cache_dir(options->cache_dir)) {
+        fprintf(stderr, "Error: Cannot use cache directory %s\n", options->cache_dir);
+        return 1;
+    }
+
+    compile_batch_t batch;
+    memset(&batch, 0, sizeof(batch));
+    batch.output_dir = options->output_dir;
+    batch.prune_redundant = options->prune_redundant;
+    atomic_init(&batch.next, 0);
+
+    uint64_t begin = rift_matcher_monotonic_ns();
+    const char *input = options->pattern;
+    bool collected = input[0] == '@' ? batch_collect_manifest(&batch, input + 1)
+                                     : batch_collect_directory(&batch, input, "");
+    int result = 0;
+    if (!collected) {
+        result = 1;
+    } else if (batch.num_files == 0) {
+        fprintf(stderr, "Error: No .rift or .re files found in %s\n", input);
+        result = 1;
+    }
+
+    size_t jobs = options->jobs;
+    if (jobs == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        jobs = cpus > 0 ? (size_t)cpus : 1;
+    }
+    size_t num_workers = jobs < batch.num_files ? jobs : batch.num_files;
+    batch.threads_per_file = num_workers ? jobs / num_workers : 1;
+
+    /* The caller works too, so one thread fewer is started */
+    pthread_t *threads = NULL;
+    size_t started = 0;
+    if (result == 0 && num_workers > 1) {
+        threads = rift_malloc((num_workers - 1) * sizeof(*threads));
+        for (; threads && started < num_workers - 1; started++) {
+            if (pthread_create(&threads[started], NULL, batch_worker, &batch) != 0) {
+                break;
+            }
+        }
+    }
+    if (result == 0) {
+        batch_worker(&batch);
+    }
+    for (size_t i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    rift_free(threads);
+    uint64_t wall_ns = rift_matcher_monotonic_ns() - begin;
+
+    size_t compiled = 0;
+    size_t cached = 0;
+    size_t failed = 0;
+    for (size_t i = 0; i < batch.num_files; i++) {
+        const compile_batch_file_t *file = &batch.files[i];
+        if (!file->ok) {
+            fprintf(stderr, "Error: %s: %s\n", file->source_path, file->error);
+            failed++;
+        } else if (file->cached) {
+            cached++;
+            if (!cmd->quiet) {
+                printf("%s -> %s: cached (read %.2f ms, write %.2f ms)\n", file->source_path,
+                       file->output_path, ns_to_ms(file->read_ns), ns_to_ms(file->write_ns));
+            }
+        } else {
+            compiled++;
+            if (!cmd->quiet) {
+                const rift_dsl_compile_stats_t *stats = &file->stats;
+                printf("%s -> %s: %zu patterns (read %.2f ms, parse %.2f ms, patterns %.2f ms, "
+                       "counters %.2f ms, codegen %.2f ms, compile %.2f ms, write %.2f ms)\n",
+                       file->source_path, file->output_path, stats->num_patterns,
+                       ns_to_ms(file->read_ns), ns_to_ms(stats->parse_ns),
+                       ns_to_ms(stats->pattern_ns), ns_to_ms(stats->counters_ns),
+                       ns_to_ms(stats->codegen_ns), ns_to_ms(stats->compile_ns),
+                       ns_to_ms(file->write_ns));
+            }
+        }
+        rift_free(file->source_path);
+        rift_free(file->output_path);
+    }
+    rift_free(batch.files);
+
+    if (!cmd->quiet) {
+        printf("%zu compiled, %zu cached, %zu failed in %.2f ms on %zu jobs\n", compiled, cached,
+               failed, ns_to_ms(wall_ns), jobs);
+    }
+
+    if (options->cache_dir) {
+        rift_dsl_set_cache_dir(NULL);
+    }
+
+    return result == 0 && failed == 0 ? 0 : 1;
+}
+
 /**
  * @brief Execute the compile command
  *
@@ -231,6 +934,10 @@ rift_command_execute(rift_command_t *command)
         return 1;
     }
 
+    if (cmd->options.batch) {
+        return compile_batch(cmd);
+    }
+
     /* Apply options to flags */
     if (cmd->options.optimize) {
         /* Skip optimization flag for now */
@@ -291,6 +998,12 @@ rift_command_execute(rift_command_t *command)
         printf("Automaton visualization not implemented yet.\n");
     }
 
+    /* Generate C source if requested */
+    if (cmd->options.emit_c_file && !emit_c_source(cmd, pattern)) {
+        rift_regex_pattern_free(pattern);
+        return 1;
+    }
+
     /* Save to file if specified */
     if (cmd->options.output_file) {
         /* In a real implementation, we would serialize the pattern to the file */
@@ -339,14 +1052,22 @@ rift_command_get_help(const rift_command_t *command)
 
     if (type == RIFT_COMMAND_COMPILE) {
         return "compile <pattern> [options]\n"
+               "compile <directory|@manifest> [--jobs <n>] [batch options]\n"
                "\n"
-               "Compile a regular expression pattern for later use.\n"
+               "Compile a regular expression pattern for later use, or in batch mode\n"
+               "every .rift ruleset and .re pattern list (one pattern per line) of a\n"
+               "directory or manifest to a mappable .rbc container, printing the time\n"
+               "each file spent in each stage.\n"
                "\n"
                "Arguments:\n"
                "  <pattern>                     Regex pattern to compile\n"
+               "  <directory>                   Directory searched for .rift and .re files\n"
+               "  @<manifest>                   File listing the files to compile, one per line\n"
                "\n"
                "Options:\n"
                "  --output, -o <file>           Save compiled pattern to a file\n"
+               "  --emit-c <file>               Write the DFA as standalone C source\n"
+               "  --emit-prefix <name>          Prefix of the generated C names\n"
                "  --rift                        Enable LibRift r'' syntax\n"
                "  --no-optimize                 Disable automaton optimization\n"
                "  --nfa                         Force NFA mode (no DFA conversion)\n"
@@ -357,10 +1078,20 @@ rift_command_get_help(const rift_command_t *command)
                "  --dotall, -s                  . matches newline\n"
                "  --extended, -x                Ignore whitespace in pattern\n"
                "\n"
+               "Batch options:\n"
+               "  --jobs, -j <n>                Files compiled at once (default: one per CPU)\n"
+               "  --output-dir <dir>            Write containers under a directory instead of\n"
+               "                                beside their sources\n"
+               "  --cache-dir <dir>             Reuse containers of unchanged sources\n"
+               "  --prune-redundant             Leave out rules that duplicate an earlier rule\n"
+               "                                or match nothing another rule does not match\n"
+               "\n"
                "Examples:\n"
                "  librift compile \"a(b|c)*\" --output pattern.rre\n"
                "  librift compile r'a(b|c)*' --rift --no-optimize\n"
-               "  librift compile \"[0-9]+\" -i -o numbers.rre";
+               "  librift compile \"[0-9]+\" -i -o numbers.rre\n"
+               "  librift compile \"[0-9]+\" --emit-c numbers.c --emit-prefix numbers\n"
+               "  librift compile rules/ -j 16 --output-dir build/rules --cache-dir .rift-cache";
     }
 
     return "Error: Unknown command type";
@@ -391,6 +1122,11 @@ rift_command_free(rift_command_t *command)
         rift_free(cmd->options.output_file);
     }
 
+    rift_free(cmd->options.emit_c_file);
+    rift_free(cmd->options.emit_c_prefix);
+    rift_free(cmd->options.output_dir);
+    rift_free(cmd->options.cache_dir);
+
     /* Free the command itself */
     rift_free(command);
 }
@@ -429,6 +1165,12 @@ rift_command_parse_args(rift_command_t *command, int argc, char *argv[])
         return false;
     }
 
+    /* A directory or @manifest is compiled in batch mode */
+    struct stat st;
+    if (argv[0][0] == '@' || (stat(argv[0], &st) == 0 && S_ISDIR(st.st_mode))) {
+        cmd->options.batch = true;
+    }
+
     /* Check if pattern uses LibRift r'' syntax */
     if (cmd->options.pattern[0] == 'r' &&
         (cmd->options.pattern[1] == '\'' || cmd->options.pattern[1] == '"')) {
@@ -453,6 +1195,59 @@ rift_command_parse_args(rift_command_t *command, int argc, char *argv[])
                 }
                 return false;
             }
+        } else if (strcmp(argv[i], "--emit-c") == 0 || strcmp(argv[i], "--emit-prefix") == 0) {
+            /* Generated C source file or name prefix */
+            bool is_file = strcmp(argv[i], "--emit-c") == 0;
+            if (i + 1 >= argc) {
+                if (!cmd->quiet) {
+                    fprintf(stderr, "Error: Missing argument for %s option.\n", argv[i]);
+                }
+                return false;
+            }
+
+            char **target = is_file ? &cmd->options.emit_c_file : &cmd->options.emit_c_prefix;
+            rift_free(*target);
+            *target = rift_strdup(argv[i + 1]);
+            if (!*target) {
+                fprintf(stderr, "Error: Failed to allocate memory for %s\n", argv[i]);
+                return false;
+            }
+            i++; /* Skip the argument value */
+        } else if (strcmp(argv[i], "--jobs") == 0 || strcmp(argv[i], "-j") == 0) {
+            /* Files compiled at once, which implies batch mode */
+            char *end = NULL;
+            unsigned long jobs = i + 1 < argc ? strtoul(argv[i + 1], &end, 10) : 0;
+            if (i + 1 >= argc || end == argv[i + 1] || *end != '\0') {
+                if (!cmd->quiet) {
+                    fprintf(stderr, "Error: Missing or invalid argument for %s option.\n",
+                            argv[i]);
+                }
+                return false;
+            }
+            cmd->options.jobs = (size_t)jobs;
+            cmd->options.batch = true;
+            i++; /* Skip the argument value */
+        } else if (strcmp(argv[i], "--output-dir") == 0 || strcmp(argv[i], "--cache-dir") == 0) {
+            /* Directory of the batch containers or of the build cache */
+            bool is_output = strcmp(argv[i], "--output-dir") == 0;
+            if (i + 1 >= argc) {
+                if (!cmd->quiet) {
+                    fprintf(stderr, "Error: Missing argument for %s option.\n", argv[i]);
+                }
+                return false;
+            }
+
+            char **target = is_output ? &cmd->options.output_dir : &cmd->options.cache_dir;
+            rift_free(*target);
+            *target = rift_strdup(argv[i + 1]);
+            if (!*target) {
+                fprintf(stderr, "Error: Failed to allocate memory for %s\n", argv[i]);
+                return false;
+            }
+            i++; /* Skip the argument value */
+        } else if (strcmp(argv[i], "--prune-redundant") == 0) {
+            /* Leave duplicate and subsumed rules out of the containers */
+            cmd->options.prune_redundant = true;
         } else if (strcmp(argv[i], "--rift") == 0) {
             /* Enable LibRift r'' syntax */
             cmd->options.use_rift_syntax = true;
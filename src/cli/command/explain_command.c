@@ -0,0 +1,309 @@
+/**
+ * @file explain_command.c
+ * @brief Explain command implementation for LibRift CLI
+ *
+ * This file implements the explain command. The pattern is compiled as the
+ * matcher would get it, and the engine plan and ambiguity verdict recorded
+ * on it are printed, the engines listed in the order a default search tries
+ * them.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "cli/command/explain_command.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/compiler/ambiguity.h"
+#include "core/compiler/engine_plan.h"
+#include "core/compiler/match_length.h"
+#include "core/engine/pattern.h"
+#include "core/errors/regex_error.h"
+#include "core/memory/memory.h"
+#include "core/runtime/execution_tracker.h"
+
+/**
+ * @brief Engines in the order a default search tries them
+ */
+static const rift_match_engine_t EXPLAIN_ORDER[] = {
+    RIFT_MATCH_ENGINE_LAZY_DFA, RIFT_MATCH_ENGINE_BIT_PARALLEL, RIFT_MATCH_ENGINE_ONE_PASS,
+    RIFT_MATCH_ENGINE_TDFA,     RIFT_MATCH_ENGINE_PIKE_VM,      RIFT_MATCH_ENGINE_BACKTRACKER,
+    RIFT_MATCH_ENGINE_BYTECODE_VM};
+
+/** Number of engines listed */
+#define EXPLAIN_ENGINES (sizeof(EXPLAIN_ORDER) / sizeof(*EXPLAIN_ORDER))
+
+/**
+ * @brief Write a string as a JSON string literal
+ */
+static void
+write_json_string(FILE *out, const char *text)
+{
+    fputc('"', out);
+    for (const unsigned char *c = (const unsigned char *)text; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            fprintf(out, "\\%c", *c);
+        } else if (*c < 0x20) {
+            fprintf(out, "\\u%04x", *c);
+        } else {
+            fputc(*c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+/**
+ * @brief Write the plan as a table
+ */
+static void
+write_text(FILE *out, const char *source, const rift_engine_plan_t *plan,
+           const rift_ambiguity_verdict_t *verdict, const rift_match_length_bounds_t *length)
+{
+    fprintf(out, "Pattern:   %s\n", source);
+    fprintf(out, "Engine:    %s (%s)\n", rift_match_engine_name(plan->engine),
+            rift_engine_plan_get_reason(plan, plan->engine));
+    fprintf(out, "Ambiguity: %s", rift_ambiguity_to_string(verdict->ambiguity));
+    if (verdict->ambiguity == RIFT_AMBIGUITY_POLYNOMIAL) {
+        fprintf(out, ", degree %u", verdict->degree);
+    }
+    if (verdict->nested_quantifiers > 0) {
+        fprintf(out, ", %u nested quantifiers", verdict->nested_quantifiers);
+    }
+    fprintf(out, "\nStates:    %zu, %zu capture groups\n", plan->num_states,
+            plan->group_count);
+    if (rift_match_length_is_bounded(length)) {
+        fprintf(out, "Length:    %zu to %zu bytes\n", length->min, length->max);
+    } else {
+        fprintf(out, "Length:    %zu bytes or more\n", length->min);
+    }
+    fprintf(out, "Search:    %s (%s)\n\n", rift_search_strategy_name(plan->search),
+            plan->search_reason);
+
+    for (size_t i = 0; i < EXPLAIN_ENGINES; i++) {
+        rift_match_engine_t engine = EXPLAIN_ORDER[i];
+        char mark = engine == plan->engine ? '*' : plan->usable[engine] ? '+' : '-';
+        fprintf(out, "  %c %-17s %s\n", mark, rift_match_engine_name(engine),
+                rift_engine_plan_get_reason(plan, engine));
+    }
+}
+
+/**
+ * @brief Write the plan as one JSON document
+ */
+static void
+write_json(FILE *out, const char *source, const rift_engine_plan_t *plan,
+           const rift_ambiguity_verdict_t *verdict, const rift_match_length_bounds_t *length)
+{
+    fputs("{\n  \"pattern\": ", out);
+    write_json_string(out, source);
+    fprintf(out, ",\n  \"engine\": \"%s\",\n  \"states\": %zu,\n  \"groups\": %zu",
+            rift_match_engine_name(plan->engine), plan->num_states, plan->group_count);
+    fprintf(out,
+            ",\n  \"ambiguity\": {\"degree\": \"%s\", \"polynomial_degree\": %u, "
+            "\"nested_quantifiers\": %u, \"backreferences\": %s}",
+            rift_ambiguity_to_string(verdict->ambiguity), verdict->degree,
+            verdict->nested_quantifiers, verdict->has_backreference ? "true" : "false");
+    fprintf(out, ",\n  \"length\": {\"min\": %zu, \"max\": ", length->min);
+    if (rift_match_length_is_bounded(length)) {
+        fprintf(out, "%zu}", length->max);
+    } else {
+        fputs("null}", out);
+    }
+    fprintf(out, ",\n  \"search\": {\"strategy\": \"%s\", \"reason\": ",
+            rift_search_strategy_name(plan->search));
+    write_json_string(out, plan->search_reason);
+    fputc('}', out);
+
+    fputs(",\n  \"engines\": [", out);
+    for (size_t i = 0; i < EXPLAIN_ENGINES; i++) {
+        rift_match_engine_t engine = EXPLAIN_ORDER[i];
+        fprintf(out, "%s\n    {\"name\": \"%s\", \"usable\": %s, \"reason\": ", i ? "," : "",
+                rift_match_engine_name(engine), plan->usable[engine] ? "true" : "false");
+        write_json_string(out, rift_engine_plan_get_reason(plan, engine));
+        fputc('}', out);
+    }
+    fputs("\n  ]\n}\n", out);
+}
+
+/**
+ * @brief Create a new explain command
+ *
+ * @return A new explain command instance or NULL on failure
+ */
+rift_command_t *
+rift_explain_command_create(void)
+{
+    rift_explain_command_t *cmd =
+        (rift_explain_command_t *)rift_malloc(sizeof(rift_explain_command_t));
+    if (!cmd) {
+        return NULL;
+    }
+
+    memset(cmd, 0, sizeof(*cmd));
+    cmd->type = RIFT_COMMAND_EXPLAIN;
+    cmd->options.flags = 0; /* RIFT_REGEX_FLAG_NONE */
+
+    return (rift_command_t *)cmd;
+}
+
+/**
+ * @brief Get the options for an explain command
+ *
+ * @param command The explain command
+ * @return Pointer to the explain options
+ */
+rift_explain_options_t *
+rift_explain_command_get_options(rift_command_t *command)
+{
+    rift_explain_command_t *cmd = (rift_explain_command_t *)command;
+    if (!cmd || cmd->type != RIFT_COMMAND_EXPLAIN) {
+        return NULL;
+    }
+
+    return &cmd->options;
+}
+
+/**
+ * @brief Parse the arguments of an explain command
+ *
+ * @param command The explain command
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @return true if parsing was successful, false otherwise
+ */
+bool
+rift_explain_command_parse_args(rift_command_t *command, int argc, char *argv[])
+{
+    rift_explain_options_t *options = rift_explain_command_get_options(command);
+    if (!options) {
+        return false;
+    }
+
+    rift_explain_command_t *cmd = (rift_explain_command_t *)command;
+
+    for (int i = 0; i < argc; i++) {
+        const char *arg = argv[i];
+        if (strcmp(arg, "--json") == 0) {
+            options->json = true;
+        } else if (strcmp(arg, "--rift") == 0) {
+            options->flags |= RIFT_REGEX_FLAG_RIFT_SYNTAX;
+        } else if (strcmp(arg, "--case-insensitive") == 0 || strcmp(arg, "-i") == 0) {
+            options->flags |= RIFT_REGEX_FLAG_CASE_INSENSITIVE;
+        } else if (strcmp(arg, "--multiline") == 0 || strcmp(arg, "-m") == 0) {
+            options->flags |= RIFT_REGEX_FLAG_MULTILINE;
+        } else if (strcmp(arg, "--dotall") == 0 || strcmp(arg, "-s") == 0) {
+            options->flags |= RIFT_REGEX_FLAG_DOTALL;
+        } else if (arg[0] == '-' && arg[1] != '\0') {
+            if (!cmd->quiet) {
+                fprintf(stderr, "Warning: Unknown option '%s' ignored.\n", arg);
+            }
+        } else if (!options->pattern) {
+            options->pattern = rift_strdup(arg);
+            if (!options->pattern) {
+                fprintf(stderr, "Error: Failed to allocate memory for arguments\n");
+                return false;
+            }
+        } else if (!cmd->quiet) {
+            fprintf(stderr, "Warning: Extra argument '%s' ignored.\n", arg);
+        }
+    }
+
+    if (!options->pattern) {
+        if (!cmd->quiet) {
+            fprintf(stderr, "Error: A pattern is required.\n");
+        }
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Execute an explain command
+ *
+ * @param command The explain command
+ * @return 0 on success, non-zero on failure
+ */
+int
+rift_explain_command_execute(rift_command_t *command)
+{
+    rift_explain_options_t *options = rift_explain_command_get_options(command);
+    if (!options || !options->pattern) {
+        fprintf(stderr, "Error: No pattern specified\n");
+        return 1;
+    }
+
+    rift_explain_command_t *cmd = (rift_explain_command_t *)command;
+
+    rift_regex_error_t error;
+    rift_regex_error_init(&error);
+    rift_regex_pattern_t *pattern = rift_regex_compile(options->pattern, options->flags, &error);
+    if (!pattern) {
+        fprintf(stderr, "Error: Cannot compile '%s': %s\n", options->pattern,
+                rift_regex_error_message(&error));
+        return 1;
+    }
+
+    if (!cmd->quiet) {
+        const rift_engine_plan_t *plan = rift_regex_pattern_get_engine_plan(pattern);
+        const rift_ambiguity_verdict_t *verdict = rift_regex_pattern_get_ambiguity(pattern);
+        const rift_match_length_bounds_t *length = rift_regex_pattern_get_match_length(pattern);
+        if (options->json) {
+            write_json(stdout, options->pattern, plan, verdict, length);
+        } else {
+            write_text(stdout, options->pattern, plan, verdict, length);
+        }
+    }
+
+    rift_regex_pattern_free(pattern);
+    return 0;
+}
+
+/**
+ * @brief Get help information for an explain command
+ *
+ * @param command The explain command
+ * @return Help string for the command
+ */
+const char *
+rift_explain_command_get_help(const rift_command_t *command)
+{
+    (void)command;
+
+    return "explain <pattern> [options]\n"
+           "\n"
+           "Compile the pattern and print the engine its searches start with, whether\n"
+           "each engine can run it and why, the ambiguity analysis behind the choice and\n"
+           "the fewest and most bytes a match consumes. The chosen engine is marked *,\n"
+           "other usable engines + and the rest -.\n"
+           "\n"
+           "Options:\n"
+           "  --json                   Print the plan as JSON\n"
+           "  --rift                   Enable LibRift r'' syntax\n"
+           "  --case-insensitive, -i   Case insensitive matching\n"
+           "  --multiline, -m          ^ and $ match start/end of line\n"
+           "  --dotall, -s             . matches newline\n"
+           "\n"
+           "Examples:\n"
+           "  librift explain \"(a+)+b\"\n"
+           "  librift explain \"(?<year>\\d{4})-(?<month>\\d{2})\" --json";
+}
+
+/**
+ * @brief Free resources associated with an explain command
+ *
+ * @param command The command to free
+ */
+void
+rift_explain_command_free(rift_command_t *command)
+{
+    rift_explain_options_t *options = rift_explain_command_get_options(command);
+    if (!options) {
+        return;
+    }
+
+    rift_free(options->pattern);
+
+    rift_free(command);
+}
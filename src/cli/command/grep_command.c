@@ -0,0 +1,1257 @@
+/**
+ * @file grep_command.c
+ * @brief Grep command implementation for LibRift CLI
+ *
+ * This file implements the grep command, which searches memory-mapped files
+ * for regex patterns or the rules of a .rift DSL ruleset. Patterns are
+ * searched by the matcher, which picks the literal prefilter and the lazy
+ * DFA where they apply; rulesets by rift_dsl_execute_all, one line at a
+ * time, which scans shards of rules in one pass each. gzip and zstd files
+ * are decompressed on a thread of their own and searched a block of whole
+ * lines at a time as they are.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "cli/command/grep_command.h"
+#include <dirent.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "core/dsl/rift_dsl_compiler.h"
+#include "core/engine/pattern.h"
+#include "core/errors/regex_error.h"
+#include "core/memory/memory.h"
+#include "core/runtime/decompress_stream.h"
+#include "core/runtime/file_reader.h"
+#include "core/runtime/matcher.h"
+
+/**
+ * @brief Exit status when nothing matched, as with grep
+ */
+#define RIFT_GREP_NO_MATCH 1
+
+/**
+ * @brief Exit status on errors, as with grep
+ */
+#define RIFT_GREP_ERROR 2
+
+/**
+ * @brief Longest line of a compressed file searched whole; longer ones are cut
+ */
+#define RIFT_GREP_MAX_LINE (64 * 1024 * 1024)
+
+/**
+ * @brief One match: a span and the pattern or rule that found it
+ */
+typedef struct grep_record {
+    size_t start; /**< Start of the match, or of the line for a rule */
+    size_t end;   /**< End of the match, or of the line for a rule */
+    size_t label; /**< Index of the pattern or rule */
+} grep_record_t;
+
+/**
+ * @brief Growable array of matches
+ */
+typedef struct grep_records {
+    grep_record_t *items; /**< The matches */
+    size_t count;         /**< Number of matches */
+    size_t capacity;      /**< Capacity of items */
+    bool count_only;      /**< Whether to count the matches without storing them */
+    bool failed;          /**< Whether an allocation failed */
+} grep_records_t;
+
+/**
+ * @brief State of a search shared by every thread
+ */
+typedef struct grep_search {
+    const rift_grep_command_t *cmd; /**< The command */
+    rift_regex_pattern_t **patterns; /**< Compiled patterns, NULL with a ruleset */
+    void *rules;                     /**< Compiled ruleset, NULL with patterns */
+    size_t num_labels;               /**< Number of patterns or rules */
+    char **files;                    /**< Files to search */
+    size_t num_files;                /**< Number of files */
+    bool with_filename;              /**< Whether output lines start with the path */
+    size_t num_threads;              /**< Threads including the caller's */
+    atomic_size_t next_file;         /**< Next file for a worker to take */
+    rift_file_reader_t *reader;      /**< Reads the files ahead of the workers, if any */
+    atomic_bool matched;             /**< Whether any file matched */
+    atomic_bool failed;              /**< Whether any file could not be searched */
+    pthread_mutex_t output_lock;     /**< Keeps the output of each file together */
+} grep_search_t;
+
+/**
+ * @brief A line-aligned chunk of a file searched for a ruleset by one thread
+ */
+typedef struct grep_chunk {
+    const grep_search_t *search; /**< The search */
+    const char *data;            /**< The mapped file */
+    size_t start;                /**< First byte of the chunk */
+    size_t end;                  /**< One past the last byte of the chunk */
+    grep_records_t records;      /**< Matches found in the chunk */
+    pthread_t thread;            /**< Thread searching the chunk */
+    bool threaded;               /**< Whether thread was started */
+} grep_chunk_t;
+
+/**
+ * @brief Line being searched for a ruleset, as seen by the match callback
+ */
+typedef struct grep_rule_line {
+    grep_records_t *records; /**< Where the matches go */
+    size_t start;            /**< Start of the line */
+    size_t end;              /**< End of the line, before its newline */
+} grep_rule_line_t;
+
+/**
+ * @brief Pattern being searched for, as seen by the match callback
+ */
+typedef struct grep_pattern_scan {
+    grep_records_t *records; /**< Where the matches go */
+    size_t label;            /**< Index of the pattern */
+} grep_pattern_scan_t;
+
+/**
+ * @brief Append a match to an array
+ *
+ * @param records The array
+ * @param start Start of the match
+ * @param end End of the match
+ * @param label Index of the pattern or rule
+ * @return true if successful, false if the allocation failed
+ */
+static bool
+records_push(grep_records_t *records, size_t start, size_t end, size_t label)
+{
+    if (records->count_only) {
+        records->count++;
+        return true;
+    }
+
+    if (records->count == records->capacity) {
+        size_t capacity = records->capacity ? records->capacity * 2 : 64;
+        grep_record_t *items = rift_realloc(records->items, capacity * sizeof(*items));
+        if (!items) {
+            records->failed = true;
+            return false;
+        }
+        records->items = items;
+        records->capacity = capacity;
+    }
+
+    records->items[records->count++] = (grep_record_t){start, end, label};
+    return true;
+}
+
+/**
+ * @brief Append the matches of one array to another
+ *
+ * @param records The array appended to
+ * @param other The array appended, left untouched
+ * @return true if successful, false if the allocation failed
+ */
+static bool
+records_append(grep_records_t *records, const grep_records_t *other)
+{
+    if (records->count_only) {
+        records->count += other->count;
+        return true;
+    }
+
+    for (size_t i = 0; i < other->count; i++) {
+        const grep_record_t *record = &other->items[i];
+        if (!records_push(records, record->start, record->end, record->label)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Order matches by position, then by pattern
+ */
+static int
+record_compare(const void *a, const void *b)
+{
+    const grep_record_t *left = a;
+    const grep_record_t *right = b;
+
+    if (left->start != right->start) {
+        return left->start < right->start ? -1 : 1;
+    }
+    if (left->label != right->label) {
+        return left->label < right->label ? -1 : 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Store a match of a pattern
+ */
+static bool
+on_pattern_match(const rift_regex_span_t *spans, size_t num_spans, void *user_data)
+{
+    grep_pattern_scan_t *scan = user_data;
+
+    (void)num_spans;
+    return records_push(scan->records, spans[0].start, spans[0].end, scan->label);
+}
+
+/**
+ * @brief Store a rule matching a line
+ */
+static bool
+on_rule_match(size_t index, void *user_data)
+{
+    grep_rule_line_t *line = user_data;
+
+    return records_push(line->records, line->start, line->end, index);
+}
+
+/**
+ * @brief Search a range of lines for the rules of a ruleset
+ *
+ * @param search The search
+ * @param data The mapped file
+ * @param start First byte of the range, at the start of a line
+ * @param end One past the last byte of the range, at the end of a line
+ * @param records Where the matches go
+ */
+static void
+scan_rule_lines(const grep_search_t *search, const char *data, size_t start, size_t end,
+                grep_records_t *records)
+{
+    grep_rule_line_t line = {records, start, start};
+
+    while (line.start < end && !records->failed) {
+        const char *newline = memchr(data + line.start, '\n', end - line.start);
+        line.end = newline ? (size_t)(newline - data) : end;
+        rift_dsl_execute_all(search->rules, data + line.start, line.end - line.start,
+                             on_rule_match, &line);
+        line.start = line.end + 1;
+    }
+}
+
+/**
+ * @brief Thread body searching one chunk for a ruleset
+ */
+static void *
+chunk_worker(void *arg)
+{
+    grep_chunk_t *chunk = arg;
+
+    scan_rule_lines(chunk->search, chunk->data, chunk->start, chunk->end, &chunk->records);
+    return NULL;
+}
+
+/**
+ * @brief Search a file for a ruleset on every thread of the search
+ *
+ * The file is cut into one chunk per thread at line boundaries, so no line
+ * is split, and the matches of the chunks are joined in file order.
+ *
+ * @param search The search
+ * @param data The mapped file
+ * @param size Size of the file
+ * @param records Where the matches go
+ */
+static void
+scan_rules_parallel(const grep_search_t *search, const char *data, size_t size,
+                    grep_records_t *records)
+{
+    size_t num_chunks = search->num_threads;
+    if (size / RIFT_MATCHER_PARALLEL_MIN_CHUNK < num_chunks) {
+        num_chunks = size / RIFT_MATCHER_PARALLEL_MIN_CHUNK;
+    }
+
+    grep_chunk_t *chunks = NULL;
+    if (num_chunks > 1) {
+        chunks = rift_malloc(num_chunks * sizeof(*chunks));
+    }
+    if (!chunks) {
+        scan_rule_lines(search, data, 0, size, records);
+        return;
+    }
+
+    size_t start = 0;
+    for (size_t i = 0; i < num_chunks; i++) {
+        size_t end = size;
+        if (i + 1 < num_chunks) {
+            end = size / num_chunks * (i + 1);
+            end = end < start ? start : end;
+            const char *newline = memchr(data + end, '\n', size - end);
+            end = newline ? (size_t)(newline - data) + 1 : size;
+        }
+        chunks[i] = (grep_chunk_t){.search = search, .data = data, .start = start, .end = end};
+        chunks[i].records.count_only = records->count_only;
+        start = end;
+    }
+
+    /* The caller searches the first chunk, and any chunk a thread could not be started for */
+    for (size_t i = 1; i < num_chunks; i++) {
+        chunks[i].threaded = pthread_create(&chunks[i].thread, NULL, chunk_worker, &chunks[i]) == 0;
+    }
+    for (size_t i = 0; i < num_chunks; i++) {
+        if (!chunks[i].threaded) {
+            chunk_worker(&chunks[i]);
+        }
+    }
+
+    for (size_t i = 0; i < num_chunks; i++) {
+        if (chunks[i].threaded) {
+            pthread_join(chunks[i].thread, NULL);
+        }
+        if (chunks[i].records.failed || !records_append(records, &chunks[i].records)) {
+            records->failed = true;
+        }
+        rift_free(chunks[i].records.items);
+    }
+
+    rift_free(chunks);
+}
+
+/**
+ * @brief Write a string as a JSON string literal
+ *
+ * @param out The stream
+ * @param text The string
+ * @param length Length of the string
+ */
+static void
+write_json_string(FILE *out, const char *text, size_t length)
+{
+    fputc('"', out);
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = (unsigned char)text[i];
+        if (c == '"' || c == '\\') {
+            fputc('\\', out);
+            fputc(c, out);
+        } else if (c == '\n') {
+            fputs("\\n", out);
+        } else if (c == '\r') {
+            fputs("\\r", out);
+        } else if (c == '\t') {
+            fputs("\\t", out);
+        } else if (c < 0x20 || c == 0x7F) {
+            fprintf(out, "\\u%04x", c);
+        } else {
+            fputc(c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+/**
+ * @brief Write the label of a match in the text output
+ *
+ * Rules are named; patterns are only named when there are several.
+ *
+ * @param search The search
+ * @param out The stream
+ * @param label Index of the pattern or rule
+ */
+static void
+write_label(const grep_search_t *search, FILE *out, size_t label)
+{
+    if (search->rules) {
+        const char *name = rift_dsl_get_compiled_name(search->rules, label);
+        if (name) {
+            fprintf(out, "%s:", name);
+        } else {
+            fprintf(out, "rule%zu:", label);
+        }
+    } else if (search->num_labels > 1) {
+        fprintf(out, "%zu:", label);
+    }
+}
+
+/**
+ * @brief Write the number of matches of one file
+ *
+ * @param search The search
+ * @param out The stream
+ * @param path Path of the file
+ * @param count Number of matches
+ */
+static void
+write_file_count(const grep_search_t *search, FILE *out, const char *path, size_t count)
+{
+    if (search->cmd->options.json) {
+        fputs("{\"path\":", out);
+        write_json_string(out, path, strlen(path));
+        fprintf(out, ",\"count\":%zu}\n", count);
+    } else if (search->with_filename) {
+        fprintf(out, "%s:%zu\n", path, count);
+    } else {
+        fprintf(out, "%zu\n", count);
+    }
+}
+
+/**
+ * @brief Write the output of one file, or of a block of whole lines of it
+ *
+ * @param search The search
+ * @param out The stream
+ * @param path Path of the file
+ * @param data The mapped file or block
+ * @param size Size of the file or block
+ * @param records Matches of the file or block, in file order
+ * @param base_offset Offset of data in the file
+ * @param base_line Number of the line data starts
+ */
+static void
+write_file_output(const grep_search_t *search, FILE *out, const char *path, const char *data,
+                  size_t size, const grep_records_t *records, size_t base_offset,
+                  size_t base_line)
+{
+    const rift_grep_options_t *options = &search->cmd->options;
+
+    if (options->count_only) {
+        write_file_count(search, out, path, records->count);
+        return;
+    }
+
+    /* Line numbers are counted on the way, as the matches are in file order */
+    size_t line_number = base_line;
+    size_t counted_to = 0;
+    size_t printed_to = 0;
+
+    for (size_t i = 0; i < records->count; i++) {
+        const grep_record_t *record = &records->items[i];
+        for (const char *p = data + counted_to;
+             (p = memchr(p, '\n', record->start - (size_t)(p - data))) != NULL; p++) {
+            line_number++;
+        }
+        counted_to = record->start;
+
+        if (options->json) {
+            fputs("{\"path\":", out);
+            write_json_string(out, path, strlen(path));
+            fprintf(out, ",\"line\":%zu,\"start\":%zu,\"end\":%zu,", line_number,
+                    base_offset + record->start, base_offset + record->end);
+            if (search->rules) {
+                const char *name = rift_dsl_get_compiled_name(search->rules, record->label);
+                fputs("\"rule\":", out);
+                if (name) {
+                    write_json_string(out, name, strlen(name));
+                } else {
+                    fprintf(out, "%zu", record->label);
+                }
+            } else {
+                fprintf(out, "\"pattern\":%zu", record->label);
+            }
+            fputs(",\"text\":", out);
+            write_json_string(out, data + record->start, record->end - record->start);
+            fputs("}\n", out);
+            continue;
+        }
+
+        if (options->only_matching) {
+            if (search->with_filename) {
+                fprintf(out, "%s:", path);
+            }
+            fprintf(out, "%zu:%zu-%zu:", line_number, base_offset + record->start,
+                    base_offset + record->end);
+            write_label(search, out, record->label);
+            fwrite(data + record->start, 1, record->end - record->start, out);
+            fputc('\n', out);
+            continue;
+        }
+
+        /* Lines are printed once, however many matches they hold */
+        if (record->start < printed_to) {
+            continue;
+        }
+
+        size_t line_start = record->start;
+        while (line_start > 0 && data[line_start - 1] != '\n') {
+            line_start--;
+        }
+        size_t last = record->end > record->start ? record->end - 1 : record->start;
+        const char *newline = last < size ? memchr(data + last, '\n', size - last) : NULL;
+        size_t line_end = newline ? (size_t)(newline - data) : size;
+        printed_to = line_end + 1;
+
+        if (search->with_filename) {
+            fprintf(out, "%s:", path);
+        }
+        fprintf(out, "%zu:", line_number);
+        fwrite(data + line_start, 1, line_end - line_start, out);
+        fputc('\n', out);
+    }
+}
+
+/**
+ * @brief Search one mapped file
+ *
+ * @param search The search
+ * @param matchers Matchers of the calling thread, one per pattern (NULL with a ruleset)
+ * @param parallel Whether the file is searched on every thread of the search
+ * @param data The mapped file
+ * @param size Size of the file
+ * @param records Where the matches go, in file order
+ */
+static void
+scan_mapped(const grep_search_t *search, rift_regex_matcher_t **matchers, bool parallel,
+            const char *data, size_t size, grep_records_t *records)
+{
+    if (search->rules) {
+        if (parallel) {
+            scan_rules_parallel(search, data, size, records);
+        } else {
+            scan_rule_lines(search, data, 0, size, records);
+        }
+        return;
+    }
+
+    for (size_t i = 0; i < search->num_labels && !records->failed; i++) {
+        grep_pattern_scan_t scan = {records, i};
+        if (parallel) {
+            rift_matcher_find_all_parallel(search->patterns[i], data, size, search->num_threads,
+                                           on_pattern_match, &scan);
+        } else if (rift_matcher_set_input(matchers[i], data, size)) {
+            rift_matcher_for_each_match(matchers[i], on_pattern_match, &scan);
+        }
+    }
+
+    /* The matches of several patterns are searched one pattern after the other */
+    if (search->num_labels > 1 && records->count > 1 && !records->count_only) {
+        qsort(records->items, records->count, sizeof(*records->items), record_compare);
+    }
+}
+
+/**
+ * @brief Decompress, search and report one compressed file
+ *
+ * The file is decompressed on a thread of its own while the blocks already
+ * decompressed are searched. Each block runs from the line the previous one
+ * stopped at to the last newline decompressed so far, so matches of patterns
+ * never span two blocks: like rules, they are found within lines, or within
+ * RIFT_GREP_MAX_LINE bytes of lines longer than that.
+ *
+ * @param search The search
+ * @param matchers Matchers of the calling thread, one per pattern (NULL with a ruleset)
+ * @param parallel Whether each block is searched on every thread of the search
+ * @param path Path of the file
+ */
+static void
+grep_compressed(grep_search_t *search, rift_regex_matcher_t **matchers, bool parallel,
+                const char *path)
+{
+    rift_regex_error_t error;
+    rift_regex_error_init(&error);
+    rift_decompress_stream_t *stream = rift_decompress_stream_open(path, 0, &error);
+    if (!stream) {
+        fprintf(stderr, "Error: %s\n", rift_regex_error_message(&error));
+        atomic_store(&search->failed, true);
+        return;
+    }
+
+    char *buffer = NULL;
+    size_t length = 0;
+    FILE *out = search->cmd->quiet ? NULL : open_memstream(&buffer, &length);
+
+    char *block = NULL;
+    size_t block_size = 0;
+    size_t block_capacity = 0;
+    size_t base_offset = 0;
+    size_t base_line = 1;
+    size_t count = 0;
+    bool failed = false;
+    bool more = true;
+
+    while (more && !failed) {
+        const char *chunk;
+        size_t chunk_length;
+        more = rift_decompress_stream_next(stream, &chunk, &chunk_length);
+
+        /* The chunk goes after the partial line left by the previous block */
+        if (more) {
+            if (block_size + chunk_length > block_capacity) {
+                size_t capacity = block_capacity ? block_capacity * 2 : chunk_length * 2;
+                while (capacity < block_size + chunk_length) {
+                    capacity *= 2;
+                }
+                char *grown = rift_realloc(block, capacity);
+                if (!grown) {
+                    failed = true;
+                    break;
+                }
+                block = grown;
+                block_capacity = capacity;
+            }
+            memcpy(block + block_size, chunk, chunk_length);
+            block_size += chunk_length;
+        }
+
+        size_t scan_size = block_size;
+        if (more && block_size < RIFT_GREP_MAX_LINE) {
+            while (scan_size > 0 && block[scan_size - 1] != '\n') {
+                scan_size--;
+            }
+            if (scan_size == 0) {
+                continue;
+            }
+        }
+        if (scan_size == 0) {
+            break;
+        }
+
+        grep_records_t records = {.count_only = search->cmd->options.count_only};
+        scan_mapped(search, matchers, parallel, block, scan_size, &records);
+        failed = records.failed;
+        count += records.count;
+        if (out && !failed && records.count > 0 && !search->cmd->options.count_only) {
+            write_file_output(search, out, path, block, scan_size, &records, base_offset,
+                              base_line);
+        }
+        rift_free(records.items);
+
+        for (const char *p = block; (p = memchr(p, '\n', scan_size - (size_t)(p - block))) != NULL;
+             p++) {
+            base_line++;
+        }
+        base_offset += scan_size;
+        block_size -= scan_size;
+        memmove(block, block + scan_size, block_size);
+    }
+
+    if (failed) {
+        fprintf(stderr, "Error: Out of memory searching %s\n", path);
+        atomic_store(&search->failed, true);
+    } else if (rift_decompress_stream_failed(stream)) {
+        fprintf(stderr, "Error: Cannot decompress %s\n", path);
+        atomic_store(&search->failed, true);
+    }
+    if (count > 0) {
+        atomic_store(&search->matched, true);
+    }
+
+    if (out) {
+        if (search->cmd->options.count_only && !failed) {
+            write_file_count(search, out, path, count);
+        }
+        fclose(out);
+        pthread_mutex_lock(&search->output_lock);
+        fwrite(buffer, 1, length, stdout);
+        pthread_mutex_unlock(&search->output_lock);
+        free(buffer);
+    }
+
+    rift_free(block);
+    rift_decompress_stream_close(stream);
+}
+
+/**
+ * @brief Search and report the contents of one file, read or mapped
+ *
+ * The output of the file is gathered in memory and written under the output
+ * lock, so the files searched by different threads do not interleave.
+ *
+ * @param search The search
+ * @param matchers Matchers of the calling thread, one per pattern (NULL with a ruleset)
+ * @param parallel Whether the file is searched on every thread of the search
+ * @param path Path of the file
+ * @param data Contents of the file
+ * @param size Size of the file
+ */
+static void
+grep_contents(grep_search_t *search, rift_regex_matcher_t **matchers, bool parallel,
+              const char *path, const char *data, size_t size)
+{
+    grep_records_t records = {.count_only = search->cmd->options.count_only};
+    scan_mapped(search, matchers, parallel, data, size, &records);
+
+    if (records.failed) {
+        fprintf(stderr, "Error: Out of memory searching %s\n", path);
+        atomic_store(&search->failed, true);
+    } else if (records.count > 0 || search->cmd->options.count_only) {
+        if (records.count > 0) {
+            atomic_store(&search->matched, true);
+        }
+        if (!search->cmd->quiet) {
+            char *buffer = NULL;
+            size_t length = 0;
+            FILE *out = open_memstream(&buffer, &length);
+            if (out) {
+                write_file_output(search, out, path, data, size, &records, 0, 1);
+                fclose(out);
+                pthread_mutex_lock(&search->output_lock);
+                fwrite(buffer, 1, length, stdout);
+                pthread_mutex_unlock(&search->output_lock);
+                free(buffer);
+            }
+        }
+    }
+
+    rift_free(records.items);
+}
+
+/**
+ * @brief Map, search and report one file
+ *
+ * @param search The search
+ * @param matchers Matchers of the calling thread, one per pattern (NULL with a ruleset)
+ * @param parallel Whether the file is searched on every thread of the search
+ * @param path Path of the file
+ */
+static void
+grep_file(grep_search_t *search, rift_regex_matcher_t **matchers, bool parallel,
+          const char *path)
+{
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        fprintf(stderr, "Error: Cannot open %s\n", path);
+        atomic_store(&search->failed, true);
+        if (fd >= 0) {
+            close(fd);
+        }
+        return;
+    }
+
+    size_t size = (size_t)st.st_size;
+    const char *data = "";
+    void *mapping = MAP_FAILED;
+    if (size > 0) {
+        mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            fprintf(stderr, "Error: Cannot map %s\n", path);
+            atomic_store(&search->failed, true);
+            close(fd);
+            return;
+        }
+        madvise(mapping, size, MADV_SEQUENTIAL);
+        data = mapping;
+    }
+    close(fd);
+
+    if (rift_compression_detect(data, size) != RIFT_COMPRESSION_NONE) {
+        munmap(mapping, size);
+        grep_compressed(search, matchers, parallel, path);
+        return;
+    }
+
+    grep_contents(search, matchers, parallel, path, data, size);
+    if (mapping != MAP_FAILED) {
+        munmap(mapping, size);
+    }
+}
+
+/**
+ * @brief Thread body taking files from the search until none is left
+ */
+static void *
+file_worker(void *arg)
+{
+    grep_search_t *search = arg;
+    rift_regex_matcher_t **matchers = NULL;
+
+    /* Matchers hold the engines' caches, so each thread has its own */
+    if (search->patterns) {
+        matchers = rift_malloc(search->num_labels * sizeof(*matchers));
+        if (!matchers) {
+            atomic_store(&search->failed, true);
+            return NULL;
+        }
+        for (size_t i = 0; i < search->num_labels; i++) {
+            matchers[i] = rift_matcher_create(search->patterns[i], RIFT_MATCHER_OPTION_NONE);
+            if (!matchers[i]) {
+                for (size_t j = 0; j < i; j++) {
+                    rift_matcher_free(matchers[j]);
+                }
+                rift_free(matchers);
+                atomic_store(&search->failed, true);
+                return NULL;
+            }
+        }
+    }
+
+    /* Files the reader could not read whole, and compressed ones, are mapped */
+    rift_file_read_t file;
+    while (search->reader && rift_file_reader_next(search->reader, &file)) {
+        if (file.error) {
+            fprintf(stderr, "Error: Cannot open %s\n", file.path);
+            atomic_store(&search->failed, true);
+        } else if (!file.complete ||
+                   rift_compression_detect(file.data, file.size) != RIFT_COMPRESSION_NONE) {
+            grep_file(search, matchers, false, file.path);
+        } else {
+            grep_contents(search, matchers, false, file.path, file.size ? file.data : "",
+                          file.size);
+        }
+        rift_file_reader_release(search->reader, &file);
+    }
+
+    size_t index;
+    while (!search->reader &&
+           (index = atomic_fetch_add(&search->next_file, 1)) < search->num_files) {
+        grep_file(search, matchers, false, search->files[index]);
+    }
+
+    if (matchers) {
+        for (size_t i = 0; i < search->num_labels; i++) {
+            rift_matcher_free(matchers[i]);
+        }
+        rift_free(matchers);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Add a path to the files searched, descending into directories
+ *
+ * Hidden entries and symbolic links met inside directories are skipped.
+ *
+ * @param search The search
+ * @param capacity Capacity of search->files
+ * @param path The path
+ * @param top Whether the path was given on the command line
+ * @return true if successful, false on allocation failure
+ */
+static bool
+collect_files(grep_search_t *search, size_t *capacity, const char *path, bool top)
+{
+    struct stat st;
+    if ((top ? stat(path, &st) : lstat(path, &st)) != 0) {
+        if (top) {
+            fprintf(stderr, "Error: Cannot open %s\n", path);
+            atomic_store(&search->failed, true);
+        }
+        return true;
+    }
+
+    if (S_ISREG(st.st_mode)) {
+        if (search->num_files == *capacity) {
+            size_t grown = *capacity ? *capacity * 2 : 64;
+            char **files = rift_realloc(search->files, grown * sizeof(*files));
+            if (!files) {
+                return false;
+            }
+            search->files = files;
+            *capacity = grown;
+        }
+        search->files[search->num_files] = rift_strdup(path);
+        return search->files[search->num_files++] != NULL;
+    }
+
+    if (!S_ISDIR(st.st_mode)) {
+        return true;
+    }
+
+    search->with_filename = true;
+    DIR *dir = opendir(path);
+    if (!dir) {
+        fprintf(stderr, "Error: Cannot read directory %s\n", path);
+        atomic_store(&search->failed, true);
+        return true;
+    }
+
+    bool ok = true;
+    size_t path_length = strlen(path);
+    struct dirent *entry;
+    while (ok && (entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+        size_t length = path_length + strlen(entry->d_name) + 2;
+        char *child = rift_malloc(length);
+        if (!child) {
+            ok = false;
+            break;
+        }
+        bool slash = path_length > 0 && path[path_length - 1] == '/';
+        snprintf(child, length, slash ? "%s%s" : "%s/%s", path, entry->d_name);
+        ok = collect_files(search, capacity, child, false);
+        rift_free(child);
+    }
+
+    closedir(dir);
+    return ok;
+}
+
+/**
+ * @brief Compile the patterns or the ruleset of a command
+ *
+ * @param cmd The grep command
+ * @param search The search to fill
+ * @return true if successful, false otherwise
+ */
+static bool
+compile_search(const rift_grep_command_t *cmd, grep_search_t *search)
+{
+    const rift_grep_options_t *options = &cmd->options;
+
+    if (options->rules_file) {
+        /* Bytecode containers are mapped; anything else is compiled as .rift source */
+        size_t length = strlen(options->rules_file);
+        bool is_source = length >= 5 && strcmp(options->rules_file + length - 5, ".rift") == 0;
+        rift_dsl_compile_options_t compile_options = {.num_threads = search->num_threads};
+        search->rules = is_source ? rift_dsl_compile_file(options->rules_file, &compile_options)
+                                  : rift_dsl_map_compilation(options->rules_file);
+        const char *error = search->rules ? rift_dsl_get_compilation_error(search->rules)
+                                          : "cannot read the file";
+        if (error) {
+            fprintf(stderr, "Error: Ruleset %s: %s\n", options->rules_file, error);
+            return false;
+        }
+        search->num_labels = rift_dsl_get_compiled_count(search->rules);
+        return true;
+    }
+
+    search->patterns = rift_malloc(options->num_patterns * sizeof(*search->patterns));
+    if (!search->patterns) {
+        fprintf(stderr, "Error: Failed to allocate memory for patterns\n");
+        return false;
+    }
+
+    for (size_t i = 0; i < options->num_patterns; i++) {
+        rift_regex_error_t error;
+        rift_regex_error_init(&error);
+        search->patterns[i] = rift_regex_compile(options->patterns[i], options->flags, &error);
+        if (!search->patterns[i]) {
+            fprintf(stderr, "Error: Compilation of '%s' failed: %s\n", options->patterns[i],
+                    rift_regex_get_error_string(error));
+            return false;
+        }
+        search->num_labels = i + 1;
+    }
+    return true;
+}
+
+/**
+ * @brief Create a new grep command
+ *
+ * @return A new grep command instance or NULL on failure
+ */
+rift_command_t *
+rift_grep_command_create(void)
+{
+    rift_grep_command_t *cmd = (rift_grep_command_t *)rift_malloc(sizeof(rift_grep_command_t));
+    if (!cmd) {
+        return NULL;
+    }
+
+    memset(cmd, 0, sizeof(*cmd));
+    cmd->type = RIFT_COMMAND_GREP;
+    cmd->options.flags = 0; /* RIFT_REGEX_FLAG_NONE */
+
+    return (rift_command_t *)cmd;
+}
+
+/**
+ * @brief Get the options for a grep command
+ *
+ * @param command The grep command
+ * @return Pointer to the grep options
+ */
+rift_grep_options_t *
+rift_grep_command_get_options(rift_command_t *command)
+{
+    rift_grep_command_t *cmd = (rift_grep_command_t *)command;
+    if (!cmd || cmd->type != RIFT_COMMAND_GREP) {
+        return NULL;
+    }
+
+    return &cmd->options;
+}
+
+/**
+ * @brief Append a string to an argument list
+ *
+ * @param list The list
+ * @param count Number of strings in the list
+ * @param value The string, copied
+ * @return true if successful, false on allocation failure
+ */
+static bool
+append_string(char ***list, size_t *count, const char *value)
+{
+    char **grown = rift_realloc(*list, (*count + 1) * sizeof(**list));
+    if (!grown) {
+        return false;
+    }
+    *list = grown;
+    grown[*count] = rift_strdup(value);
+    if (!grown[*count]) {
+        return false;
+    }
+    (*count)++;
+    return true;
+}
+
+/**
+ * @brief Parse the arguments of a grep command
+ *
+ * @param command The grep command
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @return true if parsing was successful, false otherwise
+ */
+bool
+rift_grep_command_parse_args(rift_command_t *command, int argc, char *argv[])
+{
+    rift_grep_options_t *options = rift_grep_command_get_options(command);
+    if (!options) {
+        return false;
+    }
+
+    rift_grep_command_t *cmd = (rift_grep_command_t *)command;
+    bool pattern_given = false;
+
+    for (int i = 0; i < argc; i++) {
+        const char *arg = argv[i];
+        bool takes_value = strcmp(arg, "-e") == 0 || strcmp(arg, "--regexp") == 0 ||
+                           strcmp(arg, "-f") == 0 || strcmp(arg, "--rules") == 0 ||
+                           strcmp(arg, "-j") == 0 || strcmp(arg, "--threads") == 0;
+        if (takes_value && i + 1 >= argc) {
+            if (!cmd->quiet) {
+                fprintf(stderr, "Error: Missing argument for %s option.\n", arg);
+            }
+            return false;
+        }
+
+        bool ok = true;
+        if (strcmp(arg, "-e") == 0 || strcmp(arg, "--regexp") == 0) {
+            /* One more pattern */
+            ok = append_string(&options->patterns, &options->num_patterns, argv[++i]);
+            pattern_given = true;
+        } else if (strcmp(arg, "-f") == 0 || strcmp(arg, "--rules") == 0) {
+            /* Ruleset instead of patterns */
+            rift_free(options->rules_file);
+            options->rules_file = rift_strdup(argv[++i]);
+            ok = options->rules_file != NULL;
+            pattern_given = true;
+        } else if (strcmp(arg, "-j") == 0 || strcmp(arg, "--threads") == 0) {
+            /* Thread count, 0 for one per CPU */
+            char *end;
+            unsigned long threads = strtoul(argv[++i], &end, 10);
+            if (*end != '\0') {
+                fprintf(stderr, "Error: Invalid thread count '%s'.\n", argv[i]);
+                return false;
+            }
+            options->num_threads = (size_t)threads;
+        } else if (strcmp(arg, "-c") == 0 || strcmp(arg, "--count") == 0) {
+            options->count_only = true;
+        } else if (strcmp(arg, "-o") == 0 || strcmp(arg, "--only-matching") == 0) {
+            options->only_matching = true;
+        } else if (strcmp(arg, "--json") == 0) {
+            options->json = true;
+        } else if (strcmp(arg, "--rift") == 0) {
+            options->flags |= RIFT_REGEX_FLAG_RIFT_SYNTAX;
+        } else if (strcmp(arg, "--case-insensitive") == 0 || strcmp(arg, "-i") == 0) {
+            options->flags |= RIFT_REGEX_FLAG_CASE_INSENSITIVE;
+        } else if (strcmp(arg, "--multiline") == 0 || strcmp(arg, "-m") == 0) {
+            options->flags |= RIFT_REGEX_FLAG_MULTILINE;
+        } else if (strcmp(arg, "--dotall") == 0 || strcmp(arg, "-s") == 0) {
+            options->flags |= RIFT_REGEX_FLAG_DOTALL;
+        } else if (strcmp(arg, "--extended") == 0 || strcmp(arg, "-x") == 0) {
+            options->flags |= RIFT_REGEX_FLAG_EXTENDED;
+        } else if (arg[0] == '-' && arg[1] != '\0') {
+            if (!cmd->quiet) {
+                fprintf(stderr, "Warning: Unknown option '%s' ignored.\n", arg);
+            }
+        } else if (!pattern_given) {
+            /* The first operand is the pattern */
+            ok = append_string(&options->patterns, &options->num_patterns, arg);
+            pattern_given = true;
+        } else {
+            ok = append_string(&options->paths, &options->num_paths, arg);
+        }
+
+        if (!ok) {
+            fprintf(stderr, "Error: Failed to allocate memory for arguments\n");
+            return false;
+        }
+    }
+
+    if (!pattern_given) {
+        if (!cmd->quiet) {
+            fprintf(stderr, "Error: No pattern specified.\n");
+        }
+        return false;
+    }
+
+    if (options->rules_file && options->num_patterns > 0) {
+        if (!cmd->quiet) {
+            fprintf(stderr, "Error: --rules cannot be combined with patterns.\n");
+        }
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Execute a grep command
+ *
+ * @param command The grep command
+ * @return 0 if a match was found, 1 if none was, 2 on error
+ */
+int
+rift_grep_command_execute(rift_command_t *command)
+{
+    rift_grep_options_t *options = rift_grep_command_get_options(command);
+    if (!options || (!options->rules_file && options->num_patterns == 0)) {
+        fprintf(stderr, "Error: No pattern specified\n");
+        return RIFT_GREP_ERROR;
+    }
+
+    rift_grep_command_t *cmd = (rift_grep_command_t *)command;
+    grep_search_t search = {.cmd = cmd, .num_threads = options->num_threads};
+    if (search.num_threads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        search.num_threads = cpus > 0 ? (size_t)cpus : 1;
+    }
+    atomic_init(&search.next_file, 0);
+    atomic_init(&search.matched, false);
+    atomic_init(&search.failed, false);
+    pthread_mutex_init(&search.output_lock, NULL);
+
+    int status = RIFT_GREP_ERROR;
+    size_t capacity = 0;
+    bool ok = compile_search(cmd, &search);
+
+    if (ok && options->num_paths == 0) {
+        ok = collect_files(&search, &capacity, ".", true);
+    }
+    for (size_t i = 0; ok && i < options->num_paths; i++) {
+        ok = collect_files(&search, &capacity, options->paths[i], true);
+    }
+    if (!ok && !search.failed) {
+        fprintf(stderr, "Error: Failed to allocate memory for file list\n");
+    }
+    search.with_filename = search.with_filename || search.num_files > 1;
+
+    if (ok && cmd->verbose && !cmd->quiet) {
+        fprintf(stderr, "Searching %zu files for %zu %s on %zu threads\n", search.num_files,
+                search.num_labels, search.rules ? "rules" : "patterns", search.num_threads);
+    }
+
+    if (ok && search.num_files == 1 && search.num_threads > 1) {
+        /* A single file is searched in chunks by every thread */
+        grep_file(&search, NULL, true, search.files[0]);
+    } else if (ok && search.num_files > 0) {
+        /* Several files are shared out to a pool of threads, one file at a time,
+         * read ahead of them in bulk, through io_uring where the kernel has it */
+        search.reader = rift_file_reader_create((const char *const *)search.files,
+                                                search.num_files, NULL, NULL);
+        if (cmd->verbose && !cmd->quiet && rift_file_reader_uses_io_uring(search.reader)) {
+            fprintf(stderr, "Reading files through io_uring\n");
+        }
+        size_t num_workers = search.num_threads;
+        if (num_workers > search.num_files) {
+            num_workers = search.num_files;
+        }
+        pthread_t *workers = rift_malloc(num_workers * sizeof(*workers));
+        size_t started = 0;
+        while (workers && started + 1 < num_workers &&
+               pthread_create(&workers[started], NULL, file_worker, &search) == 0) {
+            started++;
+        }
+        file_worker(&search);
+        for (size_t i = 0; i < started; i++) {
+            pthread_join(workers[i], NULL);
+        }
+        rift_free(workers);
+        rift_file_reader_free(search.reader);
+    }
+
+    if (ok) {
+        fflush(stdout);
+        if (search.failed) {
+            status = RIFT_GREP_ERROR;
+        } else {
+            status = search.matched ? 0 : RIFT_GREP_NO_MATCH;
+        }
+    }
+
+    for (size_t i = 0; i < search.num_files; i++) {
+        rift_free(search.files[i]);
+    }
+    rift_free(search.files);
+    for (size_t i = 0; search.patterns && i < search.num_labels; i++) {
+        rift_regex_pattern_free(search.patterns[i]);
+    }
+    rift_free(search.patterns);
+    if (search.rules) {
+        rift_dsl_free_compilation(search.rules);
+    }
+    pthread_mutex_destroy(&search.output_lock);
+
+    return status;
+}
+
+/**
+ * @brief Get help information for a grep command
+ *
+ * @param command The grep command
+ * @return Help string for the command
+ */
+const char *
+rift_grep_command_get_help(const rift_command_t *command)
+{
+    (void)command;
+
+    return "grep <pattern> [path...] [options]\n"
+           "grep (-e <pattern>)... [path...] [options]\n"
+           "grep --rules <file> [path...] [options]\n"
+           "\n"
+           "Search files and directories for regex patterns or the rules of a ruleset.\n"
+           "Directories are searched recursively, and the current directory when no\n"
+           "path is given. gzip and zstd files are decompressed as they are searched.\n"
+           "Exits with 0 if a match was found, 1 if none was, 2 on errors.\n"
+           "\n"
+           "Options:\n"
+           "  --regexp, -e <pattern>        Search for a pattern, repeatable\n"
+           "  --rules, -f <file>            Search for the rules of a .rift file or of a\n"
+           "                                compiled bytecode container, line by line\n"
+           "  --count, -c                   Print the number of matches per file\n"
+           "  --only-matching, -o           Print line:start-end:text for each match\n"
+           "  --json                        Print one JSON record per match or count\n"
+           "  --threads, -j <n>             Threads to search with (default: one per CPU)\n"
+           "  --rift                        Enable LibRift r'' syntax\n"
+           "  --case-insensitive, -i        Case insensitive matching\n"
+           "  --multiline, -m               ^ and $ match start/end of line\n"
+           "  --dotall, -s                  . matches newline\n"
+           "  --extended, -x                Ignore whitespace in pattern\n"
+           "\n"
+           "Examples:\n"
+           "  librift grep \"ERROR [0-9]+\" /var/log/app.log\n"
+           "  librift grep -e timeout -e refused -c logs/\n"
+           "  librift grep -o \"status=5[0-9]{2}\" access.log.gz\n"
+           "  librift grep --rules alerts.rift --json /var/log";
+}
+
+/**
+ * @brief Free resources associated with a grep command
+ *
+ * @param command The command to free
+ */
+void
+rift_grep_command_free(rift_command_t *command)
+{
+    rift_grep_options_t *options = rift_grep_command_get_options(command);
+    if (!options) {
+        return;
+    }
+
+    for (size_t i = 0; i < options->num_patterns; i++) {
+        rift_free(options->patterns[i]);
+    }
+    rift_free(options->patterns);
+    for (size_t i = 0; i < options->num_paths; i++) {
+        rift_free(options->paths[i]);
+    }
+    rift_free(options->paths);
+    rift_free(options->rules_file);
+
+    rift_free(command);
+}
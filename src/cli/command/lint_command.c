@@ -0,0 +1,250 @@
+/**
+ * @file lint_command.c
+ * @brief Lint command implementation for LibRift CLI
+ *
+ * This file implements the lint command. The ruleset is compiled with a lint
+ * report requested, which compares the languages of the rules' minimized
+ * DFAs, and the redundant rules are printed with the rule covering each one.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "cli/command/lint_command.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/dsl/rift_dsl_compiler.h"
+#include "core/memory/memory.h"
+
+/**
+ * @brief Write a string as a JSON string literal
+ */
+static void
+write_json_string(FILE *out, const char *text)
+{
+    fputc('"', out);
+    for (const unsigned char *c = (const unsigned char *)(text ? text : ""); *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            fprintf(out, "\\%c", *c);
+        } else if (*c < 0x20) {
+            fprintf(out, "\\u%04x", *c);
+        } else {
+            fputc(*c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+/**
+ * @brief Write the redundant rules, one per line
+ */
+static void
+write_text(FILE *out, const char *rules_file, const rift_dsl_lint_t *lint, size_t num_rules)
+{
+    for (size_t i = 0; i < lint->count; i++) {
+        const rift_dsl_redundancy_t *redundancy = &lint->redundancies[i];
+        fprintf(out, "%s: rule %zu '%s' %s rule %zu '%s'\n", rules_file, redundancy->index + 1,
+                redundancy->name ? redundancy->name : "",
+                redundancy->duplicate ? "duplicates" : "is subsumed by",
+                redundancy->covered_by + 1,
+                redundancy->covered_by_name ? redundancy->covered_by_name : "");
+    }
+    fprintf(out, "%zu of %zu rules redundant, %zu compared\n", lint->count, num_rules,
+            lint->num_compared);
+}
+
+/**
+ * @brief Write the redundant rules as one JSON document
+ */
+static void
+write_json(FILE *out, const char *rules_file, const rift_dsl_lint_t *lint, size_t num_rules)
+{
+    fputs("{\n  \"ruleset\": ", out);
+    write_json_string(out, rules_file);
+    fprintf(out, ",\n  \"rules\": %zu,\n  \"compared\": %zu,\n  \"redundant\": [", num_rules,
+            lint->num_compared);
+    for (size_t i = 0; i < lint->count; i++) {
+        const rift_dsl_redundancy_t *redundancy = &lint->redundancies[i];
+        fprintf(out, "%s\n    {\"index\": %zu, \"name\": ", i ? "," : "", redundancy->index);
+        write_json_string(out, redundancy->name);
+        fprintf(out, ", \"covered_by\": %zu, \"covered_by_name\": ", redundancy->covered_by);
+        write_json_string(out, redundancy->covered_by_name);
+        fprintf(out, ", \"duplicate\": %s}", redundancy->duplicate ? "true" : "false");
+    }
+    fputs(lint->count > 0 ? "\n  ]\n}\n" : "]\n}\n", out);
+}
+
+/**
+ * @brief Create a new lint command
+ *
+ * @return A new lint command instance or NULL on failure
+ */
+rift_command_t *
+rift_lint_command_create(void)
+{
+    rift_lint_command_t *cmd = (rift_lint_command_t *)rift_malloc(sizeof(rift_lint_command_t));
+    if (!cmd) {
+        return NULL;
+    }
+
+    memset(cmd, 0, sizeof(*cmd));
+    cmd->type = RIFT_COMMAND_LINT;
+
+    return (rift_command_t *)cmd;
+}
+
+/**
+ * @brief Get the options for a lint command
+ *
+ * @param command The lint command
+ * @return Pointer to the lint options
+ */
+rift_lint_options_t *
+rift_lint_command_get_options(rift_command_t *command)
+{
+    rift_lint_command_t *cmd = (rift_lint_command_t *)command;
+    if (!cmd || cmd->type != RIFT_COMMAND_LINT) {
+        return NULL;
+    }
+
+    return &cmd->options;
+}
+
+/**
+ * @brief Parse the arguments of a lint command
+ *
+ * @param command The lint command
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @return true if parsing was successful, false otherwise
+ */
+bool
+rift_lint_command_parse_args(rift_command_t *command, int argc, char *argv[])
+{
+    rift_lint_options_t *options = rift_lint_command_get_options(command);
+    if (!options) {
+        return false;
+    }
+
+    rift_lint_command_t *cmd = (rift_lint_command_t *)command;
+
+    for (int i = 0; i < argc; i++) {
+        const char *arg = argv[i];
+        if (strcmp(arg, "--json") == 0) {
+            options->json = true;
+        } else if (strcmp(arg, "--strict") == 0) {
+            options->strict = true;
+        } else if (arg[0] == '-' && arg[1] != '\0') {
+            if (!cmd->quiet) {
+                fprintf(stderr, "Warning: Unknown option '%s' ignored.\n", arg);
+            }
+        } else if (!options->rules_file) {
+            options->rules_file = rift_strdup(arg);
+            if (!options->rules_file) {
+                fprintf(stderr, "Error: Failed to allocate memory for arguments\n");
+                return false;
+            }
+        } else if (!cmd->quiet) {
+            fprintf(stderr, "Warning: Extra argument '%s' ignored.\n", arg);
+        }
+    }
+
+    if (!options->rules_file) {
+        if (!cmd->quiet) {
+            fprintf(stderr, "Error: A ruleset is required.\n");
+        }
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Execute a lint command
+ *
+ * @param command The lint command
+ * @return 0 on success, 1 on failure, 2 with --strict when a rule is redundant
+ */
+int
+rift_lint_command_execute(rift_command_t *command)
+{
+    rift_lint_options_t *options = rift_lint_command_get_options(command);
+    if (!options || !options->rules_file) {
+        fprintf(stderr, "Error: No ruleset specified\n");
+        return 1;
+    }
+
+    rift_lint_command_t *cmd = (rift_lint_command_t *)command;
+
+    rift_dsl_lint_t lint;
+    rift_dsl_compile_options_t compile_options = {0, NULL, 0, NULL, &lint, false};
+    void *compilation = rift_dsl_compile_file(options->rules_file, &compile_options);
+    const char *message = compilation ? rift_dsl_get_compilation_error(compilation)
+                                      : "cannot read the file";
+    if (message) {
+        fprintf(stderr, "Error: Cannot compile ruleset %s: %s\n", options->rules_file, message);
+        rift_dsl_lint_free(&lint);
+        rift_dsl_free_compilation(compilation);
+        return 1;
+    }
+
+    if (!cmd->quiet) {
+        size_t num_rules = rift_dsl_get_compiled_count(compilation);
+        if (options->json) {
+            write_json(stdout, options->rules_file, &lint, num_rules);
+        } else {
+            write_text(stdout, options->rules_file, &lint, num_rules);
+        }
+    }
+
+    int status = options->strict && lint.count > 0 ? 2 : 0;
+    rift_dsl_lint_free(&lint);
+    rift_dsl_free_compilation(compilation);
+    return status;
+}
+
+/**
+ * @brief Get help information for a lint command
+ *
+ * @param command The lint command
+ * @return Help string for the command
+ */
+const char *
+rift_lint_command_get_help(const rift_command_t *command)
+{
+    (void)command;
+
+    return "lint <rules.rift> [options]\n"
+           "\n"
+           "Compile the ruleset and report the redundant rules: duplicates of an earlier\n"
+           "rule, and rules matching nothing another rule does not match. Rules with\n"
+           "anchors, word boundaries, atomic groups, lookarounds or backreferences are\n"
+           "not compared. Compiling with the prune_redundant option leaves them out.\n"
+           "\n"
+           "Options:\n"
+           "  --json                   Print the redundant rules as JSON\n"
+           "  --strict                 Exit with status 2 if a rule is redundant\n"
+           "\n"
+           "Examples:\n"
+           "  librift lint rules.rift\n"
+           "  librift lint rules.rift --json --strict";
+}
+
+/**
+ * @brief Free resources associated with a lint command
+ *
+ * @param command The command to free
+ */
+void
+rift_lint_command_free(rift_command_t *command)
+{
+    rift_lint_options_t *options = rift_lint_command_get_options(command);
+    if (!options) {
+        return;
+    }
+
+    rift_free(options->rules_file);
+
+    rift_free(command);
+}
@@ -0,0 +1,776 @@
+/**
+ * @file output_writer.c
+ * @brief Implementation of the buffered output writer of the CLI
+ *
+ * The writer keeps one stack entry per open record, object or array,
+ * which is all the JSON encodings need to place separators and the text
+ * encoding needs to place spaces. CBOR containers are written with
+ * indefinite lengths, so nothing is held back until a container ends.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "cli/command/output_writer.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "core/memory/memory.h"
+
+/* CBOR initial bytes of the indefinite-length containers and their end */
+#define CBOR_ARRAY_START 0x9F
+#define CBOR_MAP_START 0xBF
+#define CBOR_BREAK 0xFF
+
+/* CBOR major types, in the top three bits of the initial byte */
+#define CBOR_UNSIGNED 0
+#define CBOR_NEGATIVE 1
+#define CBOR_TEXT 3
+
+/* CBOR simple values */
+#define CBOR_FALSE 0xF4
+#define CBOR_TRUE 0xF5
+
+/**
+ * @brief Names of the formats, indexed by rift_output_format_t
+ */
+static const char *const format_names[] = {"text", "json", "ndjson", "cbor", "binary"};
+
+/**
+ * @brief Open record, object or array
+ */
+typedef struct container {
+    bool is_array;    /**< Whether members have no keys */
+    bool has_members; /**< Whether a member was written, so the next needs a separator */
+} container_t;
+
+/**
+ * @brief Output writer structure
+ */
+struct rift_output_writer {
+    int fd;                      /**< File written */
+    bool owns_fd;                /**< Whether fd is closed with the writer */
+    rift_output_format_t format; /**< Encoding of the output */
+    char *buffer;                /**< Bytes not written yet */
+    size_t length;               /**< Bytes in buffer */
+    bool failed;                 /**< Whether a write failed */
+    size_t records;              /**< Records started */
+    container_t *stack;          /**< Open containers, the record first */
+    size_t depth;                /**< Number of open containers */
+    size_t stack_capacity;       /**< Capacity of stack */
+};
+
+/**
+ * @brief Write bytes to the file, resuming after interruptions and short writes
+ */
+static bool
+write_all(int fd, const char *data, size_t length)
+{
+    while (length > 0) {
+        ssize_t written = write(fd, data, length);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        length -= (size_t)written;
+    }
+    return true;
+}
+
+/**
+ * @brief Write the buffered bytes to the file
+ */
+static void
+drain(rift_output_writer_t *writer)
+{
+    if (writer->length > 0 && !writer->failed) {
+        writer->failed = !write_all(writer->fd, writer->buffer, writer->length);
+    }
+    writer->length = 0;
+}
+
+/**
+ * @brief Append bytes to the output
+ *
+ * Runs larger than the buffer go straight to the file once the buffer is
+ * drained, so they are not copied.
+ */
+static void
+put(rift_output_writer_t *writer, const void *data, size_t length)
+{
+    if (length > RIFT_OUTPUT_WRITER_BUFFER_SIZE - writer->length) {
+        drain(writer);
+        if (length >= RIFT_OUTPUT_WRITER_BUFFER_SIZE) {
+            if (!writer->failed) {
+                writer->failed = !write_all(writer->fd, data, length);
+            }
+            return;
+        }
+    }
+    memcpy(writer->buffer + writer->length, data, length);
+    writer->length += length;
+}
+
+/**
+ * @brief Append one byte to the output
+ */
+static void
+put_byte(rift_output_writer_t *writer, unsigned char byte)
+{
+    if (writer->length == RIFT_OUTPUT_WRITER_BUFFER_SIZE) {
+        drain(writer);
+    }
+    writer->buffer[writer->length++] = (char)byte;
+}
+
+/**
+ * @brief Append a terminated string to the output
+ */
+static void
+put_string(rift_output_writer_t *writer, const char *text)
+{
+    put(writer, text, strlen(text));
+}
+
+/**
+ * @brief Append an unsigned integer in decimal
+ */
+static void
+put_decimal(rift_output_writer_t *writer, uint64_t value)
+{
+    char digits[20];
+    size_t start = sizeof(digits);
+    do {
+        digits[--start] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    put(writer, digits + start, sizeof(digits) - start);
+}
+
+/**
+ * @brief Append a string as a quoted JSON string
+ */
+static void
+put_json_string(rift_output_writer_t *writer, const char *value, size_t length)
+{
+    static const char hex[] = "0123456789abcdef";
+
+    put_byte(writer, '"');
+    size_t run = 0;
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = (unsigned char)value[i];
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+
+        /* Copy the bytes that needed no escape in one go */
+        put(writer, value + run, i - run);
+        run = i + 1;
+        switch (c) {
+        case '"':
+            put(writer, "\\\"", 2);
+            break;
+        case '\\':
+            put(writer, "\\\\", 2);
+            break;
+        case '\n':
+            put(writer, "\\n", 2);
+            break;
+        case '\r':
+            put(writer, "\\r", 2);
+            break;
+        case '\t':
+            put(writer, "\\t", 2);
+            break;
+        default: {
+            char escape[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF]};
+            put(writer, escape, sizeof(escape));
+            break;
+        }
+        }
+    }
+    put(writer, value + run, length - run);
+    put_byte(writer, '"');
+}
+
+/**
+ * @brief Append the head of a CBOR data item, its major type and argument
+ */
+static void
+put_cbor_head(rift_output_writer_t *writer, unsigned major, uint64_t argument)
+{
+    unsigned char head[9];
+    size_t size;
+    unsigned char type = (unsigned char)(major << 5);
+    if (argument < 24) {
+        head[0] = type | (unsigned char)argument;
+        size = 1;
+    } else if (argument <= UINT8_MAX) {
+        head[0] = type | 24;
+        size = 2;
+    } else if (argument <= UINT16_MAX) {
+        head[0] = type | 25;
+        size = 3;
+    } else if (argument <= UINT32_MAX) {
+        head[0] = type | 26;
+        size = 5;
+    } else {
+        head[0] = type | 27;
+        size = 9;
+    }
+
+    /* The argument follows the initial byte in network byte order */
+    for (size_t i = size - 1; i > 0; i--) {
+        head[i] = (unsigned char)(argument & 0xFF);
+        argument >>= 8;
+    }
+    put(writer, head, size);
+}
+
+/**
+ * @brief Append a CBOR text string
+ */
+static void
+put_cbor_text(rift_output_writer_t *writer, const char *value, size_t length)
+{
+    put_cbor_head(writer, CBOR_TEXT, length);
+    put(writer, value, length);
+}
+
+/**
+ * @brief Open a container, the record when none is open
+ */
+static bool
+push_container(rift_output_writer_t *writer, bool is_array)
+{
+    if (writer->depth == writer->stack_capacity) {
+        size_t capacity = writer->stack_capacity ? writer->stack_capacity * 2 : 16;
+        container_t *stack = rift_realloc(writer->stack, capacity * sizeof(container_t));
+        if (!stack) {
+            return false;
+        }
+        writer->stack = stack;
+        writer->stack_capacity = capacity;
+    }
+
+    writer->stack[writer->depth].is_array = is_array;
+    writer->stack[writer->depth].has_members = false;
+    writer->depth++;
+    return true;
+}
+
+/**
+ * @brief Write what comes before a member of the innermost container
+ *
+ * That is the separator from the previous member and, in an object, the
+ * key. A member needs an open record, and a key exactly when it is in an
+ * object.
+ */
+static bool
+begin_member(rift_output_writer_t *writer, const char *key)
+{
+    if (writer->depth == 0 || writer->format == RIFT_OUTPUT_FORMAT_BINARY) {
+        return false;
+    }
+
+    container_t *container = &writer->stack[writer->depth - 1];
+    if (container->is_array == (key != NULL)) {
+        return false;
+    }
+
+    bool separate = container->has_members;
+    container->has_members = true;
+    switch (writer->format) {
+    case RIFT_OUTPUT_FORMAT_TEXT:
+        if (separate) {
+            put_byte(writer, ' ');
+        }
+        if (key) {
+            put_string(writer, key);
+            put_byte(writer, '=');
+        }
+        break;
+    case RIFT_OUTPUT_FORMAT_JSON:
+    case RIFT_OUTPUT_FORMAT_NDJSON:
+        if (separate) {
+            put_byte(writer, ',');
+        }
+        if (key) {
+            put_json_string(writer, key, strlen(key));
+            put_byte(writer, ':');
+        }
+        break;
+    case RIFT_OUTPUT_FORMAT_CBOR:
+        if (key) {
+            put_cbor_text(writer, key, strlen(key));
+        }
+        break;
+    case RIFT_OUTPUT_FORMAT_BINARY:
+        break;
+    }
+    return true;
+}
+
+/**
+ * @brief Parses the name of a format
+ *
+ * @param name "text", "json", "ndjson", "cbor" or "binary"
+ * @param format Where the format goes
+ * @return bool True if the name is known, false otherwise
+ */
+bool
+rift_output_format_parse(const char *name, rift_output_format_t *format)
+{
+    if (!name || !format) {
+        return false;
+    }
+
+    for (size_t i = 0; i < sizeof(format_names) / sizeof(format_names[0]); i++) {
+        if (strcmp(name, format_names[i]) == 0) {
+            *format = (rift_output_format_t)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Gets the name of a format
+ *
+ * @param format The format
+ * @return const char* Its name, "unknown" for an invalid format
+ */
+const char *
+rift_output_format_name(rift_output_format_t format)
+{
+    if ((size_t)format >= sizeof(format_names) / sizeof(format_names[0])) {
+        return "unknown";
+    }
+    return format_names[format];
+}
+
+/**
+ * @brief Opens a writer on a file
+ *
+ * @param path File written, created or truncated, or NULL or "-" for standard output
+ * @param format Encoding of the output
+ * @return rift_output_writer_t* A new writer or NULL on failure
+ */
+rift_output_writer_t *
+rift_output_writer_open(const char *path, rift_output_format_t format)
+{
+    if ((size_t)format >= sizeof(format_names) / sizeof(format_names[0])) {
+        return NULL;
+    }
+
+    rift_output_writer_t *writer = rift_malloc(sizeof(rift_output_writer_t));
+    if (!writer) {
+        return NULL;
+    }
+    memset(writer, 0, sizeof(rift_output_writer_t));
+    writer->format = format;
+
+    writer->buffer = rift_malloc(RIFT_OUTPUT_WRITER_BUFFER_SIZE);
+    if (!writer->buffer) {
+        rift_free(writer);
+        return NULL;
+    }
+
+    if (!path || strcmp(path, "-") == 0) {
+        /* Text printed before through stdio must come first */
+        fflush(stdout);
+        writer->fd = STDOUT_FILENO;
+    } else {
+        writer->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (writer->fd < 0) {
+            rift_free(writer->buffer);
+            rift_free(writer);
+            return NULL;
+        }
+        writer->owns_fd = true;
+    }
+    return writer;
+}
+
+/**
+ * @brief Ends the output, writes what is buffered and frees the writer
+ *
+ * @param writer The writer (can be NULL)
+ * @return bool True if every write succeeded, false otherwise
+ */
+bool
+rift_output_writer_close(rift_output_writer_t *writer)
+{
+    if (!writer) {
+        return false;
+    }
+
+    if (writer->format == RIFT_OUTPUT_FORMAT_JSON) {
+        put_string(writer, writer->records > 0 ? "\n]\n" : "[]\n");
+    }
+    drain(writer);
+
+    bool ok = !writer->failed && writer->depth == 0;
+    if (writer->owns_fd && close(writer->fd) != 0) {
+        ok = false;
+    }
+    rift_free(writer->stack);
+    rift_free(writer->buffer);
+    rift_free(writer);
+    return ok;
+}
+
+/**
+ * @brief Gets the encoding of a writer
+ *
+ * @param writer The writer
+ * @return rift_output_format_t The format
+ */
+rift_output_format_t
+rift_output_writer_get_format(const rift_output_writer_t *writer)
+{
+    return writer ? writer->format : RIFT_OUTPUT_FORMAT_TEXT;
+}
+
+/**
+ * @brief Writes what is buffered
+ *
+ * @param writer The writer
+ * @return bool True if every write so far succeeded, false otherwise
+ */
+bool
+rift_output_writer_flush(rift_output_writer_t *writer)
+{
+    if (!writer) {
+        return false;
+    }
+
+    drain(writer);
+    return !writer->failed;
+}
+
+/**
+ * @brief Writes bytes as they are
+ *
+ * @param writer The writer
+ * @param data The bytes
+ * @param length Number of bytes
+ * @return bool True if successful, false otherwise
+ */
+bool
+rift_output_writer_write(rift_output_writer_t *writer, const void *data, size_t length)
+{
+    if (!writer || (!data && length > 0)) {
+        return false;
+    }
+
+    put(writer, data, length);
+    return !writer->failed;
+}
+
+/**
+ * @brief Writes formatted text as it is
+ *
+ * @param writer The writer
+ * @param format printf-style format
+ * @return bool True if successful, false otherwise
+ */
+bool
+rift_output_writer_printf(rift_output_writer_t *writer, const char *format, ...)
+{
+    if (!writer || !format) {
+        return false;
+    }
+
+    /* Most lines fit in what is left of the buffer and are formatted in place */
+    va_list args;
+    va_start(args, format);
+    size_t room = RIFT_OUTPUT_WRITER_BUFFER_SIZE - writer->length;
+    int needed = vsnprintf(writer->buffer + writer->length, room, format, args);
+    va_end(args);
+    if (needed < 0) {
+        return false;
+    }
+    if ((size_t)needed < room) {
+        writer->length += (size_t)needed;
+        return !writer->failed;
+    }
+
+    char *text = rift_malloc((size_t)needed + 1);
+    if (!text) {
+        return false;
+    }
+    va_start(args, format);
+    vsnprintf(text, (size_t)needed + 1, format, args);
+    va_end(args);
+    put(writer, text, (size_t)needed);
+    rift_free(text);
+    return !writer->failed;
+}
+
+/**
+ * @brief Starts a record, an object at the top level of the output
+ *
+ * @param writer The writer
+ * @return bool True if successful, false otherwise
+ */
+bool
+rift_output_writer_begin_record(rift_output_writer_t *writer)
+{
+    if (!writer || writer->depth > 0 || writer->format == RIFT_OUTPUT_FORMAT_BINARY ||
+        !push_container(writer, false)) {
+        return false;
+    }
+
+    switch (writer->format) {
+    case RIFT_OUTPUT_FORMAT_JSON:
+        put_string(writer, writer->records > 0 ? ",\n{" : "[\n{");
+        break;
+    case RIFT_OUTPUT_FORMAT_NDJSON:
+        put_byte(writer, '{');
+        break;
+    case RIFT_OUTPUT_FORMAT_CBOR:
+        put_byte(writer, CBOR_MAP_START);
+        break;
+    case RIFT_OUTPUT_FORMAT_TEXT:
+    case RIFT_OUTPUT_FORMAT_BINARY:
+        break;
+    }
+    writer->records++;
+    return !writer->failed;
+}
+
+/**
+ * @brief Ends the record started last
+ *
+ * @param writer The writer
+ * @return bool True if successful, false otherwise
+ */
+bool
+rift_output_writer_end_record(rift_output_writer_t *writer)
+{
+    if (!writer || writer->depth != 1) {
+        return false;
+    }
+
+    writer->depth = 0;
+    switch (writer->format) {
+    case RIFT_OUTPUT_FORMAT_TEXT:
+        put_byte(writer, '\n');
+        break;
+    case RIFT_OUTPUT_FORMAT_JSON:
+        put_byte(writer, '}');
+        break;
+    case RIFT_OUTPUT_FORMAT_NDJSON:
+        put(writer, "}\n", 2);
+        break;
+    case RIFT_OUTPUT_FORMAT_CBOR:
+        put_byte(writer, CBOR_BREAK);
+        break;
+    case RIFT_OUTPUT_FORMAT_BINARY:
+        break;
+    }
+    return !writer->failed;
+}
+
+/**
+ * @brief Open a container nested in the current record
+ */
+static bool
+begin_container(rift_output_writer_t *writer, const char *key, bool is_array)
+{
+    if (!writer || !begin_member(writer, key) || !push_container(writer, is_array)) {
+        return false;
+    }
+
+    if (writer->format == RIFT_OUTPUT_FORMAT_CBOR) {
+        put_byte(writer, is_array ? CBOR_ARRAY_START : CBOR_MAP_START);
+    } else {
+        put_byte(writer, is_array ? '[' : '{');
+    }
+    return !writer->failed;
+}
+
+/**
+ * @brief Close the innermost container, which must not be the record
+ */
+static bool
+end_container(rift_output_writer_t *writer, bool is_array)
+{
+    if (!writer || writer->depth < 2 || writer->stack[writer->depth - 1].is_array != is_array) {
+        return false;
+    }
+
+    writer->depth--;
+    if (writer->format == RIFT_OUTPUT_FORMAT_CBOR) {
+        put_byte(writer, CBOR_BREAK);
+    } else {
+        put_byte(writer, is_array ? ']' : '}');
+    }
+    return !writer->failed;
+}
+
+/**
+ * @brief Starts an object nested in the current record
+ *
+ * @param writer The writer
+ * @param key Name of the object in the enclosing object, NULL in an array
+ * @return bool True if successful, false otherwise
+ */
+bool
+rift_output_writer_begin_object(rift_output_writer_t *writer, const char *key)
+{
+    return begin_container(writer, key, false);
+}
+
+/**
+ * @brief Ends the object started last
+ *
+ * @param writer The writer
+ * @return bool True if successful, false otherwise
+ */
+bool
+rift_output_writer_end_object(rift_output_writer_t *writer)
+{
+    return end_container(writer, false);
+}
+
+/**
+ * @brief Starts an array nested in the current record
+ *
+ * @param writer The writer
+ * @param key Name of the array in the enclosing object, NULL in an array
+ * @return bool True if successful, false otherwise
+ */
+bool
+rift_output_writer_begin_array(rift_output_writer_t *writer, const char *key)
+{
+    return begin_container(writer, key, true);
+}
+
+/**
+ * @brief Ends the array started last
+ *
+ * @param writer The writer
+ * @return bool True if successful, false otherwise
+ */
+bool
+rift_output_writer_end_array(rift_output_writer_t *writer)
+{
+    return end_container(writer, true);
+}
+
+/**
+ * @brief Writes a string field
+ *
+ * @param writer The writer
+ * @param key Name of the field, NULL in an array
+ * @param value The string, which need not be terminated
+ * @param length Bytes of value
+ * @return bool True if successful, false otherwise
+ */
+bool
+rift_output_writer_field_string(rift_output_writer_t *writer, const char *key, const char *value,
+                                size_t length)
+{
+    if (!writer || (!value && length > 0) || !begin_member(writer, key)) {
+        return false;
+    }
+
+    switch (writer->format) {
+    case RIFT_OUTPUT_FORMAT_TEXT:
+        put(writer, value, length);
+        break;
+    case RIFT_OUTPUT_FORMAT_JSON:
+    case RIFT_OUTPUT_FORMAT_NDJSON:
+        put_json_string(writer, value, length);
+        break;
+    case RIFT_OUTPUT_FORMAT_CBOR:
+        put_cbor_text(writer, value, length);
+        break;
+    case RIFT_OUTPUT_FORMAT_BINARY:
+        break;
+    }
+    return !writer->failed;
+}
+
+/**
+ * @brief Writes an unsigned integer field
+ *
+ * @param writer The writer
+ * @param key Name of the field, NULL in an array
+ * @param value The integer
+ * @return bool True if successful, false otherwise
+ */
+bool
+rift_output_writer_field_uint(rift_output_writer_t *writer, const char *key, uint64_t value)
+{
+    if (!writer || !begin_member(writer, key)) {
+        return false;
+    }
+
+    if (writer->format == RIFT_OUTPUT_FORMAT_CBOR) {
+        put_cbor_head(writer, CBOR_UNSIGNED, value);
+    } else {
+        put_decimal(writer, value);
+    }
+    return !writer->failed;
+}
+
+/**
+ * @brief Writes a signed integer field
+ *
+ * @param writer The writer
+ * @param key Name of the field, NULL in an array
+ * @param value The integer
+ * @return bool True if successful, false otherwise
+ */
+bool
+rift_output_writer_field_int(rift_output_writer_t *writer, const char *key, int64_t value)
+{
+    if (value >= 0) {
+        return rift_output_writer_field_uint(writer, key, (uint64_t)value);
+    }
+    if (!writer || !begin_member(writer, key)) {
+        return false;
+    }
+
+    /* -1 - value cannot overflow, unlike -value for INT64_MIN */
+    uint64_t magnitude = (uint64_t)(-1 - value);
+    if (writer->format == RIFT_OUTPUT_FORMAT_CBOR) {
+        put_cbor_head(writer, CBOR_NEGATIVE, magnitude);
+    } else {
+        put_byte(writer, '-');
+        put_decimal(writer, magnitude + 1);
+    }
+    return !writer->failed;
+}
+
+/**
+ * @brief Writes a boolean field
+ *
+ * @param writer The writer
+ * @param key Name of the field, NULL in an array
+ * @param value The boolean
+ * @return bool True if successful, false otherwise
+ */
+bool
+rift_output_writer_field_bool(rift_output_writer_t *writer, const char *key, bool value)
+{
+    if (!writer || !begin_member(writer, key)) {
+        return false;
+    }
+
+    if (writer->format == RIFT_OUTPUT_FORMAT_CBOR) {
+        put_byte(writer, value ? CBOR_TRUE : CBOR_FALSE);
+    } else {
+        put_string(writer, value ? "true" : "false");
+    }
+    return !writer->failed;
+}
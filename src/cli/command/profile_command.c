@@ -0,0 +1,1090 @@
+/**
+ * @file profile_command.c
+ * @brief Profile command implementation for LibRift CLI
+ *
+ * This file implements the profile command. Each pattern goes through the
+ * stages of the compiler one at a time, each timed on its own: tokenizing,
+ * parsing, validating the AST, building the NFA, the subset construction
+ * of the DFA, minimizing it, and generating the bytecode the VM runs. The
+ * pattern is then compiled as a whole and its matches in the corpus are
+ * found through the matcher, as rift_regex_compile() users would. The
+ * search is timed with telemetry off, then run once more with it on for
+ * the steps, backtracks and engine of the search. With --counters another
+ * search runs between hardware counter reads, attributed like the
+ * telemetry to the pattern and the engine that ran most of it.
+ *
+ * Times are medians of the repeats, from the monotonic clock.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "cli/command/profile_command.h"
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "core/automaton/automaton.h"
+#include "core/automaton/hopcroft.h"
+#include "core/bytecode/bytecode_compiler.h"
+#include "core/compiler/auto_possessify.h"
+#include "core/compiler/compiler.h"
+#include "core/compiler/simplify.h"
+#include "core/dsl/rift_dsl_parser.h"
+#include "core/engine/pattern.h"
+#include "core/errors/regex_error.h"
+#include "core/memory/memory.h"
+#include "core/parser/ast.h"
+#include "core/parser/parser.h"
+#include "core/parser/validator.h"
+#include "core/runtime/execution_tracker.h"
+#include "core/runtime/matcher.h"
+#include "core/runtime/perf_counters.h"
+#include "core/tokenizer/tokenizer.h"
+
+/**
+ * @brief Stages of the compiler, in the order they run
+ */
+typedef enum profile_stage {
+    PROFILE_STAGE_TOKENIZE,
+    PROFILE_STAGE_PARSE,
+    PROFILE_STAGE_VALIDATE,
+    PROFILE_STAGE_NFA,
+    PROFILE_STAGE_DFA,
+    PROFILE_STAGE_MINIMIZE,
+    PROFILE_STAGE_BYTECODE,
+    PROFILE_STAGE_COUNT
+} profile_stage_t;
+
+/**
+ * @brief Names of the stages in reports
+ */
+static const char *const STAGE_NAMES[PROFILE_STAGE_COUNT] = {
+    "tokenize", "parse", "validate", "nfa", "dfa", "minimize", "bytecode",
+};
+
+/**
+ * @brief Measurements of one pattern
+ */
+typedef struct profile_result {
+    const char *name;                       /**< Rule name, or the pattern itself */
+    const char *pattern;                    /**< The pattern */
+    rift_regex_flags_t flags;               /**< Its compilation flags */
+    const char *error;                      /**< Why the pattern does not compile, or NULL */
+    uint64_t stage_ns[PROFILE_STAGE_COUNT]; /**< Median time of each stage */
+    bool stage_ran[PROFILE_STAGE_COUNT];    /**< Whether the stage ran on the pattern */
+    uint64_t compile_ns;                    /**< Sum of the stages that ran */
+    bool searched;                          /**< Whether the corpus was searched */
+    uint64_t scan_ns;                       /**< Median time of searching the corpus */
+    size_t matches;                         /**< Matches found in the corpus */
+    rift_match_stats_t stats;               /**< Telemetry of one search of the corpus */
+    rift_match_engine_t engine;             /**< Engine that ran most of the attempts */
+    rift_perf_sample_t counters;            /**< Hardware counts of one search, if read */
+} profile_result_t;
+
+/**
+ * @brief DSL flag names mapped onto compilation flags
+ */
+static const struct {
+    const char *name;
+    rift_regex_flags_t flag;
+} DSL_FLAGS[] = {
+    {"CASE_INSENSITIVE", RIFT_REGEX_FLAG_CASE_INSENSITIVE},
+    {"MULTILINE", RIFT_REGEX_FLAG_MULTILINE},
+    {"DOTALL", RIFT_REGEX_FLAG_DOTALL},
+    {"EXTENDED", RIFT_REGEX_FLAG_EXTENDED},
+};
+
+/**
+ * @brief Order times for the medians
+ */
+static int
+compare_ns(const void *a, const void *b)
+{
+    uint64_t left = *(const uint64_t *)a;
+    uint64_t right = *(const uint64_t *)b;
+    return left < right ? -1 : left > right;
+}
+
+/**
+ * @brief Sort times and pick the median
+ *
+ * @param times The times, sorted in place
+ * @param count Number of times, at least 1
+ * @return The median
+ */
+static uint64_t
+median_ns(uint64_t *times, size_t count)
+{
+    qsort(times, count, sizeof(*times), compare_ns);
+    return times[count / 2];
+}
+
+/**
+ * @brief Run every stage of the compiler on a pattern once
+ *
+ * Each stage takes the output of the one before it. The DFA and its
+ * minimization are skipped for patterns the subset construction rejects,
+ * and the bytecode is generated from the NFA either way.
+ *
+ * @param result The pattern, and where its stage_ran flags go
+ * @param stage_ns Where the time of each stage goes
+ * @return true if the pattern compiled, false with result->error otherwise
+ */
+static bool
+compile_stages(profile_result_t *result, uint64_t stage_ns[PROFILE_STAGE_COUNT])
+{
+    rift_regex_flags_t flags = result->flags;
+    rift_regex_error_t error;
+    rift_regex_error_init(&error);
+    memset(stage_ns, 0, PROFILE_STAGE_COUNT * sizeof(*stage_ns));
+    memset(result->stage_ran, 0, sizeof(result->stage_ran));
+
+    /* Tokenize alone; the parser tokenizes again as it goes */
+    uint64_t begin = rift_matcher_monotonic_ns();
+    rift_regex_tokenizer_t *tokenizer = rift_regex_tokenizer_create(result->pattern);
+    bool tokenized = tokenizer != NULL;
+    while (tokenized) {
+        rift_regex_token_t token = rift_regex_tokenizer_next_token(tokenizer);
+        if (token.type == RIFT_REGEX_TOKEN_ERROR) {
+            tokenized = false;
+        } else if (token.type == RIFT_REGEX_TOKEN_END) {
+            break;
+        }
+    }
+    rift_regex_tokenizer_free(tokenizer);
+    stage_ns[PROFILE_STAGE_TOKENIZE] = rift_matcher_monotonic_ns() - begin;
+    result->stage_ran[PROFILE_STAGE_TOKENIZE] = true;
+    if (!tokenized) {
+        result->error = "the pattern does not tokenize";
+        return false;
+    }
+
+    /* A parser initialized in place has no validator, so validation is timed apart */
+    rift_regex_parser_t parser;
+    begin = rift_matcher_monotonic_ns();
+    rift_regex_parser_init(&parser, flags, (flags & RIFT_REGEX_FLAG_RIFT_SYNTAX) != 0);
+    rift_regex_ast_t *ast = rift_regex_parser_parse(&parser, result->pattern);
+    stage_ns[PROFILE_STAGE_PARSE] = rift_matcher_monotonic_ns() - begin;
+    result->stage_ran[PROFILE_STAGE_PARSE] = true;
+    if (!ast) {
+        result->error = "the pattern does not parse";
+        return false;
+    }
+
+    rift_regex_validator_t *validator = rift_regex_validator_create();
+    begin = rift_matcher_monotonic_ns();
+    bool valid = validator && rift_regex_validator_validate_with_options(validator, ast, flags);
+    stage_ns[PROFILE_STAGE_VALIDATE] = rift_matcher_monotonic_ns() - begin;
+    result->stage_ran[PROFILE_STAGE_VALIDATE] = true;
+    rift_regex_validator_free(validator);
+    if (!valid) {
+        rift_regex_ast_free(ast);
+        result->error = "the pattern is not valid";
+        return false;
+    }
+
+    /* The NFA, after the AST rewrites rift_regex_compile_pattern() makes */
+    begin = rift_matcher_monotonic_ns();
+    rift_regex_simplify_ast(ast);
+    rift_regex_auto_possessify(ast, flags);
+    rift_regex_automaton_t *nfa = rift_regex_compile_ast(ast, flags, &error);
+    stage_ns[PROFILE_STAGE_NFA] = rift_matcher_monotonic_ns() - begin;
+    result->stage_ran[PROFILE_STAGE_NFA] = true;
+    if (!nfa) {
+        rift_regex_ast_free(ast);
+        result->error = "the pattern has no NFA";
+        return false;
+    }
+
+    rift_regex_automaton_t *dfa = NULL;
+    begin = rift_matcher_monotonic_ns();
+    if (!nfa->is_deterministic) {
+        dfa = rift_automaton_nfa_to_dfa(nfa, &error);
+    }
+    stage_ns[PROFILE_STAGE_DFA] = rift_matcher_monotonic_ns() - begin;
+    result->stage_ran[PROFILE_STAGE_DFA] = nfa->is_deterministic || dfa;
+
+    if (result->stage_ran[PROFILE_STAGE_DFA]) {
+        begin = rift_matcher_monotonic_ns();
+        rift_regex_automaton_t *minimal = rift_hopcroft_minimize(dfa ? dfa : nfa, &error);
+        stage_ns[PROFILE_STAGE_MINIMIZE] = rift_matcher_monotonic_ns() - begin;
+        result->stage_ran[PROFILE_STAGE_MINIMIZE] = minimal != NULL;
+        rift_automaton_free(minimal);
+    }
+    rift_automaton_free(dfa);
+
+    /* The VM counts, so its NFA keeps bounded repeats as counted loops */
+    begin = rift_matcher_monotonic_ns();
+    rift_regex_automaton_t *counted =
+        nfa->is_deterministic ? NULL : rift_regex_compile_ast_with_counters(ast, flags, &error);
+    rift_bytecode_program_t *program =
+        rift_bytecode_from_automaton(counted ? counted : nfa, flags, &error);
+    stage_ns[PROFILE_STAGE_BYTECODE] = rift_matcher_monotonic_ns() - begin;
+    result->stage_ran[PROFILE_STAGE_BYTECODE] = program != NULL;
+
+    rift_bytecode_program_free(program);
+    rift_automaton_free(counted);
+    rift_automaton_free(nfa);
+    rift_regex_ast_free(ast);
+    return true;
+}
+
+/**
+ * @brief Count a match found by the matcher
+ */
+static bool
+count_match(const rift_regex_span_t *spans, size_t num_spans, void *user_data)
+{
+    (void)spans;
+    (void)num_spans;
+    (*(size_t *)user_data)++;
+    return true;
+}
+
+/**
+ * @brief Count the matches of the matcher in the corpus
+ */
+static size_t
+scan_matcher(rift_regex_matcher_t *matcher, const char *input, size_t length)
+{
+    size_t matches = 0;
+    if (rift_matcher_set_input(matcher, input, length)) {
+        rift_matcher_for_each_match(matcher, count_match, &matches);
+    }
+    return matches;
+}
+
+/**
+ * @brief Time the search of the corpus, then record its telemetry
+ *
+ * @param result The pattern, and where the measurements go
+ * @param input The corpus
+ * @param length Length of the corpus
+ * @param times Scratch space for the repeats
+ * @param repeats Number of timed searches
+ * @param counters Hardware counters read over one more search, or NULL
+ */
+static void
+measure_search(profile_result_t *result, const char *input, size_t length, uint64_t *times,
+               size_t repeats, rift_perf_counters_t *counters)
+{
+    rift_regex_error_t error;
+    rift_regex_error_init(&error);
+    rift_regex_pattern_t *pattern = rift_regex_compile(result->pattern, result->flags, &error);
+    rift_regex_matcher_t *matcher =
+        pattern ? rift_matcher_create(pattern, RIFT_MATCHER_OPTION_NONE) : NULL;
+    if (!matcher) {
+        rift_regex_pattern_free(pattern);
+        return;
+    }
+
+    /* The first search warms the lazy DFA's cache up and is not timed */
+    result->matches = scan_matcher(matcher, input, length);
+    for (size_t i = 0; i < repeats; i++) {
+        uint64_t begin = rift_matcher_monotonic_ns();
+        scan_matcher(matcher, input, length);
+        times[i] = rift_matcher_monotonic_ns() - begin;
+    }
+    result->scan_ns = median_ns(times, repeats);
+
+    rift_matcher_set_stats_enabled(matcher, true);
+    rift_matcher_reset_stats(matcher);
+    scan_matcher(matcher, input, length);
+    rift_matcher_get_total_stats(matcher, &result->stats);
+    rift_matcher_set_stats_enabled(matcher, false);
+
+    if (rift_perf_counters_start(counters)) {
+        scan_matcher(matcher, input, length);
+        rift_perf_counters_stop(counters, &result->counters);
+    }
+
+    /* A search mixes engines when the lazy DFA gives up; report the busiest */
+    result->engine = result->stats.engine;
+    uint64_t most = 0;
+    for (size_t i = 0; i < RIFT_MATCH_ENGINE_COUNT; i++) {
+        if (result->stats.engine_attempts[i] > most) {
+            most = result->stats.engine_attempts[i];
+            result->engine = (rift_match_engine_t)i;
+        }
+    }
+    result->searched = true;
+
+    rift_matcher_free(matcher);
+    rift_regex_pattern_free(pattern);
+}
+
+/**
+ * @brief Measure one pattern
+ *
+ * @param options Options of the command
+ * @param input The corpus, or NULL for compilation only
+ * @param length Length of the corpus
+ * @param counters Hardware counters of the searches, or NULL
+ * @param result The pattern, and where the measurements go
+ */
+static void
+measure_pattern(const rift_profile_options_t *options, const char *input, size_t length,
+                rift_perf_counters_t *counters, profile_result_t *result)
+{
+    size_t repeats = options->repeats > 0 ? options->repeats : 1;
+    uint64_t *times = malloc(repeats * PROFILE_STAGE_COUNT * sizeof(*times));
+    if (!times) {
+        result->error = "out of memory";
+        return;
+    }
+
+    /* times holds the repeats of each stage side by side, one row per stage */
+    uint64_t stage_ns[PROFILE_STAGE_COUNT];
+    for (size_t i = 0; i < repeats && !result->error; i++) {
+        compile_stages(result, stage_ns);
+        for (size_t stage = 0; stage < PROFILE_STAGE_COUNT; stage++) {
+            times[stage * repeats + i] = stage_ns[stage];
+        }
+    }
+    if (result->error) {
+        free(times);
+        return;
+    }
+
+    for (size_t stage = 0; stage < PROFILE_STAGE_COUNT; stage++) {
+        if (result->stage_ran[stage]) {
+            result->stage_ns[stage] = median_ns(&times[stage * repeats], repeats);
+            result->compile_ns += result->stage_ns[stage];
+        }
+    }
+
+    if (input) {
+        measure_search(result, input, length, times, repeats, counters);
+    }
+    free(times);
+}
+
+/**
+ * @brief Cost of a pattern by the measure the patterns are ranked by
+ */
+static uint64_t
+ranking_cost(const profile_result_t *result, rift_profile_sort_t sort)
+{
+    switch (sort) {
+    case RIFT_PROFILE_SORT_COMPILE:
+        return result->compile_ns;
+    case RIFT_PROFILE_SORT_MATCH:
+        return result->scan_ns;
+    case RIFT_PROFILE_SORT_TOTAL:
+    default:
+        return result->compile_ns + result->scan_ns;
+    }
+}
+
+/**
+ * @brief Sort key of the ranking, set before sorting
+ */
+static rift_profile_sort_t ranking_sort;
+
+/**
+ * @brief Order patterns from the most to the least costly, failures last
+ */
+static int
+compare_results(const void *a, const void *b)
+{
+    const profile_result_t *left = (const profile_result_t *)a;
+    const profile_result_t *right = (const profile_result_t *)b;
+    if (!left->error != !right->error) {
+        return left->error ? 1 : -1;
+    }
+    uint64_t left_cost = ranking_cost(left, ranking_sort);
+    uint64_t right_cost = ranking_cost(right, ranking_sort);
+    return left_cost > right_cost ? -1 : left_cost < right_cost;
+}
+
+/**
+ * @brief Nanoseconds per byte of a search
+ */
+static double
+ns_per_byte(const profile_result_t *result, size_t length)
+{
+    return length > 0 ? (double)result->scan_ns / (double)length : 0.0;
+}
+
+/**
+ * @brief Write a string as a JSON string literal
+ */
+static void
+write_json_string(FILE *out, const char *text)
+{
+    fputc('"', out);
+    for (const unsigned char *c = (const unsigned char *)text; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            fprintf(out, "\\%c", *c);
+        } else if (*c < 0x20) {
+            fprintf(out, "\\u%04x", *c);
+        } else {
+            fputc(*c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+/**
+ * @brief Write the results as one JSON document
+ */
+static void
+write_json(FILE *out, const rift_profile_options_t *options, size_t length,
+           const profile_result_t *results, size_t count)
+{
+    fputs("{\n  \"input\": ", out);
+    write_json_string(out, options->input_file ? options->input_file : "");
+    fprintf(out, ",\n  \"bytes\": %zu,\n  \"repeats\": %zu,\n  \"patterns\": [", length,
+            options->repeats);
+
+    for (size_t i = 0; i < count; i++) {
+        const profile_result_t *result = &results[i];
+        fprintf(out, "%s\n    {\"rank\": %zu, \"name\": ", i ? "," : "", i + 1);
+        write_json_string(out, result->name);
+        fputs(", \"pattern\": ", out);
+        write_json_string(out, result->pattern);
+        if (result->error) {
+            fputs(", \"error\": ", out);
+            write_json_string(out, result->error);
+            fputc('}', out);
+            continue;
+        }
+
+        fprintf(out, ", \"compile_ns\": {\"total\": %llu",
+                (unsigned long long)result->compile_ns);
+        for (size_t stage = 0; stage < PROFILE_STAGE_COUNT; stage++) {
+            if (result->stage_ran[stage]) {
+                fprintf(out, ", \"%s\": %llu", STAGE_NAMES[stage],
+                        (unsigned long long)result->stage_ns[stage]);
+            } else {
+                fprintf(out, ", \"%s\": null", STAGE_NAMES[stage]);
+            }
+        }
+        fputc('}', out);
+
+        if (result->searched) {
+            fprintf(out,
+                    ", \"match\": {\"scan_ns\": %llu, \"ns_per_byte\": %.3f, \"matches\": %zu, "
+                    "\"engine\": \"%s\", \"attempts\": %llu, \"steps\": %llu, "
+                    "\"backtracks\": %llu, \"max_stack_depth\": %llu, "
+                    "\"prefilter_skips\": %llu}",
+                    (unsigned long long)result->scan_ns, ns_per_byte(result, length),
+                    result->matches, rift_match_engine_name(result->engine),
+                    (unsigned long long)result->stats.attempts,
+                    (unsigned long long)result->stats.steps,
+                    (unsigned long long)result->stats.backtrack_pops,
+                    (unsigned long long)result->stats.max_stack_depth,
+                    (unsigned long long)result->stats.prefilter_skips);
+        }
+        if (options->counters && result->searched) {
+            fputs(", \"counters\": {", out);
+            for (size_t i = 0; i < RIFT_PERF_EVENT_COUNT; i++) {
+                fprintf(out, "%s\"%s\": ", i ? ", " : "",
+                        rift_perf_event_name((rift_perf_event_t)i));
+                if (result->counters.valid[i]) {
+                    fprintf(out, "%llu", (unsigned long long)result->counters.values[i]);
+                } else {
+                    fputs("null", out);
+                }
+            }
+            fputc('}', out);
+        }
+        fputc('}', out);
+    }
+    fputs("\n  ]\n}\n", out);
+}
+
+/**
+ * @brief Write a frame name of a folded stack
+ *
+ * Semicolons separate the frames and white space ends the stack, so both
+ * are replaced.
+ */
+static void
+write_folded_frame(FILE *out, const char *text)
+{
+    for (const unsigned char *c = (const unsigned char *)text; *c; c++) {
+        fputc(*c == ';' || *c <= ' ' ? '_' : *c, out);
+    }
+}
+
+/**
+ * @brief Write the results as folded stacks, one per stage and search
+ *
+ * Each line is pattern;compile;stage or pattern;match;engine followed by
+ * nanoseconds, the input flamegraph.pl and speedscope take.
+ */
+static void
+write_folded(FILE *out, const profile_result_t *results, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        const profile_result_t *result = &results[i];
+        if (result->error) {
+            continue;
+        }
+        for (size_t stage = 0; stage < PROFILE_STAGE_COUNT; stage++) {
+            if (result->stage_ran[stage] && result->stage_ns[stage] > 0) {
+                write_folded_frame(out, result->name);
+                fprintf(out, ";compile;%s %llu\n", STAGE_NAMES[stage],
+                        (unsigned long long)result->stage_ns[stage]);
+            }
+        }
+        if (result->searched && result->scan_ns > 0) {
+            write_folded_frame(out, result->name);
+            fprintf(out, ";match;%s %llu\n", rift_match_engine_name(result->engine),
+                    (unsigned long long)result->scan_ns);
+        }
+    }
+}
+
+/**
+ * @brief Write the time of a stage in microseconds, or a dash if it did not run
+ */
+static void
+write_stage_us(FILE *out, const profile_result_t *result, size_t stage)
+{
+    if (result->stage_ran[stage]) {
+        fprintf(out, " %9.1f", (double)result->stage_ns[stage] / 1e3);
+    } else {
+        fprintf(out, " %9s", "-");
+    }
+}
+
+/**
+ * @brief Write a count per kilobyte of the corpus, or a dash if it was not read
+ */
+static void
+write_count_per_kb(FILE *out, const rift_perf_sample_t *counters, rift_perf_event_t event,
+                   size_t length)
+{
+    if (counters->valid[event] && length > 0) {
+        fprintf(out, " %10.2f", (double)counters->values[event] * 1024.0 / (double)length);
+    } else {
+        fprintf(out, " %10s", "-");
+    }
+}
+
+/**
+ * @brief Write the hardware counts of the searches, per byte and per kilobyte
+ */
+static void
+write_counters_text(FILE *out, size_t length, const profile_result_t *results, size_t count)
+{
+    fprintf(out, "\nHardware counters (one search)\n%-4s %-24s %10s %6s %10s %10s %10s %10s %s\n",
+            "rank", "pattern", "cycles/B", "IPC", "br_miss/KB", "l1d/KB", "llc/KB", "dtlb/KB",
+            "engine");
+    for (size_t i = 0; i < count; i++) {
+        const profile_result_t *result = &results[i];
+        if (!result->searched) {
+            continue;
+        }
+        const rift_perf_sample_t *counters = &result->counters;
+        fprintf(out, "%-4zu %-24.24s", i + 1, result->name);
+        if (counters->valid[RIFT_PERF_EVENT_CYCLES] && length > 0) {
+            fprintf(out, " %10.3f",
+                    (double)counters->values[RIFT_PERF_EVENT_CYCLES] / (double)length);
+        } else {
+            fprintf(out, " %10s", "-");
+        }
+        if (counters->valid[RIFT_PERF_EVENT_CYCLES] &&
+            counters->valid[RIFT_PERF_EVENT_INSTRUCTIONS] &&
+            counters->values[RIFT_PERF_EVENT_CYCLES] > 0) {
+            fprintf(out, " %6.2f",
+                    (double)counters->values[RIFT_PERF_EVENT_INSTRUCTIONS] /
+                        (double)counters->values[RIFT_PERF_EVENT_CYCLES]);
+        } else {
+            fprintf(out, " %6s", "-");
+        }
+        write_count_per_kb(out, counters, RIFT_PERF_EVENT_BRANCH_MISSES, length);
+        write_count_per_kb(out, counters, RIFT_PERF_EVENT_L1D_MISSES, length);
+        write_count_per_kb(out, counters, RIFT_PERF_EVENT_LLC_MISSES, length);
+        write_count_per_kb(out, counters, RIFT_PERF_EVENT_DTLB_MISSES, length);
+        fprintf(out, " %s\n", rift_match_engine_name(result->engine));
+    }
+}
+
+/**
+ * @brief Write the results as ranked tables, compilation then search
+ */
+static void
+write_text(FILE *out, const rift_profile_options_t *options, size_t length,
+           const profile_result_t *results, size_t count)
+{
+    static const char *const SORT_NAMES[] = {"total cost", "compile time", "search time"};
+
+    if (options->input_file) {
+        fprintf(out, "%zu patterns on %s (%zu bytes, %zu repeats), ranked by %s\n\n", count,
+                options->input_file, length, options->repeats, SORT_NAMES[options->sort]);
+    } else {
+        fprintf(out, "%zu patterns (%zu repeats), ranked by %s\n\n", count, options->repeats,
+                SORT_NAMES[options->sort]);
+    }
+
+    fprintf(out, "Compile time (us)\n%-4s %-24s %9s", "rank", "pattern", "total");
+    for (size_t stage = 0; stage < PROFILE_STAGE_COUNT; stage++) {
+        fprintf(out, " %9s", STAGE_NAMES[stage]);
+    }
+    fputc('\n', out);
+    for (size_t i = 0; i < count; i++) {
+        const profile_result_t *result = &results[i];
+        fprintf(out, "%-4zu %-24.24s", i + 1, result->name);
+        if (result->error) {
+            fprintf(out, " error: %s\n", result->error);
+            continue;
+        }
+        fprintf(out, " %9.1f", (double)result->compile_ns / 1e3);
+        for (size_t stage = 0; stage < PROFILE_STAGE_COUNT; stage++) {
+            write_stage_us(out, result, stage);
+        }
+        fputc('\n', out);
+    }
+
+    if (!options->input_file) {
+        return;
+    }
+
+    fprintf(out, "\nSearch\n%-4s %-24s %10s %9s %10s %12s %12s %12s %s\n", "rank", "pattern",
+            "scan_us", "ns/byte", "matches", "steps", "backtracks", "pf_skips", "engine");
+    for (size_t i = 0; i < count; i++) {
+        const profile_result_t *result = &results[i];
+        if (!result->searched) {
+            continue;
+        }
+        fprintf(out, "%-4zu %-24.24s %10.1f %9.3f %10zu %12llu %12llu %12llu %s\n", i + 1,
+                result->name, (double)result->scan_ns / 1e3, ns_per_byte(result, length),
+                result->matches, (unsigned long long)result->stats.steps,
+                (unsigned long long)result->stats.backtrack_pops,
+                (unsigned long long)result->stats.prefilter_skips,
+                rift_match_engine_name(result->engine));
+    }
+
+    if (options->counters) {
+        write_counters_text(out, length, results, count);
+    }
+}
+
+/**
+ * @brief Collect the patterns to profile
+ *
+ * The rules of a ruleset keep their names and flags, and the command's
+ * flags are added to them.
+ *
+ * @param options Options of the command
+ * @param rules Where the parsed ruleset goes, to be freed after the results
+ * @param count Where the number of patterns goes
+ * @return The patterns, or NULL on failure
+ */
+static profile_result_t *
+collect_patterns(const rift_profile_options_t *options, void **rules, size_t *count)
+{
+    *rules = NULL;
+    *count = options->num_patterns;
+    if (options->rules_file) {
+        *rules = rift_dsl_load_file(options->rules_file);
+        const char *message = *rules ? rift_dsl_get_error_message(*rules) : NULL;
+        if (!*rules || message) {
+            fprintf(stderr, "Error: Cannot load ruleset %s: %s\n", options->rules_file,
+                    message ? message : "parse failed");
+            rift_dsl_free(*rules);
+            *rules = NULL;
+            return NULL;
+        }
+        *count = rift_dsl_get_pattern_count(*rules);
+    }
+
+    profile_result_t *results = calloc(*count > 0 ? *count : 1, sizeof(*results));
+    if (!results) {
+        fprintf(stderr, "Error: Failed to allocate memory for the results\n");
+        return NULL;
+    }
+
+    for (size_t i = 0; i < *count; i++) {
+        profile_result_t *result = &results[i];
+        result->flags = options->flags;
+        if (!*rules) {
+            result->name = result->pattern = options->patterns[i];
+            continue;
+        }
+
+        const char *name = NULL;
+        const char *pattern = NULL;
+        if (!rift_dsl_get_pattern(*rules, i, &name, &pattern) || !pattern) {
+            result->name = name ? name : "(unnamed)";
+            result->pattern = "";
+            result->error = "the rule has no pattern";
+            continue;
+        }
+        result->name = name ? name : pattern;
+        result->pattern = pattern;
+
+        const char **flags = NULL;
+        size_t num_flags = 0;
+        if (rift_dsl_get_pattern_flags(*rules, i, &flags, &num_flags)) {
+            for (size_t f = 0; f < num_flags; f++) {
+                for (size_t m = 0; m < sizeof(DSL_FLAGS) / sizeof(DSL_FLAGS[0]); m++) {
+                    if (flags[f] && strcmp(flags[f], DSL_FLAGS[m].name) == 0) {
+                        result->flags |= DSL_FLAGS[m].flag;
+                    }
+                }
+            }
+        }
+    }
+    return results;
+}
+
+/**
+ * @brief Create a new profile command
+ *
+ * @return A new profile command instance or NULL on failure
+ */
+rift_command_t *
+rift_profile_command_create(void)
+{
+    rift_profile_command_t *cmd =
+        (rift_profile_command_t *)rift_malloc(sizeof(rift_profile_command_t));
+    if (!cmd) {
+        return NULL;
+    }
+
+    memset(cmd, 0, sizeof(*cmd));
+    cmd->type = RIFT_COMMAND_PROFILE;
+    cmd->options.repeats = RIFT_PROFILE_DEFAULT_REPEATS;
+    cmd->options.sort = RIFT_PROFILE_SORT_TOTAL;
+    cmd->options.format = RIFT_PROFILE_FORMAT_TEXT;
+    cmd->options.flags = 0; /* RIFT_REGEX_FLAG_NONE */
+
+    return (rift_command_t *)cmd;
+}
+
+/**
+ * @brief Get the options for a profile command
+ *
+ * @param command The profile command
+ * @return Pointer to the profile options
+ */
+rift_profile_options_t *
+rift_profile_command_get_options(rift_command_t *command)
+{
+    rift_profile_command_t *cmd = (rift_profile_command_t *)command;
+    if (!cmd || cmd->type != RIFT_COMMAND_PROFILE) {
+        return NULL;
+    }
+
+    return &cmd->options;
+}
+
+/**
+ * @brief Parse a count given to an option
+ *
+ * @param text The argument
+ * @param value Where the count goes
+ * @return true if the argument is a count, false otherwise
+ */
+static bool
+parse_count(const char *text, size_t *value)
+{
+    char *end;
+    unsigned long long parsed = strtoull(text, &end, 10);
+    if (*text == '\0' || *end != '\0') {
+        fprintf(stderr, "Error: Invalid count '%s'.\n", text);
+        return false;
+    }
+    *value = (size_t)parsed;
+    return true;
+}
+
+/**
+ * @brief Add a pattern to profile
+ *
+ * @param options The options
+ * @param pattern The pattern
+ * @return true if added, false on allocation failure
+ */
+static bool
+add_pattern(rift_profile_options_t *options, const char *pattern)
+{
+    char **patterns =
+        rift_realloc(options->patterns, (options->num_patterns + 1) * sizeof(char *));
+    if (!patterns) {
+        return false;
+    }
+    options->patterns = patterns;
+    patterns[options->num_patterns] = rift_strdup(pattern);
+    if (!patterns[options->num_patterns]) {
+        return false;
+    }
+    options->num_patterns++;
+    return true;
+}
+
+/**
+ * @brief Parse the arguments of a profile command
+ *
+ * @param command The profile command
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @return true if parsing was successful, false otherwise
+ */
+bool
+rift_profile_command_parse_args(rift_command_t *command, int argc, char *argv[])
+{
+    rift_profile_options_t *options = rift_profile_command_get_options(command);
+    if (!options) {
+        return false;
+    }
+
+    rift_profile_command_t *cmd = (rift_profile_command_t *)command;
+    bool have_patterns = false;
+
+    for (int i = 0; i < argc; i++) {
+        const char *arg = argv[i];
+        bool takes_value = strcmp(arg, "-e") == 0 || strcmp(arg, "--regexp") == 0 ||
+                           strcmp(arg, "--rules") == 0 || strcmp(arg, "--repeat") == 0 ||
+                           strcmp(arg, "--top") == 0 || strcmp(arg, "--sort") == 0;
+        if (takes_value && i + 1 >= argc) {
+            if (!cmd->quiet) {
+                fprintf(stderr, "Error: Missing argument for %s option.\n", arg);
+            }
+            return false;
+        }
+
+        bool ok = true;
+        if (strcmp(arg, "-e") == 0 || strcmp(arg, "--regexp") == 0) {
+            ok = add_pattern(options, argv[++i]);
+            have_patterns = true;
+        } else if (strcmp(arg, "--rules") == 0) {
+            rift_free(options->rules_file);
+            options->rules_file = rift_strdup(argv[++i]);
+            ok = options->rules_file != NULL;
+            have_patterns = true;
+        } else if (strcmp(arg, "--repeat") == 0) {
+            if (!parse_count(argv[++i], &options->repeats)) {
+                return false;
+            }
+        } else if (strcmp(arg, "--top") == 0) {
+            if (!parse_count(argv[++i], &options->top)) {
+                return false;
+            }
+        } else if (strcmp(arg, "--sort") == 0) {
+            const char *key = argv[++i];
+            if (strcmp(key, "total") == 0) {
+                options->sort = RIFT_PROFILE_SORT_TOTAL;
+            } else if (strcmp(key, "compile") == 0) {
+                options->sort = RIFT_PROFILE_SORT_COMPILE;
+            } else if (strcmp(key, "match") == 0) {
+                options->sort = RIFT_PROFILE_SORT_MATCH;
+            } else {
+                if (!cmd->quiet) {
+                    fprintf(stderr, "Error: Unknown sort key '%s'.\n", key);
+                }
+                return false;
+            }
+        } else if (strcmp(arg, "--json") == 0) {
+            options->format = RIFT_PROFILE_FORMAT_JSON;
+        } else if (strcmp(arg, "--folded") == 0) {
+            options->format = RIFT_PROFILE_FORMAT_FOLDED;
+        } else if (strcmp(arg, "--counters") == 0) {
+            options->counters = true;
+        } else if (strcmp(arg, "--rift") == 0) {
+            options->flags |= RIFT_REGEX_FLAG_RIFT_SYNTAX;
+        } else if (strcmp(arg, "--case-insensitive") == 0 || strcmp(arg, "-i") == 0) {
+            options->flags |= RIFT_REGEX_FLAG_CASE_INSENSITIVE;
+        } else if (strcmp(arg, "--multiline") == 0 || strcmp(arg, "-m") == 0) {
+            options->flags |= RIFT_REGEX_FLAG_MULTILINE;
+        } else if (strcmp(arg, "--dotall") == 0 || strcmp(arg, "-s") == 0) {
+            options->flags |= RIFT_REGEX_FLAG_DOTALL;
+        } else if (arg[0] == '-' && arg[1] != '\0') {
+            if (!cmd->quiet) {
+                fprintf(stderr, "Warning: Unknown option '%s' ignored.\n", arg);
+            }
+        } else if (!have_patterns) {
+            /* The pattern comes first, unless -e or --rules gave the patterns */
+            ok = add_pattern(options, arg);
+            have_patterns = true;
+        } else if (!options->input_file) {
+            options->input_file = rift_strdup(arg);
+            ok = options->input_file != NULL;
+        } else if (!cmd->quiet) {
+            fprintf(stderr, "Warning: Extra argument '%s' ignored.\n", arg);
+        }
+
+        if (!ok) {
+            fprintf(stderr, "Error: Failed to allocate memory for arguments\n");
+            return false;
+        }
+    }
+
+    if (options->num_patterns == 0 && !options->rules_file) {
+        if (!cmd->quiet) {
+            fprintf(stderr, "Error: A pattern, -e or --rules is required.\n");
+        }
+        return false;
+    }
+    if (options->num_patterns > 0 && options->rules_file) {
+        if (!cmd->quiet) {
+            fprintf(stderr, "Error: Patterns and --rules cannot be combined.\n");
+        }
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Execute a profile command
+ *
+ * @param command The profile command
+ * @return 0 on success, non-zero on failure
+ */
+int
+rift_profile_command_execute(rift_command_t *command)
+{
+    rift_profile_options_t *options = rift_profile_command_get_options(command);
+    if (!options || (options->num_patterns == 0 && !options->rules_file)) {
+        fprintf(stderr, "Error: No pattern specified\n");
+        return 1;
+    }
+
+    rift_profile_command_t *cmd = (rift_profile_command_t *)command;
+
+    /* The corpus is mapped once and searched in place by every pattern */
+    void *mapping = NULL;
+    size_t length = 0;
+    if (options->input_file) {
+        int fd = open(options->input_file, O_RDONLY);
+        struct stat st;
+        if (fd < 0 || fstat(fd, &st) != 0) {
+            fprintf(stderr, "Error: Cannot open input file: %s\n", options->input_file);
+            if (fd >= 0) {
+                close(fd);
+            }
+            return 1;
+        }
+        length = (size_t)st.st_size;
+        mapping = length ? mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0) : NULL;
+        close(fd);
+        if (mapping == MAP_FAILED) {
+            fprintf(stderr, "Error: Cannot map input file: %s\n", options->input_file);
+            return 1;
+        }
+    }
+    const char *input = options->input_file ? (mapping ? (const char *)mapping : "") : NULL;
+
+    void *rules = NULL;
+    size_t count = 0;
+    profile_result_t *results = collect_patterns(options, &rules, &count);
+    if (!results) {
+        if (mapping) {
+            munmap(mapping, length);
+        }
+        return 1;
+    }
+
+    /* Counters count the thread that opens them, so they are opened here */
+    rift_perf_counters_t *counters =
+        options->counters && input ? rift_perf_counters_create() : NULL;
+    if (options->counters && input && !counters && !cmd->quiet) {
+        fprintf(stderr, "Warning: Hardware counters are not available on this system.\n");
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (results[i].error) {
+            continue;
+        }
+        if (cmd->verbose && !cmd->quiet) {
+            fprintf(stderr, "Profiling %s...\n", results[i].name);
+        }
+        measure_pattern(options, input, length, counters, &results[i]);
+    }
+    rift_perf_counters_free(counters);
+
+    ranking_sort = options->sort;
+    qsort(results, count, sizeof(*results), compare_results);
+    size_t reported = options->top > 0 && options->top < count ? options->top : count;
+
+    if (options->format == RIFT_PROFILE_FORMAT_JSON) {
+        write_json(stdout, options, length, results, reported);
+    } else if (options->format == RIFT_PROFILE_FORMAT_FOLDED) {
+        write_folded(stdout, results, reported);
+    } else {
+        write_text(stdout, options, length, results, reported);
+    }
+
+    free(results);
+    rift_dsl_free(rules);
+    if (mapping) {
+        munmap(mapping, length);
+    }
+    return 0;
+}
+
+/**
+ * @brief Get help information for a profile command
+ *
+ * @param command The profile command
+ * @return Help string for the command
+ */
+const char *
+rift_profile_command_get_help(const rift_command_t *command)
+{
+    (void)command;
+
+    return "profile <pattern> [input] [options]\n"
+           "profile -e <pattern> [-e <pattern>...] [input] [options]\n"
+           "profile --rules <file.rift> [input] [options]\n"
+           "\n"
+           "Rank patterns, or the rules of a ruleset, by what they cost. Each pattern is\n"
+           "compiled one stage at a time: tokenize, parse, validate, nfa, dfa, minimize\n"
+           "and bytecode. Given a corpus, its matches are then found through the matcher,\n"
+           "reporting ns/byte, steps, backtracks, prefilter skips and the engine that ran\n"
+           "the search. Stages that cannot run on a pattern are shown as '-'. With\n"
+           "--counters, one more search per pattern is measured with the hardware\n"
+           "counters: cycles per byte, IPC, and branch, L1, LLC and dTLB misses per KB.\n"
+           "\n"
+           "Options:\n"
+           "  -e, --regexp <pattern>        Profile this pattern, repeatable\n"
+           "  --rules <file>                Profile the rules of a .rift ruleset\n"
+           "  --repeat <n>                  Measured compilations and searches (default: 5)\n"
+           "  --sort <total|compile|match>  What the patterns are ranked by (default: total)\n"
+           "  --top <n>                     Report only the n most costly patterns\n"
+           "  --json                        Print the results as JSON\n"
+           "  --folded                      Print folded stacks for flamegraph.pl, in ns\n"
+           "  --counters                    Read hardware counters over a search (Linux)\n"
+           "  --rift                        Enable LibRift r'' syntax\n"
+           "  --case-insensitive, -i        Case insensitive matching\n"
+           "  --multiline, -m               ^ and $ match start/end of line\n"
+           "  --dotall, -s                  . matches newline\n"
+           "\n"
+           "Examples:\n"
+           "  librift profile --rules alerts.rift app.log --top 10\n"
+           "  librift profile -e \"ERROR [0-9]+\" -e \"(a|b)*c{2,50}\" app.log --sort match\n"
+           "  librift profile --rules alerts.rift app.log --folded | flamegraph.pl > p.svg";
+}
+
+/**
+ * @brief Free resources associated with a profile command
+ *
+ * @param command The command to free
+ */
+void
+rift_profile_command_free(rift_command_t *command)
+{
+    rift_profile_options_t *options = rift_profile_command_get_options(command);
+    if (!options) {
+        return;
+    }
+
+    for (size_t i = 0; i < options->num_patterns; i++) {
+        rift_free(options->patterns[i]);
+    }
+    rift_free(options->patterns);
+    rift_free(options->rules_file);
+    rift_free(options->input_file);
+
+    rift_free(command);
+}
@@ -31,17 +31,23 @@ ommand/rift_tokenize_command.h"/a #include "core/runtime/matcher.h"
  * @brief Tokenize command implementation for LibRift CLI
  *
  * This file implements the tokenize command, which tokenizes input files
- * using the LibRift tokenizer engine.
+ * using the LibRift tokenizer engine, either all at once or as a stream of
+ * token spans over a memory-mapped input.
  *
  * @copyright Copyright (c) 2025 LibRift Project
  * @license MIT License
  */
 
 ommand/rift_tokenize_command.h"/a #include "core/errors/regex_error.h"
+#include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include "core/errors/error.h"
+#include "cli/command/output_writer.h"
 #include "core/tokenizer/tokenizer.h"
 #include "librift/cli/commands/rift_tokenize_command.h"
 #include "librift/tokenizer/tokenizer.h"
@@ -50,6 +56,8 @@ ommand/rift_tokenize_command.h"/a #include "core/errors/regex_error.h"
 #include "librift/utils/memory_utils.h"
 
 
+/* Input tokenized between two releases of the pages behind the scan */
+#define TOKENIZE_STREAM_RELEASE_SIZE ((size_t)64 << 20)
 
 ommand/rift_tokenize_command.h"/a #include "core/runtime/matcher.h"
 ommand/rift_tokenize_command.h"/a #include "core/runtime/matcher.h"
@@ -187,14 +195,17 @@ tokenize_parse_args(rift_command_t *command, int argc, char *argv[])
         } else if (strcmp(argv[i], "--format") == 0) {
             /* Output format */
             if (i + 1 < argc) {
-                if (strcmp(argv[i + 1], "json") == 0 || strcmp(argv[i + 1], "text") == 0) {
+                rift_output_format_t parsed;
+                if (rift_output_format_parse(argv[i + 1], &parsed)) {
                     cmd->options.format = rift_strdup(argv[i + 1]);
                     if (!cmd->options.format) {
                         fprintf(stderr, "Error: Failed to allocate memory for format\n");
                         return false;
                     }
                 } else {
-                    fprintf(stderr, "Error: Invalid format '%s'. Must be 'json' or 'text'.\n",
+                    fprintf(stderr,
+                            "Error: Invalid format '%s'. Must be 'json', 'text', 'ndjson', "
+                            "'cbor' or 'binary'.\n",
                             argv[i + 1]);
                     return false;
                 }
@@ -281,7 +292,13 @@ tokenize_execute(rift_command_t *command)
         cmd->options.flags |= RIFT_REGEX_FLAG_CASE_SENSITIVE;
     }
 
-    /* Execute tokenization */
+    /* Execute tokenization; span formats stream the input instead of loading it */
+    rift_output_format_t format = RIFT_OUTPUT_FORMAT_TEXT;
+    rift_output_format_parse(cmd->options.format, &format);
+    if (format == RIFT_OUTPUT_FORMAT_NDJSON || format == RIFT_OUTPUT_FORMAT_CBOR ||
+        format == RIFT_OUTPUT_FORMAT_BINARY) {
+        return rift_tokenize_stream(&cmd->options, cmd->verbose, cmd->quiet);
+    }
     return rift_tokenize_file(&cmd->options, cmd->verbose, cmd->quiet);
 }
 
@@ -332,23 +349,17 @@ rift_tokenize_file(const rift_tokenize_options_t *options, bool verbose, bool qu
     }
 
     /* Tokenize the input */
-    FILE *output = stdout;
-    if (options->output_file) {
-        output = fopen(options->output_file, "w");
-        if (!output) {
-            if (!quiet) {
-                fprintf(stderr, "Error: Failed to open output file '%s'\n", options->output_file);
-            }
-            rift_regex_tokenizer_free(tokenizer);
-            free(file_content);
-            return 1;
+    rift_output_format_t format = RIFT_OUTPUT_FORMAT_TEXT;
+    rift_output_format_parse(options->format, &format);
+    rift_output_writer_t *output = rift_output_writer_open(options->output_file, format);
+    if (!output) {
+        if (!quiet) {
+            fprintf(stderr, "Error: Failed to open output file '%s'\n",
+                    options->output_file ? options->output_file : "-");
         }
-    }
-
-    /* Determine output format and write tokens */
-    bool is_json = (options->format && strcmp(options->format, "json") == 0);
-    if (is_json) {
-        fprintf(output, "[\n");
+        rift_regex_tokenizer_free(tokenizer);
+        free(file_content);
+        return 1;
     }
 
     /* Process all tokens */
@@ -358,29 +369,25 @@ rift_tokenize_file(const rift_tokenize_options_t *options, bool verbose, bool qu
         token_count++;
 
         /* Format and output the token */
-        if (is_json) {
-            if (token_count > 1) {
-                fprintf(output, ",\n");
-            }
-
-            fprintf(output, "  {\n");
-            fprintf(output, "    \"type\": \"%s\",\n", rift_regex_token_type_to_string(token.type));
-            fprintf(output, "    \"position\": %zu", token.position);
-
-            if (token.value) {
-                fprintf(output, ",\n    \"value\": \"%s\"", token.value);
-            }
-
-            fprintf(output, "\n  }");
-        } else {
-            /* Text format */
+        if (format == RIFT_OUTPUT_FORMAT_TEXT) {
             char token_str[256];
             if (rift_regex_token_to_string(&token, token_str, sizeof(token_str))) {
-                fprintf(output, "%s\n", token_str);
+                rift_output_writer_printf(output, "%s\n", token_str);
             } else {
-                fprintf(output, "Token(%s, pos=%zu)\n", rift_regex_token_type_to_string(token.type),
-                        token.position);
+                rift_output_writer_printf(output, "Token(%s, pos=%zu)\n",
+                                          rift_regex_token_type_to_string(token.type),
+                                          token.position);
+            }
+        } else {
+            const char *type = rift_regex_token_type_to_string(token.type);
+            rift_output_writer_begin_record(output);
+            rift_output_writer_field_string(output, "type", type, strlen(type));
+            rift_output_writer_field_uint(output, "position", token.position);
+            if (token.value) {
+                rift_output_writer_field_string(output, "value", token.value,
+                                                strlen(token.value));
             }
+            rift_output_writer_end_record(output);
         }
 
         /* Check if this is the end token */
@@ -389,13 +396,12 @@ rift_tokenize_file(const rift_tokenize_options_t *options, bool verbose, bool qu
         }
     }
 
-    if (is_json) {
-        fprintf(output, "\n]\n");
-    }
-
-    /* Close output file if needed */
-    if (output != stdout) {
-        fclose(output);
+    int result = 0;
+    if (!rift_output_writer_close(output)) {
+        if (!quiet) {
+            fprintf(stderr, "Error: Failed to write tokens\n");
+        }
+        result = 1;
     }
 
     /* Print summary if verbose */
@@ -407,11 +413,156 @@ rift_tokenize_file(const rift_tokenize_options_t *options, bool verbose, bool qu
     rift_regex_tokenizer_free(tokenizer);
     free(file_content);
 
-    return 0;
+    return result;
 }
 
 ommand/rift_tokenize_command.h"/a #include "core/runtime/matcher.h"
 ommand/rift_tokenize_command.h"/a #include "core/runtime/matcher.h"
+/**
+ * @brief Tokenize a file as a stream of token spans
+ *
+ * @param options The tokenization options; the format is ndjson, cbor or binary
+ * @param verbose Whether to show verbose output
+ * @param quiet Whether to suppress all output
+ * @return int 0 on success, non-zero on failure
+ */
+int
+rift_tokenize_stream(const rift_tokenize_options_t *options, bool verbose, bool quiet)
+{
+    if (!options || !options->input_file) {
+        return 1;
+    }
+
+    rift_output_format_t format = RIFT_OUTPUT_FORMAT_NDJSON;
+    rift_output_format_parse(options->format, &format);
+
+    /* Map the input; only regular files can be mapped */
+    int fd = open(options->input_file, O_RDONLY);
+    if (fd < 0) {
+        if (!quiet) {
+            fprintf(stderr, "Error: Failed to open input file '%s'\n", options->input_file);
+        }
+        return 1;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        if (!quiet) {
+            fprintf(stderr, "Error: '%s' is not a regular file\n", options->input_file);
+        }
+        close(fd);
+        return 1;
+    }
+
+    size_t size = (size_t)st.st_size;
+    char *input = NULL;
+    if (size > 0) {
+        void *mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            if (!quiet) {
+                fprintf(stderr, "Error: Failed to map input file '%s'\n", options->input_file);
+            }
+            close(fd);
+            return 1;
+        }
+        madvise(mapping, size, MADV_SEQUENTIAL);
+        input = (char *)mapping;
+    }
+    close(fd);
+
+    /* Tokens carry their spans only, so nothing is copied or allocated per token */
+    rift_regex_tokenizer_t *tokenizer = rift_regex_tokenizer_create_spans(input, size);
+    if (!tokenizer) {
+        if (!quiet) {
+            fprintf(stderr, "Error: Failed to create tokenizer\n");
+        }
+        if (input) {
+            munmap(input, size);
+        }
+        return 1;
+    }
+
+    rift_output_writer_t *output = rift_output_writer_open(options->output_file, format);
+    if (!output) {
+        if (!quiet) {
+            fprintf(stderr, "Error: Failed to open output file '%s'\n",
+                    options->output_file ? options->output_file : "-");
+        }
+        rift_regex_tokenizer_free(tokenizer);
+        if (input) {
+            munmap(input, size);
+        }
+        return 1;
+    }
+
+    if (format == RIFT_OUTPUT_FORMAT_BINARY) {
+        rift_output_writer_write(output, RIFT_TOKENIZE_STREAM_MAGIC,
+                                 sizeof(RIFT_TOKENIZE_STREAM_MAGIC) - 1);
+    }
+
+    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    size_t released = 0;
+    size_t token_count = 0;
+    int result = 0;
+    while (true) {
+        rift_regex_token_t token = rift_regex_tokenizer_next_token(tokenizer);
+        token_count++;
+
+        if (format == RIFT_OUTPUT_FORMAT_BINARY) {
+            rift_tokenize_record_t record = {token.start, token.end, (uint32_t)token.type, 0};
+            rift_output_writer_write(output, &record, sizeof(record));
+        } else {
+            const char *type = rift_regex_token_type_to_string(token.type);
+            rift_output_writer_begin_record(output);
+            rift_output_writer_field_string(output, "type", type, strlen(type));
+            rift_output_writer_field_uint(output, "start", token.start);
+            rift_output_writer_field_uint(output, "end", token.end);
+            rift_output_writer_end_record(output);
+        }
+
+        if (token.type == RIFT_REGEX_TOKEN_END) {
+            break;
+        }
+
+        /* An error that consumed nothing would repeat forever */
+        if (token.end == token.start) {
+            if (!quiet) {
+                const char *error = rift_regex_tokenizer_get_error(tokenizer);
+                fprintf(stderr, "Error: Tokenization stopped at offset %zu: %s\n", token.start,
+                        error ? error : "no progress");
+            }
+            result = 1;
+            break;
+        }
+
+        /* Tokens never look behind their start, so the pages before it can go */
+        if (token.end - released >= TOKENIZE_STREAM_RELEASE_SIZE) {
+            size_t boundary = token.end - token.end % page_size;
+            madvise(input + released, boundary - released, MADV_DONTNEED);
+            released = boundary;
+        }
+    }
+
+    if (!rift_output_writer_close(output)) {
+        if (!quiet) {
+            fprintf(stderr, "Error: Failed to write tokens\n");
+        }
+        result = 1;
+    }
+
+    /* The summary goes to stderr so that it never mixes with streamed tokens */
+    if (verbose && !quiet) {
+        fprintf(stderr, "Tokenization complete: %zu tokens found\n", token_count);
+    }
+
+    rift_regex_tokenizer_free(tokenizer);
+    if (input) {
+        munmap(input, size);
+    }
+
+    return result;
+}
+
 /**
  * @brief Get help information for the tokenize command
  *
@@ -427,7 +578,8 @@ tokenize_get_help(const rift_command_t *command)
            "\n"
            "Options:\n"
            "  --output, -o <file>       Output tokens to file (default: stdout)\n"
-           "  --format <json|text>      Output format (default: text)\n"
+           "  --format <fmt>            Output format: json, text, or the streamed span\n"
+           "                            formats ndjson, cbor and binary (default: text)\n"
            "  --rules <file>            Custom tokenization rules file\n"
            "  --ignore <pattern>        Pattern to ignore during tokenization\n"
            "  --case-sensitive          Enable case sensitivity\n"
@@ -435,7 +587,8 @@ tokenize_get_help(const rift_command_t *command)
            "\n"
            "Examples:\n"
            "  rift tokenize source.rf --output tokens.json --format json\n"
-           "  rift tokenize input.txt --case-sensitive";
+           "  rift tokenize input.txt --case-sensitive\n"
+           "  rift tokenize huge.log --format binary --output tokens.bin";
 }
 
 ommand/rift_tokenize_command.h"/a #include "core/runtime/matcher.h"
@@ -0,0 +1,1072 @@
+/**
+ * @file serve_command.c
+ * @brief Serve command implementation for LibRift CLI
+ *
+ * This file implements the serve command. The ruleset is published through
+ * a rift_dsl_ruleset_t, so a reload swaps it in while batches already
+ * running finish on the old compilation. Each connection has a thread that
+ * reads its frames and queues its match requests; a pool of workers takes
+ * the queue a batch at a time, once the oldest request has waited the
+ * batching window or the batch is full, and matches the whole batch on one
+ * pin of the ruleset with rift_dsl_execute_all.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "cli/command/serve_command.h"
+#include <errno.h>
+#include <netdb.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+#include "core/dsl/rift_dsl_compiler.h"
+#include "core/dsl/rift_dsl_ruleset.h"
+#include "core/memory/memory.h"
+#include "core/runtime/metrics.h"
+
+/**
+ * @brief Default batching window in microseconds
+ */
+#define RIFT_SERVE_DEFAULT_WINDOW_US 200
+
+/**
+ * @brief Default number of requests in a batch
+ */
+#define RIFT_SERVE_DEFAULT_MAX_BATCH 64
+
+/**
+ * @brief Default largest input, in bytes
+ */
+#define RIFT_SERVE_DEFAULT_MAX_REQUEST (1024 * 1024)
+
+/**
+ * @brief Milliseconds between checks of the signals and of the ruleset file
+ */
+#define RIFT_SERVE_POLL_MS 1000
+
+/**
+ * @brief Bytes of a frame header: the length, then the type or status
+ */
+#define RIFT_SERVE_HEADER_SIZE 5
+
+/** Set by SIGINT and SIGTERM */
+static volatile sig_atomic_t serve_stop_requested;
+
+/** Set by SIGHUP */
+static volatile sig_atomic_t serve_reload_requested;
+
+/**
+ * @brief A match request waiting for its batch
+ */
+typedef struct serve_request {
+    const char *input;           /**< The input */
+    size_t length;               /**< Length of the input */
+    uint64_t arrival_ns;         /**< When the request was queued */
+    rift_output_buffer_t *reply; /**< Reply frame the matching rules are appended to */
+    bool failed;                 /**< Whether the rules could not be appended */
+    bool done;                   /**< Whether the request was matched */
+    pthread_cond_t done_cond;    /**< Signaled when the request is matched */
+    struct serve_request *next;  /**< Next request of the queue or batch */
+} serve_request_t;
+
+/**
+ * @brief An open client connection
+ */
+typedef struct serve_connection {
+    struct serve_state *state;     /**< The server */
+    int fd;                        /**< The socket */
+    struct serve_connection *next; /**< Next open connection */
+} serve_connection_t;
+
+/**
+ * @brief State shared by the listener, the connections and the workers
+ */
+typedef struct serve_state {
+    const rift_serve_options_t *options; /**< Options of the command */
+    rift_dsl_ruleset_t *ruleset;         /**< The published compilation */
+    rift_metrics_t *metrics;             /**< Registry the matches are recorded in */
+    uint32_t metrics_pattern;            /**< Identifier of the ruleset in the registry */
+    pthread_mutex_t lock;                /**< Guards everything below */
+    pthread_cond_t queued;               /**< Signaled when a request is queued or on stop */
+    pthread_cond_t closed;               /**< Signaled when a connection closes */
+    serve_request_t *head;               /**< Oldest queued request */
+    serve_request_t *tail;               /**< Newest queued request */
+    size_t num_queued;                   /**< Requests queued */
+    serve_connection_t *connections;     /**< Open connections */
+    size_t num_connections;              /**< Number of open connections */
+    bool stopping;                       /**< Whether the workers are to exit */
+    uint64_t num_requests;               /**< Match requests matched */
+    uint64_t num_batches;                /**< Batches matched */
+    uint64_t num_reloads;                /**< Ruleset reloads published */
+    uint64_t num_failed_reloads;         /**< Ruleset reloads that failed to compile */
+} serve_state_t;
+
+/**
+ * @brief Record a stop request
+ */
+static void
+handle_stop(int signal_number)
+{
+    (void)signal_number;
+    serve_stop_requested = 1;
+}
+
+/**
+ * @brief Record a reload request
+ */
+static void
+handle_reload(int signal_number)
+{
+    (void)signal_number;
+    serve_reload_requested = 1;
+}
+
+/**
+ * @brief Read the monotonic clock in nanoseconds
+ */
+static uint64_t
+now_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief Store a 32-bit integer in big-endian order
+ */
+static void
+put_u32(char *bytes, uint32_t value)
+{
+    bytes[0] = (char)(value >> 24);
+    bytes[1] = (char)(value >> 16);
+    bytes[2] = (char)(value >> 8);
+    bytes[3] = (char)value;
+}
+
+/**
+ * @brief Load a 32-bit integer stored in big-endian order
+ */
+static uint32_t
+get_u32(const char *bytes)
+{
+    const unsigned char *b = (const unsigned char *)bytes;
+    return ((uint32_t)b[0] << 24) | ((uint32_t)b[1] << 16) | ((uint32_t)b[2] << 8) | b[3];
+}
+
+/**
+ * @brief Read exactly length bytes from a socket
+ *
+ * @return true if successful, false on end of stream or error
+ */
+static bool
+read_full(int fd, char *buffer, size_t length)
+{
+    while (length > 0) {
+        ssize_t count = read(fd, buffer, length);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        buffer += count;
+        length -= (size_t)count;
+    }
+    return true;
+}
+
+/**
+ * @brief Write exactly length bytes to a socket
+ *
+ * @return true if successful, false on error
+ */
+static bool
+write_full(int fd, const char *buffer, size_t length)
+{
+    while (length > 0) {
+        ssize_t count = write(fd, buffer, length);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return false;
+        }
+        buffer += count;
+        length -= (size_t)count;
+    }
+    return true;
+}
+
+/**
+ * @brief Start a reply frame, leaving its length to frame_send
+ *
+ * @return true if successful, false on allocation failure
+ */
+static bool
+frame_begin(rift_output_buffer_t *frame, uint8_t status)
+{
+    char header[RIFT_SERVE_HEADER_SIZE] = {0, 0, 0, 0, (char)status};
+    rift_output_buffer_clear(frame);
+    return rift_output_buffer_append(frame, header, sizeof(header));
+}
+
+/**
+ * @brief Fill in the length of a reply frame and send it
+ *
+ * @return true if successful, false on error
+ */
+static bool
+frame_send(int fd, rift_output_buffer_t *frame)
+{
+    put_u32(frame->data, (uint32_t)(frame->length - 4));
+    return write_full(fd, frame->data, frame->length);
+}
+
+/**
+ * @brief Send an error reply
+ *
+ * @return true if successful, false on error
+ */
+static bool
+send_error(int fd, rift_output_buffer_t *frame, const char *message)
+{
+    return frame_begin(frame, RIFT_SERVE_STATUS_ERROR) &&
+           rift_output_buffer_append(frame, message, strlen(message)) && frame_send(fd, frame);
+}
+
+/**
+ * @brief Compile or map a ruleset, reporting why it cannot be loaded
+ *
+ * @param path The .rift source or bytecode container
+ * @param num_threads Threads the compilation may use
+ * @return The compilation or NULL on failure
+ */
+static void *
+load_ruleset(const char *path, size_t num_threads)
+{
+    /* Bytecode containers are mapped; anything else is compiled as .rift source */
+    size_t length = strlen(path);
+    bool is_source = length >= 5 && strcmp(path + length - 5, ".rift") == 0;
+    rift_dsl_compile_options_t compile_options = {.num_threads = num_threads};
+    void *compilation = is_source ? rift_dsl_compile_file(path, &compile_options)
+                                  : rift_dsl_map_compilation(path);
+    const char *error = compilation ? rift_dsl_get_compilation_error(compilation)
+                                    : "cannot read the file";
+    if (error) {
+        fprintf(stderr, "Error: Ruleset %s: %s\n", path, error);
+        rift_dsl_free_compilation(compilation);
+        return NULL;
+    }
+    return compilation;
+}
+
+/**
+ * @brief Recompile the ruleset and publish it, keeping the old one on failure
+ *
+ * @param state The server
+ * @param quiet Whether to leave successful reloads unreported
+ */
+static void
+reload_ruleset(serve_state_t *state, bool quiet)
+{
+    const rift_serve_options_t *options = state->options;
+    void *compilation = load_ruleset(options->rules_file, options->num_threads);
+    size_t num_rules = compilation ? rift_dsl_get_compiled_count(compilation) : 0;
+    bool published = compilation && rift_dsl_ruleset_swap(state->ruleset, compilation);
+    if (compilation && !published) {
+        fprintf(stderr, "Error: Failed to publish ruleset %s\n", options->rules_file);
+        rift_dsl_free_compilation(compilation);
+    }
+
+    pthread_mutex_lock(&state->lock);
+    if (published) {
+        state->num_reloads++;
+    } else {
+        state->num_failed_reloads++;
+    }
+    pthread_mutex_unlock(&state->lock);
+
+    if (published && !quiet) {
+        fprintf(stderr, "Reloaded %zu rules of %s\n", num_rules, options->rules_file);
+    }
+}
+
+/**
+ * @brief Append the index of a matching rule to the reply of a request
+ */
+static bool
+collect_rule(size_t index, void *user_data)
+{
+    serve_request_t *request = (serve_request_t *)user_data;
+    char bytes[4];
+    put_u32(bytes, (uint32_t)index);
+    if (!rift_output_buffer_append(request->reply, bytes, sizeof(bytes))) {
+        request->failed = true;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Match every request of a batch on one pin of the ruleset
+ *
+ * @param state The server
+ * @param batch The requests, linked by next
+ */
+static void
+match_batch(serve_state_t *state, serve_request_t *batch)
+{
+    rift_dsl_ruleset_guard_t guard;
+    void *compilation = rift_dsl_ruleset_pin(state->ruleset, &guard);
+
+    for (serve_request_t *request = batch; request; request = request->next) {
+        if (!compilation) {
+            request->failed = true;
+            continue;
+        }
+        uint64_t start = now_ns();
+        size_t matched = rift_dsl_execute_all(compilation, request->input, request->length,
+                                              collect_rule, request);
+        rift_metrics_record(state->metrics, state->metrics_pattern, RIFT_MATCH_ENGINE_LAZY_DFA,
+                            matched > 0, false, now_ns() - start);
+    }
+
+    rift_dsl_ruleset_unpin(state->ruleset, &guard);
+}
+
+/**
+ * @brief Match the queued requests a batch at a time until the server stops
+ *
+ * @param arg The server
+ * @return NULL
+ */
+static void *
+serve_worker(void *arg)
+{
+    serve_state_t *state = (serve_state_t *)arg;
+    const rift_serve_options_t *options = state->options;
+    uint64_t window_ns = (uint64_t)options->window_us * 1000u;
+
+    pthread_mutex_lock(&state->lock);
+    for (;;) {
+        while (!state->head && !state->stopping) {
+            pthread_cond_wait(&state->queued, &state->lock);
+        }
+        if (!state->head) {
+            break;
+        }
+
+        // The batch fills until the window of its oldest request closes; another worker
+        // may take it meanwhile
+        uint64_t deadline = state->head->arrival_ns + window_ns;
+        while (state->head && state->num_queued < options->max_batch && now_ns() < deadline) {
+            struct timespec until = {(time_t)(deadline / 1000000000u),
+                                     (long)(deadline % 1000000000u)};
+            pthread_cond_timedwait(&state->queued, &state->lock, &until);
+        }
+        if (!state->head) {
+            continue;
+        }
+
+        serve_request_t *batch = state->head;
+        serve_request_t *last = batch;
+        size_t count = 1;
+        while (count < options->max_batch && last->next) {
+            last = last->next;
+            count++;
+        }
+        state->head = last->next;
+        if (!state->head) {
+            state->tail = NULL;
+        }
+        last->next = NULL;
+        state->num_queued -= count;
+        state->num_requests += count;
+        state->num_batches++;
+        if (state->head) {
+            pthread_cond_signal(&state->queued);
+        }
+        pthread_mutex_unlock(&state->lock);
+
+        match_batch(state, batch);
+
+        pthread_mutex_lock(&state->lock);
+        for (serve_request_t *request = batch, *next; request; request = next) {
+            next = request->next;
+            request->done = true;
+            pthread_cond_signal(&request->done_cond);
+        }
+    }
+    pthread_mutex_unlock(&state->lock);
+    return NULL;
+}
+
+/**
+ * @brief Queue a match request, wait for its batch and send the reply
+ *
+ * @param state The server
+ * @param fd The client socket
+ * @param request The connection's request, with its reply frame
+ * @param input The input
+ * @param length Length of the input
+ * @return true if the reply was sent, false on error
+ */
+static bool
+answer_match(serve_state_t *state, int fd, serve_request_t *request, const char *input,
+             size_t length)
+{
+    char count[4] = {0};
+    if (!frame_begin(request->reply, RIFT_SERVE_STATUS_OK) ||
+        !rift_output_buffer_append(request->reply, count, sizeof(count))) {
+        return false;
+    }
+
+    request->input = length > 0 ? input : "";
+    request->length = length;
+    request->failed = false;
+    request->done = false;
+    request->next = NULL;
+
+    pthread_mutex_lock(&state->lock);
+    request->arrival_ns = now_ns();
+    if (state->tail) {
+        state->tail->next = request;
+    } else {
+        state->head = request;
+    }
+    state->tail = request;
+    state->num_queued++;
+    if (state->num_queued >= state->options->max_batch) {
+        pthread_cond_broadcast(&state->queued);
+    } else {
+        pthread_cond_signal(&state->queued);
+    }
+    while (!request->done) {
+        pthread_cond_wait(&request->done_cond, &state->lock);
+    }
+    pthread_mutex_unlock(&state->lock);
+
+    if (request->failed) {
+        return send_error(fd, request->reply, "Matching failed");
+    }
+    size_t num_rules = (request->reply->length - RIFT_SERVE_HEADER_SIZE - sizeof(count)) / 4;
+    put_u32(request->reply->data + RIFT_SERVE_HEADER_SIZE, (uint32_t)num_rules);
+    return frame_send(fd, request->reply);
+}
+
+/**
+ * @brief Send the metrics of the ruleset and of the server
+ *
+ * @param state The server
+ * @param fd The client socket
+ * @param frame Buffer for the reply frame
+ * @return true if the reply was sent, false on error
+ */
+static bool
+answer_metrics(serve_state_t *state, int fd, rift_output_buffer_t *frame)
+{
+    if (!frame_begin(frame, RIFT_SERVE_STATUS_OK) ||
+        !rift_metrics_snapshot(state->metrics, RIFT_METRICS_FORMAT_PROMETHEUS, frame)) {
+        return false;
+    }
+
+    pthread_mutex_lock(&state->lock);
+    char counters[512];
+    int length = snprintf(counters, sizeof(counters),
+                          "librift_serve_requests_total %llu\n"
+                          "librift_serve_batches_total %llu\n"
+                          "librift_serve_reloads_total %llu\n"
+                          "librift_serve_failed_reloads_total %llu\n"
+                          "librift_serve_connections %zu\n",
+                          (unsigned long long)state->num_requests,
+                          (unsigned long long)state->num_batches,
+                          (unsigned long long)state->num_reloads,
+                          (unsigned long long)state->num_failed_reloads, state->num_connections);
+    pthread_mutex_unlock(&state->lock);
+
+    return rift_output_buffer_append(frame, counters, (size_t)length) && frame_send(fd, frame);
+}
+
+/**
+ * @brief Answer the requests of a connection until it closes
+ *
+ * @param arg The connection, freed on return
+ * @return NULL
+ */
+static void *
+serve_connection(void *arg)
+{
+    serve_connection_t *connection = (serve_connection_t *)arg;
+    serve_state_t *state = connection->state;
+    int fd = connection->fd;
+
+    rift_output_buffer_t frame;
+    rift_output_buffer_init(&frame);
+    serve_request_t request;
+    memset(&request, 0, sizeof(request));
+    request.reply = &frame;
+    pthread_cond_init(&request.done_cond, NULL);
+
+    char *message = NULL;
+    size_t capacity = 0;
+    for (;;) {
+        char header[4];
+        if (!read_full(fd, header, sizeof(header))) {
+            break;
+        }
+        uint32_t length = get_u32(header);
+        if (length == 0 || length - 1 > state->options->max_request) {
+            send_error(fd, &frame, length == 0 ? "Empty frame" : "Request too large");
+            break;
+        }
+        if (length > capacity) {
+            char *grown = (char *)rift_realloc(message, length);
+            if (!grown) {
+                send_error(fd, &frame, "Out of memory");
+                break;
+            }
+            message = grown;
+            capacity = length;
+        }
+        if (!read_full(fd, message, length)) {
+            break;
+        }
+
+        bool ok;
+        switch ((uint8_t)message[0]) {
+        case RIFT_SERVE_REQUEST_MATCH:
+            ok = answer_match(state, fd, &request, message + 1, length - 1);
+            break;
+        case RIFT_SERVE_REQUEST_METRICS:
+            ok = answer_metrics(state, fd, &frame);
+            break;
+        default:
+            ok = send_error(fd, &frame, "Unknown request type");
+            break;
+        }
+        if (!ok) {
+            break;
+        }
+    }
+
+    rift_free(message);
+    rift_output_buffer_free(&frame);
+    pthread_cond_destroy(&request.done_cond);
+
+    pthread_mutex_lock(&state->lock);
+    serve_connection_t **link = &state->connections;
+    while (*link != connection) {
+        link = &(*link)->next;
+    }
+    *link = connection->next;
+    state->num_connections--;
+    pthread_cond_signal(&state->closed);
+    pthread_mutex_unlock(&state->lock);
+
+    close(fd);
+    rift_free(connection);
+    return NULL;
+}
+
+/**
+ * @brief Open the Unix socket or TCP address the server listens on
+ *
+ * @param options Options of the command
+ * @return The listening socket or -1 on failure
+ */
+static int
+open_listener(const rift_serve_options_t *options)
+{
+    if (options->socket_path) {
+        struct sockaddr_un address;
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (strlen(options->socket_path) >= sizeof(address.sun_path)) {
+            fprintf(stderr, "Error: Socket path %s is too long\n", options->socket_path);
+            return -1;
+        }
+        strcpy(address.sun_path, options->socket_path);
+
+        /* A socket left by an earlier server is replaced; any other file is not */
+        struct stat info;
+        if (lstat(options->socket_path, &info) == 0 && S_ISSOCK(info.st_mode)) {
+            unlink(options->socket_path);
+        }
+
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0 || bind(fd, (struct sockaddr *)&address, sizeof(address)) != 0 ||
+            listen(fd, SOMAXCONN) != 0) {
+            fprintf(stderr, "Error: Cannot listen on %s: %s\n", options->socket_path,
+                    strerror(errno));
+            if (fd >= 0) {
+                close(fd);
+            }
+            return -1;
+        }
+        return fd;
+    }
+
+    /* host:port, where the host may be bracketed and empty or * stands for any */
+    char *host = rift_strdup(options->listen);
+    char *colon = host ? strrchr(host, ':') : NULL;
+    if (!colon) {
+        fprintf(stderr, "Error: Invalid listen address '%s', expected host:port\n",
+                options->listen);
+        rift_free(host);
+        return -1;
+    }
+    *colon = '\0';
+    const char *port = colon + 1;
+    char *name = host;
+    size_t name_length = strlen(name);
+    if (name_length >= 2 && name[0] == '[' && name[name_length - 1] == ']') {
+        name[name_length - 1] = '\0';
+        name++;
+    }
+    bool any = name[0] == '\0' || strcmp(name, "*") == 0;
+
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+    struct addrinfo *addresses = NULL;
+    int status = getaddrinfo(any ? NULL : name, port, &hints, &addresses);
+    if (status != 0) {
+        fprintf(stderr, "Error: Cannot resolve %s: %s\n", options->listen, gai_strerror(status));
+        rift_free(host);
+        return -1;
+    }
+
+    int fd = -1;
+    for (struct addrinfo *address = addresses; address && fd < 0; address = address->ai_next) {
+        fd = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+        int reuse = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        if (bind(fd, address->ai_addr, address->ai_addrlen) != 0 ||
+            listen(fd, SOMAXCONN) != 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    if (fd < 0) {
+        fprintf(stderr, "Error: Cannot listen on %s: %s\n", options->listen, strerror(errno));
+    }
+
+    freeaddrinfo(addresses);
+    rift_free(host);
+    return fd;
+}
+
+/**
+ * @brief Start a thread for a new connection
+ *
+ * @param state The server
+ * @param fd The accepted socket, closed on failure
+ */
+static void
+start_connection(serve_state_t *state, int fd)
+{
+    serve_connection_t *connection = (serve_connection_t *)rift_malloc(sizeof(*connection));
+    if (!connection) {
+        close(fd);
+        return;
+    }
+    connection->state = state;
+    connection->fd = fd;
+
+    pthread_mutex_lock(&state->lock);
+    connection->next = state->connections;
+    state->connections = connection;
+    state->num_connections++;
+    pthread_mutex_unlock(&state->lock);
+
+    pthread_attr_t attributes;
+    pthread_attr_init(&attributes);
+    pthread_attr_setdetachstate(&attributes, PTHREAD_CREATE_DETACHED);
+    pthread_t thread;
+    bool started = pthread_create(&thread, &attributes, serve_connection, connection) == 0;
+    pthread_attr_destroy(&attributes);
+    if (started) {
+        return;
+    }
+
+    pthread_mutex_lock(&state->lock);
+    state->connections = connection->next;
+    state->num_connections--;
+    pthread_mutex_unlock(&state->lock);
+    close(fd);
+    rift_free(connection);
+}
+
+/**
+ * @brief Create a new serve command
+ *
+ * @return A new serve command instance or NULL on failure
+ */
+rift_command_t *
+rift_serve_command_create(void)
+{
+    rift_serve_command_t *cmd = (rift_serve_command_t *)rift_malloc(sizeof(rift_serve_command_t));
+    if (!cmd) {
+        return NULL;
+    }
+
+    memset(cmd, 0, sizeof(*cmd));
+    cmd->type = RIFT_COMMAND_SERVE;
+    cmd->options.window_us = RIFT_SERVE_DEFAULT_WINDOW_US;
+    cmd->options.max_batch = RIFT_SERVE_DEFAULT_MAX_BATCH;
+    cmd->options.max_request = RIFT_SERVE_DEFAULT_MAX_REQUEST;
+    cmd->options.watch = true;
+
+    return (rift_command_t *)cmd;
+}
+
+/**
+ * @brief Get the options for a serve command
+ *
+ * @param command The serve command
+ * @return Pointer to the serve options
+ */
+rift_serve_options_t *
+rift_serve_command_get_options(rift_command_t *command)
+{
+    rift_serve_command_t *cmd = (rift_serve_command_t *)command;
+    if (!cmd || cmd->type != RIFT_COMMAND_SERVE) {
+        return NULL;
+    }
+
+    return &cmd->options;
+}
+
+/**
+ * @brief Parse the arguments of a serve command
+ *
+ * @param command The serve command
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @return true if parsing was successful, false otherwise
+ */
+bool
+rift_serve_command_parse_args(rift_command_t *command, int argc, char *argv[])
+{
+    rift_serve_options_t *options = rift_serve_command_get_options(command);
+    if (!options) {
+        return false;
+    }
+
+    rift_serve_command_t *cmd = (rift_serve_command_t *)command;
+
+    for (int i = 0; i < argc; i++) {
+        const char *arg = argv[i];
+        bool takes_value = strcmp(arg, "--socket") == 0 || strcmp(arg, "--listen") == 0 ||
+                           strcmp(arg, "--window-us") == 0 || strcmp(arg, "--max-batch") == 0 ||
+                           strcmp(arg, "--max-request") == 0 || strcmp(arg, "-j") == 0 ||
+                           strcmp(arg, "--threads") == 0;
+        if (takes_value && i + 1 >= argc) {
+            if (!cmd->quiet) {
+                fprintf(stderr, "Error: Missing argument for %s option.\n", arg);
+            }
+            return false;
+        }
+
+        bool ok = true;
+        if (strcmp(arg, "--socket") == 0) {
+            rift_free(options->socket_path);
+            options->socket_path = rift_strdup(argv[++i]);
+            ok = options->socket_path != NULL;
+        } else if (strcmp(arg, "--listen") == 0) {
+            rift_free(options->listen);
+            options->listen = rift_strdup(argv[++i]);
+            ok = options->listen != NULL;
+        } else if (takes_value) {
+            /* The remaining options take a count */
+            char *end;
+            unsigned long value = strtoul(argv[++i], &end, 10);
+            if (*end != '\0' || argv[i][0] == '\0') {
+                fprintf(stderr, "Error: Invalid value '%s' for %s.\n", argv[i], arg);
+                return false;
+            }
+            if (strcmp(arg, "--window-us") == 0) {
+                options->window_us = (size_t)value;
+            } else if (strcmp(arg, "--max-batch") == 0) {
+                options->max_batch = value > 0 ? (size_t)value : 1;
+            } else if (strcmp(arg, "--max-request") == 0) {
+                options->max_request = value < UINT32_MAX ? (size_t)value : UINT32_MAX - 1;
+            } else {
+                options->num_threads = (size_t)value;
+            }
+        } else if (strcmp(arg, "--no-watch") == 0) {
+            options->watch = false;
+        } else if (arg[0] == '-' && arg[1] != '\0') {
+            if (!cmd->quiet) {
+                fprintf(stderr, "Warning: Unknown option '%s' ignored.\n", arg);
+            }
+        } else if (!options->rules_file) {
+            options->rules_file = rift_strdup(arg);
+            ok = options->rules_file != NULL;
+        } else if (!cmd->quiet) {
+            fprintf(stderr, "Warning: Extra argument '%s' ignored.\n", arg);
+        }
+
+        if (!ok) {
+            fprintf(stderr, "Error: Failed to allocate memory for arguments\n");
+            return false;
+        }
+    }
+
+    if (!options->rules_file) {
+        if (!cmd->quiet) {
+            fprintf(stderr, "Error: A ruleset is required.\n");
+        }
+        return false;
+    }
+
+    if ((options->socket_path != NULL) == (options->listen != NULL)) {
+        if (!cmd->quiet) {
+            fprintf(stderr, "Error: Exactly one of --socket and --listen is required.\n");
+        }
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Execute a serve command
+ *
+ * @param command The serve command
+ * @return 0 on a clean shutdown, 1 on failure
+ */
+int
+rift_serve_command_execute(rift_command_t *command)
+{
+    rift_serve_options_t *options = rift_serve_command_get_options(command);
+    if (!options || !options->rules_file || (!options->socket_path && !options->listen)) {
+        fprintf(stderr, "Error: No ruleset or address specified\n");
+        return 1;
+    }
+
+    rift_serve_command_t *cmd = (rift_serve_command_t *)command;
+    rift_serve_options_t resolved = *options;
+    if (resolved.num_threads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        resolved.num_threads = cpus > 0 ? (size_t)cpus : 1;
+    }
+
+    struct stat info;
+    bool have_info = stat(resolved.rules_file, &info) == 0;
+    void *compilation = load_ruleset(resolved.rules_file, resolved.num_threads);
+    if (!compilation) {
+        return 1;
+    }
+    size_t num_rules = rift_dsl_get_compiled_count(compilation);
+
+    serve_state_t state;
+    memset(&state, 0, sizeof(state));
+    state.options = &resolved;
+    state.ruleset = rift_dsl_ruleset_create(compilation);
+    state.metrics = rift_metrics_create(1);
+    if (!state.ruleset || !state.metrics) {
+        fprintf(stderr, "Error: Failed to allocate the server\n");
+        if (state.ruleset) {
+            rift_dsl_ruleset_free(state.ruleset);
+        } else {
+            rift_dsl_free_compilation(compilation);
+        }
+        if (state.metrics) {
+            rift_metrics_free(state.metrics);
+        }
+        return 1;
+    }
+    state.metrics_pattern = rift_metrics_register_pattern(state.metrics, resolved.rules_file);
+
+    int listener = open_listener(&resolved);
+    if (listener < 0) {
+        rift_metrics_free(state.metrics);
+        rift_dsl_ruleset_free(state.ruleset);
+        return 1;
+    }
+
+    // The workers' timed waits for a batch to fill are on the monotonic clock
+    pthread_condattr_t condition_attributes;
+    pthread_condattr_init(&condition_attributes);
+    pthread_condattr_setclock(&condition_attributes, CLOCK_MONOTONIC);
+    pthread_mutex_init(&state.lock, NULL);
+    pthread_cond_init(&state.queued, &condition_attributes);
+    pthread_cond_init(&state.closed, NULL);
+    pthread_condattr_destroy(&condition_attributes);
+
+    // No SA_RESTART, so a signal interrupts the poll below at once
+    struct sigaction action, old_int, old_term, old_hup, old_pipe;
+    memset(&action, 0, sizeof(action));
+    sigemptyset(&action.sa_mask);
+    serve_stop_requested = 0;
+    serve_reload_requested = 0;
+    action.sa_handler = handle_stop;
+    sigaction(SIGINT, &action, &old_int);
+    sigaction(SIGTERM, &action, &old_term);
+    action.sa_handler = handle_reload;
+    sigaction(SIGHUP, &action, &old_hup);
+    action.sa_handler = SIG_IGN;
+    sigaction(SIGPIPE, &action, &old_pipe);
+
+    pthread_t *workers = (pthread_t *)rift_malloc(resolved.num_threads * sizeof(pthread_t));
+    size_t num_workers = 0;
+    while (workers && num_workers < resolved.num_threads &&
+           pthread_create(&workers[num_workers], NULL, serve_worker, &state) == 0) {
+        num_workers++;
+    }
+
+    int status = 0;
+    if (num_workers == 0) {
+        fprintf(stderr, "Error: Failed to start the worker threads\n");
+        status = 1;
+    } else if (!cmd->quiet) {
+        fprintf(stderr, "Serving %zu rules of %s on %s with %zu threads\n", num_rules,
+                resolved.rules_file, resolved.socket_path ? resolved.socket_path : resolved.listen,
+                num_workers);
+    }
+
+    while (status == 0 && !serve_stop_requested) {
+        struct pollfd pending = {listener, POLLIN, 0};
+        int ready = poll(&pending, 1, RIFT_SERVE_POLL_MS);
+        if (ready < 0 && errno != EINTR) {
+            fprintf(stderr, "Error: Cannot wait for connections: %s\n", strerror(errno));
+            status = 1;
+            break;
+        }
+
+        struct stat current;
+        bool changed = resolved.watch && stat(resolved.rules_file, &current) == 0 &&
+                       (!have_info || current.st_mtime != info.st_mtime ||
+                        current.st_size != info.st_size);
+        if (changed) {
+            info = current;
+            have_info = true;
+        }
+        if (serve_reload_requested || changed) {
+            serve_reload_requested = 0;
+            reload_ruleset(&state, cmd->quiet);
+        }
+
+        if (ready > 0 && (pending.revents & POLLIN)) {
+            int client = accept(listener, NULL, NULL);
+            if (client >= 0) {
+                start_connection(&state, client);
+            }
+        }
+    }
+
+    close(listener);
+    if (resolved.socket_path) {
+        unlink(resolved.socket_path);
+    }
+
+    // Closing the connections ends their reads; a request already queued is still
+    // matched, since the workers run until every connection has gone
+    pthread_mutex_lock(&state.lock);
+    for (serve_connection_t *connection = state.connections; connection;
+         connection = connection->next) {
+        shutdown(connection->fd, SHUT_RDWR);
+    }
+    while (state.num_connections > 0) {
+        pthread_cond_wait(&state.closed, &state.lock);
+    }
+    state.stopping = true;
+    pthread_cond_broadcast(&state.queued);
+    pthread_mutex_unlock(&state.lock);
+
+    for (size_t i = 0; i < num_workers; i++) {
+        pthread_join(workers[i], NULL);
+    }
+    rift_free(workers);
+
+    sigaction(SIGINT, &old_int, NULL);
+    sigaction(SIGTERM, &old_term, NULL);
+    sigaction(SIGHUP, &old_hup, NULL);
+    sigaction(SIGPIPE, &old_pipe, NULL);
+
+    if (cmd->verbose) {
+        fprintf(stderr, "Matched %llu requests in %llu batches, %llu reloads\n",
+                (unsigned long long)state.num_requests, (unsigned long long)state.num_batches,
+                (unsigned long long)state.num_reloads);
+    }
+
+    pthread_cond_destroy(&state.queued);
+    pthread_cond_destroy(&state.closed);
+    pthread_mutex_destroy(&state.lock);
+    rift_metrics_free(state.metrics);
+    rift_dsl_ruleset_free(state.ruleset);
+    return status;
+}
+
+/**
+ * @brief Get help information for a serve command
+ *
+ * @param command The serve command
+ * @return Help string for the command
+ */
+const char *
+rift_serve_command_get_help(const rift_command_t *command)
+{
+    (void)command;
+
+    return "serve <rules.rift> (--socket <path> | --listen <host:port>) [options]\n"
+           "\n"
+           "Compile the ruleset once and answer match requests from any number of\n"
+           "clients. Each frame is a 32-bit big-endian length and that many bytes, the\n"
+           "first being the type: 1 to match the rest of the frame, 2 for the metrics.\n"
+           "A reply starts with a status, 0 for success; a match reply then holds the\n"
+           "number of matching rules and their indices as 32-bit big-endian integers,\n"
+           "a metrics reply the metrics in the Prometheus text format. Requests arriving\n"
+           "within the batching window are matched together. SIGHUP, or a change to\n"
+           "the ruleset file, reloads the ruleset without dropping a request.\n"
+           "\n"
+           "Options:\n"
+           "  --socket <path>          Listen on a Unix socket\n"
+           "  --listen <host:port>     Listen on a TCP address (host * for any)\n"
+           "  --window-us <n>          Batching window in microseconds (default: 200)\n"
+           "  --max-batch <n>          Most requests in a batch (default: 64)\n"
+           "  --max-request <n>        Largest input in bytes (default: 1048576)\n"
+           "  --threads, -j <n>        Threads matching batches (default: one per CPU)\n"
+           "  --no-watch               Reload on SIGHUP only\n"
+           "\n"
+           "Examples:\n"
+           "  librift serve rules.rift --socket /run/rift.sock\n"
+           "  librift serve rules.rift --listen *:7070 --window-us 500 -j 8";
+}
+
+/**
+ * @brief Free resources associated with a serve command
+ *
+ * @param command The command to free
+ */
+void
+rift_serve_command_free(rift_command_t *command)
+{
+    rift_serve_options_t *options = rift_serve_command_get_options(command);
+    if (!options) {
+        return;
+    }
+
+    rift_free(options->rules_file);
+    rift_free(options->socket_path);
+    rift_free(options->listen);
+
+    rift_free(command);
+}
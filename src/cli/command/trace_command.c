@@ -0,0 +1,616 @@
+/**
+ * @file trace_command.c
+ * @brief Trace command implementation for LibRift CLI
+ *
+ * This file implements the trace command. The pattern's matches in the
+ * input are found by the backtracking matcher with a trace buffer attached,
+ * and the records the buffer kept are ranked by location, the states where
+ * the search backtracked most coming first.
+ *
+ * The heat map and the animation are drawn by the SVG renderer. Records
+ * are played over the automaton one frame at a time; the update manager
+ * merges what a frame did to each state, so a frame costs one refresh per
+ * state it touched and its patch holds just those states.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "cli/command/trace_command.h"
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "cli/visualizer/svg_renderer.h"
+#include "core/engine/pattern.h"
+#include "core/errors/regex_error.h"
+#include "core/memory/memory.h"
+#include "core/runtime/matcher.h"
+#include "core/runtime/trace_buffer.h"
+
+/** Margin around the states when the canvas is sized */
+#define CANVAS_MARGIN 60
+
+/**
+ * @brief Style of the heat map and the animation
+ *
+ * Heat grows with the logarithm of the backtracks at a state, see
+ * rift_svg_automaton_mapper_mark_state().
+ */
+static const char TRACE_STYLE[] =
+    "<style>\n"
+    ".state-body{fill:#fff;stroke:#333;stroke-width:2}\n"
+    ".accept-ring{fill:none;stroke:#333}\n"
+    ".transition path{fill:none;stroke:#999;marker-end:url(#arrow)}\n"
+    ".cluster rect{fill:#eee;stroke:#999}\n"
+    "text{font:12px sans-serif}\n"
+    "[data-heat=\"1\"] .state-body{fill:#fff5eb}\n"
+    "[data-heat=\"2\"] .state-body{fill:#fee6ce}\n"
+    "[data-heat=\"3\"] .state-body{fill:#fdd0a2}\n"
+    "[data-heat=\"4\"] .state-body{fill:#fdae6b}\n"
+    "[data-heat=\"5\"] .state-body{fill:#fd8d3c}\n"
+    "[data-heat=\"6\"] .state-body{fill:#f16913}\n"
+    "[data-heat=\"7\"] .state-body{fill:#d94801}\n"
+    "[data-heat=\"8\"] .state-body{fill:#8c2d04}\n"
+    ".active .state-body{stroke:#0057d9;stroke-width:5}\n"
+    "</style>\n";
+
+/**
+ * @brief Player of the animation: frames are patches of state groups
+ */
+static const char TRACE_PLAYER[] =
+    "var view = document.getElementById('view'), initial = view.innerHTML;\n"
+    "var label = document.getElementById('frame'), next = 0, timer = null;\n"
+    "function apply(patch) {\n"
+    "  var doc = new DOMParser().parseFromString(\n"
+    "      '<svg xmlns=\"http://www.w3.org/2000/svg\">' + patch + '</svg>', 'image/svg+xml');\n"
+    "  Array.prototype.slice.call(doc.documentElement.children).forEach(function (g) {\n"
+    "    var old = document.getElementById(g.id);\n"
+    "    if (g.getAttribute('data-removed')) { if (old) old.remove(); return; }\n"
+    "    var node = document.importNode(g, true);\n"
+    "    if (old) { old.replaceWith(node); return; }\n"
+    "    view.querySelector(g.id.charAt(0) == 't' ? 'g.transitions' : 'g.states')\n"
+    "        .appendChild(node);\n"
+    "  });\n"
+    "}\n"
+    "function show() { label.textContent = 'Frame ' + next + ' of ' + frames.length; }\n"
+    "function pause() { clearInterval(timer); timer = null; }\n"
+    "function step() { if (next >= frames.length) { pause(); return; } apply(frames[next++]);"
+    " show(); }\n"
+    "document.getElementById('play').onclick = function () {\n"
+    "  if (timer) { pause(); } else { timer = setInterval(step, 1000 / 30); }\n"
+    "};\n"
+    "document.getElementById('restart').onclick = function () {\n"
+    "  pause(); view.innerHTML = initial; next = 0; show();\n"
+    "};\n"
+    "show();\n";
+
+/**
+ * @brief Count a match found by the matcher
+ */
+static bool
+count_match(const rift_regex_span_t *spans, size_t num_spans, void *user_data)
+{
+    (void)spans;
+    (void)num_spans;
+    (*(size_t *)user_data)++;
+    return true;
+}
+
+/**
+ * @brief Size the canvas of a renderer to the states it placed
+ *
+ * @param renderer The renderer, after rendering
+ */
+static void
+fit_canvas(rift_svg_renderer_t *renderer)
+{
+    rift_svg_element_t *root = rift_svg_renderer_get_root_element(renderer);
+    rift_svg_element_t *states = rift_svg_element_get_child(root, 2);
+    int width = 2 * CANVAS_MARGIN;
+    int height = 2 * CANVAS_MARGIN;
+    for (size_t i = 0; i < rift_svg_element_get_child_count(states); i++) {
+        const char *transform =
+            rift_svg_element_get_attribute(rift_svg_element_get_child(states, i), "transform");
+        int x;
+        int y;
+        if (transform && sscanf(transform, "translate(%d,%d)", &x, &y) == 2) {
+            width = x + CANVAS_MARGIN > width ? x + CANVAS_MARGIN : width;
+            height = y + CANVAS_MARGIN > height ? y + CANVAS_MARGIN : height;
+        }
+    }
+    rift_svg_renderer_initialize(renderer, width, height);
+}
+
+/**
+ * @brief Write a string as a JavaScript string literal safe inside a script element
+ */
+static void
+write_js_string(FILE *out, const char *text)
+{
+    fputc('"', out);
+    for (const unsigned char *c = (const unsigned char *)text; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            fprintf(out, "\\%c", *c);
+        } else if (*c < 0x20 || *c == '<') {
+            fprintf(out, "\\u%04x", *c);
+        } else {
+            fputc(*c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+/**
+ * @brief Draw the trace over the automaton and write the heat map and the animation
+ *
+ * @param options Options of the command
+ * @param automaton The automaton of the pattern
+ * @param records The records, oldest first
+ * @param count Number of records
+ * @return true if every file was written, false otherwise
+ */
+static bool
+write_drawings(const rift_trace_options_t *options, void *automaton,
+               const rift_trace_record_t *records, size_t count)
+{
+    rift_svg_renderer_t *renderer = rift_svg_renderer_create();
+    char *svg = renderer ? rift_svg_renderer_render(renderer, automaton) : NULL;
+    if (!svg) {
+        fprintf(stderr, "Error: Cannot draw the automaton\n");
+        rift_svg_renderer_destroy(renderer);
+        return false;
+    }
+    rift_free(svg);
+    fit_canvas(renderer);
+    svg = rift_svg_renderer_render(renderer, automaton);
+
+    bool ok = svg != NULL;
+    FILE *html = NULL;
+    if (ok && options->html_file) {
+        html = fopen(options->html_file, "w");
+        if (!html) {
+            fprintf(stderr, "Error: Cannot write %s\n", options->html_file);
+            ok = false;
+        }
+    }
+
+    if (html) {
+        fputs("<!DOCTYPE html>\n<html>\n<head>\n<meta charset=\"utf-8\">\n"
+              "<title>LibRift trace</title>\n",
+              html);
+        fputs(TRACE_STYLE, html);
+        fputs("</head>\n<body>\n<p><button id=\"play\">Play</button> "
+              "<button id=\"restart\">Restart</button> <span id=\"frame\"></span></p>\n"
+              "<div id=\"view\">",
+              html);
+        fputs(svg, html);
+        fputs("</div>\n<script>\nvar frames = [\n", html);
+
+        /* One frame per slice of records, the states each slice touched */
+        size_t frames = options->frames > 0 ? options->frames : RIFT_TRACE_DEFAULT_FRAMES;
+        size_t per_frame = count / frames + (count % frames != 0);
+        for (size_t start = 0; ok && start < count; start += per_frame) {
+            size_t slice = count - start < per_frame ? count - start : per_frame;
+            rift_svg_renderer_play_trace(renderer, records + start, slice);
+            char *patch = rift_svg_renderer_render_changes(renderer);
+            ok = patch != NULL;
+            if (patch) {
+                write_js_string(html, patch);
+                fputs(",\n", html);
+            }
+            rift_free(patch);
+        }
+
+        fputs("];\n", html);
+        fputs(TRACE_PLAYER, html);
+        fputs("</script>\n</body>\n</html>\n", html);
+        if (fclose(html) != 0) {
+            ok = false;
+        }
+    } else {
+        rift_svg_renderer_play_trace(renderer, records, count);
+    }
+
+    /* The heat map is the last frame, the whole trace played */
+    if (ok && options->svg_file) {
+        rift_free(svg);
+        svg = rift_svg_renderer_render(renderer, automaton);
+        FILE *file = svg ? fopen(options->svg_file, "w") : NULL;
+
+        /* The style goes inside the svg element, the document's only root */
+        const char *body = svg ? strchr(svg, '>') : NULL;
+        ok = file && body && fwrite(svg, 1, (size_t)(body + 1 - svg), file) &&
+             fputs(TRACE_STYLE, file) >= 0 && fputs(body + 1, file) >= 0;
+        if (file && fclose(file) != 0) {
+            ok = false;
+        }
+        if (!ok) {
+            fprintf(stderr, "Error: Cannot write %s\n", options->svg_file);
+        }
+    }
+
+    rift_free(svg);
+    rift_svg_renderer_destroy(renderer);
+    return ok;
+}
+
+/**
+ * @brief Write the summary of the trace and its hotspots
+ */
+static void
+write_report(FILE *out, const rift_trace_options_t *options, size_t length, size_t matches,
+             const rift_trace_buffer_t *buffer, const rift_trace_record_t *records, size_t count,
+             const rift_trace_hotspot_t *hotspots, size_t num_hotspots)
+{
+    uint64_t total = rift_trace_buffer_get_total(buffer);
+    uint64_t events[RIFT_TRACE_EVENT_COUNT] = {0};
+    for (size_t i = 0; i < count; i++) {
+        events[records[i].event]++;
+    }
+
+    fprintf(out, "Trace of '%s' on %s: %zu bytes, %zu matches\n", options->pattern,
+            options->input_file ? options->input_file : "text", length, matches);
+    fprintf(out, "Records: %zu kept of %llu", count, (unsigned long long)total);
+    if (total > count) {
+        fprintf(out, ", the first %llu overwritten", (unsigned long long)(total - count));
+    }
+    fputs("\nEvents:", out);
+    for (size_t e = 0; e < RIFT_TRACE_EVENT_COUNT; e++) {
+        fprintf(out, " %s %llu%s", rift_trace_event_name((rift_trace_event_t)e),
+                (unsigned long long)events[e], e + 1 < RIFT_TRACE_EVENT_COUNT ? "," : "\n");
+    }
+
+    if (num_hotspots == 0) {
+        return;
+    }
+    fprintf(out, "\nHotspots\n%-4s %-8s %12s %12s %12s\n", "rank", "state", "backtracks",
+            "failures", "records");
+    for (size_t i = 0; i < num_hotspots; i++) {
+        char state[16];
+        if (hotspots[i].location == RIFT_TRACE_NO_LOCATION) {
+            snprintf(state, sizeof(state), "-");
+        } else {
+            snprintf(state, sizeof(state), "q%u", (unsigned)hotspots[i].location);
+        }
+        fprintf(out, "%-4zu %-8s %12llu %12llu %12llu\n", i + 1, state,
+                (unsigned long long)hotspots[i].backtracks,
+                (unsigned long long)hotspots[i].failures,
+                (unsigned long long)hotspots[i].records);
+    }
+}
+
+/**
+ * @brief Create a new trace command
+ *
+ * @return A new trace command instance or NULL on failure
+ */
+rift_command_t *
+rift_trace_command_create(void)
+{
+    rift_trace_command_t *cmd = (rift_trace_command_t *)rift_malloc(sizeof(rift_trace_command_t));
+    if (!cmd) {
+        return NULL;
+    }
+
+    memset(cmd, 0, sizeof(*cmd));
+    cmd->type = RIFT_COMMAND_TRACE;
+    cmd->options.top = RIFT_TRACE_DEFAULT_TOP;
+    cmd->options.frames = RIFT_TRACE_DEFAULT_FRAMES;
+    cmd->options.flags = 0; /* RIFT_REGEX_FLAG_NONE */
+
+    return (rift_command_t *)cmd;
+}
+
+/**
+ * @brief Get the options for a trace command
+ *
+ * @param command The trace command
+ * @return Pointer to the trace options
+ */
+rift_trace_options_t *
+rift_trace_command_get_options(rift_command_t *command)
+{
+    rift_trace_command_t *cmd = (rift_trace_command_t *)command;
+    if (!cmd || cmd->type != RIFT_COMMAND_TRACE) {
+        return NULL;
+    }
+
+    return &cmd->options;
+}
+
+/**
+ * @brief Parse a count given to an option
+ *
+ * @param text The argument
+ * @param value Where the count goes
+ * @return true if the argument is a count, false otherwise
+ */
+static bool
+parse_count(const char *text, size_t *value)
+{
+    char *end;
+    unsigned long long parsed = strtoull(text, &end, 10);
+    if (*text == '\0' || *end != '\0') {
+        fprintf(stderr, "Error: Invalid count '%s'.\n", text);
+        return false;
+    }
+    *value = (size_t)parsed;
+    return true;
+}
+
+/**
+ * @brief Replace a string option with a copy of an argument
+ */
+static bool
+set_string(char **option, const char *value)
+{
+    rift_free(*option);
+    *option = rift_strdup(value);
+    return *option != NULL;
+}
+
+/**
+ * @brief Parse the arguments of a trace command
+ *
+ * @param command The trace command
+ * @param argc Argument count
+ * @param argv Argument vector
+ * @return true if parsing was successful, false otherwise
+ */
+bool
+rift_trace_command_parse_args(rift_command_t *command, int argc, char *argv[])
+{
+    rift_trace_options_t *options = rift_trace_command_get_options(command);
+    if (!options) {
+        return false;
+    }
+
+    rift_trace_command_t *cmd = (rift_trace_command_t *)command;
+
+    for (int i = 0; i < argc; i++) {
+        const char *arg = argv[i];
+        bool takes_value = strcmp(arg, "-t") == 0 || strcmp(arg, "--text") == 0 ||
+                           strcmp(arg, "--buffer") == 0 || strcmp(arg, "--top") == 0 ||
+                           strcmp(arg, "--frames") == 0 || strcmp(arg, "--svg") == 0 ||
+                           strcmp(arg, "--html") == 0;
+        if (takes_value && i + 1 >= argc) {
+            if (!cmd->quiet) {
+                fprintf(stderr, "Error: Missing argument for %s option.\n", arg);
+            }
+            return false;
+        }
+
+        bool ok = true;
+        if (strcmp(arg, "-t") == 0 || strcmp(arg, "--text") == 0) {
+            ok = set_string(&options->text, argv[++i]);
+        } else if (strcmp(arg, "--buffer") == 0) {
+            if (!parse_count(argv[++i], &options->buffer_records)) {
+                return false;
+            }
+        } else if (strcmp(arg, "--top") == 0) {
+            if (!parse_count(argv[++i], &options->top)) {
+                return false;
+            }
+        } else if (strcmp(arg, "--frames") == 0) {
+            if (!parse_count(argv[++i], &options->frames)) {
+                return false;
+            }
+        } else if (strcmp(arg, "--svg") == 0) {
+            ok = set_string(&options->svg_file, argv[++i]);
+        } else if (strcmp(arg, "--html") == 0) {
+            ok = set_string(&options->html_file, argv[++i]);
+        } else if (strcmp(arg, "--backtracks-only") == 0) {
+            options->backtracks_only = true;
+        } else if (strcmp(arg, "--rift") == 0) {
+            options->flags |= RIFT_REGEX_FLAG_RIFT_SYNTAX;
+        } else if (strcmp(arg, "--case-insensitive") == 0 || strcmp(arg, "-i") == 0) {
+            options->flags |= RIFT_REGEX_FLAG_CASE_INSENSITIVE;
+        } else if (strcmp(arg, "--multiline") == 0 || strcmp(arg, "-m") == 0) {
+            options->flags |= RIFT_REGEX_FLAG_MULTILINE;
+        } else if (strcmp(arg, "--dotall") == 0 || strcmp(arg, "-s") == 0) {
+            options->flags |= RIFT_REGEX_FLAG_DOTALL;
+        } else if (arg[0] == '-' && arg[1] != '\0') {
+            if (!cmd->quiet) {
+                fprintf(stderr, "Warning: Unknown option '%s' ignored.\n", arg);
+            }
+        } else if (!options->pattern) {
+            ok = set_string(&options->pattern, arg);
+        } else if (!options->input_file) {
+            ok = set_string(&options->input_file, arg);
+        } else if (!cmd->quiet) {
+            fprintf(stderr, "Warning: Extra argument '%s' ignored.\n", arg);
+        }
+
+        if (!ok) {
+            fprintf(stderr, "Error: Failed to allocate memory for arguments\n");
+            return false;
+        }
+    }
+
+    if (!options->pattern) {
+        if (!cmd->quiet) {
+            fprintf(stderr, "Error: A pattern is required.\n");
+        }
+        return false;
+    }
+    if (!options->input_file == !options->text) {
+        if (!cmd->quiet) {
+            fprintf(stderr, "Error: Give either an input file or --text.\n");
+        }
+        return false;
+    }
+    if (options->frames == 0) {
+        options->frames = RIFT_TRACE_DEFAULT_FRAMES;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Execute a trace command
+ *
+ * @param command The trace command
+ * @return 0 on success, non-zero on failure
+ */
+int
+rift_trace_command_execute(rift_command_t *command)
+{
+    rift_trace_options_t *options = rift_trace_command_get_options(command);
+    if (!options || !options->pattern || (!options->input_file && !options->text)) {
+        fprintf(stderr, "Error: No pattern or input specified\n");
+        return 1;
+    }
+
+    rift_trace_command_t *cmd = (rift_trace_command_t *)command;
+
+    /* The input is mapped and searched in place */
+    void *mapping = NULL;
+    size_t length = 0;
+    const char *input = options->text;
+    if (options->input_file) {
+        int fd = open(options->input_file, O_RDONLY);
+        struct stat st;
+        if (fd < 0 || fstat(fd, &st) != 0) {
+            fprintf(stderr, "Error: Cannot open input file: %s\n", options->input_file);
+            if (fd >= 0) {
+                close(fd);
+            }
+            return 1;
+        }
+        length = (size_t)st.st_size;
+        mapping = length ? mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0) : NULL;
+        close(fd);
+        if (mapping == MAP_FAILED) {
+            fprintf(stderr, "Error: Cannot map input file: %s\n", options->input_file);
+            return 1;
+        }
+        input = mapping ? (const char *)mapping : "";
+    } else {
+        length = strlen(input);
+    }
+
+    rift_regex_error_t error;
+    rift_regex_error_init(&error);
+    rift_regex_pattern_t *pattern = rift_regex_compile(options->pattern, options->flags, &error);
+    rift_regex_matcher_t *matcher =
+        pattern ? rift_matcher_create(pattern, RIFT_MATCHER_OPTION_BACKTRACK) : NULL;
+    rift_trace_buffer_t *buffer =
+        matcher ? rift_trace_buffer_create(options->buffer_records) : NULL;
+    size_t capacity = rift_trace_buffer_get_capacity(buffer);
+    rift_trace_record_t *records =
+        buffer ? (rift_trace_record_t *)rift_malloc(capacity * sizeof(*records)) : NULL;
+    size_t top = options->top > 0 ? options->top : capacity;
+    rift_trace_hotspot_t *hotspots =
+        records ? (rift_trace_hotspot_t *)rift_malloc(top * sizeof(*hotspots)) : NULL;
+
+    int status = 0;
+    if (!pattern) {
+        fprintf(stderr, "Error: Cannot compile '%s': %s\n", options->pattern,
+                rift_regex_error_message(&error));
+        status = 1;
+    } else if (!hotspots) {
+        fprintf(stderr, "Error: Failed to allocate memory for the trace\n");
+        status = 1;
+    } else {
+        if (options->backtracks_only) {
+            rift_trace_buffer_set_events(buffer, 1u << RIFT_TRACE_EVENT_BACKTRACK);
+        }
+        rift_matcher_set_trace(matcher, buffer);
+
+        size_t matches = 0;
+        if (cmd->verbose && !cmd->quiet) {
+            fprintf(stderr, "Tracing %s...\n", options->pattern);
+        }
+        if (rift_matcher_set_input(matcher, input, length)) {
+            rift_matcher_for_each_match(matcher, count_match, &matches);
+        }
+        rift_matcher_set_trace(matcher, NULL);
+
+        size_t count = rift_trace_buffer_snapshot(buffer, records, capacity);
+        size_t num_hotspots = rift_trace_find_hotspots(records, count, hotspots, top);
+        if (!cmd->quiet) {
+            write_report(stdout, options, length, matches, buffer, records, count, hotspots,
+                         num_hotspots);
+        }
+
+        if ((options->svg_file || options->html_file) &&
+            !write_drawings(options, rift_regex_pattern_get_automaton(pattern), records,
+                            count)) {
+            status = 1;
+        }
+    }
+
+    rift_free(hotspots);
+    rift_free(records);
+    rift_trace_buffer_free(buffer);
+    rift_matcher_free(matcher);
+    rift_regex_pattern_free(pattern);
+    if (mapping) {
+        munmap(mapping, length);
+    }
+    return status;
+}
+
+/**
+ * @brief Get help information for a trace command
+ *
+ * @param command The trace command
+ * @return Help string for the command
+ */
+const char *
+rift_trace_command_get_help(const rift_command_t *command)
+{
+    (void)command;
+
+    return "trace <pattern> <input> [options]\n"
+           "trace <pattern> --text <string> [options]\n"
+           "\n"
+           "Search the input with the backtracking matcher while it records each step,\n"
+           "failure, backtrack and match into a ring buffer, then rank the states by the\n"
+           "backtracking they saw. The trace can be drawn over the automaton as a heat map\n"
+           "or played as an animation. Long searches keep only their latest records.\n"
+           "\n"
+           "Options:\n"
+           "  -t, --text <string>      Search this string instead of a file\n"
+           "  --buffer <n>             Records the trace keeps (default: 65536)\n"
+           "  --backtracks-only        Record backtracks only, to cover longer searches\n"
+           "  --top <n>                Hotspots reported, 0 for all (default: 10)\n"
+           "  --svg <file>             Write the automaton colored by backtracks\n"
+           "  --html <file>            Write an animation of the trace over the automaton\n"
+           "  --frames <n>             Most frames of the animation (default: 200)\n"
+           "  --rift                   Enable LibRift r'' syntax\n"
+           "  --case-insensitive, -i   Case insensitive matching\n"
+           "  --multiline, -m          ^ and $ match start/end of line\n"
+           "  --dotall, -s             . matches newline\n"
+           "\n"
+           "Examples:\n"
+           "  librift trace \"(a|aa)*b\" --text aaaaaaaaaaaaaaaaaaaac --html trace.html\n"
+           "  librift trace \"(\\w+\\s?)*$\" app.log --backtracks-only --svg hot.svg";
+}
+
+/**
+ * @brief Free resources associated with a trace command
+ *
+ * @param command The command to free
+ */
+void
+rift_trace_command_free(rift_command_t *command)
+{
+    rift_trace_options_t *options = rift_trace_command_get_options(command);
+    if (!options) {
+        return;
+    }
+
+    rift_free(options->pattern);
+    rift_free(options->input_file);
+    rift_free(options->text);
+    rift_free(options->svg_file);
+    rift_free(options->html_file);
+
+    rift_free(command);
+}
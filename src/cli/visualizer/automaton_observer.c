@@ -0,0 +1,135 @@
+/**
+ * @file automaton_observer.c
+ * @brief Implementation of the automaton observer interface
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "cli/visualizer/automaton_observer.h"
+#include <string.h>
+#include "core/memory/memory.h"
+
+/**
+ * @brief Creates a new automaton observer
+ *
+ * @param update_callback The callback function to receive updates
+ * @param user_data User data to pass to the callback
+ * @return rift_automaton_observer_t* A new observer instance or NULL on failure
+ */
+rift_automaton_observer_t *
+rift_automaton_observer_create(rift_automaton_update_callback_t update_callback, void *user_data)
+{
+    rift_automaton_observer_t *observer = rift_malloc(sizeof(rift_automaton_observer_t));
+    if (!observer) {
+        return NULL;
+    }
+
+    memset(observer, 0, sizeof(*observer));
+    observer->update = update_callback;
+    observer->user_data = user_data;
+    return observer;
+}
+
+/**
+ * @brief Destroys an automaton observer
+ *
+ * @param observer The observer to destroy
+ */
+void
+rift_automaton_observer_destroy(rift_automaton_observer_t *observer)
+{
+    rift_free(observer);
+}
+
+/**
+ * @brief Holds back a change to an automaton until the batch ends
+ *
+ * A batch remembers one automaton; a change to another one delivers the
+ * update of the first right away, so no change is lost.
+ *
+ * @param observer The observer, in a batch
+ * @param automaton The automaton that changed
+ */
+static void
+hold_change(rift_automaton_observer_t *observer, void *automaton)
+{
+    if (observer->batch_automaton && observer->batch_automaton != automaton &&
+        observer->update) {
+        observer->update(observer, observer->batch_automaton);
+    }
+    observer->batch_automaton = automaton;
+}
+
+/**
+ * @brief Starts holding back the notifications of an observer
+ *
+ * @param observer The observer (can be NULL)
+ */
+void
+rift_automaton_observer_begin_batch(rift_automaton_observer_t *observer)
+{
+    if (observer) {
+        observer->batch_depth++;
+    }
+}
+
+/**
+ * @brief Ends a batch and delivers the changes it held back as one update
+ *
+ * @param observer The observer (can be NULL)
+ */
+void
+rift_automaton_observer_end_batch(rift_automaton_observer_t *observer)
+{
+    if (!observer || observer->batch_depth == 0 || --observer->batch_depth > 0) {
+        return;
+    }
+
+    void *automaton = observer->batch_automaton;
+    observer->batch_automaton = NULL;
+    if (automaton && observer->update) {
+        observer->update(observer, automaton);
+    }
+}
+
+/**
+ * @brief Notifies an observer of an automaton update
+ *
+ * @param observer The observer to notify
+ * @param automaton The updated automaton
+ */
+void
+rift_automaton_observer_notify(rift_automaton_observer_t *observer, void *automaton)
+{
+    if (observer && observer->batch_depth > 0) {
+        hold_change(observer, automaton);
+    } else if (observer && observer->update) {
+        observer->update(observer, automaton);
+    }
+}
+
+/**
+ * @brief Notifies an observer of a change to one state or transition
+ *
+ * @param observer The observer to notify
+ * @param automaton The automaton the element belongs to
+ * @param type What changed
+ * @param element The state or transition that changed
+ */
+void
+rift_automaton_observer_notify_change(rift_automaton_observer_t *observer, void *automaton,
+                                      rift_automaton_change_type_t type, void *element)
+{
+    if (!observer) {
+        return;
+    }
+
+    if (observer->batch_depth > 0) {
+        hold_change(observer, automaton);
+    } else if (observer->changed) {
+        observer->changed(observer, automaton, type, element);
+    } else {
+        rift_automaton_observer_notify(observer, automaton);
+    }
+}
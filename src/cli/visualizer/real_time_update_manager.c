@@ -0,0 +1,436 @@
+/**
+ * @file real_time_update_manager.c
+ * @brief Implementation of the real-time update manager
+ *
+ * Waiting updates are kept in scheduling order with an index from element
+ * to update, which is what merges a burst of changes to one element into a
+ * single update.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "cli/visualizer/real_time_update_manager.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "core/memory/memory.h"
+
+/** Key of an index slot whose update was cancelled */
+#define TOMBSTONE ((void *)&tombstone_marker)
+static char tombstone_marker;
+
+/**
+ * @brief Index slot from an element to its waiting update
+ */
+typedef struct pending_slot {
+    void *element; /**< Element, NULL for a free slot */
+    size_t index;  /**< Position of its update in the pending array */
+} pending_slot_t;
+
+/**
+ * @brief Real-time update manager structure
+ */
+struct rift_real_time_update_manager {
+    rift_svg_automaton_mapper_t *mapper; /**< Mapper the updates are applied to */
+    rift_update_entry_t *pending;        /**< Waiting updates, element NULL when cancelled */
+    size_t num_pending;                  /**< Updates in the pending array */
+    size_t pending_capacity;             /**< Capacity of the pending array */
+    size_t live;                         /**< Updates not cancelled */
+    pending_slot_t *slots;               /**< Index of the waiting updates */
+    size_t slot_capacity;                /**< Slots, a power of two */
+    bool resync;                         /**< Whether a layout change waits */
+    void *resync_automaton;              /**< Automaton of the layout change or NULL */
+    uint32_t throttle_ms;                /**< Minimum time between two passes */
+    uint64_t last_processed;             /**< Timestamp of the last pass */
+};
+
+/**
+ * @brief Hash an address to a slot
+ */
+static size_t
+hash_element(const void *element, size_t capacity)
+{
+    uint64_t h = (uint64_t)(uintptr_t)element;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return (size_t)h & (capacity - 1);
+}
+
+/**
+ * @brief Find the index slot of an element
+ */
+static pending_slot_t *
+find_slot(const rift_real_time_update_manager_t *manager, const void *element)
+{
+    if (manager->slot_capacity == 0) {
+        return NULL;
+    }
+
+    size_t i = hash_element(element, manager->slot_capacity);
+    while (manager->slots[i].element) {
+        if (manager->slots[i].element == element) {
+            return &manager->slots[i];
+        }
+        i = (i + 1) & (manager->slot_capacity - 1);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Index the update at a position of the pending array
+ *
+ * The index holds at most one slot per pending update and is cleared with
+ * it, so it grows with the pending array rather than being rehashed.
+ */
+static bool
+index_update(rift_real_time_update_manager_t *manager, void *element, size_t index)
+{
+    if ((manager->num_pending + 1) * 2 > manager->slot_capacity) {
+        size_t capacity = manager->slot_capacity ? manager->slot_capacity * 2 : 64;
+        pending_slot_t *slots = rift_malloc(capacity * sizeof(pending_slot_t));
+        if (!slots) {
+            return false;
+        }
+        memset(slots, 0, capacity * sizeof(pending_slot_t));
+        for (size_t i = 0; i < manager->slot_capacity; i++) {
+            pending_slot_t *slot = &manager->slots[i];
+            if (!slot->element || slot->element == TOMBSTONE) {
+                continue;
+            }
+            size_t j = hash_element(slot->element, capacity);
+            while (slots[j].element) {
+                j = (j + 1) & (capacity - 1);
+            }
+            slots[j] = *slot;
+        }
+        rift_free(manager->slots);
+        manager->slots = slots;
+        manager->slot_capacity = capacity;
+    }
+
+    size_t i = hash_element(element, manager->slot_capacity);
+    while (manager->slots[i].element) {
+        i = (i + 1) & (manager->slot_capacity - 1);
+    }
+    manager->slots[i].element = element;
+    manager->slots[i].index = index;
+    return true;
+}
+
+/**
+ * @brief Whether an update is about a state
+ */
+static bool
+is_state_update(rift_update_type_t type)
+{
+    return type == RIFT_UPDATE_TYPE_STATE_ADDED || type == RIFT_UPDATE_TYPE_STATE_REMOVED ||
+           type == RIFT_UPDATE_TYPE_STATE_MODIFIED;
+}
+
+/**
+ * @brief Order updates with states first, then by descending priority
+ */
+static int
+compare_updates(const void *a, const void *b)
+{
+    const rift_update_entry_t *x = a;
+    const rift_update_entry_t *y = b;
+    bool x_state = is_state_update(x->type);
+    bool y_state = is_state_update(y->type);
+    if (x_state != y_state) {
+        return x_state ? -1 : 1;
+    }
+    if (x->priority != y->priority) {
+        return x->priority > y->priority ? -1 : 1;
+    }
+    /* Earlier updates first among equals */
+    return x->timestamp < y->timestamp ? -1 : (x->timestamp > y->timestamp ? 1 : 0);
+}
+
+/**
+ * @brief Drop every waiting update
+ */
+static void
+clear_pending(rift_real_time_update_manager_t *manager)
+{
+    if (manager->slot_capacity > 0) {
+        memset(manager->slots, 0, manager->slot_capacity * sizeof(pending_slot_t));
+    }
+    manager->num_pending = 0;
+    manager->live = 0;
+    manager->resync = false;
+    manager->resync_automaton = NULL;
+}
+
+/**
+ * @brief Creates a new real-time update manager
+ *
+ * @param mapper The automaton mapper to use
+ * @return rift_real_time_update_manager_t* A new update manager or NULL on failure
+ */
+rift_real_time_update_manager_t *
+rift_real_time_update_manager_create(rift_svg_automaton_mapper_t *mapper)
+{
+    if (!mapper) {
+        return NULL;
+    }
+
+    rift_real_time_update_manager_t *manager =
+        rift_malloc(sizeof(rift_real_time_update_manager_t));
+    if (!manager) {
+        return NULL;
+    }
+
+    memset(manager, 0, sizeof(*manager));
+    manager->mapper = mapper;
+    manager->throttle_ms = RIFT_UPDATE_DEFAULT_THROTTLE_MS;
+    return manager;
+}
+
+/**
+ * @brief Destroys a real-time update manager and frees associated resources
+ *
+ * @param manager The manager to destroy
+ */
+void
+rift_real_time_update_manager_destroy(rift_real_time_update_manager_t *manager)
+{
+    if (!manager) {
+        return;
+    }
+
+    rift_free(manager->pending);
+    rift_free(manager->slots);
+    rift_free(manager);
+}
+
+/**
+ * @brief Schedules an update for processing
+ *
+ * @param manager The manager to use
+ * @param update The update to schedule
+ * @return bool True if scheduled successfully, false otherwise
+ */
+bool
+rift_real_time_update_manager_schedule_update(rift_real_time_update_manager_t *manager,
+                                              rift_update_entry_t update)
+{
+    if (!manager) {
+        return false;
+    }
+
+    if (update.type == RIFT_UPDATE_TYPE_LAYOUT_CHANGED) {
+        manager->resync = true;
+        if (update.element) {
+            manager->resync_automaton = update.element;
+        }
+        return true;
+    }
+    if (!update.element) {
+        return false;
+    }
+
+    pending_slot_t *slot = find_slot(manager, update.element);
+
+    if (update.type == RIFT_UPDATE_TYPE_STATE_REMOVED ||
+        update.type == RIFT_UPDATE_TYPE_TRANSITION_REMOVED) {
+        if (slot) {
+            manager->pending[slot->index].element = NULL;
+            slot->element = TOMBSTONE;
+            manager->live--;
+        }
+        if (update.type == RIFT_UPDATE_TYPE_STATE_REMOVED) {
+            rift_svg_automaton_mapper_remove_state(manager->mapper, update.element);
+        } else {
+            rift_svg_automaton_mapper_remove_transition(manager->mapper, update.element);
+        }
+        return true;
+    }
+
+    if (slot) {
+        rift_update_entry_t *waiting = &manager->pending[slot->index];
+        /* An addition stays one, since the element is not mapped yet */
+        if (waiting->type != RIFT_UPDATE_TYPE_STATE_ADDED &&
+            waiting->type != RIFT_UPDATE_TYPE_TRANSITION_ADDED) {
+            waiting->type = update.type;
+        }
+        if (update.priority > waiting->priority) {
+            waiting->priority = update.priority;
+        }
+        return true;
+    }
+
+    if (manager->num_pending == manager->pending_capacity) {
+        size_t capacity = manager->pending_capacity ? manager->pending_capacity * 2 : 64;
+        rift_update_entry_t *pending =
+            rift_realloc(manager->pending, capacity * sizeof(rift_update_entry_t));
+        if (!pending) {
+            return false;
+        }
+        manager->pending = pending;
+        manager->pending_capacity = capacity;
+    }
+    if (!index_update(manager, update.element, manager->num_pending)) {
+        return false;
+    }
+
+    if (update.timestamp == 0) {
+        update.timestamp = rift_real_time_update_manager_get_timestamp();
+    }
+    manager->pending[manager->num_pending++] = update;
+    manager->live++;
+    return true;
+}
+
+/**
+ * @brief Apply the waiting updates to the mapper
+ */
+static int
+apply_pending(rift_real_time_update_manager_t *manager)
+{
+    rift_svg_automaton_mapper_t *mapper = manager->mapper;
+    void *automaton = manager->resync_automaton ? manager->resync_automaton
+                                                : rift_svg_automaton_mapper_get_automaton(mapper);
+    int processed = (int)manager->live + (manager->resync ? 1 : 0);
+
+    /* Past a quarter of the mapped elements, one pass over the automaton is cheaper */
+    size_t mapped = rift_svg_automaton_mapper_get_element_count(mapper);
+    bool resync = manager->resync || (automaton && manager->live * 4 > mapped);
+
+    if (resync && automaton) {
+        rift_svg_automaton_mapper_update_elements_from_automaton(mapper, automaton);
+    } else {
+        /* Compact the cancelled updates away before ordering the rest */
+        size_t n = 0;
+        for (size_t i = 0; i < manager->num_pending; i++) {
+            if (manager->pending[i].element) {
+                manager->pending[n++] = manager->pending[i];
+            }
+        }
+        qsort(manager->pending, n, sizeof(rift_update_entry_t), compare_updates);
+
+        for (size_t i = 0; i < n; i++) {
+            if (is_state_update(manager->pending[i].type)) {
+                rift_svg_automaton_mapper_update_state(mapper, manager->pending[i].element);
+            } else {
+                rift_svg_automaton_mapper_update_transition(mapper, manager->pending[i].element);
+            }
+        }
+    }
+
+    clear_pending(manager);
+    manager->last_processed = rift_real_time_update_manager_get_timestamp();
+    return processed;
+}
+
+/**
+ * @brief Processes all pending updates
+ *
+ * @param manager The manager to use
+ * @return int The number of updates processed
+ */
+int
+rift_real_time_update_manager_process_updates(rift_real_time_update_manager_t *manager)
+{
+    if (!rift_real_time_update_manager_has_pending_updates(manager)) {
+        return 0;
+    }
+
+    uint64_t now = rift_real_time_update_manager_get_timestamp();
+    if (manager->last_processed != 0 && now - manager->last_processed < manager->throttle_ms) {
+        return 0;
+    }
+    return apply_pending(manager);
+}
+
+/**
+ * @brief Processes all pending updates regardless of the throttling interval
+ *
+ * @param manager The manager to use
+ * @return int The number of updates processed
+ */
+int
+rift_real_time_update_manager_flush(rift_real_time_update_manager_t *manager)
+{
+    if (!rift_real_time_update_manager_has_pending_updates(manager)) {
+        return 0;
+    }
+    return apply_pending(manager);
+}
+
+/**
+ * @brief Sets the throttling interval for updates
+ *
+ * @param manager The manager to modify
+ * @param interval_ms The throttling interval in milliseconds
+ * @return bool True if successful, false otherwise
+ */
+bool
+rift_real_time_update_manager_throttle_updates(rift_real_time_update_manager_t *manager,
+                                               uint32_t interval_ms)
+{
+    if (!manager) {
+        return false;
+    }
+
+    manager->throttle_ms = interval_ms;
+    return true;
+}
+
+/**
+ * @brief Gets the current timestamp in milliseconds
+ *
+ * @return uint64_t The current timestamp
+ */
+uint64_t
+rift_real_time_update_manager_get_timestamp(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000u + (uint64_t)now.tv_nsec / 1000000u;
+}
+
+/**
+ * @brief Creates a new update entry
+ *
+ * @param type The update type
+ * @param element The automaton element
+ * @param priority The update priority
+ * @return rift_update_entry_t The created update entry
+ */
+rift_update_entry_t
+rift_real_time_update_manager_create_update(rift_update_type_t type, void *element, int priority)
+{
+    rift_update_entry_t update;
+    update.type = type;
+    update.element = element;
+    update.timestamp = rift_real_time_update_manager_get_timestamp();
+    update.priority = priority;
+    return update;
+}
+
+/**
+ * @brief Checks if the manager has pending updates
+ *
+ * @param manager The manager to query
+ * @return bool True if there are pending updates, false otherwise
+ */
+bool
+rift_real_time_update_manager_has_pending_updates(rift_real_time_update_manager_t *manager)
+{
+    return manager && (manager->live > 0 || manager->resync);
+}
+
+/**
+ * @brief Gets the number of pending updates
+ *
+ * @param manager The manager to query
+ * @return size_t The number of pending updates
+ */
+size_t
+rift_real_time_update_manager_get_pending_update_count(rift_real_time_update_manager_t *manager)
+{
+    return manager ? manager->live + (manager->resync ? 1 : 0) : 0;
+}
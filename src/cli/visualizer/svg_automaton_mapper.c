@@ -0,0 +1,1587 @@
+/**
+ * @file svg_automaton_mapper.c
+ * @brief Implementation of the mapping between automata and SVG elements
+ *
+ * States and transitions are keyed by address in an open addressing table,
+ * so looking up the element of one of them stays constant time on automata
+ * with thousands of states.
+ *
+ * The layered layout follows Sugiyama: cycles are broken at the back edges
+ * of a depth-first search, states are layered by longest path, and the
+ * order within each layer is improved by barycenter sweeps. Every step is
+ * linear in the edges apart from sorting the layers, so laying out an
+ * automaton costs O(E + V log V) per sweep. Strongly connected components
+ * at or above the collapse threshold are drawn as one cluster node.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "cli/visualizer/svg_automaton_mapper.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "core/automaton/automaton.h"
+#include "core/automaton/state.h"
+#include "core/automaton/transition.h"
+#include "core/memory/memory.h"
+
+/** Radius of a state circle */
+#define STATE_RADIUS 20
+/** Radius of the inner ring of an accepting state */
+#define ACCEPT_RADIUS 16
+/** Horizontal distance between layout columns */
+#define COLUMN_SPACING 120
+/** Vertical distance between states of a column */
+#define ROW_SPACING 80
+/** Distance of the first column and row from the origin */
+#define LAYOUT_MARGIN 60
+/** Hottest data-heat of a traced state */
+#define MAX_HEAT 8
+
+/** Key of a table slot whose entry was removed */
+#define TOMBSTONE ((const void *)&tombstone_marker)
+static const char tombstone_marker;
+
+/**
+ * @brief Element mapped to one state or transition
+ */
+typedef struct mapping {
+    const void *key;             /**< State or transition, NULL for a free slot */
+    rift_svg_element_t *element; /**< Group drawing it */
+    bool is_state;               /**< Whether key is a state */
+    int x;                       /**< Centre of a state */
+    int y;                       /**< Centre of a state */
+    size_t generation;           /**< Last synchronization that found it */
+    const void *from;            /**< Source state of a transition */
+    const void *to;              /**< Target state of a transition */
+    size_t cluster;              /**< 1 + index of the cluster drawing a state, 0 if none */
+    size_t index;                /**< Position of a state in the automaton during a layout */
+    uint32_t visits;             /**< Trace records marked at a state */
+    uint32_t backtracks;         /**< Backtracks marked at a state */
+    bool active;                 /**< Whether a trace is at the state now */
+    bool traced;                 /**< Whether the state was ever marked */
+} mapping_t;
+
+/**
+ * @brief SVG automaton mapper structure
+ */
+struct rift_svg_automaton_mapper {
+    rift_regex_automaton_t *automaton;  /**< Automaton mapped */
+    rift_svg_element_t *root;           /**< Root svg element */
+    rift_svg_element_t *transitions;    /**< Group of the transition groups */
+    rift_svg_element_t *states;         /**< Group of the state groups, drawn above */
+    mapping_t *slots;                   /**< Open addressing table */
+    size_t capacity;                    /**< Slots, a power of two */
+    size_t count;                       /**< Live entries */
+    size_t used;                        /**< Live entries and tombstones */
+    size_t generation;                  /**< Current synchronization */
+    size_t next_transition_id;          /**< Number in the next transition ID */
+    size_t *column_rows;                /**< States placed in each layout column */
+    size_t num_columns;                 /**< Layout columns in use */
+    char **removed_ids;                 /**< IDs removed since they were last taken */
+    size_t num_removed;                 /**< Number of removed IDs */
+    size_t removed_capacity;            /**< Capacity of removed_ids */
+    int layout;                         /**< Layout of newly mapped automata */
+    size_t collapse_threshold;          /**< Smallest component collapsed, 0 for none */
+    rift_svg_element_t **clusters;      /**< Groups of the collapsed components */
+    size_t num_clusters;                /**< Number of clusters */
+    bool layout_stale;                  /**< Whether states or transitions changed since */
+};
+
+/**
+ * @brief Hash an address to a slot
+ */
+static size_t
+hash_key(const void *key, size_t capacity)
+{
+    uint64_t h = (uint64_t)(uintptr_t)key;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return (size_t)h & (capacity - 1);
+}
+
+/**
+ * @brief Find the entry of a key
+ */
+static mapping_t *
+find_mapping(const rift_svg_automaton_mapper_t *mapper, const void *key)
+{
+    if (!key || mapper->capacity == 0) {
+        return NULL;
+    }
+
+    size_t i = hash_key(key, mapper->capacity);
+    while (mapper->slots[i].key) {
+        if (mapper->slots[i].key == key) {
+            return &mapper->slots[i];
+        }
+        i = (i + 1) & (mapper->capacity - 1);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Rebuild the table with a capacity, dropping the tombstones
+ */
+static bool
+resize_table(rift_svg_automaton_mapper_t *mapper, size_t capacity)
+{
+    mapping_t *slots = rift_malloc(capacity * sizeof(mapping_t));
+    if (!slots) {
+        return false;
+    }
+    memset(slots, 0, capacity * sizeof(mapping_t));
+
+    for (size_t i = 0; i < mapper->capacity; i++) {
+        mapping_t *entry = &mapper->slots[i];
+        if (!entry->key || entry->key == TOMBSTONE) {
+            continue;
+        }
+        size_t j = hash_key(entry->key, capacity);
+        while (slots[j].key) {
+            j = (j + 1) & (capacity - 1);
+        }
+        slots[j] = *entry;
+    }
+
+    rift_free(mapper->slots);
+    mapper->slots = slots;
+    mapper->capacity = capacity;
+    mapper->used = mapper->count;
+    return true;
+}
+
+/**
+ * @brief Add an entry for a key that has none
+ *
+ * Entries move when the table grows, so earlier entry pointers are stale
+ * after this call.
+ */
+static mapping_t *
+insert_mapping(rift_svg_automaton_mapper_t *mapper, const void *key)
+{
+    if ((mapper->used + 1) * 2 > mapper->capacity) {
+        size_t capacity = mapper->capacity ? mapper->capacity : 64;
+        while ((mapper->count + 1) * 2 > capacity / 2) {
+            capacity *= 2;
+        }
+        if (!resize_table(mapper, capacity)) {
+            return NULL;
+        }
+    }
+
+    size_t i = hash_key(key, mapper->capacity);
+    while (mapper->slots[i].key && mapper->slots[i].key != TOMBSTONE) {
+        i = (i + 1) & (mapper->capacity - 1);
+    }
+    if (!mapper->slots[i].key) {
+        mapper->used++;
+    }
+    memset(&mapper->slots[i], 0, sizeof(mapping_t));
+    mapper->slots[i].key = key;
+    mapper->count++;
+    mapper->layout_stale = true;
+    return &mapper->slots[i];
+}
+
+/**
+ * @brief Record the ID of an element about to be removed
+ */
+static void
+record_removed(rift_svg_automaton_mapper_t *mapper, const rift_svg_element_t *element)
+{
+    const char *id = rift_svg_element_get_id(element);
+    if (!id) {
+        return;
+    }
+
+    if (mapper->num_removed == mapper->removed_capacity) {
+        size_t capacity = mapper->removed_capacity ? mapper->removed_capacity * 2 : 16;
+        char **ids = rift_realloc(mapper->removed_ids, capacity * sizeof(char *));
+        if (!ids) {
+            return;
+        }
+        mapper->removed_ids = ids;
+        mapper->removed_capacity = capacity;
+    }
+
+    char *copy = rift_strdup(id);
+    if (copy) {
+        mapper->removed_ids[mapper->num_removed++] = copy;
+    }
+}
+
+/**
+ * @brief Destroy the element of an entry and free its slot
+ */
+static void
+remove_mapping(rift_svg_automaton_mapper_t *mapper, mapping_t *entry)
+{
+    record_removed(mapper, entry->element);
+    rift_svg_element_destroy(entry->element);
+    entry->key = TOMBSTONE;
+    entry->element = NULL;
+    mapper->count--;
+    mapper->layout_stale = true;
+}
+
+/**
+ * @brief Create a child element and append it to a parent
+ */
+static rift_svg_element_t *
+append_new(rift_svg_element_t *parent, const char *name)
+{
+    rift_svg_element_t *element = rift_svg_element_create(name);
+    if (element && !rift_svg_element_append_child(parent, element)) {
+        rift_svg_element_destroy(element);
+        return NULL;
+    }
+    return element;
+}
+
+/**
+ * @brief Set an attribute to a formatted integer
+ */
+static void
+set_int_attribute(rift_svg_element_t *element, const char *name, int value)
+{
+    char buffer[24];
+    snprintf(buffer, sizeof(buffer), "%d", value);
+    rift_svg_element_set_attribute(element, name, buffer);
+}
+
+/**
+ * @brief Place a state in the next row of a layout column
+ */
+static void
+place_in_column(rift_svg_automaton_mapper_t *mapper, mapping_t *entry, size_t column)
+{
+    if (column >= mapper->num_columns) {
+        size_t *rows = rift_realloc(mapper->column_rows, (column + 1) * sizeof(size_t));
+        if (!rows) {
+            entry->x = LAYOUT_MARGIN;
+            entry->y = LAYOUT_MARGIN;
+            return;
+        }
+        memset(rows + mapper->num_columns, 0,
+               (column + 1 - mapper->num_columns) * sizeof(size_t));
+        mapper->column_rows = rows;
+        mapper->num_columns = column + 1;
+    }
+
+    entry->x = LAYOUT_MARGIN + (int)column * COLUMN_SPACING;
+    entry->y = LAYOUT_MARGIN + (int)mapper->column_rows[column]++ * ROW_SPACING;
+}
+
+/**
+ * @brief Refresh the group of a state from the state
+ */
+static void
+refresh_state_element(rift_svg_automaton_mapper_t *mapper, const mapping_t *entry)
+{
+    const rift_regex_state_t *state = entry->key;
+    rift_svg_element_t *group = entry->element;
+    char buffer[64];
+
+    const char *class_name = state->is_accepting ? "state accepting" : "state";
+    if (mapper->automaton && mapper->automaton->initial_state == state) {
+        class_name = state->is_accepting ? "state initial accepting" : "state initial";
+    }
+    snprintf(buffer, sizeof(buffer), "%s%s", class_name, entry->active ? " active" : "");
+    rift_svg_element_set_attribute(group, "class", buffer);
+
+    /* Only states that were ever marked carry the trace attributes */
+    if (entry->traced) {
+        int heat = 0;
+        for (uint32_t b = entry->backtracks; b && heat < MAX_HEAT; b >>= 1) {
+            heat++;
+        }
+        set_int_attribute(group, "data-heat", heat);
+        snprintf(buffer, sizeof(buffer), "%u", (unsigned)entry->visits);
+        rift_svg_element_set_attribute(group, "data-visits", buffer);
+        snprintf(buffer, sizeof(buffer), "%u", (unsigned)entry->backtracks);
+        rift_svg_element_set_attribute(group, "data-backtracks", buffer);
+    }
+
+    snprintf(buffer, sizeof(buffer), "translate(%d,%d)", entry->x, entry->y);
+    rift_svg_element_set_attribute(group, "transform", buffer);
+
+    snprintf(buffer, sizeof(buffer), "State %zu%s", state->id,
+             state->is_accepting ? ", accepting" : "");
+    rift_svg_element_set_accessible_label(group, buffer);
+
+    rift_svg_element_set_attribute(rift_svg_element_get_child(group, 1), "visibility",
+                                   state->is_accepting ? "visible" : "hidden");
+
+    snprintf(buffer, sizeof(buffer), "q%zu", state->id);
+    rift_svg_element_set_text(rift_svg_element_get_child(group, 2), buffer);
+
+    /* Only states that were ever collapsed carry the attribute */
+    if (entry->cluster || rift_svg_element_get_attribute(group, "display")) {
+        rift_svg_element_set_attribute(group, "display", entry->cluster ? "none" : "inline");
+    }
+}
+
+/**
+ * @brief Integer square root, rounded down
+ */
+static unsigned long
+isqrt(unsigned long value)
+{
+    unsigned long root = 0;
+    unsigned long bit = 1UL << (sizeof(unsigned long) * 8 - 2);
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+/**
+ * @brief Refresh the group of a transition from the transition
+ */
+static void
+refresh_transition_element(rift_svg_automaton_mapper_t *mapper, const mapping_t *entry)
+{
+    const rift_regex_transition_t *transition = entry->key;
+    const mapping_t *from = find_mapping(mapper, entry->from);
+    const mapping_t *to = find_mapping(mapper, entry->to);
+    if (!from || !to) {
+        return;
+    }
+
+    rift_svg_element_t *group = entry->element;
+    rift_svg_element_t *path = rift_svg_element_get_child(group, 0);
+    rift_svg_element_t *label = rift_svg_element_get_child(group, 1);
+    char buffer[160];
+    int label_x;
+    int label_y;
+
+    rift_svg_element_set_attribute(group, "class",
+                                   transition->is_epsilon ? "transition epsilon" : "transition");
+
+    /* Transitions inside a collapsed component are part of its cluster */
+    bool hidden = from->cluster && from->cluster == to->cluster;
+    if (hidden || rift_svg_element_get_attribute(group, "display")) {
+        rift_svg_element_set_attribute(group, "display", hidden ? "none" : "inline");
+    }
+
+    if (from == to) {
+        /* Loop drawn above the state */
+        snprintf(buffer, sizeof(buffer), "M%d,%d C%d,%d %d,%d %d,%d", from->x - 10,
+                 from->y - STATE_RADIUS + 3, from->x - 30, from->y - 70, from->x + 30,
+                 from->y - 70, from->x + 10, from->y - STATE_RADIUS + 3);
+        label_x = from->x;
+        label_y = from->y - 60;
+    } else {
+        /* Straight line between the circle edges */
+        long dx = to->x - from->x;
+        long dy = to->y - from->y;
+        long length = (long)isqrt((unsigned long)(dx * dx + dy * dy));
+        int ox = length > 0 ? (int)(dx * STATE_RADIUS / length) : 0;
+        int oy = length > 0 ? (int)(dy * STATE_RADIUS / length) : 0;
+        snprintf(buffer, sizeof(buffer), "M%d,%d L%d,%d", from->x + ox, from->y + oy, to->x - ox,
+                 to->y - oy);
+        label_x = (from->x + to->x) / 2;
+        label_y = (from->y + to->y) / 2 - 6;
+    }
+    rift_svg_element_set_attribute(path, "d", buffer);
+
+    set_int_attribute(label, "x", label_x);
+    set_int_attribute(label, "y", label_y);
+    if (transition->is_epsilon || !transition->input_pattern) {
+        rift_svg_element_set_text(label, "\xce\xb5");
+    } else {
+        rift_svg_element_set_text(label, transition->input_pattern);
+    }
+}
+
+/**
+ * @brief Build the group of a new state entry
+ */
+static bool
+build_state_element(rift_svg_automaton_mapper_t *mapper, mapping_t *entry)
+{
+    const rift_regex_state_t *state = entry->key;
+    char id[32];
+
+    rift_svg_element_t *group = rift_svg_element_create("g");
+    if (!group) {
+        return false;
+    }
+    snprintf(id, sizeof(id), "s%zu", state->id);
+    rift_svg_element_set_id(group, id);
+
+    rift_svg_element_t *body = append_new(group, "circle");
+    rift_svg_element_t *ring = append_new(group, "circle");
+    rift_svg_element_t *text = append_new(group, "text");
+    if (!body || !ring || !text || !rift_svg_element_append_child(mapper->states, group)) {
+        rift_svg_element_destroy(group);
+        return false;
+    }
+
+    set_int_attribute(body, "r", STATE_RADIUS);
+    rift_svg_element_set_attribute(body, "class", "state-body");
+    set_int_attribute(ring, "r", ACCEPT_RADIUS);
+    rift_svg_element_set_attribute(ring, "class", "accept-ring");
+    rift_svg_element_set_attribute(text, "text-anchor", "middle");
+    rift_svg_element_set_attribute(text, "dy", "0.35em");
+
+    entry->element = group;
+    refresh_state_element(mapper, entry);
+    return true;
+}
+
+/**
+ * @brief Build the group of a new transition entry
+ */
+static bool
+build_transition_element(rift_svg_automaton_mapper_t *mapper, mapping_t *entry)
+{
+    char id[32];
+
+    rift_svg_element_t *group = rift_svg_element_create("g");
+    if (!group) {
+        return false;
+    }
+    snprintf(id, sizeof(id), "t%zu", mapper->next_transition_id++);
+    rift_svg_element_set_id(group, id);
+
+    rift_svg_element_t *path = append_new(group, "path");
+    rift_svg_element_t *label = append_new(group, "text");
+    if (!path || !label || !rift_svg_element_append_child(mapper->transitions, group)) {
+        rift_svg_element_destroy(group);
+        return false;
+    }
+
+    rift_svg_element_set_attribute(path, "fill", "none");
+    rift_svg_element_set_attribute(path, "marker-end", "url(#arrow)");
+    rift_svg_element_set_attribute(label, "text-anchor", "middle");
+
+    entry->element = group;
+    refresh_transition_element(mapper, entry);
+    return true;
+}
+
+/**
+ * @brief Assign positions with the default layout
+ *
+ * States are placed in columns by breadth-first distance from the initial
+ * state; states it does not reach go in a column after the last.
+ */
+static void
+layout_breadth_first(rift_svg_automaton_mapper_t *mapper)
+{
+    rift_regex_automaton_t *automaton = mapper->automaton;
+    mapper->num_columns = 0;
+
+    size_t n = automaton->num_states;
+    rift_regex_state_t **queue = rift_malloc(n * sizeof(rift_regex_state_t *));
+    size_t *depth = rift_malloc(n * sizeof(size_t));
+    if (!queue || !depth) {
+        rift_free(queue);
+        rift_free(depth);
+        return;
+    }
+
+    /* Mark placed states by the generation, which no entry has yet */
+    size_t mark = ++mapper->generation;
+    size_t head = 0;
+    size_t tail = 0;
+    size_t max_depth = 0;
+    mapping_t *initial = find_mapping(mapper, automaton->initial_state);
+    if (initial) {
+        initial->generation = mark;
+        queue[tail] = automaton->initial_state;
+        depth[tail++] = 0;
+    }
+
+    while (head < tail) {
+        rift_regex_state_t *state = queue[head];
+        size_t d = depth[head++];
+        place_in_column(mapper, find_mapping(mapper, state), d);
+        max_depth = d > max_depth ? d : max_depth;
+
+        for (size_t i = 0; i < state->num_transitions && tail < n; i++) {
+            mapping_t *next = find_mapping(mapper, state->transitions[i]->to_state);
+            if (next && next->generation != mark) {
+                next->generation = mark;
+                queue[tail] = state->transitions[i]->to_state;
+                depth[tail++] = d + 1;
+            }
+        }
+    }
+
+    size_t unreached = tail > 0 ? max_depth + 1 : 0;
+    for (size_t i = 0; i < n; i++) {
+        mapping_t *entry = find_mapping(mapper, automaton->states[i]);
+        if (entry && entry->generation != mark) {
+            entry->generation = mark;
+            place_in_column(mapper, entry, unreached);
+        }
+    }
+
+    rift_free(queue);
+    rift_free(depth);
+}
+
+/**
+ * @brief Destroy the cluster groups and return their states to view
+ */
+static void
+clear_clusters(rift_svg_automaton_mapper_t *mapper, bool record)
+{
+    for (size_t i = 0; i < mapper->num_clusters; i++) {
+        if (record) {
+            record_removed(mapper, mapper->clusters[i]);
+        }
+        rift_svg_element_destroy(mapper->clusters[i]);
+    }
+    rift_free(mapper->clusters);
+    mapper->clusters = NULL;
+    mapper->num_clusters = 0;
+
+    for (size_t i = 0; i < mapper->capacity; i++) {
+        if (mapper->slots[i].key && mapper->slots[i].key != TOMBSTONE) {
+            mapper->slots[i].cluster = 0;
+        }
+    }
+}
+
+/**
+ * @brief Add the group drawing a collapsed component
+ */
+static bool
+add_cluster(rift_svg_automaton_mapper_t *mapper, size_t num_states, int x, int y)
+{
+    rift_svg_element_t **clusters =
+        rift_realloc(mapper->clusters, (mapper->num_clusters + 1) * sizeof(rift_svg_element_t *));
+    if (!clusters) {
+        return false;
+    }
+    mapper->clusters = clusters;
+
+    rift_svg_element_t *group = append_new(mapper->states, "g");
+    rift_svg_element_t *box = group ? append_new(group, "rect") : NULL;
+    rift_svg_element_t *text = box ? append_new(group, "text") : NULL;
+    if (!text) {
+        rift_svg_element_destroy(group);
+        return false;
+    }
+
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "c%zu", mapper->num_clusters);
+    rift_svg_element_set_id(group, buffer);
+    rift_svg_element_set_attribute(group, "class", "cluster");
+    snprintf(buffer, sizeof(buffer), "translate(%d,%d)", x, y);
+    rift_svg_element_set_attribute(group, "transform", buffer);
+    snprintf(buffer, sizeof(buffer), "Strongly connected component of %zu states", num_states);
+    rift_svg_element_set_accessible_label(group, buffer);
+
+    set_int_attribute(box, "x", -2 * STATE_RADIUS);
+    set_int_attribute(box, "y", -STATE_RADIUS);
+    set_int_attribute(box, "width", 4 * STATE_RADIUS);
+    set_int_attribute(box, "height", 2 * STATE_RADIUS);
+    rift_svg_element_set_attribute(box, "rx", "8");
+    rift_svg_element_set_attribute(text, "text-anchor", "middle");
+    rift_svg_element_set_attribute(text, "dy", "0.35em");
+    snprintf(buffer, sizeof(buffer), "%zu states", num_states);
+    rift_svg_element_set_text(text, buffer);
+
+    mapper->clusters[mapper->num_clusters++] = group;
+    return true;
+}
+
+/**
+ * @brief Label the strongly connected components of a graph
+ *
+ * Iterative Tarjan, so deep automata do not exhaust the stack. Components
+ * are numbered in reverse topological order.
+ *
+ * @return The number of components, or 0 if memory ran out
+ */
+static size_t
+find_components(size_t n, const size_t *offsets, const size_t *targets, size_t *component)
+{
+    const size_t unvisited = (size_t)-1;
+    size_t *order = rift_malloc(n * sizeof(size_t));
+    size_t *low = rift_malloc(n * sizeof(size_t));
+    size_t *stack = rift_malloc(n * sizeof(size_t));
+    size_t *frames = rift_malloc(n * sizeof(size_t));
+    size_t *next_edge = rift_malloc(n * sizeof(size_t));
+    size_t count = 0;
+    if (!order || !low || !stack || !frames || !next_edge) {
+        goto done;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        order[i] = unvisited;
+        component[i] = unvisited;
+    }
+
+    size_t counter = 0;
+    size_t depth = 0;
+    for (size_t root = 0; root < n; root++) {
+        if (order[root] != unvisited) {
+            continue;
+        }
+        size_t num_frames = 0;
+        frames[num_frames++] = root;
+        order[root] = low[root] = counter++;
+        next_edge[root] = offsets[root];
+        stack[depth++] = root;
+
+        while (num_frames > 0) {
+            size_t v = frames[num_frames - 1];
+            if (next_edge[v] < offsets[v + 1]) {
+                size_t w = targets[next_edge[v]++];
+                if (order[w] == unvisited) {
+                    order[w] = low[w] = counter++;
+                    next_edge[w] = offsets[w];
+                    stack[depth++] = w;
+                    frames[num_frames++] = w;
+                } else if (component[w] == unvisited && order[w] < low[v]) {
+                    /* w is still on the stack, so it is in the component of v */
+                    low[v] = order[w];
+                }
+                continue;
+            }
+
+            num_frames--;
+            if (num_frames > 0) {
+                size_t parent = frames[num_frames - 1];
+                low[parent] = low[v] < low[parent] ? low[v] : low[parent];
+            }
+            if (low[v] == order[v]) {
+                size_t w;
+                do {
+                    w = stack[--depth];
+                    component[w] = count;
+                } while (w != v);
+                count++;
+            }
+        }
+    }
+
+done:
+    rift_free(order);
+    rift_free(low);
+    rift_free(stack);
+    rift_free(frames);
+    rift_free(next_edge);
+    return count;
+}
+
+/**
+ * @brief Node of a layer with its sort key
+ */
+typedef struct layer_slot {
+    double key;  /**< Barycenter of the neighbours */
+    size_t node; /**< Node */
+} layer_slot_t;
+
+/**
+ * @brief Order layer slots by key, then by node for a stable result
+ */
+static int
+compare_layer_slots(const void *a, const void *b)
+{
+    const layer_slot_t *x = a;
+    const layer_slot_t *y = b;
+    if (x->key != y->key) {
+        return x->key < y->key ? -1 : 1;
+    }
+    return x->node < y->node ? -1 : (x->node > y->node ? 1 : 0);
+}
+
+/**
+ * @brief Reorder one layer by the barycenter of the neighbours on one side
+ */
+static void
+sweep_layer(size_t *layer, size_t count, const size_t *offsets, const size_t *targets,
+            const size_t *node_layer, size_t *position, bool below, layer_slot_t *slots)
+{
+    for (size_t i = 0; i < count; i++) {
+        size_t v = layer[i];
+        double sum = 0.0;
+        size_t degree = 0;
+        for (size_t e = offsets[v]; e < offsets[v + 1]; e++) {
+            size_t u = targets[e];
+            if (below ? node_layer[u] < node_layer[v] : node_layer[u] > node_layer[v]) {
+                sum += (double)position[u];
+                degree++;
+            }
+        }
+        slots[i].key = degree > 0 ? sum / (double)degree : (double)position[v];
+        slots[i].node = v;
+    }
+
+    qsort(slots, count, sizeof(layer_slot_t), compare_layer_slots);
+    for (size_t i = 0; i < count; i++) {
+        layer[i] = slots[i].node;
+        position[layer[i]] = i;
+    }
+}
+
+/** Barycenter sweeps down and up the layers */
+#define CROSSING_SWEEPS 4
+
+/**
+ * @brief Assign positions with the layered layout
+ *
+ * @return false if memory ran out, leaving the positions as they were
+ */
+static bool
+layout_layered(rift_svg_automaton_mapper_t *mapper)
+{
+    rift_regex_automaton_t *automaton = mapper->automaton;
+    size_t n = automaton->num_states;
+    rift_regex_state_t **states = automaton->states;
+
+    /* Number the mapped states and count their edges */
+    size_t num_edges = 0;
+    for (size_t i = 0; i < n; i++) {
+        mapping_t *entry = find_mapping(mapper, states[i]);
+        if (entry) {
+            entry->index = i;
+        }
+        num_edges += states[i]->num_transitions;
+    }
+
+    /* One block for every array the layout needs */
+    size_t words = 13 * n + 4 + 3 * num_edges;
+    size_t *block = rift_malloc(words * sizeof(size_t));
+    layer_slot_t *slots = rift_malloc((n + 1) * sizeof(layer_slot_t));
+    if (!block || !slots) {
+        rift_free(block);
+        rift_free(slots);
+        return false;
+    }
+    size_t *offsets = block;                       /* n + 1, edges of each state */
+    size_t *targets = offsets + n + 1;             /* num_edges */
+    size_t *node = targets + num_edges;            /* n, node drawing each state */
+    size_t *node_offsets = node + n;               /* n + 1, edges of each node */
+    size_t *node_targets = node_offsets + n + 1;   /* num_edges */
+    size_t *in_offsets = node_targets + num_edges; /* n + 1, reverse edges */
+    size_t *in_targets = in_offsets + n + 1;       /* num_edges */
+    size_t *component = in_targets + num_edges;    /* n */
+    size_t *post = component + n;                  /* n, postorder number */
+    size_t *node_layer = post + n;                 /* n */
+    size_t *position = node_layer + n;             /* n, position within the layer */
+    size_t *layers = position + n;                 /* n, nodes grouped by layer */
+    size_t *layer_start = layers + n;              /* n + 1 */
+    size_t *frames = layer_start + n + 1;          /* n */
+    size_t *next_edge = frames + n;                /* n */
+    size_t *by_post = next_edge + n;               /* n, nodes by postorder */
+
+    /* State graph in compressed rows */
+    size_t e = 0;
+    for (size_t i = 0; i < n; i++) {
+        offsets[i] = e;
+        for (size_t j = 0; j < states[i]->num_transitions; j++) {
+            const mapping_t *to = find_mapping(mapper, states[i]->transitions[j]->to_state);
+            if (to) {
+                targets[e++] = to->index;
+            }
+        }
+    }
+    offsets[n] = e;
+    num_edges = e;
+
+    /* Collapse the large components into their first state */
+    for (size_t i = 0; i < n; i++) {
+        node[i] = i;
+    }
+    if (mapper->collapse_threshold > 1) {
+        size_t num_components = find_components(n, offsets, targets, component);
+        size_t *size = num_components ? rift_malloc(2 * num_components * sizeof(size_t)) : NULL;
+        if (size) {
+            size_t *first = size + num_components;
+            memset(size, 0, num_components * sizeof(size_t));
+            for (size_t i = n; i-- > 0;) {
+                size[component[i]]++;
+                first[component[i]] = i;
+            }
+            for (size_t i = 0; i < n; i++) {
+                if (size[component[i]] >= mapper->collapse_threshold) {
+                    node[i] = first[component[i]];
+                }
+            }
+            rift_free(size);
+        }
+    }
+
+    /* Node graph, without the edges inside a node, and its reverse */
+    memset(node_offsets, 0, (n + 1) * sizeof(size_t));
+    memset(in_offsets, 0, (n + 1) * sizeof(size_t));
+    for (size_t v = 0; v < n; v++) {
+        for (size_t k = offsets[v]; k < offsets[v + 1]; k++) {
+            if (node[v] != node[targets[k]]) {
+                node_offsets[node[v] + 1]++;
+                in_offsets[node[targets[k]] + 1]++;
+            }
+        }
+    }
+    for (size_t v = 0; v < n; v++) {
+        node_offsets[v + 1] += node_offsets[v];
+        in_offsets[v + 1] += in_offsets[v];
+    }
+    memcpy(frames, node_offsets, n * sizeof(size_t));
+    memcpy(next_edge, in_offsets, n * sizeof(size_t));
+    for (size_t v = 0; v < n; v++) {
+        for (size_t k = offsets[v]; k < offsets[v + 1]; k++) {
+            size_t a = node[v];
+            size_t b = node[targets[k]];
+            if (a != b) {
+                node_targets[frames[a]++] = b;
+                in_targets[next_edge[b]++] = a;
+            }
+        }
+    }
+
+    /* Depth-first postorder, from the initial state first */
+    const size_t unvisited = (size_t)-1;
+    for (size_t v = 0; v < n; v++) {
+        post[v] = unvisited;
+        node_layer[v] = 0;
+    }
+    const mapping_t *initial = find_mapping(mapper, automaton->initial_state);
+    size_t num_post = 0;
+    for (size_t r = 0; r <= n; r++) {
+        size_t root = r == 0 ? (initial ? node[initial->index] : 0) : r - 1;
+        if (root >= n || node[root] != root || post[root] != unvisited) {
+            continue;
+        }
+        size_t num_frames = 0;
+        frames[num_frames++] = root;
+        next_edge[root] = node_offsets[root];
+        post[root] = unvisited - 1; /* on the path */
+        while (num_frames > 0) {
+            size_t v = frames[num_frames - 1];
+            if (next_edge[v] < node_offsets[v + 1]) {
+                size_t w = node_targets[next_edge[v]++];
+                if (post[w] == unvisited) {
+                    post[w] = unvisited - 1;
+                    next_edge[w] = node_offsets[w];
+                    frames[num_frames++] = w;
+                }
+                continue;
+            }
+            num_frames--;
+            by_post[num_post] = v;
+            post[v] = num_post++;
+        }
+    }
+
+    /*
+     * Longest path layering in reverse postorder, which is topological once
+     * the back edges, those to a node finished later, are left out.
+     */
+    size_t num_layers = 0;
+    for (size_t i = num_post; i-- > 0;) {
+        size_t a = by_post[i];
+        for (size_t k = node_offsets[a]; k < node_offsets[a + 1]; k++) {
+            size_t b = node_targets[k];
+            if (post[b] < post[a] && node_layer[b] < node_layer[a] + 1) {
+                node_layer[b] = node_layer[a] + 1;
+            }
+        }
+        num_layers = node_layer[a] + 1 > num_layers ? node_layer[a] + 1 : num_layers;
+    }
+
+    /* Group the nodes by layer, each in reverse postorder to start with */
+    memset(layer_start, 0, (n + 1) * sizeof(size_t));
+    for (size_t i = 0; i < num_post; i++) {
+        layer_start[node_layer[by_post[i]] + 1]++;
+    }
+    for (size_t l = 0; l < num_layers; l++) {
+        layer_start[l + 1] += layer_start[l];
+    }
+    memcpy(frames, layer_start, num_layers * sizeof(size_t));
+    for (size_t i = num_post; i-- > 0;) {
+        size_t v = by_post[i];
+        position[v] = frames[node_layer[v]] - layer_start[node_layer[v]];
+        layers[frames[node_layer[v]]++] = v;
+    }
+
+    /* Crossing reduction */
+    for (int sweep = 0; sweep < CROSSING_SWEEPS; sweep++) {
+        for (size_t l = 1; l < num_layers; l++) {
+            sweep_layer(layers + layer_start[l], layer_start[l + 1] - layer_start[l], in_offsets,
+                        in_targets, node_layer, position, true, slots);
+        }
+        for (size_t l = num_layers > 1 ? num_layers - 1 : 0; l-- > 0;) {
+            sweep_layer(layers + layer_start[l], layer_start[l + 1] - layer_start[l],
+                        node_offsets, node_targets, node_layer, position, false, slots);
+        }
+    }
+
+    /* Coordinates, with the columns kept for states mapped later */
+    size_t *rows = rift_realloc(mapper->column_rows, (num_layers + 1) * sizeof(size_t));
+    if (rows) {
+        mapper->column_rows = rows;
+        mapper->num_columns = num_layers;
+        for (size_t l = 0; l < num_layers; l++) {
+            rows[l] = layer_start[l + 1] - layer_start[l];
+        }
+    }
+    for (size_t i = 0; i < n; i++) {
+        mapping_t *entry = find_mapping(mapper, states[i]);
+        if (!entry) {
+            continue;
+        }
+        size_t v = node[i];
+        entry->x = LAYOUT_MARGIN + (int)node_layer[v] * COLUMN_SPACING;
+        entry->y = LAYOUT_MARGIN + (int)position[v] * ROW_SPACING;
+    }
+
+    /* One cluster per collapsed component, numbered in state order */
+    for (size_t v = 0; v < n; v++) {
+        frames[v] = 0;
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (node[i] != i) {
+            frames[node[i]]++;
+        }
+    }
+    for (size_t i = 0; i < n; i++) {
+        if (node[i] == i && frames[i] > 0) {
+            mapping_t *entry = find_mapping(mapper, states[i]);
+            if (entry && add_cluster(mapper, frames[i] + 1, entry->x, entry->y)) {
+                next_edge[i] = mapper->num_clusters;
+            } else {
+                next_edge[i] = 0;
+            }
+        }
+    }
+    for (size_t i = 0; i < n; i++) {
+        mapping_t *entry = find_mapping(mapper, states[i]);
+        if (entry && node[i] != i) {
+            entry->cluster = next_edge[node[i]];
+        } else if (entry && frames[i] > 0) {
+            entry->cluster = next_edge[i];
+        }
+    }
+
+    rift_free(slots);
+    rift_free(block);
+    return true;
+}
+
+/**
+ * @brief Assign layout positions to the states of the mapped automaton
+ */
+static void
+layout_states(rift_svg_automaton_mapper_t *mapper)
+{
+    clear_clusters(mapper, true);
+    mapper->layout_stale = false;
+    if (!mapper->automaton || mapper->automaton->num_states == 0) {
+        mapper->num_columns = 0;
+        return;
+    }
+    if (mapper->layout == RIFT_SVG_LAYOUT_LAYERED && layout_layered(mapper)) {
+        return;
+    }
+    layout_breadth_first(mapper);
+}
+
+/**
+ * @brief Creates a new SVG automaton mapper
+ *
+ * @return rift_svg_automaton_mapper_t* A new mapper instance or NULL on failure
+ */
+rift_svg_automaton_mapper_t *
+rift_svg_automaton_mapper_create(void)
+{
+    rift_svg_automaton_mapper_t *mapper = rift_malloc(sizeof(rift_svg_automaton_mapper_t));
+    if (!mapper) {
+        return NULL;
+    }
+    memset(mapper, 0, sizeof(*mapper));
+
+    mapper->root = rift_svg_element_create("svg");
+    if (!mapper->root) {
+        rift_free(mapper);
+        return NULL;
+    }
+    rift_svg_element_set_attribute(mapper->root, "xmlns", "http://www.w3.org/2000/svg");
+
+    rift_svg_element_t *defs = append_new(mapper->root, "defs");
+    rift_svg_element_t *marker = defs ? append_new(defs, "marker") : NULL;
+    rift_svg_element_t *arrow = marker ? append_new(marker, "path") : NULL;
+    mapper->transitions = append_new(mapper->root, "g");
+    mapper->states = append_new(mapper->root, "g");
+    if (!arrow || !mapper->transitions || !mapper->states) {
+        rift_svg_element_destroy(mapper->root);
+        rift_free(mapper);
+        return NULL;
+    }
+
+    rift_svg_element_set_id(marker, "arrow");
+    rift_svg_element_set_attribute(marker, "viewBox", "0 0 10 10");
+    rift_svg_element_set_attribute(marker, "refX", "10");
+    rift_svg_element_set_attribute(marker, "refY", "5");
+    rift_svg_element_set_attribute(marker, "markerWidth", "8");
+    rift_svg_element_set_attribute(marker, "markerHeight", "8");
+    rift_svg_element_set_attribute(marker, "orient", "auto");
+    rift_svg_element_set_attribute(arrow, "d", "M0,0 L10,5 L0,10 z");
+    rift_svg_element_set_attribute(mapper->transitions, "class", "transitions");
+    rift_svg_element_set_attribute(mapper->states, "class", "states");
+    return mapper;
+}
+
+/**
+ * @brief Destroys an SVG automaton mapper and frees associated resources
+ *
+ * @param mapper The mapper to destroy
+ */
+void
+rift_svg_automaton_mapper_destroy(rift_svg_automaton_mapper_t *mapper)
+{
+    if (!mapper) {
+        return;
+    }
+
+    for (size_t i = 0; i < mapper->num_removed; i++) {
+        rift_free(mapper->removed_ids[i]);
+    }
+    rift_free(mapper->removed_ids);
+    rift_free(mapper->column_rows);
+    rift_free(mapper->slots);
+    rift_free(mapper->clusters);
+    /* The mapped groups and clusters are destroyed with the root */
+    rift_svg_element_destroy(mapper->root);
+    rift_free(mapper);
+}
+
+/**
+ * @brief Maps an automaton to SVG elements
+ *
+ * @param mapper The mapper to use
+ * @param automaton The automaton to map
+ * @return rift_svg_element_t* The root SVG element containing the mapped automaton
+ */
+rift_svg_element_t *
+rift_svg_automaton_mapper_map_automaton_to_svg(rift_svg_automaton_mapper_t *mapper,
+                                               void *automaton)
+{
+    if (!mapper || !automaton) {
+        return NULL;
+    }
+
+    rift_svg_automaton_mapper_clear_mappings(mapper);
+    mapper->automaton = automaton;
+    if (!rift_svg_automaton_mapper_update_elements_from_automaton(mapper, automaton)) {
+        return NULL;
+    }
+    return mapper->root;
+}
+
+/**
+ * @brief Updates existing SVG elements from an automaton
+ *
+ * @param mapper The mapper to use
+ * @param automaton The updated automaton
+ * @return bool True if successful, false otherwise
+ */
+bool
+rift_svg_automaton_mapper_update_elements_from_automaton(rift_svg_automaton_mapper_t *mapper,
+                                                         void *automaton)
+{
+    if (!mapper || !automaton) {
+        return false;
+    }
+    if (mapper->automaton != automaton) {
+        return rift_svg_automaton_mapper_map_automaton_to_svg(mapper, automaton) != NULL;
+    }
+
+    rift_regex_automaton_t *nfa = automaton;
+    bool first = mapper->count == 0;
+    bool ok = true;
+
+    /* Map the states first, so a fresh mapping gets the layered layout */
+    for (size_t i = 0; first && ok && i < nfa->num_states; i++) {
+        ok = rift_svg_automaton_mapper_update_state(mapper, nfa->states[i]);
+    }
+    if (ok && first) {
+        layout_states(mapper);
+        for (size_t i = 0; i < nfa->num_states; i++) {
+            refresh_state_element(mapper, find_mapping(mapper, nfa->states[i]));
+        }
+    }
+
+    size_t generation = ++mapper->generation;
+    for (size_t i = 0; ok && i < nfa->num_states; i++) {
+        rift_regex_state_t *state = nfa->states[i];
+        ok = rift_svg_automaton_mapper_update_state(mapper, state);
+        find_mapping(mapper, state)->generation = generation;
+        for (size_t j = 0; ok && j < state->num_transitions; j++) {
+            ok = rift_svg_automaton_mapper_update_transition(mapper, state->transitions[j]);
+            if (ok) {
+                find_mapping(mapper, state->transitions[j])->generation = generation;
+            }
+        }
+    }
+    if (!ok) {
+        return false;
+    }
+
+    /* Sweep what the automaton no longer has, transitions before their states */
+    for (int pass = 0; pass < 2; pass++) {
+        for (size_t i = 0; i < mapper->capacity; i++) {
+            mapping_t *entry = &mapper->slots[i];
+            if (entry->key && entry->key != TOMBSTONE && entry->generation != generation &&
+                entry->is_state == (pass == 1)) {
+                if (entry->is_state) {
+                    rift_svg_automaton_mapper_remove_state(mapper, (void *)entry->key);
+                } else {
+                    remove_mapping(mapper, entry);
+                }
+            }
+        }
+    }
+
+    /* The layout of a fresh mapping already saw every transition */
+    if (first) {
+        mapper->layout_stale = false;
+    }
+    return true;
+}
+
+/**
+ * @brief Gets the SVG element for a specific automaton state
+ *
+ * @param mapper The mapper to query
+ * @param state The automaton state
+ * @return rift_svg_element_t* The corresponding SVG element or NULL if not found
+ */
+rift_svg_element_t *
+rift_svg_automaton_mapper_get_state_element(rift_svg_automaton_mapper_t *mapper, void *state)
+{
+    const mapping_t *entry = mapper ? find_mapping(mapper, state) : NULL;
+    return entry && entry->is_state ? entry->element : NULL;
+}
+
+/**
+ * @brief Gets the SVG element for a specific automaton transition
+ *
+ * @param mapper The mapper to query
+ * @param transition The automaton transition
+ * @return rift_svg_element_t* The corresponding SVG element or NULL if not found
+ */
+rift_svg_element_t *
+rift_svg_automaton_mapper_get_transition_element(rift_svg_automaton_mapper_t *mapper,
+                                                 void *transition)
+{
+    const mapping_t *entry = mapper ? find_mapping(mapper, transition) : NULL;
+    return entry && !entry->is_state ? entry->element : NULL;
+}
+
+/**
+ * @brief Clears all mappings from the mapper
+ *
+ * The elements are destroyed without being recorded as removed.
+ *
+ * @param mapper The mapper to clear
+ * @return bool True if successful, false otherwise
+ */
+bool
+rift_svg_automaton_mapper_clear_mappings(rift_svg_automaton_mapper_t *mapper)
+{
+    if (!mapper) {
+        return false;
+    }
+
+    clear_clusters(mapper, false);
+    for (size_t i = 0; i < mapper->capacity; i++) {
+        mapping_t *entry = &mapper->slots[i];
+        if (entry->key && entry->key != TOMBSTONE) {
+            rift_svg_element_destroy(entry->element);
+        }
+    }
+    if (mapper->capacity > 0) {
+        memset(mapper->slots, 0, mapper->capacity * sizeof(mapping_t));
+    }
+    for (size_t i = 0; i < mapper->num_removed; i++) {
+        rift_free(mapper->removed_ids[i]);
+    }
+
+    mapper->count = 0;
+    mapper->used = 0;
+    mapper->num_removed = 0;
+    mapper->num_columns = 0;
+    mapper->next_transition_id = 0;
+    mapper->automaton = NULL;
+    return true;
+}
+
+/**
+ * @brief Find the entry whose group is an element or one of its ancestors
+ */
+static const mapping_t *
+find_element(const rift_svg_automaton_mapper_t *mapper, const rift_svg_element_t *element)
+{
+    for (; element; element = rift_svg_element_get_parent(element)) {
+        for (size_t i = 0; i < mapper->capacity; i++) {
+            const mapping_t *entry = &mapper->slots[i];
+            if (entry->key && entry->key != TOMBSTONE && entry->element == element) {
+                return entry;
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Gets the state from an SVG element
+ *
+ * The element may be the group of the state or one of its children.
+ *
+ * @param mapper The mapper to query
+ * @param element The SVG element
+ * @return void* The corresponding automaton state or NULL if not found
+ */
+void *
+rift_svg_automaton_mapper_get_state_from_element(rift_svg_automaton_mapper_t *mapper,
+                                                 rift_svg_element_t *element)
+{
+    const mapping_t *entry = mapper ? find_element(mapper, element) : NULL;
+    return entry && entry->is_state ? (void *)entry->key : NULL;
+}
+
+/**
+ * @brief Gets the transition from an SVG element
+ *
+ * The element may be the group of the transition or one of its children.
+ *
+ * @param mapper The mapper to query
+ * @param element The SVG element
+ * @return void* The corresponding automaton transition or NULL if not found
+ */
+void *
+rift_svg_automaton_mapper_get_transition_from_element(rift_svg_automaton_mapper_t *mapper,
+                                                      rift_svg_element_t *element)
+{
+    const mapping_t *entry = mapper ? find_element(mapper, element) : NULL;
+    return entry && !entry->is_state ? (void *)entry->key : NULL;
+}
+
+/**
+ * @brief Applies a custom layout algorithm to the automaton visualization
+ *
+ * The algorithm also lays out automata mapped later. Positions are kept
+ * when no state or transition was added or removed since the same layout
+ * was last applied; otherwise the states that move are formatted again on
+ * the next serialization.
+ *
+ * @param mapper The mapper to use
+ * @param layout_algorithm The layout algorithm identifier (0 = default)
+ * @return bool True if successful, false otherwise
+ */
+bool
+rift_svg_automaton_mapper_apply_layout(rift_svg_automaton_mapper_t *mapper, int layout_algorithm)
+{
+    if (!mapper || (layout_algorithm != RIFT_SVG_LAYOUT_DEFAULT &&
+                    layout_algorithm != RIFT_SVG_LAYOUT_LAYERED)) {
+        return false;
+    }
+    if (layout_algorithm == mapper->layout && !mapper->layout_stale) {
+        return true;
+    }
+
+    mapper->layout = layout_algorithm;
+    layout_states(mapper);
+    for (int pass = 0; pass < 2; pass++) {
+        for (size_t i = 0; i < mapper->capacity; i++) {
+            const mapping_t *entry = &mapper->slots[i];
+            if (!entry->key || entry->key == TOMBSTONE || entry->is_state != (pass == 0)) {
+                continue;
+            }
+            if (entry->is_state) {
+                refresh_state_element(mapper, entry);
+            } else {
+                refresh_transition_element(mapper, entry);
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Gets the root SVG element of the mapper
+ *
+ * @param mapper The mapper to query
+ * @return rift_svg_element_t* The root SVG element or NULL on error
+ */
+rift_svg_element_t *
+rift_svg_automaton_mapper_get_root_element(rift_svg_automaton_mapper_t *mapper)
+{
+    return mapper ? mapper->root : NULL;
+}
+
+/**
+ * @brief Sets the size from which strongly connected components are collapsed
+ *
+ * @param mapper The mapper to modify
+ * @param min_states Smallest component collapsed, or 0 to collapse none
+ * @return bool True if successful, false otherwise
+ */
+bool
+rift_svg_automaton_mapper_set_collapse_threshold(rift_svg_automaton_mapper_t *mapper,
+                                                 size_t min_states)
+{
+    if (!mapper) {
+        return false;
+    }
+
+    if (min_states != mapper->collapse_threshold) {
+        mapper->collapse_threshold = min_states;
+        mapper->layout_stale = true;
+    }
+    return true;
+}
+
+/**
+ * @brief Gets the automaton the mapper last mapped
+ *
+ * @param mapper The mapper to query
+ * @return void* The automaton or NULL if none is mapped
+ */
+void *
+rift_svg_automaton_mapper_get_automaton(rift_svg_automaton_mapper_t *mapper)
+{
+    return mapper ? mapper->automaton : NULL;
+}
+
+/**
+ * @brief Maps a state, or refreshes the element of an already mapped state
+ *
+ * A new state goes below the states of the last layout column, so placing
+ * it moves no other state.
+ *
+ * @param mapper The mapper to use
+ * @param state The automaton state
+ * @return bool True if successful, false otherwise
+ */
+bool
+rift_svg_automaton_mapper_update_state(rift_svg_automaton_mapper_t *mapper, void *state)
+{
+    if (!mapper || !state) {
+        return false;
+    }
+
+    mapping_t *entry = find_mapping(mapper, state);
+    if (entry) {
+        refresh_state_element(mapper, entry);
+        return true;
+    }
+
+    entry = insert_mapping(mapper, state);
+    if (!entry) {
+        return false;
+    }
+    entry->is_state = true;
+    entry->generation = mapper->generation;
+    place_in_column(mapper, entry, mapper->num_columns > 0 ? mapper->num_columns - 1 : 0);
+    if (!build_state_element(mapper, entry)) {
+        entry->key = TOMBSTONE;
+        mapper->count--;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Maps a transition, or refreshes the element of an already mapped one
+ *
+ * @param mapper The mapper to use
+ * @param transition The automaton transition
+ * @return bool True if successful, false otherwise
+ */
+bool
+rift_svg_automaton_mapper_update_transition(rift_svg_automaton_mapper_t *mapper,
+                                            void *transition)
+{
+    rift_regex_transition_t *t = transition;
+    if (!mapper || !t || !t->from_state || !t->to_state) {
+        return false;
+    }
+
+    if ((!find_mapping(mapper, t->from_state) &&
+         !rift_svg_automaton_mapper_update_state(mapper, t->from_state)) ||
+        (!find_mapping(mapper, t->to_state) &&
+         !rift_svg_automaton_mapper_update_state(mapper, t->to_state))) {
+        return false;
+    }
+
+    mapping_t *entry = find_mapping(mapper, t);
+    if (entry) {
+        /* A transition can be redirected, which moves its path */
+        entry->from = t->from_state;
+        entry->to = t->to_state;
+        refresh_transition_element(mapper, entry);
+        return true;
+    }
+
+    entry = insert_mapping(mapper, t);
+    if (!entry) {
+        return false;
+    }
+    entry->is_state = false;
+    entry->generation = mapper->generation;
+    entry->from = t->from_state;
+    entry->to = t->to_state;
+    if (!build_transition_element(mapper, entry)) {
+        entry->key = TOMBSTONE;
+        mapper->count--;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Removes the element of a state and of the transitions touching it
+ *
+ * @param mapper The mapper to use
+ * @param state The automaton state
+ * @return bool True if the state was mapped, false otherwise
+ */
+bool
+rift_svg_automaton_mapper_remove_state(rift_svg_automaton_mapper_t *mapper, void *state)
+{
+    mapping_t *entry = mapper ? find_mapping(mapper, state) : NULL;
+    if (!entry || !entry->is_state) {
+        return false;
+    }
+
+    for (size_t i = 0; i < mapper->capacity; i++) {
+        mapping_t *other = &mapper->slots[i];
+        if (other->key && other->key != TOMBSTONE && !other->is_state &&
+            (other->from == state || other->to == state)) {
+            remove_mapping(mapper, other);
+        }
+    }
+    remove_mapping(mapper, entry);
+    return true;
+}
+
+/**
+ * @brief Removes the element of a transition
+ *
+ * @param mapper The mapper to use
+ * @param transition The automaton transition
+ * @return bool True if the transition was mapped, false otherwise
+ */
+bool
+rift_svg_automaton_mapper_remove_transition(rift_svg_automaton_mapper_t *mapper,
+                                            void *transition)
+{
+    mapping_t *entry = mapper ? find_mapping(mapper, transition) : NULL;
+    if (!entry || entry->is_state) {
+        return false;
+    }
+
+    remove_mapping(mapper, entry);
+    return true;
+}
+
+/**
+ * @brief Marks a state with what a match trace did there
+ *
+ * @param mapper The mapper to use
+ * @param state The automaton state
+ * @param visits Trace records to add to the state's
+ * @param backtracks Backtracks to add to the state's
+ * @param active Whether the trace is at the state now
+ * @return bool True if the state is mapped, false otherwise
+ */
+bool
+rift_svg_automaton_mapper_mark_state(rift_svg_automaton_mapper_t *mapper, void *state,
+                                     uint32_t visits, uint32_t backtracks, bool active)
+{
+    mapping_t *entry = mapper && state ? find_mapping(mapper, state) : NULL;
+    if (!entry || !entry->is_state) {
+        return false;
+    }
+
+    entry->visits = visits > UINT32_MAX - entry->visits ? UINT32_MAX : entry->visits + visits;
+    entry->backtracks = backtracks > UINT32_MAX - entry->backtracks
+                            ? UINT32_MAX
+                            : entry->backtracks + backtracks;
+    entry->active = active;
+    entry->traced = true;
+    return true;
+}
+
+/**
+ * @brief Clears the trace marks of every state
+ *
+ * @param mapper The mapper to use
+ * @return bool True if successful, false otherwise
+ */
+bool
+rift_svg_automaton_mapper_clear_marks(rift_svg_automaton_mapper_t *mapper)
+{
+    if (!mapper) {
+        return false;
+    }
+
+    for (size_t i = 0; i < mapper->capacity; i++) {
+        mapping_t *entry = &mapper->slots[i];
+        if (entry->key && entry->key != TOMBSTONE && entry->traced) {
+            entry->visits = 0;
+            entry->backtracks = 0;
+            entry->active = false;
+            refresh_state_element(mapper, entry);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Gets the number of states and transitions mapped
+ *
+ * @param mapper The mapper to query
+ * @return size_t The number of mapped elements
+ */
+size_t
+rift_svg_automaton_mapper_get_element_count(rift_svg_automaton_mapper_t *mapper)
+{
+    return mapper ? mapper->count : 0;
+}
+
+/**
+ * @brief Takes the IDs of the elements removed since the last call
+ *
+ * @param mapper The mapper to use
+ * @param count Receives the number of IDs
+ * @return char** The IDs (caller must free each and the array) or NULL if none
+ */
+char **
+rift_svg_automaton_mapper_take_removed_ids(rift_svg_automaton_mapper_t *mapper, size_t *count)
+{
+    if (count) {
+        *count = 0;
+    }
+    if (!mapper || !count || mapper->num_removed == 0) {
+        return NULL;
+    }
+
+    char **ids = mapper->removed_ids;
+    *count = mapper->num_removed;
+    mapper->removed_ids = NULL;
+    mapper->num_removed = 0;
+    mapper->removed_capacity = 0;
+    return ids;
+}
@@ -0,0 +1,561 @@
+/**
+ * @file svg_element.c
+ * @brief Implementation of SVG elements for the LibRift visualizer
+ *
+ * Elements form a tree with a parent link. Every element keeps the markup
+ * it was last serialized to, with the invariant that an element without
+ * kept markup has ancestors without it too. A change therefore drops the
+ * markup up the parent chain only until it meets an element that already
+ * lost it.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "cli/visualizer/svg_element.h"
+#include <stdlib.h>
+#include <string.h>
+#include "core/memory/memory.h"
+
+/**
+ * @brief SVG element structure
+ */
+struct rift_svg_element {
+    char *name;                        /**< Element name */
+    rift_svg_attribute_t *attributes;  /**< Attributes, in the order they were set */
+    size_t num_attributes;             /**< Number of attributes */
+    size_t attribute_capacity;         /**< Capacity of the attributes array */
+    char *text;                        /**< Text content or NULL */
+    rift_svg_element_t **children;     /**< Child elements */
+    size_t num_children;               /**< Number of children */
+    size_t child_capacity;             /**< Capacity of the children array */
+    rift_svg_element_t *parent;        /**< Parent element or NULL */
+    char *markup;                      /**< Markup of the last serialization, NULL when dirty */
+    size_t markup_length;              /**< Length of the markup */
+};
+
+/**
+ * @brief Growable output buffer of a serialization
+ */
+typedef struct svg_buffer {
+    char *data;      /**< Characters written, NUL terminated */
+    size_t length;   /**< Characters written */
+    size_t capacity; /**< Capacity of data */
+    bool failed;     /**< Whether an allocation failed */
+} svg_buffer_t;
+
+/**
+ * @brief Make room for more characters in a buffer
+ */
+static bool
+buffer_reserve(svg_buffer_t *buffer, size_t extra)
+{
+    if (buffer->failed) {
+        return false;
+    }
+    if (buffer->length + extra + 1 <= buffer->capacity) {
+        return true;
+    }
+
+    size_t capacity = buffer->capacity ? buffer->capacity * 2 : 256;
+    while (capacity < buffer->length + extra + 1) {
+        capacity *= 2;
+    }
+    char *data = rift_realloc(buffer->data, capacity);
+    if (!data) {
+        buffer->failed = true;
+        return false;
+    }
+    buffer->data = data;
+    buffer->capacity = capacity;
+    return true;
+}
+
+/**
+ * @brief Append characters to a buffer
+ */
+static void
+buffer_append(svg_buffer_t *buffer, const char *text, size_t length)
+{
+    if (buffer_reserve(buffer, length)) {
+        memcpy(buffer->data + buffer->length, text, length);
+        buffer->length += length;
+        buffer->data[buffer->length] = '\0';
+    }
+}
+
+/**
+ * @brief Append text to a buffer with the XML special characters escaped
+ */
+static void
+buffer_append_escaped(svg_buffer_t *buffer, const char *text)
+{
+    for (const char *c = text; *c; c++) {
+        switch (*c) {
+        case '&':
+            buffer_append(buffer, "&amp;", 5);
+            break;
+        case '<':
+            buffer_append(buffer, "&lt;", 4);
+            break;
+        case '>':
+            buffer_append(buffer, "&gt;", 4);
+            break;
+        case '"':
+            buffer_append(buffer, "&quot;", 6);
+            break;
+        default:
+            buffer_append(buffer, c, 1);
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Drop the kept markup of an element and of its ancestors
+ */
+static void
+invalidate(rift_svg_element_t *element)
+{
+    /* An element without markup has ancestors without it, so the walk stops there */
+    while (element && element->markup) {
+        rift_free(element->markup);
+        element->markup = NULL;
+        element->markup_length = 0;
+        element = element->parent;
+    }
+}
+
+/**
+ * @brief Creates a new SVG element
+ *
+ * @param name The element name (e.g., "rect", "circle", "svg")
+ * @return rift_svg_element_t* A new SVG element or NULL on failure
+ */
+rift_svg_element_t *
+rift_svg_element_create(const char *name)
+{
+    if (!name || !*name) {
+        return NULL;
+    }
+
+    rift_svg_element_t *element = rift_malloc(sizeof(rift_svg_element_t));
+    if (!element) {
+        return NULL;
+    }
+
+    memset(element, 0, sizeof(*element));
+    element->name = rift_strdup(name);
+    if (!element->name) {
+        rift_free(element);
+        return NULL;
+    }
+    return element;
+}
+
+/**
+ * @brief Destroys an SVG element and all its children
+ *
+ * The element is detached from its parent first.
+ *
+ * @param element The element to destroy
+ */
+void
+rift_svg_element_destroy(rift_svg_element_t *element)
+{
+    if (!element) {
+        return;
+    }
+
+    if (element->parent) {
+        rift_svg_element_remove_child(element->parent, element);
+    }
+
+    for (size_t i = 0; i < element->num_children; i++) {
+        /* Children are freed without detaching each from this dying parent */
+        element->children[i]->parent = NULL;
+        rift_svg_element_destroy(element->children[i]);
+    }
+    for (size_t i = 0; i < element->num_attributes; i++) {
+        rift_free(element->attributes[i].name);
+        rift_free(element->attributes[i].value);
+    }
+
+    rift_free(element->children);
+    rift_free(element->attributes);
+    rift_free(element->text);
+    rift_free(element->markup);
+    rift_free(element->name);
+    rift_free(element);
+}
+
+/**
+ * @brief Sets an attribute on an SVG element
+ *
+ * @param element The element to modify
+ * @param name The attribute name
+ * @param value The attribute value
+ * @return bool True if successful, false otherwise
+ */
+bool
+rift_svg_element_set_attribute(rift_svg_element_t *element, const char *name, const char *value)
+{
+    if (!element || !name || !value) {
+        return false;
+    }
+
+    for (size_t i = 0; i < element->num_attributes; i++) {
+        rift_svg_attribute_t *attribute = &element->attributes[i];
+        if (strcmp(attribute->name, name) != 0) {
+            continue;
+        }
+        if (strcmp(attribute->value, value) == 0) {
+            /* Unchanged, so the kept markup still holds */
+            return true;
+        }
+        char *copy = rift_strdup(value);
+        if (!copy) {
+            return false;
+        }
+        rift_free(attribute->value);
+        attribute->value = copy;
+        invalidate(element);
+        return true;
+    }
+
+    if (element->num_attributes == element->attribute_capacity) {
+        size_t capacity = element->attribute_capacity ? element->attribute_capacity * 2 : 4;
+        rift_svg_attribute_t *attributes =
+            rift_realloc(element->attributes, capacity * sizeof(rift_svg_attribute_t));
+        if (!attributes) {
+            return false;
+        }
+        element->attributes = attributes;
+        element->attribute_capacity = capacity;
+    }
+
+    rift_svg_attribute_t *attribute = &element->attributes[element->num_attributes];
+    attribute->name = rift_strdup(name);
+    attribute->value = rift_strdup(value);
+    if (!attribute->name || !attribute->value) {
+        rift_free(attribute->name);
+        rift_free(attribute->value);
+        return false;
+    }
+    element->num_attributes++;
+    invalidate(element);
+    return true;
+}
+
+/**
+ * @brief Gets an attribute value from an SVG element
+ *
+ * @param element The element to query
+ * @param name The attribute name
+ * @return const char* The attribute value or NULL if not found
+ */
+const char *
+rift_svg_element_get_attribute(const rift_svg_element_t *element, const char *name)
+{
+    if (!element || !name) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < element->num_attributes; i++) {
+        if (strcmp(element->attributes[i].name, name) == 0) {
+            return element->attributes[i].value;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Adds a child element to an SVG element
+ *
+ * @param parent The parent element
+ * @param child The child element to add, which must not have a parent
+ * @return bool True if successful, false otherwise
+ */
+bool
+rift_svg_element_append_child(rift_svg_element_t *parent, rift_svg_element_t *child)
+{
+    if (!parent || !child || child->parent || child == parent) {
+        return false;
+    }
+
+    if (parent->num_children == parent->child_capacity) {
+        size_t capacity = parent->child_capacity ? parent->child_capacity * 2 : 4;
+        rift_svg_element_t **children =
+            rift_realloc(parent->children, capacity * sizeof(rift_svg_element_t *));
+        if (!children) {
+            return false;
+        }
+        parent->children = children;
+        parent->child_capacity = capacity;
+    }
+
+    parent->children[parent->num_children++] = child;
+    child->parent = parent;
+    invalidate(parent);
+    return true;
+}
+
+/**
+ * @brief Gets the ID of an SVG element
+ *
+ * @param element The element to query
+ * @return const char* The element ID or NULL if not set
+ */
+const char *
+rift_svg_element_get_id(const rift_svg_element_t *element)
+{
+    return rift_svg_element_get_attribute(element, "id");
+}
+
+/**
+ * @brief Sets the ID of an SVG element
+ *
+ * @param element The element to modify
+ * @param id The ID to set
+ * @return bool True if successful, false otherwise
+ */
+bool
+rift_svg_element_set_id(rift_svg_element_t *element, const char *id)
+{
+    return rift_svg_element_set_attribute(element, "id", id);
+}
+
+/**
+ * @brief Gets a child element by index
+ *
+ * @param element The parent element
+ * @param index The child index
+ * @return rift_svg_element_t* The child element or NULL if not found
+ */
+rift_svg_element_t *
+rift_svg_element_get_child(const rift_svg_element_t *element, size_t index)
+{
+    if (!element || index >= element->num_children) {
+        return NULL;
+    }
+    return element->children[index];
+}
+
+/**
+ * @brief Gets the number of children of an SVG element
+ *
+ * @param element The element to query
+ * @return size_t The number of children
+ */
+size_t
+rift_svg_element_get_child_count(const rift_svg_element_t *element)
+{
+    return element ? element->num_children : 0;
+}
+
+/**
+ * @brief Sets the text content of an SVG element
+ *
+ * @param element The element to modify
+ * @param text The text, or NULL for none
+ * @return bool True if successful, false otherwise
+ */
+bool
+rift_svg_element_set_text(rift_svg_element_t *element, const char *text)
+{
+    if (!element) {
+        return false;
+    }
+
+    if ((!text && !element->text) || (text && element->text && strcmp(text, element->text) == 0)) {
+        return true;
+    }
+
+    char *copy = NULL;
+    if (text) {
+        copy = rift_strdup(text);
+        if (!copy) {
+            return false;
+        }
+    }
+    rift_free(element->text);
+    element->text = copy;
+    invalidate(element);
+    return true;
+}
+
+/**
+ * @brief Gets the parent of an SVG element
+ *
+ * @param element The element to query
+ * @return rift_svg_element_t* The parent or NULL for a root element
+ */
+rift_svg_element_t *
+rift_svg_element_get_parent(const rift_svg_element_t *element)
+{
+    return element ? element->parent : NULL;
+}
+
+/**
+ * @brief Checks whether an SVG element changed since it was last serialized
+ *
+ * @param element The element to query
+ * @return bool True if the element must be formatted again, false otherwise
+ */
+bool
+rift_svg_element_is_dirty(const rift_svg_element_t *element)
+{
+    return element && !element->markup;
+}
+
+/**
+ * @brief Write an element to a buffer, reusing and refreshing kept markup
+ */
+static void
+serialize(rift_svg_element_t *element, svg_buffer_t *buffer)
+{
+    if (element->markup) {
+        buffer_append(buffer, element->markup, element->markup_length);
+        return;
+    }
+
+    size_t start = buffer->length;
+    buffer_append(buffer, "<", 1);
+    buffer_append(buffer, element->name, strlen(element->name));
+    for (size_t i = 0; i < element->num_attributes; i++) {
+        buffer_append(buffer, " ", 1);
+        buffer_append(buffer, element->attributes[i].name, strlen(element->attributes[i].name));
+        buffer_append(buffer, "=\"", 2);
+        buffer_append_escaped(buffer, element->attributes[i].value);
+        buffer_append(buffer, "\"", 1);
+    }
+
+    if (!element->text && element->num_children == 0) {
+        buffer_append(buffer, "/>", 2);
+    } else {
+        buffer_append(buffer, ">", 1);
+        if (element->text) {
+            buffer_append_escaped(buffer, element->text);
+        }
+        for (size_t i = 0; i < element->num_children; i++) {
+            serialize(element->children[i], buffer);
+        }
+        buffer_append(buffer, "</", 2);
+        buffer_append(buffer, element->name, strlen(element->name));
+        buffer_append(buffer, ">", 1);
+    }
+
+    if (buffer->failed) {
+        return;
+    }
+
+    /* Keep the markup, so the next serialization copies it if nothing changes */
+    size_t length = buffer->length - start;
+    element->markup = rift_malloc(length + 1);
+    if (element->markup) {
+        memcpy(element->markup, buffer->data + start, length);
+        element->markup[length] = '\0';
+        element->markup_length = length;
+    }
+}
+
+/**
+ * @brief Converts an SVG element to a string representation
+ *
+ * @param element The element to convert
+ * @return char* The SVG string (caller must free) or NULL on failure
+ */
+char *
+rift_svg_element_to_string(const rift_svg_element_t *element)
+{
+    if (!element) {
+        return NULL;
+    }
+
+    /* Only the kept markup changes, which callers cannot observe */
+    svg_buffer_t buffer = {0};
+    serialize((rift_svg_element_t *)element, &buffer);
+    if (buffer.failed || !buffer.data) {
+        rift_free(buffer.data);
+        return NULL;
+    }
+    return buffer.data;
+}
+
+/**
+ * @brief Sets an accessible label for an SVG element
+ *
+ * @param element The element to modify
+ * @param label The accessible label
+ * @return bool True if successful, false otherwise
+ */
+bool
+rift_svg_element_set_accessible_label(rift_svg_element_t *element, const char *label)
+{
+    return rift_svg_element_set_attribute(element, "aria-label", label);
+}
+
+/**
+ * @brief Removes a child element from a parent
+ *
+ * @param parent The parent element
+ * @param child The child element to remove
+ * @return bool True if successful, false otherwise
+ */
+bool
+rift_svg_element_remove_child(rift_svg_element_t *parent, rift_svg_element_t *child)
+{
+    if (!parent || !child || child->parent != parent) {
+        return false;
+    }
+
+    for (size_t i = 0; i < parent->num_children; i++) {
+        if (parent->children[i] == child) {
+            memmove(&parent->children[i], &parent->children[i + 1],
+                    (parent->num_children - i - 1) * sizeof(rift_svg_element_t *));
+            parent->num_children--;
+            child->parent = NULL;
+            invalidate(parent);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Creates a deep clone of an SVG element
+ *
+ * @param element The element to clone
+ * @return rift_svg_element_t* The cloned element or NULL on failure
+ */
+rift_svg_element_t *
+rift_svg_element_clone(const rift_svg_element_t *element)
+{
+    if (!element) {
+        return NULL;
+    }
+
+    rift_svg_element_t *clone = rift_svg_element_create(element->name);
+    if (!clone) {
+        return NULL;
+    }
+
+    bool ok = rift_svg_element_set_text(clone, element->text);
+    for (size_t i = 0; ok && i < element->num_attributes; i++) {
+        ok = rift_svg_element_set_attribute(clone, element->attributes[i].name,
+                                            element->attributes[i].value);
+    }
+    for (size_t i = 0; ok && i < element->num_children; i++) {
+        rift_svg_element_t *child = rift_svg_element_clone(element->children[i]);
+        ok = rift_svg_element_append_child(clone, child);
+        if (!ok) {
+            rift_svg_element_destroy(child);
+        }
+    }
+
+    if (!ok) {
+        rift_svg_element_destroy(clone);
+        return NULL;
+    }
+    return clone;
+}
@@ -0,0 +1,512 @@
+/**
+ * @file svg_renderer.c
+ * @brief Implementation of the SVG renderer for the LibRift visualizer
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "cli/visualizer/svg_renderer.h"
+#include "core/automaton/automaton.h"
+#include "core/automaton/state.h"
+#include "core/memory/memory.h"
+
+/** Index of the transitions layer among the children of the root */
+#define TRANSITIONS_LAYER 1
+/** Index of the states layer among the children of the root */
+#define STATES_LAYER 2
+
+/**
+ * @brief SVG renderer structure
+ *
+ * The observer comes first, so the observer pointer passed to the
+ * callbacks is the renderer.
+ */
+struct rift_svg_renderer {
+    rift_automaton_observer_t observer;        /**< Observer of the rendered automaton */
+    rift_svg_automaton_mapper_t *mapper;       /**< Mapper owning the document */
+    rift_real_time_update_manager_t *updates;  /**< Updates waiting for the next frame */
+    void *automaton;                           /**< Automaton last rendered */
+    rift_regex_state_t **states_by_id;         /**< States of automaton by ID, for traces */
+    size_t num_state_ids;                      /**< Length of states_by_id, 0 until built */
+    rift_regex_state_t *active_state;          /**< State of the last trace record played */
+};
+
+/**
+ * @brief Names of the color schemes, indexed by rift_color_scheme_t
+ */
+static const char *const color_scheme_names[] = {
+    "default",    "high-contrast", "deuteranopia", "protanopia",
+    "tritanopia", "monochrome",    "dark",         "custom",
+};
+
+/**
+ * @brief Map a change notification to a typed update
+ */
+static void
+on_change(rift_automaton_observer_t *observer, void *automaton, rift_automaton_change_type_t type,
+          void *element)
+{
+    rift_svg_renderer_t *renderer = (rift_svg_renderer_t *)observer;
+    if (automaton != renderer->automaton) {
+        return;
+    }
+
+    rift_update_type_t update_type;
+    switch (type) {
+    case RIFT_AUTOMATON_CHANGE_STATE_ADDED:
+        update_type = RIFT_UPDATE_TYPE_STATE_ADDED;
+        break;
+    case RIFT_AUTOMATON_CHANGE_STATE_REMOVED:
+        update_type = RIFT_UPDATE_TYPE_STATE_REMOVED;
+        break;
+    case RIFT_AUTOMATON_CHANGE_STATE_MODIFIED:
+        update_type = RIFT_UPDATE_TYPE_STATE_MODIFIED;
+        break;
+    case RIFT_AUTOMATON_CHANGE_TRANSITION_ADDED:
+        update_type = RIFT_UPDATE_TYPE_TRANSITION_ADDED;
+        break;
+    case RIFT_AUTOMATON_CHANGE_TRANSITION_REMOVED:
+        update_type = RIFT_UPDATE_TYPE_TRANSITION_REMOVED;
+        break;
+    default:
+        update_type = RIFT_UPDATE_TYPE_TRANSITION_MODIFIED;
+        break;
+    }
+
+    rift_real_time_update_manager_schedule_update(
+        renderer->updates, rift_real_time_update_manager_create_update(update_type, element, 0));
+    rift_real_time_update_manager_process_updates(renderer->updates);
+}
+
+/**
+ * @brief Creates a new SVG renderer
+ *
+ * @return rift_svg_renderer_t* A new SVG renderer instance or NULL on failure
+ */
+rift_svg_renderer_t *
+rift_svg_renderer_create(void)
+{
+    rift_svg_renderer_t *renderer = rift_malloc(sizeof(rift_svg_renderer_t));
+    if (!renderer) {
+        return NULL;
+    }
+    memset(renderer, 0, sizeof(*renderer));
+
+    renderer->mapper = rift_svg_automaton_mapper_create();
+    renderer->updates =
+        renderer->mapper ? rift_real_time_update_manager_create(renderer->mapper) : NULL;
+    if (!renderer->updates) {
+        rift_svg_automaton_mapper_destroy(renderer->mapper);
+        rift_free(renderer);
+        return NULL;
+    }
+
+    renderer->observer.update = rift_svg_renderer_update;
+    renderer->observer.changed = on_change;
+    renderer->observer.user_data = renderer;
+    return renderer;
+}
+
+/**
+ * @brief Destroys an SVG renderer and frees all associated resources
+ *
+ * @param renderer The renderer to destroy
+ */
+void
+rift_svg_renderer_destroy(rift_svg_renderer_t *renderer)
+{
+    if (!renderer) {
+        return;
+    }
+
+    rift_real_time_update_manager_destroy(renderer->updates);
+    rift_svg_automaton_mapper_destroy(renderer->mapper);
+    rift_free(renderer->states_by_id);
+    rift_free(renderer);
+}
+
+/**
+ * @brief Initializes the SVG renderer with specific dimensions
+ *
+ * @param renderer The renderer to initialize
+ * @param width The width of the rendering area
+ * @param height The height of the rendering area
+ * @return bool True if initialization was successful, false otherwise
+ */
+bool
+rift_svg_renderer_initialize(rift_svg_renderer_t *renderer, int width, int height)
+{
+    if (!renderer || width <= 0 || height <= 0) {
+        return false;
+    }
+
+    rift_svg_element_t *root = rift_svg_automaton_mapper_get_root_element(renderer->mapper);
+    char buffer[48];
+
+    snprintf(buffer, sizeof(buffer), "%d", width);
+    bool ok = rift_svg_element_set_attribute(root, "width", buffer);
+    snprintf(buffer, sizeof(buffer), "%d", height);
+    ok = ok && rift_svg_element_set_attribute(root, "height", buffer);
+    snprintf(buffer, sizeof(buffer), "0 0 %d %d", width, height);
+    return ok && rift_svg_element_set_attribute(root, "viewBox", buffer);
+}
+
+/**
+ * @brief Bring the document up to date with an automaton
+ */
+static bool
+synchronize(rift_svg_renderer_t *renderer, void *automaton)
+{
+    if (automaton != renderer->automaton) {
+        /* Updates waiting for the previous automaton are of no use now, nor is its trace */
+        rift_free(renderer->states_by_id);
+        renderer->states_by_id = NULL;
+        renderer->num_state_ids = 0;
+        renderer->active_state = NULL;
+        rift_real_time_update_manager_destroy(renderer->updates);
+        renderer->updates = rift_real_time_update_manager_create(renderer->mapper);
+        renderer->automaton = NULL;
+        if (!renderer->updates ||
+            !rift_svg_automaton_mapper_map_automaton_to_svg(renderer->mapper, automaton)) {
+            return false;
+        }
+        renderer->automaton = automaton;
+        return true;
+    }
+
+    rift_real_time_update_manager_flush(renderer->updates);
+    return true;
+}
+
+/**
+ * @brief Renders an automaton to SVG string
+ *
+ * @param renderer The renderer to use
+ * @param automaton The automaton to render
+ * @return char* The rendered SVG as a string (caller must free) or NULL on failure
+ */
+char *
+rift_svg_renderer_render(rift_svg_renderer_t *renderer, void *automaton)
+{
+    if (!renderer || !automaton || !synchronize(renderer, automaton)) {
+        return NULL;
+    }
+
+    /* The removals are part of this render, so a later patch must not repeat them */
+    size_t num_removed = 0;
+    char **removed = rift_svg_automaton_mapper_take_removed_ids(renderer->mapper, &num_removed);
+    for (size_t i = 0; i < num_removed; i++) {
+        rift_free(removed[i]);
+    }
+    rift_free(removed);
+
+    return rift_svg_element_to_string(
+        rift_svg_automaton_mapper_get_root_element(renderer->mapper));
+}
+
+/**
+ * @brief Exports the current SVG to a file
+ *
+ * @param renderer The renderer to use
+ * @param file_path The file path to export to
+ * @return bool True if export was successful, false otherwise
+ */
+bool
+rift_svg_renderer_export_to_file(rift_svg_renderer_t *renderer, const char *file_path)
+{
+    if (!renderer || !renderer->automaton || !file_path) {
+        return false;
+    }
+
+    char *svg = rift_svg_renderer_render(renderer, renderer->automaton);
+    if (!svg) {
+        return false;
+    }
+
+    FILE *file = fopen(file_path, "w");
+    bool ok = file && fputs(svg, file) >= 0;
+    if (file && fclose(file) != 0) {
+        ok = false;
+    }
+    rift_free(svg);
+    return ok;
+}
+
+/**
+ * @brief Applies accessibility settings to the renderer
+ *
+ * The settings are not interpreted yet; the document is always given an
+ * image role and a label for screen readers.
+ *
+ * @param renderer The renderer to modify
+ * @param settings The accessibility settings to apply
+ * @return void
+ */
+void
+rift_svg_renderer_apply_accessibility_settings(rift_svg_renderer_t *renderer, void *settings)
+{
+    (void)settings;
+    if (!renderer) {
+        return;
+    }
+
+    rift_svg_element_t *root = rift_svg_automaton_mapper_get_root_element(renderer->mapper);
+    rift_svg_element_set_attribute(root, "role", "img");
+    rift_svg_element_set_accessible_label(root, "Automaton diagram");
+}
+
+/**
+ * @brief Sets the color scheme for the SVG renderer
+ *
+ * The scheme is named in a data-color-scheme attribute of the document for
+ * style sheets to select on.
+ *
+ * @param renderer The renderer to modify
+ * @param scheme The color scheme to apply
+ * @return void
+ */
+void
+rift_svg_renderer_set_color_scheme(rift_svg_renderer_t *renderer, int scheme)
+{
+    size_t num_schemes = sizeof(color_scheme_names) / sizeof(color_scheme_names[0]);
+    if (!renderer || scheme < 0 || (size_t)scheme >= num_schemes) {
+        return;
+    }
+
+    rift_svg_element_set_attribute(rift_svg_automaton_mapper_get_root_element(renderer->mapper),
+                                   "data-color-scheme", color_scheme_names[scheme]);
+}
+
+/**
+ * @brief Gets the underlying SVG element from the renderer
+ *
+ * @param renderer The renderer to query
+ * @return rift_svg_element_t* The root SVG element
+ */
+rift_svg_element_t *
+rift_svg_renderer_get_root_element(rift_svg_renderer_t *renderer)
+{
+    return renderer ? rift_svg_automaton_mapper_get_root_element(renderer->mapper) : NULL;
+}
+
+/**
+ * @brief Updates the renderer in response to automaton changes
+ *
+ * Without telling what changed, the whole automaton is compared with the
+ * document in the next frame; only the elements that differ are changed.
+ *
+ * @param observer The observer (cast to rift_svg_renderer_t*)
+ * @param automaton The updated automaton
+ * @return void
+ */
+void
+rift_svg_renderer_update(rift_automaton_observer_t *observer, void *automaton)
+{
+    rift_svg_renderer_t *renderer = (rift_svg_renderer_t *)observer;
+    if (!renderer || !automaton || automaton != renderer->automaton) {
+        return;
+    }
+
+    rift_real_time_update_manager_schedule_update(
+        renderer->updates, rift_real_time_update_manager_create_update(
+                               RIFT_UPDATE_TYPE_LAYOUT_CHANGED, automaton, 0));
+    rift_real_time_update_manager_process_updates(renderer->updates);
+}
+
+/**
+ * @brief Gets the observer to notify of changes to the rendered automaton
+ *
+ * @param renderer The renderer to query
+ * @return rift_automaton_observer_t* The observer or NULL on error
+ */
+rift_automaton_observer_t *
+rift_svg_renderer_get_observer(rift_svg_renderer_t *renderer)
+{
+    return renderer ? &renderer->observer : NULL;
+}
+
+/**
+ * @brief Append a string to a growing patch
+ */
+static bool
+append_patch(char **patch, size_t *length, size_t *capacity, const char *text)
+{
+    size_t n = strlen(text);
+    if (*length + n + 1 > *capacity) {
+        size_t grown = *capacity ? *capacity : 256;
+        while (*length + n + 1 > grown) {
+            grown *= 2;
+        }
+        char *data = rift_realloc(*patch, grown);
+        if (!data) {
+            return false;
+        }
+        *patch = data;
+        *capacity = grown;
+    }
+    memcpy(*patch + *length, text, n + 1);
+    *length += n;
+    return true;
+}
+
+/**
+ * @brief Renders the elements changed since the last render
+ *
+ * @param renderer The renderer to use
+ * @return char* The changed elements (caller must free), empty if none, or NULL on failure
+ */
+char *
+rift_svg_renderer_render_changes(rift_svg_renderer_t *renderer)
+{
+    if (!renderer || !renderer->automaton) {
+        return NULL;
+    }
+    rift_real_time_update_manager_flush(renderer->updates);
+
+    char *patch = NULL;
+    size_t length = 0;
+    size_t capacity = 0;
+    bool ok = append_patch(&patch, &length, &capacity, "");
+
+    /* Removals first, so an element added again under a removed ID survives */
+    size_t num_removed = 0;
+    char **removed = rift_svg_automaton_mapper_take_removed_ids(renderer->mapper, &num_removed);
+    for (size_t i = 0; i < num_removed; i++) {
+        if (ok) {
+            ok = append_patch(&patch, &length, &capacity, "<g id=\"") &&
+                 append_patch(&patch, &length, &capacity, removed[i]) &&
+                 append_patch(&patch, &length, &capacity, "\" data-removed=\"true\"/>");
+        }
+        rift_free(removed[i]);
+    }
+    rift_free(removed);
+
+    rift_svg_element_t *root = rift_svg_automaton_mapper_get_root_element(renderer->mapper);
+    const size_t layers[] = {TRANSITIONS_LAYER, STATES_LAYER};
+    for (size_t l = 0; ok && l < 2; l++) {
+        rift_svg_element_t *layer = rift_svg_element_get_child(root, layers[l]);
+        size_t count = rift_svg_element_get_child_count(layer);
+        for (size_t i = 0; ok && i < count; i++) {
+            rift_svg_element_t *group = rift_svg_element_get_child(layer, i);
+            if (!rift_svg_element_is_dirty(group)) {
+                continue;
+            }
+            char *markup = rift_svg_element_to_string(group);
+            ok = markup && append_patch(&patch, &length, &capacity, markup);
+            rift_free(markup);
+        }
+    }
+
+    if (!ok) {
+        rift_free(patch);
+        return NULL;
+    }
+    return patch;
+}
+
+/**
+ * @brief Index the states of the rendered automaton by ID
+ *
+ * States are looked up by ID for every record played, so the index is
+ * built on the first play and kept until another automaton is rendered.
+ */
+static bool
+index_states(rift_svg_renderer_t *renderer)
+{
+    if (renderer->num_state_ids > 0) {
+        return true;
+    }
+
+    rift_regex_automaton_t *automaton = renderer->automaton;
+    size_t num_ids = 0;
+    for (size_t i = 0; i < automaton->num_states; i++) {
+        if (automaton->states[i] && automaton->states[i]->id >= num_ids) {
+            num_ids = automaton->states[i]->id + 1;
+        }
+    }
+    if (num_ids == 0) {
+        return false;
+    }
+
+    renderer->states_by_id = rift_malloc(num_ids * sizeof(rift_regex_state_t *));
+    if (!renderer->states_by_id) {
+        return false;
+    }
+    memset(renderer->states_by_id, 0, num_ids * sizeof(rift_regex_state_t *));
+    for (size_t i = 0; i < automaton->num_states; i++) {
+        if (automaton->states[i]) {
+            renderer->states_by_id[automaton->states[i]->id] = automaton->states[i];
+        }
+    }
+    renderer->num_state_ids = num_ids;
+    return true;
+}
+
+/**
+ * @brief Schedule the refresh of a state marked by a trace
+ */
+static void
+schedule_state(rift_svg_renderer_t *renderer, rift_regex_state_t *state)
+{
+    rift_real_time_update_manager_schedule_update(
+        renderer->updates,
+        rift_real_time_update_manager_create_update(RIFT_UPDATE_TYPE_STATE_MODIFIED, state, 0));
+}
+
+/**
+ * @brief Plays match trace records over the rendered automaton
+ *
+ * @param renderer The renderer, after an automaton was rendered
+ * @param records The records, oldest first
+ * @param count Number of records
+ * @return size_t The number of records played
+ */
+size_t
+rift_svg_renderer_play_trace(rift_svg_renderer_t *renderer, const rift_trace_record_t *records,
+                             size_t count)
+{
+    if (!renderer || !renderer->automaton || !records || !index_states(renderer)) {
+        return 0;
+    }
+
+    size_t played = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint32_t location = records[i].location;
+        rift_regex_state_t *state =
+            location < renderer->num_state_ids ? renderer->states_by_id[location] : NULL;
+        if (!state) {
+            continue;
+        }
+
+        if (renderer->active_state && renderer->active_state != state) {
+            rift_svg_automaton_mapper_mark_state(renderer->mapper, renderer->active_state, 0, 0,
+                                                 false);
+            schedule_state(renderer, renderer->active_state);
+        }
+        if (rift_svg_automaton_mapper_mark_state(
+                renderer->mapper, state, 1, records[i].event == RIFT_TRACE_EVENT_BACKTRACK,
+                true)) {
+            schedule_state(renderer, state);
+            renderer->active_state = state;
+            played++;
+        }
+    }
+    return played;
+}
+
+/**
+ * @brief Clears what the trace records played so far marked
+ *
+ * @param renderer The renderer
+ */
+void
+rift_svg_renderer_clear_trace(rift_svg_renderer_t *renderer)
+{
+    if (!renderer) {
+        return;
+    }
+
+    rift_svg_automaton_mapper_clear_marks(renderer->mapper);
+    renderer->active_state = NULL;
+}
@@ -0,0 +1,659 @@
+/**
+ * @file aho_corasick.c
+ * @brief Implementation of Aho-Corasick literal matching for the LibRift regex engine
+ *
+ * This file keeps the literals added to an automaton in one byte pool and
+ * compiles them on build: bytes no literal uses share class 0, the trie is
+ * laid out as a dense table over the classes, and a breadth-first pass fills
+ * the missing transitions through the failure links and chains each state to
+ * the nearest suffix state with outputs. Automata are expanded into literals
+ * by a depth-first walk of their frozen form.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/automaton/aho_corasick.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/automaton/byte_class.h"
+#include "core/automaton/frozen_automaton.h"
+#include "core/memory/memory.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef RIFT_BYTE_SCAN_SIMD128
+#include <wasm_simd128.h>
+#endif
+
+/**
+ * @brief Frame of the walk expanding an automaton into literals
+ */
+typedef struct {
+    uint32_t state;  /**< State of the frame */
+    uint32_t edge;   /**< Next edge to follow */
+    uint32_t byte;   /**< Next byte of the edge to try */
+    uint32_t length; /**< Bytes read to reach the state */
+} literal_frame_t;
+
+/**
+ * @brief Record an error of the automaton
+ */
+static void
+set_error(rift_regex_error_t *error, rift_regex_error_code_t code, const char *message)
+{
+    if (error) {
+        error->code = code;
+        snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH, "%s", message);
+    }
+}
+
+/**
+ * @brief Free the tables of the built automaton
+ */
+static void
+discard_tables(rift_aho_corasick_t *ac)
+{
+    rift_free(ac->transitions);
+    rift_free(ac->first_outputs);
+    rift_free(ac->output_tags);
+    rift_free(ac->output_next);
+    rift_free(ac->dict_links);
+    rift_free(ac->seen);
+    ac->transitions = NULL;
+    ac->first_outputs = NULL;
+    ac->output_tags = NULL;
+    ac->output_next = NULL;
+    ac->dict_links = NULL;
+    ac->seen = NULL;
+    ac->num_states = 0;
+    ac->built = false;
+}
+
+/**
+ * @brief Create an empty Aho-Corasick automaton
+ */
+rift_aho_corasick_t *
+rift_aho_corasick_create(rift_regex_error_t *error)
+{
+    rift_aho_corasick_t *ac = (rift_aho_corasick_t *)rift_calloc(1, sizeof(rift_aho_corasick_t));
+    if (!ac) {
+        set_error(error, RIFT_REGEX_ERROR_MEMORY, "Failed to allocate Aho-Corasick automaton");
+    }
+    return ac;
+}
+
+/**
+ * @brief Free an Aho-Corasick automaton
+ */
+void
+rift_aho_corasick_free(rift_aho_corasick_t *ac)
+{
+    if (!ac) {
+        return;
+    }
+    discard_tables(ac);
+    rift_free(ac->pool);
+    rift_free(ac->literal_offsets);
+    rift_free(ac->literal_lengths);
+    rift_free(ac->literal_tags);
+    rift_free(ac);
+}
+
+/**
+ * @brief Make room for one more literal of the given length
+ */
+static bool
+reserve_literal(rift_aho_corasick_t *ac, size_t length)
+{
+    if (ac->pool_size + length > ac->pool_capacity) {
+        size_t capacity = ac->pool_capacity ? ac->pool_capacity * 2 : 256;
+        while (capacity < ac->pool_size + length) {
+            capacity *= 2;
+        }
+        char *pool = (char *)rift_realloc(ac->pool, capacity);
+        if (!pool) {
+            return false;
+        }
+        ac->pool = pool;
+        ac->pool_capacity = capacity;
+    }
+
+    if (ac->num_literals == ac->literal_capacity) {
+        size_t capacity = ac->literal_capacity ? ac->literal_capacity * 2 : 16;
+        size_t *offsets =
+            (size_t *)rift_realloc(ac->literal_offsets, capacity * sizeof(size_t));
+        if (!offsets) {
+            return false;
+        }
+        ac->literal_offsets = offsets;
+        size_t *lengths =
+            (size_t *)rift_realloc(ac->literal_lengths, capacity * sizeof(size_t));
+        if (!lengths) {
+            return false;
+        }
+        ac->literal_lengths = lengths;
+        uint32_t *tags =
+            (uint32_t *)rift_realloc(ac->literal_tags, capacity * sizeof(uint32_t));
+        if (!tags) {
+            return false;
+        }
+        ac->literal_tags = tags;
+        ac->literal_capacity = capacity;
+    }
+    return true;
+}
+
+/**
+ * @brief Append a literal, the tables being rebuilt on the next build
+ */
+static bool
+append_literal(rift_aho_corasick_t *ac, const char *bytes, size_t length, uint32_t tag)
+{
+    if (!reserve_literal(ac, length)) {
+        return false;
+    }
+    memcpy(ac->pool + ac->pool_size, bytes, length);
+    ac->literal_offsets[ac->num_literals] = ac->pool_size;
+    ac->literal_lengths[ac->num_literals] = length;
+    ac->literal_tags[ac->num_literals] = tag;
+    ac->pool_size += length;
+    ac->num_literals++;
+    ac->built = false;
+    return true;
+}
+
+/**
+ * @brief Add a literal
+ */
+bool
+rift_aho_corasick_add(rift_aho_corasick_t *ac, const char *bytes, size_t length, uint32_t tag,
+                      rift_regex_error_t *error)
+{
+    if (!ac || !bytes || length == 0 || tag == UINT32_MAX) {
+        set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER, "Invalid literal provided");
+        return false;
+    }
+    if (!append_literal(ac, bytes, length, tag)) {
+        set_error(error, RIFT_REGEX_ERROR_MEMORY, "Failed to allocate literal");
+        return false;
+    }
+    if (tag >= ac->tag_limit) {
+        ac->tag_limit = tag + 1;
+    }
+    return true;
+}
+
+/**
+ * @brief Check whether an automaton can only accept literals, edges aside
+ */
+static bool
+has_state_data(const rift_frozen_automaton_t *frozen)
+{
+    if (frozen->num_counters > 0 || frozen->num_lookarounds > 0) {
+        return true;
+    }
+    for (uint32_t i = 0; i < frozen->num_states; i++) {
+        if (frozen->state_flags[i] != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Count the bytes an edge accepts, stopping past the allowed number
+ */
+static uint32_t
+edge_byte_count(const rift_frozen_automaton_t *frozen, uint32_t edge)
+{
+    uint32_t count = 0;
+    for (uint32_t byte = 0; byte < 256 && count <= RIFT_AHO_CORASICK_MAX_EDGE_BYTES; byte++) {
+        count += rift_transition_predicate_test(&frozen->edge_predicates[edge], (uint8_t)byte);
+    }
+    return count;
+}
+
+/**
+ * @brief Append every string a frozen automaton accepts
+ *
+ * Each frame holds a state and the bytes read to reach it; a byte edge pushes
+ * one frame per byte it accepts, so every path is visited once and every
+ * string is appended once per path accepting it.
+ *
+ * @return RIFT_REGEX_ERROR_NONE, or the reason the automaton does not expand
+ */
+static rift_regex_error_code_t
+expand_literals(rift_aho_corasick_t *ac, const rift_frozen_automaton_t *frozen, uint32_t tag)
+{
+    char buffer[RIFT_AHO_CORASICK_MAX_LITERAL_LENGTH];
+    size_t capacity = 64;
+    literal_frame_t *stack = (literal_frame_t *)rift_malloc(capacity * sizeof(literal_frame_t));
+    if (!stack) {
+        return RIFT_REGEX_ERROR_MEMORY;
+    }
+
+    rift_regex_error_code_t code = RIFT_REGEX_ERROR_NONE;
+    size_t top = 0;
+    size_t visits = 0;
+    uint32_t state = frozen->start_state;
+    uint32_t length = 0;
+    for (;;) {
+        // Enter the state, reached by the string in the first length bytes of buffer
+        if (++visits > RIFT_AHO_CORASICK_MAX_EXPANSION) {
+            code = RIFT_REGEX_ERROR_LIMIT_EXCEEDED;
+            break;
+        }
+        if (rift_frozen_automaton_is_accepting(frozen, state)) {
+            if (length == 0) {
+                code = RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE;
+                break;
+            }
+            if (!append_literal(ac, buffer, length, tag)) {
+                code = RIFT_REGEX_ERROR_MEMORY;
+                break;
+            }
+        }
+        if (top == capacity) {
+            capacity *= 2;
+            literal_frame_t *frames =
+                (literal_frame_t *)rift_realloc(stack, capacity * sizeof(literal_frame_t));
+            if (!frames) {
+                code = RIFT_REGEX_ERROR_MEMORY;
+                break;
+            }
+            stack = frames;
+        }
+        stack[top++] = (literal_frame_t){state, frozen->edge_offsets[state], 0, length};
+
+        // Find the next state to enter, or finish once the walk is back at the start
+        bool entered = false;
+        while (!entered && top > 0) {
+            literal_frame_t *frame = &stack[top - 1];
+            uint32_t e = frame->edge;
+            if (e == frozen->edge_offsets[frame->state + 1]) {
+                top--;
+                continue;
+            }
+            if (rift_frozen_automaton_edge_is_epsilon(frozen, e)) {
+                frame->edge++;
+                state = frozen->edge_targets[e];
+                length = frame->length;
+                entered = true;
+                continue;
+            }
+            if (frame->byte == 0 &&
+                edge_byte_count(frozen, e) > RIFT_AHO_CORASICK_MAX_EDGE_BYTES) {
+                code = RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE;
+                break;
+            }
+
+            uint32_t byte = frame->byte;
+            while (byte < 256 &&
+                   !rift_transition_predicate_test(&frozen->edge_predicates[e], (uint8_t)byte)) {
+                byte++;
+            }
+            if (byte == 256) {
+                frame->edge++;
+                frame->byte = 0;
+                continue;
+            }
+            if (frame->length == RIFT_AHO_CORASICK_MAX_LITERAL_LENGTH) {
+                code = RIFT_REGEX_ERROR_LIMIT_EXCEEDED;
+                break;
+            }
+            frame->byte = byte + 1;
+            buffer[frame->length] = (char)byte;
+            state = frozen->edge_targets[e];
+            length = frame->length + 1;
+            entered = true;
+        }
+        if (!entered) {
+            break;
+        }
+    }
+
+    rift_free(stack);
+    return code;
+}
+
+/**
+ * @brief Add every string an automaton accepts as a literal
+ */
+bool
+rift_aho_corasick_add_automaton(rift_aho_corasick_t *ac, const rift_regex_automaton_t *automaton,
+                                uint32_t tag, rift_regex_error_t *error)
+{
+    if (!ac || !automaton || tag == UINT32_MAX) {
+        set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER, "Invalid automaton provided");
+        return false;
+    }
+
+    rift_frozen_automaton_t *frozen = rift_frozen_automaton_create(automaton, error);
+    if (!frozen) {
+        return false;
+    }
+    if (frozen->start_state == RIFT_FROZEN_NO_STATE) {
+        rift_frozen_automaton_free(frozen);
+        set_error(error, RIFT_REGEX_ERROR_INVALID_AUTOMATON, "Automaton has no initial state");
+        return false;
+    }
+    if (has_state_data(frozen)) {
+        rift_frozen_automaton_free(frozen);
+        set_error(error, RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE,
+                  "Assertions and counted loops do not reduce to literals");
+        return false;
+    }
+
+    // Literals appended before a failure are dropped again
+    size_t num_literals = ac->num_literals;
+    size_t pool_size = ac->pool_size;
+    bool built = ac->built;
+    rift_regex_error_code_t code = expand_literals(ac, frozen, tag);
+    rift_frozen_automaton_free(frozen);
+    if (code != RIFT_REGEX_ERROR_NONE) {
+        ac->num_literals = num_literals;
+        ac->pool_size = pool_size;
+        ac->built = built;
+        set_error(error, code,
+                  code == RIFT_REGEX_ERROR_MEMORY ? "Failed to allocate literal"
+                  : code == RIFT_REGEX_ERROR_LIMIT_EXCEEDED
+                      ? "Automaton expands to too many or too long literals"
+                      : "Automaton accepts more than a finite set of literals");
+        return false;
+    }
+    if (ac->num_literals > num_literals && tag >= ac->tag_limit) {
+        ac->tag_limit = tag + 1;
+    }
+    return true;
+}
+
+/**
+ * @brief Number the byte classes and note the bytes that leave the root
+ */
+static void
+build_classes(rift_aho_corasick_t *ac)
+{
+    bool used[256] = {false};
+    for (size_t i = 0; i < ac->pool_size; i++) {
+        used[(uint8_t)ac->pool[i]] = true;
+    }
+
+    ac->num_classes = 1;
+    ac->num_start_bytes = 0;
+    for (uint32_t byte = 0; byte < 256; byte++) {
+        ac->classes[byte] = used[byte] ? (uint8_t)ac->num_classes++ : 0;
+    }
+    for (size_t i = 0; i < ac->num_literals; i++) {
+        used[(uint8_t)ac->pool[ac->literal_offsets[i]]] = false;
+    }
+    for (uint32_t byte = 0; byte < 256; byte++) {
+        if (!used[byte] && ac->classes[byte] != 0) {
+            if (ac->num_start_bytes < RIFT_AHO_CORASICK_MAX_START_BYTES) {
+                ac->start_bytes[ac->num_start_bytes] = (uint8_t)byte;
+            }
+            ac->num_start_bytes++;
+        }
+    }
+    if (ac->num_start_bytes > RIFT_AHO_CORASICK_MAX_START_BYTES) {
+        ac->num_start_bytes = 256;
+    }
+
+    // Unused slots repeat the first byte, so scans always compare against all of them
+    for (uint32_t i = ac->num_start_bytes; i < RIFT_AHO_CORASICK_MAX_START_BYTES; i++) {
+        ac->start_bytes[i] = ac->start_bytes[0];
+    }
+}
+
+/**
+ * @brief Lay the literals out as a trie, state 0 the root and 0 a missing child
+ */
+static void
+build_trie(rift_aho_corasick_t *ac)
+{
+    uint32_t num_classes = ac->num_classes;
+    ac->num_states = 1;
+    ac->first_outputs[0] = RIFT_AHO_CORASICK_NONE;
+    for (size_t i = 0; i < ac->num_literals; i++) {
+        const uint8_t *bytes = (const uint8_t *)ac->pool + ac->literal_offsets[i];
+        uint32_t state = 0;
+        for (size_t j = 0; j < ac->literal_lengths[i]; j++) {
+            uint32_t *child = &ac->transitions[(size_t)state * num_classes + ac->classes[bytes[j]]];
+            if (*child == 0) {
+                *child = ac->num_states;
+                ac->first_outputs[ac->num_states++] = RIFT_AHO_CORASICK_NONE;
+            }
+            state = *child;
+        }
+
+        // A literal added twice with one tag reports once
+        uint32_t output = ac->first_outputs[state];
+        while (output != RIFT_AHO_CORASICK_NONE && ac->output_tags[output] != ac->literal_tags[i]) {
+            output = ac->output_next[output];
+        }
+        if (output == RIFT_AHO_CORASICK_NONE) {
+            ac->output_tags[i] = ac->literal_tags[i];
+            ac->output_next[i] = ac->first_outputs[state];
+            ac->first_outputs[state] = (uint32_t)i;
+        }
+    }
+}
+
+/**
+ * @brief Follow the failure links into the missing transitions, breadth first
+ *
+ * When a state is taken off the queue, its row still holds only its trie
+ * children, and the rows of every shallower state are complete. The failure
+ * state of a child on class c is where the parent's failure state goes on c.
+ */
+static void
+build_links(rift_aho_corasick_t *ac, uint32_t *queue, uint32_t *failures)
+{
+    uint32_t num_classes = ac->num_classes;
+    size_t head = 0;
+    size_t tail = 0;
+    failures[0] = 0;
+    ac->dict_links[0] = RIFT_AHO_CORASICK_NONE;
+    queue[tail++] = 0;
+    while (head < tail) {
+        uint32_t state = queue[head++];
+        uint32_t *row = &ac->transitions[(size_t)state * num_classes];
+        const uint32_t *failure_row = &ac->transitions[(size_t)failures[state] * num_classes];
+        for (uint32_t c = 1; c < num_classes; c++) {
+            if (row[c] == 0) {
+                row[c] = state == 0 ? 0 : failure_row[c];
+                continue;
+            }
+            uint32_t child = row[c];
+            uint32_t failure = state == 0 ? 0 : failure_row[c];
+            failures[child] = failure;
+            ac->dict_links[child] = ac->first_outputs[failure] != RIFT_AHO_CORASICK_NONE
+                                        ? failure
+                                        : ac->dict_links[failure];
+            queue[tail++] = child;
+        }
+    }
+}
+
+/**
+ * @brief Compile the literals into the scanning automaton
+ */
+static bool
+build_automaton(rift_aho_corasick_t *ac)
+{
+    discard_tables(ac);
+    build_classes(ac);
+
+    // A trie has at most one state per literal byte besides the root
+    size_t max_states = ac->pool_size + 1;
+    ac->transitions =
+        (uint32_t *)rift_calloc(max_states * ac->num_classes, sizeof(uint32_t));
+    ac->first_outputs = (uint32_t *)rift_malloc(max_states * sizeof(uint32_t));
+    ac->output_tags = (uint32_t *)rift_malloc((ac->num_literals + 1) * sizeof(uint32_t));
+    ac->output_next = (uint32_t *)rift_malloc((ac->num_literals + 1) * sizeof(uint32_t));
+    ac->dict_links = (uint32_t *)rift_malloc(max_states * sizeof(uint32_t));
+    uint32_t *queue = (uint32_t *)rift_malloc(max_states * sizeof(uint32_t));
+    uint32_t *failures = (uint32_t *)rift_malloc(max_states * sizeof(uint32_t));
+    bool built = ac->transitions && ac->first_outputs && ac->output_tags && ac->output_next &&
+                 ac->dict_links && queue && failures;
+    if (built) {
+        build_trie(ac);
+        build_links(ac, queue, failures);
+        ac->seen = (uint32_t *)rift_calloc(ac->num_states, sizeof(uint32_t));
+        built = ac->seen != NULL;
+    }
+    rift_free(queue);
+    rift_free(failures);
+
+    if (!built) {
+        discard_tables(ac);
+        return false;
+    }
+    ac->generation = 0;
+    ac->built = true;
+    return true;
+}
+
+/**
+ * @brief Compile the literals added so far into the scanning automaton
+ */
+bool
+rift_aho_corasick_build(rift_aho_corasick_t *ac, rift_regex_error_t *error)
+{
+    if (!ac) {
+        set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER, "Null automaton provided");
+        return false;
+    }
+    if (ac->pool_size >= UINT32_MAX) {
+        set_error(error, RIFT_REGEX_ERROR_LIMIT_EXCEEDED, "Too many literal bytes");
+        return false;
+    }
+
+    rift_memory_tag_t outer = rift_memory_tag_use(RIFT_MEMORY_TAG_DFA);
+    bool built = build_automaton(ac);
+    rift_memory_tag_use(outer);
+    if (!built) {
+        set_error(error, RIFT_REGEX_ERROR_MEMORY, "Failed to allocate Aho-Corasick tables");
+    }
+    return built;
+}
+
+/**
+ * @brief Get the number of states of a built automaton
+ */
+size_t
+rift_aho_corasick_get_state_count(const rift_aho_corasick_t *ac)
+{
+    return ac && ac->built ? ac->num_states : 0;
+}
+
+/**
+ * @brief Set the tags of a state and of its suffixes not reported yet in this scan
+ */
+static void
+report_state(rift_aho_corasick_t *ac, uint32_t state, uint64_t *tags)
+{
+    while (state != RIFT_AHO_CORASICK_NONE && ac->seen[state] != ac->generation) {
+        ac->seen[state] = ac->generation;
+        for (uint32_t output = ac->first_outputs[state]; output != RIFT_AHO_CORASICK_NONE;
+             output = ac->output_next[output]) {
+            tags[ac->output_tags[output] >> 6] |= UINT64_C(1) << (ac->output_tags[output] & 63);
+        }
+        state = ac->dict_links[state];
+    }
+}
+
+/**
+ * @brief Find the next input byte that leaves the root
+ *
+ * Blocks of 16 bytes are compared against every start byte at once where
+ * SSE2 or Wasm SIMD is available.
+ *
+ * @param bytes The start bytes
+ * @param input The input bytes
+ * @param start First position to consider
+ * @param end Position after the last one to consider
+ * @return Position of the byte or end if none leaves the root
+ */
+static size_t
+find_start_byte(const uint8_t *bytes, const char *input, size_t start, size_t end)
+{
+    size_t pos = start;
+#if defined(RIFT_BYTE_SCAN_SIMD128)
+    v128_t first = wasm_i8x16_splat((int8_t)bytes[0]);
+    v128_t second = wasm_i8x16_splat((int8_t)bytes[1]);
+    v128_t third = wasm_i8x16_splat((int8_t)bytes[2]);
+    for (; pos + 16 <= end; pos += 16) {
+        v128_t block = wasm_v128_load(input + pos);
+        uint32_t mask = wasm_i8x16_bitmask(
+            wasm_v128_or(wasm_v128_or(wasm_i8x16_eq(block, first), wasm_i8x16_eq(block, second)),
+                         wasm_i8x16_eq(block, third)));
+        if (mask != 0) {
+            return pos + (size_t)__builtin_ctz(mask);
+        }
+    }
+#elif defined(__SSE2__)
+    __m128i first = _mm_set1_epi8((char)bytes[0]);
+    __m128i second = _mm_set1_epi8((char)bytes[1]);
+    __m128i third = _mm_set1_epi8((char)bytes[2]);
+    for (; pos + 16 <= end; pos += 16) {
+        __m128i block = _mm_loadu_si128((const __m128i *)(input + pos));
+        int mask = _mm_movemask_epi8(
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, first), _mm_cmpeq_epi8(block, second)),
+                         _mm_cmpeq_epi8(block, third)));
+        if (mask != 0) {
+            return pos + (size_t)__builtin_ctz((unsigned int)mask);
+        }
+    }
+#endif
+
+    for (; pos < end; pos++) {
+        uint8_t c = (uint8_t)input[pos];
+        if (c == bytes[0] || c == bytes[1] || c == bytes[2]) {
+            return pos;
+        }
+    }
+    return end;
+}
+
+/**
+ * @brief Collect the tags of every literal occurring in the input
+ */
+bool
+rift_aho_corasick_scan(rift_aho_corasick_t *ac, const char *input, size_t length, uint64_t *tags,
+                       size_t num_words)
+{
+    if (!ac || !ac->built || (!input && length > 0) || !tags ||
+        num_words < ((size_t)ac->tag_limit + 63) / 64) {
+        return false;
+    }
+    memset(tags, 0, num_words * sizeof(uint64_t));
+    if (ac->num_start_bytes == 0) {
+        return true;
+    }
+
+    if (++ac->generation == 0) {
+        memset(ac->seen, 0, ac->num_states * sizeof(uint32_t));
+        ac->generation = 1;
+    }
+
+    const uint32_t *transitions = ac->transitions;
+    uint32_t num_classes = ac->num_classes;
+    bool skip = ac->num_start_bytes <= RIFT_AHO_CORASICK_MAX_START_BYTES;
+    uint32_t state = 0;
+    for (size_t i = 0; i < length;) {
+        if (state == 0 && skip) {
+            i = find_start_byte(ac->start_bytes, input, i, length);
+            if (i == length) {
+                break;
+            }
+        }
+        state = transitions[(size_t)state * num_classes + ac->classes[(uint8_t)input[i++]]];
+        if (ac->first_outputs[state] != RIFT_AHO_CORASICK_NONE ||
+            ac->dict_links[state] != RIFT_AHO_CORASICK_NONE) {
+            report_state(ac, state, tags);
+        }
+    }
+    return true;
+}
@@ -87589,6 +87589,13 @@ utomaton/automaton.h"/a #include "core/errors/regex_error.h"
  */
 
 #include "core/automaton/automaton.h
+#include "core/automaton/byte_class.h"
+#include "core/automaton/frozen_automaton.h"
+#include "core/automaton/epsilon_closure.h"
+#include "core/automaton/lookaround.h"
+#include "core/automaton/sparse_set.h"
+#include "core/automaton/subset_table.h"
+#include "core/config/config.h"
 #include "core/automaton/state.h"
 
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
@@ -91685,9 +91692,9 @@ utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 /**
- * @brief Maximum size for automaton states
+ * @brief DFA state budget used when the configuration cannot be read
  */
-#define MAX_AUTOMATON_STATES 1024
+#define AUTOMATON_DEFAULT_DFA_STATE_BUDGET 10000
 
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
@@ -95861,23 +95868,12 @@ rift_automaton_create_epsilon_transition(rift_regex_automaton_t *automaton,
     }
 
     // Ensure both states belong to this automaton
-    bool from_found = false, to_found = false;
-    for (size_t i = 0; i < automaton->num_states; i++) {
-        if (automaton->states[i] == from_state) {
-            from_found = true;
-        }
-        if (automaton->states[i] == to_state) {
-            to_found = true;
-        }
-        if (from_found && to_found) {
-            break;
-        }
-    }
-
-    if (!from_found || !to_found) {
+    if (rift_automaton_get_state_index(automaton, from_state) == RIFT_STATE_NO_ID ||
+        rift_automaton_get_state_index(automaton, to_state) == RIFT_STATE_NO_ID) {
         return false; // States not found in automaton
     }
 
+    rift_automaton_invalidate_epsilon_closures(automaton);
     return rift_state_add_epsilon_transition(from_state, to_state);
 }
 
@@ -100032,7 +100028,9 @@ rift_automaton_add_state_internal(rift_regex_automaton_t *automaton, rift_regex_
         return false;
     }
 
-    // Add the state to the automaton
+    // Add the state to the automaton, its ID being its index
+    rift_automaton_invalidate_epsilon_closures(automaton);
+    state->id = automaton->num_states;
     automaton->states[automaton->num_states] = state;
     automaton->num_states++;
 
@@ -102116,7 +102114,9 @@ rift_automaton_create_state(struct rift_regex_automaton *automaton, bool is_acce
         automaton->state_capacity = new_capacity;
     }
 
-    // Add the state to the automaton
+    // Add the state to the automaton, its ID being its index
+    rift_automaton_invalidate_epsilon_closures(automaton);
+    state->id = automaton->num_states;
     automaton->states[automaton->num_states++] = state;
 
     // If this is the first state, make it the initial state
@@ -104173,2077 +104173,18 @@ utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 /**
- * @brief Get the type of an automaton
- *
- * @param automaton The automaton
- * @return The automaton type
- */
-rift_automaton_type_t
-rift_automaton_get_type(const rift_regex_automaton_t *automaton)
-{
-    if (!automaton) {
-        return RIFT_AUTOMATON_INVALID;
-    }
-    return automaton->type;
-}
-
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/config/config.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/runtime/matcher.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/config/config.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/memory/memory.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/config/config.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/runtime/matcher.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/config/config.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/config/config.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/runtime/matcher.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/config/config.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/memory/memory.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/config/config.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/runtime/matcher.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/config/config.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/config/config.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/runtime/matcher.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/config/config.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/memory/memory.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/config/config.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/runtime/matcher.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/config/config.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/config/config.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/runtime/matcher.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/config/config.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/memory/memory.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/config/config.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/runtime/matcher.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/config/config.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/automaton.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/compiler/compiler.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/minimizer.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/state.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-utomaton/automaton.h"/a #include "core/automaton/transition.h"
-utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-/**
- * @brief Check if an automaton is deterministic
+ * @brief Get the type of an automaton
  *
  * @param automaton The automaton
- * @return true if the automaton is a DFA, false otherwise
+ * @return The automaton type
  */
-bool
-rift_automaton_is_deterministic(const rift_regex_automaton_t *automaton)
+rift_automaton_type_t
+rift_automaton_get_type(const rift_regex_automaton_t *automaton)
 {
     if (!automaton) {
-        return false;
+        return RIFT_AUTOMATON_INVALID;
     }
-    return automaton->is_deterministic;
+    return automaton->type;
 }
 
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
@@ -108291,34 +106232,18 @@ utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 /**
- * @brief Set the initial state of an automaton
+ * @brief Check if an automaton is deterministic
  *
  * @param automaton The automaton
- * @param state The state to set as initial
- * @return true if successful, false otherwise
+ * @return true if the automaton is a DFA, false otherwise
  */
 bool
-rift_automaton_set_initial_state(rift_regex_automaton_t *automaton, rift_regex_state_t *state)
+rift_automaton_is_deterministic(const rift_regex_automaton_t *automaton)
 {
-    if (!automaton || !state) {
+    if (!automaton) {
         return false;
     }
-
-    // Ensure the state belongs to this automaton
-    bool state_found = false;
-    for (size_t i = 0; i < automaton->num_states; i++) {
-        if (automaton->states[i] == state) {
-            state_found = true;
-            break;
-        }
-    }
-
-    if (!state_found) {
-        return false; // State does not belong to this automaton
-    }
-
-    automaton->initial_state = state;
-    return true;
+    return automaton->is_deterministic;
 }
 
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
@@ -110366,18 +108291,26 @@ utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 /**
- * @brief Get the initial state of an automaton
+ * @brief Set the initial state of an automaton
  *
  * @param automaton The automaton
- * @return The initial state or NULL if not set
+ * @param state The state to set as initial
+ * @return true if successful, false otherwise
  */
-rift_regex_state_t *
-rift_automaton_get_initial_state(const rift_regex_automaton_t *automaton)
+bool
+rift_automaton_set_initial_state(rift_regex_automaton_t *automaton, rift_regex_state_t *state)
 {
-    if (!automaton) {
-        return NULL;
+    if (!automaton || !state) {
+        return false;
     }
-    return automaton->initial_state;
+
+    // Ensure the state belongs to this automaton
+    if (rift_automaton_get_state_index(automaton, state) == RIFT_STATE_NO_ID) {
+        return false; // State does not belong to this automaton
+    }
+
+    automaton->initial_state = state;
+    return true;
 }
 
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
@@ -112425,18 +110358,18 @@ utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 /**
- * @brief Get the number of states in an automaton
+ * @brief Get the initial state of an automaton
  *
  * @param automaton The automaton
- * @return The number of states
+ * @return The initial state or NULL if not set
  */
-size_t
-rift_automaton_get_state_count(const rift_regex_automaton_t *automaton)
+rift_regex_state_t *
+rift_automaton_get_initial_state(const rift_regex_automaton_t *automaton)
 {
     if (!automaton) {
-        return 0;
+        return NULL;
     }
-    return automaton->num_states;
+    return automaton->initial_state;
 }
 
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
@@ -114484,19 +112417,18 @@ utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 /**
- * @brief Get a state by index
+ * @brief Get the number of states in an automaton
  *
  * @param automaton The automaton
- * @param index The index of the state
- * @return The state or NULL if the index is out of bounds
+ * @return The number of states
  */
-rift_regex_state_t *
-rift_automaton_get_state_by_index(const rift_regex_automaton_t *automaton, size_t index)
+size_t
+rift_automaton_get_state_count(const rift_regex_automaton_t *automaton)
 {
-    if (!automaton || index >= automaton->num_states) {
-        return NULL;
+    if (!automaton) {
+        return 0;
     }
-    return automaton->states[index];
+    return automaton->num_states;
 }
 
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
@@ -116544,26 +114476,19 @@ utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 /**
- * @brief Find a state by ID
+ * @brief Get a state by index
  *
  * @param automaton The automaton
- * @param id The ID of the state to find
- * @return The state or NULL if not found
+ * @param index The index of the state
+ * @return The state or NULL if the index is out of bounds
  */
 rift_regex_state_t *
-rift_automaton_find_state_by_id(const rift_regex_automaton_t *automaton, size_t id)
+rift_automaton_get_state_by_index(const rift_regex_automaton_t *automaton, size_t index)
 {
-    if (!automaton) {
+    if (!automaton || index >= automaton->num_states) {
         return NULL;
     }
-
-    for (size_t i = 0; i < automaton->num_states; i++) {
-        if (rift_state_get_id(automaton->states[i]) == id) {
-            return automaton->states[i];
-        }
-    }
-
-    return NULL; // State not found
+    return automaton->states[index];
 }
 
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
@@ -118611,54 +116536,41 @@ utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 /**
- * @brief Add a transition between two states in the automaton
+ * @brief Find a state by ID
  *
  * @param automaton The automaton
- * @param from_state The source state
- * @param to_state The target state
- * @param pattern The pattern for the transition
- * @return true if successful, false otherwise
+ * @param id The ID of the state to find
+ * @return The state or NULL if not found
  */
-bool
-rift_automaton_add_transition(rift_regex_automaton_t *automaton, rift_regex_state_t *from_state,
-                              rift_regex_state_t *to_state, const char *pattern)
+rift_regex_state_t *
+rift_automaton_find_state_by_id(const rift_regex_automaton_t *automaton, size_t id)
 {
-    if (!automaton || !from_state || !to_state) {
-        return false;
+    if (!automaton || id >= automaton->num_states) {
+        return NULL;
     }
 
-    // Ensure both states belong to this automaton
-    bool from_found = false, to_found = false;
-    for (size_t i = 0; i < automaton->num_states; i++) {
-        if (automaton->states[i] == from_state) {
-            from_found = true;
-        }
-        if (automaton->states[i] == to_state) {
-            to_found = true;
-        }
-        if (from_found && to_found) {
-            break;
-        }
-    }
+    return automaton->states[id];
+}
 
-    if (!from_found || !to_found) {
-        return false; // One or both states do not belong to this automaton
+/**
+ * @brief Get the index of a state in an automaton
+ *
+ * @param automaton The automaton
+ * @param state The state
+ * @return The index, or RIFT_STATE_NO_ID if the state is not in the automaton
+ */
+size_t
+rift_automaton_get_state_index(const rift_regex_automaton_t *automaton,
+                               const rift_regex_state_t *state)
+{
+    if (!automaton || !state || state->id >= automaton->num_states ||
+        automaton->states[state->id] != state) {
+        return RIFT_STATE_NO_ID;
     }
 
-    // Add the transition to the source state
-    if (pattern == NULL) {
-        return rift_state_add_epsilon_transition(from_state, to_state);
-    } else {
-        return rift_state_add_transition(from_state, to_state, pattern);
-    }
-}
-bool
-rift_automaton_minimize(rift_regex_automaton_t *automaton)
-{
-    // Placeholder implementation for minimizing the automaton
-    // Add the actual logic here
-    return true; // Return true for now to avoid errors
+    return state->id;
 }
+
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
@@ -120704,19 +118616,44 @@ utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 /**
- * @brief Reset an automaton to its initial state
+ * @brief Add a transition between two states in the automaton
  *
- * @param automaton The automaton to reset
+ * @param automaton The automaton
+ * @param from_state The source state
+ * @param to_state The target state
+ * @param pattern The pattern for the transition
+ * @return true if successful, false otherwise
  */
-void
-rift_automaton_reset(rift_regex_automaton_t *automaton)
+bool
+rift_automaton_add_transition(rift_regex_automaton_t *automaton, rift_regex_state_t *from_state,
+                              rift_regex_state_t *to_state, const char *pattern)
 {
-    if (!automaton) {
-        return;
+    if (!automaton || !from_state || !to_state) {
+        return false;
+    }
+
+    // Ensure both states belong to this automaton
+    if (rift_automaton_get_state_index(automaton, from_state) == RIFT_STATE_NO_ID ||
+        rift_automaton_get_state_index(automaton, to_state) == RIFT_STATE_NO_ID) {
+        return false; // One or both states do not belong to this automaton
     }
-    automaton->current_state = automaton->initial_state;
-}
 
+    rift_automaton_invalidate_epsilon_closures(automaton);
+
+    // Add the transition to the source state
+    if (pattern == NULL) {
+        return rift_state_add_epsilon_transition(from_state, to_state);
+    } else {
+        return rift_state_add_transition(from_state, to_state, pattern);
+    }
+}
+bool
+rift_automaton_minimize(rift_regex_automaton_t *automaton)
+{
+    // Placeholder implementation for minimizing the automaton
+    // Add the actual logic here
+    return true; // Return true for now to avoid errors
+}
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
@@ -122762,18 +120699,17 @@ utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 /**
- * @brief Get the current state of an automaton
+ * @brief Reset an automaton to its initial state
  *
- * @param automaton The automaton
- * @return The current state or NULL if not set
+ * @param automaton The automaton to reset
  */
-rift_regex_state_t *
-rift_automaton_get_current_state(const rift_regex_automaton_t *automaton)
+void
+rift_automaton_reset(rift_regex_automaton_t *automaton)
 {
     if (!automaton) {
-        return NULL;
+        return;
     }
-    return automaton->current_state;
+    automaton->current_state = automaton->initial_state;
 }
 
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
@@ -124821,34 +122757,18 @@ utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 /**
- * @brief Set the current state of an automaton
+ * @brief Get the current state of an automaton
  *
  * @param automaton The automaton
- * @param state The state to set as current
- * @return true if successful, false otherwise
+ * @return The current state or NULL if not set
  */
-bool
-rift_automaton_set_current_state(rift_regex_automaton_t *automaton, rift_regex_state_t *state)
+rift_regex_state_t *
+rift_automaton_get_current_state(const rift_regex_automaton_t *automaton)
 {
-    if (!automaton || !state) {
-        return false;
-    }
-
-    // Check if the state belongs to this automaton
-    bool state_found = false;
-    for (size_t i = 0; i < automaton->num_states; i++) {
-        if (automaton->states[i] == state) {
-            state_found = true;
-            break;
-        }
-    }
-
-    if (!state_found) {
-        return false; // State does not belong to this automaton
+    if (!automaton) {
+        return NULL;
     }
-
-    automaton->current_state = state;
-    return true;
+    return automaton->current_state;
 }
 
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
@@ -126896,18 +124816,26 @@ utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 /**
- * @brief Check if the automaton is in an accepting state
+ * @brief Set the current state of an automaton
  *
  * @param automaton The automaton
- * @return true if the current state is accepting, false otherwise
+ * @param state The state to set as current
+ * @return true if successful, false otherwise
  */
 bool
-rift_automaton_is_accepting(const rift_regex_automaton_t *automaton)
+rift_automaton_set_current_state(rift_regex_automaton_t *automaton, rift_regex_state_t *state)
 {
-    if (!automaton || !automaton->current_state) {
+    if (!automaton || !state) {
         return false;
     }
-    return rift_state_is_accepting(automaton->current_state);
+
+    // Check if the state belongs to this automaton
+    if (rift_automaton_get_state_index(automaton, state) == RIFT_STATE_NO_ID) {
+        return false; // State does not belong to this automaton
+    }
+
+    automaton->current_state = state;
+    return true;
 }
 
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
@@ -128955,34 +126883,18 @@ utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 /**
- * @brief Get the current transitions from the current state of an automaton
+ * @brief Check if the automaton is in an accepting state
  *
  * @param automaton The automaton
- * @param transitions Array to store the transitions
- * @param max_transitions Maximum number of transitions to store
- * @return The number of transitions stored
+ * @return true if the current state is accepting, false otherwise
  */
-size_t
-rift_automaton_get_current_transitions(rift_regex_automaton_t *automaton,
-                                       rift_regex_transition_t **transitions,
-                                       size_t max_transitions)
+bool
+rift_automaton_is_accepting(const rift_regex_automaton_t *automaton)
 {
-    if (!automaton || !automaton->current_state || !transitions || max_transitions == 0) {
-        return 0;
-    }
-
-    rift_regex_state_t *state = automaton->current_state;
-    size_t num_transitions = rift_state_get_transition_count(state);
-    size_t count = 0;
-
-    for (size_t i = 0; i < num_transitions && count < max_transitions; i++) {
-        rift_regex_transition_t *transition = rift_state_get_transition(state, i);
-        if (transition) {
-            transitions[count++] = transition;
-        }
+    if (!automaton || !automaton->current_state) {
+        return false;
     }
-
-    return count;
+    return rift_state_is_accepting(automaton->current_state);
 }
 
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
@@ -131030,20 +128942,34 @@ utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 /**
- * @brief Check if a transition matches a character
+ * @brief Get the current transitions from the current state of an automaton
  *
- * @param transition The transition to check
- * @param c The character to check
- * @return true if the transition matches the character, false otherwise
+ * @param automaton The automaton
+ * @param transitions Array to store the transitions
+ * @param max_transitions Maximum number of transitions to store
+ * @return The number of transitions stored
  */
-bool
-rift_automaton_transition_matches(rift_regex_transition_t *transition, char c)
+size_t
+rift_automaton_get_current_transitions(rift_regex_automaton_t *automaton,
+                                       rift_regex_transition_t **transitions,
+                                       size_t max_transitions)
 {
-    if (!transition) {
-        return false;
+    if (!automaton || !automaton->current_state || !transitions || max_transitions == 0) {
+        return 0;
     }
 
-    return rift_transition_matches_char(transition, c);
+    rift_regex_state_t *state = automaton->current_state;
+    size_t num_transitions = rift_state_get_transition_count(state);
+    size_t count = 0;
+
+    for (size_t i = 0; i < num_transitions && count < max_transitions; i++) {
+        rift_regex_transition_t *transition = rift_state_get_transition(state, i);
+        if (transition) {
+            transitions[count++] = transition;
+        }
+    }
+
+    return count;
 }
 
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
@@ -133091,21 +131017,20 @@ utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 /**
- * @brief Set the flags for an automaton
+ * @brief Check if a transition matches a character
  *
- * @param automaton The automaton
- * @param flags The flags to set
- * @return true if successful, false otherwise
+ * @param transition The transition to check
+ * @param c The character to check
+ * @return true if the transition matches the character, false otherwise
  */
 bool
-rift_automaton_set_flags(rift_regex_automaton_t *automaton, rift_regex_flags_t flags)
+rift_automaton_transition_matches(rift_regex_transition_t *transition, char c)
 {
-    if (!automaton) {
+    if (!transition) {
         return false;
     }
 
-    automaton->flags = flags;
-    return true;
+    return rift_transition_matches_char(transition, c);
 }
 
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
@@ -135153,19 +133078,21 @@ utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 /**
- * @brief Get the flags of an automaton
+ * @brief Set the flags for an automaton
  *
  * @param automaton The automaton
- * @return The automaton flags
+ * @param flags The flags to set
+ * @return true if successful, false otherwise
  */
-rift_regex_flags_t
-rift_automaton_get_flags(const rift_regex_automaton_t *automaton)
+bool
+rift_automaton_set_flags(rift_regex_automaton_t *automaton, rift_regex_flags_t flags)
 {
     if (!automaton) {
-        return RIFT_REGEX_FLAG_NONE;
+        return false;
     }
 
-    return automaton->flags;
+    automaton->flags = flags;
+    return true;
 }
 
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
@@ -137213,29 +135140,19 @@ utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 /**
- * @brief Get the last error from an automaton
+ * @brief Get the flags of an automaton
  *
  * @param automaton The automaton
- * @param error Pointer to store the error
- * @return true if an error was found, false otherwise
+ * @return The automaton flags
  */
-bool
-rift_automaton_get_last_error(const rift_regex_automaton_t *automaton, rift_regex_error_t *error)
+rift_regex_flags_t
+rift_automaton_get_flags(const rift_regex_automaton_t *automaton)
 {
-    if (!automaton || !error) {
-        return false;
-    }
-
-    if (automaton->last_error.code == RIFT_REGEX_ERROR_NONE) {
-        return false;
+    if (!automaton) {
+        return RIFT_REGEX_FLAG_NONE;
     }
 
-    // Copy the error (not just a pointer assignment)
-    error->code = automaton->last_error.code;
-    strncpy(error->message, automaton->last_error.message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH - 1);
-    error->message[RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH - 1] = '\0';
-
-    return true;
+    return automaton->flags;
 }
 
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
@@ -139283,19 +137200,27 @@ utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 /**
- * @brief Clear the last error from an automaton
+ * @brief Get the last error from an automaton
  *
  * @param automaton The automaton
+ * @param error Pointer to store the error
+ * @return true if an error was found, false otherwise
  */
-void
-rift_automaton_clear_error(rift_regex_automaton_t *automaton)
+bool
+rift_automaton_get_last_error(const rift_regex_automaton_t *automaton, rift_regex_error_t *error)
 {
-    if (!automaton) {
-        return;
+    if (!automaton || !error) {
+        return false;
     }
 
-    automaton->last_error.code = RIFT_REGEX_ERROR_NONE;
-    automaton->last_error.message[0] = '\0';
+    if (automaton->last_error.code == RIFT_REGEX_ERROR_NONE) {
+        return false;
+    }
+
+    // Copy the error (not just a pointer assignment), with any message still to be formatted
+    rift_regex_error_copy(error, &automaton->last_error);
+
+    return true;
 }
 
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
@@ -141342,87 +139267,110 @@ utomaton/automaton.h"/a #include "core/automaton/state.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-/*
- * This helper function computes the set of states reachable from the given
- * states via epsilon transitions.
+/**
+ * @brief Get the epsilon closures of all states of an automaton
  *
- * @param nfa The NFA
- * @param states Array of states
- * @param num_states Number of states in the array
- * @param closure Output array for the closure states
- * @param closure_size Pointer to store the size of the closure
- * @return true if successful, false otherwise
+ * The cache is derived data, so it is filled in even through a const automaton.
+ *
+ * @param automaton The automaton
+ * @param error Pointer to store error information (can be NULL)
+ * @return The cached closures or NULL on failure
  */
-static bool
-compute_epsilon_closure(const rift_regex_automaton_t *nfa, rift_regex_state_t **states,
-                        size_t num_states, rift_regex_state_t **closure, size_t *closure_size)
+const struct rift_epsilon_closures *
+rift_automaton_get_epsilon_closures(const rift_regex_automaton_t *automaton,
+                                    rift_regex_error_t *error)
 {
-    if (!nfa || !states || !closure || !closure_size || num_states == 0) {
-        return false;
+    if (!automaton) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Null automaton provided");
+        }
+        return NULL;
     }
 
-    // Create a queue for the BFS
-    rift_regex_state_t **queue =
-        (rift_regex_state_t **)malloc(nfa->num_states * sizeof(rift_regex_state_t *));
-    if (!queue) {
-        return false;
+    rift_regex_automaton_t *cache_owner = (rift_regex_automaton_t *)automaton;
+    if (cache_owner->epsilon_closures &&
+        cache_owner->epsilon_closures->num_states != automaton->num_states) {
+        rift_automaton_invalidate_epsilon_closures(cache_owner);
     }
 
-    // Keep track of visited states
-    bool *visited = (bool *)calloc(nfa->num_states, sizeof(bool));
-    if (!visited) {
-        free(queue);
-        return false;
+    if (!cache_owner->epsilon_closures) {
+        cache_owner->epsilon_closures = rift_epsilon_closures_compute(automaton, error);
     }
 
-    // Initialize the queue with the starting states
-    size_t front = 0;
-    size_t back = 0;
-    for (size_t i = 0; i < num_states; i++) {
-        queue[back++] = states[i];
+    return cache_owner->epsilon_closures;
+}
 
-        // Mark the state as visited in the visited array
-        for (size_t j = 0; j < nfa->num_states; j++) {
-            if (nfa->states[j] == states[i]) {
-                visited[j] = true;
-                break;
-            }
-        }
+/**
+ * @brief Drop the cached epsilon closures of an automaton
+ *
+ * @param automaton The automaton
+ */
+void
+rift_automaton_invalidate_epsilon_closures(rift_regex_automaton_t *automaton)
+{
+    if (!automaton) {
+        return;
     }
 
-    // BFS to find all states reachable via epsilon transitions
-    size_t next_closure_index = 0;
-    while (front < back) {
-        rift_regex_state_t *current = queue[front++];
-        closure[next_closure_index++] = current;
+    rift_epsilon_closures_free(automaton->epsilon_closures);
+    automaton->epsilon_closures = NULL;
+}
 
-        // Process all epsilon transitions from the current state
-        size_t num_transitions = rift_state_get_transition_count(current);
-        for (size_t i = 0; i < num_transitions; i++) {
-            rift_regex_transition_t *transition = rift_state_get_transition(current, i);
-            if (!transition || !rift_transition_is_epsilon(transition)) {
-                continue;
-            }
+/**
+ * @brief Compute the epsilon closure of a set of states
+ *
+ * The per-state closures are precomputed, so this only unions their sorted
+ * member lists instead of following epsilon transitions again.
+ *
+ * @param automaton The automaton
+ * @param states The states to compute the closure for
+ * @param num_states Number of states in the input set
+ * @param closure Array of at least the automaton's state count for the closure states
+ * @param closure_size Pointer to store the number of states in the closure
+ * @return true if successful, false otherwise
+ */
+bool
+rift_automaton_compute_epsilon_closure(const rift_regex_automaton_t *automaton,
+                                       rift_regex_state_t *const *states, size_t num_states,
+                                       rift_regex_state_t **closure, size_t *closure_size)
+{
+    if (!automaton || !states || !closure || !closure_size || num_states == 0) {
+        return false;
+    }
 
-            rift_regex_state_t *target = rift_transition_get_target(transition);
-            if (!target) {
-                continue;
-            }
+    const rift_epsilon_closures_t *closures =
+        rift_automaton_get_epsilon_closures(automaton, NULL);
+    if (!closures) {
+        return false;
+    }
 
-            // Find the index of the target state in the NFA
-            for (size_t j = 0; j < nfa->num_states; j++) {
-                if (nfa->states[j] == target && !visited[j]) {
-                    visited[j] = true;
-                    queue[back++] = target;
-                    break;
-                }
-            }
+    // One block holds the input indices, the sorted union and the scratch bitset
+    size_t n = closures->num_states;
+    size_t words = closures->bitset_words;
+    uint64_t *scratch = (uint64_t *)calloc(words + n + 1, sizeof(uint64_t));
+    if (!scratch) {
+        return false;
+    }
+    uint32_t *indices = (uint32_t *)(scratch + words);
+    uint32_t *members = indices + n;
+
+    size_t num_indices = 0;
+    for (size_t i = 0; i < num_states && num_indices < n; i++) {
+        uint32_t index = rift_epsilon_closures_find_state(closures, states[i]);
+        if (index != RIFT_EPSILON_NO_STATE) {
+            indices[num_indices++] = index;
         }
     }
 
-    *closure_size = next_closure_index;
-    free(queue);
-    free(visited);
+    size_t count = rift_epsilon_closures_union(closures, indices, num_indices, scratch, members);
+    for (size_t i = 0; i < count; i++) {
+        closure[i] = automaton->states[members[i]];
+    }
+
+    *closure_size = count;
+    free(scratch);
     return true;
 }
 
@@ -143471,64 +141419,76 @@ utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 /**
- * @brief Find the next set of states reached from the given set via a specific input
- *
- * @param nfa The NFA
- * @param current_states Current set of states
- * @param num_current_states Number of states in the current set
- * @param input Input character
- * @param next_states Output array for the next states
- * @param num_next_states Pointer to store the number of next states
- * @return true if successful, false otherwise
+ * @brief Set the bit of a state in a subset bitset
  */
-static bool
-compute_next_states(const rift_regex_automaton_t *nfa, rift_regex_state_t **current_states,
-                    size_t num_current_states, char input, rift_regex_state_t **next_states,
-                    size_t *num_next_states)
+static void
+subset_add(uint64_t *bitset, uint32_t state)
 {
-    if (!nfa || !current_states || !next_states || !num_next_states || num_current_states == 0) {
-        return false;
-    }
+    bitset[state / 64] |= (uint64_t)1 << (state % 64);
+}
 
-    // Find all states reachable from the current set via the input character
-    size_t next_count = 0;
-    for (size_t i = 0; i < num_current_states; i++) {
-        rift_regex_state_t *current = current_states[i];
-        if (!current) {
+/**
+ * @brief List the states of a subset bitset in ascending order
+ *
+ * @param bitset The subset bitset
+ * @param words Number of words in the bitset
+ * @param states Output array for the state indices
+ * @return Number of states written
+ */
+static size_t
+subset_members(const uint64_t *bitset, size_t words, uint32_t *states)
+{
+    size_t count = 0;
+    for (size_t w = 0; w < words; w++) {
+        if (!bitset[w]) {
             continue;
         }
+        for (unsigned bit = 0; bit < 64; bit++) {
+            if (bitset[w] & ((uint64_t)1 << bit)) {
+                states[count++] = (uint32_t)(w * 64 + bit);
+            }
+        }
+    }
+    return count;
+}
 
+/**
+ * @brief Find the states reached from a subset via a specific input
+ *
+ * @param nfa The NFA
+ * @param closures Epsilon closures of the NFA
+ * @param states Sorted state indices of the current subset
+ * @param num_states Number of states in the current subset
+ * @param input Input character
+ * @param targets Set cleared and filled with the target state indices
+ * @return Number of targets
+ */
+static size_t
+compute_next_states(const rift_regex_automaton_t *nfa, const rift_epsilon_closures_t *closures,
+                    const uint32_t *states, size_t num_states, char input,
+                    rift_sparse_set_t *targets)
+{
+    rift_sparse_set_clear(targets);
+    for (size_t i = 0; i < num_states; i++) {
+        rift_regex_state_t *current = nfa->states[states[i]];
         size_t num_transitions = rift_state_get_transition_count(current);
+
         for (size_t j = 0; j < num_transitions; j++) {
             rift_regex_transition_t *transition = rift_state_get_transition(current, j);
-            if (!transition || rift_transition_is_epsilon(transition)) {
+            if (!transition || rift_transition_is_epsilon(transition) ||
+                !rift_transition_matches_char(transition, input)) {
                 continue;
             }
 
-            if (rift_transition_matches_char(transition, input)) {
-                rift_regex_state_t *target = rift_transition_get_target(transition);
-                if (!target) {
-                    continue;
-                }
-
-                // Add the target state to the next set if it's not already there
-                bool already_in_set = false;
-                for (size_t k = 0; k < next_count; k++) {
-                    if (next_states[k] == target) {
-                        already_in_set = true;
-                        break;
-                    }
-                }
-
-                if (!already_in_set) {
-                    next_states[next_count++] = target;
-                }
+            uint32_t target =
+                rift_epsilon_closures_find_state(closures, rift_transition_get_target(transition));
+            if (target != RIFT_EPSILON_NO_STATE) {
+                rift_sparse_set_insert(targets, target);
             }
         }
     }
 
-    *num_next_states = next_count;
-    return true;
+    return targets->count;
 }
 
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
@@ -145579,20 +143539,15 @@ utomaton/automaton.h"/a #include "core/errors/regex_error.h"
  * @brief Check if a DFA state subset is accepting
  *
  * @param nfa The original NFA
- * @param subset The subset of NFA states
- * @param subset_size The size of the subset
+ * @param states Sorted state indices of the subset
+ * @param num_states Number of states in the subset
  * @return true if any state in the subset is accepting, false otherwise
  */
 static bool
-is_subset_accepting(const rift_regex_automaton_t *nfa, rift_regex_state_t **subset,
-                    size_t subset_size)
+is_subset_accepting(const rift_regex_automaton_t *nfa, const uint32_t *states, size_t num_states)
 {
-    if (!nfa || !subset || subset_size == 0) {
-        return false;
-    }
-
-    for (size_t i = 0; i < subset_size; i++) {
-        if (rift_state_is_accepting(subset[i])) {
+    for (size_t i = 0; i < num_states; i++) {
+        if (rift_state_is_accepting(nfa->states[states[i]])) {
             return true;
         }
     }
@@ -145600,6 +143555,171 @@ is_subset_accepting(const rift_regex_automaton_t *nfa, rift_regex_state_t **subs
     return false;
 }
 
+/**
+ * @brief Create the DFA state of a subset
+ *
+ * The new state accepts if any member does and carries the union of the
+ * members' accept tags.
+ *
+ * @param dfa The DFA being built
+ * @param nfa The original NFA
+ * @param states Sorted state indices of the subset
+ * @param num_states Number of states in the subset
+ * @return The new state or NULL on failure
+ */
+static rift_regex_state_t *
+create_subset_state(rift_regex_automaton_t *dfa, const rift_regex_automaton_t *nfa,
+                    const uint32_t *states, size_t num_states)
+{
+    rift_regex_state_t *state =
+        rift_automaton_create_state(dfa, is_subset_accepting(nfa, states, num_states));
+    if (!state) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < num_states; i++) {
+        if (!rift_state_merge_accept_tags(state, nfa->states[states[i]])) {
+            return NULL;
+        }
+    }
+
+    return state;
+}
+
+/**
+ * @brief Mark the states of an automaton some match can pass through
+ *
+ * A state is live when the initial state reaches it and it reaches an
+ * accepting state, epsilon edges included. The edges are resolved to
+ * indices once and grouped by target, so both searches are linear in
+ * states and transitions. The initial state is always live.
+ *
+ * @param automaton The automaton
+ * @param live Array of num_states entries receiving the marks
+ * @return true if successful, false on allocation failure
+ */
+static bool
+mark_live_states(const rift_regex_automaton_t *automaton, bool *live)
+{
+    size_t n = automaton->num_states;
+    memset(live, 0, n * sizeof(bool));
+    size_t initial = rift_automaton_get_state_index(automaton, automaton->initial_state);
+    if (initial == RIFT_STATE_NO_ID) {
+        return true;
+    }
+
+    size_t num_edges = 0;
+    for (size_t i = 0; i < n; i++) {
+        num_edges += rift_state_get_transition_count(automaton->states[i]);
+    }
+
+    // Edge targets per source, the same edges per target, and a work queue
+    size_t *offsets = (size_t *)malloc((n + 1) * sizeof(size_t));
+    size_t *reverse_offsets = (size_t *)calloc(n + 1, sizeof(size_t));
+    uint32_t *targets = (uint32_t *)malloc((num_edges + 1) * sizeof(uint32_t));
+    uint32_t *sources = (uint32_t *)malloc((num_edges + 1) * sizeof(uint32_t));
+    uint32_t *queue = (uint32_t *)malloc(n * sizeof(uint32_t));
+    bool *reached = (bool *)calloc(n, sizeof(bool));
+    bool success = offsets && reverse_offsets && targets && sources && queue && reached;
+    if (!success) {
+        goto cleanup;
+    }
+
+    size_t edge = 0;
+    for (size_t i = 0; i < n; i++) {
+        offsets[i] = edge;
+        rift_regex_state_t *state = automaton->states[i];
+        size_t count = rift_state_get_transition_count(state);
+        for (size_t j = 0; j < count; j++) {
+            rift_regex_transition_t *transition = state->transitions[j];
+            size_t target = transition
+                                ? rift_automaton_get_state_index(automaton, transition->to_state)
+                                : RIFT_STATE_NO_ID;
+            if (target != RIFT_STATE_NO_ID) {
+                targets[edge++] = (uint32_t)target;
+                reverse_offsets[target]++;
+            }
+        }
+    }
+    offsets[n] = edge;
+
+    // Counts become end offsets, then placing each edge moves its target's offset to the start
+    for (size_t i = 1; i < n; i++) {
+        reverse_offsets[i] += reverse_offsets[i - 1];
+    }
+    reverse_offsets[n] = edge;
+    for (size_t i = 0; i < n; i++) {
+        for (size_t k = offsets[i]; k < offsets[i + 1]; k++) {
+            sources[--reverse_offsets[targets[k]]] = (uint32_t)i;
+        }
+    }
+
+    // Forward from the initial state
+    size_t head = 0;
+    size_t tail = 0;
+    reached[initial] = true;
+    queue[tail++] = (uint32_t)initial;
+    while (head < tail) {
+        uint32_t state = queue[head++];
+        for (size_t k = offsets[state]; k < offsets[state + 1]; k++) {
+            if (!reached[targets[k]]) {
+                reached[targets[k]] = true;
+                queue[tail++] = targets[k];
+            }
+        }
+    }
+
+    // Backward from the accepting states the forward search found
+    head = 0;
+    tail = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (reached[i] && rift_state_is_accepting(automaton->states[i])) {
+            live[i] = true;
+            queue[tail++] = (uint32_t)i;
+        }
+    }
+    while (head < tail) {
+        uint32_t state = queue[head++];
+        for (size_t k = reverse_offsets[state]; k < reverse_offsets[state + 1]; k++) {
+            uint32_t source = sources[k];
+            if (reached[source] && !live[source]) {
+                live[source] = true;
+                queue[tail++] = source;
+            }
+        }
+    }
+    live[initial] = true;
+
+cleanup:
+    free(offsets);
+    free(reverse_offsets);
+    free(targets);
+    free(sources);
+    free(queue);
+    free(reached);
+    return success;
+}
+
+/**
+ * @brief Drop the states no match passes through from a sorted subset
+ *
+ * @param live Live marks of the NFA states
+ * @param states Sorted state indices, filtered in place
+ * @param num_states Number of state indices
+ * @return Number of state indices kept
+ */
+static size_t
+filter_live_states(const bool *live, uint32_t *states, size_t num_states)
+{
+    size_t kept = 0;
+    for (size_t i = 0; i < num_states; i++) {
+        if (live[states[i]]) {
+            states[kept++] = states[i];
+        }
+    }
+    return kept;
+}
+
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
@@ -147644,41 +145764,6 @@ utomaton/automaton.h"/a #include "core/automaton/state.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-/**
- * @brief Compare two state subsets for equality
- *
- * @param subset1 The first subset
- * @param size1 The size of the first subset
- * @param subset2 The second subset
- * @param size2 The size of the second subset
- * @return true if the subsets contain the same states, false otherwise
- */
-static bool
-are_subsets_equal(rift_regex_state_t **subset1, size_t size1, rift_regex_state_t **subset2,
-                  size_t size2)
-{
-    if (size1 != size2) {
-        return false;
-    }
-
-    // Check if every state in subset1 is also in subset2
-    for (size_t i = 0; i < size1; i++) {
-        bool found = false;
-        for (size_t j = 0; j < size2; j++) {
-            if (subset1[i] == subset2[j]) {
-                found = true;
-                break;
-            }
-        }
-
-        if (!found) {
-            return false;
-        }
-    }
-
-    return true;
-}
-
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
@@ -149723,29 +147808,6 @@ utomaton/automaton.h"/a #include "core/automaton/state.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-/**
- * @brief Find the index of a subset in the subsets array
- *
- * @param subset The subset to find
- * @param subset_size The size of the subset
- * @param subsets Array of subsets
- * @param subset_sizes Array of subset sizes
- * @param num_subsets Number of subsets in the array
- * @return The index of the subset or -1 if not found
- */
-static int
-find_subset_index(rift_regex_state_t **subset, size_t subset_size, rift_regex_state_t ***subsets,
-                  size_t *subset_sizes, size_t num_subsets)
-{
-    for (size_t i = 0; i < num_subsets; i++) {
-        if (are_subsets_equal(subset, subset_size, subsets[i], subset_sizes[i])) {
-            return (int)i;
-        }
-    }
-
-    return -1;
-}
-
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
@@ -151794,6 +149856,7 @@ utomaton/automaton.h"/a #include "core/errors/regex_error.h"
  * @brief Convert an NFA to a DFA
  *
  * This function uses the subset construction algorithm to convert an NFA to an equivalent DFA.
+ * The DFA state budget is the RIFT_REGEX_PARAM_MAX_STATES configuration parameter.
  *
  * @param nfa The NFA to convert
  * @param error Pointer to store error code (can be NULL)
@@ -151801,6 +149864,29 @@ utomaton/automaton.h"/a #include "core/errors/regex_error.h"
  */
 rift_regex_automaton_t *
 rift_automaton_nfa_to_dfa(const rift_regex_automaton_t *nfa, rift_regex_error_t *error)
+{
+    size_t max_states = AUTOMATON_DEFAULT_DFA_STATE_BUDGET;
+    if (rift_config_get_regex_param(RIFT_REGEX_PARAM_MAX_STATES, &max_states) != RIFT_OK) {
+        max_states = AUTOMATON_DEFAULT_DFA_STATE_BUDGET;
+    }
+
+    return rift_automaton_nfa_to_dfa_limited(nfa, max_states, error);
+}
+
+/**
+ * @brief Convert an NFA to a DFA with an explicit state budget
+ *
+ * Subsets are canonical bitsets over NFA state indices, found through a hash table.
+ * Working memory grows with the number of DFA states actually discovered.
+ *
+ * @param nfa The NFA to convert
+ * @param max_states Maximum number of DFA states (0 for no limit)
+ * @param error Pointer to store error code (can be NULL)
+ * @return The equivalent DFA or NULL on failure
+ */
+rift_regex_automaton_t *
+rift_automaton_nfa_to_dfa_limited(const rift_regex_automaton_t *nfa, size_t max_states,
+                                  rift_regex_error_t *error)
 {
     if (!nfa) {
         if (error) {
@@ -151816,299 +149902,200 @@ rift_automaton_nfa_to_dfa(const rift_regex_automaton_t *nfa, rift_regex_error_t
         return rift_automaton_clone(nfa);
     }
 
-    // Create a new DFA
-    rift_regex_automaton_t *dfa = rift_automaton_create(RIFT_AUTOMATON_DFA);
-    if (!dfa) {
-        if (error) {
-            error->code = RIFT_REGEX_ERROR_MEMORY;
-            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH, "Failed to create DFA");
-        }
-        return NULL;
-    }
-
-    // Copy flags from the NFA
-    dfa->flags = nfa->flags;
-
-    // Initialize data structures for subset construction
-    rift_regex_state_t ***subsets =
-        (rift_regex_state_t ***)malloc(MAX_AUTOMATON_STATES * sizeof(rift_regex_state_t **));
-    if (!subsets) {
-        rift_automaton_free(dfa);
+    // A subset of states has no single input position to check a lookaround at
+    if (rift_automaton_has_lookarounds(nfa)) {
         if (error) {
-            error->code = RIFT_REGEX_ERROR_MEMORY;
+            error->code = RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE;
             snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
-                     "Failed to allocate memory for subsets");
+                     "Automata with lookarounds cannot be determinized");
         }
         return NULL;
     }
 
-    // Initialize each subset array
-    for (size_t i = 0; i < MAX_AUTOMATON_STATES; i++) {
-        subsets[i] = (rift_regex_state_t **)malloc(nfa->num_states * sizeof(rift_regex_state_t *));
-        if (!subsets[i]) {
-            for (size_t j = 0; j < i; j++) {
-                free(subsets[j]);
-            }
-            free(subsets);
-            rift_automaton_free(dfa);
-            if (error) {
-                error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
-                snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
-                         "Null automaton provided");
-            }
-            return NULL;
-        }
-    }
-
-    // Array to store the size of each subset
-    size_t *subset_sizes = (size_t *)calloc(MAX_AUTOMATON_STATES, sizeof(size_t));
-    if (!subset_sizes) {
-        for (size_t i = 0; i < MAX_AUTOMATON_STATES; i++) {
-            free(subsets[i]);
-        }
-        free(subsets);
-        rift_automaton_free(dfa);
-        if (error) {
-            error->code = RIFT_REGEX_ERROR_MEMORY;
-            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
-                     "Failed to allocate memory for subset sizes");
-        }
+    // Per-state epsilon closures, also the state pointer to index map
+    const rift_epsilon_closures_t *closures = rift_automaton_get_epsilon_closures(nfa, error);
+    if (!closures) {
         return NULL;
     }
 
-    // Array to map subsets to DFA states
-    rift_regex_state_t **dfa_states =
-        (rift_regex_state_t **)calloc(MAX_AUTOMATON_STATES, sizeof(rift_regex_state_t *));
-    if (!dfa_states) {
-        free(subset_sizes);
-        for (size_t i = 0; i < MAX_AUTOMATON_STATES; i++) {
-            free(subsets[i]);
-        }
-        free(subsets);
-        rift_automaton_free(dfa);
+    uint32_t initial_index = rift_epsilon_closures_find_state(closures, nfa->initial_state);
+    if (initial_index == RIFT_EPSILON_NO_STATE) {
         if (error) {
-            error->code = RIFT_REGEX_ERROR_MEMORY;
+            error->code = RIFT_REGEX_ERROR_INVALID_AUTOMATON;
             snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
-                     "Failed to allocate memory for DFA states");
+                     "NFA has no initial state");
         }
         return NULL;
     }
 
-    // Start with the epsilon closure of the NFA's initial state
-    rift_regex_state_t *initial_states[1] = {nfa->initial_state};
-    if (!compute_epsilon_closure(nfa, initial_states, 1, subsets[0], &subset_sizes[0])) {
-        free(dfa_states);
-        free(subset_sizes);
-        for (size_t i = 0; i < MAX_AUTOMATON_STATES; i++) {
-            free(subsets[i]);
-        }
-        free(subsets);
-        rift_automaton_free(dfa);
+    // Create a new DFA
+    rift_regex_automaton_t *dfa = rift_automaton_create(RIFT_AUTOMATON_DFA);
+    if (!dfa) {
         if (error) {
-            error->code = RIFT_REGEX_ERROR_INTERNAL;
-            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
-                     "Failed to compute epsilon closure");
+            error->code = RIFT_REGEX_ERROR_MEMORY;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH, "Failed to create DFA");
         }
         return NULL;
     }
 
-    // Create the initial DFA state
-    dfa_states[0] =
-        rift_automaton_create_state(dfa, is_subset_accepting(nfa, subsets[0], subset_sizes[0]));
+    // Copy flags from the NFA
+    dfa->flags = nfa->flags;
 
-    if (!dfa_states[0]) {
-        free(dfa_states);
-        free(subset_sizes);
-        for (size_t i = 0; i < MAX_AUTOMATON_STATES; i++) {
-            free(subsets[i]);
-        }
-        free(subsets);
+    // Partition the input alphabet into the classes the NFA can tell apart
+    rift_byte_classes_t classes;
+    if (!rift_byte_classes_compute(nfa, &classes, error)) {
         rift_automaton_free(dfa);
-        if (error) {
-            error->code = RIFT_REGEX_ERROR_MEMORY;
-            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
-                     "Failed to create initial DFA state");
-        }
         return NULL;
     }
 
-    // Start with one unmarked subset (the initial state)
-    size_t num_subsets = 1;
-    size_t current_subset = 0;
+    // Subsets keyed by bitset, numbered in discovery order
+    size_t n = closures->num_states;
+    rift_subset_table_t *table = rift_subset_table_create((uint32_t)n);
 
-    // Process all reachable subsets
-    if (!dfa_states) {
-        free(subset_sizes);
-        for (size_t i = 0; i < MAX_AUTOMATON_STATES; i++) {
-            free(subsets[i]);
-        }
-        free(subsets);
-        rift_automaton_free(dfa);
+    // Working memory: current and closure members, direct targets and two bitsets
+    size_t words = closures->bitset_words > 0 ? closures->bitset_words : 1;
+    uint32_t *members = (uint32_t *)malloc(2 * (n + 1) * sizeof(uint32_t));
+    uint64_t *bitsets = (uint64_t *)calloc(2 * words, sizeof(uint64_t));
+    bool *live = (bool *)malloc((n + 1) * sizeof(bool));
+    rift_sparse_set_t targets = {0};
+    bool have_targets = rift_sparse_set_init(&targets, (uint32_t)n);
+
+    // DFA states are created in subset order, so subset i is dfa->states[i]
+    bool success = false;
+    if (!table || !members || !bitsets || !live || !have_targets ||
+        !mark_live_states(nfa, live)) {
         if (error) {
             error->code = RIFT_REGEX_ERROR_MEMORY;
             snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
-                     "Failed to allocate memory for DFA states");
+                     "Failed to allocate memory for subset construction");
         }
-        return NULL;
+        goto cleanup;
     }
 
-    if (!compute_epsilon_closure(nfa, initial_states, 1, subsets[0], &subset_sizes[0])) {
-        free(dfa_states);
-        free(subset_sizes);
-        for (size_t i = 0; i < MAX_AUTOMATON_STATES; i++) {
-            free(subsets[i]);
-        }
-        free(subsets);
-        rift_automaton_free(dfa);
-        if (error) {
-            error->code = RIFT_REGEX_ERROR_INTERNAL;
-            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
-                     "Failed to compute epsilon closure");
-        }
-        return NULL;
+    uint32_t *next_members = members + (n + 1);
+    uint64_t *key = bitsets;
+    uint64_t *scratch = bitsets + words;
+
+    // Start with the epsilon closure of the NFA's initial state
+    // States no match passes through are left out of every subset
+    size_t num_members =
+        rift_epsilon_closures_union(closures, &initial_index, 1, scratch, next_members);
+    num_members = filter_live_states(live, next_members, num_members);
+    for (size_t i = 0; i < num_members; i++) {
+        subset_add(key, next_members[i]);
     }
+    rift_subset_table_insert(table, key, NULL);
+    memset(key, 0, words * sizeof(uint64_t));
 
     // Create the initial DFA state
-    dfa_states[0] =
-        rift_automaton_create_state(dfa, is_subset_accepting(nfa, subsets[0], subset_sizes[0]));
-    if (!dfa_states[0]) {
-        free(dfa_states);
-        free(subset_sizes);
-        for (size_t i = 0; i < MAX_AUTOMATON_STATES; i++) {
-            free(subsets[i]);
-        }
-        free(subsets);
-        rift_automaton_free(dfa);
+    if (table->count != 1 || !create_subset_state(dfa, nfa, next_members, num_members)) {
         if (error) {
             error->code = RIFT_REGEX_ERROR_MEMORY;
             snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
                      "Failed to create initial DFA state");
         }
-        return NULL;
+        goto cleanup;
     }
 
-    // Process all reachable subsets
-    while (current_subset < num_subsets) {
-        // Get the current subset
-        rift_regex_state_t **current_subset_states = subsets[current_subset];
-        size_t current_subset_size = subset_sizes[current_subset];
+    // Process subsets in the order they were discovered
+    for (uint32_t current_subset = 0; current_subset < table->count; current_subset++) {
+        // The table may move its storage on insert, so take the members out first
+        num_members = subset_members(rift_subset_table_get(table, current_subset), table->words,
+                                     members);
 
-        // Process all possible input characters
-        // For simplicity, we'll use ASCII characters 0-127
-        for (int c = 0; c < 128; c++) {
-            // Find the next set of states reached from the current subset via this character
-            rift_regex_state_t *direct_targets[MAX_AUTOMATON_STATES];
-            size_t num_direct_targets = 0;
-
-            if (!compute_next_states(nfa, current_subset_states, current_subset_size, (char)c,
-                                     direct_targets, &num_direct_targets)) {
-                continue; // Skip this character if no transitions
+        // Process one representative byte per input class
+        for (uint16_t k = 0; k < classes.num_classes; k++) {
+            // The class pattern becomes the label of the DFA transition
+            char pattern[RIFT_BYTE_CLASS_MAX_PATTERN_LENGTH];
+            if (rift_byte_classes_format_pattern(&classes, k, pattern, sizeof(pattern)) == 0) {
+                continue; // A class holding only NUL has no pattern form
             }
+            char c = (char)classes.representatives[k];
 
-            if (num_direct_targets == 0) {
+            // Find the states reached from the current subset via this character
+            size_t num_targets =
+                compute_next_states(nfa, closures, members, num_members, c, &targets);
+            if (num_targets == 0) {
                 continue; // Skip this character if no transitions
             }
 
             // Compute the epsilon closure of the direct targets
-            rift_regex_state_t *next_states[MAX_AUTOMATON_STATES];
-            size_t num_next_states = 0;
-
-            if (!compute_epsilon_closure(nfa, direct_targets, num_direct_targets, next_states,
-                                         &num_next_states)) {
-                continue; // Skip this character if unable to compute closure
+            size_t num_next = rift_epsilon_closures_union(closures, targets.dense, num_targets,
+                                                          scratch, next_members);
+            num_next = filter_live_states(live, next_members, num_next);
+            if (num_next == 0) {
+                continue; // Only dead states are reached
             }
-
-            if (num_next_states == 0) {
-                continue; // Skip this character if empty closure
+            for (size_t i = 0; i < num_next; i++) {
+                subset_add(key, next_members[i]);
             }
 
-            // Check if this subset already exists
-            int next_subset_index =
-                find_subset_index(next_states, num_next_states, subsets, subset_sizes, num_subsets);
+            // Find the subset or add it as a new DFA state
+            bool inserted = false;
+            uint32_t next_subset = rift_subset_table_insert(table, key, &inserted);
+            memset(key, 0, words * sizeof(uint64_t));
 
-            // If the subset doesn't exist, add it
-            if (next_subset_index == -1) {
-                // Check if we have reached the maximum number of states
-                if (num_subsets >= MAX_AUTOMATON_STATES) {
-                    free(dfa_states);
-                    free(subset_sizes);
-                    for (size_t i = 0; i < MAX_AUTOMATON_STATES; i++) {
-                        free(subsets[i]);
-                    }
-                    free(subsets);
-                    rift_automaton_free(dfa);
+            if (next_subset == RIFT_SUBSET_NOT_FOUND) {
+                if (error) {
+                    error->code = RIFT_REGEX_ERROR_MEMORY;
+                    snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                             "Failed to store DFA state subset");
+                }
+                goto cleanup;
+            }
+
+            if (inserted) {
+                // Stop once the DFA outgrows its state budget
+                if (max_states > 0 && table->count > max_states) {
                     if (error) {
                         error->code = RIFT_REGEX_ERROR_LIMIT_EXCEEDED;
                         snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
-                                 "Maximum number of DFA states exceeded");
+                                 "DFA exceeds the budget of %zu states", max_states);
                     }
-                    return NULL;
-                }
-
-                // Copy the next states to a new subset
-                for (size_t i = 0; i < num_next_states; i++) {
-                    subsets[num_subsets][i] = next_states[i];
+                    goto cleanup;
                 }
-                subset_sizes[num_subsets] = num_next_states;
 
                 // Create a new DFA state for this subset
-                bool is_accepting = is_subset_accepting(nfa, next_states, num_next_states);
-                dfa_states[num_subsets] = rift_automaton_create_state(dfa, is_accepting);
-                if (!dfa_states[num_subsets]) {
-                    free(dfa_states);
-                    free(subset_sizes);
-                    for (size_t i = 0; i < MAX_AUTOMATON_STATES; i++) {
-                        free(subsets[i]);
-                    }
-                    free(subsets);
-                    rift_automaton_free(dfa);
+                if (!create_subset_state(dfa, nfa, next_members, num_next)) {
                     if (error) {
                         error->code = RIFT_REGEX_ERROR_MEMORY;
                         snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
                                  "Failed to create DFA state");
                     }
-                    return NULL;
+                    goto cleanup;
                 }
-
-                next_subset_index = (int)num_subsets;
-                num_subsets++;
             }
 
             // Add a transition from the current state to the next state
-            char pattern[3] = {(char)c, '\0'};
-            if (!rift_automaton_add_transition(dfa, dfa_states[current_subset],
-                                               dfa_states[next_subset_index], pattern)) {
-                free(dfa_states);
-                free(subset_sizes);
-                for (size_t i = 0; i < MAX_AUTOMATON_STATES; i++) {
-                    free(subsets[i]);
-                }
-                free(subsets);
-                rift_automaton_free(dfa);
+            if (!rift_automaton_add_transition(dfa, dfa->states[current_subset],
+                                               dfa->states[next_subset], pattern)) {
                 if (error) {
                     error->code = RIFT_REGEX_ERROR_MEMORY;
                     snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
                              "Failed to add transition to DFA");
                 }
-                return NULL;
+                goto cleanup;
             }
         }
-
-        // Move to the next unmarked subset
-        current_subset++;
     }
 
-    // Free temporary data structures
-    free(dfa_states);
-    free(subset_sizes);
-    for (size_t i = 0; i < MAX_AUTOMATON_STATES; i++) {
-        free(subsets[i]);
-    }
-    free(subsets);
-
     // Set the deterministic flag
     dfa->is_deterministic = true;
+    // Classes leading to the same state become one transition
+    success = rift_automaton_optimize_transitions(dfa);
+
+cleanup:
+    // Free temporary data structures
+    free(live);
+    free(bitsets);
+    free(members);
+    rift_sparse_set_destroy(&targets);
+    rift_subset_table_free(table);
 
+    if (!success) {
+        rift_automaton_free(dfa);
+        return NULL;
+    }
     return dfa;
 }
 
@@ -154156,81 +152143,6 @@ utomaton/automaton.h"/a #include "core/automaton/state.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-/**
- * @brief Check if a state is reachable from the initial state of an automaton
- *
- * This is a helper function for rift_automaton_remove_unreachable_states
- *
- * @param automaton The automaton
- * @param state The state to check
- * @param visited Array of visited states
- * @return true if the state is reachable, false otherwise
- */
-static bool
-is_state_reachable(const rift_regex_automaton_t *automaton, const rift_regex_state_t *state,
-                   bool *visited)
-{
-    if (!automaton || !state || !visited) {
-        return false;
-    }
-
-    // Find the index of the state
-    size_t state_index = 0;
-    bool found = false;
-    for (size_t i = 0; i < automaton->num_states; i++) {
-        if (automaton->states[i] == state) {
-            state_index = i;
-            found = true;
-            break;
-        }
-    }
-
-    if (!found) {
-        return false; // State not in automaton
-    }
-
-    // Check if this state has already been visited
-    if (visited[state_index]) {
-        return true;
-    }
-
-    // Mark this state as visited
-    visited[state_index] = true;
-
-    // If this is the initial state, it's reachable
-    if (state == automaton->initial_state) {
-        return true;
-    }
-
-    // Check if this state can be reached from any other state
-    for (size_t i = 0; i < automaton->num_states; i++) {
-        rift_regex_state_t *source = automaton->states[i];
-
-        if (!source || source == state) {
-            continue;
-        }
-
-        // Check all transitions from the source state
-        size_t num_transitions = rift_state_get_transition_count(source);
-        for (size_t j = 0; j < num_transitions; j++) {
-            rift_regex_transition_t *transition = rift_state_get_transition(source, j);
-            if (!transition) {
-                continue;
-            }
-
-            if (rift_transition_get_target(transition) == state) {
-                // This state can be reached from source, check if source is reachable
-                if (visited[i] || is_state_reachable(automaton, source, visited)) {
-                    return true;
-                }
-            }
-        }
-    }
-
-    // State is not reachable
-    return false;
-}
-
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
@@ -156276,128 +154188,85 @@ utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 /**
- * @brief Remove unreachable states from an automaton
+ * @brief Remove the states no match can pass through
+ *
+ * States the initial state does not reach and states that reach no
+ * accepting state are found in one pass over the edges and deleted
+ * together, with the edges into them. The remaining states keep their
+ * order, closing the gaps in automaton->states. The initial state is
+ * always kept.
  *
  * @param automaton The automaton to process
- * @return The number of states removed
+ * @return true if successful, false on invalid parameters or allocation failure
  */
-size_t
+bool
 rift_automaton_remove_unreachable_states(rift_regex_automaton_t *automaton)
 {
-    if (!automaton || automaton->num_states == 0) {
-        return 0;
+    if (!automaton) {
+        return false;
     }
 
-    // Create an array to track reachable states
-    bool *reachable = (bool *)calloc(automaton->num_states, sizeof(bool));
-    if (!reachable) {
-        return 0;
+    size_t n = automaton->num_states;
+    if (n == 0 || !automaton->initial_state) {
+        return true;
     }
 
-    // Mark the initial state as reachable
-    if (automaton->initial_state) {
-        size_t initial_index = 0;
-        for (size_t i = 0; i < automaton->num_states; i++) {
-            if (automaton->states[i] == automaton->initial_state) {
-                initial_index = i;
-                break;
-            }
-        }
-        reachable[initial_index] = true;
+    bool *live = (bool *)malloc(n * sizeof(bool));
+    if (!live || !mark_live_states(automaton, live)) {
+        free(live);
+        return false;
     }
 
-    // Perform a depth-first search from the initial state to mark all reachable states
-    bool *visited = (bool *)calloc(automaton->num_states, sizeof(bool));
-    if (!visited) {
-        free(reachable);
-        return 0;
+    size_t num_live = 0;
+    for (size_t i = 0; i < n; i++) {
+        num_live += live[i] ? 1 : 0;
+    }
+    if (num_live == n) {
+        free(live);
+        return true;
     }
 
-    for (size_t i = 0; i < automaton->num_states; i++) {
-        if (reachable[i]) {
-            // Clear the visited array
-            memset(visited, 0, automaton->num_states * sizeof(bool));
-
-            // Mark all states reachable from this state
-            rift_regex_state_t *state = automaton->states[i];
-            size_t num_transitions = rift_state_get_transition_count(state);
-
-            for (size_t j = 0; j < num_transitions; j++) {
-                rift_regex_transition_t *transition = rift_state_get_transition(state, j);
-                if (!transition) {
-                    continue;
-                }
-
-                rift_regex_state_t *target = rift_transition_get_target(transition);
-                if (!target) {
-                    continue;
-                }
-
-                // Find the index of the target state
-                for (size_t k = 0; k < automaton->num_states; k++) {
-                    if (automaton->states[k] == target) {
-                        reachable[k] = true;
-                        break;
-                    }
-                }
+    // Drop the edges into removed states, then the states themselves
+    for (size_t i = 0; i < n; i++) {
+        rift_regex_state_t *state = automaton->states[i];
+        if (!live[i] || !state) {
+            continue;
+        }
+        size_t kept = 0;
+        for (size_t j = 0; j < state->num_transitions; j++) {
+            rift_regex_transition_t *transition = state->transitions[j];
+            size_t target = transition
+                                ? rift_automaton_get_state_index(automaton, transition->to_state)
+                                : RIFT_STATE_NO_ID;
+            if (target != RIFT_STATE_NO_ID && !live[target]) {
+                rift_transition_free(transition);
+                continue;
             }
+            state->transitions[kept++] = transition;
         }
+        state->num_transitions = kept;
     }
 
-    free(visited);
-
-    // Count unreachable states and remove them
-    size_t num_removed = 0;
-    size_t i = 0;
-    while (i < automaton->num_states) {
-        if (!reachable[i]) {
-            // This state is unreachable, remove it
-            rift_regex_state_t *state = automaton->states[i];
-
-            // Remove any transitions to this state from other states
-            for (size_t j = 0; j < automaton->num_states; j++) {
-                if (j == i || !automaton->states[j]) {
-                    continue;
-                }
-
-                rift_regex_state_t *other_state = automaton->states[j];
-                size_t num_transitions = rift_state_get_transition_count(other_state);
-
-                for (size_t k = 0; k < num_transitions; k++) {
-                    rift_regex_transition_t *transition = rift_state_get_transition(other_state, k);
-                    if (!transition) {
-                        continue;
-                    }
-
-                    if (rift_transition_get_target(transition) == state) {
-                        rift_state_remove_transition(other_state, k);
-                        // Adjust the index since removing a transition shifts the array
-                        k--;
-                        num_transitions--;
-                    }
-                }
-            }
-
-            // Free the state
-            rift_state_free(state);
-
-            // Shift the remaining states down
-            memmove(&automaton->states[i], &automaton->states[i + 1],
-                    (automaton->num_states - i - 1) * sizeof(rift_regex_state_t *));
-
-            // Adjust the reachable array to match
-            memmove(&reachable[i], &reachable[i + 1],
-                    (automaton->num_states - i - 1) * sizeof(bool));
-
-            automaton->num_states--;
-            num_removed++;
-        } else {
-            i++;
+    size_t kept = 0;
+    for (size_t i = 0; i < n; i++) {
+        rift_regex_state_t *state = automaton->states[i];
+        if (live[i]) {
+            state->id = kept;
+            automaton->states[kept++] = state;
+            continue;
         }
+        if (automaton->current_state == state) {
+            automaton->current_state = automaton->initial_state;
+        }
+        rift_state_free(state);
     }
+    automaton->num_states = kept;
+
+    // State indices shifted, so the cached closures no longer apply
+    rift_automaton_invalidate_epsilon_closures(automaton);
 
-    free(reachable);
-    return num_removed;
+    free(live);
+    return true;
 }
 
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
@@ -158444,17 +156313,231 @@ utomaton/automaton.h"/a #include "core/automaton/state.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
 utomaton/automaton.h"/a #include "core/automaton/transition.h"
 utomaton/automaton.h"/a #include "core/errors/regex_error.h"
-/*
+/**
+ * @brief Check whether a transition is a plain byte edge that can be merged
+ *
+ * Epsilon edges and edges bound to a pattern keep their place. Edges taking
+ * NUL do too, as NUL has no pattern form.
+ *
+ * @param transition The transition
+ * @return true if the transition can be merged with others
+ */
+static bool
+is_mergeable_transition(const rift_regex_transition_t *transition)
+{
+    return transition && !transition->is_epsilon && !transition->pattern &&
+           !(transition->predicate.bitmap[0] & 1);
+}
+
+/**
+ * @brief Check whether a transition accepts a byte of a 256-bit set
+ */
+static bool
+transition_overlaps(const rift_regex_transition_t *transition, const uint64_t *bytes)
+{
+    const uint64_t *bitmap = transition->predicate.bitmap;
+    return ((bitmap[0] & bytes[0]) | (bitmap[1] & bytes[1]) | (bitmap[2] & bytes[2]) |
+            (bitmap[3] & bytes[3])) != 0;
+}
+
+/**
+ * @brief Get the lowest byte a transition accepts, 256 for none
+ */
+static int
+transition_lowest_byte(const rift_regex_transition_t *transition)
+{
+    for (int w = 0; w < 4; w++) {
+        uint64_t word = transition->predicate.bitmap[w];
+        if (word) {
+            return w * 64 + __builtin_ctzll(word);
+        }
+    }
+    return 256;
+}
+
+/**
+ * @brief Merge the later byte edges of a state into an earlier one to the same target
+ *
+ * Edge k joins edge j when both are plain byte edges with the same target and
+ * priority, no epsilon edge lies between them, and no edge left between them
+ * accepts a byte of edge k: only then is moving k's bytes ahead of those
+ * edges invisible to a search trying the edges in order.
+ *
+ * @param state The state
+ * @param j Index of the edge merged into
+ * @param absorbed Scratch array of num_transitions entries
+ * @return true if edges were merged
+ */
+static bool
+merge_transitions_into(rift_regex_state_t *state, size_t j, size_t *absorbed)
+{
+    rift_regex_transition_t *first = state->transitions[j];
+    uint64_t bytes[4];
+    uint64_t passed[4] = {0};
+    memcpy(bytes, first->predicate.bitmap, sizeof(bytes));
+
+    size_t count = 0;
+    for (size_t k = j + 1; k < state->num_transitions; k++) {
+        rift_regex_transition_t *transition = state->transitions[k];
+        if (!transition || transition->is_epsilon) {
+            break;
+        }
+        if (is_mergeable_transition(transition) && transition->to_state == first->to_state &&
+            transition->priority == first->priority && !transition_overlaps(transition, passed)) {
+            for (int w = 0; w < 4; w++) {
+                bytes[w] |= transition->predicate.bitmap[w];
+            }
+            absorbed[count++] = k;
+            continue;
+        }
+        for (int w = 0; w < 4; w++) {
+            passed[w] |= transition->predicate.bitmap[w];
+        }
+    }
+    if (count == 0) {
+        return false;
+    }
+
+    uint32_t set[RIFT_BYTE_SET_WORDS];
+    for (int w = 0; w < 4; w++) {
+        set[2 * w] = (uint32_t)bytes[w];
+        set[2 * w + 1] = (uint32_t)(bytes[w] >> 32);
+    }
+    char pattern[RIFT_BYTE_CLASS_MAX_PATTERN_LENGTH];
+    rift_regex_transition_t *merged = NULL;
+    if (rift_byte_set_format_pattern(set, pattern, sizeof(pattern)) > 0) {
+        merged = rift_transition_create(state, first->to_state, pattern);
+    }
+
+    // Keep the edges as they are unless the pattern parses back to the same bytes
+    if (!merged || memcmp(merged->predicate.bitmap, bytes, sizeof(bytes)) != 0) {
+        if (merged) {
+            rift_transition_free(merged);
+        }
+        return false;
+    }
+
+    merged->priority = first->priority;
+    rift_transition_free(first);
+    state->transitions[j] = merged;
+    for (size_t i = 0; i < count; i++) {
+        rift_transition_free(state->transitions[absorbed[i]]);
+        state->transitions[absorbed[i]] = NULL;
+    }
+
+    size_t kept = j + 1;
+    for (size_t k = j + 1; k < state->num_transitions; k++) {
+        if (state->transitions[k]) {
+            state->transitions[kept++] = state->transitions[k];
+        }
+    }
+    state->num_transitions = kept;
+    return true;
+}
+
+/**
+ * @brief Sort runs of disjoint byte edges of a state by their lowest byte
+ *
+ * At most one edge of such a run accepts any byte, so their order is not
+ * observable. Runs end at epsilon edges and at edges sharing a byte with
+ * the run; the edges of a DFA state form a single run.
+ *
+ * @param state The state
+ * @return true if edges moved
+ */
+static bool
+sort_transition_runs(rift_regex_state_t *state)
+{
+    bool moved = false;
+    size_t start = 0;
+    while (start < state->num_transitions) {
+        uint64_t run[4] = {0};
+        size_t end = start;
+        while (end < state->num_transitions) {
+            rift_regex_transition_t *transition = state->transitions[end];
+            if (!transition || transition->is_epsilon || transition_overlaps(transition, run)) {
+                break;
+            }
+            for (int w = 0; w < 4; w++) {
+                run[w] |= transition->predicate.bitmap[w];
+            }
+            end++;
+        }
+
+        // Insertion sort: runs are short or, from subset construction, nearly sorted
+        for (size_t i = start + 1; i < end; i++) {
+            rift_regex_transition_t *transition = state->transitions[i];
+            int lowest = transition_lowest_byte(transition);
+            size_t k = i;
+            while (k > start && transition_lowest_byte(state->transitions[k - 1]) > lowest) {
+                state->transitions[k] = state->transitions[k - 1];
+                k--;
+            }
+            if (k != i) {
+                state->transitions[k] = transition;
+                moved = true;
+            }
+        }
+        start = end > start ? end : start + 1;
+    }
+    return moved;
+}
+
+/**
+ * @brief Normalize the byte transitions of every state
+ *
+ * Byte edges to the same target are merged into one edge over the union of
+ * their bytes, such as the edges per byte class that subset construction
+ * emits, and runs of edges accepting disjoint bytes are sorted by their
+ * lowest byte. Merges and moves that could change which edge a search
+ * tries first for some byte are not made.
+ *
+ * @param automaton The automaton to optimize
+ * @return true if successful, false otherwise
  */
 bool
 rift_automaton_optimize_transitions(rift_regex_automaton_t *automaton)
 {
-    // Placeholder for transition table optimization
     if (!automaton) {
         return false;
     }
 
-    // For now, just return success
+    size_t max_transitions = 0;
+    for (size_t i = 0; i < automaton->num_states; i++) {
+        size_t count = rift_state_get_transition_count(automaton->states[i]);
+        max_transitions = count > max_transitions ? count : max_transitions;
+    }
+    if (max_transitions < 2) {
+        return true;
+    }
+
+    size_t *absorbed = (size_t *)malloc(max_transitions * sizeof(size_t));
+    if (!absorbed) {
+        return false;
+    }
+
+    bool changed = false;
+    for (size_t i = 0; i < automaton->num_states; i++) {
+        rift_regex_state_t *state = automaton->states[i];
+        if (!state) {
+            continue;
+        }
+        for (size_t j = 0; j + 1 < state->num_transitions; j++) {
+            if (is_mergeable_transition(state->transitions[j]) &&
+                merge_transitions_into(state, j, absorbed)) {
+                changed = true;
+            }
+        }
+        if (sort_transition_runs(state)) {
+            changed = true;
+        }
+    }
+    free(absorbed);
+
+    // Cached closures refer to the transitions of the states
+    if (changed) {
+        rift_automaton_invalidate_epsilon_closures(automaton);
+    }
     return true;
 }
 
@@ -162589,6 +160672,12 @@ rift_automaton_clone(const rift_regex_automaton_t *automaton)
     clone->flags = automaton->flags;
     clone->is_deterministic = automaton->is_deterministic;
 
+    // Cloned states keep their lookaround indices, so the table comes along
+    if (!rift_automaton_copy_lookarounds(clone, automaton)) {
+        rift_automaton_free(clone);
+        return NULL;
+    }
+
     // Create a mapping from original states to cloned states
     rift_regex_state_t **state_map =
         (rift_regex_state_t **)malloc(automaton->num_states * sizeof(rift_regex_state_t *));
@@ -162631,66 +160720,51 @@ rift_automaton_clone(const rift_regex_automaton_t *automaton)
         }
     }
 
+    // Freeze the source so every target is found by index instead of by a
+    // linear search over all states
+    rift_frozen_automaton_t *frozen = rift_frozen_automaton_create(automaton, NULL);
+    if (!frozen) {
+        free(state_map);
+        rift_automaton_free(clone);
+        return NULL;
+    }
+
     // Clone all transitions
-    for (size_t i = 0; i < automaton->num_states; i++) {
-        rift_regex_state_t *orig_state = automaton->states[i];
+    for (uint32_t i = 0; i < frozen->num_states; i++) {
         rift_regex_state_t *cloned_state = state_map[i];
 
-        size_t num_transitions = rift_state_get_transition_count(orig_state);
-        for (size_t j = 0; j < num_transitions; j++) {
-            rift_regex_transition_t *transition = rift_state_get_transition(orig_state, j);
-            if (!transition) {
-                continue;
-            }
+        for (uint32_t e = frozen->edge_offsets[i]; e < frozen->edge_offsets[i + 1]; e++) {
+            rift_regex_state_t *cloned_target = state_map[frozen->edge_targets[e]];
+            bool added;
 
-            rift_regex_state_t *orig_target = rift_transition_get_target(transition);
-            if (!orig_target) {
-                continue;
-            }
-
-            // Find the target's index in the original automaton
-            size_t target_index = 0;
-            bool found = false;
-            for (size_t k = 0; k < automaton->num_states; k++) {
-                if (automaton->states[k] == orig_target) {
-                    target_index = k;
-                    found = true;
-                    break;
-                }
+            if (rift_frozen_automaton_edge_is_epsilon(frozen, e)) {
+                added = rift_state_add_epsilon_transition(cloned_state, cloned_target);
+            } else {
+                const char *pattern = rift_frozen_automaton_get_edge_pattern(frozen, e);
+                added = pattern && rift_state_add_transition(cloned_state, cloned_target, pattern);
             }
 
-            if (!found) {
-                for (size_t k = 0; k < automaton->num_states; k++) {
-                    rift_state_free(state_map[k]);
-                }
+            if (!added) {
+                rift_frozen_automaton_free(frozen);
                 free(state_map);
                 rift_automaton_free(clone);
                 return NULL;
             }
+        }
+    }
 
-            // Get the cloned target
-            rift_regex_state_t *cloned_target = state_map[target_index];
+    rift_frozen_automaton_free(frozen);
 
-            // Add the transition to the cloned state
-            if (rift_transition_is_epsilon(transition)) {
-                if (!rift_state_add_epsilon_transition(cloned_state, cloned_target)) {
-                    for (size_t k = 0; k < automaton->num_states; k++) {
-                        rift_state_free(state_map[k]);
-                    }
-                    free(state_map);
-                    rift_automaton_free(clone);
-                    return NULL;
-                }
-            } else {
-                const char *pattern = rift_transition_get_pattern(transition);
-                if (!pattern || !rift_state_add_transition(cloned_state, cloned_target, pattern)) {
-                    for (size_t k = 0; k < automaton->num_states; k++) {
-                        rift_state_free(state_map[k]);
-                    }
-                    free(state_map);
-                    rift_automaton_free(clone);
-                    return NULL;
-                }
+    // A counted loop's step state refers to its start state, which has moved too
+    for (size_t i = 0; i < automaton->num_states; i++) {
+        const rift_regex_state_t *repeat_start = automaton->states[i]->repeat_start;
+        if (!repeat_start) {
+            continue;
+        }
+        for (size_t j = 0; j < automaton->num_states; j++) {
+            if (automaton->states[j] == repeat_start) {
+                state_map[i]->repeat_start = state_map[j];
+                break;
             }
         }
     }
@@ -171053,6 +169127,12 @@ rift_automaton_free(rift_regex_automaton_t *automaton)
     // Free the states array
     free(automaton->states);
 
+    // Free the cached epsilon closures
+    rift_epsilon_closures_free(automaton->epsilon_closures);
+
+    // Free the lookaround bodies
+    rift_automaton_free_lookarounds(automaton);
+
     // No need to free error message since it's an array, not dynamically allocated
 
     // Free the automaton structure itself
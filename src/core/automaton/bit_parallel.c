@@ -0,0 +1,404 @@
+/**
+ * @file bit_parallel.c
+ * @brief Implementation of the bit-parallel NFA simulation for the LibRift regex engine
+ *
+ * This file numbers the byte edges reachable from the start of a frozen NFA
+ * breadth first, so the edges of a concatenation get consecutive positions,
+ * and works out which positions follow each one through epsilon closures.
+ * Successors that are the next position or the position itself become the
+ * shift and loop masks; the rest go to follow tables indexed by eight
+ * positions at a time, built only for the chunks that need them.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/automaton/bit_parallel.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/automaton/frozen_automaton.h"
+#include "core/memory/memory.h"
+
+/**
+ * @brief Position entry of an edge that is not a position
+ */
+#define NO_POSITION UINT32_MAX
+
+/**
+ * @brief Working state of the construction
+ */
+typedef struct {
+    const rift_frozen_automaton_t *nfa;                /**< The frozen NFA */
+    uint32_t *position_of;                             /**< Position of each edge, or none */
+    uint32_t edges[RIFT_BIT_PARALLEL_MAX_POSITIONS];   /**< Edge of each position */
+    uint64_t follow[RIFT_BIT_PARALLEL_MAX_POSITIONS];  /**< Successors of each position */
+    uint32_t num_positions;                            /**< Positions numbered so far */
+    uint32_t *visited;                                 /**< Last closure that reached a state */
+    uint32_t generation;                               /**< Number of the current closure */
+    uint32_t *stack;                                   /**< Stack of the closure walk */
+} bit_parallel_builder_t;
+
+/**
+ * @brief Record an error of the construction
+ */
+static void
+set_error(rift_regex_error_t *error, rift_regex_error_code_t code, const char *message)
+{
+    if (error) {
+        error->code = code;
+        snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH, "%s", message);
+    }
+}
+
+/**
+ * @brief Find the position of an edge, numbering it if it has none yet
+ *
+ * Edges with the same target and pattern follow and accept the same bytes,
+ * so they share a position. In a Glushkov automaton, where every edge into a
+ * state reads the same pattern, positions are then the states.
+ *
+ * @param builder The builder
+ * @param edge The byte edge
+ * @return The position, or NO_POSITION if the positions do not fit in a word
+ */
+static uint32_t
+edge_position(bit_parallel_builder_t *builder, uint32_t edge)
+{
+    const rift_frozen_automaton_t *nfa = builder->nfa;
+    if (builder->position_of[edge] != NO_POSITION) {
+        return builder->position_of[edge];
+    }
+
+    const char *pattern = rift_frozen_automaton_get_edge_pattern(nfa, edge);
+    for (uint32_t p = 0; p < builder->num_positions; p++) {
+        uint32_t other = builder->edges[p];
+        const char *other_pattern = rift_frozen_automaton_get_edge_pattern(nfa, other);
+        if (nfa->edge_targets[other] == nfa->edge_targets[edge] && pattern && other_pattern &&
+            strcmp(pattern, other_pattern) == 0) {
+            builder->position_of[edge] = p;
+            return p;
+        }
+    }
+
+    if (builder->num_positions == RIFT_BIT_PARALLEL_MAX_POSITIONS) {
+        return NO_POSITION;
+    }
+    builder->edges[builder->num_positions] = edge;
+    builder->position_of[edge] = builder->num_positions++;
+    return builder->position_of[edge];
+}
+
+/**
+ * @brief Collect the positions leaving the epsilon closure of a state
+ *
+ * Edges not numbered yet get the next positions, in the order the closure
+ * reaches them.
+ *
+ * @param builder The builder
+ * @param state The NFA state
+ * @param positions Pointer to store the positions leaving the closure
+ * @param accepting Pointer to store whether the closure holds an accepting state
+ * @return true on success, false if the positions do not fit in a word
+ */
+static bool
+walk_closure(bit_parallel_builder_t *builder, uint32_t state, uint64_t *positions,
+             bool *accepting)
+{
+    const rift_frozen_automaton_t *nfa = builder->nfa;
+    size_t top = 0;
+
+    *positions = 0;
+    *accepting = false;
+    builder->generation++;
+    builder->stack[top++] = state;
+    while (top > 0) {
+        uint32_t current = builder->stack[--top];
+        if (builder->visited[current] == builder->generation) {
+            continue;
+        }
+        builder->visited[current] = builder->generation;
+        *accepting = *accepting || rift_frozen_automaton_is_accepting(nfa, current);
+
+        for (uint32_t e = nfa->edge_offsets[current]; e < nfa->edge_offsets[current + 1]; e++) {
+            if (nfa->edge_flags[e] & RIFT_FROZEN_EDGE_EPSILON) {
+                continue;
+            }
+            uint32_t position = edge_position(builder, e);
+            if (position == NO_POSITION) {
+                return false;
+            }
+            *positions |= (uint64_t)1 << position;
+        }
+
+        /* Push epsilon edges in reverse so the first is followed first */
+        for (uint32_t e = nfa->edge_offsets[current + 1]; e > nfa->edge_offsets[current]; e--) {
+            if (nfa->edge_flags[e - 1] & RIFT_FROZEN_EDGE_EPSILON) {
+                builder->stack[top++] = nfa->edge_targets[e - 1];
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Fill the masks and follow tables from the successors of every position
+ */
+static bool
+build_tables(bit_parallel_builder_t *builder, rift_bit_parallel_t *bit_parallel)
+{
+    const rift_frozen_automaton_t *nfa = builder->nfa;
+    uint32_t num_positions = builder->num_positions;
+    uint64_t other[RIFT_BIT_PARALLEL_MAX_POSITIONS];
+
+    for (uint32_t p = 0; p < num_positions; p++) {
+        uint64_t bit = (uint64_t)1 << p;
+        uint64_t next = p + 1 < RIFT_BIT_PARALLEL_MAX_POSITIONS ? bit << 1 : 0;
+        other[p] = builder->follow[p];
+        if (other[p] & next) {
+            bit_parallel->shift |= bit;
+            other[p] &= ~next;
+        }
+        if (other[p] & bit) {
+            bit_parallel->loop |= bit;
+            other[p] &= ~bit;
+        }
+
+        const rift_transition_predicate_t *predicate = &nfa->edge_predicates[builder->edges[p]];
+        for (int byte = 0; byte < 256; byte++) {
+            if (rift_transition_predicate_test(predicate, (uint8_t)byte)) {
+                bit_parallel->masks[byte] |= bit;
+            }
+        }
+    }
+
+    /* Only chunks with a position of other successors get a table */
+    uint32_t chunks[RIFT_BIT_PARALLEL_MAX_CHUNKS];
+    uint32_t num_chunks = 0;
+    for (uint32_t c = 0; c * RIFT_BIT_PARALLEL_CHUNK_BITS < num_positions; c++) {
+        for (uint32_t j = 0; j < RIFT_BIT_PARALLEL_CHUNK_BITS; j++) {
+            uint32_t p = c * RIFT_BIT_PARALLEL_CHUNK_BITS + j;
+            if (p < num_positions && other[p] != 0) {
+                chunks[num_chunks++] = c;
+                break;
+            }
+        }
+    }
+
+    bit_parallel->num_chunks = num_chunks;
+    if (num_chunks == 0) {
+        return true;
+    }
+    bit_parallel->tables = (uint64_t(*)[256])rift_calloc(num_chunks, sizeof(uint64_t[256]));
+    if (!bit_parallel->tables) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < num_chunks; i++) {
+        uint32_t base = chunks[i] * RIFT_BIT_PARALLEL_CHUNK_BITS;
+        bit_parallel->chunk_shifts[i] = (uint8_t)base;
+        for (uint32_t value = 1; value < 256; value++) {
+            /* Each entry adds the lowest bit's successors to an entry already filled */
+            uint32_t low = (uint32_t)__builtin_ctz(value);
+            uint64_t successors = base + low < num_positions ? other[base + low] : 0;
+            bit_parallel->tables[i][value] =
+                bit_parallel->tables[i][value & (value - 1)] | successors;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Free the working state of the construction
+ */
+static void
+builder_free(bit_parallel_builder_t *builder)
+{
+    rift_frozen_automaton_free((rift_frozen_automaton_t *)builder->nfa);
+    rift_free(builder->position_of);
+    rift_free(builder->visited);
+    rift_free(builder->stack);
+}
+
+/**
+ * @brief Build the bit-parallel simulation of an NFA under the tag already in use
+ *
+ * @param nfa The NFA
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new simulation or NULL on failure
+ */
+static rift_bit_parallel_t *
+create_bit_parallel(const rift_regex_automaton_t *nfa, rift_regex_error_t *error)
+{
+    if (!nfa) {
+        set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER, "Null automaton provided");
+        return NULL;
+    }
+
+    bit_parallel_builder_t builder = {0};
+    builder.nfa = rift_frozen_automaton_create(nfa, error);
+    if (!builder.nfa) {
+        return NULL;
+    }
+
+    const rift_frozen_automaton_t *frozen = builder.nfa;
+    if (frozen->start_state == RIFT_FROZEN_NO_STATE) {
+        set_error(error, RIFT_REGEX_ERROR_INVALID_AUTOMATON, "Automaton has no initial state");
+        builder_free(&builder);
+        return NULL;
+    }
+    if (frozen->num_lookarounds > 0 || frozen->num_counters > 0) {
+        set_error(error, RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE,
+                  "Lookarounds and counted loops cannot run bit-parallel");
+        builder_free(&builder);
+        return NULL;
+    }
+
+    rift_bit_parallel_t *bit_parallel =
+        (rift_bit_parallel_t *)rift_calloc(1, sizeof(rift_bit_parallel_t));
+    builder.position_of = (uint32_t *)rift_malloc(((size_t)frozen->num_edges + 1) *
+                                                  sizeof(uint32_t));
+    builder.visited = (uint32_t *)rift_calloc(frozen->num_states, sizeof(uint32_t));
+    builder.stack = (uint32_t *)rift_malloc(((size_t)frozen->num_edges + 1) * sizeof(uint32_t));
+    if (!bit_parallel || !builder.position_of || !builder.visited || !builder.stack) {
+        set_error(error, RIFT_REGEX_ERROR_MEMORY, "Failed to allocate bit-parallel simulation");
+        rift_bit_parallel_free(bit_parallel);
+        builder_free(&builder);
+        return NULL;
+    }
+    for (uint32_t e = 0; e < frozen->num_edges; e++) {
+        builder.position_of[e] = NO_POSITION;
+    }
+
+    /* New positions are appended as the closures of earlier ones reach them */
+    bool fits = walk_closure(&builder, frozen->start_state, &bit_parallel->first,
+                             &bit_parallel->accepts_empty);
+    for (uint32_t p = 0; fits && p < builder.num_positions; p++) {
+        bool accepting;
+        fits = walk_closure(&builder, frozen->edge_targets[builder.edges[p]], &builder.follow[p],
+                            &accepting);
+        if (accepting) {
+            bit_parallel->final |= (uint64_t)1 << p;
+        }
+    }
+    if (!fits) {
+        set_error(error, RIFT_REGEX_ERROR_LIMIT_EXCEEDED,
+                  "Automaton has too many positions to run bit-parallel");
+        rift_bit_parallel_free(bit_parallel);
+        builder_free(&builder);
+        return NULL;
+    }
+
+    bit_parallel->num_positions = builder.num_positions;
+    bool built = build_tables(&builder, bit_parallel);
+    builder_free(&builder);
+    if (!built) {
+        set_error(error, RIFT_REGEX_ERROR_MEMORY, "Failed to allocate bit-parallel tables");
+        rift_bit_parallel_free(bit_parallel);
+        return NULL;
+    }
+    return bit_parallel;
+}
+
+/**
+ * @brief Build the bit-parallel simulation of an NFA
+ *
+ * @param nfa The NFA (a DFA is accepted as well)
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new simulation or NULL on failure
+ */
+rift_bit_parallel_t *
+rift_bit_parallel_create(const rift_regex_automaton_t *nfa, rift_regex_error_t *error)
+{
+    rift_memory_tag_t outer = rift_memory_tag_use(RIFT_MEMORY_TAG_VM);
+    rift_bit_parallel_t *bit_parallel = create_bit_parallel(nfa, error);
+    rift_memory_tag_use(outer);
+    return bit_parallel;
+}
+
+/**
+ * @brief Free a bit-parallel simulation
+ *
+ * @param bit_parallel The simulation to free
+ */
+void
+rift_bit_parallel_free(rift_bit_parallel_t *bit_parallel)
+{
+    if (!bit_parallel) {
+        return;
+    }
+
+    rift_free(bit_parallel->tables);
+    rift_free(bit_parallel);
+}
+
+/**
+ * @brief Get the number of positions of a bit-parallel simulation
+ *
+ * @param bit_parallel The simulation
+ * @return Number of positions
+ */
+size_t
+rift_bit_parallel_get_position_count(const rift_bit_parallel_t *bit_parallel)
+{
+    return bit_parallel ? bit_parallel->num_positions : 0;
+}
+
+/**
+ * @brief Find a prefix of the input accepted by the automaton
+ *
+ * @param bit_parallel The simulation
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param earliest Whether to stop at the shortest accepted prefix instead of the longest
+ * @param match_end Pointer to store the length of the accepted prefix (can be NULL)
+ * @return true if a prefix (possibly empty) is accepted, false otherwise
+ */
+bool
+rift_bit_parallel_match_prefix(const rift_bit_parallel_t *bit_parallel, const char *input,
+                               size_t length, bool earliest, size_t *match_end)
+{
+    if (!bit_parallel || (!input && length > 0)) {
+        return false;
+    }
+
+    bool found = bit_parallel->accepts_empty;
+    size_t end = 0;
+    if (found && earliest) {
+        if (match_end) {
+            *match_end = 0;
+        }
+        return true;
+    }
+
+    /* Before the first byte, the start state's closure stands for every active position */
+    uint64_t active = 0;
+    for (size_t pos = 0; pos < length; pos++) {
+        uint64_t next;
+        if (pos == 0) {
+            next = bit_parallel->first;
+        } else {
+            next = ((active & bit_parallel->shift) << 1) | (active & bit_parallel->loop);
+            for (uint32_t i = 0; i < bit_parallel->num_chunks; i++) {
+                next |= bit_parallel->tables[i][(active >> bit_parallel->chunk_shifts[i]) & 0xff];
+            }
+        }
+
+        active = next & bit_parallel->masks[(uint8_t)input[pos]];
+        if (active == 0) {
+            break;
+        }
+        if (active & bit_parallel->final) {
+            found = true;
+            end = pos + 1;
+            if (earliest) {
+                break;
+            }
+        }
+    }
+
+    if (found && match_end) {
+        *match_end = end;
+    }
+    return found;
+}
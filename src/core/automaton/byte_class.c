@@ -0,0 +1,419 @@
+/**
+ * @file byte_class.c
+ * @brief Implementation of byte equivalence classes for the LibRift regex engine
+ *
+ * This file implements partition refinement over the byte alphabet, the
+ * conversion of a class back into a transition pattern and scans of the
+ * input for members of a byte set.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/automaton/byte_class.h"
+#include <stdio.h>
+#include <string.h>
+#include "core/automaton/state.h"
+#include "core/automaton/transition.h"
+#ifdef RIFT_BYTE_SCAN_SIMD128
+#include <wasm_simd128.h>
+#endif
+
+/**
+ * @brief Recompute the representative byte of every class
+ *
+ * @param classes The partition to update
+ */
+static void
+update_representatives(rift_byte_classes_t *classes)
+{
+    bool seen[RIFT_BYTE_CLASS_ALPHABET_SIZE] = {false};
+
+    /* Scan from byte 1 so NUL is only chosen when it is alone in its class */
+    for (int c = 1; c < RIFT_BYTE_CLASS_ALPHABET_SIZE; c++) {
+        uint8_t class_index = classes->map[c];
+        if (!seen[class_index]) {
+            seen[class_index] = true;
+            classes->representatives[class_index] = (uint8_t)c;
+        }
+    }
+
+    if (!seen[classes->map[0]]) {
+        classes->representatives[classes->map[0]] = 0;
+    }
+}
+
+/**
+ * @brief Initialize a partition with a single class containing every byte
+ *
+ * @param classes The partition to initialize
+ */
+void
+rift_byte_classes_init(rift_byte_classes_t *classes)
+{
+    if (!classes) {
+        return;
+    }
+
+    memset(classes, 0, sizeof(rift_byte_classes_t));
+    classes->num_classes = 1;
+    classes->representatives[0] = 1;
+}
+
+/**
+ * @brief Split classes so that members of a byte set are separated from non-members
+ *
+ * Class indices are renumbered in order of their smallest byte, so the result
+ * does not depend on the order in which refinements are applied.
+ *
+ * @param classes The partition to refine
+ * @param members Membership flag for every byte
+ */
+void
+rift_byte_classes_refine(rift_byte_classes_t *classes,
+                         const bool members[RIFT_BYTE_CLASS_ALPHABET_SIZE])
+{
+    if (!classes || !members) {
+        return;
+    }
+
+    /* Each (old class, membership) pair becomes a class of its own */
+    int16_t remap[RIFT_BYTE_CLASS_ALPHABET_SIZE * 2];
+    memset(remap, 0xff, sizeof(remap));
+
+    uint16_t next_class = 0;
+    for (int c = 0; c < RIFT_BYTE_CLASS_ALPHABET_SIZE; c++) {
+        size_t key = (size_t)classes->map[c] * 2 + (members[c] ? 1 : 0);
+        if (remap[key] < 0) {
+            remap[key] = (int16_t)next_class++;
+        }
+        classes->map[c] = (uint8_t)remap[key];
+    }
+
+    classes->num_classes = next_class;
+    update_representatives(classes);
+}
+
+/**
+ * @brief Compute the byte classes distinguished by an automaton
+ *
+ * @param automaton The automaton to analyze
+ * @param classes Pointer to store the partition
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+bool
+rift_byte_classes_compute(const rift_regex_automaton_t *automaton, rift_byte_classes_t *classes,
+                          rift_regex_error_t *error)
+{
+    if (!automaton || !classes) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Invalid parameters for byte class computation");
+        }
+        return false;
+    }
+
+    rift_byte_classes_init(classes);
+
+    for (size_t i = 0; i < automaton->num_states; i++) {
+        const rift_regex_state_t *state = automaton->states[i];
+        size_t num_transitions = rift_state_get_transition_count(state);
+
+        for (size_t j = 0; j < num_transitions; j++) {
+            const rift_regex_transition_t *transition = rift_state_get_transition(state, j);
+            if (!transition || rift_transition_is_epsilon(transition)) {
+                continue;
+            }
+
+            bool members[RIFT_BYTE_CLASS_ALPHABET_SIZE];
+            for (int c = 0; c < RIFT_BYTE_CLASS_ALPHABET_SIZE; c++) {
+                members[c] = rift_transition_matches_char(transition, (char)c);
+            }
+            rift_byte_classes_refine(classes, members);
+
+            /* Every byte is already distinguished, further splits are no-ops */
+            if (classes->num_classes == RIFT_BYTE_CLASS_ALPHABET_SIZE) {
+                return true;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Get the class index of a byte
+ *
+ * @param classes The partition
+ * @param byte The byte
+ * @return The class index
+ */
+uint8_t
+rift_byte_classes_get(const rift_byte_classes_t *classes, uint8_t byte)
+{
+    return classes ? classes->map[byte] : 0;
+}
+
+/**
+ * @brief Check whether a byte must be escaped outside a bracket expression
+ */
+static bool
+is_ere_special(int c)
+{
+    return c != '\0' && strchr(".[]()*+?{}|^$\\", c) != NULL;
+}
+
+/**
+ * @brief Check whether a byte needs a fixed position inside a bracket expression
+ */
+static bool
+is_bracket_special(int c)
+{
+    return c == ']' || c == '^' || c == '-' || c == '[';
+}
+
+/**
+ * @brief Check whether two bytes can be joined by a bracket range
+ *
+ * Ranges are only emitted inside digits and ASCII letters, where their meaning
+ * does not depend on the collation order of the current locale.
+ */
+static bool
+is_range_safe(int a, int b)
+{
+    return (a >= '0' && b <= '9') || (a >= 'A' && b <= 'Z') || (a >= 'a' && b <= 'z');
+}
+
+/**
+ * @brief Format a set of bytes as a transition pattern
+ *
+ * @param members Membership flag for every byte, NUL ignored
+ * @param buffer Output buffer of at least RIFT_BYTE_CLASS_MAX_PATTERN_LENGTH bytes
+ * @return Length of the pattern, or 0 if the set has no printable pattern
+ */
+static size_t
+format_members(const bool *members, char *buffer)
+{
+    size_t count = 0;
+    int single = 0;
+    for (int c = 1; c < RIFT_BYTE_CLASS_ALPHABET_SIZE; c++) {
+        if (members[c]) {
+            single = c;
+            count++;
+        }
+    }
+
+    size_t pos = 0;
+    if (count == 0) {
+        buffer[0] = '\0';
+        return 0;
+    }
+
+    if (count == 1) {
+        if (is_ere_special(single)) {
+            buffer[pos++] = '\\';
+        }
+        buffer[pos++] = (char)single;
+        buffer[pos] = '\0';
+        return pos;
+    }
+
+    /*
+     * Bracket layout: ']' first, then ordinary bytes and ranges, then '[', '^'
+     * and finally '-', so none of them takes on a special meaning.
+     */
+    buffer[pos++] = '[';
+    if (members[']']) {
+        buffer[pos++] = ']';
+    }
+
+    for (int c = 1; c < RIFT_BYTE_CLASS_ALPHABET_SIZE; c++) {
+        if (!members[c] || is_bracket_special(c)) {
+            continue;
+        }
+
+        int end = c;
+        while (end + 1 < RIFT_BYTE_CLASS_ALPHABET_SIZE && members[end + 1] &&
+               is_range_safe(c, end + 1)) {
+            end++;
+        }
+
+        buffer[pos++] = (char)c;
+        if (end - c >= 2) {
+            buffer[pos++] = '-';
+            buffer[pos++] = (char)end;
+            c = end;
+        }
+    }
+
+    if (members['[']) {
+        buffer[pos++] = '[';
+    }
+    if (members['^']) {
+        if (pos == 1) {
+            /* "[^" would negate the expression, lead with '-' instead */
+            buffer[pos++] = '-';
+            buffer[pos++] = '^';
+            buffer[pos++] = ']';
+            buffer[pos] = '\0';
+            return pos;
+        }
+        buffer[pos++] = '^';
+    }
+    if (members['-']) {
+        buffer[pos++] = '-';
+    }
+
+    buffer[pos++] = ']';
+    buffer[pos] = '\0';
+    return pos;
+}
+
+/**
+ * @brief Format a class as a transition pattern
+ *
+ * @param classes The partition
+ * @param class_index The class to format
+ * @param buffer Output buffer of at least RIFT_BYTE_CLASS_MAX_PATTERN_LENGTH bytes
+ * @param buffer_size Size of the output buffer
+ * @return Length of the pattern, or 0 if the class has no printable pattern
+ */
+size_t
+rift_byte_classes_format_pattern(const rift_byte_classes_t *classes, uint16_t class_index,
+                                 char *buffer, size_t buffer_size)
+{
+    if (!classes || !buffer || buffer_size < RIFT_BYTE_CLASS_MAX_PATTERN_LENGTH ||
+        class_index >= classes->num_classes) {
+        return 0;
+    }
+
+    bool members[RIFT_BYTE_CLASS_ALPHABET_SIZE];
+    for (int c = 0; c < RIFT_BYTE_CLASS_ALPHABET_SIZE; c++) {
+        members[c] = classes->map[c] == class_index;
+    }
+    return format_members(members, buffer);
+}
+
+/**
+ * @brief Format a byte set as a transition pattern
+ *
+ * @param set RIFT_BYTE_SET_WORDS words, bit c set for each member byte c
+ * @param buffer Output buffer of at least RIFT_BYTE_CLASS_MAX_PATTERN_LENGTH bytes
+ * @param buffer_size Size of the output buffer
+ * @return Length of the pattern, or 0 if the set has no printable pattern
+ */
+size_t
+rift_byte_set_format_pattern(const uint32_t *set, char *buffer, size_t buffer_size)
+{
+    if (!set || !buffer || buffer_size < RIFT_BYTE_CLASS_MAX_PATTERN_LENGTH) {
+        return 0;
+    }
+
+    bool members[RIFT_BYTE_CLASS_ALPHABET_SIZE];
+    for (int c = 0; c < RIFT_BYTE_CLASS_ALPHABET_SIZE; c++) {
+        members[c] = (set[c >> 5] >> (c & 31)) & 1;
+    }
+    return format_members(members, buffer);
+}
+
+/**
+ * @brief Check whether a byte belongs to a byte set
+ */
+static bool
+byte_set_has(const uint32_t *set, unsigned char c)
+{
+    return (set[c >> 5] >> (c & 31)) & 1;
+}
+
+#ifdef RIFT_BYTE_SCAN_SIMD128
+/**
+ * @brief Test 16 input bytes against a byte set
+ *
+ * Wasm memory is little-endian, so byte k of the set holds the members
+ * 8k .. 8k + 7. Each lane picks its set byte with two swizzles, one per
+ * half of the set (lanes out of a half's range read 0), then its bit.
+ *
+ * @param low Set bytes 0 to 15
+ * @param high Set bytes 16 to 31
+ * @param block The input bytes
+ * @return Mask with bit i set when byte i of the block is a member
+ */
+static uint32_t
+byte_set_mask16(v128_t low, v128_t high, v128_t block)
+{
+    const v128_t bits = wasm_i8x16_make(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+    v128_t index = wasm_u8x16_shr(block, 3);
+    v128_t high_index = wasm_i8x16_sub(index, wasm_i8x16_splat(16));
+    v128_t row =
+        wasm_v128_or(wasm_i8x16_swizzle(low, index), wasm_i8x16_swizzle(high, high_index));
+    v128_t bit = wasm_i8x16_swizzle(bits, wasm_v128_and(block, wasm_i8x16_splat(7)));
+    v128_t member = wasm_i8x16_ne(wasm_v128_and(row, bit), wasm_i8x16_splat(0));
+    return wasm_i8x16_bitmask(member);
+}
+#endif
+
+/**
+ * @brief Find the next input byte that belongs to a byte set
+ *
+ * @param set RIFT_BYTE_SET_WORDS words, bit c set for each member byte c
+ * @param input The input bytes
+ * @param start First position to consider
+ * @param end Position after the last one to consider
+ * @return Position of the byte or end if none belongs to the set
+ */
+size_t
+rift_byte_set_find(const uint32_t *set, const char *input, size_t start, size_t end)
+{
+    size_t pos = start;
+#ifdef RIFT_BYTE_SCAN_SIMD128
+    v128_t low = wasm_v128_load(set);
+    v128_t high = wasm_v128_load(set + 4);
+    for (; pos + 16 <= end; pos += 16) {
+        uint32_t mask = byte_set_mask16(low, high, wasm_v128_load(input + pos));
+        if (mask != 0) {
+            return pos + (size_t)__builtin_ctz(mask);
+        }
+    }
+#endif
+
+    for (; pos < end; pos++) {
+        if (byte_set_has(set, (unsigned char)input[pos])) {
+            return pos;
+        }
+    }
+    return end;
+}
+
+/**
+ * @brief Find the next input byte that does not belong to a byte set
+ *
+ * @param set RIFT_BYTE_SET_WORDS words, bit c set for each member byte c
+ * @param input The input bytes
+ * @param start First position to consider
+ * @param end Position after the last one to consider
+ * @return Position of the byte or end if all belong to the set
+ */
+size_t
+rift_byte_set_span(const uint32_t *set, const char *input, size_t start, size_t end)
+{
+    size_t pos = start;
+#ifdef RIFT_BYTE_SCAN_SIMD128
+    v128_t low = wasm_v128_load(set);
+    v128_t high = wasm_v128_load(set + 4);
+    for (; pos + 16 <= end; pos += 16) {
+        uint32_t mask = ~byte_set_mask16(low, high, wasm_v128_load(input + pos)) & 0xFFFF;
+        if (mask != 0) {
+            return pos + (size_t)__builtin_ctz(mask);
+        }
+    }
+#endif
+
+    for (; pos < end; pos++) {
+        if (!byte_set_has(set, (unsigned char)input[pos])) {
+            return pos;
+        }
+    }
+    return end;
+}
@@ -0,0 +1,895 @@
+/**
+ * @file compact_dfa.c
+ * @brief Implementation of the compressed DFA table forms for the LibRift regex engine
+ *
+ * Comb and default-chain layouts are packed the way Tarjan and Yao pack
+ * sparse tables: rows are placed from the one with the most stored cells
+ * down, each at the first offset where its cells fall into free slots, and
+ * the slots remember the row owning them so rows can share an offset.
+ *
+ * Every layout is built from a copy of the table whose rows are put in ID
+ * order first: the dead row, then the accepting rows, then the others, each
+ * group in its source order.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/automaton/compact_dfa.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/memory/memory.h"
+
+/**
+ * @brief Owner of a slot no row has taken
+ */
+#define COMB_FREE_SLOT UINT32_MAX
+
+/**
+ * @brief Offsets tried for a row, and slots below the last taken it searches from
+ */
+#define COMB_SEARCH_LIMIT 256
+
+/**
+ * @brief Preceding rows compared with a row when choosing its default
+ */
+#define DEFAULT_CANDIDATES 16
+
+/**
+ * @brief Cells of the rows a comb or default chain stores
+ */
+typedef struct comb_cells {
+    uint32_t *row_start; /**< First cell of each row, num_states + 1 entries */
+    uint8_t *classes;    /**< Byte class of each cell */
+    uint32_t *targets;   /**< Target of each cell */
+} comb_cells_t;
+
+/**
+ * @brief A row waiting to be placed, with its number of cells
+ */
+typedef struct comb_order {
+    uint32_t row;   /**< Row index */
+    uint32_t count; /**< Cells it stores */
+} comb_order_t;
+
+/**
+ * @brief Set the error of a failed allocation
+ *
+ * @param error Pointer to store error information (can be NULL)
+ */
+static void
+set_memory_error(rift_regex_error_t *error)
+{
+    if (error) {
+        error->code = RIFT_REGEX_ERROR_MEMORY;
+        snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                 "Failed to allocate compact DFA");
+    }
+}
+
+/**
+ * @brief Get a row of a dense table
+ */
+static inline const uint32_t *
+table_row(const rift_dfa_table_t *table, uint32_t row)
+{
+    return table->next + (size_t)row * table->num_classes;
+}
+
+/**
+ * @brief Count the runs of consecutive classes with the same target over every row
+ *
+ * @param table The dense table
+ * @return Number of runs
+ */
+static size_t
+count_runs(const rift_dfa_table_t *table)
+{
+    size_t runs = 0;
+    for (uint32_t row = 0; row < table->num_states; row++) {
+        const uint32_t *next = table_row(table, row);
+        runs++;
+        for (uint32_t k = 1; k < table->num_classes; k++) {
+            runs += next[k] != next[k - 1];
+        }
+    }
+    return runs;
+}
+
+/**
+ * @brief Count the cells of every row that are not dead
+ *
+ * @param table The dense table
+ * @return Number of live cells
+ */
+static size_t
+count_live_cells(const rift_dfa_table_t *table)
+{
+    size_t cells = (size_t)table->num_states * table->num_classes;
+    size_t live = 0;
+    for (size_t i = 0; i < cells; i++) {
+        live += table->next[i] != RIFT_DFA_DEAD_STATE;
+    }
+    return live;
+}
+
+/**
+ * @brief Get the memory used by the parts every layout has
+ *
+ * @param num_states Number of rows
+ * @return Size in bytes
+ */
+static size_t
+common_memory(uint32_t num_states)
+{
+    return sizeof(rift_compact_dfa_t) + (size_t)num_states * sizeof(uint32_t);
+}
+
+/**
+ * @brief Get the bytes per ID of the dense layout of a table
+ *
+ * @param num_states Number of rows
+ * @param num_classes Number of byte classes
+ * @return 1, 2 or 4, the narrowest width holding the largest premultiplied ID
+ */
+static uint8_t
+dense_width(uint32_t num_states, uint32_t num_classes)
+{
+    uint64_t largest = (uint64_t)(num_states - 1) * num_classes;
+    return largest <= UINT8_MAX ? 1 : largest <= UINT16_MAX ? 2 : 4;
+}
+
+/**
+ * @brief Copy a table with its rows in ID order
+ *
+ * @param table The dense table
+ * @param dfa The compact DFA, whose rows array and special_limit are filled
+ * @param ordered The table to fill, whose next array is allocated
+ * @return true if successful, false if memory ran out
+ */
+static bool
+order_rows(const rift_dfa_table_t *table, rift_compact_dfa_t *dfa, rift_dfa_table_t *ordered)
+{
+    uint32_t num_states = table->num_states;
+    uint32_t *position = (uint32_t *)rift_malloc(num_states * sizeof(uint32_t));
+    dfa->rows = (uint32_t *)rift_malloc(num_states * sizeof(uint32_t));
+    ordered->next = (uint32_t *)rift_malloc((size_t)num_states * table->num_classes *
+                                            sizeof(uint32_t));
+    if (!position || !dfa->rows || !ordered->next) {
+        rift_free(position);
+        return false;
+    }
+
+    // The dead row stays first even in a table claiming it accepts
+    uint32_t count = 0;
+    dfa->rows[count++] = RIFT_DFA_DEAD_STATE;
+    for (int accepting = 1; accepting >= 0; accepting--) {
+        for (uint32_t row = 1; row < num_states; row++) {
+            if (rift_dfa_table_is_accepting(table, row) == (accepting == 1)) {
+                dfa->rows[count++] = row;
+            }
+        }
+        if (accepting == 1) {
+            dfa->special_limit = count;
+        }
+    }
+
+    for (uint32_t id = 0; id < num_states; id++) {
+        position[dfa->rows[id]] = id;
+    }
+    for (uint32_t id = 0; id < num_states; id++) {
+        const uint32_t *next = table_row(table, dfa->rows[id]);
+        uint32_t *ordered_next = ordered->next + (size_t)id * table->num_classes;
+        for (uint32_t k = 0; k < table->num_classes; k++) {
+            ordered_next[k] = position[next[k]];
+        }
+    }
+
+    ordered->num_states = num_states;
+    ordered->num_classes = table->num_classes;
+    ordered->start_state = position[table->start_state];
+    rift_free(position);
+    return true;
+}
+
+/**
+ * @brief Build the dense layout of a compact DFA
+ *
+ * @param ordered The table with its rows in ID order
+ * @param dfa The compact DFA
+ * @return true if successful, false if memory ran out
+ */
+static bool
+build_dense(const rift_dfa_table_t *ordered, rift_compact_dfa_t *dfa)
+{
+    size_t cells = (size_t)ordered->num_states * ordered->num_classes;
+    dfa->id_width = dense_width(ordered->num_states, ordered->num_classes);
+    dfa->next = rift_table_alloc(cells, dfa->id_width);
+    if (!dfa->next) {
+        return false;
+    }
+
+    for (size_t i = 0; i < cells; i++) {
+        uint32_t id = ordered->next[i] * dfa->stride;
+        if (dfa->id_width == 1) {
+            ((uint8_t *)dfa->next)[i] = (uint8_t)id;
+        } else if (dfa->id_width == 2) {
+            ((uint16_t *)dfa->next)[i] = (uint16_t)id;
+        } else {
+            ((uint32_t *)dfa->next)[i] = id;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Order rows by decreasing number of cells, then by index
+ */
+static int
+compare_order(const void *a, const void *b)
+{
+    const comb_order_t *left = (const comb_order_t *)a;
+    const comb_order_t *right = (const comb_order_t *)b;
+    if (left->count != right->count) {
+        return left->count > right->count ? -1 : 1;
+    }
+    return left->row < right->row ? -1 : left->row > right->row;
+}
+
+/**
+ * @brief Make room for a slot index in the displaced arrays
+ *
+ * @param dfa The compact DFA whose check and value arrays grow
+ * @param capacity Current number of slots allocated, updated
+ * @param needed Number of slots needed
+ * @return true if successful, false if memory ran out or the slots exceed 32 bits
+ */
+static bool
+reserve_slots(rift_compact_dfa_t *dfa, size_t *capacity, size_t needed)
+{
+    if (needed <= *capacity) {
+        return true;
+    }
+    if (needed >= UINT32_MAX) {
+        return false;
+    }
+
+    size_t grown = *capacity * 2 > needed ? *capacity * 2 : needed;
+    uint32_t *check = (uint32_t *)rift_realloc(dfa->check, grown * sizeof(uint32_t));
+    if (!check) {
+        return false;
+    }
+    dfa->check = check;
+    uint32_t *value = (uint32_t *)rift_realloc(dfa->value, grown * sizeof(uint32_t));
+    if (!value) {
+        return false;
+    }
+    dfa->value = value;
+
+    for (size_t i = *capacity; i < grown; i++) {
+        dfa->check[i] = COMB_FREE_SLOT;
+    }
+    *capacity = grown;
+    return true;
+}
+
+/**
+ * @brief Place the cells of every row in the displaced arrays
+ *
+ * Each row goes to the lowest offset where all its cells land in free slots,
+ * searched from the first free slot among the last COMB_SEARCH_LIMIT below
+ * the highest slot taken, or past that slot when none of COMB_SEARCH_LIMIT
+ * offsets fits. Bounding the search keeps packing linear in the rows. The
+ * arrays end num_classes slots past the last offset, so a lookup of any
+ * class stays inside them.
+ *
+ * @param dfa The compact DFA, whose base, check and value arrays are filled
+ * @param cells The cells of each row
+ * @return true if successful, false if memory ran out
+ */
+static bool
+pack_rows(rift_compact_dfa_t *dfa, const comb_cells_t *cells)
+{
+    uint32_t num_states = dfa->num_states;
+    comb_order_t *order = (comb_order_t *)rift_malloc(num_states * sizeof(comb_order_t));
+    dfa->base = (uint32_t *)rift_calloc(num_states, sizeof(uint32_t));
+    if (!order || !dfa->base) {
+        rift_free(order);
+        return false;
+    }
+
+    for (uint32_t row = 0; row < num_states; row++) {
+        order[row].row = row;
+        order[row].count = cells->row_start[row + 1] - cells->row_start[row];
+    }
+    qsort(order, num_states, sizeof(comb_order_t), compare_order);
+
+    size_t capacity = 0;
+    size_t first_free = 0;
+    size_t top = 0;
+    size_t end = dfa->num_classes;
+    bool ok = reserve_slots(dfa, &capacity, cells->row_start[num_states] + end);
+
+    for (uint32_t i = 0; ok && i < num_states && order[i].count > 0; i++) {
+        uint32_t row = order[i].row;
+        const uint8_t *classes = cells->classes + cells->row_start[row];
+        const uint32_t *targets = cells->targets + cells->row_start[row];
+        uint32_t count = order[i].count;
+
+        // Holes further down than the window are left behind rather than searched again
+        size_t start = top > COMB_SEARCH_LIMIT ? top - COMB_SEARCH_LIMIT : 0;
+        start = first_free > start ? first_free : start;
+        size_t base = start > classes[0] ? start - classes[0] : 0;
+        for (size_t tries = 0;; base++, tries++) {
+            if (tries == COMB_SEARCH_LIMIT) {
+                base = top > classes[0] ? top - classes[0] : 0;
+            }
+            ok = reserve_slots(dfa, &capacity, base + dfa->num_classes);
+            uint32_t c = 0;
+            while (ok && c < count && dfa->check[base + classes[c]] == COMB_FREE_SLOT) {
+                c++;
+            }
+            if (!ok || c == count) {
+                break;
+            }
+        }
+        if (!ok) {
+            break;
+        }
+
+        for (uint32_t c = 0; c < count; c++) {
+            dfa->check[base + classes[c]] = row;
+            dfa->value[base + classes[c]] = targets[c];
+        }
+        dfa->base[row] = (uint32_t)base;
+        top = base + classes[count - 1] + 1 > top ? base + classes[count - 1] + 1 : top;
+        end = base + dfa->num_classes > end ? base + dfa->num_classes : end;
+        while (first_free < capacity && dfa->check[first_free] != COMB_FREE_SLOT) {
+            first_free++;
+        }
+    }
+
+    rift_free(order);
+    dfa->num_slots = (uint32_t)end;
+    return ok;
+}
+
+/**
+ * @brief Count the cells where two rows differ, giving up at a bound
+ *
+ * @param table The dense table
+ * @param row The row
+ * @param other The row compared with
+ * @param bound Count past which the exact number does not matter
+ * @return Number of differing cells, or bound if there are at least that many
+ */
+static uint32_t
+row_difference(const rift_dfa_table_t *table, uint32_t row, uint32_t other, uint32_t bound)
+{
+    const uint32_t *next = table_row(table, row);
+    const uint32_t *other_next = table_row(table, other);
+    uint32_t count = 0;
+    for (uint32_t k = 0; k < table->num_classes && count < bound; k++) {
+        count += next[k] != other_next[k];
+    }
+    return count;
+}
+
+/**
+ * @brief Choose the default row of every row
+ *
+ * A row takes as default the start row or one of the DEFAULT_CANDIDATES rows
+ * before it, whichever leaves it the fewest cells to store, if that is fewer
+ * than its live cells. Defaults point to earlier rows or to the start row,
+ * which has none, so the chains end, and no chain is longer than
+ * RIFT_COMPACT_DFA_MAX_CHAIN.
+ *
+ * @param table The dense table
+ * @param dfa The compact DFA whose defaults array is filled
+ * @return true if successful, false if memory ran out
+ */
+static bool
+choose_defaults(const rift_dfa_table_t *table, rift_compact_dfa_t *dfa)
+{
+    uint32_t num_states = table->num_states;
+    uint8_t *depth = (uint8_t *)rift_calloc(num_states, sizeof(uint8_t));
+    dfa->defaults = (uint32_t *)rift_malloc(num_states * sizeof(uint32_t));
+    if (!depth || !dfa->defaults) {
+        rift_free(depth);
+        return false;
+    }
+
+    for (uint32_t row = 0; row < num_states; row++) {
+        dfa->defaults[row] = RIFT_COMPACT_DFA_NO_DEFAULT;
+        if (row == table->start_state) {
+            continue;
+        }
+
+        uint32_t best = row_difference(table, row, RIFT_DFA_DEAD_STATE, table->num_classes);
+        uint32_t first = row > DEFAULT_CANDIDATES ? row - DEFAULT_CANDIDATES : 1;
+        for (uint32_t other = first; other <= row && best > 0; other++) {
+            // The last candidate stands for the start row
+            uint32_t candidate = other == row ? table->start_state : other;
+            if (candidate == row || depth[candidate] >= RIFT_COMPACT_DFA_MAX_CHAIN) {
+                continue;
+            }
+            uint32_t difference = row_difference(table, row, candidate, best);
+            if (difference < best) {
+                best = difference;
+                dfa->defaults[row] = candidate;
+                depth[row] = depth[candidate] + 1;
+            }
+        }
+    }
+
+    rift_free(depth);
+    return true;
+}
+
+/**
+ * @brief Collect the cells each row of a comb or default chain stores
+ *
+ * A row without a default stores its live cells; a row with one stores the
+ * cells where it differs from its default, dead ones included.
+ *
+ * @param table The dense table
+ * @param defaults Default of each row, NULL for none
+ * @param cells The cells to fill
+ * @return true if successful, false if memory ran out
+ */
+static bool
+collect_cells(const rift_dfa_table_t *table, const uint32_t *defaults, comb_cells_t *cells)
+{
+    uint32_t num_states = table->num_states;
+    size_t total = 0;
+    cells->row_start = (uint32_t *)rift_malloc(((size_t)num_states + 1) * sizeof(uint32_t));
+    if (!cells->row_start) {
+        return false;
+    }
+
+    for (int pass = 0; pass < 2; pass++) {
+        total = 0;
+        for (uint32_t row = 0; row < num_states; row++) {
+            uint32_t other = defaults ? defaults[row] : RIFT_COMPACT_DFA_NO_DEFAULT;
+            const uint32_t *next = table_row(table, row);
+            const uint32_t *other_next =
+                table_row(table, other == RIFT_COMPACT_DFA_NO_DEFAULT ? RIFT_DFA_DEAD_STATE
+                                                                      : other);
+            cells->row_start[row] = (uint32_t)total;
+            for (uint32_t k = 0; k < table->num_classes; k++) {
+                if (next[k] == other_next[k]) {
+                    continue;
+                }
+                if (pass == 1) {
+                    cells->classes[total] = (uint8_t)k;
+                    cells->targets[total] = next[k];
+                }
+                total++;
+            }
+        }
+        cells->row_start[num_states] = (uint32_t)total;
+
+        // The first pass only counts, to size the cell arrays
+        if (pass == 0) {
+            cells->classes = (uint8_t *)rift_malloc(total + 1);
+            cells->targets = (uint32_t *)rift_malloc((total + 1) * sizeof(uint32_t));
+            if (!cells->classes || !cells->targets) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Build the comb or default-chain arrays of a compact DFA
+ *
+ * @param table The dense table
+ * @param dfa The compact DFA
+ * @param chain Whether rows store their differences from a default row
+ * @return true if successful, false if memory ran out
+ */
+static bool
+build_comb(const rift_dfa_table_t *table, rift_compact_dfa_t *dfa, bool chain)
+{
+    comb_cells_t cells = {NULL, NULL, NULL};
+    bool ok = (!chain || choose_defaults(table, dfa)) &&
+              collect_cells(table, chain ? dfa->defaults : NULL, &cells) &&
+              pack_rows(dfa, &cells);
+
+    rift_free(cells.row_start);
+    rift_free(cells.classes);
+    rift_free(cells.targets);
+    if (!ok) {
+        return false;
+    }
+
+    // Give back the slots reserved past the last row
+    uint32_t *check = (uint32_t *)rift_realloc(dfa->check, dfa->num_slots * sizeof(uint32_t));
+    if (check) {
+        dfa->check = check;
+    }
+    uint32_t *value = (uint32_t *)rift_realloc(dfa->value, dfa->num_slots * sizeof(uint32_t));
+    if (value) {
+        dfa->value = value;
+    }
+    return true;
+}
+
+/**
+ * @brief Build the runs of every row of a compact DFA
+ *
+ * @param table The dense table
+ * @param dfa The compact DFA
+ * @return true if successful, false if memory ran out or there are too many runs
+ */
+static bool
+build_ranges(const rift_dfa_table_t *table, rift_compact_dfa_t *dfa)
+{
+    size_t runs = count_runs(table);
+    if (runs >= UINT32_MAX) {
+        return false;
+    }
+
+    dfa->num_ranges = (uint32_t)runs;
+    dfa->range_start =
+        (uint32_t *)rift_malloc(((size_t)table->num_states + 1) * sizeof(uint32_t));
+    dfa->range_last = (uint8_t *)rift_malloc(runs);
+    dfa->range_target = (uint32_t *)rift_malloc(runs * sizeof(uint32_t));
+    if (!dfa->range_start || !dfa->range_last || !dfa->range_target) {
+        return false;
+    }
+
+    uint32_t run = 0;
+    for (uint32_t row = 0; row < table->num_states; row++) {
+        const uint32_t *next = table_row(table, row);
+        dfa->range_start[row] = run;
+        for (uint32_t k = 0; k < table->num_classes; k++) {
+            if (k + 1 == table->num_classes || next[k + 1] != next[k]) {
+                dfa->range_last[run] = (uint8_t)k;
+                dfa->range_target[run] = next[k];
+                run++;
+            }
+        }
+    }
+    dfa->range_start[table->num_states] = run;
+    return true;
+}
+
+/**
+ * @brief Build a compact DFA in a given layout under the tag already in use
+ *
+ * @param table The dense table to compress
+ * @param layout The layout
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new compact DFA or NULL on failure
+ */
+static rift_compact_dfa_t *
+create_compact(const rift_dfa_table_t *table, rift_dfa_layout_t layout, rift_regex_error_t *error)
+{
+    if (!table || !table->next || layout >= RIFT_DFA_LAYOUT_COUNT) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Null DFA table or unknown compact DFA layout");
+        }
+        return NULL;
+    }
+
+    // Premultiplied dense IDs must stay within 32 bits
+    if ((uint64_t)table->num_states * table->num_classes > UINT32_MAX) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_LIMIT_EXCEEDED;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "DFA table has too many cells for a compact DFA");
+        }
+        return NULL;
+    }
+
+    rift_compact_dfa_t *dfa = (rift_compact_dfa_t *)rift_calloc(1, sizeof(rift_compact_dfa_t));
+    if (!dfa) {
+        set_memory_error(error);
+        return NULL;
+    }
+    dfa->layout = layout;
+    dfa->num_states = table->num_states;
+    dfa->num_classes = table->num_classes;
+    dfa->stride = layout == RIFT_DFA_LAYOUT_DENSE ? table->num_classes : 1;
+    memcpy(dfa->byte_class, table->byte_class, sizeof(dfa->byte_class));
+
+    rift_dfa_table_t ordered = {0};
+    bool ok = order_rows(table, dfa, &ordered);
+    if (ok) {
+        dfa->start_state = ordered.start_state * dfa->stride;
+        dfa->special_limit *= dfa->stride;
+        switch (layout) {
+        case RIFT_DFA_LAYOUT_DENSE:
+            ok = build_dense(&ordered, dfa);
+            break;
+        case RIFT_DFA_LAYOUT_COMB:
+            ok = build_comb(&ordered, dfa, false);
+            break;
+        case RIFT_DFA_LAYOUT_DEFAULT_CHAIN:
+            ok = build_comb(&ordered, dfa, true);
+            break;
+        default:
+            ok = build_ranges(&ordered, dfa);
+            break;
+        }
+    }
+    rift_free(ordered.next);
+
+    if (!ok) {
+        rift_compact_dfa_free(dfa);
+        set_memory_error(error);
+        return NULL;
+    }
+    return dfa;
+}
+
+/**
+ * @brief Build a compact DFA in a given layout
+ *
+ * @param table The dense table to compress, left untouched
+ * @param layout The layout
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new compact DFA or NULL on failure
+ */
+rift_compact_dfa_t *
+rift_compact_dfa_create(const rift_dfa_table_t *table, rift_dfa_layout_t layout,
+                        rift_regex_error_t *error)
+{
+    rift_memory_tag_t outer = rift_memory_tag_use(RIFT_MEMORY_TAG_DFA);
+    rift_compact_dfa_t *dfa = create_compact(table, layout, error);
+    rift_memory_tag_use(outer);
+    return dfa;
+}
+
+/**
+ * @brief Build a compact DFA in the fastest layout that fits a memory budget
+ *
+ * The dense and range layouts are sized before they are built, and the
+ * comb is skipped when its live cells alone are over the budget; the sizes
+ * of the comb and default-chain layouts are only known once packed.
+ *
+ * @param table The dense table to compress, left untouched
+ * @param max_bytes The budget in bytes, 0 for none
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new compact DFA or NULL on failure
+ */
+rift_compact_dfa_t *
+rift_compact_dfa_create_with_budget(const rift_dfa_table_t *table, size_t max_bytes,
+                                    rift_regex_error_t *error)
+{
+    if (max_bytes == 0 || !table) {
+        return rift_compact_dfa_create(table, RIFT_DFA_LAYOUT_DENSE, error);
+    }
+
+    size_t common = common_memory(table->num_states);
+    size_t bounds[RIFT_DFA_LAYOUT_COUNT];
+    uint8_t width = dense_width(table->num_states, table->num_classes);
+    bounds[RIFT_DFA_LAYOUT_DENSE] =
+        common + (size_t)table->num_states * table->num_classes * width;
+    bounds[RIFT_DFA_LAYOUT_COMB] = common + (size_t)table->num_states * sizeof(uint32_t) +
+                                   count_live_cells(table) * 2 * sizeof(uint32_t);
+    bounds[RIFT_DFA_LAYOUT_DEFAULT_CHAIN] = common;
+    bounds[RIFT_DFA_LAYOUT_RANGES] = common +
+                                     ((size_t)table->num_states + 1) * sizeof(uint32_t) +
+                                     count_runs(table) * (sizeof(uint8_t) + sizeof(uint32_t));
+
+    // Layouts that cannot fit are not built; the bounds are exact for dense and ranges
+    for (int layout = RIFT_DFA_LAYOUT_DENSE; layout < RIFT_DFA_LAYOUT_COUNT; layout++) {
+        if (bounds[layout] > max_bytes) {
+            continue;
+        }
+
+        rift_compact_dfa_t *dfa = rift_compact_dfa_create(table, (rift_dfa_layout_t)layout, error);
+        if (!dfa || rift_compact_dfa_memory_usage(dfa) <= max_bytes) {
+            return dfa;
+        }
+        rift_compact_dfa_free(dfa);
+    }
+
+    if (error) {
+        error->code = RIFT_REGEX_ERROR_LIMIT_EXCEEDED;
+        snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                 "No compact DFA layout fits in %zu bytes", max_bytes);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Free a compact DFA
+ *
+ * @param dfa The compact DFA (can be NULL)
+ */
+void
+rift_compact_dfa_free(rift_compact_dfa_t *dfa)
+{
+    if (!dfa) {
+        return;
+    }
+
+    rift_free(dfa->rows);
+    rift_table_free(dfa->next);
+    rift_free(dfa->base);
+    rift_free(dfa->defaults);
+    rift_free(dfa->check);
+    rift_free(dfa->value);
+    rift_free(dfa->range_start);
+    rift_free(dfa->range_last);
+    rift_free(dfa->range_target);
+    rift_free(dfa);
+}
+
+/**
+ * @brief Get the name of a layout
+ *
+ * @param layout The layout
+ * @return A static lowercase name, "unknown" for an invalid layout
+ */
+const char *
+rift_dfa_layout_name(rift_dfa_layout_t layout)
+{
+    switch (layout) {
+    case RIFT_DFA_LAYOUT_DENSE:
+        return "dense";
+    case RIFT_DFA_LAYOUT_COMB:
+        return "comb";
+    case RIFT_DFA_LAYOUT_DEFAULT_CHAIN:
+        return "default-chain";
+    case RIFT_DFA_LAYOUT_RANGES:
+        return "ranges";
+    default:
+        return "unknown";
+    }
+}
+
+/**
+ * @brief Check whether a value is a state ID of a compact DFA
+ *
+ * @param dfa The compact DFA
+ * @param state The value
+ * @return true if it is one
+ */
+static bool
+is_state(const rift_compact_dfa_t *dfa, uint32_t state)
+{
+    return state % dfa->stride == 0 && state / dfa->stride < dfa->num_states;
+}
+
+/**
+ * @brief Get the next state for an input byte
+ *
+ * @param dfa The compact DFA
+ * @param state The current state ID
+ * @param byte The input byte
+ * @return The next state ID (RIFT_DFA_DEAD_STATE if there is no transition or
+ *         the state is not an ID of the DFA)
+ */
+uint32_t
+rift_compact_dfa_next(const rift_compact_dfa_t *dfa, uint32_t state, uint8_t byte)
+{
+    if (!dfa || !is_state(dfa, state)) {
+        return RIFT_DFA_DEAD_STATE;
+    }
+
+    return rift_compact_dfa_step(dfa, state, byte);
+}
+
+/**
+ * @brief Check whether a state is accepting
+ *
+ * @param dfa The compact DFA
+ * @param state The state ID
+ * @return true if the state is accepting, false otherwise
+ */
+bool
+rift_compact_dfa_is_accepting(const rift_compact_dfa_t *dfa, uint32_t state)
+{
+    if (!dfa || !is_state(dfa, state)) {
+        return false;
+    }
+
+    return state != RIFT_DFA_DEAD_STATE && state < dfa->special_limit;
+}
+
+/**
+ * @brief Check whether the whole input is accepted
+ *
+ * @param dfa The compact DFA
+ * @param input The input buffer
+ * @param length Length of the input in bytes
+ * @return true if the entire input is accepted, false otherwise
+ */
+bool
+rift_compact_dfa_matches(const rift_compact_dfa_t *dfa, const char *input, size_t length)
+{
+    if (!dfa || (!input && length > 0)) {
+        return false;
+    }
+
+    const unsigned char *bytes = (const unsigned char *)input;
+    uint32_t state = dfa->start_state;
+
+    for (size_t i = 0; i < length; i++) {
+        state = rift_compact_dfa_step(dfa, state, bytes[i]);
+        if (state == RIFT_DFA_DEAD_STATE) {
+            return false;
+        }
+    }
+
+    return state != RIFT_DFA_DEAD_STATE && state < dfa->special_limit;
+}
+
+/**
+ * @brief Find the longest accepted prefix of the input
+ *
+ * @param dfa The compact DFA
+ * @param input The input buffer
+ * @param length Length of the input in bytes
+ * @param match_end Pointer to store the end offset of the longest match (can be NULL)
+ * @return true if some prefix (possibly empty) is accepted, false otherwise
+ */
+bool
+rift_compact_dfa_longest_prefix(const rift_compact_dfa_t *dfa, const char *input, size_t length,
+                                size_t *match_end)
+{
+    if (!dfa || (!input && length > 0)) {
+        return false;
+    }
+
+    const uint32_t special_limit = dfa->special_limit;
+    const unsigned char *bytes = (const unsigned char *)input;
+    uint32_t state = dfa->start_state;
+    bool found = state != RIFT_DFA_DEAD_STATE && state < special_limit;
+    size_t last_end = 0;
+
+    // One compare lets ordinary states through; special ones are dead or accepting
+    for (size_t i = 0; i < length; i++) {
+        state = rift_compact_dfa_step(dfa, state, bytes[i]);
+        if (state < special_limit) {
+            if (state == RIFT_DFA_DEAD_STATE) {
+                break;
+            }
+            found = true;
+            last_end = i + 1;
+        }
+    }
+
+    if (found && match_end) {
+        *match_end = last_end;
+    }
+
+    return found;
+}
+
+/**
+ * @brief Get the memory used by a compact DFA
+ *
+ * @param dfa The compact DFA
+ * @return Size of its storage in bytes, 0 for NULL
+ */
+size_t
+rift_compact_dfa_memory_usage(const rift_compact_dfa_t *dfa)
+{
+    if (!dfa) {
+        return 0;
+    }
+
+    size_t size = common_memory(dfa->num_states);
+    switch (dfa->layout) {
+    case RIFT_DFA_LAYOUT_DENSE:
+        return size + (size_t)dfa->num_states * dfa->num_classes * dfa->id_width;
+    case RIFT_DFA_LAYOUT_COMB:
+        return size + (size_t)dfa->num_states * sizeof(uint32_t) +
+               (size_t)dfa->num_slots * 2 * sizeof(uint32_t);
+    case RIFT_DFA_LAYOUT_DEFAULT_CHAIN:
+        return size + (size_t)dfa->num_states * 2 * sizeof(uint32_t) +
+               (size_t)dfa->num_slots * 2 * sizeof(uint32_t);
+    default:
+        return size + ((size_t)dfa->num_states + 1) * sizeof(uint32_t) +
+               (size_t)dfa->num_ranges * (sizeof(uint8_t) + sizeof(uint32_t));
+    }
+}
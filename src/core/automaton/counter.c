@@ -0,0 +1,468 @@
+/**
+ * @file counter.c
+ * @brief Implementation of counted repetition for the LibRift regex automaton
+ *
+ * This file marks counted loops and unrolls them. Unrolling a loop with
+ * bounds {min,max} keeps its body as the first copy and clones it for the
+ * others; between copy i and copy i + 1 sits a junction standing for "i
+ * iterations done", which repeats while i is below the maximum and leaves
+ * once i reaches the minimum. The start and step states of the loop become
+ * the first two junctions. An unbounded loop gets max(min, 1) copies, the
+ * last junction looping back into the last copy.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/automaton/counter.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/automaton/transition.h"
+#include "core/memory/memory.h"
+
+/**
+ * @brief Sentinel index meaning "not a state of the automaton"
+ */
+#define COUNTER_NO_STATE SIZE_MAX
+
+/**
+ * @brief Look up the index of a state among the first states of an automaton
+ *
+ * @param automaton The automaton
+ * @param count Number of leading states searched
+ * @param state The state to look up
+ * @return The index or COUNTER_NO_STATE if the state is not among them
+ */
+static size_t
+find_index(const rift_regex_automaton_t *automaton, size_t count, const rift_regex_state_t *state)
+{
+    size_t index = rift_automaton_get_state_index(automaton, state);
+    return index < count ? index : COUNTER_NO_STATE;
+}
+
+/**
+ * @brief Set an error on an invalid counted loop
+ */
+static bool
+set_counter_error(rift_regex_error_t *error, rift_regex_error_code_t code, const char *message)
+{
+    if (error) {
+        error->code = code;
+        snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH, "%s", message);
+    }
+    return false;
+}
+
+/**
+ * @brief Find the COUNTER_STEP state of a loop
+ *
+ * @return The step state or NULL if the loop has none
+ */
+static rift_regex_state_t *
+find_step(const rift_regex_automaton_t *automaton, const rift_regex_state_t *start)
+{
+    for (size_t i = 0; i < automaton->num_states; i++) {
+        rift_regex_state_t *state = automaton->states[i];
+        if ((state->flags & RIFT_STATE_FLAG_COUNTER_STEP) && state->repeat_start == start) {
+            return state;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Turn a counting state back into a plain one without edges
+ */
+static void
+clear_counter(rift_regex_state_t *state)
+{
+    while (state->num_transitions > 0) {
+        rift_state_remove_transition(state, state->num_transitions - 1);
+    }
+
+    state->flags &= ~(RIFT_STATE_FLAG_COUNTER_START | RIFT_STATE_FLAG_COUNTER_STEP);
+    state->repeat_min = 0;
+    state->repeat_max = 0;
+    state->repeat_greedy = true;
+    state->repeat_start = NULL;
+}
+
+/**
+ * @brief Copy everything but the transitions of a state into a new state
+ *
+ * The loop a counting state belongs to is set by the caller.
+ */
+static bool
+copy_state_data(rift_regex_state_t *copy, const rift_regex_state_t *state)
+{
+    if ((state->pattern && !rift_state_set_pattern(copy, state->pattern)) ||
+        !rift_state_merge_accept_tags(copy, state)) {
+        return false;
+    }
+    if (state->capture &&
+        (!rift_state_set_group_name(copy, state->capture->group_name) ||
+         !rift_state_set_group_start(copy, state->capture->is_group_start) ||
+         !rift_state_set_group_end(copy, state->capture->is_group_end))) {
+        return false;
+    }
+
+    copy->flags = state->flags;
+    copy->repeat_min = state->repeat_min;
+    copy->repeat_max = state->repeat_max;
+    copy->repeat_greedy = state->repeat_greedy;
+    copy->lookaround = state->lookaround;
+    return true;
+}
+
+/**
+ * @brief Add a copy of a transition between other states
+ */
+static bool
+copy_transition(rift_regex_state_t *from, rift_regex_state_t *to,
+                const rift_regex_transition_t *transition)
+{
+    bool added = rift_transition_is_epsilon(transition)
+                     ? rift_state_add_epsilon_transition(from, to)
+                     : transition->input_pattern &&
+                           rift_state_add_transition(from, to, transition->input_pattern);
+
+    if (added) {
+        from->transitions[from->num_transitions - 1]->priority = transition->priority;
+    }
+    return added;
+}
+
+/**
+ * @brief Add the repeat and leave edges of a junction in order of preference
+ */
+static bool
+add_junction_edges(rift_regex_state_t *junction, rift_regex_state_t *repeat,
+                   rift_regex_state_t *leave, bool greedy)
+{
+    rift_regex_state_t *first = greedy ? repeat : leave;
+    rift_regex_state_t *second = greedy ? leave : repeat;
+
+    return (!first || rift_state_add_epsilon_transition(junction, first)) &&
+           (!second || rift_state_add_epsilon_transition(junction, second));
+}
+
+/**
+ * @brief Mark the start and step states of a counted loop
+ */
+bool
+rift_counter_mark(rift_regex_state_t *start, rift_regex_state_t *step, uint32_t min, uint32_t max,
+                  bool greedy)
+{
+    if (!start || !step || start == step || max < min) {
+        return false;
+    }
+
+    rift_regex_state_t *states[] = {start, step};
+    for (size_t i = 0; i < 2; i++) {
+        states[i]->flags |= i == 0 ? RIFT_STATE_FLAG_COUNTER_START : RIFT_STATE_FLAG_COUNTER_STEP;
+        states[i]->repeat_min = min;
+        states[i]->repeat_max = max;
+        states[i]->repeat_greedy = greedy;
+        states[i]->repeat_start = start;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Get the targets of the edges of a counting state
+ */
+bool
+rift_counter_get_edges(const rift_regex_state_t *state, rift_regex_state_t **repeat,
+                       rift_regex_state_t **leave)
+{
+    if (!state || !repeat || !leave || state->num_transitions != 2 ||
+        !(state->flags & (RIFT_STATE_FLAG_COUNTER_START | RIFT_STATE_FLAG_COUNTER_STEP)) ||
+        !rift_transition_is_epsilon(state->transitions[0]) ||
+        !rift_transition_is_epsilon(state->transitions[1])) {
+        return false;
+    }
+
+    rift_regex_state_t *first = rift_transition_get_target(state->transitions[0]);
+    rift_regex_state_t *second = rift_transition_get_target(state->transitions[1]);
+    *repeat = state->repeat_greedy ? first : second;
+    *leave = state->repeat_greedy ? second : first;
+    return *repeat && *leave;
+}
+
+/**
+ * @brief Check whether a counted loop is better unrolled
+ *
+ * @param automaton The automaton holding the loop
+ * @param start The COUNTER_START state of the loop
+ * @return true if the loop should be unrolled, also when it cannot be inspected
+ */
+bool
+rift_counter_should_unroll(const rift_regex_automaton_t *automaton,
+                           const rift_regex_state_t *start)
+{
+    if (!automaton || !start) {
+        return true;
+    }
+
+    uint32_t bound = start->repeat_max == RIFT_COUNTER_UNBOUNDED ? start->repeat_min
+                                                                  : start->repeat_max;
+    if (bound <= RIFT_COUNTER_UNROLL_LIMIT) {
+        return true;
+    }
+
+    rift_regex_state_t *step = find_step(automaton, start);
+    rift_regex_state_t *body = NULL;
+    rift_regex_state_t *leave = NULL;
+    bool *seen = (bool *)rift_calloc(automaton->num_states + 1, sizeof(bool));
+    rift_regex_state_t **queue = (rift_regex_state_t **)rift_malloc(
+        (automaton->num_states + 1) * sizeof(rift_regex_state_t *));
+
+    // The body matches the empty string when epsilon edges alone reach the step
+    bool nullable = true;
+    if (step && seen && queue && rift_counter_get_edges(start, &body, &leave)) {
+        size_t count = 0;
+        size_t index = find_index(automaton, automaton->num_states, body);
+        if (index != COUNTER_NO_STATE) {
+            seen[index] = true;
+            queue[count++] = body;
+            nullable = false;
+        }
+
+        for (size_t i = 0; i < count && !nullable; i++) {
+            for (size_t t = 0; t < queue[i]->num_transitions; t++) {
+                const rift_regex_transition_t *transition = queue[i]->transitions[t];
+                rift_regex_state_t *target = rift_transition_get_target(transition);
+                if (!target || !rift_transition_is_epsilon(transition)) {
+                    continue;
+                }
+                if (target == step) {
+                    nullable = true;
+                    break;
+                }
+
+                index = find_index(automaton, automaton->num_states, target);
+                if (index != COUNTER_NO_STATE && !seen[index]) {
+                    seen[index] = true;
+                    queue[count++] = target;
+                }
+            }
+        }
+    }
+
+    rift_free(seen);
+    rift_free(queue);
+    return nullable;
+}
+
+/**
+ * @brief Unroll one counted loop into plain states
+ *
+ * On failure the automaton is left half rewritten and must be freed.
+ */
+bool
+rift_counter_expand(rift_regex_automaton_t *automaton, rift_regex_state_t *start,
+                    rift_regex_error_t *error)
+{
+    if (!automaton || !start || !(start->flags & RIFT_STATE_FLAG_COUNTER_START)) {
+        return set_counter_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                                 "Invalid counted loop to expand");
+    }
+
+    rift_regex_state_t *step = find_step(automaton, start);
+    rift_regex_state_t *body = NULL;
+    rift_regex_state_t *leave = NULL;
+    rift_regex_state_t *step_body = NULL;
+    rift_regex_state_t *step_leave = NULL;
+    if (!step || !rift_counter_get_edges(start, &body, &leave) ||
+        !rift_counter_get_edges(step, &step_body, &step_leave) || step_body != body ||
+        step_leave != leave || body == step) {
+        return set_counter_error(error, RIFT_REGEX_ERROR_INVALID_AUTOMATON,
+                                 "Malformed counted loop");
+    }
+
+    uint32_t min = start->repeat_min;
+    bool greedy = start->repeat_greedy;
+    bool bounded = start->repeat_max != RIFT_COUNTER_UNBOUNDED;
+    size_t copies = bounded ? start->repeat_max : (min > 1 ? min : 1);
+    size_t num_states = automaton->num_states;
+
+    bool *in_body = (bool *)rift_calloc(num_states + 1, sizeof(bool));
+    rift_regex_state_t **members =
+        (rift_regex_state_t **)rift_malloc((num_states + 1) * sizeof(rift_regex_state_t *));
+    size_t *member_index = (size_t *)rift_malloc((num_states + 1) * sizeof(size_t));
+    rift_regex_state_t **map =
+        (rift_regex_state_t **)rift_calloc(num_states + 1, sizeof(rift_regex_state_t *));
+    rift_regex_state_t **junctions =
+        (rift_regex_state_t **)rift_calloc(copies + 1, sizeof(rift_regex_state_t *));
+    rift_regex_state_t **entry =
+        (rift_regex_state_t **)rift_calloc(copies + 1, sizeof(rift_regex_state_t *));
+
+    rift_regex_error_code_t code = RIFT_REGEX_ERROR_MEMORY;
+    const char *message = "Failed to allocate counted loop copies";
+    if (!in_body || !members || !member_index || !map || !junctions || !entry) {
+        goto fail;
+    }
+
+    /* Collect the body: everything reachable from its entry before the step */
+    size_t count = 0;
+    size_t index = find_index(automaton, num_states, body);
+    if (index == COUNTER_NO_STATE) {
+        code = RIFT_REGEX_ERROR_INVALID_AUTOMATON;
+        message = "Counted loop body is outside the automaton";
+        goto fail;
+    }
+    in_body[index] = true;
+    member_index[count] = index;
+    members[count++] = body;
+
+    for (size_t i = 0; i < count; i++) {
+        for (size_t t = 0; t < members[i]->num_transitions; t++) {
+            rift_regex_state_t *target = rift_transition_get_target(members[i]->transitions[t]);
+            if (!target || target == step) {
+                continue;
+            }
+
+            index = find_index(automaton, num_states, target);
+            if (target == start || target == leave || index == COUNTER_NO_STATE) {
+                code = RIFT_REGEX_ERROR_INVALID_AUTOMATON;
+                message = "Counted loop body leaves the loop";
+                goto fail;
+            }
+            if (!in_body[index]) {
+                in_body[index] = true;
+                member_index[count] = index;
+                members[count++] = target;
+            }
+        }
+    }
+
+    /* Copy 1 is the body itself, ending at the step */
+    junctions[0] = start;
+    if (copies > 0) {
+        junctions[1] = step;
+        entry[1] = body;
+    } else {
+        clear_counter(step);
+    }
+
+    /* Copies 2 and up are clones, each ending at a new junction */
+    message = "Failed to copy counted loop body";
+    for (size_t k = 2; k <= copies; k++) {
+        junctions[k] = rift_automaton_create_state(automaton, false);
+        if (!junctions[k]) {
+            goto fail;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            rift_regex_state_t *copy =
+                rift_automaton_create_state(automaton, members[i]->is_accepting);
+            if (!copy || !copy_state_data(copy, members[i])) {
+                goto fail;
+            }
+            map[member_index[i]] = copy;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            rift_regex_state_t *copy = map[member_index[i]];
+            for (size_t t = 0; t < members[i]->num_transitions; t++) {
+                const rift_regex_transition_t *transition = members[i]->transitions[t];
+                rift_regex_state_t *target = rift_transition_get_target(transition);
+                if (target &&
+                    !copy_transition(copy,
+                                     target == step
+                                         ? junctions[k]
+                                         : map[find_index(automaton, num_states, target)],
+                                     transition)) {
+                    goto fail;
+                }
+            }
+
+            // Loops nested in the body are counted in the copy by its own start
+            if (members[i]->repeat_start) {
+                index = find_index(automaton, num_states, members[i]->repeat_start);
+                copy->repeat_start =
+                    index != COUNTER_NO_STATE && in_body[index] ? map[index] : NULL;
+            }
+        }
+
+        entry[k] = map[member_index[0]];
+    }
+
+    /* Junction i has done i iterations: it repeats below max and leaves from min */
+    message = "Failed to connect counted loop copies";
+    for (size_t i = 0; i <= copies; i++) {
+        clear_counter(junctions[i]);
+
+        rift_regex_state_t *repeat = NULL;
+        if (i < copies) {
+            repeat = entry[i + 1];
+        } else if (!bounded) {
+            repeat = entry[copies];
+        }
+
+        if (!add_junction_edges(junctions[i], repeat, i >= min ? leave : NULL, greedy)) {
+            goto fail;
+        }
+    }
+
+    code = RIFT_REGEX_ERROR_NONE;
+
+fail:
+    rift_automaton_invalidate_epsilon_closures(automaton);
+
+    rift_free(in_body);
+    rift_free(members);
+    rift_free(member_index);
+    rift_free(map);
+    rift_free(junctions);
+    rift_free(entry);
+
+    if (code != RIFT_REGEX_ERROR_NONE) {
+        return set_counter_error(error, code, message);
+    }
+    return true;
+}
+
+/**
+ * @brief Check whether an automaton has counted loops
+ */
+bool
+rift_automaton_has_counters(const rift_regex_automaton_t *automaton)
+{
+    if (!automaton) {
+        return false;
+    }
+
+    for (size_t i = 0; i < automaton->num_states; i++) {
+        if (automaton->states[i]->flags & RIFT_STATE_FLAG_COUNTER_START) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Unroll every counted loop of an automaton
+ *
+ * Copies of nested loops are appended to the states, so they are reached
+ * later in the same pass.
+ */
+bool
+rift_automaton_expand_counters(rift_regex_automaton_t *automaton, rift_regex_error_t *error)
+{
+    if (!automaton) {
+        return set_counter_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                                 "Null automaton provided");
+    }
+
+    for (size_t i = 0; i < automaton->num_states; i++) {
+        rift_regex_state_t *state = automaton->states[i];
+        if ((state->flags & RIFT_STATE_FLAG_COUNTER_START) &&
+            !rift_counter_expand(automaton, state, error)) {
+            return false;
+        }
+    }
+    return true;
+}
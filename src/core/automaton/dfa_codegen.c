@@ -0,0 +1,253 @@
+/**
+ * @file dfa_codegen.c
+ * @brief Implementation of C source generation from compiled DFA tables
+ *
+ * This file prints a rift_dfa_table_t as static arrays followed by the two
+ * scanning loops of dfa_table.c, rewritten against those arrays, or as a
+ * const rift_dfa_table_t over such arrays for code linked with librift.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/automaton/dfa_codegen.h"
+#include <ctype.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * @brief Number of array elements written per line of output
+ */
+#define DFA_CODEGEN_VALUES_PER_LINE 12
+
+/**
+ * @brief Check that a prefix is a valid C identifier
+ *
+ * @param prefix The prefix to check
+ * @return true if the prefix is a valid C identifier
+ */
+static bool
+is_identifier(const char *prefix)
+{
+    if (!isalpha((unsigned char)prefix[0]) && prefix[0] != '_') {
+        return false;
+    }
+
+    for (const char *p = prefix + 1; *p; p++) {
+        if (!isalnum((unsigned char)*p) && *p != '_') {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Pick the narrowest unsigned type holding every row index
+ *
+ * @param num_states Number of rows in the table
+ * @return The name of the C type
+ */
+static const char *
+state_type(uint32_t num_states)
+{
+    if (num_states <= UINT8_MAX + 1u) {
+        return "uint8_t";
+    }
+    return num_states <= UINT16_MAX + 1u ? "uint16_t" : "uint32_t";
+}
+
+/**
+ * @brief Write one element of an array initializer
+ *
+ * @param out The stream to write to
+ * @param value The element
+ * @param index Index of the element in the array
+ * @param count Number of elements in the array
+ */
+static void
+emit_value(FILE *out, uint32_t value, size_t index, size_t count)
+{
+    bool line_start = index % DFA_CODEGEN_VALUES_PER_LINE == 0;
+    bool line_end = (index + 1) % DFA_CODEGEN_VALUES_PER_LINE == 0 || index + 1 == count;
+
+    fprintf(out, "%s%u%s", line_start ? "    " : " ", value, line_end ? ",\n" : ",");
+}
+
+/**
+ * @brief Write the result of a code generation, reporting a failed write
+ *
+ * @param out The stream written to
+ * @param name Prefix or name of what was written
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if every write succeeded, false otherwise
+ */
+static bool
+check_written(FILE *out, const char *name, rift_regex_error_t *error)
+{
+    if (ferror(out)) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INTERNAL;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Failed to write generated code for %s", name);
+        }
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Write a compiled table as standalone C source
+ *
+ * @param table The compiled table
+ * @param prefix Prefix of every emitted name, a valid C identifier
+ * @param out The stream to write to
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false on invalid parameters or write failure
+ */
+bool
+rift_dfa_table_emit_c(const rift_dfa_table_t *table, const char *prefix, FILE *out,
+                      rift_regex_error_t *error)
+{
+    if (!table || !prefix || !out || !is_identifier(prefix)) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Null table or stream, or prefix is not a C identifier");
+        }
+        return false;
+    }
+
+    const char *type = state_type(table->num_states);
+    size_t cells = (size_t)table->num_states * table->num_classes;
+
+    fprintf(out,
+            "/* DFA with %u states and %u byte classes, generated by rift compile --emit-c */\n\n"
+            "#include <stdbool.h>\n"
+            "#include <stddef.h>\n"
+            "#include <stdint.h>\n\n",
+            table->num_states, table->num_classes);
+
+    fprintf(out, "static const uint8_t %s_byte_class[256] = {\n", prefix);
+    for (size_t i = 0; i < RIFT_DFA_ALPHABET_SIZE; i++) {
+        emit_value(out, table->byte_class[i], i, RIFT_DFA_ALPHABET_SIZE);
+    }
+    fprintf(out, "};\n\n");
+
+    // Row 0 is the dead state, as in the table the source was built from
+    fprintf(out, "static const %s %s_next[%zu] = {\n", type, prefix, cells);
+    for (size_t i = 0; i < cells; i++) {
+        emit_value(out, table->next[i], i, cells);
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static const uint8_t %s_accept[%u] = {\n", prefix, table->num_states);
+    for (uint32_t row = 0; row < table->num_states; row++) {
+        emit_value(out, rift_dfa_table_is_accepting(table, row), row, table->num_states);
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out,
+            "bool\n"
+            "%s_matches(const char *input, size_t length)\n"
+            "{\n"
+            "    const unsigned char *bytes = (const unsigned char *)input;\n"
+            "    uint32_t state = %u;\n\n"
+            "    for (size_t i = 0; i < length; i++) {\n"
+            "        state = %s_next[state * %u + %s_byte_class[bytes[i]]];\n"
+            "        if (state == 0) {\n"
+            "            return false;\n"
+            "        }\n"
+            "    }\n\n"
+            "    return %s_accept[state];\n"
+            "}\n\n",
+            prefix, table->start_state, prefix, table->num_classes, prefix, prefix);
+
+    fprintf(out,
+            "bool\n"
+            "%s_longest_prefix(const char *input, size_t length, size_t *match_end)\n"
+            "{\n"
+            "    const unsigned char *bytes = (const unsigned char *)input;\n"
+            "    uint32_t state = %u;\n"
+            "    bool found = %s_accept[state];\n"
+            "    size_t last_end = 0;\n\n"
+            "    for (size_t i = 0; i < length; i++) {\n"
+            "        state = %s_next[state * %u + %s_byte_class[bytes[i]]];\n"
+            "        if (state == 0) {\n"
+            "            break;\n"
+            "        }\n"
+            "        if (%s_accept[state]) {\n"
+            "            found = true;\n"
+            "            last_end = i + 1;\n"
+            "        }\n"
+            "    }\n\n"
+            "    if (found && match_end) {\n"
+            "        *match_end = last_end;\n"
+            "    }\n\n"
+            "    return found;\n"
+            "}\n",
+            prefix, table->start_state, prefix, prefix, table->num_classes, prefix, prefix);
+
+    return check_written(out, prefix, error);
+}
+
+/**
+ * @brief Write a compiled table as a read-only rift_dfa_table_t definition
+ *
+ * @param table The compiled table
+ * @param name Name of the emitted table, a valid C identifier
+ * @param out The stream to write to
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false on invalid parameters or write failure
+ */
+bool
+rift_dfa_table_emit_c_table(const rift_dfa_table_t *table, const char *name, FILE *out,
+                            rift_regex_error_t *error)
+{
+    if (!table || !name || !out || !is_identifier(name)) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Null table or stream, or name is not a C identifier");
+        }
+        return false;
+    }
+
+    size_t cells = (size_t)table->num_states * table->num_classes;
+    size_t accept_words = ((size_t)table->num_states + 63) / 64;
+
+    // The table type keeps its arrays 32 and 64 bits wide, so they are too
+    fprintf(out, "static const uint32_t %s_next[%zu] = {\n", name, cells);
+    for (size_t i = 0; i < cells; i++) {
+        emit_value(out, table->next[i], i, cells);
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static const uint64_t %s_accept[%zu] = {\n", name, accept_words);
+    for (size_t i = 0; i < accept_words; i++) {
+        fprintf(out, "    UINT64_C(0x%016llx),\n", (unsigned long long)table->accept_bitmap[i]);
+    }
+    fprintf(out, "};\n\n");
+
+    // The casts only drop const; nothing writes through a table that is not freed
+    fprintf(out,
+            "const rift_dfa_table_t %s = {\n"
+            "    .num_states = %u,\n"
+            "    .start_state = %u,\n"
+            "    .num_classes = %u,\n"
+            "    .byte_class = {\n",
+            name, table->num_states, table->start_state, table->num_classes);
+    for (size_t i = 0; i < RIFT_DFA_ALPHABET_SIZE; i++) {
+        fputs(i % DFA_CODEGEN_VALUES_PER_LINE == 0 ? "    " : "", out);
+        emit_value(out, table->byte_class[i], i, RIFT_DFA_ALPHABET_SIZE);
+    }
+    fprintf(out,
+            "    },\n"
+            "    .next = (uint32_t *)%s_next,\n"
+            "    .accept_bitmap = (uint64_t *)%s_accept,\n"
+            "};\n",
+            name, name);
+
+    return check_written(out, name, error);
+}
@@ -0,0 +1,827 @@
+/**
+ * @file dfa_table.c
+ * @brief Implementation of the dense DFA transition table for the LibRift regex engine
+ *
+ * This file compiles pointer-based DFAs into a flat next-state table indexed
+ * by byte class and provides the byte-at-a-time scanning loops that run over it.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/automaton/dfa_table.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/automaton/state.h"
+#include "core/automaton/transition.h"
+#include "core/memory/memory.h"
+
+/* Prefetch the table entry a scan reads next, for reading and keeping in cache */
+#if defined(__GNUC__) || defined(__clang__)
+#define DFA_PREFETCH(address) __builtin_prefetch((address), 0, 3)
+#else
+#define DFA_PREFETCH(address) ((void)(address))
+#endif
+
+/**
+ * @brief Look up the table row assigned to a state
+ *
+ * @param dfa The source automaton
+ * @param state The state to look up
+ * @return The row index or RIFT_DFA_DEAD_STATE if the state is unknown
+ */
+static uint32_t
+find_row(const rift_regex_automaton_t *dfa, const rift_regex_state_t *state)
+{
+    size_t index = rift_automaton_get_state_index(dfa, state);
+    return index == RIFT_STATE_NO_ID ? RIFT_DFA_DEAD_STATE : (uint32_t)index + 1;
+}
+
+/**
+ * @brief Compile a DFA into a dense transition table under the tag already in use
+ *
+ * @param dfa The deterministic automaton to compile
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new table or NULL on failure
+ */
+static rift_dfa_table_t *
+compile_table(const rift_regex_automaton_t *dfa, rift_regex_error_t *error)
+{
+    if (!dfa || !dfa->initial_state) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Null automaton or missing initial state");
+        }
+        return NULL;
+    }
+
+    if (!dfa->is_deterministic) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_AUTOMATON;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Dense tables can only be compiled from a DFA");
+        }
+        return NULL;
+    }
+
+    if (dfa->num_states >= UINT32_MAX / RIFT_DFA_ALPHABET_SIZE) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_LIMIT_EXCEEDED;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "DFA has too many states for a dense table");
+        }
+        return NULL;
+    }
+
+    rift_byte_classes_t classes;
+    if (!rift_byte_classes_compute(dfa, &classes, error)) {
+        return NULL;
+    }
+
+    rift_dfa_table_t *table = (rift_dfa_table_t *)rift_calloc(1, sizeof(rift_dfa_table_t));
+    if (!table) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_MEMORY;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Failed to allocate DFA table");
+        }
+        return NULL;
+    }
+
+    /* Row 0 is the dead state, automaton states occupy rows 1..num_states */
+    table->num_states = (uint32_t)dfa->num_states + 1;
+    table->num_classes = classes.num_classes;
+    memcpy(table->byte_class, classes.map, sizeof(table->byte_class));
+    table->next = (uint32_t *)rift_table_alloc((size_t)table->num_states * table->num_classes,
+                                               sizeof(uint32_t));
+    table->accept_bitmap =
+        (uint64_t *)rift_calloc((table->num_states + 63) / 64, sizeof(uint64_t));
+    if (!table->next || !table->accept_bitmap) {
+        rift_dfa_table_free(table);
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_MEMORY;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Failed to allocate DFA table rows");
+        }
+        return NULL;
+    }
+
+    table->start_state = find_row(dfa, dfa->initial_state);
+
+    /* Evaluate every transition pattern once per byte class */
+    for (size_t i = 0; i < dfa->num_states; i++) {
+        const rift_regex_state_t *state = dfa->states[i];
+        uint32_t row = (uint32_t)i + 1;
+        uint32_t *row_next = table->next + (size_t)row * table->num_classes;
+
+        if (rift_state_is_accepting(state)) {
+            table->accept_bitmap[row / 64] |= (uint64_t)1 << (row % 64);
+        }
+
+        size_t num_transitions = rift_state_get_transition_count(state);
+        for (size_t t = 0; t < num_transitions; t++) {
+            const rift_regex_transition_t *transition = rift_state_get_transition(state, t);
+            if (!transition || rift_transition_is_epsilon(transition)) {
+                continue;
+            }
+
+            uint32_t target = find_row(dfa, rift_transition_get_target(transition));
+            if (target == RIFT_DFA_DEAD_STATE) {
+                continue;
+            }
+
+            for (uint32_t k = 0; k < table->num_classes; k++) {
+                /* The first matching transition wins, as in the pointer-based walk */
+                if (row_next[k] == RIFT_DFA_DEAD_STATE &&
+                    rift_transition_matches_char(transition, (char)classes.representatives[k])) {
+                    row_next[k] = target;
+                }
+            }
+        }
+    }
+
+    return table;
+}
+
+/**
+ * @brief Compile a DFA into a dense transition table
+ *
+ * @param dfa The deterministic automaton to compile
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new table or NULL on failure
+ */
+rift_dfa_table_t *
+rift_dfa_table_compile(const rift_regex_automaton_t *dfa, rift_regex_error_t *error)
+{
+    rift_memory_tag_t outer = rift_memory_tag_use(RIFT_MEMORY_TAG_DFA);
+    rift_dfa_table_t *table = compile_table(dfa, error);
+    rift_memory_tag_use(outer);
+    return table;
+}
+
+/**
+ * @brief Copy a compiled DFA table
+ *
+ * @param table The table to copy
+ * @return A new table or NULL on failure
+ */
+rift_dfa_table_t *
+rift_dfa_table_clone(const rift_dfa_table_t *table)
+{
+    if (!table) {
+        return NULL;
+    }
+
+    size_t next_size = (size_t)table->num_states * table->num_classes * sizeof(uint32_t);
+    size_t accept_size = ((table->num_states + 63) / 64) * sizeof(uint64_t);
+    rift_dfa_table_t *clone = (rift_dfa_table_t *)rift_malloc(sizeof(rift_dfa_table_t));
+    if (!clone) {
+        return NULL;
+    }
+
+    *clone = *table;
+    clone->next = (uint32_t *)rift_table_alloc(next_size, 1);
+    clone->accept_bitmap = (uint64_t *)rift_malloc(accept_size);
+    if (!clone->next || !clone->accept_bitmap) {
+        rift_dfa_table_free(clone);
+        return NULL;
+    }
+
+    memcpy(clone->next, table->next, next_size);
+    memcpy(clone->accept_bitmap, table->accept_bitmap, accept_size);
+    return clone;
+}
+
+/**
+ * @brief Words before the byte class map in the flat encoding
+ */
+#define DFA_ENCODING_HEADER_WORDS 4
+
+/**
+ * @brief Swap the byte order of each value of a section of 32-bit words in one pass
+ *
+ * @param values The values
+ * @param count Number of values
+ */
+static void
+swap32_array(uint32_t *values, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        values[i] = __builtin_bswap32(values[i]);
+    }
+}
+
+/**
+ * @brief Swap the byte order of each value of a section of 64-bit words in one pass
+ *
+ * @param values The values
+ * @param count Number of values
+ */
+static void
+swap64_array(uint64_t *values, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        values[i] = __builtin_bswap64(values[i]);
+    }
+}
+
+/**
+ * @brief Get the size of a flat encoding from its dimensions
+ *
+ * @param num_states Number of rows
+ * @param num_classes Number of columns
+ * @return Size in bytes, rounded up to a multiple of 8
+ */
+static size_t
+encoded_size(uint32_t num_states, uint32_t num_classes)
+{
+    size_t size = DFA_ENCODING_HEADER_WORDS * sizeof(uint32_t) + RIFT_DFA_ALPHABET_SIZE +
+                  ((num_states + 63) / 64) * sizeof(uint64_t) +
+                  (size_t)num_states * num_classes * sizeof(uint32_t);
+    return (size + 7) & ~(size_t)7;
+}
+
+/**
+ * @brief Get the size of the flat encoding of a table
+ *
+ * @param table The compiled table
+ * @return Size in bytes, 0 for NULL
+ */
+size_t
+rift_dfa_table_encoded_size(const rift_dfa_table_t *table)
+{
+    return table ? encoded_size(table->num_states, table->num_classes) : 0;
+}
+
+/**
+ * @brief Write the flat encoding of a table
+ *
+ * @param table The compiled table
+ * @param data Output buffer of rift_dfa_table_encoded_size() bytes
+ */
+void
+rift_dfa_table_encode(const rift_dfa_table_t *table, uint8_t *data)
+{
+    if (!table || !data) {
+        return;
+    }
+
+    uint32_t header[DFA_ENCODING_HEADER_WORDS] = {table->num_states, table->start_state,
+                                                  table->num_classes, 0};
+    size_t accept_size = ((table->num_states + 63) / 64) * sizeof(uint64_t);
+    size_t next_size = (size_t)table->num_states * table->num_classes * sizeof(uint32_t);
+    size_t offset = 0;
+
+    memset(data, 0, rift_dfa_table_encoded_size(table));
+    memcpy(data, header, sizeof(header));
+    offset += sizeof(header);
+    memcpy(data + offset, table->byte_class, RIFT_DFA_ALPHABET_SIZE);
+    offset += RIFT_DFA_ALPHABET_SIZE;
+    memcpy(data + offset, table->accept_bitmap, accept_size);
+    offset += accept_size;
+    memcpy(data + offset, table->next, next_size);
+}
+
+/**
+ * @brief Read and check the dimensions of a flat encoding
+ *
+ * @param data The encoding
+ * @param size Number of bytes available at data
+ * @param swap Whether the encoding has the other byte order
+ * @param header Pointer to store the header words
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if the header is valid and the encoding fits in size
+ */
+static bool
+read_encoding_header(const uint8_t *data, size_t size, bool swap,
+                     uint32_t header[DFA_ENCODING_HEADER_WORDS], rift_regex_error_t *error)
+{
+    bool valid = data && size >= DFA_ENCODING_HEADER_WORDS * sizeof(uint32_t);
+    if (valid) {
+        memcpy(header, data, DFA_ENCODING_HEADER_WORDS * sizeof(uint32_t));
+        if (swap) {
+            swap32_array(header, DFA_ENCODING_HEADER_WORDS);
+        }
+
+        /* Row 0 is the dead state, and every byte class needs a column */
+        valid = header[0] > RIFT_DFA_DEAD_STATE && header[1] < header[0] && header[2] > 0 &&
+                header[2] <= RIFT_DFA_ALPHABET_SIZE &&
+                (uint64_t)header[0] * header[2] <= SIZE_MAX / sizeof(uint32_t) / 2 &&
+                encoded_size(header[0], header[2]) <= size;
+    }
+
+    if (!valid && error) {
+        error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+        snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                 "Invalid or truncated DFA table encoding");
+    }
+    return valid;
+}
+
+/**
+ * @brief Check that every cell and byte class of a table stays in range
+ *
+ * @param table The table
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if the table is safe to scan with
+ */
+static bool
+check_table(const rift_dfa_table_t *table, rift_regex_error_t *error)
+{
+    bool valid = true;
+    for (size_t i = 0; valid && i < RIFT_DFA_ALPHABET_SIZE; i++) {
+        valid = table->byte_class[i] < table->num_classes;
+    }
+
+    size_t cells = (size_t)table->num_states * table->num_classes;
+    for (size_t i = 0; valid && i < cells; i++) {
+        valid = table->next[i] < table->num_states;
+    }
+
+    if (!valid && error) {
+        error->code = RIFT_REGEX_ERROR_INVALID_AUTOMATON;
+        snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                 "DFA table encoding refers to a missing state or class");
+    }
+    return valid;
+}
+
+/**
+ * @brief Read a table from its flat encoding into new memory
+ *
+ * @param data The encoding, with no alignment requirement
+ * @param size Number of bytes available at data
+ * @param swap Whether the encoding has the other byte order
+ * @param used Pointer to store the size of the encoding (can be NULL)
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new table or NULL on failure
+ */
+rift_dfa_table_t *
+rift_dfa_table_decode(const uint8_t *data, size_t size, bool swap, size_t *used,
+                      rift_regex_error_t *error)
+{
+    uint32_t header[DFA_ENCODING_HEADER_WORDS];
+    if (!read_encoding_header(data, size, swap, header, error)) {
+        return NULL;
+    }
+
+    rift_dfa_table_t *table = (rift_dfa_table_t *)rift_calloc(1, sizeof(rift_dfa_table_t));
+    size_t accept_words = (header[0] + 63) / 64;
+    size_t cells = (size_t)header[0] * header[2];
+    if (table) {
+        table->next = (uint32_t *)rift_table_alloc(cells, sizeof(uint32_t));
+        table->accept_bitmap = (uint64_t *)rift_malloc(accept_words * sizeof(uint64_t));
+    }
+    if (!table || !table->next || !table->accept_bitmap) {
+        rift_dfa_table_free(table);
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_MEMORY;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Failed to allocate DFA table");
+        }
+        return NULL;
+    }
+
+    table->num_states = header[0];
+    table->start_state = header[1];
+    table->num_classes = header[2];
+
+    size_t offset = sizeof(header);
+    memcpy(table->byte_class, data + offset, RIFT_DFA_ALPHABET_SIZE);
+    offset += RIFT_DFA_ALPHABET_SIZE;
+    memcpy(table->accept_bitmap, data + offset, accept_words * sizeof(uint64_t));
+    offset += accept_words * sizeof(uint64_t);
+    memcpy(table->next, data + offset, cells * sizeof(uint32_t));
+
+    if (swap) {
+        swap64_array(table->accept_bitmap, accept_words);
+        swap32_array(table->next, cells);
+    }
+
+    if (!check_table(table, error)) {
+        rift_dfa_table_free(table);
+        return NULL;
+    }
+
+    if (used) {
+        *used = encoded_size(table->num_states, table->num_classes);
+    }
+    return table;
+}
+
+/**
+ * @brief Use a flat encoding in place as a table
+ *
+ * @param data The encoding
+ * @param size Number of bytes available at data
+ * @param table The table to fill in
+ * @param used Pointer to store the size of the encoding (can be NULL)
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if the encoding is valid, false otherwise
+ */
+bool
+rift_dfa_table_view(const uint8_t *data, size_t size, rift_dfa_table_t *table, size_t *used,
+                    rift_regex_error_t *error)
+{
+    if (!table || (uintptr_t)data % 8 != 0) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Null table or misaligned DFA table encoding");
+        }
+        return false;
+    }
+
+    uint32_t header[DFA_ENCODING_HEADER_WORDS];
+    if (!read_encoding_header(data, size, false, header, error)) {
+        return false;
+    }
+
+    size_t offset = sizeof(header);
+    table->num_states = header[0];
+    table->start_state = header[1];
+    table->num_classes = header[2];
+    memcpy(table->byte_class, data + offset, RIFT_DFA_ALPHABET_SIZE);
+    offset += RIFT_DFA_ALPHABET_SIZE;
+    table->accept_bitmap = (uint64_t *)(data + offset);
+    offset += ((header[0] + 63) / 64) * sizeof(uint64_t);
+    table->next = (uint32_t *)(data + offset);
+
+    if (!check_table(table, error)) {
+        return false;
+    }
+
+    if (used) {
+        *used = encoded_size(table->num_states, table->num_classes);
+    }
+    return true;
+}
+
+/**
+ * @brief Free a compiled DFA table
+ *
+ * @param table The table to free
+ */
+void
+rift_dfa_table_free(rift_dfa_table_t *table)
+{
+    if (!table) {
+        return;
+    }
+
+    rift_table_free(table->next);
+    rift_free(table->accept_bitmap);
+    rift_free(table);
+}
+
+/**
+ * @brief Get the next state for an input byte
+ *
+ * @param table The compiled table
+ * @param state The current row index
+ * @param byte The input byte
+ * @return The next row index (RIFT_DFA_DEAD_STATE if there is no transition)
+ */
+uint32_t
+rift_dfa_table_next(const rift_dfa_table_t *table, uint32_t state, uint8_t byte)
+{
+    if (!table || state >= table->num_states) {
+        return RIFT_DFA_DEAD_STATE;
+    }
+
+    return table->next[(size_t)state * table->num_classes + table->byte_class[byte]];
+}
+
+/**
+ * @brief Check whether a row of the table is accepting
+ *
+ * @param table The compiled table
+ * @param state The row index
+ * @return true if the state is accepting, false otherwise
+ */
+bool
+rift_dfa_table_is_accepting(const rift_dfa_table_t *table, uint32_t state)
+{
+    if (!table || state >= table->num_states) {
+        return false;
+    }
+
+    return (table->accept_bitmap[state / 64] >> (state % 64)) & 1u;
+}
+
+/**
+ * @brief Check whether the whole input is accepted by the table
+ *
+ * @param table The compiled table
+ * @param input The input buffer
+ * @param length Length of the input in bytes
+ * @return true if the entire input is accepted, false otherwise
+ */
+bool
+rift_dfa_table_matches(const rift_dfa_table_t *table, const char *input, size_t length)
+{
+    if (!table || (!input && length > 0)) {
+        return false;
+    }
+
+    const uint32_t *next = table->next;
+    const uint8_t *byte_class = table->byte_class;
+    const size_t stride = table->num_classes;
+    const unsigned char *bytes = (const unsigned char *)input;
+    uint32_t state = table->start_state;
+
+    for (size_t i = 0; i < length; i++) {
+        state = next[state * stride + byte_class[bytes[i]]];
+        if (state == RIFT_DFA_DEAD_STATE) {
+            return false;
+        }
+    }
+
+    return (table->accept_bitmap[state / 64] >> (state % 64)) & 1u;
+}
+
+/**
+ * @brief Find the longest accepted prefix of the input
+ *
+ * @param table The compiled table
+ * @param input The input buffer
+ * @param length Length of the input in bytes
+ * @param match_end Pointer to store the end offset of the longest match
+ * @return true if some prefix (possibly empty) is accepted, false otherwise
+ */
+bool
+rift_dfa_table_longest_prefix(const rift_dfa_table_t *table, const char *input, size_t length,
+                              size_t *match_end)
+{
+    if (!table || (!input && length > 0)) {
+        return false;
+    }
+
+    const uint32_t *next = table->next;
+    const uint8_t *byte_class = table->byte_class;
+    const size_t stride = table->num_classes;
+    const uint64_t *accept = table->accept_bitmap;
+    const unsigned char *bytes = (const unsigned char *)input;
+    uint32_t state = table->start_state;
+    bool found = (accept[state / 64] >> (state % 64)) & 1u;
+    size_t last_end = 0;
+
+    for (size_t i = 0; i < length; i++) {
+        state = next[state * stride + byte_class[bytes[i]]];
+        if (state == RIFT_DFA_DEAD_STATE) {
+            break;
+        }
+        if ((accept[state / 64] >> (state % 64)) & 1u) {
+            found = true;
+            last_end = i + 1;
+        }
+    }
+
+    if (found && match_end) {
+        *match_end = last_end;
+    }
+
+    return found;
+}
+
+/**
+ * @brief Find the shortest accepted prefix of the input
+ *
+ * @param table The compiled table
+ * @param input The input buffer
+ * @param length Length of the input in bytes
+ * @param match_end Pointer to store the end offset of the shortest match (can be NULL)
+ * @return true if some prefix (possibly empty) is accepted, false otherwise
+ */
+bool
+rift_dfa_table_shortest_prefix(const rift_dfa_table_t *table, const char *input, size_t length,
+                               size_t *match_end)
+{
+    if (!table || (!input && length > 0)) {
+        return false;
+    }
+
+    const uint32_t *next = table->next;
+    const uint8_t *byte_class = table->byte_class;
+    const size_t stride = table->num_classes;
+    const uint64_t *accept = table->accept_bitmap;
+    const unsigned char *bytes = (const unsigned char *)input;
+    uint32_t state = table->start_state;
+
+    for (size_t i = 0; i <= length; i++) {
+        if ((accept[state / 64] >> (state % 64)) & 1u) {
+            if (match_end) {
+                *match_end = i;
+            }
+            return true;
+        }
+        if (i == length) {
+            break;
+        }
+        state = next[state * stride + byte_class[bytes[i]]];
+        if (state == RIFT_DFA_DEAD_STATE) {
+            break;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief One input being scanned by the batch scanners
+ */
+typedef struct dfa_lane {
+    const unsigned char *bytes; /**< The input */
+    size_t length;              /**< Length of the input */
+    size_t position;            /**< Offset of the next byte to read */
+    size_t last_end;            /**< End of the longest accepted prefix so far */
+    size_t input;               /**< Index of the input in the batch */
+    uint32_t state;             /**< Current row */
+} dfa_lane_t;
+
+/**
+ * @brief Check whether a row of the table is accepting, without validation
+ */
+static inline bool
+row_accepts(const uint64_t *accept, uint32_t state)
+{
+    return (accept[state / 64] >> (state % 64)) & 1u;
+}
+
+/**
+ * @brief Start scanning the next inputs of a batch until one needs stepping
+ *
+ * Inputs that are decided before reading a byte get their result right away.
+ *
+ * @param table The compiled table
+ * @param inputs The inputs
+ * @param lengths Lengths of the inputs, NULL to use strlen
+ * @param count Number of inputs
+ * @param next_input Index of the next input to start, advanced
+ * @param whole Whether only the whole input counts as a match
+ * @param match_ends Array of results to fill
+ * @param lane The lane to load
+ * @return true if the lane was loaded, false once every input was started
+ */
+static bool
+load_lane(const rift_dfa_table_t *table, const char *const *inputs, const size_t *lengths,
+          size_t count, size_t *next_input, bool whole, size_t *match_ends, dfa_lane_t *lane)
+{
+    while (*next_input < count) {
+        size_t index = (*next_input)++;
+        const char *input = inputs[index];
+        size_t length = lengths ? lengths[index] : input ? strlen(input) : 0;
+        bool accepts = row_accepts(table->accept_bitmap, table->start_state);
+
+        if (!input && length > 0) {
+            match_ends[index] = RIFT_DFA_NO_MATCH;
+            continue;
+        }
+        if (length == 0) {
+            match_ends[index] = accepts ? 0 : RIFT_DFA_NO_MATCH;
+            continue;
+        }
+
+        lane->bytes = (const unsigned char *)input;
+        lane->length = length;
+        lane->position = 0;
+        lane->last_end = !whole && accepts ? 0 : RIFT_DFA_NO_MATCH;
+        lane->input = index;
+        lane->state = table->start_state;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Scan a batch of inputs RIFT_DFA_INTERLEAVE at a time
+ *
+ * Every pass over the lanes reads one byte of each, so the table loads of
+ * different lanes are independent and overlap. Once a lane knows where its
+ * next load goes, that entry is prefetched, giving it a whole pass to
+ * arrive. A lane that finishes takes the next input, so the lanes stay full
+ * while inputs of different lengths come and go.
+ *
+ * @param table The compiled table
+ * @param inputs The inputs
+ * @param lengths Lengths of the inputs, NULL to use strlen
+ * @param count Number of inputs
+ * @param whole Whether only the whole input counts as a match
+ * @param match_ends Array of count end offsets to fill
+ */
+static void
+scan_many(const rift_dfa_table_t *table, const char *const *inputs, const size_t *lengths,
+          size_t count, bool whole, size_t *match_ends)
+{
+    const uint32_t *next = table->next;
+    const uint8_t *byte_class = table->byte_class;
+    const size_t stride = table->num_classes;
+    const uint64_t *accept = table->accept_bitmap;
+    dfa_lane_t lanes[RIFT_DFA_INTERLEAVE];
+    size_t next_input = 0;
+    size_t active = 0;
+
+    while (active < RIFT_DFA_INTERLEAVE && load_lane(table, inputs, lengths, count, &next_input,
+                                                     whole, match_ends, &lanes[active])) {
+        active++;
+    }
+
+    while (active > 0) {
+        for (size_t i = 0; i < active;) {
+            dfa_lane_t *lane = &lanes[i];
+            uint32_t state = next[lane->state * stride + byte_class[lane->bytes[lane->position]]];
+            lane->position++;
+
+            bool finished = state == RIFT_DFA_DEAD_STATE || lane->position == lane->length;
+            if (state != RIFT_DFA_DEAD_STATE && row_accepts(accept, state) &&
+                (!whole || lane->position == lane->length)) {
+                lane->last_end = lane->position;
+            }
+
+            if (!finished) {
+                lane->state = state;
+                DFA_PREFETCH(&next[state * stride + byte_class[lane->bytes[lane->position]]]);
+                i++;
+                continue;
+            }
+
+            // Hand the lane to the next input, or close the gap with the last lane
+            match_ends[lane->input] = lane->last_end;
+            if (!load_lane(table, inputs, lengths, count, &next_input, whole, match_ends, lane)) {
+                lanes[i] = lanes[--active];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Check whether each of several inputs is accepted as a whole
+ *
+ * @param table The compiled table
+ * @param inputs The inputs (an input can be NULL if its length is 0)
+ * @param lengths Lengths of the inputs in bytes, NULL to use strlen
+ * @param count Number of inputs
+ * @param results Array of count results to fill
+ * @return true if successful, false on invalid parameters
+ */
+bool
+rift_dfa_table_matches_many(const rift_dfa_table_t *table, const char *const *inputs,
+                            const size_t *lengths, size_t count, bool *results)
+{
+    if (!table || (count > 0 && (!inputs || !results))) {
+        return false;
+    }
+
+    // Results go through a small array of ends, a block of inputs at a time
+    size_t ends[64];
+    for (size_t begin = 0; begin < count; begin += 64) {
+        size_t block = count - begin < 64 ? count - begin : 64;
+        scan_many(table, inputs + begin, lengths ? lengths + begin : NULL, block, true, ends);
+        for (size_t i = 0; i < block; i++) {
+            results[begin + i] = ends[i] != RIFT_DFA_NO_MATCH;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Find the longest accepted prefix of each of several inputs
+ *
+ * @param table The compiled table
+ * @param inputs The inputs (an input can be NULL if its length is 0)
+ * @param lengths Lengths of the inputs in bytes, NULL to use strlen
+ * @param count Number of inputs
+ * @param match_ends Array of count end offsets to fill
+ * @return true if successful, false on invalid parameters
+ */
+bool
+rift_dfa_table_longest_prefix_many(const rift_dfa_table_t *table, const char *const *inputs,
+                                   const size_t *lengths, size_t count, size_t *match_ends)
+{
+    if (!table || (count > 0 && (!inputs || !match_ends))) {
+        return false;
+    }
+
+    scan_many(table, inputs, lengths, count, false, match_ends);
+    return true;
+}
+
+/**
+ * @brief Get the memory used by a compiled table
+ *
+ * @param table The compiled table
+ * @return Size of the table storage in bytes
+ */
+size_t
+rift_dfa_table_memory_usage(const rift_dfa_table_t *table)
+{
+    if (!table) {
+        return 0;
+    }
+
+    return sizeof(rift_dfa_table_t) +
+           (size_t)table->num_states * table->num_classes * sizeof(uint32_t) +
+           ((table->num_states + 63) / 64) * sizeof(uint64_t);
+}
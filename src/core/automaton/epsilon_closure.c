@@ -0,0 +1,256 @@
+/**
+ * @file epsilon_closure.c
+ * @brief Implementation of precomputed epsilon closures for the LibRift regex engine
+ *
+ * This file computes the epsilon closure of every state once, over the frozen
+ * layout of the automaton, and provides lookups and unions over the result.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/automaton/epsilon_closure.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/automaton/frozen_automaton.h"
+#include "core/memory/memory.h"
+
+/**
+ * @brief Order state indices ascending
+ */
+static int
+compare_indices(const void *a, const void *b)
+{
+    uint32_t ia = *(const uint32_t *)a;
+    uint32_t ib = *(const uint32_t *)b;
+
+    if (ia < ib) {
+        return -1;
+    }
+    return ia > ib ? 1 : 0;
+}
+
+/**
+ * @brief Set the error for a failed allocation
+ */
+static void
+set_memory_error(rift_regex_error_t *error)
+{
+    if (error) {
+        error->code = RIFT_REGEX_ERROR_MEMORY;
+        snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                 "Failed to allocate epsilon closures");
+    }
+}
+
+/**
+ * @brief Compute the epsilon closures of every state of an automaton
+ *
+ * @param automaton The automaton
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new closure table or NULL on failure
+ */
+rift_epsilon_closures_t *
+rift_epsilon_closures_compute(const rift_regex_automaton_t *automaton, rift_regex_error_t *error)
+{
+    if (!automaton) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Null automaton provided");
+        }
+        return NULL;
+    }
+
+    rift_frozen_automaton_t *frozen = rift_frozen_automaton_create(automaton, error);
+    if (!frozen) {
+        return NULL;
+    }
+
+    rift_epsilon_closures_t *closures =
+        (rift_epsilon_closures_t *)rift_calloc(1, sizeof(rift_epsilon_closures_t));
+    if (!closures) {
+        rift_frozen_automaton_free(frozen);
+        set_memory_error(error);
+        return NULL;
+    }
+
+    uint32_t n = frozen->num_states;
+    closures->num_states = n;
+    closures->automaton = automaton;
+    closures->bitset_words = ((size_t)n + 63) / 64;
+    closures->offsets = (uint32_t *)rift_malloc(((size_t)n + 1) * sizeof(uint32_t));
+
+    /* Each closure holds at least its own state */
+    size_t capacity = n > 0 ? n : 1;
+    closures->members = (uint32_t *)rift_malloc(capacity * sizeof(uint32_t));
+
+    /* A visit stamp per state avoids clearing a visited set between closures */
+    uint32_t *stamp = (uint32_t *)rift_calloc(n > 0 ? n : 1, sizeof(uint32_t));
+    uint32_t *stack = (uint32_t *)rift_malloc((n > 0 ? n : 1) * sizeof(uint32_t));
+
+    if (!closures->offsets || !closures->members || !stamp || !stack) {
+        rift_free(stack);
+        rift_free(stamp);
+        rift_frozen_automaton_free(frozen);
+        rift_epsilon_closures_free(closures);
+        set_memory_error(error);
+        return NULL;
+    }
+
+    size_t used = 0;
+    for (uint32_t s = 0; s < n; s++) {
+        closures->offsets[s] = (uint32_t)used;
+
+        size_t top = 0;
+        stack[top++] = s;
+        stamp[s] = s + 1;
+
+        while (top > 0) {
+            uint32_t current = stack[--top];
+
+            if (used == capacity) {
+                uint32_t *grown =
+                    (uint32_t *)rift_realloc(closures->members, capacity * 2 * sizeof(uint32_t));
+                if (!grown) {
+                    rift_free(stack);
+                    rift_free(stamp);
+                    rift_frozen_automaton_free(frozen);
+                    rift_epsilon_closures_free(closures);
+                    set_memory_error(error);
+                    return NULL;
+                }
+                closures->members = grown;
+                capacity *= 2;
+            }
+            closures->members[used++] = current;
+
+            for (uint32_t e = frozen->edge_offsets[current]; e < frozen->edge_offsets[current + 1];
+                 e++) {
+                uint32_t target = frozen->edge_targets[e];
+                if (rift_frozen_automaton_edge_is_epsilon(frozen, e) && stamp[target] != s + 1) {
+                    stamp[target] = s + 1;
+                    stack[top++] = target;
+                }
+            }
+        }
+
+        qsort(&closures->members[closures->offsets[s]], used - closures->offsets[s],
+              sizeof(uint32_t), compare_indices);
+    }
+    closures->offsets[n] = (uint32_t)used;
+
+    rift_free(stack);
+    rift_free(stamp);
+    rift_frozen_automaton_free(frozen);
+    return closures;
+}
+
+/**
+ * @brief Free a closure table
+ *
+ * @param closures The closure table to free
+ */
+void
+rift_epsilon_closures_free(rift_epsilon_closures_t *closures)
+{
+    if (!closures) {
+        return;
+    }
+
+    rift_free(closures->offsets);
+    rift_free(closures->members);
+    rift_free(closures);
+}
+
+/**
+ * @brief Get the epsilon closure of a state
+ *
+ * @param closures The closure table
+ * @param state The state index
+ * @param size Pointer to store the number of states in the closure
+ * @return The sorted closure members or NULL if the index is out of range
+ */
+const uint32_t *
+rift_epsilon_closures_get(const rift_epsilon_closures_t *closures, uint32_t state, size_t *size)
+{
+    if (!closures || state >= closures->num_states) {
+        if (size) {
+            *size = 0;
+        }
+        return NULL;
+    }
+
+    if (size) {
+        *size = closures->offsets[state + 1] - closures->offsets[state];
+    }
+    return &closures->members[closures->offsets[state]];
+}
+
+/**
+ * @brief Find the index of a state in a closure table
+ *
+ * @param closures The closure table
+ * @param state The state to look up
+ * @return The state index or RIFT_EPSILON_NO_STATE if the state is unknown
+ */
+uint32_t
+rift_epsilon_closures_find_state(const rift_epsilon_closures_t *closures,
+                                 const rift_regex_state_t *state)
+{
+    if (!closures) {
+        return RIFT_EPSILON_NO_STATE;
+    }
+
+    // State IDs are indices, so the table needs no map of its own
+    size_t index = rift_automaton_get_state_index(closures->automaton, state);
+    return index < closures->num_states ? (uint32_t)index : RIFT_EPSILON_NO_STATE;
+}
+
+/**
+ * @brief Compute the union of the epsilon closures of several states
+ *
+ * @param closures The closure table
+ * @param states The state indices
+ * @param num_states Number of state indices
+ * @param scratch Zeroed scratch bitset
+ * @param out Array of at least closures->num_states entries for the sorted union
+ * @return Number of states written to out
+ */
+size_t
+rift_epsilon_closures_union(const rift_epsilon_closures_t *closures, const uint32_t *states,
+                            size_t num_states, uint64_t *scratch, uint32_t *out)
+{
+    if (!closures || !states || !scratch || !out) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < num_states; i++) {
+        if (states[i] >= closures->num_states) {
+            continue;
+        }
+        for (uint32_t m = closures->offsets[states[i]]; m < closures->offsets[states[i] + 1];
+             m++) {
+            uint32_t member = closures->members[m];
+            scratch[member / 64] |= (uint64_t)1 << (member % 64);
+        }
+    }
+
+    /* Reading the bitset back word by word yields the union in ascending order */
+    size_t count = 0;
+    for (size_t w = 0; w < closures->bitset_words; w++) {
+        uint64_t word = scratch[w];
+        if (!word) {
+            continue;
+        }
+        for (unsigned bit = 0; bit < 64; bit++) {
+            if (word & ((uint64_t)1 << bit)) {
+                out[count++] = (uint32_t)(w * 64 + bit);
+            }
+        }
+        scratch[w] = 0;
+    }
+
+    return count;
+}
@@ -0,0 +1,513 @@
+/**
+ * @file frozen_automaton.c
+ * @brief Implementation of the frozen automaton layout for the LibRift regex engine
+ *
+ * This file converts pointer-based automata into the index-based CSR layout
+ * and provides the accessors used by traversal code.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/automaton/frozen_automaton.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/automaton/state.h"
+#include "core/memory/memory.h"
+
+/**
+ * @brief Look up the index of a state
+ *
+ * @param automaton The source automaton
+ * @param state The state to look up
+ * @return The index or RIFT_FROZEN_NO_STATE if the state is not in the automaton
+ */
+static uint32_t
+find_index(const rift_regex_automaton_t *automaton, const rift_regex_state_t *state)
+{
+    size_t index = rift_automaton_get_state_index(automaton, state);
+    return index == RIFT_STATE_NO_ID ? RIFT_FROZEN_NO_STATE : (uint32_t)index;
+}
+
+/**
+ * @brief Append a string to the pool
+ *
+ * @param frozen The frozen automaton whose pool is being filled
+ * @param used Number of pool bytes already in use (updated)
+ * @param text The string to append
+ * @return Offset of the string in the pool
+ */
+static uint32_t
+pool_append(rift_frozen_automaton_t *frozen, size_t *used, const char *text)
+{
+    size_t length = strlen(text) + 1;
+    uint32_t offset = (uint32_t)*used;
+
+    memcpy(frozen->string_pool + *used, text, length);
+    *used += length;
+    return offset;
+}
+
+/**
+ * @brief Freeze an automaton into the read-only layout
+ *
+ * @param automaton The automaton to freeze
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new frozen automaton or NULL on failure
+ */
+rift_frozen_automaton_t *
+rift_frozen_automaton_create(const rift_regex_automaton_t *automaton, rift_regex_error_t *error)
+{
+    if (!automaton) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Null automaton provided");
+        }
+        return NULL;
+    }
+
+    if (automaton->num_states >= RIFT_FROZEN_NO_STATE) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_LIMIT_EXCEEDED;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Automaton has too many states to freeze");
+        }
+        return NULL;
+    }
+
+    size_t num_states = automaton->num_states;
+
+    /* First pass: size the edge arrays, the side tables, the tags and the string pool */
+    size_t num_edges = 0;
+    size_t num_captures = 0;
+    size_t num_counters = 0;
+    size_t num_lookarounds = 0;
+    size_t num_tags = 0;
+    size_t tag_limit = 0;
+    size_t pool_size = 0;
+    for (size_t i = 0; i < num_states; i++) {
+        const rift_regex_state_t *state = automaton->states[i];
+        size_t num_transitions = rift_state_get_transition_count(state);
+
+        for (size_t w = 0; w < state->num_accept_tag_words; w++) {
+            for (unsigned bit = 0; bit < 64; bit++) {
+                if (state->accept_tags[w] & ((uint64_t)1 << bit)) {
+                    num_tags++;
+                    tag_limit = w * 64 + bit + 1;
+                }
+            }
+        }
+
+        for (size_t j = 0; j < num_transitions; j++) {
+            const rift_regex_transition_t *transition = rift_state_get_transition(state, j);
+            if (!transition || !rift_transition_get_target(transition)) {
+                continue;
+            }
+            num_edges++;
+            if (!rift_transition_is_epsilon(transition) && transition->input_pattern) {
+                pool_size += strlen(transition->input_pattern) + 1;
+            }
+        }
+
+        const rift_state_capture_t *group = state->capture;
+        if (group && (group->group_name || group->is_group_start || group->is_group_end)) {
+            num_captures++;
+            if (group->group_name) {
+                pool_size += strlen(group->group_name) + 1;
+            }
+        }
+
+        if (state->flags & (RIFT_STATE_FLAG_COUNTER_START | RIFT_STATE_FLAG_COUNTER_STEP)) {
+            num_counters++;
+        }
+
+        if (state->lookaround != RIFT_STATE_NO_LOOKAROUND) {
+            num_lookarounds++;
+        }
+    }
+
+    if (num_edges >= UINT32_MAX || num_tags >= UINT32_MAX || pool_size >= RIFT_FROZEN_NO_STRING) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_LIMIT_EXCEEDED;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Automaton has too many transitions to freeze");
+        }
+        return NULL;
+    }
+
+    rift_frozen_automaton_t *frozen =
+        (rift_frozen_automaton_t *)rift_calloc(1, sizeof(rift_frozen_automaton_t));
+    if (!frozen) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_MEMORY;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Failed to allocate frozen automaton");
+        }
+        return NULL;
+    }
+
+    frozen->type = automaton->type;
+    frozen->is_deterministic = automaton->is_deterministic;
+    frozen->flags = automaton->flags;
+    frozen->num_states = (uint32_t)num_states;
+    frozen->num_edges = (uint32_t)num_edges;
+    frozen->num_captures = (uint32_t)num_captures;
+    frozen->num_counters = (uint32_t)num_counters;
+    frozen->num_lookarounds = (uint32_t)num_lookarounds;
+    frozen->num_accept_tags = (uint32_t)num_tags;
+    frozen->accept_tag_limit = (uint32_t)tag_limit;
+    frozen->string_pool_size = pool_size;
+
+    frozen->accept_bitmap = (uint64_t *)rift_calloc((num_states + 63) / 64 + 1, sizeof(uint64_t));
+    frozen->state_flags = (uint8_t *)rift_calloc(num_states + 1, sizeof(uint8_t));
+    /* The arrays a scan walks on every step, page-backed once they are large */
+    frozen->edge_offsets = (uint32_t *)rift_table_alloc(num_states + 1, sizeof(uint32_t));
+    frozen->edge_targets = (uint32_t *)rift_table_alloc(num_edges + 1, sizeof(uint32_t));
+    frozen->edge_flags = (uint8_t *)rift_table_alloc(num_edges + 1, sizeof(uint8_t));
+    frozen->edge_priorities = (int32_t *)rift_table_alloc(num_edges + 1, sizeof(int32_t));
+    frozen->edge_predicates = (rift_transition_predicate_t *)rift_calloc(
+        num_edges + 1, sizeof(rift_transition_predicate_t));
+    frozen->edge_pattern_offsets = (uint32_t *)rift_malloc((num_edges + 1) * sizeof(uint32_t));
+    frozen->captures =
+        (rift_frozen_capture_t *)rift_calloc(num_captures + 1, sizeof(rift_frozen_capture_t));
+    frozen->counters =
+        (rift_frozen_counter_t *)rift_calloc(num_counters + 1, sizeof(rift_frozen_counter_t));
+    frozen->lookarounds = (rift_frozen_lookaround_t *)rift_calloc(
+        num_lookarounds + 1, sizeof(rift_frozen_lookaround_t));
+    frozen->accept_tag_offsets = (uint32_t *)rift_calloc(num_states + 1, sizeof(uint32_t));
+    frozen->accept_tags = (uint32_t *)rift_malloc((num_tags + 1) * sizeof(uint32_t));
+    frozen->string_pool = (char *)rift_malloc(pool_size + 1);
+
+    if (!frozen->accept_bitmap || !frozen->state_flags || !frozen->edge_offsets ||
+        !frozen->edge_targets || !frozen->edge_flags || !frozen->edge_priorities ||
+        !frozen->edge_predicates || !frozen->edge_pattern_offsets || !frozen->captures ||
+        !frozen->counters || !frozen->lookarounds || !frozen->accept_tag_offsets ||
+        !frozen->accept_tags || !frozen->string_pool) {
+        rift_frozen_automaton_free(frozen);
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_MEMORY;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Failed to allocate frozen automaton arrays");
+        }
+        return NULL;
+    }
+
+    frozen->start_state = find_index(automaton, automaton->initial_state);
+
+    /* Second pass: fill the arrays in state order */
+    size_t edge = 0;
+    size_t capture = 0;
+    size_t counter = 0;
+    size_t lookaround = 0;
+    size_t tag = 0;
+    size_t pool_used = 0;
+    for (size_t i = 0; i < num_states; i++) {
+        const rift_regex_state_t *state = automaton->states[i];
+
+        frozen->edge_offsets[i] = (uint32_t)edge;
+        frozen->state_flags[i] = (uint8_t)state->flags;
+        if (rift_state_is_accepting(state)) {
+            frozen->accept_bitmap[i / 64] |= (uint64_t)1 << (i % 64);
+        }
+
+        frozen->accept_tag_offsets[i] = (uint32_t)tag;
+        for (size_t w = 0; w < state->num_accept_tag_words; w++) {
+            for (unsigned bit = 0; bit < 64; bit++) {
+                if (state->accept_tags[w] & ((uint64_t)1 << bit)) {
+                    frozen->accept_tags[tag++] = (uint32_t)(w * 64 + bit);
+                }
+            }
+        }
+
+        const rift_state_capture_t *group = state->capture;
+        if (group && (group->group_name || group->is_group_start || group->is_group_end)) {
+            rift_frozen_capture_t *entry = &frozen->captures[capture++];
+            entry->state = (uint32_t)i;
+            entry->is_group_start = group->is_group_start;
+            entry->is_group_end = group->is_group_end;
+            entry->name_offset = group->group_name
+                                     ? pool_append(frozen, &pool_used, group->group_name)
+                                     : RIFT_FROZEN_NO_STRING;
+        }
+
+        if (state->flags & (RIFT_STATE_FLAG_COUNTER_START | RIFT_STATE_FLAG_COUNTER_STEP)) {
+            rift_frozen_counter_t *entry = &frozen->counters[counter++];
+            entry->state = (uint32_t)i;
+            entry->start = find_index(automaton, state->repeat_start);
+            entry->min = state->repeat_min;
+            entry->max = state->repeat_max;
+            entry->greedy = state->repeat_greedy;
+        }
+
+        if (state->lookaround != RIFT_STATE_NO_LOOKAROUND) {
+            rift_frozen_lookaround_t *entry = &frozen->lookarounds[lookaround++];
+            entry->state = (uint32_t)i;
+            entry->index = state->lookaround;
+        }
+
+        size_t num_transitions = rift_state_get_transition_count(state);
+        for (size_t j = 0; j < num_transitions; j++) {
+            const rift_regex_transition_t *transition = rift_state_get_transition(state, j);
+            if (!transition || !rift_transition_get_target(transition)) {
+                continue;
+            }
+
+            uint32_t target = find_index(automaton, rift_transition_get_target(transition));
+            if (target == RIFT_FROZEN_NO_STATE) {
+                rift_frozen_automaton_free(frozen);
+                if (error) {
+                    error->code = RIFT_REGEX_ERROR_INVALID_AUTOMATON;
+                    snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                             "Transition targets a state outside the automaton");
+                }
+                return NULL;
+            }
+
+            frozen->edge_targets[edge] = target;
+            frozen->edge_priorities[edge] = transition->priority;
+            frozen->edge_pattern_offsets[edge] = RIFT_FROZEN_NO_STRING;
+            if (rift_transition_is_epsilon(transition)) {
+                frozen->edge_flags[edge] = RIFT_FROZEN_EDGE_EPSILON;
+            } else {
+                frozen->edge_predicates[edge] = transition->predicate;
+                if (transition->input_pattern) {
+                    frozen->edge_pattern_offsets[edge] =
+                        pool_append(frozen, &pool_used, transition->input_pattern);
+                }
+            }
+            edge++;
+        }
+    }
+    frozen->edge_offsets[num_states] = (uint32_t)edge;
+    frozen->accept_tag_offsets[num_states] = (uint32_t)tag;
+
+    return frozen;
+}
+
+/**
+ * @brief Free a frozen automaton
+ *
+ * @param frozen The frozen automaton to free
+ */
+void
+rift_frozen_automaton_free(rift_frozen_automaton_t *frozen)
+{
+    if (!frozen) {
+        return;
+    }
+
+    rift_free(frozen->accept_bitmap);
+    rift_free(frozen->state_flags);
+    rift_table_free(frozen->edge_offsets);
+    rift_table_free(frozen->edge_targets);
+    rift_table_free(frozen->edge_flags);
+    rift_table_free(frozen->edge_priorities);
+    rift_free(frozen->edge_predicates);
+    rift_free(frozen->edge_pattern_offsets);
+    rift_free(frozen->captures);
+    rift_free(frozen->counters);
+    rift_free(frozen->lookarounds);
+    rift_free(frozen->accept_tag_offsets);
+    rift_free(frozen->accept_tags);
+    rift_free(frozen->string_pool);
+    rift_free(frozen);
+}
+
+/**
+ * @brief Check whether a state is accepting
+ *
+ * @param frozen The frozen automaton
+ * @param state The state index
+ * @return true if the state is accepting, false otherwise
+ */
+bool
+rift_frozen_automaton_is_accepting(const rift_frozen_automaton_t *frozen, uint32_t state)
+{
+    if (!frozen || state >= frozen->num_states) {
+        return false;
+    }
+
+    return (frozen->accept_bitmap[state / 64] >> (state % 64)) & 1u;
+}
+
+/**
+ * @brief Check whether an edge is an epsilon edge
+ *
+ * @param frozen The frozen automaton
+ * @param edge The edge index
+ * @return true if the edge is an epsilon edge, false otherwise
+ */
+bool
+rift_frozen_automaton_edge_is_epsilon(const rift_frozen_automaton_t *frozen, uint32_t edge)
+{
+    if (!frozen || edge >= frozen->num_edges) {
+        return false;
+    }
+
+    return (frozen->edge_flags[edge] & RIFT_FROZEN_EDGE_EPSILON) != 0;
+}
+
+/**
+ * @brief Get the pattern text of an edge
+ *
+ * @param frozen The frozen automaton
+ * @param edge The edge index
+ * @return The pattern or NULL for epsilon edges
+ */
+const char *
+rift_frozen_automaton_get_edge_pattern(const rift_frozen_automaton_t *frozen, uint32_t edge)
+{
+    if (!frozen || edge >= frozen->num_edges ||
+        frozen->edge_pattern_offsets[edge] == RIFT_FROZEN_NO_STRING) {
+        return NULL;
+    }
+
+    return frozen->string_pool + frozen->edge_pattern_offsets[edge];
+}
+
+/**
+ * @brief Find the capture metadata of a state
+ *
+ * @param frozen The frozen automaton
+ * @param state The state index
+ * @return The capture entry or NULL if the state has no group information
+ */
+const rift_frozen_capture_t *
+rift_frozen_automaton_find_capture(const rift_frozen_automaton_t *frozen, uint32_t state)
+{
+    if (!frozen) {
+        return NULL;
+    }
+
+    /* Entries are sorted by state index */
+    size_t low = 0;
+    size_t high = frozen->num_captures;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (frozen->captures[mid].state < state) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    if (low < frozen->num_captures && frozen->captures[low].state == state) {
+        return &frozen->captures[low];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Find the counted loop metadata of a state
+ *
+ * @param frozen The frozen automaton
+ * @param state The state index
+ * @return The counter entry or NULL if the state is not a counting state
+ */
+const rift_frozen_counter_t *
+rift_frozen_automaton_find_counter(const rift_frozen_automaton_t *frozen, uint32_t state)
+{
+    if (!frozen) {
+        return NULL;
+    }
+
+    /* Entries are sorted by state index */
+    size_t low = 0;
+    size_t high = frozen->num_counters;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (frozen->counters[mid].state < state) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    if (low < frozen->num_counters && frozen->counters[low].state == state) {
+        return &frozen->counters[low];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Find the lookaround metadata of a state
+ *
+ * @param frozen The frozen automaton
+ * @param state The state index
+ * @return The lookaround entry or NULL if the state runs no lookaround
+ */
+const rift_frozen_lookaround_t *
+rift_frozen_automaton_find_lookaround(const rift_frozen_automaton_t *frozen, uint32_t state)
+{
+    if (!frozen) {
+        return NULL;
+    }
+
+    /* Entries are sorted by state index */
+    size_t low = 0;
+    size_t high = frozen->num_lookarounds;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (frozen->lookarounds[mid].state < state) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    if (low < frozen->num_lookarounds && frozen->lookarounds[low].state == state) {
+        return &frozen->lookarounds[low];
+    }
+    return NULL;
+}
+
+/**
+ * @brief Get the accept tags of a state
+ *
+ * @param frozen The frozen automaton
+ * @param state The state index
+ * @param count Pointer to store the number of tags
+ * @return The tags in ascending order, or NULL if the state has none
+ */
+const uint32_t *
+rift_frozen_automaton_get_accept_tags(const rift_frozen_automaton_t *frozen, uint32_t state,
+                                      uint32_t *count)
+{
+    if (!frozen || !count || state >= frozen->num_states) {
+        if (count) {
+            *count = 0;
+        }
+        return NULL;
+    }
+
+    uint32_t begin = frozen->accept_tag_offsets[state];
+    *count = frozen->accept_tag_offsets[state + 1] - begin;
+    return *count > 0 ? &frozen->accept_tags[begin] : NULL;
+}
+
+/**
+ * @brief Get the memory used by a frozen automaton
+ *
+ * @param frozen The frozen automaton
+ * @return Size of the frozen storage in bytes
+ */
+size_t
+rift_frozen_automaton_memory_usage(const rift_frozen_automaton_t *frozen)
+{
+    if (!frozen) {
+        return 0;
+    }
+
+    size_t per_state = sizeof(uint8_t) + sizeof(uint32_t) * 2;
+    size_t per_edge = sizeof(uint32_t) * 2 + sizeof(uint8_t) + sizeof(int32_t) +
+                      sizeof(rift_transition_predicate_t);
+
+    return sizeof(rift_frozen_automaton_t) + frozen->num_states * per_state +
+           ((frozen->num_states + 63) / 64) * sizeof(uint64_t) + frozen->num_edges * per_edge +
+           frozen->num_captures * sizeof(rift_frozen_capture_t) +
+           frozen->num_counters * sizeof(rift_frozen_counter_t) +
+           frozen->num_lookarounds * sizeof(rift_frozen_lookaround_t) +
+           frozen->num_accept_tags * sizeof(uint32_t) + frozen->string_pool_size;
+}
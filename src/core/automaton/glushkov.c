@@ -0,0 +1,327 @@
+/**
+ * @file glushkov.c
+ * @brief Implementation of the Glushkov construction for the LibRift regex engine
+ *
+ * This file builds the Glushkov automaton of an NFA through its frozen form.
+ * The closures of the start state and of every position are walked depth
+ * first in edge order, numbering positions as they are first reached, then
+ * one state is created per closure and given an edge per position the
+ * closure reaches. Edges with the same target and pattern lead to the same
+ * future, so they share a position.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/automaton/glushkov.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/automaton/frozen_automaton.h"
+#include "core/automaton/state.h"
+#include "core/memory/memory.h"
+
+/**
+ * @brief Position entry of an edge that is not a position
+ */
+#define NO_POSITION UINT32_MAX
+
+/**
+ * @brief Working state of the construction
+ *
+ * Closure 0 is the start state's and closure p + 1 is position p's, stored
+ * back to back in follow from follow_offsets[i] to follow_offsets[i + 1].
+ */
+typedef struct {
+    const rift_frozen_automaton_t *nfa; /**< The frozen NFA */
+    uint32_t *position_of;              /**< Position of each edge, or none */
+    uint32_t *edges;                    /**< Edge of each position */
+    uint32_t num_positions;             /**< Positions numbered so far */
+    uint32_t *first_position;           /**< First position into each state, or none */
+    uint32_t *next_position;            /**< Next position into the same state */
+    uint32_t *position_seen;            /**< Last closure that reached a position */
+    uint32_t *follow;                   /**< Positions reached by each closure */
+    size_t follow_count;                /**< Entries of follow in use */
+    size_t follow_capacity;             /**< Entries allocated for follow */
+    size_t *follow_offsets;             /**< First entry of each closure, and the end */
+    bool *accepting;                    /**< Whether each closure holds an accepting state */
+    uint32_t *visited;                  /**< Last closure that reached a state */
+    uint32_t generation;                /**< Number of the current closure */
+    uint32_t *stack_states;             /**< States of the closure walk */
+    uint32_t *stack_cursors;            /**< Next edge of each state on the walk */
+} glushkov_builder_t;
+
+/**
+ * @brief Record an error of the construction
+ */
+static void
+set_error(rift_regex_error_t *error, rift_regex_error_code_t code, const char *message)
+{
+    if (error) {
+        error->code = code;
+        snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH, "%s", message);
+    }
+}
+
+/**
+ * @brief Append a position to the closure being walked
+ */
+static bool
+append_follow(glushkov_builder_t *builder, uint32_t position)
+{
+    if (builder->follow_count == builder->follow_capacity) {
+        size_t capacity = builder->follow_capacity ? builder->follow_capacity * 2 : 64;
+        uint32_t *follow =
+            (uint32_t *)rift_realloc(builder->follow, capacity * sizeof(uint32_t));
+        if (!follow) {
+            return false;
+        }
+        builder->follow = follow;
+        builder->follow_capacity = capacity;
+    }
+    builder->follow[builder->follow_count++] = position;
+    return true;
+}
+
+/**
+ * @brief Find the position of an edge, numbering it if it has none yet
+ */
+static uint32_t
+edge_position(glushkov_builder_t *builder, uint32_t edge)
+{
+    const rift_frozen_automaton_t *nfa = builder->nfa;
+    if (builder->position_of[edge] != NO_POSITION) {
+        return builder->position_of[edge];
+    }
+
+    uint32_t target = nfa->edge_targets[edge];
+    const char *pattern = rift_frozen_automaton_get_edge_pattern(nfa, edge);
+    for (uint32_t p = builder->first_position[target]; p != NO_POSITION;
+         p = builder->next_position[p]) {
+        const char *other = rift_frozen_automaton_get_edge_pattern(nfa, builder->edges[p]);
+        if (pattern && other && strcmp(pattern, other) == 0) {
+            builder->position_of[edge] = p;
+            return p;
+        }
+    }
+
+    uint32_t position = builder->num_positions++;
+    builder->edges[position] = edge;
+    builder->position_seen[position] = 0;
+    builder->next_position[position] = builder->first_position[target];
+    builder->first_position[target] = position;
+    builder->position_of[edge] = position;
+    return position;
+}
+
+/**
+ * @brief Walk the epsilon closure of a state, collecting its positions in edge order
+ *
+ * A state's edges are taken in order and an epsilon edge is followed before
+ * the next edge, as the Pike VM adds threads, so positions come out in the
+ * order of preference. Edges not numbered yet get the next positions.
+ *
+ * @param builder The builder
+ * @param state The NFA state
+ * @param closure Index of the closure being walked
+ * @return true on success, false on allocation failure
+ */
+static bool
+walk_closure(glushkov_builder_t *builder, uint32_t state, uint32_t closure)
+{
+    const rift_frozen_automaton_t *nfa = builder->nfa;
+    size_t top = 0;
+
+    builder->follow_offsets[closure] = builder->follow_count;
+    builder->accepting[closure] = false;
+    builder->generation++;
+    builder->visited[state] = builder->generation;
+    builder->stack_states[top] = state;
+    builder->stack_cursors[top++] = nfa->edge_offsets[state];
+    while (top > 0) {
+        uint32_t current = builder->stack_states[top - 1];
+        uint32_t e = builder->stack_cursors[top - 1];
+        if (e == nfa->edge_offsets[current]) {
+            builder->accepting[closure] =
+                builder->accepting[closure] || rift_frozen_automaton_is_accepting(nfa, current);
+        }
+        if (e == nfa->edge_offsets[current + 1]) {
+            top--;
+            continue;
+        }
+        builder->stack_cursors[top - 1] = e + 1;
+
+        if (nfa->edge_flags[e] & RIFT_FROZEN_EDGE_EPSILON) {
+            uint32_t target = nfa->edge_targets[e];
+            if (builder->visited[target] != builder->generation) {
+                builder->visited[target] = builder->generation;
+                builder->stack_states[top] = target;
+                builder->stack_cursors[top++] = nfa->edge_offsets[target];
+            }
+            continue;
+        }
+
+        // A position reached again adds nothing, as the Pike VM drops the later thread
+        uint32_t position = edge_position(builder, e);
+        if (builder->position_seen[position] == builder->generation) {
+            continue;
+        }
+        builder->position_seen[position] = builder->generation;
+        if (!append_follow(builder, position)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Create the states and edges of the Glushkov automaton
+ *
+ * @param builder The builder, holding every closure
+ * @param glushkov The automaton to fill
+ * @return true if successful, false on allocation failure
+ */
+static bool
+add_positions(const glushkov_builder_t *builder, rift_regex_automaton_t *glushkov)
+{
+    uint32_t num_states = builder->num_positions + 1;
+    rift_regex_state_t **states =
+        (rift_regex_state_t **)rift_malloc(num_states * sizeof(rift_regex_state_t *));
+    if (!states) {
+        return false;
+    }
+
+    bool built = true;
+    for (uint32_t i = 0; built && i < num_states; i++) {
+        states[i] = rift_automaton_create_state(glushkov, builder->accepting[i]);
+        built = states[i] != NULL;
+    }
+    built = built && rift_automaton_set_initial_state(glushkov, states[0]);
+
+    for (uint32_t i = 0; built && i < num_states; i++) {
+        for (size_t f = builder->follow_offsets[i]; built && f < builder->follow_offsets[i + 1];
+             f++) {
+            uint32_t position = builder->follow[f];
+            const char *pattern =
+                rift_frozen_automaton_get_edge_pattern(builder->nfa, builder->edges[position]);
+            built = !pattern || rift_state_add_transition(states[i], states[position + 1], pattern);
+        }
+    }
+
+    rift_free(states);
+    return built;
+}
+
+/**
+ * @brief Free the working state of the construction
+ */
+static void
+builder_free(glushkov_builder_t *builder)
+{
+    rift_frozen_automaton_free((rift_frozen_automaton_t *)builder->nfa);
+    rift_free(builder->position_of);
+    rift_free(builder->edges);
+    rift_free(builder->first_position);
+    rift_free(builder->next_position);
+    rift_free(builder->position_seen);
+    rift_free(builder->follow);
+    rift_free(builder->follow_offsets);
+    rift_free(builder->accepting);
+    rift_free(builder->visited);
+    rift_free(builder->stack_states);
+    rift_free(builder->stack_cursors);
+}
+
+/**
+ * @brief Check whether an NFA keeps data on its states besides their edges
+ */
+static bool
+has_state_data(const rift_frozen_automaton_t *frozen)
+{
+    if (frozen->num_captures > 0 || frozen->num_counters > 0 || frozen->num_lookarounds > 0 ||
+        frozen->num_accept_tags > 0) {
+        return true;
+    }
+    for (uint32_t i = 0; i < frozen->num_states; i++) {
+        if (frozen->state_flags[i] != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Build the Glushkov automaton of an NFA
+ */
+rift_regex_automaton_t *
+rift_automaton_to_glushkov(const rift_regex_automaton_t *automaton, rift_regex_error_t *error)
+{
+    if (!automaton) {
+        set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER, "Null automaton provided");
+        return NULL;
+    }
+
+    glushkov_builder_t builder = {0};
+    builder.nfa = rift_frozen_automaton_create(automaton, error);
+    if (!builder.nfa) {
+        return NULL;
+    }
+
+    const rift_frozen_automaton_t *frozen = builder.nfa;
+    if (frozen->start_state == RIFT_FROZEN_NO_STATE) {
+        set_error(error, RIFT_REGEX_ERROR_INVALID_AUTOMATON, "Automaton has no initial state");
+        builder_free(&builder);
+        return NULL;
+    }
+    if (has_state_data(frozen)) {
+        set_error(error, RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE,
+                  "Captures, assertions and counted loops need epsilon edges");
+        builder_free(&builder);
+        return NULL;
+    }
+
+    // Every closure is the start state's or a position's, and every position an edge
+    size_t num_edges = frozen->num_edges;
+    builder.position_of = (uint32_t *)rift_malloc((num_edges + 1) * sizeof(uint32_t));
+    builder.edges = (uint32_t *)rift_malloc((num_edges + 1) * sizeof(uint32_t));
+    builder.first_position = (uint32_t *)rift_malloc(frozen->num_states * sizeof(uint32_t));
+    builder.next_position = (uint32_t *)rift_malloc((num_edges + 1) * sizeof(uint32_t));
+    builder.position_seen = (uint32_t *)rift_malloc((num_edges + 1) * sizeof(uint32_t));
+    builder.follow_offsets = (size_t *)rift_malloc((num_edges + 2) * sizeof(size_t));
+    builder.accepting = (bool *)rift_malloc((num_edges + 1) * sizeof(bool));
+    builder.visited = (uint32_t *)rift_calloc(frozen->num_states, sizeof(uint32_t));
+    builder.stack_states = (uint32_t *)rift_malloc(frozen->num_states * sizeof(uint32_t));
+    builder.stack_cursors = (uint32_t *)rift_malloc(frozen->num_states * sizeof(uint32_t));
+    bool built = builder.position_of && builder.edges && builder.first_position &&
+                 builder.next_position && builder.position_seen && builder.follow_offsets &&
+                 builder.accepting && builder.visited && builder.stack_states &&
+                 builder.stack_cursors;
+    for (size_t e = 0; built && e < num_edges; e++) {
+        builder.position_of[e] = NO_POSITION;
+    }
+    for (uint32_t i = 0; built && i < frozen->num_states; i++) {
+        builder.first_position[i] = NO_POSITION;
+    }
+
+    // New positions are appended as the closures of earlier ones reach them
+    built = built && walk_closure(&builder, frozen->start_state, 0);
+    for (uint32_t p = 0; built && p < builder.num_positions; p++) {
+        built = walk_closure(&builder, frozen->edge_targets[builder.edges[p]], p + 1);
+    }
+
+    rift_regex_automaton_t *glushkov = NULL;
+    if (built) {
+        builder.follow_offsets[builder.num_positions + 1] = builder.follow_count;
+        glushkov = rift_automaton_create(RIFT_AUTOMATON_NFA);
+        built = glushkov && rift_automaton_set_flags(glushkov, frozen->flags) &&
+                add_positions(&builder, glushkov);
+    }
+    builder_free(&builder);
+
+    if (!built) {
+        set_error(error, RIFT_REGEX_ERROR_MEMORY, "Failed to allocate Glushkov automaton");
+        rift_automaton_free(glushkov);
+        return NULL;
+    }
+    return glushkov;
+}
@@ -0,0 +1,616 @@
+/**
+ * @file hopcroft.c
+ * @brief Implementation of Hopcroft DFA minimization for the LibRift regex engine
+ *
+ * This file refines the accepting / non-accepting partition of a DFA table,
+ * or a finer one keyed by accept tags, with Hopcroft's algorithm. Blocks are
+ * contiguous ranges of one element array, a split always relabels the smaller
+ * half, and splitters are (block, class) pairs, so no state signatures are
+ * ever built.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/automaton/hopcroft.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/automaton/frozen_automaton.h"
+#include "core/automaton/state.h"
+#include "core/memory/memory.h"
+
+/**
+ * @brief Working storage of a partition refinement
+ */
+typedef struct {
+    uint32_t *elements;      /**< Rows grouped by block */
+    uint32_t *position;      /**< Position of each row in elements */
+    uint32_t *block_first;   /**< First position of each block */
+    uint32_t *block_end;     /**< One past the last position of each block */
+    uint32_t *marked;        /**< Number of marked rows at the start of each block */
+    uint32_t *touched;       /**< Blocks with marked rows */
+    uint32_t *splitter;      /**< Copy of the rows of the current splitter */
+    uint32_t *inverse_first; /**< Offsets into inverse per (class, target) */
+    uint32_t *inverse;       /**< Source rows of every transition */
+    uint32_t *work_blocks;   /**< Pending splitter blocks */
+    uint16_t *work_classes;  /**< Pending splitter classes */
+    uint8_t *in_work;        /**< Whether (block, class) is pending */
+    uint32_t *label_first;   /**< First position of each label in the initial partition */
+} hopcroft_work_t;
+
+/**
+ * @brief Free the working storage of a partition refinement
+ */
+static void
+hopcroft_work_free(hopcroft_work_t *work)
+{
+    rift_free(work->elements);
+    rift_free(work->position);
+    rift_free(work->block_first);
+    rift_free(work->block_end);
+    rift_free(work->marked);
+    rift_free(work->touched);
+    rift_free(work->splitter);
+    rift_free(work->inverse_first);
+    rift_free(work->inverse);
+    rift_free(work->work_blocks);
+    rift_free(work->work_classes);
+    rift_free(work->in_work);
+    rift_free(work->label_first);
+}
+
+/**
+ * @brief Add a splitter to the work list
+ */
+static void
+push_splitter(hopcroft_work_t *work, size_t *count, uint32_t block, uint16_t class_index,
+              uint32_t num_classes)
+{
+    work->in_work[(size_t)block * num_classes + class_index] = 1;
+    work->work_blocks[*count] = block;
+    work->work_classes[*count] = class_index;
+    (*count)++;
+}
+
+/**
+ * @brief Partition the rows of a DFA table into equivalence classes
+ *
+ * @param table The compiled DFA table
+ * @param block_of Array of table->num_states entries for the block of every row
+ * @param num_blocks Pointer to store the number of blocks
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+bool
+rift_hopcroft_partition(const rift_dfa_table_t *table, uint32_t *block_of, uint32_t *num_blocks,
+                        rift_regex_error_t *error)
+{
+    return rift_hopcroft_partition_labeled(table, NULL, 2, block_of, num_blocks, error);
+}
+
+/**
+ * @brief Partition the rows of a DFA table, starting from labelled accept classes
+ *
+ * @param table The compiled DFA table
+ * @param labels Initial class of every row, or NULL to split on acceptance alone
+ * @param num_labels Number of distinct label values
+ * @param block_of Array of table->num_states entries for the block of every row
+ * @param num_blocks Pointer to store the number of blocks
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+bool
+rift_hopcroft_partition_labeled(const rift_dfa_table_t *table, const uint32_t *labels,
+                                uint32_t num_labels, uint32_t *block_of, uint32_t *num_blocks,
+                                rift_regex_error_t *error)
+{
+    if (!table || !block_of || !num_blocks || (!labels && num_labels < 2)) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Invalid parameters for DFA partitioning");
+        }
+        return false;
+    }
+
+    uint32_t n = table->num_states;
+    uint32_t num_classes = table->num_classes;
+    size_t num_pairs = (size_t)n * num_classes;
+
+    hopcroft_work_t work;
+    memset(&work, 0, sizeof(work));
+    work.elements = (uint32_t *)rift_malloc(n * sizeof(uint32_t));
+    work.position = (uint32_t *)rift_malloc(n * sizeof(uint32_t));
+    work.block_first = (uint32_t *)rift_malloc(n * sizeof(uint32_t));
+    work.block_end = (uint32_t *)rift_malloc(n * sizeof(uint32_t));
+    work.marked = (uint32_t *)rift_calloc(n, sizeof(uint32_t));
+    work.touched = (uint32_t *)rift_malloc(n * sizeof(uint32_t));
+    work.splitter = (uint32_t *)rift_malloc(n * sizeof(uint32_t));
+    work.inverse_first = (uint32_t *)rift_calloc(num_pairs + 1, sizeof(uint32_t));
+    work.inverse = (uint32_t *)rift_malloc((num_pairs + 1) * sizeof(uint32_t));
+    work.work_blocks = (uint32_t *)rift_malloc((num_pairs + 1) * sizeof(uint32_t));
+    work.work_classes = (uint16_t *)rift_malloc((num_pairs + 1) * sizeof(uint16_t));
+    work.in_work = (uint8_t *)rift_calloc(num_pairs + 1, sizeof(uint8_t));
+    work.label_first = (uint32_t *)rift_calloc((size_t)num_labels + 1, sizeof(uint32_t));
+
+    if (!work.elements || !work.position || !work.block_first || !work.block_end ||
+        !work.marked || !work.touched || !work.splitter || !work.inverse_first ||
+        !work.inverse || !work.work_blocks || !work.work_classes || !work.in_work ||
+        !work.label_first) {
+        hopcroft_work_free(&work);
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_MEMORY;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Failed to allocate DFA partition");
+        }
+        return false;
+    }
+
+    /* Only rows reachable from the start state take part; the dead row always does */
+    for (uint32_t i = 0; i < n; i++) {
+        block_of[i] = RIFT_HOPCROFT_NO_BLOCK;
+    }
+
+    uint32_t num_reachable = 0;
+    block_of[RIFT_DFA_DEAD_STATE] = 0;
+    work.elements[num_reachable++] = RIFT_DFA_DEAD_STATE;
+    if (table->start_state != RIFT_DFA_DEAD_STATE) {
+        block_of[table->start_state] = 0;
+        work.elements[num_reachable++] = table->start_state;
+    }
+
+    for (uint32_t head = 0; head < num_reachable; head++) {
+        const uint32_t *row = &table->next[(size_t)work.elements[head] * num_classes];
+        for (uint32_t k = 0; k < num_classes; k++) {
+            if (block_of[row[k]] == RIFT_HOPCROFT_NO_BLOCK) {
+                block_of[row[k]] = 0;
+                work.elements[num_reachable++] = row[k];
+            }
+        }
+    }
+
+    /* Inverse transitions, grouped by (class, target) */
+    for (uint32_t i = 0; i < num_reachable; i++) {
+        uint32_t source = work.elements[i];
+        for (uint32_t k = 0; k < num_classes; k++) {
+            work.inverse_first[(size_t)k * n + table->next[(size_t)source * num_classes + k]]++;
+        }
+    }
+    for (size_t p = 0; p < num_pairs; p++) {
+        work.inverse_first[p + 1] += work.inverse_first[p];
+    }
+
+    /* Filling backwards leaves inverse_first[p] at the start of list p */
+    for (uint32_t i = 0; i < num_reachable; i++) {
+        uint32_t source = work.elements[i];
+        for (uint32_t k = 0; k < num_classes; k++) {
+            size_t pair = (size_t)k * n + table->next[(size_t)source * num_classes + k];
+            work.inverse[--work.inverse_first[pair]] = source;
+        }
+    }
+
+    /* Initial partition: one block per label in use, by counting sort on the label */
+    for (uint32_t row = 0; row < n; row++) {
+        if (block_of[row] == RIFT_HOPCROFT_NO_BLOCK) {
+            continue;
+        }
+
+        uint32_t label = labels ? labels[row] : (rift_dfa_table_is_accepting(table, row) ? 1 : 0);
+        if (label >= num_labels) {
+            hopcroft_work_free(&work);
+            if (error) {
+                error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+                snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                         "DFA row %u has label %u outside of %u labels", row, label, num_labels);
+            }
+            return false;
+        }
+        block_of[row] = label;
+        work.label_first[label + 1]++;
+    }
+    for (uint32_t l = 0; l < num_labels; l++) {
+        work.label_first[l + 1] += work.label_first[l];
+    }
+
+    uint32_t blocks = 0;
+    uint32_t largest = 0;
+    for (uint32_t l = 0; l < num_labels; l++) {
+        if (work.label_first[l + 1] == work.label_first[l]) {
+            continue;
+        }
+        work.block_first[blocks] = work.label_first[l];
+        work.block_end[blocks] = work.label_first[l + 1];
+        if (work.block_end[blocks] - work.block_first[blocks] >
+            work.block_end[largest] - work.block_first[largest]) {
+            largest = blocks;
+        }
+        blocks++;
+    }
+
+    /* block_of holds the label until every row has its position */
+    for (uint32_t row = 0; row < n; row++) {
+        if (block_of[row] != RIFT_HOPCROFT_NO_BLOCK) {
+            uint32_t position = work.label_first[block_of[row]]++;
+            work.position[row] = position;
+            work.elements[position] = row;
+        }
+    }
+    for (uint32_t b = 0; b < blocks; b++) {
+        for (uint32_t i = work.block_first[b]; i < work.block_end[b]; i++) {
+            block_of[work.elements[i]] = b;
+        }
+    }
+
+    /* Every initial block but the largest must split the others */
+    size_t pending = 0;
+    for (uint32_t b = 0; b < blocks; b++) {
+        if (b == largest) {
+            continue;
+        }
+        for (uint32_t k = 0; k < num_classes; k++) {
+            push_splitter(&work, &pending, b, (uint16_t)k, num_classes);
+        }
+    }
+
+    while (pending > 0) {
+        pending--;
+        uint32_t splitter_block = work.work_blocks[pending];
+        uint16_t class_index = work.work_classes[pending];
+        work.in_work[(size_t)splitter_block * num_classes + class_index] = 0;
+
+        /* The splitter may itself be split below, so refine against a copy */
+        uint32_t splitter_size = 0;
+        for (uint32_t i = work.block_first[splitter_block]; i < work.block_end[splitter_block];
+             i++) {
+            work.splitter[splitter_size++] = work.elements[i];
+        }
+
+        /* Mark every row entering the splitter on this class */
+        uint32_t num_touched = 0;
+        for (uint32_t i = 0; i < splitter_size; i++) {
+            size_t pair = (size_t)class_index * n + work.splitter[i];
+            for (uint32_t j = work.inverse_first[pair]; j < work.inverse_first[pair + 1]; j++) {
+                uint32_t source = work.inverse[j];
+                uint32_t block = block_of[source];
+
+                if (work.marked[block] == 0) {
+                    work.touched[num_touched++] = block;
+                }
+
+                /* Move the row into the marked prefix of its block */
+                uint32_t target_position = work.block_first[block] + work.marked[block]++;
+                uint32_t displaced = work.elements[target_position];
+                uint32_t source_position = work.position[source];
+                work.elements[target_position] = source;
+                work.position[source] = target_position;
+                work.elements[source_position] = displaced;
+                work.position[displaced] = source_position;
+            }
+        }
+
+        for (uint32_t t = 0; t < num_touched; t++) {
+            uint32_t block = work.touched[t];
+            uint32_t marked = work.marked[block];
+            uint32_t first = work.block_first[block];
+            uint32_t size = work.block_end[block] - first;
+            work.marked[block] = 0;
+
+            if (marked == size) {
+                continue;
+            }
+
+            /* The new block takes the smaller half, so each row is relabelled O(log n) times */
+            uint32_t new_block = blocks++;
+            if (marked <= size - marked) {
+                work.block_first[new_block] = first;
+                work.block_end[new_block] = first + marked;
+                work.block_first[block] = first + marked;
+            } else {
+                work.block_first[new_block] = first + marked;
+                work.block_end[new_block] = work.block_end[block];
+                work.block_end[block] = first + marked;
+            }
+
+            for (uint32_t i = work.block_first[new_block]; i < work.block_end[new_block]; i++) {
+                block_of[work.elements[i]] = new_block;
+            }
+
+            /* Whether or not the old block was pending, the smaller half suffices */
+            for (uint32_t k = 0; k < num_classes; k++) {
+                push_splitter(&work, &pending, new_block, (uint16_t)k, num_classes);
+            }
+        }
+    }
+
+    *num_blocks = blocks;
+    hopcroft_work_free(&work);
+    return true;
+}
+
+/**
+ * @brief Check whether two predicates accept a common byte
+ */
+static bool
+predicates_overlap(const rift_transition_predicate_t *a, const rift_transition_predicate_t *b)
+{
+    for (int w = 0; w < 4; w++) {
+        if (a->bitmap[w] & b->bitmap[w]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Check whether dropping the dead edges of a state would change its transitions
+ *
+ * The first matching transition wins, so a dead edge shadows any later edge
+ * that accepts one of its bytes.
+ *
+ * @param frozen The frozen DFA
+ * @param state The state index in the frozen DFA
+ * @param block_of Block of every table row
+ * @param dead_block Block of the dead row
+ * @return true if the dead edges must be kept, false otherwise
+ */
+static bool
+dead_edges_shadow(const rift_frozen_automaton_t *frozen, uint32_t state, const uint32_t *block_of,
+                  uint32_t dead_block)
+{
+    for (uint32_t e = frozen->edge_offsets[state]; e < frozen->edge_offsets[state + 1]; e++) {
+        if (block_of[frozen->edge_targets[e] + 1] != dead_block) {
+            continue;
+        }
+        for (uint32_t later = e + 1; later < frozen->edge_offsets[state + 1]; later++) {
+            if (block_of[frozen->edge_targets[later] + 1] != dead_block &&
+                predicates_overlap(&frozen->edge_predicates[e], &frozen->edge_predicates[later])) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Accept tags of one DFA row, used to group rows by tag set
+ */
+typedef struct {
+    const uint32_t *tags; /**< Tags in ascending order */
+    uint32_t count;       /**< Number of tags */
+    uint32_t row;         /**< Table row */
+} hopcroft_tag_row_t;
+
+/**
+ * @brief Order rows by their tag lists
+ */
+static int
+compare_tag_rows(const void *a, const void *b)
+{
+    const hopcroft_tag_row_t *ra = (const hopcroft_tag_row_t *)a;
+    const hopcroft_tag_row_t *rb = (const hopcroft_tag_row_t *)b;
+
+    for (uint32_t i = 0; i < ra->count && i < rb->count; i++) {
+        if (ra->tags[i] != rb->tags[i]) {
+            return ra->tags[i] < rb->tags[i] ? -1 : 1;
+        }
+    }
+    if (ra->count != rb->count) {
+        return ra->count < rb->count ? -1 : 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Label every row by its accept tag set
+ *
+ * Rejecting rows get label 0 and accepting rows with equal tag sets share a
+ * label from 1 upwards.
+ *
+ * @param table The compiled DFA table
+ * @param frozen The frozen DFA, whose state i is row i + 1
+ * @param labels Output array of table->num_states labels
+ * @return Number of labels, or 0 on allocation failure
+ */
+static uint32_t
+label_accept_tags(const rift_dfa_table_t *table, const rift_frozen_automaton_t *frozen,
+                  uint32_t *labels)
+{
+    hopcroft_tag_row_t *rows =
+        (hopcroft_tag_row_t *)rift_malloc(table->num_states * sizeof(hopcroft_tag_row_t));
+    if (!rows) {
+        return 0;
+    }
+
+    uint32_t num_rows = 0;
+    for (uint32_t row = 0; row < table->num_states; row++) {
+        labels[row] = 0;
+        if (row != RIFT_DFA_DEAD_STATE && rift_dfa_table_is_accepting(table, row)) {
+            hopcroft_tag_row_t *entry = &rows[num_rows++];
+            entry->tags = rift_frozen_automaton_get_accept_tags(frozen, row - 1, &entry->count);
+            entry->row = row;
+        }
+    }
+
+    qsort(rows, num_rows, sizeof(hopcroft_tag_row_t), compare_tag_rows);
+
+    uint32_t num_labels = 1;
+    for (uint32_t i = 0; i < num_rows; i++) {
+        if (i == 0 || compare_tag_rows(&rows[i - 1], &rows[i]) != 0) {
+            num_labels++;
+        }
+        labels[rows[i].row] = num_labels - 1;
+    }
+
+    rift_free(rows);
+    return num_labels;
+}
+
+/**
+ * @brief Create the minimized state of a block, copying the accept tags of its representative
+ */
+static rift_regex_state_t *
+create_block_state(rift_regex_automaton_t *minimized, const rift_regex_automaton_t *dfa,
+                   const rift_dfa_table_t *table, uint32_t row)
+{
+    rift_regex_state_t *state =
+        rift_automaton_create_state(minimized, rift_dfa_table_is_accepting(table, row));
+    if (state && row != RIFT_DFA_DEAD_STATE &&
+        !rift_state_merge_accept_tags(state, dfa->states[row - 1])) {
+        return NULL;
+    }
+    return state;
+}
+
+/**
+ * @brief Build the minimal DFA equivalent to a DFA
+ *
+ * @param dfa The deterministic automaton to minimize
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new minimized automaton or NULL on failure
+ */
+rift_regex_automaton_t *
+rift_hopcroft_minimize(const rift_regex_automaton_t *dfa, rift_regex_error_t *error)
+{
+    if (!dfa) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Null automaton provided");
+        }
+        return NULL;
+    }
+
+    rift_regex_automaton_t *minimized = NULL;
+    rift_frozen_automaton_t *frozen = NULL;
+    uint32_t *block_of = NULL;
+    uint32_t *labels = NULL;
+    uint32_t *representative = NULL;
+    rift_regex_state_t **block_state = NULL;
+    uint32_t *queue = NULL;
+    uint32_t num_blocks = 0;
+    bool success = false;
+
+    rift_dfa_table_t *table = rift_dfa_table_compile(dfa, error);
+    if (!table) {
+        return NULL;
+    }
+
+    frozen = rift_frozen_automaton_create(dfa, error);
+    block_of = (uint32_t *)rift_malloc(table->num_states * sizeof(uint32_t));
+    if (!frozen || !block_of) {
+        goto cleanup;
+    }
+
+    if (frozen->num_accept_tags == 0) {
+        if (!rift_hopcroft_partition(table, block_of, &num_blocks, error)) {
+            goto cleanup;
+        }
+    } else {
+        labels = (uint32_t *)rift_malloc(table->num_states * sizeof(uint32_t));
+        uint32_t num_labels = labels ? label_accept_tags(table, frozen, labels) : 0;
+        if (num_labels == 0) {
+            goto memory_error;
+        }
+        if (!rift_hopcroft_partition_labeled(table, labels, num_labels, block_of, &num_blocks,
+                                             error)) {
+            goto cleanup;
+        }
+    }
+
+    representative = (uint32_t *)rift_malloc(num_blocks * sizeof(uint32_t));
+    block_state = (rift_regex_state_t **)rift_calloc(num_blocks + 1, sizeof(rift_regex_state_t *));
+    queue = (uint32_t *)rift_malloc((num_blocks + 1) * sizeof(uint32_t));
+    minimized = rift_automaton_create(RIFT_AUTOMATON_DFA);
+    if (!representative || !block_state || !queue || !minimized) {
+        goto memory_error;
+    }
+
+    for (uint32_t b = 0; b < num_blocks; b++) {
+        representative[b] = RIFT_HOPCROFT_NO_BLOCK;
+    }
+    for (uint32_t row = 1; row < table->num_states; row++) {
+        uint32_t block = block_of[row];
+        if (block != RIFT_HOPCROFT_NO_BLOCK && representative[block] == RIFT_HOPCROFT_NO_BLOCK) {
+            representative[block] = row;
+        }
+    }
+
+    /* block_state[num_blocks] is the explicit sink, created only when a dead edge must stay */
+    uint32_t dead_block = block_of[RIFT_DFA_DEAD_STATE];
+    uint32_t start_block = block_of[table->start_state];
+    uint32_t head = 0;
+    uint32_t tail = 0;
+
+    block_state[start_block] = create_block_state(minimized, dfa, table, table->start_state);
+    if (!block_state[start_block] ||
+        !rift_automaton_set_initial_state(minimized, block_state[start_block])) {
+        goto memory_error;
+    }
+    if (start_block != dead_block) {
+        queue[tail++] = start_block;
+    }
+
+    while (head < tail) {
+        uint32_t block = queue[head++];
+        uint32_t state = representative[block] - 1;
+        bool keep_dead = dead_edges_shadow(frozen, state, block_of, dead_block);
+
+        for (uint32_t e = frozen->edge_offsets[state]; e < frozen->edge_offsets[state + 1]; e++) {
+            if (rift_frozen_automaton_edge_is_epsilon(frozen, e)) {
+                continue;
+            }
+
+            uint32_t target = block_of[frozen->edge_targets[e] + 1];
+            if (target == dead_block) {
+                if (!keep_dead) {
+                    continue;
+                }
+                target = num_blocks;
+            }
+
+            if (!block_state[target]) {
+                block_state[target] =
+                    target == num_blocks
+                        ? rift_automaton_create_state(minimized, false)
+                        : create_block_state(minimized, dfa, table, representative[target]);
+                if (!block_state[target]) {
+                    goto memory_error;
+                }
+                if (target != num_blocks) {
+                    queue[tail++] = target;
+                }
+            }
+
+            if (!rift_automaton_add_transition(minimized, block_state[block], block_state[target],
+                                               rift_frozen_automaton_get_edge_pattern(frozen, e))) {
+                goto memory_error;
+            }
+        }
+    }
+
+    success = true;
+    goto cleanup;
+
+memory_error:
+    if (error) {
+        error->code = RIFT_REGEX_ERROR_MEMORY;
+        snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                 "Failed to build minimized automaton");
+    }
+
+cleanup:
+    rift_dfa_table_free(table);
+    rift_frozen_automaton_free(frozen);
+    rift_free(block_of);
+    rift_free(labels);
+    rift_free(representative);
+    rift_free(block_state);
+    rift_free(queue);
+
+    if (!success) {
+        rift_automaton_free(minimized);
+        return NULL;
+    }
+    return minimized;
+}
@@ -0,0 +1,1425 @@
+/**
+ * @file lazy_dfa.c
+ * @brief Implementation of on-demand DFA construction for the LibRift regex engine
+ *
+ * This file implements a lazy DFA whose states are NFA state sets built the
+ * first time the input reaches them. Transitions are cached per byte class in
+ * a bounded state cache; a full cache is flushed and, if flushes come faster
+ * than the input advances, the search finishes as an NFA simulation. Saved
+ * caches carry an FNV-1a fingerprint of the automaton they were built for.
+ *
+ * For an NFA with anchors or word boundaries, a state is the set of NFA
+ * states a byte led to, before any epsilon move, plus the kind of that byte.
+ * The closure is taken when the next byte is known, dropping the states whose
+ * assertions fail between the two bytes. Whether a state accepts depends on
+ * the kind of the next byte too, so it gets an accept flag per kind.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/automaton/lazy_dfa.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/automaton/state.h"
+#include "core/memory/memory.h"
+#include "core/runtime/probes.h"
+
+/** Transition entry that has not been computed yet */
+#define LAZY_DFA_UNKNOWN UINT32_MAX
+
+/** State flag set on accepting states */
+#define LAZY_DFA_STATE_ACCEPTING 0x01u
+
+/** State flag set on the empty state set, which can never accept again */
+#define LAZY_DFA_STATE_DEAD 0x02u
+
+/** First of the flags telling whether a state accepts before each kind of next byte */
+#define LAZY_DFA_STATE_ACCEPT_BEFORE 0x04u
+
+/** NFA state flags settled by the bytes around a position */
+#define LAZY_DFA_ASSERTING                                                                     \
+    (RIFT_STATE_FLAG_ANCHOR_START | RIFT_STATE_FLAG_ANCHOR_END | RIFT_STATE_FLAG_WORD_BOUNDARY | \
+     RIFT_STATE_FLAG_NOT_WORD_BOUNDARY)
+
+/* Kinds of the byte next to a position, which is all assertions look at */
+#define LAZY_DFA_LOOK_EDGE 0u    /**< Before the start or past the end of the text */
+#define LAZY_DFA_LOOK_NEWLINE 1u /**< A newline */
+#define LAZY_DFA_LOOK_WORD 2u    /**< A word character */
+#define LAZY_DFA_LOOK_OTHER 3u   /**< Any other byte */
+#define LAZY_DFA_LOOKS 4u        /**< Number of kinds */
+
+/** Key bits past the NFA states holding the kind of the byte before a state */
+#define LAZY_DFA_LOOK_BITS 2u
+
+/** Byte order mark of a saved cache, as written by the saving machine */
+#define LAZY_DFA_CACHE_BYTE_ORDER 0x01020304u
+
+/* FNV-1a parameters */
+#define LAZY_DFA_FNV_OFFSET 2166136261u
+#define LAZY_DFA_FNV_PRIME 16777619u
+
+/**
+ * @brief Header of a saved state cache
+ *
+ * It is followed by the NFA state set of every state, cache->words words
+ * each, then by its transitions, num_classes entries each.
+ */
+typedef struct {
+    uint32_t magic;          /**< RIFT_LAZY_DFA_CACHE_MAGIC */
+    uint32_t version;        /**< RIFT_LAZY_DFA_CACHE_VERSION */
+    uint32_t byte_order;     /**< LAZY_DFA_CACHE_BYTE_ORDER of the writer */
+    uint32_t fingerprint;    /**< FNV-1a of the automaton and byte classes */
+    uint32_t num_nfa_states; /**< States of the frozen NFA */
+    uint32_t num_classes;    /**< Byte classes of the NFA */
+    uint32_t unanchored;     /**< Whether the lazy DFA is unanchored */
+    uint32_t num_states;     /**< Cached states saved */
+    uint32_t start_state;    /**< Cached start state or RIFT_SUBSET_NOT_FOUND */
+    uint32_t reserved;       /**< Always zero */
+} lazy_dfa_cache_header_t;
+
+/**
+ * @brief Per-search bookkeeping used to detect cache thrashing
+ */
+typedef struct {
+    size_t flushes;           /**< Flushes during this search */
+    size_t bytes_since_flush; /**< Input bytes consumed since the last flush */
+} lazy_dfa_search_t;
+
+/**
+ * @brief Input of a search and the direction it is read in
+ */
+typedef struct {
+    const char *bytes;  /**< The input bytes */
+    size_t length;      /**< Number of input bytes */
+    bool backward;      /**< Whether bytes are read from the last one down */
+    size_t start_limit; /**< Bytes read before an unanchored search stops restarting */
+} lazy_dfa_input_t;
+
+/**
+ * @brief Get the byte a search reads at a step
+ */
+static inline uint8_t
+input_byte(const lazy_dfa_input_t *input, size_t pos)
+{
+    return (uint8_t)input->bytes[input->backward ? input->length - 1 - pos : pos];
+}
+
+/**
+ * @brief Get the kind of a byte as assertions see it
+ *
+ * @param byte The byte, or RIFT_LAZY_DFA_TEXT_EDGE
+ * @return One of the LAZY_DFA_LOOK_* kinds
+ */
+static inline uint8_t
+byte_look(int byte)
+{
+    if (byte < 0) {
+        return LAZY_DFA_LOOK_EDGE;
+    }
+    if (byte == '\n') {
+        return LAZY_DFA_LOOK_NEWLINE;
+    }
+    if ((byte >= '0' && byte <= '9') || (byte >= 'A' && byte <= 'Z') ||
+        (byte >= 'a' && byte <= 'z') || byte == '_') {
+        return LAZY_DFA_LOOK_WORD;
+    }
+    return LAZY_DFA_LOOK_OTHER;
+}
+
+/**
+ * @brief Get the kind of the byte a search reads at a step, or of the one after its input
+ */
+static inline uint8_t
+look_at(const rift_lazy_dfa_t *lazy, const lazy_dfa_input_t *input, size_t pos)
+{
+    return pos < input->length ? byte_look(input_byte(input, pos)) : lazy->look_ahead;
+}
+
+/**
+ * @brief Check whether the assertions of an NFA state hold between two kinds of bytes
+ *
+ * @param lazy The lazy DFA
+ * @param flags Flags of the NFA state
+ * @param behind Kind of the byte before the position
+ * @param ahead Kind of the byte after the position
+ * @return true if every assertion holds
+ */
+static bool
+assertions_hold(const rift_lazy_dfa_t *lazy, uint8_t flags, uint8_t behind, uint8_t ahead)
+{
+    bool multiline = (lazy->nfa->flags & RIFT_REGEX_FLAG_MULTILINE) != 0;
+    bool boundary = (behind == LAZY_DFA_LOOK_WORD) != (ahead == LAZY_DFA_LOOK_WORD);
+
+    if ((flags & RIFT_STATE_FLAG_ANCHOR_START) && behind != LAZY_DFA_LOOK_EDGE &&
+        !(multiline && behind == LAZY_DFA_LOOK_NEWLINE)) {
+        return false;
+    }
+    if ((flags & RIFT_STATE_FLAG_ANCHOR_END) && ahead != LAZY_DFA_LOOK_EDGE &&
+        !(multiline && ahead == LAZY_DFA_LOOK_NEWLINE)) {
+        return false;
+    }
+    if ((flags & RIFT_STATE_FLAG_WORD_BOUNDARY) && !boundary) {
+        return false;
+    }
+    return !((flags & RIFT_STATE_FLAG_NOT_WORD_BOUNDARY) && boundary);
+}
+
+/**
+ * @brief Compute the epsilon closure of a set at a position between two kinds of bytes
+ *
+ * States whose assertions fail there are left out, as are the states only
+ * they lead to.
+ *
+ * @param lazy The lazy DFA
+ * @param seeds NFA states the closure starts from
+ * @param num_seeds Number of seed states
+ * @param behind Kind of the byte before the position
+ * @param ahead Kind of the byte after the position
+ * @param out Output array for the closure, in no particular order
+ * @return Number of states written
+ */
+static size_t
+look_closure(rift_lazy_dfa_t *lazy, const uint32_t *seeds, size_t num_seeds, uint8_t behind,
+             uint8_t ahead, uint32_t *out)
+{
+    const rift_frozen_automaton_t *nfa = lazy->nfa;
+    size_t count = 0;
+
+    rift_sparse_set_clear(&lazy->look_seen);
+    for (size_t i = 0; i < num_seeds; i++) {
+        uint32_t state = seeds[i];
+        if (rift_sparse_set_insert(&lazy->look_seen, state) &&
+            assertions_hold(lazy, nfa->state_flags[state], behind, ahead)) {
+            out[count++] = state;
+        }
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        uint32_t state = out[i];
+        for (uint32_t e = nfa->edge_offsets[state]; e < nfa->edge_offsets[state + 1]; e++) {
+            if (!(nfa->edge_flags[e] & RIFT_FROZEN_EDGE_EPSILON)) {
+                continue;
+            }
+
+            uint32_t target = nfa->edge_targets[e];
+            if (rift_sparse_set_insert(&lazy->look_seen, target) &&
+                assertions_hold(lazy, nfa->state_flags[target], behind, ahead)) {
+                out[count++] = target;
+            }
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief List the states of a bitset in ascending order
+ *
+ * @param bitset The bitset
+ * @param words Number of words in the bitset
+ * @param states Output array for the state indices
+ * @return Number of states written
+ */
+static size_t
+bitset_members(const uint64_t *bitset, size_t words, uint32_t *states)
+{
+    size_t count = 0;
+    for (size_t w = 0; w < words; w++) {
+        if (!bitset[w]) {
+            continue;
+        }
+        for (unsigned bit = 0; bit < 64; bit++) {
+            if (bitset[w] & ((uint64_t)1 << bit)) {
+                states[count++] = (uint32_t)(w * 64 + bit);
+            }
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Take the kind of the byte before a state off the end of its member list
+ *
+ * @param lazy The lazy DFA
+ * @param members Members of a cache key in ascending order
+ * @param num_members Number of members, reduced to the NFA states
+ * @return The kind of the byte before the state
+ */
+static uint8_t
+split_look(const rift_lazy_dfa_t *lazy, const uint32_t *members, size_t *num_members)
+{
+    uint8_t behind = LAZY_DFA_LOOK_EDGE;
+    while (*num_members > 0 && members[*num_members - 1] >= lazy->nfa->num_states) {
+        (*num_members)--;
+        behind |= (uint8_t)(1u << (members[*num_members] - lazy->nfa->num_states));
+    }
+    return behind;
+}
+
+/**
+ * @brief List the NFA states of a cached state
+ *
+ * @param lazy The lazy DFA
+ * @param state The cached state
+ * @param members Output array for the sorted NFA states
+ * @param behind Pointer to store the kind of the byte before the state
+ * @return Number of NFA states written
+ */
+static size_t
+state_members(const rift_lazy_dfa_t *lazy, uint32_t state, uint32_t *members, uint8_t *behind)
+{
+    size_t num_members = bitset_members(rift_subset_table_get(lazy->cache, state),
+                                        lazy->cache->words, members);
+    *behind = split_look(lazy, members, &num_members);
+    return num_members;
+}
+
+/**
+ * @brief Compute the NFA state set reached from a set on one input byte
+ *
+ * With assertions the set holds the states before their closure, which is
+ * taken here once the byte tells which assertions hold, and the successor
+ * set is left unclosed in turn.
+ *
+ * @param lazy The lazy DFA
+ * @param members Sorted NFA states of the current set
+ * @param num_members Number of states in the current set
+ * @param behind Kind of the byte before the current set
+ * @param byte The input byte
+ * @param restart Whether a match may start after the byte, in an unanchored search
+ * @param out Output array for the sorted successor set
+ * @return Number of states in the successor set
+ */
+static size_t
+step_set(rift_lazy_dfa_t *lazy, const uint32_t *members, size_t num_members, uint8_t behind,
+         uint8_t byte, bool restart, uint32_t *out)
+{
+    const rift_frozen_automaton_t *nfa = lazy->nfa;
+    rift_sparse_set_t *targets = &lazy->targets;
+
+    if (lazy->has_assertions) {
+        num_members = look_closure(lazy, members, num_members, behind, byte_look(byte),
+                                   lazy->look_members);
+        members = lazy->look_members;
+    }
+
+    rift_sparse_set_clear(targets);
+    for (size_t i = 0; i < num_members; i++) {
+        uint32_t state = members[i];
+        for (uint32_t e = nfa->edge_offsets[state]; e < nfa->edge_offsets[state + 1]; e++) {
+            if ((nfa->edge_flags[e] & RIFT_FROZEN_EDGE_EPSILON) ||
+                !rift_transition_predicate_test(&nfa->edge_predicates[e], byte)) {
+                continue;
+            }
+
+            rift_sparse_set_insert(targets, nfa->edge_targets[e]);
+        }
+    }
+
+    /* An unanchored search restarts at every position */
+    if (lazy->unanchored && restart) {
+        rift_sparse_set_insert(targets, nfa->start_state);
+    }
+
+    if (lazy->has_assertions) {
+        memcpy(out, targets->dense, targets->count * sizeof(uint32_t));
+        return targets->count;
+    }
+    return rift_epsilon_closures_union(lazy->closures, targets->dense, targets->count,
+                                       lazy->scratch, out);
+}
+
+/**
+ * @brief Check whether an NFA state set contains an accepting state
+ */
+static bool
+set_is_accepting(const rift_lazy_dfa_t *lazy, const uint32_t *members, size_t num_members)
+{
+    for (size_t i = 0; i < num_members; i++) {
+        if (rift_frozen_automaton_is_accepting(lazy->nfa, members[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Add the accept tags of an NFA state set to a bitset
+ *
+ * @param lazy The lazy DFA
+ * @param members NFA states of the set
+ * @param num_members Number of states in the set
+ * @param tags Bitset of lazy->tag_words words to update
+ */
+static void
+add_set_tags(const rift_lazy_dfa_t *lazy, const uint32_t *members, size_t num_members,
+             uint64_t *tags)
+{
+    for (size_t i = 0; i < num_members; i++) {
+        uint32_t count = 0;
+        const uint32_t *state_tags =
+            rift_frozen_automaton_get_accept_tags(lazy->nfa, members[i], &count);
+        for (uint32_t t = 0; t < count; t++) {
+            tags[state_tags[t] / 64] |= (uint64_t)1 << (state_tags[t] % 64);
+        }
+    }
+}
+
+/**
+ * @brief Check whether a set accepts at a position between two kinds of bytes
+ *
+ * @param lazy The lazy DFA
+ * @param members NFA states of the set
+ * @param num_members Number of states in the set
+ * @param behind Kind of the byte before the position
+ * @param ahead Kind of the byte after the position
+ * @return true if the set accepts there
+ */
+static bool
+set_accepts(rift_lazy_dfa_t *lazy, const uint32_t *members, size_t num_members, uint8_t behind,
+            uint8_t ahead)
+{
+    if (lazy->has_assertions) {
+        num_members = look_closure(lazy, members, num_members, behind, ahead, lazy->look_members);
+        members = lazy->look_members;
+    }
+    return set_is_accepting(lazy, members, num_members);
+}
+
+/**
+ * @brief Add the accept tags of a set at a position between two kinds of bytes
+ *
+ * @param lazy The lazy DFA
+ * @param members NFA states of the set
+ * @param num_members Number of states in the set
+ * @param behind Kind of the byte before the position
+ * @param ahead Kind of the byte after the position
+ * @param tags Bitset of lazy->tag_words words to update
+ */
+static void
+add_context_tags(rift_lazy_dfa_t *lazy, const uint32_t *members, size_t num_members,
+                 uint8_t behind, uint8_t ahead, uint64_t *tags)
+{
+    if (lazy->has_assertions) {
+        num_members = look_closure(lazy, members, num_members, behind, ahead, lazy->look_members);
+        members = lazy->look_members;
+    }
+    add_set_tags(lazy, members, num_members, tags);
+}
+
+/**
+ * @brief Get the kinds of next byte a cached state keeps accept tags for
+ */
+static inline size_t
+tag_looks(const rift_lazy_dfa_t *lazy)
+{
+    return lazy->has_assertions ? LAZY_DFA_LOOKS : 1;
+}
+
+/**
+ * @brief Check whether a cached state accepts before the byte a search reads at a step
+ */
+static inline bool
+accepts_at(const rift_lazy_dfa_t *lazy, uint32_t state, const lazy_dfa_input_t *input, size_t pos)
+{
+    uint8_t flags = lazy->state_flags[state];
+    if (!(flags & LAZY_DFA_STATE_ACCEPTING) || !lazy->has_assertions) {
+        return (flags & LAZY_DFA_STATE_ACCEPTING) != 0;
+    }
+    return (flags & (LAZY_DFA_STATE_ACCEPT_BEFORE << look_at(lazy, input, pos))) != 0;
+}
+
+/**
+ * @brief Look up an NFA state set in the cache, adding it if there is room
+ *
+ * @param lazy The lazy DFA
+ * @param members Sorted NFA states of the set
+ * @param num_members Number of states in the set
+ * @param behind Kind of the byte before the state, part of the key with assertions
+ * @param may_insert Whether the set may be added when it is not cached
+ * @return The cached state or RIFT_SUBSET_NOT_FOUND
+ */
+static uint32_t
+cache_lookup(rift_lazy_dfa_t *lazy, const uint32_t *members, size_t num_members, uint8_t behind,
+             bool may_insert)
+{
+    size_t n = lazy->nfa->num_states;
+    for (size_t i = 0; i < num_members; i++) {
+        lazy->key[members[i] / 64] |= (uint64_t)1 << (members[i] % 64);
+    }
+    for (size_t b = 0; lazy->has_assertions && b < LAZY_DFA_LOOK_BITS; b++) {
+        if (behind & (1u << b)) {
+            lazy->key[(n + b) / 64] |= (uint64_t)1 << ((n + b) % 64);
+        }
+    }
+
+    uint32_t index;
+    bool inserted = false;
+    if (may_insert) {
+        index = rift_subset_table_insert(lazy->cache, lazy->key, &inserted);
+    } else {
+        index = rift_subset_table_find(lazy->cache, lazy->key);
+    }
+
+    for (size_t i = 0; i < num_members; i++) {
+        lazy->key[members[i] / 64] = 0;
+    }
+    for (size_t b = 0; lazy->has_assertions && b < LAZY_DFA_LOOK_BITS; b++) {
+        lazy->key[(n + b) / 64] = 0;
+    }
+
+    if (inserted) {
+        uint32_t *row = &lazy->transitions[(size_t)index * lazy->classes.num_classes];
+        for (uint16_t k = 0; k < lazy->classes.num_classes; k++) {
+            row[k] = LAZY_DFA_UNKNOWN;
+        }
+
+        lazy->state_flags[index] = num_members == 0 ? LAZY_DFA_STATE_DEAD : 0;
+
+        // With assertions, acceptance and tags are settled per kind of the byte read next
+        size_t looks = tag_looks(lazy);
+        for (size_t ahead = 0; ahead < looks; ahead++) {
+            const uint32_t *set = members;
+            size_t set_size = num_members;
+            if (lazy->has_assertions) {
+                set_size = look_closure(lazy, members, num_members, behind, (uint8_t)ahead,
+                                        lazy->look_members);
+                set = lazy->look_members;
+            }
+
+            if (set_is_accepting(lazy, set, set_size)) {
+                lazy->state_flags[index] |= LAZY_DFA_STATE_ACCEPTING;
+                if (lazy->has_assertions) {
+                    lazy->state_flags[index] |= (uint8_t)(LAZY_DFA_STATE_ACCEPT_BEFORE << ahead);
+                }
+            }
+            if (lazy->tag_words > 0) {
+                uint64_t *tags =
+                    &lazy->state_tags[((size_t)index * looks + ahead) * lazy->tag_words];
+                memset(tags, 0, lazy->tag_words * sizeof(uint64_t));
+                add_set_tags(lazy, set, set_size, tags);
+            }
+        }
+        lazy->stats.states_built++;
+    }
+
+    return index;
+}
+
+/**
+ * @brief Get the cached start state, building it if needed
+ *
+ * @param lazy The lazy DFA
+ * @return The start state or RIFT_SUBSET_NOT_FOUND on allocation failure
+ */
+static uint32_t
+start_state(rift_lazy_dfa_t *lazy)
+{
+    if (lazy->cached_start != RIFT_SUBSET_NOT_FOUND) {
+        return lazy->cached_start;
+    }
+
+    if (lazy->cache->count >= lazy->max_cached_states) {
+        rift_lazy_dfa_flush(lazy);
+        lazy->stats.cache_flushes++;
+    }
+
+    // With assertions the closure waits for the first byte
+    size_t num_members = 1;
+    if (lazy->has_assertions) {
+        lazy->members[0] = lazy->nfa->start_state;
+    } else {
+        num_members = rift_epsilon_closures_union(lazy->closures, &lazy->nfa->start_state, 1,
+                                                  lazy->scratch, lazy->members);
+    }
+    lazy->cached_start = cache_lookup(lazy, lazy->members, num_members, lazy->look_behind, true);
+    return lazy->cached_start;
+}
+
+/**
+ * @brief Build the transition of a cached state on one input byte
+ *
+ * On success the successor is cached and returned. When the cache thrashes or
+ * an allocation fails, RIFT_SUBSET_NOT_FOUND is returned and the successor set
+ * is left in lazy->next_members for NFA simulation.
+ *
+ * @param lazy The lazy DFA
+ * @param state The current cached state, updated if the cache is flushed
+ * @param byte The input byte
+ * @param search Bookkeeping of the running search
+ * @param num_next Pointer to store the size of the successor set
+ * @return The successor state or RIFT_SUBSET_NOT_FOUND to fall back to NFA simulation
+ */
+static uint32_t
+build_transition(rift_lazy_dfa_t *lazy, uint32_t *state, uint8_t byte, lazy_dfa_search_t *search,
+                 size_t *num_next)
+{
+    uint8_t behind = LAZY_DFA_LOOK_EDGE;
+    size_t num_members = state_members(lazy, *state, lazy->members, &behind);
+    *num_next = step_set(lazy, lazy->members, num_members, behind, byte, true, lazy->next_members);
+
+    uint8_t next_behind = byte_look(byte);
+    uint32_t next = cache_lookup(lazy, lazy->next_members, *num_next, next_behind, false);
+    if (next == RIFT_SUBSET_NOT_FOUND) {
+        if (lazy->cache->count >= lazy->max_cached_states) {
+            /* A second flush before the input covered a cache's worth of bytes is thrashing */
+            if (search->flushes > 0 && search->bytes_since_flush < lazy->max_cached_states) {
+                return RIFT_SUBSET_NOT_FOUND;
+            }
+
+            rift_lazy_dfa_flush(lazy);
+            lazy->stats.cache_flushes++;
+            search->flushes++;
+            search->bytes_since_flush = 0;
+
+            *state = cache_lookup(lazy, lazy->members, num_members, behind, true);
+            if (*state == RIFT_SUBSET_NOT_FOUND) {
+                return RIFT_SUBSET_NOT_FOUND;
+            }
+        }
+
+        next = cache_lookup(lazy, lazy->next_members, *num_next, next_behind, true);
+        if (next == RIFT_SUBSET_NOT_FOUND) {
+            return RIFT_SUBSET_NOT_FOUND;
+        }
+    }
+
+    lazy->transitions[(size_t)*state * lazy->classes.num_classes + lazy->classes.map[byte]] = next;
+    return next;
+}
+
+/**
+ * @brief Finish a search by simulating the NFA without caching
+ *
+ * @param lazy The lazy DFA
+ * @param num_members Size of the current set, held in lazy->next_members
+ * @param behind Kind of the byte before the current set
+ * @param input The input of the search
+ * @param pos Step of the next input byte
+ * @param earliest Whether to stop at the first accepted prefix
+ * @param found Whether a prefix was already accepted (updated)
+ * @param match_end End of the accepted prefix (updated)
+ * @param alive Set to whether the set was non-empty when the input ran out
+ */
+static void
+simulate_nfa(rift_lazy_dfa_t *lazy, size_t num_members, uint8_t behind,
+             const lazy_dfa_input_t *input, size_t pos, bool earliest, bool *found,
+             size_t *match_end, bool *alive)
+{
+    uint32_t *current = lazy->next_members;
+    uint32_t *next = lazy->members;
+
+    *alive = false;
+
+    for (; pos < input->length && num_members > 0; pos++) {
+        uint8_t byte = input_byte(input, pos);
+        num_members =
+            step_set(lazy, current, num_members, behind, byte, pos + 1 < input->start_limit, next);
+        behind = byte_look(byte);
+
+        uint32_t *swap = current;
+        current = next;
+        next = swap;
+
+        if (set_accepts(lazy, current, num_members, behind, look_at(lazy, input, pos + 1))) {
+            *found = true;
+            *match_end = pos + 1;
+            if (earliest) {
+                return;
+            }
+        }
+    }
+
+    *alive = num_members > 0;
+}
+
+/**
+ * @brief Get the bytes one cached state takes
+ *
+ * Counts its transitions, flags and accept tags, and its state set with the
+ * hash and index slots the cache table keeps for it.
+ *
+ * @param lazy The lazy DFA, with its byte classes, tag words and cache set up
+ * @return Bytes per cached state
+ */
+static size_t
+cached_state_bytes(const rift_lazy_dfa_t *lazy)
+{
+    return lazy->classes.num_classes * sizeof(uint32_t) + sizeof(uint8_t) +
+           tag_looks(lazy) * lazy->tag_words * sizeof(uint64_t) +
+           (lazy->cache->words + 1) * sizeof(uint64_t) + 2 * sizeof(uint32_t);
+}
+
+/**
+ * @brief Create a lazy DFA under the tag already in use
+ *
+ * @param nfa The NFA (a DFA is accepted as well)
+ * @param max_cached_states Capacity of the state cache (0 for the default)
+ * @param max_cache_bytes Bytes the state cache may take, 0 for no limit
+ * @param unanchored Whether matches may start at any position
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new lazy DFA or NULL on failure
+ */
+static rift_lazy_dfa_t *
+build_lazy_dfa(const rift_regex_automaton_t *nfa, size_t max_cached_states,
+               size_t max_cache_bytes, bool unanchored, rift_regex_error_t *error)
+{
+    if (!nfa) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Null automaton provided");
+        }
+        return NULL;
+    }
+
+    // Cached states stand for sets, and a lookaround depends on the position too
+    if (nfa->num_lookarounds > 0) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Lookarounds are not supported by the lazy DFA");
+        }
+        return NULL;
+    }
+
+    if (max_cached_states == 0) {
+        max_cached_states = RIFT_LAZY_DFA_DEFAULT_CACHE_STATES;
+    } else if (max_cached_states < RIFT_LAZY_DFA_MIN_CACHE_STATES) {
+        max_cached_states = RIFT_LAZY_DFA_MIN_CACHE_STATES;
+    }
+
+    rift_lazy_dfa_t *lazy = (rift_lazy_dfa_t *)rift_calloc(1, sizeof(rift_lazy_dfa_t));
+    if (!lazy) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_MEMORY;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Failed to allocate lazy DFA");
+        }
+        return NULL;
+    }
+
+    lazy->max_cached_states = max_cached_states;
+    lazy->unanchored = unanchored;
+    lazy->cached_start = RIFT_SUBSET_NOT_FOUND;
+
+    if (!rift_byte_classes_compute(nfa, &lazy->classes, error)) {
+        rift_lazy_dfa_free(lazy);
+        return NULL;
+    }
+
+    lazy->nfa = rift_frozen_automaton_create(nfa, error);
+    if (!lazy->nfa) {
+        rift_lazy_dfa_free(lazy);
+        return NULL;
+    }
+
+    if (lazy->nfa->start_state == RIFT_FROZEN_NO_STATE) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_AUTOMATON;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Automaton has no initial state");
+        }
+        rift_lazy_dfa_free(lazy);
+        return NULL;
+    }
+
+    lazy->closures = rift_epsilon_closures_compute(nfa, error);
+    if (!lazy->closures) {
+        rift_lazy_dfa_free(lazy);
+        return NULL;
+    }
+
+    // Assertions look at the kinds of the bytes around a position, so no class mixes kinds
+    size_t n = lazy->nfa->num_states;
+    for (size_t i = 0; i < n && !lazy->has_assertions; i++) {
+        lazy->has_assertions = (lazy->nfa->state_flags[i] & LAZY_DFA_ASSERTING) != 0;
+    }
+    if (lazy->has_assertions) {
+        bool words[RIFT_BYTE_CLASS_ALPHABET_SIZE];
+        bool newlines[RIFT_BYTE_CLASS_ALPHABET_SIZE];
+        for (int c = 0; c < RIFT_BYTE_CLASS_ALPHABET_SIZE; c++) {
+            words[c] = byte_look(c) == LAZY_DFA_LOOK_WORD;
+            newlines[c] = c == '\n';
+        }
+        rift_byte_classes_refine(&lazy->classes, words);
+        rift_byte_classes_refine(&lazy->classes, newlines);
+    }
+
+    lazy->tag_words = ((size_t)lazy->nfa->accept_tag_limit + 63) / 64;
+    lazy->cache =
+        rift_subset_table_create((uint32_t)(n + (lazy->has_assertions ? LAZY_DFA_LOOK_BITS : 0)));
+
+    // Shrink the cache to the budget, which must hold the states a flush keeps
+    if (lazy->cache && max_cache_bytes > 0) {
+        size_t fit = max_cache_bytes / cached_state_bytes(lazy);
+        if (fit < RIFT_LAZY_DFA_MIN_CACHE_STATES) {
+            // Matchers only look at the code, so the message is left to be formatted on demand
+            rift_regex_error_set_formatted(error, RIFT_REGEX_ERROR_LIMIT_EXCEEDED,
+                                           "Lazy DFA state cache does not fit in %zu bytes",
+                                           max_cache_bytes);
+            rift_lazy_dfa_free(lazy);
+            return NULL;
+        }
+        if (fit < max_cached_states) {
+            max_cached_states = fit;
+            lazy->max_cached_states = fit;
+        }
+    }
+
+    lazy->transitions = (uint32_t *)rift_malloc(max_cached_states * lazy->classes.num_classes *
+                                                sizeof(uint32_t));
+    lazy->state_flags = (uint8_t *)rift_calloc(max_cached_states, sizeof(uint8_t));
+    lazy->members = (uint32_t *)rift_malloc((n + LAZY_DFA_LOOK_BITS + 1) * sizeof(uint32_t));
+    bool sets = rift_sparse_set_init(&lazy->targets, (uint32_t)n);
+    lazy->next_members = (uint32_t *)rift_malloc((n + LAZY_DFA_LOOK_BITS + 1) * sizeof(uint32_t));
+    if (lazy->tag_words > 0) {
+        lazy->state_tags = (uint64_t *)rift_malloc(max_cached_states * tag_looks(lazy) *
+                                                   lazy->tag_words * sizeof(uint64_t));
+    }
+    if (lazy->has_assertions) {
+        lazy->look_members = (uint32_t *)rift_malloc((n + 1) * sizeof(uint32_t));
+        sets = sets && rift_sparse_set_init(&lazy->look_seen, (uint32_t)n);
+    }
+
+    if (lazy->cache) {
+        lazy->key = (uint64_t *)rift_calloc(lazy->cache->words, sizeof(uint64_t));
+        lazy->scratch = (uint64_t *)rift_calloc(lazy->cache->words, sizeof(uint64_t));
+    }
+
+    if (!lazy->cache || !lazy->transitions || !lazy->state_flags || !lazy->members ||
+        !sets || !lazy->next_members || !lazy->key || !lazy->scratch ||
+        (lazy->tag_words > 0 && !lazy->state_tags) ||
+        (lazy->has_assertions && !lazy->look_members)) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_MEMORY;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Failed to allocate lazy DFA state cache");
+        }
+        rift_lazy_dfa_free(lazy);
+        return NULL;
+    }
+
+    return lazy;
+}
+
+/**
+ * @brief Create a lazy DFA, anchored or not
+ *
+ * @param nfa The NFA (a DFA is accepted as well)
+ * @param max_cached_states Capacity of the state cache (0 for the default)
+ * @param max_cache_bytes Bytes the state cache may take, 0 for no limit
+ * @param unanchored Whether matches may start at any position
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new lazy DFA or NULL on failure
+ */
+static rift_lazy_dfa_t *
+create_lazy_dfa(const rift_regex_automaton_t *nfa, size_t max_cached_states,
+                size_t max_cache_bytes, bool unanchored, rift_regex_error_t *error)
+{
+    // The cache is sized up front, so its memory all counts under the DFA tag
+    rift_memory_tag_t outer = rift_memory_tag_use(RIFT_MEMORY_TAG_DFA);
+    rift_lazy_dfa_t *lazy =
+        build_lazy_dfa(nfa, max_cached_states, max_cache_bytes, unanchored, error);
+    rift_memory_tag_use(outer);
+    return lazy;
+}
+
+/**
+ * @brief Create a lazy DFA for an NFA
+ *
+ * @param nfa The NFA (a DFA is accepted as well)
+ * @param max_cached_states Capacity of the state cache (0 for the default)
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new lazy DFA or NULL on failure
+ */
+rift_lazy_dfa_t *
+rift_lazy_dfa_create(const rift_regex_automaton_t *nfa, size_t max_cached_states,
+                     rift_regex_error_t *error)
+{
+    return create_lazy_dfa(nfa, max_cached_states, 0, false, error);
+}
+
+/**
+ * @brief Create a lazy DFA whose state cache fits in a memory budget
+ *
+ * @param nfa The NFA (a DFA is accepted as well)
+ * @param max_cache_bytes Bytes the state cache may take, 0 for no limit
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new lazy DFA or NULL on failure
+ */
+rift_lazy_dfa_t *
+rift_lazy_dfa_create_with_budget(const rift_regex_automaton_t *nfa, size_t max_cache_bytes,
+                                 rift_regex_error_t *error)
+{
+    return create_lazy_dfa(nfa, 0, max_cache_bytes, false, error);
+}
+
+/**
+ * @brief Create a lazy DFA that finds matches starting anywhere in the input
+ *
+ * @param nfa The NFA (a DFA is accepted as well)
+ * @param max_cached_states Capacity of the state cache (0 for the default)
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new lazy DFA or NULL on failure
+ */
+rift_lazy_dfa_t *
+rift_lazy_dfa_create_unanchored(const rift_regex_automaton_t *nfa, size_t max_cached_states,
+                                rift_regex_error_t *error)
+{
+    return create_lazy_dfa(nfa, max_cached_states, 0, true, error);
+}
+
+/**
+ * @brief Free a lazy DFA
+ *
+ * @param lazy The lazy DFA to free
+ */
+void
+rift_lazy_dfa_free(rift_lazy_dfa_t *lazy)
+{
+    if (!lazy) {
+        return;
+    }
+
+    rift_frozen_automaton_free(lazy->nfa);
+    rift_epsilon_closures_free(lazy->closures);
+    rift_subset_table_free(lazy->cache);
+    rift_free(lazy->transitions);
+    rift_free(lazy->state_flags);
+    rift_free(lazy->state_tags);
+    rift_free(lazy->members);
+    rift_sparse_set_destroy(&lazy->targets);
+    rift_sparse_set_destroy(&lazy->look_seen);
+    rift_free(lazy->next_members);
+    rift_free(lazy->key);
+    rift_free(lazy->scratch);
+    rift_free(lazy->look_members);
+    rift_free(lazy);
+}
+
+/**
+ * @brief Drop every cached DFA state
+ *
+ * @param lazy The lazy DFA
+ */
+void
+rift_lazy_dfa_flush(rift_lazy_dfa_t *lazy)
+{
+    if (!lazy) {
+        return;
+    }
+
+    RIFT_PROBE2(lazy_dfa__flush, lazy, lazy->cache->count);
+
+    /* Rows are reset when a state is inserted, so only the index needs clearing */
+    rift_subset_table_clear(lazy->cache);
+    lazy->cached_start = RIFT_SUBSET_NOT_FOUND;
+}
+
+/**
+ * @brief Set the bytes around the input of the following searches
+ *
+ * @param lazy The lazy DFA
+ * @param before Byte read just before the input, or RIFT_LAZY_DFA_TEXT_EDGE
+ * @param after Byte that would be read just after it, or RIFT_LAZY_DFA_TEXT_EDGE
+ */
+void
+rift_lazy_dfa_set_context(rift_lazy_dfa_t *lazy, int before, int after)
+{
+    if (!lazy) {
+        return;
+    }
+
+    // The start state is keyed by the byte before it
+    uint8_t behind = byte_look(before);
+    if (lazy->has_assertions && behind != lazy->look_behind) {
+        lazy->cached_start = RIFT_SUBSET_NOT_FOUND;
+    }
+    lazy->look_behind = behind;
+    lazy->look_ahead = byte_look(after);
+}
+
+/**
+ * @brief Read the input from the start state, remembering the accepted prefixes
+ *
+ * @param lazy The lazy DFA
+ * @param input The input of the search
+ * @param earliest Whether to stop at the shortest accepted prefix instead of the longest
+ * @param match_end Pointer to store the length of the accepted prefix (can be NULL)
+ * @param needs_more Pointer to store whether the input ran out before the search ended (can be
+ * NULL)
+ * @return true if a prefix (possibly empty) is accepted, false otherwise
+ */
+static bool
+walk(rift_lazy_dfa_t *lazy, const lazy_dfa_input_t *input, bool earliest, size_t *match_end,
+     bool *needs_more)
+{
+    if (needs_more) {
+        *needs_more = false;
+    }
+
+    if (!lazy || (!input->bytes && input->length > 0) || input->start_limit == 0) {
+        return false;
+    }
+
+    uint32_t state = start_state(lazy);
+    if (state == RIFT_SUBSET_NOT_FOUND) {
+        return false;
+    }
+
+    lazy_dfa_search_t search = {0, 0};
+    bool found = accepts_at(lazy, state, input, 0);
+    bool alive = true;
+    size_t end = 0;
+
+    for (size_t pos = 0; pos < input->length && !(found && earliest); pos++) {
+        if (lazy->state_flags[state] & LAZY_DFA_STATE_DEAD) {
+            alive = false;
+            break;
+        }
+
+        /* Cached transitions restart the search, so past the limit the set is stepped alone */
+        if (lazy->unanchored && pos + 1 >= input->start_limit) {
+            uint8_t behind = LAZY_DFA_LOOK_EDGE;
+            size_t num_members = state_members(lazy, state, lazy->next_members, &behind);
+            simulate_nfa(lazy, num_members, behind, input, pos, earliest, &found, &end, &alive);
+            break;
+        }
+
+        uint8_t byte = input_byte(input, pos);
+        uint32_t next =
+            lazy->transitions[(size_t)state * lazy->classes.num_classes + lazy->classes.map[byte]];
+
+        if (next == LAZY_DFA_UNKNOWN) {
+            size_t num_next = 0;
+            next = build_transition(lazy, &state, byte, &search, &num_next);
+            if (next == RIFT_SUBSET_NOT_FOUND) {
+                uint8_t behind = byte_look(byte);
+                if (set_accepts(lazy, lazy->next_members, num_next, behind,
+                                look_at(lazy, input, pos + 1))) {
+                    found = true;
+                    end = pos + 1;
+                }
+                alive = false;
+                if (!(found && earliest)) {
+                    lazy->stats.nfa_fallbacks++;
+                    RIFT_PROBE3(lazy_dfa__bailout, lazy, pos, lazy->cache->count);
+                    simulate_nfa(lazy, num_next, behind, input, pos + 1, earliest, &found, &end,
+                                 &alive);
+                }
+                break;
+            }
+        }
+
+        state = next;
+        search.bytes_since_flush++;
+
+        if (accepts_at(lazy, state, input, pos + 1)) {
+            found = true;
+            end = pos + 1;
+        }
+    }
+
+    // The search ended with the input in a live state, so more bytes could extend it
+    if (needs_more) {
+        bool dead = (lazy->state_flags[state] & LAZY_DFA_STATE_DEAD) != 0;
+        *needs_more = alive && !dead && !(found && earliest);
+    }
+
+    if (found && match_end) {
+        *match_end = end;
+    }
+    return found;
+}
+
+/**
+ * @brief Find a prefix of the input accepted by the automaton
+ *
+ * @param lazy The lazy DFA
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param earliest Whether to stop at the shortest accepted prefix instead of the longest
+ * @param match_end Pointer to store the length of the accepted prefix (can be NULL)
+ * @return true if a prefix (possibly empty) is accepted, false otherwise
+ */
+bool
+rift_lazy_dfa_match_prefix(rift_lazy_dfa_t *lazy, const char *input, size_t length,
+                           bool earliest, size_t *match_end)
+{
+    return rift_lazy_dfa_match_prefix_partial(lazy, input, length, earliest, match_end, NULL);
+}
+
+/**
+ * @brief Find a prefix of the input, telling whether more input could change it
+ *
+ * @param lazy The lazy DFA
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param earliest Whether to stop at the shortest accepted prefix instead of the longest
+ * @param match_end Pointer to store the length of the accepted prefix (can be NULL)
+ * @param needs_more Pointer to store whether the input ran out before the search ended (can be
+ * NULL)
+ * @return true if a prefix (possibly empty) is accepted, false otherwise
+ */
+bool
+rift_lazy_dfa_match_prefix_partial(rift_lazy_dfa_t *lazy, const char *input, size_t length,
+                                   bool earliest, size_t *match_end, bool *needs_more)
+{
+    lazy_dfa_input_t search_input = {input, length, false, SIZE_MAX};
+    return walk(lazy, &search_input, earliest, match_end, needs_more);
+}
+
+/**
+ * @brief Find a suffix of the input accepted by the automaton, reading backward
+ *
+ * @param lazy The lazy DFA, usually of a reversed automaton
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param earliest Whether to stop at the shortest accepted suffix instead of the longest
+ * @param match_length Pointer to store the length of the accepted suffix (can be NULL)
+ * @return true if a suffix (possibly empty) is accepted, false otherwise
+ */
+bool
+rift_lazy_dfa_match_suffix(rift_lazy_dfa_t *lazy, const char *input, size_t length,
+                           bool earliest, size_t *match_length)
+{
+    lazy_dfa_input_t search_input = {input, length, true, SIZE_MAX};
+    return walk(lazy, &search_input, earliest, match_length, NULL);
+}
+
+/**
+ * @brief Find where the first match starting before a limit ends
+ *
+ * @param lazy The lazy DFA, unanchored to let matches start anywhere
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param start_limit Position matches must start before
+ * @param match_end Pointer to store the end of the match (can be NULL)
+ * @return true if such a match exists, false otherwise
+ */
+bool
+rift_lazy_dfa_find_earliest_end(rift_lazy_dfa_t *lazy, const char *input, size_t length,
+                                size_t start_limit, size_t *match_end)
+{
+    lazy_dfa_input_t search_input = {input, length, false, start_limit};
+    return walk(lazy, &search_input, true, match_end, NULL);
+}
+
+/**
+ * @brief Check whether the whole input is accepted by the automaton
+ *
+ * @param lazy The lazy DFA
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @return true if the input is accepted, false otherwise
+ */
+bool
+rift_lazy_dfa_matches(rift_lazy_dfa_t *lazy, const char *input, size_t length)
+{
+    size_t end = 0;
+    return rift_lazy_dfa_match_prefix(lazy, input, length, false, &end) && end == length;
+}
+
+/**
+ * @brief Collect the accept tags of every state reached while reading the input
+ *
+ * @param lazy The lazy DFA
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param tags Bitset to fill, cleared first
+ * @param num_words Number of 64-bit words in tags
+ * @return true if successful, false on invalid parameters or allocation failure
+ */
+bool
+rift_lazy_dfa_scan_tags(rift_lazy_dfa_t *lazy, const char *input, size_t length, uint64_t *tags,
+                        size_t num_words)
+{
+    if (!lazy || (!input && length > 0) || !tags || num_words < lazy->tag_words) {
+        return false;
+    }
+
+    memset(tags, 0, num_words * sizeof(uint64_t));
+    if (lazy->tag_words == 0) {
+        return true;
+    }
+
+    uint32_t state = start_state(lazy);
+    if (state == RIFT_SUBSET_NOT_FOUND) {
+        return false;
+    }
+
+    lazy_dfa_input_t scan_input = {input, length, false, SIZE_MAX};
+    lazy_dfa_search_t search = {0, 0};
+    size_t looks = tag_looks(lazy);
+    size_t num_members = 0;
+    size_t pos = 0;
+
+    for (;; pos++) {
+        if (lazy->state_flags[state] & LAZY_DFA_STATE_ACCEPTING) {
+            size_t ahead = lazy->has_assertions ? look_at(lazy, &scan_input, pos) : 0;
+            const uint64_t *state_tags =
+                &lazy->state_tags[((size_t)state * looks + ahead) * lazy->tag_words];
+            for (size_t w = 0; w < lazy->tag_words; w++) {
+                tags[w] |= state_tags[w];
+            }
+        }
+
+        if (pos >= length || (lazy->state_flags[state] & LAZY_DFA_STATE_DEAD)) {
+            return true;
+        }
+
+        uint8_t byte = (uint8_t)input[pos];
+        uint32_t next =
+            lazy->transitions[(size_t)state * lazy->classes.num_classes + lazy->classes.map[byte]];
+
+        if (next == LAZY_DFA_UNKNOWN) {
+            next = build_transition(lazy, &state, byte, &search, &num_members);
+            if (next == RIFT_SUBSET_NOT_FOUND) {
+                break;
+            }
+        }
+
+        state = next;
+        search.bytes_since_flush++;
+    }
+
+    /* The cache thrashes: finish over raw state sets, starting from lazy->next_members */
+    uint32_t *current = lazy->next_members;
+    uint32_t *next = lazy->members;
+    uint8_t behind = byte_look((uint8_t)input[pos]);
+
+    lazy->stats.nfa_fallbacks++;
+    RIFT_PROBE3(lazy_dfa__bailout, lazy, pos, lazy->cache->count);
+
+    for (pos++;; pos++) {
+        add_context_tags(lazy, current, num_members, behind, look_at(lazy, &scan_input, pos),
+                         tags);
+        if (pos >= length || num_members == 0) {
+            return true;
+        }
+
+        num_members = step_set(lazy, current, num_members, behind, (uint8_t)input[pos], true, next);
+        behind = byte_look((uint8_t)input[pos]);
+
+        uint32_t *swap = current;
+        current = next;
+        next = swap;
+    }
+}
+
+/**
+ * @brief Add bytes to an FNV-1a hash
+ */
+static uint32_t
+fnv1a(uint32_t hash, const void *bytes, size_t length)
+{
+    const uint8_t *p = (const uint8_t *)bytes;
+    for (size_t i = 0; p && i < length; i++) {
+        hash = (hash ^ p[i]) * LAZY_DFA_FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * @brief Compute the fingerprint a saved cache must match
+ *
+ * Covers what the cached sets and transitions depend on: the states, edges
+ * and edge patterns of the NFA, its accepting states and tags, its state and
+ * automaton flags, and the byte classes transitions are indexed by.
+ *
+ * @param lazy The lazy DFA
+ * @return The fingerprint
+ */
+static uint32_t
+cache_fingerprint(const rift_lazy_dfa_t *lazy)
+{
+    const rift_frozen_automaton_t *nfa = lazy->nfa;
+    size_t n = nfa->num_states;
+    uint32_t hash = LAZY_DFA_FNV_OFFSET;
+
+    hash = fnv1a(hash, &nfa->num_states, sizeof(nfa->num_states));
+    hash = fnv1a(hash, &nfa->num_edges, sizeof(nfa->num_edges));
+    hash = fnv1a(hash, &nfa->start_state, sizeof(nfa->start_state));
+    hash = fnv1a(hash, nfa->edge_offsets, (n + 1) * sizeof(uint32_t));
+    hash = fnv1a(hash, nfa->edge_targets, nfa->num_edges * sizeof(uint32_t));
+    hash = fnv1a(hash, nfa->edge_flags, nfa->num_edges * sizeof(uint8_t));
+    hash = fnv1a(hash, nfa->edge_pattern_offsets, nfa->num_edges * sizeof(uint32_t));
+    hash = fnv1a(hash, nfa->string_pool, nfa->string_pool_size);
+    hash = fnv1a(hash, nfa->accept_bitmap, (n + 63) / 64 * sizeof(uint64_t));
+    hash = fnv1a(hash, nfa->accept_tag_offsets, (n + 1) * sizeof(uint32_t));
+    hash = fnv1a(hash, nfa->accept_tags, nfa->num_accept_tags * sizeof(uint32_t));
+    hash = fnv1a(hash, nfa->state_flags, n * sizeof(uint8_t));
+    hash = fnv1a(hash, &nfa->flags, sizeof(nfa->flags));
+    return fnv1a(hash, lazy->classes.map, sizeof(lazy->classes.map));
+}
+
+/**
+ * @brief Set an error code and message for a rejected saved cache
+ */
+static void
+set_cache_error(rift_regex_error_t *error, rift_regex_error_code_t code, const char *message)
+{
+    if (error) {
+        error->code = code;
+        snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH, "%s", message);
+    }
+}
+
+/**
+ * @brief Save the state cache of a lazy DFA
+ *
+ * @param lazy The lazy DFA
+ * @param data Output buffer (can be NULL to get size)
+ * @param size Size of output buffer or pointer to store required size
+ * @return true if successful, false on invalid parameters or a buffer too small
+ */
+bool
+rift_lazy_dfa_save_cache(const rift_lazy_dfa_t *lazy, uint8_t *data, size_t *size)
+{
+    if (!lazy || !size) {
+        return false;
+    }
+
+    size_t count = lazy->cache->count;
+    size_t set_bytes = lazy->cache->words * sizeof(uint64_t);
+    size_t row_bytes = lazy->classes.num_classes * sizeof(uint32_t);
+    size_t needed = sizeof(lazy_dfa_cache_header_t) + count * (set_bytes + row_bytes);
+    if (!data) {
+        *size = needed;
+        return true;
+    }
+    if (*size < needed) {
+        return false;
+    }
+
+    lazy_dfa_cache_header_t header = {RIFT_LAZY_DFA_CACHE_MAGIC,
+                                      RIFT_LAZY_DFA_CACHE_VERSION,
+                                      LAZY_DFA_CACHE_BYTE_ORDER,
+                                      cache_fingerprint(lazy),
+                                      lazy->nfa->num_states,
+                                      lazy->classes.num_classes,
+                                      lazy->unanchored ? 1u : 0u,
+                                      (uint32_t)count,
+                                      lazy->cached_start,
+                                      0};
+    memcpy(data, &header, sizeof(header));
+
+    uint8_t *sets = data + sizeof(header);
+    if (count > 0) {
+        memcpy(sets, rift_subset_table_get(lazy->cache, 0), count * set_bytes);
+        memcpy(sets + count * set_bytes, lazy->transitions, count * row_bytes);
+    }
+
+    *size = needed;
+    return true;
+}
+
+/**
+ * @brief Replace the state cache of a lazy DFA with a saved one
+ *
+ * @param lazy The lazy DFA
+ * @param data The saved cache
+ * @param size Size of the saved cache in bytes
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if the cache was loaded, false otherwise
+ */
+bool
+rift_lazy_dfa_load_cache(rift_lazy_dfa_t *lazy, const uint8_t *data, size_t size,
+                         rift_regex_error_t *error)
+{
+    lazy_dfa_cache_header_t header;
+    if (!lazy || !data || size < sizeof(header)) {
+        set_cache_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER, "Invalid saved cache");
+        return false;
+    }
+
+    memcpy(&header, data, sizeof(header));
+    if (header.magic != RIFT_LAZY_DFA_CACHE_MAGIC ||
+        header.version != RIFT_LAZY_DFA_CACHE_VERSION ||
+        header.byte_order != LAZY_DFA_CACHE_BYTE_ORDER) {
+        set_cache_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                        "Not a saved lazy DFA cache of this version and byte order");
+        return false;
+    }
+    if (header.num_nfa_states != lazy->nfa->num_states ||
+        header.num_classes != lazy->classes.num_classes ||
+        header.unanchored != (lazy->unanchored ? 1u : 0u) ||
+        header.fingerprint != cache_fingerprint(lazy)) {
+        set_cache_error(error, RIFT_REGEX_ERROR_INVALID_AUTOMATON,
+                        "Saved lazy DFA cache belongs to another automaton");
+        return false;
+    }
+
+    size_t count = header.num_states;
+    size_t words = lazy->cache->words;
+    size_t set_bytes = words * sizeof(uint64_t);
+    size_t row_bytes = lazy->classes.num_classes * sizeof(uint32_t);
+    if ((size - sizeof(header)) / (set_bytes + row_bytes) < count ||
+        size != sizeof(header) + count * (set_bytes + row_bytes) ||
+        (header.start_state >= count && header.start_state != RIFT_SUBSET_NOT_FOUND)) {
+        set_cache_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER, "Truncated saved cache");
+        return false;
+    }
+
+    // Every transition must lead to a saved state or be unknown
+    const uint8_t *sets = data + sizeof(header);
+    const uint8_t *rows = sets + count * set_bytes;
+    for (size_t i = 0; i < count * lazy->classes.num_classes; i++) {
+        uint32_t target;
+        memcpy(&target, rows + i * sizeof(uint32_t), sizeof(target));
+        if (target >= count && target != LAZY_DFA_UNKNOWN) {
+            set_cache_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                            "Saved cache has a transition to no state");
+            return false;
+        }
+    }
+
+    // States are inserted in saved order, so their indices stay those of the transitions
+    size_t loaded = count < lazy->max_cached_states ? count : lazy->max_cached_states;
+    size_t key_bits = lazy->nfa->num_states + (lazy->has_assertions ? LAZY_DFA_LOOK_BITS : 0);
+    size_t tail = key_bits % 64;
+    rift_lazy_dfa_stats_t stats = lazy->stats;
+    rift_lazy_dfa_flush(lazy);
+    for (size_t i = 0; i < loaded; i++) {
+        memcpy(lazy->key, sets + i * set_bytes, set_bytes);
+        bool stray = tail != 0 && (lazy->key[words - 1] >> tail) != 0;
+        size_t num_members = stray ? 0 : bitset_members(lazy->key, words, lazy->members);
+        uint8_t behind = split_look(lazy, lazy->members, &num_members);
+        memset(lazy->key, 0, set_bytes);
+
+        if (stray || cache_lookup(lazy, lazy->members, num_members, behind, true) != i) {
+            lazy->stats = stats;
+            rift_lazy_dfa_flush(lazy);
+            set_cache_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                            "Saved cache has an invalid or repeated state set");
+            return false;
+        }
+    }
+    lazy->stats = stats;
+
+    // Transitions to states left out are built again on demand
+    for (size_t i = 0; i < loaded * lazy->classes.num_classes; i++) {
+        uint32_t target;
+        memcpy(&target, rows + i * sizeof(uint32_t), sizeof(target));
+        lazy->transitions[i] = target < loaded ? target : LAZY_DFA_UNKNOWN;
+    }
+    lazy->cached_start = header.start_state < loaded && !lazy->has_assertions
+                             ? header.start_state
+                             : RIFT_SUBSET_NOT_FOUND;
+    return true;
+}
+
+/**
+ * @brief Get the number of DFA states currently cached
+ *
+ * @param lazy The lazy DFA
+ * @return Number of cached states
+ */
+size_t
+rift_lazy_dfa_cached_states(const rift_lazy_dfa_t *lazy)
+{
+    return lazy ? lazy->cache->count : 0;
+}
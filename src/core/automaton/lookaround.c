@@ -0,0 +1,232 @@
+/**
+ * @file lookaround.c
+ * @brief Implementation of lookaround assertions for the LibRift regex engine
+ *
+ * This file keeps the lookaround table of an automaton and evaluates its
+ * entries. A lookahead is an anchored prefix search that stops at the first
+ * match; a lookbehind of length n is a full match over the n bytes before
+ * the position, which cannot start before the input.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/automaton/lookaround.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/memory/memory.h"
+
+/**
+ * @brief Add a lookaround to the table of an automaton
+ */
+uint32_t
+rift_automaton_add_lookaround(rift_regex_automaton_t *automaton, rift_regex_automaton_t *body,
+                              bool is_behind, bool is_negated, uint32_t length)
+{
+    if (!automaton || !body || automaton->num_lookarounds >= RIFT_STATE_NO_LOOKAROUND - 1) {
+        rift_automaton_free(body);
+        return RIFT_STATE_NO_LOOKAROUND;
+    }
+
+    rift_lookaround_t *lookarounds = (rift_lookaround_t *)rift_realloc(
+        automaton->lookarounds, (automaton->num_lookarounds + 1) * sizeof(rift_lookaround_t));
+    if (!lookarounds) {
+        rift_automaton_free(body);
+        return RIFT_STATE_NO_LOOKAROUND;
+    }
+
+    rift_lookaround_t *entry = &lookarounds[automaton->num_lookarounds];
+    entry->body = body;
+    entry->is_behind = is_behind;
+    entry->is_negated = is_negated;
+    entry->length = length;
+
+    automaton->lookarounds = lookarounds;
+    return (uint32_t)automaton->num_lookarounds++;
+}
+
+/**
+ * @brief Copy the lookaround table of an automaton into another
+ */
+bool
+rift_automaton_copy_lookarounds(rift_regex_automaton_t *target,
+                                const rift_regex_automaton_t *source)
+{
+    if (!target || !source) {
+        return false;
+    }
+
+    for (size_t i = 0; i < source->num_lookarounds; i++) {
+        const rift_lookaround_t *entry = &source->lookarounds[i];
+        rift_regex_automaton_t *body = rift_automaton_clone(entry->body);
+        if (!body || rift_automaton_add_lookaround(target, body, entry->is_behind,
+                                                   entry->is_negated,
+                                                   entry->length) == RIFT_STATE_NO_LOOKAROUND) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Free the lookaround table of an automaton
+ */
+void
+rift_automaton_free_lookarounds(rift_regex_automaton_t *automaton)
+{
+    if (!automaton) {
+        return;
+    }
+
+    for (size_t i = 0; i < automaton->num_lookarounds; i++) {
+        rift_automaton_free(automaton->lookarounds[i].body);
+    }
+    rift_free(automaton->lookarounds);
+    automaton->lookarounds = NULL;
+    automaton->num_lookarounds = 0;
+}
+
+/**
+ * @brief Check whether an automaton has lookaround states
+ */
+bool
+rift_automaton_has_lookarounds(const rift_regex_automaton_t *automaton)
+{
+    return automaton && automaton->num_lookarounds > 0;
+}
+
+/**
+ * @brief Create an evaluator under the tag already in use
+ */
+static rift_lookaround_evaluator_t *
+create_evaluator(const rift_regex_automaton_t *automaton, rift_regex_error_t *error)
+{
+    size_t count = automaton->num_lookarounds;
+    rift_lookaround_evaluator_t *evaluator =
+        (rift_lookaround_evaluator_t *)rift_calloc(1, sizeof(rift_lookaround_evaluator_t));
+    if (!evaluator) {
+        goto memory_error;
+    }
+
+    evaluator->count = count;
+    evaluator->info = (rift_lookaround_t *)rift_malloc(count * sizeof(rift_lookaround_t));
+    evaluator->dfas = (rift_lazy_dfa_t **)rift_calloc(count, sizeof(rift_lazy_dfa_t *));
+    evaluator->cached_positions = (size_t *)rift_malloc(count * sizeof(size_t));
+    evaluator->cached_results = (bool *)rift_calloc(count, sizeof(bool));
+    if (!evaluator->info || !evaluator->dfas || !evaluator->cached_positions ||
+        !evaluator->cached_results) {
+        goto memory_error;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        evaluator->info[i] = automaton->lookarounds[i];
+        evaluator->info[i].body = NULL;
+        evaluator->dfas[i] = rift_lazy_dfa_create(automaton->lookarounds[i].body,
+                                                  RIFT_LOOKAROUND_CACHE_STATES, error);
+        if (!evaluator->dfas[i]) {
+            rift_lookaround_evaluator_free(evaluator);
+            return NULL;
+        }
+    }
+
+    rift_lookaround_evaluator_reset(evaluator);
+    return evaluator;
+
+memory_error:
+    if (error) {
+        error->code = RIFT_REGEX_ERROR_MEMORY;
+        snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                 "Failed to allocate lookaround evaluator");
+    }
+    rift_lookaround_evaluator_free(evaluator);
+    return NULL;
+}
+
+/**
+ * @brief Create an evaluator for the lookarounds of an automaton
+ */
+rift_lookaround_evaluator_t *
+rift_lookaround_evaluator_create(const rift_regex_automaton_t *automaton,
+                                 rift_regex_error_t *error)
+{
+    if (!rift_automaton_has_lookarounds(automaton)) {
+        return NULL;
+    }
+
+    rift_memory_tag_t outer = rift_memory_tag_use(RIFT_MEMORY_TAG_VM);
+    rift_lookaround_evaluator_t *evaluator = create_evaluator(automaton, error);
+    rift_memory_tag_use(outer);
+    return evaluator;
+}
+
+/**
+ * @brief Free a lookaround evaluator
+ */
+void
+rift_lookaround_evaluator_free(rift_lookaround_evaluator_t *evaluator)
+{
+    if (!evaluator) {
+        return;
+    }
+
+    if (evaluator->dfas) {
+        for (size_t i = 0; i < evaluator->count; i++) {
+            rift_lazy_dfa_free(evaluator->dfas[i]);
+        }
+    }
+    rift_free(evaluator->info);
+    rift_free(evaluator->dfas);
+    rift_free(evaluator->cached_positions);
+    rift_free(evaluator->cached_results);
+    rift_free(evaluator);
+}
+
+/**
+ * @brief Forget the kept results, before a search over new input
+ */
+void
+rift_lookaround_evaluator_reset(rift_lookaround_evaluator_t *evaluator)
+{
+    if (!evaluator) {
+        return;
+    }
+
+    for (size_t i = 0; i < evaluator->count; i++) {
+        evaluator->cached_positions[i] = SIZE_MAX;
+    }
+}
+
+/**
+ * @brief Check whether a lookaround holds at an input position
+ */
+bool
+rift_lookaround_evaluator_test(rift_lookaround_evaluator_t *evaluator, uint32_t index,
+                               const char *input, size_t length, size_t position)
+{
+    if (!evaluator || index >= evaluator->count || position > length) {
+        return false;
+    }
+
+    if (evaluator->cached_positions[index] == position) {
+        return evaluator->cached_results[index];
+    }
+
+    // Empty input may come without a buffer
+    const rift_lookaround_t *info = &evaluator->info[index];
+    const char *at = input ? input + position : NULL;
+    bool matched;
+    if (info->is_behind) {
+        matched = position >= info->length &&
+                  rift_lazy_dfa_matches(evaluator->dfas[index], at ? at - info->length : NULL,
+                                        info->length);
+    } else {
+        matched = rift_lazy_dfa_match_prefix(evaluator->dfas[index], at, length - position, true,
+                                             NULL);
+    }
+
+    bool holds = matched != info->is_negated;
+    evaluator->cached_positions[index] = position;
+    evaluator->cached_results[index] = holds;
+    return holds;
+}
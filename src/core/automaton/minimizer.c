@@ -15669,6 +15669,8 @@ utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 #include <stdlib.h>
 #include <string.h>
 #include "core/automaton/automaton.h"
+#include "core/automaton/hopcroft.h"
+#include "core/automaton/product.h"
 #include "core/automaton/state.h"
 #include "core/errors/error.h"
 #include "core/memory/memory.h"
@@ -16685,9 +16687,6 @@ utomaton/minimizer.h"/a #include "core/config/config.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
-/* Maximum states constant for working buffers */
-#define MAX_STATES 1000
-
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
@@ -17318,16 +17317,6 @@ utomaton/minimizer.h"/a #include "core/config/config.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
-/**
- * @brief Equivalence class structure for state grouping
- */
-typedef struct {
-    size_t *state_ids; /**< Array of state IDs in this class */
-    size_t num_states; /**< Number of states in this class */
-    size_t capacity;   /**< Capacity of the state_ids array */
-    char *signature;   /**< Signature representing behavior */
-} equivalence_class_t;
-
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
@@ -17958,16 +17947,6 @@ utomaton/minimizer.h"/a #include "core/config/config.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
-/**
- * @brief State minimizer context for Hopcroft's algorithm
- */
-typedef struct {
-    rift_regex_automaton_t *automaton; /**< Automaton being minimized */
-    equivalence_class_t **classes;     /**< Array of equivalence classes */
-    size_t num_classes;                /**< Number of classes */
-    size_t class_capacity;             /**< Capacity of classes array */
-} state_minimizer_t;
-
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
@@ -18598,48 +18577,6 @@ utomaton/minimizer.h"/a #include "core/config/config.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
-/**
- * @brief Create a new equivalence class
- *
- * @param signature Behavioral signature for this class
- * @return New equivalence class or NULL on failure
- */
-static equivalence_class_t *
-equivalence_class_create(const char *signature)
-{
-    if (!signature) {
-        return NULL;
-    }
-
-    equivalence_class_t *eclass = (equivalence_class_t *)rift_malloc(sizeof(equivalence_class_t));
-    if (!eclass) {
-        return NULL;
-    }
-
-    /* Initialize the class */
-    eclass->state_ids = NULL;
-    eclass->num_states = 0;
-    eclass->capacity = 0;
-
-    /* Copy the signature */
-    eclass->signature = rift_strdup(signature);
-    if (!eclass->signature) {
-        rift_free(eclass);
-        return NULL;
-    }
-
-    /* Start with a reasonable capacity */
-    eclass->capacity = 8;
-    eclass->state_ids = (size_t *)rift_malloc(sizeof(size_t) * eclass->capacity);
-    if (!eclass->state_ids) {
-        rift_free(eclass->signature);
-        rift_free(eclass);
-        return NULL;
-    }
-
-    return eclass;
-}
-
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
@@ -19270,29 +19207,6 @@ utomaton/minimizer.h"/a #include "core/config/config.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
-/**
- * @brief Free an equivalence class and its resources
- *
- * @param eclass The class to free
- */
-static void
-equivalence_class_free(equivalence_class_t *eclass)
-{
-    if (!eclass) {
-        return;
-    }
-
-    if (eclass->state_ids) {
-        rift_free(eclass->state_ids);
-    }
-
-    if (eclass->signature) {
-        rift_free(eclass->signature);
-    }
-
-    rift_free(eclass);
-}
-
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
@@ -19923,39 +19837,6 @@ utomaton/minimizer.h"/a #include "core/config/config.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
-/**
- * @brief Add a state to an equivalence class
- *
- * @param eclass The equivalence class
- * @param state_id State ID to add
- * @return true if successful, false on failure
- */
-static bool
-equivalence_class_add_state(equivalence_class_t *eclass, size_t state_id)
-{
-    if (!eclass) {
-        return false;
-    }
-
-    /* Resize if necessary */
-    if (eclass->num_states >= eclass->capacity) {
-        size_t new_capacity = eclass->capacity * 2;
-        size_t *new_state_ids =
-            (size_t *)rift_realloc(eclass->state_ids, sizeof(size_t) * new_capacity);
-
-        if (!new_state_ids) {
-            return false;
-        }
-
-        eclass->state_ids = new_state_ids;
-        eclass->capacity = new_capacity;
-    }
-
-    /* Add the state ID */
-    eclass->state_ids[eclass->num_states++] = state_id;
-    return true;
-}
-
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
@@ -20586,29 +20467,6 @@ utomaton/minimizer.h"/a #include "core/config/config.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
-/**
- * @brief Check if a class contains a specific state
- *
- * @param eclass The class to check
- * @param state_id State ID to look for
- * @return true if state is in the class, false otherwise
- */
-static bool
-equivalence_class_contains_state(const equivalence_class_t *eclass, size_t state_id)
-{
-    if (!eclass) {
-        return false;
-    }
-
-    for (size_t i = 0; i < eclass->num_states; i++) {
-        if (eclass->state_ids[i] == state_id) {
-            return true;
-        }
-    }
-
-    return false;
-}
-
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
@@ -21239,22 +21097,6 @@ utomaton/minimizer.h"/a #include "core/config/config.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
-/**
- * @brief Get a representative state from a class
- *
- * @param eclass The equivalence class
- * @return Representative state ID or (size_t)-1 if empty
- */
-static size_t
-equivalence_class_get_representative(const equivalence_class_t *eclass)
-{
-    if (!eclass || eclass->num_states == 0) {
-        return (size_t)-1;
-    }
-
-    return eclass->state_ids[0];
-}
-
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
@@ -21885,57 +21727,6 @@ utomaton/minimizer.h"/a #include "core/config/config.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
-/**
- * @brief Split a class based on a discriminator
- *
- * @param eclass Original class to split
- * @param new_signature Signature for the new class
- * @param state_ids States to move to the new class
- * @param num_states Number of states to move
- * @return New equivalence class or NULL on failure
- */
-static equivalence_class_t *
-equivalence_class_split(equivalence_class_t *eclass, const char *new_signature, size_t *state_ids,
-                        size_t num_states)
-{
-    if (!eclass || !new_signature || !state_ids || num_states == 0) {
-        return NULL;
-    }
-
-    /* Create the new class */
-    equivalence_class_t *new_class = equivalence_class_create(new_signature);
-    if (!new_class) {
-        return NULL;
-    }
-
-    /* Move states to the new class */
-    for (size_t i = 0; i < num_states; i++) {
-        if (!equivalence_class_add_state(new_class, state_ids[i])) {
-            equivalence_class_free(new_class);
-            return NULL;
-        }
-    }
-
-    /* Remove moved states from the original class */
-    size_t j = 0;
-    for (size_t i = 0; i < eclass->num_states; i++) {
-        bool found = false;
-        for (size_t k = 0; k < num_states; k++) {
-            if (eclass->state_ids[i] == state_ids[k]) {
-                found = true;
-                break;
-            }
-        }
-
-        if (!found) {
-            eclass->state_ids[j++] = eclass->state_ids[i];
-        }
-    }
-
-    eclass->num_states = j;
-    return new_class;
-}
-
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
@@ -22566,38 +22357,6 @@ utomaton/minimizer.h"/a #include "core/config/config.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
-/**
- * @brief Initialize a state minimizer
- *
- * @param minimizer Minimizer to initialize
- * @param automaton Automaton to minimize
- * @return true if successful, false otherwise
- */
-static bool
-state_minimizer_init(state_minimizer_t *minimizer, rift_regex_automaton_t *automaton)
-{
-    if (!minimizer || !automaton) {
-        return false;
-    }
-
-    /* Initialize the minimizer */
-    minimizer->automaton = automaton;
-    minimizer->classes = NULL;
-    minimizer->num_classes = 0;
-    minimizer->class_capacity = 0;
-
-    /* Allocate initial capacity */
-    minimizer->class_capacity = 8;
-    minimizer->classes = (equivalence_class_t **)rift_malloc(sizeof(equivalence_class_t *) *
-                                                             minimizer->class_capacity);
-
-    if (!minimizer->classes) {
-        return false;
-    }
-
-    return true;
-}
-
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
@@ -23228,29 +22987,6 @@ utomaton/minimizer.h"/a #include "core/config/config.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
-/**
- * @brief Find which equivalence class contains a state
- *
- * @param minimizer The state minimizer
- * @param state_id State ID to find
- * @return Matching equivalence class or NULL if not found
- */
-static equivalence_class_t *
-find_equivalence_class(const state_minimizer_t *minimizer, size_t state_id)
-{
-    if (!minimizer) {
-        return NULL;
-    }
-
-    for (size_t i = 0; i < minimizer->num_classes; i++) {
-        if (equivalence_class_contains_state(minimizer->classes[i], state_id)) {
-            return minimizer->classes[i];
-        }
-    }
-
-    return NULL;
-}
-
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
@@ -23881,39 +23617,6 @@ utomaton/minimizer.h"/a #include "core/config/config.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
-/**
- * @brief Add an equivalence class to the minimizer
- *
- * @param minimizer The state minimizer
- * @param eclass Class to add
- * @return true if successful, false otherwise
- */
-static bool
-state_minimizer_add_class(state_minimizer_t *minimizer, equivalence_class_t *eclass)
-{
-    if (!minimizer || !eclass) {
-        return false;
-    }
-
-    /* Resize if necessary */
-    if (minimizer->num_classes >= minimizer->class_capacity) {
-        size_t new_capacity = minimizer->class_capacity * 2;
-        equivalence_class_t **new_classes = (equivalence_class_t **)rift_realloc(
-            minimizer->classes, sizeof(equivalence_class_t *) * new_capacity);
-
-        if (!new_classes) {
-            return false;
-        }
-
-        minimizer->classes = new_classes;
-        minimizer->class_capacity = new_capacity;
-    }
-
-    /* Add the class */
-    minimizer->classes[minimizer->num_classes++] = eclass;
-    return true;
-}
-
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
@@ -24544,82 +24247,6 @@ utomaton/minimizer.h"/a #include "core/config/config.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
-/**
- * @brief Compute the initial partition (accepting vs. non-accepting states)
- *
- * @param minimizer The state minimizer
- * @return true if successful, false otherwise
- */
-static bool
-state_minimizer_compute_initial_partition(state_minimizer_t *minimizer)
-{
-    if (!minimizer || !minimizer->automaton) {
-        return false;
-    }
-
-    /* Create the two initial classes */
-    equivalence_class_t *accepting = equivalence_class_create("accepting");
-    equivalence_class_t *non_accepting = equivalence_class_create("non-accepting");
-
-    if (!accepting || !non_accepting) {
-        if (accepting)
-            equivalence_class_free(accepting);
-        if (non_accepting)
-            equivalence_class_free(non_accepting);
-        return false;
-    }
-
-    /* Classify all states */
-    size_t state_count = rift_automaton_get_state_count(minimizer->automaton);
-
-    for (size_t i = 0; i < state_count; i++) {
-        rift_regex_state_t *state = rift_automaton_get_state_by_index(minimizer->automaton, i);
-        if (!state) {
-            continue;
-        }
-
-        size_t state_id = rift_automaton_get_state_id(state);
-        bool is_accepting = rift_automaton_is_state_accepting(minimizer->automaton, state);
-
-        /* Add to appropriate class */
-        if (is_accepting) {
-            if (!equivalence_class_add_state(accepting, state_id)) {
-                equivalence_class_free(accepting);
-                equivalence_class_free(non_accepting);
-                return false;
-            }
-        } else {
-            if (!equivalence_class_add_state(non_accepting, state_id)) {
-                equivalence_class_free(accepting);
-                equivalence_class_free(non_accepting);
-                return false;
-            }
-        }
-    }
-
-    /* Add classes to minimizer if not empty */
-    if (accepting->num_states > 0) {
-        if (!state_minimizer_add_class(minimizer, accepting)) {
-            equivalence_class_free(accepting);
-            equivalence_class_free(non_accepting);
-            return false;
-        }
-    } else {
-        equivalence_class_free(accepting);
-    }
-
-    if (non_accepting->num_states > 0) {
-        if (!state_minimizer_add_class(minimizer, non_accepting)) {
-            equivalence_class_free(non_accepting);
-            return false;
-        }
-    } else {
-        equivalence_class_free(non_accepting);
-    }
-
-    return true;
-}
-
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
@@ -25250,88 +24877,6 @@ utomaton/minimizer.h"/a #include "core/config/config.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
-/**
- * @brief Compute a behavioral signature for a state
- *
- * @param minimizer The state minimizer
- * @param state State to analyze
- * @return Signature string (caller must free) or NULL on failure
- */
-static char *
-state_minimizer_compute_signature(const state_minimizer_t *minimizer,
-                                  const rift_regex_state_t *state)
-{
-    if (!minimizer || !state) {
-        return NULL;
-    }
-
-    /* Allocate signature buffer */
-    size_t buffer_size = 1024;
-    char *signature = (char *)rift_malloc(buffer_size);
-    if (!signature) {
-        return NULL;
-    }
-
-    signature[0] = '\0';
-    size_t pos = 0;
-
-    /* Get all transitions from this state */
-    size_t transition_count = rift_automaton_get_state_transition_count(state);
-
-    for (size_t i = 0; i < transition_count; i++) {
-        rift_regex_transition_t *transition = rift_automaton_get_state_transition(state, i);
-        if (!transition) {
-            continue;
-        }
-
-        /* Get the target state and its class */
-        rift_regex_state_t *target = rift_automaton_transition_get_target(transition);
-        if (!target) {
-            continue;
-        }
-
-        size_t target_id = rift_automaton_get_state_id(target);
-        equivalence_class_t *target_class = find_equivalence_class(minimizer, target_id);
-        if (!target_class) {
-            continue;
-        }
-
-        /* Find the class index */
-        size_t class_index = 0;
-        for (size_t j = 0; j < minimizer->num_classes; j++) {
-            if (minimizer->classes[j] == target_class) {
-                class_index = j;
-                break;
-            }
-        }
-
-        /* Get transition pattern */
-        const char *pattern = rift_automaton_transition_get_pattern(transition);
-        if (!pattern) {
-            /* For epsilon transitions */
-            pattern = "ε";
-        }
-
-        /* Add to signature */
-        int chars_written =
-            snprintf(signature + pos, buffer_size - pos, "%s:%zu,", pattern, class_index);
-
-        if (chars_written < 0 || (size_t)chars_written >= buffer_size - pos) {
-            rift_free(signature);
-            return NULL;
-        }
-
-        pos += chars_written;
-    }
-
-    /* Remove trailing comma */
-    if (pos > 0 && signature[pos - 1] == ',') {
-        signature[pos - 1] = '\0';
-    }
-
-    return signature;
-}
-
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
@@ -25962,135 +25507,6 @@ utomaton/minimizer.h"/a #include "core/config/config.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
-/**
- * @brief Split an equivalence class based on behavior
- *
- * @param minimizer The state minimizer
- * @param eclass Class to split
- * @return Number of new classes created (0 if no split)
- */
-static int
-split_equivalence_class(state_minimizer_t *minimizer, equivalence_class_t *eclass)
-{
-    if (!minimizer || !eclass || eclass->num_states <= 1) {
-        return 0;
-    }
-
-    /* Map from signature to states with that signature */
-    typedef struct {
-        char *signature;
-        size_t *state_ids;
-        size_t num_states;
-        size_t capacity;
-    } signature_group_t;
-
-    signature_group_t *groups = NULL;
-    size_t num_groups = 0;
-    size_t group_capacity = 0;
-
-    /* Group states by behavior */
-    for (size_t i = 0; i < eclass->num_states; i++) {
-        size_t state_id = eclass->state_ids[i];
-        rift_regex_state_t *state = rift_automaton_find_state_by_id(minimizer->automaton, state_id);
-        if (!state) {
-            continue;
-        }
-
-        /* Compute behavior signature */
-        char *signature = state_minimizer_compute_signature(minimizer, state);
-        if (!signature) {
-            continue;
-        }
-
-        /* Find or create group for this signature */
-        size_t group_index = (size_t)-1;
-        for (size_t j = 0; j < num_groups; j++) {
-            if (strcmp(groups[j].signature, signature) == 0) {
-                group_index = j;
-                break;
-            }
-        }
-
-        if (group_index == (size_t)-1) {
-            /* Create new group */
-            if (num_groups >= group_capacity) {
-                size_t new_capacity = group_capacity == 0 ? 4 : group_capacity * 2;
-                signature_group_t *new_groups = (signature_group_t *)rift_realloc(
-                    groups, sizeof(signature_group_t) * new_capacity);
-
-                if (!new_groups) {
-                    rift_free(signature);
-                    goto cleanup;
-                }
-
-                groups = new_groups;
-                group_capacity = new_capacity;
-            }
-
-            /* Initialize new group */
-            groups[num_groups].signature = signature;
-            groups[num_groups].state_ids =
-                (size_t *)rift_malloc(sizeof(size_t) * eclass->num_states);
-            groups[num_groups].num_states = 0;
-            groups[num_groups].capacity = eclass->num_states;
-
-            if (!groups[num_groups].state_ids) {
-                rift_free(signature);
-                goto cleanup;
-            }
-
-            group_index = num_groups++;
-        } else {
-            /* Group already exists */
-            rift_free(signature);
-        }
-
-        /* Add state to its group */
-        groups[group_index].state_ids[groups[group_index].num_states++] = state_id;
-    }
-
-    /* If all states have same signature, no split needed */
-    if (num_groups <= 1) {
-        goto cleanup;
-    }
-
-    /* Split into multiple classes */
-    for (size_t i = 1; i < num_groups; i++) {
-        equivalence_class_t *new_class = equivalence_class_split(
-            eclass, groups[i].signature, groups[i].state_ids, groups[i].num_states);
-
-        if (!new_class) {
-            goto cleanup;
-        }
-
-        /* Add new class to minimizer */
-        if (!state_minimizer_add_class(minimizer, new_class)) {
-            equivalence_class_free(new_class);
-            goto cleanup;
-        }
-    }
-
-    /* Cleanup and return success */
-    for (size_t i = 0; i < num_groups; i++) {
-        rift_free(groups[i].signature);
-        rift_free(groups[i].state_ids);
-    }
-    rift_free(groups);
-
-    return num_groups - 1; /* Number of new classes created */
-
-cleanup:
-    /* Handle failure case */
-    if (groups) {
-        for (size_t i = 0; i < num_groups; i++) {
-            rift_free(groups[i].signature);
-            rift_free(groups[i].state_ids);
-        }
-        rift_free(groups);
-    }
-    return 0;
-}
-
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
@@ -26721,37 +26137,6 @@ utomaton/minimizer.h"/a #include "core/config/config.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
-/**
- * @brief Refine partition until no further splits are possible
- *
- * @param minimizer The state minimizer
- * @return 0 if refined, 1 if stable, negative on error
- */
-static int
-state_minimizer_refine_partition(state_minimizer_t *minimizer)
-{
-    if (!minimizer) {
-        return -1;
-    }
-
-    bool changed = false;
-
-    /* Try to split each class */
-    for (size_t i = 0; i < minimizer->num_classes; i++) {
-        int split_result = split_equivalence_class(minimizer, minimizer->classes[i]);
-
-        if (split_result < 0) {
-            return -1;
-        }
-
-        if (split_result > 0) {
-            changed = true;
-        }
-    }
-
-    return changed ? 0 : 1; /* 0 if refined, 1 if stable */
-}
-
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
@@ -27382,189 +26767,6 @@ utomaton/minimizer.h"/a #include "core/config/config.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
-/**
- * @brief Create the minimized automaton from equivalence classes
- *
- * @param minimizer The state minimizer
- * @return New minimized automaton or NULL on failure
- */
-static rift_regex_automaton_t *
-state_minimizer_create_minimized_automaton(const state_minimizer_t *minimizer)
-{
-    if (!minimizer) {
-        return NULL;
-    }
-
-    /* Create new automaton of appropriate type */
-    rift_regex_automaton_t *minimized =
-        rift_automaton_create(rift_automaton_get_type(minimizer->automaton));
-
-    if (!minimized) {
-        return NULL;
-    }
-
-    /* Create a state for each equivalence class */
-    for (size_t i = 0; i < minimizer->num_classes; i++) {
-        equivalence_class_t *eclass = minimizer->classes[i];
-
-        /* Get a representative state */
-        size_t rep_id = equivalence_class_get_representative(eclass);
-        if (rep_id == (size_t)-1) {
-            rift_automaton_free(minimized);
-            return NULL;
-        }
-
-        rift_regex_state_t *rep_state =
-            rift_automaton_find_state_by_id(minimizer->automaton, rep_id);
-        if (!rep_state) {
-            rift_automaton_free(minimized);
-            return NULL;
-        }
-
-        /* Create corresponding state in new automaton */
-        rift_regex_state_t *new_state = rift_automaton_create_state(minimized, false);
-        if (!new_state) {
-            rift_automaton_free(minimized);
-            return NULL;
-        }
-
-        /* Transfer properties from representative */
-        if (rift_automaton_is_state_accepting(minimizer->automaton, rep_state)) {
-            rift_automaton_set_state_accepting(minimized, new_state, true);
-        }
-
-        /* If representative is initial state, make this the initial state */
-        rift_regex_state_t *original_initial =
-            rift_automaton_get_initial_state(minimizer->automaton);
-
-        if (original_initial && rep_id == rift_automaton_get_state_id(original_initial)) {
-            rift_automaton_set_initial_state(minimized, new_state);
-        }
-
-        /* Store mapping for transition creation */
-        rift_automaton_set_state_user_data(new_state, eclass);
-    }
-
-    /* Create transitions between states in minimized automaton */
-    for (size_t i = 0; i < minimizer->num_classes; i++) {
-        equivalence_class_t *from_class = minimizer->classes[i];
-
-        /* Get a representative state */
-        size_t rep_id = equivalence_class_get_representative(from_class);
-        if (rep_id == (size_t)-1) {
-            rift_automaton_free(minimized);
-            return NULL;
-        }
-
-        rift_regex_state_t *rep_state =
-            rift_automaton_find_state_by_id(minimizer->automaton, rep_id);
-        if (!rep_state) {
-            rift_automaton_free(minimized);
-            return NULL;
-        }
-
-        /* Get all transitions from this state */
-        size_t transition_count = rift_automaton_get_state_transition_count(rep_state);
-
-        for (size_t j = 0; j < transition_count; j++) {
-            rift_regex_transition_t *transition = rift_automaton_get_state_transition(rep_state, j);
-            if (!transition) {
-                continue;
-            }
-
-            /* Get target state and its class */
-            rift_regex_state_t *target = rift_automaton_transition_get_target(transition);
-            if (!target) {
-                continue;
-            }
-
-            size_t target_id = rift_automaton_get_state_id(target);
-            equivalence_class_t *to_class = find_equivalence_class(minimizer, target_id);
-            if (!to_class) {
-                continue;
-            }
-
-            /* Find corresponding states in minimized automaton */
-            rift_regex_state_t *from_state = NULL;
-            rift_regex_state_t *to_state = NULL;
-
-            size_t state_count = rift_automaton_get_state_count(minimized);
-            for (size_t k = 0; k < state_count; k++) {
-                rift_regex_state_t *state = rift_automaton_get_state_by_index(minimized, k);
-                if (!state) {
-                    continue;
-                }
-
-                equivalence_class_t *class =
-                    (equivalence_class_t *)rift_automaton_get_state_user_data(state);
-
-                if (class == from_class) {
-                    from_state = state;
-                }
-
-                if (class == to_class) {
-                    to_state = state;
-                }
-
-                if (from_state && to_state) {
-                    break;
-                }
-            }
-
-            if (!from_state || !to_state) {
-                continue;
-            }
-
-            /* Create equivalent transition */
-            const char *pattern = rift_automaton_transition_get_pattern(transition);
-
-            if (rift_automaton_is_epsilon_transition(transition)) {
-                rift_automaton_create_epsilon_transition(minimized, from_state, to_state);
-            } else if (pattern) {
-                /* Only create this transition if it doesn't already exist */
-                bool exists = false;
-                size_t from_transitions = rift_automaton_get_state_transition_count(from_state);
-
-                for (size_t k = 0; k < from_transitions; k++) {
-                    rift_regex_transition_t *existing =
-                        rift_automaton_get_state_transition(from_state, k);
-
-                    if (!existing) {
-                        continue;
-                    }
-
-                    if (rift_automaton_transition_get_target(existing) == to_state) {
-                        const char *existing_pattern =
-                            rift_automaton_transition_get_pattern(existing);
-
-                        if (existing_pattern && strcmp(existing_pattern, pattern) == 0) {
-                            exists = true;
-                            break;
-                        }
-                    }
-                }
-
-                if (!exists) {
-                    if (minimized && from_state && to_state && pattern) {
-                        rift_automaton_add_transition(minimized, from_state, to_state, pattern);
-                    }
-                }
-            }
-        }
-    }
-
-    /* Clear the temporary user data */
-    size_t state_count = rift_automaton_get_state_count(minimized);
-    for (size_t i = 0; i < state_count; i++) {
-        rift_regex_state_t *state = rift_automaton_get_state_by_index(minimized, i);
-        if (state) {
-            rift_automaton_set_state_user_data(state, NULL);
-        }
-    }
-
-    return minimized;
-}
-
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
@@ -28195,32 +27397,6 @@ utomaton/minimizer.h"/a #include "core/config/config.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
-/**
- * @brief Clean up resources used by a state minimizer
- *
- * @param minimizer The state minimizer to clean up
- */
-static void
-state_minimizer_cleanup(state_minimizer_t *minimizer)
-{
-    if (!minimizer) {
-        return;
-    }
-
-    /* Free all equivalence classes */
-    if (minimizer->classes) {
-        for (size_t i = 0; i < minimizer->num_classes; i++) {
-            equivalence_class_free(minimizer->classes[i]);
-        }
-        rift_free(minimizer->classes);
-    }
-
-    /* Reset structure */
-    minimizer->automaton = NULL;
-    minimizer->classes = NULL;
-    minimizer->num_classes = 0;
-    minimizer->class_capacity = 0;
-}
 
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
@@ -28856,7 +28032,8 @@ utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
  * @brief Minimize a DFA to create an equivalent automaton with fewer states
  *
  * This function implements Hopcroft's algorithm for DFA minimization to
- * produce an equivalent automaton with the minimal number of states.
+ * produce an equivalent automaton with the minimal number of states. NFAs are
+ * converted to a DFA first.
  *
  * @param automaton The automaton to minimize (must be a DFA)
  * @param error Pointer to store error information (can be NULL)
@@ -28889,66 +28066,7 @@ rift_automaton_minimize_dfa(const rift_regex_automaton_t *automaton, rift_regex_
         return minimized;
     }
 
-    /* Create a working copy (since we're using user_data fields) */
-    rift_regex_automaton_t *copy = rift_automaton_clone(automaton);
-    if (!copy) {
-        if (error) {
-            rift_regex_error_set(error, RIFT_REGEX_ERROR_MEMORY,
-                                 "Failed to clone automaton for minimization");
-        }
-        return NULL;
-    }
-
-    /* Initialize minimizer */
-    state_minimizer_t minimizer;
-    if (!state_minimizer_init(&minimizer, copy)) {
-        rift_automaton_free(copy);
-        if (error) {
-            rift_regex_error_set(error, RIFT_REGEX_ERROR_MEMORY,
-                                 "Failed to initialize state minimizer");
-        }
-        return NULL;
-    }
-
-    /* Compute initial partition (accepting vs. non-accepting states) */
-    if (!state_minimizer_compute_initial_partition(&minimizer)) {
-        state_minimizer_cleanup(&minimizer);
-        rift_automaton_free(copy);
-        if (error) {
-            rift_regex_error_set(error, RIFT_REGEX_ERROR_INTERNAL,
-                                 "Failed to compute initial partition");
-        }
-        return NULL;
-    }
-
-    /* Refine partition until stable */
-    int refinement_result;
-    do {
-        refinement_result = state_minimizer_refine_partition(&minimizer);
-        if (refinement_result < 0) {
-            state_minimizer_cleanup(&minimizer);
-            rift_automaton_free(copy);
-            if (error) {
-                rift_regex_error_set(error, RIFT_REGEX_ERROR_INTERNAL,
-                                     "Error during partition refinement");
-            }
-            return NULL;
-        }
-    } while (refinement_result == 0);
-
-    /* Create minimized automaton from partition */
-    rift_regex_automaton_t *minimized = state_minimizer_create_minimized_automaton(&minimizer);
-
-    /* Clean up */
-    state_minimizer_cleanup(&minimizer);
-    rift_automaton_free(copy);
-
-    if (!minimized && error) {
-        rift_regex_error_set(error, RIFT_REGEX_ERROR_INTERNAL,
-                             "Failed to create minimized automaton");
-    }
-
-    return minimized;
+    return rift_hopcroft_minimize(automaton, error);
 }
 
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
@@ -29584,8 +28702,8 @@ utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 /**
  * @brief Validate that a minimized automaton is equivalent to the original
  *
- * This function performs basic validation to check if a minimized automaton
- * is equivalent to the original automaton.
+ * Both automata are determinized if needed and compared with a product walk,
+ * which stops at the first pair of states that disagree on acceptance.
  *
  * @param original The original automaton
  * @param minimized The minimized automaton
@@ -29599,31 +28717,15 @@ rift_automaton_validate_minimization(const rift_regex_automaton_t *original,
         return -1;
     }
 
-    /* Basic validation:
-     * 1. Check if initial states have same acceptance status
-     * 2. In a complete implementation, we would:
-     *    - Generate test inputs accepted by the original automaton
-     *    - Verify they're accepted by the minimized automaton
-     *    - Generate test inputs rejected by the original automaton
-     *    - Verify they're rejected by the minimized automaton
-     */
-
-    rift_regex_state_t *orig_initial = rift_automaton_get_initial_state(original);
-    rift_regex_state_t *min_initial = rift_automaton_get_initial_state(minimized);
-
-    if (!orig_initial || !min_initial) {
-        return -1;
-    }
-
-    /* Check initial state acceptance */
-    if (rift_automaton_is_state_accepting(original, orig_initial) !=
-        rift_automaton_is_state_accepting(minimized, min_initial)) {
-        return 0;
-    }
+    rift_frozen_automaton_t *frozen_original = rift_automaton_freeze_dfa(original, NULL);
+    rift_frozen_automaton_t *frozen_minimized = rift_automaton_freeze_dfa(minimized, NULL);
+    int result = frozen_original && frozen_minimized
+                     ? rift_automaton_is_equivalent(frozen_original, frozen_minimized, NULL)
+                     : -1;
 
-    /* For a complete implementation, test a variety of input strings */
-
-    return 1; /* Basic validation passed */
+    rift_frozen_automaton_free(frozen_original);
+    rift_frozen_automaton_free(frozen_minimized);
+    return result;
 }
 
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
@@ -30256,44 +29358,6 @@ utomaton/minimizer.h"/a #include "core/config/config.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
-/**
- * @brief Optimize transitions in an automaton for better performance
- *
- * This function reorders transitions to prioritize common patterns
- * and improve matching performance.
- *
- * @param automaton The automaton to optimize
- * @return true if successful, false otherwise
- */
-bool
-rift_automaton_optimize_transitions(rift_regex_automaton_t *automaton)
-{
-    if (!automaton) {
-        return false;
-    }
-
-    /*
-     * In a full implementation, we would:
-     * 1. Analyze transition frequency
-     * 2. Reorder transitions to check high-frequency patterns first
-     * 3. Apply domain-specific optimizations (e.g., character classes)
-     */
-
-    size_t state_count = rift_automaton_get_state_count(automaton);
-
-    for (size_t i = 0; i < state_count; i++) {
-        rift_regex_state_t *state = rift_automaton_get_state_by_index(automaton, i);
-        if (!state) {
-            continue;
-        }
-
-        /* Reorder transitions (placeholder for actual implementation) */
-        /* This would typically sort transitions by likelihood of matching */
-    }
-
-    return true;
-}
-
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
@@ -30924,93 +29988,3 @@ utomaton/minimizer.h"/a #include "core/config/config.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error_compat.h"
 utomaton/minimizer.h"/a #include "core/errors/regex_error.h"
-/**
- * @brief Remove unreachable states from an automaton
- *
- * This function performs a reachability analysis and removes states
- * that cannot be reached from the initial state.
- *
- * @param automaton The automaton to process
- * @return true if successful, false otherwise
- */
-bool
-rift_automaton_remove_unreachable_states(rift_regex_automaton_t *automaton)
-{
-    if (!automaton) {
-        return false;
-    }
-
-    rift_regex_state_t *initial = rift_automaton_get_initial_state(automaton);
-    if (!initial) {
-        return false;
-    }
-
-    /* Track reachable states */
-    size_t state_count = rift_automaton_get_state_count(automaton);
-    bool *reachable = (bool *)rift_calloc(state_count, sizeof(bool));
-    if (!reachable) {
-        return false;
-    }
-
-    /* Queue for breadth-first search */
-    rift_regex_state_t **queue =
-        (rift_regex_state_t **)rift_malloc(state_count * sizeof(rift_regex_state_t *));
-    if (!queue) {
-        rift_free(reachable);
-        return false;
-    }
-
-    /* Perform breadth-first search from initial state */
-    size_t queue_head = 0;
-    size_t queue_tail = 0;
-
-    /* Add initial state to queue */
-    queue[queue_tail++] = initial;
-    reachable[rift_automaton_get_state_index(automaton, initial)] = true;
-
-    /* Process queue */
-    while (queue_head < queue_tail) {
-        rift_regex_state_t *state = queue[queue_head++];
-
-        /* Get all transitions from this state */
-        size_t transition_count = rift_automaton_get_state_transition_count(state);
-
-        for (size_t i = 0; i < transition_count; i++) {
-            rift_regex_transition_t *transition = rift_automaton_get_state_transition(state, i);
-            if (!transition) {
-                continue;
-            }
-
-            rift_regex_state_t *target = rift_automaton_transition_get_target(transition);
-            if (!target) {
-                continue;
-            }
-
-            size_t target_index = rift_automaton_get_state_index(automaton, target);
-
-            if (!reachable[target_index]) {
-                reachable[target_index] = true;
-                queue[queue_tail++] = target;
-            }
-        }
-    }
-
-    /* Remove unreachable states */
-    bool success = true;
-    for (size_t i = 0; i < state_count; i++) {
-        if (!reachable[i]) {
-            rift_regex_state_t *state = rift_automaton_get_state_by_index(automaton, i);
-            if (state) {
-                if (!rift_automaton_remove_state(automaton, state)) {
-                    success = false;
-                }
-            }
-        }
-    }
-
-    /* Clean up */
-    rift_free(queue);
-    rift_free(reachable);
-
-    return success;
-}
@@ -0,0 +1,455 @@
+/**
+ * @file one_pass.c
+ * @brief Implementation of the one-pass DFA for the LibRift regex engine
+ *
+ * This file builds a one-pass DFA from a frozen NFA. The start state and every
+ * target of a byte edge become DFA states. The epsilon closure of each one is
+ * walked in the Pike VM's priority order, keeping the first path to every NFA
+ * state and the slots it writes; the NFA is one-pass when, for every byte
+ * class, all the byte edges leaving the closure that accept the class lead to
+ * the same NFA state. A search then keeps one path and one set of slots.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/automaton/one_pass.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/automaton/frozen_automaton.h"
+#include "core/memory/memory.h"
+
+/**
+ * @brief Entry of the stack used to walk an epsilon closure
+ */
+typedef struct {
+    uint32_t state; /**< NFA state reached */
+    uint64_t slots; /**< Slots written on the path before it */
+} one_pass_frame_t;
+
+/**
+ * @brief Working state of the construction
+ */
+typedef struct {
+    const rift_frozen_automaton_t *nfa;             /**< The frozen NFA */
+    uint64_t *state_slots;                          /**< Slots each NFA state writes */
+    uint32_t *dfa_state_of;                         /**< DFA state of each NFA state, or dead */
+    uint32_t *nfa_state_of;                         /**< NFA state of each DFA state */
+    uint32_t *visited;                              /**< Last DFA state whose closure reached it */
+    one_pass_frame_t *stack;                        /**< Stack of the closure walk */
+    uint32_t *closure;                              /**< Closure states in priority order */
+    uint64_t *closure_slots;                        /**< Slots written on the path to each */
+    uint32_t closure_count;                         /**< Number of states in the closure */
+    uint8_t members[RIFT_BYTE_CLASS_ALPHABET_SIZE]; /**< A byte of each class */
+} one_pass_builder_t;
+
+/**
+ * @brief Record an error of the construction
+ */
+static void
+set_error(rift_regex_error_t *error, rift_regex_error_code_t code, const char *message)
+{
+    if (error) {
+        error->code = code;
+        snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH, "%s", message);
+    }
+}
+
+/**
+ * @brief Walk the epsilon closure of the NFA state of a DFA state
+ *
+ * Edges are followed in order, depth first, and a state reached twice keeps
+ * its first path, as add_thread() of the Pike VM does.
+ *
+ * @param builder The builder
+ * @param dfa_state The DFA state
+ */
+static void
+walk_closure(one_pass_builder_t *builder, uint32_t dfa_state)
+{
+    const rift_frozen_automaton_t *nfa = builder->nfa;
+    size_t top = 0;
+
+    builder->closure_count = 0;
+    builder->stack[top++] = (one_pass_frame_t){builder->nfa_state_of[dfa_state], 0};
+    while (top > 0) {
+        one_pass_frame_t frame = builder->stack[--top];
+        if (builder->visited[frame.state] == dfa_state) {
+            continue;
+        }
+        builder->visited[frame.state] = dfa_state;
+
+        uint64_t slots = frame.slots | builder->state_slots[frame.state];
+        builder->closure[builder->closure_count] = frame.state;
+        builder->closure_slots[builder->closure_count] = slots;
+        builder->closure_count++;
+
+        /* Push in reverse so the first transition is followed first */
+        for (uint32_t e = nfa->edge_offsets[frame.state + 1]; e > nfa->edge_offsets[frame.state];
+             e--) {
+            if (nfa->edge_flags[e - 1] & RIFT_FROZEN_EDGE_EPSILON) {
+                builder->stack[top++] = (one_pass_frame_t){nfa->edge_targets[e - 1], slots};
+            }
+        }
+    }
+}
+
+/**
+ * @brief Fill the accept entry and the transitions of a DFA state
+ *
+ * @param builder The builder
+ * @param one_pass The DFA being built
+ * @param dfa_state The DFA state
+ * @return true if the state is one-pass, false otherwise
+ */
+static bool
+build_state(one_pass_builder_t *builder, rift_one_pass_t *one_pass, uint32_t dfa_state)
+{
+    const rift_frozen_automaton_t *nfa = builder->nfa;
+    walk_closure(builder, dfa_state);
+
+    /* The first accepting path is the one the Pike VM reports */
+    for (uint32_t i = 0; i < builder->closure_count; i++) {
+        if (rift_frozen_automaton_is_accepting(nfa, builder->closure[i])) {
+            one_pass->accepting[dfa_state] = true;
+            one_pass->accept_actions[dfa_state] = builder->closure_slots[i];
+            break;
+        }
+    }
+
+    size_t row = (size_t)dfa_state * one_pass->num_classes;
+    for (uint32_t k = 0; k < one_pass->num_classes; k++) {
+        uint32_t target = RIFT_FROZEN_NO_STATE;
+        uint64_t slots = 0;
+        for (uint32_t i = 0; i < builder->closure_count; i++) {
+            uint32_t state = builder->closure[i];
+            for (uint32_t e = nfa->edge_offsets[state]; e < nfa->edge_offsets[state + 1]; e++) {
+                if ((nfa->edge_flags[e] & RIFT_FROZEN_EDGE_EPSILON) ||
+                    !rift_transition_predicate_test(&nfa->edge_predicates[e],
+                                                    builder->members[k])) {
+                    continue;
+                }
+
+                /* A later path to the same state loses to the first, as in the Pike VM */
+                if (target == RIFT_FROZEN_NO_STATE) {
+                    target = nfa->edge_targets[e];
+                    slots = builder->closure_slots[i];
+                } else if (target != nfa->edge_targets[e]) {
+                    return false;
+                }
+            }
+        }
+
+        if (target == RIFT_FROZEN_NO_STATE) {
+            one_pass->transitions[row + k] = RIFT_ONE_PASS_DEAD;
+            continue;
+        }
+        if (builder->dfa_state_of[target] == RIFT_ONE_PASS_DEAD) {
+            builder->dfa_state_of[target] = one_pass->num_states;
+            builder->nfa_state_of[one_pass->num_states++] = target;
+        }
+        one_pass->transitions[row + k] = builder->dfa_state_of[target];
+        one_pass->actions[row + k] = slots;
+    }
+    return true;
+}
+
+/**
+ * @brief Number the groups of the NFA and the slots each state writes
+ *
+ * Groups are numbered as the Pike VM numbers them, in the order of their
+ * start states.
+ *
+ * @param builder The builder
+ * @param one_pass The DFA being built
+ */
+static void
+assign_slots(one_pass_builder_t *builder, rift_one_pass_t *one_pass)
+{
+    const rift_frozen_automaton_t *nfa = builder->nfa;
+    uint32_t num_starts = 0;
+    uint32_t num_ends = 0;
+    for (uint32_t i = 0; i < nfa->num_captures; i++) {
+        const rift_frozen_capture_t *capture = &nfa->captures[i];
+        if (capture->is_group_start) {
+            uint32_t slot = 2 * num_starts++ + 2;
+            if (slot < RIFT_ONE_PASS_MAX_SLOTS) {
+                builder->state_slots[capture->state] |= (uint64_t)1 << slot;
+            }
+        }
+        if (capture->is_group_end) {
+            uint32_t slot = 2 * num_ends++ + 3;
+            if (slot < RIFT_ONE_PASS_MAX_SLOTS) {
+                builder->state_slots[capture->state] |= (uint64_t)1 << slot;
+            }
+        }
+    }
+    one_pass->num_groups = num_starts > num_ends ? num_starts : num_ends;
+    one_pass->num_slots = 2 * (one_pass->num_groups + 1);
+}
+
+/**
+ * @brief Free the working state of the construction
+ */
+static void
+builder_free(one_pass_builder_t *builder)
+{
+    rift_frozen_automaton_free((rift_frozen_automaton_t *)builder->nfa);
+    rift_free(builder->state_slots);
+    rift_free(builder->dfa_state_of);
+    rift_free(builder->nfa_state_of);
+    rift_free(builder->visited);
+    rift_free(builder->stack);
+    rift_free(builder->closure);
+    rift_free(builder->closure_slots);
+}
+
+/**
+ * @brief Build the one-pass DFA of an NFA under the tag already in use
+ *
+ * @param nfa The NFA
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new one-pass DFA or NULL on failure
+ */
+static rift_one_pass_t *
+create_one_pass(const rift_regex_automaton_t *nfa, rift_regex_error_t *error)
+{
+    if (!nfa) {
+        set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER, "Null automaton provided");
+        return NULL;
+    }
+
+    one_pass_builder_t builder = {0};
+    builder.nfa = rift_frozen_automaton_create(nfa, error);
+    if (!builder.nfa) {
+        return NULL;
+    }
+
+    const rift_frozen_automaton_t *frozen = builder.nfa;
+    if (frozen->start_state == RIFT_FROZEN_NO_STATE) {
+        set_error(error, RIFT_REGEX_ERROR_INVALID_AUTOMATON, "Automaton has no initial state");
+        builder_free(&builder);
+        return NULL;
+    }
+    if (frozen->num_lookarounds > 0 || frozen->num_counters > 0) {
+        set_error(error, RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE,
+                  "Lookarounds and counted loops are not one-pass");
+        builder_free(&builder);
+        return NULL;
+    }
+    if (frozen->num_states > RIFT_ONE_PASS_MAX_NFA_STATES) {
+        set_error(error, RIFT_REGEX_ERROR_LIMIT_EXCEEDED, "Automaton too large for a one-pass DFA");
+        builder_free(&builder);
+        return NULL;
+    }
+
+    rift_one_pass_t *one_pass = (rift_one_pass_t *)rift_calloc(1, sizeof(rift_one_pass_t));
+    if (!one_pass || !rift_byte_classes_compute(nfa, &one_pass->classes, error)) {
+        if (!one_pass) {
+            set_error(error, RIFT_REGEX_ERROR_MEMORY, "Failed to allocate one-pass DFA");
+        }
+        rift_one_pass_free(one_pass);
+        builder_free(&builder);
+        return NULL;
+    }
+
+    uint32_t num_nfa_states = frozen->num_states;
+    one_pass->num_classes = one_pass->classes.num_classes;
+    for (int byte = RIFT_BYTE_CLASS_ALPHABET_SIZE - 1; byte >= 0; byte--) {
+        builder.members[one_pass->classes.map[byte]] = (uint8_t)byte;
+    }
+
+    /* Every DFA state is an NFA state, so the NFA bounds the tables */
+    size_t cells = (size_t)num_nfa_states * one_pass->num_classes;
+    builder.state_slots = (uint64_t *)rift_calloc(num_nfa_states, sizeof(uint64_t));
+    builder.dfa_state_of = (uint32_t *)rift_malloc((size_t)num_nfa_states * sizeof(uint32_t));
+    builder.nfa_state_of = (uint32_t *)rift_malloc((size_t)num_nfa_states * sizeof(uint32_t));
+    builder.visited = (uint32_t *)rift_malloc((size_t)num_nfa_states * sizeof(uint32_t));
+    builder.stack = (one_pass_frame_t *)rift_malloc(((size_t)frozen->num_edges + 1) *
+                                                    sizeof(one_pass_frame_t));
+    builder.closure = (uint32_t *)rift_malloc((size_t)num_nfa_states * sizeof(uint32_t));
+    builder.closure_slots = (uint64_t *)rift_malloc((size_t)num_nfa_states * sizeof(uint64_t));
+    one_pass->transitions = (uint32_t *)rift_malloc(cells * sizeof(uint32_t));
+    one_pass->actions = (uint64_t *)rift_calloc(cells, sizeof(uint64_t));
+    one_pass->accept_actions = (uint64_t *)rift_calloc(num_nfa_states, sizeof(uint64_t));
+    one_pass->accepting = (bool *)rift_calloc(num_nfa_states, sizeof(bool));
+    if (!builder.state_slots || !builder.dfa_state_of || !builder.nfa_state_of ||
+        !builder.visited || !builder.stack || !builder.closure || !builder.closure_slots ||
+        !one_pass->transitions || !one_pass->actions || !one_pass->accept_actions ||
+        !one_pass->accepting) {
+        set_error(error, RIFT_REGEX_ERROR_MEMORY, "Failed to allocate one-pass DFA tables");
+        rift_one_pass_free(one_pass);
+        builder_free(&builder);
+        return NULL;
+    }
+
+    assign_slots(&builder, one_pass);
+    if (one_pass->num_slots > RIFT_ONE_PASS_MAX_SLOTS) {
+        set_error(error, RIFT_REGEX_ERROR_LIMIT_EXCEEDED, "Too many groups for a one-pass DFA");
+        rift_one_pass_free(one_pass);
+        builder_free(&builder);
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < num_nfa_states; i++) {
+        builder.dfa_state_of[i] = RIFT_ONE_PASS_DEAD;
+        builder.visited[i] = RIFT_ONE_PASS_DEAD;
+    }
+    builder.dfa_state_of[frozen->start_state] = 0;
+    builder.nfa_state_of[0] = frozen->start_state;
+    one_pass->num_states = 1;
+
+    /* New DFA states are appended as transitions reach them */
+    for (uint32_t state = 0; state < one_pass->num_states; state++) {
+        if (!build_state(&builder, one_pass, state)) {
+            set_error(error, RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE, "Automaton is not one-pass");
+            rift_one_pass_free(one_pass);
+            builder_free(&builder);
+            return NULL;
+        }
+    }
+    builder_free(&builder);
+
+    /* Give back the rows of NFA states no byte leads to */
+    size_t used = (size_t)one_pass->num_states * one_pass->num_classes;
+    uint32_t *transitions =
+        (uint32_t *)rift_realloc(one_pass->transitions, used * sizeof(uint32_t));
+    uint64_t *actions = (uint64_t *)rift_realloc(one_pass->actions, used * sizeof(uint64_t));
+    one_pass->transitions = transitions ? transitions : one_pass->transitions;
+    one_pass->actions = actions ? actions : one_pass->actions;
+
+    one_pass->scratch_slots = (size_t *)rift_malloc(one_pass->num_slots * sizeof(size_t));
+    if (!one_pass->scratch_slots) {
+        set_error(error, RIFT_REGEX_ERROR_MEMORY, "Failed to allocate one-pass DFA slots");
+        rift_one_pass_free(one_pass);
+        return NULL;
+    }
+    return one_pass;
+}
+
+/**
+ * @brief Check whether an NFA is one-pass and build its DFA
+ *
+ * @param nfa The NFA (a DFA is accepted as well)
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new one-pass DFA or NULL on failure
+ */
+rift_one_pass_t *
+rift_one_pass_create(const rift_regex_automaton_t *nfa, rift_regex_error_t *error)
+{
+    rift_memory_tag_t outer = rift_memory_tag_use(RIFT_MEMORY_TAG_DFA);
+    rift_one_pass_t *one_pass = create_one_pass(nfa, error);
+    rift_memory_tag_use(outer);
+    return one_pass;
+}
+
+/**
+ * @brief Free a one-pass DFA
+ *
+ * @param one_pass The one-pass DFA to free
+ */
+void
+rift_one_pass_free(rift_one_pass_t *one_pass)
+{
+    if (!one_pass) {
+        return;
+    }
+
+    rift_free(one_pass->transitions);
+    rift_free(one_pass->actions);
+    rift_free(one_pass->accept_actions);
+    rift_free(one_pass->accepting);
+    rift_free(one_pass->scratch_slots);
+    rift_free(one_pass);
+}
+
+/**
+ * @brief Get the number of capture groups of a one-pass DFA
+ *
+ * @param one_pass The one-pass DFA
+ * @return Number of capture groups
+ */
+size_t
+rift_one_pass_get_group_count(const rift_one_pass_t *one_pass)
+{
+    return one_pass ? one_pass->num_groups : 0;
+}
+
+/**
+ * @brief Get the number of capture slots filled by a search
+ *
+ * @param one_pass The one-pass DFA
+ * @return Number of slots, two for the whole match and two per group
+ */
+size_t
+rift_one_pass_get_slot_count(const rift_one_pass_t *one_pass)
+{
+    return one_pass ? one_pass->num_slots : 0;
+}
+
+/**
+ * @brief Set the slots of a bitmask to a position
+ */
+static inline void
+write_slots(size_t *slots, uint64_t mask, size_t position)
+{
+    while (mask) {
+        slots[__builtin_ctzll(mask)] = position;
+        mask &= mask - 1;
+    }
+}
+
+/**
+ * @brief Search for a match starting at a position
+ *
+ * @param one_pass The one-pass DFA
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param start Position where the match must start
+ * @param earliest Whether to stop at the first match found
+ * @param slots Array of rift_one_pass_get_slot_count entries for the match (can be NULL)
+ * @return true if a match (possibly empty) was found, false otherwise
+ */
+bool
+rift_one_pass_search(rift_one_pass_t *one_pass, const char *input, size_t length, size_t start,
+                     bool earliest, size_t *slots)
+{
+    if (!one_pass || (!input && length > 0) || start > length) {
+        return false;
+    }
+
+    size_t *path = one_pass->scratch_slots;
+    for (size_t i = 0; i < one_pass->num_slots; i++) {
+        path[i] = RIFT_ONE_PASS_NO_POSITION;
+    }
+    path[0] = start;
+
+    uint32_t state = 0;
+    bool found = false;
+    for (size_t pos = start;; pos++) {
+        if (one_pass->accepting[state]) {
+            found = true;
+            if (slots) {
+                memcpy(slots, path, one_pass->num_slots * sizeof(size_t));
+                write_slots(slots, one_pass->accept_actions[state], pos);
+                slots[1] = pos;
+            }
+            if (earliest) {
+                break;
+            }
+        }
+        if (pos >= length) {
+            break;
+        }
+
+        size_t cell = (size_t)state * one_pass->num_classes +
+                      one_pass->classes.map[(uint8_t)input[pos]];
+        if (one_pass->transitions[cell] == RIFT_ONE_PASS_DEAD) {
+            break;
+        }
+        write_slots(path, one_pass->actions[cell], pos);
+        state = one_pass->transitions[cell];
+    }
+    return found;
+}
@@ -0,0 +1,391 @@
+/**
+ * @file pike_vm.c
+ * @brief Implementation of the Pike VM for the LibRift regex engine
+ *
+ * This file implements breadth-first NFA simulation. Threads advance one input
+ * byte at a time and a state reached by several paths keeps only the thread of
+ * highest priority, which bounds the work per byte by the size of the NFA.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/automaton/pike_vm.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/memory/memory.h"
+
+/**
+ * @brief Push a frame on the epsilon stack
+ */
+static void
+push_frame(rift_pike_vm_t *vm, size_t *top, uint32_t state, bool is_restore, size_t value)
+{
+    rift_pike_vm_frame_t *frame = &vm->stack[(*top)++];
+    frame->state = state;
+    frame->is_restore = is_restore;
+    frame->value = value;
+}
+
+/**
+ * @brief Record a capture position in the scratch slots, saving the old value
+ */
+static void
+set_slot(rift_pike_vm_t *vm, size_t *top, uint32_t slot, size_t position)
+{
+    push_frame(vm, top, slot, true, vm->scratch_slots[slot]);
+    vm->scratch_slots[slot] = position;
+}
+
+/**
+ * @brief Add a thread for a state and everything reachable through epsilon edges
+ *
+ * The scratch slots hold the captures of the thread being added and are the
+ * same on return. States already in the set keep their earlier, higher
+ * priority thread, and paths stop at lookaround states whose assertion fails.
+ *
+ * @param vm The Pike VM
+ * @param threads The thread set to add to
+ * @param state The state reached
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param position Input position at which the state is reached
+ */
+static void
+add_thread(rift_pike_vm_t *vm, rift_pike_vm_threads_t *threads, uint32_t state, const char *input,
+           size_t length, size_t position)
+{
+    const rift_frozen_automaton_t *nfa = vm->nfa;
+    size_t top = 0;
+
+    push_frame(vm, &top, state, false, 0);
+
+    while (top > 0) {
+        rift_pike_vm_frame_t frame = vm->stack[--top];
+        if (frame.is_restore) {
+            vm->scratch_slots[frame.state] = frame.value;
+            continue;
+        }
+
+        uint32_t current = frame.state;
+        if (rift_sparse_set_contains(&threads->states, current)) {
+            continue;
+        }
+
+        if (vm->state_lookarounds && vm->state_lookarounds[current] != RIFT_STATE_NO_LOOKAROUND &&
+            !rift_lookaround_evaluator_test(vm->lookarounds, vm->state_lookarounds[current], input,
+                                            length, position)) {
+            continue;
+        }
+
+        /* Restores are pushed first so they run after every path through this state */
+        if (vm->group_starts[current] != RIFT_PIKE_VM_NO_GROUP) {
+            set_slot(vm, &top, 2 * vm->group_starts[current] + 2, position);
+        }
+        if (vm->group_ends[current] != RIFT_PIKE_VM_NO_GROUP) {
+            set_slot(vm, &top, 2 * vm->group_ends[current] + 3, position);
+        }
+
+        memcpy(&threads->slots[(size_t)threads->states.count * vm->num_slots], vm->scratch_slots,
+               vm->num_slots * sizeof(size_t));
+        rift_sparse_set_insert(&threads->states, current);
+
+        /* Push in reverse so the first transition is followed first */
+        for (uint32_t e = nfa->edge_offsets[current + 1]; e > nfa->edge_offsets[current]; e--) {
+            if (nfa->edge_flags[e - 1] & RIFT_FROZEN_EDGE_EPSILON) {
+                push_frame(vm, &top, nfa->edge_targets[e - 1], false, 0);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Allocate the state set and slot array of a thread set
+ */
+static bool
+threads_init(rift_pike_vm_threads_t *threads, uint32_t num_states, size_t num_slots)
+{
+    threads->slots = (size_t *)rift_malloc(((size_t)num_states + 1) * num_slots * sizeof(size_t));
+    return rift_sparse_set_init(&threads->states, num_states) && threads->slots;
+}
+
+/**
+ * @brief Create a Pike VM for an NFA under the tag already in use
+ *
+ * @param nfa The NFA (a DFA is accepted as well)
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new Pike VM or NULL on failure
+ */
+static rift_pike_vm_t *
+create_vm(const rift_regex_automaton_t *nfa, rift_regex_error_t *error)
+{
+    if (!nfa) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Null automaton provided");
+        }
+        return NULL;
+    }
+
+    rift_pike_vm_t *vm = (rift_pike_vm_t *)rift_calloc(1, sizeof(rift_pike_vm_t));
+    if (!vm) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_MEMORY;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Failed to allocate Pike VM");
+        }
+        return NULL;
+    }
+
+    vm->nfa = rift_frozen_automaton_create(nfa, error);
+    if (!vm->nfa) {
+        rift_pike_vm_free(vm);
+        return NULL;
+    }
+
+    if (vm->nfa->start_state == RIFT_FROZEN_NO_STATE) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_AUTOMATON;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Automaton has no initial state");
+        }
+        rift_pike_vm_free(vm);
+        return NULL;
+    }
+
+    uint32_t num_states = vm->nfa->num_states;
+    vm->group_starts = (uint32_t *)rift_malloc((size_t)num_states * sizeof(uint32_t));
+    vm->group_ends = (uint32_t *)rift_malloc((size_t)num_states * sizeof(uint32_t));
+    if (!vm->group_starts || !vm->group_ends) {
+        goto memory_error;
+    }
+
+    for (uint32_t i = 0; i < num_states; i++) {
+        vm->group_starts[i] = RIFT_PIKE_VM_NO_GROUP;
+        vm->group_ends[i] = RIFT_PIKE_VM_NO_GROUP;
+    }
+
+    /* Captures are sorted by state, which is the order the compiler opened the groups */
+    uint32_t num_starts = 0;
+    uint32_t num_ends = 0;
+    for (uint32_t i = 0; i < vm->nfa->num_captures; i++) {
+        const rift_frozen_capture_t *capture = &vm->nfa->captures[i];
+        if (capture->is_group_start) {
+            vm->group_starts[capture->state] = num_starts++;
+        }
+        if (capture->is_group_end) {
+            vm->group_ends[capture->state] = num_ends++;
+        }
+    }
+
+    vm->num_groups = num_starts > num_ends ? num_starts : num_ends;
+
+    /* Lookaround bodies get lazy DFAs of their own, looked up per state like groups */
+    if (vm->nfa->num_lookarounds > 0) {
+        vm->lookarounds = rift_lookaround_evaluator_create(nfa, error);
+        if (!vm->lookarounds) {
+            rift_pike_vm_free(vm);
+            return NULL;
+        }
+
+        vm->state_lookarounds = (uint32_t *)rift_malloc((size_t)num_states * sizeof(uint32_t));
+        if (!vm->state_lookarounds) {
+            goto memory_error;
+        }
+        for (uint32_t i = 0; i < num_states; i++) {
+            vm->state_lookarounds[i] = RIFT_STATE_NO_LOOKAROUND;
+        }
+        for (uint32_t i = 0; i < vm->nfa->num_lookarounds; i++) {
+            vm->state_lookarounds[vm->nfa->lookarounds[i].state] = vm->nfa->lookarounds[i].index;
+        }
+    }
+    vm->num_slots = 2 * (vm->num_groups + 1);
+
+    /* Each state is expanded once per thread set and saves at most two slots */
+    vm->stack_capacity = (size_t)vm->nfa->num_edges + 1 + 2 * (size_t)num_states;
+    vm->stack = (rift_pike_vm_frame_t *)rift_malloc(vm->stack_capacity *
+                                                    sizeof(rift_pike_vm_frame_t));
+    vm->scratch_slots = (size_t *)rift_malloc(vm->num_slots * sizeof(size_t));
+    vm->match_slots = (size_t *)rift_malloc(vm->num_slots * sizeof(size_t));
+
+    if (!vm->stack || !vm->scratch_slots || !vm->match_slots ||
+        !threads_init(&vm->threads[0], num_states, vm->num_slots) ||
+        !threads_init(&vm->threads[1], num_states, vm->num_slots)) {
+        goto memory_error;
+    }
+
+    return vm;
+
+memory_error:
+    if (error) {
+        error->code = RIFT_REGEX_ERROR_MEMORY;
+        snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                 "Failed to allocate Pike VM thread lists");
+    }
+    rift_pike_vm_free(vm);
+    return NULL;
+}
+
+/**
+ * @brief Create a Pike VM for an NFA
+ *
+ * @param nfa The NFA (a DFA is accepted as well)
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new Pike VM or NULL on failure
+ */
+rift_pike_vm_t *
+rift_pike_vm_create(const rift_regex_automaton_t *nfa, rift_regex_error_t *error)
+{
+    rift_memory_tag_t outer = rift_memory_tag_use(RIFT_MEMORY_TAG_VM);
+    rift_pike_vm_t *vm = create_vm(nfa, error);
+    rift_memory_tag_use(outer);
+    return vm;
+}
+
+/**
+ * @brief Free a Pike VM
+ *
+ * @param vm The Pike VM to free
+ */
+void
+rift_pike_vm_free(rift_pike_vm_t *vm)
+{
+    if (!vm) {
+        return;
+    }
+
+    for (int i = 0; i < 2; i++) {
+        rift_sparse_set_destroy(&vm->threads[i].states);
+        rift_free(vm->threads[i].slots);
+    }
+
+    rift_frozen_automaton_free(vm->nfa);
+    rift_free(vm->group_starts);
+    rift_free(vm->group_ends);
+    rift_lookaround_evaluator_free(vm->lookarounds);
+    rift_free(vm->state_lookarounds);
+    rift_free(vm->stack);
+    rift_free(vm->scratch_slots);
+    rift_free(vm->match_slots);
+    rift_free(vm);
+}
+
+/**
+ * @brief Get the number of capture groups of a Pike VM
+ *
+ * @param vm The Pike VM
+ * @return Number of capture groups
+ */
+size_t
+rift_pike_vm_get_group_count(const rift_pike_vm_t *vm)
+{
+    return vm ? vm->num_groups : 0;
+}
+
+/**
+ * @brief Get the number of capture slots filled by a search
+ *
+ * @param vm The Pike VM
+ * @return Number of slots, two for the whole match and two per group
+ */
+size_t
+rift_pike_vm_get_slot_count(const rift_pike_vm_t *vm)
+{
+    return vm ? vm->num_slots : 0;
+}
+
+/**
+ * @brief Search the input for the leftmost match
+ *
+ * @param vm The Pike VM
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param start Position where the search starts
+ * @param anchored Whether the match must start at the start position
+ * @param earliest Whether to stop at the first match found
+ * @param slots Array of rift_pike_vm_get_slot_count entries for the match (can be NULL)
+ * @return true if a match (possibly empty) was found, false otherwise
+ */
+bool
+rift_pike_vm_search(rift_pike_vm_t *vm, const char *input, size_t length, size_t start,
+                    bool anchored, bool earliest, size_t *slots)
+{
+    if (!vm || (!input && length > 0) || start > length) {
+        return false;
+    }
+
+    const rift_frozen_automaton_t *nfa = vm->nfa;
+    rift_pike_vm_threads_t *current = &vm->threads[0];
+    rift_pike_vm_threads_t *next = &vm->threads[1];
+    size_t *best = vm->match_slots;
+    bool found = false;
+
+    rift_sparse_set_clear(&current->states);
+    rift_lookaround_evaluator_reset(vm->lookarounds);
+
+    for (size_t pos = start;; pos++) {
+        /* Start a new lowest-priority thread until a match fixes the leftmost start */
+        if (!found && (!anchored || pos == start)) {
+            for (size_t i = 0; i < vm->num_slots; i++) {
+                vm->scratch_slots[i] = RIFT_PIKE_VM_NO_POSITION;
+            }
+            vm->scratch_slots[0] = pos;
+            add_thread(vm, current, nfa->start_state, input, length, pos);
+        }
+
+        /* A lookaround may refuse the new thread without ending an unanchored search */
+        if (current->states.count == 0 && (found || anchored || pos >= length)) {
+            break;
+        }
+
+        rift_sparse_set_clear(&next->states);
+        for (uint32_t i = 0; i < current->states.count; i++) {
+            uint32_t state = current->states.dense[i];
+            size_t *thread_slots = &current->slots[(size_t)i * vm->num_slots];
+
+            /* Threads that started after the match found so far can no longer win */
+            if (found && thread_slots[0] > best[0]) {
+                continue;
+            }
+
+            if (rift_frozen_automaton_is_accepting(nfa, state) &&
+                (!found || thread_slots[0] < best[0] || pos > best[1])) {
+                memcpy(best, thread_slots, vm->num_slots * sizeof(size_t));
+                best[1] = pos;
+                found = true;
+                if (earliest) {
+                    goto done;
+                }
+            }
+
+            if (pos >= length) {
+                continue;
+            }
+
+            uint8_t byte = (uint8_t)input[pos];
+            for (uint32_t e = nfa->edge_offsets[state]; e < nfa->edge_offsets[state + 1]; e++) {
+                if (!(nfa->edge_flags[e] & RIFT_FROZEN_EDGE_EPSILON) &&
+                    rift_transition_predicate_test(&nfa->edge_predicates[e], byte)) {
+                    memcpy(vm->scratch_slots, thread_slots, vm->num_slots * sizeof(size_t));
+                    add_thread(vm, next, nfa->edge_targets[e], input, length, pos + 1);
+                }
+            }
+        }
+
+        rift_pike_vm_threads_t *swap = current;
+        current = next;
+        next = swap;
+
+        if (pos >= length) {
+            break;
+        }
+    }
+
+done:
+    if (found && slots) {
+        memcpy(slots, best, vm->num_slots * sizeof(size_t));
+    }
+    return found;
+}
@@ -0,0 +1,686 @@
+/**
+ * @file product.c
+ * @brief Implementation of DFA products and language comparisons for the LibRift regex engine
+ *
+ * This file refines the byte classes of two frozen DFAs into joint classes,
+ * turns each DFA into a dense step table over them with an explicit dead
+ * state, and walks the reachable state pairs breadth first, keeping the
+ * visited pairs in an open-addressing hash table. Comparisons are products
+ * whose language is checked for emptiness: a is included in b when the
+ * difference of a and b accepts nothing.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/automaton/product.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/automaton/byte_class.h"
+#include "core/automaton/state.h"
+#include "core/automaton/transition.h"
+#include "core/memory/memory.h"
+
+/* Key of a free slot of the pair table */
+#define PRODUCT_EMPTY_KEY UINT64_MAX
+
+/* Combination only used to compare languages: strings exactly one automaton accepts */
+#define PRODUCT_SYMMETRIC_DIFFERENCE ((rift_product_operation_t)(RIFT_PRODUCT_DIFFERENCE + 1))
+
+/**
+ * @brief One automaton of a product, stepped over the joint byte classes
+ *
+ * A side without a DFA stands for the automaton accepting every string,
+ * with a single state that all bytes lead back to.
+ */
+typedef struct {
+    const rift_frozen_automaton_t *dfa; /**< The DFA, NULL for the universal automaton */
+    uint32_t start;                     /**< Start state */
+    uint32_t dead;                      /**< Implicit rejecting sink, one past the last state */
+    uint32_t *next;                     /**< dead + 1 rows of num_classes targets */
+} product_side_t;
+
+/**
+ * @brief Working storage of a product walk
+ */
+typedef struct {
+    rift_byte_classes_t classes; /**< Byte classes neither DFA can tell apart */
+    product_side_t sides[2];     /**< The two automata */
+    uint64_t *keys;              /**< Visited pairs by hash, PRODUCT_EMPTY_KEY when free */
+    uint32_t *ids;               /**< Index in pairs of the pair in each slot */
+    size_t capacity;             /**< Number of slots, a power of two */
+    uint64_t *pairs;             /**< Visited pairs in breadth-first order */
+    size_t num_pairs;            /**< Number of visited pairs */
+    size_t pair_capacity;        /**< Number of pairs allocated */
+} product_t;
+
+/**
+ * @brief Set an error code and message
+ *
+ * @param error The error to update (can be NULL)
+ * @param code The error code
+ * @param message The error message
+ */
+static void
+set_error(rift_regex_error_t *error, rift_regex_error_code_t code, const char *message)
+{
+    if (error) {
+        error->code = code;
+        snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH, "%s", message);
+    }
+}
+
+/**
+ * @brief Check that a frozen automaton is a DFA the walk can step through
+ *
+ * @param dfa The frozen automaton
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if the automaton is deterministic, has a start state and no epsilon edges
+ */
+static bool
+check_dfa(const rift_frozen_automaton_t *dfa, rift_regex_error_t *error)
+{
+    if (!dfa) {
+        set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER, "Null automaton provided");
+        return false;
+    }
+
+    bool valid = dfa->is_deterministic && dfa->start_state != RIFT_FROZEN_NO_STATE;
+    for (uint32_t e = 0; valid && e < dfa->num_edges; e++) {
+        valid = !rift_frozen_automaton_edge_is_epsilon(dfa, e);
+    }
+    if (!valid) {
+        set_error(error, RIFT_REGEX_ERROR_INVALID_AUTOMATON,
+                  "Products need DFAs with a start state and no epsilon edges");
+    }
+    return valid;
+}
+
+/**
+ * @brief Refine the joint byte classes by the edges of a DFA
+ *
+ * @param classes The partition to refine
+ * @param dfa The frozen DFA (can be NULL)
+ */
+static void
+refine_classes(rift_byte_classes_t *classes, const rift_frozen_automaton_t *dfa)
+{
+    bool members[RIFT_BYTE_CLASS_ALPHABET_SIZE];
+    for (uint32_t e = 0; dfa && e < dfa->num_edges; e++) {
+        for (int c = 0; c < RIFT_BYTE_CLASS_ALPHABET_SIZE; c++) {
+            members[c] = rift_transition_predicate_test(&dfa->edge_predicates[e], (uint8_t)c);
+        }
+        rift_byte_classes_refine(classes, members);
+    }
+}
+
+/**
+ * @brief Fill the step table of a side over the joint byte classes
+ *
+ * @param side The side, whose DFA is set
+ * @param classes The joint byte classes
+ * @return true if successful, false on allocation failure
+ */
+static bool
+build_side(product_side_t *side, const rift_byte_classes_t *classes)
+{
+    const rift_frozen_automaton_t *dfa = side->dfa;
+    uint32_t num_classes = classes->num_classes;
+    side->start = dfa ? dfa->start_state : 0;
+    side->dead = dfa ? dfa->num_states : 1;
+    side->next = (uint32_t *)rift_malloc((size_t)(side->dead + 1) * num_classes * sizeof(uint32_t));
+    if (!side->next) {
+        return false;
+    }
+
+    for (size_t i = 0; i < (size_t)(side->dead + 1) * num_classes; i++) {
+        side->next[i] = dfa ? side->dead : 0;
+    }
+
+    for (uint32_t s = 0; dfa && s < dfa->num_states; s++) {
+        uint32_t *row = side->next + (size_t)s * num_classes;
+        for (uint32_t e = dfa->edge_offsets[s]; e < dfa->edge_offsets[s + 1]; e++) {
+            for (uint32_t k = 0; k < num_classes; k++) {
+                /* The first edge matching a byte wins, as in the DFA table */
+                if (row[k] == side->dead &&
+                    rift_transition_predicate_test(&dfa->edge_predicates[e],
+                                                   classes->representatives[k])) {
+                    row[k] = dfa->edge_targets[e];
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Check whether a side accepts in a state
+ *
+ * @param side The side
+ * @param state The state, possibly the dead one
+ * @return true if the state is accepting
+ */
+static bool
+side_accepts(const product_side_t *side, uint32_t state)
+{
+    if (!side->dfa) {
+        return true;
+    }
+    return state != side->dead && rift_frozen_automaton_is_accepting(side->dfa, state);
+}
+
+/**
+ * @brief Check whether a pair is accepting under an operation
+ *
+ * @param product The product
+ * @param operation How acceptance is combined
+ * @param pair The pair
+ * @return true if the pair is accepting
+ */
+static bool
+pair_accepts(const product_t *product, rift_product_operation_t operation, uint64_t pair)
+{
+    bool a = side_accepts(&product->sides[0], (uint32_t)(pair >> 32));
+    bool b = side_accepts(&product->sides[1], (uint32_t)pair);
+    switch (operation) {
+    case RIFT_PRODUCT_INTERSECTION:
+        return a && b;
+    case RIFT_PRODUCT_UNION:
+        return a || b;
+    case RIFT_PRODUCT_DIFFERENCE:
+        return a && !b;
+    default:
+        return a != b;
+    }
+}
+
+/**
+ * @brief Check whether no string leads from a pair to acceptance, judging by its dead states
+ *
+ * @param product The product
+ * @param operation How acceptance is combined
+ * @param pair The pair
+ * @return true if the pair need not be visited
+ */
+static bool
+pair_is_dead(const product_t *product, rift_product_operation_t operation, uint64_t pair)
+{
+    bool a_dead = (uint32_t)(pair >> 32) == product->sides[0].dead;
+    bool b_dead = (uint32_t)pair == product->sides[1].dead;
+    switch (operation) {
+    case RIFT_PRODUCT_INTERSECTION:
+        return a_dead || b_dead;
+    case RIFT_PRODUCT_DIFFERENCE:
+        return a_dead;
+    default:
+        return a_dead && b_dead;
+    }
+}
+
+/**
+ * @brief Get the slot of a pair in the table, or the free slot it would go to
+ *
+ * @param product The product, whose table has a free slot
+ * @param pair The pair
+ * @return The slot index
+ */
+static size_t
+find_slot(const product_t *product, uint64_t pair)
+{
+    size_t mask = product->capacity - 1;
+    size_t slot = (size_t)((pair * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+    while (product->keys[slot] != PRODUCT_EMPTY_KEY && product->keys[slot] != pair) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+/**
+ * @brief Double the pair table
+ *
+ * @param product The product
+ * @return true if successful, false on allocation failure
+ */
+static bool
+grow_table(product_t *product)
+{
+    size_t capacity = product->capacity * 2;
+    uint64_t *keys = (uint64_t *)rift_malloc(capacity * sizeof(uint64_t));
+    uint32_t *ids = (uint32_t *)rift_malloc(capacity * sizeof(uint32_t));
+    if (!keys || !ids) {
+        rift_free(keys);
+        rift_free(ids);
+        return false;
+    }
+
+    memset(keys, 0xff, capacity * sizeof(uint64_t));
+    rift_free(product->keys);
+    rift_free(product->ids);
+    product->keys = keys;
+    product->ids = ids;
+    product->capacity = capacity;
+
+    for (size_t i = 0; i < product->num_pairs; i++) {
+        size_t slot = find_slot(product, product->pairs[i]);
+        keys[slot] = product->pairs[i];
+        ids[slot] = (uint32_t)i;
+    }
+    return true;
+}
+
+/**
+ * @brief Record a pair unless it was visited
+ *
+ * @param product The product
+ * @param pair The pair
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if the pair is recorded, false on failure
+ */
+static bool
+visit_pair(product_t *product, uint64_t pair, rift_regex_error_t *error)
+{
+    if (product->keys[find_slot(product, pair)] == pair) {
+        return true;
+    }
+
+    if (product->num_pairs >= RIFT_PRODUCT_MAX_STATES) {
+        set_error(error, RIFT_REGEX_ERROR_LIMIT_EXCEEDED, "Product has too many state pairs");
+        return false;
+    }
+
+    /* The table stays at most half full */
+    if ((product->num_pairs + 1) * 2 > product->capacity && !grow_table(product)) {
+        set_error(error, RIFT_REGEX_ERROR_MEMORY, "Failed to allocate product state pairs");
+        return false;
+    }
+    if (product->num_pairs == product->pair_capacity) {
+        size_t pair_capacity = product->pair_capacity * 2;
+        uint64_t *pairs =
+            (uint64_t *)rift_realloc(product->pairs, pair_capacity * sizeof(uint64_t));
+        if (!pairs) {
+            set_error(error, RIFT_REGEX_ERROR_MEMORY, "Failed to allocate product state pairs");
+            return false;
+        }
+        product->pairs = pairs;
+        product->pair_capacity = pair_capacity;
+    }
+
+    size_t slot = find_slot(product, pair);
+    product->keys[slot] = pair;
+    product->ids[slot] = (uint32_t)product->num_pairs;
+    product->pairs[product->num_pairs++] = pair;
+    return true;
+}
+
+/**
+ * @brief Look up the index of a visited pair
+ *
+ * @param product The product
+ * @param pair The pair
+ * @return The index in breadth-first order, or UINT32_MAX if it was not visited
+ */
+static uint32_t
+find_pair(const product_t *product, uint64_t pair)
+{
+    size_t slot = find_slot(product, pair);
+    return product->keys[slot] == pair ? product->ids[slot] : UINT32_MAX;
+}
+
+/**
+ * @brief Get the pair a byte class leads to
+ *
+ * @param product The product
+ * @param pair The pair
+ * @param class_index The byte class
+ * @return The next pair
+ */
+static uint64_t
+step_pair(const product_t *product, uint64_t pair, uint32_t class_index)
+{
+    uint32_t num_classes = product->classes.num_classes;
+    const product_side_t *a = &product->sides[0];
+    const product_side_t *b = &product->sides[1];
+    uint64_t next_a = a->next[(size_t)(pair >> 32) * num_classes + class_index];
+    uint64_t next_b = b->next[(size_t)(uint32_t)pair * num_classes + class_index];
+    return (next_a << 32) | next_b;
+}
+
+/**
+ * @brief Free the storage of a product
+ *
+ * @param product The product
+ */
+static void
+product_destroy(product_t *product)
+{
+    rift_free(product->sides[0].next);
+    rift_free(product->sides[1].next);
+    rift_free(product->keys);
+    rift_free(product->ids);
+    rift_free(product->pairs);
+}
+
+/**
+ * @brief Prepare the walk of two automata
+ *
+ * @param product The product to initialize
+ * @param a The first frozen DFA, NULL for the universal automaton
+ * @param b The second frozen DFA
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+static bool
+product_init(product_t *product, const rift_frozen_automaton_t *a,
+             const rift_frozen_automaton_t *b, rift_regex_error_t *error)
+{
+    memset(product, 0, sizeof(*product));
+    if ((a && !check_dfa(a, error)) || !check_dfa(b, error)) {
+        return false;
+    }
+
+    rift_byte_classes_init(&product->classes);
+    refine_classes(&product->classes, a);
+    refine_classes(&product->classes, b);
+    product->sides[0].dfa = a;
+    product->sides[1].dfa = b;
+
+    product->capacity = 64;
+    product->pair_capacity = 32;
+    product->keys = (uint64_t *)rift_malloc(product->capacity * sizeof(uint64_t));
+    product->ids = (uint32_t *)rift_malloc(product->capacity * sizeof(uint32_t));
+    product->pairs = (uint64_t *)rift_malloc(product->pair_capacity * sizeof(uint64_t));
+    if (!product->keys || !product->ids || !product->pairs ||
+        !build_side(&product->sides[0], &product->classes) ||
+        !build_side(&product->sides[1], &product->classes)) {
+        product_destroy(product);
+        set_error(error, RIFT_REGEX_ERROR_MEMORY, "Failed to allocate product tables");
+        return false;
+    }
+    memset(product->keys, 0xff, product->capacity * sizeof(uint64_t));
+    return true;
+}
+
+/**
+ * @brief Visit the pairs reachable from the start pair breadth first
+ *
+ * Dead pairs are neither recorded nor stepped from.
+ *
+ * @param product The product
+ * @param operation How acceptance is combined
+ * @param stop_at_accept Whether to stop at the first accepting pair
+ * @param error Pointer to store error information (can be NULL)
+ * @return 1 if an accepting pair was reached, 0 if not, negative on error
+ */
+static int
+explore(product_t *product, rift_product_operation_t operation, bool stop_at_accept,
+        rift_regex_error_t *error)
+{
+    uint64_t start = ((uint64_t)product->sides[0].start << 32) | product->sides[1].start;
+    if (pair_is_dead(product, operation, start)) {
+        return 0;
+    }
+    if (!visit_pair(product, start, error)) {
+        return -1;
+    }
+
+    int accepted = 0;
+    for (size_t i = 0; i < product->num_pairs; i++) {
+        uint64_t pair = product->pairs[i];
+        if (pair_accepts(product, operation, pair)) {
+            accepted = 1;
+            if (stop_at_accept) {
+                break;
+            }
+        }
+
+        for (uint32_t k = 0; k < product->classes.num_classes; k++) {
+            uint64_t next = step_pair(product, pair, k);
+            if (!pair_is_dead(product, operation, next) && !visit_pair(product, next, error)) {
+                return -1;
+            }
+        }
+    }
+    return accepted;
+}
+
+/**
+ * @brief Build the DFA of the visited pairs
+ *
+ * @param product The product, fully explored
+ * @param operation How acceptance is combined
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new DFA or NULL on failure
+ */
+static rift_regex_automaton_t *
+build_automaton(const product_t *product, rift_product_operation_t operation,
+                rift_regex_error_t *error)
+{
+    rift_regex_automaton_t *result = rift_automaton_create(RIFT_AUTOMATON_DFA);
+    rift_regex_state_t **states = (rift_regex_state_t **)rift_malloc(
+        (product->num_pairs > 0 ? product->num_pairs : 1) * sizeof(rift_regex_state_t *));
+    if (!result || !states) {
+        goto memory_error;
+    }
+
+    /* With no live pair the language is empty: a lone rejecting start state */
+    if (product->num_pairs == 0) {
+        rift_regex_state_t *start = rift_automaton_create_state(result, false);
+        if (!start || !rift_automaton_set_initial_state(result, start)) {
+            goto memory_error;
+        }
+        rift_free(states);
+        return result;
+    }
+
+    for (size_t i = 0; i < product->num_pairs; i++) {
+        states[i] =
+            rift_automaton_create_state(result, pair_accepts(product, operation, product->pairs[i]));
+        if (!states[i]) {
+            goto memory_error;
+        }
+    }
+    if (!rift_automaton_set_initial_state(result, states[0])) {
+        goto memory_error;
+    }
+
+    uint32_t targets[RIFT_BYTE_CLASS_ALPHABET_SIZE];
+    bool emitted[RIFT_BYTE_CLASS_ALPHABET_SIZE];
+    char pattern[RIFT_BYTE_CLASS_MAX_PATTERN_LENGTH];
+    uint32_t num_classes = product->classes.num_classes;
+    for (size_t i = 0; i < product->num_pairs; i++) {
+        for (uint32_t k = 0; k < num_classes; k++) {
+            targets[k] = find_pair(product, step_pair(product, product->pairs[i], k));
+            emitted[k] = targets[k] == UINT32_MAX;
+        }
+
+        /* One transition per target, over every byte of the classes leading there */
+        for (uint32_t k = 0; k < num_classes; k++) {
+            if (emitted[k]) {
+                continue;
+            }
+
+            uint32_t set[RIFT_BYTE_SET_WORDS] = {0};
+            for (int c = 0; c < RIFT_BYTE_CLASS_ALPHABET_SIZE; c++) {
+                uint8_t class_index = product->classes.map[c];
+                if (targets[class_index] == targets[k]) {
+                    set[c >> 5] |= 1u << (c & 31);
+                    emitted[class_index] = true;
+                }
+            }
+
+            if (rift_byte_set_format_pattern(set, pattern, sizeof(pattern)) > 0 &&
+                !rift_automaton_add_transition(result, states[i], states[targets[k]], pattern)) {
+                goto memory_error;
+            }
+        }
+    }
+
+    rift_free(states);
+    return result;
+
+memory_error:
+    set_error(error, RIFT_REGEX_ERROR_MEMORY, "Failed to build product automaton");
+    rift_free(states);
+    rift_automaton_free(result);
+    return NULL;
+}
+
+/**
+ * @brief Build the product of two automata
+ *
+ * @param a The first frozen DFA, NULL for the universal automaton
+ * @param b The second frozen DFA
+ * @param operation How acceptance is combined
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new DFA or NULL on failure
+ */
+static rift_regex_automaton_t *
+product_build(const rift_frozen_automaton_t *a, const rift_frozen_automaton_t *b,
+              rift_product_operation_t operation, rift_regex_error_t *error)
+{
+    product_t product;
+    if (!product_init(&product, a, b, error)) {
+        return NULL;
+    }
+
+    rift_regex_automaton_t *result = explore(&product, operation, false, error) >= 0
+                                         ? build_automaton(&product, operation, error)
+                                         : NULL;
+    product_destroy(&product);
+    return result;
+}
+
+/**
+ * @brief Check whether the product of two DFAs accepts nothing
+ *
+ * @param a The first frozen DFA
+ * @param b The second frozen DFA
+ * @param operation How acceptance is combined
+ * @param error Pointer to store error information (can be NULL)
+ * @return 1 if the product accepts no string, 0 if it accepts one, negative on error
+ */
+static int
+product_is_empty(const rift_frozen_automaton_t *a, const rift_frozen_automaton_t *b,
+                 rift_product_operation_t operation, rift_regex_error_t *error)
+{
+    if (!a) {
+        set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER, "Null automaton provided");
+        return -1;
+    }
+
+    product_t product;
+    if (!product_init(&product, a, b, error)) {
+        return -1;
+    }
+
+    int accepted = explore(&product, operation, true, error);
+    product_destroy(&product);
+    return accepted < 0 ? -1 : !accepted;
+}
+
+/**
+ * @brief Freeze the DFA of an automaton for the product operations
+ *
+ * @param automaton The automaton
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new frozen DFA or NULL on failure
+ */
+rift_frozen_automaton_t *
+rift_automaton_freeze_dfa(const rift_regex_automaton_t *automaton, rift_regex_error_t *error)
+{
+    if (!automaton) {
+        set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER, "Null automaton provided");
+        return NULL;
+    }
+
+    if (automaton->is_deterministic) {
+        return rift_frozen_automaton_create(automaton, error);
+    }
+
+    rift_regex_automaton_t *dfa = rift_automaton_nfa_to_dfa(automaton, error);
+    rift_frozen_automaton_t *frozen = dfa ? rift_frozen_automaton_create(dfa, error) : NULL;
+    rift_automaton_free(dfa);
+    return frozen;
+}
+
+/**
+ * @brief Build the product of two DFAs
+ *
+ * @param a The first frozen DFA
+ * @param b The second frozen DFA
+ * @param operation How acceptance is combined
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new DFA or NULL on failure
+ */
+rift_regex_automaton_t *
+rift_automaton_product(const rift_frozen_automaton_t *a, const rift_frozen_automaton_t *b,
+                       rift_product_operation_t operation, rift_regex_error_t *error)
+{
+    if (!a || operation > RIFT_PRODUCT_DIFFERENCE) {
+        set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                  "Null automaton or unknown product operation");
+        return NULL;
+    }
+    return product_build(a, b, operation, error);
+}
+
+/**
+ * @brief Build a DFA accepting the strings two DFAs both accept
+ *
+ * @param a The first frozen DFA
+ * @param b The second frozen DFA
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new DFA or NULL on failure
+ */
+rift_regex_automaton_t *
+rift_automaton_intersection(const rift_frozen_automaton_t *a, const rift_frozen_automaton_t *b,
+                            rift_regex_error_t *error)
+{
+    return rift_automaton_product(a, b, RIFT_PRODUCT_INTERSECTION, error);
+}
+
+/**
+ * @brief Build a DFA accepting the strings a DFA rejects
+ *
+ * @param dfa The frozen DFA
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new DFA or NULL on failure
+ */
+rift_regex_automaton_t *
+rift_automaton_complement(const rift_frozen_automaton_t *dfa, rift_regex_error_t *error)
+{
+    /* Everything minus the language of the DFA */
+    return product_build(NULL, dfa, RIFT_PRODUCT_DIFFERENCE, error);
+}
+
+/**
+ * @brief Check whether every string one DFA accepts is accepted by another
+ *
+ * @param a The frozen DFA whose language may be included
+ * @param b The frozen DFA whose language may include it
+ * @param error Pointer to store error information (can be NULL)
+ * @return 1 if the language of a is a subset of that of b, 0 if not,
+ *         negative on error
+ */
+int
+rift_automaton_is_subset(const rift_frozen_automaton_t *a, const rift_frozen_automaton_t *b,
+                         rift_regex_error_t *error)
+{
+    return product_is_empty(a, b, RIFT_PRODUCT_DIFFERENCE, error);
+}
+
+/**
+ * @brief Check whether two DFAs accept the same strings
+ *
+ * @param a The first frozen DFA
+ * @param b The second frozen DFA
+ * @param error Pointer to store error information (can be NULL)
+ * @return 1 if the languages are equal, 0 if not, negative on error
+ */
+int
+rift_automaton_is_equivalent(const rift_frozen_automaton_t *a, const rift_frozen_automaton_t *b,
+                             rift_regex_error_t *error)
+{
+    return product_is_empty(a, b, PRODUCT_SYMMETRIC_DIFFERENCE, error);
+}
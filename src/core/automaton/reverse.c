@@ -0,0 +1,145 @@
+/**
+ * @file reverse.c
+ * @brief Implementation of automaton reversal for the LibRift regex engine
+ *
+ * This file reverses an automaton through its frozen form, whose integer
+ * state indices and edge arrays give every edge without looking states up
+ * by address. Anchors and word boundaries stay on their states; read
+ * backward, a start anchor tests what an end anchor tests forward.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/automaton/reverse.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/automaton/frozen_automaton.h"
+#include "core/automaton/state.h"
+#include "core/memory/memory.h"
+
+/**
+ * @brief Get the assertion flags a state keeps in the reverse automaton
+ *
+ * @param flags Flags of the state in the frozen automaton
+ * @return The flags with the anchors swapped and everything but assertions dropped
+ */
+static rift_state_flag_t
+reversed_flags(uint8_t flags)
+{
+    rift_state_flag_t result =
+        (rift_state_flag_t)(flags & (RIFT_STATE_FLAG_WORD_BOUNDARY |
+                                     RIFT_STATE_FLAG_NOT_WORD_BOUNDARY));
+    if (flags & RIFT_STATE_FLAG_ANCHOR_START) {
+        result |= RIFT_STATE_FLAG_ANCHOR_END;
+    }
+    if (flags & RIFT_STATE_FLAG_ANCHOR_END) {
+        result |= RIFT_STATE_FLAG_ANCHOR_START;
+    }
+    return result;
+}
+
+/**
+ * @brief Add the reversed edges and states of a frozen automaton
+ *
+ * @param frozen The frozen automaton
+ * @param reversed The reverse automaton, holding its new initial state
+ * @param states Array of frozen->num_states entries for the reversed states
+ * @return true if successful, false on allocation failure
+ */
+static bool
+add_reversed(const rift_frozen_automaton_t *frozen, rift_regex_automaton_t *reversed,
+             rift_regex_state_t **states)
+{
+    for (uint32_t i = 0; i < frozen->num_states; i++) {
+        states[i] = rift_automaton_create_state(reversed, i == frozen->start_state);
+        if (!states[i] || !rift_state_set_flag(states[i], reversed_flags(frozen->state_flags[i]))) {
+            return false;
+        }
+    }
+
+    rift_regex_state_t *start = rift_automaton_get_initial_state(reversed);
+    for (uint32_t i = 0; i < frozen->num_states; i++) {
+        if (rift_frozen_automaton_is_accepting(frozen, i) &&
+            !rift_state_add_epsilon_transition(start, states[i])) {
+            return false;
+        }
+
+        for (uint32_t e = frozen->edge_offsets[i]; e < frozen->edge_offsets[i + 1]; e++) {
+            rift_regex_state_t *from = states[frozen->edge_targets[e]];
+            const char *pattern = rift_frozen_automaton_get_edge_pattern(frozen, e);
+            bool added = rift_frozen_automaton_edge_is_epsilon(frozen, e)
+                             ? rift_state_add_epsilon_transition(from, states[i])
+                             : !pattern || rift_state_add_transition(from, states[i], pattern);
+            if (!added) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Build the reverse of an automaton
+ */
+rift_regex_automaton_t *
+rift_automaton_reverse(const rift_regex_automaton_t *automaton, rift_regex_error_t *error)
+{
+    if (!automaton) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Null automaton provided");
+        }
+        return NULL;
+    }
+
+    rift_frozen_automaton_t *frozen = rift_frozen_automaton_create(automaton, error);
+    if (!frozen) {
+        return NULL;
+    }
+
+    // A counter or an assertion reads the input in one direction only
+    if (frozen->num_counters > 0 || frozen->num_lookarounds > 0) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Automata with counted loops or lookarounds cannot be reversed");
+        }
+        rift_frozen_automaton_free(frozen);
+        return NULL;
+    }
+
+    if (frozen->start_state == RIFT_FROZEN_NO_STATE) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_AUTOMATON;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Automaton has no initial state");
+        }
+        rift_frozen_automaton_free(frozen);
+        return NULL;
+    }
+
+    rift_regex_automaton_t *reversed = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t **states =
+        (rift_regex_state_t **)rift_malloc(frozen->num_states * sizeof(rift_regex_state_t *));
+    rift_regex_state_t *start = reversed ? rift_automaton_create_state(reversed, false) : NULL;
+    bool built = start && states && rift_automaton_set_initial_state(reversed, start) &&
+                 rift_automaton_set_flags(reversed, frozen->flags) &&
+                 add_reversed(frozen, reversed, states);
+
+    rift_free(states);
+    rift_frozen_automaton_free(frozen);
+
+    if (!built) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_MEMORY;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Failed to allocate reverse automaton");
+        }
+        rift_automaton_free(reversed);
+        return NULL;
+    }
+    return reversed;
+}
@@ -0,0 +1,48 @@
+/**
+ * @file sparse_set.c
+ * @brief Implementation of sparse sets of NFA state indices
+ *
+ * The sparse array is zeroed although a sparse set reads its entries only
+ * to check them against dense, so that memory checkers see no read of
+ * uninitialized memory.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/automaton/sparse_set.h"
+#include "core/memory/memory.h"
+
+bool
+rift_sparse_set_init(rift_sparse_set_t *set, uint32_t capacity)
+{
+    if (!set) {
+        return false;
+    }
+
+    /* One spare entry keeps an empty set's arrays allocated */
+    set->dense = (uint32_t *)rift_malloc(((size_t)capacity + 1) * sizeof(uint32_t));
+    set->sparse = (uint32_t *)rift_calloc((size_t)capacity + 1, sizeof(uint32_t));
+    set->count = 0;
+    set->capacity = capacity;
+    if (!set->dense || !set->sparse) {
+        rift_sparse_set_destroy(set);
+        return false;
+    }
+    return true;
+}
+
+void
+rift_sparse_set_destroy(rift_sparse_set_t *set)
+{
+    if (!set) {
+        return;
+    }
+
+    rift_free(set->dense);
+    rift_free(set->sparse);
+    set->dense = NULL;
+    set->sparse = NULL;
+    set->count = 0;
+    set->capacity = 0;
+}
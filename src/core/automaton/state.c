@@ -1980,8 +1980,20 @@ utomaton/state.h"/a #include "core/automaton/state.h"
 utomaton/state.h"/a #include "core/memory/memory.h"
 utomaton/state.h"/a #include "core/automaton/transition.h"
 utomaton/state.h"/a #include "core/memory/memory.h"
-/* Static counter for generating unique state IDs */
-static size_t next_state_id = 1;
+/**
+ * @brief Get the group data of a state, allocating it on first use
+ *
+ * @param state The state
+ * @return The group data or NULL on allocation failure
+ */
+static rift_state_capture_t *
+state_capture(rift_regex_state_t *state)
+{
+    if (!state->capture) {
+        state->capture = calloc(1, sizeof(rift_state_capture_t));
+    }
+    return state->capture;
+}
 
 utomaton/state.h"/a #include "core/memory/memory.h"
 utomaton/state.h"/a #include "core/automaton/transition.h"
@@ -2061,7 +2073,7 @@ rift_state_create(bool is_accepting)
     }
 
     /* Initialize the state */
-    state->id = next_state_id++;
+    state->id = RIFT_STATE_NO_ID; /* Assigned by the automaton the state is added to */
     state->is_accepting = is_accepting;
     state->pattern = NULL;
     state->transitions = NULL;
@@ -2069,14 +2081,25 @@ rift_state_create(bool is_accepting)
     state->transition_capacity = 0;
     state->user_data = NULL;
 
-    /* Initialize group data */
-    state->group_name = NULL;
-    state->is_group_start = false;
-    state->is_group_end = false;
+    /* Group data is only allocated for the states that need it */
+    state->capture = NULL;
 
     /* Initialize flags */
     state->flags = RIFT_STATE_FLAG_NONE;
 
+    /* Initialize accept tags */
+    state->accept_tags = NULL;
+    state->num_accept_tag_words = 0;
+
+    /* Initialize counted loop data */
+    state->repeat_min = 0;
+    state->repeat_max = 0;
+    state->repeat_greedy = true;
+    state->repeat_start = NULL;
+
+    /* Initialize lookaround data */
+    state->lookaround = RIFT_STATE_NO_LOOKAROUND;
+
     return state;
 }
 
@@ -2161,22 +2184,16 @@ utomaton/state.h"/a #include "core/memory/memory.h"
 utomaton/state.h"/a #include "core/automaton/transition.h"
 utomaton/state.h"/a #include "core/memory/memory.h"
 /**
- * @brief Set the end position of a capturing group for a state
+ * @brief Mark a state as the end of a capturing group
  *
  * @param state The state
- * @param group_index The capturing group index
- * @param position The end position
+ * @param is_end Whether the state ends a group
  * @return true if successful, false otherwise
  */
 bool
-rift_automaton_set_state_group_end(rift_regex_state_t *state, size_t group_index, size_t position)
+rift_automaton_set_state_group_end(rift_regex_state_t *state, bool is_end)
 {
-    if (!state || group_index >= RIFT_MAX_CAPTURE_GROUPS) {
-        return false;
-    }
-
-    state->capture_group_ends[group_index] = position;
-    return true;
+    return rift_state_set_group_end(state, is_end);
 }
 
 bool
@@ -2270,11 +2287,15 @@ rift_state_free(rift_regex_state_t *state)
         free(state->pattern);
     }
 
-    /* Free the group name */
-    if (state->group_name) {
-        free(state->group_name);
+    /* Free the group data */
+    if (state->capture) {
+        free(state->capture->group_name);
+        free(state->capture);
     }
 
+    /* Free the accept tags */
+    free(state->accept_tags);
+
     /* Free all transitions */
     if (state->transitions) {
         for (size_t i = 0; i < state->num_transitions; i++) {
@@ -2379,19 +2400,29 @@ rift_state_clone(const rift_regex_state_t *state)
         }
     }
 
-    /* Copy group name if it exists */
-    if (state->group_name) {
-        clone->group_name = strdup(state->group_name);
-        if (!clone->group_name) {
+    /* Copy group data if there is any */
+    if (state->capture) {
+        if (!rift_state_set_group_name(clone, state->capture->group_name) ||
+            !rift_state_set_group_start(clone, state->capture->is_group_start) ||
+            !rift_state_set_group_end(clone, state->capture->is_group_end)) {
             rift_state_free(clone);
             return NULL;
         }
     }
 
+    /* Copy accept tags if there are any */
+    if (!rift_state_merge_accept_tags(clone, state)) {
+        rift_state_free(clone);
+        return NULL;
+    }
+
     /* Copy other simple properties */
-    clone->is_group_start = state->is_group_start;
-    clone->is_group_end = state->is_group_end;
     clone->flags = state->flags;
+    clone->repeat_min = state->repeat_min;
+    clone->repeat_max = state->repeat_max;
+    clone->repeat_greedy = state->repeat_greedy;
+    clone->repeat_start = state->repeat_start == state ? clone : state->repeat_start;
+    clone->lookaround = state->lookaround;
 
     /* User data is typically not cloned */
 
@@ -2785,12 +2816,12 @@ utomaton/state.h"/a #include "core/memory/memory.h"
  * @brief Get the ID of a state
  *
  * @param state The state
- * @return The state ID or 0 if the state is NULL
+ * @return The state ID, or RIFT_STATE_NO_ID if the state is NULL or in no automaton
  */
 size_t
 rift_state_get_id(const rift_regex_state_t *state)
 {
-    return state ? state->id : 0;
+    return state ? state->id : RIFT_STATE_NO_ID;
 }
 
 utomaton/state.h"/a #include "core/memory/memory.h"
@@ -2872,12 +2903,6 @@ rift_state_set_id(rift_regex_state_t *state, size_t id)
     }
 
     state->id = id;
-
-    /* Update the next_state_id if necessary */
-    if (id >= next_state_id) {
-        next_state_id = id + 1;
-    }
-
     return true;
 }
 
@@ -3586,22 +3611,22 @@ rift_state_are_equivalent(const rift_regex_state_t *state1, const rift_regex_sta
     }
 
     /* Check if the states have the same group properties */
-    if (state1->is_group_start != state2->is_group_start ||
-        state1->is_group_end != state2->is_group_end) {
+    if (rift_state_is_group_start(state1) != rift_state_is_group_start(state2) ||
+        rift_state_is_group_end(state1) != rift_state_is_group_end(state2)) {
         return false;
     }
 
     /* Check if both states have group names or both don't */
-    bool state1_has_group_name = (state1->group_name != NULL);
-    bool state2_has_group_name = (state2->group_name != NULL);
+    const char *state1_group_name = rift_state_get_group_name(state1);
+    const char *state2_group_name = rift_state_get_group_name(state2);
 
-    if (state1_has_group_name != state2_has_group_name) {
+    if ((state1_group_name != NULL) != (state2_group_name != NULL)) {
         return false;
     }
 
     /* If both have group names, check if they are the same */
-    if (state1_has_group_name && state2_has_group_name) {
-        if (strcmp(state1->group_name, state2->group_name) != 0) {
+    if (state1_group_name && state2_group_name) {
+        if (strcmp(state1_group_name, state2_group_name) != 0) {
             return false;
         }
     }
@@ -3851,15 +3876,19 @@ rift_state_set_group_name(rift_regex_state_t *state, const char *name)
     }
 
     /* Free existing name if any */
-    if (state->group_name) {
-        free(state->group_name);
-        state->group_name = NULL;
+    if (state->capture && state->capture->group_name) {
+        free(state->capture->group_name);
+        state->capture->group_name = NULL;
     }
 
     /* Set new name if provided */
     if (name) {
-        state->group_name = strdup(name);
-        if (!state->group_name) {
+        rift_state_capture_t *capture = state_capture(state);
+        if (!capture) {
+            return false;
+        }
+        capture->group_name = strdup(name);
+        if (!capture->group_name) {
             return false;
         }
     }
@@ -3938,7 +3967,7 @@ utomaton/state.h"/a #include "core/memory/memory.h"
 const char *
 rift_state_get_group_name(const rift_regex_state_t *state)
 {
-    return state ? ((const struct rift_regex_state *)state)->group_name : NULL;
+    return state && state->capture ? state->capture->group_name : NULL;
 }
 
 utomaton/state.h"/a #include "core/memory/memory.h"
@@ -4017,7 +4046,16 @@ rift_state_set_group_start(rift_regex_state_t *state, bool is_group_start)
         return false;
     }
 
-    state->is_group_start = is_group_start;
+    /* Clearing the mark needs no record */
+    if (!is_group_start && !state->capture) {
+        return true;
+    }
+
+    rift_state_capture_t *capture = state_capture(state);
+    if (!capture) {
+        return false;
+    }
+    capture->is_group_start = is_group_start;
     return true;
 }
 
@@ -4092,7 +4130,7 @@ utomaton/state.h"/a #include "core/memory/memory.h"
 bool
 rift_state_is_group_start(const rift_regex_state_t *state)
 {
-    return state ? ((const struct rift_regex_state *)state)->is_group_start : false;
+    return state && state->capture ? state->capture->is_group_start : false;
 }
 
 utomaton/state.h"/a #include "core/memory/memory.h"
@@ -4171,7 +4209,16 @@ rift_state_set_group_end(struct rift_regex_state *state, bool is_group_end)
         return false;
     }
 
-    state->is_group_end = is_group_end;
+    /* Clearing the mark needs no record */
+    if (!is_group_end && !state->capture) {
+        return true;
+    }
+
+    rift_state_capture_t *capture = state_capture(state);
+    if (!capture) {
+        return false;
+    }
+    capture->is_group_end = is_group_end;
     return true;
 }
 
@@ -4246,80 +4293,109 @@ utomaton/state.h"/a #include "core/memory/memory.h"
 bool
 rift_state_is_group_end(const rift_regex_state_t *state)
 {
-    return state ? ((const struct rift_regex_state *)state)->is_group_end : false;
+    return state && state->capture ? state->capture->is_group_end : false;
 }
 
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/automaton/transition.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/automaton/state.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/automaton/transition.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/config/config.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/automaton/transition.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/automaton/state.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/automaton/transition.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/runtime/matcher.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/automaton/transition.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/automaton/state.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/automaton/transition.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/config/config.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/automaton/transition.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/automaton/state.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/automaton/transition.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/automaton/transition.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/automaton/state.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/automaton/transition.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/config/config.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/automaton/transition.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/automaton/state.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/automaton/transition.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/runtime/matcher.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/automaton/transition.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/automaton/state.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/automaton/transition.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/config/config.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/automaton/transition.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/automaton/state.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
-utomaton/state.h"/a #include "core/automaton/transition.h"
-utomaton/state.h"/a #include "core/memory/memory.h"
 /**
- * @brief Reset the state ID counter
+ * @brief Grow the accept tag bitset of a state to hold a number of words
  *
- * This function should only be used for testing purposes.
+ * @param state The state to modify
+ * @param words Number of 64-bit words needed
+ * @return true if successful, false on allocation failure
  */
-void
-rift_state_reset_id_counter(void)
+static bool
+reserve_accept_tag_words(rift_regex_state_t *state, size_t words)
 {
-    next_state_id = 1;
+    if (words <= state->num_accept_tag_words) {
+        return true;
+    }
+
+    uint64_t *tags = (uint64_t *)realloc(state->accept_tags, words * sizeof(uint64_t));
+    if (!tags) {
+        return false;
+    }
+
+    memset(tags + state->num_accept_tag_words, 0,
+           (words - state->num_accept_tag_words) * sizeof(uint64_t));
+    state->accept_tags = tags;
+    state->num_accept_tag_words = words;
+    return true;
+}
+
+/**
+ * @brief Tag a state as accepting for a pattern
+ *
+ * @param state The state to modify
+ * @param tag The pattern identifier
+ * @return true if successful, false otherwise
+ */
+bool
+rift_state_add_accept_tag(rift_regex_state_t *state, uint32_t tag)
+{
+    if (!state || !reserve_accept_tag_words(state, (size_t)tag / 64 + 1)) {
+        return false;
+    }
+
+    state->accept_tags[tag / 64] |= (uint64_t)1 << (tag % 64);
+    state->is_accepting = true;
+    return true;
+}
+
+/**
+ * @brief Check whether a state accepts for a pattern
+ *
+ * @param state The state to check
+ * @param tag The pattern identifier
+ * @return true if the state carries the tag, false otherwise
+ */
+bool
+rift_state_has_accept_tag(const rift_regex_state_t *state, uint32_t tag)
+{
+    if (!state || (size_t)tag / 64 >= state->num_accept_tag_words) {
+        return false;
+    }
+
+    return (state->accept_tags[tag / 64] >> (tag % 64)) & 1u;
+}
+
+/**
+ * @brief Get the accept tag bitset of a state
+ *
+ * @param state The state
+ * @param num_words Pointer to store the number of 64-bit words (can be NULL)
+ * @return The bitset or NULL if the state has no tags
+ */
+const uint64_t *
+rift_state_get_accept_tags(const rift_regex_state_t *state, size_t *num_words)
+{
+    if (num_words) {
+        *num_words = state ? state->num_accept_tag_words : 0;
+    }
+    return state ? state->accept_tags : NULL;
+}
+
+/**
+ * @brief Add the accept tags of one state to another
+ *
+ * @param state The state to modify
+ * @param source The state whose tags are added
+ * @return true if successful, false otherwise
+ */
+bool
+rift_state_merge_accept_tags(rift_regex_state_t *state, const rift_regex_state_t *source)
+{
+    if (!state || !source) {
+        return false;
+    }
+
+    if (!reserve_accept_tag_words(state, source->num_accept_tag_words)) {
+        return false;
+    }
+
+    for (size_t w = 0; w < source->num_accept_tag_words; w++) {
+        state->accept_tags[w] |= source->accept_tags[w];
+    }
+    return true;
 }
 
 utomaton/state.h"/a #include "core/memory/memory.h"
@@ -4384,8 +4460,6 @@ utomaton/state.h"/a #include "core/automaton/state.h"
 utomaton/state.h"/a #include "core/memory/memory.h"
 utomaton/state.h"/a #include "core/automaton/transition.h"
 utomaton/state.h"/a #include "core/memory/memory.h"
-/* Removing rift_state_info_t functions as the type is not defined */
-
 utomaton/state.h"/a #include "core/memory/memory.h"
 utomaton/state.h"/a #include "core/automaton/transition.h"
 utomaton/state.h"/a #include "core/memory/memory.h"
@@ -4448,11 +4522,7 @@ utomaton/state.h"/a #include "core/automaton/state.h"
 utomaton/state.h"/a #include "core/memory/memory.h"
 utomaton/state.h"/a #include "core/automaton/transition.h"
 utomaton/state.h"/a #include "core/memory/memory.h"
-/**
- * @brief Get the next available state ID
- *
- * @return The next available state ID
- */
+/* Removing rift_state_info_t functions as the type is not defined */
 
 utomaton/state.h"/a #include "core/memory/memory.h"
 utomaton/state.h"/a #include "core/automaton/transition.h"
@@ -4516,13 +4586,3 @@ utomaton/state.h"/a #include "core/automaton/state.h"
 utomaton/state.h"/a #include "core/memory/memory.h"
 utomaton/state.h"/a #include "core/automaton/transition.h"
 utomaton/state.h"/a #include "core/memory/memory.h"
-/**
- * @brief Get the next available state ID
- *
- * @return The next available state ID
- */
-size_t
-rift_state_get_next_id(void)
-{
-    return next_state_id;
-}
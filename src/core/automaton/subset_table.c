@@ -0,0 +1,283 @@
+/**
+ * @file subset_table.c
+ * @brief Implementation of the hash-indexed subset table for the LibRift regex engine
+ *
+ * This file stores NFA state subsets as bitsets and indexes them with linear
+ * probing over their 64-bit hashes.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/automaton/subset_table.h"
+#include <stdlib.h>
+#include <string.h>
+#include "core/memory/memory.h"
+
+/** Initial number of subsets the storage can hold */
+#define SUBSET_TABLE_INITIAL_CAPACITY 16
+
+/**
+ * @brief Create an empty subset table
+ *
+ * @param num_nfa_states Number of NFA states a subset can contain
+ * @return A new subset table or NULL on failure
+ */
+rift_subset_table_t *
+rift_subset_table_create(uint32_t num_nfa_states)
+{
+    rift_subset_table_t *table = (rift_subset_table_t *)rift_calloc(1, sizeof(rift_subset_table_t));
+    if (!table) {
+        return NULL;
+    }
+
+    /* Keep at least one word so empty subsets still have a distinct storage slot */
+    table->words = ((size_t)num_nfa_states + 63) / 64;
+    if (table->words == 0) {
+        table->words = 1;
+    }
+
+    table->capacity = SUBSET_TABLE_INITIAL_CAPACITY;
+    table->num_slots = (size_t)SUBSET_TABLE_INITIAL_CAPACITY * 2;
+    table->bits = (uint64_t *)rift_malloc(table->capacity * table->words * sizeof(uint64_t));
+    table->hashes = (uint64_t *)rift_malloc(table->capacity * sizeof(uint64_t));
+    table->slots = (uint32_t *)rift_calloc(table->num_slots, sizeof(uint32_t));
+
+    if (!table->bits || !table->hashes || !table->slots) {
+        rift_subset_table_free(table);
+        return NULL;
+    }
+
+    return table;
+}
+
+/**
+ * @brief Free a subset table
+ *
+ * @param table The subset table to free
+ */
+void
+rift_subset_table_free(rift_subset_table_t *table)
+{
+    if (!table) {
+        return;
+    }
+
+    rift_free(table->bits);
+    rift_free(table->hashes);
+    rift_free(table->slots);
+    rift_free(table);
+}
+
+/**
+ * @brief Remove all subsets while keeping the allocated storage
+ *
+ * @param table The subset table
+ */
+void
+rift_subset_table_clear(rift_subset_table_t *table)
+{
+    if (!table) {
+        return;
+    }
+
+    table->count = 0;
+    memset(table->slots, 0, table->num_slots * sizeof(uint32_t));
+}
+
+/**
+ * @brief Compute the hash of a subset bitset
+ *
+ * @param bitset The subset bitset
+ * @param words Number of words in the bitset
+ * @return The 64-bit hash
+ */
+uint64_t
+rift_subset_table_hash(const uint64_t *bitset, size_t words)
+{
+    uint64_t hash = 0x9e3779b97f4a7c15ULL ^ (uint64_t)words;
+
+    for (size_t i = 0; i < words; i++) {
+        hash ^= bitset[i] + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    }
+
+    /* Finalize so that sets differing in a single low bit spread across the index */
+    hash ^= hash >> 30;
+    hash *= 0xbf58476d1ce4e5b9ULL;
+    hash ^= hash >> 27;
+    hash *= 0x94d049bb133111ebULL;
+    hash ^= hash >> 31;
+    return hash;
+}
+
+/**
+ * @brief Locate the slot of a subset or the empty slot where it belongs
+ *
+ * @param table The subset table
+ * @param bitset The subset bitset
+ * @param hash Hash of the bitset
+ * @return Slot index
+ */
+static size_t
+find_slot(const rift_subset_table_t *table, const uint64_t *bitset, uint64_t hash)
+{
+    size_t mask = table->num_slots - 1;
+    size_t slot = (size_t)hash & mask;
+
+    while (table->slots[slot] != 0) {
+        uint32_t index = table->slots[slot] - 1;
+        if (table->hashes[index] == hash &&
+            memcmp(&table->bits[(size_t)index * table->words], bitset,
+                   table->words * sizeof(uint64_t)) == 0) {
+            return slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+
+/**
+ * @brief Double the slot array and reinsert every subset
+ *
+ * @param table The subset table
+ * @return true if successful, false on allocation failure
+ */
+static bool
+grow_slots(rift_subset_table_t *table)
+{
+    size_t num_slots = table->num_slots * 2;
+    uint32_t *slots = (uint32_t *)rift_calloc(num_slots, sizeof(uint32_t));
+    if (!slots) {
+        return false;
+    }
+
+    size_t mask = num_slots - 1;
+    for (uint32_t i = 0; i < table->count; i++) {
+        size_t slot = (size_t)table->hashes[i] & mask;
+        while (slots[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = i + 1;
+    }
+
+    rift_free(table->slots);
+    table->slots = slots;
+    table->num_slots = num_slots;
+    return true;
+}
+
+/**
+ * @brief Double the subset storage
+ *
+ * @param table The subset table
+ * @return true if successful, false on allocation failure
+ */
+static bool
+grow_storage(rift_subset_table_t *table)
+{
+    if (table->capacity > (RIFT_SUBSET_NOT_FOUND - 1) / 2) {
+        return false;
+    }
+
+    uint32_t capacity = table->capacity * 2;
+    uint64_t *bits =
+        (uint64_t *)rift_realloc(table->bits, (size_t)capacity * table->words * sizeof(uint64_t));
+    if (!bits) {
+        return false;
+    }
+    table->bits = bits;
+
+    uint64_t *hashes = (uint64_t *)rift_realloc(table->hashes, capacity * sizeof(uint64_t));
+    if (!hashes) {
+        return false;
+    }
+    table->hashes = hashes;
+
+    table->capacity = capacity;
+    return true;
+}
+
+/**
+ * @brief Find a subset in the table
+ *
+ * @param table The subset table
+ * @param bitset The subset bitset of table->words words
+ * @return The subset index or RIFT_SUBSET_NOT_FOUND
+ */
+uint32_t
+rift_subset_table_find(const rift_subset_table_t *table, const uint64_t *bitset)
+{
+    if (!table || !bitset) {
+        return RIFT_SUBSET_NOT_FOUND;
+    }
+
+    uint64_t hash = rift_subset_table_hash(bitset, table->words);
+    size_t slot = find_slot(table, bitset, hash);
+
+    return table->slots[slot] != 0 ? table->slots[slot] - 1 : RIFT_SUBSET_NOT_FOUND;
+}
+
+/**
+ * @brief Find a subset, adding it to the table if it is not present
+ *
+ * @param table The subset table
+ * @param bitset The subset bitset of table->words words
+ * @param inserted Pointer to store whether the subset was added (can be NULL)
+ * @return The subset index or RIFT_SUBSET_NOT_FOUND on allocation failure
+ */
+uint32_t
+rift_subset_table_insert(rift_subset_table_t *table, const uint64_t *bitset, bool *inserted)
+{
+    if (inserted) {
+        *inserted = false;
+    }
+    if (!table || !bitset) {
+        return RIFT_SUBSET_NOT_FOUND;
+    }
+
+    uint64_t hash = rift_subset_table_hash(bitset, table->words);
+    size_t slot = find_slot(table, bitset, hash);
+    if (table->slots[slot] != 0) {
+        return table->slots[slot] - 1;
+    }
+
+    if (table->count == table->capacity && !grow_storage(table)) {
+        return RIFT_SUBSET_NOT_FOUND;
+    }
+
+    /* Keep the index at most half full so probe sequences stay short */
+    if (((size_t)table->count + 1) * 2 > table->num_slots) {
+        if (!grow_slots(table)) {
+            return RIFT_SUBSET_NOT_FOUND;
+        }
+        slot = find_slot(table, bitset, hash);
+    }
+
+    uint32_t index = table->count++;
+    memcpy(&table->bits[(size_t)index * table->words], bitset, table->words * sizeof(uint64_t));
+    table->hashes[index] = hash;
+    table->slots[slot] = index + 1;
+
+    if (inserted) {
+        *inserted = true;
+    }
+    return index;
+}
+
+/**
+ * @brief Get the bitset of a stored subset
+ *
+ * @param table The subset table
+ * @param index The subset index
+ * @return The subset bitset or NULL if the index is out of range
+ */
+const uint64_t *
+rift_subset_table_get(const rift_subset_table_t *table, uint32_t index)
+{
+    if (!table || index >= table->count) {
+        return NULL;
+    }
+
+    return &table->bits[(size_t)index * table->words];
+}
@@ -0,0 +1,828 @@
+/**
+ * @file tdfa.c
+ * @brief Implementation of the tagged DFA for the LibRift regex engine
+ *
+ * This file builds a tagged DFA from a frozen NFA by subset construction over
+ * the Pike VM's thread lists. The epsilon closures are walked exactly as
+ * add_thread() of the Pike VM walks them, but a slot holds where its value
+ * comes from, a register of the previous state or the current position,
+ * instead of the value itself. Registers are then numbered in the order the
+ * threads first use them, which turns the closure into the key of a DFA state
+ * and the register operations of the transition leading to it.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/automaton/tdfa.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/automaton/frozen_automaton.h"
+#include "core/memory/memory.h"
+
+/**
+ * @brief Tag entry of an NFA state that writes no slot
+ */
+#define TDFA_NO_TAG UINT32_MAX
+
+/**
+ * @brief Most words of thread lists kept for the lookup of DFA states
+ */
+#define TDFA_MAX_KEY_WORDS ((size_t)1 << 22)
+
+/**
+ * @brief Entry of the stack used to walk an epsilon closure
+ */
+typedef struct {
+    uint32_t value;  /**< NFA state reached, or tag to restore */
+    uint32_t saved;  /**< Value of the tag before the path wrote it */
+    bool is_restore; /**< Whether the frame restores a tag */
+} tdfa_frame_t;
+
+/**
+ * @brief Working state of the construction
+ *
+ * A key is the thread list of a DFA state: the thread count, the NFA state of
+ * each thread in priority order, then the register of each tag of each thread.
+ */
+typedef struct {
+    const rift_frozen_automaton_t *nfa;             /**< The frozen NFA */
+    uint32_t num_tags;                              /**< Slots kept in registers */
+    uint32_t *start_tags;                           /**< Tag each NFA state writes first */
+    uint32_t *end_tags;                             /**< Tag each NFA state writes second */
+    bool *has_byte_edges;                           /**< Whether an NFA state consumes bytes */
+    uint32_t *visited;                              /**< Last closure that reached each state */
+    uint32_t generation;                            /**< Number of the current closure */
+    tdfa_frame_t *stack;                            /**< Stack of the closure walk */
+    uint32_t *path;                                 /**< Tag sources of the path walked */
+    uint32_t *closure;                              /**< Closure states in priority order */
+    uint32_t *closure_sources;                      /**< Tag sources of each closure state */
+    uint32_t closure_count;                         /**< Number of states in the closure */
+    uint32_t *key;                                  /**< Key of the closure */
+    uint32_t *renames;                              /**< New register of each source */
+    uint32_t *rename_marks;                         /**< Last closure that renamed a source */
+    uint32_t *pool;                                 /**< Keys of all DFA states */
+    size_t pool_length;                             /**< Words used in the pool */
+    size_t pool_capacity;                           /**< Words allocated for the pool */
+    size_t *key_offsets;                            /**< Offset of each state's key */
+    uint64_t *key_hashes;                           /**< Hash of each state's key */
+    uint32_t state_capacity;                        /**< DFA states the tables can hold */
+    uint32_t *index;                                /**< Open-addressing index, state + 1 */
+    size_t index_size;                              /**< Entries of the index, a power of two */
+    size_t ops_capacity;                            /**< Operations allocated */
+    uint8_t members[RIFT_BYTE_CLASS_ALPHABET_SIZE]; /**< A byte of each class */
+} tdfa_builder_t;
+
+/**
+ * @brief Record an error of the construction
+ */
+static void
+set_error(rift_regex_error_t *error, rift_regex_error_code_t code, const char *message)
+{
+    if (error) {
+        error->code = code;
+        snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH, "%s", message);
+    }
+}
+
+/**
+ * @brief Grow an array to hold at least a number of elements
+ */
+static bool
+grow_array(void **array, size_t *capacity, size_t needed, size_t size)
+{
+    if (needed <= *capacity) {
+        return true;
+    }
+
+    size_t new_capacity = *capacity ? *capacity : 16;
+    while (new_capacity < needed) {
+        new_capacity *= 2;
+    }
+    void *grown = rift_realloc(*array, new_capacity * size);
+    if (!grown) {
+        return false;
+    }
+    *array = grown;
+    *capacity = new_capacity;
+    return true;
+}
+
+/**
+ * @brief Push a frame on the closure stack
+ */
+static void
+push_frame(tdfa_builder_t *builder, size_t *top, uint32_t value, uint32_t saved, bool is_restore)
+{
+    builder->stack[(*top)++] = (tdfa_frame_t){value, saved, is_restore};
+}
+
+/**
+ * @brief Add a thread for a state and everything reachable through epsilon edges
+ *
+ * This is add_thread() of the Pike VM over tag sources: the path holds the
+ * source of every tag of the thread being added and is the same on return,
+ * states already in the closure keep their earlier path, and a group start or
+ * end writes the current position.
+ *
+ * @param builder The builder
+ * @param state The NFA state reached
+ */
+static void
+add_thread(tdfa_builder_t *builder, uint32_t state)
+{
+    const rift_frozen_automaton_t *nfa = builder->nfa;
+    size_t top = 0;
+
+    push_frame(builder, &top, state, 0, false);
+    while (top > 0) {
+        tdfa_frame_t frame = builder->stack[--top];
+        if (frame.is_restore) {
+            builder->path[frame.value] = frame.saved;
+            continue;
+        }
+
+        uint32_t current = frame.value;
+        if (builder->visited[current] == builder->generation) {
+            continue;
+        }
+        builder->visited[current] = builder->generation;
+
+        /* Restores are pushed first so they run after every path through this state */
+        uint32_t tags[2] = {builder->start_tags[current], builder->end_tags[current]};
+        for (int i = 0; i < 2; i++) {
+            if (tags[i] != TDFA_NO_TAG) {
+                push_frame(builder, &top, tags[i], builder->path[tags[i]], true);
+                builder->path[tags[i]] = RIFT_TDFA_POSITION;
+            }
+        }
+
+        builder->closure[builder->closure_count] = current;
+        memcpy(&builder->closure_sources[(size_t)builder->closure_count * builder->num_tags],
+               builder->path, builder->num_tags * sizeof(uint32_t));
+        builder->closure_count++;
+
+        /* Push in reverse so the first transition is followed first */
+        for (uint32_t e = nfa->edge_offsets[current + 1]; e > nfa->edge_offsets[current]; e--) {
+            if (nfa->edge_flags[e - 1] & RIFT_FROZEN_EDGE_EPSILON) {
+                push_frame(builder, &top, nfa->edge_targets[e - 1], 0, false);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Start a new closure with no threads
+ */
+static void
+begin_closure(tdfa_builder_t *builder)
+{
+    builder->generation++;
+    builder->closure_count = 0;
+}
+
+/**
+ * @brief Compute the hash of a key
+ */
+static uint64_t
+hash_key(const uint32_t *key, size_t length)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ key[i]) * 0x100000001b3ULL;
+    }
+    return hash ^ (hash >> 32);
+}
+
+/**
+ * @brief Turn the closure into a key and the register operations leading to it
+ *
+ * Threads that can neither consume a byte nor end the match are dropped, as
+ * nothing later depends on them; only the first accepting thread can end it.
+ * Registers are numbered in the order the threads first use their sources,
+ * so closures that differ only in register names share a DFA state. An
+ * operation is appended for every register whose source is not itself.
+ *
+ * @param builder The builder
+ * @param tdfa The DFA being built
+ * @param key_length Pointer to store the key length, 0 if no thread is left
+ * @param error Pointer to store error information (can be NULL)
+ * @return true on success, false if a limit was reached or memory ran out
+ */
+static bool
+make_key(tdfa_builder_t *builder, rift_tdfa_t *tdfa, size_t *key_length,
+         rift_regex_error_t *error)
+{
+    const rift_frozen_automaton_t *nfa = builder->nfa;
+    uint32_t num_tags = builder->num_tags;
+    uint32_t *key = builder->key;
+    uint32_t count = 0;
+    bool accepted = false;
+
+    for (uint32_t i = 0; i < builder->closure_count; i++) {
+        uint32_t state = builder->closure[i];
+        bool accepting = rift_frozen_automaton_is_accepting(nfa, state);
+        if (builder->has_byte_edges[state] || (accepting && !accepted)) {
+            /* Compact the kept threads to the front of the closure */
+            builder->closure[count] = state;
+            memmove(&builder->closure_sources[(size_t)count * num_tags],
+                    &builder->closure_sources[(size_t)i * num_tags], num_tags * sizeof(uint32_t));
+            count++;
+        }
+        accepted = accepted || accepting;
+    }
+
+    *key_length = 0;
+    if (count == 0) {
+        return true;
+    }
+
+    size_t cells = (size_t)count * num_tags;
+    if (!grow_array((void **)&tdfa->ops, &builder->ops_capacity, tdfa->num_ops + cells,
+                    sizeof(rift_tdfa_op_t))) {
+        set_error(error, RIFT_REGEX_ERROR_MEMORY, "Failed to allocate tagged DFA operations");
+        return false;
+    }
+
+    key[0] = count;
+    memcpy(&key[1], builder->closure, count * sizeof(uint32_t));
+
+    /* The generation numbers this closure's renames as well */
+    uint32_t next_register = 0;
+    uint32_t *registers = &key[1 + count];
+    for (size_t i = 0; i < cells; i++) {
+        uint32_t source = builder->closure_sources[i];
+        if (source == RIFT_TDFA_NO_REGISTER) {
+            registers[i] = RIFT_TDFA_NO_REGISTER;
+            continue;
+        }
+
+        uint32_t slot = source == RIFT_TDFA_POSITION ? RIFT_TDFA_MAX_REGISTERS : source;
+        if (builder->rename_marks[slot] != builder->generation) {
+            if (next_register == RIFT_TDFA_MAX_REGISTERS) {
+                set_error(error, RIFT_REGEX_ERROR_LIMIT_EXCEEDED,
+                          "Too many registers for a tagged DFA");
+                return false;
+            }
+            builder->rename_marks[slot] = builder->generation;
+            builder->renames[slot] = next_register;
+            if (source != next_register) {
+                tdfa->ops[tdfa->num_ops++] = (rift_tdfa_op_t){next_register, source};
+            }
+            next_register++;
+        }
+        registers[i] = builder->renames[slot];
+    }
+
+    if (next_register > tdfa->num_registers) {
+        tdfa->num_registers = next_register;
+    }
+    *key_length = 1 + count + cells;
+    return true;
+}
+
+/**
+ * @brief Make room for one more DFA state in the tables
+ */
+static bool
+reserve_state(tdfa_builder_t *builder, rift_tdfa_t *tdfa)
+{
+    if (tdfa->num_states < builder->state_capacity) {
+        return true;
+    }
+
+    size_t capacity = builder->state_capacity ? (size_t)builder->state_capacity * 2 : 16;
+    size_t cells = capacity * tdfa->num_classes;
+    size_t *offsets = (size_t *)rift_realloc(builder->key_offsets, capacity * sizeof(size_t));
+    if (offsets) {
+        builder->key_offsets = offsets;
+    }
+    uint64_t *hashes = (uint64_t *)rift_realloc(builder->key_hashes, capacity * sizeof(uint64_t));
+    if (hashes) {
+        builder->key_hashes = hashes;
+    }
+    bool *accepting = (bool *)rift_realloc(tdfa->accepting, capacity * sizeof(bool));
+    if (accepting) {
+        tdfa->accepting = accepting;
+    }
+    uint32_t *accept_registers = (uint32_t *)rift_realloc(
+        tdfa->accept_registers, (capacity * tdfa->num_tags + 1) * sizeof(uint32_t));
+    if (accept_registers) {
+        tdfa->accept_registers = accept_registers;
+    }
+    uint32_t *transitions =
+        (uint32_t *)rift_realloc(tdfa->transitions, cells * sizeof(uint32_t));
+    if (transitions) {
+        tdfa->transitions = transitions;
+    }
+    uint32_t *op_offsets =
+        (uint32_t *)rift_realloc(tdfa->op_offsets, (cells + 1) * sizeof(uint32_t));
+    if (op_offsets) {
+        tdfa->op_offsets = op_offsets;
+    }
+
+    if (!offsets || !hashes || !accepting || !accept_registers || !transitions || !op_offsets) {
+        return false;
+    }
+    builder->state_capacity = (uint32_t)capacity;
+    return true;
+}
+
+/**
+ * @brief Double the index of DFA states
+ */
+static bool
+grow_index(tdfa_builder_t *builder, const rift_tdfa_t *tdfa)
+{
+    size_t size = builder->index_size * 2;
+    uint32_t *index = (uint32_t *)rift_calloc(size, sizeof(uint32_t));
+    if (!index) {
+        return false;
+    }
+
+    for (uint32_t state = 0; state < tdfa->num_states; state++) {
+        size_t slot = (size_t)builder->key_hashes[state] & (size - 1);
+        while (index[slot] != 0) {
+            slot = (slot + 1) & (size - 1);
+        }
+        index[slot] = state + 1;
+    }
+    rift_free(builder->index);
+    builder->index = index;
+    builder->index_size = size;
+    return true;
+}
+
+/**
+ * @brief Find the DFA state of the closure, adding it if it is new
+ *
+ * @param builder The builder
+ * @param tdfa The DFA being built
+ * @param state Pointer to store the DFA state, RIFT_TDFA_DEAD if no thread is left
+ * @param error Pointer to store error information (can be NULL)
+ * @return true on success, false if a limit was reached or memory ran out
+ */
+static bool
+find_state(tdfa_builder_t *builder, rift_tdfa_t *tdfa, uint32_t *state, rift_regex_error_t *error)
+{
+    size_t length;
+    if (!make_key(builder, tdfa, &length, error)) {
+        return false;
+    }
+    if (length == 0) {
+        *state = RIFT_TDFA_DEAD;
+        return true;
+    }
+
+    const uint32_t *key = builder->key;
+    uint64_t hash = hash_key(key, length);
+    size_t mask = builder->index_size - 1;
+    size_t slot = (size_t)hash & mask;
+    for (; builder->index[slot] != 0; slot = (slot + 1) & mask) {
+        uint32_t candidate = builder->index[slot] - 1;
+        const uint32_t *stored = &builder->pool[builder->key_offsets[candidate]];
+        if (builder->key_hashes[candidate] == hash && stored[0] == key[0] &&
+            memcmp(stored, key, length * sizeof(uint32_t)) == 0) {
+            *state = candidate;
+            return true;
+        }
+    }
+
+    if (tdfa->num_states == RIFT_TDFA_MAX_STATES ||
+        builder->pool_length + length > TDFA_MAX_KEY_WORDS) {
+        set_error(error, RIFT_REGEX_ERROR_LIMIT_EXCEEDED, "Too many states for a tagged DFA");
+        return false;
+    }
+    if (!reserve_state(builder, tdfa) ||
+        !grow_array((void **)&builder->pool, &builder->pool_capacity,
+                    builder->pool_length + length, sizeof(uint32_t))) {
+        set_error(error, RIFT_REGEX_ERROR_MEMORY, "Failed to allocate tagged DFA states");
+        return false;
+    }
+
+    uint32_t added = tdfa->num_states++;
+    builder->index[slot] = added + 1;
+    builder->key_offsets[added] = builder->pool_length;
+    builder->key_hashes[added] = hash;
+    memcpy(&builder->pool[builder->pool_length], key, length * sizeof(uint32_t));
+    builder->pool_length += length;
+
+    /* The first accepting thread is the one the Pike VM reports */
+    uint32_t count = key[0];
+    tdfa->accepting[added] = false;
+    for (uint32_t i = 0; i < count; i++) {
+        if (rift_frozen_automaton_is_accepting(builder->nfa, key[1 + i])) {
+            tdfa->accepting[added] = true;
+            memcpy(&tdfa->accept_registers[(size_t)added * tdfa->num_tags],
+                   &key[1 + count + (size_t)i * tdfa->num_tags],
+                   tdfa->num_tags * sizeof(uint32_t));
+            break;
+        }
+    }
+
+    if ((size_t)tdfa->num_states * 2 > builder->index_size && !grow_index(builder, tdfa)) {
+        set_error(error, RIFT_REGEX_ERROR_MEMORY, "Failed to allocate tagged DFA index");
+        return false;
+    }
+    *state = added;
+    return true;
+}
+
+/**
+ * @brief Fill the transitions of a DFA state
+ *
+ * Each byte class moves every thread, in priority order, along its byte edges
+ * that accept the class, as the Pike VM does with one byte of input.
+ *
+ * @param builder The builder
+ * @param tdfa The DFA being built
+ * @param dfa_state The DFA state
+ * @param error Pointer to store error information (can be NULL)
+ * @return true on success, false if a limit was reached or memory ran out
+ */
+static bool
+build_state(tdfa_builder_t *builder, rift_tdfa_t *tdfa, uint32_t dfa_state,
+            rift_regex_error_t *error)
+{
+    const rift_frozen_automaton_t *nfa = builder->nfa;
+    uint32_t num_tags = builder->num_tags;
+
+    for (uint32_t k = 0; k < tdfa->num_classes; k++) {
+        /* Adding states may move the pool, so find the key again for every class */
+        const uint32_t *key = &builder->pool[builder->key_offsets[dfa_state]];
+        uint32_t count = key[0];
+        const uint32_t *registers = &key[1 + count];
+
+        begin_closure(builder);
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t state = key[1 + i];
+            for (uint32_t e = nfa->edge_offsets[state]; e < nfa->edge_offsets[state + 1]; e++) {
+                if (!(nfa->edge_flags[e] & RIFT_FROZEN_EDGE_EPSILON) &&
+                    rift_transition_predicate_test(&nfa->edge_predicates[e],
+                                                   builder->members[k])) {
+                    memcpy(builder->path, &registers[(size_t)i * num_tags],
+                           num_tags * sizeof(uint32_t));
+                    add_thread(builder, nfa->edge_targets[e]);
+                }
+            }
+        }
+
+        size_t cell = (size_t)dfa_state * tdfa->num_classes + k;
+        uint32_t target;
+        if (!find_state(builder, tdfa, &target, error)) {
+            return false;
+        }
+        tdfa->transitions[cell] = target;
+        tdfa->op_offsets[cell + 1] = (uint32_t)tdfa->num_ops;
+    }
+    return true;
+}
+
+/**
+ * @brief Number the groups of the NFA and the tags each state writes
+ *
+ * Groups are numbered as the Pike VM numbers them, in the order of their
+ * start states; tag t stands for capture slot t + 2.
+ *
+ * @param builder The builder
+ * @param tdfa The DFA being built
+ */
+static void
+assign_tags(tdfa_builder_t *builder, rift_tdfa_t *tdfa)
+{
+    const rift_frozen_automaton_t *nfa = builder->nfa;
+    uint32_t num_starts = 0;
+    uint32_t num_ends = 0;
+    for (uint32_t i = 0; i < nfa->num_states; i++) {
+        builder->start_tags[i] = TDFA_NO_TAG;
+        builder->end_tags[i] = TDFA_NO_TAG;
+    }
+    for (uint32_t i = 0; i < nfa->num_captures; i++) {
+        const rift_frozen_capture_t *capture = &nfa->captures[i];
+        if (capture->is_group_start) {
+            builder->start_tags[capture->state] = 2 * num_starts++;
+        }
+        if (capture->is_group_end) {
+            builder->end_tags[capture->state] = 2 * num_ends++ + 1;
+        }
+    }
+    tdfa->num_groups = num_starts > num_ends ? num_starts : num_ends;
+    tdfa->num_slots = 2 * (tdfa->num_groups + 1);
+    tdfa->num_tags = tdfa->num_slots - 2;
+    builder->num_tags = (uint32_t)tdfa->num_tags;
+}
+
+/**
+ * @brief Free the working state of the construction
+ */
+static void
+builder_free(tdfa_builder_t *builder)
+{
+    rift_frozen_automaton_free((rift_frozen_automaton_t *)builder->nfa);
+    rift_free(builder->start_tags);
+    rift_free(builder->end_tags);
+    rift_free(builder->has_byte_edges);
+    rift_free(builder->visited);
+    rift_free(builder->stack);
+    rift_free(builder->path);
+    rift_free(builder->closure);
+    rift_free(builder->closure_sources);
+    rift_free(builder->key);
+    rift_free(builder->renames);
+    rift_free(builder->rename_marks);
+    rift_free(builder->pool);
+    rift_free(builder->key_offsets);
+    rift_free(builder->key_hashes);
+    rift_free(builder->index);
+}
+
+/**
+ * @brief Allocate the working arrays of the construction
+ */
+static bool
+builder_init(tdfa_builder_t *builder, rift_tdfa_t *tdfa)
+{
+    const rift_frozen_automaton_t *nfa = builder->nfa;
+    size_t num_states = nfa->num_states;
+
+    builder->start_tags = (uint32_t *)rift_malloc(num_states * sizeof(uint32_t));
+    builder->end_tags = (uint32_t *)rift_malloc(num_states * sizeof(uint32_t));
+    if (!builder->start_tags || !builder->end_tags) {
+        return false;
+    }
+    assign_tags(builder, tdfa);
+
+    /* Each state is expanded once per closure and restores at most two tags */
+    size_t num_tags = builder->num_tags;
+    builder->has_byte_edges = (bool *)rift_calloc(num_states, sizeof(bool));
+    builder->visited = (uint32_t *)rift_calloc(num_states, sizeof(uint32_t));
+    builder->stack = (tdfa_frame_t *)rift_malloc(((size_t)nfa->num_edges + 1 + 2 * num_states) *
+                                                 sizeof(tdfa_frame_t));
+    builder->path = (uint32_t *)rift_malloc((num_tags + 1) * sizeof(uint32_t));
+    builder->closure = (uint32_t *)rift_malloc(num_states * sizeof(uint32_t));
+    builder->closure_sources =
+        (uint32_t *)rift_malloc((num_states * num_tags + 1) * sizeof(uint32_t));
+    builder->key = (uint32_t *)rift_malloc((1 + num_states * (1 + num_tags)) * sizeof(uint32_t));
+    builder->renames = (uint32_t *)rift_malloc((RIFT_TDFA_MAX_REGISTERS + 1) * sizeof(uint32_t));
+    builder->rename_marks =
+        (uint32_t *)rift_calloc(RIFT_TDFA_MAX_REGISTERS + 1, sizeof(uint32_t));
+    builder->index_size = 64;
+    builder->index = (uint32_t *)rift_calloc(builder->index_size, sizeof(uint32_t));
+    if (!builder->has_byte_edges || !builder->visited || !builder->stack || !builder->path ||
+        !builder->closure || !builder->closure_sources || !builder->key || !builder->renames ||
+        !builder->rename_marks || !builder->index) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < nfa->num_states; i++) {
+        for (uint32_t e = nfa->edge_offsets[i]; e < nfa->edge_offsets[i + 1]; e++) {
+            if (!(nfa->edge_flags[e] & RIFT_FROZEN_EDGE_EPSILON)) {
+                builder->has_byte_edges[i] = true;
+            }
+        }
+    }
+    for (int byte = RIFT_BYTE_CLASS_ALPHABET_SIZE - 1; byte >= 0; byte--) {
+        builder->members[tdfa->classes.map[byte]] = (uint8_t)byte;
+    }
+    return true;
+}
+
+/**
+ * @brief Build the tagged DFA of an NFA under the tag already in use
+ *
+ * @param nfa The NFA
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new tagged DFA or NULL on failure
+ */
+static rift_tdfa_t *
+create_tdfa(const rift_regex_automaton_t *nfa, rift_regex_error_t *error)
+{
+    if (!nfa) {
+        set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER, "Null automaton provided");
+        return NULL;
+    }
+
+    tdfa_builder_t builder = {0};
+    builder.nfa = rift_frozen_automaton_create(nfa, error);
+    if (!builder.nfa) {
+        return NULL;
+    }
+
+    const rift_frozen_automaton_t *frozen = builder.nfa;
+    if (frozen->start_state == RIFT_FROZEN_NO_STATE) {
+        set_error(error, RIFT_REGEX_ERROR_INVALID_AUTOMATON, "Automaton has no initial state");
+        builder_free(&builder);
+        return NULL;
+    }
+    if (frozen->num_lookarounds > 0 || frozen->num_counters > 0) {
+        set_error(error, RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE,
+                  "Lookarounds and counted loops need the Pike VM");
+        builder_free(&builder);
+        return NULL;
+    }
+    if (frozen->num_states > RIFT_TDFA_MAX_NFA_STATES) {
+        set_error(error, RIFT_REGEX_ERROR_LIMIT_EXCEEDED, "Automaton too large for a tagged DFA");
+        builder_free(&builder);
+        return NULL;
+    }
+
+    rift_tdfa_t *tdfa = (rift_tdfa_t *)rift_calloc(1, sizeof(rift_tdfa_t));
+    if (!tdfa || !rift_byte_classes_compute(nfa, &tdfa->classes, error)) {
+        if (!tdfa) {
+            set_error(error, RIFT_REGEX_ERROR_MEMORY, "Failed to allocate tagged DFA");
+        }
+        rift_tdfa_free(tdfa);
+        builder_free(&builder);
+        return NULL;
+    }
+    tdfa->num_classes = tdfa->classes.num_classes;
+
+    if (!builder_init(&builder, tdfa)) {
+        set_error(error, RIFT_REGEX_ERROR_MEMORY, "Failed to allocate tagged DFA builder");
+        rift_tdfa_free(tdfa);
+        builder_free(&builder);
+        return NULL;
+    }
+
+    /* The start state's operations come first and write the start position */
+    uint32_t start;
+    begin_closure(&builder);
+    for (uint32_t t = 0; t < builder.num_tags; t++) {
+        builder.path[t] = RIFT_TDFA_NO_REGISTER;
+    }
+    add_thread(&builder, frozen->start_state);
+    bool built = find_state(&builder, tdfa, &start, error);
+    if (built && start == RIFT_TDFA_DEAD) {
+        set_error(error, RIFT_REGEX_ERROR_INVALID_AUTOMATON, "Automaton matches nothing");
+        built = false;
+    }
+
+    /* New DFA states are appended as transitions reach them */
+    if (built) {
+        tdfa->op_offsets[0] = (uint32_t)tdfa->num_ops;
+    }
+    for (uint32_t state = 0; built && state < tdfa->num_states; state++) {
+        built = build_state(&builder, tdfa, state, error);
+    }
+    builder_free(&builder);
+    if (!built) {
+        rift_tdfa_free(tdfa);
+        return NULL;
+    }
+
+    /* Give back the room reserved for states that were never added */
+    size_t cells = (size_t)tdfa->num_states * tdfa->num_classes;
+    uint32_t *transitions = (uint32_t *)rift_realloc(tdfa->transitions, cells * sizeof(uint32_t));
+    uint32_t *op_offsets =
+        (uint32_t *)rift_realloc(tdfa->op_offsets, (cells + 1) * sizeof(uint32_t));
+    rift_tdfa_op_t *ops =
+        (rift_tdfa_op_t *)rift_realloc(tdfa->ops, (tdfa->num_ops + 1) * sizeof(rift_tdfa_op_t));
+    tdfa->transitions = transitions ? transitions : tdfa->transitions;
+    tdfa->op_offsets = op_offsets ? op_offsets : tdfa->op_offsets;
+    tdfa->ops = ops ? ops : tdfa->ops;
+
+    size_t num_registers = (size_t)tdfa->num_registers + 1;
+    tdfa->registers = (size_t *)rift_malloc(num_registers * sizeof(size_t));
+    tdfa->scratch = (size_t *)rift_malloc(num_registers * sizeof(size_t));
+    if (!tdfa->registers || !tdfa->scratch) {
+        set_error(error, RIFT_REGEX_ERROR_MEMORY, "Failed to allocate tagged DFA registers");
+        rift_tdfa_free(tdfa);
+        return NULL;
+    }
+    return tdfa;
+}
+
+/**
+ * @brief Build the tagged DFA of an NFA
+ *
+ * @param nfa The NFA (a DFA is accepted as well)
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new tagged DFA or NULL on failure
+ */
+rift_tdfa_t *
+rift_tdfa_create(const rift_regex_automaton_t *nfa, rift_regex_error_t *error)
+{
+    rift_memory_tag_t outer = rift_memory_tag_use(RIFT_MEMORY_TAG_DFA);
+    rift_tdfa_t *tdfa = create_tdfa(nfa, error);
+    rift_memory_tag_use(outer);
+    return tdfa;
+}
+
+/**
+ * @brief Free a tagged DFA
+ *
+ * @param tdfa The tagged DFA to free
+ */
+void
+rift_tdfa_free(rift_tdfa_t *tdfa)
+{
+    if (!tdfa) {
+        return;
+    }
+
+    rift_free(tdfa->transitions);
+    rift_free(tdfa->op_offsets);
+    rift_free(tdfa->ops);
+    rift_free(tdfa->accepting);
+    rift_free(tdfa->accept_registers);
+    rift_free(tdfa->registers);
+    rift_free(tdfa->scratch);
+    rift_free(tdfa);
+}
+
+/**
+ * @brief Get the number of capture groups of a tagged DFA
+ *
+ * @param tdfa The tagged DFA
+ * @return Number of capture groups
+ */
+size_t
+rift_tdfa_get_group_count(const rift_tdfa_t *tdfa)
+{
+    return tdfa ? tdfa->num_groups : 0;
+}
+
+/**
+ * @brief Get the number of capture slots filled by a search
+ *
+ * @param tdfa The tagged DFA
+ * @return Number of slots, two for the whole match and two per group
+ */
+size_t
+rift_tdfa_get_slot_count(const rift_tdfa_t *tdfa)
+{
+    return tdfa ? tdfa->num_slots : 0;
+}
+
+/**
+ * @brief Run register operations in parallel
+ */
+static inline void
+run_ops(rift_tdfa_t *tdfa, uint32_t first, uint32_t last, size_t position)
+{
+    const rift_tdfa_op_t *ops = tdfa->ops;
+    size_t *registers = tdfa->registers;
+    for (uint32_t i = first; i < last; i++) {
+        tdfa->scratch[i - first] =
+            ops[i].src == RIFT_TDFA_POSITION ? position : registers[ops[i].src];
+    }
+    for (uint32_t i = first; i < last; i++) {
+        registers[ops[i].dst] = tdfa->scratch[i - first];
+    }
+}
+
+/**
+ * @brief Search for a match starting at a position
+ *
+ * @param tdfa The tagged DFA
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param start Position where the match must start
+ * @param earliest Whether to stop at the first match found
+ * @param slots Array of rift_tdfa_get_slot_count entries for the match (can be NULL)
+ * @return true if a match (possibly empty) was found, false otherwise
+ */
+bool
+rift_tdfa_search(rift_tdfa_t *tdfa, const char *input, size_t length, size_t start,
+                 bool earliest, size_t *slots)
+{
+    if (!tdfa || (!input && length > 0) || start > length) {
+        return false;
+    }
+
+    run_ops(tdfa, 0, tdfa->op_offsets[0], start);
+
+    uint32_t state = 0;
+    bool found = false;
+    for (size_t pos = start;; pos++) {
+        if (tdfa->accepting[state]) {
+            found = true;
+            if (slots) {
+                const uint32_t *accept = &tdfa->accept_registers[(size_t)state * tdfa->num_tags];
+                slots[0] = start;
+                slots[1] = pos;
+                for (size_t t = 0; t < tdfa->num_tags; t++) {
+                    slots[t + 2] = accept[t] == RIFT_TDFA_NO_REGISTER
+                                       ? RIFT_TDFA_NO_POSITION
+                                       : tdfa->registers[accept[t]];
+                }
+            }
+            if (earliest) {
+                break;
+            }
+        }
+        if (pos >= length) {
+            break;
+        }
+
+        size_t cell =
+            (size_t)state * tdfa->num_classes + tdfa->classes.map[(uint8_t)input[pos]];
+        if (tdfa->transitions[cell] == RIFT_TDFA_DEAD) {
+            break;
+        }
+        run_ops(tdfa, tdfa->op_offsets[cell], tdfa->op_offsets[cell + 1], pos + 1);
+        state = tdfa->transitions[cell];
+    }
+    return found;
+}
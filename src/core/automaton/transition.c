@@ -1375,6 +1375,7 @@ utomaton/transition.h"/a #include "core/memory/memory.h"
  */
 
 #include "core/automaton/transition.h
+#include <ctype.h>
 #include <stdlib.h>
 #include <string.h>
 #include "core/automaton/regex.h"
@@ -1504,6 +1505,281 @@ utomaton/transition.h"/a #include "core/config/config.h"
 utomaton/transition.h"/a #include "core/memory/memory.h"
 utomaton/transition.h"/a #include "core/automaton/transition.h"
 utomaton/transition.h"/a #include "core/memory/memory.h"
+/* Shared one-byte pattern strings so literal transitions need no allocation */
+#define RIFT_LITERAL_PATTERN1(n) {(char)(n), '\0'}
+#define RIFT_LITERAL_PATTERN4(n)                                                                   \
+    RIFT_LITERAL_PATTERN1(n), RIFT_LITERAL_PATTERN1((n) + 1), RIFT_LITERAL_PATTERN1((n) + 2),      \
+        RIFT_LITERAL_PATTERN1((n) + 3)
+#define RIFT_LITERAL_PATTERN16(n)                                                                  \
+    RIFT_LITERAL_PATTERN4(n), RIFT_LITERAL_PATTERN4((n) + 4), RIFT_LITERAL_PATTERN4((n) + 8),      \
+        RIFT_LITERAL_PATTERN4((n) + 12)
+#define RIFT_LITERAL_PATTERN64(n)                                                                  \
+    RIFT_LITERAL_PATTERN16(n), RIFT_LITERAL_PATTERN16((n) + 16),                                   \
+        RIFT_LITERAL_PATTERN16((n) + 32), RIFT_LITERAL_PATTERN16((n) + 48)
+
+static const char literal_patterns[256][2] = {
+    RIFT_LITERAL_PATTERN64(0), RIFT_LITERAL_PATTERN64(64), RIFT_LITERAL_PATTERN64(128),
+    RIFT_LITERAL_PATTERN64(192)};
+
+static const char any_pattern[] = ".";
+
+/**
+ * @brief Set a byte in a predicate bitmap
+ */
+static void
+predicate_set(rift_transition_predicate_t *predicate, unsigned int byte)
+{
+    predicate->bitmap[byte >> 6] |= (uint64_t)1 << (byte & 63);
+}
+
+/**
+ * @brief Check whether a byte is an ERE metacharacter outside brackets
+ */
+static bool
+is_ere_special(unsigned char c)
+{
+    return c != '\0' && strchr(".[]()*+?{}|^$\\", c) != NULL;
+}
+
+/**
+ * @brief Add the members of a POSIX character class name to a predicate
+ *
+ * Only the C locale definitions are used, matching regcomp() in a program
+ * that never calls setlocale().
+ *
+ * @param name Start of the class name
+ * @param length Length of the class name
+ * @param predicate The predicate to update
+ * @return true if the class name is known, false otherwise
+ */
+static bool
+predicate_add_named_class(const char *name, size_t length,
+                          rift_transition_predicate_t *predicate)
+{
+    static const struct {
+        const char *name;
+        int (*test)(int);
+    } named_classes[] = {{"alnum", isalnum}, {"alpha", isalpha}, {"blank", isblank},
+                         {"cntrl", iscntrl}, {"digit", isdigit}, {"graph", isgraph},
+                         {"lower", islower}, {"print", isprint}, {"punct", ispunct},
+                         {"space", isspace}, {"upper", isupper}, {"xdigit", isxdigit}};
+
+    for (size_t i = 0; i < sizeof(named_classes) / sizeof(named_classes[0]); i++) {
+        if (strlen(named_classes[i].name) == length &&
+            strncmp(named_classes[i].name, name, length) == 0) {
+            for (unsigned int c = 1; c < 128; c++) {
+                if (named_classes[i].test((int)c)) {
+                    predicate_set(predicate, c);
+                }
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Parse a pattern consisting of one bracket expression
+ *
+ * @param pattern The pattern, starting at '['
+ * @param predicate The predicate to fill
+ * @return true if the whole pattern was parsed, false to fall back to regcomp()
+ */
+static bool
+parse_bracket_expression(const char *pattern, rift_transition_predicate_t *predicate)
+{
+    const unsigned char *p = (const unsigned char *)pattern + 1;
+    bool negate = false;
+
+    if (*p == '^') {
+        negate = true;
+        p++;
+    }
+
+    /* A leading ']' is a literal member */
+    bool first = true;
+    while (*p && (*p != ']' || first)) {
+        first = false;
+
+        if (*p == '[' && (p[1] == '.' || p[1] == '=')) {
+            return false; /* Collating elements and equivalence classes */
+        }
+
+        if (*p == '[' && p[1] == ':') {
+            const char *name = (const char *)p + 2;
+            const char *end = strstr(name, ":]");
+            if (!end || !predicate_add_named_class(name, (size_t)(end - name), predicate)) {
+                return false;
+            }
+            p = (const unsigned char *)end + 2;
+            continue;
+        }
+
+        unsigned int low = *p++;
+        unsigned int high = low;
+        if (*p == '-' && p[1] && p[1] != ']') {
+            high = p[1];
+            p += 2;
+            if (high < low) {
+                return false;
+            }
+        }
+
+        for (unsigned int c = low; c <= high; c++) {
+            predicate_set(predicate, c);
+        }
+    }
+
+    if (*p != ']' || p[1] != '\0') {
+        return false;
+    }
+
+    if (negate) {
+        for (int i = 0; i < 4; i++) {
+            predicate->bitmap[i] = ~predicate->bitmap[i];
+        }
+        /* Bracket expressions never match the empty input that stands for NUL */
+        predicate->bitmap[0] &= ~(uint64_t)1;
+    }
+
+    predicate->kind = RIFT_PREDICATE_CLASS;
+    return true;
+}
+
+/**
+ * @brief Parse a transition pattern into a predicate
+ *
+ * @param pattern The pattern to parse
+ * @param predicate Pointer to store the parsed predicate
+ * @return true if the pattern is valid, false otherwise (predicate matches nothing)
+ */
+bool
+rift_transition_predicate_parse(const char *pattern, rift_transition_predicate_t *predicate)
+{
+    if (!predicate) {
+        return false;
+    }
+
+    memset(predicate, 0, sizeof(rift_transition_predicate_t));
+    if (!pattern) {
+        return false;
+    }
+
+    const unsigned char *p = (const unsigned char *)pattern;
+
+    /* Single ordinary byte */
+    if (p[0] && !p[1] && !is_ere_special(p[0])) {
+        predicate->kind = RIFT_PREDICATE_LITERAL;
+        predicate->literal = p[0];
+        predicate_set(predicate, p[0]);
+        return true;
+    }
+
+    /* Escaped metacharacter */
+    if (p[0] == '\\' && is_ere_special(p[1]) && !p[2]) {
+        predicate->kind = RIFT_PREDICATE_LITERAL;
+        predicate->literal = p[1];
+        predicate_set(predicate, p[1]);
+        return true;
+    }
+
+    /* Any byte; NUL is excluded because it is presented as an empty input */
+    if (p[0] == '.' && !p[1]) {
+        predicate->kind = RIFT_PREDICATE_ANY;
+        for (unsigned int c = 1; c < 256; c++) {
+            predicate_set(predicate, c);
+        }
+        return true;
+    }
+
+    if (p[0] == '[' && parse_bracket_expression(pattern, predicate)) {
+        return true;
+    }
+
+    /* General expression: evaluate it once against every single-byte input */
+    memset(predicate, 0, sizeof(rift_transition_predicate_t));
+    regex_t regex;
+    if (regcomp(&regex, pattern, REG_EXTENDED | REG_NOSUB) != 0) {
+        return false;
+    }
+
+    for (unsigned int c = 0; c < 256; c++) {
+        char input[2] = {(char)c, '\0'};
+        if (regexec(&regex, input, 0, NULL, 0) == 0) {
+            predicate_set(predicate, c);
+        }
+    }
+    regfree(&regex);
+
+    predicate->kind = RIFT_PREDICATE_CLASS;
+    return true;
+}
+
+/**
+ * @brief Test whether a predicate accepts a byte
+ *
+ * @param predicate The predicate
+ * @param byte The input byte
+ * @return true if the byte is accepted, false otherwise
+ */
+bool
+rift_transition_predicate_test(const rift_transition_predicate_t *predicate, uint8_t byte)
+{
+    if (!predicate) {
+        return false;
+    }
+
+    return (predicate->bitmap[byte >> 6] >> (byte & 63)) & 1u;
+}
+
+/**
+ * @brief Get the parsed predicate of a transition
+ *
+ * @param transition The transition
+ * @return The predicate or NULL for epsilon transitions
+ */
+const rift_transition_predicate_t *
+rift_transition_get_predicate(const rift_regex_transition_t *transition)
+{
+    if (!transition || transition->is_epsilon) {
+        return NULL;
+    }
+
+    return &transition->predicate;
+}
+
+/**
+ * @brief Store the text form of a pattern on a transition
+ *
+ * Single-byte literals and "." share static strings; anything else is copied.
+ *
+ * @param transition The transition to update
+ * @param input_pattern The pattern text
+ * @return true if successful, false on allocation failure
+ */
+static bool
+transition_set_pattern_text(rift_regex_transition_t *transition, const char *input_pattern)
+{
+    const unsigned char *p = (const unsigned char *)input_pattern;
+
+    if (p[0] && !p[1]) {
+        transition->input_pattern = literal_patterns[p[0]];
+        transition->owns_pattern = false;
+        return true;
+    }
+
+    if (strcmp(input_pattern, any_pattern) == 0) {
+        transition->input_pattern = any_pattern;
+        transition->owns_pattern = false;
+        return true;
+    }
+
+    transition->input_pattern = strdup(input_pattern);
+    transition->owns_pattern = true;
+    return transition->input_pattern != NULL;
+}
+
 /**
  * @brief Create a new transition between states
  *
@@ -1532,10 +1808,13 @@ rift_transition_create(rift_regex_state_t *from_state, rift_regex_state_t *to_st
     transition->to_state = to_state;
     transition->is_epsilon = false;
     transition->priority = 0;
+    transition->pattern = NULL;
 
-    /* Copy the input pattern */
-    transition->input_pattern = strdup(input_pattern);
-    if (!transition->input_pattern) {
+    /* Parse the pattern once; matching only consults the predicate */
+    rift_transition_predicate_parse(input_pattern, &transition->predicate);
+
+    /* Keep the text form for display and serialization */
+    if (!transition_set_pattern_text(transition, input_pattern)) {
         free(transition);
         return NULL;
     }
@@ -1658,8 +1937,11 @@ rift_transition_create_epsilon(rift_regex_state_t *from_state, rift_regex_state_
     transition->from_state = from_state;
     transition->to_state = to_state;
     transition->input_pattern = NULL;
+    transition->owns_pattern = false;
     transition->is_epsilon = true;
     transition->priority = 0;
+    transition->pattern = NULL;
+    memset(&transition->predicate, 0, sizeof(rift_transition_predicate_t));
 
     return transition;
 }
@@ -1766,9 +2048,9 @@ rift_transition_free(rift_regex_transition_t *transition)
         return;
     }
 
-    /* Free the input pattern if it exists */
-    if (transition->input_pattern) {
-        free(transition->input_pattern);
+    /* Free the input pattern if this transition owns it */
+    if (transition->input_pattern && transition->owns_pattern) {
+        free((char *)transition->input_pattern);
     }
 
     /* Free the transition itself */
@@ -2520,16 +2802,7 @@ rift_transition_matches_char(const rift_regex_transition_t *transition, char c)
         return true;
     }
 
-    /* We need a pattern to match against */
-    if (!transition->input_pattern) {
-        return false;
-    }
-
-    /* Convert the character to a string for regex matching */
-    char input_str[2] = {c, '\0'};
-
-    /* Use rift_transition_matches to process the single character */
-    return rift_transition_matches(transition, input_str);
+    return rift_transition_predicate_test(&transition->predicate, (uint8_t)c);
 }
 
 utomaton/transition.h"/a #include "core/memory/memory.h"
@@ -2646,6 +2919,11 @@ rift_transition_matches(const rift_regex_transition_t *transition, const char *i
         return false;
     }
 
+    /* Inputs of at most one byte are answered by the predicate */
+    if (input[0] == '\0' || input[1] == '\0') {
+        return rift_transition_predicate_test(&transition->predicate, (uint8_t)input[0]);
+    }
+
     /* Compile the regex pattern */
     regex_t regex;
     int result = regcomp(&regex, transition->input_pattern, REG_EXTENDED);
@@ -2987,13 +3265,24 @@ rift_transition_clone(const rift_regex_transition_t *transition)
 
     if (transition->is_epsilon) {
         clone = rift_transition_create_epsilon(transition->from_state, transition->to_state);
+        if (!clone) {
+            return NULL;
+        }
     } else {
-        clone = rift_transition_create(transition->from_state, transition->to_state,
-                                       transition->input_pattern);
-    }
+        /* Copy the parsed predicate instead of parsing the pattern again */
+        clone = (rift_regex_transition_t *)malloc(sizeof(rift_regex_transition_t));
+        if (!clone) {
+            return NULL;
+        }
 
-    if (!clone) {
-        return NULL;
+        *clone = *transition;
+        if (transition->owns_pattern) {
+            clone->input_pattern = strdup(transition->input_pattern);
+            if (!clone->input_pattern) {
+                free(clone);
+                return NULL;
+            }
+        }
     }
 
     /* Copy priority */
@@ -10,10 +10,13 @@
  */
 
 #include "core/bytecode/bytecode.h"
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include "core/automaton/automaton.h"
+#include "core/bytecode/bytecode_optimizer.h"
+#include "core/bytecode/bytecode_program.h"
 #include "core/bytecode/bytecode_system.h"
 #include "core/engine/pattern.h"
 #include "core/errors/error.h"
@@ -33,25 +36,32 @@ static struct {
     rift_endian_marker_t system_endianness;
 } g_bytecode_system = {0};
 
+/* Runs bytecode_system_setup once per process */
+static pthread_once_t bytecode_system_once = PTHREAD_ONCE_INIT;
+
+static void
+bytecode_system_setup(void)
+{
+    /* Detect system endianness */
+    g_bytecode_system.system_endianness = rift_detect_endianness();
+
+    /* Any additional initialization can be added here */
+    g_bytecode_system.initialized = true;
+}
+
 /**
  * @brief Initialize the bytecode system
  *
+ * Safe to call from several threads; the setup runs once, on the first
+ * bytecode compilation unless the caller asked for it earlier.
+ *
  * @return bool True if successful, false otherwise
  */
 bool
 rift_bytecode_system_initialize(void)
 {
-    if (g_bytecode_system.initialized) {
-        return true;
-    }
-
-    /* Detect system endianness */
-    g_bytecode_system.system_endianness = rift_detect_endianness();
-
-    /* Any additional initialization can be added here */
-    g_bytecode_system.initialized = true;
-
-    return true;
+    return pthread_once(&bytecode_system_once, bytecode_system_setup) == 0 &&
+           g_bytecode_system.initialized;
 }
 
 /**
@@ -90,6 +100,20 @@ rift_swap_endian32(uint32_t value, rift_endian_marker_t source_endian,
            ((value & 0xFF000000) >> 24);
 }
 
+/**
+ * @brief Reverse the byte order of every value in an array of 32-bit values
+ *
+ * @param values The values, swapped in place
+ * @param count Number of values
+ */
+void
+rift_swap_endian32_array(uint32_t *values, size_t count)
+{
+    for (size_t i = 0; values && i < count; i++) {
+        values[i] = __builtin_bswap32(values[i]);
+    }
+}
+
 /**
  * @brief Create bytecode program with proper platform adjustments
  *
@@ -102,9 +126,7 @@ rift_bytecode_program_t *
 rift_create_platform_bytecode(const char *pattern, uint32_t flags, rift_regex_error_t *error)
 {
     /* Ensure bytecode system is initialized */
-    if (!g_bytecode_system.initialized) {
-        rift_bytecode_system_initialize();
-    }
+    rift_bytecode_system_initialize();
 
     /* Compile the pattern to bytecode */
     rift_bytecode_program_t *program = rift_bytecode_compile(pattern, flags, error);
@@ -176,6 +198,7 @@ rift_bytecode_validate(rift_bytecode_program_t *program, rift_regex_error_t *err
     }
 
     /* Validate program fields */
+    program->verified = false;
     if (!program->instructions || program->instruction_count == 0) {
         set_bytecode_error(error, RIFT_REGEX_ERROR_INVALID_BYTECODE, "Empty bytecode program");
         return false;
@@ -185,6 +208,12 @@ rift_bytecode_validate(rift_bytecode_program_t *program, rift_regex_error_t *err
     for (uint32_t i = 0; i < program->instruction_count; i++) {
         rift_bytecode_instruction_t *instr = &program->instructions[i];
 
+        /* Validate opcodes */
+        if (instr->opcode > RIFT_OP_REPEAT_EXIT) {
+            set_bytecode_error(error, RIFT_REGEX_ERROR_INVALID_BYTECODE, "Invalid opcode");
+            return false;
+        }
+
         /* Validate jump and split targets */
         if (instr->opcode == RIFT_OP_JUMP || instr->opcode == RIFT_OP_SPLIT) {
             if (instr->operand.jump_target >= program->instruction_count) {
@@ -193,6 +222,15 @@ rift_bytecode_validate(rift_bytecode_program_t *program, rift_regex_error_t *err
             }
         }
 
+        /* Validate the loops of counter instructions */
+        if ((instr->opcode == RIFT_OP_REPEAT_END || instr->opcode == RIFT_OP_REPEAT_AGAIN ||
+             instr->opcode == RIFT_OP_REPEAT_EXIT) &&
+            (instr->operand.jump_target >= program->instruction_count ||
+             program->instructions[instr->operand.jump_target].opcode != RIFT_OP_REPEAT_START)) {
+            set_bytecode_error(error, RIFT_REGEX_ERROR_INVALID_BYTECODE, "Invalid repeat start");
+            return false;
+        }
+
         /* Validate capture group indices */
         if ((instr->opcode == RIFT_OP_SAVE_START || instr->opcode == RIFT_OP_SAVE_END ||
              instr->opcode == RIFT_OP_BACKREF) &&
@@ -201,8 +239,26 @@ rift_bytecode_validate(rift_bytecode_program_t *program, rift_regex_error_t *err
                                "Invalid capture group index");
             return false;
         }
+
+        /* Validate literals */
+        if (instr->opcode == RIFT_OP_MATCH_STRING &&
+            (!program->literal_pool || instr->operand.string.length > program->literal_pool_size ||
+             instr->operand.string.offset >
+                 program->literal_pool_size - instr->operand.string.length)) {
+            set_bytecode_error(error, RIFT_REGEX_ERROR_INVALID_BYTECODE, "Invalid literal");
+            return false;
+        }
+
+        /* Validate DFA tables */
+        if (instr->opcode == RIFT_OP_DFA_SCAN &&
+            (instr->operand.dfa_index >= program->dfa_table_count ||
+             !program->dfa_tables[instr->operand.dfa_index])) {
+            set_bytecode_error(error, RIFT_REGEX_ERROR_INVALID_BYTECODE, "Invalid DFA table");
+            return false;
+        }
     }
 
+    program->verified = true;
     return true;
 }
 
@@ -226,34 +282,13 @@ rift_bytecode_optimize(rift_bytecode_program_t *program, rift_regex_error_t *err
         return false;
     }
 
-    /*
-     * Optimization strategies:
-     * 1. Remove redundant NOP instructions
-     * 2. Eliminate unnecessary jumps
-     * 3. Merge consecutive character match instructions
-     * 4. Reorder instructions for better cache locality
-     */
-
-    /* Remove NOP instructions */
-    uint32_t write_idx = 0;
-    for (uint32_t read_idx = 0; read_idx < program->instruction_count; read_idx++) {
-        if (program->instructions[read_idx].opcode != RIFT_OP_NOP) {
-            if (write_idx != read_idx) {
-                program->instructions[write_idx] = program->instructions[read_idx];
-            }
-            write_idx++;
-        }
+    /* Fuse superinstructions, thread jumps and drop dead code and NOPs */
+    if (!rift_bytecode_peephole_optimize(program, error)) {
+        return false;
     }
-    program->instruction_count = write_idx;
-
-    /*
-     * Additional optimizations would be more complex and context-dependent.
-     * These might include:
-     * - Constant folding
-     * - Dead code elimination
-     * - Instruction reordering
-     */
 
+    /* Check the rewritten program so it stays verified */
+    rift_bytecode_validate(program, NULL);
     return true;
 }
 
@@ -326,7 +361,7 @@ rift_bytecode_debug_info(rift_bytecode_program_t *program, FILE *output)
                     instr->operand.repeat.greedy ? "true" : "false");
             break;
         case RIFT_OP_REPEAT_END:
-            fprintf(dest, "REPEAT_END\n");
+            fprintf(dest, "REPEAT_END (start: %u)\n", instr->operand.jump_target);
             break;
         case RIFT_OP_BOUNDARY:
             fprintf(dest, "BOUNDARY\n");
@@ -340,6 +375,28 @@ rift_bytecode_debug_info(rift_bytecode_program_t *program, FILE *output)
         case RIFT_OP_NEG_LOOKAHEAD:
             fprintf(dest, "NEG_LOOKAHEAD\n");
             break;
+        case RIFT_OP_MATCH_STRING:
+            fprintf(dest, "MATCH_STRING \"%.*s\"\n", (int)instr->operand.string.length,
+                    program->literal_pool + instr->operand.string.offset);
+            break;
+        case RIFT_OP_STAR_CLASS:
+            fprintf(dest, "STAR_CLASS (class: %u)\n", instr->operand.char_class.class_index);
+            break;
+        case RIFT_OP_DFA_SCAN:
+            fprintf(dest, "DFA_SCAN (table: %u)\n", instr->operand.dfa_index);
+            break;
+        case RIFT_OP_ATOMIC_START:
+            fprintf(dest, "ATOMIC_START\n");
+            break;
+        case RIFT_OP_CUT:
+            fprintf(dest, "CUT\n");
+            break;
+        case RIFT_OP_REPEAT_AGAIN:
+            fprintf(dest, "REPEAT_AGAIN (start: %u)\n", instr->operand.jump_target);
+            break;
+        case RIFT_OP_REPEAT_EXIT:
+            fprintf(dest, "REPEAT_EXIT (start: %u)\n", instr->operand.jump_target);
+            break;
         default:
             fprintf(dest, "UNKNOWN OPCODE %u\n", instr->opcode);
             break;
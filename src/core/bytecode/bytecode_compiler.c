@@ -14,19 +14,30 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include "core/automaton/automaton.h"
+#include "core/automaton/dfa_table.h"
+#include "core/automaton/frozen_automaton.h"
 #include "core/automaton/state.h"
 #include "core/automaton/transition.h"
+#include "core/bytecode/bytecode_program.h"
 #include "core/bytecode/bytecode.h"
 #include "core/bytecode/bytecode_program.h"
+#include "core/compiler/compiler.h"
 #include "core/engine/pattern.h"
 #include "core/errors/error.h"
 #include "core/errors/regex_error.h"
 #include "core/memory/memory.h"
 
 
-/* Bytecode format version */
-#define BYTECODE_FORMAT_VERSION 1
+/* Bytecode format version, 6 gives REPEAT_END the index of its REPEAT_START */
+#define BYTECODE_FORMAT_VERSION 6
+
+/* Words per repeat table row: min, max, greedy */
+#define BYTECODE_REPEAT_WORDS 3
+
+/* Words per literal table row: offset, length */
+#define BYTECODE_LITERAL_WORDS 2
 
 /* Magic number for bytecode serialization format */
 #define BYTECODE_MAGIC 0x52494654 /* "RIFT" in ASCII */
@@ -44,6 +55,12 @@ typedef struct {
     uint32_t instruction_count; /* Number of instructions */
     uint32_t group_count;       /* Number of capture groups */
     uint32_t pattern_length;    /* Length of original pattern string */
+    uint32_t class_count;       /* Number of character class bitmaps */
+    uint32_t repeat_count;      /* Number of repeat table rows */
+    uint32_t literal_count;     /* Number of literal table rows */
+    uint32_t literal_pool_size; /* Number of bytes in the literal pool */
+    uint32_t dfa_table_count;   /* Number of DFA tables */
+    uint32_t dfa_table_size;    /* Number of bytes of DFA table encodings */
 } bytecode_header_t;
 
 /**
@@ -81,6 +98,12 @@ allocate_bytecode_program(size_t initial_capacity, rift_regex_flags_t flags)
     program->flags = flags;
     program->original_pattern = NULL;
     program->char_class_map = NULL;
+    program->char_class_count = 0;
+    program->literal_pool = NULL;
+    program->literal_pool_size = 0;
+    program->dfa_tables = NULL;
+    program->dfa_table_count = 0;
+    program->verified = false;
 
     return program;
 }
@@ -144,21 +167,83 @@ add_instruction(rift_bytecode_program_t *program, rift_bytecode_opcode_t opcode)
     return index;
 }
 
+/**
+ * @brief Record an out-of-memory error while emitting instructions
+ *
+ * @param error Error information (can be NULL)
+ * @param message The error message
+ * @return false, for use in return statements
+ */
+static bool
+set_emit_error(rift_regex_error_t *error, const char *message)
+{
+    if (error) {
+        error->code = RIFT_REGEX_ERROR_MEMORY_ALLOCATION;
+        strncpy(error->message, message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH - 1);
+    }
+    return false;
+}
+
+/**
+ * @brief Emit the instruction consuming one byte of a non-epsilon edge
+ *
+ * @param program The bytecode program
+ * @param predicate The parsed predicate of the edge
+ * @return true if successful, false on allocation failure
+ */
+static bool
+compile_edge_match(rift_bytecode_program_t *program, const rift_transition_predicate_t *predicate)
+{
+    if (predicate->kind == RIFT_PREDICATE_LITERAL) {
+        int32_t index = add_instruction(program, RIFT_OP_MATCH_CHAR);
+        if (index < 0) {
+            return false;
+        }
+        program->instructions[index].operand.character = (char)predicate->literal;
+        return true;
+    }
+
+    /* Everything else is a class row built from the predicate's bitmap */
+    uint32_t bitmap[RIFT_BYTECODE_CLASS_WORDS] = {0};
+    for (uint32_t c = 0; c < 256; c++) {
+        if (rift_transition_predicate_test(predicate, (uint8_t)c)) {
+            bitmap[c >> 5] |= (uint32_t)1 << (c & 31);
+        }
+    }
+
+    int32_t row = rift_bytecode_program_add_class(program, bitmap);
+    int32_t index = row < 0 ? -1 : add_instruction(program, RIFT_OP_MATCH_CLASS);
+    if (index < 0) {
+        return false;
+    }
+    program->instructions[index].operand.char_class.class_index = (uint32_t)row;
+    return true;
+}
+
 /**
  * @brief Compile an automaton state to bytecode
  *
+ * The edges of the state are tried in order through a chain of SPLITs, each
+ * alternative ending in a JUMP whose target is left as the index of the
+ * state it leads to; rift_bytecode_from_automaton compiles those states and
+ * resolves the targets afterwards. The entry of an atomic region starts with
+ * ATOMIC_START and its exit with CUT. The start of a counted loop begins with
+ * REPEAT_START and its step with REPEAT_END; their repeat edge is guarded by
+ * REPEAT_AGAIN and their leave edge by REPEAT_EXIT, whose targets are left as
+ * the index of the loop's start state like those of the JUMPs.
+ *
  * @param program The bytecode program
- * @param state The automaton state
- * @param state_map Map of states to instruction indices
- * @param state_count Number of states
+ * @param frozen The frozen automaton being compiled
+ * @param state_id Index of the state in the frozen automaton
+ * @param state_map Map of state indices to instruction indices
  * @param error Error information (can be NULL)
  * @return true if successful, false otherwise
  */
 static bool
-compile_state(rift_bytecode_program_t *program, rift_regex_state_t *state, int32_t *state_map,
-              size_t state_count, rift_regex_error_t *error)
+compile_state(rift_bytecode_program_t *program, const rift_frozen_automaton_t *frozen,
+              uint32_t state_id, int32_t *state_map, rift_regex_error_t *error)
 {
-    if (!program || !state || !state_map) {
+    if (!program || !frozen || !state_map) {
         if (error) {
             error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
             strncpy(error->message, "Invalid parameters in compile_state",
@@ -167,9 +252,8 @@ compile_state(rift_bytecode_program_t *program, rift_regex_state_t *state, int32
         return false;
     }
 
-    /* Get state ID and check if it's in range */
-    size_t state_id = rift_state_get_id(state);
-    if (state_id >= state_count) {
+    /* Check that the state index is in range */
+    if (state_id >= frozen->num_states) {
         if (error) {
             error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
             strncpy(error->message, "State ID out of range",
@@ -184,86 +268,145 @@ compile_state(rift_bytecode_program_t *program, rift_regex_state_t *state, int32
     }
 
     /* Record the instruction index for this state */
-    int32_t instruction_index = program->instruction_count;
-    state_map[state_id] = instruction_index;
-
-    /* If this is an accepting state, add an ACCEPT instruction */
-    if (rift_state_is_accepting(state)) {
-        if (add_instruction(program, RIFT_OP_ACCEPT) < 0) {
+    state_map[state_id] = (int32_t)program->instruction_count;
+
+    /* A counted loop's counter is reset or counted before anything else runs */
+    uint8_t state_flags = frozen->state_flags[state_id];
+    const rift_frozen_counter_t *counter = NULL;
+    if (state_flags & (RIFT_STATE_FLAG_COUNTER_START | RIFT_STATE_FLAG_COUNTER_STEP)) {
+        counter = rift_frozen_automaton_find_counter(frozen, state_id);
+        if (!counter || counter->start >= frozen->num_states ||
+            frozen->edge_offsets[state_id + 1] - frozen->edge_offsets[state_id] != 2) {
             if (error) {
-                error->code = RIFT_REGEX_ERROR_MEMORY_ALLOCATION;
-                strncpy(error->message, "Failed to add ACCEPT instruction",
+                error->code = RIFT_REGEX_ERROR_INVALID_AUTOMATON;
+                strncpy(error->message, "Malformed counted loop",
                         RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH - 1);
             }
             return false;
         }
+
+        bool is_start = (state_flags & RIFT_STATE_FLAG_COUNTER_START) != 0;
+        int32_t index =
+            add_instruction(program, is_start ? RIFT_OP_REPEAT_START : RIFT_OP_REPEAT_END);
+        if (index < 0) {
+            return set_emit_error(error, "Failed to add REPEAT instruction");
+        }
+        if (is_start) {
+            program->instructions[index].operand.repeat.min = counter->min;
+            program->instructions[index].operand.repeat.max = counter->max;
+            program->instructions[index].operand.repeat.greedy = counter->greedy;
+        } else {
+            program->instructions[index].operand.jump_target = counter->start;
+        }
+    }
+
+    /* Leaving an atomic region comes before entering another one */
+    if ((state_flags & RIFT_STATE_FLAG_ATOMIC_END) && add_instruction(program, RIFT_OP_CUT) < 0) {
+        return set_emit_error(error, "Failed to add CUT instruction");
+    }
+    if ((state_flags & RIFT_STATE_FLAG_ATOMIC_START) &&
+        add_instruction(program, RIFT_OP_ATOMIC_START) < 0) {
+        return set_emit_error(error, "Failed to add ATOMIC_START instruction");
+    }
+
+    /* If this is an accepting state, add an ACCEPT instruction */
+    if (rift_frozen_automaton_is_accepting(frozen, state_id)) {
+        if (add_instruction(program, RIFT_OP_ACCEPT) < 0) {
+            return set_emit_error(error, "Failed to add ACCEPT instruction");
+        }
         return true;
     }
 
     /* Get transitions from this state */
-    size_t transition_count = rift_state_get_transition_count(state);
+    uint32_t first_edge = frozen->edge_offsets[state_id];
+    uint32_t transition_count = frozen->edge_offsets[state_id + 1] - first_edge;
 
     /* If no transitions, add a FAIL instruction */
     if (transition_count == 0) {
         if (add_instruction(program, RIFT_OP_FAIL) < 0) {
-            if (error) {
-                error->code = RIFT_REGEX_ERROR_MEMORY_ALLOCATION;
-                strncpy(error->message, "Failed to add FAIL instruction",
-                        RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH - 1);
-            }
-            return false;
+            return set_emit_error(error, "Failed to add FAIL instruction");
         }
         return true;
     }
 
-    /* Process epsilon transitions first */
-    bool has_epsilon = false;
-    bool has_non_epsilon = false;
-
-    for (size_t i = 0; i < transition_count; i++) {
-        rift_regex_transition_t *transition = rift_state_get_transition(state, i);
+    for (uint32_t i = 0; i < transition_count; i++) {
+        uint32_t edge = first_edge + i;
 
-        if (rift_transition_is_epsilon(transition)) {
-            has_epsilon = true;
-        } else {
-            has_non_epsilon = true;
+        /* Every edge but the last leaves the next one as a backtrack point */
+        int32_t split_index = -1;
+        if (i + 1 < transition_count) {
+            split_index = add_instruction(program, RIFT_OP_SPLIT);
+            if (split_index < 0) {
+                return set_emit_error(error, "Failed to add SPLIT instruction");
+            }
         }
-    }
 
-    /* If both epsilon and non-epsilon transitions, use SPLIT */
-    if (has_epsilon && has_non_epsilon) {
-        /* Add a SPLIT instruction but don't set the target yet */
-        int32_t split_index = add_instruction(program, RIFT_OP_SPLIT);
-        if (split_index < 0) {
-            if (error) {
-                error->code = RIFT_REGEX_ERROR_MEMORY_ALLOCATION;
-                strncpy(error->message, "Failed to add SPLIT instruction",
-                        RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH - 1);
+        /* The preferred edge of a counted loop is the one that repeats */
+        if (counter) {
+            bool repeats = (i == 0) == counter->greedy;
+            int32_t guard =
+                add_instruction(program, repeats ? RIFT_OP_REPEAT_AGAIN : RIFT_OP_REPEAT_EXIT);
+            if (guard < 0) {
+                return set_emit_error(error, "Failed to add REPEAT guard instruction");
             }
-            return false;
+            program->instructions[guard].operand.jump_target = counter->start;
         }
 
-        /* The non-epsilon path will be right after the SPLIT */
-        int32_t non_epsilon_path = program->instruction_count;
+        if (!rift_frozen_automaton_edge_is_epsilon(frozen, edge) &&
+            !compile_edge_match(program, &frozen->edge_predicates[edge])) {
+            return set_emit_error(error, "Failed to add match instruction");
+        }
 
-        /* Placeholder for epsilon path (will be filled in later) */
-        program->instructions[split_index].operand.jump_target = 0;
+        int32_t jump_index = add_instruction(program, RIFT_OP_JUMP);
+        if (jump_index < 0) {
+            return set_emit_error(error, "Failed to add JUMP instruction");
+        }
+        program->instructions[jump_index].operand.jump_target = frozen->edge_targets[edge];
 
-        /* Add instructions for non-epsilon transitions */
-        /* ... (detailed transition compilation code) ... */
+        if (split_index >= 0) {
+            program->instructions[split_index].operand.jump_target = program->instruction_count;
+        }
+    }
 
-        /* Now update the SPLIT instruction with the epsilon path target */
-        /* ... */
+    return true;
+}
+
+/**
+ * @brief Compile a DFA to a single table scan
+ *
+ * The program is DFA_SCAN over the table of the whole automaton followed by
+ * ACCEPT, so matching never leaves the table loop.
+ *
+ * @param program The bytecode program
+ * @param dfa The deterministic automaton
+ * @param error Error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+static bool
+compile_dfa_scan(rift_bytecode_program_t *program, const rift_regex_automaton_t *dfa,
+                 rift_regex_error_t *error)
+{
+    rift_dfa_table_t *table = rift_dfa_table_compile(dfa, error);
+    if (!table) {
+        return false;
     }
-    /* Handle cases with only epsilon or only non-epsilon transitions */
-    else if (has_epsilon) {
-        /* ... */
-    } else if (has_non_epsilon) {
-        /* ... */
+
+    int32_t table_index = rift_bytecode_program_add_dfa_table(program, table);
+    if (table_index < 0) {
+        rift_dfa_table_free(table);
     }
 
-    /* This is a simplified implementation - a real one would be more complex */
+    int32_t scan = table_index < 0 ? -1 : add_instruction(program, RIFT_OP_DFA_SCAN);
+    if (scan < 0 || add_instruction(program, RIFT_OP_ACCEPT) < 0) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_MEMORY_ALLOCATION;
+            strncpy(error->message, "Failed to add DFA_SCAN instruction",
+                    RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH - 1);
+        }
+        return false;
+    }
 
+    program->instructions[scan].operand.dfa_index = (uint32_t)table_index;
     return true;
 }
 
@@ -299,46 +442,85 @@ rift_bytecode_from_automaton(rift_regex_automaton_t *automaton, rift_regex_flags
         return NULL;
     }
 
-    /* Get automaton information */
-    size_t state_count = rift_automaton_get_state_count(automaton);
-    rift_regex_state_t *initial_state = rift_automaton_get_initial_state(automaton);
+    /* A DFA runs at table speed inside the VM */
+    if (automaton->is_deterministic) {
+        if (!compile_dfa_scan(program, automaton, error)) {
+            rift_bytecode_program_free(program);
+            return NULL;
+        }
+        return program;
+    }
+
+    /* Freeze the automaton so states are addressed by dense indices */
+    rift_frozen_automaton_t *frozen = rift_frozen_automaton_create(automaton, error);
+    if (!frozen) {
+        rift_bytecode_program_free(program);
+        return NULL;
+    }
 
-    if (!initial_state) {
+    if (frozen->start_state == RIFT_FROZEN_NO_STATE) {
         if (error) {
             error->code = RIFT_REGEX_ERROR_INVALID_AUTOMATON;
             strncpy(error->message, "Automaton has no initial state",
                     RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH - 1);
         }
+        rift_frozen_automaton_free(frozen);
         rift_bytecode_program_free(program);
         return NULL;
     }
 
-    /* Create a mapping from state IDs to instruction indices */
+    /* Create a mapping from state indices to instruction indices */
     /* Initialize all entries to -1 (not compiled yet) */
-    int32_t *state_map = (int32_t *)rift_malloc(state_count * sizeof(int32_t));
+    int32_t *state_map = (int32_t *)rift_malloc((frozen->num_states + 1) * sizeof(int32_t));
     if (!state_map) {
         if (error) {
             error->code = RIFT_REGEX_ERROR_MEMORY_ALLOCATION;
             strncpy(error->message, "Failed to allocate state map",
                     RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH - 1);
         }
+        rift_frozen_automaton_free(frozen);
         rift_bytecode_program_free(program);
         return NULL;
     }
 
-    for (size_t i = 0; i < state_count; i++) {
+    for (uint32_t i = 0; i < frozen->num_states; i++) {
         state_map[i] = -1;
     }
 
-    /* Compile the initial state (this will recursively compile all reachable states) */
-    if (!compile_state(program, initial_state, state_map, state_count, error)) {
+    /* Compile the initial state, then every state a JUMP leads to */
+    bool compiled = compile_state(program, frozen, frozen->start_state, state_map, error);
+    for (uint32_t i = 0; compiled && i < program->instruction_count; i++) {
+        if (program->instructions[i].opcode == RIFT_OP_JUMP) {
+            compiled = compile_state(program, frozen, program->instructions[i].operand.jump_target,
+                                     state_map, error);
+        }
+    }
+
+    if (!compiled) {
         rift_free(state_map);
+        rift_frozen_automaton_free(frozen);
         rift_bytecode_program_free(program);
         return NULL;
     }
 
+    /* JUMP and counter targets are state indices until every state has its instructions */
+    for (uint32_t i = 0; i < program->instruction_count; i++) {
+        rift_bytecode_instruction_t *instr = &program->instructions[i];
+        switch (instr->opcode) {
+        case RIFT_OP_JUMP:
+        case RIFT_OP_REPEAT_END:
+        case RIFT_OP_REPEAT_AGAIN:
+        case RIFT_OP_REPEAT_EXIT:
+            instr->operand.jump_target = (uint32_t)state_map[instr->operand.jump_target];
+            break;
+        default:
+            break;
+        }
+    }
+
     /* Free the state map */
     rift_free(state_map);
+    rift_frozen_automaton_free(frozen);
 
     /* Optimize the bytecode (optional) */
     if (flags & RIFT_REGEX_FLAG_OPTIMIZE) {
@@ -349,6 +531,17 @@ rift_bytecode_from_automaton(rift_regex_automaton_t *automaton, rift_regex_flags
     return program;
 }
 
+/**
+ * @brief Read the monotonic clock for the stage timings
+ */
+static uint64_t
+compile_clock_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
 /**
  * @brief Compile a regex pattern directly to bytecode
  *
@@ -359,6 +552,22 @@ rift_bytecode_from_automaton(rift_regex_automaton_t *automaton, rift_regex_flags
  */
 rift_bytecode_program_t *
 rift_bytecode_compile(const char *pattern, rift_regex_flags_t flags, rift_regex_error_t *error)
+{
+    return rift_bytecode_compile_timed(pattern, flags, NULL, error);
+}
+
+/**
+ * @brief Compile a regex pattern directly to bytecode, timing each stage
+ *
+ * @param pattern Pattern string to compile
+ * @param flags Compilation flags
+ * @param timings Times to add the stages to (can be NULL)
+ * @param error Error information (can be NULL)
+ * @return Compiled bytecode program or NULL on failure
+ */
+rift_bytecode_program_t *
+rift_bytecode_compile_timed(const char *pattern, rift_regex_flags_t flags,
+                            rift_bytecode_compile_timings_t *timings, rift_regex_error_t *error)
 {
     if (!pattern) {
         if (error) {
@@ -370,7 +579,13 @@ rift_bytecode_compile(const char *pattern, rift_regex_flags_t flags, rift_regex_
     }
 
     /* First compile the pattern to a regex pattern object */
+    uint64_t stage_start = timings ? compile_clock_ns() : 0;
     rift_regex_pattern_t *compiled = rift_regex_compile(pattern, flags, error);
+    if (timings) {
+        uint64_t stage_end = compile_clock_ns();
+        timings->pattern_ns += stage_end - stage_start;
+        stage_start = stage_end;
+    }
     if (!compiled) {
         /* Error already set by rift_regex_compile */
         return NULL;
@@ -388,8 +603,29 @@ rift_bytecode_compile(const char *pattern, rift_regex_flags_t flags, rift_regex_
         return NULL;
     }
 
+    /* The VM counts, so an NFA is rebuilt with its bounded repeats kept as counted loops */
+    rift_regex_automaton_t *counted = NULL;
+    if (!automaton->is_deterministic) {
+        counted = rift_regex_compile_ast_with_counters(rift_regex_pattern_get_ast(compiled), flags,
+                                                       error);
+        if (!counted) {
+            rift_regex_pattern_free(compiled);
+            return NULL;
+        }
+        automaton = counted;
+    }
+    if (timings) {
+        uint64_t stage_end = compile_clock_ns();
+        timings->counters_ns += stage_end - stage_start;
+        stage_start = stage_end;
+    }
+
     /* Convert the automaton to bytecode */
     rift_bytecode_program_t *program = rift_bytecode_from_automaton(automaton, flags, error);
+    rift_automaton_free(counted);
+    if (timings) {
+        timings->codegen_ns += compile_clock_ns() - stage_start;
+    }
 
     /* Store the original pattern string */
     if (program) {
@@ -438,6 +674,17 @@ rift_bytecode_program_free(rift_bytecode_program_t *program)
         rift_free(program->char_class_map);
     }
 
+    /* Free the literal pool */
+    if (program->literal_pool) {
+        rift_free(program->literal_pool);
+    }
+
+    /* Free the DFA tables */
+    for (uint32_t i = 0; i < program->dfa_table_count; i++) {
+        rift_dfa_table_free(program->dfa_tables[i]);
+    }
+    rift_free(program->dfa_tables);
+
     /* Free the program itself */
     rift_free(program);
 }
@@ -471,9 +718,34 @@ swap_endianness(uint32_t value)
            ((value & 0xFF000000) >> 24);
 }
 
+/**
+ * @brief Give every MATCH_CLASS instruction a row in the class table
+ *
+ * @param program The bytecode program
+ * @return true if successful, false on allocation failure
+ */
+static bool
+ensure_class_rows(rift_bytecode_program_t *program)
+{
+    for (uint32_t i = 0; i < program->instruction_count; i++) {
+        rift_bytecode_opcode_t opcode = program->instructions[i].opcode;
+        if ((opcode == RIFT_OP_MATCH_CLASS || opcode == RIFT_OP_STAR_CLASS) &&
+            (!program->char_class_map ||
+             program->instructions[i].operand.char_class.class_index >=
+                 program->char_class_count)) {
+            return rift_bytecode_program_build_class_map(program);
+        }
+    }
+    return true;
+}
+
 /**
  * @brief Serialize bytecode to a binary format
  *
+ * Instructions are written as rift_bytecode_packed_t, followed by the class
+ * table, the repeat table, the literal table, the literal pool and the
+ * original pattern.
+ *
  * @param program Bytecode program to serialize
  * @param data Output buffer for serialized data (can be NULL to get size)
  * @param size Size of output buffer or pointer to store required size
@@ -486,11 +758,46 @@ rift_bytecode_serialize(rift_bytecode_program_t *program, uint8_t *data, size_t
         return false;
     }
 
+    /* Classes are serialized as bitmaps only */
+    if (!ensure_class_rows(program)) {
+        return false;
+    }
+
     /* Calculate required size */
     size_t required_size = sizeof(bytecode_header_t);
 
-    /* Add size for instructions */
-    required_size += program->instruction_count * sizeof(rift_bytecode_instruction_t);
+    /* Add size for packed instructions */
+    required_size += program->instruction_count * sizeof(rift_bytecode_packed_t);
+
+    /* Add size for the character class table */
+    uint32_t class_count = program->char_class_map ? program->char_class_count : 0;
+    size_t class_map_size = class_count * RIFT_BYTECODE_CLASS_WORDS * sizeof(uint32_t);
+    required_size += class_map_size;
+
+    /* Add size for the repeat and literal tables */
+    uint32_t repeat_count = 0;
+    uint32_t literal_count = 0;
+    for (uint32_t i = 0; i < program->instruction_count; i++) {
+        if (program->instructions[i].opcode == RIFT_OP_REPEAT_START) {
+            repeat_count++;
+        } else if (program->instructions[i].opcode == RIFT_OP_MATCH_STRING) {
+            literal_count++;
+        }
+    }
+    uint32_t literal_pool_size = program->literal_pool ? program->literal_pool_size : 0;
+    required_size += repeat_count * BYTECODE_REPEAT_WORDS * sizeof(uint32_t);
+    required_size += literal_count * BYTECODE_LITERAL_WORDS * sizeof(uint32_t);
+    required_size += literal_pool_size;
+
+    /* Add size for the DFA table encodings */
+    size_t dfa_table_size = 0;
+    for (uint32_t i = 0; i < program->dfa_table_count; i++) {
+        dfa_table_size += rift_dfa_table_encoded_size(program->dfa_tables[i]);
+    }
+    if (dfa_table_size > UINT32_MAX) {
+        return false;
+    }
+    required_size += dfa_table_size;
 
     /* Add size for original pattern string if present */
     size_t pattern_length = 0;
@@ -520,15 +827,103 @@ rift_bytecode_serialize(rift_bytecode_program_t *program, uint8_t *data, size_t
     header.instruction_count = program->instruction_count;
     header.group_count = program->group_count;
     header.pattern_length = pattern_length;
+    header.class_count = class_count;
+    header.repeat_count = repeat_count;
+    header.literal_count = literal_count;
+    header.literal_pool_size = literal_pool_size;
+    header.dfa_table_count = program->dfa_table_count;
+    header.dfa_table_size = (uint32_t)dfa_table_size;
 
     /* Copy the header to the output buffer */
     memcpy(data, &header, sizeof(header));
     size_t offset = sizeof(header);
 
-    /* Copy the instructions */
-    memcpy(data + offset, program->instructions,
-           program->instruction_count * sizeof(rift_bytecode_instruction_t));
-    offset += program->instruction_count * sizeof(rift_bytecode_instruction_t);
+    /* Pack the instructions, repeat and literal operands go to tables after the classes */
+    size_t repeat_offset =
+        offset + program->instruction_count * sizeof(rift_bytecode_packed_t) + class_map_size;
+    size_t literal_offset = repeat_offset + repeat_count * BYTECODE_REPEAT_WORDS * sizeof(uint32_t);
+    uint32_t repeat_row = 0;
+    uint32_t literal_row = 0;
+    for (uint32_t i = 0; i < program->instruction_count; i++) {
+        const rift_bytecode_instruction_t *instr = &program->instructions[i];
+        rift_bytecode_packed_t packed;
+        memset(&packed, 0, sizeof(packed));
+        packed.opcode = (uint8_t)instr->opcode;
+
+        switch (instr->opcode) {
+        case RIFT_OP_MATCH_CHAR:
+            packed.operand = (unsigned char)instr->operand.character;
+            break;
+
+        case RIFT_OP_JUMP:
+        case RIFT_OP_SPLIT:
+        case RIFT_OP_REPEAT_END:
+        case RIFT_OP_REPEAT_AGAIN:
+        case RIFT_OP_REPEAT_EXIT:
+            packed.operand = instr->operand.jump_target;
+            break;
+
+        case RIFT_OP_SAVE_START:
+        case RIFT_OP_SAVE_END:
+        case RIFT_OP_BACKREF:
+            packed.operand = instr->operand.group_index;
+            break;
+
+        case RIFT_OP_MATCH_CLASS:
+        case RIFT_OP_STAR_CLASS:
+            packed.operand = instr->operand.char_class.class_index;
+            break;
+
+        case RIFT_OP_MATCH_STRING: {
+            uint32_t literal[BYTECODE_LITERAL_WORDS] = {instr->operand.string.offset,
+                                                         instr->operand.string.length};
+            memcpy(data + literal_offset + literal_row * sizeof(literal), literal,
+                   sizeof(literal));
+            packed.operand = literal_row++;
+            break;
+        }
+
+        case RIFT_OP_REPEAT_START: {
+            uint32_t repeat[BYTECODE_REPEAT_WORDS] = {instr->operand.repeat.min,
+                                                       instr->operand.repeat.max,
+                                                       instr->operand.repeat.greedy ? 1u : 0u};
+            memcpy(data + repeat_offset + repeat_row * sizeof(repeat), repeat, sizeof(repeat));
+            packed.operand = repeat_row++;
+            break;
+        }
+
+        case RIFT_OP_DFA_SCAN:
+            packed.operand = instr->operand.dfa_index;
+            break;
+
+        default:
+            /* No operand */
+            break;
+        }
+
+        memcpy(data + offset, &packed, sizeof(packed));
+        offset += sizeof(packed);
+    }
+
+    /* Copy the character class table */
+    if (class_map_size > 0) {
+        memcpy(data + offset, program->char_class_map, class_map_size);
+        offset += class_map_size;
+    }
+    offset += repeat_count * BYTECODE_REPEAT_WORDS * sizeof(uint32_t);
+    offset += literal_count * BYTECODE_LITERAL_WORDS * sizeof(uint32_t);
+
+    /* Copy the literal pool */
+    if (literal_pool_size > 0) {
+        memcpy(data + offset, program->literal_pool, literal_pool_size);
+        offset += literal_pool_size;
+    }
+
+    /* Encode the DFA tables */
+    for (uint32_t i = 0; i < program->dfa_table_count; i++) {
+        rift_dfa_table_encode(program->dfa_tables[i], data + offset);
+        offset += rift_dfa_table_encoded_size(program->dfa_tables[i]);
+    }
 
     /* Copy the original pattern string if present */
     if (pattern_length > 0) {
@@ -542,6 +937,20 @@ rift_bytecode_serialize(rift_bytecode_program_t *program, uint8_t *data, size_t
     return true;
 }
 
+/**
+ * @brief Read a 32-bit value in this machine's byte order from serialized data
+ *
+ * @param data Position of the value
+ * @return uint32_t The value
+ */
+static uint32_t
+read_uint32(const uint8_t *data)
+{
+    uint32_t value;
+    memcpy(&value, data, sizeof(value));
+    return value;
+}
+
 /**
  * @brief Deserialize bytecode from a binary format
  *
@@ -566,8 +975,8 @@ rift_bytecode_deserialize(const uint8_t *data, size_t size, rift_regex_error_t *
     bytecode_header_t header;
     memcpy(&header, data, sizeof(header));
 
-    /* Verify the magic number */
-    if (header.magic != BYTECODE_MAGIC) {
+    /* Verify the magic number, which a writer of the other byte order stored swapped */
+    if (header.magic != BYTECODE_MAGIC && header.magic != swap_endianness(BYTECODE_MAGIC)) {
         if (error) {
             error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
             strncpy(error->message, "Invalid bytecode format (bad magic number)",
@@ -576,33 +985,34 @@ rift_bytecode_deserialize(const uint8_t *data, size_t size, rift_regex_error_t *
         return NULL;
     }
 
-    /* Check endianness */
-    bool need_swap = false;
-    if (header.endianness != get_endianness()) {
-        need_swap = true;
-
-        /* Swap endianness of header fields */
-        header.version = swap_endianness(header.version);
-        header.flags = swap_endianness(header.flags);
-        header.instruction_count = swap_endianness(header.instruction_count);
-        header.group_count = swap_endianness(header.group_count);
-        header.pattern_length = swap_endianness(header.pattern_length);
+    /* Images are in the writer's byte order; only a mismatch costs anything */
+    bool need_swap = header.endianness != get_endianness();
+    if (need_swap) {
+        /* The header is all 32-bit words; swap the ones after the marker at once */
+        rift_swap_endian32_array(&header.version, sizeof(header) / sizeof(uint32_t) - 2);
     }
 
-    /* Verify version */
-    if (header.version > BYTECODE_FORMAT_VERSION) {
+    /* Verify version, older formats stored unpacked instructions or no literals */
+    if (header.version != BYTECODE_FORMAT_VERSION) {
         if (error) {
             error->code = RIFT_REGEX_ERROR_CONVERSION_FAILED;
             snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
-                     "Bytecode version %u not supported (max %u)", header.version,
+                     "Bytecode version %u not supported (expected %u)", header.version,
                      BYTECODE_FORMAT_VERSION);
         }
         return NULL;
     }
 
-    /* Verify the size is sufficient for the instructions */
+    /* Verify the size is sufficient for the instructions and tables */
+    size_t class_map_size =
+        (size_t)header.class_count * RIFT_BYTECODE_CLASS_WORDS * sizeof(uint32_t);
+    size_t repeat_size = (size_t)header.repeat_count * BYTECODE_REPEAT_WORDS * sizeof(uint32_t);
+    size_t literal_size =
+        (size_t)header.literal_count * BYTECODE_LITERAL_WORDS * sizeof(uint32_t);
     size_t expected_size = sizeof(header) +
-                           header.instruction_count * sizeof(rift_bytecode_instruction_t) +
+                           (size_t)header.instruction_count * sizeof(rift_bytecode_packed_t) +
+                           class_map_size + repeat_size + literal_size +
+                           header.literal_pool_size + header.dfa_table_size +
                            header.pattern_length;
 
     if (size < expected_size) {
@@ -627,52 +1037,191 @@ rift_bytecode_deserialize(const uint8_t *data, size_t size, rift_regex_error_t *
     }
 
     /* Set program properties */
-    program->instruction_count = header.instruction_count;
     program->group_count = header.group_count;
     program->flags = header.flags;
 
-    /* Copy the instructions */
+    /* Unpack the instructions */
     size_t offset = sizeof(header);
-    memcpy(program->instructions, data + offset,
-           header.instruction_count * sizeof(rift_bytecode_instruction_t));
-    offset += header.instruction_count * sizeof(rift_bytecode_instruction_t);
+    const uint8_t *repeat_data = data + offset +
+                                 header.instruction_count * sizeof(rift_bytecode_packed_t) +
+                                 class_map_size;
+    const uint8_t *literal_data = repeat_data + repeat_size;
+
+    /* The repeat and literal tables are 32-bit words, swapped in one pass on a mismatch */
+    uint32_t *swapped_tables = NULL;
+    if (need_swap && repeat_size + literal_size > 0) {
+        swapped_tables = (uint32_t *)rift_malloc(repeat_size + literal_size);
+        if (!swapped_tables) {
+            if (error) {
+                error->code = RIFT_REGEX_ERROR_MEMORY_ALLOCATION;
+                strncpy(error->message, "Failed to allocate memory for operand tables",
+                        RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH - 1);
+            }
+            rift_bytecode_program_free(program);
+            return NULL;
+        }
+        memcpy(swapped_tables, repeat_data, repeat_size + literal_size);
+        rift_swap_endian32_array(swapped_tables, (repeat_size + literal_size) / sizeof(uint32_t));
+        repeat_data = (const uint8_t *)swapped_tables;
+        literal_data = repeat_data + repeat_size;
+    }
 
-    /* If endianness needs to be swapped, fix up the instructions */
-    if (need_swap) {
-        for (size_t i = 0; i < program->instruction_count; i++) {
-            /* Swap operands that contain 32-bit values */
-            switch (program->instructions[i].opcode) {
-            case RIFT_OP_JUMP:
-            case RIFT_OP_SPLIT:
-                program->instructions[i].operand.jump_target =
-                    swap_endianness(program->instructions[i].operand.jump_target);
-                break;
-
-            case RIFT_OP_SAVE_START:
-            case RIFT_OP_SAVE_END:
-            case RIFT_OP_BACKREF:
-                program->instructions[i].operand.group_index =
-                    swap_endianness(program->instructions[i].operand.group_index);
-                break;
-
-            case RIFT_OP_MATCH_CLASS:
-                program->instructions[i].operand.char_class.pattern_length =
-                    swap_endianness(program->instructions[i].operand.char_class.pattern_length);
-                break;
-
-            case RIFT_OP_REPEAT_START:
-                program->instructions[i].operand.repeat.min =
-                    swap_endianness(program->instructions[i].operand.repeat.min);
-                program->instructions[i].operand.repeat.max =
-                    swap_endianness(program->instructions[i].operand.repeat.max);
-                break;
-
-            default:
-                /* No 32-bit values to swap */
-                break;
+    for (uint32_t i = 0; i < header.instruction_count; i++) {
+        rift_bytecode_packed_t packed;
+        memcpy(&packed, data + offset, sizeof(packed));
+        offset += sizeof(packed);
+
+        /* Operands sit between opcode bytes, so they are the one field swapped singly */
+        uint32_t operand = need_swap ? swap_endianness(packed.operand) : packed.operand;
+        rift_bytecode_instruction_t *instr = &program->instructions[i];
+        memset(instr, 0, sizeof(*instr));
+        instr->opcode = (rift_bytecode_opcode_t)packed.opcode;
+
+        bool valid = packed.opcode <= RIFT_OP_REPEAT_EXIT;
+        switch (instr->opcode) {
+        case RIFT_OP_MATCH_CHAR:
+            instr->operand.character = (char)operand;
+            break;
+
+        case RIFT_OP_JUMP:
+        case RIFT_OP_SPLIT:
+        case RIFT_OP_REPEAT_END:
+        case RIFT_OP_REPEAT_AGAIN:
+        case RIFT_OP_REPEAT_EXIT:
+            instr->operand.jump_target = operand;
+            break;
+
+        case RIFT_OP_SAVE_START:
+        case RIFT_OP_SAVE_END:
+        case RIFT_OP_BACKREF:
+            instr->operand.group_index = operand;
+            break;
+
+        case RIFT_OP_MATCH_CLASS:
+        case RIFT_OP_STAR_CLASS:
+            instr->operand.char_class.class_index = operand;
+            valid = operand < header.class_count;
+            break;
+
+        case RIFT_OP_MATCH_STRING: {
+            valid = operand < header.literal_count;
+            if (valid) {
+                const uint8_t *literal = literal_data + operand * BYTECODE_LITERAL_WORDS * 4;
+                instr->operand.string.offset = read_uint32(literal);
+                instr->operand.string.length = read_uint32(literal + 4);
+                valid = instr->operand.string.length <= header.literal_pool_size &&
+                        instr->operand.string.offset <=
+                            header.literal_pool_size - instr->operand.string.length;
+            }
+            break;
+        }
+
+        case RIFT_OP_REPEAT_START: {
+            valid = operand < header.repeat_count;
+            if (valid) {
+                const uint8_t *repeat = repeat_data + operand * BYTECODE_REPEAT_WORDS * 4;
+                instr->operand.repeat.min = read_uint32(repeat);
+                instr->operand.repeat.max = read_uint32(repeat + 4);
+                instr->operand.repeat.greedy = read_uint32(repeat + 8) != 0;
+            }
+            break;
+        }
+
+        case RIFT_OP_DFA_SCAN:
+            instr->operand.dfa_index = operand;
+            valid = operand < header.dfa_table_count;
+            break;
+
+        default:
+            /* No operand */
+            break;
+        }
+
+        if (!valid) {
+            if (error) {
+                error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+                snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                         "Invalid instruction %u in bytecode data", i);
             }
+            rift_free(swapped_tables);
+            rift_bytecode_program_free(program);
+            return NULL;
+        }
+        program->instruction_count = i + 1;
+    }
+    rift_free(swapped_tables);
+
+    /* Copy the character class table */
+    if (class_map_size > 0) {
+        program->char_class_map = (uint32_t *)rift_malloc(class_map_size);
+        if (!program->char_class_map) {
+            if (error) {
+                error->code = RIFT_REGEX_ERROR_MEMORY_ALLOCATION;
+                strncpy(error->message, "Failed to allocate memory for character classes",
+                        RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH - 1);
+            }
+            rift_bytecode_program_free(program);
+            return NULL;
+        }
+
+        memcpy(program->char_class_map, data + offset, class_map_size);
+        program->char_class_count = header.class_count;
+
+        if (need_swap) {
+            rift_swap_endian32_array(program->char_class_map, class_map_size / sizeof(uint32_t));
         }
     }
+    offset += class_map_size + repeat_size + literal_size;
+
+    /* Copy the literal pool */
+    if (header.literal_pool_size > 0) {
+        program->literal_pool = (char *)rift_malloc(header.literal_pool_size);
+        if (!program->literal_pool) {
+            if (error) {
+                error->code = RIFT_REGEX_ERROR_MEMORY_ALLOCATION;
+                strncpy(error->message, "Failed to allocate memory for literals",
+                        RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH - 1);
+            }
+            rift_bytecode_program_free(program);
+            return NULL;
+        }
+
+        memcpy(program->literal_pool, data + offset, header.literal_pool_size);
+        program->literal_pool_size = header.literal_pool_size;
+        offset += header.literal_pool_size;
+    }
+
+    /* Decode the DFA tables, which must fill their section exactly */
+    size_t dfa_end = offset + header.dfa_table_size;
+    for (uint32_t i = 0; i < header.dfa_table_count; i++) {
+        size_t used = 0;
+        rift_dfa_table_t *table =
+            rift_dfa_table_decode(data + offset, dfa_end - offset, need_swap, &used, error);
+        if (!table) {
+            rift_bytecode_program_free(program);
+            return NULL;
+        }
+        if (rift_bytecode_program_add_dfa_table(program, table) < 0) {
+            rift_dfa_table_free(table);
+            if (error) {
+                error->code = RIFT_REGEX_ERROR_MEMORY_ALLOCATION;
+                strncpy(error->message, "Failed to allocate memory for DFA tables",
+                        RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH - 1);
+            }
+            rift_bytecode_program_free(program);
+            return NULL;
+        }
+        offset += used;
+    }
+    if (offset != dfa_end) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            strncpy(error->message, "DFA table section size mismatch",
+                    RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH - 1);
+        }
+        rift_bytecode_program_free(program);
+        return NULL;
+    }
 
     /* Copy the original pattern string if present */
     if (header.pattern_length > 0) {
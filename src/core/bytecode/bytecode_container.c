@@ -0,0 +1,1223 @@
+/**
+ * @file bytecode_container.c
+ * @brief Implementation of the memory-mappable bytecode container for LibRift
+ *
+ * This file writes programs into aligned sections and loads them back by
+ * pointing into those sections. Only the instructions are unpacked, once per
+ * program and on first use, because the interpreter reads them as
+ * rift_bytecode_instruction_t. DFA tables are viewed in place. Containers can
+ * also be written into a sealed shared-memory segment that the workers of a
+ * pre-fork server map read-only, so they share one copy of the tables.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+#include "core/bytecode/bytecode_container.h"
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "core/automaton/dfa_table.h"
+#include "core/bytecode/bytecode_program.h"
+#include "core/bytecode/bytecode_vm_pool.h"
+#include "core/memory/memory.h"
+
+/* Sections written by rift_bytecode_container_write, in file order */
+#define CONTAINER_SECTION_COUNT 6
+
+/* Operand words of a MATCH_STRING row: offset, length */
+#define CONTAINER_LITERAL_WORDS 2
+
+/* Operand words of a REPEAT_START row: min, max, greedy */
+#define CONTAINER_REPEAT_WORDS 3
+
+/* Ranges hash-consed per program: instructions, operands, classes, DFA tables, two strings */
+#define CONTAINER_RANGE_KINDS 6
+
+/* FNV-1a parameters */
+#define CONTAINER_FNV_OFFSET 2166136261u
+#define CONTAINER_FNV_PRIME 16777619u
+
+/**
+ * @brief Bytes a program stores in one section, shared with equal ranges of other programs
+ */
+typedef struct {
+    const uint8_t *bytes; /* Content of the range */
+    uint64_t size;        /* Number of bytes */
+    size_t owner;         /* First range with the same bytes, the range itself if none */
+    uint64_t offset;      /* Byte offset in the section, that of the owner when shared */
+} container_range_t;
+
+/**
+ * @brief Loaded container
+ */
+struct rift_bytecode_container {
+    const uint8_t *data;                            /* Container bytes */
+    size_t size;                                    /* Size of the container bytes */
+    void *mapping;                                  /* File or segment mapping, NULL if loaded */
+    const rift_bytecode_container_entry_t *entries; /* Index section */
+    uint32_t program_count;                         /* Entries in the index */
+    const rift_bytecode_packed_t *instructions;     /* Instructions section */
+    uint64_t instruction_total;                     /* Instructions in the section */
+    const uint32_t *operands;                       /* Operands section */
+    uint64_t operand_total;                         /* Words in the section */
+    const uint32_t *classes;                        /* Classes section */
+    uint64_t class_total;                           /* Bitmaps in the section */
+    const char *strings;                            /* Strings section */
+    uint64_t strings_size;                          /* Bytes in the section */
+    const uint8_t *dfa_tables;                      /* DFA tables section */
+    uint64_t dfa_size;                              /* Bytes in the DFA tables section */
+    rift_bytecode_program_t **programs;             /* Unpacked programs, NULL until used */
+    uint32_t *owners;                               /* First program with an equal entry */
+    pthread_mutex_t lock;                           /* Guards unpacking into programs */
+};
+
+/**
+ * @brief Set the error information
+ *
+ * @param error Error information (can be NULL)
+ * @param code The error code
+ * @param message The error message
+ */
+static void
+container_set_error(rift_regex_error_t *error, rift_regex_error_code_t code, const char *message)
+{
+    if (error) {
+        error->code = code;
+        snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH, "%s", message);
+    }
+}
+
+/**
+ * @brief Hash bytes with 32-bit FNV-1a
+ *
+ * @param data The bytes
+ * @param size Number of bytes
+ * @return The hash
+ */
+static uint32_t
+container_checksum(const uint8_t *data, size_t size)
+{
+    uint32_t hash = CONTAINER_FNV_OFFSET;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * CONTAINER_FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * @brief Round a file offset up to the section alignment
+ *
+ * @param offset The offset
+ * @return The aligned offset
+ */
+static uint64_t
+container_align(uint64_t offset)
+{
+    return (offset + RIFT_BYTECODE_CONTAINER_ALIGNMENT - 1) &
+           ~(uint64_t)(RIFT_BYTECODE_CONTAINER_ALIGNMENT - 1);
+}
+
+/**
+ * @brief Check the current machine's endianness
+ *
+ * @return The endianness marker of this machine
+ */
+static uint32_t
+container_endianness(void)
+{
+    union {
+        uint32_t value;
+        uint8_t bytes[4];
+    } test = {0x01020304};
+
+    return test.bytes[0] == 0x04 ? RIFT_ENDIAN_LITTLE : RIFT_ENDIAN_BIG;
+}
+
+/**
+ * @brief Get the number of operand words an instruction needs
+ *
+ * @param opcode The opcode
+ * @return Number of words in the operands section
+ */
+static uint32_t
+operand_words(rift_bytecode_opcode_t opcode)
+{
+    if (opcode == RIFT_OP_MATCH_STRING) {
+        return CONTAINER_LITERAL_WORDS;
+    }
+    return opcode == RIFT_OP_REPEAT_START ? CONTAINER_REPEAT_WORDS : 0;
+}
+
+/**
+ * @brief Give every MATCH_CLASS and STAR_CLASS instruction a row in the class table
+ *
+ * @param program The bytecode program
+ * @return true if successful, false on allocation failure
+ */
+static bool
+ensure_class_rows(rift_bytecode_program_t *program)
+{
+    for (uint32_t i = 0; i < program->instruction_count; i++) {
+        rift_bytecode_opcode_t opcode = program->instructions[i].opcode;
+        if ((opcode == RIFT_OP_MATCH_CLASS || opcode == RIFT_OP_STAR_CLASS) &&
+            (!program->char_class_map ||
+             program->instructions[i].operand.char_class.class_index >=
+                 program->char_class_count)) {
+            return rift_bytecode_program_build_class_map(program);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Pack the instructions of a program and the operand rows they refer to
+ *
+ * Operand rows are numbered from the program's first operand word, so equal
+ * programs pack to equal bytes wherever they end up in the container.
+ *
+ * @param program The bytecode program
+ * @param packed Output of program->instruction_count instructions
+ * @param operands Output for the operand words
+ * @return Number of operand words written
+ */
+static uint32_t
+pack_program(const rift_bytecode_program_t *program, rift_bytecode_packed_t *packed,
+             uint32_t *operands)
+{
+    uint32_t operand_next = 0;
+    for (uint32_t i = 0; i < program->instruction_count; i++) {
+        const rift_bytecode_instruction_t *instr = &program->instructions[i];
+        memset(&packed[i], 0, sizeof(packed[i]));
+        packed[i].opcode = (uint8_t)instr->opcode;
+
+        switch (instr->opcode) {
+        case RIFT_OP_MATCH_CHAR:
+            packed[i].operand = (unsigned char)instr->operand.character;
+            break;
+
+        case RIFT_OP_JUMP:
+        case RIFT_OP_SPLIT:
+        case RIFT_OP_REPEAT_END:
+        case RIFT_OP_REPEAT_AGAIN:
+        case RIFT_OP_REPEAT_EXIT:
+            packed[i].operand = instr->operand.jump_target;
+            break;
+
+        case RIFT_OP_SAVE_START:
+        case RIFT_OP_SAVE_END:
+        case RIFT_OP_BACKREF:
+            packed[i].operand = instr->operand.group_index;
+            break;
+
+        case RIFT_OP_MATCH_CLASS:
+        case RIFT_OP_STAR_CLASS:
+            packed[i].operand = instr->operand.char_class.class_index;
+            break;
+
+        case RIFT_OP_MATCH_STRING:
+            packed[i].operand = operand_next;
+            operands[operand_next++] = instr->operand.string.offset;
+            operands[operand_next++] = instr->operand.string.length;
+            break;
+
+        case RIFT_OP_REPEAT_START:
+            packed[i].operand = operand_next;
+            operands[operand_next++] = instr->operand.repeat.min;
+            operands[operand_next++] = instr->operand.repeat.max;
+            operands[operand_next++] = instr->operand.repeat.greedy ? 1u : 0u;
+            break;
+
+        case RIFT_OP_DFA_SCAN:
+            packed[i].operand = instr->operand.dfa_index;
+            break;
+
+        default:
+            /* No operand */
+            break;
+        }
+    }
+    return operand_next;
+}
+
+/**
+ * @brief Find the first earlier range holding the same bytes as each range
+ *
+ * This hash-conses the ranges: every range gets an owner, itself when its
+ * bytes were not seen before, so equal ranges can be stored once.
+ *
+ * @param ranges The ranges, whose owner fields are set
+ * @param count Number of ranges
+ * @return true if successful, false on allocation failure
+ */
+static bool
+container_share(container_range_t *ranges, size_t count)
+{
+    size_t slots = 16;
+    while (slots < count * 2) {
+        slots *= 2;
+    }
+
+    /* Open addressing over range indices, 0 marks a free slot */
+    size_t *table = (size_t *)rift_calloc(slots, sizeof(size_t));
+    if (!table) {
+        return false;
+    }
+
+    for (size_t r = 0; r < count; r++) {
+        container_range_t *range = &ranges[r];
+        size_t slot = container_checksum(range->bytes, range->size) & (slots - 1);
+        range->owner = r;
+        while (table[slot] != 0) {
+            const container_range_t *seen = &ranges[table[slot] - 1];
+            if (seen->size == range->size &&
+                (range->size == 0 || memcmp(seen->bytes, range->bytes, range->size) == 0)) {
+                range->owner = table[slot] - 1;
+                break;
+            }
+            slot = (slot + 1) & (slots - 1);
+        }
+        if (range->owner == r) {
+            table[slot] = r + 1;
+        }
+    }
+
+    rift_free(table);
+    return true;
+}
+
+/**
+ * @brief Lay out shared ranges one after the other
+ *
+ * Owners get the next free offset and every other range that of its owner.
+ *
+ * @param ranges The ranges, whose offset fields are set
+ * @param count Number of ranges
+ * @return Number of bytes the owners take
+ */
+static uint64_t
+container_place(container_range_t *ranges, size_t count)
+{
+    uint64_t size = 0;
+    for (size_t r = 0; r < count; r++) {
+        if (ranges[r].owner == r) {
+            ranges[r].offset = size;
+            size += ranges[r].size;
+        } else {
+            ranges[r].offset = ranges[ranges[r].owner].offset;
+        }
+    }
+    return size;
+}
+
+/**
+ * @brief Copy the owned ranges into their section
+ *
+ * @param ranges The placed ranges
+ * @param count Number of ranges
+ * @param section Start of the section
+ */
+static void
+container_copy(const container_range_t *ranges, size_t count, uint8_t *section)
+{
+    for (size_t r = 0; r < count; r++) {
+        if (ranges[r].owner == r && ranges[r].size > 0) {
+            memcpy(section + ranges[r].offset, ranges[r].bytes, (size_t)ranges[r].size);
+        }
+    }
+}
+
+/**
+ * @brief Write programs into a container
+ *
+ * Equal instruction streams, operand rows, class tables, literal pools,
+ * patterns and DFA tables are stored once and shared by every program that
+ * has them, so rules repeating the same fragments cost their bytes once.
+ *
+ * @param programs Programs to write, in index order
+ * @param count Number of programs
+ * @param data Output buffer (can be NULL to get size)
+ * @param size Size of output buffer or pointer to store required size
+ * @return true if successful, false otherwise
+ */
+bool
+rift_bytecode_container_write(rift_bytecode_program_t *const *programs, uint32_t count,
+                              uint8_t *data, size_t *size)
+{
+    if ((!programs && count > 0) || !size) {
+        return false;
+    }
+
+    /* Size the programs' own ranges */
+    uint64_t instruction_total = 0;
+    uint64_t operand_total = 0;
+    uint64_t dfa_total = 0;
+    for (uint32_t p = 0; p < count; p++) {
+        rift_bytecode_program_t *program = programs[p];
+        if (!program || !ensure_class_rows(program)) {
+            return false;
+        }
+
+        instruction_total += program->instruction_count;
+        for (uint32_t i = 0; i < program->instruction_count; i++) {
+            operand_total += operand_words(program->instructions[i].opcode);
+        }
+        for (uint32_t t = 0; t < program->dfa_table_count; t++) {
+            dfa_total += rift_dfa_table_encoded_size(program->dfa_tables[t]);
+        }
+    }
+
+    /* Index entries hold 32-bit offsets */
+    if (instruction_total > UINT32_MAX || operand_total > UINT32_MAX ||
+        dfa_total > UINT32_MAX) {
+        return false;
+    }
+
+    /* Pack everything first, so equal ranges can be found by their bytes */
+    size_t range_count = (size_t)count * CONTAINER_RANGE_KINDS;
+    container_range_t *ranges =
+        (container_range_t *)rift_calloc(range_count + 1, sizeof(container_range_t));
+    rift_bytecode_packed_t *packed = (rift_bytecode_packed_t *)rift_malloc(
+        (size_t)instruction_total * sizeof(rift_bytecode_packed_t) + 1);
+    uint32_t *operands = (uint32_t *)rift_malloc((size_t)operand_total * sizeof(uint32_t) + 1);
+    uint8_t *encoded = (uint8_t *)rift_malloc((size_t)dfa_total + 1);
+    if (!ranges || !packed || !operands || !encoded) {
+        rift_free(encoded);
+        rift_free(operands);
+        rift_free(packed);
+        rift_free(ranges);
+        return false;
+    }
+
+    container_range_t *instruction_ranges = ranges;
+    container_range_t *operand_ranges = ranges + count;
+    container_range_t *class_ranges = ranges + (size_t)count * 2;
+    container_range_t *dfa_ranges = ranges + (size_t)count * 3;
+    container_range_t *string_ranges = ranges + (size_t)count * 4;
+
+    size_t instruction_next = 0;
+    size_t operand_next = 0;
+    size_t dfa_next = 0;
+    for (uint32_t p = 0; p < count; p++) {
+        const rift_bytecode_program_t *program = programs[p];
+
+        uint32_t words = pack_program(program, packed + instruction_next, operands + operand_next);
+        instruction_ranges[p].bytes = (const uint8_t *)(packed + instruction_next);
+        instruction_ranges[p].size = program->instruction_count * sizeof(rift_bytecode_packed_t);
+        operand_ranges[p].bytes = (const uint8_t *)(operands + operand_next);
+        operand_ranges[p].size = words * sizeof(uint32_t);
+        instruction_next += program->instruction_count;
+        operand_next += words;
+
+        if (program->char_class_map) {
+            class_ranges[p].bytes = (const uint8_t *)program->char_class_map;
+            class_ranges[p].size = (uint64_t)program->char_class_count *
+                                   RIFT_BYTECODE_CLASS_WORDS * sizeof(uint32_t);
+        }
+
+        /* Encodings are multiples of 8 bytes, so every table stays aligned for viewing */
+        dfa_ranges[p].bytes = encoded + dfa_next;
+        for (uint32_t t = 0; t < program->dfa_table_count; t++) {
+            rift_dfa_table_encode(program->dfa_tables[t], encoded + dfa_next);
+            dfa_next += rift_dfa_table_encoded_size(program->dfa_tables[t]);
+        }
+        dfa_ranges[p].size = encoded + dfa_next - dfa_ranges[p].bytes;
+
+        /* Literal pools and patterns share the strings section, so they share ranges too */
+        container_range_t *literal = &string_ranges[(size_t)p * 2];
+        container_range_t *pattern = &string_ranges[(size_t)p * 2 + 1];
+        if (program->literal_pool) {
+            literal->bytes = (const uint8_t *)program->literal_pool;
+            literal->size = program->literal_pool_size;
+        }
+        if (program->original_pattern) {
+            pattern->bytes = (const uint8_t *)program->original_pattern;
+            pattern->size = strlen(program->original_pattern) + 1;
+        }
+    }
+
+    /* Ranges are shared within their kind only, as each kind has its own section */
+    bool written = container_share(instruction_ranges, count) &&
+                   container_share(operand_ranges, count) &&
+                   container_share(class_ranges, count) && container_share(dfa_ranges, count) &&
+                   container_share(string_ranges, (size_t)count * 2);
+    uint64_t instruction_size = container_place(instruction_ranges, count);
+    uint64_t operand_size = container_place(operand_ranges, count);
+    uint64_t class_size = container_place(class_ranges, count);
+    uint64_t dfa_size = container_place(dfa_ranges, count);
+    uint64_t strings_size = container_place(string_ranges, (size_t)count * 2);
+    written = written && strings_size <= UINT32_MAX &&
+              class_size / (RIFT_BYTECODE_CLASS_WORDS * sizeof(uint32_t)) <= UINT32_MAX;
+
+    rift_bytecode_section_t sections[CONTAINER_SECTION_COUNT] = {
+        {RIFT_BYTECODE_SECTION_INDEX, 0, 0,
+         (uint64_t)count * sizeof(rift_bytecode_container_entry_t)},
+        {RIFT_BYTECODE_SECTION_INSTRUCTIONS, 0, 0, instruction_size},
+        {RIFT_BYTECODE_SECTION_OPERANDS, 0, 0, operand_size},
+        {RIFT_BYTECODE_SECTION_CLASSES, 0, 0, class_size},
+        {RIFT_BYTECODE_SECTION_STRINGS, 0, 0, strings_size},
+        {RIFT_BYTECODE_SECTION_DFA_TABLES, 0, 0, dfa_size},
+    };
+
+    uint64_t offset = sizeof(rift_bytecode_container_header_t) + sizeof(sections);
+    for (uint32_t s = 0; s < CONTAINER_SECTION_COUNT; s++) {
+        sections[s].offset = container_align(offset);
+        offset = sections[s].offset + sections[s].size;
+    }
+    uint64_t required_size = container_align(offset);
+
+    if (written && required_size > SIZE_MAX) {
+        written = false;
+    }
+
+    /* If data is NULL, just return the required size */
+    if (written && !data) {
+        *size = (size_t)required_size;
+    } else if (written && *size < required_size) {
+        *size = (size_t)required_size;
+        written = false;
+    } else if (written) {
+        memset(data, 0, (size_t)required_size);
+        memcpy(data + sizeof(rift_bytecode_container_header_t), sections, sizeof(sections));
+
+        rift_bytecode_container_entry_t *entries =
+            (rift_bytecode_container_entry_t *)(data + sections[0].offset);
+        container_copy(instruction_ranges, count, data + sections[1].offset);
+        container_copy(operand_ranges, count, data + sections[2].offset);
+        container_copy(class_ranges, count, data + sections[3].offset);
+        container_copy(string_ranges, (size_t)count * 2, data + sections[4].offset);
+        container_copy(dfa_ranges, count, data + sections[5].offset);
+
+        for (uint32_t p = 0; p < count; p++) {
+            const rift_bytecode_program_t *program = programs[p];
+            rift_bytecode_container_entry_t *entry = &entries[p];
+            const container_range_t *literal = &string_ranges[(size_t)p * 2];
+            const container_range_t *pattern = &string_ranges[(size_t)p * 2 + 1];
+
+            entry->flags = program->flags;
+            entry->group_count = program->group_count;
+            entry->instruction_first =
+                (uint32_t)(instruction_ranges[p].offset / sizeof(rift_bytecode_packed_t));
+            entry->instruction_count = program->instruction_count;
+            entry->operand_first = (uint32_t)(operand_ranges[p].offset / sizeof(uint32_t));
+            entry->operand_count = (uint32_t)(operand_ranges[p].size / sizeof(uint32_t));
+            entry->class_first = (uint32_t)(class_ranges[p].offset /
+                                            (RIFT_BYTECODE_CLASS_WORDS * sizeof(uint32_t)));
+            entry->class_count = program->char_class_map ? program->char_class_count : 0;
+            entry->literal_offset = (uint32_t)literal->offset;
+            entry->literal_size = (uint32_t)literal->size;
+            entry->pattern_offset = (uint32_t)pattern->offset;
+            entry->pattern_length =
+                program->original_pattern ? (uint32_t)(pattern->size - 1) : UINT32_MAX;
+            entry->dfa_offset = (uint32_t)dfa_ranges[p].offset;
+            entry->dfa_size = (uint32_t)dfa_ranges[p].size;
+        }
+
+        rift_bytecode_container_header_t header;
+        memset(&header, 0, sizeof(header));
+        header.magic = RIFT_BYTECODE_CONTAINER_MAGIC;
+        header.endianness = container_endianness();
+        header.version = RIFT_BYTECODE_CONTAINER_VERSION;
+        header.section_count = CONTAINER_SECTION_COUNT;
+        header.program_count = count;
+        header.file_size = required_size;
+        header.checksum =
+            container_checksum(data + sizeof(header), (size_t)required_size - sizeof(header));
+        memcpy(data, &header, sizeof(header));
+        *size = (size_t)required_size;
+    }
+
+    rift_free(encoded);
+    rift_free(operands);
+    rift_free(packed);
+    rift_free(ranges);
+    return written;
+}
+
+/**
+ * @brief Check the index entry of a program against the section sizes
+ *
+ * @param container The container
+ * @param entry The index entry
+ * @return true if every range of the entry lies inside its section
+ */
+static bool
+entry_is_valid(const rift_bytecode_container_t *container,
+               const rift_bytecode_container_entry_t *entry)
+{
+    if ((uint64_t)entry->instruction_first + entry->instruction_count >
+            container->instruction_total ||
+        (uint64_t)entry->operand_first + entry->operand_count > container->operand_total ||
+        (uint64_t)entry->class_first + entry->class_count > container->class_total ||
+        (uint64_t)entry->literal_offset + entry->literal_size > container->strings_size ||
+        (uint64_t)entry->dfa_offset + entry->dfa_size > container->dfa_size) {
+        return false;
+    }
+
+    if (entry->pattern_length == UINT32_MAX) {
+        return true;
+    }
+
+    /* The pattern must be terminated inside the section */
+    uint64_t end = (uint64_t)entry->pattern_offset + entry->pattern_length;
+    return end < container->strings_size && container->strings[end] == '\0';
+}
+
+/**
+ * @brief Load a container from memory without copying it
+ *
+ * @param data Container bytes, aligned to at least 8 bytes
+ * @param size Size of the container bytes
+ * @param error Error information (can be NULL)
+ * @return The loaded container or NULL on failure
+ */
+rift_bytecode_container_t *
+rift_bytecode_container_load(const uint8_t *data, size_t size, rift_regex_error_t *error)
+{
+    if (!data || size < sizeof(rift_bytecode_container_header_t) || (uintptr_t)data % 8 != 0) {
+        container_set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                            "Invalid or misaligned container data");
+        return NULL;
+    }
+
+    const rift_bytecode_container_header_t *header =
+        (const rift_bytecode_container_header_t *)data;
+    if (header->magic != RIFT_BYTECODE_CONTAINER_MAGIC) {
+        container_set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                            "Invalid container format (bad magic number)");
+        return NULL;
+    }
+
+    /* Sections are used in place, so only the native byte order can be loaded */
+    if (header->endianness != container_endianness() ||
+        header->version != RIFT_BYTECODE_CONTAINER_VERSION) {
+        container_set_error(error, RIFT_REGEX_ERROR_CONVERSION_FAILED,
+                            "Container version or byte order not supported");
+        return NULL;
+    }
+
+    if (header->file_size != size ||
+        (size - sizeof(*header)) / sizeof(rift_bytecode_section_t) < header->section_count) {
+        container_set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER, "Container data truncated");
+        return NULL;
+    }
+
+    if (container_checksum(data + sizeof(*header), size - sizeof(*header)) != header->checksum) {
+        container_set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                            "Container checksum mismatch");
+        return NULL;
+    }
+
+    rift_bytecode_container_t *container =
+        (rift_bytecode_container_t *)rift_calloc(1, sizeof(rift_bytecode_container_t));
+    if (!container) {
+        container_set_error(error, RIFT_REGEX_ERROR_MEMORY_ALLOCATION,
+                            "Failed to allocate container");
+        return NULL;
+    }
+    container->data = data;
+    container->size = size;
+    pthread_mutex_init(&container->lock, NULL);
+
+    /* Locate the sections, the first of each type wins and unknown types are skipped */
+    const rift_bytecode_section_t *sections =
+        (const rift_bytecode_section_t *)(data + sizeof(*header));
+    bool has_index = false;
+    for (uint32_t s = 0; s < header->section_count; s++) {
+        const rift_bytecode_section_t *section = &sections[s];
+        if (section->offset % RIFT_BYTECODE_CONTAINER_ALIGNMENT != 0 || section->offset > size ||
+            section->size > size - section->offset) {
+            container_set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                                "Container section out of bounds");
+            rift_bytecode_container_close(container);
+            return NULL;
+        }
+
+        const uint8_t *base = data + section->offset;
+        switch (section->type) {
+        case RIFT_BYTECODE_SECTION_INDEX:
+            if (!has_index) {
+                container->entries = (const rift_bytecode_container_entry_t *)base;
+                has_index = section->size / sizeof(rift_bytecode_container_entry_t) >=
+                            header->program_count;
+            }
+            break;
+
+        case RIFT_BYTECODE_SECTION_INSTRUCTIONS:
+            if (!container->instructions) {
+                container->instructions = (const rift_bytecode_packed_t *)base;
+                container->instruction_total = section->size / sizeof(rift_bytecode_packed_t);
+            }
+            break;
+
+        case RIFT_BYTECODE_SECTION_OPERANDS:
+            if (!container->operands) {
+                container->operands = (const uint32_t *)base;
+                container->operand_total = section->size / sizeof(uint32_t);
+            }
+            break;
+
+        case RIFT_BYTECODE_SECTION_CLASSES:
+            if (!container->classes) {
+                container->classes = (const uint32_t *)base;
+                container->class_total =
+                    section->size / (RIFT_BYTECODE_CLASS_WORDS * sizeof(uint32_t));
+            }
+            break;
+
+        case RIFT_BYTECODE_SECTION_STRINGS:
+            if (!container->strings) {
+                container->strings = (const char *)base;
+                container->strings_size = section->size;
+            }
+            break;
+
+        case RIFT_BYTECODE_SECTION_DFA_TABLES:
+            if (!container->dfa_tables) {
+                container->dfa_tables = base;
+                container->dfa_size = section->size;
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    if (!has_index) {
+        container_set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                            "Container index missing or truncated");
+        rift_bytecode_container_close(container);
+        return NULL;
+    }
+
+    for (uint32_t p = 0; p < header->program_count; p++) {
+        if (!entry_is_valid(container, &container->entries[p])) {
+            container_set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                                "Container index entry out of bounds");
+            rift_bytecode_container_close(container);
+            return NULL;
+        }
+    }
+
+    container->programs = (rift_bytecode_program_t **)rift_calloc(
+        header->program_count ? header->program_count : 1, sizeof(rift_bytecode_program_t *));
+    if (!container->programs) {
+        container_set_error(error, RIFT_REGEX_ERROR_MEMORY_ALLOCATION,
+                            "Failed to allocate container programs");
+        rift_bytecode_container_close(container);
+        return NULL;
+    }
+    container->program_count = header->program_count;
+
+    /* Programs whose entries are equal are unpacked once and shared */
+    container->owners = (uint32_t *)rift_calloc(container->program_count + 1, sizeof(uint32_t));
+    container_range_t *ranges = (container_range_t *)rift_calloc(container->program_count + 1,
+                                                                 sizeof(container_range_t));
+    bool shared = container->owners && ranges;
+    for (uint32_t p = 0; shared && p < container->program_count; p++) {
+        ranges[p].bytes = (const uint8_t *)&container->entries[p];
+        ranges[p].size = sizeof(rift_bytecode_container_entry_t);
+    }
+    shared = shared && container_share(ranges, container->program_count);
+    for (uint32_t p = 0; shared && p < container->program_count; p++) {
+        container->owners[p] = (uint32_t)ranges[p].owner;
+    }
+    rift_free(ranges);
+    if (!shared) {
+        container_set_error(error, RIFT_REGEX_ERROR_MEMORY_ALLOCATION,
+                            "Failed to allocate container programs");
+        rift_bytecode_container_close(container);
+        return NULL;
+    }
+
+    return container;
+}
+
+/**
+ * @brief Map a container file or segment read-only and load it
+ *
+ * @param fd Descriptor of the file or segment, left open
+ * @param error Error information (can be NULL)
+ * @return The loaded container or NULL on failure
+ */
+static rift_bytecode_container_t *
+container_map(int fd, rift_regex_error_t *error)
+{
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) ||
+        (size_t)info.st_size < sizeof(rift_bytecode_container_header_t)) {
+        container_set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                            "Container file is not a regular file or too small");
+        return NULL;
+    }
+
+    /* Shared so that every process mapping a segment reads the same pages */
+    size_t size = (size_t)info.st_size;
+    void *mapping = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        container_set_error(error, RIFT_REGEX_ERROR_MEMORY_ALLOCATION,
+                            "Failed to map container file");
+        return NULL;
+    }
+
+    rift_bytecode_container_t *container =
+        rift_bytecode_container_load((const uint8_t *)mapping, size, error);
+    if (!container) {
+        munmap(mapping, size);
+        return NULL;
+    }
+
+    container->mapping = mapping;
+    return container;
+}
+
+/**
+ * @brief Map a container file and load it
+ *
+ * @param path Path of the container file
+ * @param error Error information (can be NULL)
+ * @return The loaded container or NULL on failure
+ */
+rift_bytecode_container_t *
+rift_bytecode_container_open(const char *path, rift_regex_error_t *error)
+{
+    if (!path) {
+        container_set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER, "Null container path");
+        return NULL;
+    }
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        container_set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                            "Failed to open container file");
+        return NULL;
+    }
+
+    rift_bytecode_container_t *container = container_map(fd, error);
+    close(fd);
+    return container;
+}
+
+/**
+ * @brief Create an empty shared-memory segment
+ *
+ * Without a name the segment is a memfd that can be sealed, or, where memfd
+ * is not available, a POSIX shared-memory object unlinked right away.
+ *
+ * @param name Name of the POSIX shared-memory object, or NULL for an anonymous segment
+ * @return A read-write descriptor of the segment, or -1 on failure
+ */
+static int
+container_segment_create(const char *name)
+{
+    if (name) {
+        return shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    }
+
+#if defined(__linux__) && defined(MFD_ALLOW_SEALING)
+    int fd = memfd_create("rift_container", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd >= 0) {
+        return fd;
+    }
+#endif
+
+    char anonymous[64];
+    for (unsigned attempt = 0; attempt < 16; attempt++) {
+        snprintf(anonymous, sizeof(anonymous), "/rift_container_%ld_%u", (long)getpid(),
+                 attempt);
+        int fd = shm_open(anonymous, O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd >= 0) {
+            shm_unlink(anonymous);
+            return fd;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Write programs into a shared-memory segment for pre-fork servers
+ *
+ * @param programs Programs to write, in index order
+ * @param count Number of programs
+ * @param name Name of a POSIX shared-memory object to create, or NULL for an anonymous segment
+ * @param error Error information (can be NULL)
+ * @return A descriptor of the segment, or -1 on failure
+ */
+int
+rift_bytecode_container_share(rift_bytecode_program_t *const *programs, uint32_t count,
+                              const char *name, rift_regex_error_t *error)
+{
+    size_t size = 0;
+    if (!rift_bytecode_container_write(programs, count, NULL, &size)) {
+        container_set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                            "Failed to size shared container");
+        return -1;
+    }
+
+    int fd = container_segment_create(name);
+    if (fd < 0) {
+        container_set_error(error, RIFT_REGEX_ERROR_MEMORY_ALLOCATION,
+                            "Failed to create shared-memory segment");
+        return -1;
+    }
+
+    /* The writable mapping is dropped before sealing, which refuses while one exists */
+    bool written = false;
+    void *mapping = MAP_FAILED;
+    if (ftruncate(fd, (off_t)size) == 0) {
+        mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    if (mapping != MAP_FAILED) {
+        written = rift_bytecode_container_write(programs, count, (uint8_t *)mapping, &size);
+        munmap(mapping, size);
+    }
+
+    if (written) {
+#if defined(__linux__) && defined(F_SEAL_WRITE)
+        if (!name) {
+            fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL);
+        }
+#endif
+        if (name) {
+            fchmod(fd, 0400);
+        }
+        return fd;
+    }
+
+    close(fd);
+    if (name) {
+        shm_unlink(name);
+    }
+    container_set_error(error, mapping == MAP_FAILED ? RIFT_REGEX_ERROR_MEMORY_ALLOCATION
+                                                     : RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                        "Failed to write shared container");
+    return -1;
+}
+
+/**
+ * @brief Map a shared container segment read-only and load it
+ *
+ * @param fd Descriptor of the segment, left open
+ * @param error Error information (can be NULL)
+ * @return The loaded container or NULL on failure
+ */
+rift_bytecode_container_t *
+rift_bytecode_container_attach(int fd, rift_regex_error_t *error)
+{
+    if (fd < 0) {
+        container_set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                            "Invalid shared container descriptor");
+        return NULL;
+    }
+    return container_map(fd, error);
+}
+
+/**
+ * @brief Map a named shared container segment read-only and load it
+ *
+ * @param name Name of the POSIX shared-memory object
+ * @param error Error information (can be NULL)
+ * @return The loaded container or NULL on failure
+ */
+rift_bytecode_container_t *
+rift_bytecode_container_attach_name(const char *name, rift_regex_error_t *error)
+{
+    if (!name) {
+        container_set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                            "Null shared container name");
+        return NULL;
+    }
+
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) {
+        container_set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                            "Failed to open shared container");
+        return NULL;
+    }
+
+    rift_bytecode_container_t *container = container_map(fd, error);
+    close(fd);
+    return container;
+}
+
+/**
+ * @brief Remove the name of a shared container segment
+ *
+ * @param name Name of the POSIX shared-memory object
+ * @return true if the name was removed
+ */
+bool
+rift_bytecode_container_unshare(const char *name)
+{
+    return name && shm_unlink(name) == 0;
+}
+
+/**
+ * @brief Get the number of programs in a container
+ *
+ * @param container The container
+ * @return Number of programs, 0 for NULL
+ */
+uint32_t
+rift_bytecode_container_count(const rift_bytecode_container_t *container)
+{
+    return container ? container->program_count : 0;
+}
+
+/**
+ * @brief View the DFA tables of a program in place
+ *
+ * The pointer array and the table structs share one allocation, stored as
+ * program->dfa_tables.
+ *
+ * @param container The container
+ * @param entry The index entry of the program
+ * @param program The program being unpacked
+ * @param error Error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+static bool
+unpack_dfa_tables(const rift_bytecode_container_t *container,
+                  const rift_bytecode_container_entry_t *entry, rift_bytecode_program_t *program,
+                  rift_regex_error_t *error)
+{
+    const uint8_t *data = container->dfa_tables + entry->dfa_offset;
+    uint32_t count = 0;
+    for (size_t offset = 0; offset < entry->dfa_size; count++) {
+        rift_dfa_table_t view;
+        size_t used = 0;
+        if (!rift_dfa_table_view(data + offset, entry->dfa_size - offset, &view, &used, error)) {
+            return false;
+        }
+        offset += used;
+    }
+    if (count == 0) {
+        return true;
+    }
+
+    rift_dfa_table_t **tables = (rift_dfa_table_t **)rift_calloc(
+        count, sizeof(rift_dfa_table_t *) + sizeof(rift_dfa_table_t));
+    if (!tables) {
+        container_set_error(error, RIFT_REGEX_ERROR_MEMORY_ALLOCATION,
+                            "Failed to allocate container DFA tables");
+        return false;
+    }
+
+    rift_dfa_table_t *views = (rift_dfa_table_t *)(tables + count);
+    size_t offset = 0;
+    for (uint32_t t = 0; t < count; t++) {
+        size_t used = 0;
+        rift_dfa_table_view(data + offset, entry->dfa_size - offset, &views[t], &used, NULL);
+        tables[t] = &views[t];
+        offset += used;
+    }
+
+    program->dfa_tables = tables;
+    program->dfa_table_count = count;
+    return true;
+}
+
+/**
+ * @brief Unpack the instructions of one program
+ *
+ * @param container The container
+ * @param entry The index entry of the program
+ * @param error Error information (can be NULL)
+ * @return The program or NULL on failure
+ */
+static rift_bytecode_program_t *
+unpack_program(const rift_bytecode_container_t *container,
+               const rift_bytecode_container_entry_t *entry, rift_regex_error_t *error)
+{
+    rift_bytecode_program_t *program =
+        (rift_bytecode_program_t *)rift_calloc(1, sizeof(rift_bytecode_program_t));
+    if (program) {
+        program->instructions = (rift_bytecode_instruction_t *)rift_calloc(
+            entry->instruction_count ? entry->instruction_count : 1,
+            sizeof(rift_bytecode_instruction_t));
+    }
+    if (!program || !program->instructions) {
+        rift_free(program);
+        container_set_error(error, RIFT_REGEX_ERROR_MEMORY_ALLOCATION,
+                            "Failed to allocate container program");
+        return NULL;
+    }
+
+    program->instruction_count = entry->instruction_count;
+    program->capacity = entry->instruction_count;
+    program->group_count = entry->group_count;
+    program->flags = (rift_regex_flags_t)entry->flags;
+
+    /* The tables stay in the container, the VM only reads them */
+    if (entry->class_count > 0) {
+        program->char_class_map = (uint32_t *)(container->classes + (size_t)entry->class_first *
+                                                                        RIFT_BYTECODE_CLASS_WORDS);
+        program->char_class_count = entry->class_count;
+    }
+    if (entry->literal_size > 0) {
+        program->literal_pool = (char *)(container->strings + entry->literal_offset);
+        program->literal_pool_size = entry->literal_size;
+    }
+    if (entry->pattern_length != UINT32_MAX) {
+        program->original_pattern = (char *)(container->strings + entry->pattern_offset);
+    }
+
+    if (!unpack_dfa_tables(container, entry, program, error)) {
+        rift_free(program->instructions);
+        rift_free(program);
+        return NULL;
+    }
+
+    const rift_bytecode_packed_t *packed = container->instructions + entry->instruction_first;
+    const uint32_t *operands = container->operands + entry->operand_first;
+    for (uint32_t i = 0; i < entry->instruction_count; i++) {
+        rift_bytecode_instruction_t *instr = &program->instructions[i];
+        uint32_t operand = packed[i].operand;
+        instr->opcode = (rift_bytecode_opcode_t)packed[i].opcode;
+
+        bool valid = packed[i].opcode <= RIFT_OP_REPEAT_EXIT;
+        switch (instr->opcode) {
+        case RIFT_OP_MATCH_CHAR:
+            instr->operand.character = (char)operand;
+            break;
+
+        case RIFT_OP_JUMP:
+        case RIFT_OP_SPLIT:
+        case RIFT_OP_REPEAT_END:
+        case RIFT_OP_REPEAT_AGAIN:
+        case RIFT_OP_REPEAT_EXIT:
+            instr->operand.jump_target = operand;
+            break;
+
+        case RIFT_OP_SAVE_START:
+        case RIFT_OP_SAVE_END:
+        case RIFT_OP_BACKREF:
+            instr->operand.group_index = operand;
+            break;
+
+        case RIFT_OP_MATCH_CLASS:
+        case RIFT_OP_STAR_CLASS:
+            instr->operand.char_class.class_index = operand;
+            valid = operand < entry->class_count;
+            break;
+
+        case RIFT_OP_MATCH_STRING:
+            valid = operand < entry->operand_count &&
+                    entry->operand_count - operand >= CONTAINER_LITERAL_WORDS;
+            if (valid) {
+                instr->operand.string.offset = operands[operand];
+                instr->operand.string.length = operands[operand + 1];
+                valid = instr->operand.string.length <= entry->literal_size &&
+                        instr->operand.string.offset <=
+                            entry->literal_size - instr->operand.string.length;
+            }
+            break;
+
+        case RIFT_OP_REPEAT_START:
+            valid = operand < entry->operand_count &&
+                    entry->operand_count - operand >= CONTAINER_REPEAT_WORDS;
+            if (valid) {
+                instr->operand.repeat.min = operands[operand];
+                instr->operand.repeat.max = operands[operand + 1];
+                instr->operand.repeat.greedy = operands[operand + 2] != 0;
+            }
+            break;
+
+        case RIFT_OP_DFA_SCAN:
+            instr->operand.dfa_index = operand;
+            valid = operand < program->dfa_table_count;
+            break;
+
+        default:
+            /* No operand */
+            break;
+        }
+
+        if (!valid) {
+            if (error) {
+                error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+                snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                         "Invalid instruction %u in container program", i);
+            }
+            rift_free(program->dfa_tables);
+            rift_free(program->instructions);
+            rift_free(program);
+            return NULL;
+        }
+    }
+
+    return program;
+}
+
+/**
+ * @brief Get a program of a container
+ *
+ * @param container The container
+ * @param index Index of the program
+ * @param error Error information (can be NULL)
+ * @return The program or NULL on failure
+ */
+rift_bytecode_program_t *
+rift_bytecode_container_program(rift_bytecode_container_t *container, uint32_t index,
+                                rift_regex_error_t *error)
+{
+    if (!container || index >= container->program_count) {
+        container_set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                            "Null container or program index out of range");
+        return NULL;
+    }
+
+    pthread_mutex_lock(&container->lock);
+    uint32_t owner = container->owners[index];
+    rift_bytecode_program_t *program = container->programs[owner];
+    if (!program) {
+        program = unpack_program(container, &container->entries[owner], error);
+        container->programs[owner] = program;
+    }
+    pthread_mutex_unlock(&container->lock);
+
+    return program;
+}
+
+/**
+ * @brief Close a container, freeing its programs and unmapping its file or segment
+ *
+ * @param container Container to close (can be NULL)
+ */
+void
+rift_bytecode_container_close(rift_bytecode_container_t *container)
+{
+    if (!container) {
+        return;
+    }
+
+    /* Only the instruction and table arrays were allocated, the rest points into the data */
+    if (container->programs) {
+        for (uint32_t p = 0; p < container->program_count; p++) {
+            if (container->programs[p]) {
+                rift_bytecode_vm_pool_evict(container->programs[p]);
+                rift_free(container->programs[p]->dfa_tables);
+                rift_free(container->programs[p]->instructions);
+                rift_free(container->programs[p]);
+            }
+        }
+        rift_free(container->programs);
+    }
+    rift_free(container->owners);
+
+    if (container->mapping) {
+        munmap(container->mapping, container->size);
+    }
+
+    pthread_mutex_destroy(&container->lock);
+    rift_free(container);
+}
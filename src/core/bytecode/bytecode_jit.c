@@ -0,0 +1,842 @@
+/**
+ * @file bytecode_jit.c
+ * @brief Implementation of native code compilation for LibRift bytecode
+ *
+ * This file implements a small x86-64 code generator. Each instruction
+ * becomes a few machine instructions working on fixed registers; failure
+ * jumps to one shared routine that pops the backtrack stack.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/bytecode/bytecode_jit.h"
+#include <stdio.h>
+#include <string.h>
+#include "core/memory/memory.h"
+
+#if defined(__x86_64__) && (defined(__linux__) || defined(__APPLE__))
+#define RIFT_BYTECODE_JIT_X86_64 1
+#include <sys/mman.h>
+#else
+#define RIFT_BYTECODE_JIT_X86_64 0
+#endif
+
+/* Results of the generated code */
+#define JIT_RESULT_MATCH 1
+#define JIT_RESULT_NO_MATCH 0
+#define JIT_RESULT_ERROR (-1)
+#define JIT_RESULT_TIMEOUT (-2)
+#define JIT_RESULT_OVERFLOW (-3)
+
+/* Backtrack frame words: resume address (0 for a capture restore), position, star start + 1 */
+#define JIT_FRAME_WORDS 3
+
+/**
+ * @brief State shared between the caller and the generated code
+ *
+ * The generated code addresses the fields by the offsets noted.
+ */
+typedef struct {
+    const char *input;   /* 0: Input string */
+    uint64_t length;     /* 8: Input length */
+    uint64_t start;      /* 16: Start position */
+    uint64_t *stack;     /* 24: Backtrack stack base */
+    uint64_t *stack_end; /* 32: One past the last frame that fits */
+    uint32_t *captures;  /* 40: Capture positions of the VM */
+    uint64_t budget;     /* 48: Backward jumps and backtracks left */
+    uint64_t end;        /* 56: End position of a match */
+} jit_context_t;
+
+typedef int32_t (*jit_function_t)(jit_context_t *context);
+
+#if RIFT_BYTECODE_JIT_X86_64
+
+/* Labels after the instruction labels 0..instruction_count */
+enum {
+    JIT_LABEL_FAIL,
+    JIT_LABEL_FAIL_LOOP,
+    JIT_LABEL_RESTORE,
+    JIT_LABEL_NO_MATCH,
+    JIT_LABEL_TIMEOUT,
+    JIT_LABEL_OVERFLOW,
+    JIT_LABEL_EPILOGUE,
+    JIT_LABEL_COUNT
+};
+
+/**
+ * @brief A rel32 field waiting for its label
+ */
+typedef struct {
+    size_t at;      /* Offset of the field */
+    uint32_t label; /* Label it refers to */
+} jit_fixup_t;
+
+/**
+ * @brief Code being generated
+ */
+typedef struct {
+    uint8_t *code;
+    size_t size;
+    size_t capacity;
+    jit_fixup_t *fixups;
+    size_t fixup_count;
+    size_t fixup_capacity;
+    size_t *labels;         /* Offset of each label */
+    uint32_t first_special; /* First label after the instruction labels */
+    bool failed;            /* Whether an allocation failed */
+} jit_buffer_t;
+
+/**
+ * @brief Append bytes to the code
+ *
+ * @param buffer The code
+ * @param bytes Bytes to append
+ * @param count Number of bytes
+ */
+static void
+jit_emit(jit_buffer_t *buffer, const uint8_t *bytes, size_t count)
+{
+    if (buffer->failed) {
+        return;
+    }
+
+    if (buffer->size + count > buffer->capacity) {
+        size_t capacity = buffer->capacity ? buffer->capacity * 2 : 1024;
+        while (capacity < buffer->size + count) {
+            capacity *= 2;
+        }
+        uint8_t *code = (uint8_t *)rift_realloc(buffer->code, capacity);
+        if (!code) {
+            buffer->failed = true;
+            return;
+        }
+        buffer->code = code;
+        buffer->capacity = capacity;
+    }
+
+    memcpy(buffer->code + buffer->size, bytes, count);
+    buffer->size += count;
+}
+
+#define EMIT(buffer, ...)                                                                          \
+    do {                                                                                           \
+        static const uint8_t bytes_[] = {__VA_ARGS__};                                             \
+        jit_emit((buffer), bytes_, sizeof(bytes_));                                                \
+    } while (0)
+
+/**
+ * @brief Append a byte to the code
+ *
+ * @param buffer The code
+ * @param value The byte
+ */
+static void
+jit_emit_u8(jit_buffer_t *buffer, uint8_t value)
+{
+    jit_emit(buffer, &value, 1);
+}
+
+/**
+ * @brief Append a little-endian 32-bit value to the code
+ *
+ * @param buffer The code
+ * @param value The value
+ */
+static void
+jit_emit_u32(jit_buffer_t *buffer, uint32_t value)
+{
+    uint8_t bytes[4] = {(uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16),
+                        (uint8_t)(value >> 24)};
+    jit_emit(buffer, bytes, sizeof(bytes));
+}
+
+/**
+ * @brief Append a little-endian 64-bit value to the code
+ *
+ * @param buffer The code
+ * @param value The value
+ */
+static void
+jit_emit_u64(jit_buffer_t *buffer, uint64_t value)
+{
+    jit_emit_u32(buffer, (uint32_t)value);
+    jit_emit_u32(buffer, (uint32_t)(value >> 32));
+}
+
+/**
+ * @brief Append a rel32 field for a label, patched once all labels are placed
+ *
+ * @param buffer The code
+ * @param label The label
+ */
+static void
+jit_emit_label(jit_buffer_t *buffer, uint32_t label)
+{
+    if (buffer->failed) {
+        return;
+    }
+
+    if (buffer->fixup_count == buffer->fixup_capacity) {
+        size_t capacity = buffer->fixup_capacity ? buffer->fixup_capacity * 2 : 64;
+        jit_fixup_t *fixups =
+            (jit_fixup_t *)rift_realloc(buffer->fixups, capacity * sizeof(jit_fixup_t));
+        if (!fixups) {
+            buffer->failed = true;
+            return;
+        }
+        buffer->fixups = fixups;
+        buffer->fixup_capacity = capacity;
+    }
+
+    buffer->fixups[buffer->fixup_count].at = buffer->size;
+    buffer->fixups[buffer->fixup_count].label = label;
+    buffer->fixup_count++;
+    jit_emit_u32(buffer, 0);
+}
+
+/* Special label numbers follow the instruction labels */
+#define LABEL(buffer, name) ((buffer)->first_special + JIT_LABEL_##name)
+
+/**
+ * @brief Place a label at the end of the code
+ *
+ * @param buffer The code
+ * @param label The label
+ */
+static void
+jit_place(jit_buffer_t *buffer, uint32_t label)
+{
+    buffer->labels[label] = buffer->size;
+}
+
+/* jcc rel32, cc being the low byte of the 0F 8x opcode */
+static void
+jit_jcc(jit_buffer_t *buffer, uint8_t cc, uint32_t label)
+{
+    jit_emit_u8(buffer, 0x0F);
+    jit_emit_u8(buffer, cc);
+    jit_emit_label(buffer, label);
+}
+
+#define JIT_JB 0x82
+#define JIT_JAE 0x83
+#define JIT_JE 0x84
+#define JIT_JNE 0x85
+
+/* jmp rel32 */
+static void
+jit_jmp(jit_buffer_t *buffer, uint32_t label)
+{
+    jit_emit_u8(buffer, 0xE9);
+    jit_emit_label(buffer, label);
+}
+
+/* Fail to the overflow exit unless a frame fits: cmp r14, [r15+32]; jae overflow */
+static void
+jit_check_stack(jit_buffer_t *buffer)
+{
+    EMIT(buffer, 0x4D, 0x3B, 0x77, 0x20);
+    jit_jcc(buffer, JIT_JAE, LABEL(buffer, OVERFLOW));
+}
+
+/* Fail to timeout when the budget runs out: dec qword [r15+48]; jz timeout */
+static void
+jit_spend_budget(jit_buffer_t *buffer)
+{
+    EMIT(buffer, 0x49, 0xFF, 0x4F, 0x30);
+    jit_jcc(buffer, JIT_JE, LABEL(buffer, TIMEOUT));
+}
+
+/* Fail at the end of input: cmp r13, r12; jae fail */
+static void
+jit_check_input(jit_buffer_t *buffer)
+{
+    EMIT(buffer, 0x4D, 0x39, 0xE5);
+    jit_jcc(buffer, JIT_JAE, LABEL(buffer, FAIL));
+}
+
+/**
+ * @brief Push a frame resuming at a label with the current position
+ *
+ * @param buffer The code
+ * @param label Label to resume at
+ */
+static void
+jit_push_branch(jit_buffer_t *buffer, uint32_t label)
+{
+    jit_check_stack(buffer);
+    EMIT(buffer, 0x48, 0x8D, 0x05); /* lea rax, [rip+label] */
+    jit_emit_label(buffer, label);
+    EMIT(buffer, 0x49, 0x89, 0x06);                               /* mov [r14], rax */
+    EMIT(buffer, 0x4D, 0x89, 0x6E, 0x08);                         /* mov [r14+8], r13 */
+    EMIT(buffer, 0x49, 0xC7, 0x46, 0x10, 0x00, 0x00, 0x00, 0x00); /* mov qword [r14+16], 0 */
+    EMIT(buffer, 0x49, 0x83, 0xC6, 0x18);                         /* add r14, 24 */
+}
+
+/**
+ * @brief Store the current position in a capture, trailing the old value
+ *
+ * @param buffer The code
+ * @param slot Index in the captures array
+ */
+static void
+jit_save(jit_buffer_t *buffer, uint32_t slot)
+{
+    jit_check_stack(buffer);
+    EMIT(buffer, 0x49, 0x8B, 0x47, 0x28); /* mov rax, [r15+40] */
+    EMIT(buffer, 0x8B, 0x88);             /* mov ecx, [rax+slot*4] */
+    jit_emit_u32(buffer, slot * 4);
+    EMIT(buffer, 0x49, 0xC7, 0x06, 0x00, 0x00, 0x00, 0x00); /* mov qword [r14], 0 */
+    EMIT(buffer, 0x49, 0xC7, 0x46, 0x08);                   /* mov qword [r14+8], slot */
+    jit_emit_u32(buffer, slot);
+    EMIT(buffer, 0x49, 0x89, 0x4E, 0x10); /* mov [r14+16], rcx */
+    EMIT(buffer, 0x49, 0x83, 0xC6, 0x18); /* add r14, 24 */
+    EMIT(buffer, 0x44, 0x89, 0xA8);       /* mov [rax+slot*4], r13d */
+    jit_emit_u32(buffer, slot * 4);
+}
+
+/**
+ * @brief Load the bitmap of a class row into rdx
+ *
+ * @param buffer The code
+ * @param bitmap The row
+ */
+static void
+jit_load_class(jit_buffer_t *buffer, const uint32_t *bitmap)
+{
+    EMIT(buffer, 0x48, 0xBA); /* mov rdx, imm64 */
+    jit_emit_u64(buffer, (uint64_t)(uintptr_t)bitmap);
+}
+
+/**
+ * @brief Generate the code of one instruction
+ *
+ * @param buffer The code
+ * @param program The program
+ * @param index Instruction index
+ * @param classes Class bitmap row per instruction
+ */
+static void
+jit_instruction(jit_buffer_t *buffer, const rift_bytecode_program_t *program, uint32_t index,
+                const uint32_t *const *classes)
+{
+    const rift_bytecode_instruction_t *instr = &program->instructions[index];
+    uint32_t count = program->instruction_count;
+
+    switch (instr->opcode) {
+    case RIFT_OP_NOP:
+        break;
+
+    case RIFT_OP_MATCH_CHAR:
+        jit_check_input(buffer);
+        EMIT(buffer, 0x42, 0x80, 0x3C, 0x2B); /* cmp byte [rbx+r13], c */
+        jit_emit_u8(buffer, (uint8_t)instr->operand.character);
+        jit_jcc(buffer, JIT_JNE, LABEL(buffer, FAIL));
+        EMIT(buffer, 0x49, 0xFF, 0xC5); /* inc r13 */
+        break;
+
+    case RIFT_OP_MATCH_STRING: {
+        uint32_t length = instr->operand.string.length;
+        const char *literal = program->literal_pool + instr->operand.string.offset;
+
+        EMIT(buffer, 0x4C, 0x89, 0xE0); /* mov rax, r12 */
+        EMIT(buffer, 0x4C, 0x29, 0xE8); /* sub rax, r13 */
+        EMIT(buffer, 0x48, 0x3D);       /* cmp rax, length */
+        jit_emit_u32(buffer, length);
+        jit_jcc(buffer, JIT_JB, LABEL(buffer, FAIL));
+        for (uint32_t k = 0; k < length; k++) {
+            if (k < 128) {
+                EMIT(buffer, 0x42, 0x80, 0x7C, 0x2B); /* cmp byte [rbx+r13+k8], c */
+                jit_emit_u8(buffer, (uint8_t)k);
+            } else {
+                EMIT(buffer, 0x42, 0x80, 0xBC, 0x2B); /* cmp byte [rbx+r13+k32], c */
+                jit_emit_u32(buffer, k);
+            }
+            jit_emit_u8(buffer, (uint8_t)literal[k]);
+            jit_jcc(buffer, JIT_JNE, LABEL(buffer, FAIL));
+        }
+        EMIT(buffer, 0x49, 0x81, 0xC5); /* add r13, length */
+        jit_emit_u32(buffer, length);
+        break;
+    }
+
+    case RIFT_OP_MATCH_ANY:
+        jit_check_input(buffer);
+        EMIT(buffer, 0x49, 0xFF, 0xC5); /* inc r13 */
+        break;
+
+    case RIFT_OP_MATCH_CLASS:
+        jit_check_input(buffer);
+        jit_load_class(buffer, classes[index]);
+        EMIT(buffer, 0x42, 0x0F, 0xB6, 0x04, 0x2B); /* movzx eax, byte [rbx+r13] */
+        EMIT(buffer, 0x0F, 0xA3, 0x02);             /* bt [rdx], eax */
+        jit_jcc(buffer, JIT_JAE, LABEL(buffer, FAIL));
+        EMIT(buffer, 0x49, 0xFF, 0xC5); /* inc r13 */
+        break;
+
+    case RIFT_OP_STAR_CLASS:
+        EMIT(buffer, 0x4C, 0x89, 0xE9); /* mov rcx, r13 */
+        jit_load_class(buffer, classes[index]);
+        EMIT(buffer, 0x4D, 0x39, 0xE5,             /* loop: cmp r13, r12 */
+             0x73, 0x0F,                           /* jae done */
+             0x42, 0x0F, 0xB6, 0x04, 0x2B,         /* movzx eax, byte [rbx+r13] */
+             0x0F, 0xA3, 0x02,                     /* bt [rdx], eax */
+             0x73, 0x05,                           /* jae done */
+             0x49, 0xFF, 0xC5,                     /* inc r13 */
+             0xEB, 0xEC);                          /* jmp loop */
+        EMIT(buffer, 0x49, 0x39, 0xCD);            /* done: cmp r13, rcx */
+        jit_jcc(buffer, JIT_JE, index + 1);
+
+        /* One frame gives the run back a character at a time, see the fail routine */
+        jit_check_stack(buffer);
+        EMIT(buffer, 0x48, 0x8D, 0x05); /* lea rax, [rip+next] */
+        jit_emit_label(buffer, index + 1);
+        EMIT(buffer, 0x49, 0x89, 0x06);       /* mov [r14], rax */
+        EMIT(buffer, 0x49, 0x8D, 0x55, 0xFF); /* lea rdx, [r13-1] */
+        EMIT(buffer, 0x49, 0x89, 0x56, 0x08); /* mov [r14+8], rdx */
+        EMIT(buffer, 0x48, 0x8D, 0x51, 0x01); /* lea rdx, [rcx+1] */
+        EMIT(buffer, 0x49, 0x89, 0x56, 0x10); /* mov [r14+16], rdx */
+        EMIT(buffer, 0x49, 0x83, 0xC6, 0x18); /* add r14, 24 */
+        break;
+
+    case RIFT_OP_JUMP: {
+        uint32_t target = instr->operand.jump_target < count ? instr->operand.jump_target : count;
+        if (target <= index) {
+            jit_spend_budget(buffer);
+        }
+        jit_jmp(buffer, target);
+        break;
+    }
+
+    case RIFT_OP_SPLIT: {
+        uint32_t target = instr->operand.jump_target < count ? instr->operand.jump_target : count;
+        jit_push_branch(buffer, target);
+        break;
+    }
+
+    case RIFT_OP_SAVE_START:
+        jit_save(buffer, instr->operand.group_index * 2);
+        break;
+
+    case RIFT_OP_SAVE_END:
+        jit_save(buffer, instr->operand.group_index * 2 + 1);
+        break;
+
+    case RIFT_OP_ACCEPT:
+        EMIT(buffer, 0x4D, 0x89, 0x6F, 0x38);       /* mov [r15+56], r13 */
+        EMIT(buffer, 0xB8, 0x01, 0x00, 0x00, 0x00); /* mov eax, 1 */
+        jit_jmp(buffer, LABEL(buffer, EPILOGUE));
+        break;
+
+    default:
+        /* FAIL, the only remaining supported opcode */
+        jit_jmp(buffer, LABEL(buffer, FAIL));
+        break;
+    }
+}
+
+/**
+ * @brief Generate the shared routines after the instructions
+ *
+ * @param buffer The code
+ */
+static void
+jit_routines(jit_buffer_t *buffer)
+{
+    /* Running past the last instruction is an error, its label is instruction_count */
+    jit_place(buffer, buffer->first_special - 1);
+    EMIT(buffer, 0xB8, 0xFF, 0xFF, 0xFF, 0xFF); /* mov eax, -1 */
+    jit_jmp(buffer, LABEL(buffer, EPILOGUE));
+
+    jit_place(buffer, LABEL(buffer, FAIL));
+    jit_spend_budget(buffer);
+
+    jit_place(buffer, LABEL(buffer, FAIL_LOOP));
+    EMIT(buffer, 0x4D, 0x3B, 0x77, 0x18); /* cmp r14, [r15+24] */
+    jit_jcc(buffer, JIT_JE, LABEL(buffer, NO_MATCH));
+    EMIT(buffer, 0x49, 0x8B, 0x46, 0xE8); /* mov rax, [r14-24] */
+    EMIT(buffer, 0x48, 0x85, 0xC0);       /* test rax, rax */
+    jit_jcc(buffer, JIT_JE, LABEL(buffer, RESTORE));
+    EMIT(buffer, 0x4D, 0x8B, 0x6E, 0xF0, /* mov r13, [r14-16] */
+         0x49, 0x8B, 0x4E, 0xF8,         /* mov rcx, [r14-8] */
+         0x48, 0x85, 0xC9,               /* test rcx, rcx */
+         0x74, 0x0F,                     /* jz pop */
+         0x49, 0x39, 0xCD,               /* cmp r13, rcx */
+         0x72, 0x0A,                     /* jb pop */
+         0x49, 0x8D, 0x55, 0xFF,         /* lea rdx, [r13-1] */
+         0x49, 0x89, 0x56, 0xF0,         /* mov [r14-16], rdx: keep a shorter run */
+         0xFF, 0xE0,                     /* jmp rax */
+         0x49, 0x83, 0xEE, 0x18,         /* pop: sub r14, 24 */
+         0xFF, 0xE0);                    /* jmp rax */
+
+    /* A capture frame puts the old value back and keeps popping */
+    jit_place(buffer, LABEL(buffer, RESTORE));
+    EMIT(buffer, 0x49, 0x8B, 0x56, 0xF0, /* mov rdx, [r14-16] */
+         0x49, 0x8B, 0x4E, 0xF8,         /* mov rcx, [r14-8] */
+         0x49, 0x8B, 0x47, 0x28,         /* mov rax, [r15+40] */
+         0x89, 0x0C, 0x90,               /* mov [rax+rdx*4], ecx */
+         0x49, 0x83, 0xEE, 0x18);        /* sub r14, 24 */
+    jit_jmp(buffer, LABEL(buffer, FAIL_LOOP));
+
+    jit_place(buffer, LABEL(buffer, NO_MATCH));
+    EMIT(buffer, 0x31, 0xC0); /* xor eax, eax */
+    jit_jmp(buffer, LABEL(buffer, EPILOGUE));
+
+    jit_place(buffer, LABEL(buffer, TIMEOUT));
+    EMIT(buffer, 0xB8, 0xFE, 0xFF, 0xFF, 0xFF); /* mov eax, -2 */
+    jit_jmp(buffer, LABEL(buffer, EPILOGUE));
+
+    jit_place(buffer, LABEL(buffer, OVERFLOW));
+    EMIT(buffer, 0xB8, 0xFD, 0xFF, 0xFF, 0xFF); /* mov eax, -3 */
+
+    jit_place(buffer, LABEL(buffer, EPILOGUE));
+    EMIT(buffer, 0x41, 0x5F, 0x41, 0x5E, 0x41, 0x5D, 0x41, 0x5C, 0x5B, 0xC3);
+}
+
+#endif /* RIFT_BYTECODE_JIT_X86_64 */
+
+/**
+ * @brief Set an error
+ *
+ * @param error Error information (can be NULL)
+ * @param code Error code
+ * @param message Error message
+ */
+static void
+jit_set_error(rift_regex_error_t *error, rift_regex_error_code_t code, const char *message)
+{
+    if (error) {
+        error->code = code;
+        snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH, "%s", message);
+    }
+}
+
+/**
+ * @brief Check whether the JIT can generate code on this platform
+ *
+ * @return true if rift_bytecode_jit_compile can succeed
+ */
+bool
+rift_bytecode_jit_available(void)
+{
+    return RIFT_BYTECODE_JIT_X86_64;
+}
+
+#if RIFT_BYTECODE_JIT_X86_64
+
+/**
+ * @brief Check that every instruction of a program can be compiled
+ *
+ * @param program The program
+ * @return true if the program is supported
+ */
+static bool
+jit_supported(const rift_bytecode_program_t *program)
+{
+    for (uint32_t i = 0; i < program->instruction_count; i++) {
+        const rift_bytecode_instruction_t *instr = &program->instructions[i];
+
+        switch (instr->opcode) {
+        case RIFT_OP_NOP:
+        case RIFT_OP_MATCH_CHAR:
+        case RIFT_OP_MATCH_ANY:
+        case RIFT_OP_MATCH_CLASS:
+        case RIFT_OP_STAR_CLASS:
+        case RIFT_OP_JUMP:
+        case RIFT_OP_SPLIT:
+        case RIFT_OP_ACCEPT:
+        case RIFT_OP_FAIL:
+            break;
+        case RIFT_OP_SAVE_START:
+        case RIFT_OP_SAVE_END:
+            if (instr->operand.group_index > program->group_count) {
+                return false;
+            }
+            break;
+        case RIFT_OP_MATCH_STRING:
+            if (!program->literal_pool ||
+                instr->operand.string.length > program->literal_pool_size ||
+                instr->operand.string.offset >
+                    program->literal_pool_size - instr->operand.string.length) {
+                return false;
+            }
+            break;
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Copy the class bitmaps of a program, building rows from patterns where needed
+ *
+ * @param program The program
+ * @param rows Output row pointer per instruction, NULL for non-class instructions
+ * @return The bitmaps, or NULL on allocation failure
+ */
+static uint32_t *
+jit_classes(const rift_bytecode_program_t *program, const uint32_t **rows)
+{
+    uint32_t count = program->instruction_count;
+    uint32_t table_rows = program->char_class_map ? program->char_class_count : 0;
+
+    /* One row per class instruction, so the table need not be shared */
+    uint32_t class_rows = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        rift_bytecode_opcode_t opcode = program->instructions[i].opcode;
+        if (opcode == RIFT_OP_MATCH_CLASS || opcode == RIFT_OP_STAR_CLASS) {
+            class_rows++;
+        }
+    }
+
+    uint32_t *classes = (uint32_t *)rift_calloc(class_rows ? class_rows : 1,
+                                                RIFT_BYTECODE_CLASS_WORDS * sizeof(uint32_t));
+    if (!classes) {
+        return NULL;
+    }
+
+    uint32_t *row = classes;
+    for (uint32_t i = 0; i < count; i++) {
+        const rift_bytecode_instruction_t *instr = &program->instructions[i];
+        rows[i] = NULL;
+        if (instr->opcode != RIFT_OP_MATCH_CLASS && instr->opcode != RIFT_OP_STAR_CLASS) {
+            continue;
+        }
+
+        if (instr->operand.char_class.class_index < table_rows) {
+            memcpy(row,
+                   program->char_class_map +
+                       instr->operand.char_class.class_index * RIFT_BYTECODE_CLASS_WORDS,
+                   RIFT_BYTECODE_CLASS_WORDS * sizeof(uint32_t));
+        } else if (instr->operand.char_class.class_pattern) {
+            for (uint32_t k = 0; k < instr->operand.char_class.pattern_length; k++) {
+                unsigned char c = (unsigned char)instr->operand.char_class.class_pattern[k];
+                row[c >> 5] |= (uint32_t)1 << (c & 31);
+            }
+        }
+        rows[i] = row;
+        row += RIFT_BYTECODE_CLASS_WORDS;
+    }
+
+    return classes;
+}
+
+/**
+ * @brief Generate the code of a program
+ *
+ * @param buffer The code, with labels allocated
+ * @param program The program
+ * @param rows Class row per instruction
+ */
+static void
+jit_generate(jit_buffer_t *buffer, const rift_bytecode_program_t *program,
+             const uint32_t *const *rows)
+{
+    /* rbx input, r12 length, r13 position, r14 backtrack stack top, r15 context */
+    EMIT(buffer, 0x53, 0x41, 0x54, 0x41, 0x55, 0x41, 0x56, 0x41, 0x57); /* push */
+    EMIT(buffer, 0x49, 0x89, 0xFF,                                      /* mov r15, rdi */
+         0x49, 0x8B, 0x5F, 0x00,                                        /* mov rbx, [r15] */
+         0x4D, 0x8B, 0x67, 0x08,                                        /* mov r12, [r15+8] */
+         0x4D, 0x8B, 0x6F, 0x10,                                        /* mov r13, [r15+16] */
+         0x4D, 0x8B, 0x77, 0x18);                                       /* mov r14, [r15+24] */
+
+    for (uint32_t i = 0; i < program->instruction_count; i++) {
+        jit_place(buffer, i);
+        jit_instruction(buffer, program, i, rows);
+    }
+
+    jit_routines(buffer);
+
+    if (!buffer->failed) {
+        for (size_t f = 0; f < buffer->fixup_count; f++) {
+            const jit_fixup_t *fixup = &buffer->fixups[f];
+            int32_t rel = (int32_t)((int64_t)buffer->labels[fixup->label] -
+                                    (int64_t)(fixup->at + 4));
+            memcpy(buffer->code + fixup->at, &rel, sizeof(rel));
+        }
+    }
+}
+
+#endif /* RIFT_BYTECODE_JIT_X86_64 */
+
+/**
+ * @brief Compile a program to native code
+ *
+ * @param program The program to compile
+ * @param error Pointer to store error information (can be NULL)
+ * @return The compiled program or NULL on failure
+ */
+rift_bytecode_jit_t *
+rift_bytecode_jit_compile(const rift_bytecode_program_t *program, rift_regex_error_t *error)
+{
+    if (!program || !program->instructions) {
+        jit_set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER, "Null bytecode program");
+        return NULL;
+    }
+
+#if RIFT_BYTECODE_JIT_X86_64
+    if (!jit_supported(program)) {
+        jit_set_error(error, RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE,
+                      "Program uses instructions the JIT does not support");
+        return NULL;
+    }
+
+    uint32_t count = program->instruction_count;
+    rift_bytecode_jit_t *jit = (rift_bytecode_jit_t *)rift_calloc(1, sizeof(rift_bytecode_jit_t));
+    const uint32_t **rows = (const uint32_t **)rift_malloc((count + 1) * sizeof(uint32_t *));
+    jit_buffer_t buffer;
+    memset(&buffer, 0, sizeof(buffer));
+    buffer.first_special = count + 1;
+    buffer.labels = (size_t *)rift_calloc(count + 1 + JIT_LABEL_COUNT, sizeof(size_t));
+    if (jit) {
+        jit->classes = rows ? jit_classes(program, rows) : NULL;
+    }
+
+    bool success = jit && rows && buffer.labels && jit->classes;
+    if (success) {
+        jit_generate(&buffer, program, rows);
+        success = !buffer.failed;
+    }
+
+    /* Write the code, then make it executable and read-only */
+    if (success) {
+        void *code = mmap(NULL, buffer.size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                          -1, 0);
+        if (code == MAP_FAILED) {
+            success = false;
+        } else {
+            memcpy(code, buffer.code, buffer.size);
+            jit->code = code;
+            jit->code_size = buffer.size;
+            success = mprotect(code, buffer.size, PROT_READ | PROT_EXEC) == 0;
+        }
+    }
+
+    rift_free(buffer.code);
+    rift_free(buffer.fixups);
+    rift_free(buffer.labels);
+    rift_free((void *)rows);
+
+    if (!success) {
+        rift_bytecode_jit_free(jit);
+        jit_set_error(error, RIFT_REGEX_ERROR_MEMORY, "Failed to allocate memory for native code");
+        return NULL;
+    }
+
+    jit->program = program;
+    jit->capture_count = program->group_count + 1;
+    return jit;
+#else
+    jit_set_error(error, RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE,
+                  "No native code generator for this platform");
+    return NULL;
+#endif
+}
+
+/**
+ * @brief Execute a program through its native code
+ *
+ * @param jit Compiled program (can be NULL)
+ * @param program Bytecode program to execute
+ * @param vm VM instance to use, its captures receive the groups
+ * @param match Output match result (can be NULL)
+ * @return true if pattern matched, false otherwise
+ */
+bool
+rift_bytecode_jit_execute(const rift_bytecode_jit_t *jit, rift_bytecode_program_t *program,
+                          rift_bytecode_vm_t *vm, rift_regex_match_t *match)
+{
+    if (!jit || !jit->code || jit->program != program || !vm ||
+        vm->capture_count < jit->capture_count) {
+        return rift_bytecode_execute(program, vm, match);
+    }
+
+    rift_bytecode_vm_reset(vm);
+    if (vm->max_instructions == 0) {
+        vm->timed_out = true;
+        return false;
+    }
+
+    jit_context_t context;
+    context.input = vm->input;
+    context.length = vm->input_length;
+    context.start = vm->current_pos;
+    context.captures = vm->captures;
+    context.budget = vm->max_instructions;
+    context.end = 0;
+
+    jit_function_t function;
+    memcpy(&function, &jit->code, sizeof(function));
+
+    int32_t result;
+    for (;;) {
+        /* Frames live in the VM's backtrack stack, grown and rerun when full */
+        vm->captures[0] = (uint32_t)context.start;
+        vm->captures[1] = (uint32_t)-1;
+        context.stack = (uint64_t *)(void *)vm->backtrack_stack;
+        context.stack_end =
+            context.stack + (vm->stack_capacity * sizeof(uint32_t) / (JIT_FRAME_WORDS * 8)) *
+                                JIT_FRAME_WORDS;
+
+        result = function(&context);
+        if (result != JIT_RESULT_OVERFLOW) {
+            break;
+        }
+
+        uint32_t capacity = vm->stack_capacity * 2;
+        uint32_t *stack =
+            (uint32_t *)rift_realloc(vm->backtrack_stack, capacity * sizeof(uint32_t));
+        if (!stack) {
+            vm->instruction_counter = vm->max_instructions - context.budget;
+            return false;
+        }
+        vm->backtrack_stack = stack;
+        vm->stack_capacity = capacity;
+        for (uint32_t i = 2; i < jit->capture_count * 2; i++) {
+            vm->captures[i] = (uint32_t)-1;
+        }
+    }
+
+    vm->instruction_counter = vm->max_instructions - context.budget;
+
+    /* Let the interpreter finish what the native budget could not, bit-state may apply there */
+    if (result == JIT_RESULT_TIMEOUT) {
+        return rift_bytecode_execute(program, vm, match);
+    }
+
+    if (result != JIT_RESULT_MATCH) {
+        return false;
+    }
+
+    vm->current_pos = (uint32_t)context.end;
+    vm->captures[1] = (uint32_t)context.end;
+    if (match) {
+        match->start_pos = vm->captures[0];
+        match->end_pos = vm->captures[1];
+        match->group_count = vm->capture_count;
+    }
+    return true;
+}
+
+/**
+ * @brief Free a compiled program
+ *
+ * @param jit Compiled program to free (can be NULL)
+ */
+void
+rift_bytecode_jit_free(rift_bytecode_jit_t *jit)
+{
+    if (!jit) {
+        return;
+    }
+
+#if RIFT_BYTECODE_JIT_X86_64
+    if (jit->code) {
+        munmap(jit->code, jit->code_size);
+    }
+#endif
+    rift_free(jit->classes);
+    rift_free(jit);
+}
@@ -0,0 +1,405 @@
+/**
+ * @file bytecode_optimizer.c
+ * @brief Implementation of the peephole optimizer for LibRift bytecode
+ *
+ * This file implements the passes that fuse instruction sequences into
+ * superinstructions, thread jumps and drop dead code and NOPs.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/bytecode/bytecode_optimizer.h"
+#include <stdio.h>
+#include <string.h>
+#include "core/bytecode/bytecode_program.h"
+#include "core/memory/memory.h"
+
+/* Remapping table entry of a removed instruction */
+#define REMOVED_INSTRUCTION ((uint32_t)-1)
+
+/**
+ * @brief Set an allocation error
+ *
+ * @param error Error information (can be NULL)
+ * @param message Error message
+ */
+static void
+set_memory_error(rift_regex_error_t *error, const char *message)
+{
+    if (error) {
+        error->code = RIFT_REGEX_ERROR_MEMORY_ALLOCATION;
+        snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH, "%s", message);
+    }
+}
+
+/**
+ * @brief Turn an instruction into a NOP, releasing its operand
+ *
+ * @param instr The instruction
+ */
+static void
+clear_instruction(rift_bytecode_instruction_t *instr)
+{
+    if (instr->opcode == RIFT_OP_MATCH_CLASS && instr->operand.char_class.class_pattern) {
+        rift_free(instr->operand.char_class.class_pattern);
+    }
+
+    instr->opcode = RIFT_OP_NOP;
+    memset(&instr->operand, 0, sizeof(instr->operand));
+}
+
+/**
+ * @brief Mark the instructions that are jump targets
+ *
+ * @param program The program
+ * @param targets Output flag per instruction
+ */
+static void
+mark_jump_targets(const rift_bytecode_program_t *program, uint8_t *targets)
+{
+    memset(targets, 0, program->instruction_count);
+    for (uint32_t i = 0; i < program->instruction_count; i++) {
+        const rift_bytecode_instruction_t *instr = &program->instructions[i];
+        if ((instr->opcode == RIFT_OP_JUMP || instr->opcode == RIFT_OP_SPLIT) &&
+            instr->operand.jump_target < program->instruction_count) {
+            targets[instr->operand.jump_target] = 1;
+        }
+    }
+}
+
+/**
+ * @brief Fuse greedy class loops into STAR_CLASS
+ *
+ * The loop is SPLIT to the exit, MATCH_CLASS, JUMP back to the SPLIT, with
+ * the exit right after the JUMP. STAR_CLASS consumes the longest run of class
+ * members and falls through to the exit.
+ *
+ * @param program The program
+ * @param targets Jump target flag per instruction
+ */
+static void
+fuse_star_class(rift_bytecode_program_t *program, const uint8_t *targets)
+{
+    rift_bytecode_instruction_t *code = program->instructions;
+
+    for (uint32_t i = 0; i + 2 < program->instruction_count; i++) {
+        if (code[i].opcode != RIFT_OP_SPLIT || code[i].operand.jump_target != i + 3 ||
+            code[i + 1].opcode != RIFT_OP_MATCH_CLASS || code[i + 2].opcode != RIFT_OP_JUMP ||
+            code[i + 2].operand.jump_target != i || targets[i + 1] || targets[i + 2]) {
+            continue;
+        }
+
+        uint32_t class_index = code[i + 1].operand.char_class.class_index;
+        code[i].opcode = RIFT_OP_STAR_CLASS;
+        memset(&code[i].operand, 0, sizeof(code[i].operand));
+        code[i].operand.char_class.class_index = class_index;
+        clear_instruction(&code[i + 1]);
+        clear_instruction(&code[i + 2]);
+        i += 2;
+    }
+}
+
+/**
+ * @brief Fuse runs of MATCH_CHAR into MATCH_STRING
+ *
+ * @param program The program
+ * @param targets Jump target flag per instruction
+ * @param error Error information (can be NULL)
+ * @return true if successful, false on allocation failure
+ */
+static bool
+fuse_match_string(rift_bytecode_program_t *program, const uint8_t *targets,
+                  rift_regex_error_t *error)
+{
+    rift_bytecode_instruction_t *code = program->instructions;
+
+    for (uint32_t i = 0; i < program->instruction_count; i++) {
+        if (code[i].opcode != RIFT_OP_MATCH_CHAR) {
+            continue;
+        }
+
+        /* Only the first character of a run may be jumped to */
+        uint32_t end = i + 1;
+        while (end < program->instruction_count && code[end].opcode == RIFT_OP_MATCH_CHAR &&
+               !targets[end]) {
+            end++;
+        }
+
+        uint32_t length = end - i;
+        if (length < 2) {
+            continue;
+        }
+
+        char *pool = (char *)rift_realloc(program->literal_pool,
+                                          (size_t)program->literal_pool_size + length);
+        if (!pool) {
+            set_memory_error(error, "Failed to allocate memory for the literal pool");
+            return false;
+        }
+        program->literal_pool = pool;
+
+        uint32_t offset = program->literal_pool_size;
+        for (uint32_t j = 0; j < length; j++) {
+            pool[offset + j] = code[i + j].operand.character;
+        }
+        program->literal_pool_size += length;
+
+        code[i].opcode = RIFT_OP_MATCH_STRING;
+        memset(&code[i].operand, 0, sizeof(code[i].operand));
+        code[i].operand.string.offset = offset;
+        code[i].operand.string.length = length;
+        for (uint32_t j = i + 1; j < end; j++) {
+            clear_instruction(&code[j]);
+        }
+        i = end - 1;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Send jumps straight to the end of JUMP chains
+ *
+ * @param program The program
+ */
+static void
+thread_jumps(rift_bytecode_program_t *program)
+{
+    rift_bytecode_instruction_t *code = program->instructions;
+    uint32_t count = program->instruction_count;
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (code[i].opcode != RIFT_OP_JUMP && code[i].opcode != RIFT_OP_SPLIT) {
+            continue;
+        }
+
+        /* A chain longer than the program is a loop of jumps, left as it is */
+        uint32_t target = code[i].operand.jump_target;
+        uint32_t steps = 0;
+        while (target < count && code[target].opcode == RIFT_OP_JUMP && steps < count) {
+            target = code[target].operand.jump_target;
+            steps++;
+        }
+        if (steps < count) {
+            code[i].operand.jump_target = target;
+        }
+    }
+}
+
+/**
+ * @brief Drop jumps that land where execution would fall through anyway
+ *
+ * A JUMP over NOPs only does nothing, so it becomes a NOP itself. Scanning
+ * backwards lets a run of such jumps collapse in one pass.
+ *
+ * @param program The program
+ */
+static void
+drop_fallthrough_jumps(rift_bytecode_program_t *program)
+{
+    rift_bytecode_instruction_t *code = program->instructions;
+
+    for (uint32_t i = program->instruction_count; i-- > 0;) {
+        if (code[i].opcode != RIFT_OP_JUMP || code[i].operand.jump_target <= i) {
+            continue;
+        }
+
+        uint32_t next = i + 1;
+        while (next < code[i].operand.jump_target && code[next].opcode == RIFT_OP_NOP) {
+            next++;
+        }
+        if (next == code[i].operand.jump_target) {
+            clear_instruction(&code[i]);
+        }
+    }
+}
+
+/**
+ * @brief Drop instructions no path from the first instruction reaches
+ *
+ * @param program The program
+ * @param reachable Scratch flag per instruction
+ * @param worklist Scratch list with room for one entry per instruction
+ */
+static void
+remove_dead_code(rift_bytecode_program_t *program, uint8_t *reachable, uint32_t *worklist)
+{
+    rift_bytecode_instruction_t *code = program->instructions;
+    uint32_t count = program->instruction_count;
+    uint32_t pending = 0;
+
+    memset(reachable, 0, count);
+    if (count > 0) {
+        reachable[0] = 1;
+        worklist[pending++] = 0;
+    }
+
+    while (pending > 0) {
+        uint32_t i = worklist[--pending];
+        uint32_t successors[2];
+        uint32_t num_successors = 0;
+
+        switch (code[i].opcode) {
+        case RIFT_OP_ACCEPT:
+        case RIFT_OP_FAIL:
+            break;
+        case RIFT_OP_JUMP:
+            successors[num_successors++] = code[i].operand.jump_target;
+            break;
+        case RIFT_OP_SPLIT:
+            successors[num_successors++] = code[i].operand.jump_target;
+            successors[num_successors++] = i + 1;
+            break;
+        default:
+            successors[num_successors++] = i + 1;
+            break;
+        }
+
+        for (uint32_t s = 0; s < num_successors; s++) {
+            if (successors[s] < count && !reachable[successors[s]]) {
+                reachable[successors[s]] = 1;
+                worklist[pending++] = successors[s];
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (!reachable[i]) {
+            clear_instruction(&code[i]);
+        }
+    }
+}
+
+/**
+ * @brief Remove NOP instructions and renumber jump targets
+ *
+ * @param program The program
+ * @param remap Scratch table with one entry per instruction
+ */
+static void
+remove_nops(rift_bytecode_program_t *program, uint32_t *remap)
+{
+    rift_bytecode_instruction_t *code = program->instructions;
+    uint32_t count = program->instruction_count;
+
+    /* First pass: count NOPs and build the remapping table */
+    uint32_t write_idx = 0;
+    for (uint32_t read_idx = 0; read_idx < count; read_idx++) {
+        if (code[read_idx].opcode != RIFT_OP_NOP) {
+            remap[read_idx] = write_idx++;
+        } else {
+            remap[read_idx] = REMOVED_INSTRUCTION;
+        }
+    }
+
+    /* If no NOPs, nothing to do; a program of NOPs only is kept as it is */
+    if (write_idx == count || write_idx == 0) {
+        return;
+    }
+
+    /* A jump into the trailing NOPs runs off the end, keep the last one for it to land on */
+    uint32_t last_kept = count - 1;
+    while (remap[last_kept] == REMOVED_INSTRUCTION) {
+        last_kept--;
+    }
+    for (uint32_t i = 0; i < count && last_kept < count - 1; i++) {
+        if ((code[i].opcode == RIFT_OP_JUMP || code[i].opcode == RIFT_OP_SPLIT) &&
+            code[i].operand.jump_target > last_kept) {
+            remap[count - 1] = write_idx++;
+            break;
+        }
+    }
+
+    /* Second pass: compact the instruction array */
+    write_idx = 0;
+    for (uint32_t read_idx = 0; read_idx < count; read_idx++) {
+        if (remap[read_idx] != REMOVED_INSTRUCTION) {
+            if (write_idx != read_idx) {
+                code[write_idx] = code[read_idx];
+            }
+            write_idx++;
+        }
+    }
+
+    /* Third pass: update jump targets */
+    for (uint32_t i = 0; i < write_idx; i++) {
+        rift_bytecode_instruction_t *instr = &code[i];
+
+        if (instr->opcode == RIFT_OP_JUMP || instr->opcode == RIFT_OP_SPLIT) {
+            uint32_t old_target = instr->operand.jump_target;
+
+            /* A NOP falls through, so a jump to it goes to the next kept instruction */
+            while (remap[old_target] == REMOVED_INSTRUCTION) {
+                old_target++;
+            }
+
+            instr->operand.jump_target = remap[old_target];
+        } else if (instr->opcode == RIFT_OP_REPEAT_END || instr->opcode == RIFT_OP_REPEAT_AGAIN ||
+                   instr->opcode == RIFT_OP_REPEAT_EXIT) {
+            /* The REPEAT_START a counter instruction names is never a NOP */
+            instr->operand.jump_target = remap[instr->operand.jump_target];
+        }
+    }
+
+    program->instruction_count = write_idx;
+}
+
+/**
+ * @brief Run the peephole passes over a bytecode program
+ *
+ * @param program The program to optimize
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false on allocation failure
+ */
+bool
+rift_bytecode_peephole_optimize(rift_bytecode_program_t *program, rift_regex_error_t *error)
+{
+    if (!program) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Null bytecode program");
+        }
+        return false;
+    }
+
+    if (program->instruction_count == 0) {
+        return true;
+    }
+
+    /* The rewritten program has to be validated again */
+    program->verified = false;
+
+    /* Give every character class a bitmap and drop unused or duplicate ones */
+    if (!rift_bytecode_program_build_class_map(program)) {
+        set_memory_error(error, "Failed to allocate memory for the character class table");
+        return false;
+    }
+
+    uint32_t count = program->instruction_count;
+    uint8_t *flags = (uint8_t *)rift_malloc(count);
+    uint32_t *scratch = (uint32_t *)rift_malloc(count * sizeof(uint32_t));
+    if (!flags || !scratch) {
+        rift_free(flags);
+        rift_free(scratch);
+        set_memory_error(error, "Failed to allocate memory for bytecode optimization");
+        return false;
+    }
+
+    /* Fusion keeps every jump target, and threading only moves jumps to existing targets */
+    mark_jump_targets(program, flags);
+    fuse_star_class(program, flags);
+    bool success = fuse_match_string(program, flags, error);
+
+    if (success) {
+        thread_jumps(program);
+        remove_dead_code(program, flags, scratch);
+        drop_fallthrough_jumps(program);
+        remove_nops(program, scratch);
+    }
+
+    rift_free(flags);
+    rift_free(scratch);
+    return success;
+}
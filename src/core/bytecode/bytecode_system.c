@@ -10,7 +10,10 @@
  */
 
 #include "core/bytecode/bytecode_system.h"
+#include "core/automaton/dfa_table.h"
 #include "core/bytecode/bytecode.h"
+#include "core/bytecode/bytecode_optimizer.h"
+#include "core/bytecode/bytecode_program.h"
 
 
 /**
@@ -48,6 +51,12 @@ rift_bytecode_program_create(size_t initial_capacity, rift_regex_flags_t flags)
     program->flags = flags;
     program->original_pattern = NULL;
     program->char_class_map = NULL;
+    program->char_class_count = 0;
+    program->literal_pool = NULL;
+    program->literal_pool_size = 0;
+    program->dfa_tables = NULL;
+    program->dfa_table_count = 0;
+    program->verified = false;
 
     return program;
 }
@@ -117,6 +126,7 @@ rift_bytecode_program_add_instruction(rift_bytecode_program_t *program,
     memset(&program->instructions[index].operand, 0, sizeof(program->instructions[index].operand));
 
     program->instruction_count++;
+    program->verified = false;
     return index;
 }
 
@@ -141,6 +151,163 @@ rift_bytecode_program_set_char_operand(rift_bytecode_program_t *program, int32_t
     return true;
 }
 
+/**
+ * @brief Build the bitmap of a class pattern
+ *
+ * @param class_pattern Member bytes of the class (can be NULL if pattern_length is 0)
+ * @param pattern_length Number of member bytes
+ * @param bitmap Output of RIFT_BYTECODE_CLASS_WORDS words
+ */
+static void
+class_bitmap_from_pattern(const char *class_pattern, uint32_t pattern_length, uint32_t *bitmap)
+{
+    memset(bitmap, 0, RIFT_BYTECODE_CLASS_WORDS * sizeof(uint32_t));
+    for (uint32_t i = 0; i < pattern_length; i++) {
+        unsigned char c = (unsigned char)class_pattern[i];
+        bitmap[c >> 5] |= (uint32_t)1 << (c & 31);
+    }
+}
+
+/**
+ * @brief Find the row of a class bitmap in a class table
+ *
+ * @param map The class table
+ * @param count Number of rows in the table
+ * @param bitmap The bitmap to look for
+ * @return The row of the bitmap or count if it is not in the table
+ */
+static uint32_t
+find_class_row(const uint32_t *map, uint32_t count, const uint32_t *bitmap)
+{
+    uint32_t row = 0;
+    while (row < count && memcmp(map + row * RIFT_BYTECODE_CLASS_WORDS, bitmap,
+                                 RIFT_BYTECODE_CLASS_WORDS * sizeof(uint32_t)) != 0) {
+        row++;
+    }
+    return row;
+}
+
+/**
+ * @brief Add a character class bitmap to the program's class table
+ *
+ * @param program The bytecode program
+ * @param bitmap RIFT_BYTECODE_CLASS_WORDS words, bit c set for each member byte c
+ * @return The row of the class in char_class_map or -1 on failure
+ */
+int32_t
+rift_bytecode_program_add_class(rift_bytecode_program_t *program, const uint32_t *bitmap)
+{
+    if (!program || !bitmap || program->char_class_count >= INT32_MAX) {
+        return -1;
+    }
+
+    /* Identical classes share a row */
+    uint32_t row = find_class_row(program->char_class_map, program->char_class_count, bitmap);
+    if (row < program->char_class_count) {
+        return (int32_t)row;
+    }
+
+    uint32_t *map = (uint32_t *)rift_realloc(
+        program->char_class_map,
+        (program->char_class_count + 1) * RIFT_BYTECODE_CLASS_WORDS * sizeof(uint32_t));
+    if (!map) {
+        return -1;
+    }
+
+    memcpy(map + row * RIFT_BYTECODE_CLASS_WORDS, bitmap,
+           RIFT_BYTECODE_CLASS_WORDS * sizeof(uint32_t));
+    program->char_class_map = map;
+    program->char_class_count++;
+    return (int32_t)row;
+}
+
+/**
+ * @brief Add a DFA table to the program for DFA_SCAN instructions
+ *
+ * @param program The bytecode program
+ * @param table The table, owned by the program on success
+ * @return The index of the table in dfa_tables or -1 on failure
+ */
+int32_t
+rift_bytecode_program_add_dfa_table(rift_bytecode_program_t *program, rift_dfa_table_t *table)
+{
+    if (!program || !table || program->dfa_table_count >= INT32_MAX) {
+        return -1;
+    }
+
+    rift_dfa_table_t **tables = (rift_dfa_table_t **)rift_realloc(
+        program->dfa_tables, (program->dfa_table_count + 1) * sizeof(rift_dfa_table_t *));
+    if (!tables) {
+        return -1;
+    }
+
+    tables[program->dfa_table_count] = table;
+    program->dfa_tables = tables;
+    return (int32_t)program->dfa_table_count++;
+}
+
+/**
+ * @brief Rebuild the class table from the MATCH_CLASS instructions
+ *
+ * @param program The bytecode program
+ * @return true if successful, false on allocation failure
+ */
+bool
+rift_bytecode_program_build_class_map(rift_bytecode_program_t *program)
+{
+    if (!program) {
+        return false;
+    }
+
+    /* Size the table for one row per instruction so no instruction is left half updated */
+    uint32_t class_count = 0;
+    for (uint32_t i = 0; i < program->instruction_count; i++) {
+        if (program->instructions[i].opcode == RIFT_OP_MATCH_CLASS ||
+            program->instructions[i].opcode == RIFT_OP_STAR_CLASS) {
+            class_count++;
+        }
+    }
+
+    uint32_t *map = NULL;
+    if (class_count > 0) {
+        map = (uint32_t *)rift_malloc(class_count * RIFT_BYTECODE_CLASS_WORDS * sizeof(uint32_t));
+        if (!map) {
+            return false;
+        }
+    }
+
+    uint32_t rows = 0;
+    for (uint32_t i = 0; i < program->instruction_count; i++) {
+        rift_bytecode_instruction_t *instr = &program->instructions[i];
+        if (instr->opcode != RIFT_OP_MATCH_CLASS && instr->opcode != RIFT_OP_STAR_CLASS) {
+            continue;
+        }
+
+        uint32_t *bitmap = map + rows * RIFT_BYTECODE_CLASS_WORDS;
+        uint32_t old_row = instr->operand.char_class.class_index;
+        if (instr->operand.char_class.class_pattern) {
+            class_bitmap_from_pattern(instr->operand.char_class.class_pattern,
+                                      instr->operand.char_class.pattern_length, bitmap);
+        } else if (program->char_class_map && old_row < program->char_class_count) {
+            memcpy(bitmap, program->char_class_map + old_row * RIFT_BYTECODE_CLASS_WORDS,
+                   RIFT_BYTECODE_CLASS_WORDS * sizeof(uint32_t));
+        } else {
+            class_bitmap_from_pattern(NULL, 0, bitmap);
+        }
+
+        uint32_t row = find_class_row(map, rows, bitmap);
+        if (row == rows) {
+            rows++;
+        }
+        instr->operand.char_class.class_index = row;
+    }
+
+    rift_free(program->char_class_map);
+    program->char_class_map = map;
+    program->char_class_count = rows;
+    return true;
+}
+
 /**
  * @brief Set the operand for a character class match instruction
  *
@@ -168,6 +335,15 @@ rift_bytecode_program_set_class_operand(rift_bytecode_program_t *program, int32_
     /* Copy the pattern */
     memcpy(pattern_copy, class_pattern, pattern_length);
 
+    /* Add the class bitmap to the class table */
+    uint32_t bitmap[RIFT_BYTECODE_CLASS_WORDS];
+    class_bitmap_from_pattern(class_pattern, pattern_length, bitmap);
+    int32_t class_index = rift_bytecode_program_add_class(program, bitmap);
+    if (class_index < 0) {
+        rift_free(pattern_copy);
+        return false;
+    }
+
     /* Free any existing pattern */
     if (program->instructions[index].operand.char_class.class_pattern) {
         rift_free(program->instructions[index].operand.char_class.class_pattern);
@@ -176,6 +352,7 @@ rift_bytecode_program_set_class_operand(rift_bytecode_program_t *program, int32_
     /* Set the new pattern */
     program->instructions[index].operand.char_class.class_pattern = pattern_copy;
     program->instructions[index].operand.char_class.pattern_length = pattern_length;
+    program->instructions[index].operand.char_class.class_index = (uint32_t)class_index;
 
     return true;
 }
@@ -200,6 +377,7 @@ rift_bytecode_program_set_jump_target(rift_bytecode_program_t *program, int32_t
     }
 
     program->instructions[index].operand.jump_target = target_index;
+    program->verified = false;
     return true;
 }
 
@@ -223,6 +401,7 @@ rift_bytecode_program_set_group_operand(rift_bytecode_program_t *program, int32_
     }
 
     program->instructions[index].operand.group_index = group_index;
+    program->verified = false;
     return true;
 }
 
@@ -291,6 +470,7 @@ rift_bytecode_program_set_group_count(rift_bytecode_program_t *program, uint32_t
     }
 
     program->group_count = group_count;
+    program->verified = false;
     return true;
 }
 
@@ -351,11 +531,39 @@ rift_bytecode_program_clone(const rift_bytecode_program_t *program)
         }
     }
 
-    /* Clone character class map if present */
-    if (program->char_class_map) {
-        /* This would require knowing the size of the map which isn't stored */
-        /* For now, we leave it as NULL and handle it at runtime */
-        clone->char_class_map = NULL;
+    /* Clone the character class table if present */
+    if (program->char_class_map && program->char_class_count > 0) {
+        size_t map_size = program->char_class_count * RIFT_BYTECODE_CLASS_WORDS * sizeof(uint32_t);
+        clone->char_class_map = (uint32_t *)rift_malloc(map_size);
+        if (!clone->char_class_map) {
+            rift_bytecode_program_free(clone);
+            return NULL;
+        }
+
+        memcpy(clone->char_class_map, program->char_class_map, map_size);
+        clone->char_class_count = program->char_class_count;
+    }
+
+    /* Clone the literal pool if present */
+    if (program->literal_pool && program->literal_pool_size > 0) {
+        clone->literal_pool = (char *)rift_malloc(program->literal_pool_size);
+        if (!clone->literal_pool) {
+            rift_bytecode_program_free(clone);
+            return NULL;
+        }
+
+        memcpy(clone->literal_pool, program->literal_pool, program->literal_pool_size);
+        clone->literal_pool_size = program->literal_pool_size;
+    }
+
+    /* Clone the DFA tables */
+    for (uint32_t i = 0; i < program->dfa_table_count; i++) {
+        rift_dfa_table_t *table = rift_dfa_table_clone(program->dfa_tables[i]);
+        if (!table || rift_bytecode_program_add_dfa_table(clone, table) < 0) {
+            rift_dfa_table_free(table);
+            rift_bytecode_program_free(clone);
+            return NULL;
+        }
     }
 
     return clone;
@@ -396,6 +604,17 @@ rift_bytecode_program_free(rift_bytecode_program_t *program)
         rift_free(program->char_class_map);
     }
 
+    /* Free the literal pool */
+    if (program->literal_pool) {
+        rift_free(program->literal_pool);
+    }
+
+    /* Free the DFA tables */
+    for (uint32_t i = 0; i < program->dfa_table_count; i++) {
+        rift_dfa_table_free(program->dfa_tables[i]);
+    }
+    rift_free(program->dfa_tables);
+
     /* Free the program itself */
     rift_free(program);
 }
@@ -421,6 +640,7 @@ rift_bytecode_validate(rift_bytecode_program_t *program, rift_regex_error_t *err
     }
 
     /* Validate program fields */
+    program->verified = false;
         if (!program->instructions || program->instruction_count == 0) {
         if (error) {
             error->code = RIFT_REGEX_ERROR_INVALID_AUTOMATON;
@@ -435,6 +655,29 @@ rift_bytecode_validate(rift_bytecode_program_t *program, rift_regex_error_t *err
     for (uint32_t i = 0; i < program->instruction_count; i++) {
         rift_bytecode_instruction_t *instr = &program->instructions[i];
 
+        /* Validate opcodes */
+        if (instr->opcode > RIFT_OP_REPEAT_EXIT) {
+            if (error) {
+                error->code = RIFT_REGEX_ERROR_INVALID_AUTOMATON;
+                snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                         "Invalid opcode at instruction %u: %u", i, (unsigned)instr->opcode);
+            }
+            return false;
+        }
+
+        /* Validate the loops of counter instructions */
+        if ((instr->opcode == RIFT_OP_REPEAT_END || instr->opcode == RIFT_OP_REPEAT_AGAIN ||
+             instr->opcode == RIFT_OP_REPEAT_EXIT) &&
+            (instr->operand.jump_target >= program->instruction_count ||
+             program->instructions[instr->operand.jump_target].opcode != RIFT_OP_REPEAT_START)) {
+            if (error) {
+                error->code = RIFT_REGEX_ERROR_INVALID_AUTOMATON;
+                snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                         "Invalid repeat start at instruction %u", i);
+            }
+            return false;
+        }
+
         /* Validate jump and split targets */
         if (instr->opcode == RIFT_OP_JUMP || instr->opcode == RIFT_OP_SPLIT) {
             if (instr->operand.jump_target >= program->instruction_count) {
@@ -475,8 +718,49 @@ rift_bytecode_validate(rift_bytecode_program_t *program, rift_regex_error_t *err
                 return false;
             }
         }
+
+        /* Validate class table rows */
+        if (instr->opcode == RIFT_OP_MATCH_CLASS || instr->opcode == RIFT_OP_STAR_CLASS) {
+            if ((program->char_class_map || instr->opcode == RIFT_OP_STAR_CLASS) &&
+                instr->operand.char_class.class_index >= program->char_class_count) {
+                if (error) {
+                    error->code = RIFT_REGEX_ERROR_INVALID_AUTOMATON;
+                    snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                             "Invalid character class at instruction %u: class %u >= %u", i,
+                             instr->operand.char_class.class_index, program->char_class_count);
+                }
+                return false;
+            }
+        }
+
+        /* Validate literals */
+        if (instr->opcode == RIFT_OP_MATCH_STRING &&
+            (!program->literal_pool || instr->operand.string.length > program->literal_pool_size ||
+             instr->operand.string.offset >
+                 program->literal_pool_size - instr->operand.string.length)) {
+            if (error) {
+                error->code = RIFT_REGEX_ERROR_INVALID_AUTOMATON;
+                snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                         "Invalid literal at instruction %u", i);
+            }
+            return false;
+        }
+
+        /* Validate DFA tables */
+        if (instr->opcode == RIFT_OP_DFA_SCAN &&
+            (instr->operand.dfa_index >= program->dfa_table_count ||
+             !program->dfa_tables[instr->operand.dfa_index])) {
+            if (error) {
+                error->code = RIFT_REGEX_ERROR_INVALID_AUTOMATON;
+                snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                         "Invalid DFA table at instruction %u: table %u >= %u", i,
+                         instr->operand.dfa_index, program->dfa_table_count);
+            }
+            return false;
+        }
     }
 
+    program->verified = true;
     return true;
 }
 
@@ -505,73 +789,13 @@ rift_bytecode_optimize(rift_bytecode_program_t *program, rift_regex_error_t *err
         return false;
     }
 
-    /* Remove NOP instructions */
-    uint32_t write_idx = 0;
-    uint32_t *remap = (uint32_t *)rift_malloc(program->instruction_count * sizeof(uint32_t));
-
-    if (!remap) {
-        if (error) {
-            error->code = RIFT_REGEX_ERROR_MEMORY_ALLOCATION;
-            strncpy(error->message, "Failed to allocate memory for instruction remapping",
-                    RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH - 1);
-            error->message[RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH - 1] = '\0';
-        }
+    /* Fuse superinstructions, thread jumps and drop dead code and NOPs */
+    if (!rift_bytecode_peephole_optimize(program, error)) {
         return false;
     }
 
-    /* First pass: count NOPs and build the remapping table */
-    for (uint32_t read_idx = 0; read_idx < program->instruction_count; read_idx++) {
-        if (program->instructions[read_idx].opcode != RIFT_OP_NOP) {
-            remap[read_idx] = write_idx++;
-        } else {
-            remap[read_idx] = (uint32_t)-1; /* Mark NOP for deletion */
-        }
-    }
-
-    /* If no NOPs, nothing to do */
-    if (write_idx == program->instruction_count) {
-        rift_free(remap);
-        return true;
-    }
-
-    /* Second pass: compact the instruction array */
-    write_idx = 0;
-    for (uint32_t read_idx = 0; read_idx < program->instruction_count; read_idx++) {
-        if (program->instructions[read_idx].opcode != RIFT_OP_NOP) {
-            if (write_idx != read_idx) {
-                program->instructions[write_idx] = program->instructions[read_idx];
-            }
-            write_idx++;
-        }
-    }
-
-    /* Third pass: update jump targets */
-    for (uint32_t i = 0; i < write_idx; i++) {
-        rift_bytecode_instruction_t *instr = &program->instructions[i];
-
-        if (instr->opcode == RIFT_OP_JUMP || instr->opcode == RIFT_OP_SPLIT) {
-            uint32_t old_target = instr->operand.jump_target;
-
-            /* Skip over NOPs for jump targets */
-            while (old_target < program->instruction_count && remap[old_target] == (uint32_t)-1) {
-                old_target++;
-            }
-
-            if (old_target < program->instruction_count) {
-                instr->operand.jump_target = remap[old_target];
-            } else {
-                /* Jump to end of program (which might be ACCEPT) */
-                instr->operand.jump_target = write_idx - 1;
-            }
-        }
-    }
-
-    /* Update instruction count */
-    program->instruction_count = write_idx;
-
-    /* Free the remapping table */
-    rift_free(remap);
-
+    /* Check the rewritten program so it stays verified */
+    rift_bytecode_validate(program, NULL);
     return true;
 }
 
@@ -615,7 +839,9 @@ rift_bytecode_debug_info(rift_bytecode_program_t *program, FILE *output)
             fprintf(dest, "MATCH_CHAR '%c'\n", instr->operand.character);
             break;
         case RIFT_OP_MATCH_CLASS:
-            fprintf(dest, "MATCH_CLASS (len: %u)\n", instr->operand.char_class.pattern_length);
+            fprintf(dest, "MATCH_CLASS (len: %u, class: %u)\n",
+                    instr->operand.char_class.pattern_length,
+                    instr->operand.char_class.class_index);
             break;
         case RIFT_OP_JUMP:
             fprintf(dest, "JUMP to %u\n", instr->operand.jump_target);
@@ -644,7 +870,7 @@ rift_bytecode_debug_info(rift_bytecode_program_t *program, FILE *output)
                     instr->operand.repeat.greedy ? "true" : "false");
             break;
         case RIFT_OP_REPEAT_END:
-            fprintf(dest, "REPEAT_END\n");
+            fprintf(dest, "REPEAT_END (start: %u)\n", instr->operand.jump_target);
             break;
         case RIFT_OP_BOUNDARY:
             fprintf(dest, "BOUNDARY\n");
@@ -658,6 +884,28 @@ rift_bytecode_debug_info(rift_bytecode_program_t *program, FILE *output)
         case RIFT_OP_NEG_LOOKAHEAD:
             fprintf(dest, "NEG_LOOKAHEAD\n");
             break;
+        case RIFT_OP_MATCH_STRING:
+            fprintf(dest, "MATCH_STRING \"%.*s\"\n", (int)instr->operand.string.length,
+                    program->literal_pool + instr->operand.string.offset);
+            break;
+        case RIFT_OP_STAR_CLASS:
+            fprintf(dest, "STAR_CLASS (class: %u)\n", instr->operand.char_class.class_index);
+            break;
+        case RIFT_OP_DFA_SCAN:
+            fprintf(dest, "DFA_SCAN (table: %u)\n", instr->operand.dfa_index);
+            break;
+        case RIFT_OP_ATOMIC_START:
+            fprintf(dest, "ATOMIC_START\n");
+            break;
+        case RIFT_OP_CUT:
+            fprintf(dest, "CUT\n");
+            break;
+        case RIFT_OP_REPEAT_AGAIN:
+            fprintf(dest, "REPEAT_AGAIN (start: %u)\n", instr->operand.jump_target);
+            break;
+        case RIFT_OP_REPEAT_EXIT:
+            fprintf(dest, "REPEAT_EXIT (start: %u)\n", instr->operand.jump_target);
+            break;
         default:
             fprintf(dest, "UNKNOWN OPCODE %u\n", instr->opcode);
             break;
@@ -10,6 +10,8 @@
  */
 
 #include "core/bytecode/bytecode_vm.h"
+#include "core/automaton/byte_class.h"
+#include "core/automaton/dfa_table.h"
 
 
 
@@ -17,16 +19,51 @@
 #define DEFAULT_STACK_CAPACITY 256
 #define DEFAULT_MAX_INSTRUCTIONS 10000000 /* Limit for preventing infinite loops */
 
-/**
- * @brief Instruction execution result
+/* Dispatch through computed goto where the compiler supports it */
+#ifndef RIFT_BYTECODE_VM_THREADED
+#if defined(__GNUC__) || defined(__clang__)
+#define RIFT_BYTECODE_VM_THREADED 1
+#else
+#define RIFT_BYTECODE_VM_THREADED 0
+#endif
+#endif
+
+/* Decoder markers, beyond the last opcode */
+#define VM_OPCODE_COUNT (RIFT_OP_REPEAT_EXIT + 1)
+#define VM_OPCODE_INVALID (VM_OPCODE_COUNT)
+#define VM_OPCODE_END (VM_OPCODE_COUNT + 1)
+
+/*
+ * Features of a run. Each interpreter loop is generated for a set of them
+ * and leaves out the work of the others, such as saving captures in every
+ * backtrack frame; a run takes the leanest loop covering its features.
  */
-typedef enum {
-    RESULT_CONTINUE, /* Continue to next instruction */
-    RESULT_JUMP,     /* Jump to specified instruction */
-    RESULT_MATCH,    /* Match found */
-    RESULT_FAIL,     /* Match failed */
-    RESULT_ERROR     /* Execution error */
-} execution_result_t;
+#define VM_FEATURE_CAPTURES (1u << 0) /* SAVE_START, SAVE_END or BACKREF: frames save captures */
+#define VM_FEATURE_COUNTERS (1u << 1) /* Counted loops: frames save their iterations */
+#define VM_FEATURE_ATOMIC (1u << 2)   /* ATOMIC_START or CUT: frames may be atomic markers */
+#define VM_FEATURE_BUDGET (1u << 3)   /* An instruction budget to enforce */
+#define VM_FEATURE_TRACE (1u << 4)    /* A trace buffer to record events in */
+#define VM_FEATURE_ALL ((1u << 5) - 1)
+
+/* Interpreter loops, leanest first, with the features each one handles */
+#define VM_LOOPS(X)                                                                                \
+    X(vm_run_lean, 0)                                                                              \
+    X(vm_run_budget, VM_FEATURE_BUDGET)                                                            \
+    X(vm_run_captures, VM_FEATURE_CAPTURES | VM_FEATURE_BUDGET)                                    \
+    X(vm_run_full, VM_FEATURE_ALL)
+
+/* Instruction index flag of a frame that gives back one character of a STAR_CLASS run */
+#define VM_BACKTRACK_STAR ((uint32_t)1 << 31)
+
+/* Instruction index flag of the marker frame ATOMIC_START pushes for CUT to find */
+#define VM_BACKTRACK_ATOMIC ((uint32_t)1 << 30)
+
+/* Operand flag of a BACKREF that ignores ASCII case */
+#define VM_BACKREF_CASELESS ((uint32_t)1 << 31)
+
+/* Fewest entries of a memo table, and the share of them that may be used */
+#define VM_MEMO_MIN_ENTRIES 64
+#define VM_MEMO_LOAD(entries) ((entries) - (entries) / 4)
 
 /**
  * @brief Backtracking entry for the VM
@@ -38,6 +75,23 @@ typedef struct {
     uint32_t *capture_end;      /* Capture group end positions */
 } backtrack_entry_t;
 
+/**
+ * @brief Get the words of a backtrack frame
+ *
+ * Frames hold the instruction, position and STAR_CLASS run start, then two
+ * words per capture and one per counted loop when the loop saves them.
+ *
+ * @param vm VM instance
+ * @param features Features of the interpreter loop
+ * @return Number of words
+ */
+static inline uint32_t
+vm_frame_words(const rift_bytecode_vm_t *vm, uint32_t features)
+{
+    return 3 + ((features & VM_FEATURE_CAPTURES) ? 2 * vm->capture_count : 0) +
+           ((features & VM_FEATURE_COUNTERS) ? vm->counter_count : 0);
+}
+
 /**
  * @brief Create a new VM for executing bytecode
  *
@@ -58,8 +112,8 @@ rift_bytecode_vm_create(rift_bytecode_program_t *program, const char *input, siz
         input_length = strlen(input);
     }
 
-    /* Allocate VM structure */
-    rift_bytecode_vm_t *vm = (rift_bytecode_vm_t *)rift_malloc(sizeof(rift_bytecode_vm_t));
+    /* Allocate VM structure from its pool */
+    rift_bytecode_vm_t *vm = (rift_bytecode_vm_t *)rift_pool_alloc(sizeof(rift_bytecode_vm_t));
     if (!vm) {
         return NULL;
     }
@@ -73,12 +127,41 @@ rift_bytecode_vm_create(rift_bytecode_program_t *program, const char *input, siz
     vm->timed_out = false;
     vm->max_instructions = DEFAULT_MAX_INSTRUCTIONS;
     vm->instruction_counter = 0;
+    vm->backtrack_pushes = 0;
+    vm->backtrack_pops = 0;
+    vm->max_stack_size = 0;
+    vm->trace = NULL;
+    vm->decoded_program = NULL;
+    vm->decoded_source = NULL;
+    vm->decoded = NULL;
+    vm->decoded_count = 0;
+    vm->decoded_capacity = 0;
+    vm->decoded_class_source = NULL;
+    vm->decoded_classes = NULL;
+    vm->decoded_class_capacity = 0;
+    vm->decoded_handlers = NULL;
+    vm->decoded_features = 0;
+    vm->decoded_has_backref = false;
+    vm->decoded_has_cut = false;
+    vm->counters = NULL;
+    vm->counter_bounds = NULL;
+    vm->counter_count = 0;
+    vm->counter_capacity = 0;
+    vm->visited = NULL;
+    vm->visited_capacity = 0;
+    vm->bit_state_limit = RIFT_BYTECODE_VM_BIT_STATE_BITS;
+    vm->bit_state = false;
+    vm->memo_words = 0;
+    vm->memo_mask = 0;
+    vm->memo_free = 0;
+    vm->decoded_backref_group_count = 0;
 
     /* Initialize capture groups */
     vm->capture_count = program->group_count + 1; /* +1 for the full match */
+    vm->capture_capacity = vm->capture_count;
     vm->captures = (uint32_t *)rift_malloc(vm->capture_count * 2 * sizeof(uint32_t));
     if (!vm->captures) {
-        rift_free(vm);
+        rift_pool_free(vm, sizeof(rift_bytecode_vm_t));
         return NULL;
     }
 
@@ -88,13 +171,15 @@ rift_bytecode_vm_create(rift_bytecode_program_t *program, const char *input, siz
     }
 
     /* Allocate backtrack stack */
-    vm->backtrack_stack = (uint32_t *)rift_malloc(vm->stack_capacity * sizeof(uint32_t) *
-                                                  (2 + 2 * vm->capture_count));
+    vm->backtrack_stack =
+        (uint32_t *)rift_malloc(vm->stack_capacity * sizeof(uint32_t) *
+                                vm_frame_words(vm, VM_FEATURE_ALL));
     if (!vm->backtrack_stack) {
         rift_free(vm->captures);
-        rift_free(vm);
+        rift_pool_free(vm, sizeof(rift_bytecode_vm_t));
         return NULL;
     }
+    vm->frame_words = vm_frame_words(vm, VM_FEATURE_ALL);
 
     return vm;
 }
@@ -119,7 +204,21 @@ rift_bytecode_vm_free(rift_bytecode_vm_t *vm)
         rift_free(vm->backtrack_stack);
     }
 
-    rift_free(vm);
+    if (vm->decoded) {
+        rift_free(vm->decoded);
+    }
+
+    if (vm->decoded_classes) {
+        rift_free(vm->decoded_classes);
+    }
+
+    if (vm->visited) {
+        rift_free(vm->visited);
+    }
+
+    rift_free(vm->counters);
+    rift_free(vm->counter_bounds);
+    rift_pool_free(vm, sizeof(rift_bytecode_vm_t));
 }
 
 /**
@@ -128,14 +227,21 @@ rift_bytecode_vm_free(rift_bytecode_vm_t *vm)
  * @param vm VM instance
  * @param instruction_index Instruction index to restore to
  * @param input_position Input position to restore to
+ * @param star_start Start of the STAR_CLASS run for flagged frames, 0 otherwise
+ * @param features Features of the interpreter loop
  * @return true if successful, false on stack overflow
  */
-static bool
-vm_push_backtrack(rift_bytecode_vm_t *vm, uint32_t instruction_index, uint32_t input_position)
+static inline bool
+vm_push_backtrack(rift_bytecode_vm_t *vm, uint32_t instruction_index, uint32_t input_position,
+                  uint32_t star_start, uint32_t features)
 {
     /* Check if we need to expand the stack */
-    if (vm->stack_size + 2 + 2 * vm->capture_count > vm->stack_capacity) {
+    uint32_t frame_words = vm_frame_words(vm, features);
+    if (vm->stack_size + frame_words > vm->stack_capacity) {
         uint32_t new_capacity = vm->stack_capacity * 2;
+        while (vm->stack_size + frame_words > new_capacity) {
+            new_capacity *= 2;
+        }
         uint32_t *new_stack =
             (uint32_t *)rift_realloc(vm->backtrack_stack, new_capacity * sizeof(uint32_t));
 
@@ -147,16 +253,30 @@ vm_push_backtrack(rift_bytecode_vm_t *vm, uint32_t instruction_index, uint32_t i
         vm->stack_capacity = new_capacity;
     }
 
-    /* Push instruction index and input position */
+    /* Push instruction index, input position and run start */
     vm->backtrack_stack[vm->stack_size++] = instruction_index;
     vm->backtrack_stack[vm->stack_size++] = input_position;
+    vm->backtrack_stack[vm->stack_size++] = star_start;
 
     /* Push capture group state */
-    for (uint32_t i = 0; i < vm->capture_count; i++) {
-        vm->backtrack_stack[vm->stack_size++] = vm->captures[i * 2];     /* Start position */
-        vm->backtrack_stack[vm->stack_size++] = vm->captures[i * 2 + 1]; /* End position */
+    if (features & VM_FEATURE_CAPTURES) {
+        for (uint32_t i = 0; i < vm->capture_count; i++) {
+            vm->backtrack_stack[vm->stack_size++] = vm->captures[i * 2];     /* Start position */
+            vm->backtrack_stack[vm->stack_size++] = vm->captures[i * 2 + 1]; /* End position */
+        }
+    }
+
+    /* Push the iterations of the counted loops */
+    if (features & VM_FEATURE_COUNTERS) {
+        for (uint32_t i = 0; i < vm->counter_count; i++) {
+            vm->backtrack_stack[vm->stack_size++] = vm->counters[i];
+        }
     }
 
+    vm->backtrack_pushes++;
+    if (vm->stack_size > vm->max_stack_size) {
+        vm->max_stack_size = vm->stack_size;
+    }
     return true;
 }
 
@@ -166,35 +286,78 @@ vm_push_backtrack(rift_bytecode_vm_t *vm, uint32_t instruction_index, uint32_t i
  * @param vm VM instance
  * @param instruction_index Pointer to store instruction index
  * @param input_position Pointer to store input position
+ * @param star_start Pointer to store the STAR_CLASS run start
+ * @param features Features of the interpreter loop
  * @return true if successful, false on stack underflow
  */
-static bool
-vm_pop_backtrack(rift_bytecode_vm_t *vm, uint32_t *instruction_index, uint32_t *input_position)
+static inline bool
+vm_pop_backtrack(rift_bytecode_vm_t *vm, uint32_t *instruction_index, uint32_t *input_position,
+                 uint32_t *star_start, uint32_t features)
 {
     /* Check if the stack is empty */
-    if (vm->stack_size < 2 + 2 * vm->capture_count) {
+    uint32_t frame_words = vm_frame_words(vm, features);
+    if (vm->stack_size < frame_words) {
         return false;
     }
 
     /* Calculate the base index for the current frame */
-    uint32_t base_index = vm->stack_size - (2 + 2 * vm->capture_count);
+    uint32_t base_index = vm->stack_size - frame_words;
 
-    /* Pop instruction index and input position */
+    /* Pop instruction index, input position and run start */
     *instruction_index = vm->backtrack_stack[base_index];
     *input_position = vm->backtrack_stack[base_index + 1];
+    *star_start = vm->backtrack_stack[base_index + 2];
 
     /* Restore capture group state */
-    for (uint32_t i = 0; i < vm->capture_count; i++) {
-        vm->captures[i * 2] = vm->backtrack_stack[base_index + 2 + i * 2];     /* Start position */
-        vm->captures[i * 2 + 1] = vm->backtrack_stack[base_index + 3 + i * 2]; /* End position */
+    uint32_t counter_base = base_index + 3;
+    if (features & VM_FEATURE_CAPTURES) {
+        for (uint32_t i = 0; i < vm->capture_count; i++) {
+            vm->captures[i * 2] = vm->backtrack_stack[base_index + 3 + i * 2]; /* Start position */
+            vm->captures[i * 2 + 1] = vm->backtrack_stack[base_index + 4 + i * 2]; /* End */
+        }
+        counter_base += 2 * vm->capture_count;
+    }
+
+    /* Restore the iterations of the counted loops */
+    if (features & VM_FEATURE_COUNTERS) {
+        for (uint32_t i = 0; i < vm->counter_count; i++) {
+            vm->counters[i] = vm->backtrack_stack[counter_base + i];
+        }
     }
 
     /* Adjust stack size */
-    vm->stack_size -= (2 + 2 * vm->capture_count);
+    vm->stack_size -= frame_words;
+    vm->backtrack_pops++;
 
     return true;
 }
 
+/**
+ * @brief Drop the backtrack points down to and including the nearest atomic marker
+ *
+ * Frames have a fixed size, so the marker is found by stepping down from the top.
+ *
+ * @param vm VM instance
+ * @param features Features of the interpreter loop
+ * @return true if successful, false if no atomic region is open
+ */
+static inline bool
+vm_cut_backtrack(rift_bytecode_vm_t *vm, uint32_t features)
+{
+    uint32_t frame_words = vm_frame_words(vm, features);
+    uint32_t base_index = vm->stack_size;
+
+    while (base_index >= frame_words) {
+        base_index -= frame_words;
+        if (vm->backtrack_stack[base_index] & VM_BACKTRACK_ATOMIC) {
+            vm->stack_size = base_index;
+            return true;
+        }
+    }
+
+    return false;
+}
+
 /**
  * @brief Reset the VM to start from the beginning
  *
@@ -211,224 +374,604 @@ rift_bytecode_vm_reset(rift_bytecode_vm_t *vm)
     vm->stack_size = 0;
     vm->timed_out = false;
     vm->instruction_counter = 0;
+    vm->backtrack_pushes = 0;
+    vm->backtrack_pops = 0;
+    vm->max_stack_size = 0;
 
     /* Reset all captures to "not set" (-1) */
     for (uint32_t i = 0; i < vm->capture_count * 2; i++) {
         vm->captures[i] = (uint32_t)-1;
     }
+
+    for (uint32_t i = 0; i < vm->counter_count; i++) {
+        vm->counters[i] = 0;
+    }
+}
+
+/**
+ * @brief Rebind a VM to a program and input for reuse
+ *
+ * @param vm VM to rebind
+ * @param program Bytecode program to execute
+ * @param input Input string to match against
+ * @param input_length Length of input string or (size_t)-1 to use strlen
+ * @return true if successful, false on invalid parameters or allocation failure
+ */
+bool
+rift_bytecode_vm_bind(rift_bytecode_vm_t *vm, rift_bytecode_program_t *program, const char *input,
+                      size_t input_length)
+{
+    if (!vm || !program || !input) {
+        return false;
+    }
+
+    /* The captures only grow, frames are sized by capture_count when pushed */
+    uint32_t capture_count = program->group_count + 1;
+    if (capture_count > vm->capture_capacity) {
+        uint32_t *captures =
+            (uint32_t *)rift_realloc(vm->captures, capture_count * 2 * sizeof(uint32_t));
+        if (!captures) {
+            return false;
+        }
+        vm->captures = captures;
+        vm->capture_capacity = capture_count;
+    }
+    vm->capture_count = capture_count;
+
+    vm->input = input;
+    vm->input_length = input_length == (size_t)-1 ? strlen(input) : input_length;
+    rift_bytecode_vm_reset(vm);
+    return true;
+}
+
+/**
+ * @brief Check whether the VM holds a decoding of a program as it is now
+ *
+ * @param vm VM instance
+ * @param program The program
+ * @return true if the decoding is current, whichever loop it was made for
+ */
+static inline bool
+vm_decoded(const rift_bytecode_vm_t *vm, const rift_bytecode_program_t *program)
+{
+    return vm->decoded_program == program && vm->decoded_source == program->instructions &&
+           vm->decoded_count == program->instruction_count &&
+           vm->decoded_class_source == program->char_class_map;
+}
+
+/**
+ * @brief Build the class bitmap of a class instruction from its pattern
+ *
+ * @param instr The instruction
+ * @param bitmap Output of RIFT_BYTECODE_CLASS_WORDS words
+ */
+static void
+vm_class_bitmap(const rift_bytecode_instruction_t *instr, uint32_t *bitmap)
+{
+    const char *class_pattern = instr->operand.char_class.class_pattern;
+    uint32_t pattern_length = class_pattern ? instr->operand.char_class.pattern_length : 0;
+
+    memset(bitmap, 0, RIFT_BYTECODE_CLASS_WORDS * sizeof(uint32_t));
+    for (uint32_t i = 0; i < pattern_length; i++) {
+        unsigned char c = (unsigned char)class_pattern[i];
+        bitmap[c >> 5] |= (uint32_t)1 << (c & 31);
+    }
 }
 
 /**
- * @brief Execute a single instruction
+ * @brief Decode a program for dispatch
+ *
+ * Every instruction is packed into 8 bytes: its handler and the one operand
+ * it needs. Jump targets are clamped to the end marker placed after the last
+ * instruction, so the loop needs no bounds checks. Instructions that can
+ * only fail with an error get the invalid handler. Every MATCH_CLASS and
+ * STAR_CLASS gets a bitmap row, taken from the program's class table or built
+ * from its class pattern when the table has none for it. MATCH_STRING keeps
+ * its literal in the program and DFA_SCAN its table, both only checked here.
+ * Every REPEAT_START gets a counter slot, which the REPEAT_END, REPEAT_AGAIN
+ * and REPEAT_EXIT naming it take as their operand.
  *
  * @param vm VM instance
  * @param program Bytecode program
- * @param instr_ptr Current instruction pointer
- * @param next_instr Pointer to store next instruction index
- * @return Execution result
+ * @param handlers Handler offset per opcode (NULL for switch dispatch)
+ * @param invalid Handler offset for invalid instructions
+ * @param end Handler offset for the end marker
+ * @return true if successful, false on allocation failure
  */
-static execution_result_t
-execute_instruction(rift_bytecode_vm_t *vm, rift_bytecode_program_t *program, uint32_t instr_ptr,
-                    uint32_t *next_instr)
+static bool
+vm_decode(rift_bytecode_vm_t *vm, const rift_bytecode_program_t *program,
+          const int32_t *handlers, int32_t invalid, int32_t end)
 {
-    /* Check if we've hit the maximum number of instructions */
-    if (vm->instruction_counter++ >= vm->max_instructions) {
-        vm->timed_out = true;
-        return RESULT_ERROR;
-    }
-
-    /* Check if instruction pointer is valid */
-    if (instr_ptr >= program->instruction_count) {
-        return RESULT_ERROR;
-    }
-
-    /* Get the current instruction */
-    rift_bytecode_instruction_t *instr = &program->instructions[instr_ptr];
-
-    /* Execute based on opcode */
-    switch (instr->opcode) {
-    case RIFT_OP_NOP:
-        /* No operation, just continue to next instruction */
-        *next_instr = instr_ptr + 1;
-        return RESULT_CONTINUE;
-
-    case RIFT_OP_MATCH_CHAR:
-        /* Match a single character */
-        if (vm->current_pos < vm->input_length &&
-            vm->input[vm->current_pos] == instr->operand.character) {
-            vm->current_pos++;
-            *next_instr = instr_ptr + 1;
-            return RESULT_CONTINUE;
+    if (vm_decoded(vm, program) && vm->decoded_handlers == handlers) {
+        return true;
+    }
+
+    /* Instruction indices share a word with the STAR_CLASS and atomic frame flags */
+    uint32_t count = program->instruction_count;
+    if (count >= VM_BACKTRACK_ATOMIC) {
+        return false;
+    }
+
+    /* The validator has proven the operands of a verified program, for captures of its size */
+    bool verified = program->verified && vm->capture_count > program->group_count;
+
+    if (count + 1 > vm->decoded_capacity) {
+        rift_bytecode_decoded_t *decoded = (rift_bytecode_decoded_t *)rift_realloc(
+            vm->decoded, (count + 1) * sizeof(rift_bytecode_decoded_t));
+        if (!decoded) {
+            return false;
         }
-        return RESULT_FAIL;
-
-    case RIFT_OP_MATCH_CLASS:
-        /* Match a character class */
-        if (vm->current_pos < vm->input_length) {
-            char current_char = vm->input[vm->current_pos];
-            const char *class_pattern = instr->operand.char_class.class_pattern;
-            uint32_t pattern_length = instr->operand.char_class.pattern_length;
-
-            /* Check if character is in the class */
-            for (uint32_t i = 0; i < pattern_length; i++) {
-                if (current_char == class_pattern[i]) {
-                    vm->current_pos++;
-                    *next_instr = instr_ptr + 1;
-                    return RESULT_CONTINUE;
-                }
-            }
+        vm->decoded = decoded;
+        vm->decoded_capacity = count + 1;
+    }
+
+    /* The program's rows come first, then one per class the table lacks */
+    uint32_t table_rows = program->char_class_map ? program->char_class_count : 0;
+    uint32_t class_rows = table_rows;
+    for (uint32_t i = 0; i < count; i++) {
+        rift_bytecode_opcode_t opcode = program->instructions[i].opcode;
+        if ((opcode == RIFT_OP_MATCH_CLASS || opcode == RIFT_OP_STAR_CLASS) &&
+            program->instructions[i].operand.char_class.class_index >= table_rows) {
+            class_rows++;
+        }
+    }
+
+    if (class_rows > vm->decoded_class_capacity) {
+        uint32_t *classes = (uint32_t *)rift_realloc(
+            vm->decoded_classes, class_rows * RIFT_BYTECODE_CLASS_WORDS * sizeof(uint32_t));
+        if (!classes) {
+            return false;
+        }
+        vm->decoded_classes = classes;
+        vm->decoded_class_capacity = class_rows;
+    }
+
+    if (table_rows > 0) {
+        memcpy(vm->decoded_classes, program->char_class_map,
+               table_rows * RIFT_BYTECODE_CLASS_WORDS * sizeof(uint32_t));
+    }
+    uint32_t next_row = table_rows;
+    vm->decoded_has_backref = false;
+    vm->decoded_has_cut = false;
+    vm->decoded_backref_group_count = 0;
+    vm->decoded_features = 0;
+
+    /* REPEAT_STARTs get their slots first, the instructions naming them may come before them */
+    uint32_t counter_count = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (program->instructions[i].opcode == RIFT_OP_REPEAT_START) {
+            counter_count++;
         }
-        return RESULT_FAIL;
-
-    case RIFT_OP_MATCH_ANY:
-        /* Match any character */
-        if (vm->current_pos < vm->input_length) {
-            vm->current_pos++;
-            *next_instr = instr_ptr + 1;
-            return RESULT_CONTINUE;
+    }
+
+    if (counter_count > vm->counter_capacity) {
+        uint32_t *counters =
+            (uint32_t *)rift_realloc(vm->counters, counter_count * sizeof(uint32_t));
+        if (!counters) {
+            return false;
         }
-        return RESULT_FAIL;
-
-    case RIFT_OP_JUMP:
-        /* Unconditional jump */
-        *next_instr = instr->operand.jump_target;
-        return RESULT_JUMP;
-
-    case RIFT_OP_SPLIT:
-        /* Split execution paths (non-deterministic choice) */
-        /* First, save the alternate path as a backtrack point */
-        if (!vm_push_backtrack(vm, instr->operand.jump_target, vm->current_pos)) {
-            return RESULT_ERROR;
+        vm->counters = counters;
+
+        uint32_t *bounds =
+            (uint32_t *)rift_realloc(vm->counter_bounds, counter_count * 2 * sizeof(uint32_t));
+        if (!bounds) {
+            return false;
         }
+        vm->counter_bounds = bounds;
+        vm->counter_capacity = counter_count;
+    }
 
-        /* Continue with the primary path */
-        *next_instr = instr_ptr + 1;
-        return RESULT_CONTINUE;
+    uint32_t next_counter = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        const rift_bytecode_instruction_t *instr = &program->instructions[i];
+        vm->decoded[i].operand = 0;
+        if (instr->opcode == RIFT_OP_REPEAT_START) {
+            vm->counter_bounds[next_counter * 2] = instr->operand.repeat.min;
+            vm->counter_bounds[next_counter * 2 + 1] = instr->operand.repeat.max;
+            vm->decoded[i].operand = next_counter++;
+        }
+    }
+    vm->counter_count = counter_count;
+    if (counter_count > 0) {
+        vm->decoded_features |= VM_FEATURE_COUNTERS;
+    }
 
-    case RIFT_OP_SAVE_START:
-        /* Save start position for a capture group */
-        {
+    for (uint32_t i = 0; i < count; i++) {
+        const rift_bytecode_instruction_t *instr = &program->instructions[i];
+        rift_bytecode_decoded_t *decoded = &vm->decoded[i];
+        uint32_t opcode = (uint32_t)instr->opcode;
+
+        switch (instr->opcode) {
+        case RIFT_OP_MATCH_CHAR:
+            decoded->operand = (unsigned char)instr->operand.character;
+            break;
+        case RIFT_OP_JUMP:
+        case RIFT_OP_SPLIT:
+            decoded->operand = verified || instr->operand.jump_target < count
+                                   ? instr->operand.jump_target
+                                   : count;
+            break;
+        case RIFT_OP_BACKREF: {
+            /* Captures decide whether a backreference matches, and key the memo table */
             uint32_t group_index = instr->operand.group_index;
-            if (group_index < vm->capture_count) {
-                vm->captures[group_index * 2] = vm->current_pos;
-                *next_instr = instr_ptr + 1;
-                return RESULT_CONTINUE;
+            bool listed = false;
+            for (uint32_t g = 0;
+                 g < vm->decoded_backref_group_count && g < RIFT_BYTECODE_VM_MEMO_GROUPS; g++) {
+                listed = listed || vm->decoded_backref_groups[g] == group_index;
+            }
+            if (!listed && vm->decoded_backref_group_count <= RIFT_BYTECODE_VM_MEMO_GROUPS) {
+                if (vm->decoded_backref_group_count < RIFT_BYTECODE_VM_MEMO_GROUPS) {
+                    vm->decoded_backref_groups[vm->decoded_backref_group_count] = group_index;
+                }
+                vm->decoded_backref_group_count++;
             }
-            return RESULT_ERROR;
-        }
 
-    case RIFT_OP_SAVE_END:
-        /* Save end position for a capture group */
-        {
-            uint32_t group_index = instr->operand.group_index;
-            if (group_index < vm->capture_count) {
-                vm->captures[group_index * 2 + 1] = vm->current_pos;
-                *next_instr = instr_ptr + 1;
-                return RESULT_CONTINUE;
+            vm->decoded_has_backref = true;
+            vm->decoded_features |= VM_FEATURE_CAPTURES;
+            if (!verified && group_index >= vm->capture_count) {
+                opcode = VM_OPCODE_INVALID;
+            }
+            decoded->operand = group_index;
+            if (program->flags & RIFT_REGEX_FLAG_CASE_INSENSITIVE) {
+                decoded->operand |= VM_BACKREF_CASELESS;
             }
-            return RESULT_ERROR;
+            break;
+        }
+        case RIFT_OP_SAVE_START:
+        case RIFT_OP_SAVE_END:
+            vm->decoded_features |= VM_FEATURE_CAPTURES;
+            if (!verified && instr->operand.group_index >= vm->capture_count) {
+                opcode = VM_OPCODE_INVALID;
+            }
+            decoded->operand = instr->operand.group_index;
+            break;
+        case RIFT_OP_MATCH_CLASS:
+        case RIFT_OP_STAR_CLASS:
+            if (instr->operand.char_class.class_index < table_rows) {
+                decoded->operand = instr->operand.char_class.class_index;
+            } else {
+                vm_class_bitmap(instr, vm->decoded_classes + next_row * RIFT_BYTECODE_CLASS_WORDS);
+                decoded->operand = next_row++;
+            }
+            break;
+        case RIFT_OP_MATCH_STRING:
+            if (verified) {
+                break;
+            }
+            if (!program->literal_pool ||
+                instr->operand.string.length > program->literal_pool_size ||
+                instr->operand.string.offset >
+                    program->literal_pool_size - instr->operand.string.length) {
+                opcode = VM_OPCODE_INVALID;
+            }
+            break;
+        case RIFT_OP_DFA_SCAN:
+            if (!verified && (instr->operand.dfa_index >= program->dfa_table_count ||
+                              !program->dfa_tables[instr->operand.dfa_index])) {
+                opcode = VM_OPCODE_INVALID;
+            }
+            decoded->operand = instr->operand.dfa_index;
+            break;
+        case RIFT_OP_CUT:
+            /* What a cut drops depends on the path taken, not just the position */
+            vm->decoded_has_cut = true;
+            vm->decoded_features |= VM_FEATURE_ATOMIC;
+            break;
+        case RIFT_OP_ATOMIC_START:
+            vm->decoded_features |= VM_FEATURE_ATOMIC;
+            break;
+        case RIFT_OP_REPEAT_END:
+        case RIFT_OP_REPEAT_AGAIN:
+        case RIFT_OP_REPEAT_EXIT:
+            if (!verified && (instr->operand.jump_target >= count ||
+                              program->instructions[instr->operand.jump_target].opcode !=
+                                  RIFT_OP_REPEAT_START)) {
+                opcode = VM_OPCODE_INVALID;
+            } else {
+                decoded->operand = vm->decoded[instr->operand.jump_target].operand;
+            }
+            break;
+        default:
+            if (!verified && opcode >= VM_OPCODE_COUNT) {
+                opcode = VM_OPCODE_INVALID;
+            }
+            break;
         }
 
-    case RIFT_OP_ACCEPT:
-        /* Accept the current input */
-        return RESULT_MATCH;
+        decoded->op = (int32_t)opcode;
+        if (handlers) {
+            decoded->op = opcode == VM_OPCODE_INVALID ? invalid : handlers[opcode];
+        }
+    }
 
-    case RIFT_OP_FAIL:
-        /* Fail the current path */
-        return RESULT_FAIL;
+    /* Running past the last instruction is an error */
+    vm->decoded[count].op = handlers ? end : (int32_t)VM_OPCODE_END;
+    vm->decoded[count].operand = 0;
 
-    case RIFT_OP_REPEAT_START:
-        /* Start of a repetition construct */
-        {
-            uint32_t min = instr->operand.repeat.min;
-            uint32_t max = instr->operand.repeat.max;
-            bool greedy = instr->operand.repeat.greedy;
+    vm->decoded_program = program;
+    vm->decoded_source = program->instructions;
+    vm->decoded_count = count;
+    vm->decoded_class_source = program->char_class_map;
+    vm->decoded_handlers = handlers;
+    return true;
+}
 
-            /* Implementation would need to track repetition counts */
-            /* This is a simplified placeholder */
+/**
+ * @brief Get the features of a program
+ *
+ * @param vm VM instance
+ * @param program The program
+ * @return Features its instructions use, from the decoder when it decoded the program
+ */
+static uint32_t
+vm_program_features(const rift_bytecode_vm_t *vm, const rift_bytecode_program_t *program)
+{
+    if (vm_decoded(vm, program)) {
+        return vm->decoded_features;
+    }
 
-            *next_instr = instr_ptr + 1;
-            return RESULT_CONTINUE;
+    uint32_t features = 0;
+    for (uint32_t i = 0; i < program->instruction_count; i++) {
+        switch (program->instructions[i].opcode) {
+        case RIFT_OP_SAVE_START:
+        case RIFT_OP_SAVE_END:
+        case RIFT_OP_BACKREF:
+            features |= VM_FEATURE_CAPTURES;
+            break;
+        case RIFT_OP_REPEAT_START:
+            features |= VM_FEATURE_COUNTERS;
+            break;
+        case RIFT_OP_ATOMIC_START:
+        case RIFT_OP_CUT:
+            features |= VM_FEATURE_ATOMIC;
+            break;
+        default:
+            break;
         }
+    }
+    return features;
+}
 
-    case RIFT_OP_REPEAT_END:
-        /* End of a repetition construct */
-        *next_instr = instr_ptr + 1;
-        return RESULT_CONTINUE;
-
-    case RIFT_OP_BOUNDARY:
-        /* Word boundary assertion */
-        {
-            bool at_boundary = false;
+/**
+ * @brief Prepare the visited bitmap when the run can use the bit-state mode
+ *
+ * @param vm VM instance, with the program decoded
+ * @return The cleared bitmap, or NULL to backtrack without memoization
+ */
+static uint32_t *
+vm_bit_state_begin(rift_bytecode_vm_t *vm)
+{
+    vm->bit_state = false;
+    vm->memo_words = 0;
+    /* Counters, like captures for a backreference, are state a position does not record */
+    if (vm->decoded_has_backref || vm->decoded_has_cut || vm->counter_count > 0 ||
+        vm->bit_state_limit == 0) {
+        return NULL;
+    }
 
-            /* Check if current position is at a word boundary */
-            if (vm->current_pos == 0 || vm->current_pos == vm->input_length) {
-                /* Start or end of input is a boundary */
-                at_boundary = true;
-            } else {
-                /* Check if transition between word and non-word character */
-                char prev = vm->input[vm->current_pos - 1];
-                char curr = vm->input[vm->current_pos];
-                bool prev_is_word = (prev >= 'a' && prev <= 'z') || (prev >= 'A' && prev <= 'Z') ||
-                                    (prev >= '0' && prev <= '9') || (prev == '_');
-                bool curr_is_word = (curr >= 'a' && curr <= 'z') || (curr >= 'A' && curr <= 'Z') ||
-                                    (curr >= '0' && curr <= '9') || (curr == '_');
-                at_boundary = prev_is_word != curr_is_word;
-            }
+    /* The end marker gets a row, jumps to it are memoized like the others */
+    size_t rows = (size_t)vm->decoded_count + 1;
+    size_t columns = vm->input_length + 1;
+    if (columns > vm->bit_state_limit / rows) {
+        return NULL;
+    }
 
-            if (at_boundary) {
-                *next_instr = instr_ptr + 1;
-                return RESULT_CONTINUE;
-            }
-            return RESULT_FAIL;
+    size_t words = (rows * columns + 31) / 32;
+    if (words > vm->visited_capacity) {
+        uint32_t *visited = (uint32_t *)rift_realloc(vm->visited, words * sizeof(uint32_t));
+        if (!visited) {
+            return NULL;
         }
+        vm->visited = visited;
+        vm->visited_capacity = words;
+    }
 
-    case RIFT_OP_BACKREF:
-        /* Backreference to a previous capture */
-        {
-            uint32_t group_index = instr->operand.group_index;
-            if (group_index >= vm->capture_count) {
-                return RESULT_ERROR;
-            }
+    memset(vm->visited, 0, words * sizeof(uint32_t));
+    vm->bit_state = true;
+    return vm->visited;
+}
 
-            uint32_t start = vm->captures[group_index * 2];
-            uint32_t end = vm->captures[group_index * 2 + 1];
+/**
+ * @brief Prepare the memo table when a run with backreferences can be memoized
+ *
+ * Past a BACKREF, what a path does depends on the spans of the groups it
+ * refers to as well as on the instruction and position, so an entry holds
+ * all of them. The table lives in the visited buffer, under the bitmap's
+ * size limit.
+ *
+ * @param vm VM instance, with the program decoded
+ * @return true if the run is memoized
+ */
+static bool
+vm_memo_begin(rift_bytecode_vm_t *vm)
+{
+    vm->memo_words = 0;
+    if (!vm->decoded_has_backref || vm->decoded_has_cut || vm->counter_count > 0 ||
+        vm->decoded_backref_group_count > RIFT_BYTECODE_VM_MEMO_GROUPS) {
+        return false;
+    }
 
-            /* If group hasn't been captured yet, fail */
-            if (start == (uint32_t)-1 || end == (uint32_t)-1) {
-                return RESULT_FAIL;
-            }
+    /* Room for every pair twice over, while it fits the limit */
+    uint32_t words = 2 + 2 * vm->decoded_backref_group_count;
+    size_t limit = vm->bit_state_limit / 32 / words;
+    size_t pairs = ((size_t)vm->decoded_count + 1) * (vm->input_length + 1);
+    size_t entries = VM_MEMO_MIN_ENTRIES;
+    if (entries > limit) {
+        return false;
+    }
+    while (entries < 2 * pairs && entries * 2 <= limit) {
+        entries *= 2;
+    }
+
+    if (entries * words > vm->visited_capacity) {
+        uint32_t *table =
+            (uint32_t *)rift_realloc(vm->visited, entries * words * sizeof(uint32_t));
+        if (!table) {
+            return false;
+        }
+        vm->visited = table;
+        vm->visited_capacity = entries * words;
+    }
 
-            /* Calculate length of captured group */
-            uint32_t length = end - start;
+    /* An instruction index of all ones marks a free entry */
+    memset(vm->visited, 0xff, entries * words * sizeof(uint32_t));
+    vm->memo_words = words;
+    vm->memo_mask = entries - 1;
+    vm->memo_free = VM_MEMO_LOAD(entries);
+    return true;
+}
 
-            /* Check if there's enough input left */
-            if (vm->current_pos + length > vm->input_length) {
-                return RESULT_FAIL;
-            }
+/**
+ * @brief Mark an (instruction, position, spans) entry as explored
+ *
+ * Once the table holds all the entries it may, new ones are not recorded and
+ * their paths are explored again, as without memoization.
+ *
+ * @param vm VM instance, at the position of the entry
+ * @param ip Instruction of the entry
+ * @return true if the entry was explored before
+ */
+static bool
+vm_memo_visit(rift_bytecode_vm_t *vm, uint32_t ip)
+{
+    uint32_t key[2 + 2 * RIFT_BYTECODE_VM_MEMO_GROUPS];
+    uint32_t words = vm->memo_words;
+    key[0] = ip;
+    key[1] = vm->current_pos;
+    uint64_t hash = (((uint64_t)ip << 32) | vm->current_pos) * 0x9e3779b97f4a7c15ULL;
+    for (uint32_t g = 0; g < vm->decoded_backref_group_count; g++) {
+        uint32_t group_index = vm->decoded_backref_groups[g];
+        key[2 + 2 * g] = vm->captures[group_index * 2];
+        key[3 + 2 * g] = vm->captures[group_index * 2 + 1];
+        hash = (hash ^ (((uint64_t)key[2 + 2 * g] << 32) | key[3 + 2 * g])) *
+               0x9e3779b97f4a7c15ULL;
+    }
 
-            /* Compare input with captured group */
-            if (memcmp(vm->input + vm->current_pos, vm->input + start, length) == 0) {
-                vm->current_pos += length;
-                *next_instr = instr_ptr + 1;
-                return RESULT_CONTINUE;
+    /* Linear probing, the table never fills up */
+    for (size_t slot = (size_t)(hash >> 32) & vm->memo_mask;;
+         slot = (slot + 1) & vm->memo_mask) {
+        uint32_t *entry = vm->visited + slot * words;
+        if (entry[0] == UINT32_MAX) {
+            if (vm->memo_free > 0) {
+                vm->memo_free--;
+                memcpy(entry, key, words * sizeof(uint32_t));
             }
-            return RESULT_FAIL;
+            return false;
         }
+        if (memcmp(entry, key, words * sizeof(uint32_t)) == 0) {
+            return true;
+        }
+    }
+}
 
-    case RIFT_OP_LOOKAHEAD:
-    case RIFT_OP_NEG_LOOKAHEAD:
-        /* Lookahead assertions would need more complex implementation */
-        /* Not fully implemented in this simplified version */
-        *next_instr = instr_ptr + 1;
-        return RESULT_CONTINUE;
-
-    default:
-        /* Unknown opcode */
-        return RESULT_ERROR;
+/**
+ * @brief Compare the text a backreference matches with its group's, ignoring ASCII case
+ *
+ * @param a The input at the current position
+ * @param b The input the group matched
+ * @param length Length of both
+ * @return true if they are equal up to ASCII case
+ */
+static inline bool
+vm_equal_caseless(const char *a, const char *b, uint32_t length)
+{
+    /* Repeated text is mostly in the same case, memcmp settles that at once */
+    if (memcmp(a, b, length) == 0) {
+        return true;
     }
+    for (uint32_t i = 0; i < length; i++) {
+        unsigned char x = (unsigned char)a[i];
+        unsigned char y = (unsigned char)b[i];
+        if (x != y && ((x | 0x20) != (y | 0x20) || (unsigned char)((x | 0x20) - 'a') > 'z' - 'a')) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Mark an (instruction, position) pair as explored
+ *
+ * @param visited The visited bitmap
+ * @param bit Bit of the pair
+ * @return true if the pair was explored before
+ */
+static inline bool
+vm_visit(uint32_t *visited, size_t bit)
+{
+    uint32_t mask = (uint32_t)1 << (bit & 31);
+    bool seen = (visited[bit >> 5] & mask) != 0;
+    visited[bit >> 5] |= mask;
+    return seen;
+}
+
+/**
+ * @brief Check whether a character is a word character
+ *
+ * @param c Character to check
+ * @return true for letters, digits and underscore
+ */
+static inline bool
+vm_is_word_char(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
 }
 
+/*
+ * Dispatch macros. VM_OP labels a handler, VM_NEXT runs the instruction at
+ * ip. Straight-line runs are counted in one step when control leaves them.
+ */
+#if RIFT_BYTECODE_VM_THREADED
+#define VM_OP(name) op_##name
+#define VM_NEXT() goto *(&&op_NOP + code[ip].op)
+#else
+#define VM_OP(name) case RIFT_OP_##name
+#define VM_NEXT() goto dispatch
+#endif
+
+#define VM_COUNT_RUN() (vm->instruction_counter += (uint64_t)(ip - run_start) + 1)
+
+/* In bit-state or memo mode, whether instruction target was seen at the current position */
+#define VM_VISITED(target)                                                                         \
+    ((visited &&                                                                                   \
+      vm_visit(visited, (size_t)(target) * (vm->input_length + 1) + vm->current_pos)) ||           \
+     (memo && vm_memo_visit(vm, (target))))
+
+/* Record an event at the current position when the VM is traced */
+#define VM_TRACE(event, location)                                                                  \
+    do {                                                                                           \
+        if ((VM_LOOP_FEATURES & VM_FEATURE_TRACE) && trace) {                                      \
+            rift_trace_buffer_record(trace, (event), (location), vm->current_pos);                 \
+        }                                                                                          \
+    } while (0)
+
+/* Stop a run that used up its budget */
+#define VM_CHECK_BUDGET()                                                                          \
+    do {                                                                                           \
+        if ((VM_LOOP_FEATURES & VM_FEATURE_BUDGET) &&                                              \
+            vm->instruction_counter >= vm->max_instructions) {                                     \
+            vm->timed_out = true;                                                                  \
+            return false;                                                                          \
+        }                                                                                          \
+    } while (0)
+
+/* Interpreter loops, one per entry of VM_LOOPS */
+#define VM_LOOP_NAME vm_run_lean
+#define VM_LOOP_FEATURES 0
+#include "core/bytecode/bytecode_vm_loop.h"
+
+#define VM_LOOP_NAME vm_run_budget
+#define VM_LOOP_FEATURES VM_FEATURE_BUDGET
+#include "core/bytecode/bytecode_vm_loop.h"
+
+#define VM_LOOP_NAME vm_run_captures
+#define VM_LOOP_FEATURES (VM_FEATURE_CAPTURES | VM_FEATURE_BUDGET)
+#include "core/bytecode/bytecode_vm_loop.h"
+
+#define VM_LOOP_NAME vm_run_full
+#define VM_LOOP_FEATURES VM_FEATURE_ALL
+#include "core/bytecode/bytecode_vm_loop.h"
+
 /**
  * @brief Execute bytecode program
  *
@@ -445,66 +988,31 @@ rift_bytecode_execute(rift_bytecode_program_t *program, rift_bytecode_vm_t *vm,
         return false;
     }
 
-    /* Reset VM state */
-    rift_bytecode_vm_reset(vm);
-
-    /* Initialize captures for full match (group 0) */
-    vm->captures[0] = vm->current_pos; /* Start at current position */
-    vm->captures[1] = (uint32_t)-1;    /* End not determined yet */
-
-    uint32_t instr_ptr = 0;
-    uint32_t next_instr = 0;
-
-    while (true) {
-        /* Execute the current instruction */
-        execution_result_t result = execute_instruction(vm, program, instr_ptr, &next_instr);
-
-        switch (result) {
-        case RESULT_CONTINUE:
-            /* Continue to next instruction */
-            instr_ptr = next_instr;
-            break;
-
-        case RESULT_JUMP:
-            /* Jump to specified instruction */
-            instr_ptr = next_instr;
-            break;
-
-        case RESULT_MATCH:
-            /* Match found - set the end position for group 0 */
-            vm->captures[1] = vm->current_pos;
-
-            /* Fill match information if provided */
-            if (match) {
-                match->start_pos = vm->captures[0];
-                match->end_pos = vm->captures[1];
-                match->group_count = vm->capture_count;
-
-                /* Match groups would be copied here in a complete implementation */
-            }
-
-            return true;
-
-        case RESULT_FAIL:
-            /* Match failed - try backtracking */
-            if (vm_pop_backtrack(vm, &instr_ptr, &vm->current_pos)) {
-                /* Successfully backtracked */
-                continue;
-            }
-
-            /* No more backtracking options, match failed */
-            return false;
+    uint32_t features = vm_program_features(vm, program);
+    if (vm->max_instructions != UINT64_MAX) {
+        features |= VM_FEATURE_BUDGET;
+    }
+    if (vm->trace) {
+        features |= VM_FEATURE_TRACE;
+    }
 
-        case RESULT_ERROR:
-            /* Execution error */
-            return false;
-        }
+#define VM_LOOP_SELECT(name, loop_features)                                                        \
+    if ((features & ~(uint32_t)(loop_features)) == 0) {                                            \
+        return name(program, vm, match);                                                           \
     }
+    VM_LOOPS(VM_LOOP_SELECT)
+#undef VM_LOOP_SELECT
 
-    /* Should never reach here */
     return false;
 }
 
+#undef VM_OP
+#undef VM_NEXT
+#undef VM_COUNT_RUN
+#undef VM_TRACE
+#undef VM_VISITED
+#undef VM_CHECK_BUDGET
+
 /**
  * @brief Create a VM instance with custom settings
  *
@@ -525,6 +1033,20 @@ rift_bytecode_vm_create_with_options(rift_bytecode_program_t *program, const cha
     return vm;
 }
 
+/**
+ * @brief Set the largest visited bitmap for the bit-state mode
+ *
+ * @param vm VM instance
+ * @param max_bits Largest bitmap in bits, 0 to always backtrack without memoization
+ */
+void
+rift_bytecode_vm_set_bit_state_limit(rift_bytecode_vm_t *vm, size_t max_bits)
+{
+    if (vm) {
+        vm->bit_state_limit = max_bits;
+    }
+}
+
 /**
  * @brief Check if VM timed out during execution
  *
@@ -537,6 +1059,31 @@ rift_bytecode_vm_timed_out(const rift_bytecode_vm_t *vm)
     return vm ? vm->timed_out : false;
 }
 
+/**
+ * @brief Get the telemetry of the last execution
+ *
+ * @param vm VM instance
+ * @param stats Pointer to store the counters
+ * @return true if successful, false otherwise
+ */
+bool
+rift_bytecode_vm_get_stats(const rift_bytecode_vm_t *vm, rift_match_stats_t *stats)
+{
+    if (!vm || !stats) {
+        return false;
+    }
+
+    rift_match_stats_reset(stats);
+    stats->attempts = 1;
+    stats->engine_attempts[RIFT_MATCH_ENGINE_BYTECODE_VM] = 1;
+    stats->engine = RIFT_MATCH_ENGINE_BYTECODE_VM;
+    stats->steps = vm->instruction_counter;
+    stats->backtrack_pushes = vm->backtrack_pushes;
+    stats->backtrack_pops = vm->backtrack_pops;
+    stats->max_stack_depth = vm->max_stack_size / vm->frame_words;
+    return true;
+}
+
 /**
  * @brief Get captured group from VM
  *
@@ -0,0 +1,207 @@
+/**
+ * @file bytecode_vm_pool.c
+ * @brief Implementation of the per-thread pool of bytecode VMs for LibRift
+ *
+ * This file implements a cache of VMs per thread. Slots are keyed by the
+ * program they last ran, and a slot is reclaimed round robin when a new
+ * program needs one.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/bytecode/bytecode_vm_pool.h"
+#include <pthread.h>
+#include "core/memory/memory.h"
+
+/**
+ * @brief One pooled VM
+ */
+typedef struct {
+    const rift_bytecode_program_t *program; /* Program the VM last ran */
+    rift_bytecode_vm_t *vm;                  /* The VM, NULL for an empty slot */
+    uint64_t max_instructions;               /* Limit the VM was created with */
+    size_t bit_state_limit;                  /* Bit-state limit the VM was created with */
+    bool in_use;                             /* Whether a caller holds the VM */
+} vm_pool_slot_t;
+
+/**
+ * @brief Pool of one thread
+ */
+typedef struct {
+    vm_pool_slot_t slots[RIFT_BYTECODE_VM_POOL_SIZE];
+    uint32_t next_victim; /* Slot reclaimed next when none is empty */
+} vm_pool_t;
+
+static pthread_key_t vm_pool_key;
+static pthread_once_t vm_pool_once = PTHREAD_ONCE_INIT;
+static bool vm_pool_key_created = false;
+
+/**
+ * @brief Free the pool of an exiting thread
+ *
+ * @param pool The thread's pool
+ */
+static void
+vm_pool_cleanup(void *pool)
+{
+    vm_pool_t *thread_pool = (vm_pool_t *)pool;
+    for (uint32_t i = 0; i < RIFT_BYTECODE_VM_POOL_SIZE; i++) {
+        rift_bytecode_vm_free(thread_pool->slots[i].vm);
+    }
+    rift_free(thread_pool);
+}
+
+/**
+ * @brief Create the thread-local key of the pools
+ */
+static void
+vm_pool_create_key(void)
+{
+    vm_pool_key_created = pthread_key_create(&vm_pool_key, vm_pool_cleanup) == 0;
+}
+
+/**
+ * @brief Get the calling thread's pool
+ *
+ * @param create Whether to create the pool when the thread has none
+ * @return The pool or NULL
+ */
+static vm_pool_t *
+vm_pool_get(bool create)
+{
+    if (pthread_once(&vm_pool_once, vm_pool_create_key) != 0 || !vm_pool_key_created) {
+        return NULL;
+    }
+
+    vm_pool_t *pool = (vm_pool_t *)pthread_getspecific(vm_pool_key);
+    if (!pool && create) {
+        pool = (vm_pool_t *)rift_calloc(1, sizeof(vm_pool_t));
+        if (pool && pthread_setspecific(vm_pool_key, pool) != 0) {
+            rift_free(pool);
+            pool = NULL;
+        }
+    }
+    return pool;
+}
+
+/**
+ * @brief Take a VM bound to a program and input from the calling thread's pool
+ *
+ * @param program Bytecode program to execute
+ * @param input Input string to match against
+ * @param input_length Length of input string or (size_t)-1 to use strlen
+ * @return A VM or NULL on failure
+ */
+rift_bytecode_vm_t *
+rift_bytecode_vm_acquire(rift_bytecode_program_t *program, const char *input, size_t input_length)
+{
+    if (!program || !input) {
+        return NULL;
+    }
+
+    vm_pool_t *pool = vm_pool_get(true);
+    if (!pool) {
+        return rift_bytecode_vm_create(program, input, input_length);
+    }
+
+    /* Prefer the slot that already decoded the program, then an empty one */
+    vm_pool_slot_t *slot = NULL;
+    vm_pool_slot_t *empty = NULL;
+    for (uint32_t i = 0; i < RIFT_BYTECODE_VM_POOL_SIZE && !slot; i++) {
+        vm_pool_slot_t *candidate = &pool->slots[i];
+        if (candidate->in_use) {
+            continue;
+        }
+        if (candidate->vm && candidate->program == program) {
+            slot = candidate;
+        } else if (!candidate->vm && !empty) {
+            empty = candidate;
+        }
+    }
+    if (!slot) {
+        slot = empty;
+    }
+
+    if (!slot) {
+        /* Reclaim a free slot round robin */
+        for (uint32_t n = 0; n < RIFT_BYTECODE_VM_POOL_SIZE; n++) {
+            vm_pool_slot_t *victim = &pool->slots[pool->next_victim];
+            pool->next_victim = (pool->next_victim + 1) % RIFT_BYTECODE_VM_POOL_SIZE;
+            if (!victim->in_use) {
+                slot = victim;
+                break;
+            }
+        }
+    }
+
+    /* Every slot is held, e.g. by a nested match */
+    if (!slot) {
+        return rift_bytecode_vm_create(program, input, input_length);
+    }
+
+    if (!slot->vm) {
+        slot->vm = rift_bytecode_vm_create(program, input, input_length);
+        if (!slot->vm) {
+            return NULL;
+        }
+        slot->max_instructions = slot->vm->max_instructions;
+        slot->bit_state_limit = slot->vm->bit_state_limit;
+    } else if (!rift_bytecode_vm_bind(slot->vm, program, input, input_length)) {
+        return NULL;
+    }
+
+    slot->vm->max_instructions = slot->max_instructions;
+    slot->vm->bit_state_limit = slot->bit_state_limit;
+    slot->program = program;
+    slot->in_use = true;
+    return slot->vm;
+}
+
+/**
+ * @brief Hand a VM back to the calling thread's pool
+ *
+ * @param vm VM returned by rift_bytecode_vm_acquire (can be NULL)
+ */
+void
+rift_bytecode_vm_release(rift_bytecode_vm_t *vm)
+{
+    if (!vm) {
+        return;
+    }
+
+    vm_pool_t *pool = vm_pool_get(false);
+    if (pool) {
+        for (uint32_t i = 0; i < RIFT_BYTECODE_VM_POOL_SIZE; i++) {
+            if (pool->slots[i].vm == vm) {
+                pool->slots[i].in_use = false;
+                return;
+            }
+        }
+    }
+
+    rift_bytecode_vm_free(vm);
+}
+
+/**
+ * @brief Forget a program in the calling thread's pool
+ *
+ * @param program The program
+ */
+void
+rift_bytecode_vm_pool_evict(const rift_bytecode_program_t *program)
+{
+    vm_pool_t *pool = vm_pool_get(false);
+    if (!pool || !program) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < RIFT_BYTECODE_VM_POOL_SIZE; i++) {
+        vm_pool_slot_t *slot = &pool->slots[i];
+        if (slot->vm && slot->program == program) {
+            /* Drop the decoded program too, the VM itself stays pooled */
+            slot->program = NULL;
+            slot->vm->decoded_program = NULL;
+        }
+    }
+}
@@ -0,0 +1,899 @@
+/**
+ * @file ambiguity.c
+ * @brief Implementation of the static catastrophic-backtracking analysis
+ *
+ * This file removes epsilon transitions from a frozen automaton, keeping a
+ * capped count of the distinct epsilon paths behind each consuming move, and
+ * then decides the degree of ambiguity with the criteria of Weber and Seidl:
+ * strongly connected components of the automaton squared for EDA, and a
+ * search over the automaton cubed between pairs of loops for IDA. The AST
+ * contributes the structural findings, nested quantifiers and
+ * backreferences.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/compiler/ambiguity.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/automaton/frozen_automaton.h"
+#include "core/memory/memory.h"
+
+/* Index meaning "no node" in the analysis graphs */
+#define AMBIGUITY_NONE UINT32_MAX
+
+/**
+ * @brief Consuming move of the epsilon-free automaton
+ */
+typedef struct ambiguity_move {
+    const uint64_t *label; /**< 256-bit set of bytes the move accepts */
+    uint32_t target;       /**< Index of the target state */
+    uint8_t multiplicity;  /**< Distinct epsilon paths leading to the move, capped at 2 */
+} ambiguity_move_t;
+
+/**
+ * @brief Epsilon-free automaton over the states reached by consuming moves
+ *
+ * State 0 is the initial state. The moves of state i are
+ * moves[move_offsets[i]] .. moves[move_offsets[i + 1] - 1].
+ */
+typedef struct ambiguity_graph {
+    uint32_t num_states;    /**< Number of states */
+    uint32_t *move_offsets; /**< num_states + 1 offsets into moves */
+    ambiguity_move_t *moves; /**< Moves of all states */
+    uint32_t num_moves;     /**< Number of moves */
+    uint32_t moves_capacity; /**< Capacity of moves */
+} ambiguity_graph_t;
+
+/**
+ * @brief Successor enumeration of an implicit graph for tarjan_scc
+ *
+ * @param context Graph passed to tarjan_scc
+ * @param node The node
+ * @param cursor Enumeration position, 0 on the first call for the node
+ * @return The next successor or AMBIGUITY_NONE when there are no more
+ */
+typedef uint32_t (*ambiguity_successor_fn)(const void *context, uint32_t node, uint64_t *cursor);
+
+/**
+ * @brief Set an error
+ */
+static void
+set_error(rift_regex_error_t *error, rift_regex_error_code_t code, const char *message)
+{
+    if (error) {
+        error->code = code;
+        snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH, "%s", message);
+    }
+}
+
+/**
+ * @brief Check whether two byte sets share a byte
+ */
+static bool
+labels_intersect(const uint64_t *a, const uint64_t *b)
+{
+    return ((a[0] & b[0]) | (a[1] & b[1]) | (a[2] & b[2]) | (a[3] & b[3])) != 0;
+}
+
+/**
+ * @brief Check whether three byte sets share a byte
+ */
+static bool
+labels_intersect3(const uint64_t *a, const uint64_t *b, const uint64_t *c)
+{
+    return ((a[0] & b[0] & c[0]) | (a[1] & b[1] & c[1]) | (a[2] & b[2] & c[2]) |
+            (a[3] & b[3] & c[3])) != 0;
+}
+
+/**
+ * @brief Compute strongly connected components with an iterative Tarjan search
+ *
+ * Only nodes reachable from the root are visited; the others keep component
+ * AMBIGUITY_NONE. Components are numbered in reverse topological order, so a
+ * component only reaches components with smaller numbers.
+ *
+ * @param num_nodes Number of nodes
+ * @param root Node to start from
+ * @param next Successor enumeration
+ * @param context Graph passed to next
+ * @param component Array of num_nodes entries receiving the component of each node
+ * @param num_components Pointer to store the number of components
+ * @return true if successful, false on allocation failure
+ */
+static bool
+tarjan_scc(uint32_t num_nodes, uint32_t root, ambiguity_successor_fn next, const void *context,
+           uint32_t *component, uint32_t *num_components)
+{
+    typedef struct {
+        uint32_t node;
+        uint64_t cursor;
+    } frame_t;
+
+    uint32_t *index = (uint32_t *)rift_malloc(num_nodes * sizeof(uint32_t));
+    uint32_t *low = (uint32_t *)rift_malloc(num_nodes * sizeof(uint32_t));
+    uint32_t *stack = (uint32_t *)rift_malloc(num_nodes * sizeof(uint32_t));
+    frame_t *frames = (frame_t *)rift_malloc(num_nodes * sizeof(frame_t));
+    if (!index || !low || !stack || !frames) {
+        rift_free(index);
+        rift_free(low);
+        rift_free(stack);
+        rift_free(frames);
+        return false;
+    }
+
+    for (uint32_t i = 0; i < num_nodes; i++) {
+        index[i] = AMBIGUITY_NONE;
+        component[i] = AMBIGUITY_NONE;
+    }
+
+    uint32_t counter = 0;
+    uint32_t stack_size = 0;
+    uint32_t frame_count = 0;
+    *num_components = 0;
+
+    // A node is on the Tarjan stack while it has an index but no component
+    index[root] = low[root] = counter++;
+    stack[stack_size++] = root;
+    frames[frame_count++] = (frame_t){root, 0};
+
+    while (frame_count > 0) {
+        frame_t *frame = &frames[frame_count - 1];
+        uint32_t node = frame->node;
+        uint32_t successor = next(context, node, &frame->cursor);
+
+        if (successor != AMBIGUITY_NONE) {
+            if (index[successor] == AMBIGUITY_NONE) {
+                index[successor] = low[successor] = counter++;
+                stack[stack_size++] = successor;
+                frames[frame_count++] = (frame_t){successor, 0};
+            } else if (component[successor] == AMBIGUITY_NONE && index[successor] < low[node]) {
+                low[node] = index[successor];
+            }
+            continue;
+        }
+
+        if (low[node] == index[node]) {
+            uint32_t member;
+            do {
+                member = stack[--stack_size];
+                component[member] = *num_components;
+            } while (member != node);
+            (*num_components)++;
+        }
+
+        frame_count--;
+        if (frame_count > 0) {
+            uint32_t parent = frames[frame_count - 1].node;
+            if (low[node] < low[parent]) {
+                low[parent] = low[node];
+            }
+        }
+    }
+
+    rift_free(index);
+    rift_free(low);
+    rift_free(stack);
+    rift_free(frames);
+    return true;
+}
+
+/**
+ * @brief Successors of a state of the epsilon-free automaton
+ */
+static uint32_t
+graph_successor(const void *context, uint32_t node, uint64_t *cursor)
+{
+    const ambiguity_graph_t *graph = (const ambiguity_graph_t *)context;
+    uint32_t count = graph->move_offsets[node + 1] - graph->move_offsets[node];
+    if (*cursor >= count) {
+        return AMBIGUITY_NONE;
+    }
+    return graph->moves[graph->move_offsets[node] + (*cursor)++].target;
+}
+
+/**
+ * @brief Successors of a pair of states in the automaton squared
+ *
+ * Pair (p, q) is node p * num_states + q, and a successor pairs two moves
+ * that share a byte.
+ */
+static uint32_t
+pair_successor(const void *context, uint32_t node, uint64_t *cursor)
+{
+    const ambiguity_graph_t *graph = (const ambiguity_graph_t *)context;
+    uint32_t n = graph->num_states;
+    uint32_t p = node / n;
+    uint32_t q = node % n;
+    const ambiguity_move_t *p_moves = graph->moves + graph->move_offsets[p];
+    const ambiguity_move_t *q_moves = graph->moves + graph->move_offsets[q];
+    uint64_t p_count = graph->move_offsets[p + 1] - graph->move_offsets[p];
+    uint64_t q_count = graph->move_offsets[q + 1] - graph->move_offsets[q];
+
+    while (*cursor < p_count * q_count) {
+        const ambiguity_move_t *a = &p_moves[*cursor / q_count];
+        const ambiguity_move_t *b = &q_moves[*cursor % q_count];
+        (*cursor)++;
+        if (labels_intersect(a->label, b->label)) {
+            return a->target * n + b->target;
+        }
+    }
+    return AMBIGUITY_NONE;
+}
+
+/**
+ * @brief Append a move to the graph
+ */
+static bool
+graph_add_move(ambiguity_graph_t *graph, const uint64_t *label, uint32_t target,
+               uint8_t multiplicity)
+{
+    if (graph->num_moves == graph->moves_capacity) {
+        uint32_t capacity = graph->moves_capacity ? graph->moves_capacity * 2 : 64;
+        ambiguity_move_t *moves =
+            (ambiguity_move_t *)rift_realloc(graph->moves, capacity * sizeof(ambiguity_move_t));
+        if (!moves) {
+            return false;
+        }
+        graph->moves = moves;
+        graph->moves_capacity = capacity;
+    }
+
+    graph->moves[graph->num_moves++] = (ambiguity_move_t){label, target, multiplicity};
+    return true;
+}
+
+/**
+ * @brief Free the storage of a graph
+ */
+static void
+graph_free(ambiguity_graph_t *graph)
+{
+    rift_free(graph->move_offsets);
+    rift_free(graph->moves);
+}
+
+/**
+ * @brief Remove the epsilon transitions of a frozen automaton
+ *
+ * The states kept are the initial state and the targets of consuming edges
+ * reachable from it, numbered in discovery order. The epsilon paths from a
+ * kept state are counted with increments pushed through the epsilon edges;
+ * counts only grow and stop at 2, so every state is queued at most twice and
+ * epsilon cycles end up at 2, like the unbounded number of paths they create.
+ *
+ * @param frozen The frozen automaton
+ * @param graph Pointer to store the epsilon-free automaton
+ * @param too_large Pointer set to true when there are more than
+ *                  RIFT_AMBIGUITY_MAX_STATES kept states
+ * @return true if successful, false on allocation failure
+ */
+static bool
+graph_build(const rift_frozen_automaton_t *frozen, ambiguity_graph_t *graph, bool *too_large)
+{
+    uint32_t num_states = frozen->num_states;
+    memset(graph, 0, sizeof(*graph));
+    *too_large = false;
+
+    uint32_t *kept_index = (uint32_t *)rift_malloc(num_states * sizeof(uint32_t));
+    uint32_t *kept = (uint32_t *)rift_malloc(RIFT_AMBIGUITY_MAX_STATES * sizeof(uint32_t));
+    uint8_t *paths = (uint8_t *)rift_calloc(num_states, sizeof(uint8_t));
+    uint32_t *touched = (uint32_t *)rift_malloc(num_states * sizeof(uint32_t));
+    uint32_t *queue_state = (uint32_t *)rift_malloc(2 * num_states * sizeof(uint32_t));
+    uint8_t *queue_delta = (uint8_t *)rift_malloc(2 * num_states * sizeof(uint8_t));
+    graph->move_offsets = (uint32_t *)rift_malloc((RIFT_AMBIGUITY_MAX_STATES + 1) * sizeof(uint32_t));
+
+    bool ok = kept_index && kept && paths && touched && queue_state && queue_delta &&
+              graph->move_offsets;
+
+    for (uint32_t i = 0; ok && i < num_states; i++) {
+        kept_index[i] = AMBIGUITY_NONE;
+    }
+
+    uint32_t num_kept = 0;
+    if (ok) {
+        kept_index[frozen->start_state] = num_kept;
+        kept[num_kept++] = frozen->start_state;
+    }
+
+    for (uint32_t k = 0; ok && k < num_kept; k++) {
+        graph->move_offsets[k] = graph->num_moves;
+
+        // Count the epsilon paths from the kept state to every state
+        uint32_t num_touched = 0;
+        size_t head = 0;
+        size_t tail = 0;
+        paths[kept[k]] = 1;
+        touched[num_touched++] = kept[k];
+        queue_state[tail] = kept[k];
+        queue_delta[tail++] = 1;
+
+        while (head < tail) {
+            uint32_t state = queue_state[head];
+            uint8_t delta = queue_delta[head++];
+            for (uint32_t e = frozen->edge_offsets[state]; e < frozen->edge_offsets[state + 1];
+                 e++) {
+                if (!(frozen->edge_flags[e] & RIFT_FROZEN_EDGE_EPSILON)) {
+                    continue;
+                }
+                uint32_t target = frozen->edge_targets[e];
+                uint8_t before = paths[target];
+                uint8_t after = before + delta > 2 ? 2 : (uint8_t)(before + delta);
+                if (after == before) {
+                    continue;
+                }
+                if (before == 0) {
+                    touched[num_touched++] = target;
+                }
+                paths[target] = after;
+                queue_state[tail] = target;
+                queue_delta[tail++] = (uint8_t)(after - before);
+            }
+        }
+
+        // Every consuming edge of the closure becomes a move
+        for (uint32_t t = 0; ok && t < num_touched; t++) {
+            uint32_t state = touched[t];
+            for (uint32_t e = frozen->edge_offsets[state];
+                 ok && e < frozen->edge_offsets[state + 1]; e++) {
+                const uint64_t *label = frozen->edge_predicates[e].bitmap;
+                if ((frozen->edge_flags[e] & RIFT_FROZEN_EDGE_EPSILON) ||
+                    !(label[0] | label[1] | label[2] | label[3])) {
+                    continue;
+                }
+
+                uint32_t target = frozen->edge_targets[e];
+                if (kept_index[target] == AMBIGUITY_NONE) {
+                    if (num_kept == RIFT_AMBIGUITY_MAX_STATES) {
+                        *too_large = true;
+                        ok = false;
+                        break;
+                    }
+                    kept_index[target] = num_kept;
+                    kept[num_kept++] = target;
+                }
+                ok = graph_add_move(graph, label, kept_index[target], paths[state]);
+            }
+        }
+
+        for (uint32_t t = 0; t < num_touched; t++) {
+            paths[touched[t]] = 0;
+        }
+    }
+
+    if (ok) {
+        graph->num_states = num_kept;
+        graph->move_offsets[num_kept] = graph->num_moves;
+    }
+
+    rift_free(kept_index);
+    rift_free(kept);
+    rift_free(paths);
+    rift_free(touched);
+    rift_free(queue_state);
+    rift_free(queue_delta);
+    if (!ok) {
+        graph_free(graph);
+        memset(graph, 0, sizeof(*graph));
+    }
+    return ok;
+}
+
+/**
+ * @brief Check the automaton squared for exponential ambiguity
+ *
+ * A loop p -> p has two distinct runs on one word exactly when the
+ * component of (p, p) also holds a pair (x, y) with x != y, or when (p, p)
+ * reaches a pair of its own component through two different moves, or
+ * through one move with several epsilon paths behind it.
+ *
+ * @param graph The epsilon-free automaton
+ * @param exponential Pointer to store the result
+ * @return true if successful, false on allocation failure
+ */
+static bool
+check_exponential(const ambiguity_graph_t *graph, bool *exponential)
+{
+    uint32_t n = graph->num_states;
+    uint32_t num_pairs = n * n;
+    *exponential = false;
+
+    uint32_t *component = (uint32_t *)rift_malloc(num_pairs * sizeof(uint32_t));
+    if (!component) {
+        return false;
+    }
+
+    uint32_t num_components = 0;
+    if (!tarjan_scc(num_pairs, 0, pair_successor, graph, component, &num_components)) {
+        rift_free(component);
+        return false;
+    }
+
+    uint8_t *kinds = (uint8_t *)rift_calloc(num_components, sizeof(uint8_t));
+    if (!kinds) {
+        rift_free(component);
+        return false;
+    }
+
+    // Bit 0: the component holds a diagonal pair, bit 1: an off-diagonal pair
+    for (uint32_t pair = 0; pair < num_pairs; pair++) {
+        if (component[pair] != AMBIGUITY_NONE) {
+            kinds[component[pair]] |= pair / n == pair % n ? 1 : 2;
+        }
+    }
+    for (uint32_t c = 0; c < num_components && !*exponential; c++) {
+        *exponential = kinds[c] == 3;
+    }
+
+    // Parallel moves between diagonal pairs of one component
+    for (uint32_t p = 0; p < n && !*exponential; p++) {
+        uint32_t own = component[p * n + p];
+        if (own == AMBIGUITY_NONE) {
+            continue;
+        }
+
+        for (uint32_t i = graph->move_offsets[p]; i < graph->move_offsets[p + 1]; i++) {
+            const ambiguity_move_t *a = &graph->moves[i];
+            if (a->multiplicity > 1 && component[a->target * n + a->target] == own) {
+                *exponential = true;
+                break;
+            }
+            for (uint32_t j = i + 1; j < graph->move_offsets[p + 1]; j++) {
+                const ambiguity_move_t *b = &graph->moves[j];
+                if (a->target == b->target && component[a->target * n + a->target] == own &&
+                    labels_intersect(a->label, b->label)) {
+                    *exponential = true;
+                    break;
+                }
+            }
+            if (*exponential) {
+                break;
+            }
+        }
+    }
+
+    rift_free(kinds);
+    rift_free(component);
+    return true;
+}
+
+/**
+ * @brief Search the automaton cubed for a word v with p -> p, p -> q and q -> q
+ *
+ * Triples (x, y, z) keep x in the component of p and z in the component of
+ * q, since runs from a state back to itself never leave its component.
+ *
+ * @param graph The epsilon-free automaton
+ * @param component Component of every state
+ * @param members Members of the two components, first those of p's
+ * @param local Position of every state within its component's members
+ * @param size_a Number of members of p's component
+ * @param size_b Number of members of q's component
+ * @param p First loop state
+ * @param q Second loop state
+ * @param visited Bitset of size_a * num_states * size_b bits, all zero
+ * @param queue Array of size_a * num_states * size_b entries
+ * @param budget Remaining triples that may be visited, decreased
+ * @return true if the word exists
+ */
+static bool
+find_loop_pair(const ambiguity_graph_t *graph, const uint32_t *component, const uint32_t *members,
+               const uint32_t *local, uint32_t size_a, uint32_t size_b, uint32_t p, uint32_t q,
+               uint64_t *visited, uint32_t *queue, uint64_t *budget)
+{
+    uint32_t n = graph->num_states;
+    uint32_t comp_a = component[p];
+    uint32_t comp_b = component[q];
+    uint32_t goal = (local[p] * n + q) * size_b + local[q];
+    uint32_t start = (local[p] * n + p) * size_b + local[q];
+    bool found = false;
+
+    size_t head = 0;
+    size_t tail = 0;
+    visited[start / 64] |= 1ull << (start % 64);
+    queue[tail++] = start;
+
+    while (head < tail && !found && *budget > 0) {
+        uint32_t triple = queue[head++];
+        (*budget)--;
+        uint32_t x = members[triple / (n * size_b)];
+        uint32_t y = (triple / size_b) % n;
+        uint32_t z = members[size_a + triple % size_b];
+
+        for (uint32_t i = graph->move_offsets[x]; i < graph->move_offsets[x + 1] && !found; i++) {
+            const ambiguity_move_t *a = &graph->moves[i];
+            if (component[a->target] != comp_a) {
+                continue;
+            }
+            for (uint32_t j = graph->move_offsets[y]; j < graph->move_offsets[y + 1] && !found;
+                 j++) {
+                const ambiguity_move_t *b = &graph->moves[j];
+                if (!labels_intersect(a->label, b->label)) {
+                    continue;
+                }
+                for (uint32_t k = graph->move_offsets[z]; k < graph->move_offsets[z + 1]; k++) {
+                    const ambiguity_move_t *c = &graph->moves[k];
+                    if (component[c->target] != comp_b ||
+                        !labels_intersect3(a->label, b->label, c->label)) {
+                        continue;
+                    }
+                    uint32_t next = (local[a->target] * n + b->target) * size_b + local[c->target];
+                    if (next == goal) {
+                        found = true;
+                        break;
+                    }
+                    if (!(visited[next / 64] & (1ull << (next % 64)))) {
+                        visited[next / 64] |= 1ull << (next % 64);
+                        queue[tail++] = next;
+                    }
+                }
+            }
+        }
+    }
+
+    // Clear only the bits set, the bitset is reused for the next pair
+    for (size_t i = 0; i < tail; i++) {
+        visited[queue[i] / 64] = 0;
+    }
+    return found;
+}
+
+/**
+ * @brief Compute the polynomial degree of ambiguity
+ *
+ * Two loops are linked when a single word runs from the first back to
+ * itself, from the first to the second and from the second back to itself.
+ * A chain of k linked loops gives Theta(n^k) runs on inputs of length n.
+ *
+ * @param graph The epsilon-free automaton
+ * @param degree Pointer to store the longest chain of links
+ * @param complete Pointer set to false when the triple budget ran out
+ * @return true if successful, false on allocation failure
+ */
+static bool
+compute_polynomial_degree(const ambiguity_graph_t *graph, uint32_t *degree, bool *complete)
+{
+    uint32_t n = graph->num_states;
+    *degree = 0;
+    *complete = true;
+
+    uint32_t *component = (uint32_t *)rift_malloc(n * sizeof(uint32_t));
+    uint32_t num_components = 0;
+    if (!component || !tarjan_scc(n, 0, graph_successor, graph, component, &num_components)) {
+        rift_free(component);
+        return false;
+    }
+
+    // Group the states by component and mark the components holding a loop
+    uint32_t *offsets = (uint32_t *)rift_calloc(num_components + 1, sizeof(uint32_t));
+    uint32_t *members = (uint32_t *)rift_malloc(n * sizeof(uint32_t));
+    uint32_t *local = (uint32_t *)rift_malloc(n * sizeof(uint32_t));
+    bool *looping = (bool *)rift_calloc(num_components, sizeof(bool));
+    uint32_t *chain = (uint32_t *)rift_calloc(num_components, sizeof(uint32_t));
+    bool *reached = (bool *)rift_malloc(n * sizeof(bool));
+    uint32_t *reach_stack = (uint32_t *)rift_malloc(n * sizeof(uint32_t));
+    bool ok = offsets && members && local && looping && chain && reached && reach_stack;
+
+    if (ok) {
+        for (uint32_t s = 0; s < n; s++) {
+            offsets[component[s] + 1]++;
+            for (uint32_t i = graph->move_offsets[s]; i < graph->move_offsets[s + 1]; i++) {
+                if (component[graph->moves[i].target] == component[s]) {
+                    looping[component[s]] = true;
+                }
+            }
+        }
+        for (uint32_t c = 0; c < num_components; c++) {
+            offsets[c + 1] += offsets[c];
+        }
+        // Fill members in state order, recording each state's position
+        uint32_t *fill = (uint32_t *)rift_calloc(num_components, sizeof(uint32_t));
+        ok = fill != NULL;
+        for (uint32_t s = 0; ok && s < n; s++) {
+            uint32_t c = component[s];
+            local[s] = fill[c]++;
+            members[offsets[c] + local[s]] = s;
+        }
+        rift_free(fill);
+    }
+
+    uint64_t budget = RIFT_AMBIGUITY_MAX_TRIPLES;
+    uint32_t *pair_members = NULL;
+    uint64_t *visited = NULL;
+    uint32_t *queue = NULL;
+
+    // Components are numbered sinks first, so every chain[b] below a is final
+    for (uint32_t a = 0; ok && a < num_components && *complete; a++) {
+        if (!looping[a]) {
+            continue;
+        }
+
+        // States reachable from the component
+        memset(reached, 0, n * sizeof(bool));
+        uint32_t depth = 0;
+        for (uint32_t m = offsets[a]; m < offsets[a + 1]; m++) {
+            reached[members[m]] = true;
+            reach_stack[depth++] = members[m];
+        }
+        while (depth > 0) {
+            uint32_t s = reach_stack[--depth];
+            for (uint32_t i = graph->move_offsets[s]; i < graph->move_offsets[s + 1]; i++) {
+                uint32_t t = graph->moves[i].target;
+                if (!reached[t]) {
+                    reached[t] = true;
+                    reach_stack[depth++] = t;
+                }
+            }
+        }
+
+        uint32_t size_a = offsets[a + 1] - offsets[a];
+        for (uint32_t b = 0; ok && b < a && *complete; b++) {
+            if (!looping[b] || !reached[members[offsets[b]]] || chain[b] + 1 <= chain[a]) {
+                continue;
+            }
+
+            uint32_t size_b = offsets[b + 1] - offsets[b];
+            size_t triples = (size_t)size_a * n * size_b;
+            rift_free(pair_members);
+            rift_free(visited);
+            rift_free(queue);
+            pair_members = (uint32_t *)rift_malloc((size_a + size_b) * sizeof(uint32_t));
+            visited = (uint64_t *)rift_calloc((triples + 63) / 64, sizeof(uint64_t));
+            queue = (uint32_t *)rift_malloc(triples * sizeof(uint32_t));
+            if (!pair_members || !visited || !queue) {
+                ok = false;
+                break;
+            }
+            memcpy(pair_members, members + offsets[a], size_a * sizeof(uint32_t));
+            memcpy(pair_members + size_a, members + offsets[b], size_b * sizeof(uint32_t));
+
+            bool linked = false;
+            for (uint32_t i = 0; i < size_a && !linked; i++) {
+                for (uint32_t j = 0; j < size_b && !linked; j++) {
+                    linked = find_loop_pair(graph, component, pair_members, local, size_a, size_b,
+                                            pair_members[i], pair_members[size_a + j], visited,
+                                            queue, &budget);
+                    if (budget == 0) {
+                        *complete = false;
+                    }
+                }
+            }
+            if (linked) {
+                chain[a] = chain[b] + 1;
+            }
+        }
+
+        if (chain[a] > *degree) {
+            *degree = chain[a];
+        }
+    }
+
+    rift_free(pair_members);
+    rift_free(visited);
+    rift_free(queue);
+    rift_free(component);
+    rift_free(offsets);
+    rift_free(members);
+    rift_free(local);
+    rift_free(looping);
+    rift_free(chain);
+    rift_free(reached);
+    rift_free(reach_stack);
+    return ok;
+}
+
+/**
+ * @brief Check whether a quantifier has no upper bound
+ *
+ * @param value The quantifier value, such as "*", "+?" or "{2,}"
+ * @return true for *, + and {m,}
+ */
+static bool
+quantifier_is_unbounded(const char *value)
+{
+    if (!value) {
+        return false;
+    }
+    if (value[0] == '*' || value[0] == '+') {
+        return true;
+    }
+    if (value[0] != '{') {
+        return false;
+    }
+
+    const char *comma = strchr(value, ',');
+    return comma && comma[1] == '}';
+}
+
+/**
+ * @brief Record the findings of an AST subtree
+ *
+ * @param node The root of the subtree
+ * @param inside_unbounded Whether an ancestor is an unbounded quantifier
+ * @param verdict The verdict to update
+ */
+static void
+analyze_ast_node(const rift_regex_ast_node_t *node, bool inside_unbounded,
+                 rift_ambiguity_verdict_t *verdict)
+{
+    if (!node) {
+        return;
+    }
+
+    rift_regex_ast_node_type_t type = rift_regex_ast_get_node_type(node);
+    if (type == RIFT_REGEX_AST_NODE_BACKREFERENCE ||
+        type == RIFT_REGEX_AST_NODE_NAMED_BACKREFERENCE) {
+        verdict->has_backreference = true;
+    }
+
+    if (type == RIFT_REGEX_AST_NODE_QUANTIFIER &&
+        quantifier_is_unbounded(rift_regex_ast_get_node_value(node))) {
+        if (inside_unbounded) {
+            verdict->nested_quantifiers++;
+        }
+        inside_unbounded = true;
+    }
+
+    size_t num_children = rift_regex_ast_get_child_count(node);
+    for (size_t i = 0; i < num_children; i++) {
+        analyze_ast_node(rift_regex_ast_get_child(node, i), inside_unbounded, verdict);
+    }
+}
+
+/**
+ * @brief Initialize a verdict to "not analyzed"
+ *
+ * @param verdict The verdict
+ */
+void
+rift_ambiguity_verdict_init(rift_ambiguity_verdict_t *verdict)
+{
+    if (verdict) {
+        memset(verdict, 0, sizeof(*verdict));
+        verdict->ambiguity = RIFT_AMBIGUITY_UNKNOWN;
+    }
+}
+
+/**
+ * @brief Record the structural findings of a pattern's AST
+ *
+ * @param ast The AST
+ * @param verdict The verdict to update
+ */
+void
+rift_ambiguity_analyze_ast(const rift_regex_ast_t *ast, rift_ambiguity_verdict_t *verdict)
+{
+    if (!ast || !verdict) {
+        return;
+    }
+
+    verdict->nested_quantifiers = 0;
+    verdict->has_backreference = false;
+    analyze_ast_node(rift_regex_ast_get_root(ast), false, verdict);
+}
+
+/**
+ * @brief Compute the degree of ambiguity of an automaton
+ *
+ * @param automaton The automaton
+ * @param verdict The verdict to update
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if analyzed, false on invalid parameters or allocation failure
+ */
+bool
+rift_ambiguity_analyze_automaton(const rift_regex_automaton_t *automaton,
+                                 rift_ambiguity_verdict_t *verdict, rift_regex_error_t *error)
+{
+    if (!automaton || !verdict) {
+        set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER, "Invalid parameters");
+        return false;
+    }
+
+    verdict->ambiguity = RIFT_AMBIGUITY_UNKNOWN;
+    verdict->degree = 0;
+
+    rift_frozen_automaton_t *frozen = rift_frozen_automaton_create(automaton, error);
+    if (!frozen) {
+        return false;
+    }
+
+    // An automaton without an initial state matches nothing
+    if (frozen->start_state == RIFT_FROZEN_NO_STATE) {
+        verdict->ambiguity = RIFT_AMBIGUITY_FINITE;
+        rift_frozen_automaton_free(frozen);
+        return true;
+    }
+
+    ambiguity_graph_t graph;
+    bool too_large = false;
+    if (!graph_build(frozen, &graph, &too_large)) {
+        rift_frozen_automaton_free(frozen);
+        if (too_large) {
+            // Too large to analyze is a verdict, not a failure
+            return true;
+        }
+        set_error(error, RIFT_REGEX_ERROR_MEMORY, "Failed to allocate the ambiguity analysis");
+        return false;
+    }
+
+    bool exponential = false;
+    uint32_t degree = 0;
+    bool complete = true;
+    bool ok = check_exponential(&graph, &exponential);
+    if (ok && !exponential) {
+        ok = compute_polynomial_degree(&graph, &degree, &complete);
+    }
+    // The move labels point into the frozen automaton
+    graph_free(&graph);
+    rift_frozen_automaton_free(frozen);
+
+    if (!ok) {
+        set_error(error, RIFT_REGEX_ERROR_MEMORY, "Failed to allocate the ambiguity analysis");
+        return false;
+    }
+
+    if (exponential) {
+        verdict->ambiguity = RIFT_AMBIGUITY_EXPONENTIAL;
+    } else if (degree > 0) {
+        verdict->ambiguity = RIFT_AMBIGUITY_POLYNOMIAL;
+        verdict->degree = degree;
+    } else if (complete) {
+        verdict->ambiguity = RIFT_AMBIGUITY_FINITE;
+    }
+    return true;
+}
+
+/**
+ * @brief Analyze a pattern's AST and automaton
+ *
+ * @param ast The AST (can be NULL)
+ * @param automaton The automaton
+ * @param verdict Pointer to store the verdict
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if analyzed, false otherwise (the verdict is then UNKNOWN)
+ */
+bool
+rift_ambiguity_analyze(const rift_regex_ast_t *ast, const rift_regex_automaton_t *automaton,
+                       rift_ambiguity_verdict_t *verdict, rift_regex_error_t *error)
+{
+    rift_ambiguity_verdict_init(verdict);
+    rift_ambiguity_analyze_ast(ast, verdict);
+    return rift_ambiguity_analyze_automaton(automaton, verdict, error);
+}
+
+/**
+ * @brief Check whether a verdict calls for a linear-time engine
+ *
+ * @param verdict The verdict
+ * @return true for EDA and IDA patterns
+ */
+bool
+rift_ambiguity_is_dangerous(const rift_ambiguity_verdict_t *verdict)
+{
+    return verdict && (verdict->ambiguity == RIFT_AMBIGUITY_EXPONENTIAL ||
+                       verdict->ambiguity == RIFT_AMBIGUITY_POLYNOMIAL);
+}
+
+/**
+ * @brief Get the name of a degree of ambiguity
+ *
+ * @param ambiguity The degree
+ * @return A static string such as "exponential"
+ */
+const char *
+rift_ambiguity_to_string(rift_ambiguity_t ambiguity)
+{
+    switch (ambiguity) {
+    case RIFT_AMBIGUITY_FINITE:
+        return "finite";
+    case RIFT_AMBIGUITY_POLYNOMIAL:
+        return "polynomial";
+    case RIFT_AMBIGUITY_EXPONENTIAL:
+        return "exponential";
+    case RIFT_AMBIGUITY_UNKNOWN:
+    default:
+        return "unknown";
+    }
+}
@@ -0,0 +1,316 @@
+/**
+ * @file auto_possessify.c
+ * @brief Implementation of automatic quantifier possessification
+ *
+ * This file walks a pattern's AST looking for greedy quantifiers over a
+ * single byte. For each, the bytes the loop repeats are compared with the
+ * bytes the rest of its sequence must start with; when no byte is in both,
+ * a repetition given back can never be matched by what follows, so the
+ * quantifier is rewritten to its possessive form and compiled inside an
+ * atomic region. Byte sets are taken from the transition predicates the
+ * compiler would build for the same nodes, so the analysis agrees with what
+ * the matchers execute.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/compiler/auto_possessify.h"
+#include <stdlib.h>
+#include <string.h>
+#include "core/automaton/transition.h"
+#include "core/config/config.h"
+
+/**
+ * @brief Flags under which byte sets of the AST are not those that match
+ */
+#define AUTO_POSSESSIFY_DISABLING_FLAGS                                                   \
+    (RIFT_REGEX_FLAG_NO_AUTO_POSSESS | RIFT_REGEX_FLAG_CASE_INSENSITIVE |                 \
+     RIFT_REGEX_FLAG_EXTENDED | RIFT_REGEX_FLAG_UNGREEDY)
+
+/**
+ * @brief Get the predicate of a node that matches exactly one byte
+ *
+ * Literals longer than one byte yield the predicate of their first byte
+ * when first_only is set, as the compiler chains them one byte at a time.
+ */
+static bool
+single_byte_predicate(const rift_regex_ast_node_t *node, bool first_only,
+                      rift_transition_predicate_t *predicate)
+{
+    const char *value = rift_regex_ast_get_node_value(node);
+
+    switch (node->type) {
+    case RIFT_REGEX_AST_NODE_LITERAL:
+        if (!value || !value[0] || (value[1] && !first_only)) {
+            return false;
+        }
+        if (value[1]) {
+            char first[2] = {value[0], '\0'};
+            return rift_transition_predicate_parse(first, predicate);
+        }
+        return rift_transition_predicate_parse(value, predicate);
+
+    case RIFT_REGEX_AST_NODE_CHARACTER_CLASS:
+        return value && rift_transition_predicate_parse(value, predicate);
+
+    case RIFT_REGEX_AST_NODE_DOT:
+        return rift_transition_predicate_parse(".", predicate);
+
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Parse the repetition bounds and mode of a quantifier value
+ *
+ * Only the minimum matters to the analysis; the maximum is skipped.
+ */
+static bool
+quantifier_info(const char *value, size_t *min, bool *greedy, bool *possessive)
+{
+    if (!value || !value[0]) {
+        return false;
+    }
+
+    size_t length = strlen(value);
+    char mode = length > 1 ? value[length - 1] : '\0';
+
+    switch (value[0]) {
+    case '*':
+    case '?':
+        *min = 0;
+        break;
+    case '+':
+        *min = 1;
+        break;
+    case '{':
+        *min = (size_t)strtoul(value + 1, NULL, 10);
+        break;
+    default:
+        return false;
+    }
+
+    *greedy = mode != '?';
+    *possessive = mode == '+';
+    return true;
+}
+
+/**
+ * @brief Check whether the flags of a node rule out the analysis
+ */
+static bool
+node_is_disabled(const rift_regex_ast_node_t *node)
+{
+    return (node->flags & AUTO_POSSESSIFY_DISABLING_FLAGS) != 0;
+}
+
+/**
+ * @brief Compute the bytes every match of a node must start with
+ *
+ * Fails for nodes that can match the empty string or start with anything
+ * other than a known byte, as then the next node's first byte is unknown.
+ *
+ * @param node The node
+ * @param first Predicate to merge the node's first bytes into
+ * @return true if the first bytes are known, false otherwise
+ */
+static bool
+first_bytes(const rift_regex_ast_node_t *node, rift_transition_predicate_t *first)
+{
+    if (!node || node_is_disabled(node)) {
+        return false;
+    }
+
+    rift_transition_predicate_t predicate;
+    size_t count = rift_regex_ast_get_child_count(node);
+
+    switch (node->type) {
+    case RIFT_REGEX_AST_NODE_LITERAL:
+    case RIFT_REGEX_AST_NODE_CHARACTER_CLASS:
+    case RIFT_REGEX_AST_NODE_DOT:
+        if (!single_byte_predicate(node, true, &predicate)) {
+            return false;
+        }
+        for (size_t i = 0; i < 4; i++) {
+            first->bitmap[i] |= predicate.bitmap[i];
+        }
+        return true;
+
+    case RIFT_REGEX_AST_NODE_GROUP:
+    case RIFT_REGEX_AST_NODE_NON_CAPTURING_GROUP:
+    case RIFT_REGEX_AST_NODE_NAMED_GROUP:
+    case RIFT_REGEX_AST_NODE_ATOMIC_GROUP:
+    case RIFT_REGEX_AST_NODE_CONCATENATION:
+        return count > 0 && first_bytes(rift_regex_ast_get_child(node, 0), first);
+
+    case RIFT_REGEX_AST_NODE_ALTERNATION:
+        if (count == 0) {
+            return false;
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (!first_bytes(rift_regex_ast_get_child(node, i), first)) {
+                return false;
+            }
+        }
+        return true;
+
+    case RIFT_REGEX_AST_NODE_QUANTIFIER: {
+        size_t min;
+        bool greedy, possessive;
+        if (!quantifier_info(rift_regex_ast_get_node_value(node), &min, &greedy, &possessive) ||
+            min == 0 || count == 0) {
+            return false;
+        }
+        return first_bytes(rift_regex_ast_get_child(node, 0), first);
+    }
+
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Check whether nothing can follow a node in any match
+ *
+ * True when the node is the last element of every sequence up to the root.
+ * Groups are not looked through: a capture ends after its last element.
+ */
+static bool
+ends_pattern(const rift_regex_ast_node_t *node)
+{
+    const rift_regex_ast_node_t *parent = rift_regex_ast_get_parent(node);
+
+    while (parent && parent->type == RIFT_REGEX_AST_NODE_CONCATENATION) {
+        size_t count = rift_regex_ast_get_child_count(parent);
+        if (rift_regex_ast_get_child(parent, count - 1) != node) {
+            return false;
+        }
+        node = parent;
+        parent = rift_regex_ast_get_parent(node);
+    }
+
+    return parent && parent->type == RIFT_REGEX_AST_NODE_ROOT;
+}
+
+/**
+ * @brief Get the node following another in its sequence
+ *
+ * @return The next sibling, or NULL if the node is not followed in a concatenation
+ */
+static const rift_regex_ast_node_t *
+next_in_sequence(const rift_regex_ast_node_t *node)
+{
+    const rift_regex_ast_node_t *parent = rift_regex_ast_get_parent(node);
+    if (!parent || parent->type != RIFT_REGEX_AST_NODE_CONCATENATION) {
+        return NULL;
+    }
+
+    size_t count = rift_regex_ast_get_child_count(parent);
+    for (size_t i = 0; i + 1 < count; i++) {
+        if (rift_regex_ast_get_child(parent, i) == node) {
+            return rift_regex_ast_get_child(parent, i + 1);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Check whether a quantifier can be made possessive
+ */
+static bool
+can_possessify(const rift_regex_ast_node_t *node)
+{
+    size_t min;
+    bool greedy, possessive;
+    if (!quantifier_info(rift_regex_ast_get_node_value(node), &min, &greedy, &possessive) ||
+        !greedy || possessive || rift_regex_ast_get_child_count(node) != 1) {
+        return false;
+    }
+
+    rift_transition_predicate_t body;
+    if (!single_byte_predicate(rift_regex_ast_get_child(node, 0), false, &body)) {
+        return false;
+    }
+
+    const rift_regex_ast_node_t *next = next_in_sequence(node);
+    if (!next) {
+        return ends_pattern(node);
+    }
+
+    rift_transition_predicate_t first;
+    memset(&first, 0, sizeof(first));
+    if (!first_bytes(next, &first)) {
+        return false;
+    }
+
+    for (size_t i = 0; i < 4; i++) {
+        if (body.bitmap[i] & first.bitmap[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Rewrite the quantifiers of a subtree
+ */
+static size_t
+possessify_node(rift_regex_ast_node_t *node)
+{
+    if (!node || node_is_disabled(node)) {
+        return 0;
+    }
+
+    size_t rewritten = 0;
+    size_t count = rift_regex_ast_get_child_count(node);
+    for (size_t i = 0; i < count; i++) {
+        rewritten += possessify_node(rift_regex_ast_get_child(node, i));
+    }
+
+    if (node->type != RIFT_REGEX_AST_NODE_QUANTIFIER || !can_possessify(node)) {
+        return rewritten;
+    }
+
+    const char *value = rift_regex_ast_get_node_value(node);
+    size_t length = strlen(value);
+    char *possessive = (char *)malloc(length + 2);
+    if (!possessive) {
+        return rewritten;
+    }
+    memcpy(possessive, value, length);
+    possessive[length] = '+';
+    possessive[length + 1] = '\0';
+
+    // A failed rewrite leaves the quantifier greedy, which is still correct
+    if (rift_regex_ast_node_set_value(node, possessive)) {
+        rewritten++;
+    }
+    free(possessive);
+    return rewritten;
+}
+
+/**
+ * @brief Make the quantifiers of an AST possessive where it cannot change a match
+ *
+ * @param ast The AST, rewritten in place before it is compiled
+ * @param flags The compilation flags
+ * @return The number of quantifiers made possessive
+ */
+size_t
+rift_regex_auto_possessify(rift_regex_ast_t *ast, rift_regex_flags_t flags)
+{
+    if (!ast || !ast->root || ((flags | ast->flags) & AUTO_POSSESSIFY_DISABLING_FLAGS)) {
+        return 0;
+    }
+
+    // Possessive loops need atomic states, which would keep the pattern off a Glushkov NFA
+    bool glushkov_nfa = false;
+    if (rift_config_get_regex_param(RIFT_REGEX_PARAM_GLUSHKOV_NFA, &glushkov_nfa) == RIFT_OK &&
+        glushkov_nfa) {
+        return 0;
+    }
+
+    return possessify_node(ast->root);
+}
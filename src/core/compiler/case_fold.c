@@ -0,0 +1,116 @@
+/**
+ * @file case_fold.c
+ * @brief Compile-time case folding for the LibRift regex engine
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/compiler/case_fold.h"
+#include <string.h>
+#include "core/automaton/byte_class.h"
+#include "core/automaton/transition.h"
+
+/**
+ * @brief Run of code points whose other case lies at a fixed distance
+ */
+static const struct {
+    uint32_t start;
+    uint32_t end;
+    int32_t delta;
+} fold_runs[] = {
+    {0x41, 0x5A, 32},   {0x61, 0x7A, -32},   /* ASCII */
+    {0xC0, 0xD6, 32},   {0xD8, 0xDE, 32},    /* Latin-1 capitals, without U+00D7 */
+    {0xE0, 0xF6, -32},  {0xF8, 0xFE, -32},   /* Latin-1 small letters, without U+00F7 */
+    {0x391, 0x3A1, 32}, {0x3A3, 0x3AB, 32},  /* Greek capitals, without U+03A2 */
+    {0x3B1, 0x3C1, -32}, {0x3C3, 0x3CB, -32}, /* Greek small letters, without final sigma */
+    {0x400, 0x40F, 80}, {0x410, 0x42F, 32},  /* Cyrillic capitals */
+    {0x430, 0x44F, -32}, {0x450, 0x45F, -80}, /* Cyrillic small letters */
+};
+
+/**
+ * @brief Get the other case of a code point
+ */
+uint32_t
+rift_case_fold_other(uint32_t codepoint)
+{
+    for (size_t i = 0; i < sizeof(fold_runs) / sizeof(fold_runs[0]); i++) {
+        if (codepoint >= fold_runs[i].start && codepoint <= fold_runs[i].end) {
+            return (uint32_t)((int32_t)codepoint + fold_runs[i].delta);
+        }
+    }
+    return codepoint;
+}
+
+/**
+ * @brief Add the other case of every member to a set of code points
+ */
+bool
+rift_case_fold_range_set(rift_utf8_range_set_t *set)
+{
+    if (!set) {
+        return false;
+    }
+
+    // Only the ranges present on entry are folded; what is added needs no folding
+    size_t count = set->count;
+    for (size_t i = 0; i < count; i++) {
+        for (size_t j = 0; j < sizeof(fold_runs) / sizeof(fold_runs[0]); j++) {
+            uint32_t start = set->ranges[i].start > fold_runs[j].start ? set->ranges[i].start
+                                                                       : fold_runs[j].start;
+            uint32_t end =
+                set->ranges[i].end < fold_runs[j].end ? set->ranges[i].end : fold_runs[j].end;
+            if (start <= end &&
+                !rift_utf8_range_set_add(set, (uint32_t)((int32_t)start + fold_runs[j].delta),
+                                         (uint32_t)((int32_t)end + fold_runs[j].delta))) {
+                return false;
+            }
+        }
+    }
+
+    rift_utf8_range_set_normalize(set);
+    return true;
+}
+
+/**
+ * @brief Fold a transition pattern so that it matches ASCII letters in either case
+ */
+bool
+rift_case_fold_pattern(const char *pattern, char *buffer, size_t buffer_size)
+{
+    rift_transition_predicate_t predicate;
+    if (!pattern || !buffer || buffer_size < RIFT_BYTE_CLASS_MAX_PATTERN_LENGTH ||
+        !rift_transition_predicate_parse(pattern, &predicate)) {
+        return false;
+    }
+
+    // A negated class is folded as the set it excludes
+    bool negated = pattern[0] == '[' && pattern[1] == '^';
+    bool members[RIFT_BYTE_CLASS_ALPHABET_SIZE];
+    for (unsigned int c = 0; c < RIFT_BYTE_CLASS_ALPHABET_SIZE; c++) {
+        members[c] = ((predicate.bitmap[c / 64] >> (c % 64)) & 1) != negated;
+    }
+
+    bool changed = false;
+    for (unsigned int c = 'A'; c <= 'Z'; c++) {
+        unsigned int lower = c + ('a' - 'A');
+        if (members[c] != members[lower]) {
+            members[c] = true;
+            members[lower] = true;
+            changed = true;
+        }
+    }
+    if (!changed) {
+        return false;
+    }
+
+    // The format helper takes a partition; class 1 holds the members
+    rift_byte_classes_t classes;
+    memset(&classes, 0, sizeof(classes));
+    classes.num_classes = 2;
+    for (unsigned int c = 1; c < RIFT_BYTE_CLASS_ALPHABET_SIZE; c++) {
+        classes.map[c] = members[c] != negated ? 1 : 0;
+    }
+
+    return rift_byte_classes_format_pattern(&classes, 1, buffer, buffer_size) > 0;
+}
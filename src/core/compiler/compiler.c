@@ -31,6 +31,17 @@ ompiler/compiler.h"/a #include "core/runtime/matcher.h"
  * @license MIT License
  */
 
+#include "core/automaton/byte_class.h"
+#include "core/automaton/counter.h"
+#include "core/automaton/glushkov.h"
+#include "core/automaton/lookaround.h"
+#include "core/automaton/sparse_set.h"
+#include "core/compiler/case_fold.h"
+#include "core/compiler/auto_possessify.h"
+#include "core/compiler/simplify.h"
+#include "core/compiler/utf8_ranges.h"
+#include "core/config/config.h"
+#include "core/memory/memory.h"
 ompiler/compiler.h"/a #include "core/runtime/matcher.h"
 ompiler/compiler.h"/a #include "core/runtime/matcher.h"
 
@@ -228,11 +239,46 @@ rift_regex_get_compile_error_message(rift_regex_error_t error)
 
 ompiler/compiler.h"/a #include "core/runtime/matcher.h"
 /**
- * @brief Compile an AST into an automaton structure
+ * @brief Finish a compiled automaton so that matching only reads it
+ *
+ * The epsilon closures are the one part of an automaton otherwise filled in
+ * lazily by the first match, which would make concurrent first matches race.
  */
-rift_regex_automaton_t *
-rift_regex_compile_ast(const rift_regex_ast_t *ast, rift_regex_flags_t flags,
-                       rift_regex_error_t *error)
+static rift_regex_automaton_t *
+seal_automaton(rift_regex_automaton_t *automaton, rift_regex_error_t *error)
+{
+    if (!rift_automaton_get_epsilon_closures(automaton, error)) {
+        rift_automaton_free(automaton);
+        return NULL;
+    }
+    return automaton;
+}
+
+/**
+ * @brief Count the capturing groups under an AST node
+ */
+static size_t
+count_capture_groups(const rift_regex_ast_node_t *node)
+{
+    if (!node) {
+        return 0;
+    }
+
+    rift_regex_ast_node_type_t type = rift_regex_ast_get_node_type(node);
+    size_t count =
+        type == RIFT_REGEX_AST_NODE_GROUP || type == RIFT_REGEX_AST_NODE_NAMED_GROUP ? 1 : 0;
+    size_t children = rift_regex_ast_get_child_count(node);
+    for (size_t i = 0; i < children; i++) {
+        count += count_capture_groups(rift_regex_ast_get_child(node, i));
+    }
+    return count;
+}
+
+/**
+ * @brief Build the NFA of an AST, keeping its counted loops
+ */
+static rift_regex_automaton_t *
+build_counted_nfa(const rift_regex_ast_t *ast, rift_regex_flags_t flags, rift_regex_error_t *error)
 {
     if (!ast) {
         if (error) {
@@ -242,6 +288,19 @@ rift_regex_compile_ast(const rift_regex_ast_t *ast, rift_regex_flags_t flags,
         return NULL;
     }
 
+    // Group data lives outside the states, so the only bound is the configured one
+    size_t max_groups = 0;
+    if (rift_config_get_regex_param(RIFT_REGEX_PARAM_MAX_CAPTURE_GROUPS, &max_groups) == RIFT_OK &&
+        max_groups > 0) {
+        size_t groups = count_capture_groups(rift_regex_ast_get_root(ast));
+        if (groups > max_groups) {
+            RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_LIMIT_EXCEEDED,
+                                 "Pattern has %zu capturing groups, the limit is %zu", groups,
+                                 max_groups);
+            return NULL;
+        }
+    }
+
     // Create an empty NFA
     rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
     if (!nfa) {
@@ -257,9 +316,65 @@ rift_regex_compile_ast(const rift_regex_ast_t *ast, rift_regex_flags_t flags,
         return NULL;
     }
 
-    // Determine if DFA conversion is needed based on flags
-    if (flags & RIFT_REGEX_FLAG_USE_DFA) {
-        rift_regex_automaton_t *dfa = rift_automaton_nfa_to_dfa(nfa, error);
+    return nfa;
+}
+
+/**
+ * @brief Compile an AST into an automaton whose counted loops are kept
+ */
+rift_regex_automaton_t *
+rift_regex_compile_ast_with_counters(const rift_regex_ast_t *ast, rift_regex_flags_t flags,
+                                     rift_regex_error_t *error)
+{
+    rift_memory_tag_t outer = rift_memory_tag_use(RIFT_MEMORY_TAG_AUTOMATON);
+    rift_regex_automaton_t *nfa = build_counted_nfa(ast, flags, error);
+    rift_regex_automaton_t *automaton = nfa ? seal_automaton(nfa, error) : NULL;
+    rift_memory_tag_use(outer);
+    return automaton;
+}
+
+/**
+ * @brief Compile an AST into an automaton under the tag already in use
+ */
+static rift_regex_automaton_t *
+compile_ast(const rift_regex_ast_t *ast, rift_regex_flags_t flags, rift_regex_error_t *error)
+{
+    rift_regex_automaton_t *nfa = build_counted_nfa(ast, flags, error);
+    if (!nfa) {
+        return NULL;
+    }
+
+    // The state-machine engines cannot count, so counted loops are unrolled for them
+    if (!rift_automaton_expand_counters(nfa, error)) {
+        rift_automaton_free(nfa);
+        return NULL;
+    }
+
+    // A Glushkov NFA has no epsilon edges for closures and subset construction to walk;
+    // patterns with captures, assertions or atomic groups keep the Thompson NFA
+    bool glushkov_nfa = false;
+    if (rift_config_get_regex_param(RIFT_REGEX_PARAM_GLUSHKOV_NFA, &glushkov_nfa) == RIFT_OK &&
+        glushkov_nfa) {
+        rift_regex_automaton_t *glushkov = rift_automaton_to_glushkov(nfa, NULL);
+        if (glushkov) {
+            rift_automaton_free(nfa);
+            nfa = glushkov;
+        }
+    }
+
+    // Determine if DFA conversion is needed based on flags; lookarounds keep the NFA,
+    // whose assertions the Pike VM checks position by position
+    if ((flags & RIFT_REGEX_FLAG_USE_DFA) && !rift_automaton_has_lookarounds(nfa)) {
+        rift_regex_error_t dfa_error = {0};
+        rift_memory_tag_t outer = rift_memory_tag_use(RIFT_MEMORY_TAG_DFA);
+        rift_regex_automaton_t *dfa = rift_automaton_nfa_to_dfa(nfa, &dfa_error);
+        rift_memory_tag_use(outer);
+
+        // A DFA over the state budget degrades to the NFA, which matchers run
+        // on the lazy DFA or the Pike VM with memory bounded per match
+        if (!dfa && dfa_error.code == RIFT_REGEX_ERROR_LIMIT_EXCEEDED) {
+            return seal_automaton(nfa, error);
+        }
         rift_automaton_free(nfa);
 
         if (!dfa) {
@@ -282,10 +397,23 @@ rift_regex_compile_ast(const rift_regex_ast_t *ast, rift_regex_flags_t flags,
             }
         }
 
-        return dfa;
+        return seal_automaton(dfa, error);
     }
 
-    return nfa;
+    return seal_automaton(nfa, error);
+}
+
+/**
+ * @brief Compile an AST into an automaton structure
+ */
+rift_regex_automaton_t *
+rift_regex_compile_ast(const rift_regex_ast_t *ast, rift_regex_flags_t flags,
+                       rift_regex_error_t *error)
+{
+    rift_memory_tag_t outer = rift_memory_tag_use(RIFT_MEMORY_TAG_AUTOMATON);
+    rift_regex_automaton_t *automaton = compile_ast(ast, flags, error);
+    rift_memory_tag_use(outer);
+    return automaton;
 }
 
 ompiler/compiler.h"/a #include "core/runtime/matcher.h"
@@ -303,17 +431,29 @@ rift_regex_compile_pattern(const char *pattern, rift_regex_flags_t flags, rift_r
         return NULL;
     }
 
+    // The AST only lives for this compilation, so its nodes go in an arena
+    // that is dropped in one piece; without one they go on the heap
+    rift_arena_t *arena = rift_arena_create(0);
+
     // Parse the pattern into an AST
-    rift_regex_ast_t *ast = rift_regex_parse(pattern, flags, error);
+    rift_regex_ast_t *ast = rift_regex_parse_in_arena(pattern, flags, arena, error);
     if (!ast) {
+        rift_arena_free(arena);
         return NULL;
     }
 
+    // Shrink the AST first, so the passes after it and the NFA see less of it
+    rift_regex_simplify_ast(ast);
+
+    // Make loops that cannot give anything back to what follows possessive
+    rift_regex_auto_possessify(ast, flags);
+
     // Compile the AST into an automaton
     rift_regex_automaton_t *automaton = rift_regex_compile_ast(ast, flags, error);
 
-    // Free the AST (no longer needed after compilation)
+    // Free the AST (no longer needed after compilation), then its nodes
     rift_regex_ast_free(ast);
+    rift_arena_free(arena);
 
     return automaton;
 }
@@ -372,6 +512,121 @@ build_automaton_from_ast(rift_regex_automaton_t *automaton, const rift_regex_ast
     return true;
 }
 
+/**
+ * @brief Check whether a node matches letters in either case
+ */
+static bool
+is_caseless(const rift_regex_ast_node_t *node, rift_regex_flags_t flags)
+{
+    return ((flags | node->flags) & RIFT_REGEX_FLAG_CASE_INSENSITIVE) != 0;
+}
+
+/**
+ * @brief Add the UTF-8 byte sequences of a set of code points between two states
+ *
+ * Each sequence becomes a chain of byte range transitions, so the automaton
+ * consumes one whole encoded character per path.
+ *
+ * @param automaton The automaton
+ * @param set The code points
+ * @param start_state The state the sequences leave from
+ * @param end_state The state the sequences lead to
+ * @return true if successful, false on allocation failure
+ */
+static bool
+add_codepoint_ranges(rift_regex_automaton_t *automaton, const rift_utf8_range_set_t *set,
+                     rift_regex_state_t *start_state, rift_regex_state_t *end_state)
+{
+    rift_utf8_sequence_t sequences[RIFT_UTF8_MAX_SEQUENCES];
+    char pattern[RIFT_UTF8_MAX_PATTERN_LENGTH];
+
+    for (size_t i = 0; i < set->count; i++) {
+        // NUL is presented as the empty input and never matches a byte transition
+        uint32_t low = set->ranges[i].start ? set->ranges[i].start : 1;
+        size_t count = rift_utf8_sequences(low, set->ranges[i].end, sequences);
+
+        for (size_t j = 0; j < count; j++) {
+            rift_regex_state_t *prev_state = start_state;
+            for (uint8_t k = 0; k < sequences[j].length; k++) {
+                rift_regex_state_t *next_state = end_state;
+                if (k + 1 < sequences[j].length) {
+                    next_state = rift_automaton_create_state(automaton, false);
+                    if (!next_state) {
+                        return false;
+                    }
+                }
+
+                rift_utf8_format_byte_range(sequences[j].start[k], sequences[j].end[k],
+                                            pattern);
+                if (!rift_automaton_add_transition(automaton, prev_state, next_state,
+                                                   pattern)) {
+                    return false;
+                }
+                prev_state = next_state;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Handle a class, property or dot that matches whole UTF-8 characters
+ *
+ * @param automaton The automaton
+ * @param node A character class, Unicode property or dot node
+ * @param start_state Pointer to store the start state
+ * @param end_state Pointer to store the end state
+ * @param flags Compilation flags
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+static bool
+handle_utf8_class(rift_regex_automaton_t *automaton, const rift_regex_ast_node_t *node,
+                  rift_regex_state_t **start_state, rift_regex_state_t **end_state,
+                  rift_regex_flags_t flags, rift_regex_error_t *error)
+{
+    const char *value = rift_regex_ast_get_node_value(node);
+    bool caseless = is_caseless(node, flags);
+    rift_utf8_range_set_t set = {NULL, 0, 0};
+    bool parsed;
+
+    switch (rift_regex_ast_get_node_type(node)) {
+    case RIFT_REGEX_AST_NODE_UNICODE_PROPERTY:
+        parsed = rift_utf8_parse_property(value, caseless, &set);
+        if (!parsed) {
+            rift_utf8_range_set_clear(&set);
+            RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE,
+                                 "Unknown Unicode property '%s'", value ? value : "");
+            return false;
+        }
+        break;
+    case RIFT_REGEX_AST_NODE_DOT:
+        parsed = rift_utf8_range_set_add(&set, 1, RIFT_UTF8_MAX_CODEPOINT);
+        break;
+    default:
+        parsed = rift_utf8_parse_class(value, caseless, &set);
+        if (!parsed) {
+            rift_utf8_range_set_clear(&set);
+            RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_INVALID_CHARACTER_CLASS,
+                                 "Invalid UTF-8 character class '%s'", value ? value : "");
+            return false;
+        }
+        break;
+    }
+
+    *start_state = rift_automaton_create_state(automaton, false);
+    *end_state = rift_automaton_create_state(automaton, false);
+    bool success = parsed && *start_state && *end_state &&
+                   add_codepoint_ranges(automaton, &set, *start_state, *end_state);
+    rift_utf8_range_set_clear(&set);
+
+    if (!success) {
+        RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_MEMORY,
+                             "Failed to create UTF-8 class transitions", 0);
+    }
+    return success;
+}
+
 ompiler/compiler.h"/a #include "core/runtime/matcher.h"
 /**
  * @brief Convert an AST node to an NFA
@@ -401,12 +656,24 @@ convert_node_to_nfa(rift_regex_automaton_t *automaton, const rift_regex_ast_node
         return handle_quantifier(automaton, node, start_state, end_state, flags, error);
 
     case RIFT_REGEX_AST_NODE_CHARACTER_CLASS:
-        return handle_character_class(automaton, node, start_state, end_state, error);
+        if ((flags & RIFT_REGEX_FLAG_UTF8) &&
+            rift_utf8_class_needs_ranges(rift_regex_ast_get_node_value(node))) {
+            return handle_utf8_class(automaton, node, start_state, end_state, flags, error);
+        }
+        return handle_character_class(automaton, node, start_state, end_state, flags, error);
+
+    case RIFT_REGEX_AST_NODE_UNICODE_PROPERTY:
+        return handle_utf8_class(automaton, node, start_state, end_state, flags, error);
 
     case RIFT_REGEX_AST_NODE_LITERAL:
-        return handle_literal(automaton, node, start_state, end_state, error);
+        return handle_literal(automaton, node, start_state, end_state, flags, error);
 
     case RIFT_REGEX_AST_NODE_DOT:
+        // In UTF-8 mode a dot consumes a whole encoded character
+        if (flags & RIFT_REGEX_FLAG_UTF8) {
+            return handle_utf8_class(automaton, node, start_state, end_state, flags, error);
+        }
+
         // Create a dot (any character) NFA
         *start_state = rift_automaton_create_state(automaton, false);
         *end_state = rift_automaton_create_state(automaton, false);
@@ -426,11 +693,18 @@ convert_node_to_nfa(rift_regex_automaton_t *automaton, const rift_regex_ast_node
 
     case RIFT_REGEX_AST_NODE_NON_CAPTURING_GROUP:
     case RIFT_REGEX_AST_NODE_NAMED_GROUP:
+    case RIFT_REGEX_AST_NODE_ATOMIC_GROUP:
         return handle_group(automaton, node, start_state, end_state, flags, error);
 
     case RIFT_REGEX_AST_NODE_ANCHOR:
         return handle_anchor(automaton, node, start_state, end_state, error);
 
+    case RIFT_REGEX_AST_NODE_LOOKAHEAD:
+    case RIFT_REGEX_AST_NODE_NEGATIVE_LOOKAHEAD:
+    case RIFT_REGEX_AST_NODE_LOOKBEHIND:
+    case RIFT_REGEX_AST_NODE_NEGATIVE_LOOKBEHIND:
+        return handle_lookaround(automaton, node, start_state, end_state, flags, error);
+
     case RIFT_REGEX_AST_NODE_ROOT:
         // Root node should have exactly one child
         if (rift_regex_ast_get_child_count(node) != 1) {
@@ -550,14 +824,20 @@ handle_concatenation(rift_regex_automaton_t *automaton, const rift_regex_ast_nod
         return false;
     }
 
-    // Concatenation must have at least 1 child
+    // An empty concatenation, as in "a|" or "()", matches the empty string
     size_t child_count = rift_regex_ast_get_child_count(node);
-    if (child_count < 1) {
-        if (error) {
-            RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_INTERNAL,
-                                 "Concatenation must have at least 1 child", 0);
+    if (child_count == 0) {
+        *start_state = rift_automaton_create_state(automaton, false);
+        *end_state = rift_automaton_create_state(automaton, false);
+        if (!*start_state || !*end_state ||
+            !rift_automaton_create_epsilon_transition(automaton, *start_state, *end_state)) {
+            if (error) {
+                RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_MEMORY,
+                                     "Failed to create empty concatenation", 0);
+            }
+            return false;
         }
-        return false;
+        return true;
     }
 
     // Handle the special case of a single child
@@ -617,6 +897,98 @@ handle_concatenation(rift_regex_automaton_t *automaton, const rift_regex_ast_nod
     return true;
 }
 
+/**
+ * @brief Add a choice between repeating and leaving, in order of preference
+ *
+ * Backtracking engines follow epsilon transitions in the order they were
+ * added, so a greedy quantifier must offer the repetition first.
+ *
+ * @param automaton The automaton
+ * @param from The state making the choice
+ * @param repeat The start of the repeated sub-expression
+ * @param leave The state reached by not repeating
+ * @param is_greedy Whether repeating is preferred
+ * @return true if successful, false otherwise
+ */
+static bool
+add_branches(rift_regex_automaton_t *automaton, rift_regex_state_t *from,
+             rift_regex_state_t *repeat, rift_regex_state_t *leave, bool is_greedy)
+{
+    rift_regex_state_t *first = is_greedy ? repeat : leave;
+    rift_regex_state_t *second = is_greedy ? leave : repeat;
+
+    return rift_automaton_create_epsilon_transition(automaton, from, first) &&
+           rift_automaton_create_epsilon_transition(automaton, from, second);
+}
+
+/**
+ * @brief Add a transition on one literal byte
+ *
+ * Bytes that are special in a transition pattern are escaped, so a literal
+ * '.' or '[' matches only itself.
+ *
+ * @param automaton The automaton
+ * @param from The source state
+ * @param to The target state
+ * @param c The byte
+ * @param caseless Whether a letter matches in either case
+ * @return true if successful, false otherwise
+ */
+static bool
+add_literal_transition(rift_regex_automaton_t *automaton, rift_regex_state_t *from,
+                       rift_regex_state_t *to, char c, bool caseless)
+{
+    char pattern[3] = {c, '\0', '\0'};
+    if (strchr(".[]()*+?{}|^$\\", c)) {
+        pattern[0] = '\\';
+        pattern[1] = c;
+    }
+
+    // A letter becomes a class of both cases
+    char folded[RIFT_BYTE_CLASS_MAX_PATTERN_LENGTH];
+    if (caseless && rift_case_fold_pattern(pattern, folded, sizeof(folded))) {
+        return rift_automaton_add_transition(automaton, from, to, folded);
+    }
+
+    return rift_automaton_add_transition(automaton, from, to, pattern);
+}
+
+/**
+ * @brief Mark the entry and exit states of an atomic region
+ *
+ * @param start_state The entry state
+ * @param end_state The exit state
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+static bool
+mark_atomic(rift_regex_state_t *start_state, rift_regex_state_t *end_state,
+            rift_regex_error_t *error)
+{
+    if (!rift_automaton_set_state_flag(start_state, RIFT_STATE_FLAG_ATOMIC_START) ||
+        !rift_automaton_set_state_flag(end_state, RIFT_STATE_FLAG_ATOMIC_END)) {
+        if (error) {
+            RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_MEMORY, "Failed to set atomic flags");
+        }
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Check whether a quantifier pattern carries the possessive modifier
+ *
+ * @param pattern The quantifier pattern string (e.g. "*+", "{2,}+")
+ * @return true if the quantifier is possessive
+ */
+static bool
+is_possessive_quantifier(const char *pattern)
+{
+    size_t length = strlen(pattern);
+    return length > 1 && pattern[length - 1] == '+';
+}
+
 ompiler/compiler.h"/a #include "core/runtime/matcher.h"
 /**
  * @brief Handle quantifier (*, +, ?, {m,n}) node
@@ -688,11 +1060,9 @@ handle_quantifier(rift_regex_automaton_t *automaton, const rift_regex_ast_node_t
             return false;
         }
 
-        // Connect start and end states
-        if (!rift_automaton_create_epsilon_transition(automaton, *start_state, *end_state) ||
-            !rift_automaton_create_epsilon_transition(automaton, *start_state, sub_start) ||
-            !rift_automaton_create_epsilon_transition(automaton, sub_end, *end_state) ||
-            !rift_automaton_create_epsilon_transition(automaton, sub_end, sub_start)) {
+        // Connect start and end states, the preferred branch first
+        if (!add_branches(automaton, *start_state, sub_start, *end_state, is_greedy) ||
+            !add_branches(automaton, sub_end, sub_start, *end_state, is_greedy)) {
             if (error) {
                 RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_MEMORY,
                                      "Failed to create epsilon transition", 0);
@@ -708,10 +1078,9 @@ handle_quantifier(rift_regex_automaton_t *automaton, const rift_regex_ast_node_t
             return false;
         }
 
-        // Connect start and end states
+        // Connect start and end states, the preferred branch first
         if (!rift_automaton_create_epsilon_transition(automaton, *start_state, sub_start) ||
-            !rift_automaton_create_epsilon_transition(automaton, sub_end, *end_state) ||
-            !rift_automaton_create_epsilon_transition(automaton, sub_end, sub_start)) {
+            !add_branches(automaton, sub_end, sub_start, *end_state, is_greedy)) {
             if (error) {
                 RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_MEMORY,
                                      "Failed to create epsilon transition", 0);
@@ -727,9 +1096,8 @@ handle_quantifier(rift_regex_automaton_t *automaton, const rift_regex_ast_node_t
             return false;
         }
 
-        // Connect start and end states
-        if (!rift_automaton_create_epsilon_transition(automaton, *start_state, *end_state) ||
-            !rift_automaton_create_epsilon_transition(automaton, *start_state, sub_start) ||
+        // Connect start and end states, the preferred branch first
+        if (!add_branches(automaton, *start_state, sub_start, *end_state, is_greedy) ||
             !rift_automaton_create_epsilon_transition(automaton, sub_end, *end_state)) {
             if (error) {
                 RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_MEMORY,
@@ -738,117 +1106,78 @@ handle_quantifier(rift_regex_automaton_t *automaton, const rift_regex_ast_node_t
             return false;
         }
     } else {
-        // {m,n} - Between m and n repetitions
-
-        // First, handle the minimum number of repetitions
-        rift_regex_state_t *prev_end = *start_state;
-
-        for (size_t i = 0; i < min; i++) {
-            rift_regex_state_t *sub_start = NULL;
-            rift_regex_state_t *sub_end = NULL;
-
-            if (!convert_node_to_nfa(automaton, child, &sub_start, &sub_end, flags, error)) {
-                return false;
-            }
-
-            // Connect the previous end to this copy's start
-            if (!rift_automaton_create_epsilon_transition(automaton, prev_end, sub_start)) {
-                if (error) {
-                    RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_MEMORY,
-                                         "Failed to create epsilon transition", 0);
-                }
-                return false;
-            }
+        // {m,n} - One copy of the body, counted between m and n times
+        rift_regex_state_t *sub_start = NULL;
+        rift_regex_state_t *sub_end = NULL;
 
-            prev_end = sub_end;
+        if (!convert_node_to_nfa(automaton, child, &sub_start, &sub_end, flags, error)) {
+            return false;
         }
 
-        // If max is unlimited or there are additional optional repetitions
-        if (max == 0 || max > min) {
-            // Create a repeating section for the optional repetitions
-            rift_regex_state_t *optional_start = NULL;
-            rift_regex_state_t *optional_end = NULL;
-
-            if (!convert_node_to_nfa(automaton, child, &optional_start, &optional_end, flags,
-                                     error)) {
-                return false;
+        rift_regex_state_t *step = rift_automaton_create_state(automaton, false);
+        if (!step) {
+            if (error) {
+                RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_MEMORY,
+                                     "Failed to create counter state", 0);
             }
+            return false;
+        }
 
-            // Connect the last required repetition to the optional section
-            if (!rift_automaton_create_epsilon_transition(automaton, prev_end, optional_start)) {
+        // Entering the loop and ending an iteration may both repeat or leave, the counter decides
+        if (!rift_automaton_create_epsilon_transition(automaton, sub_end, step) ||
+            !add_branches(automaton, *start_state, sub_start, *end_state, is_greedy) ||
+            !add_branches(automaton, step, sub_start, *end_state, is_greedy)) {
+            if (error) {
                 RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_MEMORY,
                                      "Failed to create epsilon transition", 0);
-                return false;
             }
+            return false;
+        }
 
-            // For unlimited repetitions
-            if (max == 0) {
-                // Add a loop back to allow multiple repetitions
-                if (!rift_automaton_create_epsilon_transition(automaton, optional_end,
-                                                              optional_start)) {
-                    if (error) {
-                        RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_MEMORY,
-                                             "Failed to create epsilon transition");
-                    }
-                    return false;
-                }
-            } else {
-                if (!rift_automaton_create_epsilon_transition(automaton, optional_end,
-                                                              *end_state)) {
-                    if (error) {
-                        RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_MEMORY,
-                                             "Failed to create epsilon transition", 0);
-                    }
-
-                    return false;
-                }
+        if (min >= RIFT_COUNTER_UNBOUNDED || max >= RIFT_COUNTER_UNBOUNDED ||
+            !rift_counter_mark(*start_state, step, (uint32_t)min,
+                               max == 0 ? RIFT_COUNTER_UNBOUNDED : (uint32_t)max, is_greedy)) {
+            if (error) {
+                RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_INVALID_QUANTIFIER,
+                                     "Quantifier bounds out of range: '%s'", pattern);
             }
-        } else {
-            // For limited optional repetitions, create the remaining copies
-            rift_regex_state_t *optional_end = NULL; // Declare and initialize optional_end
-            rift_regex_state_t *opt_prev_end = optional_end;
-
-            // We already created one optional repetition, so start from 1
-            for (size_t i = 1; i < max - min; i++) {
-                rift_regex_state_t *sub_start = NULL;
-                rift_regex_state_t *sub_end = NULL;
-
-                if (!convert_node_to_nfa(automaton, child, &sub_start, &sub_end, flags, error)) {
-                    return false;
-                }
+            return false;
+        }
 
-                // Connect the previous optional end to this copy's start and to the final
-                // end
-                if (!rift_automaton_create_epsilon_transition(automaton, opt_prev_end, sub_start) ||
-                    !rift_automaton_create_epsilon_transition(automaton, opt_prev_end,
-                                                              *end_state)) {
-                    if (error) {
-                        RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_MEMORY,
-                                             "Failed to create epsilon transition", 0);
-                    }
-                    return false;
-                }
+        // Small loops, and loops whose body can match nothing, are unrolled right away
+        if (rift_counter_should_unroll(automaton, *start_state) &&
+            !rift_counter_expand(automaton, *start_state, error)) {
+            return false;
+        }
+    }
 
-                opt_prev_end = sub_end;
+    // A possessive quantifier is an atomic group around the greedy one
+    if (is_possessive_quantifier(pattern)) {
+        rift_regex_state_t *atomic_start = rift_automaton_create_state(automaton, false);
+        rift_regex_state_t *atomic_end = rift_automaton_create_state(automaton, false);
+        if (!atomic_start || !atomic_end) {
+            if (error) {
+                RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_MEMORY,
+                                     "Failed to create atomic states", 0);
             }
+            return false;
+        }
 
-            // Connect the last optional copy to the final end state
-            if (!rift_automaton_create_epsilon_transition(automaton, opt_prev_end, *end_state)) {
-                if (error) {
-                    RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_MEMORY,
-                                         "Failed to create epsilon transition", 0);
-                }
-                return false;
-            }
+        if (!mark_atomic(atomic_start, atomic_end, error)) {
+            return false;
         }
-        // Just connect the last required repetition to the end state
-        if (!rift_automaton_create_epsilon_transition(automaton, prev_end, *end_state)) {
+
+        if (!rift_automaton_create_epsilon_transition(automaton, atomic_start, *start_state) ||
+            !rift_automaton_create_epsilon_transition(automaton, *end_state, atomic_end)) {
             if (error) {
                 RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_MEMORY,
                                      "Failed to create epsilon transition", 0);
             }
             return false;
         }
+
+        *start_state = atomic_start;
+        *end_state = atomic_end;
     }
 
     return true;
@@ -861,7 +1190,7 @@ ompiler/compiler.h"/a #include "core/runtime/matcher.h"
 bool
 handle_character_class(rift_regex_automaton_t *automaton, const rift_regex_ast_node_t *node,
                        rift_regex_state_t **start_state, rift_regex_state_t **end_state,
-                       rift_regex_error_t *error)
+                       rift_regex_flags_t flags, rift_regex_error_t *error)
 {
     if (!automaton || !node || !start_state || !end_state) {
         if (error) {
@@ -893,6 +1222,12 @@ handle_character_class(rift_regex_automaton_t *automaton, const rift_regex_ast_n
         return false;
     }
 
+    // Case folding widens the class itself, so matching stays one bit test per byte
+    char folded[RIFT_BYTE_CLASS_MAX_PATTERN_LENGTH];
+    if (is_caseless(node, flags) && rift_case_fold_pattern(pattern, folded, sizeof(folded))) {
+        pattern = folded;
+    }
+
     // Add a transition for the character class
     // For character classes, we use the whole pattern as a transition condition
     if (!rift_automaton_add_transition(automaton, *start_state, *end_state, pattern)) {
@@ -913,7 +1248,7 @@ ompiler/compiler.h"/a #include "core/runtime/matcher.h"
 bool
 handle_literal(rift_regex_automaton_t *automaton, const rift_regex_ast_node_t *node,
                rift_regex_state_t **start_state, rift_regex_state_t **end_state,
-               rift_regex_error_t *error)
+               rift_regex_flags_t flags, rift_regex_error_t *error)
 {
     if (!automaton || !node || !start_state || !end_state) {
         if (error) {
@@ -944,26 +1279,25 @@ handle_literal(rift_regex_automaton_t *automaton, const rift_regex_ast_node_t *n
         return false;
     }
 
-    // For a single character literal, create a direct transition
-    if (strlen(pattern) == 1) {
-        if (!rift_automaton_add_transition(automaton, *start_state, *end_state, pattern)) {
-            if (error) {
-                RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_MEMORY,
-                                     "Failed to create literal transition");
+    // A literal of several bytes is a chain of states, one transition per byte
+    bool caseless = is_caseless(node, flags);
+    bool utf8 = caseless && (flags & RIFT_REGEX_FLAG_UTF8);
+    size_t pattern_len = strlen(pattern);
+    rift_regex_state_t *prev_state = *start_state;
+    for (size_t i = 0; i < pattern_len; i++) {
+        // A UTF-8 character with another case is one step with a path per variant
+        uint32_t codepoint = 0;
+        size_t step = 1;
+        if (utf8) {
+            size_t read = rift_utf8_decode(pattern + i, pattern_len - i, &codepoint);
+            if (read > 1 && rift_case_fold_other(codepoint) != codepoint) {
+                step = read;
             }
-            return false;
         }
-    } else {
-        // For multi-character literals, create a chain of states
-        rift_regex_state_t *prev_state = *start_state;
-        size_t pattern_len = strlen(pattern);
-
-        for (size_t i = 0; i < pattern_len - 1; i++) {
-            // Create a temporary character buffer for single character
-            char char_buf[2] = {pattern[i], '\0'};
 
-            // Create a new intermediate state
-            rift_regex_state_t *next_state = rift_automaton_create_state(automaton, false);
+        rift_regex_state_t *next_state = *end_state;
+        if (i + step < pattern_len) {
+            next_state = rift_automaton_create_state(automaton, false);
             if (!next_state) {
                 if (error) {
                     RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_MEMORY,
@@ -971,28 +1305,29 @@ handle_literal(rift_regex_automaton_t *automaton, const rift_regex_ast_node_t *n
                 }
                 return false;
             }
+        }
 
-            // Add transition for the current character
-            if (!rift_automaton_add_transition(automaton, prev_state, next_state, char_buf)) {
-                if (error) {
-                    RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_MEMORY,
-                                         "Failed to create literal transition");
-                }
-                return false;
-            }
-
-            prev_state = next_state;
+        bool added;
+        if (step > 1) {
+            uint32_t other = rift_case_fold_other(codepoint);
+            rift_utf8_range_t ranges[2] = {{codepoint, codepoint}, {other, other}};
+            rift_utf8_range_set_t set = {ranges, 2, 2};
+            added = add_codepoint_ranges(automaton, &set, prev_state, next_state);
+        } else {
+            added = add_literal_transition(automaton, prev_state, next_state, pattern[i],
+                                           caseless);
         }
+        i += step - 1;
 
-        // Add transition for the last character
-        char last_char_buf[2] = {pattern[pattern_len - 1], '\0'};
-        if (!rift_automaton_add_transition(automaton, prev_state, *end_state, last_char_buf)) {
+        if (!added) {
             if (error) {
                 RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_MEMORY,
                                      "Failed to create literal transition");
             }
             return false;
         }
+
+        prev_state = next_state;
     }
 
     return true;
@@ -1095,6 +1430,11 @@ handle_group(rift_regex_automaton_t *automaton, const rift_regex_ast_node_t *nod
             }
             return false;
         }
+    } else if (group_type == RIFT_REGEX_AST_NODE_ATOMIC_GROUP) {
+        // Atomic group - leaving it discards the backtrack points taken inside
+        if (!mark_atomic(*start_state, *end_state, error)) {
+            return false;
+        }
     }
     // Non-capturing groups don't need special handling
 
@@ -1215,11 +1555,249 @@ handle_anchor(rift_regex_automaton_t *automaton, const rift_regex_ast_node_t *no
     return true;
 }
 
+/**
+ * @brief Find what keeps a lookaround body from being compiled on its own
+ *
+ * Groups inside a body would be numbered in the body's automaton, where no
+ * engine reports them, and a nested lookaround would need its own evaluator.
+ *
+ * @param node The body or a node under it
+ * @return A description of the problem, or NULL if there is none
+ */
+static const char *
+lookaround_body_problem(const rift_regex_ast_node_t *node)
+{
+    switch (rift_regex_ast_get_node_type(node)) {
+    case RIFT_REGEX_AST_NODE_GROUP:
+    case RIFT_REGEX_AST_NODE_NAMED_GROUP:
+        return "Capturing groups inside lookarounds are not supported";
+
+    case RIFT_REGEX_AST_NODE_LOOKAHEAD:
+    case RIFT_REGEX_AST_NODE_NEGATIVE_LOOKAHEAD:
+    case RIFT_REGEX_AST_NODE_LOOKBEHIND:
+    case RIFT_REGEX_AST_NODE_NEGATIVE_LOOKBEHIND:
+        return "Nested lookarounds are not supported";
+
+    default:
+        break;
+    }
+
+    size_t count = rift_regex_ast_get_child_count(node);
+    for (size_t i = 0; i < count; i++) {
+        const char *problem = lookaround_body_problem(rift_regex_ast_get_child(node, i));
+        if (problem) {
+            return problem;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Compute the number of bytes every match of a node has
+ *
+ * @param node The node
+ * @param flags Compilation flags
+ * @param length Pointer to store the length
+ * @return true if all matches have the same length, false otherwise
+ */
+static bool
+fixed_match_length(const rift_regex_ast_node_t *node, rift_regex_flags_t flags, size_t *length)
+{
+    const char *value = rift_regex_ast_get_node_value(node);
+    size_t count = rift_regex_ast_get_child_count(node);
+
+    switch (rift_regex_ast_get_node_type(node)) {
+    case RIFT_REGEX_AST_NODE_LITERAL:
+        // Folded UTF-8 letters have the length of their other case
+        *length = value ? strlen(value) : 0;
+        return value != NULL;
+
+    case RIFT_REGEX_AST_NODE_CHARACTER_CLASS:
+        // A class of whole UTF-8 characters takes one to four bytes
+        *length = 1;
+        return value && !((flags & RIFT_REGEX_FLAG_UTF8) && rift_utf8_class_needs_ranges(value));
+
+    case RIFT_REGEX_AST_NODE_DOT:
+        *length = 1;
+        return !(flags & RIFT_REGEX_FLAG_UTF8);
+
+    case RIFT_REGEX_AST_NODE_ANCHOR:
+        *length = 0;
+        return true;
+
+    case RIFT_REGEX_AST_NODE_GROUP:
+    case RIFT_REGEX_AST_NODE_NON_CAPTURING_GROUP:
+    case RIFT_REGEX_AST_NODE_NAMED_GROUP:
+    case RIFT_REGEX_AST_NODE_ATOMIC_GROUP:
+        return count == 1 && fixed_match_length(rift_regex_ast_get_child(node, 0), flags, length);
+
+    case RIFT_REGEX_AST_NODE_CONCATENATION:
+    case RIFT_REGEX_AST_NODE_ALTERNATION: {
+        bool is_sequence =
+            rift_regex_ast_get_node_type(node) == RIFT_REGEX_AST_NODE_CONCATENATION;
+        size_t total = 0;
+        for (size_t i = 0; i < count; i++) {
+            size_t child = 0;
+            if (!fixed_match_length(rift_regex_ast_get_child(node, i), flags, &child)) {
+                return false;
+            }
+            if (is_sequence) {
+                if (child > SIZE_MAX - total) {
+                    return false;
+                }
+                total += child;
+            } else if (i > 0 && child != total) {
+                return false;
+            } else {
+                total = child;
+            }
+        }
+        *length = total;
+        return count > 0 || is_sequence;
+    }
+
+    case RIFT_REGEX_AST_NODE_QUANTIFIER: {
+        // A maximum of 0 means no limit, so {0} is not counted as fixed
+        size_t min = 0;
+        size_t max = 0;
+        bool is_greedy = true;
+        size_t child = 0;
+        if (count != 1 || !parse_quantifier_values(value, &min, &max, &is_greedy) ||
+            min != max || max == 0 ||
+            !fixed_match_length(rift_regex_ast_get_child(node, 0), flags, &child) ||
+            (child > 0 && min > SIZE_MAX / child)) {
+            return false;
+        }
+        *length = child * min;
+        return true;
+    }
+
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Handle lookaround nodes
+ *
+ * The body is compiled into an automaton of its own and added to the
+ * automaton's lookaround table; the node itself becomes a state running the
+ * assertion, joined to its end by an epsilon transition.
+ */
+bool
+handle_lookaround(rift_regex_automaton_t *automaton, const rift_regex_ast_node_t *node,
+                  rift_regex_state_t **start_state, rift_regex_state_t **end_state,
+                  rift_regex_flags_t flags, rift_regex_error_t *error)
+{
+    if (!automaton || !node || !start_state || !end_state) {
+        if (error) {
+            RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                                 "Invalid parameters for lookaround handling");
+        }
+        return false;
+    }
+
+    rift_regex_ast_node_type_t type = rift_regex_ast_get_node_type(node);
+    bool is_behind = type == RIFT_REGEX_AST_NODE_LOOKBEHIND ||
+                     type == RIFT_REGEX_AST_NODE_NEGATIVE_LOOKBEHIND;
+    bool is_negated = type == RIFT_REGEX_AST_NODE_NEGATIVE_LOOKAHEAD ||
+                      type == RIFT_REGEX_AST_NODE_NEGATIVE_LOOKBEHIND;
+
+    const rift_regex_ast_node_t *body_node = rift_regex_ast_get_child(node, 0);
+    if (!body_node) {
+        if (error) {
+            RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_INTERNAL, "Lookaround has no body");
+        }
+        return false;
+    }
+
+    const char *problem = lookaround_body_problem(body_node);
+    if (problem) {
+        if (error) {
+            RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE, "%s", problem);
+        }
+        return false;
+    }
+
+    // A lookbehind is checked over a window ending at the position, so it needs a fixed length
+    size_t length = 0;
+    if (is_behind && (!fixed_match_length(body_node, flags, &length) || length >= UINT32_MAX)) {
+        if (error) {
+            RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE,
+                                 "Lookbehind must match a fixed number of bytes");
+        }
+        return false;
+    }
+
+    // The body is built like a whole pattern, counted loops unrolled for the lazy DFA
+    rift_regex_automaton_t *body = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    if (!body) {
+        if (error) {
+            RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_MEMORY,
+                                 "Failed to create lookaround automaton");
+        }
+        return false;
+    }
+
+    rift_regex_state_t *body_start = NULL;
+    rift_regex_state_t *body_end = NULL;
+    if (!convert_node_to_nfa(body, body_node, &body_start, &body_end, flags, error)) {
+        rift_automaton_free(body);
+        return false;
+    }
+
+    if (!rift_automaton_set_state_accepting(body, body_end, true) ||
+        !rift_automaton_set_initial_state(body, body_start)) {
+        rift_automaton_free(body);
+        if (error) {
+            RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_INTERNAL,
+                                 "Failed to set lookaround start or end state");
+        }
+        return false;
+    }
+
+    if (!rift_automaton_expand_counters(body, error)) {
+        rift_automaton_free(body);
+        return false;
+    }
+
+    uint32_t index =
+        rift_automaton_add_lookaround(automaton, body, is_behind, is_negated, (uint32_t)length);
+    if (index == RIFT_STATE_NO_LOOKAROUND) {
+        if (error) {
+            RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_MEMORY, "Failed to add lookaround");
+        }
+        return false;
+    }
+
+    *start_state = rift_automaton_create_state(automaton, false);
+    *end_state = rift_automaton_create_state(automaton, false);
+    if (!*start_state || !*end_state) {
+        if (error) {
+            RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_MEMORY,
+                                 "Failed to create start or end states");
+        }
+        return false;
+    }
+    (*start_state)->lookaround = index;
+
+    if (!rift_automaton_create_epsilon_transition(automaton, *start_state, *end_state)) {
+        if (error) {
+            RIFT_REGEX_SET_ERROR(error, RIFT_REGEX_ERROR_MEMORY,
+                                 "Failed to create epsilon transition");
+        }
+        return false;
+    }
+
+    return true;
+}
+
 ompiler/compiler.h"/a #include "core/runtime/matcher.h"
 /**
  * @brief Parse quantifier values from a pattern string
  *
- * @param pattern The quantifier pattern string (e.g. "*", "+", "?", "{1,3}", "{2,}", "{4}")
+ * @param pattern The quantifier pattern string (e.g. "*", "+", "?", "{1,3}", "{2,}", "{4}"),
+ *        optionally followed by '?' (lazy) or '+' (possessive)
  * @param min Pointer to store minimum repetitions
  * @param max Pointer to store maximum repetitions (0 means unlimited)
  * @param is_greedy Pointer to store greediness flag
@@ -1235,16 +1813,16 @@ parse_quantifier_values(const char *pattern, size_t *min, size_t *max, bool *is_
     // Default to greedy
     *is_greedy = true;
 
-    // Handle standard quantifiers first
-    if (strcmp(pattern, "*") == 0) {
+    // Handle standard quantifiers first; a trailing '+' (possessive) stays greedy
+    if (strcmp(pattern, "*") == 0 || strcmp(pattern, "*+") == 0) {
         *min = 0;
         *max = 0; // Unlimited
         return true;
-    } else if (strcmp(pattern, "+") == 0) {
+    } else if (strcmp(pattern, "+") == 0 || strcmp(pattern, "++") == 0) {
         *min = 1;
         *max = 0; // Unlimited
         return true;
-    } else if (strcmp(pattern, "?") == 0) {
+    } else if (strcmp(pattern, "?") == 0 || strcmp(pattern, "?+") == 0) {
         *min = 0;
         *max = 1;
         return true;
@@ -1305,10 +1883,12 @@ parse_quantifier_values(const char *pattern, size_t *min, size_t *max, bool *is_
         return false;
     }
 
-    // Check for non-greedy modifier
+    // Check for non-greedy or possessive modifier
     if (*p == '?') {
         *is_greedy = false;
         p++;
+    } else if (*p == '+') {
+        p++;
     }
 
     // Pattern should be fully consumed
@@ -1334,62 +1914,15 @@ compute_epsilon_closure(const rift_regex_automaton_t *automaton, rift_regex_stat
         return false;
     }
 
-    // Initialize the closure with the input states
-    memcpy(closure, states, num_states * sizeof(rift_regex_state_t *));
-    *closure_size = num_states;
-
-    // Use a stack to track states to process
-    rift_regex_state_t **stack =
-        (rift_regex_state_t **)rift_malloc(num_states * sizeof(rift_regex_state_t *));
-    if (!stack) {
-        return false;
-    }
-
-    memcpy(stack, states, num_states * sizeof(rift_regex_state_t *));
-    size_t stack_size = num_states;
-    size_t stack_pos = 0;
-
-    // Process states until the stack is empty
-    while (stack_pos < stack_size) {
-        rift_regex_state_t *current = stack[stack_pos++];
-
-        // Get all epsilon transitions from the current state
-        rift_regex_transition_t **transitions = NULL;
-        size_t num_transitions =
-            rift_automaton_get_state_transitions(automaton, current, &transitions);
-
-        // Process each epsilon transition
-        for (size_t i = 0; i < num_transitions; i++) {
-            if (rift_automaton_is_epsilon_transition(transitions[i])) {
-                rift_regex_state_t *target = rift_automaton_transition_get_target(transitions[i]);
-
-                // Check if the target is already in the closure
-                bool found = false;
-                for (size_t j = 0; j < *closure_size; j++) {
-                    if (closure[j] == target) {
-                        found = true;
-                        break;
-                    }
-                }
-
-                // If not already in the closure, add it to both closure and stack
-                if (!found) {
-                    closure[(*closure_size)++] = target;
-                    stack[stack_size++] = target;
-                }
-            }
-        }
-
-        // Free transitions array if allocated by the get_state_transitions function
-        if (transitions) {
-            rift_free(transitions);
-        }
+    // An empty input set has an empty closure
+    if (num_states == 0) {
+        *closure_size = 0;
+        return true;
     }
 
-    // Free the stack
-    rift_free(stack);
-
-    return true;
+    // Union the per-state closures cached on the automaton
+    return rift_automaton_compute_epsilon_closure(automaton, states, num_states, closure,
+                                                  closure_size);
 }
 
 ompiler/compiler.h"/a #include "core/runtime/matcher.h"
@@ -1414,6 +1947,12 @@ compute_next_states(const rift_regex_automaton_t *automaton, rift_regex_state_t
 
     *next_size = 0;
 
+    // Targets are told apart by state ID, so a repeated one is dropped in constant time
+    rift_sparse_set_t seen;
+    if (!rift_sparse_set_init(&seen, (uint32_t)rift_automaton_get_state_count(automaton))) {
+        return false;
+    }
+
     // Process each state
     for (size_t i = 0; i < num_states; i++) {
         rift_regex_state_t *current = states[i];
@@ -1433,18 +1972,8 @@ compute_next_states(const rift_regex_automaton_t *automaton, rift_regex_state_t
             // Check if the transition matches the character
             if (rift_automaton_transition_matches(transitions[j], &c)) {
                 rift_regex_state_t *target = rift_automaton_transition_get_target(transitions[j]);
-
-                // Check if the target is already in the next states
-                bool found = false;
-                for (size_t k = 0; k < *next_size; k++) {
-                    if (next_states[k] == target) {
-                        found = true;
-                        break;
-                    }
-                }
-
-                // If not already in the next states, add it
-                if (!found) {
+                size_t id = rift_automaton_get_state_index(automaton, target);
+                if (id != RIFT_STATE_NO_ID && rift_sparse_set_insert(&seen, (uint32_t)id)) {
                     next_states[(*next_size)++] = target;
                 }
             }
@@ -1456,6 +1985,7 @@ compute_next_states(const rift_regex_automaton_t *automaton, rift_regex_state_t
         }
     }
 
+    rift_sparse_set_destroy(&seen);
     return true;
 }
 
@@ -0,0 +1,399 @@
+/**
+ * @file engine_plan.c
+ * @brief Implementation of compile-time engine selection
+ *
+ * This file checks each of the matcher's engines against a compiled pattern.
+ * Capture groups, backreferences, lookarounds and counted loops rule engines
+ * out outright; size limits are checked against the frozen automaton; and
+ * the bit-parallel and one-pass engines, whose fit depends on the shape of
+ * the automaton, are built once and freed again.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/compiler/engine_plan.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "core/automaton/bit_parallel.h"
+#include "core/automaton/frozen_automaton.h"
+#include "core/automaton/one_pass.h"
+#include "core/automaton/product.h"
+#include "core/automaton/state.h"
+#include "core/automaton/tdfa.h"
+#include "core/compiler/compiler.h"
+#include "core/config/config.h"
+
+/**
+ * @brief Set error information
+ *
+ * @param error The error structure to update (can be NULL)
+ * @param code The error code
+ * @param message The error message
+ */
+static void
+set_error(rift_regex_error_t *error, rift_regex_error_code_t code, const char *message)
+{
+    if (error) {
+        error->code = code;
+        snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH, "%s", message);
+    }
+}
+
+/**
+ * @brief Record whether an engine can run the pattern and why
+ *
+ * @param plan The plan
+ * @param engine The engine
+ * @param usable Whether the engine can run the pattern
+ * @param format printf-style format of the reason
+ */
+static void
+plan_set(rift_engine_plan_t *plan, rift_match_engine_t engine, bool usable, const char *format,
+         ...)
+{
+    va_list args;
+    va_start(args, format);
+    plan->usable[engine] = usable;
+    vsnprintf(plan->reasons[engine], RIFT_ENGINE_PLAN_REASON_LENGTH, format, args);
+    va_end(args);
+}
+
+/**
+ * @brief Initialize a plan to "not planned", allowing every engine
+ *
+ * @param plan The plan
+ */
+void
+rift_engine_plan_init(rift_engine_plan_t *plan)
+{
+    if (!plan) {
+        return;
+    }
+
+    memset(plan, 0, sizeof(*plan));
+    plan->engine = RIFT_MATCH_ENGINE_NONE;
+    for (int engine = 0; engine < RIFT_MATCH_ENGINE_COUNT; engine++) {
+        plan->usable[engine] = true;
+        snprintf(plan->reasons[engine], RIFT_ENGINE_PLAN_REASON_LENGTH, "not planned");
+    }
+    plan->search = RIFT_SEARCH_FORWARD;
+    snprintf(plan->search_reason, RIFT_ENGINE_PLAN_REASON_LENGTH, "not planned");
+}
+
+/**
+ * @brief Check the bit-parallel NFA by building it
+ *
+ * @param automaton The automaton
+ * @param plan The plan
+ */
+static void
+plan_bit_parallel(const rift_regex_automaton_t *automaton, rift_engine_plan_t *plan)
+{
+    rift_regex_error_t error = {0};
+    rift_bit_parallel_t *bit_parallel = rift_bit_parallel_create(automaton, &error);
+    if (!bit_parallel) {
+        plan_set(plan, RIFT_MATCH_ENGINE_BIT_PARALLEL, false, "%s",
+                 rift_regex_error_message(&error));
+        return;
+    }
+
+    plan->bit_parallel_positions = rift_bit_parallel_get_position_count(bit_parallel);
+    rift_bit_parallel_free(bit_parallel);
+    plan_set(plan, RIFT_MATCH_ENGINE_BIT_PARALLEL, true, "%zu of %d positions",
+             plan->bit_parallel_positions, RIFT_BIT_PARALLEL_MAX_POSITIONS);
+}
+
+/**
+ * @brief Check the one-pass DFA by building it
+ *
+ * @param automaton The automaton
+ * @param plan The plan
+ */
+static void
+plan_one_pass(const rift_regex_automaton_t *automaton, rift_engine_plan_t *plan)
+{
+    rift_regex_error_t error = {0};
+    rift_one_pass_t *one_pass = rift_one_pass_create(automaton, &error);
+    if (!one_pass) {
+        plan_set(plan, RIFT_MATCH_ENGINE_ONE_PASS, false, "%s", rift_regex_error_message(&error));
+        return;
+    }
+
+    rift_one_pass_free(one_pass);
+    plan_set(plan, RIFT_MATCH_ENGINE_ONE_PASS, true, "every byte leaves one way to continue");
+}
+
+/**
+ * @brief Choose the engines of a compiled pattern
+ *
+ * @param automaton The automaton of the pattern
+ * @param group_count Number of capture groups
+ * @param verdict The ambiguity verdict of the pattern (can be NULL)
+ * @param plan Pointer to store the plan
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if planned, false on invalid parameters
+ */
+bool
+rift_engine_plan_build(const rift_regex_automaton_t *automaton, size_t group_count,
+                       const rift_ambiguity_verdict_t *verdict, rift_engine_plan_t *plan,
+                       rift_regex_error_t *error)
+{
+    if (!plan) {
+        set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER, "Invalid parameters");
+        return false;
+    }
+
+    rift_engine_plan_init(plan);
+    if (!automaton) {
+        set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER, "Invalid parameters");
+        return false;
+    }
+
+    rift_frozen_automaton_t *frozen = rift_frozen_automaton_create(automaton, error);
+    if (!frozen) {
+        return false;
+    }
+    plan->num_states = frozen->num_states;
+    plan->group_count = group_count;
+    bool lookarounds = frozen->num_lookarounds > 0;
+    bool counters = frozen->num_counters > 0;
+    rift_frozen_automaton_free(frozen);
+
+    plan->planned = true;
+    plan_set(plan, RIFT_MATCH_ENGINE_NONE, false, "not an engine");
+    plan_set(plan, RIFT_MATCH_ENGINE_BYTECODE_VM, false, "runs rulesets, not single patterns");
+    plan_set(plan, RIFT_MATCH_ENGINE_BACKTRACKER, true, "runs every pattern");
+
+    // Only the backtracker keeps the text a group matched to compare against
+    if (verdict && verdict->has_backreference) {
+        static const rift_match_engine_t automaton_engines[] = {
+            RIFT_MATCH_ENGINE_LAZY_DFA, RIFT_MATCH_ENGINE_BIT_PARALLEL, RIFT_MATCH_ENGINE_ONE_PASS,
+            RIFT_MATCH_ENGINE_TDFA, RIFT_MATCH_ENGINE_PIKE_VM};
+        for (size_t i = 0; i < sizeof(automaton_engines) / sizeof(*automaton_engines); i++) {
+            plan_set(plan, automaton_engines[i], false, "backreferences need the backtracker");
+        }
+        plan_set(plan, RIFT_MATCH_ENGINE_BACKTRACKER, true, "the pattern has backreferences");
+        plan->engine = RIFT_MATCH_ENGINE_BACKTRACKER;
+        return true;
+    }
+
+    // The lazy DFA and bit-parallel NFA report match bounds only
+    bool dangerous = rift_ambiguity_is_dangerous(verdict);
+    bool prefer_dfa = dangerous;
+    if (group_count > 0 || lookarounds) {
+        const char *reason = group_count > 0 ? "reports bounds only, not capture groups"
+                                             : "lookarounds need the Pike VM";
+        plan_set(plan, RIFT_MATCH_ENGINE_LAZY_DFA, false, "%s", reason);
+        plan_set(plan, RIFT_MATCH_ENGINE_BIT_PARALLEL, false, "%s", reason);
+        prefer_dfa = false;
+    } else {
+        bool use_dfa = false;
+        if (!prefer_dfa &&
+            rift_config_get_regex_param(RIFT_REGEX_PARAM_USE_DFA_WHEN_POSSIBLE, &use_dfa) ==
+                RIFT_OK &&
+            use_dfa) {
+            prefer_dfa = true;
+        }
+        plan_set(plan, RIFT_MATCH_ENGINE_LAZY_DFA, true, "%s",
+                 dangerous ? "linear time for an ambiguous pattern"
+                 : prefer_dfa ? "preferred by the configuration"
+                              : "on request; the configuration prefers other engines");
+        plan_bit_parallel(automaton, plan);
+    }
+
+    // One-pass and tagged DFAs fill capture groups as they scan
+    plan_one_pass(automaton, plan);
+    if (lookarounds || counters) {
+        plan_set(plan, RIFT_MATCH_ENGINE_TDFA, false, "%s",
+                 lookarounds ? "lookarounds are not supported" : "counted loops are not supported");
+    } else if (plan->num_states > RIFT_TDFA_MAX_NFA_STATES) {
+        plan_set(plan, RIFT_MATCH_ENGINE_TDFA, false, "%zu states, over %d", plan->num_states,
+                 RIFT_TDFA_MAX_NFA_STATES);
+    } else {
+        plan_set(plan, RIFT_MATCH_ENGINE_TDFA, true, "built at the first search, within %d states",
+                 RIFT_TDFA_MAX_STATES);
+    }
+    plan_set(plan, RIFT_MATCH_ENGINE_PIKE_VM, true, "linear time for every pattern");
+
+    static const rift_match_engine_t order[] = {
+        RIFT_MATCH_ENGINE_BIT_PARALLEL, RIFT_MATCH_ENGINE_ONE_PASS, RIFT_MATCH_ENGINE_TDFA,
+        RIFT_MATCH_ENGINE_PIKE_VM};
+    plan->engine = RIFT_MATCH_ENGINE_BACKTRACKER;
+    if (prefer_dfa) {
+        plan->engine = RIFT_MATCH_ENGINE_LAZY_DFA;
+    } else {
+        for (size_t i = 0; i < sizeof(order) / sizeof(*order); i++) {
+            if (plan->usable[order[i]]) {
+                plan->engine = order[i];
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Check whether a pattern's matches contain their suffix literal only at their end
+ *
+ * The intersection of the pattern's language with that of .*suffix.+ is
+ * empty exactly when no match has another occurrence ending before its end.
+ * Assertions restrict where a match may be but not what the DFA reads, so
+ * patterns with them are not checked.
+ *
+ * @param automaton The automaton of the pattern
+ * @param prefilter The literals of the pattern, with a suffix
+ * @return true if the suffix ends every match once, false if not or unknown
+ */
+static bool
+suffix_ends_matches_once(const rift_regex_automaton_t *automaton,
+                         const rift_prefilter_t *prefilter)
+{
+    rift_frozen_automaton_t *frozen = rift_frozen_automaton_create(automaton, NULL);
+    if (!frozen) {
+        return false;
+    }
+    const uint8_t asserting = RIFT_STATE_FLAG_ANCHOR_START | RIFT_STATE_FLAG_ANCHOR_END |
+                              RIFT_STATE_FLAG_WORD_BOUNDARY | RIFT_STATE_FLAG_NOT_WORD_BOUNDARY;
+    bool plain = frozen->num_lookarounds == 0 && frozen->num_counters == 0;
+    for (uint32_t i = 0; i < frozen->num_states && plain; i++) {
+        plain = (frozen->state_flags[i] & asserting) == 0;
+    }
+    rift_frozen_automaton_free(frozen);
+    if (!plain) {
+        return false;
+    }
+
+    // Spell the suffix with hexadecimal escapes, so no byte of it is an operator
+    char probe[4 * RIFT_PREFILTER_MAX_LITERAL_LENGTH + 8];
+    size_t length = (size_t)snprintf(probe, sizeof(probe), ".*");
+    for (size_t i = 0; i < prefilter->suffix.length; i++) {
+        length += (size_t)snprintf(probe + length, sizeof(probe) - length, "\\x%02x",
+                                   (uint8_t)prefilter->suffix.bytes[i]);
+    }
+    snprintf(probe + length, sizeof(probe) - length, ".+");
+
+    rift_regex_flags_t flags = RIFT_REGEX_FLAG_DOTALL;
+    if (prefilter->caseless) {
+        flags |= RIFT_REGEX_FLAG_CASE_INSENSITIVE;
+    }
+    rift_regex_automaton_t *overlap = rift_regex_compile_pattern(probe, flags, NULL);
+    rift_frozen_automaton_t *pattern_dfa = rift_automaton_freeze_dfa(automaton, NULL);
+    rift_frozen_automaton_t *overlap_dfa =
+        overlap ? rift_automaton_freeze_dfa(overlap, NULL) : NULL;
+    rift_regex_automaton_t *both = pattern_dfa && overlap_dfa
+                                       ? rift_automaton_intersection(pattern_dfa, overlap_dfa, NULL)
+                                       : NULL;
+    rift_frozen_automaton_t *both_dfa = both ? rift_frozen_automaton_create(both, NULL) : NULL;
+
+    // Every state of the product is reachable, so an accepting one is a string of both
+    bool once = both_dfa != NULL;
+    for (uint32_t word = 0; once && word < (both_dfa->num_states + 63) / 64; word++) {
+        once = both_dfa->accept_bitmap[word] == 0;
+    }
+
+    rift_frozen_automaton_free(both_dfa);
+    rift_automaton_free(both);
+    rift_frozen_automaton_free(overlap_dfa);
+    rift_frozen_automaton_free(pattern_dfa);
+    rift_automaton_free(overlap);
+    return once;
+}
+
+/**
+ * @brief Choose how searches locate the start of a match
+ *
+ * @param plan The plan, built by rift_engine_plan_build()
+ * @param automaton The automaton of the pattern
+ * @param prefilter The literals of the pattern (can be NULL)
+ * @return true if a strategy other than RIFT_SEARCH_FORWARD was chosen
+ */
+bool
+rift_engine_plan_choose_search(rift_engine_plan_t *plan, const rift_regex_automaton_t *automaton,
+                               const rift_prefilter_t *prefilter)
+{
+    if (!plan) {
+        return false;
+    }
+
+    plan->search = RIFT_SEARCH_FORWARD;
+    if (!automaton || !prefilter) {
+        snprintf(plan->search_reason, RIFT_ENGINE_PLAN_REASON_LENGTH, "no literal is known");
+    } else if (prefilter->anchored_start) {
+        snprintf(plan->search_reason, RIFT_ENGINE_PLAN_REASON_LENGTH, "matches start at an anchor");
+    } else if (prefilter->prefix.length > 0) {
+        snprintf(plan->search_reason, RIFT_ENGINE_PLAN_REASON_LENGTH,
+                 "the prefix \"%.40s\" finds the starts", prefilter->prefix.bytes);
+    } else if (prefilter->suffix.length > 0 && suffix_ends_matches_once(automaton, prefilter)) {
+        plan->search = RIFT_SEARCH_REVERSE_SUFFIX;
+        snprintf(plan->search_reason, RIFT_ENGINE_PLAN_REASON_LENGTH,
+                 "every match ends at its only \"%.40s\"", prefilter->suffix.bytes);
+    } else if (prefilter->num_required > 0) {
+        plan->search = RIFT_SEARCH_INNER_LITERAL;
+        snprintf(plan->search_reason, RIFT_ENGINE_PLAN_REASON_LENGTH,
+                 "every match contains \"%.40s\"%s", prefilter->required[0].bytes,
+                 prefilter->num_required > 1 ? " or another literal" : "");
+    } else {
+        snprintf(plan->search_reason, RIFT_ENGINE_PLAN_REASON_LENGTH, "no literal is required");
+    }
+    return plan->search != RIFT_SEARCH_FORWARD;
+}
+
+/**
+ * @brief Get the name of a search strategy
+ *
+ * @param strategy The strategy
+ * @return A static lowercase name, "unknown" for an invalid strategy
+ */
+const char *
+rift_search_strategy_name(rift_search_strategy_t strategy)
+{
+    switch (strategy) {
+    case RIFT_SEARCH_FORWARD:
+        return "forward";
+    case RIFT_SEARCH_REVERSE_SUFFIX:
+        return "reverse-suffix";
+    case RIFT_SEARCH_INNER_LITERAL:
+        return "inner-literal";
+    default:
+        return "unknown";
+    }
+}
+
+/**
+ * @brief Check whether a plan lets an engine run the pattern
+ *
+ * @param plan The plan (can be NULL)
+ * @param engine The engine
+ * @return true if the engine is usable or the pattern was not planned
+ */
+bool
+rift_engine_plan_allows(const rift_engine_plan_t *plan, rift_match_engine_t engine)
+{
+    if (!plan || !plan->planned) {
+        return true;
+    }
+    if ((int)engine < 0 || engine >= RIFT_MATCH_ENGINE_COUNT) {
+        return false;
+    }
+
+    return plan->usable[engine];
+}
+
+/**
+ * @brief Get the reason recorded for an engine
+ *
+ * @param plan The plan
+ * @param engine The engine
+ * @return The reason, or an empty string
+ */
+const char *
+rift_engine_plan_get_reason(const rift_engine_plan_t *plan, rift_match_engine_t engine)
+{
+    if (!plan || (int)engine < 0 || engine >= RIFT_MATCH_ENGINE_COUNT) {
+        return "";
+    }
+
+    return plan->reasons[engine];
+}
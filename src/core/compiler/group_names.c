@@ -0,0 +1,222 @@
+/**
+ * @file group_names.c
+ * @brief Implementation of the compile-time table of named capture groups
+ *
+ * This file walks the AST in the order of opening parentheses, numbering the
+ * capturing groups as it goes, and stores the named ones in an open-addressing
+ * hash table keyed by FNV-1a hashes of the names.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/compiler/group_names.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/memory/memory.h"
+
+/* FNV-1a parameters */
+#define GROUP_NAMES_FNV_OFFSET 2166136261u
+#define GROUP_NAMES_FNV_PRIME 16777619u
+
+/**
+ * @brief Set an error code and message
+ *
+ * @param error The error to update (can be NULL)
+ * @param code The error code
+ * @param message The error message
+ */
+static void
+set_error(rift_regex_error_t *error, rift_regex_error_code_t code, const char *message)
+{
+    if (error) {
+        error->code = code;
+        snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH, "%s", message);
+    }
+}
+
+/**
+ * @brief Hash a group name with 32-bit FNV-1a
+ *
+ * @param name The name
+ * @return The hash
+ */
+static uint32_t
+hash_name(const char *name)
+{
+    uint32_t hash = GROUP_NAMES_FNV_OFFSET;
+    for (const unsigned char *c = (const unsigned char *)name; *c; c++) {
+        hash = (hash ^ *c) * GROUP_NAMES_FNV_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * @brief Count the named groups of a subtree and the bytes their names take
+ *
+ * @param node The subtree
+ * @param count Number of named groups, incremented
+ * @param bytes Bytes of the names with their terminators, incremented
+ */
+static void
+measure_names(const rift_regex_ast_node_t *node, size_t *count, size_t *bytes)
+{
+    if (!node) {
+        return;
+    }
+
+    const char *name = rift_regex_ast_get_node_value(node);
+    if (rift_regex_ast_get_node_type(node) == RIFT_REGEX_AST_NODE_NAMED_GROUP && name) {
+        (*count)++;
+        *bytes += strlen(name) + 1;
+    }
+
+    size_t num_children = rift_regex_ast_get_child_count(node);
+    for (size_t i = 0; i < num_children; i++) {
+        measure_names(rift_regex_ast_get_child(node, i), count, bytes);
+    }
+}
+
+/**
+ * @brief Find the slot of a name, or the empty slot it would go to
+ *
+ * @param names The table, with at least one empty slot
+ * @param name The name
+ * @param hash The hash of the name
+ * @return The slot
+ */
+static rift_group_name_slot_t *
+find_slot(const rift_group_names_t *names, const char *name, uint32_t hash)
+{
+    size_t mask = names->capacity - 1;
+    for (size_t i = hash & mask;; i = (i + 1) & mask) {
+        rift_group_name_slot_t *slot = &names->slots[i];
+        if (!slot->name || (slot->hash == hash && strcmp(slot->name, name) == 0)) {
+            return slot;
+        }
+    }
+}
+
+/**
+ * @brief Number the groups of a subtree and insert the named ones
+ *
+ * @param node The subtree
+ * @param names The table
+ * @param next_index Index of the next capturing group, incremented
+ * @param cursor Where the next name is copied, advanced
+ */
+static void
+insert_names(const rift_regex_ast_node_t *node, rift_group_names_t *names, uint32_t *next_index,
+             char **cursor)
+{
+    if (!node) {
+        return;
+    }
+
+    rift_regex_ast_node_type_t type = rift_regex_ast_get_node_type(node);
+    if (type == RIFT_REGEX_AST_NODE_GROUP || type == RIFT_REGEX_AST_NODE_NAMED_GROUP) {
+        uint32_t index = (*next_index)++;
+        const char *name = rift_regex_ast_get_node_value(node);
+        if (type == RIFT_REGEX_AST_NODE_NAMED_GROUP && name) {
+            uint32_t hash = hash_name(name);
+            rift_group_name_slot_t *slot = find_slot(names, name, hash);
+
+            /* A name reused by a later group keeps pointing at the first one */
+            if (!slot->name) {
+                size_t length = strlen(name) + 1;
+                memcpy(*cursor, name, length);
+                slot->name = *cursor;
+                slot->hash = hash;
+                slot->index = index;
+                *cursor += length;
+                names->count++;
+            }
+        }
+    }
+
+    size_t num_children = rift_regex_ast_get_child_count(node);
+    for (size_t i = 0; i < num_children; i++) {
+        insert_names(rift_regex_ast_get_child(node, i), names, next_index, cursor);
+    }
+}
+
+/**
+ * @brief Build the name table of an AST
+ *
+ * @param ast The AST
+ * @param error Pointer to store error information (can be NULL)
+ * @return The table, or NULL on failure
+ */
+rift_group_names_t *
+rift_group_names_build(const rift_regex_ast_t *ast, rift_regex_error_t *error)
+{
+    if (!ast) {
+        set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER, "Invalid parameter: AST is NULL");
+        return NULL;
+    }
+
+    const rift_regex_ast_node_t *root = rift_regex_ast_get_root(ast);
+    size_t count = 0;
+    size_t bytes = 0;
+    measure_names(root, &count, &bytes);
+
+    /* At most half full, so probes stay short and always end at an empty slot */
+    size_t capacity = 4;
+    while (capacity < count * 2) {
+        capacity *= 2;
+    }
+
+    rift_group_names_t *names = (rift_group_names_t *)rift_calloc(1, sizeof(rift_group_names_t));
+    if (names) {
+        names->capacity = capacity;
+        names->slots =
+            (rift_group_name_slot_t *)rift_calloc(capacity, sizeof(rift_group_name_slot_t));
+        names->names = bytes > 0 ? (char *)rift_malloc(bytes) : NULL;
+    }
+    if (!names || !names->slots || (bytes > 0 && !names->names)) {
+        rift_group_names_free(names);
+        set_error(error, RIFT_REGEX_ERROR_MEMORY, "Failed to allocate group name table");
+        return NULL;
+    }
+
+    uint32_t next_index = 1;
+    char *cursor = names->names;
+    insert_names(root, names, &next_index, &cursor);
+    return names;
+}
+
+/**
+ * @brief Find the index of a named group
+ *
+ * @param names The table (can be NULL)
+ * @param name The group name
+ * @return The group index, or RIFT_GROUP_NO_INDEX if no group has the name
+ */
+size_t
+rift_group_names_lookup(const rift_group_names_t *names, const char *name)
+{
+    if (!names || !name || names->count == 0) {
+        return RIFT_GROUP_NO_INDEX;
+    }
+
+    const rift_group_name_slot_t *slot = find_slot(names, name, hash_name(name));
+    return slot->name ? slot->index : RIFT_GROUP_NO_INDEX;
+}
+
+/**
+ * @brief Free a name table
+ *
+ * @param names The table (can be NULL)
+ */
+void
+rift_group_names_free(rift_group_names_t *names)
+{
+    if (!names) {
+        return;
+    }
+
+    rift_free(names->slots);
+    rift_free(names->names);
+    rift_free(names);
+}
@@ -0,0 +1,207 @@
+/**
+ * @file match_length.c
+ * @brief Implementation of the static match-length bounds
+ *
+ * This file walks the AST bottom-up: sequences add the bounds of their
+ * parts, alternations take the smallest minimum and the largest maximum of
+ * their branches, and quantifiers scale the bounds of their body by their
+ * repetition counts. Sums and products saturate at the unbounded length.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/compiler/match_length.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/compiler/compiler.h"
+#include "core/compiler/utf8_ranges.h"
+
+/* Most bytes one UTF-8 encoded character takes */
+#define MATCH_LENGTH_MAX_UTF8_BYTES 4
+
+/**
+ * @brief Add two lengths, saturating at the unbounded length
+ */
+static size_t
+add_length(size_t a, size_t b)
+{
+    return a > RIFT_MATCH_LENGTH_UNBOUNDED - b ? RIFT_MATCH_LENGTH_UNBOUNDED : a + b;
+}
+
+/**
+ * @brief Multiply two lengths, saturating at the unbounded length
+ */
+static size_t
+multiply_length(size_t a, size_t b)
+{
+    if (a == 0 || b == 0) {
+        return 0;
+    }
+    return a > RIFT_MATCH_LENGTH_UNBOUNDED / b ? RIFT_MATCH_LENGTH_UNBOUNDED : a * b;
+}
+
+/**
+ * @brief Compute the bounds of a node's matches
+ *
+ * @param node The node
+ * @param flags Compilation flags
+ * @param bounds Pointer to store the bounds
+ */
+static void
+analyze_node(const rift_regex_ast_node_t *node, rift_regex_flags_t flags,
+             rift_match_length_bounds_t *bounds)
+{
+    rift_match_length_bounds_init(bounds);
+    if (!node) {
+        return;
+    }
+
+    const char *value = rift_regex_ast_get_node_value(node);
+    size_t count = rift_regex_ast_get_child_count(node);
+    bool utf8 = (flags & RIFT_REGEX_FLAG_UTF8) != 0;
+
+    switch (rift_regex_ast_get_node_type(node)) {
+    case RIFT_REGEX_AST_NODE_LITERAL:
+        if (value) {
+            bounds->min = bounds->max = strlen(value);
+        }
+        return;
+
+    case RIFT_REGEX_AST_NODE_CHARACTER_CLASS:
+        // Classes of ASCII members compile to single-byte transitions even in UTF-8 mode
+        bounds->min = 1;
+        bounds->max = utf8 && (!value || rift_utf8_class_needs_ranges(value))
+                          ? MATCH_LENGTH_MAX_UTF8_BYTES
+                          : 1;
+        return;
+
+    case RIFT_REGEX_AST_NODE_DOT:
+        bounds->min = 1;
+        bounds->max = utf8 ? MATCH_LENGTH_MAX_UTF8_BYTES : 1;
+        return;
+
+    case RIFT_REGEX_AST_NODE_UNICODE_PROPERTY:
+        bounds->min = 1;
+        bounds->max = MATCH_LENGTH_MAX_UTF8_BYTES;
+        return;
+
+    case RIFT_REGEX_AST_NODE_ANCHOR:
+    case RIFT_REGEX_AST_NODE_WORD_BOUNDARY:
+    case RIFT_REGEX_AST_NODE_NOT_WORD_BOUNDARY:
+    case RIFT_REGEX_AST_NODE_LOOKAHEAD:
+    case RIFT_REGEX_AST_NODE_NEGATIVE_LOOKAHEAD:
+    case RIFT_REGEX_AST_NODE_LOOKBEHIND:
+    case RIFT_REGEX_AST_NODE_NEGATIVE_LOOKBEHIND:
+    case RIFT_REGEX_AST_NODE_COMMENT:
+    case RIFT_REGEX_AST_NODE_OPTION:
+        bounds->max = 0;
+        return;
+
+    case RIFT_REGEX_AST_NODE_GROUP:
+    case RIFT_REGEX_AST_NODE_NON_CAPTURING_GROUP:
+    case RIFT_REGEX_AST_NODE_NAMED_GROUP:
+    case RIFT_REGEX_AST_NODE_ATOMIC_GROUP:
+    case RIFT_REGEX_AST_NODE_ROOT:
+    case RIFT_REGEX_AST_NODE_PATTERN:
+    case RIFT_REGEX_AST_NODE_SEQUENCE:
+    case RIFT_REGEX_AST_NODE_CONCATENATION: {
+        rift_match_length_bounds_t total = {0, 0};
+        for (size_t i = 0; i < count; i++) {
+            rift_match_length_bounds_t child;
+            analyze_node(rift_regex_ast_get_child(node, i), flags, &child);
+            total.min = add_length(total.min, child.min);
+            total.max = add_length(total.max, child.max);
+        }
+        *bounds = total;
+        return;
+    }
+
+    case RIFT_REGEX_AST_NODE_ALTERNATION:
+        for (size_t i = 0; i < count; i++) {
+            rift_match_length_bounds_t child;
+            analyze_node(rift_regex_ast_get_child(node, i), flags, &child);
+            if (i == 0 || child.min < bounds->min) {
+                bounds->min = child.min;
+            }
+            if (i == 0 || child.max > bounds->max) {
+                bounds->max = child.max;
+            }
+        }
+        return;
+
+    case RIFT_REGEX_AST_NODE_QUANTIFIER: {
+        // A maximum of 0 means no limit, as it does for the compiler
+        size_t min = 0;
+        size_t max = 0;
+        bool is_greedy = true;
+        if (count != 1 || !parse_quantifier_values(value, &min, &max, &is_greedy)) {
+            return;
+        }
+
+        rift_match_length_bounds_t child;
+        analyze_node(rift_regex_ast_get_child(node, 0), flags, &child);
+        bounds->min = multiply_length(child.min, min);
+        bounds->max = max == 0 && child.max > 0 ? RIFT_MATCH_LENGTH_UNBOUNDED
+                                                : multiply_length(child.max, max);
+        return;
+    }
+
+    default:
+        // Backreferences and anything else may consume any number of bytes
+        return;
+    }
+}
+
+/**
+ * @brief Initialize bounds to "not analyzed"
+ *
+ * @param bounds The bounds
+ */
+void
+rift_match_length_bounds_init(rift_match_length_bounds_t *bounds)
+{
+    if (bounds) {
+        bounds->min = 0;
+        bounds->max = RIFT_MATCH_LENGTH_UNBOUNDED;
+    }
+}
+
+/**
+ * @brief Compute the bounds of a pattern's matches from its AST
+ *
+ * @param ast The AST
+ * @param flags Compilation flags
+ * @param bounds Pointer to store the bounds
+ * @return true if analyzed, false on invalid parameters
+ */
+bool
+rift_match_length_analyze(const rift_regex_ast_t *ast, rift_regex_flags_t flags,
+                          rift_match_length_bounds_t *bounds)
+{
+    if (!bounds) {
+        return false;
+    }
+
+    rift_match_length_bounds_init(bounds);
+    const rift_regex_ast_node_t *root = ast ? rift_regex_ast_get_root(ast) : NULL;
+    if (!root) {
+        return false;
+    }
+
+    analyze_node(root, flags, bounds);
+    return true;
+}
+
+/**
+ * @brief Check whether the maximum of some bounds is finite
+ *
+ * @param bounds The bounds
+ * @return true if the maximum is finite
+ */
+bool
+rift_match_length_is_bounded(const rift_match_length_bounds_t *bounds)
+{
+    return bounds && bounds->max != RIFT_MATCH_LENGTH_UNBOUNDED;
+}
@@ -0,0 +1,1106 @@
+/**
+ * @file prefilter.c
+ * @brief Implementation of literal extraction and substring prefiltering
+ *
+ * This file walks a pattern's AST bottom-up, computing for every node the
+ * literal its matches start with, the literal they end with and a set of
+ * literals one of which each match contains. Nodes whose matches are a single
+ * known string are tracked exactly so that adjacent literals join up, and a
+ * backreference repeats what is known about the group it refers to. The
+ * first bytes and the start anchor come from the compiled automaton instead,
+ * whose transition predicates are exactly what the matchers execute.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/compiler/prefilter.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/automaton/byte_class.h"
+#include "core/automaton/frozen_automaton.h"
+#include "core/automaton/state.h"
+#include "core/memory/memory.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef RIFT_BYTE_SCAN_SIMD128
+#include <wasm_simd128.h>
+#endif
+
+/**
+ * @brief Literals known about the matches of one AST node
+ */
+typedef struct prefilter_info {
+    bool exact;                      /**< Every match is exactly the prefix string */
+    rift_prefilter_literal_t prefix; /**< Literal every match starts with */
+    rift_prefilter_literal_t suffix; /**< Literal every match ends with */
+    rift_prefilter_literal_t required[RIFT_PREFILTER_MAX_LITERALS]; /**< Alternatives */
+    size_t num_required; /**< Number of required literals */
+} prefilter_info_t;
+
+/**
+ * @brief Store the first bytes of a string in a literal
+ */
+static void
+literal_set_head(rift_prefilter_literal_t *literal, const char *bytes, size_t length)
+{
+    if (length > RIFT_PREFILTER_MAX_LITERAL_LENGTH) {
+        length = RIFT_PREFILTER_MAX_LITERAL_LENGTH;
+    }
+    memcpy(literal->bytes, bytes, length);
+    literal->bytes[length] = '\0';
+    literal->length = length;
+}
+
+/**
+ * @brief Store the last bytes of a string in a literal
+ */
+static void
+literal_set_tail(rift_prefilter_literal_t *literal, const char *bytes, size_t length)
+{
+    if (length > RIFT_PREFILTER_MAX_LITERAL_LENGTH) {
+        bytes += length - RIFT_PREFILTER_MAX_LITERAL_LENGTH;
+        length = RIFT_PREFILTER_MAX_LITERAL_LENGTH;
+    }
+    memcpy(literal->bytes, bytes, length);
+    literal->bytes[length] = '\0';
+    literal->length = length;
+}
+
+/**
+ * @brief Store the concatenation of two literals, keeping its head or its tail
+ */
+static void
+literal_concat(rift_prefilter_literal_t *out, const rift_prefilter_literal_t *a,
+               const rift_prefilter_literal_t *b, bool keep_tail)
+{
+    char buffer[2 * RIFT_PREFILTER_MAX_LITERAL_LENGTH];
+    memcpy(buffer, a->bytes, a->length);
+    memcpy(buffer + a->length, b->bytes, b->length);
+
+    if (keep_tail) {
+        literal_set_tail(out, buffer, a->length + b->length);
+    } else {
+        literal_set_head(out, buffer, a->length + b->length);
+    }
+}
+
+/**
+ * @brief Get the length of the shortest literal in a set (0 for an empty set)
+ */
+static size_t
+set_min_length(const rift_prefilter_literal_t *literals, size_t count)
+{
+    if (count == 0) {
+        return 0;
+    }
+
+    size_t min_length = literals[0].length;
+    for (size_t i = 1; i < count; i++) {
+        if (literals[i].length < min_length) {
+            min_length = literals[i].length;
+        }
+    }
+    return min_length;
+}
+
+/**
+ * @brief Check whether a literal set rejects more input than another
+ *
+ * Longer literals occur less often and fewer alternatives cost fewer
+ * searches, so the shortest literal decides and the count breaks ties.
+ */
+static bool
+set_is_better(const rift_prefilter_literal_t *a, size_t a_count,
+              const rift_prefilter_literal_t *b, size_t b_count)
+{
+    size_t a_length = set_min_length(a, a_count);
+    size_t b_length = set_min_length(b, b_count);
+
+    if (a_length != b_length) {
+        return a_length > b_length;
+    }
+    return a_length > 0 && a_count < b_count;
+}
+
+/**
+ * @brief Replace the required set of a node by a single literal if that is better
+ */
+static void
+info_offer_required(prefilter_info_t *info, const rift_prefilter_literal_t *literal)
+{
+    if (set_is_better(literal, 1, info->required, info->num_required)) {
+        info->required[0] = *literal;
+        info->num_required = 1;
+    }
+}
+
+/**
+ * @brief Complete the required set of a node with its prefix and suffix
+ */
+static void
+info_finalize(prefilter_info_t *info)
+{
+    info_offer_required(info, &info->prefix);
+    info_offer_required(info, &info->suffix);
+
+    if (set_min_length(info->required, info->num_required) == 0) {
+        info->num_required = 0;
+    }
+}
+
+/**
+ * @brief Set a node to know nothing about its matches
+ */
+static void
+info_set_unknown(prefilter_info_t *info)
+{
+    memset(info, 0, sizeof(*info));
+}
+
+/**
+ * @brief Set a node to match exactly one string
+ */
+static void
+info_set_exact(prefilter_info_t *info, const char *bytes, size_t length)
+{
+    memset(info, 0, sizeof(*info));
+    literal_set_head(&info->prefix, bytes, length);
+    literal_set_tail(&info->suffix, bytes, length);
+    info->exact = length <= RIFT_PREFILTER_MAX_LITERAL_LENGTH;
+    info_finalize(info);
+}
+
+/**
+ * @brief Combine the information of two nodes matched one after the other
+ */
+static void
+info_concat(prefilter_info_t *out, const prefilter_info_t *a, const prefilter_info_t *b)
+{
+    if (a->exact && b->exact &&
+        a->prefix.length + b->prefix.length <= RIFT_PREFILTER_MAX_LITERAL_LENGTH) {
+        char buffer[RIFT_PREFILTER_MAX_LITERAL_LENGTH];
+        memcpy(buffer, a->prefix.bytes, a->prefix.length);
+        memcpy(buffer + a->prefix.length, b->prefix.bytes, b->prefix.length);
+        info_set_exact(out, buffer, a->prefix.length + b->prefix.length);
+        return;
+    }
+
+    prefilter_info_t result;
+    info_set_unknown(&result);
+
+    // Prefixes and suffixes extend through sides whose matches are known exactly
+    if (a->exact) {
+        literal_concat(&result.prefix, &a->prefix, &b->prefix, false);
+    } else {
+        result.prefix = a->prefix;
+    }
+    if (b->exact) {
+        literal_concat(&result.suffix, &a->suffix, &b->suffix, true);
+    } else {
+        result.suffix = b->suffix;
+    }
+
+    if (set_is_better(a->required, a->num_required, b->required, b->num_required)) {
+        memcpy(result.required, a->required, a->num_required * sizeof(a->required[0]));
+        result.num_required = a->num_required;
+    } else {
+        memcpy(result.required, b->required, b->num_required * sizeof(b->required[0]));
+        result.num_required = b->num_required;
+    }
+
+    // The end of one side runs straight into the start of the other
+    rift_prefilter_literal_t junction;
+    literal_concat(&junction, &a->suffix, &b->prefix, false);
+    info_offer_required(&result, &junction);
+
+    info_finalize(&result);
+    *out = result;
+}
+
+/**
+ * @brief Combine the information of alternatives
+ */
+static void
+info_alternate(prefilter_info_t *out, const prefilter_info_t *infos, size_t count)
+{
+    prefilter_info_t result;
+    info_set_unknown(&result);
+
+    result.prefix = infos[0].prefix;
+    result.suffix = infos[0].suffix;
+    bool all_required = true;
+
+    for (size_t i = 0; i < count; i++) {
+        const prefilter_info_t *info = &infos[i];
+
+        // Keep the longest common prefix and suffix
+        size_t prefix_length = 0;
+        while (prefix_length < result.prefix.length && prefix_length < info->prefix.length &&
+               result.prefix.bytes[prefix_length] == info->prefix.bytes[prefix_length]) {
+            prefix_length++;
+        }
+        result.prefix.length = prefix_length;
+        result.prefix.bytes[prefix_length] = '\0';
+
+        size_t suffix_length = 0;
+        while (suffix_length < result.suffix.length && suffix_length < info->suffix.length &&
+               result.suffix.bytes[result.suffix.length - 1 - suffix_length] ==
+                   info->suffix.bytes[info->suffix.length - 1 - suffix_length]) {
+            suffix_length++;
+        }
+        memmove(result.suffix.bytes, result.suffix.bytes + result.suffix.length - suffix_length,
+                suffix_length);
+        result.suffix.length = suffix_length;
+        result.suffix.bytes[suffix_length] = '\0';
+
+        // Every match contains a required literal of the alternative it took
+        if (info->num_required == 0) {
+            all_required = false;
+        }
+        for (size_t j = 0; all_required && j < info->num_required; j++) {
+            bool duplicate = false;
+            for (size_t k = 0; k < result.num_required && !duplicate; k++) {
+                duplicate = result.required[k].length == info->required[j].length &&
+                            memcmp(result.required[k].bytes, info->required[j].bytes,
+                                   info->required[j].length) == 0;
+            }
+            if (duplicate) {
+                continue;
+            }
+            if (result.num_required == RIFT_PREFILTER_MAX_LITERALS) {
+                all_required = false;
+                break;
+            }
+            result.required[result.num_required++] = info->required[j];
+        }
+    }
+
+    if (!all_required) {
+        result.num_required = 0;
+    }
+
+    info_finalize(&result);
+    *out = result;
+}
+
+/**
+ * @brief Check whether a literal node value stands for its own bytes
+ */
+static bool
+is_plain_literal(const char *value)
+{
+    for (const char *c = value; *c; c++) {
+        if (strchr(".[]()*+?{}|^$\\", *c)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Get the minimum repetition count of a quantifier
+ *
+ * @param value The quantifier value, such as "*", "+?" or "{2,5}"
+ * @param exactly_once Pointer to store whether the quantifier is {1} or {1,1}
+ * @return The minimum count, 0 if it cannot be parsed
+ */
+static size_t
+quantifier_min(const char *value, bool *exactly_once)
+{
+    *exactly_once = false;
+
+    if (!value) {
+        return 0;
+    }
+    if (value[0] == '+') {
+        return 1;
+    }
+    if (value[0] != '{') {
+        return 0;
+    }
+
+    char *end = NULL;
+    unsigned long min = strtoul(value + 1, &end, 10);
+    if (end == value + 1) {
+        return 0;
+    }
+    *exactly_once = min == 1 && (strncmp(end, "}", 1) == 0 || strncmp(end, ",1}", 3) == 0);
+    return (size_t)min;
+}
+
+/**
+ * @brief Find the capturing group a backreference refers to
+ *
+ * @param node The subtree to search
+ * @param index Number of the group, or 0 to look it up by name
+ * @param name Name of the group when index is 0
+ * @param next_index Number of the next capturing group, incremented
+ * @return The first group with that number or name, NULL if there is none
+ */
+static const rift_regex_ast_node_t *
+find_group(const rift_regex_ast_node_t *node, unsigned long index, const char *name,
+           unsigned long *next_index)
+{
+    if (!node) {
+        return NULL;
+    }
+
+    rift_regex_ast_node_type_t type = rift_regex_ast_get_node_type(node);
+    if (type == RIFT_REGEX_AST_NODE_GROUP || type == RIFT_REGEX_AST_NODE_NAMED_GROUP) {
+        unsigned long number = (*next_index)++;
+        const char *group_name = rift_regex_ast_get_node_value(node);
+        if (index ? number == index
+                  : type == RIFT_REGEX_AST_NODE_NAMED_GROUP && group_name &&
+                        strcmp(group_name, name) == 0) {
+            return node;
+        }
+    }
+
+    size_t num_children = rift_regex_ast_get_child_count(node);
+    for (size_t i = 0; i < num_children; i++) {
+        const rift_regex_ast_node_t *group =
+            find_group(rift_regex_ast_get_child(node, i), index, name, next_index);
+        if (group) {
+            return group;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Compute the literal information of an AST node
+ *
+ * @param node The node
+ * @param root Root of the AST, where backreferences find their groups (NULL
+ *        inside a group reached through a backreference)
+ * @param info Pointer to store the information
+ * @param disabled Pointer set to true if the pattern must not be prefiltered
+ */
+static void
+analyze_node(const rift_regex_ast_node_t *node, const rift_regex_ast_node_t *root,
+             prefilter_info_t *info, bool *disabled)
+{
+    info_set_unknown(info);
+
+    if (!node || *disabled) {
+        return;
+    }
+
+    if (node->flags & (RIFT_REGEX_FLAG_CASE_INSENSITIVE | RIFT_REGEX_FLAG_EXTENDED)) {
+        *disabled = true;
+        return;
+    }
+
+    size_t num_children = rift_regex_ast_get_child_count(node);
+
+    switch (rift_regex_ast_get_node_type(node)) {
+    case RIFT_REGEX_AST_NODE_LITERAL:
+    case RIFT_REGEX_AST_NODE_CHAR: {
+        const char *value = rift_regex_ast_get_node_value(node);
+        if (value && is_plain_literal(value)) {
+            info_set_exact(info, value, strlen(value));
+        }
+        return;
+    }
+
+    case RIFT_REGEX_AST_NODE_ANCHOR:
+    case RIFT_REGEX_AST_NODE_WORD_BOUNDARY:
+    case RIFT_REGEX_AST_NODE_NOT_WORD_BOUNDARY:
+    case RIFT_REGEX_AST_NODE_LOOKAHEAD:
+    case RIFT_REGEX_AST_NODE_NEGATIVE_LOOKAHEAD:
+    case RIFT_REGEX_AST_NODE_LOOKBEHIND:
+    case RIFT_REGEX_AST_NODE_NEGATIVE_LOOKBEHIND:
+    case RIFT_REGEX_AST_NODE_COMMENT:
+        // Zero-width nodes consume nothing
+        info_set_exact(info, "", 0);
+        return;
+
+    case RIFT_REGEX_AST_NODE_OPTION:
+        // Inline options can change how the following literals match
+        *disabled = true;
+        return;
+
+    case RIFT_REGEX_AST_NODE_QUANTIFIER: {
+        bool exactly_once = false;
+        if (num_children != 1 ||
+            quantifier_min(rift_regex_ast_get_node_value(node), &exactly_once) == 0) {
+            return;
+        }
+
+        // One or more repetitions keep the literals of a single one
+        analyze_node(rift_regex_ast_get_child(node, 0), root, info, disabled);
+        info->exact = info->exact && exactly_once;
+        return;
+    }
+
+    case RIFT_REGEX_AST_NODE_ALTERNATION: {
+        if (num_children == 0) {
+            info_set_exact(info, "", 0);
+            return;
+        }
+
+        prefilter_info_t *infos =
+            (prefilter_info_t *)rift_malloc(num_children * sizeof(prefilter_info_t));
+        if (!infos) {
+            *disabled = true;
+            return;
+        }
+        for (size_t i = 0; i < num_children; i++) {
+            analyze_node(rift_regex_ast_get_child(node, i), root, &infos[i], disabled);
+        }
+        info_alternate(info, infos, num_children);
+        rift_free(infos);
+        return;
+    }
+
+    case RIFT_REGEX_AST_NODE_CONCATENATION:
+    case RIFT_REGEX_AST_NODE_GROUP:
+    case RIFT_REGEX_AST_NODE_NON_CAPTURING_GROUP:
+    case RIFT_REGEX_AST_NODE_NAMED_GROUP:
+    case RIFT_REGEX_AST_NODE_ATOMIC_GROUP:
+    case RIFT_REGEX_AST_NODE_ROOT:
+    case RIFT_REGEX_AST_NODE_PATTERN:
+    case RIFT_REGEX_AST_NODE_SEQUENCE: {
+        info_set_exact(info, "", 0);
+        for (size_t i = 0; i < num_children; i++) {
+            prefilter_info_t child;
+            analyze_node(rift_regex_ast_get_child(node, i), root, &child, disabled);
+            info_concat(info, info, &child);
+        }
+        return;
+    }
+
+    case RIFT_REGEX_AST_NODE_BACKREFERENCE:
+    case RIFT_REGEX_AST_NODE_NAMED_BACKREFERENCE: {
+        const char *value = rift_regex_ast_get_node_value(node);
+        if (!root || !value) {
+            return;
+        }
+
+        // A backreference matches the very text its group did, so it has the group's literals
+        unsigned long index = 0;
+        if (rift_regex_ast_get_node_type(node) == RIFT_REGEX_AST_NODE_BACKREFERENCE) {
+            index = strtoul(value, NULL, 10);
+            if (index == 0) {
+                return;
+            }
+        }
+        unsigned long next_index = 1;
+        const rift_regex_ast_node_t *group = find_group(root, index, value, &next_index);
+        if (group) {
+            analyze_node(group, NULL, info, disabled);
+        }
+        return;
+    }
+
+    default:
+        // Classes and the rest match strings not known here
+        return;
+    }
+}
+
+/**
+ * @brief Cut a literal at its first non-ASCII byte
+ *
+ * @param literal The literal
+ * @param keep_tail Whether to keep the bytes after the last non-ASCII byte instead
+ * @return The new length
+ */
+static size_t
+cut_non_ascii(rift_prefilter_literal_t *literal, bool keep_tail)
+{
+    for (size_t i = 0; i < literal->length; i++) {
+        size_t pos = keep_tail ? literal->length - 1 - i : i;
+        if ((unsigned char)literal->bytes[pos] < 0x80) {
+            continue;
+        }
+        if (keep_tail) {
+            rift_prefilter_literal_t tail = *literal;
+            literal_set_tail(literal, tail.bytes + pos + 1, tail.length - pos - 1);
+        } else {
+            literal->length = pos;
+            literal->bytes[pos] = '\0';
+        }
+        break;
+    }
+    return literal->length;
+}
+
+/**
+ * @brief Keep only the parts of the literals that ASCII case folding can compare
+ *
+ * Part of a prefix, suffix or required literal is one as well, so cutting
+ * keeps the prefilter valid; a required literal cut to nothing leaves no
+ * literal required.
+ */
+static void
+cut_literals_to_ascii(rift_prefilter_t *prefilter)
+{
+    cut_non_ascii(&prefilter->prefix, false);
+    cut_non_ascii(&prefilter->suffix, true);
+    for (size_t i = 0; i < prefilter->num_required; i++) {
+        if (cut_non_ascii(&prefilter->required[i], false) == 0) {
+            prefilter->num_required = 0;
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Extract the literals of a pattern
+ *
+ * @param ast The AST of the pattern
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new prefilter or NULL on failure
+ */
+rift_prefilter_t *
+rift_prefilter_create(const rift_regex_ast_t *ast, rift_regex_error_t *error)
+{
+    if (!ast) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Invalid parameter: AST is NULL");
+        }
+        return NULL;
+    }
+
+    rift_prefilter_t *prefilter = (rift_prefilter_t *)rift_calloc(1, sizeof(rift_prefilter_t));
+    prefilter_info_t *info = (prefilter_info_t *)rift_malloc(sizeof(prefilter_info_t));
+    if (!prefilter || !info) {
+        rift_free(prefilter);
+        rift_free(info);
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_MEMORY;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Failed to allocate prefilter");
+        }
+        return NULL;
+    }
+
+    // Every byte may start a match until the automaton is analyzed
+    memset(prefilter->first_bytes, 0xff, sizeof(prefilter->first_bytes));
+    prefilter->num_first_bytes = 256;
+    prefilter->multiline = (ast->flags & RIFT_REGEX_FLAG_MULTILINE) != 0;
+
+    prefilter->caseless = (ast->flags & RIFT_REGEX_FLAG_CASE_INSENSITIVE) != 0;
+
+    bool disabled = (ast->flags & RIFT_REGEX_FLAG_EXTENDED) != 0;
+    analyze_node(rift_regex_ast_get_root(ast), rift_regex_ast_get_root(ast), info, &disabled);
+
+    if (!disabled) {
+        prefilter->prefix = info->prefix;
+        prefilter->suffix = info->suffix;
+        memcpy(prefilter->required, info->required, info->num_required * sizeof(info->required[0]));
+        prefilter->num_required = info->num_required;
+        if (prefilter->caseless && (ast->flags & RIFT_REGEX_FLAG_UTF8)) {
+            cut_literals_to_ascii(prefilter);
+        }
+    }
+
+    rift_free(info);
+    return prefilter;
+}
+
+/**
+ * @brief Walk the epsilon transitions reachable from the start state
+ *
+ * @param frozen The frozen automaton
+ * @param stop_at_anchor Whether to stop at states carrying a start anchor
+ * @param first_bytes Set to add the bytes of consuming transitions to (can be NULL)
+ * @param reaches_input Pointer set to true if an accepting state or consuming
+ *        transition is reached
+ * @param reaches_accept Pointer set to true if an accepting state is reached
+ * @return true if successful, false on allocation failure
+ */
+static bool
+walk_start_paths(const rift_frozen_automaton_t *frozen, bool stop_at_anchor, uint64_t *first_bytes,
+                 bool *reaches_input, bool *reaches_accept)
+{
+    uint32_t *stack = (uint32_t *)rift_malloc(frozen->num_states * sizeof(uint32_t));
+    uint64_t *visited = (uint64_t *)rift_calloc((frozen->num_states + 63) / 64, sizeof(uint64_t));
+    if (!stack || !visited) {
+        rift_free(stack);
+        rift_free(visited);
+        return false;
+    }
+
+    size_t depth = 0;
+    stack[depth++] = frozen->start_state;
+    visited[frozen->start_state / 64] |= 1ULL << (frozen->start_state % 64);
+
+    while (depth > 0) {
+        uint32_t state = stack[--depth];
+        if (stop_at_anchor && (frozen->state_flags[state] & RIFT_STATE_FLAG_ANCHOR_START)) {
+            continue;
+        }
+
+        if (rift_frozen_automaton_is_accepting(frozen, state)) {
+            *reaches_input = true;
+            *reaches_accept = true;
+        }
+
+        for (uint32_t edge = frozen->edge_offsets[state]; edge < frozen->edge_offsets[state + 1];
+             edge++) {
+            if (!rift_frozen_automaton_edge_is_epsilon(frozen, edge)) {
+                *reaches_input = true;
+                for (size_t word = 0; first_bytes && word < 4; word++) {
+                    first_bytes[word] |= frozen->edge_predicates[edge].bitmap[word];
+                }
+                continue;
+            }
+
+            uint32_t target = frozen->edge_targets[edge];
+            if (!(visited[target / 64] & (1ULL << (target % 64)))) {
+                visited[target / 64] |= 1ULL << (target % 64);
+                stack[depth++] = target;
+            }
+        }
+    }
+
+    rift_free(stack);
+    rift_free(visited);
+    return true;
+}
+
+/**
+ * @brief Add what the compiled automaton of a pattern tells about match starts
+ *
+ * @param prefilter The prefilter
+ * @param automaton The automaton compiled from the same pattern
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+bool
+rift_prefilter_analyze_automaton(rift_prefilter_t *prefilter,
+                                 const rift_regex_automaton_t *automaton,
+                                 rift_regex_error_t *error)
+{
+    if (!prefilter || !automaton) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Invalid parameters for automaton analysis");
+        }
+        return false;
+    }
+
+    rift_frozen_automaton_t *frozen = rift_frozen_automaton_create(automaton, error);
+    if (!frozen) {
+        return false;
+    }
+    if (frozen->start_state == RIFT_FROZEN_NO_STATE) {
+        rift_frozen_automaton_free(frozen);
+        return true;
+    }
+
+    uint64_t first_bytes[4] = {0};
+    bool unanchored = false;
+    bool nullable = false;
+    bool unused = false;
+    if (!walk_start_paths(frozen, true, NULL, &unanchored, &unused) ||
+        !walk_start_paths(frozen, false, first_bytes, &unused, &nullable)) {
+        rift_frozen_automaton_free(frozen);
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_MEMORY;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Failed to allocate automaton analysis");
+        }
+        return false;
+    }
+
+    prefilter->anchored_start = !unanchored;
+    prefilter->multiline = prefilter->multiline || (frozen->flags & RIFT_REGEX_FLAG_MULTILINE);
+
+    // An empty match can start in front of any byte
+    if (!nullable) {
+        memcpy(prefilter->first_bytes, first_bytes, sizeof(first_bytes));
+        prefilter->num_first_bytes = 0;
+        for (unsigned byte = 0; byte < 256; byte++) {
+            if (first_bytes[byte / 64] & (1ULL << (byte % 64))) {
+                prefilter->num_first_bytes++;
+            }
+        }
+    }
+
+    rift_frozen_automaton_free(frozen);
+    return true;
+}
+
+/**
+ * @brief Free a prefilter
+ *
+ * @param prefilter The prefilter to free
+ */
+void
+rift_prefilter_free(rift_prefilter_t *prefilter)
+{
+    rift_free(prefilter);
+}
+
+/**
+ * @brief Check whether a prefilter can reject any input
+ *
+ * @param prefilter The prefilter
+ * @return true if a prefix or required literal is known, false otherwise
+ */
+bool
+rift_prefilter_has_literals(const rift_prefilter_t *prefilter)
+{
+    return prefilter && (prefilter->prefix.length > 0 || prefilter->num_required > 0);
+}
+
+/**
+ * @brief Check whether a prefilter can rule out any start position
+ *
+ * @param prefilter The prefilter
+ * @return true if it has literals, a restricted first-byte set or an anchor
+ */
+bool
+rift_prefilter_can_skip(const rift_prefilter_t *prefilter)
+{
+    return rift_prefilter_has_literals(prefilter) ||
+           (prefilter && (prefilter->num_first_bytes < 256 || prefilter->anchored_start));
+}
+
+/**
+ * @brief Find the next occurrence of a byte
+ *
+ * memchr is a word-at-a-time loop in Wasm builds, so those compare 16 bytes
+ * per step instead.
+ *
+ * @param input The input bytes
+ * @param start First position to consider
+ * @param end Position after the last one to consider
+ * @param byte The byte
+ * @return Position of the byte or end if it does not occur
+ */
+size_t
+rift_prefilter_find_byte(const char *input, size_t start, size_t end, unsigned char byte)
+{
+#ifdef RIFT_BYTE_SCAN_SIMD128
+    size_t pos = start;
+    v128_t bytes = wasm_i8x16_splat((int8_t)byte);
+    for (; pos + 16 <= end; pos += 16) {
+        uint32_t mask = wasm_i8x16_bitmask(wasm_i8x16_eq(wasm_v128_load(input + pos), bytes));
+        if (mask != 0) {
+            return pos + (size_t)__builtin_ctz(mask);
+        }
+    }
+    for (; pos < end; pos++) {
+        if ((unsigned char)input[pos] == byte) {
+            return pos;
+        }
+    }
+    return end;
+#else
+    const char *found = (const char *)memchr(input + start, byte, end - start);
+    return found ? (size_t)(found - input) : end;
+#endif
+}
+
+/**
+ * @brief Find the first occurrence of a literal
+ *
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param start First position to consider
+ * @param literal The literal bytes
+ * @param literal_length Number of literal bytes
+ * @return Position of the occurrence or RIFT_PREFILTER_NO_CANDIDATE
+ */
+size_t
+rift_prefilter_find_literal(const char *input, size_t length, size_t start, const char *literal,
+                            size_t literal_length)
+{
+    if (!input || start > length) {
+        return RIFT_PREFILTER_NO_CANDIDATE;
+    }
+    if (literal_length == 0) {
+        return start;
+    }
+
+    while (length - start >= literal_length) {
+        size_t end = length - literal_length + 1;
+        size_t pos = rift_prefilter_find_byte(input, start, end, (unsigned char)literal[0]);
+        if (pos == end) {
+            break;
+        }
+
+        if (memcmp(input + pos + 1, literal + 1, literal_length - 1) == 0) {
+            return pos;
+        }
+        start = pos + 1;
+    }
+
+    return RIFT_PREFILTER_NO_CANDIDATE;
+}
+
+/**
+ * @brief Fold an ASCII letter to lower case
+ */
+static unsigned char
+fold_byte(unsigned char c)
+{
+    return c >= 'A' && c <= 'Z' ? (unsigned char)(c + ('a' - 'A')) : c;
+}
+
+/**
+ * @brief Compare two byte strings ignoring ASCII case
+ */
+static bool
+equal_caseless(const char *a, const char *b, size_t length)
+{
+    for (size_t i = 0; i < length; i++) {
+        if (fold_byte((unsigned char)a[i]) != fold_byte((unsigned char)b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Find the next byte equal to either case of a byte
+ *
+ * @param input The input bytes
+ * @param start First position to consider
+ * @param end Position after the last one to consider
+ * @param byte The byte
+ * @return Position of the byte or end if it does not occur
+ */
+static size_t
+find_byte_caseless(const char *input, size_t start, size_t end, unsigned char byte)
+{
+    unsigned char lower = fold_byte(byte);
+    unsigned char upper = lower >= 'a' && lower <= 'z' ? (unsigned char)(lower - ('a' - 'A'))
+                                                       : lower;
+    if (lower == upper) {
+        return rift_prefilter_find_byte(input, start, end, lower);
+    }
+
+    size_t pos = start;
+#if defined(RIFT_BYTE_SCAN_SIMD128)
+    v128_t lowers = wasm_i8x16_splat((int8_t)lower);
+    v128_t uppers = wasm_i8x16_splat((int8_t)upper);
+    while (pos + 16 <= end) {
+        v128_t block = wasm_v128_load(input + pos);
+        uint32_t mask = wasm_i8x16_bitmask(
+            wasm_v128_or(wasm_i8x16_eq(block, lowers), wasm_i8x16_eq(block, uppers)));
+        if (mask != 0) {
+            return pos + (size_t)__builtin_ctz(mask);
+        }
+        pos += 16;
+    }
+#elif defined(__SSE2__)
+    __m128i lowers = _mm_set1_epi8((char)lower);
+    __m128i uppers = _mm_set1_epi8((char)upper);
+    while (pos + 16 <= end) {
+        __m128i block = _mm_loadu_si128((const __m128i *)(input + pos));
+        int mask = _mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(block, lowers), _mm_cmpeq_epi8(block, uppers)));
+        if (mask != 0) {
+            return pos + (size_t)__builtin_ctz((unsigned int)mask);
+        }
+        pos += 16;
+    }
+#endif
+
+    for (; pos < end; pos++) {
+        if ((unsigned char)input[pos] == lower || (unsigned char)input[pos] == upper) {
+            return pos;
+        }
+    }
+    return end;
+}
+
+/**
+ * @brief Find the first occurrence of a literal, ignoring ASCII case
+ *
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param start First position to consider
+ * @param literal The literal bytes
+ * @param literal_length Number of literal bytes
+ * @return Position of the occurrence or RIFT_PREFILTER_NO_CANDIDATE
+ */
+size_t
+rift_prefilter_find_literal_caseless(const char *input, size_t length, size_t start,
+                                     const char *literal, size_t literal_length)
+{
+    if (!input || start > length) {
+        return RIFT_PREFILTER_NO_CANDIDATE;
+    }
+    if (literal_length == 0) {
+        return start;
+    }
+
+    while (length - start >= literal_length) {
+        size_t end = length - literal_length + 1;
+        size_t pos = find_byte_caseless(input, start, end, (unsigned char)literal[0]);
+        if (pos == end) {
+            break;
+        }
+
+        if (equal_caseless(input + pos + 1, literal + 1, literal_length - 1)) {
+            return pos;
+        }
+        start = pos + 1;
+    }
+
+    return RIFT_PREFILTER_NO_CANDIDATE;
+}
+
+/**
+ * @brief Find a literal of a prefilter, ignoring case if the pattern does
+ */
+static size_t
+find_literal(const rift_prefilter_t *prefilter, const char *input, size_t length, size_t start,
+             const rift_prefilter_literal_t *literal)
+{
+    if (prefilter->caseless) {
+        return rift_prefilter_find_literal_caseless(input, length, start, literal->bytes,
+                                                    literal->length);
+    }
+    return rift_prefilter_find_literal(input, length, start, literal->bytes, literal->length);
+}
+
+/**
+ * @brief Check whether a byte can begin a match
+ */
+static bool
+is_first_byte(const rift_prefilter_t *prefilter, uint8_t byte)
+{
+    return (prefilter->first_bytes[byte / 64] >> (byte % 64)) & 1;
+}
+
+/**
+ * @brief Find the next byte of the first-byte set
+ */
+static size_t
+find_first_byte(const rift_prefilter_t *prefilter, const char *input, size_t length, size_t start)
+{
+    if (prefilter->num_first_bytes == 1) {
+        for (unsigned byte = 0; byte < 256; byte++) {
+            if (is_first_byte(prefilter, (uint8_t)byte)) {
+                size_t pos = rift_prefilter_find_byte(input, start, length, (unsigned char)byte);
+                return pos < length ? pos : RIFT_PREFILTER_NO_CANDIDATE;
+            }
+        }
+    }
+
+    uint32_t set[RIFT_BYTE_SET_WORDS];
+    for (size_t w = 0; w < RIFT_BYTE_SET_WORDS; w++) {
+        set[w] = (uint32_t)(prefilter->first_bytes[w / 2] >> (w % 2 * 32));
+    }
+    size_t pos = rift_byte_set_find(set, input, start, length);
+    return pos < length ? pos : RIFT_PREFILTER_NO_CANDIDATE;
+}
+
+/**
+ * @brief Check whether a match can start at an anchored position
+ */
+static bool
+can_start_at(const rift_prefilter_t *prefilter, const char *input, size_t length, size_t pos)
+{
+    if (prefilter->prefix.length > 0) {
+        if (length - pos < prefilter->prefix.length) {
+            return false;
+        }
+        return prefilter->caseless
+                   ? equal_caseless(input + pos, prefilter->prefix.bytes, prefilter->prefix.length)
+                   : memcmp(input + pos, prefilter->prefix.bytes, prefilter->prefix.length) == 0;
+    }
+    if (prefilter->num_first_bytes < 256) {
+        return pos < length && is_first_byte(prefilter, (uint8_t)input[pos]);
+    }
+    return true;
+}
+
+/**
+ * @brief Find the next anchored position a match can start at
+ */
+static size_t
+find_anchored(const rift_prefilter_t *prefilter, const char *input, size_t length, size_t start)
+{
+    size_t pos = start;
+
+    while (true) {
+        // Only the start of the input, or of a line in multiline mode, passes ^
+        if (pos > 0 && !(prefilter->multiline && input[pos - 1] == '\n')) {
+            if (!prefilter->multiline || pos >= length) {
+                return RIFT_PREFILTER_NO_CANDIDATE;
+            }
+            const char *newline = (const char *)memchr(input + pos, '\n', length - pos);
+            if (!newline) {
+                return RIFT_PREFILTER_NO_CANDIDATE;
+            }
+            pos = (size_t)(newline - input) + 1;
+        }
+
+        if (can_start_at(prefilter, input, length, pos)) {
+            return pos;
+        }
+        if (pos >= length) {
+            return RIFT_PREFILTER_NO_CANDIDATE;
+        }
+        pos++;
+    }
+}
+
+/**
+ * @brief Find the first position where a match could start
+ *
+ * @param prefilter The prefilter
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param start First position to consider
+ * @param window_end Pointer to store the last position known to be a candidate (can be NULL)
+ * @return The candidate position or RIFT_PREFILTER_NO_CANDIDATE
+ */
+size_t
+rift_prefilter_find_candidate(const rift_prefilter_t *prefilter, const char *input, size_t length,
+                              size_t start, size_t *window_end)
+{
+    if (!input || start > length) {
+        return RIFT_PREFILTER_NO_CANDIDATE;
+    }
+
+    size_t candidate = start;
+    bool positional = true;
+
+    if (prefilter && prefilter->anchored_start) {
+        candidate = find_anchored(prefilter, input, length, start);
+    } else if (prefilter && prefilter->prefix.length > 0) {
+        candidate = find_literal(prefilter, input, length, start, &prefilter->prefix);
+    } else if (prefilter && prefilter->num_first_bytes < 256) {
+        candidate = find_first_byte(prefilter, input, length, start);
+    } else {
+        positional = false;
+    }
+    size_t last = positional ? candidate : length;
+
+    if (candidate != RIFT_PREFILTER_NO_CANDIDATE && prefilter && prefilter->num_required > 0) {
+        // A match starting at or before the earliest occurrence may contain it
+        size_t earliest = RIFT_PREFILTER_NO_CANDIDATE;
+        for (size_t i = 0; i < prefilter->num_required; i++) {
+            size_t pos = find_literal(prefilter, input, length, candidate, &prefilter->required[i]);
+            if (pos < earliest) {
+                earliest = pos;
+            }
+        }
+
+        if (earliest == RIFT_PREFILTER_NO_CANDIDATE) {
+            candidate = RIFT_PREFILTER_NO_CANDIDATE;
+        } else if (!positional) {
+            last = earliest;
+        }
+    }
+
+    if (window_end) {
+        *window_end = last;
+    }
+    return candidate;
+}
@@ -0,0 +1,821 @@
+/**
+ * @file simplify.c
+ * @brief Implementation of AST simplification before NFA construction
+ *
+ * This file rewrites a pattern's AST bottom-up. Each node's children are
+ * simplified first, then the node itself: sequences absorb nested sequences
+ * and merge adjacent literals, alternations absorb nested alternations,
+ * factor out the literal prefixes of their alternatives and turn runs of
+ * single-byte alternatives into one class, and quantifiers absorb simple
+ * quantifiers directly below them. Non-capturing groups are replaced by
+ * their contents, as the AST already makes the grouping explicit.
+ *
+ * Alternatives are only reordered across alternatives that start with a
+ * different literal byte: two such alternatives never both match at one
+ * position, so which is tried first cannot change a match.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/compiler/simplify.h"
+#include <stdlib.h>
+#include <string.h>
+#include "core/automaton/transition.h"
+#include "core/memory/memory.h"
+
+static rift_regex_ast_node_t *simplify_alternation(rift_regex_ast_node_t *node, size_t *rewrites);
+static rift_regex_ast_node_t *simplify_concatenation(rift_regex_ast_node_t *node,
+                                                     size_t *rewrites);
+
+/**
+ * @brief Create a node beside another, in the same arena and with the same flags
+ */
+static rift_regex_ast_node_t *
+create_like(const rift_regex_ast_node_t *like, rift_regex_ast_node_type_t type)
+{
+    rift_regex_ast_node_t *node = rift_regex_ast_node_create_in_arena(like->arena, type);
+    if (node) {
+        node->flags = like->flags;
+    }
+    return node;
+}
+
+/**
+ * @brief Free a node that was taken out of the tree, but not its children
+ */
+static void
+drop_node(rift_regex_ast_node_t *node)
+{
+    node->num_children = 0;
+    rift_regex_ast_node_free(node);
+}
+
+/**
+ * @brief Copy text into a new value for a node, from the node's arena or the heap
+ *
+ * @return The copy, or NULL if allocation fails
+ */
+static char *
+copy_value(const rift_regex_ast_node_t *node, const char *text, size_t length)
+{
+    char *value = node->arena ? (char *)rift_arena_alloc(node->arena, length + 1)
+                              : (char *)malloc(length + 1);
+    if (value) {
+        memcpy(value, text, length);
+        value[length] = '\0';
+    }
+    return value;
+}
+
+/**
+ * @brief Give a node a value made by copy_value, releasing the old one
+ */
+static void
+adopt_value(rift_regex_ast_node_t *node, char *value)
+{
+    if (!node->arena) {
+        free(node->value);
+    }
+    node->value = value;
+}
+
+/**
+ * @brief Replace the value of a node, leaving it unchanged if allocation fails
+ *
+ * @param node The node
+ * @param text The new value, which may point into the old one
+ * @param length Length of the new value
+ * @return true if the value was replaced, false otherwise
+ */
+static bool
+replace_value(rift_regex_ast_node_t *node, const char *text, size_t length)
+{
+    char *value = copy_value(node, text, length);
+    if (!value) {
+        return false;
+    }
+    adopt_value(node, value);
+    return true;
+}
+
+/**
+ * @brief Make room for a number of children without adding any
+ */
+static bool
+reserve_children(rift_regex_ast_node_t *node, size_t count)
+{
+    if (count <= node->child_capacity) {
+        return true;
+    }
+
+    rift_regex_ast_node_t **children =
+        node->arena ? (rift_regex_ast_node_t **)rift_arena_realloc(
+                          node->arena, node->children,
+                          sizeof(rift_regex_ast_node_t *) * node->child_capacity,
+                          sizeof(rift_regex_ast_node_t *) * count)
+                    : (rift_regex_ast_node_t **)realloc(node->children,
+                                                        sizeof(rift_regex_ast_node_t *) * count);
+    if (!children) {
+        return false;
+    }
+
+    node->children = children;
+    node->child_capacity = count;
+    return true;
+}
+
+/**
+ * @brief Make a list of nodes the children of a node
+ *
+ * The node must already have room for them.
+ */
+static void
+set_children(rift_regex_ast_node_t *node, rift_regex_ast_node_t **children, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        node->children[i] = children[i];
+        children[i]->parent = node;
+    }
+    node->num_children = count;
+}
+
+/**
+ * @brief Replace children of the same type as their parent by their own children
+ *
+ * Sequences in a sequence and alternations in an alternation add nothing.
+ */
+static void
+absorb_same_type(rift_regex_ast_node_t *node, size_t *rewrites)
+{
+    size_t count = 0;
+    bool nested = false;
+    for (size_t i = 0; i < node->num_children; i++) {
+        rift_regex_ast_node_t *child = node->children[i];
+        if (child->type == node->type && child->flags == node->flags) {
+            count += child->num_children;
+            nested = true;
+        } else {
+            count++;
+        }
+    }
+
+    if (!nested) {
+        return;
+    }
+
+    rift_regex_ast_node_t **children =
+        (rift_regex_ast_node_t **)malloc(sizeof(rift_regex_ast_node_t *) * (count ? count : 1));
+    if (!children || !reserve_children(node, count)) {
+        free(children);
+        return;
+    }
+
+    size_t next = 0;
+    for (size_t i = 0; i < node->num_children; i++) {
+        rift_regex_ast_node_t *child = node->children[i];
+        if (child->type == node->type && child->flags == node->flags) {
+            memcpy(children + next, child->children,
+                   sizeof(rift_regex_ast_node_t *) * child->num_children);
+            next += child->num_children;
+            drop_node(child);
+            (*rewrites)++;
+        } else {
+            children[next++] = child;
+        }
+    }
+
+    set_children(node, children, count);
+    free(children);
+}
+
+/**
+ * @brief Merge a run of literals into the first one, freeing the others
+ *
+ * @param run The literals
+ * @param count Number of literals
+ * @param length Total length of their values
+ * @return true if merged, false if memory ran out and the run is unchanged
+ */
+static bool
+merge_run(rift_regex_ast_node_t **run, size_t count, size_t length)
+{
+    char *text = (char *)malloc(length + 1);
+    if (!text) {
+        return false;
+    }
+
+    size_t offset = 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t part = strlen(run[i]->value);
+        memcpy(text + offset, run[i]->value, part);
+        offset += part;
+    }
+
+    bool merged = replace_value(run[0], text, length);
+    free(text);
+    if (!merged) {
+        return false;
+    }
+
+    for (size_t i = 1; i < count; i++) {
+        rift_regex_ast_node_free(run[i]);
+    }
+    return true;
+}
+
+/**
+ * @brief Merge runs of adjacent literals of a sequence into one literal
+ */
+static void
+merge_literals(rift_regex_ast_node_t *node, size_t *rewrites)
+{
+    size_t kept = 0;
+
+    for (size_t i = 0; i < node->num_children;) {
+        rift_regex_ast_node_t *first = node->children[i];
+        size_t end = i + 1;
+        size_t length = first->type == RIFT_REGEX_AST_NODE_LITERAL && first->value
+                            ? strlen(first->value)
+                            : 0;
+
+        while (length > 0 && end < node->num_children &&
+               node->children[end]->type == RIFT_REGEX_AST_NODE_LITERAL &&
+               node->children[end]->value && node->children[end]->flags == first->flags) {
+            length += strlen(node->children[end]->value);
+            end++;
+        }
+
+        if (end - i > 1 && merge_run(node->children + i, end - i, length)) {
+            node->children[kept++] = first;
+            (*rewrites)++;
+        } else {
+            for (size_t j = i; j < end; j++) {
+                node->children[kept++] = node->children[j];
+            }
+        }
+        i = end;
+    }
+
+    node->num_children = kept;
+}
+
+/**
+ * @brief Get the literal an alternative starts with
+ *
+ * @return The literal node, or NULL if the alternative starts otherwise
+ */
+static rift_regex_ast_node_t *
+leading_literal(rift_regex_ast_node_t *node)
+{
+    if (node->type == RIFT_REGEX_AST_NODE_CONCATENATION && node->num_children > 0) {
+        node = node->children[0];
+    }
+
+    if (node->type != RIFT_REGEX_AST_NODE_LITERAL || !node->value || !node->value[0]) {
+        return NULL;
+    }
+    return node;
+}
+
+/**
+ * @brief Strip a prefix off an alternative that starts with it
+ *
+ * @param node The alternative
+ * @param rest What is left of its leading literal, from copy_value, or NULL if nothing
+ * @return The rest of the alternative, an empty sequence if nothing is left
+ */
+static rift_regex_ast_node_t *
+strip_prefix(rift_regex_ast_node_t *node, char *rest)
+{
+    rift_regex_ast_node_t *literal = leading_literal(node);
+
+    if (rest) {
+        adopt_value(literal, rest);
+        return node;
+    }
+
+    if (node == literal) {
+        // The whole alternative was the prefix; what is left matches the empty string
+        adopt_value(node, NULL);
+        node->type = RIFT_REGEX_AST_NODE_CONCATENATION;
+        return node;
+    }
+
+    rift_regex_ast_node_free(rift_regex_ast_node_remove_child(node, 0));
+    if (node->num_children == 1) {
+        rift_regex_ast_node_t *only = node->children[0];
+        drop_node(node);
+        return only;
+    }
+    return node;
+}
+
+/**
+ * @brief Factor the common literal prefix out of a group of alternatives
+ *
+ * @param node The alternation the group comes from, only used for allocations
+ * @param group The alternatives, in the order they are tried
+ * @param count Number of alternatives, at least two
+ * @param rewrites Running count of rewrites
+ * @return The prefix followed by an alternation of the rests, or NULL on failure
+ */
+static rift_regex_ast_node_t *
+factor_group(rift_regex_ast_node_t *node, rift_regex_ast_node_t **group, size_t count,
+             size_t *rewrites)
+{
+    const char *first = leading_literal(group[0])->value;
+    size_t prefix = strlen(first);
+    for (size_t i = 1; i < count; i++) {
+        const char *value = leading_literal(group[i])->value;
+        size_t length = 0;
+        while (length < prefix && value[length] == first[length]) {
+            length++;
+        }
+        prefix = length;
+    }
+
+    // Everything the result needs is allocated before the alternatives are touched
+    rift_regex_ast_node_t *sequence = create_like(node, RIFT_REGEX_AST_NODE_CONCATENATION);
+    rift_regex_ast_node_t *literal = create_like(node, RIFT_REGEX_AST_NODE_LITERAL);
+    rift_regex_ast_node_t *rests = create_like(node, RIFT_REGEX_AST_NODE_ALTERNATION);
+    char **rest_values = (char **)calloc(count, sizeof(char *));
+    bool ready = sequence && literal && rests && rest_values &&
+                 replace_value(literal, first, prefix) && reserve_children(sequence, 2) &&
+                 reserve_children(rests, count);
+
+    for (size_t i = 0; ready && i < count; i++) {
+        rift_regex_ast_node_t *leading = leading_literal(group[i]);
+        size_t length = strlen(leading->value);
+        if (length > prefix) {
+            rest_values[i] = copy_value(leading, leading->value + prefix, length - prefix);
+            ready = rest_values[i] != NULL;
+        }
+    }
+
+    if (!ready) {
+        for (size_t i = 0; rest_values && i < count; i++) {
+            if (!leading_literal(group[i])->arena) {
+                free(rest_values[i]);
+            }
+        }
+        free(rest_values);
+        rift_regex_ast_node_free(sequence);
+        rift_regex_ast_node_free(literal);
+        rift_regex_ast_node_free(rests);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        group[i] = strip_prefix(group[i], rest_values[i]);
+    }
+    free(rest_values);
+    set_children(rests, group, count);
+    (*rewrites)++;
+
+    rift_regex_ast_node_t *parts[2] = {literal, simplify_alternation(rests, rewrites)};
+    set_children(sequence, parts, 2);
+    return simplify_concatenation(sequence, rewrites);
+}
+
+/**
+ * @brief Factor common literal prefixes out of the alternatives of an alternation
+ *
+ * An alternative joins the group of an earlier one starting with the same
+ * byte when everything between them starts with another literal byte.
+ */
+static void
+factor_prefixes(rift_regex_ast_node_t *node, size_t *rewrites)
+{
+    size_t count = node->num_children;
+    rift_regex_ast_node_t **group =
+        (rift_regex_ast_node_t **)malloc(sizeof(rift_regex_ast_node_t *) * count);
+    bool *taken = (bool *)calloc(count, sizeof(bool));
+    if (!group || !taken) {
+        free(group);
+        free(taken);
+        return;
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (taken[i]) {
+            continue;
+        }
+
+        rift_regex_ast_node_t *child = node->children[i];
+        rift_regex_ast_node_t *literal = leading_literal(child);
+        size_t members = 0;
+        group[members++] = child;
+
+        for (size_t j = i + 1; literal && j < count; j++) {
+            if (taken[j]) {
+                // Already moved into an earlier group, and possibly rewritten there
+                continue;
+            }
+            rift_regex_ast_node_t *other = leading_literal(node->children[j]);
+            if (!other) {
+                break;
+            }
+            if (other->value[0] == literal->value[0] &&
+                node->children[j]->flags == child->flags && other->flags == literal->flags) {
+                group[members++] = node->children[j];
+                taken[j] = true;
+            }
+        }
+
+        rift_regex_ast_node_t *factored =
+            members > 1 ? factor_group(node, group, members, rewrites) : NULL;
+        if (factored) {
+            node->children[kept++] = factored;
+            continue;
+        }
+
+        // Unfactored members keep their relative order right after the first
+        for (size_t m = 0; m < members; m++) {
+            node->children[kept++] = group[m];
+        }
+    }
+
+    node->num_children = kept;
+    for (size_t i = 0; i < kept; i++) {
+        node->children[i]->parent = node;
+    }
+
+    free(group);
+    free(taken);
+}
+
+/**
+ * @brief Get the bytes an alternative matches, if it matches exactly one byte
+ */
+static bool
+single_byte_set(const rift_regex_ast_node_t *node, rift_transition_predicate_t *predicate)
+{
+    switch (node->type) {
+    case RIFT_REGEX_AST_NODE_LITERAL:
+        if (!node->value || !node->value[0] || node->value[1]) {
+            return false;
+        }
+        memset(predicate, 0, sizeof(*predicate));
+        predicate->bitmap[(unsigned char)node->value[0] / 64] |=
+            (uint64_t)1 << ((unsigned char)node->value[0] % 64);
+        return true;
+
+    case RIFT_REGEX_AST_NODE_CHARACTER_CLASS:
+        return node->value && rift_transition_predicate_parse(node->value, predicate);
+
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Check whether a byte is in a byte set
+ */
+static bool
+set_has(const rift_transition_predicate_t *set, unsigned int c)
+{
+    return (set->bitmap[c / 64] >> (c % 64)) & 1;
+}
+
+/**
+ * @brief Write a bracket expression matching a set of bytes
+ *
+ * ']' goes first, '[' after the ordinary members so it never starts a
+ * named class, then '^' and '-' last, '-' moving to the front if '^' would
+ * otherwise start the list. Runs of three or more ordinary bytes become
+ * ranges.
+ *
+ * @param set The bytes, NUL excluded
+ * @param out Buffer of at least 4 * 256 + 3 bytes
+ */
+static void
+write_class(const rift_transition_predicate_t *set, char *out)
+{
+    size_t length = 0;
+    out[length++] = '[';
+
+    if (set_has(set, ']')) {
+        out[length++] = ']';
+    }
+
+    for (unsigned int c = 1; c < 256; c++) {
+        if (!set_has(set, c) || strchr("[]^-", (int)c)) {
+            continue;
+        }
+
+        unsigned int end = c;
+        while (end + 1 < 256 && set_has(set, end + 1) && !strchr("[]^-", (int)(end + 1))) {
+            end++;
+        }
+
+        out[length++] = (char)c;
+        if (end - c >= 2) {
+            out[length++] = '-';
+            out[length++] = (char)end;
+            c = end;
+        }
+    }
+
+    if (set_has(set, '[')) {
+        out[length++] = '[';
+    }
+
+    bool dash = set_has(set, '-');
+    if (set_has(set, '^')) {
+        if (length == 1 && dash) {
+            out[length++] = '-';
+            dash = false;
+        }
+        out[length++] = '^';
+    }
+    if (dash) {
+        out[length++] = '-';
+    }
+
+    out[length++] = ']';
+    out[length] = '\0';
+}
+
+/**
+ * @brief Turn the first of a run of single-byte alternatives into their union
+ *
+ * @param run The alternatives
+ * @param count Number of alternatives
+ * @param set The bytes they match together
+ * @return true if merged, false if the run is unchanged
+ */
+static bool
+merge_byte_run(rift_regex_ast_node_t **run, size_t count, const rift_transition_predicate_t *set)
+{
+    // NUL stands for the end of input and no bracket expression holds it
+    if (set_has(set, 0)) {
+        return false;
+    }
+
+    size_t members = 0;
+    unsigned int byte = 0;
+    for (unsigned int c = 1; c < 256; c++) {
+        if (set_has(set, c)) {
+            members++;
+            byte = c;
+        }
+    }
+
+    char text[4 * 256 + 3];
+    if (members == 0) {
+        return false;
+    } else if (members == 1) {
+        text[0] = (char)byte;
+        text[1] = '\0';
+    } else {
+        write_class(set, text);
+    }
+
+    if (!replace_value(run[0], text, strlen(text))) {
+        return false;
+    }
+
+    run[0]->type =
+        members == 1 ? RIFT_REGEX_AST_NODE_LITERAL : RIFT_REGEX_AST_NODE_CHARACTER_CLASS;
+    for (size_t i = 1; i < count; i++) {
+        rift_regex_ast_node_free(run[i]);
+    }
+    return true;
+}
+
+/**
+ * @brief Replace runs of adjacent single-byte alternatives by one class
+ */
+static void
+merge_single_bytes(rift_regex_ast_node_t *node, size_t *rewrites)
+{
+    size_t kept = 0;
+
+    for (size_t i = 0; i < node->num_children;) {
+        rift_regex_ast_node_t *first = node->children[i];
+        rift_transition_predicate_t set;
+        size_t end = i + 1;
+
+        if (single_byte_set(first, &set)) {
+            rift_transition_predicate_t next;
+            while (end < node->num_children && node->children[end]->flags == first->flags &&
+                   single_byte_set(node->children[end], &next)) {
+                for (size_t b = 0; b < 4; b++) {
+                    set.bitmap[b] |= next.bitmap[b];
+                }
+                end++;
+            }
+        }
+
+        if (end - i > 1 && merge_byte_run(node->children + i, end - i, &set)) {
+            node->children[kept++] = first;
+            (*rewrites)++;
+        } else {
+            for (size_t j = i; j < end; j++) {
+                node->children[kept++] = node->children[j];
+            }
+        }
+        i = end;
+    }
+
+    node->num_children = kept;
+}
+
+/**
+ * @brief Check whether a node is an empty sequence
+ */
+static bool
+is_empty(const rift_regex_ast_node_t *node)
+{
+    return node->type == RIFT_REGEX_AST_NODE_CONCATENATION && node->num_children == 0;
+}
+
+/**
+ * @brief Check whether a node may be put under a quantifier
+ */
+static bool
+is_quantifiable(const rift_regex_ast_node_t *node)
+{
+    switch (node->type) {
+    case RIFT_REGEX_AST_NODE_LITERAL:
+    case RIFT_REGEX_AST_NODE_CHARACTER_CLASS:
+    case RIFT_REGEX_AST_NODE_DOT:
+    case RIFT_REGEX_AST_NODE_CONCATENATION:
+    case RIFT_REGEX_AST_NODE_ALTERNATION:
+    case RIFT_REGEX_AST_NODE_GROUP:
+    case RIFT_REGEX_AST_NODE_NAMED_GROUP:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Simplify an alternation whose children are already simplified
+ *
+ * @return The node that replaces the alternation
+ */
+static rift_regex_ast_node_t *
+simplify_alternation(rift_regex_ast_node_t *node, size_t *rewrites)
+{
+    absorb_same_type(node, rewrites);
+    factor_prefixes(node, rewrites);
+    merge_single_bytes(node, rewrites);
+
+    if (node->num_children == 1) {
+        rift_regex_ast_node_t *only = node->children[0];
+        drop_node(node);
+        return only;
+    }
+
+    // X|empty is X? and empty|X is X??, which try the same branches in the same order
+    if (node->num_children == 2 && is_empty(node->children[0]) != is_empty(node->children[1])) {
+        bool empty_first = is_empty(node->children[0]);
+        rift_regex_ast_node_t *body = node->children[empty_first ? 1 : 0];
+        rift_regex_ast_node_t *empty = node->children[empty_first ? 0 : 1];
+
+        if (is_quantifiable(body) && body->flags == node->flags &&
+            replace_value(node, empty_first ? "??" : "?", empty_first ? 2 : 1)) {
+            node->type = RIFT_REGEX_AST_NODE_QUANTIFIER;
+            node->children[0] = body;
+            node->num_children = 1;
+            rift_regex_ast_node_free(empty);
+            (*rewrites)++;
+        }
+    }
+
+    return node;
+}
+
+/**
+ * @brief Simplify a sequence whose children are already simplified
+ *
+ * @return The node that replaces the sequence
+ */
+static rift_regex_ast_node_t *
+simplify_concatenation(rift_regex_ast_node_t *node, size_t *rewrites)
+{
+    absorb_same_type(node, rewrites);
+    merge_literals(node, rewrites);
+
+    if (node->num_children == 1) {
+        rift_regex_ast_node_t *only = node->children[0];
+        drop_node(node);
+        return only;
+    }
+    return node;
+}
+
+/**
+ * @brief Check whether a quantifier value is a plain greedy *, + or ?
+ */
+static bool
+is_simple_quantifier(const char *value)
+{
+    return value && (value[0] == '*' || value[0] == '+' || value[0] == '?') && !value[1];
+}
+
+/**
+ * @brief Fold simple quantifiers directly under a simple quantifier
+ *
+ * (?:a*)*, (?:a+)? and the like repeat the same strings as one quantifier:
+ * the same one when both agree, * otherwise.
+ */
+static void
+fold_quantifiers(rift_regex_ast_node_t *node, size_t *rewrites)
+{
+    while (node->num_children == 1 && is_simple_quantifier(node->value)) {
+        rift_regex_ast_node_t *child = node->children[0];
+        if (child->type != RIFT_REGEX_AST_NODE_QUANTIFIER || child->num_children != 1 ||
+            child->flags != node->flags || !is_simple_quantifier(child->value)) {
+            return;
+        }
+
+        if (node->value[0] != child->value[0] && !replace_value(node, "*", 1)) {
+            return;
+        }
+
+        node->children[0] = child->children[0];
+        node->children[0]->parent = node;
+        drop_node(child);
+        (*rewrites)++;
+    }
+}
+
+/**
+ * @brief Simplify a subtree
+ *
+ * @return The node that replaces the subtree's root
+ */
+static rift_regex_ast_node_t *
+simplify_node(rift_regex_ast_node_t *node, size_t *rewrites)
+{
+    for (size_t i = 0; i < node->num_children; i++) {
+        rift_regex_ast_node_t *child = simplify_node(node->children[i], rewrites);
+        node->children[i] = child;
+        child->parent = node;
+    }
+
+    switch (node->type) {
+    case RIFT_REGEX_AST_NODE_NON_CAPTURING_GROUP:
+        if (node->num_children == 1) {
+            rift_regex_ast_node_t *only = node->children[0];
+            drop_node(node);
+            (*rewrites)++;
+            return only;
+        }
+        return node;
+
+    case RIFT_REGEX_AST_NODE_CONCATENATION:
+        return simplify_concatenation(node, rewrites);
+
+    case RIFT_REGEX_AST_NODE_ALTERNATION:
+        return simplify_alternation(node, rewrites);
+
+    case RIFT_REGEX_AST_NODE_QUANTIFIER:
+        fold_quantifiers(node, rewrites);
+        return node;
+
+    default:
+        return node;
+    }
+}
+
+/**
+ * @brief Forget the content hashes of a rewritten tree
+ *
+ * The rewrites write node fields directly, so hashes computed before the
+ * pass, by validation for one, no longer describe the nodes.
+ */
+static void
+forget_hashes(rift_regex_ast_node_t *node)
+{
+    node->hash = 0;
+    for (size_t i = 0; i < node->num_children; i++) {
+        forget_hashes(node->children[i]);
+    }
+}
+
+/**
+ * @brief Simplify an AST without changing what it matches
+ *
+ * @param ast The AST, rewritten in place before it is compiled
+ * @return The number of rewrites made
+ */
+size_t
+rift_regex_simplify_ast(rift_regex_ast_t *ast)
+{
+    if (!ast || !ast->root) {
+        return 0;
+    }
+
+    size_t rewrites = 0;
+    ast->root = simplify_node(ast->root, &rewrites);
+    ast->root->parent = NULL;
+    if (rewrites > 0) {
+        forget_hashes(ast->root);
+    }
+    return rewrites;
+}
@@ -0,0 +1,602 @@
+/**
+ * @file utf8_ranges.c
+ * @brief Compilation of Unicode code point ranges into UTF-8 byte ranges
+ *
+ * Ranges are split the way the utf8-ranges crate does it: first at the
+ * surrogate gap and at the boundaries between encoded lengths, then at the
+ * smallest continuation byte boundary where the start and the end differ,
+ * until every byte of the start encoding pairs up with the same byte of the
+ * end encoding and the range is their cross product.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/compiler/utf8_ranges.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/compiler/case_fold.h"
+
+/**
+ * @brief Largest code point of each UTF-8 encoded length
+ */
+static const uint32_t length_limits[] = {0x7F, 0x7FF, 0xFFFF};
+
+/**
+ * @brief Decode one UTF-8 encoded code point
+ */
+size_t
+rift_utf8_decode(const char *text, size_t length, uint32_t *codepoint)
+{
+    if (!text || length == 0 || !codepoint) {
+        return 0;
+    }
+
+    const unsigned char *bytes = (const unsigned char *)text;
+    size_t count;
+    uint32_t value;
+    uint32_t minimum;
+    if (bytes[0] < 0x80) {
+        *codepoint = bytes[0];
+        return 1;
+    } else if ((bytes[0] & 0xE0) == 0xC0) {
+        count = 2;
+        value = bytes[0] & 0x1F;
+        minimum = 0x80;
+    } else if ((bytes[0] & 0xF0) == 0xE0) {
+        count = 3;
+        value = bytes[0] & 0x0F;
+        minimum = 0x800;
+    } else if ((bytes[0] & 0xF8) == 0xF0) {
+        count = 4;
+        value = bytes[0] & 0x07;
+        minimum = 0x10000;
+    } else {
+        return 0;
+    }
+
+    if (length < count) {
+        return 0;
+    }
+    for (size_t i = 1; i < count; i++) {
+        if ((bytes[i] & 0xC0) != 0x80) {
+            return 0;
+        }
+        value = (value << 6) | (bytes[i] & 0x3F);
+    }
+
+    if (value < minimum || value > RIFT_UTF8_MAX_CODEPOINT ||
+        (value >= 0xD800 && value <= 0xDFFF)) {
+        return 0;
+    }
+
+    *codepoint = value;
+    return count;
+}
+
+/**
+ * @brief Encode one code point as UTF-8
+ */
+size_t
+rift_utf8_encode(uint32_t codepoint, uint8_t *out)
+{
+    if (!out || codepoint > RIFT_UTF8_MAX_CODEPOINT ||
+        (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+        return 0;
+    }
+
+    if (codepoint <= 0x7F) {
+        out[0] = (uint8_t)codepoint;
+        return 1;
+    }
+    if (codepoint <= 0x7FF) {
+        out[0] = (uint8_t)(0xC0 | (codepoint >> 6));
+        out[1] = (uint8_t)(0x80 | (codepoint & 0x3F));
+        return 2;
+    }
+    if (codepoint <= 0xFFFF) {
+        out[0] = (uint8_t)(0xE0 | (codepoint >> 12));
+        out[1] = (uint8_t)(0x80 | ((codepoint >> 6) & 0x3F));
+        out[2] = (uint8_t)(0x80 | (codepoint & 0x3F));
+        return 3;
+    }
+    out[0] = (uint8_t)(0xF0 | (codepoint >> 18));
+    out[1] = (uint8_t)(0x80 | ((codepoint >> 12) & 0x3F));
+    out[2] = (uint8_t)(0x80 | ((codepoint >> 6) & 0x3F));
+    out[3] = (uint8_t)(0x80 | (codepoint & 0x3F));
+    return 4;
+}
+
+/**
+ * @brief Split a range and append its sequences
+ *
+ * @param start First code point
+ * @param end Last code point
+ * @param out Output array
+ * @param count Number of sequences written so far
+ */
+static void
+split_range(uint32_t start, uint32_t end, rift_utf8_sequence_t *out, size_t *count)
+{
+    if (start > end || *count >= RIFT_UTF8_MAX_SEQUENCES) {
+        return;
+    }
+
+    // Surrogates have no encoding
+    if (start < 0xD800 && end > 0xDFFF) {
+        split_range(start, 0xD7FF, out, count);
+        split_range(0xE000, end, out, count);
+        return;
+    }
+    if (start >= 0xD800 && start <= 0xDFFF) {
+        start = 0xE000;
+    }
+    if (end >= 0xD800 && end <= 0xDFFF) {
+        end = 0xD7FF;
+    }
+    if (start > end) {
+        return;
+    }
+
+    // Both ends must have the same encoded length
+    for (size_t i = 0; i < sizeof(length_limits) / sizeof(length_limits[0]); i++) {
+        if (start <= length_limits[i] && end > length_limits[i]) {
+            split_range(start, length_limits[i], out, count);
+            split_range(length_limits[i] + 1, end, out, count);
+            return;
+        }
+    }
+
+    // Where the ends differ above a continuation byte, that byte must span its full range
+    for (unsigned int i = 1; i < RIFT_UTF8_MAX_LENGTH; i++) {
+        uint32_t mask = ((uint32_t)1 << (6 * i)) - 1;
+        if ((start & ~mask) != (end & ~mask)) {
+            if ((start & mask) != 0) {
+                split_range(start, start | mask, out, count);
+                split_range((start | mask) + 1, end, out, count);
+                return;
+            }
+            if ((end & mask) != mask) {
+                split_range(start, (end & ~mask) - 1, out, count);
+                split_range(end & ~mask, end, out, count);
+                return;
+            }
+        }
+    }
+
+    rift_utf8_sequence_t *sequence = &out[(*count)++];
+    sequence->length = (uint8_t)rift_utf8_encode(start, sequence->start);
+    rift_utf8_encode(end, sequence->end);
+}
+
+/**
+ * @brief Split a code point range into UTF-8 byte range sequences
+ */
+size_t
+rift_utf8_sequences(uint32_t start, uint32_t end, rift_utf8_sequence_t *out)
+{
+    if (!out) {
+        return 0;
+    }
+    if (end > RIFT_UTF8_MAX_CODEPOINT) {
+        end = RIFT_UTF8_MAX_CODEPOINT;
+    }
+
+    size_t count = 0;
+    split_range(start, end, out, &count);
+    return count;
+}
+
+/**
+ * @brief Check whether a byte has a special meaning inside a bracket expression
+ */
+static bool
+is_bracket_special(unsigned int c)
+{
+    return c == ']' || c == '[' || c == '^' || c == '-';
+}
+
+/**
+ * @brief Format a byte range as a transition pattern
+ */
+size_t
+rift_utf8_format_byte_range(uint8_t start, uint8_t end, char *buffer)
+{
+    size_t pos = 0;
+    if (!buffer || start == 0 || start > end) {
+        return 0;
+    }
+
+    if (start == end) {
+        if (strchr(".[]()*+?{}|^$\\", (char)start)) {
+            buffer[pos++] = '\\';
+        }
+        buffer[pos++] = (char)start;
+        buffer[pos] = '\0';
+        return pos;
+    }
+
+    /*
+     * Same layout as a byte class: ']' first, then the runs between the
+     * special bytes, then '[', '^' and '-', so none of them takes on a
+     * special meaning.
+     */
+    buffer[pos++] = '[';
+    if (start <= ']' && end >= ']') {
+        buffer[pos++] = ']';
+    }
+
+    for (unsigned int c = start; c <= end; c++) {
+        if (is_bracket_special(c)) {
+            continue;
+        }
+
+        unsigned int last = c;
+        while (last < end && !is_bracket_special(last + 1)) {
+            last++;
+        }
+
+        buffer[pos++] = (char)c;
+        if (last > c) {
+            buffer[pos++] = '-';
+            buffer[pos++] = (char)last;
+        }
+        c = last;
+    }
+
+    const char trailing[] = "[^-";
+    for (size_t i = 0; i < sizeof(trailing) - 1; i++) {
+        if ((unsigned char)trailing[i] >= start && (unsigned char)trailing[i] <= end) {
+            buffer[pos++] = trailing[i];
+        }
+    }
+    buffer[pos++] = ']';
+    buffer[pos] = '\0';
+    return pos;
+}
+
+/**
+ * @brief Add a code point range to a set
+ */
+bool
+rift_utf8_range_set_add(rift_utf8_range_set_t *set, uint32_t start, uint32_t end)
+{
+    if (!set || start > end) {
+        return set != NULL;
+    }
+
+    if (set->count == set->capacity) {
+        size_t capacity = set->capacity ? set->capacity * 2 : 8;
+        rift_utf8_range_t *ranges =
+            (rift_utf8_range_t *)realloc(set->ranges, capacity * sizeof(rift_utf8_range_t));
+        if (!ranges) {
+            return false;
+        }
+        set->ranges = ranges;
+        set->capacity = capacity;
+    }
+
+    set->ranges[set->count].start = start;
+    set->ranges[set->count].end = end;
+    set->count++;
+    return true;
+}
+
+/**
+ * @brief Order ranges by their start
+ */
+static int
+compare_ranges(const void *a, const void *b)
+{
+    uint32_t left = ((const rift_utf8_range_t *)a)->start;
+    uint32_t right = ((const rift_utf8_range_t *)b)->start;
+    return left < right ? -1 : left > right ? 1 : 0;
+}
+
+/**
+ * @brief Sort the ranges of a set and merge the ones that overlap or touch
+ */
+void
+rift_utf8_range_set_normalize(rift_utf8_range_set_t *set)
+{
+    if (!set || set->count < 2) {
+        return;
+    }
+
+    qsort(set->ranges, set->count, sizeof(rift_utf8_range_t), compare_ranges);
+
+    size_t kept = 0;
+    for (size_t i = 1; i < set->count; i++) {
+        rift_utf8_range_t *last = &set->ranges[kept];
+        if (set->ranges[i].start <= last->end + 1) {
+            if (set->ranges[i].end > last->end) {
+                last->end = set->ranges[i].end;
+            }
+        } else {
+            set->ranges[++kept] = set->ranges[i];
+        }
+    }
+    set->count = kept + 1;
+}
+
+/**
+ * @brief Replace a normalized set by its complement over all code points
+ */
+bool
+rift_utf8_range_set_negate(rift_utf8_range_set_t *set)
+{
+    if (!set) {
+        return false;
+    }
+
+    rift_utf8_range_set_t complement = {NULL, 0, 0};
+    uint32_t next = 0;
+    for (size_t i = 0; i < set->count; i++) {
+        if (set->ranges[i].start > next &&
+            !rift_utf8_range_set_add(&complement, next, set->ranges[i].start - 1)) {
+            rift_utf8_range_set_clear(&complement);
+            return false;
+        }
+        next = set->ranges[i].end + 1;
+    }
+    if (next <= RIFT_UTF8_MAX_CODEPOINT &&
+        !rift_utf8_range_set_add(&complement, next, RIFT_UTF8_MAX_CODEPOINT)) {
+        rift_utf8_range_set_clear(&complement);
+        return false;
+    }
+
+    rift_utf8_range_set_clear(set);
+    *set = complement;
+    return true;
+}
+
+/**
+ * @brief Free the ranges of a set and empty it
+ */
+void
+rift_utf8_range_set_clear(rift_utf8_range_set_t *set)
+{
+    if (!set) {
+        return;
+    }
+    free(set->ranges);
+    set->ranges = NULL;
+    set->count = 0;
+    set->capacity = 0;
+}
+
+/**
+ * @brief Check whether a bracket expression needs code point matching
+ */
+bool
+rift_utf8_class_needs_ranges(const char *pattern)
+{
+    if (!pattern || pattern[0] != '[') {
+        return false;
+    }
+
+    bool needed = pattern[1] == '^';
+    size_t length = strlen(pattern);
+    for (size_t i = 0; i < length;) {
+        uint32_t codepoint;
+        size_t read = rift_utf8_decode(pattern + i, length - i, &codepoint);
+        if (read == 0) {
+            return false;
+        }
+        needed = needed || read > 1;
+        i += read;
+    }
+    return needed;
+}
+
+/**
+ * @brief Add the ASCII members of a POSIX character class name to a set
+ */
+static bool
+add_named_class(const char *name, size_t length, rift_utf8_range_set_t *set)
+{
+    static const struct {
+        const char *name;
+        int (*test)(int);
+    } named_classes[] = {{"alnum", isalnum}, {"alpha", isalpha}, {"blank", isblank},
+                         {"cntrl", iscntrl}, {"digit", isdigit}, {"graph", isgraph},
+                         {"lower", islower}, {"print", isprint}, {"punct", ispunct},
+                         {"space", isspace}, {"upper", isupper}, {"xdigit", isxdigit}};
+
+    for (size_t i = 0; i < sizeof(named_classes) / sizeof(named_classes[0]); i++) {
+        if (strlen(named_classes[i].name) == length &&
+            strncmp(named_classes[i].name, name, length) == 0) {
+            for (uint32_t c = 1; c < 128; c++) {
+                if (named_classes[i].test((int)c) && !rift_utf8_range_set_add(set, c, c)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Read a UTF-8 bracket expression into a normalized set of code points
+ */
+bool
+rift_utf8_parse_class(const char *pattern, bool caseless, rift_utf8_range_set_t *set)
+{
+    if (!pattern || !set || pattern[0] != '[') {
+        return false;
+    }
+
+    const char *p = pattern + 1;
+    const char *limit = pattern + strlen(pattern);
+    bool negate = false;
+    if (*p == '^') {
+        negate = true;
+        p++;
+    }
+
+    bool first = true;
+    while (p < limit && (*p != ']' || first)) {
+        first = false;
+
+        if (*p == '[' && (p[1] == '.' || p[1] == '=')) {
+            return false;
+        }
+
+        if (*p == '[' && p[1] == ':') {
+            const char *name = p + 2;
+            const char *end = strstr(name, ":]");
+            if (!end || !add_named_class(name, (size_t)(end - name), set)) {
+                return false;
+            }
+            p = end + 2;
+            continue;
+        }
+
+        uint32_t low;
+        size_t read = rift_utf8_decode(p, (size_t)(limit - p), &low);
+        if (read == 0) {
+            return false;
+        }
+        p += read;
+
+        uint32_t high = low;
+        if (*p == '-' && p[1] && p[1] != ']') {
+            read = rift_utf8_decode(p + 1, (size_t)(limit - p - 1), &high);
+            if (read == 0 || high < low) {
+                return false;
+            }
+            p += 1 + read;
+        }
+
+        if (!rift_utf8_range_set_add(set, low, high)) {
+            return false;
+        }
+    }
+
+    if (p + 1 != limit || *p != ']') {
+        return false;
+    }
+
+    rift_utf8_range_set_normalize(set);
+    if ((caseless && !rift_case_fold_range_set(set)) ||
+        (negate && !rift_utf8_range_set_negate(set))) {
+        return false;
+    }
+
+    // Bracket expressions never match NUL, as with byte classes
+    if (set->count > 0 && set->ranges[0].start == 0) {
+        if (set->ranges[0].end == 0) {
+            memmove(set->ranges, set->ranges + 1, (set->count - 1) * sizeof(rift_utf8_range_t));
+            set->count--;
+        } else {
+            set->ranges[0].start = 1;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Property that is exactly a list of code point ranges
+ *
+ * Without the Unicode character database only properties defined by fixed
+ * ranges are known: Any, ASCII, private use and a set of blocks.
+ */
+static const struct {
+    const char *name;
+    rift_utf8_range_t ranges[3];
+    size_t count;
+} properties[] = {
+    {"any", {{0x0, RIFT_UTF8_MAX_CODEPOINT}}, 1},
+    {"ascii", {{0x0, 0x7F}}, 1},
+    {"co", {{0xE000, 0xF8FF}, {0xF0000, 0xFFFFD}, {0x100000, 0x10FFFD}}, 3},
+    {"inbasiclatin", {{0x0, 0x7F}}, 1},
+    {"inlatin1supplement", {{0x80, 0xFF}}, 1},
+    {"inlatinextendeda", {{0x100, 0x17F}}, 1},
+    {"inlatinextendedb", {{0x180, 0x24F}}, 1},
+    {"inipaextensions", {{0x250, 0x2AF}}, 1},
+    {"incombiningdiacriticalmarks", {{0x300, 0x36F}}, 1},
+    {"ingreek", {{0x370, 0x3FF}}, 1},
+    {"ingreekandcoptic", {{0x370, 0x3FF}}, 1},
+    {"incyrillic", {{0x400, 0x4FF}}, 1},
+    {"inarmenian", {{0x530, 0x58F}}, 1},
+    {"inhebrew", {{0x590, 0x5FF}}, 1},
+    {"inarabic", {{0x600, 0x6FF}}, 1},
+    {"indevanagari", {{0x900, 0x97F}}, 1},
+    {"inthai", {{0xE00, 0xE7F}}, 1},
+    {"inhanguljamo", {{0x1100, 0x11FF}}, 1},
+    {"ingeneralpunctuation", {{0x2000, 0x206F}}, 1},
+    {"incurrencysymbols", {{0x20A0, 0x20CF}}, 1},
+    {"inarrows", {{0x2190, 0x21FF}}, 1},
+    {"inmathematicaloperators", {{0x2200, 0x22FF}}, 1},
+    {"inboxdrawing", {{0x2500, 0x257F}}, 1},
+    {"incjksymbolsandpunctuation", {{0x3000, 0x303F}}, 1},
+    {"inhiragana", {{0x3040, 0x309F}}, 1},
+    {"inkatakana", {{0x30A0, 0x30FF}}, 1},
+    {"incjkunifiedideographs", {{0x4E00, 0x9FFF}}, 1},
+    {"inhangulsyllables", {{0xAC00, 0xD7AF}}, 1},
+    {"inprivateusearea", {{0xE000, 0xF8FF}}, 1},
+    {"inhalfwidthandfullwidthforms", {{0xFF00, 0xFFEF}}, 1},
+    {"inemoticons", {{0x1F600, 0x1F64F}}, 1},
+};
+
+/**
+ * @brief Read a \\p or \\P escape into a normalized set of code points
+ */
+bool
+rift_utf8_parse_property(const char *escape, bool caseless, rift_utf8_range_set_t *set)
+{
+    if (!escape || !set || escape[0] != '\\' || (escape[1] != 'p' && escape[1] != 'P')) {
+        return false;
+    }
+
+    bool negate = escape[1] == 'P';
+    const char *name = escape + 2;
+    size_t length = strlen(name);
+    if (name[0] == '{') {
+        if (length < 2 || name[length - 1] != '}') {
+            return false;
+        }
+        name++;
+        length -= 2;
+        if (length > 0 && name[0] == '^') {
+            negate = !negate;
+            name++;
+            length--;
+        }
+    }
+
+    // Loose matching: case, spaces, underscores and hyphens do not count
+    char key[64];
+    size_t key_length = 0;
+    for (size_t i = 0; i < length; i++) {
+        char c = name[i];
+        if (c == ' ' || c == '_' || c == '-') {
+            continue;
+        }
+        if (key_length + 1 >= sizeof(key)) {
+            return false;
+        }
+        key[key_length++] = (char)tolower((unsigned char)c);
+    }
+    key[key_length] = '\0';
+
+    for (size_t i = 0; i < sizeof(properties) / sizeof(properties[0]); i++) {
+        if (strcmp(properties[i].name, key) != 0) {
+            continue;
+        }
+        for (size_t j = 0; j < properties[i].count; j++) {
+            if (!rift_utf8_range_set_add(set, properties[i].ranges[j].start,
+                                         properties[i].ranges[j].end)) {
+                return false;
+            }
+        }
+        rift_utf8_range_set_normalize(set);
+        if (caseless && !rift_case_fold_range_set(set)) {
+            return false;
+        }
+        return !negate || rift_utf8_range_set_negate(set);
+    }
+    return false;
+}
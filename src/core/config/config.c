@@ -23,15 +23,22 @@ onfig/config.h"/a #include "core/errors/regex_error.h"
  * This file implements the configuration management facilities for the
  * LibRift library, including support for regex engine parameters.
  *
+ * The configuration is an immutable, reference-counted snapshot. A change
+ * copies the current snapshot, modifies the copy and swaps it in under
+ * config_lock; readers holding the old one keep it until they release it.
+ *
  * @copyright Copyright (c) 2025 LibRift Project
  * @license MIT License
  */
 
 #include "core/config/config.h
+#include <pthread.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 onfig/config.h"/a #include "core/errors/regex_error.h"
 
@@ -47,24 +54,90 @@ static const rift_config_t DEFAULT_CONFIG = {
               .optimize_automaton = true,
               .use_dfa_when_possible = true,
               .enable_rift_syntax = true,
-              .max_capture_groups = 100},
+              .max_capture_groups = 100,
+              .glushkov_nfa = false},
     .memory = {.allocation_limit = 0, /* 0 means no limit */
                .use_custom_allocator = false,
                .custom_malloc = NULL,
                .custom_realloc = NULL,
-               .custom_free = NULL}};
+               .custom_free = NULL,
+               .table_page_threshold = RIFT_TABLE_PAGE_THRESHOLD,
+               .table_huge_pages = true}};
 
 onfig/config.h"/a #include "core/errors/regex_error.h"
 /**
- * @brief Global configuration instance
+ * @brief A configuration and the references to it
+ *
+ * The configuration comes first, so a pointer to it is one to its snapshot.
+ */
+typedef struct config_snapshot {
+    rift_config_t config; /**< The settings, never modified once published */
+    atomic_uint refs;     /**< References, one of them the global one while current */
+} config_snapshot_t;
+
+/**
+ * @brief Snapshot of the defaults, current until the first change and never freed
+ */
+static config_snapshot_t default_snapshot;
+
+/**
+ * @brief Current snapshot, replaced under config_lock
  */
-static rift_config_t global_config;
+static config_snapshot_t *current_snapshot = &default_snapshot;
 
 onfig/config.h"/a #include "core/errors/regex_error.h"
 /**
  * @brief Initialization flag to track if the config has been initialized
+ *
+ * Every accessor initializes the configuration on first use; the flag is
+ * atomic so that only the first caller, under config_lock, copies the
+ * defaults, while later callers pay for one load.
+ */
+static atomic_bool config_initialized = false;
+
+/**
+ * @brief Serializes initialization, cleanup and the swaps of the current snapshot
  */
-static bool config_initialized = false;
+static pthread_mutex_t config_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @brief Drop a reference to a snapshot, freeing it with the last one
+ *
+ * @param snapshot The snapshot
+ */
+static void
+snapshot_release(config_snapshot_t *snapshot)
+{
+    if (snapshot != &default_snapshot &&
+        atomic_fetch_sub_explicit(&snapshot->refs, 1, memory_order_acq_rel) == 1) {
+        free(snapshot);
+    }
+}
+
+/**
+ * @brief Make a configuration the current snapshot; the caller holds config_lock
+ *
+ * Snapshots are allocated with the standard allocator, since rift_malloc
+ * reads the configuration itself.
+ *
+ * @param config The settings of the new snapshot
+ * @return RIFT_OK on success, RIFT_ERROR_MEMORY_ALLOCATION if no snapshot could be made
+ */
+static rift_status_t
+publish_locked(const rift_config_t *config)
+{
+    config_snapshot_t *snapshot = (config_snapshot_t *)malloc(sizeof(config_snapshot_t));
+    if (!snapshot) {
+        return RIFT_ERROR_MEMORY_ALLOCATION;
+    }
+
+    snapshot->config = *config;
+    atomic_init(&snapshot->refs, 1);
+    config_snapshot_t *previous = current_snapshot;
+    current_snapshot = snapshot;
+    snapshot_release(previous);
+    return RIFT_OK;
+}
 
 onfig/config.h"/a #include "core/errors/regex_error.h"
 /**
@@ -79,10 +152,22 @@ rift_config_initialize(void)
         return RIFT_OK;
     }
 
-    /* Copy default configuration to global instance */
-    memcpy(&global_config, &DEFAULT_CONFIG, sizeof(rift_config_t));
+    pthread_mutex_lock(&config_lock);
+    bool first = !config_initialized;
+    if (first) {
+        /* Start from the defaults, dropping what a previous run published */
+        default_snapshot.config = DEFAULT_CONFIG;
+        config_snapshot_t *previous = current_snapshot;
+        current_snapshot = &default_snapshot;
+        snapshot_release(previous);
+        config_initialized = true;
+    }
+    pthread_mutex_unlock(&config_lock);
 
-    config_initialized = true;
+    /* Outside the lock, as the memory system reads the configuration back */
+    if (first) {
+        rift_memory_config_changed();
+    }
     return RIFT_OK;
 }
 
@@ -99,9 +184,13 @@ rift_config_cleanup(void)
         return RIFT_OK;
     }
 
-    /* No dynamic resources to clean up at the moment */
-
+    /* Snapshots still held elsewhere are freed when released */
+    pthread_mutex_lock(&config_lock);
+    config_snapshot_t *previous = current_snapshot;
+    current_snapshot = &default_snapshot;
+    snapshot_release(previous);
     config_initialized = false;
+    pthread_mutex_unlock(&config_lock);
     return RIFT_OK;
 }
 
@@ -109,7 +198,7 @@ onfig/config.h"/a #include "core/errors/regex_error.h"
 /**
  * @brief Get the global configuration
  *
- * @return Pointer to the global configuration instance
+ * @return Pointer to the current snapshot, valid until the configuration changes
  */
 const rift_config_t *
 rift_config_get(void)
@@ -118,7 +207,42 @@ rift_config_get(void)
         rift_config_initialize();
     }
 
-    return &global_config;
+    pthread_mutex_lock(&config_lock);
+    const rift_config_t *config = &current_snapshot->config;
+    pthread_mutex_unlock(&config_lock);
+    return config;
+}
+
+/**
+ * @brief Take a reference to the current configuration snapshot
+ *
+ * @return The snapshot, to be released with rift_config_release()
+ */
+const rift_config_t *
+rift_config_acquire(void)
+{
+    if (!config_initialized) {
+        rift_config_initialize();
+    }
+
+    pthread_mutex_lock(&config_lock);
+    config_snapshot_t *snapshot = current_snapshot;
+    atomic_fetch_add_explicit(&snapshot->refs, 1, memory_order_relaxed);
+    pthread_mutex_unlock(&config_lock);
+    return &snapshot->config;
+}
+
+/**
+ * @brief Release a snapshot taken with rift_config_acquire()
+ *
+ * @param config The snapshot (can be NULL)
+ */
+void
+rift_config_release(const rift_config_t *config)
+{
+    if (config) {
+        snapshot_release((config_snapshot_t *)config);
+    }
 }
 
 onfig/config.h"/a #include "core/errors/regex_error.h"
@@ -139,10 +263,14 @@ rift_config_set(const rift_config_t *config)
         rift_config_initialize();
     }
 
-    /* Copy the provided configuration to the global instance */
-    memcpy(&global_config, config, sizeof(rift_config_t));
+    pthread_mutex_lock(&config_lock);
+    rift_status_t status = publish_locked(config);
+    pthread_mutex_unlock(&config_lock);
+    if (status == RIFT_OK) {
+        rift_memory_config_changed();
+    }
 
-    return RIFT_OK;
+    return status;
 }
 
 onfig/config.h"/a #include "core/errors/regex_error.h"
@@ -158,55 +286,60 @@ rift_config_reset(void)
         return rift_config_initialize();
     }
 
-    /* Copy default configuration to global instance */
-    memcpy(&global_config, &DEFAULT_CONFIG, sizeof(rift_config_t));
+    pthread_mutex_lock(&config_lock);
+    rift_status_t status = publish_locked(&DEFAULT_CONFIG);
+    pthread_mutex_unlock(&config_lock);
+    if (status == RIFT_OK) {
+        rift_memory_config_changed();
+    }
 
-    return RIFT_OK;
+    return status;
 }
 
 onfig/config.h"/a #include "core/errors/regex_error.h"
 /**
- * @brief Get a specific regex configuration parameter
+ * @brief Get a parameter of a regex configuration
  *
+ * @param config The regex configuration
  * @param param The parameter to get
  * @param value Pointer to store the value
  * @return RIFT_OK on success, error code on failure
  */
 rift_status_t
-rift_config_get_regex_param(rift_regex_config_param_t param, void *value)
+rift_regex_config_get_param(const rift_regex_config_t *config, rift_regex_config_param_t param,
+                            void *value)
 {
-    if (!value) {
+    if (!config || !value) {
         return RIFT_ERROR_INVALID_PARAMETER;
     }
 
-    if (!config_initialized) {
-        rift_config_initialize();
-    }
-
     switch (param) {
     case RIFT_REGEX_PARAM_MAX_PATTERN_LENGTH:
-        *(size_t *)value = global_config.regex.max_pattern_length;
+        *(size_t *)value = config->max_pattern_length;
         break;
     case RIFT_REGEX_PARAM_MAX_STATES:
-        *(size_t *)value = global_config.regex.max_states;
+        *(size_t *)value = config->max_states;
         break;
     case RIFT_REGEX_PARAM_MAX_BACKTRACK_DEPTH:
-        *(size_t *)value = global_config.regex.max_backtrack_depth;
+        *(size_t *)value = config->max_backtrack_depth;
         break;
     case RIFT_REGEX_PARAM_DEFAULT_TIMEOUT_MS:
-        *(uint32_t *)value = global_config.regex.default_timeout_ms;
+        *(uint32_t *)value = config->default_timeout_ms;
         break;
     case RIFT_REGEX_PARAM_OPTIMIZE_AUTOMATON:
-        *(bool *)value = global_config.regex.optimize_automaton;
+        *(bool *)value = config->optimize_automaton;
         break;
     case RIFT_REGEX_PARAM_USE_DFA_WHEN_POSSIBLE:
-        *(bool *)value = global_config.regex.use_dfa_when_possible;
+        *(bool *)value = config->use_dfa_when_possible;
         break;
     case RIFT_REGEX_PARAM_ENABLE_RIFT_SYNTAX:
-        *(bool *)value = global_config.regex.enable_rift_syntax;
+        *(bool *)value = config->enable_rift_syntax;
         break;
     case RIFT_REGEX_PARAM_MAX_CAPTURE_GROUPS:
-        *(size_t *)value = global_config.regex.max_capture_groups;
+        *(size_t *)value = config->max_capture_groups;
+        break;
+    case RIFT_REGEX_PARAM_GLUSHKOV_NFA:
+        *(bool *)value = config->glushkov_nfa;
         break;
     default:
         return RIFT_ERROR_INVALID_PARAMETER;
@@ -215,49 +348,49 @@ rift_config_get_regex_param(rift_regex_config_param_t param, void *value)
     return RIFT_OK;
 }
 
-onfig/config.h"/a #include "core/errors/regex_error.h"
 /**
- * @brief Set a specific regex configuration parameter
+ * @brief Set a parameter of a regex configuration
  *
+ * @param config The regex configuration
  * @param param The parameter to set
  * @param value Pointer to the value
  * @return RIFT_OK on success, error code on failure
  */
 rift_status_t
-rift_config_set_regex_param(rift_regex_config_param_t param, const void *value)
+rift_regex_config_set_param(rift_regex_config_t *config, rift_regex_config_param_t param,
+                            const void *value)
 {
-    if (!value) {
+    if (!config || !value) {
         return RIFT_ERROR_INVALID_PARAMETER;
     }
 
-    if (!config_initialized) {
-        rift_config_initialize();
-    }
-
     switch (param) {
     case RIFT_REGEX_PARAM_MAX_PATTERN_LENGTH:
-        global_config.regex.max_pattern_length = *(const size_t *)value;
+        config->max_pattern_length = *(const size_t *)value;
         break;
     case RIFT_REGEX_PARAM_MAX_STATES:
-        global_config.regex.max_states = *(const size_t *)value;
+        config->max_states = *(const size_t *)value;
         break;
     case RIFT_REGEX_PARAM_MAX_BACKTRACK_DEPTH:
-        global_config.regex.max_backtrack_depth = *(const size_t *)value;
+        config->max_backtrack_depth = *(const size_t *)value;
         break;
     case RIFT_REGEX_PARAM_DEFAULT_TIMEOUT_MS:
-        global_config.regex.default_timeout_ms = *(const uint32_t *)value;
+        config->default_timeout_ms = *(const uint32_t *)value;
         break;
     case RIFT_REGEX_PARAM_OPTIMIZE_AUTOMATON:
-        global_config.regex.optimize_automaton = *(const bool *)value;
+        config->optimize_automaton = *(const bool *)value;
         break;
     case RIFT_REGEX_PARAM_USE_DFA_WHEN_POSSIBLE:
-        global_config.regex.use_dfa_when_possible = *(const bool *)value;
+        config->use_dfa_when_possible = *(const bool *)value;
         break;
     case RIFT_REGEX_PARAM_ENABLE_RIFT_SYNTAX:
-        global_config.regex.enable_rift_syntax = *(const bool *)value;
+        config->enable_rift_syntax = *(const bool *)value;
         break;
     case RIFT_REGEX_PARAM_MAX_CAPTURE_GROUPS:
-        global_config.regex.max_capture_groups = *(const size_t *)value;
+        config->max_capture_groups = *(const size_t *)value;
+        break;
+    case RIFT_REGEX_PARAM_GLUSHKOV_NFA:
+        config->glushkov_nfa = *(const bool *)value;
         break;
     default:
         return RIFT_ERROR_INVALID_PARAMETER;
@@ -266,6 +399,57 @@ rift_config_set_regex_param(rift_regex_config_param_t param, const void *value)
     return RIFT_OK;
 }
 
+/**
+ * @brief Get a specific regex configuration parameter
+ *
+ * @param param The parameter to get
+ * @param value Pointer to store the value
+ * @return RIFT_OK on success, error code on failure
+ */
+rift_status_t
+rift_config_get_regex_param(rift_regex_config_param_t param, void *value)
+{
+    if (!value) {
+        return RIFT_ERROR_INVALID_PARAMETER;
+    }
+
+    const rift_config_t *config = rift_config_acquire();
+    rift_status_t status = rift_regex_config_get_param(&config->regex, param, value);
+    rift_config_release(config);
+    return status;
+}
+
+onfig/config.h"/a #include "core/errors/regex_error.h"
+/**
+ * @brief Set a specific regex configuration parameter
+ *
+ * @param param The parameter to set
+ * @param value Pointer to the value
+ * @return RIFT_OK on success, error code on failure
+ */
+rift_status_t
+rift_config_set_regex_param(rift_regex_config_param_t param, const void *value)
+{
+    if (!value) {
+        return RIFT_ERROR_INVALID_PARAMETER;
+    }
+
+    if (!config_initialized) {
+        rift_config_initialize();
+    }
+
+    // The copy and the swap happen under one lock, so concurrent changes are not lost
+    pthread_mutex_lock(&config_lock);
+    rift_config_t next = current_snapshot->config;
+    rift_status_t status = rift_regex_config_set_param(&next.regex, param, value);
+    if (status == RIFT_OK) {
+        status = publish_locked(&next);
+    }
+    pthread_mutex_unlock(&config_lock);
+
+    return status;
+}
+
 onfig/config.h"/a #include "core/errors/regex_error.h"
 /**
  * @brief Set custom memory allocator functions
@@ -287,12 +471,19 @@ rift_config_set_memory_allocator(rift_malloc_func_t malloc_fn, rift_realloc_func
         rift_config_initialize();
     }
 
-    global_config.memory.use_custom_allocator = true;
-    global_config.memory.custom_malloc = malloc_fn;
-    global_config.memory.custom_realloc = realloc_fn;
-    global_config.memory.custom_free = free_fn;
+    pthread_mutex_lock(&config_lock);
+    rift_config_t next = current_snapshot->config;
+    next.memory.use_custom_allocator = true;
+    next.memory.custom_malloc = malloc_fn;
+    next.memory.custom_realloc = realloc_fn;
+    next.memory.custom_free = free_fn;
+    rift_status_t status = publish_locked(&next);
+    pthread_mutex_unlock(&config_lock);
+    if (status == RIFT_OK) {
+        rift_memory_config_changed();
+    }
 
-    return RIFT_OK;
+    return status;
 }
 
 onfig/config.h"/a #include "core/errors/regex_error.h"
@@ -310,10 +501,7 @@ rift_config_to_json(char *buffer, size_t buffer_size)
         return RIFT_ERROR_INVALID_PARAMETER;
     }
 
-    if (!config_initialized) {
-        rift_config_initialize();
-    }
-
+    const rift_config_t *config = rift_config_acquire();
     int written =
         snprintf(buffer, buffer_size,
                  "{\n"
@@ -325,20 +513,27 @@ rift_config_to_json(char *buffer, size_t buffer_size)
                  "    \"optimize_automaton\": %s,\n"
                  "    \"use_dfa_when_possible\": %s,\n"
                  "    \"enable_rift_syntax\": %s,\n"
-                 "    \"max_capture_groups\": %zu\n"
+                 "    \"max_capture_groups\": %zu,\n"
+                 "    \"glushkov_nfa\": %s\n"
                  "  },\n"
                  "  \"memory\": {\n"
                  "    \"allocation_limit\": %zu,\n"
-                 "    \"use_custom_allocator\": %s\n"
+                 "    \"use_custom_allocator\": %s,\n"
+                 "    \"table_page_threshold\": %zu,\n"
+                 "    \"table_huge_pages\": %s\n"
                  "  }\n"
                  "}",
-                 global_config.regex.max_pattern_length, global_config.regex.max_states,
-                 global_config.regex.max_backtrack_depth, global_config.regex.default_timeout_ms,
-                 global_config.regex.optimize_automaton ? "true" : "false",
-                 global_config.regex.use_dfa_when_possible ? "true" : "false",
-                 global_config.regex.enable_rift_syntax ? "true" : "false",
-                 global_config.regex.max_capture_groups, global_config.memory.allocation_limit,
-                 global_config.memory.use_custom_allocator ? "true" : "false");
+                 config->regex.max_pattern_length, config->regex.max_states,
+                 config->regex.max_backtrack_depth, config->regex.default_timeout_ms,
+                 config->regex.optimize_automaton ? "true" : "false",
+                 config->regex.use_dfa_when_possible ? "true" : "false",
+                 config->regex.enable_rift_syntax ? "true" : "false",
+                 config->regex.max_capture_groups, config->regex.glushkov_nfa ? "true" : "false",
+                 config->memory.allocation_limit,
+                 config->memory.use_custom_allocator ? "true" : "false",
+                 config->memory.table_page_threshold,
+                 config->memory.table_huge_pages ? "true" : "false");
+    rift_config_release(config);
 
     if (written < 0 || (size_t)written >= buffer_size) {
         return RIFT_ERROR_BUFFER_OVERFLOW;
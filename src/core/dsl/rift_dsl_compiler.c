@@ -17,8 +17,25 @@
  */
 
 #include "core/dsl/rift_dsl_compiler.h"
+#include <ctype.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include "core/automaton/frozen_automaton.h"
+#include "core/automaton/hopcroft.h"
+#include "core/automaton/lazy_dfa.h"
+#include "core/automaton/lookaround.h"
+#include "core/automaton/product.h"
+#include "core/automaton/state.h"
 #include "core/bytecode/bytecode.h"
+#include "core/bytecode/bytecode_compiler.h"
+#include "core/bytecode/bytecode_container.h"
 #include "core/bytecode/bytecode_system.h"
+#include "core/bytecode/bytecode_vm_pool.h"
+#include "core/dsl/rift_dsl_formula.h"
+#include "core/dsl/rift_dsl_parser.h"
+#include "core/engine/pattern.h"
+#include "core/engine/pattern_set.h"
 #include "core/errors/error.h"
 #include "core/errors/regex_error.h"
  #include <stdio.h>
@@ -30,6 +47,66 @@
  #include "core/bytecode/bytecode_system.h"
  #include "core/errors/regex_error.h"
  
+ /* Rule identifier of a program the union DFA does not run */
+ #define RIFT_DSL_NO_RULE UINT32_MAX
+ 
+ /* DFA states a pattern may take before it is left to the VM */
+ #define RIFT_DSL_MAX_TABLE_STATES 4096
+ 
+ /* Profiled searches below which a profile says nothing about a pattern */
+ #define RIFT_DSL_PROFILE_MIN_SEARCHES 16
+ 
+ /* Steps per profiled search above which a pattern may take a larger DFA */
+ #define RIFT_DSL_PROFILE_COSTLY_STEPS 64
+ 
+ /* Factor of RIFT_DSL_MAX_TABLE_STATES a costly pattern may take */
+ #define RIFT_DSL_PROFILE_TABLE_SCALE 4
+ 
+ /* Percentage of profiled searches below which a pattern is selective */
+ #define RIFT_DSL_PROFILE_SELECTIVE_PERCENT 10
+
+ /* Inputs rift_dsl_execute_batch prefilters and scans at a time */
+ #define RIFT_DSL_BATCH_BLOCK 256
+ 
+ /* Magic and version of the analysis section following the serialized programs */
+ #define RIFT_DSL_ANALYSIS_MAGIC "RDXT"
+ #define RIFT_DSL_ANALYSIS_VERSION 1u
+ 
+ /* Flags of a program in the analysis section */
+ #define RIFT_DSL_ANALYSIS_TABLE 0x1u
+ #define RIFT_DSL_ANALYSIS_PREFILTER 0x2u
+ #define RIFT_DSL_ANALYSIS_VERDICT 0x4u
+ #define RIFT_DSL_ANALYSIS_CHECK_REQUIRED 0x8u
+ 
+ /* What compiling a pattern found out besides its program */
+ typedef struct {
+     rift_dfa_table_t *table;          /* Minimized DFA of the pattern, NULL to run the VM */
+     rift_prefilter_t prefilter;       /* Literals and first bytes of every match */
+     bool has_prefilter;               /* Whether prefilter was computed */
+     rift_ambiguity_verdict_t verdict; /* Static backtracking analysis */
+     bool has_verdict;                 /* Whether verdict was computed */
+     bool check_required;              /* Whether to look for a required literal first */
+ } rift_dsl_analysis_t;
+ 
+ /* Lazy DFA over the union of the rules of a shard, used by one caller at a time */
+ typedef struct rift_dsl_scanner {
+     rift_lazy_dfa_t *lazy;          /* Anchored lazy DFA over the union automaton */
+     uint64_t *tags;                 /* Rules matched by the last scan */
+     size_t num_words;               /* Number of 64-bit words in tags */
+     bool scanned;                   /* Whether tags hold the scan of the current input */
+     struct rift_dsl_scanner *next;  /* Next idle scanner */
+ } rift_dsl_scanner_t;
+ 
+ /* Rules whose union DFA is estimated to fit the state budget, scanned in one pass */
+ typedef struct {
+     rift_pattern_set_t *rules;         /* Union of the rules, NULL if it failed to build */
+     size_t estimated_states;           /* Sum of the minimized DFA sizes of the rules */
+     rift_dsl_scanner_t *idle_scanners; /* Scanners not in use, guarded by scanner_lock */
+ } rift_dsl_shard_t;
+ 
+ /* Shards execute_all keeps track of without allocating */
+ #define RIFT_DSL_LOCAL_SHARDS 16
+ 
  /* Structure to hold compilation results */
  typedef struct {
      rift_bytecode_program_t **programs;
@@ -37,6 +114,18 @@
      size_t capacity;
      char error_message[256];
      bool has_error;
+     rift_dsl_shard_t *shards;            /* Rule unions a DFA can run, NULL if none */
+     size_t num_shards;                   /* Number of shards */
+     uint32_t *rule_shards;               /* Shard of each program or RIFT_DSL_NO_RULE */
+     uint32_t *rule_ids;                  /* Rule of each program within its shard */
+     pthread_mutex_t scanner_lock;        /* Guards the idle scanners of the shards */
+     rift_bytecode_container_t *container; /* Mapped programs, NULL if programs are owned */
+     uint64_t *compile_ns;                /* Time taken by each program, NULL if not compiled */
+     rift_dsl_analysis_t *analyses;       /* Analysis of each program, NULL if none */
+     char **names;                        /* Name of each program, NULL if not compiled */
+     rift_dsl_formula_t *formulas;        /* Formula of each @combine, NULL if none */
+     char **formula_names;                /* Name of each combination */
+     size_t num_formulas;                 /* Number of combinations */
  } rift_dsl_compilation_t;
  
  /* Forward declarations from rift_dsl_parser.c */
@@ -46,6 +135,21 @@
  extern size_t rift_dsl_get_pattern_count(void *handle);
  extern bool rift_dsl_get_pattern(void *handle, size_t index, const char **name, const char **pattern);
  extern bool rift_dsl_get_pattern_flags(void *handle, size_t index, const char ***flags, size_t *count);
+ extern size_t rift_dsl_get_combination_count(void *handle);
+ extern bool rift_dsl_get_combination(void *handle, size_t index, const char **name,
+                                      const char **expression);
+ 
+ /* Defined below */
+ static void rift_dsl_compilation_free(rift_dsl_compilation_t *compilation);
+ static bool rift_dsl_compilation_add_program(rift_dsl_compilation_t *compilation,
+                                              rift_bytecode_program_t *program);
+ static uint64_t rift_dsl_clock_ns(void);
+ static rift_dsl_compilation_t *
+ rift_dsl_compile_patterns(void *dsl_handle, const rift_dsl_compile_options_t *options,
+                           rift_dsl_compile_stats_t *stats);
+ static rift_dsl_compilation_t *
+ rift_dsl_compile_stream(const char *filename, const rift_dsl_compile_options_t *options,
+                         rift_dsl_compile_stats_t *stats);
  
  /**
   * @brief Set an error in the compilation structure
@@ -84,7 +188,8 @@
      compilation->programs = 
          (rift_bytecode_program_t **)malloc(initial_capacity * sizeof(rift_bytecode_program_t *));
      
-     if (!compilation->programs) {
+     if (!compilation->programs || pthread_mutex_init(&compilation->scanner_lock, NULL) != 0) {
+         free(compilation->programs);
          free(compilation);
          return NULL;
      }
@@ -93,10 +198,243 @@
      compilation->capacity = initial_capacity;
      compilation->has_error = false;
      compilation->error_message[0] = '\0';
+     compilation->shards = NULL;
+     compilation->num_shards = 0;
+     compilation->rule_shards = NULL;
+     compilation->rule_ids = NULL;
+     compilation->container = NULL;
+     compilation->compile_ns = NULL;
+     compilation->analyses = NULL;
+     compilation->names = NULL;
+     compilation->formulas = NULL;
+     compilation->formula_names = NULL;
+     compilation->num_formulas = 0;
      
      return compilation;
  }
  
+ /**
+  * @brief Get a program of a compilation, unpacking it from the container if mapped
+  * 
+  * @param compilation The compilation structure
+  * @param index Index of the program, below compilation->count
+  * @return The program or NULL if it could not be unpacked
+  */
+ static rift_bytecode_program_t *
+ rift_dsl_compilation_program(rift_dsl_compilation_t *compilation, size_t index)
+ {
+     if (compilation->container) {
+         return rift_bytecode_container_program(compilation->container, (uint32_t)index, NULL);
+     }
+     
+     return compilation->programs[index];
+ }
+ 
+ /* Bytes of the analysis section header: magic, version, prefilter size, count */
+ #define RIFT_DSL_ANALYSIS_HEADER_SIZE 16
+ 
+ /* Bytes of the fixed part of a program's analysis: six words and the table size */
+ #define RIFT_DSL_ANALYSIS_ENTRY_SIZE 32
+ 
+ /* Bytes of a stored prefilter, padded so tables stay 8-byte multiples */
+ #define RIFT_DSL_PREFILTER_SIZE ((sizeof(rift_prefilter_t) + 7) & ~(size_t)7)
+ 
+ /**
+  * @brief Append a 32-bit word to a buffer
+  * 
+  * @param data The buffer
+  * @param offset Write position, advanced past the word
+  * @param value The word
+  */
+ static void
+ rift_dsl_put_u32(uint8_t *data, size_t *offset, uint32_t value)
+ {
+     memcpy(data + *offset, &value, sizeof(value));
+     *offset += sizeof(value);
+ }
+ 
+ /**
+  * @brief Read a 32-bit word from a buffer
+  * 
+  * @param data The buffer
+  * @param offset Read position, advanced past the word
+  * @return The word
+  */
+ static uint32_t
+ rift_dsl_get_u32(const uint8_t *data, size_t *offset)
+ {
+     uint32_t value;
+     memcpy(&value, data + *offset, sizeof(value));
+     *offset += sizeof(value);
+     return value;
+ }
+ 
+ /**
+  * @brief Get the size of the analysis section of a compilation
+  * 
+  * @param compilation The compilation structure
+  * @return Size in bytes, 0 if the compilation has no analysis
+  */
+ static size_t
+ rift_dsl_analysis_section_size(const rift_dsl_compilation_t *compilation)
+ {
+     if (!compilation->analyses) {
+         return 0;
+     }
+     
+     size_t size = RIFT_DSL_ANALYSIS_HEADER_SIZE;
+     for (size_t i = 0; i < compilation->count; i++) {
+         const rift_dsl_analysis_t *analysis = &compilation->analyses[i];
+         size += RIFT_DSL_ANALYSIS_ENTRY_SIZE + rift_dfa_table_encoded_size(analysis->table);
+         if (analysis->has_prefilter) {
+             size += RIFT_DSL_PREFILTER_SIZE;
+         }
+     }
+     return size;
+ }
+ 
+ /**
+  * @brief Write the analysis section of a compilation
+  * 
+  * The section holds, per program, its flags, its ambiguity verdict, the size
+  * of its table, its prefilter as laid out in memory and the flat encoding of
+  * its table. Like the program sizes, all of it is in the byte order of the
+  * machine.
+  * 
+  * @param compilation The compilation structure, holding analyses
+  * @param data Output buffer of rift_dsl_analysis_section_size() bytes
+  */
+ static void
+ rift_dsl_analysis_section_write(const rift_dsl_compilation_t *compilation, uint8_t *data)
+ {
+     size_t offset = 0;
+     memcpy(data, RIFT_DSL_ANALYSIS_MAGIC, 4);
+     offset += 4;
+     rift_dsl_put_u32(data, &offset, RIFT_DSL_ANALYSIS_VERSION);
+     rift_dsl_put_u32(data, &offset, (uint32_t)sizeof(rift_prefilter_t));
+     rift_dsl_put_u32(data, &offset, (uint32_t)compilation->count);
+     
+     for (size_t i = 0; i < compilation->count; i++) {
+         const rift_dsl_analysis_t *analysis = &compilation->analyses[i];
+         uint32_t flags = (analysis->table ? RIFT_DSL_ANALYSIS_TABLE : 0) |
+                          (analysis->has_prefilter ? RIFT_DSL_ANALYSIS_PREFILTER : 0) |
+                          (analysis->has_verdict ? RIFT_DSL_ANALYSIS_VERDICT : 0) |
+                          (analysis->check_required ? RIFT_DSL_ANALYSIS_CHECK_REQUIRED : 0);
+         uint64_t table_size = rift_dfa_table_encoded_size(analysis->table);
+         
+         rift_dsl_put_u32(data, &offset, flags);
+         rift_dsl_put_u32(data, &offset, (uint32_t)analysis->verdict.ambiguity);
+         rift_dsl_put_u32(data, &offset, analysis->verdict.degree);
+         rift_dsl_put_u32(data, &offset, analysis->verdict.nested_quantifiers);
+         rift_dsl_put_u32(data, &offset, analysis->verdict.has_backreference ? 1u : 0u);
+         rift_dsl_put_u32(data, &offset, 0);
+         memcpy(data + offset, &table_size, sizeof(table_size));
+         offset += sizeof(table_size);
+         
+         if (analysis->has_prefilter) {
+             memset(data + offset, 0, RIFT_DSL_PREFILTER_SIZE);
+             memcpy(data + offset, &analysis->prefilter, sizeof(rift_prefilter_t));
+             offset += RIFT_DSL_PREFILTER_SIZE;
+         }
+         if (analysis->table) {
+             rift_dfa_table_encode(analysis->table, data + offset);
+             offset += (size_t)table_size;
+         }
+     }
+ }
+ 
+ /**
+  * @brief Free the analyses of a compilation
+  * 
+  * @param analyses The analyses, NULL for none
+  * @param count Number of analyses
+  */
+ static void
+ rift_dsl_analyses_free(rift_dsl_analysis_t *analyses, size_t count)
+ {
+     for (size_t i = 0; analyses && i < count; i++) {
+         rift_dfa_table_free(analyses[i].table);
+     }
+     free(analyses);
+ }
+ 
+ /**
+  * @brief Read the analysis section following the programs of a compilation
+  * 
+  * @param compilation The compilation structure, holding its programs
+  * @param data The section
+  * @param size Number of bytes available at data
+  * @return true if the section was read, false if it is damaged
+  */
+ static bool
+ rift_dsl_analysis_section_read(rift_dsl_compilation_t *compilation, const uint8_t *data,
+                                size_t size)
+ {
+     size_t offset = 4;
+     if (size < RIFT_DSL_ANALYSIS_HEADER_SIZE ||
+         rift_dsl_get_u32(data, &offset) != RIFT_DSL_ANALYSIS_VERSION ||
+         rift_dsl_get_u32(data, &offset) != sizeof(rift_prefilter_t) ||
+         rift_dsl_get_u32(data, &offset) != compilation->count) {
+         return false;
+     }
+     
+     rift_dsl_analysis_t *analyses = (rift_dsl_analysis_t *)calloc(
+         compilation->count > 0 ? compilation->count : 1, sizeof(rift_dsl_analysis_t));
+     if (!analyses) {
+         return false;
+     }
+     
+     for (size_t i = 0; i < compilation->count; i++) {
+         rift_dsl_analysis_t *analysis = &analyses[i];
+         if (size - offset < RIFT_DSL_ANALYSIS_ENTRY_SIZE) {
+             rift_dsl_analyses_free(analyses, compilation->count);
+             return false;
+         }
+         
+         uint32_t flags = rift_dsl_get_u32(data, &offset);
+         uint32_t ambiguity = rift_dsl_get_u32(data, &offset);
+         analysis->verdict.degree = rift_dsl_get_u32(data, &offset);
+         analysis->verdict.nested_quantifiers = rift_dsl_get_u32(data, &offset);
+         analysis->verdict.has_backreference = rift_dsl_get_u32(data, &offset) != 0;
+         offset += sizeof(uint32_t);
+         uint64_t table_size;
+         memcpy(&table_size, data + offset, sizeof(table_size));
+         offset += sizeof(table_size);
+         analysis->verdict.ambiguity = ambiguity <= RIFT_AMBIGUITY_EXPONENTIAL
+                                           ? (rift_ambiguity_t)ambiguity
+                                           : RIFT_AMBIGUITY_UNKNOWN;
+         analysis->has_verdict = (flags & RIFT_DSL_ANALYSIS_VERDICT) != 0;
+         analysis->check_required = (flags & RIFT_DSL_ANALYSIS_CHECK_REQUIRED) != 0;
+         
+         if (flags & RIFT_DSL_ANALYSIS_PREFILTER) {
+             if (size - offset < RIFT_DSL_PREFILTER_SIZE) {
+                 rift_dsl_analyses_free(analyses, compilation->count);
+                 return false;
+             }
+             memcpy(&analysis->prefilter, data + offset, sizeof(rift_prefilter_t));
+             analysis->has_prefilter = true;
+             offset += RIFT_DSL_PREFILTER_SIZE;
+         }
+         
+         // The table is decoded as written, so the VM never determinizes again
+         if (flags & RIFT_DSL_ANALYSIS_TABLE) {
+             size_t used = 0;
+             analysis->table = table_size <= size - offset
+                                   ? rift_dfa_table_decode(data + offset, (size_t)table_size,
+                                                           false, &used, NULL)
+                                   : NULL;
+             if (!analysis->table || used != table_size) {
+                 rift_dsl_analyses_free(analyses, compilation->count);
+                 return false;
+             }
+             offset += (size_t)table_size;
+         }
+     }
+     
+     compilation->analyses = analyses;
+     return true;
+ }
+ 
  /**
   * @brief Serialize a compilation to binary data
   * 
@@ -124,7 +462,8 @@
      // Calculate size for each program
      for (size_t i = 0; i < compilation->count; i++) {
          size_t program_size = 0;
-         if (!rift_bytecode_serialize(compilation->programs[i], NULL, &program_size)) {
+         if (!rift_bytecode_serialize(rift_dsl_compilation_program(compilation, i), NULL,
+                                      &program_size)) {
              free(program_sizes);
              return false;
          }
@@ -132,6 +471,8 @@
          program_sizes[i] = program_size;
          total_size += sizeof(size_t) + program_size; // Size + program data
      }
+     size_t analysis_size = rift_dsl_analysis_section_size(compilation);
+     total_size += analysis_size;
      
      // Allocate memory for serialized data
      uint8_t *buffer = (uint8_t *)malloc(total_size);
@@ -152,7 +493,8 @@
          
          // Write program data
          size_t program_size = program_sizes[i];
-         if (!rift_bytecode_serialize(compilation->programs[i], buffer + offset, &program_size)) {
+         if (!rift_bytecode_serialize(rift_dsl_compilation_program(compilation, i),
+                                      buffer + offset, &program_size)) {
              free(program_sizes);
              free(buffer);
              return false;
@@ -161,6 +503,11 @@
          offset += program_size;
      }
      
+     // Tables and literals follow the programs, where older readers stop looking
+     if (analysis_size > 0) {
+         rift_dsl_analysis_section_write(compilation, buffer + offset);
+     }
+     
      free(program_sizes);
      
      *data = buffer;
@@ -223,7 +570,8 @@
              char message[256];
              snprintf(message, sizeof(message), 
                      "Failed to deserialize program: %s", 
-                     regex_error.message[0] ? regex_error.message : "Unknown error");
+                     rift_regex_error_message(&regex_error)[0] ? regex_error.message
+                                                               : "Unknown error");
              rift_dsl_compilation_error(compilation, message);
              return compilation;
          }
@@ -238,6 +586,12 @@
          }
      }
      
+     // Binaries written before the analysis section end here
+     if (size - offset >= 4 && memcmp(data + offset, RIFT_DSL_ANALYSIS_MAGIC, 4) == 0 &&
+         !rift_dsl_analysis_section_read(compilation, data + offset, size - offset)) {
+         rift_dsl_compilation_error(compilation, "Serialized analysis damaged");
+     }
+     
      return compilation;
  }
  
@@ -251,23 +605,85 @@
   */
  void *
  rift_dsl_compile(const char *source)
+ {
+     return rift_dsl_compile_with_options(source, NULL);
+ }
+ 
+ /**
+  * @brief Compile a .rift DSL source to bytecode on several threads
+  * 
+  * @param source The .rift DSL source code
+  * @param options Options of the compilation (can be NULL for the defaults)
+  * @return Opaque handle to compiled bytecode or NULL on error
+  */
+ void *
+ rift_dsl_compile_with_options(const char *source, const rift_dsl_compile_options_t *options)
  {
      if (!source) {
          return NULL;
      }
      
+     rift_dsl_compile_options_t defaults = {0, NULL, 0, NULL, NULL, false};
+     if (!options) {
+         options = &defaults;
+     }
+     if (options->lint) {
+         memset(options->lint, 0, sizeof(*options->lint));
+     }
+     rift_dsl_compile_stats_t stats;
+     memset(&stats, 0, sizeof(stats));
+     
      // Parse the DSL source
+     uint64_t parse_start = rift_dsl_clock_ns();
      void *dsl_handle = rift_dsl_parse(source);
+     stats.parse_ns = rift_dsl_clock_ns() - parse_start;
      if (!dsl_handle) {
          return NULL;
      }
      
      // Compile the patterns
-     rift_dsl_compilation_t *compilation = rift_dsl_compile_patterns(dsl_handle);
+     rift_dsl_compilation_t *compilation =
+         rift_dsl_compile_patterns(dsl_handle, options, &stats);
      
      // Free the DSL handle
      rift_dsl_free(dsl_handle);
      
+     if (options->stats) {
+         *options->stats = stats;
+     }
+     return compilation;
+ }
+ 
+ /**
+  * @brief Compile a .rift DSL file while parsing it as a stream
+  * 
+  * @param filename The .rift DSL file
+  * @param options Options of the compilation (can be NULL for the defaults)
+  * @return Opaque handle to compiled bytecode or NULL on error
+  */
+ void *
+ rift_dsl_compile_file(const char *filename, const rift_dsl_compile_options_t *options)
+ {
+     if (!filename) {
+         return NULL;
+     }
+     
+     rift_dsl_compile_options_t defaults = {0, NULL, 0, NULL, NULL, false};
+     if (!options) {
+         options = &defaults;
+     }
+     if (options->lint) {
+         memset(options->lint, 0, sizeof(*options->lint));
+     }
+     rift_dsl_compile_stats_t stats;
+     memset(&stats, 0, sizeof(stats));
+     
+     rift_dsl_compilation_t *compilation =
+         rift_dsl_compile_stream(filename, options, &stats);
+     
+     if (options->stats) {
+         *options->stats = stats;
+     }
      return compilation;
  }
  
@@ -282,6 +698,26 @@
      rift_dsl_compilation_free((rift_dsl_compilation_t *)handle);
  }
  
+ /**
+  * @brief Free the redundancies of a lint report
+  * 
+  * @param lint The report, emptied (can be NULL)
+  */
+ void
+ rift_dsl_lint_free(rift_dsl_lint_t *lint)
+ {
+     if (!lint) {
+         return;
+     }
+     
+     for (size_t i = 0; i < lint->count; i++) {
+         free(lint->redundancies[i].name);
+         free(lint->redundancies[i].covered_by_name);
+     }
+     free(lint->redundancies);
+     memset(lint, 0, sizeof(*lint));
+ }
+ 
  /**
   * @brief Get error message from compiled bytecode
   * 
@@ -331,7 +767,157 @@
          return NULL;
      }
      
-     return compilation->programs[index];
+     return rift_dsl_compilation_program(compilation, index);
+ }
+ 
+ /**
+  * @brief Get the time taken to compile a program
+  * 
+  * @param handle The compilation handle
+  * @param index Program index
+  * @return Nanoseconds of wall time, 0 if unknown or the index is invalid
+  */
+ uint64_t
+ rift_dsl_get_compile_ns(void *handle, size_t index)
+ {
+     rift_dsl_compilation_t *compilation = (rift_dsl_compilation_t *)handle;
+     if (!compilation || !compilation->compile_ns || index >= compilation->count) {
+         return 0;
+     }
+     
+     return compilation->compile_ns[index];
+ }
+ 
+ /**
+  * @brief Get the analysis of a program
+  * 
+  * @param handle The compilation handle
+  * @param index Program index
+  * @return The analysis or NULL if there is none or the index is invalid
+  */
+ static const rift_dsl_analysis_t *
+ rift_dsl_get_analysis(void *handle, size_t index)
+ {
+     rift_dsl_compilation_t *compilation = (rift_dsl_compilation_t *)handle;
+     if (!compilation || !compilation->analyses || index >= compilation->count) {
+         return NULL;
+     }
+     
+     return &compilation->analyses[index];
+ }
+ 
+ /**
+  * @brief Get the name of a compiled program
+  * 
+  * @param handle The compilation handle
+  * @param index Program index
+  * @return The name, or NULL if unknown or the index is invalid
+  */
+ const char *
+ rift_dsl_get_compiled_name(void *handle, size_t index)
+ {
+     rift_dsl_compilation_t *compilation = (rift_dsl_compilation_t *)handle;
+     if (!compilation || !compilation->names || index >= compilation->count) {
+         return NULL;
+     }
+     
+     return compilation->names[index];
+ }
+ 
+ /**
+  * @brief Get the number of rule combinations of a compilation
+  * 
+  * @param handle The compilation handle
+  * @return Number of compiled @combine directives
+  */
+ size_t
+ rift_dsl_get_compiled_combination_count(void *handle)
+ {
+     rift_dsl_compilation_t *compilation = (rift_dsl_compilation_t *)handle;
+     return compilation ? compilation->num_formulas : 0;
+ }
+ 
+ /**
+  * @brief Get the name of a compiled rule combination
+  * 
+  * @param handle The compilation handle
+  * @param index Combination index
+  * @return The name, or NULL if the index is invalid
+  */
+ const char *
+ rift_dsl_get_compiled_combination_name(void *handle, size_t index)
+ {
+     rift_dsl_compilation_t *compilation = (rift_dsl_compilation_t *)handle;
+     if (!compilation || index >= compilation->num_formulas) {
+         return NULL;
+     }
+     
+     return compilation->formula_names[index];
+ }
+ 
+ /**
+  * @brief Get the number of rule shards of a compilation
+  * 
+  * @param handle The compilation handle
+  * @return Number of rule unions rift_dsl_execute_all scans, 0 if none
+  */
+ size_t
+ rift_dsl_get_shard_count(void *handle)
+ {
+     rift_dsl_compilation_t *compilation = (rift_dsl_compilation_t *)handle;
+     size_t count = 0;
+     for (size_t s = 0; compilation && s < compilation->num_shards; s++) {
+         count += compilation->shards[s].rules ? 1 : 0;
+     }
+     return count;
+ }
+ 
+ /**
+  * @brief Get the minimized DFA table of a program
+  * 
+  * @param handle The compilation handle
+  * @param index Program index
+  * @return The table, or NULL if the program has none or the index is invalid
+  */
+ const rift_dfa_table_t *
+ rift_dsl_get_dfa_table(void *handle, size_t index)
+ {
+     const rift_dsl_analysis_t *analysis = rift_dsl_get_analysis(handle, index);
+     return analysis ? analysis->table : NULL;
+ }
+ 
+ /**
+  * @brief Get the prefilter of a program
+  * 
+  * @param handle The compilation handle
+  * @param index Program index
+  * @return The prefilter, or NULL if none was computed or the index is invalid
+  */
+ const rift_prefilter_t *
+ rift_dsl_get_prefilter(void *handle, size_t index)
+ {
+     const rift_dsl_analysis_t *analysis = rift_dsl_get_analysis(handle, index);
+     return analysis && analysis->has_prefilter ? &analysis->prefilter : NULL;
+ }
+ 
+ /**
+  * @brief Get the static ambiguity verdict of a program
+  * 
+  * @param handle The compilation handle
+  * @param index Program index
+  * @param verdict Verdict to fill in
+  * @return true if the verdict is known, false otherwise
+  */
+ bool
+ rift_dsl_get_ambiguity(void *handle, size_t index, rift_ambiguity_verdict_t *verdict)
+ {
+     const rift_dsl_analysis_t *analysis = rift_dsl_get_analysis(handle, index);
+     if (!analysis || !analysis->has_verdict || !verdict) {
+         return false;
+     }
+     
+     *verdict = analysis->verdict;
+     return true;
  }
  
  /**
@@ -362,144 +948,1628 @@
  }
  
  /**
-  * @brief Execute a compiled pattern on an input string
+  * @brief Write compiled bytecode as a memory-mappable container
   * 
   * @param handle Opaque handle returned by rift_dsl_compile
-  * @param index Index of the pattern to execute
-  * @param input Input string to match against
-  * @param input_length Length of the input string or (size_t)-1 to use strlen
-  * @param match Pointer to store match information (can be NULL)
-  * @return true if pattern matched, false otherwise
+  * @param data Pointer to receive the container bytes, freed with free()
+  * @param size Pointer to receive the size of the container
+  * @return true if successful, false otherwise
   */
  bool
- rift_dsl_execute(void *handle, size_t index, const char *input, 
-                  size_t input_length, rift_regex_match_t *match)
+ rift_dsl_serialize_container(void *handle, uint8_t **data, size_t *size)
  {
      rift_dsl_compilation_t *compilation = (rift_dsl_compilation_t *)handle;
-     if (!compilation || index >= compilation->count || !input) {
+     if (!compilation || !data || !size || compilation->count > UINT32_MAX) {
          return false;
      }
      
-     // Get the program
-     rift_bytecode_program_t *program = compilation->programs[index];
+     // A mapped compilation is written out from its unpacked programs
+     rift_bytecode_program_t **programs = compilation->programs;
+     if (compilation->container) {
+         programs = (rift_bytecode_program_t **)malloc(
+             (compilation->count > 0 ? compilation->count : 1) * sizeof(rift_bytecode_program_t *));
+         for (size_t i = 0; programs && i < compilation->count; i++) {
+             programs[i] = rift_dsl_compilation_program(compilation, i);
+             if (!programs[i]) {
+                 free(programs);
+                 programs = NULL;
+             }
+         }
+         if (!programs) {
+             return false;
+         }
+     }
      
-     // Create a VM
-     rift_bytecode_vm_t *vm = rift_bytecode_vm_create(program, input, input_length);
-     if (!vm) {
+     uint32_t count = (uint32_t)compilation->count;
+     size_t container_size = 0;
+     uint8_t *buffer = NULL;
+     bool written = rift_bytecode_container_write(programs, count, NULL, &container_size) &&
+                    (buffer = (uint8_t *)malloc(container_size)) != NULL &&
+                    rift_bytecode_container_write(programs, count, buffer, &container_size);
+     
+     if (programs != compilation->programs) {
+         free(programs);
+     }
+     if (!written) {
+         free(buffer);
          return false;
      }
      
-     // Execute the program
-     bool result = rift_bytecode_execute(program, vm, match);
-     
-     // Free the VM
-     rift_bytecode_vm_free(vm);
+     *data = buffer;
+     *size = container_size;
+     return true;
+ }
+ 
+ /**
+  * @brief Wrap a loaded container in a compilation
+  * 
+  * @param container The container, or NULL if it failed to load
+  * @param regex_error Why the container failed to load
+  * @param action What failed, for the error message
+  * @return Opaque handle to compiled bytecode or NULL on error
+  */
+ static void *
+ rift_dsl_container_compilation(rift_bytecode_container_t *container,
+                                const rift_regex_error_t *regex_error, const char *action)
+ {
+     rift_dsl_compilation_t *compilation = rift_dsl_compilation_create(1);
+     if (!compilation) {
+         rift_bytecode_container_close(container);
+         return NULL;
+     }
+     
+     compilation->container = container;
+     if (!compilation->container) {
+         char message[256];
+         rift_regex_error_t reason = *regex_error;
+         const char *text = rift_regex_error_message(&reason);
+         snprintf(message, sizeof(message), "Failed to %s compiled patterns: %s", action,
+                  text[0] ? text : "Unknown error");
+         rift_dsl_compilation_error(compilation, message);
+         return compilation;
+     }
+     
+     compilation->count = rift_bytecode_container_count(compilation->container);
+     return compilation;
+ }
+ 
+ /**
+  * @brief Open compiled bytecode by mapping a container file
+  * 
+  * @param filename Path of a file written from rift_dsl_serialize_container
+  * @return Opaque handle to compiled bytecode or NULL on error
+  */
+ void *
+ rift_dsl_map_compilation(const char *filename)
+ {
+     if (!filename) {
+         return NULL;
+     }
+     
+     rift_regex_error_t regex_error;
+     memset(&regex_error, 0, sizeof(regex_error));
+     rift_bytecode_container_t *container = rift_bytecode_container_open(filename, &regex_error);
+     return rift_dsl_container_compilation(container, &regex_error, "map");
+ }
+ 
+ /**
+  * @brief Open compiled bytecode from container bytes already in memory
+  * 
+  * @param data Bytes written by rift_dsl_serialize_container, aligned to 8 bytes
+  * @param size Number of bytes
+  * @return Opaque handle to compiled bytecode or NULL on error
+  */
+ void *
+ rift_dsl_load_container(const uint8_t *data, size_t size)
+ {
+     if (!data) {
+         return NULL;
+     }
+     
+     rift_regex_error_t regex_error;
+     memset(&regex_error, 0, sizeof(regex_error));
+     rift_bytecode_container_t *container = rift_bytecode_container_load(data, size, &regex_error);
+     return rift_dsl_container_compilation(container, &regex_error, "load");
+ }
+ 
+ /**
+  * @brief Check whether the prefilter of a program lets a match start at position 0
+  * 
+  * @param analysis The analysis of the program
+  * @param input The input bytes
+  * @param length Number of input bytes
+  * @return false if no match can start at the beginning of the input
+  */
+ static bool
+ rift_dsl_prefilter_allows_start(const rift_dsl_analysis_t *analysis, const char *input,
+                                 size_t length)
+ {
+     if (!analysis->has_prefilter) {
+         return true;
+     }
+     
+     const rift_prefilter_t *prefilter = &analysis->prefilter;
+     size_t prefix_length = prefilter->prefix.length;
+     if (prefix_length > length) {
+         return false;
+     }
+     for (size_t i = 0; i < prefix_length; i++) {
+         unsigned char expected = (unsigned char)prefilter->prefix.bytes[i];
+         unsigned char actual = (unsigned char)input[i];
+         if (prefilter->caseless) {
+             expected = (unsigned char)tolower(expected);
+             actual = (unsigned char)tolower(actual);
+         }
+         if (expected != actual) {
+             return false;
+         }
+     }
+     
+     // A pattern matching the empty string keeps all 256 first bytes
+     if (prefilter->num_first_bytes < 256) {
+         if (length == 0) {
+             return false;
+         }
+         unsigned char first = (unsigned char)input[0];
+         if (((prefilter->first_bytes[first / 64] >> (first % 64)) & 1) == 0) {
+             return false;
+         }
+     }
+     
+     // Searching the input only pays off for patterns a profile found selective
+     if (!analysis->check_required || prefilter->num_required == 0) {
+         return true;
+     }
+     for (size_t i = 0; i < prefilter->num_required; i++) {
+         const rift_prefilter_literal_t *literal = &prefilter->required[i];
+         size_t found = prefilter->caseless
+                            ? rift_prefilter_find_literal_caseless(input, length, 0, literal->bytes,
+                                                                   literal->length)
+                            : rift_prefilter_find_literal(input, length, 0, literal->bytes,
+                                                          literal->length);
+         if (found != RIFT_PREFILTER_NO_CANDIDATE) {
+             return true;
+         }
+     }
+     return false;
+ }
+ 
+ /**
+  * @brief Execute a compiled pattern on an input string
+  * 
+  * @param handle Opaque handle returned by rift_dsl_compile
+  * @param index Index of the pattern to execute
+  * @param input Input string to match against
+  * @param input_length Length of the input string or (size_t)-1 to use strlen
+  * @param match Pointer to store match information (can be NULL)
+  * @return true if pattern matched, false otherwise
+  */
+ bool
+ rift_dsl_execute(void *handle, size_t index, const char *input, 
+                  size_t input_length, rift_regex_match_t *match)
+ {
+     rift_dsl_compilation_t *compilation = (rift_dsl_compilation_t *)handle;
+     if (!compilation || index >= compilation->count || !input) {
+         return false;
+     }
+     
+     // Get the program
+     rift_bytecode_program_t *program = rift_dsl_compilation_program(compilation, index);
+     if (!program) {
+         return false;
+     }
+     if (input_length == (size_t)-1) {
+         input_length = strlen(input);
+     }
+     
+     // Programs match at the start of the input, where the prefilter may already rule out a match
+     const rift_dsl_analysis_t *analysis = rift_dsl_get_analysis(compilation, index);
+     if (analysis && !rift_dsl_prefilter_allows_start(analysis, input, input_length)) {
+         return false;
+     }
+     
+     // Without match details to fill, the minimized DFA answers on its own
+     if (analysis && analysis->table && !match) {
+         return rift_dfa_table_longest_prefix(analysis->table, input, input_length, NULL);
+     }
+     
+     // Take a VM from this thread's pool, it keeps its buffers between calls
+     rift_bytecode_vm_t *vm = rift_bytecode_vm_acquire(program, input, input_length);
+     if (!vm) {
+         return false;
+     }
+     
+     // Execute the program
+     bool result = rift_bytecode_execute(program, vm, match);
+     
+     // Hand the VM back
+     rift_bytecode_vm_release(vm);
+     
+     return result;
+ }
+ 
+ /**
+  * @brief Execute a compiled pattern on each of several inputs
+  * 
+  * Inputs are taken a block at a time. The prefilter drops what it can, and
+  * the rest of the block goes through the DFA table in one interleaved scan.
+  * 
+  * @param handle Opaque handle returned by rift_dsl_compile
+  * @param index Index of the pattern to execute
+  * @param inputs Input strings to match against
+  * @param lengths Lengths of the input strings, NULL to use strlen
+  * @param count Number of inputs
+  * @param results Array of count results to fill
+  * @return Number of inputs the pattern matched
+  */
+ size_t
+ rift_dsl_execute_batch(void *handle, size_t index, const char *const *inputs,
+                        const size_t *lengths, size_t count, bool *results)
+ {
+     rift_dsl_compilation_t *compilation = (rift_dsl_compilation_t *)handle;
+     if (!compilation || index >= compilation->count || (count > 0 && (!inputs || !results))) {
+         return 0;
+     }
+     
+     // Without a table every input runs on its own
+     const rift_dsl_analysis_t *analysis = rift_dsl_get_analysis(compilation, index);
+     size_t matched = 0;
+     if (!analysis || !analysis->table) {
+         for (size_t i = 0; i < count; i++) {
+             results[i] = rift_dsl_execute(handle, index, inputs[i],
+                                           lengths ? lengths[i] : (size_t)-1, NULL);
+             matched += results[i];
+         }
+         return matched;
+     }
+     
+     const char *block_inputs[RIFT_DSL_BATCH_BLOCK];
+     size_t block_lengths[RIFT_DSL_BATCH_BLOCK];
+     size_t block_indices[RIFT_DSL_BATCH_BLOCK];
+     size_t block_ends[RIFT_DSL_BATCH_BLOCK];
+     for (size_t begin = 0; begin < count; begin += RIFT_DSL_BATCH_BLOCK) {
+         size_t end = count - begin < RIFT_DSL_BATCH_BLOCK ? count : begin + RIFT_DSL_BATCH_BLOCK;
+         size_t block = 0;
+         for (size_t i = begin; i < end; i++) {
+             results[i] = false;
+             const char *input = inputs[i];
+             size_t length = input ? (lengths ? lengths[i] : strlen(input)) : 0;
+             if (!input || !rift_dsl_prefilter_allows_start(analysis, input, length)) {
+                 continue;
+             }
+             block_inputs[block] = input;
+             block_lengths[block] = length;
+             block_indices[block] = i;
+             block++;
+         }
+         
+         rift_dfa_table_longest_prefix_many(analysis->table, block_inputs, block_lengths, block,
+                                            block_ends);
+         for (size_t i = 0; i < block; i++) {
+             results[block_indices[i]] = block_ends[i] != RIFT_DFA_NO_MATCH;
+             matched += results[block_indices[i]];
+         }
+     }
+     return matched;
+ }
+ 
+ /**
+  * @brief Check whether a compiled pattern matches an input string
+  * 
+  * @param handle Opaque handle returned by rift_dsl_compile
+  * @param index Index of the pattern to execute
+  * @param input Input string to match against
+  * @param input_length Length of the input string or (size_t)-1 to use strlen
+  * @return true if pattern matched, false otherwise
+  */
+ bool
+ rift_dsl_is_match(void *handle, size_t index, const char *input, size_t input_length)
+ {
+     rift_dsl_compilation_t *compilation = (rift_dsl_compilation_t *)handle;
+     if (!compilation || index >= compilation->count || !input) {
+         return false;
+     }
+     if (input_length == (size_t)-1) {
+         input_length = strlen(input);
+     }
+     
+     // Any accepted prefix answers, so the table scan ends at the first accepting state
+     const rift_dsl_analysis_t *analysis = rift_dsl_get_analysis(compilation, index);
+     if (analysis && analysis->table) {
+         return rift_dsl_prefilter_allows_start(analysis, input, input_length) &&
+                rift_dfa_table_shortest_prefix(analysis->table, input, input_length, NULL);
+     }
+     return rift_dsl_execute(handle, index, input, input_length, NULL);
+ }
+ 
+ /**
+  * @brief Count the matches of a compiled pattern in an input string
+  * 
+  * @param handle Opaque handle returned by rift_dsl_compile
+  * @param index Index of the pattern to execute
+  * @param input Input string to match against
+  * @param input_length Length of the input string or (size_t)-1 to use strlen
+  * @return Number of non-empty matches, 0 on invalid parameters
+  */
+ size_t
+ rift_dsl_count(void *handle, size_t index, const char *input, size_t input_length)
+ {
+     rift_dsl_compilation_t *compilation = (rift_dsl_compilation_t *)handle;
+     if (!compilation || index >= compilation->count || !input) {
+         return 0;
+     }
+     if (input_length == (size_t)-1) {
+         input_length = strlen(input);
+     }
+     
+     // Each search restarts where the previous match ended
+     const rift_dsl_analysis_t *analysis = rift_dsl_get_analysis(compilation, index);
+     size_t count = 0;
+     size_t pos = 0;
+     while (pos < input_length) {
+         const char *subject = input + pos;
+         size_t length = input_length - pos;
+         size_t end = 0;
+         if (analysis && analysis->table) {
+             if (!rift_dsl_prefilter_allows_start(analysis, subject, length) ||
+                 !rift_dfa_table_longest_prefix(analysis->table, subject, length, &end)) {
+                 end = 0;
+             }
+         } else {
+             // The VM only reports the bounds, it copies no groups
+             rift_regex_match_t match = {0};
+             if (rift_dsl_execute(handle, index, subject, length, &match)) {
+                 end = match.end_pos;
+             }
+         }
+         
+         if (end > 0) {
+             count++;
+             pos += end;
+         } else {
+             pos++;
+         }
+     }
+     return count;
+ }
+ 
+ /**
+  * @brief Execute a compiled pattern on the VM and record it in a profile
+  * 
+  * @param handle Opaque handle returned by rift_dsl_compile
+  * @param index Index of the pattern to execute
+  * @param input Input string to match against
+  * @param input_length Length of the input string or (size_t)-1 to use strlen
+  * @param match Pointer to store match information (can be NULL)
+  * @param profile Profile to record the search in
+  * @return true if pattern matched, false otherwise
+  */
+ bool
+ rift_dsl_execute_profiled(void *handle, size_t index, const char *input, size_t input_length,
+                           rift_regex_match_t *match, rift_dsl_profile_t *profile)
+ {
+     rift_dsl_compilation_t *compilation = (rift_dsl_compilation_t *)handle;
+     if (!compilation || index >= compilation->count || !input) {
+         return false;
+     }
+     
+     rift_bytecode_program_t *program = rift_dsl_compilation_program(compilation, index);
+     rift_bytecode_vm_t *vm =
+         program ? rift_bytecode_vm_acquire(program, input, input_length) : NULL;
+     if (!vm) {
+         return false;
+     }
+     
+     // The VM runs whatever the analysis found, so the profile sees the cost it saves
+     bool result = rift_bytecode_execute(program, vm, match);
+     rift_match_stats_t stats;
+     bool has_stats = rift_bytecode_vm_get_stats(vm, &stats);
+     rift_bytecode_vm_release(vm);
+     
+     const char *name = compilation->names ? compilation->names[index] : NULL;
+     if (name) {
+         rift_dsl_profile_record(profile, name, result, has_stats ? &stats : NULL);
+     }
+     return result;
+ }
+ 
+ /**
+  * @brief Take an idle scanner of a shard, or create one
+  * 
+  * @param compilation The compilation
+  * @param shard The shard, holding a rule union
+  * @return The scanner or NULL on failure
+  */
+ static rift_dsl_scanner_t *
+ rift_dsl_scanner_acquire(rift_dsl_compilation_t *compilation, rift_dsl_shard_t *shard)
+ {
+     pthread_mutex_lock(&compilation->scanner_lock);
+     rift_dsl_scanner_t *scanner = shard->idle_scanners;
+     if (scanner) {
+         shard->idle_scanners = scanner->next;
+     }
+     pthread_mutex_unlock(&compilation->scanner_lock);
+     if (scanner) {
+         return scanner;
+     }
+     
+     // Programs match at the start of the input, so the union DFA is anchored too;
+     // the cache holds every state the shard was estimated to need
+     size_t cache_states = shard->estimated_states > RIFT_LAZY_DFA_DEFAULT_CACHE_STATES
+                               ? shard->estimated_states
+                               : RIFT_LAZY_DFA_DEFAULT_CACHE_STATES;
+     scanner = (rift_dsl_scanner_t *)calloc(1, sizeof(rift_dsl_scanner_t));
+     if (!scanner) {
+         return NULL;
+     }
+     scanner->lazy =
+         rift_lazy_dfa_create(rift_pattern_set_get_automaton(shard->rules), cache_states, NULL);
+     scanner->num_words = 1;
+     if (scanner->lazy && scanner->lazy->tag_words > 0) {
+         scanner->num_words = scanner->lazy->tag_words;
+     }
+     scanner->tags = (uint64_t *)calloc(scanner->num_words, sizeof(uint64_t));
+     if (!scanner->lazy || !scanner->tags) {
+         rift_lazy_dfa_free(scanner->lazy);
+         free(scanner->tags);
+         free(scanner);
+         return NULL;
+     }
+     return scanner;
+ }
+ 
+ /**
+  * @brief Give a scanner back to its shard
+  * 
+  * @param compilation The compilation
+  * @param shard The shard the scanner was taken from
+  * @param scanner The scanner from rift_dsl_scanner_acquire
+  */
+ static void
+ rift_dsl_scanner_release(rift_dsl_compilation_t *compilation, rift_dsl_shard_t *shard,
+                          rift_dsl_scanner_t *scanner)
+ {
+     pthread_mutex_lock(&compilation->scanner_lock);
+     scanner->next = shard->idle_scanners;
+     shard->idle_scanners = scanner;
+     pthread_mutex_unlock(&compilation->scanner_lock);
+ }
+ 
+ /**
+  * @brief Execute every compiled program on an input string
+  * 
+  * @param handle Opaque handle returned by rift_dsl_compile
+  * @param input Input string to match against
+  * @param input_length Length of the input string or (size_t)-1 to use strlen
+  * @param callback Function called with the index of each matching program (can be NULL)
+  * @param user_data Pointer passed to the callback
+  * @return Number of matching programs reported
+  */
+ size_t
+ rift_dsl_execute_all(void *handle, const char *input, size_t input_length,
+                      rift_dsl_match_callback_t callback, void *user_data)
+ {
+     rift_dsl_compilation_t *compilation = (rift_dsl_compilation_t *)handle;
+     if (!compilation || !input) {
+         return 0;
+     }
+     if (input_length == (size_t)-1) {
+         input_length = strlen(input);
+     }
+     
+     // Scanners of the shards reached so far; without them every program runs on its own
+     rift_dsl_scanner_t *local_scanners[RIFT_DSL_LOCAL_SHARDS] = {NULL};
+     rift_dsl_scanner_t **scanners = local_scanners;
+     if (compilation->num_shards > RIFT_DSL_LOCAL_SHARDS) {
+         scanners = (rift_dsl_scanner_t **)calloc(compilation->num_shards,
+                                                  sizeof(rift_dsl_scanner_t *));
+     }
+     
+     size_t matched = 0;
+     for (size_t i = 0; i < compilation->count; i++) {
+         uint32_t shard = compilation->rule_shards ? compilation->rule_shards[i]
+                                                   : RIFT_DSL_NO_RULE;
+         rift_dsl_scanner_t *scanner = NULL;
+         
+         // One pass answers for every rule of a shard; a failed scan leaves them to the VM
+         if (shard != RIFT_DSL_NO_RULE && scanners) {
+             if (!scanners[shard]) {
+                 scanners[shard] = rift_dsl_scanner_acquire(compilation,
+                                                            &compilation->shards[shard]);
+                 if (scanners[shard]) {
+                     scanners[shard]->scanned =
+                         rift_lazy_dfa_scan_tags(scanners[shard]->lazy, input, input_length,
+                                                 scanners[shard]->tags,
+                                                 scanners[shard]->num_words);
+                 }
+             }
+             scanner = scanners[shard];
+         }
+         
+         uint32_t id = compilation->rule_ids ? compilation->rule_ids[i] : RIFT_DSL_NO_RULE;
+         bool hit = scanner && scanner->scanned
+                        ? ((scanner->tags[id / 64] >> (id % 64)) & 1) != 0
+                        : rift_dsl_execute(handle, i, input, input_length, NULL);
+         if (!hit) {
+             continue;
+         }
+         
+         matched++;
+         if (callback && !callback(i, user_data)) {
+             break;
+         }
+     }
+     
+     for (size_t s = 0; scanners && s < compilation->num_shards; s++) {
+         if (scanners[s]) {
+             rift_dsl_scanner_release(compilation, &compilation->shards[s], scanners[s]);
+         }
+     }
+     if (scanners != local_scanners) {
+         free(scanners);
+     }
+     return matched;
+ }
+ 
+ /* Bit-sliced matches of a block of inputs, filled by rift_dsl_execute_all */
+ typedef struct {
+     uint64_t *lanes;  /* Words of each program in turn, num_words per program */
+     size_t num_words; /* Words per program */
+     size_t input;     /* Input of the block being executed */
+ } rift_dsl_lane_fill_t;
+ 
+ /**
+  * @brief Set the bit of the current input in the lanes of a matching program
+  * 
+  * @param index Index of the matching program
+  * @param user_data The lanes to fill
+  * @return true to go on with the next programs
+  */
+ static bool
+ rift_dsl_fill_lane(size_t index, void *user_data)
+ {
+     rift_dsl_lane_fill_t *fill = (rift_dsl_lane_fill_t *)user_data;
+     fill->lanes[index * fill->num_words + fill->input / 64] |= (uint64_t)1 << (fill->input % 64);
+     return true;
+ }
+ 
+ /**
+  * @brief Evaluate every rule combination on each of several inputs
+  * 
+  * @param handle Opaque handle returned by rift_dsl_compile
+  * @param inputs Input strings
+  * @param lengths Lengths of the input strings, NULL to use strlen
+  * @param count Number of inputs
+  * @param results Array of num_combinations * count results, by combination then input
+  * @return Number of results that are true
+  */
+ size_t
+ rift_dsl_execute_combinations(void *handle, const char *const *inputs, const size_t *lengths,
+                               size_t count, bool *results)
+ {
+     rift_dsl_compilation_t *compilation = (rift_dsl_compilation_t *)handle;
+     if (!compilation || compilation->num_formulas == 0 || (count > 0 && (!inputs || !results))) {
+         return 0;
+     }
+     
+     enum { WORDS = RIFT_DSL_BATCH_BLOCK / 64 };
+     uint64_t *lanes = (uint64_t *)malloc((compilation->count > 0 ? compilation->count : 1) *
+                                          WORDS * sizeof(uint64_t));
+     if (!lanes) {
+         memset(results, 0, compilation->num_formulas * count * sizeof(bool));
+         return 0;
+     }
+     
+     size_t matched = 0;
+     uint64_t values[WORDS];
+     for (size_t begin = 0; begin < count; begin += RIFT_DSL_BATCH_BLOCK) {
+         size_t block = count - begin < RIFT_DSL_BATCH_BLOCK ? count - begin
+                                                             : RIFT_DSL_BATCH_BLOCK;
+         
+         // One execution of every rule per input fills the lanes of the block
+         rift_dsl_lane_fill_t fill = {lanes, (block + 63) / 64, 0};
+         memset(lanes, 0, compilation->count * fill.num_words * sizeof(uint64_t));
+         for (fill.input = 0; fill.input < block; fill.input++) {
+             const char *input = inputs[begin + fill.input];
+             if (input) {
+                 rift_dsl_execute_all(handle, input, lengths ? lengths[begin + fill.input]
+                                                             : (size_t)-1,
+                                      rift_dsl_fill_lane, &fill);
+             }
+         }
+         
+         for (size_t f = 0; f < compilation->num_formulas; f++) {
+             rift_dsl_formula_eval_lanes(&compilation->formulas[f], lanes, fill.num_words,
+                                         values);
+             bool *row = results + f * count + begin;
+             for (size_t i = 0; i < block; i++) {
+                 row[i] = ((values[i / 64] >> (i % 64)) & 1) != 0;
+                 matched += row[i];
+             }
+         }
+     }
+     
+     free(lanes);
+     return matched;
+ }
+ 
+ /**
+  * @brief Free resources associated with a compilation structure
+  * 
+  * @param compilation The compilation structure to free
+  */
+ static void
+ rift_dsl_compilation_free(rift_dsl_compilation_t *compilation)
+ {
+     if (!compilation) {
+         return;
+     }
+     
+     // Free all compiled programs, mapped ones go with their container
+     if (compilation->container) {
+         rift_bytecode_container_close(compilation->container);
+     } else {
+         for (size_t i = 0; i < compilation->count; i++) {
+             rift_bytecode_vm_pool_evict(compilation->programs[i]);
+             rift_bytecode_program_free(compilation->programs[i]);
+         }
+     }
+     
+     for (size_t s = 0; s < compilation->num_shards; s++) {
+         rift_dsl_shard_t *shard = &compilation->shards[s];
+         while (shard->idle_scanners) {
+             rift_dsl_scanner_t *scanner = shard->idle_scanners;
+             shard->idle_scanners = scanner->next;
+             rift_lazy_dfa_free(scanner->lazy);
+             free(scanner->tags);
+             free(scanner);
+         }
+         rift_pattern_set_free(shard->rules);
+     }
+     pthread_mutex_destroy(&compilation->scanner_lock);
+     free(compilation->shards);
+     free(compilation->rule_shards);
+     free(compilation->rule_ids);
+     free(compilation->compile_ns);
+     rift_dsl_analyses_free(compilation->analyses, compilation->count);
+     for (size_t i = 0; compilation->names && i < compilation->count; i++) {
+         free(compilation->names[i]);
+     }
+     free(compilation->names);
+     for (size_t i = 0; i < compilation->num_formulas; i++) {
+         rift_dsl_formula_destroy(&compilation->formulas[i]);
+         free(compilation->formula_names[i]);
+     }
+     free(compilation->formulas);
+     free(compilation->formula_names);
+     
+     free(compilation->programs);
+     free(compilation);
+ }
+ 
+ /**
+  * @brief Add a program to the compilation
+  * 
+  * @param compilation The compilation structure
+  * @param program The bytecode program to add
+  * @return true if successful, false otherwise
+  */
+ static bool
+ rift_dsl_compilation_add_program(rift_dsl_compilation_t *compilation, 
+                                  rift_bytecode_program_t *program)
+ {
+     if (!compilation || !program) {
+         return false;
+     }
+     
+     // Check if we need to grow the array
+     if (compilation->count >= compilation->capacity) {
+         size_t new_capacity = compilation->capacity * 2;
+         rift_bytecode_program_t **new_programs = (rift_bytecode_program_t **)realloc(
+             compilation->programs, new_capacity * sizeof(rift_bytecode_program_t *));
+         
+         if (!new_programs) {
+             return false;
+         }
+         
+         compilation->programs = new_programs;
+         compilation->capacity = new_capacity;
+     }
+     
+     // Add the program
+     compilation->programs[compilation->count++] = program;
+     
+     return true;
+ }
+ 
+ /**
+  * @brief Convert flag string to numeric flags
+  * 
+  * @param flag_name The flag name
+  * @return The numeric flag value or 0 if unknown
+  */
+ static rift_regex_flags_t
+ rift_dsl_flag_to_numeric(const char *flag_name)
+ {
+     if (!flag_name) {
+         return 0;
+     }
+     
+     // Define mappings from flag names to numeric values
+     struct {
+         const char *name;
+         rift_regex_flags_t value;
+     } flag_mappings[] = {
+         { "CASE_INSENSITIVE", 0x00000001 },
+         { "MULTILINE", 0x00000002 },
+         { "DOTALL", 0x00000004 },
+         { "EXTENDED", 0x00000008 },
+         { "OPTIMIZE", 0x00000010 },
+         { "UTF8", 0x00000020 },
+         { "JIT", 0x00000040 },
+         { NULL, 0 }
+     };
+     
+     // Look up the flag
+     for (int i = 0; flag_mappings[i].name != NULL; i++) {
+         if (strcmp(flag_name, flag_mappings[i].name) == 0) {
+             return flag_mappings[i].value;
+         }
+     }
+     
+     return 0;
+ }
+ 
+ /**
+  * @brief Read the monotonic clock for the compilation timings
+  */
+ static uint64_t
+ rift_dsl_clock_ns(void)
+ {
+     struct timespec now;
+     clock_gettime(CLOCK_MONOTONIC, &now);
+     return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+ }
+ 
+ /**
+  * @brief One pattern of a DSL file, queued for the compiling threads
+  */
+ typedef struct {
+     char *name;                       /* Name of the pattern */
+     char *pattern;                    /* Pattern string, freed once compiled */
+     rift_regex_flags_t flags;         /* Flags named in the DSL */
+     rift_bytecode_program_t *program; /* Program, set by the thread that compiled it */
+     rift_regex_pattern_t *rule;       /* Pattern for the rule union, NULL to keep to the VM */
+     uint64_t compile_ns;              /* Wall time of compiling the program */
+     rift_dsl_analysis_t analysis;     /* Table, prefilter and verdict of the pattern */
+     uint64_t profile_matches;         /* Matches recorded in the profile, 0 without one */
+     rift_frozen_automaton_t *language; /* Minimized DFA compared by the lint, or NULL */
+ } rift_dsl_job_entry_t;
+ 
+ /**
+  * @brief Patterns shared out among the threads of a compilation
+  * 
+  * When the source is parsed as a stream, patterns keep arriving while the
+  * threads compile and the entries move as they grow, so every field is
+  * only touched under the lock.
+  */
+ typedef struct {
+     rift_dsl_job_entry_t *entries;   /* Patterns in source order */
+     size_t count;                    /* Number of patterns */
+     size_t capacity;                 /* Number of entries allocated */
+     size_t next;                     /* Next pattern to take */
+     size_t failed_index;             /* First pattern that failed, SIZE_MAX if none */
+     size_t max_pending;              /* Patterns queued ahead of the threads, 0 for no limit */
+     bool open;                       /* Whether more patterns may arrive */
+     const rift_dsl_profile_t *profile; /* Read by the threads, NULL for none */
+     bool keep_languages;             /* Whether the threads keep the DFAs of the patterns */
+     pthread_mutex_t lock;            /* Guards the job */
+     pthread_cond_t added;            /* Signaled when a pattern arrives or the job closes */
+     pthread_cond_t taken;            /* Signaled when a pattern is taken or one fails */
+     char error_message[256];         /* Error of the pattern at failed_index */
+ } rift_dsl_job_t;
+ 
+ /**
+  * @brief One thread of a compilation
+  */
+ typedef struct {
+     rift_dsl_job_t *job;                     /* The compilation */
+     rift_bytecode_compile_timings_t timings; /* Stage times of the thread's patterns */
+     pthread_t thread;                        /* Thread running the worker */
+     bool started;                            /* Whether the thread was started */
+ } rift_dsl_worker_t;
+ 
+ /* Patterns a streamed source may be parsed ahead of each compiling thread */
+ #define RIFT_DSL_PENDING_PER_THREAD 64
+ 
+ /**
+  * @brief Compile a pattern for the rule union if a DFA can stand in for its program
+  * 
+  * The program matches at the start of the input, as the anchored union DFA
+  * does. Atomic groups and lookarounds depend on more than the states
+  * reached, so patterns using them keep to the VM. The lazy union DFA checks
+  * word boundaries and anchors, the latter only outside multiline mode, as
+  * the union has no flags of its own; those patterns get no table.
+  * Auto-possessification is left off, as its atomic groups would send every
+  * pattern with a repeat to the VM too.
+  * 
+  * The same compiled pattern gives the analysis kept with the program: its
+  * ambiguity verdict, its prefilter and, for a rule within
+  * RIFT_DSL_MAX_TABLE_STATES states, its minimized DFA table. A profile that
+  * found the pattern costly on the VM lets its table grow larger, and one
+  * that found it selective has its required literals looked for before it runs.
+  * 
+  * @param entry The pattern, whose program compiled
+  * @param profiled What the profile recorded for the pattern (can be NULL)
+  * @param analysis Analysis to fill, zeroed by the caller
+  * @param language Where to keep the frozen minimized DFA given a table (can be NULL)
+  * @return The compiled pattern or NULL to run the program instead
+  */
+ static rift_regex_pattern_t *
+ rift_dsl_compile_rule(const rift_dsl_job_entry_t *entry, const rift_dsl_profile_entry_t *profiled,
+                       rift_dsl_analysis_t *analysis, rift_frozen_automaton_t **language)
+ {
+     const rift_state_flag_t anchors = RIFT_STATE_FLAG_ANCHOR_START | RIFT_STATE_FLAG_ANCHOR_END;
+     const rift_state_flag_t boundaries =
+         RIFT_STATE_FLAG_WORD_BOUNDARY | RIFT_STATE_FLAG_NOT_WORD_BOUNDARY;
+     const rift_state_flag_t atomic = RIFT_STATE_FLAG_ATOMIC_START | RIFT_STATE_FLAG_ATOMIC_END;
+     
+     rift_regex_pattern_t *rule =
+         rift_regex_compile(entry->pattern, entry->flags | RIFT_REGEX_FLAG_NO_AUTO_POSSESS, NULL);
+     const rift_regex_automaton_t *automaton =
+         rule ? rift_regex_pattern_get_automaton(rule) : NULL;
+     bool determinizable = automaton && !rift_automaton_has_lookarounds(automaton);
+     bool asserting = false;
+     for (size_t i = 0; determinizable && i < automaton->num_states; i++) {
+         rift_state_flag_t flags = automaton->states[i]->flags;
+         determinizable = (flags & atomic) == 0 &&
+                          !((flags & anchors) && (entry->flags & RIFT_REGEX_FLAG_MULTILINE));
+         asserting = asserting || (flags & (anchors | boundaries)) != 0;
+     }
+     
+     if (rule) {
+         analysis->verdict = *rift_regex_pattern_get_ambiguity(rule);
+         analysis->has_verdict = true;
+         determinizable = determinizable && !analysis->verdict.has_backreference;
+         
+         rift_prefilter_t *prefilter =
+             rift_prefilter_create(rift_regex_pattern_get_ast(rule), NULL);
+         if (prefilter && rift_prefilter_analyze_automaton(prefilter, automaton, NULL)) {
+             analysis->prefilter = *prefilter;
+             analysis->has_prefilter = true;
+         }
+         rift_prefilter_free(prefilter);
+     }
+     
+     size_t max_states = RIFT_DSL_MAX_TABLE_STATES;
+     if (profiled && profiled->searches >= RIFT_DSL_PROFILE_MIN_SEARCHES) {
+         if (profiled->steps / profiled->searches >= RIFT_DSL_PROFILE_COSTLY_STEPS) {
+             max_states *= RIFT_DSL_PROFILE_TABLE_SCALE;
+         }
+         analysis->check_required =
+             analysis->has_prefilter && analysis->prefilter.num_required > 0 &&
+             profiled->matches * 100 < profiled->searches * RIFT_DSL_PROFILE_SELECTIVE_PERCENT;
+     }
+     
+     // A pattern whose DFA outgrows the budget still joins the union, which builds states lazily
+     if (determinizable && !asserting) {
+         rift_regex_automaton_t *dfa =
+             rift_automaton_nfa_to_dfa_limited(automaton, max_states, NULL);
+         rift_regex_automaton_t *minimal = dfa ? rift_hopcroft_minimize(dfa, NULL) : NULL;
+         analysis->table = minimal ? rift_dfa_table_compile(minimal, NULL) : NULL;
+         if (language && analysis->table) {
+             *language = rift_frozen_automaton_create(minimal, NULL);
+         }
+         rift_automaton_free(minimal);
+         rift_automaton_free(dfa);
+     }
+     
+     if (!determinizable) {
+         rift_regex_pattern_free(rule);
+         return NULL;
+     }
+     return rule;
+ }
+ 
+ /**
+  * @brief Compile patterns until none is left
+  * 
+  * Patterns after one that failed are skipped, since they would be dropped.
+  * While the job is open, the worker waits for more patterns.
+  * 
+  * @param arg The worker
+  * @return NULL
+  */
+ static void *
+ rift_dsl_compile_worker(void *arg)
+ {
+     rift_dsl_worker_t *worker = (rift_dsl_worker_t *)arg;
+     rift_dsl_job_t *job = worker->job;
+     
+     pthread_mutex_lock(&job->lock);
+     while (true) {
+         while (job->open && job->next >= job->count) {
+             pthread_cond_wait(&job->added, &job->lock);
+         }
+         size_t index = job->next;
+         if (index >= job->count || index > job->failed_index) {
+             break;
+         }
+         job->next++;
+         rift_dsl_job_entry_t entry = job->entries[index];
+         pthread_cond_signal(&job->taken);
+         pthread_mutex_unlock(&job->lock);
+         
+         rift_regex_error_t regex_error;
+         memset(&regex_error, 0, sizeof(regex_error));
+         uint64_t start = rift_dsl_clock_ns();
+         entry.program = rift_bytecode_compile_timed(entry.pattern, entry.flags, &worker->timings,
+                                                     &regex_error);
+         entry.compile_ns = rift_dsl_clock_ns() - start;
+         const rift_dsl_profile_entry_t *profiled = rift_dsl_profile_find(job->profile, entry.name);
+         entry.profile_matches = profiled ? profiled->matches : 0;
+         entry.rule = entry.program
+                          ? rift_dsl_compile_rule(&entry, profiled, &entry.analysis,
+                                                  job->keep_languages ? &entry.language : NULL)
+                          : NULL;
+         free(entry.pattern);
+         
+         pthread_mutex_lock(&job->lock);
+         job->entries[index].pattern = NULL;
+         job->entries[index].program = entry.program;
+         job->entries[index].rule = entry.rule;
+         job->entries[index].compile_ns = entry.compile_ns;
+         job->entries[index].analysis = entry.analysis;
+         job->entries[index].profile_matches = entry.profile_matches;
+         job->entries[index].language = entry.language;
+         
+         // Only the first failure in source order is reported
+         if (!entry.program && index < job->failed_index) {
+             job->failed_index = index;
+             snprintf(job->error_message, sizeof(job->error_message),
+                     "Failed to compile pattern '%s': %s",
+                     entry.name,
+                     rift_regex_error_message(&regex_error)[0] ? regex_error.message
+                                                               : "Unknown error");
+             pthread_cond_broadcast(&job->taken);
+         }
+     }
+     pthread_mutex_unlock(&job->lock);
+     
+     return NULL;
+ }
+ 
+ /**
+  * @brief Copy a string into memory owned by a job
+  * 
+  * @param string The string
+  * @return The copy or NULL on allocation failure
+  */
+ static char *
+ rift_dsl_copy_string(const char *string)
+ {
+     size_t length = strlen(string);
+     char *copy = (char *)malloc(length + 1);
+     if (copy) {
+         memcpy(copy, string, length + 1);
+     }
+     return copy;
+ }
+ 
+ /**
+  * @brief Initialize a job with no patterns
+  * 
+  * @param job The job
+  * @param open Whether patterns may arrive once the threads run
+  * @return true if successful, false otherwise
+  */
+ static bool
+ rift_dsl_job_init(rift_dsl_job_t *job, bool open)
+ {
+     memset(job, 0, sizeof(*job));
+     job->failed_index = SIZE_MAX;
+     job->open = open;
+     if (pthread_mutex_init(&job->lock, NULL) != 0) {
+         return false;
+     }
+     if (pthread_cond_init(&job->added, NULL) != 0) {
+         pthread_mutex_destroy(&job->lock);
+         return false;
+     }
+     if (pthread_cond_init(&job->taken, NULL) != 0) {
+         pthread_cond_destroy(&job->added);
+         pthread_mutex_destroy(&job->lock);
+         return false;
+     }
+     return true;
+ }
+ 
+ /**
+  * @brief Free a job and whatever its entries still own
+  * 
+  * @param job The job, whose threads have ended
+  */
+ static void
+ rift_dsl_job_destroy(rift_dsl_job_t *job)
+ {
+     for (size_t i = 0; i < job->count; i++) {
+         free(job->entries[i].name);
+         free(job->entries[i].pattern);
+         rift_bytecode_program_free(job->entries[i].program);
+         rift_regex_pattern_free(job->entries[i].rule);
+         rift_dfa_table_free(job->entries[i].analysis.table);
+         rift_frozen_automaton_free(job->entries[i].language);
+     }
+     free(job->entries);
+     pthread_cond_destroy(&job->taken);
+     pthread_cond_destroy(&job->added);
+     pthread_mutex_destroy(&job->lock);
+ }
+ 
+ /**
+  * @brief Queue a pattern for the compiling threads
+  * 
+  * Patterns after one that failed would be dropped, so they are not queued.
+  * With a pending limit the caller waits for the threads to catch up, which
+  * bounds the memory taken by a streamed source.
+  * 
+  * @param job The job
+  * @param name Name of the pattern
+  * @param pattern Pattern string
+  * @param flags Flags of the pattern
+  * @return true if the pattern was queued or dropped, false on allocation failure
+  */
+ static bool
+ rift_dsl_job_add(rift_dsl_job_t *job, const char *name, const char *pattern,
+                  rift_regex_flags_t flags)
+ {
+     char *name_copy = rift_dsl_copy_string(name ? name : "");
+     char *pattern_copy = pattern ? rift_dsl_copy_string(pattern) : NULL;
+     if (!name_copy || !pattern_copy) {
+         free(name_copy);
+         free(pattern_copy);
+         return false;
+     }
      
-     return result;
+     pthread_mutex_lock(&job->lock);
+     while (job->max_pending > 0 && job->count - job->next >= job->max_pending &&
+            job->failed_index == SIZE_MAX) {
+         pthread_cond_wait(&job->taken, &job->lock);
+     }
+     
+     if (job->failed_index != SIZE_MAX) {
+         pthread_mutex_unlock(&job->lock);
+         free(name_copy);
+         free(pattern_copy);
+         return true;
+     }
+     
+     if (job->count == job->capacity) {
+         size_t capacity = job->capacity > 0 ? job->capacity * 2 : 16;
+         rift_dsl_job_entry_t *entries = (rift_dsl_job_entry_t *)realloc(
+             job->entries, capacity * sizeof(rift_dsl_job_entry_t));
+         if (!entries) {
+             pthread_mutex_unlock(&job->lock);
+             free(name_copy);
+             free(pattern_copy);
+             return false;
+         }
+         job->entries = entries;
+         job->capacity = capacity;
+     }
+     
+     rift_dsl_job_entry_t *entry = &job->entries[job->count++];
+     memset(entry, 0, sizeof(*entry));
+     entry->name = name_copy;
+     entry->pattern = pattern_copy;
+     entry->flags = flags;
+     pthread_cond_signal(&job->added);
+     pthread_mutex_unlock(&job->lock);
+     return true;
  }
  
  /**
-  * @brief Free resources associated with a compilation structure
+  * @brief Queue a pattern handed over by the stream parser
   * 
-  * @param compilation The compilation structure to free
+  * @param name Name of the pattern
+  * @param pattern Pattern string
+  * @param flags Names of the flags of the pattern
+  * @param flag_count Number of flags
+  * @param user_data The job
+  * @return true to go on parsing, false on allocation failure
+  */
+ static bool
+ rift_dsl_job_stream_pattern(const char *name, const char *pattern, char *const *flags,
+                             size_t flag_count, void *user_data)
+ {
+     rift_regex_flags_t numeric_flags = 0;
+     for (size_t i = 0; i < flag_count; i++) {
+         numeric_flags |= rift_dsl_flag_to_numeric(flags[i]);
+     }
+     return rift_dsl_job_add((rift_dsl_job_t *)user_data, name, pattern, numeric_flags);
+ }
+ 
+ /**
+  * @brief Compile the patterns of a job on several threads
+  * 
+  * Given a file, the caller parses it as a stream while the other threads
+  * compile what it has queued so far, then compiles alongside them.
+  * 
+  * @param job The job
+  * @param num_threads Threads including the caller's
+  * @param filename File to parse as a stream, NULL if the job is already filled
+  * @param stats Timings to fill
+  * @return The handle of the parsed file, NULL without a file or if it cannot be read
+  */
+ static void *
+ rift_dsl_job_run(rift_dsl_job_t *job, size_t num_threads, const char *filename,
+                  rift_dsl_compile_stats_t *stats)
+ {
+     rift_dsl_worker_t *workers =
+         (rift_dsl_worker_t *)calloc(num_threads, sizeof(rift_dsl_worker_t));
+     if (!workers) {
+         num_threads = 1;
+     }
+     rift_dsl_worker_t caller_worker;
+     memset(&caller_worker, 0, sizeof(caller_worker));
+     rift_dsl_worker_t *first = workers ? &workers[0] : &caller_worker;
+     
+     uint64_t compile_start = rift_dsl_clock_ns();
+     first->job = job;
+     size_t num_started = 0;
+     for (size_t t = 1; t < num_threads; t++) {
+         workers[t].job = job;
+         workers[t].started =
+             pthread_create(&workers[t].thread, NULL, rift_dsl_compile_worker, &workers[t]) == 0;
+         num_started += workers[t].started;
+     }
+     
+     void *dsl_handle = NULL;
+     if (filename) {
+         // Without other threads nothing would take the patterns, so none are held back
+         pthread_mutex_lock(&job->lock);
+         job->max_pending = num_started * RIFT_DSL_PENDING_PER_THREAD;
+         pthread_mutex_unlock(&job->lock);
+         
+         uint64_t parse_start = rift_dsl_clock_ns();
+         dsl_handle = rift_dsl_load_file_stream(filename, rift_dsl_job_stream_pattern, job);
+         stats->parse_ns = rift_dsl_clock_ns() - parse_start;
+         
+         // Every pattern is dropped on a parse error, so the threads may stop
+         if (!dsl_handle || rift_dsl_get_error_message(dsl_handle)) {
+             pthread_mutex_lock(&job->lock);
+             job->failed_index = 0;
+             pthread_mutex_unlock(&job->lock);
+         }
+     }
+     
+     pthread_mutex_lock(&job->lock);
+     job->open = false;
+     pthread_cond_broadcast(&job->added);
+     pthread_mutex_unlock(&job->lock);
+     rift_dsl_compile_worker(first);
+     
+     stats->num_threads = 1;
+     stats->pattern_ns += first->timings.pattern_ns;
+     stats->counters_ns += first->timings.counters_ns;
+     stats->codegen_ns += first->timings.codegen_ns;
+     for (size_t t = 1; t < num_threads; t++) {
+         if (workers[t].started) {
+             pthread_join(workers[t].thread, NULL);
+             stats->num_threads++;
+             stats->pattern_ns += workers[t].timings.pattern_ns;
+             stats->counters_ns += workers[t].timings.counters_ns;
+             stats->codegen_ns += workers[t].timings.codegen_ns;
+         }
+     }
+     stats->compile_ns = rift_dsl_clock_ns() - compile_start;
+     free(workers);
+     return dsl_handle;
+ }
+ 
+ /**
+  * @brief Find the rules another rule covers, and prune them if asked
+  * 
+  * A rule is redundant when another rule accepts every string it accepts
+  * and either accepts more or comes first. Strict inclusion orders the
+  * rules and only the first of the rules accepting the same strings is
+  * kept, so every redundant rule is covered by a kept rule, which is the
+  * one reported. Rules are only pruned when every pattern compiled, as a
+  * failed compilation keeps no program anyway.
+  * 
+  * @param job The job, whose threads have ended
+  * @param options Options of the compilation
+  * @param stats Timings to fill
   */
  static void
- rift_dsl_compilation_free(rift_dsl_compilation_t *compilation)
+ rift_dsl_job_lint(rift_dsl_job_t *job, const rift_dsl_compile_options_t *options,
+                   rift_dsl_compile_stats_t *stats)
  {
-     if (!compilation) {
+     size_t count = job->count < job->failed_index ? job->count : job->failed_index;
+     bool *redundant = (bool *)calloc(count > 0 ? count : 1, sizeof(bool));
+     if (!job->keep_languages || !redundant) {
+         free(redundant);
          return;
      }
      
-     // Free all compiled programs
-     for (size_t i = 0; i < compilation->count; i++) {
-         rift_bytecode_program_free(compilation->programs[i]);
+     size_t num_compared = 0;
+     size_t num_redundant = 0;
+     for (size_t i = 0; i < count; i++) {
+         const rift_frozen_automaton_t *language = job->entries[i].language;
+         if (!language) {
+             continue;
+         }
+         num_compared++;
+         for (size_t j = 0; j < count && !redundant[i]; j++) {
+             const rift_frozen_automaton_t *other = job->entries[j].language;
+             if (j != i && other && rift_automaton_is_subset(language, other, NULL) == 1) {
+                 redundant[i] = j < i || rift_automaton_is_subset(other, language, NULL) == 0;
+             }
+         }
+         num_redundant += redundant[i];
      }
      
-     free(compilation->programs);
-     free(compilation);
+     rift_dsl_lint_t *lint = options->lint;
+     if (lint) {
+         lint->num_compared = num_compared;
+         lint->redundancies = num_redundant > 0 ? (rift_dsl_redundancy_t *)calloc(
+                                                      num_redundant, sizeof(rift_dsl_redundancy_t))
+                                                : NULL;
+     }
+     for (size_t i = 0; lint && lint->redundancies && i < count; i++) {
+         if (!redundant[i]) {
+             continue;
+         }
+         
+         // Only a comparison failing for want of memory can leave no kept rule found
+         size_t j = 0;
+         while (j < count &&
+                (j == i || redundant[j] || !job->entries[j].language ||
+                 rift_automaton_is_subset(job->entries[i].language, job->entries[j].language,
+                                          NULL) != 1)) {
+             j++;
+         }
+         if (j == count) {
+             continue;
+         }
+         rift_dsl_redundancy_t *redundancy = &lint->redundancies[lint->count];
+         redundancy->index = i;
+         redundancy->covered_by = j;
+         redundancy->name = rift_dsl_copy_string(job->entries[i].name);
+         redundancy->covered_by_name = rift_dsl_copy_string(job->entries[j].name);
+         redundancy->duplicate = rift_automaton_is_equivalent(job->entries[i].language,
+                                                              job->entries[j].language, NULL) == 1;
+         lint->count++;
+     }
+     
+     if (options->prune_redundant && job->failed_index == SIZE_MAX) {
+         size_t kept = 0;
+         for (size_t i = 0; i < job->count; i++) {
+             rift_dsl_job_entry_t *entry = &job->entries[i];
+             if (!redundant[i]) {
+                 job->entries[kept++] = *entry;
+                 continue;
+             }
+             free(entry->name);
+             rift_bytecode_program_free(entry->program);
+             rift_regex_pattern_free(entry->rule);
+             rift_dfa_table_free(entry->analysis.table);
+             rift_frozen_automaton_free(entry->language);
+         }
+         job->count = kept;
+         stats->num_pruned = num_redundant;
+     }
+     free(redundant);
  }
  
  /**
-  * @brief Add a program to the compilation
+  * @brief Order two patterns by the matches a profile recorded, most first
   * 
-  * @param compilation The compilation structure
-  * @param program The bytecode program to add
-  * @return true if successful, false otherwise
+  * @param a The first pattern
+  * @param b The second pattern
+  * @return Negative, zero or positive as for qsort
   */
- static bool
- rift_dsl_compilation_add_program(rift_dsl_compilation_t *compilation, 
-                                  rift_bytecode_program_t *program)
+ static int
+ rift_dsl_compare_profiled(const void *a, const void *b)
  {
-     if (!compilation || !program) {
-         return false;
+     const rift_dsl_job_entry_t *const *left = (const rift_dsl_job_entry_t *const *)a;
+     const rift_dsl_job_entry_t *const *right = (const rift_dsl_job_entry_t *const *)b;
+     if ((*left)->profile_matches != (*right)->profile_matches) {
+         return (*left)->profile_matches > (*right)->profile_matches ? -1 : 1;
+     }
+     return *left < *right ? -1 : (*left > *right ? 1 : 0);
+ }
+ 
+ /**
+  * @brief Get the order rules are placed into shards in
+  * 
+  * @param entries The patterns of the programs
+  * @param count Number of patterns
+  * @return Pattern indices, most matched first and in source order otherwise,
+  *         or NULL on allocation failure
+  */
+ static size_t *
+ rift_dsl_rule_order(const rift_dsl_job_entry_t *entries, size_t count)
+ {
+     const rift_dsl_job_entry_t **sorted =
+         (const rift_dsl_job_entry_t **)malloc(count * sizeof(rift_dsl_job_entry_t *));
+     size_t *order = (size_t *)malloc(count * sizeof(size_t));
+     if (!sorted || !order) {
+         free(sorted);
+         free(order);
+         return NULL;
      }
      
-     // Check if we need to grow the array
-     if (compilation->count >= compilation->capacity) {
-         size_t new_capacity = compilation->capacity * 2;
-         rift_bytecode_program_t **new_programs = (rift_bytecode_program_t **)realloc(
-             compilation->programs, new_capacity * sizeof(rift_bytecode_program_t *));
+     for (size_t i = 0; i < count; i++) {
+         sorted[i] = &entries[i];
+     }
+     qsort(sorted, count, sizeof(sorted[0]), rift_dsl_compare_profiled);
+     for (size_t i = 0; i < count; i++) {
+         order[i] = (size_t)(sorted[i] - entries);
+     }
+     free(sorted);
+     return order;
+ }
+ 
+ /**
+  * @brief Put the rules a DFA can run into shards of union automata
+  * 
+  * A rule is estimated to need as many union states as its minimized DFA
+  * has, or RIFT_DSL_MAX_TABLE_STATES when it had no table, which holds as
+  * long as the states of the rules do not combine. Rules go to the first
+  * shard whose estimate stays within the budget, and a rule over the budget
+  * on its own gets a shard to itself. With a profile, the rules that matched
+  * most are placed first, so they share the first shards. Programs left out,
+  * or those of a shard whose union cannot be built, run on the VM in
+  * rift_dsl_execute_all.
+  * 
+  * @param compilation The compilation, holding its programs and their analyses
+  * @param entries The patterns of the programs, in the same order
+  * @param shard_states Estimated DFA states per shard, 0 for the default
+  */
+ static void
+ rift_dsl_compilation_build_rules(rift_dsl_compilation_t *compilation,
+                                  const rift_dsl_job_entry_t *entries, size_t shard_states)
+ {
+     if (compilation->count == 0) {
+         return;
+     }
+     if (shard_states == 0) {
+         shard_states = RIFT_DSL_DEFAULT_SHARD_STATES;
+     }
+     
+     compilation->rule_ids = (uint32_t *)malloc(compilation->count * sizeof(uint32_t));
+     compilation->rule_shards = (uint32_t *)malloc(compilation->count * sizeof(uint32_t));
+     compilation->shards =
+         (rift_dsl_shard_t *)calloc(compilation->count, sizeof(rift_dsl_shard_t));
+     if (!compilation->rule_ids || !compilation->rule_shards || !compilation->shards) {
+         free(compilation->rule_ids);
+         free(compilation->rule_shards);
+         free(compilation->shards);
+         compilation->rule_ids = NULL;
+         compilation->rule_shards = NULL;
+         compilation->shards = NULL;
+         return;
+     }
+     
+     // Without memory for the order the rules are placed in source order
+     size_t *order = rift_dsl_rule_order(entries, compilation->count);
+     for (size_t i = 0; i < compilation->count; i++) {
+         compilation->rule_ids[i] = RIFT_DSL_NO_RULE;
+         compilation->rule_shards[i] = RIFT_DSL_NO_RULE;
+     }
+     for (size_t n = 0; n < compilation->count; n++) {
+         size_t i = order ? order[n] : n;
+         if (!entries[i].rule) {
+             continue;
+         }
          
-         if (!new_programs) {
-             return false;
+         const rift_dfa_table_t *table =
+             compilation->analyses ? compilation->analyses[i].table : NULL;
+         size_t estimate = table ? table->num_states : RIFT_DSL_MAX_TABLE_STATES;
+         size_t s = 0;
+         while (s < compilation->num_shards &&
+                compilation->shards[s].estimated_states + estimate > shard_states) {
+             s++;
+         }
+         rift_dsl_shard_t *shard = &compilation->shards[s];
+         if (s == compilation->num_shards) {
+             shard->rules = rift_pattern_set_create(0);
+             if (!shard->rules) {
+                 continue;
+             }
+             compilation->num_shards++;
          }
          
-         compilation->programs = new_programs;
-         compilation->capacity = new_capacity;
+         if (rift_pattern_set_add_automaton(shard->rules,
+                                            rift_regex_pattern_get_automaton(entries[i].rule),
+                                            &compilation->rule_ids[i], NULL)) {
+             compilation->rule_shards[i] = (uint32_t)s;
+             shard->estimated_states += estimate;
+         }
      }
+     free(order);
      
-     // Add the program
-     compilation->programs[compilation->count++] = program;
-     
-     return true;
+     // A shard whose union cannot be built leaves its rules to the VM
+     for (size_t s = 0; s < compilation->num_shards; s++) {
+         rift_dsl_shard_t *shard = &compilation->shards[s];
+         if (rift_pattern_set_get_count(shard->rules) > 0 &&
+             rift_pattern_set_compile(shard->rules, NULL)) {
+             continue;
+         }
+         for (size_t i = 0; i < compilation->count; i++) {
+             if (compilation->rule_shards[i] == s) {
+                 compilation->rule_shards[i] = RIFT_DSL_NO_RULE;
+             }
+         }
+         rift_pattern_set_free(shard->rules);
+         shard->rules = NULL;
+     }
  }
  
  /**
-  * @brief Convert flag string to numeric flags
+  * @brief Move the programs of a finished job into a compilation
   * 
-  * @param flag_name The flag name
-  * @return The numeric flag value or 0 if unknown
+  * The programs keep source order up to the first pattern that failed.
+  * 
+  * @param job The job, whose threads have ended
+  * @param read_error Error met while queuing the patterns, empty if none
+  * @param shard_states Estimated DFA states per rule shard, 0 for the default
+  * @param stats Timings to fill
+  * @return Compilation result structure or NULL on error
   */
- static rift_regex_flags_t
- rift_dsl_flag_to_numeric(const char *flag_name)
+ static rift_dsl_compilation_t *
+ rift_dsl_job_collect(rift_dsl_job_t *job, const char *read_error, size_t shard_states,
+                      rift_dsl_compile_stats_t *stats)
  {
-     if (!flag_name) {
-         return 0;
+     rift_dsl_compilation_t *compilation =
+         rift_dsl_compilation_create(job->count > 0 ? job->count : 1);
+     if (!compilation) {
+         return NULL;
      }
      
-     // Define mappings from flag names to numeric values
-     struct {
-         const char *name;
-         rift_regex_flags_t value;
-     } flag_mappings[] = {
-         { "CASE_INSENSITIVE", 0x00000001 },
-         { "MULTILINE", 0x00000002 },
-         { "DOTALL", 0x00000004 },
-         { "EXTENDED", 0x00000008 },
-         { "OPTIMIZE", 0x00000010 },
-         { "UTF8", 0x00000020 },
-         { "JIT", 0x00000040 },
-         { NULL, 0 }
-     };
+     for (size_t i = 0; i < job->count && i < job->failed_index && !compilation->has_error;
+          i++) {
+         if (rift_dsl_compilation_add_program(compilation, job->entries[i].program)) {
+             job->entries[i].program = NULL;
+         } else {
+             char message[128];
+             snprintf(message, sizeof(message), 
+                     "Failed to store compiled pattern '%s'", job->entries[i].name);
+             rift_dsl_compilation_error(compilation, message);
+         }
+     }
+     stats->num_patterns = compilation->count;
      
-     // Look up the flag
-     for (int i = 0; flag_mappings[i].name != NULL; i++) {
-         if (strcmp(flag_name, flag_mappings[i].name) == 0) {
-             return flag_mappings[i].value;
+     compilation->compile_ns = (uint64_t *)malloc(compilation->capacity * sizeof(uint64_t));
+     for (size_t i = 0; compilation->compile_ns && i < compilation->count; i++) {
+         compilation->compile_ns[i] = job->entries[i].compile_ns;
+     }
+     
+     compilation->analyses =
+         (rift_dsl_analysis_t *)malloc(compilation->capacity * sizeof(rift_dsl_analysis_t));
+     for (size_t i = 0; compilation->analyses && i < compilation->count; i++) {
+         compilation->analyses[i] = job->entries[i].analysis;
+         job->entries[i].analysis.table = NULL;
+     }
+     
+     compilation->names = (char **)malloc(compilation->capacity * sizeof(char *));
+     for (size_t i = 0; compilation->names && i < compilation->count; i++) {
+         compilation->names[i] = job->entries[i].name;
+         job->entries[i].name = NULL;
+     }
+     
+     rift_dsl_compilation_build_rules(compilation, job->entries, shard_states);
+     stats->num_shards = rift_dsl_get_shard_count(compilation);
+     
+     if (!compilation->has_error && job->failed_index < job->count) {
+         rift_dsl_compilation_error(compilation, job->error_message);
+     } else if (!compilation->has_error && read_error[0]) {
+         rift_dsl_compilation_error(compilation, read_error);
+     }
+     return compilation;
+ }
+ 
+ /**
+  * @brief Resolve a rule name of a combination to its program
+  * 
+  * @param name The name, not null-terminated
+  * @param length Length of the name
+  * @param rule Pointer to store the index of the program
+  * @param user_data The compilation
+  * @return true if a program has the name, false otherwise
+  */
+ static bool
+ rift_dsl_resolve_rule(const char *name, size_t length, uint32_t *rule, void *user_data)
+ {
+     const rift_dsl_compilation_t *compilation = (const rift_dsl_compilation_t *)user_data;
+     for (size_t i = 0; compilation->names && i < compilation->count; i++) {
+         if (strncmp(compilation->names[i], name, length) == 0 &&
+             compilation->names[i][length] == '\0') {
+             *rule = (uint32_t)i;
+             return true;
          }
      }
+     return false;
+ }
+ 
+ /**
+  * @brief Compile the rule combinations of a DSL file against the programs
+  * 
+  * Combinations name the programs of the compilation, so a rule pruned as
+  * redundant or after a failed pattern cannot be named. The first
+  * combination that does not compile sets the error of the compilation.
+  * 
+  * @param compilation The compilation, holding the programs and their names
+  * @param dsl_handle The DSL file handle
+  */
+ static void
+ rift_dsl_compilation_add_combinations(rift_dsl_compilation_t *compilation, void *dsl_handle)
+ {
+     size_t count = rift_dsl_get_combination_count(dsl_handle);
+     if (count == 0 || compilation->has_error) {
+         return;
+     }
      
-     return 0;
+     compilation->formulas = (rift_dsl_formula_t *)calloc(count, sizeof(rift_dsl_formula_t));
+     compilation->formula_names = (char **)calloc(count, sizeof(char *));
+     if (!compilation->formulas || !compilation->formula_names) {
+         rift_dsl_compilation_error(compilation, "Failed to allocate rule combinations");
+         return;
+     }
+     
+     for (size_t i = 0; i < count; i++) {
+         const char *name;
+         const char *expression;
+         char reason[128];
+         if (!rift_dsl_get_combination(dsl_handle, i, &name, &expression)) {
+             rift_dsl_compilation_error(compilation, "Failed to get rule combination");
+             return;
+         }
+         if (!rift_dsl_formula_compile(&compilation->formulas[i], expression,
+                                       rift_dsl_resolve_rule, compilation, reason,
+                                       sizeof(reason))) {
+             char message[256];
+             snprintf(message, sizeof(message), "Combination '%s': %s", name, reason);
+             rift_dsl_compilation_error(compilation, message);
+             return;
+         }
+         compilation->formula_names[i] = rift_dsl_copy_string(name);
+         compilation->num_formulas++;
+         if (!compilation->formula_names[i]) {
+             rift_dsl_compilation_error(compilation, "Failed to allocate rule combinations");
+             return;
+         }
+     }
+ }
+ 
+ /**
+  * @brief Create a compilation holding only an error
+  * 
+  * @param message The error message
+  * @return Compilation result structure or NULL on error
+  */
+ static rift_dsl_compilation_t *
+ rift_dsl_compilation_create_error(const char *message)
+ {
+     rift_dsl_compilation_t *compilation = rift_dsl_compilation_create(1);
+     if (compilation) {
+         rift_dsl_compilation_error(compilation, message);
+     }
+     return compilation;
  }
  
  /**
   * @brief Compile patterns from a DSL file
   * 
   * @param dsl_handle The DSL file handle from rift_dsl_parse
+  * @param options Options of the compilation
+  * @param stats Timings to fill
   * @return Compilation result structure or NULL on error
   */
  static rift_dsl_compilation_t *
- rift_dsl_compile_patterns(void *dsl_handle)
+ rift_dsl_compile_patterns(void *dsl_handle, const rift_dsl_compile_options_t *options,
+                           rift_dsl_compile_stats_t *stats)
  {
      if (!dsl_handle) {
          return NULL;
@@ -508,51 +2578,42 @@
      // Check if there was a parsing error
      const char *error_message = rift_dsl_get_error_message(dsl_handle);
      if (error_message) {
-         // Create a compilation with the error
-         rift_dsl_compilation_t *compilation = rift_dsl_compilation_create(1);
-         if (!compilation) {
-             return NULL;
-         }
-         
-         rift_dsl_compilation_error(compilation, error_message);
-         return compilation;
+         return rift_dsl_compilation_create_error(error_message);
      }
      
      // Get the number of patterns
      size_t pattern_count = rift_dsl_get_pattern_count(dsl_handle);
      if (pattern_count == 0) {
-         // Create an empty compilation
-         return rift_dsl_compilation_create(1);
+         // Create an empty compilation, where any combination names an unknown rule
+         rift_dsl_compilation_t *compilation = rift_dsl_compilation_create(1);
+         if (compilation) {
+             rift_dsl_compilation_add_combinations(compilation, dsl_handle);
+         }
+         return compilation;
      }
      
-     // Create a compilation with enough capacity for all patterns
-     rift_dsl_compilation_t *compilation = rift_dsl_compilation_create(pattern_count);
-     if (!compilation) {
+     rift_dsl_job_t job;
+     if (!rift_dsl_job_init(&job, false)) {
          return NULL;
      }
+     job.profile = options->profile;
+     job.keep_languages = options->lint || options->prune_redundant;
      
-     // Initialize the regex error structure
-     rift_regex_error_t regex_error;
-     memset(&regex_error, 0, sizeof(regex_error));
-     
-     // Compile each pattern
+     // Read the patterns and flags first, the parser's handle stays on this thread
+     char read_error[128] = "";
      for (size_t i = 0; i < pattern_count; i++) {
+         // Get pattern and name
          const char *name;
          const char *pattern;
-         
-         // Get pattern and name
          if (!rift_dsl_get_pattern(dsl_handle, i, &name, &pattern)) {
-             char message[128];
-             snprintf(message, sizeof(message), "Failed to get pattern at index %zu", i);
-             rift_dsl_compilation_error(compilation, message);
-             return compilation;
+             snprintf(read_error, sizeof(read_error), "Failed to get pattern at index %zu", i);
+             break;
          }
          
          // Get flags
+         rift_regex_flags_t numeric_flags = 0;
          const char **flags;
          size_t flag_count;
-         rift_regex_flags_t numeric_flags = 0;
-         
          if (rift_dsl_get_pattern_flags(dsl_handle, i, &flags, &flag_count)) {
              // Convert string flags to numeric values
              for (size_t j = 0; j < flag_count; j++) {
@@ -560,29 +2621,73 @@
              }
          }
          
-         // Compile the pattern to bytecode
-         rift_bytecode_program_t *program = 
-             rift_bytecode_compile(pattern, numeric_flags, &regex_error);
-         
-         if (!program) {
-             char message[256];
-             snprintf(message, sizeof(message), 
-                     "Failed to compile pattern '%s': %s", 
-                     name, regex_error.message[0] ? regex_error.message : "Unknown error");
-             rift_dsl_compilation_error(compilation, message);
-             return compilation;
+         if (!rift_dsl_job_add(&job, name, pattern, numeric_flags)) {
+             rift_dsl_job_destroy(&job);
+             return NULL;
          }
-         
-         // Add the program to the compilation
-         if (!rift_dsl_compilation_add_program(compilation, program)) {
-             char message[128];
-             snprintf(message, sizeof(message), 
-                     "Failed to store compiled pattern '%s'", name);
-             rift_dsl_compilation_error(compilation, message);
-             rift_bytecode_program_free(program);
-             return compilation;
+     }
+     
+     // No more threads than patterns; the caller is the first
+     size_t num_threads = options->num_threads;
+     if (num_threads == 0) {
+         long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+         num_threads = cpus > 0 ? (size_t)cpus : 1;
+     }
+     if (num_threads > job.count) {
+         num_threads = job.count > 0 ? job.count : 1;
+     }
+     rift_dsl_job_run(&job, num_threads, NULL, stats);
+     rift_dsl_job_lint(&job, options, stats);
+     
+     rift_dsl_compilation_t *compilation =
+         rift_dsl_job_collect(&job, read_error, options->shard_states, stats);
+     if (compilation) {
+         rift_dsl_compilation_add_combinations(compilation, dsl_handle);
+     }
+     rift_dsl_job_destroy(&job);
+     return compilation;
+ }
+ 
+ /**
+  * @brief Compile the patterns of a DSL file while parsing it as a stream
+  * 
+  * @param filename The DSL file
+  * @param options Options of the compilation
+  * @param stats Timings to fill
+  * @return Compilation result structure or NULL on error
+  */
+ static rift_dsl_compilation_t *
+ rift_dsl_compile_stream(const char *filename, const rift_dsl_compile_options_t *options,
+                         rift_dsl_compile_stats_t *stats)
+ {
+     rift_dsl_job_t job;
+     if (!rift_dsl_job_init(&job, true)) {
+         return NULL;
+     }
+     job.profile = options->profile;
+     job.keep_languages = options->lint || options->prune_redundant;
+     
+     size_t num_threads = options->num_threads;
+     if (num_threads == 0) {
+         long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+         num_threads = cpus > 0 ? (size_t)cpus : 1;
+     }
+     void *dsl_handle = rift_dsl_job_run(&job, num_threads, filename, stats);
+     rift_dsl_job_lint(&job, options, stats);
+     
+     // A parse error drops the patterns compiled so far, as when parsing first
+     rift_dsl_compilation_t *compilation = NULL;
+     if (dsl_handle) {
+         const char *error_message = rift_dsl_get_error_message(dsl_handle);
+         compilation = error_message ? rift_dsl_compilation_create_error(error_message)
+                                     : rift_dsl_job_collect(&job, "", options->shard_states,
+                                                            stats);
+         if (compilation && !error_message) {
+             rift_dsl_compilation_add_combinations(compilation, dsl_handle);
          }
+         rift_dsl_free(dsl_handle);
      }
      
+     rift_dsl_job_destroy(&job);
      return compilation;
  }
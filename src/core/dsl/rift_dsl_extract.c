@@ -0,0 +1,283 @@
+/**
+ * @file rift_dsl_extract.c
+ * @brief Implementation of two-phase capture extraction for .rift rules
+ *
+ * The plan holds a regex pattern per rule with groups. An extractor first
+ * collects the matching rules with rift_dsl_execute_all, then runs the
+ * rule's matcher, anchored at the start, over the input up to the end of
+ * the longest prefix the rule's DFA table accepts, or over the whole input
+ * for a rule without a table.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/dsl/rift_dsl_extract.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/automaton/dfa_table.h"
+#include "core/dsl/rift_dsl_compiler.h"
+#include "core/engine/pattern.h"
+#include "core/runtime/matcher.h"
+
+/**
+ * @brief How the groups of one rule are extracted
+ */
+typedef struct extract_rule {
+    rift_regex_pattern_t *pattern; /**< Capture pattern, NULL to leave the rule to the VM */
+    const rift_dfa_table_t *table; /**< Table bounding the match end, NULL for none */
+    size_t num_spans;              /**< Spans reported: the match and each group */
+} extract_rule_t;
+
+struct rift_dsl_extract_plan {
+    void *compilation;     /**< The compilation, not owned */
+    extract_rule_t *rules; /**< Extraction of each rule */
+    size_t num_rules;      /**< Number of rules */
+    size_t max_spans;      /**< Most spans of any rule */
+    size_t num_captured;   /**< Rules with a capture pattern */
+};
+
+struct rift_dsl_extractor {
+    const rift_dsl_extract_plan_t *plan; /**< The plan */
+    rift_regex_matcher_t **matchers;     /**< Matcher of each rule, created on its first match */
+    size_t *hits;                        /**< Rules the current input matches */
+    size_t num_hits;                     /**< Number of rules in hits */
+    rift_regex_span_t *spans;            /**< Spans of the rule being reported */
+};
+
+/**
+ * @brief Set the error of a failed allocation
+ *
+ * @param error Pointer to store error information (can be NULL)
+ */
+static void
+set_memory_error(rift_regex_error_t *error)
+{
+    if (error) {
+        error->code = RIFT_REGEX_ERROR_MEMORY;
+        snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                 "Failed to allocate the extraction plan");
+    }
+}
+
+rift_dsl_extract_plan_t *
+rift_dsl_extract_plan_create(void *compilation, rift_regex_error_t *error)
+{
+    if (!compilation || rift_dsl_get_compilation_error(compilation)) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Invalid or failed compilation");
+        }
+        return NULL;
+    }
+
+    rift_dsl_extract_plan_t *plan =
+        (rift_dsl_extract_plan_t *)calloc(1, sizeof(rift_dsl_extract_plan_t));
+    if (!plan) {
+        set_memory_error(error);
+        return NULL;
+    }
+    plan->compilation = compilation;
+    plan->num_rules = rift_dsl_get_compiled_count(compilation);
+    plan->max_spans = 1;
+    plan->rules = (extract_rule_t *)calloc(plan->num_rules ? plan->num_rules : 1,
+                                           sizeof(extract_rule_t));
+    if (!plan->rules) {
+        set_memory_error(error);
+        free(plan);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < plan->num_rules; i++) {
+        extract_rule_t *rule = &plan->rules[i];
+        const rift_bytecode_program_t *program = rift_dsl_get_compiled_program(compilation, i);
+        rule->table = rift_dsl_get_dfa_table(compilation, i);
+        rule->num_spans = 1;
+
+        // Rules without groups need no pattern, since the VM reports their span
+        if (!program || program->group_count == 0 || !program->original_pattern) {
+            continue;
+        }
+        rule->pattern = rift_regex_compile(program->original_pattern, program->flags, NULL);
+        if (!rule->pattern) {
+            continue;
+        }
+        rule->num_spans = 1 + rift_regex_pattern_get_group_count(rule->pattern);
+        if (rule->num_spans > plan->max_spans) {
+            plan->max_spans = rule->num_spans;
+        }
+        plan->num_captured++;
+    }
+
+    return plan;
+}
+
+void
+rift_dsl_extract_plan_free(rift_dsl_extract_plan_t *plan)
+{
+    if (!plan) {
+        return;
+    }
+    for (size_t i = 0; i < plan->num_rules; i++) {
+        rift_regex_pattern_free(plan->rules[i].pattern);
+    }
+    free(plan->rules);
+    free(plan);
+}
+
+size_t
+rift_dsl_extract_plan_span_count(const rift_dsl_extract_plan_t *plan, size_t rule)
+{
+    if (!plan || rule >= plan->num_rules) {
+        return 0;
+    }
+    return plan->rules[rule].num_spans;
+}
+
+size_t
+rift_dsl_extract_plan_group_index(const rift_dsl_extract_plan_t *plan, size_t rule,
+                                  const char *name)
+{
+    if (!plan || rule >= plan->num_rules || !plan->rules[rule].pattern || !name) {
+        return RIFT_GROUP_NO_INDEX;
+    }
+    return rift_regex_pattern_group_index(plan->rules[rule].pattern, name);
+}
+
+size_t
+rift_dsl_extract_plan_capture_count(const rift_dsl_extract_plan_t *plan)
+{
+    return plan ? plan->num_captured : 0;
+}
+
+rift_dsl_extractor_t *
+rift_dsl_extractor_create(const rift_dsl_extract_plan_t *plan)
+{
+    if (!plan) {
+        return NULL;
+    }
+
+    rift_dsl_extractor_t *extractor =
+        (rift_dsl_extractor_t *)calloc(1, sizeof(rift_dsl_extractor_t));
+    if (!extractor) {
+        return NULL;
+    }
+    size_t num_rules = plan->num_rules ? plan->num_rules : 1;
+    extractor->plan = plan;
+    extractor->matchers = (rift_regex_matcher_t **)calloc(num_rules, sizeof(*extractor->matchers));
+    extractor->hits = (size_t *)malloc(num_rules * sizeof(size_t));
+    extractor->spans = (rift_regex_span_t *)malloc(plan->max_spans * sizeof(rift_regex_span_t));
+    if (!extractor->matchers || !extractor->hits || !extractor->spans) {
+        rift_dsl_extractor_free(extractor);
+        return NULL;
+    }
+    return extractor;
+}
+
+void
+rift_dsl_extractor_free(rift_dsl_extractor_t *extractor)
+{
+    if (!extractor) {
+        return;
+    }
+    for (size_t i = 0; extractor->matchers && i < extractor->plan->num_rules; i++) {
+        rift_matcher_free(extractor->matchers[i]);
+    }
+    free(extractor->matchers);
+    free(extractor->hits);
+    free(extractor->spans);
+    free(extractor);
+}
+
+/**
+ * @brief Record a rule the input matches
+ */
+static bool
+collect_hit(size_t index, void *user_data)
+{
+    rift_dsl_extractor_t *extractor = (rift_dsl_extractor_t *)user_data;
+    extractor->hits[extractor->num_hits++] = index;
+    return true;
+}
+
+/**
+ * @brief Fill the spans of a rule known to match the input
+ *
+ * @param extractor The extractor
+ * @param index Index of the rule
+ * @param input The input
+ * @param input_length Length of the input
+ * @return true if the spans were filled, false if the rule did not match after all
+ */
+static bool
+extract_rule(rift_dsl_extractor_t *extractor, size_t index, const char *input,
+             size_t input_length)
+{
+    const rift_dsl_extract_plan_t *plan = extractor->plan;
+    const extract_rule_t *rule = &plan->rules[index];
+    rift_regex_span_t *spans = extractor->spans;
+    for (size_t i = 0; i < rule->num_spans; i++) {
+        spans[i].start = RIFT_REGEX_SPAN_UNSET;
+        spans[i].end = RIFT_REGEX_SPAN_UNSET;
+    }
+
+    if (rule->pattern) {
+        // The match cannot reach past the longest prefix the table accepts
+        size_t end = input_length;
+        if (rule->table && !rift_dfa_table_longest_prefix(rule->table, input, input_length, &end)) {
+            end = input_length;
+        }
+
+        rift_regex_matcher_t *matcher = extractor->matchers[index];
+        if (!matcher) {
+            matcher = rift_matcher_create(rule->pattern, RIFT_MATCHER_OPTION_ANCHOR_START);
+            extractor->matchers[index] = matcher;
+        }
+        if (matcher && rift_matcher_set_input(matcher, input, end) &&
+            rift_matcher_find_next_spans(matcher, spans, rule->num_spans, NULL)) {
+            return true;
+        }
+    }
+
+    // Rules without groups, or whose pattern the matcher could not run, get the VM's span
+    rift_regex_match_t match;
+    memset(&match, 0, sizeof(match));
+    if (!rift_dsl_execute(plan->compilation, index, input, input_length, &match)) {
+        return false;
+    }
+    spans[0].start = match.start_pos;
+    spans[0].end = match.end_pos;
+    return true;
+}
+
+size_t
+rift_dsl_extract(rift_dsl_extractor_t *extractor, const char *input, size_t input_length,
+                 rift_dsl_extract_callback_t callback, void *user_data)
+{
+    if (!extractor || !input) {
+        return 0;
+    }
+
+    // Phase one: one pass of each rule shard finds the rules worth extracting
+    extractor->num_hits = 0;
+    rift_dsl_execute_all(extractor->plan->compilation, input, input_length, collect_hit,
+                         extractor);
+
+    // Phase two: the capture engines run for those rules alone
+    size_t reported = 0;
+    for (size_t i = 0; i < extractor->num_hits; i++) {
+        size_t index = extractor->hits[i];
+        if (!extract_rule(extractor, index, input, input_length)) {
+            continue;
+        }
+        reported++;
+        rift_dsl_extraction_t extraction = {index, extractor->spans,
+                                            extractor->plan->rules[index].num_spans};
+        if (callback && !callback(&extraction, user_data)) {
+            break;
+        }
+    }
+    return reported;
+}
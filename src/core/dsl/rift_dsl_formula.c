@@ -0,0 +1,347 @@
+/**
+ * @file rift_dsl_formula.c
+ * @brief Implementation of boolean formulas over the rules of a .rift file
+ *
+ * Expressions are parsed by recursive descent straight to postfix order,
+ * tracking the depth of the operand stack, so evaluation needs no
+ * allocation: the stack is an array of RIFT_DSL_FORMULA_MAX_STACK entries.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/dsl/rift_dsl_formula.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief State of the parse of an expression
+ */
+typedef struct {
+    const char *expression;               /**< The whole expression */
+    const char *cursor;                   /**< Next character to read */
+    rift_dsl_formula_resolver_t resolver; /**< Resolves the rule names */
+    void *user_data;                      /**< User data for the resolver */
+    rift_dsl_formula_t *formula;          /**< Formula being built */
+    size_t capacity;                      /**< Steps allocated */
+    size_t depth;                         /**< Operand stack depth after the steps so far */
+    size_t nesting;                       /**< Operators and parentheses open */
+    char *error;                          /**< Buffer for the error message, NULL for none */
+    size_t error_size;                    /**< Size of the error buffer */
+    bool failed;                          /**< Whether the parse failed */
+} formula_parser_t;
+
+/**
+ * @brief Record the first error of a parse
+ *
+ * @param parser The parser
+ * @param message The message, a format taking the offset of the cursor
+ */
+static void
+parser_fail(formula_parser_t *parser, const char *message)
+{
+    if (parser->failed) {
+        return;
+    }
+    parser->failed = true;
+    if (parser->error && parser->error_size > 0) {
+        snprintf(parser->error, parser->error_size, message,
+                 (size_t)(parser->cursor - parser->expression));
+    }
+}
+
+/**
+ * @brief Append a step, keeping track of the operand stack
+ *
+ * @param parser The parser
+ * @param op The operation
+ * @param rule The rule of a RIFT_DSL_FORMULA_RULE step
+ */
+static void
+parser_emit(formula_parser_t *parser, rift_dsl_formula_op_t op, uint32_t rule)
+{
+    if (parser->failed) {
+        return;
+    }
+
+    rift_dsl_formula_t *formula = parser->formula;
+    if (formula->num_steps == parser->capacity) {
+        size_t capacity = parser->capacity > 0 ? parser->capacity * 2 : 8;
+        rift_dsl_formula_step_t *steps = (rift_dsl_formula_step_t *)realloc(
+            formula->steps, capacity * sizeof(rift_dsl_formula_step_t));
+        if (!steps) {
+            parser_fail(parser, "Out of memory at offset %zu");
+            return;
+        }
+        formula->steps = steps;
+        parser->capacity = capacity;
+    }
+    formula->steps[formula->num_steps].op = op;
+    formula->steps[formula->num_steps].rule = rule;
+    formula->num_steps++;
+
+    if (op == RIFT_DSL_FORMULA_RULE) {
+        parser->depth++;
+    } else if (op != RIFT_DSL_FORMULA_NOT) {
+        parser->depth--;
+    }
+    if (parser->depth > formula->max_stack) {
+        formula->max_stack = parser->depth;
+    }
+    if (formula->max_stack > RIFT_DSL_FORMULA_MAX_STACK) {
+        parser_fail(parser, "Expression nested too deeply at offset %zu");
+    }
+}
+
+/**
+ * @brief Skip white space
+ *
+ * @param parser The parser
+ */
+static void
+parser_skip_space(formula_parser_t *parser)
+{
+    while (isspace((unsigned char)*parser->cursor)) {
+        parser->cursor++;
+    }
+}
+
+/**
+ * @brief Get the length of the name at the cursor
+ *
+ * @param parser The parser, at a non-space character
+ * @return Length of the name, 0 if none starts there
+ */
+static size_t
+parser_name_length(const formula_parser_t *parser)
+{
+    const char *p = parser->cursor;
+    if (!isalpha((unsigned char)*p) && *p != '_') {
+        return 0;
+    }
+    while (isalnum((unsigned char)*p) || *p == '_') {
+        p++;
+    }
+    return (size_t)(p - parser->cursor);
+}
+
+/**
+ * @brief Consume an operator given by its symbol or its word
+ *
+ * @param parser The parser
+ * @param symbol The symbol
+ * @param word The word, which must not run on into a longer name (can be NULL)
+ * @return true if the operator was at the cursor, false otherwise
+ */
+static bool
+parser_accept(formula_parser_t *parser, char symbol, const char *word)
+{
+    parser_skip_space(parser);
+    if (*parser->cursor == symbol) {
+        parser->cursor++;
+        return true;
+    }
+
+    if (!word) {
+        return false;
+    }
+    size_t length = strlen(word);
+    if (parser_name_length(parser) == length && strncmp(parser->cursor, word, length) == 0) {
+        parser->cursor += length;
+        return true;
+    }
+    return false;
+}
+
+static void parse_or(formula_parser_t *parser);
+
+/**
+ * @brief Parse a negation, a parenthesized expression or a rule name
+ *
+ * @param parser The parser
+ */
+static void
+parse_operand(formula_parser_t *parser)
+{
+    if (parser->failed) {
+        return;
+    }
+    if (++parser->nesting > RIFT_DSL_FORMULA_MAX_STACK) {
+        parser_fail(parser, "Expression nested too deeply at offset %zu");
+        return;
+    }
+
+    if (parser_accept(parser, '!', "not")) {
+        parse_operand(parser);
+        parser_emit(parser, RIFT_DSL_FORMULA_NOT, 0);
+    } else if (parser_accept(parser, '(', NULL)) {
+        parse_or(parser);
+        if (!parser_accept(parser, ')', NULL)) {
+            parser_fail(parser, "Expected ) at offset %zu");
+        }
+    } else {
+        size_t length = parser_name_length(parser);
+        uint32_t rule = 0;
+        if (length == 0) {
+            parser_fail(parser, "Expected a rule name at offset %zu");
+        } else if (!parser->resolver(parser->cursor, length, &rule, parser->user_data)) {
+            if (parser->error && parser->error_size > 0) {
+                snprintf(parser->error, parser->error_size, "Unknown rule '%.*s' at offset %zu",
+                         (int)length, parser->cursor,
+                         (size_t)(parser->cursor - parser->expression));
+            }
+            parser->failed = true;
+        } else {
+            parser->cursor += length;
+            parser_emit(parser, RIFT_DSL_FORMULA_RULE, rule);
+        }
+    }
+    parser->nesting--;
+}
+
+/**
+ * @brief Parse operands joined by and
+ *
+ * @param parser The parser
+ */
+static void
+parse_and(formula_parser_t *parser)
+{
+    parse_operand(parser);
+    while (!parser->failed && parser_accept(parser, '&', "and")) {
+        parse_operand(parser);
+        parser_emit(parser, RIFT_DSL_FORMULA_AND, 0);
+    }
+}
+
+/**
+ * @brief Parse conjunctions joined by or
+ *
+ * @param parser The parser
+ */
+static void
+parse_or(formula_parser_t *parser)
+{
+    parse_and(parser);
+    while (!parser->failed && parser_accept(parser, '|', "or")) {
+        parse_and(parser);
+        parser_emit(parser, RIFT_DSL_FORMULA_OR, 0);
+    }
+}
+
+bool
+rift_dsl_formula_compile(rift_dsl_formula_t *formula, const char *expression,
+                         rift_dsl_formula_resolver_t resolver, void *user_data, char *error,
+                         size_t error_size)
+{
+    if (!formula || !expression || !resolver) {
+        if (error && error_size > 0) {
+            snprintf(error, error_size, "Invalid parameters");
+        }
+        return false;
+    }
+
+    memset(formula, 0, sizeof(*formula));
+    formula_parser_t parser = {expression, expression, resolver, user_data, formula, 0, 0, 0,
+                               error,      error_size, false};
+    parse_or(&parser);
+    parser_skip_space(&parser);
+    if (*parser.cursor != '\0') {
+        parser_fail(&parser, "Unexpected character at offset %zu");
+    }
+
+    if (parser.failed) {
+        rift_dsl_formula_destroy(formula);
+        return false;
+    }
+    return true;
+}
+
+void
+rift_dsl_formula_destroy(rift_dsl_formula_t *formula)
+{
+    if (!formula) {
+        return;
+    }
+    free(formula->steps);
+    memset(formula, 0, sizeof(*formula));
+}
+
+bool
+rift_dsl_formula_matches(const rift_dsl_formula_t *formula, const uint64_t *matched)
+{
+    bool stack[RIFT_DSL_FORMULA_MAX_STACK];
+    size_t top = 0;
+
+    for (size_t i = 0; i < formula->num_steps; i++) {
+        const rift_dsl_formula_step_t *step = &formula->steps[i];
+        switch (step->op) {
+        case RIFT_DSL_FORMULA_RULE:
+            stack[top++] = ((matched[step->rule / 64] >> (step->rule % 64)) & 1) != 0;
+            break;
+        case RIFT_DSL_FORMULA_NOT:
+            stack[top - 1] = !stack[top - 1];
+            break;
+        case RIFT_DSL_FORMULA_AND:
+            top--;
+            stack[top - 1] = stack[top - 1] && stack[top];
+            break;
+        case RIFT_DSL_FORMULA_OR:
+            top--;
+            stack[top - 1] = stack[top - 1] || stack[top];
+            break;
+        }
+    }
+    return top > 0 && stack[0];
+}
+
+void
+rift_dsl_formula_eval_lanes(const rift_dsl_formula_t *formula, const uint64_t *lanes,
+                            size_t num_words, uint64_t *out)
+{
+    enum { BLOCK = RIFT_DSL_FORMULA_BLOCK_WORDS };
+    uint64_t stack[RIFT_DSL_FORMULA_MAX_STACK][BLOCK];
+
+    // Every operation runs over a whole block, which the loops of fixed length let vectorize
+    for (size_t base = 0; base < num_words; base += BLOCK) {
+        size_t count = num_words - base < BLOCK ? num_words - base : BLOCK;
+        size_t top = 0;
+
+        for (size_t i = 0; i < formula->num_steps; i++) {
+            const rift_dsl_formula_step_t *step = &formula->steps[i];
+            switch (step->op) {
+            case RIFT_DSL_FORMULA_RULE: {
+                const uint64_t *words = lanes + (size_t)step->rule * num_words + base;
+                for (size_t k = 0; k < BLOCK; k++) {
+                    stack[top][k] = k < count ? words[k] : 0;
+                }
+                top++;
+                break;
+            }
+            case RIFT_DSL_FORMULA_NOT:
+                for (size_t k = 0; k < BLOCK; k++) {
+                    stack[top - 1][k] = ~stack[top - 1][k];
+                }
+                break;
+            case RIFT_DSL_FORMULA_AND:
+                top--;
+                for (size_t k = 0; k < BLOCK; k++) {
+                    stack[top - 1][k] &= stack[top][k];
+                }
+                break;
+            case RIFT_DSL_FORMULA_OR:
+                top--;
+                for (size_t k = 0; k < BLOCK; k++) {
+                    stack[top - 1][k] |= stack[top][k];
+                }
+                break;
+            }
+        }
+
+        for (size_t k = 0; k < count; k++) {
+            out[base + k] = top > 0 ? stack[0][k] : 0;
+        }
+    }
+}
@@ -7,18 +7,26 @@
  * @brief Implementation of I/O utilities for the .rift DSL
  *
  * This file implements the functionality to read and write .rift DSL files,
- * including serialization and deserialization of bytecode.
+ * including serialization and deserialization of bytecode. Binaries compiled
+ * from a source can be kept in a cache directory, named by a hash of the
+ * source and of everything else their bytes depend on.
  *
  * @copyright Copyright (c) 2025 LibRift Project
  * @license MIT License
  */
 
 #include "core/dsl/rift_dsl_io.h"
+#include "core/dsl/rift_dsl_compiler.h"
 #include "core/engine/pattern.h"
+#include "version.h"
+ #include <pthread.h>
  #include <stdio.h>
  #include <stdlib.h>
  #include <string.h>
  #include <stdbool.h>
+ #include <sys/stat.h>
+ #include <sys/types.h>
+ #include <unistd.h>
  
  /* Forward declarations from rift_dsl_parser.c */
  extern void *rift_dsl_parse(const char *source);
@@ -30,6 +38,8 @@
  extern void rift_dsl_free_compilation(void *handle);
  extern bool rift_dsl_serialize_compilation(void *handle, uint8_t **data, size_t *size);
  extern void *rift_dsl_deserialize_compilation(const uint8_t *data, size_t size);
+ extern bool rift_dsl_serialize_container(void *handle, uint8_t **data, size_t *size);
+ extern void *rift_dsl_map_compilation(const char *filename);
  
  /**
   * @brief Structure containing a raw binary buffer and its size
@@ -37,10 +47,57 @@
  typedef struct {
      uint8_t *data;
      size_t size;
+     bool from_cache;
      char error_message[256];
      bool has_error;
  } rift_dsl_binary_t;
  
+ /**
+  * @brief Version of the cache file layout, raised when it or the binary format changes
+  */
+ #define RIFT_DSL_CACHE_FORMAT 2
+ 
+ /**
+  * @brief Written in native byte order, so a file from another endianness is refused
+  */
+ #define RIFT_DSL_CACHE_BYTE_ORDER 0x01020304u
+ 
+ /**
+  * @brief Kinds of cached payload, part of the key so both kinds of one source coexist
+  */
+ #define RIFT_DSL_CACHE_KIND_BINARY 0u
+ #define RIFT_DSL_CACHE_KIND_CONTAINER 1u
+ 
+ /**
+  * @brief Header of a cache file, followed by the binary
+  * 
+  * The file is named by the key, a hash of the source and of the fields
+  * before it; the source length guards against a colliding key and the
+  * payload hash against a torn or damaged file.
+  */
+ typedef struct {
+     char magic[4];
+     uint32_t format;
+     uint32_t library_version;
+     uint32_t byte_order;
+     uint32_t size_width;
+     uint32_t payload_kind;
+     uint64_t source_length;
+     uint64_t key;
+     uint64_t payload_size;
+     uint64_t payload_hash;
+ } rift_dsl_cache_header_t;
+ 
+ /**
+  * @brief Cache directory, empty while caching is off
+  */
+ static char rift_dsl_cache_dir[4096];
+ 
+ /**
+  * @brief Lock of the cache directory
+  */
+ static pthread_mutex_t rift_dsl_cache_lock = PTHREAD_MUTEX_INITIALIZER;
+ 
  /**
   * @brief Set an error in the binary buffer
   * 
@@ -82,6 +139,7 @@
      }
      
      binary->size = size;
+     binary->from_cache = false;
      binary->has_error = false;
      binary->error_message[0] = '\0';
      
@@ -130,21 +188,158 @@
      return true;
  }
  
- /* Public API functions */
+ /**
+  * @brief Hash bytes with 64-bit FNV-1a
+  * 
+  * @param hash Hash of the bytes before, or the FNV offset basis
+  * @param data The bytes
+  * @param size Number of bytes
+  * @return The updated hash
+  */
+ static uint64_t
+ rift_dsl_cache_hash(uint64_t hash, const void *data, size_t size)
+ {
+     const uint8_t *bytes = (const uint8_t *)data;
+     for (size_t i = 0; i < size; i++) {
+         hash = (hash ^ bytes[i]) * 1099511628211ULL;
+     }
+     return hash;
+ }
  
  /**
-  * @brief Compile a .rift DSL source and export as bytecode binary
+  * @brief Fill the header of the cache file of a source
   * 
+  * @param header The header to fill, whose payload fields are cleared
   * @param source The .rift DSL source code
-  * @return Opaque handle to binary data or NULL on error
+  * @param length Length of the source
+  * @param kind Kind of the payload, a RIFT_DSL_CACHE_KIND_* value
   */
- void *
- rift_dsl_compile_to_binary(const char *source)
+ static void
+ rift_dsl_cache_header_init(rift_dsl_cache_header_t *header, const char *source, size_t length,
+                            uint32_t kind)
  {
-     if (!source) {
+     memset(header, 0, sizeof(*header));
+     memcpy(header->magic, "RDSC", 4);
+     header->format = RIFT_DSL_CACHE_FORMAT;
+     header->library_version = LIBRIFT_VERSION;
+     header->byte_order = RIFT_DSL_CACHE_BYTE_ORDER;
+     header->size_width = (uint32_t)sizeof(size_t);
+     header->payload_kind = kind;
+     header->source_length = length;
+     
+     uint64_t key = rift_dsl_cache_hash(14695981039346656037ULL, header,
+                                        offsetof(rift_dsl_cache_header_t, key));
+     header->key = rift_dsl_cache_hash(key, source, length);
+ }
+ 
+ /**
+  * @brief Build the path of a cache file
+  * 
+  * @param path Buffer for the path
+  * @param path_size Size of the buffer
+  * @param key Key of the file
+  * @return true if caching is on and the path fits, false otherwise
+  */
+ static bool
+ rift_dsl_cache_path(char *path, size_t path_size, uint64_t key)
+ {
+     pthread_mutex_lock(&rift_dsl_cache_lock);
+     int written = rift_dsl_cache_dir[0] != '\0'
+                       ? snprintf(path, path_size, "%s/%016llx.rdsc", rift_dsl_cache_dir,
+                                  (unsigned long long)key)
+                       : -1;
+     pthread_mutex_unlock(&rift_dsl_cache_lock);
+     return written > 0 && (size_t)written < path_size;
+ }
+ 
+ /**
+  * @brief Read the binary cached for a source
+  * 
+  * @param path Path of the cache file
+  * @param expected Header the file must start with, payload fields aside
+  * @return The binary, or NULL if the file is missing or does not match
+  */
+ static rift_dsl_binary_t *
+ rift_dsl_cache_read(const char *path, const rift_dsl_cache_header_t *expected)
+ {
+     FILE *file = fopen(path, "rb");
+     if (!file) {
          return NULL;
      }
      
+     rift_dsl_cache_header_t header;
+     rift_dsl_binary_t *binary = NULL;
+     if (fread(&header, sizeof(header), 1, file) == 1 &&
+         memcmp(&header, expected, offsetof(rift_dsl_cache_header_t, payload_size)) == 0 &&
+         header.payload_size > 0 && header.payload_size <= SIZE_MAX) {
+         binary = rift_dsl_binary_create((size_t)header.payload_size);
+     }
+     if (binary && (fread(binary->data, 1, binary->size, file) != binary->size ||
+                    fgetc(file) != EOF ||
+                    rift_dsl_cache_hash(14695981039346656037ULL, binary->data, binary->size) !=
+                        header.payload_hash)) {
+         rift_dsl_binary_free(binary);
+         binary = NULL;
+     }
+     fclose(file);
+     
+     if (binary) {
+         binary->from_cache = true;
+     }
+     return binary;
+ }
+ 
+ /**
+  * @brief Store a binary in the cache
+  * 
+  * The file is written under a name of its own and renamed into place, so
+  * processes reading the cache never see it half written.
+  * 
+  * @param path Path of the cache file
+  * @param header Header of the file, payload fields aside
+  * @param binary The binary
+  */
+ static void
+ rift_dsl_cache_write(const char *path, const rift_dsl_cache_header_t *header,
+                      const rift_dsl_binary_t *binary)
+ {
+     static unsigned long counter = 0;
+     char temporary[4200];
+     pthread_mutex_lock(&rift_dsl_cache_lock);
+     unsigned long serial = counter++;
+     pthread_mutex_unlock(&rift_dsl_cache_lock);
+     int written = snprintf(temporary, sizeof(temporary), "%s.%ld.%lu.tmp", path,
+                            (long)getpid(), serial);
+     if (written <= 0 || (size_t)written >= sizeof(temporary)) {
+         return;
+     }
+     
+     rift_dsl_cache_header_t stored = *header;
+     stored.payload_size = binary->size;
+     stored.payload_hash = rift_dsl_cache_hash(14695981039346656037ULL, binary->data,
+                                               binary->size);
+     
+     FILE *file = fopen(temporary, "wb");
+     if (!file) {
+         return;
+     }
+     bool complete = fwrite(&stored, sizeof(stored), 1, file) == 1 &&
+                     fwrite(binary->data, 1, binary->size, file) == binary->size;
+     complete = fclose(file) == 0 && complete;
+     if (!complete || rename(temporary, path) != 0) {
+         remove(temporary);
+     }
+ }
+ 
+ /**
+  * @brief Compile a .rift DSL source to a binary, without the cache
+  * 
+  * @param source The .rift DSL source code
+  * @return New binary or NULL on error
+  */
+ static rift_dsl_binary_t *
+ rift_dsl_compile_binary(const char *source)
+ {
      // Compile the DSL
      void *compilation = rift_dsl_compile(source);
      if (!compilation) {
@@ -180,6 +375,151 @@
      return binary;
  }
  
+ /* Public API functions */
+ 
+ /**
+  * @brief Set the directory caching compiled binaries
+  * 
+  * @param directory The directory, created if missing, or NULL to stop caching
+  * @return true if successful, false otherwise
+  */
+ bool
+ rift_dsl_set_cache_dir(const char *directory)
+ {
+     if (directory && (directory[0] == '\0' ||
+                       strlen(directory) >= sizeof(rift_dsl_cache_dir))) {
+         return false;
+     }
+     
+     struct stat info;
+     if (directory && mkdir(directory, 0755) != 0 &&
+         (stat(directory, &info) != 0 || !S_ISDIR(info.st_mode))) {
+         return false;
+     }
+     
+     pthread_mutex_lock(&rift_dsl_cache_lock);
+     snprintf(rift_dsl_cache_dir, sizeof(rift_dsl_cache_dir), "%s", directory ? directory : "");
+     pthread_mutex_unlock(&rift_dsl_cache_lock);
+     return true;
+ }
+ 
+ 
+ /**
+  * @brief Compile a .rift DSL source and export as bytecode binary
+  * 
+  * @param source The .rift DSL source code
+  * @return Opaque handle to binary data or NULL on error
+  */
+ void *
+ rift_dsl_compile_to_binary(const char *source)
+ {
+     if (!source) {
+         return NULL;
+     }
+     
+     // Take the binary from the cache when it holds one for this source
+     rift_dsl_cache_header_t header;
+     char path[4160];
+     rift_dsl_cache_header_init(&header, source, strlen(source), RIFT_DSL_CACHE_KIND_BINARY);
+     bool cached = rift_dsl_cache_path(path, sizeof(path), header.key);
+     if (cached) {
+         rift_dsl_binary_t *binary = rift_dsl_cache_read(path, &header);
+         if (binary) {
+             return binary;
+         }
+     }
+     
+     rift_dsl_binary_t *binary = rift_dsl_compile_binary(source);
+     if (binary && cached) {
+         rift_dsl_cache_write(path, &header, binary);
+     }
+     return binary;
+ }
+ 
+ /**
+  * @brief Compile a .rift DSL source and export it as a mappable container
+  * 
+  * @param source The .rift DSL source code
+  * @return Opaque handle to binary data or NULL on error
+  */
+ void *
+ rift_dsl_compile_to_container(const char *source)
+ {
+     return rift_dsl_compile_to_container_with_options(source, NULL);
+ }
+ 
+ /**
+  * @brief Compile a .rift DSL source to a mappable container with options
+  * 
+  * @param source The .rift DSL source code
+  * @param options Options of the compilation (can be NULL for the defaults)
+  * @return Opaque handle to binary data or NULL on error
+  */
+ void *
+ rift_dsl_compile_to_container_with_options(const char *source,
+                                            const rift_dsl_compile_options_t *options)
+ {
+     if (!source) {
+         return NULL;
+     }
+     
+     // Take the container from the cache when it holds one for this source; the key
+     // only covers the source, so pruned and linted compilations bypass the cache
+     rift_dsl_cache_header_t header;
+     char path[4160];
+     rift_dsl_cache_header_init(&header, source, strlen(source), RIFT_DSL_CACHE_KIND_CONTAINER);
+     bool cached = !(options && (options->prune_redundant || options->lint)) &&
+                   rift_dsl_cache_path(path, sizeof(path), header.key);
+     if (cached) {
+         rift_dsl_binary_t *binary = rift_dsl_cache_read(path, &header);
+         if (binary) {
+             if (options && options->stats) {
+                 memset(options->stats, 0, sizeof(*options->stats));
+             }
+             return binary;
+         }
+     }
+     
+     void *compilation = rift_dsl_compile_with_options(source, options);
+     if (!compilation) {
+         return NULL;
+     }
+     
+     // A failed compilation gives no bytes, only its error
+     const char *error = rift_dsl_get_compilation_error(compilation);
+     if (error) {
+         rift_dsl_binary_t *binary = rift_dsl_binary_create(0);
+         if (binary) {
+             rift_dsl_binary_error(binary, error);
+         }
+         rift_dsl_free_compilation(compilation);
+         return binary;
+     }
+     
+     uint8_t *data;
+     size_t size;
+     bool written = rift_dsl_serialize_container(compilation, &data, &size);
+     rift_dsl_free_compilation(compilation);
+     if (!written) {
+         return NULL;
+     }
+     
+     // The binary takes the container bytes as they are
+     rift_dsl_binary_t *binary = rift_dsl_binary_create(0);
+     if (!binary) {
+         free(data);
+         return NULL;
+     }
+     free(binary->data);
+     binary->data = data;
+     binary->size = size;
+     
+     if (cached) {
+         rift_dsl_cache_write(path, &header, binary);
+     }
+     return binary;
+ }
+ 
  /**
   * @brief Load and compile a .rift DSL file and export as bytecode binary
   * 
@@ -248,6 +588,19 @@
      rift_dsl_binary_free((rift_dsl_binary_t *)handle);
  }
  
+ /**
+  * @brief Check whether binary data was read from the cache
+  * 
+  * @param handle Opaque handle returned by rift_dsl_compile_to_binary
+  * @return true if the binary came from the cache directory, false otherwise
+  */
+ bool
+ rift_dsl_binary_is_cached(void *handle)
+ {
+     rift_dsl_binary_t *binary = (rift_dsl_binary_t *)handle;
+     return binary && binary->from_cache;
+ }
+ 
  /**
   * @brief Get error message from binary data
   * 
@@ -386,6 +739,18 @@
      return rift_dsl_deserialize_compilation(binary->data, binary->size);
  }
  
+ /**
+  * @brief Create a compiled pattern handle by mapping a container file
+  * 
+  * @param filename Path to a file saved from rift_dsl_compile_to_container
+  * @return Opaque handle to compiled patterns or NULL on error
+  */
+ void *
+ rift_dsl_compilation_map(const char *filename)
+ {
+     return rift_dsl_map_compilation(filename);
+ }
+ 
  /**
   * @brief Validate binary data format
   * 
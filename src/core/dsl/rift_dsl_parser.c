@@ -19,25 +19,63 @@
 #include "core/parser/parser.h"
 #include "core/syntax/lexer.h"
 #include "core/syntax/parser.h"
+ #include <fcntl.h>
+ #include <sys/mman.h>
+ #include <sys/stat.h>
+ #include <unistd.h>
  #include <stdio.h>
  #include <stdlib.h>
  #include <string.h>
  #include <ctype.h>
  #include <stdbool.h>
  #include <stddef.h>
+ #include <stdint.h>
  #include "core/dsl/rift_dsl_parser.h"
  
 
  
+ /**
+  * @brief Hand the pattern parsed last to the stream callback
+  * 
+  * Flags follow their pattern, so a pattern is complete once the next one
+  * starts or the source ends. Without a callback patterns stay in the file.
+  * 
+  * @param lexer The lexer, which gets an error if the callback stops
+  * @param file The DSL file holding at most the pattern parsed last
+  * @param callback The stream callback (can be NULL)
+  * @param user_data User data for the callback
+  */
+ static void
+ rift_dsl_parse_flush_pattern(rift_dsl_lexer_t *lexer, rift_dsl_file_t *file,
+                              rift_dsl_pattern_callback_t callback, void *user_data)
+ {
+     rift_dsl_pattern_t *pattern = file->patterns;
+     if (!callback || !pattern) {
+         return;
+     }
+     
+     file->patterns = NULL;
+     file->last_pattern = NULL;
+     file->pattern_cursor = NULL;
+     if (!callback(pattern->name, pattern->pattern, pattern->flags, pattern->flag_count,
+                   user_data)) {
+         rift_dsl_lexer_error(lexer, "Pattern callback stopped parsing");
+     }
+     rift_dsl_pattern_free(pattern);
+ }
+ 
  /**
   * @brief Parse a .rift file from a string
   * 
   * @param source The source string
   * @param source_length Length of the source string
+  * @param callback Callback taking each pattern instead of the file (can be NULL)
+  * @param user_data User data for the callback
   * @return Parsed DSL file structure or NULL on error
   */
  static rift_dsl_file_t *
- rift_dsl_parse_source(const char *source, size_t source_length)
+ rift_dsl_parse_source(const char *source, size_t source_length,
+                       rift_dsl_pattern_callback_t callback, void *user_data)
  {
      rift_dsl_lexer_t lexer;
      rift_dsl_lexer_init(&lexer, source, source_length);
@@ -70,6 +108,7 @@
              
              if (strcmp(token.value, "pattern") == 0) {
                  rift_dsl_token_free(&token);
+                 rift_dsl_parse_flush_pattern(&lexer, file, callback, user_data);
                  rift_dsl_parse_pattern(&lexer, file);
              }
              else if (strcmp(token.value, "flags") == 0) {
@@ -80,6 +119,14 @@
                  rift_dsl_token_free(&token);
                  rift_dsl_parse_test_case(&lexer, file);
              }
+             else if (strcmp(token.value, "bench") == 0) {
+                 rift_dsl_token_free(&token);
+                 rift_dsl_parse_bench(&lexer, file, callback == NULL);
+             }
+             else if (strcmp(token.value, "combine") == 0) {
+                 rift_dsl_token_free(&token);
+                 rift_dsl_parse_combination(&lexer, file);
+             }
              else {
                  char message[128];
                  snprintf(message, sizeof(message), "Unknown directive: @%s", token.value);
@@ -102,6 +149,10 @@
          }
      }
      
+     if (!lexer.has_error) {
+         rift_dsl_parse_flush_pattern(&lexer, file, callback, user_data);
+     }
+     
      // Check for lexer errors
      if (lexer.has_error) {
          rift_dsl_file_error(file, lexer.error_message);
@@ -154,6 +205,40 @@
      free(test_case->match_groups);
  }
  
+ /**
+  * @brief Free resources associated with a benchmark
+  * 
+  * @param bench The benchmark to free
+  */
+ static void
+ rift_dsl_bench_free(rift_dsl_bench_t *bench)
+ {
+     if (!bench) {
+         return;
+     }
+     
+     free(bench->pattern_name);
+     free(bench->input);
+     free(bench->corpus);
+ }
+ 
+ /**
+  * @brief Free resources associated with a rule combination
+  * 
+  * @param combination The combination to free
+  */
+ static void
+ rift_dsl_combination_free(rift_dsl_combination_t *combination)
+ {
+     if (!combination) {
+         return;
+     }
+     
+     free(combination->name);
+     free(combination->expression);
+     free(combination);
+ }
+ 
  /**
   * @brief Free resources associated with a DSL file
   * 
@@ -183,9 +268,75 @@
          test_case = next;
      }
      
+     // Free benchmarks
+     rift_dsl_bench_list_t *bench = file->benches;
+     while (bench) {
+         rift_dsl_bench_list_t *next = bench->next;
+         rift_dsl_bench_free(&bench->bench);
+         free(bench);
+         bench = next;
+     }
+     
+     // Free combinations
+     rift_dsl_combination_t *combination = file->combinations;
+     while (combination) {
+         rift_dsl_combination_t *next = combination->next;
+         rift_dsl_combination_free(combination);
+         combination = next;
+     }
+     
      free(file);
  }
  
+ /**
+  * @brief Find a pattern by index
+  * 
+  * The pattern found last is kept, so reading the patterns in order does
+  * not walk the list from its head each time.
+  * 
+  * @param file The DSL file
+  * @param index The pattern index
+  * @return The pattern or NULL if the index is out of range
+  */
+ static rift_dsl_pattern_t *
+ rift_dsl_file_pattern_at(rift_dsl_file_t *file, size_t index)
+ {
+     if (!file->pattern_cursor || file->pattern_cursor_index > index) {
+         file->pattern_cursor = file->patterns;
+         file->pattern_cursor_index = 0;
+     }
+     
+     while (file->pattern_cursor && file->pattern_cursor_index < index) {
+         file->pattern_cursor = file->pattern_cursor->next;
+         file->pattern_cursor_index++;
+     }
+     return file->pattern_cursor;
+ }
+ 
+ /**
+  * @brief Find a test case by index
+  * 
+  * Like rift_dsl_file_pattern_at, the test case found last is kept.
+  * 
+  * @param file The DSL file
+  * @param index The test case index
+  * @return The test case or NULL if the index is out of range
+  */
+ static rift_dsl_test_case_list_t *
+ rift_dsl_file_test_case_at(rift_dsl_file_t *file, size_t index)
+ {
+     if (!file->test_case_cursor || file->test_case_cursor_index > index) {
+         file->test_case_cursor = file->test_cases;
+         file->test_case_cursor_index = 0;
+     }
+     
+     while (file->test_case_cursor && file->test_case_cursor_index < index) {
+         file->test_case_cursor = file->test_case_cursor->next;
+         file->test_case_cursor_index++;
+     }
+     return file->test_case_cursor;
+ }
+ 
  /* Public API functions */
  
  /**
@@ -201,7 +352,69 @@
          return NULL;
      }
      
-     return rift_dsl_parse_source(source, strlen(source));
+     return rift_dsl_parse_source(source, strlen(source), NULL, NULL);
+ }
+ 
+ /**
+  * @brief Parse a .rift source, handing each pattern to a callback
+  * 
+  * @param source The source bytes, not necessarily null-terminated
+  * @param length Length of the source
+  * @param callback Callback taking each pattern
+  * @param user_data User data for the callback
+  * @return Opaque handle to the test cases and error of the file or NULL on error
+  */
+ void *
+ rift_dsl_parse_stream(const char *source, size_t length, rift_dsl_pattern_callback_t callback,
+                       void *user_data)
+ {
+     if (!source || !callback) {
+         return NULL;
+     }
+     
+     return rift_dsl_parse_source(source, length, callback, user_data);
+ }
+ 
+ /**
+  * @brief Map a .rift file and parse it as a stream
+  * 
+  * @param filename The filename
+  * @param callback Callback taking each pattern
+  * @param user_data User data for the callback
+  * @return Opaque handle to the test cases and error of the file or NULL on error
+  */
+ void *
+ rift_dsl_load_file_stream(const char *filename, rift_dsl_pattern_callback_t callback,
+                           void *user_data)
+ {
+     if (!filename || !callback) {
+         return NULL;
+     }
+     
+     int fd = open(filename, O_RDONLY);
+     if (fd < 0) {
+         return NULL;
+     }
+     
+     struct stat info;
+     if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size <= 0) {
+         close(fd);
+         return NULL;
+     }
+     
+     // Pages are read in as the lexer reaches them and can be dropped behind it
+     size_t length = (size_t)info.st_size;
+     void *source = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+     close(fd);
+     if (source == MAP_FAILED) {
+         return NULL;
+     }
+     madvise(source, length, MADV_SEQUENTIAL);
+     
+     rift_dsl_file_t *file = rift_dsl_parse_source((const char *)source, length, callback,
+                                                   user_data);
+     munmap(source, length);
+     return file;
  }
  
  /**
@@ -302,15 +515,8 @@
          return 0;
      }
      
-     size_t count = 0;
-     rift_dsl_pattern_t *pattern = file->patterns;
-     
-     while (pattern) {
-         count++;
-         pattern = pattern->next;
-     }
-     
-     return count;
+     // Streamed files hand their patterns over, so only held ones count
+     return file->patterns ? file->pattern_count : 0;
  }
  
  /**
@@ -330,21 +536,14 @@
          return false;
      }
      
-     size_t current = 0;
-     rift_dsl_pattern_t *current_pattern = file->patterns;
-     
-     while (current_pattern) {
-         if (current == index) {
-             *name = current_pattern->name;
-             *pattern = current_pattern->pattern;
-             return true;
-         }
-         
-         current++;
-         current_pattern = current_pattern->next;
+     rift_dsl_pattern_t *current_pattern = rift_dsl_file_pattern_at(file, index);
+     if (!current_pattern) {
+         return false;
      }
      
-     return false;
+     *name = current_pattern->name;
+     *pattern = current_pattern->pattern;
+     return true;
  }
  
  /**
@@ -364,21 +563,14 @@
          return false;
      }
      
-     size_t current = 0;
-     rift_dsl_pattern_t *current_pattern = file->patterns;
-     
-     while (current_pattern) {
-         if (current == index) {
-             *flags = (const char **)current_pattern->flags;
-             *count = current_pattern->flag_count;
-             return true;
-         }
-         
-         current++;
-         current_pattern = current_pattern->next;
+     rift_dsl_pattern_t *current_pattern = rift_dsl_file_pattern_at(file, index);
+     if (!current_pattern) {
+         return false;
      }
      
-     return false;
+     *flags = (const char **)current_pattern->flags;
+     *count = current_pattern->flag_count;
+     return true;
  }
  
  /**
@@ -395,15 +587,7 @@
          return 0;
      }
      
-     size_t count = 0;
-     rift_dsl_test_case_list_t *test_case = file->test_cases;
-     
-     while (test_case) {
-         count++;
-         test_case = test_case->next;
-     }
-     
-     return count;
+     return file->test_case_count;
  }
  
  /**
@@ -423,21 +607,14 @@
          return false;
      }
      
-     size_t current = 0;
-     rift_dsl_test_case_list_t *current_test_case = file->test_cases;
-     
-     while (current_test_case) {
-         if (current == index) {
-             *input = current_test_case->test_case.input;
-             *expect_match = current_test_case->test_case.expect_match;
-             return true;
-         }
-         
-         current++;
-         current_test_case = current_test_case->next;
+     rift_dsl_test_case_list_t *current_test_case = rift_dsl_file_test_case_at(file, index);
+     if (!current_test_case) {
+         return false;
      }
      
-     return false;
+     *input = current_test_case->test_case.input;
+     *expect_match = current_test_case->test_case.expect_match;
+     return true;
  }
  
  /**
@@ -457,21 +634,122 @@
          return false;
      }
      
-     size_t current = 0;
-     rift_dsl_test_case_list_t *current_test_case = file->test_cases;
+     rift_dsl_test_case_list_t *current_test_case = rift_dsl_file_test_case_at(file, index);
+     if (!current_test_case) {
+         return false;
+     }
      
-     while (current_test_case) {
-         if (current == index) {
-             *groups = (const char **)current_test_case->test_case.match_groups;
-             *count = current_test_case->test_case.group_count;
-             return true;
-         }
-         
-         current++;
-         current_test_case = current_test_case->next;
+     *groups = (const char **)current_test_case->test_case.match_groups;
+     *count = current_test_case->test_case.group_count;
+     return true;
+ }
+ 
+ /**
+  * @brief Get the number of benchmarks in a DSL file
+  * 
+  * @param handle Opaque handle returned by rift_dsl_parse or rift_dsl_load_file
+  * @return Number of benchmarks
+  */
+ size_t
+ rift_dsl_get_bench_count(void *handle)
+ {
+     rift_dsl_file_t *file = (rift_dsl_file_t *)handle;
+     if (!file) {
+         return 0;
+     }
+     
+     return file->bench_count;
+ }
+ 
+ /**
+  * @brief Get a benchmark by index
+  * 
+  * @param handle Opaque handle returned by rift_dsl_parse or rift_dsl_load_file
+  * @param index The benchmark index
+  * @return The benchmark, owned by the file, or NULL if the index is out of range
+  */
+ const rift_dsl_bench_t *
+ rift_dsl_get_bench(void *handle, size_t index)
+ {
+     rift_dsl_file_t *file = (rift_dsl_file_t *)handle;
+     if (!file || index >= file->bench_count) {
+         return NULL;
+     }
+     
+     rift_dsl_bench_list_t *bench = file->benches;
+     for (size_t i = 0; i < index; i++) {
+         bench = bench->next;
+     }
+     return &bench->bench;
+ }
+ 
+ /**
+  * @brief Get the number of rule combinations in a DSL file
+  * 
+  * @param handle Opaque handle returned by rift_dsl_parse or rift_dsl_load_file
+  * @return Number of combinations
+  */
+ size_t
+ rift_dsl_get_combination_count(void *handle)
+ {
+     rift_dsl_file_t *file = (rift_dsl_file_t *)handle;
+     if (!file) {
+         return 0;
      }
      
-     return false;
+     return file->combination_count;
+ }
+ 
+ /**
+  * @brief Get a rule combination by index
+  * 
+  * @param handle Opaque handle returned by rift_dsl_parse or rift_dsl_load_file
+  * @param index The combination index
+  * @param name Pointer to store the combination name
+  * @param expression Pointer to store the boolean expression
+  * @return true if successful, false otherwise
+  */
+ bool
+ rift_dsl_get_combination(void *handle, size_t index, const char **name,
+                          const char **expression)
+ {
+     rift_dsl_file_t *file = (rift_dsl_file_t *)handle;
+     if (!file || !name || !expression || index >= file->combination_count) {
+         return false;
+     }
+     
+     rift_dsl_combination_t *combination = file->combinations;
+     for (size_t i = 0; i < index; i++) {
+         combination = combination->next;
+     }
+     *name = combination->name;
+     *expression = combination->expression;
+     return true;
+ }
+ 
+ /**
+  * @brief Get the index of the pattern a test case checks
+  * 
+  * @param handle Opaque handle returned by rift_dsl_parse or rift_dsl_load_file
+  * @param index The test case index
+  * @param pattern_index Pointer to store the pattern index
+  * @return true if successful, false otherwise
+  */
+ bool
+ rift_dsl_get_test_case_pattern(void *handle, size_t index, size_t *pattern_index)
+ {
+     rift_dsl_file_t *file = (rift_dsl_file_t *)handle;
+     if (!file || !pattern_index) {
+         return false;
+     }
+     
+     rift_dsl_test_case_list_t *current_test_case = rift_dsl_file_test_case_at(file, index);
+     if (!current_test_case) {
+         return false;
+     }
+     
+     *pattern_index = current_test_case->test_case.pattern_index;
+     return true;
  } rift_dsl_token_type_t;
  
  typedef struct {
@@ -504,6 +782,7 @@
      bool expect_match;
      char **match_groups;
      size_t group_count;
+     size_t pattern_index;
  } rift_dsl_test_case_t;
  
  typedef struct rift_dsl_test_case_list {
@@ -511,9 +790,43 @@
      struct rift_dsl_test_case_list *next;
  } rift_dsl_test_case_list_t;
  
+ typedef struct {
+     char *pattern_name;
+     size_t pattern_index;
+     char *input;
+     char *corpus;
+     size_t iterations;
+     size_t warmup;
+ } rift_dsl_bench_t;
+ 
+ typedef struct rift_dsl_bench_list {
+     rift_dsl_bench_t bench;
+     struct rift_dsl_bench_list *next;
+ } rift_dsl_bench_list_t;
+ 
+ typedef struct rift_dsl_combination_struct {
+     char *name;
+     char *expression;
+     struct rift_dsl_combination_struct *next;
+ } rift_dsl_combination_t;
+ 
  typedef struct {
      rift_dsl_pattern_t *patterns;
+     rift_dsl_pattern_t *last_pattern;
+     size_t pattern_count;
      rift_dsl_test_case_list_t *test_cases;
+     rift_dsl_test_case_list_t *last_test_case;
+     size_t test_case_count;
+     rift_dsl_pattern_t *pattern_cursor;
+     size_t pattern_cursor_index;
+     rift_dsl_test_case_list_t *test_case_cursor;
+     size_t test_case_cursor_index;
+     rift_dsl_bench_list_t *benches;
+     rift_dsl_bench_list_t *last_bench;
+     size_t bench_count;
+     rift_dsl_combination_t *combinations;
+     rift_dsl_combination_t *last_combination;
+     size_t combination_count;
      char error_message[256];
      bool has_error;
  } rift_dsl_file_t;
@@ -734,6 +1047,49 @@
      return token;
  }
  
+ /**
+  * @brief Parse a decimal number
+  * 
+  * @param lexer The lexer
+  * @return The parsed number token, holding the digits as text
+  */
+ static rift_dsl_token_t
+ rift_dsl_lexer_number(rift_dsl_lexer_t *lexer)
+ {
+     size_t start = lexer->position;
+     size_t line = lexer->line;
+     size_t column = lexer->column;
+     
+     while (!rift_dsl_lexer_is_at_end(lexer) && rift_dsl_is_digit(rift_dsl_lexer_peek(lexer))) {
+         rift_dsl_lexer_advance(lexer);
+     }
+     
+     size_t length = lexer->position - start;
+     char *value = (char *)malloc(length + 1);
+     if (!value) {
+         rift_dsl_token_t token = {
+             .type = RIFT_DSL_TOKEN_UNKNOWN,
+             .value = NULL,
+             .line = line,
+             .column = column
+         };
+         rift_dsl_lexer_error(lexer, "Memory allocation failed");
+         return token;
+     }
+     
+     memcpy(value, lexer->source + start, length);
+     value[length] = '\0';
+     
+     rift_dsl_token_t token = {
+         .type = RIFT_DSL_TOKEN_NUMBER,
+         .value = value,
+         .line = line,
+         .column = column
+     };
+     
+     return token;
+ }
+ 
  /**
   * @brief Parse a string literal
   * 
@@ -907,6 +1263,11 @@
          return rift_dsl_lexer_identifier(lexer);
      }
      
+     // Handle numbers
+     if (rift_dsl_is_digit(c)) {
+         return rift_dsl_lexer_number(lexer);
+     }
+     
      // Unknown character
      rift_dsl_lexer_advance(lexer); // Consume the character anyway
      
@@ -952,7 +1313,19 @@
      }
      
      file->patterns = NULL;
+     file->last_pattern = NULL;
+     file->pattern_count = 0;
      file->test_cases = NULL;
+     file->last_test_case = NULL;
+     file->test_case_count = 0;
+     file->pattern_cursor = NULL;
+     file->test_case_cursor = NULL;
+     file->benches = NULL;
+     file->last_bench = NULL;
+     file->bench_count = 0;
+     file->combinations = NULL;
+     file->last_combination = NULL;
+     file->combination_count = 0;
      file->has_error = false;
      file->error_message[0] = '\0';
      
@@ -987,9 +1360,15 @@
          return false;
      }
      
-     // Add at the beginning of the list for simplicity
-     pattern->next = file->patterns;
-     file->patterns = pattern;
+     // Add at the end of the list, so indices follow the source
+     pattern->next = NULL;
+     if (file->last_pattern) {
+         file->last_pattern->next = pattern;
+     } else {
+         file->patterns = pattern;
+     }
+     file->last_pattern = pattern;
+     file->pattern_count++;
      
      return true;
  }
@@ -1018,15 +1397,75 @@
      list_item->next = NULL;
      
      // Add at the end of the list
-     if (!file->test_cases) {
+     if (file->last_test_case) {
+         file->last_test_case->next = list_item;
+     } else {
          file->test_cases = list_item;
+     }
+     file->last_test_case = list_item;
+     file->test_case_count++;
+     
+     return true;
+ }
+ 
+ /**
+  * @brief Add a benchmark to a DSL file
+  * 
+  * @param file The DSL file
+  * @param bench The benchmark to add
+  * @return true if successful, false otherwise
+  */
+ static bool
+ rift_dsl_file_add_bench(rift_dsl_file_t *file, rift_dsl_bench_t *bench)
+ {
+     if (!file || !bench) {
+         return false;
+     }
+     
+     rift_dsl_bench_list_t *list_item = 
+         (rift_dsl_bench_list_t *)malloc(sizeof(rift_dsl_bench_list_t));
+     if (!list_item) {
+         return false;
+     }
+     
+     list_item->bench = *bench;
+     list_item->next = NULL;
+     
+     // Add at the end of the list
+     if (file->last_bench) {
+         file->last_bench->next = list_item;
      } else {
-         rift_dsl_test_case_list_t *current = file->test_cases;
-         while (current->next) {
-             current = current->next;
-         }
-         current->next = list_item;
+         file->benches = list_item;
      }
+     file->last_bench = list_item;
+     file->bench_count++;
+     
+     return true;
+ }
+ 
+ /**
+  * @brief Add a rule combination to a DSL file
+  * 
+  * @param file The DSL file
+  * @param combination The combination to add
+  * @return true if successful, false otherwise
+  */
+ static bool
+ rift_dsl_file_add_combination(rift_dsl_file_t *file, rift_dsl_combination_t *combination)
+ {
+     if (!file || !combination) {
+         return false;
+     }
+     
+     // Add at the end of the list, so indices follow the source
+     combination->next = NULL;
+     if (file->last_combination) {
+         file->last_combination->next = combination;
+     } else {
+         file->combinations = combination;
+     }
+     file->last_combination = combination;
+     file->combination_count++;
      
      return true;
  }
@@ -1173,13 +1612,13 @@
      rift_dsl_token_free(&token);
      
      // If there's no pattern defined yet, we can't add flags
-     if (!file->patterns) {
+     if (!file->last_pattern) {
          rift_dsl_lexer_error(lexer, "Flags must be defined after a pattern");
          return;
      }
      
      // Parse the flags
-     rift_dsl_pattern_t *pattern = file->patterns; // Get the most recent pattern
+     rift_dsl_pattern_t *pattern = file->last_pattern; // Get the most recent pattern
      
      // Temporary storage for flags
      char **flags = NULL;
@@ -1298,12 +1737,19 @@
      
      rift_dsl_token_free(&token);
      
+     // A test case checks the pattern defined last
+     if (file->pattern_count == 0) {
+         rift_dsl_lexer_error(lexer, "Test cases must be defined after a pattern");
+         return;
+     }
+     
      // Initialize a new test case
      rift_dsl_test_case_t test_case = {
          .input = NULL,
          .expect_match = false,
          .match_groups = NULL,
-         .group_count = 0
+         .group_count = 0,
+         .pattern_index = file->pattern_count - 1
      };
      
      // Parse test case properties
@@ -1575,3 +2021,239 @@
          return;
      }
  }
+ 
+ /**
+  * @brief Parse a benchmark definition
+  * 
+  * A benchmark times the pattern it names, or the pattern defined last, on an
+  * inline input or on the files matching a corpus glob. A streaming parse
+  * keeps no patterns to name, so there the benchmark is only checked.
+  * 
+  * @param lexer The lexer, just past @bench
+  * @param file The DSL file to add the benchmark to
+  * @param store Whether to add the benchmark to the file
+  */
+ static void
+ rift_dsl_parse_bench(rift_dsl_lexer_t *lexer, rift_dsl_file_t *file, bool store)
+ {
+     // Expect: @bench { pattern = "NAME" input = "..." iterations = N warmup = N }
+     
+     rift_dsl_token_t token = rift_dsl_lexer_next_token(lexer);
+     if (token.type != RIFT_DSL_TOKEN_LBRACE) {
+         rift_dsl_lexer_error(lexer, "Expected { after bench directive");
+         rift_dsl_token_free(&token);
+         return;
+     }
+     
+     rift_dsl_token_free(&token);
+     
+     rift_dsl_bench_t bench = {
+         .pattern_name = NULL,
+         .pattern_index = 0,
+         .input = NULL,
+         .corpus = NULL,
+         .iterations = RIFT_DSL_BENCH_DEFAULT_ITERATIONS,
+         .warmup = SIZE_MAX
+     };
+     
+     // Parse benchmark properties
+     while (1) {
+         token = rift_dsl_lexer_next_token(lexer);
+         
+         if (token.type == RIFT_DSL_TOKEN_RBRACE) {
+             // End of benchmark
+             rift_dsl_token_free(&token);
+             break;
+         }
+         
+         if (token.type != RIFT_DSL_TOKEN_IDENTIFIER) {
+             rift_dsl_lexer_error(lexer, "Expected property name in bench");
+             rift_dsl_token_free(&token);
+             rift_dsl_bench_free(&bench);
+             return;
+         }
+         
+         char *property_name = token.value;
+         token.value = NULL; // Prevent double free
+         rift_dsl_token_free(&token);
+         
+         // Expect equals sign
+         token = rift_dsl_lexer_next_token(lexer);
+         if (token.type != RIFT_DSL_TOKEN_EQUALS) {
+             char message[128];
+             snprintf(message, sizeof(message), "Expected = after property name '%s'",
+                      property_name);
+             rift_dsl_lexer_error(lexer, message);
+             free(property_name);
+             rift_dsl_token_free(&token);
+             rift_dsl_bench_free(&bench);
+             return;
+         }
+         
+         rift_dsl_token_free(&token);
+         
+         bool is_string = strcmp(property_name, "pattern") == 0 ||
+                          strcmp(property_name, "input") == 0 ||
+                          strcmp(property_name, "corpus") == 0;
+         bool is_number = strcmp(property_name, "iterations") == 0 ||
+                          strcmp(property_name, "warmup") == 0;
+         if (!is_string && !is_number) {
+             char message[128];
+             snprintf(message, sizeof(message), "Unknown bench property: '%s'", property_name);
+             rift_dsl_lexer_error(lexer, message);
+             free(property_name);
+             rift_dsl_bench_free(&bench);
+             return;
+         }
+         
+         token = rift_dsl_lexer_next_token(lexer);
+         if (token.type != (is_string ? RIFT_DSL_TOKEN_STRING : RIFT_DSL_TOKEN_NUMBER)) {
+             char message[128];
+             snprintf(message, sizeof(message), "Expected %s value for %s property",
+                      is_string ? "string" : "number", property_name);
+             rift_dsl_lexer_error(lexer, message);
+             free(property_name);
+             rift_dsl_token_free(&token);
+             rift_dsl_bench_free(&bench);
+             return;
+         }
+         
+         if (is_string) {
+             char **target = strcmp(property_name, "pattern") == 0 ? &bench.pattern_name
+                             : strcmp(property_name, "input") == 0 ? &bench.input
+                                                                  : &bench.corpus;
+             free(*target);
+             *target = token.value;
+             token.value = NULL; // Prevent double free
+         } else {
+             char *end = NULL;
+             unsigned long long value = strtoull(token.value, &end, 10);
+             if (*end != '\0' || value >= SIZE_MAX) {
+                 rift_dsl_lexer_error(lexer, "Number out of range in bench");
+                 free(property_name);
+                 rift_dsl_token_free(&token);
+                 rift_dsl_bench_free(&bench);
+                 return;
+             }
+             if (strcmp(property_name, "iterations") == 0) {
+                 bench.iterations = (size_t)value;
+             } else {
+                 bench.warmup = (size_t)value;
+             }
+         }
+         
+         rift_dsl_token_free(&token);
+         free(property_name);
+     }
+     
+     if ((bench.input == NULL) == (bench.corpus == NULL)) {
+         rift_dsl_lexer_error(lexer, "A bench needs exactly one of input and corpus");
+         rift_dsl_bench_free(&bench);
+         return;
+     }
+     if (bench.iterations == 0) {
+         rift_dsl_lexer_error(lexer, "A bench needs at least one iteration");
+         rift_dsl_bench_free(&bench);
+         return;
+     }
+     if (bench.warmup == SIZE_MAX) {
+         bench.warmup = bench.iterations / 10 > 0 ? bench.iterations / 10 : 1;
+     }
+     
+     if (!store) {
+         rift_dsl_bench_free(&bench);
+         return;
+     }
+     
+     // Resolve the pattern by name, or take the one defined last
+     if (bench.pattern_name) {
+         size_t index = 0;
+         rift_dsl_pattern_t *pattern = file->patterns;
+         while (pattern && strcmp(pattern->name, bench.pattern_name) != 0) {
+             pattern = pattern->next;
+             index++;
+         }
+         if (!pattern) {
+             char message[128];
+             snprintf(message, sizeof(message), "Unknown pattern in bench: '%s'",
+                      bench.pattern_name);
+             rift_dsl_lexer_error(lexer, message);
+             rift_dsl_bench_free(&bench);
+             return;
+         }
+         bench.pattern_index = index;
+     } else if (file->pattern_count > 0) {
+         bench.pattern_index = file->pattern_count - 1;
+     } else {
+         rift_dsl_lexer_error(lexer, "A bench without a pattern name must follow a pattern");
+         rift_dsl_bench_free(&bench);
+         return;
+     }
+     
+     if (!rift_dsl_file_add_bench(file, &bench)) {
+         rift_dsl_lexer_error(lexer, "Failed to add bench to file");
+         rift_dsl_bench_free(&bench);
+     }
+ }
+ 
+ /**
+  * @brief Parse a rule combination definition
+  * 
+  * The expression is kept as written; the compiler resolves its rule names,
+  * so a combination may name patterns defined after it. Streaming parses
+  * keep combinations too, as they are needed once every pattern compiled.
+  * 
+  * @param lexer The lexer, just past @combine
+  * @param file The DSL file to add the combination to
+  */
+ static void
+ rift_dsl_parse_combination(rift_dsl_lexer_t *lexer, rift_dsl_file_t *file)
+ {
+     // Expect: @combine NAME = "A & B & !C"
+     
+     rift_dsl_token_t token = rift_dsl_lexer_next_token(lexer);
+     if (token.type != RIFT_DSL_TOKEN_IDENTIFIER) {
+         rift_dsl_lexer_error(lexer, "Expected combination name");
+         rift_dsl_token_free(&token);
+         return;
+     }
+     
+     rift_dsl_combination_t *combination =
+         (rift_dsl_combination_t *)calloc(1, sizeof(rift_dsl_combination_t));
+     if (!combination) {
+         rift_dsl_lexer_error(lexer, "Memory allocation failed");
+         rift_dsl_token_free(&token);
+         return;
+     }
+     
+     combination->name = token.value;
+     token.value = NULL; // Prevent double free
+     
+     // Expect equals sign
+     token = rift_dsl_lexer_next_token(lexer);
+     if (token.type != RIFT_DSL_TOKEN_EQUALS) {
+         rift_dsl_lexer_error(lexer, "Expected = after combination name");
+         rift_dsl_token_free(&token);
+         rift_dsl_combination_free(combination);
+         return;
+     }
+     
+     rift_dsl_token_free(&token);
+     
+     // Get the expression string
+     token = rift_dsl_lexer_next_token(lexer);
+     if (token.type != RIFT_DSL_TOKEN_STRING) {
+         rift_dsl_lexer_error(lexer, "Expected combination expression string");
+         rift_dsl_token_free(&token);
+         rift_dsl_combination_free(combination);
+         return;
+     }
+     
+     combination->expression = token.value;
+     token.value = NULL; // Prevent double free
+     
+     if (!rift_dsl_file_add_combination(file, combination)) {
+         rift_dsl_lexer_error(lexer, "Failed to add combination to file");
+         rift_dsl_combination_free(combination);
+     }
+ }
@@ -0,0 +1,297 @@
+/**
+ * @file rift_dsl_profile.c
+ * @brief Implementation of the match profiles of .rift rules
+ *
+ * Entries are kept sorted by name, so the compiler's lookups and the
+ * records of a matching loop both take a binary search.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/dsl/rift_dsl_profile.h"
+#include <ctype.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Header line written at the top of a saved profile
+ */
+#define PROFILE_HEADER "# librift dsl profile: name searches matches steps\n"
+
+struct rift_dsl_profile {
+    rift_dsl_profile_entry_t *entries; /**< Entries ordered by name */
+    size_t count;                      /**< Number of entries */
+    size_t capacity;                   /**< Number of entries allocated */
+};
+
+/**
+ * @brief Find where a name is, or would be inserted
+ *
+ * @param profile The profile
+ * @param name The name
+ * @param found Pointer to store whether the entry exists
+ * @return Index of the entry or of the insertion point
+ */
+static size_t
+profile_search(const rift_dsl_profile_t *profile, const char *name, bool *found)
+{
+    size_t low = 0;
+    size_t high = profile->count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        int order = strcmp(profile->entries[mid].name, name);
+        if (order == 0) {
+            *found = true;
+            return mid;
+        }
+        if (order < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    *found = false;
+    return low;
+}
+
+/**
+ * @brief Check that a name can be written to the text form
+ *
+ * @param name The name
+ * @return true if it is non-empty, short enough and has no white space
+ */
+static bool
+profile_name_valid(const char *name)
+{
+    size_t length = strlen(name);
+    if (length == 0 || length > RIFT_DSL_PROFILE_MAX_NAME) {
+        return false;
+    }
+    for (size_t i = 0; i < length; i++) {
+        if (isspace((unsigned char)name[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Get the entry of a name, adding an empty one if needed
+ *
+ * @param profile The profile
+ * @param name The name
+ * @return The entry or NULL on invalid name or allocation failure
+ */
+static rift_dsl_profile_entry_t *
+profile_entry(rift_dsl_profile_t *profile, const char *name)
+{
+    bool found = false;
+    size_t index = profile_search(profile, name, &found);
+    if (found) {
+        return &profile->entries[index];
+    }
+    if (!profile_name_valid(name)) {
+        return NULL;
+    }
+
+    if (profile->count == profile->capacity) {
+        size_t capacity = profile->capacity > 0 ? profile->capacity * 2 : 16;
+        rift_dsl_profile_entry_t *entries = (rift_dsl_profile_entry_t *)realloc(
+            profile->entries, capacity * sizeof(rift_dsl_profile_entry_t));
+        if (!entries) {
+            return NULL;
+        }
+        profile->entries = entries;
+        profile->capacity = capacity;
+    }
+
+    char *copy = strdup(name);
+    if (!copy) {
+        return NULL;
+    }
+    memmove(&profile->entries[index + 1], &profile->entries[index],
+            (profile->count - index) * sizeof(rift_dsl_profile_entry_t));
+    profile->count++;
+
+    rift_dsl_profile_entry_t *entry = &profile->entries[index];
+    memset(entry, 0, sizeof(*entry));
+    entry->name = copy;
+    return entry;
+}
+
+rift_dsl_profile_t *
+rift_dsl_profile_create(void)
+{
+    return (rift_dsl_profile_t *)calloc(1, sizeof(rift_dsl_profile_t));
+}
+
+void
+rift_dsl_profile_free(rift_dsl_profile_t *profile)
+{
+    if (!profile) {
+        return;
+    }
+
+    for (size_t i = 0; i < profile->count; i++) {
+        free((char *)profile->entries[i].name);
+    }
+    free(profile->entries);
+    free(profile);
+}
+
+bool
+rift_dsl_profile_record(rift_dsl_profile_t *profile, const char *name, bool matched,
+                        const rift_match_stats_t *stats)
+{
+    if (!profile || !name) {
+        return false;
+    }
+
+    rift_dsl_profile_entry_t *entry = profile_entry(profile, name);
+    if (!entry) {
+        return false;
+    }
+
+    entry->searches++;
+    entry->matches += matched ? 1 : 0;
+    entry->steps += stats ? stats->steps : 0;
+    return true;
+}
+
+bool
+rift_dsl_profile_merge(rift_dsl_profile_t *total, const rift_dsl_profile_t *profile)
+{
+    if (!total || !profile || total == profile) {
+        return false;
+    }
+
+    for (size_t i = 0; i < profile->count; i++) {
+        const rift_dsl_profile_entry_t *source = &profile->entries[i];
+        rift_dsl_profile_entry_t *entry = profile_entry(total, source->name);
+        if (!entry) {
+            return false;
+        }
+        entry->searches += source->searches;
+        entry->matches += source->matches;
+        entry->steps += source->steps;
+    }
+    return true;
+}
+
+const rift_dsl_profile_entry_t *
+rift_dsl_profile_find(const rift_dsl_profile_t *profile, const char *name)
+{
+    if (!profile || !name) {
+        return NULL;
+    }
+
+    bool found = false;
+    size_t index = profile_search(profile, name, &found);
+    return found ? &profile->entries[index] : NULL;
+}
+
+size_t
+rift_dsl_profile_get_count(const rift_dsl_profile_t *profile)
+{
+    return profile ? profile->count : 0;
+}
+
+const rift_dsl_profile_entry_t *
+rift_dsl_profile_get_entry(const rift_dsl_profile_t *profile, size_t index)
+{
+    if (!profile || index >= profile->count) {
+        return NULL;
+    }
+    return &profile->entries[index];
+}
+
+bool
+rift_dsl_profile_save(const rift_dsl_profile_t *profile, const char *filename)
+{
+    if (!profile || !filename) {
+        return false;
+    }
+
+    FILE *file = fopen(filename, "w");
+    if (!file) {
+        return false;
+    }
+
+    bool written = fputs(PROFILE_HEADER, file) >= 0;
+    for (size_t i = 0; written && i < profile->count; i++) {
+        const rift_dsl_profile_entry_t *entry = &profile->entries[i];
+        written = fprintf(file, "%s %" PRIu64 " %" PRIu64 " %" PRIu64 "\n", entry->name,
+                          entry->searches, entry->matches, entry->steps) > 0;
+    }
+    return fclose(file) == 0 && written;
+}
+
+rift_dsl_profile_t *
+rift_dsl_profile_load(const char *filename, char *error_message, size_t error_size)
+{
+    if (error_message && error_size > 0) {
+        error_message[0] = '\0';
+    }
+    if (!filename) {
+        return NULL;
+    }
+
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        if (error_message && error_size > 0) {
+            snprintf(error_message, error_size, "Cannot open profile '%s'", filename);
+        }
+        return NULL;
+    }
+
+    rift_dsl_profile_t *profile = rift_dsl_profile_create();
+    char line[RIFT_DSL_PROFILE_MAX_NAME + 128];
+    size_t line_number = 0;
+    while (profile && fgets(line, sizeof(line), file)) {
+        line_number++;
+        const char *start = line;
+        while (isspace((unsigned char)*start)) {
+            start++;
+        }
+        if (*start == '\0' || *start == '#') {
+            continue;
+        }
+
+        char name[RIFT_DSL_PROFILE_MAX_NAME + 1];
+        uint64_t searches = 0;
+        uint64_t matches = 0;
+        uint64_t steps = 0;
+        char extra;
+        rift_dsl_profile_entry_t *entry = NULL;
+        bool parsed = strchr(line, '\n') != NULL || feof(file);
+        parsed = parsed &&
+                 sscanf(start, "%255s %" SCNu64 " %" SCNu64 " %" SCNu64 " %c", name, &searches,
+                        &matches, &steps, &extra) == 4 &&
+                 matches <= searches;
+        if (parsed) {
+            entry = profile_entry(profile, name);
+        }
+        if (!entry) {
+            if (error_message && error_size > 0) {
+                snprintf(error_message, error_size, "Invalid profile entry at line %zu",
+                         line_number);
+            }
+            rift_dsl_profile_free(profile);
+            profile = NULL;
+            break;
+        }
+
+        entry->searches += searches;
+        entry->matches += matches;
+        entry->steps += steps;
+    }
+
+    fclose(file);
+    if (!profile && error_message && error_size > 0 && error_message[0] == '\0') {
+        snprintf(error_message, error_size, "Failed to allocate profile");
+    }
+    return profile;
+}
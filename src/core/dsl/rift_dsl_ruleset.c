@@ -0,0 +1,378 @@
+/**
+ * @file rift_dsl_ruleset.c
+ * @brief Implementation of the hot-swappable ruleset handle
+ *
+ * Readers count their pins in per-slot counters split into two phases. A
+ * swap unpublishes the old snapshot, then flips the phase twice, each time
+ * waiting for the pins counted in the phase it left to go. A reader that
+ * still holds the old snapshot pinned it before it was unpublished, so its
+ * pin is counted in one of the two phases and the wait covers it; a reader
+ * that pins afterwards loads the new snapshot whatever phase it counts in.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/dsl/rift_dsl_ruleset.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * @brief Size the reader slots are padded to, so threads do not share lines
+ */
+#define RULESET_CACHE_LINE 64
+
+/**
+ * @brief Polls of the reader slots before a swap starts sleeping between them
+ */
+#define RULESET_SPIN_POLLS 64
+
+/**
+ * @brief A published compilation
+ */
+typedef struct ruleset_snapshot {
+    void *compilation;   /**< The compilation, NULL for none */
+    uint64_t generation; /**< Swaps made before it was published */
+} ruleset_snapshot_t;
+
+/**
+ * @brief Pin counters of the readers that use a slot
+ */
+typedef struct ruleset_slot {
+    _Alignas(RULESET_CACHE_LINE) atomic_size_t pins[2]; /**< Pins counted in each phase */
+} ruleset_slot_t;
+
+struct rift_dsl_ruleset {
+    _Atomic(ruleset_snapshot_t *) current;                /**< Published snapshot */
+    atomic_uint phase;                                    /**< Phase new pins count in */
+    pthread_mutex_t swap_lock;                            /**< Serializes swaps */
+    _Atomic(const rift_allocator_t *) allocator;          /**< Allocator, NULL for none */
+    ruleset_slot_t slots[RIFT_DSL_RULESET_READER_SLOTS]; /**< Reader pin counters */
+};
+
+/* Every thread gets an index on its first pin; it picks the thread's slot */
+static pthread_once_t thread_index_once = PTHREAD_ONCE_INIT;
+static pthread_key_t thread_index_key;
+static bool thread_index_key_created = false;
+static atomic_size_t next_thread_index = 0;
+
+static void
+create_thread_index_key(void)
+{
+    thread_index_key_created = pthread_key_create(&thread_index_key, NULL) == 0;
+}
+
+/**
+ * @brief Get the reader slot of the calling thread
+ *
+ * @return Index of the slot
+ */
+static size_t
+thread_slot(void)
+{
+    pthread_once(&thread_index_once, create_thread_index_key);
+    if (!thread_index_key_created) {
+        return 0;
+    }
+
+    // The key holds the index plus one, as a missing value reads as NULL
+    uintptr_t stored = (uintptr_t)pthread_getspecific(thread_index_key);
+    if (stored == 0) {
+        stored = (uintptr_t)atomic_fetch_add(&next_thread_index, 1) + 1;
+        pthread_setspecific(thread_index_key, (void *)stored);
+    }
+    return (size_t)(stored - 1) % RIFT_DSL_RULESET_READER_SLOTS;
+}
+
+/**
+ * @brief Create a snapshot of a compilation
+ *
+ * @param compilation The compilation (can be NULL)
+ * @param generation Swaps made before it is published
+ * @return A new snapshot or NULL on failure
+ */
+static ruleset_snapshot_t *
+snapshot_create(void *compilation, uint64_t generation)
+{
+    ruleset_snapshot_t *snapshot = malloc(sizeof(ruleset_snapshot_t));
+    if (!snapshot) {
+        return NULL;
+    }
+    snapshot->compilation = compilation;
+    snapshot->generation = generation;
+    return snapshot;
+}
+
+/**
+ * @brief Free a snapshot and its compilation
+ *
+ * @param snapshot The snapshot
+ */
+static void
+snapshot_free(ruleset_snapshot_t *snapshot)
+{
+    if (snapshot->compilation) {
+        rift_dsl_free_compilation(snapshot->compilation);
+    }
+    free(snapshot);
+}
+
+/**
+ * @brief Make the allocator of a ruleset the one in use on the thread
+ *
+ * @param ruleset The ruleset
+ * @return The allocator to restore with rift_allocator_use afterwards
+ */
+static const rift_allocator_t *
+ruleset_allocator_enter(rift_dsl_ruleset_t *ruleset)
+{
+    const rift_allocator_t *outer = rift_allocator_current();
+    const rift_allocator_t *allocator = atomic_load(&ruleset->allocator);
+    if (allocator) {
+        rift_allocator_use(allocator);
+    }
+    return outer;
+}
+
+/**
+ * @brief Wait until no reader holds a pin taken before the call
+ *
+ * Must be called with the swap lock held.
+ *
+ * @param ruleset The ruleset
+ */
+static void
+wait_for_readers(rift_dsl_ruleset_t *ruleset)
+{
+    // Two flips: a reader may have read the phase before the first one and
+    // counted its pin in it after the wait for that phase was over
+    for (int flip = 0; flip < 2; flip++) {
+        unsigned phase = atomic_load(&ruleset->phase);
+        atomic_store(&ruleset->phase, phase ^ 1);
+
+        for (size_t i = 0; i < RIFT_DSL_RULESET_READER_SLOTS; i++) {
+            size_t polls = 0;
+            while (atomic_load(&ruleset->slots[i].pins[phase]) != 0) {
+                if (++polls < RULESET_SPIN_POLLS) {
+                    sched_yield();
+                } else {
+                    struct timespec pause = {0, 50000};
+                    nanosleep(&pause, NULL);
+                }
+            }
+        }
+    }
+}
+
+rift_dsl_ruleset_t *
+rift_dsl_ruleset_create(void *compilation)
+{
+    rift_dsl_ruleset_t *ruleset = aligned_alloc(RULESET_CACHE_LINE, sizeof(rift_dsl_ruleset_t));
+    if (!ruleset) {
+        return NULL;
+    }
+    memset(ruleset, 0, sizeof(rift_dsl_ruleset_t));
+
+    ruleset_snapshot_t *snapshot = snapshot_create(compilation, 0);
+    if (!snapshot) {
+        free(ruleset);
+        return NULL;
+    }
+    if (pthread_mutex_init(&ruleset->swap_lock, NULL) != 0) {
+        free(snapshot);
+        free(ruleset);
+        return NULL;
+    }
+
+    atomic_init(&ruleset->current, snapshot);
+    atomic_init(&ruleset->phase, 0);
+    atomic_init(&ruleset->allocator, NULL);
+    for (size_t i = 0; i < RIFT_DSL_RULESET_READER_SLOTS; i++) {
+        atomic_init(&ruleset->slots[i].pins[0], 0);
+        atomic_init(&ruleset->slots[i].pins[1], 0);
+    }
+
+    return ruleset;
+}
+
+void
+rift_dsl_ruleset_free(rift_dsl_ruleset_t *ruleset)
+{
+    if (!ruleset) {
+        return;
+    }
+
+    snapshot_free(atomic_load(&ruleset->current));
+    pthread_mutex_destroy(&ruleset->swap_lock);
+    free(ruleset);
+}
+
+void *
+rift_dsl_ruleset_pin(rift_dsl_ruleset_t *ruleset, rift_dsl_ruleset_guard_t *guard)
+{
+    if (!guard) {
+        return NULL;
+    }
+    memset(guard, 0, sizeof(*guard));
+    if (!ruleset) {
+        return NULL;
+    }
+
+    guard->slot = thread_slot();
+    guard->phase = atomic_load(&ruleset->phase);
+    atomic_fetch_add(&ruleset->slots[guard->slot].pins[guard->phase], 1);
+
+    // Loaded after the pin is counted, so a swap that missed the pin has
+    // already published its snapshot and this one cannot be the old one
+    ruleset_snapshot_t *snapshot = atomic_load(&ruleset->current);
+    guard->compilation = snapshot->compilation;
+    guard->generation = snapshot->generation;
+
+    return guard->compilation;
+}
+
+void
+rift_dsl_ruleset_unpin(rift_dsl_ruleset_t *ruleset, rift_dsl_ruleset_guard_t *guard)
+{
+    if (!ruleset || !guard) {
+        return;
+    }
+
+    atomic_fetch_sub(&ruleset->slots[guard->slot].pins[guard->phase], 1);
+    guard->compilation = NULL;
+}
+
+bool
+rift_dsl_ruleset_swap(rift_dsl_ruleset_t *ruleset, void *compilation)
+{
+    if (!ruleset) {
+        return false;
+    }
+
+    pthread_mutex_lock(&ruleset->swap_lock);
+
+    ruleset_snapshot_t *old_snapshot = atomic_load(&ruleset->current);
+    ruleset_snapshot_t *snapshot = snapshot_create(compilation, old_snapshot->generation + 1);
+    if (!snapshot) {
+        pthread_mutex_unlock(&ruleset->swap_lock);
+        return false;
+    }
+
+    atomic_store(&ruleset->current, snapshot);
+    wait_for_readers(ruleset);
+
+    pthread_mutex_unlock(&ruleset->swap_lock);
+
+    snapshot_free(old_snapshot);
+    return true;
+}
+
+bool
+rift_dsl_ruleset_reload(rift_dsl_ruleset_t *ruleset, const char *source,
+                        const rift_dsl_compile_options_t *options, char *error_message,
+                        size_t error_size)
+{
+    if (error_message && error_size > 0) {
+        error_message[0] = '\0';
+    }
+    if (!ruleset || !source) {
+        return false;
+    }
+
+    // Compiled before the swap lock is taken, so a slow compilation does
+    // not hold up a concurrent swap
+    const rift_allocator_t *outer = ruleset_allocator_enter(ruleset);
+    void *compilation = rift_dsl_compile_with_options(source, options);
+    rift_allocator_use(outer);
+    if (!compilation) {
+        if (error_message && error_size > 0) {
+            snprintf(error_message, error_size, "Failed to compile ruleset");
+        }
+        return false;
+    }
+
+    const char *error = rift_dsl_get_compilation_error(compilation);
+    if (error) {
+        if (error_message && error_size > 0) {
+            snprintf(error_message, error_size, "%s", error);
+        }
+        rift_dsl_free_compilation(compilation);
+        return false;
+    }
+
+    if (!rift_dsl_ruleset_swap(ruleset, compilation)) {
+        if (error_message && error_size > 0) {
+            snprintf(error_message, error_size, "Failed to publish ruleset");
+        }
+        rift_dsl_free_compilation(compilation);
+        return false;
+    }
+
+    return true;
+}
+
+bool
+rift_dsl_ruleset_set_allocator(rift_dsl_ruleset_t *ruleset, const rift_allocator_t *allocator)
+{
+    if (!ruleset) {
+        return false;
+    }
+
+    atomic_store(&ruleset->allocator, allocator);
+    return true;
+}
+
+bool
+rift_dsl_ruleset_execute(rift_dsl_ruleset_t *ruleset, size_t index, const char *input,
+                         size_t input_length, rift_regex_match_t *match)
+{
+    rift_dsl_ruleset_guard_t guard;
+    void *compilation = rift_dsl_ruleset_pin(ruleset, &guard);
+    if (!compilation) {
+        rift_dsl_ruleset_unpin(ruleset, &guard);
+        return false;
+    }
+
+    const rift_allocator_t *outer = ruleset_allocator_enter(ruleset);
+    bool matched = rift_dsl_execute(compilation, index, input, input_length, match);
+    rift_allocator_use(outer);
+
+    rift_dsl_ruleset_unpin(ruleset, &guard);
+    return matched;
+}
+
+size_t
+rift_dsl_ruleset_execute_all(rift_dsl_ruleset_t *ruleset, const char *input, size_t input_length,
+                             rift_dsl_match_callback_t callback, void *user_data)
+{
+    rift_dsl_ruleset_guard_t guard;
+    void *compilation = rift_dsl_ruleset_pin(ruleset, &guard);
+    if (!compilation) {
+        rift_dsl_ruleset_unpin(ruleset, &guard);
+        return 0;
+    }
+
+    const rift_allocator_t *outer = ruleset_allocator_enter(ruleset);
+    size_t matched = rift_dsl_execute_all(compilation, input, input_length, callback, user_data);
+    rift_allocator_use(outer);
+
+    rift_dsl_ruleset_unpin(ruleset, &guard);
+    return matched;
+}
+
+uint64_t
+rift_dsl_ruleset_generation(rift_dsl_ruleset_t *ruleset)
+{
+    // Pinned, as a swap may free the snapshot as soon as it is unpublished
+    rift_dsl_ruleset_guard_t guard;
+    rift_dsl_ruleset_pin(ruleset, &guard);
+    uint64_t generation = guard.generation;
+    rift_dsl_ruleset_unpin(ruleset, &guard);
+
+    return generation;
+}
@@ -0,0 +1,813 @@
+/**
+ * @file rift_test_runner.c
+ * @brief Implementation of the test runner for .rift DSL files
+ *
+ * The patterns of a file are compiled once, on several threads, and each
+ * program is shared by the test cases that check its pattern. The test cases
+ * are then taken in chunks by the running threads; every result has its own
+ * slot, so the threads only share the counter handing out the chunks.
+ * Benchmarks follow on the calling thread alone.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/dsl/rift_test_runner.h"
+#include <glob.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "core/runtime/match_types.h"
+
+/**
+ * @brief Test cases a thread takes at a time
+ */
+#define TEST_RUNNER_CHUNK 64
+
+/**
+ * @brief Results of a test run, with the file and programs they refer into
+ */
+typedef struct test_run {
+    void *dsl;                    /**< Parsed file, owning names, inputs and groups */
+    void *compilation;            /**< Programs shared by the test cases */
+    rift_test_results_t results;  /**< One result per test case */
+    rift_bench_result_t *benches; /**< One result per benchmark run */
+    size_t bench_count;           /**< Number of benchmarks run */
+    char *base_dir;               /**< Directory of relative corpus globs, NULL for the cwd */
+    char error_message[256];      /**< Error of the run */
+    bool has_error;               /**< Whether the run failed */
+} test_run_t;
+
+/**
+ * @brief One input of a benchmark pass
+ */
+typedef struct test_bench_input {
+    const char *data; /**< Input bytes */
+    size_t length;    /**< Number of input bytes */
+    char *owned;      /**< Buffer read from a corpus file, NULL for an inline input */
+} test_bench_input_t;
+
+/**
+ * @brief Test cases shared out among the running threads
+ */
+typedef struct test_job {
+    test_run_t *run;    /**< The run whose results are filled */
+    atomic_size_t next; /**< First test case of the next chunk */
+} test_job_t;
+
+/**
+ * @brief Read the monotonic clock for the test timings
+ */
+static uint64_t
+test_clock_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief Set the error of a run
+ *
+ * @param run The run
+ * @param message The error message
+ */
+static void
+test_run_error(test_run_t *run, const char *message)
+{
+    run->has_error = true;
+    snprintf(run->error_message, sizeof(run->error_message), "%s", message);
+}
+
+/**
+ * @brief Run test cases until none is left
+ *
+ * @param arg The job
+ * @return NULL
+ */
+static void *
+test_worker(void *arg)
+{
+    test_job_t *job = (test_job_t *)arg;
+    test_run_t *run = job->run;
+
+    while (true) {
+        size_t first = atomic_fetch_add(&job->next, TEST_RUNNER_CHUNK);
+        if (first >= run->results.count) {
+            break;
+        }
+
+        size_t last = first + TEST_RUNNER_CHUNK;
+        if (last > run->results.count) {
+            last = run->results.count;
+        }
+        for (size_t i = first; i < last; i++) {
+            rift_test_result_t *result = &run->results.results[i];
+            uint64_t start = test_clock_ns();
+            result->actual_match =
+                rift_dsl_execute(run->compilation, result->pattern_index, result->test_input,
+                                 strlen(result->test_input), NULL);
+            result->elapsed_ns = test_clock_ns() - start;
+            result->passed = result->actual_match == result->expected_match;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Fill the results of a run from the test cases of its file
+ *
+ * @param run The run, holding its parsed file and compilation
+ * @return true if successful, false otherwise
+ */
+static bool
+test_run_prepare(test_run_t *run)
+{
+    size_t count = rift_dsl_get_test_case_count(run->dsl);
+    size_t num_programs = rift_dsl_get_compiled_count(run->compilation);
+    run->results.results = (rift_test_result_t *)calloc(count > 0 ? count : 1,
+                                                        sizeof(rift_test_result_t));
+    if (!run->results.results) {
+        test_run_error(run, "Failed to allocate test results");
+        return false;
+    }
+    run->results.count = count;
+
+    for (size_t i = 0; i < count; i++) {
+        rift_test_result_t *result = &run->results.results[i];
+        const char *name = NULL;
+        const char *pattern = NULL;
+        const char **groups = NULL;
+        if (!rift_dsl_get_test_case(run->dsl, i, &result->test_input, &result->expected_match) ||
+            !rift_dsl_get_test_case_pattern(run->dsl, i, &result->pattern_index) ||
+            !rift_dsl_get_pattern(run->dsl, result->pattern_index, &name, &pattern) ||
+            result->pattern_index >= num_programs) {
+            char message[128];
+            snprintf(message, sizeof(message), "Failed to read test case %zu", i);
+            test_run_error(run, message);
+            return false;
+        }
+
+        result->pattern_name = name;
+        result->test_input = result->test_input ? result->test_input : "";
+        if (rift_dsl_get_test_case_groups(run->dsl, i, &groups, &result->group_count)) {
+            result->expected_groups = (char **)groups;
+        }
+        result->compile_ns = rift_dsl_get_compile_ns(run->compilation, result->pattern_index);
+    }
+    return true;
+}
+
+/**
+ * @brief Run the test cases of a run on several threads
+ *
+ * @param run The prepared run
+ * @param num_threads Threads including the caller's
+ */
+static void
+test_run_execute(test_run_t *run, size_t num_threads)
+{
+    test_job_t job;
+    job.run = run;
+    atomic_init(&job.next, 0);
+
+    // No more threads than chunks; the caller is the first
+    size_t num_chunks = (run->results.count + TEST_RUNNER_CHUNK - 1) / TEST_RUNNER_CHUNK;
+    if (num_threads > num_chunks) {
+        num_threads = num_chunks > 0 ? num_chunks : 1;
+    }
+    pthread_t *threads = num_threads > 1
+                             ? (pthread_t *)calloc(num_threads - 1, sizeof(pthread_t))
+                             : NULL;
+    bool *started = num_threads > 1 ? (bool *)calloc(num_threads - 1, sizeof(bool)) : NULL;
+    if (!threads || !started) {
+        num_threads = 1;
+    }
+
+    for (size_t t = 1; t < num_threads; t++) {
+        started[t - 1] = pthread_create(&threads[t - 1], NULL, test_worker, &job) == 0;
+    }
+    test_worker(&job);
+    for (size_t t = 1; t < num_threads; t++) {
+        if (started[t - 1]) {
+            pthread_join(threads[t - 1], NULL);
+        }
+    }
+    free(threads);
+    free(started);
+
+    for (size_t i = 0; i < run->results.count; i++) {
+        if (run->results.results[i].passed) {
+            run->results.passed_count++;
+        } else {
+            run->results.failed_count++;
+        }
+    }
+}
+
+/**
+ * @brief Read a whole file
+ *
+ * @param filename Path of the file
+ * @param length Pointer to store the number of bytes read
+ * @return The bytes, NUL-terminated, or NULL on failure
+ */
+static char *
+test_read_file(const char *filename, size_t *length)
+{
+    FILE *file = fopen(filename, "rb");
+    if (!file) {
+        return NULL;
+    }
+
+    char *data = NULL;
+    long size = -1;
+    if (fseek(file, 0, SEEK_END) == 0) {
+        size = ftell(file);
+    }
+    if (size >= 0 && fseek(file, 0, SEEK_SET) == 0) {
+        data = (char *)malloc((size_t)size + 1);
+    }
+    if (data && fread(data, 1, (size_t)size, file) != (size_t)size) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    if (!data) {
+        return NULL;
+    }
+
+    data[size] = '\0';
+    *length = (size_t)size;
+    return data;
+}
+
+/**
+ * @brief Free the inputs of a benchmark
+ *
+ * @param inputs The inputs
+ * @param count Number of inputs
+ */
+static void
+test_bench_inputs_free(test_bench_input_t *inputs, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        free(inputs[i].owned);
+    }
+    free(inputs);
+}
+
+/**
+ * @brief Load the inputs of a benchmark
+ *
+ * @param run The run, which gets an error on failure
+ * @param bench The benchmark
+ * @param count Pointer to store the number of inputs
+ * @return The inputs, or NULL on failure
+ */
+static test_bench_input_t *
+test_bench_load(test_run_t *run, const rift_dsl_bench_t *bench, size_t *count)
+{
+    char message[256];
+    if (bench->input) {
+        test_bench_input_t *inputs = (test_bench_input_t *)calloc(1, sizeof(test_bench_input_t));
+        if (!inputs) {
+            test_run_error(run, "Failed to allocate bench inputs");
+            return NULL;
+        }
+        inputs[0].data = bench->input;
+        inputs[0].length = strlen(bench->input);
+        *count = 1;
+        return inputs;
+    }
+
+    // A relative glob is taken from the directory of the file
+    char *pattern = NULL;
+    if (run->base_dir && bench->corpus[0] != '/') {
+        size_t size = strlen(run->base_dir) + strlen(bench->corpus) + 2;
+        pattern = (char *)malloc(size);
+        if (pattern) {
+            snprintf(pattern, size, "%s/%s", run->base_dir, bench->corpus);
+        }
+    } else {
+        pattern = strdup(bench->corpus);
+    }
+    if (!pattern) {
+        test_run_error(run, "Failed to allocate bench corpus path");
+        return NULL;
+    }
+
+    glob_t paths;
+    int status = glob(pattern, 0, NULL, &paths);
+    free(pattern);
+    if (status != 0 || paths.gl_pathc == 0) {
+        if (status != GLOB_NOMATCH) {
+            globfree(&paths);
+        }
+        snprintf(message, sizeof(message), "Bench corpus '%s' matches no file", bench->corpus);
+        test_run_error(run, message);
+        return NULL;
+    }
+
+    test_bench_input_t *inputs =
+        (test_bench_input_t *)calloc(paths.gl_pathc, sizeof(test_bench_input_t));
+    if (!inputs) {
+        globfree(&paths);
+        test_run_error(run, "Failed to allocate bench inputs");
+        return NULL;
+    }
+    for (size_t i = 0; i < paths.gl_pathc; i++) {
+        inputs[i].owned = test_read_file(paths.gl_pathv[i], &inputs[i].length);
+        if (!inputs[i].owned) {
+            snprintf(message, sizeof(message), "Failed to read bench corpus file '%s'",
+                     paths.gl_pathv[i]);
+            test_run_error(run, message);
+            test_bench_inputs_free(inputs, i);
+            globfree(&paths);
+            return NULL;
+        }
+        inputs[i].data = inputs[i].owned;
+    }
+    *count = paths.gl_pathc;
+    globfree(&paths);
+    return inputs;
+}
+
+/**
+ * @brief Search every input of a benchmark for successive matches
+ *
+ * Programs match at the start of their input, so the search tries each
+ * position in turn and resumes after a match, or one byte further after an
+ * empty one.
+ *
+ * @param compilation The compilation
+ * @param index Index of the timed program
+ * @param inputs The inputs
+ * @param count Number of inputs
+ * @return Number of matches found
+ */
+static size_t
+test_bench_pass(void *compilation, size_t index, const test_bench_input_t *inputs, size_t count)
+{
+    size_t matches = 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t position = 0;
+        while (position <= inputs[i].length) {
+            rift_regex_match_t match = {0};
+            if (rift_dsl_execute(compilation, index, inputs[i].data + position,
+                                 inputs[i].length - position, &match)) {
+                matches++;
+                position += match.end_pos > 0 ? match.end_pos : 1;
+            } else {
+                position++;
+            }
+        }
+    }
+    return matches;
+}
+
+/**
+ * @brief Order samples for qsort
+ */
+static int
+test_compare_samples(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Get the median of sorted samples
+ *
+ * @param samples The samples, sorted
+ * @param count Number of samples, at least 1
+ * @return The median
+ */
+static double
+test_median(const double *samples, size_t count)
+{
+    if (count % 2 == 1) {
+        return samples[count / 2];
+    }
+    return (samples[count / 2 - 1] + samples[count / 2]) / 2.0;
+}
+
+/**
+ * @brief Run a benchmark and fill its result
+ *
+ * @param run The run, holding the compilation
+ * @param bench The benchmark
+ * @param result The result to fill
+ * @return true if successful, false otherwise
+ */
+static bool
+test_bench_run(test_run_t *run, const rift_dsl_bench_t *bench, rift_bench_result_t *result)
+{
+    size_t count = 0;
+    test_bench_input_t *inputs = test_bench_load(run, bench, &count);
+    if (!inputs) {
+        return false;
+    }
+
+    double *samples = (double *)malloc(bench->iterations * sizeof(double));
+    if (!samples) {
+        test_bench_inputs_free(inputs, count);
+        test_run_error(run, "Failed to allocate bench samples");
+        return false;
+    }
+
+    size_t bytes = 0;
+    for (size_t i = 0; i < count; i++) {
+        bytes += inputs[i].length;
+    }
+    // An empty input still costs the attempt at its end
+    double divisor = bytes > 0 ? (double)bytes : 1.0;
+
+    size_t matches = 0;
+    for (size_t i = 0; i < bench->warmup; i++) {
+        matches = test_bench_pass(run->compilation, bench->pattern_index, inputs, count);
+    }
+    for (size_t i = 0; i < bench->iterations; i++) {
+        uint64_t start = test_clock_ns();
+        matches = test_bench_pass(run->compilation, bench->pattern_index, inputs, count);
+        samples[i] = (double)(test_clock_ns() - start) / divisor;
+    }
+
+    qsort(samples, bench->iterations, sizeof(double), test_compare_samples);
+    double median = test_median(samples, bench->iterations);
+    size_t p99 = (bench->iterations * 99 + 99) / 100;
+    result->median_ns_per_byte = median;
+    result->p99_ns_per_byte = samples[p99 - 1];
+
+    // The deviations, sorted again, give the MAD
+    for (size_t i = 0; i < bench->iterations; i++) {
+        samples[i] = samples[i] > median ? samples[i] - median : median - samples[i];
+    }
+    qsort(samples, bench->iterations, sizeof(double), test_compare_samples);
+    result->mad_ns_per_byte = test_median(samples, bench->iterations);
+
+    double pass_ns = median * divisor;
+    result->iterations = bench->iterations;
+    result->warmup = bench->warmup;
+    result->input_count = count;
+    result->input_bytes = bytes;
+    result->matches = matches;
+    result->matches_per_second = pass_ns > 0.0 ? (double)matches * 1e9 / pass_ns : 0.0;
+
+    free(samples);
+    test_bench_inputs_free(inputs, count);
+    return true;
+}
+
+/**
+ * @brief Run the benchmarks of a run on the calling thread
+ *
+ * @param run The run, whose tests have run
+ */
+static void
+test_run_benches(test_run_t *run)
+{
+    size_t count = rift_dsl_get_bench_count(run->dsl);
+    if (count == 0) {
+        return;
+    }
+
+    run->benches = (rift_bench_result_t *)calloc(count, sizeof(rift_bench_result_t));
+    if (!run->benches) {
+        test_run_error(run, "Failed to allocate bench results");
+        return;
+    }
+
+    size_t num_programs = rift_dsl_get_compiled_count(run->compilation);
+    for (size_t i = 0; i < count; i++) {
+        const rift_dsl_bench_t *bench = rift_dsl_get_bench(run->dsl, i);
+        rift_bench_result_t *result = &run->benches[i];
+        const char *pattern = NULL;
+        if (!bench || bench->pattern_index >= num_programs ||
+            !rift_dsl_get_pattern(run->dsl, bench->pattern_index, &result->pattern_name,
+                                  &pattern)) {
+            char message[128];
+            snprintf(message, sizeof(message), "Failed to read bench %zu", i);
+            test_run_error(run, message);
+            return;
+        }
+
+        result->pattern_index = bench->pattern_index;
+        if (!test_bench_run(run, bench, result)) {
+            return;
+        }
+        run->bench_count++;
+    }
+}
+
+/**
+ * @brief Run tests, then benchmarks if asked, from a .rift DSL source string
+ *
+ * @param source The .rift DSL source code
+ * @param options Options of the run (can be NULL)
+ * @param base_dir Directory of relative corpus globs (can be NULL for the cwd)
+ * @return The run or NULL on allocation failure
+ */
+static test_run_t *
+test_run_source(const char *source, const rift_test_run_options_t *options, const char *base_dir)
+{
+    test_run_t *run = (test_run_t *)calloc(1, sizeof(test_run_t));
+    if (!run) {
+        return NULL;
+    }
+    if (base_dir && !(run->base_dir = strdup(base_dir))) {
+        free(run);
+        return NULL;
+    }
+
+    size_t num_threads = options ? options->num_threads : 1;
+    if (num_threads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = cpus > 0 ? (size_t)cpus : 1;
+    }
+
+    // The patterns compile once, on the same threads as the tests
+    rift_dsl_compile_options_t compile_options = {num_threads, NULL};
+    run->dsl = rift_dsl_parse(source);
+    run->compilation = rift_dsl_compile_with_options(source, &compile_options);
+    if (!run->dsl || !run->compilation) {
+        test_run_error(run, "Failed to parse the test source");
+        return run;
+    }
+
+    const char *error = rift_dsl_get_error_message(run->dsl);
+    if (!error) {
+        error = rift_dsl_get_compilation_error(run->compilation);
+    }
+    if (error) {
+        test_run_error(run, error);
+        return run;
+    }
+
+    if (test_run_prepare(run)) {
+        test_run_execute(run, num_threads);
+    }
+    if (!run->has_error && options && options->run_benches) {
+        test_run_benches(run);
+    }
+    return run;
+}
+
+/**
+ * @brief Run tests from a .rift DSL source string on several threads
+ */
+void *
+rift_test_run_source_with_options(const char *source, const rift_test_run_options_t *options)
+{
+    if (!source) {
+        return NULL;
+    }
+
+    return test_run_source(source, options, NULL);
+}
+
+/**
+ * @brief Run tests from a .rift DSL source string
+ */
+void *
+rift_test_run_source(const char *source)
+{
+    return rift_test_run_source_with_options(source, NULL);
+}
+
+/**
+ * @brief Run tests from a .rift DSL file on several threads
+ */
+void *
+rift_test_run_file_with_options(const char *filename, const rift_test_run_options_t *options)
+{
+    if (!filename) {
+        return NULL;
+    }
+
+    size_t length = 0;
+    char *source = test_read_file(filename, &length);
+    if (!source) {
+        return NULL;
+    }
+
+    // Corpus globs are relative to the directory of the file
+    const char *slash = strrchr(filename, '/');
+    char *base_dir = slash ? strndup(filename, (size_t)(slash - filename)) : NULL;
+    if (slash && !base_dir) {
+        free(source);
+        return NULL;
+    }
+
+    test_run_t *run = test_run_source(source, options, base_dir);
+    free(base_dir);
+    free(source);
+    return run;
+}
+
+/**
+ * @brief Run tests from a .rift DSL file
+ */
+void *
+rift_test_run_file(const char *filename)
+{
+    return rift_test_run_file_with_options(filename, NULL);
+}
+
+/**
+ * @brief Free test results
+ */
+void
+rift_test_free_results(void *handle)
+{
+    test_run_t *run = (test_run_t *)handle;
+    if (!run) {
+        return;
+    }
+
+    free(run->results.results);
+    free(run->benches);
+    free(run->base_dir);
+    rift_dsl_free_compilation(run->compilation);
+    rift_dsl_free(run->dsl);
+    free(run);
+}
+
+/**
+ * @brief Get error message from failed test run
+ */
+const char *
+rift_test_get_error(void *handle)
+{
+    test_run_t *run = (test_run_t *)handle;
+    return run && run->has_error ? run->error_message : NULL;
+}
+
+/**
+ * @brief Get the number of test results
+ */
+size_t
+rift_test_get_result_count(void *handle)
+{
+    test_run_t *run = (test_run_t *)handle;
+    return run ? run->results.count : 0;
+}
+
+/**
+ * @brief Get a specific test result
+ */
+bool
+rift_test_get_result(void *handle, size_t index, rift_test_result_t *result)
+{
+    test_run_t *run = (test_run_t *)handle;
+    if (!run || !result || index >= run->results.count) {
+        return false;
+    }
+
+    *result = run->results.results[index];
+    return true;
+}
+
+/**
+ * @brief Get summary of test results
+ */
+bool
+rift_test_get_summary(void *handle, size_t *total, size_t *passed, size_t *failed)
+{
+    test_run_t *run = (test_run_t *)handle;
+    if (!run) {
+        return false;
+    }
+
+    if (total) {
+        *total = run->results.count;
+    }
+    if (passed) {
+        *passed = run->results.passed_count;
+    }
+    if (failed) {
+        *failed = run->results.failed_count;
+    }
+    return true;
+}
+
+/**
+ * @brief Print test results to stdout
+ */
+void
+rift_test_print_results(void *handle, bool verbose)
+{
+    test_run_t *run = (test_run_t *)handle;
+    if (!run) {
+        return;
+    }
+
+    if (run->has_error) {
+        printf("Test run failed: %s\n", run->error_message);
+        return;
+    }
+
+    for (size_t i = 0; i < run->results.count; i++) {
+        const rift_test_result_t *result = &run->results.results[i];
+        if (!verbose && result->passed) {
+            continue;
+        }
+        printf("[%s] %s on \"%s\": expected %s, got %s (%.3f us)\n",
+               result->passed ? "PASS" : "FAIL", result->pattern_name, result->test_input,
+               result->expected_match ? "match" : "no match",
+               result->actual_match ? "match" : "no match", (double)result->elapsed_ns / 1000.0);
+    }
+    printf("%zu tests, %zu passed, %zu failed\n", run->results.count, run->results.passed_count,
+           run->results.failed_count);
+}
+
+/**
+ * @brief Get the number of benchmark results
+ */
+size_t
+rift_test_get_bench_count(void *handle)
+{
+    test_run_t *run = (test_run_t *)handle;
+    return run ? run->bench_count : 0;
+}
+
+/**
+ * @brief Get a specific benchmark result
+ */
+bool
+rift_test_get_bench_result(void *handle, size_t index, rift_bench_result_t *result)
+{
+    test_run_t *run = (test_run_t *)handle;
+    if (!run || !result || index >= run->bench_count) {
+        return false;
+    }
+
+    *result = run->benches[index];
+    return true;
+}
+
+/**
+ * @brief Print a string as a JSON string literal
+ *
+ * @param text The string
+ */
+static void
+test_print_json_string(const char *text)
+{
+    putchar('"');
+    for (const unsigned char *c = (const unsigned char *)text; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            printf("\\%c", *c);
+        } else if (*c < 0x20) {
+            printf("\\u%04x", *c);
+        } else {
+            putchar(*c);
+        }
+    }
+    putchar('"');
+}
+
+/**
+ * @brief Print benchmark results to stdout
+ */
+void
+rift_test_print_bench_results(void *handle, bool json)
+{
+    test_run_t *run = (test_run_t *)handle;
+    if (!run) {
+        return;
+    }
+
+    if (!json) {
+        for (size_t i = 0; i < run->bench_count; i++) {
+            const rift_bench_result_t *result = &run->benches[i];
+            printf("[BENCH] %s: median %.3f ns/B, MAD %.3f ns/B, p99 %.3f ns/B, "
+                   "%.0f matches/s (%zu iterations over %zu bytes)\n",
+                   result->pattern_name, result->median_ns_per_byte, result->mad_ns_per_byte,
+                   result->p99_ns_per_byte, result->matches_per_second, result->iterations,
+                   result->input_bytes);
+        }
+        return;
+    }
+
+    printf("{\"benchmarks\":[");
+    for (size_t i = 0; i < run->bench_count; i++) {
+        const rift_bench_result_t *result = &run->benches[i];
+        printf("%s{\"pattern\":", i > 0 ? "," : "");
+        test_print_json_string(result->pattern_name);
+        printf(",\"pattern_index\":%zu,\"iterations\":%zu,\"warmup\":%zu,\"inputs\":%zu,"
+               "\"bytes\":%zu,\"matches\":%zu,\"median_ns_per_byte\":%.6f,"
+               "\"mad_ns_per_byte\":%.6f,\"p99_ns_per_byte\":%.6f,\"matches_per_second\":%.3f}",
+               result->pattern_index, result->iterations, result->warmup, result->input_count,
+               result->input_bytes, result->matches, result->median_ns_per_byte,
+               result->mad_ns_per_byte, result->p99_ns_per_byte, result->matches_per_second);
+    }
+    printf("]}\n");
+}
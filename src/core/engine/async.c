@@ -0,0 +1,477 @@
+/**
+ * @file async.c
+ * @brief Implementation of completion-based matching
+ *
+ * Jobs wait in a FIFO queue until a worker takes them, and stay on a
+ * pending list until they complete so they can be found by id to cancel.
+ * A job carries its own cancel flag, which its matcher watches. Once done,
+ * a job either calls its callback and is freed, or moves to the completion
+ * queue. The signal descriptor holds one unread event exactly while that
+ * queue is not empty; it is written and read under the pool lock along
+ * with the queue, so a wake-up is never lost.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/engine/async.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+
+/**
+ * @brief A submitted job, then its completion
+ */
+typedef struct async_job {
+    const rift_regex_pattern_t *pattern; /**< Pattern to match */
+    const char *input;                   /**< Input to match */
+    size_t length;                       /**< Length of the input */
+    uint64_t deadline_ns;                /**< Deadline of the job */
+    uint64_t submit_ns;                  /**< Time of submission */
+    rift_async_callback_t callback;      /**< Called on completion, or NULL to queue */
+    atomic_bool cancel;                  /**< Watched by the job's matcher */
+    rift_async_completion_t completion;  /**< Outcome, filled when the job ends */
+    struct async_job *next;              /**< Next job in the job or completion queue */
+    struct async_job *pending_prev;      /**< Previous pending job */
+    struct async_job *pending_next;      /**< Next pending job */
+} async_job_t;
+
+/**
+ * @brief Pool of workers with its queues
+ */
+struct rift_async_pool {
+    pthread_mutex_t lock;          /**< Guards everything below but the threads */
+    pthread_cond_t work_ready;     /**< Signalled when a job is queued or the pool stops */
+    async_job_t *queue_head;       /**< First job waiting for a worker */
+    async_job_t *queue_tail;       /**< Last job waiting for a worker */
+    async_job_t *pending;          /**< Jobs queued or running */
+    async_job_t *done_head;        /**< First completion waiting for rift_async_poll */
+    async_job_t *done_tail;        /**< Last completion waiting for rift_async_poll */
+    uint64_t next_id;              /**< Id of the next job */
+    bool stopping;                 /**< Whether the pool is being freed */
+    rift_matcher_option_t options; /**< Options of the workers' matchers */
+    int signal_fds[2];             /**< Read and write ends, the same eventfd on Linux */
+    pthread_t *threads;            /**< The workers */
+    size_t num_threads;            /**< Number of workers */
+};
+
+/**
+ * @brief Open the descriptor that signals queued completions
+ *
+ * @param fds Array to store the read and write ends
+ * @return true if successful, false otherwise
+ */
+static bool
+signal_open(int fds[2])
+{
+#ifdef __linux__
+    fds[0] = fds[1] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    return fds[0] >= 0;
+#else
+    if (pipe(fds) != 0) {
+        return false;
+    }
+    for (int i = 0; i < 2; i++) {
+        fcntl(fds[i], F_SETFL, fcntl(fds[i], F_GETFL) | O_NONBLOCK);
+        fcntl(fds[i], F_SETFD, FD_CLOEXEC);
+    }
+    return true;
+#endif
+}
+
+/**
+ * @brief Close the descriptor that signals queued completions
+ *
+ * @param fds The read and write ends
+ */
+static void
+signal_close(int fds[2])
+{
+    close(fds[0]);
+    if (fds[1] != fds[0]) {
+        close(fds[1]);
+    }
+}
+
+/**
+ * @brief Make the descriptor readable, called as the queue stops being empty
+ *
+ * @param fds The read and write ends
+ */
+static void
+signal_raise(int fds[2])
+{
+#ifdef __linux__
+    uint64_t one = 1;
+    ssize_t written;
+    do {
+        written = write(fds[1], &one, sizeof(one));
+    } while (written < 0 && errno == EINTR);
+#else
+    char byte = 1;
+    ssize_t written;
+    do {
+        written = write(fds[1], &byte, 1);
+    } while (written < 0 && errno == EINTR);
+#endif
+}
+
+/**
+ * @brief Consume the event, called as the queue becomes empty
+ *
+ * @param fds The read and write ends
+ */
+static void
+signal_clear(int fds[2])
+{
+#ifdef __linux__
+    uint64_t count;
+    ssize_t got;
+    do {
+        got = read(fds[0], &count, sizeof(count));
+    } while (got < 0 && errno == EINTR);
+#else
+    char byte;
+    ssize_t got;
+    do {
+        got = read(fds[0], &byte, 1);
+    } while (got < 0 && errno == EINTR);
+#endif
+}
+
+/**
+ * @brief Remove a job from the pending list
+ *
+ * The caller holds the pool lock.
+ *
+ * @param pool The pool
+ * @param job The job
+ */
+static void
+pending_remove(rift_async_pool_t *pool, async_job_t *job)
+{
+    if (job->pending_prev) {
+        job->pending_prev->pending_next = job->pending_next;
+    } else {
+        pool->pending = job->pending_next;
+    }
+    if (job->pending_next) {
+        job->pending_next->pending_prev = job->pending_prev;
+    }
+}
+
+/**
+ * @brief Run a job and work out how it ended
+ *
+ * @param pool The pool
+ * @param job The job
+ */
+static void
+run_job(rift_async_pool_t *pool, async_job_t *job)
+{
+    rift_async_completion_t *completion = &job->completion;
+    completion->span.start = RIFT_REGEX_SPAN_UNSET;
+    completion->span.end = RIFT_REGEX_SPAN_UNSET;
+
+    // Jobs that cannot finish in time are not started
+    if (atomic_load_explicit(&job->cancel, memory_order_relaxed)) {
+        completion->status = RIFT_ASYNC_CANCELLED;
+        return;
+    }
+    if (job->deadline_ns != RIFT_MATCHER_NO_DEADLINE &&
+        rift_matcher_monotonic_ns() >= job->deadline_ns) {
+        completion->status = RIFT_ASYNC_TIMED_OUT;
+        return;
+    }
+
+    rift_regex_matcher_t *matcher = rift_matcher_create(job->pattern, pool->options);
+    if (!matcher || !rift_matcher_set_deadline(matcher, job->deadline_ns) ||
+        !rift_matcher_set_cancel_flag(matcher, &job->cancel) ||
+        !rift_matcher_set_input(matcher, job->input, job->length)) {
+        completion->status = RIFT_ASYNC_FAILED;
+        rift_matcher_free(matcher);
+        return;
+    }
+
+    if (rift_matcher_find_next_spans(matcher, &completion->span, 1, NULL)) {
+        completion->status = RIFT_ASYNC_MATCHED;
+    } else if (rift_matcher_timed_out(matcher)) {
+        completion->status = atomic_load_explicit(&job->cancel, memory_order_relaxed)
+                                 ? RIFT_ASYNC_CANCELLED
+                                 : RIFT_ASYNC_TIMED_OUT;
+    } else {
+        completion->status = RIFT_ASYNC_NO_MATCH;
+    }
+    rift_matcher_free(matcher);
+}
+
+/**
+ * @brief Deliver the completion of a job, which then leaves the pending list
+ *
+ * @param pool The pool
+ * @param job The job
+ */
+static void
+complete_job(rift_async_pool_t *pool, async_job_t *job)
+{
+    rift_async_callback_t callback = job->callback;
+    job->completion.elapsed_ns = rift_matcher_monotonic_ns() - job->submit_ns;
+
+    // A queued job belongs to rift_async_poll as soon as the lock is released
+    pthread_mutex_lock(&pool->lock);
+    pending_remove(pool, job);
+    if (!callback) {
+        job->next = NULL;
+        if (pool->done_tail) {
+            pool->done_tail->next = job;
+        } else {
+            pool->done_head = job;
+            signal_raise(pool->signal_fds);
+        }
+        pool->done_tail = job;
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    if (callback) {
+        callback(&job->completion, job->completion.user_data);
+        free(job);
+    }
+}
+
+/**
+ * @brief Run jobs until the pool stops and its queue is empty
+ *
+ * @param arg The pool
+ * @return NULL
+ */
+static void *
+run_worker(void *arg)
+{
+    rift_async_pool_t *pool = (rift_async_pool_t *)arg;
+
+    while (true) {
+        pthread_mutex_lock(&pool->lock);
+        while (!pool->queue_head && !pool->stopping) {
+            pthread_cond_wait(&pool->work_ready, &pool->lock);
+        }
+        async_job_t *job = pool->queue_head;
+        if (job) {
+            pool->queue_head = job->next;
+            if (!pool->queue_head) {
+                pool->queue_tail = NULL;
+            }
+        }
+        pthread_mutex_unlock(&pool->lock);
+
+        if (!job) {
+            return NULL;
+        }
+        run_job(pool, job);
+        complete_job(pool, job);
+    }
+}
+
+/**
+ * @brief Stop the workers of a pool, cancelling what is left, and join them
+ *
+ * @param pool The pool
+ * @param num_started Number of workers that were started
+ */
+static void
+stop_workers(rift_async_pool_t *pool, size_t num_started)
+{
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = true;
+    for (async_job_t *job = pool->pending; job; job = job->pending_next) {
+        atomic_store_explicit(&job->cancel, true, memory_order_relaxed);
+    }
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (size_t i = 0; i < num_started; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+}
+
+rift_async_pool_t *
+rift_async_pool_create(size_t num_threads, rift_matcher_option_t options)
+{
+    if (num_threads == 0) {
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        num_threads = cpus > 0 ? (size_t)cpus : 1;
+    }
+
+    rift_async_pool_t *pool = (rift_async_pool_t *)calloc(1, sizeof(rift_async_pool_t));
+    if (!pool) {
+        return NULL;
+    }
+    pool->threads = (pthread_t *)calloc(num_threads, sizeof(pthread_t));
+    if (!pool->threads) {
+        free(pool);
+        return NULL;
+    }
+    if (!signal_open(pool->signal_fds)) {
+        free(pool->threads);
+        free(pool);
+        return NULL;
+    }
+    if (pthread_mutex_init(&pool->lock, NULL) != 0) {
+        signal_close(pool->signal_fds);
+        free(pool->threads);
+        free(pool);
+        return NULL;
+    }
+    if (pthread_cond_init(&pool->work_ready, NULL) != 0) {
+        pthread_mutex_destroy(&pool->lock);
+        signal_close(pool->signal_fds);
+        free(pool->threads);
+        free(pool);
+        return NULL;
+    }
+
+    pool->next_id = RIFT_ASYNC_NO_JOB + 1;
+    pool->options = options;
+    pool->num_threads = num_threads;
+
+    for (size_t i = 0; i < num_threads; i++) {
+        if (pthread_create(&pool->threads[i], NULL, run_worker, pool) != 0) {
+            pool->num_threads = i;
+            rift_async_pool_free(pool);
+            return NULL;
+        }
+    }
+
+    return pool;
+}
+
+void
+rift_async_pool_free(rift_async_pool_t *pool)
+{
+    if (!pool) {
+        return;
+    }
+
+    stop_workers(pool, pool->num_threads);
+
+    async_job_t *job = pool->done_head;
+    while (job) {
+        async_job_t *next = job->next;
+        free(job);
+        job = next;
+    }
+
+    pthread_cond_destroy(&pool->work_ready);
+    pthread_mutex_destroy(&pool->lock);
+    signal_close(pool->signal_fds);
+    free(pool->threads);
+    free(pool);
+}
+
+uint64_t
+rift_async_submit(rift_async_pool_t *pool, const rift_regex_pattern_t *pattern,
+                  const char *input, size_t length, uint64_t deadline_ns,
+                  rift_async_callback_t callback, void *user_data)
+{
+    if (!pool || !pattern || !input) {
+        return RIFT_ASYNC_NO_JOB;
+    }
+
+    async_job_t *job = (async_job_t *)calloc(1, sizeof(async_job_t));
+    if (!job) {
+        return RIFT_ASYNC_NO_JOB;
+    }
+    job->pattern = pattern;
+    job->input = input;
+    job->length = length;
+    job->deadline_ns = deadline_ns;
+    job->submit_ns = rift_matcher_monotonic_ns();
+    job->callback = callback;
+    atomic_init(&job->cancel, false);
+    job->completion.user_data = user_data;
+
+    pthread_mutex_lock(&pool->lock);
+    if (pool->stopping) {
+        pthread_mutex_unlock(&pool->lock);
+        free(job);
+        return RIFT_ASYNC_NO_JOB;
+    }
+
+    uint64_t id = pool->next_id++;
+    job->completion.job_id = id;
+
+    job->pending_next = pool->pending;
+    if (pool->pending) {
+        pool->pending->pending_prev = job;
+    }
+    pool->pending = job;
+
+    if (pool->queue_tail) {
+        pool->queue_tail->next = job;
+    } else {
+        pool->queue_head = job;
+    }
+    pool->queue_tail = job;
+
+    pthread_cond_signal(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+
+    return id;
+}
+
+bool
+rift_async_cancel(rift_async_pool_t *pool, uint64_t job_id)
+{
+    if (!pool || job_id == RIFT_ASYNC_NO_JOB) {
+        return false;
+    }
+
+    bool found = false;
+    pthread_mutex_lock(&pool->lock);
+    for (async_job_t *job = pool->pending; job; job = job->pending_next) {
+        if (job->completion.job_id == job_id) {
+            atomic_store_explicit(&job->cancel, true, memory_order_relaxed);
+            found = true;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return found;
+}
+
+int
+rift_async_get_fd(const rift_async_pool_t *pool)
+{
+    return pool ? pool->signal_fds[0] : -1;
+}
+
+size_t
+rift_async_poll(rift_async_pool_t *pool, rift_async_completion_t *completions,
+                size_t max_completions)
+{
+    if (!pool || !completions) {
+        return 0;
+    }
+
+    size_t count = 0;
+    pthread_mutex_lock(&pool->lock);
+    while (count < max_completions && pool->done_head) {
+        async_job_t *job = pool->done_head;
+        pool->done_head = job->next;
+        completions[count++] = job->completion;
+        free(job);
+    }
+    if (count > 0 && !pool->done_head) {
+        pool->done_tail = NULL;
+        signal_clear(pool->signal_fds);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return count;
+}
@@ -0,0 +1,425 @@
+/**
+ * @file batch.c
+ * @brief Implementation of batch matching
+ *
+ * Every thread starts with an equal contiguous range of the inputs and takes
+ * chunks from the front of it under the range's lock. A thread whose range
+ * is empty looks for the largest range left and moves the back half of it
+ * to its own. Ranges only shrink from either end and are split under their
+ * lock, so every input is matched exactly once, and the batch ends once no
+ * range has inputs left. The locks are only contended while stealing.
+ *
+ * With NUMA replication every thread is pinned to a node before it matches
+ * anything, and the first thread on a node clones the patterns while pinned
+ * there. Memory is placed on first touch, so each node's copies, and the
+ * matchers built from them, sit in its local memory.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/engine/batch.h"
+#include "core/engine/numa.h"
+#include "core/engine/pattern.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/**
+ * @brief Copies of the patterns for the threads of one NUMA node
+ */
+typedef struct batch_node {
+    pthread_mutex_t lock;            /**< Guards patterns and failed */
+    rift_regex_pattern_t **patterns; /**< Copies of the patterns, cloned on first use */
+    bool failed;                     /**< Whether the patterns could not be cloned */
+} batch_node_t;
+
+/**
+ * @brief Inputs, patterns and results shared by the threads of a batch
+ */
+typedef struct batch_job {
+    const rift_regex_pattern_t *const *patterns; /**< Patterns to match */
+    size_t num_patterns;                         /**< Number of patterns */
+    const char *const *inputs;                   /**< Inputs to match */
+    const size_t *lengths;                       /**< Input lengths, NULL for strlen */
+    rift_batch_result_t *results;                /**< Result matrix */
+    size_t chunk_size;                           /**< Inputs taken at a time */
+    rift_matcher_option_t matcher_options;       /**< Options of the matchers */
+    struct batch_worker *workers;                /**< The threads' ranges */
+    size_t num_workers;                          /**< Number of threads */
+    batch_node_t *nodes;                         /**< Per-node copies of the patterns */
+    size_t num_nodes;                            /**< Number of nodes, 0 without replication */
+    const bool *offloaded;                       /**< Patterns the executor matched, or NULL */
+} batch_job_t;
+
+/**
+ * @brief One thread of a batch and the inputs it still owns
+ */
+typedef struct batch_worker {
+    batch_job_t *job;                            /**< The batch */
+    const rift_regex_pattern_t *const *patterns; /**< The job's patterns or its node's copies */
+    size_t node;                                 /**< Node the thread is pinned to */
+    rift_numa_affinity_t affinity;               /**< Affinity of the thread before it was pinned */
+    pthread_mutex_t lock;                        /**< Guards next and end */
+    size_t next;                                 /**< First input left in the range */
+    size_t end;                                  /**< Position past the last input of the range */
+    rift_regex_matcher_t **matchers;             /**< One matcher per pattern, built on first use */
+    size_t steals;                               /**< Ranges taken from other threads */
+    bool failed;                                 /**< Whether a matcher or the copies failed */
+    pthread_t thread;                            /**< Thread running the worker */
+    bool started;                                /**< Whether the thread was started */
+} batch_worker_t;
+
+/**
+ * @brief Take the next chunk of a worker's own range
+ *
+ * @param worker The worker
+ * @param begin Pointer to store the first input of the chunk
+ * @param end Pointer to store the position past its last input
+ * @return true if the range had inputs left, false otherwise
+ */
+static bool
+take_chunk(batch_worker_t *worker, size_t *begin, size_t *end)
+{
+    pthread_mutex_lock(&worker->lock);
+    *begin = worker->next;
+    *end = worker->end - worker->next > worker->job->chunk_size
+               ? worker->next + worker->job->chunk_size
+               : worker->end;
+    worker->next = *end;
+    pthread_mutex_unlock(&worker->lock);
+
+    return *begin < *end;
+}
+
+/**
+ * @brief Move the back half of the largest other range to a worker
+ *
+ * @param worker The worker whose range is empty
+ * @return true if inputs were taken, false once every range is empty
+ */
+static bool
+steal_range(batch_worker_t *worker)
+{
+    batch_job_t *job = worker->job;
+
+    while (true) {
+        batch_worker_t *victim = NULL;
+        size_t largest = 0;
+        for (size_t i = 0; i < job->num_workers; i++) {
+            batch_worker_t *other = &job->workers[i];
+            if (other == worker) {
+                continue;
+            }
+            pthread_mutex_lock(&other->lock);
+            size_t remaining = other->end - other->next;
+            pthread_mutex_unlock(&other->lock);
+            if (remaining > largest) {
+                largest = remaining;
+                victim = other;
+            }
+        }
+        if (!victim) {
+            return false;
+        }
+
+        // The victim may have taken inputs since, so split what is there now
+        pthread_mutex_lock(&victim->lock);
+        size_t remaining = victim->end - victim->next;
+        size_t split = victim->next + remaining / 2;
+        size_t end = victim->end;
+        victim->end = split;
+        pthread_mutex_unlock(&victim->lock);
+
+        if (split < end) {
+            pthread_mutex_lock(&worker->lock);
+            worker->next = split;
+            worker->end = end;
+            pthread_mutex_unlock(&worker->lock);
+            worker->steals++;
+            return true;
+        }
+    }
+}
+
+/**
+ * @brief Match one input against every pattern
+ *
+ * @param worker The worker
+ * @param index Index of the input
+ * @return true if successful, false if a matcher could not be built
+ */
+static bool
+match_input(batch_worker_t *worker, size_t index)
+{
+    batch_job_t *job = worker->job;
+    const char *input = job->inputs[index];
+    size_t length = job->lengths ? job->lengths[index] : (size_t)-1;
+    rift_batch_result_t *row = &job->results[index * job->num_patterns];
+
+    for (size_t j = 0; j < job->num_patterns; j++) {
+        if (job->offloaded && job->offloaded[j]) {
+            continue;
+        }
+        rift_batch_result_t *result = &row[j];
+        result->matched = false;
+        result->span.start = RIFT_REGEX_SPAN_UNSET;
+        result->span.end = RIFT_REGEX_SPAN_UNSET;
+
+        if (!worker->matchers[j]) {
+            worker->matchers[j] = rift_matcher_create(worker->patterns[j], job->matcher_options);
+            if (!worker->matchers[j]) {
+                return false;
+            }
+        }
+
+        rift_regex_matcher_t *matcher = worker->matchers[j];
+        if (!input || !rift_matcher_set_input(matcher, input, length)) {
+            continue;
+        }
+        result->matched = rift_matcher_find_next_spans(matcher, &result->span, 1, NULL);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Pin a worker to its node and point it at the node's patterns
+ *
+ * @param worker The worker
+ * @return true if successful, false if the patterns could not be cloned
+ */
+static bool
+join_node(batch_worker_t *worker)
+{
+    batch_job_t *job = worker->job;
+    batch_node_t *node = &job->nodes[worker->node];
+
+    // Without pinning the copies still work, they are just not sure to be local
+    rift_numa_bind_thread(worker->node, &worker->affinity);
+
+    pthread_mutex_lock(&node->lock);
+    if (!node->patterns && !node->failed) {
+        rift_regex_pattern_t **copies = (rift_regex_pattern_t **)calloc(
+            job->num_patterns ? job->num_patterns : 1, sizeof(rift_regex_pattern_t *));
+        node->failed = !copies;
+        for (size_t j = 0; !node->failed && j < job->num_patterns; j++) {
+            copies[j] = rift_regex_pattern_clone(job->patterns[j]);
+            node->failed = !copies[j];
+        }
+        if (node->failed && copies) {
+            for (size_t j = 0; j < job->num_patterns; j++) {
+                rift_regex_pattern_free(copies[j]);
+            }
+            free(copies);
+        } else {
+            node->patterns = copies;
+        }
+    }
+    if (node->patterns) {
+        worker->patterns = (const rift_regex_pattern_t *const *)node->patterns;
+    }
+    bool success = !node->failed;
+    pthread_mutex_unlock(&node->lock);
+
+    return success;
+}
+
+/**
+ * @brief Match inputs until no range has any left
+ *
+ * @param arg The worker
+ * @return NULL
+ */
+static void *
+run_worker(void *arg)
+{
+    batch_worker_t *worker = (batch_worker_t *)arg;
+    size_t begin, end;
+
+    if (worker->job->num_nodes > 0) {
+        worker->failed = !join_node(worker);
+    }
+
+    while (!worker->failed && (take_chunk(worker, &begin, &end) || steal_range(worker))) {
+        for (size_t i = begin; i < end && !worker->failed; i++) {
+            worker->failed = !match_input(worker, i);
+        }
+    }
+
+    // Matters for the caller's thread, which runs the first worker
+    rift_numa_restore_thread(&worker->affinity);
+    return NULL;
+}
+
+/**
+ * @brief Get the number of threads to use by default
+ */
+static size_t
+default_thread_count(void)
+{
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return cpus > 0 ? (size_t)cpus : 1;
+}
+
+bool
+rift_match_batch(const rift_regex_pattern_t *const *patterns, size_t num_patterns,
+                 const char *const *inputs, const size_t *lengths, size_t num_inputs,
+                 rift_batch_result_t *results, const rift_batch_options_t *options)
+{
+    if ((!patterns && num_patterns > 0) || (!inputs && num_inputs > 0) ||
+        (!results && num_inputs > 0 && num_patterns > 0)) {
+        return false;
+    }
+    for (size_t j = 0; j < num_patterns; j++) {
+        if (!patterns[j]) {
+            return false;
+        }
+    }
+
+    uint64_t start_ns = rift_matcher_monotonic_ns();
+    rift_batch_options_t defaults = {0, 0, RIFT_MATCHER_OPTION_NONE, NULL, false, NULL};
+    if (!options) {
+        options = &defaults;
+    }
+
+    // The threads leave the columns the executor filled, and have nothing to do without others
+    bool *offloaded = NULL;
+    size_t num_offloaded = 0;
+    if (options->executor && num_patterns > 0 && num_inputs > 0) {
+        offloaded = (bool *)calloc(num_patterns, sizeof(bool));
+        if (!offloaded || !options->executor->execute(options->executor->state, patterns,
+                                                      num_patterns, inputs, lengths, num_inputs,
+                                                      results, offloaded)) {
+            free(offloaded);
+            return false;
+        }
+        for (size_t j = 0; j < num_patterns; j++) {
+            num_offloaded += offloaded[j];
+        }
+        if (num_offloaded == num_patterns) {
+            num_inputs = 0;
+        }
+    }
+
+    batch_job_t job;
+    job.patterns = patterns;
+    job.num_patterns = num_patterns;
+    job.inputs = inputs;
+    job.lengths = lengths;
+    job.results = results;
+    job.chunk_size = options->chunk_size ? options->chunk_size : RIFT_BATCH_DEFAULT_CHUNK;
+    job.matcher_options = options->matcher_options;
+    job.offloaded = offloaded;
+
+    // No more threads than chunks, so every thread starts with some work
+    size_t num_workers = options->num_threads ? options->num_threads : default_thread_count();
+    size_t num_chunks = (num_inputs + job.chunk_size - 1) / job.chunk_size;
+    if (num_workers > num_chunks) {
+        num_workers = num_chunks;
+    }
+    if (num_workers == 0) {
+        num_workers = 1;
+    }
+
+    // One copy per node that has a thread; a single node shares the originals
+    size_t num_nodes = options->numa_replicate ? rift_numa_node_count() : 1;
+    job.num_nodes = num_nodes > 1 ? (num_nodes < num_workers ? num_nodes : num_workers) : 0;
+    job.nodes = NULL;
+    if (job.num_nodes > 0) {
+        job.nodes = (batch_node_t *)calloc(job.num_nodes, sizeof(batch_node_t));
+        if (!job.nodes) {
+            free(offloaded);
+            return false;
+        }
+        for (size_t n = 0; n < job.num_nodes; n++) {
+            if (pthread_mutex_init(&job.nodes[n].lock, NULL) != 0) {
+                while (n-- > 0) {
+                    pthread_mutex_destroy(&job.nodes[n].lock);
+                }
+                free(job.nodes);
+                free(offloaded);
+                return false;
+            }
+        }
+    }
+
+    job.num_workers = num_workers;
+    job.workers = (batch_worker_t *)calloc(num_workers, sizeof(batch_worker_t));
+    bool success = job.workers != NULL;
+
+    size_t initialized = 0;
+    for (; success && initialized < num_workers; initialized++) {
+        batch_worker_t *worker = &job.workers[initialized];
+        worker->job = &job;
+        worker->patterns = patterns;
+        worker->node = job.num_nodes > 0 ? initialized % job.num_nodes : 0;
+        worker->next = num_inputs / num_workers * initialized;
+        worker->end = initialized + 1 == num_workers
+                          ? num_inputs
+                          : num_inputs / num_workers * (initialized + 1);
+        worker->matchers =
+            (rift_regex_matcher_t **)calloc(num_patterns ? num_patterns : 1, sizeof(void *));
+        if (!worker->matchers || pthread_mutex_init(&worker->lock, NULL) != 0) {
+            free(worker->matchers);
+            success = false;
+            break;
+        }
+    }
+
+    if (success) {
+        // The caller is the first worker; the others steal what it cannot start
+        for (size_t i = 1; i < num_workers; i++) {
+            job.workers[i].started =
+                pthread_create(&job.workers[i].thread, NULL, run_worker, &job.workers[i]) == 0;
+        }
+        run_worker(&job.workers[0]);
+    }
+
+    // Every thread must be done before any lock goes, as they steal from each other
+    for (size_t i = 1; i < initialized; i++) {
+        if (job.workers[i].started) {
+            pthread_join(job.workers[i].thread, NULL);
+        }
+    }
+
+    size_t num_threads = 0;
+    size_t steals = 0;
+    for (size_t i = 0; i < initialized; i++) {
+        batch_worker_t *worker = &job.workers[i];
+        if (i == 0 || worker->started) {
+            num_threads++;
+        }
+        success = success && !worker->failed;
+        steals += worker->steals;
+
+        for (size_t j = 0; j < num_patterns; j++) {
+            rift_matcher_free(worker->matchers[j]);
+        }
+        free(worker->matchers);
+        pthread_mutex_destroy(&worker->lock);
+    }
+    free(job.workers);
+
+    for (size_t n = 0; n < job.num_nodes; n++) {
+        batch_node_t *node = &job.nodes[n];
+        if (node->patterns) {
+            for (size_t j = 0; j < num_patterns; j++) {
+                rift_regex_pattern_free(node->patterns[j]);
+            }
+            free(node->patterns);
+        }
+        pthread_mutex_destroy(&node->lock);
+    }
+    free(job.nodes);
+    free(offloaded);
+
+    if (options->stats) {
+        options->stats->elapsed_ns = rift_matcher_monotonic_ns() - start_ns;
+        options->stats->num_threads = num_threads;
+        options->stats->steals = steals;
+        options->stats->numa_nodes = job.num_nodes;
+        options->stats->offloaded = num_offloaded;
+    }
+    return success;
+}
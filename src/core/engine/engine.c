@@ -17,6 +17,7 @@ engine/engine.h"
 #include "core/errors/regex_error.h"
 #include "core/parser/ast.h"
  #include "core/engine/engine.h"
+ #include "core/config/config.h"
  #include "core/errors/regex_error.h"
  #include "core/parser/ast.h"
  
@@ -195,14 +196,32 @@ engine/engine.h"
          return NULL;
      }
      
-     /* Count capture groups */
+     /* Count capture groups and resolve their names */
      regex_pattern->group_count = rift_regex_ast_count_groups(ast);
+     regex_pattern->group_names = rift_group_names_build(ast, error);
+     if (!regex_pattern->group_names) {
+         rift_automaton_free(regex_pattern->automaton);
+         free(regex_pattern->source);
+         free_ast(ast);
+         free(regex_pattern);
+         return NULL;
+     }
+     regex_pattern->prefilter = NULL;
      
      /* Additional initialization based on flags */
      regex_pattern->is_rift_syntax = (pattern[0] == 'r' && (pattern[1] == '\'' || pattern[1] == '"'));
      regex_pattern->is_valid = true;
      regex_pattern->error_message = NULL;
      
+     /* Classify the pattern so the matcher can pick its engine up front */
+     rift_ambiguity_analyze(ast, regex_pattern->automaton, &regex_pattern->ambiguity, NULL);
+     rift_engine_plan_build(regex_pattern->automaton, regex_pattern->group_count,
+                            &regex_pattern->ambiguity, &regex_pattern->engine_plan, NULL);
+     rift_match_length_analyze(ast, flags, &regex_pattern->match_length);
+     const rift_config_t *config = rift_config_acquire();
+     regex_pattern->config = config->regex;
+     rift_config_release(config);
+     
      return regex_pattern;
  }
  
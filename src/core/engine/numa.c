@@ -0,0 +1,187 @@
+/**
+ * @file numa.c
+ * @brief Implementation of NUMA node discovery and thread pinning
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+#include "core/engine/numa.h"
+#include <stdio.h>
+#include <string.h>
+#ifdef __linux__
+#include <dirent.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#endif
+
+#ifdef __linux__
+
+/**
+ * @brief Read the ids of the nodes that have CPUs, in increasing order
+ *
+ * @param ids Array to store the ids
+ * @param max_ids Number of entries in ids
+ * @return Number of ids stored
+ */
+static size_t
+read_node_ids(int *ids, size_t max_ids)
+{
+    DIR *dir = opendir("/sys/devices/system/node");
+    if (!dir) {
+        return 0;
+    }
+
+    size_t count = 0;
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL && count < max_ids) {
+        int id;
+        char rest;
+        if (sscanf(entry->d_name, "node%d%c", &id, &rest) != 1 || id < 0) {
+            continue;
+        }
+
+        // Nodes with memory only have an empty CPU list
+        char path[64];
+        char list[8];
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", id);
+        FILE *file = fopen(path, "r");
+        bool has_cpus = file && fgets(list, sizeof(list), file) && list[0] >= '0' &&
+                        list[0] <= '9';
+        if (file) {
+            fclose(file);
+        }
+        if (!has_cpus) {
+            continue;
+        }
+
+        // Insertion keeps the ids sorted; readdir order is arbitrary
+        size_t i = count++;
+        while (i > 0 && ids[i - 1] > id) {
+            ids[i] = ids[i - 1];
+            i--;
+        }
+        ids[i] = id;
+    }
+    closedir(dir);
+
+    return count;
+}
+
+/**
+ * @brief Read the CPUs of a node
+ *
+ * @param id Id of the node
+ * @param cpus Set to store the CPUs
+ * @return true if the node has CPUs, false otherwise
+ */
+static bool
+read_node_cpus(int id, cpu_set_t *cpus)
+{
+    char path[64];
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", id);
+    FILE *file = fopen(path, "r");
+    if (!file) {
+        return false;
+    }
+
+    // The list is ranges such as 0-15,32-47
+    CPU_ZERO(cpus);
+    unsigned long first, last;
+    int separator = ',';
+    while (separator == ',' && fscanf(file, "%lu", &first) == 1) {
+        last = first;
+        separator = fgetc(file);
+        if (separator == '-') {
+            if (fscanf(file, "%lu", &last) != 1) {
+                break;
+            }
+            separator = fgetc(file);
+        }
+        for (unsigned long cpu = first; cpu <= last && cpu < CPU_SETSIZE; cpu++) {
+            CPU_SET(cpu, cpus);
+        }
+    }
+    fclose(file);
+
+    return CPU_COUNT(cpus) > 0;
+}
+
+#endif /* __linux__ */
+
+size_t
+rift_numa_node_count(void)
+{
+#ifdef __linux__
+    int ids[RIFT_NUMA_MAX_NODES];
+    size_t count = read_node_ids(ids, RIFT_NUMA_MAX_NODES);
+    return count > 0 ? count : 1;
+#else
+    return 1;
+#endif
+}
+
+bool
+rift_numa_bind_thread(size_t node, rift_numa_affinity_t *previous)
+{
+    if (previous) {
+        memset(previous, 0, sizeof(*previous));
+    }
+
+#ifdef __linux__
+    int ids[RIFT_NUMA_MAX_NODES];
+    size_t count = read_node_ids(ids, RIFT_NUMA_MAX_NODES);
+    cpu_set_t cpus;
+    if (count == 0 || !read_node_cpus(ids[node % count], &cpus)) {
+        return false;
+    }
+
+    if (previous) {
+        cpu_set_t saved;
+        if (pthread_getaffinity_np(pthread_self(), sizeof(saved), &saved) != 0) {
+            return false;
+        }
+        for (size_t cpu = 0; cpu < RIFT_NUMA_MAX_CPUS && cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &saved)) {
+                previous->cpus[cpu / 64] |= (uint64_t)1 << (cpu % 64);
+            }
+        }
+        previous->valid = true;
+    }
+
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0) {
+        if (previous) {
+            previous->valid = false;
+        }
+        return false;
+    }
+    return true;
+#else
+    (void)node;
+    return false;
+#endif
+}
+
+void
+rift_numa_restore_thread(const rift_numa_affinity_t *previous)
+{
+    if (!previous || !previous->valid) {
+        return;
+    }
+
+#ifdef __linux__
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    for (size_t cpu = 0; cpu < RIFT_NUMA_MAX_CPUS && cpu < CPU_SETSIZE; cpu++) {
+        if (previous->cpus[cpu / 64] & ((uint64_t)1 << (cpu % 64))) {
+            CPU_SET(cpu, &cpus);
+        }
+    }
+    pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+#endif
+}
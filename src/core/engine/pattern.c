@@ -12,8 +12,14 @@ engine/pattern.h"
  */
 
 #include "core/engine/pattern.h
+#include <stdatomic.h>
 #include <stdlib.h>
 #include <string.h>
+#include "core/automaton/frozen_automaton.h"
+#include "core/automaton/lookaround.h"
+#include "core/automaton/state.h"
+#include "core/compiler/auto_possessify.h"
+#include "core/runtime/probes.h"
 
 
 /**
@@ -50,9 +56,19 @@ rift_regex_compile_pattern_extended(const char *pattern, rift_regex_flags_t flag
         return NULL;
     }
 
+    // Make loops that cannot give anything back to what follows possessive
+    rift_regex_auto_possessify(ast, flags);
+
     // Compile the AST into an automaton
     rift_regex_automaton_t *automaton = rift_regex_compile_ast(ast, flags, error);
 
+    // Classify the pattern while the AST is still around
+    rift_ambiguity_verdict_t verdict;
+    rift_ambiguity_verdict_init(&verdict);
+    if (automaton) {
+        rift_ambiguity_analyze(ast, automaton, &verdict, NULL);
+    }
+
     // Free the AST (no longer needed after compilation)
     rift_regex_ast_free(ast);
 
@@ -62,14 +78,17 @@ rift_regex_compile_pattern_extended(const char *pattern, rift_regex_flags_t flag
 
     // If using R'' syntax and limit registry is provided, register pattern-specific limits
     if (is_r_syntax && limit_registry) {
-        // Calculate pattern complexity
-        float complexity = rift_bailout_calculate_pattern_complexity(
-            rift_regex_pattern_create_from_automaton(automaton, flags), true);
+        // The static verdict decides when known, the complexity heuristic otherwise
+        float complexity = 0.0f;
+        if (verdict.ambiguity == RIFT_AMBIGUITY_UNKNOWN) {
+            complexity = rift_bailout_calculate_pattern_complexity(
+                rift_regex_pattern_create_from_automaton(automaton, flags), true);
+        }
 
-        // Create appropriate limits based on complexity
+        // Create appropriate limits based on the verdict
         rift_backtrack_limit_config_t *r_syntax_config = NULL;
 
-        if (complexity > 5.0f) {
+        if (verdict.ambiguity == RIFT_AMBIGUITY_EXPONENTIAL || complexity > 5.0f) {
             // Stricter limits for highly complex patterns
             r_syntax_config =
                 rift_backtrack_limit_config_create_pattern(pattern_id,
@@ -78,7 +97,7 @@ rift_regex_compile_pattern_extended(const char *pattern, rift_regex_flags_t flag
                                                            3000, // Reduced time limit (3 seconds)
                                                            50000 // Reduced transitions
                 );
-        } else if (complexity > 2.0f) {
+        } else if (verdict.ambiguity == RIFT_AMBIGUITY_POLYNOMIAL || complexity > 2.0f) {
             // Moderate limits for medium complexity
             r_syntax_config =
                 rift_backtrack_limit_config_create_pattern(pattern_id,
@@ -110,15 +129,46 @@ rift_regex_compile_pattern_extended(const char *pattern, rift_regex_flags_t flag
 }
 
 /**
- * @brief Create a new regex pattern from a string
+ * @brief Copy the regex settings of the current configuration snapshot into a pattern
+ *
+ * @param regex The pattern
+ */
+static void
+capture_config(rift_regex_pattern_t *regex)
+{
+    const rift_config_t *config = rift_config_acquire();
+    regex->config = config->regex;
+    rift_config_release(config);
+}
+
+/**
+ * @brief Build the literal prefilter a matcher would keep for a pattern
+ *
+ * @param regex The pattern, with its AST and automaton
+ * @return A prefilter that can rule out positions, or NULL
+ */
+static rift_prefilter_t *
+build_prefilter(const rift_regex_pattern_t *regex)
+{
+    rift_prefilter_t *prefilter = rift_prefilter_create(regex->ast, NULL);
+    if (prefilter && (!rift_prefilter_analyze_automaton(prefilter, regex->automaton, NULL) ||
+                      !rift_prefilter_can_skip(prefilter))) {
+        rift_prefilter_free(prefilter);
+        prefilter = NULL;
+    }
+    return prefilter;
+}
+
+/**
+ * @brief Compile a pattern string, between the compile probes
  *
  * @param pattern The pattern string
  * @param flags Compilation flags
  * @param error Pointer to store error code (can be NULL)
  * @return A new pattern or NULL on failure
  */
-rift_regex_pattern_t *
-rift_regex_compile(const char *pattern, rift_regex_flags_t flags, rift_regex_error_t *error)
+static rift_regex_pattern_t *
+compile_pattern(const char *pattern, rift_regex_flags_t flags, rift_regex_error_t *error)
 {
     if (!pattern) {
         if (error) {
@@ -147,6 +197,13 @@ rift_regex_compile(const char *pattern, rift_regex_flags_t flags, rift_regex_err
     regex->group_count = 0;
     regex->is_rift_syntax = false;
     regex->error_message[0] = '\0';
+    rift_ambiguity_verdict_init(&regex->ambiguity);
+    rift_engine_plan_init(&regex->engine_plan);
+    rift_match_length_bounds_init(&regex->match_length);
+    capture_config(regex);
+    regex->group_names = NULL;
+    regex->prefilter = NULL;
+    atomic_init(&regex->shared_refs, NULL);
 
     if (!regex->source) {
         free(regex);
@@ -179,8 +236,16 @@ rift_regex_compile(const char *pattern, rift_regex_flags_t flags, rift_regex_err
         return NULL;
     }
 
-    /* Count capture groups in the AST */
+    /* Count capture groups in the AST and resolve their names */
     regex->group_count = rift_regex_ast_count_groups(regex->ast);
+    regex->group_names = rift_group_names_build(regex->ast, error);
+    if (!regex->group_names) {
+        rift_regex_pattern_free(regex);
+        return NULL;
+    }
+
+    /* Make loops that cannot give anything back to what follows possessive */
+    rift_regex_auto_possessify(regex->ast, flags);
 
     /* Compile the AST to automaton */
     regex->automaton = rift_regex_compile_ast(regex->ast, flags, error);
@@ -197,6 +262,59 @@ rift_regex_compile(const char *pattern, rift_regex_flags_t flags, rift_regex_err
         }
     }
 
+    /* Classify the pattern so the matcher can pick its engine up front */
+    rift_ambiguity_analyze(regex->ast, regex->automaton, &regex->ambiguity, NULL);
+    rift_engine_plan_build(regex->automaton, regex->group_count, &regex->ambiguity,
+                           &regex->engine_plan, NULL);
+    rift_match_length_analyze(regex->ast, flags, &regex->match_length);
+
+    /* Pick how searches find match starts from the literals the matcher will use */
+    rift_prefilter_t *prefilter = build_prefilter(regex);
+    rift_engine_plan_choose_search(&regex->engine_plan, regex->automaton, prefilter);
+    rift_prefilter_free(prefilter);
+
+    return regex;
+}
+
+/**
+ * @brief Create a new regex pattern from a string
+ *
+ * @param pattern The pattern string
+ * @param flags Compilation flags
+ * @param error Pointer to store error code (can be NULL)
+ * @return A new pattern or NULL on failure
+ */
+rift_regex_pattern_t *
+rift_regex_compile(const char *pattern, rift_regex_flags_t flags, rift_regex_error_t *error)
+{
+    RIFT_PROBE3(compile__start, pattern, pattern ? strlen(pattern) : 0, (int)flags);
+    rift_regex_pattern_t *regex = compile_pattern(pattern, flags, error);
+    RIFT_PROBE4(compile__end, regex, pattern, regex ? regex->automaton->num_states : 0,
+                regex ? 0 : error ? (int)error->code : -1);
+    return regex;
+}
+
+/**
+ * @brief Create a new regex pattern whose compiled form comes from an allocator
+ *
+ * @param pattern The pattern string
+ * @param flags Compilation flags
+ * @param allocator The allocator, or NULL for the one in use on the thread
+ * @param error Pointer to store error code (can be NULL)
+ * @return A new pattern or NULL on failure
+ */
+rift_regex_pattern_t *
+rift_regex_compile_with_allocator(const char *pattern, rift_regex_flags_t flags,
+                                  const rift_allocator_t *allocator, rift_regex_error_t *error)
+{
+    const rift_allocator_t *outer = rift_allocator_current();
+    if (allocator) {
+        rift_allocator_use(allocator);
+    }
+
+    rift_regex_pattern_t *regex = rift_regex_compile(pattern, flags, error);
+
+    rift_allocator_use(outer);
     return regex;
 }
 
@@ -232,6 +350,106 @@ rift_regex_pattern_get_group_count(const rift_regex_pattern_t *pattern)
     return pattern->group_count;
 }
 
+/**
+ * @brief Get the static ambiguity verdict of the pattern
+ *
+ * @param pattern The pattern
+ * @return The verdict, or NULL if pattern is NULL
+ */
+const rift_ambiguity_verdict_t *
+rift_regex_pattern_get_ambiguity(const rift_regex_pattern_t *pattern)
+{
+    if (!pattern) {
+        return NULL;
+    }
+
+    return &pattern->ambiguity;
+}
+
+/**
+ * @brief Get the engine plan of the pattern
+ *
+ * @param pattern The pattern
+ * @return The plan, or NULL if pattern is NULL
+ */
+const rift_engine_plan_t *
+rift_regex_pattern_get_engine_plan(const rift_regex_pattern_t *pattern)
+{
+    if (!pattern) {
+        return NULL;
+    }
+
+    return &pattern->engine_plan;
+}
+
+/**
+ * @brief Get the bounds on the length of the pattern's matches
+ *
+ * @param pattern The pattern
+ * @return The bounds, or NULL if pattern is NULL
+ */
+const rift_match_length_bounds_t *
+rift_regex_pattern_get_match_length(const rift_regex_pattern_t *pattern)
+{
+    if (!pattern) {
+        return NULL;
+    }
+
+    return &pattern->match_length;
+}
+
+/**
+ * @brief Get the regex settings of the pattern
+ *
+ * @param pattern The pattern
+ * @return The settings, or NULL if pattern is NULL
+ */
+const rift_regex_config_t *
+rift_regex_pattern_get_config(const rift_regex_pattern_t *pattern)
+{
+    if (!pattern) {
+        return NULL;
+    }
+
+    return &pattern->config;
+}
+
+/**
+ * @brief Override one regex setting for this pattern only
+ *
+ * @param pattern The pattern
+ * @param param The parameter to override
+ * @param value Pointer to the value
+ * @return true if set, false on invalid parameters
+ */
+bool
+rift_regex_pattern_set_param(rift_regex_pattern_t *pattern, rift_regex_config_param_t param,
+                             const void *value)
+{
+    if (!pattern) {
+        return false;
+    }
+
+    return rift_regex_config_set_param(&pattern->config, param, value) == RIFT_OK;
+}
+
+/**
+ * @brief Get the index of a named capture group
+ *
+ * @param pattern The pattern
+ * @param name The group name
+ * @return The group index, or RIFT_GROUP_NO_INDEX if there is no such group
+ */
+size_t
+rift_regex_pattern_group_index(const rift_regex_pattern_t *pattern, const char *name)
+{
+    if (!pattern) {
+        return RIFT_GROUP_NO_INDEX;
+    }
+
+    return rift_group_names_lookup(pattern->group_names, name);
+}
+
 /**
  * @brief Get the compiled automaton from the pattern
  *
@@ -248,6 +466,22 @@ rift_regex_pattern_get_automaton(const rift_regex_pattern_t *pattern)
     return pattern->automaton;
 }
 
+/**
+ * @brief Get the literal prefilter a pattern was deserialized with
+ *
+ * @param pattern The pattern
+ * @return The prefilter, or NULL if the matcher should derive one
+ */
+const rift_prefilter_t *
+rift_regex_pattern_get_prefilter(const rift_regex_pattern_t *pattern)
+{
+    if (!pattern) {
+        return NULL;
+    }
+
+    return pattern->prefilter;
+}
+
 /**
  * @brief Free a compiled pattern
  *
@@ -260,6 +494,16 @@ rift_regex_pattern_free(rift_regex_pattern_t *pattern)
         return;
     }
 
+    /* Clones share the compiled parts, the last one to go frees them */
+    atomic_size_t *shared_refs = atomic_load(&pattern->shared_refs);
+    if (shared_refs) {
+        if (atomic_fetch_sub(shared_refs, 1) > 1) {
+            free(pattern);
+            return;
+        }
+        free(shared_refs);
+    }
+
     /* Free all owned resources */
     if (pattern->source) {
         free(pattern->source);
@@ -273,6 +517,9 @@ rift_regex_pattern_free(rift_regex_pattern_t *pattern)
         free_automaton(pattern->automaton);
     }
 
+    rift_group_names_free(pattern->group_names);
+    rift_prefilter_free(pattern->prefilter);
+
     /* Free the pattern itself */
     free(pattern);
 }
@@ -324,9 +571,48 @@ rift_regex_pattern_get_ast(const rift_regex_pattern_t *pattern)
     return pattern->ast;
 }
 
+/**
+ * @brief Get the reference count shared by a pattern and its clones
+ *
+ * The count is only allocated once a pattern is cloned, so patterns that are
+ * never cloned do not pay for it. A pattern that is cloned from several
+ * threads at once ends up with the count published first.
+ *
+ * @param pattern The pattern
+ * @return The count, or NULL on allocation failure
+ */
+static atomic_size_t *
+pattern_shared_refs(const rift_regex_pattern_t *pattern)
+{
+    /* The count lives outside the const view of the pattern; it is the only
+       field a clone writes to */
+    rift_regex_pattern_t *owner = (rift_regex_pattern_t *)pattern;
+
+    atomic_size_t *shared_refs = atomic_load(&owner->shared_refs);
+    if (shared_refs) {
+        return shared_refs;
+    }
+
+    atomic_size_t *created = (atomic_size_t *)malloc(sizeof(atomic_size_t));
+    if (!created) {
+        return NULL;
+    }
+    atomic_init(created, 1);
+
+    atomic_size_t *expected = NULL;
+    if (!atomic_compare_exchange_strong(&owner->shared_refs, &expected, created)) {
+        free(created);
+        return expected;
+    }
+    return created;
+}
+
 /**
  * @brief Create a duplicate of a pattern
  *
+ * The source, AST and automaton are not modified once compiled, so the
+ * duplicate shares them with the original instead of copying them.
+ *
  * @param pattern The pattern to clone
  * @return A new pattern that is a copy of the original, or NULL on failure
  */
@@ -343,40 +629,30 @@ rift_regex_pattern_clone(const rift_regex_pattern_t *pattern)
         return NULL;
     }
 
-    /* Initialize with default values */
-    clone->source = NULL;
-    clone->ast = NULL;
-    clone->automaton = NULL;
-    clone->flags = pattern->flags;
-    clone->group_count = pattern->group_count;
-    clone->is_rift_syntax = pattern->is_rift_syntax;
-
-    /* Copy the source string */
-    if (pattern->source) {
-        clone->source = strdup(pattern->source);
-        if (!clone->source) {
-            rift_regex_pattern_free(clone);
-            return NULL;
-        }
+    atomic_size_t *shared_refs = pattern_shared_refs(pattern);
+    if (!shared_refs) {
+        free(clone);
+        return NULL;
     }
+    atomic_fetch_add(shared_refs, 1);
 
-    /* Clone the AST */
-    if (pattern->ast) {
-        clone->ast = rift_regex_ast_clone(pattern->ast);
-        if (!clone->ast) {
-            rift_regex_pattern_free(clone);
-            return NULL;
-        }
-    }
+    /* Share the compiled parts */
+    clone->source = pattern->source;
+    clone->ast = pattern->ast;
+    clone->automaton = pattern->automaton;
+    clone->group_names = pattern->group_names;
+    clone->prefilter = pattern->prefilter;
+    atomic_init(&clone->shared_refs, shared_refs);
 
-    /* Clone the automaton */
-    if (pattern->automaton) {
-        clone->automaton = rift_automaton_clone(pattern->automaton);
-        if (!clone->automaton) {
-            rift_regex_pattern_free(clone);
-            return NULL;
-        }
-    }
+    /* Copy the per-pattern state */
+    clone->flags = pattern->flags;
+    clone->group_count = pattern->group_count;
+    clone->is_rift_syntax = pattern->is_rift_syntax;
+    clone->is_valid = pattern->is_valid;
+    clone->ambiguity = pattern->ambiguity;
+    clone->engine_plan = pattern->engine_plan;
+    clone->match_length = pattern->match_length;
+    clone->config = pattern->config;
 
     /* Copy the error message */
     strncpy(clone->error_message, pattern->error_message, sizeof(clone->error_message));
@@ -446,6 +722,581 @@ rift_regex_pattern_to_string(const rift_regex_pattern_t *pattern, char *buffer,
     return (written > 0 && (size_t)written < buffer_size);
 }
 
+/* Magic number of a serialized pattern, "RFTP" */
+#define PATTERN_IMAGE_MAGIC 0x52465450u
+
+/* Version of the serialized pattern layout */
+#define PATTERN_IMAGE_VERSION 1u
+
+/* Byte order marker, read back swapped on a machine of the other byte order */
+#define PATTERN_IMAGE_BYTE_ORDER 0x01020304u
+
+/* Length written in place of a missing string */
+#define PATTERN_IMAGE_NO_STRING UINT32_MAX
+
+/* Deepest nesting of lookaround bodies read back */
+#define PATTERN_IMAGE_MAX_DEPTH 32
+
+/* Bytes every state takes before its strings, accept tags and transitions */
+#define PATTERN_IMAGE_STATE_BYTES (10 * sizeof(uint32_t))
+
+/* Largest accept tag read back, so a corrupt image cannot size a huge tag bitset */
+#define PATTERN_IMAGE_MAX_ACCEPT_TAG (1u << 20)
+
+/* Capture marks of a state */
+#define PATTERN_IMAGE_CAPTURE 0x01u
+#define PATTERN_IMAGE_CAPTURE_START 0x02u
+#define PATTERN_IMAGE_CAPTURE_END 0x04u
+
+/**
+ * @brief Header of a serialized pattern
+ *
+ * It is followed by the pattern's fields, its group name table, its literal
+ * prefilter and its automaton. The analysis results are copied verbatim, so
+ * the sizes of their structures are recorded and must match on load.
+ */
+typedef struct {
+    uint32_t magic;      /**< PATTERN_IMAGE_MAGIC */
+    uint32_t version;    /**< PATTERN_IMAGE_VERSION */
+    uint32_t byte_order; /**< PATTERN_IMAGE_BYTE_ORDER of the writer */
+    uint32_t layout;     /**< Sizes of the structures copied verbatim, see image_layout() */
+} pattern_image_header_t;
+
+/**
+ * @brief Growing buffer a pattern is serialized into
+ */
+typedef struct {
+    unsigned char *data; /**< Bytes written so far */
+    size_t used;         /**< Number of bytes written */
+    size_t capacity;     /**< Size of the buffer */
+    bool failed;         /**< Whether an allocation or a freeze failed */
+} image_writer_t;
+
+/**
+ * @brief Cursor over a serialized pattern
+ */
+typedef struct {
+    const unsigned char *data; /**< The image */
+    size_t size;               /**< Size of the image */
+    size_t pos;                /**< Offset of the next byte to read */
+    bool failed;               /**< Whether the image was truncated or invalid */
+    bool out_of_memory;        /**< Whether rebuilding the pattern ran out of memory */
+} image_reader_t;
+
+/**
+ * @brief Combine the sizes of the structures an image copies verbatim
+ */
+static uint32_t
+image_layout(void)
+{
+    const size_t sizes[] = {sizeof(size_t),
+                            sizeof(rift_ambiguity_verdict_t),
+                            sizeof(rift_engine_plan_t),
+                            sizeof(rift_match_length_bounds_t),
+                            sizeof(rift_regex_config_t),
+                            sizeof(rift_prefilter_t)};
+    uint32_t layout = 0;
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        layout = layout * 31 + (uint32_t)sizes[i];
+    }
+    return layout;
+}
+
+/**
+ * @brief Append bytes to an image
+ */
+static void
+image_put(image_writer_t *writer, const void *bytes, size_t length)
+{
+    if (writer->failed || length == 0) {
+        return;
+    }
+
+    if (length > writer->capacity - writer->used) {
+        size_t capacity = writer->capacity ? writer->capacity : 256;
+        while (length > capacity - writer->used) {
+            capacity *= 2;
+        }
+        unsigned char *data = (unsigned char *)realloc(writer->data, capacity);
+        if (!data) {
+            writer->failed = true;
+            return;
+        }
+        writer->data = data;
+        writer->capacity = capacity;
+    }
+
+    memcpy(writer->data + writer->used, bytes, length);
+    writer->used += length;
+}
+
+/**
+ * @brief Append a 32-bit value to an image
+ */
+static void
+image_put_u32(image_writer_t *writer, uint32_t value)
+{
+    image_put(writer, &value, sizeof(value));
+}
+
+/**
+ * @brief Append a string to an image, with its length and terminator
+ */
+static void
+image_put_string(image_writer_t *writer, const char *text)
+{
+    if (!text) {
+        image_put_u32(writer, PATTERN_IMAGE_NO_STRING);
+        return;
+    }
+
+    size_t length = strlen(text) + 1;
+    if (length >= PATTERN_IMAGE_NO_STRING) {
+        writer->failed = true;
+        return;
+    }
+    image_put_u32(writer, (uint32_t)length);
+    image_put(writer, text, length);
+}
+
+/**
+ * @brief Read bytes from an image, or zeros past its end
+ */
+static void
+image_get(image_reader_t *reader, void *bytes, size_t length)
+{
+    if (reader->failed || length > reader->size - reader->pos) {
+        reader->failed = true;
+        memset(bytes, 0, length);
+        return;
+    }
+
+    memcpy(bytes, reader->data + reader->pos, length);
+    reader->pos += length;
+}
+
+/**
+ * @brief Read a 32-bit value from an image
+ */
+static uint32_t
+image_get_u32(image_reader_t *reader)
+{
+    uint32_t value;
+    image_get(reader, &value, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief Read a string from an image without copying it
+ *
+ * @param reader The reader
+ * @return The string inside the image, or NULL for a missing string or on failure
+ */
+static const char *
+image_get_string(image_reader_t *reader)
+{
+    uint32_t length = image_get_u32(reader);
+    if (reader->failed || length == PATTERN_IMAGE_NO_STRING) {
+        return NULL;
+    }
+
+    const unsigned char *text = reader->data + reader->pos;
+    if (length == 0 || length > reader->size - reader->pos ||
+        memchr(text, '\0', length) != text + length - 1) {
+        reader->failed = true;
+        return NULL;
+    }
+    reader->pos += length;
+    return (const char *)text;
+}
+
+/**
+ * @brief Write an automaton and the bodies of its lookarounds
+ *
+ * The automaton is frozen first, so every transition names its target by
+ * state index and the states are written in index order.
+ *
+ * @param writer The writer
+ * @param automaton The automaton
+ */
+static void
+write_automaton(image_writer_t *writer, const rift_regex_automaton_t *automaton)
+{
+    rift_frozen_automaton_t *frozen = rift_frozen_automaton_create(automaton, NULL);
+    if (!frozen) {
+        writer->failed = true;
+        return;
+    }
+
+    image_put_u32(writer, (uint32_t)frozen->type);
+    image_put_u32(writer, frozen->is_deterministic ? 1u : 0u);
+    image_put_u32(writer, (uint32_t)frozen->flags);
+    image_put_u32(writer, frozen->num_states);
+    image_put_u32(writer, frozen->start_state);
+
+    for (uint32_t i = 0; i < frozen->num_states; i++) {
+        const rift_regex_state_t *state = automaton->states[i];
+        image_put_u32(writer, (uint32_t)state->flags);
+        image_put_u32(writer, rift_frozen_automaton_is_accepting(frozen, i) ? 1u : 0u);
+        image_put_u32(writer, state->lookaround);
+
+        const rift_frozen_capture_t *capture = rift_frozen_automaton_find_capture(frozen, i);
+        if (capture) {
+            image_put_u32(writer, PATTERN_IMAGE_CAPTURE |
+                                      (capture->is_group_start ? PATTERN_IMAGE_CAPTURE_START : 0) |
+                                      (capture->is_group_end ? PATTERN_IMAGE_CAPTURE_END : 0));
+            image_put_string(writer, capture->name_offset == RIFT_FROZEN_NO_STRING
+                                         ? NULL
+                                         : frozen->string_pool + capture->name_offset);
+        } else {
+            image_put_u32(writer, 0);
+        }
+
+        const rift_frozen_counter_t *counter = rift_frozen_automaton_find_counter(frozen, i);
+        image_put_u32(writer, state->repeat_min);
+        image_put_u32(writer, state->repeat_max);
+        image_put_u32(writer, state->repeat_greedy ? 1u : 0u);
+        image_put_u32(writer, counter ? counter->start : RIFT_FROZEN_NO_STATE);
+
+        uint32_t num_tags = 0;
+        const uint32_t *tags = rift_frozen_automaton_get_accept_tags(frozen, i, &num_tags);
+        image_put_u32(writer, num_tags);
+        image_put(writer, tags, num_tags * sizeof(uint32_t));
+
+        uint32_t first = frozen->edge_offsets[i];
+        uint32_t end = frozen->edge_offsets[i + 1];
+        image_put_u32(writer, end - first);
+        for (uint32_t e = first; e < end; e++) {
+            image_put_u32(writer, frozen->edge_targets[e]);
+            image_put_u32(writer, frozen->edge_flags[e]);
+            image_put(writer, &frozen->edge_priorities[e], sizeof(int32_t));
+            if (!rift_frozen_automaton_edge_is_epsilon(frozen, e)) {
+                image_put_string(writer, rift_frozen_automaton_get_edge_pattern(frozen, e));
+            }
+        }
+    }
+
+    rift_frozen_automaton_free(frozen);
+
+    image_put_u32(writer, (uint32_t)automaton->num_lookarounds);
+    for (size_t i = 0; i < automaton->num_lookarounds; i++) {
+        const rift_lookaround_t *entry = &automaton->lookarounds[i];
+        image_put_u32(writer, entry->is_behind ? 1u : 0u);
+        image_put_u32(writer, entry->is_negated ? 1u : 0u);
+        image_put_u32(writer, entry->length);
+        write_automaton(writer, entry->body);
+    }
+}
+
+/**
+ * @brief Rebuild an automaton and the bodies of its lookarounds
+ *
+ * @param reader The reader
+ * @param depth Number of lookaround bodies the automaton is nested in
+ * @return The automaton, or NULL with the reader failed
+ */
+static rift_regex_automaton_t *
+read_automaton(image_reader_t *reader, unsigned depth)
+{
+    uint32_t type = image_get_u32(reader);
+    uint32_t is_deterministic = image_get_u32(reader);
+    uint32_t flags = image_get_u32(reader);
+    uint32_t num_states = image_get_u32(reader);
+    uint32_t start = image_get_u32(reader);
+
+    /* Every state takes some bytes, which bounds what a short image can ask for */
+    if (reader->failed || depth > PATTERN_IMAGE_MAX_DEPTH ||
+        (type != RIFT_AUTOMATON_NFA && type != RIFT_AUTOMATON_DFA) ||
+        num_states > (reader->size - reader->pos) / PATTERN_IMAGE_STATE_BYTES ||
+        (start >= num_states && start != RIFT_FROZEN_NO_STATE)) {
+        reader->failed = true;
+        return NULL;
+    }
+
+    rift_regex_automaton_t *automaton = rift_automaton_create((rift_automaton_type_t)type);
+    if (!automaton) {
+        reader->failed = reader->out_of_memory = true;
+        return NULL;
+    }
+    automaton->is_deterministic = is_deterministic != 0;
+    automaton->flags = (rift_regex_flags_t)flags;
+
+    /* Create every state first, so transitions can go to states read later */
+    for (uint32_t i = 0; i < num_states; i++) {
+        if (!rift_automaton_create_state(automaton, false)) {
+            reader->failed = reader->out_of_memory = true;
+            rift_automaton_free(automaton);
+            return NULL;
+        }
+    }
+    automaton->initial_state = start == RIFT_FROZEN_NO_STATE ? NULL : automaton->states[start];
+    automaton->current_state = automaton->initial_state;
+
+    for (uint32_t i = 0; i < num_states && !reader->failed; i++) {
+        rift_regex_state_t *state = automaton->states[i];
+        state->flags = (rift_state_flag_t)image_get_u32(reader);
+        bool is_accepting = image_get_u32(reader) != 0;
+        state->lookaround = image_get_u32(reader);
+        rift_state_set_accepting(state, is_accepting);
+
+        uint32_t capture = image_get_u32(reader);
+        if (capture & PATTERN_IMAGE_CAPTURE) {
+            const char *name = image_get_string(reader);
+            if (!reader->failed &&
+                ((name && !rift_state_set_group_name(state, name)) ||
+                 !rift_state_set_group_start(state, capture & PATTERN_IMAGE_CAPTURE_START) ||
+                 !rift_state_set_group_end(state, capture & PATTERN_IMAGE_CAPTURE_END))) {
+                reader->failed = reader->out_of_memory = true;
+            }
+        }
+
+        state->repeat_min = image_get_u32(reader);
+        state->repeat_max = image_get_u32(reader);
+        state->repeat_greedy = image_get_u32(reader) != 0;
+        uint32_t repeat_start = image_get_u32(reader);
+        if (repeat_start != RIFT_FROZEN_NO_STATE) {
+            if (repeat_start >= num_states) {
+                reader->failed = true;
+                break;
+            }
+            state->repeat_start = automaton->states[repeat_start];
+        }
+
+        uint32_t num_tags = image_get_u32(reader);
+        for (uint32_t t = 0; t < num_tags && !reader->failed; t++) {
+            uint32_t tag = image_get_u32(reader);
+            if (tag >= PATTERN_IMAGE_MAX_ACCEPT_TAG) {
+                reader->failed = true;
+            } else if (!reader->failed && !rift_state_add_accept_tag(state, tag)) {
+                reader->failed = reader->out_of_memory = true;
+            }
+        }
+
+        uint32_t num_edges = image_get_u32(reader);
+        for (uint32_t e = 0; e < num_edges && !reader->failed; e++) {
+            uint32_t target = image_get_u32(reader);
+            uint32_t edge_flags = image_get_u32(reader);
+            int32_t priority;
+            image_get(reader, &priority, sizeof(priority));
+            const char *text = (edge_flags & RIFT_FROZEN_EDGE_EPSILON) ? NULL
+                                                                       : image_get_string(reader);
+            if (reader->failed || target >= num_states ||
+                (!(edge_flags & RIFT_FROZEN_EDGE_EPSILON) && !text)) {
+                reader->failed = true;
+                break;
+            }
+
+            bool added = text ? rift_state_add_transition(state, automaton->states[target], text)
+                              : rift_state_add_epsilon_transition(state, automaton->states[target]);
+            if (!added) {
+                reader->failed = reader->out_of_memory = true;
+                break;
+            }
+            state->transitions[state->num_transitions - 1]->priority = priority;
+        }
+    }
+
+    uint32_t num_lookarounds = image_get_u32(reader);
+    for (uint32_t i = 0; i < num_lookarounds && !reader->failed; i++) {
+        bool is_behind = image_get_u32(reader) != 0;
+        bool is_negated = image_get_u32(reader) != 0;
+        uint32_t length = image_get_u32(reader);
+        rift_regex_automaton_t *body = read_automaton(reader, depth + 1);
+        if (body && rift_automaton_add_lookaround(automaton, body, is_behind, is_negated,
+                                                  length) == RIFT_STATE_NO_LOOKAROUND) {
+            reader->failed = reader->out_of_memory = true;
+        }
+    }
+
+    /* Every state runs a lookaround of the table or none */
+    for (uint32_t i = 0; i < num_states && !reader->failed; i++) {
+        uint32_t lookaround = automaton->states[i]->lookaround;
+        if (lookaround != RIFT_STATE_NO_LOOKAROUND && lookaround >= automaton->num_lookarounds) {
+            reader->failed = true;
+        }
+    }
+
+    if (reader->failed) {
+        rift_automaton_free(automaton);
+        return NULL;
+    }
+    return automaton;
+}
+
+/**
+ * @brief Write a group name table, slot by slot
+ *
+ * The slots are kept where they are, so the table needs no hashing on load.
+ *
+ * @param writer The writer
+ * @param names The table (can be NULL)
+ */
+static void
+write_group_names(image_writer_t *writer, const rift_group_names_t *names)
+{
+    image_put_u32(writer, names ? 1u : 0u);
+    if (!names) {
+        return;
+    }
+
+    size_t bytes = 0;
+    for (size_t i = 0; i < names->capacity; i++) {
+        const char *name = names->slots[i].name;
+        if (name && (size_t)(name - names->names) + strlen(name) + 1 > bytes) {
+            bytes = (size_t)(name - names->names) + strlen(name) + 1;
+        }
+    }
+    if (names->capacity >= UINT32_MAX || bytes >= UINT32_MAX) {
+        writer->failed = true;
+        return;
+    }
+
+    image_put_u32(writer, (uint32_t)names->capacity);
+    image_put_u32(writer, (uint32_t)names->count);
+    image_put_u32(writer, (uint32_t)bytes);
+    image_put(writer, names->names, bytes);
+    for (size_t i = 0; i < names->capacity; i++) {
+        const rift_group_name_slot_t *slot = &names->slots[i];
+        image_put_u32(writer, slot->name ? (uint32_t)(slot->name - names->names)
+                                         : PATTERN_IMAGE_NO_STRING);
+        image_put_u32(writer, slot->hash);
+        image_put_u32(writer, slot->index);
+    }
+}
+
+/**
+ * @brief Rebuild a group name table
+ *
+ * @param reader The reader
+ * @return The table, or NULL if none was written or with the reader failed
+ */
+static rift_group_names_t *
+read_group_names(image_reader_t *reader)
+{
+    if (image_get_u32(reader) == 0 || reader->failed) {
+        return NULL;
+    }
+
+    uint32_t capacity = image_get_u32(reader);
+    uint32_t count = image_get_u32(reader);
+    uint32_t bytes = image_get_u32(reader);
+    const unsigned char *block = reader->data + reader->pos;
+
+    /* Lookups probe until an empty slot, so one must be left */
+    if (reader->failed || capacity == 0 || (capacity & (capacity - 1)) != 0 ||
+        count >= capacity || bytes > reader->size - reader->pos ||
+        capacity > (reader->size - reader->pos - bytes) / (3 * sizeof(uint32_t)) ||
+        (bytes > 0 && block[bytes - 1] != '\0')) {
+        reader->failed = true;
+        return NULL;
+    }
+
+    rift_group_names_t *names = (rift_group_names_t *)rift_calloc(1, sizeof(rift_group_names_t));
+    if (names) {
+        names->capacity = capacity;
+        names->slots =
+            (rift_group_name_slot_t *)rift_calloc(capacity, sizeof(rift_group_name_slot_t));
+        names->names = bytes > 0 ? (char *)rift_malloc(bytes) : NULL;
+    }
+    if (!names || !names->slots || (bytes > 0 && !names->names)) {
+        rift_group_names_free(names);
+        reader->failed = reader->out_of_memory = true;
+        return NULL;
+    }
+    memcpy(names->names, block, bytes);
+    reader->pos += bytes;
+
+    for (uint32_t i = 0; i < capacity; i++) {
+        uint32_t offset = image_get_u32(reader);
+        names->slots[i].hash = image_get_u32(reader);
+        names->slots[i].index = image_get_u32(reader);
+        if (offset != PATTERN_IMAGE_NO_STRING) {
+            if (offset >= bytes) {
+                reader->failed = true;
+                break;
+            }
+            names->slots[i].name = names->names + offset;
+            names->count++;
+        }
+    }
+
+    if (reader->failed || names->count != count) {
+        rift_group_names_free(names);
+        reader->failed = true;
+        return NULL;
+    }
+    return names;
+}
+
+/**
+ * @brief Write the literal prefilter a matcher would build for a pattern
+ *
+ * @param writer The writer
+ * @param pattern The pattern
+ */
+static void
+write_prefilter(image_writer_t *writer, const rift_regex_pattern_t *pattern)
+{
+    /* The same prefilter the matcher keeps: only one that can rule out positions */
+    const rift_prefilter_t *prefilter = pattern->prefilter;
+    rift_prefilter_t *built = NULL;
+    if (!prefilter && pattern->ast) {
+        built = build_prefilter(pattern);
+        prefilter = built;
+    }
+
+    image_put_u32(writer, prefilter ? 1u : 0u);
+    if (prefilter) {
+        image_put(writer, prefilter, sizeof(*prefilter));
+    }
+    rift_prefilter_free(built);
+}
+
+/**
+ * @brief Check that a literal read back is terminated within its bytes
+ */
+static bool
+literal_is_valid(const rift_prefilter_literal_t *literal)
+{
+    return literal->length <= RIFT_PREFILTER_MAX_LITERAL_LENGTH &&
+           literal->bytes[literal->length] == '\0';
+}
+
+/**
+ * @brief Read a literal prefilter
+ *
+ * @param reader The reader
+ * @return The prefilter, or NULL if none was written or with the reader failed
+ */
+static rift_prefilter_t *
+read_prefilter(image_reader_t *reader)
+{
+    if (image_get_u32(reader) == 0 || reader->failed) {
+        return NULL;
+    }
+
+    rift_prefilter_t *prefilter = (rift_prefilter_t *)rift_malloc(sizeof(rift_prefilter_t));
+    if (!prefilter) {
+        reader->failed = reader->out_of_memory = true;
+        return NULL;
+    }
+    image_get(reader, prefilter, sizeof(*prefilter));
+
+    bool valid = !reader->failed && literal_is_valid(&prefilter->prefix) &&
+                 literal_is_valid(&prefilter->suffix) &&
+                 prefilter->num_required <= RIFT_PREFILTER_MAX_LITERALS &&
+                 prefilter->num_first_bytes <= 256;
+    for (size_t i = 0; valid && i < prefilter->num_required; i++) {
+        valid = literal_is_valid(&prefilter->required[i]);
+    }
+    if (!valid) {
+        rift_free(prefilter);
+        reader->failed = true;
+        return NULL;
+    }
+    return prefilter;
+}
+
 /**
  * @brief Serialize a pattern to a binary format for storage
  *
@@ -458,14 +1309,36 @@ bool
 rift_regex_pattern_serialize(const rift_regex_pattern_t *pattern, unsigned char **data,
                              size_t *size)
 {
-    /* Stub implementation - would require a full serialization format */
-    /* This would serialize the pattern's components (flags, source, automaton) */
-    /* For a real implementation, consider using a proper serialization library */
+    if (!pattern || !pattern->automaton || !data || !size) {
+        return false;
+    }
+
+    pattern_image_header_t header = {PATTERN_IMAGE_MAGIC, PATTERN_IMAGE_VERSION,
+                                     PATTERN_IMAGE_BYTE_ORDER, image_layout()};
+    image_writer_t writer = {NULL, 0, 0, false};
+    image_put(&writer, &header, sizeof(header));
+
+    image_put_u32(&writer, (uint32_t)pattern->flags);
+    image_put_u32(&writer, pattern->is_rift_syntax ? 1u : 0u);
+    image_put(&writer, &pattern->group_count, sizeof(pattern->group_count));
+    image_put_string(&writer, pattern->source);
+    image_put(&writer, &pattern->ambiguity, sizeof(pattern->ambiguity));
+    image_put(&writer, &pattern->engine_plan, sizeof(pattern->engine_plan));
+    image_put(&writer, &pattern->match_length, sizeof(pattern->match_length));
+    image_put(&writer, &pattern->config, sizeof(pattern->config));
+
+    write_group_names(&writer, pattern->group_names);
+    write_prefilter(&writer, pattern);
+    write_automaton(&writer, pattern->automaton);
+
+    if (writer.failed) {
+        free(writer.data);
+        return false;
+    }
 
-    (void)pattern;
-    (void)data;
-    (void)size;
-    return false;
+    *data = writer.data;
+    *size = writer.used;
+    return true;
 }
 
 /**
@@ -479,16 +1352,69 @@ rift_regex_pattern_serialize(const rift_regex_pattern_t *pattern, unsigned char
 rift_regex_pattern_t *
 rift_regex_pattern_deserialize(const unsigned char *data, size_t size, rift_regex_error_t *error)
 {
-    /* Stub implementation - would require a full deserialization format */
-    /* This would reconstruct the pattern from serialized components */
-    /* For a real implementation, consider using a proper serialization library */
+    pattern_image_header_t header;
+    if (!data || size < sizeof(header)) {
+        rift_regex_error_set_with_message(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                                          "Invalid serialized pattern");
+        return NULL;
+    }
 
-    (void)data;
-    (void)size;
-    if (error) {
-        error->code = RIFT_REGEX_ERROR_UNSUPPORTED_OPERATION;
+    memcpy(&header, data, sizeof(header));
+    if (header.magic != PATTERN_IMAGE_MAGIC || header.version != PATTERN_IMAGE_VERSION ||
+        header.byte_order != PATTERN_IMAGE_BYTE_ORDER || header.layout != image_layout()) {
+        rift_regex_error_set_with_message(
+            error, RIFT_REGEX_ERROR_UNSUPPORTED_OPERATION,
+            "Not a serialized pattern of this version, build and byte order");
+        return NULL;
     }
-    return NULL;
+
+    /* Allocate the pattern structure */
+    rift_regex_pattern_t *regex = (rift_regex_pattern_t *)malloc(sizeof(rift_regex_pattern_t));
+    if (!regex) {
+        rift_regex_error_set_with_message(error, RIFT_REGEX_ERROR_MEMORY_ALLOCATION,
+                                          "Failed to allocate memory for regex pattern");
+        return NULL;
+    }
+
+    /* Initialize the pattern; it is matched without an AST */
+    regex->source = NULL;
+    regex->ast = NULL;
+    regex->automaton = NULL;
+    regex->is_valid = true;
+    regex->error_message[0] = '\0';
+    regex->group_names = NULL;
+    regex->prefilter = NULL;
+    atomic_init(&regex->shared_refs, NULL);
+
+    image_reader_t reader = {data, size, sizeof(header), false, false};
+    regex->flags = (rift_regex_flags_t)image_get_u32(&reader);
+    regex->is_rift_syntax = image_get_u32(&reader) != 0;
+    image_get(&reader, &regex->group_count, sizeof(regex->group_count));
+    const char *source = image_get_string(&reader);
+    if (source && !(regex->source = strdup(source))) {
+        reader.failed = reader.out_of_memory = true;
+    }
+    image_get(&reader, &regex->ambiguity, sizeof(regex->ambiguity));
+    image_get(&reader, &regex->engine_plan, sizeof(regex->engine_plan));
+    image_get(&reader, &regex->match_length, sizeof(regex->match_length));
+    image_get(&reader, &regex->config, sizeof(regex->config));
+
+    regex->group_names = read_group_names(&reader);
+    regex->prefilter = read_prefilter(&reader);
+    regex->automaton = read_automaton(&reader, 0);
+
+    if (reader.failed || reader.pos != size) {
+        rift_regex_error_set_with_message(
+            error,
+            reader.out_of_memory ? RIFT_REGEX_ERROR_MEMORY_ALLOCATION
+                                 : RIFT_REGEX_ERROR_INVALID_PARAMETER,
+            reader.out_of_memory ? "Failed to allocate memory for deserialized pattern"
+                                 : "Serialized pattern is truncated or corrupt");
+        rift_regex_pattern_free(regex);
+        return NULL;
+    }
+
+    return regex;
 }
 
 /**
@@ -562,6 +1488,13 @@ rift_regex_pattern_from_ast(const rift_regex_ast_t *ast, rift_regex_flags_t flag
     regex->group_count = 0;
     regex->is_rift_syntax = false;
     regex->error_message[0] = '\0';
+    rift_ambiguity_verdict_init(&regex->ambiguity);
+    rift_engine_plan_init(&regex->engine_plan);
+    rift_match_length_bounds_init(&regex->match_length);
+    capture_config(regex);
+    regex->group_names = NULL;
+    regex->prefilter = NULL;
+    atomic_init(&regex->shared_refs, NULL);
 
     if (!regex->ast) {
         free(regex);
@@ -571,8 +1504,16 @@ rift_regex_pattern_from_ast(const rift_regex_ast_t *ast, rift_regex_flags_t flag
         return NULL;
     }
 
-    /* Count capture groups in the AST */
+    /* Count capture groups in the AST and resolve their names */
     regex->group_count = rift_regex_ast_count_groups(regex->ast);
+    regex->group_names = rift_group_names_build(regex->ast, error);
+    if (!regex->group_names) {
+        rift_regex_pattern_free(regex);
+        return NULL;
+    }
+
+    /* Make loops that cannot give anything back to what follows possessive */
+    rift_regex_auto_possessify(regex->ast, flags);
 
     /* Compile the AST to automaton */
     regex->automaton = rift_regex_compile_ast(regex->ast, flags, error);
@@ -589,6 +1530,17 @@ rift_regex_pattern_from_ast(const rift_regex_ast_t *ast, rift_regex_flags_t flag
         }
     }
 
+    /* Classify the pattern so the matcher can pick its engine up front */
+    rift_ambiguity_analyze(regex->ast, regex->automaton, &regex->ambiguity, NULL);
+    rift_engine_plan_build(regex->automaton, regex->group_count, &regex->ambiguity,
+                           &regex->engine_plan, NULL);
+    rift_match_length_analyze(regex->ast, flags, &regex->match_length);
+
+    /* Pick how searches find match starts from the literals the matcher will use */
+    rift_prefilter_t *prefilter = build_prefilter(regex);
+    rift_engine_plan_choose_search(&regex->engine_plan, regex->automaton, prefilter);
+    rift_prefilter_free(prefilter);
+
     /* Generate a source string representation from the AST */
     char *ast_string = rift_regex_ast_to_string(ast);
     if (ast_string) {
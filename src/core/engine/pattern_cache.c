@@ -0,0 +1,555 @@
+/**
+ * @file pattern_cache.c
+ * @brief Implementation of the shared cache of compiled patterns
+ *
+ * The cache is split into stripes by the hash of the pattern text, each with
+ * its own lock, hash table, LRU list and share of the budget, so lookups of
+ * different patterns rarely contend. The LRU list only holds entries nobody
+ * holds: a hit takes its entry off the list and the last release puts it
+ * back at the front, so evicting is always taking the list's tail. Misses
+ * compile outside the lock; when two threads compile the same pattern at
+ * once, the second to finish keeps the first one's entry and drops its own.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/engine/pattern_cache.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/automaton/dfa_table.h"
+#include "core/bytecode/bytecode_compiler.h"
+
+/**
+ * @brief Buckets of a stripe's hash table when it is created
+ */
+#define CACHE_INITIAL_BUCKETS 16
+
+/**
+ * @brief What an entry holds
+ */
+typedef enum cache_kind {
+    CACHE_PATTERN, /**< A rift_regex_pattern_t */
+    CACHE_BYTECODE /**< A rift_bytecode_program_t */
+} cache_kind_t;
+
+/**
+ * @brief One compiled pattern or program
+ */
+typedef struct cache_entry {
+    struct cache_entry *bucket_next; /**< Next entry in the bucket */
+    struct cache_entry *lru_prev;    /**< More recently released entry */
+    struct cache_entry *lru_next;    /**< Less recently released entry */
+    uint64_t hash;                   /**< Hash of the pattern text */
+    cache_kind_t kind;               /**< What value is */
+    rift_regex_flags_t flags;        /**< Compilation flags */
+    void *value;                     /**< The pattern or program, which owns the text */
+    size_t cost;                     /**< Estimated memory of the value */
+    size_t holders;                  /**< Callers holding the value */
+} cache_entry_t;
+
+/**
+ * @brief One independently locked part of a cache
+ */
+typedef struct cache_stripe {
+    pthread_mutex_t lock;    /**< Guards everything below */
+    cache_entry_t **buckets; /**< Hash table, a power of two of chains */
+    size_t num_buckets;      /**< Number of buckets */
+    size_t num_entries;      /**< Entries in the table */
+    size_t num_held;         /**< Entries with holders */
+    cache_entry_t *lru_head; /**< Most recently released unheld entry */
+    cache_entry_t *lru_tail; /**< Least recently released unheld entry */
+    size_t bytes;            /**< Estimated memory of the entries */
+    size_t budget;           /**< Share of the budget */
+    uint64_t hits;           /**< Lookups answered from the stripe */
+    uint64_t misses;         /**< Lookups that compiled */
+    uint64_t evictions;      /**< Entries freed to stay within the budget */
+} cache_stripe_t;
+
+/**
+ * @brief Cache of compiled patterns and bytecode programs
+ */
+struct rift_pattern_cache {
+    cache_stripe_t stripes[RIFT_PATTERN_CACHE_STRIPES]; /**< Parts chosen by hash */
+};
+
+static rift_pattern_cache_t *global_cache = NULL;
+static pthread_once_t global_cache_once = PTHREAD_ONCE_INIT;
+
+/**
+ * @brief Hash a pattern text with 64-bit FNV-1a
+ */
+static uint64_t
+hash_source(const char *source)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (const unsigned char *p = (const unsigned char *)source; *p; p++) {
+        hash = (hash ^ *p) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+/**
+ * @brief Get the pattern text a value was compiled from
+ */
+static const char *
+value_source(cache_kind_t kind, const void *value)
+{
+    if (kind == CACHE_PATTERN) {
+        return ((const rift_regex_pattern_t *)value)->source;
+    }
+    return ((const rift_bytecode_program_t *)value)->original_pattern;
+}
+
+/**
+ * @brief Free a value
+ */
+static void
+value_free(cache_kind_t kind, void *value)
+{
+    if (kind == CACHE_PATTERN) {
+        rift_regex_pattern_free((rift_regex_pattern_t *)value);
+    } else {
+        rift_bytecode_program_free((rift_bytecode_program_t *)value);
+    }
+}
+
+/**
+ * @brief Estimate the memory of a value from its largest parts
+ */
+static size_t
+value_cost(cache_kind_t kind, const void *value)
+{
+    if (kind == CACHE_PATTERN) {
+        const rift_regex_pattern_t *pattern = (const rift_regex_pattern_t *)value;
+        size_t cost = sizeof(*pattern) + strlen(pattern->source) + 1;
+        if (pattern->automaton) {
+            cost += pattern->automaton->num_states * (sizeof(rift_regex_state_t) + sizeof(void *));
+            cost += pattern->automaton->num_transitions *
+                    (sizeof(rift_regex_transition_t) + sizeof(void *));
+        }
+        return cost;
+    }
+
+    const rift_bytecode_program_t *program = (const rift_bytecode_program_t *)value;
+    size_t cost = sizeof(*program) + strlen(program->original_pattern) + 1;
+    cost += (size_t)program->capacity * sizeof(rift_bytecode_instruction_t);
+    cost += (size_t)program->char_class_count * RIFT_BYTECODE_CLASS_WORDS * sizeof(uint32_t);
+    cost += program->literal_pool_size;
+    for (uint32_t i = 0; i < program->dfa_table_count; i++) {
+        cost += rift_dfa_table_encoded_size(program->dfa_tables[i]);
+    }
+    return cost;
+}
+
+/**
+ * @brief Get the stripe of a hash
+ */
+static cache_stripe_t *
+stripe_of(rift_pattern_cache_t *cache, uint64_t hash)
+{
+    return &cache->stripes[hash % RIFT_PATTERN_CACHE_STRIPES];
+}
+
+/**
+ * @brief Get the bucket of a hash in a stripe
+ */
+static cache_entry_t **
+bucket_of(cache_stripe_t *stripe, uint64_t hash)
+{
+    // The low bits chose the stripe, so the bucket uses the ones above
+    return &stripe->buckets[(hash / RIFT_PATTERN_CACHE_STRIPES) & (stripe->num_buckets - 1)];
+}
+
+/**
+ * @brief Find the entry of a key in a stripe
+ */
+static cache_entry_t *
+stripe_find(cache_stripe_t *stripe, uint64_t hash, cache_kind_t kind, const char *source,
+            rift_regex_flags_t flags)
+{
+    for (cache_entry_t *entry = *bucket_of(stripe, hash); entry; entry = entry->bucket_next) {
+        if (entry->hash == hash && entry->kind == kind && entry->flags == flags &&
+            strcmp(value_source(kind, entry->value), source) == 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Double the buckets of a stripe; on failure the chains just stay longer
+ */
+static void
+stripe_grow(cache_stripe_t *stripe)
+{
+    size_t num_buckets = stripe->num_buckets * 2;
+    cache_entry_t **buckets = (cache_entry_t **)calloc(num_buckets, sizeof(cache_entry_t *));
+    if (!buckets) {
+        return;
+    }
+
+    cache_entry_t **old_buckets = stripe->buckets;
+    size_t old_count = stripe->num_buckets;
+    stripe->buckets = buckets;
+    stripe->num_buckets = num_buckets;
+    for (size_t i = 0; i < old_count; i++) {
+        cache_entry_t *entry = old_buckets[i];
+        while (entry) {
+            cache_entry_t *next = entry->bucket_next;
+            cache_entry_t **bucket = bucket_of(stripe, entry->hash);
+            entry->bucket_next = *bucket;
+            *bucket = entry;
+            entry = next;
+        }
+    }
+    free(old_buckets);
+}
+
+/**
+ * @brief Take an entry off the LRU list
+ */
+static void
+lru_unlink(cache_stripe_t *stripe, cache_entry_t *entry)
+{
+    if (entry->lru_prev) {
+        entry->lru_prev->lru_next = entry->lru_next;
+    } else {
+        stripe->lru_head = entry->lru_next;
+    }
+    if (entry->lru_next) {
+        entry->lru_next->lru_prev = entry->lru_prev;
+    } else {
+        stripe->lru_tail = entry->lru_prev;
+    }
+    entry->lru_prev = NULL;
+    entry->lru_next = NULL;
+}
+
+/**
+ * @brief Put an entry at the front of the LRU list
+ */
+static void
+lru_push(cache_stripe_t *stripe, cache_entry_t *entry)
+{
+    entry->lru_prev = NULL;
+    entry->lru_next = stripe->lru_head;
+    if (stripe->lru_head) {
+        stripe->lru_head->lru_prev = entry;
+    } else {
+        stripe->lru_tail = entry;
+    }
+    stripe->lru_head = entry;
+}
+
+/**
+ * @brief Remove an unheld entry from a stripe and free it
+ */
+static void
+stripe_evict(cache_stripe_t *stripe, cache_entry_t *entry)
+{
+    lru_unlink(stripe, entry);
+    cache_entry_t **link = bucket_of(stripe, entry->hash);
+    while (*link != entry) {
+        link = &(*link)->bucket_next;
+    }
+    *link = entry->bucket_next;
+
+    stripe->num_entries--;
+    stripe->bytes -= entry->cost;
+    value_free(entry->kind, entry->value);
+    free(entry);
+}
+
+/**
+ * @brief Evict the least recently released entries until the stripe fits its budget
+ */
+static void
+stripe_trim(cache_stripe_t *stripe)
+{
+    while (stripe->bytes > stripe->budget && stripe->lru_tail) {
+        stripe_evict(stripe, stripe->lru_tail);
+        stripe->evictions++;
+    }
+}
+
+/**
+ * @brief Take a hold on an entry
+ */
+static void
+entry_hold(cache_stripe_t *stripe, cache_entry_t *entry)
+{
+    if (entry->holders++ == 0) {
+        lru_unlink(stripe, entry);
+        stripe->num_held++;
+    }
+}
+
+/**
+ * @brief Compile a pattern into a value of the given kind
+ */
+static void *
+compile_value(cache_kind_t kind, const char *pattern, rift_regex_flags_t flags,
+              rift_regex_error_t *error)
+{
+    if (kind == CACHE_PATTERN) {
+        return rift_regex_compile(pattern, flags, error);
+    }
+
+    // The text is how a release finds the entry again, so a program must keep it
+    rift_bytecode_program_t *program = rift_bytecode_compile(pattern, flags, error);
+    if (program && !program->original_pattern) {
+        rift_bytecode_program_free(program);
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_MEMORY_ALLOCATION;
+        }
+        return NULL;
+    }
+    return program;
+}
+
+/**
+ * @brief Look up a pattern, compiling and inserting it on a miss
+ */
+static void *
+cache_acquire(rift_pattern_cache_t *cache, cache_kind_t kind, const char *pattern,
+              rift_regex_flags_t flags, rift_regex_error_t *error)
+{
+    if (!cache || !pattern) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+        }
+        return NULL;
+    }
+
+    uint64_t hash = hash_source(pattern);
+    cache_stripe_t *stripe = stripe_of(cache, hash);
+
+    pthread_mutex_lock(&stripe->lock);
+    cache_entry_t *entry = stripe_find(stripe, hash, kind, pattern, flags);
+    if (entry) {
+        entry_hold(stripe, entry);
+        stripe->hits++;
+        pthread_mutex_unlock(&stripe->lock);
+        return entry->value;
+    }
+    stripe->misses++;
+    pthread_mutex_unlock(&stripe->lock);
+
+    // Compiling can take long, so other lookups of the stripe go on meanwhile
+    void *value = compile_value(kind, pattern, flags, error);
+    if (!value) {
+        return NULL;
+    }
+    cache_entry_t *created = (cache_entry_t *)calloc(1, sizeof(cache_entry_t));
+    if (!created) {
+        value_free(kind, value);
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_MEMORY_ALLOCATION;
+        }
+        return NULL;
+    }
+    created->hash = hash;
+    created->kind = kind;
+    created->flags = flags;
+    created->value = value;
+    created->cost = value_cost(kind, value);
+
+    pthread_mutex_lock(&stripe->lock);
+    entry = stripe_find(stripe, hash, kind, pattern, flags);
+    if (entry) {
+        // Another thread compiled the same pattern first
+        entry_hold(stripe, entry);
+        pthread_mutex_unlock(&stripe->lock);
+        value_free(kind, value);
+        free(created);
+        return entry->value;
+    }
+
+    if (stripe->num_entries >= stripe->num_buckets) {
+        stripe_grow(stripe);
+    }
+    cache_entry_t **bucket = bucket_of(stripe, hash);
+    created->bucket_next = *bucket;
+    *bucket = created;
+    created->holders = 1;
+    stripe->num_entries++;
+    stripe->num_held++;
+    stripe->bytes += created->cost;
+    stripe_trim(stripe);
+    pthread_mutex_unlock(&stripe->lock);
+
+    return value;
+}
+
+/**
+ * @brief Drop a hold on the entry of a value
+ */
+static void
+cache_release(rift_pattern_cache_t *cache, cache_kind_t kind, const void *value)
+{
+    if (!cache || !value) {
+        return;
+    }
+
+    uint64_t hash = hash_source(value_source(kind, value));
+    cache_stripe_t *stripe = stripe_of(cache, hash);
+
+    pthread_mutex_lock(&stripe->lock);
+    for (cache_entry_t *entry = *bucket_of(stripe, hash); entry; entry = entry->bucket_next) {
+        if (entry->value == value) {
+            if (entry->holders > 0 && --entry->holders == 0) {
+                stripe->num_held--;
+                lru_push(stripe, entry);
+                stripe_trim(stripe);
+            }
+            break;
+        }
+    }
+    pthread_mutex_unlock(&stripe->lock);
+}
+
+rift_pattern_cache_t *
+rift_pattern_cache_create(size_t memory_budget)
+{
+    rift_pattern_cache_t *cache = (rift_pattern_cache_t *)calloc(1, sizeof(rift_pattern_cache_t));
+    if (!cache) {
+        return NULL;
+    }
+
+    if (memory_budget == 0) {
+        memory_budget = RIFT_PATTERN_CACHE_DEFAULT_BUDGET;
+    }
+    size_t stripe_budget = memory_budget / RIFT_PATTERN_CACHE_STRIPES;
+
+    for (size_t i = 0; i < RIFT_PATTERN_CACHE_STRIPES; i++) {
+        cache_stripe_t *stripe = &cache->stripes[i];
+        stripe->budget = stripe_budget > 0 ? stripe_budget : 1;
+        stripe->num_buckets = CACHE_INITIAL_BUCKETS;
+        stripe->buckets = (cache_entry_t **)calloc(CACHE_INITIAL_BUCKETS, sizeof(cache_entry_t *));
+        if (!stripe->buckets || pthread_mutex_init(&stripe->lock, NULL) != 0) {
+            free(stripe->buckets);
+            while (i-- > 0) {
+                free(cache->stripes[i].buckets);
+                pthread_mutex_destroy(&cache->stripes[i].lock);
+            }
+            free(cache);
+            return NULL;
+        }
+    }
+
+    return cache;
+}
+
+void
+rift_pattern_cache_free(rift_pattern_cache_t *cache)
+{
+    if (!cache) {
+        return;
+    }
+
+    for (size_t i = 0; i < RIFT_PATTERN_CACHE_STRIPES; i++) {
+        cache_stripe_t *stripe = &cache->stripes[i];
+        for (size_t b = 0; b < stripe->num_buckets; b++) {
+            cache_entry_t *entry = stripe->buckets[b];
+            while (entry) {
+                cache_entry_t *next = entry->bucket_next;
+                value_free(entry->kind, entry->value);
+                free(entry);
+                entry = next;
+            }
+        }
+        free(stripe->buckets);
+        pthread_mutex_destroy(&stripe->lock);
+    }
+    free(cache);
+}
+
+/**
+ * @brief Create the process-wide cache
+ */
+static void
+global_cache_create(void)
+{
+    global_cache = rift_pattern_cache_create(RIFT_PATTERN_CACHE_DEFAULT_BUDGET);
+}
+
+rift_pattern_cache_t *
+rift_pattern_cache_global(void)
+{
+    if (pthread_once(&global_cache_once, global_cache_create) != 0) {
+        return NULL;
+    }
+    return global_cache;
+}
+
+const rift_regex_pattern_t *
+rift_pattern_cache_compile(rift_pattern_cache_t *cache, const char *pattern,
+                           rift_regex_flags_t flags, rift_regex_error_t *error)
+{
+    return (const rift_regex_pattern_t *)cache_acquire(cache, CACHE_PATTERN, pattern, flags,
+                                                       error);
+}
+
+void
+rift_pattern_cache_release(rift_pattern_cache_t *cache, const rift_regex_pattern_t *pattern)
+{
+    cache_release(cache, CACHE_PATTERN, pattern);
+}
+
+const rift_bytecode_program_t *
+rift_pattern_cache_compile_bytecode(rift_pattern_cache_t *cache, const char *pattern,
+                                    rift_regex_flags_t flags, rift_regex_error_t *error)
+{
+    return (const rift_bytecode_program_t *)cache_acquire(cache, CACHE_BYTECODE, pattern, flags,
+                                                          error);
+}
+
+void
+rift_pattern_cache_release_bytecode(rift_pattern_cache_t *cache,
+                                    const rift_bytecode_program_t *program)
+{
+    cache_release(cache, CACHE_BYTECODE, program);
+}
+
+void
+rift_pattern_cache_clear(rift_pattern_cache_t *cache)
+{
+    if (!cache) {
+        return;
+    }
+
+    for (size_t i = 0; i < RIFT_PATTERN_CACHE_STRIPES; i++) {
+        cache_stripe_t *stripe = &cache->stripes[i];
+        pthread_mutex_lock(&stripe->lock);
+        while (stripe->lru_tail) {
+            stripe_evict(stripe, stripe->lru_tail);
+        }
+        pthread_mutex_unlock(&stripe->lock);
+    }
+}
+
+void
+rift_pattern_cache_get_stats(rift_pattern_cache_t *cache, rift_pattern_cache_stats_t *stats)
+{
+    if (!stats) {
+        return;
+    }
+    memset(stats, 0, sizeof(*stats));
+    if (!cache) {
+        return;
+    }
+
+    for (size_t i = 0; i < RIFT_PATTERN_CACHE_STRIPES; i++) {
+        cache_stripe_t *stripe = &cache->stripes[i];
+        pthread_mutex_lock(&stripe->lock);
+        stats->hits += stripe->hits;
+        stats->misses += stripe->misses;
+        stats->evictions += stripe->evictions;
+        stats->entries += stripe->num_entries;
+        stats->held += stripe->num_held;
+        stats->bytes += stripe->bytes;
+        pthread_mutex_unlock(&stripe->lock);
+    }
+}
@@ -0,0 +1,629 @@
+/**
+ * @file pattern_set.c
+ * @brief Implementation of multi-pattern matching for the LibRift regex engine
+ *
+ * This file implements pattern sets. The automata of all patterns are copied
+ * into one union NFA whose accepting states are tagged with their pattern
+ * identifier, and an unanchored lazy DFA over the union collects the tags of
+ * every state the input reaches. The union is kept across compiles, so
+ * changing one pattern of a large set only copies that pattern again. Sets of
+ * literals, such as keyword lists, are scanned with an Aho-Corasick automaton
+ * instead, which needs no state cache however many literals there are.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/engine/pattern_set.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/automaton/frozen_automaton.h"
+#include "core/automaton/state.h"
+#include "core/engine/pattern.h"
+#include "core/engine/pattern_cache.h"
+#include "core/memory/memory.h"
+
+/**
+ * @brief Drop the scanner of a set, keeping the union it runs on
+ */
+static void
+discard_scanner(rift_pattern_set_t *set)
+{
+    rift_lazy_dfa_free(set->scanner);
+    rift_aho_corasick_free(set->literals);
+    rift_free(set->matched);
+    set->scanner = NULL;
+    set->literals = NULL;
+    set->matched = NULL;
+    set->matched_words = 0;
+}
+
+/**
+ * @brief Drop the compiled union and scanner of a set
+ */
+static void
+discard_compiled(rift_pattern_set_t *set)
+{
+    discard_scanner(set);
+    rift_automaton_free(set->combined);
+    set->combined = NULL;
+    set->dead_states = 0;
+    for (size_t i = 0; i < set->num_patterns; i++) {
+        set->merged[i] = false;
+    }
+}
+
+/**
+ * @brief Cut the copy of a pattern off from the start state of the union
+ *
+ * Its states stay in the union, unreachable, until the next rebuild.
+ */
+static void
+cut_off_pattern(rift_pattern_set_t *set, uint32_t id)
+{
+    if (!set->merged[id] || !set->combined) {
+        return;
+    }
+    set->merged[id] = false;
+    if (set->union_starts[id] == RIFT_PATTERN_SET_NOT_MERGED) {
+        return;
+    }
+
+    rift_regex_state_t *start = set->combined->initial_state;
+    rift_regex_state_t *entry = set->combined->states[set->union_starts[id]];
+    for (size_t t = 0; t < start->num_transitions; t++) {
+        if (start->transitions[t]->is_epsilon && start->transitions[t]->to_state == entry) {
+            rift_state_remove_transition(start, t);
+            break;
+        }
+    }
+    rift_automaton_invalidate_epsilon_closures(set->combined);
+    set->dead_states += set->union_sizes[id];
+}
+
+/**
+ * @brief Copy the states and transitions of one pattern into the union
+ *
+ * @param combined The union automaton
+ * @param automaton The automaton of the pattern
+ * @param id The pattern identifier used as accept tag
+ * @param start Pointer to store the union state the copy starts at
+ * @param size Pointer to store the number of union states of the copy
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+static bool
+append_pattern(rift_regex_automaton_t *combined, const rift_regex_automaton_t *automaton,
+               uint32_t id, size_t *start, size_t *size, rift_regex_error_t *error)
+{
+    rift_frozen_automaton_t *frozen = rift_frozen_automaton_create(automaton, error);
+    if (!frozen) {
+        return false;
+    }
+
+    /* State i of the pattern becomes state base + i of the union */
+    size_t base = combined->num_states;
+    *start = RIFT_PATTERN_SET_NOT_MERGED;
+    *size = 0;
+
+    if (frozen->start_state == RIFT_FROZEN_NO_STATE) {
+        rift_frozen_automaton_free(frozen);
+        return true;
+    }
+
+    bool success = false;
+
+    for (uint32_t i = 0; i < frozen->num_states; i++) {
+        rift_regex_state_t *state = rift_automaton_create_state(combined, false);
+        if (!state) {
+            goto cleanup;
+        }
+        state->flags = (rift_state_flag_t)frozen->state_flags[i];
+        if (rift_frozen_automaton_is_accepting(frozen, i) &&
+            !rift_state_add_accept_tag(state, id)) {
+            goto cleanup;
+        }
+    }
+
+    for (uint32_t i = 0; i < frozen->num_states; i++) {
+        rift_regex_state_t *state = combined->states[base + i];
+
+        for (uint32_t e = frozen->edge_offsets[i]; e < frozen->edge_offsets[i + 1]; e++) {
+            rift_regex_state_t *target = combined->states[base + frozen->edge_targets[e]];
+            bool added;
+
+            if (rift_frozen_automaton_edge_is_epsilon(frozen, e)) {
+                added = rift_state_add_epsilon_transition(state, target);
+            } else {
+                const char *pattern = rift_frozen_automaton_get_edge_pattern(frozen, e);
+                added = pattern && rift_state_add_transition(state, target, pattern);
+            }
+
+            if (!added) {
+                goto cleanup;
+            }
+        }
+    }
+
+    success = rift_state_add_epsilon_transition(combined->initial_state,
+                                                combined->states[base + frozen->start_state]);
+    *start = base + frozen->start_state;
+    *size = frozen->num_states;
+
+cleanup:
+    if (!success && error) {
+        error->code = RIFT_REGEX_ERROR_MEMORY;
+        snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                 "Failed to copy pattern %u into the pattern set", id);
+    }
+    rift_frozen_automaton_free(frozen);
+    return success;
+}
+
+/**
+ * @brief Build an Aho-Corasick automaton over the literals of every pattern
+ *
+ * @return The automaton, or NULL when a pattern does not expand to literals
+ */
+static rift_aho_corasick_t *
+build_literal_scanner(const rift_pattern_set_t *set)
+{
+    if (set->num_patterns == 0) {
+        return NULL;
+    }
+
+    rift_aho_corasick_t *literals = rift_aho_corasick_create(NULL);
+    for (size_t i = 0; literals && i < set->num_patterns; i++) {
+        if (!rift_aho_corasick_add_automaton(literals, set->automata[i], (uint32_t)i, NULL)) {
+            rift_aho_corasick_free(literals);
+            literals = NULL;
+        }
+    }
+    if (literals && !rift_aho_corasick_build(literals, NULL)) {
+        rift_aho_corasick_free(literals);
+        literals = NULL;
+    }
+    return literals;
+}
+
+/**
+ * @brief Create an empty pattern set
+ *
+ * @param max_cached_states State cache capacity of the scanner (0 for the default)
+ * @return A new pattern set or NULL on failure
+ */
+rift_pattern_set_t *
+rift_pattern_set_create(size_t max_cached_states)
+{
+    rift_pattern_set_t *set = (rift_pattern_set_t *)rift_calloc(1, sizeof(rift_pattern_set_t));
+    if (!set) {
+        return NULL;
+    }
+
+    set->max_cached_states = max_cached_states;
+    return set;
+}
+
+/**
+ * @brief Free a pattern set
+ *
+ * @param set The pattern set to free
+ */
+void
+rift_pattern_set_free(rift_pattern_set_t *set)
+{
+    if (!set) {
+        return;
+    }
+
+    discard_compiled(set);
+    for (size_t i = 0; i < set->num_patterns; i++) {
+        rift_automaton_free(set->automata[i]);
+    }
+    rift_free(set->automata);
+    rift_free(set->union_starts);
+    rift_free(set->union_sizes);
+    rift_free(set->merged);
+    rift_free(set);
+}
+
+/**
+ * @brief Compile a pattern through the shared cache, or alone without one
+ */
+static const rift_regex_pattern_t *
+compile_shared(rift_pattern_cache_t *cache, const char *pattern, rift_regex_flags_t flags,
+               rift_regex_error_t *error)
+{
+    return cache ? rift_pattern_cache_compile(cache, pattern, flags, error)
+                 : rift_regex_compile(pattern, flags, error);
+}
+
+/**
+ * @brief Give back a pattern from compile_shared
+ */
+static void
+release_shared(rift_pattern_cache_t *cache, const rift_regex_pattern_t *pattern)
+{
+    if (cache) {
+        rift_pattern_cache_release(cache, pattern);
+    } else {
+        rift_regex_pattern_free((rift_regex_pattern_t *)pattern);
+    }
+}
+
+/**
+ * @brief Compile a pattern and add it to a set
+ *
+ * @param set The pattern set
+ * @param pattern The pattern string
+ * @param flags Compilation flags
+ * @param id Pointer to store the identifier of the pattern (can be NULL)
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+bool
+rift_pattern_set_add(rift_pattern_set_t *set, const char *pattern, rift_regex_flags_t flags,
+                     uint32_t *id, rift_regex_error_t *error)
+{
+    if (!set || !pattern) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Invalid parameters for pattern set add");
+        }
+        return false;
+    }
+
+    rift_pattern_cache_t *cache = rift_pattern_cache_global();
+    const rift_regex_pattern_t *compiled = compile_shared(cache, pattern, flags, error);
+    if (!compiled) {
+        return false;
+    }
+
+    bool success = rift_pattern_set_add_automaton(
+        set, rift_regex_pattern_get_automaton(compiled), id, error);
+    release_shared(cache, compiled);
+    return success;
+}
+
+/**
+ * @brief Add a compiled automaton to a set
+ *
+ * @param set The pattern set
+ * @param automaton The automaton of the pattern
+ * @param id Pointer to store the identifier of the pattern (can be NULL)
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+bool
+rift_pattern_set_add_automaton(rift_pattern_set_t *set, const rift_regex_automaton_t *automaton,
+                               uint32_t *id, rift_regex_error_t *error)
+{
+    if (!set || !automaton) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Invalid parameters for pattern set add");
+        }
+        return false;
+    }
+
+    if (set->num_patterns >= UINT32_MAX) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_LIMIT_EXCEEDED;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Pattern set is full");
+        }
+        return false;
+    }
+
+    if (set->num_patterns == set->capacity) {
+        size_t capacity = set->capacity > 0 ? set->capacity * 2 : 16;
+        rift_regex_automaton_t **automata = (rift_regex_automaton_t **)rift_realloc(
+            set->automata, capacity * sizeof(rift_regex_automaton_t *));
+        if (automata) {
+            set->automata = automata;
+        }
+        size_t *starts = (size_t *)rift_realloc(set->union_starts, capacity * sizeof(size_t));
+        if (starts) {
+            set->union_starts = starts;
+        }
+        size_t *sizes = (size_t *)rift_realloc(set->union_sizes, capacity * sizeof(size_t));
+        if (sizes) {
+            set->union_sizes = sizes;
+        }
+        bool *merged = (bool *)rift_realloc(set->merged, capacity * sizeof(bool));
+        if (merged) {
+            set->merged = merged;
+        }
+
+        // Arrays that did grow are only used up to the old capacity until all have
+        if (!automata || !starts || !sizes || !merged) {
+            if (error) {
+                error->code = RIFT_REGEX_ERROR_MEMORY;
+                snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                         "Failed to grow pattern set");
+            }
+            return false;
+        }
+        set->capacity = capacity;
+    }
+
+    rift_regex_automaton_t *copy = rift_automaton_clone(automaton);
+    if (!copy) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_MEMORY;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Failed to copy pattern automaton");
+        }
+        return false;
+    }
+
+    discard_scanner(set);
+    if (id) {
+        *id = (uint32_t)set->num_patterns;
+    }
+    set->merged[set->num_patterns] = false;
+    set->automata[set->num_patterns++] = copy;
+    return true;
+}
+
+/**
+ * @brief Compile a pattern and put it in place of one in a set
+ *
+ * @param set The pattern set
+ * @param id The identifier of the pattern to replace
+ * @param pattern The new pattern string
+ * @param flags Compilation flags
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise, leaving the old pattern in place
+ */
+bool
+rift_pattern_set_replace(rift_pattern_set_t *set, uint32_t id, const char *pattern,
+                         rift_regex_flags_t flags, rift_regex_error_t *error)
+{
+    if (!set || !pattern || id >= set->num_patterns) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Invalid parameters for pattern set replace");
+        }
+        return false;
+    }
+
+    rift_pattern_cache_t *cache = rift_pattern_cache_global();
+    const rift_regex_pattern_t *compiled = compile_shared(cache, pattern, flags, error);
+    if (!compiled) {
+        return false;
+    }
+
+    bool success = rift_pattern_set_replace_automaton(
+        set, id, rift_regex_pattern_get_automaton(compiled), error);
+    release_shared(cache, compiled);
+    return success;
+}
+
+/**
+ * @brief Put a compiled automaton in place of a pattern of a set
+ *
+ * @param set The pattern set
+ * @param id The identifier of the pattern to replace
+ * @param automaton The new automaton of the pattern
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise, leaving the old pattern in place
+ */
+bool
+rift_pattern_set_replace_automaton(rift_pattern_set_t *set, uint32_t id,
+                                   const rift_regex_automaton_t *automaton,
+                                   rift_regex_error_t *error)
+{
+    if (!set || !automaton || id >= set->num_patterns) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Invalid parameters for pattern set replace");
+        }
+        return false;
+    }
+
+    rift_regex_automaton_t *copy = rift_automaton_clone(automaton);
+    if (!copy) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_MEMORY;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Failed to copy pattern automaton");
+        }
+        return false;
+    }
+
+    discard_scanner(set);
+    cut_off_pattern(set, id);
+    rift_automaton_free(set->automata[id]);
+    set->automata[id] = copy;
+    return true;
+}
+
+/**
+ * @brief Build the union automaton and scanner of a set
+ *
+ * @param set The pattern set
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+bool
+rift_pattern_set_compile(rift_pattern_set_t *set, rift_regex_error_t *error)
+{
+    if (!set) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Null pattern set provided");
+        }
+        return false;
+    }
+
+    discard_scanner(set);
+
+    // Unreachable copies still cost the scanner, so once they outnumber the
+    // live states the union is built again from scratch
+    if (set->combined && set->dead_states * 2 > set->combined->num_states) {
+        discard_compiled(set);
+    }
+
+    if (!set->combined) {
+        set->combined = rift_automaton_create(RIFT_AUTOMATON_NFA);
+        rift_regex_state_t *start =
+            set->combined ? rift_automaton_create_state(set->combined, false) : NULL;
+        if (!start || !rift_automaton_set_initial_state(set->combined, start)) {
+            if (error) {
+                error->code = RIFT_REGEX_ERROR_MEMORY;
+                snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                         "Failed to create pattern set automaton");
+            }
+            discard_compiled(set);
+            return false;
+        }
+    }
+
+    set->matched_words = (set->num_patterns + 63) / 64;
+    set->matched = (uint64_t *)rift_calloc(set->matched_words + 1, sizeof(uint64_t));
+    if (!set->matched) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_MEMORY;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Failed to create pattern set automaton");
+        }
+        discard_scanner(set);
+        return false;
+    }
+
+    // Only patterns added or replaced since the last compile are copied
+    for (size_t i = 0; i < set->num_patterns; i++) {
+        if (set->merged[i]) {
+            continue;
+        }
+        if (!append_pattern(set->combined, set->automata[i], (uint32_t)i, &set->union_starts[i],
+                            &set->union_sizes[i], error)) {
+            discard_compiled(set);
+            return false;
+        }
+        set->merged[i] = true;
+    }
+    rift_automaton_invalidate_epsilon_closures(set->combined);
+
+    // The union is still kept for callers of rift_pattern_set_get_automaton()
+    set->literals = build_literal_scanner(set);
+    if (set->literals) {
+        return true;
+    }
+    set->scanner =
+        rift_lazy_dfa_create_unanchored(set->combined, set->max_cached_states, error);
+    if (!set->scanner) {
+        discard_compiled(set);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Get the union automaton of a compiled set
+ *
+ * @param set The pattern set
+ * @return The union automaton or NULL if the set is not compiled
+ */
+const rift_regex_automaton_t *
+rift_pattern_set_get_automaton(const rift_pattern_set_t *set)
+{
+    // Between a change and the next compile the union may miss patterns
+    return set && (set->scanner || set->literals) ? set->combined : NULL;
+}
+
+/**
+ * @brief Get the number of patterns in a set
+ *
+ * @param set The pattern set
+ * @return Number of patterns
+ */
+size_t
+rift_pattern_set_get_count(const rift_pattern_set_t *set)
+{
+    return set ? set->num_patterns : 0;
+}
+
+/**
+ * @brief Find every pattern that matches somewhere in the input
+ *
+ * @param set The pattern set
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param ids Array for the identifiers of matching patterns in ascending order (can be NULL)
+ * @param max_ids Capacity of the ids array
+ * @param error Pointer to store error information (can be NULL)
+ * @return Number of matching patterns, which may exceed max_ids, or 0 on failure
+ */
+size_t
+rift_pattern_set_scan(rift_pattern_set_t *set, const char *input, size_t length, uint32_t *ids,
+                      size_t max_ids, rift_regex_error_t *error)
+{
+    if (!set || (!input && length > 0)) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Invalid parameters for pattern set scan");
+        }
+        return 0;
+    }
+
+    if (!set->scanner && !set->literals && !rift_pattern_set_compile(set, error)) {
+        return 0;
+    }
+
+    bool scanned = set->literals ? rift_aho_corasick_scan(set->literals, input, length,
+                                                          set->matched, set->matched_words + 1)
+                                 : rift_lazy_dfa_scan_tags(set->scanner, input, length,
+                                                           set->matched, set->matched_words + 1);
+    if (!scanned) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_MEMORY;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Failed to scan input with pattern set");
+        }
+        return 0;
+    }
+
+    size_t count = 0;
+    for (size_t w = 0; w < set->matched_words; w++) {
+        if (!set->matched[w]) {
+            continue;
+        }
+        for (unsigned bit = 0; bit < 64; bit++) {
+            if (set->matched[w] & ((uint64_t)1 << bit)) {
+                if (ids && count < max_ids) {
+                    ids[count] = (uint32_t)(w * 64 + bit);
+                }
+                count++;
+            }
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief Check whether a pattern matched in the last scan
+ *
+ * @param set The pattern set
+ * @param id The pattern identifier
+ * @return true if the pattern matched, false otherwise
+ */
+bool
+rift_pattern_set_matched(const rift_pattern_set_t *set, uint32_t id)
+{
+    if (!set || !set->matched || id >= set->num_patterns) {
+        return false;
+    }
+
+    return (set->matched[id / 64] >> (id % 64)) & 1u;
+}
@@ -0,0 +1,613 @@
+/**
+ * @file rulebank.c
+ * @brief Implementation of rule banks for the LibRift regex engine
+ *
+ * The compiled patterns of a bank are shared by every thread. The matchers
+ * are not: each thread gets an arena with one matcher per rule, found
+ * through a _Thread_local cache as the safe backtracker finds its arenas,
+ * so the bank's mutex is only taken on a thread's first match. An arena
+ * goes when its thread exits or with the bank, whichever comes first.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/engine/rulebank.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include "core/engine/pattern.h"
+#include "core/engine/pattern_cache.h"
+#include "core/memory/memory.h"
+#include "core/runtime/matcher.h"
+
+/**
+ * @brief Number of rule banks a thread finds without a key lookup
+ */
+#define RULEBANK_TLS_SLOTS 4
+
+/**
+ * @brief A thread's matchers for one rule bank
+ */
+struct rift_rulebank_arena {
+    rift_rulebank_t *owner;             /**< Rule bank this arena belongs to */
+    rift_regex_matcher_t **matchers;    /**< One matcher per rule */
+    struct rift_rulebank_arena *prev;   /**< Previous arena of the owner */
+    struct rift_rulebank_arena *next;   /**< Next arena of the owner */
+};
+
+/**
+ * @brief Rule bank structure
+ */
+struct rift_rulebank {
+    rift_rulebank_option_t options;         /**< Options of the bank */
+    char **names;                           /**< Name of each rule */
+    const rift_regex_pattern_t **patterns;  /**< Compiled pattern of each rule */
+    size_t *group_counts;                   /**< Capture groups of each rule */
+    size_t num_rules;                       /**< Number of rules */
+    size_t capacity;                        /**< Capacity of the rule arrays */
+    rift_pattern_cache_t *cache;            /**< Cache the patterns came from, or NULL */
+    pthread_key_t thread_local_key;         /**< Key of each thread's arena, for thread exit */
+    pthread_mutex_t mutex;                  /**< Guards arenas */
+    struct rift_rulebank_arena *arenas;     /**< Arenas of the threads that matched */
+    uint64_t id;                            /**< Process-unique id keying thread caches */
+    atomic_bool sealed;                     /**< Whether a match has run, closing the rules */
+};
+
+/**
+ * @brief Match results structure
+ */
+struct rift_rulebank_results {
+    size_t num_rules;         /**< Rules of the bank the results were made for */
+    size_t num_matched;       /**< Rules that matched the last line */
+    uint32_t first;           /**< First rule that matched, RIFT_RULEBANK_NO_RULE if none */
+    bool *matched;            /**< Whether each rule matched */
+    size_t *offsets;          /**< First span of each rule, num_rules + 1 of them */
+    rift_regex_span_t *spans; /**< Spans of every rule, 1 + its groups each */
+};
+
+/**
+ * @brief Entry of the per-thread cache, keyed by the owner's id
+ *
+ * Ids are never reused, so an entry left behind by a freed bank can never
+ * match again.
+ */
+typedef struct tls_slot {
+    uint64_t id;                        /**< Id of the owner, 0 if empty */
+    struct rift_rulebank_arena *arena;  /**< The calling thread's arena */
+} tls_slot_t;
+
+static _Thread_local tls_slot_t tls_cache[RULEBANK_TLS_SLOTS];
+static _Thread_local size_t tls_next_slot;
+
+/* Source of rule bank ids */
+static atomic_uint_fast64_t next_rulebank_id = 1;
+
+/**
+ * @brief Set an error code and message
+ */
+static void
+set_error(rift_regex_error_t *error, rift_regex_error_code_t code, const char *message)
+{
+    if (error) {
+        error->code = code;
+        snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH, "%s", message);
+    }
+}
+
+/**
+ * @brief Compile a pattern through the cache when there is one
+ */
+static const rift_regex_pattern_t *
+compile_shared(rift_pattern_cache_t *cache, const char *pattern, rift_regex_flags_t flags,
+               rift_regex_error_t *error)
+{
+    return cache ? rift_pattern_cache_compile(cache, pattern, flags, error)
+                 : rift_regex_compile(pattern, flags, error);
+}
+
+/**
+ * @brief Give back a pattern from compile_shared
+ */
+static void
+release_shared(rift_pattern_cache_t *cache, const rift_regex_pattern_t *pattern)
+{
+    if (cache) {
+        rift_pattern_cache_release(cache, pattern);
+    } else {
+        rift_regex_pattern_free((rift_regex_pattern_t *)pattern);
+    }
+}
+
+/**
+ * @brief Free an arena and its matchers
+ */
+static void
+destroy_arena(struct rift_rulebank_arena *arena)
+{
+    for (size_t i = 0; arena->matchers && i < arena->owner->num_rules; i++) {
+        rift_matcher_free(arena->matchers[i]);
+    }
+    rift_free(arena->matchers);
+    rift_free(arena);
+}
+
+/**
+ * @brief Unlink an arena from its owner and free it
+ *
+ * @param arena The arena, whose owner's mutex is held
+ */
+static void
+free_arena_locked(struct rift_rulebank_arena *arena)
+{
+    if (arena->prev) {
+        arena->prev->next = arena->next;
+    } else {
+        arena->owner->arenas = arena->next;
+    }
+    if (arena->next) {
+        arena->next->prev = arena->prev;
+    }
+    destroy_arena(arena);
+}
+
+/**
+ * @brief Free the arena of an exiting thread
+ *
+ * Registered with pthread_key_create().
+ *
+ * @param arena The exiting thread's arena
+ */
+static void
+thread_local_arena_cleanup(void *arena)
+{
+    struct rift_rulebank_arena *local = (struct rift_rulebank_arena *)arena;
+    if (!local) {
+        return;
+    }
+
+    rift_rulebank_t *owner = local->owner;
+    pthread_mutex_lock(&owner->mutex);
+    free_arena_locked(local);
+    pthread_mutex_unlock(&owner->mutex);
+}
+
+/**
+ * @brief Create and register the calling thread's arena
+ *
+ * This is the one place a thread takes the bank's mutex on its way to its
+ * matchers.
+ *
+ * @param bank The rule bank
+ * @return The new arena or NULL on failure
+ */
+static struct rift_rulebank_arena *
+register_arena(rift_rulebank_t *bank)
+{
+    struct rift_rulebank_arena *arena =
+        (struct rift_rulebank_arena *)rift_calloc(1, sizeof(*arena));
+    if (!arena) {
+        return NULL;
+    }
+    arena->owner = bank;
+    arena->matchers = (rift_regex_matcher_t **)rift_calloc(bank->num_rules ? bank->num_rules : 1,
+                                                           sizeof(rift_regex_matcher_t *));
+    bool created = arena->matchers != NULL;
+    for (size_t i = 0; created && i < bank->num_rules; i++) {
+        arena->matchers[i] = rift_matcher_create(bank->patterns[i], RIFT_MATCHER_OPTION_NONE);
+        created = arena->matchers[i] != NULL;
+    }
+
+    if (!created || pthread_mutex_lock(&bank->mutex) != 0) {
+        destroy_arena(arena);
+        return NULL;
+    }
+
+    if (pthread_setspecific(bank->thread_local_key, arena) != 0) {
+        pthread_mutex_unlock(&bank->mutex);
+        destroy_arena(arena);
+        return NULL;
+    }
+
+    arena->next = bank->arenas;
+    if (arena->next) {
+        arena->next->prev = arena;
+    }
+    bank->arenas = arena;
+
+    pthread_mutex_unlock(&bank->mutex);
+    return arena;
+}
+
+/**
+ * @brief Get the calling thread's arena, creating it on first use
+ *
+ * @param bank The rule bank
+ * @return The arena or NULL on failure
+ */
+static struct rift_rulebank_arena *
+get_local_arena(rift_rulebank_t *bank)
+{
+    for (size_t i = 0; i < RULEBANK_TLS_SLOTS; i++) {
+        if (tls_cache[i].id == bank->id) {
+            return tls_cache[i].arena;
+        }
+    }
+
+    struct rift_rulebank_arena *arena =
+        (struct rift_rulebank_arena *)pthread_getspecific(bank->thread_local_key);
+    if (!arena) {
+        arena = register_arena(bank);
+        if (!arena) {
+            return NULL;
+        }
+    }
+
+    tls_slot_t *slot = &tls_cache[tls_next_slot];
+    tls_next_slot = (tls_next_slot + 1) % RULEBANK_TLS_SLOTS;
+    slot->id = bank->id;
+    slot->arena = arena;
+    return arena;
+}
+
+/**
+ * @brief Create an empty rule bank
+ *
+ * @param options Options of the bank
+ * @return A new rule bank or NULL on failure
+ */
+rift_rulebank_t *
+rift_rulebank_create(rift_rulebank_option_t options)
+{
+    rift_rulebank_t *bank = (rift_rulebank_t *)rift_calloc(1, sizeof(rift_rulebank_t));
+    if (!bank) {
+        return NULL;
+    }
+
+    if (pthread_mutex_init(&bank->mutex, NULL) != 0) {
+        rift_free(bank);
+        return NULL;
+    }
+    if (pthread_key_create(&bank->thread_local_key, thread_local_arena_cleanup) != 0) {
+        pthread_mutex_destroy(&bank->mutex);
+        rift_free(bank);
+        return NULL;
+    }
+
+    bank->options = options;
+    bank->cache = rift_pattern_cache_global();
+    bank->id = atomic_fetch_add_explicit(&next_rulebank_id, 1, memory_order_relaxed);
+    atomic_init(&bank->sealed, false);
+    return bank;
+}
+
+/**
+ * @brief Free a rule bank and the matchers of every thread
+ *
+ * @param bank The rule bank (can be NULL)
+ */
+void
+rift_rulebank_free(rift_rulebank_t *bank)
+{
+    if (!bank) {
+        return;
+    }
+
+    /* No destructor runs from here on, so the arenas left are freed here */
+    pthread_key_delete(bank->thread_local_key);
+    while (bank->arenas) {
+        free_arena_locked(bank->arenas);
+    }
+    pthread_mutex_destroy(&bank->mutex);
+
+    for (size_t i = 0; i < bank->num_rules; i++) {
+        release_shared(bank->cache, bank->patterns[i]);
+        rift_free(bank->names[i]);
+    }
+    rift_free(bank->names);
+    rift_free(bank->patterns);
+    rift_free(bank->group_counts);
+    rift_free(bank);
+}
+
+/**
+ * @brief Make room for one more rule
+ */
+static bool
+grow_rules(rift_rulebank_t *bank)
+{
+    if (bank->num_rules < bank->capacity) {
+        return true;
+    }
+
+    size_t capacity = bank->capacity ? bank->capacity * 2 : 8;
+    char **names = (char **)rift_realloc(bank->names, capacity * sizeof(char *));
+    if (!names) {
+        return false;
+    }
+    bank->names = names;
+    const rift_regex_pattern_t **patterns = (const rift_regex_pattern_t **)rift_realloc(
+        (void *)bank->patterns, capacity * sizeof(rift_regex_pattern_t *));
+    if (!patterns) {
+        return false;
+    }
+    bank->patterns = patterns;
+    size_t *group_counts = (size_t *)rift_realloc(bank->group_counts, capacity * sizeof(size_t));
+    if (!group_counts) {
+        return false;
+    }
+    bank->group_counts = group_counts;
+    bank->capacity = capacity;
+    return true;
+}
+
+/**
+ * @brief Compile a pattern and add it to a bank as a named rule
+ *
+ * @param bank The rule bank
+ * @param name Name of the rule, unique in the bank (copied)
+ * @param pattern The pattern string
+ * @param flags Compilation flags
+ * @param rule Pointer to store the index of the rule (can be NULL)
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+bool
+rift_rulebank_add(rift_rulebank_t *bank, const char *name, const char *pattern,
+                  rift_regex_flags_t flags, uint32_t *rule, rift_regex_error_t *error)
+{
+    if (!bank || !name || !pattern) {
+        set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                  "Invalid parameters for rule bank add");
+        return false;
+    }
+    if (atomic_load_explicit(&bank->sealed, memory_order_relaxed)) {
+        set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                  "Rules cannot be added to a rule bank after its first match");
+        return false;
+    }
+    if (rift_rulebank_find(bank, name) != RIFT_RULEBANK_NO_RULE) {
+        set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER, "Duplicate rule name in rule bank");
+        return false;
+    }
+    if (bank->num_rules >= RIFT_RULEBANK_NO_RULE || !grow_rules(bank)) {
+        set_error(error, RIFT_REGEX_ERROR_MEMORY_ALLOCATION, "Failed to grow rule bank");
+        return false;
+    }
+
+    char *copy = rift_strdup(name);
+    if (!copy) {
+        set_error(error, RIFT_REGEX_ERROR_MEMORY_ALLOCATION, "Failed to copy rule name");
+        return false;
+    }
+    const rift_regex_pattern_t *compiled = compile_shared(bank->cache, pattern, flags, error);
+    if (!compiled) {
+        rift_free(copy);
+        return false;
+    }
+
+    size_t index = bank->num_rules++;
+    bank->names[index] = copy;
+    bank->patterns[index] = compiled;
+    bank->group_counts[index] = rift_regex_pattern_get_group_count(compiled);
+    if (rule) {
+        *rule = (uint32_t)index;
+    }
+    return true;
+}
+
+/**
+ * @brief Get the number of rules of a bank
+ *
+ * @param bank The rule bank
+ * @return Number of rules
+ */
+size_t
+rift_rulebank_get_count(const rift_rulebank_t *bank)
+{
+    return bank ? bank->num_rules : 0;
+}
+
+/**
+ * @brief Find a rule by name
+ *
+ * @param bank The rule bank
+ * @param name Name of the rule
+ * @return Index of the rule, or RIFT_RULEBANK_NO_RULE if the bank has none of that name
+ */
+uint32_t
+rift_rulebank_find(const rift_rulebank_t *bank, const char *name)
+{
+    if (!bank || !name) {
+        return RIFT_RULEBANK_NO_RULE;
+    }
+    for (size_t i = 0; i < bank->num_rules; i++) {
+        if (strcmp(bank->names[i], name) == 0) {
+            return (uint32_t)i;
+        }
+    }
+    return RIFT_RULEBANK_NO_RULE;
+}
+
+/**
+ * @brief Get the name of a rule
+ *
+ * @param bank The rule bank
+ * @param rule Index of the rule
+ * @return The name, or NULL for an invalid index
+ */
+const char *
+rift_rulebank_get_name(const rift_rulebank_t *bank, uint32_t rule)
+{
+    return bank && rule < bank->num_rules ? bank->names[rule] : NULL;
+}
+
+/**
+ * @brief Get the number of capture groups of a rule
+ *
+ * @param bank The rule bank
+ * @param rule Index of the rule
+ * @return Number of capture groups, 0 for an invalid index
+ */
+size_t
+rift_rulebank_get_group_count(const rift_rulebank_t *bank, uint32_t rule)
+{
+    return bank && rule < bank->num_rules ? bank->group_counts[rule] : 0;
+}
+
+/**
+ * @brief Create results sized for the rules of a bank
+ *
+ * @param bank The rule bank
+ * @return New results or NULL on failure
+ */
+rift_rulebank_results_t *
+rift_rulebank_results_create(const rift_rulebank_t *bank)
+{
+    if (!bank) {
+        return NULL;
+    }
+
+    rift_rulebank_results_t *results =
+        (rift_rulebank_results_t *)rift_calloc(1, sizeof(rift_rulebank_results_t));
+    if (!results) {
+        return NULL;
+    }
+    results->num_rules = bank->num_rules;
+    results->first = RIFT_RULEBANK_NO_RULE;
+    results->matched = (bool *)rift_calloc(bank->num_rules + 1, sizeof(bool));
+    results->offsets = (size_t *)rift_calloc(bank->num_rules + 1, sizeof(size_t));
+    if (!results->matched || !results->offsets) {
+        rift_rulebank_results_free(results);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < bank->num_rules; i++) {
+        results->offsets[i + 1] = results->offsets[i] + 1 + bank->group_counts[i];
+    }
+    results->spans = (rift_regex_span_t *)rift_calloc(results->offsets[bank->num_rules] + 1,
+                                                      sizeof(rift_regex_span_t));
+    if (!results->spans) {
+        rift_rulebank_results_free(results);
+        return NULL;
+    }
+    return results;
+}
+
+/**
+ * @brief Free results
+ *
+ * @param results The results (can be NULL)
+ */
+void
+rift_rulebank_results_free(rift_rulebank_results_t *results)
+{
+    if (!results) {
+        return;
+    }
+    rift_free(results->matched);
+    rift_free(results->offsets);
+    rift_free(results->spans);
+    rift_free(results);
+}
+
+/**
+ * @brief Match a line against the rules of a bank
+ *
+ * @param bank The rule bank
+ * @param line The line, which need not be NUL-terminated
+ * @param length Length of the line
+ * @param results Results created for the bank, overwritten
+ * @return Number of rules that matched, 0 if none did or on failure
+ */
+size_t
+rift_rulebank_match(rift_rulebank_t *bank, const char *line, size_t length,
+                    rift_rulebank_results_t *results)
+{
+    if (!results) {
+        return 0;
+    }
+    results->num_matched = 0;
+    results->first = RIFT_RULEBANK_NO_RULE;
+    memset(results->matched, 0, results->num_rules * sizeof(bool));
+    if (!bank || (!line && length > 0) || results->num_rules != bank->num_rules) {
+        return 0;
+    }
+
+    atomic_store_explicit(&bank->sealed, true, memory_order_relaxed);
+    struct rift_rulebank_arena *arena = get_local_arena(bank);
+    if (!arena) {
+        return 0;
+    }
+
+    for (size_t i = 0; i < bank->num_rules; i++) {
+        rift_regex_matcher_t *matcher = arena->matchers[i];
+        size_t max_spans = results->offsets[i + 1] - results->offsets[i];
+        if (!rift_matcher_set_input(matcher, line ? line : "", length) ||
+            !rift_matcher_find_next_spans(matcher, results->spans + results->offsets[i],
+                                          max_spans, NULL)) {
+            continue;
+        }
+
+        results->matched[i] = true;
+        if (results->num_matched++ == 0) {
+            results->first = (uint32_t)i;
+            if (bank->options & RIFT_RULEBANK_OPTION_FIRST_MATCH) {
+                break;
+            }
+        }
+    }
+    return results->num_matched;
+}
+
+/**
+ * @brief Check whether a rule matched the last line
+ *
+ * @param results The results
+ * @param rule Index of the rule
+ * @return true if the rule matched, false otherwise
+ */
+bool
+rift_rulebank_results_matched(const rift_rulebank_results_t *results, uint32_t rule)
+{
+    return results && rule < results->num_rules && results->matched[rule];
+}
+
+/**
+ * @brief Get the first rule that matched the last line
+ *
+ * @param results The results
+ * @return Index of the rule, or RIFT_RULEBANK_NO_RULE if none matched
+ */
+uint32_t
+rift_rulebank_results_first(const rift_rulebank_results_t *results)
+{
+    return results ? results->first : RIFT_RULEBANK_NO_RULE;
+}
+
+/**
+ * @brief Get the span of a rule's match or of one of its capture groups
+ *
+ * @param results The results
+ * @param rule Index of the rule
+ * @param group 0 for the whole match, i for capture group i
+ * @param span Pointer to store the span, offsets into the line
+ * @return true if the rule matched and the group took part, false otherwise
+ */
+bool
+rift_rulebank_results_get_span(const rift_rulebank_results_t *results, uint32_t rule,
+                               size_t group, rift_regex_span_t *span)
+{
+    if (!rift_rulebank_results_matched(results, rule) || !span ||
+        group >= results->offsets[rule + 1] - results->offsets[rule]) {
+        return false;
+    }
+
+    const rift_regex_span_t *found = &results->spans[results->offsets[rule] + group];
+    if (found->start == RIFT_REGEX_SPAN_UNSET) {
+        return false;
+    }
+    *span = *found;
+    return true;
+}
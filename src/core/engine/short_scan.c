@@ -0,0 +1,350 @@
+/**
+ * @file short_scan.c
+ * @brief Implementation of lane-parallel matching of many short inputs
+ *
+ * The search table is the minimized DFA of the pattern behind a state that
+ * loops on every byte, so a match may start anywhere. Its accepting rows are
+ * then made to loop on themselves: once a lane has matched it stays
+ * accepting, and no lane needs checking until its input ends. Lanes whose
+ * input has ended keep their state while the longest input of the group
+ * finishes.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/engine/short_scan.h"
+#include <stdlib.h>
+#include <string.h>
+#include "core/automaton/hopcroft.h"
+#include "core/automaton/lookaround.h"
+#include "core/automaton/state.h"
+#include "core/engine/pattern.h"
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+/* State flags the search table cannot honour, as it only knows the states reached */
+static const rift_state_flag_t SHORT_SCAN_ASSERTING =
+    RIFT_STATE_FLAG_ANCHOR_START | RIFT_STATE_FLAG_ANCHOR_END | RIFT_STATE_FLAG_WORD_BOUNDARY |
+    RIFT_STATE_FLAG_NOT_WORD_BOUNDARY | RIFT_STATE_FLAG_ATOMIC_START | RIFT_STATE_FLAG_ATOMIC_END |
+    RIFT_STATE_FLAG_COUNTER_START | RIFT_STATE_FLAG_COUNTER_STEP;
+
+/**
+ * @brief Build the unanchored search NFA of an automaton
+ *
+ * @param nfa The automaton
+ * @return A copy of the automaton behind a state looping on every byte but NUL, or NULL
+ */
+static rift_regex_automaton_t *
+create_search_nfa(const rift_regex_automaton_t *nfa)
+{
+    rift_regex_automaton_t *search = rift_automaton_clone(nfa);
+    if (!search) {
+        return NULL;
+    }
+
+    rift_regex_state_t *start = rift_automaton_get_initial_state(search);
+    rift_regex_state_t *loop = rift_automaton_create_state(search, false);
+    if (!start || !loop || !rift_automaton_add_transition(search, loop, loop, ".") ||
+        !rift_automaton_create_epsilon_transition(search, loop, start) ||
+        !rift_automaton_set_initial_state(search, loop)) {
+        rift_automaton_free(search);
+        return NULL;
+    }
+    return search;
+}
+
+/**
+ * @brief Compile the search table of an automaton
+ *
+ * @param nfa The automaton
+ * @param error Pointer to store error information (can be NULL)
+ * @return The table with absorbing accepting rows, or NULL if it cannot be built
+ */
+static rift_dfa_table_t *
+compile_search_table(const rift_regex_automaton_t *nfa, rift_regex_error_t *error)
+{
+    if (rift_automaton_has_lookarounds(nfa)) {
+        return NULL;
+    }
+    for (size_t i = 0; i < nfa->num_states; i++) {
+        if (nfa->states[i]->flags & SHORT_SCAN_ASSERTING) {
+            return NULL;
+        }
+    }
+
+    rift_regex_automaton_t *search = create_search_nfa(nfa);
+    rift_regex_automaton_t *dfa = search ? rift_automaton_nfa_to_dfa(search, error) : NULL;
+    rift_regex_automaton_t *minimal = dfa ? rift_hopcroft_minimize(dfa, error) : NULL;
+    rift_dfa_table_t *table = minimal && minimal->num_states < RIFT_SHORT_SCAN_MAX_STATES
+                                  ? rift_dfa_table_compile(minimal, error)
+                                  : NULL;
+    rift_automaton_free(minimal);
+    rift_automaton_free(dfa);
+    rift_automaton_free(search);
+    if (!table) {
+        return NULL;
+    }
+
+    // No DFA edge takes NUL, which would end the search; it only ends the partial matches,
+    // and the search goes on from the start row. Bytes the loop takes never share its class.
+    uint32_t nul = table->byte_class[0];
+    for (uint32_t row = 0; row < table->num_states; row++) {
+        uint32_t *cells = table->next + (size_t)row * table->num_classes;
+        if (rift_dfa_table_is_accepting(table, row)) {
+            for (uint32_t column = 0; column < table->num_classes; column++) {
+                cells[column] = row;
+            }
+        } else if (row != RIFT_DFA_DEAD_STATE) {
+            cells[nul] = table->start_state;
+        }
+    }
+    return table;
+}
+
+/**
+ * @brief Create a scanner searching for the language of an automaton
+ *
+ * @param nfa The automaton, with no backreferences
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new scanner, or NULL if the table cannot be built
+ */
+rift_short_scanner_t *
+rift_short_scanner_create_from_automaton(const rift_regex_automaton_t *nfa,
+                                         rift_regex_error_t *error)
+{
+    if (!nfa) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+        }
+        return NULL;
+    }
+
+    rift_short_scanner_t *scanner = (rift_short_scanner_t *)calloc(1, sizeof(rift_short_scanner_t));
+    if (!scanner) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_MEMORY;
+        }
+        return NULL;
+    }
+
+    scanner->table = compile_search_table(nfa, error);
+    if (!scanner->table) {
+        free(scanner);
+        return NULL;
+    }
+    return scanner;
+}
+
+/**
+ * @brief Create a scanner for a compiled pattern
+ *
+ * The pattern is compiled again without auto-possessification, whose atomic
+ * groups never change whether a match exists but would keep the pattern
+ * from the table.
+ *
+ * @param pattern The compiled pattern
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new scanner or NULL on failure
+ */
+rift_short_scanner_t *
+rift_short_scanner_create(const rift_regex_pattern_t *pattern, rift_regex_error_t *error)
+{
+    if (!pattern) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+        }
+        return NULL;
+    }
+
+    rift_short_scanner_t *scanner = (rift_short_scanner_t *)calloc(1, sizeof(rift_short_scanner_t));
+    if (!scanner) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_MEMORY;
+        }
+        return NULL;
+    }
+
+    const rift_ambiguity_verdict_t *verdict = rift_regex_pattern_get_ambiguity(pattern);
+    const char *source = rift_regex_pattern_get_source(pattern);
+    if (!verdict->has_backreference) {
+        rift_regex_pattern_t *plain =
+            source ? rift_regex_compile(source,
+                                        rift_regex_pattern_get_flags(pattern) |
+                                            RIFT_REGEX_FLAG_NO_AUTO_POSSESS,
+                                        NULL)
+                   : NULL;
+        const rift_regex_automaton_t *automaton =
+            rift_regex_pattern_get_automaton(plain ? plain : pattern);
+        if (automaton) {
+            scanner->table = compile_search_table(automaton, NULL);
+        }
+        rift_regex_pattern_free(plain);
+    }
+
+    if (!scanner->table) {
+        scanner->matcher = rift_matcher_create(pattern, RIFT_MATCHER_OPTION_NONE);
+        if (!scanner->matcher) {
+            free(scanner);
+            if (error) {
+                error->code = RIFT_REGEX_ERROR_MEMORY;
+            }
+            return NULL;
+        }
+    }
+    return scanner;
+}
+
+/**
+ * @brief Free a scanner
+ *
+ * @param scanner The scanner (can be NULL)
+ */
+void
+rift_short_scanner_free(rift_short_scanner_t *scanner)
+{
+    if (!scanner) {
+        return;
+    }
+
+    rift_dfa_table_free(scanner->table);
+    rift_matcher_free(scanner->matcher);
+    free(scanner);
+}
+
+/**
+ * @brief Step a group of lanes through the table until their inputs end
+ *
+ * @param table The search table
+ * @param bytes The lanes' inputs
+ * @param lengths The lanes' input lengths
+ * @param longest Length of the longest input
+ * @param states Final row of each lane
+ */
+static void
+scan_group(const rift_dfa_table_t *table, const unsigned char *const *bytes,
+           const size_t *lengths, size_t longest, uint32_t *states)
+{
+    const uint32_t *next = table->next;
+    const uint8_t *byte_class = table->byte_class;
+    const size_t stride = table->num_classes;
+    size_t lane;
+
+#ifdef __AVX2__
+    // Row offsets fit in 32 bits: RIFT_SHORT_SCAN_MAX_STATES rows of at most 256 columns
+    bool fits = longest <= INT32_MAX;
+    if (fits) {
+        __m256i state = _mm256_set1_epi32((int)table->start_state);
+        __m256i columns = _mm256_set1_epi32((int)stride);
+        __m256i ends = _mm256_setr_epi32((int)lengths[0], (int)lengths[1], (int)lengths[2],
+                                         (int)lengths[3], (int)lengths[4], (int)lengths[5],
+                                         (int)lengths[6], (int)lengths[7]);
+        int32_t classes[RIFT_SHORT_SCAN_LANES];
+        for (size_t position = 0; position < longest; position++) {
+            for (lane = 0; lane < RIFT_SHORT_SCAN_LANES; lane++) {
+                classes[lane] = position < lengths[lane] ? byte_class[bytes[lane][position]] : 0;
+            }
+            __m256i offsets = _mm256_add_epi32(_mm256_mullo_epi32(state, columns),
+                                               _mm256_loadu_si256((const __m256i *)classes));
+            __m256i moved = _mm256_i32gather_epi32((const int *)next, offsets, 4);
+            __m256i running = _mm256_cmpgt_epi32(ends, _mm256_set1_epi32((int)position));
+            state = _mm256_blendv_epi8(state, moved, running);
+        }
+        _mm256_storeu_si256((__m256i *)states, state);
+        return;
+    }
+#endif
+
+    for (lane = 0; lane < RIFT_SHORT_SCAN_LANES; lane++) {
+        states[lane] = table->start_state;
+    }
+    for (size_t position = 0; position < longest; position++) {
+        for (lane = 0; lane < RIFT_SHORT_SCAN_LANES; lane++) {
+            if (position < lengths[lane]) {
+                states[lane] = next[states[lane] * stride + byte_class[bytes[lane][position]]];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Check whether the pattern matches somewhere in each of several inputs
+ *
+ * @param scanner The scanner
+ * @param inputs The inputs (an input can be NULL, which never matches)
+ * @param lengths Lengths of the inputs in bytes, NULL to use strlen
+ * @param count Number of inputs
+ * @param bitmap Array of (count + 63) / 64 words to fill, one bit per input
+ * @return true if successful, false on invalid parameters
+ */
+bool
+rift_short_scanner_match(rift_short_scanner_t *scanner, const char *const *inputs,
+                         const size_t *lengths, size_t count, uint64_t *bitmap)
+{
+    if (!scanner || (count > 0 && (!inputs || !bitmap))) {
+        return false;
+    }
+    memset(bitmap, 0, ((count + 63) / 64) * sizeof(uint64_t));
+
+    if (!scanner->table) {
+        for (size_t i = 0; i < count; i++) {
+            rift_regex_span_t span;
+            size_t length = lengths ? lengths[i] : (size_t)-1;
+            if (inputs[i] && rift_matcher_set_input(scanner->matcher, inputs[i], length) &&
+                rift_matcher_find_next_spans(scanner->matcher, &span, 1, NULL)) {
+                bitmap[i / 64] |= 1ULL << (i % 64);
+            }
+        }
+        return true;
+    }
+
+    // The last group is padded with empty lanes
+    static const unsigned char empty[1] = {0};
+    const unsigned char *bytes[RIFT_SHORT_SCAN_LANES];
+    size_t group_lengths[RIFT_SHORT_SCAN_LANES];
+    uint32_t states[RIFT_SHORT_SCAN_LANES];
+    for (size_t begin = 0; begin < count; begin += RIFT_SHORT_SCAN_LANES) {
+        size_t longest = 0;
+        for (size_t lane = 0; lane < RIFT_SHORT_SCAN_LANES; lane++) {
+            size_t i = begin + lane;
+            const char *input = i < count ? inputs[i] : NULL;
+            bytes[lane] = input ? (const unsigned char *)input : empty;
+            group_lengths[lane] = input ? (lengths ? lengths[i] : strlen(input)) : 0;
+            longest = group_lengths[lane] > longest ? group_lengths[lane] : longest;
+        }
+
+        scan_group(scanner->table, bytes, group_lengths, longest, states);
+        for (size_t lane = 0; lane < RIFT_SHORT_SCAN_LANES && begin + lane < count; lane++) {
+            size_t i = begin + lane;
+            if (inputs[i] && rift_dfa_table_is_accepting(scanner->table, states[lane])) {
+                bitmap[i / 64] |= 1ULL << (i % 64);
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Check whether a pattern matches somewhere in each of several inputs
+ *
+ * @param pattern The compiled pattern
+ * @param inputs The inputs (an input can be NULL, which never matches)
+ * @param lengths Lengths of the inputs in bytes, NULL to use strlen
+ * @param count Number of inputs
+ * @param bitmap Array of (count + 63) / 64 words to fill, one bit per input
+ * @return true if successful, false on invalid parameters or allocation failure
+ */
+bool
+rift_match_many_short(const rift_regex_pattern_t *pattern, const char *const *inputs,
+                      const size_t *lengths, size_t count, uint64_t *bitmap)
+{
+    rift_short_scanner_t *scanner = rift_short_scanner_create(pattern, NULL);
+    if (!scanner) {
+        return false;
+    }
+
+    bool success = rift_short_scanner_match(scanner, inputs, lengths, count, bitmap);
+    rift_short_scanner_free(scanner);
+    return success;
+}
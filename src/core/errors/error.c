@@ -4,6 +4,8 @@
  *
  * This file implements the error handling and reporting facilities for the
  * LibRift library, providing meaningful error messages and status codes.
+ * Each thread has its own current error, and its message is only formatted
+ * when something reads it.
  *
  * @copyright Copyright (c) 2025 LibRift Project
  * @license MIT License
@@ -15,6 +17,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "core/errors/error_args.h"
 
 
 /**
@@ -27,8 +30,11 @@
  * @param ... Additional arguments for formatting
  */
 
-/* Thread-local error information (could be made thread-local using platform-specific methods) */
-static rift_error_info_t current_error = {RIFT_OK, 0, "", ""};
+/* Error information of the calling thread */
+static _Thread_local rift_error_info_t current_error = {RIFT_OK, 0, "", ""};
+
+/* Message of the current error, waiting to be formatted */
+static _Thread_local rift_error_args_t current_args;
 
 /* Error callback function pointer */
 static rift_error_callback_t error_callback = NULL;
@@ -73,16 +79,24 @@ get_error_description(rift_status_t status)
 }
 
 /**
- * @brief Set the current error information
- *
- * @param status Error status code
- * @param line Line number where the error occurred
- * @param file Source file where the error occurred
- * @param message Error message format
- * @param ... Variable arguments for the error message
+ * @brief Format the message of the current error if it is still deferred
  */
-void
-rift_error_set(rift_status_t status, int line, const char *file, const char *message, ...)
+static void
+format_current_message(void)
+{
+    if (rift_error_args_pending(&current_args)) {
+        rift_error_args_format(&current_args, current_error.message,
+                               RIFT_ERROR_MAX_MESSAGE_LENGTH);
+        rift_error_args_clear(&current_args);
+    }
+}
+
+/**
+ * @brief Set the current error from a message format and its argument list
+ */
+static void
+set_current_error(rift_status_t status, int line, const char *file, const char *message,
+                  va_list args)
 {
     /* Update the current error information */
     current_error.status = status;
@@ -92,25 +106,49 @@ rift_error_set(rift_status_t status, int line, const char *file, const char *mes
     strncpy(current_error.file, file ? file : "", RIFT_ERROR_MAX_FILE_LENGTH - 1);
     current_error.file[RIFT_ERROR_MAX_FILE_LENGTH - 1] = '\0';
 
-    /* Format the error message with the variable arguments */
-    va_list args;
-    va_start(args, message);
-    vsnprintf(current_error.message, RIFT_ERROR_MAX_MESSAGE_LENGTH, message ? message : "", args);
-    va_end(args);
-
-    /* If no specific message was provided, use the default description */
+    /* Record the message; it is formatted when read, or now if it cannot be recorded */
     if (!message || message[0] == '\0') {
+        /* If no specific message was provided, use the default description */
+        rift_error_args_clear(&current_args);
         strncpy(current_error.message, get_error_description(status),
                 RIFT_ERROR_MAX_MESSAGE_LENGTH - 1);
         current_error.message[RIFT_ERROR_MAX_MESSAGE_LENGTH - 1] = '\0';
+    } else {
+        va_list copy;
+        va_copy(copy, args);
+        if (rift_error_args_capture(&current_args, message, copy)) {
+            current_error.message[0] = '\0';
+        } else {
+            vsnprintf(current_error.message, RIFT_ERROR_MAX_MESSAGE_LENGTH, message, args);
+        }
+        va_end(copy);
     }
 
     /* Call the error callback if registered */
     if (error_callback) {
+        format_current_message();
         error_callback(&current_error);
     }
 }
 
+/**
+ * @brief Set the current error information
+ *
+ * @param status Error status code
+ * @param line Line number where the error occurred
+ * @param file Source file where the error occurred
+ * @param message Error message format
+ * @param ... Variable arguments for the error message
+ */
+void
+rift_error_set(rift_status_t status, int line, const char *file, const char *message, ...)
+{
+    va_list args;
+    va_start(args, message);
+    set_current_error(status, line, file, message, args);
+    va_end(args);
+}
+
 /**
  * @brief Get the current error information
  *
@@ -119,6 +157,7 @@ rift_error_set(rift_status_t status, int line, const char *file, const char *mes
 const rift_error_info_t *
 rift_error_get(void)
 {
+    format_current_message();
     return &current_error;
 }
 
@@ -132,6 +171,7 @@ rift_error_clear(void)
     current_error.line = 0;
     current_error.file[0] = '\0';
     current_error.message[0] = '\0';
+    rift_error_args_clear(&current_args);
 }
 
 /**
@@ -209,7 +249,7 @@ rift_error_is_error(rift_status_t status)
 rift_status_t
 rift_error_current_format(char *buffer, size_t buffer_size)
 {
-    return rift_error_format(&current_error, buffer, buffer_size);
+    return rift_error_format(rift_error_get(), buffer, buffer_size);
 }
 
 /**
@@ -225,15 +265,11 @@ rift_error_current_format(char *buffer, size_t buffer_size)
 rift_status_t
 rift_error_log(rift_status_t status, int line, const char *file, const char *message, ...)
 {
-    /* Format the error message with the variable arguments */
-    char formatted_message[RIFT_ERROR_MAX_MESSAGE_LENGTH];
+    /* Set the error information */
     va_list args;
     va_start(args, message);
-    vsnprintf(formatted_message, sizeof(formatted_message), message ? message : "", args);
+    set_current_error(status, line, file, message, args);
     va_end(args);
 
-    /* Set the error information */
-    rift_error_set(status, line, file, "%s", formatted_message);
-
     return status;
 }
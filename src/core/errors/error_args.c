@@ -0,0 +1,341 @@
+/**
+ * @file error_args.c
+ * @brief Implementation of the deferred formatting of error messages
+ *
+ * This file records a message's arguments by walking its format string once
+ * and reading each argument with the type its conversion names, then formats
+ * the message later by walking the format again and handing each conversion
+ * and its recorded argument to snprintf.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/errors/error_args.h"
+#include <stdio.h>
+#include <string.h>
+
+/* Longest conversion specification copied out of a format, with its '%' */
+#define ERROR_ARGS_MAX_SPEC_LENGTH 24
+
+/**
+ * @brief Length modifiers of a conversion
+ */
+typedef enum error_args_length {
+    ERROR_ARGS_LENGTH_NONE,
+    ERROR_ARGS_LENGTH_CHAR,
+    ERROR_ARGS_LENGTH_SHORT,
+    ERROR_ARGS_LENGTH_LONG,
+    ERROR_ARGS_LENGTH_LONG_LONG,
+    ERROR_ARGS_LENGTH_SIZE,
+    ERROR_ARGS_LENGTH_INTMAX,
+    ERROR_ARGS_LENGTH_PTRDIFF,
+    ERROR_ARGS_LENGTH_LONG_DOUBLE
+} error_args_length_t;
+
+/**
+ * @brief Parse the conversion specification starting at a '%'
+ *
+ * @param spec Pointer to the '%'
+ * @param end Pointer to store the position just past the specification
+ * @param type Pointer to store the type of the argument it takes
+ * @return 1 if it takes an argument, 0 for "%%", -1 if it cannot be recorded
+ */
+static int
+parse_spec(const char *spec, const char **end, rift_error_arg_type_t *type)
+{
+    const char *p = spec + 1;
+    if (*p == '%') {
+        *end = p + 1;
+        return 0;
+    }
+
+    while (*p && strchr("-+ #0", *p)) {
+        p++;
+    }
+    while (*p >= '0' && *p <= '9') {
+        p++;
+    }
+    if (*p == '.') {
+        p++;
+        while (*p >= '0' && *p <= '9') {
+            p++;
+        }
+    }
+
+    error_args_length_t length = ERROR_ARGS_LENGTH_NONE;
+    switch (*p) {
+    case 'h':
+        length = p[1] == 'h' ? ERROR_ARGS_LENGTH_CHAR : ERROR_ARGS_LENGTH_SHORT;
+        p += p[1] == 'h' ? 2 : 1;
+        break;
+    case 'l':
+        length = p[1] == 'l' ? ERROR_ARGS_LENGTH_LONG_LONG : ERROR_ARGS_LENGTH_LONG;
+        p += p[1] == 'l' ? 2 : 1;
+        break;
+    case 'z':
+        length = ERROR_ARGS_LENGTH_SIZE;
+        p++;
+        break;
+    case 'j':
+        length = ERROR_ARGS_LENGTH_INTMAX;
+        p++;
+        break;
+    case 't':
+        length = ERROR_ARGS_LENGTH_PTRDIFF;
+        p++;
+        break;
+    case 'L':
+        length = ERROR_ARGS_LENGTH_LONG_DOUBLE;
+        p++;
+        break;
+    default:
+        break;
+    }
+
+    if (p + 1 - spec >= ERROR_ARGS_MAX_SPEC_LENGTH) {
+        return -1;
+    }
+    *end = p + 1;
+
+    switch (*p) {
+    case 'd':
+    case 'i':
+    case 'o':
+    case 'u':
+    case 'x':
+    case 'X':
+        switch (length) {
+        case ERROR_ARGS_LENGTH_LONG:
+            *type = RIFT_ERROR_ARG_LONG;
+            return 1;
+        case ERROR_ARGS_LENGTH_LONG_LONG:
+            *type = RIFT_ERROR_ARG_LONG_LONG;
+            return 1;
+        case ERROR_ARGS_LENGTH_SIZE:
+            *type = RIFT_ERROR_ARG_SIZE;
+            return 1;
+        case ERROR_ARGS_LENGTH_INTMAX:
+            *type = RIFT_ERROR_ARG_INTMAX;
+            return 1;
+        case ERROR_ARGS_LENGTH_PTRDIFF:
+            *type = RIFT_ERROR_ARG_PTRDIFF;
+            return 1;
+        case ERROR_ARGS_LENGTH_LONG_DOUBLE:
+            return -1;
+        default:
+            *type = RIFT_ERROR_ARG_INT;
+            return 1;
+        }
+    case 'c':
+        *type = RIFT_ERROR_ARG_INT;
+        return length == ERROR_ARGS_LENGTH_NONE ? 1 : -1;
+    case 'e':
+    case 'E':
+    case 'f':
+    case 'F':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+        *type = RIFT_ERROR_ARG_DOUBLE;
+        return length == ERROR_ARGS_LENGTH_NONE || length == ERROR_ARGS_LENGTH_LONG ? 1 : -1;
+    case 's':
+        *type = RIFT_ERROR_ARG_STRING;
+        return length == ERROR_ARGS_LENGTH_NONE ? 1 : -1;
+    case 'p':
+        *type = RIFT_ERROR_ARG_POINTER;
+        return length == ERROR_ARGS_LENGTH_NONE ? 1 : -1;
+    default:
+        // %n, '*' widths, wide characters and anything unknown
+        return -1;
+    }
+}
+
+/**
+ * @brief Record a format string and its arguments without formatting them
+ *
+ * @param record The record
+ * @param format Format string
+ * @param args Arguments for the format string
+ * @return true if recorded, false if the message must be formatted now
+ */
+bool
+rift_error_args_capture(rift_error_args_t *record, const char *format, va_list args)
+{
+    if (!record) {
+        return false;
+    }
+
+    rift_error_args_clear(record);
+    if (!format) {
+        return false;
+    }
+
+    for (const char *p = strchr(format, '%'); p; p = strchr(p, '%')) {
+        rift_error_arg_type_t type = RIFT_ERROR_ARG_INT;
+        int takes = parse_spec(p, &p, &type);
+        if (takes < 0 || (takes > 0 && record->count == RIFT_ERROR_ARGS_MAX)) {
+            rift_error_args_clear(record);
+            return false;
+        }
+        if (takes == 0) {
+            continue;
+        }
+
+        rift_error_arg_t *arg = &record->args[record->count++];
+        arg->type = type;
+        switch (type) {
+        case RIFT_ERROR_ARG_LONG:
+            arg->value.l = va_arg(args, long);
+            break;
+        case RIFT_ERROR_ARG_LONG_LONG:
+            arg->value.ll = va_arg(args, long long);
+            break;
+        case RIFT_ERROR_ARG_SIZE:
+            arg->value.z = va_arg(args, size_t);
+            break;
+        case RIFT_ERROR_ARG_INTMAX:
+            arg->value.j = va_arg(args, intmax_t);
+            break;
+        case RIFT_ERROR_ARG_PTRDIFF:
+            arg->value.t = va_arg(args, ptrdiff_t);
+            break;
+        case RIFT_ERROR_ARG_DOUBLE:
+            arg->value.d = va_arg(args, double);
+            break;
+        case RIFT_ERROR_ARG_POINTER:
+            arg->value.p = va_arg(args, void *);
+            break;
+        case RIFT_ERROR_ARG_STRING: {
+            const char *string = va_arg(args, const char *);
+            size_t length = strlen(string ? string : "(null)");
+            if (length >= sizeof(record->text) - record->text_used) {
+                rift_error_args_clear(record);
+                return false;
+            }
+            arg->value.text = record->text_used;
+            memcpy(record->text + record->text_used, string ? string : "(null)", length + 1);
+            record->text_used += (uint8_t)(length + 1);
+            break;
+        }
+        default:
+            arg->value.i = va_arg(args, int);
+            break;
+        }
+    }
+
+    record->format = format;
+    return true;
+}
+
+/**
+ * @brief Format one recorded argument with its conversion specification
+ */
+static int
+format_arg(char *buffer, size_t size, const char *spec, const rift_error_args_t *record,
+           const rift_error_arg_t *arg)
+{
+    switch (arg->type) {
+    case RIFT_ERROR_ARG_LONG:
+        return snprintf(buffer, size, spec, arg->value.l);
+    case RIFT_ERROR_ARG_LONG_LONG:
+        return snprintf(buffer, size, spec, arg->value.ll);
+    case RIFT_ERROR_ARG_SIZE:
+        return snprintf(buffer, size, spec, arg->value.z);
+    case RIFT_ERROR_ARG_INTMAX:
+        return snprintf(buffer, size, spec, arg->value.j);
+    case RIFT_ERROR_ARG_PTRDIFF:
+        return snprintf(buffer, size, spec, arg->value.t);
+    case RIFT_ERROR_ARG_DOUBLE:
+        return snprintf(buffer, size, spec, arg->value.d);
+    case RIFT_ERROR_ARG_POINTER:
+        return snprintf(buffer, size, spec, arg->value.p);
+    case RIFT_ERROR_ARG_STRING:
+        return snprintf(buffer, size, spec, record->text + arg->value.text);
+    default:
+        return snprintf(buffer, size, spec, arg->value.i);
+    }
+}
+
+/**
+ * @brief Format a recorded message
+ *
+ * @param record The record
+ * @param buffer Buffer to store the message
+ * @param buffer_size Size of the buffer
+ * @return true if a message was pending and written
+ */
+bool
+rift_error_args_format(const rift_error_args_t *record, char *buffer, size_t buffer_size)
+{
+    if (!rift_error_args_pending(record) || !buffer || buffer_size == 0) {
+        return false;
+    }
+
+    size_t used = 0;
+    size_t next = 0;
+    const char *p = record->format;
+    while (*p && used + 1 < buffer_size) {
+        const char *percent = strchr(p, '%');
+        size_t literal = percent ? (size_t)(percent - p) : strlen(p);
+        if (literal > buffer_size - 1 - used) {
+            literal = buffer_size - 1 - used;
+        }
+        memcpy(buffer + used, p, literal);
+        used += literal;
+        if (!percent) {
+            break;
+        }
+
+        rift_error_arg_type_t type;
+        const char *end = percent;
+        int takes = parse_spec(percent, &end, &type);
+        if (takes == 0) {
+            if (used + 1 < buffer_size) {
+                buffer[used++] = '%';
+            }
+        } else if (takes > 0 && next < record->count) {
+            char spec[ERROR_ARGS_MAX_SPEC_LENGTH];
+            memcpy(spec, percent, (size_t)(end - percent));
+            spec[end - percent] = '\0';
+            int written = format_arg(buffer + used, buffer_size - used, spec, record,
+                                     &record->args[next++]);
+            if (written > 0) {
+                used += (size_t)written < buffer_size - used ? (size_t)written
+                                                             : buffer_size - 1 - used;
+            }
+        }
+        p = end;
+    }
+
+    buffer[used] = '\0';
+    return true;
+}
+
+/**
+ * @brief Check whether a record holds a message waiting to be formatted
+ *
+ * @param record The record
+ * @return true if a message is pending
+ */
+bool
+rift_error_args_pending(const rift_error_args_t *record)
+{
+    return record && record->format != NULL;
+}
+
+/**
+ * @brief Drop any message waiting in a record
+ *
+ * @param record The record
+ */
+void
+rift_error_args_clear(rift_error_args_t *record)
+{
+    if (record) {
+        record->format = NULL;
+        record->count = 0;
+        record->text_used = 0;
+    }
+}
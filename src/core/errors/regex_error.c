@@ -3,7 +3,8 @@
  * @brief Implementation of error handling for the LibRift regex engine
  *
  * This file implements the functions declared in regex_error.h for error
- * handling in the LibRift regex engine.
+ * handling in the LibRift regex engine. A formatted error keeps its format
+ * and arguments in the error's deferred record until the message is read.
  *
  * @copyright Copyright (c) 2025 LibRift Project
  * @license MIT License
@@ -33,6 +34,7 @@ rift_regex_error_init(rift_regex_error_t *error)
     error->code = RIFT_REGEX_ERROR_NONE;
     error->message[0] = '\0';
     error->position = 0;
+    rift_error_args_clear(&error->deferred);
 
     return true;
 }
@@ -103,12 +105,17 @@ rift_regex_error_code_to_string(rift_regex_error_code_t error_code)
 const char *
 rift_regex_get_error_string(rift_regex_error_t error)
 {
+    // The error is a copy, so its message is kept per thread rather than returned from it
+    static _Thread_local char message[RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH];
+
     if (error.code == RIFT_REGEX_ERROR_NONE) {
         return "No error";
     }
 
-    if (error.message[0] != '\0') {
-        return error.message;
+    const char *text = rift_regex_error_message(&error);
+    if (text[0] != '\0') {
+        memcpy(message, text, sizeof(message));
+        return message;
     }
 
     return rift_regex_error_code_to_string(error.code);
@@ -141,6 +148,7 @@ rift_regex_error_set_with_message(rift_regex_error_t *error, int code, const cha
     }
 
     error->position = 0;
+    rift_error_args_clear(&error->deferred);
 }
 
 /**
@@ -162,11 +170,20 @@ rift_regex_error_set_formatted(rift_regex_error_t *error, rift_regex_error_code_
     error->code = code;
 
     if (format) {
+        // Record the arguments now and format them when the message is read
         va_list args;
+        va_list copy;
         va_start(args, format);
-        vsnprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH, format, args);
+        va_copy(copy, args);
+        if (rift_error_args_capture(&error->deferred, format, copy)) {
+            error->message[0] = '\0';
+        } else {
+            vsnprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH, format, args);
+        }
+        va_end(copy);
         va_end(args);
     } else {
+        rift_error_args_clear(&error->deferred);
         const char *default_message = rift_regex_error_code_to_string(code);
         strncpy(error->message, default_message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH - 1);
         error->message[RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH - 1] = '\0';
@@ -190,6 +207,7 @@ rift_regex_error_clear(rift_regex_error_t *error)
     error->code = RIFT_REGEX_ERROR_NONE;
     error->message[0] = '\0';
     error->position = 0;
+    rift_error_args_clear(&error->deferred);
 }
 
 /**
@@ -219,6 +237,7 @@ rift_regex_error_create(rift_regex_error_code_t code, const char *message)
     }
 
     error->position = 0;
+    rift_error_args_clear(&error->deferred);
 
     return error;
 }
@@ -236,6 +255,30 @@ rift_regex_error_free(rift_regex_error_t *error)
     }
 }
 
+/**
+ * @brief Get the message of an error, formatting it first if it is deferred
+ *
+ * A message written into the buffer directly takes precedence over a
+ * deferred one, so code that fills the buffer itself keeps working.
+ *
+ * @param error Pointer to the error object
+ * @return The message, or an empty string if there is none
+ */
+const char *
+rift_regex_error_message(rift_regex_error_t *error)
+{
+    if (!error) {
+        return "";
+    }
+
+    if (error->message[0] == '\0' && rift_error_args_pending(&error->deferred)) {
+        rift_error_args_format(&error->deferred, error->message, sizeof(error->message));
+    }
+    rift_error_args_clear(&error->deferred);
+
+    return error->message;
+}
+
 /**
  * @brief Format an error object to a string
  *
@@ -251,11 +294,19 @@ rift_regex_error_format(const rift_regex_error_t *error, char *buffer, size_t bu
         return false;
     }
 
+    // A deferred message is formatted here, without touching the error
+    char deferred[RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH];
+    const char *message = error->message;
+    if (message[0] == '\0' &&
+        rift_error_args_format(&error->deferred, deferred, sizeof(deferred))) {
+        message = deferred;
+    }
+
     if (error->position > 0) {
         snprintf(buffer, buffer_size, "Error %d at position %zu: %s", (int)error->code,
-                 error->position, error->message);
+                 error->position, message);
     } else {
-        snprintf(buffer, buffer_size, "Error %d: %s", (int)error->code, error->message);
+        snprintf(buffer, buffer_size, "Error %d: %s", (int)error->code, message);
     }
 
     return true;
@@ -290,6 +341,7 @@ rift_regex_error_copy(rift_regex_error_t *dest, const rift_regex_error_t *src)
     dest->code = src->code;
     strncpy(dest->message, src->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH);
     dest->position = src->position;
+    dest->deferred = src->deferred;
 
     return true;
 }
@@ -109,8 +109,12 @@ rift_regex_error_to_core_error(const rift_regex_error_t *regex_error, rift_error
 
     if (core_error) {
         core_error->status = status;
-        strncpy(core_error->message, regex_error->message, RIFT_ERROR_MAX_MESSAGE_LENGTH - 1);
-        core_error->message[RIFT_ERROR_MAX_MESSAGE_LENGTH - 1] = '\0';
+        if (regex_error->message[0] != '\0' ||
+            !rift_error_args_format(&regex_error->deferred, core_error->message,
+                                    RIFT_ERROR_MAX_MESSAGE_LENGTH)) {
+            strncpy(core_error->message, regex_error->message, RIFT_ERROR_MAX_MESSAGE_LENGTH - 1);
+            core_error->message[RIFT_ERROR_MAX_MESSAGE_LENGTH - 1] = '\0';
+        }
         // Other fields would typically be filled by the calling function
     }
 
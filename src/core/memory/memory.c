@@ -9,17 +9,95 @@
  * @license MIT License
  */
 
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
 #include "core/memory/memory.h"
+#include <pthread.h>
+#include <stdatomic.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "core/config/config.h"
+#include "core/runtime/probes.h"
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Size the stats shards are padded to, so threads do not share lines
+ */
+#define RIFT_MEMORY_CACHE_LINE 64
+
+/**
+ * @brief Profiling counters of one tag in a stats shard
+ */
+typedef struct memory_tag_counters {
+    atomic_size_t bytes_allocated; /**< Bytes allocated */
+    atomic_size_t bytes_freed;     /**< Bytes freed */
+    atomic_size_t allocs;          /**< Allocations */
+    atomic_size_t frees;           /**< Frees */
+} memory_tag_counters_t;
+
+/**
+ * @brief Counters of the threads that use a stats shard
+ *
+ * Bytes and counts only ever grow, so a shard can be summed without
+ * knowing which thread freed what another allocated.
+ */
+typedef struct memory_stats_shard {
+    _Alignas(RIFT_MEMORY_CACHE_LINE) atomic_size_t bytes_allocated; /**< Bytes allocated */
+    atomic_size_t bytes_freed;                                       /**< Bytes freed */
+    atomic_size_t allocs;                                            /**< Allocations */
+    atomic_size_t frees;                                             /**< Frees */
+    atomic_size_t checkpoint; /**< Net usage of the shard when the peak was last updated */
+    memory_tag_counters_t tags[RIFT_MEMORY_TAG_COUNT]; /**< Counters kept while profiling */
+} memory_stats_shard_t;
+
+/* Memory tracking statistics, sharded by thread and summed on read */
+static memory_stats_shard_t memory_stats_shards[RIFT_MEMORY_STATS_SHARDS];
 
-/* Memory tracking statistics */
-static rift_memory_stats_t memory_stats = {0};
+/* Peak of the summed usage, refreshed as shards grow by a granule */
+static atomic_size_t memory_peak_usage = 0;
 
+#if RIFT_MEMORY_TRACKING
 /* Memory tracking enabled flag */
-static bool memory_tracking_enabled = false;
+static atomic_bool memory_tracking_enabled = false;
+
+/* Allocation profiling by tag enabled flag */
+static atomic_bool memory_profiling_enabled = false;
+
+/* Shard of the calling thread, assigned on its first tracked allocation */
+static _Thread_local size_t memory_stats_shard = SIZE_MAX;
+static atomic_size_t next_memory_stats_shard = 0;
+#endif
+
+/**
+ * @brief Allocator settings cached from the configuration
+ *
+ * Reloaded when the configuration generation moves past the one loaded.
+ */
+static _Atomic(rift_malloc_func_t) cached_malloc = NULL;
+static _Atomic(rift_realloc_func_t) cached_realloc = NULL;
+static _Atomic(rift_free_func_t) cached_free = NULL;
+static atomic_size_t cached_allocation_limit = 0;
+static atomic_size_t cached_table_page_threshold = 0;
+static atomic_bool cached_table_huge_pages = false;
+static atomic_uint cached_generation = 0;
+static atomic_uint config_generation = 1;
+
+/* Allocator in use on the calling thread, NULL for the configured one */
+static _Thread_local const rift_allocator_t *thread_allocator = NULL;
+
+/* Tag the calling thread's allocations count under while profiling */
+static _Thread_local uint8_t memory_tag = RIFT_MEMORY_TAG_OTHER;
+
+/* Names of the tags in the profile report */
+static const char *const memory_tag_names[RIFT_MEMORY_TAG_COUNT] = {
+    "other", "tokenizer", "parser", "automaton", "dfa", "vm", "backtracker", "results"};
 
 /**
  * @brief Enable memory usage tracking
@@ -30,9 +108,12 @@ static bool memory_tracking_enabled = false;
 bool
 rift_memory_tracking_enable(bool enabled)
 {
-    bool previous = memory_tracking_enabled;
-    memory_tracking_enabled = enabled;
-    return previous;
+#if RIFT_MEMORY_TRACKING
+    return atomic_exchange(&memory_tracking_enabled, enabled);
+#else
+    (void)enabled;
+    return false;
+#endif
 }
 
 /**
@@ -41,7 +122,67 @@ rift_memory_tracking_enable(bool enabled)
 void
 rift_memory_tracking_reset(void)
 {
-    memset(&memory_stats, 0, sizeof(rift_memory_stats_t));
+    for (size_t i = 0; i < RIFT_MEMORY_STATS_SHARDS; i++) {
+        memory_stats_shard_t *shard = &memory_stats_shards[i];
+        atomic_store_explicit(&shard->bytes_allocated, 0, memory_order_relaxed);
+        atomic_store_explicit(&shard->bytes_freed, 0, memory_order_relaxed);
+        atomic_store_explicit(&shard->allocs, 0, memory_order_relaxed);
+        atomic_store_explicit(&shard->frees, 0, memory_order_relaxed);
+        atomic_store_explicit(&shard->checkpoint, 0, memory_order_relaxed);
+        for (size_t tag = 0; tag < RIFT_MEMORY_TAG_COUNT; tag++) {
+            memory_tag_counters_t *counters = &shard->tags[tag];
+            atomic_store_explicit(&counters->bytes_allocated, 0, memory_order_relaxed);
+            atomic_store_explicit(&counters->bytes_freed, 0, memory_order_relaxed);
+            atomic_store_explicit(&counters->allocs, 0, memory_order_relaxed);
+            atomic_store_explicit(&counters->frees, 0, memory_order_relaxed);
+        }
+    }
+    atomic_store(&memory_peak_usage, 0);
+}
+
+/**
+ * @brief Raise the recorded peak to a usage
+ *
+ * @param usage The usage
+ */
+static void
+memory_peak_raise(size_t usage)
+{
+    size_t peak = atomic_load(&memory_peak_usage);
+    while (usage > peak && !atomic_compare_exchange_weak(&memory_peak_usage, &peak, usage)) {
+    }
+}
+
+/**
+ * @brief Sum the stats shards
+ *
+ * @param stats Pointer to store the sums
+ */
+static void
+memory_stats_sum(rift_memory_stats_t *stats)
+{
+    size_t bytes_allocated = 0;
+    size_t bytes_freed = 0;
+    size_t allocs = 0;
+    size_t frees = 0;
+
+    for (size_t i = 0; i < RIFT_MEMORY_STATS_SHARDS; i++) {
+        memory_stats_shard_t *shard = &memory_stats_shards[i];
+        bytes_allocated += atomic_load_explicit(&shard->bytes_allocated, memory_order_relaxed);
+        bytes_freed += atomic_load_explicit(&shard->bytes_freed, memory_order_relaxed);
+        allocs += atomic_load_explicit(&shard->allocs, memory_order_relaxed);
+        frees += atomic_load_explicit(&shard->frees, memory_order_relaxed);
+    }
+
+    // Shards read while other threads allocate may see a free before its allocation
+    stats->current_usage = bytes_allocated > bytes_freed ? bytes_allocated - bytes_freed : 0;
+    stats->total_allocs = allocs;
+    stats->total_frees = frees;
+    stats->active_allocs = allocs > frees ? allocs - frees : 0;
+
+    // Every sum is a chance to see a high the shard checkpoints missed
+    memory_peak_raise(stats->current_usage);
+    stats->peak_usage = atomic_load(&memory_peak_usage);
 }
 
 /**
@@ -57,6 +198,9 @@ void
 rift_memory_get_stats(size_t *current_usage, size_t *peak_usage, size_t *total_allocs,
                       size_t *total_frees, size_t *active_allocs)
 {
+    rift_memory_stats_t memory_stats;
+    memory_stats_sum(&memory_stats);
+
     if (current_usage)
         *current_usage = memory_stats.current_usage;
     if (peak_usage)
@@ -105,6 +249,97 @@ standard_free(void *ptr)
     free(ptr);
 }
 
+/**
+ * @brief Invalidate the allocator settings cached from the configuration
+ */
+void
+rift_memory_config_changed(void)
+{
+    atomic_fetch_add(&config_generation, 1);
+}
+
+/**
+ * @brief Make sure the cached allocator settings match the configuration
+ *
+ * The common case is two loads; the configuration is only read again
+ * after rift_memory_config_changed.
+ */
+static inline void
+allocator_cache_refresh(void)
+{
+    unsigned generation = atomic_load_explicit(&config_generation, memory_order_acquire);
+    if (atomic_load_explicit(&cached_generation, memory_order_acquire) == generation) {
+        return;
+    }
+
+    const rift_config_t *config = rift_config_acquire();
+    bool custom = config->memory.use_custom_allocator;
+    atomic_store_explicit(&cached_malloc,
+                          custom && config->memory.custom_malloc ? config->memory.custom_malloc
+                                                                 : standard_malloc,
+                          memory_order_relaxed);
+    atomic_store_explicit(&cached_realloc,
+                          custom && config->memory.custom_realloc ? config->memory.custom_realloc
+                                                                  : standard_realloc,
+                          memory_order_relaxed);
+    atomic_store_explicit(&cached_free,
+                          custom && config->memory.custom_free ? config->memory.custom_free
+                                                               : standard_free,
+                          memory_order_relaxed);
+    atomic_store_explicit(&cached_allocation_limit, config->memory.allocation_limit,
+                          memory_order_relaxed);
+    atomic_store_explicit(&cached_table_page_threshold, config->memory.table_page_threshold,
+                          memory_order_relaxed);
+    atomic_store_explicit(&cached_table_huge_pages, config->memory.table_huge_pages,
+                          memory_order_relaxed);
+    rift_config_release(config);
+
+    // A change made while the settings were read moved the generation on,
+    // so the next call reads them again
+    atomic_store_explicit(&cached_generation, generation, memory_order_release);
+}
+
+#if RIFT_MEMORY_TRACKING
+/**
+ * @brief Get the stats shard of the calling thread
+ *
+ * @return The shard
+ */
+static inline memory_stats_shard_t *
+memory_stats_shard_get(void)
+{
+    if (memory_stats_shard == SIZE_MAX) {
+        memory_stats_shard =
+            atomic_fetch_add_explicit(&next_memory_stats_shard, 1, memory_order_relaxed) %
+            RIFT_MEMORY_STATS_SHARDS;
+    }
+    return &memory_stats_shards[memory_stats_shard];
+}
+
+/**
+ * @brief Refresh the peak once a shard has grown by a granule
+ *
+ * @param shard The shard of the calling thread
+ */
+static void
+memory_stats_checkpoint(memory_stats_shard_t *shard)
+{
+    // Net usage of the shard, negative when its threads free what others allocated
+    intptr_t net =
+        (intptr_t)(atomic_load_explicit(&shard->bytes_allocated, memory_order_relaxed) -
+                   atomic_load_explicit(&shard->bytes_freed, memory_order_relaxed));
+    intptr_t checkpoint = (intptr_t)atomic_load_explicit(&shard->checkpoint, memory_order_relaxed);
+
+    if (net > checkpoint + RIFT_MEMORY_PEAK_GRANULE) {
+        rift_memory_stats_t memory_stats;
+        memory_stats_sum(&memory_stats);
+        atomic_store_explicit(&shard->checkpoint, (size_t)net, memory_order_relaxed);
+    } else if (net < checkpoint - RIFT_MEMORY_PEAK_GRANULE) {
+        // Lowered as the shard shrinks, so growing back is noticed again
+        atomic_store_explicit(&shard->checkpoint, (size_t)net, memory_order_relaxed);
+    }
+}
+
 /**
  * @brief Update memory tracking statistics for allocation
  *
@@ -113,16 +348,14 @@ standard_free(void *ptr)
 static void
 update_stats_alloc(size_t size)
 {
-    if (!memory_tracking_enabled) {
+    if (!atomic_load_explicit(&memory_tracking_enabled, memory_order_relaxed)) {
         return;
     }
 
-    memory_stats.current_usage += size;
-    if (memory_stats.current_usage > memory_stats.peak_usage) {
-        memory_stats.peak_usage = memory_stats.current_usage;
-    }
-    memory_stats.total_allocs++;
-    memory_stats.active_allocs++;
+    memory_stats_shard_t *shard = memory_stats_shard_get();
+    atomic_fetch_add_explicit(&shard->bytes_allocated, size, memory_order_relaxed);
+    atomic_fetch_add_explicit(&shard->allocs, 1, memory_order_relaxed);
+    memory_stats_checkpoint(shard);
 }
 
 /**
@@ -133,13 +366,88 @@ update_stats_alloc(size_t size)
 static void
 update_stats_free(size_t size)
 {
-    if (!memory_tracking_enabled) {
+    if (!atomic_load_explicit(&memory_tracking_enabled, memory_order_relaxed)) {
+        return;
+    }
+
+    memory_stats_shard_t *shard = memory_stats_shard_get();
+    atomic_fetch_add_explicit(&shard->bytes_freed, size, memory_order_relaxed);
+    atomic_fetch_add_explicit(&shard->frees, 1, memory_order_relaxed);
+    memory_stats_checkpoint(shard);
+}
+
+/**
+ * @brief Update memory tracking statistics for a resize
+ *
+ * @param old_size Size before the resize in bytes
+ * @param size Size after the resize in bytes
+ */
+static void
+update_stats_resize(size_t old_size, size_t size)
+{
+    if (!atomic_load_explicit(&memory_tracking_enabled, memory_order_relaxed)) {
+        return;
+    }
+
+    memory_stats_shard_t *shard = memory_stats_shard_get();
+    atomic_fetch_add_explicit(&shard->bytes_allocated, size, memory_order_relaxed);
+    atomic_fetch_add_explicit(&shard->bytes_freed, old_size, memory_order_relaxed);
+    memory_stats_checkpoint(shard);
+}
+
+/**
+ * @brief Update the profiling counters of a tag
+ *
+ * @param tag Tag of the block
+ * @param allocated Bytes the block grew by
+ * @param freed Bytes the block gave back
+ * @param allocs 1 for a new block, 0 otherwise
+ * @param frees 1 for a freed block, 0 otherwise
+ */
+static void
+update_tag_stats(uint8_t tag, size_t allocated, size_t freed, size_t allocs, size_t frees)
+{
+    if (!atomic_load_explicit(&memory_profiling_enabled, memory_order_relaxed)) {
         return;
     }
 
-    memory_stats.current_usage -= size;
-    memory_stats.total_frees++;
-    memory_stats.active_allocs--;
+    memory_tag_counters_t *counters = &memory_stats_shard_get()->tags[tag];
+    if (allocated) {
+        atomic_fetch_add_explicit(&counters->bytes_allocated, allocated, memory_order_relaxed);
+    }
+    if (freed) {
+        atomic_fetch_add_explicit(&counters->bytes_freed, freed, memory_order_relaxed);
+    }
+    if (allocs) {
+        atomic_fetch_add_explicit(&counters->allocs, allocs, memory_order_relaxed);
+    }
+    if (frees) {
+        atomic_fetch_add_explicit(&counters->frees, frees, memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Check an allocation against the allocation limit
+ *
+ * Summing the shards costs a pass over them, so it is only done when a
+ * limit is set. Usage is only known while tracking is enabled.
+ *
+ * @param freed Bytes the allocation gives back
+ * @param size Bytes the allocation takes
+ * @return true if the allocation fits, false otherwise
+ */
+static bool
+within_allocation_limit(size_t freed, size_t size)
+{
+    size_t limit = atomic_load_explicit(&cached_allocation_limit, memory_order_relaxed);
+    if (limit == 0) {
+        return true;
+    }
+
+    rift_memory_stats_t memory_stats;
+    memory_stats_sum(&memory_stats);
+    size_t usage = memory_stats.current_usage > freed ? memory_stats.current_usage - freed : 0;
+    return usage + size <= limit;
 }
 
 /**
@@ -149,12 +457,133 @@ update_stats_free(size_t size)
 typedef struct rift_mem_header {
     size_t size;        /**< Size of allocated block (excluding header) */
     uint32_t magic;     /**< Magic number for validation */
-    uint8_t padding[4]; /**< Padding for alignment */
+    uint8_t tag;        /**< Tag the block counts under while profiling */
+    uint8_t padding[3]; /**< Padding for alignment */
 } rift_mem_header_t;
 
 /* Magic value for memory block validation */
 #define RIFT_MEMORY_MAGIC 0x52494654 /* "RIFT" in ASCII */
 
+/* Magic value of blocks allocated through a rift_allocator_t */
+#define RIFT_MEMORY_MAGIC_SCOPED 0x52494641 /* "RIFA" in ASCII */
+
+/**
+ * @brief Header of a block allocated through a rift_allocator_t
+ *
+ * The regular header comes last, so it sits right before the user memory
+ * like in any other block and the magic tells the two apart.
+ */
+typedef struct memory_scoped_header {
+    const rift_allocator_t *allocator; /**< Allocator the block belongs to */
+    size_t reserved;                   /**< Keeps the header a multiple of 16 bytes */
+    rift_mem_header_t base;            /**< Size and magic */
+} memory_scoped_header_t;
+
+/**
+ * @brief Get the scoped header of a block from its regular header
+ *
+ * @param header Regular header of a block with the scoped magic
+ * @return The scoped header
+ */
+static inline memory_scoped_header_t *
+memory_scoped_header_get(rift_mem_header_t *header)
+{
+    return (memory_scoped_header_t *)((unsigned char *)header -
+                                      offsetof(memory_scoped_header_t, base));
+}
+
+/**
+ * @brief Allocate from an allocator with no allocator in use on the thread
+ *
+ * @param allocator The allocator
+ * @param size Size to allocate in bytes
+ * @return Allocated memory or NULL on failure
+ */
+static void *
+allocator_allocate(const rift_allocator_t *allocator, size_t size)
+{
+    const rift_allocator_t *outer = thread_allocator;
+    thread_allocator = NULL;
+    void *block = allocator->allocate(allocator->ctx, size);
+    thread_allocator = outer;
+    return block;
+}
+
+/**
+ * @brief Resize a block of an allocator with no allocator in use on the thread
+ *
+ * @param allocator The allocator
+ * @param block The block
+ * @param old_size Size of the block in bytes
+ * @param size New size in bytes
+ * @return Resized memory or NULL on failure, in which case block is untouched
+ */
+static void *
+allocator_reallocate(const rift_allocator_t *allocator, void *block, size_t old_size, size_t size)
+{
+    const rift_allocator_t *outer = thread_allocator;
+    thread_allocator = NULL;
+
+    void *resized;
+    if (allocator->reallocate) {
+        resized = allocator->reallocate(allocator->ctx, block, old_size, size);
+    } else {
+        resized = allocator->allocate(allocator->ctx, size);
+        if (resized) {
+            memcpy(resized, block, old_size < size ? old_size : size);
+            if (allocator->deallocate) {
+                allocator->deallocate(allocator->ctx, block, old_size);
+            }
+        }
+    }
+
+    thread_allocator = outer;
+    return resized;
+}
+
+/**
+ * @brief Free a block of an allocator with no allocator in use on the thread
+ *
+ * @param allocator The allocator
+ * @param block The block
+ * @param size Size of the block in bytes
+ */
+static void
+allocator_deallocate(const rift_allocator_t *allocator, void *block, size_t size)
+{
+    if (!allocator->deallocate) {
+        return;
+    }
+
+    const rift_allocator_t *outer = thread_allocator;
+    thread_allocator = NULL;
+    allocator->deallocate(allocator->ctx, block, size);
+    thread_allocator = outer;
+}
+
+/**
+ * @brief Whether rift_malloc allocates through a rift_allocator_t on this thread
+ *
+ * @return true if an allocator is in use, false otherwise
+ */
+static inline bool
+memory_scope_active(void)
+{
+    return thread_allocator != NULL;
+}
+
+/**
+ * @brief Whether a block was allocated through a rift_allocator_t
+ *
+ * @param ptr Memory from rift_malloc
+ * @return true if the block belongs to an allocator, false otherwise
+ */
+static inline bool
+memory_block_scoped(void *ptr)
+{
+    return (((rift_mem_header_t *)ptr) - 1)->magic == RIFT_MEMORY_MAGIC_SCOPED;
+}
+
 /**
  * @brief Allocate memory with tracking
  *
@@ -168,33 +597,42 @@ rift_malloc(size_t size)
         return NULL;
     }
 
+    allocator_cache_refresh();
+
     /* Check allocation limit if set */
-    const rift_config_t *config = rift_config_get();
-    if (config->memory.allocation_limit > 0 &&
-        memory_stats.current_usage + size > config->memory.allocation_limit) {
+    if (!within_allocation_limit(0, size)) {
         return NULL;
     }
 
-    /* Determine which allocator to use */
-    void *(*alloc_func)(size_t) = standard_malloc;
-    if (config->memory.use_custom_allocator && config->memory.custom_malloc) {
-        alloc_func = config->memory.custom_malloc;
-    }
-
     /* Allocate memory with header */
-    size_t total_size = size + sizeof(rift_mem_header_t);
-    rift_mem_header_t *header = (rift_mem_header_t *)alloc_func(total_size);
-
-    if (!header) {
-        return NULL;
+    rift_mem_header_t *header;
+    const rift_allocator_t *allocator = thread_allocator;
+    if (allocator) {
+        memory_scoped_header_t *scoped = (memory_scoped_header_t *)allocator_allocate(
+            allocator, size + sizeof(memory_scoped_header_t));
+        if (!scoped) {
+            return NULL;
+        }
+        scoped->allocator = allocator;
+        header = &scoped->base;
+        header->magic = RIFT_MEMORY_MAGIC_SCOPED;
+    } else {
+        rift_malloc_func_t alloc_func =
+            atomic_load_explicit(&cached_malloc, memory_order_relaxed);
+        header = (rift_mem_header_t *)alloc_func(size + sizeof(rift_mem_header_t));
+        if (!header) {
+            return NULL;
+        }
+        header->magic = RIFT_MEMORY_MAGIC;
     }
 
     /* Initialize header */
     header->size = size;
-    header->magic = RIFT_MEMORY_MAGIC;
+    header->tag = memory_tag;
 
     /* Update statistics */
     update_stats_alloc(size);
+    update_tag_stats(header->tag, size, 0, 1, 0);
 
     /* Return pointer to the usable memory (after header) */
     return (void *)(header + 1);
@@ -223,44 +661,44 @@ rift_realloc(void *ptr, size_t size)
     rift_mem_header_t *header = ((rift_mem_header_t *)ptr) - 1;
 
     /* Validate the header */
-    if (header->magic != RIFT_MEMORY_MAGIC) {
+    if (header->magic != RIFT_MEMORY_MAGIC && header->magic != RIFT_MEMORY_MAGIC_SCOPED) {
         /* Invalid memory block, not allocated by rift_malloc */
         return NULL;
     }
 
+    allocator_cache_refresh();
+
     /* Check allocation limit if set */
-    const rift_config_t *config = rift_config_get();
     size_t old_size = header->size;
-    if (config->memory.allocation_limit > 0 &&
-        memory_stats.current_usage - old_size + size > config->memory.allocation_limit) {
+    if (!within_allocation_limit(old_size, size)) {
         return NULL;
     }
 
-    /* Determine which reallocator to use */
-    void *(*realloc_func)(void *, size_t) = standard_realloc;
-    if (config->memory.use_custom_allocator && config->memory.custom_realloc) {
-        realloc_func = config->memory.custom_realloc;
+    /* Reallocate with new size, with the allocator the block came from */
+    rift_mem_header_t *new_header;
+    if (header->magic == RIFT_MEMORY_MAGIC_SCOPED) {
+        memory_scoped_header_t *scoped = memory_scoped_header_get(header);
+        memory_scoped_header_t *resized = (memory_scoped_header_t *)allocator_reallocate(
+            scoped->allocator, scoped, old_size + sizeof(memory_scoped_header_t),
+            size + sizeof(memory_scoped_header_t));
+        new_header = resized ? &resized->base : NULL;
+    } else {
+        rift_realloc_func_t realloc_func =
+            atomic_load_explicit(&cached_realloc, memory_order_relaxed);
+        new_header =
+            (rift_mem_header_t *)realloc_func(header, size + sizeof(rift_mem_header_t));
     }
 
-    /* Reallocate with new size */
-    size_t new_total_size = size + sizeof(rift_mem_header_t);
-    rift_mem_header_t *new_header = (rift_mem_header_t *)realloc_func(header, new_total_size);
-
     if (!new_header) {
         return NULL;
     }
 
     /* Update statistics */
-    if (memory_tracking_enabled) {
-        memory_stats.current_usage = memory_stats.current_usage - old_size + size;
-        if (memory_stats.current_usage > memory_stats.peak_usage) {
-            memory_stats.peak_usage = memory_stats.current_usage;
-        }
-    }
+    update_stats_resize(old_size, size);
+    update_tag_stats(new_header->tag, size, old_size, 0, 0);
 
     /* Update header */
     new_header->size = size;
-    new_header->magic = RIFT_MEMORY_MAGIC;
 
     return (void *)(new_header + 1);
 }
@@ -281,27 +719,114 @@ rift_free(void *ptr)
     rift_mem_header_t *header = ((rift_mem_header_t *)ptr) - 1;
 
     /* Validate the header */
-    if (header->magic != RIFT_MEMORY_MAGIC) {
+    uint32_t magic = header->magic;
+    if (magic != RIFT_MEMORY_MAGIC && magic != RIFT_MEMORY_MAGIC_SCOPED) {
         /* Invalid memory block, not allocated by rift_malloc */
         return;
     }
 
     /* Update statistics */
     update_stats_free(header->size);
+    update_tag_stats(header->tag, 0, header->size, 0, 1);
 
     /* Invalidate the header to catch use-after-free */
     header->magic = 0;
 
-    /* Determine which free function to use */
-    void (*free_func)(void *) = standard_free;
-    const rift_config_t *config = rift_config_get();
-    if (config->memory.use_custom_allocator && config->memory.custom_free) {
-        free_func = config->memory.custom_free;
+    /* Free the memory block to the allocator it came from */
+    if (magic == RIFT_MEMORY_MAGIC_SCOPED) {
+        memory_scoped_header_t *scoped = memory_scoped_header_get(header);
+        allocator_deallocate(scoped->allocator, scoped,
+                             header->size + sizeof(memory_scoped_header_t));
+        return;
     }
-
-    /* Free the memory block */
+    allocator_cache_refresh();
+    rift_free_func_t free_func = atomic_load_explicit(&cached_free, memory_order_relaxed);
     free_func(header);
 }
+#else
+/**
+ * @brief Whether rift_malloc allocates through a rift_allocator_t, which
+ *        without tracking it never does
+ *
+ * @return false
+ */
+static inline bool
+memory_scope_active(void)
+{
+    return false;
+}
+
+/**
+ * @brief Whether a block was allocated through a rift_allocator_t
+ *
+ * @param ptr Memory from rift_malloc
+ * @return false
+ */
+static inline bool
+memory_block_scoped(void *ptr)
+{
+    (void)ptr;
+    return false;
+}
+
+/**
+ * @brief Allocate memory
+ *
+ * Tracking is compiled out, so this is the configured allocator alone.
+ *
+ * @param size Size to allocate in bytes
+ * @return Allocated memory or NULL on failure
+ */
+void *
+rift_malloc(size_t size)
+{
+    if (size == 0) {
+        return NULL;
+    }
+
+    allocator_cache_refresh();
+    return atomic_load_explicit(&cached_malloc, memory_order_relaxed)(size);
+}
+
+/**
+ * @brief Reallocate memory
+ *
+ * @param ptr Pointer to memory to reallocate
+ * @param size New size in bytes
+ * @return Reallocated memory or NULL on failure
+ */
+void *
+rift_realloc(void *ptr, size_t size)
+{
+    if (!ptr) {
+        return rift_malloc(size);
+    }
+
+    if (size == 0) {
+        rift_free(ptr);
+        return NULL;
+    }
+
+    allocator_cache_refresh();
+    return atomic_load_explicit(&cached_realloc, memory_order_relaxed)(ptr, size);
+}
+
+/**
+ * @brief Free allocated memory
+ *
+ * @param ptr Pointer to memory to free
+ */
+void
+rift_free(void *ptr)
+{
+    if (!ptr) {
+        return;
+    }
+
+    allocator_cache_refresh();
+    atomic_load_explicit(&cached_free, memory_order_relaxed)(ptr);
+}
+#endif /* RIFT_MEMORY_TRACKING */
 
 /**
  * @brief Allocate and zero-initialize memory
@@ -365,6 +890,14 @@ rift_memory_report(char *buffer, size_t buffer_size)
         return RIFT_ERROR_INVALID_PARAMETER;
     }
 
+    rift_memory_stats_t memory_stats;
+    memory_stats_sum(&memory_stats);
+
+    const char *tracking = "compiled out";
+#if RIFT_MEMORY_TRACKING
+    tracking = atomic_load(&memory_tracking_enabled) ? "yes" : "no";
+#endif
+
     int written = snprintf(buffer, buffer_size,
                            "LibRift Memory Usage Report:\n"
                            "  Current usage: %zu bytes (%.2f KB, %.2f MB)\n"
@@ -378,11 +911,1050 @@ rift_memory_report(char *buffer, size_t buffer_size)
                            memory_stats.peak_usage, (double)memory_stats.peak_usage / 1024.0,
                            (double)memory_stats.peak_usage / (1024.0 * 1024.0),
                            memory_stats.total_allocs, memory_stats.total_frees,
-                           memory_stats.active_allocs, memory_tracking_enabled ? "yes" : "no");
+                           memory_stats.active_allocs, tracking);
 
     if (written < 0 || (size_t)written >= buffer_size) {
         return RIFT_ERROR_BUFFER_OVERFLOW;
     }
 
     return RIFT_OK;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Enable allocation profiling by subsystem tag
+ *
+ * @param enabled Whether to enable profiling
+ * @return Previous state of profiling
+ */
+bool
+rift_memory_profiling_enable(bool enabled)
+{
+#if RIFT_MEMORY_TRACKING
+    return atomic_exchange(&memory_profiling_enabled, enabled);
+#else
+    (void)enabled;
+    return false;
+#endif
+}
+
+/**
+ * @brief Make a tag the one allocations on the calling thread count under
+ *
+ * @param tag The tag
+ * @return The previous tag
+ */
+rift_memory_tag_t
+rift_memory_tag_use(rift_memory_tag_t tag)
+{
+    rift_memory_tag_t previous = (rift_memory_tag_t)memory_tag;
+    memory_tag = (uint8_t)(tag < RIFT_MEMORY_TAG_COUNT ? tag : RIFT_MEMORY_TAG_OTHER);
+    return previous;
+}
+
+/**
+ * @brief Allocate memory under a tag
+ *
+ * @param size Size to allocate in bytes
+ * @param tag The tag
+ * @return Allocated memory or NULL on failure
+ */
+void *
+rift_malloc_tagged(size_t size, rift_memory_tag_t tag)
+{
+    rift_memory_tag_t outer = rift_memory_tag_use(tag);
+    void *ptr = rift_malloc(size);
+    rift_memory_tag_use(outer);
+    return ptr;
+}
+
+/**
+ * @brief Allocate zeroed memory under a tag
+ *
+ * @param num Number of elements
+ * @param size Size of each element in bytes
+ * @param tag The tag
+ * @return Allocated memory or NULL on failure
+ */
+void *
+rift_calloc_tagged(size_t num, size_t size, rift_memory_tag_t tag)
+{
+    rift_memory_tag_t outer = rift_memory_tag_use(tag);
+    void *ptr = rift_calloc(num, size);
+    rift_memory_tag_use(outer);
+    return ptr;
+}
+
+/**
+ * @brief Get the name of a tag
+ *
+ * @param tag The tag
+ * @return The name
+ */
+const char *
+rift_memory_tag_name(rift_memory_tag_t tag)
+{
+    return memory_tag_names[tag < RIFT_MEMORY_TAG_COUNT ? tag : RIFT_MEMORY_TAG_OTHER];
+}
+
+/**
+ * @brief Get the profiling counters of a tag
+ *
+ * @param tag The tag
+ * @param stats Pointer to store the counters
+ */
+void
+rift_memory_get_tag_stats(rift_memory_tag_t tag, rift_memory_tag_stats_t *stats)
+{
+    if (!stats) {
+        return;
+    }
+    memset(stats, 0, sizeof(*stats));
+    if (tag >= RIFT_MEMORY_TAG_COUNT) {
+        return;
+    }
+
+    for (size_t i = 0; i < RIFT_MEMORY_STATS_SHARDS; i++) {
+        memory_tag_counters_t *counters = &memory_stats_shards[i].tags[tag];
+        stats->bytes_allocated +=
+            atomic_load_explicit(&counters->bytes_allocated, memory_order_relaxed);
+        stats->bytes_freed += atomic_load_explicit(&counters->bytes_freed, memory_order_relaxed);
+        stats->allocs += atomic_load_explicit(&counters->allocs, memory_order_relaxed);
+        stats->frees += atomic_load_explicit(&counters->frees, memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Write the profiling counters of every tag as JSON
+ *
+ * @param buffer Buffer to store the report
+ * @param buffer_size Size of the buffer
+ * @return RIFT_OK on success, error code on failure
+ */
+rift_status_t
+rift_memory_profile_report(char *buffer, size_t buffer_size)
+{
+    if (!buffer || buffer_size == 0) {
+        return RIFT_ERROR_INVALID_PARAMETER;
+    }
+
+    bool profiling = false;
+#if RIFT_MEMORY_TRACKING
+    profiling = atomic_load(&memory_profiling_enabled);
+#endif
+
+    size_t offset = 0;
+    int written = snprintf(buffer, buffer_size, "{\n  \"profiling\": %s,\n  \"tags\": {",
+                           profiling ? "true" : "false");
+    for (size_t tag = 0; tag < RIFT_MEMORY_TAG_COUNT; tag++) {
+        if (written < 0 || (offset += (size_t)written) >= buffer_size) {
+            return RIFT_ERROR_BUFFER_OVERFLOW;
+        }
+
+        rift_memory_tag_stats_t stats;
+        rift_memory_get_tag_stats((rift_memory_tag_t)tag, &stats);
+        size_t current = stats.bytes_allocated > stats.bytes_freed
+                             ? stats.bytes_allocated - stats.bytes_freed
+                             : 0;
+        written = snprintf(buffer + offset, buffer_size - offset,
+                           "%s\n    \"%s\": {\"allocs\": %zu, \"frees\": %zu, "
+                           "\"bytes_allocated\": %zu, \"bytes_freed\": %zu, "
+                           "\"current_bytes\": %zu}",
+                           tag == 0 ? "" : ",", memory_tag_names[tag], stats.allocs, stats.frees,
+                           stats.bytes_allocated, stats.bytes_freed, current);
+    }
+    if (written < 0 || (offset += (size_t)written) >= buffer_size) {
+        return RIFT_ERROR_BUFFER_OVERFLOW;
+    }
+
+    written = snprintf(buffer + offset, buffer_size - offset, "\n  }\n}");
+    if (written < 0 || offset + (size_t)written >= buffer_size) {
+        return RIFT_ERROR_BUFFER_OVERFLOW;
+    }
+
+    return RIFT_OK;
+}
+
+/* Alignment of arena allocations, enough for any type */
+#define RIFT_ARENA_ALIGNMENT _Alignof(max_align_t)
+
+/**
+ * @brief Round a size up to the arena alignment
+ *
+ * @param size The size
+ * @return The rounded size, or 0 on overflow
+ */
+static size_t
+arena_align(size_t size)
+{
+    size_t aligned = (size + RIFT_ARENA_ALIGNMENT - 1) & ~(size_t)(RIFT_ARENA_ALIGNMENT - 1);
+    return aligned < size ? 0 : aligned;
+}
+
+/**
+ * @brief Block an arena carves allocations from
+ */
+typedef struct rift_arena_block {
+    struct rift_arena_block *next; /**< Next block, older than this one */
+    size_t size;                   /**< Usable bytes after the header */
+    size_t used;                   /**< Bytes handed out */
+} rift_arena_block_t;
+
+struct rift_arena {
+    rift_arena_block_t *blocks; /**< Block allocations are carved from, then older ones */
+    size_t block_size;          /**< Usable size of a regular block */
+    void *last;                 /**< Last allocation, the only one that can grow in place */
+    size_t allocations;         /**< Allocations served since the last reset */
+    size_t bytes_used;          /**< Bytes handed out since the last reset */
+};
+
+/**
+ * @brief Get the usable memory of a block
+ *
+ * @param block The block
+ * @return Start of the memory after the aligned header
+ */
+static unsigned char *
+arena_block_data(rift_arena_block_t *block)
+{
+    return (unsigned char *)block + arena_align(sizeof(rift_arena_block_t));
+}
+
+/**
+ * @brief Allocate a block
+ *
+ * @param size Usable size of the block
+ * @return A new block or NULL on failure
+ */
+static rift_arena_block_t *
+arena_block_create(size_t size)
+{
+    size_t header = arena_align(sizeof(rift_arena_block_t));
+    if (size > SIZE_MAX - header) {
+        return NULL;
+    }
+
+    rift_arena_block_t *block = (rift_arena_block_t *)rift_malloc(header + size);
+    if (!block) {
+        return NULL;
+    }
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+
+    return block;
+}
+
+/**
+ * @brief Create an arena
+ *
+ * @param block_size Size of the blocks, 0 for RIFT_ARENA_DEFAULT_BLOCK_SIZE
+ * @return A new arena or NULL on failure
+ */
+rift_arena_t *
+rift_arena_create(size_t block_size)
+{
+    rift_arena_t *arena = (rift_arena_t *)rift_malloc(sizeof(rift_arena_t));
+    if (!arena) {
+        return NULL;
+    }
+
+    arena->blocks = NULL;
+    arena->block_size = arena_align(block_size > 0 ? block_size : RIFT_ARENA_DEFAULT_BLOCK_SIZE);
+    arena->last = NULL;
+    arena->allocations = 0;
+    arena->bytes_used = 0;
+
+    return arena;
+}
+
+/**
+ * @brief Free an arena and everything allocated from it
+ *
+ * @param arena The arena (can be NULL)
+ */
+void
+rift_arena_free(rift_arena_t *arena)
+{
+    if (!arena) {
+        return;
+    }
+
+    rift_arena_block_t *block = arena->blocks;
+    while (block) {
+        rift_arena_block_t *next = block->next;
+        rift_free(block);
+        block = next;
+    }
+    rift_free(arena);
+}
+
+/**
+ * @brief Free everything allocated from an arena but keep it for reuse
+ *
+ * @param arena The arena
+ */
+void
+rift_arena_reset(rift_arena_t *arena)
+{
+    if (!arena) {
+        return;
+    }
+
+    // Keep one regular block; oversized ones were for single allocations
+    rift_arena_block_t *kept = NULL;
+    rift_arena_block_t *block = arena->blocks;
+    while (block) {
+        rift_arena_block_t *next = block->next;
+        if (!kept && block->size == arena->block_size) {
+            kept = block;
+            kept->next = NULL;
+            kept->used = 0;
+        } else {
+            rift_free(block);
+        }
+        block = next;
+    }
+
+    arena->blocks = kept;
+    arena->last = NULL;
+    arena->allocations = 0;
+    arena->bytes_used = 0;
+}
+
+/**
+ * @brief Allocate memory from an arena
+ *
+ * @param arena The arena
+ * @param size Size to allocate in bytes
+ * @return Allocated memory or NULL on failure
+ */
+void *
+rift_arena_alloc(rift_arena_t *arena, size_t size)
+{
+    if (!arena) {
+        return NULL;
+    }
+
+    size_t aligned = arena_align(size > 0 ? size : 1);
+    if (aligned == 0) {
+        return NULL;
+    }
+
+    rift_arena_block_t *block = arena->blocks;
+    if (!block || block->size - block->used < aligned) {
+        if (aligned > arena->block_size / 4) {
+            // A dedicated block goes behind the current one, which keeps its free space
+            rift_arena_block_t *dedicated = arena_block_create(aligned);
+            if (!dedicated) {
+                return NULL;
+            }
+            dedicated->used = aligned;
+            if (block) {
+                dedicated->next = block->next;
+                block->next = dedicated;
+            } else {
+                arena->blocks = dedicated;
+                arena->last = arena_block_data(dedicated);
+            }
+            arena->allocations++;
+            arena->bytes_used += aligned;
+            return arena_block_data(dedicated);
+        }
+
+        rift_arena_block_t *fresh = arena_block_create(arena->block_size);
+        if (!fresh) {
+            return NULL;
+        }
+        fresh->next = block;
+        arena->blocks = fresh;
+        block = fresh;
+    }
+
+    void *ptr = arena_block_data(block) + block->used;
+    block->used += aligned;
+    arena->last = ptr;
+    arena->allocations++;
+    arena->bytes_used += aligned;
+
+    return ptr;
+}
+
+/**
+ * @brief Allocate zero-initialized memory from an arena
+ *
+ * @param arena The arena
+ * @param num Number of elements
+ * @param size Size of each element in bytes
+ * @return Allocated memory or NULL on failure
+ */
+void *
+rift_arena_calloc(rift_arena_t *arena, size_t num, size_t size)
+{
+    size_t total_size = num * size;
+
+    /* Check for multiplication overflow */
+    if (size != 0 && total_size / size != num) {
+        return NULL;
+    }
+
+    void *ptr = rift_arena_alloc(arena, total_size);
+    if (ptr) {
+        memset(ptr, 0, total_size);
+    }
+
+    return ptr;
+}
+
+/**
+ * @brief Resize memory allocated from an arena
+ *
+ * @param arena The arena
+ * @param ptr Memory from rift_arena_alloc (can be NULL)
+ * @param old_size Size ptr was allocated with
+ * @param new_size New size in bytes
+ * @return Resized memory or NULL on failure
+ */
+void *
+rift_arena_realloc(rift_arena_t *arena, void *ptr, size_t old_size, size_t new_size)
+{
+    if (!ptr) {
+        return rift_arena_alloc(arena, new_size);
+    }
+    if (!arena) {
+        return NULL;
+    }
+
+    size_t old_aligned = arena_align(old_size > 0 ? old_size : 1);
+    size_t new_aligned = arena_align(new_size > 0 ? new_size : 1);
+    if (new_aligned == 0) {
+        return NULL;
+    }
+
+    // The last allocation of the current block can move its end
+    rift_arena_block_t *block = arena->blocks;
+    if (ptr == arena->last && block &&
+        (unsigned char *)ptr + old_aligned == arena_block_data(block) + block->used &&
+        block->used - old_aligned + new_aligned <= block->size) {
+        block->used = block->used - old_aligned + new_aligned;
+        arena->bytes_used = arena->bytes_used - old_aligned + new_aligned;
+        return ptr;
+    }
+
+    if (new_size <= old_size) {
+        return ptr;
+    }
+
+    void *moved = rift_arena_alloc(arena, new_size);
+    if (moved) {
+        memcpy(moved, ptr, old_size);
+    }
+    return moved;
+}
+
+/**
+ * @brief Duplicate a string into an arena
+ *
+ * @param arena The arena
+ * @param str String to duplicate
+ * @return Duplicated string or NULL on failure
+ */
+char *
+rift_arena_strdup(rift_arena_t *arena, const char *str)
+{
+    if (!str) {
+        return NULL;
+    }
+
+    return rift_arena_strndup(arena, str, strlen(str));
+}
+
+/**
+ * @brief Duplicate at most length bytes of a string into an arena
+ *
+ * @param arena The arena
+ * @param str String to duplicate
+ * @param length Maximum number of bytes to copy
+ * @return Duplicated string or NULL on failure
+ */
+char *
+rift_arena_strndup(rift_arena_t *arena, const char *str, size_t length)
+{
+    if (!str) {
+        return NULL;
+    }
+
+    size_t len = 0;
+    while (len < length && str[len] != '\0') {
+        len++;
+    }
+
+    char *dup = (char *)rift_arena_alloc(arena, len + 1);
+    if (dup) {
+        memcpy(dup, str, len);
+        dup[len] = '\0';
+    }
+
+    return dup;
+}
+
+/**
+ * @brief Read the counters of an arena
+ *
+ * @param arena The arena
+ * @param stats Pointer to store the counters
+ */
+void
+rift_arena_get_stats(const rift_arena_t *arena, rift_arena_stats_t *stats)
+{
+    if (!stats) {
+        return;
+    }
+    memset(stats, 0, sizeof(*stats));
+    if (!arena) {
+        return;
+    }
+
+    stats->allocations = arena->allocations;
+    stats->bytes_used = arena->bytes_used;
+    for (const rift_arena_block_t *block = arena->blocks; block; block = block->next) {
+        stats->bytes_reserved += block->size;
+        stats->blocks++;
+    }
+}
+
+/**
+ * @brief Make an allocator the one rift_malloc uses on the calling thread
+ *
+ * @param allocator The allocator, NULL for the configured one
+ * @return The allocator in use before the call, NULL for the configured one
+ */
+const rift_allocator_t *
+rift_allocator_use(const rift_allocator_t *allocator)
+{
+    const rift_allocator_t *previous = thread_allocator;
+    thread_allocator = allocator;
+    return previous;
+}
+
+/**
+ * @brief Get the allocator in use on the calling thread
+ *
+ * @return The allocator, NULL for the configured one
+ */
+const rift_allocator_t *
+rift_allocator_current(void)
+{
+    return thread_allocator;
+}
+
+/**
+ * @brief Allocate callback of the arena allocator
+ *
+ * @param ctx The arena
+ * @param size Size to allocate in bytes
+ * @return Allocated memory or NULL on failure
+ */
+static void *
+arena_allocator_allocate(void *ctx, size_t size)
+{
+    return rift_arena_alloc((rift_arena_t *)ctx, size);
+}
+
+/**
+ * @brief Reallocate callback of the arena allocator
+ *
+ * @param ctx The arena
+ * @param ptr Memory from the arena
+ * @param old_size Size ptr was allocated with
+ * @param new_size New size in bytes
+ * @return Resized memory or NULL on failure
+ */
+static void *
+arena_allocator_reallocate(void *ctx, void *ptr, size_t old_size, size_t new_size)
+{
+    return rift_arena_realloc((rift_arena_t *)ctx, ptr, old_size, new_size);
+}
+
+/**
+ * @brief Fill an allocator that allocates from an arena
+ *
+ * @param allocator The allocator to fill
+ * @param arena The arena
+ */
+void
+rift_allocator_init_arena(rift_allocator_t *allocator, rift_arena_t *arena)
+{
+    if (!allocator) {
+        return;
+    }
+
+    allocator->allocate = arena_allocator_allocate;
+    allocator->reallocate = arena_allocator_reallocate;
+    allocator->deallocate = NULL;
+    allocator->ctx = arena;
+}
+
+#if RIFT_MEMORY_POOLS
+/* Number of pool size classes */
+#define RIFT_POOL_CLASSES (RIFT_POOL_MAX_OBJECT_SIZE / RIFT_POOL_SIZE_CLASS)
+
+/**
+ * @brief A released object, linked through its own first bytes
+ */
+typedef struct pool_object {
+    struct pool_object *next; /**< Next released object of the class */
+} pool_object_t;
+
+/**
+ * @brief Released objects of one size class shared by all threads
+ */
+typedef struct pool_global_list {
+    pthread_mutex_t lock; /**< Protects the list */
+    pool_object_t *head;  /**< First object */
+} pool_global_list_t;
+
+/**
+ * @brief Released objects a thread keeps for itself
+ */
+typedef struct pool_thread_cache {
+    pool_object_t *heads[RIFT_POOL_CLASSES]; /**< First object of each class */
+    size_t counts[RIFT_POOL_CLASSES];        /**< Objects of each class */
+} pool_thread_cache_t;
+
+static pool_global_list_t pool_global_lists[RIFT_POOL_CLASSES];
+static pthread_once_t pool_once = PTHREAD_ONCE_INIT;
+static pthread_key_t pool_cache_key;
+static bool pool_cache_key_created = false;
+
+/* The calling thread's cache, also registered with pool_cache_key for cleanup */
+static _Thread_local pool_thread_cache_t *pool_cache = NULL;
+
+/**
+ * @brief Move a number of objects from a thread cache to the global list
+ *
+ * @param cache The thread cache
+ * @param cls The size class
+ * @param count Number of objects to move
+ */
+static void
+pool_cache_flush(pool_thread_cache_t *cache, size_t cls, size_t count)
+{
+    if (count == 0 || !cache->heads[cls]) {
+        return;
+    }
+
+    // Detach the first count objects as one chain, then splice it in
+    pool_object_t *first = cache->heads[cls];
+    pool_object_t *last = first;
+    size_t moved = 1;
+    while (moved < count && last->next) {
+        last = last->next;
+        moved++;
+    }
+    cache->heads[cls] = last->next;
+    cache->counts[cls] -= moved;
+
+    pool_global_list_t *list = &pool_global_lists[cls];
+    pthread_mutex_lock(&list->lock);
+    last->next = list->head;
+    list->head = first;
+    pthread_mutex_unlock(&list->lock);
+}
+
+/**
+ * @brief Give a thread's objects back to the global lists when it exits
+ *
+ * @param arg The thread cache
+ */
+static void
+pool_cache_destroy(void *arg)
+{
+    pool_thread_cache_t *cache = arg;
+    for (size_t cls = 0; cls < RIFT_POOL_CLASSES; cls++) {
+        pool_cache_flush(cache, cls, cache->counts[cls]);
+    }
+    free(cache);
+}
+
+static void
+pool_init(void)
+{
+    for (size_t cls = 0; cls < RIFT_POOL_CLASSES; cls++) {
+        pthread_mutex_init(&pool_global_lists[cls].lock, NULL);
+        pool_global_lists[cls].head = NULL;
+    }
+    pool_cache_key_created = pthread_key_create(&pool_cache_key, pool_cache_destroy) == 0;
+}
+
+/**
+ * @brief Get the calling thread's cache, creating it on first use
+ *
+ * @return The cache, or NULL if the thread has to use the global lists
+ */
+static pool_thread_cache_t *
+pool_cache_get(void)
+{
+    if (pool_cache) {
+        return pool_cache;
+    }
+
+    pthread_once(&pool_once, pool_init);
+    if (!pool_cache_key_created) {
+        return NULL;
+    }
+
+    pool_thread_cache_t *cache = calloc(1, sizeof(pool_thread_cache_t));
+    if (!cache) {
+        return NULL;
+    }
+    if (pthread_setspecific(pool_cache_key, cache) != 0) {
+        free(cache);
+        return NULL;
+    }
+
+    pool_cache = cache;
+    return cache;
+}
+
+/**
+ * @brief Allocate an object from the fixed-size object pools
+ *
+ * @param size Size of the object in bytes
+ * @return Allocated memory or NULL on failure
+ */
+void *
+rift_pool_alloc(size_t size)
+{
+    if (size == 0 || size > RIFT_POOL_MAX_OBJECT_SIZE || memory_scope_active()) {
+        return rift_malloc(size);
+    }
+
+    size_t cls = (size - 1) / RIFT_POOL_SIZE_CLASS;
+    pool_thread_cache_t *cache = pool_cache_get();
+
+    if (cache && cache->heads[cls]) {
+        pool_object_t *object = cache->heads[cls];
+        cache->heads[cls] = object->next;
+        cache->counts[cls]--;
+        return object;
+    }
+
+    // Take a batch from the global list; the objects past the first are
+    // kept for the thread's next allocations
+    pthread_once(&pool_once, pool_init);
+    size_t batch = cache ? RIFT_POOL_THREAD_CACHE / 2 + 1 : 1;
+    pool_global_list_t *list = &pool_global_lists[cls];
+    pthread_mutex_lock(&list->lock);
+    pool_object_t *object = list->head;
+    pool_object_t *last = object;
+    size_t taken = object ? 1 : 0;
+    while (last && taken < batch && last->next) {
+        last = last->next;
+        taken++;
+    }
+    if (last) {
+        list->head = last->next;
+        last->next = NULL;
+    }
+    pthread_mutex_unlock(&list->lock);
+
+    if (!object) {
+        RIFT_PROBE1(pool__exhausted, (cls + 1) * RIFT_POOL_SIZE_CLASS);
+        return rift_malloc((cls + 1) * RIFT_POOL_SIZE_CLASS);
+    }
+
+    if (cache) {
+        cache->heads[cls] = object->next;
+        cache->counts[cls] = taken - 1;
+    }
+
+    return object;
+}
+
+/**
+ * @brief Return an object to the pools
+ *
+ * @param ptr Object from rift_pool_alloc (can be NULL)
+ * @param size Size the object was allocated with
+ */
+void
+rift_pool_free(void *ptr, size_t size)
+{
+    if (!ptr) {
+        return;
+    }
+    if (size == 0 || size > RIFT_POOL_MAX_OBJECT_SIZE || memory_block_scoped(ptr)) {
+        rift_free(ptr);
+        return;
+    }
+
+    size_t cls = (size - 1) / RIFT_POOL_SIZE_CLASS;
+    pool_object_t *object = ptr;
+    pool_thread_cache_t *cache = pool_cache_get();
+
+    if (!cache) {
+        pool_global_list_t *list = &pool_global_lists[cls];
+        pthread_mutex_lock(&list->lock);
+        object->next = list->head;
+        list->head = object;
+        pthread_mutex_unlock(&list->lock);
+        return;
+    }
+
+    object->next = cache->heads[cls];
+    cache->heads[cls] = object;
+    cache->counts[cls]++;
+
+    // Keep half, so a thread that alternates around the limit does not
+    // take the lock on every release
+    if (cache->counts[cls] > RIFT_POOL_THREAD_CACHE) {
+        pool_cache_flush(cache, cls, cache->counts[cls] - RIFT_POOL_THREAD_CACHE / 2);
+    }
+}
+
+/**
+ * @brief Release the objects kept by the pools
+ */
+void
+rift_pool_trim(void)
+{
+    pthread_once(&pool_once, pool_init);
+
+    pool_thread_cache_t *cache = pool_cache;
+    for (size_t cls = 0; cls < RIFT_POOL_CLASSES; cls++) {
+        if (cache) {
+            pool_cache_flush(cache, cls, cache->counts[cls]);
+        }
+
+        pool_global_list_t *list = &pool_global_lists[cls];
+        pthread_mutex_lock(&list->lock);
+        pool_object_t *object = list->head;
+        list->head = NULL;
+        pthread_mutex_unlock(&list->lock);
+
+        while (object) {
+            pool_object_t *next = object->next;
+            rift_free(object);
+            object = next;
+        }
+    }
+}
+#else
+/**
+ * @brief Allocate an object
+ *
+ * Pools are compiled out, so this is rift_malloc.
+ *
+ * @param size Size of the object in bytes
+ * @return Allocated memory or NULL on failure
+ */
+void *
+rift_pool_alloc(size_t size)
+{
+    return rift_malloc(size);
+}
+
+/**
+ * @brief Free an object
+ *
+ * @param ptr Object from rift_pool_alloc (can be NULL)
+ * @param size Size the object was allocated with
+ */
+void
+rift_pool_free(void *ptr, size_t size)
+{
+    (void)size;
+    rift_free(ptr);
+}
+
+/**
+ * @brief Release the objects kept by the pools, of which there are none
+ */
+void
+rift_pool_trim(void)
+{
+}
+#endif /* RIFT_MEMORY_POOLS */
+
+/* Magic value of tables from rift_table_alloc */
+#define RIFT_TABLE_MAGIC 0x52495442 /* "RITB" in ASCII */
+
+/**
+ * @brief Header right before a table from rift_table_alloc
+ */
+typedef struct memory_table_header {
+    void *base;     /**< Start of the mapping or of the rift_malloc block */
+    size_t length;  /**< Length of the mapping, 0 for a rift_malloc block */
+    size_t size;    /**< Size of the table in bytes */
+    uint32_t magic; /**< RIFT_TABLE_MAGIC */
+    uint8_t tag;    /**< Tag a mapped table counts under while profiling */
+} memory_table_header_t;
+
+_Static_assert(sizeof(memory_table_header_t) <= RIFT_TABLE_ALIGNMENT,
+               "the table header must fit in the alignment gap");
+
+/**
+ * @brief Round a size up to a multiple of a power of two
+ *
+ * @param size The size
+ * @param unit The power of two
+ * @return The rounded size
+ */
+static inline size_t
+table_round_up(size_t size, size_t unit)
+{
+    return (size + unit - 1) & ~(unit - 1);
+}
+
+#ifdef __linux__
+/**
+ * @brief Map anonymous memory for a table
+ *
+ * Reserved huge pages are tried first. Without them the mapping is aligned
+ * to a huge page by mapping one more and trimming the ends, so transparent
+ * huge pages can back it from its first byte.
+ *
+ * @param length Bytes needed
+ * @param huge_pages Whether to back the mapping with huge pages
+ * @param mapped Set to the length of the mapping
+ * @return Start of the mapping, or NULL on failure
+ */
+static void *
+table_map(size_t length, bool huge_pages, size_t *mapped)
+{
+    int protection = PROT_READ | PROT_WRITE;
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+    if (huge_pages) {
+        size_t huge_length = table_round_up(length, RIFT_TABLE_HUGE_PAGE_SIZE);
+#ifdef MAP_HUGETLB
+        void *base = mmap(NULL, huge_length, protection, flags | MAP_HUGETLB, -1, 0);
+        if (base != MAP_FAILED) {
+            *mapped = huge_length;
+            return base;
+        }
+#endif
+        unsigned char *region =
+            mmap(NULL, huge_length + RIFT_TABLE_HUGE_PAGE_SIZE, protection, flags, -1, 0);
+        if (region != MAP_FAILED) {
+            size_t head = table_round_up((uintptr_t)region, RIFT_TABLE_HUGE_PAGE_SIZE) -
+                          (uintptr_t)region;
+            if (head > 0) {
+                munmap(region, head);
+            }
+            if (head < RIFT_TABLE_HUGE_PAGE_SIZE) {
+                munmap(region + head + huge_length, RIFT_TABLE_HUGE_PAGE_SIZE - head);
+            }
+#ifdef MADV_HUGEPAGE
+            madvise(region + head, huge_length, MADV_HUGEPAGE);
+#endif
+            *mapped = huge_length;
+            return region + head;
+        }
+    }
+
+    long page = sysconf(_SC_PAGESIZE);
+    size_t page_length = table_round_up(length, page > 0 ? (size_t)page : 4096);
+    void *base = mmap(NULL, page_length, protection, flags, -1, 0);
+    if (base == MAP_FAILED) {
+        return NULL;
+    }
+    *mapped = page_length;
+    return base;
+}
+#endif /* __linux__ */
+
+/**
+ * @brief Allocate a zeroed lookup table
+ *
+ * @param num Number of elements
+ * @param size Size of each element in bytes
+ * @return Zeroed memory to release with rift_table_free, or NULL on failure
+ */
+void *
+rift_table_alloc(size_t num, size_t size)
+{
+    size_t total = num * size;
+    if (total == 0 || total / size != num ||
+        total > SIZE_MAX - RIFT_TABLE_ALIGNMENT - 2 * RIFT_TABLE_HUGE_PAGE_SIZE) {
+        return NULL;
+    }
+
+    allocator_cache_refresh();
+
+    memory_table_header_t *header;
+#ifdef __linux__
+    // Tables allocated while an allocator is in use on the thread come from it
+    size_t threshold = atomic_load_explicit(&cached_table_page_threshold, memory_order_relaxed);
+    if (threshold != 0 && total >= threshold && !memory_scope_active()) {
+#if RIFT_MEMORY_TRACKING
+        if (!within_allocation_limit(0, total)) {
+            return NULL;
+        }
+#endif
+        bool huge_pages = atomic_load_explicit(&cached_table_huge_pages, memory_order_relaxed);
+        size_t length;
+        unsigned char *base = table_map(total + RIFT_TABLE_ALIGNMENT, huge_pages, &length);
+        if (base) {
+            // Fresh anonymous pages are already zero
+            header = (memory_table_header_t *)(base + RIFT_TABLE_ALIGNMENT) - 1;
+            header->base = base;
+            header->length = length;
+            header->size = total;
+            header->magic = RIFT_TABLE_MAGIC;
+            header->tag = memory_tag;
+#if RIFT_MEMORY_TRACKING
+            update_stats_alloc(total);
+            update_tag_stats(header->tag, total, 0, 1, 0);
+#endif
+            return header + 1;
+        }
+    }
+#endif
+
+    unsigned char *block =
+        rift_calloc(1, total + sizeof(memory_table_header_t) + RIFT_TABLE_ALIGNMENT);
+    if (!block) {
+        return NULL;
+    }
+    uintptr_t data =
+        table_round_up((uintptr_t)block + sizeof(memory_table_header_t), RIFT_TABLE_ALIGNMENT);
+    header = (memory_table_header_t *)data - 1;
+    header->base = block;
+    header->length = 0;
+    header->size = total;
+    header->magic = RIFT_TABLE_MAGIC;
+    return header + 1;
+}
+
+/**
+ * @brief Release a table from rift_table_alloc
+ *
+ * @param ptr The table (can be NULL)
+ */
+void
+rift_table_free(void *ptr)
+{
+    if (!ptr) {
+        return;
+    }
+
+    memory_table_header_t *header = (memory_table_header_t *)ptr - 1;
+    if (header->magic != RIFT_TABLE_MAGIC) {
+        /* Not a table from rift_table_alloc */
+        return;
+    }
+    header->magic = 0;
+
+#ifdef __linux__
+    if (header->length > 0) {
+#if RIFT_MEMORY_TRACKING
+        update_stats_free(header->size);
+        update_tag_stats(header->tag, 0, header->size, 0, 1);
+#endif
+        munmap(header->base, header->length);
+        return;
+    }
+#endif
+    rift_free(header->base);
+}
@@ -10,6 +10,8 @@
  */
 
 #include "core/parser/ast.h"
+#include "core/memory/memory.h"
+#include "core/parser/parser.h"
 #include "librift/parser/ast.h"
 /**
  * @brief Create a new AST
@@ -46,7 +48,7 @@ rift_regex_ast_free(rift_regex_ast_t *ast)
 
     // Free the root node and all its children
     if (ast->root) {
-        free_ast_node(ast->root);
+        rift_regex_ast_node_free_recursive(ast->root);
     }
 
     // Free the AST itself
@@ -291,6 +293,23 @@ rift_regex_ast_clone(const rift_regex_ast_t *ast)
     return clone;
 }
 
+/**
+ * @brief Count the capture groups in a subtree
+ *
+ * @param node The root of the subtree
+ * @return The number of capture groups
+ */
+static size_t
+count_node_groups(const rift_regex_ast_node_t *node)
+{
+    size_t count = node->type == RIFT_REGEX_AST_NODE_GROUP ||
+                   node->type == RIFT_REGEX_AST_NODE_NAMED_GROUP;
+    for (size_t i = 0; i < node->num_children; i++) {
+        count += count_node_groups(node->children[i]);
+    }
+    return count;
+}
+
 /**
  * @brief Count the number of capture groups in an AST
  *
@@ -304,9 +323,7 @@ rift_regex_ast_count_groups(const rift_regex_ast_t *ast)
         return 0;
     }
 
-    // In a full implementation, we would traverse the tree and count group nodes
-    // For now, we'll just return the stored count
-    return ast->group_count;
+    return count_node_groups(ast->root);
 }
 
 /**
@@ -349,33 +366,12 @@ build_ast_from_pattern(rift_regex_ast_node_t *root, const char *pattern, rift_re
         return false;
     }
 
-    // This is a stub implementation - in a real implementation,
-    // we would parse the pattern string and build an AST
-
-    // For now, we'll create a simple AST with a literal node
-    rift_regex_ast_node_t *literal = rift_regex_ast_create_node(RIFT_REGEX_AST_NODE_LITERAL);
-    if (!literal) {
-        if (error) {
-            error->code = RIFT_REGEX_ERROR_MEMORY_ALLOCATION;
-            strcpy(error->message, "Memory allocation failed");
-        }
-        return false;
-    }
-
-    if (!rift_regex_ast_set_value(literal, pattern)) {
-        free_ast_node(literal);
-        if (error) {
-            error->code = RIFT_REGEX_ERROR_MEMORY_ALLOCATION;
-            strcpy(error->message, "Memory allocation failed");
-        }
-        return false;
-    }
-
-    if (!rift_regex_ast_add_child(root, literal)) {
-        rift_regex_ast_node_free_recursive(literal);
+    // The nodes go where the root is; the parser needs nothing freed afterwards
+    rift_regex_parser_t parser;
+    rift_regex_parser_init(&parser, flags, (flags & RIFT_REGEX_FLAG_RIFT_SYNTAX) != 0);
+    if (!rift_regex_parser_parse_into(&parser, pattern, flags, root)) {
         if (error) {
-            error->code = RIFT_REGEX_ERROR_INTERNAL;
-            strcpy(error->message, "Internal error while adding child node");
+            *error = rift_regex_parser_get_error(&parser);
         }
         return false;
     }
@@ -393,6 +389,22 @@ build_ast_from_pattern(rift_regex_ast_node_t *root, const char *pattern, rift_re
  */
 rift_regex_ast_t *
 rift_regex_parse(const char *pattern, rift_regex_flags_t flags, rift_regex_error_t *error)
+{
+    return rift_regex_parse_in_arena(pattern, flags, NULL, error);
+}
+
+/**
+ * @brief Parse a regex pattern into an AST under the tag already in use
+ *
+ * @param pattern The pattern string
+ * @param flags Compilation flags
+ * @param arena Arena for the nodes, NULL to create them on the heap
+ * @param error Pointer to store error code (can be NULL)
+ * @return A new AST representing the pattern or NULL on failure
+ */
+static rift_regex_ast_t *
+parse_in_arena(const char *pattern, rift_regex_flags_t flags, rift_arena_t *arena,
+               rift_regex_error_t *error)
 {
     if (!pattern) {
         if (error) {
@@ -415,8 +427,9 @@ rift_regex_parse(const char *pattern, rift_regex_flags_t flags, rift_regex_error
     // Set the flags
     ast->flags = flags;
 
-    // Create a root node
-    rift_regex_ast_node_t *root = rift_regex_ast_create_node(RIFT_REGEX_AST_NODE_ROOT);
+    // Create a root node; the rest of the tree goes where the root is
+    rift_regex_ast_node_t *root =
+        rift_regex_ast_node_create_in_arena(arena, RIFT_REGEX_AST_NODE_ROOT);
     if (!root) {
         rift_regex_ast_free(ast);
         if (error) {
@@ -450,3 +463,23 @@ rift_regex_parse(const char *pattern, rift_regex_flags_t flags, rift_regex_error
 
     return ast;
 }
+
+/**
+ * @brief Parse a regex pattern into an AST whose nodes live in an arena
+ *
+ * @param pattern The pattern string
+ * @param flags Compilation flags
+ * @param arena Arena for the nodes, NULL to create them on the heap
+ * @param error Pointer to store error code (can be NULL)
+ * @return A new AST representing the pattern or NULL on failure
+ */
+rift_regex_ast_t *
+rift_regex_parse_in_arena(const char *pattern, rift_regex_flags_t flags, rift_arena_t *arena,
+                          rift_regex_error_t *error)
+{
+    // The tokenizer counts its own allocations under its tag
+    rift_memory_tag_t outer = rift_memory_tag_use(RIFT_MEMORY_TAG_PARSER);
+    rift_regex_ast_t *ast = parse_in_arena(pattern, flags, arena, error);
+    rift_memory_tag_use(outer);
+    return ast;
+}
@@ -13,6 +13,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "core/memory/memory.h"
 #include "librift/parser/ast_node.h"
 
 
@@ -30,7 +31,22 @@
 rift_regex_ast_node_t *
 rift_regex_ast_node_create(rift_regex_ast_node_type_t type)
 {
-    rift_regex_ast_node_t *node = (rift_regex_ast_node_t *)malloc(sizeof(rift_regex_ast_node_t));
+    return rift_regex_ast_node_create_in_arena(NULL, type);
+}
+
+/**
+ * @brief Create a new AST node in an arena
+ *
+ * @param arena The arena, NULL to create the node on the heap
+ * @param type The type of node to create
+ * @return A new AST node or NULL on failure
+ */
+rift_regex_ast_node_t *
+rift_regex_ast_node_create_in_arena(rift_arena_t *arena, rift_regex_ast_node_type_t type)
+{
+    rift_regex_ast_node_t *node =
+        arena ? (rift_regex_ast_node_t *)rift_arena_alloc(arena, sizeof(rift_regex_ast_node_t))
+              : (rift_regex_ast_node_t *)malloc(sizeof(rift_regex_ast_node_t));
 
     if (!node) {
         return NULL;
@@ -45,6 +61,8 @@ rift_regex_ast_node_create(rift_regex_ast_node_type_t type)
     node->flags = 0;
     node->parent = NULL;
     node->state_info = NULL;
+    node->arena = arena;
+    node->hash = 0;
 
     return node;
 }
@@ -61,6 +79,11 @@ rift_regex_ast_node_free(rift_regex_ast_node_t *node)
         return;
     }
 
+    /* Arena nodes go with their arena */
+    if (node->arena) {
+        return;
+    }
+
     /* Free the value if it exists */
     if (node->value) {
         free(node->value);
@@ -135,15 +158,19 @@ rift_regex_ast_node_set_value(rift_regex_ast_node_t *node, const char *value)
         return false;
     }
 
+    rift_regex_ast_node_invalidate_hash(node);
+
     /* Free old value if it exists */
     if (node->value) {
-        free(node->value);
+        if (!node->arena) {
+            free(node->value);
+        }
         node->value = NULL;
     }
 
     /* Set the new value */
     if (value) {
-        node->value = strdup(value);
+        node->value = node->arena ? rift_arena_strdup(node->arena, value) : strdup(value);
         if (!node->value) {
             return false;
         }
@@ -187,8 +214,14 @@ rift_regex_ast_node_add_child(rift_regex_ast_node_t *parent, rift_regex_ast_node
         size_t new_capacity =
             parent->child_capacity == 0 ? INITIAL_CHILD_CAPACITY : parent->child_capacity * 2;
 
-        rift_regex_ast_node_t **new_children = (rift_regex_ast_node_t **)realloc(
-            parent->children, sizeof(rift_regex_ast_node_t *) * new_capacity);
+        rift_regex_ast_node_t **new_children =
+            parent->arena
+                ? (rift_regex_ast_node_t **)rift_arena_realloc(
+                      parent->arena, parent->children,
+                      sizeof(rift_regex_ast_node_t *) * parent->child_capacity,
+                      sizeof(rift_regex_ast_node_t *) * new_capacity)
+                : (rift_regex_ast_node_t **)realloc(parent->children,
+                                                    sizeof(rift_regex_ast_node_t *) * new_capacity);
 
         if (!new_children) {
             return false;
@@ -200,6 +233,7 @@ rift_regex_ast_node_add_child(rift_regex_ast_node_t *parent, rift_regex_ast_node
 
     /* Add the child to the array */
     parent->children[parent->num_children++] = child;
+    rift_regex_ast_node_invalidate_hash(parent);
 
     /* Update the child's parent pointer */
     child->parent = parent;
@@ -230,6 +264,7 @@ rift_regex_ast_node_remove_child(rift_regex_ast_node_t *parent, size_t index)
     }
 
     parent->num_children--;
+    rift_regex_ast_node_invalidate_hash(parent);
 
     /* Clear the child's parent pointer */
     if (child) {
@@ -288,6 +323,74 @@ rift_regex_ast_node_get_parent(const rift_regex_ast_node_t *node)
     return node->parent;
 }
 
+/**
+ * @brief Mix bytes into an FNV-1a hash
+ */
+static uint64_t
+hash_bytes(uint64_t hash, const void *data, size_t size)
+{
+    const unsigned char *bytes = (const unsigned char *)data;
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+/**
+ * @brief Get the content hash of a subtree
+ *
+ * @param node The root of the subtree
+ * @return The hash, never 0, or 0 for a NULL node
+ */
+uint64_t
+rift_regex_ast_node_hash(const rift_regex_ast_node_t *node)
+{
+    if (!node) {
+        return 0;
+    }
+    if (node->hash) {
+        return node->hash;
+    }
+
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    uint32_t type = (uint32_t)node->type;
+    uint64_t flags = (uint64_t)node->flags;
+    uint64_t count = (uint64_t)node->num_children;
+    hash = hash_bytes(hash, &type, sizeof(type));
+    hash = hash_bytes(hash, &flags, sizeof(flags));
+
+    // A missing value and an empty one hash differently
+    hash = hash_bytes(hash, node->value ? "v" : "n", 1);
+    if (node->value) {
+        hash = hash_bytes(hash, node->value, strlen(node->value) + 1);
+    }
+
+    hash = hash_bytes(hash, &count, sizeof(count));
+    for (size_t i = 0; i < node->num_children; i++) {
+        uint64_t child = rift_regex_ast_node_hash(node->children[i]);
+        hash = hash_bytes(hash, &child, sizeof(child));
+    }
+
+    // The hash is a cache of the node contents, so storing it does not change the node
+    ((rift_regex_ast_node_t *)node)->hash = hash ? hash : 1;
+    return node->hash;
+}
+
+/**
+ * @brief Forget the content hash of a node and of its ancestors
+ *
+ * @param node The changed node
+ */
+void
+rift_regex_ast_node_invalidate_hash(rift_regex_ast_node_t *node)
+{
+    // A known hash implies known hashes below it, so the walk can stop at an unknown one
+    while (node && node->hash) {
+        node->hash = 0;
+        node = node->parent;
+    }
+}
+
 /**
  * @brief Clone a node (shallow copy, without children)
  *
@@ -0,0 +1,611 @@
+/**
+ * @file flat_ast.c
+ * @brief Implementation of the flat, index-based AST of LibRift
+ *
+ * A flat AST is built from a node tree in two passes: the first counts the
+ * nodes and value bytes, the second lays the nodes out depth-first in one
+ * allocation that also holds the child table and the string pool.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/parser/flat_ast.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/memory/memory.h"
+
+/**
+ * @brief State of the second pass of a flat AST build
+ */
+typedef struct flat_builder {
+    rift_regex_flat_ast_t *flat;        /**< Flat AST being filled */
+    rift_regex_flat_node_id_t next_node; /**< Next free node */
+    uint32_t next_child;                /**< Next free entry of the child table */
+    uint32_t *slots;                    /**< Pool offsets of the values stored so far */
+    size_t slot_mask;                   /**< Number of slots minus one */
+} flat_builder_t;
+
+/**
+ * @brief Growable buffer for string representations
+ */
+typedef struct string_buffer {
+    char *data;      /**< Text, NUL-terminated */
+    size_t length;   /**< Length of the text */
+    size_t capacity; /**< Size of the data allocation */
+    bool failed;     /**< Whether an allocation failed */
+} string_buffer_t;
+
+/**
+ * @brief Set an error, if an error structure was given
+ *
+ * @param error Pointer to the error structure (can be NULL)
+ * @param code The error code
+ * @param message The error message
+ */
+static void
+set_error(rift_regex_error_t *error, rift_regex_error_code_t code, const char *message)
+{
+    if (error) {
+        error->code = code;
+        snprintf(error->message, sizeof(error->message), "%s", message);
+    }
+}
+
+/**
+ * @brief Count the nodes and value bytes of a tree
+ *
+ * @param node The root of the tree
+ * @param node_count Running count of nodes
+ * @param string_bytes Running count of value bytes, terminators included
+ * @return true if the tree has no missing children, false otherwise
+ */
+static bool
+measure_tree(const rift_regex_ast_node_t *node, size_t *node_count, size_t *string_bytes)
+{
+    if (!node) {
+        return false;
+    }
+
+    (*node_count)++;
+    if (node->value) {
+        *string_bytes += strlen(node->value) + 1;
+    }
+
+    for (size_t i = 0; i < node->num_children; i++) {
+        if (!measure_tree(node->children[i], node_count, string_bytes)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Store a value in the string pool, once per distinct value
+ *
+ * @param builder The builder
+ * @param value The value
+ * @return The offset of the value in the pool
+ */
+static uint32_t
+intern_value(flat_builder_t *builder, const char *value)
+{
+    rift_regex_flat_ast_t *flat = builder->flat;
+    size_t length = strlen(value);
+
+    /* FNV-1a */
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (unsigned char)value[i]) * 16777619u;
+    }
+
+    size_t slot = hash & builder->slot_mask;
+    while (builder->slots[slot] != RIFT_REGEX_FLAT_AST_NONE) {
+        if (strcmp(flat->strings + builder->slots[slot], value) == 0) {
+            return builder->slots[slot];
+        }
+        slot = (slot + 1) & builder->slot_mask;
+    }
+
+    uint32_t offset = flat->string_size;
+    memcpy(flat->strings + offset, value, length + 1);
+    flat->string_size += (uint32_t)(length + 1);
+    builder->slots[slot] = offset;
+
+    return offset;
+}
+
+/**
+ * @brief Lay a tree out in the flat AST, each node before its children
+ *
+ * @param builder The builder
+ * @param node The root of the tree
+ * @param parent The flat parent of the tree's root
+ * @return The index given to the tree's root
+ */
+static rift_regex_flat_node_id_t
+flatten_tree(flat_builder_t *builder, const rift_regex_ast_node_t *node,
+             rift_regex_flat_node_id_t parent)
+{
+    rift_regex_flat_ast_t *flat = builder->flat;
+    rift_regex_flat_node_id_t id = builder->next_node++;
+    rift_regex_flat_ast_node_t *flat_node = &flat->nodes[id];
+
+    flat_node->type = (uint8_t)node->type;
+    flat_node->flags = (uint32_t)node->flags;
+    flat_node->value = node->value ? intern_value(builder, node->value) : RIFT_REGEX_FLAT_AST_NONE;
+    flat_node->first_child = builder->next_child;
+    flat_node->child_count = (uint32_t)node->num_children;
+    flat_node->parent = parent;
+
+    // Reserve the node's range of the child table before its subtrees take theirs
+    builder->next_child += flat_node->child_count;
+
+    for (size_t i = 0; i < node->num_children; i++) {
+        flat->children[flat_node->first_child + i] = flatten_tree(builder, node->children[i], id);
+    }
+
+    return id;
+}
+
+/**
+ * @brief Point the arrays of a flat AST into the allocation that follows it
+ *
+ * @param flat The flat AST, at the start of its allocation
+ */
+static void
+locate_arrays(rift_regex_flat_ast_t *flat)
+{
+    char *base = (char *)(flat + 1);
+
+    flat->nodes = (rift_regex_flat_ast_node_t *)base;
+    flat->children =
+        (rift_regex_flat_node_id_t *)(base + flat->node_count * sizeof(rift_regex_flat_ast_node_t));
+    flat->strings = (char *)(flat->children + flat->node_count);
+}
+
+/**
+ * @brief Build a flat AST from a node tree
+ *
+ * @param root The root of the tree, which is left untouched
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new flat AST or NULL on failure
+ */
+rift_regex_flat_ast_t *
+rift_regex_flat_ast_from_node(const rift_regex_ast_node_t *root, rift_regex_error_t *error)
+{
+    size_t node_count = 0;
+    size_t string_bytes = 0;
+
+    if (!measure_tree(root, &node_count, &string_bytes)) {
+        set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER, "AST has a missing node");
+        return NULL;
+    }
+
+    if (node_count >= RIFT_REGEX_FLAT_AST_NONE || string_bytes >= RIFT_REGEX_FLAT_AST_NONE) {
+        set_error(error, RIFT_REGEX_ERROR_LIMIT_EXCEEDED, "AST too large for a flat AST");
+        return NULL;
+    }
+
+    // One child table entry per node but the root; the spare entry keeps the math simple
+    size_t size = sizeof(rift_regex_flat_ast_t) +
+                  node_count * (sizeof(rift_regex_flat_ast_node_t) +
+                                sizeof(rift_regex_flat_node_id_t)) +
+                  string_bytes;
+
+    rift_regex_flat_ast_t *flat = (rift_regex_flat_ast_t *)malloc(size);
+    if (!flat) {
+        set_error(error, RIFT_REGEX_ERROR_MEMORY, "Failed to allocate flat AST");
+        return NULL;
+    }
+
+    flat->node_count = (uint32_t)node_count;
+    flat->string_size = 0;
+    flat->size = size;
+    flat->flags = RIFT_REGEX_FLAG_NONE;
+    locate_arrays(flat);
+
+    // Open addressing table at most half full
+    size_t slot_count = 2;
+    while (slot_count < node_count * 2) {
+        slot_count *= 2;
+    }
+
+    flat_builder_t builder = {flat, 0, 0, (uint32_t *)malloc(slot_count * sizeof(uint32_t)),
+                              slot_count - 1};
+    if (!builder.slots) {
+        free(flat);
+        set_error(error, RIFT_REGEX_ERROR_MEMORY, "Failed to allocate flat AST");
+        return NULL;
+    }
+    memset(builder.slots, 0xff, slot_count * sizeof(uint32_t));
+
+    flatten_tree(&builder, root, RIFT_REGEX_FLAT_AST_NONE);
+    free(builder.slots);
+
+    flat->group_count = rift_regex_flat_ast_count_groups(flat);
+
+    return flat;
+}
+
+/**
+ * @brief Build a flat AST from an AST
+ *
+ * @param ast The AST, which is left untouched
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new flat AST or NULL on failure
+ */
+rift_regex_flat_ast_t *
+rift_regex_flat_ast_from_ast(const rift_regex_ast_t *ast, rift_regex_error_t *error)
+{
+    if (!ast || !ast->root) {
+        set_error(error, RIFT_REGEX_ERROR_INVALID_PARAMETER, "AST has no root node");
+        return NULL;
+    }
+
+    rift_regex_flat_ast_t *flat = rift_regex_flat_ast_from_node(ast->root, error);
+    if (flat) {
+        flat->flags = ast->flags;
+    }
+
+    return flat;
+}
+
+/**
+ * @brief Rebuild a node tree from a flat AST
+ *
+ * @param flat The flat AST
+ * @param id The node to start from
+ * @param arena Arena for the new nodes, NULL to create them on the heap
+ * @return The new tree or NULL on failure
+ */
+rift_regex_ast_node_t *
+rift_regex_flat_ast_to_node(const rift_regex_flat_ast_t *flat, rift_regex_flat_node_id_t id,
+                            rift_arena_t *arena)
+{
+    if (!flat || id >= flat->node_count) {
+        return NULL;
+    }
+
+    const rift_regex_flat_ast_node_t *flat_node = &flat->nodes[id];
+    rift_regex_ast_node_t *node =
+        rift_regex_ast_node_create_in_arena(arena, (rift_regex_ast_node_type_t)flat_node->type);
+    if (!node) {
+        return NULL;
+    }
+
+    node->flags = (rift_regex_flags_t)flat_node->flags;
+    if (flat_node->value != RIFT_REGEX_FLAT_AST_NONE &&
+        !rift_regex_ast_node_set_value(node, flat->strings + flat_node->value)) {
+        rift_regex_ast_node_free(node);
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < flat_node->child_count; i++) {
+        rift_regex_ast_node_t *child =
+            rift_regex_flat_ast_to_node(flat, flat->children[flat_node->first_child + i], arena);
+
+        if (!child || !rift_regex_ast_node_add_child(node, child)) {
+            rift_regex_ast_node_free_recursive(child);
+            rift_regex_ast_node_free_recursive(node);
+            return NULL;
+        }
+    }
+
+    return node;
+}
+
+/**
+ * @brief Free a flat AST
+ *
+ * @param flat The flat AST to free
+ */
+void
+rift_regex_flat_ast_free(rift_regex_flat_ast_t *flat)
+{
+    free(flat);
+}
+
+/**
+ * @brief Clone a flat AST
+ *
+ * @param flat The flat AST to clone
+ * @return A new flat AST or NULL on failure
+ */
+rift_regex_flat_ast_t *
+rift_regex_flat_ast_clone(const rift_regex_flat_ast_t *flat)
+{
+    if (!flat) {
+        return NULL;
+    }
+
+    rift_regex_flat_ast_t *clone = (rift_regex_flat_ast_t *)malloc(flat->size);
+    if (!clone) {
+        return NULL;
+    }
+
+    memcpy(clone, flat, flat->size);
+    locate_arrays(clone);
+
+    return clone;
+}
+
+/**
+ * @brief Get the number of nodes
+ *
+ * @param flat The flat AST
+ * @return The number of nodes
+ */
+size_t
+rift_regex_flat_ast_get_node_count(const rift_regex_flat_ast_t *flat)
+{
+    return flat ? flat->node_count : 0;
+}
+
+/**
+ * @brief Get the type of a node
+ *
+ * @param flat The flat AST
+ * @param id The node
+ * @return The node type, RIFT_REGEX_AST_NODE_NONE for an invalid node
+ */
+rift_regex_ast_node_type_t
+rift_regex_flat_ast_get_node_type(const rift_regex_flat_ast_t *flat, rift_regex_flat_node_id_t id)
+{
+    if (!flat || id >= flat->node_count) {
+        return RIFT_REGEX_AST_NODE_NONE;
+    }
+
+    return (rift_regex_ast_node_type_t)flat->nodes[id].type;
+}
+
+/**
+ * @brief Get the value of a node
+ *
+ * @param flat The flat AST
+ * @param id The node
+ * @return The node value or NULL if not set
+ */
+const char *
+rift_regex_flat_ast_get_node_value(const rift_regex_flat_ast_t *flat, rift_regex_flat_node_id_t id)
+{
+    if (!flat || id >= flat->node_count || flat->nodes[id].value == RIFT_REGEX_FLAT_AST_NONE) {
+        return NULL;
+    }
+
+    return flat->strings + flat->nodes[id].value;
+}
+
+/**
+ * @brief Get the flags of a node
+ *
+ * @param flat The flat AST
+ * @param id The node
+ * @return The node flags
+ */
+rift_regex_flags_t
+rift_regex_flat_ast_get_node_flags(const rift_regex_flat_ast_t *flat, rift_regex_flat_node_id_t id)
+{
+    if (!flat || id >= flat->node_count) {
+        return RIFT_REGEX_FLAG_NONE;
+    }
+
+    return (rift_regex_flags_t)flat->nodes[id].flags;
+}
+
+/**
+ * @brief Get the number of children of a node
+ *
+ * @param flat The flat AST
+ * @param id The node
+ * @return The number of children
+ */
+size_t
+rift_regex_flat_ast_get_child_count(const rift_regex_flat_ast_t *flat,
+                                    rift_regex_flat_node_id_t id)
+{
+    if (!flat || id >= flat->node_count) {
+        return 0;
+    }
+
+    return flat->nodes[id].child_count;
+}
+
+/**
+ * @brief Get a child of a node
+ *
+ * @param flat The flat AST
+ * @param id The node
+ * @param index The index of the child
+ * @return The child node, RIFT_REGEX_FLAT_AST_NONE if not found
+ */
+rift_regex_flat_node_id_t
+rift_regex_flat_ast_get_child(const rift_regex_flat_ast_t *flat, rift_regex_flat_node_id_t id,
+                              size_t index)
+{
+    if (!flat || id >= flat->node_count || index >= flat->nodes[id].child_count) {
+        return RIFT_REGEX_FLAT_AST_NONE;
+    }
+
+    return flat->children[flat->nodes[id].first_child + index];
+}
+
+/**
+ * @brief Get the parent of a node
+ *
+ * @param flat The flat AST
+ * @param id The node
+ * @return The parent node, RIFT_REGEX_FLAT_AST_NONE for the root
+ */
+rift_regex_flat_node_id_t
+rift_regex_flat_ast_get_parent(const rift_regex_flat_ast_t *flat, rift_regex_flat_node_id_t id)
+{
+    if (!flat || id >= flat->node_count) {
+        return RIFT_REGEX_FLAT_AST_NONE;
+    }
+
+    return flat->nodes[id].parent;
+}
+
+/**
+ * @brief Check if a node is of a specific type
+ *
+ * @param flat The flat AST
+ * @param id The node
+ * @param type The type to check against
+ * @return true if the node is of the specified type, false otherwise
+ */
+bool
+rift_regex_flat_ast_is_type(const rift_regex_flat_ast_t *flat, rift_regex_flat_node_id_t id,
+                            rift_regex_ast_node_type_t type)
+{
+    if (!flat || id >= flat->node_count) {
+        return false;
+    }
+
+    return flat->nodes[id].type == type;
+}
+
+/**
+ * @brief Count the capture groups of a flat AST
+ *
+ * @param flat The flat AST
+ * @return The number of capturing and named groups
+ */
+size_t
+rift_regex_flat_ast_count_groups(const rift_regex_flat_ast_t *flat)
+{
+    if (!flat) {
+        return 0;
+    }
+
+    size_t count = 0;
+    for (uint32_t i = 0; i < flat->node_count; i++) {
+        if (flat->nodes[i].type == RIFT_REGEX_AST_NODE_GROUP ||
+            flat->nodes[i].type == RIFT_REGEX_AST_NODE_NAMED_GROUP) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief Append formatted text to a string buffer
+ *
+ * @param buffer The buffer
+ * @param format The printf-style format
+ */
+static void
+buffer_append(string_buffer_t *buffer, const char *format, ...)
+{
+    if (buffer->failed) {
+        return;
+    }
+
+    va_list args;
+    va_start(args, format);
+    va_list retry;
+    va_copy(retry, args);
+
+    int written =
+        vsnprintf(buffer->data + buffer->length, buffer->capacity - buffer->length, format, args);
+    va_end(args);
+
+    if (written >= 0 && buffer->length + (size_t)written >= buffer->capacity) {
+        size_t capacity = buffer->capacity * 2;
+        while (buffer->length + (size_t)written >= capacity) {
+            capacity *= 2;
+        }
+
+        char *data = (char *)realloc(buffer->data, capacity);
+        if (!data) {
+            buffer->failed = true;
+            va_end(retry);
+            return;
+        }
+
+        buffer->data = data;
+        buffer->capacity = capacity;
+        vsnprintf(buffer->data + buffer->length, buffer->capacity - buffer->length, format, retry);
+    }
+    va_end(retry);
+
+    if (written < 0) {
+        buffer->failed = true;
+        return;
+    }
+
+    buffer->length += (size_t)written;
+}
+
+/**
+ * @brief Append the lines of a node and, if requested, of its subtree
+ *
+ * @param buffer The buffer
+ * @param flat The flat AST
+ * @param id The node
+ * @param depth Depth of the node below the first one appended
+ * @param include_children Whether to append the subtree
+ */
+static void
+append_node(string_buffer_t *buffer, const rift_regex_flat_ast_t *flat,
+            rift_regex_flat_node_id_t id, size_t depth, bool include_children)
+{
+    const rift_regex_flat_ast_node_t *node = &flat->nodes[id];
+
+    buffer_append(buffer, "%s%*sType: %s", depth ? "\n" : "", (int)(depth * 2), "",
+                  rift_regex_ast_node_type_to_string((rift_regex_ast_node_type_t)node->type));
+
+    if (node->value != RIFT_REGEX_FLAT_AST_NONE) {
+        buffer_append(buffer, ", Value: \"%s\"", flat->strings + node->value);
+    }
+
+    buffer_append(buffer, ", Children: %u", (unsigned)node->child_count);
+
+    if (node->flags) {
+        buffer_append(buffer, ", Flags: 0x%x", (unsigned)node->flags);
+    }
+
+    if (include_children) {
+        for (uint32_t i = 0; i < node->child_count; i++) {
+            append_node(buffer, flat, flat->children[node->first_child + i], depth + 1, true);
+        }
+    }
+}
+
+/**
+ * @brief Convert a node to a string representation (for debugging)
+ *
+ * @param flat The flat AST
+ * @param id The node
+ * @param include_children Whether to include children in the string representation
+ * @return A string representation of the node or NULL on failure
+ *         The caller is responsible for freeing the returned string.
+ */
+char *
+rift_regex_flat_ast_node_to_string(const rift_regex_flat_ast_t *flat,
+                                   rift_regex_flat_node_id_t id, bool include_children)
+{
+    if (!flat || id >= flat->node_count) {
+        return NULL;
+    }
+
+    string_buffer_t buffer = {(char *)malloc(256), 0, 256, false};
+    if (!buffer.data) {
+        return NULL;
+    }
+    buffer.data[0] = '\0';
+
+    append_node(&buffer, flat, id, 0, include_children);
+
+    if (buffer.failed) {
+        free(buffer.data);
+        return NULL;
+    }
+
+    return buffer.data;
+}
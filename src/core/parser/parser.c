@@ -1,1286 +1,1304 @@
-#include "core/parser/parser.h"
 /**
-core/parser/parser.h"
  * @file parser.c
  * @brief Implementation of parser functions for the LibRift regex engine
  *
  * This file implements the parsing of regular expression patterns into
- * Abstract Syntax Trees (ASTs) in the LibRift regex engine.
+ * Abstract Syntax Trees (ASTs) in the LibRift regex engine. Parsing is a
+ * single recursive-descent pass over the pattern bytes: bytes are classified
+ * through the tokenizer's byte table, but no tokens are built, and nodes are
+ * created in the arena of the root they are parsed under. Fixed values
+ * (one-character literals, quantifiers, anchors, class shorthands) are
+ * shared by arena nodes instead of copied.
  *
  * @copyright Copyright (c) 2025 LibRift Project
  * @license MIT License
  *
  */
 
-#include "core/syntax/parser.h
+#include "core/parser/parser.h"
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
-#include "librift/parser/parser.h"
-
+#include "core/memory/memory.h"
+#include "core/tokenizer/token.h"
+#include "core/tokenizer/token_type.h"
+#include "core/tokenizer/tokenizer.h"
+
+/* Values of '*', '+' and '?', each plain, lazy and possessive */
+static const char *const simple_quantifiers[3][3] = {
+    {"*", "*?", "*+"},
+    {"+", "+?", "++"},
+    {"?", "??", "?+"},
+};
 
 /**
- * @brief State information for regex nodes
+ * @brief Set the error of the parser, keeping the first one of a parse
+ *
+ * @param parser The parser
+ * @param code The error code
+ * @param position Position of the error in the pattern text
+ * @param format Format of the error message
  */
-typedef struct rift_state_info {
-    size_t entry_state_id;
-    size_t exit_state_id;
-    void *transition_condition;
-    rift_regex_flags_t constraints;
-    bool is_accepting;
-} rift_state_info_t;
+static void
+set_error(rift_regex_parser_t *parser, rift_regex_error_code_t code, size_t position,
+          const char *format, ...)
+{
+    if (parser->error.code != RIFT_REGEX_ERROR_NONE) {
+        return;
+    }
+
+    parser->error.code = code;
+    parser->error.position = parser->offset + position;
+    parser->error_position = parser->error.position;
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(parser->error.message, sizeof(parser->error.message), format, args);
+    va_end(args);
+}
 
 /**
- * @brief Set an error message in the parser
+ * @brief Clear the error of the parser
  *
  * @param parser The parser
- * @param message The error message
- * @param position The position of the error
  */
+static void
+clear_error(rift_regex_parser_t *parser)
+{
+    parser->error.code = RIFT_REGEX_ERROR_NONE;
+    parser->error.message[0] = '\0';
+    parser->error.position = 0;
+    parser->error_position = (size_t)-1;
+}
+
 /**
- * @brief Create a new parser
+ * @brief Check if the whole pattern text has been read
  *
- * @return A new parser or NULL on failure
+ * @param parser The parser
+ * @return true if at the end, false otherwise
  */
-rift_regex_parser_t *
-rift_regex_parser_create(rift_regex_flags_t flags, bool rift_flag)
+static bool
+at_end(const rift_regex_parser_t *parser)
 {
-    rift_regex_parser_t *parser = (rift_regex_parser_t *)malloc(sizeof(rift_regex_parser_t));
-    if (!parser) {
-        return NULL;
-    }
-
-    // Initialize the parser
-    parser->tokenizer = NULL;
-    parser->validator = NULL;
-    parser->flags = RIFT_REGEX_FLAG_NONE;
-    parser->ast = NULL;
-    parser->current_node = NULL;
-    parser->error_message[0] = '\0';
-    parser->error_position = (size_t)-1;
-    parser->owns_tokenizer = false;
-    parser->owns_validator = false;
-    parser->next_state_id = 1; // Initialize state ID counter
-
-    // Create the validator
-    parser->validator = rift_regex_validator_create();
-    if (!parser->validator) {
-        free(parser);
-        return NULL;
-    }
-    parser->owns_validator = true;
-
-    return parser;
+    return parser->position >= parser->length;
 }
 
 /**
- * @brief Free resources associated with a parser
+ * @brief Get the byte at an offset from the current position
  *
- * @param parser The parser to free
+ * @param parser The parser
+ * @param offset Offset from the current position
+ * @return The byte or '\0' past the end
  */
-void
-rift_regex_parser_free(rift_regex_parser_t *parser)
+static char
+peek_byte(const rift_regex_parser_t *parser, size_t offset)
 {
-    if (!parser) {
-        return;
+    if (parser->position + offset >= parser->length) {
+        return '\0';
     }
 
-    // Free the tokenizer if owned
-    if (parser->tokenizer && parser->owns_tokenizer) {
-        rift_regex_tokenizer_free(parser->tokenizer);
-    }
+    return parser->input[parser->position + offset];
+}
 
-    // Free the validator if owned
-    if (parser->validator && parser->owns_validator) {
-        rift_regex_validator_free(parser->validator);
+/**
+ * @brief Create a node where the tree is being built
+ *
+ * @param parser The parser
+ * @param type The node type
+ * @return The node or NULL on failure
+ */
+static rift_regex_ast_node_t *
+create_node(rift_regex_parser_t *parser, rift_regex_ast_node_type_t type)
+{
+    rift_regex_ast_node_t *node = rift_regex_ast_node_create_in_arena(parser->arena, type);
+    if (!node) {
+        set_error(parser, RIFT_REGEX_ERROR_MEMORY, parser->position,
+                  "Failed to allocate AST node");
     }
+    return node;
+}
 
-    // Free the AST if allocated
-    if (parser->ast) {
-        rift_regex_ast_free(parser->ast);
+/**
+ * @brief Free a node and its subtree; arena nodes are left to the arena
+ *
+ * @param node The node (can be NULL)
+ */
+static void
+free_node(rift_regex_ast_node_t *node)
+{
+    if (node) {
+        rift_regex_ast_node_free_recursive(node);
     }
-
-    // Free the parser itself
-    free(parser);
 }
 
 /**
- * @brief Set the tokenizer for the parser
+ * @brief Add a child to a node
  *
  * @param parser The parser
- * @param tokenizer The tokenizer to use
+ * @param parent The parent node
+ * @param child The child node
  * @return true if successful, false otherwise
  */
-bool
-rift_regex_parser_set_tokenizer(rift_regex_parser_t *parser, rift_regex_tokenizer_t *tokenizer)
+static bool
+add_child(rift_regex_parser_t *parser, rift_regex_ast_node_t *parent,
+          rift_regex_ast_node_t *child)
 {
-    if (!parser) {
+    if (!rift_regex_ast_node_add_child(parent, child)) {
+        set_error(parser, RIFT_REGEX_ERROR_MEMORY, parser->position,
+                  "Failed to add AST node");
         return false;
     }
+    return true;
+}
 
-    // Free the existing tokenizer if owned
-    if (parser->tokenizer && parser->owns_tokenizer) {
-        rift_regex_tokenizer_free(parser->tokenizer);
+/**
+ * @brief Set a node value that outlives the parse
+ *
+ * Arena nodes share the string; heap nodes own their values, so they get a copy.
+ *
+ * @param parser The parser
+ * @param node The node
+ * @param value A static NUL-terminated string
+ * @return true if successful, false otherwise
+ */
+static bool
+set_shared_value(rift_regex_parser_t *parser, rift_regex_ast_node_t *node, const char *value)
+{
+    if (node->arena) {
+        node->value = (char *)value;
+        return true;
     }
 
-    parser->tokenizer = tokenizer;
-    parser->owns_tokenizer = false;
-
+    if (!rift_regex_ast_node_set_value(node, value)) {
+        set_error(parser, RIFT_REGEX_ERROR_MEMORY, parser->position, "Failed to set node value");
+        return false;
+    }
     return true;
 }
 
 /**
- * @brief Set the validator for the parser
+ * @brief Set a node value copied from the pattern text
  *
  * @param parser The parser
- * @param validator The validator to use
+ * @param node The node
+ * @param start Offset of the value in the pattern text
+ * @param length Length of the value
  * @return true if successful, false otherwise
  */
-bool
-rift_regex_parser_set_validator(rift_regex_parser_t *parser, rift_regex_validator_t *validator)
+static bool
+set_text_value(rift_regex_parser_t *parser, rift_regex_ast_node_t *node, size_t start,
+               size_t length)
 {
-    if (!parser) {
-        return false;
+    char *value = NULL;
+    if (node->arena) {
+        value = rift_arena_strndup(node->arena, parser->input + start, length);
+    } else {
+        value = (char *)malloc(length + 1);
+        if (value) {
+            memcpy(value, parser->input + start, length);
+            value[length] = '\0';
+        }
     }
 
-    // Free the existing validator if owned
-    if (parser->validator && parser->owns_validator) {
-        rift_regex_validator_free(parser->validator);
+    if (!value) {
+        set_error(parser, RIFT_REGEX_ERROR_MEMORY, start, "Failed to set node value");
+        return false;
     }
 
-    parser->validator = validator;
-    parser->owns_validator = false;
-
+    node->value = value;
     return true;
 }
 
 /**
- * @brief Get the last error
+ * @brief Create a node with a shared value
  *
  * @param parser The parser
- * @return The last error or an error with code RIFT_REGEX_ERROR_NONE if no error occurred
+ * @param type The node type
+ * @param value A static NUL-terminated string, NULL for none
+ * @return The node or NULL on failure
  */
-rift_regex_error_t
-rift_regex_parser_get_error(const rift_regex_parser_t *parser)
+static rift_regex_ast_node_t *
+create_leaf(rift_regex_parser_t *parser, rift_regex_ast_node_type_t type, const char *value)
 {
-    if (!parser || parser->error_message[0] == '\0') {
-        rift_regex_error_t error = {.code = RIFT_REGEX_ERROR_NONE, .message = {0}};
-        return error;
+    rift_regex_ast_node_t *node = create_node(parser, type);
+    if (node && value && !set_shared_value(parser, node, value)) {
+        free_node(node);
+        return NULL;
     }
+    return node;
+}
 
-    return parser->error;
+/**
+ * @brief Create a node with a value copied from the pattern text
+ *
+ * @param parser The parser
+ * @param type The node type
+ * @param start Offset of the value in the pattern text
+ * @param length Length of the value
+ * @return The node or NULL on failure
+ */
+static rift_regex_ast_node_t *
+create_text_leaf(rift_regex_parser_t *parser, rift_regex_ast_node_type_t type, size_t start,
+                 size_t length)
+{
+    rift_regex_ast_node_t *node = create_node(parser, type);
+    if (node && !set_text_value(parser, node, start, length)) {
+        free_node(node);
+        return NULL;
+    }
+    return node;
 }
 
 /**
- * @brief Get the position of the last error
+ * @brief Measure a quantifier at the current position
+ *
+ * A '{' that does not open a well-formed {m}, {m,} or {m,n} is a literal.
  *
  * @param parser The parser
- * @return The position of the last error or (size_t)-1 if no error occurred
+ * @return Length of the quantifier without its lazy or possessive suffix, 0 if none
  */
-size_t
-rift_regex_parser_get_error_position(const rift_regex_parser_t *parser)
+static size_t
+quantifier_length(const rift_regex_parser_t *parser)
 {
-    if (!parser) {
-        return (size_t)-1;
+    char c = peek_byte(parser, 0);
+    if (c == '*' || c == '+' || c == '?') {
+        return 1;
+    }
+    if (c != '{') {
+        return 0;
     }
 
-    return parser->error_position;
+    size_t i = 1;
+    size_t digits = 0;
+    while (isdigit((unsigned char)peek_byte(parser, i))) {
+        i++;
+        digits++;
+    }
+    if (digits == 0) {
+        return 0;
+    }
+    if (peek_byte(parser, i) == ',') {
+        i++;
+        while (isdigit((unsigned char)peek_byte(parser, i))) {
+            i++;
+        }
+    }
+    return peek_byte(parser, i) == '}' ? i + 1 : 0;
 }
 
+static rift_regex_ast_node_t *parse_alternation(rift_regex_parser_t *parser);
+
 /**
- * @brief Reset the parser state to prepare for a new parse
+ * @brief Parse a group, from its '(' to its ')'
+ *
+ * Comments yield no node.
  *
  * @param parser The parser
+ * @param out Where to store the node
+ * @return true if successful, false otherwise
  */
-static void
-reset_parser(rift_regex_parser_t *parser)
+static bool
+parse_group(rift_regex_parser_t *parser, rift_regex_ast_node_t **out)
 {
-    if (!parser) {
-        return;
+    size_t start = parser->position++;
+    rift_regex_ast_node_type_t type = RIFT_REGEX_AST_NODE_GROUP;
+    size_t value_start = 0;
+    size_t value_length = 0;
+
+    if (peek_byte(parser, 0) == '?') {
+        parser->position++;
+        char c = peek_byte(parser, 0);
+        parser->position++;
+
+        switch (c) {
+        case ':':
+            type = RIFT_REGEX_AST_NODE_NON_CAPTURING_GROUP;
+            break;
+        case '=':
+            type = RIFT_REGEX_AST_NODE_LOOKAHEAD;
+            break;
+        case '!':
+            type = RIFT_REGEX_AST_NODE_NEGATIVE_LOOKAHEAD;
+            break;
+        case '>':
+            type = RIFT_REGEX_AST_NODE_ATOMIC_GROUP;
+            break;
+        case '#': {
+            const char *close = memchr(parser->input + parser->position, ')',
+                                       parser->length - parser->position);
+            if (!close) {
+                set_error(parser, RIFT_REGEX_ERROR_UNBALANCED_PARENTHESES, start,
+                          "Unclosed comment at position %zu", parser->offset + start);
+                return false;
+            }
+            parser->position = (size_t)(close - parser->input) + 1;
+            *out = NULL;
+            return true;
+        }
+        case '<':
+            if (peek_byte(parser, 0) == '=' || peek_byte(parser, 0) == '!') {
+                type = peek_byte(parser, 0) == '=' ? RIFT_REGEX_AST_NODE_LOOKBEHIND
+                                              : RIFT_REGEX_AST_NODE_NEGATIVE_LOOKBEHIND;
+                parser->position++;
+                break;
+            }
+            type = RIFT_REGEX_AST_NODE_NAMED_GROUP;
+            break;
+        case 'P':
+            if (peek_byte(parser, 0) == '<') {
+                parser->position++;
+                type = RIFT_REGEX_AST_NODE_NAMED_GROUP;
+                break;
+            }
+            set_error(parser, RIFT_REGEX_ERROR_SYNTAX, start,
+                      "Invalid group specifier at position %zu", parser->offset + start);
+            return false;
+        default:
+            if (c == '\0' || !strchr("imsxUJ-", c)) {
+                set_error(parser, RIFT_REGEX_ERROR_SYNTAX, start,
+                          "Invalid group specifier at position %zu", parser->offset + start);
+                return false;
+            }
+
+            // Inline options, alone or scoping a group of their own
+            type = RIFT_REGEX_AST_NODE_OPTION;
+            value_start = parser->position - 1;
+            while (peek_byte(parser, 0) != '\0' && strchr("imsxUJ-", peek_byte(parser, 0))) {
+                parser->position++;
+            }
+            value_length = parser->position - value_start;
+            if (peek_byte(parser, 0) == ')') {
+                parser->position++;
+                *out = create_text_leaf(parser, type, value_start, value_length);
+                return *out != NULL;
+            }
+            if (peek_byte(parser, 0) != ':') {
+                set_error(parser, RIFT_REGEX_ERROR_SYNTAX, parser->position,
+                          "Invalid option character at position %zu",
+                          parser->offset + parser->position);
+                return false;
+            }
+            parser->position++;
+            break;
+        }
+
+        if (type == RIFT_REGEX_AST_NODE_NAMED_GROUP) {
+            value_start = parser->position;
+            while (isalnum((unsigned char)peek_byte(parser, 0)) || peek_byte(parser, 0) == '_') {
+                parser->position++;
+            }
+            value_length = parser->position - value_start;
+            if (value_length == 0 || peek_byte(parser, 0) != '>') {
+                set_error(parser, RIFT_REGEX_ERROR_SYNTAX, start,
+                          "Invalid group name at position %zu", parser->offset + start);
+                return false;
+            }
+            parser->position++;
+        }
+    }
+
+    if (parser->depth >= RIFT_REGEX_PARSER_MAX_DEPTH) {
+        set_error(parser, RIFT_REGEX_ERROR_LIMIT_EXCEEDED, start,
+                  "Groups nested deeper than %d", RIFT_REGEX_PARSER_MAX_DEPTH);
+        return false;
     }
 
-    // Free the existing AST if any
-    if (parser->ast) {
-        rift_regex_ast_free(parser->ast);
-        parser->ast = NULL;
+    parser->depth++;
+    rift_regex_ast_node_t *body = parse_alternation(parser);
+    parser->depth--;
+    if (!body) {
+        return false;
     }
 
-    // Create a new AST
-    parser->ast = rift_regex_ast_create();
+    if (peek_byte(parser, 0) != ')') {
+        free_node(body);
+        set_error(parser, RIFT_REGEX_ERROR_UNBALANCED_PARENTHESES, start,
+                  "Missing ')' for group opened at position %zu", parser->offset + start);
+        return false;
+    }
+    parser->position++;
 
-    // Reset the current node
-    parser->current_node = NULL;
+    rift_regex_ast_node_t *group = value_length > 0
+                                       ? create_text_leaf(parser, type, value_start, value_length)
+                                       : create_node(parser, type);
+    if (!group || !add_child(parser, group, body)) {
+        free_node(group);
+        free_node(body);
+        return false;
+    }
 
-    // Reset error state
-    parser->error_message[0] = '\0';
-    parser->error_position = (size_t)-1;
+    *out = group;
+    return true;
 }
 
 /**
- * @brief Parse a regular expression pattern with options
+ * @brief Parse a bracket expression, from its '[' to its ']'
+ *
+ * The node value is the whole expression, brackets included.
  *
  * @param parser The parser
- * @param pattern The pattern to parse
- * @param flags Flags that affect parsing
- * @return An AST representing the pattern or NULL on failure
+ * @return The node or NULL on failure
  */
-rift_regex_ast_t *
-rift_regex_parser_parse_with_options(rift_regex_parser_t *parser, const char *pattern,
-                                     rift_regex_flags_t flags)
+static rift_regex_ast_node_t *
+parse_character_class(rift_regex_parser_t *parser)
 {
-    if (!parser || !pattern) {
-        return NULL;
+    size_t start = parser->position++;
+
+    // A ']' right after the opening bracket (or its negation) is a member
+    if (peek_byte(parser, 0) == '^') {
+        parser->position++;
+    }
+    if (peek_byte(parser, 0) == ']') {
+        parser->position++;
     }
 
-    // Reset the parser state
-    reset_parser(parser);
+    while (!at_end(parser) && peek_byte(parser, 0) != ']') {
+        char c = peek_byte(parser, 0);
+        if (c == '\\' && parser->position + 1 < parser->length) {
+            parser->position += 2;
+            continue;
+        }
 
-    // Store the flags
-    parser->flags = flags;
+        // [:name:], [.coll.] and [=equiv=] may contain ']' before they close
+        char delimiter = peek_byte(parser, 1);
+        if (c == '[' && (delimiter == ':' || delimiter == '.' || delimiter == '=')) {
+            size_t close = parser->position + 2;
+            while (close + 1 < parser->length &&
+                   !(parser->input[close] == delimiter && parser->input[close + 1] == ']')) {
+                close++;
+            }
+            if (close + 1 < parser->length) {
+                parser->position = close + 2;
+                continue;
+            }
+        }
 
-    // Create a tokenizer for the pattern
-    if (parser->tokenizer && parser->owns_tokenizer) {
-        rift_regex_tokenizer_free(parser->tokenizer);
+        parser->position++;
     }
 
-    parser->tokenizer = rift_regex_tokenizer_create(pattern);
-    if (!parser->tokenizer) {
-        set_error(parser, "Failed to create tokenizer", 0);
+    if (at_end(parser)) {
+        set_error(parser, RIFT_REGEX_ERROR_UNBALANCED_BRACKETS, start,
+                  "Missing ']' for character class opened at position %zu",
+                  parser->offset + start);
         return NULL;
     }
-    parser->owns_tokenizer = true;
+    parser->position++;
 
-    // Create a root node for the AST
-    rift_regex_ast_node_t *root = rift_regex_ast_create_node(RIFT_REGEX_AST_NODE_ROOT);
-    if (!root) {
-        set_error(parser, "Failed to create root node", 0);
-        return NULL;
-    }
+    return create_text_leaf(parser, RIFT_REGEX_AST_NODE_CHARACTER_CLASS, start,
+                            parser->position - start);
+}
 
-    if (!rift_regex_ast_set_root(parser->ast, root)) {
-        rift_regex_ast_free_node(root);
-        set_error(parser, "Failed to set root node", 0);
-        return NULL;
+/**
+ * @brief Get the value of a hexadecimal digit
+ *
+ * @param c The digit
+ * @return The value or -1 if c is not a hexadecimal digit
+ */
+static int
+hex_value(char c)
+{
+    if (c >= '0' && c <= '9') {
+        return c - '0';
     }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
 
-    // Set the current node to the root
-    parser->current_node = root;
-
-    // Parse the pattern
-    if (!rift_regex_parser_handle_alternation(parser)) {
-        // Error message is already set
+/**
+ * @brief Parse an escape sequence, from its backslash on
+ *
+ * @param parser The parser
+ * @return The node or NULL on failure
+ */
+static rift_regex_ast_node_t *
+parse_escape(rift_regex_parser_t *parser)
+{
+    size_t start = parser->position++;
+    if (at_end(parser)) {
+        set_error(parser, RIFT_REGEX_ERROR_TRAILING_BACKSLASH, start,
+                  "Trailing backslash at end of pattern");
         return NULL;
     }
 
-    // Validate the AST
-    if (parser->validator) {
-        if (!rift_regex_validator_validate_with_options(parser->validator, parser->ast, flags)) {
-            const char *validator_error = rift_regex_validator_get_last_error(parser->validator);
-            if (validator_error) {
-                set_error(parser, validator_error, 0);
-            } else {
-                set_error(parser, "AST validation failed", 0);
+    char c = parser->input[parser->position++];
+    switch (c) {
+    case 'd':
+        return create_leaf(parser, RIFT_REGEX_AST_NODE_CHARACTER_CLASS, "[0-9]");
+    case 'D':
+        return create_leaf(parser, RIFT_REGEX_AST_NODE_CHARACTER_CLASS, "[^0-9]");
+    case 'w':
+        return create_leaf(parser, RIFT_REGEX_AST_NODE_CHARACTER_CLASS, "[A-Za-z0-9_]");
+    case 'W':
+        return create_leaf(parser, RIFT_REGEX_AST_NODE_CHARACTER_CLASS, "[^A-Za-z0-9_]");
+    case 's':
+        return create_leaf(parser, RIFT_REGEX_AST_NODE_CHARACTER_CLASS, "[ \t\n\r\f\v]");
+    case 'S':
+        return create_leaf(parser, RIFT_REGEX_AST_NODE_CHARACTER_CLASS, "[^ \t\n\r\f\v]");
+    case 'b':
+        return create_leaf(parser, RIFT_REGEX_AST_NODE_ANCHOR, "\\b");
+    case 'B':
+        return create_leaf(parser, RIFT_REGEX_AST_NODE_ANCHOR, "\\B");
+    case 'A':
+        return create_leaf(parser, RIFT_REGEX_AST_NODE_ANCHOR, "^");
+    case 'z':
+    case 'Z':
+        return create_leaf(parser, RIFT_REGEX_AST_NODE_ANCHOR, "$");
+    case 'K':
+        return create_leaf(parser, RIFT_REGEX_AST_NODE_BACKREF_RESET, NULL);
+    case 'n':
+        return create_leaf(parser, RIFT_REGEX_AST_NODE_LITERAL, rift_regex_token_intern_char('\n'));
+    case 't':
+        return create_leaf(parser, RIFT_REGEX_AST_NODE_LITERAL, rift_regex_token_intern_char('\t'));
+    case 'r':
+        return create_leaf(parser, RIFT_REGEX_AST_NODE_LITERAL, rift_regex_token_intern_char('\r'));
+    case 'f':
+        return create_leaf(parser, RIFT_REGEX_AST_NODE_LITERAL, rift_regex_token_intern_char('\f'));
+    case 'v':
+        return create_leaf(parser, RIFT_REGEX_AST_NODE_LITERAL, rift_regex_token_intern_char('\v'));
+    case 'e':
+        return create_leaf(parser, RIFT_REGEX_AST_NODE_LITERAL, rift_regex_token_intern_char(27));
+    case 'x': {
+        int high = hex_value(peek_byte(parser, 0));
+        int low = hex_value(peek_byte(parser, 1));
+        if (high < 0 || low < 0 || (high == 0 && low == 0)) {
+            set_error(parser, RIFT_REGEX_ERROR_INVALID_ESCAPE, start,
+                      "Invalid hexadecimal escape at position %zu", parser->offset + start);
+            return NULL;
+        }
+        parser->position += 2;
+        return create_leaf(parser, RIFT_REGEX_AST_NODE_LITERAL,
+                           rift_regex_token_intern_char((char)(high * 16 + low)));
+    }
+    case 'k': {
+        char open = peek_byte(parser, 0);
+        char close = open == '<' ? '>' : open == '{' ? '}' : open == '\'' ? '\'' : '\0';
+        size_t name_start = parser->position + 1;
+        size_t name_end = name_start;
+        while (name_end < parser->length &&
+               (isalnum((unsigned char)parser->input[name_end]) ||
+                parser->input[name_end] == '_')) {
+            name_end++;
+        }
+        if (close == '\0' || name_end == name_start || name_end >= parser->length ||
+            parser->input[name_end] != close) {
+            set_error(parser, RIFT_REGEX_ERROR_INVALID_BACKREFERENCE, start,
+                      "Invalid named backreference at position %zu", parser->offset + start);
+            return NULL;
+        }
+        parser->position = name_end + 1;
+        return create_text_leaf(parser, RIFT_REGEX_AST_NODE_NAMED_BACKREFERENCE, name_start,
+                                name_end - name_start);
+    }
+    case 'p':
+    case 'P': {
+        // The property keeps its escape text; \pL and \p{Name} both work
+        if (peek_byte(parser, 0) == '{') {
+            const char *close = memchr(parser->input + parser->position, '}',
+                                       parser->length - parser->position);
+            if (!close) {
+                set_error(parser, RIFT_REGEX_ERROR_INVALID_ESCAPE, start,
+                          "Unclosed Unicode property at position %zu", parser->offset + start);
+                return NULL;
             }
+            parser->position = (size_t)(close - parser->input) + 1;
+        } else if (isalpha((unsigned char)peek_byte(parser, 0))) {
+            parser->position++;
+        } else {
+            set_error(parser, RIFT_REGEX_ERROR_INVALID_ESCAPE, start,
+                      "Invalid Unicode property at position %zu", parser->offset + start);
             return NULL;
         }
+        return create_text_leaf(parser, RIFT_REGEX_AST_NODE_UNICODE_PROPERTY, start,
+                                parser->position - start);
+    }
+    default:
+        break;
+    }
+
+    if (c >= '1' && c <= '9') {
+        size_t digits_start = parser->position - 1;
+        while (isdigit((unsigned char)peek_byte(parser, 0))) {
+            parser->position++;
+        }
+        return create_text_leaf(parser, RIFT_REGEX_AST_NODE_BACKREFERENCE, digits_start,
+                                parser->position - digits_start);
     }
 
-    // Return the AST
-    rift_regex_ast_t *result = parser->ast;
-    parser->ast = NULL; // Don't free the AST when the parser is freed
+    if (isalnum((unsigned char)c)) {
+        set_error(parser, RIFT_REGEX_ERROR_INVALID_ESCAPE, start,
+                  "Unknown escape sequence '\\%c' at position %zu", c, parser->offset + start);
+        return NULL;
+    }
 
-    return result;
+    // Any other escaped byte stands for itself
+    return create_leaf(parser, RIFT_REGEX_AST_NODE_LITERAL, rift_regex_token_intern_char(c));
 }
 
 /**
- * @brief Parse a regular expression pattern
+ * @brief Parse an atom: a literal run, a class, a group, an escape or an anchor
  *
  * @param parser The parser
- * @param pattern The pattern to parse
- * @return An AST representing the pattern or NULL on failure
+ * @param out Where to store the node, NULL for a comment
+ * @return true if successful, false otherwise
  */
-rift_regex_ast_t *
-rift_regex_parser_parse(rift_regex_parser_t *parser, const char *pattern)
+static bool
+parse_atom(rift_regex_parser_t *parser, rift_regex_ast_node_t **out)
 {
-    return rift_regex_parser_parse_with_options(parser, pattern, RIFT_REGEX_FLAG_NONE);
+    size_t start = parser->position;
+    char c = parser->input[start];
+
+    switch (rift_regex_token_byte_type(c)) {
+    case RIFT_REGEX_TOKEN_LPAREN:
+        return parse_group(parser, out);
+    case RIFT_REGEX_TOKEN_LBRACKET:
+        *out = parse_character_class(parser);
+        return *out != NULL;
+    case RIFT_REGEX_TOKEN_BACKSLASH:
+        *out = parse_escape(parser);
+        return *out != NULL;
+    case RIFT_REGEX_TOKEN_DOT:
+        parser->position++;
+        *out = create_leaf(parser, RIFT_REGEX_AST_NODE_DOT, ".");
+        return *out != NULL;
+    case RIFT_REGEX_TOKEN_CARET:
+        parser->position++;
+        *out = create_leaf(parser, RIFT_REGEX_AST_NODE_ANCHOR, "^");
+        return *out != NULL;
+    case RIFT_REGEX_TOKEN_DOLLAR:
+        parser->position++;
+        *out = create_leaf(parser, RIFT_REGEX_AST_NODE_ANCHOR, "$");
+        return *out != NULL;
+    case RIFT_REGEX_TOKEN_STAR:
+    case RIFT_REGEX_TOKEN_PLUS:
+    case RIFT_REGEX_TOKEN_QUESTION:
+    case RIFT_REGEX_TOKEN_LBRACE:
+        if (quantifier_length(parser) > 0) {
+            set_error(parser, RIFT_REGEX_ERROR_INVALID_QUANTIFIER, start,
+                      "Quantifier '%c' at position %zu does not follow a repeatable item", c,
+                      parser->offset + start);
+            return false;
+        }
+        break;
+    default:
+        break;
+    }
+
+    // Plain bytes up to the next special one make one literal
+    size_t run = rift_regex_token_literal_run(parser->input + start, parser->length - start);
+    if (parser->flags & RIFT_REGEX_FLAG_UTF8) {
+        // A quantifier takes the whole last character, not just its last byte
+        while (run > 0 && start + run < parser->length &&
+               ((unsigned char)parser->input[start + run] & 0xC0) == 0x80) {
+            run--;
+        }
+        if (run == 0) {
+            while (start + run + 1 < parser->length &&
+                   ((unsigned char)parser->input[start + run + 1] & 0xC0) == 0x80) {
+                run++;
+            }
+            run = run > 0 ? run + 1 : 0;
+        }
+    }
+    if (run > 1) {
+        parser->position += run;
+        *out = create_text_leaf(parser, RIFT_REGEX_AST_NODE_LITERAL, start, run);
+        return *out != NULL;
+    }
+
+    parser->position++;
+    *out = create_leaf(parser, RIFT_REGEX_AST_NODE_LITERAL, rift_regex_token_intern_char(c));
+    return *out != NULL;
 }
 
 /**
- * @brief Parse a character class
+ * @brief Parse an atom and the quantifier that follows it, if any
  *
  * @param parser The parser
+ * @param out Where to store the node, NULL for a comment
  * @return true if successful, false otherwise
  */
-bool
-rift_regex_parser_handle_character_class(rift_regex_parser_t *parser)
+static bool
+parse_quantified(rift_regex_parser_t *parser, rift_regex_ast_node_t **out)
 {
-    if (!parser || !parser->tokenizer) {
+    rift_regex_ast_node_t *atom = NULL;
+    if (!parse_atom(parser, &atom)) {
         return false;
     }
 
-    // Get the character class content
-    rift_regex_token_t token = rift_regex_tokenizer_next_token(parser->tokenizer);
-    if (token.type != RIFT_REGEX_TOKEN_CHAR_CLASS) {
-        set_error(parser, "Expected character class", token.position);
-        return false;
+    size_t start = parser->position;
+    size_t length = atom ? quantifier_length(parser) : 0;
+    if (length == 0) {
+        *out = atom;
+        return true;
     }
 
-    // Create a character class node
-    rift_regex_ast_node_t *node = rift_regex_ast_create_node(RIFT_REGEX_AST_NODE_CHARACTER_CLASS);
-    if (!node) {
-        set_error(parser, "Failed to create character class node", token.position);
-        return false;
+    parser->position += length;
+    size_t mode = 0;
+    if (peek_byte(parser, 0) == '?' || peek_byte(parser, 0) == '+') {
+        mode = peek_byte(parser, 0) == '?' ? 1 : 2;
+        parser->position++;
+    }
+
+    rift_regex_ast_node_t *quantifier = NULL;
+    if (length == 1) {
+        size_t kind = parser->input[start] == '*' ? 0 : parser->input[start] == '+' ? 1 : 2;
+        quantifier =
+            create_leaf(parser, RIFT_REGEX_AST_NODE_QUANTIFIER, simple_quantifiers[kind][mode]);
+    } else {
+        // {m,n} with m above n can never match
+        const char *comma = memchr(parser->input + start, ',', length);
+        if (comma && comma[1] != '}' &&
+            strtoul(comma + 1, NULL, 10) < strtoul(parser->input + start + 1, NULL, 10)) {
+            free_node(atom);
+            set_error(parser, RIFT_REGEX_ERROR_INVALID_QUANTIFIER, start,
+                      "Quantifier bounds out of order at position %zu", parser->offset + start);
+            return false;
+        }
+        quantifier = create_text_leaf(parser, RIFT_REGEX_AST_NODE_QUANTIFIER, start,
+                                      parser->position - start);
     }
 
-    // Set the character class value
-    if (!rift_regex_ast_set_value(node, token.value)) {
-        rift_regex_ast_free_node(node);
-        set_error(parser, "Failed to set character class value", token.position);
+    if (!quantifier || !add_child(parser, quantifier, atom)) {
+        free_node(quantifier);
+        free_node(atom);
         return false;
     }
 
-    // Add the node to the current node
-    if (!rift_regex_ast_add_child(parser->current_node, node)) {
-        rift_regex_ast_free_node(node);
-        set_error(parser, "Failed to add character class node", token.position);
+    if (quantifier_length(parser) > 0) {
+        free_node(quantifier);
+        set_error(parser, RIFT_REGEX_ERROR_INVALID_QUANTIFIER, parser->position,
+                  "Quantifier at position %zu does not follow a repeatable item",
+                  parser->offset + parser->position);
         return false;
     }
 
+    *out = quantifier;
     return true;
 }
 
-bool
-rift_regex_parser_handle_group(rift_regex_parser_t *parser)
-{
-    if (!parser || !parser->tokenizer) {
-        return false;
-    }
-
-    // Get the opening parenthesis
-    rift_regex_token_t token = rift_regex_tokenizer_next_token(parser->tokenizer);
-    if (token.type != RIFT_REGEX_TOKEN_LPAREN) {
-        set_error(parser, "Expected opening parenthesis", token.position);
-        return false;
-    }
-
-    // Determine the group type
-    rift_regex_ast_node_type_t group_type = RIFT_REGEX_AST_NODE_GROUP;
-    char *group_name = NULL;
-    /**
-     * @brief Set state information for an AST node
-     *
-     * @param node The AST node
-     * @param info The state information
-     * @param aux_data Additional data (can be NULL)
-     * @return true if successful, false otherwise
-     */
-    static bool rift_regex_ast_node_set_state_info(rift_regex_ast_node_t * node,
-                                                   rift_state_info_t * info, void *aux_data)
-    {
-        if (!node || !info) {
-            return false;
-        }
-
-        // This would be implemented to store the state info in the node
-        // For now, we'll just return true as a stub implementation
-        return true;
-    }
+/**
+ * @brief Parse a sequence of quantified atoms up to a '|', a ')' or the end
+ *
+ * An empty sequence is an empty concatenation, which matches the empty string.
+ *
+ * @param parser The parser
+ * @return The node or NULL on failure
+ */
+static rift_regex_ast_node_t *
+parse_concatenation(rift_regex_parser_t *parser)
+{
+    rift_regex_ast_node_t *first = NULL;
+    rift_regex_ast_node_t *concatenation = NULL;
 
-    bool rift_regex_parser_handle_group(rift_regex_parser_t * parser)
-        // Check for group specifier
-        token = rift_regex_tokenizer_peek_token(parser->tokenizer);
-    if (token.type == RIFT_REGEX_TOKEN_NON_CAPTURING) {
-        rift_regex_tokenizer_next_token(parser->tokenizer); // Consume the token
-        group_type = RIFT_REGEX_AST_NODE_NON_CAPTURING_GROUP;
-    } else if (token.type == RIFT_REGEX_TOKEN_NAMED_GROUP) {
-        rift_regex_tokenizer_next_token(parser->tokenizer); // Consume the token
-        group_type = RIFT_REGEX_AST_NODE_NAMED_GROUP;
-        group_name = strdup(token.value);
-    } else if (token.type == RIFT_REGEX_TOKEN_LOOKAHEAD) {
-        rift_regex_tokenizer_next_token(parser->tokenizer); // Consume the token
-        group_type = RIFT_REGEX_AST_NODE_LOOKAHEAD;
-    } else if (token.type == RIFT_REGEX_TOKEN_NEGATIVE_LOOKAHEAD) {
-        rift_regex_tokenizer_next_token(parser->tokenizer); // Consume the token
-        group_type = RIFT_REGEX_AST_NODE_NEGATIVE_LOOKAHEAD;
-    } else if (token.type == RIFT_REGEX_TOKEN_LOOKBEHIND) {
-        rift_regex_tokenizer_next_token(parser->tokenizer); // Consume the token
-        group_type = RIFT_REGEX_AST_NODE_LOOKBEHIND;
-    } else if (token.type == RIFT_REGEX_TOKEN_NEGATIVE_LOOKBEHIND) {
-        rift_regex_tokenizer_next_token(parser->tokenizer); // Consume the token
-        group_type = RIFT_REGEX_AST_NODE_NEGATIVE_LOOKBEHIND;
-    } else if (token.type == RIFT_REGEX_TOKEN_ATOMIC_GROUP) {
-        rift_regex_tokenizer_next_token(parser->tokenizer); // Consume the token
-        group_type = RIFT_REGEX_AST_NODE_ATOMIC_GROUP;
-    } else if (token.type == RIFT_REGEX_TOKEN_COMMENT) {
-        rift_regex_tokenizer_next_token(parser->tokenizer); // Consume the token
-        group_type = RIFT_REGEX_AST_NODE_COMMENT;
-
-        // Create a comment node
-        rift_regex_ast_node_t *node = rift_regex_ast_create_node(group_type);
-        if (!node) {
-            set_error(parser, "Failed to create comment node", token.position);
-            return false;
+    while (!at_end(parser) && peek_byte(parser, 0) != '|' && peek_byte(parser, 0) != ')') {
+        rift_regex_ast_node_t *item = NULL;
+        if (!parse_quantified(parser, &item)) {
+            free_node(concatenation ? concatenation : first);
+            return NULL;
         }
-
-        // Set the comment value
-        if (!rift_regex_ast_set_value(node, token.value)) {
-            rift_regex_ast_free_node(node);
-            set_error(parser, "Failed to set comment value", token.position);
-            return false;
+        if (!item) {
+            continue;
         }
-
-        // Add the node to the current node
-        // Add the group to the current node
-        if (!rift_regex_ast_add_child(parser->current_node, group)) {
-            rift_regex_ast_free_node(group);
-            set_error(parser, "Failed to add group node", token.position);
-            return false;
+        if (!first) {
+            first = item;
+            continue;
         }
 
-        // Set state information for the group node
-        rift_state_info_t temp_info = {.entry_state_id = parser->next_state_id++,
-                                       .exit_state_id = parser->next_state_id++,
-                                       .transition_condition = NULL,
-                                       .constraints = parser->flags,
-                                       .is_accepting = false};
-
-        if (!rift_regex_ast_node_set_state_info(group, &temp_info, NULL)) {
-            set_error(parser, "Failed to set state info for group", token.position);
-            return false;
-        }
-        // Get the closing parenthesis (should be already consumed for comments)
-        token = rift_regex_tokenizer_next_token(parser->tokenizer);
-        if (token.type != RIFT_REGEX_TOKEN_RPAREN) {
-            set_error(parser, "Expected closing parenthesis", token.position);
-            return false;
+        // The node is only made once a second item shows up
+        if (!concatenation) {
+            concatenation = create_node(parser, RIFT_REGEX_AST_NODE_CONCATENATION);
+            if (!concatenation || !add_child(parser, concatenation, first)) {
+                free_node(concatenation);
+                free_node(first);
+                free_node(item);
+                return NULL;
+            }
         }
-
-        return true;
-    }
-
-    // Create a group node
-    rift_regex_ast_node_t *group = rift_regex_ast_create_node(group_type);
-    if (!group) {
-        free(group_name);
-        set_error(parser, "Failed to create group node", token.position);
-        return false;
-    }
-
-    // Set the group name for named groups
-    if (group_type == RIFT_REGEX_AST_NODE_NAMED_GROUP) {
-        if (!rift_regex_ast_set_value(group, group_name)) {
-            free(group_name);
-            rift_regex_ast_free_node(group);
-            set_error(parser, "Failed to set group name", token.position);
-            return false;
+        if (!add_child(parser, concatenation, item)) {
+            free_node(concatenation);
+            free_node(item);
+            return NULL;
         }
     }
-    free(group_name);
 
-    // Add the group to the current node
-    if (!rift_regex_ast_add_child(parser->current_node, group)) {
-        rift_regex_ast_free_node(group);
-        set_error(parser, "Failed to add group node", token.position);
-        return false;
+    if (concatenation) {
+        return concatenation;
     }
-
-    // Save the parent node
-    rift_regex_ast_node_t *parent = parser->current_node;
-
-    // Set the current node to the group
-    parser->current_node = group;
-
-    // Parse the contents of the group
-    if (!rift_regex_parser_handle_alternation(parser)) {
-        // Error message is already set
-        return false;
+    if (first) {
+        return first;
     }
-
-    // Restore the current node
-    parser->current_node = parent;
-
-    // Get the closing parenthesis
-    token = rift_regex_tokenizer_next_token(parser->tokenizer);
-    if (token.type != RIFT_REGEX_TOKEN_RPAREN) {
-        set_error(parser, "Expected closing parenthesis", token.position);
-        return false;
-    }
-
-    return true;
+    return create_node(parser, RIFT_REGEX_AST_NODE_CONCATENATION);
 }
 
 /**
- * @brief Parse a quantifier
+ * @brief Parse branches separated by '|' up to a ')' or the end
  *
  * @param parser The parser
- * @return true if successful, false otherwise
+ * @return The node or NULL on failure
  */
-bool
-rift_regex_parser_handle_quantifier(rift_regex_parser_t *parser)
+static rift_regex_ast_node_t *
+parse_alternation(rift_regex_parser_t *parser)
 {
-    if (!parser || !parser->tokenizer || !parser->current_node) {
-        return false;
+    rift_regex_ast_node_t *branch = parse_concatenation(parser);
+    if (!branch || peek_byte(parser, 0) != '|') {
+        return branch;
     }
 
-    // Check if there is a child to quantify
-    size_t child_count = rift_regex_ast_get_child_count(parser->current_node);
-    if (child_count == 0) {
-        set_error(parser, "Nothing to quantify",
-                  rift_regex_tokenizer_get_position(parser->tokenizer));
-        return false;
+    rift_regex_ast_node_t *alternation = create_node(parser, RIFT_REGEX_AST_NODE_ALTERNATION);
+    if (!alternation || !add_child(parser, alternation, branch)) {
+        free_node(alternation);
+        free_node(branch);
+        return NULL;
     }
 
-    // Get the last child
-    rift_regex_ast_node_t *last_child =
-        rift_regex_ast_get_child(parser->current_node, child_count - 1);
-    if (!last_child) {
-        set_error(parser, "Failed to get last child",
-                  rift_regex_tokenizer_get_position(parser->tokenizer));
-        return false;
+    while (peek_byte(parser, 0) == '|') {
+        parser->position++;
+        branch = parse_concatenation(parser);
+        if (!branch || !add_child(parser, alternation, branch)) {
+            free_node(branch);
+            free_node(alternation);
+            return NULL;
+        }
     }
 
-    // Get the quantifier token
-    rift_regex_token_t token = rift_regex_tokenizer_next_token(parser->tokenizer);
-    if (token.type != RIFT_REGEX_TOKEN_STAR && token.type != RIFT_REGEX_TOKEN_PLUS &&
-        token.type != RIFT_REGEX_TOKEN_QUESTION && token.type != RIFT_REGEX_TOKEN_LBRACE) {
-        set_error(parser, "Expected quantifier", token.position);
-        return false;
-    }
+    return alternation;
+}
 
-    // Create a quantifier node
-    rift_regex_ast_node_t *quantifier = rift_regex_ast_create_node(RIFT_REGEX_AST_NODE_QUANTIFIER);
-    if (!quantifier) {
-        set_error(parser, "Failed to create quantifier node", token.position);
-        return false;
+/**
+ * @brief Initialize a parser in place, without a validator
+ *
+ * @param parser The parser to initialize
+ * @param flags Parsing flags to initialize with
+ * @param rift_flag Whether to enable LibRift syntax mode
+ */
+void
+rift_regex_parser_init(rift_regex_parser_t *parser, rift_regex_flags_t flags, bool rift_flag)
+{
+    if (!parser) {
+        return;
     }
 
-    // Set the quantifier type based on the token
-    char *quantifier_value = NULL;
-    if (token.type == RIFT_REGEX_TOKEN_STAR) {
-        quantifier_value = strdup("*");
-    } else if (token.type == RIFT_REGEX_TOKEN_PLUS) {
-        quantifier_value = strdup("+");
-    } else if (token.type == RIFT_REGEX_TOKEN_QUESTION) {
-        quantifier_value = strdup("?");
-    } else if (token.type == RIFT_REGEX_TOKEN_LBRACE) {
-        // Parse {m,n} quantifier
-        size_t start_pos = token.position;
-        char buffer[32];
-        size_t buffer_index = 0;
-
-        // Add the opening brace
-        buffer[buffer_index++] = '{';
-
-        // Read the minimum value
-        token = rift_regex_tokenizer_next_token(parser->tokenizer);
-        if (token.type != RIFT_REGEX_TOKEN_LITERAL && token.type != RIFT_REGEX_TOKEN_COMMA) {
-            rift_regex_ast_free_node(quantifier);
-            set_error(parser, "Expected number or comma in quantifier", token.position);
-            return false;
-        }
-
-        if (token.type == RIFT_REGEX_TOKEN_LITERAL) {
-            // Add the minimum value
-            buffer[buffer_index++] = token.value[0];
-
-            // Read more digits
-            while (buffer_index < sizeof(buffer) - 3) { // Leave room for ,n}
-                token = rift_regex_tokenizer_peek_token(parser->tokenizer);
-                if (token.type != RIFT_REGEX_TOKEN_LITERAL || !isdigit(token.value[0])) {
-                    break;
-                }
-
-                rift_regex_tokenizer_next_token(parser->tokenizer); // Consume the token
-                buffer[buffer_index++] = token.value[0];
-            }
-
-            // Read the comma or closing brace
-            token = rift_regex_tokenizer_next_token(parser->tokenizer);
-        }
-
-        // Handle the comma and maximum value
-        if (token.type == RIFT_REGEX_TOKEN_COMMA) {
-            // Add the comma
-            buffer[buffer_index++] = ',';
-
-            // Read the maximum value (optional)
-            token = rift_regex_tokenizer_peek_token(parser->tokenizer);
-            if (token.type == RIFT_REGEX_TOKEN_LITERAL && isdigit(token.value[0])) {
-                rift_regex_tokenizer_next_token(parser->tokenizer); // Consume the token
-                buffer[buffer_index++] = token.value[0];
-
-                // Read more digits
-                while (buffer_index < sizeof(buffer) - 1) { // Leave room for }
-                    token = rift_regex_tokenizer_peek_token(parser->tokenizer);
-                    if (token.type != RIFT_REGEX_TOKEN_LITERAL || !isdigit(token.value[0])) {
-                        break;
-                    }
-
-                    rift_regex_tokenizer_next_token(parser->tokenizer); // Consume the token
-                    buffer[buffer_index++] = token.value[0];
-                }
-            }
-
-            // Read the closing brace
-            token = rift_regex_tokenizer_next_token(parser->tokenizer);
-        }
-
-        // Check for closing brace
-        if (token.type != RIFT_REGEX_TOKEN_RBRACE) {
-            rift_regex_ast_free_node(quantifier);
-            set_error(parser, "Expected closing brace in quantifier", token.position);
-            return false;
-        }
-
-        // Add the closing brace
-        buffer[buffer_index++] = '}';
-        buffer[buffer_index] = '\0';
-
-        quantifier_value = strdup(buffer);
-    }
+    memset(parser, 0, sizeof(rift_regex_parser_t));
+    parser->flags = flags;
+    parser->rift_flag_enabled = rift_flag;
+    clear_error(parser);
+}
 
-    // Set the quantifier value
-    if (!quantifier_value || !rift_regex_ast_set_value(quantifier, quantifier_value)) {
-        free(quantifier_value);
-        rift_regex_ast_free_node(quantifier);
-        set_error(parser, "Failed to set quantifier value", token.position);
-        return false;
+/**
+ * @brief Create a new parser
+ *
+ * @param flags Parsing flags to initialize with
+ * @param rift_flag Whether to enable LibRift syntax mode
+ * @return A new parser or NULL on failure
+ */
+rift_regex_parser_t *
+rift_regex_parser_create(rift_regex_flags_t flags, bool rift_flag)
+{
+    rift_regex_parser_t *parser = (rift_regex_parser_t *)malloc(sizeof(rift_regex_parser_t));
+    if (!parser) {
+        return NULL;
     }
-    free(quantifier_value);
 
-    // Check for greediness modifier
-    token = rift_regex_tokenizer_peek_token(parser->tokenizer);
-    if (token.type == RIFT_REGEX_TOKEN_QUESTION) {
-        // Consume the token
-        rift_regex_tokenizer_next_token(parser->tokenizer);
+    rift_regex_parser_init(parser, flags, rift_flag);
 
-        // Get the current quantifier value
-        const char *current_value = rift_regex_ast_get_node_value(quantifier);
+    // Create the validator
+    parser->validator = rift_regex_validator_create();
+    if (!parser->validator) {
+        free(parser);
+        return NULL;
+    }
+    parser->owns_validator = true;
 
-        // Append the ? to the quantifier value
-        char new_value[32];
-        snprintf(new_value, sizeof(new_value), "%s?", current_value);
+    return parser;
+}
 
-        if (!rift_regex_ast_set_value(quantifier, new_value)) {
-            rift_regex_ast_free_node(quantifier);
-            set_error(parser, "Failed to set quantifier value", token.position);
-            return false;
-        }
+/**
+ * @brief Free resources associated with a parser
+ *
+ * @param parser The parser to free
+ */
+void
+rift_regex_parser_free(rift_regex_parser_t *parser)
+{
+    if (!parser) {
+        return;
     }
 
-    // Remove the last child from the current node
-    rift_regex_ast_node_t *parent = parser->current_node;
-
-    // Add the last child to the quantifier
-    if (!rift_regex_ast_add_child(quantifier, last_child)) {
-        rift_regex_ast_free_node(quantifier);
-        set_error(parser, "Failed to add child to quantifier", token.position);
-        return false;
+    // Free the tokenizer if owned
+    if (parser->tokenizer && parser->owns_tokenizer) {
+        rift_regex_tokenizer_free(parser->tokenizer);
     }
 
-    // Replace the last child with the quantifier
-    if (rift_regex_ast_get_child_count(parent) > 0) {
-        if (!rift_regex_ast_set_child(parent, child_count - 1, quantifier)) {
-            rift_regex_ast_free_node(quantifier);
-            set_error(parser, "Failed to update quantifier node",
-                      rift_regex_tokenizer_get_position(parser->tokenizer));
-            return false;
-        }
+    // Free the validator if owned
+    if (parser->validator && parser->owns_validator) {
+        rift_regex_validator_free(parser->validator);
     }
 
-    return true;
+    free(parser);
 }
 
 /**
- * @brief Parse a concatenation of terms
+ * @brief Set the tokenizer for the parser
  *
  * @param parser The parser
+ * @param tokenizer The tokenizer to use
  * @return true if successful, false otherwise
  */
 bool
-rift_regex_parser_handle_concatenation(rift_regex_parser_t *parser)
+rift_regex_parser_set_tokenizer(rift_regex_parser_t *parser, rift_regex_tokenizer_t *tokenizer)
 {
-    if (!parser || !parser->tokenizer) {
+    if (!parser) {
         return false;
     }
 
-    // Check if we need to create a concatenation node
-    rift_regex_ast_node_t *concat = NULL;
-
-    // Parse the first term
-    if (!parse_term(parser)) {
-        return false;
+    // Free the existing tokenizer if owned
+    if (parser->tokenizer && parser->owns_tokenizer) {
+        rift_regex_tokenizer_free(parser->tokenizer);
     }
 
-    // Check for more terms
-    rift_regex_token_t token = rift_regex_tokenizer_peek_token(parser->tokenizer);
-
-    // Check if we have more terms to parse
-    while (token.type != RIFT_REGEX_TOKEN_END && token.type != RIFT_REGEX_TOKEN_PIPE &&
-           token.type != RIFT_REGEX_TOKEN_RPAREN) {
-
-        // If this is the second term, create a concatenation node
-        if (!concat) {
-            // Create a concatenation node
-            concat = rift_regex_ast_create_node(RIFT_REGEX_AST_NODE_CONCATENATION);
-            if (!concat) {
-                set_error(parser, "Failed to create concatenation node", token.position);
-                return false;
-            }
-
-            // Add the concatenation node to the current node
-            rift_regex_ast_node_t *parent = parser->current_node;
-
-            // Get the first term (last child of the current node)
-            size_t child_count = rift_regex_ast_get_child_count(parent);
-            if (child_count == 0) {
-                rift_regex_ast_free_node(concat);
-                set_error(parser, "No first term for concatenation", token.position);
-                return false;
-            }
-
-            rift_regex_ast_node_t *first_term = rift_regex_ast_get_child(parent, child_count - 1);
-            if (!first_term) {
-                rift_regex_ast_free_node(concat);
-                set_error(parser, "Failed to get first term", token.position);
-                return false;
-            }
-
-            // Replace the last child with the concatenation
-            if (rift_regex_ast_get_child_count(parent) > 0) {
-                if (!rift_regex_ast_set_child(parent, child_count - 1, concat) ||
-                    !rift_regex_ast_set_parent(first_term, concat)) {
-                    rift_regex_ast_free_node(concat);
-                    set_error(parser, "Failed to update node relationships", token.position);
-                    return false;
-                }
-            }
-
-            // Add the first term to the concatenation
-            if (!rift_regex_ast_add_child(concat, first_term)) {
-                rift_regex_ast_free_node(concat);
-                set_error(parser, "Failed to add first term to concatenation", token.position);
-                return false;
-            }
-
-            // Set the current node to the concatenation for parsing the second term
-            parser->current_node = concat;
-        }
-
-        // Parse the next term
-        if (!parse_term(parser)) {
-            return false;
-        }
-
-        // Check for more terms
-        token = rift_regex_tokenizer_peek_token(parser->tokenizer);
-    }
+    parser->tokenizer = tokenizer;
+    parser->owns_tokenizer = false;
 
     return true;
 }
 
 /**
- * @brief Parse an alternation of concatenations
+ * @brief Set the validator for the parser
  *
  * @param parser The parser
+ * @param validator The validator to use
  * @return true if successful, false otherwise
  */
 bool
-rift_regex_parser_handle_alternation(rift_regex_parser_t *parser)
+rift_regex_parser_set_validator(rift_regex_parser_t *parser, rift_regex_validator_t *validator)
 {
-    if (!parser || !parser->tokenizer) {
+    if (!parser) {
         return false;
     }
 
-    // Check if we need to create an alternation node
-    rift_regex_ast_node_t *alt = NULL;
-
-    // Parse the first concatenation
-    if (!rift_regex_parser_handle_concatenation(parser)) {
-        return false;
+    // Free the existing validator if owned
+    if (parser->validator && parser->owns_validator) {
+        rift_regex_validator_free(parser->validator);
     }
 
-    // Check for alternation
-    rift_regex_token_t token = rift_regex_tokenizer_peek_token(parser->tokenizer);
-
-    // Check if we have more concatenations to parse
-    while (token.type == RIFT_REGEX_TOKEN_PIPE) {
-        // Consume the pipe
-        rift_regex_tokenizer_next_token(parser->tokenizer);
-
-        // If this is the second concatenation, create an alternation node
-        if (!alt) {
-            // Create an alternation node
-            alt = rift_regex_ast_create_node(RIFT_REGEX_AST_NODE_ALTERNATION);
-            if (!alt) {
-                set_error(parser, "Failed to create alternation node", token.position);
-                return false;
-            }
-
-            // Add the alternation node to the current node
-            rift_regex_ast_node_t *parent = parser->current_node;
-
-            // Get the first concatenation (last child of the current node)
-            size_t child_count = rift_regex_ast_get_child_count(parent);
-            if (child_count == 0) {
-                rift_regex_ast_free_node(alt);
-                set_error(parser, "No first concatenation for alternation", token.position);
-                return false;
-            }
-
-            rift_regex_ast_node_t *first_concat = rift_regex_ast_get_child(parent, child_count - 1);
-            if (!first_concat) {
-                rift_regex_ast_free_node(alt);
-                set_error(parser, "Failed to get first concatenation", token.position);
-                return false;
-            }
-
-            // Replace the last child with the alternation
-            if (!rift_regex_ast_set_child(parent, child_count - 1, alt) ||
-                !rift_regex_ast_set_parent(first_concat, alt)) {
-                rift_regex_ast_free_node(alt);
-                set_error(parser, "Failed to update node relationships", token.position);
-                return false;
-            }
-            // Add the first concatenation to the alternation
-            if (!rift_regex_ast_add_child(alt, first_concat)) {
-                rift_regex_ast_free_node(alt);
-                set_error(parser, "Failed to add first concatenation to alternation",
-                          token.position);
-                return false;
-            }
-
-            // Set the current node to the alternation for parsing the second
-            // concatenation
-            parser->current_node = alt;
-        }
-
-        // Parse the next concatenation
-        if (!rift_regex_parser_handle_concatenation(parser)) {
-            return false;
-        }
-
-        // Check for more concatenations
-        token = rift_regex_tokenizer_peek_token(parser->tokenizer);
-    }
+    parser->validator = validator;
+    parser->owns_validator = false;
 
     return true;
 }
 
 /**
- * @brief Parse an atom (literal, dot, group, etc.)
+ * @brief Parse a regular expression pattern under an existing root node
  *
  * @param parser The parser
+ * @param pattern The pattern to parse
+ * @param flags Flags that affect parsing
+ * @param root The node the pattern's tree is added to
  * @return true if successful, false otherwise
  */
-static bool
-parse_atom(rift_regex_parser_t *parser)
+bool
+rift_regex_parser_parse_into(rift_regex_parser_t *parser, const char *pattern,
+                             rift_regex_flags_t flags, rift_regex_ast_node_t *root)
 {
-    if (!parser || !parser->tokenizer) {
+    if (!parser) {
         return false;
     }
 
-    // Peek at the next token
-    rift_regex_token_t token = rift_regex_tokenizer_peek_token(parser->tokenizer);
-
-    // Handle different atom types
-    switch (token.type) {
-    case RIFT_REGEX_TOKEN_LITERAL: {
-        // Consume the token
-        token = rift_regex_tokenizer_next_token(parser->tokenizer);
-
-        // Create a literal node
-        rift_regex_ast_node_t *node = rift_regex_ast_create_node(RIFT_REGEX_AST_NODE_LITERAL);
-        if (!node) {
-            set_error(parser, "Failed to create literal node", token.position);
-            return false;
-        }
-
-        // Set the literal value
-        if (!rift_regex_ast_set_value(node, token.value)) {
-            rift_regex_ast_free_node(node);
-            set_error(parser, "Failed to set literal value", token.position);
-            return false;
-        }
-
-        // Add the node to the current node
-        if (!rift_regex_ast_add_child(parser->current_node, node)) {
-            rift_regex_ast_free_node(node);
-            set_error(parser, "Failed to add literal node", token.position);
-            return false;
-        }
-
-        return true;
+    clear_error(parser);
+    parser->offset = 0;
+    if (!pattern || !root) {
+        set_error(parser, RIFT_REGEX_ERROR_INVALID_PARAMETER, 0, "Invalid parameters");
+        return false;
     }
 
-    case RIFT_REGEX_TOKEN_DOT: {
-        // Consume the token
-        token = rift_regex_tokenizer_next_token(parser->tokenizer);
-
-        // Create a dot node
-        rift_regex_ast_node_t *node = rift_regex_ast_create_node(RIFT_REGEX_AST_NODE_DOT);
-        if (!node) {
-            set_error(parser, "Failed to create dot node", token.position);
+    parser->flags = flags;
+    parser->arena = root->arena;
+    parser->input = pattern;
+    parser->length = strlen(pattern);
+    parser->position = 0;
+    parser->depth = 0;
+
+    // An R'' pattern is unwrapped once, here; only its body is parsed
+    parser->rift_syntax_mode = rift_regex_is_rift_syntax(pattern);
+    if (parser->rift_syntax_mode) {
+        if (!parser->rift_flag_enabled && !(flags & RIFT_REGEX_FLAG_RIFT_SYNTAX)) {
+            set_error(parser, RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE, 0,
+                      "LibRift R'' syntax detected but -lrift flag is not enabled");
             return false;
         }
-
-        // Add the node to the current node
-        if (!rift_regex_ast_add_child(parser->current_node, node)) {
-            rift_regex_ast_free_node(node);
-            set_error(parser, "Failed to add dot node", token.position);
+        if (parser->length < 3 || pattern[parser->length - 1] != pattern[1]) {
+            set_error(parser, RIFT_REGEX_ERROR_SYNTAX, parser->length,
+                      "Missing closing quote for R'' pattern");
             return false;
         }
-
-        return true;
+        parser->input = pattern + 2;
+        parser->length -= 3;
+        parser->offset = 2;
     }
 
-    case RIFT_REGEX_TOKEN_LPAREN:
-        return rift_regex_parser_handle_group(parser);
-
-    case RIFT_REGEX_TOKEN_LBRACKET:
-        return rift_regex_parser_handle_character_class(parser);
-
-    case RIFT_REGEX_TOKEN_CARET: {
-        // Consume the token
-        token = rift_regex_tokenizer_next_token(parser->tokenizer);
-
-        // Create an anchor node
-        rift_regex_ast_node_t *node = rift_regex_ast_create_node(RIFT_REGEX_AST_NODE_ANCHOR);
-        if (!node) {
-            set_error(parser, "Failed to create anchor node", token.position);
-            return false;
-        }
-
-        // Set the anchor value
-        if (!rift_regex_ast_set_value(node, "^")) {
-            rift_regex_ast_free_node(node);
-            set_error(parser, "Failed to set anchor value", token.position);
-            return false;
-        }
-
-        // Add the node to the current node
-        if (!rift_regex_ast_add_child(parser->current_node, node)) {
-            rift_regex_ast_free_node(node);
-            set_error(parser, "Failed to add anchor node", token.position);
-            return false;
-        }
-
-        return true;
+    rift_regex_ast_node_t *tree = parse_alternation(parser);
+    if (!tree) {
+        return false;
     }
 
-    case RIFT_REGEX_TOKEN_DOLLAR: {
-        // Consume the token
-        token = rift_regex_tokenizer_next_token(parser->tokenizer);
-
-        // Create an anchor node
-        rift_regex_ast_node_t *node = rift_regex_ast_create_node(RIFT_REGEX_AST_NODE_ANCHOR);
-        if (!node) {
-            set_error(parser, "Failed to create anchor node", token.position);
-            return false;
-        }
-
-        // Set the anchor value
-        if (!rift_regex_ast_set_value(node, "$")) {
-            rift_regex_ast_free_node(node);
-            set_error(parser, "Failed to set anchor value", token.position);
-            return false;
-        }
-
-        // Add the node to the current node
-        if (!rift_regex_ast_add_child(parser->current_node, node)) {
-            rift_regex_ast_free_node(node);
-            set_error(parser, "Failed to add anchor node", token.position);
-            return false;
-        }
-
-        return true;
+    // Only an unmatched ')' stops the top level before the end
+    if (!at_end(parser)) {
+        free_node(tree);
+        set_error(parser, RIFT_REGEX_ERROR_UNBALANCED_PARENTHESES, parser->position,
+                  "Unmatched ')' at position %zu", parser->offset + parser->position);
+        return false;
     }
 
-    case RIFT_REGEX_TOKEN_ESCAPE_SEQUENCE: {
-        // Consume the token
-        token = rift_regex_tokenizer_next_token(parser->tokenizer);
-
-        // Create a node based on the escape sequence
-        rift_regex_ast_node_t *node;
-        if (token.value[0] == 'd' || token.value[0] == 'D' || token.value[0] == 'w' ||
-            token.value[0] == 'W' || token.value[0] == 's' || token.value[0] == 'S') {
-            // Character class escape sequence
-            node = rift_regex_ast_create_node(RIFT_REGEX_AST_NODE_CHARACTER_CLASS);
-        } else {
-            // Literal escape sequence
-            node = rift_regex_ast_create_node(RIFT_REGEX_AST_NODE_LITERAL);
-        }
-
-        if (!node) {
-            set_error(parser, "Failed to create escape sequence node", token.position);
-            return false;
-        }
-
-        // Set the escape sequence value
-        char value[3] = {'\\', token.value[0], '\0'};
-        if (!rift_regex_ast_set_value(node, value)) {
-            rift_regex_ast_free_node(node);
-            set_error(parser, "Failed to set escape sequence value", token.position);
-            return false;
-        }
-
-        // Add the node to the current node
-        if (!rift_regex_ast_add_child(parser->current_node, node)) {
-            rift_regex_ast_free_node(node);
-            set_error(parser, "Failed to add escape sequence node", token.position);
-            return false;
-        }
-
-        return true;
+    if (!add_child(parser, root, tree)) {
+        free_node(tree);
+        return false;
     }
 
-    case RIFT_REGEX_TOKEN_WORD_BOUNDARY: {
-        // Consume the token
-        token = rift_regex_tokenizer_next_token(parser->tokenizer);
-
-        // Create a word boundary node
-        rift_regex_ast_node_t *node = rift_regex_ast_create_node(RIFT_REGEX_AST_NODE_WORD_BOUNDARY);
-        if (!node) {
-            set_error(parser, "Failed to create word boundary node", token.position);
-            return false;
-        }
-
-        // Add the node to the current node
-        if (!rift_regex_ast_add_child(parser->current_node, node)) {
-            rift_regex_ast_free_node(node);
-            set_error(parser, "Failed to add word boundary node", token.position);
-            return false;
-        }
+    return true;
+}
 
-        return true;
+/**
+ * @brief Parse a regular expression pattern with options
+ *
+ * @param parser The parser
+ * @param pattern The pattern to parse
+ * @param flags Flags that affect parsing
+ * @return An AST representing the pattern or NULL on failure
+ */
+rift_regex_ast_t *
+rift_regex_parser_parse_with_options(rift_regex_parser_t *parser, const char *pattern,
+                                     rift_regex_flags_t flags)
+{
+    if (!parser) {
+        return NULL;
     }
 
-    case RIFT_REGEX_TOKEN_NOT_WORD_BOUNDARY: {
-        // Consume the token
-        token = rift_regex_tokenizer_next_token(parser->tokenizer);
-
-        // Create a not word boundary node
-        rift_regex_ast_node_t *node =
-            rift_regex_ast_create_node(RIFT_REGEX_AST_NODE_NOT_WORD_BOUNDARY);
-        if (!node) {
-            set_error(parser, "Failed to create not word boundary node", token.position);
-            return false;
-        }
-
-        // Add the node to the current node
-        if (!rift_regex_ast_add_child(parser->current_node, node)) {
-            rift_regex_ast_free_node(node);
-            set_error(parser, "Failed to add not word boundary node", token.position);
-            return false;
-        }
-
-        return true;
+    rift_regex_ast_t *ast = rift_regex_ast_create();
+    rift_regex_ast_node_t *root = rift_regex_ast_node_create(RIFT_REGEX_AST_NODE_ROOT);
+    if (!ast || !root || !rift_regex_ast_set_root(ast, root)) {
+        rift_regex_ast_node_free(root);
+        rift_regex_ast_free(ast);
+        clear_error(parser);
+        set_error(parser, RIFT_REGEX_ERROR_MEMORY, 0, "Failed to create AST");
+        return NULL;
     }
+    ast->flags = flags;
 
-    case RIFT_REGEX_TOKEN_BACKREFERENCE: {
-        // Consume the token
-        token = rift_regex_tokenizer_next_token(parser->tokenizer);
-
-        // Create a backreference node
-        rift_regex_ast_node_t *node = rift_regex_ast_create_node(RIFT_REGEX_AST_NODE_BACKREFERENCE);
-        if (!node) {
-            set_error(parser, "Failed to create backreference node", token.position);
-            return false;
-        }
-
-        // Set the backreference value
-        if (!rift_regex_ast_set_value(node, token.value)) {
-            rift_regex_ast_free_node(node);
-            set_error(parser, "Failed to set backreference value", token.position);
-            return false;
-        }
-
-        // Add the node to the current node
-        if (!rift_regex_ast_add_child(parser->current_node, node)) {
-            rift_regex_ast_free_node(node);
-            set_error(parser, "Failed to add backreference node", token.position);
-            return false;
-        }
-
-        return true;
+    if (!rift_regex_parser_parse_into(parser, pattern, flags, root)) {
+        rift_regex_ast_free(ast);
+        return NULL;
     }
 
-    case RIFT_REGEX_TOKEN_NAMED_BACKREFERENCE: {
-        // Consume the token
-        token = rift_regex_tokenizer_next_token(parser->tokenizer);
-
-        // Create a named backreference node
-        rift_regex_ast_node_t *node =
-            rift_regex_ast_create_node(RIFT_REGEX_AST_NODE_NAMED_BACKREFERENCE);
-        if (!node) {
-            set_error(parser, "Failed to create named backreference node", token.position);
-            return false;
-        }
-
-        // Set the named backreference value
-        if (!rift_regex_ast_set_value(node, token.value)) {
-            rift_regex_ast_free_node(node);
-            set_error(parser, "Failed to set named backreference value", token.position);
-            return false;
-        }
-
-        // Add the node to the current node
-        if (!rift_regex_ast_add_child(parser->current_node, node)) {
-            rift_regex_ast_free_node(node);
-            set_error(parser, "Failed to add named backreference node", token.position);
-            return false;
-        }
+    ast->group_count = rift_regex_ast_count_groups(ast);
 
-        return true;
+    // Validate the AST
+    if (parser->validator &&
+        !rift_regex_validator_validate_with_options(parser->validator, ast, flags)) {
+        const char *validator_error = rift_regex_validator_get_last_error(parser->validator);
+        set_error(parser, RIFT_REGEX_ERROR_SYNTAX, 0, "%s",
+                  validator_error ? validator_error : "AST validation failed");
+        rift_regex_ast_free(ast);
+        return NULL;
     }
+    ast->is_valid = true;
 
-    case RIFT_REGEX_TOKEN_BACKREF_RESET: {
-        // Consume the token
-        token = rift_regex_tokenizer_next_token(parser->tokenizer);
-
-        // Create a backref reset node
-        rift_regex_ast_node_t *node = rift_regex_ast_create_node(RIFT_REGEX_AST_NODE_BACKREF_RESET);
-        if (!node) {
-            set_error(parser, "Failed to create backref reset node", token.position);
-            return false;
-        }
+    return ast;
+}
 
-        // Add the node to the current node
-        if (!rift_regex_ast_add_child(parser->current_node, node)) {
-            rift_regex_ast_free_node(node);
-            set_error(parser, "Failed to add backref reset node", token.position);
-            return false;
-        }
+/**
+ * @brief Parse a regular expression pattern
+ *
+ * @param parser The parser
+ * @param pattern The pattern to parse
+ * @return An AST representing the pattern or NULL on failure
+ */
+rift_regex_ast_t *
+rift_regex_parser_parse(rift_regex_parser_t *parser, const char *pattern)
+{
+    return rift_regex_parser_parse_with_options(parser, pattern,
+                                                parser ? parser->flags : RIFT_REGEX_FLAG_NONE);
+}
 
-        return true;
+/**
+ * @brief Check the syntax of a pattern without keeping its AST
+ *
+ * @param parser The parser
+ * @param pattern The pattern to check
+ * @param flags Flags that affect parsing
+ * @return true if the pattern is valid, false otherwise
+ */
+bool
+rift_regex_parser_validate(rift_regex_parser_t *parser, const char *pattern,
+                           rift_regex_flags_t flags)
+{
+    if (!parser) {
+        return false;
     }
 
-    case RIFT_REGEX_TOKEN_START_OF_INPUT: {
-        // Consume the token
-        token = rift_regex_tokenizer_next_token(parser->tokenizer);
-
-        // Create an anchor node
-        rift_regex_ast_node_t *node = rift_regex_ast_create_node(RIFT_REGEX_AST_NODE_ANCHOR);
-        if (!node) {
-            set_error(parser, "Failed to create anchor node", token.position);
-            return false;
-        }
-
-        // Set the anchor value
-        if (!rift_regex_ast_set_value(node, "\\A")) {
-            rift_regex_ast_free_node(node);
-            set_error(parser, "Failed to set anchor value", token.position);
-            return false;
-        }
-
-        // Add the node to the current node
-        if (!rift_regex_ast_add_child(parser->current_node, node)) {
-            rift_regex_ast_free_node(node);
-            set_error(parser, "Failed to add anchor node", token.position);
-            return false;
-        }
-
-        return true;
+    // The tree is thrown away, so it goes in a scratch arena
+    rift_arena_t *arena = rift_arena_create(0);
+    rift_regex_ast_node_t *root =
+        rift_regex_ast_node_create_in_arena(arena, RIFT_REGEX_AST_NODE_ROOT);
+    if (!root) {
+        rift_arena_free(arena);
+        clear_error(parser);
+        set_error(parser, RIFT_REGEX_ERROR_MEMORY, 0, "Failed to create AST");
+        return false;
     }
 
-    case RIFT_REGEX_TOKEN_END_OF_INPUT: {
-        // Consume the token
-        token = rift_regex_tokenizer_next_token(parser->tokenizer);
+    bool valid = rift_regex_parser_parse_into(parser, pattern, flags, root);
 
-        // Create an anchor node
-        rift_regex_ast_node_t *node = rift_regex_ast_create_node(RIFT_REGEX_AST_NODE_ANCHOR);
-        if (!node) {
-            set_error(parser, "Failed to create anchor node", token.position);
-            return false;
-        }
-
-        // Set the anchor value
-        if (!rift_regex_ast_set_value(node, token.value[0] == 'Z' ? "\\Z" : "\\z")) {
-            rift_regex_ast_free_node(node);
-            set_error(parser, "Failed to set anchor value", token.position);
-            return false;
-        }
+    if (arena) {
+        rift_arena_free(arena);
+    } else {
+        rift_regex_ast_node_free_recursive(root);
+    }
 
-        // Add the node to the current node
-        if (!rift_regex_ast_add_child(parser->current_node, node)) {
-            rift_regex_ast_free_node(node);
-            set_error(parser, "Failed to add anchor node", token.position);
-            return false;
-        }
+    return valid;
+}
 
-        return true;
+/**
+ * @brief Get the last error
+ *
+ * @param parser The parser
+ * @return The last error or an error with code RIFT_REGEX_ERROR_NONE if no error occurred
+ */
+rift_regex_error_t
+rift_regex_parser_get_error(const rift_regex_parser_t *parser)
+{
+    if (!parser) {
+        rift_regex_error_t error = {.code = RIFT_REGEX_ERROR_NONE, .message = {0}};
+        return error;
     }
 
-    case RIFT_REGEX_TOKEN_OPTION: {
-        // Consume the token
-        token = rift_regex_tokenizer_next_token(parser->tokenizer);
+    return parser->error;
+}
 
-        // Create an option node
-        rift_regex_ast_node_t *node = rift_regex_ast_create_node(RIFT_REGEX_AST_NODE_OPTION);
-        if (!node) {
-            set_error(parser, "Failed to create option node", token.position);
-            return false;
-        }
+/**
+ * @brief Get the last error
+ *
+ * @param parser The parser
+ * @return The last error or an error with code RIFT_REGEX_ERROR_NONE if no error occurred
+ */
+rift_regex_error_t
+rift_regex_pattern_parser_get_error(const rift_regex_parser_t *parser)
+{
+    return rift_regex_parser_get_error(parser);
+}
 
-        // Set the option value
-        if (!rift_regex_ast_set_value(node, token.value)) {
-            rift_regex_ast_free_node(node);
-            set_error(parser, "Failed to set option value", token.position);
-            return false;
-        }
+/**
+ * @brief Get the code of the last error
+ *
+ * @param parser The parser
+ * @return The code of the last error, RIFT_REGEX_ERROR_NONE if none occurred
+ */
+rift_regex_error_code_t
+rift_regex_parser_get_error_code(const rift_regex_parser_t *parser)
+{
+    return parser ? parser->error.code : RIFT_REGEX_ERROR_NONE;
+}
 
-        // Add the node to the current node
-        if (!rift_regex_ast_add_child(parser->current_node, node)) {
-            rift_regex_ast_free_node(node);
-            set_error(parser, "Failed to add option node", token.position);
-            return false;
-        }
+/**
+ * @brief Get the last error message
+ *
+ * @param parser The parser
+ * @return The last error message, empty if no error occurred
+ */
+const char *
+rift_regex_parser_get_error_message(const rift_regex_parser_t *parser)
+{
+    return parser ? parser->error.message : "";
+}
 
-        return true;
+/**
+ * @brief Get the position of the last error
+ *
+ * @param parser The parser
+ * @return The position of the last error or (size_t)-1 if no error occurred
+ */
+size_t
+rift_regex_parser_get_error_position(const rift_regex_parser_t *parser)
+{
+    if (!parser) {
+        return (size_t)-1;
     }
 
-    case RIFT_REGEX_TOKEN_END:
-    case RIFT_REGEX_TOKEN_RPAREN:
-    case RIFT_REGEX_TOKEN_PIPE:
-        // These tokens indicate the end of a sequence, not an atom
-        // We'll return true with no node created, which means an empty sequence
-        return true;
+    return parser->error_position;
+}
 
-    default:
-        set_error(parser, "Unexpected token in pattern", token.position);
-        return false;
-    }
+/**
+ * @brief Check if the last pattern parsed used LibRift R'' syntax
+ *
+ * @param parser The parser instance
+ * @return true if it did, false otherwise
+ */
+bool
+rift_regex_parser_is_rift_syntax(const rift_regex_parser_t *parser)
+{
+    return parser && parser->rift_syntax_mode;
 }
 
 /**
- * @brief Parse a term (atom followed by optional quantifier)
+ * @brief Set whether the -lrift flag is enabled
  *
- * @param parser The parser
+ * @param parser The parser instance
+ * @param enabled Whether the flag should be enabled
  * @return true if successful, false otherwise
  */
-static bool
-parse_term(rift_regex_parser_t *parser)
+bool
+rift_regex_parser_set_rift_flag(rift_regex_parser_t *parser, bool enabled)
 {
-    if (!parser || !parser->tokenizer) {
-        return false;
-    }
-
-    // Parse an atom
-    if (!parse_atom(parser)) {
+    if (!parser) {
         return false;
     }
 
-    // Check for a quantifier
-    rift_regex_token_t token = rift_regex_tokenizer_peek_token(parser->tokenizer);
+    parser->rift_flag_enabled = enabled;
+    return true;
+}
 
-    if (token.type == RIFT_REGEX_TOKEN_STAR || token.type == RIFT_REGEX_TOKEN_PLUS ||
-        token.type == RIFT_REGEX_TOKEN_QUESTION || token.type == RIFT_REGEX_TOKEN_LBRACE) {
+/**
+ * @brief Check if the -lrift flag is enabled
+ *
+ * @param parser The parser instance
+ * @return true if the flag is enabled, false otherwise
+ */
+bool
+rift_regex_parser_is_rift_flag_enabled(const rift_regex_parser_t *parser)
+{
+    return parser && parser->rift_flag_enabled;
+}
 
-        // Parse the quantifier
-        if (!rift_regex_parser_handle_quantifier(parser)) {
-            return false;
-        }
+/**
+ * @brief Set parser options
+ *
+ * @param parser The parser instance
+ * @param flags Flags controlling parser behavior
+ * @return true if successful, false otherwise
+ */
+bool
+rift_regex_parser_set_flags(rift_regex_parser_t *parser, rift_regex_flags_t flags)
+{
+    if (!parser) {
+        return false;
     }
 
+    parser->flags = flags;
     return true;
 }
+
+/**
+ * @brief Get the current parser flags
+ *
+ * @param parser The parser instance
+ * @return The current flags
+ */
+rift_regex_flags_t
+rift_regex_parser_get_flags(const rift_regex_parser_t *parser)
+{
+    return parser ? parser->flags : RIFT_REGEX_FLAG_NONE;
+}
@@ -14,6 +14,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "core/parser/flat_ast.h"
 #include "librift/parser/validator.h"
 
 
@@ -37,6 +38,57 @@ set_error(rift_regex_validator_t *validator, const char *format, ...)
     va_end(args);
 }
 
+/**
+ * @brief What the checks of one node look at, whichever AST form it comes from
+ */
+typedef struct node_view {
+    rift_regex_ast_node_type_t type;             /**< Node type */
+    const char *value;                           /**< Node value, NULL if not set */
+    size_t child_count;                          /**< Number of children */
+    rift_regex_ast_node_type_t first_child_type; /**< Type of the first child, NONE if none */
+} node_view_t;
+
+static bool validate_view(rift_regex_validator_t *validator, const node_view_t *view);
+static bool validate_alternation_view(rift_regex_validator_t *validator, const node_view_t *view);
+static bool validate_quantifier_view(rift_regex_validator_t *validator, const node_view_t *view);
+static bool validate_group_view(rift_regex_validator_t *validator, const node_view_t *view);
+static bool validate_character_class_view(rift_regex_validator_t *validator,
+                                          const node_view_t *view);
+
+/**
+ * @brief Describe a tree node for the node checks
+ *
+ * @param node The node
+ * @param view The view to fill
+ */
+static void
+view_tree_node(const rift_regex_ast_node_t *node, node_view_t *view)
+{
+    rift_regex_ast_node_t *child = rift_regex_ast_get_child(node, 0);
+
+    view->type = rift_regex_ast_get_node_type(node);
+    view->value = rift_regex_ast_get_node_value(node);
+    view->child_count = rift_regex_ast_get_child_count(node);
+    view->first_child_type = child ? rift_regex_ast_get_node_type(child) : RIFT_REGEX_AST_NODE_NONE;
+}
+
+/**
+ * @brief Describe a flat AST node for the node checks
+ *
+ * @param flat The flat AST
+ * @param id The node
+ * @param view The view to fill
+ */
+static void
+view_flat_node(const rift_regex_flat_ast_t *flat, rift_regex_flat_node_id_t id, node_view_t *view)
+{
+    view->type = rift_regex_flat_ast_get_node_type(flat, id);
+    view->value = rift_regex_flat_ast_get_node_value(flat, id);
+    view->child_count = rift_regex_flat_ast_get_child_count(flat, id);
+    view->first_child_type =
+        rift_regex_flat_ast_get_node_type(flat, rift_regex_flat_ast_get_child(flat, id, 0));
+}
+
 /**
  * @brief Create a new validator
  *
@@ -59,6 +111,9 @@ rift_regex_validator_create(void)
     validator->current_group_number = 0;
     validator->max_recursion_depth = 1000; // Reasonable default
     validator->current_recursion_depth = 0;
+    validator->cache = NULL;
+    validator->cache_capacity = 0;
+    validator->cache_count = 0;
 
     return validator;
 }
@@ -119,38 +174,135 @@ rift_regex_validator_free(rift_regex_validator_t *validator)
         return;
     }
 
+    free(validator->cache);
     free(validator);
 }
 
+/**
+ * @brief Forget the subtrees a validator has seen pass
+ *
+ * @param validator The validator
+ */
+void
+rift_regex_validator_clear_cache(rift_regex_validator_t *validator)
+{
+    if (!validator) {
+        return;
+    }
+
+    free(validator->cache);
+    validator->cache = NULL;
+    validator->cache_capacity = 0;
+    validator->cache_count = 0;
+}
+
+/**
+ * @brief Cache key of a subtree under the current validation flags
+ */
+static uint64_t
+cache_key(const rift_regex_validator_t *validator, const rift_regex_ast_node_t *node)
+{
+    uint64_t key = rift_regex_ast_node_hash(node) ^
+                   ((uint64_t)validator->flags * 0x9e3779b97f4a7c15ULL);
+    return key ? key : 1;
+}
+
+/**
+ * @brief Find the cache slot of a key, or the free slot it would take
+ */
+static rift_regex_validator_cache_entry_t *
+cache_slot(rift_regex_validator_cache_entry_t *cache, size_t capacity, uint64_t key)
+{
+    size_t mask = capacity - 1;
+    for (size_t i = (size_t)key & mask;; i = (i + 1) & mask) {
+        if (cache[i].key == key || cache[i].key == 0) {
+            return &cache[i];
+        }
+    }
+}
+
+/**
+ * @brief Look up the summary of a subtree that passed before
+ *
+ * @return The summary, or NULL if the subtree was not seen pass
+ */
+static const rift_regex_validator_cache_entry_t *
+cache_find(const rift_regex_validator_t *validator, uint64_t key)
+{
+    if (!validator->cache) {
+        return NULL;
+    }
+
+    const rift_regex_validator_cache_entry_t *entry =
+        cache_slot(validator->cache, validator->cache_capacity, key);
+    return entry->key ? entry : NULL;
+}
+
+/**
+ * @brief Remember the summary of a subtree that passed
+ *
+ * The cache is only an accelerator, so running out of memory or of room
+ * just means the subtree is walked again next time.
+ */
+static void
+cache_store(rift_regex_validator_t *validator, const rift_regex_validator_cache_entry_t *entry)
+{
+    // Keep the table at most three quarters full
+    if ((validator->cache_count + 1) * 4 > validator->cache_capacity * 3) {
+        size_t capacity = validator->cache_capacity ? validator->cache_capacity * 2 : 64;
+        if (capacity > RIFT_REGEX_VALIDATOR_CACHE_MAX_ENTRIES) {
+            // Full: start over rather than let an old document pin the memory
+            memset(validator->cache, 0,
+                   sizeof(rift_regex_validator_cache_entry_t) * validator->cache_capacity);
+            validator->cache_count = 0;
+        } else {
+            rift_regex_validator_cache_entry_t *cache =
+                (rift_regex_validator_cache_entry_t *)calloc(
+                    capacity, sizeof(rift_regex_validator_cache_entry_t));
+            if (!cache) {
+                return;
+            }
+            for (size_t i = 0; i < validator->cache_capacity; i++) {
+                if (validator->cache[i].key) {
+                    *cache_slot(cache, capacity, validator->cache[i].key) = validator->cache[i];
+                }
+            }
+            free(validator->cache);
+            validator->cache = cache;
+            validator->cache_capacity = capacity;
+        }
+    }
+
+    rift_regex_validator_cache_entry_t *slot =
+        cache_slot(validator->cache, validator->cache_capacity, entry->key);
+    if (slot->key == 0) {
+        validator->cache_count++;
+    }
+    *slot = *entry;
+}
+
 /**
  * @brief Check if a node has a valid number of children
  *
  * @param validator The validator
- * @param node The node to check
+ * @param view The node to check
  * @param min_children Minimum number of children required
  * @param max_children Maximum number of children allowed (use SIZE_MAX for unlimited)
  * @return true if the node has a valid number of children, false otherwise
  */
 static bool
-validate_child_count(rift_regex_validator_t *validator, const rift_regex_ast_node_t *node,
+validate_child_count(rift_regex_validator_t *validator, const node_view_t *view,
                      size_t min_children, size_t max_children)
 {
-    if (!node) {
-        set_error(validator, "Node is NULL");
-        return false;
-    }
-
-    size_t child_count = rift_regex_ast_get_child_count(node);
-
-    if (child_count < min_children) {
+    if (view->child_count < min_children) {
         set_error(validator, "Node of type %d requires at least %zu children, but has %zu",
-                  rift_regex_ast_get_node_type(node), min_children, child_count);
+                  view->type, min_children, view->child_count);
         return false;
     }
 
-    if (child_count > max_children) {
+    if (view->child_count > max_children) {
         set_error(validator, "Node of type %d allows at most %zu children, but has %zu",
-                  rift_regex_ast_get_node_type(node), max_children, child_count);
+                  view->type, max_children, view->child_count);
         return false;
     }
 
@@ -160,12 +312,19 @@ validate_child_count(rift_regex_validator_t *validator, const rift_regex_ast_nod
 /**
  * @brief Validate an AST node recursively
  *
+ * Subtrees with children are looked up in the cache by content hash first.
+ * A backreference only depends on how many groups come before it, so a
+ * subtree that passed once passes again wherever at least as many groups
+ * precede it as its deepest backreference needs.
+ *
  * @param validator The validator
  * @param node The node to validate
+ * @param summary Filled with the summary of the subtree when it is valid
  * @return true if the node is valid, false otherwise
  */
 static bool
-validate_node_recursive(rift_regex_validator_t *validator, const rift_regex_ast_node_t *node)
+validate_node_recursive(rift_regex_validator_t *validator, const rift_regex_ast_node_t *node,
+                        rift_regex_validator_cache_entry_t *summary)
 {
     if (!validator || !node) {
         return false;
@@ -177,29 +336,64 @@ validate_node_recursive(rift_regex_validator_t *validator, const rift_regex_ast_
         return false;
     }
 
+    size_t child_count = rift_regex_ast_get_child_count(node);
+    uint64_t key = child_count > 0 ? cache_key(validator, node) : 0;
+    const rift_regex_validator_cache_entry_t *cached = key ? cache_find(validator, key) : NULL;
+    if (cached && cached->groups_required <= validator->current_group_number &&
+        validator->current_recursion_depth + cached->height <= validator->max_recursion_depth) {
+        *summary = *cached;
+        validator->current_group_number += cached->group_count;
+        if (validator->current_group_number > validator->max_group_number) {
+            validator->max_group_number = validator->current_group_number;
+        }
+        return true;
+    }
+
+    size_t groups_before = validator->current_group_number;
+
     // Increment recursion depth
     validator->current_recursion_depth++;
 
     // Validate the node based on its type
     bool result = rift_regex_validator_validate_node(validator, node);
 
+    summary->key = key;
+    summary->groups_required = 0;
+    summary->height = 1;
+    if (result && rift_regex_ast_get_node_type(node) == RIFT_REGEX_AST_NODE_BACKREFERENCE) {
+        summary->groups_required = (size_t)strtol(rift_regex_ast_get_node_value(node), NULL, 10);
+    }
+
     // If the node is valid, validate its children
     if (result) {
-        size_t child_count = rift_regex_ast_get_child_count(node);
-
         for (size_t i = 0; i < child_count; i++) {
             rift_regex_ast_node_t *child = rift_regex_ast_get_child(node, i);
+            size_t groups_inside = validator->current_group_number - groups_before;
+            rift_regex_validator_cache_entry_t child_summary;
 
-            if (!validate_node_recursive(validator, child)) {
+            if (!validate_node_recursive(validator, child, &child_summary)) {
                 result = false;
                 break;
             }
+
+            // Groups of the subtree that precede the child count toward what it needs
+            if (child_summary.groups_required > groups_inside + summary->groups_required) {
+                summary->groups_required = child_summary.groups_required - groups_inside;
+            }
+            if (child_summary.height + 1 > summary->height) {
+                summary->height = child_summary.height + 1;
+            }
         }
     }
 
     // Decrement recursion depth
     validator->current_recursion_depth--;
 
+    summary->group_count = validator->current_group_number - groups_before;
+    if (result && key) {
+        cache_store(validator, summary);
+    }
+
     return result;
 }
 
@@ -255,7 +449,47 @@ rift_regex_validator_validate_with_options(rift_regex_validator_t *validator,
     }
 
     // Start recursive validation from the root
-    return validate_node_recursive(validator, root);
+    rift_regex_validator_cache_entry_t summary;
+    return validate_node_recursive(validator, root, &summary);
+}
+
+/**
+ * @brief Validate a flat AST
+ *
+ * @param validator The validator
+ * @param flat The flat AST to validate
+ * @param flags Flags that affect validation
+ * @return true if the AST is valid, false otherwise
+ */
+bool
+rift_regex_validator_validate_flat(rift_regex_validator_t *validator,
+                                   const rift_regex_flat_ast_t *flat, rift_regex_flags_t flags)
+{
+    if (!validator || !flat || rift_regex_flat_ast_get_node_count(flat) == 0) {
+        if (validator) {
+            set_error(validator, "NULL AST provided for validation");
+        }
+        return false;
+    }
+
+    validator->error[0] = '\0';
+    validator->flags = flags;
+    validator->max_group_number = 0;
+    validator->current_group_number = 0;
+    validator->current_recursion_depth = 0;
+
+    // Nodes are stored in the order the recursive walk visits them, so groups
+    // are numbered before the backreferences that follow them either way
+    size_t count = rift_regex_flat_ast_get_node_count(flat);
+    for (rift_regex_flat_node_id_t id = RIFT_REGEX_FLAT_AST_ROOT; id < count; id++) {
+        node_view_t view;
+        view_flat_node(flat, id, &view);
+        if (!validate_view(validator, &view)) {
+            return false;
+        }
+    }
+
+    return true;
 }
 
 /**
@@ -292,19 +526,34 @@ rift_regex_validator_validate_node(rift_regex_validator_t *validator,
         return false;
     }
 
-    rift_regex_ast_node_type_t type = rift_regex_ast_get_node_type(node);
+    node_view_t view;
+    view_tree_node(node, &view);
+    return validate_view(validator, &view);
+}
+
+/**
+ * @brief Validate one node from its view
+ *
+ * @param validator The validator
+ * @param view The node to validate
+ * @return true if the node is valid, false otherwise
+ */
+static bool
+validate_view(rift_regex_validator_t *validator, const node_view_t *view)
+{
+    rift_regex_ast_node_type_t type = view->type;
 
     switch (type) {
     case RIFT_REGEX_AST_NODE_ALTERNATION:
-        return rift_regex_validator_validate_alternation(validator, node);
+        return validate_alternation_view(validator, view);
 
     case RIFT_REGEX_AST_NODE_CONCATENATION:
-        // Concatenation is valid if it has at least one child
-        return validate_child_count(validator, node, 1, SIZE_MAX);
+        // An empty concatenation matches the empty string
+        return true;
 
     case RIFT_REGEX_AST_NODE_LITERAL:
         // Literal must have a value
-        if (!rift_regex_ast_get_node_value(node)) {
+        if (!view->value) {
             set_error(validator, "Literal node has no value");
             return false;
         }
@@ -315,17 +564,17 @@ rift_regex_validator_validate_node(rift_regex_validator_t *validator,
         return true;
 
     case RIFT_REGEX_AST_NODE_CHARACTER_CLASS:
-        return rift_regex_validator_validate_character_class(validator, node);
+        return validate_character_class_view(validator, view);
 
     case RIFT_REGEX_AST_NODE_GROUP:
     case RIFT_REGEX_AST_NODE_NON_CAPTURING_GROUP:
     case RIFT_REGEX_AST_NODE_NAMED_GROUP:
-        return rift_regex_validator_validate_group(validator, node);
+        return validate_group_view(validator, view);
 
     case RIFT_REGEX_AST_NODE_BACKREFERENCE:
         // Validate backreference has a valid group number
         {
-            const char *value = rift_regex_ast_get_node_value(node);
+            const char *value = view->value;
             if (!value) {
                 set_error(validator, "Backreference has no value");
                 return false;
@@ -344,14 +593,14 @@ rift_regex_validator_validate_node(rift_regex_validator_t *validator,
 
     case RIFT_REGEX_AST_NODE_NAMED_BACKREFERENCE:
         // Named backreference must have a name value
-        if (!rift_regex_ast_get_node_value(node)) {
+        if (!view->value) {
             set_error(validator, "Named backreference has no name value");
             return false;
         }
         return true;
 
     case RIFT_REGEX_AST_NODE_QUANTIFIER:
-        return rift_regex_validator_validate_quantifier(validator, node);
+        return validate_quantifier_view(validator, view);
 
     case RIFT_REGEX_AST_NODE_ANCHOR:
     case RIFT_REGEX_AST_NODE_WORD_BOUNDARY:
@@ -366,7 +615,7 @@ rift_regex_validator_validate_node(rift_regex_validator_t *validator,
     case RIFT_REGEX_AST_NODE_NEGATIVE_LOOKBEHIND:
     case RIFT_REGEX_AST_NODE_ATOMIC_GROUP:
         // These assertions must have exactly one child
-        return validate_child_count(validator, node, 1, 1);
+        return validate_child_count(validator, view, 1, 1);
 
     case RIFT_REGEX_AST_NODE_COMMENT:
         // Comments don't need validation
@@ -375,7 +624,7 @@ rift_regex_validator_validate_node(rift_regex_validator_t *validator,
     case RIFT_REGEX_AST_NODE_OPTION:
         // Options must have a valid value
         {
-            const char *value = rift_regex_ast_get_node_value(node);
+            const char *value = view->value;
             if (!value) {
                 set_error(validator, "Option node has no value");
                 return false;
@@ -395,14 +644,14 @@ rift_regex_validator_validate_node(rift_regex_validator_t *validator,
 
     case RIFT_REGEX_AST_NODE_CONDITIONAL:
         // Conditionals must have 2 or 3 children (condition + then + optional else)
-        if (!validate_child_count(validator, node, 2, 3)) {
+        if (!validate_child_count(validator, view, 2, 3)) {
             return false;
         }
         return true;
 
     case RIFT_REGEX_AST_NODE_BACKTRACK_CONTROL:
         // Backtrack control must have a valid value
-        if (!rift_regex_ast_get_node_value(node)) {
+        if (!view->value) {
             set_error(validator, "Backtrack control node has no value");
             return false;
         }
@@ -411,7 +660,7 @@ rift_regex_validator_validate_node(rift_regex_validator_t *validator,
     case RIFT_REGEX_AST_NODE_POSIX_CLASS:
         // POSIX class must have a valid class name
         {
-            const char *value = rift_regex_ast_get_node_value(node);
+            const char *value = view->value;
             if (!value) {
                 set_error(validator, "POSIX class has no value");
                 return false;
@@ -439,7 +688,7 @@ rift_regex_validator_validate_node(rift_regex_validator_t *validator,
 
     case RIFT_REGEX_AST_NODE_UNICODE_PROPERTY:
         // Unicode property must have a valid property name
-        if (!rift_regex_ast_get_node_value(node)) {
+        if (!view->value) {
             set_error(validator, "Unicode property has no value");
             return false;
         }
@@ -448,7 +697,7 @@ rift_regex_validator_validate_node(rift_regex_validator_t *validator,
 
     case RIFT_REGEX_AST_NODE_ROOT:
         // Root node should have exactly one child
-        return validate_child_count(validator, node, 1, 1);
+        return validate_child_count(validator, view, 1, 1);
 
     default:
         set_error(validator, "Unknown node type: %d", type);
@@ -474,8 +723,23 @@ rift_regex_validator_validate_alternation(rift_regex_validator_t *validator,
         return false;
     }
 
+    node_view_t view;
+    view_tree_node(node, &view);
+    return validate_alternation_view(validator, &view);
+}
+
+/**
+ * @brief Validate an alternation node from its view
+ *
+ * @param validator The validator
+ * @param view The node to validate
+ * @return true if the node is valid, false otherwise
+ */
+static bool
+validate_alternation_view(rift_regex_validator_t *validator, const node_view_t *view)
+{
     // Alternation must have at least 2 alternatives
-    if (!validate_child_count(validator, node, 2, SIZE_MAX)) {
+    if (!validate_child_count(validator, view, 2, SIZE_MAX)) {
         return false;
     }
 
@@ -500,13 +764,28 @@ rift_regex_validator_validate_quantifier(rift_regex_validator_t *validator,
         return false;
     }
 
+    node_view_t view;
+    view_tree_node(node, &view);
+    return validate_quantifier_view(validator, &view);
+}
+
+/**
+ * @brief Validate a quantifier node from its view
+ *
+ * @param validator The validator
+ * @param view The node to validate
+ * @return true if the node is valid, false otherwise
+ */
+static bool
+validate_quantifier_view(rift_regex_validator_t *validator, const node_view_t *view)
+{
     // Quantifier must have exactly one child
-    if (!validate_child_count(validator, node, 1, 1)) {
+    if (!validate_child_count(validator, view, 1, 1)) {
         return false;
     }
 
     // Get the quantifier specifications
-    const char *value = rift_regex_ast_get_node_value(node);
+    const char *value = view->value;
     if (!value) {
         set_error(validator, "Quantifier node has no value");
         return false;
@@ -516,14 +795,16 @@ rift_regex_validator_validate_quantifier(rift_regex_validator_t *validator,
     unsigned long min = 0, max = 0;
     bool unlimited = false;
 
-    // Handle simple quantifiers
-    if (strcmp(value, "*") == 0) {
+    // Handle simple quantifiers, which may carry a lazy or possessive suffix
+    size_t length = strlen(value);
+    bool simple_suffix = length == 1 || (length == 2 && (value[1] == '?' || value[1] == '+'));
+    if (value[0] == '*' && simple_suffix) {
         min = 0;
         unlimited = true;
-    } else if (strcmp(value, "+") == 0) {
+    } else if (value[0] == '+' && simple_suffix) {
         min = 1;
         unlimited = true;
-    } else if (strcmp(value, "?") == 0) {
+    } else if (value[0] == '?' && simple_suffix) {
         min = 0;
         max = 1;
     } else if (value[0] == '{') {
@@ -569,13 +850,12 @@ rift_regex_validator_validate_quantifier(rift_regex_validator_t *validator,
     }
 
     // Don't allow quantifying nothing or nodes that can't be quantified
-    rift_regex_ast_node_t *child = rift_regex_ast_get_child(node, 0);
-    if (!child) {
+    if (view->first_child_type == RIFT_REGEX_AST_NODE_NONE) {
         set_error(validator, "Quantifier has no child node");
         return false;
     }
 
-    rift_regex_ast_node_type_t child_type = rift_regex_ast_get_node_type(child);
+    rift_regex_ast_node_type_t child_type = view->first_child_type;
 
     // Disallow quantifying assertions (lookahead, lookbehind, anchors)
     if (child_type == RIFT_REGEX_AST_NODE_LOOKAHEAD ||
@@ -611,12 +891,27 @@ rift_regex_validator_validate_group(rift_regex_validator_t *validator,
         return false;
     }
 
+    node_view_t view;
+    view_tree_node(node, &view);
+    return validate_group_view(validator, &view);
+}
+
+/**
+ * @brief Validate a group node from its view
+ *
+ * @param validator The validator
+ * @param view The node to validate
+ * @return true if the node is valid, false otherwise
+ */
+static bool
+validate_group_view(rift_regex_validator_t *validator, const node_view_t *view)
+{
     // Group must have exactly one child
-    if (!validate_child_count(validator, node, 1, 1)) {
+    if (!validate_child_count(validator, view, 1, 1)) {
         return false;
     }
 
-    rift_regex_ast_node_type_t type = rift_regex_ast_get_node_type(node);
+    rift_regex_ast_node_type_t type = view->type;
 
     // Increment group counter for capturing groups
     if (type == RIFT_REGEX_AST_NODE_GROUP) {
@@ -626,7 +921,7 @@ rift_regex_validator_validate_group(rift_regex_validator_t *validator,
         }
     } else if (type == RIFT_REGEX_AST_NODE_NAMED_GROUP) {
         // Named group must have a name
-        const char *name = rift_regex_ast_get_node_value(node);
+        const char *name = view->value;
         if (!name || name[0] == '\0') {
             set_error(validator, "Named capturing group has no name");
             return false;
@@ -674,8 +969,23 @@ rift_regex_validator_validate_character_class(rift_regex_validator_t *validator,
         return false;
     }
 
+    node_view_t view;
+    view_tree_node(node, &view);
+    return validate_character_class_view(validator, &view);
+}
+
+/**
+ * @brief Validate a character class node from its view
+ *
+ * @param validator The validator
+ * @param view The node to validate
+ * @return true if the node is valid, false otherwise
+ */
+static bool
+validate_character_class_view(rift_regex_validator_t *validator, const node_view_t *view)
+{
     // Character class must have a value
-    const char *value = rift_regex_ast_get_node_value(node);
+    const char *value = view->value;
     if (!value) {
         set_error(validator, "Character class node has no value");
         return false;
@@ -3,13 +3,20 @@
  * @brief Implementation of baseline regex pattern utilities
  *
  * This file implements utilities for working with the baseline regex patterns
- * defined in baseline_patterns.h.
+ * defined in baseline_patterns.h. Patterns are compiled on their first
+ * request; their DFA tables come from baseline_tables.c, which the build
+ * generates with tools/baseline_gen, unless LIBRIFT_PRECOMPILED_BASELINE is
+ * left undefined. Nothing is compiled until a pattern is asked for, and two
+ * threads asking at once both compile it, the first to publish it winning.
  *
  * @copyright Copyright (c) 2025 LibRift Project
  * @license MIT License
  */
 
 #include "core/patterns/baseline_patterns.h"
+#include <stdatomic.h>
+#include "core/automaton/automaton.h"
+#include "core/automaton/hopcroft.h"
 #include "core/compiler/compiler.h"
 #include "core/engine/pattern.h"
 #include "core/errors/error.h"
@@ -20,90 +27,88 @@
 #include "librift/patterns/baseline_patterns.h"
 
 
-/* Internal pattern cache for precompiled patterns */
-static struct {
-    rift_regex_pattern_t *empty_state;
-    rift_regex_pattern_t *whitespace;
-    rift_regex_pattern_t *word_boundary;
-    rift_regex_pattern_t *identifier;
-    rift_regex_pattern_t *numeric;
-    rift_regex_pattern_t *string;
-    rift_regex_pattern_t *comment;
-    rift_regex_pattern_t *operator;
-    rift_regex_pattern_t *function;
-    rift_regex_pattern_t *state_transition;
-} pattern_cache = {0};
+/* Flags every baseline pattern is compiled with */
+#define BASELINE_FLAGS (RIFT_REGEX_FLAG_RIFT_SYNTAX | RIFT_REGEX_FLAG_OPTIMIZE)
+
+/* Pattern string of each baseline pattern type */
+static const char *const baseline_sources[RIFT_BASELINE_PATTERN_COUNT] = {
+    [RIFT_BASELINE_PATTERN_EMPTY_STATE] = RIFT_PATTERN_EMPTY_STATE,
+    [RIFT_BASELINE_PATTERN_WHITESPACE] = RIFT_PATTERN_WHITESPACE,
+    [RIFT_BASELINE_PATTERN_WORD_BOUNDARY] = RIFT_PATTERN_WORD_BOUNDARY,
+    [RIFT_BASELINE_PATTERN_IDENTIFIER] = RIFT_PATTERN_IDENTIFIER,
+    [RIFT_BASELINE_PATTERN_NUMERIC] = RIFT_PATTERN_NUMERIC,
+    [RIFT_BASELINE_PATTERN_STRING] = RIFT_PATTERN_STRING,
+    [RIFT_BASELINE_PATTERN_COMMENT] = RIFT_PATTERN_COMMENT,
+    [RIFT_BASELINE_PATTERN_OPERATOR] = RIFT_PATTERN_OPERATOR,
+    [RIFT_BASELINE_PATTERN_FUNCTION] = RIFT_PATTERN_FUNCTION,
+    [RIFT_BASELINE_PATTERN_STATE_TRANSITION] = RIFT_PATTERN_STATE_TRANSITION,
+};
+
+/* Internal pattern cache, filled one pattern at a time */
+static _Atomic(rift_regex_pattern_t *) pattern_cache[RIFT_BASELINE_PATTERN_COUNT];
+
+#ifdef LIBRIFT_PRECOMPILED_BASELINE
+/* Tables generated at build time, NULL for a pattern the generator could not compile */
+extern const rift_dfa_table_t *const rift_baseline_tables[RIFT_BASELINE_PATTERN_COUNT];
+#else
+/* Tables compiled on their first request */
+static _Atomic(rift_dfa_table_t *) table_cache[RIFT_BASELINE_PATTERN_COUNT];
+static atomic_bool table_compiled[RIFT_BASELINE_PATTERN_COUNT];
+#endif
 
 /**
- * @brief Initialize the baseline pattern cache
+ * @brief Check that a pattern type names a baseline pattern
+ */
+static bool
+is_valid_type(rift_baseline_pattern_type_t pattern_type)
+{
+    return (int)pattern_type >= 0 && (int)pattern_type < RIFT_BASELINE_PATTERN_COUNT;
+}
+
+/**
+ * @brief Compile one baseline pattern into the cache if it is not there yet
  *
+ * @param pattern_type The pattern type, which must be valid
  * @param error Pointer to store error information (can be NULL)
- * @return true if initialization was successful, false otherwise
+ * @return The cached pattern, or NULL if it cannot be compiled
  */
-bool
-rift_baseline_patterns_initialize(rift_regex_error_t *error)
+static rift_regex_pattern_t *
+compile_cached(rift_baseline_pattern_type_t pattern_type, rift_regex_error_t *error)
 {
-    rift_regex_flags_t flags = RIFT_REGEX_FLAG_RIFT_SYNTAX | RIFT_REGEX_FLAG_OPTIMIZE;
-
-    if (!pattern_cache.empty_state) {
-        pattern_cache.empty_state = rift_regex_compile(RIFT_PATTERN_EMPTY_STATE, flags, error);
-        if (!pattern_cache.empty_state)
-            return false;
+    rift_regex_pattern_t *cached = atomic_load(&pattern_cache[pattern_type]);
+    if (cached) {
+        return cached;
     }
 
-    if (!pattern_cache.whitespace) {
-        pattern_cache.whitespace = rift_regex_compile(RIFT_PATTERN_WHITESPACE, flags, error);
-        if (!pattern_cache.whitespace)
-            return false;
-    }
-
-    if (!pattern_cache.word_boundary) {
-        pattern_cache.word_boundary = rift_regex_compile(RIFT_PATTERN_WORD_BOUNDARY, flags, error);
-        if (!pattern_cache.word_boundary)
-            return false;
-    }
-
-    if (!pattern_cache.identifier) {
-        pattern_cache.identifier = rift_regex_compile(RIFT_PATTERN_IDENTIFIER, flags, error);
-        if (!pattern_cache.identifier)
-            return false;
-    }
-
-    if (!pattern_cache.numeric) {
-        pattern_cache.numeric = rift_regex_compile(RIFT_PATTERN_NUMERIC, flags, error);
-        if (!pattern_cache.numeric)
-            return false;
-    }
-
-    if (!pattern_cache.string) {
-        pattern_cache.string = rift_regex_compile(RIFT_PATTERN_STRING, flags, error);
-        if (!pattern_cache.string)
-            return false;
-    }
-
-    if (!pattern_cache.comment) {
-        pattern_cache.comment = rift_regex_compile(RIFT_PATTERN_COMMENT, flags, error);
-        if (!pattern_cache.comment)
-            return false;
-    }
-
-    if (!pattern_cache.operator) {
-        pattern_cache.operator= rift_regex_compile(RIFT_PATTERN_OPERATOR, flags, error);
-        if (!pattern_cache.operator)
-            return false;
+    rift_regex_pattern_t *compiled =
+        rift_regex_compile(baseline_sources[pattern_type], BASELINE_FLAGS, error);
+    if (!compiled) {
+        return NULL;
     }
-
-    if (!pattern_cache.function) {
-        pattern_cache.function = rift_regex_compile(RIFT_PATTERN_FUNCTION, flags, error);
-        if (!pattern_cache.function)
-            return false;
+    if (!atomic_compare_exchange_strong(&pattern_cache[pattern_type], &cached, compiled)) {
+        /* Another thread published the pattern first */
+        rift_regex_pattern_free(compiled);
+        return cached;
     }
+    return compiled;
+}
 
-    if (!pattern_cache.state_transition) {
-        pattern_cache.state_transition =
-            rift_regex_compile(RIFT_PATTERN_STATE_TRANSITION, flags, error);
-        if (!pattern_cache.state_transition)
+/**
+ * @brief Initialize the baseline pattern cache
+ *
+ * Compiles every pattern now rather than on its first request, for a
+ * process that would rather pay for them up front.
+ *
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if initialization was successful, false otherwise
+ */
+bool
+rift_baseline_patterns_initialize(rift_regex_error_t *error)
+{
+    for (int i = 0; i < RIFT_BASELINE_PATTERN_COUNT; i++) {
+        if (!compile_cached((rift_baseline_pattern_type_t)i, error)) {
             return false;
+        }
     }
 
     return true;
@@ -115,54 +120,13 @@ rift_baseline_patterns_initialize(rift_regex_error_t *error)
 void
 rift_baseline_patterns_cleanup(void)
 {
-    if (pattern_cache.empty_state) {
-        rift_regex_pattern_free(pattern_cache.empty_state);
-        pattern_cache.empty_state = NULL;
-    }
-
-    if (pattern_cache.whitespace) {
-        rift_regex_pattern_free(pattern_cache.whitespace);
-        pattern_cache.whitespace = NULL;
-    }
-
-    if (pattern_cache.word_boundary) {
-        rift_regex_pattern_free(pattern_cache.word_boundary);
-        pattern_cache.word_boundary = NULL;
-    }
-
-    if (pattern_cache.identifier) {
-        rift_regex_pattern_free(pattern_cache.identifier);
-        pattern_cache.identifier = NULL;
-    }
-
-    if (pattern_cache.numeric) {
-        rift_regex_pattern_free(pattern_cache.numeric);
-        pattern_cache.numeric = NULL;
-    }
-
-    if (pattern_cache.string) {
-        rift_regex_pattern_free(pattern_cache.string);
-        pattern_cache.string = NULL;
-    }
-
-    if (pattern_cache.comment) {
-        rift_regex_pattern_free(pattern_cache.comment);
-        pattern_cache.comment = NULL;
-    }
-
-    if (pattern_cache.operator) {
-        rift_regex_pattern_free(pattern_cache.operator);
-        pattern_cache.operator= NULL;
-    }
-
-    if (pattern_cache.function) {
-        rift_regex_pattern_free(pattern_cache.function);
-        pattern_cache.function = NULL;
-    }
+    for (int i = 0; i < RIFT_BASELINE_PATTERN_COUNT; i++) {
+        rift_regex_pattern_free(atomic_exchange(&pattern_cache[i], NULL));
 
-    if (pattern_cache.state_transition) {
-        rift_regex_pattern_free(pattern_cache.state_transition);
-        pattern_cache.state_transition = NULL;
+#ifndef LIBRIFT_PRECOMPILED_BASELINE
+        rift_dfa_table_free(atomic_exchange(&table_cache[i], NULL));
+        atomic_store(&table_compiled[i], false);
+#endif
     }
 }
 
@@ -176,36 +140,43 @@ rift_baseline_patterns_cleanup(void)
 rift_regex_pattern_t *
 rift_baseline_patterns_get(rift_baseline_pattern_type_t pattern_type, rift_regex_error_t *error)
 {
-    /* Initialize patterns if needed */
-    if (!pattern_cache.empty_state) {
-        if (!rift_baseline_patterns_initialize(error)) {
-            return NULL;
+    if (!is_valid_type(pattern_type)) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Unknown pattern type: %d", pattern_type);
         }
+        return NULL;
     }
 
-    /* Return the requested pattern */
-    switch (pattern_type) {
-    case RIFT_BASELINE_PATTERN_EMPTY_STATE:
-        return pattern_cache.empty_state;
-    case RIFT_BASELINE_PATTERN_WHITESPACE:
-        return pattern_cache.whitespace;
-    case RIFT_BASELINE_PATTERN_WORD_BOUNDARY:
-        return pattern_cache.word_boundary;
-    case RIFT_BASELINE_PATTERN_IDENTIFIER:
-        return pattern_cache.identifier;
-    case RIFT_BASELINE_PATTERN_NUMERIC:
-        return pattern_cache.numeric;
-    case RIFT_BASELINE_PATTERN_STRING:
-        return pattern_cache.string;
-    case RIFT_BASELINE_PATTERN_COMMENT:
-        return pattern_cache.comment;
-    case RIFT_BASELINE_PATTERN_OPERATOR:
-        return pattern_cache.operator;
-    case RIFT_BASELINE_PATTERN_FUNCTION:
-        return pattern_cache.function;
-    case RIFT_BASELINE_PATTERN_STATE_TRANSITION:
-        return pattern_cache.state_transition;
-    default:
+    /* Only the requested pattern is compiled */
+    return compile_cached(pattern_type, error);
+}
+
+/**
+ * @brief Get the pattern string of a baseline pattern
+ *
+ * @param pattern_type The pattern type
+ * @return The RIFT_PATTERN_* string, or NULL for an unknown type
+ */
+const char *
+rift_baseline_patterns_get_source(rift_baseline_pattern_type_t pattern_type)
+{
+    return is_valid_type(pattern_type) ? baseline_sources[pattern_type] : NULL;
+}
+
+/**
+ * @brief Compile a baseline pattern into a minimal DFA table
+ *
+ * @param pattern_type The pattern type
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new table or NULL on failure
+ */
+rift_dfa_table_t *
+rift_baseline_patterns_compile_table(rift_baseline_pattern_type_t pattern_type,
+                                     rift_regex_error_t *error)
+{
+    if (!is_valid_type(pattern_type)) {
         if (error) {
             error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
             snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
@@ -213,4 +184,56 @@ rift_baseline_patterns_get(rift_baseline_pattern_type_t pattern_type, rift_regex
         }
         return NULL;
     }
+
+    rift_regex_pattern_t *pattern =
+        rift_regex_compile(baseline_sources[pattern_type], BASELINE_FLAGS, error);
+    if (!pattern) {
+        return NULL;
+    }
+
+    /* Determinize and minimize as rift compile --emit-c does */
+    const rift_regex_automaton_t *automaton = rift_regex_pattern_get_automaton(pattern);
+    rift_regex_automaton_t *dfa = NULL;
+    if (automaton && !automaton->is_deterministic) {
+        dfa = rift_automaton_nfa_to_dfa(automaton, error);
+        automaton = dfa;
+    }
+
+    rift_regex_automaton_t *minimal = automaton ? rift_hopcroft_minimize(automaton, error) : NULL;
+    rift_dfa_table_t *table = minimal ? rift_dfa_table_compile(minimal, error) : NULL;
+
+    rift_automaton_free(minimal);
+    rift_automaton_free(dfa);
+    rift_regex_pattern_free(pattern);
+    return table;
+}
+
+/**
+ * @brief Get the DFA table of a baseline pattern
+ *
+ * @param pattern_type The pattern type
+ * @return The table, owned by the library, or NULL if the pattern could not be
+ *         compiled into one
+ */
+const rift_dfa_table_t *
+rift_baseline_patterns_get_table(rift_baseline_pattern_type_t pattern_type)
+{
+    if (!is_valid_type(pattern_type)) {
+        return NULL;
+    }
+
+#ifdef LIBRIFT_PRECOMPILED_BASELINE
+    return rift_baseline_tables[pattern_type];
+#else
+    if (!atomic_load(&table_compiled[pattern_type])) {
+        rift_dfa_table_t *compiled = rift_baseline_patterns_compile_table(pattern_type, NULL);
+        rift_dfa_table_t *expected = NULL;
+        if (compiled &&
+            !atomic_compare_exchange_strong(&table_cache[pattern_type], &expected, compiled)) {
+            rift_dfa_table_free(compiled);
+        }
+        atomic_store(&table_compiled[pattern_type], true);
+    }
+    return atomic_load(&table_cache[pattern_type]);
+#endif
 }
@@ -0,0 +1,304 @@
+/**
+ * @file lexer.c
+ * @brief Implementation of the longest-match tokenizer
+ *
+ * The rules go into a pattern set, whose union automaton tags every
+ * accepting state with the rules it completes. Determinizing keeps the tags
+ * and Hopcroft minimization never merges states with different tags, so
+ * each row of the dense table built from the minimal DFA knows its rules;
+ * the lexer keeps the first of them per row, which is all longest match
+ * with priority tie-breaking needs. The table is then compressed into the
+ * layout the memory budget allows, whose accepting states map back to
+ * their rows.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/patterns/lexer.h"
+#include <stdio.h>
+#include <string.h>
+#include "core/automaton/automaton.h"
+#include "core/automaton/compact_dfa.h"
+#include "core/automaton/dfa_table.h"
+#include "core/automaton/hopcroft.h"
+#include "core/automaton/state.h"
+#include "core/engine/pattern_set.h"
+#include "core/memory/memory.h"
+
+/**
+ * @brief Lexer structure
+ */
+struct rift_lexer {
+    rift_pattern_set_t *rules; /**< The rules, tagged by their index */
+    rift_compact_dfa_t *table; /**< Minimal DFA of the rules, NULL until compiled */
+    uint32_t *row_rules;       /**< First rule accepted by each row, RIFT_LEXER_NO_RULE if none */
+    size_t memory_budget;      /**< Bytes the table may take, 0 for none */
+};
+
+/**
+ * @brief Create a lexer with no rules
+ *
+ * @return A new lexer or NULL on failure
+ */
+rift_lexer_t *
+rift_lexer_create(void)
+{
+    rift_lexer_t *lexer = (rift_lexer_t *)rift_calloc(1, sizeof(rift_lexer_t));
+    if (!lexer) {
+        return NULL;
+    }
+
+    lexer->rules = rift_pattern_set_create(0);
+    if (!lexer->rules) {
+        rift_free(lexer);
+        return NULL;
+    }
+    return lexer;
+}
+
+/**
+ * @brief Drop the compiled DFA of a lexer
+ */
+static void
+discard_table(rift_lexer_t *lexer)
+{
+    rift_compact_dfa_free(lexer->table);
+    rift_free(lexer->row_rules);
+    lexer->table = NULL;
+    lexer->row_rules = NULL;
+}
+
+/**
+ * @brief Free a lexer
+ *
+ * @param lexer The lexer (can be NULL)
+ */
+void
+rift_lexer_free(rift_lexer_t *lexer)
+{
+    if (!lexer) {
+        return;
+    }
+
+    discard_table(lexer);
+    rift_pattern_set_free(lexer->rules);
+    rift_free(lexer);
+}
+
+/**
+ * @brief Compile a pattern and add it as the lowest-priority rule
+ *
+ * @param lexer The lexer
+ * @param pattern The pattern string
+ * @param flags Compilation flags
+ * @param rule Pointer to store the index of the rule (can be NULL)
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+bool
+rift_lexer_add_rule(rift_lexer_t *lexer, const char *pattern, rift_regex_flags_t flags,
+                    uint32_t *rule, rift_regex_error_t *error)
+{
+    if (!lexer || !pattern) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Invalid parameters for lexer rule");
+        }
+        return false;
+    }
+
+    // Pattern identifiers are assigned in order, so they are the priorities
+    return rift_pattern_set_add(lexer->rules, pattern, flags, rule, error);
+}
+
+/**
+ * @brief Get the number of rules of a lexer
+ *
+ * @param lexer The lexer
+ * @return Number of rules
+ */
+size_t
+rift_lexer_get_rule_count(const rift_lexer_t *lexer)
+{
+    return lexer ? rift_pattern_set_get_count(lexer->rules) : 0;
+}
+
+/**
+ * @brief Bound the memory of a lexer's transition table
+ *
+ * @param lexer The lexer
+ * @param max_bytes The budget in bytes, 0 for none (the dense table)
+ */
+void
+rift_lexer_set_memory_budget(rift_lexer_t *lexer, size_t max_bytes)
+{
+    if (lexer) {
+        lexer->memory_budget = max_bytes;
+    }
+}
+
+/**
+ * @brief Get the lowest accept tag of a state
+ *
+ * @param state The state
+ * @return The tag, or RIFT_LEXER_NO_RULE if the state has none
+ */
+static uint32_t
+first_tag(const rift_regex_state_t *state)
+{
+    size_t num_words = 0;
+    const uint64_t *tags = rift_state_get_accept_tags(state, &num_words);
+
+    for (size_t w = 0; tags && w < num_words; w++) {
+        if (tags[w] == 0) {
+            continue;
+        }
+        uint32_t bit = 0;
+        while (!(tags[w] >> bit & 1)) {
+            bit++;
+        }
+        return (uint32_t)(w * 64 + bit);
+    }
+    return RIFT_LEXER_NO_RULE;
+}
+
+/**
+ * @brief Build the DFA of a lexer's rules
+ *
+ * @param lexer The lexer
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+bool
+rift_lexer_compile(rift_lexer_t *lexer, rift_regex_error_t *error)
+{
+    if (!lexer || rift_pattern_set_get_count(lexer->rules) == 0) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "A lexer needs at least one rule to compile");
+        }
+        return false;
+    }
+
+    discard_table(lexer);
+    if (!rift_pattern_set_compile(lexer->rules, error)) {
+        return false;
+    }
+
+    rift_regex_automaton_t *dfa =
+        rift_automaton_nfa_to_dfa(rift_pattern_set_get_automaton(lexer->rules), error);
+    rift_regex_automaton_t *minimal = dfa ? rift_hopcroft_minimize(dfa, error) : NULL;
+    rift_automaton_free(dfa);
+    if (!minimal) {
+        return false;
+    }
+
+    // Row i + 1 of the table is state i of the automaton it is compiled from
+    rift_dfa_table_t *dense = rift_dfa_table_compile(minimal, error);
+    lexer->table = dense ? rift_compact_dfa_create_with_budget(dense, lexer->memory_budget, error)
+                         : NULL;
+    rift_dfa_table_free(dense);
+    if (!lexer->table) {
+        rift_automaton_free(minimal);
+        return false;
+    }
+
+    lexer->row_rules = (uint32_t *)rift_malloc(lexer->table->num_states * sizeof(uint32_t));
+    if (!lexer->row_rules) {
+        rift_automaton_free(minimal);
+        discard_table(lexer);
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_MEMORY;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Failed to allocate lexer rows");
+        }
+        return false;
+    }
+
+    lexer->row_rules[RIFT_DFA_DEAD_STATE] = RIFT_LEXER_NO_RULE;
+    for (size_t i = 0; i < minimal->num_states; i++) {
+        lexer->row_rules[i + 1] = first_tag(minimal->states[i]);
+    }
+
+    rift_automaton_free(minimal);
+    return true;
+}
+
+/**
+ * @brief Get the token starting at an offset
+ *
+ * @param lexer The compiled lexer
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param offset Offset of the token
+ * @param token Pointer to store the token
+ * @return true if a token was stored, false at the end of the input or if
+ *         the lexer is not compiled
+ */
+bool
+rift_lexer_next(const rift_lexer_t *lexer, const char *input, size_t length, size_t offset,
+                rift_lexer_token_t *token)
+{
+    if (!lexer || !lexer->table || !input || !token || offset >= length) {
+        return false;
+    }
+
+    const rift_compact_dfa_t *table = lexer->table;
+    const unsigned char *bytes = (const unsigned char *)input;
+    uint32_t state = table->start_state;
+
+    // An unmatched byte is a token of its own, as flex's default rule makes it
+    token->rule = RIFT_LEXER_NO_RULE;
+    token->start = offset;
+    token->end = offset + 1;
+
+    // The start state is never consulted: empty matches make no tokens. Only the dead and
+    // accepting states sort below special_limit, and only accepting rows have rules.
+    for (size_t i = offset; i < length; i++) {
+        state = rift_compact_dfa_step(table, state, bytes[i]);
+        if (state >= table->special_limit) {
+            continue;
+        }
+        if (state == RIFT_DFA_DEAD_STATE) {
+            break;
+        }
+        uint32_t rule = lexer->row_rules[rift_compact_dfa_row(table, state)];
+        if (rule != RIFT_LEXER_NO_RULE) {
+            token->rule = rule;
+            token->end = i + 1;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Cut the whole input into tokens
+ *
+ * @param lexer The compiled lexer
+ * @param input The input bytes
+ * @param length Number of input bytes
+ * @param tokens Array for the tokens in input order (can be NULL)
+ * @param max_tokens Capacity of the tokens array
+ * @return Number of tokens in the input, which may exceed max_tokens, or 0
+ *         if the lexer is not compiled
+ */
+size_t
+rift_lexer_tokenize(const rift_lexer_t *lexer, const char *input, size_t length,
+                    rift_lexer_token_t *tokens, size_t max_tokens)
+{
+    size_t count = 0;
+    rift_lexer_token_t token;
+
+    for (size_t offset = 0; rift_lexer_next(lexer, input, length, offset, &token);
+         offset = token.end) {
+        if (tokens && count < max_tokens) {
+            tokens[count] = token;
+        }
+        count++;
+    }
+    return count;
+}
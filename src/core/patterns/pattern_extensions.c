@@ -28,30 +28,7 @@
 static const char *
 get_pattern_string(rift_baseline_pattern_type_t pattern_type)
 {
-    switch (pattern_type) {
-    case RIFT_BASELINE_PATTERN_EMPTY_STATE:
-        return RIFT_PATTERN_EMPTY_STATE;
-    case RIFT_BASELINE_PATTERN_WHITESPACE:
-        return RIFT_PATTERN_WHITESPACE;
-    case RIFT_BASELINE_PATTERN_WORD_BOUNDARY:
-        return RIFT_PATTERN_WORD_BOUNDARY;
-    case RIFT_BASELINE_PATTERN_IDENTIFIER:
-        return RIFT_PATTERN_IDENTIFIER;
-    case RIFT_BASELINE_PATTERN_NUMERIC:
-        return RIFT_PATTERN_NUMERIC;
-    case RIFT_BASELINE_PATTERN_STRING:
-        return RIFT_PATTERN_STRING;
-    case RIFT_BASELINE_PATTERN_COMMENT:
-        return RIFT_PATTERN_COMMENT;
-    case RIFT_BASELINE_PATTERN_OPERATOR:
-        return RIFT_PATTERN_OPERATOR;
-    case RIFT_BASELINE_PATTERN_FUNCTION:
-        return RIFT_PATTERN_FUNCTION;
-    case RIFT_BASELINE_PATTERN_STATE_TRANSITION:
-        return RIFT_PATTERN_STATE_TRANSITION;
-    default:
-        return NULL;
-    }
+    return rift_baseline_patterns_get_source(pattern_type);
 }
 
 rift_regex_pattern_t *
@@ -234,6 +211,56 @@ rift_pattern_sequence(const rift_baseline_pattern_type_t *pattern_types, size_t
     return pattern;
 }
 
+rift_lexer_t *
+rift_pattern_lexer(const rift_baseline_pattern_type_t *pattern_types, size_t num_patterns,
+                   rift_regex_flags_t flags, rift_regex_error_t *error)
+{
+    if (!pattern_types || num_patterns == 0) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Invalid parameters: pattern_types=%p, num_patterns=%zu",
+                     (void *)pattern_types, num_patterns);
+        }
+        return NULL;
+    }
+
+    rift_lexer_t *lexer = rift_lexer_create();
+    if (!lexer) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_MEMORY;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Memory allocation failed");
+        }
+        return NULL;
+    }
+
+    for (size_t i = 0; i < num_patterns; i++) {
+        const char *pattern_str = get_pattern_string(pattern_types[i]);
+        if (!pattern_str) {
+            if (error) {
+                error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+                snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                         "Invalid pattern type: %d", pattern_types[i]);
+            }
+            rift_lexer_free(lexer);
+            return NULL;
+        }
+
+        if (!rift_lexer_add_rule(lexer, pattern_str, flags | RIFT_REGEX_FLAG_RIFT_SYNTAX, NULL,
+                                 error)) {
+            rift_lexer_free(lexer);
+            return NULL;
+        }
+    }
+
+    if (!rift_lexer_compile(lexer, error)) {
+        rift_lexer_free(lexer);
+        return NULL;
+    }
+    return lexer;
+}
+
 /**
  * @brief Find a pattern name placeholder in a template string
  *
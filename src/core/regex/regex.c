@@ -246,7 +246,9 @@ rift_regex_error_init(rift_regex_error_t *error)
     }
 
     error->code = RIFT_REGEX_ERROR_NONE;
+    error->message[0] = '\0';
     error->position = 0;
+    rift_error_args_clear(&error->deferred);
     return true;
 }
 
@@ -0,0 +1,347 @@
+/**
+ * @file backtrack_stack.c
+ * @brief Implementation of the contiguous backtrack stack
+ *
+ * Frames and undo entries live in two arrays that double when full, so a
+ * push or pop is a bump of a count and allocation only happens while the
+ * stack grows past its deepest point so far.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/runtime/backtrack_stack.h"
+#include <stdlib.h>
+#include <string.h>
+#include "core/memory/memory.h"
+
+/**
+ * @brief Grow an array to hold at least one more element
+ *
+ * @param array The array, updated on success
+ * @param capacity Its capacity in elements, updated on success
+ * @param element_size Size of one element
+ * @return true if successful, false on allocation failure
+ */
+static bool
+grow_array(void **array, size_t *capacity, size_t element_size)
+{
+    size_t new_capacity = *capacity ? *capacity * 2 : RIFT_BACKTRACK_STACK_INITIAL_CAPACITY;
+    rift_memory_tag_t outer = rift_memory_tag_use(RIFT_MEMORY_TAG_BACKTRACKER);
+    void *grown = rift_realloc(*array, new_capacity * element_size);
+    rift_memory_tag_use(outer);
+    if (!grown) {
+        return false;
+    }
+
+    *array = grown;
+    *capacity = new_capacity;
+    return true;
+}
+
+/**
+ * @brief Unset every capture slot
+ *
+ * @param stack The stack
+ */
+static void
+clear_slots(rift_backtrack_stack_t *stack)
+{
+    for (size_t i = 0; i < stack->num_groups * 2; i++) {
+        stack->slots[i] = RIFT_BACKTRACK_SLOT_UNSET;
+    }
+}
+
+/**
+ * @brief Create a backtrack stack
+ *
+ * @param max_depth Maximum number of frames
+ * @param num_groups Number of capture groups
+ * @return A new stack or NULL on failure
+ */
+rift_backtrack_stack_t *
+rift_backtrack_stack_create(size_t max_depth, size_t num_groups)
+{
+    rift_backtrack_stack_t *stack = (rift_backtrack_stack_t *)rift_calloc_tagged(
+        1, sizeof(*stack), RIFT_MEMORY_TAG_BACKTRACKER);
+    if (!stack) {
+        return NULL;
+    }
+
+    stack->max_depth = max_depth;
+    stack->num_groups = num_groups;
+
+    if (num_groups > 0) {
+        stack->slots = (size_t *)rift_malloc_tagged(sizeof(size_t) * num_groups * 2,
+                                                    RIFT_MEMORY_TAG_BACKTRACKER);
+        if (!stack->slots) {
+            rift_free(stack);
+            return NULL;
+        }
+        clear_slots(stack);
+    }
+
+    return stack;
+}
+
+/**
+ * @brief Free a backtrack stack
+ *
+ * @param stack The stack to free (can be NULL)
+ */
+void
+rift_backtrack_stack_free(rift_backtrack_stack_t *stack)
+{
+    if (!stack) {
+        return;
+    }
+
+    rift_free(stack->frames);
+    rift_free(stack->undo);
+    rift_free(stack->slots);
+    rift_free(stack);
+}
+
+/**
+ * @brief Drop every frame and undo entry and unset every capture slot
+ *
+ * @param stack The stack
+ */
+void
+rift_backtrack_stack_reset(rift_backtrack_stack_t *stack)
+{
+    if (!stack) {
+        return;
+    }
+
+    stack->frame_count = 0;
+    stack->undo_count = 0;
+    clear_slots(stack);
+}
+
+/**
+ * @brief Push a frame
+ *
+ * @param stack The stack
+ * @param state State to resume from
+ * @param input_position Input position to resume at
+ * @return true if pushed, false at the maximum depth or on allocation failure
+ */
+bool
+rift_backtrack_stack_push(rift_backtrack_stack_t *stack, struct rift_regex_state *state,
+                          size_t input_position)
+{
+    if (!stack || !state || stack->frame_count >= stack->max_depth) {
+        return false;
+    }
+
+    if (stack->frame_count == stack->frame_capacity &&
+        !grow_array((void **)&stack->frames, &stack->frame_capacity,
+                    sizeof(rift_backtrack_frame_t))) {
+        return false;
+    }
+
+    rift_backtrack_frame_t *frame = &stack->frames[stack->frame_count++];
+    frame->state = state;
+    frame->input_position = input_position;
+    frame->undo_mark = stack->undo_count;
+
+    return true;
+}
+
+/**
+ * @brief Pop the top frame and roll the capture slots back to it
+ *
+ * @param stack The stack
+ * @param state Receives the state to resume from
+ * @param input_position Receives the input position to resume at
+ * @return true if a frame was popped, false if the stack was empty
+ */
+bool
+rift_backtrack_stack_pop(rift_backtrack_stack_t *stack, struct rift_regex_state **state,
+                         size_t *input_position)
+{
+    if (!stack || !state || !input_position || stack->frame_count == 0) {
+        return false;
+    }
+
+    const rift_backtrack_frame_t *frame = &stack->frames[--stack->frame_count];
+
+    // Replay the writes made since the push, newest first
+    while (stack->undo_count > frame->undo_mark) {
+        const rift_backtrack_undo_t *entry = &stack->undo[--stack->undo_count];
+        stack->slots[entry->slot] = entry->value;
+    }
+
+    *state = frame->state;
+    *input_position = frame->input_position;
+
+    return true;
+}
+
+/**
+ * @brief Write a capture slot, logging the old value for the top frame
+ *
+ * @param stack The stack
+ * @param slot Index of the slot
+ * @param value New value of the slot
+ * @return true if written, false on an invalid slot or allocation failure
+ */
+bool
+rift_backtrack_stack_set_slot(rift_backtrack_stack_t *stack, size_t slot, size_t value)
+{
+    if (!stack || slot >= stack->num_groups * 2) {
+        return false;
+    }
+
+    size_t old_value = stack->slots[slot];
+    if (old_value == value) {
+        return true;
+    }
+
+    // Without a frame nothing can roll this write back
+    if (stack->frame_count > 0) {
+        if (stack->undo_count == stack->undo_capacity &&
+            !grow_array((void **)&stack->undo, &stack->undo_capacity,
+                        sizeof(rift_backtrack_undo_t))) {
+            return false;
+        }
+
+        rift_backtrack_undo_t *entry = &stack->undo[stack->undo_count++];
+        entry->slot = slot;
+        entry->value = old_value;
+    }
+
+    stack->slots[slot] = value;
+    return true;
+}
+
+/**
+ * @brief Read a capture slot
+ *
+ * @param stack The stack
+ * @param slot Index of the slot
+ * @return The slot value, or RIFT_BACKTRACK_SLOT_UNSET for an invalid slot
+ */
+size_t
+rift_backtrack_stack_get_slot(const rift_backtrack_stack_t *stack, size_t slot)
+{
+    if (!stack || slot >= stack->num_groups * 2) {
+        return RIFT_BACKTRACK_SLOT_UNSET;
+    }
+
+    return stack->slots[slot];
+}
+
+/**
+ * @brief Check whether the stack has no frames
+ *
+ * @param stack The stack
+ * @return true if empty or NULL
+ */
+bool
+rift_backtrack_stack_is_empty(const rift_backtrack_stack_t *stack)
+{
+    return !stack || stack->frame_count == 0;
+}
+
+/**
+ * @brief Get the number of frames on the stack
+ *
+ * @param stack The stack
+ * @return The number of frames
+ */
+size_t
+rift_backtrack_stack_get_depth(const rift_backtrack_stack_t *stack)
+{
+    return stack ? stack->frame_count : 0;
+}
+
+/**
+ * @brief Drop the frames above a depth without rolling anything back
+ *
+ * @param stack The stack
+ * @param depth The depth to cut back to, at most the current depth
+ * @return true if cut, false on an invalid depth
+ */
+bool
+rift_backtrack_stack_cut(rift_backtrack_stack_t *stack, size_t depth)
+{
+    if (!stack || depth > stack->frame_count) {
+        return false;
+    }
+
+    stack->frame_count = depth;
+
+    // With no frame left, nothing can roll the logged writes back
+    if (depth == 0) {
+        stack->undo_count = 0;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Set the maximum number of frames
+ *
+ * @param stack The stack
+ * @param max_depth The new maximum
+ * @return true if successful, false otherwise
+ */
+bool
+rift_backtrack_stack_set_max_depth(rift_backtrack_stack_t *stack, size_t max_depth)
+{
+    if (!stack) {
+        return false;
+    }
+
+    stack->max_depth = max_depth;
+    return true;
+}
+
+/**
+ * @brief Copy a backtrack stack
+ *
+ * @param stack The stack to copy
+ * @return A new stack with the same frames, undo log and slots, or NULL on failure
+ */
+rift_backtrack_stack_t *
+rift_backtrack_stack_clone(const rift_backtrack_stack_t *stack)
+{
+    if (!stack) {
+        return NULL;
+    }
+
+    rift_backtrack_stack_t *clone = rift_backtrack_stack_create(stack->max_depth, stack->num_groups);
+    if (!clone) {
+        return NULL;
+    }
+
+    if (stack->frame_count > 0) {
+        clone->frames = (rift_backtrack_frame_t *)rift_malloc_tagged(
+            sizeof(rift_backtrack_frame_t) * stack->frame_count, RIFT_MEMORY_TAG_BACKTRACKER);
+        if (!clone->frames) {
+            rift_backtrack_stack_free(clone);
+            return NULL;
+        }
+        memcpy(clone->frames, stack->frames, sizeof(rift_backtrack_frame_t) * stack->frame_count);
+        clone->frame_count = clone->frame_capacity = stack->frame_count;
+    }
+
+    if (stack->undo_count > 0) {
+        clone->undo = (rift_backtrack_undo_t *)rift_malloc_tagged(
+            sizeof(rift_backtrack_undo_t) * stack->undo_count, RIFT_MEMORY_TAG_BACKTRACKER);
+        if (!clone->undo) {
+            rift_backtrack_stack_free(clone);
+            return NULL;
+        }
+        memcpy(clone->undo, stack->undo, sizeof(rift_backtrack_undo_t) * stack->undo_count);
+        clone->undo_count = clone->undo_capacity = stack->undo_count;
+    }
+
+    if (stack->num_groups > 0) {
+        memcpy(clone->slots, stack->slots, sizeof(size_t) * stack->num_groups * 2);
+    }
+
+    return clone;
+}
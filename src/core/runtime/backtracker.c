@@ -1,135 +1,132 @@
-#include "core/runtime/backtracker.h"
 /**
-core/runtime/backtracker.h"
  * @file backtracker.c
  * @brief Implementation of backtracking functionality for the LibRift regex engine
  *
- * This file implements the backtracking component of the LibRift regex engine,
- * which is essential for handling complex pattern matching scenarios that
- * require backtracking.
+ * This file implements the backtracker on top of the contiguous backtrack
+ * stack. Capture groups are written into the stack's slots before a frame is
+ * pushed, so the undo log holds only the groups that changed between two
+ * points and a pop restores exactly the groups given to its push.
  *
  * @copyright Copyright (c) 2025 LibRift Project
  * @license MIT License
  */
 
-#include "runtime/backtracker.h
+#include "core/runtime/backtracker.h"
 #include <stdlib.h>
 #include <string.h>
-#include "librift/runtime/backtracker.h"
 
+/**
+ * @brief Index of the slot holding the number of groups given to a push
+ *
+ * @param backtracker The backtracker
+ * @return The slot index, just past the group slots
+ */
+static inline size_t
+count_slot(const rift_regex_backtracker_t *backtracker)
+{
+    return backtracker->num_groups * 2;
+}
 
-static struct rift_regex_backtracker *
-create_backtracker(size_t max_depth, size_t num_groups)
+/**
+ * @brief Copy one slot into the caller's group arrays
+ *
+ * @param slot Index of the slot
+ * @param value Value of the slot
+ * @param group_starts Array of group start positions (can be NULL)
+ * @param group_ends Array of group end positions (can be NULL)
+ */
+static inline void
+store_slot(size_t slot, size_t value, size_t *group_starts, size_t *group_ends)
 {
-    struct rift_regex_backtracker *backtracker = malloc(sizeof(struct rift_regex_backtracker));
-    if (!backtracker)
-        return NULL;
+    size_t *groups = (slot & 1) ? group_ends : group_starts;
+    if (groups) {
+        groups[slot / 2] = value;
+    }
+}
 
-    /* Initialize backtracker */
-    backtracker->max_depth = max_depth;
-    backtracker->num_groups = num_groups;
+/**
+ * @brief Initialize a policy with a depth limit and no hook
+ *
+ * @param policy The policy
+ * @param max_depth Maximum depth for backtracking
+ */
+void
+rift_backtracker_policy_init(rift_backtracker_policy_t *policy, size_t max_depth)
+{
+    if (!policy) {
+        return;
+    }
 
-    return backtracker;
+    policy->max_depth = max_depth;
+    policy->bailout = NULL;
+    policy->user_data = NULL;
 }
 
 /**
- * @brief Create a new backtracker
+ * @brief Create a new backtracker with a policy
  *
- * @param max_depth Maximum depth for backtracking
+ * @param policy The policy, copied into the backtracker
  * @param num_groups Number of capturing groups
  * @return A new backtracker or NULL on failure
  */
 rift_regex_backtracker_t *
-rift_backtracker_create(size_t max_depth, size_t num_groups)
+rift_backtracker_create_with_policy(const rift_backtracker_policy_t *policy, size_t num_groups)
 {
+    if (!policy) {
+        return NULL;
+    }
+
     rift_regex_backtracker_t *backtracker =
         (rift_regex_backtracker_t *)malloc(sizeof(rift_regex_backtracker_t));
     if (!backtracker) {
         return NULL;
     }
 
-    backtracker->stack_top = NULL;
-    backtracker->current_depth = 0;
-    backtracker->max_depth = max_depth;
+    // One extra slot pair, of which the first holds the pushed group count
+    backtracker->stack = rift_backtrack_stack_create(policy->max_depth, num_groups + 1);
+    if (!backtracker->stack) {
+        free(backtracker);
+        return NULL;
+    }
+
     backtracker->num_groups = num_groups;
+    backtracker->policy = *policy;
 
     return backtracker;
 }
 
 /**
- * @brief Create a backtrack point
+ * @brief Create a new backtracker
  *
- * @param state The current state
- * @param input_position Position in the input string
- * @param group_starts Array of group start positions
- * @param group_ends Array of group end positions
- * @param num_groups Number of groups
- * @return A new backtrack point or NULL on failure
+ * @param max_depth Maximum depth for backtracking
+ * @param num_groups Number of capturing groups
+ * @return A new backtracker or NULL on failure
  */
-rift_regex_backtrack_point_t *
-rift_backtrack_point_create(rift_regex_state_t *state, size_t input_position,
-                            const size_t *group_starts, const size_t *group_ends, size_t num_groups)
+rift_regex_backtracker_t *
+rift_backtracker_create(size_t max_depth, size_t num_groups)
 {
-    if (!state || (!group_starts && num_groups > 0) || (!group_ends && num_groups > 0)) {
-        return NULL;
-    }
-
-    rift_regex_backtrack_point_t *point =
-        (rift_regex_backtrack_point_t *)malloc(sizeof(rift_regex_backtrack_point_t));
-    if (!point) {
-        return NULL;
-    }
-
-    point->state = state;
-    point->input_position = input_position;
-    point->num_groups = num_groups;
-    point->next = NULL;
-
-    // Allocate and copy group information if needed
-    if (num_groups > 0) {
-        point->group_starts = (size_t *)malloc(sizeof(size_t) * num_groups);
-        point->group_ends = (size_t *)malloc(sizeof(size_t) * num_groups);
-
-        if (!point->group_starts || !point->group_ends) {
-            if (point->group_starts)
-                free(point->group_starts);
-            if (point->group_ends)
-                free(point->group_ends);
-            free(point);
-            return NULL;
-        }
-
-        memcpy(point->group_starts, group_starts, sizeof(size_t) * num_groups);
-        memcpy(point->group_ends, group_ends, sizeof(size_t) * num_groups);
-    } else {
-        point->group_starts = NULL;
-        point->group_ends = NULL;
-    }
-
-    return point;
+    rift_backtracker_policy_t policy;
+    rift_backtracker_policy_init(&policy, max_depth);
+    return rift_backtracker_create_with_policy(&policy, num_groups);
 }
 
 /**
- * @brief Free a backtrack point
+ * @brief Replace the policy of a backtracker
  *
- * @param point The backtrack point to free
+ * @param backtracker The backtracker
+ * @param policy The new policy
+ * @return true if successful, false otherwise
  */
-void
-rift_backtrack_point_free(rift_regex_backtrack_point_t *point)
+bool
+rift_backtracker_set_policy(rift_regex_backtracker_t *backtracker,
+                            const rift_backtracker_policy_t *policy)
 {
-    if (!point) {
-        return;
-    }
-
-    if (point->group_starts) {
-        free(point->group_starts);
-    }
-
-    if (point->group_ends) {
-        free(point->group_ends);
+    if (!backtracker || !policy) {
+        return false;
     }
 
-    free(point);
+    backtracker->policy = *policy;
+    return rift_backtrack_stack_set_max_depth(backtracker->stack, policy->max_depth);
 }
 
 /**
@@ -148,29 +145,36 @@ rift_backtracker_push(rift_regex_backtracker_t *backtracker, rift_regex_state_t
                       size_t input_position, const size_t *group_starts, const size_t *group_ends,
                       size_t num_groups)
 {
-    if (!backtracker || !state) {
+    if (!backtracker || !state || num_groups > backtracker->num_groups ||
+        (num_groups > 0 && (!group_starts || !group_ends))) {
         return false;
     }
 
-    // Check if we've reached the maximum depth
-    if (backtracker->current_depth >= backtracker->max_depth) {
+    rift_backtrack_stack_t *stack = backtracker->stack;
+
+    // Check the limit before touching the slots, which the caller may not roll back
+    if (stack->frame_count >= stack->max_depth) {
+#if RIFT_BACKTRACKER_BAILOUT_HOOKS
+        if (backtracker->policy.bailout) {
+            backtracker->policy.bailout(backtracker, stack->frame_count,
+                                        backtracker->policy.user_data);
+        }
+#endif
         return false;
     }
 
-    // Create a new backtrack point
-    rift_regex_backtrack_point_t *point =
-        rift_backtrack_point_create(state, input_position, group_starts, group_ends, num_groups);
-
-    if (!point) {
+    // Writes are logged against the frame below, so popping it undoes them
+    for (size_t i = 0; i < num_groups; i++) {
+        if (!rift_backtrack_stack_set_slot(stack, 2 * i, group_starts[i]) ||
+            !rift_backtrack_stack_set_slot(stack, 2 * i + 1, group_ends[i])) {
+            return false;
+        }
+    }
+    if (!rift_backtrack_stack_set_slot(stack, count_slot(backtracker), num_groups)) {
         return false;
     }
 
-    // Push the point onto the stack
-    point->next = backtracker->stack_top;
-    backtracker->stack_top = point;
-    backtracker->current_depth++;
-
-    return true;
+    return rift_backtrack_stack_push(stack, state, input_position);
 }
 
 /**
@@ -193,40 +197,89 @@ rift_backtracker_pop(rift_regex_backtracker_t *backtracker, rift_regex_state_t *
         return false;
     }
 
-    // Check if the stack is empty
-    if (!backtracker->stack_top) {
+    if (!rift_backtrack_stack_pop(backtracker->stack, state, input_position)) {
         return false;
     }
 
-    // Get the top point
-    rift_regex_backtrack_point_t *point = backtracker->stack_top;
+    // The slots are now as they were when the point was pushed
+    *num_groups = rift_backtrack_stack_get_slot(backtracker->stack, count_slot(backtracker));
+    for (size_t slot = 0; slot < *num_groups * 2; slot++) {
+        store_slot(slot, backtracker->stack->slots[slot], group_starts, group_ends);
+    }
 
-    // Extract information
-    *state = point->state;
-    *input_position = point->input_position;
-    *num_groups = point->num_groups;
+    return true;
+}
 
-    // Copy group information if needed
-    if (point->num_groups > 0) {
-        if (group_starts && point->group_starts) {
-            memcpy(group_starts, point->group_starts, sizeof(size_t) * point->num_groups);
-        }
+/**
+ * @brief Peek at the top backtrack point without removing it
+ *
+ * The slots may have moved on since the top point was pushed, so its groups
+ * are rebuilt by replaying the undo entries logged since then onto a copy.
+ *
+ * @param backtracker The backtracker
+ * @param state Pointer to store the state
+ * @param input_position Pointer to store the input position
+ * @param group_starts Array to store group start positions
+ * @param group_ends Array to store group end positions
+ * @param num_groups Pointer to store the number of groups
+ * @return true if a point was peeked, false if the stack was empty
+ */
+bool
+rift_backtracker_peek(const rift_regex_backtracker_t *backtracker, rift_regex_state_t **state,
+                      size_t *input_position, size_t *group_starts, size_t *group_ends,
+                      size_t *num_groups)
+{
+    if (!backtracker || !state || !input_position || !num_groups) {
+        return false;
+    }
 
-        if (group_ends && point->group_ends) {
-            memcpy(group_ends, point->group_ends, sizeof(size_t) * point->num_groups);
+    const rift_backtrack_stack_t *stack = backtracker->stack;
+    if (stack->frame_count == 0) {
+        return false;
+    }
+
+    const rift_backtrack_frame_t *frame = &stack->frames[stack->frame_count - 1];
+    size_t count = stack->slots[count_slot(backtracker)];
+    for (size_t i = stack->undo_count; i > frame->undo_mark; i--) {
+        if (stack->undo[i - 1].slot == count_slot(backtracker)) {
+            count = stack->undo[i - 1].value;
         }
     }
 
-    // Pop the point
-    backtracker->stack_top = point->next;
-    backtracker->current_depth--;
+    for (size_t slot = 0; slot < count * 2; slot++) {
+        store_slot(slot, stack->slots[slot], group_starts, group_ends);
+    }
+    for (size_t i = stack->undo_count; i > frame->undo_mark; i--) {
+        const rift_backtrack_undo_t *entry = &stack->undo[i - 1];
+        if (entry->slot < count * 2) {
+            store_slot(entry->slot, entry->value, group_starts, group_ends);
+        }
+    }
 
-    // Free the point
-    rift_backtrack_point_free(point);
+    *state = frame->state;
+    *input_position = frame->input_position;
+    *num_groups = count;
 
     return true;
 }
 
+/**
+ * @brief Discard the backtrack points pushed above a depth
+ *
+ * @param backtracker The backtracker
+ * @param depth The depth at the entry of the atomic region
+ * @return true if cut, false on an invalid depth
+ */
+bool
+rift_backtracker_cut(rift_regex_backtracker_t *backtracker, size_t depth)
+{
+    if (!backtracker) {
+        return false;
+    }
+
+    return rift_backtrack_stack_cut(backtracker->stack, depth);
+}
+
 /**
  * @brief Check if the backtracker stack is empty
  *
@@ -240,12 +293,14 @@ rift_backtracker_is_empty(const rift_regex_backtracker_t *backtracker)
         return true;
     }
 
-    return backtracker->stack_top == NULL;
+    return rift_backtrack_stack_is_empty(backtracker->stack);
 }
 
 /**
  * @brief Reset the backtracker
  *
+ * The stack keeps its capacity, so a reused backtracker does not allocate.
+ *
  * @param backtracker The backtracker to reset
  */
 void
@@ -255,14 +310,7 @@ rift_backtracker_reset(rift_regex_backtracker_t *backtracker)
         return;
     }
 
-    // Free all backtrack points
-    while (backtracker->stack_top) {
-        rift_regex_backtrack_point_t *point = backtracker->stack_top;
-        backtracker->stack_top = point->next;
-        rift_backtrack_point_free(point);
-    }
-
-    backtracker->current_depth = 0;
+    rift_backtrack_stack_reset(backtracker->stack);
 }
 
 /**
@@ -278,7 +326,7 @@ rift_backtracker_get_depth(const rift_regex_backtracker_t *backtracker)
         return 0;
     }
 
-    return backtracker->current_depth;
+    return rift_backtrack_stack_get_depth(backtracker->stack);
 }
 
 /**
@@ -294,7 +342,7 @@ rift_backtracker_get_max_depth(const rift_regex_backtracker_t *backtracker)
         return 0;
     }
 
-    return backtracker->max_depth;
+    return backtracker->policy.max_depth;
 }
 
 /**
@@ -311,55 +359,24 @@ rift_backtracker_set_max_depth(rift_regex_backtracker_t *backtracker, size_t max
         return false;
     }
 
-    backtracker->max_depth = max_depth;
-    return true;
+    backtracker->policy.max_depth = max_depth;
+    return rift_backtrack_stack_set_max_depth(backtracker->stack, max_depth);
 }
 
 /**
- * @brief Peek at the top backtrack point without removing it
+ * @brief Get the number of capture groups of a backtracker
  *
  * @param backtracker The backtracker
- * @param state Pointer to store the state
- * @param input_position Pointer to store the input position
- * @param group_starts Array to store group start positions
- * @param group_ends Array to store group end positions
- * @param num_groups Pointer to store the number of groups
- * @return true if a point was peeked, false if the stack was empty
+ * @return The number of groups, or 0 for NULL
  */
-bool
-rift_backtracker_peek(const rift_regex_backtracker_t *backtracker, rift_regex_state_t **state,
-                      size_t *input_position, size_t *group_starts, size_t *group_ends,
-                      size_t *num_groups)
+size_t
+rift_backtracker_get_num_groups(const rift_regex_backtracker_t *backtracker)
 {
-    if (!backtracker || !state || !input_position || !num_groups) {
-        return false;
-    }
-
-    // Check if the stack is empty
-    if (!backtracker->stack_top) {
-        return false;
-    }
-
-    // Get the top point
-    rift_regex_backtrack_point_t *point = backtracker->stack_top;
-
-    // Extract information
-    *state = point->state;
-    *input_position = point->input_position;
-    *num_groups = point->num_groups;
-
-    // Copy group information if needed
-    if (point->num_groups > 0) {
-        if (group_starts && point->group_starts) {
-            memcpy(group_starts, point->group_starts, sizeof(size_t) * point->num_groups);
-        }
-
-        if (group_ends && point->group_ends) {
-            memcpy(group_ends, point->group_ends, sizeof(size_t) * point->num_groups);
-        }
+    if (!backtracker) {
+        return 0;
     }
 
-    return true;
+    return backtracker->num_groups;
 }
 
 /**
@@ -375,57 +392,21 @@ rift_backtracker_clone(const rift_regex_backtracker_t *backtracker)
         return NULL;
     }
 
-    // Create a new backtracker
     rift_regex_backtracker_t *clone =
-        rift_backtracker_create(backtracker->max_depth, backtracker->num_groups);
-
+        (rift_regex_backtracker_t *)malloc(sizeof(rift_regex_backtracker_t));
     if (!clone) {
         return NULL;
     }
 
-    // Clone the stack if not empty
-    if (backtracker->stack_top) {
-        // Start from the bottom of the stack
-        rift_regex_backtrack_point_t **points = NULL;
-        size_t count = 0;
-        rift_regex_backtrack_point_t *current = backtracker->stack_top;
-
-        // Count the points
-        while (current) {
-            count++;
-            current = current->next;
-        }
-
-        // Allocate an array to store the points in reverse order
-        points =
-            (rift_regex_backtrack_point_t **)malloc(sizeof(rift_regex_backtrack_point_t *) * count);
-        if (!points) {
-            rift_backtracker_free(clone);
-            return NULL;
-        }
-
-        // Fill the array
-        current = backtracker->stack_top;
-        for (size_t i = 0; i < count; i++) {
-            points[i] = current;
-            current = current->next;
-        }
-
-        // Push the points onto the new stack in reverse order
-        for (size_t i = count; i > 0; i--) {
-            rift_regex_backtrack_point_t *point = points[i - 1];
-
-            if (!rift_backtracker_push(clone, point->state, point->input_position,
-                                       point->group_starts, point->group_ends, point->num_groups)) {
-                free(points);
-                rift_backtracker_free(clone);
-                return NULL;
-            }
-        }
-
-        free(points);
+    clone->stack = rift_backtrack_stack_clone(backtracker->stack);
+    if (!clone->stack) {
+        free(clone);
+        return NULL;
     }
 
+    clone->num_groups = backtracker->num_groups;
+    clone->policy = backtracker->policy;
+
     return clone;
 }
 
@@ -441,9 +422,6 @@ rift_backtracker_free(rift_regex_backtracker_t *backtracker)
         return;
     }
 
-    // Reset the backtracker to free all points
-    rift_backtracker_reset(backtracker);
-
-    // Free the backtracker itself
+    rift_backtrack_stack_free(backtracker->stack);
     free(backtracker);
 }
@@ -1,1083 +0,0 @@
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-#include "core/runtime/backtracker_backtracker_safe_backtracker.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/backtracker_backtracker_safe_backtracker.h"/a #include "core/errors/regex_error.h"
@@ -1,47 +1,237 @@
-#include "core/runtime/backtracker_limit_registry.h"
+/**
+ * @file backtracker_limit_registry.c
+ * @brief Implementation of the backtracking limit registry
+ *
+ * Writers take the registry mutex, update the registered scopes and publish
+ * a new immutable snapshot with the scopes sorted by identifier. Readers load
+ * the snapshot pointer and binary search it without locking. Configuration
+ * changes are rare, so replaced snapshots are kept until the registry is
+ * freed instead of tracking when the last reader has left them.
+ *
+ * Telemetry is written on every recorded search rather than on rare
+ * configuration changes, so it is kept apart from the snapshots: a sorted
+ * table of per-pattern totals behind a lock that only recording matchers
+ * take.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
 
-#include "runtime/backtracker_limit_registry.h
+#include "core/runtime/backtracker_limit_registry.h"
+#include <pthread.h>
+#include <stdatomic.h>
 #include <stdlib.h>
 #include <string.h>
-core/runtime/backtracker_limit_registry.h
-core/config/backtracker_limit_registry.h"
+#include "core/config/backtracker_limit_registry.h"
+
+/**
+ * @brief Limits registered for one scope
+ */
+typedef struct rift_backtrack_limit_entry {
+    uint32_t id;               /**< Pattern or match identifier */
+    bool override_parent;      /**< Whether to override the parent scope */
+    uint32_t max_depth;        /**< Maximum backtracking depth */
+    uint32_t max_duration_ms;  /**< Maximum time in milliseconds */
+    uint64_t max_transitions;  /**< Maximum state transitions */
+    uint64_t max_memory_bytes; /**< Memory budget of a match's engines */
+} rift_backtrack_limit_entry_t;
+
+/**
+ * @brief Immutable view of the registry published to readers
+ *
+ * The pattern and match entries follow the structure, sorted by identifier.
+ */
+typedef struct rift_backtrack_limit_snapshot {
+    uint64_t generation;                           /**< Number of changes published */
+    rift_backtrack_limit_entry_t global;           /**< Global limits */
+    const rift_backtrack_limit_entry_t *patterns;  /**< Pattern entries */
+    size_t pattern_count;                          /**< Number of pattern entries */
+    const rift_backtrack_limit_entry_t *matches;   /**< Match entries */
+    size_t match_count;                            /**< Number of match entries */
+    struct rift_backtrack_limit_snapshot *retired; /**< Older snapshot, freed with the registry */
+} rift_backtrack_limit_snapshot_t;
+
+/**
+ * @brief Telemetry totals of one pattern
+ */
+typedef struct rift_backtrack_pattern_stats {
+    uint32_t id;              /**< Pattern identifier */
+    rift_match_stats_t stats; /**< Totals of the recorded searches */
+} rift_backtrack_pattern_stats_t;
+
 struct rift_backtrack_limit_registry {
-    rift_backtrack_limit_config_t *global_config;
-    struct {
-        uint32_t pattern_id;
-        rift_backtrack_limit_config_t *config;
-    } *pattern_configs;
+    pthread_mutex_t write_lock;                       /**< Serializes writers */
+    _Atomic(rift_backtrack_limit_snapshot_t *) snapshot; /**< Current snapshot */
+    rift_backtrack_limit_entry_t global;              /**< Global limits */
+    rift_backtrack_limit_entry_t *pattern_configs;    /**< Pattern entries, unsorted */
     size_t pattern_config_count;
     size_t pattern_config_capacity;
-
-    struct {
-        uint32_t match_id;
-        rift_backtrack_limit_config_t *config;
-    } *match_configs;
+    rift_backtrack_limit_entry_t *match_configs;      /**< Match entries, unsorted */
     size_t match_config_count;
     size_t match_config_capacity;
+    pthread_mutex_t stats_lock;                       /**< Guards the telemetry table */
+    rift_backtrack_pattern_stats_t *pattern_stats;    /**< Telemetry, sorted by identifier */
+    size_t pattern_stats_count;
+    size_t pattern_stats_capacity;
 };
 
+/**
+ * @brief Order entries by identifier
+ */
+static int
+compare_entries(const void *a, const void *b)
+{
+    uint32_t id_a = ((const rift_backtrack_limit_entry_t *)a)->id;
+    uint32_t id_b = ((const rift_backtrack_limit_entry_t *)b)->id;
+    return (id_a > id_b) - (id_a < id_b);
+}
+
+/**
+ * @brief Find an entry in a sorted array
+ */
+static const rift_backtrack_limit_entry_t *
+find_entry(const rift_backtrack_limit_entry_t *entries, size_t count, uint32_t id)
+{
+    size_t low = 0;
+    size_t high = count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (entries[mid].id < id) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low < count && entries[low].id == id ? &entries[low] : NULL;
+}
+
+/**
+ * @brief Build and publish a snapshot of the registered scopes
+ *
+ * Must be called with the write lock held.
+ *
+ * @param registry The registry
+ * @return true if successful, false on allocation failure
+ */
+static bool
+publish_snapshot(rift_backtrack_limit_registry_t *registry)
+{
+    size_t entry_count = registry->pattern_config_count + registry->match_config_count;
+    rift_backtrack_limit_snapshot_t *snapshot = (rift_backtrack_limit_snapshot_t *)malloc(
+        sizeof(*snapshot) + entry_count * sizeof(rift_backtrack_limit_entry_t));
+    if (!snapshot) {
+        return false;
+    }
+
+    rift_backtrack_limit_entry_t *entries = (rift_backtrack_limit_entry_t *)(snapshot + 1);
+    if (registry->pattern_config_count > 0) {
+        memcpy(entries, registry->pattern_configs,
+               registry->pattern_config_count * sizeof(rift_backtrack_limit_entry_t));
+    }
+    if (registry->match_config_count > 0) {
+        memcpy(entries + registry->pattern_config_count, registry->match_configs,
+               registry->match_config_count * sizeof(rift_backtrack_limit_entry_t));
+    }
+    qsort(entries, registry->pattern_config_count, sizeof(*entries), compare_entries);
+    qsort(entries + registry->pattern_config_count, registry->match_config_count,
+          sizeof(*entries), compare_entries);
+
+    rift_backtrack_limit_snapshot_t *previous =
+        atomic_load_explicit(&registry->snapshot, memory_order_relaxed);
+
+    snapshot->generation = previous ? previous->generation + 1 : 1;
+    snapshot->global = registry->global;
+    snapshot->patterns = entries;
+    snapshot->pattern_count = registry->pattern_config_count;
+    snapshot->matches = entries + registry->pattern_config_count;
+    snapshot->match_count = registry->match_config_count;
+    snapshot->retired = previous;
+
+    atomic_store_explicit(&registry->snapshot, snapshot, memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Insert or replace an entry in an unsorted array
+ *
+ * @param entries The array, updated when it grows
+ * @param count Its number of entries
+ * @param capacity Its capacity
+ * @param entry The entry to store
+ * @return true if successful, false on allocation failure
+ */
+static bool
+store_entry(rift_backtrack_limit_entry_t **entries, size_t *count, size_t *capacity,
+            const rift_backtrack_limit_entry_t *entry)
+{
+    for (size_t i = 0; i < *count; i++) {
+        if ((*entries)[i].id == entry->id) {
+            (*entries)[i] = *entry;
+            return true;
+        }
+    }
+
+    if (*count >= *capacity) {
+        size_t new_capacity = *capacity == 0 ? 8 : *capacity * 2;
+        void *new_array = realloc(*entries, new_capacity * sizeof(**entries));
+        if (!new_array) {
+            return false;
+        }
+
+        *entries = new_array;
+        *capacity = new_capacity;
+    }
+
+    (*entries)[(*count)++] = *entry;
+    return true;
+}
+
+/**
+ * @brief Copy the limits of a configuration into an entry
+ */
+static rift_backtrack_limit_entry_t
+entry_from_config(uint32_t id, const rift_backtrack_limit_config_t *config)
+{
+    rift_backtrack_limit_entry_t entry;
+    entry.id = id;
+    entry.override_parent = config->override_parent;
+    entry.max_depth = config->max_depth;
+    entry.max_duration_ms = config->max_duration_ms;
+    entry.max_transitions = config->max_transitions;
+    entry.max_memory_bytes = config->max_memory_bytes;
+    return entry;
+}
+
 rift_backtrack_limit_registry_t *
 rift_backtrack_limit_registry_create(void)
 {
     rift_backtrack_limit_registry_t *registry =
-        (rift_backtrack_limit_registry_t *)malloc(sizeof(rift_backtrack_limit_registry_t));
+        (rift_backtrack_limit_registry_t *)calloc(1, sizeof(rift_backtrack_limit_registry_t));
+    if (!registry) {
+        return NULL;
+    }
 
-    if (registry) {
-        registry->global_config =
-            rift_backtrack_limit_config_create_global(1000,  // Default max depth
-                                                      5000,  // Default max duration (5 seconds)
-                                                      100000 // Default max transitions
-            );
+    registry->global.override_parent = true;
+    registry->global.max_depth = 1000;         // Default max depth
+    registry->global.max_duration_ms = 5000;   // Default max duration (5 seconds)
+    registry->global.max_transitions = 100000; // Default max transitions
+    atomic_init(&registry->snapshot, NULL);
 
-        registry->pattern_configs = NULL;
-        registry->pattern_config_count = 0;
-        registry->pattern_config_capacity = 0;
+    if (pthread_mutex_init(&registry->write_lock, NULL) != 0) {
+        free(registry);
+        return NULL;
+    }
+    if (pthread_mutex_init(&registry->stats_lock, NULL) != 0) {
+        pthread_mutex_destroy(&registry->write_lock);
+        free(registry);
+        return NULL;
+    }
 
-        registry->match_configs = NULL;
-        registry->match_config_count = 0;
-        registry->match_config_capacity = 0;
+    if (!publish_snapshot(registry)) {
+        pthread_mutex_destroy(&registry->stats_lock);
+        pthread_mutex_destroy(&registry->write_lock);
+        free(registry);
+        return NULL;
     }
 
     return registry;
@@ -51,164 +241,276 @@ bool
 rift_backtrack_limit_registry_set_global(rift_backtrack_limit_registry_t *registry,
                                          const rift_backtrack_limit_config_t *config)
 {
-
     if (!registry || !config || config->scope != RIFT_BACKTRACK_SCOPE_GLOBAL) {
         return false;
     }
 
-    if (registry->global_config) {
-        rift_backtrack_limit_config_free(registry->global_config);
-    }
+    pthread_mutex_lock(&registry->write_lock);
+    rift_backtrack_limit_entry_t previous = registry->global;
+    registry->global = entry_from_config(0, config);
+    registry->global.override_parent = true;
 
-    // Make a copy of the configuration
-    registry->global_config = rift_backtrack_limit_config_create_global(
-        config->max_depth, config->max_duration_ms, config->max_transitions);
+    bool published = publish_snapshot(registry);
+    if (!published) {
+        registry->global = previous;
+    }
+    pthread_mutex_unlock(&registry->write_lock);
 
-    return registry->global_config != NULL;
+    return published;
 }
 
-// Implementation of pattern registry functions
 bool
 rift_backtrack_limit_registry_register_pattern(rift_backtrack_limit_registry_t *registry,
                                                uint32_t pattern_id,
                                                const rift_backtrack_limit_config_t *config)
 {
-
     if (!registry || !config || config->scope != RIFT_BACKTRACK_SCOPE_PATTERN) {
         return false;
     }
 
-    // Check if we need to expand capacity
-    if (registry->pattern_config_count >= registry->pattern_config_capacity) {
-        size_t new_capacity =
-            registry->pattern_config_capacity == 0 ? 8 : registry->pattern_config_capacity * 2;
+    rift_backtrack_limit_entry_t entry = entry_from_config(pattern_id, config);
 
-        void *new_array =
-            realloc(registry->pattern_configs, new_capacity * sizeof(*registry->pattern_configs));
+    pthread_mutex_lock(&registry->write_lock);
+    bool stored = store_entry(&registry->pattern_configs, &registry->pattern_config_count,
+                              &registry->pattern_config_capacity, &entry) &&
+                  publish_snapshot(registry);
+    pthread_mutex_unlock(&registry->write_lock);
 
-        if (!new_array) {
-            return false;
-        }
+    return stored;
+}
 
-        registry->pattern_configs = new_array;
-        registry->pattern_config_capacity = new_capacity;
+bool
+rift_backtrack_limit_registry_register_match(rift_backtrack_limit_registry_t *registry,
+                                             uint32_t match_id,
+                                             const rift_backtrack_limit_config_t *config)
+{
+    if (!registry || !config || config->scope != RIFT_BACKTRACK_SCOPE_MATCH) {
+        return false;
     }
 
-    // Check if pattern already exists
-    for (size_t i = 0; i < registry->pattern_config_count; i++) {
-        if (registry->pattern_configs[i].pattern_id == pattern_id) {
-            // Replace existing configuration
-            rift_backtrack_limit_config_free(registry->pattern_configs[i].config);
+    rift_backtrack_limit_entry_t entry = entry_from_config(match_id, config);
 
-            registry->pattern_configs[i].config = rift_backtrack_limit_config_create_pattern(
-                pattern_id, config->override_parent, config->max_depth, config->max_duration_ms,
-                config->max_transitions);
+    pthread_mutex_lock(&registry->write_lock);
+    bool stored = store_entry(&registry->match_configs, &registry->match_config_count,
+                              &registry->match_config_capacity, &entry) &&
+                  publish_snapshot(registry);
+    pthread_mutex_unlock(&registry->write_lock);
 
-            return registry->pattern_configs[i].config != NULL;
-        }
+    return stored;
+}
+
+bool
+rift_backtrack_limit_registry_resolve(const rift_backtrack_limit_registry_t *registry,
+                                      uint32_t pattern_id, uint32_t match_id,
+                                      rift_backtrack_limits_t *limits)
+{
+    if (!registry || !limits) {
+        return false;
     }
 
-    // Add new pattern configuration
-    registry->pattern_configs[registry->pattern_config_count].pattern_id = pattern_id;
-    registry->pattern_configs[registry->pattern_config_count].config =
-        rift_backtrack_limit_config_create_pattern(pattern_id, config->override_parent,
-                                                   config->max_depth, config->max_duration_ms,
-                                                   config->max_transitions);
+    // The snapshot is never modified once published, so no lock is needed
+    const rift_backtrack_limit_snapshot_t *snapshot =
+        atomic_load_explicit(&((rift_backtrack_limit_registry_t *)registry)->snapshot,
+                             memory_order_acquire);
 
-    if (!registry->pattern_configs[registry->pattern_config_count].config) {
-        return false;
+    // Start with global config as base
+    limits->max_depth = snapshot->global.max_depth;
+    limits->max_duration_ms = snapshot->global.max_duration_ms;
+    limits->max_transitions = snapshot->global.max_transitions;
+    limits->max_memory_bytes = snapshot->global.max_memory_bytes;
+    limits->generation = snapshot->generation;
+
+    // Apply pattern-specific, then match-specific overrides
+    const rift_backtrack_limit_entry_t *scopes[2] = {
+        find_entry(snapshot->patterns, snapshot->pattern_count, pattern_id),
+        find_entry(snapshot->matches, snapshot->match_count, match_id)};
+
+    for (size_t i = 0; i < 2; i++) {
+        if (scopes[i] && scopes[i]->override_parent) {
+            limits->max_depth = scopes[i]->max_depth;
+            limits->max_duration_ms = scopes[i]->max_duration_ms;
+            limits->max_transitions = scopes[i]->max_transitions;
+            limits->max_memory_bytes = scopes[i]->max_memory_bytes;
+        }
     }
 
-    registry->pattern_config_count++;
     return true;
 }
 
-// Implementation of match registry functions (similar to pattern)
-bool
-rift_backtrack_limit_registry_register_match(rift_backtrack_limit_registry_t *registry,
-                                             uint32_t match_id,
-                                             const rift_backtrack_limit_config_t *config)
+uint64_t
+rift_backtrack_limit_registry_get_generation(const rift_backtrack_limit_registry_t *registry)
 {
-    // Similar to register_pattern implementation
-    // ...
-    return true;
+    if (!registry) {
+        return 0;
+    }
+
+    const rift_backtrack_limit_snapshot_t *snapshot =
+        atomic_load_explicit(&((rift_backtrack_limit_registry_t *)registry)->snapshot,
+                             memory_order_acquire);
+    return snapshot->generation;
 }
 
 rift_backtrack_limit_config_t *
 rift_backtrack_limit_registry_get_effective_config(const rift_backtrack_limit_registry_t *registry,
                                                    uint32_t pattern_id, uint32_t match_id)
 {
-
-    if (!registry) {
+    rift_backtrack_limits_t limits;
+    if (!rift_backtrack_limit_registry_resolve(registry, pattern_id, match_id, &limits)) {
         return NULL;
     }
 
-    // Start with global config as base
-    rift_backtrack_limit_config_t *effective_config = rift_backtrack_limit_config_create_global(
-        registry->global_config->max_depth, registry->global_config->max_duration_ms,
-        registry->global_config->max_transitions);
+    rift_backtrack_limit_config_t *config = rift_backtrack_limit_config_create_global(
+        limits.max_depth, limits.max_duration_ms, limits.max_transitions);
+    if (config) {
+        config->max_memory_bytes = limits.max_memory_bytes;
+    }
+    return config;
+}
 
-    if (!effective_config) {
-        return NULL;
+/**
+ * @brief Find the position of a pattern in the telemetry table
+ *
+ * Must be called with the stats lock held.
+ *
+ * @return The index of the pattern, or where it would be inserted
+ */
+static size_t
+find_pattern_stats(const rift_backtrack_limit_registry_t *registry, uint32_t id)
+{
+    size_t low = 0;
+    size_t high = registry->pattern_stats_count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (registry->pattern_stats[mid].id < id) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
     }
+    return low;
+}
 
-    // Apply pattern-specific overrides if applicable
-    for (size_t i = 0; i < registry->pattern_config_count; i++) {
-        if (registry->pattern_configs[i].pattern_id == pattern_id) {
-            rift_backtrack_limit_config_t *pattern_config = registry->pattern_configs[i].config;
+bool
+rift_backtrack_limit_registry_record_stats(const rift_backtrack_limit_registry_t *registry,
+                                           uint32_t pattern_id, const rift_match_stats_t *stats)
+{
+    if (!registry || !stats) {
+        return false;
+    }
 
-            if (pattern_config->override_parent) {
-                effective_config->max_depth = pattern_config->max_depth;
-                effective_config->max_duration_ms = pattern_config->max_duration_ms;
-                effective_config->max_transitions = pattern_config->max_transitions;
+    // Only the telemetry is written, never the limits readers rely on
+    rift_backtrack_limit_registry_t *writable = (rift_backtrack_limit_registry_t *)registry;
+    bool recorded = true;
+
+    pthread_mutex_lock(&writable->stats_lock);
+    size_t index = find_pattern_stats(writable, pattern_id);
+    if (index == writable->pattern_stats_count ||
+        writable->pattern_stats[index].id != pattern_id) {
+        if (writable->pattern_stats_count >= writable->pattern_stats_capacity) {
+            size_t new_capacity =
+                writable->pattern_stats_capacity == 0 ? 8 : writable->pattern_stats_capacity * 2;
+            void *new_array =
+                realloc(writable->pattern_stats, new_capacity * sizeof(*writable->pattern_stats));
+            if (!new_array) {
+                recorded = false;
+            } else {
+                writable->pattern_stats = new_array;
+                writable->pattern_stats_capacity = new_capacity;
             }
+        }
 
-            break;
+        if (recorded) {
+            memmove(&writable->pattern_stats[index + 1], &writable->pattern_stats[index],
+                    (writable->pattern_stats_count - index) * sizeof(*writable->pattern_stats));
+            writable->pattern_stats_count++;
+            writable->pattern_stats[index].id = pattern_id;
+            rift_match_stats_reset(&writable->pattern_stats[index].stats);
         }
     }
 
-    // Apply match-specific overrides if applicable
-    for (size_t i = 0; i < registry->match_config_count; i++) {
-        if (registry->match_configs[i].match_id == match_id) {
-            rift_backtrack_limit_config_t *match_config = registry->match_configs[i].config;
+    if (recorded) {
+        rift_match_stats_merge(&writable->pattern_stats[index].stats, stats);
+    }
+    pthread_mutex_unlock(&writable->stats_lock);
 
-            if (match_config->override_parent) {
-                effective_config->max_depth = match_config->max_depth;
-                effective_config->max_duration_ms = match_config->max_duration_ms;
-                effective_config->max_transitions = match_config->max_transitions;
-            }
+    return recorded;
+}
 
-            break;
-        }
+bool
+rift_backtrack_limit_registry_get_pattern_stats(const rift_backtrack_limit_registry_t *registry,
+                                                uint32_t pattern_id, rift_match_stats_t *stats)
+{
+    if (!registry || !stats) {
+        return false;
+    }
+
+    rift_backtrack_limit_registry_t *writable = (rift_backtrack_limit_registry_t *)registry;
+    rift_match_stats_reset(stats);
+
+    pthread_mutex_lock(&writable->stats_lock);
+    size_t index = find_pattern_stats(writable, pattern_id);
+    bool found = index < writable->pattern_stats_count &&
+                 writable->pattern_stats[index].id == pattern_id;
+    if (found) {
+        *stats = writable->pattern_stats[index].stats;
+    }
+    pthread_mutex_unlock(&writable->stats_lock);
+
+    return found;
+}
+
+size_t
+rift_backtrack_limit_registry_get_stats_patterns(const rift_backtrack_limit_registry_t *registry,
+                                                 uint32_t *pattern_ids, size_t max_ids)
+{
+    if (!registry || (!pattern_ids && max_ids > 0)) {
+        return 0;
     }
 
-    return effective_config;
+    rift_backtrack_limit_registry_t *writable = (rift_backtrack_limit_registry_t *)registry;
+
+    pthread_mutex_lock(&writable->stats_lock);
+    size_t count = writable->pattern_stats_count;
+    for (size_t i = 0; i < count && i < max_ids; i++) {
+        pattern_ids[i] = writable->pattern_stats[i].id;
+    }
+    pthread_mutex_unlock(&writable->stats_lock);
+
+    return count;
 }
 
 void
-rift_backtrack_limit_registry_free(rift_backtrack_limit_registry_t *registry)
+rift_backtrack_limit_registry_reset_stats(rift_backtrack_limit_registry_t *registry)
 {
     if (!registry) {
         return;
     }
 
-    // Free global config
-    if (registry->global_config) {
-        rift_backtrack_limit_config_free(registry->global_config);
-    }
+    pthread_mutex_lock(&registry->stats_lock);
+    registry->pattern_stats_count = 0;
+    pthread_mutex_unlock(&registry->stats_lock);
+}
 
-    // Free pattern configs
-    for (size_t i = 0; i < registry->pattern_config_count; i++) {
-        rift_backtrack_limit_config_free(registry->pattern_configs[i].config);
+void
+rift_backtrack_limit_registry_free(rift_backtrack_limit_registry_t *registry)
+{
+    if (!registry) {
+        return;
     }
-    free(registry->pattern_configs);
 
-    // Free match configs
-    for (size_t i = 0; i < registry->match_config_count; i++) {
-        rift_backtrack_limit_config_free(registry->match_configs[i].config);
+    // Free the current snapshot and every one it replaced
+    rift_backtrack_limit_snapshot_t *snapshot =
+        atomic_load_explicit(&registry->snapshot, memory_order_relaxed);
+    while (snapshot) {
+        rift_backtrack_limit_snapshot_t *retired = snapshot->retired;
+        free(snapshot);
+        snapshot = retired;
     }
-    free(registry->match_configs);
 
+    pthread_mutex_destroy(&registry->write_lock);
+    pthread_mutex_destroy(&registry->stats_lock);
+    free(registry->pattern_configs);
+    free(registry->match_configs);
+    free(registry->pattern_stats);
     free(registry);
 }
-y itself free(registry);
\ No newline at end of file
@@ -34,9 +34,9 @@ rift_matcher_context_create(const char *input, size_t input_length, size_t max_c
         input_length = strlen(input);
     }
 
-    // Allocate the context structure
+    // Allocate the context structure from its pool
     rift_regex_matcher_context_t *context =
-        (rift_regex_matcher_context_t *)rift_malloc(sizeof(rift_regex_matcher_context_t));
+        (rift_regex_matcher_context_t *)rift_pool_alloc(sizeof(rift_regex_matcher_context_t));
     if (!context) {
         return NULL;
     }
@@ -53,7 +53,7 @@ rift_matcher_context_create(const char *input, size_t input_length, size_t max_c
     if (max_capture_groups > 0) {
         context->capture_groups = rift_capture_groups_create(max_capture_groups);
         if (!context->capture_groups) {
-            rift_free(context);
+            rift_pool_free(context, sizeof(rift_regex_matcher_context_t));
             return NULL;
         }
     }
@@ -78,8 +78,8 @@ rift_matcher_context_free(rift_regex_matcher_context_t *context)
         rift_capture_groups_free(context->capture_groups);
     }
 
-    // Free the context itself
-    rift_free(context);
+    // Return the context itself to its pool
+    rift_pool_free(context, sizeof(rift_regex_matcher_context_t));
 }
 
 /**
@@ -210,16 +210,16 @@ rift_matcher_context_advance(rift_regex_matcher_context_t *context)
 }
 
 /**
- * @brief Create a match result from the current context state
+ * @brief Create a match result under the tag already in use
  *
  * @param context The matcher context
  * @param start_pos Start position of the match
  * @param end_pos End position of the match
  * @return Pointer to the new match result or NULL on failure
  */
-rift_regex_match_result_t *
-rift_matcher_context_create_match_result(const rift_regex_matcher_context_t *context,
-                                         size_t start_pos, size_t end_pos)
+static rift_regex_match_result_t *
+create_match_result(const rift_regex_matcher_context_t *context, size_t start_pos,
+                    size_t end_pos)
 {
     if (!context || start_pos > end_pos || end_pos > context->input_length || !context->input) {
         return NULL;
@@ -320,6 +320,73 @@ rift_matcher_context_create_match_result(const rift_regex_matcher_context_t *con
     return result;
 }
 
+/**
+ * @brief Create a match result from the current context state
+ *
+ * @param context The matcher context
+ * @param start_pos Start position of the match
+ * @param end_pos End position of the match
+ * @return Pointer to the new match result or NULL on failure
+ */
+rift_regex_match_result_t *
+rift_matcher_context_create_match_result(const rift_regex_matcher_context_t *context,
+                                         size_t start_pos, size_t end_pos)
+{
+    rift_memory_tag_t outer = rift_memory_tag_use(RIFT_MEMORY_TAG_RESULTS);
+    rift_regex_match_result_t *result = create_match_result(context, start_pos, end_pos);
+    rift_memory_tag_use(outer);
+    return result;
+}
+
+/**
+ * @brief Fill caller-provided spans from the current context state
+ *
+ * @param context The matcher context
+ * @param start_pos Start position of the match
+ * @param end_pos End position of the match
+ * @param spans Array to store the spans
+ * @param max_spans Number of entries in spans
+ * @return Number of spans the match has, which may exceed max_spans, or 0 on failure
+ */
+size_t
+rift_matcher_context_get_spans(const rift_regex_matcher_context_t *context, size_t start_pos,
+                               size_t end_pos, rift_regex_span_t *spans, size_t max_spans)
+{
+    if (!context || start_pos > end_pos || end_pos > context->input_length ||
+        (!spans && max_spans > 0)) {
+        return 0;
+    }
+
+    size_t num_groups = 0;
+    if (context->capture_groups) {
+        num_groups = rift_capture_groups_get_count(context->capture_groups);
+    }
+
+    if (max_spans > 0) {
+        spans[0].start = start_pos;
+        spans[0].end = end_pos;
+    }
+
+    // Only the groups that fit are read, the total count is returned regardless
+    for (size_t i = 0; i < num_groups && i + 1 < max_spans; i++) {
+        rift_regex_capture_group_t *group =
+            rift_capture_groups_get_by_index(context->capture_groups, i);
+        size_t group_start = group ? rift_capture_group_get_start(group) : RIFT_REGEX_SPAN_UNSET;
+        size_t group_end = group ? rift_capture_group_get_end(group) : RIFT_REGEX_SPAN_UNSET;
+
+        if (group_start == RIFT_REGEX_SPAN_UNSET || group_end == RIFT_REGEX_SPAN_UNSET ||
+            group_start > group_end || group_end > context->input_length) {
+            group_start = RIFT_REGEX_SPAN_UNSET;
+            group_end = RIFT_REGEX_SPAN_UNSET;
+        }
+
+        spans[i + 1].start = group_start;
+        spans[i + 1].end = group_end;
+    }
+
+    return num_groups + 1;
+}
+
 /**
  * @brief Free resources associated with a match result
  *
@@ -0,0 +1,476 @@
+/**
+ * @file decompress_stream.c
+ * @brief Implementation of pipelined decompression streams
+ *
+ * The decompressing thread and the caller hand the two chunk buffers back
+ * and forth under one lock: the thread fills buffer 0, then 1, then 0
+ * again once the caller has moved past it, and so on. Compressed input is
+ * read through a buffer of RIFT_DECOMPRESS_INPUT_SIZE bytes owned by the
+ * thread.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/runtime/decompress_stream.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "core/memory/memory.h"
+
+#ifdef LIBRIFT_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef LIBRIFT_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+/* Bytes of compressed input read at a time */
+#define RIFT_DECOMPRESS_INPUT_SIZE (64 * 1024)
+
+/**
+ * @brief Decompression stream structure
+ */
+struct rift_decompress_stream {
+    int fd;                          /**< The file, read by the thread */
+    rift_compression_t compression;  /**< Format of the file */
+    size_t chunk_size;               /**< Size of each buffer */
+    char *buffers[2];                /**< The chunk buffers */
+    size_t lengths[2];               /**< Bytes decompressed into each buffer */
+    bool full[2];                    /**< Whether a buffer waits for, or is held by, the caller */
+    size_t next;                     /**< Buffer the caller takes next */
+    bool holding;                    /**< Whether the caller holds the other buffer */
+    bool done;                       /**< Whether the thread has published its last chunk */
+    bool failed;                     /**< Whether the input ended on an error */
+    bool stopping;                   /**< Whether the caller asked the thread to stop */
+    pthread_mutex_t lock;            /**< Guards the fields above from full on */
+    pthread_cond_t changed;          /**< Signaled when any of them changes */
+    pthread_t thread;                /**< The decompressing thread */
+};
+
+/**
+ * @brief Chunk being filled by the decompressing thread
+ */
+typedef struct stream_writer {
+    rift_decompress_stream_t *stream; /**< The stream */
+    size_t index;                     /**< Buffer being filled */
+    char *out;                        /**< That buffer, NULL once the caller stopped the stream */
+    size_t filled;                    /**< Bytes written to it */
+} stream_writer_t;
+
+rift_compression_t
+rift_compression_detect(const void *data, size_t size)
+{
+    const unsigned char *bytes = data;
+    if (bytes && size >= 2 && bytes[0] == 0x1f && bytes[1] == 0x8b) {
+        return RIFT_COMPRESSION_GZIP;
+    }
+    if (bytes && size >= 4 && bytes[0] == 0x28 && bytes[1] == 0xb5 && bytes[2] == 0x2f &&
+        bytes[3] == 0xfd) {
+        return RIFT_COMPRESSION_ZSTD;
+    }
+    return RIFT_COMPRESSION_NONE;
+}
+
+bool
+rift_compression_supported(rift_compression_t compression)
+{
+    switch (compression) {
+    case RIFT_COMPRESSION_NONE:
+        return true;
+    case RIFT_COMPRESSION_GZIP:
+#ifdef LIBRIFT_HAVE_ZLIB
+        return true;
+#else
+        return false;
+#endif
+    case RIFT_COMPRESSION_ZSTD:
+#ifdef LIBRIFT_HAVE_ZSTD
+        return true;
+#else
+        return false;
+#endif
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Wait until the caller has handed a buffer back
+ *
+ * @param writer The writer, its index set to the buffer wanted
+ * @return true if the buffer is free, false if the stream is stopping
+ */
+static bool
+writer_acquire(stream_writer_t *writer)
+{
+    rift_decompress_stream_t *stream = writer->stream;
+
+    pthread_mutex_lock(&stream->lock);
+    while (stream->full[writer->index] && !stream->stopping) {
+        pthread_cond_wait(&stream->changed, &stream->lock);
+    }
+    bool stopping = stream->stopping;
+    pthread_mutex_unlock(&stream->lock);
+
+    writer->out = stopping ? NULL : stream->buffers[writer->index];
+    writer->filled = 0;
+    return !stopping;
+}
+
+/**
+ * @brief Hand the buffer being filled to the caller and take the other one
+ *
+ * @param writer The writer
+ * @return true if the next buffer is free, false if the stream is stopping
+ */
+static bool
+writer_publish(stream_writer_t *writer)
+{
+    rift_decompress_stream_t *stream = writer->stream;
+
+    if (writer->filled > 0) {
+        pthread_mutex_lock(&stream->lock);
+        stream->lengths[writer->index] = writer->filled;
+        stream->full[writer->index] = true;
+        pthread_cond_broadcast(&stream->changed);
+        pthread_mutex_unlock(&stream->lock);
+        writer->index ^= 1;
+    }
+    return writer_acquire(writer);
+}
+
+/**
+ * @brief Read from the file, retrying interrupted reads
+ *
+ * @return Bytes read, 0 at the end of the file, -1 on an error
+ */
+static ssize_t
+read_input(int fd, void *buffer, size_t size)
+{
+    ssize_t count;
+    do {
+        count = read(fd, buffer, size);
+    } while (count < 0 && errno == EINTR);
+    return count;
+}
+
+/**
+ * @brief Copy an uncompressed file into the chunks
+ *
+ * @return true if read to its end, false on an error or when stopped
+ */
+static bool
+copy_plain(stream_writer_t *writer)
+{
+    size_t chunk_size = writer->stream->chunk_size;
+    while (writer->out) {
+        ssize_t count =
+            read_input(writer->stream->fd, writer->out + writer->filled, chunk_size - writer->filled);
+        if (count <= 0) {
+            return count == 0;
+        }
+        writer->filled += (size_t)count;
+        if (writer->filled == chunk_size && !writer_publish(writer)) {
+            return false;
+        }
+    }
+    return false;
+}
+
+#ifdef LIBRIFT_HAVE_ZLIB
+/**
+ * @brief Decompress a gzip file into the chunks, member after member
+ *
+ * @return true if read to its end, false on an error or when stopped
+ */
+static bool
+inflate_gzip(stream_writer_t *writer, unsigned char *input)
+{
+    size_t chunk_size = writer->stream->chunk_size;
+    z_stream z;
+    memset(&z, 0, sizeof(z));
+    if (inflateInit2(&z, 15 + 16) != Z_OK) {
+        return false;
+    }
+
+    bool ok = false;
+    bool in_member = false;
+    while (writer->out) {
+        if (z.avail_in == 0) {
+            ssize_t count = read_input(writer->stream->fd, input, RIFT_DECOMPRESS_INPUT_SIZE);
+            if (count <= 0) {
+                // A file cut inside a member is corrupt
+                ok = count == 0 && !in_member;
+                break;
+            }
+            z.next_in = input;
+            z.avail_in = (uInt)count;
+        }
+
+        z.next_out = (Bytef *)writer->out + writer->filled;
+        z.avail_out = (uInt)(chunk_size - writer->filled);
+        int status = inflate(&z, Z_NO_FLUSH);
+        writer->filled = chunk_size - z.avail_out;
+        in_member = status != Z_STREAM_END;
+        if (status == Z_STREAM_END) {
+            inflateReset(&z);
+        } else if (status != Z_OK && status != Z_BUF_ERROR) {
+            break;
+        }
+
+        if (writer->filled == chunk_size && !writer_publish(writer)) {
+            break;
+        }
+    }
+
+    inflateEnd(&z);
+    return ok;
+}
+#endif
+
+#ifdef LIBRIFT_HAVE_ZSTD
+/**
+ * @brief Decompress a zstd file into the chunks, frame after frame
+ *
+ * @return true if read to its end, false on an error or when stopped
+ */
+static bool
+decompress_zstd(stream_writer_t *writer, unsigned char *input)
+{
+    size_t chunk_size = writer->stream->chunk_size;
+    ZSTD_DCtx *context = ZSTD_createDCtx();
+    if (!context) {
+        return false;
+    }
+
+    bool ok = false;
+    size_t pending = 0;
+    ZSTD_inBuffer in = {input, 0, 0};
+    while (writer->out) {
+        if (in.pos == in.size) {
+            ssize_t count = read_input(writer->stream->fd, input, RIFT_DECOMPRESS_INPUT_SIZE);
+            if (count <= 0) {
+                // A nonzero hint means the last frame is incomplete
+                ok = count == 0 && pending == 0;
+                break;
+            }
+            in.size = (size_t)count;
+            in.pos = 0;
+        }
+
+        ZSTD_outBuffer out = {writer->out, chunk_size, writer->filled};
+        pending = ZSTD_decompressStream(context, &out, &in);
+        writer->filled = out.pos;
+        if (ZSTD_isError(pending)) {
+            break;
+        }
+
+        if (writer->filled == chunk_size && !writer_publish(writer)) {
+            break;
+        }
+    }
+
+    ZSTD_freeDCtx(context);
+    return ok;
+}
+#endif
+
+/**
+ * @brief Body of the decompressing thread
+ */
+static void *
+decompress_worker(void *arg)
+{
+    rift_decompress_stream_t *stream = arg;
+    stream_writer_t writer = {stream, 0, NULL, 0};
+    bool ok = false;
+
+    if (writer_acquire(&writer)) {
+        if (stream->compression == RIFT_COMPRESSION_NONE) {
+            ok = copy_plain(&writer);
+        } else {
+            unsigned char *input = rift_malloc(RIFT_DECOMPRESS_INPUT_SIZE);
+#ifdef LIBRIFT_HAVE_ZLIB
+            if (input && stream->compression == RIFT_COMPRESSION_GZIP) {
+                ok = inflate_gzip(&writer, input);
+            }
+#endif
+#ifdef LIBRIFT_HAVE_ZSTD
+            if (input && stream->compression == RIFT_COMPRESSION_ZSTD) {
+                ok = decompress_zstd(&writer, input);
+            }
+#endif
+            rift_free(input);
+        }
+    }
+
+    // The last, partly filled chunk
+    pthread_mutex_lock(&stream->lock);
+    if (writer.out && writer.filled > 0) {
+        stream->lengths[writer.index] = writer.filled;
+        stream->full[writer.index] = true;
+    }
+    stream->failed = !ok && !stream->stopping;
+    stream->done = true;
+    pthread_cond_broadcast(&stream->changed);
+    pthread_mutex_unlock(&stream->lock);
+    return NULL;
+}
+
+rift_decompress_stream_t *
+rift_decompress_stream_open(const char *path, size_t chunk_size, rift_regex_error_t *error)
+{
+    if (!path) {
+        rift_regex_error_set_with_message(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                                          "Invalid parameters");
+        return NULL;
+    }
+
+    int fd = open(path, O_RDONLY);
+    unsigned char magic[4];
+    ssize_t count = fd >= 0 ? pread(fd, magic, sizeof(magic), 0) : -1;
+    if (count < 0) {
+        rift_regex_error_set_formatted(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                                       "Cannot read %s", path);
+        if (fd >= 0) {
+            close(fd);
+        }
+        return NULL;
+    }
+
+    rift_compression_t compression = rift_compression_detect(magic, (size_t)count);
+    if (!rift_compression_supported(compression)) {
+        rift_regex_error_set_formatted(error, RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE,
+                                       "%s is compressed with %s, which this build cannot read",
+                                       path,
+                                       compression == RIFT_COMPRESSION_GZIP ? "gzip" : "zstd");
+        close(fd);
+        return NULL;
+    }
+
+    rift_decompress_stream_t *stream = rift_calloc(1, sizeof(*stream));
+    if (!stream) {
+        rift_regex_error_set_with_message(error, RIFT_REGEX_ERROR_MEMORY,
+                                          "Memory allocation failed");
+        close(fd);
+        return NULL;
+    }
+
+    stream->fd = fd;
+    stream->compression = compression;
+    stream->chunk_size = chunk_size ? chunk_size : RIFT_DECOMPRESS_CHUNK_SIZE;
+    stream->buffers[0] = rift_malloc(stream->chunk_size);
+    stream->buffers[1] = rift_malloc(stream->chunk_size);
+    pthread_mutex_init(&stream->lock, NULL);
+    pthread_cond_init(&stream->changed, NULL);
+    if (!stream->buffers[0] || !stream->buffers[1] ||
+        pthread_create(&stream->thread, NULL, decompress_worker, stream) != 0) {
+        rift_regex_error_set_with_message(error, RIFT_REGEX_ERROR_MEMORY,
+                                          "Cannot start the decompressing thread");
+        pthread_cond_destroy(&stream->changed);
+        pthread_mutex_destroy(&stream->lock);
+        rift_free(stream->buffers[0]);
+        rift_free(stream->buffers[1]);
+        rift_free(stream);
+        close(fd);
+        return NULL;
+    }
+
+    return stream;
+}
+
+rift_compression_t
+rift_decompress_stream_get_compression(const rift_decompress_stream_t *stream)
+{
+    return stream ? stream->compression : RIFT_COMPRESSION_NONE;
+}
+
+bool
+rift_decompress_stream_next(rift_decompress_stream_t *stream, const char **data, size_t *length)
+{
+    if (!stream || !data || !length) {
+        return false;
+    }
+
+    pthread_mutex_lock(&stream->lock);
+
+    // The chunk returned last time goes back to the thread
+    if (stream->holding) {
+        stream->full[stream->next ^ 1] = false;
+        stream->holding = false;
+        pthread_cond_broadcast(&stream->changed);
+    }
+
+    while (!stream->full[stream->next] && !stream->done) {
+        pthread_cond_wait(&stream->changed, &stream->lock);
+    }
+
+    bool taken = stream->full[stream->next];
+    if (taken) {
+        *data = stream->buffers[stream->next];
+        *length = stream->lengths[stream->next];
+        stream->holding = true;
+        stream->next ^= 1;
+    }
+
+    pthread_mutex_unlock(&stream->lock);
+    return taken;
+}
+
+bool
+rift_decompress_stream_failed(const rift_decompress_stream_t *stream)
+{
+    if (!stream) {
+        return true;
+    }
+
+    rift_decompress_stream_t *mutable_stream = (rift_decompress_stream_t *)stream;
+    pthread_mutex_lock(&mutable_stream->lock);
+    bool failed = stream->failed;
+    pthread_mutex_unlock(&mutable_stream->lock);
+    return failed;
+}
+
+bool
+rift_decompress_stream_feed(rift_decompress_stream_t *stream, rift_regex_matcher_t *matcher)
+{
+    if (!stream || !matcher) {
+        return false;
+    }
+
+    const char *chunk;
+    size_t length;
+    bool fed = true;
+    while (fed && rift_decompress_stream_next(stream, &chunk, &length)) {
+        fed = rift_matcher_feed(matcher, chunk, length, false);
+    }
+
+    // Ending the matcher's stream also readies it for the next one
+    bool ended = rift_matcher_feed(matcher, NULL, 0, true);
+    return fed && ended && !rift_decompress_stream_failed(stream);
+}
+
+void
+rift_decompress_stream_close(rift_decompress_stream_t *stream)
+{
+    if (!stream) {
+        return;
+    }
+
+    pthread_mutex_lock(&stream->lock);
+    stream->stopping = true;
+    pthread_cond_broadcast(&stream->changed);
+    pthread_mutex_unlock(&stream->lock);
+    pthread_join(stream->thread, NULL);
+
+    pthread_cond_destroy(&stream->changed);
+    pthread_mutex_destroy(&stream->lock);
+    rift_free(stream->buffers[0]);
+    rift_free(stream->buffers[1]);
+    close(stream->fd);
+    rift_free(stream);
+}
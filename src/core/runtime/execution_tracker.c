@@ -0,0 +1,59 @@
+/**
+ * @file execution_tracker.c
+ * @brief Implementation of the per-match telemetry counters
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/runtime/execution_tracker.h"
+#include <string.h>
+
+void
+rift_match_stats_reset(rift_match_stats_t *stats)
+{
+    if (stats) {
+        memset(stats, 0, sizeof(*stats));
+    }
+}
+
+void
+rift_match_stats_merge(rift_match_stats_t *total, const rift_match_stats_t *stats)
+{
+    if (!total || !stats) {
+        return;
+    }
+
+    total->searches += stats->searches;
+    total->attempts += stats->attempts;
+    for (size_t i = 0; i < RIFT_MATCH_ENGINE_COUNT; i++) {
+        total->engine_attempts[i] += stats->engine_attempts[i];
+    }
+    if (stats->engine != RIFT_MATCH_ENGINE_NONE) {
+        total->engine = stats->engine;
+    }
+
+    total->steps += stats->steps;
+    total->backtrack_pushes += stats->backtrack_pushes;
+    total->backtrack_pops += stats->backtrack_pops;
+    if (stats->max_stack_depth > total->max_stack_depth) {
+        total->max_stack_depth = stats->max_stack_depth;
+    }
+    total->epsilon_expansions += stats->epsilon_expansions;
+    total->prefilter_skips += stats->prefilter_skips;
+    total->budget_fallbacks += stats->budget_fallbacks;
+    total->engine_switches += stats->engine_switches;
+}
+
+const char *
+rift_match_engine_name(rift_match_engine_t engine)
+{
+    static const char *const names[RIFT_MATCH_ENGINE_COUNT] = {
+        "none",        "lazy DFA",     "Pike VM",   "backtracker",
+        "bytecode VM", "one-pass DFA", "tagged DFA", "bit-parallel NFA"};
+
+    if ((unsigned)engine >= RIFT_MATCH_ENGINE_COUNT) {
+        return "unknown";
+    }
+    return names[engine];
+}
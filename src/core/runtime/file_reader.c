@@ -0,0 +1,677 @@
+/**
+ * @file file_reader.c
+ * @brief Implementation of bulk file reading on io_uring or pread
+ *
+ * The reading thread gives each file a buffer of the pool for the time of
+ * its open, read and close, then queues it for the scanning threads, which
+ * hand the buffer back once done. On io_uring the ring is driven through
+ * its system calls directly, as liburing would: each file is an OPENAT, a
+ * READ (READ_FIXED when the pool could be registered) and a CLOSE, the next
+ * one submitted as the previous completes, with up to queue_depth files in
+ * flight. A read that fills its buffer marks the file incomplete rather
+ * than being followed by another, since most files are far smaller.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+#include "core/runtime/file_reader.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "core/memory/memory.h"
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && \
+    defined(__NR_io_uring_register)
+#include <linux/io_uring.h>
+#define RIFT_FILE_READER_IO_URING 1
+#endif
+#endif
+
+#ifdef RIFT_FILE_READER_IO_URING
+
+/* Operation of a completion, in the low bits of its user data */
+#define RING_OP_OPEN 0
+#define RING_OP_READ 1
+#define RING_OP_CLOSE 2
+#define RING_OP_BITS 2
+
+/**
+ * @brief An io_uring instance mapped into the process
+ */
+typedef struct file_ring {
+    int fd;                     /**< The ring */
+    void *sq_map;               /**< Mapping of the submission ring */
+    size_t sq_map_size;         /**< Its size */
+    void *cq_map;               /**< Mapping of the completion ring, sq_map if shared */
+    size_t cq_map_size;         /**< Its size */
+    struct io_uring_sqe *sqes;  /**< The submission entries */
+    size_t sqes_size;           /**< Size of their mapping */
+    unsigned *sq_head;          /**< Head of the submission ring, moved by the kernel */
+    unsigned *sq_tail;          /**< Tail of the submission ring */
+    unsigned *sq_array;         /**< Indices of the entries submitted */
+    unsigned sq_mask;           /**< Mask of submission ring indices */
+    unsigned sq_entries;        /**< Entries of the submission ring */
+    unsigned *cq_head;          /**< Head of the completion ring */
+    unsigned *cq_tail;          /**< Tail of the completion ring, moved by the kernel */
+    struct io_uring_cqe *cqes;  /**< The completions */
+    unsigned cq_mask;           /**< Mask of completion ring indices */
+    unsigned to_submit;         /**< Entries queued since the last submission */
+    bool fixed;                 /**< Whether the pool is registered with the ring */
+} file_ring_t;
+
+#endif /* RIFT_FILE_READER_IO_URING */
+
+/**
+ * @brief File being read into a buffer of the pool
+ */
+typedef struct file_slot {
+    size_t path;  /**< Index of the path */
+    int fd;       /**< The open file */
+    bool reading; /**< Whether the file is opened or read on the ring */
+} file_slot_t;
+
+/**
+ * @brief File reader structure
+ */
+struct rift_file_reader {
+    const char *const *paths;  /**< Paths of the files */
+    size_t num_paths;          /**< Number of paths */
+    size_t buffer_size;        /**< Size of each buffer */
+    size_t num_buffers;        /**< Buffers in the pool */
+    char *pool;                /**< The buffers, one after the other */
+    file_slot_t *slots;        /**< File being read into each buffer */
+    size_t *free_buffers;      /**< Stack of the buffers free for reads */
+    size_t num_free;           /**< Buffers on the stack */
+    rift_file_read_t *ready;   /**< Queue of the files read, waiting to be taken */
+    size_t ready_head;         /**< First file of the queue */
+    size_t ready_count;        /**< Files in the queue */
+    bool done;                 /**< Whether every file has been queued */
+    bool stopping;             /**< Whether the reader is being freed */
+    pthread_mutex_t lock;      /**< Guards the fields above from free_buffers on */
+    pthread_cond_t changed;    /**< Signaled when any of them changes */
+    pthread_t thread;          /**< The reading thread */
+    bool io_uring;             /**< Whether files are read through the ring */
+#ifdef RIFT_FILE_READER_IO_URING
+    file_ring_t ring; /**< The ring, when io_uring is used */
+#endif
+};
+
+/**
+ * @brief Take a free buffer, waiting for one
+ *
+ * @param reader The reader
+ * @param buffer Pointer to store the buffer
+ * @param wait Whether to wait when none is free
+ * @return true if a buffer was taken, false if none is free or the reader is stopping
+ */
+static bool
+acquire_buffer(rift_file_reader_t *reader, size_t *buffer, bool wait)
+{
+    pthread_mutex_lock(&reader->lock);
+    while (wait && reader->num_free == 0 && !reader->stopping) {
+        pthread_cond_wait(&reader->changed, &reader->lock);
+    }
+    bool taken = reader->num_free > 0 && !reader->stopping;
+    if (taken) {
+        *buffer = reader->free_buffers[--reader->num_free];
+    }
+    pthread_mutex_unlock(&reader->lock);
+    return taken;
+}
+
+/**
+ * @brief Queue a file for the scanning threads
+ *
+ * @param reader The reader
+ * @param buffer Buffer holding the file
+ * @param size Bytes read, ignored on an error
+ * @param error errno of the failure, 0 if none
+ */
+static void
+publish_file(rift_file_reader_t *reader, size_t buffer, size_t size, int error)
+{
+    rift_file_read_t file;
+    file.index = reader->slots[buffer].path;
+    file.path = reader->paths[file.index];
+    file.data = error ? NULL : reader->pool + buffer * reader->buffer_size;
+    file.size = error ? 0 : size;
+    file.complete = !error && size < reader->buffer_size;
+    file.error = error;
+    file.buffer = buffer;
+
+    pthread_mutex_lock(&reader->lock);
+    size_t tail = (reader->ready_head + reader->ready_count) % reader->num_buffers;
+    reader->ready[tail] = file;
+    reader->ready_count++;
+    pthread_cond_broadcast(&reader->changed);
+    pthread_mutex_unlock(&reader->lock);
+}
+
+/**
+ * @brief Read one file into a buffer with open and pread
+ */
+static void
+read_file_sync(rift_file_reader_t *reader, size_t buffer)
+{
+    const char *path = reader->paths[reader->slots[buffer].path];
+    char *data = reader->pool + buffer * reader->buffer_size;
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        int error = errno;
+        if (fd >= 0) {
+            close(fd);
+        }
+        publish_file(reader, buffer, 0, error);
+        return;
+    }
+
+    /* Of a larger file, as much as fits, as a read on the ring would */
+    size_t size = (size_t)st.st_size;
+    if (size > reader->buffer_size) {
+        size = reader->buffer_size;
+    }
+
+    size_t filled = 0;
+    int error = 0;
+    while (filled < size) {
+        ssize_t count = pread(fd, data + filled, size - filled, (off_t)filled);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            error = count < 0 ? errno : 0;
+            break;
+        }
+        filled += (size_t)count;
+    }
+    close(fd);
+    publish_file(reader, buffer, filled, error);
+}
+
+/**
+ * @brief Body of the reading thread without io_uring
+ */
+static void
+read_files_sync(rift_file_reader_t *reader)
+{
+    size_t buffer;
+    for (size_t i = 0; i < reader->num_paths && acquire_buffer(reader, &buffer, true); i++) {
+        reader->slots[buffer].path = i;
+        read_file_sync(reader, buffer);
+    }
+}
+
+#ifdef RIFT_FILE_READER_IO_URING
+
+/**
+ * @brief Unmap and close a ring
+ */
+static void
+ring_close(file_ring_t *ring)
+{
+    if (ring->sqes && ring->sqes != MAP_FAILED) {
+        munmap(ring->sqes, ring->sqes_size);
+    }
+    if (ring->cq_map && ring->cq_map != MAP_FAILED && ring->cq_map != ring->sq_map) {
+        munmap(ring->cq_map, ring->cq_map_size);
+    }
+    if (ring->sq_map && ring->sq_map != MAP_FAILED) {
+        munmap(ring->sq_map, ring->sq_map_size);
+    }
+    if (ring->fd >= 0) {
+        close(ring->fd);
+    }
+    memset(ring, 0, sizeof(*ring));
+    ring->fd = -1;
+}
+
+/**
+ * @brief Check that the kernel supports every operation the reader submits
+ */
+static bool
+ring_supports_ops(const file_ring_t *ring)
+{
+    size_t num_ops = UINT8_MAX + 1;
+    struct io_uring_probe *probe =
+        rift_calloc(1, sizeof(*probe) + num_ops * sizeof(struct io_uring_probe_op));
+    if (!probe) {
+        return false;
+    }
+
+    bool supported = false;
+    if (syscall(__NR_io_uring_register, ring->fd, IORING_REGISTER_PROBE, probe, num_ops) == 0) {
+        const unsigned char ops[] = {IORING_OP_OPENAT, IORING_OP_READ, IORING_OP_CLOSE};
+        supported = true;
+        for (size_t i = 0; supported && i < sizeof(ops); i++) {
+            supported = ops[i] <= probe->last_op &&
+                        (probe->ops[ops[i]].flags & IO_URING_OP_SUPPORTED) != 0;
+        }
+    }
+    rift_free(probe);
+    return supported;
+}
+
+/**
+ * @brief Set up a ring for the reader and register its pool with it
+ *
+ * @return true if the ring is ready, false if io_uring is unavailable
+ */
+static bool
+ring_open(rift_file_reader_t *reader)
+{
+    file_ring_t *ring = &reader->ring;
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    memset(ring, 0, sizeof(*ring));
+
+    /* A read per buffer and the closes of files already handed out */
+    ring->fd = (int)syscall(__NR_io_uring_setup, (unsigned)(reader->num_buffers * 2), &params);
+    if (ring->fd < 0) {
+        ring->fd = -1;
+        return false;
+    }
+
+    ring->sq_map_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cq_map_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    bool single_map = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_map && ring->cq_map_size > ring->sq_map_size) {
+        ring->sq_map_size = ring->cq_map_size;
+    }
+    ring->sq_map = mmap(NULL, ring->sq_map_size, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+    ring->cq_map = single_map ? ring->sq_map
+                              : mmap(NULL, ring->cq_map_size, PROT_READ | PROT_WRITE,
+                                     MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ring->fd, IORING_OFF_SQES);
+    if (ring->sq_map == MAP_FAILED || ring->cq_map == MAP_FAILED || ring->sqes == MAP_FAILED ||
+        !ring_supports_ops(ring)) {
+        ring_close(ring);
+        return false;
+    }
+
+    char *sq = ring->sq_map;
+    char *cq = ring->cq_map;
+    ring->sq_head = (unsigned *)(sq + params.sq_off.head);
+    ring->sq_tail = (unsigned *)(sq + params.sq_off.tail);
+    ring->sq_array = (unsigned *)(sq + params.sq_off.array);
+    ring->sq_mask = *(unsigned *)(sq + params.sq_off.ring_mask);
+    ring->sq_entries = params.sq_entries;
+    ring->cq_head = (unsigned *)(cq + params.cq_off.head);
+    ring->cq_tail = (unsigned *)(cq + params.cq_off.tail);
+    ring->cqes = (struct io_uring_cqe *)(cq + params.cq_off.cqes);
+    ring->cq_mask = *(unsigned *)(cq + params.cq_off.ring_mask);
+
+    /* Registered buffers save pinning the pages on every read; without
+     * locked memory to spare, plain reads do */
+    struct iovec *iovecs = rift_malloc(reader->num_buffers * sizeof(*iovecs));
+    if (iovecs) {
+        for (size_t i = 0; i < reader->num_buffers; i++) {
+            iovecs[i].iov_base = reader->pool + i * reader->buffer_size;
+            iovecs[i].iov_len = reader->buffer_size;
+        }
+        ring->fixed = syscall(__NR_io_uring_register, ring->fd, IORING_REGISTER_BUFFERS, iovecs,
+                              (unsigned)reader->num_buffers) == 0;
+        rift_free(iovecs);
+    }
+    return true;
+}
+
+/**
+ * @brief Queue a submission entry, to be submitted by ring_submit()
+ *
+ * The reader never has more operations in flight than the ring has
+ * entries, so there is always one free.
+ */
+static struct io_uring_sqe *
+ring_queue(file_ring_t *ring, unsigned char opcode, size_t buffer, unsigned op)
+{
+    unsigned tail = *ring->sq_tail;
+    unsigned index = tail & ring->sq_mask;
+    struct io_uring_sqe *sqe = &ring->sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = opcode;
+    sqe->user_data = ((uint64_t)buffer << RING_OP_BITS) | op;
+    ring->sq_array[index] = index;
+    __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    ring->to_submit++;
+    return sqe;
+}
+
+/**
+ * @brief Submit the queued entries and wait for a completion
+ *
+ * @return true if successful, false if the ring failed
+ */
+static bool
+ring_submit(file_ring_t *ring)
+{
+    for (;;) {
+        long submitted = syscall(__NR_io_uring_enter, ring->fd, ring->to_submit, 1,
+                                 IORING_ENTER_GETEVENTS, NULL, 0);
+        if (submitted >= 0) {
+            ring->to_submit -= (unsigned)submitted;
+            return true;
+        }
+        if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+            return false;
+        }
+    }
+}
+
+/**
+ * @brief Queue the read of an open file into its buffer
+ */
+static void
+ring_queue_read(rift_file_reader_t *reader, size_t buffer)
+{
+    file_ring_t *ring = &reader->ring;
+    struct io_uring_sqe *sqe =
+        ring_queue(ring, ring->fixed ? IORING_OP_READ_FIXED : IORING_OP_READ, buffer, RING_OP_READ);
+    sqe->fd = reader->slots[buffer].fd;
+    sqe->addr = (uint64_t)(uintptr_t)(reader->pool + buffer * reader->buffer_size);
+    sqe->len = (unsigned)reader->buffer_size;
+    sqe->off = 0;
+    if (ring->fixed) {
+        sqe->buf_index = (uint16_t)buffer;
+    }
+}
+
+/**
+ * @brief Queue the close of an open file
+ */
+static void
+ring_queue_close(rift_file_reader_t *reader, size_t buffer)
+{
+    struct io_uring_sqe *sqe = ring_queue(&reader->ring, IORING_OP_CLOSE, buffer, RING_OP_CLOSE);
+    sqe->fd = reader->slots[buffer].fd;
+}
+
+/**
+ * @brief Body of the reading thread on io_uring
+ */
+static void
+read_files_ring(rift_file_reader_t *reader)
+{
+    file_ring_t *ring = &reader->ring;
+    size_t next_path = 0;
+    size_t in_flight = 0;
+    int ring_error = 0;
+
+    for (;;) {
+        /* Open as many files as there are free buffers */
+        size_t buffer;
+        while (next_path < reader->num_paths && acquire_buffer(reader, &buffer, in_flight == 0)) {
+            reader->slots[buffer].path = next_path;
+            reader->slots[buffer].fd = -1;
+            struct io_uring_sqe *sqe = ring_queue(ring, IORING_OP_OPENAT, buffer, RING_OP_OPEN);
+            sqe->fd = AT_FDCWD;
+            sqe->addr = (uint64_t)(uintptr_t)reader->paths[next_path];
+            sqe->open_flags = O_RDONLY | O_CLOEXEC;
+            reader->slots[buffer].reading = true;
+            next_path++;
+            in_flight++;
+        }
+        if (in_flight == 0) {
+            break;
+        }
+
+        if (!ring_submit(ring)) {
+            ring_error = errno;
+            break;
+        }
+
+        pthread_mutex_lock(&reader->lock);
+        bool stopping = reader->stopping;
+        pthread_mutex_unlock(&reader->lock);
+
+        unsigned head = *ring->cq_head;
+        unsigned tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+        for (; head != tail; head++) {
+            const struct io_uring_cqe *cqe = &ring->cqes[head & ring->cq_mask];
+            size_t slot = (size_t)(cqe->user_data >> RING_OP_BITS);
+            unsigned op = (unsigned)(cqe->user_data & ((1u << RING_OP_BITS) - 1));
+            int result = cqe->res;
+            in_flight--;
+
+            if (op == RING_OP_OPEN && result < 0) {
+                reader->slots[slot].reading = false;
+                publish_file(reader, slot, 0, -result);
+            } else if (op == RING_OP_OPEN) {
+                reader->slots[slot].fd = result;
+                if (stopping) {
+                    ring_queue_close(reader, slot);
+                } else {
+                    ring_queue_read(reader, slot);
+                }
+                in_flight++;
+            } else if (op == RING_OP_READ) {
+                /* The buffer is the caller's from here on; the close
+                 * only needs the descriptor */
+                reader->slots[slot].reading = false;
+                if (!stopping) {
+                    publish_file(reader, slot, result < 0 ? 0 : (size_t)result,
+                                 result < 0 ? -result : 0);
+                }
+                ring_queue_close(reader, slot);
+                in_flight++;
+            }
+        }
+        __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+
+        if (stopping) {
+            next_path = reader->num_paths;
+        }
+    }
+
+    /* Were the ring to fail, the files it did not finish are reported as
+     * unreadable. No read is submitted after that, so buffers the kernel
+     * may still write to until the ring is closed only carry errors. */
+    if (ring_error) {
+        for (size_t i = 0; i < reader->num_buffers; i++) {
+            if (reader->slots[i].reading) {
+                reader->slots[i].reading = false;
+                publish_file(reader, i, 0, ring_error);
+            }
+        }
+        size_t buffer;
+        for (; next_path < reader->num_paths && acquire_buffer(reader, &buffer, true);
+             next_path++) {
+            reader->slots[buffer].path = next_path;
+            publish_file(reader, buffer, 0, ring_error);
+        }
+    }
+}
+
+#endif /* RIFT_FILE_READER_IO_URING */
+
+/**
+ * @brief Body of the reading thread
+ */
+static void *
+file_reader_worker(void *arg)
+{
+    rift_file_reader_t *reader = arg;
+
+#ifdef RIFT_FILE_READER_IO_URING
+    if (reader->io_uring) {
+        read_files_ring(reader);
+    } else {
+        read_files_sync(reader);
+    }
+#else
+    read_files_sync(reader);
+#endif
+
+    pthread_mutex_lock(&reader->lock);
+    reader->done = true;
+    pthread_cond_broadcast(&reader->changed);
+    pthread_mutex_unlock(&reader->lock);
+    return NULL;
+}
+
+/**
+ * @brief Free a reader's memory, its thread stopped
+ */
+static void
+free_reader_memory(rift_file_reader_t *reader)
+{
+    rift_free(reader->pool);
+    rift_free(reader->slots);
+    rift_free(reader->free_buffers);
+    rift_free(reader->ready);
+    rift_free(reader);
+}
+
+rift_file_reader_t *
+rift_file_reader_create(const char *const *paths, size_t num_paths,
+                        const rift_file_reader_config_t *config, rift_regex_error_t *error)
+{
+    if (!paths && num_paths > 0) {
+        rift_regex_error_set_with_message(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                                          "Invalid parameters");
+        return NULL;
+    }
+
+    rift_file_reader_t *reader = rift_calloc(1, sizeof(*reader));
+    if (!reader) {
+        rift_regex_error_set_with_message(error, RIFT_REGEX_ERROR_MEMORY,
+                                          "Memory allocation failed");
+        return NULL;
+    }
+
+    reader->paths = paths;
+    reader->num_paths = num_paths;
+    reader->num_buffers =
+        config && config->queue_depth ? config->queue_depth : RIFT_FILE_READER_QUEUE_DEPTH;
+    reader->buffer_size =
+        config && config->buffer_size ? config->buffer_size : RIFT_FILE_READER_BUFFER_SIZE;
+    if (num_paths > 0 && reader->num_buffers > num_paths) {
+        reader->num_buffers = num_paths;
+    }
+    /* Registered buffers are indexed by 16 bits */
+    if (reader->num_buffers > UINT16_MAX) {
+        reader->num_buffers = UINT16_MAX;
+    }
+
+    reader->pool = rift_malloc(reader->num_buffers * reader->buffer_size);
+    reader->slots = rift_calloc(reader->num_buffers, sizeof(*reader->slots));
+    reader->free_buffers = rift_malloc(reader->num_buffers * sizeof(*reader->free_buffers));
+    reader->ready = rift_malloc(reader->num_buffers * sizeof(*reader->ready));
+    if (!reader->pool || !reader->slots || !reader->free_buffers || !reader->ready) {
+        rift_regex_error_set_with_message(error, RIFT_REGEX_ERROR_MEMORY,
+                                          "Memory allocation failed");
+        free_reader_memory(reader);
+        return NULL;
+    }
+
+    /* Buffers are taken from the top of the stack, lowest first */
+    for (size_t i = 0; i < reader->num_buffers; i++) {
+        reader->free_buffers[i] = reader->num_buffers - 1 - i;
+    }
+    reader->num_free = reader->num_buffers;
+
+#ifdef RIFT_FILE_READER_IO_URING
+    reader->ring.fd = -1;
+    reader->io_uring = !(config && config->no_io_uring) && ring_open(reader);
+#endif
+
+    pthread_mutex_init(&reader->lock, NULL);
+    pthread_cond_init(&reader->changed, NULL);
+    if (pthread_create(&reader->thread, NULL, file_reader_worker, reader) != 0) {
+        rift_regex_error_set_with_message(error, RIFT_REGEX_ERROR_MEMORY,
+                                          "Cannot start the reading thread");
+#ifdef RIFT_FILE_READER_IO_URING
+        if (reader->io_uring) {
+            ring_close(&reader->ring);
+        }
+#endif
+        pthread_cond_destroy(&reader->changed);
+        pthread_mutex_destroy(&reader->lock);
+        free_reader_memory(reader);
+        return NULL;
+    }
+
+    return reader;
+}
+
+bool
+rift_file_reader_next(rift_file_reader_t *reader, rift_file_read_t *file)
+{
+    if (!reader || !file) {
+        return false;
+    }
+
+    pthread_mutex_lock(&reader->lock);
+    while (reader->ready_count == 0 && !reader->done) {
+        pthread_cond_wait(&reader->changed, &reader->lock);
+    }
+
+    bool taken = reader->ready_count > 0;
+    if (taken) {
+        *file = reader->ready[reader->ready_head];
+        reader->ready_head = (reader->ready_head + 1) % reader->num_buffers;
+        reader->ready_count--;
+    }
+    pthread_mutex_unlock(&reader->lock);
+    return taken;
+}
+
+void
+rift_file_reader_release(rift_file_reader_t *reader, rift_file_read_t *file)
+{
+    if (!reader || !file || file->buffer >= reader->num_buffers) {
+        return;
+    }
+
+    pthread_mutex_lock(&reader->lock);
+    reader->free_buffers[reader->num_free++] = file->buffer;
+    pthread_cond_broadcast(&reader->changed);
+    pthread_mutex_unlock(&reader->lock);
+
+    file->data = NULL;
+    file->buffer = SIZE_MAX;
+}
+
+bool
+rift_file_reader_uses_io_uring(const rift_file_reader_t *reader)
+{
+    return reader && reader->io_uring;
+}
+
+void
+rift_file_reader_free(rift_file_reader_t *reader)
+{
+    if (!reader) {
+        return;
+    }
+
+    pthread_mutex_lock(&reader->lock);
+    reader->stopping = true;
+    pthread_cond_broadcast(&reader->changed);
+    pthread_mutex_unlock(&reader->lock);
+    pthread_join(reader->thread, NULL);
+
+#ifdef RIFT_FILE_READER_IO_URING
+    if (reader->io_uring) {
+        ring_close(&reader->ring);
+    }
+#endif
+    pthread_cond_destroy(&reader->changed);
+    pthread_mutex_destroy(&reader->lock);
+    free_reader_memory(reader);
+}
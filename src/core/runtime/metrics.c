@@ -0,0 +1,487 @@
+/**
+ * @file metrics.c
+ * @brief Implementation of the search metrics registry
+ *
+ * The counters of a pattern in a shard live in a block of their own,
+ * allocated by the first search the shard records for the pattern, so a
+ * registry sized for many patterns costs only pointers until they are
+ * searched.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/runtime/metrics.h"
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include "core/memory/memory.h"
+
+/**
+ * @brief Counters of one pattern in one shard
+ */
+typedef struct metrics_block {
+    _Atomic uint64_t searches[RIFT_MATCH_ENGINE_COUNT];     /**< Searches, by engine */
+    _Atomic uint64_t matches[RIFT_MATCH_ENGINE_COUNT];      /**< Matches, by engine */
+    _Atomic uint64_t timeouts[RIFT_MATCH_ENGINE_COUNT];     /**< Timeouts, by engine */
+    _Atomic uint64_t latency_sum_ns;                        /**< Sum of the latencies */
+    _Atomic uint64_t latency[RIFT_METRICS_LATENCY_BUCKETS]; /**< Histogram of the latencies */
+} metrics_block_t;
+
+/**
+ * @brief Metrics registry structure
+ */
+struct rift_metrics {
+    size_t capacity;                    /**< Patterns the registry can hold */
+    atomic_size_t count;                /**< Patterns registered */
+    char **names;                       /**< Name of each pattern */
+    _Atomic(metrics_block_t *) *blocks; /**< Block of pattern p in shard s at s * capacity + p */
+    pthread_mutex_t lock;               /**< Serializes registrations */
+};
+
+/* Shard of the calling thread, assigned on its first recorded search */
+static _Thread_local size_t metrics_shard = SIZE_MAX;
+static atomic_size_t next_metrics_shard = 0;
+
+/* Quantiles of the latency summary */
+static const double SUMMARY_QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+static const char *const SUMMARY_LABELS[] = {"0.5", "0.9", "0.99", "0.999"};
+static const char *const SUMMARY_KEYS[] = {"p50", "p90", "p99", "p999"};
+#define SUMMARY_COUNT (sizeof(SUMMARY_QUANTILES) / sizeof(SUMMARY_QUANTILES[0]))
+
+/**
+ * @brief Find the histogram bucket of a latency
+ *
+ * Latencies below RIFT_METRICS_SUB_BUCKETS have a bucket each; above, each
+ * power of two is split into RIFT_METRICS_SUB_BUCKETS equal buckets.
+ */
+static size_t
+latency_bucket(uint64_t latency_ns)
+{
+    if (latency_ns < RIFT_METRICS_SUB_BUCKETS) {
+        return (size_t)latency_ns;
+    }
+
+    unsigned exponent = 63 - (unsigned)__builtin_clzll(latency_ns);
+    if (exponent >= RIFT_METRICS_MAX_EXPONENT) {
+        return RIFT_METRICS_LATENCY_BUCKETS - 1;
+    }
+    size_t sub = (size_t)(latency_ns >> (exponent - 3)) & (RIFT_METRICS_SUB_BUCKETS - 1);
+    return RIFT_METRICS_SUB_BUCKETS + (exponent - 3) * RIFT_METRICS_SUB_BUCKETS + sub;
+}
+
+/**
+ * @brief Get the highest latency of a histogram bucket
+ */
+static uint64_t
+bucket_upper_bound(size_t bucket)
+{
+    if (bucket < RIFT_METRICS_SUB_BUCKETS) {
+        return bucket;
+    }
+    if (bucket == RIFT_METRICS_LATENCY_BUCKETS - 1) {
+        return UINT64_MAX;
+    }
+
+    unsigned exponent = 3 + (unsigned)((bucket - RIFT_METRICS_SUB_BUCKETS) /
+                                       RIFT_METRICS_SUB_BUCKETS);
+    uint64_t sub = (bucket - RIFT_METRICS_SUB_BUCKETS) % RIFT_METRICS_SUB_BUCKETS;
+    uint64_t low = (RIFT_METRICS_SUB_BUCKETS + sub) << (exponent - 3);
+    return low + ((uint64_t)1 << (exponent - 3)) - 1;
+}
+
+rift_metrics_t *
+rift_metrics_create(size_t max_patterns)
+{
+    if (max_patterns == 0 || max_patterns >= RIFT_METRICS_NO_PATTERN) {
+        return NULL;
+    }
+
+    rift_metrics_t *metrics = (rift_metrics_t *)rift_calloc(1, sizeof(rift_metrics_t));
+    if (!metrics) {
+        return NULL;
+    }
+
+    metrics->capacity = max_patterns;
+    atomic_init(&metrics->count, 0);
+    metrics->names = (char **)rift_calloc(max_patterns, sizeof(char *));
+    metrics->blocks = rift_calloc(max_patterns * RIFT_METRICS_SHARDS, sizeof(*metrics->blocks));
+    if (!metrics->names || !metrics->blocks || pthread_mutex_init(&metrics->lock, NULL) != 0) {
+        rift_free(metrics->names);
+        rift_free(metrics->blocks);
+        rift_free(metrics);
+        return NULL;
+    }
+    for (size_t i = 0; i < max_patterns * RIFT_METRICS_SHARDS; i++) {
+        atomic_init(&metrics->blocks[i], NULL);
+    }
+    return metrics;
+}
+
+void
+rift_metrics_free(rift_metrics_t *metrics)
+{
+    if (!metrics) {
+        return;
+    }
+
+    size_t count = atomic_load(&metrics->count);
+    for (size_t i = 0; i < count; i++) {
+        rift_free(metrics->names[i]);
+    }
+    for (size_t i = 0; i < metrics->capacity * RIFT_METRICS_SHARDS; i++) {
+        rift_free(atomic_load_explicit(&metrics->blocks[i], memory_order_relaxed));
+    }
+    pthread_mutex_destroy(&metrics->lock);
+    rift_free(metrics->names);
+    rift_free(metrics->blocks);
+    rift_free(metrics);
+}
+
+uint32_t
+rift_metrics_register_pattern(rift_metrics_t *metrics, const char *name)
+{
+    if (!metrics) {
+        return RIFT_METRICS_NO_PATTERN;
+    }
+
+    uint32_t id = RIFT_METRICS_NO_PATTERN;
+    pthread_mutex_lock(&metrics->lock);
+    size_t count = atomic_load_explicit(&metrics->count, memory_order_relaxed);
+    if (count < metrics->capacity) {
+        char number[24];
+        if (!name) {
+            snprintf(number, sizeof(number), "%zu", count);
+            name = number;
+        }
+        metrics->names[count] = rift_strdup(name);
+        if (metrics->names[count]) {
+            id = (uint32_t)count;
+            // Publish the name before the pattern can be read
+            atomic_store_explicit(&metrics->count, count + 1, memory_order_release);
+        }
+    }
+    pthread_mutex_unlock(&metrics->lock);
+    return id;
+}
+
+size_t
+rift_metrics_get_pattern_count(const rift_metrics_t *metrics)
+{
+    return metrics ? atomic_load_explicit(&metrics->count, memory_order_acquire) : 0;
+}
+
+/**
+ * @brief Get the block of a pattern in the calling thread's shard
+ *
+ * @return The block, or NULL if it cannot be allocated
+ */
+static metrics_block_t *
+get_block(rift_metrics_t *metrics, uint32_t pattern)
+{
+    if (metrics_shard == SIZE_MAX) {
+        metrics_shard = atomic_fetch_add_explicit(&next_metrics_shard, 1, memory_order_relaxed) %
+                        RIFT_METRICS_SHARDS;
+    }
+
+    _Atomic(metrics_block_t *) *slot =
+        &metrics->blocks[metrics_shard * metrics->capacity + pattern];
+    metrics_block_t *block = atomic_load_explicit(slot, memory_order_acquire);
+    if (block) {
+        return block;
+    }
+
+    // Zeroed memory is a valid block of atomics; threads sharing the shard race to install one
+    metrics_block_t *fresh = (metrics_block_t *)rift_calloc(1, sizeof(metrics_block_t));
+    if (!fresh) {
+        return NULL;
+    }
+    if (!atomic_compare_exchange_strong_explicit(slot, &block, fresh, memory_order_acq_rel,
+                                                 memory_order_acquire)) {
+        rift_free(fresh);
+        return block;
+    }
+    return fresh;
+}
+
+void
+rift_metrics_record(rift_metrics_t *metrics, uint32_t pattern, rift_match_engine_t engine,
+                    bool found, bool timed_out, uint64_t latency_ns)
+{
+    if (!metrics || pattern >= rift_metrics_get_pattern_count(metrics) ||
+        (unsigned)engine >= RIFT_MATCH_ENGINE_COUNT) {
+        return;
+    }
+
+    metrics_block_t *block = get_block(metrics, pattern);
+    if (!block) {
+        return;
+    }
+
+    atomic_fetch_add_explicit(&block->searches[engine], 1, memory_order_relaxed);
+    if (found) {
+        atomic_fetch_add_explicit(&block->matches[engine], 1, memory_order_relaxed);
+    }
+    if (timed_out) {
+        atomic_fetch_add_explicit(&block->timeouts[engine], 1, memory_order_relaxed);
+    }
+    atomic_fetch_add_explicit(&block->latency_sum_ns, latency_ns, memory_order_relaxed);
+    atomic_fetch_add_explicit(&block->latency[latency_bucket(latency_ns)], 1,
+                              memory_order_relaxed);
+}
+
+bool
+rift_metrics_get_pattern(const rift_metrics_t *metrics, uint32_t pattern,
+                         rift_metrics_pattern_t *result)
+{
+    if (!metrics || !result || pattern >= rift_metrics_get_pattern_count(metrics)) {
+        return false;
+    }
+
+    memset(result, 0, sizeof(*result));
+    result->name = metrics->names[pattern];
+    for (size_t shard = 0; shard < RIFT_METRICS_SHARDS; shard++) {
+        metrics_block_t *block = atomic_load_explicit(
+            &metrics->blocks[shard * metrics->capacity + pattern], memory_order_acquire);
+        if (!block) {
+            continue;
+        }
+
+        for (size_t i = 0; i < RIFT_MATCH_ENGINE_COUNT; i++) {
+            result->searches[i] += atomic_load_explicit(&block->searches[i], memory_order_relaxed);
+            result->matches[i] += atomic_load_explicit(&block->matches[i], memory_order_relaxed);
+            result->timeouts[i] += atomic_load_explicit(&block->timeouts[i], memory_order_relaxed);
+        }
+        result->latency_sum_ns +=
+            atomic_load_explicit(&block->latency_sum_ns, memory_order_relaxed);
+        for (size_t i = 0; i < RIFT_METRICS_LATENCY_BUCKETS; i++) {
+            uint64_t count = atomic_load_explicit(&block->latency[i], memory_order_relaxed);
+            result->latency[i] += count;
+            result->latency_count += count;
+        }
+    }
+    return true;
+}
+
+uint64_t
+rift_metrics_latency_quantile(const rift_metrics_pattern_t *result, double quantile)
+{
+    if (!result || result->latency_count == 0) {
+        return 0;
+    }
+
+    quantile = quantile < 0.0 ? 0.0 : quantile > 1.0 ? 1.0 : quantile;
+    uint64_t rank = (uint64_t)(quantile * (double)result->latency_count);
+    if ((double)rank < quantile * (double)result->latency_count || rank == 0) {
+        rank++;
+    }
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < RIFT_METRICS_LATENCY_BUCKETS; i++) {
+        seen += result->latency[i];
+        if (seen >= rank) {
+            return bucket_upper_bound(i);
+        }
+    }
+    return bucket_upper_bound(RIFT_METRICS_LATENCY_BUCKETS - 1);
+}
+
+void
+rift_metrics_reset(rift_metrics_t *metrics)
+{
+    if (!metrics) {
+        return;
+    }
+
+    for (size_t i = 0; i < metrics->capacity * RIFT_METRICS_SHARDS; i++) {
+        metrics_block_t *block = atomic_load_explicit(&metrics->blocks[i], memory_order_acquire);
+        if (!block) {
+            continue;
+        }
+        for (size_t engine = 0; engine < RIFT_MATCH_ENGINE_COUNT; engine++) {
+            atomic_store_explicit(&block->searches[engine], 0, memory_order_relaxed);
+            atomic_store_explicit(&block->matches[engine], 0, memory_order_relaxed);
+            atomic_store_explicit(&block->timeouts[engine], 0, memory_order_relaxed);
+        }
+        atomic_store_explicit(&block->latency_sum_ns, 0, memory_order_relaxed);
+        for (size_t bucket = 0; bucket < RIFT_METRICS_LATENCY_BUCKETS; bucket++) {
+            atomic_store_explicit(&block->latency[bucket], 0, memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief Append formatted text to a snapshot
+ */
+static bool
+append_format(rift_output_buffer_t *buffer, const char *format, ...)
+{
+    char text[256];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    if (length < 0 || (size_t)length >= sizeof(text)) {
+        return false;
+    }
+    return rift_output_buffer_append(buffer, text, (size_t)length);
+}
+
+/**
+ * @brief Append a string quoted for a Prometheus label or a JSON value
+ *
+ * Both formats escape backslashes, quotes and newlines the same way; JSON
+ * also needs the other control characters escaped.
+ */
+static bool
+append_quoted(rift_output_buffer_t *buffer, const char *text)
+{
+    bool ok = rift_output_buffer_append(buffer, "\"", 1);
+    for (const char *c = text; ok && *c; c++) {
+        if (*c == '\\' || *c == '"') {
+            char escaped[2] = {'\\', *c};
+            ok = rift_output_buffer_append(buffer, escaped, 2);
+        } else if (*c == '\n') {
+            ok = rift_output_buffer_append(buffer, "\\n", 2);
+        } else if ((unsigned char)*c < 0x20) {
+            ok = append_format(buffer, "\\u%04x", (unsigned)(unsigned char)*c);
+        } else {
+            ok = rift_output_buffer_append(buffer, c, 1);
+        }
+    }
+    return ok && rift_output_buffer_append(buffer, "\"", 1);
+}
+
+/**
+ * @brief Append the samples of one counter family in the Prometheus format
+ *
+ * @param field Offset of the counter array in rift_metrics_pattern_t
+ */
+static bool
+write_prometheus_counter(rift_output_buffer_t *buffer, const rift_metrics_pattern_t *patterns,
+                         size_t count, const char *name, const char *help, size_t field)
+{
+    bool ok = append_format(buffer, "# HELP %s %s\n# TYPE %s counter\n", name, help, name);
+    for (size_t p = 0; ok && p < count; p++) {
+        const uint64_t *values = (const uint64_t *)((const char *)&patterns[p] + field);
+        for (size_t engine = 0; ok && engine < RIFT_MATCH_ENGINE_COUNT; engine++) {
+            if (patterns[p].searches[engine] == 0) {
+                continue;
+            }
+            ok = append_format(buffer, "%s{pattern=", name) &&
+                 append_quoted(buffer, patterns[p].name) &&
+                 append_format(buffer, ",engine=\"%s\"} %llu\n",
+                               rift_match_engine_name((rift_match_engine_t)engine),
+                               (unsigned long long)values[engine]);
+        }
+    }
+    return ok;
+}
+
+/**
+ * @brief Append a snapshot in the Prometheus text format
+ */
+static bool
+write_prometheus(rift_output_buffer_t *buffer, const rift_metrics_pattern_t *patterns,
+                 size_t count)
+{
+    bool ok = write_prometheus_counter(buffer, patterns, count, "librift_searches_total",
+                                       "Searches, by the engine of their last attempt",
+                                       offsetof(rift_metrics_pattern_t, searches)) &&
+              write_prometheus_counter(buffer, patterns, count, "librift_matches_total",
+                                       "Searches that found a match",
+                                       offsetof(rift_metrics_pattern_t, matches)) &&
+              write_prometheus_counter(buffer, patterns, count, "librift_timeouts_total",
+                                       "Searches stopped by a timeout or a limit",
+                                       offsetof(rift_metrics_pattern_t, timeouts));
+
+    const char *name = "librift_search_latency_seconds";
+    ok = ok && append_format(buffer, "# HELP %s Search latency\n# TYPE %s summary\n", name, name);
+    for (size_t p = 0; ok && p < count; p++) {
+        if (patterns[p].latency_count == 0) {
+            continue;
+        }
+        for (size_t q = 0; ok && q < SUMMARY_COUNT; q++) {
+            uint64_t ns = rift_metrics_latency_quantile(&patterns[p], SUMMARY_QUANTILES[q]);
+            ok = append_format(buffer, "%s{pattern=", name) &&
+                 append_quoted(buffer, patterns[p].name) &&
+                 append_format(buffer, ",quantile=\"%s\"} %.9g\n", SUMMARY_LABELS[q],
+                               (double)ns / 1e9);
+        }
+        ok = ok && append_format(buffer, "%s_sum{pattern=", name) &&
+             append_quoted(buffer, patterns[p].name) &&
+             append_format(buffer, "} %.9g\n", (double)patterns[p].latency_sum_ns / 1e9) &&
+             append_format(buffer, "%s_count{pattern=", name) &&
+             append_quoted(buffer, patterns[p].name) &&
+             append_format(buffer, "} %llu\n", (unsigned long long)patterns[p].latency_count);
+    }
+    return ok;
+}
+
+/**
+ * @brief Append a snapshot as JSON
+ */
+static bool
+write_json(rift_output_buffer_t *buffer, const rift_metrics_pattern_t *patterns, size_t count)
+{
+    bool ok = append_format(buffer, "{\"patterns\":[");
+    for (size_t p = 0; ok && p < count; p++) {
+        const rift_metrics_pattern_t *pattern = &patterns[p];
+        ok = append_format(buffer, "%s{\"name\":", p > 0 ? "," : "") &&
+             append_quoted(buffer, pattern->name) && append_format(buffer, ",\"engines\":{");
+
+        bool first = true;
+        for (size_t engine = 0; ok && engine < RIFT_MATCH_ENGINE_COUNT; engine++) {
+            if (pattern->searches[engine] == 0) {
+                continue;
+            }
+            ok = append_format(buffer,
+                               "%s\"%s\":{\"searches\":%llu,\"matches\":%llu,\"timeouts\":%llu}",
+                               first ? "" : ",",
+                               rift_match_engine_name((rift_match_engine_t)engine),
+                               (unsigned long long)pattern->searches[engine],
+                               (unsigned long long)pattern->matches[engine],
+                               (unsigned long long)pattern->timeouts[engine]);
+            first = false;
+        }
+
+        ok = ok && append_format(buffer, "},\"latency_ns\":{\"count\":%llu,\"sum\":%llu",
+                                 (unsigned long long)pattern->latency_count,
+                                 (unsigned long long)pattern->latency_sum_ns);
+        for (size_t q = 0; ok && q < SUMMARY_COUNT; q++) {
+            ok = append_format(
+                buffer, ",\"%s\":%llu", SUMMARY_KEYS[q],
+                (unsigned long long)rift_metrics_latency_quantile(pattern, SUMMARY_QUANTILES[q]));
+        }
+        ok = ok && append_format(buffer, "}}");
+    }
+    return ok && append_format(buffer, "]}\n");
+}
+
+bool
+rift_metrics_snapshot(const rift_metrics_t *metrics, rift_metrics_format_t format,
+                      rift_output_buffer_t *buffer)
+{
+    if (!metrics || !buffer) {
+        return false;
+    }
+
+    size_t count = rift_metrics_get_pattern_count(metrics);
+    rift_metrics_pattern_t *patterns = NULL;
+    if (count > 0) {
+        patterns = (rift_metrics_pattern_t *)rift_malloc(count * sizeof(*patterns));
+        if (!patterns) {
+            return false;
+        }
+    }
+    for (size_t p = 0; p < count; p++) {
+        rift_metrics_get_pattern(metrics, (uint32_t)p, &patterns[p]);
+    }
+
+    bool ok = format == RIFT_METRICS_FORMAT_JSON ? write_json(buffer, patterns, count)
+                                                 : write_prometheus(buffer, patterns, count);
+    rift_free(patterns);
+    return ok;
+}
@@ -0,0 +1,194 @@
+/**
+ * @file perf_counters.c
+ * @brief Implementation of hardware performance counters on perf_event_open
+ *
+ * Every event is opened on its own rather than as one group: a group can
+ * only be scheduled whole, so a single event the machine lacks, which is
+ * common for the cache events under virtualization, would lose all of
+ * them.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+#include "core/runtime/perf_counters.h"
+#include <string.h>
+#include "core/memory/memory.h"
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Counters structure
+ */
+struct rift_perf_counters {
+    int fds[RIFT_PERF_EVENT_COUNT]; /**< File of each event, -1 if it is not counted */
+};
+
+static const char *const EVENT_NAMES[RIFT_PERF_EVENT_COUNT] = {
+    "cycles", "instructions", "branch_misses", "l1d_misses", "llc_misses", "dtlb_misses",
+};
+
+#ifdef __linux__
+
+/**
+ * @brief Open one event for the calling thread, disabled
+ *
+ * @return The file of the event, or -1 if it cannot be counted
+ */
+static int
+open_event(rift_perf_event_t event)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    switch (event) {
+    case RIFT_PERF_EVENT_CYCLES:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+    case RIFT_PERF_EVENT_INSTRUCTIONS:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+    case RIFT_PERF_EVENT_BRANCH_MISSES:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+    case RIFT_PERF_EVENT_L1D_MISSES:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        break;
+    case RIFT_PERF_EVENT_LLC_MISSES:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        break;
+    case RIFT_PERF_EVENT_DTLB_MISSES:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        break;
+    default:
+        return -1;
+    }
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+#endif /* __linux__ */
+
+rift_perf_counters_t *
+rift_perf_counters_create(void)
+{
+#ifdef __linux__
+    rift_perf_counters_t *counters =
+        (rift_perf_counters_t *)rift_malloc(sizeof(rift_perf_counters_t));
+    if (!counters) {
+        return NULL;
+    }
+
+    size_t opened = 0;
+    for (size_t i = 0; i < RIFT_PERF_EVENT_COUNT; i++) {
+        counters->fds[i] = open_event((rift_perf_event_t)i);
+        opened += counters->fds[i] >= 0;
+    }
+    if (opened == 0) {
+        rift_free(counters);
+        return NULL;
+    }
+    return counters;
+#else
+    return NULL;
+#endif
+}
+
+void
+rift_perf_counters_free(rift_perf_counters_t *counters)
+{
+    if (!counters) {
+        return;
+    }
+
+#ifdef __linux__
+    for (size_t i = 0; i < RIFT_PERF_EVENT_COUNT; i++) {
+        if (counters->fds[i] >= 0) {
+            close(counters->fds[i]);
+        }
+    }
+#endif
+    rift_free(counters);
+}
+
+bool
+rift_perf_counters_start(rift_perf_counters_t *counters)
+{
+    if (!counters) {
+        return false;
+    }
+
+#ifdef __linux__
+    for (size_t i = 0; i < RIFT_PERF_EVENT_COUNT; i++) {
+        if (counters->fds[i] >= 0) {
+            ioctl(counters->fds[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(counters->fds[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool
+rift_perf_counters_stop(rift_perf_counters_t *counters, rift_perf_sample_t *sample)
+{
+    if (!sample) {
+        return false;
+    }
+    memset(sample, 0, sizeof(*sample));
+    if (!counters) {
+        return false;
+    }
+
+    bool any = false;
+#ifdef __linux__
+    for (size_t i = 0; i < RIFT_PERF_EVENT_COUNT; i++) {
+        if (counters->fds[i] >= 0) {
+            ioctl(counters->fds[i], PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+
+    // Read after every event stopped, so none counts the reads of the others
+    for (size_t i = 0; i < RIFT_PERF_EVENT_COUNT; i++) {
+        uint64_t data[3]; /* value, time enabled, time running */
+        if (counters->fds[i] < 0 ||
+            read(counters->fds[i], data, sizeof(data)) != (ssize_t)sizeof(data) || data[2] == 0) {
+            continue;
+        }
+        double scale = data[2] < data[1] ? (double)data[1] / (double)data[2] : 1.0;
+        sample->values[i] = (uint64_t)((double)data[0] * scale);
+        sample->valid[i] = true;
+        any = true;
+    }
+#endif
+    return any;
+}
+
+const char *
+rift_perf_event_name(rift_perf_event_t event)
+{
+    return (unsigned)event < RIFT_PERF_EVENT_COUNT ? EVENT_NAMES[event] : "unknown";
+}
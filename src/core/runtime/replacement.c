@@ -0,0 +1,290 @@
+/**
+ * @file replacement.c
+ * @brief Implementation of replacement templates and growable output buffers
+ *
+ * This file splits a replacement template into literal and group pieces once,
+ * so expanding it for a match only copies bytes.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/runtime/replacement.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/memory/memory.h"
+
+/**
+ * @brief Initialize an empty output buffer
+ *
+ * @param buffer The buffer
+ */
+void
+rift_output_buffer_init(rift_output_buffer_t *buffer)
+{
+    if (!buffer) {
+        return;
+    }
+
+    buffer->data = NULL;
+    buffer->length = 0;
+    buffer->capacity = 0;
+}
+
+/**
+ * @brief Append bytes to an output buffer
+ *
+ * @param buffer The buffer
+ * @param bytes The bytes to append (can be NULL if length is 0)
+ * @param length Number of bytes
+ * @return true if successful, false on allocation failure
+ */
+bool
+rift_output_buffer_append(rift_output_buffer_t *buffer, const char *bytes, size_t length)
+{
+    if (!buffer || (!bytes && length > 0)) {
+        return false;
+    }
+
+    // Room for the terminator is always kept
+    size_t needed = buffer->length + length + 1;
+    if (needed > buffer->capacity) {
+        size_t capacity = buffer->capacity ? buffer->capacity : 64;
+        while (capacity < needed) {
+            capacity *= 2;
+        }
+
+        char *data = (char *)rift_realloc(buffer->data, capacity);
+        if (!data) {
+            return false;
+        }
+        buffer->data = data;
+        buffer->capacity = capacity;
+    }
+
+    if (length > 0) {
+        memcpy(buffer->data + buffer->length, bytes, length);
+    }
+    buffer->length += length;
+    buffer->data[buffer->length] = '\0';
+    return true;
+}
+
+/**
+ * @brief Empty an output buffer, keeping its memory
+ *
+ * @param buffer The buffer
+ */
+void
+rift_output_buffer_clear(rift_output_buffer_t *buffer)
+{
+    if (!buffer) {
+        return;
+    }
+
+    buffer->length = 0;
+    if (buffer->data) {
+        buffer->data[0] = '\0';
+    }
+}
+
+/**
+ * @brief Release the memory of an output buffer
+ *
+ * @param buffer The buffer, left empty and reusable
+ */
+void
+rift_output_buffer_free(rift_output_buffer_t *buffer)
+{
+    if (!buffer) {
+        return;
+    }
+
+    rift_free(buffer->data);
+    rift_output_buffer_init(buffer);
+}
+
+/**
+ * @brief Append a piece to a replacement, merging adjacent literal text
+ *
+ * @param replacement The replacement
+ * @param piece The piece to append
+ */
+static void
+add_piece(rift_replacement_t *replacement, const rift_replacement_piece_t *piece)
+{
+    if (!piece->is_group) {
+        if (piece->length == 0) {
+            return;
+        }
+
+        rift_replacement_piece_t *last =
+            replacement->num_pieces > 0 ? &replacement->pieces[replacement->num_pieces - 1] : NULL;
+        if (last && !last->is_group && last->offset + last->length == piece->offset) {
+            last->length += piece->length;
+            return;
+        }
+    } else if (piece->group > replacement->max_group) {
+        replacement->max_group = piece->group;
+    }
+
+    replacement->pieces[replacement->num_pieces++] = *piece;
+}
+
+/**
+ * @brief Parse a replacement template
+ *
+ * @param text The template text
+ * @param error Pointer to store error information (can be NULL)
+ * @return A new replacement or NULL on failure
+ */
+rift_replacement_t *
+rift_replacement_compile(const char *text, rift_regex_error_t *error)
+{
+    if (!text) {
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Null replacement template provided");
+        }
+        return NULL;
+    }
+
+    size_t length = strlen(text);
+    rift_replacement_t *replacement = (rift_replacement_t *)rift_calloc(1, sizeof(*replacement));
+    if (replacement) {
+        replacement->text = (char *)rift_malloc(length + 1);
+        // A template never has more pieces than bytes
+        replacement->pieces = (rift_replacement_piece_t *)rift_malloc(
+            (length + 1) * sizeof(rift_replacement_piece_t));
+    }
+    if (!replacement || !replacement->text || !replacement->pieces) {
+        rift_replacement_free(replacement);
+        if (error) {
+            error->code = RIFT_REGEX_ERROR_MEMORY;
+            snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                     "Failed to allocate replacement template");
+        }
+        return NULL;
+    }
+    memcpy(replacement->text, text, length + 1);
+
+    size_t pos = 0;
+    while (pos < length) {
+        rift_replacement_piece_t piece = {false, pos, 1, 0};
+
+        if (text[pos] != '$' || pos + 1 == length) {
+            add_piece(replacement, &piece);
+            pos++;
+            continue;
+        }
+
+        // $$ is a literal $
+        if (text[pos + 1] == '$') {
+            add_piece(replacement, &piece);
+            pos += 2;
+            continue;
+        }
+
+        bool braced = text[pos + 1] == '{';
+        size_t digits = pos + (braced ? 2 : 1);
+        size_t end = digits;
+        size_t group = 0;
+        while (end < length && isdigit((unsigned char)text[end])) {
+            group = group * 10 + (size_t)(text[end] - '0');
+            end++;
+        }
+
+        if (end == digits || (braced && (end == length || text[end] != '}'))) {
+            if (braced) {
+                rift_replacement_free(replacement);
+                if (error) {
+                    error->code = RIFT_REGEX_ERROR_SYNTAX;
+                    error->position = pos;
+                    snprintf(error->message, RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH,
+                             "Unterminated group reference at position %zu", pos);
+                }
+                return NULL;
+            }
+
+            // A $ not followed by a group number is literal
+            add_piece(replacement, &piece);
+            pos++;
+            continue;
+        }
+
+        piece.is_group = true;
+        piece.length = 0;
+        piece.group = group;
+        add_piece(replacement, &piece);
+        pos = braced ? end + 1 : end;
+    }
+
+    return replacement;
+}
+
+/**
+ * @brief Free a replacement template
+ *
+ * @param replacement The replacement to free
+ */
+void
+rift_replacement_free(rift_replacement_t *replacement)
+{
+    if (!replacement) {
+        return;
+    }
+
+    rift_free(replacement->text);
+    rift_free(replacement->pieces);
+    rift_free(replacement);
+}
+
+/**
+ * @brief Append the expansion of a replacement for one match
+ *
+ * @param replacement The replacement
+ * @param input The input the spans refer to
+ * @param spans The spans of the match, spans[0] being the whole match
+ * @param num_spans Number of spans
+ * @param output The buffer to append to
+ * @return true if successful, false on invalid parameters or allocation failure
+ */
+bool
+rift_replacement_expand(const rift_replacement_t *replacement, const char *input,
+                        const rift_regex_span_t *spans, size_t num_spans,
+                        rift_output_buffer_t *output)
+{
+    if (!replacement || !output || (!spans && num_spans > 0)) {
+        return false;
+    }
+
+    for (size_t i = 0; i < replacement->num_pieces; i++) {
+        const rift_replacement_piece_t *piece = &replacement->pieces[i];
+
+        if (!piece->is_group) {
+            if (!rift_output_buffer_append(output, replacement->text + piece->offset,
+                                           piece->length)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (piece->group >= num_spans || !input) {
+            continue;
+        }
+
+        const rift_regex_span_t *span = &spans[piece->group];
+        if (span->start == RIFT_REGEX_SPAN_UNSET || span->start > span->end) {
+            continue;
+        }
+
+        if (!rift_output_buffer_append(output, input + span->start, span->end - span->start)) {
+            return false;
+        }
+    }
+
+    return true;
+}
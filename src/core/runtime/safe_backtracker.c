@@ -1,1077 +1,546 @@
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
+/**
+ * @file safe_backtracker.c
+ * @brief Implementation of thread-safe backtracker for the LibRift regex engine
+ *
+ * This file implements the thread-safe backtracker as a thread-local
+ * instance policy over the backtracker in backtracker.c. The depth limit and
+ * the bailout hook are enforced by each thread's backtracker, not repeated
+ * here. Each thread finds its backtracker through a _Thread_local cache, so
+ * the mutex is only taken the first time a thread uses a safe backtracker and
+ * after the policy changes; there is no process-wide registry.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
 #include "core/runtime/safe_backtracker.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
-ore/runtime/safe_backtracker.h"/a #include "core/errors/regex_error.h"
+#include <stdatomic.h>
+#include <stdlib.h>
+
+/**
+ * @brief Number of safe backtrackers a thread finds without a key lookup
+ */
+#define SAFE_BACKTRACKER_TLS_SLOTS 4
+
+/**
+ * @brief A thread's backtracker for one safe backtracker
+ *
+ * Arenas are linked into their owner when a thread first uses it, the only
+ * time that thread takes the owner's mutex unless the policy changes.
+ */
+struct rift_safe_backtracker_arena {
+    rift_regex_safe_backtracker_t *owner;     /**< Safe backtracker this arena belongs to */
+    rift_regex_backtracker_t *backtracker;    /**< The thread's frames */
+    uint64_t generation;                      /**< Policy generation last applied */
+    struct rift_safe_backtracker_arena *prev; /**< Previous arena of the owner */
+    struct rift_safe_backtracker_arena *next; /**< Next arena of the owner */
+};
+
+/**
+ * @brief Entry of the per-thread cache, keyed by the owner's id
+ *
+ * Ids are never reused, so an entry left behind by a freed safe backtracker
+ * can never match again.
+ */
+typedef struct tls_slot {
+    uint64_t id;                               /**< Id of the owner, 0 if empty */
+    struct rift_safe_backtracker_arena *arena; /**< The calling thread's arena */
+} tls_slot_t;
+
+static _Thread_local tls_slot_t tls_cache[SAFE_BACKTRACKER_TLS_SLOTS];
+static _Thread_local size_t tls_next_slot;
+
+/* Source of safe backtracker ids */
+static atomic_uint_fast64_t next_safe_backtracker_id = 1;
+
+/**
+ * @brief Unlink an arena from its owner and free it
+ *
+ * @param arena The arena, whose owner's mutex is held
+ */
+static void
+free_arena_locked(struct rift_safe_backtracker_arena *arena)
+{
+    if (arena->prev) {
+        arena->prev->next = arena->next;
+    } else {
+        arena->owner->arenas = arena->next;
+    }
+    if (arena->next) {
+        arena->next->prev = arena->prev;
+    }
+
+    rift_backtracker_free(arena->backtracker);
+    free(arena);
+}
+
+/**
+ * @brief Cleanup function for thread-local backtracker
+ *
+ * This function is registered with pthread_key_create() to ensure that
+ * thread-local resources are cleaned up when a thread exits.
+ *
+ * @param arena The exiting thread's arena
+ */
+static void
+thread_local_backtracker_cleanup(void *arena)
+{
+    struct rift_safe_backtracker_arena *local = (struct rift_safe_backtracker_arena *)arena;
+    if (!local) {
+        return;
+    }
+
+    rift_regex_safe_backtracker_t *owner = local->owner;
+    pthread_mutex_lock(&owner->mutex);
+    free_arena_locked(local);
+    pthread_mutex_unlock(&owner->mutex);
+}
+
+/**
+ * @brief Create and register the calling thread's arena
+ *
+ * This is the one place a thread takes the owner's mutex on its way to a
+ * backtracker.
+ *
+ * @param safe_bt The thread-safe backtracker
+ * @return The new arena or NULL on failure
+ */
+static struct rift_safe_backtracker_arena *
+register_arena(rift_regex_safe_backtracker_t *safe_bt)
+{
+    struct rift_safe_backtracker_arena *arena =
+        (struct rift_safe_backtracker_arena *)calloc(1, sizeof(*arena));
+    if (!arena) {
+        return NULL;
+    }
+    arena->owner = safe_bt;
+
+    if (pthread_mutex_lock(&safe_bt->mutex) != 0) {
+        free(arena);
+        return NULL;
+    }
+
+    arena->backtracker = rift_backtracker_create_with_policy(&safe_bt->policy, safe_bt->num_groups);
+    arena->generation = atomic_load_explicit(&safe_bt->policy_generation, memory_order_relaxed);
+    if (!arena->backtracker || pthread_setspecific(safe_bt->thread_local_key, arena) != 0) {
+        pthread_mutex_unlock(&safe_bt->mutex);
+        rift_backtracker_free(arena->backtracker);
+        free(arena);
+        return NULL;
+    }
+
+    arena->next = safe_bt->arenas;
+    if (arena->next) {
+        arena->next->prev = arena;
+    }
+    safe_bt->arenas = arena;
+
+    pthread_mutex_unlock(&safe_bt->mutex);
+    return arena;
+}
+
+/**
+ * @brief Apply a changed policy to the calling thread's arena
+ *
+ * @param safe_bt The thread-safe backtracker
+ * @param arena The calling thread's arena
+ */
+static void
+sync_arena_policy(rift_regex_safe_backtracker_t *safe_bt,
+                  struct rift_safe_backtracker_arena *arena)
+{
+    if (pthread_mutex_lock(&safe_bt->mutex) != 0) {
+        return;
+    }
+
+    rift_backtracker_set_policy(arena->backtracker, &safe_bt->policy);
+    arena->generation = atomic_load_explicit(&safe_bt->policy_generation, memory_order_relaxed);
+
+    pthread_mutex_unlock(&safe_bt->mutex);
+}
+
+/**
+ * @brief Create a new thread-safe backtracker with a policy
+ *
+ * @param policy The policy every thread-local backtracker gets
+ * @param num_groups Number of capture groups
+ * @return Pointer to the new thread-safe backtracker or NULL on failure
+ */
+rift_regex_safe_backtracker_t *
+rift_safe_backtracker_create_with_policy(const rift_backtracker_policy_t *policy,
+                                         size_t num_groups)
+{
+    if (!policy) {
+        return NULL;
+    }
+
+    rift_regex_safe_backtracker_t *safe_bt =
+        (rift_regex_safe_backtracker_t *)calloc(1, sizeof(rift_regex_safe_backtracker_t));
+    if (!safe_bt) {
+        return NULL;
+    }
+
+    /* Initialize the mutex */
+    if (pthread_mutex_init(&safe_bt->mutex, NULL) != 0) {
+        free(safe_bt);
+        return NULL;
+    }
+
+    /* Initialize thread-local storage key */
+    if (pthread_key_create(&safe_bt->thread_local_key, thread_local_backtracker_cleanup) != 0) {
+        pthread_mutex_destroy(&safe_bt->mutex);
+        free(safe_bt);
+        return NULL;
+    }
+
+    safe_bt->policy = *policy;
+    safe_bt->num_groups = num_groups;
+    safe_bt->id = atomic_fetch_add_explicit(&next_safe_backtracker_id, 1, memory_order_relaxed);
+    atomic_init(&safe_bt->policy_generation, 0);
+    safe_bt->arenas = NULL;
+    safe_bt->initialized = true;
+
+    /* Initialize the global backtracker as a fallback */
+    safe_bt->global_bt = rift_backtracker_create_with_policy(policy, num_groups);
+    if (!safe_bt->global_bt) {
+        rift_safe_backtracker_free(safe_bt);
+        return NULL;
+    }
+
+    return safe_bt;
+}
+
+/**
+ * @brief Create a new thread-safe backtracker
+ *
+ * @param max_depth Maximum backtracking depth
+ * @param num_groups Number of capture groups
+ * @return Pointer to the new thread-safe backtracker or NULL on failure
+ */
+rift_regex_safe_backtracker_t *
+rift_safe_backtracker_create(uint32_t max_depth, size_t num_groups)
+{
+    rift_backtracker_policy_t policy;
+    rift_backtracker_policy_init(&policy, max_depth);
+    return rift_safe_backtracker_create_with_policy(&policy, num_groups);
+}
+
+/**
+ * @brief Get the calling thread's backtracker, creating it on first use
+ *
+ * The thread-local cache answers repeat calls without a key lookup or a
+ * lock. A miss falls back to the pthread key, and only a thread's first call
+ * for this safe backtracker, or its first call after a policy change, locks.
+ *
+ * @param safe_bt The thread-safe backtracker
+ * @return Pointer to the thread-local backtracker or NULL on failure
+ */
+rift_regex_backtracker_t *
+rift_safe_backtracker_get_local(rift_regex_safe_backtracker_t *safe_bt)
+{
+    if (!safe_bt || !safe_bt->initialized) {
+        return NULL;
+    }
+
+    struct rift_safe_backtracker_arena *arena = NULL;
+    for (size_t i = 0; i < SAFE_BACKTRACKER_TLS_SLOTS; i++) {
+        if (tls_cache[i].id == safe_bt->id) {
+            arena = tls_cache[i].arena;
+            break;
+        }
+    }
+
+    if (!arena) {
+        arena = (struct rift_safe_backtracker_arena *)pthread_getspecific(
+            safe_bt->thread_local_key);
+        if (!arena) {
+            arena = register_arena(safe_bt);
+        }
+
+        /* Fall back to global backtracker if local creation failed */
+        if (!arena) {
+            return safe_bt->global_bt;
+        }
+
+        tls_cache[tls_next_slot].id = safe_bt->id;
+        tls_cache[tls_next_slot].arena = arena;
+        tls_next_slot = (tls_next_slot + 1) % SAFE_BACKTRACKER_TLS_SLOTS;
+    }
+
+    if (arena->generation !=
+        atomic_load_explicit(&safe_bt->policy_generation, memory_order_acquire)) {
+        sync_arena_policy(safe_bt, arena);
+    }
+
+    return arena->backtracker;
+}
+
+/**
+ * @brief Push a new backtrack point onto the backtracker stack
+ *
+ * @param safe_bt The thread-safe backtracker
+ * @param state The current state
+ * @param input_position Position in the input string
+ * @param group_starts Array of group start positions
+ * @param group_ends Array of group end positions
+ * @param num_groups Number of groups
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if the point was pushed successfully, false otherwise
+ */
+bool
+rift_safe_backtracker_push(rift_regex_safe_backtracker_t *safe_bt, rift_regex_state_t *state,
+                           size_t input_position, const size_t *group_starts,
+                           const size_t *group_ends, size_t num_groups, rift_regex_error_t *error)
+{
+    if (!safe_bt || !state || !group_starts || !group_ends) {
+        if (error) {
+            rift_regex_error_set_with_message(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                                              "Invalid backtracker parameters");
+        }
+        return false;
+    }
+
+    /* Get the thread-local backtracker */
+    rift_regex_backtracker_t *local_bt = rift_safe_backtracker_get_local(safe_bt);
+    if (!local_bt) {
+        if (error) {
+            rift_regex_error_set_with_message(error, RIFT_REGEX_ERROR_INTERNAL,
+                                              "Failed to get thread-local backtracker");
+        }
+        return false;
+    }
+
+    /* The backtracker enforces the depth limit and calls the bailout hook */
+    if (!rift_backtracker_push(local_bt, state, input_position, group_starts, group_ends,
+                               num_groups)) {
+        if (error) {
+            if (rift_backtracker_get_depth(local_bt) >= rift_backtracker_get_max_depth(local_bt)) {
+                rift_regex_error_set_with_message(error, RIFT_REGEX_ERROR_BACKTRACKING_LIMIT,
+                                                  "Maximum backtracking depth exceeded");
+            } else {
+                rift_regex_error_set_with_message(error, RIFT_REGEX_ERROR_INTERNAL,
+                                                  "Failed to push backtrack point");
+            }
+        }
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Pop a backtrack point from the backtracker stack
+ *
+ * @param safe_bt The thread-safe backtracker
+ * @param state Pointer to store the state
+ * @param input_position Pointer to store the input position
+ * @param group_starts Array to store group start positions
+ * @param group_ends Array to store group end positions
+ * @param num_groups Pointer to store the number of groups
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if a point was popped, false if the stack was empty
+ */
+bool
+rift_safe_backtracker_pop(rift_regex_safe_backtracker_t *safe_bt, rift_regex_state_t **state,
+                          size_t *input_position, size_t *group_starts, size_t *group_ends,
+                          size_t *num_groups, rift_regex_error_t *error)
+{
+    if (!safe_bt || !state || !input_position || !group_starts || !group_ends || !num_groups) {
+        if (error) {
+            rift_regex_error_set_with_message(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                                              "Invalid backtracker parameters");
+        }
+        return false;
+    }
+
+    /* Get the thread-local backtracker */
+    rift_regex_backtracker_t *local_bt = rift_safe_backtracker_get_local(safe_bt);
+    if (!local_bt) {
+        if (error) {
+            rift_regex_error_set_with_message(error, RIFT_REGEX_ERROR_INTERNAL,
+                                              "Failed to get thread-local backtracker");
+        }
+        return false;
+    }
+
+    /* Pop the backtrack point */
+    return rift_backtracker_pop(local_bt, state, input_position, group_starts, group_ends,
+                                num_groups);
+}
+
+/**
+ * @brief Check if the backtracker stack is empty
+ *
+ * @param safe_bt The thread-safe backtracker
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if the stack is empty, false otherwise
+ */
+bool
+rift_safe_backtracker_is_empty(rift_regex_safe_backtracker_t *safe_bt, rift_regex_error_t *error)
+{
+    if (!safe_bt) {
+        if (error) {
+            rift_regex_error_set_with_message(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                                              "Invalid backtracker parameter");
+        }
+        return true; /* Consider NULL backtracker as empty */
+    }
+
+    /* Get the thread-local backtracker */
+    rift_regex_backtracker_t *local_bt = rift_safe_backtracker_get_local(safe_bt);
+    if (!local_bt) {
+        if (error) {
+            rift_regex_error_set_with_message(error, RIFT_REGEX_ERROR_INTERNAL,
+                                              "Failed to get thread-local backtracker");
+        }
+        return true; /* Consider failure to get backtracker as empty */
+    }
+
+    /* Check if the backtracker is empty */
+    return rift_backtracker_is_empty(local_bt);
+}
+
+/**
+ * @brief Reset the backtracker
+ *
+ * @param safe_bt The thread-safe backtracker
+ * @param error Pointer to store error information (can be NULL)
+ * @return true if successful, false otherwise
+ */
+bool
+rift_safe_backtracker_reset(rift_regex_safe_backtracker_t *safe_bt, rift_regex_error_t *error)
+{
+    if (!safe_bt) {
+        if (error) {
+            rift_regex_error_set_with_message(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                                              "Invalid backtracker parameter");
+        }
+        return false;
+    }
+
+    /* Get the thread-local backtracker */
+    rift_regex_backtracker_t *local_bt = rift_safe_backtracker_get_local(safe_bt);
+    if (!local_bt) {
+        if (error) {
+            rift_regex_error_set_with_message(error, RIFT_REGEX_ERROR_INTERNAL,
+                                              "Failed to get thread-local backtracker");
+        }
+        return false;
+    }
+
+    /* Reset the backtracker */
+    rift_backtracker_reset(local_bt);
+    return true;
+}
+
+/**
+ * @brief Get the current depth of the backtracker stack
+ *
+ * @param safe_bt The thread-safe backtracker
+ * @param error Pointer to store error information (can be NULL)
+ * @return The current depth or (size_t)-1 on error
+ */
+size_t
+rift_safe_backtracker_get_depth(rift_regex_safe_backtracker_t *safe_bt, rift_regex_error_t *error)
+{
+    if (!safe_bt) {
+        if (error) {
+            rift_regex_error_set_with_message(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
+                                              "Invalid backtracker parameter");
+        }
+        return (size_t)-1;
+    }
+
+    /* Get the thread-local backtracker */
+    rift_regex_backtracker_t *local_bt = rift_safe_backtracker_get_local(safe_bt);
+    if (!local_bt) {
+        if (error) {
+            rift_regex_error_set_with_message(error, RIFT_REGEX_ERROR_INTERNAL,
+                                              "Failed to get thread-local backtracker");
+        }
+        return (size_t)-1;
+    }
+
+    /* Get the current depth */
+    return rift_backtracker_get_depth(local_bt);
+}
+
+/**
+ * @brief Get the maximum depth allowed for the backtracker
+ *
+ * @param safe_bt The thread-safe backtracker
+ * @return The maximum allowed depth
+ */
+uint32_t
+rift_safe_backtracker_get_max_depth(const rift_regex_safe_backtracker_t *safe_bt)
+{
+    if (!safe_bt) {
+        return 0; /* Return 0 for NULL backtracker */
+    }
+
+    return (uint32_t)safe_bt->policy.max_depth;
+}
+
+/**
+ * @brief Set the maximum depth for the backtracker
+ *
+ * @param safe_bt The thread-safe backtracker
+ * @param max_depth The new maximum depth
+ * @return true if successful, false otherwise
+ */
+bool
+rift_safe_backtracker_set_max_depth(rift_regex_safe_backtracker_t *safe_bt, uint32_t max_depth)
+{
+    if (!safe_bt) {
+        return false;
+    }
+
+    /* Lock the mutex to ensure thread safety */
+    if (pthread_mutex_lock(&safe_bt->mutex) != 0) {
+        return false;
+    }
+
+    /* Threads apply the new policy to their own arena on their next call */
+    safe_bt->policy.max_depth = max_depth;
+    rift_backtracker_set_max_depth(safe_bt->global_bt, max_depth);
+    atomic_fetch_add_explicit(&safe_bt->policy_generation, 1, memory_order_release);
+
+    /* Unlock the mutex */
+    pthread_mutex_unlock(&safe_bt->mutex);
+
+    return true;
+}
+
+/**
+ * @brief Free resources associated with a thread-safe backtracker
+ *
+ * @param safe_bt The thread-safe backtracker to free
+ */
+void
+rift_safe_backtracker_free(rift_regex_safe_backtracker_t *safe_bt)
+{
+    if (!safe_bt) {
+        return;
+    }
+
+    if (safe_bt->initialized) {
+        /* Clean up thread-local storage key, so no destructor runs from here on */
+        pthread_key_delete(safe_bt->thread_local_key);
+
+        /* Free every thread's arena, the key destructor no longer will */
+        while (safe_bt->arenas) {
+            free_arena_locked(safe_bt->arenas);
+        }
+
+        /* Clean up mutex */
+        pthread_mutex_destroy(&safe_bt->mutex);
+
+        /* Free the global backtracker */
+        if (safe_bt->global_bt) {
+            rift_backtracker_free(safe_bt->global_bt);
+        }
+    }
+
+    /* Free the thread-safe backtracker itself */
+    free(safe_bt);
+}
@@ -0,0 +1,292 @@
+/**
+ * @file trace_buffer.c
+ * @brief Implementation of the match trace ring buffer
+ *
+ * A record is packed as the input position in the high 32 bits, the event
+ * in the next 4 and the location in the low 28. Recording lives in the
+ * header so that the engines inline it; this file holds what readers use.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/runtime/trace_buffer.h"
+#include <stdlib.h>
+#include <string.h>
+#include "core/memory/memory.h"
+
+/**
+ * @brief Names of the events, indexed by rift_trace_event_t
+ */
+static const char *const event_names[RIFT_TRACE_EVENT_COUNT] = {
+    "start", "step", "fail", "backtrack", "match",
+};
+
+/**
+ * @brief Create a trace buffer
+ *
+ * @param capacity Records kept, rounded up to a power of two, 0 for the default
+ * @return A new buffer or NULL on allocation failure
+ */
+rift_trace_buffer_t *
+rift_trace_buffer_create(size_t capacity)
+{
+    if (capacity == 0) {
+        capacity = RIFT_TRACE_BUFFER_DEFAULT_CAPACITY;
+    }
+    size_t slots = 1;
+    while (slots < capacity) {
+        if (slots > SIZE_MAX / 2 / sizeof(uint64_t)) {
+            return NULL;
+        }
+        slots *= 2;
+    }
+
+    rift_trace_buffer_t *buffer = (rift_trace_buffer_t *)rift_malloc(sizeof(*buffer));
+    if (!buffer) {
+        return NULL;
+    }
+
+    buffer->slots = (_Atomic uint64_t *)rift_malloc(slots * sizeof(uint64_t));
+    if (!buffer->slots) {
+        rift_free(buffer);
+        return NULL;
+    }
+    for (size_t i = 0; i < slots; i++) {
+        atomic_init(&buffer->slots[i], 0);
+    }
+    buffer->mask = slots - 1;
+    atomic_init(&buffer->claimed, 0);
+    atomic_init(&buffer->published, 0);
+    buffer->events = RIFT_TRACE_EVENTS_ALL;
+    return buffer;
+}
+
+/**
+ * @brief Free a trace buffer
+ *
+ * @param buffer The buffer (can be NULL)
+ */
+void
+rift_trace_buffer_free(rift_trace_buffer_t *buffer)
+{
+    if (!buffer) {
+        return;
+    }
+
+    rift_free((void *)buffer->slots);
+    rift_free(buffer);
+}
+
+/**
+ * @brief Choose the events recorded
+ *
+ * @param buffer The buffer
+ * @param events Mask of (1u << event) bits
+ */
+void
+rift_trace_buffer_set_events(rift_trace_buffer_t *buffer, uint32_t events)
+{
+    if (buffer) {
+        buffer->events = events & RIFT_TRACE_EVENTS_ALL;
+    }
+}
+
+/**
+ * @brief Drop every record
+ *
+ * @param buffer The buffer
+ */
+void
+rift_trace_buffer_clear(rift_trace_buffer_t *buffer)
+{
+    if (!buffer) {
+        return;
+    }
+
+    atomic_store_explicit(&buffer->claimed, 0, memory_order_relaxed);
+    atomic_store_explicit(&buffer->published, 0, memory_order_release);
+}
+
+/**
+ * @brief Get the number of records kept
+ *
+ * @param buffer The buffer
+ * @return The capacity in records, 0 for NULL
+ */
+size_t
+rift_trace_buffer_get_capacity(const rift_trace_buffer_t *buffer)
+{
+    return buffer ? buffer->mask + 1 : 0;
+}
+
+/**
+ * @brief Get the number of records made since the buffer was created or cleared
+ *
+ * @param buffer The buffer
+ * @return The number of records, 0 for NULL
+ */
+uint64_t
+rift_trace_buffer_get_total(const rift_trace_buffer_t *buffer)
+{
+    return buffer ? atomic_load_explicit(&buffer->published, memory_order_acquire) : 0;
+}
+
+/**
+ * @brief Unpack a record
+ */
+static rift_trace_record_t
+unpack_record(uint64_t word)
+{
+    rift_trace_record_t record;
+    record.location = (uint32_t)(word & RIFT_TRACE_LOCATION_MAX);
+    record.position = (uint32_t)(word >> 32);
+    record.event = (rift_trace_event_t)((word >> 28) & 0xF);
+    return record;
+}
+
+/**
+ * @brief Copy the latest records, oldest first
+ *
+ * This is the read side of a sequence lock: the records are copied, then
+ * claimed is read again, and every record the writer may have started to
+ * overwrite in the meantime is dropped from the front.
+ *
+ * @param buffer The buffer
+ * @param records Where the records go
+ * @param max_records Room in records
+ * @return The number of records copied
+ */
+size_t
+rift_trace_buffer_snapshot(const rift_trace_buffer_t *buffer, rift_trace_record_t *records,
+                           size_t max_records)
+{
+    if (!buffer || !records || max_records == 0) {
+        return 0;
+    }
+
+    size_t capacity = buffer->mask + 1;
+    size_t room = max_records < capacity ? max_records : capacity;
+    uint64_t end = atomic_load_explicit(&buffer->published, memory_order_acquire);
+    uint64_t begin = end > room ? end - room : 0;
+
+    uint64_t *words = (uint64_t *)rift_malloc((size_t)(end - begin) * sizeof(uint64_t) + 1);
+    if (!words) {
+        return 0;
+    }
+    for (uint64_t i = begin; i < end; i++) {
+        words[i - begin] =
+            atomic_load_explicit(&buffer->slots[i & buffer->mask], memory_order_relaxed);
+    }
+
+    /* Slots of records at or past claimed - capacity may hold newer records now */
+    atomic_thread_fence(memory_order_acquire);
+    uint64_t claimed = atomic_load_explicit(&buffer->claimed, memory_order_relaxed);
+    uint64_t first = claimed > capacity ? claimed - capacity : 0;
+    if (first < begin) {
+        first = begin;
+    }
+
+    size_t count = 0;
+    for (uint64_t i = first; i < end; i++) {
+        records[count++] = unpack_record(words[i - begin]);
+    }
+    rift_free(words);
+    return count;
+}
+
+/**
+ * @brief Order records by location
+ */
+static int
+compare_locations(const void *a, const void *b)
+{
+    uint32_t left = ((const rift_trace_record_t *)a)->location;
+    uint32_t right = ((const rift_trace_record_t *)b)->location;
+    return left < right ? -1 : left > right;
+}
+
+/**
+ * @brief Order hotspots the hottest first
+ */
+static int
+compare_hotspots(const void *a, const void *b)
+{
+    const rift_trace_hotspot_t *left = a;
+    const rift_trace_hotspot_t *right = b;
+    if (left->backtracks != right->backtracks) {
+        return left->backtracks > right->backtracks ? -1 : 1;
+    }
+    if (left->failures != right->failures) {
+        return left->failures > right->failures ? -1 : 1;
+    }
+    if (left->records != right->records) {
+        return left->records > right->records ? -1 : 1;
+    }
+    return left->location < right->location ? -1 : left->location > right->location;
+}
+
+/**
+ * @brief Rank the locations of records by the backtracking they saw
+ *
+ * The records are sorted by location on a copy, so a trace of n records
+ * is ranked in O(n log n) whatever the number of locations.
+ *
+ * @param records The records
+ * @param count Number of records
+ * @param hotspots Where the hottest locations go
+ * @param max_hotspots Room in hotspots
+ * @return The number of hotspots written, 0 on allocation failure
+ */
+size_t
+rift_trace_find_hotspots(const rift_trace_record_t *records, size_t count,
+                         rift_trace_hotspot_t *hotspots, size_t max_hotspots)
+{
+    if (!records || count == 0 || !hotspots || max_hotspots == 0) {
+        return 0;
+    }
+
+    rift_trace_record_t *sorted = (rift_trace_record_t *)rift_malloc(count * sizeof(*sorted));
+    rift_trace_hotspot_t *all = (rift_trace_hotspot_t *)rift_malloc(count * sizeof(*all));
+    if (!sorted || !all) {
+        rift_free(sorted);
+        rift_free(all);
+        return 0;
+    }
+    memcpy(sorted, records, count * sizeof(*sorted));
+    qsort(sorted, count, sizeof(*sorted), compare_locations);
+
+    size_t num_locations = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (num_locations == 0 || all[num_locations - 1].location != sorted[i].location) {
+            memset(&all[num_locations], 0, sizeof(all[num_locations]));
+            all[num_locations++].location = sorted[i].location;
+        }
+        rift_trace_hotspot_t *hotspot = &all[num_locations - 1];
+        hotspot->records++;
+        hotspot->backtracks += sorted[i].event == RIFT_TRACE_EVENT_BACKTRACK;
+        hotspot->failures += sorted[i].event == RIFT_TRACE_EVENT_FAIL;
+    }
+    qsort(all, num_locations, sizeof(*all), compare_hotspots);
+
+    size_t written = num_locations < max_hotspots ? num_locations : max_hotspots;
+    memcpy(hotspots, all, written * sizeof(*hotspots));
+    rift_free(sorted);
+    rift_free(all);
+    return written;
+}
+
+/**
+ * @brief Get the name of an event
+ *
+ * @param event The event
+ * @return A lowercase name, "unknown" for an invalid event
+ */
+const char *
+rift_trace_event_name(rift_trace_event_t event)
+{
+    if ((unsigned)event >= RIFT_TRACE_EVENT_COUNT) {
+        return "unknown";
+    }
+    return event_names[event];
+}
@@ -151,22 +151,9 @@ rift_regex_syntax_compile(rift_regex_syntax_context_t *context, const char *patt
         return NULL;
     }
 
-    // Create a new lexer for the pattern
-    rift_regex_syntax_lexer_t *lexer = rift_regex_syntax_lexer_create(pattern);
-    if (!lexer) {
-        set_error(context, RIFT_REGEX_ERROR_MEMORY_ALLOCATION, "Failed to create lexer");
-        return NULL;
-    }
-
-    // Store the lexer in the context
-    if (context->lexer && context->owns_lexer) {
-        rift_regex_syntax_lexer_free(context->lexer);
-    }
-    context->lexer = lexer;
-    context->owns_lexer = true;
-
-    // Parse the pattern
-    rift_regex_ast_t *ast = rift_regex_parser_parse(context->parser, pattern);
+    // Parse the pattern; the parser reads it in one pass, R'' quotes included
+    rift_regex_ast_t *ast =
+        rift_regex_parser_parse_with_options(context->parser, pattern, context->flags);
 
     // Check for parser errors
     if (!ast) {
@@ -11,7 +11,31 @@
 #define _POSIX_C_SOURCE 200809L
 
 #include "core/syntax/lexer.h"
+#include "core/tokenizer/token.h"
 #include "librift/syntax/lexer.h"
+
+/**
+ * @brief Scan a run of plain literal characters as one token
+ *
+ * @param lexer The syntax lexer
+ * @param start_pos Position of the first character of the run
+ * @param length Length of the run
+ * @return The literal run token
+ */
+static rift_regex_token_t
+scan_literal_run(rift_regex_syntax_lexer_t *lexer, size_t start_pos, size_t length)
+{
+    rift_regex_token_t token;
+    token.type = RIFT_REGEX_TOKEN_LITERAL_RUN;
+    token.value = strndup(lexer->input + start_pos, length);
+    token.position = start_pos;
+    token.start = start_pos;
+    token.end = start_pos + length;
+
+    lexer->position += length;
+    return token;
+}
+
 /**
  * @brief Scan a token in standard regex syntax mode
  *
@@ -29,42 +53,30 @@ scan_standard_syntax_token(rift_regex_syntax_lexer_t *lexer)
         return create_token(RIFT_REGEX_TOKEN_END, NULL, start_pos);
     }
 
+    /* Runs of plain literals become one token */
+    rift_regex_token_type_t type = rift_regex_token_byte_type(c);
+    if (type == RIFT_REGEX_TOKEN_LITERAL) {
+        size_t run = rift_regex_token_literal_run(lexer->input + start_pos,
+                                                  lexer->length - start_pos);
+        if (run > 1) {
+            return scan_literal_run(lexer, start_pos, run);
+        }
+    }
+
     /* Handle special characters */
     lexer_advance(lexer);
 
-    switch (c) {
-    case '.':
-        return create_char_token(RIFT_REGEX_TOKEN_DOT, c, start_pos);
-    case '^':
-        return create_char_token(RIFT_REGEX_TOKEN_CARET, c, start_pos);
-    case '$':
-        return create_char_token(RIFT_REGEX_TOKEN_DOLLAR, c, start_pos);
-    case '*':
-        return create_char_token(RIFT_REGEX_TOKEN_STAR, c, start_pos);
-    case '+':
-        return create_char_token(RIFT_REGEX_TOKEN_PLUS, c, start_pos);
-    case '?':
-        return create_char_token(RIFT_REGEX_TOKEN_QUESTION, c, start_pos);
-    case '|':
-        return create_char_token(RIFT_REGEX_TOKEN_PIPE, c, start_pos);
-    case '(':
+    switch (type) {
+    case RIFT_REGEX_TOKEN_LPAREN:
         return scan_group(lexer, start_pos);
-    case ')':
-        return create_char_token(RIFT_REGEX_TOKEN_RPAREN, c, start_pos);
-    case '[':
+    case RIFT_REGEX_TOKEN_LBRACKET:
         return scan_character_class(lexer, start_pos);
-    case ']':
-        return create_char_token(RIFT_REGEX_TOKEN_RBRACKET, c, start_pos);
-    case '{':
+    case RIFT_REGEX_TOKEN_LBRACE:
         return scan_quantifier(lexer, start_pos);
-    case '}':
-        return create_char_token(RIFT_REGEX_TOKEN_RBRACE, c, start_pos);
-    case ',':
-        return create_char_token(RIFT_REGEX_TOKEN_COMMA, c, start_pos);
-    case '\\':
+    case RIFT_REGEX_TOKEN_BACKSLASH:
         return scan_escape_sequence(lexer, start_pos);
     default:
-        return create_char_token(RIFT_REGEX_TOKEN_LITERAL, c, start_pos);
+        return create_char_token(type, c, start_pos);
     }
 }
 
@@ -111,40 +123,32 @@ scan_rift_syntax_token(rift_regex_syntax_lexer_t *lexer)
         return scan_escape_sequence(lexer, start_pos);
     }
 
+    /* Runs of plain literals become one token, up to the closing quote */
+    rift_regex_token_type_t type = rift_regex_token_byte_type(c);
+    if (type == RIFT_REGEX_TOKEN_LITERAL) {
+        size_t run = rift_regex_token_literal_run(lexer->input + start_pos,
+                                                  lexer->length - start_pos);
+        const char *quote = memchr(lexer->input + start_pos, lexer->quote_char, run);
+        if (quote) {
+            run = (size_t)(quote - (lexer->input + start_pos));
+        }
+        if (run > 1) {
+            return scan_literal_run(lexer, start_pos, run);
+        }
+    }
+
     /* Handle other tokens same as regular syntax */
     lexer_advance(lexer);
 
-    switch (c) {
-    case '.':
-        return create_char_token(RIFT_REGEX_TOKEN_DOT, c, start_pos);
-    case '^':
-        return create_char_token(RIFT_REGEX_TOKEN_CARET, c, start_pos);
-    case '$':
-        return create_char_token(RIFT_REGEX_TOKEN_DOLLAR, c, start_pos);
-    case '*':
-        return create_char_token(RIFT_REGEX_TOKEN_STAR, c, start_pos);
-    case '+':
-        return create_char_token(RIFT_REGEX_TOKEN_PLUS, c, start_pos);
-    case '?':
-        return create_char_token(RIFT_REGEX_TOKEN_QUESTION, c, start_pos);
-    case '|':
-        return create_char_token(RIFT_REGEX_TOKEN_PIPE, c, start_pos);
-    case '(':
+    switch (type) {
+    case RIFT_REGEX_TOKEN_LPAREN:
         return scan_group(lexer, start_pos);
-    case ')':
-        return create_char_token(RIFT_REGEX_TOKEN_RPAREN, c, start_pos);
-    case '[':
+    case RIFT_REGEX_TOKEN_LBRACKET:
         return scan_character_class(lexer, start_pos);
-    case ']':
-        return create_char_token(RIFT_REGEX_TOKEN_RBRACKET, c, start_pos);
-    case '{':
+    case RIFT_REGEX_TOKEN_LBRACE:
         return scan_quantifier(lexer, start_pos);
-    case '}':
-        return create_char_token(RIFT_REGEX_TOKEN_RBRACE, c, start_pos);
-    case ',':
-        return create_char_token(RIFT_REGEX_TOKEN_COMMA, c, start_pos);
     default:
-        return create_char_token(RIFT_REGEX_TOKEN_LITERAL, c, start_pos);
+        return create_char_token(type, c, start_pos);
     }
 }
 
@@ -438,6 +442,7 @@ const char *
 rift_regex_syntax_token_type_name(rift_regex_token_type_t type)
 {
     static const char *token_type_names[] = {"LITERAL",
+                                             "LITERAL_RUN",
                                              "DOT",
                                              "CARET",
                                              "DOLLAR",
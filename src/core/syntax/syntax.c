@@ -11,6 +11,7 @@
  */
 
 #include "core/syntax/syntax.h"
+#include <stdatomic.h>
 #include "core/parser/parser.h"
 #include "core/syntax/integration.h"
 #include "core/syntax/lexer.h"
@@ -22,7 +23,7 @@
 
 
 /* Global variables */
-static bool g_syntax_registered = false;
+static atomic_bool g_syntax_registered = false;
 
 /**
  * @brief Create a new regex literal
@@ -243,13 +244,8 @@ rift_regex_parser_extract_pattern(const char *literal_text, char *output, size_t
 bool
 rift_regex_syntax_register(void)
 {
-    // Already registered?
-    if (g_syntax_registered) {
-        return true;
-    }
-
-    // Set the registration flag
-    g_syntax_registered = true;
+    // Registering twice, or from two threads at once, leaves it registered
+    atomic_store(&g_syntax_registered, true);
 
     return true;
 }
@@ -265,13 +261,7 @@ rift_regex_syntax_register(void)
 bool
 rift_regex_syntax_unregister(void)
 {
-    // Already unregistered?
-    if (!g_syntax_registered) {
-        return true;
-    }
-
-    // Clear the registration flag
-    g_syntax_registered = false;
+    atomic_store(&g_syntax_registered, false);
 
     return true;
 }
@@ -284,7 +274,7 @@ rift_regex_syntax_unregister(void)
 bool
 rift_regex_syntax_is_registered(void)
 {
-    return g_syntax_registered;
+    return atomic_load(&g_syntax_registered);
 }
 
 /**
@@ -674,95 +664,3 @@ rift_regex_parser_extract_flags(const char *literal_text, rift_regex_flags_t *fl
 
     return true; // Successfully processed all flags
 }
-/**
- * @brief Extended regex pattern compilation function with automatic R'' syntax detection
- *
- * This function detects whether the pattern uses R'' syntax and sets up
- * appropriate backtracking limits and strategies.
- */
-rift_regex_automaton_t *
-rift_regex_compile_pattern_extended(const char *pattern, rift_regex_flags_t flags,
-                                    rift_backtrack_limit_registry_t *limit_registry,
-                                    uint32_t pattern_id, rift_regex_error_t *error)
-{
-    if (!pattern) {
-        if (error) {
-            error->code = RIFT_REGEX_ERROR_INVALID_PARAMETER;
-            strncpy(error->message, "Invalid pattern parameter",
-                    RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH - 1);
-        }
-        return NULL;
-    }
-
-    // Detect R'' syntax
-    bool is_r_syntax = rift_regex_is_rift_syntax(pattern);
-
-    // If using R'' syntax, ensure the RIFT_SYNTAX flag is set
-    if (is_r_syntax) {
-        flags |= RIFT_REGEX_FLAG_RIFT_SYNTAX;
-    }
-
-    // Parse the pattern into an AST
-    rift_regex_ast_t *ast = rift_regex_parse(pattern, flags, error);
-    if (!ast) {
-        return NULL;
-    }
-
-    // Compile the AST into an automaton
-    rift_regex_automaton_t *automaton = rift_regex_compile_ast(ast, flags, error);
-
-    // Free the AST (no longer needed after compilation)
-    rift_regex_ast_free(ast);
-
-    if (!automaton) {
-        return NULL;
-    }
-
-    // If using R'' syntax and limit registry is provided, register pattern-specific limits
-    if (is_r_syntax && limit_registry) {
-        // Calculate pattern complexity
-        float complexity = rift_bailout_calculate_pattern_complexity(
-            rift_regex_pattern_create_from_automaton(automaton, flags), true);
-
-        // Create appropriate limits based on complexity
-        rift_backtrack_limit_config_t *r_syntax_config = NULL;
-
-        if (complexity > 5.0f) {
-            // Stricter limits for highly complex patterns
-            r_syntax_config =
-                rift_backtrack_limit_config_create_pattern(pattern_id,
-                                                           true, // Override global settings
-                                                           800,  // Reduced depth limit
-                                                           3000, // Reduced time limit (3 seconds)
-                                                           50000 // Reduced transitions
-                );
-        } else if (complexity > 2.0f) {
-            // Moderate limits for medium complexity
-            r_syntax_config =
-                rift_backtrack_limit_config_create_pattern(pattern_id,
-                                                           true, // Override global settings
-                                                           1200, // Slightly reduced depth
-                                                           4000, // 4 seconds
-                                                           75000 // Moderately reduced transitions
-                );
-        } else {
-            // Default limits for simple patterns
-            r_syntax_config = rift_backtrack_limit_config_create_pattern(
-                pattern_id,
-                false,  // Use global settings
-                0, 0, 0 // These values are ignored when not overriding
-            );
-        }
-
-        // Register the configuration
-        if (r_syntax_config) {
-            rift_backtrack_limit_registry_register_pattern(limit_registry, pattern_id,
-                                                           r_syntax_config);
-
-            // Free the local copy
-            rift_backtrack_limit_config_free(r_syntax_config);
-        }
-    }
-
-    return automaton;
-}
@@ -10,11 +10,134 @@
  */
 
 #include "core/tokenizer/token.h"
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include "librift/parser/token.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+
+/* Interned values of one-character tokens, one NUL-terminated string per byte */
+#define TOKEN_CHAR_VALUE(c) {(char)(c), '\0'}
+#define TOKEN_CHAR_VALUES_4(c)                                                                     \
+    TOKEN_CHAR_VALUE(c), TOKEN_CHAR_VALUE((c) + 1), TOKEN_CHAR_VALUE((c) + 2),                     \
+        TOKEN_CHAR_VALUE((c) + 3)
+#define TOKEN_CHAR_VALUES_16(c)                                                                    \
+    TOKEN_CHAR_VALUES_4(c), TOKEN_CHAR_VALUES_4((c) + 4), TOKEN_CHAR_VALUES_4((c) + 8),            \
+        TOKEN_CHAR_VALUES_4((c) + 12)
+#define TOKEN_CHAR_VALUES_64(c)                                                                    \
+    TOKEN_CHAR_VALUES_16(c), TOKEN_CHAR_VALUES_16((c) + 16), TOKEN_CHAR_VALUES_16((c) + 32),       \
+        TOKEN_CHAR_VALUES_16((c) + 48)
+
+static const char token_char_values[256][2] = {TOKEN_CHAR_VALUES_64(0), TOKEN_CHAR_VALUES_64(64),
+                                               TOKEN_CHAR_VALUES_64(128),
+                                               TOKEN_CHAR_VALUES_64(192)};
 
+/**
+ * @brief Get the interned value of a one-character token
+ *
+ * @param c The character
+ * @return The NUL-terminated string holding c
+ */
+const char *
+rift_regex_token_intern_char(char c)
+{
+    return token_char_values[(unsigned char)c];
+}
+
+/**
+ * @brief Check if a token value is interned
+ *
+ * @param value The value (can be NULL)
+ * @return true if the value comes from rift_regex_token_intern_char, false otherwise
+ */
+bool
+rift_regex_token_value_is_interned(const char *value)
+{
+    uintptr_t address = (uintptr_t)value;
+    uintptr_t first = (uintptr_t)token_char_values;
+    return address >= first && address < first + sizeof(token_char_values);
+}
+
+/* Token type each byte starts; bytes left out are plain literals */
+static const unsigned char token_byte_types[256] = {
+    ['.'] = RIFT_REGEX_TOKEN_DOT,         ['^'] = RIFT_REGEX_TOKEN_CARET,
+    ['$'] = RIFT_REGEX_TOKEN_DOLLAR,      ['*'] = RIFT_REGEX_TOKEN_STAR,
+    ['+'] = RIFT_REGEX_TOKEN_PLUS,        ['?'] = RIFT_REGEX_TOKEN_QUESTION,
+    ['('] = RIFT_REGEX_TOKEN_LPAREN,      [')'] = RIFT_REGEX_TOKEN_RPAREN,
+    ['['] = RIFT_REGEX_TOKEN_LBRACKET,    [']'] = RIFT_REGEX_TOKEN_RBRACKET,
+    ['{'] = RIFT_REGEX_TOKEN_LBRACE,      ['}'] = RIFT_REGEX_TOKEN_RBRACE,
+    ['|'] = RIFT_REGEX_TOKEN_PIPE,        [','] = RIFT_REGEX_TOKEN_COMMA,
+    ['\\'] = RIFT_REGEX_TOKEN_BACKSLASH,
+};
+
+#ifdef __SSE2__
+/* Bytes of token_byte_types that are not plain literals */
+static const char token_special_bytes[] = ".^$*+?()[]{}|,\\";
+#endif
+
+/**
+ * @brief Get the type of the token a byte starts
+ *
+ * @param c The byte
+ * @return The token type
+ */
+rift_regex_token_type_t
+rift_regex_token_byte_type(char c)
+{
+    return (rift_regex_token_type_t)token_byte_types[(unsigned char)c];
+}
+
+/**
+ * @brief Get the length of the run of plain literal bytes at the start of the input
+ *
+ * With SSE2, blocks of 16 bytes without a special byte are skipped at once;
+ * the table finds the end of the run in the block that has one.
+ *
+ * @param input The input
+ * @param length Length of the input
+ * @return Length of the run, 0 if the input does not start with a plain literal
+ */
+size_t
+rift_regex_token_literal_run(const char *input, size_t length)
+{
+    if (!input) {
+        return 0;
+    }
+
+    size_t run = 0;
+
+#ifdef __SSE2__
+    while (run + 16 <= length) {
+        __m128i block = _mm_loadu_si128((const __m128i *)(input + run));
+        __m128i special = _mm_setzero_si128();
+        for (size_t i = 0; i < sizeof(token_special_bytes) - 1; i++) {
+            __m128i byte = _mm_set1_epi8(token_special_bytes[i]);
+            special = _mm_or_si128(special, _mm_cmpeq_epi8(block, byte));
+        }
+        if (_mm_movemask_epi8(special) != 0) {
+            break;
+        }
+        run += 16;
+    }
+#endif
+
+    while (run < length &&
+           token_byte_types[(unsigned char)input[run]] == RIFT_REGEX_TOKEN_LITERAL) {
+        run++;
+    }
+
+    // A quantifier after the run applies to its last byte only
+    if (run > 0 && run < length &&
+        rift_regex_token_type_is_quantifier(rift_regex_token_byte_type(input[run]))) {
+        run--;
+    }
+
+    return run;
+}
 
 /**
  * @brief Create a new token
@@ -30,8 +153,12 @@ rift_regex_token_create(rift_regex_token_type_t type, const char *value, size_t
     rift_regex_token_t token;
     token.type = type;
     token.position = position;
+    token.start = position;
+    token.end = position;
 
-    if (value) {
+    if (rift_regex_token_value_is_interned(value)) {
+        token.value = (char *)value;
+    } else if (value) {
         token.value = strdup(value);
         if (!token.value && type != RIFT_REGEX_TOKEN_ERROR) {
             // Set as error token if memory allocation fails
@@ -59,6 +186,8 @@ rift_regex_token_create_simple(rift_regex_token_type_t type, size_t position)
     token.type = type;
     token.value = NULL;
     token.position = position;
+    token.start = position;
+    token.end = position;
 
     return token;
 }
@@ -101,7 +230,11 @@ rift_regex_token_copy(const rift_regex_token_t *token)
         return rift_regex_token_create_error("NULL token", 0);
     }
 
-    return rift_regex_token_create(token->type, token->value, token->position);
+    // Interned values are shared, everything else is copied
+    rift_regex_token_t copy = rift_regex_token_create(token->type, token->value, token->position);
+    copy.start = token->start;
+    copy.end = token->end;
+    return copy;
 }
 
 /**
@@ -116,10 +249,10 @@ rift_regex_token_free(rift_regex_token_t *token)
         return;
     }
 
-    if (token->value) {
+    if (token->value && !rift_regex_token_value_is_interned(token->value)) {
         free(token->value);
-        token->value = NULL;
     }
+    token->value = NULL;
 
     // Note: We don't free the token itself as it may be stack-allocated
 }
@@ -136,10 +269,10 @@ rift_regex_token_free_value(rift_regex_token_t *token)
         return;
     }
 
-    if (token->value) {
+    if (token->value && !rift_regex_token_value_is_interned(token->value)) {
         free(token->value);
-        token->value = NULL;
     }
+    token->value = NULL;
 }
 
 /**
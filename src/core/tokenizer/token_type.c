@@ -20,6 +20,7 @@
  */
 static const char *token_type_strings[] = {
     [RIFT_REGEX_TOKEN_LITERAL] = "LITERAL",
+    [RIFT_REGEX_TOKEN_LITERAL_RUN] = "LITERAL_RUN",
     [RIFT_REGEX_TOKEN_DOT] = "DOT",
     [RIFT_REGEX_TOKEN_CARET] = "CARET",
     [RIFT_REGEX_TOKEN_DOLLAR] = "DOLLAR",
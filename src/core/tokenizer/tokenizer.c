@@ -13,6 +13,8 @@
 #include <ctype.h>
 #include <stdlib.h>
 #include <string.h>
+#include "core/memory/memory.h"
+#include "core/tokenizer/token.h"
 #include "librift/parser/tokenizer.h"
 
 
@@ -28,8 +30,36 @@ struct rift_regex_tokenizer {
     char last_error[RIFT_REGEX_MAX_ERROR_LENGTH]; /**< Last error message */
     rift_regex_token_t current_token;             /**< Current token */
     bool has_current_token;                       /**< Whether current_token is valid */
+    rift_arena_t *arena;                          /**< Arena for token values, NULL for heap */
+    char *values; /**< Copy of the input the values of longer tokens point into */
 };
 
+/**
+ * @brief Get the value of a token longer than one character
+ *
+ * The value is the token's text in the tokenizer's copy of the input,
+ * terminated in place. The byte overwritten is the closing delimiter of the
+ * same token, the first byte of the token after a literal run, or the end of
+ * the input. Values never start at the first byte of a token, so no other
+ * value covers it. Span tokenizers keep no copy and give such tokens no
+ * value.
+ *
+ * @param tokenizer The tokenizer
+ * @param start Offset of the value in the input
+ * @param length Length of the value
+ * @return The NUL-terminated value
+ */
+static char *
+token_value_slice(rift_regex_tokenizer_t *tokenizer, size_t start, size_t length)
+{
+    if (!tokenizer->values) {
+        return NULL;
+    }
+
+    tokenizer->values[start + length] = '\0';
+    return tokenizer->values + start;
+}
+
 /**
  * @brief Create a new tokenizer for the given input string
  *
@@ -38,13 +68,26 @@ struct rift_regex_tokenizer {
  */
 rift_regex_tokenizer_t *
 rift_regex_tokenizer_create(const char *input)
+{
+    return rift_regex_tokenizer_create_in_arena(input, NULL);
+}
+
+/**
+ * @brief Create a new tokenizer whose token values live in an arena
+ *
+ * @param input The input string to tokenize
+ * @param arena Arena for the token values, NULL to allocate them on the heap
+ * @return A new tokenizer or NULL on failure
+ */
+rift_regex_tokenizer_t *
+rift_regex_tokenizer_create_in_arena(const char *input, rift_arena_t *arena)
 {
     if (!input) {
         return NULL;
     }
 
-    rift_regex_tokenizer_t *tokenizer =
-        (rift_regex_tokenizer_t *)malloc(sizeof(rift_regex_tokenizer_t));
+    rift_regex_tokenizer_t *tokenizer = (rift_regex_tokenizer_t *)rift_malloc_tagged(
+        sizeof(rift_regex_tokenizer_t), RIFT_MEMORY_TAG_TOKENIZER);
     if (!tokenizer) {
         return NULL;
     }
@@ -54,11 +97,67 @@ rift_regex_tokenizer_create(const char *input)
     tokenizer->position = 0;
     tokenizer->last_error[0] = '\0';
     tokenizer->has_current_token = false;
+    tokenizer->arena = arena;
+
+    // One copy of the input for all token values instead of one allocation per token
+    if (arena) {
+        tokenizer->values = rift_arena_strndup(arena, input, tokenizer->input_length);
+    } else {
+        tokenizer->values =
+            (char *)rift_malloc_tagged(tokenizer->input_length + 1, RIFT_MEMORY_TAG_TOKENIZER);
+        if (tokenizer->values) {
+            memcpy(tokenizer->values, input, tokenizer->input_length);
+            tokenizer->values[tokenizer->input_length] = '\0';
+        }
+    }
+    if (!tokenizer->values) {
+        rift_free(tokenizer);
+        return NULL;
+    }
 
     // Initialize the current token
     tokenizer->current_token.type = RIFT_REGEX_TOKEN_END;
     tokenizer->current_token.value = NULL;
     tokenizer->current_token.position = 0;
+    tokenizer->current_token.start = 0;
+    tokenizer->current_token.end = 0;
+
+    return tokenizer;
+}
+
+/**
+ * @brief Create a tokenizer that reports token spans without values
+ *
+ * @param input The input to tokenize, which must outlive the tokenizer
+ * @param length The length of the input
+ * @return A new tokenizer or NULL on failure
+ */
+rift_regex_tokenizer_t *
+rift_regex_tokenizer_create_spans(const char *input, size_t length)
+{
+    if (!input && length > 0) {
+        return NULL;
+    }
+
+    rift_regex_tokenizer_t *tokenizer = (rift_regex_tokenizer_t *)rift_malloc_tagged(
+        sizeof(rift_regex_tokenizer_t), RIFT_MEMORY_TAG_TOKENIZER);
+    if (!tokenizer) {
+        return NULL;
+    }
+
+    tokenizer->input = input ? input : "";
+    tokenizer->input_length = length;
+    tokenizer->position = 0;
+    tokenizer->last_error[0] = '\0';
+    tokenizer->has_current_token = false;
+    tokenizer->arena = NULL;
+    tokenizer->values = NULL;
+
+    tokenizer->current_token.type = RIFT_REGEX_TOKEN_END;
+    tokenizer->current_token.value = NULL;
+    tokenizer->current_token.position = 0;
+    tokenizer->current_token.start = 0;
+    tokenizer->current_token.end = 0;
 
     return tokenizer;
 }
@@ -75,12 +174,12 @@ rift_regex_tokenizer_free(rift_regex_tokenizer_t *tokenizer)
         return;
     }
 
-    // Free the current token value if allocated
-    if (tokenizer->current_token.value) {
-        free(tokenizer->current_token.value);
+    // Arena values are left to the arena
+    if (!tokenizer->arena) {
+        rift_free(tokenizer->values);
     }
 
-    free(tokenizer);
+    rift_free(tokenizer);
 }
 
 /**
@@ -193,15 +292,7 @@ scan_character_class(rift_regex_tokenizer_t *tokenizer)
 
     // Extract the character class content
     size_t length = tokenizer->position - start_pos - 1; // Exclude the closing bracket
-    token.value = (char *)malloc(length + 1);
-    if (!token.value) {
-        snprintf(tokenizer->last_error, RIFT_REGEX_MAX_ERROR_LENGTH, "Memory allocation failed");
-        token.type = RIFT_REGEX_TOKEN_ERROR;
-        return token;
-    }
-
-    strncpy(token.value, tokenizer->input + start_pos, length);
-    token.value[length] = '\0';
+    token.value = token_value_slice(tokenizer, start_pos, length);
 
     return token;
 }
@@ -228,15 +319,7 @@ scan_escape_sequence(rift_regex_tokenizer_t *tokenizer)
     }
 
     char c = advance(tokenizer);
-    token.value = (char *)malloc(2);
-    if (!token.value) {
-        snprintf(tokenizer->last_error, RIFT_REGEX_MAX_ERROR_LENGTH, "Memory allocation failed");
-        token.type = RIFT_REGEX_TOKEN_ERROR;
-        return token;
-    }
-
-    token.value[0] = c;
-    token.value[1] = '\0';
+    token.value = (char *)rift_regex_token_intern_char(c);
 
     // Determine token type based on the escaped character
     switch (c) {
@@ -351,7 +434,7 @@ scan_group_specifier(rift_regex_tokenizer_t *tokenizer)
 
             // Extract the group name until '>'
             size_t start_pos = tokenizer->position - 1; // Include the first name character
-            size_t name_length = 0;
+            size_t name_length = 1;                     // Start with 1 for the first character
 
             while (!rift_regex_tokenizer_is_at_end(tokenizer)) {
                 c = advance(tokenizer);
@@ -370,16 +453,7 @@ scan_group_specifier(rift_regex_tokenizer_t *tokenizer)
                 return token;
             }
 
-            token.value = (char *)malloc(name_length + 1);
-            if (!token.value) {
-                snprintf(tokenizer->last_error, RIFT_REGEX_MAX_ERROR_LENGTH,
-                         "Memory allocation failed");
-                token.type = RIFT_REGEX_TOKEN_ERROR;
-                return token;
-            }
-
-            strncpy(token.value, tokenizer->input + start_pos, name_length);
-            token.value[name_length] = '\0';
+            token.value = token_value_slice(tokenizer, start_pos, name_length);
 
             return token;
         }
@@ -412,16 +486,7 @@ scan_group_specifier(rift_regex_tokenizer_t *tokenizer)
             return token;
         }
 
-        token.value = (char *)malloc(comment_length + 1);
-        if (!token.value) {
-            snprintf(tokenizer->last_error, RIFT_REGEX_MAX_ERROR_LENGTH,
-                     "Memory allocation failed");
-            token.type = RIFT_REGEX_TOKEN_ERROR;
-            return token;
-        }
-
-        strncpy(token.value, tokenizer->input + start_pos, comment_length);
-        token.value[comment_length] = '\0';
+        token.value = token_value_slice(tokenizer, start_pos, comment_length);
 
         return token;
     default:
@@ -451,16 +516,7 @@ scan_group_specifier(rift_regex_tokenizer_t *tokenizer)
                 }
             }
 
-            token.value = (char *)malloc(option_length + 1);
-            if (!token.value) {
-                snprintf(tokenizer->last_error, RIFT_REGEX_MAX_ERROR_LENGTH,
-                         "Memory allocation failed");
-                token.type = RIFT_REGEX_TOKEN_ERROR;
-                return token;
-            }
-
-            strncpy(token.value, tokenizer->input + start_pos, option_length);
-            token.value[option_length] = '\0';
+            token.value = token_value_slice(tokenizer, start_pos, option_length);
 
             return token;
         } else {
@@ -490,75 +546,47 @@ scan_token(rift_regex_tokenizer_t *tokenizer)
         return token;
     }
 
-    char c = advance(tokenizer);
     rift_regex_token_t token;
-    token.position = tokenizer->position - 1;
+    token.position = tokenizer->position;
     token.value = NULL;
 
-    switch (c) {
-    case '.':
-        token.type = RIFT_REGEX_TOKEN_DOT;
-        break;
-    case '^':
-        token.type = RIFT_REGEX_TOKEN_CARET;
-        break;
-    case '$':
-        token.type = RIFT_REGEX_TOKEN_DOLLAR;
-        break;
-    case '*':
-        token.type = RIFT_REGEX_TOKEN_STAR;
-        break;
-    case '+':
-        token.type = RIFT_REGEX_TOKEN_PLUS;
-        break;
-    case '?':
-        token.type = RIFT_REGEX_TOKEN_QUESTION;
-        break;
-    case '(':
+    // Runs of plain literals become one token
+    char c = tokenizer->input[tokenizer->position];
+    rift_regex_token_type_t type = rift_regex_token_byte_type(c);
+    if (type == RIFT_REGEX_TOKEN_LITERAL) {
+        size_t run = rift_regex_token_literal_run(tokenizer->input + tokenizer->position,
+                                                  tokenizer->input_length - tokenizer->position);
+        if (run > 1) {
+            token.type = RIFT_REGEX_TOKEN_LITERAL_RUN;
+            token.value = token_value_slice(tokenizer, tokenizer->position, run);
+            tokenizer->position += run;
+            return token;
+        }
+    }
+
+    advance(tokenizer);
+
+    switch (type) {
+    case RIFT_REGEX_TOKEN_LPAREN:
         // Check for group specifier
         if (!rift_regex_tokenizer_is_at_end(tokenizer) &&
             rift_regex_tokenizer_get_current_char(tokenizer) == '?') {
             advance(tokenizer); // Consume the '?'
             return scan_group_specifier(tokenizer);
         }
-        token.type = RIFT_REGEX_TOKEN_LPAREN;
-        break;
-    case ')':
-        token.type = RIFT_REGEX_TOKEN_RPAREN;
         break;
-    case '[':
+    case RIFT_REGEX_TOKEN_LBRACKET:
         return scan_character_class(tokenizer);
-    case ']':
-        token.type = RIFT_REGEX_TOKEN_RBRACKET;
-        break;
-    case '{':
-        token.type = RIFT_REGEX_TOKEN_LBRACE;
-        break;
-    case '}':
-        token.type = RIFT_REGEX_TOKEN_RBRACE;
-        break;
-    case '|':
-        token.type = RIFT_REGEX_TOKEN_PIPE;
-        break;
-    case ',':
-        token.type = RIFT_REGEX_TOKEN_COMMA;
-        break;
-    case '\\':
+    case RIFT_REGEX_TOKEN_BACKSLASH:
         return scan_escape_sequence(tokenizer);
+    case RIFT_REGEX_TOKEN_LITERAL:
+        token.value = (char *)rift_regex_token_intern_char(c);
+        break;
     default:
-        // Literal character
-        token.type = RIFT_REGEX_TOKEN_LITERAL;
-        token.value = (char *)malloc(2);
-        if (!token.value) {
-            snprintf(tokenizer->last_error, RIFT_REGEX_MAX_ERROR_LENGTH,
-                     "Memory allocation failed");
-            token.type = RIFT_REGEX_TOKEN_ERROR;
-            return token;
-        }
-        token.value[0] = c;
-        token.value[1] = '\0';
+        break;
     }
 
+    token.type = type;
     return token;
 }
 
@@ -579,14 +607,11 @@ rift_regex_tokenizer_next_token(rift_regex_tokenizer_t *tokenizer)
         return token;
     }
 
-    // Free the current token value if allocated
-    if (tokenizer->has_current_token && tokenizer->current_token.value) {
-        free(tokenizer->current_token.value);
-        tokenizer->current_token.value = NULL;
-    }
-
-    // Scan the next token
+    // Scan the next token; values live in the tokenizer, so there is nothing to free
+    size_t start = tokenizer->position;
     tokenizer->current_token = scan_token(tokenizer);
+    tokenizer->current_token.start = start;
+    tokenizer->current_token.end = tokenizer->position;
     tokenizer->has_current_token = true;
 
     return tokenizer->current_token;
@@ -617,16 +642,12 @@ rift_regex_tokenizer_peek_token(rift_regex_tokenizer_t *tokenizer)
     // Otherwise, scan the next token and save it
     size_t saved_position = tokenizer->position;
     rift_regex_token_t token = scan_token(tokenizer);
+    token.start = saved_position;
+    token.end = tokenizer->position;
 
-    // Restore the position
+    // Restore the position; scanning the token again terminates its value the same way
     tokenizer->position = saved_position;
 
-    // Since we're not storing this token, free any allocated value
-    if (token.value) {
-        free(token.value);
-        token.value = NULL;
-    }
-
     return token;
 }
 
@@ -676,34 +697,10 @@ rift_regex_tokenizer_reset(rift_regex_tokenizer_t *tokenizer)
 
     tokenizer->position = 0;
     tokenizer->last_error[0] = '\0';
-
-    // Free the current token value if allocated
-    if (tokenizer->has_current_token && tokenizer->current_token.value) {
-        free(tokenizer->current_token.value);
-        tokenizer->current_token.value = NULL;
-    }
-
+    tokenizer->current_token.value = NULL;
     tokenizer->has_current_token = false;
 }
 
-/**
- * @brief Free resources associated with a token
- *
- * @param token The token to free
- */
-void
-rift_regex_token_free(rift_regex_token_t *token)
-{
-    if (!token) {
-        return;
-    }
-
-    if (token->value) {
-        free(token->value);
-        token->value = NULL;
-    }
-}
-
 /**
  * @brief Get the name of a token type
  *
@@ -716,6 +713,8 @@ rift_regex_token_type_name(rift_regex_token_type_t type)
     switch (type) {
     case RIFT_REGEX_TOKEN_LITERAL:
         return "LITERAL";
+    case RIFT_REGEX_TOKEN_LITERAL_RUN:
+        return "LITERAL_RUN";
     case RIFT_REGEX_TOKEN_DOT:
         return "DOT";
     case RIFT_REGEX_TOKEN_CARET:
@@ -0,0 +1,213 @@
+/**
+ * @file handle_table.c
+ * @brief Implementation of generational handle tables
+ *
+ * Slots grow by doubling and are never moved out of index order, so a
+ * handle's index stays valid across growth. Free slots form a stack through
+ * their next_free fields; generations skip 0 so that no handle equals
+ * RIFT_HANDLE_INVALID.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/webbridge/handle_table.h"
+#include <stdlib.h>
+
+/**
+ * @brief Slots allocated when no initial capacity is given
+ */
+#define HANDLE_DEFAULT_CAPACITY 64
+
+/**
+ * @brief Mask of the slot index in a handle
+ */
+#define HANDLE_INDEX_MASK (RIFT_HANDLE_MAX_SLOTS - 1)
+
+/**
+ * @brief Largest generation a handle can hold
+ */
+#define HANDLE_MAX_GENERATION (UINT32_MAX >> RIFT_HANDLE_INDEX_BITS)
+
+/**
+ * @brief End of the free slot chain
+ */
+#define HANDLE_NO_SLOT UINT32_MAX
+
+/**
+ * @brief One slot of a handle table
+ */
+typedef struct {
+    void *object;        /**< Stored object, NULL when free */
+    uint32_t generation; /**< Generation of the handles to this slot, never 0 */
+    uint32_t next_free;  /**< Next free slot while free */
+} handle_slot_t;
+
+struct rift_handle_table {
+    handle_slot_t *slots; /**< Slots in index order */
+    uint32_t capacity;    /**< Number of slots allocated */
+    uint32_t used;        /**< Slots handed out at least once */
+    uint32_t free_head;   /**< First free slot below used, HANDLE_NO_SLOT if none */
+    size_t count;         /**< Number of stored objects */
+};
+
+/**
+ * @brief Find the slot of a live handle
+ *
+ * @param table The table
+ * @param handle The handle
+ * @return The slot or NULL if the handle is invalid or stale
+ */
+static handle_slot_t *
+handle_slot(const rift_handle_table_t *table, uint32_t handle)
+{
+    if (!table || handle == RIFT_HANDLE_INVALID) {
+        return NULL;
+    }
+
+    uint32_t index = handle & HANDLE_INDEX_MASK;
+    if (index >= table->used) {
+        return NULL;
+    }
+
+    handle_slot_t *slot = &table->slots[index];
+    if (!slot->object || slot->generation != handle >> RIFT_HANDLE_INDEX_BITS) {
+        return NULL;
+    }
+    return slot;
+}
+
+/**
+ * @brief Free a slot, making its handles stale
+ *
+ * @param table The table
+ * @param index Index of the slot
+ */
+static void
+handle_release(rift_handle_table_t *table, uint32_t index)
+{
+    handle_slot_t *slot = &table->slots[index];
+    slot->object = NULL;
+    slot->generation = slot->generation == HANDLE_MAX_GENERATION ? 1 : slot->generation + 1;
+    slot->next_free = table->free_head;
+    table->free_head = index;
+    table->count--;
+}
+
+rift_handle_table_t *
+rift_handle_table_create(uint32_t initial_capacity)
+{
+    if (initial_capacity == 0) {
+        initial_capacity = HANDLE_DEFAULT_CAPACITY;
+    }
+    if (initial_capacity > RIFT_HANDLE_MAX_SLOTS) {
+        initial_capacity = RIFT_HANDLE_MAX_SLOTS;
+    }
+
+    rift_handle_table_t *table = (rift_handle_table_t *)calloc(1, sizeof(rift_handle_table_t));
+    if (!table) {
+        return NULL;
+    }
+
+    table->slots = (handle_slot_t *)malloc(initial_capacity * sizeof(handle_slot_t));
+    if (!table->slots) {
+        free(table);
+        return NULL;
+    }
+    table->capacity = initial_capacity;
+    table->free_head = HANDLE_NO_SLOT;
+    return table;
+}
+
+void
+rift_handle_table_free(rift_handle_table_t *table)
+{
+    if (!table) {
+        return;
+    }
+
+    free(table->slots);
+    free(table);
+}
+
+uint32_t
+rift_handle_table_insert(rift_handle_table_t *table, void *object)
+{
+    if (!table || !object) {
+        return RIFT_HANDLE_INVALID;
+    }
+
+    uint32_t index = table->free_head;
+    if (index != HANDLE_NO_SLOT) {
+        table->free_head = table->slots[index].next_free;
+    } else {
+        if (table->used == RIFT_HANDLE_MAX_SLOTS) {
+            return RIFT_HANDLE_INVALID;
+        }
+        if (table->used == table->capacity) {
+            uint32_t capacity = table->capacity > RIFT_HANDLE_MAX_SLOTS / 2
+                                    ? RIFT_HANDLE_MAX_SLOTS
+                                    : table->capacity * 2;
+            handle_slot_t *slots =
+                (handle_slot_t *)realloc(table->slots, capacity * sizeof(handle_slot_t));
+            if (!slots) {
+                return RIFT_HANDLE_INVALID;
+            }
+            table->slots = slots;
+            table->capacity = capacity;
+        }
+        index = table->used++;
+        table->slots[index].generation = 1;
+    }
+
+    handle_slot_t *slot = &table->slots[index];
+    slot->object = object;
+    slot->next_free = HANDLE_NO_SLOT;
+    table->count++;
+    return (slot->generation << RIFT_HANDLE_INDEX_BITS) | index;
+}
+
+void *
+rift_handle_table_get(const rift_handle_table_t *table, uint32_t handle)
+{
+    handle_slot_t *slot = handle_slot(table, handle);
+    return slot ? slot->object : NULL;
+}
+
+void *
+rift_handle_table_remove(rift_handle_table_t *table, uint32_t handle)
+{
+    handle_slot_t *slot = handle_slot(table, handle);
+    if (!slot) {
+        return NULL;
+    }
+
+    void *object = slot->object;
+    handle_release(table, (uint32_t)(slot - table->slots));
+    return object;
+}
+
+size_t
+rift_handle_table_remove_each(rift_handle_table_t *table, rift_handle_visit_fn visit,
+                              void *context)
+{
+    if (!table || !visit) {
+        return 0;
+    }
+
+    size_t removed = 0;
+    for (uint32_t index = 0; index < table->used; index++) {
+        void *object = table->slots[index].object;
+        if (object && visit(object, context)) {
+            handle_release(table, index);
+            removed++;
+        }
+    }
+    return removed;
+}
+
+size_t
+rift_handle_table_count(const rift_handle_table_t *table)
+{
+    return table ? table->count : 0;
+}
@@ -0,0 +1,1346 @@
+/**
+ * @file webbridge.c
+ * @brief Implementation of the WebAssembly bridge
+ *
+ * The objects handed out to JavaScript live in generational handle tables,
+ * so JavaScript only holds 32-bit handles. Matching runs on the span API of
+ * the matcher and writes its results as uint32_t words straight into Wasm
+ * memory, where JavaScript reads them through a typed array view. The
+ * entry points build natively too, where they are unit tested.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include "core/webbridge/webbridge.h"
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "core/bytecode/bytecode.h"
+#include "core/bytecode/bytecode_vm.h"
+#include "core/bytecode/bytecode_vm_pool.h"
+#include "core/dsl/rift_dsl_compiler.h"
+#include "core/engine/pattern.h"
+#include "core/runtime/matcher.h"
+
+/* Wasm builds only have threads when built with pthreads */
+#if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+#define WEBBRIDGE_THREADS 1
+#include <pthread.h>
+#include <unistd.h>
+#ifdef __EMSCRIPTEN__
+#include <emscripten/threading.h>
+#endif
+#else
+#define WEBBRIDGE_THREADS 0
+#endif
+
+/**
+ * @brief Words of one span in a span array: start, then end
+ */
+#define WEBBRIDGE_SPAN_WORDS 2
+
+/**
+ * @brief Streamed spans a matcher keeps room for when its stream begins
+ */
+#define WEBBRIDGE_PENDING_CAPACITY 16
+
+/**
+ * @brief Words a pool worker keeps room for when the pool is created
+ */
+#define WEBBRIDGE_WORKER_CAPACITY 256
+
+/**
+ * @brief A matcher and the state the bridge keeps for it
+ */
+typedef struct bridge_matcher {
+    rift_regex_matcher_t *matcher;        /**< The matcher */
+    rift_pattern_handle_t pattern_handle; /**< Pattern the matcher was created for */
+    rift_regex_span_t *spans;             /**< Spans of the latest match */
+    size_t num_spans;                     /**< Spans per match: the groups plus one */
+    bool has_match;                       /**< Whether spans hold the latest match */
+    bool exhausted;                       /**< Whether find_next has passed the end */
+    size_t input_length;                  /**< Length of the current input */
+    uint8_t *input_buffer;                /**< Input buffer JavaScript writes into */
+    uint32_t input_capacity;              /**< Capacity of input_buffer */
+    uint32_t *pending;                    /**< Streamed spans not written out yet */
+    size_t num_pending;                   /**< Number of spans in pending */
+    size_t pending_capacity;              /**< Capacity of pending, in spans */
+    bool streaming;                       /**< Whether a stream is in progress */
+    bool stream_fed_last;                 /**< Whether the stream's last chunk was fed */
+    bool stream_failed;                   /**< Whether a streamed span could not be kept */
+} bridge_matcher_t;
+
+#if WEBBRIDGE_THREADS
+struct bridge_pool;
+
+/**
+ * @brief One worker of a pool and the words it wrote for the current batch
+ */
+typedef struct bridge_worker {
+    struct bridge_pool *pool;      /**< The pool */
+    rift_regex_matcher_t *matcher; /**< Matcher of the worker's own */
+    uint32_t *words;               /**< Count and spans of each input it matched */
+    size_t num_words;              /**< Number of words in words */
+    size_t capacity;               /**< Capacity of words */
+} bridge_worker_t;
+
+/**
+ * @brief Where the results of one input of a batch were written
+ */
+typedef struct bridge_result {
+    const bridge_worker_t *worker; /**< Worker that matched the input */
+    size_t offset;                 /**< First word of the results in the worker's words */
+    size_t num_words;              /**< Number of words of the results */
+} bridge_result_t;
+
+/**
+ * @brief Workers matching one pattern, and the batch they share
+ */
+typedef struct bridge_pool {
+    const rift_regex_pattern_t *pattern; /**< The pattern, owned by the pattern table */
+    size_t num_spans;                    /**< Spans per match */
+    bridge_worker_t *workers;            /**< The workers */
+    pthread_t *threads;                  /**< Thread of each worker */
+    size_t num_workers;                  /**< Number of workers */
+    size_t num_started;                  /**< Workers whose thread was started */
+    pthread_mutex_t batch_lock;          /**< Held by the caller of a batch */
+    pthread_mutex_t lock;                /**< Guards the fields below */
+    pthread_cond_t work_ready;           /**< Signaled when a batch starts or the pool stops */
+    pthread_cond_t work_done;            /**< Signaled when the last worker is done */
+    uint64_t generation;                 /**< Number of batches started */
+    size_t active;                       /**< Workers still matching the current batch */
+    bool stopping;                       /**< Whether the workers must exit */
+    const char *inputs;                  /**< Input bytes of the current batch */
+    const uint32_t *offsets;             /**< Input offsets of the current batch */
+    uint32_t count;                      /**< Number of inputs of the current batch */
+    atomic_uint next_input;              /**< Next input a worker takes */
+    atomic_bool failed;                  /**< Whether a worker ran out of memory */
+    bridge_result_t *results;            /**< Results of each input */
+    size_t results_capacity;             /**< Capacity of results */
+} bridge_pool_t;
+#endif
+
+/**
+ * @brief Handle tables of the objects handed out to JavaScript
+ */
+static struct {
+    rift_handle_table_t *patterns; /**< rift_regex_pattern_t objects */
+    rift_handle_table_t *matchers; /**< bridge_matcher_t objects */
+    rift_handle_table_t *bundles;  /**< Compilations loaded from containers */
+    rift_handle_table_t *pools;    /**< bridge_pool_t objects */
+} bridge;
+
+/* Message of the last failure on this thread */
+static _Thread_local char last_error[RIFT_REGEX_ERROR_MAX_MESSAGE_LENGTH];
+
+#if WEBBRIDGE_THREADS
+/* Guards the handle tables against callers on several threads */
+static pthread_mutex_t bridge_lock = PTHREAD_MUTEX_INITIALIZER;
+#define BRIDGE_LOCK() pthread_mutex_lock(&bridge_lock)
+#define BRIDGE_UNLOCK() pthread_mutex_unlock(&bridge_lock)
+#else
+#define BRIDGE_LOCK() ((void)0)
+#define BRIDGE_UNLOCK() ((void)0)
+#endif
+
+/**
+ * @brief Record the message of a failure for rift_webbridge_get_last_error
+ *
+ * @param format printf-style format of the message
+ */
+static void
+set_error(const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    vsnprintf(last_error, sizeof(last_error), format, args);
+    va_end(args);
+}
+
+/**
+ * @brief Look up the object of a handle
+ *
+ * @param table The table
+ * @param handle The handle
+ * @param kind Kind of object, for the error message
+ * @return The object or NULL, with the error set, if the handle is invalid or stale
+ */
+static void *
+bridge_get(rift_handle_table_t *table, uint32_t handle, const char *kind)
+{
+    BRIDGE_LOCK();
+    void *object = rift_handle_table_get(table, handle);
+    BRIDGE_UNLOCK();
+    if (!object) {
+        set_error("Invalid %s handle %u", kind, handle);
+    }
+    return object;
+}
+
+/**
+ * @brief Store an object and issue its handle
+ *
+ * @param table The table
+ * @param object The object
+ * @return The handle or RIFT_HANDLE_INVALID, with the error set, on failure
+ */
+static uint32_t
+bridge_insert(rift_handle_table_t *table, void *object)
+{
+    if (!table) {
+        set_error("WebBridge is not initialized");
+        return RIFT_HANDLE_INVALID;
+    }
+    BRIDGE_LOCK();
+    uint32_t handle = rift_handle_table_insert(table, object);
+    BRIDGE_UNLOCK();
+    if (handle == RIFT_HANDLE_INVALID) {
+        set_error("Out of handles");
+    }
+    return handle;
+}
+
+/**
+ * @brief Remove the object of a handle
+ *
+ * @param table The table
+ * @param handle The handle
+ * @return The object or NULL if the handle is invalid or stale
+ */
+static void *
+bridge_remove(rift_handle_table_t *table, uint32_t handle)
+{
+    BRIDGE_LOCK();
+    void *object = rift_handle_table_remove(table, handle);
+    BRIDGE_UNLOCK();
+    return object;
+}
+
+/**
+ * @brief Write spans as words, unset spans as RIFT_WEBBRIDGE_BATCH_UNSET
+ *
+ * @param words Words to write, WEBBRIDGE_SPAN_WORDS per span
+ * @param spans The spans found
+ * @param num_spans Number of spans found
+ * @param width Number of spans to write, those past num_spans unset
+ */
+static void
+write_span_words(uint32_t *words, const rift_regex_span_t *spans, size_t num_spans, size_t width)
+{
+    for (size_t i = 0; i < width; i++) {
+        bool set = i < num_spans && spans[i].start != RIFT_REGEX_SPAN_UNSET;
+        words[WEBBRIDGE_SPAN_WORDS * i] = set ? (uint32_t)spans[i].start
+                                              : RIFT_WEBBRIDGE_BATCH_UNSET;
+        words[WEBBRIDGE_SPAN_WORDS * i + 1] = set ? (uint32_t)spans[i].end
+                                                  : RIFT_WEBBRIDGE_BATCH_UNSET;
+    }
+}
+
+/**
+ * @brief Span array a batch writes its matches into
+ */
+typedef struct span_writer {
+    uint32_t *words;    /**< The span array */
+    uint32_t max_words; /**< Number of words in the array */
+    uint32_t used;      /**< Words written, header included */
+    uint32_t count;     /**< Matches written */
+    size_t width;       /**< Spans per match */
+    bool overflow;      /**< Whether a match did not fit */
+} span_writer_t;
+
+/**
+ * @brief Write one match of rift_matcher_for_each_match to a span array
+ */
+static bool
+write_match(const rift_regex_span_t *spans, size_t num_spans, void *user_data)
+{
+    span_writer_t *writer = (span_writer_t *)user_data;
+    size_t needed = WEBBRIDGE_SPAN_WORDS * writer->width;
+    if (writer->max_words - writer->used < needed) {
+        writer->overflow = true;
+        return false;
+    }
+    write_span_words(writer->words + writer->used, spans, num_spans, writer->width);
+    writer->used += (uint32_t)needed;
+    writer->count++;
+    return true;
+}
+
+/**
+ * @brief Free a matcher and the state the bridge keeps for it
+ *
+ * @param bm The matcher (can be NULL)
+ */
+static void
+bridge_matcher_free(bridge_matcher_t *bm)
+{
+    if (!bm) {
+        return;
+    }
+    rift_matcher_free(bm->matcher);
+    free(bm->spans);
+    free(bm->input_buffer);
+    free(bm->pending);
+    free(bm);
+}
+
+/**
+ * @brief Point a matcher at a new input
+ *
+ * @param bm The matcher
+ * @param input The input
+ * @param length Length of the input
+ * @return true if successful, false otherwise
+ */
+static bool
+bridge_matcher_set_input(bridge_matcher_t *bm, const char *input, size_t length)
+{
+    bm->has_match = false;
+    bm->exhausted = false;
+    bm->input_length = length;
+    if (!rift_matcher_set_input(bm->matcher, input, length)) {
+        set_error("Failed to set the matcher input");
+        return false;
+    }
+    return true;
+}
+
+#if WEBBRIDGE_THREADS
+static void bridge_pool_free(bridge_pool_t *pool);
+#endif
+
+/**
+ * @brief Free a pattern while its table is emptied
+ */
+static bool
+free_pattern_object(void *object, void *context)
+{
+    (void)context;
+    rift_regex_pattern_free((rift_regex_pattern_t *)object);
+    return true;
+}
+
+/**
+ * @brief Free a matcher while its table is emptied
+ */
+static bool
+free_matcher_object(void *object, void *context)
+{
+    (void)context;
+    bridge_matcher_free((bridge_matcher_t *)object);
+    return true;
+}
+
+/**
+ * @brief Free a bundle while its table is emptied
+ */
+static bool
+free_bundle_object(void *object, void *context)
+{
+    (void)context;
+    rift_dsl_free_compilation(object);
+    return true;
+}
+
+#if WEBBRIDGE_THREADS
+/**
+ * @brief Free a pool while its table is emptied
+ */
+static bool
+free_pool_object(void *object, void *context)
+{
+    (void)context;
+    bridge_pool_free((bridge_pool_t *)object);
+    return true;
+}
+#endif
+
+/**
+ * @brief Free the matchers created for one pattern
+ *
+ * @param object The matcher
+ * @param context Pointer to the pattern handle
+ * @return true if the matcher was created for the pattern and freed
+ */
+static bool
+free_matcher_of_pattern(void *object, void *context)
+{
+    bridge_matcher_t *bm = (bridge_matcher_t *)object;
+    if (bm->pattern_handle != *(const rift_pattern_handle_t *)context) {
+        return false;
+    }
+    bridge_matcher_free(bm);
+    return true;
+}
+
+RIFT_EXPORT int
+rift_webbridge_init(void)
+{
+    if (bridge.patterns) {
+        return 1;
+    }
+
+    bridge.patterns = rift_handle_table_create(0);
+    bridge.matchers = rift_handle_table_create(0);
+    bridge.bundles = rift_handle_table_create(0);
+    bridge.pools = rift_handle_table_create(0);
+    if (!bridge.patterns || !bridge.matchers || !bridge.bundles || !bridge.pools) {
+        rift_webbridge_cleanup();
+        set_error("Failed to allocate the handle tables");
+        return 0;
+    }
+    last_error[0] = '\0';
+    return 1;
+}
+
+RIFT_EXPORT void
+rift_webbridge_cleanup(void)
+{
+    // Pools and matchers run patterns, so they go first
+#if WEBBRIDGE_THREADS
+    rift_handle_table_remove_each(bridge.pools, free_pool_object, NULL);
+#endif
+    rift_handle_table_remove_each(bridge.matchers, free_matcher_object, NULL);
+    rift_handle_table_remove_each(bridge.patterns, free_pattern_object, NULL);
+    rift_handle_table_remove_each(bridge.bundles, free_bundle_object, NULL);
+
+    rift_handle_table_free(bridge.pools);
+    rift_handle_table_free(bridge.matchers);
+    rift_handle_table_free(bridge.patterns);
+    rift_handle_table_free(bridge.bundles);
+    memset(&bridge, 0, sizeof(bridge));
+}
+
+RIFT_EXPORT rift_pattern_handle_t
+rift_webbridge_compile(const char *pattern, uint32_t flags)
+{
+    if (!pattern) {
+        set_error("No pattern given");
+        return RIFT_HANDLE_INVALID;
+    }
+
+    rift_regex_error_t error = {RIFT_REGEX_ERROR_NONE};
+    rift_regex_pattern_t *compiled = rift_regex_compile(pattern, (rift_regex_flags_t)flags, &error);
+    if (!compiled) {
+        const char *message = rift_regex_error_message(&error);
+        set_error("%s", message[0] ? message : "Failed to compile the pattern");
+        return RIFT_HANDLE_INVALID;
+    }
+
+    rift_pattern_handle_t handle = bridge_insert(bridge.patterns, compiled);
+    if (handle == RIFT_HANDLE_INVALID) {
+        rift_regex_pattern_free(compiled);
+    }
+    return handle;
+}
+
+RIFT_EXPORT uint32_t
+rift_webbridge_get_last_error(char *buffer, uint32_t buffer_size)
+{
+    size_t length = strlen(last_error);
+    if (buffer && buffer_size > 0) {
+        size_t copied = length < buffer_size ? length : buffer_size - 1;
+        memcpy(buffer, last_error, copied);
+        buffer[copied] = '\0';
+    }
+    return (uint32_t)length;
+}
+
+RIFT_EXPORT void
+rift_webbridge_free_pattern(rift_pattern_handle_t handle)
+{
+    rift_regex_pattern_t *pattern = (rift_regex_pattern_t *)bridge_remove(bridge.patterns, handle);
+    if (!pattern) {
+        return;
+    }
+    rift_webbridge_free_pattern_matchers(handle);
+    rift_regex_pattern_free(pattern);
+}
+
+RIFT_EXPORT rift_matcher_handle_t
+rift_webbridge_create_matcher(rift_pattern_handle_t pattern_handle, uint32_t options)
+{
+    const rift_regex_pattern_t *pattern =
+        (const rift_regex_pattern_t *)bridge_get(bridge.patterns, pattern_handle, "pattern");
+    if (!pattern) {
+        return RIFT_HANDLE_INVALID;
+    }
+
+    bridge_matcher_t *bm = (bridge_matcher_t *)calloc(1, sizeof(bridge_matcher_t));
+    if (!bm) {
+        set_error("Failed to allocate the matcher");
+        return RIFT_HANDLE_INVALID;
+    }
+    bm->pattern_handle = pattern_handle;
+    bm->num_spans = rift_regex_pattern_get_group_count(pattern) + 1;
+    bm->matcher = rift_matcher_create(pattern, (rift_matcher_option_t)options);
+    bm->spans = (rift_regex_span_t *)malloc(bm->num_spans * sizeof(rift_regex_span_t));
+    if (!bm->matcher || !bm->spans) {
+        bridge_matcher_free(bm);
+        set_error("Failed to create the matcher");
+        return RIFT_HANDLE_INVALID;
+    }
+
+    rift_matcher_handle_t handle = bridge_insert(bridge.matchers, bm);
+    if (handle == RIFT_HANDLE_INVALID) {
+        bridge_matcher_free(bm);
+    }
+    return handle;
+}
+
+/**
+ * @brief Grow the input buffer of a matcher to a capacity
+ *
+ * @param bm The matcher
+ * @param capacity Number of bytes the buffer must hold
+ * @return true if successful, false on allocation failure
+ */
+static bool
+reserve_input(bridge_matcher_t *bm, uint32_t capacity)
+{
+    if (bm->input_buffer && capacity <= bm->input_capacity) {
+        return true;
+    }
+
+    // Doubling keeps a text edited key by key from reallocating on every change
+    uint32_t new_capacity = bm->input_capacity ? bm->input_capacity : 64;
+    while (new_capacity < capacity) {
+        new_capacity = new_capacity > UINT32_MAX / 2 ? capacity : new_capacity * 2;
+    }
+    uint8_t *buffer = (uint8_t *)realloc(bm->input_buffer, new_capacity);
+    if (!buffer) {
+        set_error("Failed to allocate an input buffer of %u bytes", capacity);
+        return false;
+    }
+
+    // The matcher must not keep reading the old buffer
+    if (bm->input_buffer != buffer && bm->input_buffer) {
+        bridge_matcher_set_input(bm, (const char *)buffer, 0);
+    }
+    bm->input_buffer = buffer;
+    bm->input_capacity = new_capacity;
+    return true;
+}
+
+RIFT_EXPORT int
+rift_webbridge_set_input(rift_matcher_handle_t matcher_handle, const char *input, int32_t length)
+{
+    bridge_matcher_t *bm = (bridge_matcher_t *)bridge_get(bridge.matchers, matcher_handle,
+                                                          "matcher");
+    if (!bm || !input) {
+        return 0;
+    }
+
+    size_t input_length = length < 0 ? strlen(input) : (size_t)length;
+    if (input_length > UINT32_MAX) {
+        set_error("Input too long");
+        return 0;
+    }
+
+    // Input already written into the buffer is matched where it is
+    if ((const uint8_t *)input == bm->input_buffer) {
+        if (input_length > bm->input_capacity) {
+            set_error("Input length %zu exceeds the input buffer", input_length);
+            return 0;
+        }
+    } else {
+        if (!reserve_input(bm, (uint32_t)input_length)) {
+            return 0;
+        }
+        memcpy(bm->input_buffer, input, input_length);
+    }
+    return bridge_matcher_set_input(bm, (const char *)bm->input_buffer, input_length);
+}
+
+RIFT_EXPORT uint8_t *
+rift_webbridge_get_input_buffer(rift_matcher_handle_t matcher_handle, uint32_t capacity)
+{
+    bridge_matcher_t *bm = (bridge_matcher_t *)bridge_get(bridge.matchers, matcher_handle,
+                                                          "matcher");
+    if (!bm || !reserve_input(bm, capacity)) {
+        return NULL;
+    }
+    return bm->input_buffer;
+}
+
+RIFT_EXPORT int
+rift_webbridge_set_input_length(rift_matcher_handle_t matcher_handle, uint32_t length)
+{
+    bridge_matcher_t *bm = (bridge_matcher_t *)bridge_get(bridge.matchers, matcher_handle,
+                                                          "matcher");
+    if (!bm) {
+        return 0;
+    }
+    if (!bm->input_buffer || length > bm->input_capacity) {
+        set_error("Input length %u exceeds the input buffer", length);
+        return 0;
+    }
+    return bridge_matcher_set_input(bm, (const char *)bm->input_buffer, length);
+}
+
+RIFT_EXPORT int
+rift_webbridge_matches(rift_matcher_handle_t matcher_handle)
+{
+    bridge_matcher_t *bm = (bridge_matcher_t *)bridge_get(bridge.matchers, matcher_handle,
+                                                          "matcher");
+    if (!bm) {
+        return 0;
+    }
+    bm->has_match = false;
+    return rift_matcher_matches(bm->matcher, NULL) ? 1 : 0;
+}
+
+RIFT_EXPORT int
+rift_webbridge_find_next(rift_matcher_handle_t matcher_handle, uint32_t *start_pos,
+                         uint32_t *end_pos)
+{
+    bridge_matcher_t *bm = (bridge_matcher_t *)bridge_get(bridge.matchers, matcher_handle,
+                                                          "matcher");
+    if (!bm) {
+        return 0;
+    }
+
+    size_t num_spans = 0;
+    bm->has_match = false;
+    if (bm->exhausted ||
+        !rift_matcher_find_next_spans(bm->matcher, bm->spans, bm->num_spans, &num_spans)) {
+        return 0;
+    }
+    for (size_t i = num_spans; i < bm->num_spans; i++) {
+        bm->spans[i].start = RIFT_REGEX_SPAN_UNSET;
+        bm->spans[i].end = RIFT_REGEX_SPAN_UNSET;
+    }
+    bm->has_match = true;
+
+    // Continue after the match, advancing at least one byte past an empty one
+    size_t position = rift_matcher_get_position(bm->matcher);
+    size_t next_pos = bm->spans[0].end > position ? bm->spans[0].end : position + 1;
+    if (next_pos > bm->input_length) {
+        bm->exhausted = true;
+    } else {
+        rift_matcher_set_position(bm->matcher, next_pos);
+    }
+
+    if (start_pos) {
+        *start_pos = (uint32_t)bm->spans[0].start;
+    }
+    if (end_pos) {
+        *end_pos = (uint32_t)bm->spans[0].end;
+    }
+    return 1;
+}
+
+RIFT_EXPORT int
+rift_webbridge_get_group(rift_matcher_handle_t matcher_handle, uint32_t group_index,
+                         uint32_t *start_pos, uint32_t *end_pos)
+{
+    bridge_matcher_t *bm = (bridge_matcher_t *)bridge_get(bridge.matchers, matcher_handle,
+                                                          "matcher");
+    if (!bm || !bm->has_match || group_index >= bm->num_spans ||
+        bm->spans[group_index].start == RIFT_REGEX_SPAN_UNSET) {
+        return 0;
+    }
+    if (start_pos) {
+        *start_pos = (uint32_t)bm->spans[group_index].start;
+    }
+    if (end_pos) {
+        *end_pos = (uint32_t)bm->spans[group_index].end;
+    }
+    return 1;
+}
+
+RIFT_EXPORT int
+rift_webbridge_get_named_group(rift_matcher_handle_t matcher_handle, const char *name,
+                               uint32_t *start_pos, uint32_t *end_pos)
+{
+    bridge_matcher_t *bm = (bridge_matcher_t *)bridge_get(bridge.matchers, matcher_handle,
+                                                          "matcher");
+    if (!bm || !name) {
+        return 0;
+    }
+    size_t index = rift_regex_pattern_group_index(rift_matcher_get_pattern(bm->matcher), name);
+    if (index == RIFT_GROUP_NO_INDEX || index > UINT32_MAX) {
+        return 0;
+    }
+    return rift_webbridge_get_group(matcher_handle, (uint32_t)index, start_pos, end_pos);
+}
+
+RIFT_EXPORT uint32_t
+rift_webbridge_find_all_batch(rift_matcher_handle_t matcher_handle, const char *input,
+                              int32_t length, uint32_t *spans, uint32_t max_words)
+{
+    bridge_matcher_t *bm = (bridge_matcher_t *)bridge_get(bridge.matchers, matcher_handle,
+                                                          "matcher");
+    if (!bm || !input) {
+        return 0;
+    }
+    if (!spans || max_words < RIFT_WEBBRIDGE_BATCH_HEADER_WORDS) {
+        set_error("Span array too small for its header");
+        return 0;
+    }
+
+    size_t input_length = length < 0 ? strlen(input) : (size_t)length;
+    if (!bridge_matcher_set_input(bm, input, input_length)) {
+        return 0;
+    }
+
+    span_writer_t writer = {spans, max_words, RIFT_WEBBRIDGE_BATCH_HEADER_WORDS, 0, bm->num_spans,
+                            false};
+    bool searched = rift_matcher_for_each_match(bm->matcher, write_match, &writer);
+    spans[0] = (uint32_t)bm->num_spans;
+    spans[1] = writer.overflow ? 1 : 0;
+    if (!searched) {
+        set_error("Failed to search the input");
+        return 0;
+    }
+    return writer.count;
+}
+
+/**
+ * @brief Keep a streamed match until a span array has room for it
+ */
+static bool
+keep_streamed_match(const rift_regex_span_t *spans, size_t num_spans, void *user_data)
+{
+    bridge_matcher_t *bm = (bridge_matcher_t *)user_data;
+    if (bm->num_pending == bm->pending_capacity) {
+        size_t capacity = bm->pending_capacity ? bm->pending_capacity * 2
+                                               : WEBBRIDGE_PENDING_CAPACITY;
+        uint32_t *pending = (uint32_t *)realloc(bm->pending,
+                                                capacity * WEBBRIDGE_SPAN_WORDS * sizeof(uint32_t));
+        if (!pending) {
+            bm->stream_failed = true;
+            return false;
+        }
+        bm->pending = pending;
+        bm->pending_capacity = capacity;
+    }
+    write_span_words(bm->pending + WEBBRIDGE_SPAN_WORDS * bm->num_pending, spans, num_spans, 1);
+    bm->num_pending++;
+    return true;
+}
+
+/**
+ * @brief Write the kept streamed matches that fit into a span array
+ *
+ * @param bm The matcher
+ * @param spans The span array
+ * @param max_words Number of words in spans
+ * @return Number of matches written
+ */
+static uint32_t
+write_streamed_matches(bridge_matcher_t *bm, uint32_t *spans, uint32_t max_words)
+{
+    size_t room = (max_words - RIFT_WEBBRIDGE_BATCH_HEADER_WORDS) / WEBBRIDGE_SPAN_WORDS;
+    size_t count = bm->num_pending < room ? bm->num_pending : room;
+    if (count > 0) {
+        // The rest goes first on the next call
+        memcpy(spans + RIFT_WEBBRIDGE_BATCH_HEADER_WORDS, bm->pending,
+               count * WEBBRIDGE_SPAN_WORDS * sizeof(uint32_t));
+        bm->num_pending -= count;
+        memmove(bm->pending, bm->pending + WEBBRIDGE_SPAN_WORDS * count,
+                bm->num_pending * WEBBRIDGE_SPAN_WORDS * sizeof(uint32_t));
+    }
+    spans[0] = 1;
+    spans[1] = bm->num_pending > 0 ? 1 : 0;
+    return (uint32_t)count;
+}
+
+/**
+ * @brief Look up a streaming matcher and check its span array
+ *
+ * @param matcher_handle Handle to the matcher
+ * @param spans The span array
+ * @param max_words Number of words in spans
+ * @return The matcher or NULL, with the error set, on failure
+ */
+static bridge_matcher_t *
+get_stream(rift_matcher_handle_t matcher_handle, const uint32_t *spans, uint32_t max_words)
+{
+    bridge_matcher_t *bm = (bridge_matcher_t *)bridge_get(bridge.matchers, matcher_handle,
+                                                          "matcher");
+    if (!bm) {
+        return NULL;
+    }
+    if (!bm->streaming) {
+        set_error("No stream in progress");
+        return NULL;
+    }
+    if (!spans || max_words < RIFT_WEBBRIDGE_BATCH_HEADER_WORDS) {
+        set_error("Span array too small for its header");
+        return NULL;
+    }
+    return bm;
+}
+
+RIFT_EXPORT int
+rift_webbridge_stream_begin(rift_matcher_handle_t matcher_handle)
+{
+    bridge_matcher_t *bm = (bridge_matcher_t *)bridge_get(bridge.matchers, matcher_handle,
+                                                          "matcher");
+    if (!bm) {
+        return 0;
+    }
+
+    rift_matcher_set_stream_callback(bm->matcher, keep_streamed_match, bm);
+    rift_matcher_stream_reset(bm->matcher);
+    bm->num_pending = 0;
+    bm->stream_fed_last = false;
+    bm->stream_failed = false;
+
+    // An empty chunk checks that the pattern can be streamed at all
+    bm->streaming = rift_matcher_feed(bm->matcher, NULL, 0, false);
+    if (!bm->streaming) {
+        set_error("The pattern cannot be streamed");
+        return 0;
+    }
+    return 1;
+}
+
+RIFT_EXPORT uint32_t
+rift_webbridge_stream_feed(rift_matcher_handle_t matcher_handle, const char *chunk,
+                           int32_t length, uint32_t *spans, uint32_t max_words)
+{
+    bridge_matcher_t *bm = get_stream(matcher_handle, spans, max_words);
+    if (!bm || (!chunk && length > 0) || length < 0 || bm->stream_fed_last) {
+        return 0;
+    }
+
+    if (!rift_matcher_feed(bm->matcher, chunk, (size_t)length, false) || bm->stream_failed) {
+        set_error("Failed to match the chunk");
+        return 0;
+    }
+    return write_streamed_matches(bm, spans, max_words);
+}
+
+RIFT_EXPORT uint32_t
+rift_webbridge_stream_end(rift_matcher_handle_t matcher_handle, uint32_t *spans,
+                          uint32_t max_words)
+{
+    bridge_matcher_t *bm = get_stream(matcher_handle, spans, max_words);
+    if (!bm) {
+        return 0;
+    }
+
+    if (!bm->stream_fed_last) {
+        bm->stream_fed_last = true;
+        if (!rift_matcher_feed(bm->matcher, NULL, 0, true) || bm->stream_failed) {
+            bm->streaming = false;
+            set_error("Failed to end the stream");
+            return 0;
+        }
+    }
+    uint32_t count = write_streamed_matches(bm, spans, max_words);
+    if (bm->num_pending == 0) {
+        bm->streaming = false;
+    }
+    return count;
+}
+
+RIFT_EXPORT void
+rift_webbridge_free_matcher(rift_matcher_handle_t matcher_handle)
+{
+    bridge_matcher_free((bridge_matcher_t *)bridge_remove(bridge.matchers, matcher_handle));
+}
+
+RIFT_EXPORT uint32_t
+rift_webbridge_free_matchers(const rift_matcher_handle_t *matcher_handles, uint32_t count)
+{
+    if (!matcher_handles) {
+        return 0;
+    }
+
+    uint32_t freed = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        bridge_matcher_t *bm = (bridge_matcher_t *)bridge_remove(bridge.matchers,
+                                                                 matcher_handles[i]);
+        if (bm) {
+            bridge_matcher_free(bm);
+            freed++;
+        }
+    }
+    return freed;
+}
+
+RIFT_EXPORT uint32_t
+rift_webbridge_free_pattern_matchers(rift_pattern_handle_t pattern_handle)
+{
+    if (pattern_handle == RIFT_HANDLE_INVALID) {
+        return 0;
+    }
+    BRIDGE_LOCK();
+    size_t freed =
+        rift_handle_table_remove_each(bridge.matchers, free_matcher_of_pattern, &pattern_handle);
+    BRIDGE_UNLOCK();
+    return (uint32_t)freed;
+}
+
+#if WEBBRIDGE_THREADS
+/**
+ * @brief Append the results of one input to a worker's words
+ *
+ * @param worker The worker
+ * @param num_words Number of words to make room for
+ * @return Pointer to the room or NULL on allocation failure
+ */
+static uint32_t *
+worker_reserve(bridge_worker_t *worker, size_t num_words)
+{
+    if (worker->capacity - worker->num_words < num_words) {
+        size_t capacity = worker->capacity ? worker->capacity : WEBBRIDGE_WORKER_CAPACITY;
+        while (capacity - worker->num_words < num_words) {
+            capacity *= 2;
+        }
+        uint32_t *words = (uint32_t *)realloc(worker->words, capacity * sizeof(uint32_t));
+        if (!words) {
+            return NULL;
+        }
+        worker->words = words;
+        worker->capacity = capacity;
+    }
+    uint32_t *room = worker->words + worker->num_words;
+    worker->num_words += num_words;
+    return room;
+}
+
+/**
+ * @brief Append one match of an input to a worker's words
+ */
+static bool
+worker_write_match(const rift_regex_span_t *spans, size_t num_spans, void *user_data)
+{
+    bridge_worker_t *worker = (bridge_worker_t *)user_data;
+    size_t width = worker->pool->num_spans;
+    uint32_t *words = worker_reserve(worker, WEBBRIDGE_SPAN_WORDS * width);
+    if (!words) {
+        atomic_store(&worker->pool->failed, true);
+        return false;
+    }
+    write_span_words(words, spans, num_spans, width);
+    return true;
+}
+
+/**
+ * @brief Match the inputs of the current batch a worker takes
+ *
+ * @param worker The worker
+ */
+static void
+worker_run_batch(bridge_worker_t *worker)
+{
+    bridge_pool_t *pool = worker->pool;
+    worker->num_words = 0;
+
+    while (!atomic_load(&pool->failed)) {
+        uint32_t i = atomic_fetch_add(&pool->next_input, 1);
+        if (i >= pool->count) {
+            break;
+        }
+
+        // The count word goes first, filled in once the matches are known
+        size_t offset = worker->num_words;
+        if (!worker_reserve(worker, 1)) {
+            atomic_store(&pool->failed, true);
+            break;
+        }
+        rift_matcher_set_input(worker->matcher, pool->inputs + pool->offsets[i],
+                               pool->offsets[i + 1] - pool->offsets[i]);
+        if (!rift_matcher_for_each_match(worker->matcher, worker_write_match, worker)) {
+            atomic_store(&pool->failed, true);
+            break;
+        }
+        size_t num_words = worker->num_words - offset;
+        size_t match_words = WEBBRIDGE_SPAN_WORDS * pool->num_spans;
+        worker->words[offset] = (uint32_t)((num_words - 1) / match_words);
+        pool->results[i] = (bridge_result_t){worker, offset, num_words};
+    }
+}
+
+/**
+ * @brief Thread of a pool worker, matching batches until the pool stops
+ */
+static void *
+worker_main(void *arg)
+{
+    bridge_worker_t *worker = (bridge_worker_t *)arg;
+    bridge_pool_t *pool = worker->pool;
+    uint64_t seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    while (true) {
+        while (!pool->stopping && pool->generation == seen) {
+            pthread_cond_wait(&pool->work_ready, &pool->lock);
+        }
+        if (pool->stopping) {
+            break;
+        }
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+
+        worker_run_batch(worker);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->active == 0) {
+            pthread_cond_signal(&pool->work_done);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/**
+ * @brief Stop the workers of a pool and free it
+ *
+ * @param pool The pool (can be NULL)
+ */
+static void
+bridge_pool_free(bridge_pool_t *pool)
+{
+    if (!pool) {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stopping = true;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+    for (size_t i = 0; i < pool->num_started; i++) {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    for (size_t i = 0; pool->workers && i < pool->num_workers; i++) {
+        rift_matcher_free(pool->workers[i].matcher);
+        free(pool->workers[i].words);
+    }
+    pthread_cond_destroy(&pool->work_done);
+    pthread_cond_destroy(&pool->work_ready);
+    pthread_mutex_destroy(&pool->lock);
+    pthread_mutex_destroy(&pool->batch_lock);
+    free(pool->workers);
+    free(pool->threads);
+    free(pool->results);
+    free(pool);
+}
+
+/**
+ * @brief Get the number of workers to use when none is given
+ *
+ * @return Number of logical cores, at least 1
+ */
+static size_t
+default_workers(void)
+{
+#ifdef __EMSCRIPTEN__
+    int cores = emscripten_num_logical_cores();
+#else
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    return cores > 0 ? (size_t)cores : 1;
+}
+#endif
+
+RIFT_EXPORT rift_pool_handle_t
+rift_webbridge_create_pool(rift_pattern_handle_t pattern_handle, uint32_t num_workers)
+{
+#if WEBBRIDGE_THREADS
+    const rift_regex_pattern_t *pattern =
+        (const rift_regex_pattern_t *)bridge_get(bridge.patterns, pattern_handle, "pattern");
+    if (!pattern) {
+        return RIFT_HANDLE_INVALID;
+    }
+
+    bridge_pool_t *pool = (bridge_pool_t *)calloc(1, sizeof(bridge_pool_t));
+    if (!pool) {
+        set_error("Failed to allocate the pool");
+        return RIFT_HANDLE_INVALID;
+    }
+    pool->pattern = pattern;
+    pool->num_spans = rift_regex_pattern_get_group_count(pattern) + 1;
+    pool->num_workers = num_workers ? num_workers : default_workers();
+    pthread_mutex_init(&pool->batch_lock, NULL);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work_ready, NULL);
+    pthread_cond_init(&pool->work_done, NULL);
+    atomic_init(&pool->next_input, 0);
+    atomic_init(&pool->failed, false);
+
+    pool->workers = (bridge_worker_t *)calloc(pool->num_workers, sizeof(bridge_worker_t));
+    pool->threads = (pthread_t *)calloc(pool->num_workers, sizeof(pthread_t));
+    bool ready = pool->workers && pool->threads;
+    for (size_t i = 0; ready && i < pool->num_workers; i++) {
+        pool->workers[i].pool = pool;
+        pool->workers[i].matcher = rift_matcher_create(pattern, RIFT_MATCHER_OPTION_NONE);
+        ready = pool->workers[i].matcher != NULL;
+    }
+    for (size_t i = 0; ready && i < pool->num_workers; i++) {
+        ready = pthread_create(&pool->threads[i], NULL, worker_main, &pool->workers[i]) == 0;
+        pool->num_started += ready ? 1 : 0;
+    }
+    if (!ready) {
+        bridge_pool_free(pool);
+        set_error("Failed to start the pool workers");
+        return RIFT_HANDLE_INVALID;
+    }
+
+    rift_pool_handle_t handle = bridge_insert(bridge.pools, pool);
+    if (handle == RIFT_HANDLE_INVALID) {
+        bridge_pool_free(pool);
+    }
+    return handle;
+#else
+    (void)pattern_handle;
+    (void)num_workers;
+    set_error("Worker pools need a build with pthreads");
+    return RIFT_HANDLE_INVALID;
+#endif
+}
+
+RIFT_EXPORT uint32_t
+rift_webbridge_pool_find_all_batch(rift_pool_handle_t pool_handle, const char *inputs,
+                                   const uint32_t *offsets, uint32_t count, uint32_t *spans,
+                                   uint32_t max_words)
+{
+#if WEBBRIDGE_THREADS
+    bridge_pool_t *pool = (bridge_pool_t *)bridge_get(bridge.pools, pool_handle, "pool");
+    if (!pool) {
+        return 0;
+    }
+    if ((!inputs && count > 0) || !offsets || !spans ||
+        max_words < RIFT_WEBBRIDGE_BATCH_HEADER_WORDS) {
+        set_error("Invalid batch parameters");
+        return 0;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        if (offsets[i + 1] < offsets[i]) {
+            set_error("Offsets of input %u decrease", i);
+            return 0;
+        }
+    }
+
+    pthread_mutex_lock(&pool->batch_lock);
+    if (pool->results_capacity < count) {
+        bridge_result_t *results =
+            (bridge_result_t *)realloc(pool->results, count * sizeof(bridge_result_t));
+        if (!results) {
+            pthread_mutex_unlock(&pool->batch_lock);
+            set_error("Failed to allocate the batch results");
+            return 0;
+        }
+        pool->results = results;
+        pool->results_capacity = count;
+    }
+
+    // Start the workers on the batch and wait for the last one
+    pthread_mutex_lock(&pool->lock);
+    pool->inputs = inputs;
+    pool->offsets = offsets;
+    pool->count = count;
+    atomic_store(&pool->next_input, 0);
+    atomic_store(&pool->failed, false);
+    pool->active = pool->num_workers;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->work_ready);
+    while (pool->active > 0) {
+        pthread_cond_wait(&pool->work_done, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    if (atomic_load(&pool->failed)) {
+        pthread_mutex_unlock(&pool->batch_lock);
+        set_error("Failed to match the batch");
+        return 0;
+    }
+
+    // Gather the results in input order, as many inputs as fit
+    uint32_t used = RIFT_WEBBRIDGE_BATCH_HEADER_WORDS;
+    uint32_t written = 0;
+    while (written < count) {
+        const bridge_result_t *result = &pool->results[written];
+        if (max_words - used < result->num_words) {
+            break;
+        }
+        memcpy(spans + used, result->worker->words + result->offset,
+               result->num_words * sizeof(uint32_t));
+        used += (uint32_t)result->num_words;
+        written++;
+    }
+    spans[0] = (uint32_t)pool->num_spans;
+    spans[1] = written < count ? 1 : 0;
+    pthread_mutex_unlock(&pool->batch_lock);
+    return written;
+#else
+    (void)pool_handle;
+    (void)inputs;
+    (void)offsets;
+    (void)count;
+    (void)spans;
+    (void)max_words;
+    set_error("Worker pools need a build with pthreads");
+    return 0;
+#endif
+}
+
+RIFT_EXPORT void
+rift_webbridge_free_pool(rift_pool_handle_t pool_handle)
+{
+#if WEBBRIDGE_THREADS
+    bridge_pool_free((bridge_pool_t *)bridge_remove(bridge.pools, pool_handle));
+#else
+    (void)pool_handle;
+#endif
+}
+
+RIFT_EXPORT uint32_t
+rift_webbridge_serialize_pattern(rift_pattern_handle_t pattern_handle, uint8_t *buffer,
+                                 uint32_t *buffer_size)
+{
+    const rift_regex_pattern_t *pattern =
+        (const rift_regex_pattern_t *)bridge_get(bridge.patterns, pattern_handle, "pattern");
+    if (!pattern) {
+        return 0;
+    }
+
+    unsigned char *data = NULL;
+    size_t size = 0;
+    if (!rift_regex_pattern_serialize(pattern, &data, &size) || size > UINT32_MAX) {
+        free(data);
+        set_error("Failed to serialize the pattern");
+        return 0;
+    }
+
+    // Without a buffer, or with one too small, only the size is reported
+    uint32_t capacity = buffer_size ? *buffer_size : 0;
+    if (buffer_size) {
+        *buffer_size = (uint32_t)size;
+    }
+    if (buffer && capacity < size) {
+        free(data);
+        set_error("Buffer of %u bytes too small for %zu", capacity, size);
+        return 0;
+    }
+    if (buffer) {
+        memcpy(buffer, data, size);
+    }
+    free(data);
+    return (uint32_t)size;
+}
+
+RIFT_EXPORT rift_pattern_handle_t
+rift_webbridge_deserialize_pattern(const uint8_t *buffer, uint32_t buffer_size)
+{
+    if (!buffer) {
+        set_error("No buffer given");
+        return RIFT_HANDLE_INVALID;
+    }
+
+    rift_regex_error_t error = {RIFT_REGEX_ERROR_NONE};
+    rift_regex_pattern_t *pattern = rift_regex_pattern_deserialize(buffer, buffer_size, &error);
+    if (!pattern) {
+        const char *message = rift_regex_error_message(&error);
+        set_error("%s", message[0] ? message : "Invalid serialized pattern");
+        return RIFT_HANDLE_INVALID;
+    }
+
+    rift_pattern_handle_t handle = bridge_insert(bridge.patterns, pattern);
+    if (handle == RIFT_HANDLE_INVALID) {
+        rift_regex_pattern_free(pattern);
+    }
+    return handle;
+}
+
+RIFT_EXPORT rift_pattern_set_handle_t
+rift_webbridge_load_bundle(const uint8_t *buffer, uint32_t buffer_size)
+{
+    if (!buffer) {
+        set_error("No buffer given");
+        return RIFT_HANDLE_INVALID;
+    }
+
+    void *compilation = rift_dsl_load_container(buffer, buffer_size);
+    if (!compilation) {
+        set_error("Failed to load the bundle");
+        return RIFT_HANDLE_INVALID;
+    }
+    const char *message = rift_dsl_get_compilation_error(compilation);
+    if (message) {
+        set_error("%s", message);
+        rift_dsl_free_compilation(compilation);
+        return RIFT_HANDLE_INVALID;
+    }
+
+    rift_pattern_set_handle_t handle = bridge_insert(bridge.bundles, compilation);
+    if (handle == RIFT_HANDLE_INVALID) {
+        rift_dsl_free_compilation(compilation);
+    }
+    return handle;
+}
+
+RIFT_EXPORT uint32_t
+rift_webbridge_bundle_count(rift_pattern_set_handle_t set_handle)
+{
+    void *compilation = bridge_get(bridge.bundles, set_handle, "bundle");
+    return compilation ? (uint32_t)rift_dsl_get_compiled_count(compilation) : 0;
+}
+
+RIFT_EXPORT int
+rift_webbridge_bundle_matches(rift_pattern_set_handle_t set_handle, uint32_t index,
+                              const char *input, int32_t length)
+{
+    void *compilation = bridge_get(bridge.bundles, set_handle, "bundle");
+    if (!compilation || !input) {
+        return 0;
+    }
+    size_t input_length = length < 0 ? (size_t)-1 : (size_t)length;
+    return rift_dsl_execute(compilation, index, input, input_length, NULL) ? 1 : 0;
+}
+
+RIFT_EXPORT void
+rift_webbridge_free_bundle(rift_pattern_set_handle_t set_handle)
+{
+    void *compilation = bridge_remove(bridge.bundles, set_handle);
+    if (compilation) {
+        rift_dsl_free_compilation(compilation);
+    }
+}
+
+RIFT_EXPORT int
+rift_webbridge_run_bytecode(const uint8_t *bytecode, uint32_t bytecode_size, const char *input,
+                            uint32_t input_length, uint32_t *match_start, uint32_t *match_end)
+{
+    if (!bytecode || !input) {
+        set_error("No bytecode or input given");
+        return 0;
+    }
+
+    rift_regex_error_t error = {RIFT_REGEX_ERROR_NONE};
+    rift_bytecode_program_t *program = rift_bytecode_deserialize(bytecode, bytecode_size, &error);
+    if (!program) {
+        const char *message = rift_regex_error_message(&error);
+        set_error("%s", message[0] ? message : "Invalid bytecode");
+        return 0;
+    }
+
+    rift_regex_match_t match;
+    memset(&match, 0, sizeof(match));
+    rift_bytecode_vm_t *vm = rift_bytecode_vm_acquire(program, input, input_length);
+    bool found = vm && rift_bytecode_execute(program, vm, &match);
+    rift_bytecode_vm_release(vm);
+
+    // The program is freed below, so the pool must not keep it
+    rift_bytecode_vm_pool_evict(program);
+    rift_bytecode_program_free(program);
+
+    if (!found) {
+        return 0;
+    }
+    if (match_start) {
+        *match_start = (uint32_t)match.start_pos;
+    }
+    if (match_end) {
+        *match_end = (uint32_t)match.end_pos;
+    }
+    return 1;
+}
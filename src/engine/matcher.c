@@ -1,6 +1,4 @@
 /**
-core/engine/matcher.h
-engine/matcher.h"
  * @file matcher.c
  * @brief Implementation of the pattern matching interface for the LibRift regex engine
  *
@@ -12,7 +10,34 @@ engine/matcher.h"
  * @license MIT License
  */
 
-#include "core/runtime/matcher.h
+#include "core/runtime/matcher.h"
+#include "core/automaton/bit_parallel.h"
+#include "core/automaton/epsilon_closure.h"
+#include "core/automaton/lazy_dfa.h"
+#include "core/automaton/lookaround.h"
+#include "core/automaton/one_pass.h"
+#include "core/automaton/pike_vm.h"
+#include "core/automaton/reverse.h"
+#include "core/automaton/tdfa.h"
+#include "core/automaton/state.h"
+#include "core/automaton/transition.h"
+#include "core/compiler/ambiguity.h"
+#include "core/compiler/engine_plan.h"
+#include "core/compiler/match_length.h"
+#include "core/compiler/prefilter.h"
+#include "core/config/config.h"
+#include "core/parser/ast.h"
+#include "core/runtime/backtrack_stack.h"
+#include "core/runtime/metrics.h"
+#include "core/runtime/probes.h"
+#include "core/runtime/replacement.h"
+#include "core/runtime/trace_buffer.h"
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 /**
  * @brief Check if the matcher has timed out
  *
@@ -30,7 +55,115 @@ bool check_timeout(rift_regex_matcher_t *matcher);
  */
 
 /**
- * @brief Check if the matcher has timed out
+ * @brief Get the current time of the monotonic clock used for deadlines
+ *
+ * @return Nanoseconds since an unspecified starting point
+ */
+uint64_t
+rift_matcher_monotonic_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * @brief Compute the deadline of a match attempt starting now
+ *
+ * The clock is read at most once here. check_timeout then compares against the
+ * result, so the per-character cost is a countdown. The countdown carries
+ * over between attempts, so a run of many short attempts still reads the
+ * clock.
+ *
+ * @param matcher The matcher
+ */
+static void
+start_timeout(rift_regex_matcher_t *matcher)
+{
+    matcher->timed_out = false;
+    matcher->deadline_ns = matcher->request_deadline_ns;
+
+    // The registry limit applies along with the matcher's own timeout
+    uint32_t timeout_ms = matcher->timeout_ms;
+    if (matcher->limits.max_duration_ms != 0 &&
+        (timeout_ms == 0 || matcher->limits.max_duration_ms < timeout_ms)) {
+        timeout_ms = matcher->limits.max_duration_ms;
+    }
+
+    if (timeout_ms != 0) {
+        uint64_t deadline = rift_matcher_monotonic_ns() + (uint64_t)timeout_ms * 1000000u;
+        if (deadline < matcher->deadline_ns) {
+            matcher->deadline_ns = deadline;
+        }
+    }
+}
+
+/**
+ * @brief Resolve the registry limits again if the registry has changed
+ *
+ * The common case is one acquire load of the registry generation.
+ *
+ * @param matcher The matcher
+ */
+/**
+ * @brief Size the engines of a matcher for its memory budget
+ *
+ * The backtracker's depth is capped on every call, as resolving the limits
+ * may have raised it; the lazy DFA is dropped only when the budget changed.
+ *
+ * @param matcher The matcher
+ */
+static void
+apply_memory_budget(rift_regex_matcher_t *matcher)
+{
+    size_t budget = matcher->memory_budget;
+    if (matcher->limits.max_memory_bytes != 0 &&
+        (budget == 0 || matcher->limits.max_memory_bytes < budget)) {
+        budget = (size_t)matcher->limits.max_memory_bytes;
+    }
+
+    if (budget != matcher->applied_budget) {
+        rift_lazy_dfa_free(matcher->lazy_dfa);
+        rift_lazy_dfa_free(matcher->forward_dfa);
+        rift_lazy_dfa_free(matcher->reverse_dfa);
+        matcher->lazy_dfa = NULL;
+        matcher->forward_dfa = NULL;
+        matcher->reverse_dfa = NULL;
+        matcher->reverse_search_ready = false;
+        matcher->lazy_dfa_over_budget = false;
+        matcher->applied_budget = budget;
+    }
+
+    // Each frame may log a capture write to undo
+    if (budget != 0) {
+        size_t max_frames =
+            budget / (sizeof(rift_backtrack_frame_t) + sizeof(rift_backtrack_undo_t));
+        if (max_frames < matcher->backtrack_stack->max_depth) {
+            rift_backtrack_stack_set_max_depth(matcher->backtrack_stack,
+                                               max_frames > 0 ? max_frames : 1);
+        }
+    }
+}
+
+static void
+refresh_limits(rift_regex_matcher_t *matcher)
+{
+    if (!matcher->limit_registry ||
+        rift_backtrack_limit_registry_get_generation(matcher->limit_registry) ==
+            matcher->limits.generation) {
+        return;
+    }
+
+    if (rift_backtrack_limit_registry_resolve(matcher->limit_registry, matcher->limit_pattern_id,
+                                              matcher->limit_match_id, &matcher->limits) &&
+        matcher->limits.max_depth != 0) {
+        rift_backtrack_stack_set_max_depth(matcher->backtrack_stack, matcher->limits.max_depth);
+    }
+    apply_memory_budget(matcher);
+}
+
+/**
+ * @brief Check if the matcher has timed out or been cancelled
  *
  * @param matcher The matcher
  * @return true if timed out, false otherwise
@@ -38,15 +171,28 @@ bool check_timeout(rift_regex_matcher_t *matcher);
 bool
 check_timeout(rift_regex_matcher_t *matcher)
 {
-    if (!matcher || matcher->timeout_ms == 0) {
+    if (!matcher) {
         return false;
     }
 
-    clock_t current_time = clock();
-    double elapsed_ms = (double)(current_time - matcher->start_time) * 1000.0 / CLOCKS_PER_SEC;
+    if (matcher->deadline_ns == RIFT_MATCHER_NO_DEADLINE && !matcher->cancel_flag) {
+        return false;
+    }
 
-    if (elapsed_ms >= matcher->timeout_ms) {
+    if (--matcher->timeout_countdown != 0) {
+        return false;
+    }
+    matcher->timeout_countdown = RIFT_MATCHER_TIMEOUT_CHECK_INTERVAL;
+
+    bool cancelled =
+        matcher->cancel_flag && atomic_load_explicit(matcher->cancel_flag, memory_order_relaxed);
+    if (cancelled || (matcher->deadline_ns != RIFT_MATCHER_NO_DEADLINE &&
+                      rift_matcher_monotonic_ns() >= matcher->deadline_ns)) {
+        // Callers unwind at once; the next check, from the caller's loop, reads again
+        matcher->timeout_countdown = 1;
         matcher->timed_out = true;
+        RIFT_PROBE3(timeout, matcher->pattern, (int)cancelled,
+                    rift_matcher_context_get_position(matcher->context));
         return true;
     }
 
@@ -67,20 +213,73 @@ rift_matcher_create(const rift_regex_pattern_t *pattern, rift_matcher_option_t o
         return NULL;
     }
 
-    // Allocate the matcher structure
-    rift_regex_matcher_t *matcher = (rift_regex_matcher_t *)malloc(sizeof(rift_regex_matcher_t));
+    // Allocate the matcher structure; matchers come and go per request
+    rift_regex_matcher_t *matcher =
+        (rift_regex_matcher_t *)rift_pool_alloc(sizeof(rift_regex_matcher_t));
     if (!matcher) {
         return NULL;
     }
 
-    // Initialize the matcher
+    // Initialize the matcher; its settings are those of the pattern, so searches read no global
+    const rift_regex_config_t *config = rift_regex_pattern_get_config(pattern);
     matcher->pattern = pattern;
+    matcher->config = *config;
     matcher->context = NULL; // Will be set when input is provided
+    matcher->lazy_dfa = NULL; // Built on the first match that can use it
+    matcher->forward_dfa = NULL;
+    matcher->reverse_dfa = NULL;
+    matcher->reverse_search_ready = false;
+    matcher->bit_parallel = NULL; // Built on the first match the lazy DFA cannot take
+    matcher->bit_parallel_ready = false;
+    matcher->one_pass = NULL; // Built on the first match that can use it
+    matcher->one_pass_slots = NULL;
+    matcher->one_pass_ready = false;
+    matcher->tdfa = NULL; // Built on the first match the one-pass DFA cannot take
+    matcher->tdfa_slots = NULL;
+    matcher->tdfa_ready = false;
+    matcher->pike_vm = NULL;
+    matcher->pike_slots = NULL;
+    matcher->prefilter = NULL; // Built on the first search
+    matcher->prefilter_ready = false;
+    matcher->last_match_start = 0;
+    matcher->last_match_end = 0;
+    matcher->stream_callback = NULL;
+    matcher->stream_user_data = NULL;
+    matcher->stream_buffer = NULL;
+    matcher->stream_length = 0;
+    matcher->stream_capacity = 0;
+    matcher->stream_offset = 0;
+    matcher->stream_before = RIFT_LAZY_DFA_TEXT_EDGE;
+    matcher->stream_stopped = false;
     matcher->flags = rift_regex_pattern_get_flags(pattern);
     matcher->options = options;
     matcher->timeout_ms = 0;
     matcher->timed_out = false;
-    matcher->start_time = 0;
+    matcher->request_deadline_ns = RIFT_MATCHER_NO_DEADLINE;
+    matcher->deadline_ns = RIFT_MATCHER_NO_DEADLINE;
+    matcher->timeout_countdown = RIFT_MATCHER_TIMEOUT_CHECK_INTERVAL;
+    matcher->cancel_flag = NULL;
+    matcher->limit_registry = NULL;
+    matcher->limit_pattern_id = 0;
+    matcher->limit_match_id = 0;
+    memset(&matcher->limits, 0, sizeof(matcher->limits));
+    matcher->step_count = 0;
+    matcher->step_limit = 0;
+    matcher->step_pending = false;
+    matcher->switch_steps_per_byte = RIFT_MATCHER_SWITCH_STEPS_PER_BYTE;
+    matcher->stats_enabled = false;
+    matcher->trace = NULL;
+    matcher->metrics = NULL;
+    matcher->metrics_pattern_id = 0;
+    matcher->metrics_start_ns = 0;
+    matcher->last_engine = RIFT_MATCH_ENGINE_NONE;
+    rift_match_stats_reset(&matcher->stats);
+    rift_match_stats_reset(&matcher->stats_total);
+    matcher->allocator = NULL;
+    matcher->memory_budget = 0;
+    matcher->applied_budget = 0;
+    matcher->lazy_dfa_over_budget = false;
+    matcher->bounds_only = false;
 
     // Get the number of capture groups from the pattern
     size_t num_groups = rift_regex_pattern_get_group_count(pattern);
@@ -88,9 +287,9 @@ rift_matcher_create(const rift_regex_pattern_t *pattern, rift_matcher_option_t o
     // Create the backtracker
     // Default max depth is 10000, but this can be changed later
 
-    matcher->backtracker = rift_backtracker_create(10000, num_groups);
-    if (!matcher->backtracker) {
-        free(matcher);
+    matcher->backtrack_stack = rift_backtrack_stack_create(10000, num_groups);
+    if (!matcher->backtrack_stack) {
+        rift_pool_free(matcher, sizeof(rift_regex_matcher_t));
         return NULL;
     }
 
@@ -116,12 +315,24 @@ rift_matcher_free(rift_regex_matcher_t *matcher)
     }
 
     // Free the backtracker
-    if (matcher->backtracker) {
-        rift_backtracker_free((rift_regex_backtracker_t *)matcher->backtracker);
-    }
-
-    // Free the matcher itself
-    free(matcher);
+    rift_backtrack_stack_free(matcher->backtrack_stack);
+
+    // Free the lazy DFA, the bit-parallel NFA, the one-pass and tagged DFAs and the Pike VM
+    rift_lazy_dfa_free(matcher->lazy_dfa);
+    rift_lazy_dfa_free(matcher->forward_dfa);
+    rift_lazy_dfa_free(matcher->reverse_dfa);
+    rift_bit_parallel_free(matcher->bit_parallel);
+    rift_one_pass_free(matcher->one_pass);
+    rift_free(matcher->one_pass_slots);
+    rift_tdfa_free(matcher->tdfa);
+    rift_free(matcher->tdfa_slots);
+    rift_pike_vm_free(matcher->pike_vm);
+    rift_free(matcher->pike_slots);
+    rift_prefilter_free(matcher->prefilter);
+    rift_free(matcher->stream_buffer);
+
+    // Return the matcher itself to its pool
+    rift_pool_free(matcher, sizeof(rift_regex_matcher_t));
 }
 
 /**
@@ -162,12 +373,11 @@ rift_matcher_reset(rift_regex_matcher_t *matcher)
     }
 
     // Reset the backtracker
-    if (matcher->backtracker) {
-        rift_backtracker_reset(matcher->backtracker);
-    }
+    rift_backtrack_stack_reset(matcher->backtrack_stack);
 
-    // Reset timeout status
+    // Reset timeout status and abandon a stepped search
     matcher->timed_out = false;
+    matcher->step_pending = false;
 }
 
 /**
@@ -184,6 +394,7 @@ rift_matcher_set_input(rift_regex_matcher_t *matcher, const char *input, size_t
     if (!matcher || !input) {
         return false;
     }
+    matcher->step_pending = false;
 
     // Use strlen if length is not specified
     if (length == (size_t)-1) {
@@ -208,676 +419,3017 @@ rift_matcher_set_input(rift_regex_matcher_t *matcher, const char *input, size_t
 }
 
 /**
- * @brief Process a single character through the automaton
+ * @brief Push a backtrack point
  *
- * @param automaton The automaton
- * @param c The character to process
- * @param matcher The matcher for backtracking
- * @param context The matcher context for capturing
- * @return true if the character was accepted, false otherwise
+ * Captures are not copied: the backtrack stack holds them as slots and logs
+ * the old value of a slot only when it is written, so a point costs one
+ * frame in a contiguous array.
+ *
+ * @param matcher The matcher
+ * @param state The state to resume from
+ * @param pos The input position to resume at
  */
-bool
-process_character(rift_regex_automaton_t *automaton, char c, rift_regex_matcher_t *matcher,
-                  rift_regex_matcher_context_t *context)
-{
-    // Get all possible transitions from the current state
-    rift_regex_transition_t *transitions[100]; // Arbitrary limit, could be dynamic
-    size_t num_transitions = rift_automaton_get_current_transitions(automaton, transitions, 100);
-
-    // Try all epsilon transitions first (without consuming input)
-    for (size_t i = 0; i < num_transitions; i++) {
-        if (rift_automaton_transition_is_epsilon(transitions[i])) {
-            // Save current state for potential backtracking
-            rift_regex_state_t *current_state = rift_automaton_get_current_state(automaton);
-            size_t current_pos = rift_matcher_context_get_position(context);
-
-            // Follow the epsilon transition
-            rift_regex_state_t *target = rift_automaton_transition_get_target(transitions[i]);
-            rift_automaton_set_current_state(automaton, target);
-
-            // Recursively process the same character
-            if (process_character(automaton, c, matcher, context)) {
-                return true;
-            }
+static void
+push_backtrack_point(rift_regex_matcher_t *matcher, rift_regex_state_t *state, size_t pos)
+{
+    rift_backtrack_stack_push(matcher->backtrack_stack, state, pos);
 
-            // Backtrack
-            rift_automaton_set_current_state(automaton, current_state);
-            rift_matcher_context_set_position(context, current_pos);
+    if (matcher->stats_enabled) {
+        size_t depth = rift_backtrack_stack_get_depth(matcher->backtrack_stack);
+        matcher->stats.backtrack_pushes++;
+        if (depth > matcher->stats.max_stack_depth) {
+            matcher->stats.max_stack_depth = depth;
         }
     }
+}
 
-    // Try all non-epsilon transitions
-    for (size_t i = 0; i < num_transitions; i++) {
-        if (!rift_automaton_transition_is_epsilon(transitions[i])) {
-            const char *pattern = rift_automaton_transition_get_pattern(transitions[i]);
-
-            // Check if this transition accepts the character
-            // This would require a more complex matching logic in practice
-            if (pattern && pattern[0] == c) {
-                rift_regex_state_t *target = rift_automaton_transition_get_target(transitions[i]);
-                rift_automaton_set_current_state(automaton, target);
-
-                // Consume the character in the context
-                rift_matcher_context_advance(context);
+/**
+ * @brief Record an event at a state when the matcher is traced
+ *
+ * @param matcher The matcher
+ * @param event What happened
+ * @param state The state, or NULL for an engine without states
+ * @param pos Input position
+ */
+static inline void
+trace_state(const rift_regex_matcher_t *matcher, rift_trace_event_t event,
+            const rift_regex_state_t *state, size_t pos)
+{
+    if (matcher->trace) {
+        rift_trace_buffer_record(matcher->trace, event,
+                                 state ? state->id : RIFT_TRACE_NO_LOCATION, pos);
+    }
+}
 
-                return true;
-            }
+/**
+ * @brief Copy the context's capture groups into the backtrack stack's slots
+ *
+ * Called with no frames pushed, so nothing is logged.
+ *
+ * @param matcher The matcher
+ */
+static void
+load_capture_slots(rift_regex_matcher_t *matcher)
+{
+    rift_backtrack_stack_t *stack = matcher->backtrack_stack;
+    rift_regex_capture_groups_t *groups = rift_matcher_context_get_capture_groups(matcher->context);
+
+    for (size_t i = 0; groups && i < stack->num_groups; i++) {
+        rift_regex_capture_groups_t *group = rift_capture_groups_get_by_index(groups, i);
+        if (group) {
+            rift_backtrack_stack_set_slot(stack, 2 * i, rift_capture_group_get_start(group));
+            rift_backtrack_stack_set_slot(stack, 2 * i + 1, rift_capture_group_get_end(group));
         }
     }
+}
 
-    return false;
+/**
+ * @brief Copy the backtrack stack's slots back into the context's capture groups
+ *
+ * @param matcher The matcher
+ */
+static void
+store_capture_slots(rift_regex_matcher_t *matcher)
+{
+    rift_backtrack_stack_t *stack = matcher->backtrack_stack;
+    rift_regex_capture_groups_t *groups = rift_matcher_context_get_capture_groups(matcher->context);
+
+    for (size_t i = 0; groups && i < stack->num_groups; i++) {
+        rift_capture_groups_record(groups, i, NULL, stack->slots[2 * i], stack->slots[2 * i + 1]);
+    }
 }
 
 /**
- * @brief Execute a match attempt starting from the current position
+ * @brief Move from a state over one character
  *
- * This function attempts to match the pattern starting from the current position
- * in the input string. It returns true if a match is found, false otherwise.
+ * Every consuming transition in the epsilon closure of the state is tried.
+ * The closure comes from the table built at compile time, so epsilon chains
+ * of any length cost no recursion and are never walked twice, and states may
+ * have any number of transitions. The first transition accepting the
+ * character is taken. With a matcher, the targets of the other accepting
+ * transitions are pushed as backtrack points resuming at resume_pos.
  *
- * @param matcher The matcher
- * @param match Pointer to store match information (can be NULL)
- * @param anchored Whether the match should be anchored at the current position
- * @return true if a match was found, false otherwise
+ * @param automaton The automaton
+ * @param current_state Pointer to the state to move from, updated to the target state
+ * @param c The character to process
+ * @param matcher The matcher to push alternatives to (can be NULL)
+ * @param resume_pos Input position the alternatives resume at
+ * @return true if the character was accepted, false otherwise
  */
-bool
-execute_match(rift_regex_matcher_t *matcher, rift_regex_match_t *match, bool anchored)
+static bool
+step_character(const rift_regex_automaton_t *automaton, rift_regex_state_t **current_state, char c,
+               rift_regex_matcher_t *matcher, size_t resume_pos)
 {
-    if (!matcher || !matcher->context) {
+    if (!current_state || !*current_state) {
         return false;
     }
 
-    // Get the automaton from the pattern
-    rift_regex_automaton_t *automaton = rift_regex_pattern_get_automaton(matcher->pattern);
-    if (!automaton) {
+    const rift_epsilon_closures_t *closures = rift_automaton_get_epsilon_closures(automaton, NULL);
+    uint32_t current_index = rift_epsilon_closures_find_state(closures, *current_state);
+    size_t closure_size = 0;
+    const uint32_t *closure = rift_epsilon_closures_get(closures, current_index, &closure_size);
+    if (!closure) {
         return false;
     }
+    if (matcher && matcher->stats_enabled) {
+        matcher->stats.epsilon_expansions += closure_size;
+    }
 
-    // Reset the backtracker
-    rift_backtracker_reset(matcher->backtracker);
-
-    // Reset timeout status
-    matcher->timed_out = false;
-    matcher->start_time = clock();
-
-    // Save the starting position of the match
-    size_t start_pos = rift_matcher_context_get_position(matcher->context);
-    size_t input_length = rift_matcher_context_get_input_length(matcher->context);
-    const char *input = rift_matcher_context_get_input(matcher->context);
-
-    // Reset the automaton to its initial state
-    rift_automaton_reset(automaton);
-
-    // Process the input string through the automaton
-    size_t match_end = start_pos;
-    bool match_found = false;
-
-    // Only attempt matching if there's input left
-    if (start_pos < input_length) {
-        size_t pos = start_pos;
-
-        while (pos < input_length) {
-            // Check for timeout
-            if (check_timeout(matcher)) {
-                return false;
+    rift_regex_state_t *taken = NULL;
+    for (size_t k = 0; k < closure_size; k++) {
+        rift_regex_state_t *state = automaton->states[closure[k]];
+        size_t num_transitions = rift_state_get_transition_count(state);
+
+        for (size_t i = 0; i < num_transitions; i++) {
+            rift_regex_transition_t *transition = rift_state_get_transition(state, i);
+            const rift_transition_predicate_t *predicate =
+                transition ? rift_transition_get_predicate(transition) : NULL;
+            if (!predicate || !rift_transition_predicate_test(predicate, (uint8_t)c)) {
+                continue;
             }
 
-            // Try to process the current character
-            char current_char = input[pos];
-            if (!process_character(automaton, current_char, matcher, matcher->context)) {
-                // Character not accepted - try backtracking
-                if (anchored || rift_backtracker_is_empty(matcher->backtracker)) {
-                    break;
-                }
-
-                // Backtrack to a previous state
-                rift_regex_state_t *state;
-                size_t backtrack_pos;
-                size_t group_starts[100]; // Fixed size for simplicity
-                size_t group_ends[100];
-                size_t num_groups;
-
-                if (!rift_backtracker_pop(matcher->backtracker, &state, &backtrack_pos,
-                                          group_starts, group_ends, &num_groups)) {
-                    break;
-                }
-
-                // Restore the automaton state
-                rift_automaton_set_current_state(automaton, state);
-                pos = backtrack_pos;
-
-                // Set context position
-                rift_matcher_context_set_position(matcher->context, pos);
-
-                // Restore capture groups
-                rift_regex_capture_groups_t *groups =
-                    rift_matcher_context_get_capture_groups(matcher->context);
-
-                if (groups) {
-                    for (size_t i = 0; i < num_groups; i++) {
-                        rift_capture_groups_record(groups, i, NULL, group_starts[i], group_ends[i]);
-                    }
+            rift_regex_state_t *target = rift_automaton_transition_get_target(transition);
+            if (!taken) {
+                taken = target;
+                if (!matcher) {
+                    *current_state = taken;
+                    return true;
                 }
             } else {
-                // Character was processed successfully
-                pos++;
-
-                // If the automaton is in an accepting state, we have a match
-                if (rift_automaton_is_accepting(automaton)) {
-                    match_found = true;
-                    match_end = pos;
-
-                    // If we're using greedy matching (default), continue to try to match more
-                    if (!(matcher->options & RIFT_MATCHER_OPTION_LAZY)) {
-                        // Save this state as a backtrack point
-                        size_t num_groups = rift_regex_pattern_get_group_count(matcher->pattern);
-
-                        if (num_groups > 0) {
-                            // Get current group positions
-                            rift_regex_capture_groups_t *groups =
-                                rift_matcher_context_get_capture_groups(matcher->context);
-
-                            size_t current_group_starts[100]; // Fixed size for simplicity
-                            size_t current_group_ends[100];
-
-                            for (size_t i = 0; i < num_groups; i++) {
-                                rift_regex_capture_groups_t *group =
-                                    rift_capture_groups_get_by_index(groups, i);
-
-                                if (group) {
-                                    current_group_starts[i] = rift_capture_group_get_start(group);
-                                    current_group_ends[i] = rift_capture_group_get_end(group);
-                                } else {
-                                    current_group_starts[i] = (size_t)-1;
-                                    current_group_ends[i] = (size_t)-1;
-                                }
-                            }
-
-                            // Push the current state as a backtrack point
-                            rift_backtracker_push(
-                                matcher->backtracker, rift_automaton_get_current_state(automaton),
-                                pos, current_group_starts, current_group_ends, num_groups);
-                        } else {
-                            // No groups to track
-                            rift_backtracker_push(matcher->backtracker,
-                                                  rift_automaton_get_current_state(automaton), pos,
-                                                  NULL, NULL, 0);
-                        }
-                    } else {
-                        // Lazy matching - return the match as soon as we find it
-                        break;
-                    }
-                }
-
-                // Push potential alternative paths for backtracking
-                rift_regex_transition_t *transitions[100]; // Arbitrary limit
-                size_t num_transitions =
-                    rift_automaton_get_current_transitions(automaton, transitions, 100);
-
-                for (size_t i = 1; i < num_transitions; i++) { // Skip the first one
-                    // Get the target state of this transition
-                    rift_regex_state_t *target_state =
-                        rift_automaton_transition_get_target(transitions[i]);
-
-                    // Capture current group state for backtracking
-                    size_t num_groups = rift_regex_pattern_get_group_count(matcher->pattern);
-
-                    if (num_groups > 0) {
-                        // Get current group positions
-                        rift_regex_capture_groups_t *groups =
-                            rift_matcher_context_get_capture_groups(matcher->context);
-
-                        size_t current_group_starts[100]; // Fixed size for simplicity
-                        size_t current_group_ends[100];
-
-                        for (size_t j = 0; j < num_groups; j++) {
-                            rift_regex_capture_groups_t *group =
-                                rift_capture_groups_get_by_index(groups, j);
-
-                            if (group) {
-                                current_group_starts[j] = rift_capture_group_get_start(group);
-                                current_group_ends[j] = rift_capture_group_get_end(group);
-                            } else {
-                                current_group_starts[j] = (size_t)-1;
-                                current_group_ends[j] = (size_t)-1;
-                            }
-                        }
-
-                        // Push the alternative state as a backtrack point
-                        rift_backtracker_push(matcher->backtracker, target_state, pos,
-                                              current_group_starts, current_group_ends, num_groups);
-                    } else {
-                        // No groups to track
-                        rift_backtracker_push(matcher->backtracker, target_state, pos, NULL, NULL,
-                                              0);
-                    }
-                }
+                push_backtrack_point(matcher, target, resume_pos);
             }
         }
     }
 
-    // If we found a match, create the match result
-    if (match_found && match) {
-        rift_regex_match_result_t result =
-            *rift_matcher_context_create_match_result(matcher->context, start_pos, match_end);
-        match->start_pos = result.start_pos;
-        match->end_pos = result.end_pos;
-        match->groups = result.groups;
+    if (!taken) {
+        return false;
     }
-
-    return match_found;
+    *current_state = taken;
+    return true;
 }
 
 /**
- * @brief Find the next match in the input string
+ * @brief Process a single character from a state of the automaton
  *
- * @param matcher The matcher
- * @param match Pointer to store match information (can be NULL)
- * @return true if a match was found, false otherwise
+ * @param automaton The automaton
+ * @param current_state Pointer to the state to move from, updated to the target state
+ * @param c The character to process
+ * @param context The matcher context for capturing
+ * @return true if the character was accepted, false otherwise
  */
 bool
-rift_matcher_find_next(rift_regex_matcher_t *matcher, rift_regex_match_t *match)
+process_character(const rift_regex_automaton_t *automaton, rift_regex_state_t **current_state,
+                  char c, rift_regex_matcher_context_t *context)
 {
-    if (!matcher || !matcher->context) {
+    if (!step_character(automaton, current_state, c, NULL, 0)) {
         return false;
     }
 
-    size_t input_length = rift_matcher_context_get_input_length(matcher->context);
-    size_t start_pos = rift_matcher_context_get_position(matcher->context);
+    // Consume the character in the context
+    rift_matcher_context_advance(context);
+    return true;
+}
 
-    // Try to find a match starting from the current position
-    if (execute_match(matcher, match, false)) {
-        return true;
+/**
+ * @brief Make the allocator of a matcher the one in use on the thread
+ *
+ * @param matcher The matcher
+ * @return The allocator to restore with rift_allocator_use afterwards
+ */
+static const rift_allocator_t *
+matcher_allocator_enter(const rift_regex_matcher_t *matcher)
+{
+    const rift_allocator_t *outer = rift_allocator_current();
+    if (matcher->allocator) {
+        rift_allocator_use(matcher->allocator);
     }
+    return outer;
+}
 
-    // If we didn't find a match, and we're not anchored to the start, try from the next position
-    if (!(matcher->options & RIFT_MATCHER_OPTION_ANCHOR_START)) {
-        // Start from the current position + 1, unless we're at the end
-        if (start_pos < input_length) {
-            start_pos++;
-        } else {
-            return false; // No more input to search
-        }
-
-        // Set the new start position
-        rift_matcher_context_set_position(matcher->context, start_pos);
-
-        // Try to find a match from each position
-        while (start_pos < input_length) {
-            if (execute_match(matcher, match, false)) {
-                return true;
-            }
+/**
+ * @brief Get the byte at a position for the context of a lazy DFA search
+ *
+ * @param input The input
+ * @param input_length Length of the input
+ * @param pos The position, where SIZE_MAX stands for the one before the input
+ * @return The byte, or RIFT_LAZY_DFA_TEXT_EDGE outside the input
+ */
+static inline int
+context_byte(const char *input, size_t input_length, size_t pos)
+{
+    return pos < input_length ? (uint8_t)input[pos] : RIFT_LAZY_DFA_TEXT_EDGE;
+}
 
-            // Move to the next position
-            start_pos++;
-            rift_matcher_context_set_position(matcher->context, start_pos);
+/**
+ * @brief Get the lazy DFA of a matcher if the pattern can run on it
+ *
+ * The lazy DFA reports match bounds only, so it is used for patterns without
+ * capture groups, either on request, when the pattern's settings prefer DFAs
+ * or when the compile-time analysis found the pattern EDA or IDA. Searches that
+ * need no captures, in rift_matcher_is_match() and rift_matcher_count(),
+ * always use it, unless the pattern has backreferences. Patterns with
+ * lookarounds go to the Pike VM, which checks them at each position; anchors
+ * and word boundaries are checked by the DFA, given the bytes around the
+ * part of the input it reads. It is never used under
+ * RIFT_MATCHER_OPTION_PIKE_VM or RIFT_MATCHER_OPTION_BACKTRACK.
+ *
+ * @param matcher The matcher
+ * @param automaton The automaton of the pattern
+ * @return The lazy DFA or NULL to use the backtracking matcher
+ */
+static rift_lazy_dfa_t *
+get_lazy_dfa(rift_regex_matcher_t *matcher, rift_regex_automaton_t *automaton)
+{
+    bool bounds_only = matcher->bounds_only;
+    if (!RIFT_MATCHER_ENGINE_LAZY_DFA ||
+        (!bounds_only && rift_regex_pattern_get_group_count(matcher->pattern) > 0) ||
+        rift_automaton_has_lookarounds(automaton) ||
+        (matcher->options & (RIFT_MATCHER_OPTION_PIKE_VM | RIFT_MATCHER_OPTION_BACKTRACK))) {
+        return NULL;
+    }
 
-            // Check for timeout
-            if (check_timeout(matcher)) {
-                return false;
-            }
-        }
+    // Dangerous patterns always take the linear-time path when it is available
+    const rift_ambiguity_verdict_t *verdict = rift_regex_pattern_get_ambiguity(matcher->pattern);
+    if (bounds_only && verdict->has_backreference) {
+        return NULL;
+    }
+    if (!bounds_only && !(matcher->options & RIFT_MATCHER_OPTION_LAZY_DFA) &&
+        !rift_ambiguity_is_dangerous(verdict) && !matcher->config.use_dfa_when_possible) {
+        return NULL;
     }
 
-    return false;
+    // A pattern the budget cannot hold a state cache for goes to the Pike VM
+    if (!matcher->lazy_dfa && !matcher->lazy_dfa_over_budget) {
+        rift_regex_error_t error = {0};
+        const rift_allocator_t *outer = matcher_allocator_enter(matcher);
+        matcher->lazy_dfa =
+            rift_lazy_dfa_create_with_budget(automaton, matcher->applied_budget, &error);
+        rift_allocator_use(outer);
+        matcher->lazy_dfa_over_budget = error.code == RIFT_REGEX_ERROR_LIMIT_EXCEEDED;
+    }
+    return matcher->lazy_dfa;
 }
 
 /**
- * @brief Check if the entire input string matches the pattern
+ * @brief Get the bit-parallel NFA of a matcher if the pattern is short enough
+ *
+ * Capture-free patterns the lazy DFA is not used for, because the DFA is
+ * turned off in the configuration, still need no threads when their NFA has
+ * at most RIFT_BIT_PARALLEL_MAX_POSITIONS byte edges: the active edges fit
+ * in a word and each byte updates them with a few masks. It is built once
+ * per matcher and left out under the options and budgets that keep the lazy
+ * DFA out, or when the pattern's engine plan found it does not fit.
  *
  * @param matcher The matcher
- * @param match Pointer to store match information (can be NULL)
- * @return true if the entire string matches, false otherwise
+ * @param automaton The automaton of the pattern
+ * @return The bit-parallel NFA or NULL to use the other engines
  */
-bool
-rift_matcher_matches(rift_regex_matcher_t *matcher, rift_regex_match_t *match)
+static rift_bit_parallel_t *
+get_bit_parallel(rift_regex_matcher_t *matcher, rift_regex_automaton_t *automaton)
 {
-    if (!matcher || !matcher->context) {
-        return false;
+    if (!RIFT_MATCHER_ENGINE_BIT_PARALLEL ||
+        rift_regex_pattern_get_group_count(matcher->pattern) > 0 ||
+        rift_automaton_has_lookarounds(automaton) ||
+        (matcher->options & (RIFT_MATCHER_OPTION_PIKE_VM | RIFT_MATCHER_OPTION_BACKTRACK |
+                             RIFT_MATCHER_OPTION_LAZY_DFA)) ||
+        matcher->lazy_dfa_over_budget) {
+        return NULL;
     }
-
-    // Reset the matcher to the beginning of the input
-    rift_matcher_context_set_position(matcher->context, 0);
-
-    // Try to find a match starting from the beginning
-    rift_regex_match_t local_match;
-    if (!execute_match(matcher, &local_match, true)) {
-        return false;
+    if (matcher->bit_parallel_ready) {
+        return matcher->bit_parallel;
     }
+    matcher->bit_parallel_ready = true;
 
-    // Check if the match covers the entire input
-    size_t input_length = rift_matcher_context_get_input_length(matcher->context);
-
-    if (local_match.end_pos == input_length) {
-        if (match) {
-            *match = local_match;
-        }
-        return true;
+    const rift_ambiguity_verdict_t *verdict = rift_regex_pattern_get_ambiguity(matcher->pattern);
+    if ((verdict && verdict->has_backreference) ||
+        !rift_engine_plan_allows(rift_regex_pattern_get_engine_plan(matcher->pattern),
+                                 RIFT_MATCH_ENGINE_BIT_PARALLEL)) {
+        return NULL;
     }
 
-    return false;
+    const rift_allocator_t *outer = matcher_allocator_enter(matcher);
+    matcher->bit_parallel = rift_bit_parallel_create(automaton, NULL);
+    rift_allocator_use(outer);
+    return matcher->bit_parallel;
 }
 
 /**
- * @brief Find all matches in the input string
+ * @brief Get the one-pass DFA of a matcher if the pattern is one-pass
+ *
+ * Patterns with captures in which every byte leaves one way to continue,
+ * such as key=value or date extraction, fill their groups in one scan
+ * instead of running Pike VM threads. The check runs once per matcher and
+ * is skipped when an option forces the Pike VM or the backtracking matcher,
+ * or when the pattern's engine plan already found the pattern not one-pass.
+ * A memory budget too small for the lazy DFA's state cache leaves the
+ * pattern on the Pike VM, as the one-pass tables would not fit either.
  *
  * @param matcher The matcher
- * @param matches Array to store match information
- * @param max_matches Maximum number of matches to find
- * @param num_matches Pointer to store the number of matches found
- * @return true if at least one match was found, false otherwise
+ * @param automaton The automaton of the pattern
+ * @return The one-pass DFA or NULL to use the Pike VM
+ */
+static rift_one_pass_t *
+get_one_pass(rift_regex_matcher_t *matcher, rift_regex_automaton_t *automaton)
+{
+    if (!RIFT_MATCHER_ENGINE_ONE_PASS ||
+        (matcher->options & (RIFT_MATCHER_OPTION_PIKE_VM | RIFT_MATCHER_OPTION_BACKTRACK)) ||
+        matcher->lazy_dfa_over_budget) {
+        return NULL;
+    }
+    if (matcher->one_pass_ready) {
+        return matcher->one_pass;
+    }
+    matcher->one_pass_ready = true;
+
+    const rift_ambiguity_verdict_t *verdict = rift_regex_pattern_get_ambiguity(matcher->pattern);
+    if ((verdict && verdict->has_backreference) ||
+        !rift_engine_plan_allows(rift_regex_pattern_get_engine_plan(matcher->pattern),
+                                 RIFT_MATCH_ENGINE_ONE_PASS)) {
+        return NULL;
+    }
+
+    const rift_allocator_t *outer = matcher_allocator_enter(matcher);
+    rift_one_pass_t *one_pass = rift_one_pass_create(automaton, NULL);
+    size_t *slots = NULL;
+    if (one_pass) {
+        slots = (size_t *)rift_malloc(rift_one_pass_get_slot_count(one_pass) * sizeof(size_t));
+        if (!slots) {
+            rift_one_pass_free(one_pass);
+            one_pass = NULL;
+        }
+    }
+    rift_allocator_use(outer);
+
+    matcher->one_pass = one_pass;
+    matcher->one_pass_slots = slots;
+    return one_pass;
+}
+
+/**
+ * @brief Get the tagged DFA of a matcher if the pattern's DFA is small enough
+ *
+ * Patterns with captures that are not one-pass still fill their groups in
+ * one deterministic scan when their tagged DFA stays within the state and
+ * register limits. Like the one-pass DFA, it is tried once per matcher and
+ * left out under the options and budgets that keep the one-pass DFA out.
+ *
+ * @param matcher The matcher
+ * @param automaton The automaton of the pattern
+ * @return The tagged DFA or NULL to use the Pike VM
+ */
+static rift_tdfa_t *
+get_tdfa(rift_regex_matcher_t *matcher, rift_regex_automaton_t *automaton)
+{
+    if (!RIFT_MATCHER_ENGINE_TDFA ||
+        (matcher->options & (RIFT_MATCHER_OPTION_PIKE_VM | RIFT_MATCHER_OPTION_BACKTRACK)) ||
+        matcher->lazy_dfa_over_budget) {
+        return NULL;
+    }
+    if (matcher->tdfa_ready) {
+        return matcher->tdfa;
+    }
+    matcher->tdfa_ready = true;
+
+    const rift_ambiguity_verdict_t *verdict = rift_regex_pattern_get_ambiguity(matcher->pattern);
+    if ((verdict && verdict->has_backreference) ||
+        !rift_engine_plan_allows(rift_regex_pattern_get_engine_plan(matcher->pattern),
+                                 RIFT_MATCH_ENGINE_TDFA)) {
+        return NULL;
+    }
+
+    const rift_allocator_t *outer = matcher_allocator_enter(matcher);
+    rift_tdfa_t *tdfa = rift_tdfa_create(automaton, NULL);
+    size_t *slots = NULL;
+    if (tdfa) {
+        slots = (size_t *)rift_malloc(rift_tdfa_get_slot_count(tdfa) * sizeof(size_t));
+        if (!slots) {
+            rift_tdfa_free(tdfa);
+            tdfa = NULL;
+        }
+    }
+    rift_allocator_use(outer);
+
+    matcher->tdfa = tdfa;
+    matcher->tdfa_slots = slots;
+    return tdfa;
+}
+
+/**
+ * @brief Build the Pike VM of a matcher if the pattern can run on it
+ *
+ * The Pike VM handles everything but backreferences in linear time. It is
+ * built once and kept, also for backtracking attempts that switch to it.
+ *
+ * @param matcher The matcher
+ * @param automaton The automaton of the pattern
+ * @return The Pike VM, or NULL for patterns with backreferences
+ */
+static rift_pike_vm_t *
+build_pike_vm(rift_regex_matcher_t *matcher, rift_regex_automaton_t *automaton)
+{
+    if (!RIFT_MATCHER_ENGINE_PIKE_VM) {
+        return NULL;
+    }
+    if (matcher->pike_vm) {
+        return matcher->pike_vm;
+    }
+
+    const rift_ambiguity_verdict_t *verdict = rift_regex_pattern_get_ambiguity(matcher->pattern);
+    if (verdict && verdict->has_backreference) {
+        return NULL;
+    }
+
+    const rift_allocator_t *outer = matcher_allocator_enter(matcher);
+    rift_pike_vm_t *pike_vm = rift_pike_vm_create(automaton, NULL);
+    if (pike_vm) {
+        matcher->pike_slots =
+            (size_t *)rift_malloc(rift_pike_vm_get_slot_count(pike_vm) * sizeof(size_t));
+    }
+    rift_allocator_use(outer);
+    if (!pike_vm) {
+        return NULL;
+    }
+
+    if (!matcher->pike_slots) {
+        rift_pike_vm_free(pike_vm);
+        return NULL;
+    }
+
+    matcher->pike_vm = pike_vm;
+    return pike_vm;
+}
+
+/**
+ * @brief Get the Pike VM of a matcher if the pattern can run on it
+ *
+ * Only patterns with backreferences fall back to the backtracking matcher,
+ * unless RIFT_MATCHER_OPTION_BACKTRACK forces it.
+ *
+ * @param matcher The matcher
+ * @param automaton The automaton of the pattern
+ * @return The Pike VM or NULL to use the backtracking matcher
+ */
+static rift_pike_vm_t *
+get_pike_vm(rift_regex_matcher_t *matcher, rift_regex_automaton_t *automaton)
+{
+    if (matcher->options & RIFT_MATCHER_OPTION_BACKTRACK) {
+        return NULL;
+    }
+    return build_pike_vm(matcher, automaton);
+}
+
+/**
+ * @brief Get the literal prefilter of a matcher
+ *
+ * The prefilter is built from the pattern's AST and automaton on the first
+ * search and kept only if it can rule out start positions. Deserialized
+ * patterns have no AST and bring the prefilter they were saved with.
+ *
+ * @param matcher The matcher
+ * @return The prefilter or NULL to try every position
+ */
+static rift_prefilter_t *
+get_prefilter(rift_regex_matcher_t *matcher)
+{
+    if (matcher->prefilter_ready) {
+        return matcher->prefilter;
+    }
+    matcher->prefilter_ready = true;
+
+    const rift_regex_ast_t *ast = rift_regex_pattern_get_ast(matcher->pattern);
+    rift_regex_automaton_t *automaton = rift_regex_pattern_get_automaton(matcher->pattern);
+    const rift_prefilter_t *loaded = rift_regex_pattern_get_prefilter(matcher->pattern);
+    if ((!ast && !loaded) || !automaton) {
+        return NULL;
+    }
+
+    const rift_allocator_t *outer = matcher_allocator_enter(matcher);
+    rift_prefilter_t *prefilter = NULL;
+    if (!ast) {
+        prefilter = (rift_prefilter_t *)rift_malloc(sizeof(rift_prefilter_t));
+        if (prefilter) {
+            *prefilter = *loaded;
+        }
+    } else {
+        prefilter = rift_prefilter_create(ast, NULL);
+        if (prefilter && (!rift_prefilter_analyze_automaton(prefilter, automaton, NULL) ||
+                          !rift_prefilter_can_skip(prefilter))) {
+            rift_prefilter_free(prefilter);
+            prefilter = NULL;
+        }
+    }
+    rift_allocator_use(outer);
+
+    matcher->prefilter = prefilter;
+    return prefilter;
+}
+
+/**
+ * @brief Get the DFAs that locate match starts without trying every position
+ *
+ * An unanchored lazy DFA finds where the earliest match ends and the lazy DFA
+ * of the reversed pattern, read backward from there, where it starts. They
+ * are built for patterns that run on the lazy DFA and cannot match the empty
+ * string, and not under a memory budget, which is sized for one lazy DFA.
+ * Whether an asserting pattern matches the empty string depends on where,
+ * so those must consume a byte in every match.
+ *
+ * @param matcher The matcher
+ * @return true if both DFAs are ready, false to try start positions one by one
+ */
+static bool
+get_reverse_search(rift_regex_matcher_t *matcher)
+{
+    // Searches reporting captures find them from the start position on another engine
+    refresh_limits(matcher);
+    if (!matcher->bounds_only && rift_regex_pattern_get_group_count(matcher->pattern) > 0) {
+        return false;
+    }
+    if (matcher->reverse_search_ready) {
+        return matcher->reverse_dfa != NULL;
+    }
+
+    rift_regex_automaton_t *automaton = rift_regex_pattern_get_automaton(matcher->pattern);
+    rift_lazy_dfa_t *lazy_dfa = automaton ? get_lazy_dfa(matcher, automaton) : NULL;
+    if (!lazy_dfa) {
+        return false;
+    }
+
+    matcher->reverse_search_ready = true;
+    rift_lazy_dfa_set_context(lazy_dfa, RIFT_LAZY_DFA_TEXT_EDGE, RIFT_LAZY_DFA_TEXT_EDGE);
+    const rift_match_length_bounds_t *bounds =
+        rift_regex_pattern_get_match_length(matcher->pattern);
+    if (matcher->applied_budget != 0 || rift_lazy_dfa_matches(lazy_dfa, NULL, 0) ||
+        (lazy_dfa->has_assertions && bounds->min == 0)) {
+        return false;
+    }
+
+    const rift_allocator_t *outer = matcher_allocator_enter(matcher);
+    rift_regex_automaton_t *reversed = rift_automaton_reverse(automaton, NULL);
+    if (reversed) {
+        matcher->forward_dfa = rift_lazy_dfa_create_unanchored(automaton, 0, NULL);
+        matcher->reverse_dfa = rift_lazy_dfa_create(reversed, 0, NULL);
+        rift_automaton_free(reversed);
+    }
+    if (!matcher->forward_dfa || !matcher->reverse_dfa) {
+        rift_lazy_dfa_free(matcher->forward_dfa);
+        rift_lazy_dfa_free(matcher->reverse_dfa);
+        matcher->forward_dfa = NULL;
+        matcher->reverse_dfa = NULL;
+    }
+    rift_allocator_use(outer);
+    return matcher->reverse_dfa != NULL;
+}
+
+/**
+ * @brief Find the leftmost start of a match with the forward and reverse DFAs
+ *
+ * The forward DFA finds the earliest end of a match starting before the
+ * limit, and the reverse DFA the leftmost start of a match ending there. A
+ * match starting even earlier may still end later, so the search repeats with
+ * that start as the limit until no match is left before it. The last forward
+ * pass usually dies a few bytes past the limit; when the pattern's matches
+ * are at most max bytes long, it never reads more than max - 1 bytes past it,
+ * and the reverse DFA never reads more than max bytes back from a match end.
+ *
+ * @param matcher The matcher, with the DFAs of get_reverse_search()
+ * @param input The input
+ * @param input_length Length of the input
+ * @param start_pos Position the search starts at
+ * @param start_limit Position the match must start before
+ * @param found Pointer to store whether a match starts before start_limit
+ * @param match_start Pointer to store the leftmost start
+ * @return true if successful, false if the reverse DFA failed
+ */
+static bool
+find_match_start(rift_regex_matcher_t *matcher, const char *input, size_t input_length,
+                 size_t start_pos, size_t start_limit, bool *found, size_t *match_start)
+{
+    const char *subject = input + start_pos;
+    size_t subject_length = input_length - start_pos;
+    size_t limit = start_limit > start_pos ? start_limit - start_pos : 0;
+    const rift_match_length_bounds_t *bounds =
+        rift_regex_pattern_get_match_length(matcher->pattern);
+    size_t max_length = bounds->max;
+    size_t end = 0;
+
+    *found = false;
+    while (limit > 0) {
+        // A match starting before the limit ends at most max_length - 1 bytes past it
+        size_t scan_length = subject_length;
+        if (max_length < subject_length && limit - 1 < subject_length - max_length) {
+            scan_length = limit - 1 + max_length;
+        }
+        rift_lazy_dfa_set_context(matcher->forward_dfa,
+                                  context_byte(input, input_length, start_pos - 1),
+                                  context_byte(input, input_length, start_pos + scan_length));
+        if (!rift_lazy_dfa_find_earliest_end(matcher->forward_dfa, subject, scan_length, limit,
+                                             &end)) {
+            break;
+        }
+
+        // The pattern cannot match the empty string, so the start moves left every round
+        size_t window = end < max_length ? end : max_length;
+        size_t length = 0;
+        rift_lazy_dfa_set_context(matcher->reverse_dfa,
+                                  context_byte(input, input_length, start_pos + end),
+                                  context_byte(input, input_length, start_pos + end - window - 1));
+        if (!rift_lazy_dfa_match_suffix(matcher->reverse_dfa, subject + end - window, window,
+                                        false, &length) ||
+            length == 0 || end - length >= limit) {
+            return false;
+        }
+
+        limit = end - length;
+        *found = true;
+    }
+
+    *match_start = start_pos + limit;
+    return true;
+}
+
+/**
+ * @brief Find an occurrence of one of the prefilter's literals
+ *
+ * @param prefilter The prefilter, for its case handling
+ * @param input The input
+ * @param input_length Length of the input
+ * @param start First position to consider
+ * @param literal The literal
+ * @return Position of the occurrence or RIFT_PREFILTER_NO_CANDIDATE
+ */
+static size_t
+find_prefilter_literal(const rift_prefilter_t *prefilter, const char *input, size_t input_length,
+                       size_t start, const rift_prefilter_literal_t *literal)
+{
+    if (prefilter->caseless) {
+        return rift_prefilter_find_literal_caseless(input, input_length, start, literal->bytes,
+                                                    literal->length);
+    }
+    return rift_prefilter_find_literal(input, input_length, start, literal->bytes,
+                                       literal->length);
+}
+
+/**
+ * @brief Find the leftmost match start from the occurrences of the suffix literal
+ *
+ * The plan chose this only when no match contains the suffix except at its
+ * end. A match starting at or before an occurrence then ends at that
+ * occurrence, so the first occurrence a match ends at holds the leftmost
+ * match, whose start the reverse DFA finds reading back from there. Matches
+ * ending at an occurrence start after the previous one, which bounds each
+ * backward read and keeps the whole search linear.
+ *
+ * @param matcher The matcher, with the DFAs of get_reverse_search()
+ * @param prefilter The prefilter, with a suffix literal
+ * @param input The input
+ * @param input_length Length of the input
+ * @param start_pos Position the search starts at
+ * @param start_limit Position the match must start before
+ * @param found Pointer to store whether a match starts before start_limit
+ * @param match_start Pointer to store the leftmost start
+ */
+static void
+find_suffix_match_start(rift_regex_matcher_t *matcher, const rift_prefilter_t *prefilter,
+                        const char *input, size_t input_length, size_t start_pos,
+                        size_t start_limit, bool *found, size_t *match_start)
+{
+    const rift_prefilter_literal_t *suffix = &prefilter->suffix;
+    const rift_match_length_bounds_t *bounds =
+        rift_regex_pattern_get_match_length(matcher->pattern);
+    size_t max_length = bounds->max;
+    size_t lower = start_pos;
+
+    *found = false;
+    while (lower < start_limit) {
+        size_t pos = find_prefilter_literal(prefilter, input, input_length, lower, suffix);
+        if (pos == RIFT_PREFILTER_NO_CANDIDATE) {
+            return;
+        }
+
+        size_t end = pos + suffix->length;
+        size_t window_start = end - lower > max_length ? end - max_length : lower;
+        size_t length = 0;
+        rift_lazy_dfa_set_context(matcher->reverse_dfa, context_byte(input, input_length, end),
+                                  context_byte(input, input_length, window_start - 1));
+        if (rift_lazy_dfa_match_suffix(matcher->reverse_dfa, input + window_start,
+                                       end - window_start, false, &length) &&
+            length > 0) {
+            // Matches ending at later occurrences start after this one, so no earlier
+            *found = end - length < start_limit;
+            *match_start = end - length;
+            return;
+        }
+        lower = pos + 1;
+    }
+}
+
+/**
+ * @brief Find the leftmost match start by the search strategy of the pattern
+ *
+ * An inner literal moves the start of the forward and reverse passes up to
+ * where a match containing its first occurrence could start, which for
+ * patterns of unbounded length only helps when it does not occur at all.
+ *
+ * @param matcher The matcher, with the DFAs of get_reverse_search()
+ * @param prefilter The prefilter (can be NULL)
+ * @param input The input
+ * @param input_length Length of the input
+ * @param start_pos Position the search starts at
+ * @param start_limit Position the match must start before
+ * @param found Pointer to store whether a match starts before start_limit
+ * @param match_start Pointer to store the leftmost start
+ * @return true if successful, false if the reverse DFA failed
+ */
+static bool
+locate_match_start(rift_regex_matcher_t *matcher, const rift_prefilter_t *prefilter,
+                   const char *input, size_t input_length, size_t start_pos, size_t start_limit,
+                   bool *found, size_t *match_start)
+{
+    const rift_engine_plan_t *plan = rift_regex_pattern_get_engine_plan(matcher->pattern);
+    if (prefilter && plan->search == RIFT_SEARCH_REVERSE_SUFFIX && prefilter->suffix.length > 0) {
+        find_suffix_match_start(matcher, prefilter, input, input_length, start_pos, start_limit,
+                                found, match_start);
+        return true;
+    }
+
+    if (prefilter && plan->search == RIFT_SEARCH_INNER_LITERAL && prefilter->num_required > 0) {
+        // Every match ends at or after the end of the first occurrence of some literal
+        size_t first_end = SIZE_MAX;
+        for (size_t i = 0; i < prefilter->num_required; i++) {
+            const rift_prefilter_literal_t *literal = &prefilter->required[i];
+            size_t pos = find_prefilter_literal(prefilter, input, input_length, start_pos, literal);
+            if (pos != RIFT_PREFILTER_NO_CANDIDATE && pos + literal->length < first_end) {
+                first_end = pos + literal->length;
+            }
+        }
+        if (first_end == SIZE_MAX) {
+            *found = false;
+            return true;
+        }
+
+        const rift_match_length_bounds_t *bounds =
+            rift_regex_pattern_get_match_length(matcher->pattern);
+        if (bounds->max < first_end - start_pos) {
+            start_pos = first_end - bounds->max;
+        }
+    }
+    return find_match_start(matcher, input, input_length, start_pos, start_limit, found,
+                            match_start);
+}
+
+/**
+ * @brief Record the groups of a match found by a slot-filling engine
+ *
+ * @param matcher The matcher
+ * @param slots The slots of the match, two for the whole match and two per group
+ * @param num_groups Number of capture groups
+ */
+static void
+record_slots(rift_regex_matcher_t *matcher, const size_t *slots, size_t num_groups)
+{
+    rift_regex_capture_groups_t *groups = rift_matcher_context_get_capture_groups(matcher->context);
+    if (groups) {
+        for (size_t i = 0; i < num_groups; i++) {
+            rift_capture_groups_record(groups, i, NULL, slots[2 * i + 2], slots[2 * i + 3]);
+        }
+    }
+}
+
+/**
+ * @brief Run the one-pass DFA at the current position and record the captures
+ *
+ * @param matcher The matcher
+ * @param one_pass The one-pass DFA of the pattern
+ * @param start_pos Position where the match must start
+ * @param match_end Pointer to store the end of the match
+ * @return true if a non-empty match was found, false otherwise
+ */
+static bool
+execute_one_pass(rift_regex_matcher_t *matcher, rift_one_pass_t *one_pass, size_t start_pos,
+                 size_t *match_end)
+{
+    const char *input = rift_matcher_context_get_input(matcher->context);
+    size_t input_length = rift_matcher_context_get_input_length(matcher->context);
+    bool earliest = (matcher->options & RIFT_MATCHER_OPTION_LAZY) != 0;
+    size_t *slots = matcher->one_pass_slots;
+
+    bool found = rift_one_pass_search(one_pass, input, input_length, start_pos, earliest, slots);
+
+    // Empty matches are not reported, so use the longest match past an empty one
+    if (found && slots[1] == start_pos && earliest) {
+        found = rift_one_pass_search(one_pass, input, input_length, start_pos, false, slots);
+    }
+
+    if (!found || slots[1] == start_pos) {
+        return false;
+    }
+
+    record_slots(matcher, slots, rift_one_pass_get_group_count(one_pass));
+    *match_end = slots[1];
+    return true;
+}
+
+/**
+ * @brief Run the tagged DFA at the current position and record the captures
+ *
+ * @param matcher The matcher
+ * @param tdfa The tagged DFA of the pattern
+ * @param start_pos Position where the match must start
+ * @param match_end Pointer to store the end of the match
+ * @return true if a non-empty match was found, false otherwise
+ */
+static bool
+execute_tdfa(rift_regex_matcher_t *matcher, rift_tdfa_t *tdfa, size_t start_pos,
+             size_t *match_end)
+{
+    const char *input = rift_matcher_context_get_input(matcher->context);
+    size_t input_length = rift_matcher_context_get_input_length(matcher->context);
+    bool earliest = (matcher->options & RIFT_MATCHER_OPTION_LAZY) != 0;
+    size_t *slots = matcher->tdfa_slots;
+
+    bool found = rift_tdfa_search(tdfa, input, input_length, start_pos, earliest, slots);
+
+    // Empty matches are not reported, so use the longest match past an empty one
+    if (found && slots[1] == start_pos && earliest) {
+        found = rift_tdfa_search(tdfa, input, input_length, start_pos, false, slots);
+    }
+
+    if (!found || slots[1] == start_pos) {
+        return false;
+    }
+
+    record_slots(matcher, slots, rift_tdfa_get_group_count(tdfa));
+    *match_end = slots[1];
+    return true;
+}
+
+/**
+ * @brief Run the Pike VM at the current position and record the captures
+ *
+ * @param matcher The matcher
+ * @param pike_vm The Pike VM of the pattern
+ * @param start_pos Position where the match must start
+ * @param match_end Pointer to store the end of the match
+ * @return true if a non-empty match was found, false otherwise
+ */
+static bool
+execute_pike_vm(rift_regex_matcher_t *matcher, rift_pike_vm_t *pike_vm, size_t start_pos,
+                size_t *match_end)
+{
+    const char *input = rift_matcher_context_get_input(matcher->context);
+    size_t input_length = rift_matcher_context_get_input_length(matcher->context);
+    bool earliest = (matcher->options & RIFT_MATCHER_OPTION_LAZY) != 0;
+    size_t *slots = matcher->pike_slots;
+
+    bool found = rift_pike_vm_search(pike_vm, input, input_length, start_pos, true, earliest, slots);
+
+    // Empty matches are not reported, so use the longest match past an empty one
+    if (found && slots[1] == start_pos && earliest) {
+        found = rift_pike_vm_search(pike_vm, input, input_length, start_pos, true, false, slots);
+    }
+
+    if (!found || slots[1] == start_pos) {
+        return false;
+    }
+
+    record_slots(matcher, slots, rift_pike_vm_get_group_count(pike_vm));
+    *match_end = slots[1];
+    return true;
+}
+
+/**
+ * @brief Record a match attempt in the telemetry of the running search
+ *
+ * @param matcher The matcher
+ * @param engine The engine that ran the attempt
+ * @param steps The steps it ran
+ * @param pops The backtrack points it resumed
+ */
+static void
+record_attempt(rift_regex_matcher_t *matcher, rift_match_engine_t engine, uint64_t steps,
+               uint64_t pops)
+{
+    matcher->last_engine = engine;
+    matcher->step_count += steps;
+    if (!matcher->stats_enabled) {
+        return;
+    }
+
+    matcher->stats.attempts++;
+    matcher->stats.engine_attempts[engine]++;
+    matcher->stats.engine = engine;
+    matcher->stats.steps += steps;
+    matcher->stats.backtrack_pops += pops;
+}
+
+/**
+ * @brief Start recording the telemetry of a search
+ *
+ * @param matcher The matcher
+ */
+static void
+begin_search_stats(rift_regex_matcher_t *matcher)
+{
+    matcher->last_engine = RIFT_MATCH_ENGINE_NONE;
+    if (matcher->metrics) {
+        matcher->metrics_start_ns = rift_matcher_monotonic_ns();
+    }
+    if (matcher->stats_enabled) {
+        rift_match_stats_reset(&matcher->stats);
+        matcher->stats.searches = 1;
+    }
+}
+
+/**
+ * @brief Add the telemetry of a finished search to the totals
+ *
+ * @param matcher The matcher
+ * @param found Whether the search found a match
+ */
+static void
+end_search_stats(rift_regex_matcher_t *matcher, bool found)
+{
+    if (matcher->metrics) {
+        rift_metrics_record(matcher->metrics, matcher->metrics_pattern_id, matcher->last_engine,
+                            found, matcher->timed_out,
+                            rift_matcher_monotonic_ns() - matcher->metrics_start_ns);
+    }
+    if (!matcher->stats_enabled) {
+        return;
+    }
+
+    rift_match_stats_merge(&matcher->stats_total, &matcher->stats);
+    if (matcher->limit_registry) {
+        rift_backtrack_limit_registry_record_stats(matcher->limit_registry,
+                                                   matcher->limit_pattern_id, &matcher->stats);
+    }
+}
+
+/**
+ * @brief Execute a match attempt starting from the current position
+ *
+ * This function attempts to match the pattern starting from the current position
+ * in the input string. It returns true if a match is found, false otherwise.
+ *
+ * @param matcher The matcher
+ * @param match Pointer to store match information (can be NULL)
+ * @param anchored Whether the match should be anchored at the current position
+ * @return true if a match was found, false otherwise
+ */
+bool
+execute_match(rift_regex_matcher_t *matcher, rift_regex_match_t *match, bool anchored)
+{
+    if (!matcher || !matcher->context) {
+        return false;
+    }
+
+    // Get the automaton from the pattern
+    rift_regex_automaton_t *automaton = rift_regex_pattern_get_automaton(matcher->pattern);
+    if (!automaton) {
+        return false;
+    }
+
+    // Reset the backtracker
+    rift_backtrack_stack_reset(matcher->backtrack_stack);
+
+    // Pick up registry changes, then reset timeout status and compute the deadline
+    refresh_limits(matcher);
+    start_timeout(matcher);
+
+    // Save the starting position of the match
+    size_t start_pos = rift_matcher_context_get_position(matcher->context);
+    size_t input_length = rift_matcher_context_get_input_length(matcher->context);
+    const char *input = rift_matcher_context_get_input(matcher->context);
+
+    // Process the input string through the automaton, which is never written to
+    size_t match_end = start_pos;
+    bool match_found = false;
+    rift_regex_state_t *current_state = NULL;
+
+    // Run capture-free patterns on the lazy DFA or, when short, the bit-parallel NFA, one-pass
+    // patterns on the one-pass DFA, the rest on the tagged DFA when it is small enough and on
+    // the Pike VM otherwise
+    rift_lazy_dfa_t *lazy_dfa = get_lazy_dfa(matcher, automaton);
+    rift_bit_parallel_t *bit_parallel = lazy_dfa ? NULL : get_bit_parallel(matcher, automaton);
+    rift_one_pass_t *one_pass = lazy_dfa || bit_parallel ? NULL : get_one_pass(matcher, automaton);
+    rift_tdfa_t *tdfa = lazy_dfa || bit_parallel || one_pass ? NULL : get_tdfa(matcher, automaton);
+    rift_pike_vm_t *pike_vm =
+        lazy_dfa || bit_parallel || one_pass || tdfa ? NULL : get_pike_vm(matcher, automaton);
+    if (!lazy_dfa && matcher->lazy_dfa_over_budget) {
+        RIFT_PROBE3(bailout, matcher->pattern, RIFT_PROBE_BAILOUT_BUDGET, start_pos);
+        if (matcher->stats_enabled) {
+            matcher->stats.budget_fallbacks++;
+        }
+    }
+    rift_match_engine_t engine = lazy_dfa       ? RIFT_MATCH_ENGINE_LAZY_DFA
+                                 : bit_parallel ? RIFT_MATCH_ENGINE_BIT_PARALLEL
+                                 : one_pass     ? RIFT_MATCH_ENGINE_ONE_PASS
+                                 : tdfa         ? RIFT_MATCH_ENGINE_TDFA
+                                 : pike_vm      ? RIFT_MATCH_ENGINE_PIKE_VM
+                                                : RIFT_MATCH_ENGINE_BACKTRACKER;
+    RIFT_PROBE3(engine__select, matcher->pattern, (int)engine, start_pos);
+    uint64_t steps = 0;
+    uint64_t pops = 0;
+    if (lazy_dfa) {
+        if (start_pos < input_length) {
+            const char *subject = input + start_pos;
+            size_t subject_length = input_length - start_pos;
+            bool earliest = (matcher->options & RIFT_MATCHER_OPTION_LAZY) != 0;
+            size_t length = 0;
+
+            rift_lazy_dfa_set_context(lazy_dfa, context_byte(input, input_length, start_pos - 1),
+                                      RIFT_LAZY_DFA_TEXT_EDGE);
+            match_found =
+                rift_lazy_dfa_match_prefix(lazy_dfa, subject, subject_length, earliest, &length);
+
+            // Empty matches are not reported, so use the longest match past an empty one
+            if (match_found && length == 0 && earliest) {
+                match_found =
+                    rift_lazy_dfa_match_prefix(lazy_dfa, subject, subject_length, false, &length);
+            }
+
+            match_found = match_found && length > 0;
+            match_end = start_pos + length;
+            steps = match_found ? length : subject_length;
+        }
+    } else if (bit_parallel) {
+        if (start_pos < input_length) {
+            const char *subject = input + start_pos;
+            size_t subject_length = input_length - start_pos;
+            bool earliest = (matcher->options & RIFT_MATCHER_OPTION_LAZY) != 0;
+            size_t length = 0;
+
+            match_found = rift_bit_parallel_match_prefix(bit_parallel, subject, subject_length,
+                                                         earliest, &length);
+
+            // Empty matches are not reported, as with the lazy DFA
+            if (match_found && length == 0 && earliest) {
+                match_found = rift_bit_parallel_match_prefix(bit_parallel, subject,
+                                                             subject_length, false, &length);
+            }
+
+            match_found = match_found && length > 0;
+            match_end = start_pos + length;
+            steps = match_found ? length : subject_length;
+        }
+    } else if (one_pass) {
+        if (start_pos < input_length) {
+            match_found = execute_one_pass(matcher, one_pass, start_pos, &match_end);
+            steps = (match_found ? match_end : input_length) - start_pos;
+        }
+    } else if (tdfa) {
+        if (start_pos < input_length) {
+            match_found = execute_tdfa(matcher, tdfa, start_pos, &match_end);
+            steps = (match_found ? match_end : input_length) - start_pos;
+        }
+    } else if (pike_vm) {
+        if (start_pos < input_length) {
+            match_found = execute_pike_vm(matcher, pike_vm, start_pos, &match_end);
+            steps = (match_found ? match_end : input_length) - start_pos;
+        }
+    } else {
+        // Start from the initial state
+        current_state = rift_automaton_get_initial_state(automaton);
+    }
+    trace_state(matcher, RIFT_TRACE_EVENT_START, current_state, start_pos);
+
+    // Fall back to backtracking for patterns with backreferences, when it is built in
+    if (RIFT_MATCHER_ENGINE_BACKTRACKER && !lazy_dfa && !bit_parallel && !one_pass && !tdfa &&
+        !pike_vm && start_pos < input_length) {
+        size_t pos = start_pos;
+        bool backtracked = false;
+        uint64_t transitions = 0;
+        uint64_t switch_steps =
+            (uint64_t)matcher->switch_steps_per_byte * (input_length - start_pos + 1);
+
+        load_capture_slots(matcher);
+
+        while (pos < input_length) {
+            // Check for timeout and the transition limit
+            if (check_timeout(matcher)) {
+                record_attempt(matcher, engine, steps, pops);
+                return false;
+            }
+            if (matcher->limits.max_transitions != 0 &&
+                ++transitions > matcher->limits.max_transitions) {
+                matcher->timed_out = true;
+                RIFT_PROBE3(bailout, matcher->pattern, RIFT_PROBE_BAILOUT_TRANSITION_LIMIT, pos);
+                record_attempt(matcher, engine, steps, pops);
+                return false;
+            }
+            if (switch_steps != 0 && steps >= switch_steps) {
+                // Rerun an exploding attempt on the Pike VM, keeping any match found so far
+                pike_vm = build_pike_vm(matcher, automaton);
+                switch_steps = 0;
+                if (pike_vm) {
+                    RIFT_PROBE3(bailout, matcher->pattern, RIFT_PROBE_BAILOUT_ENGINE_SWITCH, pos);
+                    if (matcher->stats_enabled) {
+                        matcher->stats.engine_switches++;
+                    }
+                    size_t pike_end = start_pos;
+                    if (execute_pike_vm(matcher, pike_vm, start_pos, &pike_end)) {
+                        match_found = true;
+                        match_end = pike_end;
+                        backtracked = false;
+                    }
+                    steps += (match_found ? match_end : input_length) - start_pos;
+                    engine = RIFT_MATCH_ENGINE_PIKE_VM;
+                    break;
+                }
+            }
+            steps++;
+
+            // Try to process the current character
+            char current_char = input[pos];
+            rift_regex_state_t *from_state = current_state;
+            if (!step_character(automaton, &current_state, current_char, matcher, pos + 1)) {
+                trace_state(matcher, RIFT_TRACE_EVENT_FAIL, from_state, pos);
+
+                // Character not accepted - try backtracking
+                if (anchored || rift_backtrack_stack_is_empty(matcher->backtrack_stack)) {
+                    break;
+                }
+
+                // Backtrack to a previous state, rolling the capture slots back with it
+                rift_regex_state_t *state;
+                size_t backtrack_pos;
+
+                if (!rift_backtrack_stack_pop(matcher->backtrack_stack, &state, &backtrack_pos)) {
+                    break;
+                }
+                pops++;
+                trace_state(matcher, RIFT_TRACE_EVENT_BACKTRACK, state, backtrack_pos);
+
+                // Restore the state
+                current_state = state;
+                pos = backtrack_pos;
+                backtracked = true;
+
+                // Set context position
+                rift_matcher_context_set_position(matcher->context, pos);
+            } else {
+                // Character was processed successfully
+                trace_state(matcher, RIFT_TRACE_EVENT_STEP, from_state, pos);
+                pos++;
+                rift_matcher_context_advance(matcher->context);
+
+                // If the current state is accepting, we have a match
+                if (rift_state_is_accepting(current_state)) {
+                    match_found = true;
+                    match_end = pos;
+                    trace_state(matcher, RIFT_TRACE_EVENT_MATCH, current_state, pos);
+
+                    // If we're using greedy matching (default), continue to try to match more
+                    if (!(matcher->options & RIFT_MATCHER_OPTION_LAZY)) {
+                        // Save this state as a backtrack point
+                        push_backtrack_point(matcher, current_state, pos);
+                    } else {
+                        // Lazy matching - return the match as soon as we find it
+                        break;
+                    }
+                }
+            }
+        }
+
+        // Publish the captures the last backtrack rolled back to
+        if (backtracked) {
+            store_capture_slots(matcher);
+        }
+    }
+
+    record_attempt(matcher, engine, steps, pops);
+    if (match_found && !current_state) {
+        trace_state(matcher, RIFT_TRACE_EVENT_MATCH, NULL, match_end);
+    }
+
+    if (match_found) {
+        matcher->last_match_start = start_pos;
+        matcher->last_match_end = match_end;
+    }
+
+    // If we found a match, create the match result
+    if (match_found && match) {
+        rift_regex_match_result_t result =
+            *rift_matcher_context_create_match_result(matcher->context, start_pos, match_end);
+        match->start_pos = result.start_pos;
+        match->end_pos = result.end_pos;
+        match->groups = result.groups;
+    }
+
+    return match_found;
+}
+
+/**
+ * @brief Search for the next match, the prefilter permitting
+ *
+ * Matches may end past start_limit, but only start positions before it are
+ * tried.
+ *
+ * @param matcher The matcher
+ * @param match Pointer to store match information (can be NULL)
+ * @param start_limit Position the match must start before
+ * @return true if a match was found, false otherwise
+ */
+static bool
+find_next_match(rift_regex_matcher_t *matcher, rift_regex_match_t *match, size_t start_limit)
+{
+    const char *input = rift_matcher_context_get_input(matcher->context);
+    size_t input_length = rift_matcher_context_get_input_length(matcher->context);
+    size_t start_pos = rift_matcher_context_get_position(matcher->context);
+    bool anchored = (matcher->options & RIFT_MATCHER_OPTION_ANCHOR_START) != 0;
+
+    // A match needs at least min bytes, so none starts closer than that to the end
+    const rift_match_length_bounds_t *bounds =
+        rift_regex_pattern_get_match_length(matcher->pattern);
+    size_t last_start = bounds->min <= input_length ? input_length - bounds->min + 1 : 0;
+    if (start_limit > last_start) {
+        start_limit = last_start;
+    }
+
+    // Positions up to window_end passed the prefilter and need no new search
+    rift_prefilter_t *prefilter = get_prefilter(matcher);
+    size_t window_end = 0;
+    bool in_window = false;
+
+    // Patterns on the lazy DFA locate the leftmost match start in a few linear passes
+    bool found = false;
+    size_t match_start = start_pos;
+    if (!anchored && get_reverse_search(matcher) &&
+        locate_match_start(matcher, prefilter, input, input_length, start_pos, start_limit, &found,
+                           &match_start)) {
+        if (!found) {
+            rift_matcher_context_set_position(matcher->context, input_length);
+            return false;
+        }
+
+        start_pos = match_start;
+        rift_matcher_context_set_position(matcher->context, start_pos);
+        prefilter = NULL;
+    }
+
+    while (true) {
+        if (prefilter && !(in_window && start_pos <= window_end)) {
+            size_t candidate = rift_prefilter_find_candidate(prefilter, input, input_length,
+                                                             start_pos, &window_end);
+            size_t skipped_to = candidate == RIFT_PREFILTER_NO_CANDIDATE ? input_length : candidate;
+            matcher->step_count += skipped_to - start_pos;
+            if (matcher->stats_enabled) {
+                matcher->stats.prefilter_skips += skipped_to - start_pos;
+            }
+            if (candidate == RIFT_PREFILTER_NO_CANDIDATE || candidate >= start_limit ||
+                (anchored && candidate != start_pos)) {
+                if (!anchored) {
+                    rift_matcher_context_set_position(matcher->context, input_length);
+                }
+                return false;
+            }
+
+            in_window = true;
+            start_pos = candidate;
+            rift_matcher_context_set_position(matcher->context, start_pos);
+        }
+
+        // Try to find a match starting from the current position
+        if (start_pos < start_limit && execute_match(matcher, match, false)) {
+            return true;
+        }
+
+        // If we're anchored to the start or at the limit, there is nowhere else to try
+        if (anchored || start_pos >= start_limit) {
+            return false;
+        }
+
+        // Move to the next position
+        start_pos++;
+        rift_matcher_context_set_position(matcher->context, start_pos);
+        if (start_pos >= start_limit) {
+            return false;
+        }
+
+        // Check for timeout
+        if (check_timeout(matcher)) {
+            return false;
+        }
+
+        // Yield to rift_matcher_step once its steps are spent
+        if (matcher->step_limit != 0 && matcher->step_count >= matcher->step_limit) {
+            matcher->step_pending = true;
+            return false;
+        }
+    }
+}
+
+/**
+ * @brief Find the next match in the input string
+ *
+ * @param matcher The matcher
+ * @param match Pointer to store match information (can be NULL)
+ * @return true if a match was found, false otherwise
+ */
+bool
+rift_matcher_find_next(rift_regex_matcher_t *matcher, rift_regex_match_t *match)
+{
+    if (!matcher || !matcher->context) {
+        return false;
+    }
+
+    size_t input_length = rift_matcher_context_get_input_length(matcher->context);
+    RIFT_PROBE3(match__start, matcher->pattern, input_length,
+                rift_matcher_context_get_position(matcher->context));
+    matcher->step_pending = false;
+    begin_search_stats(matcher);
+    bool found = find_next_match(matcher, match, input_length);
+    end_search_stats(matcher, found);
+    RIFT_PROBE4(match__end, matcher->pattern, (int)found, matcher->last_match_start,
+                matcher->last_match_end);
+    return found;
+}
+
+/**
+ * @brief Run the search for the next match for a limited number of steps
+ *
+ * @param matcher The matcher
+ * @param max_steps Steps to run before yielding, at least one attempt runs
+ * @param match Pointer to store match information when found (can be NULL)
+ * @param status Pointer to store the outcome of the call
+ * @return true if a match was found, false if not or not yet
+ */
+bool
+rift_matcher_step(rift_regex_matcher_t *matcher, uint64_t max_steps, rift_regex_match_t *match,
+                  rift_match_status_t *status)
+{
+    if (!matcher || !matcher->context || !status) {
+        return false;
+    }
+
+    // A search yielded by the last call resumes at the position it stopped at
+    size_t input_length = rift_matcher_context_get_input_length(matcher->context);
+    if (!matcher->step_pending) {
+        RIFT_PROBE3(match__start, matcher->pattern, input_length,
+                    rift_matcher_context_get_position(matcher->context));
+        begin_search_stats(matcher);
+    }
+
+    matcher->step_pending = false;
+    matcher->step_limit = matcher->step_count + (max_steps ? max_steps : 1);
+    bool found = find_next_match(matcher, match, input_length);
+    matcher->step_limit = 0;
+
+    if (matcher->step_pending) {
+        *status = RIFT_MATCH_PENDING;
+        return false;
+    }
+
+    end_search_stats(matcher, found);
+    RIFT_PROBE4(match__end, matcher->pattern, (int)found, matcher->last_match_start,
+                matcher->last_match_end);
+    *status = found ? RIFT_MATCH_FOUND : RIFT_MATCH_NOT_FOUND;
+    return found;
+}
+
+/**
+ * @brief Find the next match and report it as spans without allocating
+ *
+ * @param matcher The matcher
+ * @param spans Array to store the spans (can be NULL if max_spans is 0)
+ * @param max_spans Number of entries in spans
+ * @param num_spans Pointer to store the number of spans the match has (can be NULL)
+ * @return true if a match was found, false otherwise
+ */
+bool
+rift_matcher_find_next_spans(rift_regex_matcher_t *matcher, rift_regex_span_t *spans,
+                             size_t max_spans, size_t *num_spans)
+{
+    if (!matcher || !matcher->context || (!spans && max_spans > 0)) {
+        return false;
+    }
+
+    // Without a match structure the search builds no match result
+    if (!rift_matcher_find_next(matcher, NULL)) {
+        return false;
+    }
+
+    size_t count = rift_matcher_context_get_spans(matcher->context, matcher->last_match_start,
+                                                  matcher->last_match_end, spans, max_spans);
+    if (num_spans) {
+        *num_spans = count;
+    }
+
+    return count > 0;
+}
+
+/**
+ * @brief Copy the text of a span into a caller-provided buffer
+ *
+ * @param matcher The matcher whose input the span refers to
+ * @param span The span
+ * @param buffer Buffer to store the text
+ * @param buffer_size Size of the buffer
+ * @return Length of the span text, or 0 for an unset or invalid span
+ */
+size_t
+rift_matcher_copy_span_text(const rift_regex_matcher_t *matcher, const rift_regex_span_t *span,
+                            char *buffer, size_t buffer_size)
+{
+    if (!matcher || !matcher->context || !span) {
+        return 0;
+    }
+
+    const char *input = rift_matcher_context_get_input(matcher->context);
+    size_t input_length = rift_matcher_context_get_input_length(matcher->context);
+    if (!input || span->start > span->end || span->end > input_length) {
+        return 0;
+    }
+
+    size_t length = span->end - span->start;
+    if (buffer && buffer_size > 0) {
+        size_t copied = length < buffer_size ? length : buffer_size - 1;
+        memcpy(buffer, input + span->start, copied);
+        buffer[copied] = '\0';
+    }
+
+    return length;
+}
+
+/**
+ * @brief Set the callback receiving the matches of a streamed input
+ *
+ * @param matcher The matcher
+ * @param callback The callback, called once per match
+ * @param user_data User data passed to the callback
+ * @return true if successful, false otherwise
+ */
+bool
+rift_matcher_set_stream_callback(rift_regex_matcher_t *matcher,
+                                 rift_matcher_match_callback_t callback, void *user_data)
+{
+    if (!matcher || !callback) {
+        return false;
+    }
+
+    matcher->stream_callback = callback;
+    matcher->stream_user_data = user_data;
+    return true;
+}
+
+/**
+ * @brief Discard a streamed input and start over at offset 0
+ *
+ * @param matcher The matcher
+ */
+void
+rift_matcher_stream_reset(rift_regex_matcher_t *matcher)
+{
+    if (!matcher) {
+        return;
+    }
+
+    matcher->stream_length = 0;
+    matcher->stream_offset = 0;
+    matcher->stream_before = RIFT_LAZY_DFA_TEXT_EDGE;
+    matcher->stream_stopped = false;
+}
+
+/**
+ * @brief Get the lazy DFA used to stream a pattern
+ *
+ * Streamed matches report their bounds only, so patterns with capture groups
+ * run on the lazy DFA as well. Backreferences need the whole input.
+ *
+ * @param matcher The matcher
+ * @return The lazy DFA or NULL if the pattern cannot be streamed
+ */
+static rift_lazy_dfa_t *
+get_stream_dfa(rift_regex_matcher_t *matcher)
+{
+    if (!RIFT_MATCHER_ENGINE_LAZY_DFA) {
+        return NULL;
+    }
+    if (matcher->lazy_dfa) {
+        return matcher->lazy_dfa;
+    }
+
+    const rift_ambiguity_verdict_t *verdict = rift_regex_pattern_get_ambiguity(matcher->pattern);
+    if (verdict && verdict->has_backreference) {
+        return NULL;
+    }
+
+    rift_regex_automaton_t *automaton = rift_regex_pattern_get_automaton(matcher->pattern);
+    if (!automaton) {
+        return NULL;
+    }
+
+    // Streaming has no other engine, so a budget too small for the cache
+    // gets the smallest one, whose flushes fall back to NFA simulation
+    const rift_allocator_t *outer = matcher_allocator_enter(matcher);
+    matcher->lazy_dfa = rift_lazy_dfa_create_with_budget(automaton, matcher->applied_budget, NULL);
+    if (!matcher->lazy_dfa && matcher->applied_budget != 0) {
+        matcher->lazy_dfa = rift_lazy_dfa_create(automaton, RIFT_LAZY_DFA_MIN_CACHE_STATES, NULL);
+    }
+    rift_allocator_use(outer);
+    return matcher->lazy_dfa;
+}
+
+/**
+ * @brief Append a chunk to the stream buffer
+ *
+ * @param matcher The matcher
+ * @param chunk The chunk bytes
+ * @param length Number of bytes in the chunk
+ * @return true if successful, false on allocation failure
+ */
+static bool
+stream_append(rift_regex_matcher_t *matcher, const char *chunk, size_t length)
+{
+    if (length == 0) {
+        return true;
+    }
+
+    size_t needed = matcher->stream_length + length;
+    if (needed > matcher->stream_capacity) {
+        size_t capacity = matcher->stream_capacity ? matcher->stream_capacity : 4096;
+        while (capacity < needed) {
+            capacity *= 2;
+        }
+
+        const rift_allocator_t *outer = matcher_allocator_enter(matcher);
+        char *buffer = (char *)rift_realloc(matcher->stream_buffer, capacity);
+        rift_allocator_use(outer);
+        if (!buffer) {
+            return false;
+        }
+        matcher->stream_buffer = buffer;
+        matcher->stream_capacity = capacity;
+    }
+
+    memcpy(matcher->stream_buffer + matcher->stream_length, chunk, length);
+    matcher->stream_length = needed;
+    return true;
+}
+
+/**
+ * @brief Feed the next chunk of a streamed input
+ *
+ * @param matcher The matcher
+ * @param chunk The chunk bytes (can be NULL if length is 0)
+ * @param length Number of bytes in the chunk
+ * @param is_last Whether this chunk ends the input
+ * @return true if successful, false on invalid parameters, unsupported patterns or allocation
+ * failure
+ */
+bool
+rift_matcher_feed(rift_regex_matcher_t *matcher, const char *chunk, size_t length, bool is_last)
+{
+    if (!matcher || !matcher->stream_callback || (!chunk && length > 0)) {
+        return false;
+    }
+
+    rift_lazy_dfa_t *lazy_dfa = get_stream_dfa(matcher);
+    if (!lazy_dfa) {
+        return false;
+    }
+
+    if (!matcher->stream_stopped && !stream_append(matcher, chunk, length)) {
+        return false;
+    }
+
+    const char *buffer = matcher->stream_buffer;
+    size_t buffer_length = matcher->stream_length;
+    bool earliest = (matcher->options & RIFT_MATCHER_OPTION_LAZY) != 0;
+    bool anchored = (matcher->options & RIFT_MATCHER_OPTION_ANCHOR_START) != 0;
+    size_t pos = 0;
+
+    while (!matcher->stream_stopped && pos < buffer_length) {
+        const char *subject = buffer + pos;
+        size_t subject_length = buffer_length - pos;
+        size_t match_length = 0;
+        bool needs_more = false;
+
+        rift_lazy_dfa_set_context(lazy_dfa,
+                                  pos > 0 ? (uint8_t)buffer[pos - 1] : matcher->stream_before,
+                                  RIFT_LAZY_DFA_TEXT_EDGE);
+        bool found = rift_lazy_dfa_match_prefix_partial(lazy_dfa, subject, subject_length,
+                                                        earliest, &match_length, &needs_more);
+
+        // Empty matches are not reported, so use the longest match past an empty one
+        if (found && match_length == 0 && earliest) {
+            found = rift_lazy_dfa_match_prefix_partial(lazy_dfa, subject, subject_length, false,
+                                                       &match_length, &needs_more);
+        }
+
+        // Keep the bytes from here until more input decides the match, or the
+        // assertions at its end when it reaches the end of the buffer
+        bool at_end = lazy_dfa->has_assertions && found && match_length == subject_length;
+        if ((needs_more || at_end) && !is_last) {
+            break;
+        }
+
+        if (found && match_length > 0) {
+            rift_regex_span_t span = {matcher->stream_offset + pos,
+                                      matcher->stream_offset + pos + match_length};
+            if (!matcher->stream_callback(&span, 1, matcher->stream_user_data)) {
+                matcher->stream_stopped = true;
+            }
+            pos += match_length;
+        } else if (anchored) {
+            // Anchored matches continue only where the previous one ended
+            matcher->stream_stopped = true;
+        } else {
+            pos++;
+        }
+    }
+
+    if (matcher->stream_stopped) {
+        pos = buffer_length;
+    }
+
+    // Drop the bytes no pending match can start in
+    if (pos > 0) {
+        matcher->stream_before = (uint8_t)buffer[pos - 1];
+        memmove(matcher->stream_buffer, buffer + pos, buffer_length - pos);
+        matcher->stream_length = buffer_length - pos;
+        matcher->stream_offset += pos;
+    }
+
+    if (is_last) {
+        rift_matcher_stream_reset(matcher);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Report every match of the input to a callback
+ *
+ * @param matcher The matcher
+ * @param callback The callback, called once per match
+ * @param user_data User data passed to the callback
+ * @return true if successful, false on invalid parameters or allocation failure
+ */
+bool
+rift_matcher_for_each_match(rift_regex_matcher_t *matcher, rift_matcher_match_callback_t callback,
+                            void *user_data)
+{
+    if (!matcher || !matcher->context || !callback) {
+        return false;
+    }
+
+    // Patterns with few groups need no allocation at all
+    rift_regex_span_t local_spans[RIFT_MATCHER_LOCAL_SPANS];
+    rift_regex_span_t *spans = local_spans;
+    size_t max_spans = rift_regex_pattern_get_group_count(matcher->pattern) + 1;
+    if (max_spans > RIFT_MATCHER_LOCAL_SPANS) {
+        spans = (rift_regex_span_t *)malloc(max_spans * sizeof(rift_regex_span_t));
+        if (!spans) {
+            return false;
+        }
+    }
+
+    size_t input_length = rift_matcher_context_get_input_length(matcher->context);
+    rift_matcher_context_set_position(matcher->context, 0);
+
+    size_t num_spans = 0;
+    while (!check_timeout(matcher) &&
+           rift_matcher_find_next_spans(matcher, spans, max_spans, &num_spans)) {
+        if (num_spans > max_spans) {
+            num_spans = max_spans;
+        }
+        if (!callback(spans, num_spans, user_data)) {
+            break;
+        }
+
+        // Continue after the match, advancing at least one character
+        size_t next_pos = spans[0].end;
+        if (next_pos <= rift_matcher_context_get_position(matcher->context)) {
+            next_pos = rift_matcher_context_get_position(matcher->context) + 1;
+        }
+        if (next_pos >= input_length) {
+            break;
+        }
+        rift_matcher_context_set_position(matcher->context, next_pos);
+    }
+
+    if (spans != local_spans) {
+        free(spans);
+    }
+    return true;
+}
+
+/**
+ * @brief Report every match of each line of the input to a callback
+ *
+ * @param matcher The matcher
+ * @param callback The callback, called once per match
+ * @param user_data User data passed to the callback
+ * @return true if successful, false on invalid parameters or allocation failure
+ */
+bool
+rift_matcher_for_each_line_match(rift_regex_matcher_t *matcher,
+                                 rift_matcher_line_callback_t callback, void *user_data)
+{
+    if (!matcher || !matcher->context || !callback) {
+        return false;
+    }
+
+    // Patterns with few groups need no allocation at all
+    rift_regex_span_t local_spans[RIFT_MATCHER_LOCAL_SPANS];
+    rift_regex_span_t *spans = local_spans;
+    size_t max_spans = rift_regex_pattern_get_group_count(matcher->pattern) + 1;
+    if (max_spans > RIFT_MATCHER_LOCAL_SPANS) {
+        spans = (rift_regex_span_t *)malloc(max_spans * sizeof(rift_regex_span_t));
+        if (!spans) {
+            return false;
+        }
+    }
+
+    const char *input = rift_matcher_context_get_input(matcher->context);
+    size_t input_length = rift_matcher_context_get_input_length(matcher->context);
+    size_t saved_position = rift_matcher_context_get_position(matcher->context);
+    rift_prefilter_t *prefilter = get_prefilter(matcher);
+
+    size_t line_number = 0;
+    bool stopped = false;
+    for (size_t line_start = 0; line_start < input_length && !stopped;) {
+        size_t line_end = rift_prefilter_find_byte(input, line_start, input_length, '\n');
+        const char *line = input + line_start;
+        size_t line_length = line_end - line_start;
+        rift_regex_span_t line_span = {line_start, line_end};
+        line_number++;
+        line_start = line_end + 1;
+
+        // Lines the prefilter rules out are never made the input
+        if (prefilter && rift_prefilter_find_candidate(prefilter, line, line_length, 0, NULL) ==
+                             RIFT_PREFILTER_NO_CANDIDATE) {
+            continue;
+        }
+
+        // The line is the whole input, so the anchors hold at its ends
+        rift_matcher_set_input(matcher, line, line_length);
+        size_t num_spans = 0;
+        while (!check_timeout(matcher) &&
+               rift_matcher_find_next_spans(matcher, spans, max_spans, &num_spans)) {
+            if (num_spans > max_spans) {
+                num_spans = max_spans;
+            }
+            if (!callback(line_number, &line_span, spans, num_spans, user_data)) {
+                stopped = true;
+                break;
+            }
+
+            // Continue after the match, advancing at least one character
+            size_t next_pos = spans[0].end;
+            if (next_pos <= rift_matcher_context_get_position(matcher->context)) {
+                next_pos = rift_matcher_context_get_position(matcher->context) + 1;
+            }
+            if (next_pos >= line_length) {
+                break;
+            }
+            rift_matcher_context_set_position(matcher->context, next_pos);
+        }
+    }
+
+    rift_matcher_set_input(matcher, input, input_length);
+    rift_matcher_context_set_position(matcher->context, saved_position);
+    if (spans != local_spans) {
+        free(spans);
+    }
+    return true;
+}
+
+/**
+ * @brief Map a file and report its matches, by line or over the whole file
+ *
+ * @param matcher The matcher
+ * @param path Path of the file to scan
+ * @param callback Receiver of the matches of the whole file, or NULL
+ * @param line_callback Receiver of the matches of each line, used when callback is NULL
+ * @param user_data User data passed to the callback
+ * @return true if the file was scanned, false otherwise
+ */
+static bool
+scan_file(rift_regex_matcher_t *matcher, const char *path, rift_matcher_match_callback_t callback,
+          rift_matcher_line_callback_t line_callback, void *user_data)
+{
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        close(fd);
+        return false;
+    }
+
+    // An empty file has nothing to map and nothing to match
+    size_t size = (size_t)info.st_size;
+    if (size == 0) {
+        close(fd);
+        return true;
+    }
+
+    void *mapping = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return false;
+    }
+    madvise(mapping, size, MADV_SEQUENTIAL);
+
+    // Keep the caller's input to put it back once the mapping is gone
+    const char *saved_input = NULL;
+    size_t saved_length = 0;
+    size_t saved_position = 0;
+    if (matcher->context) {
+        saved_input = rift_matcher_context_get_input(matcher->context);
+        saved_length = rift_matcher_context_get_input_length(matcher->context);
+        saved_position = rift_matcher_context_get_position(matcher->context);
+    }
+
+    bool success =
+        rift_matcher_set_input(matcher, (const char *)mapping, size) &&
+        (callback ? rift_matcher_for_each_match(matcher, callback, user_data)
+                  : rift_matcher_for_each_line_match(matcher, line_callback, user_data));
+
+    if (saved_input) {
+        rift_matcher_set_input(matcher, saved_input, saved_length);
+        rift_matcher_context_set_position(matcher->context, saved_position);
+    } else {
+        rift_matcher_set_input(matcher, "", 0);
+    }
+
+    munmap(mapping, size);
+    return success;
+}
+
+/**
+ * @brief Report every match in a file to a callback
+ *
+ * @param matcher The matcher
+ * @param path Path of the file to scan
+ * @param callback The callback, called once per match
+ * @param user_data User data passed to the callback
+ * @return true if the file was scanned, false otherwise
+ */
+bool
+rift_matcher_find_all_file(rift_regex_matcher_t *matcher, const char *path,
+                           rift_matcher_match_callback_t callback, void *user_data)
+{
+    if (!matcher || !path || !callback) {
+        return false;
+    }
+
+    return scan_file(matcher, path, callback, NULL, user_data);
+}
+
+/**
+ * @brief Report every match of each line of a file to a callback
+ *
+ * @param matcher The matcher
+ * @param path Path of the file to scan
+ * @param callback The callback, called once per match
+ * @param user_data User data passed to the callback
+ * @return true if the file was scanned, false otherwise
+ */
+bool
+rift_matcher_find_all_lines_file(rift_regex_matcher_t *matcher, const char *path,
+                                 rift_matcher_line_callback_t callback, void *user_data)
+{
+    if (!matcher || !path || !callback) {
+        return false;
+    }
+
+    return scan_file(matcher, path, NULL, callback, user_data);
+}
+
+/**
+ * @brief Matches of one chunk of an input searched in parallel
+ */
+typedef struct parallel_chunk {
+    const rift_regex_pattern_t *pattern; /**< Pattern to search for */
+    const char *input;                   /**< Whole input */
+    size_t length;                       /**< Length of the whole input */
+    size_t start;                        /**< First start position of the chunk */
+    size_t end;                          /**< Position past the last start position */
+    rift_regex_span_t *matches;          /**< Matches found from start, in order */
+    size_t count;                        /**< Number of matches */
+    size_t capacity;                     /**< Capacity of matches */
+    bool failed;                         /**< Whether the search ran out of memory */
+    pthread_t thread;                    /**< Worker searching the chunk */
+    bool started;                        /**< Whether the worker was started */
+} parallel_chunk_t;
+
+/**
+ * @brief Find the matches starting in a chunk as if the search began at its start
+ *
+ * Each chunk gets a matcher of its own over the whole input, so matches can
+ * end in later chunks and anchors see the real input. When the pattern's
+ * matches are at most max bytes long, the searches on the DFAs read no more
+ * than max - 1 bytes past the chunk's end.
+ *
+ * @param arg The chunk
+ * @return NULL
+ */
+static void *
+search_chunk(void *arg)
+{
+    parallel_chunk_t *chunk = (parallel_chunk_t *)arg;
+    rift_regex_matcher_t *matcher = rift_matcher_create(chunk->pattern, RIFT_MATCHER_OPTION_NONE);
+    if (!matcher || !rift_matcher_set_input(matcher, chunk->input, chunk->length)) {
+        rift_matcher_free(matcher);
+        chunk->failed = true;
+        return NULL;
+    }
+
+    rift_matcher_context_set_position(matcher->context, chunk->start);
+    while (find_next_match(matcher, NULL, chunk->end)) {
+        if (chunk->count >= chunk->capacity) {
+            size_t new_capacity = chunk->capacity == 0 ? 64 : chunk->capacity * 2;
+            rift_regex_span_t *new_matches = (rift_regex_span_t *)realloc(
+                chunk->matches, new_capacity * sizeof(rift_regex_span_t));
+            if (!new_matches) {
+                chunk->failed = true;
+                break;
+            }
+            chunk->matches = new_matches;
+            chunk->capacity = new_capacity;
+        }
+
+        // Matches are never empty, so the search always moves forward
+        rift_regex_span_t *span = &chunk->matches[chunk->count++];
+        span->start = matcher->last_match_start;
+        span->end = matcher->last_match_end;
+        rift_matcher_context_set_position(matcher->context, span->end);
+    }
+
+    rift_matcher_free(matcher);
+    return NULL;
+}
+
+/**
+ * @brief Report the matches of a chunk that the sequential search would find
+ *
+ * A search position decides everything after it, as each start position
+ * is tried the same way whatever came before. The chunk's matches were
+ * found searching from its start, while the sequential search enters the
+ * chunk at *position, past the end of the previous match. Matches are
+ * taken from the chunk as soon as the search the chunk ran before one of
+ * them started at or before *position; until then the sequential search
+ * runs again from *position, which only happens when a match crosses a
+ * chunk boundary and so covers few positions.
+ *
+ * @param chunk The chunk, with its matches found
+ * @param matcher Matcher over the whole input for the searches run again
+ * @param position Position the sequential search is at, updated past the chunk
+ * @param callback The callback, called once per match
+ * @param user_data User data passed to the callback
+ * @return true to go on with the next chunk, false once the callback stopped the search
+ */
+static bool
+stitch_chunk(const parallel_chunk_t *chunk, rift_regex_matcher_t *matcher, size_t *position,
+             rift_matcher_match_callback_t callback, void *user_data)
+{
+    size_t next = 0;
+
+    while (true) {
+        // The first match of the chunk the sequential search has not passed
+        while (next < chunk->count && chunk->matches[next].start < *position) {
+            next++;
+        }
+        size_t searched_from = next == 0 ? chunk->start : chunk->matches[next - 1].end;
+
+        if (!chunk->failed && searched_from <= *position) {
+            for (; next < chunk->count; next++) {
+                if (!callback(&chunk->matches[next], 1, user_data)) {
+                    return false;
+                }
+                *position = chunk->matches[next].end;
+            }
+            break;
+        }
+
+        // Run the sequential search until it agrees with the chunk's
+        rift_matcher_context_set_position(matcher->context, *position);
+        if (!find_next_match(matcher, NULL, chunk->end)) {
+            break;
+        }
+
+        rift_regex_span_t span = {matcher->last_match_start, matcher->last_match_end};
+        if (!callback(&span, 1, user_data)) {
+            return false;
+        }
+        *position = span.end;
+    }
+
+    if (*position < chunk->end) {
+        *position = chunk->end;
+    }
+    return true;
+}
+
+/**
+ * @brief Report every match of an input to a callback, searching it on several threads
+ *
+ * @param pattern The compiled pattern
+ * @param input The input
+ * @param length Length of the input or (size_t)-1 to use strlen
+ * @param num_threads Number of threads to search with, including the caller's
+ * @param callback The callback, called once per match
+ * @param user_data User data passed to the callback
+ * @return true if the input was searched, false on invalid parameters or allocation failure
+ */
+bool
+rift_matcher_find_all_parallel(const rift_regex_pattern_t *pattern, const char *input,
+                               size_t length, size_t num_threads,
+                               rift_matcher_match_callback_t callback, void *user_data)
+{
+    if (!pattern || !input || !callback) {
+        return false;
+    }
+    if (length == (size_t)-1) {
+        length = strlen(input);
+    }
+
+    // Chunks too small to pay for a thread are merged
+    size_t num_chunks = num_threads == 0 ? 1 : num_threads;
+    if (num_chunks > length / RIFT_MATCHER_PARALLEL_MIN_CHUNK) {
+        num_chunks = length / RIFT_MATCHER_PARALLEL_MIN_CHUNK;
+    }
+    if (num_chunks == 0) {
+        num_chunks = 1;
+    }
+
+    parallel_chunk_t *chunks = (parallel_chunk_t *)calloc(num_chunks, sizeof(parallel_chunk_t));
+    rift_regex_matcher_t *matcher = rift_matcher_create(pattern, RIFT_MATCHER_OPTION_NONE);
+    if (!chunks || !matcher || !rift_matcher_set_input(matcher, input, length)) {
+        free(chunks);
+        rift_matcher_free(matcher);
+        return false;
+    }
+
+    for (size_t i = 0; i < num_chunks; i++) {
+        chunks[i].pattern = pattern;
+        chunks[i].input = input;
+        chunks[i].length = length;
+        chunks[i].start = length / num_chunks * i;
+        chunks[i].end = i + 1 == num_chunks ? length : length / num_chunks * (i + 1);
+    }
+
+    // The caller searches the first chunk; a worker that cannot start is searched inline
+    for (size_t i = 1; i < num_chunks; i++) {
+        chunks[i].started = pthread_create(&chunks[i].thread, NULL, search_chunk, &chunks[i]) == 0;
+    }
+    search_chunk(&chunks[0]);
+
+    // Report in input order, stitching each chunk as its worker finishes
+    size_t position = 0;
+    bool reporting = true;
+    for (size_t i = 0; i < num_chunks; i++) {
+        if (chunks[i].started) {
+            pthread_join(chunks[i].thread, NULL);
+        } else if (i > 0 && reporting) {
+            search_chunk(&chunks[i]);
+        }
+
+        if (reporting) {
+            reporting = stitch_chunk(&chunks[i], matcher, &position, callback, user_data);
+        }
+        free(chunks[i].matches);
+    }
+
+    free(chunks);
+    rift_matcher_free(matcher);
+    return true;
+}
+
+/**
+ * @brief Check if the entire input string matches the pattern
+ *
+ * @param matcher The matcher
+ * @param match Pointer to store match information (can be NULL)
+ * @return true if the entire string matches, false otherwise
+ */
+bool
+rift_matcher_matches(rift_regex_matcher_t *matcher, rift_regex_match_t *match)
+{
+    if (!matcher || !matcher->context) {
+        return false;
+    }
+
+    // Reset the matcher to the beginning of the input
+    rift_matcher_context_set_position(matcher->context, 0);
+
+    // Try to find a match starting from the beginning
+    rift_regex_match_t local_match;
+    RIFT_PROBE3(match__start, matcher->pattern,
+                rift_matcher_context_get_input_length(matcher->context), (size_t)0);
+    begin_search_stats(matcher);
+    bool found = execute_match(matcher, &local_match, true);
+    end_search_stats(matcher, found);
+    RIFT_PROBE4(match__end, matcher->pattern, (int)found, matcher->last_match_start,
+                matcher->last_match_end);
+    if (!found) {
+        return false;
+    }
+
+    // Check if the match covers the entire input
+    size_t input_length = rift_matcher_context_get_input_length(matcher->context);
+
+    if (local_match.end_pos == input_length) {
+        if (match) {
+            *match = local_match;
+        }
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Check whether the pattern matches anywhere in the input
+ *
+ * @param matcher The matcher
+ * @return true if the input has a match, false otherwise
+ */
+bool
+rift_matcher_is_match(rift_regex_matcher_t *matcher)
+{
+    if (!matcher || !matcher->context) {
+        return false;
+    }
+
+    const char *input = rift_matcher_context_get_input(matcher->context);
+    size_t input_length = rift_matcher_context_get_input_length(matcher->context);
+    size_t position = rift_matcher_context_get_position(matcher->context);
+    bool anchored = (matcher->options & RIFT_MATCHER_OPTION_ANCHOR_START) != 0;
+
+    begin_search_stats(matcher);
+    matcher->bounds_only = true;
+    bool found = false;
+    if (!anchored && get_reverse_search(matcher)) {
+        // The forward DFA stops at the first accepting state, which no match can precede
+        size_t end = input_length;
+        rift_lazy_dfa_set_context(matcher->forward_dfa, RIFT_LAZY_DFA_TEXT_EDGE,
+                                  RIFT_LAZY_DFA_TEXT_EDGE);
+        found = rift_lazy_dfa_find_earliest_end(matcher->forward_dfa, input, input_length,
+                                                input_length, &end);
+        record_attempt(matcher, RIFT_MATCH_ENGINE_LAZY_DFA, found ? end : input_length, 0);
+    } else {
+        rift_matcher_context_set_position(matcher->context, 0);
+        found = find_next_match(matcher, NULL, input_length);
+    }
+    matcher->bounds_only = false;
+    end_search_stats(matcher, found);
+
+    rift_matcher_context_set_position(matcher->context, position);
+    return found;
+}
+
+/**
+ * @brief Count the matches in the input
+ *
+ * @param matcher The matcher
+ * @return Number of matches, 0 on invalid parameters
+ */
+size_t
+rift_matcher_count(rift_regex_matcher_t *matcher)
+{
+    if (!matcher || !matcher->context) {
+        return 0;
+    }
+
+    size_t input_length = rift_matcher_context_get_input_length(matcher->context);
+    size_t position = rift_matcher_context_get_position(matcher->context);
+    rift_matcher_context_set_position(matcher->context, 0);
+
+    begin_search_stats(matcher);
+    matcher->bounds_only = true;
+    size_t count = 0;
+    while (!check_timeout(matcher) && find_next_match(matcher, NULL, input_length)) {
+        count++;
+
+        // Restart after the match, advancing at least one character, as for_each_match does
+        size_t next_pos = matcher->last_match_end;
+        if (next_pos <= rift_matcher_context_get_position(matcher->context)) {
+            next_pos = rift_matcher_context_get_position(matcher->context) + 1;
+        }
+        if (next_pos >= input_length) {
+            break;
+        }
+        rift_matcher_context_set_position(matcher->context, next_pos);
+    }
+    matcher->bounds_only = false;
+    end_search_stats(matcher, count > 0);
+
+    rift_matcher_context_set_position(matcher->context, position);
+    return count;
+}
+
+/**
+ * @brief Find all matches in the input string
+ *
+ * @param matcher The matcher
+ * @param matches Array to store match information
+ * @param max_matches Maximum number of matches to find
+ * @param num_matches Pointer to store the number of matches found
+ * @return true if at least one match was found, false otherwise
+ */
+bool
+rift_matcher_find_all(rift_regex_matcher_t *matcher, rift_regex_match_t *matches,
+                      size_t max_matches, size_t *num_matches)
+{
+    if (!matcher || !matches || !num_matches || max_matches == 0) {
+        return false;
+    }
+
+    // Reset the matcher to the beginning of the input
+    rift_matcher_context_set_position(matcher->context, 0);
+
+    // Initialize the match count
+    *num_matches = 0;
+
+    // Find all matches, up to max_matches
+    while (*num_matches < max_matches) {
+        // Check for timeout
+        if (check_timeout(matcher)) {
+            return *num_matches > 0;
+        }
+
+        // Try to find the next match
+        if (!rift_matcher_find_next(matcher, &matches[*num_matches])) {
+            break;
+        }
+
+        // Increment the match count
+        (*num_matches)++;
+
+        // Set the next start position to avoid overlapping matches
+        // To avoid infinite loops, we advance at least one character
+        size_t next_pos = matches[*num_matches - 1].end_pos;
+        if (next_pos <= rift_matcher_context_get_position(matcher->context)) {
+            next_pos = rift_matcher_context_get_position(matcher->context) + 1;
+        }
+
+        // If we've reached the end of the input, we're done
+        if (next_pos >= rift_matcher_context_get_input_length(matcher->context)) {
+            break;
+        }
+
+        rift_matcher_context_set_position(matcher->context, next_pos);
+    }
+
+    return *num_matches > 0;
+}
+
+/**
+ * @brief Replace occurrences of the pattern in the input string
+ *
+ * @param matcher The matcher
+ * @param replacement The replacement string
+ * @param output Buffer to store the result
+ * @param output_size Size of the output buffer
+ * @param num_replacements Pointer to store the number of replacements made
+ * @return true if successful, false otherwise
+ */
+bool
+rift_matcher_replace(rift_regex_matcher_t *matcher, const char *replacement, char *output,
+                     size_t output_size, size_t *num_replacements)
+{
+    if (!matcher || !replacement || !output || output_size == 0 || !num_replacements) {
+        return false;
+    }
+
+    // Reset the matcher to the beginning of the input
+    rift_matcher_context_set_position(matcher->context, 0);
+
+    // Get the input string
+    const char *input = rift_matcher_context_get_input(matcher->context);
+    size_t input_length = rift_matcher_context_get_input_length(matcher->context);
+
+    // Initialize counters
+    *num_replacements = 0;
+    size_t output_pos = 0;
+    size_t last_copy_pos = 0;
+
+    // Find all matches and replace them
+    rift_regex_match_t match;
+    while (rift_matcher_find_next(matcher, &match)) {
+        // Check for timeout
+        if (check_timeout(matcher)) {
+            break;
+        }
+
+        // Copy the text between the last match and this match
+        size_t to_copy = match.start_pos - last_copy_pos;
+        if (output_pos + to_copy >= output_size) {
+            // Not enough space
+            return false;
+        }
+        memcpy(output + output_pos, input + last_copy_pos, to_copy);
+        output_pos += to_copy;
+
+        // Copy the replacement text
+        size_t replacement_len = strlen(replacement);
+        if (output_pos + replacement_len >= output_size) {
+            // Not enough space
+            return false;
+        }
+        memcpy(output + output_pos, replacement, replacement_len);
+        output_pos += replacement_len;
+
+        // Update counters
+        (*num_replacements)++;
+        last_copy_pos = match.end_pos;
+
+        // Set the next start position
+        // To avoid infinite loops, we advance at least one character
+        size_t next_pos = match.end_pos;
+        if (next_pos <= rift_matcher_context_get_position(matcher->context)) {
+            next_pos = rift_matcher_context_get_position(matcher->context) + 1;
+        }
+
+        // If we've reached the end of the input, we're done
+        if (next_pos >= input_length) {
+            break;
+        }
+
+        rift_matcher_context_set_position(matcher->context, next_pos);
+    }
+
+    // Copy any remaining text
+    size_t to_copy = input_length - last_copy_pos;
+    if (output_pos + to_copy >= output_size) {
+        // Not enough space
+        return false;
+    }
+    memcpy(output + output_pos, input + last_copy_pos, to_copy);
+    output_pos += to_copy;
+
+    // Null-terminate the output
+    if (output_pos >= output_size) {
+        output[output_size - 1] = '\0';
+    } else {
+        output[output_pos] = '\0';
+    }
+
+    return true;
+}
+
+/**
+ * @brief Split the input string using the pattern as a delimiter
+ *
+ * @param matcher The matcher
+ * @param parts Array to store the resulting parts
+ * @param max_parts Maximum number of parts to return
+ * @param num_parts Pointer to store the number of parts
+ * @return true if successful, false otherwise
+ */
+bool
+rift_matcher_split(rift_regex_matcher_t *matcher, char **parts, size_t max_parts, size_t *num_parts)
+{
+    if (!matcher || !parts || max_parts == 0 || !num_parts) {
+        return false;
+    }
+
+    // Reset the matcher to the beginning of the input
+    rift_matcher_context_set_position(matcher->context, 0);
+
+    // Get the input string
+    const char *input = rift_matcher_context_get_input(matcher->context);
+    size_t input_length = rift_matcher_context_get_input_length(matcher->context);
+
+    // Initialize counters
+    *num_parts = 0;
+    size_t last_end_pos = 0;
+
+    // Find all matches and split the string
+    rift_regex_match_t match;
+    while (*num_parts < max_parts - 1 && rift_matcher_find_next(matcher, &match)) {
+        // Check for timeout
+        if (check_timeout(matcher)) {
+            break;
+        }
+
+        // Create a part from the text between the last match and this match
+        size_t part_length = match.start_pos - last_end_pos;
+        parts[*num_parts] = (char *)malloc(part_length + 1);
+        if (!parts[*num_parts]) {
+            // Cleanup allocated parts
+            for (size_t i = 0; i < *num_parts; i++) {
+                free(parts[i]);
+            }
+            return false;
+        }
+
+        memcpy(parts[*num_parts], input + last_end_pos, part_length);
+        parts[*num_parts][part_length] = '\0';
+
+        (*num_parts)++;
+        last_end_pos = match.end_pos;
+
+        // Set the next start position
+        // To avoid infinite loops, we advance at least one character
+        size_t next_pos = match.end_pos;
+        if (next_pos <= rift_matcher_context_get_position(matcher->context)) {
+            next_pos = rift_matcher_context_get_position(matcher->context) + 1;
+        }
+
+        // If we've reached the end of the input, we're done
+        if (next_pos >= input_length) {
+            break;
+        }
+
+        rift_matcher_context_set_position(matcher->context, next_pos);
+    }
+
+    // Add the last part if there's room and it's not empty
+    if (*num_parts < max_parts && last_end_pos < input_length) {
+        size_t part_length = input_length - last_end_pos;
+        parts[*num_parts] = (char *)malloc(part_length + 1);
+        if (!parts[*num_parts]) {
+            // Cleanup allocated parts
+            for (size_t i = 0; i < *num_parts; i++) {
+                free(parts[i]);
+            }
+            return false;
+        }
+
+        memcpy(parts[*num_parts], input + last_end_pos, part_length);
+        parts[*num_parts][part_length] = '\0';
+
+        (*num_parts)++;
+    }
+
+    return *num_parts > 0;
+}
+
+/**
+ * @brief State of a single-pass replacement
+ */
+typedef struct replace_state {
+    const char *input;                     /**< Input being rewritten */
+    const rift_replacement_t *replacement; /**< Template expanded for every match */
+    rift_output_buffer_t *output;          /**< Buffer receiving the result */
+    size_t copied;                         /**< Input position copied up to */
+    size_t count;                          /**< Number of replacements made */
+    bool failed;                           /**< Whether an append failed */
+} replace_state_t;
+
+/**
+ * @brief Copy the text before a match and append the expanded replacement
+ */
+static bool
+replace_match(const rift_regex_span_t *spans, size_t num_spans, void *user_data)
+{
+    replace_state_t *state = (replace_state_t *)user_data;
+
+    if (!rift_output_buffer_append(state->output, state->input + state->copied,
+                                   spans[0].start - state->copied) ||
+        !rift_replacement_expand(state->replacement, state->input, spans, num_spans,
+                                 state->output)) {
+        state->failed = true;
+        return false;
+    }
+
+    state->copied = spans[0].end;
+    state->count++;
+    return true;
+}
+
+/**
+ * @brief Replace every match, appending the result to a growable buffer
+ *
+ * @param matcher The matcher
+ * @param replacement The compiled replacement template
+ * @param output The buffer to append to
+ * @param num_replacements Pointer to store the number of replacements made (can be NULL)
+ * @return true if successful, false on invalid parameters or allocation failure
+ */
+bool
+rift_matcher_replace_into(rift_regex_matcher_t *matcher, const rift_replacement_t *replacement,
+                          rift_output_buffer_t *output, size_t *num_replacements)
+{
+    if (!matcher || !matcher->context || !replacement || !output) {
+        return false;
+    }
+
+    replace_state_t state = {rift_matcher_context_get_input(matcher->context),
+                             replacement,
+                             output,
+                             0,
+                             0,
+                             false};
+
+    if (!rift_matcher_for_each_match(matcher, replace_match, &state) || state.failed) {
+        return false;
+    }
+
+    // Copy the text after the last match
+    size_t input_length = rift_matcher_context_get_input_length(matcher->context);
+    if (!rift_output_buffer_append(output, state.input + state.copied,
+                                   input_length - state.copied)) {
+        return false;
+    }
+
+    if (num_replacements) {
+        *num_replacements = state.count;
+    }
+    return true;
+}
+
+/**
+ * @brief State of a span-only split
+ */
+typedef struct split_state {
+    rift_regex_span_t *parts; /**< Array receiving the parts */
+    size_t max_parts;         /**< Number of entries in parts */
+    size_t count;             /**< Number of parts stored */
+    size_t part_start;        /**< Start of the part being collected */
+} split_state_t;
+
+/**
+ * @brief Store the part ending at a delimiter match
+ */
+static bool
+split_match(const rift_regex_span_t *spans, size_t num_spans, void *user_data)
+{
+    split_state_t *state = (split_state_t *)user_data;
+    (void)num_spans;
+
+    state->parts[state->count].start = state->part_start;
+    state->parts[state->count].end = spans[0].start;
+    state->count++;
+    state->part_start = spans[0].end;
+
+    // The last entry is kept for the rest of the input
+    return state->count < state->max_parts - 1;
+}
+
+/**
+ * @brief Split the input around the matches, returning spans into the input
+ *
+ * @param matcher The matcher
+ * @param parts Array to store the parts
+ * @param max_parts Number of entries in parts
+ * @param num_parts Pointer to store the number of parts
+ * @return true if at least one part was found, false otherwise
+ */
+bool
+rift_matcher_split_spans(rift_regex_matcher_t *matcher, rift_regex_span_t *parts,
+                         size_t max_parts, size_t *num_parts)
+{
+    if (!matcher || !matcher->context || !parts || max_parts == 0 || !num_parts) {
+        return false;
+    }
+
+    split_state_t state = {parts, max_parts, 0, 0};
+    if (max_parts > 1 && !rift_matcher_for_each_match(matcher, split_match, &state)) {
+        return false;
+    }
+
+    // Add the rest of the input unless it is empty
+    size_t input_length = rift_matcher_context_get_input_length(matcher->context);
+    if (state.part_start < input_length) {
+        parts[state.count].start = state.part_start;
+        parts[state.count].end = input_length;
+        state.count++;
+    }
+
+    *num_parts = state.count;
+    return state.count > 0;
+}
+
+/**
+ * @brief Set matcher options
+ *
+ * @param matcher The matcher
+ * @param options The options to set
+ * @return true if successful, false otherwise
+ */
+bool
+rift_matcher_set_options(rift_regex_matcher_t *matcher, rift_matcher_option_t options)
+{
+    if (!matcher) {
+        return false;
+    }
+
+    matcher->options = options;
+    return true;
+}
+
+/**
+ * @brief Set the maximum backtracking depth
+ *
+ * @param matcher The matcher
+ * @param max_depth The maximum depth
+ * @return true if successful, false otherwise
+ */
+bool
+rift_matcher_set_max_backtrack_depth(rift_regex_matcher_t *matcher, size_t max_depth)
+{
+    if (!matcher || !matcher->backtrack_stack) {
+        return false;
+    }
+
+    return rift_backtrack_stack_set_max_depth(matcher->backtrack_stack, max_depth);
+}
+
+/**
+ * @brief Get the current backtracking depth
+ *
+ * @param matcher The matcher
+ * @return The current backtracking depth
+ */
+size_t
+rift_matcher_get_backtrack_depth(const rift_regex_matcher_t *matcher)
+{
+    return rift_backtrack_stack_get_depth(matcher ? matcher->backtrack_stack : NULL);
+}
+
+/**
+ * @brief Set a timeout for matching operations
+ *
+ * @param matcher The matcher
+ * @param timeout_ms Timeout in milliseconds (0 for no timeout)
+ * @return true if successful, false otherwise
+ */
+bool
+rift_matcher_set_timeout(rift_regex_matcher_t *matcher, uint32_t timeout_ms)
+{
+    if (!matcher) {
+        return false;
+    }
+
+    matcher->timeout_ms = timeout_ms;
+    return true;
+}
+
+/**
+ * @brief Check if a timeout occurred during the last matching operation
+ *
+ * @param matcher The matcher
+ * @return true if a timeout occurred, false otherwise
+ */
+bool
+rift_matcher_timed_out(const rift_regex_matcher_t *matcher)
+{
+    if (!matcher) {
+        return false;
+    }
+
+    return matcher->timed_out;
+}
+
+/**
+ * @brief Set an absolute deadline for matching operations
+ *
+ * @param matcher The matcher
+ * @param deadline_ns Deadline from rift_matcher_monotonic_ns, or
+ *                    RIFT_MATCHER_NO_DEADLINE
+ * @return true if successful, false otherwise
+ */
+bool
+rift_matcher_set_deadline(rift_regex_matcher_t *matcher, uint64_t deadline_ns)
+{
+    if (!matcher) {
+        return false;
+    }
+
+    matcher->request_deadline_ns = deadline_ns;
+    matcher->deadline_ns = deadline_ns;
+    return true;
+}
+
+/**
+ * @brief Let another thread cancel matching operations through a flag
+ *
+ * @param matcher The matcher
+ * @param cancel_flag The flag, or NULL to stop watching one
+ * @return true if successful, false otherwise
+ */
+bool
+rift_matcher_set_cancel_flag(rift_regex_matcher_t *matcher, const atomic_bool *cancel_flag)
+{
+    if (!matcher) {
+        return false;
+    }
+
+    matcher->cancel_flag = cancel_flag;
+    return true;
+}
+
+/**
+ * @brief Set when a backtracking attempt moves to the Pike VM
+ *
+ * @param matcher The matcher
+ * @param steps_per_byte Steps per byte before switching, 0 to never switch
+ * @return true if successful, false otherwise
  */
 bool
-rift_matcher_find_all(rift_regex_matcher_t *matcher, rift_regex_match_t *matches,
-                      size_t max_matches, size_t *num_matches)
+rift_matcher_set_engine_switch(rift_regex_matcher_t *matcher, uint32_t steps_per_byte)
 {
-    if (!matcher || !matches || !num_matches || max_matches == 0) {
+    if (!matcher) {
         return false;
     }
 
-    // Reset the matcher to the beginning of the input
-    rift_matcher_context_set_position(matcher->context, 0);
-
-    // Initialize the match count
-    *num_matches = 0;
-
-    // Find all matches, up to max_matches
-    while (*num_matches < max_matches) {
-        // Check for timeout
-        if (check_timeout(matcher)) {
-            return *num_matches > 0;
-        }
-
-        // Try to find the next match
-        if (!rift_matcher_find_next(matcher, &matches[*num_matches])) {
-            break;
-        }
+    matcher->switch_steps_per_byte = steps_per_byte;
+    return true;
+}
 
-        // Increment the match count
-        (*num_matches)++;
+/**
+ * @brief Take the backtracking limits from a registry
+ *
+ * @param matcher The matcher
+ * @param registry The registry, or NULL to stop using one
+ * @param pattern_id Pattern identifier to resolve
+ * @param match_id Match identifier to resolve
+ * @return true if successful, false otherwise
+ */
+bool
+rift_matcher_set_limit_registry(rift_regex_matcher_t *matcher,
+                                const rift_backtrack_limit_registry_t *registry,
+                                uint32_t pattern_id, uint32_t match_id)
+{
+    if (!matcher) {
+        return false;
+    }
 
-        // Set the next start position to avoid overlapping matches
-        // To avoid infinite loops, we advance at least one character
-        size_t next_pos = matches[*num_matches - 1].end_pos;
-        if (next_pos <= rift_matcher_context_get_position(matcher->context)) {
-            next_pos = rift_matcher_context_get_position(matcher->context) + 1;
-        }
+    matcher->limit_registry = registry;
+    matcher->limit_pattern_id = pattern_id;
+    matcher->limit_match_id = match_id;
+    memset(&matcher->limits, 0, sizeof(matcher->limits));
 
-        // If we've reached the end of the input, we're done
-        if (next_pos >= rift_matcher_context_get_input_length(matcher->context)) {
-            break;
-        }
+    // Resolve now so the first match only compares generations
+    refresh_limits(matcher);
+    apply_memory_budget(matcher);
+    return true;
+}
 
-        rift_matcher_context_set_position(matcher->context, next_pos);
+/**
+ * @brief Allocate the matcher's engines and buffers through an allocator
+ *
+ * @param matcher The matcher
+ * @param allocator The allocator, or NULL for the one in use on the thread
+ * @return true if successful, false otherwise
+ */
+bool
+rift_matcher_set_allocator(rift_regex_matcher_t *matcher, const rift_allocator_t *allocator)
+{
+    if (!matcher) {
+        return false;
     }
 
-    return *num_matches > 0;
+    matcher->allocator = allocator;
+    return true;
 }
 
 /**
- * @brief Replace occurrences of the pattern in the input string
+ * @brief Bound the memory a search's engines may use
  *
  * @param matcher The matcher
- * @param replacement The replacement string
- * @param output Buffer to store the result
- * @param output_size Size of the output buffer
- * @param num_replacements Pointer to store the number of replacements made
+ * @param max_bytes The budget in bytes, 0 for none
  * @return true if successful, false otherwise
  */
 bool
-rift_matcher_replace(rift_regex_matcher_t *matcher, const char *replacement, char *output,
-                     size_t output_size, size_t *num_replacements)
+rift_matcher_set_memory_budget(rift_regex_matcher_t *matcher, size_t max_bytes)
 {
-    if (!matcher || !replacement || !output || output_size == 0 || !num_replacements) {
+    if (!matcher) {
         return false;
     }
 
-    // Reset the matcher to the beginning of the input
-    rift_matcher_context_set_position(matcher->context, 0);
-
-    // Get the input string
-    const char *input = rift_matcher_context_get_input(matcher->context);
-    size_t input_length = rift_matcher_context_get_input_length(matcher->context);
-
-    // Initialize counters
-    *num_replacements = 0;
-    size_t output_pos = 0;
-    size_t last_copy_pos = 0;
-
-    // Find all matches and replace them
-    rift_regex_match_t match;
-    while (rift_matcher_find_next(matcher, &match)) {
-        // Check for timeout
-        if (check_timeout(matcher)) {
-            break;
-        }
-
-        // Copy the text between the last match and this match
-        size_t to_copy = match.start_pos - last_copy_pos;
-        if (output_pos + to_copy >= output_size) {
-            // Not enough space
-            return false;
-        }
-        memcpy(output + output_pos, input + last_copy_pos, to_copy);
-        output_pos += to_copy;
+    matcher->memory_budget = max_bytes;
+    apply_memory_budget(matcher);
+    return true;
+}
 
-        // Copy the replacement text
-        size_t replacement_len = strlen(replacement);
-        if (output_pos + replacement_len >= output_size) {
-            // Not enough space
-            return false;
-        }
-        memcpy(output + output_pos, replacement, replacement_len);
-        output_pos += replacement_len;
+/** Magic number of a DFA cache file, "RFMC" */
+#define MATCHER_DFA_CACHE_MAGIC 0x52464d43u
 
-        // Update counters
-        (*num_replacements)++;
-        last_copy_pos = match.end_pos;
+/** Format version of a DFA cache file */
+#define MATCHER_DFA_CACHE_VERSION 1u
 
-        // Set the next start position
-        // To avoid infinite loops, we advance at least one character
-        size_t next_pos = match.end_pos;
-        if (next_pos <= rift_matcher_context_get_position(matcher->context)) {
-            next_pos = rift_matcher_context_get_position(matcher->context) + 1;
-        }
+/** Lazy DFAs kept in a cache file, in file order */
+#define MATCHER_DFA_CACHE_SECTIONS 3
 
-        // If we've reached the end of the input, we're done
-        if (next_pos >= input_length) {
-            break;
-        }
+/**
+ * @brief Write the state cache of a lazy DFA as a sized section
+ *
+ * @param file The cache file
+ * @param lazy The lazy DFA, or NULL for an empty section
+ * @return true if written, false otherwise
+ */
+static bool
+write_dfa_cache_section(FILE *file, const rift_lazy_dfa_t *lazy)
+{
+    size_t size = 0;
+    if (lazy && !rift_lazy_dfa_save_cache(lazy, NULL, &size)) {
+        return false;
+    }
 
-        rift_matcher_context_set_position(matcher->context, next_pos);
+    uint8_t *data = size > 0 ? malloc(size) : NULL;
+    if (size > 0 && (!data || !rift_lazy_dfa_save_cache(lazy, data, &size))) {
+        free(data);
+        return false;
     }
 
-    // Copy any remaining text
-    size_t to_copy = input_length - last_copy_pos;
-    if (output_pos + to_copy >= output_size) {
-        // Not enough space
+    uint64_t length = size;
+    bool success =
+        fwrite(&length, sizeof(length), 1, file) == 1 && fwrite(data, 1, size, file) == size;
+    free(data);
+    return success;
+}
+
+/**
+ * @brief Save the lazy DFA state caches of a matcher to a file
+ *
+ * @param matcher The matcher
+ * @param path Path of the cache file
+ * @return true if saved, false otherwise
+ */
+bool
+rift_matcher_save_dfa_cache(const rift_regex_matcher_t *matcher, const char *path)
+{
+    if (!matcher || !path) {
         return false;
     }
-    memcpy(output + output_pos, input + last_copy_pos, to_copy);
-    output_pos += to_copy;
 
-    // Null-terminate the output
-    if (output_pos >= output_size) {
-        output[output_size - 1] = '\0';
-    } else {
-        output[output_pos] = '\0';
+    FILE *file = fopen(path, "wb");
+    if (!file) {
+        return false;
     }
 
-    return true;
+    uint32_t header[2] = {MATCHER_DFA_CACHE_MAGIC, MATCHER_DFA_CACHE_VERSION};
+    bool success = fwrite(header, sizeof(header), 1, file) == 1 &&
+                   write_dfa_cache_section(file, matcher->lazy_dfa) &&
+                   write_dfa_cache_section(file, matcher->forward_dfa) &&
+                   write_dfa_cache_section(file, matcher->reverse_dfa);
+    return fclose(file) == 0 && success;
 }
 
 /**
- * @brief Split the input string using the pattern as a delimiter
+ * @brief Load the lazy DFA state caches of a matcher from a file
  *
  * @param matcher The matcher
- * @param parts Array to store the resulting parts
- * @param max_parts Maximum number of parts to return
- * @param num_parts Pointer to store the number of parts
- * @return true if successful, false otherwise
+ * @param path Path of the cache file
+ * @return true if loaded, false otherwise
  */
 bool
-rift_matcher_split(rift_regex_matcher_t *matcher, char **parts, size_t max_parts, size_t *num_parts)
+rift_matcher_load_dfa_cache(rift_regex_matcher_t *matcher, const char *path)
 {
-    if (!matcher || !parts || max_parts == 0 || !num_parts) {
+    if (!matcher || !path) {
         return false;
     }
 
-    // Reset the matcher to the beginning of the input
-    rift_matcher_context_set_position(matcher->context, 0);
-
-    // Get the input string
-    const char *input = rift_matcher_context_get_input(matcher->context);
-    size_t input_length = rift_matcher_context_get_input_length(matcher->context);
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
 
-    // Initialize counters
-    *num_parts = 0;
-    size_t last_end_pos = 0;
+    uint32_t header[2];
+    if (fread(header, sizeof(header), 1, file) != 1 || header[0] != MATCHER_DFA_CACHE_MAGIC ||
+        header[1] != MATCHER_DFA_CACHE_VERSION) {
+        fclose(file);
+        return false;
+    }
 
-    // Find all matches and split the string
-    rift_regex_match_t match;
-    while (*num_parts < max_parts - 1 && rift_matcher_find_next(matcher, &match)) {
-        // Check for timeout
-        if (check_timeout(matcher)) {
+    // Build the DFAs a search needing no captures would, so the sections have a target
+    bool bounds_only = matcher->bounds_only;
+    matcher->bounds_only = true;
+    get_reverse_search(matcher);
+    matcher->bounds_only = bounds_only;
+
+    rift_lazy_dfa_t *targets[MATCHER_DFA_CACHE_SECTIONS] = {
+        matcher->lazy_dfa, matcher->forward_dfa, matcher->reverse_dfa};
+    const rift_allocator_t *outer = matcher_allocator_enter(matcher);
+    bool success = true;
+    for (size_t i = 0; success && i < MATCHER_DFA_CACHE_SECTIONS; i++) {
+        uint64_t length = 0;
+        if (fread(&length, sizeof(length), 1, file) != 1 || length > SIZE_MAX) {
+            success = false;
             break;
         }
-
-        // Create a part from the text between the last match and this match
-        size_t part_length = match.start_pos - last_end_pos;
-        parts[*num_parts] = (char *)malloc(part_length + 1);
-        if (!parts[*num_parts]) {
-            // Cleanup allocated parts
-            for (size_t i = 0; i < *num_parts; i++) {
-                free(parts[i]);
-            }
-            return false;
-        }
-
-        memcpy(parts[*num_parts], input + last_end_pos, part_length);
-        parts[*num_parts][part_length] = '\0';
-
-        (*num_parts)++;
-        last_end_pos = match.end_pos;
-
-        // Set the next start position
-        // To avoid infinite loops, we advance at least one character
-        size_t next_pos = match.end_pos;
-        if (next_pos <= rift_matcher_context_get_position(matcher->context)) {
-            next_pos = rift_matcher_context_get_position(matcher->context) + 1;
-        }
-
-        // If we've reached the end of the input, we're done
-        if (next_pos >= input_length) {
-            break;
+        if (length == 0) {
+            continue;
         }
 
-        rift_matcher_context_set_position(matcher->context, next_pos);
+        // Sections for DFAs this matcher does not use are skipped
+        size_t size = (size_t)length;
+        uint8_t *data = malloc(size);
+        success = data && fread(data, 1, size, file) == size &&
+                  (!targets[i] || rift_lazy_dfa_load_cache(targets[i], data, size, NULL));
+        free(data);
     }
+    rift_allocator_use(outer);
 
-    // Add the last part if there's room and it's not empty
-    if (*num_parts < max_parts && last_end_pos < input_length) {
-        size_t part_length = input_length - last_end_pos;
-        parts[*num_parts] = (char *)malloc(part_length + 1);
-        if (!parts[*num_parts]) {
-            // Cleanup allocated parts
-            for (size_t i = 0; i < *num_parts; i++) {
-                free(parts[i]);
-            }
-            return false;
-        }
-
-        memcpy(parts[*num_parts], input + last_end_pos, part_length);
-        parts[*num_parts][part_length] = '\0';
+    fclose(file);
+    return success;
+}
 
-        (*num_parts)++;
+/**
+ * @brief Turn per-search telemetry on or off
+ *
+ * @param matcher The matcher
+ * @param enabled Whether to record telemetry
+ * @return true if successful, false otherwise
+ */
+bool
+rift_matcher_set_stats_enabled(rift_regex_matcher_t *matcher, bool enabled)
+{
+    if (!matcher) {
+        return false;
     }
 
-    return *num_parts > 0;
+    matcher->stats_enabled = enabled;
+    return true;
 }
 
 /**
- * @brief Set matcher options
+ * @brief Get the telemetry of the latest search
  *
  * @param matcher The matcher
- * @param options The options to set
+ * @param stats Pointer to store the counters
  * @return true if successful, false otherwise
  */
 bool
-rift_matcher_set_options(rift_regex_matcher_t *matcher, rift_matcher_option_t options)
+rift_matcher_get_stats(const rift_regex_matcher_t *matcher, rift_match_stats_t *stats)
 {
-    if (!matcher) {
+    if (!matcher || !stats) {
         return false;
     }
 
-    matcher->options = options;
+    *stats = matcher->stats;
     return true;
 }
 
 /**
- * @brief Set the maximum backtracking depth
+ * @brief Get the telemetry summed over every search recorded by a matcher
  *
  * @param matcher The matcher
- * @param max_depth The maximum depth
+ * @param stats Pointer to store the counters
  * @return true if successful, false otherwise
  */
 bool
-rift_matcher_set_max_backtrack_depth(rift_regex_matcher_t *matcher, size_t max_depth)
+rift_matcher_get_total_stats(const rift_regex_matcher_t *matcher, rift_match_stats_t *stats)
 {
-    if (!matcher || !matcher->backtracker) {
+    if (!matcher || !stats) {
         return false;
     }
 
-    return rift_backtracker_set_max_depth(matcher->backtracker, max_depth);
+    *stats = matcher->stats_total;
+    return true;
 }
 
 /**
- * @brief Get the current backtracking depth
+ * @brief Clear the telemetry of a matcher
  *
  * @param matcher The matcher
- * @return The current backtracking depth
  */
-size_t
-rift_matcher_get_backtrack_depth(const rift_regex_matcher_t *matcher)
+void
+rift_matcher_reset_stats(rift_regex_matcher_t *matcher)
 {
-    if (!matcher || !matcher->backtracker) {
-        return 0;
+    if (matcher) {
+        rift_match_stats_reset(&matcher->stats);
+        rift_match_stats_reset(&matcher->stats_total);
     }
-
-    return rift_backtracker_get_depth(matcher->backtracker);
 }
 
 /**
- * @brief Set a timeout for matching operations
+ * @brief Record the searches of a matcher into a trace buffer
  *
  * @param matcher The matcher
- * @param timeout_ms Timeout in milliseconds (0 for no timeout)
+ * @param trace The buffer, not owned, or NULL to stop recording
  * @return true if successful, false otherwise
  */
 bool
-rift_matcher_set_timeout(rift_regex_matcher_t *matcher, uint32_t timeout_ms)
+rift_matcher_set_trace(rift_regex_matcher_t *matcher, struct rift_trace_buffer *trace)
 {
     if (!matcher) {
         return false;
     }
 
-    matcher->timeout_ms = timeout_ms;
+    matcher->trace = trace;
     return true;
 }
 
 /**
- * @brief Check if a timeout occurred during the last matching operation
+ * @brief Count the searches of a matcher in a metrics registry
  *
  * @param matcher The matcher
- * @return true if a timeout occurred, false otherwise
+ * @param metrics The registry, not owned, or NULL to stop counting
+ * @param pattern_id Identifier from rift_metrics_register_pattern()
+ * @return true if successful, false otherwise
  */
 bool
-rift_matcher_timed_out(const rift_regex_matcher_t *matcher)
+rift_matcher_set_metrics(rift_regex_matcher_t *matcher, struct rift_metrics *metrics,
+                         uint32_t pattern_id)
 {
     if (!matcher) {
         return false;
     }
 
-    return matcher->timed_out;
+    matcher->metrics = metrics;
+    matcher->metrics_pattern_id = pattern_id;
+    return true;
 }
 
 /**
@@ -942,6 +3494,7 @@ rift_matcher_set_position(rift_regex_matcher_t *matcher, size_t position)
         return false;
     }
 
+    matcher->step_pending = false;
     return rift_matcher_context_set_position(matcher->context, position);
 }
 
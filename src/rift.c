@@ -59,19 +59,9 @@ src/rift.h"
          return true;
      }
      
-     /* Initialize bytecode system */
-     if (!rift_bytecode_system_initialize()) {
-         return false;
-     }
-     
-     /* Initialize memory management system */
-     /* The memory system initialization would be called here if needed */
-     
-     /* Initialize the parser subsystem if needed */
-     /* Example: if (rift_parser_initialize() == false) return false; */
-     
-     /* Initialize the engine subsystem */
-     /* Example: if (rift_engine_initialize() == false) return false; */
+     /* The subsystems initialize themselves on first use, once per process,
+        so a program that only searches with the DFA never sets up bytecode,
+        baseline patterns or the syntax extension */
      
      /* Mark as initialized */
      g_librift_initialized = true;
@@ -33,9 +33,9 @@ rift_matcher_context_create(const char *input, size_t input_length, size_t max_c
         input_length = strlen(input);
     }
 
-    // Allocate the context structure
+    // Allocate the context structure from its pool
     rift_regex_matcher_context_t *context =
-        (rift_regex_matcher_context_t *)rift_malloc(sizeof(rift_regex_matcher_context_t));
+        (rift_regex_matcher_context_t *)rift_pool_alloc(sizeof(rift_regex_matcher_context_t));
     if (!context) {
         return NULL;
     }
@@ -52,7 +52,7 @@ rift_matcher_context_create(const char *input, size_t input_length, size_t max_c
     if (max_capture_groups > 0) {
         context->capture_groups = rift_capture_groups_create(max_capture_groups);
         if (!context->capture_groups) {
-            rift_free(context);
+            rift_pool_free(context, sizeof(rift_regex_matcher_context_t));
             return NULL;
         }
     }
@@ -77,8 +77,8 @@ rift_matcher_context_free(rift_regex_matcher_context_t *context)
         rift_capture_groups_free(context->capture_groups);
     }
 
-    // Free the context itself
-    rift_free(context);
+    // Return the context itself to its pool
+    rift_pool_free(context, sizeof(rift_regex_matcher_context_t));
 }
 
 /**
@@ -5,8 +5,11 @@ core/runtime/context_thread_safe_context.h"
  * @file thread_safe_context.c
  * @brief Implementation of thread-safe context for the LibRift regex engine
  *
- * This file implements the thread-safe context functions declared in
- * thread_safe_context.h for ensuring thread safety in the LibRift regex engine.
+ * Each thread keeps its matcher contexts in a thread-local cache of
+ * RIFT_THREAD_SAFE_CONTEXT_CACHE_SLOTS slots, indexed by context id. A slot
+ * remembers the reset generation its context was made for, so resetting
+ * every thread is one atomic increment, and no call on the match path
+ * takes a lock. One process-wide key frees a thread's cache when it exits.
  *
  * @copyright Copyright (c) 2025 LibRift Project
  * @license MIT License
@@ -16,21 +19,107 @@ ontext_thread_safe_context.h"/a #include "core/errors/error.h"
 #include "core/runtime/context.h"
 #include "Creating missing header: include/runtime/context_thread_safe_context.h
 #include "librift/runtime/thread_safe_context.h"
+#include "runtime/context_thread_safe_context.h"
+#include "core/automaton/pike_vm.h"
+#include "core/memory/memory.h"
+#include <stdlib.h>
+#include <string.h>
 
 /**
- * @brief Cleanup function for thread-local matcher context
+ * @brief Matcher context a thread caches for one thread-safe context
+ */
+typedef struct thread_cache_slot {
+    uint64_t owner;                        /**< Id of the thread-safe context, 0 when empty */
+    uint64_t generation;                   /**< Reset generation the context was made for */
+    rift_regex_matcher_context_t *context; /**< The thread's matcher context */
+    rift_pike_vm_t *vm;                    /**< The thread's Pike VM, built on first match */
+    size_t *vm_slots;                      /**< Capture slots of the VM's searches */
+} thread_cache_slot_t;
+
+/**
+ * @brief Matcher contexts of one thread
+ */
+typedef struct thread_cache {
+    thread_cache_slot_t slots[RIFT_THREAD_SAFE_CONTEXT_CACHE_SLOTS]; /**< Slots by context id */
+} thread_cache_t;
+
+/* The calling thread's cache, also registered with thread_cache_key for cleanup */
+static _Thread_local thread_cache_t *thread_cache = NULL;
+
+static pthread_key_t thread_cache_key;
+static pthread_once_t thread_cache_once = PTHREAD_ONCE_INIT;
+static bool thread_cache_key_created = false;
+
+/* Ids start at 1 so an empty slot never matches */
+static atomic_uint_fast64_t next_context_id = 1;
+
+/**
+ * @brief Free what a cache slot holds and mark it empty
  *
- * This function is registered with pthread_key_create() to ensure that
- * thread-local resources are cleaned up when a thread exits.
+ * @param slot The slot
+ */
+static void
+thread_cache_slot_clear(thread_cache_slot_t *slot)
+{
+    rift_matcher_context_free(slot->context);
+    rift_pike_vm_free(slot->vm);
+    free(slot->vm_slots);
+    memset(slot, 0, sizeof(*slot));
+}
+
+/**
+ * @brief Free a thread's cache when the thread exits
  *
- * @param context The thread-local matcher context to free
+ * @param cache The thread's cache
  */
 static void
-thread_local_context_cleanup(void *context)
+thread_cache_cleanup(void *cache)
 {
-    if (context) {
-        rift_matcher_context_free((rift_regex_matcher_context_t *)context);
+    thread_cache_t *thread_cache_ptr = (thread_cache_t *)cache;
+    for (size_t i = 0; i < RIFT_THREAD_SAFE_CONTEXT_CACHE_SLOTS; i++) {
+        thread_cache_slot_clear(&thread_cache_ptr->slots[i]);
+    }
+    free(thread_cache_ptr);
+}
+
+/**
+ * @brief Create the key that frees the threads' caches, once per process
+ */
+static void
+thread_cache_key_create(void)
+{
+    thread_cache_key_created = pthread_key_create(&thread_cache_key, thread_cache_cleanup) == 0;
+}
+
+/**
+ * @brief Get the calling thread's cache, creating it on first use
+ *
+ * @return The cache or NULL on failure
+ */
+static thread_cache_t *
+get_thread_cache(void)
+{
+    if (thread_cache) {
+        return thread_cache;
+    }
+
+    /* A cache that could not be freed at thread exit would leak its contexts */
+    if (pthread_once(&thread_cache_once, thread_cache_key_create) != 0 ||
+        !thread_cache_key_created) {
+        return NULL;
     }
+
+    thread_cache_t *cache = (thread_cache_t *)calloc(1, sizeof(thread_cache_t));
+    if (!cache) {
+        return NULL;
+    }
+    if (pthread_setspecific(thread_cache_key, cache) != 0) {
+        free(cache);
+        return NULL;
+    }
+
+    thread_cache = cache;
+    return cache;
 }
 
 /**
@@ -55,110 +144,159 @@ rift_thread_safe_context_create(rift_regex_automaton_t *automaton, size_t max_ca
         return NULL;
     }
 
-    /* Initialize the mutex */
+    /* Initialize the mutex, which only serves rift_thread_safe_context_lock */
     if (pthread_mutex_init(&ts_context->mutex, NULL) != 0) {
         rift_free(ts_context);
         return NULL;
     }
 
-    /* Initialize thread-local storage key */
-    if (pthread_key_create(&ts_context->thread_local_key, thread_local_context_cleanup) != 0) {
-        pthread_mutex_destroy(&ts_context->mutex);
-        rift_free(ts_context);
-        return NULL;
-    }
-
-    /* Initialize the global context as a fallback */
-    ts_context->global_ctx = rift_matcher_context_create(NULL, 0, max_capture_groups);
-    if (!ts_context->global_ctx) {
-        pthread_key_delete(ts_context->thread_local_key);
-        pthread_mutex_destroy(&ts_context->mutex);
-        rift_free(ts_context);
-        return NULL;
-    }
-
     /* Initialize other fields */
     ts_context->automaton = automaton;
-    ts_context->ref_count = 1;
-    ts_context->initialized = true;
+    ts_context->max_capture_groups = max_capture_groups;
     ts_context->max_backtrack_depth = max_backtrack_depth;
+    ts_context->id = atomic_fetch_add(&next_context_id, 1);
+    atomic_init(&ts_context->ref_count, 1);
+    atomic_init(&ts_context->generation, 0);
+    ts_context->initialized = true;
     rift_regex_error_clear(&ts_context->error);
 
     return ts_context;
 }
 
 /**
- * @brief Get the thread-local matcher context
+ * @brief Get the calling thread's cache slot for a context, resetting it if needed
  *
  * @param ts_context The thread-safe context
- * @return Pointer to the thread-local matcher context or NULL on failure
+ * @return The slot, holding a matcher context, or NULL on failure
  */
-rift_regex_matcher_context_t *
-rift_thread_safe_context_get_local(rift_regex_thread_safe_context_t *ts_context)
+static thread_cache_slot_t *
+get_thread_slot(rift_regex_thread_safe_context_t *ts_context)
 {
     if (!ts_context || !ts_context->initialized) {
         return NULL;
     }
 
-    /* Try to get the thread-local context */
-    rift_regex_matcher_context_t *local_ctx =
-        (rift_regex_matcher_context_t *)pthread_getspecific(ts_context->thread_local_key);
+    thread_cache_t *cache = get_thread_cache();
+    if (!cache) {
+        return NULL;
+    }
 
-    /* If no thread-local context exists, create one */
-    if (!local_ctx) {
-        /* Lock the mutex to ensure thread safety during creation */
-        if (pthread_mutex_lock(&ts_context->mutex) != 0) {
+    size_t index = (size_t)(ts_context->id % RIFT_THREAD_SAFE_CONTEXT_CACHE_SLOTS);
+    thread_cache_slot_t *slot = &cache->slots[index];
+    uint64_t generation = atomic_load_explicit(&ts_context->generation, memory_order_acquire);
+
+    if (slot->owner != ts_context->id) {
+        /* The slot belongs to another context, possibly one already freed */
+        thread_cache_slot_clear(slot);
+        slot->context = rift_matcher_context_create(NULL, 0, ts_context->max_capture_groups);
+        if (!slot->context) {
             return NULL;
         }
+        slot->owner = ts_context->id;
+        slot->generation = generation;
+    } else if (slot->generation != generation) {
+        /* rift_thread_safe_context_reset_all was called since this thread's last call */
+        rift_matcher_context_set_input(slot->context, NULL, 0);
+        rift_matcher_context_reset(slot->context, NULL);
+        slot->generation = generation;
+    }
+
+    return slot;
+}
+
+/**
+ * @brief Get the thread-local matcher context
+ *
+ * @param ts_context The thread-safe context
+ * @return Pointer to the thread-local matcher context or NULL on failure
+ */
+rift_regex_matcher_context_t *
+rift_thread_safe_context_get_local(rift_regex_thread_safe_context_t *ts_context)
+{
+    thread_cache_slot_t *slot = get_thread_slot(ts_context);
+    return slot ? slot->context : NULL;
+}
 
-        /* Create a new thread-local context with the same parameters as the global one */
-        local_ctx = rift_matcher_context_create(
-            rift_matcher_context_get_input(ts_context->global_ctx),
-            rift_matcher_context_get_input_length(ts_context->global_ctx),
-            ts_context->global_ctx->max_capture_groups);
+/**
+ * @brief Match an input with the calling thread's matcher state
+ *
+ * @param ts_context The thread-safe context
+ * @param input The input to match
+ * @param input_length Length of the input or (size_t)-1 to use strlen
+ * @param match Pointer to store the match (can be NULL)
+ * @return true if the automaton matched the input, false otherwise or on failure
+ */
+bool
+rift_thread_safe_context_match(rift_regex_thread_safe_context_t *ts_context, const char *input,
+                               size_t input_length, rift_regex_match_t *match)
+{
+    if (!input) {
+        return false;
+    }
+    if (input_length == (size_t)-1) {
+        input_length = strlen(input);
+    }
 
-        pthread_mutex_unlock(&ts_context->mutex);
+    thread_cache_slot_t *slot = get_thread_slot(ts_context);
+    if (!slot) {
+        return false;
+    }
 
-        if (!local_ctx) {
-            return NULL;
+    /* The VM freezes its own copy of the automaton, so threads never share one */
+    if (!slot->vm) {
+        rift_pike_vm_t *vm = rift_pike_vm_create(ts_context->automaton, NULL);
+        size_t *vm_slots =
+            vm ? (size_t *)malloc(rift_pike_vm_get_slot_count(vm) * sizeof(size_t)) : NULL;
+        if (!vm_slots) {
+            rift_pike_vm_free(vm);
+            return false;
         }
+        slot->vm = vm;
+        slot->vm_slots = vm_slots;
+    }
 
-        /* Associate the context with the thread-local storage */
-        if (pthread_setspecific(ts_context->thread_local_key, local_ctx) != 0) {
-            rift_matcher_context_free(local_ctx);
-            return NULL;
-        }
+    if (!rift_pike_vm_search(slot->vm, input, input_length, 0, false, false, slot->vm_slots)) {
+        return false;
     }
 
-    return local_ctx;
+    if (match) {
+        match->start_pos = slot->vm_slots[0];
+        match->end_pos = slot->vm_slots[1];
+        match->group_count = 0;
+        match->groups = NULL;
+    }
+    return true;
 }
 
 /**
- * @brief Execute a function with a thread-local matcher context
+ * @brief Execute a function on an input with a thread-local matcher context
  *
  * @param ts_context The thread-safe context
+ * @param input The input to match
+ * @param input_length Length of the input or (size_t)-1 to use strlen
  * @param callback Function to call with the thread-local context
  * @param user_data User-defined data to pass to the callback
  * @param error Pointer to store error information (can be NULL)
  * @return The return value from the callback, or false on error
  */
 bool
-rift_thread_safe_context_execute(rift_regex_thread_safe_context_t *ts_context,
+rift_thread_safe_context_execute(rift_regex_thread_safe_context_t *ts_context, const char *input,
+                                 size_t input_length,
                                  bool (*callback)(rift_regex_matcher_context_t *, void *,
                                                   rift_regex_error_t *),
                                  void *user_data, rift_regex_error_t *error)
 {
-    if (!ts_context || !callback) {
+    if (!ts_context || !callback || !input) {
         if (error) {
             rift_regex_error_set_with_message(error, RIFT_REGEX_ERROR_INVALID_PARAMETER,
-                                              "Invalid thread-safe context or callback");
+                                              "Invalid thread-safe context, input or callback");
         }
         return false;
     }
 
     /* Get the thread-local context */
     rift_regex_matcher_context_t *local_ctx = rift_thread_safe_context_get_local(ts_context);
-    if (!local_ctx) {
+    if (!local_ctx || !rift_matcher_context_set_input(local_ctx, input, input_length)) {
         if (error) {
             rift_regex_error_set_with_message(error, RIFT_REGEX_ERROR_INTERNAL,
                                               "Failed to get thread-local context");
@@ -171,7 +309,7 @@ rift_thread_safe_context_execute(rift_regex_thread_safe_context_t *ts_context,
 }
 
 /**
- * @brief Set the input string for the thread-safe context
+ * @brief Set the input string of the calling thread's matcher context
  *
  * @param ts_context The thread-safe context
  * @param input The input string to set
@@ -186,23 +324,8 @@ rift_thread_safe_context_set_input(rift_regex_thread_safe_context_t *ts_context,
         return false;
     }
 
-    /* Lock the mutex to ensure thread safety */
-    if (pthread_mutex_lock(&ts_context->mutex) != 0) {
-        return false;
-    }
-
-    /* Calculate input length if not provided */
-    if (input_length == (size_t)-1) {
-        input_length = strlen(input);
-    }
-
-    /* Set the input for the global context */
-    bool success = rift_matcher_context_set_input(ts_context->global_ctx, input, input_length);
-
-    /* Unlock the mutex */
-    pthread_mutex_unlock(&ts_context->mutex);
-
-    return success;
+    rift_regex_matcher_context_t *local_ctx = rift_thread_safe_context_get_local(ts_context);
+    return local_ctx && rift_matcher_context_set_input(local_ctx, input, input_length);
 }
 
 /**
@@ -217,17 +340,13 @@ rift_thread_safe_context_free(rift_regex_thread_safe_context_t *ts_context)
         return;
     }
 
+    /*
+     * Contexts cached by other threads are not reachable from here. Ids are
+     * never reused, so they are never handed out again, and they are freed
+     * when their thread exits or another context takes their slot.
+     */
     if (ts_context->initialized) {
-        /* Clean up thread-local storage key */
-        pthread_key_delete(ts_context->thread_local_key);
-
-        /* Clean up mutex */
         pthread_mutex_destroy(&ts_context->mutex);
-
-        /* Free the global context */
-        if (ts_context->global_ctx) {
-            rift_matcher_context_free(ts_context->global_ctx);
-        }
     }
 
     /* Free the thread-safe context itself */
@@ -247,19 +366,7 @@ rift_thread_safe_context_ref(rift_regex_thread_safe_context_t *ts_context)
         return 0;
     }
 
-    /* Lock the mutex to ensure thread safety */
-    if (pthread_mutex_lock(&ts_context->mutex) != 0) {
-        return 0;
-    }
-
-    /* Increment the reference count */
-    ts_context->ref_count++;
-    size_t new_count = ts_context->ref_count;
-
-    /* Unlock the mutex */
-    pthread_mutex_unlock(&ts_context->mutex);
-
-    return new_count;
+    return atomic_fetch_add_explicit(&ts_context->ref_count, 1, memory_order_relaxed) + 1;
 }
 
 /**
@@ -275,28 +382,22 @@ rift_thread_safe_context_unref(rift_regex_thread_safe_context_t *ts_context)
         return (size_t)-1;
     }
 
-    /* Lock the mutex to ensure thread safety */
-    if (pthread_mutex_lock(&ts_context->mutex) != 0) {
-        return (size_t)-1;
-    }
-
-    /* Decrement the reference count */
-    if (ts_context->ref_count > 0) {
-        ts_context->ref_count--;
-    }
-
-    size_t new_count = ts_context->ref_count;
-
-    /* Unlock the mutex */
-    pthread_mutex_unlock(&ts_context->mutex);
+    /* Never drop below zero, so a stray unref cannot free the context twice */
+    size_t count = atomic_load_explicit(&ts_context->ref_count, memory_order_relaxed);
+    do {
+        if (count == 0) {
+            return (size_t)-1;
+        }
+    } while (!atomic_compare_exchange_weak_explicit(&ts_context->ref_count, &count, count - 1,
+                                                    memory_order_acq_rel, memory_order_relaxed));
 
     /* Free the context if the reference count reached 0 */
-    if (new_count == 0) {
+    if (count == 1) {
         rift_thread_safe_context_free(ts_context);
         return (size_t)-1;
     }
 
-    return new_count;
+    return count - 1;
 }
 
 /**
@@ -308,32 +409,12 @@ rift_thread_safe_context_unref(rift_regex_thread_safe_context_t *ts_context)
 bool
 rift_thread_safe_context_reset_all(rift_regex_thread_safe_context_t *ts_context)
 {
-    if (!ts_context) {
-        return false;
-    }
-
-    /* Lock the mutex to ensure thread safety */
-    if (pthread_mutex_lock(&ts_context->mutex) != 0) {
-        return false;
-    }
-
-    /* Reset the global context */
-    rift_matcher_context_reset(ts_context->global_ctx, NULL);
-
-    /* We can't directly reset all thread-local contexts, as we don't have
-       access to them. Instead, we'll force threads to recreate their contexts
-       by removing the thread-local storage key and creating a new one. */
-    pthread_key_delete(ts_context->thread_local_key);
-    if (pthread_key_create(&ts_context->thread_local_key, thread_local_context_cleanup) != 0) {
-        /* If we failed to recreate the key, mark the context as uninitialized */
-        ts_context->initialized = false;
-        pthread_mutex_unlock(&ts_context->mutex);
+    if (!ts_context || !ts_context->initialized) {
         return false;
     }
 
-    /* Unlock the mutex */
-    pthread_mutex_unlock(&ts_context->mutex);
-
+    /* Each thread sees the new generation on its next call and resets its context */
+    atomic_fetch_add_explicit(&ts_context->generation, 1, memory_order_release);
     return true;
 }
 
@@ -13,6 +13,7 @@ core/runtime/groups.h"
 #include "runtime/groups.h
 #include <stdlib.h>
 #include <string.h>
+#include "core/memory/memory.h"
 #include "librift/runtime/groups.h"
 
 
@@ -29,7 +30,7 @@ rift_regex_capture_group_t *
 rift_capture_group_create(size_t index, const char *name, size_t start_pos, size_t end_pos)
 {
     rift_regex_capture_group_t *group =
-        (rift_regex_capture_group_t *)malloc(sizeof(rift_regex_capture_group_t));
+        (rift_regex_capture_group_t *)rift_pool_alloc(sizeof(rift_regex_capture_group_t));
 
     if (!group) {
         return NULL;
@@ -43,7 +44,7 @@ rift_capture_group_create(size_t index, const char *name, size_t start_pos, size
     if (name) {
         group->name = strdup(name);
         if (!group->name) {
-            free(group);
+            rift_pool_free(group, sizeof(rift_regex_capture_group_t));
             return NULL;
         }
     } else {
@@ -69,7 +70,7 @@ rift_capture_group_free(rift_regex_capture_group_t *group)
         free(group->name);
     }
 
-    free(group);
+    rift_pool_free(group, sizeof(rift_regex_capture_group_t));
 }
 
 /**
@@ -149,20 +150,26 @@ rift_capture_groups_create(size_t max_groups)
         return NULL;
     }
 
+    // The container and its array are pooled; the array is fixed at max_groups
     rift_regex_capture_groups_t *groups =
-        (rift_regex_capture_groups_t *)malloc(sizeof(rift_regex_capture_groups_t));
+        (rift_regex_capture_groups_t *)rift_pool_alloc(sizeof(rift_regex_capture_groups_t));
 
     if (!groups) {
         return NULL;
     }
 
     // Allocate the array for storing group pointers
-    groups->groups =
-        (rift_regex_capture_group_t **)calloc(max_groups, sizeof(rift_regex_capture_group_t *));
+    if (max_groups > SIZE_MAX / sizeof(rift_regex_capture_group_t *)) {
+        rift_pool_free(groups, sizeof(rift_regex_capture_groups_t));
+        return NULL;
+    }
+    size_t array_size = max_groups * sizeof(rift_regex_capture_group_t *);
+    groups->groups = (rift_regex_capture_group_t **)rift_pool_alloc(array_size);
     if (!groups->groups) {
-        free(groups);
+        rift_pool_free(groups, sizeof(rift_regex_capture_groups_t));
         return NULL;
     }
+    memset(groups->groups, 0, array_size);
 
     groups->count = 0;
     groups->capacity = max_groups;
@@ -189,10 +196,10 @@ rift_capture_groups_free(rift_regex_capture_groups_t *groups)
                 rift_capture_group_free(groups->groups[i]);
             }
         }
-        free(groups->groups);
+        rift_pool_free(groups->groups, groups->capacity * sizeof(rift_regex_capture_group_t *));
     }
 
-    free(groups);
+    rift_pool_free(groups, sizeof(rift_regex_capture_groups_t));
 }
 
 /**
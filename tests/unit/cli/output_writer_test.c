@@ -0,0 +1,190 @@
+/**
+ * @file output_writer_test.c
+ * @brief Unit tests for the buffered output writer of the CLI
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "cli/command/output_writer.h"
+#include "core/memory/memory.h"
+
+/* Read back what a writer wrote to a file */
+static size_t
+read_back(const char *path, char *buffer, size_t size)
+{
+    FILE *file = fopen(path, "rb");
+    assert(file != NULL);
+    size_t length = fread(buffer, 1, size - 1, file);
+    fclose(file);
+    buffer[length] = '\0';
+    return length;
+}
+
+/* Write two records, the second with nested containers */
+static void
+write_records(rift_output_writer_t *writer)
+{
+    assert(rift_output_writer_begin_record(writer));
+    assert(rift_output_writer_field_string(writer, "type", "CHAR", 4));
+    assert(rift_output_writer_field_uint(writer, "start", 3));
+    assert(rift_output_writer_end_record(writer));
+
+    assert(rift_output_writer_begin_record(writer));
+    assert(rift_output_writer_field_string(writer, "value", "a\"\n\x01", 4));
+    assert(rift_output_writer_field_int(writer, "delta", -2));
+    assert(rift_output_writer_begin_array(writer, "children"));
+    assert(rift_output_writer_begin_object(writer, NULL));
+    assert(rift_output_writer_field_bool(writer, "leaf", true));
+    assert(rift_output_writer_end_object(writer));
+    assert(rift_output_writer_field_uint(writer, NULL, 500));
+    assert(rift_output_writer_end_array(writer));
+    assert(rift_output_writer_end_record(writer));
+}
+
+/* Check the JSON encodings and their escapes */
+static void
+test_json_formats(void)
+{
+    char path[] = "/tmp/rift_output_writer_XXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+    char buffer[512];
+
+    rift_output_writer_t *writer = rift_output_writer_open(path, RIFT_OUTPUT_FORMAT_JSON);
+    assert(writer != NULL);
+    write_records(writer);
+    assert(rift_output_writer_close(writer));
+    read_back(path, buffer, sizeof(buffer));
+    assert(strcmp(buffer, "[\n{\"type\":\"CHAR\",\"start\":3},\n"
+                          "{\"value\":\"a\\\"\\n\\u0001\",\"delta\":-2,"
+                          "\"children\":[{\"leaf\":true},500]}\n]\n") == 0);
+
+    writer = rift_output_writer_open(path, RIFT_OUTPUT_FORMAT_NDJSON);
+    assert(writer != NULL);
+    write_records(writer);
+    assert(rift_output_writer_close(writer));
+    read_back(path, buffer, sizeof(buffer));
+    assert(strncmp(buffer, "{\"type\":\"CHAR\",\"start\":3}\n{\"value\":", 35) == 0);
+
+    /* An empty document is still valid JSON */
+    writer = rift_output_writer_open(path, RIFT_OUTPUT_FORMAT_JSON);
+    assert(writer != NULL);
+    assert(rift_output_writer_close(writer));
+    read_back(path, buffer, sizeof(buffer));
+    assert(strcmp(buffer, "[]\n") == 0);
+
+    remove(path);
+}
+
+/* Check the CBOR encoding byte for byte */
+static void
+test_cbor_format(void)
+{
+    char path[] = "/tmp/rift_output_writer_XXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+
+    rift_output_writer_t *writer = rift_output_writer_open(path, RIFT_OUTPUT_FORMAT_CBOR);
+    assert(writer != NULL);
+    write_records(writer);
+    assert(rift_output_writer_close(writer));
+
+    static const unsigned char expected[] = {
+        0xBF, 0x64, 't', 'y', 'p', 'e', 0x64, 'C', 'H', 'A', 'R', 0x65, 's', 't', 'a', 'r', 't',
+        0x03, 0xFF, 0xBF, 0x65, 'v', 'a', 'l', 'u', 'e', 0x64, 'a', '"', '\n', 0x01, 0x65, 'd',
+        'e', 'l', 't', 'a', 0x21, 0x68, 'c', 'h', 'i', 'l', 'd', 'r', 'e', 'n', 0x9F, 0xBF, 0x64,
+        'l', 'e', 'a', 'f', 0xF5, 0xFF, 0x19, 0x01, 0xF4, 0xFF, 0xFF,
+    };
+    char buffer[512];
+    size_t length = read_back(path, buffer, sizeof(buffer));
+    assert(length == sizeof(expected));
+    assert(memcmp(buffer, expected, length) == 0);
+
+    remove(path);
+}
+
+/* Check the text encoding, raw writes and misuse */
+static void
+test_text_format(void)
+{
+    char path[] = "/tmp/rift_output_writer_XXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+
+    rift_output_writer_t *writer = rift_output_writer_open(path, RIFT_OUTPUT_FORMAT_TEXT);
+    assert(writer != NULL);
+    assert(rift_output_writer_printf(writer, "tokens: %d\n", 2));
+    write_records(writer);
+
+    /* Fields need a record, and keys exactly in objects */
+    assert(!rift_output_writer_field_uint(writer, "orphan", 1));
+    assert(rift_output_writer_begin_record(writer));
+    assert(!rift_output_writer_field_uint(writer, NULL, 1));
+    assert(!rift_output_writer_end_array(writer));
+    assert(rift_output_writer_end_record(writer));
+    assert(rift_output_writer_close(writer));
+
+    char buffer[512];
+    read_back(path, buffer, sizeof(buffer));
+    assert(strcmp(buffer, "tokens: 2\ntype=CHAR start=3\n"
+                          "value=a\"\n\x01 delta=-2 children=[{leaf=true} 500]\n\n") == 0);
+
+    /* Output larger than the buffer arrives whole and in order */
+    writer = rift_output_writer_open(path, RIFT_OUTPUT_FORMAT_BINARY);
+    assert(writer != NULL);
+    assert(!rift_output_writer_begin_record(writer));
+    size_t size = RIFT_OUTPUT_WRITER_BUFFER_SIZE * 2 + 7;
+    char *data = rift_malloc(size);
+    assert(data != NULL);
+    for (size_t i = 0; i < size; i++) {
+        data[i] = (char)(i % 251);
+    }
+    assert(rift_output_writer_write(writer, "x", 1));
+    assert(rift_output_writer_write(writer, data, size));
+    assert(rift_output_writer_close(writer));
+
+    FILE *file = fopen(path, "rb");
+    assert(file != NULL);
+    char *back = rift_malloc(size + 1);
+    assert(back != NULL);
+    assert(fread(back, 1, size + 1, file) == size + 1);
+    fclose(file);
+    assert(back[0] == 'x' && memcmp(back + 1, data, size) == 0);
+    rift_free(back);
+    rift_free(data);
+
+    remove(path);
+}
+
+/* Check the names of the formats */
+static void
+test_format_names(void)
+{
+    rift_output_format_t format;
+    assert(rift_output_format_parse("ndjson", &format) && format == RIFT_OUTPUT_FORMAT_NDJSON);
+    assert(rift_output_format_parse("cbor", &format) && format == RIFT_OUTPUT_FORMAT_CBOR);
+    assert(!rift_output_format_parse("yaml", &format));
+    assert(strcmp(rift_output_format_name(RIFT_OUTPUT_FORMAT_BINARY), "binary") == 0);
+}
+
+int
+main(void)
+{
+    test_json_formats();
+    test_cbor_format();
+    test_text_format();
+    test_format_names();
+
+    printf("Output writer tests: PASSED\n");
+    return 0;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file automaton_describer_test.c
+ * @brief Unit tests for the lazy automaton describer
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cli/accessibility/automaton_describer.h"
+#include "core/automaton/automaton.h"
+#include "core/automaton/state.h"
+#include "core/automaton/transition.h"
+#include "core/memory/memory.h"
+
+/* Build a chain q0 -a-> q1 -b-> ... of a number of states */
+static rift_regex_automaton_t *
+build_chain(size_t num_states)
+{
+    rift_regex_automaton_t *automaton = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    assert(automaton != NULL);
+
+    rift_regex_state_t *previous = NULL;
+    for (size_t i = 0; i < num_states; i++) {
+        rift_regex_state_t *state = rift_automaton_create_state(automaton, i + 1 == num_states);
+        assert(state != NULL);
+        if (previous) {
+            char pattern[2] = {(char)('a' + i % 26), '\0'};
+            assert(rift_state_add_transition(previous, state, pattern));
+        } else {
+            automaton->initial_state = state;
+        }
+        previous = state;
+    }
+    return automaton;
+}
+
+/* Check that only the states asked for are described, once each */
+static void
+test_descriptions_are_lazy(void)
+{
+    rift_regex_automaton_t *automaton = build_chain(1000);
+    rift_automaton_describer_t *describer = rift_automaton_describer_create();
+    assert(describer != NULL);
+    assert(rift_automaton_describer_attach(describer, automaton));
+    assert(rift_automaton_describer_get_cached_count(describer) == 0);
+
+    const char *view[10];
+    assert(rift_automaton_describer_describe_range(describer, 0, 10, view) == 10);
+    assert(rift_automaton_describer_get_cached_count(describer) == 10);
+    assert(strstr(view[0], "initial") != NULL);
+    assert(strstr(view[0], "on \"b\" to state") != NULL);
+
+    /* Described again, the same text comes back */
+    assert(rift_automaton_describer_describe_state(describer, automaton->states[3]) == view[3]);
+    assert(rift_automaton_describer_get_cached_count(describer) == 10);
+
+    /* The range stops at the last state */
+    assert(rift_automaton_describer_describe_range(describer, 995, 10, view) == 5);
+    assert(strstr(view[4], "accepting. No transitions.") != NULL);
+
+    const char *summary = rift_automaton_describer_describe_summary(describer);
+    assert(summary != NULL);
+    assert(strstr(summary, "1000 states, 1 accepting, and 999 transitions") != NULL);
+
+    rift_automaton_describer_destroy(describer);
+    rift_automaton_free(automaton);
+}
+
+/* Check that changes drop only the descriptions they made stale */
+static void
+test_changes_invalidate(void)
+{
+    rift_regex_automaton_t *automaton = build_chain(4);
+    rift_automaton_describer_t *describer = rift_automaton_describer_create();
+    assert(describer != NULL);
+    assert(rift_automaton_describer_attach(describer, automaton));
+    rift_automaton_observer_t *observer = rift_automaton_describer_get_observer(describer);
+
+    const char *view[4];
+    assert(rift_automaton_describer_describe_range(describer, 0, 4, view) == 4);
+
+    rift_regex_state_t *state = automaton->states[2];
+    state->is_accepting = true;
+    rift_automaton_observer_notify_change(observer, automaton,
+                                          RIFT_AUTOMATON_CHANGE_STATE_MODIFIED, state);
+    assert(rift_automaton_describer_get_cached_count(describer) == 3);
+    assert(strstr(rift_automaton_describer_describe_state(describer, state), "accepting") != NULL);
+
+    /* A new transition changes the description of its source only */
+    assert(rift_state_add_transition(automaton->states[1], automaton->states[1], "x"));
+    rift_regex_state_t *source = automaton->states[1];
+    rift_automaton_observer_notify_change(observer, automaton,
+                                          RIFT_AUTOMATON_CHANGE_TRANSITION_ADDED,
+                                          source->transitions[source->num_transitions - 1]);
+    assert(rift_automaton_describer_get_cached_count(describer) == 3);
+    assert(strstr(rift_automaton_describer_describe_state(describer, source),
+                  "on \"x\" back to itself") != NULL);
+
+    /* A removed state takes the descriptions naming it along */
+    rift_automaton_observer_notify_change(observer, automaton, RIFT_AUTOMATON_CHANGE_STATE_REMOVED,
+                                          automaton->states[3]);
+    assert(rift_automaton_describer_get_cached_count(describer) == 2);
+
+    /* A whole-automaton update drops everything */
+    rift_automaton_observer_notify(observer, automaton);
+    assert(rift_automaton_describer_get_cached_count(describer) == 0);
+
+    rift_automaton_describer_destroy(describer);
+    rift_automaton_free(automaton);
+}
+
+int
+main(void)
+{
+    test_descriptions_are_lazy();
+    test_changes_invalidate();
+
+    printf("Automaton describer tests: PASSED\n");
+    return 0;
+}
@@ -0,0 +1,241 @@
+/**
+ * @file aho_corasick_test.c
+ * @brief Unit tests for Aho-Corasick literal matching in the LibRift regex engine
+ *
+ * This file contains test cases verifying that overlapping literals are all
+ * reported, that scans skipping to the bytes starting a literal miss none,
+ * and that automata are expanded into their literals or refused whole.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/automaton/aho_corasick.h"
+#include "core/automaton/automaton.h"
+#include "core/automaton/state.h"
+
+/* Scan a string and return the tags found, for tags below 64 */
+static uint64_t
+scan_tags(rift_aho_corasick_t *ac, const char *input)
+{
+    uint64_t tags = 0;
+    assert(rift_aho_corasick_scan(ac, input, strlen(input), &tags, 1));
+    return tags;
+}
+
+/* Build an NFA for the alternation of the literals, one branch per literal */
+static rift_regex_automaton_t *
+create_alternation(const char *const *literals, size_t count)
+{
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *start = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *end = rift_automaton_create_state(nfa, true);
+    for (size_t i = 0; i < count; i++) {
+        rift_regex_state_t *from = start;
+        for (const char *p = literals[i]; *p; p++) {
+            char pattern[2] = {*p, '\0'};
+            rift_regex_state_t *to = rift_automaton_create_state(nfa, false);
+            assert(rift_automaton_add_transition(nfa, from, to, pattern));
+            from = to;
+        }
+        assert(rift_automaton_create_epsilon_transition(nfa, from, end));
+    }
+    return nfa;
+}
+
+/* Test that literals ending inside one another are all reported */
+void
+test_aho_corasick_overlapping(void)
+{
+    rift_regex_error_t error = {0};
+    rift_aho_corasick_t *ac = rift_aho_corasick_create(&error);
+    assert(ac != NULL);
+    assert(rift_aho_corasick_add(ac, "he", 2, 0, &error));
+    assert(rift_aho_corasick_add(ac, "she", 3, 1, &error));
+    assert(rift_aho_corasick_add(ac, "his", 3, 2, &error));
+    assert(rift_aho_corasick_add(ac, "hers", 4, 3, &error));
+    assert(rift_aho_corasick_add(ac, "he", 2, 4, &error));
+
+    /* Scans need a build after the last literal */
+    uint64_t tags = 0;
+    assert(!rift_aho_corasick_scan(ac, "he", 2, &tags, 1));
+    assert(rift_aho_corasick_build(ac, &error));
+
+    /* The root, h, he, her, hers, hi, his, s, sh and she */
+    assert(rift_aho_corasick_get_state_count(ac) == 10);
+    assert(ac->num_start_bytes == 2);
+
+    assert(scan_tags(ac, "ushers") == 0x1B);
+    assert(scan_tags(ac, "this") == 0x04);
+    assert(scan_tags(ac, "hhhhe") == 0x11);
+    assert(scan_tags(ac, "sshe") == 0x13);
+    assert(scan_tags(ac, "hs, hi s, h e") == 0);
+    assert(scan_tags(ac, "") == 0);
+
+    rift_aho_corasick_free(ac);
+    printf("test_aho_corasick_overlapping: PASSED\n");
+}
+
+/* Test that scans skipping ahead and scans stepping every byte agree */
+void
+test_aho_corasick_start_bytes(void)
+{
+    static const char *const few[] = {"abc", "bcd", "cab"};
+    static const char *const many[] = {"abc", "bcd", "cab", "dab"};
+    static const char *const inputs[] = {"xxabcdxx", "cabcab", "xbcxcaxab", "dabc", "bcdab"};
+
+    rift_aho_corasick_t *skipping = rift_aho_corasick_create(NULL);
+    rift_aho_corasick_t *stepping = rift_aho_corasick_create(NULL);
+    for (uint32_t i = 0; i < 4; i++) {
+        if (i < 3) {
+            assert(rift_aho_corasick_add(skipping, few[i], 3, i, NULL));
+        }
+        assert(rift_aho_corasick_add(stepping, many[i], 3, i, NULL));
+    }
+    assert(rift_aho_corasick_build(skipping, NULL));
+    assert(rift_aho_corasick_build(stepping, NULL));
+    assert(skipping->num_start_bytes == 3);
+    assert(stepping->num_start_bytes > RIFT_AHO_CORASICK_MAX_START_BYTES);
+
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(*inputs); i++) {
+        assert(scan_tags(skipping, inputs[i]) == (scan_tags(stepping, inputs[i]) & 0x7));
+    }
+    assert(scan_tags(skipping, "xxabcdxx") == 0x3);
+    assert(scan_tags(stepping, "dabc") == 0x9);
+
+    rift_aho_corasick_free(skipping);
+    rift_aho_corasick_free(stepping);
+    printf("test_aho_corasick_start_bytes: PASSED\n");
+}
+
+/* Test expanding automata into their literals */
+void
+test_aho_corasick_automaton(void)
+{
+    static const char *const keywords[] = {"if", "else", "for"};
+    rift_regex_error_t error = {0};
+    rift_aho_corasick_t *ac = rift_aho_corasick_create(NULL);
+
+    rift_regex_automaton_t *nfa = create_alternation(keywords, 3);
+    assert(rift_aho_corasick_add_automaton(ac, nfa, 0, &error));
+    assert(ac->num_literals == 3);
+    rift_automaton_free(nfa);
+
+    /* A case-folded class expands to one literal per byte */
+    nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *start = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *middle = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *end = rift_automaton_create_state(nfa, true);
+    assert(rift_automaton_add_transition(nfa, start, middle, "[dD]"));
+    assert(rift_automaton_add_transition(nfa, middle, end, "[oO]"));
+    assert(rift_aho_corasick_add_automaton(ac, nfa, 1, &error));
+    assert(ac->num_literals == 7);
+    rift_automaton_free(nfa);
+
+    assert(rift_aho_corasick_build(ac, &error));
+    assert(scan_tags(ac, "for x do") == 0x3);
+    assert(scan_tags(ac, "Do elsewhere") == 0x3);
+    assert(scan_tags(ac, "iF dO") == 0x2);
+
+    rift_aho_corasick_free(ac);
+    printf("test_aho_corasick_automaton: PASSED\n");
+}
+
+/* Test that automata accepting more than literals are refused whole */
+void
+test_aho_corasick_refused(void)
+{
+    static const char *const words[] = {"ab", "cd"};
+    rift_regex_error_t error = {0};
+    rift_aho_corasick_t *ac = rift_aho_corasick_create(NULL);
+    assert(rift_aho_corasick_add(ac, "xy", 2, 0, NULL));
+
+    /* A loop back to the start: ab, abab, ... */
+    rift_regex_automaton_t *nfa = create_alternation(words, 2);
+    rift_regex_state_t *start = rift_automaton_get_state_by_index(nfa, 0);
+    rift_regex_state_t *end = rift_automaton_get_state_by_index(nfa, 1);
+    assert(rift_automaton_create_epsilon_transition(nfa, end, start));
+    assert(!rift_aho_corasick_add_automaton(ac, nfa, 1, &error));
+    assert(error.code == RIFT_REGEX_ERROR_LIMIT_EXCEEDED);
+    rift_automaton_free(nfa);
+
+    /* The empty string */
+    nfa = create_alternation(words, 2);
+    start = rift_automaton_get_state_by_index(nfa, 0);
+    end = rift_automaton_get_state_by_index(nfa, 1);
+    assert(rift_automaton_create_epsilon_transition(nfa, start, end));
+    error.code = RIFT_REGEX_ERROR_NONE;
+    assert(!rift_aho_corasick_add_automaton(ac, nfa, 1, &error));
+    assert(error.code == RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE);
+    rift_automaton_free(nfa);
+
+    /* An anchor */
+    nfa = create_alternation(words, 2);
+    start = rift_automaton_get_state_by_index(nfa, 0);
+    assert(rift_automaton_set_state_flag(start, RIFT_STATE_FLAG_ANCHOR_START));
+    error.code = RIFT_REGEX_ERROR_NONE;
+    assert(!rift_aho_corasick_add_automaton(ac, nfa, 1, &error));
+    assert(error.code == RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE);
+    rift_automaton_free(nfa);
+
+    /* An edge accepting any byte */
+    nfa = create_alternation(words, 2);
+    end = rift_automaton_get_state_by_index(nfa, 1);
+    rift_regex_state_t *after = rift_automaton_create_state(nfa, true);
+    assert(rift_automaton_add_transition(nfa, end, after, "."));
+    error.code = RIFT_REGEX_ERROR_NONE;
+    assert(!rift_aho_corasick_add_automaton(ac, nfa, 1, &error));
+    assert(error.code == RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE);
+    rift_automaton_free(nfa);
+
+    /* Nothing of the refused automata was kept */
+    assert(ac->num_literals == 1 && ac->tag_limit == 1);
+    assert(rift_aho_corasick_build(ac, NULL));
+    assert(scan_tags(ac, "abxycd") == 0x1);
+
+    rift_aho_corasick_free(ac);
+    printf("test_aho_corasick_refused: PASSED\n");
+}
+
+/* Test invalid arguments */
+void
+test_aho_corasick_invalid(void)
+{
+    rift_regex_error_t error = {0};
+    rift_aho_corasick_t *ac = rift_aho_corasick_create(NULL);
+    assert(!rift_aho_corasick_add(ac, "", 0, 0, &error));
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_PARAMETER);
+    assert(!rift_aho_corasick_add_automaton(ac, NULL, 0, &error));
+    assert(!rift_aho_corasick_build(NULL, &error));
+
+    /* Tags past the bitset are not written */
+    uint64_t tags[2] = {0};
+    assert(rift_aho_corasick_add(ac, "a", 1, 64, NULL));
+    assert(rift_aho_corasick_build(ac, NULL));
+    assert(!rift_aho_corasick_scan(ac, "a", 1, tags, 1));
+    assert(rift_aho_corasick_scan(ac, "a", 1, tags, 2));
+    assert(tags[0] == 0 && tags[1] == 1);
+
+    rift_aho_corasick_free(ac);
+    printf("test_aho_corasick_invalid: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running Aho-Corasick tests...\n");
+
+    test_aho_corasick_overlapping();
+    test_aho_corasick_start_bytes();
+    test_aho_corasick_automaton();
+    test_aho_corasick_refused();
+    test_aho_corasick_invalid();
+
+    printf("All Aho-Corasick tests PASSED!\n");
+    return 0;
+}
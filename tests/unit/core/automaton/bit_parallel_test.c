@@ -0,0 +1,238 @@
+/**
+ * @file bit_parallel_test.c
+ * @brief Unit tests for the bit-parallel NFA simulation of the LibRift regex engine
+ *
+ * This file contains test cases verifying the match bounds found by the
+ * bit-parallel simulation, agreement with the Pike VM at every start position
+ * of a set of inputs, and the position limit.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/automaton/automaton.h"
+#include "core/automaton/bit_parallel.h"
+#include "core/automaton/pike_vm.h"
+#include "core/automaton/state.h"
+
+/* Build an NFA for (a|ab)(c|bcd)d* */
+static rift_regex_automaton_t *
+create_alternation_nfa(void)
+{
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *start = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *m = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *middle = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *n1 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *n2 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *loop = rift_automaton_create_state(nfa, true);
+
+    assert(rift_automaton_add_transition(nfa, start, middle, "a"));
+    assert(rift_automaton_add_transition(nfa, start, m, "a"));
+    assert(rift_automaton_add_transition(nfa, m, middle, "b"));
+    assert(rift_automaton_add_transition(nfa, middle, loop, "c"));
+    assert(rift_automaton_add_transition(nfa, middle, n1, "b"));
+    assert(rift_automaton_add_transition(nfa, n1, n2, "c"));
+    assert(rift_automaton_add_transition(nfa, n2, loop, "d"));
+    assert(rift_automaton_add_transition(nfa, loop, loop, "d"));
+
+    return nfa;
+}
+
+/* Build an NFA for (x|y)*z?, which accepts the empty string */
+static rift_regex_automaton_t *
+create_optional_nfa(void)
+{
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *loop = rift_automaton_create_state(nfa, true);
+    rift_regex_state_t *end = rift_automaton_create_state(nfa, true);
+
+    assert(rift_automaton_add_transition(nfa, loop, loop, "x"));
+    assert(rift_automaton_add_transition(nfa, loop, loop, "y"));
+    assert(rift_automaton_add_transition(nfa, loop, end, "z"));
+
+    return nfa;
+}
+
+/* Build an NFA for [ab]*a[ab]{n}, with n + 2 positions */
+static rift_regex_automaton_t *
+create_exponential_nfa(int n)
+{
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *loop = rift_automaton_create_state(nfa, false);
+
+    assert(rift_automaton_add_transition(nfa, loop, loop, "[ab]"));
+    rift_regex_state_t *previous = rift_automaton_create_state(nfa, n == 0);
+    assert(rift_automaton_add_transition(nfa, loop, previous, "a"));
+    for (int i = 1; i <= n; i++) {
+        rift_regex_state_t *next = rift_automaton_create_state(nfa, i == n);
+        assert(rift_automaton_add_transition(nfa, previous, next, "[ab]"));
+        previous = next;
+    }
+    return nfa;
+}
+
+/* Compare the match ends with the Pike VM at every start of every input */
+static void
+assert_agrees_with_pike_vm(rift_regex_automaton_t *nfa, const char *const *inputs, size_t count)
+{
+    rift_bit_parallel_t *bit_parallel = rift_bit_parallel_create(nfa, NULL);
+    rift_pike_vm_t *vm = rift_pike_vm_create(nfa, NULL);
+    assert(bit_parallel != NULL && vm != NULL);
+
+    size_t *slots = malloc(rift_pike_vm_get_slot_count(vm) * sizeof(size_t));
+    assert(slots != NULL);
+    for (size_t i = 0; i < count; i++) {
+        size_t length = strlen(inputs[i]);
+        for (size_t start = 0; start <= length; start++) {
+            for (int earliest = 0; earliest < 2; earliest++) {
+                size_t end = 0;
+                bool want = rift_pike_vm_search(vm, inputs[i], length, start, true, earliest,
+                                                slots);
+                bool got = rift_bit_parallel_match_prefix(bit_parallel, inputs[i] + start,
+                                                          length - start, earliest, &end);
+                assert(want == got);
+                assert(!want || start + end == slots[1]);
+            }
+        }
+    }
+
+    free(slots);
+    rift_pike_vm_free(vm);
+    rift_bit_parallel_free(bit_parallel);
+}
+
+/* Test the match bounds of a pattern with alternatives and a loop */
+void
+test_bit_parallel_match(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa = create_alternation_nfa();
+
+    rift_bit_parallel_t *bit_parallel = rift_bit_parallel_create(nfa, &error);
+    assert(bit_parallel != NULL);
+    /* The two d edges into the loop share a position */
+    assert(rift_bit_parallel_get_position_count(bit_parallel) == 7);
+
+    size_t end = 0;
+    assert(rift_bit_parallel_match_prefix(bit_parallel, "abcdd", 5, false, &end));
+    assert(end == 5);
+    assert(rift_bit_parallel_match_prefix(bit_parallel, "abcdd", 5, true, &end));
+    assert(end == 3);
+    assert(rift_bit_parallel_match_prefix(bit_parallel, "acx", 3, false, &end));
+    assert(end == 2);
+
+    /* The match must start at the first byte */
+    assert(!rift_bit_parallel_match_prefix(bit_parallel, "xac", 3, false, &end));
+    assert(!rift_bit_parallel_match_prefix(bit_parallel, "ab", 2, false, &end));
+    assert(!rift_bit_parallel_match_prefix(bit_parallel, "", 0, false, &end));
+
+    rift_bit_parallel_free(bit_parallel);
+    rift_automaton_free(nfa);
+
+    /* An empty match is the shortest and is kept when nothing longer follows */
+    nfa = create_optional_nfa();
+    bit_parallel = rift_bit_parallel_create(nfa, NULL);
+    assert(bit_parallel != NULL);
+    assert(rift_bit_parallel_match_prefix(bit_parallel, "xyzx", 4, false, &end));
+    assert(end == 3);
+    assert(rift_bit_parallel_match_prefix(bit_parallel, "xyzx", 4, true, &end));
+    assert(end == 0);
+    assert(rift_bit_parallel_match_prefix(bit_parallel, "w", 1, false, &end));
+    assert(end == 0);
+    rift_bit_parallel_free(bit_parallel);
+    rift_automaton_free(nfa);
+
+    printf("test_bit_parallel_match: PASSED\n");
+}
+
+/* Test that the match ends are those of the Pike VM */
+void
+test_bit_parallel_matches_pike_vm(void)
+{
+    static const char *const alternation_inputs[] = {"", "ac", "abc", "abcd", "abcdd", "abbcd",
+                                                     "abcddx", "aabc", "xabcd"};
+    rift_regex_automaton_t *nfa = create_alternation_nfa();
+    assert_agrees_with_pike_vm(nfa, alternation_inputs,
+                               sizeof(alternation_inputs) / sizeof(*alternation_inputs));
+    rift_automaton_free(nfa);
+
+    static const char *const optional_inputs[] = {"", "x", "xyyx", "xz", "zx", "xyzz", "w"};
+    nfa = create_optional_nfa();
+    assert_agrees_with_pike_vm(nfa, optional_inputs,
+                               sizeof(optional_inputs) / sizeof(*optional_inputs));
+    rift_automaton_free(nfa);
+
+    /* Ten positions span two chunks of the follow tables */
+    static const char *const exponential_inputs[] = {"abababababab", "bbaabbbbbbbbb",
+                                                     "aaaaaaaaaaaaaa", "abbabbbbbbbbba", "ba"};
+    nfa = create_exponential_nfa(8);
+    assert_agrees_with_pike_vm(nfa, exponential_inputs,
+                               sizeof(exponential_inputs) / sizeof(*exponential_inputs));
+    rift_automaton_free(nfa);
+
+    printf("test_bit_parallel_matches_pike_vm: PASSED\n");
+}
+
+/* Test that an automaton with more positions than a word holds is refused */
+void
+test_bit_parallel_limits(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa = create_exponential_nfa(RIFT_BIT_PARALLEL_MAX_POSITIONS - 2);
+    rift_bit_parallel_t *bit_parallel = rift_bit_parallel_create(nfa, &error);
+    assert(bit_parallel != NULL);
+    assert(rift_bit_parallel_get_position_count(bit_parallel) ==
+           RIFT_BIT_PARALLEL_MAX_POSITIONS);
+    rift_bit_parallel_free(bit_parallel);
+    rift_automaton_free(nfa);
+
+    nfa = create_exponential_nfa(RIFT_BIT_PARALLEL_MAX_POSITIONS - 1);
+    assert(rift_bit_parallel_create(nfa, &error) == NULL);
+    assert(error.code == RIFT_REGEX_ERROR_LIMIT_EXCEEDED);
+    rift_automaton_free(nfa);
+
+    printf("test_bit_parallel_limits: PASSED\n");
+}
+
+/* Test invalid arguments */
+void
+test_bit_parallel_invalid(void)
+{
+    rift_regex_error_t error = {0};
+    assert(rift_bit_parallel_create(NULL, &error) == NULL);
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_PARAMETER);
+
+    rift_regex_automaton_t *nfa = create_alternation_nfa();
+    rift_bit_parallel_t *bit_parallel = rift_bit_parallel_create(nfa, NULL);
+    assert(bit_parallel != NULL);
+    assert(!rift_bit_parallel_match_prefix(bit_parallel, NULL, 2, false, NULL));
+    assert(rift_bit_parallel_match_prefix(bit_parallel, "ac", 2, false, NULL));
+    rift_bit_parallel_free(bit_parallel);
+    rift_automaton_free(nfa);
+
+    assert(!rift_bit_parallel_match_prefix(NULL, "a", 1, false, NULL));
+    assert(rift_bit_parallel_get_position_count(NULL) == 0);
+    rift_bit_parallel_free(NULL);
+
+    printf("test_bit_parallel_invalid: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running bit-parallel NFA tests...\n");
+
+    test_bit_parallel_match();
+    test_bit_parallel_matches_pike_vm();
+    test_bit_parallel_limits();
+    test_bit_parallel_invalid();
+
+    printf("All bit-parallel NFA tests PASSED!\n");
+    return 0;
+}
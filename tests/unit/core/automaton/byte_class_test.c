@@ -0,0 +1,267 @@
+/**
+ * @file byte_class_test.c
+ * @brief Unit tests for byte equivalence classes of the LibRift regex engine
+ *
+ * This file contains test cases verifying alphabet partitioning, the
+ * pattern form of each class and scans for the members of byte sets.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/automaton/automaton.h"
+#include "core/automaton/byte_class.h"
+#include "core/automaton/state.h"
+#include "core/automaton/transition.h"
+
+/* Check that a formatted class pattern accepts exactly the members of the class */
+static void
+assert_pattern_matches_class(rift_regex_state_t *state, const rift_byte_classes_t *classes,
+                             uint16_t class_index)
+{
+    char pattern[RIFT_BYTE_CLASS_MAX_PATTERN_LENGTH];
+    assert(rift_byte_classes_format_pattern(classes, class_index, pattern, sizeof(pattern)) > 0);
+
+    rift_regex_transition_t *transition = rift_transition_create(state, state, pattern);
+    assert(transition != NULL);
+    for (int c = 1; c < RIFT_BYTE_CLASS_ALPHABET_SIZE; c++) {
+        assert(rift_transition_matches_char(transition, (char)c) ==
+               (classes->map[c] == class_index));
+    }
+    rift_transition_free(transition);
+}
+
+/* Test refinement of the alphabet */
+void
+test_byte_classes_refine(void)
+{
+    rift_byte_classes_t classes;
+    bool members[RIFT_BYTE_CLASS_ALPHABET_SIZE] = {false};
+
+    rift_byte_classes_init(&classes);
+    assert(classes.num_classes == 1);
+
+    members['a'] = true;
+    members['b'] = true;
+    rift_byte_classes_refine(&classes, members);
+    assert(classes.num_classes == 2);
+    assert(classes.map['a'] == classes.map['b']);
+    assert(classes.map['a'] != classes.map['c']);
+
+    /* Refining with the same set again must not split anything */
+    rift_byte_classes_refine(&classes, members);
+    assert(classes.num_classes == 2);
+
+    members['a'] = false;
+    rift_byte_classes_refine(&classes, members);
+    assert(classes.num_classes == 3);
+    assert(classes.representatives[classes.map['b']] == 'b');
+    assert(classes.representatives[classes.map['\0']] == 1);
+
+    printf("test_byte_classes_refine: PASSED\n");
+}
+
+/* Test classes computed from an automaton */
+void
+test_byte_classes_compute(void)
+{
+    rift_regex_error_t error = {0};
+    rift_byte_classes_t classes;
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *s0 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s1 = rift_automaton_create_state(nfa, true);
+
+    assert(rift_automaton_add_transition(nfa, s0, s1, "[a-z]"));
+    assert(rift_automaton_add_transition(nfa, s1, s1, "[0-9]"));
+    assert(rift_automaton_add_transition(nfa, s1, s0, NULL));
+
+    assert(rift_byte_classes_compute(nfa, &classes, &error));
+    assert(classes.num_classes == 3);
+    assert(classes.map['a'] == classes.map['z']);
+    assert(classes.map['0'] == classes.map['9']);
+    assert(classes.map['A'] == classes.map['-']);
+    assert(classes.map['a'] != classes.map['0']);
+
+    for (uint16_t k = 0; k < classes.num_classes; k++) {
+        assert_pattern_matches_class(s0, &classes, k);
+    }
+
+    assert(!rift_byte_classes_compute(NULL, &classes, &error));
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_PARAMETER);
+
+    rift_automaton_free(nfa);
+    printf("test_byte_classes_compute: PASSED\n");
+}
+
+/* Test patterns for bytes with special meaning */
+void
+test_byte_classes_format_special(void)
+{
+    const char *sets[] = {"^", "^-", "]^-[", "[:", ".", "\\", "a-z"};
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *state = rift_automaton_create_state(nfa, false);
+
+    for (size_t i = 0; i < sizeof(sets) / sizeof(sets[0]); i++) {
+        rift_byte_classes_t classes;
+        bool members[RIFT_BYTE_CLASS_ALPHABET_SIZE] = {false};
+        for (const char *p = sets[i]; *p; p++) {
+            members[(unsigned char)*p] = true;
+        }
+
+        rift_byte_classes_init(&classes);
+        rift_byte_classes_refine(&classes, members);
+        for (uint16_t k = 0; k < classes.num_classes; k++) {
+            assert_pattern_matches_class(state, &classes, k);
+        }
+    }
+
+    rift_automaton_free(nfa);
+    printf("test_byte_classes_format_special: PASSED\n");
+}
+
+/* Test that subset construction emits one transition per class */
+void
+test_byte_classes_nfa_to_dfa(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *s0 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s1 = rift_automaton_create_state(nfa, true);
+
+    assert(rift_automaton_add_transition(nfa, s0, s1, "[a-z]"));
+    assert(rift_automaton_add_transition(nfa, s1, s1, "[a-z]"));
+
+    rift_regex_automaton_t *dfa = rift_automaton_nfa_to_dfa(nfa, &error);
+    assert(dfa != NULL);
+    assert(rift_automaton_get_state_count(dfa) == 2);
+
+    rift_regex_state_t *start = rift_automaton_get_initial_state(dfa);
+    assert(rift_state_get_transition_count(start) == 1);
+    rift_regex_transition_t *transition = rift_state_get_transition(start, 0);
+    assert(rift_transition_matches_char(transition, 'q'));
+    assert(!rift_transition_matches_char(transition, 'Q'));
+
+    rift_automaton_free(dfa);
+    rift_automaton_free(nfa);
+    printf("test_byte_classes_nfa_to_dfa: PASSED\n");
+}
+
+/* Test byte set scans over runs longer and shorter than one SIMD block */
+void
+test_byte_set_scan(void)
+{
+    uint32_t set[RIFT_BYTE_SET_WORDS] = {0};
+    for (const char *c = "0123456789"; *c; c++) {
+        set[(unsigned char)*c >> 5] |= (uint32_t)1 << ((unsigned char)*c & 31);
+    }
+    set[0xE9 >> 5] |= (uint32_t)1 << (0xE9 & 31);
+
+    char input[80];
+    memset(input, 'x', sizeof(input));
+    input[37] = '7';
+    assert(rift_byte_set_find(set, input, 0, sizeof(input)) == 37);
+    assert(rift_byte_set_find(set, input, 38, sizeof(input)) == sizeof(input));
+    assert(rift_byte_set_find(set, input, 0, 37) == 37);
+    input[70] = (char)0xE9;
+    assert(rift_byte_set_find(set, input, 38, sizeof(input)) == 70);
+
+    memset(input, '5', sizeof(input));
+    input[53] = (char)0x80;
+    assert(rift_byte_set_span(set, input, 0, sizeof(input)) == 53);
+    assert(rift_byte_set_span(set, input, 54, sizeof(input)) == sizeof(input));
+    assert(rift_byte_set_span(set, input, 3, 9) == 9);
+    assert(rift_byte_set_span(set, "a5", 0, 2) == 0);
+
+    printf("test_byte_set_scan: PASSED\n");
+}
+
+/* Test that byte edges to one target are merged and disjoint edges sorted */
+void
+test_byte_transitions_optimize(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *s0 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s1 = rift_automaton_create_state(nfa, true);
+    assert(rift_automaton_add_transition(nfa, s0, s1, "a"));
+    assert(rift_automaton_add_transition(nfa, s0, s1, "c"));
+    assert(rift_automaton_add_transition(nfa, s0, s1, "b"));
+
+    /* Subset construction gives one edge per class; they all lead to one state */
+    rift_regex_automaton_t *dfa = rift_automaton_nfa_to_dfa(nfa, &error);
+    assert(dfa != NULL);
+    rift_regex_state_t *start = rift_automaton_get_initial_state(dfa);
+    assert(rift_state_get_transition_count(start) == 1);
+    rift_regex_transition_t *transition = rift_state_get_transition(start, 0);
+    assert(rift_transition_matches_char(transition, 'a'));
+    assert(rift_transition_matches_char(transition, 'c'));
+    assert(!rift_transition_matches_char(transition, 'd'));
+    rift_automaton_free(dfa);
+    rift_automaton_free(nfa);
+
+    /* Edges in between that take none of the merged bytes are passed over, and the
+     * disjoint edges before the b edge are sorted */
+    nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    s0 = rift_automaton_create_state(nfa, false);
+    s1 = rift_automaton_create_state(nfa, true);
+    rift_regex_state_t *s2 = rift_automaton_create_state(nfa, true);
+    assert(rift_automaton_add_transition(nfa, s0, s1, "x"));
+    assert(rift_automaton_add_transition(nfa, s0, s2, "[a-c]"));
+    assert(rift_automaton_add_transition(nfa, s0, s1, "y"));
+    assert(rift_automaton_add_transition(nfa, s0, s1, "b"));
+    assert(rift_automaton_optimize_transitions(nfa));
+    assert(rift_state_get_transition_count(s0) == 3);
+    assert(rift_state_get_transition(s0, 0)->to_state == s2);
+    transition = rift_state_get_transition(s0, 1);
+    assert(transition->to_state == s1);
+    assert(rift_transition_matches_char(transition, 'x'));
+    assert(rift_transition_matches_char(transition, 'y'));
+
+    /* The edge taking b stays behind [a-c], which a search must try first */
+    transition = rift_state_get_transition(s0, 2);
+    assert(transition->to_state == s1);
+    assert(rift_transition_matches_char(transition, 'b'));
+    assert(!rift_transition_matches_char(transition, 'x'));
+    rift_automaton_free(nfa);
+
+    /* Epsilon edges end merging and sorting; runs before them are sorted */
+    nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    s0 = rift_automaton_create_state(nfa, false);
+    s1 = rift_automaton_create_state(nfa, true);
+    s2 = rift_automaton_create_state(nfa, true);
+    assert(rift_automaton_add_transition(nfa, s0, s2, "z"));
+    assert(rift_automaton_add_transition(nfa, s0, s1, "m"));
+    assert(rift_automaton_create_epsilon_transition(nfa, s0, s2));
+    assert(rift_automaton_add_transition(nfa, s0, s1, "n"));
+    assert(rift_automaton_optimize_transitions(nfa));
+    assert(rift_state_get_transition_count(s0) == 4);
+    assert(rift_transition_matches_char(rift_state_get_transition(s0, 0), 'm'));
+    assert(rift_transition_matches_char(rift_state_get_transition(s0, 1), 'z'));
+    assert(rift_transition_is_epsilon(rift_state_get_transition(s0, 2)));
+    assert(rift_transition_matches_char(rift_state_get_transition(s0, 3), 'n'));
+    rift_automaton_free(nfa);
+
+    assert(!rift_automaton_optimize_transitions(NULL));
+    printf("test_byte_transitions_optimize: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running byte class tests...\n");
+
+    test_byte_classes_refine();
+    test_byte_classes_compute();
+    test_byte_classes_format_special();
+    test_byte_classes_nfa_to_dfa();
+    test_byte_set_scan();
+    test_byte_transitions_optimize();
+
+    printf("All byte class tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,256 @@
+/**
+ * @file compact_dfa_test.c
+ * @brief Unit tests for the compressed DFA table forms of the LibRift regex engine
+ *
+ * This file contains test cases verifying that every layout steps exactly
+ * like the dense table it was built from, and that budgets pick the fastest
+ * layout that fits.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/automaton/compact_dfa.h"
+
+/* Build a table with the given dimensions, all rows dead and none accepting */
+static rift_dfa_table_t *
+create_table(uint32_t num_states, uint32_t num_classes)
+{
+    rift_dfa_table_t *table = calloc(1, sizeof(rift_dfa_table_t));
+    assert(table != NULL);
+    table->num_states = num_states;
+    table->num_classes = num_classes;
+    table->start_state = 1;
+    for (int b = 0; b < RIFT_DFA_ALPHABET_SIZE; b++) {
+        table->byte_class[b] = (uint8_t)(b % num_classes);
+    }
+    table->next = calloc((size_t)num_states * num_classes, sizeof(uint32_t));
+    table->accept_bitmap = calloc((num_states + 63) / 64, sizeof(uint64_t));
+    assert(table->next && table->accept_bitmap);
+    return table;
+}
+
+static void
+destroy_table(rift_dfa_table_t *table)
+{
+    free(table->next);
+    free(table->accept_bitmap);
+    free(table);
+}
+
+/*
+ * Build the table of a keyword trie over the classes: each row goes back to
+ * the start row on most classes, like a search DFA, and on to a child on a
+ * few. Every eighth row accepts.
+ */
+static rift_dfa_table_t *
+create_trie_table(uint32_t num_states, uint32_t num_classes)
+{
+    rift_dfa_table_t *table = create_table(num_states, num_classes);
+    uint32_t child = 2;
+    srand(7);
+    for (uint32_t row = 1; row < num_states; row++) {
+        uint32_t *next = table->next + (size_t)row * num_classes;
+        for (uint32_t k = 0; k < num_classes; k++) {
+            next[k] = k % 5 == 4 ? RIFT_DFA_DEAD_STATE : 1;
+        }
+        for (int i = 0; i < 3 && child < num_states; i++) {
+            next[(uint32_t)rand() % num_classes] = child++;
+        }
+        if (row % 8 == 0) {
+            table->accept_bitmap[row / 64] |= (uint64_t)1 << (row % 64);
+        }
+    }
+    return table;
+}
+
+/* Build a table of random sparse rows */
+static rift_dfa_table_t *
+create_random_table(uint32_t num_states, uint32_t num_classes, unsigned seed)
+{
+    rift_dfa_table_t *table = create_table(num_states, num_classes);
+    srand(seed);
+    for (uint32_t row = 1; row < num_states; row++) {
+        uint32_t *next = table->next + (size_t)row * num_classes;
+        for (uint32_t k = 0; k < num_classes; k++) {
+            next[k] = rand() % 3 == 0 ? (uint32_t)rand() % num_states : RIFT_DFA_DEAD_STATE;
+        }
+        if (rand() % 4 == 0) {
+            table->accept_bitmap[row / 64] |= (uint64_t)1 << (row % 64);
+        }
+    }
+    return table;
+}
+
+/* Check every cell and acceptance of every layout against the table, by the rows of the IDs */
+static void
+check_layouts(const rift_dfa_table_t *table)
+{
+    for (int layout = 0; layout < RIFT_DFA_LAYOUT_COUNT; layout++) {
+        rift_compact_dfa_t *dfa = rift_compact_dfa_create(table, (rift_dfa_layout_t)layout, NULL);
+        assert(dfa != NULL);
+        assert(dfa->layout == (rift_dfa_layout_t)layout);
+        assert(rift_compact_dfa_row(dfa, dfa->start_state) == table->start_state);
+        assert(rift_compact_dfa_row(dfa, RIFT_DFA_DEAD_STATE) == RIFT_DFA_DEAD_STATE);
+
+        for (uint32_t i = 0; i < table->num_states; i++) {
+            uint32_t state = i * dfa->stride;
+            uint32_t row = rift_compact_dfa_row(dfa, state);
+            bool accepting = rift_dfa_table_is_accepting(table, row);
+            assert(rift_compact_dfa_is_accepting(dfa, state) == accepting);
+            assert(accepting == (state != RIFT_DFA_DEAD_STATE && state < dfa->special_limit));
+            for (int b = 0; b < RIFT_DFA_ALPHABET_SIZE; b++) {
+                uint32_t next = rift_compact_dfa_next(dfa, state, (uint8_t)b);
+                assert(rift_compact_dfa_row(dfa, next) ==
+                       rift_dfa_table_next(table, row, (uint8_t)b));
+            }
+        }
+        assert(rift_compact_dfa_next(dfa, table->num_states * dfa->stride, 'a') ==
+               RIFT_DFA_DEAD_STATE);
+        assert(rift_compact_dfa_memory_usage(dfa) > 0);
+        rift_compact_dfa_free(dfa);
+    }
+}
+
+/* Test that every layout agrees with the dense table */
+void
+test_compact_dfa_layouts(void)
+{
+    rift_dfa_table_t *trie = create_trie_table(500, 40);
+    check_layouts(trie);
+    destroy_table(trie);
+
+    for (unsigned seed = 1; seed <= 3; seed++) {
+        rift_dfa_table_t *random = create_random_table(200, 1 + seed * 30, seed);
+        check_layouts(random);
+        destroy_table(random);
+    }
+
+    /* One class and the dead row alone */
+    rift_dfa_table_t *tiny = create_table(2, 1);
+    tiny->next[1] = 1;
+    check_layouts(tiny);
+    destroy_table(tiny);
+
+    printf("test_compact_dfa_layouts: PASSED\n");
+}
+
+/* Test that dense IDs take the narrowest width and are premultiplied */
+void
+test_compact_dfa_widths(void)
+{
+    static const uint32_t dimensions[][3] = {{10, 20, 1}, {1000, 40, 2}, {2000, 64, 4}};
+    for (size_t i = 0; i < 3; i++) {
+        rift_dfa_table_t *table = create_trie_table(dimensions[i][0], dimensions[i][1]);
+        rift_compact_dfa_t *dfa = rift_compact_dfa_create(table, RIFT_DFA_LAYOUT_DENSE, NULL);
+        assert(dfa != NULL);
+        assert(dfa->id_width == dimensions[i][2]);
+        assert(dfa->stride == dimensions[i][1]);
+        assert(dfa->start_state % dfa->stride == 0);
+        assert(rift_compact_dfa_memory_usage(dfa) ==
+               sizeof(rift_compact_dfa_t) + table->num_states * sizeof(uint32_t) +
+                   (size_t)table->num_states * table->num_classes * dfa->id_width);
+
+        /* Not a multiple of the stride, so not an ID */
+        assert(rift_compact_dfa_next(dfa, dfa->start_state + 1, 'a') == RIFT_DFA_DEAD_STATE);
+        assert(!rift_compact_dfa_is_accepting(dfa, dfa->stride * 8 + 1));
+        rift_compact_dfa_free(dfa);
+        destroy_table(table);
+    }
+    printf("test_compact_dfa_widths: PASSED\n");
+}
+
+/* Test that the scans give the answers of the dense table */
+void
+test_compact_dfa_scan(void)
+{
+    rift_dfa_table_t *table = create_trie_table(300, 26);
+    char input[64];
+    srand(11);
+
+    for (int layout = 0; layout < RIFT_DFA_LAYOUT_COUNT; layout++) {
+        rift_compact_dfa_t *dfa = rift_compact_dfa_create(table, (rift_dfa_layout_t)layout, NULL);
+        assert(dfa != NULL);
+        for (int i = 0; i < 200; i++) {
+            size_t length = (size_t)rand() % sizeof(input);
+            for (size_t k = 0; k < length; k++) {
+                input[k] = (char)('a' + rand() % 26);
+            }
+
+            size_t expected_end = 0;
+            size_t end = 0;
+            assert(rift_compact_dfa_matches(dfa, input, length) ==
+                   rift_dfa_table_matches(table, input, length));
+            assert(rift_compact_dfa_longest_prefix(dfa, input, length, &end) ==
+                   rift_dfa_table_longest_prefix(table, input, length, &expected_end));
+            assert(end == expected_end);
+        }
+        assert(!rift_compact_dfa_matches(dfa, NULL, 1));
+        rift_compact_dfa_free(dfa);
+    }
+
+    destroy_table(table);
+    printf("test_compact_dfa_scan: PASSED\n");
+}
+
+/* Test that a budget picks the fastest layout fitting in it */
+void
+test_compact_dfa_budget(void)
+{
+    rift_dfa_table_t *table = create_trie_table(2000, 64);
+    rift_regex_error_t error;
+
+    /* No budget keeps the dense layout */
+    rift_compact_dfa_t *dense = rift_compact_dfa_create_with_budget(table, 0, NULL);
+    assert(dense != NULL && dense->layout == RIFT_DFA_LAYOUT_DENSE);
+    size_t dense_size = rift_compact_dfa_memory_usage(dense);
+    rift_compact_dfa_free(dense);
+
+    size_t sizes[RIFT_DFA_LAYOUT_COUNT];
+    for (int layout = 0; layout < RIFT_DFA_LAYOUT_COUNT; layout++) {
+        rift_compact_dfa_t *dfa = rift_compact_dfa_create(table, (rift_dfa_layout_t)layout, NULL);
+        sizes[layout] = rift_compact_dfa_memory_usage(dfa);
+        rift_compact_dfa_free(dfa);
+    }
+    assert(sizes[RIFT_DFA_LAYOUT_DENSE] == dense_size);
+
+    /* Rows that mostly repeat the start row shrink most with default chains */
+    assert(sizes[RIFT_DFA_LAYOUT_DEFAULT_CHAIN] < sizes[RIFT_DFA_LAYOUT_RANGES]);
+    assert(sizes[RIFT_DFA_LAYOUT_RANGES] < dense_size);
+
+    for (int layout = 0; layout < RIFT_DFA_LAYOUT_COUNT; layout++) {
+        rift_compact_dfa_t *dfa = rift_compact_dfa_create_with_budget(table, sizes[layout], NULL);
+        assert(dfa != NULL);
+        assert(dfa->layout <= (rift_dfa_layout_t)layout);
+        assert(rift_compact_dfa_memory_usage(dfa) <= sizes[layout]);
+        rift_compact_dfa_free(dfa);
+    }
+
+    /* Nothing fits in a few bytes */
+    assert(rift_compact_dfa_create_with_budget(table, 64, &error) == NULL);
+    assert(error.code == RIFT_REGEX_ERROR_LIMIT_EXCEEDED);
+
+    assert(rift_compact_dfa_create(NULL, RIFT_DFA_LAYOUT_DENSE, &error) == NULL);
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_PARAMETER);
+    assert(strcmp(rift_dfa_layout_name(RIFT_DFA_LAYOUT_DEFAULT_CHAIN), "default-chain") == 0);
+
+    destroy_table(table);
+    printf("test_compact_dfa_budget: PASSED\n");
+}
+
+int
+main(void)
+{
+    test_compact_dfa_layouts();
+    test_compact_dfa_widths();
+    test_compact_dfa_scan();
+    test_compact_dfa_budget();
+
+    printf("\nAll compact DFA tests passed!\n");
+    return 0;
+}
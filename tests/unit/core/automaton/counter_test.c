@@ -0,0 +1,273 @@
+/**
+ * @file counter_test.c
+ * @brief Unit tests for counted repetition in the LibRift regex automaton
+ *
+ * This file contains test cases verifying how counted loops are marked,
+ * which of them are unrolled, how the frozen layout records them and that
+ * an unrolled loop matches exactly the repetitions its bounds allow.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/automaton/automaton.h"
+#include "core/automaton/counter.h"
+#include "core/automaton/frozen_automaton.h"
+#include "core/automaton/state.h"
+#include "core/automaton/transition.h"
+
+/* States of a counted loop over a body, as the compiler builds them */
+typedef struct {
+    rift_regex_automaton_t *nfa;
+    rift_regex_state_t *start;
+    rift_regex_state_t *body;
+    rift_regex_state_t *step;
+    rift_regex_state_t *leave;
+} counted_loop_t;
+
+/* Build an NFA for a{min,max}, or ()?{min,max} with an empty body */
+static counted_loop_t
+create_counted_loop(uint32_t min, uint32_t max, bool greedy, bool empty_body)
+{
+    counted_loop_t loop;
+    loop.nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    assert(loop.nfa != NULL);
+
+    loop.start = rift_automaton_create_state(loop.nfa, false);
+    loop.body = rift_automaton_create_state(loop.nfa, false);
+    loop.step = rift_automaton_create_state(loop.nfa, false);
+    loop.leave = rift_automaton_create_state(loop.nfa, true);
+    assert(loop.start && loop.body && loop.step && loop.leave);
+
+    assert(rift_automaton_set_initial_state(loop.nfa, loop.start));
+    assert(rift_automaton_add_transition(loop.nfa, loop.body, loop.step,
+                                         empty_body ? NULL : "a"));
+
+    /* The repeat edge comes first on greedy loops */
+    rift_regex_state_t *junctions[] = {loop.start, loop.step};
+    for (size_t i = 0; i < 2; i++) {
+        rift_regex_state_t *first = greedy ? loop.body : loop.leave;
+        rift_regex_state_t *second = greedy ? loop.leave : loop.body;
+        assert(rift_automaton_add_transition(loop.nfa, junctions[i], first, NULL));
+        assert(rift_automaton_add_transition(loop.nfa, junctions[i], second, NULL));
+    }
+
+    assert(rift_counter_mark(loop.start, loop.step, min, max, greedy));
+    return loop;
+}
+
+/* Add the epsilon closure of a state of a frozen automaton to a set */
+static void
+add_closure(const rift_frozen_automaton_t *frozen, uint32_t state, bool *set)
+{
+    if (set[state]) {
+        return;
+    }
+    set[state] = true;
+
+    for (uint32_t edge = frozen->edge_offsets[state]; edge < frozen->edge_offsets[state + 1];
+         edge++) {
+        if (rift_frozen_automaton_edge_is_epsilon(frozen, edge)) {
+            add_closure(frozen, frozen->edge_targets[edge], set);
+        }
+    }
+}
+
+/* Check whether an automaton without counters matches the whole input */
+static bool
+full_match(const rift_regex_automaton_t *nfa, const char *input)
+{
+    rift_regex_error_t error = {0};
+    rift_frozen_automaton_t *frozen = rift_frozen_automaton_create(nfa, &error);
+    assert(frozen != NULL);
+    assert(frozen->num_counters == 0);
+
+    bool *current = (bool *)calloc(frozen->num_states, sizeof(bool));
+    bool *next = (bool *)calloc(frozen->num_states, sizeof(bool));
+    assert(current && next);
+    add_closure(frozen, frozen->start_state, current);
+
+    for (const char *c = input; *c; c++) {
+        memset(next, 0, frozen->num_states * sizeof(bool));
+        for (uint32_t state = 0; state < frozen->num_states; state++) {
+            if (!current[state]) {
+                continue;
+            }
+            for (uint32_t edge = frozen->edge_offsets[state];
+                 edge < frozen->edge_offsets[state + 1]; edge++) {
+                if (!rift_frozen_automaton_edge_is_epsilon(frozen, edge) &&
+                    rift_transition_predicate_test(&frozen->edge_predicates[edge],
+                                                   (unsigned char)*c)) {
+                    add_closure(frozen, frozen->edge_targets[edge], next);
+                }
+            }
+        }
+
+        bool *swap = current;
+        current = next;
+        next = swap;
+    }
+
+    bool matched = false;
+    for (uint32_t state = 0; state < frozen->num_states; state++) {
+        matched = matched || (current[state] && rift_frozen_automaton_is_accepting(frozen, state));
+    }
+
+    free(current);
+    free(next);
+    rift_frozen_automaton_free(frozen);
+    return matched;
+}
+
+/* Check a{min,max} against runs of 0 to limit a's */
+static void
+check_repetitions(const rift_regex_automaton_t *nfa, uint32_t min, uint32_t max, size_t limit)
+{
+    char input[64];
+    assert(limit < sizeof(input));
+
+    for (size_t length = 0; length <= limit; length++) {
+        memset(input, 'a', length);
+        input[length] = '\0';
+        bool expected = length >= min && (max == RIFT_COUNTER_UNBOUNDED || length <= max);
+        assert(full_match(nfa, input) == expected);
+    }
+}
+
+/* Test marking a loop and reading its edges back */
+void
+test_counter_mark(void)
+{
+    counted_loop_t loop = create_counted_loop(2, 20, true, false);
+    assert(loop.start->flags & RIFT_STATE_FLAG_COUNTER_START);
+    assert(loop.step->flags & RIFT_STATE_FLAG_COUNTER_STEP);
+    assert(loop.step->repeat_start == loop.start);
+    assert(rift_automaton_has_counters(loop.nfa));
+
+    rift_regex_state_t *repeat = NULL;
+    rift_regex_state_t *leave = NULL;
+    assert(rift_counter_get_edges(loop.step, &repeat, &leave));
+    assert(repeat == loop.body && leave == loop.leave);
+    assert(!rift_counter_get_edges(loop.body, &repeat, &leave));
+
+    /* Bounds out of order and a loop that is its own step are refused */
+    assert(!rift_counter_mark(loop.start, loop.step, 5, 4, true));
+    assert(!rift_counter_mark(loop.start, loop.start, 1, 4, true));
+    rift_automaton_free(loop.nfa);
+
+    /* A lazy loop prefers to leave */
+    loop = create_counted_loop(2, 20, false, false);
+    assert(rift_counter_get_edges(loop.start, &repeat, &leave));
+    assert(repeat == loop.body && leave == loop.leave);
+    rift_automaton_free(loop.nfa);
+
+    printf("test_counter_mark: PASSED\n");
+}
+
+/* Test which loops are unrolled by the compiler */
+void
+test_counter_should_unroll(void)
+{
+    const struct {
+        uint32_t min;
+        uint32_t max;
+        bool empty_body;
+        bool unroll;
+    } cases[] = {
+        {2, 4, false, true},
+        {2, RIFT_COUNTER_UNROLL_LIMIT, false, true},
+        {2, 20, false, false},
+        {0, RIFT_COUNTER_UNBOUNDED, false, true},
+        {10, RIFT_COUNTER_UNBOUNDED, false, false},
+        {2, 20, true, true},
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        counted_loop_t loop =
+            create_counted_loop(cases[i].min, cases[i].max, true, cases[i].empty_body);
+        assert(rift_counter_should_unroll(loop.nfa, loop.start) == cases[i].unroll);
+        rift_automaton_free(loop.nfa);
+    }
+
+    printf("test_counter_should_unroll: PASSED\n");
+}
+
+/* Test the counter table of a frozen automaton */
+void
+test_counter_frozen(void)
+{
+    rift_regex_error_t error = {0};
+    counted_loop_t loop = create_counted_loop(3, 20, true, false);
+
+    rift_frozen_automaton_t *frozen = rift_frozen_automaton_create(loop.nfa, &error);
+    assert(frozen != NULL);
+    assert(frozen->num_counters == 2);
+
+    const rift_frozen_counter_t *start = rift_frozen_automaton_find_counter(frozen, 0);
+    const rift_frozen_counter_t *step = rift_frozen_automaton_find_counter(frozen, 2);
+    assert(start && step);
+    assert(start->start == 0 && step->start == 0);
+    assert(step->min == 3 && step->max == 20 && step->greedy);
+    assert(frozen->state_flags[2] & RIFT_STATE_FLAG_COUNTER_STEP);
+    assert(rift_frozen_automaton_find_counter(frozen, 1) == NULL);
+
+    rift_frozen_automaton_free(frozen);
+    rift_automaton_free(loop.nfa);
+    printf("test_counter_frozen: PASSED\n");
+}
+
+/* Test that unrolled loops match exactly the repetitions their bounds allow */
+void
+test_counter_expand(void)
+{
+    rift_regex_error_t error = {0};
+    const struct {
+        uint32_t min;
+        uint32_t max;
+        bool greedy;
+    } cases[] = {
+        {2, 20, true},
+        {0, 12, false},
+        {3, RIFT_COUNTER_UNBOUNDED, true},
+        {0, RIFT_COUNTER_UNBOUNDED, false},
+        {4, 4, true},
+        {0, 0, true},
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        counted_loop_t loop =
+            create_counted_loop(cases[i].min, cases[i].max, cases[i].greedy, false);
+        assert(rift_automaton_expand_counters(loop.nfa, &error));
+        assert(!rift_automaton_has_counters(loop.nfa));
+        check_repetitions(loop.nfa, cases[i].min, cases[i].max, 24);
+        rift_automaton_free(loop.nfa);
+    }
+
+    /* A body that jumps out of the loop cannot be unrolled */
+    counted_loop_t loop = create_counted_loop(2, 20, true, false);
+    assert(rift_automaton_add_transition(loop.nfa, loop.body, loop.leave, "b"));
+    assert(!rift_counter_expand(loop.nfa, loop.start, &error));
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_AUTOMATON);
+    rift_automaton_free(loop.nfa);
+
+    printf("test_counter_expand: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running counter tests...\n");
+
+    test_counter_mark();
+    test_counter_should_unroll();
+    test_counter_frozen();
+    test_counter_expand();
+
+    printf("All counter tests PASSED!\n");
+    return 0;
+}
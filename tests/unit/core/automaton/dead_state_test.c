@@ -0,0 +1,142 @@
+/**
+ * @file dead_state_test.c
+ * @brief Unit tests for dead-state pruning of the LibRift regex engine
+ *
+ * This file contains test cases verifying that states no match can pass
+ * through are removed with the edges into them, on small automata and on a
+ * long chain, and that subset construction leaves them out of its subsets.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/automaton/automaton.h"
+#include "core/automaton/minimizer.h"
+#include "core/automaton/state.h"
+#include "core/automaton/transition.h"
+
+/* Test that unreachable states and states reaching no accepting state are removed */
+void
+test_dead_states_remove(void)
+{
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *s0 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s1 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *dead = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *loop = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *orphan = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *accept = rift_automaton_create_state(nfa, true);
+
+    assert(rift_automaton_add_transition(nfa, s0, s1, "a"));
+    assert(rift_automaton_create_epsilon_transition(nfa, s1, accept));
+    assert(rift_automaton_add_transition(nfa, s0, dead, "b"));
+    assert(rift_automaton_add_transition(nfa, dead, loop, "c"));
+    assert(rift_automaton_add_transition(nfa, loop, dead, "d"));
+    assert(rift_automaton_add_transition(nfa, orphan, accept, "e"));
+
+    assert(rift_automaton_remove_unreachable_states(nfa));
+    assert(rift_automaton_get_state_count(nfa) == 3);
+    assert(nfa->states[0] == s0);
+    assert(nfa->states[1] == s1);
+    assert(nfa->states[2] == accept);
+    assert(rift_state_get_transition_count(s0) == 1);
+    assert(rift_state_get_transition(s0, 0)->to_state == s1);
+
+    /* Nothing is left to remove */
+    assert(rift_automaton_remove_unreachable_states(nfa));
+    assert(rift_automaton_get_state_count(nfa) == 3);
+
+    rift_automaton_free(nfa);
+    assert(!rift_automaton_remove_unreachable_states(NULL));
+    printf("test_dead_states_remove: PASSED\n");
+}
+
+/* Test that an automaton accepting nothing keeps only its initial state */
+void
+test_dead_states_empty_language(void)
+{
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *s0 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s1 = rift_automaton_create_state(nfa, false);
+    assert(rift_automaton_add_transition(nfa, s0, s1, "a"));
+    assert(rift_automaton_add_transition(nfa, s1, s0, "b"));
+
+    assert(rift_automaton_remove_unreachable_states(nfa));
+    assert(rift_automaton_get_state_count(nfa) == 1);
+    assert(rift_automaton_get_initial_state(nfa) == s0);
+    assert(rift_state_get_transition_count(s0) == 0);
+
+    rift_automaton_free(nfa);
+    printf("test_dead_states_empty_language: PASSED\n");
+}
+
+/* Test pruning a long chain with a dead branch at every state */
+void
+test_dead_states_long_chain(void)
+{
+    const size_t length = 20000;
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *previous = rift_automaton_create_state(nfa, false);
+    for (size_t i = 0; i < length; i++) {
+        rift_regex_state_t *next = rift_automaton_create_state(nfa, i + 1 == length);
+        rift_regex_state_t *dead = rift_automaton_create_state(nfa, false);
+        assert(rift_automaton_add_transition(nfa, previous, next, "a"));
+        assert(rift_automaton_add_transition(nfa, previous, dead, "b"));
+        previous = next;
+    }
+
+    assert(rift_automaton_remove_unreachable_states(nfa));
+    assert(rift_automaton_get_state_count(nfa) == length + 1);
+    for (size_t i = 0; i < length; i++) {
+        assert(rift_state_get_transition_count(nfa->states[i]) == 1);
+    }
+
+    rift_automaton_free(nfa);
+    printf("test_dead_states_long_chain: PASSED\n");
+}
+
+/* Test that subset construction builds no subsets for dead NFA states */
+void
+test_dead_states_nfa_to_dfa(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *s0 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s1 = rift_automaton_create_state(nfa, true);
+    rift_regex_state_t *dead = rift_automaton_create_state(nfa, false);
+    assert(rift_automaton_add_transition(nfa, s0, s1, "[a-z]"));
+    assert(rift_automaton_add_transition(nfa, s0, dead, "a"));
+    assert(rift_automaton_add_transition(nfa, dead, dead, "[x-z]"));
+
+    /* Without pruning, a and the other letters would lead to different subsets */
+    rift_regex_automaton_t *dfa = rift_automaton_nfa_to_dfa(nfa, &error);
+    assert(dfa != NULL);
+    assert(rift_automaton_get_state_count(dfa) == 2);
+    rift_regex_state_t *start = rift_automaton_get_initial_state(dfa);
+    assert(rift_state_get_transition_count(start) == 1);
+    assert(rift_transition_matches_char(rift_state_get_transition(start, 0), 'a'));
+    assert(rift_state_get_transition_count(dfa->states[1]) == 0);
+
+    rift_automaton_free(dfa);
+    rift_automaton_free(nfa);
+    printf("test_dead_states_nfa_to_dfa: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running dead state tests...\n");
+
+    test_dead_states_remove();
+    test_dead_states_empty_language();
+    test_dead_states_long_chain();
+    test_dead_states_nfa_to_dfa();
+
+    printf("All dead state tests PASSED!\n");
+    return 0;
+}
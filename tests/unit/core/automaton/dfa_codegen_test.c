@@ -0,0 +1,120 @@
+/**
+ * @file dfa_codegen_test.c
+ * @brief Unit tests for C source generation from compiled DFA tables
+ *
+ * This file contains test cases verifying the shape of the source written by
+ * rift_dfa_table_emit_c and its argument validation.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/automaton/automaton.h"
+#include "core/automaton/dfa_codegen.h"
+#include "core/automaton/dfa_table.h"
+#include "core/automaton/state.h"
+
+/* Build the table of a DFA for ab+ */
+static rift_dfa_table_t *
+create_test_table(void)
+{
+    rift_regex_automaton_t *dfa = rift_automaton_create(RIFT_AUTOMATON_DFA);
+    assert(dfa != NULL);
+
+    rift_regex_state_t *s0 = rift_automaton_create_state(dfa, false);
+    rift_regex_state_t *s1 = rift_automaton_create_state(dfa, false);
+    rift_regex_state_t *s2 = rift_automaton_create_state(dfa, true);
+    assert(s0 && s1 && s2);
+
+    assert(rift_automaton_set_initial_state(dfa, s0));
+    assert(rift_automaton_add_transition(dfa, s0, s1, "a"));
+    assert(rift_automaton_add_transition(dfa, s1, s2, "b"));
+    assert(rift_automaton_add_transition(dfa, s2, s2, "b"));
+
+    rift_dfa_table_t *table = rift_dfa_table_compile(dfa, NULL);
+    assert(table != NULL);
+    rift_automaton_free(dfa);
+    return table;
+}
+
+/* Read back everything written to a stream */
+static char *
+read_stream(FILE *stream)
+{
+    long size = ftell(stream);
+    assert(size > 0);
+    rewind(stream);
+
+    char *text = malloc((size_t)size + 1);
+    assert(text != NULL);
+    assert(fread(text, 1, (size_t)size, stream) == (size_t)size);
+    text[size] = '\0';
+    return text;
+}
+
+/* Test the generated declarations */
+void
+test_dfa_codegen_emit(void)
+{
+    rift_regex_error_t error = {0};
+    rift_dfa_table_t *table = create_test_table();
+    FILE *stream = tmpfile();
+    assert(stream != NULL);
+
+    /* Two matchers in one file, as for a pattern set */
+    assert(rift_dfa_table_emit_c(table, "first", stream, &error));
+    assert(rift_dfa_table_emit_c(table, "second", stream, &error));
+
+    char *text = read_stream(stream);
+    assert(strstr(text, "static const uint8_t first_byte_class[256] = {"));
+    assert(strstr(text, "static const uint8_t first_next[12] = {"));
+    assert(strstr(text, "static const uint8_t first_accept[4] = {"));
+    assert(strstr(text, "first_matches(const char *input, size_t length)"));
+    assert(strstr(text, "first_longest_prefix(const char *input, size_t length"));
+    assert(strstr(text, "second_matches(const char *input, size_t length)"));
+    assert(strstr(text, "#include") && !strstr(text, "librift") && !strstr(text, "core/"));
+
+    free(text);
+    fclose(stream);
+    rift_dfa_table_free(table);
+    printf("test_dfa_codegen_emit: PASSED\n");
+}
+
+/* Test argument validation */
+void
+test_dfa_codegen_invalid(void)
+{
+    rift_regex_error_t error = {0};
+    rift_dfa_table_t *table = create_test_table();
+    FILE *stream = tmpfile();
+    assert(stream != NULL);
+
+    assert(!rift_dfa_table_emit_c(NULL, "p", stream, &error));
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_PARAMETER);
+    assert(!rift_dfa_table_emit_c(table, "9lives", stream, NULL));
+    assert(!rift_dfa_table_emit_c(table, "has-dash", stream, NULL));
+    assert(!rift_dfa_table_emit_c(table, "", stream, NULL));
+    assert(!rift_dfa_table_emit_c(table, "p", NULL, NULL));
+    assert(ftell(stream) == 0);
+
+    fclose(stream);
+    rift_dfa_table_free(table);
+    printf("test_dfa_codegen_invalid: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running DFA code generation tests...\n");
+
+    test_dfa_codegen_emit();
+    test_dfa_codegen_invalid();
+
+    printf("All DFA code generation tests PASSED!\n");
+    return 0;
+}
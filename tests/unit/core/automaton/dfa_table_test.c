@@ -0,0 +1,207 @@
+/**
+ * @file dfa_table_test.c
+ * @brief Unit tests for the dense DFA transition table of the LibRift regex engine
+ *
+ * This file contains test cases verifying that compiled tables agree with the
+ * pointer-based DFA they were built from.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/automaton/automaton.h"
+#include "core/automaton/dfa_table.h"
+#include "core/automaton/state.h"
+
+/* Build a DFA for ab+ */
+static rift_regex_automaton_t *
+create_test_dfa(void)
+{
+    rift_regex_automaton_t *dfa = rift_automaton_create(RIFT_AUTOMATON_DFA);
+    assert(dfa != NULL);
+
+    rift_regex_state_t *s0 = rift_automaton_create_state(dfa, false);
+    rift_regex_state_t *s1 = rift_automaton_create_state(dfa, false);
+    rift_regex_state_t *s2 = rift_automaton_create_state(dfa, true);
+    assert(s0 && s1 && s2);
+
+    assert(rift_automaton_set_initial_state(dfa, s0));
+    assert(rift_automaton_add_transition(dfa, s0, s1, "a"));
+    assert(rift_automaton_add_transition(dfa, s1, s2, "b"));
+    assert(rift_automaton_add_transition(dfa, s2, s2, "b"));
+
+    return dfa;
+}
+
+/* Test table compilation and basic layout */
+void
+test_dfa_table_compile(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *dfa = create_test_dfa();
+
+    rift_dfa_table_t *table = rift_dfa_table_compile(dfa, &error);
+    assert(table != NULL);
+    assert(table->num_states == 4);
+    assert(table->start_state != RIFT_DFA_DEAD_STATE);
+    assert(!rift_dfa_table_is_accepting(table, RIFT_DFA_DEAD_STATE));
+    assert(!rift_dfa_table_is_accepting(table, table->start_state));
+
+    uint32_t after_a = rift_dfa_table_next(table, table->start_state, 'a');
+    assert(after_a != RIFT_DFA_DEAD_STATE);
+    assert(rift_dfa_table_next(table, table->start_state, 'b') == RIFT_DFA_DEAD_STATE);
+    assert(rift_dfa_table_is_accepting(table, rift_dfa_table_next(table, after_a, 'b')));
+
+    /* 'a', 'b' and everything else */
+    assert(table->num_classes == 3);
+    assert(table->byte_class['c'] == table->byte_class[0xff]);
+    assert(table->byte_class['a'] != table->byte_class['b']);
+    assert(rift_dfa_table_memory_usage(table) < 4 * RIFT_DFA_ALPHABET_SIZE * sizeof(uint32_t));
+
+    rift_dfa_table_free(table);
+    rift_automaton_free(dfa);
+    printf("test_dfa_table_compile: PASSED\n");
+}
+
+/* Test whole-input matching */
+void
+test_dfa_table_matches(void)
+{
+    rift_regex_automaton_t *dfa = create_test_dfa();
+    rift_dfa_table_t *table = rift_dfa_table_compile(dfa, NULL);
+    assert(table != NULL);
+
+    assert(rift_dfa_table_matches(table, "ab", 2));
+    assert(rift_dfa_table_matches(table, "abbbb", 5));
+    assert(!rift_dfa_table_matches(table, "", 0));
+    assert(!rift_dfa_table_matches(table, "a", 1));
+    assert(!rift_dfa_table_matches(table, "abc", 3));
+    assert(!rift_dfa_table_matches(table, "\xff", 1));
+
+    rift_dfa_table_free(table);
+    rift_automaton_free(dfa);
+    printf("test_dfa_table_matches: PASSED\n");
+}
+
+/* Test longest-prefix scanning */
+void
+test_dfa_table_longest_prefix(void)
+{
+    rift_regex_automaton_t *dfa = create_test_dfa();
+    rift_dfa_table_t *table = rift_dfa_table_compile(dfa, NULL);
+    assert(table != NULL);
+
+    size_t end = 0;
+    assert(rift_dfa_table_longest_prefix(table, "abbxb", 5, &end));
+    assert(end == 3);
+    assert(!rift_dfa_table_longest_prefix(table, "ba", 2, &end));
+
+    /* The shortest prefix stops at the first accepting state */
+    assert(rift_dfa_table_shortest_prefix(table, "abbxb", 5, &end));
+    assert(end == 2);
+    assert(rift_dfa_table_shortest_prefix(table, "ab", 2, NULL));
+    assert(!rift_dfa_table_shortest_prefix(table, "a", 1, &end));
+    assert(!rift_dfa_table_shortest_prefix(table, "ba", 2, &end));
+
+    rift_dfa_table_free(table);
+    rift_automaton_free(dfa);
+    printf("test_dfa_table_longest_prefix: PASSED\n");
+}
+
+/* Test that the batch scanners agree with scanning each input on its own */
+void
+test_dfa_table_many(void)
+{
+    rift_regex_automaton_t *dfa = create_test_dfa();
+    rift_dfa_table_t *table = rift_dfa_table_compile(dfa, NULL);
+    assert(table != NULL);
+
+    /* More inputs than lanes and than one block, of every length up to 40 */
+    const size_t count = 150;
+    char buffers[150][48];
+    const char *inputs[150];
+    size_t lengths[150];
+    unsigned seed = 12345;
+    for (size_t i = 0; i < count; i++) {
+        lengths[i] = i % 41;
+        for (size_t j = 0; j < lengths[i]; j++) {
+            seed = seed * 1103515245u + 12345u;
+            buffers[i][j] = j == 0 ? (i % 5 ? 'a' : 'b') : (seed >> 16) % 9 ? 'b' : 'c';
+        }
+        buffers[i][lengths[i]] = '\0';
+        inputs[i] = buffers[i];
+    }
+    inputs[7] = NULL;
+    lengths[7] = 0;
+
+    bool results[150];
+    size_t ends[150];
+    assert(rift_dfa_table_matches_many(table, inputs, lengths, count, results));
+    assert(rift_dfa_table_longest_prefix_many(table, inputs, lengths, count, ends));
+    size_t matched = 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t end = 0;
+        bool found = rift_dfa_table_longest_prefix(table, inputs[i], lengths[i], &end);
+        assert(results[i] == rift_dfa_table_matches(table, inputs[i], lengths[i]));
+        assert(ends[i] == (found ? end : RIFT_DFA_NO_MATCH));
+        matched += results[i];
+    }
+    assert(matched > 0 && matched < count);
+
+    /* Without lengths the inputs are read up to their terminators */
+    inputs[7] = "abb";
+    assert(rift_dfa_table_matches_many(table, inputs, NULL, count, results));
+    assert(results[7]);
+    assert(rift_dfa_table_longest_prefix_many(table, inputs, NULL, 8, ends));
+    assert(ends[7] == 3);
+
+    assert(rift_dfa_table_matches_many(table, NULL, NULL, 0, NULL));
+    assert(!rift_dfa_table_matches_many(NULL, inputs, NULL, 1, results));
+    assert(!rift_dfa_table_longest_prefix_many(table, inputs, NULL, 1, NULL));
+
+    rift_dfa_table_free(table);
+    rift_automaton_free(dfa);
+    printf("test_dfa_table_many: PASSED\n");
+}
+
+/* Test argument validation */
+void
+test_dfa_table_invalid(void)
+{
+    rift_regex_error_t error = {0};
+
+    assert(rift_dfa_table_compile(NULL, &error) == NULL);
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_PARAMETER);
+
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *state = rift_automaton_create_state(nfa, true);
+    assert(rift_automaton_set_initial_state(nfa, state));
+    assert(rift_dfa_table_compile(nfa, &error) == NULL);
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_AUTOMATON);
+
+    assert(!rift_dfa_table_matches(NULL, "a", 1));
+    rift_dfa_table_free(NULL);
+
+    rift_automaton_free(nfa);
+    printf("test_dfa_table_invalid: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running DFA table tests...\n");
+
+    test_dfa_table_compile();
+    test_dfa_table_matches();
+    test_dfa_table_longest_prefix();
+    test_dfa_table_many();
+    test_dfa_table_invalid();
+
+    printf("All DFA table tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,166 @@
+/**
+ * @file epsilon_closure_test.c
+ * @brief Unit tests for precomputed epsilon closures of the LibRift regex engine
+ *
+ * This file contains test cases verifying per-state closures, their unions and
+ * the cache kept on the automaton.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/automaton/automaton.h"
+#include "core/automaton/epsilon_closure.h"
+#include "core/automaton/state.h"
+
+/* Build an NFA with an epsilon cycle: 0 -e-> 1 -e-> 2 -e-> 1, 2 -a-> 3, 3 -e-> 0 */
+static rift_regex_automaton_t *
+create_test_nfa(rift_regex_state_t **states)
+{
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    assert(nfa != NULL);
+
+    for (int i = 0; i < 4; i++) {
+        states[i] = rift_automaton_create_state(nfa, i == 3);
+        assert(states[i] != NULL);
+    }
+
+    assert(rift_automaton_add_transition(nfa, states[0], states[1], NULL));
+    assert(rift_automaton_add_transition(nfa, states[1], states[2], NULL));
+    assert(rift_automaton_add_transition(nfa, states[2], states[1], NULL));
+    assert(rift_automaton_add_transition(nfa, states[2], states[3], "a"));
+    assert(rift_automaton_add_transition(nfa, states[3], states[0], NULL));
+
+    return nfa;
+}
+
+/* Test the closure of every state */
+void
+test_epsilon_closures_compute(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_state_t *states[4];
+    rift_regex_automaton_t *nfa = create_test_nfa(states);
+
+    rift_epsilon_closures_t *closures = rift_epsilon_closures_compute(nfa, &error);
+    assert(closures != NULL);
+    assert(closures->num_states == 4);
+
+    size_t size = 0;
+    const uint32_t *closure = rift_epsilon_closures_get(closures, 0, &size);
+    assert(size == 3);
+    assert(closure[0] == 0 && closure[1] == 1 && closure[2] == 2);
+
+    closure = rift_epsilon_closures_get(closures, 2, &size);
+    assert(size == 2);
+    assert(closure[0] == 1 && closure[1] == 2);
+
+    closure = rift_epsilon_closures_get(closures, 3, &size);
+    assert(size == 4);
+    for (uint32_t i = 0; i < 4; i++) {
+        assert(closure[i] == i);
+    }
+
+    assert(rift_epsilon_closures_get(closures, 4, &size) == NULL);
+    assert(size == 0);
+
+    for (uint32_t i = 0; i < 4; i++) {
+        assert(rift_epsilon_closures_find_state(closures, states[i]) == i);
+    }
+
+    rift_regex_state_t *stranger = rift_state_create(false);
+    assert(rift_epsilon_closures_find_state(closures, stranger) == RIFT_EPSILON_NO_STATE);
+    rift_state_free(stranger);
+
+    rift_epsilon_closures_free(closures);
+    rift_automaton_free(nfa);
+    printf("test_epsilon_closures_compute: PASSED\n");
+}
+
+/* Test the union of several closures */
+void
+test_epsilon_closures_union(void)
+{
+    rift_regex_state_t *states[4];
+    rift_regex_automaton_t *nfa = create_test_nfa(states);
+    rift_epsilon_closures_t *closures = rift_epsilon_closures_compute(nfa, NULL);
+    assert(closures != NULL);
+
+    uint64_t scratch[1] = {0};
+    uint32_t out[4];
+    uint32_t inputs[] = {2, 1, 2};
+
+    size_t count = rift_epsilon_closures_union(closures, inputs, 3, scratch, out);
+    assert(count == 2);
+    assert(out[0] == 1 && out[1] == 2);
+    assert(scratch[0] == 0);
+
+    rift_epsilon_closures_free(closures);
+    rift_automaton_free(nfa);
+    printf("test_epsilon_closures_union: PASSED\n");
+}
+
+/* Test the cache kept on the automaton */
+void
+test_epsilon_closures_cache(void)
+{
+    rift_regex_state_t *states[4];
+    rift_regex_automaton_t *nfa = create_test_nfa(states);
+
+    const rift_epsilon_closures_t *first = rift_automaton_get_epsilon_closures(nfa, NULL);
+    assert(first != NULL);
+    assert(rift_automaton_get_epsilon_closures(nfa, NULL) == first);
+
+    rift_regex_state_t *closure[5];
+    size_t size = 0;
+    assert(rift_automaton_compute_epsilon_closure(nfa, &states[2], 1, closure, &size));
+    assert(size == 2);
+    assert(closure[0] == states[1] && closure[1] == states[2]);
+
+    /* Adding an epsilon edge must be visible in the next closure */
+    rift_regex_state_t *extra = rift_automaton_create_state(nfa, false);
+    assert(rift_automaton_add_transition(nfa, states[1], extra, NULL));
+    assert(rift_automaton_compute_epsilon_closure(nfa, &states[2], 1, closure, &size));
+    assert(size == 3);
+    assert(closure[2] == extra);
+
+    rift_automaton_free(nfa);
+    printf("test_epsilon_closures_cache: PASSED\n");
+}
+
+/* Test that subset construction still merges epsilon-reachable states */
+void
+test_epsilon_closures_nfa_to_dfa(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_state_t *states[4];
+    rift_regex_automaton_t *nfa = create_test_nfa(states);
+
+    rift_regex_automaton_t *dfa = rift_automaton_nfa_to_dfa(nfa, &error);
+    assert(dfa != NULL);
+    assert(rift_automaton_get_state_count(dfa) == 2);
+    assert(!rift_state_is_accepting(rift_automaton_get_initial_state(dfa)));
+
+    rift_automaton_free(dfa);
+    rift_automaton_free(nfa);
+    printf("test_epsilon_closures_nfa_to_dfa: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running epsilon closure tests...\n");
+
+    test_epsilon_closures_compute();
+    test_epsilon_closures_union();
+    test_epsilon_closures_cache();
+    test_epsilon_closures_nfa_to_dfa();
+
+    printf("All epsilon closure tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,172 @@
+/**
+ * @file frozen_automaton_test.c
+ * @brief Unit tests for the frozen automaton layout of the LibRift regex engine
+ *
+ * This file contains test cases verifying that frozen automata preserve the
+ * states, edges and group information of their source automaton.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/automaton/automaton.h"
+#include "core/automaton/frozen_automaton.h"
+#include "core/automaton/state.h"
+#include "core/automaton/transition.h"
+
+/* Build an NFA for (a|b)c with a named group around the alternation */
+static rift_regex_automaton_t *
+create_test_nfa(void)
+{
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    assert(nfa != NULL);
+
+    rift_regex_state_t *s0 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s1 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s2 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s3 = rift_automaton_create_state(nfa, true);
+    assert(s0 && s1 && s2 && s3);
+
+    assert(rift_automaton_set_initial_state(nfa, s0));
+    assert(rift_automaton_add_transition(nfa, s0, s1, NULL));
+    assert(rift_automaton_add_transition(nfa, s1, s2, "a"));
+    assert(rift_automaton_add_transition(nfa, s1, s2, "b"));
+    assert(rift_automaton_add_transition(nfa, s2, s3, "c"));
+
+    assert(rift_state_set_group_start(s1, true));
+    assert(rift_state_set_group_name(s1, "letter"));
+    assert(rift_state_set_group_end(s2, true));
+
+    return nfa;
+}
+
+/* Test the CSR layout of a frozen automaton */
+void
+test_frozen_automaton_layout(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa = create_test_nfa();
+
+    rift_frozen_automaton_t *frozen = rift_frozen_automaton_create(nfa, &error);
+    assert(frozen != NULL);
+    assert(frozen->num_states == 4);
+    assert(frozen->num_edges == 4);
+    assert(frozen->start_state == 0);
+    assert(!frozen->is_deterministic);
+
+    assert(frozen->edge_offsets[0] == 0);
+    assert(frozen->edge_offsets[1] == 1);
+    assert(frozen->edge_offsets[2] == 3);
+    assert(frozen->edge_offsets[4] == frozen->num_edges);
+
+    assert(rift_frozen_automaton_edge_is_epsilon(frozen, 0));
+    assert(rift_frozen_automaton_get_edge_pattern(frozen, 0) == NULL);
+    assert(frozen->edge_targets[0] == 1);
+
+    /* Edges keep the order they had on the source state */
+    assert(strcmp(rift_frozen_automaton_get_edge_pattern(frozen, 1), "a") == 0);
+    assert(strcmp(rift_frozen_automaton_get_edge_pattern(frozen, 2), "b") == 0);
+    assert(rift_transition_predicate_test(&frozen->edge_predicates[2], 'b'));
+    assert(!rift_transition_predicate_test(&frozen->edge_predicates[2], 'a'));
+    assert(frozen->edge_targets[3] == 3);
+
+    assert(!rift_frozen_automaton_is_accepting(frozen, 2));
+    assert(rift_frozen_automaton_is_accepting(frozen, 3));
+    assert(rift_frozen_automaton_memory_usage(frozen) > 0);
+
+    rift_frozen_automaton_free(frozen);
+    rift_automaton_free(nfa);
+    printf("test_frozen_automaton_layout: PASSED\n");
+}
+
+/* Test the capture side table */
+void
+test_frozen_automaton_captures(void)
+{
+    rift_regex_automaton_t *nfa = create_test_nfa();
+    rift_frozen_automaton_t *frozen = rift_frozen_automaton_create(nfa, NULL);
+    assert(frozen != NULL);
+    assert(frozen->num_captures == 2);
+
+    const rift_frozen_capture_t *start = rift_frozen_automaton_find_capture(frozen, 1);
+    assert(start != NULL);
+    assert(start->is_group_start && !start->is_group_end);
+    assert(strcmp(frozen->string_pool + start->name_offset, "letter") == 0);
+
+    const rift_frozen_capture_t *end = rift_frozen_automaton_find_capture(frozen, 2);
+    assert(end != NULL);
+    assert(end->is_group_end);
+    assert(end->name_offset == RIFT_FROZEN_NO_STRING);
+
+    assert(rift_frozen_automaton_find_capture(frozen, 0) == NULL);
+    assert(rift_frozen_automaton_find_capture(frozen, 3) == NULL);
+
+    rift_frozen_automaton_free(frozen);
+    rift_automaton_free(nfa);
+    printf("test_frozen_automaton_captures: PASSED\n");
+}
+
+/* Test that the frozen copy outlives its source and that cloning uses it */
+void
+test_frozen_automaton_clone(void)
+{
+    rift_regex_automaton_t *nfa = create_test_nfa();
+    rift_frozen_automaton_t *frozen = rift_frozen_automaton_create(nfa, NULL);
+    rift_regex_automaton_t *clone = rift_automaton_clone(nfa);
+    assert(frozen != NULL && clone != NULL);
+    rift_automaton_free(nfa);
+
+    assert(strcmp(rift_frozen_automaton_get_edge_pattern(frozen, 3), "c") == 0);
+
+    assert(rift_automaton_get_state_count(clone) == 4);
+    rift_regex_state_t *start = rift_automaton_get_initial_state(clone);
+    assert(start != NULL);
+    assert(rift_state_get_transition_count(start) == 1);
+    rift_regex_transition_t *epsilon = rift_state_get_transition(start, 0);
+    assert(rift_transition_is_epsilon(epsilon));
+
+    rift_regex_state_t *group = rift_transition_get_target(epsilon);
+    assert(rift_state_get_transition_count(group) == 2);
+    assert(rift_state_is_group_start(group));
+    assert(strcmp(rift_state_get_group_name(group), "letter") == 0);
+    assert(rift_transition_matches_char(rift_state_get_transition(group, 1), 'b'));
+
+    rift_frozen_automaton_free(frozen);
+    rift_automaton_free(clone);
+    printf("test_frozen_automaton_clone: PASSED\n");
+}
+
+/* Test argument validation */
+void
+test_frozen_automaton_invalid(void)
+{
+    rift_regex_error_t error = {0};
+
+    assert(rift_frozen_automaton_create(NULL, &error) == NULL);
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_PARAMETER);
+
+    assert(!rift_frozen_automaton_is_accepting(NULL, 0));
+    assert(rift_frozen_automaton_find_capture(NULL, 0) == NULL);
+    rift_frozen_automaton_free(NULL);
+
+    printf("test_frozen_automaton_invalid: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running frozen automaton tests...\n");
+
+    test_frozen_automaton_layout();
+    test_frozen_automaton_captures();
+    test_frozen_automaton_clone();
+    test_frozen_automaton_invalid();
+
+    printf("All frozen automaton tests PASSED!\n");
+    return 0;
+}
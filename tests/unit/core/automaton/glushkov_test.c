@@ -0,0 +1,183 @@
+/**
+ * @file glushkov_test.c
+ * @brief Unit tests for the Glushkov construction of the LibRift regex engine
+ *
+ * This file contains test cases verifying that Glushkov automata have no
+ * epsilon edges and one state per position, that they match what the NFA
+ * they come from matches, and that NFAs with state data are refused.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/automaton/automaton.h"
+#include "core/automaton/bit_parallel.h"
+#include "core/automaton/frozen_automaton.h"
+#include "core/automaton/glushkov.h"
+#include "core/automaton/pike_vm.h"
+#include "core/automaton/state.h"
+
+/* Build a Thompson NFA for (ab|a)*c?, with an epsilon edge around every part */
+static rift_regex_automaton_t *
+create_thompson_nfa(void)
+{
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *start = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *loop = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *first = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *a1 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *b1 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *second = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *a2 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *body_end = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *optional = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *c = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *end = rift_automaton_create_state(nfa, true);
+
+    assert(rift_automaton_create_epsilon_transition(nfa, start, loop));
+    assert(rift_automaton_create_epsilon_transition(nfa, loop, first));
+    assert(rift_automaton_create_epsilon_transition(nfa, loop, second));
+    assert(rift_automaton_add_transition(nfa, first, a1, "a"));
+    assert(rift_automaton_add_transition(nfa, a1, b1, "b"));
+    assert(rift_automaton_create_epsilon_transition(nfa, b1, body_end));
+    assert(rift_automaton_add_transition(nfa, second, a2, "a"));
+    assert(rift_automaton_create_epsilon_transition(nfa, a2, body_end));
+    assert(rift_automaton_create_epsilon_transition(nfa, body_end, loop));
+    assert(rift_automaton_create_epsilon_transition(nfa, loop, optional));
+    assert(rift_automaton_add_transition(nfa, optional, c, "c"));
+    assert(rift_automaton_create_epsilon_transition(nfa, c, end));
+    assert(rift_automaton_create_epsilon_transition(nfa, optional, end));
+
+    return nfa;
+}
+
+/* Compare the match bounds with the Pike VM over the NFA at every start of every input */
+static void
+assert_same_matches(rift_regex_automaton_t *nfa, rift_regex_automaton_t *glushkov,
+                    const char *const *inputs, size_t count)
+{
+    rift_pike_vm_t *expected_vm = rift_pike_vm_create(nfa, NULL);
+    rift_pike_vm_t *actual_vm = rift_pike_vm_create(glushkov, NULL);
+    assert(expected_vm != NULL && actual_vm != NULL);
+
+    size_t expected[2];
+    size_t actual[2];
+    for (size_t i = 0; i < count; i++) {
+        size_t length = strlen(inputs[i]);
+        for (size_t start = 0; start <= length; start++) {
+            for (int earliest = 0; earliest < 2; earliest++) {
+                bool want = rift_pike_vm_search(expected_vm, inputs[i], length, start, true,
+                                                earliest, expected);
+                bool got = rift_pike_vm_search(actual_vm, inputs[i], length, start, true,
+                                               earliest, actual);
+                assert(want == got);
+                assert(!want || (expected[0] == actual[0] && expected[1] == actual[1]));
+            }
+        }
+    }
+
+    rift_pike_vm_free(expected_vm);
+    rift_pike_vm_free(actual_vm);
+}
+
+/* Test the shape of the Glushkov automaton */
+void
+test_glushkov_positions(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa = create_thompson_nfa();
+    rift_regex_automaton_t *glushkov = rift_automaton_to_glushkov(nfa, &error);
+    assert(glushkov != NULL);
+
+    /* A start state and the positions a, b, a and c */
+    assert(rift_automaton_get_state_count(glushkov) == 5);
+    rift_frozen_automaton_t *frozen = rift_frozen_automaton_create(glushkov, NULL);
+    assert(frozen != NULL);
+    for (uint32_t e = 0; e < frozen->num_edges; e++) {
+        assert(!rift_frozen_automaton_edge_is_epsilon(frozen, e));
+    }
+
+    /* The empty string is still accepted, by the start state */
+    assert(rift_frozen_automaton_is_accepting(frozen, frozen->start_state));
+    rift_frozen_automaton_free(frozen);
+
+    /* The bit-parallel simulation gets one position per state past the start */
+    rift_bit_parallel_t *bit_parallel = rift_bit_parallel_create(glushkov, NULL);
+    assert(bit_parallel != NULL);
+    assert(rift_bit_parallel_get_position_count(bit_parallel) == 4);
+    rift_bit_parallel_free(bit_parallel);
+
+    rift_automaton_free(glushkov);
+    rift_automaton_free(nfa);
+    printf("test_glushkov_positions: PASSED\n");
+}
+
+/* Test that the Glushkov automaton matches what the NFA matches */
+void
+test_glushkov_matches_nfa(void)
+{
+    static const char *const inputs[] = {"",     "a",    "ab",    "aab", "abc",
+                                         "abac", "abbc", "cabab", "aba", "ac"};
+    rift_regex_automaton_t *nfa = create_thompson_nfa();
+    rift_regex_automaton_t *glushkov = rift_automaton_to_glushkov(nfa, NULL);
+    assert(glushkov != NULL);
+
+    assert_same_matches(nfa, glushkov, inputs, sizeof(inputs) / sizeof(*inputs));
+
+    rift_automaton_free(glushkov);
+    rift_automaton_free(nfa);
+    printf("test_glushkov_matches_nfa: PASSED\n");
+}
+
+/* Test that NFAs keeping data on their states are refused */
+void
+test_glushkov_state_data(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa = create_thompson_nfa();
+    rift_regex_state_t *group = rift_automaton_get_state_by_index(nfa, 2);
+    assert(rift_state_set_group_start(group, true));
+    assert(rift_automaton_to_glushkov(nfa, &error) == NULL);
+    assert(error.code == RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE);
+    rift_automaton_free(nfa);
+
+    nfa = create_thompson_nfa();
+    rift_regex_state_t *anchor = rift_automaton_get_state_by_index(nfa, 0);
+    assert(rift_automaton_set_state_flag(anchor, RIFT_STATE_FLAG_ANCHOR_START));
+    error.code = RIFT_REGEX_ERROR_NONE;
+    assert(rift_automaton_to_glushkov(nfa, &error) == NULL);
+    assert(error.code == RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE);
+    rift_automaton_free(nfa);
+
+    printf("test_glushkov_state_data: PASSED\n");
+}
+
+/* Test invalid arguments */
+void
+test_glushkov_invalid(void)
+{
+    rift_regex_error_t error = {0};
+    assert(rift_automaton_to_glushkov(NULL, &error) == NULL);
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_PARAMETER);
+
+    printf("test_glushkov_invalid: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running Glushkov construction tests...\n");
+
+    test_glushkov_positions();
+    test_glushkov_matches_nfa();
+    test_glushkov_state_data();
+    test_glushkov_invalid();
+
+    printf("All Glushkov construction tests PASSED!\n");
+    return 0;
+}
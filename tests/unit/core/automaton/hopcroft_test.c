@@ -0,0 +1,193 @@
+/**
+ * @file hopcroft_test.c
+ * @brief Unit tests for Hopcroft DFA minimization in the LibRift regex engine
+ *
+ * This file contains test cases verifying that minimization merges equivalent
+ * states, drops dead states and preserves the accepted language.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/automaton/automaton.h"
+#include "core/automaton/dfa_table.h"
+#include "core/automaton/hopcroft.h"
+#include "core/automaton/state.h"
+
+/* Check that two DFAs agree on every string over {a, b} up to a length */
+static void
+assert_same_language(const rift_regex_automaton_t *a, const rift_regex_automaton_t *b,
+                     size_t max_length)
+{
+    rift_regex_error_t error = {0};
+    rift_dfa_table_t *ta = rift_dfa_table_compile(a, &error);
+    rift_dfa_table_t *tb = rift_dfa_table_compile(b, &error);
+    assert(ta != NULL && tb != NULL);
+
+    char input[16];
+    for (size_t length = 0; length <= max_length; length++) {
+        for (size_t bits = 0; bits < ((size_t)1 << length); bits++) {
+            for (size_t i = 0; i < length; i++) {
+                input[i] = (bits >> i) & 1 ? 'b' : 'a';
+            }
+            assert(rift_dfa_table_matches(ta, input, length) ==
+                   rift_dfa_table_matches(tb, input, length));
+        }
+    }
+
+    rift_dfa_table_free(ta);
+    rift_dfa_table_free(tb);
+}
+
+/* Test the textbook DFA for (a|b)*abb, whose states A and C are equivalent */
+void
+test_hopcroft_merge(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *dfa = rift_automaton_create(RIFT_AUTOMATON_DFA);
+    rift_regex_state_t *s[5];
+    for (int i = 0; i < 5; i++) {
+        s[i] = rift_automaton_create_state(dfa, i == 4);
+        assert(s[i] != NULL);
+    }
+
+    const int on_a[5] = {1, 1, 1, 1, 1};
+    const int on_b[5] = {2, 3, 2, 4, 2};
+    for (int i = 0; i < 5; i++) {
+        assert(rift_automaton_add_transition(dfa, s[i], s[on_a[i]], "a"));
+        assert(rift_automaton_add_transition(dfa, s[i], s[on_b[i]], "b"));
+    }
+
+    rift_regex_automaton_t *minimized = rift_hopcroft_minimize(dfa, &error);
+    assert(minimized != NULL);
+    assert(rift_automaton_get_state_count(minimized) == 4);
+    assert(rift_automaton_is_deterministic(minimized));
+    assert_same_language(dfa, minimized, 10);
+
+    rift_automaton_free(minimized);
+    rift_automaton_free(dfa);
+    printf("test_hopcroft_merge: PASSED\n");
+}
+
+/* Test that states which cannot reach an accepting state are dropped */
+void
+test_hopcroft_dead_states(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *dfa = rift_automaton_create(RIFT_AUTOMATON_DFA);
+    rift_regex_state_t *s0 = rift_automaton_create_state(dfa, false);
+    rift_regex_state_t *s1 = rift_automaton_create_state(dfa, true);
+    rift_regex_state_t *trap = rift_automaton_create_state(dfa, false);
+    rift_regex_state_t *unreachable = rift_automaton_create_state(dfa, true);
+
+    assert(rift_automaton_add_transition(dfa, s0, s1, "a"));
+    assert(rift_automaton_add_transition(dfa, s0, trap, "b"));
+    assert(rift_automaton_add_transition(dfa, trap, trap, "[ab]"));
+    assert(rift_automaton_add_transition(dfa, unreachable, s0, "a"));
+
+    rift_regex_automaton_t *minimized = rift_hopcroft_minimize(dfa, &error);
+    assert(minimized != NULL);
+    assert(rift_automaton_get_state_count(minimized) == 2);
+    assert_same_language(dfa, minimized, 6);
+
+    rift_automaton_free(minimized);
+    rift_automaton_free(dfa);
+    printf("test_hopcroft_dead_states: PASSED\n");
+}
+
+/* Test that a dead edge shadowing a later overlapping edge is kept */
+void
+test_hopcroft_shadowed_edge(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *dfa = rift_automaton_create(RIFT_AUTOMATON_DFA);
+    rift_regex_state_t *s0 = rift_automaton_create_state(dfa, false);
+    rift_regex_state_t *trap = rift_automaton_create_state(dfa, false);
+    rift_regex_state_t *s1 = rift_automaton_create_state(dfa, true);
+
+    /* "a" is claimed by the trap before [ab] can accept it */
+    assert(rift_automaton_add_transition(dfa, s0, trap, "a"));
+    assert(rift_automaton_add_transition(dfa, s0, s1, "[ab]"));
+
+    rift_regex_automaton_t *minimized = rift_hopcroft_minimize(dfa, &error);
+    assert(minimized != NULL);
+    assert_same_language(dfa, minimized, 3);
+
+    rift_automaton_free(minimized);
+    rift_automaton_free(dfa);
+    printf("test_hopcroft_shadowed_edge: PASSED\n");
+}
+
+/* Test minimizing a DFA that is already minimal, built from (a|b)*a(a|b){7} */
+void
+test_hopcroft_minimal_dfa(void)
+{
+    const int n = 7;
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *states[9];
+
+    for (int i = 0; i <= n + 1; i++) {
+        states[i] = rift_automaton_create_state(nfa, i == n + 1);
+    }
+    assert(rift_automaton_add_transition(nfa, states[0], states[0], "[ab]"));
+    assert(rift_automaton_add_transition(nfa, states[0], states[1], "a"));
+    for (int i = 1; i <= n; i++) {
+        assert(rift_automaton_add_transition(nfa, states[i], states[i + 1], "[ab]"));
+    }
+
+    rift_regex_automaton_t *dfa = rift_automaton_nfa_to_dfa(nfa, &error);
+    assert(dfa != NULL);
+
+    rift_regex_automaton_t *minimized = rift_hopcroft_minimize(dfa, &error);
+    assert(minimized != NULL);
+    assert(rift_automaton_get_state_count(minimized) == (size_t)1 << (n + 1));
+    assert_same_language(dfa, minimized, 11);
+
+    rift_automaton_free(minimized);
+    rift_automaton_free(dfa);
+    rift_automaton_free(nfa);
+    printf("test_hopcroft_minimal_dfa: PASSED\n");
+}
+
+/* Test invalid arguments */
+void
+test_hopcroft_invalid(void)
+{
+    rift_regex_error_t error = {0};
+    uint32_t num_blocks = 0;
+
+    assert(rift_hopcroft_minimize(NULL, &error) == NULL);
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_PARAMETER);
+    assert(!rift_hopcroft_partition(NULL, NULL, &num_blocks, &error));
+
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *s0 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s1 = rift_automaton_create_state(nfa, true);
+    assert(rift_automaton_create_epsilon_transition(nfa, s0, s1));
+    assert(rift_hopcroft_minimize(nfa, &error) == NULL);
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_AUTOMATON);
+    rift_automaton_free(nfa);
+
+    printf("test_hopcroft_invalid: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running Hopcroft minimization tests...\n");
+
+    test_hopcroft_merge();
+    test_hopcroft_dead_states();
+    test_hopcroft_shadowed_edge();
+    test_hopcroft_minimal_dfa();
+    test_hopcroft_invalid();
+
+    printf("All Hopcroft minimization tests PASSED!\n");
+    return 0;
+}
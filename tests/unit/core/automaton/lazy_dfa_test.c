@@ -0,0 +1,578 @@
+/**
+ * @file lazy_dfa_test.c
+ * @brief Unit tests for the lazy DFA of the LibRift regex engine
+ *
+ * This file contains test cases verifying on-demand state construction,
+ * cache flushing, the fallback to NFA simulation, saved state caches, and
+ * anchors and word boundaries.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/automaton/automaton.h"
+#include "core/automaton/lazy_dfa.h"
+#include "core/automaton/reverse.h"
+#include "core/automaton/state.h"
+
+#define EXPONENTIAL_N 7
+
+/* Build an NFA for (a|b)*a(a|b){7}, whose DFA has 2^8 states */
+static rift_regex_automaton_t *
+create_exponential_nfa(void)
+{
+    const int n = EXPONENTIAL_N;
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *states[EXPONENTIAL_N + 2];
+
+    for (int i = 0; i <= n + 1; i++) {
+        states[i] = rift_automaton_create_state(nfa, i == n + 1);
+        assert(states[i] != NULL);
+    }
+
+    assert(rift_automaton_add_transition(nfa, states[0], states[0], "[ab]"));
+    assert(rift_automaton_add_transition(nfa, states[0], states[1], "a"));
+    for (int i = 1; i <= n; i++) {
+        assert(rift_automaton_add_transition(nfa, states[i], states[i + 1], "[ab]"));
+    }
+
+    return nfa;
+}
+
+/* Reference result for (a|b)*a(a|b){7} on a string over {a, b} */
+static bool
+exponential_expected(const char *input, size_t length)
+{
+    return length > EXPONENTIAL_N && input[length - EXPONENTIAL_N - 1] == 'a';
+}
+
+/* Fill a buffer with a pseudo-random string over {a, b} */
+static void
+random_ab(char *buffer, size_t length, unsigned *seed)
+{
+    for (size_t i = 0; i < length; i++) {
+        *seed = *seed * 1103515245u + 12345u;
+        buffer[i] = ((*seed >> 16) & 1) ? 'a' : 'b';
+    }
+}
+
+/* Test prefix matching with epsilon transitions */
+void
+test_lazy_dfa_prefix(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *s0 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s1 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s2 = rift_automaton_create_state(nfa, true);
+
+    /* ab+ */
+    assert(rift_automaton_add_transition(nfa, s0, s1, "a"));
+    assert(rift_automaton_add_transition(nfa, s1, s2, "b"));
+    assert(rift_automaton_create_epsilon_transition(nfa, s2, s1));
+
+    rift_lazy_dfa_t *lazy = rift_lazy_dfa_create(nfa, 0, &error);
+    assert(lazy != NULL);
+    assert(lazy->max_cached_states == RIFT_LAZY_DFA_DEFAULT_CACHE_STATES);
+
+    size_t end = 0;
+    assert(rift_lazy_dfa_match_prefix(lazy, "abbbc", 5, false, &end));
+    assert(end == 4);
+    assert(rift_lazy_dfa_match_prefix(lazy, "abbbc", 5, true, &end));
+    assert(end == 2);
+    assert(!rift_lazy_dfa_match_prefix(lazy, "ba", 2, false, &end));
+    assert(!rift_lazy_dfa_match_prefix(lazy, "", 0, false, &end));
+
+    assert(rift_lazy_dfa_matches(lazy, "abb", 3));
+    assert(!rift_lazy_dfa_matches(lazy, "abba", 4));
+
+    /* Repeated searches reuse the cached states */
+    size_t built = lazy->stats.states_built;
+    assert(rift_lazy_dfa_matches(lazy, "abbb", 4));
+    assert(lazy->stats.states_built == built);
+    assert(rift_lazy_dfa_cached_states(lazy) == built);
+
+    rift_lazy_dfa_free(lazy);
+    rift_automaton_free(nfa);
+    printf("test_lazy_dfa_prefix: PASSED\n");
+}
+
+/* Test telling whether a prefix search needs more input */
+void
+test_lazy_dfa_partial(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *s0 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s1 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s2 = rift_automaton_create_state(nfa, true);
+
+    /* ab+ */
+    assert(rift_automaton_add_transition(nfa, s0, s1, "a"));
+    assert(rift_automaton_add_transition(nfa, s1, s2, "b"));
+    assert(rift_automaton_create_epsilon_transition(nfa, s2, s1));
+
+    rift_lazy_dfa_t *lazy = rift_lazy_dfa_create(nfa, 0, &error);
+    assert(lazy != NULL);
+
+    size_t end = 0;
+    bool needs_more = false;
+
+    /* A longest match running into the end of the input may grow */
+    assert(rift_lazy_dfa_match_prefix_partial(lazy, "abb", 3, false, &end, &needs_more));
+    assert(end == 3 && needs_more);
+
+    /* A match ended by a rejected byte is final */
+    assert(rift_lazy_dfa_match_prefix_partial(lazy, "abbc", 4, false, &end, &needs_more));
+    assert(end == 3 && !needs_more);
+
+    /* An earliest match does not wait for more input */
+    assert(rift_lazy_dfa_match_prefix_partial(lazy, "ab", 2, true, &end, &needs_more));
+    assert(end == 2 && !needs_more);
+
+    /* No match yet, but one may follow */
+    assert(!rift_lazy_dfa_match_prefix_partial(lazy, "a", 1, false, &end, &needs_more));
+    assert(needs_more);
+    assert(!rift_lazy_dfa_match_prefix_partial(lazy, "", 0, false, &end, &needs_more));
+    assert(needs_more);
+    assert(!rift_lazy_dfa_match_prefix_partial(lazy, "b", 1, false, &end, &needs_more));
+    assert(!needs_more);
+
+    rift_lazy_dfa_free(lazy);
+    rift_automaton_free(nfa);
+    printf("test_lazy_dfa_partial: PASSED\n");
+}
+
+/* Test that a small cache is flushed without changing results */
+void
+test_lazy_dfa_flush(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa = create_exponential_nfa();
+
+    rift_lazy_dfa_t *lazy = rift_lazy_dfa_create(nfa, 16, &error);
+    assert(lazy != NULL);
+
+    char buffer[64];
+    unsigned seed = 1;
+    for (int i = 0; i < 500; i++) {
+        size_t length = (size_t)(i % 40);
+        random_ab(buffer, length, &seed);
+        assert(rift_lazy_dfa_matches(lazy, buffer, length) == exponential_expected(buffer, length));
+        assert(rift_lazy_dfa_cached_states(lazy) <= 16);
+    }
+    assert(lazy->stats.cache_flushes > 0);
+
+    rift_lazy_dfa_flush(lazy);
+    assert(rift_lazy_dfa_cached_states(lazy) == 0);
+
+    rift_lazy_dfa_free(lazy);
+    rift_automaton_free(nfa);
+    printf("test_lazy_dfa_flush: PASSED\n");
+}
+
+/* Test that a thrashing cache falls back to NFA simulation */
+void
+test_lazy_dfa_fallback(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa = create_exponential_nfa();
+
+    rift_lazy_dfa_t *lazy = rift_lazy_dfa_create(nfa, RIFT_LAZY_DFA_MIN_CACHE_STATES, &error);
+    assert(lazy != NULL);
+
+    char buffer[2048];
+    unsigned seed = 7;
+    random_ab(buffer, sizeof(buffer), &seed);
+
+    for (size_t length = sizeof(buffer) - 8; length <= sizeof(buffer); length++) {
+        assert(rift_lazy_dfa_matches(lazy, buffer, length) == exponential_expected(buffer, length));
+    }
+    assert(lazy->stats.nfa_fallbacks > 0);
+    assert(rift_lazy_dfa_cached_states(lazy) <= RIFT_LAZY_DFA_MIN_CACHE_STATES);
+
+    /* The simulation still sees that (a|b)* never dies */
+    bool needs_more = false;
+    rift_lazy_dfa_match_prefix_partial(lazy, buffer, sizeof(buffer), false, NULL, &needs_more);
+    assert(needs_more);
+
+    rift_lazy_dfa_free(lazy);
+    rift_automaton_free(nfa);
+    printf("test_lazy_dfa_fallback: PASSED\n");
+}
+
+/* Test that the state cache is sized to a memory budget */
+void
+test_lazy_dfa_budget(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa = create_exponential_nfa();
+
+    rift_lazy_dfa_t *lazy = rift_lazy_dfa_create_with_budget(nfa, 1024, &error);
+    assert(lazy != NULL);
+    assert(lazy->max_cached_states >= RIFT_LAZY_DFA_MIN_CACHE_STATES);
+    assert(lazy->max_cached_states < RIFT_LAZY_DFA_DEFAULT_CACHE_STATES);
+
+    char buffer[64];
+    unsigned seed = 3;
+    for (int i = 0; i < 200; i++) {
+        size_t length = (size_t)(i % 40);
+        random_ab(buffer, length, &seed);
+        assert(rift_lazy_dfa_matches(lazy, buffer, length) == exponential_expected(buffer, length));
+        assert(rift_lazy_dfa_cached_states(lazy) <= lazy->max_cached_states);
+    }
+    rift_lazy_dfa_free(lazy);
+
+    /* A budget that cannot hold the smallest cache is refused */
+    assert(rift_lazy_dfa_create_with_budget(nfa, 8, &error) == NULL);
+    assert(error.code == RIFT_REGEX_ERROR_LIMIT_EXCEEDED);
+
+    rift_automaton_free(nfa);
+    printf("test_lazy_dfa_budget: PASSED\n");
+}
+
+/* Leftmost start of a match before limit, narrowed as the matcher does */
+static bool
+leftmost_start(rift_lazy_dfa_t *forward, rift_lazy_dfa_t *reverse, const char *input,
+               size_t length, size_t *start)
+{
+    size_t limit = length + 1;
+    size_t end = 0;
+    bool found = false;
+    while (limit > 0 && rift_lazy_dfa_find_earliest_end(forward, input, length, limit, &end)) {
+        size_t suffix = 0;
+        assert(rift_lazy_dfa_match_suffix(reverse, input, end, false, &suffix));
+        assert(suffix > 0 && end - suffix < limit);
+        limit = end - suffix;
+        found = true;
+    }
+    *start = limit;
+    return found;
+}
+
+/* Test locating match starts with a reversed automaton */
+void
+test_lazy_dfa_reverse_search(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *states[6];
+    for (int i = 0; i < 6; i++) {
+        states[i] = rift_automaton_create_state(nfa, i == 4 || i == 5);
+        assert(states[i] != NULL);
+    }
+
+    /* abcd|c */
+    assert(rift_automaton_add_transition(nfa, states[0], states[1], "a"));
+    assert(rift_automaton_add_transition(nfa, states[1], states[2], "b"));
+    assert(rift_automaton_add_transition(nfa, states[2], states[3], "c"));
+    assert(rift_automaton_add_transition(nfa, states[3], states[4], "d"));
+    assert(rift_automaton_add_transition(nfa, states[0], states[5], "c"));
+
+    rift_regex_automaton_t *reversed = rift_automaton_reverse(nfa, &error);
+    assert(reversed != NULL);
+    rift_lazy_dfa_t *reverse = rift_lazy_dfa_create(reversed, 0, &error);
+    rift_lazy_dfa_t *forward = rift_lazy_dfa_create_unanchored(nfa, 0, &error);
+    assert(reverse != NULL && forward != NULL);
+
+    size_t length = 0;
+    assert(rift_lazy_dfa_match_suffix(reverse, "xxabcd", 6, false, &length));
+    assert(length == 4);
+    assert(!rift_lazy_dfa_match_suffix(reverse, "abcx", 4, false, &length));
+
+    size_t end = 0;
+    assert(rift_lazy_dfa_find_earliest_end(forward, "xabcd", 5, 6, &end));
+    assert(end == 4);
+    assert(rift_lazy_dfa_find_earliest_end(forward, "xabcd", 5, 3, &end));
+    assert(end == 5);
+    assert(!rift_lazy_dfa_find_earliest_end(forward, "xabcd", 5, 1, &end));
+
+    /* The earliest end belongs to "c", but "abcd" starts further left */
+    size_t start = 0;
+    assert(leftmost_start(forward, reverse, "xabcd", 5, &start));
+    assert(start == 1);
+    assert(leftmost_start(forward, reverse, "xxcab", 5, &start));
+    assert(start == 2);
+    assert(!leftmost_start(forward, reverse, "xabx", 4, &start));
+
+    rift_lazy_dfa_free(forward);
+    rift_lazy_dfa_free(reverse);
+    rift_automaton_free(reversed);
+    rift_automaton_free(nfa);
+    printf("test_lazy_dfa_reverse_search: PASSED\n");
+}
+
+/* Test that a saved cache lets a new lazy DFA start warm */
+void
+test_lazy_dfa_cache_warm_start(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa = create_exponential_nfa();
+
+    rift_lazy_dfa_t *cold = rift_lazy_dfa_create(nfa, 0, &error);
+    assert(cold != NULL);
+
+    char buffer[64];
+    unsigned seed = 11;
+    for (int i = 0; i < 300; i++) {
+        size_t length = (size_t)(i % 40);
+        random_ab(buffer, length, &seed);
+        rift_lazy_dfa_matches(cold, buffer, length);
+    }
+    size_t cached = rift_lazy_dfa_cached_states(cold);
+    assert(cached > 1);
+
+    size_t size = 0;
+    assert(rift_lazy_dfa_save_cache(cold, NULL, &size));
+    uint8_t *data = malloc(size);
+    assert(data != NULL);
+    size_t small = size - 1;
+    assert(!rift_lazy_dfa_save_cache(cold, data, &small));
+    assert(rift_lazy_dfa_save_cache(cold, data, &size));
+
+    /* The loaded states answer searches without building any more */
+    rift_lazy_dfa_t *warm = rift_lazy_dfa_create(nfa, 0, &error);
+    assert(warm != NULL);
+    assert(rift_lazy_dfa_load_cache(warm, data, size, &error));
+    assert(rift_lazy_dfa_cached_states(warm) == cached);
+    assert(warm->stats.states_built == 0);
+
+    seed = 11;
+    for (int i = 0; i < 300; i++) {
+        size_t length = (size_t)(i % 40);
+        random_ab(buffer, length, &seed);
+        assert(rift_lazy_dfa_matches(warm, buffer, length) == exponential_expected(buffer, length));
+    }
+    assert(warm->stats.states_built == 0);
+
+    /* A smaller cache keeps the states that fit */
+    rift_lazy_dfa_t *partial = rift_lazy_dfa_create(nfa, RIFT_LAZY_DFA_MIN_CACHE_STATES, &error);
+    assert(partial != NULL);
+    assert(rift_lazy_dfa_load_cache(partial, data, size, &error));
+    assert(rift_lazy_dfa_cached_states(partial) == RIFT_LAZY_DFA_MIN_CACHE_STATES);
+    for (size_t length = 0; length < sizeof(buffer); length++) {
+        random_ab(buffer, length, &seed);
+        assert(rift_lazy_dfa_matches(partial, buffer, length) ==
+               exponential_expected(buffer, length));
+    }
+
+    /* Truncated or altered data and other automata are refused */
+    assert(!rift_lazy_dfa_load_cache(warm, data, size - 1, &error));
+    assert(rift_lazy_dfa_cached_states(warm) == cached);
+    data[0] ^= 0xff;
+    assert(!rift_lazy_dfa_load_cache(warm, data, size, &error));
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_PARAMETER);
+    data[0] ^= 0xff;
+
+    rift_regex_automaton_t *other = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *s0 = rift_automaton_create_state(other, false);
+    rift_regex_state_t *s1 = rift_automaton_create_state(other, true);
+    assert(rift_automaton_add_transition(other, s0, s1, "a"));
+    rift_lazy_dfa_t *mismatch = rift_lazy_dfa_create(other, 0, &error);
+    assert(mismatch != NULL);
+    assert(!rift_lazy_dfa_load_cache(mismatch, data, size, &error));
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_AUTOMATON);
+    rift_lazy_dfa_t *unanchored = rift_lazy_dfa_create_unanchored(nfa, 0, &error);
+    assert(unanchored != NULL);
+    assert(!rift_lazy_dfa_load_cache(unanchored, data, size, &error));
+
+    rift_lazy_dfa_free(unanchored);
+    rift_lazy_dfa_free(mismatch);
+    rift_automaton_free(other);
+    rift_lazy_dfa_free(partial);
+    rift_lazy_dfa_free(warm);
+    rift_lazy_dfa_free(cold);
+    free(data);
+    rift_automaton_free(nfa);
+    printf("test_lazy_dfa_cache_warm_start: PASSED\n");
+}
+
+/* Build an NFA for one asserting state, a literal and another asserting state */
+static rift_regex_automaton_t *
+create_asserting_nfa(const char *literal, rift_state_flag_t before, rift_state_flag_t after)
+{
+    size_t length = strlen(literal);
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *start = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *previous = rift_automaton_create_state(nfa, false);
+    assert(start != NULL && previous != NULL);
+    assert(rift_state_set_flag(previous, before));
+    assert(rift_automaton_create_epsilon_transition(nfa, start, previous));
+
+    for (size_t i = 0; i < length; i++) {
+        char pattern[2] = {literal[i], '\0'};
+        rift_regex_state_t *next = rift_automaton_create_state(nfa, false);
+        assert(next != NULL);
+        assert(rift_automaton_add_transition(nfa, previous, next, pattern));
+        previous = next;
+    }
+
+    rift_regex_state_t *accept = rift_automaton_create_state(nfa, true);
+    assert(accept != NULL);
+    assert(rift_state_set_flag(accept, after));
+    assert(rift_automaton_create_epsilon_transition(nfa, previous, accept));
+    return nfa;
+}
+
+/* Test word boundaries, in searches and around the input */
+void
+test_lazy_dfa_word_boundary(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa = create_asserting_nfa("foo", RIFT_STATE_FLAG_WORD_BOUNDARY,
+                                                       RIFT_STATE_FLAG_WORD_BOUNDARY);
+    rift_lazy_dfa_t *search = rift_lazy_dfa_create_unanchored(nfa, 0, &error);
+    rift_lazy_dfa_t *anchored = rift_lazy_dfa_create(nfa, 0, &error);
+    assert(search != NULL && anchored != NULL);
+    assert(search->has_assertions);
+
+    /* \bfoo\b */
+    size_t end = 0;
+    assert(rift_lazy_dfa_find_earliest_end(search, "a foo.", 6, 7, &end));
+    assert(end == 5);
+    assert(rift_lazy_dfa_find_earliest_end(search, "afoo foo", 8, 9, &end));
+    assert(end == 8);
+    assert(!rift_lazy_dfa_find_earliest_end(search, "afoo foobar", 11, 12, &end));
+    assert(!rift_lazy_dfa_find_earliest_end(search, "_foo", 4, 5, &end));
+
+    /* A thrashing cache falls back to a simulation that checks them too */
+    rift_lazy_dfa_t *small = rift_lazy_dfa_create_unanchored(nfa, RIFT_LAZY_DFA_MIN_CACHE_STATES,
+                                                             &error);
+    assert(small != NULL);
+    const char *texts[] = {"afoo foobar xfoo foo", "foofoo foo_ ofoo", "a foo"};
+    for (size_t i = 0; i < sizeof(texts) / sizeof(texts[0]); i++) {
+        size_t text_length = strlen(texts[i]);
+        size_t small_end = 0;
+        bool found = rift_lazy_dfa_find_earliest_end(search, texts[i], text_length,
+                                                     text_length + 1, &end);
+        assert(rift_lazy_dfa_find_earliest_end(small, texts[i], text_length, text_length + 1,
+                                               &small_end) == found);
+        assert(!found || small_end == end);
+    }
+    assert(small->stats.nfa_fallbacks > 0);
+    rift_lazy_dfa_free(small);
+
+    /* The bytes around a slice decide the boundaries at its ends */
+    size_t length = 0;
+    assert(rift_lazy_dfa_match_prefix(anchored, "foo", 3, false, &length));
+    assert(length == 3);
+    rift_lazy_dfa_set_context(anchored, 'x', RIFT_LAZY_DFA_TEXT_EDGE);
+    assert(!rift_lazy_dfa_match_prefix(anchored, "foo", 3, false, &length));
+    rift_lazy_dfa_set_context(anchored, ' ', '9');
+    assert(!rift_lazy_dfa_match_prefix(anchored, "foo", 3, false, &length));
+    rift_lazy_dfa_set_context(anchored, ' ', '-');
+    assert(rift_lazy_dfa_match_prefix(anchored, "foo", 3, false, &length));
+    rift_lazy_dfa_set_context(anchored, RIFT_LAZY_DFA_TEXT_EDGE, RIFT_LAZY_DFA_TEXT_EDGE);
+    assert(rift_lazy_dfa_match_prefix(anchored, "foo", 3, false, &length));
+
+    /* Read backward, the boundaries test the same positions */
+    rift_regex_automaton_t *reversed = rift_automaton_reverse(nfa, &error);
+    assert(reversed != NULL);
+    rift_lazy_dfa_t *reverse = rift_lazy_dfa_create(reversed, 0, &error);
+    assert(reverse != NULL);
+    assert(rift_lazy_dfa_match_suffix(reverse, "a foo", 5, false, &length));
+    assert(length == 3);
+    assert(!rift_lazy_dfa_match_suffix(reverse, "afoo", 4, false, &length));
+
+    rift_lazy_dfa_free(reverse);
+    rift_automaton_free(reversed);
+    rift_lazy_dfa_free(anchored);
+    rift_lazy_dfa_free(search);
+    rift_automaton_free(nfa);
+    printf("test_lazy_dfa_word_boundary: PASSED\n");
+}
+
+/* Test start and end anchors, with and without multiline mode */
+void
+test_lazy_dfa_anchors(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa =
+        create_asserting_nfa("ab", RIFT_STATE_FLAG_ANCHOR_START, RIFT_STATE_FLAG_ANCHOR_END);
+
+    /* ^ab$ */
+    rift_lazy_dfa_t *search = rift_lazy_dfa_create_unanchored(nfa, 0, &error);
+    assert(search != NULL);
+    size_t end = 0;
+    assert(rift_lazy_dfa_find_earliest_end(search, "ab", 2, 3, &end));
+    assert(end == 2);
+    assert(!rift_lazy_dfa_find_earliest_end(search, "x\nab\ny", 6, 7, &end));
+    assert(!rift_lazy_dfa_find_earliest_end(search, "abab", 4, 5, &end));
+    assert(rift_lazy_dfa_matches(search, "ab", 2));
+    rift_lazy_dfa_free(search);
+
+    /* In multiline mode they also hold next to a newline */
+    assert(rift_automaton_set_flags(nfa, RIFT_REGEX_FLAG_MULTILINE));
+    search = rift_lazy_dfa_create_unanchored(nfa, 0, &error);
+    assert(search != NULL);
+    assert(rift_lazy_dfa_find_earliest_end(search, "x\nab\ny", 6, 7, &end));
+    assert(end == 4);
+    assert(!rift_lazy_dfa_find_earliest_end(search, "x\nabc\n", 6, 7, &end));
+
+    /* A reversed start anchor tests the end of what is read backward */
+    rift_regex_automaton_t *reversed = rift_automaton_reverse(nfa, &error);
+    assert(reversed != NULL);
+    rift_lazy_dfa_t *reverse = rift_lazy_dfa_create(reversed, 0, &error);
+    assert(reverse != NULL);
+    size_t length = 0;
+    assert(rift_lazy_dfa_match_suffix(reverse, "x\nab", 4, false, &length));
+    assert(length == 2);
+    assert(!rift_lazy_dfa_match_suffix(reverse, "xab", 3, false, &length));
+    rift_lazy_dfa_set_context(reverse, '\n', RIFT_LAZY_DFA_TEXT_EDGE);
+    assert(rift_lazy_dfa_match_suffix(reverse, "ab", 2, false, &length));
+    rift_lazy_dfa_set_context(reverse, 'x', RIFT_LAZY_DFA_TEXT_EDGE);
+    assert(!rift_lazy_dfa_match_suffix(reverse, "ab", 2, false, &length));
+
+    rift_lazy_dfa_free(reverse);
+    rift_automaton_free(reversed);
+    rift_lazy_dfa_free(search);
+    rift_automaton_free(nfa);
+    printf("test_lazy_dfa_anchors: PASSED\n");
+}
+
+/* Test invalid arguments */
+void
+test_lazy_dfa_invalid(void)
+{
+    rift_regex_error_t error = {0};
+
+    assert(rift_lazy_dfa_create(NULL, 0, &error) == NULL);
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_PARAMETER);
+
+    rift_regex_automaton_t *empty = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    assert(rift_lazy_dfa_create(empty, 0, &error) == NULL);
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_AUTOMATON);
+    rift_automaton_free(empty);
+
+    assert(!rift_lazy_dfa_match_prefix(NULL, "a", 1, false, NULL));
+    assert(!rift_lazy_dfa_matches(NULL, "a", 1));
+    assert(rift_lazy_dfa_cached_states(NULL) == 0);
+    rift_lazy_dfa_free(NULL);
+
+    printf("test_lazy_dfa_invalid: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running lazy DFA tests...\n");
+
+    test_lazy_dfa_prefix();
+    test_lazy_dfa_partial();
+    test_lazy_dfa_flush();
+    test_lazy_dfa_fallback();
+    test_lazy_dfa_budget();
+    test_lazy_dfa_reverse_search();
+    test_lazy_dfa_cache_warm_start();
+    test_lazy_dfa_word_boundary();
+    test_lazy_dfa_anchors();
+    test_lazy_dfa_invalid();
+
+    printf("All lazy DFA tests PASSED!\n");
+    return 0;
+}
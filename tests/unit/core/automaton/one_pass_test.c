@@ -0,0 +1,238 @@
+/**
+ * @file one_pass_test.c
+ * @brief Unit tests for the one-pass DFA of the LibRift regex engine
+ *
+ * This file contains test cases verifying the one-pass check, capture
+ * extraction in one scan and agreement with the Pike VM on every prefix
+ * and start position of a set of inputs.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/automaton/automaton.h"
+#include "core/automaton/one_pass.h"
+#include "core/automaton/pike_vm.h"
+#include "core/automaton/state.h"
+
+/* Build an NFA for x(a*)y with the group around a* */
+static rift_regex_automaton_t *
+create_group_nfa(void)
+{
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *s0 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s1 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s2 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s3 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s4 = rift_automaton_create_state(nfa, true);
+
+    assert(rift_state_set_group_start(s1, true));
+    assert(rift_state_set_group_end(s3, true));
+
+    assert(rift_automaton_add_transition(nfa, s0, s1, "x"));
+    assert(rift_automaton_create_epsilon_transition(nfa, s1, s2));
+    assert(rift_automaton_add_transition(nfa, s2, s2, "a"));
+    assert(rift_automaton_create_epsilon_transition(nfa, s2, s3));
+    assert(rift_automaton_add_transition(nfa, s3, s4, "y"));
+
+    return nfa;
+}
+
+/* Build an NFA for ([a-z]+)=([0-9]*)(;)? with three groups */
+static rift_regex_automaton_t *
+create_key_value_nfa(void)
+{
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *key_start = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *key = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *key_end = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *value_start = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *value = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *value_end = rift_automaton_create_state(nfa, true);
+    rift_regex_state_t *semi_start = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *semi_end = rift_automaton_create_state(nfa, true);
+
+    assert(rift_state_set_group_start(key_start, true));
+    assert(rift_state_set_group_end(key_end, true));
+    assert(rift_state_set_group_start(value_start, true));
+    assert(rift_state_set_group_end(value_end, true));
+    assert(rift_state_set_group_start(semi_start, true));
+    assert(rift_state_set_group_end(semi_end, true));
+
+    assert(rift_automaton_add_transition(nfa, key_start, key, "[a-z]"));
+    assert(rift_automaton_add_transition(nfa, key, key, "[a-z]"));
+    assert(rift_automaton_create_epsilon_transition(nfa, key, key_end));
+    assert(rift_automaton_add_transition(nfa, key_end, value_start, "="));
+    assert(rift_automaton_create_epsilon_transition(nfa, value_start, value));
+    assert(rift_automaton_add_transition(nfa, value, value, "[0-9]"));
+    assert(rift_automaton_create_epsilon_transition(nfa, value, value_end));
+    assert(rift_automaton_create_epsilon_transition(nfa, value_end, semi_start));
+    assert(rift_automaton_add_transition(nfa, semi_start, semi_end, ";"));
+
+    return nfa;
+}
+
+/* Build an NFA for (a|ab)b, which needs two threads after the first a */
+static rift_regex_automaton_t *
+create_ambiguous_nfa(void)
+{
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *s0 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s1 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s2 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s3 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s4 = rift_automaton_create_state(nfa, true);
+
+    assert(rift_automaton_add_transition(nfa, s0, s1, "a"));
+    assert(rift_automaton_add_transition(nfa, s0, s2, "a"));
+    assert(rift_automaton_add_transition(nfa, s2, s3, "b"));
+    assert(rift_automaton_create_epsilon_transition(nfa, s1, s3));
+    assert(rift_automaton_add_transition(nfa, s3, s4, "b"));
+
+    return nfa;
+}
+
+/* Compare the one-pass DFA with the Pike VM at every start of every input */
+static void
+assert_agrees_with_pike_vm(rift_regex_automaton_t *nfa, const char *const *inputs, size_t count)
+{
+    rift_one_pass_t *one_pass = rift_one_pass_create(nfa, NULL);
+    rift_pike_vm_t *vm = rift_pike_vm_create(nfa, NULL);
+    assert(one_pass != NULL && vm != NULL);
+    assert(rift_one_pass_get_slot_count(one_pass) == rift_pike_vm_get_slot_count(vm));
+
+    size_t num_slots = rift_one_pass_get_slot_count(one_pass);
+    size_t expected[RIFT_ONE_PASS_MAX_SLOTS];
+    size_t actual[RIFT_ONE_PASS_MAX_SLOTS];
+    for (size_t i = 0; i < count; i++) {
+        size_t length = strlen(inputs[i]);
+        for (size_t start = 0; start <= length; start++) {
+            for (int earliest = 0; earliest < 2; earliest++) {
+                bool want = rift_pike_vm_search(vm, inputs[i], length, start, true, earliest,
+                                                expected);
+                bool got = rift_one_pass_search(one_pass, inputs[i], length, start, earliest,
+                                                actual);
+                assert(want == got);
+                assert(!want || memcmp(expected, actual, num_slots * sizeof(size_t)) == 0);
+            }
+        }
+    }
+
+    rift_pike_vm_free(vm);
+    rift_one_pass_free(one_pass);
+}
+
+/* Test capture extraction on a one-pass NFA */
+void
+test_one_pass_captures(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa = create_group_nfa();
+
+    rift_one_pass_t *one_pass = rift_one_pass_create(nfa, &error);
+    assert(one_pass != NULL);
+    assert(rift_one_pass_get_group_count(one_pass) == 1);
+    assert(rift_one_pass_get_slot_count(one_pass) == 4);
+
+    size_t slots[4];
+    assert(rift_one_pass_search(one_pass, "zxaay", 5, 1, false, slots));
+    assert(slots[0] == 1 && slots[1] == 5);
+    assert(slots[2] == 2 && slots[3] == 4);
+
+    /* An empty group records equal bounds */
+    assert(rift_one_pass_search(one_pass, "xy", 2, 0, false, slots));
+    assert(slots[2] == 1 && slots[3] == 1);
+
+    /* The search is anchored */
+    assert(!rift_one_pass_search(one_pass, "zxaay", 5, 0, false, slots));
+    assert(!rift_one_pass_search(one_pass, "xaaz", 4, 0, false, slots));
+
+    rift_one_pass_free(one_pass);
+    rift_automaton_free(nfa);
+    printf("test_one_pass_captures: PASSED\n");
+}
+
+/* Test that the matches and captures are those of the Pike VM */
+void
+test_one_pass_matches_pike_vm(void)
+{
+    static const char *const group_inputs[] = {"", "x", "xy", "xay", "xaaay", "xaax", "yxy"};
+    rift_regex_automaton_t *nfa = create_group_nfa();
+    assert_agrees_with_pike_vm(nfa, group_inputs, sizeof(group_inputs) / sizeof(*group_inputs));
+    rift_automaton_free(nfa);
+
+    static const char *const key_value_inputs[] = {
+        "key=42;", "a=", "a=1", "ab=12;x", "=1", "k=1;;", "user=7;id=9;", "x=y", "abc"};
+    nfa = create_key_value_nfa();
+    assert_agrees_with_pike_vm(nfa, key_value_inputs,
+                               sizeof(key_value_inputs) / sizeof(*key_value_inputs));
+
+    /* The longest match takes the optional group, the earliest stops before it */
+    rift_one_pass_t *one_pass = rift_one_pass_create(nfa, NULL);
+    size_t slots[8];
+    assert(rift_one_pass_search(one_pass, "key=42;", 7, 0, false, slots));
+    assert(slots[1] == 7 && slots[2] == 0 && slots[3] == 3 && slots[4] == 4 && slots[5] == 6);
+    assert(slots[6] == 6 && slots[7] == 7);
+    assert(rift_one_pass_search(one_pass, "key=42;", 7, 0, true, slots));
+    assert(slots[1] == 4 && slots[6] == RIFT_ONE_PASS_NO_POSITION);
+    rift_one_pass_free(one_pass);
+    rift_automaton_free(nfa);
+
+    printf("test_one_pass_matches_pike_vm: PASSED\n");
+}
+
+/* Test that NFAs needing more than one thread are refused */
+void
+test_one_pass_rejects_ambiguous(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa = create_ambiguous_nfa();
+
+    assert(rift_one_pass_create(nfa, &error) == NULL);
+    assert(error.code == RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE);
+
+    rift_automaton_free(nfa);
+    printf("test_one_pass_rejects_ambiguous: PASSED\n");
+}
+
+/* Test invalid arguments */
+void
+test_one_pass_invalid(void)
+{
+    rift_regex_error_t error = {0};
+    assert(rift_one_pass_create(NULL, &error) == NULL);
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_PARAMETER);
+
+    rift_regex_automaton_t *nfa = create_group_nfa();
+    rift_one_pass_t *one_pass = rift_one_pass_create(nfa, NULL);
+    assert(one_pass != NULL);
+    assert(!rift_one_pass_search(one_pass, "xy", 2, 3, false, NULL));
+    assert(!rift_one_pass_search(one_pass, NULL, 2, 0, false, NULL));
+    rift_one_pass_free(one_pass);
+    rift_automaton_free(nfa);
+
+    assert(!rift_one_pass_search(NULL, "x", 1, 0, false, NULL));
+    assert(rift_one_pass_get_group_count(NULL) == 0);
+    rift_one_pass_free(NULL);
+
+    printf("test_one_pass_invalid: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running one-pass DFA tests...\n");
+
+    test_one_pass_captures();
+    test_one_pass_matches_pike_vm();
+    test_one_pass_rejects_ambiguous();
+    test_one_pass_invalid();
+
+    printf("All one-pass DFA tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,304 @@
+/**
+ * @file pike_vm_test.c
+ * @brief Unit tests for the Pike VM of the LibRift regex engine
+ *
+ * This file contains test cases verifying leftmost matching, capture
+ * extraction, lookaround states and linear behavior on patterns that make
+ * backtracking explode.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/automaton/automaton.h"
+#include "core/automaton/lookaround.h"
+#include "core/automaton/pike_vm.h"
+#include "core/automaton/state.h"
+
+/* Build an NFA for x(a*)y with the group around a* */
+static rift_regex_automaton_t *
+create_group_nfa(void)
+{
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *s0 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s1 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s2 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s3 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s4 = rift_automaton_create_state(nfa, true);
+
+    assert(rift_state_set_group_start(s1, true));
+    assert(rift_state_set_group_end(s3, true));
+
+    assert(rift_automaton_add_transition(nfa, s0, s1, "x"));
+    assert(rift_automaton_create_epsilon_transition(nfa, s1, s2));
+    assert(rift_automaton_add_transition(nfa, s2, s2, "a"));
+    assert(rift_automaton_create_epsilon_transition(nfa, s2, s3));
+    assert(rift_automaton_add_transition(nfa, s3, s4, "y"));
+
+    return nfa;
+}
+
+/* Test unanchored search with capture extraction */
+void
+test_pike_vm_captures(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa = create_group_nfa();
+
+    rift_pike_vm_t *vm = rift_pike_vm_create(nfa, &error);
+    assert(vm != NULL);
+    assert(rift_pike_vm_get_group_count(vm) == 1);
+    assert(rift_pike_vm_get_slot_count(vm) == 4);
+
+    size_t slots[4];
+    const char *input = "zxaay";
+    assert(rift_pike_vm_search(vm, input, 5, 0, false, false, slots));
+    assert(slots[0] == 1 && slots[1] == 5);
+    assert(slots[2] == 2 && slots[3] == 4);
+
+    /* An empty group records equal bounds */
+    assert(rift_pike_vm_search(vm, "xy", 2, 0, true, false, slots));
+    assert(slots[2] == 1 && slots[3] == 1);
+
+    assert(!rift_pike_vm_search(vm, input, 5, 0, true, false, slots));
+    assert(rift_pike_vm_search(vm, input, 5, 1, true, false, NULL));
+    assert(!rift_pike_vm_search(vm, "xaaz", 4, 0, false, false, slots));
+
+    rift_pike_vm_free(vm);
+    rift_automaton_free(nfa);
+    printf("test_pike_vm_captures: PASSED\n");
+}
+
+/* Test a pattern with more groups than states used to have room for */
+void
+test_pike_vm_many_groups(void)
+{
+    enum { NUM_GROUPS = 30 };
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *previous = rift_automaton_create_state(nfa, false);
+
+    /* One group around each 'a' of a{30} */
+    for (size_t i = 0; i < NUM_GROUPS; i++) {
+        rift_regex_state_t *open = rift_automaton_create_state(nfa, false);
+        rift_regex_state_t *close = rift_automaton_create_state(nfa, i + 1 == NUM_GROUPS);
+        assert(rift_state_set_group_start(open, true));
+        assert(rift_state_set_group_end(close, true));
+        assert(rift_automaton_create_epsilon_transition(nfa, previous, open));
+        assert(rift_automaton_add_transition(nfa, open, close, "a"));
+        previous = close;
+    }
+
+    /* States outside group boundaries carry no group data */
+    rift_regex_state_t *plain = rift_state_create(false);
+    assert(plain->capture == NULL);
+    assert(rift_state_set_group_end(plain, false));
+    assert(plain->capture == NULL && !rift_state_is_group_end(plain));
+    rift_state_free(plain);
+
+    rift_pike_vm_t *vm = rift_pike_vm_create(nfa, &error);
+    assert(vm != NULL);
+    assert(rift_pike_vm_get_group_count(vm) == NUM_GROUPS);
+
+    char input[NUM_GROUPS];
+    memset(input, 'a', NUM_GROUPS);
+    size_t slots[2 * (NUM_GROUPS + 1)];
+    assert(rift_pike_vm_search(vm, input, NUM_GROUPS, 0, true, false, slots));
+    for (size_t i = 0; i < NUM_GROUPS; i++) {
+        assert(slots[2 * (i + 1)] == i && slots[2 * (i + 1) + 1] == i + 1);
+    }
+
+    rift_pike_vm_free(vm);
+    rift_automaton_free(nfa);
+    printf("test_pike_vm_many_groups: PASSED\n");
+}
+
+/* Test longest and earliest match ends */
+void
+test_pike_vm_match_end(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *s0 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s1 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s2 = rift_automaton_create_state(nfa, true);
+
+    /* ab+ */
+    assert(rift_automaton_add_transition(nfa, s0, s1, "a"));
+    assert(rift_automaton_add_transition(nfa, s1, s2, "b"));
+    assert(rift_automaton_create_epsilon_transition(nfa, s2, s1));
+
+    rift_pike_vm_t *vm = rift_pike_vm_create(nfa, &error);
+    assert(vm != NULL);
+    assert(rift_pike_vm_get_group_count(vm) == 0);
+
+    size_t slots[2];
+    assert(rift_pike_vm_search(vm, "cabbba", 6, 0, false, false, slots));
+    assert(slots[0] == 1 && slots[1] == 5);
+    assert(rift_pike_vm_search(vm, "cabbba", 6, 0, false, true, slots));
+    assert(slots[0] == 1 && slots[1] == 3);
+
+    /* The leftmost start wins over a longer match further right */
+    assert(rift_pike_vm_search(vm, "abcabbb", 7, 0, false, false, slots));
+    assert(slots[0] == 0 && slots[1] == 2);
+
+    rift_pike_vm_free(vm);
+    rift_automaton_free(nfa);
+    printf("test_pike_vm_match_end: PASSED\n");
+}
+
+/* Test (a?){n}a{n} on a^n, which takes 2^n steps for a backtracker */
+void
+test_pike_vm_pathological(void)
+{
+    const int n = 30;
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *states[61];
+
+    for (int i = 0; i <= 2 * n; i++) {
+        states[i] = rift_automaton_create_state(nfa, i == 2 * n);
+        assert(states[i] != NULL);
+    }
+    for (int i = 0; i < n; i++) {
+        assert(rift_automaton_add_transition(nfa, states[i], states[i + 1], "a"));
+        assert(rift_automaton_create_epsilon_transition(nfa, states[i], states[i + 1]));
+    }
+    for (int i = n; i < 2 * n; i++) {
+        assert(rift_automaton_add_transition(nfa, states[i], states[i + 1], "a"));
+    }
+
+    rift_pike_vm_t *vm = rift_pike_vm_create(nfa, &error);
+    assert(vm != NULL);
+
+    char input[61];
+    memset(input, 'a', sizeof(input));
+
+    size_t slots[2];
+    assert(rift_pike_vm_search(vm, input, (size_t)n, 0, true, false, slots));
+    assert(slots[1] == (size_t)n);
+    assert(rift_pike_vm_search(vm, input, 2 * (size_t)n + 1, 0, true, false, slots));
+    assert(slots[1] == 2 * (size_t)n);
+    assert(!rift_pike_vm_search(vm, input, (size_t)n - 1, 0, true, false, slots));
+
+    rift_pike_vm_free(vm);
+    rift_automaton_free(nfa);
+    printf("test_pike_vm_pathological: PASSED\n");
+}
+
+/* Build an NFA matching exactly a literal, as a lookaround body */
+static rift_regex_automaton_t *
+create_literal_nfa(const char *literal)
+{
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *state = rift_automaton_create_state(nfa, false);
+    for (const char *c = literal; *c; c++) {
+        char pattern[2] = {*c, '\0'};
+        rift_regex_state_t *next = rift_automaton_create_state(nfa, c[1] == '\0');
+        assert(rift_automaton_add_transition(nfa, state, next, pattern));
+        state = next;
+    }
+    return nfa;
+}
+
+/* Test lookbehind and negative lookahead states */
+void
+test_pike_vm_lookarounds(void)
+{
+    rift_regex_error_t error = {0};
+    size_t slots[2];
+
+    /* (?<=ab)c */
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *s0 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s1 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s2 = rift_automaton_create_state(nfa, true);
+    s0->lookaround = rift_automaton_add_lookaround(nfa, create_literal_nfa("ab"), true, false, 2);
+    assert(s0->lookaround == 0);
+    assert(rift_automaton_create_epsilon_transition(nfa, s0, s1));
+    assert(rift_automaton_add_transition(nfa, s1, s2, "c"));
+
+    rift_pike_vm_t *vm = rift_pike_vm_create(nfa, &error);
+    assert(vm != NULL);
+    assert(rift_pike_vm_search(vm, "xabc", 4, 0, false, false, slots));
+    assert(slots[0] == 3 && slots[1] == 4);
+    assert(!rift_pike_vm_search(vm, "xbc", 3, 0, false, false, slots));
+    assert(!rift_pike_vm_search(vm, "c", 1, 0, false, false, slots));
+    rift_pike_vm_free(vm);
+    rift_automaton_free(nfa);
+
+    /* x(?!y) */
+    nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    s0 = rift_automaton_create_state(nfa, false);
+    s1 = rift_automaton_create_state(nfa, false);
+    s2 = rift_automaton_create_state(nfa, true);
+    assert(rift_automaton_add_transition(nfa, s0, s1, "x"));
+    s1->lookaround = rift_automaton_add_lookaround(nfa, create_literal_nfa("y"), false, true, 0);
+    assert(rift_automaton_create_epsilon_transition(nfa, s1, s2));
+
+    /* Clones carry the lookaround table */
+    rift_regex_automaton_t *clone = rift_automaton_clone(nfa);
+    assert(clone != NULL && rift_automaton_has_lookarounds(clone));
+    rift_automaton_free(nfa);
+
+    vm = rift_pike_vm_create(clone, &error);
+    assert(vm != NULL);
+    assert(rift_pike_vm_search(vm, "xyxz", 4, 0, false, false, slots));
+    assert(slots[0] == 2 && slots[1] == 3);
+    assert(rift_pike_vm_search(vm, "x", 1, 0, false, false, slots));
+    assert(!rift_pike_vm_search(vm, "xy", 2, 0, false, false, slots));
+    rift_pike_vm_free(vm);
+    rift_automaton_free(clone);
+
+    printf("test_pike_vm_lookarounds: PASSED\n");
+}
+
+/* Test invalid arguments */
+void
+test_pike_vm_invalid(void)
+{
+    rift_regex_error_t error = {0};
+
+    assert(rift_pike_vm_create(NULL, &error) == NULL);
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_PARAMETER);
+
+    rift_regex_automaton_t *empty = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    assert(rift_pike_vm_create(empty, &error) == NULL);
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_AUTOMATON);
+    rift_automaton_free(empty);
+
+    rift_regex_automaton_t *nfa = create_group_nfa();
+    rift_pike_vm_t *vm = rift_pike_vm_create(nfa, &error);
+    assert(vm != NULL);
+    assert(!rift_pike_vm_search(vm, "xy", 2, 3, false, false, NULL));
+    assert(!rift_pike_vm_search(vm, NULL, 2, 0, false, false, NULL));
+    rift_pike_vm_free(vm);
+    rift_automaton_free(nfa);
+
+    assert(!rift_pike_vm_search(NULL, "a", 1, 0, false, false, NULL));
+    assert(rift_pike_vm_get_group_count(NULL) == 0);
+    rift_pike_vm_free(NULL);
+
+    printf("test_pike_vm_invalid: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running Pike VM tests...\n");
+
+    test_pike_vm_captures();
+    test_pike_vm_many_groups();
+    test_pike_vm_match_end();
+    test_pike_vm_pathological();
+    test_pike_vm_lookarounds();
+    test_pike_vm_invalid();
+
+    printf("All Pike VM tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,229 @@
+/**
+ * @file product_test.c
+ * @brief Unit tests for DFA products and language comparisons in the LibRift regex engine
+ *
+ * This file contains test cases verifying inclusion and equivalence checks
+ * between DFAs built in different ways, the languages of intersections,
+ * unions, differences and complements, and the rejection of automata the
+ * product walk cannot step through.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/automaton/automaton.h"
+#include "core/automaton/dfa_table.h"
+#include "core/automaton/product.h"
+#include "core/automaton/state.h"
+
+/* Build an automaton from (from, to, pattern) edges; accepting states are set in a mask */
+static rift_regex_automaton_t *
+build(rift_automaton_type_t type, int num_states, unsigned accepting, const int (*edges)[2],
+      const char *const *patterns, int num_edges)
+{
+    rift_regex_automaton_t *automaton = rift_automaton_create(type);
+    assert(automaton != NULL);
+
+    rift_regex_state_t *states[8];
+    for (int i = 0; i < num_states; i++) {
+        states[i] = rift_automaton_create_state(automaton, (accepting >> i) & 1);
+        assert(states[i] != NULL);
+    }
+    assert(rift_automaton_set_initial_state(automaton, states[0]));
+    for (int i = 0; i < num_edges; i++) {
+        assert(rift_automaton_add_transition(automaton, states[edges[i][0]], states[edges[i][1]],
+                                             patterns[i]));
+    }
+    return automaton;
+}
+
+/* Freeze the DFA of an automaton and free the automaton */
+static rift_frozen_automaton_t *
+freeze(rift_regex_automaton_t *automaton)
+{
+    rift_regex_error_t error = {0};
+    rift_frozen_automaton_t *frozen = rift_automaton_freeze_dfa(automaton, &error);
+    assert(frozen != NULL);
+    rift_automaton_free(automaton);
+    return frozen;
+}
+
+/* ab+ as an NFA */
+static rift_frozen_automaton_t *
+ab_plus_nfa(void)
+{
+    static const int edges[][2] = {{0, 1}, {1, 2}, {2, 2}};
+    static const char *const patterns[] = {"a", "b", "b"};
+    return freeze(build(RIFT_AUTOMATON_NFA, 3, 1u << 2, edges, patterns, 3));
+}
+
+/* ab+ as a DFA with a redundant accepting state */
+static rift_frozen_automaton_t *
+ab_plus_dfa(void)
+{
+    static const int edges[][2] = {{0, 1}, {1, 2}, {2, 3}, {3, 3}};
+    static const char *const patterns[] = {"a", "b", "b", "b"};
+    return freeze(build(RIFT_AUTOMATON_DFA, 4, (1u << 2) | (1u << 3), edges, patterns, 4));
+}
+
+/* a[ab]+ as a DFA */
+static rift_frozen_automaton_t *
+a_ab_plus_dfa(void)
+{
+    static const int edges[][2] = {{0, 1}, {1, 2}, {2, 2}};
+    static const char *const patterns[] = {"a", "[ab]", "[ab]"};
+    return freeze(build(RIFT_AUTOMATON_DFA, 3, 1u << 2, edges, patterns, 3));
+}
+
+/* The single string c */
+static rift_frozen_automaton_t *
+c_dfa(void)
+{
+    static const int edges[][2] = {{0, 1}};
+    static const char *const patterns[] = {"c"};
+    return freeze(build(RIFT_AUTOMATON_DFA, 2, 1u << 1, edges, patterns, 1));
+}
+
+/* Check whether a DFA accepts a whole string */
+static bool
+accepts(const rift_regex_automaton_t *dfa, const char *input)
+{
+    rift_dfa_table_t *table = rift_dfa_table_compile(dfa, NULL);
+    assert(table != NULL);
+    bool result = rift_dfa_table_matches(table, input, strlen(input));
+    rift_dfa_table_free(table);
+    return result;
+}
+
+/* Test inclusion and equivalence between DFAs built in different ways */
+void
+test_product_comparisons(void)
+{
+    rift_regex_error_t error = {0};
+    rift_frozen_automaton_t *nfa_form = ab_plus_nfa();
+    rift_frozen_automaton_t *dfa_form = ab_plus_dfa();
+    rift_frozen_automaton_t *wider = a_ab_plus_dfa();
+    rift_frozen_automaton_t *c = c_dfa();
+
+    assert(rift_automaton_is_equivalent(nfa_form, dfa_form, &error) == 1);
+    assert(rift_automaton_is_subset(nfa_form, dfa_form, &error) == 1);
+    assert(rift_automaton_is_subset(nfa_form, wider, &error) == 1);
+    assert(rift_automaton_is_subset(wider, nfa_form, &error) == 0);
+    assert(rift_automaton_is_equivalent(wider, nfa_form, &error) == 0);
+    assert(rift_automaton_is_subset(c, wider, &error) == 0);
+    assert(rift_automaton_is_equivalent(c, c, &error) == 1);
+
+    rift_frozen_automaton_free(nfa_form);
+    rift_frozen_automaton_free(dfa_form);
+    rift_frozen_automaton_free(wider);
+    rift_frozen_automaton_free(c);
+    printf("test_product_comparisons: PASSED\n");
+}
+
+/* Test the languages of products and complements */
+void
+test_product_languages(void)
+{
+    rift_regex_error_t error = {0};
+    rift_frozen_automaton_t *ab_plus = ab_plus_nfa();
+    rift_frozen_automaton_t *wider = a_ab_plus_dfa();
+    rift_frozen_automaton_t *c = c_dfa();
+
+    /* ab+ is included in a[ab]+, so their intersection is ab+ */
+    rift_regex_automaton_t *result = rift_automaton_intersection(ab_plus, wider, &error);
+    assert(result != NULL);
+    rift_frozen_automaton_t *frozen = freeze(result);
+    assert(rift_automaton_is_equivalent(frozen, ab_plus, &error) == 1);
+    rift_frozen_automaton_free(frozen);
+
+    result = rift_automaton_product(wider, ab_plus, RIFT_PRODUCT_DIFFERENCE, &error);
+    assert(result != NULL);
+    assert(accepts(result, "aa") && accepts(result, "aba") && accepts(result, "abbba"));
+    assert(!accepts(result, "ab") && !accepts(result, "abbb") && !accepts(result, "a"));
+    rift_automaton_free(result);
+
+    result = rift_automaton_product(ab_plus, c, RIFT_PRODUCT_UNION, &error);
+    assert(result != NULL);
+    assert(accepts(result, "c") && accepts(result, "abb"));
+    assert(!accepts(result, "") && !accepts(result, "cc") && !accepts(result, "abc"));
+    rift_automaton_free(result);
+
+    /* Disjoint languages have an empty intersection */
+    result = rift_automaton_intersection(ab_plus, c, &error);
+    assert(result != NULL);
+    assert(!accepts(result, "ab") && !accepts(result, "c") && !accepts(result, ""));
+    rift_automaton_free(result);
+
+    result = rift_automaton_complement(ab_plus, &error);
+    assert(result != NULL);
+    assert(accepts(result, "") && accepts(result, "a") && accepts(result, "ba"));
+    assert(accepts(result, "abc") && accepts(result, "xyz"));
+    assert(!accepts(result, "ab") && !accepts(result, "abbbb"));
+
+    /* The complement of the complement is the original language */
+    frozen = freeze(result);
+    result = rift_automaton_complement(frozen, &error);
+    assert(result != NULL);
+    rift_frozen_automaton_free(frozen);
+    frozen = freeze(result);
+    assert(rift_automaton_is_equivalent(frozen, ab_plus, &error) == 1);
+    rift_frozen_automaton_free(frozen);
+
+    rift_frozen_automaton_free(ab_plus);
+    rift_frozen_automaton_free(wider);
+    rift_frozen_automaton_free(c);
+    printf("test_product_languages: PASSED\n");
+}
+
+/* Test automata the walk cannot step through */
+void
+test_product_invalid(void)
+{
+    rift_regex_error_t error = {0};
+    rift_frozen_automaton_t *c = c_dfa();
+
+    /* A frozen NFA with an epsilon edge */
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *s0 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s1 = rift_automaton_create_state(nfa, true);
+    assert(rift_automaton_set_initial_state(nfa, s0));
+    assert(rift_automaton_create_epsilon_transition(nfa, s0, s1));
+    rift_frozen_automaton_t *frozen = rift_frozen_automaton_create(nfa, &error);
+    assert(frozen != NULL);
+
+    assert(rift_automaton_is_subset(frozen, c, &error) < 0);
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_AUTOMATON);
+    assert(rift_automaton_is_equivalent(c, NULL, &error) < 0);
+    assert(rift_automaton_intersection(NULL, c, &error) == NULL);
+    assert(rift_automaton_complement(frozen, &error) == NULL);
+    assert(rift_automaton_freeze_dfa(NULL, &error) == NULL);
+
+    /* Determinizing first makes it comparable: it accepts the empty string */
+    rift_frozen_automaton_t *dfa = rift_automaton_freeze_dfa(nfa, &error);
+    assert(dfa != NULL);
+    assert(rift_automaton_is_subset(dfa, c, &error) == 0);
+
+    rift_frozen_automaton_free(dfa);
+    rift_frozen_automaton_free(frozen);
+    rift_automaton_free(nfa);
+    rift_frozen_automaton_free(c);
+    printf("test_product_invalid: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running automaton product tests...\n");
+
+    test_product_comparisons();
+    test_product_languages();
+    test_product_invalid();
+
+    printf("All automaton product tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file sparse_set_test.c
+ * @brief Unit tests for sparse sets of NFA state indices
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+
+#include "core/automaton/sparse_set.h"
+
+/* Test insertion, membership and insertion order */
+void
+test_sparse_set_insert(void)
+{
+    rift_sparse_set_t set;
+    assert(rift_sparse_set_init(&set, 100));
+    assert(set.count == 0);
+
+    for (uint32_t v = 0; v < 100; v++) {
+        assert(!rift_sparse_set_contains(&set, v));
+    }
+    assert(rift_sparse_set_insert(&set, 42));
+    assert(rift_sparse_set_insert(&set, 7));
+    assert(rift_sparse_set_insert(&set, 99));
+    assert(!rift_sparse_set_insert(&set, 7));
+    assert(set.count == 3);
+    assert(set.dense[0] == 42 && set.dense[1] == 7 && set.dense[2] == 99);
+    assert(!rift_sparse_set_contains(&set, 0));
+    assert(rift_sparse_set_contains(&set, 42));
+
+    rift_sparse_set_destroy(&set);
+    assert(set.dense == NULL && set.sparse == NULL && set.capacity == 0);
+    printf("test_sparse_set_insert: PASSED\n");
+}
+
+/* Test that clearing empties the set whatever the stale entries hold */
+void
+test_sparse_set_clear(void)
+{
+    rift_sparse_set_t set;
+    assert(rift_sparse_set_init(&set, 16));
+
+    for (uint32_t round = 0; round < 4; round++) {
+        for (uint32_t v = round; v < 16; v += 3) {
+            assert(rift_sparse_set_insert(&set, v));
+        }
+        rift_sparse_set_clear(&set);
+        for (uint32_t v = 0; v < 16; v++) {
+            assert(!rift_sparse_set_contains(&set, v));
+        }
+    }
+
+    /* An empty capacity still initializes */
+    rift_sparse_set_destroy(&set);
+    assert(rift_sparse_set_init(&set, 0));
+    rift_sparse_set_destroy(&set);
+    printf("test_sparse_set_clear: PASSED\n");
+}
+
+int
+main(void)
+{
+    test_sparse_set_insert();
+    test_sparse_set_clear();
+
+    printf("\nAll sparse set tests passed!\n");
+    return 0;
+}
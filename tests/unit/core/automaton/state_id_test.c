@@ -0,0 +1,111 @@
+/**
+ * @file state_id_test.c
+ * @brief Unit tests for per-automaton state IDs of the LibRift regex engine
+ *
+ * This file contains test cases verifying that state IDs are the indices of
+ * the states in their automaton, stay dense when states are removed, and
+ * are assigned per automaton rather than from a shared counter.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/automaton/automaton.h"
+#include "core/automaton/minimizer.h"
+#include "core/automaton/state.h"
+
+/* Test that IDs are indices and lookups by ID are array accesses */
+void
+test_state_ids_dense(void)
+{
+    rift_regex_automaton_t *first = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_automaton_t *second = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *states[4];
+    for (size_t i = 0; i < 4; i++) {
+        states[i] = rift_automaton_create_state(first, i == 3);
+        assert(rift_state_get_id(states[i]) == i);
+        assert(rift_automaton_find_state_by_id(first, i) == states[i]);
+        assert(rift_automaton_get_state_index(first, states[i]) == i);
+    }
+    assert(rift_automaton_find_state_by_id(first, 4) == NULL);
+
+    /* Every automaton numbers its states from zero */
+    rift_regex_state_t *other = rift_automaton_create_state(second, true);
+    assert(rift_state_get_id(other) == 0);
+    assert(rift_automaton_get_state_index(first, other) == RIFT_STATE_NO_ID);
+    assert(!rift_automaton_set_initial_state(first, other));
+
+    /* Standalone states have no ID until an automaton takes them */
+    rift_regex_state_t *loose = rift_state_create(false);
+    assert(rift_state_get_id(loose) == RIFT_STATE_NO_ID);
+    assert(rift_automaton_get_state_index(first, loose) == RIFT_STATE_NO_ID);
+    rift_state_free(loose);
+
+    rift_automaton_free(first);
+    rift_automaton_free(second);
+    printf("test_state_ids_dense: PASSED\n");
+}
+
+/* Test that removing states renumbers the rest */
+void
+test_state_ids_after_pruning(void)
+{
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *s0 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *orphan = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s1 = rift_automaton_create_state(nfa, true);
+    assert(rift_automaton_add_transition(nfa, s0, s1, "a"));
+    assert(rift_automaton_add_transition(nfa, orphan, s1, "b"));
+    assert(rift_state_get_id(s1) == 2);
+
+    assert(rift_automaton_remove_unreachable_states(nfa));
+    assert(rift_automaton_get_state_count(nfa) == 2);
+    assert(rift_state_get_id(s0) == 0);
+    assert(rift_state_get_id(s1) == 1);
+    assert(rift_automaton_find_state_by_id(nfa, 1) == s1);
+
+    /* States added later continue the numbering */
+    rift_regex_state_t *s2 = rift_automaton_create_state(nfa, false);
+    assert(rift_state_get_id(s2) == 2);
+
+    rift_automaton_free(nfa);
+    printf("test_state_ids_after_pruning: PASSED\n");
+}
+
+/* Test that clones number their states like the original */
+void
+test_state_ids_clone(void)
+{
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *s0 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s1 = rift_automaton_create_state(nfa, true);
+    assert(rift_automaton_add_transition(nfa, s0, s1, "a"));
+
+    rift_regex_automaton_t *clone = rift_automaton_clone(nfa);
+    assert(clone != NULL);
+    for (size_t i = 0; i < rift_automaton_get_state_count(clone); i++) {
+        assert(rift_state_get_id(clone->states[i]) == i);
+    }
+
+    rift_automaton_free(clone);
+    rift_automaton_free(nfa);
+    printf("test_state_ids_clone: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running state ID tests...\n");
+
+    test_state_ids_dense();
+    test_state_ids_after_pruning();
+    test_state_ids_clone();
+
+    printf("All state ID tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,158 @@
+/**
+ * @file subset_table_test.c
+ * @brief Unit tests for the hash-indexed subset table of the LibRift regex engine
+ *
+ * This file contains test cases verifying subset insertion, lookup and growth,
+ * and subset construction on an NFA with many DFA states.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/automaton/automaton.h"
+#include "core/automaton/state.h"
+#include "core/automaton/subset_table.h"
+#include "core/config/config.h"
+
+/* Test insertion and lookup */
+void
+test_subset_table_insert(void)
+{
+    rift_subset_table_t *table = rift_subset_table_create(100);
+    assert(table != NULL);
+    assert(table->words == 2);
+
+    uint64_t a[2] = {0x5, 0x0};
+    uint64_t b[2] = {0x5, 0x1};
+    bool inserted = false;
+
+    assert(rift_subset_table_find(table, a) == RIFT_SUBSET_NOT_FOUND);
+    assert(rift_subset_table_insert(table, a, &inserted) == 0);
+    assert(inserted);
+    assert(rift_subset_table_insert(table, b, &inserted) == 1);
+    assert(inserted);
+    assert(rift_subset_table_insert(table, a, &inserted) == 0);
+    assert(!inserted);
+
+    assert(rift_subset_table_find(table, b) == 1);
+    assert(memcmp(rift_subset_table_get(table, 1), b, sizeof(b)) == 0);
+    assert(rift_subset_table_get(table, 2) == NULL);
+
+    rift_subset_table_free(table);
+    printf("test_subset_table_insert: PASSED\n");
+}
+
+/* Test that indices stay stable while the table grows */
+void
+test_subset_table_growth(void)
+{
+    rift_subset_table_t *table = rift_subset_table_create(4096);
+    assert(table != NULL);
+
+    uint64_t key[64];
+    for (uint32_t i = 0; i < 2000; i++) {
+        memset(key, 0, sizeof(key));
+        key[i % 64] = (uint64_t)1 << (i % 61);
+        key[63] |= (uint64_t)i << 1;
+        assert(rift_subset_table_insert(table, key, NULL) == i);
+    }
+    assert(table->count == 2000);
+
+    for (uint32_t i = 0; i < 2000; i++) {
+        memset(key, 0, sizeof(key));
+        key[i % 64] = (uint64_t)1 << (i % 61);
+        key[63] |= (uint64_t)i << 1;
+        assert(rift_subset_table_find(table, key) == i);
+    }
+
+    rift_subset_table_free(table);
+    printf("test_subset_table_growth: PASSED\n");
+}
+
+/* Build an NFA for (a|b)*a(a|b){7}, whose DFA has 2^8 states */
+static rift_regex_automaton_t *
+create_exponential_nfa(void)
+{
+    const int n = 7;
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *states[9];
+
+    for (int i = 0; i <= n + 1; i++) {
+        states[i] = rift_automaton_create_state(nfa, i == n + 1);
+        assert(states[i] != NULL);
+    }
+
+    assert(rift_automaton_add_transition(nfa, states[0], states[0], "[ab]"));
+    assert(rift_automaton_add_transition(nfa, states[0], states[1], "a"));
+    for (int i = 1; i <= n; i++) {
+        assert(rift_automaton_add_transition(nfa, states[i], states[i + 1], "[ab]"));
+    }
+
+    return nfa;
+}
+
+/* Test subset construction on an NFA with many DFA states */
+void
+test_subset_table_nfa_to_dfa(void)
+{
+    const int n = 7;
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa = create_exponential_nfa();
+
+    rift_regex_automaton_t *dfa = rift_automaton_nfa_to_dfa(nfa, &error);
+    assert(dfa != NULL);
+    assert(rift_automaton_get_state_count(dfa) == (size_t)1 << (n + 1));
+
+    rift_automaton_free(dfa);
+    rift_automaton_free(nfa);
+    printf("test_subset_table_nfa_to_dfa: PASSED\n");
+}
+
+/* Test that conversion stops cleanly at the DFA state budget */
+void
+test_subset_table_state_budget(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa = create_exponential_nfa();
+
+    assert(rift_automaton_nfa_to_dfa_limited(nfa, 100, &error) == NULL);
+    assert(error.code == RIFT_REGEX_ERROR_LIMIT_EXCEEDED);
+
+    rift_regex_automaton_t *dfa = rift_automaton_nfa_to_dfa_limited(nfa, 256, &error);
+    assert(dfa != NULL);
+    rift_automaton_free(dfa);
+
+    dfa = rift_automaton_nfa_to_dfa_limited(nfa, 0, &error);
+    assert(dfa != NULL);
+    rift_automaton_free(dfa);
+
+    /* The default budget comes from the configuration */
+    size_t max_states = 50;
+    assert(rift_config_set_regex_param(RIFT_REGEX_PARAM_MAX_STATES, &max_states) == RIFT_OK);
+    error.code = RIFT_REGEX_ERROR_NONE;
+    assert(rift_automaton_nfa_to_dfa(nfa, &error) == NULL);
+    assert(error.code == RIFT_REGEX_ERROR_LIMIT_EXCEEDED);
+    assert(rift_config_reset() == RIFT_OK);
+
+    rift_automaton_free(nfa);
+    printf("test_subset_table_state_budget: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running subset table tests...\n");
+
+    test_subset_table_insert();
+    test_subset_table_growth();
+    test_subset_table_nfa_to_dfa();
+    test_subset_table_state_budget();
+
+    printf("All subset table tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,291 @@
+/**
+ * @file tdfa_test.c
+ * @brief Unit tests for the tagged DFA of the LibRift regex engine
+ *
+ * This file contains test cases verifying capture extraction by the tagged
+ * DFA on patterns that are not one-pass, agreement with the Pike VM at every
+ * start position of a set of inputs, and the construction limits.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/automaton/automaton.h"
+#include "core/automaton/one_pass.h"
+#include "core/automaton/pike_vm.h"
+#include "core/automaton/state.h"
+#include "core/automaton/tdfa.h"
+
+/* Build an NFA for (a|ab)(c|bcd)(d*) */
+static rift_regex_automaton_t *
+create_alternation_nfa(void)
+{
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *s1 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *e1 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *m = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s2 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *e2 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *n1 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *n2 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s3 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *loop = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *e3 = rift_automaton_create_state(nfa, true);
+
+    assert(rift_state_set_group_start(s1, true) && rift_state_set_group_end(e1, true));
+    assert(rift_state_set_group_start(s2, true) && rift_state_set_group_end(e2, true));
+    assert(rift_state_set_group_start(s3, true) && rift_state_set_group_end(e3, true));
+
+    assert(rift_automaton_add_transition(nfa, s1, e1, "a"));
+    assert(rift_automaton_add_transition(nfa, s1, m, "a"));
+    assert(rift_automaton_add_transition(nfa, m, e1, "b"));
+    assert(rift_automaton_create_epsilon_transition(nfa, e1, s2));
+    assert(rift_automaton_add_transition(nfa, s2, e2, "c"));
+    assert(rift_automaton_add_transition(nfa, s2, n1, "b"));
+    assert(rift_automaton_add_transition(nfa, n1, n2, "c"));
+    assert(rift_automaton_add_transition(nfa, n2, e2, "d"));
+    assert(rift_automaton_create_epsilon_transition(nfa, e2, s3));
+    assert(rift_automaton_create_epsilon_transition(nfa, s3, loop));
+    assert(rift_automaton_add_transition(nfa, loop, loop, "d"));
+    assert(rift_automaton_create_epsilon_transition(nfa, loop, e3));
+
+    return nfa;
+}
+
+/* Build an NFA for (a*)(a*)b? with an accepting state before the b */
+static rift_regex_automaton_t *
+create_split_nfa(void)
+{
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *s1 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *l1 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *e1 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s2 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *l2 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *e2 = rift_automaton_create_state(nfa, true);
+    rift_regex_state_t *end = rift_automaton_create_state(nfa, true);
+
+    assert(rift_state_set_group_start(s1, true) && rift_state_set_group_end(e1, true));
+    assert(rift_state_set_group_start(s2, true) && rift_state_set_group_end(e2, true));
+
+    assert(rift_automaton_create_epsilon_transition(nfa, s1, l1));
+    assert(rift_automaton_add_transition(nfa, l1, l1, "a"));
+    assert(rift_automaton_create_epsilon_transition(nfa, l1, e1));
+    assert(rift_automaton_create_epsilon_transition(nfa, e1, s2));
+    assert(rift_automaton_create_epsilon_transition(nfa, s2, l2));
+    assert(rift_automaton_add_transition(nfa, l2, l2, "a"));
+    assert(rift_automaton_create_epsilon_transition(nfa, l2, e2));
+    assert(rift_automaton_add_transition(nfa, e2, end, "b"));
+
+    return nfa;
+}
+
+/* Build an NFA for ((a)|b)+, where the inner group keeps its last a */
+static rift_regex_automaton_t *
+create_repeat_nfa(void)
+{
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *outer = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *outer_end = rift_automaton_create_state(nfa, true);
+    rift_regex_state_t *inner = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *inner_end = rift_automaton_create_state(nfa, false);
+
+    assert(rift_state_set_group_start(outer, true) && rift_state_set_group_end(outer_end, true));
+    assert(rift_state_set_group_start(inner, true) && rift_state_set_group_end(inner_end, true));
+
+    assert(rift_automaton_create_epsilon_transition(nfa, outer, inner));
+    assert(rift_automaton_add_transition(nfa, outer, outer_end, "b"));
+    assert(rift_automaton_add_transition(nfa, inner, inner_end, "a"));
+    assert(rift_automaton_create_epsilon_transition(nfa, inner_end, outer_end));
+    assert(rift_automaton_create_epsilon_transition(nfa, outer_end, outer));
+
+    return nfa;
+}
+
+/* Build an NFA for ([ab]*)a[ab]{n}, whose DFA needs 2^n states */
+static rift_regex_automaton_t *
+create_exponential_nfa(int n)
+{
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *start = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *loop = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *prefix_end = rift_automaton_create_state(nfa, false);
+
+    assert(rift_state_set_group_start(start, true) && rift_state_set_group_end(prefix_end, true));
+    assert(rift_automaton_create_epsilon_transition(nfa, start, loop));
+    assert(rift_automaton_add_transition(nfa, loop, loop, "[ab]"));
+    assert(rift_automaton_create_epsilon_transition(nfa, loop, prefix_end));
+
+    rift_regex_state_t *previous = rift_automaton_create_state(nfa, n == 0);
+    assert(rift_automaton_add_transition(nfa, prefix_end, previous, "a"));
+    for (int i = 1; i <= n; i++) {
+        rift_regex_state_t *next = rift_automaton_create_state(nfa, i == n);
+        assert(rift_automaton_add_transition(nfa, previous, next, "[ab]"));
+        previous = next;
+    }
+    return nfa;
+}
+
+/* Compare the tagged DFA with the Pike VM at every start of every input */
+static void
+assert_agrees_with_pike_vm(rift_regex_automaton_t *nfa, const char *const *inputs, size_t count)
+{
+    rift_tdfa_t *tdfa = rift_tdfa_create(nfa, NULL);
+    rift_pike_vm_t *vm = rift_pike_vm_create(nfa, NULL);
+    assert(tdfa != NULL && vm != NULL);
+    assert(rift_tdfa_get_slot_count(tdfa) == rift_pike_vm_get_slot_count(vm));
+
+    size_t num_slots = rift_tdfa_get_slot_count(tdfa);
+    size_t *expected = malloc(num_slots * sizeof(size_t));
+    size_t *actual = malloc(num_slots * sizeof(size_t));
+    assert(expected != NULL && actual != NULL);
+    for (size_t i = 0; i < count; i++) {
+        size_t length = strlen(inputs[i]);
+        for (size_t start = 0; start <= length; start++) {
+            for (int earliest = 0; earliest < 2; earliest++) {
+                bool want = rift_pike_vm_search(vm, inputs[i], length, start, true, earliest,
+                                                expected);
+                bool got = rift_tdfa_search(tdfa, inputs[i], length, start, earliest, actual);
+                assert(want == got);
+                assert(!want || memcmp(expected, actual, num_slots * sizeof(size_t)) == 0);
+            }
+        }
+    }
+
+    free(expected);
+    free(actual);
+    rift_pike_vm_free(vm);
+    rift_tdfa_free(tdfa);
+}
+
+/* Test capture extraction on a pattern that is not one-pass */
+void
+test_tdfa_captures(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa = create_alternation_nfa();
+
+    /* The one-pass DFA refuses the pattern, the tagged DFA takes it */
+    assert(rift_one_pass_create(nfa, NULL) == NULL);
+    rift_tdfa_t *tdfa = rift_tdfa_create(nfa, &error);
+    assert(tdfa != NULL);
+    assert(rift_tdfa_get_group_count(tdfa) == 3);
+    assert(rift_tdfa_get_slot_count(tdfa) == 8);
+
+    /* The longest match is abcd; the Pike VM prefers a then bcd over ab then c */
+    size_t slots[8];
+    assert(rift_tdfa_search(tdfa, "abcd", 4, 0, false, slots));
+    assert(slots[0] == 0 && slots[1] == 4);
+    assert(slots[2] == 0 && slots[3] == 1 && slots[4] == 1 && slots[5] == 4);
+    assert(slots[6] == 4 && slots[7] == 4);
+
+    /* A second d goes to the third group after a and bcd */
+    assert(rift_tdfa_search(tdfa, "abcdd", 5, 0, false, slots));
+    assert(slots[1] == 5 && slots[3] == 1 && slots[6] == 4 && slots[7] == 5);
+
+    /* The search is anchored */
+    assert(!rift_tdfa_search(tdfa, "xac", 3, 0, false, slots));
+    assert(rift_tdfa_search(tdfa, "xac", 3, 1, false, slots));
+    assert(slots[0] == 1 && slots[1] == 3);
+
+    rift_tdfa_free(tdfa);
+    rift_automaton_free(nfa);
+    printf("test_tdfa_captures: PASSED\n");
+}
+
+/* Test that the matches and captures are those of the Pike VM */
+void
+test_tdfa_matches_pike_vm(void)
+{
+    static const char *const alternation_inputs[] = {"", "ac", "abc", "abcd", "abcdd", "abbcd",
+                                                     "abcddx", "aabc", "xabcd"};
+    rift_regex_automaton_t *nfa = create_alternation_nfa();
+    assert_agrees_with_pike_vm(nfa, alternation_inputs,
+                               sizeof(alternation_inputs) / sizeof(*alternation_inputs));
+    rift_automaton_free(nfa);
+
+    static const char *const split_inputs[] = {"", "a", "aaa", "ab", "aaab", "aaabb", "ba"};
+    nfa = create_split_nfa();
+    assert_agrees_with_pike_vm(nfa, split_inputs, sizeof(split_inputs) / sizeof(*split_inputs));
+    rift_automaton_free(nfa);
+
+    static const char *const repeat_inputs[] = {"a", "b", "ab", "ba", "abb", "abab", "bbab",
+                                                "aab", "abc", "cab"};
+    nfa = create_repeat_nfa();
+    assert_agrees_with_pike_vm(nfa, repeat_inputs,
+                               sizeof(repeat_inputs) / sizeof(*repeat_inputs));
+
+    /* The inner group keeps the last a while later iterations take b */
+    rift_tdfa_t *tdfa = rift_tdfa_create(nfa, NULL);
+    size_t slots[6];
+    assert(rift_tdfa_search(tdfa, "abab", 4, 0, false, slots));
+    assert(slots[1] == 4 && slots[2] == 3 && slots[3] == 4 && slots[4] == 2 && slots[5] == 3);
+    assert(rift_tdfa_search(tdfa, "b", 1, 0, false, slots));
+    assert(slots[4] == RIFT_TDFA_NO_POSITION && slots[5] == RIFT_TDFA_NO_POSITION);
+    rift_tdfa_free(tdfa);
+    rift_automaton_free(nfa);
+
+    static const char *const exponential_inputs[] = {"abab", "bbaab", "aaaa", "abba", "ba"};
+    nfa = create_exponential_nfa(2);
+    assert_agrees_with_pike_vm(nfa, exponential_inputs,
+                               sizeof(exponential_inputs) / sizeof(*exponential_inputs));
+    rift_automaton_free(nfa);
+
+    printf("test_tdfa_matches_pike_vm: PASSED\n");
+}
+
+/* Test that a DFA past the state limit is refused */
+void
+test_tdfa_limits(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa = create_exponential_nfa(12);
+
+    assert(rift_tdfa_create(nfa, &error) == NULL);
+    assert(error.code == RIFT_REGEX_ERROR_LIMIT_EXCEEDED);
+
+    rift_automaton_free(nfa);
+    printf("test_tdfa_limits: PASSED\n");
+}
+
+/* Test invalid arguments */
+void
+test_tdfa_invalid(void)
+{
+    rift_regex_error_t error = {0};
+    assert(rift_tdfa_create(NULL, &error) == NULL);
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_PARAMETER);
+
+    rift_regex_automaton_t *nfa = create_split_nfa();
+    rift_tdfa_t *tdfa = rift_tdfa_create(nfa, NULL);
+    assert(tdfa != NULL);
+    assert(!rift_tdfa_search(tdfa, "ab", 2, 3, false, NULL));
+    assert(!rift_tdfa_search(tdfa, NULL, 2, 0, false, NULL));
+    rift_tdfa_free(tdfa);
+    rift_automaton_free(nfa);
+
+    assert(!rift_tdfa_search(NULL, "a", 1, 0, false, NULL));
+    assert(rift_tdfa_get_group_count(NULL) == 0);
+    rift_tdfa_free(NULL);
+
+    printf("test_tdfa_invalid: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running tagged DFA tests...\n");
+
+    test_tdfa_captures();
+    test_tdfa_matches_pike_vm();
+    test_tdfa_limits();
+    test_tdfa_invalid();
+
+    printf("All tagged DFA tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,98 @@
+/**
+ * @file bridge_direct_test.c
+ * @brief Unit tests for the direct mode of the bridge API
+ *
+ * This file contains test cases verifying that the inline entry points find
+ * the same matches as the matcher they call, one at a time and in batches,
+ * and that they refuse invalid parameters.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/bytecode/bridge_direct.h"
+
+/* Test compiling, full matches and finding matches one at a time */
+void
+test_direct_find_next(void)
+{
+    rift_regex_error_t error = {RIFT_REGEX_ERROR_NONE};
+    rift_bridge_direct_pattern_t *pattern =
+        rift_bridge_direct_compile("a+b", RIFT_REGEX_FLAG_NONE, &error);
+    assert(pattern != NULL);
+    rift_bridge_direct_matcher_t *matcher = rift_bridge_direct_create_matcher(pattern, 0);
+    assert(matcher != NULL);
+
+    const char *input = "xaab ab";
+    assert(rift_bridge_direct_set_input(matcher, input, strlen(input)));
+    assert(!rift_bridge_direct_matches(matcher));
+
+    rift_bridge_direct_reset_matcher(matcher);
+    size_t start = 0;
+    size_t end = 0;
+    assert(rift_bridge_direct_find_next(matcher, &start, &end));
+    assert(start == 1 && end == 4);
+
+    rift_regex_span_t span;
+    size_t num_spans = 0;
+    assert(rift_bridge_direct_find_next_spans(matcher, &span, 1, &num_spans));
+    assert(num_spans >= 1 && span.start == 5 && span.end == 7);
+    assert(!rift_bridge_direct_find_next(matcher, NULL, NULL));
+
+    assert(rift_bridge_direct_set_input(matcher, "aab", 3));
+    assert(rift_bridge_direct_matches(matcher));
+
+    rift_bridge_direct_free_matcher(matcher);
+    rift_bridge_direct_free_pattern(pattern);
+    printf("test_direct_find_next: PASSED\n");
+}
+
+/* Test finding every match in one call */
+void
+test_direct_find_all(void)
+{
+    rift_regex_error_t error = {RIFT_REGEX_ERROR_NONE};
+    rift_bridge_direct_pattern_t *pattern =
+        rift_bridge_direct_compile("[0-9]+", RIFT_REGEX_FLAG_NONE, &error);
+    assert(pattern != NULL);
+    rift_bridge_direct_matcher_t *matcher = rift_bridge_direct_create_matcher(pattern, 0);
+    assert(matcher != NULL);
+
+    const char *input = "12 apples, 345 pears and 6 plums";
+    assert(rift_bridge_direct_set_input(matcher, input, strlen(input)));
+
+    rift_regex_span_t spans[8];
+    assert(rift_bridge_direct_find_all(matcher, spans, 8) == 3);
+    assert(spans[0].start == 0 && spans[0].end == 2);
+    assert(spans[1].start == 11 && spans[1].end == 14);
+    assert(spans[2].start == 25 && spans[2].end == 26);
+
+    // A short array stops the search once it is full
+    assert(rift_bridge_direct_find_all(matcher, spans, 2) == 2);
+    assert(spans[1].start == 11 && spans[1].end == 14);
+
+    assert(rift_bridge_direct_find_all(matcher, NULL, 8) == 0);
+    assert(rift_bridge_direct_find_all(matcher, spans, 0) == 0);
+    assert(rift_bridge_direct_find_all(NULL, spans, 8) == 0);
+
+    rift_bridge_direct_free_matcher(matcher);
+    rift_bridge_direct_free_pattern(pattern);
+    printf("test_direct_find_all: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running bridge direct mode tests...\n");
+
+    test_direct_find_next();
+    test_direct_find_all();
+
+    printf("All bridge direct mode tests PASSED!\n");
+    return 0;
+}
@@ -4,8 +4,13 @@
 #include <string.h>
 #include <assert.h>
 
+#include "core/automaton/automaton.h"
+#include "core/automaton/dfa_table.h"
+#include "core/automaton/state.h"
 #include "core/bytecode/bytecode.h"
 #include "core/bytecode/bytecode_compiler.h"
+#include "core/bytecode/bytecode_program.h"
+#include "core/bytecode/bytecode_vm.h"
 #include "core/errors/regex_error.h"
 
 void test_bytecode_compilation() {
@@ -40,7 +45,292 @@ void test_bytecode_compilation() {
     printf("Bytecode compilation test passed.\n");
 }
 
+void test_bytecode_serialization() {
+    rift_regex_error_t error;
+    rift_bytecode_program_t *program = rift_bytecode_program_create(8, 0);
+    assert(program != NULL);
+
+    int32_t match_char = rift_bytecode_program_add_instruction(program, RIFT_OP_MATCH_CHAR);
+    int32_t match_class = rift_bytecode_program_add_instruction(program, RIFT_OP_MATCH_CLASS);
+    int32_t repeat = rift_bytecode_program_add_instruction(program, RIFT_OP_REPEAT_START);
+    int32_t split = rift_bytecode_program_add_instruction(program, RIFT_OP_SPLIT);
+    rift_bytecode_program_add_instruction(program, RIFT_OP_ACCEPT);
+    assert(rift_bytecode_program_set_char_operand(program, match_char, 'x'));
+    program->instructions[match_class].operand.char_class.class_pattern = NULL;
+    assert(rift_bytecode_program_set_class_operand(program, match_class, "0123456789", 10));
+    assert(rift_bytecode_program_set_repeat_operand(program, repeat, 2, UINT32_MAX, true));
+    assert(rift_bytecode_program_set_jump_target(program, split, 1));
+    assert(rift_bytecode_program_set_pattern(program, "x[0-9]{2,}"));
+
+    size_t size = 0;
+    assert(rift_bytecode_serialize(program, NULL, &size));
+    uint8_t *data = malloc(size);
+    assert(data != NULL);
+    assert(rift_bytecode_serialize(program, data, &size));
+
+    // Instructions are packed into 8 bytes each
+    assert(sizeof(rift_bytecode_packed_t) == 8);
+
+    rift_bytecode_program_t *copy = rift_bytecode_deserialize(data, size, &error);
+    assert(copy != NULL);
+    assert(copy->instruction_count == program->instruction_count);
+    assert(copy->instructions[match_char].operand.character == 'x');
+    assert(copy->instructions[split].operand.jump_target == 1);
+    assert(copy->instructions[repeat].operand.repeat.min == 2);
+    assert(copy->instructions[repeat].operand.repeat.max == UINT32_MAX);
+    assert(copy->instructions[repeat].operand.repeat.greedy);
+    assert(strcmp(copy->original_pattern, "x[0-9]{2,}") == 0);
+
+    // Classes come back as bitmaps
+    uint32_t row = copy->instructions[match_class].operand.char_class.class_index;
+    const uint32_t *bitmap = copy->char_class_map + row * RIFT_BYTECODE_CLASS_WORDS;
+    assert(copy->char_class_count == 1);
+    assert(copy->instructions[match_class].operand.char_class.class_pattern == NULL);
+    assert(bitmap['5' >> 5] & (1u << ('5' & 31)));
+    assert(!(bitmap['a' >> 5] & (1u << ('a' & 31))));
+
+    // A class row outside the class table is rejected (the header is 13 words)
+    data[sizeof(uint32_t) * 13 + 8 * match_class + 4] = 7;
+    assert(rift_bytecode_deserialize(data, size, &error) == NULL);
+
+    free(data);
+    rift_bytecode_program_free(copy);
+    rift_bytecode_program_free(program);
+    printf("Bytecode serialization test passed.\n");
+}
+
+void test_bytecode_serialization_literals() {
+    rift_regex_error_t error;
+    rift_bytecode_program_t *program = rift_bytecode_program_create(8, 0);
+    assert(program != NULL);
+
+    const char *literal = "abc";
+    for (const char *c = literal; *c; c++) {
+        int32_t index = rift_bytecode_program_add_instruction(program, RIFT_OP_MATCH_CHAR);
+        assert(rift_bytecode_program_set_char_operand(program, index, *c));
+    }
+    rift_bytecode_program_add_instruction(program, RIFT_OP_ACCEPT);
+
+    // The optimizer moves the characters to the literal pool
+    assert(rift_bytecode_optimize(program, &error));
+    assert(program->instruction_count == 2);
+    assert(program->instructions[0].opcode == RIFT_OP_MATCH_STRING);
+
+    size_t size = 0;
+    assert(rift_bytecode_serialize(program, NULL, &size));
+    uint8_t *data = malloc(size);
+    assert(data != NULL);
+    assert(rift_bytecode_serialize(program, data, &size));
+
+    rift_bytecode_program_t *copy = rift_bytecode_deserialize(data, size, &error);
+    assert(copy != NULL);
+    assert(copy->instructions[0].opcode == RIFT_OP_MATCH_STRING);
+    assert(copy->instructions[0].operand.string.length == 3);
+    assert(copy->literal_pool_size == program->literal_pool_size);
+    assert(memcmp(copy->literal_pool + copy->instructions[0].operand.string.offset, "abc", 3) == 0);
+
+    free(data);
+    rift_bytecode_program_free(copy);
+    rift_bytecode_program_free(program);
+    printf("Bytecode literal serialization test passed.\n");
+}
+
+static uint32_t swap_word(uint32_t value) {
+    return ((value & 0xFF) << 24) | ((value & 0xFF00) << 8) | ((value & 0xFF0000) >> 8) |
+           ((value & 0xFF000000) >> 24);
+}
+
+static void swap_words(uint8_t *data, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        uint32_t word;
+        memcpy(&word, data + i * 4, 4);
+        word = swap_word(word);
+        memcpy(data + i * 4, &word, 4);
+    }
+}
+
+void test_bytecode_foreign_endianness() {
+    rift_regex_error_t error;
+    rift_bytecode_program_t *program = rift_bytecode_program_create(8, 0);
+    assert(program != NULL);
+
+    int32_t repeat = rift_bytecode_program_add_instruction(program, RIFT_OP_REPEAT_START);
+    program->instructions[repeat].operand.repeat.min = 2;
+    program->instructions[repeat].operand.repeat.max = 70000;
+    program->instructions[repeat].operand.repeat.greedy = true;
+    for (const char *c = "abc"; *c; c++) {
+        int32_t index = rift_bytecode_program_add_instruction(program, RIFT_OP_MATCH_CHAR);
+        assert(rift_bytecode_program_set_char_operand(program, index, *c));
+    }
+    rift_bytecode_program_add_instruction(program, RIFT_OP_ACCEPT);
+    assert(rift_bytecode_optimize(program, &error));
+
+    size_t size = 0;
+    assert(rift_bytecode_serialize(program, NULL, &size));
+    uint8_t *data = malloc(size);
+    assert(data != NULL);
+    assert(rift_bytecode_serialize(program, data, &size));
+    rift_bytecode_program_t *native = rift_bytecode_deserialize(data, size, &error);
+    assert(native != NULL);
+
+    // Rewrite the image as a machine of the other byte order would have written it
+    uint32_t header[13];
+    memcpy(header, data, sizeof(header));
+    uint32_t instructions = header[4];
+    size_t class_words = (size_t)header[7] * RIFT_BYTECODE_CLASS_WORDS;
+    size_t table_words = (size_t)header[8] * 3 + (size_t)header[9] * 2;
+    swap_words(data, 13);
+    size_t offset = sizeof(header);
+    for (uint32_t i = 0; i < instructions; i++, offset += sizeof(rift_bytecode_packed_t)) {
+        swap_words(data + offset + 4, 1);
+    }
+    swap_words(data + offset, class_words + table_words);
+
+    rift_bytecode_program_t *foreign = rift_bytecode_deserialize(data, size, &error);
+    assert(foreign != NULL);
+    assert(foreign->instruction_count == native->instruction_count);
+    for (uint32_t i = 0; i < native->instruction_count; i++) {
+        assert(foreign->instructions[i].opcode == native->instructions[i].opcode);
+    }
+    assert(foreign->instructions[0].operand.repeat.min == 2);
+    assert(foreign->instructions[0].operand.repeat.max == 70000);
+    assert(foreign->instructions[0].operand.repeat.greedy);
+    assert(foreign->literal_pool_size == native->literal_pool_size);
+    assert(memcmp(foreign->literal_pool, native->literal_pool, native->literal_pool_size) == 0);
+
+    free(data);
+    rift_bytecode_program_free(foreign);
+    rift_bytecode_program_free(native);
+    rift_bytecode_program_free(program);
+    printf("Bytecode foreign endianness test passed.\n");
+}
+
+void test_bytecode_dfa_scan() {
+    rift_regex_error_t error;
+    rift_regex_automaton_t *dfa = rift_automaton_create(RIFT_AUTOMATON_DFA);
+    assert(dfa != NULL);
+
+    // ab+
+    rift_regex_state_t *s0 = rift_automaton_create_state(dfa, false);
+    rift_regex_state_t *s1 = rift_automaton_create_state(dfa, false);
+    rift_regex_state_t *s2 = rift_automaton_create_state(dfa, true);
+    assert(rift_automaton_set_initial_state(dfa, s0));
+    assert(rift_automaton_add_transition(dfa, s0, s1, "a"));
+    assert(rift_automaton_add_transition(dfa, s1, s2, "b"));
+    assert(rift_automaton_add_transition(dfa, s2, s2, "b"));
+
+    // The whole DFA becomes one table scan
+    rift_bytecode_program_t *program = rift_bytecode_from_automaton(dfa, 0, &error);
+    assert(program != NULL);
+    assert(program->instruction_count == 2);
+    assert(program->instructions[0].opcode == RIFT_OP_DFA_SCAN);
+    assert(program->instructions[0].operand.dfa_index == 0);
+    assert(program->instructions[1].opcode == RIFT_OP_ACCEPT);
+    assert(program->dfa_table_count == 1);
+
+    size_t size = 0;
+    assert(rift_bytecode_serialize(program, NULL, &size));
+    uint8_t *data = malloc(size);
+    assert(data != NULL);
+    assert(rift_bytecode_serialize(program, data, &size));
+
+    rift_bytecode_program_t *copy = rift_bytecode_deserialize(data, size, &error);
+    assert(copy != NULL);
+    assert(copy->dfa_table_count == 1);
+    assert(copy->instructions[0].opcode == RIFT_OP_DFA_SCAN);
+    assert(copy->dfa_tables[0]->num_states == program->dfa_tables[0]->num_states);
+
+    size_t end = 0;
+    assert(rift_dfa_table_longest_prefix(copy->dfa_tables[0], "abbc", 4, &end) && end == 3);
+
+    // A scan of a table the program does not have is rejected
+    assert(rift_bytecode_deserialize(data, size - 8, &error) == NULL);
+    data[sizeof(uint32_t) * 13 + 4] = 1;
+    assert(rift_bytecode_deserialize(data, size, &error) == NULL);
+
+    free(data);
+    rift_bytecode_program_free(copy);
+    rift_bytecode_program_free(program);
+    rift_automaton_free(dfa);
+    printf("Bytecode DFA scan test passed.\n");
+}
+
+void test_bytecode_atomic_region() {
+    rift_regex_error_t error;
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    assert(nfa != NULL);
+
+    // (?>a*)a, with the loop edge before the exit edge as a greedy star compiles it
+    rift_regex_state_t *enter = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *loop = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *leave = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *accept = rift_automaton_create_state(nfa, true);
+    assert(rift_automaton_set_initial_state(nfa, enter));
+    assert(rift_automaton_set_state_flag(enter, RIFT_STATE_FLAG_ATOMIC_START));
+    assert(rift_automaton_set_state_flag(leave, RIFT_STATE_FLAG_ATOMIC_END));
+    assert(rift_automaton_create_epsilon_transition(nfa, enter, loop));
+    assert(rift_automaton_add_transition(nfa, loop, loop, "a"));
+    assert(rift_automaton_create_epsilon_transition(nfa, loop, leave));
+    assert(rift_automaton_add_transition(nfa, leave, accept, "a"));
+
+    rift_bytecode_program_t *program = rift_bytecode_from_automaton(nfa, 0, &error);
+    assert(program != NULL);
+    assert(program->instructions[0].opcode == RIFT_OP_ATOMIC_START);
+
+    bool found_cut = false;
+    for (uint32_t i = 0; i < program->instruction_count; i++) {
+        found_cut = found_cut || program->instructions[i].opcode == RIFT_OP_CUT;
+    }
+    assert(found_cut);
+
+    // The group keeps every 'a', so nothing is left for the last one
+    rift_bytecode_vm_t *vm = rift_bytecode_vm_create(program, "aaa", (size_t)-1);
+    assert(vm != NULL);
+    assert(!rift_bytecode_execute(program, vm, NULL));
+    rift_bytecode_vm_free(vm);
+
+    rift_bytecode_program_free(program);
+    rift_automaton_free(nfa);
+    printf("Bytecode atomic region test passed.\n");
+}
+
+void test_bytecode_compile_timed() {
+    rift_regex_error_t error;
+    rift_bytecode_compile_timings_t timings = {0, 0, 0};
+
+    rift_bytecode_program_t *program = rift_bytecode_compile_timed("a(b+)c", 0, &timings, &error);
+    assert(program != NULL);
+    rift_bytecode_program_t *plain = rift_bytecode_compile("a(b+)c", 0, &error);
+    assert(plain != NULL);
+    assert(program->instruction_count == plain->instruction_count);
+    assert(program->group_count == plain->group_count);
+    assert(timings.pattern_ns > 0 && timings.codegen_ns > 0);
+
+    // Times add up, so one structure can cover many patterns
+    rift_bytecode_compile_timings_t first = timings;
+    rift_bytecode_program_t *second = rift_bytecode_compile_timed("x{2,5}", 0, &timings, &error);
+    assert(second != NULL);
+    assert(timings.pattern_ns > first.pattern_ns && timings.codegen_ns > first.codegen_ns);
+    assert(timings.counters_ns >= first.counters_ns);
+
+    // A failed pattern still reports the stage it reached
+    first = timings;
+    assert(rift_bytecode_compile_timed("a(b", 0, &timings, &error) == NULL);
+    assert(timings.pattern_ns > first.pattern_ns);
+
+    rift_bytecode_program_free(second);
+    rift_bytecode_program_free(plain);
+    rift_bytecode_program_free(program);
+    printf("Bytecode compile timings test passed.\n");
+}
+
 int main() {
     test_bytecode_compilation();
+    test_bytecode_serialization();
+    test_bytecode_serialization_literals();
+    test_bytecode_foreign_endianness();
+    test_bytecode_dfa_scan();
+    test_bytecode_atomic_region();
+    test_bytecode_compile_timed();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,368 @@
+/**
+ * @file bytecode_container_test.c
+ * @brief Unit tests for the bytecode container of LibRift
+ *
+ * This file contains test cases verifying that programs written to a
+ * container load back in place, from memory and from a mapped file, and
+ * that damaged containers are rejected. DFA tables are checked to be used in
+ * place like the other tables, and shared-memory segments to be readable
+ * from forked workers but not writable.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "core/automaton/dfa_table.h"
+#include "core/bytecode/bytecode_container.h"
+#include "core/bytecode/bytecode_program.h"
+#include "core/bytecode/bytecode_vm.h"
+
+/* Build "ab" followed by [0-9] */
+static rift_bytecode_program_t *
+create_class_program(void)
+{
+    rift_bytecode_program_t *program = rift_bytecode_program_create(4, 0);
+    assert(program != NULL);
+
+    int32_t index = rift_bytecode_program_add_instruction(program, RIFT_OP_MATCH_CHAR);
+    assert(rift_bytecode_program_set_char_operand(program, index, 'a'));
+    index = rift_bytecode_program_add_instruction(program, RIFT_OP_MATCH_CHAR);
+    assert(rift_bytecode_program_set_char_operand(program, index, 'b'));
+    index = rift_bytecode_program_add_instruction(program, RIFT_OP_MATCH_CLASS);
+    assert(rift_bytecode_program_set_class_operand(program, index, "0123456789", 10));
+    rift_bytecode_program_add_instruction(program, RIFT_OP_ACCEPT);
+    assert(rift_bytecode_program_set_pattern(program, "ab[0-9]"));
+    return program;
+}
+
+/* Build a three-byte literal as one MATCH_STRING */
+static rift_bytecode_program_t *
+create_literal_program(const char *literal)
+{
+    rift_bytecode_program_t *program = rift_bytecode_program_create(4, 0);
+    assert(program != NULL);
+
+    for (const char *c = literal; *c; c++) {
+        int32_t index = rift_bytecode_program_add_instruction(program, RIFT_OP_MATCH_CHAR);
+        assert(rift_bytecode_program_set_char_operand(program, index, *c));
+    }
+    rift_bytecode_program_add_instruction(program, RIFT_OP_ACCEPT);
+    assert(rift_bytecode_optimize(program, NULL));
+    assert(program->instructions[0].opcode == RIFT_OP_MATCH_STRING);
+    return program;
+}
+
+/* Build a DFA_SCAN over a table for ab* */
+static rift_bytecode_program_t *
+create_dfa_program(void)
+{
+    uint32_t next[3 * 3] = {0, 0, 0, 0, 2, 0, 0, 0, 2};
+    uint64_t accept = (uint64_t)1 << 2;
+    rift_dfa_table_t table;
+    memset(&table, 0, sizeof(table));
+    table.byte_class['a'] = 1;
+    table.byte_class['b'] = 2;
+    table.num_states = 3;
+    table.start_state = 1;
+    table.num_classes = 3;
+    table.next = next;
+    table.accept_bitmap = &accept;
+
+    rift_bytecode_program_t *program = rift_bytecode_program_create(2, 0);
+    assert(program != NULL);
+    rift_dfa_table_t *copy = rift_dfa_table_clone(&table);
+    assert(copy != NULL);
+    assert(rift_bytecode_program_add_dfa_table(program, copy) == 0);
+
+    int32_t index = rift_bytecode_program_add_instruction(program, RIFT_OP_DFA_SCAN);
+    program->instructions[index].operand.dfa_index = 0;
+    rift_bytecode_program_add_instruction(program, RIFT_OP_ACCEPT);
+    return program;
+}
+
+/* Write programs into a buffer obtained with malloc, which is suitably aligned */
+static uint8_t *
+write_container(rift_bytecode_program_t *const *programs, uint32_t count, size_t *size)
+{
+    assert(rift_bytecode_container_write(programs, count, NULL, size));
+    uint8_t *data = malloc(*size);
+    assert(data != NULL);
+    assert(rift_bytecode_container_write(programs, count, data, size));
+    return data;
+}
+
+/* Run a program on a string */
+static bool
+program_matches(rift_bytecode_program_t *program, const char *input)
+{
+    rift_bytecode_vm_t *vm = rift_bytecode_vm_create(program, input, strlen(input));
+    assert(vm != NULL);
+    bool matched = rift_bytecode_execute(program, vm, NULL);
+    rift_bytecode_vm_free(vm);
+    return matched;
+}
+
+/* Test a round trip through memory */
+void
+test_bytecode_container_load(void)
+{
+    rift_regex_error_t error = {0};
+    rift_bytecode_program_t *programs[2] = {create_class_program(), create_literal_program("xyz")};
+
+    size_t size = 0;
+    uint8_t *data = write_container(programs, 2, &size);
+    assert(size % RIFT_BYTECODE_CONTAINER_ALIGNMENT == 0);
+
+    rift_bytecode_container_t *container = rift_bytecode_container_load(data, size, &error);
+    assert(container != NULL);
+    assert(rift_bytecode_container_count(container) == 2);
+
+    // Tables are used where they lie in the container
+    rift_bytecode_program_t *classes = rift_bytecode_container_program(container, 0, &error);
+    assert(classes != NULL);
+    assert(classes->instruction_count == 4);
+    assert(classes->instructions[2].opcode == RIFT_OP_MATCH_CLASS);
+    assert((const uint8_t *)classes->char_class_map > data &&
+           (const uint8_t *)classes->char_class_map < data + size);
+    assert(strcmp(classes->original_pattern, "ab[0-9]") == 0);
+    assert(rift_bytecode_container_program(container, 0, &error) == classes);
+    assert(program_matches(classes, "ab7"));
+    assert(!program_matches(classes, "abc"));
+
+    rift_bytecode_program_t *literal = rift_bytecode_container_program(container, 1, &error);
+    assert(literal != NULL);
+    assert(literal->original_pattern == NULL);
+    assert(literal->instructions[0].operand.string.length == 3);
+    assert(program_matches(literal, "xyz"));
+    assert(!program_matches(literal, "xyy"));
+
+    assert(rift_bytecode_container_program(container, 2, &error) == NULL);
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_PARAMETER);
+
+    rift_bytecode_container_close(container);
+    free(data);
+    rift_bytecode_program_free(programs[0]);
+    rift_bytecode_program_free(programs[1]);
+    printf("test_bytecode_container_load: PASSED\n");
+}
+
+/* Test loading through a file mapping */
+void
+test_bytecode_container_open(void)
+{
+    rift_regex_error_t error = {0};
+    rift_bytecode_program_t *program = create_class_program();
+
+    size_t size = 0;
+    uint8_t *data = write_container(&program, 1, &size);
+
+    char path[] = "/tmp/rift_container_XXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    assert(write(fd, data, size) == (ssize_t)size);
+    close(fd);
+
+    rift_bytecode_container_t *container = rift_bytecode_container_open(path, &error);
+    assert(container != NULL);
+    rift_bytecode_program_t *mapped = rift_bytecode_container_program(container, 0, &error);
+    assert(mapped != NULL);
+    assert(program_matches(mapped, "ab0"));
+    rift_bytecode_container_close(container);
+
+    unlink(path);
+    assert(rift_bytecode_container_open(path, &error) == NULL);
+
+    free(data);
+    rift_bytecode_program_free(program);
+    printf("test_bytecode_container_open: PASSED\n");
+}
+
+/* Test that DFA tables are viewed in the container */
+void
+test_bytecode_container_dfa(void)
+{
+    rift_regex_error_t error = {0};
+    rift_bytecode_program_t *programs[2] = {create_class_program(), create_dfa_program()};
+
+    size_t size = 0;
+    uint8_t *data = write_container(programs, 2, &size);
+    rift_bytecode_container_t *container = rift_bytecode_container_load(data, size, &error);
+    assert(container != NULL);
+
+    rift_bytecode_program_t *dfa = rift_bytecode_container_program(container, 1, &error);
+    assert(dfa != NULL);
+    assert(dfa->dfa_table_count == 1);
+    assert(dfa->instructions[0].opcode == RIFT_OP_DFA_SCAN);
+    assert((const uint8_t *)dfa->dfa_tables[0]->next > data &&
+           (const uint8_t *)dfa->dfa_tables[0]->next < data + size);
+    assert(program_matches(dfa, "abbb"));
+    assert(!program_matches(dfa, "ba"));
+
+    // The program before it has no tables
+    rift_bytecode_program_t *classes = rift_bytecode_container_program(container, 0, &error);
+    assert(classes != NULL && classes->dfa_table_count == 0);
+
+    rift_bytecode_container_close(container);
+    free(data);
+    rift_bytecode_program_free(programs[0]);
+    rift_bytecode_program_free(programs[1]);
+    printf("test_bytecode_container_dfa: PASSED\n");
+}
+
+/* Test that equal ranges are written once and equal programs unpacked once */
+void
+test_bytecode_container_shared(void)
+{
+    rift_regex_error_t error = {0};
+    rift_bytecode_program_t *programs[4] = {create_class_program(), create_literal_program("xyz"),
+                                            create_class_program(),
+                                            create_literal_program("uvw")};
+
+    size_t size = 0;
+    uint8_t *data = write_container(programs, 4, &size);
+    const rift_bytecode_section_t *sections =
+        (const rift_bytecode_section_t *)(data + sizeof(rift_bytecode_container_header_t));
+    assert(sections[1].size == (4 + 2) * sizeof(rift_bytecode_packed_t));
+
+    // The literal programs differ in their pools only
+    const rift_bytecode_container_entry_t *entries =
+        (const rift_bytecode_container_entry_t *)(data + sections[0].offset);
+    assert(memcmp(&entries[0], &entries[2], sizeof(entries[0])) == 0);
+    assert(entries[1].instruction_first == entries[3].instruction_first);
+    assert(entries[1].operand_first == entries[3].operand_first);
+    assert(entries[1].literal_offset != entries[3].literal_offset);
+
+    rift_bytecode_container_t *container = rift_bytecode_container_load(data, size, &error);
+    assert(container != NULL);
+    rift_bytecode_program_t *first = rift_bytecode_container_program(container, 0, &error);
+    assert(first != NULL);
+    assert(rift_bytecode_container_program(container, 2, &error) == first);
+    rift_bytecode_program_t *xyz = rift_bytecode_container_program(container, 1, &error);
+    rift_bytecode_program_t *uvw = rift_bytecode_container_program(container, 3, &error);
+    assert(xyz != NULL && uvw != NULL && xyz != uvw);
+    assert(program_matches(first, "ab5"));
+    assert(program_matches(xyz, "xyz") && !program_matches(xyz, "uvw"));
+    assert(program_matches(uvw, "uvw") && !program_matches(uvw, "xyz"));
+
+    rift_bytecode_container_close(container);
+    free(data);
+    for (size_t p = 0; p < 4; p++) {
+        rift_bytecode_program_free(programs[p]);
+    }
+    printf("test_bytecode_container_shared: PASSED\n");
+}
+
+/* Test containers shared with forked workers through shared memory */
+void
+test_bytecode_container_segment(void)
+{
+    rift_regex_error_t error = {0};
+    rift_bytecode_program_t *programs[2] = {create_class_program(), create_dfa_program()};
+
+    int fd = rift_bytecode_container_share(programs, 2, NULL, &error);
+    assert(fd >= 0);
+
+    // The segment cannot be written once shared
+    void *writable = mmap(NULL, RIFT_BYTECODE_CONTAINER_ALIGNMENT, PROT_READ | PROT_WRITE,
+                          MAP_SHARED, fd, 0);
+    assert(writable == MAP_FAILED);
+
+    // A worker attaches the inherited descriptor and runs the programs from it
+    pid_t worker = fork();
+    assert(worker >= 0);
+    if (worker == 0) {
+        rift_bytecode_container_t *container = rift_bytecode_container_attach(fd, NULL);
+        close(fd);
+        bool ok = container != NULL && rift_bytecode_container_count(container) == 2;
+        rift_bytecode_program_t *dfa = ok ? rift_bytecode_container_program(container, 1, NULL)
+                                          : NULL;
+        ok = dfa != NULL && program_matches(dfa, "abb") && !program_matches(dfa, "ba");
+        rift_bytecode_container_close(container);
+        _exit(ok ? 0 : 1);
+    }
+    int status = 0;
+    assert(waitpid(worker, &status, 0) == worker);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    close(fd);
+
+    // A named segment is reached by its name until it is unshared
+    char name[64];
+    snprintf(name, sizeof(name), "/rift_container_test_%ld", (long)getpid());
+    fd = rift_bytecode_container_share(programs, 2, name, &error);
+    assert(fd >= 0);
+    close(fd);
+    assert(rift_bytecode_container_share(programs, 2, name, &error) < 0);
+
+    rift_bytecode_container_t *container = rift_bytecode_container_attach_name(name, &error);
+    assert(container != NULL);
+    assert(rift_bytecode_container_unshare(name));
+    rift_bytecode_program_t *classes = rift_bytecode_container_program(container, 0, &error);
+    assert(classes != NULL && program_matches(classes, "ab3"));
+    rift_bytecode_container_close(container);
+
+    assert(rift_bytecode_container_attach_name(name, &error) == NULL);
+    assert(!rift_bytecode_container_unshare(name));
+    assert(rift_bytecode_container_attach(-1, &error) == NULL);
+
+    rift_bytecode_program_free(programs[0]);
+    rift_bytecode_program_free(programs[1]);
+    printf("test_bytecode_container_segment: PASSED\n");
+}
+
+/* Test that damaged containers are rejected */
+void
+test_bytecode_container_invalid(void)
+{
+    rift_regex_error_t error = {0};
+    rift_bytecode_program_t *program = create_class_program();
+
+    size_t size = 0;
+    uint8_t *data = write_container(&program, 1, &size);
+
+    // Any flipped byte after the header fails the checksum
+    data[size - 1] ^= 1;
+    assert(rift_bytecode_container_load(data, size, &error) == NULL);
+    data[size - 1] ^= 1;
+
+    assert(rift_bytecode_container_load(data, size - 8, &error) == NULL);
+
+    rift_bytecode_container_header_t *header = (rift_bytecode_container_header_t *)data;
+    header->version++;
+    assert(rift_bytecode_container_load(data, size, &error) == NULL);
+    assert(error.code == RIFT_REGEX_ERROR_CONVERSION_FAILED);
+    header->version--;
+
+    header->magic = 0;
+    assert(rift_bytecode_container_load(data, size, &error) == NULL);
+    assert(rift_bytecode_container_load(NULL, size, &error) == NULL);
+    assert(rift_bytecode_container_count(NULL) == 0);
+    rift_bytecode_container_close(NULL);
+
+    free(data);
+    rift_bytecode_program_free(program);
+    printf("test_bytecode_container_invalid: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running bytecode container tests...\n");
+
+    test_bytecode_container_load();
+    test_bytecode_container_open();
+    test_bytecode_container_dfa();
+    test_bytecode_container_shared();
+    test_bytecode_container_segment();
+    test_bytecode_container_invalid();
+
+    printf("All bytecode container tests PASSED!\n");
+    return 0;
+}
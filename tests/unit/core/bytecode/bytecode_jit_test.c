@@ -0,0 +1,229 @@
+/**
+ * @file bytecode_jit_test.c
+ * @brief Unit tests for native code compilation of LibRift bytecode
+ *
+ * This file contains test cases checking that native code matches exactly
+ * what the interpreter matches, captures included, and that unsupported
+ * programs fall back to the interpreter.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/bytecode/bytecode_jit.h"
+#include "core/bytecode/bytecode_vm.h"
+
+/* Build a program from an instruction array */
+static rift_bytecode_program_t *
+create_program(const rift_bytecode_instruction_t *instructions, uint32_t count,
+               uint32_t group_count)
+{
+    rift_bytecode_program_t *program = (rift_bytecode_program_t *)calloc(1, sizeof(*program));
+    assert(program != NULL);
+    program->instructions =
+        (rift_bytecode_instruction_t *)malloc(count * sizeof(rift_bytecode_instruction_t));
+    assert(program->instructions != NULL);
+    memcpy(program->instructions, instructions, count * sizeof(rift_bytecode_instruction_t));
+    program->instruction_count = count;
+    program->capacity = count;
+    program->group_count = group_count;
+    return program;
+}
+
+static void
+free_program(rift_bytecode_program_t *program)
+{
+    free(program->instructions);
+    free(program);
+}
+
+/* Run input through the interpreter and the native code and compare the results */
+static bool
+check_same(rift_bytecode_program_t *program, const rift_bytecode_jit_t *jit, const char *input)
+{
+    rift_bytecode_vm_t *interpreted = rift_bytecode_vm_create(program, input, (size_t)-1);
+    rift_bytecode_vm_t *native = rift_bytecode_vm_create(program, input, (size_t)-1);
+    assert(interpreted != NULL && native != NULL);
+
+    rift_regex_match_t expected;
+    rift_regex_match_t actual;
+    bool matched = rift_bytecode_execute(program, interpreted, &expected);
+    assert(rift_bytecode_jit_execute(jit, program, native, &actual) == matched);
+
+    if (matched) {
+        assert(actual.start_pos == expected.start_pos && actual.end_pos == expected.end_pos);
+        for (uint32_t group = 0; group < interpreted->capture_count; group++) {
+            uint32_t start[2] = {0, 0};
+            uint32_t end[2] = {0, 0};
+            bool set = rift_bytecode_vm_get_group(interpreted, group, &start[0], &end[0]);
+            assert(rift_bytecode_vm_get_group(native, group, &start[1], &end[1]) == set);
+            assert(start[0] == start[1] && end[0] == end[1]);
+        }
+    }
+
+    rift_bytecode_vm_free(interpreted);
+    rift_bytecode_vm_free(native);
+    return matched;
+}
+
+/* Test a(b|bc)*(d) with captures, backtracking out of the loop */
+void
+test_bytecode_jit_backtracking(void)
+{
+    rift_bytecode_instruction_t code[14];
+    memset(code, 0, sizeof(code));
+    code[0].opcode = RIFT_OP_MATCH_CHAR;
+    code[0].operand.character = 'a';
+    code[1].opcode = RIFT_OP_SPLIT;
+    code[1].operand.jump_target = 10;
+    code[2].opcode = RIFT_OP_SAVE_START;
+    code[2].operand.group_index = 1;
+    code[3].opcode = RIFT_OP_SPLIT;
+    code[3].operand.jump_target = 6;
+    code[4].opcode = RIFT_OP_MATCH_CHAR;
+    code[4].operand.character = 'b';
+    code[5].opcode = RIFT_OP_JUMP;
+    code[5].operand.jump_target = 8;
+    code[6].opcode = RIFT_OP_MATCH_STRING;
+    code[6].operand.string.offset = 0;
+    code[6].operand.string.length = 2;
+    code[7].opcode = RIFT_OP_NOP;
+    code[8].opcode = RIFT_OP_SAVE_END;
+    code[8].operand.group_index = 1;
+    code[9].opcode = RIFT_OP_JUMP;
+    code[9].operand.jump_target = 1;
+    code[10].opcode = RIFT_OP_SAVE_START;
+    code[10].operand.group_index = 2;
+    code[11].opcode = RIFT_OP_MATCH_ANY;
+    code[12].opcode = RIFT_OP_SAVE_END;
+    code[12].operand.group_index = 2;
+    code[13].opcode = RIFT_OP_ACCEPT;
+
+    rift_bytecode_program_t *program = create_program(code, 14, 2);
+    program->literal_pool = (char *)"bc";
+    program->literal_pool_size = 2;
+
+    rift_regex_error_t error;
+    rift_bytecode_jit_t *jit = rift_bytecode_jit_compile(program, &error);
+    assert(jit != NULL || !rift_bytecode_jit_available());
+
+    const char *inputs[] = {"abd", "abcbd", "abcbbc", "abbb", "a", "", "xbd", "abcbcbcq"};
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+        check_same(program, jit, inputs[i]);
+    }
+    assert(check_same(program, jit, "abcbd"));
+    assert(!check_same(program, jit, "a"));
+
+    rift_bytecode_jit_free(jit);
+    free_program(program);
+    printf("test_bytecode_jit_backtracking: PASSED\n");
+}
+
+/* Test [a-z]*z through STAR_CLASS and the class table */
+void
+test_bytecode_jit_classes(void)
+{
+    uint32_t map[RIFT_BYTECODE_CLASS_WORDS];
+    memset(map, 0, sizeof(map));
+    for (unsigned char c = 'a'; c <= 'z'; c++) {
+        map[c >> 5] |= (uint32_t)1 << (c & 31);
+    }
+
+    rift_bytecode_instruction_t code[4];
+    memset(code, 0, sizeof(code));
+    code[0].opcode = RIFT_OP_STAR_CLASS;
+    code[1].opcode = RIFT_OP_MATCH_CLASS;
+    code[2].opcode = RIFT_OP_MATCH_CHAR;
+    code[2].operand.character = 'z';
+    code[3].opcode = RIFT_OP_ACCEPT;
+
+    rift_bytecode_program_t *program = create_program(code, 4, 0);
+    program->char_class_map = map;
+    program->char_class_count = 1;
+
+    rift_regex_error_t error;
+    rift_bytecode_jit_t *jit = rift_bytecode_jit_compile(program, &error);
+    assert(jit != NULL || !rift_bytecode_jit_available());
+
+    assert(check_same(program, jit, "abzcz!"));
+    assert(check_same(program, jit, "az"));
+    assert(!check_same(program, jit, "z"));
+    assert(!check_same(program, jit, "abc"));
+    assert(!check_same(program, jit, "1z"));
+
+    rift_bytecode_jit_free(jit);
+    free_program(program);
+    printf("test_bytecode_jit_classes: PASSED\n");
+}
+
+/* Test deep backtracking, the budget, and falling back for unsupported opcodes */
+void
+test_bytecode_jit_limits(void)
+{
+    /* (a|a)*b: 0 SPLIT 6, 1 SPLIT 4, 2 'a', 3 JUMP 5, 4 'a', 5 JUMP 0, 6 'b', 7 ACCEPT */
+    rift_bytecode_instruction_t code[8];
+    memset(code, 0, sizeof(code));
+    code[0].opcode = RIFT_OP_SPLIT;
+    code[0].operand.jump_target = 6;
+    code[1].opcode = RIFT_OP_SPLIT;
+    code[1].operand.jump_target = 4;
+    code[2].opcode = RIFT_OP_MATCH_CHAR;
+    code[2].operand.character = 'a';
+    code[3].opcode = RIFT_OP_JUMP;
+    code[3].operand.jump_target = 5;
+    code[4].opcode = RIFT_OP_MATCH_CHAR;
+    code[4].operand.character = 'a';
+    code[5].opcode = RIFT_OP_JUMP;
+    code[5].operand.jump_target = 0;
+    code[6].opcode = RIFT_OP_MATCH_CHAR;
+    code[6].operand.character = 'b';
+    code[7].opcode = RIFT_OP_ACCEPT;
+
+    rift_bytecode_program_t *program = create_program(code, 8, 0);
+    rift_regex_error_t error;
+    rift_bytecode_jit_t *jit = rift_bytecode_jit_compile(program, &error);
+    assert(jit != NULL || !rift_bytecode_jit_available());
+
+    /* A long run needs more frames than the initial stack holds */
+    char input[2002];
+    memset(input, 'a', 2000);
+    input[2000] = 'b';
+    input[2001] = '\0';
+    assert(check_same(program, jit, input));
+
+    /* Out of native budget, the interpreter's bit-state mode finishes the run */
+    input[30] = 'c';
+    input[31] = '\0';
+    rift_bytecode_vm_t *vm = rift_bytecode_vm_create_with_options(program, input, 31, 100000);
+    assert(!rift_bytecode_jit_execute(jit, program, vm, NULL));
+    assert(!rift_bytecode_vm_timed_out(vm));
+    rift_bytecode_vm_free(vm);
+
+    /* Lookahead is not compiled, execution stays in the interpreter */
+    rift_bytecode_jit_free(jit);
+    program->instructions[1].opcode = RIFT_OP_LOOKAHEAD;
+    assert(rift_bytecode_jit_compile(program, &error) == NULL);
+    assert(error.code == RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE ||
+           !rift_bytecode_jit_available());
+
+    free_program(program);
+    printf("test_bytecode_jit_limits: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running bytecode JIT tests...\n");
+
+    test_bytecode_jit_backtracking();
+    test_bytecode_jit_classes();
+    test_bytecode_jit_limits();
+
+    printf("All bytecode JIT tests PASSED!\n");
+    return 0;
+}
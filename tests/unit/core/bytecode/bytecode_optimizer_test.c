@@ -0,0 +1,151 @@
+/**
+ * @file bytecode_optimizer_test.c
+ * @brief Unit tests for the peephole optimizer of LibRift bytecode
+ *
+ * This file contains test cases verifying superinstruction fusion, jump
+ * threading, dead code removal and NOP removal.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/bytecode/bytecode_optimizer.h"
+#include "core/bytecode/bytecode_program.h"
+
+/* Append an instruction and return its index */
+static int32_t
+add(rift_bytecode_program_t *program, rift_bytecode_opcode_t opcode)
+{
+    int32_t index = rift_bytecode_program_add_instruction(program, opcode);
+    assert(index >= 0);
+    return index;
+}
+
+/* Test that abc[0-9]* becomes MATCH_STRING, STAR_CLASS, ACCEPT */
+void
+test_bytecode_optimizer_fusion(void)
+{
+    rift_bytecode_program_t *program = rift_bytecode_program_create(16, 0);
+    assert(program != NULL);
+
+    const char *literal = "abc";
+    for (const char *c = literal; *c; c++) {
+        assert(rift_bytecode_program_set_char_operand(program, add(program, RIFT_OP_MATCH_CHAR),
+                                                      *c));
+    }
+    int32_t split = add(program, RIFT_OP_SPLIT);
+    int32_t digit = add(program, RIFT_OP_MATCH_CLASS);
+    int32_t jump = add(program, RIFT_OP_JUMP);
+    add(program, RIFT_OP_ACCEPT);
+    assert(rift_bytecode_program_set_class_operand(program, digit, "0123456789", 10));
+    assert(rift_bytecode_program_set_jump_target(program, split, (uint32_t)jump + 1));
+    assert(rift_bytecode_program_set_jump_target(program, jump, (uint32_t)split));
+
+    rift_regex_error_t error;
+    assert(rift_bytecode_peephole_optimize(program, &error));
+    assert(program->instruction_count == 3);
+    assert(program->instructions[0].opcode == RIFT_OP_MATCH_STRING);
+    assert(program->instructions[0].operand.string.length == 3);
+    assert(memcmp(program->literal_pool + program->instructions[0].operand.string.offset, "abc",
+                  3) == 0);
+    assert(program->instructions[1].opcode == RIFT_OP_STAR_CLASS);
+    assert(program->instructions[1].operand.char_class.class_index < program->char_class_count);
+    assert(program->instructions[2].opcode == RIFT_OP_ACCEPT);
+    assert(rift_bytecode_validate(program, &error));
+
+    rift_bytecode_program_free(program);
+    printf("test_bytecode_optimizer_fusion: PASSED\n");
+}
+
+/* Test that a run of characters holding a jump target is split at the target */
+void
+test_bytecode_optimizer_targets(void)
+{
+    rift_bytecode_program_t *program = rift_bytecode_program_create(16, 0);
+    assert(program != NULL);
+
+    /* 0: SPLIT 3, 1: 'x', 2: 'y', 3: 'a', 4: 'b', 5: ACCEPT */
+    int32_t split = add(program, RIFT_OP_SPLIT);
+    const char *chars = "xyab";
+    for (const char *c = chars; *c; c++) {
+        assert(rift_bytecode_program_set_char_operand(program, add(program, RIFT_OP_MATCH_CHAR),
+                                                      *c));
+    }
+    add(program, RIFT_OP_ACCEPT);
+    assert(rift_bytecode_program_set_jump_target(program, split, 3));
+
+    rift_regex_error_t error;
+    assert(rift_bytecode_peephole_optimize(program, &error));
+    assert(program->instruction_count == 4);
+    assert(program->instructions[0].opcode == RIFT_OP_SPLIT);
+    assert(program->instructions[0].operand.jump_target == 2);
+    assert(program->instructions[1].opcode == RIFT_OP_MATCH_STRING);
+    assert(program->instructions[2].opcode == RIFT_OP_MATCH_STRING);
+    assert(memcmp(program->literal_pool + program->instructions[2].operand.string.offset, "ab",
+                  2) == 0);
+    assert(program->instructions[3].opcode == RIFT_OP_ACCEPT);
+
+    rift_bytecode_program_free(program);
+    printf("test_bytecode_optimizer_targets: PASSED\n");
+}
+
+/* Test jump threading, dead code after ACCEPT and NOP removal */
+void
+test_bytecode_optimizer_jumps(void)
+{
+    rift_bytecode_program_t *program = rift_bytecode_program_create(16, 0);
+    assert(program != NULL);
+
+    /* 0: SPLIT 2, 1: JUMP 3, 2: 'a', 3: JUMP 4, 4: NOP, 5: JUMP 7, 6: 'z', 7: ACCEPT, 8: 'q' */
+    int32_t split = add(program, RIFT_OP_SPLIT);
+    int32_t to_three = add(program, RIFT_OP_JUMP);
+    assert(rift_bytecode_program_set_char_operand(program, add(program, RIFT_OP_MATCH_CHAR), 'a'));
+    int32_t to_four = add(program, RIFT_OP_JUMP);
+    add(program, RIFT_OP_NOP);
+    int32_t to_accept = add(program, RIFT_OP_JUMP);
+    assert(rift_bytecode_program_set_char_operand(program, add(program, RIFT_OP_MATCH_CHAR), 'z'));
+    add(program, RIFT_OP_ACCEPT);
+    assert(rift_bytecode_program_set_char_operand(program, add(program, RIFT_OP_MATCH_CHAR), 'q'));
+    assert(rift_bytecode_program_set_jump_target(program, split, 2));
+    assert(rift_bytecode_program_set_jump_target(program, to_three, 3));
+    assert(rift_bytecode_program_set_jump_target(program, to_four, 4));
+    assert(rift_bytecode_program_set_jump_target(program, to_accept, 7));
+
+    rift_regex_error_t error;
+    assert(rift_bytecode_peephole_optimize(program, &error));
+
+    /* SPLIT 2, JUMP 3, 'a', ACCEPT */
+    assert(program->instruction_count == 4);
+    assert(program->instructions[0].opcode == RIFT_OP_SPLIT);
+    assert(program->instructions[0].operand.jump_target == 2);
+    assert(program->instructions[1].opcode == RIFT_OP_JUMP);
+    assert(program->instructions[1].operand.jump_target == 3);
+    assert(program->instructions[2].opcode == RIFT_OP_MATCH_CHAR);
+    assert(program->instructions[2].operand.character == 'a');
+    assert(program->instructions[3].opcode == RIFT_OP_ACCEPT);
+    assert(rift_bytecode_validate(program, &error));
+
+    assert(!rift_bytecode_peephole_optimize(NULL, &error));
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_PARAMETER);
+
+    rift_bytecode_program_free(program);
+    printf("test_bytecode_optimizer_jumps: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running bytecode optimizer tests...\n");
+
+    test_bytecode_optimizer_fusion();
+    test_bytecode_optimizer_targets();
+    test_bytecode_optimizer_jumps();
+
+    printf("All bytecode optimizer tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,863 @@
+/**
+ * @file bytecode_vm_test.c
+ * @brief Unit tests for the bytecode virtual machine of LibRift
+ *
+ * This file contains test cases verifying instruction dispatch, backtracking,
+ * capture groups, character classes, superinstructions, DFA table scans,
+ * atomic regions, counted loops, the instruction budget, the bit-state mode,
+ * backreferences, verified programs and VM reuse through the per-thread pool.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/automaton/dfa_table.h"
+#include "core/bytecode/bytecode_program.h"
+#include "core/bytecode/bytecode_vm.h"
+#include "core/bytecode/bytecode_vm_pool.h"
+
+/* Build a program from an instruction array */
+static rift_bytecode_program_t *
+create_program(const rift_bytecode_instruction_t *instructions, uint32_t count,
+               uint32_t group_count)
+{
+    rift_bytecode_program_t *program = (rift_bytecode_program_t *)calloc(1, sizeof(*program));
+    assert(program != NULL);
+    program->instructions =
+        (rift_bytecode_instruction_t *)malloc(count * sizeof(rift_bytecode_instruction_t));
+    assert(program->instructions != NULL);
+    memcpy(program->instructions, instructions, count * sizeof(rift_bytecode_instruction_t));
+    program->instruction_count = count;
+    program->capacity = count;
+    program->group_count = group_count;
+    return program;
+}
+
+static void
+free_program(rift_bytecode_program_t *program)
+{
+    free(program->instructions);
+    free(program);
+}
+
+/* Test a(b+)c with a greedy loop and a capture group */
+void
+test_bytecode_vm_loop(void)
+{
+    rift_bytecode_instruction_t code[8];
+    memset(code, 0, sizeof(code));
+    code[0].opcode = RIFT_OP_MATCH_CHAR;
+    code[0].operand.character = 'a';
+    code[1].opcode = RIFT_OP_SAVE_START;
+    code[1].operand.group_index = 1;
+    code[2].opcode = RIFT_OP_MATCH_CHAR;
+    code[2].operand.character = 'b';
+    code[3].opcode = RIFT_OP_SPLIT;
+    code[3].operand.jump_target = 5;
+    code[4].opcode = RIFT_OP_JUMP;
+    code[4].operand.jump_target = 2;
+    code[5].opcode = RIFT_OP_SAVE_END;
+    code[5].operand.group_index = 1;
+    code[6].opcode = RIFT_OP_MATCH_CHAR;
+    code[6].operand.character = 'c';
+    code[7].opcode = RIFT_OP_ACCEPT;
+
+    rift_bytecode_program_t *program = create_program(code, 8, 1);
+    rift_bytecode_vm_t *vm = rift_bytecode_vm_create(program, "abbbc", (size_t)-1);
+    assert(vm != NULL);
+
+    rift_regex_match_t match;
+    assert(rift_bytecode_execute(program, vm, &match));
+    assert(match.start_pos == 0 && match.end_pos == 5);
+
+    uint32_t start = 0;
+    uint32_t end = 0;
+    assert(rift_bytecode_vm_get_group(vm, 1, &start, &end));
+    assert(start == 1 && end == 4);
+    assert(vm->instruction_counter > 0);
+    assert(!rift_bytecode_vm_timed_out(vm));
+
+    /* The decoded program is reused by later runs */
+    const rift_bytecode_decoded_t *decoded = vm->decoded;
+    vm->input = "abx";
+    vm->input_length = 3;
+    assert(!rift_bytecode_execute(program, vm, &match));
+    assert(vm->decoded == decoded);
+
+    rift_bytecode_vm_free(vm);
+    free_program(program);
+    printf("test_bytecode_vm_loop: PASSED\n");
+}
+
+/* Test [a-c0]+ through the class table and through a bare class pattern */
+void
+test_bytecode_vm_class(void)
+{
+    rift_bytecode_instruction_t code[4];
+    memset(code, 0, sizeof(code));
+    code[0].opcode = RIFT_OP_MATCH_CLASS;
+    code[1].opcode = RIFT_OP_SPLIT;
+    code[1].operand.jump_target = 3;
+    code[2].opcode = RIFT_OP_JUMP;
+    code[2].operand.jump_target = 0;
+    code[3].opcode = RIFT_OP_ACCEPT;
+
+    uint32_t map[2 * RIFT_BYTECODE_CLASS_WORDS];
+    memset(map, 0, sizeof(map));
+    const char *members = "abc0\xe9";
+    for (const char *m = members; *m; m++) {
+        unsigned char c = (unsigned char)*m;
+        map[RIFT_BYTECODE_CLASS_WORDS + (c >> 5)] |= (uint32_t)1 << (c & 31);
+    }
+    code[0].operand.char_class.class_index = 1;
+
+    rift_bytecode_program_t *program = create_program(code, 4, 0);
+    program->char_class_map = map;
+    program->char_class_count = 2;
+
+    rift_regex_match_t match;
+    rift_bytecode_vm_t *vm = rift_bytecode_vm_create(program, "cab0\xe9z", (size_t)-1);
+    assert(vm != NULL);
+    assert(rift_bytecode_execute(program, vm, &match));
+    assert(match.start_pos == 0 && match.end_pos == 5);
+    rift_bytecode_vm_free(vm);
+
+    vm = rift_bytecode_vm_create(program, "zab", (size_t)-1);
+    assert(!rift_bytecode_execute(program, vm, &match));
+    rift_bytecode_vm_free(vm);
+
+    /* Without a row in the table the VM builds the bitmap from the pattern */
+    program->char_class_map = NULL;
+    program->char_class_count = 0;
+    program->instructions[0].operand.char_class.class_pattern = (char *)"ab";
+    program->instructions[0].operand.char_class.pattern_length = 2;
+
+    vm = rift_bytecode_vm_create(program, "abac", (size_t)-1);
+    assert(rift_bytecode_execute(program, vm, &match));
+    assert(match.start_pos == 0 && match.end_pos == 3);
+    rift_bytecode_vm_free(vm);
+
+    free_program(program);
+    printf("test_bytecode_vm_class: PASSED\n");
+}
+
+/* Test MATCH_STRING, and [a-z]*z with STAR_CLASS giving back characters */
+void
+test_bytecode_vm_superinstructions(void)
+{
+    rift_bytecode_instruction_t code[3];
+    memset(code, 0, sizeof(code));
+    code[0].opcode = RIFT_OP_MATCH_STRING;
+    code[0].operand.string.offset = 1;
+    code[0].operand.string.length = 3;
+    code[1].opcode = RIFT_OP_ACCEPT;
+
+    rift_bytecode_program_t *program = create_program(code, 2, 0);
+    program->literal_pool = (char *)"xabc";
+    program->literal_pool_size = 4;
+
+    rift_regex_match_t match;
+    rift_bytecode_vm_t *vm = rift_bytecode_vm_create(program, "abcd", (size_t)-1);
+    assert(rift_bytecode_execute(program, vm, &match));
+    assert(match.start_pos == 0 && match.end_pos == 3);
+    rift_bytecode_vm_free(vm);
+
+    vm = rift_bytecode_vm_create(program, "ab", (size_t)-1);
+    assert(!rift_bytecode_execute(program, vm, &match));
+    rift_bytecode_vm_free(vm);
+
+    /* A literal outside the pool is rejected */
+    program->instructions[0].operand.string.length = 4;
+    vm = rift_bytecode_vm_create(program, "abcd", (size_t)-1);
+    assert(!rift_bytecode_execute(program, vm, &match));
+    rift_bytecode_vm_free(vm);
+    free_program(program);
+
+    uint32_t map[RIFT_BYTECODE_CLASS_WORDS];
+    memset(map, 0, sizeof(map));
+    for (unsigned char c = 'a'; c <= 'z'; c++) {
+        map[c >> 5] |= (uint32_t)1 << (c & 31);
+    }
+    code[0].opcode = RIFT_OP_STAR_CLASS;
+    memset(&code[0].operand, 0, sizeof(code[0].operand));
+    code[1].opcode = RIFT_OP_MATCH_CHAR;
+    code[1].operand.character = 'z';
+    code[2].opcode = RIFT_OP_ACCEPT;
+
+    program = create_program(code, 3, 0);
+    program->char_class_map = map;
+    program->char_class_count = 1;
+
+    vm = rift_bytecode_vm_create(program, "abzcd!", (size_t)-1);
+    assert(rift_bytecode_execute(program, vm, &match));
+    assert(match.start_pos == 0 && match.end_pos == 3);
+    rift_bytecode_vm_free(vm);
+
+    vm = rift_bytecode_vm_create(program, "z", (size_t)-1);
+    assert(rift_bytecode_execute(program, vm, &match));
+    assert(match.end_pos == 1);
+    rift_bytecode_vm_free(vm);
+
+    vm = rift_bytecode_vm_create(program, "abc", (size_t)-1);
+    assert(!rift_bytecode_execute(program, vm, &match));
+    assert(vm->stack_size == 0);
+    rift_bytecode_vm_free(vm);
+
+    free_program(program);
+    printf("test_bytecode_vm_superinstructions: PASSED\n");
+}
+
+/* Test that an endless loop runs out of budget */
+void
+test_bytecode_vm_budget(void)
+{
+    rift_bytecode_instruction_t code[2];
+    memset(code, 0, sizeof(code));
+    code[0].opcode = RIFT_OP_NOP;
+    code[1].opcode = RIFT_OP_JUMP;
+    code[1].operand.jump_target = 0;
+
+    rift_bytecode_program_t *program = create_program(code, 2, 0);
+    rift_bytecode_vm_t *vm = rift_bytecode_vm_create_with_options(program, "", 0, 1000);
+    assert(vm != NULL);
+
+    /* Memoized, the loop would fail on its second visit instead */
+    rift_bytecode_vm_set_bit_state_limit(vm, 0);
+
+    assert(!rift_bytecode_execute(program, vm, NULL));
+    assert(rift_bytecode_vm_timed_out(vm));
+    assert(vm->instruction_counter >= 1000);
+    assert(vm->instruction_counter <= 1000 + program->instruction_count);
+
+    rift_bytecode_vm_free(vm);
+    free_program(program);
+    printf("test_bytecode_vm_budget: PASSED\n");
+}
+
+/* Test that (a|a)*b on a run of a's finishes in bit-state mode */
+void
+test_bytecode_vm_bit_state(void)
+{
+    rift_bytecode_instruction_t code[8];
+    memset(code, 0, sizeof(code));
+    code[0].opcode = RIFT_OP_SPLIT;
+    code[0].operand.jump_target = 6;
+    code[1].opcode = RIFT_OP_SPLIT;
+    code[1].operand.jump_target = 4;
+    code[2].opcode = RIFT_OP_MATCH_CHAR;
+    code[2].operand.character = 'a';
+    code[3].opcode = RIFT_OP_JUMP;
+    code[3].operand.jump_target = 5;
+    code[4].opcode = RIFT_OP_MATCH_CHAR;
+    code[4].operand.character = 'a';
+    code[5].opcode = RIFT_OP_JUMP;
+    code[5].operand.jump_target = 0;
+    code[6].opcode = RIFT_OP_MATCH_CHAR;
+    code[6].operand.character = 'b';
+    code[7].opcode = RIFT_OP_ACCEPT;
+
+    char input[32];
+    memset(input, 'a', 30);
+    input[30] = 'c';
+    input[31] = '\0';
+
+    /* Plain backtracking explores 2^30 paths and runs out of budget */
+    rift_bytecode_program_t *program = create_program(code, 8, 0);
+    rift_bytecode_vm_t *vm = rift_bytecode_vm_create(program, input, (size_t)-1);
+    rift_bytecode_vm_set_bit_state_limit(vm, 0);
+    assert(!rift_bytecode_execute(program, vm, NULL));
+    assert(rift_bytecode_vm_timed_out(vm) && !vm->bit_state);
+
+    /* Memoized, each (instruction, position) pair is explored once */
+    rift_bytecode_vm_set_bit_state_limit(vm, RIFT_BYTECODE_VM_BIT_STATE_BITS);
+    assert(!rift_bytecode_execute(program, vm, NULL));
+    assert(!rift_bytecode_vm_timed_out(vm) && vm->bit_state);
+    assert(vm->instruction_counter < 8 * 8 * 32);
+
+    /* The match is the one plain backtracking finds */
+    input[30] = 'b';
+    rift_regex_match_t match;
+    assert(rift_bytecode_execute(program, vm, &match));
+    assert(match.start_pos == 0 && match.end_pos == 31);
+
+    /* Too large a bitmap falls back to plain backtracking */
+    rift_bytecode_vm_set_bit_state_limit(vm, 64);
+    assert(rift_bytecode_execute(program, vm, &match));
+    assert(!vm->bit_state);
+
+    rift_bytecode_vm_free(vm);
+    free_program(program);
+    printf("test_bytecode_vm_bit_state: PASSED\n");
+}
+
+/* Test (x)(?:a|a)*\1: memoized on the spans of the group, and compared ignoring case */
+void
+test_bytecode_vm_backref(void)
+{
+    rift_bytecode_instruction_t code[11];
+    memset(code, 0, sizeof(code));
+    code[0].opcode = RIFT_OP_SAVE_START;
+    code[0].operand.group_index = 1;
+    code[1].opcode = RIFT_OP_MATCH_CHAR;
+    code[1].operand.character = 'x';
+    code[2].opcode = RIFT_OP_SAVE_END;
+    code[2].operand.group_index = 1;
+    code[3].opcode = RIFT_OP_SPLIT;
+    code[3].operand.jump_target = 9;
+    code[4].opcode = RIFT_OP_SPLIT;
+    code[4].operand.jump_target = 7;
+    code[5].opcode = RIFT_OP_MATCH_CHAR;
+    code[5].operand.character = 'a';
+    code[6].opcode = RIFT_OP_JUMP;
+    code[6].operand.jump_target = 3;
+    code[7].opcode = RIFT_OP_MATCH_CHAR;
+    code[7].operand.character = 'a';
+    code[8].opcode = RIFT_OP_JUMP;
+    code[8].operand.jump_target = 3;
+    code[9].opcode = RIFT_OP_BACKREF;
+    code[9].operand.group_index = 1;
+    code[10].opcode = RIFT_OP_ACCEPT;
+
+    char input[33];
+    input[0] = 'x';
+    memset(input + 1, 'a', 30);
+    input[31] = 'y';
+    input[32] = '\0';
+
+    /* Plain backtracking explores 2^30 paths and runs out of budget */
+    rift_bytecode_program_t *program = create_program(code, 11, 1);
+    rift_bytecode_vm_t *vm = rift_bytecode_vm_create(program, input, (size_t)-1);
+    rift_bytecode_vm_set_bit_state_limit(vm, 0);
+    assert(!rift_bytecode_execute(program, vm, NULL));
+    assert(rift_bytecode_vm_timed_out(vm) && vm->memo_words == 0);
+
+    /* Memoized with the span of group 1, each state is explored once */
+    rift_bytecode_vm_set_bit_state_limit(vm, RIFT_BYTECODE_VM_BIT_STATE_BITS);
+    assert(!rift_bytecode_execute(program, vm, NULL));
+    assert(!rift_bytecode_vm_timed_out(vm) && !vm->bit_state && vm->memo_words == 4);
+    assert(vm->instruction_counter < 11 * 11 * 33);
+
+    rift_regex_match_t match;
+    input[31] = 'x';
+    assert(rift_bytecode_execute(program, vm, &match));
+    assert(match.start_pos == 0 && match.end_pos == 32);
+
+    /* A small memo table fills up, and the run goes on with the entries it has */
+    rift_bytecode_vm_set_bit_state_limit(vm, 32 * 4 * 64);
+    input[31] = 'y';
+    assert(!rift_bytecode_execute(program, vm, NULL));
+    assert(!rift_bytecode_vm_timed_out(vm) && vm->memo_words == 4 && vm->memo_free == 0);
+
+    /* Case matters unless the program ignores it */
+    input[31] = 'X';
+    assert(!rift_bytecode_execute(program, vm, NULL));
+    rift_bytecode_vm_free(vm);
+
+    program->flags = RIFT_REGEX_FLAG_CASE_INSENSITIVE;
+    vm = rift_bytecode_vm_create(program, input, (size_t)-1);
+    assert(rift_bytecode_execute(program, vm, &match) && match.end_pos == 32);
+
+    /* Only letters fold: '@' and '`' differ in the case bit alone */
+    program->instructions[1].operand.character = '@';
+    rift_bytecode_vm_free(vm);
+    vm = rift_bytecode_vm_create(program, "@`", 2);
+    assert(!rift_bytecode_execute(program, vm, NULL));
+    rift_bytecode_vm_free(vm);
+    vm = rift_bytecode_vm_create(program, "@@", 2);
+    assert(rift_bytecode_execute(program, vm, &match) && match.end_pos == 2);
+
+    rift_bytecode_vm_free(vm);
+    free_program(program);
+    printf("test_bytecode_vm_backref: PASSED\n");
+}
+
+/* Test rebinding a VM and taking VMs from the pool */
+void
+test_bytecode_vm_pool(void)
+{
+    rift_bytecode_instruction_t code[4];
+    memset(code, 0, sizeof(code));
+    code[0].opcode = RIFT_OP_MATCH_CHAR;
+    code[0].operand.character = 'a';
+    code[1].opcode = RIFT_OP_ACCEPT;
+    rift_bytecode_program_t *plain = create_program(code, 2, 0);
+
+    code[0].opcode = RIFT_OP_SAVE_START;
+    code[0].operand.group_index = 3;
+    code[1].opcode = RIFT_OP_MATCH_CHAR;
+    code[1].operand.character = 'b';
+    code[2].opcode = RIFT_OP_SAVE_END;
+    code[2].operand.group_index = 3;
+    code[3].opcode = RIFT_OP_ACCEPT;
+    rift_bytecode_program_t *grouped = create_program(code, 4, 3);
+
+    /* A bound VM keeps its stack and grows its captures for more groups */
+    rift_regex_match_t match;
+    rift_bytecode_vm_t *vm = rift_bytecode_vm_create(plain, "a", (size_t)-1);
+    assert(rift_bytecode_execute(plain, vm, &match));
+    uint32_t *stack = vm->backtrack_stack;
+    assert(rift_bytecode_vm_bind(vm, grouped, "b", (size_t)-1));
+    assert(vm->backtrack_stack == stack && vm->capture_count == 4);
+    assert(rift_bytecode_execute(grouped, vm, &match));
+
+    uint32_t start = 0;
+    uint32_t end = 0;
+    assert(rift_bytecode_vm_get_group(vm, 3, &start, &end));
+    assert(start == 0 && end == 1);
+    assert(rift_bytecode_vm_bind(vm, plain, "ba", 2));
+    assert(!rift_bytecode_execute(plain, vm, &match));
+    rift_bytecode_vm_free(vm);
+
+    /* The pool hands back the VM that last ran the program */
+    vm = rift_bytecode_vm_acquire(plain, "a", (size_t)-1);
+    assert(vm != NULL && rift_bytecode_execute(plain, vm, &match));
+    rift_bytecode_vm_release(vm);
+    rift_bytecode_vm_t *again = rift_bytecode_vm_acquire(plain, "x", (size_t)-1);
+    assert(again == vm && again->decoded_program == plain);
+    assert(!rift_bytecode_execute(plain, again, &match));
+
+    /* A VM already held is not handed out twice */
+    rift_bytecode_vm_t *nested = rift_bytecode_vm_acquire(plain, "a", (size_t)-1);
+    assert(nested != NULL && nested != again);
+    assert(rift_bytecode_execute(plain, nested, &match));
+    rift_bytecode_vm_release(nested);
+    rift_bytecode_vm_release(again);
+
+    /* More programs than slots still get VMs */
+    rift_bytecode_program_t *programs[RIFT_BYTECODE_VM_POOL_SIZE + 2];
+    for (uint32_t i = 0; i < RIFT_BYTECODE_VM_POOL_SIZE + 2; i++) {
+        programs[i] = create_program(grouped->instructions, 4, 3);
+        vm = rift_bytecode_vm_acquire(programs[i], "b", 1);
+        assert(vm != NULL && rift_bytecode_execute(programs[i], vm, &match));
+        rift_bytecode_vm_release(vm);
+    }
+    for (uint32_t i = 0; i < RIFT_BYTECODE_VM_POOL_SIZE + 2; i++) {
+        rift_bytecode_vm_pool_evict(programs[i]);
+        free_program(programs[i]);
+    }
+
+    rift_bytecode_vm_pool_evict(plain);
+    rift_bytecode_vm_pool_evict(grouped);
+    free_program(plain);
+    free_program(grouped);
+    printf("test_bytecode_vm_pool: PASSED\n");
+}
+
+/* Test invalid jump targets, group indices and running off the end */
+void
+test_bytecode_vm_invalid(void)
+{
+    rift_bytecode_instruction_t code[2];
+    memset(code, 0, sizeof(code));
+
+    /* Jumping past the end fails without reading beyond the program */
+    code[0].opcode = RIFT_OP_JUMP;
+    code[0].operand.jump_target = 100;
+    rift_bytecode_program_t *program = create_program(code, 1, 0);
+    rift_bytecode_vm_t *vm = rift_bytecode_vm_create(program, "a", 1);
+    assert(!rift_bytecode_execute(program, vm, NULL));
+    rift_bytecode_vm_free(vm);
+    free_program(program);
+
+    /* Falling off the end fails */
+    code[0].opcode = RIFT_OP_MATCH_ANY;
+    program = create_program(code, 1, 0);
+    vm = rift_bytecode_vm_create(program, "a", 1);
+    assert(!rift_bytecode_execute(program, vm, NULL));
+    rift_bytecode_vm_free(vm);
+    free_program(program);
+
+    /* Saving a group the program does not have fails */
+    code[0].opcode = RIFT_OP_SAVE_START;
+    code[0].operand.group_index = 5;
+    code[1].opcode = RIFT_OP_ACCEPT;
+    program = create_program(code, 2, 0);
+    vm = rift_bytecode_vm_create(program, "a", 1);
+    assert(!rift_bytecode_execute(program, vm, NULL));
+    rift_bytecode_vm_free(vm);
+    free_program(program);
+
+    assert(!rift_bytecode_execute(NULL, NULL, NULL));
+    printf("test_bytecode_vm_invalid: PASSED\n");
+}
+
+/* Test DFA_SCAN over a hand-built table for ab*, followed by 'c' */
+void
+test_bytecode_vm_dfa_scan(void)
+{
+    /* Class 0 is any other byte, 1 is 'a', 2 is 'b'; row 0 is the dead state */
+    uint32_t next[3 * 3] = {0, 0, 0, 0, 2, 0, 0, 0, 2};
+    uint64_t accept = (uint64_t)1 << 2;
+    rift_dfa_table_t table;
+    memset(&table, 0, sizeof(table));
+    table.byte_class['a'] = 1;
+    table.byte_class['b'] = 2;
+    table.num_states = 3;
+    table.start_state = 1;
+    table.num_classes = 3;
+    table.next = next;
+    table.accept_bitmap = &accept;
+    rift_dfa_table_t *tables[1] = {&table};
+
+    rift_bytecode_instruction_t code[3];
+    memset(code, 0, sizeof(code));
+    code[0].opcode = RIFT_OP_DFA_SCAN;
+    code[1].opcode = RIFT_OP_MATCH_CHAR;
+    code[1].operand.character = 'c';
+    code[2].opcode = RIFT_OP_ACCEPT;
+
+    rift_bytecode_program_t *program = create_program(code, 3, 0);
+    program->dfa_tables = tables;
+    program->dfa_table_count = 1;
+
+    rift_regex_match_t match;
+    rift_bytecode_vm_t *vm = rift_bytecode_vm_create(program, "abbbc", (size_t)-1);
+    assert(vm != NULL);
+    assert(rift_bytecode_execute(program, vm, &match));
+    assert(match.start_pos == 0 && match.end_pos == 5);
+    rift_bytecode_vm_free(vm);
+
+    vm = rift_bytecode_vm_create(program, "bc", (size_t)-1);
+    assert(!rift_bytecode_execute(program, vm, &match));
+    rift_bytecode_vm_free(vm);
+
+    /* A scan of a table the program does not have fails */
+    program->instructions[0].operand.dfa_index = 1;
+    vm = rift_bytecode_vm_create(program, "abc", (size_t)-1);
+    assert(!rift_bytecode_execute(program, vm, &match));
+    rift_bytecode_vm_free(vm);
+
+    free_program(program);
+    printf("test_bytecode_vm_dfa_scan: PASSED\n");
+}
+
+/* Test ATOMIC_START and CUT with (?>a*) followed by a literal */
+void
+test_bytecode_vm_atomic(void)
+{
+    rift_bytecode_instruction_t code[7];
+    memset(code, 0, sizeof(code));
+    code[0].opcode = RIFT_OP_ATOMIC_START;
+    code[1].opcode = RIFT_OP_SPLIT;
+    code[1].operand.jump_target = 4;
+    code[2].opcode = RIFT_OP_MATCH_CHAR;
+    code[2].operand.character = 'a';
+    code[3].opcode = RIFT_OP_JUMP;
+    code[3].operand.jump_target = 1;
+    code[4].opcode = RIFT_OP_CUT;
+    code[5].opcode = RIFT_OP_MATCH_CHAR;
+    code[5].operand.character = 'a';
+    code[6].opcode = RIFT_OP_ACCEPT;
+
+    rift_bytecode_program_t *program = create_program(code, 7, 0);
+    rift_regex_match_t match;
+
+    /* The group keeps every 'a', none is given back to the literal */
+    rift_bytecode_vm_t *vm = rift_bytecode_vm_create(program, "aaa", (size_t)-1);
+    assert(vm != NULL);
+    assert(!rift_bytecode_execute(program, vm, &match));
+    assert(!vm->bit_state);
+    rift_bytecode_vm_free(vm);
+
+    program->instructions[5].operand.character = 'b';
+    vm = rift_bytecode_vm_create(program, "aab", (size_t)-1);
+    assert(rift_bytecode_execute(program, vm, &match));
+    assert(match.start_pos == 0 && match.end_pos == 3);
+    rift_bytecode_vm_free(vm);
+
+    /* Without the markers the loop backtracks into a match */
+    program->instructions[0].opcode = RIFT_OP_NOP;
+    program->instructions[4].opcode = RIFT_OP_NOP;
+    program->instructions[5].operand.character = 'a';
+    vm = rift_bytecode_vm_create(program, "aaa", (size_t)-1);
+    assert(rift_bytecode_execute(program, vm, &match));
+    assert(match.start_pos == 0 && match.end_pos == 3);
+    rift_bytecode_vm_free(vm);
+
+    /* A CUT outside any atomic region is an error */
+    program->instructions[4].opcode = RIFT_OP_CUT;
+    vm = rift_bytecode_vm_create(program, "aaa", (size_t)-1);
+    assert(!rift_bytecode_execute(program, vm, &match));
+    rift_bytecode_vm_free(vm);
+
+    free_program(program);
+    printf("test_bytecode_vm_atomic: PASSED\n");
+}
+
+/* Test a counted loop for a{2,3} followed by a literal, as the compiler lays it out */
+void
+test_bytecode_vm_counted_loop(void)
+{
+    rift_bytecode_instruction_t code[14];
+    memset(code, 0, sizeof(code));
+    code[0].opcode = RIFT_OP_REPEAT_START;
+    code[0].operand.repeat.min = 2;
+    code[0].operand.repeat.max = 3;
+    code[0].operand.repeat.greedy = true;
+    code[1].opcode = RIFT_OP_SPLIT;
+    code[1].operand.jump_target = 4;
+    code[2].opcode = RIFT_OP_REPEAT_AGAIN;
+    code[3].opcode = RIFT_OP_JUMP;
+    code[3].operand.jump_target = 6;
+    code[4].opcode = RIFT_OP_REPEAT_EXIT;
+    code[5].opcode = RIFT_OP_JUMP;
+    code[5].operand.jump_target = 12;
+    code[6].opcode = RIFT_OP_MATCH_CHAR;
+    code[6].operand.character = 'a';
+    code[7].opcode = RIFT_OP_REPEAT_END;
+    code[8].opcode = RIFT_OP_SPLIT;
+    code[8].operand.jump_target = 11;
+    code[9].opcode = RIFT_OP_REPEAT_AGAIN;
+    code[10].opcode = RIFT_OP_JUMP;
+    code[10].operand.jump_target = 6;
+    code[11].opcode = RIFT_OP_REPEAT_EXIT;
+    code[12].opcode = RIFT_OP_MATCH_CHAR;
+    code[12].operand.character = 'b';
+    code[13].opcode = RIFT_OP_ACCEPT;
+
+    rift_bytecode_program_t *program = create_program(code, 14, 0);
+    const char *inputs[] = {"aab", "aaab", "ab", "aaaab"};
+    const uint32_t ends[] = {3, 4, 0, 0};
+    rift_regex_match_t match;
+
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+        rift_bytecode_vm_t *vm = rift_bytecode_vm_create(program, inputs[i], (size_t)-1);
+        assert(vm != NULL);
+        assert(rift_bytecode_execute(program, vm, &match) == (ends[i] > 0));
+        assert(ends[i] == 0 || (match.start_pos == 0 && match.end_pos == ends[i]));
+        assert(vm->counter_count == 1);
+        assert(!vm->bit_state);
+        rift_bytecode_vm_free(vm);
+    }
+
+    /* a{2,3}a: the third iteration is given back, and the count with it */
+    program->instructions[12].operand.character = 'a';
+    rift_bytecode_vm_t *vm = rift_bytecode_vm_create(program, "aaa", (size_t)-1);
+    assert(rift_bytecode_execute(program, vm, &match));
+    assert(match.start_pos == 0 && match.end_pos == 3);
+    rift_bytecode_vm_free(vm);
+
+    /* A guard naming anything but a REPEAT_START is invalid */
+    program->instructions[9].operand.jump_target = 1;
+    vm = rift_bytecode_vm_create(program, "aaa", (size_t)-1);
+    assert(!rift_bytecode_execute(program, vm, &match));
+    rift_bytecode_vm_free(vm);
+
+    free_program(program);
+    printf("test_bytecode_vm_counted_loop: PASSED\n");
+}
+
+/* Test the telemetry of an execution of (a|ab)c */
+void
+test_bytecode_vm_stats(void)
+{
+    rift_bytecode_instruction_t code[7];
+    memset(code, 0, sizeof(code));
+    code[0].opcode = RIFT_OP_SPLIT;
+    code[0].operand.jump_target = 3;
+    code[1].opcode = RIFT_OP_MATCH_CHAR;
+    code[1].operand.character = 'a';
+    code[2].opcode = RIFT_OP_JUMP;
+    code[2].operand.jump_target = 5;
+    code[3].opcode = RIFT_OP_MATCH_CHAR;
+    code[3].operand.character = 'a';
+    code[4].opcode = RIFT_OP_MATCH_CHAR;
+    code[4].operand.character = 'b';
+    code[5].opcode = RIFT_OP_MATCH_CHAR;
+    code[5].operand.character = 'c';
+    code[6].opcode = RIFT_OP_ACCEPT;
+
+    rift_bytecode_program_t *program = create_program(code, 7, 0);
+    rift_bytecode_vm_t *vm = rift_bytecode_vm_create(program, "abc", (size_t)-1);
+    assert(vm != NULL);
+
+    rift_regex_match_t match;
+    rift_match_stats_t stats;
+    assert(rift_bytecode_execute(program, vm, &match));
+    assert(rift_bytecode_vm_get_stats(vm, &stats));
+    assert(stats.engine == RIFT_MATCH_ENGINE_BYTECODE_VM);
+    assert(stats.steps == vm->instruction_counter && stats.steps > 0);
+    assert(stats.backtrack_pushes == 1 && stats.backtrack_pops == 1);
+    assert(stats.max_stack_depth == 1);
+
+    /* Each execution starts its counters over */
+    assert(rift_bytecode_vm_bind(vm, program, "ac", (size_t)-1));
+    assert(rift_bytecode_execute(program, vm, &match));
+    assert(rift_bytecode_vm_get_stats(vm, &stats));
+    assert(stats.backtrack_pushes == 1 && stats.backtrack_pops == 0);
+    assert(!rift_bytecode_vm_get_stats(NULL, &stats));
+
+    rift_bytecode_vm_free(vm);
+    free_program(program);
+    printf("test_bytecode_vm_stats: PASSED\n");
+}
+
+/* Test that each run takes a loop with the features it needs */
+void
+test_bytecode_vm_feature_loops(void)
+{
+    /* (?:ab|a)c without capture instructions, though the program declares a group */
+    rift_bytecode_instruction_t plain[7];
+    memset(plain, 0, sizeof(plain));
+    plain[0].opcode = RIFT_OP_SPLIT;
+    plain[0].operand.jump_target = 4;
+    plain[1].opcode = RIFT_OP_MATCH_CHAR;
+    plain[1].operand.character = 'a';
+    plain[2].opcode = RIFT_OP_MATCH_CHAR;
+    plain[2].operand.character = 'b';
+    plain[3].opcode = RIFT_OP_JUMP;
+    plain[3].operand.jump_target = 5;
+    plain[4].opcode = RIFT_OP_MATCH_CHAR;
+    plain[4].operand.character = 'a';
+    plain[5].opcode = RIFT_OP_MATCH_CHAR;
+    plain[5].operand.character = 'c';
+    plain[6].opcode = RIFT_OP_ACCEPT;
+
+    rift_bytecode_program_t *program = create_program(plain, 7, 1);
+    rift_bytecode_vm_t *vm = rift_bytecode_vm_create(program, "ac", (size_t)-1);
+    assert(vm != NULL);
+
+    /* Frames of a program without captures hold no capture words */
+    rift_regex_match_t match;
+    assert(rift_bytecode_execute(program, vm, &match));
+    assert(match.end_pos == 2);
+    assert(vm->max_stack_size == 3);
+
+    /* Without a budget the same program runs the loop that checks none */
+    vm->max_instructions = UINT64_MAX;
+    assert(rift_bytecode_execute(program, vm, &match) && !vm->timed_out);
+    vm->max_instructions = 1;
+    assert(!rift_bytecode_execute(program, vm, &match));
+    assert(vm->timed_out);
+    rift_bytecode_vm_free(vm);
+    free_program(program);
+
+    /* (a)x|ab: the failed branch's capture is undone by backtracking */
+    rift_bytecode_instruction_t groups[8];
+    memset(groups, 0, sizeof(groups));
+    groups[0].opcode = RIFT_OP_SPLIT;
+    groups[0].operand.jump_target = 5;
+    groups[1].opcode = RIFT_OP_SAVE_START;
+    groups[1].operand.group_index = 1;
+    groups[2].opcode = RIFT_OP_MATCH_CHAR;
+    groups[2].operand.character = 'a';
+    groups[3].opcode = RIFT_OP_SAVE_END;
+    groups[3].operand.group_index = 1;
+    groups[4].opcode = RIFT_OP_MATCH_CHAR;
+    groups[4].operand.character = 'x';
+    groups[5].opcode = RIFT_OP_MATCH_CHAR;
+    groups[5].operand.character = 'a';
+    groups[6].opcode = RIFT_OP_MATCH_CHAR;
+    groups[6].operand.character = 'b';
+    groups[7].opcode = RIFT_OP_ACCEPT;
+
+    program = create_program(groups, 8, 1);
+    vm = rift_bytecode_vm_create(program, "ab", (size_t)-1);
+    assert(vm != NULL);
+    assert(rift_bytecode_execute(program, vm, &match));
+    assert(vm->max_stack_size == 3 + 2 * 2);
+
+    uint32_t start = 0;
+    uint32_t end = 0;
+    assert(!rift_bytecode_vm_get_group(vm, 1, &start, &end));
+    assert(rift_bytecode_vm_get_group(vm, 0, &start, &end) && start == 0 && end == 2);
+
+    rift_bytecode_vm_free(vm);
+    free_program(program);
+    printf("test_bytecode_vm_feature_loops: PASSED\n");
+}
+
+/* Test programs the validator verified, and that changing them drops the mark */
+void
+test_bytecode_vm_verified(void)
+{
+    /* (a)b with a capture group */
+    rift_bytecode_instruction_t code[5];
+    memset(code, 0, sizeof(code));
+    code[0].opcode = RIFT_OP_SAVE_START;
+    code[0].operand.group_index = 1;
+    code[1].opcode = RIFT_OP_MATCH_CHAR;
+    code[1].operand.character = 'a';
+    code[2].opcode = RIFT_OP_SAVE_END;
+    code[2].operand.group_index = 1;
+    code[3].opcode = RIFT_OP_MATCH_CHAR;
+    code[3].operand.character = 'b';
+    code[4].opcode = RIFT_OP_ACCEPT;
+
+    rift_bytecode_program_t *program = create_program(code, 5, 1);
+    assert(!program->verified);
+    assert(rift_bytecode_validate(program, NULL));
+    assert(program->verified);
+
+    rift_bytecode_vm_t *vm = rift_bytecode_vm_create(program, "ab", (size_t)-1);
+    assert(vm != NULL);
+    rift_regex_match_t match;
+    assert(rift_bytecode_execute(program, vm, &match));
+    assert(match.end_pos == 2);
+
+    uint32_t start = 0;
+    uint32_t end = 0;
+    assert(rift_bytecode_vm_get_group(vm, 1, &start, &end) && start == 0 && end == 1);
+
+    /* Retargeting a jump drops the mark until the program is validated again */
+    program->instructions[3].opcode = RIFT_OP_JUMP;
+    assert(rift_bytecode_program_set_jump_target(program, 3, 4));
+    assert(!program->verified);
+    assert(rift_bytecode_validate(program, NULL) && program->verified);
+    rift_bytecode_vm_free(vm);
+    vm = rift_bytecode_vm_create(program, "ab", (size_t)-1);
+    assert(vm != NULL);
+    assert(rift_bytecode_execute(program, vm, &match));
+    assert(match.end_pos == 1);
+    rift_bytecode_vm_free(vm);
+    free_program(program);
+
+    /* A program the validator refuses stays checked, and fails in the VM */
+    code[0].operand.group_index = 5;
+    program = create_program(code, 5, 1);
+    rift_regex_error_t error;
+    memset(&error, 0, sizeof(error));
+    assert(!rift_bytecode_validate(program, &error));
+    assert(!program->verified);
+    vm = rift_bytecode_vm_create(program, "ab", (size_t)-1);
+    assert(vm != NULL);
+    assert(!rift_bytecode_execute(program, vm, NULL));
+    rift_bytecode_vm_free(vm);
+    free_program(program);
+
+    code[0].opcode = RIFT_OP_REPEAT_EXIT + 1;
+    program = create_program(code, 5, 1);
+    assert(!rift_bytecode_validate(program, NULL) && !program->verified);
+    free_program(program);
+
+    printf("test_bytecode_vm_verified: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running bytecode VM tests...\n");
+
+    test_bytecode_vm_loop();
+    test_bytecode_vm_class();
+    test_bytecode_vm_superinstructions();
+    test_bytecode_vm_dfa_scan();
+    test_bytecode_vm_atomic();
+    test_bytecode_vm_counted_loop();
+    test_bytecode_vm_stats();
+    test_bytecode_vm_feature_loops();
+    test_bytecode_vm_verified();
+    test_bytecode_vm_budget();
+    test_bytecode_vm_bit_state();
+    test_bytecode_vm_backref();
+    test_bytecode_vm_pool();
+    test_bytecode_vm_invalid();
+
+    printf("All bytecode VM tests PASSED!\n");
+    return 0;
+}
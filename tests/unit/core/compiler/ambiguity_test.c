@@ -0,0 +1,151 @@
+/**
+ * @file ambiguity_test.c
+ * @brief Unit tests for the static catastrophic-backtracking analysis
+ *
+ * This file contains test cases verifying that hand-built NFAs are classified
+ * as finite, polynomially or exponentially ambiguous.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/automaton/automaton.h"
+#include "core/automaton/state.h"
+#include "core/compiler/ambiguity.h"
+
+/* Analyze an NFA and free it */
+static rift_ambiguity_verdict_t
+analyze(rift_regex_automaton_t *nfa)
+{
+    rift_regex_error_t error = {0};
+    rift_ambiguity_verdict_t verdict;
+    rift_ambiguity_verdict_init(&verdict);
+    assert(rift_ambiguity_analyze_automaton(nfa, &verdict, &error));
+    rift_automaton_free(nfa);
+    return verdict;
+}
+
+/* Test that a literal and a*b* have finitely many parses */
+void
+test_ambiguity_finite(void)
+{
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *s0 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s1 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s2 = rift_automaton_create_state(nfa, true);
+    assert(rift_automaton_add_transition(nfa, s0, s1, "a"));
+    assert(rift_automaton_add_transition(nfa, s1, s2, "b"));
+
+    rift_ambiguity_verdict_t verdict = analyze(nfa);
+    assert(verdict.ambiguity == RIFT_AMBIGUITY_FINITE);
+    assert(!rift_ambiguity_is_dangerous(&verdict));
+
+    nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    s0 = rift_automaton_create_state(nfa, false);
+    s1 = rift_automaton_create_state(nfa, true);
+    assert(rift_automaton_add_transition(nfa, s0, s0, "a"));
+    assert(rift_automaton_create_epsilon_transition(nfa, s0, s1));
+    assert(rift_automaton_add_transition(nfa, s1, s1, "b"));
+
+    verdict = analyze(nfa);
+    assert(verdict.ambiguity == RIFT_AMBIGUITY_FINITE);
+
+    printf("test_ambiguity_finite: PASSED\n");
+}
+
+/* Test that a*a* and a*a*a* are polynomial with degrees 1 and 2 */
+void
+test_ambiguity_polynomial(void)
+{
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *s0 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s1 = rift_automaton_create_state(nfa, true);
+    assert(rift_automaton_add_transition(nfa, s0, s0, "a"));
+    assert(rift_automaton_create_epsilon_transition(nfa, s0, s1));
+    assert(rift_automaton_add_transition(nfa, s1, s1, "a"));
+
+    rift_ambiguity_verdict_t verdict = analyze(nfa);
+    assert(verdict.ambiguity == RIFT_AMBIGUITY_POLYNOMIAL);
+    assert(verdict.degree == 1);
+    assert(rift_ambiguity_is_dangerous(&verdict));
+
+    nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    s0 = rift_automaton_create_state(nfa, false);
+    s1 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s2 = rift_automaton_create_state(nfa, true);
+    assert(rift_automaton_add_transition(nfa, s0, s0, "a"));
+    assert(rift_automaton_create_epsilon_transition(nfa, s0, s1));
+    assert(rift_automaton_add_transition(nfa, s1, s1, "a"));
+    assert(rift_automaton_create_epsilon_transition(nfa, s1, s2));
+    assert(rift_automaton_add_transition(nfa, s2, s2, "a"));
+
+    verdict = analyze(nfa);
+    assert(verdict.ambiguity == RIFT_AMBIGUITY_POLYNOMIAL);
+    assert(verdict.degree == 2);
+
+    printf("test_ambiguity_polynomial: PASSED\n");
+}
+
+/* Test that (a|a)* and (a+)+ are exponential while (ab+)+ is not */
+void
+test_ambiguity_exponential(void)
+{
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *s0 = rift_automaton_create_state(nfa, true);
+    rift_regex_state_t *s1 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s2 = rift_automaton_create_state(nfa, false);
+    assert(rift_automaton_create_epsilon_transition(nfa, s0, s1));
+    assert(rift_automaton_create_epsilon_transition(nfa, s0, s2));
+    assert(rift_automaton_add_transition(nfa, s1, s0, "a"));
+    assert(rift_automaton_add_transition(nfa, s2, s0, "a"));
+
+    rift_ambiguity_verdict_t verdict = analyze(nfa);
+    assert(verdict.ambiguity == RIFT_AMBIGUITY_EXPONENTIAL);
+    assert(strcmp(rift_ambiguity_to_string(verdict.ambiguity), "exponential") == 0);
+
+    /* (a+)+: the inner and outer loops both return to the start */
+    nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    s0 = rift_automaton_create_state(nfa, false);
+    s1 = rift_automaton_create_state(nfa, false);
+    s2 = rift_automaton_create_state(nfa, true);
+    assert(rift_automaton_add_transition(nfa, s0, s1, "a"));
+    assert(rift_automaton_create_epsilon_transition(nfa, s1, s0));
+    assert(rift_automaton_create_epsilon_transition(nfa, s1, s2));
+    assert(rift_automaton_create_epsilon_transition(nfa, s2, s0));
+
+    verdict = analyze(nfa);
+    assert(verdict.ambiguity == RIFT_AMBIGUITY_EXPONENTIAL);
+
+    /* (ab+)+ nests quantifiers but every word has one parse */
+    nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    s0 = rift_automaton_create_state(nfa, false);
+    s1 = rift_automaton_create_state(nfa, false);
+    s2 = rift_automaton_create_state(nfa, true);
+    assert(rift_automaton_add_transition(nfa, s0, s1, "a"));
+    assert(rift_automaton_add_transition(nfa, s1, s2, "b"));
+    assert(rift_automaton_create_epsilon_transition(nfa, s2, s1));
+    assert(rift_automaton_create_epsilon_transition(nfa, s2, s0));
+
+    verdict = analyze(nfa);
+    assert(verdict.ambiguity == RIFT_AMBIGUITY_FINITE);
+
+    printf("test_ambiguity_exponential: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running ambiguity analysis tests...\n");
+
+    test_ambiguity_finite();
+    test_ambiguity_polynomial();
+    test_ambiguity_exponential();
+
+    printf("All ambiguity analysis tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,232 @@
+/**
+ * @file auto_possessify_test.c
+ * @brief Unit tests for automatic quantifier possessification in the LibRift regex engine
+ *
+ * This file contains test cases verifying which quantifiers of a pattern AST
+ * are made possessive: those whose repeated bytes cannot start what follows
+ * them, or that end the pattern, and none whose flags or mode forbid it.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "core/compiler/auto_possessify.h"
+#include "core/parser/ast.h"
+
+/* Create a node with an optional value and children */
+static rift_regex_ast_node_t *
+node(rift_regex_ast_node_type_t type, const char *value, rift_regex_ast_node_t *first,
+     rift_regex_ast_node_t *second, rift_regex_ast_node_t *third)
+{
+    rift_regex_ast_node_t *result = rift_regex_ast_node_create(type);
+    assert(result != NULL);
+    if (value) {
+        assert(rift_regex_ast_node_set_value(result, value));
+    }
+
+    rift_regex_ast_node_t *children[] = {first, second, third};
+    for (size_t i = 0; i < 3; i++) {
+        if (children[i]) {
+            assert(rift_regex_ast_node_add_child(result, children[i]));
+        }
+    }
+    return result;
+}
+
+static rift_regex_ast_node_t *
+literal(const char *value)
+{
+    return node(RIFT_REGEX_AST_NODE_LITERAL, value, NULL, NULL, NULL);
+}
+
+static rift_regex_ast_node_t *
+char_class(const char *value)
+{
+    return node(RIFT_REGEX_AST_NODE_CHARACTER_CLASS, value, NULL, NULL, NULL);
+}
+
+static rift_regex_ast_node_t *
+quantifier(const char *value, rift_regex_ast_node_t *child)
+{
+    return node(RIFT_REGEX_AST_NODE_QUANTIFIER, value, child, NULL, NULL);
+}
+
+/* Put a tree under a root node of a new AST */
+static rift_regex_ast_t *
+create_ast(rift_regex_ast_node_t *tree, rift_regex_flags_t flags)
+{
+    rift_regex_ast_t *ast = rift_regex_ast_create();
+    assert(ast != NULL);
+    ast->flags = flags;
+    assert(rift_regex_ast_set_root(ast, node(RIFT_REGEX_AST_NODE_ROOT, NULL, tree, NULL, NULL)));
+    return ast;
+}
+
+static const char *
+value_of(const rift_regex_ast_node_t *quantifier_node)
+{
+    return rift_regex_ast_get_node_value(quantifier_node);
+}
+
+/* Test that a loop disjoint from what follows becomes possessive */
+void
+test_auto_possessify_disjoint(void)
+{
+    /* [0-9]+[a-z] */
+    rift_regex_ast_node_t *digits = quantifier("+", char_class("[0-9]"));
+    rift_regex_ast_node_t *tree =
+        node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL, digits, char_class("[a-z]"), NULL);
+
+    rift_regex_ast_t *ast = create_ast(tree, RIFT_REGEX_FLAG_NONE);
+    assert(rift_regex_auto_possessify(ast, RIFT_REGEX_FLAG_NONE) == 1);
+    assert(strcmp(value_of(digits), "++") == 0);
+    rift_regex_ast_free(ast);
+
+    /* a*b: the literal that follows starts with another byte */
+    rift_regex_ast_node_t *as = quantifier("*", literal("a"));
+    tree = node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL, as, literal("bc"), NULL);
+
+    ast = create_ast(tree, RIFT_REGEX_FLAG_NONE);
+    assert(rift_regex_auto_possessify(ast, RIFT_REGEX_FLAG_NONE) == 1);
+    assert(strcmp(value_of(as), "*+") == 0);
+    rift_regex_ast_free(ast);
+
+    printf("test_auto_possessify_disjoint: PASSED\n");
+}
+
+/* Test that a loop that may give a byte back to what follows is left alone */
+void
+test_auto_possessify_overlap(void)
+{
+    /* [a-z]*a */
+    rift_regex_ast_node_t *letters = quantifier("*", char_class("[a-z]"));
+    rift_regex_ast_node_t *tree =
+        node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL, letters, literal("a"), NULL);
+
+    rift_regex_ast_t *ast = create_ast(tree, RIFT_REGEX_FLAG_NONE);
+    assert(rift_regex_auto_possessify(ast, RIFT_REGEX_FLAG_NONE) == 0);
+    assert(strcmp(value_of(letters), "*") == 0);
+    rift_regex_ast_free(ast);
+
+    /* .*x */
+    rift_regex_ast_node_t *any =
+        quantifier("*", node(RIFT_REGEX_AST_NODE_DOT, NULL, NULL, NULL, NULL));
+    tree = node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL, any, literal("x"), NULL);
+
+    ast = create_ast(tree, RIFT_REGEX_FLAG_NONE);
+    assert(rift_regex_auto_possessify(ast, RIFT_REGEX_FLAG_NONE) == 0);
+    rift_regex_ast_free(ast);
+
+    /* a+b?a: what follows may start with the optional b or with a; b? itself may go */
+    rift_regex_ast_node_t *as = quantifier("+", literal("a"));
+    tree = node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL, as, quantifier("?", literal("b")),
+                literal("a"));
+
+    ast = create_ast(tree, RIFT_REGEX_FLAG_NONE);
+    assert(rift_regex_auto_possessify(ast, RIFT_REGEX_FLAG_NONE) == 1);
+    assert(strcmp(value_of(as), "+") == 0);
+    rift_regex_ast_free(ast);
+
+    printf("test_auto_possessify_overlap: PASSED\n");
+}
+
+/* Test that the first bytes of groups and alternations are looked through */
+void
+test_auto_possessify_structure(void)
+{
+    /* a{2,}(b|c) */
+    rift_regex_ast_node_t *as = quantifier("{2,}", literal("a"));
+    rift_regex_ast_node_t *alternation =
+        node(RIFT_REGEX_AST_NODE_ALTERNATION, NULL, literal("b"), literal("c"), NULL);
+    rift_regex_ast_node_t *tree = node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL, as,
+                                       node(RIFT_REGEX_AST_NODE_GROUP, NULL, alternation,
+                                            NULL, NULL),
+                                       NULL);
+
+    rift_regex_ast_t *ast = create_ast(tree, RIFT_REGEX_FLAG_NONE);
+    assert(rift_regex_auto_possessify(ast, RIFT_REGEX_FLAG_NONE) == 1);
+    assert(strcmp(value_of(as), "{2,}+") == 0);
+    rift_regex_ast_free(ast);
+
+    /* a+(b|a) */
+    as = quantifier("+", literal("a"));
+    alternation = node(RIFT_REGEX_AST_NODE_ALTERNATION, NULL, literal("b"), literal("a"), NULL);
+    tree = node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL, as,
+                node(RIFT_REGEX_AST_NODE_GROUP, NULL, alternation, NULL, NULL), NULL);
+
+    ast = create_ast(tree, RIFT_REGEX_FLAG_NONE);
+    assert(rift_regex_auto_possessify(ast, RIFT_REGEX_FLAG_NONE) == 0);
+    rift_regex_ast_free(ast);
+
+    /* x[0-9]+ ends the pattern, so nothing can take a digit back */
+    rift_regex_ast_node_t *digits = quantifier("+", char_class("[0-9]"));
+    tree = node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL, literal("x"), digits, NULL);
+
+    ast = create_ast(tree, RIFT_REGEX_FLAG_NONE);
+    assert(rift_regex_auto_possessify(ast, RIFT_REGEX_FLAG_NONE) == 1);
+    assert(strcmp(value_of(digits), "++") == 0);
+    rift_regex_ast_free(ast);
+
+    /* (a+)* repeats a group, so what follows a+ is a+ itself */
+    as = quantifier("+", literal("a"));
+    tree = quantifier("*", node(RIFT_REGEX_AST_NODE_GROUP, NULL, as, NULL, NULL));
+
+    ast = create_ast(tree, RIFT_REGEX_FLAG_NONE);
+    assert(rift_regex_auto_possessify(ast, RIFT_REGEX_FLAG_NONE) == 0);
+    rift_regex_ast_free(ast);
+
+    printf("test_auto_possessify_structure: PASSED\n");
+}
+
+/* Test that flags and quantifier modes turn the pass off */
+void
+test_auto_possessify_disabled(void)
+{
+    const rift_regex_flags_t disabling[] = {
+        RIFT_REGEX_FLAG_NO_AUTO_POSSESS, RIFT_REGEX_FLAG_CASE_INSENSITIVE,
+        RIFT_REGEX_FLAG_EXTENDED, RIFT_REGEX_FLAG_UNGREEDY};
+
+    for (size_t i = 0; i < sizeof(disabling) / sizeof(disabling[0]); i++) {
+        rift_regex_ast_node_t *as = quantifier("+", literal("a"));
+        rift_regex_ast_node_t *tree =
+            node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL, as, literal("b"), NULL);
+
+        rift_regex_ast_t *ast = create_ast(tree, disabling[i]);
+        assert(rift_regex_auto_possessify(ast, disabling[i]) == 0);
+        assert(strcmp(value_of(as), "+") == 0);
+        rift_regex_ast_free(ast);
+    }
+
+    /* Lazy and already possessive quantifiers are kept as written */
+    const char *kept[] = {"+?", "++", "{1,3}?"};
+    for (size_t i = 0; i < sizeof(kept) / sizeof(kept[0]); i++) {
+        rift_regex_ast_node_t *as = quantifier(kept[i], literal("a"));
+        rift_regex_ast_node_t *tree =
+            node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL, as, literal("b"), NULL);
+
+        rift_regex_ast_t *ast = create_ast(tree, RIFT_REGEX_FLAG_NONE);
+        assert(rift_regex_auto_possessify(ast, RIFT_REGEX_FLAG_NONE) == 0);
+        assert(strcmp(value_of(as), kept[i]) == 0);
+        rift_regex_ast_free(ast);
+    }
+
+    printf("test_auto_possessify_disabled: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running auto-possessify tests...\n");
+
+    test_auto_possessify_disjoint();
+    test_auto_possessify_overlap();
+    test_auto_possessify_structure();
+    test_auto_possessify_disabled();
+
+    printf("All auto-possessify tests PASSED!\n");
+    return 0;
+}
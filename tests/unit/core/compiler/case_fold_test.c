@@ -0,0 +1,106 @@
+/**
+ * @file case_fold_test.c
+ * @brief Unit tests for compile-time case folding in the LibRift regex engine
+ *
+ * This file contains test cases verifying that transition patterns and code
+ * point sets are widened to both cases of their letters, with negated
+ * classes folded before they are negated.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "core/automaton/byte_class.h"
+#include "core/automaton/transition.h"
+#include "core/compiler/case_fold.h"
+
+/* Check whether a pattern accepts a byte */
+static bool
+accepts(const char *pattern, unsigned char byte)
+{
+    rift_transition_predicate_t predicate;
+    assert(rift_transition_predicate_parse(pattern, &predicate));
+    return (predicate.bitmap[byte / 64] >> (byte % 64)) & 1;
+}
+
+/* Test folding of single code points */
+void
+test_case_fold_other(void)
+{
+    assert(rift_case_fold_other('a') == 'A');
+    assert(rift_case_fold_other('Z') == 'z');
+    assert(rift_case_fold_other('1') == '1');
+    assert(rift_case_fold_other(0xE9) == 0xC9);   /* e acute */
+    assert(rift_case_fold_other(0xD7) == 0xD7);   /* multiplication sign */
+    assert(rift_case_fold_other(0x3A3) == 0x3C3); /* sigma */
+    assert(rift_case_fold_other(0x451) == 0x401); /* io */
+
+    printf("test_case_fold_other: PASSED\n");
+}
+
+/* Test folding of byte transition patterns */
+void
+test_case_fold_pattern(void)
+{
+    char folded[RIFT_BYTE_CLASS_MAX_PATTERN_LENGTH];
+
+    assert(rift_case_fold_pattern("k", folded, sizeof(folded)));
+    assert(accepts(folded, 'k') && accepts(folded, 'K') && !accepts(folded, 'j'));
+
+    assert(rift_case_fold_pattern("[a-c0-9]", folded, sizeof(folded)));
+    assert(accepts(folded, 'B') && accepts(folded, 'b') && accepts(folded, '5'));
+    assert(!accepts(folded, 'D'));
+
+    /* [^a] must exclude both cases */
+    assert(rift_case_fold_pattern("[^a]", folded, sizeof(folded)));
+    assert(!accepts(folded, 'a') && !accepts(folded, 'A') && accepts(folded, 'b'));
+
+    /* Nothing to fold */
+    assert(!rift_case_fold_pattern("[0-9]", folded, sizeof(folded)));
+    assert(!rift_case_fold_pattern("[a-zA-Z]", folded, sizeof(folded)));
+    assert(!rift_case_fold_pattern("\\.", folded, sizeof(folded)));
+
+    printf("test_case_fold_pattern: PASSED\n");
+}
+
+/* Test folding of code point sets */
+void
+test_case_fold_range_set(void)
+{
+    rift_utf8_range_set_t set = {NULL, 0, 0};
+
+    assert(rift_utf8_range_set_add(&set, 'x', 0xE9));
+    assert(rift_case_fold_range_set(&set));
+    assert(set.count == 3);
+    assert(set.ranges[0].start == 'X' && set.ranges[0].end == 'Z');
+    assert(set.ranges[1].start == 'x' && set.ranges[1].end == 0xF6);
+    assert(set.ranges[2].start == 0xF8 && set.ranges[2].end == 0xFE);
+    rift_utf8_range_set_clear(&set);
+
+    /* A negated UTF-8 class is folded first */
+    assert(rift_utf8_parse_class("[^é]", true, &set));
+    for (size_t i = 0; i < set.count; i++) {
+        assert(!(set.ranges[i].start <= 0xC9 && set.ranges[i].end >= 0xC9));
+        assert(!(set.ranges[i].start <= 0xE9 && set.ranges[i].end >= 0xE9));
+    }
+    rift_utf8_range_set_clear(&set);
+
+    printf("test_case_fold_range_set: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running case folding tests...\n");
+
+    test_case_fold_other();
+    test_case_fold_pattern();
+    test_case_fold_range_set();
+
+    printf("All case folding tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,223 @@
+/**
+ * @file engine_plan_test.c
+ * @brief Unit tests for compile-time engine selection
+ *
+ * This file contains test cases verifying that hand-built NFAs are given the
+ * engine a default search would reach, and that engines the pattern rules
+ * out are recorded as unusable with a reason.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/automaton/automaton.h"
+#include "core/automaton/state.h"
+#include "core/compiler/ambiguity.h"
+#include "core/compiler/compiler.h"
+#include "core/compiler/engine_plan.h"
+#include "core/config/config.h"
+
+/* Build an NFA for the literal ab */
+static rift_regex_automaton_t *
+create_literal(void)
+{
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *s0 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s1 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s2 = rift_automaton_create_state(nfa, true);
+    assert(rift_automaton_add_transition(nfa, s0, s1, "a"));
+    assert(rift_automaton_add_transition(nfa, s1, s2, "b"));
+    return nfa;
+}
+
+/* Build an NFA for (a)*a, which is not one-pass: an a may stay in the loop or leave it */
+static rift_regex_automaton_t *
+create_ambiguous_group(void)
+{
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *s0 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *open = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *close = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s1 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s2 = rift_automaton_create_state(nfa, true);
+    assert(rift_state_set_group_start(open, true));
+    assert(rift_state_set_group_end(close, true));
+    assert(rift_automaton_create_epsilon_transition(nfa, s0, open));
+    assert(rift_automaton_add_transition(nfa, open, close, "a"));
+    assert(rift_automaton_create_epsilon_transition(nfa, close, s0));
+    assert(rift_automaton_create_epsilon_transition(nfa, s0, s1));
+    assert(rift_automaton_add_transition(nfa, s1, s2, "a"));
+    return nfa;
+}
+
+/* Plan an automaton with the lazy DFA preferred by the configuration or not, and free it */
+static rift_engine_plan_t
+plan(rift_regex_automaton_t *nfa, size_t group_count, const rift_ambiguity_verdict_t *verdict,
+     bool use_dfa)
+{
+    rift_regex_error_t error = {0};
+    rift_engine_plan_t result;
+    assert(rift_config_set_regex_param(RIFT_REGEX_PARAM_USE_DFA_WHEN_POSSIBLE, &use_dfa) ==
+           RIFT_OK);
+    assert(rift_engine_plan_build(nfa, group_count, verdict, &result, &error));
+    rift_automaton_free(nfa);
+    return result;
+}
+
+/* Test that capture-free patterns go to the DFA or the bit-parallel NFA */
+void
+test_engine_plan_capture_free(void)
+{
+    rift_ambiguity_verdict_t verdict;
+    rift_ambiguity_verdict_init(&verdict);
+
+    rift_engine_plan_t result = plan(create_literal(), 0, &verdict, true);
+    assert(result.planned);
+    assert(result.engine == RIFT_MATCH_ENGINE_LAZY_DFA);
+    assert(result.num_states == 3);
+
+    result = plan(create_literal(), 0, &verdict, false);
+    assert(result.engine == RIFT_MATCH_ENGINE_BIT_PARALLEL);
+    assert(result.bit_parallel_positions == 2);
+    assert(rift_engine_plan_allows(&result, RIFT_MATCH_ENGINE_LAZY_DFA));
+    assert(rift_engine_plan_allows(&result, RIFT_MATCH_ENGINE_ONE_PASS));
+    assert(rift_engine_plan_allows(&result, RIFT_MATCH_ENGINE_PIKE_VM));
+    assert(!rift_engine_plan_allows(&result, RIFT_MATCH_ENGINE_BYTECODE_VM));
+
+    /* Ambiguous patterns take the DFA whatever the configuration says */
+    verdict.ambiguity = RIFT_AMBIGUITY_EXPONENTIAL;
+    result = plan(create_literal(), 0, &verdict, false);
+    assert(result.engine == RIFT_MATCH_ENGINE_LAZY_DFA);
+
+    printf("test_engine_plan_capture_free: PASSED\n");
+}
+
+/* Test that patterns with groups skip the engines reporting bounds only */
+void
+test_engine_plan_groups(void)
+{
+    rift_engine_plan_t result = plan(create_literal(), 1, NULL, true);
+    assert(result.engine == RIFT_MATCH_ENGINE_ONE_PASS);
+    assert(!rift_engine_plan_allows(&result, RIFT_MATCH_ENGINE_LAZY_DFA));
+    assert(!rift_engine_plan_allows(&result, RIFT_MATCH_ENGINE_BIT_PARALLEL));
+    assert(strlen(rift_engine_plan_get_reason(&result, RIFT_MATCH_ENGINE_LAZY_DFA)) > 0);
+
+    /* The one-pass check fails and leaves the tagged DFA */
+    result = plan(create_ambiguous_group(), 1, NULL, true);
+    assert(!rift_engine_plan_allows(&result, RIFT_MATCH_ENGINE_ONE_PASS));
+    assert(strcmp(rift_engine_plan_get_reason(&result, RIFT_MATCH_ENGINE_ONE_PASS),
+                  "Automaton is not one-pass") == 0);
+    assert(result.engine == RIFT_MATCH_ENGINE_TDFA);
+
+    printf("test_engine_plan_groups: PASSED\n");
+}
+
+/* Test that backreferences leave only the backtracker */
+void
+test_engine_plan_backreference(void)
+{
+    rift_ambiguity_verdict_t verdict;
+    rift_ambiguity_verdict_init(&verdict);
+    verdict.has_backreference = true;
+
+    rift_engine_plan_t result = plan(create_literal(), 1, &verdict, true);
+    assert(result.engine == RIFT_MATCH_ENGINE_BACKTRACKER);
+    for (int engine = 0; engine < RIFT_MATCH_ENGINE_COUNT; engine++) {
+        assert(rift_engine_plan_allows(&result, (rift_match_engine_t)engine) ==
+               (engine == RIFT_MATCH_ENGINE_BACKTRACKER));
+    }
+
+    printf("test_engine_plan_backreference: PASSED\n");
+}
+
+/* Test that plans never built allow every engine */
+void
+test_engine_plan_unplanned(void)
+{
+    rift_regex_error_t error = {0};
+    rift_engine_plan_t result;
+    rift_engine_plan_init(&result);
+    assert(!result.planned);
+    assert(result.engine == RIFT_MATCH_ENGINE_NONE);
+    assert(rift_engine_plan_allows(&result, RIFT_MATCH_ENGINE_BIT_PARALLEL));
+    assert(rift_engine_plan_allows(NULL, RIFT_MATCH_ENGINE_ONE_PASS));
+
+    assert(!rift_engine_plan_build(NULL, 0, NULL, &result, &error));
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_PARAMETER);
+    assert(!result.planned);
+
+    printf("test_engine_plan_unplanned: PASSED\n");
+}
+
+/* Choose the search strategy of a pattern whose literals are a required suffix */
+static rift_search_strategy_t
+choose_with_suffix(const char *pattern, const char *suffix)
+{
+    rift_regex_automaton_t *automaton = rift_regex_compile_pattern(pattern, 0, NULL);
+    assert(automaton != NULL);
+    rift_prefilter_t prefilter;
+    memset(&prefilter, 0, sizeof(prefilter));
+    prefilter.suffix.length = strlen(suffix);
+    memcpy(prefilter.suffix.bytes, suffix, prefilter.suffix.length);
+    prefilter.required[0] = prefilter.suffix;
+    prefilter.num_required = 1;
+    prefilter.num_first_bytes = 256;
+
+    rift_engine_plan_t result;
+    rift_engine_plan_init(&result);
+    rift_engine_plan_choose_search(&result, automaton, &prefilter);
+    assert(result.search_reason[0] != '\0');
+    rift_automaton_free(automaton);
+    return result.search;
+}
+
+/* Test that a suffix is searched for only when matches contain it at their end alone */
+void
+test_engine_plan_search(void)
+{
+    assert(choose_with_suffix("[a-z]+@example", "@example") == RIFT_SEARCH_REVERSE_SUFFIX);
+    assert(choose_with_suffix("x*ms", "ms") == RIFT_SEARCH_REVERSE_SUFFIX);
+
+    // Both a.*Xc and [a-z]+ab can read their suffix before reaching their end
+    assert(choose_with_suffix("a.*Xc", "Xc") == RIFT_SEARCH_INNER_LITERAL);
+    assert(choose_with_suffix("[a-z]+ab", "ab") == RIFT_SEARCH_INNER_LITERAL);
+
+    // A prefix already leads the forward scan, and nothing is known without literals
+    rift_regex_automaton_t *automaton = create_literal();
+    rift_prefilter_t prefilter;
+    memset(&prefilter, 0, sizeof(prefilter));
+    prefilter.prefix.length = 2;
+    memcpy(prefilter.prefix.bytes, "ab", 2);
+    prefilter.suffix = prefilter.prefix;
+    prefilter.num_first_bytes = 256;
+    rift_engine_plan_t result;
+    rift_engine_plan_init(&result);
+    assert(result.search == RIFT_SEARCH_FORWARD);
+    assert(!rift_engine_plan_choose_search(&result, automaton, &prefilter));
+    assert(result.search == RIFT_SEARCH_FORWARD);
+    assert(!rift_engine_plan_choose_search(&result, automaton, NULL));
+    assert(strcmp(rift_search_strategy_name(RIFT_SEARCH_REVERSE_SUFFIX), "reverse-suffix") == 0);
+    rift_automaton_free(automaton);
+
+    printf("test_engine_plan_search: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running engine plan tests...\n");
+
+    test_engine_plan_capture_free();
+    test_engine_plan_groups();
+    test_engine_plan_backreference();
+    test_engine_plan_unplanned();
+    test_engine_plan_search();
+
+    printf("All engine plan tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file group_names_test.c
+ * @brief Unit tests for the named capture group table of the LibRift regex engine
+ *
+ * This file contains test cases verifying that group names resolve to the
+ * indices backreferences use, that reused names keep their first group, and
+ * that tables with many names and without any answer lookups correctly.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "core/compiler/group_names.h"
+#include "core/parser/ast.h"
+
+/* Create a node with an optional value and children */
+static rift_regex_ast_node_t *
+node(rift_regex_ast_node_type_t type, const char *value, rift_regex_ast_node_t *first,
+     rift_regex_ast_node_t *second)
+{
+    rift_regex_ast_node_t *result = rift_regex_ast_node_create(type);
+    assert(result != NULL);
+    if (value) {
+        assert(rift_regex_ast_node_set_value(result, value));
+    }
+
+    rift_regex_ast_node_t *children[] = {first, second};
+    for (size_t i = 0; i < 2; i++) {
+        if (children[i]) {
+            assert(rift_regex_ast_node_add_child(result, children[i]));
+        }
+    }
+    return result;
+}
+
+static rift_regex_ast_node_t *
+literal(const char *value)
+{
+    return node(RIFT_REGEX_AST_NODE_LITERAL, value, NULL, NULL);
+}
+
+/* Build the table of a tree under a root node */
+static rift_group_names_t *
+build(rift_regex_ast_node_t *tree)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_ast_t *ast = rift_regex_ast_create();
+    assert(ast != NULL);
+    assert(rift_regex_ast_set_root(ast, node(RIFT_REGEX_AST_NODE_ROOT, NULL, tree, NULL)));
+
+    /* The table keeps its own copy of the names */
+    rift_group_names_t *names = rift_group_names_build(ast, &error);
+    assert(names != NULL);
+    rift_regex_ast_free(ast);
+    return names;
+}
+
+/* Test that names map to the numbers of their opening parentheses */
+void
+test_group_names_indices(void)
+{
+    /* (?<year>a)((?<month>b)(c))(?<day>d) */
+    rift_regex_ast_node_t *tree = node(
+        RIFT_REGEX_AST_NODE_CONCATENATION,
+        NULL,
+        node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL,
+             node(RIFT_REGEX_AST_NODE_NAMED_GROUP, "year", literal("a"), NULL),
+             node(RIFT_REGEX_AST_NODE_GROUP, NULL,
+                  node(RIFT_REGEX_AST_NODE_NAMED_GROUP, "month", literal("b"), NULL),
+                  node(RIFT_REGEX_AST_NODE_GROUP, NULL, literal("c"), NULL))),
+        node(RIFT_REGEX_AST_NODE_NAMED_GROUP, "day", literal("d"), NULL));
+
+    rift_group_names_t *names = build(tree);
+    assert(names->count == 3);
+    assert(rift_group_names_lookup(names, "year") == 1);
+    assert(rift_group_names_lookup(names, "month") == 3);
+    assert(rift_group_names_lookup(names, "day") == 5);
+    assert(rift_group_names_lookup(names, "hour") == RIFT_GROUP_NO_INDEX);
+    assert(rift_group_names_lookup(names, "") == RIFT_GROUP_NO_INDEX);
+    assert(rift_group_names_lookup(names, NULL) == RIFT_GROUP_NO_INDEX);
+
+    rift_group_names_free(names);
+    printf("test_group_names_indices: PASSED\n");
+}
+
+/* Test that a reused name stays with its first group */
+void
+test_group_names_duplicate(void)
+{
+    /* (?<x>a)|(?<x>b) */
+    rift_regex_ast_node_t *tree =
+        node(RIFT_REGEX_AST_NODE_ALTERNATION, NULL,
+             node(RIFT_REGEX_AST_NODE_NAMED_GROUP, "x", literal("a"), NULL),
+             node(RIFT_REGEX_AST_NODE_NAMED_GROUP, "x", literal("b"), NULL));
+
+    rift_group_names_t *names = build(tree);
+    assert(names->count == 1);
+    assert(rift_group_names_lookup(names, "x") == 1);
+
+    rift_group_names_free(names);
+    printf("test_group_names_duplicate: PASSED\n");
+}
+
+/* Test tables with many names and with none */
+void
+test_group_names_sizes(void)
+{
+    /* Chain 40 named groups, each nested in the previous one */
+    char name[16];
+    rift_regex_ast_node_t *tree = literal("z");
+    for (int i = 40; i >= 1; i--) {
+        snprintf(name, sizeof(name), "field%d", i);
+        tree = node(RIFT_REGEX_AST_NODE_NAMED_GROUP, name, tree, NULL);
+    }
+
+    rift_group_names_t *names = build(tree);
+    assert(names->count == 40);
+    assert(names->capacity >= 80);
+    for (int i = 1; i <= 40; i++) {
+        snprintf(name, sizeof(name), "field%d", i);
+        assert(rift_group_names_lookup(names, name) == (size_t)i);
+    }
+    assert(rift_group_names_lookup(names, "field41") == RIFT_GROUP_NO_INDEX);
+    rift_group_names_free(names);
+
+    names = build(node(RIFT_REGEX_AST_NODE_GROUP, NULL, literal("a"), NULL));
+    assert(names->count == 0);
+    assert(rift_group_names_lookup(names, "a") == RIFT_GROUP_NO_INDEX);
+    rift_group_names_free(names);
+
+    assert(rift_group_names_lookup(NULL, "a") == RIFT_GROUP_NO_INDEX);
+    assert(rift_group_names_build(NULL, NULL) == NULL);
+    rift_group_names_free(NULL);
+    printf("test_group_names_sizes: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running group name tests...\n");
+
+    test_group_names_indices();
+    test_group_names_duplicate();
+    test_group_names_sizes();
+
+    printf("All group name tests PASSED!\n");
+    return 0;
+}
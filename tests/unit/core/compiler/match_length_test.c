@@ -0,0 +1,176 @@
+/**
+ * @file match_length_test.c
+ * @brief Unit tests for the static match-length bounds of the LibRift regex engine
+ *
+ * This file contains test cases verifying the bounds of fixed-width and
+ * bounded patterns, that unbounded quantifiers and backreferences leave the
+ * maximum open, and that UTF-8 mode widens the bytes a character can take.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "core/compiler/match_length.h"
+#include "core/parser/ast.h"
+
+/* Create a node with an optional value and children */
+static rift_regex_ast_node_t *
+node(rift_regex_ast_node_type_t type, const char *value, rift_regex_ast_node_t *first,
+     rift_regex_ast_node_t *second)
+{
+    rift_regex_ast_node_t *result = rift_regex_ast_node_create(type);
+    assert(result != NULL);
+    if (value) {
+        assert(rift_regex_ast_node_set_value(result, value));
+    }
+
+    rift_regex_ast_node_t *children[] = {first, second};
+    for (size_t i = 0; i < 2; i++) {
+        if (children[i]) {
+            assert(rift_regex_ast_node_add_child(result, children[i]));
+        }
+    }
+    return result;
+}
+
+static rift_regex_ast_node_t *
+literal(const char *value)
+{
+    return node(RIFT_REGEX_AST_NODE_LITERAL, value, NULL, NULL);
+}
+
+static rift_regex_ast_node_t *
+repeat(const char *quantifier, rift_regex_ast_node_t *body)
+{
+    return node(RIFT_REGEX_AST_NODE_QUANTIFIER, quantifier, body, NULL);
+}
+
+static rift_regex_ast_node_t *
+digit(void)
+{
+    return node(RIFT_REGEX_AST_NODE_CHARACTER_CLASS, "[0-9]", NULL, NULL);
+}
+
+/* Analyze a tree under a root node */
+static rift_match_length_bounds_t
+analyze(rift_regex_ast_node_t *tree, rift_regex_flags_t flags)
+{
+    rift_regex_ast_t *ast = rift_regex_ast_create();
+    assert(ast != NULL);
+    assert(rift_regex_ast_set_root(ast, node(RIFT_REGEX_AST_NODE_ROOT, NULL, tree, NULL)));
+
+    rift_match_length_bounds_t bounds;
+    assert(rift_match_length_analyze(ast, flags, &bounds));
+    rift_regex_ast_free(ast);
+    return bounds;
+}
+
+/* Test fixed-width and bounded patterns */
+void
+test_match_length_bounded(void)
+{
+    /* \d{4}-\d{2}: a fixed-width date prefix */
+    rift_match_length_bounds_t bounds =
+        analyze(node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL, repeat("{4}", digit()),
+                     node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL, literal("-"),
+                          repeat("{2}", digit()))),
+                RIFT_REGEX_FLAG_NONE);
+    assert(bounds.min == 7 && bounds.max == 7);
+    assert(rift_match_length_is_bounded(&bounds));
+
+    /* (?:id|ident)[0-9]{2,5}?, with an anchor consuming nothing */
+    bounds = analyze(node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL,
+                          node(RIFT_REGEX_AST_NODE_ANCHOR, "^", NULL, NULL),
+                          node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL,
+                               node(RIFT_REGEX_AST_NODE_NON_CAPTURING_GROUP, NULL,
+                                    node(RIFT_REGEX_AST_NODE_ALTERNATION, NULL, literal("id"),
+                                         literal("ident")),
+                                    NULL),
+                               repeat("{2,5}?", digit()))),
+                     RIFT_REGEX_FLAG_NONE);
+    assert(bounds.min == 4 && bounds.max == 10);
+
+    /* An optional group may be skipped */
+    bounds = analyze(repeat("?", literal("abc")), RIFT_REGEX_FLAG_NONE);
+    assert(bounds.min == 0 && bounds.max == 3);
+
+    printf("test_match_length_bounded: PASSED\n");
+}
+
+/* Test patterns whose matches can be arbitrarily long */
+void
+test_match_length_unbounded(void)
+{
+    rift_match_length_bounds_t bounds =
+        analyze(node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL, literal("ab"),
+                     repeat("+", digit())),
+                RIFT_REGEX_FLAG_NONE);
+    assert(bounds.min == 3 && bounds.max == RIFT_MATCH_LENGTH_UNBOUNDED);
+    assert(!rift_match_length_is_bounded(&bounds));
+
+    /* {2,} has no upper bound, but repeating nothing stays empty */
+    bounds = analyze(repeat("{2,}", literal("x")), RIFT_REGEX_FLAG_NONE);
+    assert(bounds.min == 2 && !rift_match_length_is_bounded(&bounds));
+    bounds = analyze(repeat("*", node(RIFT_REGEX_AST_NODE_ANCHOR, "$", NULL, NULL)),
+                     RIFT_REGEX_FLAG_NONE);
+    assert(bounds.min == 0 && bounds.max == 0);
+
+    /* A backreference can repeat a group of any length */
+    bounds = analyze(node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL,
+                          node(RIFT_REGEX_AST_NODE_GROUP, NULL, literal("ab"), NULL),
+                          node(RIFT_REGEX_AST_NODE_BACKREFERENCE, "1", NULL, NULL)),
+                     RIFT_REGEX_FLAG_NONE);
+    assert(bounds.min == 2 && !rift_match_length_is_bounded(&bounds));
+
+    /* Repetition counts too large to multiply saturate */
+    rift_regex_ast_node_t *huge = literal("abcd");
+    for (int i = 0; i < 4; i++) {
+        huge = repeat("{1000000}", huge);
+    }
+    bounds = analyze(huge, RIFT_REGEX_FLAG_NONE);
+    assert(bounds.min == RIFT_MATCH_LENGTH_UNBOUNDED && !rift_match_length_is_bounded(&bounds));
+
+    printf("test_match_length_unbounded: PASSED\n");
+}
+
+/* Test the bytes characters take in UTF-8 mode */
+void
+test_match_length_utf8(void)
+{
+    rift_match_length_bounds_t bounds =
+        analyze(node(RIFT_REGEX_AST_NODE_DOT, NULL, NULL, NULL), RIFT_REGEX_FLAG_NONE);
+    assert(bounds.min == 1 && bounds.max == 1);
+    bounds = analyze(node(RIFT_REGEX_AST_NODE_DOT, NULL, NULL, NULL), RIFT_REGEX_FLAG_UTF8);
+    assert(bounds.min == 1 && bounds.max == 4);
+
+    /* A class of ASCII members stays one byte wide */
+    bounds = analyze(repeat("{3}", digit()), RIFT_REGEX_FLAG_UTF8);
+    assert(bounds.min == 3 && bounds.max == 3);
+
+    /* A literal takes its encoded length */
+    bounds = analyze(literal("\xc3\xa9t\xc3\xa9"), RIFT_REGEX_FLAG_UTF8);
+    assert(bounds.min == 5 && bounds.max == 5);
+
+    /* Without an AST nothing is known */
+    assert(!rift_match_length_analyze(NULL, RIFT_REGEX_FLAG_NONE, &bounds));
+    assert(bounds.min == 0 && !rift_match_length_is_bounded(&bounds));
+
+    printf("test_match_length_utf8: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running match length tests...\n");
+
+    test_match_length_bounded();
+    test_match_length_unbounded();
+    test_match_length_utf8();
+
+    printf("All match length tests PASSED!\n");
+    return 0;
+}
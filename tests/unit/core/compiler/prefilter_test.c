@@ -0,0 +1,410 @@
+/**
+ * @file prefilter_test.c
+ * @brief Unit tests for literal extraction and prefiltering in the LibRift regex engine
+ *
+ * This file contains test cases verifying the prefixes, suffixes and required
+ * literals extracted from pattern ASTs, including through backreferences, the
+ * first bytes and start anchors found in automata, and the candidate positions
+ * found with them.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "core/automaton/automaton.h"
+#include "core/automaton/state.h"
+#include "core/compiler/prefilter.h"
+#include "core/parser/ast.h"
+
+/* Create a node with an optional value and children */
+static rift_regex_ast_node_t *
+node(rift_regex_ast_node_type_t type, const char *value, rift_regex_ast_node_t *first,
+     rift_regex_ast_node_t *second, rift_regex_ast_node_t *third)
+{
+    rift_regex_ast_node_t *result = rift_regex_ast_node_create(type);
+    assert(result != NULL);
+    if (value) {
+        assert(rift_regex_ast_node_set_value(result, value));
+    }
+
+    rift_regex_ast_node_t *children[] = {first, second, third};
+    for (size_t i = 0; i < 3; i++) {
+        if (children[i]) {
+            assert(rift_regex_ast_node_add_child(result, children[i]));
+        }
+    }
+    return result;
+}
+
+static rift_regex_ast_node_t *
+literal(const char *value)
+{
+    return node(RIFT_REGEX_AST_NODE_LITERAL, value, NULL, NULL, NULL);
+}
+
+/* Build a prefilter for a tree under a root node */
+static rift_prefilter_t *
+create_prefilter(rift_regex_ast_node_t *tree, rift_regex_flags_t flags)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_ast_t *ast = rift_regex_ast_create();
+    assert(ast != NULL);
+    ast->flags = flags;
+    assert(rift_regex_ast_set_root(ast, node(RIFT_REGEX_AST_NODE_ROOT, NULL, tree, NULL, NULL)));
+
+    rift_prefilter_t *prefilter = rift_prefilter_create(ast, &error);
+    assert(prefilter != NULL);
+    rift_regex_ast_free(ast);
+    return prefilter;
+}
+
+/* Check whether a prefilter requires a literal */
+static bool
+requires(const rift_prefilter_t *prefilter, const char *bytes)
+{
+    for (size_t i = 0; i < prefilter->num_required; i++) {
+        if (strcmp(prefilter->required[i].bytes, bytes) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Test that adjacent literals join into a prefix and suffix */
+void
+test_prefilter_prefix(void)
+{
+    /* ^ab(cd)e[x-z] */
+    rift_prefilter_t *prefilter = create_prefilter(
+        node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL,
+             node(RIFT_REGEX_AST_NODE_ANCHOR, "^", NULL, NULL, NULL),
+             node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL, literal("ab"),
+                  node(RIFT_REGEX_AST_NODE_GROUP, NULL, literal("cd"), NULL, NULL), literal("e")),
+             node(RIFT_REGEX_AST_NODE_CHARACTER_CLASS, "[x-z]", NULL, NULL, NULL)),
+        RIFT_REGEX_FLAG_NONE);
+
+    assert(rift_prefilter_has_literals(prefilter));
+    assert(strcmp(prefilter->prefix.bytes, "abcde") == 0);
+    assert(prefilter->suffix.length == 0);
+    assert(prefilter->num_required == 1 && requires(prefilter, "abcde"));
+
+    rift_prefilter_free(prefilter);
+    printf("test_prefilter_prefix: PASSED\n");
+}
+
+/* Test required literals in the middle of a pattern and under quantifiers */
+void
+test_prefilter_required(void)
+{
+    /* .(ab)+x?cde. */
+    rift_prefilter_t *prefilter = create_prefilter(
+        node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL,
+             node(RIFT_REGEX_AST_NODE_DOT, ".", NULL, NULL, NULL),
+             node(RIFT_REGEX_AST_NODE_QUANTIFIER, "+", literal("ab"), NULL, NULL),
+             node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL,
+                  node(RIFT_REGEX_AST_NODE_QUANTIFIER, "?", literal("x"), NULL, NULL),
+                  literal("cde"), node(RIFT_REGEX_AST_NODE_DOT, ".", NULL, NULL, NULL))),
+        RIFT_REGEX_FLAG_NONE);
+
+    assert(prefilter->prefix.length == 0);
+    assert(prefilter->num_required == 1 && requires(prefilter, "cde"));
+    rift_prefilter_free(prefilter);
+
+    /* a{1}b joins, a{2,}b only keeps the junction */
+    prefilter = create_prefilter(
+        node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL,
+             node(RIFT_REGEX_AST_NODE_QUANTIFIER, "{1}", literal("a"), NULL, NULL), literal("b"),
+             NULL),
+        RIFT_REGEX_FLAG_NONE);
+    assert(strcmp(prefilter->prefix.bytes, "ab") == 0);
+    rift_prefilter_free(prefilter);
+
+    prefilter = create_prefilter(
+        node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL,
+             node(RIFT_REGEX_AST_NODE_QUANTIFIER, "{2,}?", literal("a"), NULL, NULL),
+             literal("b"), NULL),
+        RIFT_REGEX_FLAG_NONE);
+    assert(strcmp(prefilter->prefix.bytes, "a") == 0);
+    assert(strcmp(prefilter->suffix.bytes, "ab") == 0);
+    assert(requires(prefilter, "ab"));
+    rift_prefilter_free(prefilter);
+
+    /* Optional and starred parts give nothing */
+    prefilter = create_prefilter(
+        node(RIFT_REGEX_AST_NODE_QUANTIFIER, "*", literal("abc"), NULL, NULL),
+        RIFT_REGEX_FLAG_NONE);
+    assert(!rift_prefilter_has_literals(prefilter));
+    rift_prefilter_free(prefilter);
+
+    printf("test_prefilter_required: PASSED\n");
+}
+
+/* Test alternations, which require one literal per branch */
+void
+test_prefilter_alternation(void)
+{
+    /* (foo|bar|baz)\d */
+    rift_prefilter_t *prefilter = create_prefilter(
+        node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL,
+             node(RIFT_REGEX_AST_NODE_ALTERNATION, NULL, literal("foo"), literal("bar"),
+                  literal("baz")),
+             node(RIFT_REGEX_AST_NODE_CHARACTER_CLASS, "\\d", NULL, NULL, NULL), NULL),
+        RIFT_REGEX_FLAG_NONE);
+
+    assert(prefilter->prefix.length == 0);
+    assert(prefilter->num_required == 3);
+    assert(requires(prefilter, "foo") && requires(prefilter, "bar") && requires(prefilter, "baz"));
+    rift_prefilter_free(prefilter);
+
+    /* Common prefixes and suffixes of the branches are kept */
+    prefilter = create_prefilter(
+        node(RIFT_REGEX_AST_NODE_ALTERNATION, NULL, literal("prefix_one_end"),
+             literal("prefix_two_end"), NULL),
+        RIFT_REGEX_FLAG_NONE);
+    assert(strcmp(prefilter->prefix.bytes, "prefix_") == 0);
+    assert(strcmp(prefilter->suffix.bytes, "_end") == 0);
+    rift_prefilter_free(prefilter);
+
+    /* A branch without literals spoils the set */
+    prefilter = create_prefilter(
+        node(RIFT_REGEX_AST_NODE_ALTERNATION, NULL, literal("foo"),
+             node(RIFT_REGEX_AST_NODE_DOT, ".", NULL, NULL, NULL), NULL),
+        RIFT_REGEX_FLAG_NONE);
+    assert(!rift_prefilter_has_literals(prefilter));
+    rift_prefilter_free(prefilter);
+
+    printf("test_prefilter_alternation: PASSED\n");
+}
+
+/* Test that backreferences repeat the literals of their groups */
+void
+test_prefilter_backreference(void)
+{
+    /* <(b)>.*</\1> */
+    rift_prefilter_t *prefilter = create_prefilter(
+        node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL,
+             node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL, literal("<"),
+                  node(RIFT_REGEX_AST_NODE_GROUP, NULL, literal("b"), NULL, NULL), literal(">")),
+             node(RIFT_REGEX_AST_NODE_QUANTIFIER, "*",
+                  node(RIFT_REGEX_AST_NODE_DOT, ".", NULL, NULL, NULL), NULL, NULL),
+             node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL, literal("</"),
+                  node(RIFT_REGEX_AST_NODE_BACKREFERENCE, "1", NULL, NULL, NULL), literal(">"))),
+        RIFT_REGEX_FLAG_NONE);
+    assert(strcmp(prefilter->prefix.bytes, "<b>") == 0);
+    assert(strcmp(prefilter->suffix.bytes, "</b>") == 0);
+    rift_prefilter_free(prefilter);
+
+    /* (?<q>ab)x\k<q> is known exactly */
+    prefilter = create_prefilter(
+        node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL,
+             node(RIFT_REGEX_AST_NODE_NAMED_GROUP, "q", literal("ab"), NULL, NULL), literal("x"),
+             node(RIFT_REGEX_AST_NODE_NAMED_BACKREFERENCE, "q", NULL, NULL, NULL)),
+        RIFT_REGEX_FLAG_NONE);
+    assert(strcmp(prefilter->prefix.bytes, "abxab") == 0);
+    rift_prefilter_free(prefilter);
+
+    /* A group referring to itself is looked at once, and a missing group adds nothing */
+    prefilter = create_prefilter(
+        node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL,
+             node(RIFT_REGEX_AST_NODE_GROUP, NULL,
+                  node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL, literal("a"),
+                       node(RIFT_REGEX_AST_NODE_BACKREFERENCE, "1", NULL, NULL, NULL), NULL),
+                  NULL, NULL),
+             node(RIFT_REGEX_AST_NODE_BACKREFERENCE, "2", NULL, NULL, NULL), NULL),
+        RIFT_REGEX_FLAG_NONE);
+    assert(prefilter->prefix.bytes[0] == 'a' && prefilter->suffix.length == 0);
+    rift_prefilter_free(prefilter);
+
+    printf("test_prefilter_backreference: PASSED\n");
+}
+
+/* Test that patterns whose literals may not match themselves are skipped */
+void
+test_prefilter_disabled(void)
+{
+    rift_prefilter_t *prefilter = create_prefilter(
+        node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL,
+             node(RIFT_REGEX_AST_NODE_OPTION, "i", NULL, NULL, NULL), literal("abc"), NULL),
+        RIFT_REGEX_FLAG_NONE);
+    assert(!rift_prefilter_has_literals(prefilter));
+    rift_prefilter_free(prefilter);
+
+    /* Escapes are left to the matcher */
+    prefilter = create_prefilter(literal("\\n"), RIFT_REGEX_FLAG_NONE);
+    assert(!rift_prefilter_has_literals(prefilter));
+    rift_prefilter_free(prefilter);
+
+    rift_regex_error_t error = {0};
+    assert(rift_prefilter_create(NULL, &error) == NULL);
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_PARAMETER);
+
+    printf("test_prefilter_disabled: PASSED\n");
+}
+
+/* Test that case-insensitive patterns keep their literals and search them caselessly */
+void
+test_prefilter_caseless(void)
+{
+    const char *input = "xxABxaBcxxABCDEFGHIJKLMNOPQRSTUVabcdefghijklmnopqrstuv";
+    size_t length = strlen(input);
+
+    assert(rift_prefilter_find_literal_caseless(input, length, 0, "abc", 3) == 5);
+    assert(rift_prefilter_find_literal_caseless(input, length, 6, "Abc", 3) == 10);
+    assert(rift_prefilter_find_literal_caseless(input, length, 0, "uvA", 3) == 30);
+    assert(rift_prefilter_find_literal_caseless(input, length, 0, "UVX", 3) ==
+           RIFT_PREFILTER_NO_CANDIDATE);
+    assert(rift_prefilter_find_literal_caseless(input, length, 0, "x", 1) == 0);
+
+    rift_prefilter_t *prefilter = create_prefilter(literal("abc"),
+                                                   RIFT_REGEX_FLAG_CASE_INSENSITIVE);
+    assert(rift_prefilter_has_literals(prefilter) && prefilter->caseless);
+    assert(rift_prefilter_find_candidate(prefilter, input, length, 0, NULL) == 5);
+    rift_prefilter_free(prefilter);
+
+    /* In UTF-8 mode literals stop short of letters ASCII folding cannot compare */
+    prefilter = create_prefilter(literal("ab\xC3\xA9" "cd"),
+                                 RIFT_REGEX_FLAG_CASE_INSENSITIVE | RIFT_REGEX_FLAG_UTF8);
+    assert(strcmp(prefilter->prefix.bytes, "ab") == 0);
+    assert(strcmp(prefilter->suffix.bytes, "cd") == 0);
+    rift_prefilter_free(prefilter);
+
+    printf("test_prefilter_caseless: PASSED\n");
+}
+
+/* Test finding literals and candidate positions */
+void
+test_prefilter_find_candidate(void)
+{
+    const char *input = "xxabxabcxx";
+    size_t length = strlen(input);
+
+    assert(rift_prefilter_find_literal(input, length, 0, "abc", 3) == 5);
+    assert(rift_prefilter_find_literal(input, length, 6, "abc", 3) == RIFT_PREFILTER_NO_CANDIDATE);
+    assert(rift_prefilter_find_literal(input, length, 0, "xx", 2) == 0);
+    assert(rift_prefilter_find_literal(input, length, 1, "xx", 2) == 8);
+    assert(rift_prefilter_find_literal(input, length, 10, "", 0) == 10);
+
+    /* A prefix gives the next occurrence */
+    rift_prefilter_t *prefilter = create_prefilter(literal("abc"), RIFT_REGEX_FLAG_NONE);
+    size_t window_end = 0;
+    assert(rift_prefilter_find_candidate(prefilter, input, length, 0, &window_end) == 5);
+    assert(window_end == 5);
+    assert(rift_prefilter_find_candidate(prefilter, input, length, 6, NULL) ==
+           RIFT_PREFILTER_NO_CANDIDATE);
+    rift_prefilter_free(prefilter);
+
+    /* Required literals accept every position up to their first occurrence */
+    prefilter = create_prefilter(
+        node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL,
+             node(RIFT_REGEX_AST_NODE_DOT, ".", NULL, NULL, NULL),
+             node(RIFT_REGEX_AST_NODE_ALTERNATION, NULL, literal("bc"), literal("xa"), NULL),
+             NULL),
+        RIFT_REGEX_FLAG_NONE);
+    assert(rift_prefilter_find_candidate(prefilter, input, length, 0, &window_end) == 0);
+    assert(window_end == 1);
+    assert(rift_prefilter_find_candidate(prefilter, input, length, 5, &window_end) == 5);
+    assert(window_end == 6);
+    assert(rift_prefilter_find_candidate(prefilter, input, length, 7, NULL) ==
+           RIFT_PREFILTER_NO_CANDIDATE);
+    rift_prefilter_free(prefilter);
+
+    printf("test_prefilter_find_candidate: PASSED\n");
+}
+
+/* Test first bytes and start anchors taken from automata */
+void
+test_prefilter_automaton(void)
+{
+    rift_regex_error_t error = {0};
+
+    /* ^a|^b, the anchors sit on the states in front of each branch */
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *start = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *anchor_a = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *anchor_b = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *end = rift_automaton_create_state(nfa, true);
+    assert(rift_automaton_set_initial_state(nfa, start));
+    assert(rift_state_set_flag(anchor_a, RIFT_STATE_FLAG_ANCHOR_START));
+    assert(rift_state_set_flag(anchor_b, RIFT_STATE_FLAG_ANCHOR_START));
+    assert(rift_automaton_create_epsilon_transition(nfa, start, anchor_a));
+    assert(rift_automaton_create_epsilon_transition(nfa, start, anchor_b));
+    assert(rift_automaton_add_transition(nfa, anchor_a, end, "a"));
+    assert(rift_automaton_add_transition(nfa, anchor_b, end, "b"));
+
+    rift_prefilter_t *prefilter = create_prefilter(
+        node(RIFT_REGEX_AST_NODE_DOT, ".", NULL, NULL, NULL), RIFT_REGEX_FLAG_NONE);
+    assert(!rift_prefilter_can_skip(prefilter));
+    assert(rift_prefilter_analyze_automaton(prefilter, nfa, &error));
+    assert(rift_prefilter_can_skip(prefilter));
+    assert(prefilter->anchored_start);
+    assert(prefilter->num_first_bytes == 2);
+
+    /* Only the start of the input is tried, and only if its byte fits */
+    assert(rift_prefilter_find_candidate(prefilter, "bxa", 3, 0, NULL) == 0);
+    assert(rift_prefilter_find_candidate(prefilter, "bxa", 3, 1, NULL) ==
+           RIFT_PREFILTER_NO_CANDIDATE);
+    assert(rift_prefilter_find_candidate(prefilter, "xa", 2, 0, NULL) ==
+           RIFT_PREFILTER_NO_CANDIDATE);
+
+    /* In multiline mode every line start is tried */
+    prefilter->multiline = true;
+    assert(rift_prefilter_find_candidate(prefilter, "xa\nz\nbq", 7, 0, NULL) == 5);
+    rift_prefilter_free(prefilter);
+
+    /* A branch around the anchor makes the start unanchored */
+    rift_regex_state_t *other = rift_automaton_create_state(nfa, false);
+    assert(rift_automaton_create_epsilon_transition(nfa, start, other));
+    assert(rift_automaton_add_transition(nfa, other, end, "c"));
+
+    prefilter = create_prefilter(node(RIFT_REGEX_AST_NODE_DOT, ".", NULL, NULL, NULL),
+                                 RIFT_REGEX_FLAG_NONE);
+    assert(rift_prefilter_analyze_automaton(prefilter, nfa, &error));
+    assert(!prefilter->anchored_start);
+    assert(prefilter->num_first_bytes == 3);
+    size_t window_end = 0;
+    assert(rift_prefilter_find_candidate(prefilter, "xyzcb", 5, 0, &window_end) == 3);
+    assert(window_end == 3);
+    assert(rift_prefilter_find_candidate(prefilter, "xyz", 3, 0, NULL) ==
+           RIFT_PREFILTER_NO_CANDIDATE);
+    rift_prefilter_free(prefilter);
+
+    /* An accepting start state can match before any byte */
+    rift_regex_automaton_t *empty = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *empty_start = rift_automaton_create_state(empty, true);
+    assert(rift_automaton_set_initial_state(empty, empty_start));
+    prefilter = create_prefilter(node(RIFT_REGEX_AST_NODE_DOT, ".", NULL, NULL, NULL),
+                                 RIFT_REGEX_FLAG_NONE);
+    assert(rift_prefilter_analyze_automaton(prefilter, empty, &error));
+    assert(prefilter->num_first_bytes == 256 && !prefilter->anchored_start);
+    assert(!rift_prefilter_can_skip(prefilter));
+    rift_prefilter_free(prefilter);
+
+    assert(!rift_prefilter_analyze_automaton(NULL, nfa, &error));
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_PARAMETER);
+
+    rift_automaton_free(empty);
+    rift_automaton_free(nfa);
+    printf("test_prefilter_automaton: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running prefilter tests...\n");
+
+    test_prefilter_prefix();
+    test_prefilter_required();
+    test_prefilter_alternation();
+    test_prefilter_backreference();
+    test_prefilter_disabled();
+    test_prefilter_caseless();
+    test_prefilter_find_candidate();
+    test_prefilter_automaton();
+
+    printf("All prefilter tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,219 @@
+/**
+ * @file simplify_test.c
+ * @brief Unit tests for AST simplification in the LibRift regex engine
+ *
+ * This file contains test cases verifying that sequences and non-capturing
+ * groups are flattened, literal prefixes factored out of alternations,
+ * single bytes merged into classes and nested quantifiers folded, without
+ * changing the order in which alternatives are tried.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "core/compiler/simplify.h"
+#include "core/parser/ast.h"
+
+/* Create a node with an optional value and children */
+static rift_regex_ast_node_t *
+node(rift_regex_ast_node_type_t type, const char *value, rift_regex_ast_node_t *first,
+     rift_regex_ast_node_t *second, rift_regex_ast_node_t *third)
+{
+    rift_regex_ast_node_t *result = rift_regex_ast_node_create(type);
+    assert(result != NULL);
+    if (value) {
+        assert(rift_regex_ast_node_set_value(result, value));
+    }
+
+    rift_regex_ast_node_t *children[] = {first, second, third};
+    for (size_t i = 0; i < 3; i++) {
+        if (children[i]) {
+            assert(rift_regex_ast_node_add_child(result, children[i]));
+        }
+    }
+    return result;
+}
+
+static rift_regex_ast_node_t *
+literal(const char *value)
+{
+    return node(RIFT_REGEX_AST_NODE_LITERAL, value, NULL, NULL, NULL);
+}
+
+static rift_regex_ast_node_t *
+alternation(rift_regex_ast_node_t *first, rift_regex_ast_node_t *second,
+            rift_regex_ast_node_t *third)
+{
+    return node(RIFT_REGEX_AST_NODE_ALTERNATION, NULL, first, second, third);
+}
+
+/* Put a tree under a root node of a new AST */
+static rift_regex_ast_t *
+create_ast(rift_regex_ast_node_t *tree)
+{
+    rift_regex_ast_t *ast = rift_regex_ast_create();
+    assert(ast != NULL);
+    assert(rift_regex_ast_set_root(ast, node(RIFT_REGEX_AST_NODE_ROOT, NULL, tree, NULL, NULL)));
+    return ast;
+}
+
+/* The single node under the root of a simplified AST */
+static rift_regex_ast_node_t *
+top(rift_regex_ast_t *ast)
+{
+    assert(rift_regex_ast_get_child_count(ast->root) == 1);
+    return rift_regex_ast_get_child(ast->root, 0);
+}
+
+static bool
+is_node(const rift_regex_ast_node_t *tree, rift_regex_ast_node_type_t type, const char *value)
+{
+    if (tree->type != type) {
+        return false;
+    }
+    return value ? tree->value && strcmp(tree->value, value) == 0 : true;
+}
+
+/* Test that sequences and non-capturing groups are flattened into one literal */
+void
+test_simplify_flatten(void)
+{
+    /* a(?:bc)d */
+    rift_regex_ast_node_t *group =
+        node(RIFT_REGEX_AST_NODE_NON_CAPTURING_GROUP, NULL, literal("bc"), NULL, NULL);
+    rift_regex_ast_t *ast =
+        create_ast(node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL, literal("a"), group,
+                        literal("d")));
+
+    assert(rift_regex_simplify_ast(ast) > 0);
+    assert(is_node(top(ast), RIFT_REGEX_AST_NODE_LITERAL, "abcd"));
+    rift_regex_ast_free(ast);
+
+    /* (a)b keeps its capturing group */
+    ast = create_ast(node(RIFT_REGEX_AST_NODE_CONCATENATION, NULL,
+                          node(RIFT_REGEX_AST_NODE_GROUP, NULL, literal("a"), NULL, NULL),
+                          literal("b"), NULL));
+
+    assert(rift_regex_simplify_ast(ast) == 0);
+    assert(is_node(rift_regex_ast_get_child(top(ast), 0), RIFT_REGEX_AST_NODE_GROUP, NULL));
+    rift_regex_ast_free(ast);
+
+    printf("test_simplify_flatten: PASSED\n");
+}
+
+/* Test that common prefixes are factored out in the order alternatives are tried */
+void
+test_simplify_prefixes(void)
+{
+    /* foo|foobar|fox becomes fo(?:o(?:bar)??|x) */
+    rift_regex_ast_t *ast = create_ast(alternation(literal("foo"), literal("foobar"),
+                                                   literal("fox")));
+
+    assert(rift_regex_simplify_ast(ast) > 0);
+    rift_regex_ast_node_t *tree = top(ast);
+    assert(is_node(tree, RIFT_REGEX_AST_NODE_CONCATENATION, NULL));
+    assert(is_node(rift_regex_ast_get_child(tree, 0), RIFT_REGEX_AST_NODE_LITERAL, "fo"));
+
+    rift_regex_ast_node_t *rests = rift_regex_ast_get_child(tree, 1);
+    assert(is_node(rests, RIFT_REGEX_AST_NODE_ALTERNATION, NULL));
+    assert(rift_regex_ast_get_child_count(rests) == 2);
+    assert(is_node(rift_regex_ast_get_child(rests, 1), RIFT_REGEX_AST_NODE_LITERAL, "x"));
+
+    /* foo is tried before foobar, so the optional bar is lazy */
+    rift_regex_ast_node_t *o = rift_regex_ast_get_child(rests, 0);
+    assert(is_node(rift_regex_ast_get_child(o, 0), RIFT_REGEX_AST_NODE_LITERAL, "o"));
+    assert(is_node(rift_regex_ast_get_child(o, 1), RIFT_REGEX_AST_NODE_QUANTIFIER, "??"));
+    rift_regex_ast_free(ast);
+
+    /* ab|a tries the longer alternative first, so the optional b is greedy */
+    ast = create_ast(alternation(literal("ab"), literal("a"), NULL));
+
+    assert(rift_regex_simplify_ast(ast) > 0);
+    assert(is_node(rift_regex_ast_get_child(top(ast), 1), RIFT_REGEX_AST_NODE_QUANTIFIER, "?"));
+    rift_regex_ast_free(ast);
+
+    printf("test_simplify_prefixes: PASSED\n");
+}
+
+/* Test that alternations of single bytes become classes */
+void
+test_simplify_classes(void)
+{
+    /* a|b|c */
+    rift_regex_ast_t *ast = create_ast(alternation(literal("a"), literal("b"), literal("c")));
+
+    assert(rift_regex_simplify_ast(ast) > 0);
+    assert(is_node(top(ast), RIFT_REGEX_AST_NODE_CHARACTER_CLASS, "[a-c]"));
+    rift_regex_ast_free(ast);
+
+    /* ]|^|- needs its members placed where a bracket expression reads them literally */
+    ast = create_ast(alternation(literal("]"), literal("^"), literal("-")));
+
+    assert(rift_regex_simplify_ast(ast) > 0);
+    assert(is_node(top(ast), RIFT_REGEX_AST_NODE_CHARACTER_CLASS, "[]^-]"));
+    rift_regex_ast_free(ast);
+
+    /* a|(b) keeps the capturing group as an alternative of its own */
+    ast = create_ast(alternation(literal("a"),
+                                 node(RIFT_REGEX_AST_NODE_GROUP, NULL, literal("b"), NULL, NULL),
+                                 NULL));
+
+    assert(rift_regex_simplify_ast(ast) == 0);
+    assert(is_node(top(ast), RIFT_REGEX_AST_NODE_ALTERNATION, NULL));
+    rift_regex_ast_free(ast);
+
+    printf("test_simplify_classes: PASSED\n");
+}
+
+/* Test that nested simple quantifiers are folded */
+void
+test_simplify_quantifiers(void)
+{
+    const char *inner[] = {"*", "+", "+", "?"};
+    const char *outer[] = {"*", "+", "?", "?"};
+    const char *folded[] = {"*", "+", "*", "?"};
+
+    for (size_t i = 0; i < sizeof(inner) / sizeof(inner[0]); i++) {
+        rift_regex_ast_node_t *loop =
+            node(RIFT_REGEX_AST_NODE_QUANTIFIER, inner[i], literal("a"), NULL, NULL);
+        rift_regex_ast_node_t *group =
+            node(RIFT_REGEX_AST_NODE_NON_CAPTURING_GROUP, NULL, loop, NULL, NULL);
+        rift_regex_ast_t *ast =
+            create_ast(node(RIFT_REGEX_AST_NODE_QUANTIFIER, outer[i], group, NULL, NULL));
+
+        assert(rift_regex_simplify_ast(ast) > 0);
+        assert(is_node(top(ast), RIFT_REGEX_AST_NODE_QUANTIFIER, folded[i]));
+        assert(is_node(rift_regex_ast_get_child(top(ast), 0), RIFT_REGEX_AST_NODE_LITERAL, "a"));
+        rift_regex_ast_free(ast);
+    }
+
+    /* Lazy loops are kept as written */
+    rift_regex_ast_node_t *loop =
+        node(RIFT_REGEX_AST_NODE_QUANTIFIER, "*?", literal("a"), NULL, NULL);
+    rift_regex_ast_t *ast = create_ast(node(RIFT_REGEX_AST_NODE_QUANTIFIER, "*", loop, NULL, NULL));
+
+    rift_regex_simplify_ast(ast);
+    assert(is_node(top(ast), RIFT_REGEX_AST_NODE_QUANTIFIER, "*"));
+    assert(is_node(rift_regex_ast_get_child(top(ast), 0), RIFT_REGEX_AST_NODE_QUANTIFIER, "*?"));
+    rift_regex_ast_free(ast);
+
+    printf("test_simplify_quantifiers: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running AST simplification tests...\n");
+
+    test_simplify_flatten();
+    test_simplify_prefixes();
+    test_simplify_classes();
+    test_simplify_quantifiers();
+
+    printf("All AST simplification tests PASSED!\n");
+    return 0;
+}
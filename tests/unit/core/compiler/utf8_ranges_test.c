@@ -0,0 +1,167 @@
+/**
+ * @file utf8_ranges_test.c
+ * @brief Unit tests for UTF-8 range compilation in the LibRift regex engine
+ *
+ * This file contains test cases verifying that code point ranges split into
+ * byte range sequences matching exactly their UTF-8 encodings, and that
+ * classes and Unicode properties are read into the right code points.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "core/compiler/utf8_ranges.h"
+
+/* Check whether a sequence matches an encoded code point */
+static bool
+sequence_matches(const rift_utf8_sequence_t *sequence, const uint8_t *bytes, size_t length)
+{
+    if (sequence->length != length) {
+        return false;
+    }
+    for (size_t i = 0; i < length; i++) {
+        if (bytes[i] < sequence->start[i] || bytes[i] > sequence->end[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Check that the sequences of a range match every code point of it exactly once */
+static void
+check_range(uint32_t start, uint32_t end)
+{
+    rift_utf8_sequence_t sequences[RIFT_UTF8_MAX_SEQUENCES];
+    size_t count = rift_utf8_sequences(start, end, sequences);
+    assert(count > 0 && count <= RIFT_UTF8_MAX_SEQUENCES);
+
+    uint32_t first = start > 0x80 ? start - 0x80 : 0;
+    uint32_t last = end + 0x80 < RIFT_UTF8_MAX_CODEPOINT ? end + 0x80 : RIFT_UTF8_MAX_CODEPOINT;
+    for (uint32_t c = first; c <= last; c++) {
+        uint8_t bytes[RIFT_UTF8_MAX_LENGTH];
+        size_t length = rift_utf8_encode(c, bytes);
+        if (length == 0) {
+            continue;
+        }
+
+        size_t matches = 0;
+        for (size_t i = 0; i < count; i++) {
+            matches += sequence_matches(&sequences[i], bytes, length);
+        }
+        assert(matches == (c >= start && c <= end ? 1u : 0u));
+    }
+}
+
+/* Test encoding and decoding of single code points */
+void
+test_utf8_codec(void)
+{
+    uint8_t bytes[RIFT_UTF8_MAX_LENGTH];
+    uint32_t codepoint;
+
+    assert(rift_utf8_encode(0xE9, bytes) == 2 && bytes[0] == 0xC3 && bytes[1] == 0xA9);
+    assert(rift_utf8_decode("\xC3\xA9", 2, &codepoint) == 2 && codepoint == 0xE9);
+    assert(rift_utf8_decode("\xF0\x9F\x98\x80", 4, &codepoint) == 4 && codepoint == 0x1F600);
+
+    /* Overlong forms, surrogates and truncated sequences are rejected */
+    assert(rift_utf8_decode("\xC0\xAF", 2, &codepoint) == 0);
+    assert(rift_utf8_decode("\xED\xA0\x80", 3, &codepoint) == 0);
+    assert(rift_utf8_decode("\xE2\x82", 2, &codepoint) == 0);
+    assert(rift_utf8_encode(0xD800, bytes) == 0);
+
+    printf("test_utf8_codec: PASSED\n");
+}
+
+/* Test that ranges split into sequences covering exactly their code points */
+void
+test_utf8_sequences(void)
+{
+    rift_utf8_sequence_t sequences[RIFT_UTF8_MAX_SEQUENCES];
+
+    /* One length and whole continuation bytes: a single sequence */
+    assert(rift_utf8_sequences(0x80, 0x7FF, sequences) == 1);
+    assert(sequences[0].length == 2 && sequences[0].start[0] == 0xC2 &&
+           sequences[0].end[0] == 0xDF && sequences[0].start[1] == 0x80 &&
+           sequences[0].end[1] == 0xBF);
+
+    /* All code points: one sequence per length, with the surrogates cut out */
+    assert(rift_utf8_sequences(0, RIFT_UTF8_MAX_CODEPOINT, sequences) <= 10);
+
+    check_range('a', 0xE9);
+    check_range(0x3B1, 0x3C9);
+    check_range(0xD000, 0xE100);
+    check_range(0xFFF0, 0x10010);
+    check_range(0x1F600, 0x1F64F);
+    check_range(0x10FF00, RIFT_UTF8_MAX_CODEPOINT);
+
+    printf("test_utf8_sequences: PASSED\n");
+}
+
+/* Test formatting of byte ranges as transition patterns */
+void
+test_utf8_format(void)
+{
+    char pattern[RIFT_UTF8_MAX_PATTERN_LENGTH];
+
+    assert(rift_utf8_format_byte_range('a', 'a', pattern) == 1 && strcmp(pattern, "a") == 0);
+    assert(strcmp((rift_utf8_format_byte_range('.', '.', pattern), pattern), "\\.") == 0);
+    assert(strcmp((rift_utf8_format_byte_range('Z', 'a', pattern), pattern), "[]Z\\_-a[^]") == 0);
+    assert(strcmp((rift_utf8_format_byte_range(0x80, 0xBF, pattern), pattern), "[\x80-\xBF]") ==
+           0);
+
+    printf("test_utf8_format: PASSED\n");
+}
+
+/* Test reading classes and properties into code point sets */
+void
+test_utf8_classes(void)
+{
+    rift_utf8_range_set_t set = {NULL, 0, 0};
+
+    assert(rift_utf8_class_needs_ranges("[a-é]"));
+    assert(rift_utf8_class_needs_ranges("[^a]"));
+    assert(!rift_utf8_class_needs_ranges("[a-z]"));
+    assert(!rift_utf8_class_needs_ranges("[\xA8\xA9]"));
+
+    assert(rift_utf8_parse_class("[zα-ωa-c]", false, &set));
+    assert(set.count == 3 && set.ranges[0].start == 'a' && set.ranges[0].end == 'c');
+    assert(set.ranges[2].start == 0x3B1 && set.ranges[2].end == 0x3C9);
+    rift_utf8_range_set_clear(&set);
+
+    /* Negation covers every other code point except NUL */
+    assert(rift_utf8_parse_class("[^é]", false, &set));
+    assert(set.count == 2 && set.ranges[0].start == 1 && set.ranges[0].end == 0xE8);
+    assert(set.ranges[1].start == 0xEA && set.ranges[1].end == RIFT_UTF8_MAX_CODEPOINT);
+    rift_utf8_range_set_clear(&set);
+
+    assert(rift_utf8_parse_property("\\p{In Greek}", false, &set));
+    assert(set.count == 1 && set.ranges[0].start == 0x370 && set.ranges[0].end == 0x3FF);
+    rift_utf8_range_set_clear(&set);
+
+    assert(rift_utf8_parse_property("\\P{^ascii}", false, &set));
+    assert(set.count == 1 && set.ranges[0].end == 0x7F);
+    rift_utf8_range_set_clear(&set);
+
+    assert(!rift_utf8_parse_property("\\pL", false, &set));
+    rift_utf8_range_set_clear(&set);
+
+    printf("test_utf8_classes: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running UTF-8 range tests...\n");
+
+    test_utf8_codec();
+    test_utf8_sequences();
+    test_utf8_format();
+    test_utf8_classes();
+
+    printf("All UTF-8 range tests PASSED!\n");
+    return 0;
+}
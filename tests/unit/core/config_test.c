@@ -21,6 +21,7 @@ static void test_config_initialization(void);
 static void test_config_get_set(void);
 static void test_config_reset(void);
 static void test_regex_params(void);
+static void test_config_snapshots(void);
 static void test_memory_allocator(void);
 static void test_config_serialization(void);
 
@@ -41,6 +42,7 @@ main(void)
     test_config_get_set();
     test_config_reset();
     test_regex_params();
+    test_config_snapshots();
     test_memory_allocator();
     test_config_serialization();
 
@@ -174,6 +176,10 @@ test_regex_params(void)
     status = rift_config_get_regex_param(RIFT_REGEX_PARAM_MAX_CAPTURE_GROUPS, &capture_groups);
     assert(status == RIFT_OK && "Getting capture groups should succeed");
 
+    bool glushkov_nfa = true;
+    status = rift_config_get_regex_param(RIFT_REGEX_PARAM_GLUSHKOV_NFA, &glushkov_nfa);
+    assert(status == RIFT_OK && !glushkov_nfa && "Thompson NFAs should be the default");
+
     /* Test setting regex parameters */
     size_t new_pattern_length = 8192;
     status = rift_config_set_regex_param(RIFT_REGEX_PARAM_MAX_PATTERN_LENGTH, &new_pattern_length);
@@ -199,6 +205,48 @@ test_regex_params(void)
     printf("✓ Regex parameter tests passed\n");
 }
 
+/**
+ * @brief Test that acquired snapshots keep their settings across changes
+ */
+static void
+test_config_snapshots(void)
+{
+    rift_status_t status = rift_config_initialize();
+    assert(status == RIFT_OK);
+
+    const rift_config_t *before = rift_config_acquire();
+    size_t old_states = before->regex.max_states;
+
+    /* A change publishes a new snapshot and leaves the held one alone */
+    size_t new_states = old_states + 1;
+    status = rift_config_set_regex_param(RIFT_REGEX_PARAM_MAX_STATES, &new_states);
+    assert(status == RIFT_OK);
+    assert(before->regex.max_states == old_states && "Held snapshot should not change");
+    const rift_config_t *after = rift_config_acquire();
+    assert(after != before && after->regex.max_states == new_states);
+
+    /* Regex settings copied out can be overridden one by one */
+    rift_regex_config_t local = after->regex;
+    bool use_dfa = !local.use_dfa_when_possible;
+    status = rift_regex_config_set_param(&local, RIFT_REGEX_PARAM_USE_DFA_WHEN_POSSIBLE, &use_dfa);
+    assert(status == RIFT_OK && local.use_dfa_when_possible == use_dfa);
+    bool read = !use_dfa;
+    status = rift_regex_config_get_param(&local, RIFT_REGEX_PARAM_USE_DFA_WHEN_POSSIBLE, &read);
+    assert(status == RIFT_OK && read == use_dfa);
+    assert(after->regex.use_dfa_when_possible != use_dfa && "The snapshot should not change");
+    status = rift_regex_config_set_param(NULL, RIFT_REGEX_PARAM_MAX_STATES, &new_states);
+    assert(status != RIFT_OK && "NULL configuration should fail");
+
+    rift_config_release(after);
+    rift_config_release(before);
+    rift_config_release(NULL);
+
+    status = rift_config_cleanup();
+    assert(status == RIFT_OK);
+
+    printf("✓ Snapshot tests passed\n");
+}
+
 /**
  * @brief Test memory allocator configuration
  */
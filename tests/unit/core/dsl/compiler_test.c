@@ -0,0 +1,467 @@
+/**
+ * @file compiler_test.c
+ * @brief Unit tests for the compiler of the .rift DSL
+ *
+ * This file contains test cases verifying that compiling a file as a stream
+ * gives the programs of a compilation of its source, in source order, and
+ * reports parse and pattern errors the same way, and that serialized
+ * compilations keep the DFA tables, prefilters and verdicts of their patterns.
+ * Containers load from memory as they do from a mapped file.
+ * Rule shards must answer as the programs do, whatever the state budget,
+ * and so must the rule combinations evaluated over their matches.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "core/dsl/rift_dsl_compiler.h"
+
+#define NUM_STREAMED_PATTERNS 1000
+#define NUM_SHARDED_PATTERNS 40
+
+/* Write a source to a temporary file, whose path is stored in path */
+static void
+write_source(char *path, const char *source)
+{
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    size_t length = strlen(source);
+    assert(write(fd, source, length) == (ssize_t)length);
+    close(fd);
+}
+
+/* Test that a streamed file compiles to the programs of its source */
+void
+test_compile_file_matches_source(void)
+{
+    // Enough patterns to keep the parser waiting for the compiling threads
+    size_t capacity = NUM_STREAMED_PATTERNS * 48;
+    char *source = (char *)malloc(capacity);
+    assert(source != NULL);
+    size_t length = 0;
+    for (size_t i = 0; i < NUM_STREAMED_PATTERNS; i++) {
+        length += (size_t)snprintf(source + length, capacity - length,
+                                   "@pattern P%zu = \"p%zu[0-9]+\"\n", i, i);
+    }
+
+    char path[] = "/tmp/rift_dsl_stream_XXXXXX";
+    write_source(path, source);
+
+    rift_dsl_compile_stats_t stats;
+    rift_dsl_compile_options_t options = {4, &stats};
+    void *streamed = rift_dsl_compile_file(path, &options);
+    void *parsed = rift_dsl_compile(source);
+    assert(streamed != NULL && parsed != NULL);
+    assert(rift_dsl_get_compilation_error(streamed) == NULL);
+    assert(rift_dsl_get_compiled_count(streamed) == NUM_STREAMED_PATTERNS);
+    assert(rift_dsl_get_compiled_count(parsed) == NUM_STREAMED_PATTERNS);
+    assert(stats.num_patterns == NUM_STREAMED_PATTERNS);
+
+    // Programs follow the source in both
+    assert(rift_dsl_execute(streamed, 0, "p042", 4, NULL));
+    assert(rift_dsl_execute(streamed, 7, "p71", 3, NULL));
+    assert(!rift_dsl_execute(streamed, 7, "p61", 3, NULL));
+    assert(rift_dsl_execute(parsed, 7, "p71", 3, NULL));
+    assert(rift_dsl_execute(streamed, NUM_STREAMED_PATTERNS - 1, "p9990", 5, NULL));
+
+    rift_dsl_free_compilation(streamed);
+    rift_dsl_free_compilation(parsed);
+    unlink(path);
+    free(source);
+    printf("test_compile_file_matches_source: PASSED\n");
+}
+
+/* Test that errors of a streamed file are those of its source */
+void
+test_compile_file_errors(void)
+{
+    assert(rift_dsl_compile_file("/nonexistent/rules.rift", NULL) == NULL);
+
+    // A failing pattern keeps the programs before it
+    char path[] = "/tmp/rift_dsl_stream_XXXXXX";
+    write_source(path, "@pattern A = \"abc\"\n"
+                       "@pattern B = \"(\"\n"
+                       "@pattern C = \"xyz\"\n");
+    void *compilation = rift_dsl_compile_file(path, NULL);
+    assert(compilation != NULL);
+    assert(rift_dsl_get_compilation_error(compilation) != NULL);
+    assert(strstr(rift_dsl_get_compilation_error(compilation), "'B'") != NULL);
+    assert(rift_dsl_get_compiled_count(compilation) == 1);
+    rift_dsl_free_compilation(compilation);
+    unlink(path);
+
+    // A parse error drops the patterns already compiled
+    char bad_path[] = "/tmp/rift_dsl_stream_XXXXXX";
+    write_source(bad_path, "@pattern A = \"abc\"\n"
+                           "@unknown\n");
+    compilation = rift_dsl_compile_file(bad_path, NULL);
+    assert(compilation != NULL);
+    assert(rift_dsl_get_compilation_error(compilation) != NULL);
+    assert(rift_dsl_get_compiled_count(compilation) == 0);
+    rift_dsl_free_compilation(compilation);
+    unlink(bad_path);
+    printf("test_compile_file_errors: PASSED\n");
+}
+
+/* Test that serialization keeps the analysis of every pattern */
+void
+test_serialize_keeps_analysis(void)
+{
+    void *compilation = rift_dsl_compile("@pattern Digits = \"id[0-9]+\"\n"
+                                         "@pattern Anchored = \"^abc\"\n"
+                                         "@pattern Nested = \"(a+)+b\"\n");
+    assert(compilation != NULL);
+    assert(rift_dsl_get_compilation_error(compilation) == NULL);
+    assert(rift_dsl_get_compiled_count(compilation) == 3);
+
+    // Anchored patterns keep to the VM, the others get a table
+    assert(rift_dsl_get_dfa_table(compilation, 0) != NULL);
+    assert(rift_dsl_get_dfa_table(compilation, 1) == NULL);
+    assert(rift_dsl_get_dfa_table(compilation, 2) != NULL);
+    const rift_prefilter_t *prefilter = rift_dsl_get_prefilter(compilation, 0);
+    assert(prefilter != NULL);
+    assert(prefilter->prefix.length == 2 && memcmp(prefilter->prefix.bytes, "id", 2) == 0);
+    rift_ambiguity_verdict_t verdict;
+    assert(rift_dsl_get_ambiguity(compilation, 2, &verdict));
+    assert(verdict.nested_quantifiers > 0);
+    assert(rift_dsl_get_dfa_table(compilation, 3) == NULL);
+    assert(!rift_dsl_get_ambiguity(compilation, 3, &verdict));
+
+    uint8_t *data = NULL;
+    size_t size = 0;
+    assert(rift_dsl_serialize_compilation(compilation, &data, &size));
+    void *loaded = rift_dsl_deserialize_compilation(data, size);
+    assert(loaded != NULL);
+    assert(rift_dsl_get_compilation_error(loaded) == NULL);
+    assert(rift_dsl_get_compiled_count(loaded) == 3);
+
+    // Tables, literals and verdicts come back as they were
+    for (size_t i = 0; i < 3; i++) {
+        const rift_dfa_table_t *table = rift_dsl_get_dfa_table(compilation, i);
+        const rift_dfa_table_t *loaded_table = rift_dsl_get_dfa_table(loaded, i);
+        assert((table == NULL) == (loaded_table == NULL));
+        if (table) {
+            assert(table->num_states == loaded_table->num_states);
+            assert(table->num_classes == loaded_table->num_classes);
+            assert(memcmp(table->next, loaded_table->next,
+                          (size_t)table->num_states * table->num_classes * sizeof(uint32_t)) ==
+                   0);
+        }
+        assert(memcmp(rift_dsl_get_prefilter(compilation, i), rift_dsl_get_prefilter(loaded, i),
+                      sizeof(rift_prefilter_t)) == 0);
+        rift_ambiguity_verdict_t loaded_verdict;
+        assert(rift_dsl_get_ambiguity(compilation, i, &verdict));
+        assert(rift_dsl_get_ambiguity(loaded, i, &loaded_verdict));
+        assert(verdict.ambiguity == loaded_verdict.ambiguity);
+        assert(verdict.nested_quantifiers == loaded_verdict.nested_quantifiers);
+    }
+
+    // The tables and the VM agree
+    const char *inputs[] = {"id42", "id", "xid7", "abcd", "aab", "aaaa", ""};
+    for (size_t i = 0; i < 3; i++) {
+        for (size_t j = 0; j < sizeof(inputs) / sizeof(inputs[0]); j++) {
+            rift_regex_match_t match;
+            bool expected = rift_dsl_execute(compilation, i, inputs[j], (size_t)-1, &match);
+            assert(rift_dsl_execute(compilation, i, inputs[j], (size_t)-1, NULL) == expected);
+            assert(rift_dsl_execute(loaded, i, inputs[j], (size_t)-1, NULL) == expected);
+        }
+    }
+    assert(rift_dsl_execute(loaded, 0, "id42", 4, NULL));
+    assert(!rift_dsl_execute(loaded, 0, "xid42", 5, NULL));
+
+    // A damaged section is reported, a missing one leaves the programs to the VM
+    size_t programs_size = size - 4;
+    while (memcmp(data + programs_size, "RDXT", 4) != 0) {
+        programs_size--;
+    }
+    void *truncated = rift_dsl_deserialize_compilation(data, size - 1);
+    assert(truncated != NULL && rift_dsl_get_compilation_error(truncated) != NULL);
+    void *plain = rift_dsl_deserialize_compilation(data, programs_size);
+    assert(plain != NULL && rift_dsl_get_compilation_error(plain) == NULL);
+    assert(rift_dsl_get_dfa_table(plain, 0) == NULL);
+    assert(rift_dsl_execute(plain, 0, "id42", 4, NULL));
+
+    rift_dsl_free_compilation(plain);
+    rift_dsl_free_compilation(truncated);
+    rift_dsl_free_compilation(loaded);
+    rift_dsl_free_compilation(compilation);
+    free(data);
+    printf("test_serialize_keeps_analysis: PASSED\n");
+}
+
+/* Test that container bytes in memory load without a file */
+void
+test_load_container(void)
+{
+    void *compilation = rift_dsl_compile("@pattern Word = \"[a-z]+\"\n"
+                                         "@pattern Number = \"[0-9]+\"\n"
+                                         "@pattern Again = \"[a-z]+\"\n");
+    assert(compilation != NULL);
+    uint8_t *data = NULL;
+    size_t size = 0;
+    assert(rift_dsl_serialize_container(compilation, &data, &size));
+    rift_dsl_free_compilation(compilation);
+
+    void *loaded = rift_dsl_load_container(data, size);
+    assert(loaded != NULL);
+    assert(rift_dsl_get_compilation_error(loaded) == NULL);
+    assert(rift_dsl_get_compiled_count(loaded) == 3);
+    assert(rift_dsl_execute(loaded, 0, "abc", 3, NULL));
+    assert(!rift_dsl_execute(loaded, 0, "42", 2, NULL));
+    assert(rift_dsl_execute(loaded, 1, "42", 2, NULL));
+    assert(rift_dsl_execute(loaded, 2, "abc", 3, NULL));
+    rift_dsl_free_compilation(loaded);
+
+    // Damaged bytes are reported through the compilation error
+    data[size - 1] ^= 1;
+    void *damaged = rift_dsl_load_container(data, size);
+    assert(damaged != NULL);
+    assert(rift_dsl_get_compilation_error(damaged) != NULL);
+    assert(rift_dsl_get_compiled_count(damaged) == 0);
+    rift_dsl_free_compilation(damaged);
+    assert(rift_dsl_load_container(NULL, size) == NULL);
+
+    free(data);
+    printf("test_load_container: PASSED\n");
+}
+
+/* Collect the programs reported by rift_dsl_execute_all */
+static bool
+collect_match(size_t index, void *user_data)
+{
+    bool *matched = (bool *)user_data;
+    matched[index] = true;
+    return true;
+}
+
+/* Test that rule shards keep to their budget and answer as the programs do */
+void
+test_shards_match_programs(void)
+{
+    char source[NUM_SHARDED_PATTERNS * 48];
+    size_t length = 0;
+    for (size_t i = 0; i < NUM_SHARDED_PATTERNS; i++) {
+        length += (size_t)snprintf(source + length, sizeof(source) - length,
+                                   "@pattern S%zu = \"k%zu(ab|cd)*e\"\n", i, i);
+    }
+    length += (size_t)snprintf(source + length, sizeof(source) - length,
+                               "@pattern Anchored = \"^k1\"\n");
+
+    rift_dsl_compile_stats_t stats;
+    rift_dsl_compile_options_t options = {2, &stats, 16};
+    void *sharded = rift_dsl_compile_with_options(source, &options);
+    assert(sharded != NULL);
+    assert(rift_dsl_get_compilation_error(sharded) == NULL);
+    assert(stats.num_shards > 1 && stats.num_shards < NUM_SHARDED_PATTERNS);
+    assert(rift_dsl_get_shard_count(sharded) == stats.num_shards);
+
+    void *single = rift_dsl_compile(source);
+    assert(single != NULL);
+    assert(rift_dsl_get_shard_count(single) == 1);
+
+    const char *inputs[] = {"k1e", "k12abcde", "k7abx", "k1", "k3cdcde tail", ""};
+    for (size_t j = 0; j < sizeof(inputs) / sizeof(inputs[0]); j++) {
+        bool sharded_matched[NUM_SHARDED_PATTERNS + 1] = {false};
+        bool single_matched[NUM_SHARDED_PATTERNS + 1] = {false};
+        size_t count = rift_dsl_execute_all(sharded, inputs[j], (size_t)-1, collect_match,
+                                            sharded_matched);
+        assert(rift_dsl_execute_all(single, inputs[j], (size_t)-1, collect_match,
+                                    single_matched) == count);
+        for (size_t i = 0; i <= NUM_SHARDED_PATTERNS; i++) {
+            bool expected = rift_dsl_execute(sharded, i, inputs[j], (size_t)-1, NULL);
+            assert(sharded_matched[i] == expected);
+            assert(single_matched[i] == expected);
+        }
+    }
+
+    rift_dsl_free_compilation(single);
+    rift_dsl_free_compilation(sharded);
+    printf("test_shards_match_programs: PASSED\n");
+}
+
+/* Test that batch execution answers as the programs do on each input */
+void
+test_execute_batch_matches_programs(void)
+{
+    void *compilation = rift_dsl_compile("@pattern Word = \"ab+c\"\n"
+                                         "@pattern Number = \"[0-9]+x\"\n");
+    assert(compilation != NULL);
+    assert(rift_dsl_get_dfa_table(compilation, 0) != NULL);
+
+    // More inputs than one block, of varied lengths
+    char buffers[300][16];
+    const char *inputs[300];
+    for (size_t i = 0; i < 300; i++) {
+        snprintf(buffers[i], sizeof(buffers[i]), i % 3 ? "a%.*sc%zu" : "%zux", (int)(i % 9),
+                 "bbbbbbbbb", i);
+        inputs[i] = buffers[i];
+    }
+    inputs[5] = NULL;
+
+    for (size_t index = 0; index < 2; index++) {
+        bool results[300];
+        size_t matched = rift_dsl_execute_batch(compilation, index, inputs, NULL, 300, results);
+        size_t expected = 0;
+        for (size_t i = 0; i < 300; i++) {
+            bool single = inputs[i] && rift_dsl_execute(compilation, index, inputs[i],
+                                                         (size_t)-1, NULL);
+            assert(results[i] == single);
+            expected += single;
+        }
+        assert(matched == expected && matched > 0);
+    }
+
+    assert(rift_dsl_execute_batch(compilation, 2, inputs, NULL, 1, NULL) == 0);
+    rift_dsl_free_compilation(compilation);
+    printf("test_execute_batch_matches_programs: PASSED\n");
+}
+
+/* Test the existence and counting modes against full execution */
+void
+test_is_match_and_count(void)
+{
+    void *compilation = rift_dsl_compile("@pattern Word = \"ab+c\"\n"
+                                         "@pattern Start = \"^a+\"\n");
+    assert(compilation != NULL);
+    assert(rift_dsl_get_dfa_table(compilation, 0) != NULL);
+    assert(rift_dsl_get_dfa_table(compilation, 1) == NULL);
+
+    const char *inputs[] = {"abc", "abbbcx", "ab", "xabc", "", "aa"};
+    for (size_t index = 0; index < 2; index++) {
+        for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+            bool expected = rift_dsl_execute(compilation, index, inputs[i], (size_t)-1, NULL);
+            assert(rift_dsl_is_match(compilation, index, inputs[i], (size_t)-1) == expected);
+        }
+    }
+
+    // Matches restart where the previous one ended
+    assert(rift_dsl_count(compilation, 0, "abc abbc-abcabc", (size_t)-1) == 4);
+    assert(rift_dsl_count(compilation, 0, "xyz", (size_t)-1) == 0);
+    assert(rift_dsl_count(compilation, 1, "aaaa aa", (size_t)-1) == 2);
+    assert(rift_dsl_count(compilation, 2, "abc", (size_t)-1) == 0);
+    assert(!rift_dsl_is_match(NULL, 0, "abc", (size_t)-1));
+
+    rift_dsl_free_compilation(compilation);
+    printf("test_is_match_and_count: PASSED\n");
+}
+
+/* Test that rules covered by another rule are reported and pruned */
+void
+test_lint_prunes_redundant_rules(void)
+{
+    const char *source = "@pattern Short = \"ab+\"\n"
+                         "@pattern Wide = \"a[ab]+\"\n"
+                         "@pattern Copy = \"a(a|b)+\"\n"
+                         "@pattern Other = \"c+\"\n"
+                         "@pattern Anchored = \"^ab\"\n";
+
+    rift_dsl_lint_t lint;
+    rift_dsl_compile_stats_t stats;
+    rift_dsl_compile_options_t options = {1, &stats, 0, NULL, &lint, false};
+    void *compilation = rift_dsl_compile_with_options(source, &options);
+    assert(compilation != NULL);
+    assert(rift_dsl_get_compiled_count(compilation) == 5);
+    assert(stats.num_pruned == 0);
+
+    /* The anchored rule has no DFA table, so it is never compared */
+    assert(lint.num_compared == 4);
+    assert(lint.count == 2);
+    assert(lint.redundancies[0].index == 0 && lint.redundancies[0].covered_by == 1);
+    assert(!lint.redundancies[0].duplicate);
+    assert(strcmp(lint.redundancies[0].name, "Short") == 0);
+    assert(strcmp(lint.redundancies[0].covered_by_name, "Wide") == 0);
+    assert(lint.redundancies[1].index == 2 && lint.redundancies[1].covered_by == 1);
+    assert(lint.redundancies[1].duplicate);
+    rift_dsl_lint_free(&lint);
+    assert(lint.count == 0 && lint.redundancies == NULL);
+    rift_dsl_free_compilation(compilation);
+
+    options.lint = NULL;
+    options.prune_redundant = true;
+    compilation = rift_dsl_compile_with_options(source, &options);
+    assert(compilation != NULL);
+    assert(stats.num_pruned == 2 && stats.num_patterns == 3);
+    assert(rift_dsl_get_compiled_count(compilation) == 3);
+    assert(strcmp(rift_dsl_get_compiled_name(compilation, 0), "Wide") == 0);
+    assert(strcmp(rift_dsl_get_compiled_name(compilation, 1), "Other") == 0);
+    assert(strcmp(rift_dsl_get_compiled_name(compilation, 2), "Anchored") == 0);
+
+    /* Whatever a pruned rule matched, a kept one still does */
+    assert(rift_dsl_execute(compilation, 0, "abbb", (size_t)-1, NULL));
+    assert(rift_dsl_execute(compilation, 2, "abbb", (size_t)-1, NULL));
+    rift_dsl_free_compilation(compilation);
+    printf("test_lint_prunes_redundant_rules: PASSED\n");
+}
+
+/* Test that rule combinations answer as their rules do on each input */
+void
+test_combinations_match_rules(void)
+{
+    const char *source = "@combine Flagged = \"Keyword & Number & !Internal\"\n"
+                         "@pattern Keyword = \"[a-z]+ (password|token)\"\n"
+                         "@pattern Number = \"[a-z ]+[0-9]\"\n"
+                         "@pattern Internal = \"internal\"\n"
+                         "@combine Either = \"Internal or not Keyword\"\n";
+    void *compilation = rift_dsl_compile(source);
+    assert(compilation != NULL);
+    assert(rift_dsl_get_compilation_error(compilation) == NULL);
+    assert(rift_dsl_get_compiled_combination_count(compilation) == 2);
+    assert(strcmp(rift_dsl_get_compiled_combination_name(compilation, 0), "Flagged") == 0);
+    assert(rift_dsl_get_compiled_combination_name(compilation, 2) == NULL);
+
+    enum { COUNT = 300 };
+    static const char *const samples[] = {"user password1", "internal token9", "user token",
+                                          "plain text", "internal", NULL};
+    const char *inputs[COUNT];
+    bool results[2 * COUNT];
+    for (size_t i = 0; i < COUNT; i++) {
+        inputs[i] = samples[i % 6];
+    }
+    size_t matched = rift_dsl_execute_combinations(compilation, inputs, NULL, COUNT, results);
+
+    size_t expected_matched = 0;
+    for (size_t i = 0; i < COUNT; i++) {
+        bool keyword = inputs[i] && rift_dsl_execute(compilation, 0, inputs[i], (size_t)-1, NULL);
+        bool number = inputs[i] && rift_dsl_execute(compilation, 1, inputs[i], (size_t)-1, NULL);
+        bool internal = inputs[i] && rift_dsl_execute(compilation, 2, inputs[i], (size_t)-1, NULL);
+        assert(results[i] == (keyword && number && !internal));
+        assert(results[COUNT + i] == (internal || !keyword));
+        expected_matched += results[i] + results[COUNT + i];
+    }
+    assert(matched == expected_matched);
+    assert(results[0] && !results[1] && results[COUNT + 1] && results[COUNT + 3]);
+    rift_dsl_free_compilation(compilation);
+
+    /* Combinations may only name rules */
+    compilation = rift_dsl_compile("@pattern A = \"a\"\n@combine Bad = \"A & B\"\n");
+    assert(compilation != NULL);
+    assert(strstr(rift_dsl_get_compilation_error(compilation), "Unknown rule 'B'") != NULL);
+    rift_dsl_free_compilation(compilation);
+
+    printf("test_combinations_match_rules: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running DSL compiler tests...\n");
+
+    test_compile_file_matches_source();
+    test_compile_file_errors();
+    test_serialize_keeps_analysis();
+    test_load_container();
+    test_shards_match_programs();
+    test_execute_batch_matches_programs();
+    test_is_match_and_count();
+    test_lint_prunes_redundant_rules();
+    test_combinations_match_rules();
+
+    printf("All DSL compiler tests PASSED!\n");
+    return 0;
+}
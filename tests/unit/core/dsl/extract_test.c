@@ -0,0 +1,160 @@
+/**
+ * @file extract_test.c
+ * @brief Unit tests for two-phase capture extraction of .rift rules
+ *
+ * This file contains test cases verifying that an extraction plan resolves
+ * the named groups of each rule, that only the rules an input matches are
+ * reported, with their groups as spans into the input, whether the match end
+ * is bounded by a DFA table or not, and that the callback can stop early.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/dsl/rift_dsl_compiler.h"
+#include "core/dsl/rift_dsl_extract.h"
+
+#define MAX_REPORTS 8
+
+static const char *source = "@pattern Login = \"user=(?<user>[a-z]+) id=(?<id>[0-9]+)\"\n"
+                            "@pattern Number = \"[0-9]+\"\n"
+                            "@pattern Shout = \"^(?<word>[a-z]+)!\"\n";
+
+/* Rules and spans reported for one input */
+typedef struct {
+    size_t rules[MAX_REPORTS];
+    rift_regex_span_t spans[MAX_REPORTS][3];
+    size_t count;
+    size_t limit;
+} reports_t;
+
+/* Copy each extraction, stopping after limit of them */
+static bool
+record(const rift_dsl_extraction_t *extraction, void *user_data)
+{
+    reports_t *reports = user_data;
+    assert(extraction->num_spans <= 3);
+    reports->rules[reports->count] = extraction->rule;
+    memcpy(reports->spans[reports->count], extraction->spans,
+           extraction->num_spans * sizeof(rift_regex_span_t));
+    reports->count++;
+    return reports->count < reports->limit;
+}
+
+/* Extract the groups of an input into reports */
+static size_t
+extract(rift_dsl_extractor_t *extractor, const char *input, reports_t *reports)
+{
+    memset(reports, 0, sizeof(*reports));
+    reports->limit = MAX_REPORTS;
+    return rift_dsl_extract(extractor, input, strlen(input), record, reports);
+}
+
+/* Test that the plan knows the groups of each rule */
+void
+test_extract_plan(void)
+{
+    void *compilation = rift_dsl_compile(source);
+    assert(compilation != NULL && !rift_dsl_get_compilation_error(compilation));
+
+    rift_dsl_extract_plan_t *plan = rift_dsl_extract_plan_create(compilation, NULL);
+    assert(plan != NULL);
+    assert(rift_dsl_extract_plan_capture_count(plan) == 2);
+    assert(rift_dsl_extract_plan_span_count(plan, 0) == 3);
+    assert(rift_dsl_extract_plan_span_count(plan, 1) == 1);
+    assert(rift_dsl_extract_plan_span_count(plan, 2) == 2);
+    assert(rift_dsl_extract_plan_span_count(plan, 3) == 0);
+
+    assert(rift_dsl_extract_plan_group_index(plan, 0, "user") == 1);
+    assert(rift_dsl_extract_plan_group_index(plan, 0, "id") == 2);
+    assert(rift_dsl_extract_plan_group_index(plan, 0, "word") == RIFT_GROUP_NO_INDEX);
+    assert(rift_dsl_extract_plan_group_index(plan, 1, "id") == RIFT_GROUP_NO_INDEX);
+    assert(rift_dsl_extract_plan_group_index(plan, 2, "word") == 1);
+
+    rift_dsl_extract_plan_free(plan);
+    rift_dsl_free_compilation(compilation);
+    printf("test_extract_plan: PASSED\n");
+}
+
+/* Test that only matching rules are reported, with their groups */
+void
+test_extract_matching_rules(void)
+{
+    void *compilation = rift_dsl_compile(source);
+    rift_dsl_extract_plan_t *plan = rift_dsl_extract_plan_create(compilation, NULL);
+    rift_dsl_extractor_t *extractor = rift_dsl_extractor_create(plan);
+    assert(extractor != NULL);
+    reports_t reports;
+
+    // The table of Login bounds its match before the trailing text
+    const char *login = "user=bob id=42 and more";
+    assert(extract(extractor, login, &reports) == 1);
+    assert(reports.rules[0] == 0);
+    assert(reports.spans[0][0].start == 0 && reports.spans[0][0].end == 14);
+    assert(reports.spans[0][1].start == 5 && reports.spans[0][1].end == 8);
+    assert(reports.spans[0][2].start == 12 && reports.spans[0][2].end == 14);
+
+    // A rule without groups reports its match alone
+    assert(extract(extractor, "123abc", &reports) == 1);
+    assert(reports.rules[0] == 1);
+    assert(reports.spans[0][0].start == 0 && reports.spans[0][0].end == 3);
+
+    // The anchored rule has no table, so its matcher reads the whole input
+    assert(extract(extractor, "hey! user=x", &reports) == 1);
+    assert(reports.rules[0] == 2);
+    assert(reports.spans[0][0].start == 0 && reports.spans[0][0].end == 4);
+    assert(reports.spans[0][1].start == 0 && reports.spans[0][1].end == 3);
+
+    assert(extract(extractor, "nothing here", &reports) == 0);
+    assert(reports.count == 0);
+
+    rift_dsl_extractor_free(extractor);
+    rift_dsl_extract_plan_free(plan);
+    rift_dsl_free_compilation(compilation);
+    printf("test_extract_matching_rules: PASSED\n");
+}
+
+/* Test that the callback stops the extraction */
+void
+test_extract_stop(void)
+{
+    void *compilation = rift_dsl_compile("@pattern A = \"(?<a>a+)\"\n"
+                                         "@pattern B = \"a(?<b>b)?\"\n"
+                                         "@pattern C = \"[a-z]+\"\n");
+    rift_dsl_extract_plan_t *plan = rift_dsl_extract_plan_create(compilation, NULL);
+    rift_dsl_extractor_t *extractor = rift_dsl_extractor_create(plan);
+    reports_t reports;
+
+    assert(extract(extractor, "aab", &reports) == 3);
+    assert(reports.rules[0] == 0 && reports.rules[1] == 1 && reports.rules[2] == 2);
+    assert(reports.spans[0][1].start == 0 && reports.spans[0][1].end == 2);
+    // B matches "a" alone, so its optional group did not participate
+    assert(reports.spans[1][0].end == 1);
+    assert(reports.spans[1][1].start == RIFT_REGEX_SPAN_UNSET);
+
+    memset(&reports, 0, sizeof(reports));
+    reports.limit = 1;
+    assert(rift_dsl_extract(extractor, "aab", 3, record, &reports) == 1);
+    assert(reports.count == 1 && reports.rules[0] == 0);
+
+    rift_dsl_extractor_free(extractor);
+    rift_dsl_extract_plan_free(plan);
+    rift_dsl_free_compilation(compilation);
+    printf("test_extract_stop: PASSED\n");
+}
+
+int
+main(void)
+{
+    test_extract_plan();
+    test_extract_matching_rules();
+    test_extract_stop();
+
+    printf("\nAll DSL extraction tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file formula_test.c
+ * @brief Unit tests for boolean formulas over the rules of a .rift file
+ *
+ * This file contains test cases verifying that expressions compile with the
+ * usual precedence of their operators, that syntax errors and unknown rules
+ * are reported, and that bit-sliced evaluation agrees with evaluation on
+ * the match bitmap of each input.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/dsl/rift_dsl_formula.h"
+
+#define NUM_RULES 5
+#define NUM_INPUTS 300
+
+static const char *const rule_names[NUM_RULES] = {"A", "B", "C", "Login", "not_admin"};
+
+/* Resolve the names of rule_names */
+static bool
+resolve(const char *name, size_t length, uint32_t *rule, void *user_data)
+{
+    (void)user_data;
+    for (uint32_t i = 0; i < NUM_RULES; i++) {
+        if (strlen(rule_names[i]) == length && strncmp(rule_names[i], name, length) == 0) {
+            *rule = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Evaluate an expression on the rules whose bits are set in mask */
+static bool
+evaluate(const char *expression, uint64_t mask)
+{
+    rift_dsl_formula_t formula;
+    assert(rift_dsl_formula_compile(&formula, expression, resolve, NULL, NULL, 0));
+    bool value = rift_dsl_formula_matches(&formula, &mask);
+    rift_dsl_formula_destroy(&formula);
+    return value;
+}
+
+/* Test that operators bind as not, and, or and that words stand for them */
+void
+test_formula_precedence(void)
+{
+    for (uint64_t mask = 0; mask < (1u << NUM_RULES); mask++) {
+        bool a = mask & 1;
+        bool b = (mask >> 1) & 1;
+        bool c = (mask >> 2) & 1;
+        bool login = (mask >> 3) & 1;
+        bool not_admin = (mask >> 4) & 1;
+
+        assert(evaluate("A & B & !C", mask) == (a && b && !c));
+        assert(evaluate("A and B and not C", mask) == (a && b && !c));
+        assert(evaluate("A | B & C", mask) == (a || (b && c)));
+        assert(evaluate("(A | B) & C", mask) == ((a || b) && c));
+        assert(evaluate("!A | !!B", mask) == (!a || b));
+        assert(evaluate("not (A or Login)", mask) == !(a || login));
+        assert(evaluate("Login&not_admin", mask) == (login && not_admin));
+    }
+    printf("test_formula_precedence: PASSED\n");
+}
+
+/* Test that malformed expressions and unknown rules are rejected */
+void
+test_formula_errors(void)
+{
+    static const char *const invalid[] = {"", "A &", "(A | B", "A B", "A & & B", "!", "A )"};
+    rift_dsl_formula_t formula;
+    char error[128];
+
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        error[0] = '\0';
+        assert(!rift_dsl_formula_compile(&formula, invalid[i], resolve, NULL, error,
+                                         sizeof(error)));
+        assert(error[0] != '\0');
+        assert(formula.steps == NULL && formula.num_steps == 0);
+    }
+
+    assert(!rift_dsl_formula_compile(&formula, "A & Admin", resolve, NULL, error, sizeof(error)));
+    assert(strcmp(error, "Unknown rule 'Admin' at offset 4") == 0);
+
+    /* Nesting beyond the operand stack is refused rather than overflowing it */
+    char deep[4 * RIFT_DSL_FORMULA_MAX_STACK + 8];
+    size_t length = 0;
+    for (size_t i = 0; i <= RIFT_DSL_FORMULA_MAX_STACK; i++) {
+        length += (size_t)snprintf(deep + length, sizeof(deep) - length, "A|(");
+    }
+    deep[length++] = 'B';
+    memset(deep + length, ')', RIFT_DSL_FORMULA_MAX_STACK + 1);
+    deep[length + RIFT_DSL_FORMULA_MAX_STACK + 1] = '\0';
+    assert(!rift_dsl_formula_compile(&formula, deep, resolve, NULL, error, sizeof(error)));
+    assert(strstr(error, "nested too deeply") != NULL);
+
+    printf("test_formula_errors: PASSED\n");
+}
+
+/* Test that bit-sliced evaluation agrees with evaluation input by input */
+void
+test_formula_lanes(void)
+{
+    enum { WORDS = (NUM_INPUTS + 63) / 64 };
+    uint64_t lanes[NUM_RULES * WORDS];
+    uint64_t masks[NUM_INPUTS];
+    uint64_t values[WORDS];
+    memset(lanes, 0, sizeof(lanes));
+
+    srand(5);
+    for (size_t i = 0; i < NUM_INPUTS; i++) {
+        masks[i] = (uint64_t)rand() % (1u << NUM_RULES);
+        for (uint32_t r = 0; r < NUM_RULES; r++) {
+            if ((masks[i] >> r) & 1) {
+                lanes[r * WORDS + i / 64] |= (uint64_t)1 << (i % 64);
+            }
+        }
+    }
+
+    static const char *const expressions[] = {"A & B & !C", "(A | Login) & !(B | not_admin)",
+                                              "!A", "C"};
+    for (size_t e = 0; e < sizeof(expressions) / sizeof(expressions[0]); e++) {
+        rift_dsl_formula_t formula;
+        assert(rift_dsl_formula_compile(&formula, expressions[e], resolve, NULL, NULL, 0));
+        assert(formula.max_stack >= 1 && formula.max_stack <= 3);
+        rift_dsl_formula_eval_lanes(&formula, lanes, WORDS, values);
+        for (size_t i = 0; i < NUM_INPUTS; i++) {
+            bool lane = ((values[i / 64] >> (i % 64)) & 1) != 0;
+            assert(lane == rift_dsl_formula_matches(&formula, &masks[i]));
+        }
+        rift_dsl_formula_destroy(&formula);
+    }
+    printf("test_formula_lanes: PASSED\n");
+}
+
+int
+main(void)
+{
+    test_formula_precedence();
+    test_formula_errors();
+    test_formula_lanes();
+
+    printf("\nAll DSL formula tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,218 @@
+/**
+ * @file io_test.c
+ * @brief Unit tests for the I/O utilities of the .rift DSL
+ *
+ * This file contains test cases verifying that compiled binaries and
+ * containers are read back from the cache directory when their source
+ * matches, and compiled anew when the cached file does not.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "core/dsl/rift_dsl_compiler.h"
+#include "core/dsl/rift_dsl_io.h"
+
+static const char *source = "@pattern WORD = \"abc\"\n@pattern DIGITS = \"[0-9]+\"\n";
+
+/**
+ * @brief Find the cache file of a directory holding one
+ */
+static void
+cache_file(const char *dir, char *path, size_t size)
+{
+    DIR *handle = opendir(dir);
+    assert(handle != NULL);
+    struct dirent *entry;
+    path[0] = '\0';
+    while ((entry = readdir(handle)) != NULL) {
+        if (entry->d_name[0] != '.') {
+            assert(path[0] == '\0');
+            snprintf(path, size, "%s/%s", dir, entry->d_name);
+        }
+    }
+    closedir(handle);
+    assert(path[0] != '\0');
+}
+
+/**
+ * @brief Check that two binaries hold the same bytes
+ */
+static void
+assert_same_data(void *a, void *b)
+{
+    const uint8_t *data_a, *data_b;
+    size_t size_a, size_b;
+    assert(rift_dsl_binary_get_data(a, &data_a, &size_a));
+    assert(rift_dsl_binary_get_data(b, &data_b, &size_b));
+    assert(size_a == size_b && memcmp(data_a, data_b, size_a) == 0);
+}
+
+/* Test that a second compilation of a source reads the cached binary */
+void
+test_cache_hit(void)
+{
+    char dir[] = "/tmp/rift_cache_XXXXXX";
+    assert(mkdtemp(dir) != NULL);
+    assert(rift_dsl_set_cache_dir(dir));
+
+    void *first = rift_dsl_compile_to_binary(source);
+    assert(first != NULL && !rift_dsl_binary_is_cached(first));
+    void *second = rift_dsl_compile_to_binary(source);
+    assert(second != NULL && rift_dsl_binary_is_cached(second));
+    assert_same_data(first, second);
+    assert(rift_dsl_binary_validate(second));
+
+    // Loading the file goes through the same cache
+    char rift_path[256];
+    snprintf(rift_path, sizeof(rift_path), "%s.rift", dir);
+    FILE *file = fopen(rift_path, "w");
+    assert(file != NULL);
+    fputs(source, file);
+    fclose(file);
+    void *loaded = rift_dsl_load_compile_to_binary(rift_path);
+    assert(loaded != NULL && rift_dsl_binary_is_cached(loaded));
+    assert_same_data(first, loaded);
+
+    // Another source misses
+    void *other = rift_dsl_compile_to_binary("@pattern OTHER = \"x+\"\n");
+    assert(other != NULL && !rift_dsl_binary_is_cached(other));
+
+    // Without a directory nothing is cached
+    assert(rift_dsl_set_cache_dir(NULL));
+    void *uncached = rift_dsl_compile_to_binary(source);
+    assert(uncached != NULL && !rift_dsl_binary_is_cached(uncached));
+
+    rift_dsl_binary_free(first);
+    rift_dsl_binary_free(second);
+    rift_dsl_binary_free(loaded);
+    rift_dsl_binary_free(other);
+    rift_dsl_binary_free(uncached);
+
+    char command[300];
+    snprintf(command, sizeof(command), "rm -rf %s %s", dir, rift_path);
+    assert(system(command) == 0);
+    printf("test_cache_hit: PASSED\n");
+}
+
+/* Test that a damaged cache file is compiled anew and replaced */
+void
+test_cache_damaged(void)
+{
+    char dir[] = "/tmp/rift_cache_XXXXXX";
+    assert(mkdtemp(dir) != NULL);
+    assert(rift_dsl_set_cache_dir(dir));
+
+    void *first = rift_dsl_compile_to_binary(source);
+    assert(first != NULL && !rift_dsl_binary_is_cached(first));
+
+    // Flip the last byte of the payload
+    char path[512];
+    cache_file(dir, path, sizeof(path));
+    FILE *file = fopen(path, "r+b");
+    assert(file != NULL);
+    assert(fseek(file, -1, SEEK_END) == 0);
+    int last = fgetc(file);
+    assert(fseek(file, -1, SEEK_END) == 0);
+    fputc(last ^ 0xff, file);
+    fclose(file);
+
+    void *second = rift_dsl_compile_to_binary(source);
+    assert(second != NULL && !rift_dsl_binary_is_cached(second));
+    assert_same_data(first, second);
+    void *third = rift_dsl_compile_to_binary(source);
+    assert(third != NULL && rift_dsl_binary_is_cached(third));
+
+    // A truncated file misses as well
+    assert(truncate(path, 16) == 0);
+    void *fourth = rift_dsl_compile_to_binary(source);
+    assert(fourth != NULL && !rift_dsl_binary_is_cached(fourth));
+
+    rift_dsl_binary_free(first);
+    rift_dsl_binary_free(second);
+    rift_dsl_binary_free(third);
+    rift_dsl_binary_free(fourth);
+    assert(rift_dsl_set_cache_dir(NULL));
+
+    char command[300];
+    snprintf(command, sizeof(command), "rm -rf %s", dir);
+    assert(system(command) == 0);
+    printf("test_cache_damaged: PASSED\n");
+}
+
+/* Test that containers are cached apart from the binaries of the same source */
+void
+test_cache_container(void)
+{
+    char dir[] = "/tmp/rift_cache_XXXXXX";
+    assert(mkdtemp(dir) != NULL);
+    assert(rift_dsl_set_cache_dir(dir));
+
+    rift_dsl_compile_stats_t stats;
+    rift_dsl_compile_options_t options = {0};
+    options.num_threads = 2;
+    options.stats = &stats;
+    void *first = rift_dsl_compile_to_container_with_options(source, &options);
+    assert(first != NULL && !rift_dsl_binary_is_cached(first));
+    assert(stats.num_patterns == 2);
+
+    // The cached container skips the compilation
+    void *second = rift_dsl_compile_to_container_with_options(source, &options);
+    assert(second != NULL && rift_dsl_binary_is_cached(second));
+    assert(stats.num_patterns == 0);
+    assert_same_data(first, second);
+
+    // A binary of the source is not taken for its container
+    void *binary = rift_dsl_compile_to_binary(source);
+    assert(binary != NULL && !rift_dsl_binary_is_cached(binary));
+    void *third = rift_dsl_compile_to_container(source);
+    assert(third != NULL && rift_dsl_binary_is_cached(third));
+    assert_same_data(first, third);
+
+    // A failing pattern gives its error instead of a container
+    void *failed = rift_dsl_compile_to_container("@pattern BAD = \"(\"\n");
+    assert(failed != NULL && rift_dsl_binary_get_error(failed) != NULL);
+    rift_dsl_binary_free(failed);
+
+    rift_dsl_binary_free(first);
+    rift_dsl_binary_free(second);
+    rift_dsl_binary_free(third);
+    rift_dsl_binary_free(binary);
+    assert(rift_dsl_set_cache_dir(NULL));
+
+    char command[300];
+    snprintf(command, sizeof(command), "rm -rf %s", dir);
+    assert(system(command) == 0);
+    printf("test_cache_container: PASSED\n");
+}
+
+/* Test that a path that is not a directory is refused */
+void
+test_cache_dir_errors(void)
+{
+    assert(!rift_dsl_set_cache_dir(""));
+    assert(!rift_dsl_set_cache_dir("/dev/null"));
+    assert(!rift_dsl_set_cache_dir("/nonexistent/cache"));
+    printf("test_cache_dir_errors: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running DSL I/O tests...\n");
+
+    test_cache_hit();
+    test_cache_damaged();
+    test_cache_container();
+    test_cache_dir_errors();
+
+    printf("All DSL I/O tests PASSED!\n");
+    return 0;
+}
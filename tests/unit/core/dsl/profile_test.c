@@ -0,0 +1,194 @@
+/**
+ * @file profile_test.c
+ * @brief Unit tests for the match profiles of .rift rules
+ *
+ * This file contains test cases verifying that profiles record, merge, save
+ * and load the searches of named rules, and that compiling with a profile
+ * changes how rules run but never what they match.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "core/dsl/rift_dsl_compiler.h"
+#include "core/dsl/rift_dsl_profile.h"
+
+/* A pattern whose DFA needs 8192 states, over the default table budget */
+static const char *source = "@pattern WIDE = \"(a|b)*a(a|b)(a|b)(a|b)(a|b)(a|b)(a|b)(a|b)"
+                            "(a|b)(a|b)(a|b)(a|b)(a|b)\"\n"
+                            "@pattern RARE = \"[a-z]+needle\"\n";
+
+/**
+ * @brief Write a profile file, whose path is stored in path
+ */
+static void
+write_profile(char *path, const char *text)
+{
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    size_t length = strlen(text);
+    assert(write(fd, text, length) == (ssize_t)length);
+    close(fd);
+}
+
+/* Test that records are counted per name and kept in name order */
+void
+test_profile_record(void)
+{
+    rift_dsl_profile_t *profile = rift_dsl_profile_create();
+    assert(profile != NULL);
+
+    rift_match_stats_t stats;
+    rift_match_stats_reset(&stats);
+    stats.steps = 40;
+    assert(rift_dsl_profile_record(profile, "B", true, &stats));
+    assert(rift_dsl_profile_record(profile, "A", false, NULL));
+    assert(rift_dsl_profile_record(profile, "B", false, &stats));
+    assert(!rift_dsl_profile_record(profile, "has space", true, NULL));
+    assert(!rift_dsl_profile_record(profile, "", true, NULL));
+
+    assert(rift_dsl_profile_get_count(profile) == 2);
+    assert(strcmp(rift_dsl_profile_get_entry(profile, 0)->name, "A") == 0);
+    const rift_dsl_profile_entry_t *entry = rift_dsl_profile_find(profile, "B");
+    assert(entry != NULL);
+    assert(entry->searches == 2 && entry->matches == 1 && entry->steps == 80);
+    assert(rift_dsl_profile_find(profile, "C") == NULL);
+
+    rift_dsl_profile_t *total = rift_dsl_profile_create();
+    assert(rift_dsl_profile_merge(total, profile));
+    assert(rift_dsl_profile_merge(total, profile));
+    assert(rift_dsl_profile_find(total, "B")->searches == 4);
+    assert(rift_dsl_profile_find(total, "A")->matches == 0);
+
+    rift_dsl_profile_free(total);
+    rift_dsl_profile_free(profile);
+    printf("test_profile_record: PASSED\n");
+}
+
+/* Test that a saved profile loads back, and that damaged files are refused */
+void
+test_profile_save_load(void)
+{
+    rift_dsl_profile_t *profile = rift_dsl_profile_create();
+    rift_match_stats_t stats;
+    rift_match_stats_reset(&stats);
+    stats.steps = 7;
+    for (int i = 0; i < 5; i++) {
+        assert(rift_dsl_profile_record(profile, "RULE_1", i % 2 == 0, &stats));
+    }
+
+    char path[] = "/tmp/rift_dsl_profile_XXXXXX";
+    write_profile(path, "");
+    assert(rift_dsl_profile_save(profile, path));
+    char error[128];
+    rift_dsl_profile_t *loaded = rift_dsl_profile_load(path, error, sizeof(error));
+    assert(loaded != NULL);
+    const rift_dsl_profile_entry_t *entry = rift_dsl_profile_find(loaded, "RULE_1");
+    assert(entry != NULL);
+    assert(entry->searches == 5 && entry->matches == 3 && entry->steps == 35);
+    rift_dsl_profile_free(loaded);
+    unlink(path);
+
+    // Repeated names add up, comments and blank lines are skipped
+    char summed_path[] = "/tmp/rift_dsl_profile_XXXXXX";
+    write_profile(summed_path, "# comment\n\nX 2 1 10\n  X 3 0 5\n");
+    loaded = rift_dsl_profile_load(summed_path, error, sizeof(error));
+    assert(loaded != NULL);
+    assert(rift_dsl_profile_find(loaded, "X")->searches == 5);
+    assert(rift_dsl_profile_find(loaded, "X")->steps == 15);
+    rift_dsl_profile_free(loaded);
+    unlink(summed_path);
+
+    // More matches than searches, or missing counts, name the line
+    char bad_path[] = "/tmp/rift_dsl_profile_XXXXXX";
+    write_profile(bad_path, "X 2 1 10\nY 1 2 0\n");
+    assert(rift_dsl_profile_load(bad_path, error, sizeof(error)) == NULL);
+    assert(strstr(error, "line 2") != NULL);
+    unlink(bad_path);
+    char short_path[] = "/tmp/rift_dsl_profile_XXXXXX";
+    write_profile(short_path, "X 2 1\n");
+    assert(rift_dsl_profile_load(short_path, error, sizeof(error)) == NULL);
+    unlink(short_path);
+    assert(rift_dsl_profile_load("/nonexistent/profile", error, sizeof(error)) == NULL);
+
+    rift_dsl_profile_free(profile);
+    printf("test_profile_save_load: PASSED\n");
+}
+
+/* Test that a profile recorded from a compilation guides the next one */
+void
+test_profile_guided_compile(void)
+{
+    void *plain = rift_dsl_compile(source);
+    assert(plain != NULL);
+    assert(rift_dsl_get_compilation_error(plain) == NULL);
+    assert(strcmp(rift_dsl_get_compiled_name(plain, 1), "RARE") == 0);
+    assert(rift_dsl_get_dfa_table(plain, 0) == NULL);
+
+    // The wide pattern runs long on the VM and the rare one seldom matches
+    rift_dsl_profile_t *profile = rift_dsl_profile_create();
+    const char *inputs[] = {"abababababababababababababab", "bbbbabbbbbbbbbbbbbb",
+                            "xyzneedle", "abcdef", "hello world", "nothing here"};
+    for (int round = 0; round < 10; round++) {
+        for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+            for (size_t p = 0; p < 2; p++) {
+                bool expected = rift_dsl_execute(plain, p, inputs[i], (size_t)-1, NULL);
+                assert(rift_dsl_execute_profiled(plain, p, inputs[i], (size_t)-1, NULL,
+                                                 profile) == expected);
+            }
+        }
+    }
+    const rift_dsl_profile_entry_t *rare = rift_dsl_profile_find(profile, "RARE");
+    assert(rare != NULL && rare->searches == 60 && rare->matches == 10);
+    assert(rift_dsl_profile_find(profile, "WIDE")->steps > 0);
+
+    // Only the matches of the rare pattern's profile can tell it apart
+    rift_match_stats_t costly;
+    rift_match_stats_reset(&costly);
+    costly.steps = 1000;
+    for (int i = 0; i < 100; i++) {
+        assert(rift_dsl_profile_record(profile, "WIDE", true, &costly));
+    }
+    for (int i = 0; i < 1000; i++) {
+        assert(rift_dsl_profile_record(profile, "RARE", false, NULL));
+    }
+
+    rift_dsl_compile_options_t options = {1, NULL, 0, profile};
+    void *guided = rift_dsl_compile_with_options(source, &options);
+    assert(guided != NULL);
+    assert(rift_dsl_get_compilation_error(guided) == NULL);
+    assert(rift_dsl_get_dfa_table(guided, 0) != NULL);
+
+    const char *checks[] = {"abababababababab", "aaaaaaaaaaaaa", "bbbbbbbbbbbbb", "xneedle",
+                            "needle", "xneedl", "abcneedlexyz", ""};
+    for (size_t i = 0; i < sizeof(checks) / sizeof(checks[0]); i++) {
+        for (size_t p = 0; p < 2; p++) {
+            assert(rift_dsl_execute(guided, p, checks[i], (size_t)-1, NULL) ==
+                   rift_dsl_execute(plain, p, checks[i], (size_t)-1, NULL));
+        }
+    }
+
+    rift_dsl_free_compilation(guided);
+    rift_dsl_free_compilation(plain);
+    rift_dsl_profile_free(profile);
+    printf("test_profile_guided_compile: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running DSL profile tests...\n");
+
+    test_profile_record();
+    test_profile_save_load();
+    test_profile_guided_compile();
+
+    printf("All DSL profile tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,339 @@
+/**
+ * @file ruleset_test.c
+ * @brief Unit tests for the hot-swappable ruleset handle of the .rift DSL
+ *
+ * This file contains test cases verifying that readers pin the published
+ * compilation, that a failed reload keeps the current one, that a swap frees
+ * the old compilation only once its pins are gone, and that readers keep
+ * matching while another thread reloads, also on a mapped compilation.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "core/dsl/rift_dsl_ruleset.h"
+
+#define NUM_READERS 4
+#define NUM_RELOADS 50
+
+static const char *one_pattern_source = "@pattern WORD = \"abc\"\n";
+static const char *two_pattern_source = "@pattern WORD = \"abc\"\n"
+                                        "@pattern DIGITS = \"[0-9]+\"\n";
+
+/* Test that pins see the published compilation and reloads replace it */
+void
+test_ruleset_pin_and_reload(void)
+{
+    void *compilation = rift_dsl_compile(two_pattern_source);
+    assert(compilation != NULL);
+    rift_dsl_ruleset_t *ruleset = rift_dsl_ruleset_create(compilation);
+    assert(ruleset != NULL);
+    assert(rift_dsl_ruleset_generation(ruleset) == 0);
+
+    rift_dsl_ruleset_guard_t guard;
+    assert(rift_dsl_ruleset_pin(ruleset, &guard) == compilation);
+    assert(guard.generation == 0);
+    assert(rift_dsl_get_compiled_count(guard.compilation) == 2);
+    rift_dsl_ruleset_unpin(ruleset, &guard);
+
+    char error[128];
+    assert(rift_dsl_ruleset_reload(ruleset, one_pattern_source, NULL, error, sizeof(error)));
+    assert(error[0] == '\0');
+    assert(rift_dsl_ruleset_generation(ruleset) == 1);
+
+    void *reloaded = rift_dsl_ruleset_pin(ruleset, &guard);
+    assert(reloaded != NULL);
+    assert(guard.generation == 1);
+    assert(rift_dsl_get_compiled_count(reloaded) == 1);
+    rift_dsl_ruleset_unpin(ruleset, &guard);
+
+    // A source that does not compile leaves the current compilation in use
+    assert(!rift_dsl_ruleset_reload(ruleset, "@pattern BAD = \"(\"\n", NULL, error,
+                                    sizeof(error)));
+    assert(error[0] != '\0');
+    assert(rift_dsl_ruleset_generation(ruleset) == 1);
+    assert(rift_dsl_ruleset_pin(ruleset, &guard) == reloaded);
+    rift_dsl_ruleset_unpin(ruleset, &guard);
+
+    rift_dsl_ruleset_free(ruleset);
+    printf("test_ruleset_pin_and_reload: PASSED\n");
+}
+
+/* Record the index of each matching program as a digit */
+static bool
+collect_matches(size_t index, void *user_data)
+{
+    char *matches = user_data;
+    size_t length = strlen(matches);
+    matches[length] = (char)('0' + index);
+    matches[length + 1] = '\0';
+    return true;
+}
+
+/* Stop at the first matching program */
+static bool
+stop_at_first(size_t index, void *user_data)
+{
+    *(size_t *)user_data = index;
+    return false;
+}
+
+/* Test running every program in one call, through the union DFA and the VM */
+void
+test_ruleset_execute_all(void)
+{
+    // The anchored pattern keeps to the VM, the others go into the union
+    rift_dsl_ruleset_t *ruleset = rift_dsl_ruleset_create(
+        rift_dsl_compile("@pattern WORD = \"abc\"\n"
+                         "@pattern DIGITS = \"[0-9]+\"\n"
+                         "@pattern START = \"^xyz\"\n"
+                         "@pattern PREFIX = \"ab\"\n"));
+    assert(ruleset != NULL);
+
+    char matches[8] = "";
+    assert(rift_dsl_ruleset_execute_all(ruleset, "abcd", 4, collect_matches, matches) == 2);
+    assert(strcmp(matches, "03") == 0);
+
+    matches[0] = '\0';
+    assert(rift_dsl_ruleset_execute_all(ruleset, "42", 2, collect_matches, matches) == 1);
+    assert(strcmp(matches, "1") == 0);
+
+    matches[0] = '\0';
+    assert(rift_dsl_ruleset_execute_all(ruleset, "xyz", 3, collect_matches, matches) == 1);
+    assert(strcmp(matches, "2") == 0);
+
+    // Programs match at the start of the input only, as with rift_dsl_execute
+    assert(rift_dsl_ruleset_execute_all(ruleset, "-abc", 4, NULL, NULL) == 0);
+
+    size_t first = 0;
+    assert(rift_dsl_ruleset_execute_all(ruleset, "abc", 3, stop_at_first, &first) == 1);
+    assert(first == 0);
+
+    rift_dsl_ruleset_free(ruleset);
+    printf("test_ruleset_execute_all: PASSED\n");
+}
+
+/* Test publishing a compilation mapped from a bytecode container */
+void
+test_ruleset_mapped_compilation(void)
+{
+    void *compilation = rift_dsl_compile(two_pattern_source);
+    assert(compilation != NULL);
+    uint8_t *data = NULL;
+    size_t size = 0;
+    assert(rift_dsl_serialize_container(compilation, &data, &size));
+    rift_dsl_free_compilation(compilation);
+
+    char path[] = "/tmp/rift_dsl_container_XXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    assert(write(fd, data, size) == (ssize_t)size);
+    close(fd);
+    free(data);
+
+    rift_dsl_ruleset_t *ruleset = rift_dsl_ruleset_create(rift_dsl_map_compilation(path));
+    assert(ruleset != NULL);
+    rift_dsl_ruleset_guard_t guard;
+    void *pinned = rift_dsl_ruleset_pin(ruleset, &guard);
+    assert(rift_dsl_get_compilation_error(pinned) == NULL);
+    assert(rift_dsl_get_compiled_count(pinned) == 2);
+    assert(rift_dsl_execute(pinned, 0, "abc", 3, NULL));
+    assert(rift_dsl_execute(pinned, 1, "42", 2, NULL));
+    assert(!rift_dsl_execute(pinned, 1, "abc", 3, NULL));
+    rift_dsl_ruleset_unpin(ruleset, &guard);
+
+    // Mapped compilations have no union DFA and run every program on the VM
+    char matches[8] = "";
+    assert(rift_dsl_ruleset_execute_all(ruleset, "42", 2, collect_matches, matches) == 1);
+    assert(strcmp(matches, "1") == 0);
+    rift_dsl_ruleset_free(ruleset);
+
+    // A missing container is reported through the compilation error
+    unlink(path);
+    void *missing = rift_dsl_map_compilation(path);
+    assert(missing != NULL);
+    assert(rift_dsl_get_compilation_error(missing) != NULL);
+    assert(rift_dsl_get_compiled_count(missing) == 0);
+    rift_dsl_free_compilation(missing);
+    printf("test_ruleset_mapped_compilation: PASSED\n");
+}
+
+typedef struct {
+    rift_dsl_ruleset_t *ruleset;
+    atomic_bool done;
+} swap_task_t;
+
+static void *
+swap_thread(void *arg)
+{
+    swap_task_t *task = arg;
+    bool swapped = rift_dsl_ruleset_swap(task->ruleset, rift_dsl_compile(one_pattern_source));
+    atomic_store(&task->done, swapped);
+    return NULL;
+}
+
+/* Test that a swap waits for the pins on the old compilation */
+void
+test_ruleset_swap_waits_for_pins(void)
+{
+    rift_dsl_ruleset_t *ruleset = rift_dsl_ruleset_create(rift_dsl_compile(two_pattern_source));
+    assert(ruleset != NULL);
+
+    rift_dsl_ruleset_guard_t guard;
+    void *pinned = rift_dsl_ruleset_pin(ruleset, &guard);
+    assert(pinned != NULL);
+
+    swap_task_t task;
+    task.ruleset = ruleset;
+    atomic_init(&task.done, false);
+    pthread_t thread;
+    assert(pthread_create(&thread, NULL, swap_thread, &task) == 0);
+
+    // The new compilation is published at once, the old one stays alive
+    while (rift_dsl_ruleset_generation(ruleset) == 0) {
+        sched_yield();
+    }
+    struct timespec pause = {0, 20000000};
+    nanosleep(&pause, NULL);
+    assert(!atomic_load(&task.done));
+    assert(rift_dsl_get_compiled_count(pinned) == 2);
+
+    rift_dsl_ruleset_unpin(ruleset, &guard);
+    pthread_join(thread, NULL);
+    assert(atomic_load(&task.done));
+
+    rift_dsl_ruleset_free(ruleset);
+    printf("test_ruleset_swap_waits_for_pins: PASSED\n");
+}
+
+typedef struct {
+    rift_dsl_ruleset_t *ruleset;
+    atomic_bool *stop;
+    size_t pins;
+} reader_task_t;
+
+static void *
+reader_thread(void *arg)
+{
+    reader_task_t *task = arg;
+    while (!atomic_load(task->stop)) {
+        rift_dsl_ruleset_guard_t guard;
+        void *compilation = rift_dsl_ruleset_pin(task->ruleset, &guard);
+        assert(compilation != NULL);
+        size_t count = rift_dsl_get_compiled_count(compilation);
+        assert(count == 1 || count == 2);
+        assert(rift_dsl_get_compiled_program(compilation, 0) != NULL);
+        rift_dsl_ruleset_unpin(task->ruleset, &guard);
+        task->pins++;
+    }
+    return NULL;
+}
+
+/* Test that readers keep pinning valid compilations while reloads happen */
+void
+test_ruleset_concurrent_reloads(void)
+{
+    rift_dsl_ruleset_t *ruleset = rift_dsl_ruleset_create(rift_dsl_compile(one_pattern_source));
+    assert(ruleset != NULL);
+
+    atomic_bool stop;
+    atomic_init(&stop, false);
+    pthread_t threads[NUM_READERS];
+    reader_task_t tasks[NUM_READERS];
+    for (size_t i = 0; i < NUM_READERS; i++) {
+        tasks[i] = (reader_task_t){ruleset, &stop, 0};
+        assert(pthread_create(&threads[i], NULL, reader_thread, &tasks[i]) == 0);
+    }
+
+    rift_dsl_compile_options_t options = {2, NULL};
+    for (size_t i = 0; i < NUM_RELOADS; i++) {
+        const char *source = i % 2 == 0 ? two_pattern_source : one_pattern_source;
+        assert(rift_dsl_ruleset_reload(ruleset, source, &options, NULL, 0));
+    }
+
+    atomic_store(&stop, true);
+    for (size_t i = 0; i < NUM_READERS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    assert(rift_dsl_ruleset_generation(ruleset) == NUM_RELOADS);
+
+    rift_dsl_ruleset_free(ruleset);
+    printf("test_ruleset_concurrent_reloads: PASSED\n");
+}
+
+/* Context of the counting allocator */
+typedef struct {
+    atomic_size_t allocations;
+    atomic_size_t deallocations;
+} counting_context_t;
+
+static void *
+counting_allocate(void *ctx, size_t size)
+{
+    counting_context_t *context = ctx;
+    atomic_fetch_add(&context->allocations, 1);
+    return malloc(size);
+}
+
+static void
+counting_deallocate(void *ctx, void *ptr, size_t size)
+{
+    (void)size;
+    counting_context_t *context = ctx;
+    atomic_fetch_add(&context->deallocations, 1);
+    free(ptr);
+}
+
+/* Test that reloads compile through the ruleset's allocator */
+void
+test_ruleset_allocator(void)
+{
+    counting_context_t context;
+    atomic_init(&context.allocations, 0);
+    atomic_init(&context.deallocations, 0);
+    rift_allocator_t allocator = {counting_allocate, NULL, counting_deallocate, &context};
+
+    rift_dsl_ruleset_t *ruleset = rift_dsl_ruleset_create(rift_dsl_compile(one_pattern_source));
+    assert(ruleset != NULL);
+    assert(rift_dsl_ruleset_set_allocator(ruleset, &allocator));
+    assert(atomic_load(&context.allocations) == 0);
+
+    assert(rift_dsl_ruleset_reload(ruleset, two_pattern_source, NULL, NULL, 0));
+    assert(atomic_load(&context.allocations) > 0);
+    assert(rift_allocator_current() == NULL);
+
+    rift_dsl_ruleset_execute(ruleset, 0, "abc", 3, NULL);
+    assert(rift_allocator_current() == NULL);
+
+    // Freeing the compilation gives every block back to the allocator
+    rift_dsl_ruleset_free(ruleset);
+    rift_pool_trim();
+    assert(atomic_load(&context.deallocations) == atomic_load(&context.allocations));
+    printf("test_ruleset_allocator: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running ruleset tests...\n");
+
+    test_ruleset_pin_and_reload();
+    test_ruleset_execute_all();
+    test_ruleset_mapped_compilation();
+    test_ruleset_swap_waits_for_pins();
+    test_ruleset_concurrent_reloads();
+    test_ruleset_allocator();
+
+    printf("All ruleset tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,206 @@
+/**
+ * @file test_runner_test.c
+ * @brief Unit tests for the test runner of .rift DSL files
+ *
+ * This file contains test cases verifying that test cases check the pattern
+ * defined before them, and that a parallel run gives the results of a serial
+ * one in the same order, with their timings, and that benchmarks report
+ * their statistics.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "core/dsl/rift_test_runner.h"
+
+#define NUM_GENERATED_TESTS 1000
+
+static const char *small_source = "@pattern WORD = \"abc\"\n"
+                                  "@test_case {\n"
+                                  "    input = \"abcd\"\n"
+                                  "    expect_match = true\n"
+                                  "}\n"
+                                  "@pattern DIGITS = \"[0-9]+\"\n"
+                                  "@test_case {\n"
+                                  "    input = \"42\"\n"
+                                  "    expect_match = true\n"
+                                  "}\n"
+                                  "@test_case {\n"
+                                  "    input = \"abc\"\n"
+                                  "    expect_match = true\n"
+                                  "}\n";
+
+/* Test that each test case checks the pattern defined before it */
+void
+test_runner_serial(void)
+{
+    void *run = rift_test_run_source(small_source);
+    assert(run != NULL);
+    assert(rift_test_get_error(run) == NULL);
+
+    size_t total = 0, passed = 0, failed = 0;
+    assert(rift_test_get_summary(run, &total, &passed, &failed));
+    assert(total == 3 && passed == 2 && failed == 1);
+
+    rift_test_result_t result;
+    assert(rift_test_get_result(run, 0, &result));
+    assert(result.pattern_index == 0 && result.passed);
+    assert(rift_test_get_result(run, 2, &result));
+    assert(result.pattern_index == 1);
+    assert(strcmp(result.pattern_name, "DIGITS") == 0);
+    assert(result.expected_match && !result.actual_match && !result.passed);
+    assert(!rift_test_get_result(run, 3, &result));
+
+    rift_test_free_results(run);
+    printf("test_runner_serial: PASSED\n");
+}
+
+/* Test that a parallel run gives the results of a serial one */
+void
+test_runner_parallel(void)
+{
+    // Two patterns, with test cases alternating between passing and failing
+    size_t capacity = NUM_GENERATED_TESTS * 64 + 128;
+    char *source = (char *)malloc(capacity);
+    assert(source != NULL);
+    size_t length = (size_t)snprintf(source, capacity, "@pattern DIGITS = \"[0-9]+\"\n");
+    for (size_t i = 0; i < NUM_GENERATED_TESTS; i++) {
+        length += (size_t)snprintf(source + length, capacity - length,
+                                   "@test_case {\n input = \"%s%zu\"\n expect_match = true\n}\n",
+                                   i % 2 == 0 ? "" : "x", i);
+    }
+
+    void *serial = rift_test_run_source(source);
+    rift_test_run_options_t options = {4};
+    void *parallel = rift_test_run_source_with_options(source, &options);
+    assert(serial != NULL && parallel != NULL);
+    assert(rift_test_get_error(parallel) == NULL);
+
+    size_t total = 0, passed = 0, failed = 0;
+    assert(rift_test_get_summary(parallel, &total, &passed, &failed));
+    assert(total == NUM_GENERATED_TESTS);
+    assert(passed == NUM_GENERATED_TESTS / 2 && failed == NUM_GENERATED_TESTS / 2);
+
+    for (size_t i = 0; i < NUM_GENERATED_TESTS; i++) {
+        rift_test_result_t expected;
+        rift_test_result_t actual;
+        assert(rift_test_get_result(serial, i, &expected));
+        assert(rift_test_get_result(parallel, i, &actual));
+        assert(strcmp(expected.test_input, actual.test_input) == 0);
+        assert(expected.passed == actual.passed);
+        assert(actual.passed == (i % 2 == 0));
+        assert(actual.compile_ns > 0);
+    }
+
+    rift_test_free_results(serial);
+    rift_test_free_results(parallel);
+    free(source);
+    printf("test_runner_parallel: PASSED\n");
+}
+
+/* Test that a test case before any pattern is an error */
+void
+test_runner_errors(void)
+{
+    void *run = rift_test_run_source("@test_case {\n input = \"a\"\n expect_match = true\n}\n");
+    assert(run != NULL);
+    assert(rift_test_get_error(run) != NULL);
+    assert(rift_test_get_result_count(run) == 0);
+    rift_test_free_results(run);
+
+    assert(rift_test_run_file("/nonexistent/tests.rift") == NULL);
+    printf("test_runner_errors: PASSED\n");
+}
+
+/* Test that benchmarks run on inline inputs and corpus files when asked */
+void
+test_runner_bench(void)
+{
+    char dir[] = "/tmp/rift_bench_XXXXXX";
+    assert(mkdtemp(dir) != NULL);
+    char path[256];
+    for (int i = 0; i < 2; i++) {
+        snprintf(path, sizeof(path), "%s/corpus%d.txt", dir, i);
+        FILE *corpus = fopen(path, "w");
+        assert(corpus != NULL);
+        fputs("abc 12 abc 345", corpus);
+        fclose(corpus);
+    }
+
+    // The corpus glob is relative to the directory of the file
+    snprintf(path, sizeof(path), "%s/bench.rift", dir);
+    FILE *file = fopen(path, "w");
+    assert(file != NULL);
+    fputs("@pattern DIGITS = \"[0-9]+\"\n"
+          "@pattern WORD = \"abc\"\n"
+          "@bench {\n    pattern = \"DIGITS\"\n    input = \"a1b22c333\"\n"
+          "    iterations = 50\n}\n"
+          "@bench {\n    corpus = \"corpus*.txt\"\n    iterations = 20\n    warmup = 0\n}\n",
+          file);
+    fclose(file);
+
+    // Without the option the benchmarks do not run
+    void *run = rift_test_run_file(path);
+    assert(run != NULL && rift_test_get_error(run) == NULL);
+    assert(rift_test_get_bench_count(run) == 0);
+    rift_test_free_results(run);
+
+    rift_test_run_options_t options = {1, true};
+    run = rift_test_run_file_with_options(path, &options);
+    assert(run != NULL && rift_test_get_error(run) == NULL);
+    assert(rift_test_get_bench_count(run) == 2);
+
+    rift_bench_result_t result;
+    assert(rift_test_get_bench_result(run, 0, &result));
+    assert(strcmp(result.pattern_name, "DIGITS") == 0 && result.pattern_index == 0);
+    assert(result.iterations == 50 && result.warmup == 5);
+    assert(result.input_count == 1 && result.input_bytes == 9 && result.matches == 3);
+    assert(result.median_ns_per_byte > 0.0 && result.matches_per_second > 0.0);
+    assert(result.p99_ns_per_byte >= result.median_ns_per_byte);
+    assert(result.mad_ns_per_byte >= 0.0);
+
+    assert(rift_test_get_bench_result(run, 1, &result));
+    assert(strcmp(result.pattern_name, "WORD") == 0 && result.pattern_index == 1);
+    assert(result.warmup == 0 && result.input_count == 2);
+    assert(result.input_bytes == 28 && result.matches == 4);
+    assert(!rift_test_get_bench_result(run, 2, &result));
+    rift_test_print_bench_results(run, false);
+    rift_test_print_bench_results(run, true);
+    rift_test_free_results(run);
+
+    // A corpus matching no file fails the run
+    void *missing = rift_test_run_source_with_options(
+        "@pattern WORD = \"abc\"\n@bench {\n    corpus = \"/nonexistent/*.txt\"\n}\n",
+        &options);
+    assert(missing != NULL && rift_test_get_error(missing) != NULL);
+    rift_test_free_results(missing);
+
+    for (int i = 0; i < 2; i++) {
+        snprintf(path, sizeof(path), "%s/corpus%d.txt", dir, i);
+        unlink(path);
+    }
+    snprintf(path, sizeof(path), "%s/bench.rift", dir);
+    unlink(path);
+    rmdir(dir);
+    printf("test_runner_bench: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running DSL test runner tests...\n");
+
+    test_runner_serial();
+    test_runner_parallel();
+    test_runner_errors();
+    test_runner_bench();
+
+    printf("All DSL test runner tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,161 @@
+/**
+ * @file async_test.c
+ * @brief Unit tests for completion-based matching in the LibRift regex engine
+ *
+ * This file contains test cases verifying that submitted jobs complete once
+ * each, through their callback or through the completion queue and its
+ * descriptor, and that deadlines, cancellation and freeing a busy pool end
+ * jobs with the right status.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <poll.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/engine/async.h"
+#include "core/engine/pattern.h"
+
+#define NUM_JOBS 1000
+
+/* Wait for the completion descriptor and drain the queue */
+static size_t
+wait_completions(rift_async_pool_t *pool, rift_async_completion_t *completions, size_t max)
+{
+    struct pollfd pfd = {rift_async_get_fd(pool), POLLIN, 0};
+    assert(poll(&pfd, 1, 5000) == 1);
+    return rift_async_poll(pool, completions, max);
+}
+
+/* Count completions delivered to callbacks */
+static void
+count_completion(const rift_async_completion_t *completion, void *user_data)
+{
+    assert(completion->status == RIFT_ASYNC_MATCHED);
+    atomic_fetch_add((atomic_int *)user_data, 1);
+}
+
+/* Test that queued completions match the inputs they were submitted with */
+void
+test_async_poll(void)
+{
+    rift_regex_error_t error = {RIFT_REGEX_ERROR_NONE};
+    rift_regex_pattern_t *pattern = rift_regex_compile("ab+c", RIFT_REGEX_FLAG_NONE, &error);
+    assert(pattern != NULL);
+    rift_async_pool_t *pool = rift_async_pool_create(4, RIFT_MATCHER_OPTION_NONE);
+    assert(pool != NULL);
+
+    static const char *inputs[] = {"--abbc", "nothing"};
+    for (size_t i = 0; i < NUM_JOBS; i++) {
+        uint64_t id = rift_async_submit(pool, pattern, inputs[i % 2], (size_t)-1,
+                                        RIFT_MATCHER_NO_DEADLINE, NULL, (void *)inputs[i % 2]);
+        assert(id != RIFT_ASYNC_NO_JOB);
+    }
+
+    bool *seen = (bool *)calloc(NUM_JOBS + 1, sizeof(bool));
+    assert(seen != NULL);
+    rift_async_completion_t completions[64];
+    size_t done = 0;
+    while (done < NUM_JOBS) {
+        size_t count = wait_completions(pool, completions, 64);
+        for (size_t k = 0; k < count; k++) {
+            assert(completions[k].job_id <= NUM_JOBS && !seen[completions[k].job_id]);
+            seen[completions[k].job_id] = true;
+            if (completions[k].user_data == inputs[0]) {
+                assert(completions[k].status == RIFT_ASYNC_MATCHED);
+                assert(completions[k].span.start == 2 && completions[k].span.end == 6);
+            } else {
+                assert(completions[k].status == RIFT_ASYNC_NO_MATCH);
+                assert(completions[k].span.start == RIFT_REGEX_SPAN_UNSET);
+            }
+        }
+        done += count;
+    }
+
+    /* The descriptor is not readable once the queue is empty */
+    struct pollfd pfd = {rift_async_get_fd(pool), POLLIN, 0};
+    assert(poll(&pfd, 1, 0) == 0);
+
+    free(seen);
+    rift_async_pool_free(pool);
+    rift_regex_pattern_free(pattern);
+    printf("test_async_poll: PASSED\n");
+}
+
+/* Test completions delivered through callbacks */
+void
+test_async_callback(void)
+{
+    rift_regex_error_t error = {RIFT_REGEX_ERROR_NONE};
+    rift_regex_pattern_t *pattern = rift_regex_compile("[0-9]+", RIFT_REGEX_FLAG_NONE, &error);
+    assert(pattern != NULL);
+    rift_async_pool_t *pool = rift_async_pool_create(0, RIFT_MATCHER_OPTION_NONE);
+    assert(pool != NULL);
+
+    atomic_int count = 0;
+    for (size_t i = 0; i < NUM_JOBS; i++) {
+        assert(rift_async_submit(pool, pattern, "id 42", (size_t)-1, RIFT_MATCHER_NO_DEADLINE,
+                                 count_completion, &count) != RIFT_ASYNC_NO_JOB);
+    }
+
+    /* Freeing the pool waits for every callback */
+    rift_async_pool_free(pool);
+    assert(atomic_load(&count) == NUM_JOBS);
+
+    rift_regex_pattern_free(pattern);
+    printf("test_async_callback: PASSED\n");
+}
+
+/* Test deadlines, cancellation and invalid parameters */
+void
+test_async_deadline_and_cancel(void)
+{
+    rift_regex_error_t error = {RIFT_REGEX_ERROR_NONE};
+    rift_regex_pattern_t *pattern = rift_regex_compile("abc", RIFT_REGEX_FLAG_NONE, &error);
+    assert(pattern != NULL);
+    rift_async_pool_t *pool = rift_async_pool_create(1, RIFT_MATCHER_OPTION_NONE);
+    assert(pool != NULL);
+    rift_async_completion_t completion;
+
+    /* A deadline that has already passed ends the job before it runs */
+    uint64_t id = rift_async_submit(pool, pattern, "abc", 3, rift_matcher_monotonic_ns(), NULL,
+                                    NULL);
+    assert(id != RIFT_ASYNC_NO_JOB);
+    assert(wait_completions(pool, &completion, 1) == 1);
+    assert(completion.job_id == id && completion.status == RIFT_ASYNC_TIMED_OUT);
+
+    /* A completed job can no longer be cancelled */
+    assert(!rift_async_cancel(pool, id));
+    assert(!rift_async_cancel(pool, RIFT_ASYNC_NO_JOB));
+
+    assert(rift_async_submit(NULL, pattern, "abc", 3, RIFT_MATCHER_NO_DEADLINE, NULL, NULL) ==
+           RIFT_ASYNC_NO_JOB);
+    assert(rift_async_submit(pool, NULL, "abc", 3, RIFT_MATCHER_NO_DEADLINE, NULL, NULL) ==
+           RIFT_ASYNC_NO_JOB);
+    assert(rift_async_submit(pool, pattern, NULL, 3, RIFT_MATCHER_NO_DEADLINE, NULL, NULL) ==
+           RIFT_ASYNC_NO_JOB);
+    assert(rift_async_get_fd(NULL) == -1);
+    assert(rift_async_poll(pool, &completion, 1) == 0);
+
+    rift_async_pool_free(pool);
+    rift_regex_pattern_free(pattern);
+    printf("test_async_deadline_and_cancel: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running async tests...\n");
+
+    test_async_poll();
+    test_async_callback();
+    test_async_deadline_and_cancel();
+
+    printf("All async tests PASSED!\n");
+    return 0;
+}
@@ -2,12 +2,16 @@
  * @file baseline_pattern_tests.c
  * @brief Unit tests for baseline regex pattern utilities
  *
- * Tests initialization, retrieval, and cleanup of baseline regex patterns.
+ * Tests initialization, retrieval, and cleanup of baseline regex patterns,
+ * and the DFA tables generated for them at build time.
  *
  * @copyright Copyright (c) 2025 LibRift Project
  * @license MIT License
  */
 
+#include <string.h>
+
+#include "librift/automaton/dfa_table.h"
 #include "librift/compiler/compiler.h"
 #include "librift/engine/pattern.h"
 #include "librift/errors/regex_error.h"
@@ -112,10 +116,58 @@ RIFT_TEST(baseline_patterns_matching)
     rift_baseline_patterns_cleanup();
 }
 
+/* Test the DFA tables of the baseline patterns */
+RIFT_TEST(baseline_patterns_tables)
+{
+    rift_regex_error_t error = {0};
+    const rift_dfa_table_t *table;
+
+    /* Test the identifier table with sample input */
+    table = rift_baseline_patterns_get_table(RIFT_BASELINE_PATTERN_IDENTIFIER);
+    RIFT_ASSERT(table != NULL, "Identifier table should be available");
+    RIFT_ASSERT(rift_dfa_table_matches(table, "valid_name", 10), "Should match valid identifier");
+    RIFT_ASSERT(!rift_dfa_table_matches(table, "1invalid", 8),
+                "Should not match identifier starting with number");
+    RIFT_ASSERT(rift_baseline_patterns_get_table(RIFT_BASELINE_PATTERN_IDENTIFIER) == table,
+                "Every request should return the same table");
+
+    /* Test the numeric table */
+    table = rift_baseline_patterns_get_table(RIFT_BASELINE_PATTERN_NUMERIC);
+    RIFT_ASSERT(table != NULL, "Numeric table should be available");
+    RIFT_ASSERT(rift_dfa_table_matches(table, "-123.45e10", 10),
+                "Should match scientific notation");
+    RIFT_ASSERT(!rift_dfa_table_matches(table, "abc", 3), "Should not match non-numeric string");
+
+    /* Test that the table agrees with one compiled now */
+    table = rift_baseline_patterns_get_table(RIFT_BASELINE_PATTERN_OPERATOR);
+    rift_dfa_table_t *compiled =
+        rift_baseline_patterns_compile_table(RIFT_BASELINE_PATTERN_OPERATOR, &error);
+    RIFT_ASSERT(table != NULL && compiled != NULL, "Operator table should be available");
+    RIFT_ASSERT(table->num_states == compiled->num_states &&
+                    table->start_state == compiled->start_state &&
+                    table->num_classes == compiled->num_classes,
+                "Table should have the shape of a freshly compiled one");
+    RIFT_ASSERT(memcmp(table->byte_class, compiled->byte_class, sizeof(table->byte_class)) == 0 &&
+                    memcmp(table->next, compiled->next,
+                           (size_t)table->num_states * table->num_classes *
+                               sizeof(uint32_t)) == 0,
+                "Table should have the transitions of a freshly compiled one");
+    rift_dfa_table_free(compiled);
+
+    /* Test invalid pattern type */
+    RIFT_ASSERT(rift_baseline_patterns_get_table(999) == NULL,
+                "Invalid pattern type should have no table");
+    RIFT_ASSERT(rift_baseline_patterns_get_source(999) == NULL,
+                "Invalid pattern type should have no source");
+
+    rift_baseline_patterns_cleanup();
+}
+
 /* Register tests with the test framework */
 RIFT_TEST_SUITE(baseline_patterns)
 {
     RIFT_TEST_RUN(baseline_patterns_init_cleanup);
     RIFT_TEST_RUN(baseline_patterns_get);
     RIFT_TEST_RUN(baseline_patterns_matching);
+    RIFT_TEST_RUN(baseline_patterns_tables);
 }
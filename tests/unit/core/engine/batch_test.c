@@ -0,0 +1,274 @@
+/**
+ * @file batch_test.c
+ * @brief Unit tests for batch matching in the LibRift regex engine
+ *
+ * This file contains test cases verifying that a batch fills the same
+ * result matrix as matching every input on its own, whatever the number of
+ * threads, the chunk size and NUMA replication, that an executor's patterns
+ * are left to it, and that it refuses invalid parameters.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/engine/batch.h"
+#include "core/engine/numa.h"
+#include "core/engine/pattern.h"
+
+#define NUM_PATTERNS 3
+#define NUM_INPUTS 5000
+
+static const char *pattern_strings[NUM_PATTERNS] = {"ab+c", "[0-9]+", "x(y|z)"};
+
+/* Compile the test patterns */
+static void
+compile_patterns(rift_regex_pattern_t **patterns)
+{
+    for (size_t j = 0; j < NUM_PATTERNS; j++) {
+        rift_regex_error_t error = {RIFT_REGEX_ERROR_NONE};
+        patterns[j] = rift_regex_compile(pattern_strings[j], RIFT_REGEX_FLAG_NONE, &error);
+        assert(patterns[j] != NULL);
+    }
+}
+
+/* Build inputs that match different subsets of the patterns */
+static char **
+create_inputs(size_t count)
+{
+    static const char *shapes[] = {"--abbbc--", "id %zu", "xz", "nothing", "abc xy"};
+    char **inputs = (char **)malloc(count * sizeof(char *));
+    assert(inputs != NULL);
+
+    for (size_t i = 0; i < count; i++) {
+        inputs[i] = (char *)malloc(32);
+        assert(inputs[i] != NULL);
+        snprintf(inputs[i], 32, shapes[i % 5], i);
+    }
+    return inputs;
+}
+
+/* Match one input against one pattern on its own */
+static void
+match_alone(const rift_regex_pattern_t *pattern, const char *input, rift_batch_result_t *result)
+{
+    rift_regex_matcher_t *matcher = rift_matcher_create(pattern, RIFT_MATCHER_OPTION_NONE);
+    assert(matcher != NULL);
+    assert(rift_matcher_set_input(matcher, input, strlen(input)));
+
+    result->span.start = RIFT_REGEX_SPAN_UNSET;
+    result->span.end = RIFT_REGEX_SPAN_UNSET;
+    result->matched = rift_matcher_find_next_spans(matcher, &result->span, 1, NULL);
+    rift_matcher_free(matcher);
+}
+
+/* Test that every thread count, chunk size and replication gives the sequential results */
+void
+test_batch_matches_sequential(void)
+{
+    rift_regex_pattern_t *patterns[NUM_PATTERNS];
+    compile_patterns(patterns);
+    char **inputs = create_inputs(NUM_INPUTS);
+
+    rift_batch_result_t *expected =
+        (rift_batch_result_t *)malloc(NUM_INPUTS * NUM_PATTERNS * sizeof(rift_batch_result_t));
+    rift_batch_result_t *results =
+        (rift_batch_result_t *)malloc(NUM_INPUTS * NUM_PATTERNS * sizeof(rift_batch_result_t));
+    assert(expected && results);
+    for (size_t i = 0; i < NUM_INPUTS; i++) {
+        for (size_t j = 0; j < NUM_PATTERNS; j++) {
+            match_alone(patterns[j], inputs[i], &expected[i * NUM_PATTERNS + j]);
+        }
+    }
+
+    const size_t thread_counts[] = {1, 2, 4, 0};
+    const size_t chunk_sizes[] = {1, 7, 0, NUM_INPUTS * 2};
+    size_t num_nodes = rift_numa_node_count();
+    for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]); t++) {
+        for (size_t c = 0; c < sizeof(chunk_sizes) / sizeof(chunk_sizes[0]); c++) {
+            for (int replicate = 0; replicate < 2; replicate++) {
+                rift_batch_stats_t stats = {0};
+                rift_batch_options_t options = {thread_counts[t], chunk_sizes[c],
+                                                RIFT_MATCHER_OPTION_NONE, &stats, replicate};
+                memset(results, 0xff, NUM_INPUTS * NUM_PATTERNS * sizeof(rift_batch_result_t));
+
+                assert(rift_match_batch((const rift_regex_pattern_t *const *)patterns,
+                                        NUM_PATTERNS, (const char *const *)inputs, NULL,
+                                        NUM_INPUTS, results, &options));
+                for (size_t k = 0; k < NUM_INPUTS * NUM_PATTERNS; k++) {
+                    assert(results[k].matched == expected[k].matched);
+                    assert(results[k].span.start == expected[k].span.start);
+                    assert(results[k].span.end == expected[k].span.end);
+                }
+                assert(stats.num_threads >= 1);
+                assert(thread_counts[t] == 0 || stats.num_threads <= thread_counts[t]);
+
+                /* Only several nodes get copies, never more than there are threads */
+                assert(replicate || stats.numa_nodes == 0);
+                assert(num_nodes > 1 || stats.numa_nodes == 0);
+                assert(stats.numa_nodes <= num_nodes && stats.numa_nodes <= stats.num_threads);
+            }
+        }
+    }
+
+    free(expected);
+    free(results);
+    for (size_t i = 0; i < NUM_INPUTS; i++) {
+        free(inputs[i]);
+    }
+    free(inputs);
+    for (size_t j = 0; j < NUM_PATTERNS; j++) {
+        rift_regex_pattern_free(patterns[j]);
+    }
+    printf("test_batch_matches_sequential: PASSED\n");
+}
+
+/* Executor taking the patterns whose flag is set in its state, or failing without a state */
+static bool
+execute_some(void *state, const rift_regex_pattern_t *const *patterns, size_t num_patterns,
+             const char *const *inputs, const size_t *lengths, size_t num_inputs,
+             rift_batch_result_t *results, bool *handled)
+{
+    const bool *take = (const bool *)state;
+    assert(lengths == NULL);
+    if (!take) {
+        return false;
+    }
+    for (size_t j = 0; j < num_patterns; j++) {
+        assert(!handled[j]);
+        if (!take[j]) {
+            continue;
+        }
+        for (size_t i = 0; i < num_inputs; i++) {
+            match_alone(patterns[j], inputs[i], &results[i * num_patterns + j]);
+        }
+        handled[j] = true;
+    }
+    return true;
+}
+
+/* Test that the threads match only the patterns an executor leaves */
+void
+test_batch_executor(void)
+{
+    rift_regex_pattern_t *patterns[NUM_PATTERNS];
+    compile_patterns(patterns);
+    const rift_regex_pattern_t *const *shared = (const rift_regex_pattern_t *const *)patterns;
+    char **inputs = create_inputs(NUM_INPUTS);
+
+    rift_batch_result_t *expected =
+        (rift_batch_result_t *)malloc(NUM_INPUTS * NUM_PATTERNS * sizeof(rift_batch_result_t));
+    rift_batch_result_t *results =
+        (rift_batch_result_t *)malloc(NUM_INPUTS * NUM_PATTERNS * sizeof(rift_batch_result_t));
+    assert(expected && results);
+    assert(rift_match_batch(shared, NUM_PATTERNS, (const char *const *)inputs, NULL, NUM_INPUTS,
+                            expected, NULL));
+
+    static const bool takes[][NUM_PATTERNS] = {{false, true, false}, {true, true, true}};
+    for (size_t t = 0; t < sizeof(takes) / sizeof(takes[0]); t++) {
+        rift_batch_executor_t executor = {"test", execute_some, (void *)takes[t]};
+        rift_batch_stats_t stats = {0};
+        rift_batch_options_t options = {4, 0, RIFT_MATCHER_OPTION_NONE, &stats, false, &executor};
+        memset(results, 0xff, NUM_INPUTS * NUM_PATTERNS * sizeof(rift_batch_result_t));
+
+        assert(rift_match_batch(shared, NUM_PATTERNS, (const char *const *)inputs, NULL,
+                                NUM_INPUTS, results, &options));
+        for (size_t k = 0; k < NUM_INPUTS * NUM_PATTERNS; k++) {
+            assert(results[k].matched == expected[k].matched);
+            assert(results[k].span.start == expected[k].span.start);
+            assert(results[k].span.end == expected[k].span.end);
+        }
+        assert(stats.offloaded == (t == 0 ? 1 : NUM_PATTERNS));
+        assert(t == 0 || stats.num_threads == 1);
+    }
+
+    /* A failing executor fails the batch */
+    rift_batch_executor_t failing = {"failing", execute_some, NULL};
+    rift_batch_options_t options = {4, 0, RIFT_MATCHER_OPTION_NONE, NULL, false, &failing};
+    assert(!rift_match_batch(shared, NUM_PATTERNS, (const char *const *)inputs, NULL, NUM_INPUTS,
+                             results, &options));
+
+    free(expected);
+    free(results);
+    for (size_t i = 0; i < NUM_INPUTS; i++) {
+        free(inputs[i]);
+    }
+    free(inputs);
+    for (size_t j = 0; j < NUM_PATTERNS; j++) {
+        rift_regex_pattern_free(patterns[j]);
+    }
+    printf("test_batch_executor: PASSED\n");
+}
+
+/* Test explicit lengths, which may stop short of the terminator */
+void
+test_batch_lengths(void)
+{
+    rift_regex_pattern_t *patterns[NUM_PATTERNS];
+    compile_patterns(patterns);
+
+    const char *inputs[] = {"abc123", "abc123", "xy"};
+    const size_t lengths[] = {6, 3, 1};
+    rift_batch_result_t results[3 * NUM_PATTERNS];
+    assert(rift_match_batch((const rift_regex_pattern_t *const *)patterns, NUM_PATTERNS, inputs,
+                            lengths, 3, results, NULL));
+
+    assert(results[0].matched && results[0].span.start == 0 && results[0].span.end == 3);
+    assert(results[1].matched && results[1].span.start == 3 && results[1].span.end == 6);
+    assert(results[3].matched && !results[4].matched);
+    assert(!results[7].matched && !results[8].matched);
+    assert(results[8].span.start == RIFT_REGEX_SPAN_UNSET);
+
+    for (size_t j = 0; j < NUM_PATTERNS; j++) {
+        rift_regex_pattern_free(patterns[j]);
+    }
+    printf("test_batch_lengths: PASSED\n");
+}
+
+/* Test invalid parameters and empty batches */
+void
+test_batch_invalid(void)
+{
+    rift_regex_pattern_t *patterns[NUM_PATTERNS];
+    compile_patterns(patterns);
+    const rift_regex_pattern_t *const *shared = (const rift_regex_pattern_t *const *)patterns;
+
+    const char *inputs[] = {"abc"};
+    rift_batch_result_t results[NUM_PATTERNS];
+    const rift_regex_pattern_t *missing[] = {patterns[0], NULL};
+
+    assert(!rift_match_batch(NULL, 1, inputs, NULL, 1, results, NULL));
+    assert(!rift_match_batch(shared, 1, NULL, NULL, 1, results, NULL));
+    assert(!rift_match_batch(shared, 1, inputs, NULL, 1, NULL, NULL));
+    assert(!rift_match_batch(missing, 2, inputs, NULL, 1, results, NULL));
+
+    /* Nothing to match is not an error */
+    rift_batch_stats_t stats = {0};
+    rift_batch_options_t options = {4, 0, RIFT_MATCHER_OPTION_NONE, &stats};
+    assert(rift_match_batch(shared, NUM_PATTERNS, NULL, NULL, 0, NULL, &options));
+    assert(stats.num_threads == 1 && stats.steals == 0);
+    assert(rift_match_batch(shared, 0, inputs, NULL, 1, NULL, NULL));
+
+    for (size_t j = 0; j < NUM_PATTERNS; j++) {
+        rift_regex_pattern_free(patterns[j]);
+    }
+    printf("test_batch_invalid: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running batch tests...\n");
+
+    test_batch_matches_sequential();
+    test_batch_lengths();
+    test_batch_invalid();
+    test_batch_executor();
+
+    printf("All batch tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,334 @@
+/**
+ * @file engine_differential_test.c
+ * @brief Differential fuzzing of the matching engines against each other
+ *
+ * Random patterns over a three-letter alphabet run on random inputs under
+ * every engine a matcher can be forced onto, and under its default choice,
+ * which takes captures to the one-pass and tagged DFAs. The engines must
+ * find the same matches, and the same captures wherever two engines both
+ * report them; a backtracker stopped by its timeout is left out of the
+ * comparison. Each run is also checked for performance cliffs: the steps an
+ * engine reports per attempt must stay within a bound linear in the input
+ * for every engine but the backtracker, and within a polynomial one for the
+ * backtracker, whose cliffs are reported without failing the test since its
+ * limits exist for them. Searches slower than a time bound are reported the same way.
+ *
+ * Every failure prints the seed, the pattern and the input. The seed and
+ * the number of cases come from RIFT_DIFF_SEED and RIFT_DIFF_ITERATIONS, so
+ * the same test runs as a long fuzzing session before a release:
+ *
+ *   RIFT_DIFF_SEED=$RANDOM RIFT_DIFF_ITERATIONS=1000000 ./engine_differential_test
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/runtime/matcher.h"
+
+#define DEFAULT_SEED 0x5eed2025u
+#define DEFAULT_ITERATIONS 500
+#define MAX_PATTERN 96
+#define MAX_INPUT 24
+#define MAX_DEPTH 3
+#define MAX_MATCHES (MAX_INPUT + 2)
+#define MAX_SPANS 8
+
+/* Steps per attempt allowed per input byte, with the pattern length for the backtracker */
+#define LINEAR_STEP_FACTOR 4
+#define BACKTRACK_STEP_FACTOR 8
+
+/* Time a search may take per input byte before it is reported, in nanoseconds */
+#define TIME_BOUND_NS_PER_BYTE 200000
+
+/* Timeout stopping a runaway backtracker, in milliseconds */
+#define BACKTRACK_TIMEOUT_MS 200
+
+/**
+ * @brief An engine a matcher can be forced onto
+ */
+typedef struct engine_case {
+    const char *name;             /**< Name in reports */
+    rift_matcher_option_t option; /**< Option forcing the engine */
+    bool linear;                  /**< Whether its steps must stay linear in the input */
+} engine_case_t;
+
+static const engine_case_t ENGINES[] = {
+    {"lazy DFA", RIFT_MATCHER_OPTION_LAZY_DFA, true},
+    {"Pike VM", RIFT_MATCHER_OPTION_PIKE_VM, true},
+    {"backtracker", RIFT_MATCHER_OPTION_BACKTRACK, false},
+    {"default", RIFT_MATCHER_OPTION_NONE, true},
+};
+#define ENGINE_COUNT (sizeof(ENGINES) / sizeof(ENGINES[0]))
+
+/**
+ * @brief What one engine made of one case
+ */
+typedef struct engine_run {
+    bool compiled;                                   /**< Whether the pattern compiled */
+    bool timed_out;                                  /**< Whether the timeout stopped a search */
+    size_t num_matches;                              /**< Matches found */
+    size_t num_spans[MAX_MATCHES];                   /**< Spans reported by each match */
+    rift_regex_span_t spans[MAX_MATCHES][MAX_SPANS]; /**< Spans of each match */
+    rift_match_stats_t stats;                        /**< Telemetry summed over the searches */
+    uint64_t elapsed_ns;                             /**< Time of all the searches */
+} engine_run_t;
+
+static uint64_t rng_state;
+static size_t failures;
+static size_t cliffs;
+
+/* xorshift64*, so a seed replays the same cases everywhere */
+static uint64_t
+next_random(void)
+{
+    rng_state ^= rng_state >> 12;
+    rng_state ^= rng_state << 25;
+    rng_state ^= rng_state >> 27;
+    return rng_state * 0x2545F4914F6CDD1DULL;
+}
+
+static size_t
+random_below(size_t bound)
+{
+    return (size_t)(next_random() % bound);
+}
+
+/* Append text to a pattern under construction, if it fits */
+static void
+append(char *pattern, size_t *length, const char *text)
+{
+    size_t add = strlen(text);
+    if (*length + add < MAX_PATTERN) {
+        memcpy(pattern + *length, text, add + 1);
+        *length += add;
+    }
+}
+
+static void generate_alternation(char *pattern, size_t *length, int depth);
+
+/* Generate an atom and its quantifier */
+static void
+generate_piece(char *pattern, size_t *length, int depth)
+{
+    static const char *const atoms[] = {"a", "b", "c", ".", "[ab]", "[^a]"};
+    static const char *const quantifiers[] = {"", "", "*", "+", "?"};
+
+    if (depth < MAX_DEPTH && random_below(4) == 0) {
+        append(pattern, length, "(");
+        generate_alternation(pattern, length, depth + 1);
+        append(pattern, length, ")");
+    } else {
+        append(pattern, length, atoms[random_below(sizeof(atoms) / sizeof(atoms[0]))]);
+    }
+    append(pattern, length,
+           quantifiers[random_below(sizeof(quantifiers) / sizeof(quantifiers[0]))]);
+}
+
+/* Generate one to three alternatives of one to three pieces */
+static void
+generate_alternation(char *pattern, size_t *length, int depth)
+{
+    size_t alternatives = 1 + random_below(3) / 2;
+    for (size_t i = 0; i < alternatives; i++) {
+        if (i > 0) {
+            append(pattern, length, "|");
+        }
+        size_t pieces = 1 + random_below(3);
+        for (size_t j = 0; j < pieces; j++) {
+            generate_piece(pattern, length, depth);
+        }
+    }
+}
+
+/* Run every search of a case on one engine */
+static void
+run_engine(const engine_case_t *engine, const char *pattern, const char *input, size_t length,
+           engine_run_t *run)
+{
+    memset(run, 0, sizeof(*run));
+
+    rift_regex_error_t error;
+    rift_regex_matcher_t *matcher =
+        rift_matcher_create_from_string(pattern, RIFT_REGEX_FLAG_NONE, engine->option, &error);
+    if (!matcher) {
+        return;
+    }
+    run->compiled = true;
+    assert(rift_matcher_set_stats_enabled(matcher, true));
+    assert(rift_matcher_set_timeout(matcher, BACKTRACK_TIMEOUT_MS));
+    assert(rift_matcher_set_input(matcher, input, length));
+
+    uint64_t begin = rift_matcher_monotonic_ns();
+    while (run->num_matches < MAX_MATCHES) {
+        size_t num_spans = 0;
+        if (!rift_matcher_find_next_spans(matcher, run->spans[run->num_matches], MAX_SPANS,
+                                          &num_spans)) {
+            break;
+        }
+        run->num_spans[run->num_matches++] = num_spans < MAX_SPANS ? num_spans : MAX_SPANS;
+    }
+    run->elapsed_ns = rift_matcher_monotonic_ns() - begin;
+    run->timed_out = rift_matcher_timed_out(matcher);
+    rift_matcher_get_total_stats(matcher, &run->stats);
+
+    rift_matcher_free(matcher);
+}
+
+/* Print what two engines made of a case */
+static void
+report_mismatch(uint64_t seed, size_t iteration, const char *pattern, const char *input,
+                const char *what, size_t a, size_t b, const engine_run_t *runs)
+{
+    fprintf(stderr, "MISMATCH (%s) seed=%llu case=%zu pattern=\"%s\" input=\"%s\"\n", what,
+            (unsigned long long)seed, iteration, pattern, input);
+    for (size_t e = 0; e < ENGINE_COUNT; e++) {
+        if (e != a && e != b) {
+            continue;
+        }
+        fprintf(stderr, "  %-12s", ENGINES[e].name);
+        for (size_t m = 0; m < runs[e].num_matches; m++) {
+            fprintf(stderr, " [%zu,%zu)", runs[e].spans[m][0].start, runs[e].spans[m][0].end);
+        }
+        fprintf(stderr, "\n");
+    }
+    failures++;
+}
+
+/* Compare two engines' matches, and their captures when both report them */
+static void
+compare_runs(uint64_t seed, size_t iteration, const char *pattern, const char *input,
+             const engine_run_t *runs, size_t a, size_t b)
+{
+    if (runs[a].num_matches != runs[b].num_matches) {
+        report_mismatch(seed, iteration, pattern, input, "match count", a, b, runs);
+        return;
+    }
+
+    for (size_t m = 0; m < runs[a].num_matches; m++) {
+        const rift_regex_span_t *left = runs[a].spans[m];
+        const rift_regex_span_t *right = runs[b].spans[m];
+        if (left[0].start != right[0].start || left[0].end != right[0].end) {
+            report_mismatch(seed, iteration, pattern, input, "match span", a, b, runs);
+            return;
+        }
+        if (runs[a].num_spans[m] <= 1 || runs[b].num_spans[m] <= 1) {
+            continue;
+        }
+        size_t spans = runs[a].num_spans[m] < runs[b].num_spans[m] ? runs[a].num_spans[m]
+                                                                   : runs[b].num_spans[m];
+        for (size_t s = 1; s < spans; s++) {
+            if (left[s].start != right[s].start || left[s].end != right[s].end) {
+                report_mismatch(seed, iteration, pattern, input, "capture", a, b, runs);
+                return;
+            }
+        }
+    }
+}
+
+/* Check one engine's steps and time against the bounds of its kind */
+static void
+check_bounds(uint64_t seed, size_t iteration, const char *pattern, const char *input,
+             size_t length, size_t e, const engine_run_t *run)
+{
+    uint64_t attempts = run->stats.attempts > 0 ? run->stats.attempts : 1;
+    uint64_t per_attempt = LINEAR_STEP_FACTOR * (uint64_t)(length + 1);
+    if (!ENGINES[e].linear) {
+        per_attempt *= BACKTRACK_STEP_FACTOR * (uint64_t)strlen(pattern);
+    }
+
+    bool steps_over = run->stats.steps > per_attempt * attempts;
+    bool time_over =
+        run->elapsed_ns > TIME_BOUND_NS_PER_BYTE * (uint64_t)(length + 1) * (run->num_matches + 1);
+    if (!steps_over && !time_over && !run->timed_out) {
+        return;
+    }
+
+    fprintf(stderr,
+            "%s (%s) seed=%llu case=%zu pattern=\"%s\" input=\"%s\" steps=%llu attempts=%llu "
+            "ns=%llu%s\n",
+            steps_over ? "CLIFF" : "SLOW", ENGINES[e].name,
+            (unsigned long long)seed, iteration, pattern, input,
+            (unsigned long long)run->stats.steps, (unsigned long long)attempts,
+            (unsigned long long)run->elapsed_ns, run->timed_out ? " timed out" : "");
+    if (ENGINES[e].linear && (steps_over || run->timed_out)) {
+        failures++;
+    } else {
+        cliffs++;
+    }
+}
+
+/* Test that random cases run the same on every engine */
+void
+test_engines_agree(uint64_t seed, size_t iterations)
+{
+    rng_state = seed ? seed : DEFAULT_SEED;
+    size_t compiled = 0;
+
+    for (size_t iteration = 0; iteration < iterations; iteration++) {
+        char pattern[MAX_PATTERN] = "";
+        size_t pattern_length = 0;
+        generate_alternation(pattern, &pattern_length, 0);
+
+        char input[MAX_INPUT + 1];
+        size_t length = random_below(MAX_INPUT + 1);
+        for (size_t i = 0; i < length; i++) {
+            input[i] = (char)('a' + random_below(3));
+        }
+        input[length] = '\0';
+
+        engine_run_t runs[ENGINE_COUNT];
+        for (size_t e = 0; e < ENGINE_COUNT; e++) {
+            run_engine(&ENGINES[e], pattern, input, length, &runs[e]);
+        }
+
+        /* The engines share the compiler, so a pattern compiles for all or none */
+        for (size_t e = 1; e < ENGINE_COUNT; e++) {
+            assert(runs[e].compiled == runs[0].compiled);
+        }
+        if (!runs[0].compiled) {
+            continue;
+        }
+        compiled++;
+
+        for (size_t e = 0; e < ENGINE_COUNT; e++) {
+            check_bounds(seed, iteration, pattern, input, length, e, &runs[e]);
+        }
+
+        /* Compare every engine that finished with the first one that did */
+        size_t reference = ENGINE_COUNT;
+        for (size_t e = 0; e < ENGINE_COUNT; e++) {
+            if (runs[e].timed_out) {
+                continue;
+            }
+            if (reference == ENGINE_COUNT) {
+                reference = e;
+            } else {
+                compare_runs(seed, iteration, pattern, input, runs, reference, e);
+            }
+        }
+    }
+
+    printf("%zu cases, %zu compiled, %zu slow searches reported\n", iterations, compiled, cliffs);
+    assert(compiled > 0);
+    assert(failures == 0);
+}
+
+int
+main(void)
+{
+    const char *seed_text = getenv("RIFT_DIFF_SEED");
+    const char *iterations_text = getenv("RIFT_DIFF_ITERATIONS");
+    uint64_t seed = seed_text ? strtoull(seed_text, NULL, 0) : DEFAULT_SEED;
+    size_t iterations =
+        iterations_text ? (size_t)strtoull(iterations_text, NULL, 0) : DEFAULT_ITERATIONS;
+
+    test_engines_agree(seed, iterations);
+
+    printf("Engine differential tests: PASSED\n");
+    return 0;
+}
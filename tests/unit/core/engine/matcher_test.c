@@ -10,10 +10,14 @@
  */
 
 #include <assert.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
+#include "core/automaton/lazy_dfa.h"
+#include "core/compiler/engine_plan.h"
 #include "librift/compiler/compiler.h"
 #include "librift/engine/matcher.h"
 
@@ -188,6 +192,54 @@ TEST(matcher_split)
     rift_matcher_free(matcher);
 }
 
+// Test single-pass replacement into a growable buffer
+TEST(matcher_replace_into)
+{
+    rift_regex_error_t error;
+    rift_regex_matcher_t *matcher = rift_matcher_create_from_string(
+        "([a-z]+)=([0-9]+)", RIFT_REGEX_DEFAULT, RIFT_MATCHER_DEFAULT, &error);
+    ASSERT(matcher != NULL, "Failed to create matcher");
+    ASSERT(rift_matcher_set_input(matcher, "a=1, bc=22;", 11), "Failed to set input");
+
+    rift_replacement_t *replacement = rift_replacement_compile("$2<-${1}", &error);
+    ASSERT(replacement != NULL, "Failed to compile replacement");
+
+    rift_output_buffer_t output;
+    rift_output_buffer_init(&output);
+    size_t num_replacements = 0;
+    ASSERT(rift_matcher_replace_into(matcher, replacement, &output, &num_replacements),
+           "Replace failed");
+    ASSERT(num_replacements == 2, "Should have 2 replacements");
+    ASSERT(strcmp(output.data, "1<-a, 22<-bc;") == 0, "Incorrect replacement result");
+
+    rift_output_buffer_free(&output);
+    rift_replacement_free(replacement);
+    rift_matcher_free(matcher);
+}
+
+// Test splitting into spans of the input
+TEST(matcher_split_spans)
+{
+    rift_regex_error_t error;
+    rift_regex_matcher_t *matcher =
+        rift_matcher_create_from_string(",", RIFT_REGEX_DEFAULT, RIFT_MATCHER_DEFAULT, &error);
+    ASSERT(matcher != NULL, "Failed to create matcher");
+    ASSERT(rift_matcher_set_input(matcher, "one,two,three", 13), "Failed to set input");
+
+    rift_regex_span_t parts[5];
+    size_t num_parts = 0;
+    ASSERT(rift_matcher_split_spans(matcher, parts, 5, &num_parts), "Split failed");
+    ASSERT(num_parts == 3, "Should have 3 parts");
+    ASSERT(parts[0].start == 0 && parts[0].end == 3, "First part incorrect");
+    ASSERT(parts[2].start == 8 && parts[2].end == 13, "Third part incorrect");
+
+    // The last entry holds the rest of the input
+    ASSERT(rift_matcher_split_spans(matcher, parts, 2, &num_parts), "Split failed");
+    ASSERT(num_parts == 2 && parts[1].start == 4 && parts[1].end == 13, "Rest incorrect");
+
+    rift_matcher_free(matcher);
+}
+
 // Test timeout functionality
 TEST(matcher_timeout)
 {
@@ -213,6 +265,53 @@ TEST(matcher_timeout)
     rift_matcher_free(matcher);
 }
 
+// Test cancellation through a flag and an absolute deadline
+TEST(matcher_cancel)
+{
+    rift_regex_error_t error;
+    rift_regex_matcher_t *matcher =
+        rift_matcher_create_from_string("a", RIFT_REGEX_DEFAULT, RIFT_MATCHER_DEFAULT, &error);
+    ASSERT(matcher != NULL, "Failed to create matcher");
+
+    // Enough matches for find_all to pass several timeout check intervals
+    size_t length = RIFT_MATCHER_TIMEOUT_CHECK_INTERVAL * 4;
+    char *input = malloc(length);
+    rift_regex_match_t *matches = malloc(sizeof(rift_regex_match_t) * length);
+    ASSERT(input && matches, "Allocation failed");
+    memset(input, 'a', length);
+    ASSERT(rift_matcher_set_input(matcher, input, length), "Failed to set input");
+
+    atomic_bool cancel;
+    atomic_init(&cancel, true);
+    ASSERT(rift_matcher_set_cancel_flag(matcher, &cancel), "Failed to set cancel flag");
+
+    size_t num_matches = 0;
+    rift_matcher_find_all(matcher, matches, length, &num_matches);
+    ASSERT(rift_matcher_timed_out(matcher), "Cancellation should have been seen");
+    ASSERT(num_matches < length, "Cancellation should stop the scan");
+
+    // A deadline already passed stops the scan as well
+    ASSERT(rift_matcher_set_cancel_flag(matcher, NULL), "Failed to clear cancel flag");
+    ASSERT(rift_matcher_set_deadline(matcher, rift_matcher_monotonic_ns()), "Failed to set deadline");
+    rift_matcher_set_position(matcher, 0);
+    num_matches = 0;
+    rift_matcher_find_all(matcher, matches, length, &num_matches);
+    ASSERT(rift_matcher_timed_out(matcher), "Deadline should have passed");
+    ASSERT(num_matches < length, "Deadline should stop the scan");
+
+    // Without either the whole input is scanned
+    ASSERT(rift_matcher_set_deadline(matcher, RIFT_MATCHER_NO_DEADLINE), "Failed to clear deadline");
+    rift_matcher_set_position(matcher, 0);
+    num_matches = 0;
+    ASSERT(rift_matcher_find_all(matcher, matches, length, &num_matches), "Find all failed");
+    ASSERT(!rift_matcher_timed_out(matcher), "No timeout expected");
+    ASSERT(num_matches == length, "Every character should match");
+
+    free(matches);
+    free(input);
+    rift_matcher_free(matcher);
+}
+
 // Test backtracking depth
 TEST(matcher_backtrack_depth)
 {
@@ -238,6 +337,261 @@ TEST(matcher_backtrack_depth)
     rift_matcher_free(matcher);
 }
 
+// Test limits taken from a registry and refreshed when it changes
+TEST(matcher_limit_registry)
+{
+    rift_regex_error_t error;
+    rift_regex_matcher_t *matcher =
+        rift_matcher_create_from_string("a", RIFT_REGEX_DEFAULT, RIFT_MATCHER_DEFAULT, &error);
+    ASSERT(matcher != NULL, "Failed to create matcher");
+
+    rift_backtrack_limit_registry_t *registry = rift_backtrack_limit_registry_create();
+    ASSERT(registry != NULL, "Failed to create registry");
+
+    // The limits are resolved once, when the registry is attached
+    ASSERT(rift_matcher_set_limit_registry(matcher, registry, 1, 0), "Failed to set registry");
+    ASSERT(matcher->limits.max_depth == 1000, "Global limits expected");
+    ASSERT(matcher->limits.generation == rift_backtrack_limit_registry_get_generation(registry),
+           "Limits should record their generation");
+
+    rift_backtrack_limit_config_t config = {200, 0, 0, RIFT_BACKTRACK_SCOPE_PATTERN, true};
+    ASSERT(rift_backtrack_limit_registry_register_pattern(registry, 1, &config),
+           "Failed to register pattern limits");
+    ASSERT(matcher->limits.max_depth == 1000, "Limits change only when a match starts");
+
+    ASSERT(rift_matcher_set_input(matcher, "a", 1), "Failed to set input");
+    rift_regex_match_t match;
+    ASSERT(rift_matcher_matches(matcher, &match), "Match failed");
+    ASSERT(matcher->limits.max_depth == 200, "Pattern limits expected after the change");
+    ASSERT(matcher->limits.generation == rift_backtrack_limit_registry_get_generation(registry),
+           "Limits should be current");
+
+    rift_matcher_free(matcher);
+    rift_backtrack_limit_registry_free(registry);
+}
+
+// Test per-search telemetry and its totals in a registry
+TEST(matcher_stats)
+{
+    rift_regex_error_t error;
+    rift_regex_matcher_t *matcher =
+        rift_matcher_create_from_string("b+c", RIFT_REGEX_DEFAULT, RIFT_MATCHER_DEFAULT, &error);
+    ASSERT(matcher != NULL, "Failed to create matcher");
+    ASSERT(rift_matcher_set_input(matcher, "aaabbc", 6), "Failed to set input");
+
+    // Nothing is recorded until telemetry is enabled
+    rift_match_stats_t stats;
+    ASSERT(rift_matcher_find_next(matcher, NULL), "Match failed");
+    ASSERT(rift_matcher_get_stats(matcher, &stats), "Failed to get stats");
+    ASSERT(stats.searches == 0 && stats.steps == 0, "Disabled matcher should record nothing");
+
+    rift_backtrack_limit_registry_t *registry = rift_backtrack_limit_registry_create();
+    ASSERT(registry != NULL, "Failed to create registry");
+    ASSERT(rift_matcher_set_limit_registry(matcher, registry, 7, 0), "Failed to set registry");
+    ASSERT(rift_matcher_set_stats_enabled(matcher, true), "Failed to enable stats");
+
+    ASSERT(rift_matcher_set_input(matcher, "aaabbc", 6), "Failed to set input");
+    ASSERT(rift_matcher_find_next(matcher, NULL), "Match failed");
+    ASSERT(rift_matcher_get_stats(matcher, &stats), "Failed to get stats");
+    ASSERT(stats.searches == 1, "One search expected");
+    ASSERT(stats.attempts >= 1 && stats.steps >= 3, "The match should be counted");
+    ASSERT(stats.engine != RIFT_MATCH_ENGINE_NONE && stats.engine_attempts[stats.engine] >= 1,
+           "The engine should be recorded");
+    ASSERT(stats.attempts + stats.prefilter_skips >= 4,
+           "Start positions before the match are attempted or skipped");
+
+    // A failed search is recorded too, and both land in the totals
+    ASSERT(!rift_matcher_find_next(matcher, NULL), "No second match expected");
+    rift_match_stats_t total;
+    ASSERT(rift_matcher_get_total_stats(matcher, &total), "Failed to get totals");
+    ASSERT(total.searches == 2, "Both searches should be summed");
+
+    rift_match_stats_t pattern_stats;
+    ASSERT(rift_backtrack_limit_registry_get_pattern_stats(registry, 7, &pattern_stats),
+           "The registry should have the pattern's telemetry");
+    ASSERT(pattern_stats.searches == total.searches && pattern_stats.steps == total.steps,
+           "The registry should hold the same totals");
+
+    rift_matcher_reset_stats(matcher);
+    ASSERT(rift_matcher_get_total_stats(matcher, &total) && total.searches == 0,
+           "Totals should be cleared");
+
+    rift_matcher_free(matcher);
+    rift_backtrack_limit_registry_free(registry);
+}
+
+// Test that memory budgets move searches to the Pike VM instead of failing them
+TEST(matcher_memory_budget)
+{
+    rift_regex_error_t error;
+    rift_regex_matcher_t *matcher = rift_matcher_create_from_string(
+        "b+c", RIFT_REGEX_DEFAULT, RIFT_MATCHER_OPTION_LAZY_DFA, &error);
+    ASSERT(matcher != NULL, "Failed to create matcher");
+    ASSERT(rift_matcher_set_stats_enabled(matcher, true), "Failed to enable stats");
+
+    // Too small for any lazy DFA state cache
+    ASSERT(rift_matcher_set_memory_budget(matcher, 64), "Failed to set budget");
+    ASSERT(rift_matcher_set_input(matcher, "aaabbc", 6), "Failed to set input");
+    rift_regex_match_t match;
+    ASSERT(rift_matcher_find_next(matcher, &match), "The budget should not lose the match");
+    ASSERT(match.start_pos == 3 && match.end_pos == 6, "Incorrect match");
+    rift_match_stats_t stats;
+    ASSERT(rift_matcher_get_stats(matcher, &stats), "Failed to get stats");
+    ASSERT(stats.budget_fallbacks >= 1 && stats.engine == RIFT_MATCH_ENGINE_PIKE_VM,
+           "The search should fall back to the Pike VM");
+    ASSERT(matcher->backtrack_stack->max_depth < 10000, "The backtracking depth should be capped");
+
+    // A budget that holds a cache keeps the lazy DFA
+    ASSERT(rift_matcher_set_memory_budget(matcher, 1 << 20), "Failed to set budget");
+    ASSERT(rift_matcher_set_input(matcher, "aaabbc", 6), "Failed to set input");
+    ASSERT(rift_matcher_find_next(matcher, &match), "Match failed");
+    ASSERT(rift_matcher_get_stats(matcher, &stats), "Failed to get stats");
+    ASSERT(stats.budget_fallbacks == 0 && stats.engine == RIFT_MATCH_ENGINE_LAZY_DFA,
+           "The lazy DFA should run");
+
+    // Pattern budgets in a registry apply the same way
+    rift_backtrack_limit_registry_t *registry = rift_backtrack_limit_registry_create();
+    ASSERT(registry != NULL, "Failed to create registry");
+    rift_backtrack_limit_config_t config = {0, 0, 0, RIFT_BACKTRACK_SCOPE_PATTERN, true, 64};
+    ASSERT(rift_backtrack_limit_registry_register_pattern(registry, 3, &config),
+           "Failed to register pattern limits");
+    ASSERT(rift_matcher_set_limit_registry(matcher, registry, 3, 0), "Failed to set registry");
+    ASSERT(rift_matcher_set_input(matcher, "aaabbc", 6), "Failed to set input");
+    ASSERT(rift_matcher_find_next(matcher, &match), "Match failed");
+    ASSERT(rift_matcher_get_stats(matcher, &stats), "Failed to get stats");
+    ASSERT(stats.budget_fallbacks >= 1, "The registry budget should apply");
+
+    rift_matcher_free(matcher);
+    rift_backtrack_limit_registry_free(registry);
+}
+
+// Test that the engine options force the engine of every search
+TEST(matcher_engine_options)
+{
+    const rift_matcher_option_t options[] = {RIFT_MATCHER_OPTION_LAZY_DFA,
+                                             RIFT_MATCHER_OPTION_PIKE_VM,
+                                             RIFT_MATCHER_OPTION_BACKTRACK};
+    const rift_match_engine_t engines[] = {RIFT_MATCH_ENGINE_LAZY_DFA, RIFT_MATCH_ENGINE_PIKE_VM,
+                                           RIFT_MATCH_ENGINE_BACKTRACKER};
+
+    for (size_t i = 0; i < 3; i++) {
+        rift_regex_error_t error;
+        rift_regex_matcher_t *matcher =
+            rift_matcher_create_from_string("b+c", RIFT_REGEX_DEFAULT, options[i], &error);
+        ASSERT(matcher != NULL, "Failed to create matcher");
+        ASSERT(rift_matcher_set_stats_enabled(matcher, true), "Failed to enable stats");
+        ASSERT(rift_matcher_set_input(matcher, "aaabbc", 6), "Failed to set input");
+
+        rift_regex_match_t match;
+        ASSERT(rift_matcher_find_next(matcher, &match), "Match failed");
+        ASSERT(match.start_pos == 3 && match.end_pos == 6, "Every engine should find the match");
+        rift_match_stats_t stats;
+        ASSERT(rift_matcher_get_stats(matcher, &stats), "Failed to get stats");
+        ASSERT(stats.engine == engines[i], "The forced engine should run");
+
+        rift_matcher_free(matcher);
+    }
+}
+
+// Test that exploding backtracking attempts move to the Pike VM
+TEST(matcher_engine_switch)
+{
+    rift_regex_error_t error;
+    rift_regex_matcher_t *matcher = rift_matcher_create_from_string(
+        "(a|aa)*c", RIFT_REGEX_DEFAULT, RIFT_MATCHER_OPTION_BACKTRACK, &error);
+    ASSERT(matcher != NULL, "Failed to create matcher");
+    ASSERT(rift_matcher_set_stats_enabled(matcher, true), "Failed to enable stats");
+
+    // Fibonacci many paths through 40 a's, none ending in c
+    char input[42];
+    memset(input, 'a', 40);
+    input[40] = 'b';
+    input[41] = '\0';
+    ASSERT(rift_matcher_set_input(matcher, input, 41), "Failed to set input");
+    rift_regex_match_t match;
+    ASSERT(!rift_matcher_find_next(matcher, &match), "No match expected");
+    ASSERT(!rift_matcher_timed_out(matcher), "The switch should not time out");
+    rift_match_stats_t stats;
+    ASSERT(rift_matcher_get_stats(matcher, &stats), "Failed to get stats");
+    ASSERT(stats.engine_switches >= 1 && stats.engine_attempts[RIFT_MATCH_ENGINE_PIKE_VM] >= 1,
+           "The attempt should switch to the Pike VM");
+
+    // A switched attempt still finds the match and its groups
+    input[40] = 'c';
+    ASSERT(rift_matcher_set_input(matcher, input, 41), "Failed to set input");
+    ASSERT(rift_matcher_find_next(matcher, &match), "The switch should not lose the match");
+    ASSERT(match.start_pos == 0 && match.end_pos == 41, "Incorrect match");
+
+    // Short, well-behaved attempts stay on the backtracker
+    ASSERT(rift_matcher_set_input(matcher, "aaac", 4), "Failed to set input");
+    ASSERT(rift_matcher_find_next(matcher, &match), "Match failed");
+    ASSERT(rift_matcher_get_stats(matcher, &stats), "Failed to get stats");
+    ASSERT(stats.engine_switches == 0 && stats.engine == RIFT_MATCH_ENGINE_BACKTRACKER,
+           "The backtracker should finish the attempt");
+
+    // Without the switch, the transition limit stops the search
+    ASSERT(rift_matcher_set_engine_switch(matcher, 0), "Failed to disable the switch");
+    rift_backtrack_limit_registry_t *registry = rift_backtrack_limit_registry_create();
+    ASSERT(registry != NULL, "Failed to create registry");
+    rift_backtrack_limit_config_t config = {0, 0, 1000, RIFT_BACKTRACK_SCOPE_PATTERN, true, 0};
+    ASSERT(rift_backtrack_limit_registry_register_pattern(registry, 5, &config),
+           "Failed to register pattern limits");
+    ASSERT(rift_matcher_set_limit_registry(matcher, registry, 5, 0), "Failed to set registry");
+    input[40] = 'b';
+    ASSERT(rift_matcher_set_input(matcher, input, 41), "Failed to set input");
+    ASSERT(!rift_matcher_find_next(matcher, &match), "No match expected");
+    ASSERT(rift_matcher_timed_out(matcher), "The transition limit should stop the search");
+
+    rift_matcher_free(matcher);
+    rift_backtrack_limit_registry_free(registry);
+}
+
+// Test that budgeted steps yield and resume a search
+TEST(matcher_step)
+{
+    rift_regex_error_t error;
+    rift_regex_matcher_t *matcher = rift_matcher_create_from_string(
+        "[ab][0-9]+[cd]", RIFT_REGEX_DEFAULT, RIFT_MATCHER_OPTION_BACKTRACK, &error);
+    ASSERT(matcher != NULL, "Failed to create matcher");
+    ASSERT(rift_matcher_set_stats_enabled(matcher, true), "Failed to enable stats");
+
+    // Every start position is a candidate, and only the last one matches
+    char input[203];
+    memset(input, 'a', 200);
+    memcpy(input + 200, "1c", 3);
+    ASSERT(rift_matcher_set_input(matcher, input, 202), "Failed to set input");
+
+    rift_regex_match_t match;
+    rift_match_status_t status = RIFT_MATCH_PENDING;
+    size_t calls = 0;
+    while (status == RIFT_MATCH_PENDING && calls < 1000) {
+        rift_matcher_step(matcher, 16, &match, &status);
+        calls++;
+    }
+    ASSERT(status == RIFT_MATCH_FOUND, "The resumed search should find the match");
+    ASSERT(calls > 10, "The search should yield between calls");
+    ASSERT(match.start_pos == 199 && match.end_pos == 202, "Incorrect match");
+
+    rift_match_stats_t total;
+    ASSERT(rift_matcher_get_total_stats(matcher, &total), "Failed to get totals");
+    ASSERT(total.searches == 1, "The calls should make one search");
+
+    // The next search ends at the end of the input
+    ASSERT(!rift_matcher_step(matcher, 16, &match, &status) && status == RIFT_MATCH_NOT_FOUND,
+           "No second match expected");
+
+    // A new input abandons a pending search
+    ASSERT(rift_matcher_set_input(matcher, input, 202), "Failed to set input");
+    ASSERT(!rift_matcher_step(matcher, 1, &match, &status) && status == RIFT_MATCH_PENDING,
+           "One step should not finish the search");
+    ASSERT(rift_matcher_set_input(matcher, "a12c", 4), "Failed to set input");
+    ASSERT(rift_matcher_step(matcher, 1000, &match, &status) && status == RIFT_MATCH_FOUND,
+           "The search should start over");
+    ASSERT(match.start_pos == 0 && match.end_pos == 4, "Incorrect match");
+
+    rift_matcher_free(matcher);
+}
+
 // Test position getting and setting
 TEST(matcher_position)
 {
@@ -260,6 +614,575 @@ TEST(matcher_position)
     rift_matcher_free(matcher);
 }
 
+// Collects streamed match spans
+typedef struct {
+    rift_regex_span_t spans[16];
+    size_t count;
+} stream_matches_t;
+
+static bool
+collect_stream_match(const rift_regex_span_t *spans, size_t num_spans, void *user_data)
+{
+    stream_matches_t *matches = (stream_matches_t *)user_data;
+    if (num_spans > 0 && matches->count < 16) {
+        matches->spans[matches->count++] = spans[0];
+    }
+    return true;
+}
+
+// Test streaming input in chunks
+TEST(matcher_stream)
+{
+    rift_regex_error_t error;
+    rift_regex_matcher_t *matcher =
+        rift_matcher_create_from_string("a+", RIFT_REGEX_DEFAULT, RIFT_MATCHER_DEFAULT, &error);
+    ASSERT(matcher != NULL, "Failed to create matcher");
+
+    stream_matches_t matches = {0};
+    ASSERT(!rift_matcher_feed(matcher, "a", 1, false), "Feeding needs a callback");
+    ASSERT(rift_matcher_set_stream_callback(matcher, collect_stream_match, &matches),
+           "Failed to set callback");
+
+    // "aaa bbb aaa" split inside both matches
+    ASSERT(rift_matcher_feed(matcher, "aa", 2, false), "Feed failed");
+    ASSERT(matches.count == 0, "Match may still grow");
+    ASSERT(rift_matcher_feed(matcher, "a bbb a", 7, false), "Feed failed");
+    ASSERT(matches.count == 1, "First match should be complete");
+    ASSERT(rift_matcher_feed(matcher, "aa", 2, true), "Feed failed");
+
+    ASSERT(matches.count == 2, "Should stream 2 matches");
+    ASSERT(matches.spans[0].start == 0 && matches.spans[0].end == 3, "First match incorrect");
+    ASSERT(matches.spans[1].start == 8 && matches.spans[1].end == 11, "Second match incorrect");
+
+    // The stream starts over after the last chunk
+    matches.count = 0;
+    ASSERT(rift_matcher_feed(matcher, "ba", 2, true), "Feed failed");
+    ASSERT(matches.count == 1 && matches.spans[0].start == 1, "Offsets should restart");
+
+    rift_matcher_free(matcher);
+}
+
+// Test span-only match results
+TEST(matcher_spans)
+{
+    rift_regex_error_t error;
+    rift_regex_matcher_t *matcher = rift_matcher_create_from_string("(a)(b)?c", RIFT_REGEX_DEFAULT,
+                                                                    RIFT_MATCHER_DEFAULT, &error);
+    ASSERT(matcher != NULL, "Failed to create matcher");
+    ASSERT(rift_matcher_set_input(matcher, "xxac", 4), "Failed to set input");
+
+    rift_regex_span_t spans[3];
+    size_t num_spans = 0;
+    ASSERT(rift_matcher_find_next_spans(matcher, spans, 3, &num_spans), "Failed to find pattern");
+    ASSERT(num_spans == 3, "Should have the match and 2 groups");
+    ASSERT(spans[0].start == 2 && spans[0].end == 4, "Incorrect match span");
+    ASSERT(spans[1].start == 2 && spans[1].end == 3, "Incorrect group span");
+    ASSERT(spans[2].start == RIFT_REGEX_SPAN_UNSET, "Group 2 did not participate");
+
+    char text[8];
+    ASSERT(rift_matcher_copy_span_text(matcher, &spans[0], text, sizeof(text)) == 2,
+           "Incorrect span length");
+    ASSERT(strcmp(text, "ac") == 0, "Incorrect span text");
+
+    rift_matcher_free(matcher);
+}
+
+// Stops after the first match
+static bool
+stop_after_first(const rift_regex_span_t *spans, size_t num_spans, void *user_data)
+{
+    collect_stream_match(spans, num_spans, user_data);
+    return false;
+}
+
+// Test visiting matches through a callback
+TEST(matcher_for_each_match)
+{
+    rift_regex_error_t error;
+    rift_regex_matcher_t *matcher =
+        rift_matcher_create_from_string("a+", RIFT_REGEX_DEFAULT, RIFT_MATCHER_DEFAULT, &error);
+    ASSERT(matcher != NULL, "Failed to create matcher");
+    ASSERT(rift_matcher_set_input(matcher, "aaa bbb aaa b a", 15), "Failed to set input");
+
+    stream_matches_t matches = {0};
+    ASSERT(rift_matcher_for_each_match(matcher, collect_stream_match, &matches),
+           "Visiting matches failed");
+    ASSERT(matches.count == 3, "Should visit 3 matches");
+    ASSERT(matches.spans[0].start == 0 && matches.spans[0].end == 3, "First match incorrect");
+    ASSERT(matches.spans[2].start == 14 && matches.spans[2].end == 15, "Last match incorrect");
+
+    // The callback ends the search early
+    matches.count = 0;
+    ASSERT(rift_matcher_for_each_match(matcher, stop_after_first, &matches),
+           "Visiting matches failed");
+    ASSERT(matches.count == 1, "Should stop after the first match");
+
+    ASSERT(!rift_matcher_for_each_match(matcher, NULL, NULL), "Callback is required");
+
+    rift_matcher_free(matcher);
+}
+
+// Collects any number of match spans
+typedef struct {
+    rift_regex_span_t *spans;
+    size_t count;
+    size_t capacity;
+} span_list_t;
+
+static bool
+append_span(const rift_regex_span_t *spans, size_t num_spans, void *user_data)
+{
+    span_list_t *list = (span_list_t *)user_data;
+    if (num_spans == 0) {
+        return true;
+    }
+    if (list->count == list->capacity) {
+        list->capacity = list->capacity ? list->capacity * 2 : 256;
+        list->spans = realloc(list->spans, list->capacity * sizeof(rift_regex_span_t));
+        assert(list->spans != NULL);
+    }
+    list->spans[list->count++] = spans[0];
+    return true;
+}
+
+// Test a parallel search against the sequential one
+TEST(matcher_find_all_parallel)
+{
+    rift_regex_error_t error;
+    rift_regex_matcher_t *matcher =
+        rift_matcher_create_from_string("ab+|bc", RIFT_REGEX_DEFAULT, RIFT_MATCHER_DEFAULT, &error);
+    ASSERT(matcher != NULL, "Failed to create matcher");
+
+    // Runs of b of every length, so matches cross the chunk boundaries
+    size_t length = 4 * RIFT_MATCHER_PARALLEL_MIN_CHUNK + 123;
+    char *input = malloc(length + 1);
+    ASSERT(input != NULL, "Failed to allocate input");
+    unsigned int seed = 7;
+    for (size_t i = 0; i < length; i++) {
+        seed = seed * 1103515245u + 12345u;
+        unsigned int r = (seed >> 16) % 10;
+        input[i] = r < 2 ? 'a' : r < 8 ? 'b' : 'c';
+    }
+    input[length] = '\0';
+
+    span_list_t expected = {0};
+    ASSERT(rift_matcher_set_input(matcher, input, length), "Failed to set input");
+    ASSERT(rift_matcher_for_each_match(matcher, append_span, &expected),
+           "Sequential search failed");
+    ASSERT(expected.count > 0, "The input should have matches");
+
+    const size_t thread_counts[] = {1, 3, 4, 16};
+    for (size_t i = 0; i < sizeof(thread_counts) / sizeof(thread_counts[0]); i++) {
+        span_list_t found = {0};
+        ASSERT(rift_matcher_find_all_parallel(rift_matcher_get_pattern(matcher), input, length,
+                                              thread_counts[i], append_span, &found),
+               "Parallel search failed");
+        ASSERT(found.count == expected.count, "Parallel search should find the same matches");
+        ASSERT(memcmp(found.spans, expected.spans, found.count * sizeof(rift_regex_span_t)) == 0,
+               "Parallel matches should be the sequential ones, in order");
+        free(found.spans);
+    }
+
+    // The callback ends the search early
+    stream_matches_t first = {0};
+    ASSERT(rift_matcher_find_all_parallel(rift_matcher_get_pattern(matcher), input, length, 4,
+                                          stop_after_first, &first),
+           "Parallel search failed");
+    ASSERT(first.count == 1 && first.spans[0].start == expected.spans[0].start,
+           "Should stop after the first match");
+
+    ASSERT(!rift_matcher_find_all_parallel(NULL, input, length, 4, append_span, NULL),
+           "Pattern is required");
+
+    free(expected.spans);
+    free(input);
+    rift_matcher_free(matcher);
+}
+
+// Test scanning a memory-mapped file
+TEST(matcher_find_all_file)
+{
+    rift_regex_error_t error;
+    rift_regex_matcher_t *matcher =
+        rift_matcher_create_from_string("a+", RIFT_REGEX_DEFAULT, RIFT_MATCHER_DEFAULT, &error);
+    ASSERT(matcher != NULL, "Failed to create matcher");
+
+    char path[] = "/tmp/rift_matcher_testXXXXXX";
+    int fd = mkstemp(path);
+    ASSERT(fd >= 0, "Failed to create temporary file");
+    ASSERT(write(fd, "aaa bbb aaa", 11) == 11, "Failed to write temporary file");
+    close(fd);
+
+    ASSERT(rift_matcher_set_input(matcher, "xa", 2), "Failed to set input");
+
+    stream_matches_t matches = {0};
+    ASSERT(rift_matcher_find_all_file(matcher, path, collect_stream_match, &matches),
+           "Failed to scan file");
+    ASSERT(matches.count == 2, "Should find 2 matches");
+    ASSERT(matches.spans[1].start == 8 && matches.spans[1].end == 11, "Second match incorrect");
+
+    // The previous input is back after the scan
+    ASSERT(strcmp(rift_matcher_get_input(matcher), "xa") == 0, "Input should be restored");
+    ASSERT(!rift_matcher_find_all_file(matcher, "/nonexistent/file", collect_stream_match,
+                                       &matches),
+           "Missing file should fail");
+
+    unlink(path);
+    rift_matcher_free(matcher);
+}
+
+// Test saving the lazy DFA states of one matcher and loading them into another
+TEST(matcher_dfa_cache)
+{
+    rift_regex_error_t error;
+    rift_regex_matcher_t *cold = rift_matcher_create_from_string(
+        "[a-c]+x[0-9]", RIFT_REGEX_DEFAULT, RIFT_MATCHER_OPTION_LAZY_DFA, &error);
+    ASSERT(cold != NULL, "Failed to create matcher");
+    const char *input = "abcabx1 cax9 bbbx";
+    ASSERT(rift_matcher_set_input(cold, input, strlen(input)), "Failed to set input");
+    size_t count = rift_matcher_count(cold);
+    ASSERT(count == 2, "Should count 2 matches");
+    ASSERT(cold->lazy_dfa != NULL && rift_lazy_dfa_cached_states(cold->lazy_dfa) > 0,
+           "The search should build lazy DFA states");
+
+    char path[] = "/tmp/rift_matcher_dfaXXXXXX";
+    int fd = mkstemp(path);
+    ASSERT(fd >= 0, "Failed to create temporary file");
+    close(fd);
+    ASSERT(rift_matcher_save_dfa_cache(cold, path), "Failed to save cache");
+
+    // The loaded matcher finds the same matches without building states
+    rift_regex_matcher_t *warm = rift_matcher_create_from_string(
+        "[a-c]+x[0-9]", RIFT_REGEX_DEFAULT, RIFT_MATCHER_OPTION_LAZY_DFA, &error);
+    ASSERT(warm != NULL, "Failed to create matcher");
+    ASSERT(rift_matcher_load_dfa_cache(warm, path), "Failed to load cache");
+    ASSERT(rift_lazy_dfa_cached_states(warm->lazy_dfa) ==
+               rift_lazy_dfa_cached_states(cold->lazy_dfa),
+           "The cached states should be loaded");
+    ASSERT(rift_matcher_set_input(warm, input, strlen(input)), "Failed to set input");
+    ASSERT(rift_matcher_count(warm) == count, "Loaded matcher should count the same matches");
+    ASSERT(warm->lazy_dfa->stats.states_built == 0, "No state should be built again");
+
+    // A cache saved for another pattern is refused
+    rift_regex_matcher_t *other = rift_matcher_create_from_string(
+        "[a-c]+y[0-9]", RIFT_REGEX_DEFAULT, RIFT_MATCHER_OPTION_LAZY_DFA, &error);
+    ASSERT(other != NULL, "Failed to create matcher");
+    ASSERT(!rift_matcher_load_dfa_cache(other, path), "Another pattern's cache should fail");
+    ASSERT(!rift_matcher_load_dfa_cache(warm, "/nonexistent/file"), "Missing file should fail");
+
+    unlink(path);
+    rift_matcher_free(other);
+    rift_matcher_free(warm);
+    rift_matcher_free(cold);
+}
+
+// Count matches through the span callback
+static bool
+count_match(const rift_regex_span_t *spans, size_t num_spans, void *user_data)
+{
+    (void)spans;
+    (void)num_spans;
+    (*(size_t *)user_data)++;
+    return true;
+}
+
+// Test the existence and counting modes against the span searches
+TEST(matcher_is_match_count)
+{
+    const char *patterns[] = {"ab+|bc", "(a)(b+)", "x*", "(?<w>[a-c]+)d"};
+    const char *inputs[] = {"", "xyz", "abbb bc abd", "cab bcbc", "aaad"};
+    rift_regex_error_t error;
+
+    for (size_t p = 0; p < sizeof(patterns) / sizeof(patterns[0]); p++) {
+        rift_regex_matcher_t *matcher = rift_matcher_create_from_string(
+            patterns[p], RIFT_REGEX_DEFAULT, RIFT_MATCHER_DEFAULT, &error);
+        ASSERT(matcher != NULL, "Failed to create matcher");
+
+        for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+            ASSERT(rift_matcher_set_input(matcher, inputs[i], (size_t)-1), "Failed to set input");
+            size_t expected = 0;
+            ASSERT(rift_matcher_for_each_match(matcher, count_match, &expected),
+                   "Span search failed");
+
+            ASSERT(rift_matcher_set_position(matcher, 0), "Failed to set position");
+            ASSERT(rift_matcher_is_match(matcher) == (expected > 0),
+                   "is_match should agree with the span search");
+            ASSERT(rift_matcher_count(matcher) == expected,
+                   "count should agree with the span search");
+            ASSERT(rift_matcher_get_position(matcher) == 0, "Position should be unchanged");
+        }
+        rift_matcher_free(matcher);
+    }
+
+    ASSERT(!rift_matcher_is_match(NULL), "Matcher is required");
+    ASSERT(rift_matcher_count(NULL) == 0, "Matcher is required");
+}
+
+// Matches of a line-mode search, with their line numbers
+typedef struct {
+    size_t lines[16];
+    rift_regex_span_t line_spans[16];
+    rift_regex_span_t spans[16];
+    char texts[16][16];
+    size_t count;
+    rift_regex_matcher_t *matcher;
+} line_matches_t;
+
+static bool
+collect_line_match(size_t line_number, const rift_regex_span_t *line,
+                   const rift_regex_span_t *spans, size_t num_spans, void *user_data)
+{
+    (void)num_spans;
+    line_matches_t *matches = (line_matches_t *)user_data;
+    if (matches->count == 16) {
+        return false;
+    }
+    matches->lines[matches->count] = line_number;
+    matches->line_spans[matches->count] = *line;
+    matches->spans[matches->count] = spans[0];
+    rift_matcher_copy_span_text(matches->matcher, &spans[0], matches->texts[matches->count],
+                                sizeof(matches->texts[0]));
+    matches->count++;
+    return true;
+}
+
+// Test line mode, with anchors at every line and over a mapped file
+TEST(matcher_line_mode)
+{
+    rift_regex_error_t error;
+    rift_regex_matcher_t *matcher =
+        rift_matcher_create_from_string("^err[a-z]*$", RIFT_REGEX_DEFAULT, RIFT_MATCHER_DEFAULT,
+                                        &error);
+    ASSERT(matcher != NULL, "Failed to create matcher");
+
+    // ^ and $ hold at each line, and lines without the literal are skipped
+    const char *input = "error\nok\n\nerrors x\nerrand\n";
+    ASSERT(rift_matcher_set_input(matcher, input, (size_t)-1), "Failed to set input");
+    ASSERT(rift_matcher_set_position(matcher, 2), "Failed to set position");
+    line_matches_t matches = {0};
+    matches.matcher = matcher;
+    ASSERT(rift_matcher_for_each_line_match(matcher, collect_line_match, &matches),
+           "Line search failed");
+    ASSERT(matches.count == 2, "Should match 2 lines");
+    ASSERT(matches.lines[0] == 1 && matches.lines[1] == 5, "Line numbers incorrect");
+    ASSERT(matches.line_spans[1].start == 19 && matches.line_spans[1].end == 25,
+           "Line span incorrect");
+    ASSERT(matches.spans[1].start == 0 && matches.spans[1].end == 6,
+           "Spans should be offsets into the line");
+    ASSERT(strcmp(matches.texts[1], "errand") == 0, "Match text should come from the line");
+
+    // The input and position are back after the search
+    ASSERT(strcmp(rift_matcher_get_input(matcher), input) == 0, "Input should be restored");
+    ASSERT(rift_matcher_get_position(matcher) == 2, "Position should be restored");
+
+    char path[] = "/tmp/rift_matcher_linesXXXXXX";
+    int fd = mkstemp(path);
+    ASSERT(fd >= 0, "Failed to create temporary file");
+    ASSERT(write(fd, "x\nerr\nerr err", 13) == 13, "Failed to write temporary file");
+    close(fd);
+
+    line_matches_t file_matches = {0};
+    file_matches.matcher = matcher;
+    ASSERT(rift_matcher_find_all_lines_file(matcher, path, collect_line_match, &file_matches),
+           "Failed to scan file");
+    ASSERT(file_matches.count == 1 && file_matches.lines[0] == 2, "Should match line 2 only");
+    ASSERT(file_matches.line_spans[0].start == 2 && file_matches.line_spans[0].end == 5,
+           "Line span should be an offset into the file");
+    ASSERT(!rift_matcher_for_each_line_match(matcher, NULL, NULL), "Callback is required");
+
+    unlink(path);
+    rift_matcher_free(matcher);
+}
+
+// Test that the match-length bounds limit searches without losing matches
+TEST(matcher_match_length)
+{
+    rift_regex_error_t error;
+    rift_regex_matcher_t *matcher = rift_matcher_create_from_string(
+        "[0-9]{4}-[0-9]{2}", RIFT_REGEX_DEFAULT, RIFT_MATCHER_OPTION_LAZY_DFA, &error);
+    ASSERT(matcher != NULL, "Failed to create matcher");
+
+    const rift_match_length_bounds_t *bounds =
+        rift_regex_pattern_get_match_length(rift_matcher_get_pattern(matcher));
+    ASSERT(bounds != NULL && bounds->min == 7 && bounds->max == 7,
+           "A fixed-width pattern should have equal bounds");
+
+    // The last date is one byte short, so no start position near the end is tried
+    const char *input = "on 2024-10-15, 99999-12 and 2025-0";
+    ASSERT(rift_matcher_set_input(matcher, input, (size_t)-1), "Failed to set input");
+    span_list_t found = {0};
+    ASSERT(rift_matcher_for_each_match(matcher, append_span, &found), "Search failed");
+    ASSERT(found.count == 2, "Should find 2 matches");
+    ASSERT(found.spans[0].start == 3 && found.spans[0].end == 10, "First match incorrect");
+    ASSERT(found.spans[1].start == 16 && found.spans[1].end == 23,
+           "The leftmost start of a match should be found within max bytes of its end");
+    free(found.spans);
+
+    // Chunks read only max - 1 bytes past their end and still find the crossing matches
+    size_t length = 4 * RIFT_MATCHER_PARALLEL_MIN_CHUNK + 77;
+    char *text = malloc(length + 1);
+    ASSERT(text != NULL, "Failed to allocate input");
+    unsigned int seed = 11;
+    for (size_t i = 0; i < length; i++) {
+        seed = seed * 1103515245u + 12345u;
+        text[i] = (seed >> 16) % 6 == 0 ? '-' : (char)('0' + (seed >> 8) % 10);
+    }
+    text[length] = '\0';
+
+    span_list_t expected = {0};
+    ASSERT(rift_matcher_set_input(matcher, text, length), "Failed to set input");
+    ASSERT(rift_matcher_for_each_match(matcher, append_span, &expected),
+           "Sequential search failed");
+    ASSERT(expected.count > 0, "The input should have matches");
+
+    span_list_t parallel = {0};
+    ASSERT(rift_matcher_find_all_parallel(rift_matcher_get_pattern(matcher), text, length, 4,
+                                          append_span, &parallel),
+           "Parallel search failed");
+    ASSERT(parallel.count == expected.count &&
+               memcmp(parallel.spans, expected.spans,
+                      parallel.count * sizeof(rift_regex_span_t)) == 0,
+           "Parallel matches should be the sequential ones");
+
+    free(parallel.spans);
+    free(expected.spans);
+    free(text);
+    rift_matcher_free(matcher);
+}
+
+// Test word boundaries on the lazy DFA, in searches and across streamed chunks
+TEST(matcher_word_boundary)
+{
+    rift_regex_error_t error;
+    rift_regex_matcher_t *matcher = rift_matcher_create_from_string(
+        "\\bcat\\b", RIFT_REGEX_DEFAULT, RIFT_MATCHER_OPTION_LAZY_DFA, &error);
+    ASSERT(matcher != NULL, "Failed to create matcher");
+
+    const char *input = "cat concat cats cat.";
+    ASSERT(rift_matcher_set_input(matcher, input, strlen(input)), "Failed to set input");
+    span_list_t found = {0};
+    ASSERT(rift_matcher_for_each_match(matcher, append_span, &found), "Search failed");
+    ASSERT(found.count == 2, "Should find 2 matches");
+    ASSERT(found.spans[0].start == 0 && found.spans[0].end == 3, "First match incorrect");
+    ASSERT(found.spans[1].start == 16 && found.spans[1].end == 19, "Second match incorrect");
+    free(found.spans);
+
+    ASSERT(rift_matcher_set_input(matcher, "concatenate", 11), "Failed to set input");
+    ASSERT(!rift_matcher_is_match(matcher), "A word inside another should not match");
+    ASSERT(rift_matcher_count(matcher) == 0, "Should count no matches");
+
+    // The byte after a match at the end of a chunk and the one before a chunk count too
+    stream_matches_t matches = {0};
+    ASSERT(rift_matcher_set_stream_callback(matcher, collect_stream_match, &matches),
+           "Failed to set callback");
+    ASSERT(rift_matcher_feed(matcher, "a cat", 5, false), "Feed failed");
+    ASSERT(matches.count == 0, "The next byte decides the boundary");
+    ASSERT(rift_matcher_feed(matcher, "s cat", 5, false), "Feed failed");
+    ASSERT(rift_matcher_feed(matcher, ".con", 4, false), "Feed failed");
+    ASSERT(rift_matcher_feed(matcher, "cat", 3, true), "Feed failed");
+    ASSERT(matches.count == 1, "Should stream 1 match");
+    ASSERT(matches.spans[0].start == 7 && matches.spans[0].end == 10, "Match incorrect");
+
+    rift_matcher_free(matcher);
+}
+
+// Test that searches by a suffix or inner literal find the leftmost matches
+TEST(matcher_search_strategy)
+{
+    rift_regex_error_t error;
+    rift_regex_matcher_t *matcher = rift_matcher_create_from_string(
+        "[a-z]+@example\\.com", RIFT_REGEX_DEFAULT, RIFT_MATCHER_OPTION_LAZY_DFA, &error);
+    ASSERT(matcher != NULL, "Failed to create matcher");
+    ASSERT(rift_regex_pattern_get_engine_plan(rift_matcher_get_pattern(matcher))->search ==
+               RIFT_SEARCH_REVERSE_SUFFIX,
+           "Matches end at their only suffix, so the suffix should be searched for");
+
+    const char *input = "mail bob@example.com, x@example.com and @example.com";
+    ASSERT(rift_matcher_set_input(matcher, input, strlen(input)), "Failed to set input");
+    span_list_t found = {0};
+    ASSERT(rift_matcher_for_each_match(matcher, append_span, &found), "Search failed");
+    ASSERT(found.count == 2, "Should find 2 matches");
+    ASSERT(found.spans[0].start == 5 && found.spans[0].end == 20, "First match incorrect");
+    ASSERT(found.spans[1].start == 22 && found.spans[1].end == 35, "Second match incorrect");
+    free(found.spans);
+    rift_matcher_free(matcher);
+
+    // The leftmost match runs past the first Xc, so that one cannot stand for all of them
+    matcher = rift_matcher_create_from_string("a.*Xc.*Xc|dXc", RIFT_REGEX_DEFAULT,
+                                              RIFT_MATCHER_OPTION_LAZY_DFA, &error);
+    ASSERT(matcher != NULL, "Failed to create matcher");
+    ASSERT(rift_regex_pattern_get_engine_plan(rift_matcher_get_pattern(matcher))->search !=
+               RIFT_SEARCH_REVERSE_SUFFIX,
+           "A suffix inside matches should not be searched for");
+    ASSERT(rift_matcher_set_input(matcher, "a dXc Xc", 8), "Failed to set input");
+    rift_regex_match_t match;
+    ASSERT(rift_matcher_find_next(matcher, &match), "Should find a match");
+    ASSERT(match.start == 0 && match.end == 8, "The leftmost match should be found");
+    ASSERT(rift_matcher_set_input(matcher, "a dXc", 5), "Failed to set input");
+    ASSERT(rift_matcher_find_next(matcher, &match), "Should find a match");
+    ASSERT(match.start == 2 && match.end == 5, "Only dXc matches");
+    rift_matcher_free(matcher);
+}
+
+// Test matching with a pattern rebuilt from its serialized form
+TEST(matcher_serialized_pattern)
+{
+    rift_regex_error_t error;
+    rift_regex_matcher_t *compiled = rift_matcher_create_from_string(
+        "id=(?<num>[0-9]+)(?=;)", RIFT_REGEX_DEFAULT, RIFT_MATCHER_DEFAULT, &error);
+    ASSERT(compiled != NULL, "Failed to create matcher");
+    const rift_regex_pattern_t *pattern = rift_matcher_get_pattern(compiled);
+
+    unsigned char *data = NULL;
+    size_t size = 0;
+    ASSERT(rift_regex_pattern_serialize(pattern, &data, &size), "Serialization failed");
+    rift_regex_pattern_t *loaded = rift_regex_pattern_deserialize(data, size, &error);
+    ASSERT(loaded != NULL, "Deserialization failed");
+
+    // The analysis comes back as saved, without an AST to redo it from
+    ASSERT(rift_regex_pattern_get_ast(loaded) == NULL, "Nothing should be parsed again");
+    ASSERT(strcmp(rift_regex_pattern_get_source(loaded), rift_regex_pattern_get_source(pattern)) ==
+               0,
+           "Source should be kept");
+    ASSERT(rift_regex_pattern_get_group_count(loaded) == rift_regex_pattern_get_group_count(pattern),
+           "Group count should be kept");
+    ASSERT(rift_regex_pattern_group_index(loaded, "num") == 1, "Group names should be kept");
+    ASSERT(rift_regex_pattern_get_engine_plan(loaded)->engine ==
+               rift_regex_pattern_get_engine_plan(pattern)->engine,
+           "Engine plan should be kept");
+    ASSERT(rift_regex_pattern_get_match_length(loaded)->min == 4, "Match length should be kept");
+    ASSERT(rift_regex_pattern_get_prefilter(loaded) != NULL, "The id= prefix should be kept");
+
+    rift_regex_matcher_t *matcher = rift_matcher_create(loaded, RIFT_MATCHER_DEFAULT);
+    ASSERT(matcher != NULL, "Failed to create matcher");
+    const char *input = "x id=12; id=7 id=345; id=;";
+    span_list_t expected = {0};
+    span_list_t found = {0};
+    ASSERT(rift_matcher_set_input(compiled, input, strlen(input)), "Failed to set input");
+    ASSERT(rift_matcher_for_each_match(compiled, append_span, &expected), "Search failed");
+    ASSERT(rift_matcher_set_input(matcher, input, strlen(input)), "Failed to set input");
+    ASSERT(rift_matcher_for_each_match(matcher, append_span, &found), "Search failed");
+    ASSERT(expected.count == 2 && found.count == expected.count &&
+               memcmp(found.spans, expected.spans, found.count * sizeof(rift_regex_span_t)) == 0,
+           "The loaded pattern should find the compiled one's matches");
+    free(found.spans);
+    free(expected.spans);
+    rift_matcher_free(matcher);
+    rift_regex_pattern_free(loaded);
+
+    // Truncated images and images of another format are refused
+    ASSERT(rift_regex_pattern_deserialize(data, size - 1, &error) == NULL &&
+               error.code == RIFT_REGEX_ERROR_INVALID_PARAMETER,
+           "A truncated image should be refused");
+    data[0] ^= 0xff;
+    ASSERT(rift_regex_pattern_deserialize(data, size, &error) == NULL &&
+               error.code == RIFT_REGEX_ERROR_UNSUPPORTED_OPERATION,
+           "An image with another magic number should be refused");
+
+    free(data);
+    rift_matcher_free(compiled);
+}
+
 // Main test runner
 int
 main(void)
@@ -272,9 +1195,30 @@ main(void)
     RUN_TEST(matcher_find_all);
     RUN_TEST(matcher_replace);
     RUN_TEST(matcher_split);
+    RUN_TEST(matcher_replace_into);
+    RUN_TEST(matcher_split_spans);
     RUN_TEST(matcher_timeout);
+    RUN_TEST(matcher_cancel);
     RUN_TEST(matcher_backtrack_depth);
+    RUN_TEST(matcher_limit_registry);
+    RUN_TEST(matcher_stats);
+    RUN_TEST(matcher_memory_budget);
+    RUN_TEST(matcher_engine_options);
+    RUN_TEST(matcher_engine_switch);
+    RUN_TEST(matcher_step);
     RUN_TEST(matcher_position);
+    RUN_TEST(matcher_stream);
+    RUN_TEST(matcher_spans);
+    RUN_TEST(matcher_for_each_match);
+    RUN_TEST(matcher_find_all_parallel);
+    RUN_TEST(matcher_find_all_file);
+    RUN_TEST(matcher_dfa_cache);
+    RUN_TEST(matcher_is_match_count);
+    RUN_TEST(matcher_line_mode);
+    RUN_TEST(matcher_match_length);
+    RUN_TEST(matcher_word_boundary);
+    RUN_TEST(matcher_search_strategy);
+    RUN_TEST(matcher_serialized_pattern);
 
     printf("\nTest summary: %d tests run, %d failed\n", tests_run, tests_failed);
 
@@ -0,0 +1,204 @@
+/**
+ * @file pattern_cache_test.c
+ * @brief Unit tests for the compiled pattern cache of the LibRift regex engine
+ *
+ * This file contains test cases verifying that lookups of the same text and
+ * flags share one compiled pattern or program, that only unheld entries are
+ * evicted to honour the memory budget, and that concurrent lookups and
+ * releases keep the reference counts right.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "core/engine/pattern_cache.h"
+
+#define NUM_THREADS 8
+#define NUM_LOOKUPS 2000
+#define NUM_SHARED_PATTERNS 32
+
+/* Test that the same key is compiled once and different keys are not shared */
+void
+test_pattern_cache_hits(void)
+{
+    rift_pattern_cache_t *cache = rift_pattern_cache_create(0);
+    assert(cache != NULL);
+    rift_regex_error_t error = {RIFT_REGEX_ERROR_NONE};
+
+    const rift_regex_pattern_t *first =
+        rift_pattern_cache_compile(cache, "ab+c", RIFT_REGEX_FLAG_NONE, &error);
+    const rift_regex_pattern_t *second =
+        rift_pattern_cache_compile(cache, "ab+c", RIFT_REGEX_FLAG_NONE, &error);
+    const rift_regex_pattern_t *other_flags =
+        rift_pattern_cache_compile(cache, "ab+c", RIFT_REGEX_FLAG_CASE_INSENSITIVE, &error);
+    assert(first != NULL && first == second);
+    assert(other_flags != NULL && other_flags != first);
+
+    rift_pattern_cache_stats_t stats;
+    rift_pattern_cache_get_stats(cache, &stats);
+    assert(stats.hits == 1 && stats.misses == 2);
+    assert(stats.entries == 2 && stats.held == 2 && stats.bytes > 0);
+
+    /* Failed compilations are reported and not cached */
+    assert(rift_pattern_cache_compile(cache, "(", RIFT_REGEX_FLAG_NONE, &error) == NULL);
+    assert(error.code != RIFT_REGEX_ERROR_NONE);
+    assert(rift_pattern_cache_compile(cache, NULL, RIFT_REGEX_FLAG_NONE, &error) == NULL);
+    assert(rift_pattern_cache_compile(NULL, "ab+c", RIFT_REGEX_FLAG_NONE, &error) == NULL);
+
+    rift_pattern_cache_release(cache, first);
+    rift_pattern_cache_release(cache, second);
+    rift_pattern_cache_release(cache, other_flags);
+    rift_pattern_cache_release(cache, NULL);
+    rift_pattern_cache_get_stats(cache, &stats);
+    assert(stats.entries == 2 && stats.held == 0);
+
+    /* A released entry is still found until it is evicted */
+    assert(rift_pattern_cache_compile(cache, "ab+c", RIFT_REGEX_FLAG_NONE, &error) == first);
+    rift_pattern_cache_release(cache, first);
+
+    rift_pattern_cache_free(cache);
+    printf("test_pattern_cache_hits: PASSED\n");
+}
+
+/* Test that programs are cached apart from the patterns of the same text */
+void
+test_pattern_cache_bytecode(void)
+{
+    rift_pattern_cache_t *cache = rift_pattern_cache_create(0);
+    assert(cache != NULL);
+
+    const rift_bytecode_program_t *program =
+        rift_pattern_cache_compile_bytecode(cache, "[a-z]+", RIFT_REGEX_FLAG_NONE, NULL);
+    assert(program != NULL);
+    assert(rift_pattern_cache_compile_bytecode(cache, "[a-z]+", RIFT_REGEX_FLAG_NONE, NULL) ==
+           program);
+    const rift_regex_pattern_t *pattern =
+        rift_pattern_cache_compile(cache, "[a-z]+", RIFT_REGEX_FLAG_NONE, NULL);
+    assert(pattern != NULL && (const void *)pattern != (const void *)program);
+
+    rift_pattern_cache_stats_t stats;
+    rift_pattern_cache_get_stats(cache, &stats);
+    assert(stats.hits == 1 && stats.misses == 2 && stats.entries == 2);
+
+    rift_pattern_cache_release_bytecode(cache, program);
+    rift_pattern_cache_release_bytecode(cache, program);
+    rift_pattern_cache_release(cache, pattern);
+    rift_pattern_cache_get_stats(cache, &stats);
+    assert(stats.held == 0);
+
+    rift_pattern_cache_free(cache);
+    printf("test_pattern_cache_bytecode: PASSED\n");
+}
+
+/* Test that the budget only evicts entries nobody holds */
+void
+test_pattern_cache_budget(void)
+{
+    /* One byte per stripe: nothing fits once released */
+    rift_pattern_cache_t *cache = rift_pattern_cache_create(RIFT_PATTERN_CACHE_STRIPES);
+    assert(cache != NULL);
+
+    const rift_regex_pattern_t *held =
+        rift_pattern_cache_compile(cache, "held", RIFT_REGEX_FLAG_NONE, NULL);
+    const rift_regex_pattern_t *released =
+        rift_pattern_cache_compile(cache, "released", RIFT_REGEX_FLAG_NONE, NULL);
+    assert(held != NULL && released != NULL);
+
+    rift_pattern_cache_stats_t stats;
+    rift_pattern_cache_get_stats(cache, &stats);
+    assert(stats.entries == 2 && stats.evictions == 0);
+
+    rift_pattern_cache_release(cache, released);
+    rift_pattern_cache_get_stats(cache, &stats);
+    assert(stats.entries == 1 && stats.evictions == 1);
+
+    /* The held pattern is still shared and usable */
+    assert(rift_pattern_cache_compile(cache, "held", RIFT_REGEX_FLAG_NONE, NULL) == held);
+    assert(strcmp(rift_regex_pattern_get_source(held), "held") == 0);
+    rift_pattern_cache_release(cache, held);
+    rift_pattern_cache_release(cache, held);
+    rift_pattern_cache_get_stats(cache, &stats);
+    assert(stats.entries == 0 && stats.bytes == 0);
+
+    rift_pattern_cache_free(cache);
+
+    /* Clearing drops unheld entries only */
+    cache = rift_pattern_cache_create(0);
+    assert(cache != NULL);
+    held = rift_pattern_cache_compile(cache, "held", RIFT_REGEX_FLAG_NONE, NULL);
+    released = rift_pattern_cache_compile(cache, "released", RIFT_REGEX_FLAG_NONE, NULL);
+    rift_pattern_cache_release(cache, released);
+    rift_pattern_cache_clear(cache);
+    rift_pattern_cache_get_stats(cache, &stats);
+    assert(stats.entries == 1 && stats.held == 1);
+    rift_pattern_cache_release(cache, held);
+    rift_pattern_cache_free(cache);
+
+    printf("test_pattern_cache_budget: PASSED\n");
+}
+
+/* Look up and release shared patterns in a loop */
+static void *
+lookup_thread(void *arg)
+{
+    rift_pattern_cache_t *cache = (rift_pattern_cache_t *)arg;
+    char source[32];
+
+    for (size_t i = 0; i < NUM_LOOKUPS; i++) {
+        snprintf(source, sizeof(source), "p%zu[0-9]+", (i * 7) % NUM_SHARED_PATTERNS);
+        const rift_regex_pattern_t *pattern =
+            rift_pattern_cache_compile(cache, source, RIFT_REGEX_FLAG_NONE, NULL);
+        assert(pattern != NULL);
+        assert(strcmp(rift_regex_pattern_get_source(pattern), source) == 0);
+        rift_pattern_cache_release(cache, pattern);
+    }
+    return NULL;
+}
+
+/* Test concurrent lookups of a shared set of patterns */
+void
+test_pattern_cache_threads(void)
+{
+    rift_pattern_cache_t *cache = rift_pattern_cache_create(0);
+    assert(cache != NULL);
+
+    pthread_t threads[NUM_THREADS];
+    for (size_t t = 0; t < NUM_THREADS; t++) {
+        assert(pthread_create(&threads[t], NULL, lookup_thread, cache) == 0);
+    }
+    for (size_t t = 0; t < NUM_THREADS; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    rift_pattern_cache_stats_t stats;
+    rift_pattern_cache_get_stats(cache, &stats);
+    assert(stats.hits + stats.misses == NUM_THREADS * NUM_LOOKUPS);
+    assert(stats.entries == NUM_SHARED_PATTERNS && stats.held == 0);
+    assert(stats.misses >= NUM_SHARED_PATTERNS);
+
+    rift_pattern_cache_free(cache);
+
+    /* The process-wide cache is created once */
+    assert(rift_pattern_cache_global() != NULL);
+    assert(rift_pattern_cache_global() == rift_pattern_cache_global());
+    printf("test_pattern_cache_threads: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running pattern cache tests...\n");
+
+    test_pattern_cache_hits();
+    test_pattern_cache_bytecode();
+    test_pattern_cache_budget();
+    test_pattern_cache_threads();
+
+    printf("All pattern cache tests PASSED!\n");
+    return 0;
+}
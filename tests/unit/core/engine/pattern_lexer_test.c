@@ -0,0 +1,164 @@
+/**
+ * @file pattern_lexer_test.c
+ * @brief Unit tests for the longest-match lexer in the LibRift regex engine
+ *
+ * This file contains test cases verifying that a lexer picks the longest
+ * match at every offset, gives ties to the rule added first, turns bytes no
+ * rule matches into tokens of their own, and counts tokens past the
+ * capacity of the array it fills.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/patterns/lexer.h"
+
+enum { RULE_IF, RULE_IDENT, RULE_NUMBER, RULE_SPACE, RULE_ARROW, RULE_MINUS };
+
+/* Build the lexer shared by the tests */
+static rift_lexer_t *
+create_lexer(void)
+{
+    rift_lexer_t *lexer = rift_lexer_create();
+    assert(lexer != NULL);
+
+    rift_regex_error_t error = {RIFT_REGEX_ERROR_NONE};
+    uint32_t rule = RIFT_LEXER_NO_RULE;
+    assert(rift_lexer_add_rule(lexer, "if", RIFT_REGEX_FLAG_NONE, &rule, &error));
+    assert(rule == RULE_IF);
+    assert(rift_lexer_add_rule(lexer, "[a-z]+", RIFT_REGEX_FLAG_NONE, &rule, &error));
+    assert(rule == RULE_IDENT);
+    assert(rift_lexer_add_rule(lexer, "[0-9]+", RIFT_REGEX_FLAG_NONE, NULL, &error));
+    assert(rift_lexer_add_rule(lexer, " +", RIFT_REGEX_FLAG_NONE, NULL, &error));
+    assert(rift_lexer_add_rule(lexer, "->", RIFT_REGEX_FLAG_NONE, NULL, &error));
+    assert(rift_lexer_add_rule(lexer, "-", RIFT_REGEX_FLAG_NONE, NULL, &error));
+    assert(rift_lexer_get_rule_count(lexer) == 6);
+
+    assert(rift_lexer_compile(lexer, &error));
+    return lexer;
+}
+
+/* Test longest match and priority between rules */
+static void
+test_lexer_longest_match(void)
+{
+    rift_lexer_t *lexer = create_lexer();
+    const char *input = "if iffy -> 42-x";
+    static const uint32_t rules[] = {RULE_IF,    RULE_SPACE, RULE_IDENT,  RULE_SPACE, RULE_ARROW,
+                                     RULE_SPACE, RULE_NUMBER, RULE_MINUS, RULE_IDENT};
+    static const char *texts[] = {"if", " ", "iffy", " ", "->", " ", "42", "-", "x"};
+
+    rift_lexer_token_t tokens[16];
+    size_t count = rift_lexer_tokenize(lexer, input, strlen(input), tokens, 16);
+    assert(count == 9);
+    for (size_t i = 0; i < count; i++) {
+        /* "if" ties with the identifier rule and goes to the earlier one */
+        assert(tokens[i].rule == rules[i]);
+        assert(tokens[i].end - tokens[i].start == strlen(texts[i]));
+        assert(strncmp(input + tokens[i].start, texts[i], strlen(texts[i])) == 0);
+    }
+
+    rift_lexer_free(lexer);
+    printf("test_lexer_longest_match: PASSED\n");
+}
+
+/* Test bytes no rule matches and arrays too small for every token */
+static void
+test_lexer_unmatched(void)
+{
+    rift_lexer_t *lexer = create_lexer();
+    const char *input = "a+=b";
+
+    rift_lexer_token_t token;
+    assert(rift_lexer_next(lexer, input, strlen(input), 1, &token));
+    assert(token.rule == RIFT_LEXER_NO_RULE && token.start == 1 && token.end == 2);
+    assert(!rift_lexer_next(lexer, input, strlen(input), 4, &token));
+
+    /* The count is of every token even when the array holds fewer */
+    rift_lexer_token_t tokens[2];
+    assert(rift_lexer_tokenize(lexer, input, strlen(input), tokens, 2) == 4);
+    assert(tokens[0].rule == RULE_IDENT);
+    assert(tokens[1].rule == RIFT_LEXER_NO_RULE);
+    assert(rift_lexer_tokenize(lexer, input, strlen(input), NULL, 0) == 4);
+
+    rift_lexer_free(lexer);
+    printf("test_lexer_unmatched: PASSED\n");
+}
+
+/* Test that a budgeted table cuts the same tokens, and one too small fails */
+static void
+test_lexer_memory_budget(void)
+{
+    rift_lexer_t *lexer = create_lexer();
+    const char *input = "if iffy -> 42-x ?? then else 7";
+    rift_lexer_token_t expected[32];
+    size_t count = rift_lexer_tokenize(lexer, input, strlen(input), expected, 32);
+
+    /* Shrinking budgets go through every layout that fits one of them */
+    rift_regex_error_t error = {RIFT_REGEX_ERROR_NONE};
+    for (size_t budget = 4096; budget >= 256; budget -= 16) {
+        rift_lexer_set_memory_budget(lexer, budget);
+        if (!rift_lexer_compile(lexer, &error)) {
+            assert(error.code == RIFT_REGEX_ERROR_LIMIT_EXCEEDED);
+            continue;
+        }
+
+        rift_lexer_token_t tokens[32];
+        assert(rift_lexer_tokenize(lexer, input, strlen(input), tokens, 32) == count);
+        for (size_t i = 0; i < count; i++) {
+            assert(tokens[i].rule == expected[i].rule);
+            assert(tokens[i].start == expected[i].start && tokens[i].end == expected[i].end);
+        }
+    }
+
+    rift_lexer_set_memory_budget(lexer, 16);
+    assert(!rift_lexer_compile(lexer, &error));
+    assert(error.code == RIFT_REGEX_ERROR_LIMIT_EXCEEDED);
+
+    rift_lexer_free(lexer);
+    printf("test_lexer_memory_budget: PASSED\n");
+}
+
+/* Test lexers that are not compiled and invalid parameters */
+static void
+test_lexer_invalid(void)
+{
+    rift_lexer_t *lexer = rift_lexer_create();
+    assert(lexer != NULL);
+
+    rift_regex_error_t error = {RIFT_REGEX_ERROR_NONE};
+    assert(!rift_lexer_compile(lexer, &error));
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_PARAMETER);
+
+    error.code = RIFT_REGEX_ERROR_NONE;
+    assert(!rift_lexer_add_rule(lexer, "(", RIFT_REGEX_FLAG_NONE, NULL, &error));
+    assert(error.code != RIFT_REGEX_ERROR_NONE);
+    assert(rift_lexer_get_rule_count(lexer) == 0);
+
+    assert(rift_lexer_add_rule(lexer, "a", RIFT_REGEX_FLAG_NONE, NULL, NULL));
+    rift_lexer_token_t token;
+    assert(!rift_lexer_next(lexer, "a", 1, 0, &token));
+    assert(rift_lexer_tokenize(lexer, "a", 1, NULL, 0) == 0);
+    assert(!rift_lexer_add_rule(NULL, "a", RIFT_REGEX_FLAG_NONE, NULL, NULL));
+    assert(rift_lexer_get_rule_count(NULL) == 0);
+
+    rift_lexer_free(lexer);
+    rift_lexer_free(NULL);
+    printf("test_lexer_invalid: PASSED\n");
+}
+
+int
+main(void)
+{
+    test_lexer_longest_match();
+    test_lexer_unmatched();
+    test_lexer_memory_budget();
+    test_lexer_invalid();
+    printf("All lexer tests PASSED!\n");
+    return 0;
+}
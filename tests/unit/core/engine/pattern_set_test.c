@@ -0,0 +1,330 @@
+/**
+ * @file pattern_set_test.c
+ * @brief Unit tests for multi-pattern matching in the LibRift regex engine
+ *
+ * This file contains test cases verifying per-pattern accept tags, scanning a
+ * union of patterns in one pass, switching to an Aho-Corasick scanner for
+ * literal sets and keeping tags through DFA conversion and minimization.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/automaton/automaton.h"
+#include "core/automaton/hopcroft.h"
+#include "core/automaton/state.h"
+#include "core/engine/pattern_set.h"
+
+/* Build an NFA for one literal string */
+static rift_regex_automaton_t *
+create_literal_nfa(const char *literal)
+{
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    size_t length = strlen(literal);
+    rift_regex_state_t *previous = rift_automaton_create_state(nfa, length == 0);
+    assert(previous != NULL);
+    assert(rift_automaton_set_initial_state(nfa, previous));
+
+    for (size_t i = 0; i < length; i++) {
+        char pattern[2] = {literal[i], '\0'};
+        rift_regex_state_t *next = rift_automaton_create_state(nfa, i + 1 == length);
+        assert(next != NULL);
+        assert(rift_automaton_add_transition(nfa, previous, next, pattern));
+        previous = next;
+    }
+
+    return nfa;
+}
+
+/* Add a literal pattern to a set and check its identifier */
+static void
+add_literal(rift_pattern_set_t *set, const char *literal, uint32_t expected_id)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa = create_literal_nfa(literal);
+    uint32_t id = UINT32_MAX;
+
+    assert(rift_pattern_set_add_automaton(set, nfa, &id, &error));
+    assert(id == expected_id);
+    rift_automaton_free(nfa);
+}
+
+/* Add a pattern repeating a literal one or more times to a set */
+static void
+add_repeated(rift_pattern_set_t *set, const char *literal, uint32_t expected_id)
+{
+    rift_regex_automaton_t *nfa = create_literal_nfa(literal);
+    rift_regex_state_t *last = rift_automaton_get_state_by_index(nfa, strlen(literal));
+    assert(rift_automaton_create_epsilon_transition(nfa, last, nfa->initial_state));
+
+    uint32_t id = UINT32_MAX;
+    assert(rift_pattern_set_add_automaton(set, nfa, &id, NULL));
+    assert(id == expected_id);
+    rift_automaton_free(nfa);
+}
+
+/* Test setting, querying and merging accept tags on states */
+void
+test_pattern_set_state_tags(void)
+{
+    rift_regex_state_t *a = rift_state_create(false);
+    rift_regex_state_t *b = rift_state_create(false);
+    assert(a != NULL && b != NULL);
+
+    assert(rift_state_add_accept_tag(a, 3));
+    assert(rift_state_is_accepting(a));
+    assert(rift_state_has_accept_tag(a, 3));
+    assert(!rift_state_has_accept_tag(a, 2));
+    assert(!rift_state_has_accept_tag(a, 200));
+
+    assert(rift_state_add_accept_tag(b, 130));
+    assert(rift_state_merge_accept_tags(a, b));
+    assert(rift_state_has_accept_tag(a, 3));
+    assert(rift_state_has_accept_tag(a, 130));
+
+    size_t words = 0;
+    const uint64_t *tags = rift_state_get_accept_tags(a, &words);
+    assert(tags != NULL && words == 3);
+
+    rift_regex_state_t *clone = rift_state_clone(a);
+    assert(clone != NULL);
+    assert(rift_state_has_accept_tag(clone, 3));
+    assert(rift_state_has_accept_tag(clone, 130));
+
+    rift_state_free(clone);
+    rift_state_free(a);
+    rift_state_free(b);
+    printf("test_pattern_set_state_tags: PASSED\n");
+}
+
+/* Test that one scan reports every pattern occurring in the input */
+void
+test_pattern_set_scan(void)
+{
+    rift_regex_error_t error = {0};
+    rift_pattern_set_t *set = rift_pattern_set_create(0);
+    assert(set != NULL);
+
+    add_literal(set, "abc", 0);
+    add_literal(set, "bcd", 1);
+    add_literal(set, "x", 2);
+    assert(rift_pattern_set_get_count(set) == 3);
+    assert(rift_pattern_set_compile(set, &error));
+
+    uint32_t ids[4];
+    assert(rift_pattern_set_scan(set, "zabcdz", 6, ids, 4, &error) == 2);
+    assert(ids[0] == 0 && ids[1] == 1);
+    assert(rift_pattern_set_matched(set, 0));
+    assert(!rift_pattern_set_matched(set, 2));
+
+    assert(rift_pattern_set_scan(set, "abxbc", 5, ids, 4, &error) == 1);
+    assert(ids[0] == 2);
+
+    assert(rift_pattern_set_scan(set, "ab", 2, ids, 4, &error) == 0);
+    assert(rift_pattern_set_scan(set, "", 0, ids, 4, &error) == 0);
+
+    /* The count is complete even when the ids array is short */
+    assert(rift_pattern_set_scan(set, "xabcd", 5, ids, 1, &error) == 3);
+    assert(ids[0] == 0);
+
+    /* Adding a pattern recompiles the union on the next scan */
+    add_literal(set, "", 3);
+    assert(rift_pattern_set_get_automaton(set) == NULL);
+    assert(rift_pattern_set_scan(set, "q", 1, ids, 4, &error) == 1);
+    assert(ids[0] == 3);
+
+    /* Replacing a pattern keeps its identifier and only copies the new automaton */
+    size_t states = rift_pattern_set_get_automaton(set)->num_states;
+    rift_regex_automaton_t *nfa = create_literal_nfa("qz");
+    assert(rift_pattern_set_replace_automaton(set, 0, nfa, &error));
+    rift_automaton_free(nfa);
+    assert(rift_pattern_set_scan(set, "abcqz", 5, ids, 4, &error) == 2);
+    assert(ids[0] == 0 && ids[1] == 3);
+    assert(rift_pattern_set_get_automaton(set)->num_states == states + 3);
+    assert(!rift_pattern_set_replace_automaton(set, 4, rift_pattern_set_get_automaton(set),
+                                               &error));
+
+    /* Cut-off copies are dropped once they outnumber the live states */
+    for (int i = 0; i < 16; i++) {
+        nfa = create_literal_nfa("qz");
+        assert(rift_pattern_set_replace_automaton(set, 0, nfa, &error));
+        rift_automaton_free(nfa);
+        assert(rift_pattern_set_compile(set, &error));
+    }
+    assert(rift_pattern_set_get_automaton(set)->num_states <= 2 * states);
+    assert(rift_pattern_set_scan(set, "qz", 2, ids, 4, &error) == 2);
+
+    rift_pattern_set_free(set);
+    printf("test_pattern_set_scan: PASSED\n");
+}
+
+/* Test that a thrashing scanner cache still reports the same patterns */
+void
+test_pattern_set_small_cache(void)
+{
+    rift_regex_error_t error = {0};
+    rift_pattern_set_t *small = rift_pattern_set_create(2);
+    rift_pattern_set_t *large = rift_pattern_set_create(0);
+    rift_pattern_set_t *literal = rift_pattern_set_create(0);
+    const char *literals[] = {"ab", "ba", "aab", "bba", "abab", "bbb"};
+
+    for (uint32_t i = 0; i < 6; i++) {
+        add_literal(small, literals[i], i);
+        add_literal(large, literals[i], i);
+        add_literal(literal, literals[i], i);
+    }
+
+    /* A loop keeps the first two sets on the lazy DFA */
+    add_repeated(small, "bab", 6);
+    add_repeated(large, "bab", 6);
+
+    char input[64];
+    unsigned seed = 7;
+    for (int round = 0; round < 50; round++) {
+        size_t length = (size_t)(round % 20);
+        for (size_t i = 0; i < length; i++) {
+            seed = seed * 1103515245u + 12345u;
+            input[i] = ((seed >> 16) & 1) ? 'a' : 'b';
+        }
+
+        uint32_t small_ids[7];
+        uint32_t large_ids[7];
+        uint32_t literal_ids[6];
+        size_t small_count = rift_pattern_set_scan(small, input, length, small_ids, 7, &error);
+        size_t large_count = rift_pattern_set_scan(large, input, length, large_ids, 7, &error);
+        size_t literal_count =
+            rift_pattern_set_scan(literal, input, length, literal_ids, 6, &error);
+        assert(small_count == large_count);
+        assert(memcmp(small_ids, large_ids, small_count * sizeof(uint32_t)) == 0);
+        assert(literal_count == large_count - rift_pattern_set_matched(large, 6));
+        assert(memcmp(literal_ids, large_ids, literal_count * sizeof(uint32_t)) == 0);
+
+        for (uint32_t i = 0; i < 6; i++) {
+            size_t literal_length = strlen(literals[i]);
+            bool expected = false;
+            for (size_t start = 0; start + literal_length <= length; start++) {
+                if (memcmp(input + start, literals[i], literal_length) == 0) {
+                    expected = true;
+                }
+            }
+            assert(rift_pattern_set_matched(large, i) == expected);
+        }
+    }
+
+    rift_pattern_set_free(small);
+    rift_pattern_set_free(large);
+    rift_pattern_set_free(literal);
+    printf("test_pattern_set_small_cache: PASSED\n");
+}
+
+/* Test that sets of literals are scanned with an Aho-Corasick automaton */
+void
+test_pattern_set_literal_scanner(void)
+{
+    rift_regex_error_t error = {0};
+    rift_pattern_set_t *set = rift_pattern_set_create(0);
+    add_literal(set, "he", 0);
+    add_literal(set, "she", 1);
+    add_literal(set, "hers", 2);
+    assert(rift_pattern_set_compile(set, &error));
+    assert(set->literals != NULL && set->scanner == NULL);
+    assert(rift_pattern_set_get_automaton(set) != NULL);
+
+    uint32_t ids[4];
+    assert(rift_pattern_set_scan(set, "ushers", 6, ids, 4, &error) == 3);
+    assert(ids[0] == 0 && ids[1] == 1 && ids[2] == 2);
+
+    /* A pattern that is not a set of literals brings the lazy DFA back */
+    add_repeated(set, "ab", 3);
+    assert(rift_pattern_set_scan(set, "shabab", 6, ids, 4, &error) == 1);
+    assert(ids[0] == 3);
+    assert(set->literals == NULL && set->scanner != NULL);
+
+    /* And replacing it with a literal brings the literal scanner back */
+    rift_regex_automaton_t *nfa = create_literal_nfa("ab");
+    assert(rift_pattern_set_replace_automaton(set, 3, nfa, &error));
+    rift_automaton_free(nfa);
+    assert(rift_pattern_set_scan(set, "shabab", 6, ids, 4, &error) == 1);
+    assert(set->literals != NULL && set->scanner == NULL);
+
+    rift_pattern_set_free(set);
+    printf("test_pattern_set_literal_scanner: PASSED\n");
+}
+
+/* Test that DFA conversion and minimization keep patterns apart */
+void
+test_pattern_set_dfa_tags(void)
+{
+    rift_regex_error_t error = {0};
+    rift_pattern_set_t *set = rift_pattern_set_create(0);
+    add_literal(set, "ab", 0);
+    add_literal(set, "cb", 1);
+    assert(rift_pattern_set_compile(set, &error));
+
+    rift_regex_automaton_t *dfa =
+        rift_automaton_nfa_to_dfa(rift_pattern_set_get_automaton(set), &error);
+    assert(dfa != NULL);
+
+    /* Without tags the two accepting states would merge */
+    rift_regex_automaton_t *minimized = rift_hopcroft_minimize(dfa, &error);
+    assert(minimized != NULL);
+
+    size_t only_first = 0;
+    size_t only_second = 0;
+    for (size_t i = 0; i < rift_automaton_get_state_count(minimized); i++) {
+        rift_regex_state_t *state = rift_automaton_get_state_by_index(minimized, i);
+        bool first = rift_state_has_accept_tag(state, 0);
+        bool second = rift_state_has_accept_tag(state, 1);
+        only_first += first && !second;
+        only_second += second && !first;
+    }
+    assert(only_first == 1 && only_second == 1);
+
+    rift_automaton_free(minimized);
+    rift_automaton_free(dfa);
+    rift_pattern_set_free(set);
+    printf("test_pattern_set_dfa_tags: PASSED\n");
+}
+
+/* Test invalid parameters */
+void
+test_pattern_set_invalid(void)
+{
+    rift_regex_error_t error = {0};
+
+    assert(!rift_pattern_set_add_automaton(NULL, NULL, NULL, &error));
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_PARAMETER);
+    assert(!rift_pattern_set_compile(NULL, &error));
+    assert(rift_pattern_set_scan(NULL, "a", 1, NULL, 0, &error) == 0);
+    assert(!rift_pattern_set_matched(NULL, 0));
+    assert(rift_pattern_set_get_count(NULL) == 0);
+    rift_pattern_set_free(NULL);
+
+    /* An empty set compiles and matches nothing */
+    rift_pattern_set_t *set = rift_pattern_set_create(0);
+    assert(rift_pattern_set_scan(set, "abc", 3, NULL, 0, &error) == 0);
+    rift_pattern_set_free(set);
+
+    printf("test_pattern_set_invalid: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running pattern set tests...\n");
+
+    test_pattern_set_state_tags();
+    test_pattern_set_scan();
+    test_pattern_set_small_cache();
+    test_pattern_set_literal_scanner();
+    test_pattern_set_dfa_tags();
+    test_pattern_set_invalid();
+
+    printf("All pattern set tests PASSED!\n");
+    return 0;
+}
@@ -140,6 +140,33 @@ START_TEST(test_pattern_clone)
 }
 END_TEST
 
+// Test that clones share the compiled pattern and outlive the original
+START_TEST(test_pattern_clone_shares)
+{
+    rift_regex_pattern_t *original = rift_regex_compile("a(b|c)+", RIFT_REGEX_FLAG_NONE, &error);
+    ck_assert_ptr_nonnull(original);
+
+    rift_regex_pattern_t *first = rift_regex_pattern_clone(original);
+    rift_regex_pattern_t *second = rift_regex_pattern_clone(first);
+    ck_assert_ptr_nonnull(first);
+    ck_assert_ptr_nonnull(second);
+    ck_assert_ptr_eq(rift_regex_pattern_get_automaton(first),
+                     rift_regex_pattern_get_automaton(original));
+    ck_assert_ptr_eq(rift_regex_pattern_get_ast(second), rift_regex_pattern_get_ast(original));
+    ck_assert_ptr_eq(rift_regex_pattern_get_source(second),
+                     rift_regex_pattern_get_source(original));
+
+    // The shared parts stay alive until the last clone is freed
+    rift_regex_pattern_free(original);
+    rift_regex_pattern_free(first);
+    ck_assert_str_eq(rift_regex_pattern_get_source(second), "a(b|c)+");
+    ck_assert_uint_eq(rift_regex_pattern_get_group_count(second), 1);
+    ck_assert_ptr_nonnull(rift_regex_pattern_get_automaton(second));
+
+    rift_regex_pattern_free(second);
+}
+END_TEST
+
 // Test pattern equality
 START_TEST(test_pattern_equals)
 {
@@ -316,6 +343,7 @@ pattern_suite(void)
     tcase_add_checked_fixture(tc_advanced, setup, teardown);
     tcase_add_test(tc_advanced, test_compile_with_optimization);
     tcase_add_test(tc_advanced, test_pattern_clone);
+    tcase_add_test(tc_advanced, test_pattern_clone_shares);
     tcase_add_test(tc_advanced, test_pattern_equals);
     tcase_add_test(tc_advanced, test_pattern_to_string);
     tcase_add_test(tc_advanced, test_pattern_split_alternation);
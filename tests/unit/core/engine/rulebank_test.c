@@ -0,0 +1,200 @@
+/**
+ * @file rulebank_test.c
+ * @brief Unit tests for rule banks in the LibRift regex engine
+ *
+ * This file contains test cases verifying that a rule bank finds its rules
+ * by name, records the spans of every rule that matched a line, stops at
+ * the first match when asked to, refuses duplicate names and rules added
+ * after matching, and gives the same answers on many threads at once.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/engine/rulebank.h"
+
+#define NUM_THREADS 4
+#define LINES_PER_THREAD 2000
+
+static const char *lines[] = {"[ERROR] disk full on sda1", "[INFO] user=alice id=42",
+                              "no level here", "[ERROR] user=bob id=7"};
+
+/* Build the bank shared by the tests */
+static rift_rulebank_t *
+create_bank(rift_rulebank_option_t options)
+{
+    rift_rulebank_t *bank = rift_rulebank_create(options);
+    assert(bank != NULL);
+
+    rift_regex_error_t error = {RIFT_REGEX_ERROR_NONE};
+    uint32_t rule = RIFT_RULEBANK_NO_RULE;
+    assert(rift_rulebank_add(bank, "error", "\\[ERROR\\]", RIFT_REGEX_FLAG_NONE, &rule, &error));
+    assert(rule == 0);
+    assert(rift_rulebank_add(bank, "user", "user=([a-z]+) id=([0-9]+)", RIFT_REGEX_FLAG_NONE,
+                             &rule, &error));
+    assert(rule == 1);
+    assert(rift_rulebank_add(bank, "info", "\\[INFO\\]", RIFT_REGEX_FLAG_NONE, NULL, &error));
+    return bank;
+}
+
+/* Test looking rules up */
+static void
+test_rulebank_rules(void)
+{
+    rift_rulebank_t *bank = create_bank(RIFT_RULEBANK_OPTION_NONE);
+
+    assert(rift_rulebank_get_count(bank) == 3);
+    assert(rift_rulebank_find(bank, "user") == 1);
+    assert(rift_rulebank_find(bank, "warn") == RIFT_RULEBANK_NO_RULE);
+    assert(strcmp(rift_rulebank_get_name(bank, 2), "info") == 0);
+    assert(rift_rulebank_get_name(bank, 3) == NULL);
+    assert(rift_rulebank_get_group_count(bank, 1) == 2);
+    assert(rift_rulebank_get_group_count(bank, 0) == 0);
+
+    rift_regex_error_t error = {RIFT_REGEX_ERROR_NONE};
+    assert(!rift_rulebank_add(bank, "user", "x", RIFT_REGEX_FLAG_NONE, NULL, &error));
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_PARAMETER);
+    assert(rift_rulebank_get_count(bank) == 3);
+
+    rift_rulebank_free(bank);
+    printf("test_rulebank_rules: PASSED\n");
+}
+
+/* Test the spans of the rules that matched */
+static void
+test_rulebank_match(void)
+{
+    rift_rulebank_t *bank = create_bank(RIFT_RULEBANK_OPTION_NONE);
+    rift_rulebank_results_t *results = rift_rulebank_results_create(bank);
+    assert(results != NULL);
+
+    const char *line = lines[3];
+    assert(rift_rulebank_match(bank, line, strlen(line), results) == 2);
+    assert(rift_rulebank_results_first(results) == 0);
+    assert(rift_rulebank_results_matched(results, 0));
+    assert(rift_rulebank_results_matched(results, 1));
+    assert(!rift_rulebank_results_matched(results, 2));
+
+    rift_regex_span_t span;
+    assert(rift_rulebank_results_get_span(results, 1, 1, &span));
+    assert(span.end - span.start == 3 && strncmp(line + span.start, "bob", 3) == 0);
+    assert(rift_rulebank_results_get_span(results, 1, 2, &span));
+    assert(span.end - span.start == 1 && line[span.start] == '7');
+    assert(!rift_rulebank_results_get_span(results, 1, 3, &span));
+    assert(!rift_rulebank_results_get_span(results, 2, 0, &span));
+
+    /* The results are reset for every line */
+    assert(rift_rulebank_match(bank, lines[2], strlen(lines[2]), results) == 0);
+    assert(rift_rulebank_results_first(results) == RIFT_RULEBANK_NO_RULE);
+    assert(!rift_rulebank_results_matched(results, 0));
+
+    /* The rules are closed once the bank has matched */
+    rift_regex_error_t error = {RIFT_REGEX_ERROR_NONE};
+    assert(!rift_rulebank_add(bank, "late", "x", RIFT_REGEX_FLAG_NONE, NULL, &error));
+
+    rift_rulebank_results_free(results);
+    rift_rulebank_free(bank);
+    printf("test_rulebank_match: PASSED\n");
+}
+
+/* Test stopping at the first rule that matches */
+static void
+test_rulebank_first_match(void)
+{
+    rift_rulebank_t *bank = create_bank(RIFT_RULEBANK_OPTION_FIRST_MATCH);
+    rift_rulebank_results_t *results = rift_rulebank_results_create(bank);
+    assert(results != NULL);
+
+    assert(rift_rulebank_match(bank, lines[3], strlen(lines[3]), results) == 1);
+    assert(rift_rulebank_results_first(results) == 0);
+    assert(!rift_rulebank_results_matched(results, 1));
+
+    assert(rift_rulebank_match(bank, lines[1], strlen(lines[1]), results) == 1);
+    assert(rift_rulebank_results_first(results) == 1);
+
+    rift_rulebank_results_free(results);
+    rift_rulebank_free(bank);
+    printf("test_rulebank_first_match: PASSED\n");
+}
+
+/* Match every line repeatedly on one thread */
+static void *
+match_lines(void *arg)
+{
+    rift_rulebank_t *bank = (rift_rulebank_t *)arg;
+    rift_rulebank_results_t *results = rift_rulebank_results_create(bank);
+    assert(results != NULL);
+
+    static const size_t expected[] = {1, 2, 0, 2};
+    for (size_t i = 0; i < LINES_PER_THREAD; i++) {
+        const char *line = lines[i % 4];
+        assert(rift_rulebank_match(bank, line, strlen(line), results) == expected[i % 4]);
+    }
+
+    rift_rulebank_results_free(results);
+    return NULL;
+}
+
+/* Test matching with one bank on several threads */
+static void
+test_rulebank_threads(void)
+{
+    rift_rulebank_t *bank = create_bank(RIFT_RULEBANK_OPTION_NONE);
+    pthread_t threads[NUM_THREADS];
+
+    for (size_t i = 0; i < NUM_THREADS; i++) {
+        assert(pthread_create(&threads[i], NULL, match_lines, bank) == 0);
+    }
+    for (size_t i = 0; i < NUM_THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    /* A thread still holding matchers when the bank goes */
+    match_lines(bank);
+    rift_rulebank_free(bank);
+    printf("test_rulebank_threads: PASSED\n");
+}
+
+/* Test results made for another bank and invalid parameters */
+static void
+test_rulebank_invalid(void)
+{
+    rift_rulebank_t *bank = create_bank(RIFT_RULEBANK_OPTION_NONE);
+    rift_rulebank_t *empty = rift_rulebank_create(RIFT_RULEBANK_OPTION_NONE);
+    rift_rulebank_results_t *results = rift_rulebank_results_create(empty);
+    assert(results != NULL);
+
+    assert(rift_rulebank_match(bank, lines[0], strlen(lines[0]), results) == 0);
+    assert(rift_rulebank_match(bank, lines[0], strlen(lines[0]), NULL) == 0);
+    assert(!rift_rulebank_add(NULL, "x", "x", RIFT_REGEX_FLAG_NONE, NULL, NULL));
+    assert(rift_rulebank_find(NULL, "x") == RIFT_RULEBANK_NO_RULE);
+
+    rift_regex_error_t error = {RIFT_REGEX_ERROR_NONE};
+    assert(!rift_rulebank_add(empty, "bad", "(", RIFT_REGEX_FLAG_NONE, NULL, &error));
+    assert(error.code != RIFT_REGEX_ERROR_NONE);
+    assert(rift_rulebank_get_count(empty) == 0);
+
+    rift_rulebank_results_free(results);
+    rift_rulebank_free(empty);
+    rift_rulebank_free(bank);
+    rift_rulebank_free(NULL);
+    printf("test_rulebank_invalid: PASSED\n");
+}
+
+int
+main(void)
+{
+    test_rulebank_rules();
+    test_rulebank_match();
+    test_rulebank_first_match();
+    test_rulebank_threads();
+    test_rulebank_invalid();
+    printf("All rule bank tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,155 @@
+/**
+ * @file short_scan_test.c
+ * @brief Unit tests for lane-parallel matching of many short inputs
+ *
+ * This file contains test cases verifying that scanners agree with a direct
+ * search on every input of a batch, whatever its size and input lengths, and
+ * that automata asserting positions are left to a matcher.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/automaton/automaton.h"
+#include "core/automaton/state.h"
+#include "core/engine/short_scan.h"
+
+/* Build an NFA for ab+ */
+static rift_regex_automaton_t *
+create_test_nfa(void)
+{
+    rift_regex_automaton_t *nfa = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    assert(nfa != NULL);
+
+    rift_regex_state_t *s0 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s1 = rift_automaton_create_state(nfa, false);
+    rift_regex_state_t *s2 = rift_automaton_create_state(nfa, true);
+    assert(s0 && s1 && s2);
+
+    assert(rift_automaton_set_initial_state(nfa, s0));
+    assert(rift_automaton_add_transition(nfa, s0, s1, "a"));
+    assert(rift_automaton_add_transition(nfa, s1, s2, "b"));
+    assert(rift_automaton_add_transition(nfa, s2, s2, "b"));
+
+    return nfa;
+}
+
+/* Whether ab occurs in an input, which is whether ab+ matches somewhere */
+static bool
+expected_match(const char *input, size_t length)
+{
+    for (size_t i = 0; i + 1 < length; i++) {
+        if (input[i] == 'a' && input[i + 1] == 'b') {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Test a batch of inputs of mixed lengths against the direct search */
+void
+test_short_scan_matches(void)
+{
+    rift_regex_error_t error = {0};
+    rift_regex_automaton_t *nfa = create_test_nfa();
+    rift_short_scanner_t *scanner = rift_short_scanner_create_from_automaton(nfa, &error);
+    assert(scanner != NULL);
+    assert(scanner->table != NULL && scanner->matcher == NULL);
+
+    enum { COUNT = 203 };
+    static const char alphabet[] = {'a', 'b', 'c', '\0'};
+    char *inputs[COUNT];
+    size_t lengths[COUNT];
+    unsigned int seed = 7;
+    for (size_t i = 0; i < COUNT; i++) {
+        /* Lengths 0 to 40, so lanes of a group end at different steps */
+        lengths[i] = i % 41;
+        inputs[i] = (char *)malloc(lengths[i] + 1);
+        assert(inputs[i] != NULL);
+        for (size_t j = 0; j < lengths[i]; j++) {
+            seed = seed * 1103515245u + 12345u;
+            inputs[i][j] = alphabet[(seed >> 16) % 4];
+        }
+        inputs[i][lengths[i]] = '\0';
+    }
+
+    uint64_t bitmap[(COUNT + 63) / 64];
+    assert(rift_short_scanner_match(scanner, (const char *const *)inputs, lengths, COUNT, bitmap));
+    size_t matched = 0;
+    for (size_t i = 0; i < COUNT; i++) {
+        bool bit = (bitmap[i / 64] >> (i % 64)) & 1;
+        assert(bit == expected_match(inputs[i], lengths[i]));
+        matched += bit;
+    }
+    assert(matched > 0 && matched < COUNT);
+
+    /* Bits past the last input stay clear */
+    assert((bitmap[COUNT / 64] >> (COUNT % 64)) == 0);
+
+    for (size_t i = 0; i < COUNT; i++) {
+        free(inputs[i]);
+    }
+    rift_short_scanner_free(scanner);
+    rift_automaton_free(nfa);
+    printf("test_short_scan_matches: PASSED\n");
+}
+
+/* Test NUL bytes, NULL inputs, strlen lengths and partial groups */
+void
+test_short_scan_edges(void)
+{
+    rift_regex_automaton_t *nfa = create_test_nfa();
+    rift_short_scanner_t *scanner = rift_short_scanner_create_from_automaton(nfa, NULL);
+    assert(scanner != NULL);
+
+    /* A NUL before the match does not end the search when lengths are given */
+    const char *inputs[] = {"x\0ab", NULL, "ab", "ba", "cabbb"};
+    const size_t lengths[] = {4, 0, 2, 2, 5};
+    uint64_t bitmap = ~0ULL;
+    assert(rift_short_scanner_match(scanner, inputs, lengths, 5, &bitmap));
+    assert(bitmap == ((1ULL << 0) | (1ULL << 2) | (1ULL << 4)));
+
+    /* Without lengths the first input ends at its NUL */
+    assert(rift_short_scanner_match(scanner, inputs, NULL, 5, &bitmap));
+    assert(bitmap == ((1ULL << 2) | (1ULL << 4)));
+
+    assert(rift_short_scanner_match(scanner, inputs, lengths, 0, &bitmap));
+    assert(!rift_short_scanner_match(NULL, inputs, lengths, 5, &bitmap));
+    assert(!rift_short_scanner_match(scanner, NULL, lengths, 5, &bitmap));
+
+    rift_short_scanner_free(scanner);
+    rift_short_scanner_free(NULL);
+    rift_automaton_free(nfa);
+    printf("test_short_scan_edges: PASSED\n");
+}
+
+/* Test that automata asserting positions get no table */
+void
+test_short_scan_rejects_assertions(void)
+{
+    rift_regex_automaton_t *nfa = create_test_nfa();
+    nfa->states[0]->flags |= RIFT_STATE_FLAG_ANCHOR_START;
+    assert(rift_short_scanner_create_from_automaton(nfa, NULL) == NULL);
+    rift_automaton_free(nfa);
+
+    assert(rift_short_scanner_create_from_automaton(NULL, NULL) == NULL);
+    printf("test_short_scan_rejects_assertions: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running short input scanner tests...\n");
+
+    test_short_scan_matches();
+    test_short_scan_edges();
+    test_short_scan_rejects_assertions();
+
+    printf("All short input scanner tests PASSED!\n");
+    return 0;
+}
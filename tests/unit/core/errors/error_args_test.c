@@ -0,0 +1,162 @@
+/**
+ * @file error_args_test.c
+ * @brief Unit tests for the deferred formatting of LibRift error messages
+ *
+ * This file contains unit tests verifying that recorded messages format the
+ * same as printf, that string arguments are copied, that formats the record
+ * cannot hold are formatted right away, and that each thread keeps its own
+ * current error.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "core/errors/error.h"
+#include "core/errors/error_args.h"
+#include "core/errors/regex_error.h"
+
+// Record a message without formatting it
+static bool
+record(rift_error_args_t *args, const char *format, ...)
+{
+    va_list list;
+    va_start(list, format);
+    bool recorded = rift_error_args_capture(args, format, list);
+    va_end(list);
+    return recorded;
+}
+
+// Test: Recorded messages format as printf would
+static void
+test_error_args_format(void)
+{
+    rift_error_args_t args;
+    char buffer[128];
+    char expected[128];
+
+    assert(record(&args, "state %d of %zu at %p: %-6s|%5.2f %lld%%", -3, (size_t)42,
+                  (void *)&args, "abc", 3.14159, 1LL << 40));
+    assert(rift_error_args_pending(&args));
+    assert(rift_error_args_format(&args, buffer, sizeof(buffer)));
+    snprintf(expected, sizeof(expected), "state %d of %zu at %p: %-6s|%5.2f %lld%%", -3,
+             (size_t)42, (void *)&args, "abc", 3.14159, 1LL << 40);
+    assert(strcmp(buffer, expected) == 0);
+
+    // A short buffer truncates like snprintf
+    char small[8];
+    assert(rift_error_args_format(&args, small, sizeof(small)));
+    assert(strcmp(small, "state -") == 0);
+
+    rift_error_args_clear(&args);
+    assert(!rift_error_args_pending(&args));
+    assert(!rift_error_args_format(&args, buffer, sizeof(buffer)));
+
+    printf("test_error_args_format: PASSED\n");
+}
+
+// Test: String arguments are copied and unrecordable formats are refused
+static void
+test_error_args_capture(void)
+{
+    rift_error_args_t args;
+    char buffer[128];
+
+    char name[] = "digits";
+    assert(record(&args, "rule '%s'", name));
+    strcpy(name, "gone!!");
+    assert(rift_error_args_format(&args, buffer, sizeof(buffer)));
+    assert(strcmp(buffer, "rule 'digits'") == 0);
+
+    // '*' widths, too many arguments and too much text are formatted by the caller
+    assert(!record(&args, "%*d", 4, 2) && !rift_error_args_pending(&args));
+    assert(!record(&args, "%d%d%d%d%d%d%d", 1, 2, 3, 4, 5, 6, 7));
+    char long_text[RIFT_ERROR_ARGS_TEXT_LENGTH + 1];
+    memset(long_text, 'a', sizeof(long_text) - 1);
+    long_text[sizeof(long_text) - 1] = '\0';
+    assert(!record(&args, "%s", long_text));
+
+    printf("test_error_args_capture: PASSED\n");
+}
+
+// Test: Regex errors format their message when it is read
+static void
+test_regex_error_deferred(void)
+{
+    rift_regex_error_t error;
+    rift_regex_error_init(&error);
+
+    rift_regex_error_set_formatted(&error, RIFT_REGEX_ERROR_LIMIT_EXCEEDED,
+                                   "cache does not fit in %zu bytes", (size_t)512);
+    assert(error.code == RIFT_REGEX_ERROR_LIMIT_EXCEEDED);
+    assert(error.message[0] == '\0' && "The message is formatted when read");
+
+    char buffer[128];
+    assert(rift_regex_error_format(&error, buffer, sizeof(buffer)));
+    assert(strstr(buffer, "cache does not fit in 512 bytes") != NULL);
+
+    // A copy carries the deferred message along
+    rift_regex_error_t copy;
+    rift_regex_error_init(&copy);
+    assert(rift_regex_error_copy(&copy, &error));
+    assert(strcmp(rift_regex_error_message(&copy), "cache does not fit in 512 bytes") == 0);
+    assert(strcmp(rift_regex_error_message(&error), "cache does not fit in 512 bytes") == 0);
+
+    // A message written into the buffer directly wins over a deferred one
+    rift_regex_error_set_formatted(&error, RIFT_REGEX_ERROR_INTERNAL, "step %d", 7);
+    snprintf(error.message, sizeof(error.message), "%s", "written directly");
+    assert(strcmp(rift_regex_error_message(&error), "written directly") == 0);
+
+    rift_regex_error_clear(&error);
+    assert(strcmp(rift_regex_error_message(&error), "") == 0);
+
+    printf("test_regex_error_deferred: PASSED\n");
+}
+
+// Set an error on another thread
+static void *
+set_error_thread(void *arg)
+{
+    rift_error_set(RIFT_ERROR_TIMEOUT, __LINE__, __FILE__, "worker %d timed out", *(int *)arg);
+    const rift_error_info_t *info = rift_error_get();
+    assert(info->status == RIFT_ERROR_TIMEOUT);
+    assert(strcmp(info->message, "worker 3 timed out") == 0);
+    return NULL;
+}
+
+// Test: Each thread keeps its own current error
+static void
+test_error_thread_local(void)
+{
+    rift_error_set(RIFT_ERROR_SYNTAX, __LINE__, __FILE__, "bad token '%s'", "]");
+
+    int worker = 3;
+    pthread_t thread;
+    assert(pthread_create(&thread, NULL, set_error_thread, &worker) == 0);
+    assert(pthread_join(thread, NULL) == 0);
+
+    const rift_error_info_t *info = rift_error_get();
+    assert(info->status == RIFT_ERROR_SYNTAX);
+    assert(strcmp(info->message, "bad token ']'") == 0);
+
+    rift_error_clear();
+    assert(rift_error_get()->status == RIFT_OK);
+
+    printf("test_error_thread_local: PASSED\n");
+}
+
+int
+main(void)
+{
+    test_error_args_format();
+    test_error_args_capture();
+    test_regex_error_deferred();
+    test_error_thread_local();
+
+    printf("\nAll deferred error tests passed!\n");
+    return 0;
+}
@@ -9,12 +9,19 @@
  * @license MIT License
  */
 
+#include <pthread.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include <librift/core/regex/memory/memory.h>
+#include "core/config/config.h"
+#include "core/engine/pattern.h"
+
+#define NUM_TRACKING_THREADS 8
+#define TRACKING_ALLOCS_PER_THREAD 1000
 
 /* Simple test framework */
 static int tests_run = 0;
@@ -100,6 +107,38 @@ test_strdup(void)
     return true;
 }
 
+/* Test lookup tables below and above the page threshold */
+static bool
+test_table_allocation(void)
+{
+    rift_config_t saved = *rift_config_get();
+    rift_config_t config = saved;
+    config.memory.table_page_threshold = 64 * 1024;
+    config.memory.table_huge_pages = true;
+    TEST_ASSERT("setting the table threshold should succeed", rift_config_set(&config) == RIFT_OK);
+
+    size_t counts[] = {100, 1 << 20};
+    for (size_t i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+        uint32_t *table = rift_table_alloc(counts[i], sizeof(uint32_t));
+        TEST_ASSERT("table allocation should succeed", table != NULL);
+        TEST_ASSERT("tables should be aligned", (size_t)table % RIFT_TABLE_ALIGNMENT == 0);
+        TEST_ASSERT("tables should be zeroed", table[0] == 0 && table[counts[i] - 1] == 0);
+        for (size_t j = 0; j < counts[i]; j++) {
+            table[j] = (uint32_t)j;
+        }
+        TEST_ASSERT("tables should keep their contents", table[counts[i] - 1] == counts[i] - 1);
+        rift_table_free(table);
+    }
+
+    TEST_ASSERT("overflowing tables should fail", rift_table_alloc(SIZE_MAX, 2) == NULL);
+    TEST_ASSERT("empty tables should fail", rift_table_alloc(0, 4) == NULL);
+    rift_table_free(NULL);
+
+    rift_config_set(&saved);
+    return true;
+}
+
+#if RIFT_MEMORY_TRACKING
 /* Test memory tracking */
 static bool
 test_memory_tracking(void)
@@ -151,6 +190,53 @@ test_memory_tracking(void)
     return true;
 }
 
+
+/* Test allocation profiling by subsystem tag */
+static bool
+test_memory_profiling(void)
+{
+    rift_memory_tracking_reset();
+    bool previous = rift_memory_profiling_enable(true);
+
+    /* Allocations count under the tag in use on the thread */
+    rift_memory_tag_t outer = rift_memory_tag_use(RIFT_MEMORY_TAG_PARSER);
+    TEST_ASSERT("the default tag should be other", outer == RIFT_MEMORY_TAG_OTHER);
+    void *node = rift_malloc(100);
+    void *tokens = rift_malloc_tagged(40, RIFT_MEMORY_TAG_TOKENIZER);
+    rift_memory_tag_use(outer);
+
+    /* A resize and a free count under the tag of the block */
+    node = rift_realloc(node, 300);
+    TEST_ASSERT("tagged allocations should succeed", node != NULL && tokens != NULL);
+    rift_free(tokens);
+
+    rift_memory_tag_stats_t stats;
+    rift_memory_get_tag_stats(RIFT_MEMORY_TAG_PARSER, &stats);
+    TEST_ASSERT("parser allocs should be counted", stats.allocs == 1 && stats.frees == 0);
+    TEST_ASSERT("parser bytes should follow the resize",
+                stats.bytes_allocated - stats.bytes_freed == 300);
+    rift_memory_get_tag_stats(RIFT_MEMORY_TAG_TOKENIZER, &stats);
+    TEST_ASSERT("tokenizer block should be counted and freed",
+                stats.allocs == 1 && stats.frees == 1 && stats.bytes_freed == 40);
+    rift_memory_get_tag_stats(RIFT_MEMORY_TAG_DFA, &stats);
+    TEST_ASSERT("untouched tags should stay empty", stats.allocs == 0);
+
+    char report[2048];
+    TEST_ASSERT("profile report should succeed",
+                rift_memory_profile_report(report, sizeof(report)) == RIFT_OK);
+    TEST_ASSERT("profile report should list the tags",
+                strstr(report, "\"parser\": {\"allocs\": 1") != NULL &&
+                    strstr(report, "\"results\"") != NULL);
+    TEST_ASSERT("a short buffer should be reported",
+                rift_memory_profile_report(report, 16) == RIFT_ERROR_BUFFER_OVERFLOW);
+
+    rift_free(node);
+    rift_memory_profiling_enable(previous);
+    rift_memory_tracking_reset();
+    return true;
+}
+#endif
+
 /* Test memory report */
 static bool
 test_memory_report(void)
@@ -176,6 +262,380 @@ test_memory_report(void)
     return true;
 }
 
+#if RIFT_MEMORY_TRACKING
+static void *
+tracking_thread(void *arg)
+{
+    void **blocks = arg;
+    for (int i = 0; i < TRACKING_ALLOCS_PER_THREAD; i++) {
+        blocks[i] = rift_malloc(16 + (size_t)i % 64);
+    }
+    /* Free half here and leave the rest to the main thread */
+    for (int i = 0; i < TRACKING_ALLOCS_PER_THREAD / 2; i++) {
+        rift_free(blocks[i]);
+        blocks[i] = NULL;
+    }
+    return NULL;
+}
+
+/* Test that tracking counts every allocation made on concurrent threads */
+static bool
+test_memory_tracking_threads(void)
+{
+    size_t current_usage, peak_usage, total_allocs, total_frees, active_allocs;
+    static void *blocks[NUM_TRACKING_THREADS][TRACKING_ALLOCS_PER_THREAD];
+
+    bool previous = rift_memory_tracking_enable(true);
+    rift_memory_tracking_reset();
+
+    pthread_t threads[NUM_TRACKING_THREADS];
+    for (int t = 0; t < NUM_TRACKING_THREADS; t++) {
+        TEST_ASSERT("thread should start",
+                    pthread_create(&threads[t], NULL, tracking_thread, blocks[t]) == 0);
+    }
+    for (int t = 0; t < NUM_TRACKING_THREADS; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    rift_memory_get_stats(&current_usage, &peak_usage, &total_allocs, &total_frees, &active_allocs);
+    TEST_ASSERT("Every allocation should be counted",
+                total_allocs == NUM_TRACKING_THREADS * TRACKING_ALLOCS_PER_THREAD);
+    TEST_ASSERT("Every free should be counted",
+                total_frees == NUM_TRACKING_THREADS * TRACKING_ALLOCS_PER_THREAD / 2);
+    TEST_ASSERT("Peak usage should cover current usage", peak_usage >= current_usage);
+
+    /* Blocks freed on another thread than the one that allocated them */
+    for (int t = 0; t < NUM_TRACKING_THREADS; t++) {
+        for (int i = 0; i < TRACKING_ALLOCS_PER_THREAD; i++) {
+            rift_free(blocks[t][i]);
+        }
+    }
+
+    rift_memory_get_stats(&current_usage, &peak_usage, &total_allocs, &total_frees, &active_allocs);
+    TEST_ASSERT("Active allocs should be 0", active_allocs == 0);
+    TEST_ASSERT("Current usage should be 0", current_usage == 0);
+    TEST_ASSERT("Peak usage should outlive the frees", peak_usage > 0);
+
+    rift_memory_tracking_enable(previous);
+    return true;
+}
+
+#endif
+
+static size_t counting_mallocs = 0;
+
+static void *
+counting_malloc(size_t size)
+{
+    counting_mallocs++;
+    return malloc(size);
+}
+
+/* Test that allocator changes in the configuration reach the cached allocator */
+static bool
+test_memory_allocator_change(void)
+{
+    void *before = rift_malloc(32);
+    TEST_ASSERT("malloc should return non-NULL pointer", before != NULL);
+
+    TEST_ASSERT("allocator should be set",
+                rift_config_set_memory_allocator(counting_malloc, realloc, free) == RIFT_OK);
+    void *ptr = rift_malloc(32);
+    TEST_ASSERT("malloc should use the custom allocator", ptr != NULL && counting_mallocs == 1);
+    rift_free(ptr);
+
+    rift_config_reset();
+    ptr = rift_malloc(32);
+    TEST_ASSERT("malloc should go back to the standard allocator", counting_mallocs == 1);
+    rift_free(ptr);
+    rift_free(before);
+    return true;
+}
+
+/* Test arena allocation, alignment and growth in place */
+static bool
+test_arena_allocation(void)
+{
+    rift_arena_t *arena = rift_arena_create(1024);
+    TEST_ASSERT("arena create should return non-NULL pointer", arena != NULL);
+
+    char *first = (char *)rift_arena_alloc(arena, 3);
+    double *second = (double *)rift_arena_alloc(arena, sizeof(double));
+    TEST_ASSERT("arena alloc should return non-NULL pointers", first && second);
+    TEST_ASSERT("arena allocations should be aligned",
+                (size_t)second % _Alignof(max_align_t) == 0);
+    *second = 1.5;
+
+    /* The last allocation grows without moving */
+    double *grown = (double *)rift_arena_realloc(arena, second, sizeof(double), 8 * sizeof(double));
+    TEST_ASSERT("arena realloc should grow the last allocation in place", grown == second);
+    TEST_ASSERT("arena realloc should keep the contents", grown[0] == 1.5);
+
+    /* Anything else is copied */
+    char *moved = (char *)rift_arena_realloc(arena, first, 3, 64);
+    TEST_ASSERT("arena realloc should move an earlier allocation", moved && moved != first);
+
+    int *zeroes = (int *)rift_arena_calloc(arena, 16, sizeof(int));
+    TEST_ASSERT("arena calloc should return non-NULL pointer", zeroes != NULL);
+    for (int i = 0; i < 16; i++) {
+        TEST_ASSERT("arena calloc should zero memory", zeroes[i] == 0);
+    }
+
+    char *copy = rift_arena_strndup(arena, "pattern", 3);
+    TEST_ASSERT("arena strndup should copy at most length bytes", strcmp(copy, "pat") == 0);
+    copy = rift_arena_strdup(arena, "pattern");
+    TEST_ASSERT("arena strdup should copy the string", strcmp(copy, "pattern") == 0);
+
+    rift_arena_stats_t stats;
+    rift_arena_get_stats(arena, &stats);
+    TEST_ASSERT("arena should count its allocations", stats.allocations == 6);
+    TEST_ASSERT("arena should fit small allocations in one block", stats.blocks == 1);
+
+    rift_arena_free(arena);
+    return true;
+}
+
+/* Test that arena blocks are chained, kept on reset and tracked */
+static bool
+test_arena_blocks(void)
+{
+    size_t active_before = 0;
+    size_t active_after = 0;
+
+    rift_memory_tracking_enable(true);
+    rift_memory_tracking_reset();
+    rift_memory_get_stats(NULL, NULL, NULL, NULL, &active_before);
+
+    rift_arena_t *arena = rift_arena_create(1024);
+    TEST_ASSERT("arena create should return non-NULL pointer", arena != NULL);
+
+    for (int i = 0; i < 100; i++) {
+        TEST_ASSERT("arena alloc should return non-NULL pointer",
+                    rift_arena_alloc(arena, 64) != NULL);
+    }
+    void *large = rift_arena_alloc(arena, 4096);
+    TEST_ASSERT("arena should serve allocations larger than a block", large != NULL);
+    memset(large, 0xab, 4096);
+
+    rift_arena_stats_t stats;
+    rift_arena_get_stats(arena, &stats);
+    TEST_ASSERT("arena should chain blocks", stats.blocks > 2);
+    TEST_ASSERT("arena should reserve what it hands out", stats.bytes_reserved >= stats.bytes_used);
+
+    /* Reset keeps one block for the next compilation */
+    rift_arena_reset(arena);
+    rift_arena_get_stats(arena, &stats);
+    TEST_ASSERT("arena reset should clear the counters", stats.allocations == 0);
+    TEST_ASSERT("arena reset should keep one block", stats.blocks == 1);
+
+    rift_arena_free(arena);
+    rift_memory_get_stats(NULL, NULL, NULL, NULL, &active_after);
+    TEST_ASSERT("arena free should release all blocks", active_after == active_before);
+
+    rift_memory_tracking_enable(false);
+    return true;
+}
+
+static void *
+pool_release_thread(void *arg)
+{
+    void **objects = arg;
+    for (int i = 0; i < 4 * RIFT_POOL_THREAD_CACHE; i++) {
+        rift_pool_free(objects[i], 96);
+    }
+    return NULL;
+}
+
+/* Test that pooled objects are reused, also across threads */
+static bool
+test_object_pool(void)
+{
+    rift_pool_trim();
+
+    void *first = rift_pool_alloc(100);
+    TEST_ASSERT("pool alloc should return non-NULL pointer", first != NULL);
+    TEST_ASSERT("pool objects should be aligned", (size_t)first % _Alignof(max_align_t) == 0);
+    memset(first, 0xab, 100);
+    rift_pool_free(first, 100);
+
+#if RIFT_MEMORY_POOLS
+    /* Same size class, same thread: the released object comes back */
+    void *again = rift_pool_alloc(120);
+    TEST_ASSERT("pool should reuse a released object of the same class", again == first);
+    rift_pool_free(again, 120);
+#endif
+
+    /* Objects larger than the pools serve still work */
+    void *large = rift_pool_alloc(RIFT_POOL_MAX_OBJECT_SIZE + 1);
+    TEST_ASSERT("pool should fall back for large objects", large != NULL);
+    memset(large, 0, RIFT_POOL_MAX_OBJECT_SIZE + 1);
+    rift_pool_free(large, RIFT_POOL_MAX_OBJECT_SIZE + 1);
+
+    /* Objects released on another thread reach this one through the global list */
+    static void *objects[4 * RIFT_POOL_THREAD_CACHE];
+    for (int i = 0; i < 4 * RIFT_POOL_THREAD_CACHE; i++) {
+        objects[i] = rift_pool_alloc(96);
+        TEST_ASSERT("pool alloc should return non-NULL pointer", objects[i] != NULL);
+    }
+    pthread_t thread;
+    TEST_ASSERT("thread should start",
+                pthread_create(&thread, NULL, pool_release_thread, objects) == 0);
+    pthread_join(thread, NULL);
+
+    size_t reused = 0;
+    for (int i = 0; i < 4 * RIFT_POOL_THREAD_CACHE; i++) {
+        void *object = rift_pool_alloc(96);
+        TEST_ASSERT("pool alloc should return non-NULL pointer", object != NULL);
+        for (int j = 0; j < 4 * RIFT_POOL_THREAD_CACHE; j++) {
+            if (objects[j] == object) {
+                reused++;
+                break;
+            }
+        }
+        objects[i] = object;
+    }
+#if RIFT_MEMORY_POOLS
+    TEST_ASSERT("pool should hand out objects released on other threads", reused > 0);
+#endif
+    for (int i = 0; i < 4 * RIFT_POOL_THREAD_CACHE; i++) {
+        rift_pool_free(objects[i], 96);
+    }
+
+    rift_pool_trim();
+    return true;
+}
+
+#if RIFT_MEMORY_TRACKING
+/* Context of the counting allocator */
+typedef struct {
+    size_t allocations;
+    size_t deallocations;
+    bool nested_scope;
+} counting_context_t;
+
+static void *
+counting_allocate(void *ctx, size_t size)
+{
+    counting_context_t *context = ctx;
+    context->allocations++;
+    context->nested_scope |= rift_allocator_current() != NULL;
+    return malloc(size);
+}
+
+static void
+counting_deallocate(void *ctx, void *ptr, size_t size)
+{
+    (void)size;
+    counting_context_t *context = ctx;
+    context->deallocations++;
+    free(ptr);
+}
+
+/* Test allocations through an allocator with a context */
+static bool
+test_allocator_scope(void)
+{
+    counting_context_t context = {0, 0, false};
+    rift_allocator_t allocator = {counting_allocate, NULL, counting_deallocate, &context};
+
+    const rift_allocator_t *previous = rift_allocator_use(&allocator);
+    TEST_ASSERT("no allocator should be in use by default", previous == NULL);
+    TEST_ASSERT("the allocator should be in use", rift_allocator_current() == &allocator);
+
+    char *text = rift_strdup("scoped");
+    TEST_ASSERT("scoped allocation should succeed", text != NULL);
+    TEST_ASSERT("scoped allocation should use the allocator", context.allocations == 1);
+    TEST_ASSERT("callbacks should run without an allocator in use", !context.nested_scope);
+
+    /* Without a reallocate callback, a resize allocates, copies and frees */
+    text = rift_realloc(text, 4096);
+    TEST_ASSERT("scoped realloc should succeed", text != NULL);
+    TEST_ASSERT("scoped realloc should keep the contents", strcmp(text, "scoped") == 0);
+    TEST_ASSERT("scoped realloc should use the allocator",
+                context.allocations == 2 && context.deallocations == 1);
+
+    /* Pooled objects come from the allocator and are not kept by the pools */
+    void *object = rift_pool_alloc(64);
+    TEST_ASSERT("scoped pool alloc should succeed", object != NULL);
+    TEST_ASSERT("scoped pool alloc should use the allocator", context.allocations == 3);
+    rift_pool_free(object, 64);
+    TEST_ASSERT("scoped pool free should reach the allocator", context.deallocations == 2);
+
+    rift_allocator_use(previous);
+    TEST_ASSERT("the scope should end", rift_allocator_current() == NULL);
+
+    /* The block goes back to its allocator after the scope ended */
+    void *unscoped = rift_malloc(32);
+    TEST_ASSERT("unscoped allocation should not use the allocator", context.allocations == 3);
+    rift_free(unscoped);
+    rift_free(text);
+    TEST_ASSERT("free after the scope should reach the allocator", context.deallocations == 3);
+
+    /* An arena allocator frees everything at once */
+    rift_arena_t *arena = rift_arena_create(0);
+    TEST_ASSERT("arena creation should succeed", arena != NULL);
+    rift_allocator_t arena_allocator;
+    rift_allocator_init_arena(&arena_allocator, arena);
+    rift_allocator_use(&arena_allocator);
+    for (int i = 0; i < 100; i++) {
+        void *ptr = rift_malloc(100);
+        TEST_ASSERT("arena allocation should succeed", ptr != NULL);
+        TEST_ASSERT("arena allocations should be aligned",
+                    (size_t)ptr % _Alignof(max_align_t) == 0);
+        if (i % 2 == 0) {
+            rift_free(ptr);
+        }
+    }
+    rift_allocator_use(NULL);
+
+    rift_arena_stats_t stats;
+    rift_arena_get_stats(arena, &stats);
+    TEST_ASSERT("allocations should come from the arena", stats.allocations == 100);
+    rift_arena_free(arena);
+
+    return true;
+}
+
+/* Test compiling a pattern through an arena allocator */
+static bool
+test_compile_with_allocator(void)
+{
+    rift_arena_t *arena = rift_arena_create(0);
+    TEST_ASSERT("arena creation should succeed", arena != NULL);
+    rift_allocator_t arena_allocator;
+    rift_allocator_init_arena(&arena_allocator, arena);
+
+    rift_regex_error_t error = {RIFT_REGEX_ERROR_NONE};
+    rift_regex_pattern_t *pattern =
+        rift_regex_compile_with_allocator("(?<word>[a-z]+)=[0-9]+", RIFT_REGEX_FLAG_NONE,
+                                          &arena_allocator, &error);
+    TEST_ASSERT("compilation through the arena should succeed", pattern != NULL);
+    TEST_ASSERT("the scope should end with the compilation", rift_allocator_current() == NULL);
+
+    /* The group name table is allocated with rift_calloc, so it comes from the arena */
+    rift_arena_stats_t stats;
+    rift_arena_get_stats(arena, &stats);
+    TEST_ASSERT("compilation blocks should come from the arena", stats.allocations > 0);
+    TEST_ASSERT("the pattern should keep its groups",
+                rift_regex_pattern_group_index(pattern, "word") == 1);
+
+    /* Without an allocator the one in use on the thread is kept */
+    size_t arena_allocations = stats.allocations;
+    rift_regex_pattern_t *unscoped =
+        rift_regex_compile_with_allocator("(?<word>[a-z]+)", RIFT_REGEX_FLAG_NONE, NULL, &error);
+    TEST_ASSERT("compilation without an allocator should succeed", unscoped != NULL);
+    rift_arena_get_stats(arena, &stats);
+    TEST_ASSERT("compilation without an allocator should not use the arena",
+                stats.allocations == arena_allocations);
+    rift_regex_pattern_free(unscoped);
+
+    rift_regex_pattern_free(pattern);
+    rift_arena_free(arena);
+
+    return true;
+}
+#endif
+
 int
 main(void)
 {
@@ -185,8 +645,23 @@ main(void)
     RUN_TEST(test_calloc);
     RUN_TEST(test_realloc);
     RUN_TEST(test_strdup);
+    RUN_TEST(test_table_allocation);
+#if RIFT_MEMORY_TRACKING
     RUN_TEST(test_memory_tracking);
+    RUN_TEST(test_memory_profiling);
+#endif
     RUN_TEST(test_memory_report);
+#if RIFT_MEMORY_TRACKING
+    RUN_TEST(test_memory_tracking_threads);
+#endif
+    RUN_TEST(test_memory_allocator_change);
+    RUN_TEST(test_arena_allocation);
+    RUN_TEST(test_arena_blocks);
+    RUN_TEST(test_object_pool);
+#if RIFT_MEMORY_TRACKING
+    RUN_TEST(test_allocator_scope);
+    RUN_TEST(test_compile_with_allocator);
+#endif
 
     printf("\nTest summary: %d tests, %d passed, %d failed\n", tests_run, tests_run - tests_failed,
            tests_failed);
@@ -8,6 +8,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "librift/core/regex/memory/memory.h"
 #include "librift/parser/ast_node.h"
 
 /* Test fixture setup */
@@ -105,6 +106,77 @@ test_node_clone(void)
     rift_regex_ast_node_free(clone);
 }
 
+/* Test nodes that live in an arena */
+static void
+test_node_in_arena(void)
+{
+    rift_arena_t *arena = rift_arena_create(0);
+    assert(arena != NULL);
+
+    rift_regex_ast_node_t *root =
+        rift_regex_ast_node_create_in_arena(arena, RIFT_REGEX_AST_NODE_CONCATENATION);
+    assert(root != NULL);
+    assert(root->arena == arena);
+
+    for (int i = 0; i < 10; i++) {
+        rift_regex_ast_node_t *child =
+            rift_regex_ast_node_create_in_arena(arena, RIFT_REGEX_AST_NODE_CHAR);
+        assert(child != NULL);
+        assert(rift_regex_ast_node_set_value(child, "a"));
+        assert(rift_regex_ast_node_set_value(child, "b"));
+        assert(rift_regex_ast_node_add_child(root, child));
+    }
+    assert(root->num_children == 10);
+    assert(strcmp(rift_regex_ast_node_get_value(root->children[9]), "b") == 0);
+
+    // A heap child below an arena node is still freed with the tree
+    rift_regex_ast_node_t *heap_child = rift_regex_ast_node_create(RIFT_REGEX_AST_NODE_DOT);
+    assert(heap_child != NULL);
+    assert(rift_regex_ast_node_add_child(root, heap_child));
+
+    // Clones go on the heap and outlive the arena
+    rift_regex_ast_node_t *clone = rift_regex_ast_node_clone_recursive(root);
+    assert(clone != NULL);
+    assert(clone->arena == NULL);
+
+    rift_regex_ast_node_free_recursive(root);
+    rift_arena_free(arena);
+
+    assert(clone->num_children == 11);
+    assert(strcmp(rift_regex_ast_node_get_value(clone->children[0]), "b") == 0);
+    rift_regex_ast_node_free_recursive(clone);
+}
+
+/* Test content hashes of subtrees */
+static void
+test_node_hash(void)
+{
+    // (ab) built twice hashes alike
+    rift_regex_ast_node_t *trees[2];
+    for (int i = 0; i < 2; i++) {
+        trees[i] = rift_regex_ast_node_create(RIFT_REGEX_AST_NODE_GROUP);
+        rift_regex_ast_node_t *literal = rift_regex_ast_node_create(RIFT_REGEX_AST_NODE_LITERAL);
+        assert(trees[i] != NULL && literal != NULL);
+        assert(rift_regex_ast_node_set_value(literal, "ab"));
+        assert(rift_regex_ast_node_add_child(trees[i], literal));
+    }
+    uint64_t hash = rift_regex_ast_node_hash(trees[0]);
+    assert(hash != 0);
+    assert(rift_regex_ast_node_hash(trees[1]) == hash);
+
+    // Changing a child is seen by the hash of its ancestors
+    assert(rift_regex_ast_node_set_value(trees[1]->children[0], "ac"));
+    assert(rift_regex_ast_node_hash(trees[1]) != hash);
+    assert(rift_regex_ast_node_set_value(trees[1]->children[0], "ab"));
+    assert(rift_regex_ast_node_hash(trees[1]) == hash);
+
+    rift_regex_ast_node_free_recursive(rift_regex_ast_node_remove_child(trees[1], 0));
+    assert(rift_regex_ast_node_hash(trees[1]) != hash);
+
+    rift_regex_ast_node_free_recursive(trees[0]);
+    rift_regex_ast_node_free_recursive(trees[1]);
+}
+
 int
 main(void)
 {
@@ -115,6 +187,8 @@ main(void)
     test_node_add_child();
     test_node_is_type();
     test_node_clone();
+    test_node_in_arena();
+    test_node_hash();
 
     teardown();
     printf("All tests passed!\n");
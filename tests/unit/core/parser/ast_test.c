@@ -12,6 +12,7 @@
 #include "ctest.h"
 #include "librift/parser/ast.h"
 #include "librift/parser/ast_node.h"
+#include "librift/parser/flat_ast.h"
 
 // Setup and teardown functions run before and after each test
 CTEST_SETUP(ast)
@@ -91,6 +92,48 @@ CTEST(ast, clone_ast)
     rift_regex_ast_free(clone);
 }
 
+// Test the flat form of an AST
+CTEST(ast, flat_ast)
+{
+    rift_regex_ast_t *ast = rift_regex_ast_create();
+
+    // Create a pattern: "(a)a"
+    rift_regex_ast_node_t *concat = rift_regex_ast_node_create(RIFT_REGEX_AST_NODE_CONCATENATION);
+    rift_regex_ast_node_t *group = rift_regex_ast_node_create(RIFT_REGEX_AST_NODE_GROUP);
+    rift_regex_ast_node_t *char_a = rift_regex_ast_node_create(RIFT_REGEX_AST_NODE_CHAR);
+    rift_regex_ast_node_t *char_b = rift_regex_ast_node_create(RIFT_REGEX_AST_NODE_CHAR);
+
+    rift_regex_ast_node_set_value(char_a, "a");
+    rift_regex_ast_node_set_value(char_b, "a");
+    rift_regex_ast_node_add_child(group, char_a);
+    rift_regex_ast_node_add_child(concat, group);
+    rift_regex_ast_node_add_child(concat, char_b);
+    rift_regex_ast_set_root(ast, concat);
+
+    rift_regex_flat_ast_t *flat = rift_regex_flat_ast_from_ast(ast, NULL);
+    ASSERT_NOT_NULL(flat);
+    ASSERT_EQUAL(rift_regex_flat_ast_get_node_count(flat), 4);
+    ASSERT_EQUAL(rift_regex_flat_ast_count_groups(flat), 1);
+
+    // Nodes come depth-first, and equal values share one pool entry
+    rift_regex_flat_node_id_t second =
+        rift_regex_flat_ast_get_child(flat, RIFT_REGEX_FLAT_AST_ROOT, 1);
+    ASSERT_EQUAL(second, 3);
+    ASSERT_EQUAL(rift_regex_flat_ast_get_parent(flat, second), RIFT_REGEX_FLAT_AST_ROOT);
+    ASSERT_TRUE(rift_regex_flat_ast_is_type(flat, 1, RIFT_REGEX_AST_NODE_GROUP));
+    ASSERT_EQUAL_PTR(rift_regex_flat_ast_get_node_value(flat, 2),
+                     rift_regex_flat_ast_get_node_value(flat, second));
+    ASSERT_STR(rift_regex_flat_ast_get_node_value(flat, second), "a");
+
+    rift_regex_ast_node_t *tree = rift_regex_flat_ast_to_node(flat, RIFT_REGEX_FLAT_AST_ROOT, NULL);
+    ASSERT_NOT_NULL(tree);
+    ASSERT_EQUAL(rift_regex_ast_node_get_child_count(tree), 2);
+
+    rift_regex_ast_node_free_recursive(tree);
+    rift_regex_flat_ast_free(flat);
+    rift_regex_ast_free(ast);
+}
+
 // Main function that runs all tests
 int
 main(int argc, const char *argv[])
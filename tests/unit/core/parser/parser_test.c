@@ -111,6 +111,28 @@ test_parser_invalid_pattern(void **state)
     assert_int_not_equal(pos, (size_t)-1);
 }
 
+static void
+test_parser_rift_syntax(void **state)
+{
+    rift_regex_parser_t *parser = (rift_regex_parser_t *)*state;
+
+    /* R'' patterns need the -lrift flag */
+    assert_null(rift_regex_parser_parse(parser, "R'a+b'"));
+    assert_int_equal(rift_regex_parser_get_error_code(parser),
+                     RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE);
+
+    assert_true(rift_regex_parser_set_rift_flag(parser, true));
+    rift_regex_ast_t *ast = rift_regex_parser_parse(parser, "R'(a|b)+c'");
+    assert_non_null(ast);
+    assert_true(rift_regex_parser_is_rift_syntax(parser));
+    assert_int_equal(ast->group_count, 1);
+    rift_regex_ast_free(ast);
+
+    /* Error positions refer to the whole pattern, quotes included */
+    assert_null(rift_regex_parser_parse(parser, "R'a(b'"));
+    assert_int_equal(rift_regex_parser_get_error_position(parser), 3);
+}
+
 int
 main(void)
 {
@@ -121,6 +143,7 @@ main(void)
         cmocka_unit_test_setup_teardown(test_parser_with_options, setup, teardown),
         cmocka_unit_test_setup_teardown(test_parser_complex_pattern, setup, teardown),
         cmocka_unit_test_setup_teardown(test_parser_invalid_pattern, setup, teardown),
+        cmocka_unit_test_setup_teardown(test_parser_rift_syntax, setup, teardown),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
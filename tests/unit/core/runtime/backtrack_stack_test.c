@@ -0,0 +1,186 @@
+/**
+ * @file backtrack_stack_test.c
+ * @brief Unit tests for the contiguous backtrack stack
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "core/runtime/backtrack_stack.h"
+
+/* Mock regex state structure for testing */
+typedef struct {
+    int id;
+} mock_regex_state_t;
+
+/* Test push and pop order and the depth limit */
+void
+test_backtrack_stack_push_pop(void)
+{
+    rift_backtrack_stack_t *stack = rift_backtrack_stack_create(3, 0);
+    assert(stack != NULL);
+    assert(rift_backtrack_stack_is_empty(stack));
+
+    mock_regex_state_t states[3] = {{1}, {2}, {3}};
+    for (size_t i = 0; i < 3; i++) {
+        assert(rift_backtrack_stack_push(stack, (struct rift_regex_state *)&states[i], i * 10));
+    }
+    assert(!rift_backtrack_stack_push(stack, (struct rift_regex_state *)&states[0], 99));
+    assert(rift_backtrack_stack_get_depth(stack) == 3);
+
+    for (size_t i = 3; i > 0; i--) {
+        struct rift_regex_state *state = NULL;
+        size_t pos = 0;
+        assert(rift_backtrack_stack_pop(stack, &state, &pos));
+        assert(state == (struct rift_regex_state *)&states[i - 1]);
+        assert(pos == (i - 1) * 10);
+    }
+
+    struct rift_regex_state *state = NULL;
+    size_t pos = 0;
+    assert(!rift_backtrack_stack_pop(stack, &state, &pos));
+    assert(rift_backtrack_stack_is_empty(stack));
+
+    rift_backtrack_stack_free(stack);
+    printf("test_backtrack_stack_push_pop: PASSED\n");
+}
+
+/* Test that a pop rolls back exactly the slots written since its push */
+void
+test_backtrack_stack_undo_log(void)
+{
+    rift_backtrack_stack_t *stack = rift_backtrack_stack_create(100, 2);
+    assert(stack != NULL);
+    assert(rift_backtrack_stack_get_slot(stack, 0) == RIFT_BACKTRACK_SLOT_UNSET);
+
+    mock_regex_state_t state1 = {1};
+    mock_regex_state_t state2 = {2};
+
+    // Writes below every frame are not logged
+    assert(rift_backtrack_stack_set_slot(stack, 0, 1));
+    assert(stack->undo_count == 0);
+
+    assert(rift_backtrack_stack_push(stack, (struct rift_regex_state *)&state1, 1));
+    assert(rift_backtrack_stack_set_slot(stack, 1, 4));
+    assert(rift_backtrack_stack_set_slot(stack, 1, 4));
+    assert(stack->undo_count == 1);
+
+    assert(rift_backtrack_stack_push(stack, (struct rift_regex_state *)&state2, 4));
+    assert(rift_backtrack_stack_set_slot(stack, 0, 5));
+    assert(rift_backtrack_stack_set_slot(stack, 1, 7));
+    assert(rift_backtrack_stack_set_slot(stack, 1, 8));
+    assert(!rift_backtrack_stack_set_slot(stack, 4, 0));
+
+    struct rift_regex_state *state = NULL;
+    size_t pos = 0;
+    assert(rift_backtrack_stack_pop(stack, &state, &pos));
+    assert(pos == 4);
+    assert(rift_backtrack_stack_get_slot(stack, 0) == 1);
+    assert(rift_backtrack_stack_get_slot(stack, 1) == 4);
+
+    assert(rift_backtrack_stack_pop(stack, &state, &pos));
+    assert(pos == 1);
+    assert(rift_backtrack_stack_get_slot(stack, 0) == 1);
+    assert(rift_backtrack_stack_get_slot(stack, 1) == RIFT_BACKTRACK_SLOT_UNSET);
+    assert(stack->undo_count == 0);
+
+    rift_backtrack_stack_free(stack);
+    printf("test_backtrack_stack_undo_log: PASSED\n");
+}
+
+/* Test growth past the initial capacity and reset */
+void
+test_backtrack_stack_growth_reset(void)
+{
+    size_t count = RIFT_BACKTRACK_STACK_INITIAL_CAPACITY * 4 + 1;
+    rift_backtrack_stack_t *stack = rift_backtrack_stack_create(count, 1);
+    assert(stack != NULL);
+
+    mock_regex_state_t state1 = {1};
+    for (size_t i = 0; i < count; i++) {
+        assert(rift_backtrack_stack_push(stack, (struct rift_regex_state *)&state1, i));
+        assert(rift_backtrack_stack_set_slot(stack, 0, i + 1));
+    }
+    assert(rift_backtrack_stack_get_depth(stack) == count);
+
+    for (size_t i = count; i > 0; i--) {
+        struct rift_regex_state *state = NULL;
+        size_t pos = 0;
+        assert(rift_backtrack_stack_pop(stack, &state, &pos));
+        assert(pos == i - 1);
+        assert(rift_backtrack_stack_get_slot(stack, 0) ==
+               (i == 1 ? RIFT_BACKTRACK_SLOT_UNSET : i - 1));
+    }
+
+    assert(rift_backtrack_stack_push(stack, (struct rift_regex_state *)&state1, 0));
+    assert(rift_backtrack_stack_set_slot(stack, 1, 3));
+    rift_backtrack_stack_reset(stack);
+    assert(rift_backtrack_stack_is_empty(stack));
+    assert(stack->undo_count == 0);
+    assert(rift_backtrack_stack_get_slot(stack, 1) == RIFT_BACKTRACK_SLOT_UNSET);
+
+    rift_backtrack_stack_free(stack);
+    printf("test_backtrack_stack_growth_reset: PASSED\n");
+}
+
+/* Test that a cut drops frames but keeps the slots and their undo entries */
+void
+test_backtrack_stack_cut(void)
+{
+    rift_backtrack_stack_t *stack = rift_backtrack_stack_create(100, 1);
+    assert(stack != NULL);
+
+    mock_regex_state_t state1 = {1};
+    mock_regex_state_t state2 = {2};
+
+    // An atomic region entered at depth 1, with two points taken inside it
+    assert(rift_backtrack_stack_push(stack, (struct rift_regex_state *)&state1, 0));
+    assert(rift_backtrack_stack_set_slot(stack, 0, 1));
+    size_t entry_depth = rift_backtrack_stack_get_depth(stack);
+    assert(rift_backtrack_stack_push(stack, (struct rift_regex_state *)&state2, 1));
+    assert(rift_backtrack_stack_set_slot(stack, 0, 2));
+    assert(rift_backtrack_stack_push(stack, (struct rift_regex_state *)&state2, 2));
+    assert(rift_backtrack_stack_set_slot(stack, 0, 3));
+
+    assert(!rift_backtrack_stack_cut(stack, 4));
+    assert(rift_backtrack_stack_cut(stack, entry_depth));
+    assert(rift_backtrack_stack_get_depth(stack) == 1);
+    assert(rift_backtrack_stack_get_slot(stack, 0) == 3);
+
+    // The point below the region still undoes every write made after it
+    struct rift_regex_state *state = NULL;
+    size_t pos = 0;
+    assert(rift_backtrack_stack_pop(stack, &state, &pos));
+    assert(state == (struct rift_regex_state *)&state1 && pos == 0);
+    assert(rift_backtrack_stack_get_slot(stack, 0) == RIFT_BACKTRACK_SLOT_UNSET);
+    assert(stack->undo_count == 0);
+
+    // Cutting to the bottom leaves nothing to roll back
+    assert(rift_backtrack_stack_push(stack, (struct rift_regex_state *)&state1, 0));
+    assert(rift_backtrack_stack_set_slot(stack, 0, 5));
+    assert(rift_backtrack_stack_cut(stack, 0));
+    assert(rift_backtrack_stack_is_empty(stack));
+    assert(stack->undo_count == 0);
+    assert(rift_backtrack_stack_get_slot(stack, 0) == 5);
+
+    rift_backtrack_stack_free(stack);
+    printf("test_backtrack_stack_cut: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running backtrack stack tests...\n");
+
+    test_backtrack_stack_push_pop();
+    test_backtrack_stack_undo_log();
+    test_backtrack_stack_growth_reset();
+    test_backtrack_stack_cut();
+
+    printf("All backtrack stack tests passed!\n");
+    return 0;
+}
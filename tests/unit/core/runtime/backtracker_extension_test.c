@@ -14,8 +14,7 @@
 #include <stdlib.h>
 #include <string.h>
 
-#include "librift/runtime/backtracker/backtracker.h"
-#include "librift/runtime/backtracker_extension.h"
+#include "core/runtime/backtracker.h"
 
 /**
  * @brief Test the rift_backtracker_get_num_groups function
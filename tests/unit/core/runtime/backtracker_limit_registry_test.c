@@ -13,6 +13,8 @@ static void test_global_config(void);
 static void test_pattern_config(void);
 static void test_match_config(void);
 static void test_effective_config(void);
+static void test_resolve_snapshot(void);
+static void test_pattern_stats(void);
 
 int
 main(void)
@@ -24,6 +26,8 @@ main(void)
     test_pattern_config();
     test_match_config();
     test_effective_config();
+    test_resolve_snapshot();
+    test_pattern_stats();
 
     printf("All tests passed!\n");
     return 0;
@@ -165,3 +169,101 @@ test_effective_config(void)
     rift_backtrack_limit_registry_free(registry);
     printf("Effective config test passed\n");
 }
+
+static void
+test_resolve_snapshot(void)
+{
+    rift_backtrack_limit_registry_t *registry = rift_backtrack_limit_registry_create();
+    assert(registry != NULL);
+
+    uint64_t generation = rift_backtrack_limit_registry_get_generation(registry);
+    assert(generation != 0);
+
+    rift_backtrack_limits_t limits;
+    assert(rift_backtrack_limit_registry_resolve(registry, 1, 2, &limits));
+    assert(limits.max_depth == 1000);
+    assert(limits.generation == generation);
+
+    // Every change publishes a new generation
+    rift_backtrack_limit_config_t pattern_config = {200, 300, 400, RIFT_BACKTRACK_SCOPE_PATTERN,
+                                                    true};
+    assert(rift_backtrack_limit_registry_register_pattern(registry, 1, &pattern_config));
+    assert(rift_backtrack_limit_registry_get_generation(registry) > generation);
+
+    assert(rift_backtrack_limit_registry_resolve(registry, 1, 2, &limits));
+    assert(limits.max_depth == 200);
+    assert(limits.max_duration_ms == 300);
+    assert(limits.max_transitions == 400);
+
+    // Other patterns keep the global limits
+    assert(rift_backtrack_limit_registry_resolve(registry, 7, 2, &limits));
+    assert(limits.max_depth == 1000);
+
+    // Match limits override pattern limits, unless they defer to them
+    rift_backtrack_limit_config_t match_config = {50, 60, 70, RIFT_BACKTRACK_SCOPE_MATCH, true};
+    assert(rift_backtrack_limit_registry_register_match(registry, 2, &match_config));
+    assert(rift_backtrack_limit_registry_resolve(registry, 1, 2, &limits));
+    assert(limits.max_depth == 50);
+
+    match_config.override_parent = false;
+    assert(rift_backtrack_limit_registry_register_match(registry, 2, &match_config));
+    assert(rift_backtrack_limit_registry_resolve(registry, 1, 2, &limits));
+    assert(limits.max_depth == 200);
+    assert(limits.generation == rift_backtrack_limit_registry_get_generation(registry));
+
+    rift_backtrack_limit_registry_free(registry);
+    printf("Resolve snapshot test passed\n");
+}
+
+static void
+test_pattern_stats(void)
+{
+    rift_backtrack_limit_registry_t *registry = rift_backtrack_limit_registry_create();
+    assert(registry != NULL);
+
+    rift_match_stats_t stats;
+    assert(!rift_backtrack_limit_registry_get_pattern_stats(registry, 5, &stats));
+    assert(stats.searches == 0);
+    assert(rift_backtrack_limit_registry_get_stats_patterns(registry, NULL, 0) == 0);
+
+    // Searches are summed per pattern, and the deepest stack is kept
+    rift_match_stats_t search = {0};
+    search.searches = 1;
+    search.attempts = 3;
+    search.engine_attempts[RIFT_MATCH_ENGINE_BACKTRACKER] = 3;
+    search.engine = RIFT_MATCH_ENGINE_BACKTRACKER;
+    search.steps = 40;
+    search.backtrack_pushes = 7;
+    search.max_stack_depth = 4;
+    assert(rift_backtrack_limit_registry_record_stats(registry, 5, &search));
+
+    search.max_stack_depth = 2;
+    assert(rift_backtrack_limit_registry_record_stats(registry, 5, &search));
+    assert(rift_backtrack_limit_registry_record_stats(registry, 2, &search));
+
+    assert(rift_backtrack_limit_registry_get_pattern_stats(registry, 5, &stats));
+    assert(stats.searches == 2);
+    assert(stats.steps == 80);
+    assert(stats.backtrack_pushes == 14);
+    assert(stats.engine_attempts[RIFT_MATCH_ENGINE_BACKTRACKER] == 6);
+    assert(stats.max_stack_depth == 4);
+    assert(stats.engine == RIFT_MATCH_ENGINE_BACKTRACKER);
+
+    // Patterns are listed in increasing order, whatever order they came in
+    uint32_t ids[4];
+    assert(rift_backtrack_limit_registry_get_stats_patterns(registry, ids, 4) == 2);
+    assert(ids[0] == 2 && ids[1] == 5);
+    assert(rift_backtrack_limit_registry_get_stats_patterns(registry, ids, 1) == 2);
+
+    // Telemetry does not change the limits
+    uint64_t generation = rift_backtrack_limit_registry_get_generation(registry);
+    assert(rift_backtrack_limit_registry_record_stats(registry, 9, &search));
+    assert(rift_backtrack_limit_registry_get_generation(registry) == generation);
+
+    rift_backtrack_limit_registry_reset_stats(registry);
+    assert(!rift_backtrack_limit_registry_get_pattern_stats(registry, 5, &stats));
+    assert(rift_backtrack_limit_registry_get_stats_patterns(registry, NULL, 0) == 0);
+
+    rift_backtrack_limit_registry_free(registry);
+    printf("Pattern stats test passed\n");
+}
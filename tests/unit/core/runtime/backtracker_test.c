@@ -15,7 +15,7 @@
 #include <stdlib.h>
 #include <string.h>
 
-#include "librift/runtime/backtracker.h"
+#include "core/runtime/backtracker.h"
 
 /* Mock regex state structure for testing */
 typedef struct {
@@ -31,10 +31,10 @@ test_backtracker_create(void)
 
     rift_regex_backtracker_t *backtracker = rift_backtracker_create(max_depth, num_groups);
     assert(backtracker != NULL);
-    assert(backtracker->stack_top == NULL);
-    assert(backtracker->current_depth == 0);
-    assert(backtracker->max_depth == max_depth);
-    assert(backtracker->num_groups == num_groups);
+    assert(rift_backtracker_is_empty(backtracker));
+    assert(rift_backtracker_get_depth(backtracker) == 0);
+    assert(rift_backtracker_get_max_depth(backtracker) == max_depth);
+    assert(rift_backtracker_get_num_groups(backtracker) == num_groups);
 
     rift_backtracker_free(backtracker);
     printf("test_backtracker_create: PASSED\n");
@@ -46,6 +46,8 @@ test_backtracker_push_pop(void)
 {
     rift_regex_backtracker_t *backtracker = rift_backtracker_create(10, 2);
     assert(backtracker != NULL);
+    size_t starts[2] = {0, 0};
+    size_t ends[2] = {0, 0};
 
     mock_regex_state_t state1 = {.id = 1};
     mock_regex_state_t state2 = {.id = 2};
@@ -55,24 +57,25 @@ test_backtracker_push_pop(void)
     assert(rift_backtracker_get_depth(backtracker) == 0);
 
     // Push first state
-    assert(rift_backtracker_push(backtracker, (rift_regex_state_t *)&state1, 2));
+    assert(rift_backtracker_push(backtracker, (rift_regex_state_t *)&state1, 0, starts, ends, 2));
     assert(!rift_backtracker_is_empty(backtracker));
     assert(rift_backtracker_get_depth(backtracker) == 1);
 
     // Push second state
-    assert(rift_backtracker_push(backtracker, (rift_regex_state_t *)&state2, 2));
+    assert(rift_backtracker_push(backtracker, (rift_regex_state_t *)&state2, 0, starts, ends, 2));
     assert(rift_backtracker_get_depth(backtracker) == 2);
 
     // Pop and verify states
     rift_regex_state_t *popped_state;
+    size_t pos;
     size_t num_groups;
 
-    assert(rift_backtracker_pop(backtracker, &popped_state, &num_groups));
+    assert(rift_backtracker_pop(backtracker, &popped_state, &pos, NULL, NULL, &num_groups));
     assert(((mock_regex_state_t *)popped_state)->id == 2);
     assert(num_groups == 2);
     assert(rift_backtracker_get_depth(backtracker) == 1);
 
-    assert(rift_backtracker_pop(backtracker, &popped_state, &num_groups));
+    assert(rift_backtracker_pop(backtracker, &popped_state, &pos, NULL, NULL, &num_groups));
     assert(((mock_regex_state_t *)popped_state)->id == 1);
     assert(num_groups == 2);
     assert(rift_backtracker_get_depth(backtracker) == 0);
@@ -91,22 +94,24 @@ test_backtracker_max_depth(void)
     // Create backtracker with small max depth
     rift_regex_backtracker_t *backtracker = rift_backtracker_create(2, 1);
     assert(backtracker != NULL);
+    size_t starts[1] = {0};
+    size_t ends[1] = {0};
 
     mock_regex_state_t state1 = {.id = 1};
     mock_regex_state_t state2 = {.id = 2};
     mock_regex_state_t state3 = {.id = 3};
 
     // Push up to max depth
-    assert(rift_backtracker_push(backtracker, (rift_regex_state_t *)&state1, 1));
-    assert(rift_backtracker_push(backtracker, (rift_regex_state_t *)&state2, 1));
+    assert(rift_backtracker_push(backtracker, (rift_regex_state_t *)&state1, 0, starts, ends, 1));
+    assert(rift_backtracker_push(backtracker, (rift_regex_state_t *)&state2, 0, starts, ends, 1));
 
     // Try to push beyond max depth, should fail
-    assert(!rift_backtracker_push(backtracker, (rift_regex_state_t *)&state3, 1));
+    assert(!rift_backtracker_push(backtracker, (rift_regex_state_t *)&state3, 0, starts, ends, 1));
     assert(rift_backtracker_get_depth(backtracker) == 2);
 
     // Update max depth and try again
     assert(rift_backtracker_set_max_depth(backtracker, 3));
-    assert(rift_backtracker_push(backtracker, (rift_regex_state_t *)&state3, 1));
+    assert(rift_backtracker_push(backtracker, (rift_regex_state_t *)&state3, 0, starts, ends, 1));
     assert(rift_backtracker_get_depth(backtracker) == 3);
 
     rift_backtracker_free(backtracker);
@@ -119,17 +124,20 @@ test_backtracker_peek(void)
 {
     rift_regex_backtracker_t *backtracker = rift_backtracker_create(5, 1);
     assert(backtracker != NULL);
+    size_t starts[1] = {0};
+    size_t ends[1] = {0};
 
     mock_regex_state_t state1 = {.id = 123};
 
     // Peek on empty backtracker should fail
     rift_regex_state_t *peeked_state;
+    size_t pos;
     size_t num_groups;
-    assert(!rift_backtracker_peek(backtracker, &peeked_state, &num_groups));
+    assert(!rift_backtracker_peek(backtracker, &peeked_state, &pos, NULL, NULL, &num_groups));
 
     // Push a state and peek
-    assert(rift_backtracker_push(backtracker, (rift_regex_state_t *)&state1, 1));
-    assert(rift_backtracker_peek(backtracker, &peeked_state, &num_groups));
+    assert(rift_backtracker_push(backtracker, (rift_regex_state_t *)&state1, 0, starts, ends, 1));
+    assert(rift_backtracker_peek(backtracker, &peeked_state, &pos, NULL, NULL, &num_groups));
     assert(((mock_regex_state_t *)peeked_state)->id == 123);
     assert(num_groups == 1);
 
@@ -146,12 +154,14 @@ test_backtracker_reset(void)
 {
     rift_regex_backtracker_t *backtracker = rift_backtracker_create(5, 1);
     assert(backtracker != NULL);
+    size_t starts[1] = {0};
+    size_t ends[1] = {0};
 
     mock_regex_state_t state = {.id = 1};
 
     // Push some states
-    assert(rift_backtracker_push(backtracker, (rift_regex_state_t *)&state, 1));
-    assert(rift_backtracker_push(backtracker, (rift_regex_state_t *)&state, 1));
+    assert(rift_backtracker_push(backtracker, (rift_regex_state_t *)&state, 0, starts, ends, 1));
+    assert(rift_backtracker_push(backtracker, (rift_regex_state_t *)&state, 0, starts, ends, 1));
     assert(rift_backtracker_get_depth(backtracker) == 2);
 
     // Reset and verify
@@ -169,26 +179,29 @@ test_backtracker_clone(void)
 {
     rift_regex_backtracker_t *backtracker = rift_backtracker_create(5, 1);
     assert(backtracker != NULL);
+    size_t starts[1] = {0};
+    size_t ends[1] = {0};
 
     mock_regex_state_t state1 = {.id = 1};
     mock_regex_state_t state2 = {.id = 2};
 
     // Push some states
-    assert(rift_backtracker_push(backtracker, (rift_regex_state_t *)&state1, 1));
-    assert(rift_backtracker_push(backtracker, (rift_regex_state_t *)&state2, 1));
+    assert(rift_backtracker_push(backtracker, (rift_regex_state_t *)&state1, 0, starts, ends, 1));
+    assert(rift_backtracker_push(backtracker, (rift_regex_state_t *)&state2, 0, starts, ends, 1));
 
     // Clone the backtracker
     rift_regex_backtracker_t *clone = rift_backtracker_clone(backtracker);
     assert(clone != NULL);
-    assert(clone->max_depth == backtracker->max_depth);
-    assert(clone->num_groups == backtracker->num_groups);
-    assert(clone->current_depth == backtracker->current_depth);
+    assert(rift_backtracker_get_max_depth(clone) == rift_backtracker_get_max_depth(backtracker));
+    assert(rift_backtracker_get_num_groups(clone) == rift_backtracker_get_num_groups(backtracker));
+    assert(rift_backtracker_get_depth(clone) == rift_backtracker_get_depth(backtracker));
 
     // Verify clone works independently
     rift_regex_state_t *popped_state;
+    size_t pos;
     size_t num_groups;
 
-    assert(rift_backtracker_pop(clone, &popped_state, &num_groups));
+    assert(rift_backtracker_pop(clone, &popped_state, &pos, NULL, NULL, &num_groups));
     assert(((mock_regex_state_t *)popped_state)->id == 2);
     assert(rift_backtracker_get_depth(clone) == 1);
 
@@ -200,6 +213,90 @@ test_backtracker_clone(void)
     printf("test_backtracker_clone: PASSED\n");
 }
 
+/* Test that each pop restores the groups given to its push */
+void
+test_backtracker_groups(void)
+{
+    rift_regex_backtracker_t *backtracker = rift_backtracker_create(10, 2);
+    assert(backtracker != NULL);
+
+    mock_regex_state_t state1 = {.id = 1};
+    mock_regex_state_t state2 = {.id = 2};
+    mock_regex_state_t state3 = {.id = 3};
+    size_t starts[2] = {0, 5};
+    size_t ends[2] = {4, 9};
+
+    assert(rift_backtracker_push(backtracker, (rift_regex_state_t *)&state1, 1, starts, ends, 2));
+    starts[0] = 1;
+    ends[0] = 6;
+    assert(rift_backtracker_push(backtracker, (rift_regex_state_t *)&state2, 2, starts, ends, 2));
+    starts[1] = 7;
+    assert(rift_backtracker_push(backtracker, (rift_regex_state_t *)&state3, 3, starts, ends, 1));
+
+    // More groups than the backtracker has are rejected
+    assert(!rift_backtracker_push(backtracker, (rift_regex_state_t *)&state3, 3, starts, ends, 3));
+
+    rift_regex_state_t *state;
+    size_t pos;
+    size_t num_groups;
+    size_t out_starts[2] = {0, 0};
+    size_t out_ends[2] = {0, 0};
+
+    assert(rift_backtracker_pop(backtracker, &state, &pos, out_starts, out_ends, &num_groups));
+    assert(pos == 3 && num_groups == 1);
+    assert(out_starts[0] == 1 && out_ends[0] == 6);
+
+    // Peek rebuilds the groups of a point whose slots have since moved on
+    assert(rift_backtracker_peek(backtracker, &state, &pos, out_starts, out_ends, &num_groups));
+    assert(((mock_regex_state_t *)state)->id == 2);
+    assert(num_groups == 2);
+    assert(out_starts[0] == 1 && out_ends[0] == 6);
+    assert(out_starts[1] == 5 && out_ends[1] == 9);
+
+    assert(rift_backtracker_pop(backtracker, &state, &pos, out_starts, out_ends, &num_groups));
+    assert(pos == 2 && out_starts[0] == 1 && out_starts[1] == 5);
+
+    assert(rift_backtracker_pop(backtracker, &state, &pos, out_starts, out_ends, &num_groups));
+    assert(pos == 1 && num_groups == 2);
+    assert(out_starts[0] == 0 && out_ends[0] == 4);
+    assert(out_starts[1] == 5 && out_ends[1] == 9);
+
+    rift_backtracker_free(backtracker);
+    printf("test_backtracker_groups: PASSED\n");
+}
+
+/* Bailout hook counting refused pushes */
+static void
+count_bailout(const rift_regex_backtracker_t *backtracker, size_t depth, void *user_data)
+{
+    (void)backtracker;
+    *(size_t *)user_data += depth;
+}
+
+/* Test that the policy's bailout hook runs when the depth limit is hit */
+void
+test_backtracker_policy(void)
+{
+    size_t bailouts = 0;
+    rift_backtracker_policy_t policy;
+    rift_backtracker_policy_init(&policy, 1);
+    policy.bailout = count_bailout;
+    policy.user_data = &bailouts;
+
+    rift_regex_backtracker_t *backtracker = rift_backtracker_create_with_policy(&policy, 0);
+    assert(backtracker != NULL);
+
+    mock_regex_state_t state = {.id = 1};
+    assert(rift_backtracker_push(backtracker, (rift_regex_state_t *)&state, 0, NULL, NULL, 0));
+    assert(!rift_backtracker_push(backtracker, (rift_regex_state_t *)&state, 1, NULL, NULL, 0));
+#if RIFT_BACKTRACKER_BAILOUT_HOOKS
+    assert(bailouts == 1);
+#endif
+
+    rift_backtracker_free(backtracker);
+    printf("test_backtracker_policy: PASSED\n");
+}
+
 int
 main(void)
 {
@@ -211,6 +308,8 @@ main(void)
     test_backtracker_peek();
     test_backtracker_reset();
     test_backtracker_clone();
+    test_backtracker_groups();
+    test_backtracker_policy();
 
     printf("All tests passed!\n");
     return 0;
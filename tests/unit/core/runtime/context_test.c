@@ -135,6 +135,29 @@ CTEST2(context, test_match_result_creation)
     rift_match_result_free(result);
 }
 
+// Test span-only match results
+CTEST2(context, test_match_spans)
+{
+    rift_regex_span_t spans[8];
+
+    // Context created with 5 groups, none of which participated yet
+    size_t count = rift_matcher_context_get_spans(data->context, 5, 10, spans, 8);
+    ASSERT_EQUAL(6, count);
+    ASSERT_EQUAL(5, spans[0].start);
+    ASSERT_EQUAL(10, spans[0].end);
+    ASSERT_EQUAL(RIFT_REGEX_SPAN_UNSET, spans[1].start);
+    ASSERT_EQUAL(RIFT_REGEX_SPAN_UNSET, spans[1].end);
+
+    // A short array still reports the full count
+    ASSERT_EQUAL(6, rift_matcher_context_get_spans(data->context, 5, 10, spans, 1));
+    ASSERT_EQUAL(6, rift_matcher_context_get_spans(data->context, 5, 10, NULL, 0));
+
+    // Invalid ranges are rejected
+    ASSERT_EQUAL(0, rift_matcher_context_get_spans(data->context, 10, 5, spans, 8));
+    ASSERT_EQUAL(0, rift_matcher_context_get_spans(data->context, 0, 100, spans, 8));
+    ASSERT_EQUAL(0, rift_matcher_context_get_spans(NULL, 0, 4, spans, 8));
+}
+
 // Test regex context creation and freeing
 CTEST2(context, test_regex_context_creation)
 {
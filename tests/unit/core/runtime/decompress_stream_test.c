@@ -0,0 +1,208 @@
+/**
+ * @file decompress_stream_test.c
+ * @brief Unit tests for pipelined decompression streams
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef LIBRIFT_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#include "core/runtime/decompress_stream.h"
+
+/* Build an input of numbered log lines */
+static char *
+make_lines(size_t count, size_t *size)
+{
+    char *text = malloc(count * 32);
+    assert(text != NULL);
+    *size = 0;
+    for (size_t i = 0; i < count; i++) {
+        *size += (size_t)sprintf(text + *size, "line %zu status=%zu\n", i, 200 + i % 7);
+    }
+    return text;
+}
+
+/* Write a temporary file and return its path */
+static char *
+write_temp(const void *data, size_t size)
+{
+    char *path = strdup("/tmp/rift_decompress_XXXXXX");
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    assert(write(fd, data, size) == (ssize_t)size);
+    close(fd);
+    return path;
+}
+
+/* Read a stream to its end and compare it with the expected input */
+static void
+expect_stream(const char *path, size_t chunk_size, const char *expected, size_t size)
+{
+    rift_regex_error_t error;
+    rift_decompress_stream_t *stream = rift_decompress_stream_open(path, chunk_size, &error);
+    assert(stream != NULL);
+
+    size_t offset = 0;
+    const char *chunk;
+    size_t length;
+    while (rift_decompress_stream_next(stream, &chunk, &length)) {
+        assert(length > 0 && length <= chunk_size);
+        assert(offset + length <= size);
+        assert(memcmp(chunk, expected + offset, length) == 0);
+        offset += length;
+    }
+    assert(offset == size);
+    assert(!rift_decompress_stream_failed(stream));
+    assert(!rift_decompress_stream_next(stream, &chunk, &length));
+
+    rift_decompress_stream_close(stream);
+}
+
+/* Test that formats are told from their magic bytes */
+void
+test_compression_detect(void)
+{
+    assert(rift_compression_detect("\x1f\x8b\x08\x00", 4) == RIFT_COMPRESSION_GZIP);
+    assert(rift_compression_detect("\x28\xb5\x2f\xfd", 4) == RIFT_COMPRESSION_ZSTD);
+    assert(rift_compression_detect("\x28\xb5", 2) == RIFT_COMPRESSION_NONE);
+    assert(rift_compression_detect("line 1\n", 7) == RIFT_COMPRESSION_NONE);
+    assert(rift_compression_detect(NULL, 0) == RIFT_COMPRESSION_NONE);
+    assert(rift_compression_supported(RIFT_COMPRESSION_NONE));
+
+    printf("test_compression_detect: PASSED\n");
+}
+
+/* Test that uncompressed files come through unchanged, in chunks */
+void
+test_decompress_stream_plain(void)
+{
+    size_t size;
+    char *text = make_lines(5000, &size);
+    char *path = write_temp(text, size);
+
+    expect_stream(path, 4096, text, size);
+    expect_stream(path, size + 1, text, size);
+
+    /* An empty file has no chunks */
+    char *empty = write_temp("", 0);
+    expect_stream(empty, 4096, "", 0);
+
+    unlink(path);
+    unlink(empty);
+    free(path);
+    free(empty);
+    free(text);
+
+    printf("test_decompress_stream_plain: PASSED\n");
+}
+
+#ifdef LIBRIFT_HAVE_ZLIB
+/* Append a gzip member holding data to a file */
+static void
+append_gzip(const char *path, const char *data, size_t size)
+{
+    gzFile file = gzopen(path, "ab");
+    assert(file != NULL);
+    assert(gzwrite(file, data, (unsigned)size) == (int)size);
+    assert(gzclose(file) == Z_OK);
+}
+
+/* Test that gzip files decompress, member after member */
+void
+test_decompress_stream_gzip(void)
+{
+    size_t size;
+    char *text = make_lines(20000, &size);
+    char *path = write_temp("", 0);
+
+    /* Two members read as one input */
+    append_gzip(path, text, size / 3);
+    append_gzip(path, text + size / 3, size - size / 3);
+
+    rift_regex_error_t error;
+    rift_decompress_stream_t *stream = rift_decompress_stream_open(path, 0, &error);
+    assert(stream != NULL);
+    assert(rift_decompress_stream_get_compression(stream) == RIFT_COMPRESSION_GZIP);
+    rift_decompress_stream_close(stream);
+
+    expect_stream(path, 1000, text, size);
+
+    /* Closing a stream before its end stops the thread */
+    stream = rift_decompress_stream_open(path, 512, &error);
+    assert(stream != NULL);
+    const char *chunk;
+    size_t length;
+    assert(rift_decompress_stream_next(stream, &chunk, &length));
+    rift_decompress_stream_close(stream);
+
+    /* A file cut short fails once what it holds is read */
+    FILE *file = fopen(path, "rb");
+    assert(file != NULL);
+    char *compressed = malloc(size);
+    size_t compressed_size = fread(compressed, 1, size, file);
+    fclose(file);
+    char *cut = write_temp(compressed, compressed_size / 4);
+
+    stream = rift_decompress_stream_open(cut, 4096, &error);
+    assert(stream != NULL);
+    size_t offset = 0;
+    while (rift_decompress_stream_next(stream, &chunk, &length)) {
+        assert(memcmp(chunk, text + offset, length) == 0);
+        offset += length;
+    }
+    assert(offset < size);
+    assert(rift_decompress_stream_failed(stream));
+    rift_decompress_stream_close(stream);
+
+    unlink(path);
+    unlink(cut);
+    free(path);
+    free(cut);
+    free(compressed);
+    free(text);
+
+    printf("test_decompress_stream_gzip: PASSED\n");
+}
+#endif
+
+/* Test that missing files and unsupported formats are refused */
+void
+test_decompress_stream_errors(void)
+{
+    rift_regex_error_t error;
+    assert(rift_decompress_stream_open("/nonexistent/rift.log.gz", 0, &error) == NULL);
+    assert(rift_decompress_stream_open(NULL, 0, &error) == NULL);
+
+    if (!rift_compression_supported(RIFT_COMPRESSION_ZSTD)) {
+        char *path = write_temp("\x28\xb5\x2f\xfd\x00\x00", 6);
+        assert(rift_decompress_stream_open(path, 0, &error) == NULL);
+        assert(error.code == RIFT_REGEX_ERROR_UNSUPPORTED_FEATURE);
+        unlink(path);
+        free(path);
+    }
+
+    printf("test_decompress_stream_errors: PASSED\n");
+}
+
+int
+main(void)
+{
+    test_compression_detect();
+    test_decompress_stream_plain();
+#ifdef LIBRIFT_HAVE_ZLIB
+    test_decompress_stream_gzip();
+#endif
+    test_decompress_stream_errors();
+
+    printf("\nAll decompress stream tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,190 @@
+/**
+ * @file file_reader_test.c
+ * @brief Unit tests for the bulk file reader
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "core/runtime/file_reader.h"
+
+#define NUM_FILES 300
+
+/* A directory of files with known contents */
+typedef struct test_files {
+    char dir[64];
+    char *paths[NUM_FILES + 1];
+    size_t sizes[NUM_FILES + 1];
+} test_files_t;
+
+/* Contents of file i: its index, repeated to a size that varies */
+static size_t
+file_contents(size_t i, char *out, size_t capacity)
+{
+    size_t size = (i * 37) % 3000;
+    if (i % 50 == 7) {
+        size = 10000; /* Larger than the buffers of the tests */
+    }
+    for (size_t k = 0; k < size && k < capacity; k++) {
+        out[k] = (char)('a' + (i + k) % 26);
+    }
+    return size;
+}
+
+static void
+make_files(test_files_t *files)
+{
+    strcpy(files->dir, "/tmp/rift_reader_XXXXXX");
+    assert(mkdtemp(files->dir) != NULL);
+
+    char contents[10000];
+    for (size_t i = 0; i < NUM_FILES; i++) {
+        files->paths[i] = malloc(96);
+        snprintf(files->paths[i], 96, "%s/%zu.log", files->dir, i);
+        files->sizes[i] = file_contents(i, contents, sizeof(contents));
+        FILE *file = fopen(files->paths[i], "wb");
+        assert(file != NULL);
+        assert(fwrite(contents, 1, files->sizes[i], file) == files->sizes[i]);
+        fclose(file);
+    }
+
+    /* One path that does not exist */
+    files->paths[NUM_FILES] = malloc(96);
+    snprintf(files->paths[NUM_FILES], 96, "%s/missing.log", files->dir);
+}
+
+static void
+remove_files(test_files_t *files)
+{
+    for (size_t i = 0; i <= NUM_FILES; i++) {
+        unlink(files->paths[i]);
+        free(files->paths[i]);
+    }
+    rmdir(files->dir);
+}
+
+/* Shared by the threads taking files */
+typedef struct take_state {
+    rift_file_reader_t *reader;
+    pthread_mutex_t lock;
+    int seen[NUM_FILES + 1];
+    size_t buffer_size;
+} take_state_t;
+
+static void *
+take_files(void *arg)
+{
+    take_state_t *state = arg;
+    rift_file_read_t file;
+    char expected[10000];
+
+    while (rift_file_reader_next(state->reader, &file)) {
+        if (file.index == NUM_FILES) {
+            assert(file.data == NULL && file.error == ENOENT);
+        } else {
+            size_t size = file_contents(file.index, expected, sizeof(expected));
+            assert(file.error == 0 && file.data != NULL);
+            assert(file.complete == (size < state->buffer_size));
+            assert(file.size == (file.complete ? size : state->buffer_size));
+            assert(memcmp(file.data, expected, file.size) == 0);
+        }
+        pthread_mutex_lock(&state->lock);
+        state->seen[file.index]++;
+        pthread_mutex_unlock(&state->lock);
+        rift_file_reader_release(state->reader, &file);
+    }
+    return NULL;
+}
+
+/* Read every file with a small pool shared by several threads */
+static void
+read_all(test_files_t *files, bool no_io_uring)
+{
+    rift_file_reader_config_t config = {.queue_depth = 8, .buffer_size = 4096,
+                                        .no_io_uring = no_io_uring};
+    rift_regex_error_t error;
+    take_state_t state = {.buffer_size = config.buffer_size};
+    pthread_mutex_init(&state.lock, NULL);
+    state.reader = rift_file_reader_create((const char *const *)files->paths, NUM_FILES + 1,
+                                           &config, &error);
+    assert(state.reader != NULL);
+    if (no_io_uring) {
+        assert(!rift_file_reader_uses_io_uring(state.reader));
+    }
+
+    pthread_t threads[4];
+    for (int i = 0; i < 4; i++) {
+        assert(pthread_create(&threads[i], NULL, take_files, &state) == 0);
+    }
+    for (int i = 0; i < 4; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    for (size_t i = 0; i <= NUM_FILES; i++) {
+        assert(state.seen[i] == 1);
+    }
+    rift_file_read_t file;
+    assert(!rift_file_reader_next(state.reader, &file));
+
+    rift_file_reader_free(state.reader);
+    pthread_mutex_destroy(&state.lock);
+}
+
+/* Test that every file is read once, through io_uring where available */
+void
+test_file_reader_reads_all(void)
+{
+    test_files_t files;
+    make_files(&files);
+
+    read_all(&files, false);
+    read_all(&files, true);
+
+    remove_files(&files);
+    printf("test_file_reader_reads_all: PASSED\n");
+}
+
+/* Test that a reader freed before its end stops */
+void
+test_file_reader_stops_early(void)
+{
+    test_files_t files;
+    make_files(&files);
+
+    rift_file_reader_config_t config = {.queue_depth = 4, .buffer_size = 1024};
+    rift_file_reader_t *reader = rift_file_reader_create((const char *const *)files.paths,
+                                                         NUM_FILES, &config, NULL);
+    assert(reader != NULL);
+    rift_file_read_t file;
+    assert(rift_file_reader_next(reader, &file));
+    rift_file_reader_release(reader, &file);
+    assert(rift_file_reader_next(reader, &file));
+    rift_file_reader_free(reader);
+
+    /* No paths at all */
+    reader = rift_file_reader_create(NULL, 0, NULL, NULL);
+    assert(reader != NULL);
+    assert(!rift_file_reader_next(reader, &file));
+    rift_file_reader_free(reader);
+
+    remove_files(&files);
+    printf("test_file_reader_stops_early: PASSED\n");
+}
+
+int
+main(void)
+{
+    test_file_reader_reads_all();
+    test_file_reader_stops_early();
+
+    printf("\nAll file reader tests passed!\n");
+    return 0;
+}
@@ -0,0 +1,158 @@
+/**
+ * @file metrics_test.c
+ * @brief Unit tests for the search metrics registry
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/runtime/metrics.h"
+
+#define THREADS 8
+#define SEARCHES_PER_THREAD 10000
+
+/* Test registering patterns up to the capacity */
+void
+test_metrics_register(void)
+{
+    rift_metrics_t *metrics = rift_metrics_create(2);
+    assert(metrics != NULL);
+
+    assert(rift_metrics_register_pattern(metrics, "digits") == 0);
+    assert(rift_metrics_register_pattern(metrics, NULL) == 1);
+    assert(rift_metrics_register_pattern(metrics, "full") == RIFT_METRICS_NO_PATTERN);
+    assert(rift_metrics_get_pattern_count(metrics) == 2);
+
+    rift_metrics_pattern_t result;
+    assert(rift_metrics_get_pattern(metrics, 1, &result));
+    assert(strcmp(result.name, "1") == 0);
+    assert(!rift_metrics_get_pattern(metrics, 2, &result));
+
+    rift_metrics_free(metrics);
+    assert(rift_metrics_create(0) == NULL);
+}
+
+/* Test the counters and the latency quantiles */
+void
+test_metrics_record(void)
+{
+    rift_metrics_t *metrics = rift_metrics_create(4);
+    uint32_t id = rift_metrics_register_pattern(metrics, "words");
+
+    for (uint64_t latency = 1; latency <= 1000; latency++) {
+        rift_metrics_record(metrics, id, RIFT_MATCH_ENGINE_LAZY_DFA, latency % 2 == 0, false,
+                            latency * 1000);
+    }
+    rift_metrics_record(metrics, id, RIFT_MATCH_ENGINE_BACKTRACKER, false, true, 5000000);
+    rift_metrics_record(metrics, 3, RIFT_MATCH_ENGINE_LAZY_DFA, true, false, 1);
+
+    rift_metrics_pattern_t result;
+    assert(rift_metrics_get_pattern(metrics, id, &result));
+    assert(result.searches[RIFT_MATCH_ENGINE_LAZY_DFA] == 1000);
+    assert(result.matches[RIFT_MATCH_ENGINE_LAZY_DFA] == 500);
+    assert(result.timeouts[RIFT_MATCH_ENGINE_LAZY_DFA] == 0);
+    assert(result.searches[RIFT_MATCH_ENGINE_BACKTRACKER] == 1);
+    assert(result.timeouts[RIFT_MATCH_ENGINE_BACKTRACKER] == 1);
+    assert(result.latency_count == 1001);
+    assert(result.latency_sum_ns == 500500000 + 5000000);
+
+    /* Quantiles are bucket bounds within an eighth of the exact value */
+    uint64_t p50 = rift_metrics_latency_quantile(&result, 0.5);
+    uint64_t p99 = rift_metrics_latency_quantile(&result, 0.99);
+    assert(p50 >= 501000 && p50 <= 501000 + 501000 / 8);
+    assert(p99 >= 991000 && p99 <= 991000 + 991000 / 8);
+    assert(rift_metrics_latency_quantile(&result, 1.0) >= 5000000);
+    assert(rift_metrics_latency_quantile(&result, 0.0) >= 1000);
+
+    rift_metrics_reset(metrics);
+    assert(rift_metrics_get_pattern(metrics, id, &result));
+    assert(result.searches[RIFT_MATCH_ENGINE_LAZY_DFA] == 0 && result.latency_count == 0);
+    assert(rift_metrics_latency_quantile(&result, 0.5) == 0);
+
+    rift_metrics_free(metrics);
+}
+
+/* Test the Prometheus and JSON snapshots */
+void
+test_metrics_snapshot(void)
+{
+    rift_metrics_t *metrics = rift_metrics_create(4);
+    uint32_t id = rift_metrics_register_pattern(metrics, "say \"hi\"");
+    rift_metrics_register_pattern(metrics, "idle");
+    rift_metrics_record(metrics, id, RIFT_MATCH_ENGINE_PIKE_VM, true, false, 2000);
+
+    rift_output_buffer_t buffer;
+    rift_output_buffer_init(&buffer);
+    assert(rift_metrics_snapshot(metrics, RIFT_METRICS_FORMAT_PROMETHEUS, &buffer));
+    assert(strstr(buffer.data, "# TYPE librift_searches_total counter\n") != NULL);
+    assert(strstr(buffer.data,
+                  "librift_searches_total{pattern=\"say \\\"hi\\\"\",engine=\"Pike VM\"} 1\n") !=
+           NULL);
+    assert(strstr(buffer.data, "# TYPE librift_search_latency_seconds summary\n") != NULL);
+    assert(strstr(buffer.data,
+                  "librift_search_latency_seconds_count{pattern=\"say \\\"hi\\\"\"} 1\n") != NULL);
+    assert(strstr(buffer.data, "quantile=\"0.99\"") != NULL);
+    assert(strstr(buffer.data, "pattern=\"idle\"") == NULL);
+
+    rift_output_buffer_clear(&buffer);
+    assert(rift_metrics_snapshot(metrics, RIFT_METRICS_FORMAT_JSON, &buffer));
+    assert(strstr(buffer.data, "{\"patterns\":[{\"name\":\"say \\\"hi\\\"\",") == buffer.data);
+    assert(strstr(buffer.data, "\"Pike VM\":{\"searches\":1,\"matches\":1,\"timeouts\":0}") !=
+           NULL);
+    assert(strstr(buffer.data, "{\"name\":\"idle\",\"engines\":{},\"latency_ns\":{\"count\":0") !=
+           NULL);
+
+    rift_output_buffer_free(&buffer);
+    rift_metrics_free(metrics);
+}
+
+static void *
+record_searches(void *arg)
+{
+    rift_metrics_t *metrics = (rift_metrics_t *)arg;
+    for (int i = 0; i < SEARCHES_PER_THREAD; i++) {
+        rift_metrics_record(metrics, 0, RIFT_MATCH_ENGINE_LAZY_DFA, true, false, 100);
+    }
+    return NULL;
+}
+
+/* Test that concurrent searches are all counted */
+void
+test_metrics_threads(void)
+{
+    rift_metrics_t *metrics = rift_metrics_create(1);
+    rift_metrics_register_pattern(metrics, "shared");
+
+    pthread_t threads[THREADS];
+    for (int i = 0; i < THREADS; i++) {
+        assert(pthread_create(&threads[i], NULL, record_searches, metrics) == 0);
+    }
+    for (int i = 0; i < THREADS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    rift_metrics_pattern_t result;
+    assert(rift_metrics_get_pattern(metrics, 0, &result));
+    assert(result.searches[RIFT_MATCH_ENGINE_LAZY_DFA] == THREADS * SEARCHES_PER_THREAD);
+    assert(result.latency_count == THREADS * SEARCHES_PER_THREAD);
+
+    rift_metrics_free(metrics);
+}
+
+int
+main(void)
+{
+    test_metrics_register();
+    test_metrics_record();
+    test_metrics_snapshot();
+    test_metrics_threads();
+
+    printf("Metrics tests: PASSED\n");
+    return 0;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file perf_counters_test.c
+ * @brief Unit tests for the hardware performance counters
+ *
+ * Counters are often refused, in containers and virtual machines, so the
+ * tests check that being refused is reported cleanly and check the counts
+ * only where they can be read.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "core/runtime/perf_counters.h"
+
+/* Test the names of the events */
+void
+test_perf_event_names(void)
+{
+    assert(strcmp(rift_perf_event_name(RIFT_PERF_EVENT_CYCLES), "cycles") == 0);
+    assert(strcmp(rift_perf_event_name(RIFT_PERF_EVENT_DTLB_MISSES), "dtlb_misses") == 0);
+    assert(strcmp(rift_perf_event_name(RIFT_PERF_EVENT_COUNT), "unknown") == 0);
+}
+
+/* Test that missing counters count nothing */
+void
+test_perf_counters_unavailable(void)
+{
+    rift_perf_sample_t sample;
+    memset(&sample, 0xff, sizeof(sample));
+
+    assert(!rift_perf_counters_start(NULL));
+    assert(!rift_perf_counters_stop(NULL, &sample));
+    for (size_t i = 0; i < RIFT_PERF_EVENT_COUNT; i++) {
+        assert(!sample.valid[i] && sample.values[i] == 0);
+    }
+    rift_perf_counters_free(NULL);
+}
+
+/* Test counting a loop, where the system allows it */
+void
+test_perf_counters_count(void)
+{
+    rift_perf_counters_t *counters = rift_perf_counters_create();
+    if (!counters) {
+        printf("Hardware counters not available, skipping the counts\n");
+        return;
+    }
+
+    rift_perf_sample_t sample;
+    assert(rift_perf_counters_start(counters));
+    volatile uint64_t sum = 0;
+    for (uint64_t i = 0; i < 1000000; i++) {
+        sum += i;
+    }
+    bool read = rift_perf_counters_stop(counters, &sample);
+    if (read && sample.valid[RIFT_PERF_EVENT_INSTRUCTIONS]) {
+        assert(sample.values[RIFT_PERF_EVENT_INSTRUCTIONS] >= 1000000);
+    }
+
+    rift_perf_counters_free(counters);
+}
+
+int
+main(void)
+{
+    test_perf_event_names();
+    test_perf_counters_unavailable();
+    test_perf_counters_count();
+
+    printf("Perf counter tests: PASSED\n");
+    return 0;
+}
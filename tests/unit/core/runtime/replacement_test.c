@@ -0,0 +1,112 @@
+/**
+ * @file replacement_test.c
+ * @brief Unit tests for replacement templates and output buffers
+ *
+ * This file contains test cases verifying template parsing, group expansion
+ * and buffer growth.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/runtime/replacement.h"
+
+/* Test appending to a growable buffer */
+void
+test_output_buffer(void)
+{
+    rift_output_buffer_t buffer;
+    rift_output_buffer_init(&buffer);
+    assert(buffer.data == NULL && buffer.length == 0);
+
+    assert(rift_output_buffer_append(&buffer, "", 0));
+    assert(strcmp(buffer.data, "") == 0);
+
+    for (int i = 0; i < 100; i++) {
+        assert(rift_output_buffer_append(&buffer, "abc", 3));
+    }
+    assert(buffer.length == 300);
+    assert(buffer.capacity > 300);
+    assert(memcmp(buffer.data + 297, "abc", 4) == 0);
+
+    rift_output_buffer_clear(&buffer);
+    assert(buffer.length == 0 && strcmp(buffer.data, "") == 0);
+
+    assert(!rift_output_buffer_append(&buffer, NULL, 1));
+    rift_output_buffer_free(&buffer);
+    assert(buffer.data == NULL);
+    printf("test_output_buffer: PASSED\n");
+}
+
+/* Test expanding group references */
+void
+test_replacement_expand(void)
+{
+    rift_regex_error_t error = {0};
+    const char *input = "key=value";
+    rift_regex_span_t spans[4] = {
+        {0, 9}, {0, 3}, {4, 9}, {RIFT_REGEX_SPAN_UNSET, RIFT_REGEX_SPAN_UNSET}};
+
+    rift_replacement_t *replacement = rift_replacement_compile("$2:${1}$$ [$0]$3$9 $x $", &error);
+    assert(replacement != NULL);
+    assert(replacement->max_group == 9);
+
+    rift_output_buffer_t output;
+    rift_output_buffer_init(&output);
+    assert(rift_replacement_expand(replacement, input, spans, 4, &output));
+    assert(strcmp(output.data, "value:key$ [key=value] $x $") == 0);
+    rift_replacement_free(replacement);
+
+    /* Adjacent literal text forms one piece */
+    replacement = rift_replacement_compile("plain text", &error);
+    assert(replacement != NULL && replacement->num_pieces == 1);
+    rift_replacement_free(replacement);
+
+    replacement = rift_replacement_compile("", &error);
+    assert(replacement != NULL && replacement->num_pieces == 0);
+    rift_output_buffer_clear(&output);
+    assert(rift_replacement_expand(replacement, input, spans, 4, &output));
+    assert(output.length == 0);
+    rift_replacement_free(replacement);
+
+    rift_output_buffer_free(&output);
+    printf("test_replacement_expand: PASSED\n");
+}
+
+/* Test invalid templates and parameters */
+void
+test_replacement_invalid(void)
+{
+    rift_regex_error_t error = {0};
+
+    assert(rift_replacement_compile(NULL, &error) == NULL);
+    assert(error.code == RIFT_REGEX_ERROR_INVALID_PARAMETER);
+
+    assert(rift_replacement_compile("a${1", &error) == NULL);
+    assert(error.code == RIFT_REGEX_ERROR_SYNTAX);
+    assert(error.position == 1);
+
+    assert(rift_replacement_compile("${}", &error) == NULL);
+    assert(!rift_replacement_expand(NULL, "", NULL, 0, NULL));
+    rift_replacement_free(NULL);
+
+    printf("test_replacement_invalid: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running replacement tests...\n");
+
+    test_output_buffer();
+    test_replacement_expand();
+    test_replacement_invalid();
+
+    printf("All replacement tests PASSED!\n");
+    return 0;
+}
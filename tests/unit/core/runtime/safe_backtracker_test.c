@@ -16,8 +16,8 @@
 #include <stdlib.h>
 #include <string.h>
 
-#include "librift/errors/regex_error.h"
-#include "librift/runtime/backtracker/safe_backtracker.h"
+#include "core/errors/regex_error.h"
+#include "core/runtime/safe_backtracker.h"
 
 /* Mock state for testing */
 typedef struct mock_state {
@@ -556,6 +556,73 @@ test_error_handling(void)
 }
 
 /* Main test runner */
+/* Thread body that uses the backtracker once and exits */
+static void *
+use_once_thread_func(void *arg)
+{
+    rift_regex_safe_backtracker_t *bt = (rift_regex_safe_backtracker_t *)arg;
+    mock_state_t state = {.id = 1};
+    size_t group_starts[1] = {0};
+    size_t group_ends[1] = {0};
+
+    bool ok = rift_safe_backtracker_push(bt, (rift_regex_state_t *)&state, 0, group_starts,
+                                         group_ends, 1, NULL);
+    return ok ? arg : NULL;
+}
+
+/* Test: policy changes reach existing thread-local backtrackers */
+static bool
+test_policy_change_and_thread_exit(void)
+{
+    printf("Running test: policy_change_and_thread_exit\n");
+
+    rift_regex_safe_backtracker_t *bt = rift_safe_backtracker_create(10, 1);
+    if (!bt) {
+        printf("FAIL: Could not create backtracker\n");
+        return false;
+    }
+
+    mock_state_t state = {.id = 1};
+    size_t group_starts[1] = {0};
+    size_t group_ends[1] = {0};
+    rift_regex_error_t error;
+    memset(&error, 0, sizeof(error));
+
+    /* The first push registers this thread's backtracker, the cache finds it after */
+    rift_regex_backtracker_t *local_bt = rift_safe_backtracker_get_local(bt);
+    if (!rift_safe_backtracker_push(bt, (rift_regex_state_t *)&state, 0, group_starts, group_ends,
+                                    1, &error) ||
+        rift_safe_backtracker_get_local(bt) != local_bt) {
+        printf("FAIL: Thread-local backtracker not reused\n");
+        rift_safe_backtracker_free(bt);
+        return false;
+    }
+
+    /* Lowering the limit applies to the backtracker this thread already has */
+    rift_safe_backtracker_set_max_depth(bt, 1);
+    if (rift_safe_backtracker_push(bt, (rift_regex_state_t *)&state, 1, group_starts, group_ends,
+                                   1, &error) ||
+        error.code != RIFT_REGEX_ERROR_BACKTRACKING_LIMIT) {
+        printf("FAIL: New maximum depth not applied to existing backtracker\n");
+        rift_safe_backtracker_free(bt);
+        return false;
+    }
+
+    /* A thread that exits releases its backtracker, one still alive is freed with bt */
+    pthread_t thread;
+    void *result = NULL;
+    if (pthread_create(&thread, NULL, use_once_thread_func, bt) != 0 ||
+        pthread_join(thread, &result) != 0 || result != bt) {
+        printf("FAIL: Worker thread could not use backtracker\n");
+        rift_safe_backtracker_free(bt);
+        return false;
+    }
+
+    rift_safe_backtracker_free(bt);
+    printf("PASS: policy_change_and_thread_exit\n");
+    return true;
+}
+
 int
 main(int argc, char **argv)
 {
@@ -577,9 +644,11 @@ main(int argc, char **argv)
         tests_failed++;
     if (!test_error_handling())
         tests_failed++;
+    if (!test_policy_change_and_thread_exit())
+        tests_failed++;
 
     printf("===== Safe Backtracker Test Results =====\n");
-    printf("Tests run: 7\n");
+    printf("Tests run: 8\n");
     printf("Tests failed: %d\n", tests_failed);
 
     return tests_failed > 0 ? 1 : 0;
@@ -0,0 +1,159 @@
+/**
+ * @file trace_buffer_test.c
+ * @brief Unit tests for the match trace ring buffer
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/memory/memory.h"
+#include "core/runtime/trace_buffer.h"
+
+/* Test that records come back unpacked, oldest first */
+void
+test_trace_buffer_records(void)
+{
+    rift_trace_buffer_t *buffer = rift_trace_buffer_create(5);
+    assert(buffer != NULL);
+    assert(rift_trace_buffer_get_capacity(buffer) == 8);
+
+    rift_trace_buffer_record(buffer, RIFT_TRACE_EVENT_START, 0, 0);
+    rift_trace_buffer_record(buffer, RIFT_TRACE_EVENT_BACKTRACK, 42, 7);
+    rift_trace_buffer_record(buffer, RIFT_TRACE_EVENT_MATCH, (size_t)1 << 40, (size_t)1 << 40);
+    assert(rift_trace_buffer_get_total(buffer) == 3);
+
+    rift_trace_record_t records[8];
+    assert(rift_trace_buffer_snapshot(buffer, records, 8) == 3);
+    assert(records[0].event == RIFT_TRACE_EVENT_START);
+    assert(records[1].event == RIFT_TRACE_EVENT_BACKTRACK);
+    assert(records[1].location == 42 && records[1].position == 7);
+
+    /* Out of range values saturate rather than wrap */
+    assert(records[2].location == RIFT_TRACE_LOCATION_MAX);
+    assert(records[2].position == UINT32_MAX);
+
+    /* A smaller snapshot keeps the latest records */
+    assert(rift_trace_buffer_snapshot(buffer, records, 1) == 1);
+    assert(records[0].event == RIFT_TRACE_EVENT_MATCH);
+
+    rift_trace_buffer_free(buffer);
+}
+
+/* Test that the buffer keeps the latest records once it wraps */
+void
+test_trace_buffer_wraps(void)
+{
+    rift_trace_buffer_t *buffer = rift_trace_buffer_create(16);
+    assert(buffer != NULL);
+
+    for (size_t i = 0; i < 100; i++) {
+        rift_trace_buffer_record(buffer, RIFT_TRACE_EVENT_STEP, i, i);
+    }
+    assert(rift_trace_buffer_get_total(buffer) == 100);
+
+    rift_trace_record_t records[16];
+    assert(rift_trace_buffer_snapshot(buffer, records, 16) == 16);
+    for (size_t i = 0; i < 16; i++) {
+        assert(records[i].location == 84 + i);
+    }
+
+    rift_trace_buffer_clear(buffer);
+    assert(rift_trace_buffer_get_total(buffer) == 0);
+    assert(rift_trace_buffer_snapshot(buffer, records, 16) == 0);
+
+    rift_trace_buffer_free(buffer);
+}
+
+/* Test that only the chosen events are recorded */
+void
+test_trace_buffer_event_mask(void)
+{
+    rift_trace_buffer_t *buffer = rift_trace_buffer_create(0);
+    assert(buffer != NULL);
+    assert(rift_trace_buffer_get_capacity(buffer) == RIFT_TRACE_BUFFER_DEFAULT_CAPACITY);
+
+    rift_trace_buffer_set_events(buffer, 1u << RIFT_TRACE_EVENT_BACKTRACK);
+    rift_trace_buffer_record(buffer, RIFT_TRACE_EVENT_STEP, 1, 0);
+    rift_trace_buffer_record(buffer, RIFT_TRACE_EVENT_BACKTRACK, 2, 0);
+    rift_trace_buffer_record(buffer, RIFT_TRACE_EVENT_FAIL, 3, 0);
+    assert(rift_trace_buffer_get_total(buffer) == 1);
+
+    rift_trace_buffer_free(buffer);
+}
+
+/* Test that locations are ranked by backtracks, then failures */
+void
+test_trace_hotspots(void)
+{
+    const rift_trace_record_t records[] = {
+        {1, 0, RIFT_TRACE_EVENT_STEP},      {2, 1, RIFT_TRACE_EVENT_BACKTRACK},
+        {3, 1, RIFT_TRACE_EVENT_FAIL},      {2, 2, RIFT_TRACE_EVENT_BACKTRACK},
+        {3, 2, RIFT_TRACE_EVENT_FAIL},      {4, 3, RIFT_TRACE_EVENT_BACKTRACK},
+        {3, 3, RIFT_TRACE_EVENT_FAIL},      {1, 4, RIFT_TRACE_EVENT_STEP},
+    };
+    size_t count = sizeof(records) / sizeof(records[0]);
+
+    rift_trace_hotspot_t hotspots[4];
+    assert(rift_trace_find_hotspots(records, count, hotspots, 4) == 4);
+    assert(hotspots[0].location == 2 && hotspots[0].backtracks == 2);
+    assert(hotspots[1].location == 4 && hotspots[1].backtracks == 1);
+    assert(hotspots[2].location == 3 && hotspots[2].failures == 3);
+    assert(hotspots[3].location == 1 && hotspots[3].records == 2);
+
+    assert(rift_trace_find_hotspots(records, count, hotspots, 1) == 1);
+    assert(hotspots[0].location == 2);
+    assert(strcmp(rift_trace_event_name(RIFT_TRACE_EVENT_BACKTRACK), "backtrack") == 0);
+}
+
+/* Writer recording while the main thread takes snapshots */
+static void *
+record_many(void *arg)
+{
+    rift_trace_buffer_t *buffer = arg;
+    for (size_t i = 0; i < 200000; i++) {
+        rift_trace_buffer_record(buffer, RIFT_TRACE_EVENT_STEP, i & RIFT_TRACE_LOCATION_MAX, i);
+    }
+    return NULL;
+}
+
+/* Test that snapshots taken during recording hold consecutive records */
+void
+test_trace_buffer_concurrent_snapshot(void)
+{
+    rift_trace_buffer_t *buffer = rift_trace_buffer_create(256);
+    assert(buffer != NULL);
+    rift_trace_record_t records[256];
+
+    pthread_t writer;
+    assert(pthread_create(&writer, NULL, record_many, buffer) == 0);
+    for (int round = 0; round < 1000; round++) {
+        size_t count = rift_trace_buffer_snapshot(buffer, records, 256);
+        for (size_t i = 1; i < count; i++) {
+            assert(records[i].position == records[i - 1].position + 1);
+        }
+    }
+    pthread_join(writer, NULL);
+
+    assert(rift_trace_buffer_snapshot(buffer, records, 256) == 256);
+    assert(records[255].position == 199999);
+    rift_trace_buffer_free(buffer);
+}
+
+int
+main(void)
+{
+    test_trace_buffer_records();
+    test_trace_buffer_wraps();
+    test_trace_buffer_event_mask();
+    test_trace_hotspots();
+    test_trace_buffer_concurrent_snapshot();
+
+    printf("Trace buffer tests: PASSED\n");
+    return 0;
+}
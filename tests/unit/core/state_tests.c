@@ -48,8 +48,6 @@
 static void
 setup()
 {
-    // Reset state ID counter for consistent testing
-    rift_state_reset_id_counter();
 }
 
 // Test cases converted from test_state.c
@@ -63,7 +61,7 @@ TEST_CASE(state_create)
     rift_regex_state_t *non_accepting = rift_state_create(false);
     ASSERT_NOT_NULL(non_accepting);
     ASSERT_FALSE(rift_state_is_accepting(non_accepting));
-    ASSERT_EQUAL_INT(rift_state_get_id(non_accepting), 1); // First state has ID 1
+    ASSERT_EQUAL_INT(rift_state_get_id(non_accepting), RIFT_STATE_NO_ID); // In no automaton
     ASSERT_NULL(rift_state_get_pattern(non_accepting));
     ASSERT_EQUAL_INT(rift_state_get_transition_count(non_accepting), 0);
 
@@ -71,7 +69,7 @@ TEST_CASE(state_create)
     rift_regex_state_t *accepting = rift_state_create(true);
     ASSERT_NOT_NULL(accepting);
     ASSERT_TRUE(rift_state_is_accepting(accepting));
-    ASSERT_EQUAL_INT(rift_state_get_id(accepting), 2); // Second state has ID 2
+    ASSERT_EQUAL_INT(rift_state_get_id(accepting), RIFT_STATE_NO_ID);
 
     // Clean up
     rift_state_free(non_accepting);
@@ -134,31 +132,26 @@ TEST_CASE(state_accepting_status)
  */
 TEST_CASE(state_id_management)
 {
-    // Reset ID counter at beginning of test
-    rift_state_reset_id_counter();
-
-    // Create multiple states and check sequential IDs
+    // States get their IDs from the automaton they are added to
     rift_regex_state_t *state1 = rift_state_create(false);
     rift_regex_state_t *state2 = rift_state_create(false);
-    rift_regex_state_t *state3 = rift_state_create(false);
 
-    ASSERT_EQUAL_INT(rift_state_get_id(state1), 1);
-    ASSERT_EQUAL_INT(rift_state_get_id(state2), 2);
-    ASSERT_EQUAL_INT(rift_state_get_id(state3), 3);
+    ASSERT_EQUAL_INT(rift_state_get_id(state1), RIFT_STATE_NO_ID);
+    ASSERT_EQUAL_INT(rift_state_get_id(state2), RIFT_STATE_NO_ID);
+    ASSERT_EQUAL_INT(rift_state_get_id(NULL), RIFT_STATE_NO_ID);
 
     // Set a specific ID (used for serialization)
     ASSERT_TRUE(rift_state_set_id(state2, 100));
     ASSERT_EQUAL_INT(rift_state_get_id(state2), 100);
 
-    // Create another state and check that the ID counter has been updated
-    rift_regex_state_t *state4 = rift_state_create(false);
-    ASSERT_EQUAL_INT(rift_state_get_id(state4), 101);
+    // Other states are not affected
+    rift_regex_state_t *state3 = rift_state_create(false);
+    ASSERT_EQUAL_INT(rift_state_get_id(state3), RIFT_STATE_NO_ID);
 
     // Clean up
     rift_state_free(state1);
     rift_state_free(state2);
     rift_state_free(state3);
-    rift_state_free(state4);
 }
 
 /**
@@ -448,36 +441,6 @@ TEST_CASE(state_info)
     rift_state_info_free(info2);
 }
 
-/**
- * Test next state ID retrieval
- */
-TEST_CASE(next_state_id)
-{
-    // Reset state ID counter
-    rift_state_reset_id_counter();
-
-    // First state ID should be 1
-    ASSERT_EQUAL_INT(rift_state_get_next_id(), 1);
-
-    // Create a state which increments the counter
-    rift_regex_state_t *state = rift_state_create(false);
-    ASSERT_EQUAL_INT(rift_state_get_id(state), 1);
-
-    // Next state ID should now be 2
-    ASSERT_EQUAL_INT(rift_state_get_next_id(), 2);
-
-    // Create another state
-    rift_regex_state_t *state2 = rift_state_create(false);
-    ASSERT_EQUAL_INT(rift_state_get_id(state2), 2);
-
-    // Next state ID should now be 3
-    ASSERT_EQUAL_INT(rift_state_get_next_id(), 3);
-
-    // Clean up
-    rift_state_free(state);
-    rift_state_free(state2);
-}
-
 /**
  * Main function to run all tests
  */
@@ -504,7 +467,6 @@ main(void)
     RUN_TEST(state_flags);
     RUN_TEST(state_group_management);
     RUN_TEST(state_info);
-    RUN_TEST(next_state_id);
 
     printf("All tests passed! Total tests: %d\n", test_count);
     return EXIT_SUCCESS;
@@ -227,6 +227,115 @@ CTEST(tokenizer_suite, reset_tokenizer)
     rift_regex_tokenizer_free(tokenizer);
 }
 
+// Test that token values need no allocation and that tokens carry their span
+CTEST(tokenizer_suite, token_values_and_spans)
+{
+    const char *pattern = "a[x-z](?#note)";
+    rift_regex_tokenizer_t *tokenizer = rift_regex_tokenizer_create(pattern);
+    ASSERT_NOT_NULL(tokenizer);
+
+    // One-character values are interned and shared
+    rift_regex_token_t literal = rift_regex_tokenizer_next_token(tokenizer);
+    ASSERT_STR("a", literal.value);
+    ASSERT_TRUE(rift_regex_token_value_is_interned(literal.value));
+    ASSERT_EQUAL(0, literal.start);
+    ASSERT_EQUAL(1, literal.end);
+
+    // Longer values stay valid while later tokens are scanned
+    rift_regex_token_t char_class = rift_regex_tokenizer_next_token(tokenizer);
+    ASSERT_STR("x-z", char_class.value);
+    ASSERT_EQUAL(1, char_class.start);
+    ASSERT_EQUAL(6, char_class.end);
+
+    rift_regex_token_t comment = rift_regex_tokenizer_next_token(tokenizer);
+    ASSERT_STR("note", comment.value);
+    ASSERT_STR("x-z", char_class.value);
+
+    // Copies share interned values and own the others
+    rift_regex_token_t copy = rift_regex_token_copy(&literal);
+    ASSERT_TRUE(copy.value == literal.value);
+    rift_regex_token_free(&copy);
+
+    rift_regex_tokenizer_free(tokenizer);
+}
+
+// Test that runs of plain literals come as one token
+CTEST(tokenizer_suite, literal_runs)
+{
+    const char *pattern = "https://example.com/a-path*x{10}";
+    rift_regex_tokenizer_t *tokenizer = rift_regex_tokenizer_create(pattern);
+    ASSERT_NOT_NULL(tokenizer);
+
+    rift_regex_token_t token = rift_regex_tokenizer_next_token(tokenizer);
+    ASSERT_EQUAL(RIFT_REGEX_TOKEN_LITERAL_RUN, token.type);
+    ASSERT_STR("https://example", token.value);
+    ASSERT_EQUAL(0, token.start);
+    ASSERT_EQUAL(15, token.end);
+
+    token = rift_regex_tokenizer_next_token(tokenizer);
+    ASSERT_EQUAL(RIFT_REGEX_TOKEN_DOT, token.type);
+
+    // The byte before a quantifier is left out of the run
+    token = rift_regex_tokenizer_next_token(tokenizer);
+    ASSERT_EQUAL(RIFT_REGEX_TOKEN_LITERAL_RUN, token.type);
+    ASSERT_STR("com/a-pat", token.value);
+
+    token = rift_regex_tokenizer_next_token(tokenizer);
+    ASSERT_EQUAL(RIFT_REGEX_TOKEN_LITERAL, token.type);
+    ASSERT_STR("h", token.value);
+
+    token = rift_regex_tokenizer_next_token(tokenizer);
+    ASSERT_EQUAL(RIFT_REGEX_TOKEN_STAR, token.type);
+
+    token = rift_regex_tokenizer_next_token(tokenizer);
+    ASSERT_EQUAL(RIFT_REGEX_TOKEN_LITERAL, token.type);
+    ASSERT_STR("x", token.value);
+
+    token = rift_regex_tokenizer_next_token(tokenizer);
+    ASSERT_EQUAL(RIFT_REGEX_TOKEN_LBRACE, token.type);
+
+    token = rift_regex_tokenizer_next_token(tokenizer);
+    ASSERT_EQUAL(RIFT_REGEX_TOKEN_LITERAL_RUN, token.type);
+    ASSERT_STR("10", token.value);
+
+    ASSERT_EQUAL(0, rift_regex_token_literal_run("*ab", 3));
+    ASSERT_EQUAL(3, rift_regex_token_literal_run("abc", 3));
+
+    rift_regex_tokenizer_free(tokenizer);
+}
+
+// Test that span tokenizers read unterminated input in place
+CTEST(tokenizer_suite, span_tokenizer)
+{
+    // Only the first 9 bytes are tokenized; the '(' past them is never read
+    const char buffer[] = {'a', 'b', 'c', '[', 'x', '-', 'z', ']', 'd', '('};
+    rift_regex_tokenizer_t *tokenizer = rift_regex_tokenizer_create_spans(buffer, 9);
+    ASSERT_NOT_NULL(tokenizer);
+
+    // Longer tokens come without a value
+    rift_regex_token_t token = rift_regex_tokenizer_next_token(tokenizer);
+    ASSERT_EQUAL(RIFT_REGEX_TOKEN_LITERAL_RUN, token.type);
+    ASSERT_NULL(token.value);
+    ASSERT_EQUAL(0, token.start);
+    ASSERT_EQUAL(3, token.end);
+
+    token = rift_regex_tokenizer_next_token(tokenizer);
+    ASSERT_NULL(token.value);
+    ASSERT_EQUAL(3, token.start);
+    ASSERT_EQUAL(8, token.end);
+
+    // One-character values are still interned
+    token = rift_regex_tokenizer_next_token(tokenizer);
+    ASSERT_EQUAL(RIFT_REGEX_TOKEN_LITERAL, token.type);
+    ASSERT_STR("d", token.value);
+
+    token = rift_regex_tokenizer_next_token(tokenizer);
+    ASSERT_EQUAL(RIFT_REGEX_TOKEN_END, token.type);
+    ASSERT_EQUAL(9, token.start);
+
+    rift_regex_tokenizer_free(tokenizer);
+}
+
 // Main function to run the tests
 int
 main(int argc, const char *argv[])
@@ -52,9 +52,6 @@ static rift_regex_state_t *to_state = NULL;
 static void
 setup()
 {
-    // Reset state ID counter for consistent testing
-    rift_state_reset_id_counter();
-
     // Create states for transitions
     from_state = rift_state_create(false);
     to_state = rift_state_create(true);
@@ -298,6 +295,49 @@ TEST_CASE(sort_transitions_by_priority)
     rift_transition_free(t3);
 }
 
+/**
+ * Test pre-parsed transition predicates
+ */
+TEST_CASE(transition_predicates)
+{
+    rift_regex_transition_t *t_literal = rift_transition_create(from_state, to_state, "a");
+    rift_regex_transition_t *t_any = rift_transition_create(from_state, to_state, ".");
+    rift_regex_transition_t *t_class = rift_transition_create(from_state, to_state, "[^a-c]");
+    rift_regex_transition_t *t_alt = rift_transition_create(from_state, to_state, "x|y");
+    rift_regex_transition_t *t_epsilon = rift_transition_create_epsilon(from_state, to_state);
+
+    // Simple patterns are parsed without regcomp
+    const rift_transition_predicate_t *predicate = rift_transition_get_predicate(t_literal);
+    ASSERT_NOT_NULL(predicate);
+    ASSERT_EQUAL_INT(predicate->kind, RIFT_PREDICATE_LITERAL);
+    ASSERT_EQUAL_INT(predicate->literal, 'a');
+    ASSERT_EQUAL_INT(rift_transition_get_predicate(t_any)->kind, RIFT_PREDICATE_ANY);
+    ASSERT_EQUAL_INT(rift_transition_get_predicate(t_class)->kind, RIFT_PREDICATE_CLASS);
+    ASSERT_NULL(rift_transition_get_predicate(t_epsilon));
+
+    // Predicates agree with the pattern semantics
+    ASSERT_TRUE(rift_transition_matches_char(t_any, '\n'));
+    ASSERT_FALSE(rift_transition_matches_char(t_any, '\0'));
+    ASSERT_TRUE(rift_transition_matches_char(t_class, 'd'));
+    ASSERT_FALSE(rift_transition_matches_char(t_class, 'b'));
+    ASSERT_TRUE(rift_transition_matches_char(t_alt, 'y'));
+    ASSERT_FALSE(rift_transition_matches_char(t_alt, 'z'));
+
+    // The text form is kept and survives cloning
+    rift_regex_transition_t *clone = rift_transition_clone(t_class);
+    ASSERT_NOT_NULL(clone);
+    ASSERT_EQUAL_STRING(rift_transition_get_pattern(clone), "[^a-c]");
+    ASSERT_TRUE(rift_transition_matches_char(clone, 'z'));
+    ASSERT_FALSE(rift_transition_matches_char(clone, 'a'));
+
+    rift_transition_free(clone);
+    rift_transition_free(t_literal);
+    rift_transition_free(t_any);
+    rift_transition_free(t_class);
+    rift_transition_free(t_alt);
+    rift_transition_free(t_epsilon);
+}
+
 /**
  * Main function to run all tests
  */
@@ -320,6 +360,7 @@ main(void)
     RUN_TEST(transition_clone);
     RUN_TEST(transitions_are_equal);
     RUN_TEST(sort_transitions_by_priority);
+    RUN_TEST(transition_predicates);
 
     // Clean up
     teardown();
@@ -0,0 +1,216 @@
+/**
+ * @file svg_automaton_mapper_test.c
+ * @brief Unit tests for the layouts of the LibRift SVG automaton mapper
+ *
+ * This file contains test cases verifying that the layered layout ranks
+ * states by longest path, removes the crossings it can, collapses large
+ * strongly connected components and keeps positions it has no reason to
+ * change.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cli/visualizer/svg_automaton_mapper.h"
+#include "core/automaton/automaton.h"
+#include "core/automaton/state.h"
+#include "core/automaton/transition.h"
+#include "core/memory/memory.h"
+
+/* Read the centre of a state from its group */
+static void
+get_position(rift_svg_automaton_mapper_t *mapper, rift_regex_state_t *state, int *x, int *y)
+{
+    rift_svg_element_t *group = rift_svg_automaton_mapper_get_state_element(mapper, state);
+    assert(group != NULL);
+    const char *transform = rift_svg_element_get_attribute(group, "transform");
+    assert(transform != NULL);
+    assert(sscanf(transform, "translate(%d,%d)", x, y) == 2);
+}
+
+/* Check that layers follow the longest path from the initial state */
+static void
+test_layers_follow_longest_path(void)
+{
+    rift_regex_automaton_t *automaton = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *a = rift_automaton_create_state(automaton, false);
+    rift_regex_state_t *b = rift_automaton_create_state(automaton, false);
+    rift_regex_state_t *c = rift_automaton_create_state(automaton, true);
+    assert(rift_state_add_transition(a, c, "x"));
+    assert(rift_state_add_transition(a, b, "y"));
+    assert(rift_state_add_transition(b, c, "z"));
+    assert(rift_state_add_transition(c, a, "w"));
+
+    rift_svg_automaton_mapper_t *mapper = rift_svg_automaton_mapper_create();
+    assert(rift_svg_automaton_mapper_map_automaton_to_svg(mapper, automaton) != NULL);
+    assert(rift_svg_automaton_mapper_apply_layout(mapper, RIFT_SVG_LAYOUT_LAYERED));
+
+    /* The back edge c -> a is ignored, so c lands after b */
+    int xa, ya, xb, yb, xc, yc;
+    get_position(mapper, a, &xa, &ya);
+    get_position(mapper, b, &xb, &yb);
+    get_position(mapper, c, &xc, &yc);
+    assert(xa < xb && xb < xc);
+    assert(!rift_svg_automaton_mapper_apply_layout(mapper, 7));
+
+    rift_svg_automaton_mapper_destroy(mapper);
+    rift_automaton_free(automaton);
+}
+
+/* Check that barycenter sweeps untangle a layer built in the wrong order */
+static void
+test_crossings_are_reduced(void)
+{
+    enum { WIDTH = 6 };
+    rift_regex_automaton_t *automaton = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *root = rift_automaton_create_state(automaton, false);
+    rift_regex_state_t *middle[WIDTH];
+    rift_regex_state_t *last[WIDTH];
+    for (int i = 0; i < WIDTH; i++) {
+        middle[i] = rift_automaton_create_state(automaton, false);
+    }
+    for (int i = 0; i < WIDTH; i++) {
+        last[i] = rift_automaton_create_state(automaton, true);
+    }
+    for (int i = 0; i < WIDTH; i++) {
+        assert(rift_state_add_transition(root, middle[i], "a"));
+        /* A permutation with many inversions */
+        assert(rift_state_add_transition(middle[i], last[(i * 5 + 3) % WIDTH], "b"));
+    }
+
+    rift_svg_automaton_mapper_t *mapper = rift_svg_automaton_mapper_create();
+    assert(rift_svg_automaton_mapper_apply_layout(mapper, RIFT_SVG_LAYOUT_LAYERED));
+    assert(rift_svg_automaton_mapper_map_automaton_to_svg(mapper, automaton) != NULL);
+
+    int crossings = 0;
+    for (int i = 0; i < WIDTH; i++) {
+        for (int j = i + 1; j < WIDTH; j++) {
+            int x, ui, uj, vi, vj;
+            get_position(mapper, middle[i], &x, &ui);
+            get_position(mapper, middle[j], &x, &uj);
+            get_position(mapper, middle[i]->transitions[0]->to_state, &x, &vi);
+            get_position(mapper, middle[j]->transitions[0]->to_state, &x, &vj);
+            crossings += (ui < uj) != (vi < vj);
+        }
+    }
+    assert(crossings == 0);
+
+    rift_svg_automaton_mapper_destroy(mapper);
+    rift_automaton_free(automaton);
+}
+
+/* Check that a large cycle is drawn as one cluster */
+static void
+test_components_are_collapsed(void)
+{
+    rift_regex_automaton_t *automaton = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *entry = rift_automaton_create_state(automaton, false);
+    rift_regex_state_t *cycle[5];
+    for (int i = 0; i < 5; i++) {
+        cycle[i] = rift_automaton_create_state(automaton, false);
+    }
+    rift_regex_state_t *exit = rift_automaton_create_state(automaton, true);
+    assert(rift_state_add_transition(entry, cycle[0], "a"));
+    for (int i = 0; i < 5; i++) {
+        assert(rift_state_add_transition(cycle[i], cycle[(i + 1) % 5], "b"));
+    }
+    assert(rift_state_add_transition(cycle[3], exit, "c"));
+
+    rift_svg_automaton_mapper_t *mapper = rift_svg_automaton_mapper_create();
+    assert(rift_svg_automaton_mapper_set_collapse_threshold(mapper, 3));
+    assert(rift_svg_automaton_mapper_apply_layout(mapper, RIFT_SVG_LAYOUT_LAYERED));
+    rift_svg_element_t *root = rift_svg_automaton_mapper_map_automaton_to_svg(mapper, automaton);
+    assert(root != NULL);
+
+    char *svg = rift_svg_element_to_string(root);
+    assert(svg != NULL);
+    assert(strstr(svg, "id=\"c0\"") != NULL);
+    assert(strstr(svg, ">5 states</text>") != NULL);
+    assert(strstr(svg, "id=\"c1\"") == NULL);
+    rift_free(svg);
+
+    for (int i = 0; i < 5; i++) {
+        rift_svg_element_t *group = rift_svg_automaton_mapper_get_state_element(mapper, cycle[i]);
+        assert(strcmp(rift_svg_element_get_attribute(group, "display"), "none") == 0);
+    }
+    rift_svg_element_t *inner =
+        rift_svg_automaton_mapper_get_transition_element(mapper, cycle[0]->transitions[0]);
+    assert(strcmp(rift_svg_element_get_attribute(inner, "display"), "none") == 0);
+    rift_svg_element_t *into =
+        rift_svg_automaton_mapper_get_transition_element(mapper, entry->transitions[0]);
+    assert(rift_svg_element_get_attribute(into, "display") == NULL);
+
+    /* The exit follows the cluster, which follows the entry */
+    int xe, ye, xc, yc, xx, yx;
+    get_position(mapper, entry, &xe, &ye);
+    get_position(mapper, cycle[2], &xc, &yc);
+    get_position(mapper, exit, &xx, &yx);
+    assert(xe < xc && xc < xx);
+
+    /* Without the threshold, the members come back */
+    assert(rift_svg_automaton_mapper_set_collapse_threshold(mapper, 0));
+    assert(rift_svg_automaton_mapper_apply_layout(mapper, RIFT_SVG_LAYOUT_LAYERED));
+    rift_svg_element_t *group = rift_svg_automaton_mapper_get_state_element(mapper, cycle[0]);
+    assert(strcmp(rift_svg_element_get_attribute(group, "display"), "inline") == 0);
+    size_t num_removed = 0;
+    char **removed = rift_svg_automaton_mapper_take_removed_ids(mapper, &num_removed);
+    assert(num_removed == 1 && strcmp(removed[0], "c0") == 0);
+    rift_free(removed[0]);
+    rift_free(removed);
+
+    rift_svg_automaton_mapper_destroy(mapper);
+    rift_automaton_free(automaton);
+}
+
+/* Check that applying the layout in use again changes nothing */
+static void
+test_positions_are_cached(void)
+{
+    rift_regex_automaton_t *automaton = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    rift_regex_state_t *previous = rift_automaton_create_state(automaton, false);
+    for (int i = 0; i < 10; i++) {
+        rift_regex_state_t *state = rift_automaton_create_state(automaton, i == 9);
+        assert(rift_state_add_transition(previous, state, "a"));
+        previous = state;
+    }
+
+    rift_svg_automaton_mapper_t *mapper = rift_svg_automaton_mapper_create();
+    assert(rift_svg_automaton_mapper_apply_layout(mapper, RIFT_SVG_LAYOUT_LAYERED));
+    rift_svg_element_t *root = rift_svg_automaton_mapper_map_automaton_to_svg(mapper, automaton);
+    char *svg = rift_svg_element_to_string(root);
+    rift_free(svg);
+
+    assert(rift_svg_automaton_mapper_apply_layout(mapper, RIFT_SVG_LAYOUT_LAYERED));
+    assert(!rift_svg_element_is_dirty(root));
+
+    /* A new state is placed without moving the others */
+    rift_regex_state_t *added = rift_automaton_create_state(automaton, false);
+    assert(rift_state_add_transition(previous, added, "b"));
+    assert(rift_svg_automaton_mapper_update_transition(mapper, previous->transitions[0]));
+    size_t dirty = 0;
+    rift_svg_element_t *states = rift_svg_element_get_child(root, 2);
+    for (size_t i = 0; i < rift_svg_element_get_child_count(states); i++) {
+        dirty += rift_svg_element_is_dirty(rift_svg_element_get_child(states, i));
+    }
+    assert(dirty == 1);
+
+    rift_svg_automaton_mapper_destroy(mapper);
+    rift_automaton_free(automaton);
+}
+
+int
+main(void)
+{
+    test_layers_follow_longest_path();
+    test_crossings_are_reduced();
+    test_components_are_collapsed();
+    test_positions_are_cached();
+
+    printf("SVG automaton mapper tests: PASSED\n");
+    return 0;
+}
@@ -0,0 +1,332 @@
+/**
+ * @file svg_renderer_test.c
+ * @brief Unit tests for incremental rendering in the LibRift visualizer
+ *
+ * This file contains test cases verifying that changes notified through the
+ * observer re-emit only the affected elements, and that a document updated
+ * incrementally serializes exactly like one rendered from scratch.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cli/visualizer/svg_renderer.h"
+#include "core/automaton/automaton.h"
+#include "core/automaton/state.h"
+#include "core/automaton/transition.h"
+#include "core/memory/memory.h"
+
+/* Build a chain q0 -a-> q1 -b-> ... of a number of states */
+static rift_regex_automaton_t *
+build_chain(size_t num_states)
+{
+    rift_regex_automaton_t *automaton = rift_automaton_create(RIFT_AUTOMATON_NFA);
+    assert(automaton != NULL);
+
+    rift_regex_state_t *previous = NULL;
+    for (size_t i = 0; i < num_states; i++) {
+        rift_regex_state_t *state = rift_automaton_create_state(automaton, i + 1 == num_states);
+        assert(state != NULL);
+        if (previous) {
+            char pattern[2] = {(char)('a' + i % 26), '\0'};
+            assert(rift_state_add_transition(previous, state, pattern));
+        } else {
+            automaton->initial_state = state;
+        }
+        previous = state;
+    }
+    return automaton;
+}
+
+/* Count the occurrences of a string */
+static size_t
+count_occurrences(const char *haystack, const char *needle)
+{
+    size_t count = 0;
+    for (const char *p = strstr(haystack, needle); p; p = strstr(p + 1, needle)) {
+        count++;
+    }
+    return count;
+}
+
+/* Check that only the changed state is emitted again */
+static void
+test_changes_emit_only_modified_elements(void)
+{
+    rift_regex_automaton_t *automaton = build_chain(8);
+    rift_svg_renderer_t *renderer = rift_svg_renderer_create();
+    assert(renderer != NULL);
+
+    char *svg = rift_svg_renderer_render(renderer, automaton);
+    assert(svg != NULL);
+    assert(count_occurrences(svg, "<g id=\"s") == 8);
+    assert(count_occurrences(svg, "<g id=\"t") == 7);
+    rift_free(svg);
+
+    /* Nothing changed yet */
+    char *patch = rift_svg_renderer_render_changes(renderer);
+    assert(patch != NULL && patch[0] == '\0');
+    rift_free(patch);
+
+    rift_regex_state_t *state = automaton->states[3];
+    state->is_accepting = true;
+    rift_automaton_observer_notify_change(rift_svg_renderer_get_observer(renderer), automaton,
+                                          RIFT_AUTOMATON_CHANGE_STATE_MODIFIED, state);
+
+    char id[32];
+    snprintf(id, sizeof(id), "id=\"s%zu\"", state->id);
+    patch = rift_svg_renderer_render_changes(renderer);
+    assert(patch != NULL);
+    assert(strstr(patch, id) != NULL);
+    assert(count_occurrences(patch, "<g id=") == 1);
+    assert(strstr(patch, "visibility=\"visible\"") != NULL);
+    rift_free(patch);
+
+    /* The patch marked the state clean again */
+    patch = rift_svg_renderer_render_changes(renderer);
+    assert(patch != NULL && patch[0] == '\0');
+    rift_free(patch);
+
+    rift_svg_renderer_destroy(renderer);
+    rift_automaton_free(automaton);
+}
+
+/* Check that added and removed elements show up in the patch */
+static void
+test_changes_report_additions_and_removals(void)
+{
+    rift_regex_automaton_t *automaton = build_chain(4);
+    rift_svg_renderer_t *renderer = rift_svg_renderer_create();
+    assert(renderer != NULL);
+
+    char *svg = rift_svg_renderer_render(renderer, automaton);
+    assert(svg != NULL);
+    rift_free(svg);
+
+    rift_automaton_observer_t *observer = rift_svg_renderer_get_observer(renderer);
+    rift_regex_state_t *last = automaton->states[3];
+    rift_regex_transition_t *removed = automaton->states[2]->transitions[0];
+    rift_automaton_observer_notify_change(observer, automaton,
+                                          RIFT_AUTOMATON_CHANGE_TRANSITION_REMOVED, removed);
+
+    rift_regex_state_t *added = rift_automaton_create_state(automaton, false);
+    assert(added != NULL);
+    assert(rift_state_add_transition(last, added, "z"));
+    rift_automaton_observer_notify_change(observer, automaton, RIFT_AUTOMATON_CHANGE_STATE_ADDED,
+                                          added);
+    rift_automaton_observer_notify_change(observer, automaton,
+                                          RIFT_AUTOMATON_CHANGE_TRANSITION_ADDED,
+                                          last->transitions[0]);
+
+    char *patch = rift_svg_renderer_render_changes(renderer);
+    assert(patch != NULL);
+    assert(count_occurrences(patch, "data-removed=\"true\"") == 1);
+    assert(count_occurrences(patch, "transform=") == 1);
+    assert(count_occurrences(patch, "<path") == 1);
+    assert(strstr(patch, ">z</text>") != NULL);
+    rift_free(patch);
+
+    rift_svg_renderer_destroy(renderer);
+    rift_automaton_free(automaton);
+}
+
+/* Check that a document updated in place matches a fresh render */
+static void
+test_incremental_render_matches_full_render(void)
+{
+    rift_regex_automaton_t *automaton = build_chain(16);
+    rift_svg_renderer_t *renderer = rift_svg_renderer_create();
+    assert(renderer != NULL);
+    assert(rift_svg_renderer_initialize(renderer, 800, 600));
+
+    char *svg = rift_svg_renderer_render(renderer, automaton);
+    assert(svg != NULL);
+    rift_free(svg);
+
+    /* A whole-automaton notification compares the automaton with the document */
+    rift_regex_transition_t *relabeled = automaton->states[9]->transitions[0];
+    const char *pattern = relabeled->input_pattern;
+    automaton->states[5]->is_accepting = true;
+    relabeled->input_pattern = "<&>";
+    rift_automaton_observer_notify(rift_svg_renderer_get_observer(renderer), automaton);
+    char *incremental = rift_svg_renderer_render(renderer, automaton);
+    assert(incremental != NULL);
+    assert(strstr(incremental, "&lt;&amp;&gt;") != NULL);
+
+    rift_svg_renderer_t *fresh = rift_svg_renderer_create();
+    assert(fresh != NULL);
+    assert(rift_svg_renderer_initialize(fresh, 800, 600));
+    char *full = rift_svg_renderer_render(fresh, automaton);
+    assert(full != NULL);
+    assert(strcmp(incremental, full) == 0);
+
+    rift_free(incremental);
+    rift_free(full);
+    rift_svg_renderer_destroy(fresh);
+    rift_svg_renderer_destroy(renderer);
+    relabeled->input_pattern = pattern;
+    rift_automaton_free(automaton);
+}
+
+/* Check that updates to one element are merged while they wait */
+static void
+test_updates_are_coalesced(void)
+{
+    rift_svg_automaton_mapper_t *mapper = rift_svg_automaton_mapper_create();
+    assert(mapper != NULL);
+    rift_real_time_update_manager_t *manager = rift_real_time_update_manager_create(mapper);
+    assert(manager != NULL);
+
+    int state = 0;
+    int transition = 0;
+    for (int i = 0; i < 5; i++) {
+        assert(rift_real_time_update_manager_schedule_update(
+            manager, rift_real_time_update_manager_create_update(RIFT_UPDATE_TYPE_STATE_MODIFIED,
+                                                                 &state, i)));
+    }
+    assert(rift_real_time_update_manager_schedule_update(
+        manager, rift_real_time_update_manager_create_update(RIFT_UPDATE_TYPE_TRANSITION_MODIFIED,
+                                                             &transition, 0)));
+    assert(rift_real_time_update_manager_get_pending_update_count(manager) == 2);
+
+    /* A removal applies at once and cancels what waited for the element */
+    assert(rift_real_time_update_manager_schedule_update(
+        manager, rift_real_time_update_manager_create_update(RIFT_UPDATE_TYPE_TRANSITION_REMOVED,
+                                                             &transition, 0)));
+    assert(rift_real_time_update_manager_get_pending_update_count(manager) == 1);
+
+    rift_real_time_update_manager_destroy(manager);
+    rift_svg_automaton_mapper_destroy(mapper);
+}
+
+/* Observer counting the notifications it gets */
+typedef struct {
+    int updates;
+    int changes;
+    void *last;
+} counting_observer_t;
+
+static void
+count_update(rift_automaton_observer_t *observer, void *automaton)
+{
+    counting_observer_t *counts = observer->user_data;
+    counts->updates++;
+    counts->last = automaton;
+}
+
+static void
+count_change(rift_automaton_observer_t *observer, void *automaton,
+             rift_automaton_change_type_t type, void *element)
+{
+    (void)type;
+    (void)element;
+    counting_observer_t *counts = observer->user_data;
+    counts->changes++;
+    counts->last = automaton;
+}
+
+/* Check that a batch holds its changes back and delivers them as one update */
+static void
+test_batch_delivers_one_update(void)
+{
+    counting_observer_t counts = {0, 0, NULL};
+    rift_automaton_observer_t observer = {count_update, count_change, &counts, 0, NULL};
+    int first = 0;
+    int second = 0;
+
+    rift_automaton_observer_begin_batch(&observer);
+    rift_automaton_observer_begin_batch(&observer);
+    for (int i = 0; i < 100; i++) {
+        rift_automaton_observer_notify_change(&observer, &first,
+                                              RIFT_AUTOMATON_CHANGE_STATE_MODIFIED, &i);
+    }
+    rift_automaton_observer_notify(&observer, &first);
+    rift_automaton_observer_end_batch(&observer);
+    assert(counts.updates == 0 && counts.changes == 0);
+
+    /* Only the outermost batch delivers */
+    rift_automaton_observer_end_batch(&observer);
+    assert(counts.updates == 1 && counts.changes == 0 && counts.last == &first);
+
+    /* A change to another automaton delivers the held one first */
+    rift_automaton_observer_begin_batch(&observer);
+    rift_automaton_observer_notify(&observer, &first);
+    rift_automaton_observer_notify(&observer, &second);
+    assert(counts.updates == 2 && counts.last == &first);
+    rift_automaton_observer_end_batch(&observer);
+    assert(counts.updates == 3 && counts.last == &second);
+
+    /* An empty batch delivers nothing, and unbalanced ends are ignored */
+    rift_automaton_observer_begin_batch(&observer);
+    rift_automaton_observer_end_batch(&observer);
+    rift_automaton_observer_end_batch(&observer);
+    rift_automaton_observer_begin_batch(NULL);
+    assert(counts.updates == 3);
+
+    /* Outside a batch changes go through one by one again */
+    rift_automaton_observer_notify_change(&observer, &first, RIFT_AUTOMATON_CHANGE_STATE_ADDED,
+                                          &first);
+    assert(counts.changes == 1 && observer.batch_depth == 0);
+}
+
+/* Check that played trace records heat up and activate only their states */
+static void
+test_trace_marks_states(void)
+{
+    rift_regex_automaton_t *automaton = build_chain(4);
+    rift_svg_renderer_t *renderer = rift_svg_renderer_create();
+    assert(renderer != NULL);
+    char *svg = rift_svg_renderer_render(renderer, automaton);
+    assert(svg != NULL);
+    rift_free(svg);
+
+    uint32_t hot = (uint32_t)automaton->states[1]->id;
+    uint32_t last = (uint32_t)automaton->states[2]->id;
+    const rift_trace_record_t records[] = {
+        {hot, 0, RIFT_TRACE_EVENT_STEP},
+        {hot, 1, RIFT_TRACE_EVENT_BACKTRACK},
+        {hot, 2, RIFT_TRACE_EVENT_BACKTRACK},
+        {RIFT_TRACE_NO_LOCATION, 2, RIFT_TRACE_EVENT_MATCH},
+        {last, 3, RIFT_TRACE_EVENT_STEP},
+    };
+    assert(rift_svg_renderer_play_trace(renderer, records, 5) == 4);
+
+    char *patch = rift_svg_renderer_render_changes(renderer);
+    assert(patch != NULL);
+    assert(count_occurrences(patch, "<g id=") == 2);
+    assert(strstr(patch, "data-backtracks=\"2\"") != NULL);
+    assert(strstr(patch, "data-heat=\"2\"") != NULL);
+    assert(count_occurrences(patch, " active") == 1);
+    rift_free(patch);
+
+    /* Clearing redraws the traced states cold */
+    rift_svg_renderer_clear_trace(renderer);
+    patch = rift_svg_renderer_render_changes(renderer);
+    assert(patch != NULL);
+    assert(count_occurrences(patch, "<g id=") == 2);
+    assert(count_occurrences(patch, "data-heat=\"0\"") == 2);
+    assert(strstr(patch, " active") == NULL);
+    rift_free(patch);
+
+    rift_svg_renderer_destroy(renderer);
+    rift_automaton_free(automaton);
+}
+
+int
+main(void)
+{
+    test_changes_emit_only_modified_elements();
+    test_changes_report_additions_and_removals();
+    test_incremental_render_matches_full_render();
+    test_updates_are_coalesced();
+    test_batch_delivers_one_update();
+    test_trace_marks_states();
+
+    printf("SVG renderer tests: PASSED\n");
+    return 0;
+}
@@ -0,0 +1,120 @@
+/**
+ * @file handle_table_test.c
+ * @brief Unit tests for the generational handle tables of the web bridge
+ *
+ * This file contains test cases verifying that handles find their objects,
+ * that handles to removed objects stay stale after their slots are reused,
+ * and that objects can be removed in bulk.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "core/webbridge/handle_table.h"
+
+#define NUM_OBJECTS 1000
+
+/* Select the objects whose value is odd */
+static bool
+is_odd(void *object, void *context)
+{
+    (void)context;
+    return *(int *)object % 2 == 1;
+}
+
+/* Select every object, counting them */
+static bool
+count_all(void *object, void *context)
+{
+    (void)object;
+    (*(size_t *)context)++;
+    return true;
+}
+
+/* Test lookups, removal and stale handles */
+void
+test_handle_table_lookup(void)
+{
+    rift_handle_table_t *table = rift_handle_table_create(0);
+    assert(table != NULL);
+
+    int a = 1;
+    int b = 2;
+    uint32_t handle_a = rift_handle_table_insert(table, &a);
+    uint32_t handle_b = rift_handle_table_insert(table, &b);
+    assert(handle_a != RIFT_HANDLE_INVALID && handle_b != RIFT_HANDLE_INVALID);
+    assert(handle_a != handle_b);
+    assert(rift_handle_table_get(table, handle_a) == &a);
+    assert(rift_handle_table_get(table, handle_b) == &b);
+    assert(rift_handle_table_count(table) == 2);
+
+    // The slot of a is reused, but its old handle stays stale
+    assert(rift_handle_table_remove(table, handle_a) == &a);
+    assert(rift_handle_table_get(table, handle_a) == NULL);
+    assert(rift_handle_table_remove(table, handle_a) == NULL);
+    int c = 3;
+    uint32_t handle_c = rift_handle_table_insert(table, &c);
+    assert(handle_c != handle_a);
+    assert((handle_c & (RIFT_HANDLE_MAX_SLOTS - 1)) == (handle_a & (RIFT_HANDLE_MAX_SLOTS - 1)));
+    assert(rift_handle_table_get(table, handle_a) == NULL);
+    assert(rift_handle_table_get(table, handle_c) == &c);
+
+    assert(rift_handle_table_get(table, RIFT_HANDLE_INVALID) == NULL);
+    assert(rift_handle_table_get(table, 12345) == NULL);
+    assert(rift_handle_table_insert(table, NULL) == RIFT_HANDLE_INVALID);
+    assert(rift_handle_table_get(NULL, handle_b) == NULL);
+
+    rift_handle_table_free(table);
+    printf("test_handle_table_lookup: PASSED\n");
+}
+
+/* Test growth and bulk removal */
+void
+test_handle_table_bulk(void)
+{
+    rift_handle_table_t *table = rift_handle_table_create(4);
+    assert(table != NULL);
+
+    static int values[NUM_OBJECTS];
+    uint32_t handles[NUM_OBJECTS];
+    for (int i = 0; i < NUM_OBJECTS; i++) {
+        values[i] = i;
+        handles[i] = rift_handle_table_insert(table, &values[i]);
+        assert(handles[i] != RIFT_HANDLE_INVALID);
+    }
+    for (int i = 0; i < NUM_OBJECTS; i++) {
+        assert(rift_handle_table_get(table, handles[i]) == &values[i]);
+    }
+
+    assert(rift_handle_table_remove_each(table, is_odd, NULL) == NUM_OBJECTS / 2);
+    assert(rift_handle_table_count(table) == NUM_OBJECTS / 2);
+    for (int i = 0; i < NUM_OBJECTS; i++) {
+        void *expected = i % 2 == 1 ? NULL : &values[i];
+        assert(rift_handle_table_get(table, handles[i]) == expected);
+    }
+
+    size_t visited = 0;
+    assert(rift_handle_table_remove_each(table, count_all, &visited) == NUM_OBJECTS / 2);
+    assert(visited == NUM_OBJECTS / 2);
+    assert(rift_handle_table_count(table) == 0);
+    assert(rift_handle_table_get(table, handles[0]) == NULL);
+
+    rift_handle_table_free(table);
+    printf("test_handle_table_bulk: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running handle table tests...\n");
+
+    test_handle_table_lookup();
+    test_handle_table_bulk();
+
+    printf("All handle table tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,362 @@
+/**
+ * @file webbridge_test.c
+ * @brief Unit tests for the entry points of the WebAssembly bridge
+ *
+ * This file contains test cases calling the entry points of the bridge as
+ * JavaScript would, through handles and span arrays, and checking the
+ * matches, groups and errors they report.
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "core/bytecode/bytecode.h"
+#include "core/dsl/rift_dsl_compiler.h"
+#include "core/webbridge/webbridge.h"
+
+#define HEADER RIFT_WEBBRIDGE_BATCH_HEADER_WORDS
+#define MAX_WORDS 64
+#define NUM_POOL_INPUTS 200
+
+/* Test finding matches one at a time and reading their groups */
+void
+test_webbridge_find_next(void)
+{
+    assert(rift_webbridge_init());
+    rift_pattern_handle_t pattern = rift_webbridge_compile("(?<key>[a-z]+)=(?<value>[0-9]+)?", 0);
+    assert(pattern != RIFT_HANDLE_INVALID);
+    rift_matcher_handle_t matcher = rift_webbridge_create_matcher(pattern, 0);
+    assert(matcher != RIFT_HANDLE_INVALID);
+
+    assert(rift_webbridge_set_input(matcher, "a=1 bb= ccc=33", -1));
+    uint32_t start = 0;
+    uint32_t end = 0;
+    assert(rift_webbridge_find_next(matcher, &start, &end));
+    assert(start == 0 && end == 3);
+    assert(rift_webbridge_get_named_group(matcher, "key", &start, &end));
+    assert(start == 0 && end == 1);
+    assert(rift_webbridge_get_group(matcher, 2, &start, &end));
+    assert(start == 2 && end == 3);
+
+    // The optional value did not participate
+    assert(rift_webbridge_find_next(matcher, &start, &end));
+    assert(start == 4 && end == 7);
+    assert(!rift_webbridge_get_named_group(matcher, "value", &start, &end));
+    assert(!rift_webbridge_get_named_group(matcher, "missing", &start, &end));
+    assert(!rift_webbridge_get_group(matcher, 3, &start, &end));
+
+    assert(rift_webbridge_find_next(matcher, &start, &end));
+    assert(start == 8 && end == 14);
+    assert(!rift_webbridge_find_next(matcher, &start, &end));
+    assert(!rift_webbridge_get_group(matcher, 0, &start, &end));
+
+    // The input is copied, so the caller's string may go away
+    char *input = strdup("zz=9");
+    assert(rift_webbridge_set_input(matcher, input, 4));
+    free(input);
+    assert(rift_webbridge_matches(matcher));
+
+    // Handles of freed objects stay invalid, and the failure is reported
+    rift_webbridge_free_matcher(matcher);
+    rift_webbridge_free_pattern(pattern);
+    assert(!rift_webbridge_set_input(matcher, "a=1", -1));
+    char message[64];
+    assert(rift_webbridge_get_last_error(message, sizeof(message)) > 0);
+    assert(strstr(message, "matcher") != NULL);
+    assert(rift_webbridge_create_matcher(pattern, 0) == RIFT_HANDLE_INVALID);
+
+    // Compile errors come with the compiler's message, formatted when read
+    assert(rift_webbridge_compile("(", 0) == RIFT_HANDLE_INVALID);
+    assert(rift_webbridge_get_last_error(message, sizeof(message)) > 0);
+    assert(strcmp(message, "Failed to compile the pattern") != 0);
+
+    rift_webbridge_cleanup();
+    printf("test_webbridge_find_next: PASSED\n");
+}
+
+/* Test finding every match of an input in one call */
+void
+test_webbridge_find_all_batch(void)
+{
+    assert(rift_webbridge_init());
+    rift_pattern_handle_t pattern = rift_webbridge_compile("[0-9]+", 0);
+    rift_matcher_handle_t matcher = rift_webbridge_create_matcher(pattern, 0);
+    uint32_t spans[MAX_WORDS];
+
+    const char *input = "12 apples, 345 pears and 6 plums";
+    assert(rift_webbridge_find_all_batch(matcher, input, -1, spans, MAX_WORDS) == 3);
+    assert(spans[0] == 1 && spans[1] == 0);
+    assert(spans[HEADER] == 0 && spans[HEADER + 1] == 2);
+    assert(spans[HEADER + 2] == 11 && spans[HEADER + 3] == 14);
+    assert(spans[HEADER + 4] == 25 && spans[HEADER + 5] == 26);
+
+    // Matches that do not fit are left out and flagged
+    assert(rift_webbridge_find_all_batch(matcher, input, -1, spans, HEADER + 4) == 2);
+    assert(spans[1] == 1);
+    assert(rift_webbridge_find_all_batch(matcher, input, -1, spans, 1) == 0);
+    assert(rift_webbridge_find_all_batch(matcher, "none", -1, spans, MAX_WORDS) == 0);
+    assert(spans[1] == 0);
+
+    // Groups that did not participate are written unset
+    rift_pattern_handle_t grouped = rift_webbridge_compile("a(b)?", 0);
+    rift_matcher_handle_t grouped_matcher = rift_webbridge_create_matcher(grouped, 0);
+    assert(rift_webbridge_find_all_batch(grouped_matcher, "ab a", 4, spans, MAX_WORDS) == 2);
+    assert(spans[0] == 2);
+    assert(spans[HEADER + 2] == 1 && spans[HEADER + 3] == 2);
+    assert(spans[HEADER + 4] == 3 && spans[HEADER + 5] == 4);
+    assert(spans[HEADER + 6] == RIFT_WEBBRIDGE_BATCH_UNSET);
+    assert(spans[HEADER + 7] == RIFT_WEBBRIDGE_BATCH_UNSET);
+
+    rift_webbridge_cleanup();
+    printf("test_webbridge_find_all_batch: PASSED\n");
+}
+
+/* Test matching input written straight into the matcher's buffer */
+void
+test_webbridge_input_buffer(void)
+{
+    assert(rift_webbridge_init());
+    rift_pattern_handle_t pattern = rift_webbridge_compile("a+b", 0);
+    rift_matcher_handle_t matcher = rift_webbridge_create_matcher(pattern, 0);
+    uint32_t spans[MAX_WORDS];
+
+    uint8_t *buffer = rift_webbridge_get_input_buffer(matcher, 16);
+    assert(buffer != NULL);
+    memcpy(buffer, "xaab ab", 7);
+    assert(rift_webbridge_set_input_length(matcher, 7));
+    uint32_t start = 0;
+    uint32_t end = 0;
+    assert(rift_webbridge_find_next(matcher, &start, &end));
+    assert(start == 1 && end == 4);
+
+    // The same capacity reuses the buffer, which batches read in place
+    assert(rift_webbridge_get_input_buffer(matcher, 16) == buffer);
+    assert(rift_webbridge_find_all_batch(matcher, (const char *)buffer, 7, spans, MAX_WORDS) == 2);
+    assert(spans[HEADER + 2] == 5 && spans[HEADER + 3] == 7);
+
+    // A larger capacity may move it, and lengths past it are refused
+    buffer = rift_webbridge_get_input_buffer(matcher, 4096);
+    assert(buffer != NULL);
+    memset(buffer, 'a', 4095);
+    buffer[4095] = 'b';
+    assert(rift_webbridge_set_input_length(matcher, 4096));
+    assert(rift_webbridge_find_next(matcher, &start, &end));
+    assert(start == 0 && end == 4096);
+    assert(!rift_webbridge_set_input_length(matcher, 1 << 20));
+
+    rift_webbridge_cleanup();
+    printf("test_webbridge_input_buffer: PASSED\n");
+}
+
+/* Test matching a stream of chunks */
+void
+test_webbridge_stream(void)
+{
+    assert(rift_webbridge_init());
+    rift_pattern_handle_t pattern = rift_webbridge_compile("[0-9]+", 0);
+    rift_matcher_handle_t matcher = rift_webbridge_create_matcher(pattern, 0);
+    uint32_t spans[MAX_WORDS];
+
+    assert(rift_webbridge_stream_feed(matcher, "12", 2, spans, MAX_WORDS) == 0);
+    assert(rift_webbridge_stream_begin(matcher));
+
+    // Matches crossing chunks are reported whole, with absolute offsets
+    assert(rift_webbridge_stream_feed(matcher, "ab12", 4, spans, MAX_WORDS) == 0);
+    assert(rift_webbridge_stream_feed(matcher, "34 5", 4, spans, MAX_WORDS) == 1);
+    assert(spans[0] == 1 && spans[1] == 0);
+    assert(spans[HEADER] == 2 && spans[HEADER + 1] == 6);
+    assert(rift_webbridge_stream_feed(matcher, "6x7", 3, spans, MAX_WORDS) == 1);
+    assert(spans[HEADER] == 7 && spans[HEADER + 1] == 9);
+    assert(rift_webbridge_stream_end(matcher, spans, MAX_WORDS) == 1);
+    assert(spans[HEADER] == 10 && spans[HEADER + 1] == 11);
+    assert(spans[1] == 0);
+    assert(rift_webbridge_stream_end(matcher, spans, MAX_WORDS) == 0);
+
+    // Matches that do not fit are kept for the next call
+    assert(rift_webbridge_stream_begin(matcher));
+    assert(rift_webbridge_stream_feed(matcher, "1 2 3 ", 6, spans, HEADER + 2) == 1);
+    assert(spans[1] == 1 && spans[HEADER] == 0);
+    assert(rift_webbridge_stream_end(matcher, spans, HEADER + 2) == 1);
+    assert(spans[1] == 1 && spans[HEADER] == 2);
+    assert(rift_webbridge_stream_end(matcher, spans, HEADER + 2) == 1);
+    assert(spans[1] == 0 && spans[HEADER] == 4);
+
+    // Backreferences cannot be streamed
+    rift_pattern_handle_t backref = rift_webbridge_compile("(a)\\1", 0);
+    rift_matcher_handle_t backref_matcher = rift_webbridge_create_matcher(backref, 0);
+    assert(!rift_webbridge_stream_begin(backref_matcher));
+
+    rift_webbridge_cleanup();
+    printf("test_webbridge_stream: PASSED\n");
+}
+
+/* Test freeing matchers in bulk */
+void
+test_webbridge_free_matchers(void)
+{
+    assert(rift_webbridge_init());
+    rift_pattern_handle_t a = rift_webbridge_compile("a", 0);
+    rift_pattern_handle_t b = rift_webbridge_compile("b", 0);
+    rift_matcher_handle_t matchers[4];
+    for (size_t i = 0; i < 3; i++) {
+        matchers[i] = rift_webbridge_create_matcher(a, 0);
+        assert(matchers[i] != RIFT_HANDLE_INVALID);
+    }
+    rift_matcher_handle_t of_b = rift_webbridge_create_matcher(b, 0);
+
+    // Stale and invalid handles are skipped
+    rift_webbridge_free_matcher(matchers[2]);
+    matchers[3] = RIFT_HANDLE_INVALID;
+    assert(rift_webbridge_free_matchers(&matchers[1], 3) == 1);
+    assert(rift_webbridge_free_pattern_matchers(a) == 1);
+    assert(rift_webbridge_free_pattern_matchers(a) == 0);
+    assert(!rift_webbridge_set_input(matchers[0], "a", 1));
+
+    // Freeing a pattern frees its matchers with it
+    assert(rift_webbridge_set_input(of_b, "b", 1));
+    rift_webbridge_free_pattern(b);
+    assert(!rift_webbridge_set_input(of_b, "b", 1));
+
+    rift_webbridge_cleanup();
+    printf("test_webbridge_free_matchers: PASSED\n");
+}
+
+/* Test splitting a batch across the workers of a pool */
+void
+test_webbridge_pool(void)
+{
+    assert(rift_webbridge_init());
+    rift_pattern_handle_t pattern = rift_webbridge_compile("[a-z]+", 0);
+    rift_matcher_handle_t matcher = rift_webbridge_create_matcher(pattern, 0);
+    rift_pool_handle_t pool = rift_webbridge_create_pool(pattern, 3);
+    assert(pool != RIFT_HANDLE_INVALID);
+
+    // Input i holds i % 4 words
+    static const char *const words[] = {"", "ab", "ab cd", "ab cd ef"};
+    char inputs[NUM_POOL_INPUTS * 8];
+    uint32_t offsets[NUM_POOL_INPUTS + 1];
+    size_t length = 0;
+    for (size_t i = 0; i < NUM_POOL_INPUTS; i++) {
+        offsets[i] = (uint32_t)length;
+        memcpy(inputs + length, words[i % 4], strlen(words[i % 4]));
+        length += strlen(words[i % 4]);
+    }
+    offsets[NUM_POOL_INPUTS] = (uint32_t)length;
+
+    size_t max_words = HEADER + NUM_POOL_INPUTS * 7;
+    uint32_t *spans = (uint32_t *)malloc(max_words * sizeof(uint32_t));
+    assert(rift_webbridge_pool_find_all_batch(pool, inputs, offsets, NUM_POOL_INPUTS, spans,
+                                              (uint32_t)max_words) == NUM_POOL_INPUTS);
+    assert(spans[0] == 1 && spans[1] == 0);
+
+    // Results come in input order, as one matcher finds them
+    uint32_t expected[MAX_WORDS];
+    size_t pos = HEADER;
+    for (size_t i = 0; i < NUM_POOL_INPUTS; i++) {
+        uint32_t count = rift_webbridge_find_all_batch(matcher, inputs + offsets[i],
+                                                       (int32_t)(offsets[i + 1] - offsets[i]),
+                                                       expected, MAX_WORDS);
+        assert(spans[pos] == count && count == i % 4);
+        assert(memcmp(spans + pos + 1, expected + HEADER, 2 * count * sizeof(uint32_t)) == 0);
+        pos += 1 + 2 * count;
+    }
+
+    // Inputs whose results do not fit are left out and flagged
+    assert(rift_webbridge_pool_find_all_batch(pool, inputs, offsets, NUM_POOL_INPUTS, spans,
+                                              HEADER + 4) == 2);
+    assert(spans[1] == 1);
+    assert(rift_webbridge_pool_find_all_batch(pool, inputs, offsets, 0, spans, HEADER) == 0);
+    assert(spans[1] == 0);
+
+    rift_webbridge_free_pool(pool);
+    assert(rift_webbridge_pool_find_all_batch(pool, inputs, offsets, 1, spans,
+                                              (uint32_t)max_words) == 0);
+    free(spans);
+    rift_webbridge_cleanup();
+    printf("test_webbridge_pool: PASSED\n");
+}
+
+/* Test loading patterns, bundles and bytecode from memory */
+void
+test_webbridge_load(void)
+{
+    assert(rift_webbridge_init());
+
+    // A serialized pattern comes back as a pattern of its own
+    rift_pattern_handle_t pattern = rift_webbridge_compile("[a-z]+@[a-z]+", 0);
+    uint32_t size = 0;
+    assert(rift_webbridge_serialize_pattern(pattern, NULL, &size) > 0 && size > 0);
+    uint8_t *image = (uint8_t *)malloc(size);
+    uint32_t small = size - 1;
+    assert(rift_webbridge_serialize_pattern(pattern, image, &small) == 0 && small == size);
+    assert(rift_webbridge_serialize_pattern(pattern, image, &size) == size);
+    rift_webbridge_free_pattern(pattern);
+    rift_pattern_handle_t loaded = rift_webbridge_deserialize_pattern(image, size);
+    assert(loaded != RIFT_HANDLE_INVALID);
+    rift_matcher_handle_t matcher = rift_webbridge_create_matcher(loaded, 0);
+    uint32_t start = 0;
+    uint32_t end = 0;
+    assert(rift_webbridge_set_input(matcher, "to: bob@example", -1));
+    assert(rift_webbridge_find_next(matcher, &start, &end) && start == 4 && end == 15);
+    free(image);
+
+    void *compilation = rift_dsl_compile("@pattern Word = \"[a-z]+\"\n"
+                                         "@pattern Number = \"[0-9]+\"\n");
+
+    // A bundle runs from its container bytes
+    uint8_t *data = NULL;
+    size_t data_size = 0;
+    assert(rift_dsl_serialize_container(compilation, &data, &data_size));
+    rift_pattern_set_handle_t bundle = rift_webbridge_load_bundle(data, (uint32_t)data_size);
+    assert(bundle != RIFT_HANDLE_INVALID);
+    assert(rift_webbridge_bundle_count(bundle) == 2);
+    assert(rift_webbridge_bundle_matches(bundle, 0, "abc", -1));
+    assert(!rift_webbridge_bundle_matches(bundle, 1, "abc", 3));
+    assert(rift_webbridge_bundle_matches(bundle, 1, "42", 2));
+    rift_webbridge_free_bundle(bundle);
+    assert(rift_webbridge_bundle_count(bundle) == 0);
+
+    data[data_size - 1] ^= 1;
+    assert(rift_webbridge_load_bundle(data, (uint32_t)data_size) == RIFT_HANDLE_INVALID);
+    assert(rift_webbridge_get_last_error(NULL, 0) > 0);
+    free(data);
+
+    // Bytecode runs without a handle
+    rift_bytecode_program_t *program =
+        (rift_bytecode_program_t *)rift_dsl_get_compiled_program(compilation, 1);
+    size_t bytecode_size = 0;
+    assert(rift_bytecode_serialize(program, NULL, &bytecode_size));
+    uint8_t *bytecode = (uint8_t *)malloc(bytecode_size);
+    assert(rift_bytecode_serialize(program, bytecode, &bytecode_size));
+    assert(rift_webbridge_run_bytecode(bytecode, (uint32_t)bytecode_size, "123x", 4, &start,
+                                       &end));
+    assert(start == 0 && end == 3);
+    assert(!rift_webbridge_run_bytecode(bytecode, (uint32_t)bytecode_size, "x", 1, &start, &end));
+    free(bytecode);
+    rift_dsl_free_compilation(compilation);
+
+    rift_webbridge_cleanup();
+    printf("test_webbridge_load: PASSED\n");
+}
+
+int
+main(void)
+{
+    printf("Running web bridge tests...\n");
+
+    test_webbridge_find_next();
+    test_webbridge_find_all_batch();
+    test_webbridge_input_buffer();
+    test_webbridge_stream();
+    test_webbridge_free_matchers();
+    test_webbridge_pool();
+    test_webbridge_load();
+
+    printf("All web bridge tests PASSED!\n");
+    return 0;
+}
@@ -0,0 +1,149 @@
+/**
+ * @file rift_baseline_gen.c
+ * @brief Build-time generator of the baseline pattern DFA tables
+ *
+ * The build runs this once, linked against the engine without the tables,
+ * to write baseline_tables.c: every RIFT_PATTERN_* compiled into a minimal
+ * DFA table and emitted as const data, which librift then links in so
+ * rift_baseline_patterns_get_table() has nothing left to do at runtime.
+ *
+ * Usage: rift_baseline_gen OUTPUT.c
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "core/automaton/dfa_codegen.h"
+#include "core/automaton/dfa_table.h"
+#include "core/patterns/baseline_patterns.h"
+
+/**
+ * @brief Names the tables of each baseline pattern are emitted under
+ */
+static const struct {
+    rift_baseline_pattern_type_t type; /**< The pattern type */
+    const char *enumerator;            /**< Its enumerator in pattern_types.h */
+    const char *name;                  /**< Name of its emitted table */
+} baseline_tables[RIFT_BASELINE_PATTERN_COUNT] = {
+    {RIFT_BASELINE_PATTERN_EMPTY_STATE, "RIFT_BASELINE_PATTERN_EMPTY_STATE",
+     "rift_baseline_table_empty_state"},
+    {RIFT_BASELINE_PATTERN_WHITESPACE, "RIFT_BASELINE_PATTERN_WHITESPACE",
+     "rift_baseline_table_whitespace"},
+    {RIFT_BASELINE_PATTERN_WORD_BOUNDARY, "RIFT_BASELINE_PATTERN_WORD_BOUNDARY",
+     "rift_baseline_table_word_boundary"},
+    {RIFT_BASELINE_PATTERN_IDENTIFIER, "RIFT_BASELINE_PATTERN_IDENTIFIER",
+     "rift_baseline_table_identifier"},
+    {RIFT_BASELINE_PATTERN_NUMERIC, "RIFT_BASELINE_PATTERN_NUMERIC",
+     "rift_baseline_table_numeric"},
+    {RIFT_BASELINE_PATTERN_STRING, "RIFT_BASELINE_PATTERN_STRING", "rift_baseline_table_string"},
+    {RIFT_BASELINE_PATTERN_COMMENT, "RIFT_BASELINE_PATTERN_COMMENT",
+     "rift_baseline_table_comment"},
+    {RIFT_BASELINE_PATTERN_OPERATOR, "RIFT_BASELINE_PATTERN_OPERATOR",
+     "rift_baseline_table_operator"},
+    {RIFT_BASELINE_PATTERN_FUNCTION, "RIFT_BASELINE_PATTERN_FUNCTION",
+     "rift_baseline_table_function"},
+    {RIFT_BASELINE_PATTERN_STATE_TRANSITION, "RIFT_BASELINE_PATTERN_STATE_TRANSITION",
+     "rift_baseline_table_state_transition"},
+};
+
+/**
+ * @brief Write a pattern string as a C comment
+ *
+ * A space keeps a "*" "/" pair in the pattern from closing the comment.
+ *
+ * @param out The stream to write to
+ * @param pattern The pattern string
+ */
+static void
+emit_pattern_comment(FILE *out, const char *pattern)
+{
+    fputs("/* Pattern: ", out);
+    for (const char *c = pattern; *c; c++) {
+        fputc(*c, out);
+        if (c[0] == '*' && c[1] == '/') {
+            fputc(' ', out);
+        }
+    }
+    fputs(" */\n", out);
+}
+
+/**
+ * @brief Write every baseline table and the array indexing them by type
+ *
+ * @param out The stream to write to
+ * @return true if successful, false otherwise
+ */
+static bool
+emit_tables(FILE *out)
+{
+    bool emitted[RIFT_BASELINE_PATTERN_COUNT] = {false};
+
+    fprintf(out, "/* Generated by rift_baseline_gen from baseline_patterns.h; do not edit */\n\n"
+                 "#include <stddef.h>\n"
+                 "#include <stdint.h>\n"
+                 "#include \"core/automaton/dfa_table.h\"\n"
+                 "#include \"core/patterns/pattern_types.h\"\n\n");
+
+    for (size_t i = 0; i < RIFT_BASELINE_PATTERN_COUNT; i++) {
+        rift_regex_error_t error = {0};
+        rift_dfa_table_t *table =
+            rift_baseline_patterns_compile_table(baseline_tables[i].type, &error);
+
+        // The runtime reports such a pattern as having no table, as it would without this
+        if (!table) {
+            fprintf(stderr, "rift_baseline_gen: no table for %s: %s\n",
+                    baseline_tables[i].enumerator, error.message);
+            continue;
+        }
+
+        emit_pattern_comment(out, rift_baseline_patterns_get_source(baseline_tables[i].type));
+        emitted[i] = rift_dfa_table_emit_c_table(table, baseline_tables[i].name, out, &error);
+        rift_dfa_table_free(table);
+        if (!emitted[i]) {
+            fprintf(stderr, "rift_baseline_gen: %s\n", error.message);
+            return false;
+        }
+        fputc('\n', out);
+    }
+
+    fprintf(out, "const rift_dfa_table_t *const rift_baseline_tables[RIFT_BASELINE_PATTERN_COUNT] "
+                 "= {\n");
+    for (size_t i = 0; i < RIFT_BASELINE_PATTERN_COUNT; i++) {
+        if (emitted[i]) {
+            fprintf(out, "    [%s] = &%s,\n", baseline_tables[i].enumerator,
+                    baseline_tables[i].name);
+        } else {
+            fprintf(out, "    [%s] = NULL,\n", baseline_tables[i].enumerator);
+        }
+    }
+    fprintf(out, "};\n");
+
+    return !ferror(out);
+}
+
+int
+main(int argc, char *argv[])
+{
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s OUTPUT.c\n", argv[0]);
+        return 1;
+    }
+
+    FILE *out = fopen(argv[1], "w");
+    if (!out) {
+        fprintf(stderr, "rift_baseline_gen: cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    bool written = emit_tables(out);
+    if (fclose(out) != 0 || !written) {
+        // A partial file would otherwise look up to date to the build
+        fprintf(stderr, "rift_baseline_gen: failed to write %s\n", argv[1]);
+        remove(argv[1]);
+        return 1;
+    }
+
+    return 0;
+}
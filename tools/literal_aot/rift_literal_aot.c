@@ -0,0 +1,470 @@
+/**
+ * @file rift_literal_aot.c
+ * @brief Build-time compiler of the R'' regex literals in C sources
+ *
+ * The build runs this on every source a target registers with
+ * rift_precompile_literals(). Each R'...' or R"..." literal, with the flag
+ * letters that may follow its closing quote, is compiled here, so a bad
+ * pattern fails the build with its file, line and column. The source is
+ * then written back out with every literal replaced by a call returning its
+ * rift_regex_pattern_t *, loaded on first use from the serialized image
+ * embedded in the file: no pattern is parsed or compiled at runtime.
+ *
+ * With --runtime, as when cross-compiling, the images are left out, since
+ * they only load on a machine of the build's byte order; the patterns are
+ * still checked here but compiled on first use.
+ *
+ * Usage: rift_literal_aot [--runtime] INPUT.c OUTPUT.c
+ *
+ * @copyright Copyright (c) 2025 LibRift Project
+ * @license MIT License
+ */
+
+#include <ctype.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/engine/pattern.h"
+#include "core/syntax/syntax.h"
+
+/**
+ * @brief A regex literal found in the source
+ */
+typedef struct aot_literal {
+    size_t start;              /**< Offset of its R */
+    size_t end;                /**< Offset just past its last flag letter */
+    char *pattern;             /**< Pattern between the quotes */
+    rift_regex_flags_t flags;  /**< Flags it compiles with */
+    unsigned char *image;      /**< Serialized pattern, NULL with --runtime */
+    size_t image_size;         /**< Size of image */
+} aot_literal_t;
+
+/**
+ * @brief Read a whole file
+ *
+ * @param path Path of the file
+ * @param length Pointer to store its length
+ * @return Its contents, NUL-terminated, or NULL on an I/O error
+ */
+static char *
+read_file(const char *path, size_t *length)
+{
+    FILE *in = fopen(path, "rb");
+    if (!in) {
+        return NULL;
+    }
+
+    size_t capacity = 4096;
+    size_t used = 0;
+    char *data = (char *)malloc(capacity + 1);
+    while (data) {
+        used += fread(data + used, 1, capacity - used, in);
+        if (used < capacity) {
+            break;
+        }
+        char *grown = (char *)realloc(data, capacity * 2 + 1);
+        if (!grown) {
+            free(data);
+            data = NULL;
+            break;
+        }
+        data = grown;
+        capacity *= 2;
+    }
+
+    if (data && ferror(in)) {
+        free(data);
+        data = NULL;
+    }
+    fclose(in);
+    if (data) {
+        data[used] = '\0';
+        *length = used;
+    }
+    return data;
+}
+
+/**
+ * @brief Get the line and column of an offset in the source
+ */
+static void
+locate(const char *source, size_t offset, size_t *line, size_t *column)
+{
+    *line = 1;
+    *column = 1;
+    for (size_t i = 0; i < offset; i++) {
+        if (source[i] == '\n') {
+            (*line)++;
+            *column = 1;
+        } else {
+            (*column)++;
+        }
+    }
+}
+
+/**
+ * @brief Skip a comment, string or character constant starting at an offset
+ *
+ * @param source The source
+ * @param pos Offset to look at
+ * @return Offset just past what was skipped, or pos if nothing starts there
+ */
+static size_t
+skip_non_code(const char *source, size_t pos)
+{
+    if (source[pos] == '/' && source[pos + 1] == '/') {
+        while (source[pos] && source[pos] != '\n') {
+            pos++;
+        }
+        return pos;
+    }
+    if (source[pos] == '/' && source[pos + 1] == '*') {
+        const char *end = strstr(source + pos + 2, "*/");
+        return end ? (size_t)(end - source) + 2 : pos + strlen(source + pos);
+    }
+    if (source[pos] == '"' || source[pos] == '\'') {
+        char quote = source[pos++];
+        while (source[pos] && source[pos] != quote && source[pos] != '\n') {
+            pos += source[pos] == '\\' && source[pos + 1] ? 2 : 1;
+        }
+        return source[pos] == quote ? pos + 1 : pos;
+    }
+    return pos;
+}
+
+/**
+ * @brief Compile one literal and keep what the output needs of it
+ *
+ * @param text Text of the literal, from its R through its flags
+ * @param literal The literal, its offsets already set
+ * @param runtime Whether to leave the image out
+ * @param error Pointer to store the error of a pattern that does not compile
+ * @return true if compiled, false otherwise
+ */
+static bool
+compile_literal(const char *text, aot_literal_t *literal, bool runtime, rift_regex_error_t *error)
+{
+    rift_regex_flags_t flags = RIFT_REGEX_FLAG_NONE;
+    size_t length = strlen(text);
+    char *pattern = (char *)malloc(length + 1);
+    if (!pattern || !rift_regex_parser_extract_flags(text, &flags) ||
+        !rift_regex_parser_extract_pattern(text, pattern, length + 1)) {
+        free(pattern);
+        rift_regex_error_set_with_message(error, RIFT_REGEX_ERROR_SYNTAX,
+                                          "Malformed regex literal");
+        return false;
+    }
+
+    // Compiled the way the literal would be at runtime, R'' syntax included
+    rift_regex_literal_t *compiled = rift_regex_literal_create(text, flags);
+    bool ok = compiled && rift_regex_literal_compile(compiled, error);
+    if (ok && !runtime) {
+        ok = rift_regex_pattern_serialize(rift_regex_literal_get_pattern(compiled),
+                                          &literal->image, &literal->image_size);
+        if (!ok) {
+            rift_regex_error_set_with_message(error, RIFT_REGEX_ERROR_INTERNAL,
+                                              "Cannot serialize the pattern");
+        }
+    }
+    rift_regex_literal_free(compiled);
+
+    if (!ok) {
+        free(pattern);
+        return false;
+    }
+    literal->pattern = pattern;
+    literal->flags = flags | RIFT_REGEX_FLAG_RIFT_SYNTAX;
+    return true;
+}
+
+/**
+ * @brief Find and compile every regex literal of a source
+ *
+ * Comments, strings and character constants are skipped, and an R only
+ * starts a literal at the start of a token.
+ *
+ * @param path Path of the source, for error messages
+ * @param source The source
+ * @param runtime Whether to leave the images out
+ * @param count Pointer to store the number of literals
+ * @return The literals (NULL if none), or NULL with *count set to SIZE_MAX on an error
+ */
+static aot_literal_t *
+find_literals(const char *path, const char *source, bool runtime, size_t *count)
+{
+    aot_literal_t *literals = NULL;
+    size_t capacity = 0;
+    *count = 0;
+
+    size_t pos = 0;
+    while (source[pos]) {
+        size_t next = skip_non_code(source, pos);
+        if (next != pos) {
+            pos = next;
+            continue;
+        }
+
+        bool token_start = pos == 0 || !(isalnum((unsigned char)source[pos - 1]) ||
+                                         source[pos - 1] == '_');
+        size_t start = 0;
+        size_t end = 0;
+        if (!token_start || source[pos] != 'R' ||
+            (source[pos + 1] != '\'' && source[pos + 1] != '"') ||
+            !rift_regex_parser_is_literal(source + pos, &start, &end) || start != 0) {
+            pos++;
+            continue;
+        }
+
+        // The flag letters run up to the end of the token
+        end += pos;
+        while (source[end] && strchr("imsxUr", source[end])) {
+            end++;
+        }
+
+        if (*count == capacity) {
+            capacity = capacity ? capacity * 2 : 8;
+            aot_literal_t *grown =
+                (aot_literal_t *)realloc(literals, capacity * sizeof(aot_literal_t));
+            if (!grown) {
+                fprintf(stderr, "rift_literal_aot: out of memory\n");
+                break;
+            }
+            literals = grown;
+        }
+
+        aot_literal_t *literal = &literals[*count];
+        memset(literal, 0, sizeof(*literal));
+        literal->start = pos;
+        literal->end = end;
+
+        rift_regex_error_t error;
+        rift_regex_error_init(&error);
+        char *text = (char *)malloc(end - pos + 1);
+        bool allocated = text != NULL;
+        bool compiled = false;
+        if (allocated) {
+            memcpy(text, source + pos, end - pos);
+            text[end - pos] = '\0';
+            compiled = compile_literal(text, literal, runtime, &error);
+            free(text);
+        }
+        if (!compiled) {
+            size_t line;
+            size_t column;
+            locate(source, pos, &line, &column);
+            fprintf(stderr, "%s:%zu:%zu: error: %s\n", path, line, column,
+                    allocated ? rift_regex_error_message(&error) : "out of memory");
+            break;
+        }
+
+        (*count)++;
+        pos = end;
+    }
+
+    // Anything left unscanned is an error already reported
+    if (source[pos]) {
+        for (size_t i = 0; i < *count; i++) {
+            free(literals[i].pattern);
+            free(literals[i].image);
+        }
+        free(literals);
+        *count = SIZE_MAX;
+        return NULL;
+    }
+    return literals;
+}
+
+/**
+ * @brief Write a string as a C string literal
+ */
+static void
+emit_string(FILE *out, const char *string)
+{
+    fputc('"', out);
+    for (const unsigned char *c = (const unsigned char *)string; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            fprintf(out, "\\%c", *c);
+        } else if (*c == '?' || !isprint(*c)) {
+            // Octal keeps trigraphs and control bytes out of the literal
+            fprintf(out, "\\%03o", *c);
+        } else {
+            fputc(*c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+/**
+ * @brief Write the precompiled patterns and the function loading them
+ *
+ * @param out The stream to write to
+ * @param input Path of the source, for the header comment
+ * @param literals The literals
+ * @param count Number of literals
+ */
+static void
+emit_patterns(FILE *out, const char *input, const aot_literal_t *literals, size_t count)
+{
+    fprintf(out, "/* Generated by rift_literal_aot from %s; do not edit */\n\n", input);
+    fprintf(out, "#include <stdatomic.h>\n"
+                 "#include <stddef.h>\n"
+                 "#include \"core/engine/pattern.h\"\n\n");
+
+    for (size_t i = 0; i < count; i++) {
+        if (!literals[i].image) {
+            continue;
+        }
+        fprintf(out, "static const unsigned char rift_aot_image_%zu[%zu] = {", i,
+                literals[i].image_size);
+        for (size_t b = 0; b < literals[i].image_size; b++) {
+            fprintf(out, "%s0x%02x,", b % 12 == 0 ? "\n    " : " ", literals[i].image[b]);
+        }
+        fprintf(out, "\n};\n\n");
+    }
+
+    fprintf(out, "static const struct {\n"
+                 "    const char *pattern;\n"
+                 "    rift_regex_flags_t flags;\n"
+                 "    const unsigned char *image;\n"
+                 "    size_t image_size;\n"
+                 "} rift_aot_literals[%zu] = {\n",
+            count);
+    for (size_t i = 0; i < count; i++) {
+        fprintf(out, "    {");
+        emit_string(out, literals[i].pattern);
+        if (literals[i].image) {
+            fprintf(out, ", (rift_regex_flags_t)0x%xu, rift_aot_image_%zu, %zu},\n",
+                    (unsigned)literals[i].flags, i, literals[i].image_size);
+        } else {
+            fprintf(out, ", (rift_regex_flags_t)0x%xu, NULL, 0},\n", (unsigned)literals[i].flags);
+        }
+    }
+    fprintf(out, "};\n\n");
+
+    // Racing first uses load a pattern each and keep one; patterns live as long as the program
+    fprintf(out,
+            "static _Atomic(rift_regex_pattern_t *) rift_aot_patterns[%zu];\n\n"
+            "static rift_regex_pattern_t *\n"
+            "rift_aot_pattern(size_t index)\n"
+            "{\n"
+            "    rift_regex_pattern_t *pattern =\n"
+            "        atomic_load_explicit(&rift_aot_patterns[index], memory_order_acquire);\n"
+            "    if (pattern) {\n"
+            "        return pattern;\n"
+            "    }\n"
+            "\n"
+            "    rift_regex_pattern_t *loaded =\n"
+            "        rift_aot_literals[index].image\n"
+            "            ? rift_regex_pattern_deserialize(rift_aot_literals[index].image,\n"
+            "                                             rift_aot_literals[index].image_size, "
+            "NULL)\n"
+            "            : NULL;\n"
+            "    if (!loaded) {\n"
+            "        loaded = rift_regex_compile(rift_aot_literals[index].pattern,\n"
+            "                                    rift_aot_literals[index].flags, NULL);\n"
+            "    }\n"
+            "    if (loaded && !atomic_compare_exchange_strong(&rift_aot_patterns[index], "
+            "&pattern,\n"
+            "                                                  loaded)) {\n"
+            "        rift_regex_pattern_free(loaded);\n"
+            "        return pattern;\n"
+            "    }\n"
+            "    return loaded;\n"
+            "}\n\n",
+            count);
+}
+
+/**
+ * @brief Write the source with its literals replaced
+ *
+ * A #line directive and the newlines of multi-line literals keep compiler
+ * diagnostics pointing into the original source.
+ *
+ * @param out The stream to write to
+ * @param input Path of the source
+ * @param source The source
+ * @param length Length of the source
+ * @param literals The literals
+ * @param count Number of literals
+ */
+static void
+emit_source(FILE *out, const char *input, const char *source, size_t length,
+            const aot_literal_t *literals, size_t count)
+{
+    fputs("#line 1 ", out);
+    emit_string(out, input);
+    fputc('\n', out);
+
+    size_t pos = 0;
+    for (size_t i = 0; i < count; i++) {
+        fwrite(source + pos, 1, literals[i].start - pos, out);
+        fprintf(out, "rift_aot_pattern(%zu)", i);
+        for (size_t c = literals[i].start; c < literals[i].end; c++) {
+            if (source[c] == '\n') {
+                fputc('\n', out);
+            }
+        }
+        pos = literals[i].end;
+    }
+    fwrite(source + pos, 1, length - pos, out);
+}
+
+int
+main(int argc, char *argv[])
+{
+    bool runtime = argc == 4 && strcmp(argv[1], "--runtime") == 0;
+    if (argc != 3 && !runtime) {
+        fprintf(stderr, "Usage: %s [--runtime] INPUT.c OUTPUT.c\n", argv[0]);
+        return 1;
+    }
+    const char *input = argv[argc - 2];
+    const char *output = argv[argc - 1];
+
+    size_t length = 0;
+    char *source = read_file(input, &length);
+    if (!source) {
+        fprintf(stderr, "rift_literal_aot: cannot read %s\n", input);
+        return 1;
+    }
+    if (strlen(source) != length) {
+        fprintf(stderr, "rift_literal_aot: %s is not a text file\n", input);
+        free(source);
+        return 1;
+    }
+
+    size_t count = 0;
+    aot_literal_t *literals = find_literals(input, source, runtime, &count);
+    if (count == SIZE_MAX) {
+        free(source);
+        return 1;
+    }
+
+    FILE *out = fopen(output, "w");
+    if (!out) {
+        fprintf(stderr, "rift_literal_aot: cannot open %s\n", output);
+        free(source);
+        return 1;
+    }
+
+    if (count > 0) {
+        emit_patterns(out, input, literals, count);
+    }
+    emit_source(out, input, source, length, literals, count);
+
+    bool written = !ferror(out);
+    if (fclose(out) != 0 || !written) {
+        // A partial file would otherwise look up to date to the build
+        fprintf(stderr, "rift_literal_aot: failed to write %s\n", output);
+        remove(output);
+        written = false;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        free(literals[i].pattern);
+        free(literals[i].image);
+    }
+    free(literals);
+    free(source);
+    return written ? 0 : 1;
+}